@@ -17,7 +17,15 @@
 #ifndef TINK_AEAD_H_
 #define TINK_AEAD_H_
 
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/util/inlined_buffer.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -49,7 +57,158 @@ class Aead {
       absl::string_view ciphertext,
       absl::string_view associated_data) const = 0;
 
+  // Returns the size of the ciphertext produced by EncryptInto() for a
+  // plaintext of 'plaintext_size' bytes, or an UNIMPLEMENTED error if the
+  // implementation cannot determine it without encrypting.
+  virtual crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const {
+    return crypto::tink::util::Status(
+        crypto::tink::util::error::UNIMPLEMENTED,
+        "CiphertextSize() is not supported by this Aead");
+  }
+
+  // Encrypts 'plaintext' as Encrypt() does, but writes the ciphertext into
+  // 'ciphertext_buffer' and returns the number of bytes written.  The buffer
+  // must be at least CiphertextSize(plaintext.size()) bytes long and must
+  // not overlap with 'plaintext' or 'associated_data'.
+  //
+  // The default implementation calls Encrypt() and copies the result;
+  // implementations override it to encrypt without allocating.
+  virtual crypto::tink::util::StatusOr<int64_t> EncryptInto(
+      absl::string_view plaintext, absl::string_view associated_data,
+      absl::Span<char> ciphertext_buffer) const {
+    auto ciphertext_or = Encrypt(plaintext, associated_data);
+    if (!ciphertext_or.ok()) return ciphertext_or.status();
+    return CopyToBuffer(ciphertext_or.ValueOrDie(), ciphertext_buffer);
+  }
+
+  // Decrypts 'ciphertext' as Decrypt() does, but writes the plaintext into
+  // 'plaintext_buffer' and returns the number of bytes written.  A buffer of
+  // ciphertext.size() bytes is always large enough; it must not overlap
+  // with 'ciphertext' or 'associated_data'.
+  //
+  // The default implementation calls Decrypt() and copies the result;
+  // implementations override it to decrypt without allocating.
+  virtual crypto::tink::util::StatusOr<int64_t> DecryptInto(
+      absl::string_view ciphertext, absl::string_view associated_data,
+      absl::Span<char> plaintext_buffer) const {
+    auto plaintext_or = Decrypt(ciphertext, associated_data);
+    if (!plaintext_or.ok()) return plaintext_or.status();
+    return CopyToBuffer(plaintext_or.ValueOrDie(), plaintext_buffer);
+  }
+
+  // Encrypts 'plaintext' as Encrypt() does, but returns the ciphertext in
+  // '*ciphertext', so that ciphertexts of up to N bytes need no heap
+  // allocation.  Uses EncryptInto() if the implementation knows
+  // CiphertextSize(), and copies the result of Encrypt() otherwise.
+  template <size_t N>
+  crypto::tink::util::Status Encrypt(
+      absl::string_view plaintext, absl::string_view associated_data,
+      crypto::tink::util::InlinedBuffer<N>* ciphertext) const {
+    auto size_result = CiphertextSize(plaintext.size());
+    if (!size_result.ok()) {
+      auto ciphertext_result = Encrypt(plaintext, associated_data);
+      if (!ciphertext_result.ok()) return ciphertext_result.status();
+      ciphertext->assign(ciphertext_result.ValueOrDie());
+      return crypto::tink::util::Status::OK;
+    }
+    ciphertext->resize(size_result.ValueOrDie());
+    auto written_result =
+        EncryptInto(plaintext, associated_data, ciphertext->AsSpan());
+    if (!written_result.ok()) return written_result.status();
+    ciphertext->resize(written_result.ValueOrDie());
+    return crypto::tink::util::Status::OK;
+  }
+
+  // Decrypts 'ciphertext' as Decrypt() does, but returns the plaintext in
+  // '*plaintext', so that plaintexts of up to N bytes need no heap
+  // allocation.  Uses DecryptInto().
+  template <size_t N>
+  crypto::tink::util::Status Decrypt(
+      absl::string_view ciphertext, absl::string_view associated_data,
+      crypto::tink::util::InlinedBuffer<N>* plaintext) const {
+    plaintext->resize(ciphertext.size());
+    auto written_result =
+        DecryptInto(ciphertext, associated_data, plaintext->AsSpan());
+    if (!written_result.ok()) {
+      plaintext->clear();
+      return written_result.status();
+    }
+    plaintext->resize(written_result.ValueOrDie());
+    return crypto::tink::util::Status::OK;
+  }
+
+  // Checks that 'ciphertext' is a valid ciphertext for 'associated_data',
+  // i.e. that Decrypt() would succeed, without returning the plaintext.
+  // This is for callers which only check the integrity of stored data,
+  // e.g. scrubbers.
+  //
+  // The default implementation decrypts into a buffer which is reused by
+  // the calls on the same thread, and zeroed after each call, so it saves
+  // the allocation of the plaintext but not the decryption. Only
+  // EncryptThenAuthenticate (AES-CTR-HMAC) overrides it, to check the tag
+  // without decrypting. AES-GCM, AES-GCM-SIV and the other AEADs keep the
+  // default and cost as much CPU as Decrypt().
+  virtual crypto::tink::util::Status VerifyCiphertext(
+      absl::string_view ciphertext, absl::string_view associated_data) const;
+
+  // Decrypts 'ciphertext' as Decrypt() does, but only with the key with id
+  // 'key_id' of the keyset, instead of the keys which may have produced
+  // it.  This is for callers which store the key id next to the
+  // ciphertext, e.g. to save the prefix of RAW ciphertexts, where Decrypt()
+  // would try all RAW keys.  'ciphertext' starts with the output prefix of
+  // the key, if it has one.  Primitives of keysets implement this; the
+  // default implementation returns UNIMPLEMENTED.
+  virtual crypto::tink::util::StatusOr<std::string> DecryptWithKeyId(
+      absl::string_view ciphertext, absl::string_view associated_data,
+      uint32_t key_id) const {
+    return crypto::tink::util::Status(
+        crypto::tink::util::error::UNIMPLEMENTED,
+        "DecryptWithKeyId() is not supported by this Aead");
+  }
+
+  // Encrypts plaintexts[i] with associated_data[i] as associated data, for
+  // every i.  All ciphertexts are written back-to-back into '*arena', which
+  // is allocated once for the whole batch, and on success
+  // (*ciphertexts)[i] is a view of the i-th ciphertext within '*arena'.
+  // The views are valid until '*arena' is modified or destroyed.
+  // Either all messages are encrypted or an error is returned.
+  crypto::tink::util::Status EncryptBatch(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::Span<const absl::string_view> associated_data, std::string* arena,
+      std::vector<absl::string_view>* ciphertexts) const;
+
+  // Decrypts ciphertexts[i] with associated_data[i] as associated data, for
+  // every i, with the same output conventions as EncryptBatch().  Either all
+  // messages are decrypted or an error is returned.
+  crypto::tink::util::Status DecryptBatch(
+      absl::Span<const absl::string_view> ciphertexts,
+      absl::Span<const absl::string_view> associated_data, std::string* arena,
+      std::vector<absl::string_view>* plaintexts) const;
+
+  // Encrypts plaintexts[i] into ciphertext_buffers[i], for every i.  Each
+  // buffer has exactly CiphertextSize(plaintexts[i].size()) bytes.  This is
+  // the customization point behind EncryptBatch(), for implementations that
+  // can amortize work across messages (e.g. drawing all nonces at once);
+  // the default implementation calls EncryptInto() for every message.
+  virtual crypto::tink::util::Status EncryptBatchInto(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::Span<const absl::string_view> associated_data,
+      absl::Span<const absl::Span<char>> ciphertext_buffers) const;
+
   virtual ~Aead() {}
+
+ private:
+  static crypto::tink::util::StatusOr<int64_t> CopyToBuffer(
+      const std::string& data, absl::Span<char> buffer) {
+    if (buffer.size() < data.size()) {
+      return crypto::tink::util::Status(
+          crypto::tink::util::error::INVALID_ARGUMENT,
+          "Output buffer too small");
+    }
+    std::copy(data.begin(), data.end(), buffer.begin());
+    return static_cast<int64_t>(data.size());
+  }
 };
 
 }  // namespace tink
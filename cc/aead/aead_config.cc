@@ -17,14 +17,19 @@
 #include "tink/aead/aead_config.h"
 
 #include "absl/memory/memory.h"
+#include "tink/aead/aegis_key_manager.h"
 #include "tink/aead/aes_ctr_hmac_aead_key_manager.h"
 #include "tink/aead/aes_eax_key_manager.h"
+#include "tink/aead/aes_gcm_counter_nonce_key_manager.h"
+#include "tink/aead/aes_gcm_key_check_key_manager.h"
 #include "tink/aead/aes_gcm_key_manager.h"
+#include "tink/aead/aes_gcm_page_key_manager.h"
 #include "tink/aead/aes_gcm_siv_key_manager.h"
 #include "tink/aead/kms_aead_key_manager.h"
 #include "tink/aead/kms_envelope_aead_key_manager.h"
 #include "tink/aead/xchacha20_poly1305_key_manager.h"
 #include "tink/aead/aead_wrapper.h"
+#include "tink/aead/page_aead_wrapper.h"
 #include "tink/config/config_util.h"
 #include "tink/mac/mac_config.h"
 #include "tink/registry.h"
@@ -51,6 +56,9 @@ util::Status AeadConfig::Register() {
   // Register primitive wrapper.
   status = Registry::RegisterPrimitiveWrapper(absl::make_unique<AeadWrapper>());
   if (!status.ok()) return status;
+  status =
+      Registry::RegisterPrimitiveWrapper(absl::make_unique<PageAeadWrapper>());
+  if (!status.ok()) return status;
 
   // Register key managers which utilize the FIPS validated BoringCrypto
   // implementations.
@@ -60,6 +68,9 @@ util::Status AeadConfig::Register() {
   status = Registry::RegisterKeyTypeManager(
       absl::make_unique<AesGcmKeyManager>(), true);
   if (!status.ok()) return status;
+  status = Registry::RegisterKeyTypeManager(
+      absl::make_unique<AesGcmCounterNonceKeyManager>(), true);
+  if (!status.ok()) return status;
 
   if (kUseOnlyFips) {
     return util::OkStatus();
@@ -69,6 +80,12 @@ util::Status AeadConfig::Register() {
   status = Registry::RegisterKeyTypeManager(
       absl::make_unique<AesGcmSivKeyManager>(), true);
   if (!status.ok()) return status;
+  status = Registry::RegisterKeyTypeManager(
+      absl::make_unique<AesGcmKeyCheckKeyManager>(), true);
+  if (!status.ok()) return status;
+  status = Registry::RegisterKeyTypeManager(
+      absl::make_unique<AesGcmPageKeyManager>(), true);
+  if (!status.ok()) return status;
   status = Registry::RegisterKeyTypeManager(
       absl::make_unique<AesEaxKeyManager>(), true);
   if (!status.ok()) return status;
@@ -85,8 +102,17 @@ util::Status AeadConfig::Register() {
   return util::OkStatus();
 }
 
-
-
+// static
+util::Status AeadConfig::RegisterAegis() {
+  if (kUseOnlyFips) {
+    return util::Status(util::error::INTERNAL,
+                        "AEGIS is not available in FIPS-only mode.");
+  }
+  auto status = Register();
+  if (!status.ok()) return status;
+  return Registry::RegisterKeyTypeManager(
+      absl::make_unique<AegisKeyManager>(), true);
+}
 
 }  // namespace tink
 }  // namespace crypto
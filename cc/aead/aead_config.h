@@ -46,6 +46,13 @@ class AeadConfig {
   // from the current Tink release.
   static crypto::tink::util::Status Register();
 
+  // Registers the key manager for AEGIS-128L and AEGIS-256 (see
+  // AeadKeyTemplates::Aegis128L()), in addition to those registered by
+  // Register(). AEGIS is opt-in, as its primitives can only be created on
+  // CPUs with AES instructions and it is not FIPS approved: this fails in
+  // FIPS-only mode.
+  static crypto::tink::util::Status RegisterAegis();
+
  private:
   AeadConfig() {}
 };
@@ -20,13 +20,16 @@
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "absl/types/span.h"
 #include "openssl/crypto.h"
 #include "tink/aead.h"
 #include "tink/aead/aead_key_templates.h"
+#include "tink/aead/aegis_key_manager.h"
 #include "tink/aead/aes_gcm_key_manager.h"
 #include "tink/config.h"
 #include "tink/config/tink_fips.h"
 #include "tink/keyset_handle.h"
+#include "tink/page_aead.h"
 #include "tink/registry.h"
 #include "tink/util/status.h"
 #include "tink/util/test_matchers.h"
@@ -59,6 +62,24 @@ TEST_F(AeadConfigTest, RegisterWorks) {
               IsOk());
 }
 
+TEST_F(AeadConfigTest, RegisterAegis) {
+  if (kUseOnlyFips) {
+    EXPECT_THAT(AeadConfig::RegisterAegis(),
+                StatusIs(util::error::INTERNAL));
+    return;
+  }
+  ASSERT_THAT(AeadConfig::Register(), IsOk());
+  EXPECT_THAT(Registry::get_key_manager<Aead>(AegisKeyManager().get_key_type())
+                  .status(),
+              StatusIs(util::error::NOT_FOUND));
+  ASSERT_THAT(AeadConfig::RegisterAegis(), IsOk());
+  EXPECT_THAT(Registry::get_key_manager<Aead>(AegisKeyManager().get_key_type())
+                  .status(),
+              IsOk());
+  EXPECT_THAT(KeysetHandle::GenerateNew(AeadKeyTemplates::Aegis128L()).status(),
+              IsOk());
+}
+
 // Tests that the AeadWrapper has been properly registered and we can wrap
 // primitives.
 TEST_F(AeadConfigTest, WrappersRegistered) {
@@ -96,6 +117,33 @@ TEST_F(AeadConfigTest, WrappersRegistered) {
   EXPECT_FALSE(decryption_result.status().ok());
 }
 
+// Tests that a keyset of AesGcmPageKeys gives a PageAead, through the
+// registered PageAeadWrapper.
+TEST_F(AeadConfigTest, PageAeadKeyset) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  ASSERT_THAT(AeadConfig::Register(), IsOk());
+  auto handle_result =
+      KeysetHandle::GenerateNew(AeadKeyTemplates::Aes256GcmPage());
+  ASSERT_THAT(handle_result.status(), IsOk());
+  auto page_aead_result =
+      handle_result.ValueOrDie()->GetPrimitive<PageAead>();
+  ASSERT_THAT(page_aead_result.status(), IsOk());
+  const PageAead& page_aead = *page_aead_result.ValueOrDie();
+  EXPECT_THAT(page_aead.overhead(), Eq(33));
+
+  std::string page(4096, 'x');
+  ASSERT_THAT(
+      page_aead.EncryptPage(5, "file", absl::MakeSpan(&page[0], page.size())),
+      IsOk());
+  ASSERT_THAT(
+      page_aead.DecryptPage(5, "file", absl::MakeSpan(&page[0], page.size())),
+      IsOk());
+  EXPECT_THAT(page.substr(0, 4096 - 33), Eq(std::string(4096 - 33, 'x')));
+}
+
 // FIPS-only mode tests
 TEST_F(AeadConfigTest, RegisterNonFipsTemplates) {
   if (!kUseOnlyFips || !FIPS_mode()) {
@@ -109,6 +157,10 @@ TEST_F(AeadConfigTest, RegisterNonFipsTemplates) {
   non_fips_key_templates.push_back(AeadKeyTemplates::Aes256Eax());
   non_fips_key_templates.push_back(AeadKeyTemplates::Aes128GcmSiv());
   non_fips_key_templates.push_back(AeadKeyTemplates::Aes256GcmSiv());
+  non_fips_key_templates.push_back(AeadKeyTemplates::Aes128GcmKeyCheck());
+  non_fips_key_templates.push_back(AeadKeyTemplates::Aes256GcmKeyCheck());
+  non_fips_key_templates.push_back(AeadKeyTemplates::Aes128GcmPage());
+  non_fips_key_templates.push_back(AeadKeyTemplates::Aes256GcmPage());
   non_fips_key_templates.push_back(AeadKeyTemplates::XChaCha20Poly1305());
 
   for (auto key_template : non_fips_key_templates) {
@@ -128,6 +180,8 @@ TEST_F(AeadConfigTest, RegisterFipsValidTemplates) {
   std::list<google::crypto::tink::KeyTemplate> fips_key_templates;
   fips_key_templates.push_back(AeadKeyTemplates::Aes128Gcm());
   fips_key_templates.push_back(AeadKeyTemplates::Aes256Gcm());
+  fips_key_templates.push_back(AeadKeyTemplates::Aes128GcmCounterNonce());
+  fips_key_templates.push_back(AeadKeyTemplates::Aes256GcmCounterNonce());
   fips_key_templates.push_back(AeadKeyTemplates::Aes128CtrHmacSha256());
   fips_key_templates.push_back(AeadKeyTemplates::Aes256CtrHmacSha256());
 
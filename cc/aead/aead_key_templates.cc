@@ -17,18 +17,26 @@
 #include "tink/aead/aead_key_templates.h"
 
 #include "absl/strings/string_view.h"
+#include "proto/aegis.pb.h"
 #include "proto/aes_ctr_hmac_aead.pb.h"
 #include "proto/aes_eax.pb.h"
 #include "proto/aes_gcm.pb.h"
+#include "proto/aes_gcm_counter_nonce.pb.h"
+#include "proto/aes_gcm_key_check.pb.h"
+#include "proto/aes_gcm_page.pb.h"
 #include "proto/aes_gcm_siv.pb.h"
 #include "proto/common.pb.h"
 #include "proto/kms_envelope.pb.h"
 #include "proto/tink.pb.h"
 #include "proto/xchacha20_poly1305.pb.h"
 
+using google::crypto::tink::AegisKeyFormat;
 using google::crypto::tink::AesCtrHmacAeadKeyFormat;
 using google::crypto::tink::AesEaxKeyFormat;
+using google::crypto::tink::AesGcmCounterNonceKeyFormat;
+using google::crypto::tink::AesGcmKeyCheckKeyFormat;
 using google::crypto::tink::AesGcmKeyFormat;
+using google::crypto::tink::AesGcmPageKeyFormat;
 using google::crypto::tink::AesGcmSivKeyFormat;
 using google::crypto::tink::HashType;
 using google::crypto::tink::KeyTemplate;
@@ -64,6 +72,39 @@ KeyTemplate* NewAesGcmKeyTemplate(int key_size_in_bytes,
   return key_template;
 }
 
+KeyTemplate* NewAesGcmCounterNonceKeyTemplate(int key_size_in_bytes) {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.AesGcmCounterNonceKey");
+  key_template->set_output_prefix_type(OutputPrefixType::TINK);
+  AesGcmCounterNonceKeyFormat key_format;
+  key_format.set_key_size(key_size_in_bytes);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
+KeyTemplate* NewAesGcmKeyCheckKeyTemplate(int key_size_in_bytes) {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.AesGcmKeyCheckKey");
+  key_template->set_output_prefix_type(OutputPrefixType::TINK);
+  AesGcmKeyCheckKeyFormat key_format;
+  key_format.set_key_size(key_size_in_bytes);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
+KeyTemplate* NewAesGcmPageKeyTemplate(int key_size_in_bytes) {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.AesGcmPageKey");
+  key_template->set_output_prefix_type(OutputPrefixType::TINK);
+  AesGcmPageKeyFormat key_format;
+  key_format.set_key_size(key_size_in_bytes);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
 KeyTemplate* NewAesGcmSivKeyTemplate(int key_size_in_bytes) {
   KeyTemplate* key_template = new KeyTemplate;
   key_template->set_type_url(
@@ -75,6 +116,16 @@ KeyTemplate* NewAesGcmSivKeyTemplate(int key_size_in_bytes) {
   return key_template;
 }
 
+KeyTemplate* NewAegisKeyTemplate(int key_size_in_bytes) {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url("type.googleapis.com/google.crypto.tink.AegisKey");
+  key_template->set_output_prefix_type(OutputPrefixType::TINK);
+  AegisKeyFormat key_format;
+  key_format.set_key_size(key_size_in_bytes);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
 KeyTemplate* NewAesCtrHmacAeadKeyTemplate(int aes_key_size_in_bytes,
                                           int iv_size_in_bytes,
                                           int hmac_key_size_in_bytes,
@@ -143,6 +194,48 @@ const KeyTemplate& AeadKeyTemplates::Aes256GcmNoPrefix() {
   return *key_template;
 }
 
+// static
+const KeyTemplate& AeadKeyTemplates::Aes128GcmCounterNonce() {
+  static const KeyTemplate* key_template =
+      NewAesGcmCounterNonceKeyTemplate(/* key_size_in_bytes= */ 16);
+  return *key_template;
+}
+
+// static
+const KeyTemplate& AeadKeyTemplates::Aes256GcmCounterNonce() {
+  static const KeyTemplate* key_template =
+      NewAesGcmCounterNonceKeyTemplate(/* key_size_in_bytes= */ 32);
+  return *key_template;
+}
+
+// static
+const KeyTemplate& AeadKeyTemplates::Aes128GcmKeyCheck() {
+  static const KeyTemplate* key_template =
+      NewAesGcmKeyCheckKeyTemplate(/* key_size_in_bytes= */ 16);
+  return *key_template;
+}
+
+// static
+const KeyTemplate& AeadKeyTemplates::Aes256GcmKeyCheck() {
+  static const KeyTemplate* key_template =
+      NewAesGcmKeyCheckKeyTemplate(/* key_size_in_bytes= */ 32);
+  return *key_template;
+}
+
+// static
+const KeyTemplate& AeadKeyTemplates::Aes128GcmPage() {
+  static const KeyTemplate* key_template =
+      NewAesGcmPageKeyTemplate(/* key_size_in_bytes= */ 16);
+  return *key_template;
+}
+
+// static
+const KeyTemplate& AeadKeyTemplates::Aes256GcmPage() {
+  static const KeyTemplate* key_template =
+      NewAesGcmPageKeyTemplate(/* key_size_in_bytes= */ 32);
+  return *key_template;
+}
+
 // static
 const KeyTemplate& AeadKeyTemplates::Aes128GcmSiv() {
   static const KeyTemplate* key_template =
@@ -157,6 +250,20 @@ const KeyTemplate& AeadKeyTemplates::Aes256GcmSiv() {
   return *key_template;
 }
 
+// static
+const KeyTemplate& AeadKeyTemplates::Aegis128L() {
+  static const KeyTemplate* key_template =
+      NewAegisKeyTemplate(/* key_size_in_bytes= */ 16);
+  return *key_template;
+}
+
+// static
+const KeyTemplate& AeadKeyTemplates::Aegis256() {
+  static const KeyTemplate* key_template =
+      NewAegisKeyTemplate(/* key_size_in_bytes= */ 32);
+  return *key_template;
+}
+
 // static
 const KeyTemplate& AeadKeyTemplates::Aes128CtrHmacSha256() {
   static const KeyTemplate* key_template = NewAesCtrHmacAeadKeyTemplate(
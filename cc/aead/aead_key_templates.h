@@ -76,6 +76,58 @@ class AeadKeyTemplates {
   //   - OutputPrefixType: RAW
   static const google::crypto::tink::KeyTemplate& Aes256GcmNoPrefix();
 
+  // Returns a KeyTemplate that generates new instances of
+  // AesGcmCounterNonceKey with the following parameters:
+  //   - key size: 16 bytes
+  //   - IV size: 12 bytes (random prefix and message counter)
+  //   - tag size: 16 bytes
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate& Aes128GcmCounterNonce();
+
+  // Returns a KeyTemplate that generates new instances of
+  // AesGcmCounterNonceKey with the following parameters:
+  //   - key size: 32 bytes
+  //   - IV size: 12 bytes (random prefix and message counter)
+  //   - tag size: 16 bytes
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate& Aes256GcmCounterNonce();
+
+  // Returns a KeyTemplate that generates new instances of AesGcmKeyCheckKey
+  // with the following parameters:
+  //   - key size: 16 bytes
+  //   - IV size: 12 bytes
+  //   - key check size: 16 bytes
+  //   - tag size: 16 bytes
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate& Aes128GcmKeyCheck();
+
+  // Returns a KeyTemplate that generates new instances of AesGcmKeyCheckKey
+  // with the following parameters:
+  //   - key size: 32 bytes
+  //   - IV size: 12 bytes
+  //   - key check size: 16 bytes
+  //   - tag size: 16 bytes
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate& Aes256GcmKeyCheck();
+
+  // Returns a KeyTemplate that generates new instances of AesGcmPageKey,
+  // which provide a PageAead, with the following parameters:
+  //   - key size: 16 bytes
+  //   - nonce size: 12 bytes
+  //   - tag size: 16 bytes
+  //   - OutputPrefixType: TINK
+  // Pages encrypted with the keyset have a trailer of 33 bytes.
+  static const google::crypto::tink::KeyTemplate& Aes128GcmPage();
+
+  // Returns a KeyTemplate that generates new instances of AesGcmPageKey,
+  // which provide a PageAead, with the following parameters:
+  //   - key size: 32 bytes
+  //   - nonce size: 12 bytes
+  //   - tag size: 16 bytes
+  //   - OutputPrefixType: TINK
+  // Pages encrypted with the keyset have a trailer of 33 bytes.
+  static const google::crypto::tink::KeyTemplate& Aes256GcmPage();
+
   // Returns a KeyTemplate that generates new instances of AesGcmSivKey
   // with the following parameters:
   //   - key size: 16 bytes
@@ -92,6 +144,24 @@ class AeadKeyTemplates {
   //   - OutputPrefixType: TINK
   static const google::crypto::tink::KeyTemplate& Aes256GcmSiv();
 
+  // Returns a KeyTemplate that generates new instances of AegisKey
+  // for AEGIS-128L with the following parameters:
+  //   - key size: 16 bytes
+  //   - IV size: 16 bytes
+  //   - tag size: 16 bytes
+  //   - OutputPrefixType: TINK
+  // The key manager is registered by AeadConfig::RegisterAegis().
+  static const google::crypto::tink::KeyTemplate& Aegis128L();
+
+  // Returns a KeyTemplate that generates new instances of AegisKey
+  // for AEGIS-256 with the following parameters:
+  //   - key size: 32 bytes
+  //   - IV size: 32 bytes
+  //   - tag size: 16 bytes
+  //   - OutputPrefixType: TINK
+  // The key manager is registered by AeadConfig::RegisterAegis().
+  static const google::crypto::tink::KeyTemplate& Aegis256();
+
   // Returns a KeyTemplate that generates new instances of AesCtrHmacAeadKey
   // with the following parameters:
   //   - AES key size: 16 bytes
@@ -20,29 +20,42 @@
 #include "gtest/gtest.h"
 #include "tink/aead.h"
 #include "tink/aead/aead_config.h"
+#include "tink/aead/aegis_key_manager.h"
 #include "tink/aead/aes_ctr_hmac_aead_key_manager.h"
 #include "tink/aead/aes_eax_key_manager.h"
+#include "tink/aead/aes_gcm_counter_nonce_key_manager.h"
+#include "tink/aead/aes_gcm_key_check_key_manager.h"
 #include "tink/aead/aes_gcm_key_manager.h"
+#include "tink/aead/aes_gcm_page_key_manager.h"
 #include "tink/aead/aes_gcm_siv_key_manager.h"
 #include "tink/aead/kms_envelope_aead.h"
 #include "tink/aead/kms_envelope_aead_key_manager.h"
 #include "tink/aead/xchacha20_poly1305_key_manager.h"
 #include "tink/core/key_manager_impl.h"
 #include "tink/keyset_handle.h"
+#include "tink/page_aead.h"
 #include "tink/subtle/aead_test_util.h"
 #include "tink/util/fake_kms_client.h"
 #include "tink/util/test_matchers.h"
+#include "proto/aegis.pb.h"
 #include "proto/aes_ctr_hmac_aead.pb.h"
 #include "proto/aes_eax.pb.h"
 #include "proto/aes_gcm.pb.h"
+#include "proto/aes_gcm_counter_nonce.pb.h"
+#include "proto/aes_gcm_key_check.pb.h"
+#include "proto/aes_gcm_page.pb.h"
 #include "proto/aes_gcm_siv.pb.h"
 #include "proto/common.pb.h"
 #include "proto/kms_envelope.pb.h"
 #include "proto/tink.pb.h"
 #include "proto/xchacha20_poly1305.pb.h"
 
+using google::crypto::tink::AegisKeyFormat;
 using google::crypto::tink::AesCtrHmacAeadKeyFormat;
 using google::crypto::tink::AesEaxKeyFormat;
+using google::crypto::tink::AesGcmCounterNonceKeyFormat;
+using google::crypto::tink::AesGcmKeyCheckKeyFormat;
+using google::crypto::tink::AesGcmPageKeyFormat;
 using google::crypto::tink::AesGcmKeyFormat;
 using google::crypto::tink::AesGcmSivKeyFormat;
 using google::crypto::tink::HashType;
@@ -201,6 +214,95 @@ TEST(Aes128Gcm, CheckValues) {
   EXPECT_THAT(key_format.key_size(), Eq(16));
 }
 
+TEST(AeadKeyTemplatesTest, testAesGcmCounterNonceKeyTemplates) {
+  std::string type_url =
+      "type.googleapis.com/google.crypto.tink.AesGcmCounterNonceKey";
+  for (int key_size : {16, 32}) {
+    // Check that returned template is correct.
+    const KeyTemplate& key_template =
+        key_size == 16 ? AeadKeyTemplates::Aes128GcmCounterNonce()
+                       : AeadKeyTemplates::Aes256GcmCounterNonce();
+    EXPECT_EQ(type_url, key_template.type_url());
+    EXPECT_EQ(OutputPrefixType::TINK, key_template.output_prefix_type());
+    AesGcmCounterNonceKeyFormat key_format;
+    EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+    EXPECT_EQ(key_size, key_format.key_size());
+
+    // Check that reference to the same object is returned.
+    const KeyTemplate& key_template_2 =
+        key_size == 16 ? AeadKeyTemplates::Aes128GcmCounterNonce()
+                       : AeadKeyTemplates::Aes256GcmCounterNonce();
+    EXPECT_EQ(&key_template, &key_template_2);
+
+    // Check that the template works with the key manager.
+    AesGcmCounterNonceKeyManager key_type_manager;
+    auto key_manager = internal::MakeKeyManager<Aead>(&key_type_manager);
+    EXPECT_EQ(key_manager->get_key_type(), key_template.type_url());
+    auto new_key_result =
+        key_manager->get_key_factory().NewKey(key_template.value());
+    EXPECT_TRUE(new_key_result.ok()) << new_key_result.status();
+  }
+}
+
+TEST(AeadKeyTemplatesTest, testAesGcmKeyCheckKeyTemplates) {
+  std::string type_url =
+      "type.googleapis.com/google.crypto.tink.AesGcmKeyCheckKey";
+  for (int key_size : {16, 32}) {
+    // Check that returned template is correct.
+    const KeyTemplate& key_template =
+        key_size == 16 ? AeadKeyTemplates::Aes128GcmKeyCheck()
+                       : AeadKeyTemplates::Aes256GcmKeyCheck();
+    EXPECT_EQ(type_url, key_template.type_url());
+    EXPECT_EQ(OutputPrefixType::TINK, key_template.output_prefix_type());
+    AesGcmKeyCheckKeyFormat key_format;
+    EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+    EXPECT_EQ(key_size, key_format.key_size());
+
+    // Check that reference to the same object is returned.
+    const KeyTemplate& key_template_2 =
+        key_size == 16 ? AeadKeyTemplates::Aes128GcmKeyCheck()
+                       : AeadKeyTemplates::Aes256GcmKeyCheck();
+    EXPECT_EQ(&key_template, &key_template_2);
+
+    // Check that the template works with the key manager.
+    AesGcmKeyCheckKeyManager key_type_manager;
+    auto key_manager = internal::MakeKeyManager<Aead>(&key_type_manager);
+    EXPECT_EQ(key_manager->get_key_type(), key_template.type_url());
+    auto new_key_result =
+        key_manager->get_key_factory().NewKey(key_template.value());
+    EXPECT_TRUE(new_key_result.ok()) << new_key_result.status();
+  }
+}
+
+TEST(AeadKeyTemplatesTest, testAesGcmPageKeyTemplates) {
+  std::string type_url = "type.googleapis.com/google.crypto.tink.AesGcmPageKey";
+  for (int key_size : {16, 32}) {
+    // Check that returned template is correct.
+    const KeyTemplate& key_template =
+        key_size == 16 ? AeadKeyTemplates::Aes128GcmPage()
+                       : AeadKeyTemplates::Aes256GcmPage();
+    EXPECT_EQ(type_url, key_template.type_url());
+    EXPECT_EQ(OutputPrefixType::TINK, key_template.output_prefix_type());
+    AesGcmPageKeyFormat key_format;
+    EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+    EXPECT_EQ(key_size, key_format.key_size());
+
+    // Check that reference to the same object is returned.
+    const KeyTemplate& key_template_2 =
+        key_size == 16 ? AeadKeyTemplates::Aes128GcmPage()
+                       : AeadKeyTemplates::Aes256GcmPage();
+    EXPECT_EQ(&key_template, &key_template_2);
+
+    // Check that the template works with the key manager.
+    AesGcmPageKeyManager key_type_manager;
+    auto key_manager = internal::MakeKeyManager<PageAead>(&key_type_manager);
+    EXPECT_EQ(key_manager->get_key_type(), key_template.type_url());
+    auto new_key_result =
+        key_manager->get_key_factory().NewKey(key_template.value());
+    EXPECT_TRUE(new_key_result.ok()) << new_key_result.status();
+  }
+}
+
 TEST(AeadKeyTemplatesTest, testAesGcmSivKeyTemplates) {
   std::string type_url = "type.googleapis.com/google.crypto.tink.AesGcmSivKey";
 
@@ -249,6 +351,39 @@ TEST(AeadKeyTemplatesTest, testAesGcmSivKeyTemplates) {
   }
 }
 
+TEST(AeadKeyTemplatesTest, testAegisKeyTemplates) {
+  std::string type_url = "type.googleapis.com/google.crypto.tink.AegisKey";
+  AegisKeyManager key_type_manager;
+  auto key_manager = internal::MakeKeyManager<Aead>(&key_type_manager);
+
+  {  // Test Aegis128L().
+    const KeyTemplate& key_template = AeadKeyTemplates::Aegis128L();
+    EXPECT_EQ(type_url, key_template.type_url());
+    EXPECT_EQ(OutputPrefixType::TINK, key_template.output_prefix_type());
+    AegisKeyFormat key_format;
+    EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+    EXPECT_EQ(16, key_format.key_size());
+    EXPECT_EQ(&key_template, &AeadKeyTemplates::Aegis128L());
+    EXPECT_EQ(key_manager->get_key_type(), key_template.type_url());
+    auto new_key_result =
+        key_manager->get_key_factory().NewKey(key_template.value());
+    EXPECT_TRUE(new_key_result.ok()) << new_key_result.status();
+  }
+
+  {  // Test Aegis256().
+    const KeyTemplate& key_template = AeadKeyTemplates::Aegis256();
+    EXPECT_EQ(type_url, key_template.type_url());
+    EXPECT_EQ(OutputPrefixType::TINK, key_template.output_prefix_type());
+    AegisKeyFormat key_format;
+    EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+    EXPECT_EQ(32, key_format.key_size());
+    EXPECT_EQ(&key_template, &AeadKeyTemplates::Aegis256());
+    auto new_key_result =
+        key_manager->get_key_factory().NewKey(key_template.value());
+    EXPECT_TRUE(new_key_result.ok()) << new_key_result.status();
+  }
+}
+
 TEST(AeadKeyTemplatesTest, testAesCtrHmacAeadKeyTemplates) {
   std::string type_url =
       "type.googleapis.com/google.crypto.tink.AesCtrHmacAeadKey";
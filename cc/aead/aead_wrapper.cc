@@ -16,9 +16,21 @@
 
 #include "tink/aead/aead_wrapper.h"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/strip.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "absl/types/span.h"
 #include "tink/aead.h"
 #include "tink/crypto_format.h"
+#include "tink/internal/monitored_operation.h"
 #include "tink/primitive_set.h"
+#include "tink/space_used.h"
+#include "tink/subtle/subtle_util.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -39,7 +51,7 @@ util::Status Validate(PrimitiveSet<Aead>* aead_set) {
   return util::Status::OK;
 }
 
-class AeadSetWrapper : public Aead {
+class AeadSetWrapper : public Aead, public SpaceUsedInterface {
  public:
   explicit AeadSetWrapper(std::unique_ptr<PrimitiveSet<Aead>> aead_set)
       : aead_set_(std::move(aead_set)) {}
@@ -52,12 +64,102 @@ class AeadSetWrapper : public Aead {
       absl::string_view ciphertext,
       absl::string_view associated_data) const override;
 
+  crypto::tink::util::StatusOr<std::string> DecryptWithKeyId(
+      absl::string_view ciphertext, absl::string_view associated_data,
+      uint32_t key_id) const override;
+
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override;
+
+  crypto::tink::util::StatusOr<int64_t> EncryptInto(
+      absl::string_view plaintext, absl::string_view associated_data,
+      absl::Span<char> ciphertext_buffer) const override;
+
+  crypto::tink::util::StatusOr<int64_t> DecryptInto(
+      absl::string_view ciphertext, absl::string_view associated_data,
+      absl::Span<char> plaintext_buffer) const override;
+
+  crypto::tink::util::Status VerifyCiphertext(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::Status EncryptBatchInto(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::Span<const absl::string_view> associated_data,
+      absl::Span<const absl::Span<char>> ciphertext_buffers) const override;
+
+  size_t SpaceUsed() const override {
+    return sizeof(*this) + aead_set_->SpaceUsed();
+  }
+
   ~AeadSetWrapper() override {}
 
- private:
+ protected:
+  // Runs 'try_entry' (called as try_entry(aead, raw_ciphertext)) with the
+  // entries whose identifier 'ciphertext' starts with, and then with the RAW
+  // entries, in their adaptive order, until one of them returns an OK
+  // result.  Returns that result, or absl::nullopt if no entry succeeded.
+  // Each entry gets 'ciphertext' without its identifier.
+  template <typename Result, typename TryEntry>
+  absl::optional<Result> TryEntries(absl::string_view ciphertext,
+                                    internal::MonitoredOperation* operation,
+                                    const TryEntry& try_entry) const;
+
   std::unique_ptr<PrimitiveSet<Aead>> aead_set_;
 };
 
+template <typename Result, typename TryEntry>
+absl::optional<Result> AeadSetWrapper::TryEntries(
+    absl::string_view ciphertext, internal::MonitoredOperation* operation,
+    const TryEntry& try_entry) const {
+  // Tries the entries with 'identifier' on 'raw_ciphertext', and returns
+  // true if one of them succeeded with 'result'.
+  auto try_list = [&](absl::string_view identifier,
+                      const PrimitiveSet<Aead>::Primitives& entries,
+                      absl::string_view raw_ciphertext,
+                      absl::optional<Result>* result) {
+    size_t first = aead_set_->preferred_index(identifier);
+    for (size_t i = 0; i < entries.size(); i++) {
+      auto& aead_entry =
+          entries[PrimitiveSet<Aead>::AdaptiveOrderIndex(first, i)];
+      operation->KeyTried();
+      Result entry_result =
+          try_entry(aead_entry->get_primitive(), raw_ciphertext);
+      if (entry_result.ok()) {
+        operation->Succeeded(aead_entry->get_key_id());
+        aead_set_->RecordSuccess(aead_entry.get());
+        *result = std::move(entry_result);
+        return true;
+      }
+    }
+    return false;
+  };
+
+  absl::optional<Result> result;
+  if (ciphertext.length() > CryptoFormat::kNonRawPrefixSize) {
+    absl::string_view key_id =
+        ciphertext.substr(0, CryptoFormat::kNonRawPrefixSize);
+    auto primitives_result = aead_set_->get_primitives(key_id);
+    if (primitives_result.ok() &&
+        try_list(key_id, *primitives_result.ValueOrDie(),
+                 ciphertext.substr(CryptoFormat::kNonRawPrefixSize),
+                 &result)) {
+      return result;
+    }
+  }
+
+  // No matching key succeeded, try all RAW keys.
+  auto raw_primitives_result = aead_set_->get_raw_primitives();
+  if (raw_primitives_result.ok()) {
+    operation->RawKeysTried();
+    if (try_list(CryptoFormat::kRawPrefix, *raw_primitives_result.ValueOrDie(),
+                 ciphertext, &result)) {
+      return result;
+    }
+  }
+  return absl::nullopt;
+}
+
 util::StatusOr<std::string> AeadSetWrapper::Encrypt(
     absl::string_view plaintext, absl::string_view associated_data) const {
   // BoringSSL expects a non-null pointer for plaintext and additional_data,
@@ -65,11 +167,28 @@ util::StatusOr<std::string> AeadSetWrapper::Encrypt(
   plaintext = subtle::SubtleUtilBoringSSL::EnsureNonNull(plaintext);
   associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
 
-  auto encrypt_result = aead_set_->get_primary()->get_primitive()
-      .Encrypt(plaintext, associated_data);
+  const Aead& primary = aead_set_->get_primary()->get_primitive();
+  absl::string_view key_id = aead_set_->get_primary()->get_identifier();
+  auto ciphertext_size_result = primary.CiphertextSize(plaintext.size());
+  if (ciphertext_size_result.ok()) {
+    // The primary encrypts directly behind the prefix, so that the
+    // ciphertext is allocated and written only once.
+    std::string result;
+    subtle::ResizeStringUninitialized(
+        &result, key_id.size() + ciphertext_size_result.ValueOrDie());
+    auto written_result = EncryptInto(
+        plaintext, associated_data, absl::MakeSpan(&result[0], result.size()));
+    if (!written_result.ok()) return written_result.status();
+    result.resize(written_result.ValueOrDie());
+    return result;
+  }
+
+  internal::MonitoredOperation operation("aead", "encrypt");
+  operation.KeyTried();
+  auto encrypt_result = primary.Encrypt(plaintext, associated_data);
   if (!encrypt_result.ok()) return encrypt_result.status();
-  const std::string& key_id = aead_set_->get_primary()->get_identifier();
-  return key_id + encrypt_result.ValueOrDie();
+  operation.Succeeded(aead_set_->get_primary()->get_key_id());
+  return absl::StrCat(key_id, encrypt_result.ValueOrDie());
 }
 
 util::StatusOr<std::string> AeadSetWrapper::Decrypt(
@@ -78,46 +197,259 @@ util::StatusOr<std::string> AeadSetWrapper::Decrypt(
   // regardless of whether the size is 0.
   associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
 
-  if (ciphertext.length() > CryptoFormat::kNonRawPrefixSize) {
-    absl::string_view key_id =
-        ciphertext.substr(0, CryptoFormat::kNonRawPrefixSize);
-    auto primitives_result = aead_set_->get_primitives(key_id);
-    if (primitives_result.ok()) {
-      absl::string_view raw_ciphertext =
-          ciphertext.substr(CryptoFormat::kNonRawPrefixSize);
-      for (auto& aead_entry : *(primitives_result.ValueOrDie())) {
-        Aead& aead = aead_entry->get_primitive();
-        auto decrypt_result = aead.Decrypt(raw_ciphertext, associated_data);
-        if (decrypt_result.ok()) {
-          return std::move(decrypt_result.ValueOrDie());
-        } else {
-          // LOG that a matching key didn't decrypt the ciphertext.
-        }
-      }
+  internal::MonitoredOperation operation("aead", "decrypt");
+  auto result = TryEntries<util::StatusOr<std::string>>(
+      ciphertext, &operation,
+      [associated_data](const Aead& aead, absl::string_view raw_ciphertext) {
+        return aead.Decrypt(raw_ciphertext, associated_data);
+      });
+  if (result.has_value()) return *std::move(result);
+  return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
+}
+
+util::StatusOr<std::string> AeadSetWrapper::DecryptWithKeyId(
+    absl::string_view ciphertext, absl::string_view associated_data,
+    uint32_t key_id) const {
+  associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+
+  internal::MonitoredOperation operation("aead", "decrypt");
+  auto entry_result = aead_set_->get_primitive_by_key_id(key_id);
+  if (!entry_result.ok()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        absl::StrCat("No key with id ", key_id));
+  }
+  const PrimitiveSet<Aead>::Entry<Aead>& entry = *entry_result.ValueOrDie();
+  if (absl::ConsumePrefix(&ciphertext, entry.get_identifier())) {
+    operation.KeyTried();
+    auto decrypt_result =
+        entry.get_primitive().Decrypt(ciphertext, associated_data);
+    if (decrypt_result.ok()) {
+      operation.Succeeded(key_id);
+      return decrypt_result;
     }
   }
+  return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
+}
 
-  // No matching key succeeded with decryption, try all RAW keys.
-  auto raw_primitives_result = aead_set_->get_raw_primitives();
-  if (raw_primitives_result.ok()) {
-    for (auto& aead_entry : *(raw_primitives_result.ValueOrDie())) {
-      Aead& aead = aead_entry->get_primitive();
-      auto decrypt_result = aead.Decrypt(ciphertext, associated_data);
-      if (decrypt_result.ok()) {
-        return std::move(decrypt_result.ValueOrDie());
-      }
+util::StatusOr<int64_t> AeadSetWrapper::CiphertextSize(
+    int64_t plaintext_size) const {
+  auto ciphertext_size_result =
+      aead_set_->get_primary()->get_primitive().CiphertextSize(plaintext_size);
+  if (!ciphertext_size_result.ok()) return ciphertext_size_result.status();
+  return aead_set_->get_primary()->get_identifier().size() +
+         ciphertext_size_result.ValueOrDie();
+}
+
+util::StatusOr<int64_t> AeadSetWrapper::EncryptInto(
+    absl::string_view plaintext, absl::string_view associated_data,
+    absl::Span<char> ciphertext_buffer) const {
+  plaintext = subtle::SubtleUtilBoringSSL::EnsureNonNull(plaintext);
+  associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+
+  absl::string_view key_id = aead_set_->get_primary()->get_identifier();
+  if (ciphertext_buffer.size() < key_id.size()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Ciphertext buffer too small");
+  }
+  internal::MonitoredOperation operation("aead", "encrypt");
+  operation.KeyTried();
+  std::copy(key_id.begin(), key_id.end(), ciphertext_buffer.begin());
+  auto written_result =
+      aead_set_->get_primary()->get_primitive().EncryptInto(
+          plaintext, associated_data,
+          ciphertext_buffer.subspan(key_id.size()));
+  if (!written_result.ok()) return written_result.status();
+  operation.Succeeded(aead_set_->get_primary()->get_key_id());
+  return key_id.size() + written_result.ValueOrDie();
+}
+
+util::StatusOr<int64_t> AeadSetWrapper::DecryptInto(
+    absl::string_view ciphertext, absl::string_view associated_data,
+    absl::Span<char> plaintext_buffer) const {
+  associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+
+  internal::MonitoredOperation operation("aead", "decrypt");
+  auto result = TryEntries<util::StatusOr<int64_t>>(
+      ciphertext, &operation,
+      [associated_data, plaintext_buffer](const Aead& aead,
+                                          absl::string_view raw_ciphertext) {
+        return aead.DecryptInto(raw_ciphertext, associated_data,
+                                plaintext_buffer);
+      });
+  if (result.has_value()) return *std::move(result);
+  return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
+}
+
+util::Status AeadSetWrapper::VerifyCiphertext(
+    absl::string_view ciphertext, absl::string_view associated_data) const {
+  associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+
+  internal::MonitoredOperation operation("aead", "verify");
+  auto result = TryEntries<util::Status>(
+      ciphertext, &operation,
+      [associated_data](const Aead& aead, absl::string_view raw_ciphertext) {
+        return aead.VerifyCiphertext(raw_ciphertext, associated_data);
+      });
+  if (result.has_value()) return *std::move(result);
+  return util::Status(util::error::INVALID_ARGUMENT, "verification failed");
+}
+
+util::Status AeadSetWrapper::EncryptBatchInto(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::Span<const absl::string_view> associated_data,
+    absl::Span<const absl::Span<char>> ciphertext_buffers) const {
+  absl::string_view key_id = aead_set_->get_primary()->get_identifier();
+  // Hand the primary the part of every buffer behind the prefix, so that
+  // it can encrypt the whole batch in one call.
+  std::vector<absl::Span<char>> raw_buffers;
+  raw_buffers.reserve(ciphertext_buffers.size());
+  for (absl::Span<char> buffer : ciphertext_buffers) {
+    if (buffer.size() < key_id.size()) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Ciphertext buffer too small");
+    }
+    std::copy(key_id.begin(), key_id.end(), buffer.begin());
+    raw_buffers.push_back(buffer.subspan(key_id.size()));
+  }
+  std::vector<absl::string_view> non_null_plaintexts;
+  non_null_plaintexts.reserve(plaintexts.size());
+  for (absl::string_view plaintext : plaintexts) {
+    non_null_plaintexts.push_back(
+        subtle::SubtleUtilBoringSSL::EnsureNonNull(plaintext));
+  }
+  std::vector<absl::string_view> non_null_associated_data;
+  non_null_associated_data.reserve(associated_data.size());
+  for (absl::string_view data : associated_data) {
+    non_null_associated_data.push_back(
+        subtle::SubtleUtilBoringSSL::EnsureNonNull(data));
+  }
+  internal::MonitoredOperation operation("aead", "encrypt_batch");
+  operation.KeyTried();
+  util::Status status =
+      aead_set_->get_primary()->get_primitive().EncryptBatchInto(
+          non_null_plaintexts, non_null_associated_data, raw_buffers);
+  if (status.ok()) operation.Succeeded(aead_set_->get_primary()->get_key_id());
+  return status;
+}
+
+// The wrapper of a set with a single key, the primary, as most keysets
+// are between key rotations.  Decryption goes straight to the primitive of
+// the key, which is kept at hand with its prefix, instead of looking up the
+// prefix of every ciphertext in the set.  Encryption only ever uses the
+// primary, and is inherited.
+class SingleKeyAeadWrapper : public AeadSetWrapper {
+ public:
+  explicit SingleKeyAeadWrapper(std::unique_ptr<PrimitiveSet<Aead>> aead_set)
+      : AeadSetWrapper(std::move(aead_set)),
+        aead_(aead_set_->get_primary()->get_primitive()),
+        prefix_(aead_set_->get_primary()->get_identifier()),
+        key_id_(aead_set_->get_primary()->get_key_id()) {}
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<int64_t> DecryptInto(
+      absl::string_view ciphertext, absl::string_view associated_data,
+      absl::Span<char> plaintext_buffer) const override;
+
+  crypto::tink::util::Status VerifyCiphertext(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override;
+
+  size_t SpaceUsed() const override {
+    return sizeof(*this) + aead_set_->SpaceUsed();
+  }
+
+ private:
+  // Removes the prefix of the key from 'ciphertext'; returns false if
+  // 'ciphertext' was not produced by the key.
+  bool RemovePrefix(absl::string_view* ciphertext,
+                    internal::MonitoredOperation* operation) const;
+
+  const Aead& aead_;
+  const std::string prefix_;
+  const uint32_t key_id_;
+};
+
+bool SingleKeyAeadWrapper::RemovePrefix(
+    absl::string_view* ciphertext,
+    internal::MonitoredOperation* operation) const {
+  if (prefix_.empty()) {
+    operation->RawKeysTried();
+    return true;
+  }
+  // As in AeadSetWrapper, a prefix is only looked for in ciphertexts which
+  // are longer than it.
+  if (ciphertext->length() <= CryptoFormat::kNonRawPrefixSize ||
+      !absl::ConsumePrefix(ciphertext, prefix_)) {
+    return false;
+  }
+  return true;
+}
+
+util::StatusOr<std::string> SingleKeyAeadWrapper::Decrypt(
+    absl::string_view ciphertext, absl::string_view associated_data) const {
+  associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+
+  internal::MonitoredOperation operation("aead", "decrypt");
+  if (RemovePrefix(&ciphertext, &operation)) {
+    operation.KeyTried();
+    auto decrypt_result = aead_.Decrypt(ciphertext, associated_data);
+    if (decrypt_result.ok()) {
+      operation.Succeeded(key_id_);
+      return decrypt_result;
     }
   }
   return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
 }
 
+util::StatusOr<int64_t> SingleKeyAeadWrapper::DecryptInto(
+    absl::string_view ciphertext, absl::string_view associated_data,
+    absl::Span<char> plaintext_buffer) const {
+  associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+
+  internal::MonitoredOperation operation("aead", "decrypt");
+  if (RemovePrefix(&ciphertext, &operation)) {
+    operation.KeyTried();
+    auto decrypt_result =
+        aead_.DecryptInto(ciphertext, associated_data, plaintext_buffer);
+    if (decrypt_result.ok()) {
+      operation.Succeeded(key_id_);
+      return decrypt_result;
+    }
+  }
+  return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
+}
+
+util::Status SingleKeyAeadWrapper::VerifyCiphertext(
+    absl::string_view ciphertext, absl::string_view associated_data) const {
+  associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+
+  internal::MonitoredOperation operation("aead", "verify");
+  if (RemovePrefix(&ciphertext, &operation)) {
+    operation.KeyTried();
+    if (aead_.VerifyCiphertext(ciphertext, associated_data).ok()) {
+      operation.Succeeded(key_id_);
+      return util::Status::OK;
+    }
+  }
+  return util::Status(util::error::INVALID_ARGUMENT, "verification failed");
+}
+
 }  // anonymous namespace
 
 util::StatusOr<std::unique_ptr<Aead>> AeadWrapper::Wrap(
     std::unique_ptr<PrimitiveSet<Aead>> aead_set) const {
   util::Status status = Validate(aead_set.get());
   if (!status.ok()) return status;
-  std::unique_ptr<Aead> aead(new AeadSetWrapper(std::move(aead_set)));
+  aead_set->Freeze();
+  std::unique_ptr<Aead> aead;
+  if (aead_set->get_all().size() == 1) {
+    aead.reset(new SingleKeyAeadWrapper(std::move(aead_set)));
+  } else {
+    aead.reset(new AeadSetWrapper(std::move(aead_set)));
+  }
   return std::move(aead);
 }
 
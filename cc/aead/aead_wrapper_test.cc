@@ -16,17 +16,27 @@
 
 #include "tink/aead/aead_wrapper.h"
 
+#include <algorithm>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/strip.h"
+#include "absl/types/span.h"
 #include "tink/aead.h"
 #include "tink/primitive_set.h"
+#include "tink/util/allocation_counter.h"
+#include "tink/util/inlined_buffer.h"
 #include "tink/util/status.h"
 #include "tink/util/test_matchers.h"
 #include "tink/util/test_util.h"
 #include "proto/tink.pb.h"
 
+using ::crypto::tink::test::AllocationCounter;
 using ::crypto::tink::test::DummyAead;
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
 using ::google::crypto::tink::KeysetInfo;
 using ::google::crypto::tink::KeyStatusType;
 using ::google::crypto::tink::OutputPrefixType;
@@ -35,6 +45,64 @@ namespace crypto {
 namespace tink {
 namespace {
 
+// An Aead that encrypts natively into caller-provided buffers: the
+// "ciphertext" is the name of the Aead followed by the plaintext.
+class BufferDummyAead : public Aead {
+ public:
+  explicit BufferDummyAead(absl::string_view aead_name)
+      : aead_name_(aead_name) {}
+
+  util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override {
+    return absl::StrCat(aead_name_, plaintext);
+  }
+
+  util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override {
+    if (!absl::StartsWith(ciphertext, aead_name_)) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Dummy operation failed.");
+    }
+    return std::string(ciphertext.substr(aead_name_.size()));
+  }
+
+  util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override {
+    return aead_name_.size() + plaintext_size;
+  }
+
+  util::StatusOr<int64_t> EncryptInto(
+      absl::string_view plaintext, absl::string_view associated_data,
+      absl::Span<char> ciphertext_buffer) const override {
+    if (ciphertext_buffer.size() < aead_name_.size() + plaintext.size()) {
+      return util::Status(util::error::INVALID_ARGUMENT, "Buffer too small.");
+    }
+    auto end = std::copy(aead_name_.begin(), aead_name_.end(),
+                         ciphertext_buffer.begin());
+    std::copy(plaintext.begin(), plaintext.end(), end);
+    return aead_name_.size() + plaintext.size();
+  }
+
+  util::StatusOr<int64_t> DecryptInto(
+      absl::string_view ciphertext, absl::string_view associated_data,
+      absl::Span<char> plaintext_buffer) const override {
+    if (!absl::ConsumePrefix(&ciphertext, aead_name_)) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Dummy operation failed.");
+    }
+    if (plaintext_buffer.size() < ciphertext.size()) {
+      return util::Status(util::error::INVALID_ARGUMENT, "Buffer too small.");
+    }
+    std::copy(ciphertext.begin(), ciphertext.end(), plaintext_buffer.begin());
+    return ciphertext.size();
+  }
+
+ private:
+  std::string aead_name_;
+};
+
 TEST(AeadSetWrapperTest, WrapNullptr) {
   AeadWrapper wrapper;
   auto aead_result = wrapper.Wrap(nullptr);
@@ -185,7 +253,322 @@ TEST(AeadSetWrapperTest, DecryptNonPrimary) {
   // should still be decryptable as we have the correct key in the set.
   auto decrypt_result = aead->Decrypt(ciphertext, aad);
   EXPECT_TRUE(decrypt_result.ok()) << decrypt_result.status();
+  EXPECT_THAT(aead->VerifyCiphertext(ciphertext, aad), IsOk());
+  EXPECT_FALSE(aead->VerifyCiphertext(ciphertext, "other aad").ok());
+}
+
+// A BufferDummyAead which counts its decryptions.
+class CountingAead : public BufferDummyAead {
+ public:
+  CountingAead(absl::string_view aead_name, int* decryptions)
+      : BufferDummyAead(aead_name), decryptions_(decryptions) {}
+
+  util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override {
+    (*decryptions_)++;
+    return BufferDummyAead::Decrypt(ciphertext, associated_data);
+  }
+
+ private:
+  int* decryptions_;
+};
+
+std::unique_ptr<Aead> WrapRawAeads(int count, bool adaptive_order,
+                                   int* decryptions) {
+  auto aead_set = absl::make_unique<PrimitiveSet<Aead>>();
+  for (int i = 0; i < count; i++) {
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(OutputPrefixType::RAW);
+    key_info.set_key_id(100 + i);
+    key_info.set_status(KeyStatusType::ENABLED);
+    auto entry_result = aead_set->AddPrimitive(
+        absl::make_unique<CountingAead>(absl::StrCat("aead", i), decryptions),
+        key_info);
+    EXPECT_THAT(entry_result.status(), IsOk());
+    if (i == 0) {
+      EXPECT_THAT(aead_set->set_primary(entry_result.ValueOrDie()), IsOk());
+    }
+  }
+  if (adaptive_order) EXPECT_THAT(aead_set->EnableAdaptiveOrder(), IsOk());
+  return std::move(AeadWrapper().Wrap(std::move(aead_set)).ValueOrDie());
+}
+
+TEST(AeadSetWrapperTest, RawKeysInSetOrder) {
+  int decryptions = 0;
+  std::unique_ptr<Aead> aead = WrapRawAeads(4, false, &decryptions);
+  for (int i = 0; i < 2; i++) {
+    decryptions = 0;
+    EXPECT_THAT(aead->Decrypt("aead3plaintext", "").status(), IsOk());
+    EXPECT_EQ(4, decryptions);
+  }
+}
+
+TEST(AeadSetWrapperTest, RawKeysInAdaptiveOrder) {
+  int decryptions = 0;
+  std::unique_ptr<Aead> aead = WrapRawAeads(4, true, &decryptions);
+  // The primary is tried first.
+  EXPECT_THAT(aead->Decrypt("aead0plaintext", "").status(), IsOk());
+  EXPECT_EQ(1, decryptions);
+
+  decryptions = 0;
+  EXPECT_THAT(aead->Decrypt("aead3plaintext", "").status(), IsOk());
+  EXPECT_EQ(4, decryptions);
+
+  // Then the key which decrypted most recently.
+  decryptions = 0;
+  EXPECT_THAT(aead->Decrypt("aead3plaintext", "").status(), IsOk());
+  EXPECT_EQ(1, decryptions);
+  decryptions = 0;
+  EXPECT_THAT(aead->Decrypt("aead1plaintext", "").status(), IsOk());
+  EXPECT_EQ(3, decryptions);
+}
+
+TEST(AeadSetWrapperTest, EncryptIntoWithNativePrimary) {
+  KeysetInfo::KeyInfo key_info;
+  key_info.set_output_prefix_type(OutputPrefixType::TINK);
+  key_info.set_key_id(1234543);
+  key_info.set_status(KeyStatusType::ENABLED);
+
+  auto aead_set = absl::make_unique<PrimitiveSet<Aead>>();
+  auto entry_result = aead_set->AddPrimitive(
+      absl::make_unique<BufferDummyAead>("aead0"), key_info);
+  ASSERT_THAT(entry_result.status(), IsOk());
+  ASSERT_THAT(aead_set->set_primary(entry_result.ValueOrDie()), IsOk());
+  std::string prefix(aead_set->get_primary()->get_identifier());
+
+  auto aead_result = AeadWrapper().Wrap(std::move(aead_set));
+  ASSERT_THAT(aead_result.status(), IsOk());
+  std::unique_ptr<Aead> aead = std::move(aead_result.ValueOrDie());
+  std::string plaintext = "some_plaintext";
+  std::string aad = "some_aad";
+
+  auto size_result = aead->CiphertextSize(plaintext.size());
+  ASSERT_THAT(size_result.status(), IsOk());
+  EXPECT_EQ(size_result.ValueOrDie(),
+            prefix.size() + std::string("aead0").size() + plaintext.size());
+
+  auto encrypt_result = aead->Encrypt(plaintext, aad);
+  ASSERT_THAT(encrypt_result.status(), IsOk());
+  EXPECT_EQ(encrypt_result.ValueOrDie(), absl::StrCat(prefix, "aead0",
+                                                      plaintext));
+
+  std::string ciphertext(size_result.ValueOrDie(), '\0');
+  auto written_result = aead->EncryptInto(
+      plaintext, aad, absl::MakeSpan(&ciphertext[0], ciphertext.size()));
+  ASSERT_THAT(written_result.status(), IsOk());
+  EXPECT_EQ(written_result.ValueOrDie(), ciphertext.size());
+  EXPECT_EQ(ciphertext, encrypt_result.ValueOrDie());
+
+  std::string decrypted(ciphertext.size(), '\0');
+  written_result = aead->DecryptInto(
+      ciphertext, aad, absl::MakeSpan(&decrypted[0], decrypted.size()));
+  ASSERT_THAT(written_result.status(), IsOk());
+  EXPECT_EQ(decrypted.substr(0, written_result.ValueOrDie()), plaintext);
+
+  EXPECT_FALSE(
+      aead->EncryptInto(plaintext, aad,
+                        absl::MakeSpan(&ciphertext[0], prefix.size() - 1))
+          .ok());
+}
+
+TEST(AeadSetWrapperTest, EncryptIntoWithoutNativePrimary) {
+  KeysetInfo::KeyInfo key_info;
+  key_info.set_output_prefix_type(OutputPrefixType::LEGACY);
+  key_info.set_key_id(726329);
+  key_info.set_status(KeyStatusType::ENABLED);
+
+  auto aead_set = absl::make_unique<PrimitiveSet<Aead>>();
+  auto entry_result =
+      aead_set->AddPrimitive(absl::make_unique<DummyAead>("aead0"), key_info);
+  ASSERT_THAT(entry_result.status(), IsOk());
+  ASSERT_THAT(aead_set->set_primary(entry_result.ValueOrDie()), IsOk());
+
+  auto aead_result = AeadWrapper().Wrap(std::move(aead_set));
+  ASSERT_THAT(aead_result.status(), IsOk());
+  std::unique_ptr<Aead> aead = std::move(aead_result.ValueOrDie());
+  std::string plaintext = "some_plaintext";
+  std::string aad = "some_aad";
+
+  // DummyAead cannot predict its ciphertext size, but the buffer API still
+  // works through the default implementation.
+  EXPECT_FALSE(aead->CiphertextSize(plaintext.size()).ok());
+  std::string ciphertext(100, '\0');
+  auto written_result = aead->EncryptInto(
+      plaintext, aad, absl::MakeSpan(&ciphertext[0], ciphertext.size()));
+  ASSERT_THAT(written_result.status(), IsOk());
+  ciphertext.resize(written_result.ValueOrDie());
+
+  auto decrypt_result = aead->Decrypt(ciphertext, aad);
+  ASSERT_THAT(decrypt_result.status(), IsOk());
+  EXPECT_EQ(decrypt_result.ValueOrDie(), plaintext);
+
+  std::string decrypted(ciphertext.size(), '\0');
+  written_result = aead->DecryptInto(
+      ciphertext, aad, absl::MakeSpan(&decrypted[0], decrypted.size()));
+  ASSERT_THAT(written_result.status(), IsOk());
+  EXPECT_EQ(decrypted.substr(0, written_result.ValueOrDie()), plaintext);
 }
+
+TEST(AeadSetWrapperTest, EncryptBatch) {
+  KeysetInfo::KeyInfo key_info;
+  key_info.set_output_prefix_type(OutputPrefixType::TINK);
+  key_info.set_key_id(1234543);
+  key_info.set_status(KeyStatusType::ENABLED);
+
+  auto aead_set = absl::make_unique<PrimitiveSet<Aead>>();
+  auto entry_result = aead_set->AddPrimitive(
+      absl::make_unique<BufferDummyAead>("aead0"), key_info);
+  ASSERT_THAT(entry_result.status(), IsOk());
+  ASSERT_THAT(aead_set->set_primary(entry_result.ValueOrDie()), IsOk());
+  std::string prefix(aead_set->get_primary()->get_identifier());
+
+  auto aead_result = AeadWrapper().Wrap(std::move(aead_set));
+  ASSERT_THAT(aead_result.status(), IsOk());
+  std::unique_ptr<Aead> aead = std::move(aead_result.ValueOrDie());
+
+  std::vector<absl::string_view> plaintexts = {"first", "", "third"};
+  std::vector<absl::string_view> associated_data = {"ad1", "ad2", "ad3"};
+  std::string arena;
+  std::vector<absl::string_view> ciphertexts;
+  ASSERT_THAT(
+      aead->EncryptBatch(plaintexts, associated_data, &arena, &ciphertexts),
+      IsOk());
+  ASSERT_EQ(ciphertexts.size(), plaintexts.size());
+  for (int i = 0; i < plaintexts.size(); i++) {
+    EXPECT_EQ(ciphertexts[i], absl::StrCat(prefix, "aead0", plaintexts[i]));
+  }
+
+  std::string plaintext_arena;
+  std::vector<absl::string_view> decrypted;
+  ASSERT_THAT(aead->DecryptBatch(ciphertexts, associated_data,
+                                 &plaintext_arena, &decrypted),
+              IsOk());
+  EXPECT_THAT(decrypted, testing::ElementsAre("first", "", "third"));
+}
+
+TEST(AeadSetWrapperTest, SingleKey) {
+  for (OutputPrefixType prefix_type :
+       {OutputPrefixType::TINK, OutputPrefixType::LEGACY,
+        OutputPrefixType::RAW}) {
+    SCOPED_TRACE(prefix_type);
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(prefix_type);
+    key_info.set_key_id(1234543);
+    key_info.set_status(KeyStatusType::ENABLED);
+    auto aead_set = absl::make_unique<PrimitiveSet<Aead>>();
+    auto entry_result = aead_set->AddPrimitive(
+        absl::make_unique<DummyAead>("aead0"), key_info);
+    ASSERT_THAT(entry_result.status(), IsOk());
+    ASSERT_THAT(aead_set->set_primary(entry_result.ValueOrDie()), IsOk());
+    std::string prefix(aead_set->get_primary()->get_identifier());
+
+    auto aead_result = AeadWrapper().Wrap(std::move(aead_set));
+    ASSERT_THAT(aead_result.status(), IsOk());
+    std::unique_ptr<Aead> aead = std::move(aead_result.ValueOrDie());
+    auto encrypt_result = aead->Encrypt("plaintext", "aad");
+    ASSERT_THAT(encrypt_result.status(), IsOk());
+    std::string ciphertext = encrypt_result.ValueOrDie();
+    EXPECT_TRUE(absl::StartsWith(ciphertext, prefix));
+
+    auto decrypt_result = aead->Decrypt(ciphertext, "aad");
+    ASSERT_THAT(decrypt_result.status(), IsOk());
+    EXPECT_EQ("plaintext", decrypt_result.ValueOrDie());
+    std::string decrypted(ciphertext.size(), '\0');
+    auto written_result = aead->DecryptInto(
+        ciphertext, "aad", absl::MakeSpan(&decrypted[0], decrypted.size()));
+    ASSERT_THAT(written_result.status(), IsOk());
+    EXPECT_EQ("plaintext", decrypted.substr(0, written_result.ValueOrDie()));
+
+    EXPECT_FALSE(aead->Decrypt(ciphertext, "other aad").ok());
+    EXPECT_FALSE(aead->Decrypt(prefix, "aad").ok());
+    // A ciphertext of another key, with a different prefix.
+    std::string other_ciphertext = ciphertext;
+    other_ciphertext[prefix.empty() ? 0 : prefix.size() - 1] ^= 1;
+    EXPECT_FALSE(aead->Decrypt(other_ciphertext, "aad").ok());
+
+    EXPECT_THAT(aead->VerifyCiphertext(ciphertext, "aad"), IsOk());
+    EXPECT_FALSE(aead->VerifyCiphertext(ciphertext, "other aad").ok());
+    EXPECT_FALSE(aead->VerifyCiphertext(other_ciphertext, "aad").ok());
+  }
+}
+
+TEST(AeadSetWrapperTest, AllocationBudget) {
+  // With one key the wrapper takes its single-key fast path.
+  for (int num_keys : {1, 2}) {
+    SCOPED_TRACE(num_keys);
+    auto aead_set = absl::make_unique<PrimitiveSet<Aead>>();
+    for (int i = 0; i < num_keys; i++) {
+      KeysetInfo::KeyInfo key_info;
+      key_info.set_output_prefix_type(OutputPrefixType::TINK);
+      key_info.set_key_id(1234543 + i);
+      key_info.set_status(KeyStatusType::ENABLED);
+      auto entry_result = aead_set->AddPrimitive(
+          absl::make_unique<BufferDummyAead>(absl::StrCat("aead", i)),
+          key_info);
+      ASSERT_THAT(entry_result.status(), IsOk());
+      if (i == 0) {
+        ASSERT_THAT(aead_set->set_primary(entry_result.ValueOrDie()), IsOk());
+      }
+    }
+    auto aead_result = AeadWrapper().Wrap(std::move(aead_set));
+    ASSERT_THAT(aead_result.status(), IsOk());
+    const Aead& aead = *aead_result.ValueOrDie();
+    std::string plaintext = "some plaintext";
+
+    util::InlinedBuffer<64> ciphertext;
+    AllocationCounter counter;
+    util::Status status = aead.Encrypt(plaintext, "aad", &ciphertext);
+    int64_t allocations = counter.count();
+    ASSERT_THAT(status, IsOk());
+    EXPECT_EQ(allocations, 0);
+
+    util::InlinedBuffer<64> decrypted;
+    counter.Reset();
+    status = aead.Decrypt(ciphertext.AsStringView(), "aad", &decrypted);
+    allocations = counter.count();
+    ASSERT_THAT(status, IsOk());
+    EXPECT_EQ(allocations, 0);
+    EXPECT_EQ(decrypted.AsStringView(), plaintext);
+
+    // Only the returned ciphertext is allocated.
+    counter.Reset();
+    auto encrypt_result = aead.Encrypt(plaintext, "aad");
+    allocations = counter.count();
+    ASSERT_THAT(encrypt_result.status(), IsOk());
+    EXPECT_EQ(allocations, 1);
+  }
+}
+
+TEST(AeadSetWrapperTest, DecryptWithKeyId) {
+  auto aead_set = absl::make_unique<PrimitiveSet<Aead>>();
+  for (uint32_t key_id : {10, 11, 12}) {
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(OutputPrefixType::RAW);
+    key_info.set_key_id(key_id);
+    key_info.set_status(KeyStatusType::ENABLED);
+    auto entry_result = aead_set->AddPrimitive(
+        absl::make_unique<DummyAead>(absl::StrCat("aead", key_id)), key_info);
+    ASSERT_THAT(entry_result.status(), IsOk());
+    if (key_id == 11) {
+      ASSERT_THAT(aead_set->set_primary(entry_result.ValueOrDie()), IsOk());
+    }
+  }
+  auto aead_result = AeadWrapper().Wrap(std::move(aead_set));
+  ASSERT_THAT(aead_result.status(), IsOk());
+  std::unique_ptr<Aead> aead = std::move(aead_result.ValueOrDie());
+  std::string ciphertext = aead->Encrypt("plaintext", "aad").ValueOrDie();
+
+  auto decrypt_result = aead->DecryptWithKeyId(ciphertext, "aad", 11);
+  ASSERT_THAT(decrypt_result.status(), IsOk());
+  EXPECT_EQ("plaintext", decrypt_result.ValueOrDie());
+  // Only the hinted key is tried.
+  EXPECT_FALSE(aead->DecryptWithKeyId(ciphertext, "aad", 10).ok());
+  EXPECT_FALSE(aead->DecryptWithKeyId(ciphertext, "other aad", 11).ok());
+  EXPECT_THAT(aead->DecryptWithKeyId(ciphertext, "aad", 13).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
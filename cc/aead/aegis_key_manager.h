@@ -0,0 +1,132 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef TINK_AEAD_AEGIS_KEY_MANAGER_H_
+#define TINK_AEAD_AEGIS_KEY_MANAGER_H_
+
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/aead.h"
+#include "tink/aead/cord_aead.h"
+#include "tink/aead/internal/cord_aead_from_aead.h"
+#include "tink/core/key_type_manager.h"
+#include "tink/subtle/aegis.h"
+#include "tink/subtle/cpu_features.h"
+#include "tink/subtle/random.h"
+#include "tink/util/constants.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/aegis.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// Key manager for AEGIS-128L (16 byte keys) and AEGIS-256 (32 byte keys).
+// The primitives can only be created on CPUs with AES instructions, see
+// subtle::Aegis; the manager is therefore not registered by
+// AeadConfig::Register(), but by AeadConfig::RegisterAegis().
+class AegisKeyManager
+    : public KeyTypeManager<google::crypto::tink::AegisKey,
+                            google::crypto::tink::AegisKeyFormat,
+                            List<Aead, CordAead>> {
+ public:
+  class AeadFactory : public PrimitiveFactory<Aead> {
+    crypto::tink::util::StatusOr<std::unique_ptr<Aead>> Create(
+        const google::crypto::tink::AegisKey& key) const override {
+      return NewAead(util::SecretDataFromStringView(key.key_value()));
+    }
+  };
+  class CordAeadFactory : public PrimitiveFactory<CordAead> {
+    crypto::tink::util::StatusOr<std::unique_ptr<CordAead>> Create(
+        const google::crypto::tink::AegisKey& key) const override {
+      auto aead_result =
+          NewAead(util::SecretDataFromStringView(key.key_value()));
+      if (!aead_result.ok()) return aead_result.status();
+      return {absl::make_unique<CordAeadFromAead>(
+          std::move(aead_result.ValueOrDie()))};
+    }
+  };
+
+  AegisKeyManager()
+      : KeyTypeManager(absl::make_unique<AeadFactory>(),
+                       absl::make_unique<CordAeadFactory>()) {}
+
+  uint32_t get_version() const override { return 0; }
+
+  google::crypto::tink::KeyData::KeyMaterialType key_material_type()
+      const override {
+    return google::crypto::tink::KeyData::SYMMETRIC;
+  }
+
+  const std::string& get_key_type() const override { return key_type_; }
+
+  crypto::tink::util::Status ValidateKey(
+      const google::crypto::tink::AegisKey& key) const override {
+    crypto::tink::util::Status status =
+        ValidateVersion(key.version(), get_version());
+    if (!status.ok()) return status;
+    return ValidateKeySize(key.key_value().size());
+  }
+
+  crypto::tink::util::Status ValidateKeyFormat(
+      const google::crypto::tink::AegisKeyFormat& format) const override {
+    return ValidateKeySize(format.key_size());
+  }
+
+  crypto::tink::util::StatusOr<google::crypto::tink::AegisKey> CreateKey(
+      const google::crypto::tink::AegisKeyFormat& format) const override {
+    google::crypto::tink::AegisKey key;
+    key.set_version(get_version());
+    key.set_key_value(subtle::Random::GetRandomBytes(format.key_size()));
+    return key;
+  }
+
+  FipsCompatibility FipsStatus() const override {
+    return FipsCompatibility::kNotFips;
+  }
+
+ private:
+  static crypto::tink::util::Status ValidateKeySize(uint32_t key_size) {
+    if (!subtle::Aegis::IsValidKeySizeInBytes(key_size)) {
+      return crypto::tink::util::Status(
+          util::error::INVALID_ARGUMENT,
+          absl::StrCat("Invalid AEGIS key size: ", key_size,
+                       " bytes, only 16 and 32 bytes are supported."));
+    }
+    return util::OkStatus();
+  }
+
+  static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> NewAead(
+      const util::SecretData& key) {
+#if defined(__aarch64__)
+    subtle::RecordImplementation("Aegis", "armv8");
+#else
+    subtle::RecordImplementation("Aegis", "aesni");
+#endif
+    return subtle::Aegis::New(key);
+  }
+
+  const std::string key_type_ = absl::StrCat(
+      kTypeGoogleapisCom, google::crypto::tink::AegisKey().GetTypeName());
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_AEAD_AEGIS_KEY_MANAGER_H_
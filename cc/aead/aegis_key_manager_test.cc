@@ -0,0 +1,130 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/aegis_key_manager.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/aead_test_util.h"
+#include "tink/subtle/aegis.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/aegis.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::crypto::tink::util::StatusOr;
+using ::google::crypto::tink::AegisKey;
+using ::google::crypto::tink::AegisKeyFormat;
+using ::testing::Eq;
+
+TEST(AegisKeyManagerTest, Basics) {
+  EXPECT_THAT(AegisKeyManager().get_version(), Eq(0));
+  EXPECT_THAT(AegisKeyManager().get_key_type(),
+              Eq("type.googleapis.com/google.crypto.tink.AegisKey"));
+  EXPECT_THAT(AegisKeyManager().key_material_type(),
+              Eq(google::crypto::tink::KeyData::SYMMETRIC));
+}
+
+TEST(AegisKeyManagerTest, ValidateKey) {
+  AegisKey key;
+  EXPECT_THAT(AegisKeyManager().ValidateKey(key),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  for (int key_size : {16, 32}) {
+    key.set_key_value(std::string(key_size, 'k'));
+    EXPECT_THAT(AegisKeyManager().ValidateKey(key), IsOk());
+  }
+  for (int key_size : {1, 15, 17, 24, 31, 33}) {
+    key.set_key_value(std::string(key_size, 'k'));
+    EXPECT_THAT(AegisKeyManager().ValidateKey(key),
+                StatusIs(util::error::INVALID_ARGUMENT));
+  }
+  key.set_key_value(std::string(16, 'k'));
+  key.set_version(1);
+  EXPECT_THAT(AegisKeyManager().ValidateKey(key),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(AegisKeyManagerTest, ValidateKeyFormat) {
+  AegisKeyFormat format;
+  for (int key_size : {0, 1, 15, 17, 24, 31, 33}) {
+    format.set_key_size(key_size);
+    EXPECT_THAT(AegisKeyManager().ValidateKeyFormat(format),
+                StatusIs(util::error::INVALID_ARGUMENT));
+  }
+  for (int key_size : {16, 32}) {
+    format.set_key_size(key_size);
+    EXPECT_THAT(AegisKeyManager().ValidateKeyFormat(format), IsOk());
+  }
+}
+
+TEST(AegisKeyManagerTest, CreateKey) {
+  for (int key_size : {16, 32}) {
+    AegisKeyFormat format;
+    format.set_key_size(key_size);
+    StatusOr<AegisKey> key_or = AegisKeyManager().CreateKey(format);
+    ASSERT_THAT(key_or.status(), IsOk());
+    EXPECT_THAT(key_or.ValueOrDie().version(), Eq(0));
+    EXPECT_THAT(key_or.ValueOrDie().key_value().size(), Eq(key_size));
+    EXPECT_THAT(AegisKeyManager().ValidateKey(key_or.ValueOrDie()), IsOk());
+  }
+}
+
+TEST(AegisKeyManagerTest, CreateAead) {
+  if (kUseOnlyFips || !subtle::Aegis::IsSupported()) {
+    GTEST_SKIP() << "AEGIS is not supported";
+  }
+  for (int key_size : {16, 32}) {
+    AegisKeyFormat format;
+    format.set_key_size(key_size);
+    StatusOr<AegisKey> key_or = AegisKeyManager().CreateKey(format);
+    ASSERT_THAT(key_or.status(), IsOk());
+
+    StatusOr<std::unique_ptr<Aead>> aead_or =
+        AegisKeyManager().GetPrimitive<Aead>(key_or.ValueOrDie());
+    ASSERT_THAT(aead_or.status(), IsOk());
+    StatusOr<std::unique_ptr<Aead>> direct_aead_or = subtle::Aegis::New(
+        util::SecretDataFromStringView(key_or.ValueOrDie().key_value()));
+    ASSERT_THAT(direct_aead_or.status(), IsOk());
+
+    EXPECT_THAT(EncryptThenDecrypt(*aead_or.ValueOrDie(),
+                                   *direct_aead_or.ValueOrDie(), "message",
+                                   "aad"),
+                IsOk());
+  }
+}
+
+TEST(AegisKeyManagerTest, CreateAeadUnsupported) {
+  if (kUseOnlyFips || subtle::Aegis::IsSupported()) {
+    GTEST_SKIP() << "Only fails where AEGIS is not supported";
+  }
+  AegisKey key;
+  key.set_key_value(std::string(16, 'k'));
+  EXPECT_THAT(AegisKeyManager().GetPrimitive<Aead>(key).status(),
+              StatusIs(util::error::UNIMPLEMENTED));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
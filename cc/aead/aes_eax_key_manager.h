@@ -20,7 +20,9 @@
 #include "absl/strings/str_cat.h"
 #include "tink/aead.h"
 #include "tink/core/key_type_manager.h"
+#include "tink/subtle/aes_eax_aesni.h"
 #include "tink/subtle/aes_eax_boringssl.h"
+#include "tink/subtle/cpu_features.h"
 #include "tink/subtle/random.h"
 #include "tink/util/constants.h"
 #include "tink/util/errors.h"
@@ -41,6 +43,17 @@ class AesEaxKeyManager
   class AeadFactory : public PrimitiveFactory<Aead> {
     crypto::tink::util::StatusOr<std::unique_ptr<Aead>> Create(
         const google::crypto::tink::AesEaxKey& key) const override {
+#if defined(__SSE4_1__) && defined(__AES__)
+      // Both implementations produce the same ciphertexts; the AESNI one
+      // keeps the CTR and OMAC computations in registers.
+      if (subtle::UseAesniImplementations()) {
+        subtle::RecordImplementation("AesEax", "aesni");
+        return subtle::AesEaxAesni::New(
+            util::SecretDataFromStringView(key.key_value()),
+            key.params().iv_size());
+      }
+#endif
+      subtle::RecordImplementation("AesEax", "boringssl");
       return subtle::AesEaxBoringSsl::New(
           util::SecretDataFromStringView(key.key_value()),
           key.params().iv_size());
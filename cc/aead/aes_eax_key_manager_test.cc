@@ -18,6 +18,7 @@
 #include "gtest/gtest.h"
 #include "tink/aead.h"
 #include "tink/subtle/aead_test_util.h"
+#include "tink/subtle/cpu_features.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -31,9 +32,11 @@ using ::crypto::tink::test::IsOk;
 using ::crypto::tink::util::StatusOr;
 using ::google::crypto::tink::AesEaxKey;
 using ::google::crypto::tink::AesEaxKeyFormat;
+using ::testing::Contains;
 using ::testing::Eq;
 using ::testing::Ne;
 using ::testing::Not;
+using ::testing::Pair;
 using ::testing::SizeIs;
 
 namespace {
@@ -190,6 +193,37 @@ TEST(AesGcmKeyManagerTest, CreateAead) {
               IsOk());
 }
 
+TEST(AesEaxKeyManagerTest, DispatchPolicy) {
+  AesEaxKeyFormat format;
+  format.set_key_size(16);
+  format.mutable_params()->set_iv_size(12);
+  StatusOr<AesEaxKey> key_or = AesEaxKeyManager().CreateKey(format);
+  ASSERT_THAT(key_or.status(), IsOk());
+
+  StatusOr<std::unique_ptr<Aead>> fastest_or =
+      AesEaxKeyManager().GetPrimitive<Aead>(key_or.ValueOrDie());
+  ASSERT_THAT(fastest_or.status(), IsOk());
+  EXPECT_THAT(subtle::GetChosenImplementations(),
+              Contains(Pair("AesEax", subtle::UseAesniImplementations()
+                                          ? "aesni"
+                                          : "boringssl")));
+
+  subtle::SetDispatchPolicy(subtle::DispatchPolicy::kPortableOnly);
+  StatusOr<std::unique_ptr<Aead>> portable_or =
+      AesEaxKeyManager().GetPrimitive<Aead>(key_or.ValueOrDie());
+  subtle::SetDispatchPolicy(subtle::DispatchPolicy::kFastest);
+  ASSERT_THAT(portable_or.status(), IsOk());
+  EXPECT_THAT(subtle::GetChosenImplementations(),
+              Contains(Pair("AesEax", "boringssl")));
+
+  ASSERT_THAT(EncryptThenDecrypt(*fastest_or.ValueOrDie(),
+                                 *portable_or.ValueOrDie(), "message", "aad"),
+              IsOk());
+  ASSERT_THAT(EncryptThenDecrypt(*portable_or.ValueOrDie(),
+                                 *fastest_or.ValueOrDie(), "message", "aad"),
+              IsOk());
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
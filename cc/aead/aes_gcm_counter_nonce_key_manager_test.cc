@@ -0,0 +1,138 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/aes_gcm_counter_nonce_key_manager.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/aead.h"
+#include "tink/subtle/aead_test_util.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/aes_gcm_counter_nonce.pb.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::crypto::tink::util::StatusOr;
+using ::google::crypto::tink::AesGcmCounterNonceKey;
+using ::google::crypto::tink::AesGcmCounterNonceKeyFormat;
+using ::testing::Eq;
+using ::testing::Ne;
+
+TEST(AesGcmCounterNonceKeyManagerTest, Basics) {
+  EXPECT_THAT(AesGcmCounterNonceKeyManager().get_version(), Eq(0));
+  EXPECT_THAT(
+      AesGcmCounterNonceKeyManager().get_key_type(),
+      Eq("type.googleapis.com/google.crypto.tink.AesGcmCounterNonceKey"));
+  EXPECT_THAT(AesGcmCounterNonceKeyManager().key_material_type(),
+              Eq(google::crypto::tink::KeyData::SYMMETRIC));
+}
+
+TEST(AesGcmCounterNonceKeyManagerTest, ValidateKey) {
+  AesGcmCounterNonceKey key;
+  EXPECT_THAT(AesGcmCounterNonceKeyManager().ValidateKey(key),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  for (int key_size : {15, 16, 17, 24, 31, 32, 33}) {
+    key.set_key_value(std::string(key_size, 'x'));
+    if (key_size == 16 || key_size == 32) {
+      EXPECT_THAT(AesGcmCounterNonceKeyManager().ValidateKey(key), IsOk());
+    } else {
+      EXPECT_THAT(AesGcmCounterNonceKeyManager().ValidateKey(key),
+                  StatusIs(util::error::INVALID_ARGUMENT))
+          << key_size;
+    }
+  }
+  key.set_key_value(std::string(16, 'x'));
+  key.set_version(1);
+  EXPECT_THAT(AesGcmCounterNonceKeyManager().ValidateKey(key),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(AesGcmCounterNonceKeyManagerTest, ValidateKeyFormat) {
+  AesGcmCounterNonceKeyFormat format;
+  for (int key_size : {0, 1, 15, 16, 17, 31, 32, 33}) {
+    format.set_key_size(key_size);
+    if (key_size == 16 || key_size == 32) {
+      EXPECT_THAT(AesGcmCounterNonceKeyManager().ValidateKeyFormat(format),
+                  IsOk());
+    } else {
+      EXPECT_THAT(AesGcmCounterNonceKeyManager().ValidateKeyFormat(format),
+                  StatusIs(util::error::INVALID_ARGUMENT))
+          << key_size;
+    }
+  }
+}
+
+TEST(AesGcmCounterNonceKeyManagerTest, CreateKey) {
+  AesGcmCounterNonceKeyFormat format;
+  format.set_key_size(32);
+  StatusOr<AesGcmCounterNonceKey> key_or =
+      AesGcmCounterNonceKeyManager().CreateKey(format);
+  ASSERT_THAT(key_or.status(), IsOk());
+  EXPECT_THAT(key_or.ValueOrDie().key_value().size(), Eq(format.key_size()));
+  EXPECT_THAT(AesGcmCounterNonceKeyManager().ValidateKey(key_or.ValueOrDie()),
+              IsOk());
+}
+
+TEST(AesGcmCounterNonceKeyManagerTest, CreateAead) {
+  AesGcmCounterNonceKeyFormat format;
+  format.set_key_size(16);
+  StatusOr<AesGcmCounterNonceKey> key_or =
+      AesGcmCounterNonceKeyManager().CreateKey(format);
+  ASSERT_THAT(key_or.status(), IsOk());
+
+  StatusOr<std::unique_ptr<Aead>> aead_or =
+      AesGcmCounterNonceKeyManager().GetPrimitive<Aead>(key_or.ValueOrDie());
+  ASSERT_THAT(aead_or.status(), IsOk());
+
+  // The ciphertexts are AES-GCM ciphertexts.
+  StatusOr<std::unique_ptr<Aead>> boring_ssl_aead_or =
+      subtle::AesGcmBoringSsl::New(
+          util::SecretDataFromStringView(key_or.ValueOrDie().key_value()));
+  ASSERT_THAT(boring_ssl_aead_or.status(), IsOk());
+  ASSERT_THAT(EncryptThenDecrypt(*aead_or.ValueOrDie(),
+                                 *boring_ssl_aead_or.ValueOrDie(),
+                                 "message", "aad"),
+              IsOk());
+  ASSERT_THAT(EncryptThenDecrypt(*boring_ssl_aead_or.ValueOrDie(),
+                                 *aead_or.ValueOrDie(), "message", "aad"),
+              IsOk());
+}
+
+TEST(AesGcmCounterNonceKeyManagerTest, PrimitivesUseDistinctPrefixes) {
+  AesGcmCounterNonceKeyFormat format;
+  format.set_key_size(16);
+  AesGcmCounterNonceKey key =
+      AesGcmCounterNonceKeyManager().CreateKey(format).ValueOrDie();
+  auto first = std::move(
+      AesGcmCounterNonceKeyManager().GetPrimitive<Aead>(key).ValueOrDie());
+  auto second = std::move(
+      AesGcmCounterNonceKeyManager().GetPrimitive<Aead>(key).ValueOrDie());
+  EXPECT_THAT(first->Encrypt("message", "").ValueOrDie().substr(0, 12),
+              Ne(second->Encrypt("message", "").ValueOrDie().substr(0, 12)));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
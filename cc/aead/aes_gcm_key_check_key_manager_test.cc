@@ -0,0 +1,128 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/aes_gcm_key_check_key_manager.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/aead_test_util.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/aes_gcm_key_check.pb.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::crypto::tink::util::StatusOr;
+using ::google::crypto::tink::AesGcmKeyCheckKey;
+using ::google::crypto::tink::AesGcmKeyCheckKeyFormat;
+using ::testing::Eq;
+
+TEST(AesGcmKeyCheckKeyManagerTest, Basics) {
+  EXPECT_THAT(AesGcmKeyCheckKeyManager().get_version(), Eq(0));
+  EXPECT_THAT(AesGcmKeyCheckKeyManager().get_key_type(),
+              Eq("type.googleapis.com/google.crypto.tink.AesGcmKeyCheckKey"));
+  EXPECT_THAT(AesGcmKeyCheckKeyManager().key_material_type(),
+              Eq(google::crypto::tink::KeyData::SYMMETRIC));
+}
+
+TEST(AesGcmKeyCheckKeyManagerTest, ValidateKey) {
+  AesGcmKeyCheckKey key;
+  EXPECT_THAT(AesGcmKeyCheckKeyManager().ValidateKey(key),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  for (int key_size : {15, 16, 17, 24, 31, 32, 33}) {
+    key.set_key_value(std::string(key_size, 'x'));
+    if (key_size == 16 || key_size == 32) {
+      EXPECT_THAT(AesGcmKeyCheckKeyManager().ValidateKey(key), IsOk());
+    } else {
+      EXPECT_THAT(AesGcmKeyCheckKeyManager().ValidateKey(key),
+                  StatusIs(util::error::INVALID_ARGUMENT))
+          << key_size;
+    }
+  }
+  key.set_key_value(std::string(16, 'x'));
+  key.set_version(1);
+  EXPECT_THAT(AesGcmKeyCheckKeyManager().ValidateKey(key),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(AesGcmKeyCheckKeyManagerTest, ValidateKeyFormat) {
+  AesGcmKeyCheckKeyFormat format;
+  for (int key_size : {0, 1, 15, 16, 17, 31, 32, 33}) {
+    format.set_key_size(key_size);
+    if (key_size == 16 || key_size == 32) {
+      EXPECT_THAT(AesGcmKeyCheckKeyManager().ValidateKeyFormat(format),
+                  IsOk());
+    } else {
+      EXPECT_THAT(AesGcmKeyCheckKeyManager().ValidateKeyFormat(format),
+                  StatusIs(util::error::INVALID_ARGUMENT))
+          << key_size;
+    }
+  }
+}
+
+TEST(AesGcmKeyCheckKeyManagerTest, CreateKey) {
+  AesGcmKeyCheckKeyFormat format;
+  format.set_key_size(32);
+  StatusOr<AesGcmKeyCheckKey> key_or =
+      AesGcmKeyCheckKeyManager().CreateKey(format);
+  ASSERT_THAT(key_or.status(), IsOk());
+  EXPECT_THAT(key_or.ValueOrDie().key_value().size(), Eq(format.key_size()));
+  EXPECT_THAT(AesGcmKeyCheckKeyManager().ValidateKey(key_or.ValueOrDie()),
+              IsOk());
+}
+
+TEST(AesGcmKeyCheckKeyManagerTest, CreateAead) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  AesGcmKeyCheckKeyFormat format;
+  format.set_key_size(16);
+  AesGcmKeyCheckKey key =
+      AesGcmKeyCheckKeyManager().CreateKey(format).ValueOrDie();
+  AesGcmKeyCheckKey other_key =
+      AesGcmKeyCheckKeyManager().CreateKey(format).ValueOrDie();
+
+  StatusOr<std::unique_ptr<Aead>> aead_or =
+      AesGcmKeyCheckKeyManager().GetPrimitive<Aead>(key);
+  ASSERT_THAT(aead_or.status(), IsOk());
+  StatusOr<std::unique_ptr<Aead>> same_aead_or =
+      AesGcmKeyCheckKeyManager().GetPrimitive<Aead>(key);
+  ASSERT_THAT(same_aead_or.status(), IsOk());
+  StatusOr<std::unique_ptr<Aead>> other_aead_or =
+      AesGcmKeyCheckKeyManager().GetPrimitive<Aead>(other_key);
+  ASSERT_THAT(other_aead_or.status(), IsOk());
+
+  EXPECT_THAT(EncryptThenDecrypt(*aead_or.ValueOrDie(),
+                                 *same_aead_or.ValueOrDie(), "message", "aad"),
+              IsOk());
+  std::string ciphertext =
+      aead_or.ValueOrDie()->Encrypt("message", "aad").ValueOrDie();
+  EXPECT_THAT(other_aead_or.ValueOrDie()->Decrypt(ciphertext, "aad").status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
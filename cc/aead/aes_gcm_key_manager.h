@@ -16,6 +16,7 @@
 #ifndef TINK_AEAD_AES_GCM_KEY_MANAGER_H_
 #define TINK_AEAD_AES_GCM_KEY_MANAGER_H_
 
+#include <memory>
 #include <string>
 
 #include "absl/memory/memory.h"
@@ -27,6 +28,9 @@
 #include "tink/core/key_type_manager.h"
 #include "tink/key_manager.h"
 #include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/cpu_features.h"
+#include "tink/subtle/offload_aes_gcm.h"
+#include "tink/subtle/offload_engine.h"
 #include "tink/subtle/random.h"
 #include "tink/util/constants.h"
 #include "tink/util/errors.h"
@@ -50,8 +54,23 @@ class AesGcmKeyManager
   class AeadFactory : public PrimitiveFactory<Aead> {
     crypto::tink::util::StatusOr<std::unique_ptr<Aead>> Create(
         const google::crypto::tink::AesGcmKey& key) const override {
-      auto aes_gcm_result = subtle::AesGcmBoringSsl::New(
-          util::SecretDataFromStringView(key.key_value()));
+      util::SecretData key_value =
+          util::SecretDataFromStringView(key.key_value());
+      std::shared_ptr<subtle::OffloadEngine> engine =
+          subtle::GetOffloadEngine();
+      if (engine != nullptr) {
+        auto offload_result = subtle::OffloadAesGcm::New(
+            key_value, engine,
+            subtle::GetOffloadPolicy().min_aes_gcm_message_size);
+        // Keys the engine does not support stay in software.
+        if (offload_result.ok()) {
+          subtle::RecordImplementation("AesGcm", engine->name());
+          return {std::move(offload_result.ValueOrDie())};
+        }
+      }
+      // BoringSSL picks the AESNI/PCLMULQDQ, VAES or ARMv8 code itself.
+      subtle::RecordImplementation("AesGcm", "boringssl");
+      auto aes_gcm_result = subtle::AesGcmBoringSsl::New(key_value);
       if (!aes_gcm_result.ok()) return aes_gcm_result.status();
       return {std::move(aes_gcm_result.ValueOrDie())};
     }
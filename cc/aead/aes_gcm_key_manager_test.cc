@@ -16,11 +16,17 @@
 
 #include "tink/aead/aes_gcm_key_manager.h"
 
+#include <memory>
+#include <vector>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "absl/memory/memory.h"
 #include "tink/aead.h"
 #include "tink/aead/internal/cord_aes_gcm_boringssl.h"
 #include "tink/subtle/aead_test_util.h"
+#include "tink/subtle/cpu_features.h"
+#include "tink/subtle/offload_engine.h"
 #include "tink/util/istream_input_stream.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/status.h"
@@ -185,6 +191,57 @@ TEST(AesGcmKeyManagerTest, CreateAead) {
               IsOk());
 }
 
+// An engine which is always busy, so that all messages fall back to
+// software.
+class BusyEngine : public subtle::OffloadEngine {
+ public:
+  class Session : public AesGcmSession {
+   public:
+    void Submit(std::vector<AesGcmOperation> batch) const override {
+      for (const AesGcmOperation& operation : batch) {
+        operation.done(util::Status(util::error::UNAVAILABLE, "busy"));
+      }
+    }
+  };
+
+  absl::string_view name() const override { return "busy"; }
+
+  StatusOr<std::unique_ptr<AesGcmSession>> NewAesGcmSession(
+      const util::SecretData& key) const override {
+    return {absl::make_unique<Session>()};
+  }
+
+  StatusOr<std::unique_ptr<RsaSession>> NewRsaSession(
+      const subtle::SubtleUtilBoringSSL::RsaPrivateKey& key) const override {
+    return util::Status(util::error::UNIMPLEMENTED, "no RSA");
+  }
+};
+
+TEST(AesGcmKeyManagerTest, CreateAeadWithOffloadEngine) {
+  AesGcmKeyFormat format;
+  format.set_key_size(32);
+  StatusOr<AesGcmKey> key_or = AesGcmKeyManager().CreateKey(format);
+  ASSERT_THAT(key_or.status(), IsOk());
+
+  subtle::OffloadPolicy policy;
+  policy.min_aes_gcm_message_size = 0;
+  subtle::SetOffloadEngine(std::make_shared<BusyEngine>(), policy);
+  StatusOr<std::unique_ptr<Aead>> aead_or =
+      AesGcmKeyManager().GetPrimitive<Aead>(key_or.ValueOrDie());
+  subtle::SetOffloadEngine(nullptr);
+  ASSERT_THAT(aead_or.status(), IsOk());
+  EXPECT_EQ("busy", subtle::GetChosenImplementations()["AesGcm"]);
+
+  StatusOr<std::unique_ptr<Aead>> boring_ssl_aead_or =
+      subtle::AesGcmBoringSsl::New(
+          util::SecretDataFromStringView(key_or.ValueOrDie().key_value()));
+  ASSERT_THAT(boring_ssl_aead_or.status(), IsOk());
+  ASSERT_THAT(EncryptThenDecrypt(*aead_or.ValueOrDie(),
+                                 *boring_ssl_aead_or.ValueOrDie(),
+                                 "message", "aad"),
+              IsOk());
+}
+
 TEST(AesGcmKeyManagerTest, CreateCordAead) {
   AesGcmKeyFormat format;
   format.set_key_size(32);
@@ -0,0 +1,123 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/aes_gcm_page_key_manager.h"
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/types/span.h"
+#include "tink/config/tink_fips.h"
+#include "tink/page_aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/aes_gcm_page.pb.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::crypto::tink::util::StatusOr;
+using ::google::crypto::tink::AesGcmPageKey;
+using ::google::crypto::tink::AesGcmPageKeyFormat;
+using ::testing::Eq;
+
+TEST(AesGcmPageKeyManagerTest, Basics) {
+  EXPECT_THAT(AesGcmPageKeyManager().get_version(), Eq(0));
+  EXPECT_THAT(AesGcmPageKeyManager().get_key_type(),
+              Eq("type.googleapis.com/google.crypto.tink.AesGcmPageKey"));
+  EXPECT_THAT(AesGcmPageKeyManager().key_material_type(),
+              Eq(google::crypto::tink::KeyData::SYMMETRIC));
+}
+
+TEST(AesGcmPageKeyManagerTest, ValidateKey) {
+  AesGcmPageKey key;
+  EXPECT_THAT(AesGcmPageKeyManager().ValidateKey(key),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  for (int key_size : {15, 16, 17, 24, 31, 32, 33}) {
+    key.set_key_value(std::string(key_size, 'x'));
+    if (key_size == 16 || key_size == 32) {
+      EXPECT_THAT(AesGcmPageKeyManager().ValidateKey(key), IsOk());
+    } else {
+      EXPECT_THAT(AesGcmPageKeyManager().ValidateKey(key),
+                  StatusIs(util::error::INVALID_ARGUMENT))
+          << key_size;
+    }
+  }
+  key.set_key_value(std::string(16, 'x'));
+  key.set_version(1);
+  EXPECT_THAT(AesGcmPageKeyManager().ValidateKey(key),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(AesGcmPageKeyManagerTest, ValidateKeyFormat) {
+  AesGcmPageKeyFormat format;
+  for (int key_size : {0, 1, 15, 16, 17, 31, 32, 33}) {
+    format.set_key_size(key_size);
+    if (key_size == 16 || key_size == 32) {
+      EXPECT_THAT(AesGcmPageKeyManager().ValidateKeyFormat(format), IsOk());
+    } else {
+      EXPECT_THAT(AesGcmPageKeyManager().ValidateKeyFormat(format),
+                  StatusIs(util::error::INVALID_ARGUMENT))
+          << key_size;
+    }
+  }
+}
+
+TEST(AesGcmPageKeyManagerTest, CreateKey) {
+  AesGcmPageKeyFormat format;
+  format.set_key_size(32);
+  StatusOr<AesGcmPageKey> key_or = AesGcmPageKeyManager().CreateKey(format);
+  ASSERT_THAT(key_or.status(), IsOk());
+  EXPECT_THAT(key_or.ValueOrDie().key_value().size(), Eq(format.key_size()));
+  EXPECT_THAT(AesGcmPageKeyManager().ValidateKey(key_or.ValueOrDie()),
+              IsOk());
+}
+
+TEST(AesGcmPageKeyManagerTest, CreatePageAead) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  AesGcmPageKeyFormat format;
+  format.set_key_size(16);
+  AesGcmPageKey key = AesGcmPageKeyManager().CreateKey(format).ValueOrDie();
+
+  StatusOr<std::unique_ptr<PageAead>> page_aead_or =
+      AesGcmPageKeyManager().GetPrimitive<PageAead>(key);
+  ASSERT_THAT(page_aead_or.status(), IsOk());
+  StatusOr<std::unique_ptr<PageAead>> same_page_aead_or =
+      AesGcmPageKeyManager().GetPrimitive<PageAead>(key);
+  ASSERT_THAT(same_page_aead_or.status(), IsOk());
+
+  std::string page(8192, 'x');
+  ASSERT_THAT(page_aead_or.ValueOrDie()->EncryptPage(
+                  3, "", absl::MakeSpan(&page[0], page.size())),
+              IsOk());
+  ASSERT_THAT(same_page_aead_or.ValueOrDie()->DecryptPage(
+                  3, "", absl::MakeSpan(&page[0], page.size())),
+              IsOk());
+  EXPECT_THAT(page.substr(0, 8192 - page_aead_or.ValueOrDie()->overhead()),
+              Eq(std::string(8192 - 28, 'x')));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -21,8 +21,12 @@
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "tink/aead.h"
+#include "tink/aead/cord_aead.h"
+#include "tink/aead/internal/cord_aead_from_aead.h"
 #include "tink/core/key_type_manager.h"
+#include "tink/subtle/aes_gcm_siv_aesni.h"
 #include "tink/subtle/aes_gcm_siv_boringssl.h"
+#include "tink/subtle/cpu_features.h"
 #include "tink/subtle/random.h"
 #include "tink/util/constants.h"
 #include "tink/util/protobuf_helper.h"
@@ -38,17 +42,28 @@ namespace tink {
 class AesGcmSivKeyManager
     : public KeyTypeManager<google::crypto::tink::AesGcmSivKey,
                             google::crypto::tink::AesGcmSivKeyFormat,
-                            List<Aead>> {
+                            List<Aead, CordAead>> {
  public:
   class AeadFactory : public PrimitiveFactory<Aead> {
     crypto::tink::util::StatusOr<std::unique_ptr<Aead>> Create(
         const google::crypto::tink::AesGcmSivKey& key) const override {
-      return subtle::AesGcmSivBoringSsl::New(
-          util::SecretDataFromStringView(key.key_value()));
+      return NewAead(util::SecretDataFromStringView(key.key_value()));
+    }
+  };
+  class CordAeadFactory : public PrimitiveFactory<CordAead> {
+    crypto::tink::util::StatusOr<std::unique_ptr<CordAead>> Create(
+        const google::crypto::tink::AesGcmSivKey& key) const override {
+      auto aead_result =
+          NewAead(util::SecretDataFromStringView(key.key_value()));
+      if (!aead_result.ok()) return aead_result.status();
+      return {absl::make_unique<CordAeadFromAead>(
+          std::move(aead_result.ValueOrDie()))};
     }
   };
 
-  AesGcmSivKeyManager() : KeyTypeManager(absl::make_unique<AeadFactory>()) {}
+  AesGcmSivKeyManager()
+      : KeyTypeManager(absl::make_unique<AeadFactory>(),
+                       absl::make_unique<CordAeadFactory>()) {}
 
   uint32_t get_version() const override { return 0; }
 
@@ -86,6 +101,21 @@ class AesGcmSivKeyManager
   }
 
  private:
+  // Both implementations produce the same ciphertexts; the AESNI one derives
+  // the message keys in parallel and aggregates the POLYVAL reductions.
+  static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> NewAead(
+      const util::SecretData& key) {
+#if defined(__SSE4_1__) && defined(__AES__) && defined(__PCLMUL__)
+    if (subtle::UseAesniImplementations() &&
+        subtle::GetCpuFeatures().pclmulqdq) {
+      subtle::RecordImplementation("AesGcmSiv", "aesni");
+      return subtle::AesGcmSivAesni::New(key);
+    }
+#endif
+    subtle::RecordImplementation("AesGcmSiv", "boringssl");
+    return subtle::AesGcmSivBoringSsl::New(key);
+  }
+
   const std::string key_type_ = absl::StrCat(
       kTypeGoogleapisCom, google::crypto::tink::AesGcmSivKey().GetTypeName());
 };
@@ -20,6 +20,7 @@
 #include "gtest/gtest.h"
 #include "tink/aead.h"
 #include "tink/subtle/aead_test_util.h"
+#include "tink/subtle/cpu_features.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -36,7 +37,9 @@ using ::crypto::tink::test::StatusIs;
 using ::crypto::tink::util::StatusOr;
 using ::google::crypto::tink::AesGcmSivKey;
 using ::google::crypto::tink::AesGcmSivKeyFormat;
+using ::testing::Contains;
 using ::testing::Eq;
+using ::testing::Pair;
 
 TEST(AesGcmSivKeyManagerTest, Basics) {
   EXPECT_THAT(AesGcmSivKeyManager().get_version(), Eq(0));
@@ -173,6 +176,40 @@ TEST(AesGcmSivKeyManagerTest, CreateAead) {
               IsOk());
 }
 
+TEST(AesGcmSivKeyManagerTest, DispatchPolicy) {
+  AesGcmSivKeyFormat format;
+  format.set_key_size(16);
+  StatusOr<AesGcmSivKey> key_or = AesGcmSivKeyManager().CreateKey(format);
+  ASSERT_THAT(key_or.status(), IsOk());
+
+  StatusOr<std::unique_ptr<Aead>> fastest_or =
+      AesGcmSivKeyManager().GetPrimitive<Aead>(key_or.ValueOrDie());
+  ASSERT_THAT(fastest_or.status(), IsOk());
+#if defined(__SSE4_1__) && defined(__AES__) && defined(__PCLMUL__)
+  const bool aesni = subtle::UseAesniImplementations() &&
+                     subtle::GetCpuFeatures().pclmulqdq;
+#else
+  const bool aesni = false;
+#endif
+  EXPECT_THAT(subtle::GetChosenImplementations(),
+              Contains(Pair("AesGcmSiv", aesni ? "aesni" : "boringssl")));
+
+  subtle::SetDispatchPolicy(subtle::DispatchPolicy::kPortableOnly);
+  StatusOr<std::unique_ptr<Aead>> portable_or =
+      AesGcmSivKeyManager().GetPrimitive<Aead>(key_or.ValueOrDie());
+  subtle::SetDispatchPolicy(subtle::DispatchPolicy::kFastest);
+  ASSERT_THAT(portable_or.status(), IsOk());
+  EXPECT_THAT(subtle::GetChosenImplementations(),
+              Contains(Pair("AesGcmSiv", "boringssl")));
+
+  ASSERT_THAT(EncryptThenDecrypt(*fastest_or.ValueOrDie(),
+                                 *portable_or.ValueOrDie(), "message", "aad"),
+              IsOk());
+  ASSERT_THAT(EncryptThenDecrypt(*portable_or.ValueOrDie(),
+                                 *fastest_or.ValueOrDie(), "message", "aad"),
+              IsOk());
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
@@ -14,8 +14,11 @@
 #ifndef TINK_AEAD_CORD_AEAD_H_
 #define TINK_AEAD_CORD_AEAD_H_
 
+#include <cstdint>
+
 #include "absl/strings/cord.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
@@ -32,6 +35,10 @@ namespace tink {
 // Implementations are expected to be thread safe.
 class CordAead {
  public:
+  // A list of memory fragments which is processed as the concatenation of
+  // the fragments, e.g. the buffers of a fragmented network payload.
+  using Fragments = absl::Span<const absl::Span<const uint8_t>>;
+
   // Encrypts 'plaintext' with 'associated_data' as associated data,
   // and returns the resulting ciphertext.
   // The ciphertext allows for checking authenticity and integrity
@@ -56,7 +63,32 @@ class CordAead {
       absl::Cord ciphertext,
       absl::Cord associated_data) const = 0;
 
+  // Scatter/gather variants of Encrypt() and Decrypt(), with the same
+  // results as calling them on the concatenation of the fragments.
+  // Implementations which process their input incrementally override these
+  // so that the fragments are never copied into a contiguous buffer; the
+  // default implementations copy the fragments into Cords.
+  virtual crypto::tink::util::StatusOr<absl::Cord> EncryptFragments(
+      Fragments plaintext, Fragments associated_data) const {
+    return Encrypt(ToCord(plaintext), ToCord(associated_data));
+  }
+
+  virtual crypto::tink::util::StatusOr<absl::Cord> DecryptFragments(
+      Fragments ciphertext, Fragments associated_data) const {
+    return Decrypt(ToCord(ciphertext), ToCord(associated_data));
+  }
+
   virtual ~CordAead() {}
+
+ private:
+  static absl::Cord ToCord(Fragments fragments) {
+    absl::Cord cord;
+    for (absl::Span<const uint8_t> fragment : fragments) {
+      cord.Append(absl::string_view(
+          reinterpret_cast<const char*>(fragment.data()), fragment.size()));
+    }
+    return cord;
+  }
 };
 
 }  // namespace tink
@@ -14,9 +14,19 @@
 
 #include "tink/aead/cord_aead_wrapper.h"
 
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/cord.h"
+#include "absl/types/span.h"
+
 #include "tink/aead/cord_aead.h"
+#include "tink/aead/internal/fragments.h"
 #include "tink/crypto_format.h"
 #include "tink/primitive_set.h"
+#include "tink/subtle/subtle_util.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -48,6 +58,12 @@ class CordAeadSetWrapper : public CordAead {
   crypto::tink::util::StatusOr<absl::Cord> Decrypt(
       absl::Cord ciphertext, absl::Cord associated_data) const override;
 
+  crypto::tink::util::StatusOr<absl::Cord> EncryptFragments(
+      Fragments plaintext, Fragments associated_data) const override;
+
+  crypto::tink::util::StatusOr<absl::Cord> DecryptFragments(
+      Fragments ciphertext, Fragments associated_data) const override;
+
   ~CordAeadSetWrapper() override {}
 
  private:
@@ -56,27 +72,44 @@ class CordAeadSetWrapper : public CordAead {
 
 util::StatusOr<absl::Cord> CordAeadSetWrapper::Encrypt(
     absl::Cord plaintext, absl::Cord associated_data) const {
-  auto encrypt_result = aead_set_->get_primary()->get_primitive().Encrypt(
-      plaintext, associated_data);
+  return EncryptFragments(internal::CordFragments(plaintext),
+                          internal::CordFragments(associated_data));
+}
+
+util::StatusOr<absl::Cord> CordAeadSetWrapper::Decrypt(
+    absl::Cord ciphertext, absl::Cord associated_data) const {
+  return DecryptFragments(internal::CordFragments(ciphertext),
+                          internal::CordFragments(associated_data));
+}
+
+util::StatusOr<absl::Cord> CordAeadSetWrapper::EncryptFragments(
+    Fragments plaintext, Fragments associated_data) const {
+  auto encrypt_result =
+      aead_set_->get_primary()->get_primitive().EncryptFragments(
+          plaintext, associated_data);
   if (!encrypt_result.ok()) return encrypt_result.status();
   absl::Cord result;
   result.Append(aead_set_->get_primary()->get_identifier());
-  result.Append(encrypt_result.ValueOrDie());
+  result.Append(std::move(encrypt_result.ValueOrDie()));
   return result;
 }
 
-util::StatusOr<absl::Cord> CordAeadSetWrapper::Decrypt(
-    absl::Cord ciphertext, absl::Cord associated_data) const {
-  if (ciphertext.size() > CryptoFormat::kNonRawPrefixSize) {
-    std::string key_id =
-        std::string(ciphertext.Subcord(0, CryptoFormat::kNonRawPrefixSize));
+util::StatusOr<absl::Cord> CordAeadSetWrapper::DecryptFragments(
+    Fragments ciphertext, Fragments associated_data) const {
+  uint64_t ciphertext_size = internal::FragmentsSize(ciphertext);
+  if (ciphertext_size > CryptoFormat::kNonRawPrefixSize) {
+    std::string key_id;
+    subtle::ResizeStringUninitialized(&key_id, CryptoFormat::kNonRawPrefixSize);
+    internal::CopyFromFragments(ciphertext, 0, CryptoFormat::kNonRawPrefixSize,
+                                reinterpret_cast<uint8_t*>(&key_id[0]));
     auto primitives_result = aead_set_->get_primitives(key_id);
     if (primitives_result.ok()) {
-      auto raw_ciphertext =
-          ciphertext.Subcord(key_id.size(), ciphertext.size());
+      std::vector<absl::Span<const uint8_t>> raw_ciphertext =
+          internal::SubFragments(ciphertext, key_id.size(), ciphertext_size);
       for (auto& aead_entry : *(primitives_result.ValueOrDie())) {
         CordAead& aead = aead_entry->get_primitive();
-        auto decrypt_result = aead.Decrypt(raw_ciphertext, associated_data);
+        auto decrypt_result =
+            aead.DecryptFragments(raw_ciphertext, associated_data);
         if (decrypt_result.ok()) {
           return std::move(decrypt_result.ValueOrDie());
         } else {
@@ -91,7 +124,7 @@ util::StatusOr<absl::Cord> CordAeadSetWrapper::Decrypt(
   if (raw_primitives_result.ok()) {
     for (auto& aead_entry : *(raw_primitives_result.ValueOrDie())) {
       CordAead& aead = aead_entry->get_primitive();
-      auto decrypt_result = aead.Decrypt(ciphertext, associated_data);
+      auto decrypt_result = aead.DecryptFragments(ciphertext, associated_data);
       if (decrypt_result.ok()) {
         return std::move(decrypt_result.ValueOrDie());
       }
@@ -105,6 +138,7 @@ util::StatusOr<std::unique_ptr<CordAead>> CordAeadWrapper::Wrap(
     std::unique_ptr<PrimitiveSet<CordAead>> aead_set) const {
   util::Status status = Validate(aead_set.get());
   if (!status.ok()) return status;
+  aead_set->Freeze();
   std::unique_ptr<CordAead> aead(new CordAeadSetWrapper(std::move(aead_set)));
   return std::move(aead);
 }
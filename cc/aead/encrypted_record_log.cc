@@ -0,0 +1,378 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/aead/encrypted_record_log.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/internal/endian.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "tink/aead.h"
+#include "tink/internal/thread_pool.h"
+#include "tink/output_stream.h"
+#include "tink/random_access_stream.h"
+#include "tink/util/buffer.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace {
+
+constexpr char kMagic[] = "TinkRLg1";
+constexpr int kMagicSize = 8;
+constexpr int kTrailerSize = 8 + kMagicSize;
+constexpr int kFooterEntrySize = 8 + 4;
+// The number in the associated data of the footer.
+constexpr uint64_t kFooterNumber = std::numeric_limits<uint64_t>::max();
+
+void AppendUint32(uint32_t value, std::string* output) {
+  char bytes[4];
+  absl::big_endian::Store32(bytes, value);
+  output->append(bytes, 4);
+}
+
+void AppendUint64(uint64_t value, std::string* output) {
+  char bytes[8];
+  absl::big_endian::Store64(bytes, value);
+  output->append(bytes, 8);
+}
+
+std::string BlockAssociatedData(absl::string_view associated_data,
+                                uint64_t number) {
+  std::string result(associated_data);
+  AppendUint64(number, &result);
+  return result;
+}
+
+Status WriteString(absl::string_view data, OutputStream* destination) {
+  return destination->WriteFrom(absl::MakeConstSpan(
+      reinterpret_cast<const uint8_t*>(data.data()), data.size()));
+}
+
+// Reads exactly 'count' bytes at 'position' of 'source'.
+StatusOr<std::string> ReadBytes(RandomAccessStream* source, int64_t position,
+                                int64_t count) {
+  if (count <= 0 || count > std::numeric_limits<int>::max()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("invalid read size ", count));
+  }
+  auto buffer_result = util::Buffer::New(count);
+  if (!buffer_result.ok()) return buffer_result.status();
+  util::Buffer& buffer = *buffer_result.ValueOrDie();
+  Status status = source->PRead(position, count, &buffer);
+  if (!status.ok() && status.error_code() != util::error::OUT_OF_RANGE) {
+    return status;
+  }
+  if (buffer.size() < count) {
+    return Status(util::error::INVALID_ARGUMENT, "log is truncated");
+  }
+  return std::string(buffer.get_mem_block(), count);
+}
+
+// Splits the plaintext of a block, which must hold 'expected_count' records.
+StatusOr<std::vector<std::string>> ParseBlock(absl::string_view plaintext,
+                                              int64_t expected_count) {
+  Status corrupted(util::error::INVALID_ARGUMENT, "corrupted block");
+  if (plaintext.size() < 4) return corrupted;
+  uint32_t count =
+      absl::big_endian::Load32(plaintext.data() + plaintext.size() - 4);
+  if (count != expected_count || count > (plaintext.size() - 4) / 4) {
+    return corrupted;
+  }
+  size_t index_start = plaintext.size() - 4 - 4 * static_cast<size_t>(count);
+  std::vector<std::string> records;
+  records.reserve(count);
+  for (uint32_t i = 0; i < count; i++) {
+    size_t offset = absl::big_endian::Load32(plaintext.data() + index_start +
+                                             4 * static_cast<size_t>(i));
+    if (offset > index_start || index_start - offset < 4) return corrupted;
+    size_t length = absl::big_endian::Load32(plaintext.data() + offset);
+    if (length > index_start - offset - 4) return corrupted;
+    records.emplace_back(plaintext.substr(offset + 4, length));
+  }
+  return records;
+}
+
+}  // namespace
+
+// static
+StatusOr<std::unique_ptr<EncryptedRecordLogWriter>>
+EncryptedRecordLogWriter::New(std::unique_ptr<Aead> aead,
+                              std::unique_ptr<OutputStream> destination,
+                              absl::string_view associated_data,
+                              int block_size) {
+  if (aead == nullptr || destination == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "aead and destination must be non-null");
+  }
+  if (block_size <= 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "block_size must be positive");
+  }
+  return {absl::WrapUnique(new EncryptedRecordLogWriter(
+      std::move(aead), std::move(destination), associated_data, block_size))};
+}
+
+EncryptedRecordLogWriter::EncryptedRecordLogWriter(
+    std::unique_ptr<Aead> aead, std::unique_ptr<OutputStream> destination,
+    absl::string_view associated_data, int block_size)
+    : aead_(std::move(aead)),
+      associated_data_(associated_data),
+      block_size_(block_size),
+      destination_(std::move(destination)) {}
+
+Status EncryptedRecordLogWriter::Append(absl::string_view record) {
+  absl::MutexLock lock(&mutex_);
+  if (!status_.ok()) return status_;
+  // The offsets in a block and the size of its ciphertext are 32 bits.
+  constexpr size_t kMaxBlockSize = std::numeric_limits<int32_t>::max() / 2;
+  if (record.size() > kMaxBlockSize) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("record too large: ", record.size()));
+  }
+  if (!offsets_.empty() && records_.size() + record.size() > kMaxBlockSize) {
+    status_ = WriteBlock();
+    if (!status_.ok()) return status_;
+  }
+  offsets_.push_back(records_.size());
+  AppendUint32(record.size(), &records_);
+  records_.append(record.data(), record.size());
+  record_count_++;
+  if (records_.size() >= static_cast<size_t>(block_size_)) {
+    status_ = WriteBlock();
+  }
+  return status_;
+}
+
+Status EncryptedRecordLogWriter::Flush() {
+  absl::MutexLock lock(&mutex_);
+  if (!status_.ok()) return status_;
+  if (!offsets_.empty()) status_ = WriteBlock();
+  return status_;
+}
+
+Status EncryptedRecordLogWriter::WriteBlock() {
+  std::string plaintext = std::move(records_);
+  for (uint32_t offset : offsets_) AppendUint32(offset, &plaintext);
+  AppendUint32(offsets_.size(), &plaintext);
+  auto encrypt_result = aead_->Encrypt(
+      plaintext, BlockAssociatedData(associated_data_, block_count_));
+  if (!encrypt_result.ok()) return encrypt_result.status();
+  const std::string& ciphertext = encrypt_result.ValueOrDie();
+  std::string size;
+  AppendUint32(ciphertext.size(), &size);
+  Status status = WriteString(size, destination_.get());
+  if (!status.ok()) return status;
+  status = WriteString(ciphertext, destination_.get());
+  if (!status.ok()) return status;
+
+  AppendUint64(position_, &footer_);
+  AppendUint32(offsets_.size(), &footer_);
+  position_ += size.size() + ciphertext.size();
+  block_count_++;
+  records_.clear();
+  offsets_.clear();
+  return util::OkStatus();
+}
+
+Status EncryptedRecordLogWriter::Close() {
+  absl::MutexLock lock(&mutex_);
+  if (!status_.ok()) return status_;
+  if (!offsets_.empty()) {
+    status_ = WriteBlock();
+    if (!status_.ok()) return status_;
+  }
+  auto encrypt_result = aead_->Encrypt(
+      footer_, BlockAssociatedData(associated_data_, kFooterNumber));
+  if (!encrypt_result.ok()) {
+    status_ = encrypt_result.status();
+    return status_;
+  }
+  std::string footer = std::move(encrypt_result.ValueOrDie());
+  AppendUint64(footer.size(), &footer);
+  footer.append(kMagic, kMagicSize);
+  status_ = WriteString(footer, destination_.get());
+  if (!status_.ok()) return status_;
+  status_ = Status(util::error::FAILED_PRECONDITION, "Writer closed");
+  return destination_->Close();
+}
+
+int64_t EncryptedRecordLogWriter::record_count() const {
+  absl::MutexLock lock(&mutex_);
+  return record_count_;
+}
+
+// static
+StatusOr<std::unique_ptr<EncryptedRecordLogReader>>
+EncryptedRecordLogReader::New(std::unique_ptr<Aead> aead,
+                              std::unique_ptr<RandomAccessStream> source,
+                              absl::string_view associated_data) {
+  if (aead == nullptr || source == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "aead and source must be non-null");
+  }
+  std::unique_ptr<EncryptedRecordLogReader> reader(
+      new EncryptedRecordLogReader(std::move(aead), std::move(source),
+                                   associated_data));
+  Status status = reader->ReadFooter();
+  if (!status.ok()) return status;
+  return {std::move(reader)};
+}
+
+Status EncryptedRecordLogReader::ReadFooter() {
+  auto size_result = source_->size();
+  if (!size_result.ok()) return size_result.status();
+  int64_t size = size_result.ValueOrDie();
+  Status not_a_log(util::error::INVALID_ARGUMENT,
+                   "not an encrypted record log");
+  if (size < kTrailerSize) return not_a_log;
+  auto trailer_result = ReadBytes(source_.get(), size - kTrailerSize,
+                                  kTrailerSize);
+  if (!trailer_result.ok()) return trailer_result.status();
+  const std::string& trailer = trailer_result.ValueOrDie();
+  if (trailer.substr(8) != absl::string_view(kMagic, kMagicSize)) {
+    return not_a_log;
+  }
+  uint64_t footer_size = absl::big_endian::Load64(trailer.data());
+  if (footer_size > size - kTrailerSize) return not_a_log;
+  int64_t footer_position = size - kTrailerSize - footer_size;
+  auto footer_result = ReadBytes(source_.get(), footer_position, footer_size);
+  if (!footer_result.ok()) return footer_result.status();
+  auto decrypt_result = aead_->Decrypt(
+      footer_result.ValueOrDie(),
+      BlockAssociatedData(associated_data_, kFooterNumber));
+  if (!decrypt_result.ok()) return decrypt_result.status();
+  const std::string& footer = decrypt_result.ValueOrDie();
+  if (footer.size() % kFooterEntrySize != 0) {
+    return Status(util::error::INVALID_ARGUMENT, "corrupted footer");
+  }
+  int64_t block_count = footer.size() / kFooterEntrySize;
+  block_positions_.reserve(block_count + 1);
+  first_records_.reserve(block_count + 1);
+  first_records_.push_back(0);
+  for (int64_t i = 0; i < block_count; i++) {
+    const char* entry = footer.data() + i * kFooterEntrySize;
+    int64_t position = absl::big_endian::Load64(entry);
+    int64_t previous = i == 0 ? -1 : block_positions_.back();
+    if (position <= previous || position >= footer_position) {
+      return Status(util::error::INVALID_ARGUMENT, "corrupted footer");
+    }
+    block_positions_.push_back(position);
+    first_records_.push_back(first_records_.back() +
+                             absl::big_endian::Load32(entry + 8));
+  }
+  block_positions_.push_back(footer_position);
+  return util::OkStatus();
+}
+
+StatusOr<std::string> EncryptedRecordLogReader::DecryptBlock(
+    int64_t block) const {
+  int64_t position = block_positions_[block];
+  auto read_result = ReadBytes(source_.get(), position,
+                               block_positions_[block + 1] - position);
+  if (!read_result.ok()) return read_result.status();
+  absl::string_view bytes = read_result.ValueOrDie();
+  if (bytes.size() < 4 ||
+      absl::big_endian::Load32(bytes.data()) != bytes.size() - 4) {
+    return Status(util::error::INVALID_ARGUMENT, "corrupted block");
+  }
+  return aead_->Decrypt(bytes.substr(4),
+                        BlockAssociatedData(associated_data_, block));
+}
+
+StatusOr<std::vector<std::string>> EncryptedRecordLogReader::ReadBlock(
+    int64_t block) {
+  if (block < 0 || block >= block_count()) {
+    return Status(util::error::OUT_OF_RANGE,
+                  absl::StrCat("no block ", block));
+  }
+  auto decrypt_result = DecryptBlock(block);
+  if (!decrypt_result.ok()) return decrypt_result.status();
+  return ParseBlock(decrypt_result.ValueOrDie(),
+                    first_records_[block + 1] - first_records_[block]);
+}
+
+StatusOr<std::string> EncryptedRecordLogReader::ReadRecord(int64_t ordinal) {
+  if (ordinal < 0 || ordinal >= record_count()) {
+    return Status(util::error::OUT_OF_RANGE,
+                  absl::StrCat("no record ", ordinal));
+  }
+  int64_t block = std::upper_bound(first_records_.begin(),
+                                   first_records_.end(), ordinal) -
+                  first_records_.begin() - 1;
+  int64_t index = ordinal - first_records_[block];
+  {
+    absl::MutexLock lock(&mutex_);
+    if (cached_block_ == block) return cached_records_[index];
+  }
+  auto read_result = ReadBlock(block);
+  if (!read_result.ok()) return read_result.status();
+  absl::MutexLock lock(&mutex_);
+  cached_block_ = block;
+  cached_records_ = std::move(read_result.ValueOrDie());
+  return cached_records_[index];
+}
+
+StatusOr<std::vector<std::string>> EncryptedRecordLogReader::ReadAllRecords(
+    int parallelism) {
+  if (parallelism < 1) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "parallelism must be at least 1");
+  }
+  int64_t block_count = this->block_count();
+  if (block_count > std::numeric_limits<int>::max()) {
+    return Status(util::error::INVALID_ARGUMENT, "too many blocks");
+  }
+  std::vector<std::vector<std::string>> blocks(block_count);
+  std::vector<Status> statuses(block_count);
+  auto read_block = [&](int i) {
+    auto read_result = ReadBlock(i);
+    statuses[i] = read_result.status();
+    if (read_result.ok()) blocks[i] = std::move(read_result.ValueOrDie());
+  };
+  if (parallelism > 1 && block_count > 1) {
+    internal::ThreadPool pool(std::min<int64_t>(parallelism, block_count) - 1);
+    pool.ParallelFor(block_count, read_block);
+  } else {
+    for (int i = 0; i < block_count; i++) read_block(i);
+  }
+  std::vector<std::string> records;
+  records.reserve(record_count());
+  for (int i = 0; i < block_count; i++) {
+    if (!statuses[i].ok()) return statuses[i];
+    for (std::string& record : blocks[i]) records.push_back(std::move(record));
+  }
+  return records;
+}
+
+}  // namespace tink
+}  // namespace crypto
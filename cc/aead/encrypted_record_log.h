@@ -0,0 +1,169 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_AEAD_ENCRYPTED_RECORD_LOG_H_
+#define TINK_AEAD_ENCRYPTED_RECORD_LOG_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/aead.h"
+#include "tink/output_stream.h"
+#include "tink/random_access_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+// An encrypted container for a sequence of records (e.g. log entries), on
+// top of an Aead, so that users do not need to design their own.
+//
+// The records are batched into blocks, and each block is encrypted as one
+// AEAD ciphertext, which amortizes the ciphertext overhead and the calls to
+// the Aead over many small records.  A block is written when its records
+// reach the block size, or when the writer is flushed; all records appended
+// since the last flush, from any thread, are committed together.  Closing
+// the writer adds an encrypted footer with the position of every block, so
+// that readers can look up records by their ordinal number, and decrypt
+// the blocks in parallel.
+//
+// Format (all integers are big-endian):
+//   log     = block* footer trailer
+//   block   = uint32 size || Aead ciphertext of size bytes, whose plaintext
+//             is (uint32 length || record)* || uint32 offset* || uint32 count
+//             where the offsets are those of the records in the plaintext
+//   footer  = Aead ciphertext of (uint64 position || uint32 record count)*
+//             with one entry per block
+//   trailer = uint64 size of footer || "TinkRLg1"
+// Block i is encrypted with associated data 'associated_data' || uint64 i,
+// and the footer with 'associated_data' || uint64 2^64 - 1, so that blocks
+// cannot be reordered, dropped or moved to another log without being
+// detected.
+class EncryptedRecordLogWriter {
+ public:
+  // Blocks are written once their plaintext reaches 'block_size' bytes.
+  static constexpr int kDefaultBlockSize = 64 * 1024;
+
+  // Returns a writer that encrypts with 'aead' and writes the log to
+  // 'destination'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<EncryptedRecordLogWriter>>
+  New(std::unique_ptr<Aead> aead, std::unique_ptr<OutputStream> destination,
+      absl::string_view associated_data, int block_size = kDefaultBlockSize);
+
+  // Appends 'record'.  It is written with the next block.  Thread safe.
+  crypto::tink::util::Status Append(absl::string_view record);
+
+  // Writes the records appended so far, from all threads, as one block.
+  // Thread safe.
+  crypto::tink::util::Status Flush();
+
+  // Writes the remaining records and the footer, and closes the
+  // destination.  Thread safe, but no records may be appended afterwards.
+  crypto::tink::util::Status Close();
+
+  // Returns the number of records appended so far.
+  int64_t record_count() const;
+
+ private:
+  EncryptedRecordLogWriter(std::unique_ptr<Aead> aead,
+                           std::unique_ptr<OutputStream> destination,
+                           absl::string_view associated_data, int block_size);
+
+  // Encrypts the pending records as the next block, and writes it.
+  crypto::tink::util::Status WriteBlock()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const std::unique_ptr<Aead> aead_;
+  const std::string associated_data_;
+  const int block_size_;
+  mutable absl::Mutex mutex_;
+  std::unique_ptr<OutputStream> destination_ ABSL_GUARDED_BY(mutex_);
+  // The records of the pending block, as in the block plaintext, and their
+  // offsets.
+  std::string records_ ABSL_GUARDED_BY(mutex_);
+  std::vector<uint32_t> offsets_ ABSL_GUARDED_BY(mutex_);
+  // The footer entries of the blocks written so far.
+  std::string footer_ ABSL_GUARDED_BY(mutex_);
+  int64_t block_count_ ABSL_GUARDED_BY(mutex_) = 0;
+  int64_t position_ ABSL_GUARDED_BY(mutex_) = 0;
+  int64_t record_count_ ABSL_GUARDED_BY(mutex_) = 0;
+  crypto::tink::util::Status status_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Reads logs written by EncryptedRecordLogWriter.  Opening a log reads and
+// decrypts its footer; the blocks are decrypted when their records are
+// read.  Instances of this class are thread safe.
+class EncryptedRecordLogReader {
+ public:
+  // Returns a reader for the log in 'source', which decrypts with 'aead'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<EncryptedRecordLogReader>>
+  New(std::unique_ptr<Aead> aead, std::unique_ptr<RandomAccessStream> source,
+      absl::string_view associated_data);
+
+  int64_t record_count() const { return first_records_.back(); }
+  int64_t block_count() const { return block_positions_.size() - 1; }
+
+  // Returns the record with ordinal number 'ordinal', in
+  // [0, record_count()).  The last decrypted block is kept, so that
+  // reading the records of a block one after the other decrypts it once.
+  crypto::tink::util::StatusOr<std::string> ReadRecord(int64_t ordinal);
+
+  // Returns the records of block 'block', in [0, block_count()).
+  crypto::tink::util::StatusOr<std::vector<std::string>> ReadBlock(
+      int64_t block);
+
+  // Returns all records, decrypting the blocks on up to 'parallelism'
+  // threads, including the calling one.
+  crypto::tink::util::StatusOr<std::vector<std::string>> ReadAllRecords(
+      int parallelism);
+
+ private:
+  EncryptedRecordLogReader(std::unique_ptr<Aead> aead,
+                           std::unique_ptr<RandomAccessStream> source,
+                           absl::string_view associated_data)
+      : aead_(std::move(aead)),
+        source_(std::move(source)),
+        associated_data_(associated_data) {}
+
+  crypto::tink::util::Status ReadFooter();
+  // Reads and decrypts block 'block', and returns its plaintext.
+  crypto::tink::util::StatusOr<std::string> DecryptBlock(int64_t block) const;
+
+  const std::unique_ptr<Aead> aead_;
+  const std::unique_ptr<RandomAccessStream> source_;
+  const std::string associated_data_;
+  // The position of every block, and the position of the footer.
+  std::vector<int64_t> block_positions_;
+  // The ordinal of the first record of every block, and the record count.
+  std::vector<int64_t> first_records_;
+
+  absl::Mutex mutex_;
+  int64_t cached_block_ ABSL_GUARDED_BY(mutex_) = -1;
+  std::vector<std::string> cached_records_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_AEAD_ENCRYPTED_RECORD_LOG_H_
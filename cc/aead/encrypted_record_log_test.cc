@@ -0,0 +1,202 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/aead/encrypted_record_log.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/aead.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/ostream_output_stream.h"
+#include "tink/util/prefetched_random_access_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::subtle::Random;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::crypto::tink::util::OstreamOutputStream;
+using ::crypto::tink::util::PrefetchedRandomAccessStream;
+using ::testing::UnorderedElementsAreArray;
+
+class EncryptedRecordLogTest : public ::testing::Test {
+ protected:
+  EncryptedRecordLogTest() : key_(Random::GetRandomBytes(16)) {}
+
+  std::unique_ptr<Aead> NewAead() {
+    return std::move(subtle::AesGcmBoringSsl::New(key_).ValueOrDie());
+  }
+
+  // Returns a writer to log_, which must be closed before log_ is read.
+  std::unique_ptr<EncryptedRecordLogWriter> NewWriter(int block_size) {
+    auto log_stream = absl::make_unique<std::stringstream>();
+    log_buf_ = log_stream->rdbuf();
+    auto writer_result = EncryptedRecordLogWriter::New(
+        NewAead(),
+        absl::make_unique<OstreamOutputStream>(std::move(log_stream)),
+        "associated data", block_size);
+    EXPECT_THAT(writer_result.status(), IsOk());
+    return std::move(writer_result.ValueOrDie());
+  }
+
+  std::string log() { return log_buf_->str(); }
+
+  util::StatusOr<std::unique_ptr<EncryptedRecordLogReader>> NewReader(
+      const std::string& log, absl::string_view associated_data) {
+    auto source = absl::make_unique<PrefetchedRandomAccessStream>(log.size());
+    EXPECT_THAT(source->AddRange(0, log), IsOk());
+    return EncryptedRecordLogReader::New(NewAead(), std::move(source),
+                                         associated_data);
+  }
+
+  std::string key_;
+  std::stringbuf* log_buf_ = nullptr;
+};
+
+std::vector<std::string> NewRecords(int count) {
+  std::vector<std::string> records;
+  for (int i = 0; i < count; i++) {
+    records.push_back(Random::GetRandomBytes(i % 50));
+  }
+  return records;
+}
+
+TEST_F(EncryptedRecordLogTest, WriteAndRead) {
+  for (int record_count : {0, 1, 10, 1000}) {
+    SCOPED_TRACE(absl::StrCat("record_count = ", record_count));
+    std::vector<std::string> records = NewRecords(record_count);
+    std::unique_ptr<EncryptedRecordLogWriter> writer = NewWriter(100);
+    for (const std::string& record : records) {
+      ASSERT_THAT(writer->Append(record), IsOk());
+    }
+    EXPECT_EQ(record_count, writer->record_count());
+    ASSERT_THAT(writer->Close(), IsOk());
+
+    auto reader_result = NewReader(log(), "associated data");
+    ASSERT_THAT(reader_result.status(), IsOk());
+    EncryptedRecordLogReader& reader = *reader_result.ValueOrDie();
+    EXPECT_EQ(record_count, reader.record_count());
+    if (record_count == 1000) {
+      EXPECT_GT(reader.block_count(), 100);
+    }
+    for (int parallelism : {1, 4}) {
+      auto all_records_result = reader.ReadAllRecords(parallelism);
+      ASSERT_THAT(all_records_result.status(), IsOk());
+      EXPECT_EQ(records, all_records_result.ValueOrDie());
+    }
+    for (int i = 0; i < record_count; i++) {
+      auto record_result = reader.ReadRecord(i);
+      ASSERT_THAT(record_result.status(), IsOk());
+      EXPECT_EQ(records[i], record_result.ValueOrDie());
+    }
+    for (int i = record_count - 1; i >= 0; i -= 7) {
+      EXPECT_EQ(records[i], reader.ReadRecord(i).ValueOrDie());
+    }
+    EXPECT_THAT(reader.ReadRecord(record_count).status(),
+                StatusIs(util::error::OUT_OF_RANGE));
+  }
+}
+
+TEST_F(EncryptedRecordLogTest, FlushWritesABlock) {
+  std::unique_ptr<EncryptedRecordLogWriter> writer = NewWriter(1 << 20);
+  for (absl::string_view record : {"a", "b", "c"}) {
+    ASSERT_THAT(writer->Append(record), IsOk());
+  }
+  ASSERT_THAT(writer->Flush(), IsOk());
+  ASSERT_THAT(writer->Flush(), IsOk());
+  ASSERT_THAT(writer->Append("d"), IsOk());
+  ASSERT_THAT(writer->Close(), IsOk());
+  EXPECT_THAT(writer->Append("e"), StatusIs(util::error::FAILED_PRECONDITION));
+
+  auto reader_result = NewReader(log(), "associated data");
+  ASSERT_THAT(reader_result.status(), IsOk());
+  EncryptedRecordLogReader& reader = *reader_result.ValueOrDie();
+  EXPECT_EQ(2, reader.block_count());
+  EXPECT_EQ(std::vector<std::string>({"a", "b", "c"}),
+            reader.ReadBlock(0).ValueOrDie());
+  EXPECT_EQ(std::vector<std::string>({"d"}), reader.ReadBlock(1).ValueOrDie());
+}
+
+TEST_F(EncryptedRecordLogTest, ConcurrentAppends) {
+  std::unique_ptr<EncryptedRecordLogWriter> writer = NewWriter(1000);
+  std::vector<std::string> records;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    for (int i = 0; i < 500; i++) records.push_back(absl::StrCat(t, ":", i));
+    threads.emplace_back([&writer, t]() {
+      for (int i = 0; i < 500; i++) {
+        EXPECT_THAT(writer->Append(absl::StrCat(t, ":", i)), IsOk());
+        if (i % 50 == 0) {
+          EXPECT_THAT(writer->Flush(), IsOk());
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  ASSERT_THAT(writer->Close(), IsOk());
+
+  auto reader_result = NewReader(log(), "associated data");
+  ASSERT_THAT(reader_result.status(), IsOk());
+  auto all_records_result = reader_result.ValueOrDie()->ReadAllRecords(2);
+  ASSERT_THAT(all_records_result.status(), IsOk());
+  EXPECT_THAT(all_records_result.ValueOrDie(),
+              UnorderedElementsAreArray(records));
+}
+
+TEST_F(EncryptedRecordLogTest, DetectsModifications) {
+  std::vector<std::string> records = NewRecords(100);
+  std::unique_ptr<EncryptedRecordLogWriter> writer = NewWriter(100);
+  for (const std::string& record : records) {
+    ASSERT_THAT(writer->Append(record), IsOk());
+  }
+  ASSERT_THAT(writer->Close(), IsOk());
+  std::string log = this->log();
+
+  EXPECT_FALSE(NewReader(log, "other associated data").ok());
+  EXPECT_FALSE(NewReader(log.substr(0, log.size() - 1), "associated data")
+                   .ok());
+  EXPECT_FALSE(NewReader(log.substr(1000), "associated data").ok());
+
+  // A modified block fails only the reads of its records.
+  std::string modified = log;
+  modified[10] ^= 1;
+  auto reader_result = NewReader(modified, "associated data");
+  ASSERT_THAT(reader_result.status(), IsOk());
+  EncryptedRecordLogReader& reader = *reader_result.ValueOrDie();
+  EXPECT_FALSE(reader.ReadRecord(0).ok());
+  EXPECT_FALSE(reader.ReadAllRecords(3).ok());
+  EXPECT_THAT(reader.ReadRecord(99).status(), IsOk());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
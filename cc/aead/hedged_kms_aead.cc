@@ -0,0 +1,254 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/hedged_kms_aead.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tink/aead.h"
+#include "tink/async_aead.h"
+#include "tink/kms_clients.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+// The number of recent latencies the hedging delay is computed from, and
+// how many of them are needed before it is used.
+constexpr int kMaxLatencies = 100;
+constexpr int kMinLatencies = 20;
+
+// How long a replica is unhealthy after its first failure, doubling with
+// each further consecutive failure up to kMaxUnhealthyPeriod.
+constexpr absl::Duration kUnhealthyPeriod = absl::Seconds(1);
+constexpr absl::Duration kMaxUnhealthyPeriod = absl::Seconds(60);
+
+}  // namespace
+
+// The state of one Encrypt() or Decrypt() call, shared with the callbacks
+// of its requests, which may outlive the call.
+struct HedgedKmsAead::Call {
+  absl::Mutex mutex;
+  bool done ABSL_GUARDED_BY(mutex) = false;
+  std::string result ABSL_GUARDED_BY(mutex);
+  int pending ABSL_GUARDED_BY(mutex) = 0;
+  int failures ABSL_GUARDED_BY(mutex) = 0;
+  util::Status last_error ABSL_GUARDED_BY(mutex);
+};
+
+// static
+util::StatusOr<std::unique_ptr<Aead>> HedgedKmsAead::New(
+    std::vector<std::unique_ptr<AsyncAead>> replicas,
+    const Options& options) {
+  if (replicas.empty()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "at least one replica must be given");
+  }
+  for (const auto& replica : replicas) {
+    if (replica == nullptr) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "replicas must be non-null");
+    }
+  }
+  if (options.deadline < absl::ZeroDuration() ||
+      options.initial_hedging_delay < absl::ZeroDuration()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "deadline and hedging delay must not be negative");
+  }
+  std::unique_ptr<Aead> aead(new HedgedKmsAead(std::move(replicas), options));
+  return std::move(aead);
+}
+
+// static
+util::StatusOr<std::unique_ptr<Aead>> HedgedKmsAead::New(
+    const std::vector<std::string>& key_uris, const Options& options) {
+  std::vector<std::unique_ptr<AsyncAead>> replicas;
+  for (const std::string& key_uri : key_uris) {
+    auto client_result = KmsClients::Get(key_uri);
+    if (!client_result.ok()) return client_result.status();
+    auto replica_result =
+        client_result.ValueOrDie()->GetAsyncAead(key_uri);
+    if (!replica_result.ok()) return replica_result.status();
+    replicas.push_back(std::move(replica_result.ValueOrDie()));
+  }
+  return New(std::move(replicas), options);
+}
+
+HedgedKmsAead::HedgedKmsAead(std::vector<std::unique_ptr<AsyncAead>> replicas,
+                             const Options& options)
+    : options_(options),
+      consecutive_failures_(replicas.size(), 0),
+      unhealthy_until_(replicas.size(), absl::InfinitePast()),
+      replicas_(std::move(replicas)) {}
+
+util::StatusOr<std::string> HedgedKmsAead::Encrypt(
+    absl::string_view plaintext, absl::string_view associated_data) const {
+  return Run([plaintext, associated_data](const AsyncAead& replica,
+                                          AsyncAead::DoneCallback done) {
+    replica.EncryptAsync(plaintext, associated_data, std::move(done));
+  });
+}
+
+util::StatusOr<std::string> HedgedKmsAead::Decrypt(
+    absl::string_view ciphertext, absl::string_view associated_data) const {
+  return Run([ciphertext, associated_data](const AsyncAead& replica,
+                                           AsyncAead::DoneCallback done) {
+    replica.DecryptAsync(ciphertext, associated_data, std::move(done));
+  });
+}
+
+util::StatusOr<std::string> HedgedKmsAead::Run(
+    const StartFunction& start) const {
+  const std::vector<int> order = ReplicaOrder();
+  const absl::Time deadline = options_.deadline == absl::ZeroDuration()
+                                  ? absl::InfiniteFuture()
+                                  : absl::Now() + options_.deadline;
+  auto call = std::make_shared<Call>();
+  int started = 0;
+  int failures_handled = 0;
+  while (true) {
+    // Requests are started without holding call->mutex, as their callbacks
+    // may run right away.
+    StartOnReplica(order[started++], start, call);
+    const absl::Time hedge_at =
+        options_.hedge_requests && started < order.size()
+            ? absl::Now() + HedgingDelay()
+            : absl::InfiniteFuture();
+
+    absl::MutexLock lock(&call->mutex);
+    auto next_request_due = [&call, &failures_handled]()
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(call->mutex) {
+          return call->done || call->failures > failures_handled;
+        };
+    call->mutex.AwaitWithDeadline(
+        absl::Condition(&next_request_due), std::min(deadline, hedge_at));
+    if (call->done) return std::move(call->result);
+    if (call->failures > failures_handled) {
+      // Fail over to the next replica right away.
+      failures_handled++;
+      if (started < order.size()) continue;
+      if (call->pending == 0) return call->last_error;
+      // Wait for the requests that are still pending.
+      auto done_or_failed = [&call]()
+          ABSL_EXCLUSIVE_LOCKS_REQUIRED(call->mutex) {
+            return call->done || call->pending == 0;
+          };
+      call->mutex.AwaitWithDeadline(absl::Condition(&done_or_failed),
+                                    deadline);
+      if (call->done) return std::move(call->result);
+      if (call->pending == 0) return call->last_error;
+    }
+    if (absl::Now() >= deadline) {
+      return util::Status(
+          util::error::DEADLINE_EXCEEDED,
+          absl::StrCat("KMS request did not complete within ",
+                       absl::FormatDuration(options_.deadline), ": ",
+                       call->last_error.ok() ? "no replica answered"
+                                             : call->last_error.ToString()));
+    }
+    // The hedging delay has passed, so the request is duplicated.
+  }
+}
+
+void HedgedKmsAead::StartOnReplica(int replica, const StartFunction& start,
+                                   const std::shared_ptr<Call>& call) const {
+  {
+    absl::MutexLock lock(&call->mutex);
+    call->pending++;
+  }
+  const absl::Time start_time = absl::Now();
+  // The callback may use 'this', since replicas_ are destroyed first, and
+  // wait for their pending operations when they are.
+  start(*replicas_[replica],
+        [this, replica, start_time, call](util::StatusOr<std::string> result) {
+          RecordResult(replica, result.ok(), absl::Now() - start_time);
+          absl::MutexLock lock(&call->mutex);
+          call->pending--;
+          if (!result.ok()) {
+            call->failures++;
+            call->last_error = result.status();
+          } else if (!call->done) {
+            call->done = true;
+            call->result = std::move(result.ValueOrDie());
+          }
+        });
+}
+
+std::vector<int> HedgedKmsAead::ReplicaOrder() const {
+  std::vector<int> order(replicas_.size());
+  for (int i = 0; i < order.size(); i++) order[i] = i;
+  const absl::Time now = absl::Now();
+  absl::MutexLock lock(&mutex_);
+  // Healthy replicas first in the given order, then the others by how soon
+  // they are healthy again.
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    absl::Time a_time = std::max(unhealthy_until_[a], now);
+    absl::Time b_time = std::max(unhealthy_until_[b], now);
+    return a_time < b_time;
+  });
+  return order;
+}
+
+absl::Duration HedgedKmsAead::HedgingDelay() const {
+  std::vector<absl::Duration> latencies;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (latencies_.size() < kMinLatencies) {
+      return options_.initial_hedging_delay;
+    }
+    latencies = latencies_;
+  }
+  auto percentile_95 = latencies.begin() + latencies.size() * 95 / 100;
+  std::nth_element(latencies.begin(), percentile_95, latencies.end());
+  return *percentile_95;
+}
+
+void HedgedKmsAead::RecordResult(int replica, bool ok,
+                                 absl::Duration latency) const {
+  absl::MutexLock lock(&mutex_);
+  if (ok) {
+    consecutive_failures_[replica] = 0;
+    unhealthy_until_[replica] = absl::InfinitePast();
+    if (latencies_.size() < kMaxLatencies) {
+      latencies_.push_back(latency);
+    } else {
+      latencies_[next_latency_] = latency;
+      next_latency_ = (next_latency_ + 1) % kMaxLatencies;
+    }
+    return;
+  }
+  int failures = std::min(consecutive_failures_[replica], 6);
+  consecutive_failures_[replica]++;
+  unhealthy_until_[replica] =
+      absl::Now() +
+      std::min(kUnhealthyPeriod * (1 << failures), kMaxUnhealthyPeriod);
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,128 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_AEAD_HEDGED_KMS_AEAD_H_
+#define TINK_AEAD_HEDGED_KMS_AEAD_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tink/aead.h"
+#include "tink/async_aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+// An Aead that sends its requests to one of several replicas of a KMS key,
+// e.g. the regional replicas of an AWS multi-Region key, or the same key
+// reached through different endpoints, so that a slow or failing replica
+// does not stall the caller:
+//  - Requests go to the first healthy replica, in the given order. A
+//    replica that fails is considered unhealthy for a while, growing with
+//    the number of consecutive failures, and is then only used when the
+//    healthy ones fail.
+//  - If a request fails, it is sent to the next replica.
+//  - If hedging is enabled and a replica has not answered after the hedging
+//    delay, the request is also sent to the next replica, and the first
+//    answer wins.
+//  - With a deadline, Encrypt() and Decrypt() return DEADLINE_EXCEEDED once
+//    it has passed. Requests still pending then complete in the background.
+//
+// All replicas must be able to decrypt the ciphertexts of each other, i.e.
+// hold the same key material.
+class HedgedKmsAead : public Aead {
+ public:
+  struct Options {
+    // How long Encrypt() and Decrypt() wait at most. Zero means no limit.
+    absl::Duration deadline = absl::ZeroDuration();
+    // Whether to send a request to the next replica if the current one has
+    // not answered within the hedging delay, which is the 95th percentile
+    // of the latencies of recent requests.
+    bool hedge_requests = true;
+    // The hedging delay while too few latencies are known.
+    absl::Duration initial_hedging_delay = absl::Milliseconds(200);
+  };
+
+  // Creates an Aead that sends requests to 'replicas', which must not be
+  // empty, preferring them in the given order.
+  static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
+      std::vector<std::unique_ptr<AsyncAead>> replicas,
+      const Options& options);
+
+  // Like New() above, with the AsyncAeads of the 'key_uris' from the
+  // KmsClient registered for them in KmsClients.
+  static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
+      const std::vector<std::string>& key_uris, const Options& options);
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override;
+
+  ~HedgedKmsAead() override {}
+
+ private:
+  // Starts an operation on the given replica.
+  using StartFunction =
+      std::function<void(const AsyncAead&, AsyncAead::DoneCallback)>;
+  struct Call;
+
+  HedgedKmsAead(std::vector<std::unique_ptr<AsyncAead>> replicas,
+                const Options& options);
+
+  // Runs the operation started by 'start' on the replicas as described
+  // above, and returns the first successful result.
+  crypto::tink::util::StatusOr<std::string> Run(
+      const StartFunction& start) const;
+  // Starts the operation on 'replica' for 'call'.
+  void StartOnReplica(int replica, const StartFunction& start,
+                      const std::shared_ptr<Call>& call) const;
+  // Returns the indices of the replicas, healthy ones first.
+  std::vector<int> ReplicaOrder() const;
+  absl::Duration HedgingDelay() const;
+  void RecordResult(int replica, bool ok, absl::Duration latency) const;
+
+  const Options options_;
+
+  mutable absl::Mutex mutex_;
+  // Per replica, the number of consecutive failures, and until when the
+  // replica is considered unhealthy.
+  mutable std::vector<int> consecutive_failures_ ABSL_GUARDED_BY(mutex_);
+  mutable std::vector<absl::Time> unhealthy_until_ ABSL_GUARDED_BY(mutex_);
+  // The latencies of recent successful requests, as a ring buffer.
+  mutable std::vector<absl::Duration> latencies_ ABSL_GUARDED_BY(mutex_);
+  mutable int next_latency_ ABSL_GUARDED_BY(mutex_) = 0;
+
+  // Declared last, so that their pending operations complete before the
+  // members above are destroyed.
+  const std::vector<std::unique_ptr<AsyncAead>> replicas_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_AEAD_HEDGED_KMS_AEAD_H_
@@ -0,0 +1,203 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/hedged_kms_aead.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tink/async_aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::DummyAead;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::HasSubstr;
+
+// A replica which answers after 'delay' on a thread of its own, or fails
+// right away, and counts its requests.
+class FakeReplica : public AsyncAead {
+ public:
+  FakeReplica(absl::Duration delay, bool fail, std::atomic<int>* requests)
+      : aead_("shared key"), delay_(delay), fail_(fail), requests_(requests) {}
+
+  void EncryptAsync(absl::string_view plaintext,
+                    absl::string_view associated_data,
+                    DoneCallback done) const override {
+    Answer(aead_.Encrypt(plaintext, associated_data), std::move(done));
+  }
+
+  void DecryptAsync(absl::string_view ciphertext,
+                    absl::string_view associated_data,
+                    DoneCallback done) const override {
+    Answer(aead_.Decrypt(ciphertext, associated_data), std::move(done));
+  }
+
+  // Waits for the pending operations.
+  ~FakeReplica() override {
+    for (auto& thread : threads_) thread.join();
+  }
+
+ private:
+  void Answer(util::StatusOr<std::string> result, DoneCallback done) const {
+    (*requests_)++;
+    if (fail_) {
+      done(util::Status(util::error::UNAVAILABLE, "replica is down"));
+      return;
+    }
+    absl::MutexLock lock(&mutex_);
+    threads_.emplace_back([this, result, done]() {
+      absl::SleepFor(delay_);
+      done(result);
+    });
+  }
+
+  DummyAead aead_;
+  const absl::Duration delay_;
+  const bool fail_;
+  std::atomic<int>* requests_;
+  mutable absl::Mutex mutex_;
+  mutable std::vector<std::thread> threads_ ABSL_GUARDED_BY(mutex_);
+};
+
+class HedgedKmsAeadTest : public ::testing::Test {
+ protected:
+  // Adds a replica to those HedgedKmsAead() uses.
+  void AddReplica(absl::Duration delay, bool fail = false) {
+    requests_.push_back(absl::make_unique<std::atomic<int>>(0));
+    replicas_.push_back(
+        absl::make_unique<FakeReplica>(delay, fail, requests_.back().get()));
+  }
+
+  std::unique_ptr<Aead> HedgedAead(const HedgedKmsAead::Options& options) {
+    auto aead_result = HedgedKmsAead::New(std::move(replicas_), options);
+    EXPECT_THAT(aead_result.status(), IsOk());
+    return std::move(aead_result.ValueOrDie());
+  }
+
+  int requests(int replica) { return *requests_[replica]; }
+
+  std::vector<std::unique_ptr<std::atomic<int>>> requests_;
+  std::vector<std::unique_ptr<AsyncAead>> replicas_;
+};
+
+TEST_F(HedgedKmsAeadTest, EncryptDecrypt) {
+  AddReplica(absl::ZeroDuration());
+  AddReplica(absl::ZeroDuration());
+  auto aead = HedgedAead(HedgedKmsAead::Options());
+  auto ciphertext_result = aead->Encrypt("plaintext", "ad");
+  ASSERT_THAT(ciphertext_result.status(), IsOk());
+  auto plaintext_result = aead->Decrypt(ciphertext_result.ValueOrDie(), "ad");
+  ASSERT_THAT(plaintext_result.status(), IsOk());
+  EXPECT_EQ("plaintext", plaintext_result.ValueOrDie());
+  EXPECT_EQ(0, requests(1));
+  EXPECT_FALSE(aead->Decrypt(ciphertext_result.ValueOrDie(), "other").ok());
+}
+
+TEST_F(HedgedKmsAeadTest, FailsOverAndPrefersHealthyReplicas) {
+  AddReplica(absl::ZeroDuration(), /*fail=*/true);
+  AddReplica(absl::ZeroDuration());
+  auto aead = HedgedAead(HedgedKmsAead::Options());
+  EXPECT_THAT(aead->Encrypt("plaintext", "ad").status(), IsOk());
+  EXPECT_THAT(aead->Encrypt("plaintext", "ad").status(), IsOk());
+  aead.reset();
+  // The failed replica is not asked again while it is unhealthy.
+  EXPECT_EQ(1, requests(0));
+  EXPECT_EQ(2, requests(1));
+}
+
+TEST_F(HedgedKmsAeadTest, ReturnsLastErrorIfAllReplicasFail) {
+  AddReplica(absl::ZeroDuration(), /*fail=*/true);
+  AddReplica(absl::ZeroDuration(), /*fail=*/true);
+  auto aead = HedgedAead(HedgedKmsAead::Options());
+  EXPECT_THAT(aead->Encrypt("plaintext", "ad").status(),
+              StatusIs(util::error::UNAVAILABLE, HasSubstr("replica is down")));
+  aead.reset();
+  EXPECT_EQ(1, requests(0));
+  EXPECT_EQ(1, requests(1));
+}
+
+TEST_F(HedgedKmsAeadTest, HedgesSlowRequests) {
+  AddReplica(absl::Seconds(2));
+  AddReplica(absl::ZeroDuration());
+  HedgedKmsAead::Options options;
+  options.initial_hedging_delay = absl::Milliseconds(10);
+  auto aead = HedgedAead(options);
+  absl::Time start = absl::Now();
+  EXPECT_THAT(aead->Encrypt("plaintext", "ad").status(), IsOk());
+  EXPECT_LT(absl::Now() - start, absl::Seconds(1));
+  aead.reset();
+  EXPECT_EQ(1, requests(0));
+  EXPECT_EQ(1, requests(1));
+}
+
+TEST_F(HedgedKmsAeadTest, WaitsWithoutHedging) {
+  AddReplica(absl::Milliseconds(50));
+  AddReplica(absl::ZeroDuration());
+  HedgedKmsAead::Options options;
+  options.hedge_requests = false;
+  options.initial_hedging_delay = absl::Milliseconds(10);
+  auto aead = HedgedAead(options);
+  EXPECT_THAT(aead->Encrypt("plaintext", "ad").status(), IsOk());
+  aead.reset();
+  EXPECT_EQ(1, requests(0));
+  EXPECT_EQ(0, requests(1));
+}
+
+TEST_F(HedgedKmsAeadTest, DeadlineExceeded) {
+  AddReplica(absl::Seconds(1));
+  HedgedKmsAead::Options options;
+  options.deadline = absl::Milliseconds(50);
+  auto aead = HedgedAead(options);
+  absl::Time start = absl::Now();
+  EXPECT_THAT(aead->Encrypt("plaintext", "ad").status(),
+              StatusIs(util::error::DEADLINE_EXCEEDED));
+  EXPECT_LT(absl::Now() - start, absl::Milliseconds(500));
+}
+
+TEST_F(HedgedKmsAeadTest, InvalidArguments) {
+  EXPECT_THAT(HedgedKmsAead::New(std::vector<std::unique_ptr<AsyncAead>>(),
+                                 HedgedKmsAead::Options())
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  AddReplica(absl::ZeroDuration());
+  HedgedKmsAead::Options options;
+  options.deadline = absl::Seconds(-1);
+  EXPECT_THAT(HedgedKmsAead::New(std::move(replicas_), options).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
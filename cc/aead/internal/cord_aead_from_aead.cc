@@ -0,0 +1,88 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/internal/cord_aead_from_aead.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "absl/strings/cord.h"
+#include "absl/strings/string_view.h"
+#include "tink/aead/cord_aead.h"
+#include "tink/aead/internal/fragments.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+// Returns the concatenation of 'fragments', which is stored in 'storage'
+// unless there is at most one fragment.
+absl::string_view Gather(CordAead::Fragments fragments, std::string* storage) {
+  if (fragments.empty()) return absl::string_view();
+  if (fragments.size() == 1) {
+    return absl::string_view(
+        reinterpret_cast<const char*>(fragments[0].data()),
+        fragments[0].size());
+  }
+  uint64_t size = internal::FragmentsSize(fragments);
+  subtle::ResizeStringUninitialized(storage, size);
+  internal::CopyFromFragments(fragments, 0, size,
+                              reinterpret_cast<uint8_t*>(&(*storage)[0]));
+  return *storage;
+}
+
+}  // namespace
+
+util::StatusOr<absl::Cord> CordAeadFromAead::Encrypt(
+    absl::Cord plaintext, absl::Cord additional_data) const {
+  return EncryptFragments(internal::CordFragments(plaintext),
+                          internal::CordFragments(additional_data));
+}
+
+util::StatusOr<absl::Cord> CordAeadFromAead::Decrypt(
+    absl::Cord ciphertext, absl::Cord additional_data) const {
+  return DecryptFragments(internal::CordFragments(ciphertext),
+                          internal::CordFragments(additional_data));
+}
+
+util::StatusOr<absl::Cord> CordAeadFromAead::EncryptFragments(
+    Fragments plaintext, Fragments additional_data) const {
+  std::string plaintext_storage;
+  std::string additional_data_storage;
+  auto ciphertext_result =
+      aead_->Encrypt(Gather(plaintext, &plaintext_storage),
+                     Gather(additional_data, &additional_data_storage));
+  if (!ciphertext_result.ok()) return ciphertext_result.status();
+  return absl::Cord(std::move(ciphertext_result.ValueOrDie()));
+}
+
+util::StatusOr<absl::Cord> CordAeadFromAead::DecryptFragments(
+    Fragments ciphertext, Fragments additional_data) const {
+  std::string ciphertext_storage;
+  std::string additional_data_storage;
+  auto plaintext_result =
+      aead_->Decrypt(Gather(ciphertext, &ciphertext_storage),
+                     Gather(additional_data, &additional_data_storage));
+  if (!plaintext_result.ok()) return plaintext_result.status();
+  return absl::Cord(std::move(plaintext_result.ValueOrDie()));
+}
+
+}  // namespace tink
+}  // namespace crypto
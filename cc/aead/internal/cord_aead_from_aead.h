@@ -0,0 +1,62 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_AEAD_INTERNAL_CORD_AEAD_FROM_AEAD_H_
+#define TINK_AEAD_INTERNAL_CORD_AEAD_FROM_AEAD_H_
+
+#include <memory>
+#include <utility>
+
+#include "absl/strings/cord.h"
+#include "tink/aead.h"
+#include "tink/aead/cord_aead.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+// A CordAead for an Aead which can only process contiguous messages, such as
+// XChaCha20-Poly1305 and AES-GCM-SIV, which BoringSSL implements as one-shot
+// EVP_AEADs (and AES-GCM-SIV needs two passes over the plaintext anyway).
+// Inputs of more than one fragment are copied once into a contiguous buffer;
+// the output of the Aead becomes the returned Cord without a copy.
+class CordAeadFromAead : public CordAead {
+ public:
+  explicit CordAeadFromAead(std::unique_ptr<Aead> aead)
+      : aead_(std::move(aead)) {}
+
+  crypto::tink::util::StatusOr<absl::Cord> Encrypt(
+      absl::Cord plaintext, absl::Cord additional_data) const override;
+
+  crypto::tink::util::StatusOr<absl::Cord> Decrypt(
+      absl::Cord ciphertext, absl::Cord additional_data) const override;
+
+  crypto::tink::util::StatusOr<absl::Cord> EncryptFragments(
+      Fragments plaintext, Fragments additional_data) const override;
+
+  crypto::tink::util::StatusOr<absl::Cord> DecryptFragments(
+      Fragments ciphertext, Fragments additional_data) const override;
+
+  ~CordAeadFromAead() override {}
+
+ private:
+  const std::unique_ptr<Aead> aead_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_AEAD_INTERNAL_CORD_AEAD_FROM_AEAD_H_
@@ -0,0 +1,117 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/internal/cord_aead_from_aead.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/subtle/aes_gcm_siv_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/xchacha20_poly1305_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+
+// Splits 'data' into fragments of 'fragment_size' bytes, with an empty
+// fragment in front.
+std::vector<absl::Span<const uint8_t>> Split(absl::string_view data,
+                                             int fragment_size) {
+  std::vector<absl::Span<const uint8_t>> fragments = {{}};
+  for (int pos = 0; pos < data.size(); pos += fragment_size) {
+    absl::string_view fragment = data.substr(pos, fragment_size);
+    fragments.push_back(absl::MakeConstSpan(
+        reinterpret_cast<const uint8_t*>(fragment.data()), fragment.size()));
+  }
+  return fragments;
+}
+
+std::vector<std::unique_ptr<Aead>> Aeads() {
+  std::vector<std::unique_ptr<Aead>> aeads;
+  aeads.push_back(std::move(subtle::XChacha20Poly1305BoringSsl::New(
+                                subtle::Random::GetRandomKeyBytes(32))
+                                .ValueOrDie()));
+  auto aes_gcm_siv =
+      subtle::AesGcmSivBoringSsl::New(subtle::Random::GetRandomKeyBytes(32));
+  // AES-GCM-SIV is not available with every SSL library.
+  if (aes_gcm_siv.ok()) aeads.push_back(std::move(aes_gcm_siv.ValueOrDie()));
+  return aeads;
+}
+
+TEST(CordAeadFromAeadTest, EncryptDecryptFragments) {
+  const std::string message = subtle::Random::GetRandomBytes(1000);
+  const std::string aad = "Some data to authenticate.";
+  for (auto& aead : Aeads()) {
+    Aead* raw_aead = aead.get();
+    CordAeadFromAead cord_aead(std::move(aead));
+    for (int fragment_size : {1, 7, 100, 1000}) {
+      SCOPED_TRACE(absl::StrCat("fragment_size = ", fragment_size));
+      auto ct = cord_aead.EncryptFragments(Split(message, fragment_size),
+                                           Split(aad, fragment_size));
+      ASSERT_THAT(ct.status(), IsOk());
+      std::string ciphertext = std::string(ct.ValueOrDie());
+
+      auto pt = cord_aead.DecryptFragments(Split(ciphertext, fragment_size),
+                                           Split(aad, fragment_size));
+      ASSERT_THAT(pt.status(), IsOk());
+      EXPECT_EQ(std::string(pt.ValueOrDie()), message);
+
+      auto pt_cord = cord_aead.Decrypt(absl::Cord(ciphertext), absl::Cord(aad));
+      ASSERT_THAT(pt_cord.status(), IsOk());
+      EXPECT_EQ(std::string(pt_cord.ValueOrDie()), message);
+
+      auto pt_string = raw_aead->Decrypt(ciphertext, aad);
+      ASSERT_THAT(pt_string.status(), IsOk());
+      EXPECT_EQ(pt_string.ValueOrDie(), message);
+
+      EXPECT_FALSE(cord_aead
+                       .DecryptFragments(Split(ciphertext, fragment_size),
+                                         Split("wrong aad", fragment_size))
+                       .ok());
+    }
+  }
+}
+
+TEST(CordAeadFromAeadTest, EncryptDecryptCord) {
+  const std::string message = subtle::Random::GetRandomBytes(100);
+  const std::string aad = "Some data to authenticate.";
+  for (auto& aead : Aeads()) {
+    CordAeadFromAead cord_aead(std::move(aead));
+    auto ct = cord_aead.Encrypt(absl::Cord(message), absl::Cord(aad));
+    ASSERT_THAT(ct.status(), IsOk());
+    auto pt = cord_aead.Decrypt(ct.ValueOrDie(), absl::Cord(aad));
+    ASSERT_THAT(pt.status(), IsOk());
+    EXPECT_EQ(std::string(pt.ValueOrDie()), message);
+    EXPECT_FALSE(cord_aead.Decrypt(ct.ValueOrDie(), absl::Cord("")).ok());
+  }
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
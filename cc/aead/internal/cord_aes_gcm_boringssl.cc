@@ -20,12 +20,14 @@
 #include <string>
 #include <vector>
 
+#include "absl/memory/memory.h"
 #include "absl/strings/cord.h"
 #include "openssl/aead.h"
 #include "openssl/base.h"
 #include "openssl/cipher.h"
 #include "openssl/err.h"
 #include "tink/aead/cord_aead.h"
+#include "tink/aead/internal/fragments.h"
 #include "tink/subtle/random.h"
 #include "tink/subtle/subtle_util.h"
 #include "tink/subtle/subtle_util_boringssl.h"
@@ -37,76 +39,158 @@
 namespace crypto {
 namespace tink {
 
-util::Status CordAesGcmBoringSsl::Init(util::SecretData key_value) {
-  cipher_ =
+util::StatusOr<std::unique_ptr<CordAead>> CordAesGcmBoringSsl::New(
+    util::SecretData key_value) {
+  const EVP_CIPHER* cipher =
       subtle::SubtleUtilBoringSSL::GetAesGcmCipherForKeySize(key_value.size());
-
-  if (cipher_ == nullptr) {
+  if (cipher == nullptr) {
     return util::Status(util::error::INTERNAL, "invalid key size");
   }
 
-  key_ = key_value;
-  return util::OkStatus();
+  // Expand the key once; messages only set their IV on a copy of this
+  // context.
+  bssl::UniquePtr<EVP_CIPHER_CTX> context(EVP_CIPHER_CTX_new());
+  if (context == nullptr ||
+      !EVP_EncryptInit_ex(context.get(), cipher, nullptr, nullptr, nullptr)) {
+    return util::Status(util::error::INTERNAL, "Encryption init failed");
+  }
+  if (!EVP_CIPHER_CTX_ctrl(context.get(), EVP_CTRL_GCM_SET_IVLEN,
+                           kIvSizeInBytes, nullptr)) {
+    return util::Status(util::error::INTERNAL, "Setting IV size failed");
+  }
+  if (!EVP_EncryptInit_ex(context.get(), nullptr, nullptr,
+                          reinterpret_cast<const uint8_t*>(key_value.data()),
+                          nullptr)) {
+    return util::Status(util::error::INTERNAL, "Encryption init failed");
+  }
+  return {absl::WrapUnique(new CordAesGcmBoringSsl(std::move(context)))};
 }
 
-util::StatusOr<std::unique_ptr<CordAead>> CordAesGcmBoringSsl::New(
-    util::SecretData key_value) {
-  std::unique_ptr<CordAesGcmBoringSsl> aead(new CordAesGcmBoringSsl);
-  auto status = aead->Init(key_value);
-  if (!status.ok()) {
-    return status;
+util::Status CordAesGcmBoringSsl::InitContext(EVP_CIPHER_CTX* ctx,
+                                              absl::string_view iv,
+                                              bool encrypt) const {
+  if (!EVP_CIPHER_CTX_copy(ctx, context_.get())) {
+    return util::Status(util::error::INTERNAL, "Copying context failed");
+  }
+  if (!EVP_CipherInit_ex(ctx, nullptr, nullptr, nullptr,
+                         reinterpret_cast<const uint8_t*>(iv.data()),
+                         encrypt ? 1 : 0)) {
+    return util::Status(util::error::INTERNAL,
+                        encrypt ? "Encryption init failed"
+                                : "Decryption init failed");
   }
-  return util::StatusOr<std::unique_ptr<CordAead>>(std::move(aead));
+  return util::OkStatus();
 }
 
 util::StatusOr<absl::Cord> CordAesGcmBoringSsl::Encrypt(
     absl::Cord plaintext, absl::Cord additional_data) const {
-  std::string iv = subtle::Random::GetRandomBytes(kIvSizeInBytes);
+  return EncryptFragments(internal::CordFragments(plaintext),
+                          internal::CordFragments(additional_data));
+}
 
-  bssl::UniquePtr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new());
+util::StatusOr<absl::Cord> CordAesGcmBoringSsl::Decrypt(
+    absl::Cord ciphertext, absl::Cord additional_data) const {
+  if (ciphertext.size() < kIvSizeInBytes + kTagSizeInBytes) {
+    return util::Status(util::error::INTERNAL, "Ciphertext too short");
+  }
+  std::string iv(ciphertext.Subcord(0, kIvSizeInBytes));
+  std::string tag(ciphertext.Subcord(ciphertext.size() - kTagSizeInBytes,
+                                     kTagSizeInBytes));
+  ciphertext.RemovePrefix(kIvSizeInBytes);
+  ciphertext.RemoveSuffix(kTagSizeInBytes);
 
-  if (!EVP_EncryptInit_ex(ctx.get(), cipher_, nullptr, nullptr, nullptr)) {
-    return util::Status(util::error::INTERNAL, "Encryption init failed");
+  bssl::ScopedEVP_CIPHER_CTX ctx;
+  auto status = InitContext(ctx.get(), iv, /*encrypt=*/false);
+  if (!status.ok()) return status;
+
+  int len = 0;
+  // Process AD
+  for (absl::Span<const uint8_t> ad_fragment :
+       internal::CordFragments(additional_data)) {
+    if (ad_fragment.empty()) continue;
+    if (!EVP_DecryptUpdate(ctx.get(), nullptr, &len, ad_fragment.data(),
+                           ad_fragment.size())) {
+      return util::Status(util::error::INTERNAL, "Decryption failed");
+    }
   }
 
-  if (!EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_IVLEN, kIvSizeInBytes,
-                           nullptr)) {
-    return util::Status(util::error::INTERNAL, "Setting IV size failed");
+  uint64_t plaintext_len = ciphertext.size();
+  char* plaintext_buffer = std::allocator<char>().allocate(plaintext_len);
+  uint64_t plaintext_buffer_offset = 0;
+
+  absl::Cord result = absl::MakeCordFromExternal(
+      absl::string_view(plaintext_buffer, plaintext_len),
+      [](absl::string_view sv) {
+        std::allocator<char>().deallocate(const_cast<char*>(sv.data()),
+                                          sv.size());
+      });
+
+  // Drops every chunk of the ciphertext once it is decrypted.  Unless the
+  // caller still shares the chunk, this frees it, so that the ciphertext
+  // shrinks while the plaintext grows.
+  while (!ciphertext.empty()) {
+    absl::string_view ct_chunk = *ciphertext.chunk_begin();
+    if (!EVP_DecryptUpdate(
+            ctx.get(),
+            reinterpret_cast<uint8_t*>(
+                &plaintext_buffer[plaintext_buffer_offset]),
+            &len, reinterpret_cast<const uint8_t*>(ct_chunk.data()),
+            ct_chunk.size())) {
+      return util::Status(util::error::INTERNAL, "Decryption failed");
+    }
+    plaintext_buffer_offset += ct_chunk.size();
+    ciphertext.RemovePrefix(ct_chunk.size());
   }
 
-  if (!EVP_EncryptInit_ex(ctx.get(), nullptr, nullptr,
-                          reinterpret_cast<const uint8_t*>(key_.data()),
-                          reinterpret_cast<const uint8_t*>(iv.data()))) {
-    return util::Status(util::error::INTERNAL, "Encryption init failed");
+  if (!EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_TAG, kTagSizeInBytes,
+                           reinterpret_cast<uint8_t*>(&tag[0]))) {
+    return util::Status(util::error::INTERNAL,
+                        "Could not set authentication tag");
+  }
+  // Verify authentication tag
+  if (!EVP_DecryptFinal_ex(ctx.get(), nullptr, &len)) {
+    return util::Status(util::error::INTERNAL, "Authentication failed");
   }
+  return result;
+}
+
+util::StatusOr<absl::Cord> CordAesGcmBoringSsl::EncryptFragments(
+    Fragments plaintext, Fragments additional_data) const {
+  std::string iv = subtle::Random::GetRandomBytes(kIvSizeInBytes);
+
+  bssl::ScopedEVP_CIPHER_CTX ctx;
+  auto status = InitContext(ctx.get(), iv, /*encrypt=*/true);
+  if (!status.ok()) return status;
 
   int len = 0;
-  // Process AD
-  for (auto ad_chunk : additional_data.Chunks()) {
-    if (!EVP_EncryptUpdate(ctx.get(), nullptr, &len,
-                           reinterpret_cast<const uint8_t*>(ad_chunk.data()),
-                           ad_chunk.size())) {
+  // Process AD. Empty fragments are skipped, since EVP treats a null input
+  // as the end of the message.
+  for (absl::Span<const uint8_t> ad_fragment : additional_data) {
+    if (ad_fragment.empty()) continue;
+    if (!EVP_EncryptUpdate(ctx.get(), nullptr, &len, ad_fragment.data(),
+                           ad_fragment.size())) {
       return util::Status(util::error::INTERNAL, "Encryption failed");
     }
   }
 
-  char* buffer = std::allocator<char>().allocate(plaintext.size());
+  uint64_t plaintext_len = internal::FragmentsSize(plaintext);
+  char* buffer = std::allocator<char>().allocate(plaintext_len);
   absl::Cord ciphertext_buffer = absl::MakeCordFromExternal(
-      absl::string_view(buffer, plaintext.size()), [](absl::string_view sv) {
+      absl::string_view(buffer, plaintext_len), [](absl::string_view sv) {
         std::allocator<char>().deallocate(const_cast<char*>(sv.data()),
                                           sv.size());
       });
   uint64_t ciphertext_buffer_offset = 0;
 
-  for (auto plaintext_chunk : plaintext.Chunks()) {
+  for (absl::Span<const uint8_t> plaintext_fragment : plaintext) {
+    if (plaintext_fragment.empty()) continue;
     if (!EVP_EncryptUpdate(
             ctx.get(),
             reinterpret_cast<uint8_t*>(&(buffer[ciphertext_buffer_offset])),
-            &len, reinterpret_cast<const uint8_t*>(plaintext_chunk.data()),
-            plaintext_chunk.size())) {
+            &len, plaintext_fragment.data(), plaintext_fragment.size())) {
       return util::Status(util::error::INTERNAL, "Encryption failed");
     }
-    ciphertext_buffer_offset += plaintext_chunk.size();
+    ciphertext_buffer_offset += plaintext_fragment.size();
   }
   if (!EVP_EncryptFinal_ex(ctx.get(), nullptr, &len)) {
     return util::Status(util::error::INTERNAL, "Encryption failed");
@@ -127,44 +211,37 @@ util::StatusOr<absl::Cord> CordAesGcmBoringSsl::Encrypt(
   return result;
 }
 
-util::StatusOr<absl::Cord> CordAesGcmBoringSsl::Decrypt(
-    absl::Cord ciphertext, absl::Cord additional_data) const {
-  if (ciphertext.size() < kIvSizeInBytes + kTagSizeInBytes) {
+util::StatusOr<absl::Cord> CordAesGcmBoringSsl::DecryptFragments(
+    Fragments ciphertext, Fragments additional_data) const {
+  uint64_t ciphertext_len = internal::FragmentsSize(ciphertext);
+  if (ciphertext_len < kIvSizeInBytes + kTagSizeInBytes) {
     return util::Status(util::error::INTERNAL, "Ciphertext too short");
   }
 
   // First bytes contain IV
-  std::string iv = std::string(ciphertext.Subcord(0, kIvSizeInBytes));
-  absl::Cord raw_ciphertext = ciphertext.Subcord(
-      kIvSizeInBytes, ciphertext.size() - kIvSizeInBytes - kTagSizeInBytes);
-
-  bssl::UniquePtr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new());
-  if (!EVP_DecryptInit_ex(ctx.get(), cipher_, nullptr, nullptr, nullptr)) {
-    return util::Status(util::error::INTERNAL, "Decryption init failed");
-  }
-
-  if (!EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_IVLEN, kIvSizeInBytes,
-                           nullptr)) {
-    return util::Status(util::error::INTERNAL, "Setting IV size failed");
-  }
+  std::string iv;
+  subtle::ResizeStringUninitialized(&iv, kIvSizeInBytes);
+  internal::CopyFromFragments(ciphertext, 0, kIvSizeInBytes,
+                              reinterpret_cast<uint8_t*>(&iv[0]));
+  uint64_t plaintext_len = ciphertext_len - kIvSizeInBytes - kTagSizeInBytes;
+  std::vector<absl::Span<const uint8_t>> raw_ciphertext =
+      internal::SubFragments(ciphertext, kIvSizeInBytes,
+                             kIvSizeInBytes + plaintext_len);
 
-  if (!EVP_DecryptInit_ex(ctx.get(), nullptr, nullptr,
-                          reinterpret_cast<const uint8_t*>(key_.data()),
-                          reinterpret_cast<const uint8_t*>(iv.data()))) {
-    return util::Status(util::error::INTERNAL, "Decryption init failed");
-  }
+  bssl::ScopedEVP_CIPHER_CTX ctx;
+  auto status = InitContext(ctx.get(), iv, /*encrypt=*/false);
+  if (!status.ok()) return status;
 
   int len = 0;
   // Process AD
-  for (auto ad_chunk : additional_data.Chunks()) {
-    if (!EVP_DecryptUpdate(ctx.get(), nullptr, &len,
-                           reinterpret_cast<const uint8_t*>(ad_chunk.data()),
-                           ad_chunk.size())) {
+  for (absl::Span<const uint8_t> ad_fragment : additional_data) {
+    if (ad_fragment.empty()) continue;
+    if (!EVP_DecryptUpdate(ctx.get(), nullptr, &len, ad_fragment.data(),
+                           ad_fragment.size())) {
       return util::Status(util::error::INTERNAL, "Decryption failed");
     }
   }
 
-  uint64_t plaintext_len = ciphertext.size() - kIvSizeInBytes - kTagSizeInBytes;
   char* plaintext_buffer = std::allocator<char>().allocate(plaintext_len);
   uint64_t plaintext_buffer_offset = 0;
 
@@ -175,24 +252,24 @@ util::StatusOr<absl::Cord> CordAesGcmBoringSsl::Decrypt(
                                           sv.size());
       });
 
-  for (auto ct_chunk : raw_ciphertext.Chunks()) {
+  for (absl::Span<const uint8_t> ct_fragment : raw_ciphertext) {
+    if (ct_fragment.empty()) continue;
     if (!EVP_DecryptUpdate(ctx.get(),
                            reinterpret_cast<uint8_t*>(
                                &plaintext_buffer[plaintext_buffer_offset]),
-                           &len,
-                           reinterpret_cast<const uint8_t*>(ct_chunk.data()),
-                           ct_chunk.size())) {
+                           &len, ct_fragment.data(), ct_fragment.size())) {
       return util::Status(util::error::INTERNAL, "Decryption failed");
     }
-    plaintext_buffer_offset += ct_chunk.size();
+    plaintext_buffer_offset += ct_fragment.size();
   }
 
-  // Set expected tag value to last chunk in ciphertext Cord
-  std::string tag = std::string(
-      ciphertext.Subcord(ciphertext.size() - kTagSizeInBytes, kTagSizeInBytes));
+  // The tag is in the last bytes of the ciphertext.
+  uint8_t tag[kTagSizeInBytes];
+  internal::CopyFromFragments(ciphertext, ciphertext_len - kTagSizeInBytes,
+                              kTagSizeInBytes, tag);
 
   if (!EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_TAG, kTagSizeInBytes,
-                           &tag[0])) {
+                           tag)) {
     return util::Status(util::error::INTERNAL,
                         "Could not set authentication tag");
   }
@@ -16,6 +16,7 @@
 #define TINK_AEAD_INTERNAL_CORD_AES_GCM_BORINGSSL_H_
 
 #include <memory>
+#include <utility>
 
 #include "absl/strings/string_view.h"
 #include "openssl/aead.h"
@@ -37,20 +38,40 @@ class CordAesGcmBoringSsl : public CordAead {
   crypto::tink::util::StatusOr<absl::Cord> Encrypt(
       absl::Cord plaintext, absl::Cord additional_data) const override;
 
+  // Decrypts into a single buffer of the size of the plaintext, and drops
+  // the chunks of 'ciphertext' as soon as they are decrypted. Callers which
+  // move a ciphertext they do not share into Decrypt() hence hold about the
+  // size of one message in memory, rather than ciphertext and plaintext.
   crypto::tink::util::StatusOr<absl::Cord> Decrypt(
       absl::Cord ciphertext, absl::Cord additional_data) const override;
 
+  // Processes the fragments incrementally, without copying them into a
+  // contiguous buffer.
+  crypto::tink::util::StatusOr<absl::Cord> EncryptFragments(
+      Fragments plaintext, Fragments additional_data) const override;
+
+  crypto::tink::util::StatusOr<absl::Cord> DecryptFragments(
+      Fragments ciphertext, Fragments additional_data) const override;
+
   ~CordAesGcmBoringSsl() override {}
 
  private:
   static constexpr int kIvSizeInBytes = 12;
   static constexpr int kTagSizeInBytes = 16;
 
-  CordAesGcmBoringSsl() {}
-  crypto::tink::util::Status Init(crypto::tink::util::SecretData key_value);
+  explicit CordAesGcmBoringSsl(bssl::UniquePtr<EVP_CIPHER_CTX> context)
+      : context_(std::move(context)) {}
+
+  // Initializes 'ctx' as a copy of context_ with the given IV, for
+  // encryption or decryption.
+  crypto::tink::util::Status InitContext(EVP_CIPHER_CTX* ctx,
+                                         absl::string_view iv,
+                                         bool encrypt) const;
 
-  const EVP_CIPHER *cipher_;
-  crypto::tink::util::SecretData key_;
+  // A context with the key schedule (and hence the GHASH key) already set
+  // up, which is copied for every message instead of re-keying.  It is
+  // never modified after construction.
+  const bssl::UniquePtr<EVP_CIPHER_CTX> context_;
 };
 
 }  // namespace tink
@@ -22,6 +22,8 @@
 #include "absl/strings/cord_test_helpers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/err.h"
 #include "include/rapidjson/document.h"
 #include "tink/subtle/aes_gcm_boringssl.h"
@@ -61,6 +63,36 @@ TEST(CordAesGcmBoringSslTest, EncryptDecryptCord) {
   EXPECT_EQ(pt.ValueOrDie(), message_cord.Flatten());
 }
 
+TEST(CordAesGcmBoringSslTest, ReusesKeyAcrossMessages) {
+  util::SecretData key = util::SecretDataFromStringView(
+      test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
+  auto res = CordAesGcmBoringSsl::New(key);
+  ASSERT_THAT(res.status(), IsOk());
+  auto cipher = std::move(res.ValueOrDie());
+  const absl::Cord aad_cord = absl::Cord("Some data to authenticate.");
+
+  // Interleave encryptions and decryptions on the same instance, so that
+  // every message has to start from the cached key schedule.
+  std::vector<absl::Cord> ciphertexts;
+  for (int i = 0; i < 10; i++) {
+    auto ct = cipher->Encrypt(absl::Cord(absl::StrCat("message ", i)),
+                              aad_cord);
+    ASSERT_THAT(ct.status(), IsOk());
+    if (!ciphertexts.empty()) {
+      EXPECT_NE(ct.ValueOrDie(), ciphertexts.back());
+      auto pt = cipher->Decrypt(ciphertexts.back(), aad_cord);
+      ASSERT_THAT(pt.status(), IsOk());
+      EXPECT_EQ(pt.ValueOrDie(), absl::StrCat("message ", i - 1));
+    }
+    ciphertexts.push_back(ct.ValueOrDie());
+  }
+  for (int i = 0; i < 10; i++) {
+    auto pt = cipher->Decrypt(ciphertexts[i], aad_cord);
+    ASSERT_THAT(pt.status(), IsOk());
+    EXPECT_EQ(pt.ValueOrDie(), absl::StrCat("message ", i));
+  }
+}
+
 TEST(CordAesGcmBoringSslTest, ChunkyCordEncrypt) {
   util::SecretData key = util::SecretDataFromStringView(
       test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
@@ -106,6 +138,41 @@ TEST(CordAesGcmBoringSslTest, ChunkyCordDecrypt) {
   EXPECT_THAT(pt.ValueOrDie(), Eq(message));
 }
 
+TEST(CordAesGcmBoringSslTest, DecryptMovedAndSharedCiphertexts) {
+  util::SecretData key = util::SecretDataFromStringView(
+      test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
+  auto res = CordAesGcmBoringSsl::New(key);
+  ASSERT_THAT(res.status(), IsOk());
+  auto cipher = std::move(res.ValueOrDie());
+  std::string message(100000, 'm');
+  const absl::Cord aad_cord = absl::Cord("Some data to authenticate.");
+
+  auto ct = cipher->Encrypt(absl::Cord(message), aad_cord);
+  ASSERT_THAT(ct.status(), IsOk());
+  std::string ciphertext(ct.ValueOrDie());
+  absl::Cord shared_ct =
+      absl::MakeFragmentedCord(absl::StrSplit(ciphertext, absl::ByLength(997)));
+
+  // Decrypting a copy leaves the chunks of the shared ciphertext intact.
+  auto pt = cipher->Decrypt(shared_ct, aad_cord);
+  ASSERT_THAT(pt.status(), IsOk());
+  EXPECT_EQ(pt.ValueOrDie(), message);
+  EXPECT_EQ(shared_ct, ciphertext);
+
+  // The sole owner of a ciphertext can move it into Decrypt().
+  pt = cipher->Decrypt(std::move(shared_ct), aad_cord);
+  ASSERT_THAT(pt.status(), IsOk());
+  EXPECT_EQ(pt.ValueOrDie(), message);
+
+  // A ciphertext with a wrong tag fails after all chunks were decrypted.
+  ciphertext.back() ^= 1;
+  EXPECT_FALSE(cipher
+                   ->Decrypt(absl::MakeFragmentedCord(absl::StrSplit(
+                                 ciphertext, absl::ByLength(997))),
+                             aad_cord)
+                   .ok());
+}
+
 TEST(CordAesGcmBoringSslTest, SameResultAsString) {
   util::SecretData key = util::SecretDataFromStringView(
       test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
@@ -137,6 +204,56 @@ TEST(CordAesGcmBoringSslTest, SameResultAsString) {
   EXPECT_EQ(pt.ValueOrDie(), message);
 }
 
+// Splits 'data' into fragments of 'fragment_size' bytes, with an empty
+// fragment in front.
+std::vector<absl::Span<const uint8_t>> Split(absl::string_view data,
+                                             int fragment_size) {
+  std::vector<absl::Span<const uint8_t>> fragments = {{}};
+  for (int pos = 0; pos < data.size(); pos += fragment_size) {
+    absl::string_view fragment = data.substr(pos, fragment_size);
+    fragments.push_back(absl::MakeConstSpan(
+        reinterpret_cast<const uint8_t*>(fragment.data()), fragment.size()));
+  }
+  return fragments;
+}
+
+TEST(CordAesGcmBoringSslTest, EncryptDecryptFragments) {
+  util::SecretData key = util::SecretDataFromStringView(
+      test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
+  auto res = CordAesGcmBoringSsl::New(key);
+  ASSERT_THAT(res.status(), IsOk());
+  auto cipher = std::move(res.ValueOrDie());
+  auto res_string = subtle::AesGcmBoringSsl::New(key);
+  ASSERT_THAT(res_string.status(), IsOk());
+  auto cipher_string = std::move(res_string.ValueOrDie());
+  const std::string message(1000, 'm');
+  const std::string aad = "Some data to authenticate.";
+
+  for (int fragment_size : {1, 7, 16, 100, 1000}) {
+    SCOPED_TRACE(absl::StrCat("fragment_size = ", fragment_size));
+    auto ct = cipher->EncryptFragments(Split(message, fragment_size),
+                                       Split(aad, fragment_size));
+    ASSERT_THAT(ct.status(), IsOk());
+    std::string ciphertext = std::string(ct.ValueOrDie());
+    EXPECT_EQ(ciphertext.size(), message.size() + 12 + 16);
+
+    // The IV and the tag may span several fragments.
+    auto pt = cipher->DecryptFragments(Split(ciphertext, fragment_size),
+                                       Split(aad, fragment_size));
+    ASSERT_THAT(pt.status(), IsOk());
+    EXPECT_EQ(std::string(pt.ValueOrDie()), message);
+
+    auto pt_string = cipher_string->Decrypt(ciphertext, aad);
+    ASSERT_THAT(pt_string.status(), IsOk());
+    EXPECT_EQ(pt_string.ValueOrDie(), message);
+
+    EXPECT_FALSE(cipher
+                     ->DecryptFragments(Split(ciphertext, fragment_size),
+                                        Split("wrong aad", fragment_size))
+                     .ok());
+  }
+}
+
 TEST(CordAesGcmBoringSslTest, ModifiedCord) {
   util::SecretData key = util::SecretDataFromStringView(
       test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
@@ -0,0 +1,80 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/internal/fragments.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "absl/strings/cord.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/aead/cord_aead.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+uint64_t FragmentsSize(CordAead::Fragments fragments) {
+  uint64_t size = 0;
+  for (absl::Span<const uint8_t> fragment : fragments) {
+    size += fragment.size();
+  }
+  return size;
+}
+
+void CopyFromFragments(CordAead::Fragments fragments, uint64_t offset,
+                       uint64_t size, uint8_t* out) {
+  for (absl::Span<const uint8_t> fragment :
+       SubFragments(fragments, offset, offset + size)) {
+    std::memcpy(out, fragment.data(), fragment.size());
+    out += fragment.size();
+  }
+}
+
+std::vector<absl::Span<const uint8_t>> SubFragments(
+    CordAead::Fragments fragments, uint64_t begin, uint64_t end) {
+  std::vector<absl::Span<const uint8_t>> result;
+  if (begin >= end) return result;
+  uint64_t fragment_begin = 0;
+  for (absl::Span<const uint8_t> fragment : fragments) {
+    if (fragment.empty()) continue;
+    uint64_t fragment_end = fragment_begin + fragment.size();
+    if (fragment_end > begin && fragment_begin < end) {
+      uint64_t from = std::max(begin, fragment_begin) - fragment_begin;
+      uint64_t to = std::min(end, fragment_end) - fragment_begin;
+      result.push_back(fragment.subspan(from, to - from));
+    }
+    if (fragment_end >= end) break;
+    fragment_begin = fragment_end;
+  }
+  return result;
+}
+
+std::vector<absl::Span<const uint8_t>> CordFragments(const absl::Cord& cord) {
+  std::vector<absl::Span<const uint8_t>> result;
+  for (absl::string_view chunk : cord.Chunks()) {
+    result.push_back(absl::MakeConstSpan(
+        reinterpret_cast<const uint8_t*>(chunk.data()), chunk.size()));
+  }
+  return result;
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,55 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_AEAD_INTERNAL_FRAGMENTS_H_
+#define TINK_AEAD_INTERNAL_FRAGMENTS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/strings/cord.h"
+#include "absl/types/span.h"
+#include "tink/aead/cord_aead.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// Helpers for CordAead::Fragments.
+
+// Returns the total size of 'fragments'.
+uint64_t FragmentsSize(CordAead::Fragments fragments);
+
+// Copies the 'size' bytes at 'offset' of the concatenation of 'fragments' to
+// 'out'. The range must be within the total size of 'fragments'.
+void CopyFromFragments(CordAead::Fragments fragments, uint64_t offset,
+                       uint64_t size, uint8_t* out);
+
+// Returns the fragments which cover the bytes from 'begin' up to 'end' of the
+// concatenation of 'fragments', without copying them. None of the returned
+// fragments is empty.
+std::vector<absl::Span<const uint8_t>> SubFragments(
+    CordAead::Fragments fragments, uint64_t begin, uint64_t end);
+
+// Returns the chunks of 'cord' as fragments, which are valid as long as
+// 'cord' is neither modified nor destroyed.
+std::vector<absl::Span<const uint8_t>> CordFragments(const absl::Cord& cord);
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_AEAD_INTERNAL_FRAGMENTS_H_
@@ -0,0 +1,94 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/internal/fragments.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "tink/aead/cord_aead.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+absl::Span<const uint8_t> AsSpan(absl::string_view s) {
+  return absl::MakeConstSpan(reinterpret_cast<const uint8_t*>(s.data()),
+                             s.size());
+}
+
+std::string Concatenate(CordAead::Fragments fragments) {
+  std::string result;
+  for (absl::Span<const uint8_t> fragment : fragments) {
+    result.append(reinterpret_cast<const char*>(fragment.data()),
+                  fragment.size());
+  }
+  return result;
+}
+
+TEST(FragmentsTest, Size) {
+  std::vector<absl::Span<const uint8_t>> fragments = {
+      AsSpan("abc"), AsSpan(""), AsSpan("defgh")};
+  EXPECT_EQ(8, FragmentsSize(fragments));
+  EXPECT_EQ(0, FragmentsSize({}));
+}
+
+TEST(FragmentsTest, SubFragmentsAndCopy) {
+  std::string contents = "abcdefghijklmnop";
+  std::vector<absl::Span<const uint8_t>> fragments = {
+      AsSpan(absl::string_view(contents).substr(0, 3)),
+      AsSpan(absl::string_view(contents).substr(3, 0)),
+      AsSpan(absl::string_view(contents).substr(3, 7)),
+      AsSpan(absl::string_view(contents).substr(10, 1)),
+      AsSpan(absl::string_view(contents).substr(11))};
+  for (int begin = 0; begin <= contents.size(); begin++) {
+    for (int end = begin; end <= contents.size(); end++) {
+      SCOPED_TRACE(absl::StrCat("begin = ", begin, ", end = ", end));
+      std::vector<absl::Span<const uint8_t>> sub_fragments =
+          SubFragments(fragments, begin, end);
+      EXPECT_EQ(contents.substr(begin, end - begin),
+                Concatenate(sub_fragments));
+      for (absl::Span<const uint8_t> fragment : sub_fragments) {
+        EXPECT_FALSE(fragment.empty());
+      }
+      std::string copy(end - begin, 'x');
+      CopyFromFragments(fragments, begin, end - begin,
+                        reinterpret_cast<uint8_t*>(&copy[0]));
+      EXPECT_EQ(contents.substr(begin, end - begin), copy);
+    }
+  }
+}
+
+TEST(FragmentsTest, CordFragments) {
+  absl::Cord cord;
+  cord.Append(std::string(5000, 'a'));
+  cord.Append(std::string(5000, 'b'));
+  std::vector<absl::Span<const uint8_t>> fragments = CordFragments(cord);
+  EXPECT_LE(2, fragments.size());
+  EXPECT_EQ(std::string(cord), Concatenate(fragments));
+  EXPECT_TRUE(CordFragments(absl::Cord()).empty());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
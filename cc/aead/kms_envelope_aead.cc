@@ -14,14 +14,30 @@
 
 #include "tink/aead/kms_envelope_aead.h"
 
+#include <algorithm>
+#include <functional>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/base/internal/endian.h"
+#include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "absl/types/optional.h"
 #include "tink/aead.h"
+#include "tink/async_aead.h"
+#include "tink/internal/traced_operation.h"
+#include "tink/key_manager.h"
 #include "tink/registry.h"
 #include "tink/util/errors.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/secret_proto.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
@@ -48,83 +64,405 @@ std::string GetEnvelopeCiphertext(absl::string_view encrypted_dek,
                       encrypted_dek, encrypted_plaintext);
 }
 
+// Splits a ciphertext of the format above into 'encrypted_dek' and
+// 'payload', which point into 'ciphertext'.
+util::Status ParseEnvelopeCiphertext(absl::string_view ciphertext,
+                                     absl::string_view* encrypted_dek,
+                                     absl::string_view* payload) {
+  if (ciphertext.size() < kEncryptedDekPrefixSize) {
+    return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too short");
+  }
+  auto enc_dek_size = absl::big_endian::Load32(
+      reinterpret_cast<const uint8_t*>(ciphertext.data()));
+  if (enc_dek_size > ciphertext.size() - kEncryptedDekPrefixSize ||
+      enc_dek_size < 0) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid ciphertext");
+  }
+  *encrypted_dek = ciphertext.substr(kEncryptedDekPrefixSize, enc_dek_size);
+  *payload = ciphertext.substr(kEncryptedDekPrefixSize + enc_dek_size);
+  return util::OkStatus();
+}
+
+// An AsyncAead that runs the operations of a (blocking) Aead before
+// returning.
+class BlockingAsyncAead : public AsyncAead {
+ public:
+  explicit BlockingAsyncAead(std::unique_ptr<Aead> aead)
+      : aead_(std::move(aead)) {}
+
+  void EncryptAsync(absl::string_view plaintext,
+                    absl::string_view associated_data,
+                    DoneCallback done) const override {
+    done(aead_->Encrypt(plaintext, associated_data));
+  }
+
+  void DecryptAsync(absl::string_view ciphertext,
+                    absl::string_view associated_data,
+                    DoneCallback done) const override {
+    done(aead_->Decrypt(ciphertext, associated_data));
+  }
+
+ private:
+  std::unique_ptr<Aead> aead_;
+};
+
+// Starts an asynchronous operation with 'start' and waits for its result.
+util::StatusOr<std::string> WaitFor(
+    const std::function<void(AsyncAead::DoneCallback)>& start) {
+  absl::Notification done;
+  absl::optional<util::StatusOr<std::string>> result;
+  start([&done, &result](util::StatusOr<std::string> operation_result) {
+    result.emplace(std::move(operation_result));
+    done.Notify();
+  });
+  done.WaitForNotification();
+  return std::move(*result);
+}
+
 }  // namespace
 
 // static
 util::StatusOr<std::unique_ptr<Aead>> KmsEnvelopeAead::New(
     const google::crypto::tink::KeyTemplate& dek_template,
     std::unique_ptr<Aead> remote_aead) {
+  return New(dek_template, std::move(remote_aead), CacheOptions());
+}
+
+// static
+util::StatusOr<std::unique_ptr<Aead>> KmsEnvelopeAead::New(
+    const google::crypto::tink::KeyTemplate& dek_template,
+    std::unique_ptr<Aead> remote_aead, const CacheOptions& options) {
   if (remote_aead == nullptr) {
     return util::Status(util::error::INVALID_ARGUMENT,
                         "remote_aead must be non-null");
   }
+  auto envelope_aead_result = NewKmsEnvelopeAead(
+      dek_template, absl::make_unique<BlockingAsyncAead>(std::move(remote_aead)),
+      options);
+  if (!envelope_aead_result.ok()) return envelope_aead_result.status();
+  std::unique_ptr<Aead> envelope_aead =
+      std::move(envelope_aead_result.ValueOrDie());
+  return std::move(envelope_aead);
+}
+
+// static
+util::StatusOr<std::unique_ptr<AsyncAead>> KmsEnvelopeAead::NewAsync(
+    const google::crypto::tink::KeyTemplate& dek_template,
+    std::unique_ptr<AsyncAead> remote_aead, const CacheOptions& options) {
+  if (remote_aead == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "remote_aead must be non-null");
+  }
+  auto envelope_aead_result =
+      NewKmsEnvelopeAead(dek_template, std::move(remote_aead), options);
+  if (!envelope_aead_result.ok()) return envelope_aead_result.status();
+  std::unique_ptr<AsyncAead> envelope_aead =
+      std::move(envelope_aead_result.ValueOrDie());
+  return std::move(envelope_aead);
+}
+
+// static
+util::StatusOr<std::unique_ptr<KmsEnvelopeAead>>
+KmsEnvelopeAead::NewKmsEnvelopeAead(
+    const google::crypto::tink::KeyTemplate& dek_template,
+    std::unique_ptr<AsyncAead> remote_aead, const CacheOptions& options) {
+  if (options.max_messages_per_dek < 1) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "max_messages_per_dek must be positive");
+  }
+  if (options.max_dek_age < absl::ZeroDuration()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "max_dek_age cannot be negative");
+  }
+  if (options.max_cached_deks < 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "max_cached_deks cannot be negative");
+  }
   auto km_result = Registry::get_key_manager<Aead>(dek_template.type_url());
   if (!km_result.ok()) return km_result.status();
-  std::unique_ptr<Aead> envelope_aead(
-      new KmsEnvelopeAead(dek_template, std::move(remote_aead)));
-  return std::move(envelope_aead);
+  return {absl::WrapUnique(
+      new KmsEnvelopeAead(dek_template, std::move(remote_aead), options))};
 }
 
-util::StatusOr<std::string> KmsEnvelopeAead::Encrypt(
-    absl::string_view plaintext, absl::string_view associated_data) const {
+void KmsEnvelopeAead::NewDek(DekCallback done) const {
   // Generate DEK.
   auto dek_result = Registry::NewKeyData(dek_template_);
-  if (!dek_result.ok()) return dek_result.status();
-  auto dek = std::move(dek_result.ValueOrDie());
+  if (!dek_result.ok()) return done(dek_result.status());
+  auto key_data = std::move(dek_result.ValueOrDie());
+  auto aead_result = Registry::GetPrimitive<Aead>(*key_data);
+  if (!aead_result.ok()) return done(aead_result.status());
+  auto dek = std::make_shared<Dek>();
+  dek->aead = std::move(aead_result.ValueOrDie());
 
   // Wrap DEK key values with remote.
-  auto dek_encrypt_result =
-      remote_aead_->Encrypt(dek->value(), kEmptyAssociatedData);
-  if (!dek_encrypt_result.ok()) return dek_encrypt_result.status();
-
-  // Encrypt plaintext using DEK.
-  auto aead_result = Registry::GetPrimitive<Aead>(*dek);
-  if (!aead_result.ok()) return aead_result.status();
-  auto aead = std::move(aead_result.ValueOrDie());
-  auto encrypt_result = aead->Encrypt(plaintext, associated_data);
-  if (!encrypt_result.ok()) return encrypt_result.status();
+  remote_aead_->EncryptAsync(
+      key_data->value(), kEmptyAssociatedData,
+      [dek, done](util::StatusOr<std::string> dek_encrypt_result) {
+        if (!dek_encrypt_result.ok()) return done(dek_encrypt_result.status());
+        dek->encrypted_dek = std::move(dek_encrypt_result.ValueOrDie());
+        done(std::shared_ptr<const Dek>(dek));
+      });
+}
 
-  // Build and return ciphertext.
-  return GetEnvelopeCiphertext(dek_encrypt_result.ValueOrDie(),
-                               encrypt_result.ValueOrDie());
+void KmsEnvelopeAead::GetEncryptionDek(DekCallback done) const {
+  if (options_.max_messages_per_dek == 1) return NewDek(std::move(done));
+  std::shared_ptr<const Dek> dek;
+  {
+    absl::MutexLock lock(&encryption_mutex_);
+    if (encryption_dek_ != nullptr &&
+        encryption_dek_messages_ < options_.max_messages_per_dek &&
+        (options_.max_dek_age == absl::ZeroDuration() ||
+         absl::Now() - encryption_dek_creation_time_ <
+             options_.max_dek_age)) {
+      encryption_dek_messages_++;
+      dek = encryption_dek_;
+    } else {
+      // Only the first caller to find the DEK used up asks the KMS for a
+      // new one, the others wait for it.
+      encryption_dek_waiters_.push_back(std::move(done));
+      if (encryption_dek_waiters_.size() > 1) return;
+    }
+  }
+  if (dek != nullptr) return done(std::move(dek));
+  NewDek([this](util::StatusOr<std::shared_ptr<const Dek>> dek_result) {
+    OnEncryptionDek(std::move(dek_result));
+  });
 }
 
-util::StatusOr<std::string> KmsEnvelopeAead::Decrypt(
-    absl::string_view ciphertext, absl::string_view associated_data) const {
-  // Parse the ciphertext.
-  if (ciphertext.size() < kEncryptedDekPrefixSize) {
-    return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too short");
+void KmsEnvelopeAead::OnEncryptionDek(
+    util::StatusOr<std::shared_ptr<const Dek>> dek_result) const {
+  std::vector<DekCallback> waiters;
+  {
+    absl::MutexLock lock(&encryption_mutex_);
+    waiters.swap(encryption_dek_waiters_);
+    if (dek_result.ok()) {
+      encryption_dek_ = dek_result.ValueOrDie();
+      encryption_dek_messages_ = std::min(
+          static_cast<int>(waiters.size()), options_.max_messages_per_dek);
+      encryption_dek_creation_time_ = absl::Now();
+    }
   }
-  auto enc_dek_size = absl::big_endian::Load32(
-      reinterpret_cast<const uint8_t*>(ciphertext.data()));
-  if (enc_dek_size > ciphertext.size() - kEncryptedDekPrefixSize ||
-      enc_dek_size < 0) {
-    return util::Status(util::error::INVALID_ARGUMENT, "invalid ciphertext");
+  if (!dek_result.ok()) {
+    for (auto& waiter : waiters) waiter(dek_result.status());
+    return;
   }
+  if (options_.max_cached_deks > 0) {
+    // Our own ciphertexts can then be decrypted without contacting the KMS.
+    absl::MutexLock lock(&decryption_mutex_);
+    CacheDecryptionDek(dek_result.ValueOrDie());
+  }
+  for (int i = 0; i < static_cast<int>(waiters.size()); i++) {
+    if (i < options_.max_messages_per_dek) {
+      waiters[i](dek_result);
+    } else {
+      // More waiters than messages allowed per DEK: the remaining ones
+      // need the next DEK.
+      GetEncryptionDek(std::move(waiters[i]));
+    }
+  }
+}
+
+void KmsEnvelopeAead::GetDecryptionDek(absl::string_view encrypted_dek,
+                                       DekCallback done) const {
+  std::shared_ptr<const Dek> cached_dek;
+  {
+    absl::MutexLock lock(&decryption_mutex_);
+    auto it = decryption_deks_.find(encrypted_dek);
+    if (it != decryption_deks_.end()) {
+      decryption_lru_.splice(decryption_lru_.begin(), decryption_lru_,
+                             it->second.lru_position);
+      cached_dek = it->second.dek;
+    } else {
+      // Concurrent decryptions of the same DEK share one request to the KMS.
+      auto& waiters = decryption_dek_waiters_[encrypted_dek];
+      waiters.push_back(std::move(done));
+      if (waiters.size() > 1) return;
+    }
+  }
+  if (cached_dek != nullptr) return done(std::move(cached_dek));
+
   // Decrypt the DEK with remote.
-  auto dek_decrypt_result = remote_aead_->Decrypt(
-      ciphertext.substr(kEncryptedDekPrefixSize, enc_dek_size),
-      kEmptyAssociatedData);
+  remote_aead_->DecryptAsync(
+      encrypted_dek, kEmptyAssociatedData,
+      [this, encrypted_dek = std::string(encrypted_dek)](
+          util::StatusOr<std::string> dek_decrypt_result) {
+        OnDecryptionDek(encrypted_dek, std::move(dek_decrypt_result));
+      });
+}
+
+void KmsEnvelopeAead::OnDecryptionDek(
+    const std::string& encrypted_dek,
+    util::StatusOr<std::string> dek_decrypt_result) const {
+  util::StatusOr<std::shared_ptr<const Dek>> dek_result =
+      util::Status(util::error::UNKNOWN, "");
   if (!dek_decrypt_result.ok()) {
-    return util::Status(
+    dek_result = util::Status(
         util::error::INVALID_ARGUMENT,
         absl::StrCat("invalid ciphertext: ",
                      dek_decrypt_result.status().error_message()));
+  } else {
+    // Create AEAD from DEK.
+    google::crypto::tink::KeyData key_data;
+    key_data.set_type_url(dek_template_.type_url());
+    key_data.set_value(dek_decrypt_result.ValueOrDie());
+    key_data.set_key_material_type(google::crypto::tink::KeyData::SYMMETRIC);
+    auto aead_result = Registry::GetPrimitive<Aead>(key_data);
+    if (!aead_result.ok()) {
+      dek_result = aead_result.status();
+    } else {
+      auto dek = std::make_shared<Dek>();
+      dek->encrypted_dek = encrypted_dek;
+      dek->aead = std::move(aead_result.ValueOrDie());
+      dek_result = std::shared_ptr<const Dek>(std::move(dek));
+    }
   }
 
-  // Create AEAD from DEK.
-  google::crypto::tink::KeyData dek;
-  dek.set_type_url(dek_template_.type_url());
-  dek.set_value(dek_decrypt_result.ValueOrDie());
-  dek.set_key_material_type(google::crypto::tink::KeyData::SYMMETRIC);
+  std::vector<DekCallback> waiters;
+  {
+    absl::MutexLock lock(&decryption_mutex_);
+    auto it = decryption_dek_waiters_.find(encrypted_dek);
+    waiters.swap(it->second);
+    decryption_dek_waiters_.erase(it);
+    if (dek_result.ok()) CacheDecryptionDek(dek_result.ValueOrDie());
+  }
+  for (auto& waiter : waiters) waiter(dek_result);
+}
 
-  // Encrypt plaintext using DEK.
-  auto aead_result = Registry::GetPrimitive<Aead>(dek);
+void KmsEnvelopeAead::CacheDecryptionDek(std::shared_ptr<const Dek> dek) const {
+  if (options_.max_cached_deks == 0) return;
+  if (decryption_deks_.contains(dek->encrypted_dek)) return;
+  decryption_lru_.push_front(dek->encrypted_dek);
+  CacheEntry& entry = decryption_deks_[decryption_lru_.front()];
+  entry.dek = std::move(dek);
+  entry.lru_position = decryption_lru_.begin();
+  if (decryption_lru_.size() >
+      static_cast<size_t>(options_.max_cached_deks)) {
+    decryption_deks_.erase(decryption_lru_.back());
+    decryption_lru_.pop_back();
+  }
+}
+
+util::StatusOr<std::string> KmsEnvelopeAead::Encrypt(
+    absl::string_view plaintext, absl::string_view associated_data) const {
+  return WaitFor([this, plaintext, associated_data](DoneCallback done) {
+    EncryptAsync(plaintext, associated_data, std::move(done));
+  });
+}
+
+util::StatusOr<std::string> KmsEnvelopeAead::Decrypt(
+    absl::string_view ciphertext, absl::string_view associated_data) const {
+  return WaitFor([this, ciphertext, associated_data](DoneCallback done) {
+    DecryptAsync(ciphertext, associated_data, std::move(done));
+  });
+}
+
+util::StatusOr<std::string> KmsEnvelopeAead::EncryptWithDek(
+    const Dek& dek, absl::string_view plaintext,
+    absl::string_view associated_data) const {
+  if (!options_.use_local_kek) {
+    // Encrypt plaintext using DEK.
+    auto encrypt_result = dek.aead->Encrypt(plaintext, associated_data);
+    if (!encrypt_result.ok()) return encrypt_result.status();
+    return GetEnvelopeCiphertext(dek.encrypted_dek,
+                                 encrypt_result.ValueOrDie());
+  }
+  // 'dek' is the KEK: generate a DEK for this message, and wrap it locally.
+  // The DEK only lives for this call, so the primitive is made directly from
+  // the key proto, without a KeyData around it, and the serialized key is
+  // wiped afterwards.
+  auto km_result = Registry::get_key_manager<Aead>(dek_template_.type_url());
+  if (!km_result.ok()) return km_result.status();
+  const KeyManager<Aead>* key_manager = km_result.ValueOrDie();
+  auto key_result =
+      key_manager->get_key_factory().NewKey(dek_template_.value());
+  if (!key_result.ok()) return key_result.status();
+  const portable_proto::MessageLite& key = *key_result.ValueOrDie();
+  auto aead_result = key_manager->GetPrimitive(key);
+  if (!aead_result.ok()) return aead_result.status();
+  util::SecretData key_value(key.ByteSizeLong());
+  if (!key.SerializeToArray(key_value.data(), key_value.size())) {
+    return util::Status(util::error::INTERNAL, "failed to serialize the DEK");
+  }
+  auto wrap_result = dek.aead->Encrypt(util::SecretDataAsStringView(key_value),
+                                       kEmptyAssociatedData);
+  if (!wrap_result.ok()) return wrap_result.status();
+  auto encrypt_result =
+      aead_result.ValueOrDie()->Encrypt(plaintext, associated_data);
+  if (!encrypt_result.ok()) return encrypt_result.status();
+  return GetEnvelopeCiphertext(
+      dek.encrypted_dek, GetEnvelopeCiphertext(wrap_result.ValueOrDie(),
+                                               encrypt_result.ValueOrDie()));
+}
+
+util::StatusOr<std::string> KmsEnvelopeAead::DecryptWithDek(
+    const Dek& dek, absl::string_view payload,
+    absl::string_view associated_data) const {
+  if (!options_.use_local_kek) {
+    // Decrypt ciphertext using DEK.
+    return dek.aead->Decrypt(payload, associated_data);
+  }
+  absl::string_view wrapped_dek;
+  absl::string_view dek_payload;
+  auto status = ParseEnvelopeCiphertext(payload, &wrapped_dek, &dek_payload);
+  if (!status.ok()) return status;
+  auto unwrap_result = dek.aead->Decrypt(wrapped_dek, kEmptyAssociatedData);
+  if (!unwrap_result.ok()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        absl::StrCat("invalid ciphertext: ",
+                                     unwrap_result.status().error_message()));
+  }
+  // The KeyData of the DEK of this message lives on the stack, and is wiped
+  // on return.
+  util::ScopedSecretArena arena;
+  auto* key_data = arena.Create<google::crypto::tink::KeyData>();
+  key_data->set_type_url(dek_template_.type_url());
+  key_data->set_value(unwrap_result.ValueOrDie());
+  key_data->set_key_material_type(google::crypto::tink::KeyData::SYMMETRIC);
+  auto aead_result = Registry::GetPrimitive<Aead>(*key_data);
   if (!aead_result.ok()) return aead_result.status();
-  auto aead = std::move(aead_result.ValueOrDie());
-  return aead->Decrypt(
-      ciphertext.substr(kEncryptedDekPrefixSize + enc_dek_size),
-      associated_data);
+  return aead_result.ValueOrDie()->Decrypt(dek_payload, associated_data);
+}
+
+void KmsEnvelopeAead::EncryptAsync(absl::string_view plaintext,
+                                   absl::string_view associated_data,
+                                   DoneCallback done) const {
+  internal::TracedOperation operation("tink.kms_envelope_aead.encrypt");
+  operation.SetAttribute("tink.type_url", dek_template_.type_url());
+  operation.SetAttribute("tink.bytes", plaintext.size());
+  done = operation.EndWhenDone(std::move(done));
+  // The inputs are copied, as the DEK might be available only after this
+  // method returns.
+  GetEncryptionDek(
+      [this, plaintext = std::string(plaintext),
+       associated_data = std::string(associated_data),
+       done](util::StatusOr<std::shared_ptr<const Dek>> dek_result) {
+        if (!dek_result.ok()) return done(dek_result.status());
+        done(EncryptWithDek(*dek_result.ValueOrDie(), plaintext,
+                            associated_data));
+      });
+}
+
+void KmsEnvelopeAead::DecryptAsync(absl::string_view ciphertext,
+                                   absl::string_view associated_data,
+                                   DoneCallback done) const {
+  internal::TracedOperation operation("tink.kms_envelope_aead.decrypt");
+  operation.SetAttribute("tink.type_url", dek_template_.type_url());
+  operation.SetAttribute("tink.bytes", ciphertext.size());
+  done = operation.EndWhenDone(std::move(done));
+  // Parse the ciphertext.
+  absl::string_view encrypted_dek;
+  absl::string_view payload;
+  auto status = ParseEnvelopeCiphertext(ciphertext, &encrypted_dek, &payload);
+  if (!status.ok()) return done(status);
+  GetDecryptionDek(
+      encrypted_dek,
+      [this, payload = std::string(payload),
+       associated_data = std::string(associated_data),
+       done](util::StatusOr<std::shared_ptr<const Dek>> dek_result) {
+        if (!dek_result.ok()) return done(dek_result.status());
+        done(DecryptWithDek(*dek_result.ValueOrDie(), payload,
+                            associated_data));
+      });
 }
 
 }  // namespace tink
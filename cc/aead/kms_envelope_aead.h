@@ -15,10 +15,19 @@
 #ifndef TINK_AEAD_KMS_ENVELOPE_AEAD_H_
 #define TINK_AEAD_KMS_ENVELOPE_AEAD_H_
 
+#include <functional>
+#include <list>
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "tink/aead.h"
+#include "tink/async_aead.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
@@ -40,12 +49,65 @@ namespace tink {
 //  - Encrypted DEK: variable length that is equal to the value
 //    specified in the last 4 bytes.
 //  - AEAD payload: variable length.
-class KmsEnvelopeAead : public Aead {
+// With CacheOptions::use_local_kek the encrypted DEK above is the encrypted
+// KEK instead, and the AEAD payload has the same structure once more:
+//  - Length of the DEK encrypted with the KEK: 4 bytes (big endian)
+//  - DEK encrypted with the KEK, with empty associated data.
+//  - AEAD payload: variable length.
+//
+// By default every Encrypt() generates a fresh DEK and every call to
+// Encrypt() or Decrypt() makes one request to the KMS. CacheOptions allow
+// trading this for fewer KMS requests.
+//
+// KmsEnvelopeAead also implements AsyncAead, so that many messages can be
+// encrypted and decrypted while requests to the KMS are in flight.
+// Concurrent operations that need the same DEK share a single KMS request.
+class KmsEnvelopeAead : public Aead, public AsyncAead {
  public:
+  struct CacheOptions {
+    // The maximal number of messages encrypted with the same DEK. Values
+    // larger than 1 let Encrypt() reuse the DEK (and its encryption by
+    // the KMS) of the previous messages.
+    int max_messages_per_dek = 1;
+    // If positive, a DEK is not used for encryption for longer than this
+    // after it has been generated.
+    absl::Duration max_dek_age = absl::ZeroDuration();
+    // The maximal number of decrypted DEKs kept by Decrypt(), indexed by
+    // their encryption by the KMS. With 0 nothing is cached.
+    int max_cached_deks = 0;
+    // If true, the key encrypted by the KMS is not used to encrypt messages
+    // but only as a local key-encryption key (KEK): every message is
+    // encrypted with a fresh DEK, which is encrypted with the KEK, and the
+    // encrypted DEK is stored in the AEAD payload (see above). The options
+    // above then apply to the KEK, so that with them there is one request
+    // to the KMS per KEK while no DEK encrypts more than one message.
+    // Both the KEK and the DEKs are generated from the DEK template.
+    // Ciphertexts with a local KEK can only be decrypted with a local KEK
+    // and vice versa.
+    bool use_local_kek = false;
+  };
+
   static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
       const google::crypto::tink::KeyTemplate& dek_template,
       std::unique_ptr<Aead> remote_aead);
 
+  // Like New() above, but with the given caching 'options'.
+  // Note that reusing a DEK for many messages lowers the number of those
+  // that can be safely encrypted under a single DEK template, e.g. for
+  // AES-GCM with random nonces the number of messages per DEK should
+  // stay well below 2^32.
+  static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
+      const google::crypto::tink::KeyTemplate& dek_template,
+      std::unique_ptr<Aead> remote_aead, const CacheOptions& options);
+
+  // Like New(), but the KMS is accessed through 'remote_aead' without
+  // blocking, so requests to the KMS by EncryptAsync() and DecryptAsync()
+  // can be pipelined.  The returned object must not be destroyed while
+  // operations are pending.
+  static crypto::tink::util::StatusOr<std::unique_ptr<AsyncAead>> NewAsync(
+      const google::crypto::tink::KeyTemplate& dek_template,
+      std::unique_ptr<AsyncAead> remote_aead, const CacheOptions& options);
+
   crypto::tink::util::StatusOr<std::string> Encrypt(
       absl::string_view plaintext,
       absl::string_view associated_data) const override;
@@ -54,15 +116,97 @@ class KmsEnvelopeAead : public Aead {
       absl::string_view ciphertext,
       absl::string_view associated_data) const override;
 
+  void EncryptAsync(absl::string_view plaintext,
+                    absl::string_view associated_data,
+                    DoneCallback done) const override;
+
+  void DecryptAsync(absl::string_view ciphertext,
+                    absl::string_view associated_data,
+                    DoneCallback done) const override;
+
   ~KmsEnvelopeAead() override {}
 
  private:
+  // A DEK as primitive, together with its encryption by the KMS.
+  struct Dek {
+    std::string encrypted_dek;
+    std::unique_ptr<Aead> aead;
+  };
+  using DekCallback = std::function<void(
+      crypto::tink::util::StatusOr<std::shared_ptr<const Dek>>)>;
+
   KmsEnvelopeAead(const google::crypto::tink::KeyTemplate& dek_template,
-                  std::unique_ptr<Aead> remote_aead) :
-      dek_template_(dek_template), remote_aead_(std::move(remote_aead)) {}
+                  std::unique_ptr<AsyncAead> remote_aead,
+                  const CacheOptions& options) :
+      dek_template_(dek_template), options_(options),
+      remote_aead_(std::move(remote_aead)) {}
+
+  static crypto::tink::util::StatusOr<std::unique_ptr<KmsEnvelopeAead>>
+  NewKmsEnvelopeAead(const google::crypto::tink::KeyTemplate& dek_template,
+                     std::unique_ptr<AsyncAead> remote_aead,
+                     const CacheOptions& options);
+
+  // Encrypts a message with 'dek', or with a fresh DEK encrypted with 'dek'
+  // as KEK, and returns the ciphertext.
+  crypto::tink::util::StatusOr<std::string> EncryptWithDek(
+      const Dek& dek, absl::string_view plaintext,
+      absl::string_view associated_data) const;
+  // Decrypts the AEAD payload of a ciphertext made by EncryptWithDek().
+  crypto::tink::util::StatusOr<std::string> DecryptWithDek(
+      const Dek& dek, absl::string_view payload,
+      absl::string_view associated_data) const;
+  // Calls 'done' with the DEK to encrypt the next message with, generating
+  // a new one if the current one is used up.
+  void GetEncryptionDek(DekCallback done) const;
+  // Generates a new DEK and encrypts it with the KMS.
+  void NewDek(DekCallback done) const;
+  // Called when the generation of a new DEK for encryption has finished.
+  void OnEncryptionDek(
+      crypto::tink::util::StatusOr<std::shared_ptr<const Dek>> dek_result)
+      const;
+  // Calls 'done' with the DEK encrypted as 'encrypted_dek', using the KMS
+  // only if it is not cached.
+  void GetDecryptionDek(absl::string_view encrypted_dek,
+                        DekCallback done) const;
+  // Called when the KMS has decrypted 'encrypted_dek'.
+  void OnDecryptionDek(
+      const std::string& encrypted_dek,
+      crypto::tink::util::StatusOr<std::string> dek_decrypt_result) const;
+  void CacheDecryptionDek(std::shared_ptr<const Dek> dek) const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(decryption_mutex_);
 
   google::crypto::tink::KeyTemplate dek_template_;
-  std::unique_ptr<Aead> remote_aead_;
+  const CacheOptions options_;
+
+  // The DEK used by Encrypt(), the number of messages encrypted with it and
+  // the time it was generated, and the callers waiting for a new DEK.
+  mutable absl::Mutex encryption_mutex_;
+  mutable std::shared_ptr<const Dek> encryption_dek_
+      ABSL_GUARDED_BY(encryption_mutex_);
+  mutable int encryption_dek_messages_ ABSL_GUARDED_BY(encryption_mutex_) = 0;
+  mutable absl::Time encryption_dek_creation_time_
+      ABSL_GUARDED_BY(encryption_mutex_);
+  mutable std::vector<DekCallback> encryption_dek_waiters_
+      ABSL_GUARDED_BY(encryption_mutex_);
+
+  // DEKs used by Decrypt(), indexed by their encryption, with the least
+  // recently used one at the back of 'decryption_lru_', and the callers
+  // waiting for the KMS to decrypt a DEK.
+  struct CacheEntry {
+    std::shared_ptr<const Dek> dek;
+    std::list<std::string>::iterator lru_position;
+  };
+  mutable absl::Mutex decryption_mutex_;
+  mutable absl::flat_hash_map<std::string, CacheEntry> decryption_deks_
+      ABSL_GUARDED_BY(decryption_mutex_);
+  mutable std::list<std::string> decryption_lru_
+      ABSL_GUARDED_BY(decryption_mutex_);
+  mutable absl::flat_hash_map<std::string, std::vector<DekCallback>>
+      decryption_dek_waiters_ ABSL_GUARDED_BY(decryption_mutex_);
+
+  // Declared last, so that its pending operations complete before the
+  // members above are destroyed.
+  std::unique_ptr<AsyncAead> remote_aead_;
 };
 
 }  // namespace tink
@@ -14,6 +14,7 @@
 
 #include "tink/aead/kms_envelope_aead.h"
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -21,8 +22,11 @@
 #include "absl/base/internal/endian.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "tink/aead/aead_config.h"
 #include "tink/aead/aead_key_templates.h"
+#include "tink/async_aead.h"
 #include "tink/mac/mac_key_templates.h"
 #include "tink/registry.h"
 #include "tink/util/status.h"
@@ -39,6 +43,74 @@ using crypto::tink::test::DummyAead;
 using crypto::tink::test::IsOk;
 using crypto::tink::test::StatusIs;
 using testing::HasSubstr;
+using testing::Not;
+
+// A remote AEAD that counts how often it is called.
+class CountingAead : public Aead {
+ public:
+  CountingAead(absl::string_view name, int* encrypt_count, int* decrypt_count)
+      : aead_(name),
+        encrypt_count_(encrypt_count),
+        decrypt_count_(decrypt_count) {}
+
+  util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override {
+    (*encrypt_count_)++;
+    return aead_.Encrypt(plaintext, associated_data);
+  }
+
+  util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override {
+    (*decrypt_count_)++;
+    return aead_.Decrypt(ciphertext, associated_data);
+  }
+
+ private:
+  DummyAead aead_;
+  int* encrypt_count_;
+  int* decrypt_count_;
+};
+
+// A remote AsyncAead whose operations are queued in 'pending', and complete
+// only when the test runs them.
+class QueuedAsyncAead : public AsyncAead {
+ public:
+  QueuedAsyncAead(absl::string_view name,
+                  std::vector<std::function<void()>>* pending)
+      : aead_(name), pending_(pending) {}
+
+  void EncryptAsync(absl::string_view plaintext,
+                    absl::string_view associated_data,
+                    DoneCallback done) const override {
+    pending_->push_back([this, plaintext = std::string(plaintext),
+                         associated_data = std::string(associated_data),
+                         done]() {
+      done(aead_.Encrypt(plaintext, associated_data));
+    });
+  }
+
+  void DecryptAsync(absl::string_view ciphertext,
+                    absl::string_view associated_data,
+                    DoneCallback done) const override {
+    pending_->push_back([this, ciphertext = std::string(ciphertext),
+                         associated_data = std::string(associated_data),
+                         done]() {
+      done(aead_.Decrypt(ciphertext, associated_data));
+    });
+  }
+
+ private:
+  DummyAead aead_;
+  std::vector<std::function<void()>>* pending_;
+};
+
+void RunPending(std::vector<std::function<void()>>* pending) {
+  std::vector<std::function<void()>> operations;
+  operations.swap(*pending);
+  for (auto& operation : operations) operation();
+}
 
 
 TEST(KmsEnvelopeAeadTest, BasicEncryptDecrypt) {
@@ -167,6 +239,367 @@ TEST(KmsEnvelopeAeadTest, KeyFormat) {
   EXPECT_THAT(key.key_value().size(), testing::Eq(16));
 }
 
+TEST(KmsEnvelopeAeadTest, InvalidCacheOptions) {
+  EXPECT_THAT(AeadConfig::Register(), IsOk());
+  auto dek_template = AeadKeyTemplates::Aes128Gcm();
+  std::vector<KmsEnvelopeAead::CacheOptions> all_options(3);
+  all_options[0].max_messages_per_dek = 0;
+  all_options[1].max_dek_age = -absl::Seconds(1);
+  all_options[2].max_cached_deks = -1;
+  for (const auto& options : all_options) {
+    auto aead_result = KmsEnvelopeAead::New(
+        dek_template, absl::make_unique<DummyAead>("kms-backed-aead"),
+        options);
+    EXPECT_THAT(aead_result.status(), StatusIs(util::error::INVALID_ARGUMENT));
+  }
+}
+
+TEST(KmsEnvelopeAeadTest, NoCaching) {
+  EXPECT_THAT(AeadConfig::Register(), IsOk());
+  int encrypt_count = 0;
+  int decrypt_count = 0;
+  auto aead_result = KmsEnvelopeAead::New(
+      AeadKeyTemplates::Aes128Gcm(),
+      absl::make_unique<CountingAead>("kms-backed-aead", &encrypt_count,
+                                      &decrypt_count));
+  ASSERT_THAT(aead_result.status(), IsOk());
+  auto aead = std::move(aead_result.ValueOrDie());
+  std::string aad = "Some data to authenticate.";
+  for (int i = 0; i < 3; i++) {
+    std::string message = absl::StrCat("message ", i);
+    auto encrypt_result = aead->Encrypt(message, aad);
+    ASSERT_THAT(encrypt_result.status(), IsOk());
+    auto decrypt_result = aead->Decrypt(encrypt_result.ValueOrDie(), aad);
+    ASSERT_THAT(decrypt_result.status(), IsOk());
+    EXPECT_EQ(message, decrypt_result.ValueOrDie());
+  }
+  EXPECT_EQ(3, encrypt_count);
+  EXPECT_EQ(3, decrypt_count);
+}
+
+TEST(KmsEnvelopeAeadTest, DekReuse) {
+  EXPECT_THAT(AeadConfig::Register(), IsOk());
+  int encrypt_count = 0;
+  int decrypt_count = 0;
+  KmsEnvelopeAead::CacheOptions options;
+  options.max_messages_per_dek = 3;
+  auto aead_result = KmsEnvelopeAead::New(
+      AeadKeyTemplates::Aes128Gcm(),
+      absl::make_unique<CountingAead>("kms-backed-aead", &encrypt_count,
+                                      &decrypt_count),
+      options);
+  ASSERT_THAT(aead_result.status(), IsOk());
+  auto aead = std::move(aead_result.ValueOrDie());
+  std::string aad = "Some data to authenticate.";
+  std::vector<std::string> ciphertexts;
+  for (int i = 0; i < 7; i++) {
+    auto encrypt_result = aead->Encrypt(absl::StrCat("message ", i), aad);
+    ASSERT_THAT(encrypt_result.status(), IsOk());
+    ciphertexts.push_back(encrypt_result.ValueOrDie());
+  }
+  EXPECT_EQ(3, encrypt_count);
+  // Messages encrypted with the same DEK share the encrypted DEK, but are
+  // still different ciphertexts.
+  auto enc_dek_size = absl::big_endian::Load32(
+      reinterpret_cast<const uint8_t*>(ciphertexts[0].data()));
+  EXPECT_EQ(ciphertexts[0].substr(0, 4 + enc_dek_size),
+            ciphertexts[2].substr(0, 4 + enc_dek_size));
+  EXPECT_NE(ciphertexts[0].substr(0, 4 + enc_dek_size),
+            ciphertexts[3].substr(0, 4 + enc_dek_size));
+  EXPECT_NE(ciphertexts[0], ciphertexts[1]);
+  for (int i = 0; i < 7; i++) {
+    auto decrypt_result = aead->Decrypt(ciphertexts[i], aad);
+    ASSERT_THAT(decrypt_result.status(), IsOk());
+    EXPECT_EQ(absl::StrCat("message ", i), decrypt_result.ValueOrDie());
+  }
+  EXPECT_EQ(7, decrypt_count);
+}
+
+TEST(KmsEnvelopeAeadTest, DekExpiry) {
+  EXPECT_THAT(AeadConfig::Register(), IsOk());
+  int encrypt_count = 0;
+  int decrypt_count = 0;
+  KmsEnvelopeAead::CacheOptions options;
+  options.max_messages_per_dek = 1000;
+  options.max_dek_age = absl::Milliseconds(1);
+  auto aead_result = KmsEnvelopeAead::New(
+      AeadKeyTemplates::Aes128Gcm(),
+      absl::make_unique<CountingAead>("kms-backed-aead", &encrypt_count,
+                                      &decrypt_count),
+      options);
+  ASSERT_THAT(aead_result.status(), IsOk());
+  auto aead = std::move(aead_result.ValueOrDie());
+  for (int i = 0; i < 3; i++) {
+    EXPECT_THAT(aead->Encrypt("message", "aad").status(), IsOk());
+    absl::SleepFor(absl::Milliseconds(5));
+  }
+  EXPECT_EQ(3, encrypt_count);
+}
+
+TEST(KmsEnvelopeAeadTest, DecryptionCache) {
+  EXPECT_THAT(AeadConfig::Register(), IsOk());
+  std::string remote_aead_name = "kms-backed-aead";
+  std::string aad = "Some data to authenticate.";
+  // Ciphertexts with 4 different DEKs.
+  std::vector<std::string> ciphertexts;
+  auto encrypting_aead =
+      std::move(KmsEnvelopeAead::New(AeadKeyTemplates::Aes128Gcm(),
+                                     absl::make_unique<DummyAead>(
+                                         remote_aead_name)).ValueOrDie());
+  for (int i = 0; i < 4; i++) {
+    ciphertexts.push_back(
+        encrypting_aead->Encrypt(absl::StrCat("message ", i), aad)
+            .ValueOrDie());
+  }
+
+  int encrypt_count = 0;
+  int decrypt_count = 0;
+  KmsEnvelopeAead::CacheOptions options;
+  options.max_cached_deks = 2;
+  auto aead_result = KmsEnvelopeAead::New(
+      AeadKeyTemplates::Aes128Gcm(),
+      absl::make_unique<CountingAead>(remote_aead_name, &encrypt_count,
+                                      &decrypt_count),
+      options);
+  ASSERT_THAT(aead_result.status(), IsOk());
+  auto aead = std::move(aead_result.ValueOrDie());
+  auto decrypt = [&](int i) {
+    auto decrypt_result = aead->Decrypt(ciphertexts[i], aad);
+    ASSERT_THAT(decrypt_result.status(), IsOk());
+    EXPECT_EQ(absl::StrCat("message ", i), decrypt_result.ValueOrDie());
+  };
+  decrypt(0);
+  decrypt(1);
+  decrypt(1);
+  decrypt(0);
+  EXPECT_EQ(2, decrypt_count);
+  decrypt(2);  // Evicts the DEK of ciphertexts[1].
+  EXPECT_EQ(3, decrypt_count);
+  decrypt(0);
+  EXPECT_EQ(3, decrypt_count);
+  decrypt(1);
+  EXPECT_EQ(4, decrypt_count);
+
+  // A cached DEK does not make a modified ciphertext decrypt.
+  std::string corrupted = ciphertexts[0];
+  corrupted.back() ^= 1;
+  EXPECT_THAT(aead->Decrypt(corrupted, aad).status(), Not(IsOk()));
+  EXPECT_THAT(aead->Decrypt(ciphertexts[0], "wrong aad").status(),
+              Not(IsOk()));
+
+  // Own ciphertexts are decrypted without contacting the KMS.
+  options.max_messages_per_dek = 10;
+  auto reusing_aead_result = KmsEnvelopeAead::New(
+      AeadKeyTemplates::Aes128Gcm(),
+      absl::make_unique<CountingAead>(remote_aead_name, &encrypt_count,
+                                      &decrypt_count),
+      options);
+  ASSERT_THAT(reusing_aead_result.status(), IsOk());
+  aead = std::move(reusing_aead_result.ValueOrDie());
+  decrypt_count = 0;
+  auto encrypt_result = aead->Encrypt("message", aad);
+  ASSERT_THAT(encrypt_result.status(), IsOk());
+  auto decrypt_result = aead->Decrypt(encrypt_result.ValueOrDie(), aad);
+  ASSERT_THAT(decrypt_result.status(), IsOk());
+  EXPECT_EQ("message", decrypt_result.ValueOrDie());
+  EXPECT_EQ(0, decrypt_count);
+}
+
+TEST(KmsEnvelopeAeadTest, LocalKek) {
+  EXPECT_THAT(AeadConfig::Register(), IsOk());
+  std::string remote_aead_name = "kms-backed-aead";
+  int encrypt_count = 0;
+  int decrypt_count = 0;
+  KmsEnvelopeAead::CacheOptions options;
+  options.use_local_kek = true;
+  options.max_messages_per_dek = 5;
+  options.max_cached_deks = 2;
+  auto aead_result = KmsEnvelopeAead::New(
+      AeadKeyTemplates::Aes128Gcm(),
+      absl::make_unique<CountingAead>(remote_aead_name, &encrypt_count,
+                                      &decrypt_count),
+      options);
+  ASSERT_THAT(aead_result.status(), IsOk());
+  auto aead = std::move(aead_result.ValueOrDie());
+  std::string aad = "Some data to authenticate.";
+  std::vector<std::string> ciphertexts;
+  for (int i = 0; i < 7; i++) {
+    auto encrypt_result = aead->Encrypt(absl::StrCat("message ", i), aad);
+    ASSERT_THAT(encrypt_result.status(), IsOk());
+    ciphertexts.push_back(encrypt_result.ValueOrDie());
+  }
+  EXPECT_EQ(2, encrypt_count);
+  // Messages encrypted under the same KEK share the encrypted KEK, but each
+  // has its own DEK.
+  auto enc_kek_size = absl::big_endian::Load32(
+      reinterpret_cast<const uint8_t*>(ciphertexts[0].data()));
+  auto enc_dek_size = absl::big_endian::Load32(
+      reinterpret_cast<const uint8_t*>(ciphertexts[0].data()) + 4 +
+      enc_kek_size);
+  EXPECT_EQ(ciphertexts[0].substr(0, 4 + enc_kek_size),
+            ciphertexts[4].substr(0, 4 + enc_kek_size));
+  EXPECT_NE(ciphertexts[0].substr(0, 4 + enc_kek_size),
+            ciphertexts[5].substr(0, 4 + enc_kek_size));
+  EXPECT_NE(ciphertexts[0].substr(4 + enc_kek_size, 4 + enc_dek_size),
+            ciphertexts[1].substr(4 + enc_kek_size, 4 + enc_dek_size));
+
+  // A new instance asks the KMS once per KEK.
+  aead_result = KmsEnvelopeAead::New(
+      AeadKeyTemplates::Aes128Gcm(),
+      absl::make_unique<CountingAead>(remote_aead_name, &encrypt_count,
+                                      &decrypt_count),
+      options);
+  ASSERT_THAT(aead_result.status(), IsOk());
+  aead = std::move(aead_result.ValueOrDie());
+  for (int i = 0; i < 7; i++) {
+    auto decrypt_result = aead->Decrypt(ciphertexts[i], aad);
+    ASSERT_THAT(decrypt_result.status(), IsOk());
+    EXPECT_EQ(absl::StrCat("message ", i), decrypt_result.ValueOrDie());
+  }
+  EXPECT_EQ(2, decrypt_count);
+
+  // A modified encrypted DEK, payload or associated data does not decrypt.
+  std::string corrupted = ciphertexts[0];
+  corrupted[4 + enc_kek_size + 4] ^= 1;
+  EXPECT_THAT(aead->Decrypt(corrupted, aad).status(), Not(IsOk()));
+  corrupted = ciphertexts[0];
+  corrupted.back() ^= 1;
+  EXPECT_THAT(aead->Decrypt(corrupted, aad).status(), Not(IsOk()));
+  EXPECT_THAT(aead->Decrypt(ciphertexts[0], "wrong aad").status(),
+              Not(IsOk()));
+  EXPECT_THAT(aead->Decrypt(ciphertexts[0].substr(0, 4 + enc_kek_size + 2),
+                            aad).status(),
+              Not(IsOk()));
+
+  // Without a local KEK the ciphertexts do not decrypt.
+  auto direct_aead = std::move(
+      KmsEnvelopeAead::New(AeadKeyTemplates::Aes128Gcm(),
+                           absl::make_unique<DummyAead>(remote_aead_name))
+          .ValueOrDie());
+  EXPECT_THAT(direct_aead->Decrypt(ciphertexts[0], aad).status(),
+              Not(IsOk()));
+}
+
+TEST(KmsEnvelopeAeadTest, AsyncRemoteAead) {
+  EXPECT_THAT(AeadConfig::Register(), IsOk());
+  std::string remote_aead_name = "kms-backed-aead";
+  std::string aad = "Some data to authenticate.";
+  std::vector<std::function<void()>> pending;
+  KmsEnvelopeAead::CacheOptions options;
+  options.max_messages_per_dek = 2;
+  auto aead_result = KmsEnvelopeAead::NewAsync(
+      AeadKeyTemplates::Aes128Gcm(),
+      absl::make_unique<QueuedAsyncAead>(remote_aead_name, &pending), options);
+  ASSERT_THAT(aead_result.status(), IsOk());
+  auto aead = std::move(aead_result.ValueOrDie());
+
+  // Concurrent encryptions wait for the same DEK.
+  std::vector<std::string> ciphertexts(3);
+  for (int i = 0; i < 3; i++) {
+    aead->EncryptAsync(absl::StrCat("message ", i), aad,
+                       [&ciphertexts, i](util::StatusOr<std::string> result) {
+                         ASSERT_THAT(result.status(), IsOk());
+                         ciphertexts[i] = result.ValueOrDie();
+                       });
+  }
+  EXPECT_EQ(1, pending.size());
+  RunPending(&pending);
+  // The first two messages are encrypted, the third one needs a new DEK.
+  EXPECT_FALSE(ciphertexts[0].empty());
+  EXPECT_FALSE(ciphertexts[1].empty());
+  EXPECT_TRUE(ciphertexts[2].empty());
+  EXPECT_EQ(1, pending.size());
+  RunPending(&pending);
+  EXPECT_FALSE(ciphertexts[2].empty());
+
+  // Concurrent decryptions with the same DEK share one KMS request.
+  std::vector<std::string> plaintexts(3);
+  for (int i = 0; i < 3; i++) {
+    aead->DecryptAsync(ciphertexts[i], aad,
+                       [&plaintexts, i](util::StatusOr<std::string> result) {
+                         ASSERT_THAT(result.status(), IsOk());
+                         plaintexts[i] = result.ValueOrDie();
+                       });
+  }
+  EXPECT_EQ(2, pending.size());
+  RunPending(&pending);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(absl::StrCat("message ", i), plaintexts[i]);
+  }
+
+  // A blocking envelope AEAD decrypts the ciphertexts too.
+  auto blocking_aead_result = KmsEnvelopeAead::New(
+      AeadKeyTemplates::Aes128Gcm(),
+      absl::make_unique<DummyAead>(remote_aead_name));
+  ASSERT_THAT(blocking_aead_result.status(), IsOk());
+  auto decrypt_result =
+      blocking_aead_result.ValueOrDie()->Decrypt(ciphertexts[2], aad);
+  ASSERT_THAT(decrypt_result.status(), IsOk());
+  EXPECT_EQ("message 2", decrypt_result.ValueOrDie());
+}
+
+TEST(KmsEnvelopeAeadTest, AsyncRemoteAeadErrors) {
+  EXPECT_THAT(AeadConfig::Register(), IsOk());
+  std::string aad = "Some data to authenticate.";
+  std::vector<std::function<void()>> pending;
+  KmsEnvelopeAead::CacheOptions options;
+  options.max_messages_per_dek = 10;
+  auto aead_result = KmsEnvelopeAead::NewAsync(
+      AeadKeyTemplates::Aes128Gcm(),
+      absl::make_unique<QueuedAsyncAead>("kms-backed-aead", &pending),
+      options);
+  ASSERT_THAT(aead_result.status(), IsOk());
+  auto aead = std::move(aead_result.ValueOrDie());
+
+  util::StatusOr<std::string> ciphertext =
+      util::Status(util::error::UNKNOWN, "not encrypted yet");
+  aead->EncryptAsync("message", aad,
+                     [&ciphertext](util::StatusOr<std::string> result) {
+                       ciphertext = result;
+                     });
+  RunPending(&pending);
+  ASSERT_THAT(ciphertext.status(), IsOk());
+
+  // A ciphertext whose DEK the KMS cannot decrypt fails for all waiters.
+  auto other_aead_result = KmsEnvelopeAead::New(
+      AeadKeyTemplates::Aes128Gcm(), absl::make_unique<DummyAead>("other"));
+  ASSERT_THAT(other_aead_result.status(), IsOk());
+  auto other_ciphertext =
+      other_aead_result.ValueOrDie()->Encrypt("message", aad);
+  ASSERT_THAT(other_ciphertext.status(), IsOk());
+  int failures = 0;
+  for (int i = 0; i < 2; i++) {
+    aead->DecryptAsync(other_ciphertext.ValueOrDie(), aad,
+                       [&failures](util::StatusOr<std::string> result) {
+                         EXPECT_THAT(result.status(),
+                                     StatusIs(util::error::INVALID_ARGUMENT,
+                                              HasSubstr("invalid")));
+                         failures++;
+                       });
+  }
+  EXPECT_EQ(1, pending.size());
+  RunPending(&pending);
+  EXPECT_EQ(2, failures);
+
+  // Parsing errors are reported without contacting the KMS.
+  aead->DecryptAsync("sh", aad, [&failures](util::StatusOr<std::string> result) {
+    EXPECT_THAT(result.status(),
+                StatusIs(util::error::INVALID_ARGUMENT, HasSubstr("too short")));
+    failures++;
+  });
+  EXPECT_EQ(3, failures);
+  EXPECT_TRUE(pending.empty());
+}
+
+TEST(KmsEnvelopeAeadTest, NullAsyncAead) {
+  auto aead_result = KmsEnvelopeAead::NewAsync(
+      AeadKeyTemplates::Aes128Gcm(), nullptr,
+      KmsEnvelopeAead::CacheOptions());
+  EXPECT_THAT(aead_result.status(),
+              StatusIs(util::error::INVALID_ARGUMENT,
+                       HasSubstr("must be non-null")));
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
@@ -0,0 +1,178 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/page_aead_wrapper.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/internal/monitored_operation.h"
+#include "tink/page_aead.h"
+#include "tink/primitive_set.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+using Entry = PrimitiveSet<PageAead>::Entry<PageAead>;
+
+util::Status Validate(PrimitiveSet<PageAead>* page_aead_set) {
+  if (page_aead_set == nullptr) {
+    return util::Status(util::error::INTERNAL,
+                        "page_aead_set must be non-NULL");
+  }
+  if (page_aead_set->get_primary() == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "page_aead_set has no primary");
+  }
+  size_t prefix_size = page_aead_set->get_primary()->get_identifier().size();
+  for (const Entry* entry : page_aead_set->get_all()) {
+    if (entry->get_identifier().size() != prefix_size) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "page_aead_set mixes RAW and non-RAW keys");
+    }
+  }
+  return util::OkStatus();
+}
+
+class PageAeadSetWrapper : public PageAead {
+ public:
+  explicit PageAeadSetWrapper(
+      std::unique_ptr<PrimitiveSet<PageAead>> page_aead_set)
+      : page_aead_set_(std::move(page_aead_set)),
+        prefix_size_(page_aead_set_->get_primary()->get_identifier().size()) {
+  }
+
+  int overhead() const override {
+    return page_aead_set_->get_primary()->get_primitive().overhead() +
+           prefix_size_;
+  }
+
+  crypto::tink::util::Status EncryptPage(
+      uint64_t page_number, absl::string_view associated_data,
+      absl::Span<char> page) const override;
+
+  crypto::tink::util::Status DecryptPage(
+      uint64_t page_number, absl::string_view associated_data,
+      absl::Span<char> page) const override;
+
+  crypto::tink::util::Status EncryptPages(
+      uint64_t first_page_number, absl::string_view associated_data,
+      int page_size, absl::Span<char> pages) const override;
+
+ private:
+  std::unique_ptr<PrimitiveSet<PageAead>> page_aead_set_;
+  // The size of the output prefixes of the keys, which is the same for all
+  // keys.
+  const size_t prefix_size_;
+};
+
+util::Status PageAeadSetWrapper::EncryptPage(uint64_t page_number,
+                                             absl::string_view associated_data,
+                                             absl::Span<char> page) const {
+  if (page.size() < overhead()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Page too small");
+  }
+  internal::MonitoredOperation operation("page_aead", "encrypt");
+  operation.KeyTried();
+  const Entry* primary = page_aead_set_->get_primary();
+  absl::string_view key_id = primary->get_identifier();
+  util::Status status = primary->get_primitive().EncryptPage(
+      page_number, associated_data,
+      page.subspan(0, page.size() - prefix_size_));
+  if (!status.ok()) return status;
+  std::copy(key_id.begin(), key_id.end(), page.end() - prefix_size_);
+  operation.Succeeded(primary->get_key_id());
+  return util::OkStatus();
+}
+
+util::Status PageAeadSetWrapper::DecryptPage(uint64_t page_number,
+                                             absl::string_view associated_data,
+                                             absl::Span<char> page) const {
+  if (page.size() < prefix_size_) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Page too small");
+  }
+  internal::MonitoredOperation operation("page_aead", "decrypt");
+  absl::Span<char> key_page = page.subspan(0, page.size() - prefix_size_);
+  auto primitives_result =
+      prefix_size_ == 0
+          ? page_aead_set_->get_raw_primitives()
+          : page_aead_set_->get_primitives(absl::string_view(
+                page.data() + key_page.size(), prefix_size_));
+  if (prefix_size_ == 0) operation.RawKeysTried();
+  if (primitives_result.ok()) {
+    const PrimitiveSet<PageAead>::Primitives& entries =
+        *primitives_result.ValueOrDie();
+    // A failed decryption leaves the page unspecified, so if several keys
+    // are to be tried, each one gets a copy of the original page.
+    std::string original;
+    if (entries.size() > 1) original.assign(key_page.data(), key_page.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+      if (i > 0) std::copy(original.begin(), original.end(), key_page.begin());
+      operation.KeyTried();
+      if (entries[i]
+              ->get_primitive()
+              .DecryptPage(page_number, associated_data, key_page)
+              .ok()) {
+        operation.Succeeded(entries[i]->get_key_id());
+        return util::OkStatus();
+      }
+    }
+  }
+  return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
+}
+
+util::Status PageAeadSetWrapper::EncryptPages(
+    uint64_t first_page_number, absl::string_view associated_data,
+    int page_size, absl::Span<char> pages) const {
+  if (prefix_size_ != 0) {
+    // The pages of the primary are not contiguous, as they are separated
+    // by the prefixes.
+    return PageAead::EncryptPages(first_page_number, associated_data,
+                                  page_size, pages);
+  }
+  internal::MonitoredOperation operation("page_aead", "encrypt");
+  operation.KeyTried();
+  const Entry* primary = page_aead_set_->get_primary();
+  util::Status status = primary->get_primitive().EncryptPages(
+      first_page_number, associated_data, page_size, pages);
+  if (!status.ok()) return status;
+  operation.Succeeded(primary->get_key_id());
+  return util::OkStatus();
+}
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<PageAead>> PageAeadWrapper::Wrap(
+    std::unique_ptr<PrimitiveSet<PageAead>> primitive_set) const {
+  util::Status status = Validate(primitive_set.get());
+  if (!status.ok()) return status;
+  primitive_set->Freeze();
+  std::unique_ptr<PageAead> page_aead =
+      absl::make_unique<PageAeadSetWrapper>(std::move(primitive_set));
+  return std::move(page_aead);
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,56 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_AEAD_PAGE_AEAD_WRAPPER_H_
+#define TINK_AEAD_PAGE_AEAD_WRAPPER_H_
+
+#include <memory>
+
+#include "tink/page_aead.h"
+#include "tink/primitive_set.h"
+#include "tink/primitive_wrapper.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+// Wraps a set of PageAead-instances that correspond to a keyset, and
+// combines them into a single PageAead.  A page of the wrapper is
+//
+//   page of the key || output prefix of the key
+//
+// so that the trailer of the pages stays of one size, while the key of
+// each page is found without trying every key:
+//   * EncryptPage(...) uses the primary instance, and writes the output
+//     prefix of the primary key at the end of the page
+//   * DecryptPage(...) uses the instances whose prefix is at the end of
+//     the page, or the RAW instances if the keys are RAW.
+// All the keys of the set must therefore be RAW, or none; and their
+// instances are expected to have the same overhead, as they do if they
+// are of the same key type.
+class PageAeadWrapper : public PrimitiveWrapper<PageAead, PageAead> {
+ public:
+  // Returns a PageAead that uses the instances provided in
+  // 'primitive_set', which must be non-NULL and must contain a primary
+  // instance.
+  crypto::tink::util::StatusOr<std::unique_ptr<PageAead>> Wrap(
+      std::unique_ptr<PrimitiveSet<PageAead>> primitive_set) const override;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_AEAD_PAGE_AEAD_WRAPPER_H_
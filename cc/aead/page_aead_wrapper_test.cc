@@ -0,0 +1,210 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/page_aead_wrapper.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/page_aead.h"
+#include "tink/primitive_set.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::KeysetInfo;
+using ::google::crypto::tink::KeyStatusType;
+using ::google::crypto::tink::OutputPrefixType;
+
+// A PageAead whose trailer is its name, padded to 8 bytes, and which
+// "encrypts" the data by flipping its bits.  Like real implementations, it
+// garbles the page when decryption fails.
+class DummyPageAead : public PageAead {
+ public:
+  explicit DummyPageAead(absl::string_view name)
+      : trailer_(std::string(name).append(kOverhead - name.size(), '\0')) {}
+
+  int overhead() const override { return kOverhead; }
+
+  util::Status EncryptPage(uint64_t page_number,
+                           absl::string_view associated_data,
+                           absl::Span<char> page) const override {
+    if (page.size() < kOverhead) {
+      return util::Status(util::error::INVALID_ARGUMENT, "Page too small");
+    }
+    for (size_t i = 0; i < page.size() - kOverhead; i++) page[i] ^= 0xff;
+    std::copy(trailer_.begin(), trailer_.end(), page.end() - kOverhead);
+    return util::OkStatus();
+  }
+
+  util::Status DecryptPage(uint64_t page_number,
+                           absl::string_view associated_data,
+                           absl::Span<char> page) const override {
+    if (page.size() < kOverhead ||
+        absl::string_view(page.end() - kOverhead, kOverhead) != trailer_) {
+      std::fill(page.begin(), page.end(), 'G');
+      return util::Status(util::error::INVALID_ARGUMENT, "Wrong key");
+    }
+    for (size_t i = 0; i < page.size() - kOverhead; i++) page[i] ^= 0xff;
+    return util::OkStatus();
+  }
+
+ private:
+  static constexpr int kOverhead = 8;
+
+  const std::string trailer_;
+};
+
+constexpr int DummyPageAead::kOverhead;
+
+// Adds a DummyPageAead named 'name' to 'page_aead_set', and makes it the
+// primary if 'primary' is true.
+void AddKey(PrimitiveSet<PageAead>* page_aead_set, absl::string_view name,
+            uint32_t key_id, OutputPrefixType prefix_type, bool primary) {
+  KeysetInfo::KeyInfo key_info;
+  key_info.set_output_prefix_type(prefix_type);
+  key_info.set_key_id(key_id);
+  key_info.set_status(KeyStatusType::ENABLED);
+  auto entry_result = page_aead_set->AddPrimitive(
+      absl::make_unique<DummyPageAead>(name), key_info);
+  ASSERT_THAT(entry_result.status(), IsOk());
+  if (primary) {
+    ASSERT_THAT(page_aead_set->set_primary(entry_result.ValueOrDie()),
+                IsOk());
+  }
+}
+
+TEST(PageAeadWrapperTest, WrapNullptr) {
+  EXPECT_THAT(PageAeadWrapper().Wrap(nullptr).status(),
+              StatusIs(util::error::INTERNAL));
+}
+
+TEST(PageAeadWrapperTest, WrapEmpty) {
+  EXPECT_THAT(
+      PageAeadWrapper().Wrap(absl::make_unique<PrimitiveSet<PageAead>>())
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(PageAeadWrapperTest, MixedRawAndNonRawKeys) {
+  auto page_aead_set = absl::make_unique<PrimitiveSet<PageAead>>();
+  AddKey(page_aead_set.get(), "key0", 100, OutputPrefixType::TINK, true);
+  AddKey(page_aead_set.get(), "key1", 101, OutputPrefixType::RAW, false);
+  EXPECT_THAT(PageAeadWrapper().Wrap(std::move(page_aead_set)).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(PageAeadWrapperTest, PrefixIsAtTheEndOfThePage) {
+  auto page_aead_set = absl::make_unique<PrimitiveSet<PageAead>>();
+  AddKey(page_aead_set.get(), "key0", 100, OutputPrefixType::TINK, true);
+  std::string prefix(page_aead_set->get_primary()->get_identifier());
+  auto page_aead_result = PageAeadWrapper().Wrap(std::move(page_aead_set));
+  ASSERT_THAT(page_aead_result.status(), IsOk());
+  const PageAead& page_aead = *page_aead_result.ValueOrDie();
+  EXPECT_EQ(page_aead.overhead(), 8 + 5);
+
+  std::string page(64, 'x');
+  ASSERT_THAT(page_aead.EncryptPage(1, "", absl::MakeSpan(&page[0], 64)),
+              IsOk());
+  EXPECT_EQ(page.substr(64 - 5), prefix);
+  EXPECT_EQ(page.substr(64 - 13, 4), "key0");
+  ASSERT_THAT(page_aead.DecryptPage(1, "", absl::MakeSpan(&page[0], 64)),
+              IsOk());
+  EXPECT_EQ(page.substr(0, 64 - 13), std::string(64 - 13, 'x'));
+}
+
+TEST(PageAeadWrapperTest, DecryptAfterRotation) {
+  for (OutputPrefixType prefix_type :
+       {OutputPrefixType::TINK, OutputPrefixType::RAW}) {
+    SCOPED_TRACE(prefix_type);
+    auto old_set = absl::make_unique<PrimitiveSet<PageAead>>();
+    AddKey(old_set.get(), "key0", 100, prefix_type, true);
+    auto old_page_aead = std::move(
+        PageAeadWrapper().Wrap(std::move(old_set)).ValueOrDie());
+    std::string page(64, 'x');
+    ASSERT_THAT(
+        old_page_aead->EncryptPage(1, "", absl::MakeSpan(&page[0], 64)),
+        IsOk());
+
+    // The new primary is added first, so that for RAW keys it is tried
+    // first, and garbles the page.
+    auto new_set = absl::make_unique<PrimitiveSet<PageAead>>();
+    AddKey(new_set.get(), "key1", 101, prefix_type, true);
+    AddKey(new_set.get(), "key0", 100, prefix_type, false);
+    auto new_page_aead = std::move(
+        PageAeadWrapper().Wrap(std::move(new_set)).ValueOrDie());
+    ASSERT_THAT(
+        new_page_aead->DecryptPage(1, "", absl::MakeSpan(&page[0], 64)),
+        IsOk());
+    EXPECT_EQ(page.substr(0, 64 - old_page_aead->overhead()),
+              std::string(64 - old_page_aead->overhead(), 'x'));
+
+    std::string unknown_page(64, 'x');
+    ASSERT_THAT(DummyPageAead("key2").EncryptPage(
+                    1, "", absl::MakeSpan(&unknown_page[0], 64)),
+                IsOk());
+    EXPECT_THAT(new_page_aead->DecryptPage(
+                    1, "", absl::MakeSpan(&unknown_page[0], 64)),
+                StatusIs(util::error::INVALID_ARGUMENT));
+  }
+}
+
+TEST(PageAeadWrapperTest, Batch) {
+  for (OutputPrefixType prefix_type :
+       {OutputPrefixType::TINK, OutputPrefixType::RAW}) {
+    SCOPED_TRACE(prefix_type);
+    auto page_aead_set = absl::make_unique<PrimitiveSet<PageAead>>();
+    AddKey(page_aead_set.get(), "key0", 100, prefix_type, true);
+    auto page_aead = std::move(
+        PageAeadWrapper().Wrap(std::move(page_aead_set)).ValueOrDie());
+    constexpr int kPageSize = 32;
+    std::string pages(4 * kPageSize, 'x');
+    ASSERT_THAT(page_aead->EncryptPages(
+                    10, "", kPageSize,
+                    absl::MakeSpan(&pages[0], pages.size())),
+                IsOk());
+    std::string third = pages.substr(2 * kPageSize, kPageSize);
+    ASSERT_THAT(page_aead->DecryptPage(
+                    12, "", absl::MakeSpan(&third[0], kPageSize)),
+                IsOk());
+    ASSERT_THAT(page_aead->DecryptPages(
+                    10, "", kPageSize,
+                    absl::MakeSpan(&pages[0], pages.size())),
+                IsOk());
+    int data_size = kPageSize - page_aead->overhead();
+    for (int i = 0; i < 4; i++) {
+      EXPECT_EQ(pages.substr(i * kPageSize, data_size),
+                std::string(data_size, 'x'));
+    }
+  }
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
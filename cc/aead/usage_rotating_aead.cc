@@ -0,0 +1,151 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/usage_rotating_aead.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/aead.h"
+#include "tink/internal/sharded_counter.h"
+#include "tink/keyset_handle.h"
+#include "tink/keyset_manager.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+// The encryptions of each shard are summed up every kMaxCheckInterval
+// encryptions at most, and often enough that the encryptions which may not
+// have been checked are at most 1/kMarginDivisor of the limit.
+constexpr int64_t kMaxCheckInterval = 1024;
+constexpr int64_t kMarginDivisor = 16;
+
+}  // namespace
+
+// static
+util::StatusOr<std::unique_ptr<UsageRotatingAead>> UsageRotatingAead::New(
+    std::unique_ptr<KeysetManager> keyset_manager, const Options& options) {
+  if (keyset_manager == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "keyset_manager must be non-null");
+  }
+  if (options.max_encryptions_per_key < 1) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "max_encryptions_per_key must be positive");
+  }
+  auto aead = absl::WrapUnique(
+      new UsageRotatingAead(std::move(keyset_manager), options));
+  util::Status status =
+      aead->AddGeneration(*aead->keyset_manager_->GetKeysetHandle());
+  if (!status.ok()) return status;
+  return std::move(aead);
+}
+
+UsageRotatingAead::UsageRotatingAead(
+    std::unique_ptr<KeysetManager> keyset_manager, const Options& options)
+    : keyset_manager_(std::move(keyset_manager)), options_(options) {}
+
+util::StatusOr<std::string> UsageRotatingAead::Encrypt(
+    absl::string_view plaintext, absl::string_view associated_data) const {
+  Generation& generation = *current_.load(std::memory_order_acquire);
+  if (generation.encryptions.Add(1) % generation.check_interval == 0) {
+    MaybeRotate(generation);
+  }
+  return generation.aead->Encrypt(plaintext, associated_data);
+}
+
+util::StatusOr<std::string> UsageRotatingAead::Decrypt(
+    absl::string_view ciphertext, absl::string_view associated_data) const {
+  return current_.load(std::memory_order_acquire)
+      ->aead->Decrypt(ciphertext, associated_data);
+}
+
+std::unique_ptr<KeysetHandle> UsageRotatingAead::GetKeysetHandle() const {
+  return keyset_manager_->GetKeysetHandle();
+}
+
+int64_t UsageRotatingAead::primary_key_encryptions() const {
+  return current_.load(std::memory_order_acquire)->encryptions.Sum();
+}
+
+util::Status UsageRotatingAead::AddGeneration(
+    const KeysetHandle& keyset_handle) const {
+  auto aead_result = keyset_handle.GetPrimitive<Aead>();
+  if (!aead_result.ok()) return aead_result.status();
+  auto generation = absl::make_unique<Generation>();
+  generation->aead = std::move(aead_result.ValueOrDie());
+  int64_t divisor =
+      kMarginDivisor * generation->encryptions.num_shards();
+  generation->check_interval = std::max<int64_t>(
+      1, std::min(kMaxCheckInterval,
+                  options_.max_encryptions_per_key / divisor));
+  absl::MutexLock lock(&mutex_);
+  generations_.push_back(std::move(generation));
+  current_.store(generations_.back().get(), std::memory_order_release);
+  return util::OkStatus();
+}
+
+void UsageRotatingAead::MaybeRotate(const Generation& generation) const {
+  // Every other shard may have counted up to check_interval - 1 encryptions
+  // since its last check.
+  int64_t unchecked = (generation.encryptions.num_shards() - 1) *
+                      (generation.check_interval - 1);
+  if (generation.encryptions.Sum() + unchecked <
+      options_.max_encryptions_per_key) {
+    return;
+  }
+  bool expected = false;
+  if (!rotating_.compare_exchange_strong(expected, true,
+                                         std::memory_order_acquire)) {
+    return;
+  }
+  if (current_.load(std::memory_order_acquire) == &generation) {
+    // On failure the current primary key stays in use, and the rotation is
+    // retried at the next check.
+    Rotate().IgnoreError();
+  }
+  rotating_.store(false, std::memory_order_release);
+}
+
+util::Status UsageRotatingAead::Rotate() const {
+  uint32_t old_primary_key_id =
+      keyset_manager_->GetKeysetHandle()->GetKeysetInfo().primary_key_id();
+  auto key_id_result = keyset_manager_->Rotate(options_.key_template);
+  if (!key_id_result.ok()) return key_id_result.status();
+  std::unique_ptr<KeysetHandle> keyset_handle =
+      keyset_manager_->GetKeysetHandle();
+  util::Status status = util::OkStatus();
+  if (options_.on_rotation) status = options_.on_rotation(*keyset_handle);
+  if (status.ok()) status = AddGeneration(*keyset_handle);
+  if (!status.ok()) {
+    keyset_manager_->SetPrimary(old_primary_key_id).IgnoreError();
+    keyset_manager_->Delete(key_id_result.ValueOrDie()).IgnoreError();
+  }
+  return status;
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,132 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_AEAD_USAGE_ROTATING_AEAD_H_
+#define TINK_AEAD_USAGE_ROTATING_AEAD_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/aead.h"
+#include "tink/internal/sharded_counter.h"
+#include "tink/keyset_handle.h"
+#include "tink/keyset_manager.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// An Aead over a keyset which replaces its primary key by a new one once
+// the primary key encrypted a given number of messages, e.g. to stay below
+// the limit on the number of messages encrypted under one AES-GCM key with
+// random nonces.  Keys are thus rotated on volume, rather than on a fixed
+// schedule.
+//
+// The encryptions are counted in per-thread shards, and the sum is only
+// checked every few encryptions of a shard, so encrypting takes no lock and
+// touches no shared cache line.  Rotation starts once the count is within
+// the encryptions which may not have been checked yet of the limit; it runs
+// in the encrypting thread which noticed it, while the other threads keep
+// encrypting with the old primary key until the new one is swapped in.  The
+// limit is therefore a target rather than a hard bound: under heavy
+// concurrency a few more messages may be encrypted while the rotation runs.
+//
+// Instances of this class are thread safe.
+class UsageRotatingAead : public Aead {
+ public:
+  struct Options {
+    // The template of the new primary keys.
+    google::crypto::tink::KeyTemplate key_template;
+    // The number of encryptions with a primary key after which it is
+    // replaced.  The default is the limit of NIST SP 800-38D for AES-GCM with
+    // random 96-bit nonces.
+    int64_t max_encryptions_per_key = int64_t{1} << 32;
+    // If set, called with the keyset once it holds the new primary key, but
+    // before that key encrypts anything, e.g. to store the keyset where the
+    // decrypting services read it.  If it fails, the new key is removed, the
+    // old primary key stays in use, and the rotation is retried later.
+    std::function<crypto::tink::util::Status(const KeysetHandle&)>
+        on_rotation;
+  };
+
+  // Returns an Aead over the keyset of 'keyset_manager', which it takes
+  // over: the keyset must no longer be changed through other means.
+  static crypto::tink::util::StatusOr<std::unique_ptr<UsageRotatingAead>> New(
+      std::unique_ptr<KeysetManager> keyset_manager, const Options& options);
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override;
+
+  // Returns the current keyset.
+  std::unique_ptr<KeysetHandle> GetKeysetHandle() const;
+
+  // The number of encryptions with the current primary key.  Concurrent
+  // encryptions may or may not be included.
+  int64_t primary_key_encryptions() const;
+
+  ~UsageRotatingAead() override {}
+
+ private:
+  // The primitive of one version of the keyset, and the number of
+  // encryptions with its primary key.
+  struct Generation {
+    std::unique_ptr<Aead> aead;
+    internal::ShardedCounter encryptions;
+    // The sum of the shards is checked whenever a shard reaches a multiple
+    // of this.
+    int64_t check_interval;
+  };
+
+  UsageRotatingAead(std::unique_ptr<KeysetManager> keyset_manager,
+                    const Options& options);
+
+  // Adds a generation for 'keyset_handle', and makes it the current one.
+  crypto::tink::util::Status AddGeneration(
+      const KeysetHandle& keyset_handle) const ABSL_LOCKS_EXCLUDED(mutex_);
+  // Rotates the primary key if 'generation' is still current and reached
+  // the limit, unless another thread is already rotating.
+  void MaybeRotate(const Generation& generation) const;
+  crypto::tink::util::Status Rotate() const;
+
+  const std::unique_ptr<KeysetManager> keyset_manager_;
+  const Options options_;
+  mutable std::atomic<Generation*> current_{nullptr};
+  mutable std::atomic<bool> rotating_{false};
+  mutable absl::Mutex mutex_;
+  // All generations so far.  They are kept alive, since operations started
+  // before a rotation may still use the older ones.
+  mutable std::vector<std::unique_ptr<Generation>> generations_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_AEAD_USAGE_ROTATING_AEAD_H_
@@ -0,0 +1,159 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/usage_rotating_aead.h"
+
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "tink/aead/aead_config.h"
+#include "tink/aead/aead_key_templates.h"
+#include "tink/keyset_handle.h"
+#include "tink/keyset_manager.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::KeysetInfo;
+
+class UsageRotatingAeadTest : public ::testing::Test {
+ protected:
+  void SetUp() override { ASSERT_THAT(AeadConfig::Register(), IsOk()); }
+
+  std::unique_ptr<KeysetManager> NewKeysetManager() {
+    auto manager_result = KeysetManager::New(AeadKeyTemplates::Aes128Gcm());
+    EXPECT_THAT(manager_result.status(), IsOk());
+    return std::move(manager_result.ValueOrDie());
+  }
+
+  UsageRotatingAead::Options NewOptions(int64_t max_encryptions_per_key) {
+    UsageRotatingAead::Options options;
+    options.key_template = AeadKeyTemplates::Aes128Gcm();
+    options.max_encryptions_per_key = max_encryptions_per_key;
+    return options;
+  }
+};
+
+TEST_F(UsageRotatingAeadTest, RotatesAfterMaxEncryptions) {
+  UsageRotatingAead::Options options = NewOptions(10);
+  std::vector<int> rotated_keyset_sizes;
+  options.on_rotation = [&rotated_keyset_sizes](const KeysetHandle& handle) {
+    rotated_keyset_sizes.push_back(handle.GetKeysetInfo().key_info_size());
+    return util::OkStatus();
+  };
+  auto aead_result = UsageRotatingAead::New(NewKeysetManager(), options);
+  ASSERT_THAT(aead_result.status(), IsOk());
+  UsageRotatingAead& aead = *aead_result.ValueOrDie();
+
+  std::vector<std::string> ciphertexts;
+  for (int i = 0; i < 25; i++) {
+    auto encrypt_result = aead.Encrypt(absl::StrCat("message ", i), "ad");
+    ASSERT_THAT(encrypt_result.status(), IsOk());
+    ciphertexts.push_back(encrypt_result.ValueOrDie());
+  }
+  EXPECT_EQ(std::vector<int>({2, 3}), rotated_keyset_sizes);
+  EXPECT_EQ(3, aead.GetKeysetHandle()->GetKeysetInfo().key_info_size());
+  EXPECT_EQ(5, aead.primary_key_encryptions());
+  // Each key encrypted 10 messages at most, and all of them still decrypt.
+  for (int i = 0; i < 25; i++) {
+    if (i > 0 && i % 10 != 0) {
+      EXPECT_EQ(ciphertexts[i - 1].substr(0, 5), ciphertexts[i].substr(0, 5));
+    }
+    auto decrypt_result = aead.Decrypt(ciphertexts[i], "ad");
+    ASSERT_THAT(decrypt_result.status(), IsOk());
+    EXPECT_EQ(absl::StrCat("message ", i), decrypt_result.ValueOrDie());
+  }
+  EXPECT_NE(ciphertexts[9].substr(0, 5), ciphertexts[10].substr(0, 5));
+}
+
+TEST_F(UsageRotatingAeadTest, FailedRotationKeepsPrimaryKey) {
+  UsageRotatingAead::Options options = NewOptions(3);
+  int attempts = 0;
+  options.on_rotation = [&attempts](const KeysetHandle& handle) {
+    attempts++;
+    return util::Status(util::error::UNAVAILABLE, "storage unavailable");
+  };
+  auto aead_result = UsageRotatingAead::New(NewKeysetManager(), options);
+  ASSERT_THAT(aead_result.status(), IsOk());
+  UsageRotatingAead& aead = *aead_result.ValueOrDie();
+  uint32_t primary_key_id =
+      aead.GetKeysetHandle()->GetKeysetInfo().primary_key_id();
+
+  for (int i = 0; i < 5; i++) {
+    ASSERT_THAT(aead.Encrypt("message", "ad").status(), IsOk());
+  }
+  // The rotation is retried after every further encryption.
+  EXPECT_EQ(3, attempts);
+  EXPECT_EQ(5, aead.primary_key_encryptions());
+  KeysetInfo keyset_info = aead.GetKeysetHandle()->GetKeysetInfo();
+  EXPECT_EQ(primary_key_id, keyset_info.primary_key_id());
+  EXPECT_EQ(1, keyset_info.key_info_size());
+}
+
+TEST_F(UsageRotatingAeadTest, ConcurrentEncryptions) {
+  auto aead_result =
+      UsageRotatingAead::New(NewKeysetManager(), NewOptions(1000));
+  ASSERT_THAT(aead_result.status(), IsOk());
+  const UsageRotatingAead& aead = *aead_result.ValueOrDie();
+
+  std::vector<std::vector<std::string>> ciphertexts(4);
+  std::vector<std::thread> threads;
+  for (auto& thread_ciphertexts : ciphertexts) {
+    threads.emplace_back([&aead, &thread_ciphertexts]() {
+      for (int i = 0; i < 2000; i++) {
+        auto encrypt_result = aead.Encrypt("message", "ad");
+        if (encrypt_result.ok()) {
+          thread_ciphertexts.push_back(encrypt_result.ValueOrDie());
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+
+  // Encryptions which run during a rotation still use the old key, so there
+  // may be fewer than 8 rotations.
+  EXPECT_GE(aead.GetKeysetHandle()->GetKeysetInfo().key_info_size(), 5);
+  for (const auto& thread_ciphertexts : ciphertexts) {
+    ASSERT_EQ(2000, thread_ciphertexts.size());
+    for (const std::string& ciphertext : thread_ciphertexts) {
+      EXPECT_THAT(aead.Decrypt(ciphertext, "ad").status(), IsOk());
+    }
+  }
+}
+
+TEST_F(UsageRotatingAeadTest, InvalidArguments) {
+  EXPECT_THAT(UsageRotatingAead::New(nullptr, NewOptions(10)).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(UsageRotatingAead::New(NewKeysetManager(), NewOptions(0))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -21,6 +21,8 @@
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "tink/aead.h"
+#include "tink/aead/cord_aead.h"
+#include "tink/aead/internal/cord_aead_from_aead.h"
 #include "tink/core/key_type_manager.h"
 #include "tink/subtle/random.h"
 #include "tink/subtle/xchacha20_poly1305_boringssl.h"
@@ -40,7 +42,7 @@ namespace tink {
 class XChaCha20Poly1305KeyManager
     : public KeyTypeManager<google::crypto::tink::XChaCha20Poly1305Key,
                             google::crypto::tink::XChaCha20Poly1305KeyFormat,
-                            List<Aead>> {
+                            List<Aead, CordAead>> {
  public:
   class AeadFactory : public PrimitiveFactory<Aead> {
     crypto::tink::util::StatusOr<std::unique_ptr<Aead>> Create(
@@ -49,9 +51,20 @@ class XChaCha20Poly1305KeyManager
           util::SecretDataFromStringView(key.key_value()));
     }
   };
+  class CordAeadFactory : public PrimitiveFactory<CordAead> {
+    crypto::tink::util::StatusOr<std::unique_ptr<CordAead>> Create(
+        const google::crypto::tink::XChaCha20Poly1305Key& key) const override {
+      auto aead_result = subtle::XChacha20Poly1305BoringSsl::New(
+          util::SecretDataFromStringView(key.key_value()));
+      if (!aead_result.ok()) return aead_result.status();
+      return {absl::make_unique<CordAeadFromAead>(
+          std::move(aead_result.ValueOrDie()))};
+    }
+  };
 
   XChaCha20Poly1305KeyManager()
-      : KeyTypeManager(absl::make_unique<AeadFactory>()) {}
+      : KeyTypeManager(absl::make_unique<AeadFactory>(),
+                       absl::make_unique<CordAeadFactory>()) {}
 
   uint32_t get_version() const override { return 0; }
 
@@ -0,0 +1,69 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_ASYNC_AEAD_H_
+#define TINK_ASYNC_AEAD_H_
+
+#include <functional>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+///////////////////////////////////////////////////////////////////////////////
+// The interface for AEADs whose operations complete asynchronously, e.g.
+// because they are executed by a remote KMS.  It offers the same security
+// guarantees as Aead, but lets a caller have many operations in flight at
+// the same time instead of blocking on each of them.
+//
+// Implementations are expected to be thread safe.
+class AsyncAead {
+ public:
+  // Called exactly once with the result of an operation: the ciphertext for
+  // EncryptAsync(), the plaintext for DecryptAsync(), or an error.  It may be
+  // called on any thread, also before the call that started the operation
+  // returns, so it must not acquire locks held by that caller.
+  using DoneCallback =
+      std::function<void(crypto::tink::util::StatusOr<std::string>)>;
+
+  // Starts encrypting 'plaintext' with 'associated_data' as associated data
+  // and calls 'done' with the resulting ciphertext.  The inputs need to stay
+  // valid only until this method returns.
+  virtual void EncryptAsync(absl::string_view plaintext,
+                            absl::string_view associated_data,
+                            DoneCallback done) const = 0;
+
+  // Starts decrypting 'ciphertext' with 'associated_data' as associated data
+  // and calls 'done' with the resulting plaintext.  The inputs need to stay
+  // valid only until this method returns.
+  virtual void DecryptAsync(absl::string_view ciphertext,
+                            absl::string_view associated_data,
+                            DoneCallback done) const = 0;
+
+  // Pending operations may still run after an AsyncAead is destroyed only
+  // if the implementation says so; the implementations in Tink wait for
+  // them to complete.
+  virtual ~AsyncAead() {}
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_ASYNC_AEAD_H_
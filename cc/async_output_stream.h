@@ -0,0 +1,64 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_ASYNC_OUTPUT_STREAM_H_
+#define TINK_ASYNC_OUTPUT_STREAM_H_
+
+#include <cstdint>
+#include <functional>
+
+#include "absl/types/span.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+
+// Abstract interface of an output stream that does not block the calling
+// thread: each operation takes a callback, which is called with the status
+// of the operation once it is done.  So a few threads can serve many
+// streams, e.g. when the data goes to the network via an event loop.
+//
+// A callback may be called before the operation returns (e.g. if it
+// completed right away), or later on any thread.  At most one operation
+// of a stream may be outstanding at a time; the next one can be started
+// from the callback of the previous one.  The stream may be destroyed from
+// the callback of Close(), or once no operation is outstanding.
+class AsyncOutputStream {
+ public:
+  using Callback = std::function<void(crypto::tink::util::Status)>;
+
+  AsyncOutputStream() {}
+  virtual ~AsyncOutputStream() {}
+
+  // Writes all of 'data' to the stream, and calls 'done' afterwards.
+  // 'data' must stay valid until 'done' is called.  If the status passed
+  // to 'done' is not OK, some of 'data' may have been written, and the
+  // stream must not be used any more, other than by destroying it.
+  virtual void Write(absl::Span<const uint8_t> data, Callback done) = 0;
+
+  // Closes the stream, and calls 'done' afterwards.  Implementations may
+  // release any resources used by the stream only then.
+  virtual void Close(Callback done) = 0;
+
+  // Returns the total number of bytes written by the operations that are
+  // done.
+  virtual int64_t Position() const = 0;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_ASYNC_OUTPUT_STREAM_H_
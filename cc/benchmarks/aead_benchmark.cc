@@ -0,0 +1,161 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Benchmarks of the Aead implementations, on their own and behind
+// AeadWrapper with keysets of various sizes.
+
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "tink/aead.h"
+#include "tink/aead/aead_config.h"
+#include "tink/aead/aead_key_templates.h"
+#include "tink/benchmarks/benchmark_util.h"
+#include "tink/subtle/aes_eax_boringssl.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/aes_gcm_siv_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/xchacha20_poly1305_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace benchmarks {
+namespace {
+
+const char kAssociatedData[] = "associated data";
+
+util::SecretData RandomKey(int size) {
+  return util::SecretDataFromStringView(subtle::Random::GetRandomBytes(size));
+}
+
+const Aead& AesGcm() {
+  static const Aead* aead =
+      subtle::AesGcmBoringSsl::New(RandomKey(16)).ValueOrDie().release();
+  return *aead;
+}
+
+const Aead& AesGcmSiv() {
+  static const Aead* aead =
+      subtle::AesGcmSivBoringSsl::New(RandomKey(16)).ValueOrDie().release();
+  return *aead;
+}
+
+const Aead& AesEaxBoringSsl() {
+  static const Aead* aead =
+      subtle::AesEaxBoringSsl::New(RandomKey(16), 16).ValueOrDie().release();
+  return *aead;
+}
+
+const Aead& XChaCha20Poly1305() {
+  static const Aead* aead =
+      subtle::XChacha20Poly1305BoringSsl::New(RandomKey(32))
+          .ValueOrDie()
+          .release();
+  return *aead;
+}
+
+// The primitives are created once and shared by all threads of a benchmark,
+// as they would be in a server.
+void BM_Encrypt(benchmark::State& state, const Aead& (*aead)()) {
+  std::string plaintext = RandomMessage(state.range(0));
+  BenchmarkCounters counters(state);
+  for (auto _ : state) {
+    auto ciphertext = aead().Encrypt(plaintext, kAssociatedData);
+    benchmark::DoNotOptimize(ciphertext);
+  }
+  counters.Finish(state.range(0));
+}
+
+void BM_Decrypt(benchmark::State& state, const Aead& (*aead)()) {
+  std::string ciphertext =
+      aead().Encrypt(RandomMessage(state.range(0)), kAssociatedData)
+          .ValueOrDie();
+  BenchmarkCounters counters(state);
+  for (auto _ : state) {
+    auto plaintext = aead().Decrypt(ciphertext, kAssociatedData);
+    benchmark::DoNotOptimize(plaintext);
+  }
+  counters.Finish(state.range(0));
+}
+
+#define TINK_AEAD_BENCHMARK(name)                                    \
+  BENCHMARK_CAPTURE(BM_Encrypt, name, &name)                         \
+      ->Apply(MessageSizes)                                          \
+      ->Apply(ThreadCounts);                                         \
+  BENCHMARK_CAPTURE(BM_Decrypt, name, &name)->Apply(MessageSizes)
+
+TINK_AEAD_BENCHMARK(AesGcm);
+TINK_AEAD_BENCHMARK(AesGcmSiv);
+TINK_AEAD_BENCHMARK(AesEaxBoringSsl);
+TINK_AEAD_BENCHMARK(XChaCha20Poly1305);
+
+#undef TINK_AEAD_BENCHMARK
+
+// Measures the overhead of AeadWrapper and PrimitiveSet over AES-GCM, for
+// keysets of state.range(1) keys.  Decryption uses a ciphertext of the
+// primary key.
+util::StatusOr<std::unique_ptr<Aead>> WrappedAesGcm(int num_keys) {
+  auto status = AeadConfig::Register();
+  if (!status.ok()) return status;
+  auto handle_result = NewKeysetHandle(AeadKeyTemplates::Aes128Gcm(), num_keys);
+  if (!handle_result.ok()) return handle_result.status();
+  return handle_result.ValueOrDie()->GetPrimitive<Aead>();
+}
+
+void BM_WrappedEncrypt(benchmark::State& state) {
+  auto aead_result = WrappedAesGcm(state.range(1));
+  if (!aead_result.ok()) {
+    SkipWithError(state, aead_result.status());
+    return;
+  }
+  const Aead& aead = *aead_result.ValueOrDie();
+  std::string plaintext = RandomMessage(state.range(0));
+  BenchmarkCounters counters(state);
+  for (auto _ : state) {
+    auto ciphertext = aead.Encrypt(plaintext, kAssociatedData);
+    benchmark::DoNotOptimize(ciphertext);
+  }
+  counters.Finish(state.range(0));
+}
+
+void BM_WrappedDecrypt(benchmark::State& state) {
+  auto aead_result = WrappedAesGcm(state.range(1));
+  if (!aead_result.ok()) {
+    SkipWithError(state, aead_result.status());
+    return;
+  }
+  const Aead& aead = *aead_result.ValueOrDie();
+  std::string ciphertext =
+      aead.Encrypt(RandomMessage(state.range(0)), kAssociatedData)
+          .ValueOrDie();
+  BenchmarkCounters counters(state);
+  for (auto _ : state) {
+    auto plaintext = aead.Decrypt(ciphertext, kAssociatedData);
+    benchmark::DoNotOptimize(plaintext);
+  }
+  counters.Finish(state.range(0));
+}
+
+BENCHMARK(BM_WrappedEncrypt)->Apply(MessageAndKeysetSizes);
+BENCHMARK(BM_WrappedDecrypt)->Apply(MessageAndKeysetSizes);
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,104 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/benchmarks/benchmark_util.h"
+
+#include <sys/resource.h>
+
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "tink/keyset_handle.h"
+#include "tink/keyset_manager.h"
+#include "tink/subtle/random.h"
+#include "tink/util/allocation_counter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace benchmarks {
+
+void BenchmarkCounters::Finish(int64_t bytes_per_op) {
+  if (bytes_per_op > 0) {
+    state_.SetBytesProcessed(state_.iterations() * bytes_per_op);
+  }
+  int64_t allocations =
+      test::ThreadAllocationCount() - allocations_at_start_;
+  state_.counters["allocs/op"] = benchmark::Counter(
+      state_.iterations() == 0
+          ? 0
+          : static_cast<double>(allocations) / state_.iterations(),
+      benchmark::Counter::kAvgThreads);
+}
+
+void MessageSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgName("bytes");
+  for (int64_t size = 16; size <= (16 << 20); size *= 16) {
+    benchmark->Arg(size);
+  }
+}
+
+void MessageAndKeysetSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgNames({"bytes", "keys"});
+  for (int64_t size : {16, 1024, 64 << 10}) {
+    for (int num_keys : {1, 10, 100}) {
+      benchmark->Args({size, num_keys});
+    }
+  }
+}
+
+void ThreadCounts(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ThreadRange(1, 8)->UseRealTime();
+}
+
+void SkipWithError(benchmark::State& state, const util::Status& status) {
+  std::string message = status.ToString();
+  state.SkipWithError(message.c_str());
+}
+
+int64_t PeakRssKb() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024;  // Bytes on macOS.
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+std::string RandomMessage(int64_t size) {
+  return subtle::Random::GetRandomBytes(size);
+}
+
+util::StatusOr<std::unique_ptr<KeysetHandle>> NewKeysetHandle(
+    const google::crypto::tink::KeyTemplate& key_template, int num_keys) {
+  auto manager_result = KeysetManager::New(key_template);
+  if (!manager_result.ok()) return manager_result.status();
+  std::unique_ptr<KeysetManager> manager =
+      std::move(manager_result.ValueOrDie());
+  for (int i = 1; i < num_keys; i++) {
+    auto rotate_result = manager->Rotate(key_template);
+    if (!rotate_result.ok()) return rotate_result.status();
+  }
+  return manager->GetKeysetHandle();
+}
+
+}  // namespace benchmarks
+}  // namespace tink
+}  // namespace crypto
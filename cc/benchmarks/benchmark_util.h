@@ -0,0 +1,85 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_BENCHMARKS_BENCHMARK_UTIL_H_
+#define TINK_BENCHMARKS_BENCHMARK_UTIL_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "tink/keyset_handle.h"
+#include "tink/util/allocation_counter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace benchmarks {
+
+// Records how long each iteration of a benchmark loop takes in terms of
+// bytes and heap allocations.  Create it right before the loop and call
+// Finish() right after it:
+//
+//   BenchmarkCounters counters(state);
+//   for (auto _ : state) { ... }
+//   counters.Finish(message_size);
+class BenchmarkCounters {
+ public:
+  explicit BenchmarkCounters(benchmark::State& state)
+      : state_(state),
+        allocations_at_start_(test::ThreadAllocationCount()) {}
+
+  // Reports 'bytes_per_op' processed bytes per iteration, so that the
+  // benchmark prints a throughput (unless 'bytes_per_op' is 0), and adds an
+  // "allocs/op" counter.
+  void Finish(int64_t bytes_per_op);
+
+ private:
+  benchmark::State& state_;
+  const int64_t allocations_at_start_;
+};
+
+// Message sizes swept by the throughput benchmarks, from 16 B to 16 MiB.
+void MessageSizes(benchmark::internal::Benchmark* benchmark);
+
+// Pairs of message sizes and keyset sizes swept by the wrapper benchmarks.
+void MessageAndKeysetSizes(benchmark::internal::Benchmark* benchmark);
+
+// Thread counts swept by the benchmarks of thread-safe primitives.
+void ThreadCounts(benchmark::internal::Benchmark* benchmark);
+
+// Marks the benchmark as failed with the message of 'status'.
+void SkipWithError(benchmark::State& state, const util::Status& status);
+
+// Returns the peak resident set size of the process so far, in KiB.
+int64_t PeakRssKb();
+
+// Returns a random string of 'size' bytes.
+std::string RandomMessage(int64_t size);
+
+// Returns a handle to a keyset with 'num_keys' keys generated from
+// 'key_template'.  The last key is the primary.
+crypto::tink::util::StatusOr<std::unique_ptr<KeysetHandle>> NewKeysetHandle(
+    const google::crypto::tink::KeyTemplate& key_template, int num_keys);
+
+}  // namespace benchmarks
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_BENCHMARKS_BENCHMARK_UTIL_H_
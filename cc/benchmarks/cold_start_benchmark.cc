@@ -0,0 +1,385 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Benchmarks of the cold start of a process, up to its first encryption:
+// the registration of the key managers, the loading of encrypted keysets,
+// the creation of primitives and the first call of each primitive.  Every
+// benchmark also reports the peak resident set size of the process, as
+// "peak_rss_kb", so that regressions of the start-up memory show up too;
+// run a single benchmark per process (--benchmark_filter) to attribute it.
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "benchmark/benchmark.h"
+#include "absl/memory/memory.h"
+#include "tink/aead.h"
+#include "tink/aead/aead_key_templates.h"
+#include "tink/benchmarks/benchmark_util.h"
+#include "tink/binary_keyset_reader.h"
+#include "tink/binary_keyset_writer.h"
+#include "tink/cleartext_keyset_handle.h"
+#include "tink/config/tink_config.h"
+#include "tink/daead/deterministic_aead_key_templates.h"
+#include "tink/deterministic_aead.h"
+#include "tink/hybrid/hybrid_key_templates.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/json_keyset_reader.h"
+#include "tink/json_keyset_writer.h"
+#include "tink/keyset_handle.h"
+#include "tink/keyset_reader.h"
+#include "tink/mac.h"
+#include "tink/mac/mac_key_templates.h"
+#include "tink/public_key_sign.h"
+#include "tink/registry.h"
+#include "tink/signature/signature_key_templates.h"
+#include "tink/util/fake_kms_client.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace benchmarks {
+namespace {
+
+using ::google::crypto::tink::KeyStatusType;
+using ::google::crypto::tink::KeyTemplate;
+using ::google::crypto::tink::Keyset;
+
+const char kMessage[] = "first message";
+const char kAssociatedData[] = "associated data";
+
+enum class KeysetFormat { kBinary, kJson };
+
+// Keyset sizes swept by the keyset benchmarks, from 1 to 100k keys.
+void KeysetSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgName("keys");
+  for (int num_keys = 1; num_keys <= 100000; num_keys *= 10) {
+    benchmark->Arg(num_keys);
+  }
+}
+
+// Keyset sizes for the key types whose keys are slow to generate.
+void SmallKeysetSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgName("keys")->Arg(1)->Arg(100)->Arg(1000);
+}
+
+void ReportPeakRss(benchmark::State& state) {
+  state.counters["peak_rss_kb"] =
+      benchmark::Counter(static_cast<double>(PeakRssKb()));
+}
+
+// Registers all key managers, or returns false after marking 'state' as
+// failed.
+bool RegisterTinkConfig(benchmark::State& state) {
+  auto status = TinkConfig::Register();
+  if (!status.ok()) {
+    SkipWithError(state, status);
+    return false;
+  }
+  return true;
+}
+
+// Returns a handle to a keyset with 'num_keys' keys generated from
+// 'key_template'.  Unlike NewKeysetHandle(), the keys are added to the
+// keyset directly, which keeps the keysets of 100k keys quick to build.
+util::StatusOr<std::unique_ptr<KeysetHandle>> NewLargeKeysetHandle(
+    const KeyTemplate& key_template, int num_keys) {
+  Keyset keyset;
+  for (int i = 1; i <= num_keys; i++) {
+    auto key_data_result = Registry::NewKeyData(key_template);
+    if (!key_data_result.ok()) return key_data_result.status();
+    Keyset::Key* key = keyset.add_key();
+    *key->mutable_key_data() = *key_data_result.ValueOrDie();
+    key->set_key_id(i);
+    key->set_status(KeyStatusType::ENABLED);
+    key->set_output_prefix_type(key_template.output_prefix_type());
+  }
+  keyset.set_primary_key_id(num_keys);
+  return CleartextKeysetHandle::GetKeysetHandle(keyset);
+}
+
+// Returns the Aead of a new master key of a FakeKmsClient.
+util::StatusOr<std::unique_ptr<Aead>> NewMasterKeyAead() {
+  auto key_uri_result = test::FakeKmsClient::CreateFakeKeyUri();
+  if (!key_uri_result.ok()) return key_uri_result.status();
+  const std::string& key_uri = key_uri_result.ValueOrDie();
+  auto client_result = test::FakeKmsClient::New(key_uri, "");
+  if (!client_result.ok()) return client_result.status();
+  return client_result.ValueOrDie()->GetAead(key_uri);
+}
+
+// Returns 'keyset_handle' encrypted with 'master_key_aead' in 'format'.
+util::StatusOr<std::string> WriteEncryptedKeyset(
+    const KeysetHandle& keyset_handle, const Aead& master_key_aead,
+    KeysetFormat format) {
+  auto destination = absl::make_unique<std::stringstream>();
+  std::stringstream* encrypted_keyset = destination.get();
+  std::unique_ptr<KeysetWriter> writer;
+  if (format == KeysetFormat::kBinary) {
+    auto writer_result = BinaryKeysetWriter::New(std::move(destination));
+    if (!writer_result.ok()) return writer_result.status();
+    writer = std::move(writer_result.ValueOrDie());
+  } else {
+    auto writer_result = JsonKeysetWriter::New(std::move(destination));
+    if (!writer_result.ok()) return writer_result.status();
+    writer = std::move(writer_result.ValueOrDie());
+  }
+  auto status = keyset_handle.Write(writer.get(), master_key_aead);
+  if (!status.ok()) return status;
+  return encrypted_keyset->str();
+}
+
+util::StatusOr<std::unique_ptr<KeysetReader>> NewKeysetReader(
+    absl::string_view serialized_keyset, KeysetFormat format) {
+  if (format == KeysetFormat::kBinary) {
+    return BinaryKeysetReader::New(serialized_keyset);
+  }
+  return JsonKeysetReader::New(serialized_keyset);
+}
+
+// The first calls of the primitives.
+util::StatusOr<std::string> FirstCall(const Aead& aead) {
+  return aead.Encrypt(kMessage, kAssociatedData);
+}
+
+util::StatusOr<std::string> FirstCall(const DeterministicAead& daead) {
+  return daead.EncryptDeterministically(kMessage, kAssociatedData);
+}
+
+util::StatusOr<std::string> FirstCall(const Mac& mac) {
+  return mac.ComputeMac(kMessage);
+}
+
+util::StatusOr<std::string> FirstCall(const PublicKeySign& signer) {
+  return signer.Sign(kMessage);
+}
+
+util::StatusOr<std::string> FirstCall(const HybridEncrypt& encrypter) {
+  return encrypter.Encrypt(kMessage, kAssociatedData);
+}
+
+void BM_TinkConfigRegister(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    Registry::Reset();
+    state.ResumeTiming();
+    auto status = TinkConfig::Register();
+    if (!status.ok()) {
+      SkipWithError(state, status);
+      break;
+    }
+  }
+  ReportPeakRss(state);
+}
+BENCHMARK(BM_TinkConfigRegister);
+
+void BM_TinkConfigRegisterLazily(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    Registry::Reset();
+    state.ResumeTiming();
+    auto status = TinkConfig::RegisterLazily();
+    if (!status.ok()) {
+      SkipWithError(state, status);
+      break;
+    }
+  }
+  ReportPeakRss(state);
+}
+BENCHMARK(BM_TinkConfigRegisterLazily);
+
+// Reads a keyset of AES-GCM keys encrypted with a FakeKmsClient master key.
+void BM_KeysetHandleRead(benchmark::State& state, KeysetFormat format) {
+  if (!RegisterTinkConfig(state)) return;
+  auto handle_result =
+      NewLargeKeysetHandle(AeadKeyTemplates::Aes128Gcm(), state.range(0));
+  if (!handle_result.ok()) {
+    SkipWithError(state, handle_result.status());
+    return;
+  }
+  auto master_key_result = NewMasterKeyAead();
+  if (!master_key_result.ok()) {
+    SkipWithError(state, master_key_result.status());
+    return;
+  }
+  const Aead& master_key_aead = *master_key_result.ValueOrDie();
+  auto encrypted_keyset_result = WriteEncryptedKeyset(
+      *handle_result.ValueOrDie(), master_key_aead, format);
+  if (!encrypted_keyset_result.ok()) {
+    SkipWithError(state, encrypted_keyset_result.status());
+    return;
+  }
+  const std::string& encrypted_keyset = encrypted_keyset_result.ValueOrDie();
+  for (auto _ : state) {
+    auto reader_result = NewKeysetReader(encrypted_keyset, format);
+    if (!reader_result.ok()) {
+      SkipWithError(state, reader_result.status());
+      break;
+    }
+    auto read_result = KeysetHandle::Read(
+        std::move(reader_result.ValueOrDie()), master_key_aead);
+    if (!read_result.ok()) {
+      SkipWithError(state, read_result.status());
+      break;
+    }
+    benchmark::DoNotOptimize(read_result);
+  }
+  state.SetBytesProcessed(state.iterations() * encrypted_keyset.size());
+  ReportPeakRss(state);
+}
+BENCHMARK_CAPTURE(BM_KeysetHandleRead, binary, KeysetFormat::kBinary)
+    ->Apply(KeysetSizes);
+BENCHMARK_CAPTURE(BM_KeysetHandleRead, json, KeysetFormat::kJson)
+    ->Apply(KeysetSizes);
+
+template <typename P>
+void GetPrimitiveBenchmark(benchmark::State& state,
+                           const KeyTemplate& (*key_template)()) {
+  if (!RegisterTinkConfig(state)) return;
+  auto handle_result = NewLargeKeysetHandle(key_template(), state.range(0));
+  if (!handle_result.ok()) {
+    SkipWithError(state, handle_result.status());
+    return;
+  }
+  const KeysetHandle& handle = *handle_result.ValueOrDie();
+  for (auto _ : state) {
+    auto primitive_result = handle.GetPrimitive<P>();
+    if (!primitive_result.ok()) {
+      SkipWithError(state, primitive_result.status());
+      break;
+    }
+    benchmark::DoNotOptimize(primitive_result);
+  }
+  ReportPeakRss(state);
+}
+
+// BENCHMARK_CAPTURE() takes no template arguments, hence one function per
+// primitive.
+void BM_GetAead(benchmark::State& state,
+                const KeyTemplate& (*key_template)()) {
+  GetPrimitiveBenchmark<Aead>(state, key_template);
+}
+void BM_GetDeterministicAead(benchmark::State& state,
+                             const KeyTemplate& (*key_template)()) {
+  GetPrimitiveBenchmark<DeterministicAead>(state, key_template);
+}
+void BM_GetMac(benchmark::State& state,
+               const KeyTemplate& (*key_template)()) {
+  GetPrimitiveBenchmark<Mac>(state, key_template);
+}
+void BM_GetPublicKeySign(benchmark::State& state,
+                         const KeyTemplate& (*key_template)()) {
+  GetPrimitiveBenchmark<PublicKeySign>(state, key_template);
+}
+
+BENCHMARK_CAPTURE(BM_GetAead, Aes128Gcm, &AeadKeyTemplates::Aes128Gcm)
+    ->Apply(KeysetSizes);
+BENCHMARK_CAPTURE(BM_GetAead, XChaCha20Poly1305,
+                  &AeadKeyTemplates::XChaCha20Poly1305)
+    ->Apply(KeysetSizes);
+BENCHMARK_CAPTURE(BM_GetDeterministicAead, Aes256Siv,
+                  &DeterministicAeadKeyTemplates::Aes256Siv)
+    ->Apply(KeysetSizes);
+BENCHMARK_CAPTURE(BM_GetMac, HmacSha256, &MacKeyTemplates::HmacSha256)
+    ->Apply(KeysetSizes);
+BENCHMARK_CAPTURE(BM_GetPublicKeySign, EcdsaP256,
+                  &SignatureKeyTemplates::EcdsaP256)
+    ->Apply(SmallKeysetSizes);
+BENCHMARK_CAPTURE(BM_GetPublicKeySign, Ed25519,
+                  &SignatureKeyTemplates::Ed25519)
+    ->Apply(SmallKeysetSizes);
+
+// Measures the first call of a fresh primitive of a single key keyset,
+// which includes the lazy initializations of the primitive.  With
+// 'public_keyset', the primitive is the one of the public keyset.
+template <typename P>
+void FirstCallBenchmark(benchmark::State& state,
+                        const KeyTemplate& (*key_template)(),
+                        bool public_keyset) {
+  if (!RegisterTinkConfig(state)) return;
+  auto handle_result = NewKeysetHandle(key_template(), 1);
+  if (!handle_result.ok()) {
+    SkipWithError(state, handle_result.status());
+    return;
+  }
+  std::unique_ptr<KeysetHandle> handle = std::move(handle_result.ValueOrDie());
+  if (public_keyset) {
+    auto public_handle_result = handle->GetPublicKeysetHandle();
+    if (!public_handle_result.ok()) {
+      SkipWithError(state, public_handle_result.status());
+      return;
+    }
+    handle = std::move(public_handle_result.ValueOrDie());
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto primitive_result = handle->GetPrimitive<P>();
+    state.ResumeTiming();
+    if (!primitive_result.ok()) {
+      SkipWithError(state, primitive_result.status());
+      break;
+    }
+    auto result = FirstCall(*primitive_result.ValueOrDie());
+    benchmark::DoNotOptimize(result);
+  }
+  ReportPeakRss(state);
+}
+
+void BM_FirstAeadCall(benchmark::State& state,
+                      const KeyTemplate& (*key_template)()) {
+  FirstCallBenchmark<Aead>(state, key_template, /*public_keyset=*/false);
+}
+void BM_FirstDeterministicAeadCall(benchmark::State& state,
+                                   const KeyTemplate& (*key_template)()) {
+  FirstCallBenchmark<DeterministicAead>(state, key_template,
+                                        /*public_keyset=*/false);
+}
+void BM_FirstMacCall(benchmark::State& state,
+                     const KeyTemplate& (*key_template)()) {
+  FirstCallBenchmark<Mac>(state, key_template, /*public_keyset=*/false);
+}
+void BM_FirstPublicKeySignCall(benchmark::State& state,
+                               const KeyTemplate& (*key_template)()) {
+  FirstCallBenchmark<PublicKeySign>(state, key_template,
+                                    /*public_keyset=*/false);
+}
+void BM_FirstHybridEncryptCall(benchmark::State& state,
+                               const KeyTemplate& (*key_template)()) {
+  FirstCallBenchmark<HybridEncrypt>(state, key_template,
+                                    /*public_keyset=*/true);
+}
+
+BENCHMARK_CAPTURE(BM_FirstAeadCall, Aes128Gcm, &AeadKeyTemplates::Aes128Gcm);
+BENCHMARK_CAPTURE(BM_FirstAeadCall, XChaCha20Poly1305,
+                  &AeadKeyTemplates::XChaCha20Poly1305);
+BENCHMARK_CAPTURE(BM_FirstDeterministicAeadCall, Aes256Siv,
+                  &DeterministicAeadKeyTemplates::Aes256Siv);
+BENCHMARK_CAPTURE(BM_FirstMacCall, HmacSha256, &MacKeyTemplates::HmacSha256);
+BENCHMARK_CAPTURE(BM_FirstPublicKeySignCall, EcdsaP256,
+                  &SignatureKeyTemplates::EcdsaP256);
+BENCHMARK_CAPTURE(BM_FirstPublicKeySignCall, Ed25519,
+                  &SignatureKeyTemplates::Ed25519);
+BENCHMARK_CAPTURE(BM_FirstHybridEncryptCall, EciesP256HkdfHmacSha256Aes128Gcm,
+                  &HybridKeyTemplates::EciesP256HkdfHmacSha256Aes128Gcm);
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,343 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Benchmarks of envelope encryption and of the loading of encrypted keysets
+// against a simulated KMS (see FakeKmsClient::SimulationOptions), so that
+// work on the requests to the KMS (DEK caching, asynchronous requests, ...)
+// can be measured with realistic latencies. Besides the throughput, every
+// benchmark reports the 50th, 99th and 99.9th percentile of the latency of
+// an operation over all threads, in microseconds, the number of requests
+// to the KMS per operation, and the fraction of failed operations.
+
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tink/aead.h"
+#include "tink/aead/aead_config.h"
+#include "tink/aead/aead_key_templates.h"
+#include "tink/aead/kms_envelope_aead.h"
+#include "tink/benchmarks/benchmark_util.h"
+#include "tink/benchmarks/latency_histogram.h"
+#include "tink/binary_keyset_reader.h"
+#include "tink/binary_keyset_writer.h"
+#include "tink/keyset_handle.h"
+#include "tink/util/fake_kms_client.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace benchmarks {
+namespace {
+
+using ::crypto::tink::test::FakeKmsClient;
+
+const char kAssociatedData[] = "associated data";
+constexpr int kMessageSize = 1024;
+// The number of distinct ciphertexts decrypted by the decryption benchmark.
+constexpr int kNumCiphertexts = 1000;
+// The number of keys of the keyset read by the keyset benchmark.
+constexpr int kNumKeysetKeys = 10;
+
+// The simulated KMS deployments.
+enum class Kms {
+  // A KMS in the same region: fast, reliable and without a quota.
+  kRegional,
+  // A KMS in another region, with occasional failures and a quota on the
+  // requests in flight.
+  kRemote,
+};
+
+FakeKmsClient::SimulationOptions SimulationOptionsFor(Kms kms) {
+  FakeKmsClient::SimulationOptions simulation;
+  switch (kms) {
+    case Kms::kRegional:
+      simulation.median_latency = absl::Milliseconds(2);
+      simulation.p99_latency = absl::Milliseconds(10);
+      break;
+    case Kms::kRemote:
+      simulation.median_latency = absl::Milliseconds(30);
+      simulation.p99_latency = absl::Milliseconds(150);
+      simulation.error_rate = 0.001;
+      simulation.max_concurrent_requests = 16;
+      break;
+  }
+  return simulation;
+}
+
+// How KmsEnvelopeAead saves requests to the KMS; the argument "cache" of
+// the envelope benchmarks.
+enum CacheMode {
+  // One request per message.
+  kNoCache = 0,
+  // DEKs are reused for up to 1000 messages, and decrypted DEKs cached.
+  kDekCache = 1,
+  // As kDekCache, but for a local KEK, so that no DEK is reused.
+  kLocalKek = 2,
+};
+
+KmsEnvelopeAead::CacheOptions CacheOptionsFor(int cache_mode) {
+  KmsEnvelopeAead::CacheOptions options;
+  if (cache_mode != kNoCache) {
+    options.max_messages_per_dek = 1000;
+    options.max_dek_age = absl::Minutes(1);
+    options.max_cached_deks = kNumCiphertexts;
+    options.use_local_kek = cache_mode == kLocalKek;
+  }
+  return options;
+}
+
+void CacheModes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgName("cache");
+  for (int cache_mode : {kNoCache, kDekCache, kLocalKek}) {
+    benchmark->Arg(cache_mode);
+  }
+  benchmark->ThreadRange(1, 32)->UseRealTime();
+}
+
+// The primitives a benchmark runs, created once for all threads and all
+// runs of a benchmark, as they would be in a server.
+struct Environment {
+  std::unique_ptr<FakeKmsClient> client;
+  // An Aead of the master key, through the simulated KMS.
+  std::unique_ptr<Aead> kms_aead;
+  std::unique_ptr<Aead> envelope_aead;
+  std::string plaintext;
+  // Ciphertexts of 'envelope_aead', encrypted without the simulation.
+  std::vector<std::string> ciphertexts;
+  // A keyset encrypted with the master key.
+  std::string encrypted_keyset;
+};
+
+util::StatusOr<std::string> WriteEncryptedKeyset(const Aead& master_key_aead) {
+  auto handle_result =
+      NewKeysetHandle(AeadKeyTemplates::Aes128Gcm(), kNumKeysetKeys);
+  if (!handle_result.ok()) return handle_result.status();
+  auto destination = absl::make_unique<std::stringstream>();
+  std::stringstream* encrypted_keyset = destination.get();
+  auto writer_result = BinaryKeysetWriter::New(std::move(destination));
+  if (!writer_result.ok()) return writer_result.status();
+  auto status = handle_result.ValueOrDie()->Write(
+      writer_result.ValueOrDie().get(), master_key_aead);
+  if (!status.ok()) return status;
+  return encrypted_keyset->str();
+}
+
+util::StatusOr<std::unique_ptr<Environment>> NewEnvironment(Kms kms,
+                                                            int cache_mode) {
+  auto status = AeadConfig::Register();
+  if (!status.ok()) return status;
+  auto key_uri_result = FakeKmsClient::CreateFakeKeyUri();
+  if (!key_uri_result.ok()) return key_uri_result.status();
+  const std::string& key_uri = key_uri_result.ValueOrDie();
+  auto environment = absl::make_unique<Environment>();
+  environment->plaintext = RandomMessage(kMessageSize);
+
+  // The ciphertexts and the keyset are made without the simulation, which
+  // keeps the set-up quick.
+  auto setup_client_result = FakeKmsClient::New(key_uri, "");
+  if (!setup_client_result.ok()) return setup_client_result.status();
+  auto setup_aead_result = setup_client_result.ValueOrDie()->GetAead(key_uri);
+  if (!setup_aead_result.ok()) return setup_aead_result.status();
+  auto encrypted_keyset_result =
+      WriteEncryptedKeyset(*setup_aead_result.ValueOrDie());
+  if (!encrypted_keyset_result.ok()) return encrypted_keyset_result.status();
+  environment->encrypted_keyset =
+      std::move(encrypted_keyset_result.ValueOrDie());
+  auto setup_envelope_result =
+      KmsEnvelopeAead::New(AeadKeyTemplates::Aes128Gcm(),
+                           std::move(setup_aead_result.ValueOrDie()),
+                           CacheOptionsFor(cache_mode));
+  if (!setup_envelope_result.ok()) return setup_envelope_result.status();
+  for (int i = 0; i < kNumCiphertexts; i++) {
+    auto ciphertext_result = setup_envelope_result.ValueOrDie()->Encrypt(
+        environment->plaintext, kAssociatedData);
+    if (!ciphertext_result.ok()) return ciphertext_result.status();
+    environment->ciphertexts.push_back(
+        std::move(ciphertext_result.ValueOrDie()));
+  }
+
+  auto client_result =
+      FakeKmsClient::New(key_uri, "", SimulationOptionsFor(kms));
+  if (!client_result.ok()) return client_result.status();
+  environment->client = std::move(client_result.ValueOrDie());
+  auto kms_aead_result = environment->client->GetAead(key_uri);
+  if (!kms_aead_result.ok()) return kms_aead_result.status();
+  environment->kms_aead = std::move(kms_aead_result.ValueOrDie());
+  auto remote_aead_result = environment->client->GetAead(key_uri);
+  if (!remote_aead_result.ok()) return remote_aead_result.status();
+  auto envelope_result = KmsEnvelopeAead::New(
+      AeadKeyTemplates::Aes128Gcm(),
+      std::move(remote_aead_result.ValueOrDie()), CacheOptionsFor(cache_mode));
+  if (!envelope_result.ok()) return envelope_result.status();
+  environment->envelope_aead = std::move(envelope_result.ValueOrDie());
+  return std::move(environment);
+}
+
+// Returns the environment for 'kms' and 'cache_mode', creating it on first
+// use. Environments are never destroyed.
+util::StatusOr<const Environment*> GetEnvironment(Kms kms, int cache_mode) {
+  static absl::Mutex* mutex = new absl::Mutex();
+  static auto* environments =
+      new std::map<std::pair<Kms, int>, std::unique_ptr<Environment>>();
+  absl::MutexLock lock(mutex);
+  std::unique_ptr<Environment>& environment =
+      (*environments)[std::make_pair(kms, cache_mode)];
+  if (environment == nullptr) {
+    auto environment_result = NewEnvironment(kms, cache_mode);
+    if (!environment_result.ok()) return environment_result.status();
+    environment = std::move(environment_result.ValueOrDie());
+  }
+  return environment.get();
+}
+
+// Collects the latencies and errors of the threads of a benchmark run, and
+// reports them from the thread which finishes last, as Google Benchmark
+// sums the counters of all threads.
+class RunReporter {
+ public:
+  // Called by every thread after its loop.
+  void Finish(benchmark::State& state, const LatencyHistogram& latencies,
+              int64_t errors, int64_t kms_requests) {
+    absl::MutexLock lock(&mutex_);
+    latencies_.Add(latencies);
+    errors_ += errors;
+    if (++finished_threads_ < state.threads) return;
+    double operations = static_cast<double>(latencies_.total_count());
+    if (operations > 0) {
+      for (double percentile : {50.0, 99.0, 99.9}) {
+        state.counters[absl::StrCat("p", percentile, "_us")] =
+            benchmark::Counter(latencies_.ValueAtPercentile(percentile) /
+                               1000.0);
+      }
+      state.counters["errors/op"] = benchmark::Counter(errors_ / operations);
+      state.counters["kms_requests/op"] =
+          benchmark::Counter(kms_requests / operations);
+    }
+    latencies_ = LatencyHistogram();
+    errors_ = 0;
+    finished_threads_ = 0;
+  }
+
+ private:
+  absl::Mutex mutex_;
+  LatencyHistogram latencies_ ABSL_GUARDED_BY(mutex_);
+  int64_t errors_ ABSL_GUARDED_BY(mutex_) = 0;
+  int finished_threads_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+// Runs the loop of a benchmark with 'operation', which returns whether it
+// succeeded, and reports its latencies through 'reporter'.
+template <typename Operation>
+void RunOperations(benchmark::State& state, const Environment& environment,
+                   RunReporter* reporter, Operation operation) {
+  // All threads read the counter before the loop starts, and the reporting
+  // thread after all loops have ended.
+  const int64_t kms_requests_at_start = environment.client->num_requests();
+  LatencyHistogram latencies;
+  int64_t errors = 0;
+  int64_t i = state.thread_index;
+  for (auto _ : state) {
+    absl::Time start = absl::Now();
+    if (!operation(i)) errors++;
+    latencies.Record(absl::ToInt64Nanoseconds(absl::Now() - start));
+    i += state.threads;
+  }
+  reporter->Finish(state, latencies, errors,
+                   environment.client->num_requests() - kms_requests_at_start);
+}
+
+void BM_EnvelopeEncrypt(benchmark::State& state, Kms kms) {
+  static RunReporter* reporter = new RunReporter();
+  auto environment_result = GetEnvironment(kms, state.range(0));
+  if (!environment_result.ok()) {
+    SkipWithError(state, environment_result.status());
+    return;
+  }
+  const Environment& environment = *environment_result.ValueOrDie();
+  RunOperations(state, environment, reporter, [&environment](int64_t) {
+    return environment.envelope_aead
+        ->Encrypt(environment.plaintext, kAssociatedData)
+        .ok();
+  });
+  state.SetBytesProcessed(state.iterations() * kMessageSize);
+}
+BENCHMARK_CAPTURE(BM_EnvelopeEncrypt, regional, Kms::kRegional)
+    ->Apply(CacheModes);
+BENCHMARK_CAPTURE(BM_EnvelopeEncrypt, remote, Kms::kRemote)->Apply(CacheModes);
+
+// Decrypts kNumCiphertexts ciphertexts round-robin, so that with kDekCache
+// most of them share a DEK, and with kLocalKek a KEK.
+void BM_EnvelopeDecrypt(benchmark::State& state, Kms kms) {
+  static RunReporter* reporter = new RunReporter();
+  auto environment_result = GetEnvironment(kms, state.range(0));
+  if (!environment_result.ok()) {
+    SkipWithError(state, environment_result.status());
+    return;
+  }
+  const Environment& environment = *environment_result.ValueOrDie();
+  RunOperations(state, environment, reporter, [&environment](int64_t i) {
+    return environment.envelope_aead
+        ->Decrypt(environment.ciphertexts[i % kNumCiphertexts],
+                  kAssociatedData)
+        .ok();
+  });
+  state.SetBytesProcessed(state.iterations() * kMessageSize);
+}
+BENCHMARK_CAPTURE(BM_EnvelopeDecrypt, regional, Kms::kRegional)
+    ->Apply(CacheModes);
+BENCHMARK_CAPTURE(BM_EnvelopeDecrypt, remote, Kms::kRemote)->Apply(CacheModes);
+
+// Reads a keyset of kNumKeysetKeys AES-GCM keys, encrypted with the master
+// key, as a server does at start-up.
+void BM_KeysetHandleRead(benchmark::State& state, Kms kms) {
+  static RunReporter* reporter = new RunReporter();
+  auto environment_result = GetEnvironment(kms, kNoCache);
+  if (!environment_result.ok()) {
+    SkipWithError(state, environment_result.status());
+    return;
+  }
+  const Environment& environment = *environment_result.ValueOrDie();
+  RunOperations(state, environment, reporter, [&environment](int64_t) {
+    auto reader_result = BinaryKeysetReader::New(environment.encrypted_keyset);
+    if (!reader_result.ok()) return false;
+    return KeysetHandle::Read(std::move(reader_result.ValueOrDie()),
+                              *environment.kms_aead)
+        .ok();
+  });
+}
+BENCHMARK_CAPTURE(BM_KeysetHandleRead, regional, Kms::kRegional)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_KeysetHandleRead, remote, Kms::kRemote)
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,112 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/benchmarks/latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace crypto {
+namespace tink {
+namespace benchmarks {
+
+namespace {
+
+// Values below 2^kSubBucketBits get a bucket each; above that, every power
+// of two is split into 2^(kSubBucketBits - 1) buckets.
+constexpr int kSubBucketBits = 7;
+constexpr int kSubBucketHalfCount = 1 << (kSubBucketBits - 1);
+constexpr int kNumBuckets =
+    (64 - kSubBucketBits) * kSubBucketHalfCount + 2 * kSubBucketHalfCount;
+
+int Log2Floor(uint64_t value) {
+  int log = 0;
+  while (value >>= 1) log++;
+  return log;
+}
+
+}  // namespace
+
+LatencyHistogram::LatencyHistogram() : counts_(kNumBuckets, 0) {}
+
+int LatencyHistogram::BucketIndex(int64_t value) {
+  int shift = std::max(0, Log2Floor(value) - (kSubBucketBits - 1));
+  return shift * kSubBucketHalfCount + static_cast<int>(value >> shift);
+}
+
+int64_t LatencyHistogram::HighestValueInBucket(int index) {
+  int shift = std::max(0, index / kSubBucketHalfCount - 1);
+  uint64_t sub_bucket = index - shift * kSubBucketHalfCount;
+  uint64_t highest = ((sub_bucket + 1) << shift) - 1;
+  return static_cast<int64_t>(std::min<uint64_t>(
+      highest, std::numeric_limits<int64_t>::max()));
+}
+
+void LatencyHistogram::Record(int64_t value, int64_t count) {
+  if (count <= 0) return;
+  value = std::max<int64_t>(value, 0);
+  counts_[BucketIndex(value)] += count;
+  if (total_count_ == 0 || value < min_) min_ = value;
+  max_ = std::max(max_, value);
+  total_count_ += count;
+  sum_ += static_cast<double>(value) * count;
+}
+
+void LatencyHistogram::RecordCorrected(int64_t value,
+                                       int64_t expected_interval) {
+  Record(value);
+  if (expected_interval <= 0) return;
+  for (int64_t missed = value - expected_interval; missed >= expected_interval;
+       missed -= expected_interval) {
+    Record(missed);
+  }
+}
+
+void LatencyHistogram::Add(const LatencyHistogram& other) {
+  if (other.total_count_ == 0) return;
+  for (int i = 0; i < kNumBuckets; i++) counts_[i] += other.counts_[i];
+  if (total_count_ == 0 || other.min_ < min_) min_ = other.min_;
+  max_ = std::max(max_, other.max_);
+  total_count_ += other.total_count_;
+  sum_ += other.sum_;
+}
+
+double LatencyHistogram::mean() const {
+  return total_count_ == 0 ? 0 : sum_ / total_count_;
+}
+
+int64_t LatencyHistogram::ValueAtPercentile(double percentile) const {
+  if (total_count_ == 0) return 0;
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+  // Multiplying first keeps e.g. 99.9% of 1000 values at exactly 999.
+  int64_t rank = std::max<int64_t>(
+      1, static_cast<int64_t>(std::ceil(percentile * total_count_ / 100)));
+  int64_t seen = 0;
+  for (int i = 0; i < kNumBuckets; i++) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      // The bucket bound can exceed the values actually recorded.
+      return std::min(std::max(HighestValueInBucket(i), min()), max_);
+    }
+  }
+  return max_;
+}
+
+}  // namespace benchmarks
+}  // namespace tink
+}  // namespace crypto
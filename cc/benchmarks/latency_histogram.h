@@ -0,0 +1,80 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_BENCHMARKS_LATENCY_HISTOGRAM_H_
+#define TINK_BENCHMARKS_LATENCY_HISTOGRAM_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace crypto {
+namespace tink {
+namespace benchmarks {
+
+// A histogram of non-negative values, such as latencies in nanoseconds, in
+// the style of HdrHistogram: values up to 127 are counted exactly, and
+// larger ones in 64 linear buckets per power of two, which bounds the
+// relative error of every reported value by 1/64 over the whole range of
+// int64_t.  Recording is a few instructions and never allocates.
+//
+// Not thread-safe: load generators keep one histogram per thread and Add()
+// them at the end.
+class LatencyHistogram {
+ public:
+  LatencyHistogram();
+
+  // Records 'count' occurrences of 'value'. Negative values count as 0.
+  void Record(int64_t value, int64_t count = 1);
+
+  // Records 'value', measured by a closed-loop generator which meant to
+  // start an operation every 'expected_interval', together with the values
+  // the operations it could not start while waiting would have seen. This
+  // is the coordinated-omission correction of HdrHistogram. Open-loop
+  // generators instead measure from the intended start time, and call
+  // Record().
+  void RecordCorrected(int64_t value, int64_t expected_interval);
+
+  // Adds all values recorded by 'other'.
+  void Add(const LatencyHistogram& other);
+
+  int64_t total_count() const { return total_count_; }
+  int64_t min() const { return total_count_ == 0 ? 0 : min_; }
+  int64_t max() const { return max_; }
+  double mean() const;
+
+  // Returns the smallest recorded value such that 'percentile' percent of
+  // the values are at most that value, up to the precision of the buckets.
+  // 'percentile' is in [0, 100]; returns 0 if the histogram is empty.
+  int64_t ValueAtPercentile(double percentile) const;
+
+ private:
+  static int BucketIndex(int64_t value);
+  // The largest value counted in the bucket at 'index'.
+  static int64_t HighestValueInBucket(int index);
+
+  std::vector<int64_t> counts_;
+  int64_t total_count_ = 0;
+  int64_t min_ = 0;
+  int64_t max_ = 0;
+  // The sum of all values, as a double so that it cannot overflow.
+  double sum_ = 0;
+};
+
+}  // namespace benchmarks
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_BENCHMARKS_LATENCY_HISTOGRAM_H_
@@ -0,0 +1,96 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/benchmarks/latency_histogram.h"
+
+#include <cstdint>
+#include <limits>
+
+#include "gtest/gtest.h"
+
+namespace crypto {
+namespace tink {
+namespace benchmarks {
+namespace {
+
+TEST(LatencyHistogramTest, Empty) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.total_count(), 0);
+  EXPECT_EQ(histogram.min(), 0);
+  EXPECT_EQ(histogram.max(), 0);
+  EXPECT_EQ(histogram.mean(), 0);
+  EXPECT_EQ(histogram.ValueAtPercentile(99), 0);
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+  LatencyHistogram histogram;
+  for (int64_t value = 1; value <= 100; value++) histogram.Record(value);
+  EXPECT_EQ(histogram.total_count(), 100);
+  EXPECT_EQ(histogram.min(), 1);
+  EXPECT_EQ(histogram.max(), 100);
+  EXPECT_DOUBLE_EQ(histogram.mean(), 50.5);
+  EXPECT_EQ(histogram.ValueAtPercentile(0), 1);
+  EXPECT_EQ(histogram.ValueAtPercentile(50), 50);
+  EXPECT_EQ(histogram.ValueAtPercentile(99), 99);
+  EXPECT_EQ(histogram.ValueAtPercentile(100), 100);
+}
+
+TEST(LatencyHistogramTest, LargeValuesWithinRelativeError) {
+  LatencyHistogram histogram;
+  for (int64_t value : {int64_t{1000}, int64_t{123456789},
+                        int64_t{1} << 40,
+                        std::numeric_limits<int64_t>::max() / 3}) {
+    LatencyHistogram single;
+    single.Record(value, 10);
+    single.Record(0);
+    int64_t reported = single.ValueAtPercentile(50);
+    EXPECT_GE(reported, value);
+    EXPECT_LE(reported - value, value / 64);
+    EXPECT_EQ(single.ValueAtPercentile(100), value);
+    histogram.Add(single);
+  }
+  EXPECT_EQ(histogram.total_count(), 44);
+  EXPECT_EQ(histogram.min(), 0);
+  EXPECT_EQ(histogram.max(), std::numeric_limits<int64_t>::max() / 3);
+}
+
+TEST(LatencyHistogramTest, TailPercentiles) {
+  LatencyHistogram histogram;
+  histogram.Record(10, 999);
+  histogram.Record(100000);
+  EXPECT_EQ(histogram.ValueAtPercentile(99.9), 10);
+  EXPECT_EQ(histogram.ValueAtPercentile(99.95), 100000);
+}
+
+TEST(LatencyHistogramTest, RecordCorrected) {
+  LatencyHistogram histogram;
+  // An operation which took 10 intervals hid 9 others, which would have
+  // waited 90, 80, ..., 10.
+  histogram.RecordCorrected(100, 10);
+  EXPECT_EQ(histogram.total_count(), 10);
+  EXPECT_EQ(histogram.min(), 10);
+  EXPECT_EQ(histogram.max(), 100);
+  EXPECT_DOUBLE_EQ(histogram.mean(), 55);
+
+  LatencyHistogram fast;
+  fast.RecordCorrected(5, 10);
+  EXPECT_EQ(fast.total_count(), 1);
+}
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,340 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// An open-loop load test of a keyset, for the tail latencies which the
+// microbenchmarks do not show: contention between threads on shared state,
+// in the random number generator or in the allocator.
+//
+// Every thread starts operations at a fixed rate, whether or not the
+// previous ones have finished, and measures each latency from the time the
+// operation was meant to start. A stalled operation therefore also counts
+// against the operations queued behind it, as it would for the requests of
+// a server, instead of hiding them (coordinated omission). The time from
+// the actual start is reported separately as the service time.
+//
+// The results are written as JSON, to compare Tink versions or settings:
+//
+//   load_test --keyset=keyset.json --operation=aead_encrypt --rate=50000
+//       --threads=16 --duration=30s --output=results.json
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tink/aead.h"
+#include "tink/benchmarks/benchmark_util.h"
+#include "tink/benchmarks/latency_histogram.h"
+#include "tink/binary_keyset_reader.h"
+#include "tink/cleartext_keyset_handle.h"
+#include "tink/config/tink_config.h"
+#include "tink/deterministic_aead.h"
+#include "tink/json_keyset_reader.h"
+#include "tink/keyset_handle.h"
+#include "tink/mac.h"
+#include "tink/public_key_sign.h"
+#include "tink/public_key_verify.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/version.h"
+
+ABSL_FLAG(std::string, keyset, "", "Path of the cleartext keyset to load.");
+ABSL_FLAG(std::string, keyset_format, "json",
+          "Format of the keyset: json or binary.");
+ABSL_FLAG(std::string, operation, "aead_encrypt",
+          "One of aead_encrypt, aead_decrypt, deterministic_aead_encrypt, "
+          "deterministic_aead_decrypt, mac_compute, mac_verify, sign, "
+          "verify.");
+ABSL_FLAG(double, rate, 10000, "Operations per second, over all threads.");
+ABSL_FLAG(int, threads, 8, "Number of threads.");
+ABSL_FLAG(absl::Duration, duration, absl::Seconds(10),
+          "Duration of the measurement, after the warmup.");
+ABSL_FLAG(absl::Duration, warmup, absl::Seconds(2),
+          "Duration of the warmup, which is not measured.");
+ABSL_FLAG(int, message_size, 100, "Size of the messages in bytes.");
+ABSL_FLAG(absl::Duration, spin_wait, absl::Microseconds(200),
+          "The last part of the wait before every operation is spun rather "
+          "than slept, as the scheduler may wake a sleeping thread late. Use "
+          "0 on machines with fewer cores than threads.");
+ABSL_FLAG(std::string, output, "",
+          "Path of the JSON results; empty for standard output.");
+
+namespace crypto {
+namespace tink {
+namespace benchmarks {
+namespace {
+
+const char kAssociatedData[] = "associated data";
+
+using Operation = std::function<util::Status()>;
+
+util::StatusOr<std::unique_ptr<KeysetHandle>> ReadKeyset(
+    const std::string& path, const std::string& format) {
+  auto stream = absl::make_unique<std::ifstream>(path, std::ios::binary);
+  if (!stream->good()) {
+    return util::Status(util::error::NOT_FOUND,
+                        absl::StrCat("Cannot open keyset ", path));
+  }
+  util::StatusOr<std::unique_ptr<KeysetReader>> reader_result =
+      util::Status(util::error::INVALID_ARGUMENT,
+                   absl::StrCat("Unknown keyset format ", format));
+  if (format == "json") {
+    reader_result = JsonKeysetReader::New(std::move(stream));
+  } else if (format == "binary") {
+    reader_result = BinaryKeysetReader::New(std::move(stream));
+  }
+  if (!reader_result.ok()) return reader_result.status();
+  return CleartextKeysetHandle::Read(std::move(reader_result.ValueOrDie()));
+}
+
+// Returns an operation which calls 'function' with the primitive P of
+// 'handle', which it keeps alive.
+template <typename P>
+util::StatusOr<Operation> WithPrimitive(
+    const KeysetHandle& handle,
+    std::function<util::Status(const P&)> function) {
+  auto primitive_result = handle.GetPrimitive<P>();
+  if (!primitive_result.ok()) return primitive_result.status();
+  std::shared_ptr<const P> primitive =
+      std::move(primitive_result.ValueOrDie());
+  return Operation([primitive, function] { return function(*primitive); });
+}
+
+// Returns the operation named 'name' on the keyset of 'handle', with
+// messages of 'message_size' bytes. Inputs of the operations which verify
+// or decrypt are made once, with the same keyset.
+util::StatusOr<Operation> NewOperation(const KeysetHandle& handle,
+                                       const std::string& name,
+                                       int message_size) {
+  const std::string message = RandomMessage(message_size);
+  if (name == "aead_encrypt") {
+    return WithPrimitive<Aead>(handle, [message](const Aead& aead) {
+      return aead.Encrypt(message, kAssociatedData).status();
+    });
+  }
+  if (name == "aead_decrypt") {
+    auto aead_result = handle.GetPrimitive<Aead>();
+    if (!aead_result.ok()) return aead_result.status();
+    auto ciphertext_result =
+        aead_result.ValueOrDie()->Encrypt(message, kAssociatedData);
+    if (!ciphertext_result.ok()) return ciphertext_result.status();
+    std::string ciphertext = std::move(ciphertext_result.ValueOrDie());
+    return WithPrimitive<Aead>(handle, [ciphertext](const Aead& aead) {
+      return aead.Decrypt(ciphertext, kAssociatedData).status();
+    });
+  }
+  if (name == "deterministic_aead_encrypt") {
+    return WithPrimitive<DeterministicAead>(
+        handle, [message](const DeterministicAead& daead) {
+          return daead.EncryptDeterministically(message, kAssociatedData)
+              .status();
+        });
+  }
+  if (name == "deterministic_aead_decrypt") {
+    auto daead_result = handle.GetPrimitive<DeterministicAead>();
+    if (!daead_result.ok()) return daead_result.status();
+    auto ciphertext_result =
+        daead_result.ValueOrDie()->EncryptDeterministically(message,
+                                                            kAssociatedData);
+    if (!ciphertext_result.ok()) return ciphertext_result.status();
+    std::string ciphertext = std::move(ciphertext_result.ValueOrDie());
+    return WithPrimitive<DeterministicAead>(
+        handle, [ciphertext](const DeterministicAead& daead) {
+          return daead.DecryptDeterministically(ciphertext, kAssociatedData)
+              .status();
+        });
+  }
+  if (name == "mac_compute") {
+    return WithPrimitive<Mac>(handle, [message](const Mac& mac) {
+      return mac.ComputeMac(message).status();
+    });
+  }
+  if (name == "mac_verify") {
+    auto mac_result = handle.GetPrimitive<Mac>();
+    if (!mac_result.ok()) return mac_result.status();
+    auto tag_result = mac_result.ValueOrDie()->ComputeMac(message);
+    if (!tag_result.ok()) return tag_result.status();
+    std::string tag = std::move(tag_result.ValueOrDie());
+    return WithPrimitive<Mac>(handle, [tag, message](const Mac& mac) {
+      return mac.VerifyMac(tag, message);
+    });
+  }
+  if (name == "sign") {
+    return WithPrimitive<PublicKeySign>(
+        handle, [message](const PublicKeySign& signer) {
+          return signer.Sign(message).status();
+        });
+  }
+  if (name == "verify") {
+    auto signer_result = handle.GetPrimitive<PublicKeySign>();
+    if (!signer_result.ok()) return signer_result.status();
+    auto signature_result = signer_result.ValueOrDie()->Sign(message);
+    if (!signature_result.ok()) return signature_result.status();
+    std::string signature = std::move(signature_result.ValueOrDie());
+    auto public_handle_result = handle.GetPublicKeysetHandle();
+    if (!public_handle_result.ok()) return public_handle_result.status();
+    return WithPrimitive<PublicKeyVerify>(
+        *public_handle_result.ValueOrDie(),
+        [signature, message](const PublicKeyVerify& verifier) {
+          return verifier.Verify(signature, message);
+        });
+  }
+  return util::Status(util::error::INVALID_ARGUMENT,
+                      absl::StrCat("Unknown operation ", name));
+}
+
+// What one thread measured.
+struct ThreadResult {
+  // From the intended start time of every operation.
+  LatencyHistogram latency;
+  // From the actual start time of every operation.
+  LatencyHistogram service_time;
+  int64_t errors = 0;
+};
+
+// Starts 'operation' every 'interval' from 'start' until 'end', and
+// records the operations meant to start after 'measurement_start'. An
+// operation which cannot start on time starts as soon as possible.
+void RunThread(const Operation& operation, absl::Duration interval,
+               absl::Duration spin_wait, absl::Time start,
+               absl::Time measurement_start, absl::Time end,
+               ThreadResult* result) {
+  for (int64_t i = 0;; i++) {
+    absl::Time intended_start = start + i * interval;
+    if (intended_start >= end) break;
+    absl::Duration wait = intended_start - absl::Now();
+    if (wait > spin_wait) absl::SleepFor(wait - spin_wait);
+    absl::Time actual_start;
+    do {
+      actual_start = absl::Now();
+    } while (actual_start < intended_start);
+
+    util::Status status = operation();
+    absl::Time finish = absl::Now();
+    if (intended_start < measurement_start) continue;
+    if (!status.ok()) result->errors++;
+    result->latency.Record(absl::ToInt64Nanoseconds(finish - intended_start));
+    result->service_time.Record(
+        absl::ToInt64Nanoseconds(finish - actual_start));
+  }
+}
+
+std::string HistogramJson(const LatencyHistogram& histogram) {
+  std::vector<std::string> percentiles;
+  for (double percentile : {50.0, 90.0, 99.0, 99.9, 99.99, 100.0}) {
+    percentiles.push_back(absl::StrFormat(
+        "\"%g\": %d", percentile, histogram.ValueAtPercentile(percentile)));
+  }
+  return absl::StrFormat(
+      "{\"count\": %d, \"min\": %d, \"mean\": %.1f, \"max\": %d, "
+      "\"percentiles\": {%s}}",
+      histogram.total_count(), histogram.min(), histogram.mean(),
+      histogram.max(), absl::StrJoin(percentiles, ", "));
+}
+
+int Run() {
+  const int num_threads = absl::GetFlag(FLAGS_threads);
+  const double rate = absl::GetFlag(FLAGS_rate);
+  if (num_threads < 1 || rate <= 0) {
+    std::cerr << "--threads and --rate must be positive" << std::endl;
+    return 1;
+  }
+  util::Status status = TinkConfig::Register();
+  if (!status.ok()) {
+    std::cerr << status << std::endl;
+    return 1;
+  }
+  auto handle_result = ReadKeyset(absl::GetFlag(FLAGS_keyset),
+                                  absl::GetFlag(FLAGS_keyset_format));
+  if (!handle_result.ok()) {
+    std::cerr << handle_result.status() << std::endl;
+    return 1;
+  }
+  const std::string operation_name = absl::GetFlag(FLAGS_operation);
+  auto operation_result =
+      NewOperation(*handle_result.ValueOrDie(), operation_name,
+                   absl::GetFlag(FLAGS_message_size));
+  if (!operation_result.ok()) {
+    std::cerr << operation_result.status() << std::endl;
+    return 1;
+  }
+  const Operation& operation = operation_result.ValueOrDie();
+
+  // The threads start their operations at evenly spread offsets.
+  const absl::Duration interval = absl::Seconds(num_threads / rate);
+  const absl::Duration duration = absl::GetFlag(FLAGS_duration);
+  const absl::Time start = absl::Now() + absl::Milliseconds(100);
+  const absl::Time measurement_start = start + absl::GetFlag(FLAGS_warmup);
+  const absl::Time end = measurement_start + duration;
+  std::vector<ThreadResult> results(num_threads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; i++) {
+    threads.emplace_back(RunThread, std::cref(operation), interval,
+                         absl::GetFlag(FLAGS_spin_wait),
+                         start + i * interval / num_threads,
+                         measurement_start, end, &results[i]);
+  }
+  for (std::thread& thread : threads) thread.join();
+
+  ThreadResult total;
+  for (const ThreadResult& result : results) {
+    total.latency.Add(result.latency);
+    total.service_time.Add(result.service_time);
+    total.errors += result.errors;
+  }
+  std::string json = absl::StrFormat(
+      "{\"tink_version\": \"%s\", \"operation\": \"%s\", "
+      "\"message_size\": %d, \"threads\": %d, \"target_rate\": %.1f, "
+      "\"achieved_rate\": %.1f, \"duration_s\": %.3f, \"errors\": %d, "
+      "\"latency_ns\": %s, \"service_time_ns\": %s}\n",
+      Version::kTinkVersion, operation_name, absl::GetFlag(FLAGS_message_size),
+      num_threads, rate,
+      total.latency.total_count() / absl::ToDoubleSeconds(duration),
+      absl::ToDoubleSeconds(duration), total.errors,
+      HistogramJson(total.latency), HistogramJson(total.service_time));
+
+  const std::string output = absl::GetFlag(FLAGS_output);
+  if (output.empty()) {
+    std::cout << json;
+  } else {
+    std::ofstream(output) << json;
+  }
+  return total.errors == 0 ? 0 : 2;
+}
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace tink
+}  // namespace crypto
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  return crypto::tink::benchmarks::Run();
+}
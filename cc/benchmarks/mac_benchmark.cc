@@ -0,0 +1,215 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Benchmarks of the Mac and DeterministicAead implementations, on their own
+// and behind their wrappers with keysets of various sizes.
+
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "tink/benchmarks/benchmark_util.h"
+#include "tink/daead/deterministic_aead_config.h"
+#include "tink/daead/deterministic_aead_key_templates.h"
+#include "tink/deterministic_aead.h"
+#include "tink/mac.h"
+#include "tink/mac/mac_config.h"
+#include "tink/mac/mac_key_templates.h"
+#include "tink/subtle/aes_cmac_boringssl.h"
+#include "tink/subtle/aes_siv_boringssl.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/hmac_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace benchmarks {
+namespace {
+
+const char kAssociatedData[] = "associated data";
+
+util::SecretData RandomKey(int size) {
+  return util::SecretDataFromStringView(subtle::Random::GetRandomBytes(size));
+}
+
+const Mac& HmacSha256() {
+  static const Mac* mac =
+      subtle::HmacBoringSsl::New(subtle::HashType::SHA256, 32, RandomKey(32))
+          .ValueOrDie()
+          .release();
+  return *mac;
+}
+
+const Mac& HmacSha512() {
+  static const Mac* mac =
+      subtle::HmacBoringSsl::New(subtle::HashType::SHA512, 64, RandomKey(64))
+          .ValueOrDie()
+          .release();
+  return *mac;
+}
+
+const Mac& AesCmac() {
+  static const Mac* mac =
+      subtle::AesCmacBoringSsl::New(RandomKey(32), 16).ValueOrDie().release();
+  return *mac;
+}
+
+void BM_ComputeMac(benchmark::State& state, const Mac& (*mac)()) {
+  std::string data = RandomMessage(state.range(0));
+  BenchmarkCounters counters(state);
+  for (auto _ : state) {
+    auto tag = mac().ComputeMac(data);
+    benchmark::DoNotOptimize(tag);
+  }
+  counters.Finish(state.range(0));
+}
+
+void BM_VerifyMac(benchmark::State& state, const Mac& (*mac)()) {
+  std::string data = RandomMessage(state.range(0));
+  std::string tag = mac().ComputeMac(data).ValueOrDie();
+  BenchmarkCounters counters(state);
+  for (auto _ : state) {
+    auto status = mac().VerifyMac(tag, data);
+    benchmark::DoNotOptimize(status);
+  }
+  counters.Finish(state.range(0));
+}
+
+#define TINK_MAC_BENCHMARK(name)                                   \
+  BENCHMARK_CAPTURE(BM_ComputeMac, name, &name)                    \
+      ->Apply(MessageSizes)                                        \
+      ->Apply(ThreadCounts);                                       \
+  BENCHMARK_CAPTURE(BM_VerifyMac, name, &name)->Apply(MessageSizes)
+
+TINK_MAC_BENCHMARK(HmacSha256);
+TINK_MAC_BENCHMARK(HmacSha512);
+TINK_MAC_BENCHMARK(AesCmac);
+
+#undef TINK_MAC_BENCHMARK
+
+const DeterministicAead& AesSiv() {
+  static const DeterministicAead* daead =
+      subtle::AesSivBoringSsl::New(RandomKey(64)).ValueOrDie().release();
+  return *daead;
+}
+
+void BM_EncryptDeterministically(benchmark::State& state) {
+  std::string plaintext = RandomMessage(state.range(0));
+  BenchmarkCounters counters(state);
+  for (auto _ : state) {
+    auto ciphertext = AesSiv().EncryptDeterministically(plaintext,
+                                                        kAssociatedData);
+    benchmark::DoNotOptimize(ciphertext);
+  }
+  counters.Finish(state.range(0));
+}
+
+void BM_DecryptDeterministically(benchmark::State& state) {
+  std::string ciphertext =
+      AesSiv()
+          .EncryptDeterministically(RandomMessage(state.range(0)),
+                                    kAssociatedData)
+          .ValueOrDie();
+  BenchmarkCounters counters(state);
+  for (auto _ : state) {
+    auto plaintext =
+        AesSiv().DecryptDeterministically(ciphertext, kAssociatedData);
+    benchmark::DoNotOptimize(plaintext);
+  }
+  counters.Finish(state.range(0));
+}
+
+BENCHMARK(BM_EncryptDeterministically)
+    ->Apply(MessageSizes)
+    ->Apply(ThreadCounts);
+BENCHMARK(BM_DecryptDeterministically)->Apply(MessageSizes);
+
+// Measures the overhead of MacWrapper and PrimitiveSet over HMAC-SHA256,
+// for keysets of state.range(1) keys.
+void BM_WrappedVerifyMac(benchmark::State& state) {
+  auto status = MacConfig::Register();
+  if (!status.ok()) {
+    SkipWithError(state, status);
+    return;
+  }
+  auto handle_result =
+      NewKeysetHandle(MacKeyTemplates::HmacSha256(), state.range(1));
+  if (!handle_result.ok()) {
+    SkipWithError(state, handle_result.status());
+    return;
+  }
+  auto mac_result = handle_result.ValueOrDie()->GetPrimitive<Mac>();
+  if (!mac_result.ok()) {
+    SkipWithError(state, mac_result.status());
+    return;
+  }
+  const Mac& mac = *mac_result.ValueOrDie();
+  std::string data = RandomMessage(state.range(0));
+  std::string tag = mac.ComputeMac(data).ValueOrDie();
+  BenchmarkCounters counters(state);
+  for (auto _ : state) {
+    auto verify_status = mac.VerifyMac(tag, data);
+    benchmark::DoNotOptimize(verify_status);
+  }
+  counters.Finish(state.range(0));
+}
+
+BENCHMARK(BM_WrappedVerifyMac)->Apply(MessageAndKeysetSizes);
+
+// Measures the overhead of DeterministicAeadWrapper over AES-SIV, for
+// keysets of state.range(1) keys.
+void BM_WrappedDecryptDeterministically(benchmark::State& state) {
+  auto status = DeterministicAeadConfig::Register();
+  if (!status.ok()) {
+    SkipWithError(state, status);
+    return;
+  }
+  auto handle_result = NewKeysetHandle(
+      DeterministicAeadKeyTemplates::Aes256Siv(), state.range(1));
+  if (!handle_result.ok()) {
+    SkipWithError(state, handle_result.status());
+    return;
+  }
+  auto daead_result =
+      handle_result.ValueOrDie()->GetPrimitive<DeterministicAead>();
+  if (!daead_result.ok()) {
+    SkipWithError(state, daead_result.status());
+    return;
+  }
+  const DeterministicAead& daead = *daead_result.ValueOrDie();
+  std::string ciphertext =
+      daead
+          .EncryptDeterministically(RandomMessage(state.range(0)),
+                                    kAssociatedData)
+          .ValueOrDie();
+  BenchmarkCounters counters(state);
+  for (auto _ : state) {
+    auto plaintext =
+        daead.DecryptDeterministically(ciphertext, kAssociatedData);
+    benchmark::DoNotOptimize(plaintext);
+  }
+  counters.Finish(state.range(0));
+}
+
+BENCHMARK(BM_WrappedDecryptDeterministically)
+    ->Apply(MessageAndKeysetSizes);
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace tink
+}  // namespace crypto
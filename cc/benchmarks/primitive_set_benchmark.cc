@@ -0,0 +1,162 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Benchmarks of PrimitiveSet lookups, which every wrapper performs on each
+// decryption or verification.
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/const_init.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "benchmark/benchmark.h"
+#include "tink/benchmarks/benchmark_util.h"
+#include "tink/crypto_format.h"
+#include "tink/mac.h"
+#include "tink/primitive_set.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace benchmarks {
+namespace {
+
+using ::google::crypto::tink::KeysetInfo;
+using ::google::crypto::tink::KeyStatusType;
+using ::google::crypto::tink::OutputPrefixType;
+
+// A Mac which does nothing; only its position in the set matters.
+class NullMac : public Mac {
+ public:
+  util::StatusOr<std::string> ComputeMac(
+      absl::string_view data) const override {
+    return std::string();
+  }
+  util::Status VerifyMac(absl::string_view mac,
+                         absl::string_view data) const override {
+    return util::Status::OK;
+  }
+};
+
+struct KeyedPrimitiveSet {
+  std::unique_ptr<PrimitiveSet<Mac>> primitive_set;
+  // Output prefixes of the keys in 'primitive_set'.
+  std::vector<std::string> identifiers;
+};
+
+// Returns a set of 'num_keys' TINK keys.  Sets are created once per
+// configuration and shared by all threads of a benchmark.
+const KeyedPrimitiveSet& GetPrimitiveSet(int num_keys, bool frozen) {
+  static absl::Mutex mutex(absl::kConstInit);
+  static auto* sets =
+      new std::map<std::pair<int, bool>, std::unique_ptr<KeyedPrimitiveSet>>();
+  absl::MutexLock lock(&mutex);
+  std::unique_ptr<KeyedPrimitiveSet>& set = (*sets)[{num_keys, frozen}];
+  if (set != nullptr) return *set;
+  set = absl::make_unique<KeyedPrimitiveSet>();
+  set->primitive_set = absl::make_unique<PrimitiveSet<Mac>>();
+  for (int i = 0; i < num_keys; i++) {
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(OutputPrefixType::TINK);
+    key_info.set_key_id(0x1000 + i);
+    key_info.set_status(KeyStatusType::ENABLED);
+    auto entry =
+        set->primitive_set->AddPrimitive(absl::make_unique<NullMac>(), key_info)
+            .ValueOrDie();
+    set->identifiers.push_back(
+        CryptoFormat::GetOutputPrefix(key_info).ValueOrDie());
+    if (i == num_keys - 1) {
+      set->primitive_set->set_primary(entry).IgnoreError();
+    }
+  }
+  if (frozen) set->primitive_set->Freeze();
+  return *set;
+}
+
+// Looks up every key of a set of state.range(0) keys in turn, with the set
+// frozen (as wrappers use it) or not.
+void BM_GetPrimitives(benchmark::State& state, bool frozen) {
+  const KeyedPrimitiveSet& set = GetPrimitiveSet(state.range(0), frozen);
+  BenchmarkCounters counters(state);
+  size_t i = 0;
+  for (auto _ : state) {
+    auto primitives = set.primitive_set->get_primitives(
+        set.identifiers[i % set.identifiers.size()]);
+    benchmark::DoNotOptimize(primitives);
+    i++;
+  }
+  counters.Finish(0);
+}
+
+void KeysetSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgName("keys")->Arg(1)->Arg(10)->Arg(100)->Arg(1000);
+}
+
+BENCHMARK_CAPTURE(BM_GetPrimitives, Frozen, true)
+    ->Apply(KeysetSizes)
+    ->Apply(ThreadCounts);
+BENCHMARK_CAPTURE(BM_GetPrimitives, NotFrozen, false)
+    ->Apply(KeysetSizes)
+    ->Apply(ThreadCounts);
+
+// Reports the bytes per key (cf. PrimitiveSet::SpaceUsed()) of a set of
+// state.range(0) keys, whose primitives are created right away or lazily.
+// The time is that of adding all keys.
+void BM_BytesPerKey(benchmark::State& state, bool lazy) {
+  int num_keys = state.range(0);
+  size_t space_used = 0;
+  for (auto _ : state) {
+    PrimitiveSet<Mac> primitive_set;
+    for (int i = 0; i < num_keys; i++) {
+      KeysetInfo::KeyInfo key_info;
+      key_info.set_output_prefix_type(OutputPrefixType::TINK);
+      key_info.set_key_id(0x1000 + i);
+      key_info.set_status(KeyStatusType::ENABLED);
+      if (lazy) {
+        primitive_set
+            .AddLazyPrimitive(
+                []() -> util::StatusOr<std::unique_ptr<Mac>> {
+                  return {absl::make_unique<NullMac>()};
+                },
+                key_info)
+            .status()
+            .IgnoreError();
+      } else {
+        primitive_set.AddPrimitive(absl::make_unique<NullMac>(), key_info)
+            .status()
+            .IgnoreError();
+      }
+    }
+    space_used = primitive_set.SpaceUsed();
+  }
+  state.counters["bytes_per_key"] =
+      benchmark::Counter(static_cast<double>(space_used) / num_keys);
+}
+
+BENCHMARK_CAPTURE(BM_BytesPerKey, Eager, false)->Apply(KeysetSizes);
+BENCHMARK_CAPTURE(BM_BytesPerKey, Lazy, true)->Apply(KeysetSizes);
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace tink
+}  // namespace crypto
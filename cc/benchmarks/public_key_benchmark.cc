@@ -0,0 +1,194 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Benchmarks of the public key primitives (hybrid encryption and digital
+// signatures), through keysets with a single key of each kind.
+
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "tink/benchmarks/benchmark_util.h"
+#include "tink/hybrid/hybrid_config.h"
+#include "tink/hybrid/hybrid_key_templates.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/keyset_handle.h"
+#include "tink/public_key_sign.h"
+#include "tink/public_key_verify.h"
+#include "tink/signature/signature_config.h"
+#include "tink/signature/signature_key_templates.h"
+#include "tink/util/status.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace benchmarks {
+namespace {
+
+using ::google::crypto::tink::KeyTemplate;
+
+const char kContextInfo[] = "context info";
+
+// Message sizes for the public key benchmarks, which are dominated by the
+// asymmetric operations.
+void SmallMessageSizes(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ArgName("bytes")->Arg(16)->Arg(1024)->Arg(64 << 10);
+}
+
+// Creates the private and public primitives of a fresh key from
+// 'key_template', or returns false after marking 'state' as failed.
+template <typename PrivatePrimitive, typename PublicPrimitive>
+bool NewPrimitives(benchmark::State& state, const KeyTemplate& key_template,
+                   std::unique_ptr<PrivatePrimitive>* private_primitive,
+                   std::unique_ptr<PublicPrimitive>* public_primitive) {
+  auto handle_result = NewKeysetHandle(key_template, 1);
+  if (!handle_result.ok()) {
+    SkipWithError(state, handle_result.status());
+    return false;
+  }
+  auto private_result =
+      handle_result.ValueOrDie()->GetPrimitive<PrivatePrimitive>();
+  if (!private_result.ok()) {
+    SkipWithError(state, private_result.status());
+    return false;
+  }
+  auto public_handle_result =
+      handle_result.ValueOrDie()->GetPublicKeysetHandle();
+  if (!public_handle_result.ok()) {
+    SkipWithError(state, public_handle_result.status());
+    return false;
+  }
+  auto public_result =
+      public_handle_result.ValueOrDie()->GetPrimitive<PublicPrimitive>();
+  if (!public_result.ok()) {
+    SkipWithError(state, public_result.status());
+    return false;
+  }
+  *private_primitive = std::move(private_result.ValueOrDie());
+  *public_primitive = std::move(public_result.ValueOrDie());
+  return true;
+}
+
+void BM_HybridEncrypt(benchmark::State& state,
+                      const KeyTemplate& (*key_template)()) {
+  auto status = HybridConfig::Register();
+  if (!status.ok()) {
+    SkipWithError(state, status);
+    return;
+  }
+  std::unique_ptr<HybridDecrypt> decrypter;
+  std::unique_ptr<HybridEncrypt> encrypter;
+  if (!NewPrimitives(state, key_template(), &decrypter, &encrypter)) return;
+  std::string plaintext = RandomMessage(state.range(0));
+  BenchmarkCounters counters(state);
+  for (auto _ : state) {
+    auto ciphertext = encrypter->Encrypt(plaintext, kContextInfo);
+    benchmark::DoNotOptimize(ciphertext);
+  }
+  counters.Finish(state.range(0));
+}
+
+void BM_HybridDecrypt(benchmark::State& state,
+                      const KeyTemplate& (*key_template)()) {
+  auto status = HybridConfig::Register();
+  if (!status.ok()) {
+    SkipWithError(state, status);
+    return;
+  }
+  std::unique_ptr<HybridDecrypt> decrypter;
+  std::unique_ptr<HybridEncrypt> encrypter;
+  if (!NewPrimitives(state, key_template(), &decrypter, &encrypter)) return;
+  std::string ciphertext =
+      encrypter->Encrypt(RandomMessage(state.range(0)), kContextInfo)
+          .ValueOrDie();
+  BenchmarkCounters counters(state);
+  for (auto _ : state) {
+    auto plaintext = decrypter->Decrypt(ciphertext, kContextInfo);
+    benchmark::DoNotOptimize(plaintext);
+  }
+  counters.Finish(state.range(0));
+}
+
+#define TINK_HYBRID_BENCHMARK(name)                                    \
+  BENCHMARK_CAPTURE(BM_HybridEncrypt, name, &HybridKeyTemplates::name) \
+      ->Apply(SmallMessageSizes);                                      \
+  BENCHMARK_CAPTURE(BM_HybridDecrypt, name, &HybridKeyTemplates::name) \
+      ->Apply(SmallMessageSizes)
+
+TINK_HYBRID_BENCHMARK(EciesP256HkdfHmacSha256Aes128Gcm);
+TINK_HYBRID_BENCHMARK(EciesP256HkdfHmacSha256Aes128GcmCompressedWithoutPrefix);
+TINK_HYBRID_BENCHMARK(EciesX25519HkdfHmacSha256XChaCha20Poly1305);
+
+#undef TINK_HYBRID_BENCHMARK
+
+void BM_Sign(benchmark::State& state, const KeyTemplate& (*key_template)()) {
+  auto status = SignatureConfig::Register();
+  if (!status.ok()) {
+    SkipWithError(state, status);
+    return;
+  }
+  std::unique_ptr<PublicKeySign> signer;
+  std::unique_ptr<PublicKeyVerify> verifier;
+  if (!NewPrimitives(state, key_template(), &signer, &verifier)) return;
+  std::string data = RandomMessage(state.range(0));
+  BenchmarkCounters counters(state);
+  for (auto _ : state) {
+    auto signature = signer->Sign(data);
+    benchmark::DoNotOptimize(signature);
+  }
+  counters.Finish(state.range(0));
+}
+
+void BM_Verify(benchmark::State& state,
+               const KeyTemplate& (*key_template)()) {
+  auto status = SignatureConfig::Register();
+  if (!status.ok()) {
+    SkipWithError(state, status);
+    return;
+  }
+  std::unique_ptr<PublicKeySign> signer;
+  std::unique_ptr<PublicKeyVerify> verifier;
+  if (!NewPrimitives(state, key_template(), &signer, &verifier)) return;
+  std::string data = RandomMessage(state.range(0));
+  std::string signature = signer->Sign(data).ValueOrDie();
+  BenchmarkCounters counters(state);
+  for (auto _ : state) {
+    auto verify_status = verifier->Verify(signature, data);
+    benchmark::DoNotOptimize(verify_status);
+  }
+  counters.Finish(state.range(0));
+}
+
+#define TINK_SIGNATURE_BENCHMARK(name)                                \
+  BENCHMARK_CAPTURE(BM_Sign, name, &SignatureKeyTemplates::name)      \
+      ->Apply(SmallMessageSizes);                                     \
+  BENCHMARK_CAPTURE(BM_Verify, name, &SignatureKeyTemplates::name)    \
+      ->Apply(SmallMessageSizes)
+
+TINK_SIGNATURE_BENCHMARK(EcdsaP256);
+TINK_SIGNATURE_BENCHMARK(EcdsaP384);
+TINK_SIGNATURE_BENCHMARK(EcdsaP256Ieee);
+TINK_SIGNATURE_BENCHMARK(Ed25519);
+TINK_SIGNATURE_BENCHMARK(RsaSsaPkcs13072Sha256F4);
+TINK_SIGNATURE_BENCHMARK(RsaSsaPss3072Sha256Sha256F4);
+
+#undef TINK_SIGNATURE_BENCHMARK
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,336 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/columnar/column_encryption.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "absl/base/internal/endian.h"
+#include "absl/strings/str_cat.h"
+#include "tink/internal/thread_pool.h"
+#include "tink/subtle/subtle_util.h"
+
+namespace crypto {
+namespace tink {
+namespace columnar {
+
+namespace {
+
+// The plaintext of a page is the number n of its values as a uint64, then
+// the n + 1 offsets of the values relative to the first one as uint64s,
+// then the data of the values; all integers are little-endian.
+constexpr int kIntSize = sizeof(uint64_t);
+
+// The output of one page of a column processed value by value, with
+// offsets starting at 0.
+struct Slice {
+  std::string data;
+  std::vector<int64_t> offsets;
+  util::Status status;
+};
+
+util::Status ValidateColumn(ColumnView column) {
+  if (column.offsets.empty()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "A column needs at least one offset");
+  }
+  for (size_t i = 0; i < column.offsets.size(); i++) {
+    int64_t previous = i == 0 ? 0 : column.offsets[i - 1];
+    if (column.offsets[i] < previous ||
+        static_cast<size_t>(column.offsets[i]) > column.data.size()) {
+      return util::Status(
+          util::error::INVALID_ARGUMENT,
+          absl::StrCat("Invalid offset ", column.offsets[i], " at position ",
+                       i, " for column data of ", column.data.size(),
+                       " bytes"));
+    }
+  }
+  return util::Status::OK;
+}
+
+// Returns the index of the first value of every page of 'offsets', followed
+// by the number of values.  Every page but the last one of an empty column
+// holds at least one value.
+util::StatusOr<std::vector<int64_t>> PageBoundaries(
+    absl::Span<const int64_t> offsets, int64_t page_size) {
+  if (page_size <= 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "The page size must be positive");
+  }
+  const int64_t num_values = offsets.size() - 1;
+  std::vector<int64_t> boundaries = {0};
+  int64_t begin = 0;
+  while (begin < num_values) {
+    int64_t limit = offsets[begin] + std::min(
+        page_size, std::numeric_limits<int64_t>::max() - offsets[begin]);
+    int64_t end = std::upper_bound(offsets.begin() + begin + 1, offsets.end(),
+                                   limit) -
+                  offsets.begin() - 1;
+    begin = std::max(end, begin + 1);
+    boundaries.push_back(begin);
+  }
+  if (num_values == 0) boundaries.push_back(0);
+  if (boundaries.size() - 1 > std::numeric_limits<int>::max()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Too many pages");
+  }
+  return std::move(boundaries);
+}
+
+// Calls 'func'(i) for every page i in [0, page_count), on up to
+// 'num_threads' threads (0 means one per core).
+void ForEachPage(int page_count, int num_threads,
+                 const std::function<void(int)>& func) {
+  if (num_threads <= 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  internal::ThreadPool pool(std::min(num_threads, page_count) - 1);
+  pool.ParallelFor(page_count, func);
+}
+
+// Joins 'slices' into one column with offsets starting at 0.
+util::Status JoinSlices(const std::vector<Slice>& slices, std::string* data,
+                        std::vector<int64_t>* offsets) {
+  size_t total_size = 0;
+  size_t num_values = 0;
+  for (const Slice& slice : slices) {
+    if (!slice.status.ok()) return slice.status;
+    total_size += slice.data.size();
+    num_values += slice.offsets.size() - 1;
+  }
+  subtle::ResizeStringUninitialized(data, total_size);
+  offsets->clear();
+  offsets->reserve(num_values + 1);
+  offsets->push_back(0);
+  int64_t base = 0;
+  for (const Slice& slice : slices) {
+    std::copy(slice.data.begin(), slice.data.end(), data->begin() + base);
+    for (size_t i = 1; i < slice.offsets.size(); i++) {
+      offsets->push_back(base + slice.offsets[i]);
+    }
+    base += slice.data.size();
+  }
+  return util::Status::OK;
+}
+
+// Returns the associated data of page 'page', which binds the page to its
+// position, and the column to its number of pages.
+std::string PageAssociatedData(absl::string_view associated_data,
+                               int64_t page, int64_t page_count) {
+  std::string page_associated_data(associated_data);
+  char buffer[2 * kIntSize];
+  absl::big_endian::Store64(buffer, page);
+  absl::big_endian::Store64(buffer + kIntSize, page_count);
+  page_associated_data.append(buffer, sizeof(buffer));
+  return page_associated_data;
+}
+
+// Processes the values of every page of 'column' with 'process', on up to
+// 'num_threads' threads, and joins the results.
+util::Status ProcessValuesByPage(
+    ColumnView column, const ColumnOptions& options,
+    const std::function<util::Status(ColumnView, Slice*)>& process,
+    std::string* output_data, std::vector<int64_t>* output_offsets) {
+  util::Status status = ValidateColumn(column);
+  if (!status.ok()) return status;
+  auto boundaries_result = PageBoundaries(column.offsets, options.page_size);
+  if (!boundaries_result.ok()) return boundaries_result.status();
+  const std::vector<int64_t>& boundaries = boundaries_result.ValueOrDie();
+  const int page_count = boundaries.size() - 1;
+  std::vector<Slice> slices(page_count);
+  ForEachPage(page_count, options.num_threads, [&](int page) {
+    ColumnView page_column = {
+        column.offsets.subspan(boundaries[page],
+                               boundaries[page + 1] - boundaries[page] + 1),
+        column.data};
+    slices[page].status = process(page_column, &slices[page]);
+  });
+  return JoinSlices(slices, output_data, output_offsets);
+}
+
+}  // namespace
+
+util::StatusOr<EncryptedColumn> EncryptColumn(
+    const Aead& aead, ColumnView column, absl::string_view associated_data,
+    const ColumnOptions& options) {
+  util::Status status = ValidateColumn(column);
+  if (!status.ok()) return status;
+  auto boundaries_result = PageBoundaries(column.offsets, options.page_size);
+  if (!boundaries_result.ok()) return boundaries_result.status();
+  EncryptedColumn encrypted;
+  encrypted.page_first_values = std::move(boundaries_result.ValueOrDie());
+  const std::vector<int64_t>& boundaries = encrypted.page_first_values;
+  const int page_count = boundaries.size() - 1;
+
+  std::vector<std::string> ciphertexts(page_count);
+  std::vector<util::Status> statuses(page_count);
+  ForEachPage(page_count, options.num_threads, [&](int page) {
+    const int64_t begin = boundaries[page];
+    const int64_t end = boundaries[page + 1];
+    const int64_t data_begin = column.offsets[begin];
+    const int64_t data_size = column.offsets[end] - data_begin;
+    std::string plaintext;
+    subtle::ResizeStringUninitialized(
+        &plaintext, (end - begin + 2) * kIntSize + data_size);
+    char* p = &plaintext[0];
+    absl::little_endian::Store64(p, end - begin);
+    for (int64_t i = begin; i <= end; i++) {
+      p += kIntSize;
+      absl::little_endian::Store64(p, column.offsets[i] - data_begin);
+    }
+    std::copy_n(column.data.data() + data_begin, data_size, p + kIntSize);
+    auto encrypt_result = aead.Encrypt(
+        plaintext, PageAssociatedData(associated_data, page, page_count));
+    if (!encrypt_result.ok()) {
+      statuses[page] = encrypt_result.status();
+      return;
+    }
+    ciphertexts[page] = std::move(encrypt_result.ValueOrDie());
+  });
+
+  size_t total_size = 0;
+  for (int page = 0; page < page_count; page++) {
+    if (!statuses[page].ok()) return statuses[page];
+    total_size += ciphertexts[page].size();
+  }
+  encrypted.ciphertext.reserve(total_size);
+  encrypted.page_offsets.reserve(page_count + 1);
+  encrypted.page_offsets.push_back(0);
+  for (const std::string& ciphertext : ciphertexts) {
+    encrypted.ciphertext.append(ciphertext);
+    encrypted.page_offsets.push_back(encrypted.ciphertext.size());
+  }
+  return std::move(encrypted);
+}
+
+util::Status DecryptPage(const Aead& aead, const EncryptedColumn& column,
+                         absl::string_view associated_data, int64_t page,
+                         DecryptedPage* output) {
+  const int64_t page_count = column.page_count();
+  if (page_count < 1 ||
+      column.page_first_values.size() != column.page_offsets.size()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid encrypted column");
+  }
+  if (page < 0 || page >= page_count) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        absl::StrCat("Page ", page, " out of range"));
+  }
+  const int64_t begin = column.page_offsets[page];
+  const int64_t end = column.page_offsets[page + 1];
+  if (begin < 0 || end < begin ||
+      static_cast<size_t>(end) > column.ciphertext.size()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        absl::StrCat("Invalid offsets for page ", page));
+  }
+  auto decrypt_result = aead.Decrypt(
+      absl::string_view(column.ciphertext).substr(begin, end - begin),
+      PageAssociatedData(associated_data, page, page_count));
+  if (!decrypt_result.ok()) return decrypt_result.status();
+  output->plaintext_ = std::move(decrypt_result.ValueOrDie());
+  output->offsets_.clear();
+  output->data_ = absl::string_view();
+
+  absl::string_view plaintext = output->plaintext_;
+  const int64_t num_values =
+      column.page_first_values[page + 1] - column.page_first_values[page];
+  // The plaintext is authenticated, but its value count must also match the
+  // unauthenticated page_first_values.
+  if (plaintext.size() < kIntSize ||
+      absl::little_endian::Load64(plaintext.data()) !=
+          static_cast<uint64_t>(num_values) ||
+      static_cast<uint64_t>(num_values) >
+          (plaintext.size() - kIntSize) / kIntSize - 1) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        absl::StrCat("Invalid plaintext of page ", page));
+  }
+  absl::string_view data = plaintext.substr((num_values + 2) * kIntSize);
+  output->offsets_.reserve(num_values + 1);
+  int64_t previous = 0;
+  for (int64_t i = 0; i <= num_values; i++) {
+    int64_t offset = absl::little_endian::Load64(
+        plaintext.data() + (i + 1) * kIntSize);
+    if (offset < previous || static_cast<uint64_t>(offset) > data.size()) {
+      output->offsets_.clear();
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          absl::StrCat("Invalid plaintext of page ", page));
+    }
+    output->offsets_.push_back(offset);
+    previous = offset;
+  }
+  output->data_ = data;
+  return util::Status::OK;
+}
+
+util::Status DecryptColumn(const Aead& aead, const EncryptedColumn& column,
+                           absl::string_view associated_data,
+                           const ColumnOptions& options, std::string* data,
+                           std::vector<int64_t>* offsets) {
+  const int64_t page_count = column.page_count();
+  if (page_count < 1 || page_count > std::numeric_limits<int>::max()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid encrypted column");
+  }
+  std::vector<Slice> slices(page_count);
+  ForEachPage(page_count, options.num_threads, [&](int page) {
+    DecryptedPage decrypted;
+    slices[page].status =
+        DecryptPage(aead, column, associated_data, page, &decrypted);
+    if (!slices[page].status.ok()) return;
+    ColumnView page_column = decrypted.column();
+    slices[page].data = std::string(
+        page_column.data.substr(0, page_column.offsets.back()));
+    slices[page].offsets.assign(page_column.offsets.begin(),
+                                page_column.offsets.end());
+  });
+  return JoinSlices(slices, data, offsets);
+}
+
+util::Status EncryptDeterministicColumn(
+    const DeterministicAead& daead, ColumnView column,
+    absl::string_view associated_data, const ColumnOptions& options,
+    std::string* ciphertext_data, std::vector<int64_t>* ciphertext_offsets) {
+  auto process = [&](ColumnView page_column, Slice* slice) {
+    // EncryptDeterministicallyBatch() lets the primitive share work between
+    // the values of the page.
+    return daead.EncryptDeterministicallyBatch(
+        page_column.offsets, page_column.data, associated_data, &slice->data,
+        &slice->offsets);
+  };
+  return ProcessValuesByPage(column, options, process, ciphertext_data,
+                             ciphertext_offsets);
+}
+
+util::Status DecryptDeterministicColumn(
+    const DeterministicAead& daead, ColumnView column,
+    absl::string_view associated_data, const ColumnOptions& options,
+    std::string* plaintext_data, std::vector<int64_t>* plaintext_offsets) {
+  auto process = [&](ColumnView page_column, Slice* slice) {
+    return daead.DecryptDeterministicallyBatch(
+        page_column.offsets, page_column.data, associated_data, &slice->data,
+        &slice->offsets);
+  };
+  return ProcessValuesByPage(column, options, process, plaintext_data,
+                             plaintext_offsets);
+}
+
+}  // namespace columnar
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,136 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_COLUMNAR_COLUMN_ENCRYPTION_H_
+#define TINK_COLUMNAR_COLUMN_ENCRYPTION_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/aead.h"
+#include "tink/deterministic_aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace columnar {
+
+// Encryption of whole columns of variable-length binary values, as used
+// by columnar formats (e.g. Parquet or Arrow), instead of one value at a
+// time.
+//
+// Columns use the layout of Arrow (large) binary arrays: n + 1
+// non-decreasing offsets into one data buffer, where value i is
+// data[offsets[i], offsets[i + 1]).  The values are grouped into pages of
+// consecutive values, which are processed in parallel.
+struct ColumnView {
+  absl::Span<const int64_t> offsets;
+  absl::string_view data;
+};
+
+struct ColumnOptions {
+  // Values are grouped into pages of at most 'page_size' bytes of data,
+  // unless a single value is larger.
+  int64_t page_size = 1 << 20;
+  // The number of threads, including the calling one, that process the
+  // pages; 0 means one per core.
+  int num_threads = 1;
+};
+
+// A column encrypted page by page with an Aead: each page is one AEAD
+// ciphertext, with its own nonce, whose associated data binds it to its
+// position in the column.  This is for payload columns, whose values are
+// only read, and which should not reveal which values are equal.
+struct EncryptedColumn {
+  // The page ciphertexts, one after the other: page i is
+  // ciphertext[page_offsets[i], page_offsets[i + 1]).
+  std::string ciphertext;
+  std::vector<int64_t> page_offsets;
+  // The index of the first value of every page, followed by the number of
+  // values.
+  std::vector<int64_t> page_first_values;
+
+  int64_t page_count() const { return page_offsets.size() - 1; }
+};
+
+// Encrypts 'column' with 'aead' and 'associated_data'.  A column always
+// has at least one page, so that the number of values is authenticated
+// even if it is 0.
+crypto::tink::util::StatusOr<EncryptedColumn> EncryptColumn(
+    const Aead& aead, ColumnView column, absl::string_view associated_data,
+    const ColumnOptions& options = ColumnOptions());
+
+// The values of one decrypted page.  Passing the same DecryptedPage to
+// DecryptPage() for every page reuses its buffers, so that reading a
+// column page by page does not allocate per value.
+class DecryptedPage {
+ public:
+  int64_t size() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+  absl::string_view value(int64_t i) const {
+    return data_.substr(offsets_[i], offsets_[i + 1] - offsets_[i]);
+  }
+  // The values in the layout of ColumnView, with offsets starting at 0.
+  ColumnView column() const { return {offsets_, data_}; }
+
+ private:
+  friend crypto::tink::util::Status DecryptPage(
+      const Aead& aead, const EncryptedColumn& column,
+      absl::string_view associated_data, int64_t page, DecryptedPage* output);
+
+  std::string plaintext_;
+  std::vector<int64_t> offsets_;
+  absl::string_view data_;
+};
+
+// Decrypts page 'page' of 'column' into '*output'.
+crypto::tink::util::Status DecryptPage(const Aead& aead,
+                                       const EncryptedColumn& column,
+                                       absl::string_view associated_data,
+                                       int64_t page, DecryptedPage* output);
+
+// Decrypts all pages of 'column', in parallel, into one column with
+// offsets starting at 0.
+crypto::tink::util::Status DecryptColumn(
+    const Aead& aead, const EncryptedColumn& column,
+    absl::string_view associated_data, const ColumnOptions& options,
+    std::string* data, std::vector<int64_t>* offsets);
+
+// Encrypts every value of 'column' with 'daead' and 'associated_data', so
+// that equal values have equal ciphertexts, e.g. for join keys.  The
+// ciphertexts are written as a column with offsets starting at 0.  The
+// pages are encrypted in parallel, each with
+// DeterministicAead::EncryptDeterministicallyBatch().
+crypto::tink::util::Status EncryptDeterministicColumn(
+    const DeterministicAead& daead, ColumnView column,
+    absl::string_view associated_data, const ColumnOptions& options,
+    std::string* ciphertext_data, std::vector<int64_t>* ciphertext_offsets);
+
+// Decrypts the values of a column from EncryptDeterministicColumn().
+crypto::tink::util::Status DecryptDeterministicColumn(
+    const DeterministicAead& daead, ColumnView column,
+    absl::string_view associated_data, const ColumnOptions& options,
+    std::string* plaintext_data, std::vector<int64_t>* plaintext_offsets);
+
+}  // namespace columnar
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_COLUMNAR_COLUMN_ENCRYPTION_H_
@@ -0,0 +1,246 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/columnar/column_encryption.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/aes_siv_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace columnar {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::testing::ElementsAre;
+using ::testing::Not;
+
+std::unique_ptr<Aead> NewAead() {
+  auto aead_result = subtle::AesGcmBoringSsl::New(
+      util::SecretDataFromStringView(subtle::Random::GetRandomBytes(16)));
+  EXPECT_THAT(aead_result.status(), IsOk());
+  return std::move(aead_result.ValueOrDie());
+}
+
+std::unique_ptr<DeterministicAead> NewDaead() {
+  auto daead_result = subtle::AesSivBoringSsl::New(
+      util::SecretDataFromStringView(subtle::Random::GetRandomBytes(64)));
+  EXPECT_THAT(daead_result.status(), IsOk());
+  return std::move(daead_result.ValueOrDie());
+}
+
+// A column of 'n' values of varying sizes.
+struct TestColumn {
+  explicit TestColumn(int n) : offsets(1, 0) {
+    for (int i = 0; i < n; i++) {
+      values.push_back(absl::StrCat("value ", i * 7));
+      data.append(values.back());
+      offsets.push_back(data.size());
+    }
+  }
+
+  ColumnView view() const { return {offsets, data}; }
+
+  std::vector<std::string> values;
+  std::string data;
+  std::vector<int64_t> offsets;
+};
+
+class ColumnEncryptionThreadsTest : public ::testing::TestWithParam<int> {};
+
+TEST_P(ColumnEncryptionThreadsTest, EncryptDecrypt) {
+  std::unique_ptr<Aead> aead = NewAead();
+  TestColumn column(5000);
+  ColumnOptions options;
+  options.page_size = 1000;
+  options.num_threads = GetParam();
+
+  auto encrypt_result = EncryptColumn(*aead, column.view(), "ad", options);
+  ASSERT_THAT(encrypt_result.status(), IsOk());
+  const EncryptedColumn& encrypted = encrypt_result.ValueOrDie();
+  EXPECT_GT(encrypted.page_count(), 1);
+  EXPECT_EQ(5000, encrypted.page_first_values.back());
+  EXPECT_EQ(encrypted.ciphertext.size(), encrypted.page_offsets.back());
+
+  std::string data;
+  std::vector<int64_t> offsets;
+  ASSERT_THAT(
+      DecryptColumn(*aead, encrypted, "ad", options, &data, &offsets), IsOk());
+  EXPECT_EQ(column.data, data);
+  EXPECT_EQ(column.offsets, offsets);
+}
+
+INSTANTIATE_TEST_SUITE_P(NumThreads, ColumnEncryptionThreadsTest,
+                         ::testing::Values(0, 1, 3));
+
+TEST(ColumnEncryptionTest, DecryptPageByPage) {
+  std::unique_ptr<Aead> aead = NewAead();
+  TestColumn column(2000);
+  ColumnOptions options;
+  options.page_size = 500;
+  auto encrypt_result = EncryptColumn(*aead, column.view(), "ad", options);
+  ASSERT_THAT(encrypt_result.status(), IsOk());
+  const EncryptedColumn& encrypted = encrypt_result.ValueOrDie();
+
+  DecryptedPage page;
+  int64_t value = 0;
+  for (int64_t i = 0; i < encrypted.page_count(); i++) {
+    ASSERT_THAT(DecryptPage(*aead, encrypted, "ad", i, &page), IsOk());
+    EXPECT_EQ(encrypted.page_first_values[i], value);
+    EXPECT_LE(page.column().offsets.back(), options.page_size);
+    for (int64_t j = 0; j < page.size(); j++, value++) {
+      EXPECT_EQ(column.values[value], page.value(j));
+    }
+  }
+  EXPECT_EQ(2000, value);
+}
+
+TEST(ColumnEncryptionTest, LargeValuesGetTheirOwnPage) {
+  std::unique_ptr<Aead> aead = NewAead();
+  std::string data = std::string(10, 'a') + std::string(20, 'b');
+  std::vector<int64_t> offsets = {0, 10, 30};
+  ColumnOptions options;
+  options.page_size = 5;
+  auto encrypt_result = EncryptColumn(*aead, {offsets, data}, "ad", options);
+  ASSERT_THAT(encrypt_result.status(), IsOk());
+  EXPECT_THAT(encrypt_result.ValueOrDie().page_first_values,
+              ElementsAre(0, 1, 2));
+}
+
+TEST(ColumnEncryptionTest, EmptyColumn) {
+  std::unique_ptr<Aead> aead = NewAead();
+  std::vector<int64_t> offsets = {0};
+  auto encrypt_result = EncryptColumn(*aead, {offsets, ""}, "ad");
+  ASSERT_THAT(encrypt_result.status(), IsOk());
+  const EncryptedColumn& encrypted = encrypt_result.ValueOrDie();
+  EXPECT_EQ(1, encrypted.page_count());
+
+  DecryptedPage page;
+  ASSERT_THAT(DecryptPage(*aead, encrypted, "ad", 0, &page), IsOk());
+  EXPECT_EQ(0, page.size());
+}
+
+TEST(ColumnEncryptionTest, InvalidColumns) {
+  std::unique_ptr<Aead> aead = NewAead();
+  EXPECT_THAT(EncryptColumn(*aead, {{}, ""}, "ad").status(), Not(IsOk()));
+  std::vector<int64_t> decreasing = {0, 3, 2};
+  EXPECT_THAT(EncryptColumn(*aead, {decreasing, "abc"}, "ad").status(),
+              Not(IsOk()));
+  std::vector<int64_t> too_large = {0, 4};
+  EXPECT_THAT(EncryptColumn(*aead, {too_large, "abc"}, "ad").status(),
+              Not(IsOk()));
+  std::vector<int64_t> offsets = {0, 3};
+  ColumnOptions options;
+  options.page_size = 0;
+  EXPECT_THAT(EncryptColumn(*aead, {offsets, "abc"}, "ad", options).status(),
+              Not(IsOk()));
+}
+
+TEST(ColumnEncryptionTest, PagesAreBoundToTheirPosition) {
+  std::unique_ptr<Aead> aead = NewAead();
+  TestColumn column(100);
+  ColumnOptions options;
+  options.page_size = 100;
+  auto encrypt_result = EncryptColumn(*aead, column.view(), "ad", options);
+  ASSERT_THAT(encrypt_result.status(), IsOk());
+  const EncryptedColumn& encrypted = encrypt_result.ValueOrDie();
+  ASSERT_GT(encrypted.page_count(), 2);
+
+  std::string data;
+  std::vector<int64_t> offsets;
+  EXPECT_THAT(DecryptColumn(*aead, encrypted, "other ad", options, &data,
+                            &offsets),
+              Not(IsOk()));
+
+  // Swapping the first two pages.
+  EncryptedColumn swapped = encrypted;
+  std::string page0 = encrypted.ciphertext.substr(0, encrypted.page_offsets[1]);
+  std::string page1 = encrypted.ciphertext.substr(
+      encrypted.page_offsets[1],
+      encrypted.page_offsets[2] - encrypted.page_offsets[1]);
+  swapped.ciphertext.replace(0, encrypted.page_offsets[2], page1 + page0);
+  swapped.page_offsets[1] = page1.size();
+  EXPECT_THAT(
+      DecryptColumn(*aead, swapped, "ad", options, &data, &offsets),
+      Not(IsOk()));
+
+  // Dropping the last page.
+  EncryptedColumn truncated = encrypted;
+  truncated.page_offsets.pop_back();
+  truncated.page_first_values.pop_back();
+  EXPECT_THAT(
+      DecryptColumn(*aead, truncated, "ad", options, &data, &offsets),
+      Not(IsOk()));
+
+  // Moving a value from one page to the next one.
+  EncryptedColumn moved = encrypted;
+  moved.page_first_values[1]--;
+  DecryptedPage page;
+  EXPECT_THAT(DecryptPage(*aead, moved, "ad", 0, &page), Not(IsOk()));
+}
+
+TEST(ColumnEncryptionTest, DeterministicColumn) {
+  std::unique_ptr<DeterministicAead> daead = NewDaead();
+  TestColumn column(3000);
+  ColumnOptions options;
+  options.page_size = 2000;
+  options.num_threads = 4;
+
+  std::string ciphertext_data;
+  std::vector<int64_t> ciphertext_offsets;
+  ASSERT_THAT(EncryptDeterministicColumn(*daead, column.view(), "ad", options,
+                                         &ciphertext_data, &ciphertext_offsets),
+              IsOk());
+  ASSERT_EQ(column.offsets.size(), ciphertext_offsets.size());
+  for (int i : {0, 1, 1500, 2999}) {
+    EXPECT_EQ(daead->EncryptDeterministically(column.values[i], "ad")
+                  .ValueOrDie(),
+              ciphertext_data.substr(
+                  ciphertext_offsets[i],
+                  ciphertext_offsets[i + 1] - ciphertext_offsets[i]));
+  }
+
+  std::string data;
+  std::vector<int64_t> offsets;
+  ASSERT_THAT(
+      DecryptDeterministicColumn(*daead, {ciphertext_offsets, ciphertext_data},
+                                 "ad", options, &data, &offsets),
+      IsOk());
+  EXPECT_EQ(column.data, data);
+  EXPECT_EQ(column.offsets, offsets);
+
+  ciphertext_data.back() ^= 1;
+  EXPECT_THAT(
+      DecryptDeterministicColumn(*daead, {ciphertext_offsets, ciphertext_data},
+                                 "ad", options, &data, &offsets),
+      Not(IsOk()));
+}
+
+}  // namespace
+}  // namespace columnar
+}  // namespace tink
+}  // namespace crypto
@@ -16,13 +16,27 @@
 
 #include "tink/config/tink_config.h"
 
+#include <typeinfo>
+
+#include "tink/aead.h"
+#include "tink/aead/aead_config.h"
 #include "tink/config.h"
 #include "tink/daead/deterministic_aead_config.h"
+#include "tink/deterministic_aead.h"
 #include "tink/hybrid/hybrid_config.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/internal/registry_impl.h"
 #include "tink/key_manager.h"
+#include "tink/mac.h"
+#include "tink/mac/mac_config.h"
 #include "tink/prf/prf_config.h"
+#include "tink/prf/prf_set.h"
+#include "tink/public_key_sign.h"
+#include "tink/public_key_verify.h"
 #include "tink/registry.h"
 #include "tink/signature/signature_config.h"
+#include "tink/streaming_aead.h"
 #include "tink/streamingaead/streaming_aead_config.h"
 #include "tink/util/status.h"
 #include "proto/config.pb.h"
@@ -32,6 +46,62 @@ using google::crypto::tink::RegistryConfig;
 namespace crypto {
 namespace tink {
 
+namespace {
+
+using LazyKeyType = internal::RegistryImpl::LazyKeyType;
+using LazyWrapper = internal::RegistryImpl::LazyWrapper;
+
+#define TINK_KEY_TYPE(name) "type.googleapis.com/google.crypto.tink." name
+
+// The key types and wrappers registered by Register(), and the functions
+// registering them.
+constexpr LazyKeyType kLazyKeyTypes[] = {
+    {TINK_KEY_TYPE("HmacKey"), &MacConfig::Register},
+    {TINK_KEY_TYPE("AesCmacKey"), &MacConfig::Register},
+    {TINK_KEY_TYPE("AesCtrHmacAeadKey"), &AeadConfig::Register},
+    {TINK_KEY_TYPE("AesGcmKey"), &AeadConfig::Register},
+    {TINK_KEY_TYPE("AesGcmCounterNonceKey"), &AeadConfig::Register},
+    {TINK_KEY_TYPE("AesGcmKeyCheckKey"), &AeadConfig::Register},
+    {TINK_KEY_TYPE("AesGcmPageKey"), &AeadConfig::Register},
+    {TINK_KEY_TYPE("AesGcmSivKey"), &AeadConfig::Register},
+    {TINK_KEY_TYPE("AesEaxKey"), &AeadConfig::Register},
+    {TINK_KEY_TYPE("XChaCha20Poly1305Key"), &AeadConfig::Register},
+    {TINK_KEY_TYPE("KmsAeadKey"), &AeadConfig::Register},
+    {TINK_KEY_TYPE("KmsEnvelopeAeadKey"), &AeadConfig::Register},
+    {TINK_KEY_TYPE("EciesAeadHkdfPrivateKey"), &HybridConfig::Register},
+    {TINK_KEY_TYPE("EciesAeadHkdfPublicKey"), &HybridConfig::Register},
+    {TINK_KEY_TYPE("HmacPrfKey"), &PrfConfig::Register},
+    {TINK_KEY_TYPE("HkdfPrfKey"), &PrfConfig::Register},
+    {TINK_KEY_TYPE("AesCmacPrfKey"), &PrfConfig::Register},
+    {TINK_KEY_TYPE("EcdsaPrivateKey"), &SignatureConfig::Register},
+    {TINK_KEY_TYPE("EcdsaPublicKey"), &SignatureConfig::Register},
+    {TINK_KEY_TYPE("RsaSsaPssPrivateKey"), &SignatureConfig::Register},
+    {TINK_KEY_TYPE("RsaSsaPssPublicKey"), &SignatureConfig::Register},
+    {TINK_KEY_TYPE("RsaSsaPkcs1PrivateKey"), &SignatureConfig::Register},
+    {TINK_KEY_TYPE("RsaSsaPkcs1PublicKey"), &SignatureConfig::Register},
+    {TINK_KEY_TYPE("Ed25519PrivateKey"), &SignatureConfig::Register},
+    {TINK_KEY_TYPE("Ed25519PublicKey"), &SignatureConfig::Register},
+    {TINK_KEY_TYPE("AesSivKey"), &DeterministicAeadConfig::Register},
+    {TINK_KEY_TYPE("AesGcmHkdfStreamingKey"), &StreamingAeadConfig::Register},
+    {TINK_KEY_TYPE("AesCtrHmacStreamingKey"), &StreamingAeadConfig::Register},
+};
+
+#undef TINK_KEY_TYPE
+
+constexpr LazyWrapper kLazyWrappers[] = {
+    {&typeid(Mac), &MacConfig::Register},
+    {&typeid(Aead), &AeadConfig::Register},
+    {&typeid(HybridEncrypt), &HybridConfig::Register},
+    {&typeid(HybridDecrypt), &HybridConfig::Register},
+    {&typeid(PrfSet), &PrfConfig::Register},
+    {&typeid(PublicKeySign), &SignatureConfig::Register},
+    {&typeid(PublicKeyVerify), &SignatureConfig::Register},
+    {&typeid(DeterministicAead), &DeterministicAeadConfig::Register},
+    {&typeid(StreamingAead), &StreamingAeadConfig::Register},
+};
+
+}  // namespace
+
 // static
 const RegistryConfig& TinkConfig::Latest() {
   static const RegistryConfig* config = new RegistryConfig();
@@ -51,5 +121,11 @@ util::Status TinkConfig::Register() {
   return StreamingAeadConfig::Register();
 }
 
+// static
+util::Status TinkConfig::RegisterLazily() {
+  return internal::RegistryImpl::GlobalInstance().RegisterLazily(
+      kLazyKeyTypes, kLazyWrappers);
+}
+
 }  // namespace tink
 }  // namespace crypto
@@ -32,6 +32,9 @@ namespace tink {
 //
 //   auto status = TinkConfig::Register();
 //
+// Short-lived binaries which use only a few of the key types can call
+// TinkConfig::RegisterLazily() instead.
+//
 class TinkConfig {
  public:
   // Returns config of implementations of all primitives supported
@@ -43,6 +46,12 @@ class TinkConfig {
   // supported in the current Tink release.
   static crypto::tink::util::Status Register();
 
+  // Like Register(), but defers the registration of the key managers and
+  // the wrapper of each primitive until one of them is first looked up in
+  // the registry. This saves the construction of all key managers at
+  // start-up. Registry::Seal() registers all of them.
+  static crypto::tink::util::Status RegisterLazily();
+
  private:
   TinkConfig() {}
 };
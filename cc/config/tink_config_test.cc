@@ -20,9 +20,11 @@
 #include "tink/aead.h"
 #include "tink/aead/aes_gcm_key_manager.h"
 #include "tink/config.h"
+#include "tink/daead/deterministic_aead_key_templates.h"
 #include "tink/deterministic_aead.h"
 #include "tink/hybrid_decrypt.h"
 #include "tink/hybrid_encrypt.h"
+#include "tink/keyset_handle.h"
 #include "tink/mac.h"
 #include "tink/public_key_sign.h"
 #include "tink/public_key_verify.h"
@@ -48,6 +50,25 @@ TEST(TinkConfigTest, RegisterWorks) {
               IsOk());
 }
 
+TEST(TinkConfigTest, RegisterLazilyWorks) {
+  Registry::Reset();
+  EXPECT_THAT(TinkConfig::RegisterLazily(), IsOk());
+
+  // Key managers and wrappers are registered when first looked up.
+  EXPECT_THAT(Registry::get_key_manager<Aead>(AesGcmKeyManager().get_key_type())
+                  .status(),
+              IsOk());
+  auto handle_result = KeysetHandle::GenerateNew(
+      DeterministicAeadKeyTemplates::Aes256Siv());
+  ASSERT_THAT(handle_result.status(), IsOk());
+  EXPECT_THAT(
+      handle_result.ValueOrDie()->GetPrimitive<DeterministicAead>().status(),
+      IsOk());
+  EXPECT_THAT(Registry::get_key_manager<Aead>("unknown.key.type").status(),
+              StatusIs(util::error::NOT_FOUND));
+  Registry::Reset();
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
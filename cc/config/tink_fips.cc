@@ -16,11 +16,16 @@
 namespace crypto {
 namespace tink {
 
-#ifdef TINK_USE_ONLY_FIPS
-const bool kUseOnlyFips = true;
-#else
-const bool kUseOnlyFips = false;
-#endif
+namespace {
+
+// Returns whether BoringSSL was built with the BoringCrypto module, which
+// cannot change while the process runs.
+bool IsBoringCryptoAvailable() {
+  static const bool is_available = FIPS_mode();
+  return is_available;
+}
+
+}  // namespace
 
 crypto::tink::util::Status ChecksFipsCompatibility(
     FipsCompatibility fips_status) {
@@ -33,7 +38,7 @@ crypto::tink::util::Status ChecksFipsCompatibility(
         return util::OkStatus();
       }
     case FipsCompatibility::kRequiresBoringCrypto:
-      if (kUseOnlyFips && !FIPS_mode()) {
+      if (kUseOnlyFips && !IsBoringCryptoAvailable()) {
         return util::Status(
             util::error::INTERNAL,
             "BoringSSL not built with the BoringCrypto module. If you want to "
@@ -23,8 +23,13 @@ namespace tink {
 
 // This flag indicates whether Tink was build in FIPS only mode. If the flag
 // is set, then usage of algorithms will be restricted to algorithms which
-// utilize the FIPS validated BoringCrypto module.
-ABSL_CONST_INIT extern const bool kUseOnlyFips;
+// utilize the FIPS validated BoringCrypto module. It is a compile time
+// constant, so that the FIPS checks vanish from builds without FIPS only mode.
+#ifdef TINK_USE_ONLY_FIPS
+constexpr bool kUseOnlyFips = true;
+#else
+constexpr bool kUseOnlyFips = false;
+#endif
 
 // Should be used to indicate whether an algorithm can be used in FIPS only
 // mode or not.
@@ -40,12 +45,16 @@ enum class FipsCompatibility {
 // 1) The algorithm has no FIPS support.
 // 2) The algorithm has FIPS support, but BoringSSL has not been compiled with
 //    the BoringCrypto module.
+// Whether BoringSSL has the BoringCrypto module is only queried once.
 crypto::tink::util::Status ChecksFipsCompatibility(
     FipsCompatibility fips_status);
 
 // Utility function wich calls CheckFipsCompatibility(T::kFipsStatus).
+// Without FIPS only mode this is resolved at compile time, as primitives are
+// often constructed per message (e.g. in envelope and hybrid encryption).
 template <class T>
 crypto::tink::util::Status CheckFipsCompatibility() {
+  if (!kUseOnlyFips) return crypto::tink::util::OkStatus();
   return ChecksFipsCompatibility(T::kFipsStatus);
 }
 
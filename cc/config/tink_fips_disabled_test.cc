@@ -25,6 +25,9 @@ using testing::Eq;
 
 TEST(TinkFipsTest, FlagCorrectlySet) { EXPECT_THAT(kUseOnlyFips, Eq(false)); }
 
+// The flag can be used in constant expressions.
+static_assert(!kUseOnlyFips, "FIPS only mode must be disabled");
+
 class FipsIncompatible {
  public:
   static constexpr crypto::tink::FipsCompatibility kFipsStatus =
@@ -34,6 +34,9 @@ TEST(TinkFipsTest, FlagCorrectlySet) {
   EXPECT_THAT(kUseOnlyFips, testing::Eq(true));
 }
 
+// The flag can be used in constant expressions.
+static_assert(kUseOnlyFips, "FIPS only mode must be enabled");
+
 class FipsIncompatible {
  public:
   static constexpr crypto::tink::FipsCompatibility kFipsStatus =
@@ -0,0 +1,184 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+util::Status ValidateBatchSizes(size_t inputs_size,
+                                size_t associated_data_size) {
+  if (inputs_size != associated_data_size) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("Batch has ", inputs_size, " messages but ",
+                     associated_data_size, " associated data entries"));
+  }
+  return util::Status::OK;
+}
+
+}  // namespace
+
+util::Status Aead::VerifyCiphertext(absl::string_view ciphertext,
+                                    absl::string_view associated_data) const {
+  // Buffers of up to this size are kept for the next call on the thread.
+  constexpr size_t kMaxRetainedBufferSize = 1 << 20;
+  thread_local std::vector<char> retained_buffer;
+  // Moved out, so that nested calls, e.g. from DecryptInto(), get a buffer
+  // of their own.
+  std::vector<char> buffer = std::move(retained_buffer);
+  if (buffer.size() < ciphertext.size()) buffer.resize(ciphertext.size());
+  auto written_result =
+      DecryptInto(ciphertext, associated_data,
+                  absl::MakeSpan(buffer.data(), ciphertext.size()));
+  // On failure, an implementation may have written part of the plaintext.
+  util::SafeZeroMemory(buffer.data(), written_result.ok()
+                                          ? written_result.ValueOrDie()
+                                          : ciphertext.size());
+  if (buffer.size() <= kMaxRetainedBufferSize) {
+    retained_buffer = std::move(buffer);
+  }
+  return written_result.status();
+}
+
+util::Status Aead::EncryptBatch(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::Span<const absl::string_view> associated_data, std::string* arena,
+    std::vector<absl::string_view>* ciphertexts) const {
+  util::Status status =
+      ValidateBatchSizes(plaintexts.size(), associated_data.size());
+  if (!status.ok()) return status;
+  ciphertexts->clear();
+  ciphertexts->reserve(plaintexts.size());
+
+  std::vector<int64_t> offsets;
+  offsets.reserve(plaintexts.size() + 1);
+  offsets.push_back(0);
+  bool sizes_known = true;
+  for (absl::string_view plaintext : plaintexts) {
+    auto size_result = CiphertextSize(plaintext.size());
+    if (!size_result.ok()) {
+      sizes_known = false;
+      break;
+    }
+    offsets.push_back(offsets.back() + size_result.ValueOrDie());
+  }
+
+  if (!sizes_known) {
+    // Ciphertexts have to be computed one by one before they can be laid
+    // out in the arena.
+    std::vector<std::string> results;
+    results.reserve(plaintexts.size());
+    size_t total_size = 0;
+    for (size_t i = 0; i < plaintexts.size(); i++) {
+      auto encrypt_result = Encrypt(plaintexts[i], associated_data[i]);
+      if (!encrypt_result.ok()) return encrypt_result.status();
+      total_size += encrypt_result.ValueOrDie().size();
+      results.push_back(std::move(encrypt_result.ValueOrDie()));
+    }
+    arena->clear();
+    arena->reserve(total_size);
+    for (const std::string& result : results) arena->append(result);
+    size_t offset = 0;
+    for (const std::string& result : results) {
+      ciphertexts->push_back(
+          absl::string_view(arena->data() + offset, result.size()));
+      offset += result.size();
+    }
+    return util::Status::OK;
+  }
+
+  subtle::ResizeStringUninitialized(arena, offsets.back());
+  std::vector<absl::Span<char>> buffers;
+  buffers.reserve(plaintexts.size());
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    buffers.push_back(absl::MakeSpan(&(*arena)[0] + offsets[i],
+                                     offsets[i + 1] - offsets[i]));
+  }
+  status = EncryptBatchInto(plaintexts, associated_data, buffers);
+  if (!status.ok()) return status;
+  for (const absl::Span<char>& buffer : buffers) {
+    ciphertexts->push_back(absl::string_view(buffer.data(), buffer.size()));
+  }
+  return util::Status::OK;
+}
+
+util::Status Aead::DecryptBatch(
+    absl::Span<const absl::string_view> ciphertexts,
+    absl::Span<const absl::string_view> associated_data, std::string* arena,
+    std::vector<absl::string_view>* plaintexts) const {
+  util::Status status =
+      ValidateBatchSizes(ciphertexts.size(), associated_data.size());
+  if (!status.ok()) return status;
+  plaintexts->clear();
+  plaintexts->reserve(ciphertexts.size());
+
+  // A plaintext is never longer than its ciphertext, so the total size of
+  // the ciphertexts bounds the space needed for the plaintexts.
+  size_t total_size = 0;
+  for (absl::string_view ciphertext : ciphertexts) {
+    total_size += ciphertext.size();
+  }
+  subtle::ResizeStringUninitialized(arena, total_size);
+  size_t offset = 0;
+  for (size_t i = 0; i < ciphertexts.size(); i++) {
+    auto written_result =
+        DecryptInto(ciphertexts[i], associated_data[i],
+                    absl::MakeSpan(&(*arena)[0] + offset, ciphertexts[i].size()));
+    if (!written_result.ok()) return written_result.status();
+    plaintexts->push_back(absl::string_view(arena->data() + offset,
+                                            written_result.ValueOrDie()));
+    offset += written_result.ValueOrDie();
+  }
+  arena->resize(offset);
+  return util::Status::OK;
+}
+
+util::Status Aead::EncryptBatchInto(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::Span<const absl::string_view> associated_data,
+    absl::Span<const absl::Span<char>> ciphertext_buffers) const {
+  if (plaintexts.size() != ciphertext_buffers.size()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Number of plaintexts and buffers differ");
+  }
+  util::Status status =
+      ValidateBatchSizes(plaintexts.size(), associated_data.size());
+  if (!status.ok()) return status;
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    auto written_result =
+        EncryptInto(plaintexts[i], associated_data[i], ciphertext_buffers[i]);
+    if (!written_result.ok()) return written_result.status();
+  }
+  return util::Status::OK;
+}
+
+}  // namespace tink
+}  // namespace crypto
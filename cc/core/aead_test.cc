@@ -0,0 +1,199 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "tink/util/inlined_buffer.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::DummyAead;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::ElementsAre;
+
+// A DummyAead which can predict the size of its ciphertexts, and hence
+// goes through EncryptBatchInto() when encrypting batches.
+class SizedDummyAead : public DummyAead {
+ public:
+  explicit SizedDummyAead(absl::string_view aead_name)
+      : DummyAead(aead_name), aead_name_(aead_name) {}
+
+  util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override {
+    return DummyAead::Encrypt(plaintext, "");
+  }
+
+  util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override {
+    return DummyAead::Decrypt(ciphertext, "");
+  }
+
+  util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override {
+    return absl::StrCat(aead_name_.size(), ":0:", aead_name_).size() +
+           plaintext_size;
+  }
+
+ private:
+  std::string aead_name_;
+};
+
+TEST(AeadTest, EncryptBatchWithUnknownCiphertextSizes) {
+  DummyAead aead("dummy");
+  std::vector<absl::string_view> plaintexts = {"first", "", "third"};
+  std::vector<absl::string_view> associated_data = {"ad1", "ad2", ""};
+
+  std::string arena;
+  std::vector<absl::string_view> ciphertexts;
+  ASSERT_THAT(aead.EncryptBatch(plaintexts, associated_data, &arena,
+                                &ciphertexts),
+              IsOk());
+  ASSERT_EQ(ciphertexts.size(), 3);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(ciphertexts[i],
+              aead.Encrypt(plaintexts[i], associated_data[i]).ValueOrDie());
+  }
+  EXPECT_EQ(arena, absl::StrCat(ciphertexts[0], ciphertexts[1],
+                                ciphertexts[2]));
+
+  std::string plaintext_arena;
+  std::vector<absl::string_view> decrypted;
+  ASSERT_THAT(aead.DecryptBatch(ciphertexts, associated_data,
+                                &plaintext_arena, &decrypted),
+              IsOk());
+  EXPECT_THAT(decrypted, ElementsAre("first", "", "third"));
+}
+
+TEST(AeadTest, EncryptBatchWithKnownCiphertextSizes) {
+  SizedDummyAead aead("dummy");
+  std::vector<absl::string_view> plaintexts = {"first", "second"};
+  std::vector<absl::string_view> associated_data = {"", ""};
+
+  std::string arena;
+  std::vector<absl::string_view> ciphertexts;
+  ASSERT_THAT(aead.EncryptBatch(plaintexts, associated_data, &arena,
+                                &ciphertexts),
+              IsOk());
+  ASSERT_EQ(ciphertexts.size(), 2);
+  EXPECT_EQ(ciphertexts[0], aead.Encrypt("first", "").ValueOrDie());
+  EXPECT_EQ(ciphertexts[1], aead.Encrypt("second", "").ValueOrDie());
+  EXPECT_EQ(arena.size(), ciphertexts[0].size() + ciphertexts[1].size());
+
+  std::string plaintext_arena;
+  std::vector<absl::string_view> decrypted;
+  ASSERT_THAT(aead.DecryptBatch(ciphertexts, associated_data,
+                                &plaintext_arena, &decrypted),
+              IsOk());
+  EXPECT_THAT(decrypted, ElementsAre("first", "second"));
+}
+
+TEST(AeadTest, BatchSizeMismatch) {
+  DummyAead aead("dummy");
+  std::vector<absl::string_view> plaintexts = {"first", "second"};
+  std::vector<absl::string_view> associated_data = {"ad1"};
+  std::string arena;
+  std::vector<absl::string_view> outputs;
+  EXPECT_THAT(
+      aead.EncryptBatch(plaintexts, associated_data, &arena, &outputs),
+      StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(
+      aead.DecryptBatch(plaintexts, associated_data, &arena, &outputs),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(AeadTest, DecryptBatchFailsIfOneMessageFails) {
+  DummyAead aead("dummy");
+  std::string ciphertext = aead.Encrypt("first", "").ValueOrDie();
+  std::vector<absl::string_view> ciphertexts = {ciphertext,
+                                                "not a ciphertext"};
+  std::vector<absl::string_view> associated_data = {"", ""};
+  std::string arena;
+  std::vector<absl::string_view> plaintexts;
+  EXPECT_FALSE(
+      aead.DecryptBatch(ciphertexts, associated_data, &arena, &plaintexts)
+          .ok());
+}
+
+TEST(AeadTest, EncryptIntoInlinedBuffer) {
+  SizedDummyAead sized_aead("dummy");
+  DummyAead unsized_aead("dummy");
+  for (const Aead* aead : std::vector<const Aead*>{&sized_aead,
+                                                   &unsized_aead}) {
+    util::InlinedBuffer<64> ciphertext;
+    ASSERT_THAT(aead->Encrypt("plaintext", "", &ciphertext), IsOk());
+    EXPECT_EQ(ciphertext.AsStringView(),
+              aead->Encrypt("plaintext", "").ValueOrDie());
+    EXPECT_EQ(ciphertext.capacity(), 64);
+
+    util::InlinedBuffer<64> plaintext;
+    ASSERT_THAT(aead->Decrypt(ciphertext.AsStringView(), "", &plaintext),
+                IsOk());
+    EXPECT_EQ(plaintext.AsStringView(), "plaintext");
+  }
+}
+
+TEST(AeadTest, InlinedBufferGrowsForLongMessages) {
+  SizedDummyAead aead_impl("dummy");
+  const Aead& aead = aead_impl;
+  std::string long_plaintext(100, 'x');
+  util::InlinedBuffer<16> ciphertext;
+  ASSERT_THAT(aead.Encrypt(long_plaintext, "", &ciphertext), IsOk());
+  util::InlinedBuffer<16> plaintext;
+  ASSERT_THAT(aead.Decrypt(ciphertext.AsStringView(), "", &plaintext),
+              IsOk());
+  EXPECT_EQ(plaintext.AsStringView(), long_plaintext);
+}
+
+TEST(AeadTest, DecryptIntoInlinedBufferFailure) {
+  DummyAead aead_impl("dummy");
+  const Aead& aead = aead_impl;
+  util::InlinedBuffer<64> plaintext;
+  EXPECT_FALSE(aead.Decrypt("not a ciphertext", "", &plaintext).ok());
+  EXPECT_TRUE(plaintext.empty());
+}
+
+TEST(AeadTest, VerifyCiphertext) {
+  DummyAead aead_impl("dummy");
+  const Aead& aead = aead_impl;
+  std::string ciphertext = aead.Encrypt("plaintext", "aad").ValueOrDie();
+  EXPECT_THAT(aead.VerifyCiphertext(ciphertext, "aad"), IsOk());
+  EXPECT_FALSE(aead.VerifyCiphertext(ciphertext, "other aad").ok());
+  EXPECT_FALSE(aead.VerifyCiphertext("not a ciphertext", "aad").ok());
+  // The buffer retained by the first call is reused by longer ones.
+  std::string long_ciphertext =
+      aead.Encrypt(std::string(1000, 'x'), "aad").ValueOrDie();
+  EXPECT_THAT(aead.VerifyCiphertext(long_ciphertext, "aad"), IsOk());
+  EXPECT_THAT(aead.VerifyCiphertext(ciphertext, "aad"), IsOk());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
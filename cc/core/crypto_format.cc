@@ -47,30 +47,33 @@ const uint8_t CryptoFormat::kTinkStartByte;
 const int CryptoFormat::kRawPrefixSize;
 const absl::string_view CryptoFormat::kRawPrefix = "";
 
+CryptoFormat::OutputPrefix::OutputPrefix(uint8_t start_byte, uint32_t key_id)
+    : size_(kNonRawPrefixSize) {
+  bytes_[0] = static_cast<char>(start_byte);
+  uint32_as_big_endian(key_id, &bytes_[1]);
+}
+
 // static
 crypto::tink::util::StatusOr<std::string> CryptoFormat::GetOutputPrefix(
     const google::crypto::tink::KeysetInfo::KeyInfo& key_info) {
+  auto prefix_result = GetInlineOutputPrefix(key_info);
+  if (!prefix_result.ok()) return prefix_result.status();
+  return std::string(prefix_result.ValueOrDie().view());
+}
+
+// static
+crypto::tink::util::StatusOr<CryptoFormat::OutputPrefix>
+CryptoFormat::GetInlineOutputPrefix(
+    const google::crypto::tink::KeysetInfo::KeyInfo& key_info) {
   switch (key_info.output_prefix_type()) {
-    case OutputPrefixType::TINK: {
-      std::string prefix;
-      prefix.assign(reinterpret_cast<const char*>(&kTinkStartByte), 1);
-      char key_id_buf[4];
-      uint32_as_big_endian(key_info.key_id(), key_id_buf);
-      prefix.append(key_id_buf, 4);
-      return prefix;
-    }
+    case OutputPrefixType::TINK:
+      return OutputPrefix(kTinkStartByte, key_info.key_id());
     case OutputPrefixType::CRUNCHY:
       // FALLTHROUGH
-    case OutputPrefixType::LEGACY: {
-      std::string prefix;
-      prefix.assign(reinterpret_cast<const char*>(&kLegacyStartByte), 1);
-      char key_id_buf[4];
-      uint32_as_big_endian(key_info.key_id(), key_id_buf);
-      prefix.append(key_id_buf, 4);
-      return prefix;
-    }
+    case OutputPrefixType::LEGACY:
+      return OutputPrefix(kLegacyStartByte, key_info.key_id());
     case OutputPrefixType::RAW:
-      return std::string(kRawPrefix);
+      return OutputPrefix();
     default:
       return util::Status(crypto::tink::util::error::INVALID_ARGUMENT,
                           "The given key has invalid OutputPrefixType.");
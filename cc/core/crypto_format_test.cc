@@ -97,6 +97,27 @@ TEST_F(CryptoFormatTest, testRawPrefix) {
   EXPECT_EQ(CryptoFormat::kRawPrefixSize, prefix.length());
 }
 
+TEST_F(CryptoFormatTest, testInlineOutputPrefix) {
+  KeysetInfo::KeyInfo key_info;
+  key_info.set_key_id(0x01020304);
+  for (auto prefix_type : {OutputPrefixType::TINK, OutputPrefixType::LEGACY,
+                           OutputPrefixType::CRUNCHY, OutputPrefixType::RAW}) {
+    key_info.set_output_prefix_type(prefix_type);
+    auto inline_result = CryptoFormat::GetInlineOutputPrefix(key_info);
+    EXPECT_TRUE(inline_result.ok()) << inline_result.status();
+    auto prefix = CryptoFormat::GetOutputPrefix(key_info).ValueOrDie();
+    EXPECT_EQ(prefix, inline_result.ValueOrDie().view());
+    EXPECT_EQ(prefix.size(), inline_result.ValueOrDie().size());
+  }
+  EXPECT_TRUE(CryptoFormat::OutputPrefix().empty());
+  EXPECT_EQ(absl::string_view("\1\1\2\3\4", 5),
+            CryptoFormat::OutputPrefix(CryptoFormat::kTinkStartByte,
+                                       0x01020304).view());
+
+  key_info.set_output_prefix_type(OutputPrefixType::UNKNOWN_PREFIX);
+  EXPECT_FALSE(CryptoFormat::GetInlineOutputPrefix(key_info).ok());
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
@@ -0,0 +1,204 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/deterministic_aead.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+// Checks that 'offsets' describes a column of values within 'data', and
+// returns views of the values in '*values'.
+util::Status SplitColumn(absl::Span<const int64_t> offsets,
+                         absl::string_view data,
+                         std::vector<absl::string_view>* values) {
+  if (offsets.empty()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "A column needs at least one offset");
+  }
+  values->clear();
+  values->reserve(offsets.size() - 1);
+  for (size_t i = 0; i < offsets.size(); i++) {
+    int64_t previous = i == 0 ? 0 : offsets[i - 1];
+    if (offsets[i] < previous ||
+        static_cast<size_t>(offsets[i]) > data.size()) {
+      return util::Status(
+          util::error::INVALID_ARGUMENT,
+          absl::StrCat("Invalid offset ", offsets[i], " at position ", i,
+                       " for column data of ", data.size(), " bytes"));
+    }
+    if (i > 0) {
+      values->push_back(data.substr(previous, offsets[i] - previous));
+    }
+  }
+  return util::Status::OK;
+}
+
+class DefaultDeterministicAeadWithAssociatedData
+    : public DeterministicAeadWithAssociatedData {
+ public:
+  DefaultDeterministicAeadWithAssociatedData(const DeterministicAead& daead,
+                                             absl::string_view associated_data)
+      : daead_(daead), associated_data_(associated_data) {}
+
+  util::StatusOr<std::string> EncryptDeterministically(
+      absl::string_view plaintext) const override {
+    return daead_.EncryptDeterministically(plaintext, associated_data_);
+  }
+
+  util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext) const override {
+    return daead_.DecryptDeterministically(ciphertext, associated_data_);
+  }
+
+ private:
+  const DeterministicAead& daead_;
+  const std::string associated_data_;
+};
+
+}  // namespace
+
+util::Status DeterministicAead::EncryptDeterministicallyBatch(
+    absl::Span<const int64_t> plaintext_offsets,
+    absl::string_view plaintext_data, absl::string_view associated_data,
+    std::string* ciphertext_data,
+    std::vector<int64_t>* ciphertext_offsets) const {
+  std::vector<absl::string_view> plaintexts;
+  util::Status status =
+      SplitColumn(plaintext_offsets, plaintext_data, &plaintexts);
+  if (!status.ok()) return status;
+  ciphertext_offsets->clear();
+  ciphertext_offsets->reserve(plaintexts.size() + 1);
+  ciphertext_offsets->push_back(0);
+
+  bool sizes_known = true;
+  for (absl::string_view plaintext : plaintexts) {
+    auto size_result = CiphertextSize(plaintext.size());
+    if (!size_result.ok()) {
+      sizes_known = false;
+      break;
+    }
+    ciphertext_offsets->push_back(ciphertext_offsets->back() +
+                                  size_result.ValueOrDie());
+  }
+
+  if (!sizes_known) {
+    // Ciphertexts have to be computed one by one, and are appended to the
+    // output as they come.
+    ciphertext_offsets->resize(1);
+    ciphertext_data->clear();
+    for (absl::string_view plaintext : plaintexts) {
+      auto encrypt_result =
+          EncryptDeterministically(plaintext, associated_data);
+      if (!encrypt_result.ok()) return encrypt_result.status();
+      ciphertext_data->append(encrypt_result.ValueOrDie());
+      ciphertext_offsets->push_back(ciphertext_data->size());
+    }
+    return util::Status::OK;
+  }
+
+  subtle::ResizeStringUninitialized(ciphertext_data,
+                                    ciphertext_offsets->back());
+  std::vector<absl::Span<char>> buffers;
+  buffers.reserve(plaintexts.size());
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    buffers.push_back(
+        absl::MakeSpan(&(*ciphertext_data)[0] + (*ciphertext_offsets)[i],
+                       (*ciphertext_offsets)[i + 1] -
+                           (*ciphertext_offsets)[i]));
+  }
+  return EncryptDeterministicallyBatchInto(plaintexts, associated_data,
+                                           buffers);
+}
+
+util::Status DeterministicAead::DecryptDeterministicallyBatch(
+    absl::Span<const int64_t> ciphertext_offsets,
+    absl::string_view ciphertext_data, absl::string_view associated_data,
+    std::string* plaintext_data,
+    std::vector<int64_t>* plaintext_offsets) const {
+  std::vector<absl::string_view> ciphertexts;
+  util::Status status =
+      SplitColumn(ciphertext_offsets, ciphertext_data, &ciphertexts);
+  if (!status.ok()) return status;
+  plaintext_offsets->clear();
+  plaintext_offsets->reserve(ciphertexts.size() + 1);
+  plaintext_offsets->push_back(0);
+
+  // A plaintext is never longer than its ciphertext, so the size of the
+  // ciphertexts bounds the space needed for the plaintexts.
+  subtle::ResizeStringUninitialized(
+      plaintext_data, ciphertext_offsets.back() - ciphertext_offsets.front());
+  size_t offset = 0;
+  for (absl::string_view ciphertext : ciphertexts) {
+    auto decrypt_result =
+        DecryptDeterministically(ciphertext, associated_data);
+    if (!decrypt_result.ok()) return decrypt_result.status();
+    const std::string& plaintext = decrypt_result.ValueOrDie();
+    std::copy(plaintext.begin(), plaintext.end(),
+              plaintext_data->begin() + offset);
+    offset += plaintext.size();
+    plaintext_offsets->push_back(offset);
+  }
+  plaintext_data->resize(offset);
+  return util::Status::OK;
+}
+
+util::Status DeterministicAead::EncryptDeterministicallyBatchInto(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> ciphertext_buffers) const {
+  if (plaintexts.size() != ciphertext_buffers.size()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Number of plaintexts and buffers differ");
+  }
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    auto encrypt_result =
+        EncryptDeterministically(plaintexts[i], associated_data);
+    if (!encrypt_result.ok()) return encrypt_result.status();
+    const std::string& ciphertext = encrypt_result.ValueOrDie();
+    if (ciphertext.size() != ciphertext_buffers[i].size()) {
+      return util::Status(util::error::INTERNAL,
+                          "Ciphertext size differs from CiphertextSize()");
+    }
+    std::copy(ciphertext.begin(), ciphertext.end(),
+              ciphertext_buffers[i].begin());
+  }
+  return util::Status::OK;
+}
+
+util::StatusOr<std::unique_ptr<DeterministicAeadWithAssociatedData>>
+DeterministicAead::WithAssociatedData(
+    absl::string_view associated_data) const {
+  return {absl::make_unique<DefaultDeterministicAeadWithAssociatedData>(
+      *this, associated_data)};
+}
+
+}  // namespace tink
+}  // namespace crypto
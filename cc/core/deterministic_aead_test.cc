@@ -0,0 +1,189 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/deterministic_aead.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "tink/util/inlined_buffer.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::DummyDeterministicAead;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::ElementsAre;
+
+// A DummyDeterministicAead which can predict the size of its ciphertexts,
+// and hence goes through EncryptDeterministicallyBatchInto().
+class SizedDummyDeterministicAead : public DummyDeterministicAead {
+ public:
+  explicit SizedDummyDeterministicAead(absl::string_view daead_name)
+      : DummyDeterministicAead(daead_name), daead_name_(daead_name) {}
+
+  util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override {
+    return absl::StrCat(daead_name_.size(), ":2:", daead_name_, "ad").size() +
+           plaintext_size;
+  }
+
+  util::Status EncryptDeterministicallyBatchInto(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> ciphertext_buffers) const override {
+    batch_calls_++;
+    return DeterministicAead::EncryptDeterministicallyBatchInto(
+        plaintexts, associated_data, ciphertext_buffers);
+  }
+
+  int batch_calls() const { return batch_calls_; }
+
+ private:
+  std::string daead_name_;
+  mutable int batch_calls_ = 0;
+};
+
+TEST(DeterministicAeadTest, EncryptBatchWithUnknownCiphertextSizes) {
+  DummyDeterministicAead daead("dummy");
+  // The column starts at offset 2, as for a slice of an Arrow array.
+  std::string data = "--firstthird";
+  std::vector<int64_t> offsets = {2, 7, 7, 12};
+
+  std::string ciphertexts;
+  std::vector<int64_t> ciphertext_offsets;
+  ASSERT_THAT(daead.EncryptDeterministicallyBatch(
+                  offsets, data, "ad", &ciphertexts, &ciphertext_offsets),
+              IsOk());
+  EXPECT_EQ(ciphertexts, "5:2:dummyadfirst5:2:dummyad5:2:dummyadthird");
+  EXPECT_THAT(ciphertext_offsets, ElementsAre(0, 16, 27, 43));
+
+  std::string plaintexts;
+  std::vector<int64_t> plaintext_offsets;
+  ASSERT_THAT(daead.DecryptDeterministicallyBatch(ciphertext_offsets,
+                                                  ciphertexts, "ad",
+                                                  &plaintexts,
+                                                  &plaintext_offsets),
+              IsOk());
+  EXPECT_EQ(plaintexts, "firstthird");
+  EXPECT_THAT(plaintext_offsets, ElementsAre(0, 5, 5, 10));
+}
+
+TEST(DeterministicAeadTest, EncryptBatchWithKnownCiphertextSizes) {
+  SizedDummyDeterministicAead daead("dummy");
+  std::string data = "firstthird";
+  std::vector<int64_t> offsets = {0, 5, 5, 10};
+
+  std::string ciphertexts;
+  std::vector<int64_t> ciphertext_offsets;
+  ASSERT_THAT(daead.EncryptDeterministicallyBatch(
+                  offsets, data, "ad", &ciphertexts, &ciphertext_offsets),
+              IsOk());
+  EXPECT_EQ(daead.batch_calls(), 1);
+  EXPECT_EQ(ciphertexts, "5:2:dummyadfirst5:2:dummyad5:2:dummyadthird");
+  EXPECT_THAT(ciphertext_offsets, ElementsAre(0, 16, 27, 43));
+}
+
+TEST(DeterministicAeadTest, EmptyColumn) {
+  SizedDummyDeterministicAead daead("dummy");
+  std::vector<int64_t> offsets = {0};
+  std::string ciphertexts = "previous contents";
+  std::vector<int64_t> ciphertext_offsets;
+  ASSERT_THAT(daead.EncryptDeterministicallyBatch(
+                  offsets, "", "ad", &ciphertexts, &ciphertext_offsets),
+              IsOk());
+  EXPECT_EQ(ciphertexts, "");
+  EXPECT_THAT(ciphertext_offsets, ElementsAre(0));
+}
+
+TEST(DeterministicAeadTest, InvalidOffsets) {
+  DummyDeterministicAead daead("dummy");
+  std::string ciphertexts;
+  std::vector<int64_t> ciphertext_offsets;
+  for (const std::vector<int64_t>& offsets :
+       std::vector<std::vector<int64_t>>{{}, {-1, 2}, {0, 4, 2}, {0, 11}}) {
+    EXPECT_THAT(daead.EncryptDeterministicallyBatch(
+                    offsets, "firstthird", "ad", &ciphertexts,
+                    &ciphertext_offsets),
+                StatusIs(util::error::INVALID_ARGUMENT));
+    EXPECT_THAT(daead.DecryptDeterministicallyBatch(
+                    offsets, "firstthird", "ad", &ciphertexts,
+                    &ciphertext_offsets),
+                StatusIs(util::error::INVALID_ARGUMENT));
+  }
+}
+
+TEST(DeterministicAeadTest, DecryptBatchFailure) {
+  DummyDeterministicAead daead("dummy");
+  std::string data = "5:2:dummyadfirstsomething else";
+  std::vector<int64_t> offsets = {0, 16, 30};
+  std::string plaintexts;
+  std::vector<int64_t> plaintext_offsets;
+  EXPECT_FALSE(daead.DecryptDeterministicallyBatch(offsets, data, "ad",
+                                                   &plaintexts,
+                                                   &plaintext_offsets)
+                   .ok());
+}
+
+TEST(DeterministicAeadTest, WithAssociatedData) {
+  DummyDeterministicAead daead("dummy");
+  std::string associated_data = "ad";
+  auto bound_result = daead.WithAssociatedData(associated_data);
+  ASSERT_THAT(bound_result.status(), IsOk());
+  auto& bound = bound_result.ValueOrDie();
+  // The associated data is copied.
+  associated_data = "other ad";
+
+  std::string ciphertext =
+      bound->EncryptDeterministically("plaintext").ValueOrDie();
+  EXPECT_EQ(ciphertext,
+            daead.EncryptDeterministically("plaintext", "ad").ValueOrDie());
+  EXPECT_EQ("plaintext",
+            bound->DecryptDeterministically(ciphertext).ValueOrDie());
+  EXPECT_FALSE(bound
+                   ->DecryptDeterministically(
+                       daead.EncryptDeterministically("plaintext", "other ad")
+                           .ValueOrDie())
+                   .ok());
+}
+
+TEST(DeterministicAeadTest, EncryptIntoInlinedBuffer) {
+  SizedDummyDeterministicAead sized_daead("dummy");
+  DummyDeterministicAead unsized_daead("dummy");
+  for (const DeterministicAead* daead :
+       std::vector<const DeterministicAead*>{&sized_daead, &unsized_daead}) {
+    util::InlinedBuffer<64> ciphertext;
+    ASSERT_THAT(daead->EncryptDeterministically("plaintext", "ad", &ciphertext),
+                IsOk());
+    EXPECT_EQ(ciphertext.AsStringView(),
+              daead->EncryptDeterministically("plaintext", "ad").ValueOrDie());
+    EXPECT_EQ(ciphertext.capacity(), 64);
+  }
+  EXPECT_EQ(sized_daead.batch_calls(), 1);
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,105 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/encrypted_keyset_cache.h"
+
+#include <cstring>
+#include <utility>
+
+#include "absl/time/clock.h"
+#include "openssl/mem.h"
+#include "openssl/sha.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+std::string KeysetDigest(absl::string_view encrypted_keyset) {
+  std::string digest(SHA256_DIGEST_LENGTH, '\0');
+  SHA256(reinterpret_cast<const uint8_t*>(encrypted_keyset.data()),
+         encrypted_keyset.size(), reinterpret_cast<uint8_t*>(&digest[0]));
+  return digest;
+}
+
+uint64_t DigestIndex(absl::string_view digest) {
+  uint64_t index;
+  std::memcpy(&index, digest.data(), sizeof(index));
+  return index;
+}
+
+}  // namespace
+
+// static
+EncryptedKeysetCache& EncryptedKeysetCache::GlobalInstance() {
+  static EncryptedKeysetCache* instance =
+      new EncryptedKeysetCache(EncryptedKeysetCache::Options());
+  return *instance;
+}
+
+void EncryptedKeysetCache::Clear() {
+  absl::MutexLock lock(&mutex_);
+  entries_.clear();
+  lru_.clear();
+}
+
+absl::optional<util::SecretData> EncryptedKeysetCache::Lookup(
+    absl::string_view encrypted_keyset) {
+  if (options_.max_entries <= 0) {
+    return absl::nullopt;
+  }
+  std::string digest = KeysetDigest(encrypted_keyset);
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(DigestIndex(digest));
+  if (it == entries_.end() ||
+      CRYPTO_memcmp(it->second.digest.data(), digest.data(), digest.size()) !=
+          0) {
+    return absl::nullopt;
+  }
+  if (absl::Now() >= it->second.expiration) {
+    lru_.erase(it->second.lru_position);
+    entries_.erase(it);
+    return absl::nullopt;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+  return it->second.serialized_keyset;
+}
+
+void EncryptedKeysetCache::Insert(absl::string_view encrypted_keyset,
+                                  util::SecretData serialized_keyset) {
+  if (options_.max_entries <= 0) {
+    return;
+  }
+  absl::Time expiration = absl::Now() + options_.ttl;
+  std::string digest = KeysetDigest(encrypted_keyset);
+  uint64_t index = DigestIndex(digest);
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(index);
+  if (it != entries_.end()) {
+    lru_.erase(it->second.lru_position);
+    entries_.erase(it);
+  }
+  lru_.push_front(index);
+  entries_.emplace(index, Entry{std::move(digest), std::move(serialized_keyset),
+                                expiration, lru_.begin()});
+  if (lru_.size() > static_cast<size_t>(options_.max_entries)) {
+    entries_.erase(lru_.back());
+    lru_.pop_back();
+  }
+}
+
+}  // namespace tink
+}  // namespace crypto
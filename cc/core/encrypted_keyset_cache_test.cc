@@ -0,0 +1,162 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/encrypted_keyset_cache.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "tink/aead.h"
+#include "tink/binary_keyset_reader.h"
+#include "tink/keyset_handle.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_keyset_handle.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::AddTinkKey;
+using ::crypto::tink::test::DummyAead;
+using ::crypto::tink::test::IsOk;
+using ::google::crypto::tink::EncryptedKeyset;
+using ::google::crypto::tink::KeyData;
+using ::google::crypto::tink::Keyset;
+using ::google::crypto::tink::KeyStatusType;
+
+// A DummyAead which counts the decryptions.
+class CountingAead : public DummyAead {
+ public:
+  CountingAead() : DummyAead("master key") {}
+
+  util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override {
+    decryptions_++;
+    return DummyAead::Decrypt(ciphertext, associated_data);
+  }
+
+  int decryptions() const { return decryptions_; }
+
+ private:
+  mutable int decryptions_ = 0;
+};
+
+class EncryptedKeysetCacheTest : public ::testing::Test {
+ protected:
+  // Returns the serialized EncryptedKeyset of a keyset with a key 'key_id'.
+  std::string EncryptedKeysetWithKey(uint32_t key_id) {
+    Keyset keyset;
+    KeyData key;
+    AddTinkKey("some key type", key_id, key, KeyStatusType::ENABLED,
+               KeyData::SYMMETRIC, &keyset);
+    keyset.set_primary_key_id(key_id);
+    EncryptedKeyset encrypted_keyset;
+    encrypted_keyset.set_encrypted_keyset(
+        master_key_aead_.Encrypt(keyset.SerializeAsString(), "")
+            .ValueOrDie());
+    return encrypted_keyset.SerializeAsString();
+  }
+
+  // Reads 'encrypted_keyset' using 'cache', and returns the primary key id.
+  util::StatusOr<uint32_t> Read(const std::string& encrypted_keyset,
+                                EncryptedKeysetCache* cache) {
+    auto handle_result = KeysetHandle::Read(
+        BinaryKeysetReader::New(encrypted_keyset).ValueOrDie(),
+        master_key_aead_, cache);
+    if (!handle_result.ok()) return handle_result.status();
+    return TestKeysetHandle::GetKeyset(*handle_result.ValueOrDie())
+        .primary_key_id();
+  }
+
+  CountingAead master_key_aead_;
+};
+
+TEST_F(EncryptedKeysetCacheTest, RepeatedReadsDecryptOnce) {
+  EncryptedKeysetCache cache((EncryptedKeysetCache::Options()));
+  std::string encrypted_keyset = EncryptedKeysetWithKey(42);
+  for (int i = 0; i < 3; i++) {
+    auto read_result = Read(encrypted_keyset, &cache);
+    ASSERT_THAT(read_result.status(), IsOk());
+    EXPECT_EQ(42, read_result.ValueOrDie());
+  }
+  EXPECT_EQ(1, master_key_aead_.decryptions());
+
+  // Another keyset is decrypted, too.
+  auto read_result = Read(EncryptedKeysetWithKey(711), &cache);
+  ASSERT_THAT(read_result.status(), IsOk());
+  EXPECT_EQ(711, read_result.ValueOrDie());
+  EXPECT_EQ(2, master_key_aead_.decryptions());
+
+  cache.Clear();
+  ASSERT_THAT(Read(encrypted_keyset, &cache).status(), IsOk());
+  EXPECT_EQ(3, master_key_aead_.decryptions());
+
+  // Without a cache every read decrypts.
+  ASSERT_THAT(Read(encrypted_keyset, nullptr).status(), IsOk());
+  EXPECT_EQ(4, master_key_aead_.decryptions());
+}
+
+TEST_F(EncryptedKeysetCacheTest, EntriesExpire) {
+  EncryptedKeysetCache::Options options;
+  options.ttl = absl::ZeroDuration();
+  EncryptedKeysetCache cache(options);
+  std::string encrypted_keyset = EncryptedKeysetWithKey(42);
+  ASSERT_THAT(Read(encrypted_keyset, &cache).status(), IsOk());
+  ASSERT_THAT(Read(encrypted_keyset, &cache).status(), IsOk());
+  EXPECT_EQ(2, master_key_aead_.decryptions());
+}
+
+TEST_F(EncryptedKeysetCacheTest, LeastRecentlyUsedKeysetIsDropped) {
+  EncryptedKeysetCache::Options options;
+  options.max_entries = 2;
+  EncryptedKeysetCache cache(options);
+  std::string encrypted_keyset_1 = EncryptedKeysetWithKey(1);
+  std::string encrypted_keyset_2 = EncryptedKeysetWithKey(2);
+  std::string encrypted_keyset_3 = EncryptedKeysetWithKey(3);
+  ASSERT_THAT(Read(encrypted_keyset_1, &cache).status(), IsOk());
+  ASSERT_THAT(Read(encrypted_keyset_2, &cache).status(), IsOk());
+  ASSERT_THAT(Read(encrypted_keyset_1, &cache).status(), IsOk());
+  ASSERT_THAT(Read(encrypted_keyset_3, &cache).status(), IsOk());
+  EXPECT_EQ(3, master_key_aead_.decryptions());
+
+  // Keyset 2 was dropped, keyset 1 was not.
+  ASSERT_THAT(Read(encrypted_keyset_1, &cache).status(), IsOk());
+  EXPECT_EQ(3, master_key_aead_.decryptions());
+  ASSERT_THAT(Read(encrypted_keyset_2, &cache).status(), IsOk());
+  EXPECT_EQ(4, master_key_aead_.decryptions());
+}
+
+TEST_F(EncryptedKeysetCacheTest, FailuresAreNotCached) {
+  EncryptedKeysetCache cache((EncryptedKeysetCache::Options()));
+  EncryptedKeyset encrypted_keyset;
+  encrypted_keyset.set_encrypted_keyset("not a ciphertext");
+  for (int i = 0; i < 2; i++) {
+    EXPECT_FALSE(Read(encrypted_keyset.SerializeAsString(), &cache).ok());
+  }
+  EXPECT_EQ(2, master_key_aead_.decryptions());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
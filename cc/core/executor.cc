@@ -0,0 +1,49 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+
+#include "absl/synchronization/blocking_counter.h"
+
+namespace crypto {
+namespace tink {
+
+void Executor::ParallelFor(int count, const std::function<void(int)>& func) {
+  if (count <= 0) return;
+  // Every participating thread repeatedly claims the next index, so that
+  // uneven tasks do not leave threads idle.
+  std::atomic<int> next(0);
+  auto run = [&next, count, &func]() {
+    for (int i = next++; i < count; i = next++) func(i);
+  };
+  int helpers = std::min(num_threads(), count - 1);
+  absl::BlockingCounter done(helpers);
+  for (int i = 0; i < helpers; i++) {
+    Schedule([&run, &done]() {
+      run();
+      done.DecrementCount();
+    });
+  }
+  run();
+  done.Wait();
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,44 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid_decrypt.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+util::StatusOr<std::vector<std::string>> HybridDecrypt::DecryptBatch(
+    absl::Span<const absl::string_view> ciphertexts,
+    absl::string_view context_info) const {
+  std::vector<std::string> plaintexts;
+  plaintexts.reserve(ciphertexts.size());
+  for (absl::string_view ciphertext : ciphertexts) {
+    auto decrypt_result = Decrypt(ciphertext, context_info);
+    if (!decrypt_result.ok()) return decrypt_result.status();
+    plaintexts.push_back(std::move(decrypt_result.ValueOrDie()));
+  }
+  return std::move(plaintexts);
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,67 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid_decrypt.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::DummyHybridDecrypt;
+using ::crypto::tink::test::DummyHybridEncrypt;
+using ::crypto::tink::test::IsOk;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(HybridDecryptTest, DecryptBatch) {
+  DummyHybridEncrypt encrypt("dummy");
+  DummyHybridDecrypt decrypt("dummy");
+  std::string first = encrypt.Encrypt("first", "context").ValueOrDie();
+  std::string second = encrypt.Encrypt("", "context").ValueOrDie();
+  std::vector<absl::string_view> ciphertexts = {first, second};
+  auto plaintexts_or = decrypt.DecryptBatch(ciphertexts, "context");
+  ASSERT_THAT(plaintexts_or.status(), IsOk());
+  EXPECT_THAT(plaintexts_or.ValueOrDie(), ElementsAre("first", ""));
+}
+
+TEST(HybridDecryptTest, DecryptEmptyBatch) {
+  DummyHybridDecrypt decrypt("dummy");
+  auto plaintexts_or = decrypt.DecryptBatch({}, "context");
+  ASSERT_THAT(plaintexts_or.status(), IsOk());
+  EXPECT_THAT(plaintexts_or.ValueOrDie(), IsEmpty());
+}
+
+TEST(HybridDecryptTest, DecryptBatchFails) {
+  DummyHybridEncrypt encrypt("dummy");
+  DummyHybridDecrypt decrypt("dummy");
+  std::string good = encrypt.Encrypt("good", "context").ValueOrDie();
+  std::vector<absl::string_view> ciphertexts = {good, "bad"};
+  EXPECT_FALSE(decrypt.DecryptBatch(ciphertexts, "context").ok());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -16,18 +16,23 @@
 
 #include "tink/json_keyset_reader.h"
 
+#include <cstdint>
 #include <iostream>
 #include <istream>
 #include <sstream>
+#include <utility>
 
 #include "absl/memory/memory.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
 #include "include/rapidjson/document.h"
 #include "include/rapidjson/error/en.h"
+#include "include/rapidjson/reader.h"
 #include "tink/util/enums.h"
 #include "tink/util/errors.h"
+#include "tink/util/keyset_util.h"
 #include "tink/util/protobuf_helper.h"
+#include "tink/util/secret_data.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
@@ -136,96 +141,297 @@ EncryptedKeysetFromJson(const rapidjson::Document& json_doc) {
   return std::move(encrypted_keyset);
 }
 
-// Helpers for validating and parsing JSON strings with Keyset-protos.
-util::Status ValidateKeyset(const rapidjson::Document& json_doc) {
-  if (!json_doc.HasMember("primaryKeyId") ||
-      !json_doc["primaryKeyId"].IsUint() ||
-      !json_doc.HasMember("key") ||
-      !json_doc["key"].IsArray() ||
-      json_doc["key"].Size() < 1) {
-    return util::Status(util::error::INVALID_ARGUMENT,
-                            "Invalid JSON Keyset");
-  }
-  return util::Status::OK;
+// The JSON objects of a Keyset, and their fields.
+enum class Object { kNone, kKeyset, kKeyArray, kKey, kKeyData, kDone };
+enum class Field {
+  kUnknown,
+  kPrimaryKeyId,
+  kKey,
+  kKeyData,
+  kStatus,
+  kKeyId,
+  kOutputPrefixType,
+  kTypeUrl,
+  kValue,
+  kKeyMaterialType
+};
+
+constexpr uint32_t Bit(Field field) {
+  return field == Field::kUnknown ? 0 : 1u << static_cast<int>(field);
 }
 
-util::Status ValidateKey(const rapidjson::Value& json_value) {
-  if (!json_value.HasMember("keyData") ||
-      !json_value["keyData"].IsObject() ||
-      !json_value.HasMember("status") ||
-      !json_value["status"].IsString() ||
-      !json_value.HasMember("keyId") ||
-      !json_value["keyId"].IsUint() ||
-      !json_value.HasMember("outputPrefixType") ||
-      !json_value["outputPrefixType"].IsString()) {
-    return util::Status(util::error::INVALID_ARGUMENT,
-                            "Invalid JSON Key");
+// The required fields of the objects.
+constexpr uint32_t kKeysetFields = Bit(Field::kPrimaryKeyId) | Bit(Field::kKey);
+constexpr uint32_t kKeyFields = Bit(Field::kKeyData) | Bit(Field::kStatus) |
+                                Bit(Field::kKeyId) |
+                                Bit(Field::kOutputPrefixType);
+constexpr uint32_t kKeyDataFields =
+    Bit(Field::kTypeUrl) | Bit(Field::kValue) | Bit(Field::kKeyMaterialType);
+
+// Parses a JSON Keyset with the SAX interface of rapidjson: the fields are
+// written into the Keyset proto as they are parsed, without building a DOM
+// or intermediate protos, and the key values are base64-decoded straight
+// into the KeyData protos. Unknown fields are skipped.
+class KeysetHandler
+    : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, KeysetHandler> {
+ public:
+  explicit KeysetHandler(Keyset* keyset) : keyset_(keyset) {}
+
+  // Returns the error which made the handler stop the parsing.
+  const util::Status& status() const { return status_; }
+
+  bool StartObject() {
+    if (skip_depth_ > 0 || Skip()) {
+      skip_depth_++;
+      return true;
+    }
+    switch (object_) {
+      case Object::kNone:
+        object_ = Object::kKeyset;
+        return true;
+      case Object::kKeyArray:
+        object_ = Object::kKey;
+        key_ = keyset_->add_key();
+        seen_ &= kKeysetFields;
+        return true;
+      case Object::kKey:
+        if (field_ != Field::kKeyData) return Fail();
+        object_ = Object::kKeyData;
+        return true;
+      default:
+        return Fail();
+    }
   }
-  return util::Status::OK;
-}
 
-util::Status ValidateKeyData(const rapidjson::Value& json_value) {
-  if (!json_value.HasMember("typeUrl") ||
-      !json_value["typeUrl"].IsString() ||
-      !json_value.HasMember("value") ||
-      !json_value["value"].IsString() ||
-      !json_value.HasMember("keyMaterialType") ||
-      !json_value["keyMaterialType"].IsString()) {
-    return util::Status(util::error::INVALID_ARGUMENT,
-                            "Invalid JSON KeyData");
+  bool EndObject(rapidjson::SizeType) {
+    if (skip_depth_ > 0) {
+      skip_depth_--;
+      return true;
+    }
+    switch (object_) {
+      case Object::kKeyset:
+        if ((seen_ & kKeysetFields) != kKeysetFields ||
+            keyset_->key_size() < 1) {
+          return Fail();
+        }
+        object_ = Object::kDone;
+        return true;
+      case Object::kKey:
+        if ((seen_ & kKeyFields) != kKeyFields) return Fail();
+        object_ = Object::kKeyArray;
+        return true;
+      case Object::kKeyData:
+        if ((seen_ & kKeyDataFields) != kKeyDataFields) return Fail();
+        object_ = Object::kKey;
+        return true;
+      default:
+        return Fail();
+    }
   }
-  return util::Status::OK;
-}
 
-util::StatusOr<std::unique_ptr<KeyData>>
-KeyDataFromJson(const rapidjson::Value& json_value) {
-  auto status = ValidateKeyData(json_value);
-  if (!status.ok()) return status;
-  std::string value_field;
-  if (!absl::Base64Unescape(json_value["value"].GetString(), &value_field)) {
-    return util::Status(util::error::INVALID_ARGUMENT,
-                            "Invalid JSON KeyData");
+  bool StartArray() {
+    if (skip_depth_ > 0 || Skip()) {
+      skip_depth_++;
+      return true;
+    }
+    if (object_ != Object::kKeyset || field_ != Field::kKey) return Fail();
+    object_ = Object::kKeyArray;
+    return true;
   }
-  auto key_data = absl::make_unique<KeyData>();
-  key_data->set_type_url(json_value["typeUrl"].GetString());
-  key_data->set_value(value_field);
-  key_data->set_key_material_type(
-      Enums::KeyMaterial(json_value["keyMaterialType"].GetString()));
-  return std::move(key_data);
-}
 
-util::StatusOr<std::unique_ptr<Keyset::Key>>
-KeyFromJson(const rapidjson::Value& json_value) {
-  auto status = ValidateKey(json_value);
-  if (!status.ok()) return status;
-  auto key_data_result = KeyDataFromJson(json_value["keyData"]);
-  if (!key_data_result.ok()) return key_data_result.status();
+  bool EndArray(rapidjson::SizeType) {
+    if (skip_depth_ > 0) {
+      skip_depth_--;
+      return true;
+    }
+    object_ = Object::kKeyset;
+    return true;
+  }
 
-  auto key = absl::make_unique<Keyset::Key>();
-  key->set_key_id(json_value["keyId"].GetUint());
-  key->set_status(Enums::KeyStatus(json_value["status"].GetString()));
-  key->set_output_prefix_type(
-      Enums::OutputPrefix(json_value["outputPrefixType"].GetString()));
-  *(key->mutable_key_data()) = *(key_data_result.ValueOrDie());
-  return std::move(key);
+  bool Key(const char* str, rapidjson::SizeType length, bool) {
+    if (skip_depth_ > 0) return true;
+    absl::string_view name(str, length);
+    field_ = Field::kUnknown;
+    switch (object_) {
+      case Object::kKeyset:
+        if (name == "primaryKeyId") field_ = Field::kPrimaryKeyId;
+        if (name == "key") field_ = Field::kKey;
+        break;
+      case Object::kKey:
+        if (name == "keyData") field_ = Field::kKeyData;
+        if (name == "status") field_ = Field::kStatus;
+        if (name == "keyId") field_ = Field::kKeyId;
+        if (name == "outputPrefixType") field_ = Field::kOutputPrefixType;
+        break;
+      case Object::kKeyData:
+        if (name == "typeUrl") field_ = Field::kTypeUrl;
+        if (name == "value") field_ = Field::kValue;
+        if (name == "keyMaterialType") field_ = Field::kKeyMaterialType;
+        break;
+      default:
+        break;
+    }
+    seen_ |= Bit(field_);
+    return true;
+  }
+
+  bool String(const char* str, rapidjson::SizeType length, bool) {
+    if (skip_depth_ > 0 || Skip()) return true;
+    absl::string_view value(str, length);
+    switch (field_) {
+      case Field::kStatus:
+        key_->set_status(Enums::KeyStatus(value));
+        return true;
+      case Field::kOutputPrefixType:
+        key_->set_output_prefix_type(Enums::OutputPrefix(value));
+        return true;
+      case Field::kTypeUrl:
+        key_->mutable_key_data()->set_type_url(value.data(), value.size());
+        return true;
+      case Field::kValue:
+        if (!absl::Base64Unescape(value,
+                                  key_->mutable_key_data()->mutable_value())) {
+          return Fail();
+        }
+        return true;
+      case Field::kKeyMaterialType:
+        key_->mutable_key_data()->set_key_material_type(
+            Enums::KeyMaterial(value));
+        return true;
+      default:
+        return Fail();
+    }
+  }
+
+  bool Uint(unsigned value) {
+    if (skip_depth_ > 0 || Skip()) return true;
+    switch (field_) {
+      case Field::kPrimaryKeyId:
+        keyset_->set_primary_key_id(value);
+        return true;
+      case Field::kKeyId:
+        key_->set_key_id(value);
+        return true;
+      default:
+        return Fail();
+    }
+  }
+
+  // All other values are only valid for unknown fields.
+  bool Null() { return OtherValue(); }
+  bool Bool(bool) { return OtherValue(); }
+  bool Int(int) { return OtherValue(); }
+  bool Int64(int64_t) { return OtherValue(); }
+  bool Uint64(uint64_t) { return OtherValue(); }
+  bool Double(double) { return OtherValue(); }
+
+ private:
+  // Returns true if the current value belongs to an unknown field.
+  bool Skip() const {
+    return field_ == Field::kUnknown &&
+           (object_ == Object::kKeyset || object_ == Object::kKey ||
+            object_ == Object::kKeyData);
+  }
+
+  bool OtherValue() {
+    if (skip_depth_ > 0 || Skip()) return true;
+    return Fail();
+  }
+
+  // Records the error for the object being parsed, and stops the parsing.
+  bool Fail() {
+    switch (object_) {
+      case Object::kKeyArray:
+      case Object::kKey:
+        status_ = util::Status(util::error::INVALID_ARGUMENT,
+                               "Invalid JSON Key");
+        break;
+      case Object::kKeyData:
+        status_ = util::Status(util::error::INVALID_ARGUMENT,
+                               "Invalid JSON KeyData");
+        break;
+      default:
+        status_ = util::Status(util::error::INVALID_ARGUMENT,
+                               "Invalid JSON Keyset");
+        break;
+    }
+    return false;
+  }
+
+  Keyset* keyset_;
+  Keyset::Key* key_ = nullptr;
+  Object object_ = Object::kNone;
+  Field field_ = Field::kUnknown;
+  // The fields seen in the keyset, and in the current key and key data.
+  uint32_t seen_ = 0;
+  // The nesting depth within the value of an unknown field.
+  int skip_depth_ = 0;
+  util::Status status_;
+};
+
+// Returns an upper bound of the number of keys in 'serialized_keyset'.
+int CountKeys(absl::string_view serialized_keyset) {
+  int count = 0;
+  for (size_t pos = serialized_keyset.find("\"keyData\"");
+       pos != absl::string_view::npos;
+       pos = serialized_keyset.find("\"keyData\"", pos + 1)) {
+    count++;
+  }
+  return count;
 }
 
-util::StatusOr<std::unique_ptr<Keyset>>
-KeysetFromJson(const rapidjson::Document& json_doc) {
-  auto status = ValidateKeyset(json_doc);
-  if (!status.ok()) return status;
+util::StatusOr<std::unique_ptr<Keyset>> KeysetFromJson(
+    const std::string& serialized_keyset) {
   auto keyset = absl::make_unique<Keyset>();
-  keyset->set_primary_key_id(json_doc["primaryKeyId"].GetUint());
-  for (const auto& json_key : json_doc["key"].GetArray()) {
-    auto key_result = KeyFromJson(json_key);
-    if (!key_result.ok()) return key_result.status();
-    *(keyset->add_key()) = *(key_result.ValueOrDie());
+  keyset->mutable_key()->Reserve(CountKeys(serialized_keyset));
+  KeysetHandler handler(keyset.get());
+  rapidjson::Reader reader;
+  rapidjson::StringStream stream(serialized_keyset.c_str());
+  rapidjson::ParseResult result = reader.Parse(stream, handler);
+  if (result.Code() == rapidjson::kParseErrorTermination) {
+    return handler.status();
+  }
+  if (result.IsError()) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("Invalid JSON Keyset: Error (offset ", result.Offset(),
+                     "): ", rapidjson::GetParseError_En(result.Code())));
   }
   return std::move(keyset);
 }
 
 }  // namespace
 
+JsonKeysetCache::~JsonKeysetCache() {
+  absl::MutexLock lock(&mutex_);
+  Clear();
+}
+
+std::unique_ptr<Keyset> JsonKeysetCache::Get(
+    absl::string_view serialized_keyset) {
+  absl::MutexLock lock(&mutex_);
+  if (keyset_ == nullptr || serialized_keyset != serialized_keyset_) {
+    return nullptr;
+  }
+  return absl::make_unique<Keyset>(*keyset_);
+}
+
+void JsonKeysetCache::Put(absl::string_view serialized_keyset,
+                          const Keyset& keyset) {
+  absl::MutexLock lock(&mutex_);
+  Clear();
+  serialized_keyset_ = std::string(serialized_keyset);
+  keyset_ = absl::make_unique<Keyset>(keyset);
+}
+
+void JsonKeysetCache::Clear() {
+  // The serialized keyset holds the key material, too.
+  util::SafeZeroString(&serialized_keyset_);
+  serialized_keyset_.clear();
+  if (keyset_ != nullptr) ZeroizeKeyValues(keyset_.get());
+  keyset_.reset();
+}
+
 
 //  static
 util::StatusOr<std::unique_ptr<KeysetReader>> JsonKeysetReader::New(
@@ -246,6 +452,28 @@ util::StatusOr<std::unique_ptr<KeysetReader>> JsonKeysetReader::New(
   return std::move(reader);
 }
 
+//  static
+util::StatusOr<std::unique_ptr<KeysetReader>> JsonKeysetReader::New(
+    std::unique_ptr<std::istream> keyset_stream, JsonKeysetCache* cache) {
+  if (keyset_stream == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                            "keyset_stream must be non-null.");
+  }
+  std::unique_ptr<JsonKeysetReader> reader(
+      new JsonKeysetReader(std::move(keyset_stream)));
+  reader->cache_ = cache;
+  return std::unique_ptr<KeysetReader>(std::move(reader));
+}
+
+//  static
+util::StatusOr<std::unique_ptr<KeysetReader>> JsonKeysetReader::New(
+    absl::string_view serialized_keyset, JsonKeysetCache* cache) {
+  std::unique_ptr<JsonKeysetReader> reader(
+      new JsonKeysetReader(serialized_keyset));
+  reader->cache_ = cache;
+  return std::unique_ptr<KeysetReader>(std::move(reader));
+}
+
 util::StatusOr<std::unique_ptr<Keyset>> JsonKeysetReader::Read() {
   std::string serialized_keyset_from_stream;
   std::string* serialized_keyset;
@@ -256,15 +484,15 @@ util::StatusOr<std::unique_ptr<Keyset>> JsonKeysetReader::Read() {
         std::string(std::istreambuf_iterator<char>(*keyset_stream_), {});
     serialized_keyset = &serialized_keyset_from_stream;
   }
-  rapidjson::Document json_doc(rapidjson::kObjectType);
-  if (json_doc.Parse(serialized_keyset->c_str()).HasParseError()) {
-    return util::Status(
-        util::error::INVALID_ARGUMENT,
-        absl::StrCat(
-            "Invalid JSON Keyset: Error (offset ", json_doc.GetErrorOffset(),
-            "): ", rapidjson::GetParseError_En(json_doc.GetParseError())));
+  if (cache_ != nullptr) {
+    auto keyset = cache_->Get(*serialized_keyset);
+    if (keyset != nullptr) return std::move(keyset);
+  }
+  auto keyset_result = KeysetFromJson(*serialized_keyset);
+  if (keyset_result.ok() && cache_ != nullptr) {
+    cache_->Put(*serialized_keyset, *keyset_result.ValueOrDie());
   }
-  return KeysetFromJson(json_doc);
+  return keyset_result;
 }
 
 util::StatusOr<std::unique_ptr<EncryptedKeyset>>
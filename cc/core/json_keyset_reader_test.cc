@@ -19,9 +19,12 @@
 #include <iostream>
 #include <istream>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/substitute.h"
 #include "tink/util/protobuf_helper.h"
 #include "tink/util/test_matchers.h"
@@ -345,6 +348,133 @@ TEST_F(JsonKeysetReaderTest, ReadNegativeKeyId) {
   EXPECT_THAT(read_result.status(), Not(IsOk()));
 }
 
+TEST_F(JsonKeysetReaderTest, UnknownFieldsAreSkipped) {
+  std::string json_serialization =
+      absl::Substitute(R"(
+      {
+         "comment": {"nested": [1, {"key": []}, "x"], "flag": true},
+         "primaryKeyId": 42,
+         "key":[
+            {
+               "keyData":{
+                  "typeUrl":"type.googleapis.com/google.crypto.tink.AesGcmKey",
+                  "keyMaterialType":"SYMMETRIC",
+                  "value": "$0",
+                  "extra": null
+               },
+               "outputPrefixType":"TINK",
+               "keyId":42,
+               "status":"ENABLED",
+               "created": -1.5
+            },
+            {
+               "keyData":{
+                  "typeUrl":"type.googleapis.com/google.crypto.tink.AesEaxKey",
+                  "keyMaterialType":"SYMMETRIC",
+                  "value":"$1"
+               },
+               "outputPrefixType":"RAW",
+               "keyId":711,
+               "status":"ENABLED"
+            }
+         ]
+      })",
+                       absl::Base64Escape(gcm_key_.SerializeAsString()),
+                       absl::Base64Escape(eax_key_.SerializeAsString()));
+  auto reader_result = JsonKeysetReader::New(json_serialization);
+  ASSERT_THAT(reader_result.status(), IsOk());
+  auto read_result = reader_result.ValueOrDie()->Read();
+  ASSERT_THAT(read_result.status(), IsOk());
+  EXPECT_EQ(keyset_.SerializeAsString(),
+            read_result.ValueOrDie()->SerializeAsString());
+}
+
+TEST_F(JsonKeysetReaderTest, ReadInvalidKeysets) {
+  std::string key_data = absl::Substitute(
+      R"("keyData":{
+            "typeUrl":"type.googleapis.com/google.crypto.tink.AesGcmKey",
+            "keyMaterialType":"SYMMETRIC",
+            "value":"$0"})",
+      absl::Base64Escape(gcm_key_.SerializeAsString()));
+  std::vector<std::string> json_serializations = {
+      // Not an object.
+      "[]",
+      // No keys.
+      R"({"primaryKeyId":42, "key":[]})",
+      // No primary key id.
+      absl::StrCat(R"({"key":[{)", key_data,
+                   R"(, "outputPrefixType":"TINK", "keyId":42,
+                        "status":"ENABLED"}]})"),
+      // Primary key id of the wrong type.
+      absl::StrCat(R"({"primaryKeyId":"42", "key":[{)", key_data,
+                   R"(, "outputPrefixType":"TINK", "keyId":42,
+                        "status":"ENABLED"}]})"),
+      // Key without a status.
+      absl::StrCat(R"({"primaryKeyId":42, "key":[{)", key_data,
+                   R"(, "outputPrefixType":"TINK", "keyId":42}]})"),
+      // Key id out of range.
+      absl::StrCat(R"({"primaryKeyId":42, "key":[{)", key_data,
+                   R"(, "outputPrefixType":"TINK", "keyId":4294967296,
+                        "status":"ENABLED"}]})"),
+      // Key data without a value.
+      R"({"primaryKeyId":42, "key":[{"keyData":{
+            "typeUrl":"type.googleapis.com/google.crypto.tink.AesGcmKey",
+            "keyMaterialType":"SYMMETRIC"},
+          "outputPrefixType":"TINK", "keyId":42, "status":"ENABLED"}]})",
+      // Value that is not base64.
+      R"({"primaryKeyId":42, "key":[{"keyData":{
+            "typeUrl":"type.googleapis.com/google.crypto.tink.AesGcmKey",
+            "keyMaterialType":"SYMMETRIC", "value":"#?!"},
+          "outputPrefixType":"TINK", "keyId":42, "status":"ENABLED"}]})",
+      // Key that is not an object.
+      R"({"primaryKeyId":42, "key":["some key"]})",
+  };
+  for (const std::string& json_serialization : json_serializations) {
+    auto reader_result = JsonKeysetReader::New(json_serialization);
+    ASSERT_THAT(reader_result.status(), IsOk());
+    auto read_result = reader_result.ValueOrDie()->Read();
+    EXPECT_EQ(util::error::INVALID_ARGUMENT,
+              read_result.status().error_code())
+        << json_serialization;
+  }
+}
+
+TEST_F(JsonKeysetReaderTest, ReadWithCache) {
+  JsonKeysetCache cache;
+  for (int i = 0; i < 3; i++) {
+    auto reader_result = JsonKeysetReader::New(good_json_keyset_, &cache);
+    ASSERT_THAT(reader_result.status(), IsOk());
+    auto read_result = reader_result.ValueOrDie()->Read();
+    ASSERT_THAT(read_result.status(), IsOk());
+    EXPECT_EQ(keyset_.SerializeAsString(),
+              read_result.ValueOrDie()->SerializeAsString());
+  }
+
+  // A different keyset replaces the cached one.
+  Keyset other_keyset = keyset_;
+  other_keyset.set_primary_key_id(711);
+  std::string other_json_keyset = good_json_keyset_;
+  other_json_keyset.replace(other_json_keyset.find("42"), 2, "711");
+  for (int i = 0; i < 2; i++) {
+    std::unique_ptr<std::istream> keyset_stream(new std::stringstream(
+        other_json_keyset, std::ios_base::in));
+    auto reader_result =
+        JsonKeysetReader::New(std::move(keyset_stream), &cache);
+    ASSERT_THAT(reader_result.status(), IsOk());
+    auto read_result = reader_result.ValueOrDie()->Read();
+    ASSERT_THAT(read_result.status(), IsOk());
+    EXPECT_EQ(other_keyset.SerializeAsString(),
+              read_result.ValueOrDie()->SerializeAsString());
+  }
+
+  // Invalid keysets are not cached.
+  for (int i = 0; i < 2; i++) {
+    auto reader_result = JsonKeysetReader::New(bad_json_keyset_, &cache);
+    ASSERT_THAT(reader_result.status(), IsOk());
+    EXPECT_THAT(reader_result.ValueOrDie()->Read().status(), Not(IsOk()));
+  }
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
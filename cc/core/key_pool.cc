@@ -0,0 +1,176 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/key_pool.h"
+
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/executor.h"
+#include "tink/internal/thread_pool.h"
+#include "tink/registry.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::KeyData;
+using google::crypto::tink::KeyTemplate;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace {
+
+// Returns the identifier of the stock for 'key_template'.  The output
+// prefix type is left out, as it does not affect the key material.
+std::string StockId(const KeyTemplate& key_template) {
+  return absl::StrCat(key_template.type_url(), std::string(1, '\0'),
+                      key_template.value());
+}
+
+void Zeroize(KeyData* key_data) {
+  util::SafeZeroString(key_data->mutable_value());
+}
+
+}  // namespace
+
+// static
+StatusOr<std::unique_ptr<KeyPool>> KeyPool::New(int num_threads,
+                                                int stock_size) {
+  if (num_threads <= 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "num_threads must be positive");
+  }
+  if (stock_size <= 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "stock_size must be positive");
+  }
+  return absl::WrapUnique(new KeyPool(
+      std::make_shared<internal::ThreadPool>(num_threads), stock_size));
+}
+
+// static
+StatusOr<std::unique_ptr<KeyPool>> KeyPool::New(
+    std::shared_ptr<Executor> executor, int stock_size) {
+  if (executor == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "executor must be non-null");
+  }
+  // Refill() schedules while holding the lock that the tasks take.
+  if (executor->num_threads() <= 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "executor must have worker threads");
+  }
+  if (stock_size <= 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "stock_size must be positive");
+  }
+  return absl::WrapUnique(new KeyPool(std::move(executor), stock_size));
+}
+
+KeyPool::KeyPool(std::shared_ptr<Executor> executor, int stock_size)
+    : stock_size_(stock_size), executor_(std::move(executor)) {}
+
+KeyPool::~KeyPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    shutdown_ = true;
+  }
+  // The tasks that have not started yet return at once.
+  absl::MutexLock lock(&mutex_);
+  mutex_.Await(absl::Condition(this, &KeyPool::NoTasksRunning));
+  for (auto& id_and_stock : stocks_) {
+    for (auto& key_data : id_and_stock.second.keys) Zeroize(key_data.get());
+  }
+}
+
+void KeyPool::AddTemplate(const KeyTemplate& key_template) {
+  std::string id = StockId(key_template);
+  absl::MutexLock lock(&mutex_);
+  auto inserted = stocks_.emplace(id, Stock());
+  if (inserted.second) inserted.first->second.key_template = key_template;
+  Refill(id, &inserted.first->second);
+}
+
+StatusOr<std::unique_ptr<KeyData>> KeyPool::NewKeyData(
+    const KeyTemplate& key_template) {
+  std::string id = StockId(key_template);
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = stocks_.find(id);
+    if (it != stocks_.end()) {
+      Stock& stock = it->second;
+      std::unique_ptr<KeyData> key_data;
+      if (!stock.keys.empty()) {
+        key_data = std::move(stock.keys.front());
+        stock.keys.pop_front();
+      }
+      Refill(id, &stock);
+      if (key_data != nullptr) return std::move(key_data);
+    }
+  }
+  return Registry::NewKeyData(key_template);
+}
+
+int KeyPool::StockSize(const KeyTemplate& key_template) const {
+  absl::MutexLock lock(&mutex_);
+  auto it = stocks_.find(StockId(key_template));
+  return it == stocks_.end() ? 0 : it->second.keys.size();
+}
+
+void KeyPool::Refill(const std::string& id, Stock* stock) {
+  if (shutdown_) return;
+  while (stock->keys.size() + stock->pending < stock_size_) {
+    stock->pending++;
+    running_tasks_++;
+    executor_->Schedule([this, id]() { Generate(id); });
+  }
+}
+
+void KeyPool::Generate(const std::string& id) {
+  KeyTemplate key_template;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (shutdown_) {
+      running_tasks_--;
+      return;
+    }
+    key_template = stocks_[id].key_template;
+  }
+  auto key_data_result = Registry::NewKeyData(key_template);
+  absl::MutexLock lock(&mutex_);
+  running_tasks_--;
+  Stock& stock = stocks_[id];
+  stock.pending--;
+  // A failed generation is not retried until the next key is taken, which
+  // then reports the error.
+  if (!key_data_result.ok()) return;
+  auto key_data = std::move(key_data_result.ValueOrDie());
+  if (shutdown_) {
+    Zeroize(key_data.get());
+    return;
+  }
+  stock.keys.push_back(std::move(key_data));
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,185 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/key_pool.h"
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tink/aead/aead_config.h"
+#include "tink/aead/aead_key_templates.h"
+#include "tink/executor.h"
+#include "tink/keyset_handle.h"
+#include "tink/keyset_manager.h"
+#include "tink/thread_pool_executor.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using google::crypto::tink::KeyTemplate;
+using google::crypto::tink::OutputPrefixType;
+
+class KeyPoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto status = AeadConfig::Register();
+    ASSERT_TRUE(status.ok()) << status;
+  }
+};
+
+// Waits until 'pool' has 'size' keys in stock for 'key_template'.
+void WaitForStock(const KeyPool& pool, const KeyTemplate& key_template,
+                  int size) {
+  for (int i = 0; i < 1000 && pool.StockSize(key_template) < size; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(size, pool.StockSize(key_template));
+}
+
+TEST_F(KeyPoolTest, InvalidArguments) {
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            KeyPool::New(0, 3).status().error_code());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            KeyPool::New(2, 0).status().error_code());
+}
+
+TEST_F(KeyPoolTest, KeysAreTakenFromTheStock) {
+  const KeyTemplate& key_template = AeadKeyTemplates::Aes128Gcm();
+  auto pool = std::move(KeyPool::New(2, 3).ValueOrDie());
+  EXPECT_EQ(0, pool->StockSize(key_template));
+  pool->AddTemplate(key_template);
+  WaitForStock(*pool, key_template, 3);
+
+  // Every key is handed out once, and the stock is refilled.
+  std::set<std::string> key_values;
+  for (int i = 0; i < 10; i++) {
+    auto result = pool->NewKeyData(key_template);
+    ASSERT_TRUE(result.ok()) << result.status();
+    EXPECT_EQ(key_template.type_url(), result.ValueOrDie()->type_url());
+    key_values.insert(result.ValueOrDie()->value());
+  }
+  EXPECT_EQ(10, key_values.size());
+  WaitForStock(*pool, key_template, 3);
+}
+
+TEST_F(KeyPoolTest, OutputPrefixTypeDoesNotMatter) {
+  KeyTemplate key_template = AeadKeyTemplates::Aes256Gcm();
+  auto pool = std::move(KeyPool::New(1, 2).ValueOrDie());
+  pool->AddTemplate(key_template);
+  WaitForStock(*pool, key_template, 2);
+  key_template.set_output_prefix_type(OutputPrefixType::RAW);
+  EXPECT_EQ(2, pool->StockSize(key_template));
+}
+
+TEST_F(KeyPoolTest, TemplatesWithoutStock) {
+  auto pool = std::move(KeyPool::New(1, 2).ValueOrDie());
+  auto result = pool->NewKeyData(AeadKeyTemplates::Aes128Gcm());
+  EXPECT_TRUE(result.ok()) << result.status();
+  EXPECT_EQ(0, pool->StockSize(AeadKeyTemplates::Aes128Gcm()));
+
+  // Keys of unknown types are not generated, neither in the background nor
+  // on demand.
+  KeyTemplate unknown_template;
+  unknown_template.set_type_url("some.unknown.key.type");
+  unknown_template.set_output_prefix_type(OutputPrefixType::TINK);
+  pool->AddTemplate(unknown_template);
+  EXPECT_FALSE(pool->NewKeyData(unknown_template).ok());
+  EXPECT_EQ(0, pool->StockSize(unknown_template));
+}
+
+TEST_F(KeyPoolTest, ConcurrentUse) {
+  const KeyTemplate& key_template = AeadKeyTemplates::Aes128Gcm();
+  auto pool = std::move(KeyPool::New(3, 5).ValueOrDie());
+  pool->AddTemplate(key_template);
+  std::vector<std::vector<std::string>> key_values(4);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < key_values.size(); i++) {
+    threads.emplace_back([&pool, &key_template, &key_values, i]() {
+      for (int j = 0; j < 50; j++) {
+        auto result = pool->NewKeyData(key_template);
+        if (result.ok()) key_values[i].push_back(result.ValueOrDie()->value());
+      }
+    });
+  }
+  std::set<std::string> all_key_values;
+  for (int i = 0; i < key_values.size(); i++) {
+    threads[i].join();
+    EXPECT_EQ(50, key_values[i].size());
+    all_key_values.insert(key_values[i].begin(), key_values[i].end());
+  }
+  EXPECT_EQ(200, all_key_values.size());
+}
+
+TEST_F(KeyPoolTest, DestroyedWhileGenerating) {
+  for (int i = 0; i < 10; i++) {
+    auto pool = std::move(KeyPool::New(4, 100).ValueOrDie());
+    pool->AddTemplate(AeadKeyTemplates::Aes128Gcm());
+    pool->AddTemplate(AeadKeyTemplates::Aes256Gcm());
+  }
+}
+
+TEST_F(KeyPoolTest, SharedExecutor) {
+  const KeyTemplate& key_template = AeadKeyTemplates::Aes128Gcm();
+  std::shared_ptr<Executor> executor = NewThreadPoolExecutor(2);
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            KeyPool::New(nullptr, 3).status().error_code());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            KeyPool::New(NewThreadPoolExecutor(0), 3).status().error_code());
+
+  // The executor outlives the pools, which wait for their tasks.
+  for (int i = 0; i < 10; i++) {
+    auto pool = std::move(KeyPool::New(executor, 100).ValueOrDie());
+    pool->AddTemplate(key_template);
+  }
+  auto pool = std::move(KeyPool::New(executor, 3).ValueOrDie());
+  pool->AddTemplate(key_template);
+  WaitForStock(*pool, key_template, 3);
+  EXPECT_TRUE(pool->NewKeyData(key_template).ok());
+  WaitForStock(*pool, key_template, 3);
+}
+
+TEST_F(KeyPoolTest, KeysetHandleAndKeysetManager) {
+  const KeyTemplate& key_template = AeadKeyTemplates::Aes128Gcm();
+  auto pool = std::move(KeyPool::New(1, 2).ValueOrDie());
+  pool->AddTemplate(key_template);
+  WaitForStock(*pool, key_template, 2);
+
+  auto handle_result = KeysetHandle::GenerateNew(key_template, pool.get());
+  ASSERT_TRUE(handle_result.ok()) << handle_result.status();
+  EXPECT_EQ(1, handle_result.ValueOrDie()->GetKeysetInfo().key_info_size());
+
+  KeysetManager manager(pool.get());
+  auto rotate_result = manager.Rotate(key_template);
+  ASSERT_TRUE(rotate_result.ok()) << rotate_result.status();
+  auto add_result = manager.Add(key_template);
+  ASSERT_TRUE(add_result.ok()) << add_result.status();
+  EXPECT_EQ(2, manager.KeyCount());
+  EXPECT_EQ(rotate_result.ValueOrDie(),
+            manager.GetKeysetHandle()->GetKeysetInfo().primary_key_id());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -15,16 +15,26 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "tink/keyset_handle.h"
 
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "tink/aead.h"
+#include "tink/encrypted_keyset_cache.h"
 #include "tink/internal/key_info.h"
+#include "tink/internal/traced_operation.h"
+#include "tink/key_pool.h"
 #include "tink/keyset_reader.h"
 #include "tink/keyset_writer.h"
 #include "tink/registry.h"
+#include "tink/subtle/random.h"
 #include "tink/util/errors.h"
 #include "tink/util/keyset_util.h"
+#include "tink/util/secret_data.h"
 #include "proto/tink.pb.h"
 
 using google::crypto::tink::EncryptedKeyset;
@@ -50,12 +60,10 @@ Encrypt(const Keyset& keyset, const Aead& master_key_aead) {
 }
 
 util::StatusOr<std::unique_ptr<Keyset>>
-Decrypt(const EncryptedKeyset& enc_keyset, const Aead& master_key_aead) {
-  auto decrypt_result = master_key_aead.Decrypt(
-          enc_keyset.encrypted_keyset(), /* associated_data= */ "");
-  if (!decrypt_result.ok()) return decrypt_result.status();
+ParseKeyset(absl::string_view serialized_keyset) {
   auto keyset = absl::make_unique<Keyset>();
-  if (!keyset->ParseFromString(decrypt_result.ValueOrDie())) {
+  if (!keyset->ParseFromArray(serialized_keyset.data(),
+                              serialized_keyset.size())) {
     return util::Status(util::error::INVALID_ARGUMENT,
         "Could not parse the decrypted data as a Keyset-proto.");
   }
@@ -81,24 +89,59 @@ util::Status ValidateNoSecret(const Keyset& keyset) {
 // static
 util::StatusOr<std::unique_ptr<KeysetHandle>> KeysetHandle::Read(
     std::unique_ptr<KeysetReader> reader, const Aead& master_key_aead) {
+  return Read(std::move(reader), master_key_aead, /* cache= */ nullptr);
+}
+
+// static
+util::StatusOr<std::unique_ptr<KeysetHandle>> KeysetHandle::Read(
+    std::unique_ptr<KeysetReader> reader, const Aead& master_key_aead,
+    EncryptedKeysetCache* cache) {
+  internal::TracedOperation operation("tink.keyset_handle.read");
   auto enc_keyset_result = reader->ReadEncrypted();
   if (!enc_keyset_result.ok()) {
-    return ToStatusF(util::error::INVALID_ARGUMENT,
-                     "Error reading encrypted keyset data: %s",
-                     enc_keyset_result.status().error_message());
+    util::Status status = ToStatusF(
+        util::error::INVALID_ARGUMENT,
+        "Error reading encrypted keyset data: %s",
+        enc_keyset_result.status().error_message());
+    operation.SetStatus(status);
+    return status;
   }
+  const std::string& encrypted_keyset =
+      enc_keyset_result.ValueOrDie()->encrypted_keyset();
+  operation.SetAttribute("tink.bytes", encrypted_keyset.size());
 
-  auto keyset_result =
-      Decrypt(*enc_keyset_result.ValueOrDie(), master_key_aead);
+  util::StatusOr<std::unique_ptr<Keyset>> keyset_result;
+  absl::optional<util::SecretData> cached_keyset;
+  if (cache != nullptr) cached_keyset = cache->Lookup(encrypted_keyset);
+  if (cached_keyset.has_value()) {
+    operation.SetAttribute("tink.keyset_cache", "hit");
+    keyset_result = ParseKeyset(util::SecretDataAsStringView(*cached_keyset));
+  } else {
+    auto decrypt_result =
+        master_key_aead.Decrypt(encrypted_keyset, /* associated_data= */ "");
+    if (decrypt_result.ok()) {
+      std::string& serialized_keyset = decrypt_result.ValueOrDie();
+      keyset_result = ParseKeyset(serialized_keyset);
+      if (keyset_result.ok() && cache != nullptr) {
+        cache->Insert(encrypted_keyset,
+                      util::SecretDataFromStringView(serialized_keyset));
+      }
+      util::SafeZeroString(&serialized_keyset);
+    } else {
+      keyset_result = decrypt_result.status();
+    }
+  }
   if (!keyset_result.ok()) {
-    return ToStatusF(util::error::INVALID_ARGUMENT,
-                     "Error decrypting encrypted keyset: %s",
-                     keyset_result.status().error_message());
+    util::Status status = ToStatusF(util::error::INVALID_ARGUMENT,
+                                    "Error decrypting encrypted keyset: %s",
+                                    keyset_result.status().error_message());
+    operation.SetStatus(status);
+    return status;
   }
-
-  std::unique_ptr<KeysetHandle> handle(
+  operation.SetAttribute("tink.num_keys",
+                         keyset_result.ValueOrDie()->key_size());
+  return absl::WrapUnique(
       new KeysetHandle(std::move(keyset_result.ValueOrDie())));
-  return std::move(handle);
 }
 
 // static
@@ -144,14 +187,56 @@ util::Status KeysetHandle::WriteNoSecret(KeysetWriter* writer) const {
 // static
 util::StatusOr<std::unique_ptr<KeysetHandle>> KeysetHandle::GenerateNew(
     const KeyTemplate& key_template) {
+  return GenerateNew(key_template, /*key_pool=*/nullptr);
+}
+
+// static
+util::StatusOr<std::unique_ptr<KeysetHandle>> KeysetHandle::GenerateNew(
+    const KeyTemplate& key_template, KeyPool* key_pool) {
   Keyset keyset;
-  auto result = AddToKeyset(key_template, /*as_primary=*/true, &keyset);
+  auto result =
+      AddToKeyset(key_template, /*as_primary=*/true, key_pool, &keyset);
   if (!result.ok()) {
     return result.status();
   }
   return absl::WrapUnique<KeysetHandle>(new KeysetHandle(std::move(keyset)));
 }
 
+// static
+util::StatusOr<std::vector<std::unique_ptr<KeysetHandle>>>
+KeysetHandle::GenerateNewBatch(const KeyTemplate& key_template, int count,
+                               std::shared_ptr<Executor> executor) {
+  if (key_template.output_prefix_type() ==
+      google::crypto::tink::OutputPrefixType::UNKNOWN_PREFIX) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "key template has unknown prefix");
+  }
+  auto key_data_result =
+      Registry::NewKeyDataBatch(key_template, count, std::move(executor));
+  if (!key_data_result.ok()) return key_data_result.status();
+  auto& key_data = key_data_result.ValueOrDie();
+  // Each keyset has a single key, so that the ids need not be checked for
+  // collisions.
+  std::string key_ids =
+      subtle::Random::GetRandomBytes(count * sizeof(uint32_t));
+  std::vector<std::unique_ptr<KeysetHandle>> handles;
+  handles.reserve(count);
+  for (int i = 0; i < count; i++) {
+    uint32_t key_id;
+    std::memcpy(&key_id, &key_ids[i * sizeof(uint32_t)], sizeof(key_id));
+    Keyset keyset;
+    Keyset::Key* key = keyset.add_key();
+    key->mutable_key_data()->Swap(key_data[i].get());
+    key->set_status(google::crypto::tink::KeyStatusType::ENABLED);
+    key->set_key_id(key_id);
+    key->set_output_prefix_type(key_template.output_prefix_type());
+    keyset.set_primary_key_id(key_id);
+    handles.push_back(
+        absl::WrapUnique<KeysetHandle>(new KeysetHandle(std::move(keyset))));
+  }
+  return std::move(handles);
+}
+
 util::StatusOr<std::unique_ptr<Keyset::Key>> ExtractPublicKey(
     const Keyset::Key& key) {
   if (key.key_data().key_material_type() != KeyData::ASYMMETRIC_PRIVATE) {
@@ -182,18 +267,20 @@ KeysetHandle::GetPublicKeysetHandle() const {
 
 crypto::tink::util::StatusOr<uint32_t> KeysetHandle::AddToKeyset(
     const google::crypto::tink::KeyTemplate& key_template,
-    bool as_primary, Keyset* keyset) {
+    bool as_primary, KeyPool* key_pool, Keyset* keyset) {
   if (key_template.output_prefix_type() ==
       google::crypto::tink::OutputPrefixType::UNKNOWN_PREFIX) {
     return util::Status(util::error::INVALID_ARGUMENT,
                         "key template has unknown prefix");
   }
-  auto key_data_result = Registry::NewKeyData(key_template);
+  auto key_data_result = key_pool != nullptr
+                             ? key_pool->NewKeyData(key_template)
+                             : Registry::NewKeyData(key_template);
   if (!key_data_result.ok()) return key_data_result.status();
   auto key_data = std::move(key_data_result.ValueOrDie());
   Keyset::Key* key = keyset->add_key();
   uint32_t key_id = GenerateUnusedKeyId(*keyset);
-  *(key->mutable_key_data()) = *key_data;
+  key->mutable_key_data()->Swap(key_data.get());
   key->set_status(google::crypto::tink::KeyStatusType::ENABLED);
   key->set_key_id(key_id);
   key->set_output_prefix_type(key_template.output_prefix_type());
@@ -207,11 +294,19 @@ KeysetInfo KeysetHandle::GetKeysetInfo() const {
   return KeysetInfoFromKeyset(get_keyset());
 }
 
+size_t KeysetHandle::EstimateMemoryUsage() const {
+  // SpaceUsedLong() includes sizeof(keyset_), which is part of *this.
+  return sizeof(*this) - sizeof(keyset_) + keyset_.SpaceUsedLong() +
+         sizeof(PrimitiveCache);
+}
+
 KeysetHandle::KeysetHandle(Keyset keyset)
-    : keyset_(std::move(keyset)) {}
+    : keyset_(std::move(keyset)),
+      primitive_cache_(std::make_shared<PrimitiveCache>()) {}
 
 KeysetHandle::KeysetHandle(std::unique_ptr<Keyset> keyset)
-    : keyset_(std::move(*keyset)) {}
+    : keyset_(std::move(*keyset)),
+      primitive_cache_(std::make_shared<PrimitiveCache>()) {}
 
 const Keyset& KeysetHandle::get_keyset() const {
   return keyset_;
@@ -17,7 +17,13 @@
 #include "tink/core/key_manager_impl.h"
 #include "tink/keyset_handle.h"
 
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
 #include "tink/aead/aead_key_templates.h"
 #include "tink/aead/aead_wrapper.h"
 #include "tink/aead/aes_gcm_key_manager.h"
@@ -25,10 +31,14 @@
 #include "tink/binary_keyset_reader.h"
 #include "tink/cleartext_keyset_handle.h"
 #include "tink/config/tink_config.h"
+#include "tink/crypto_format.h"
 #include "tink/json_keyset_reader.h"
 #include "tink/json_keyset_writer.h"
+#include "tink/keyset_manager.h"
+#include "tink/public_key_sign.h"
 #include "tink/signature/ecdsa_sign_key_manager.h"
 #include "tink/signature/signature_key_templates.h"
+#include "tink/thread_pool_executor.h"
 #include "tink/util/protobuf_helper.h"
 #include "tink/util/test_keyset_handle.h"
 #include "tink/util/test_matchers.h"
@@ -50,6 +60,7 @@ using google::crypto::tink::EcdsaKeyFormat;
 using google::crypto::tink::EncryptedKeyset;
 using google::crypto::tink::KeyData;
 using google::crypto::tink::Keyset;
+using google::crypto::tink::KeysetInfo;
 using google::crypto::tink::KeyStatusType;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::OutputPrefixType;
@@ -279,6 +290,53 @@ TEST_F(KeysetHandleTest, GenerateNewKeysetHandleErrors) {
   EXPECT_EQ(util::error::NOT_FOUND, handle_result.status().error_code());
 }
 
+TEST_F(KeysetHandleTest, GenerateNewBatch) {
+  std::shared_ptr<Executor> executor = NewThreadPoolExecutor(4);
+  for (std::shared_ptr<Executor> batch_executor :
+       std::vector<std::shared_ptr<Executor>>{executor, nullptr}) {
+    auto handles_result = KeysetHandle::GenerateNewBatch(
+        SignatureKeyTemplates::EcdsaP256(), 10, batch_executor);
+    ASSERT_TRUE(handles_result.ok()) << handles_result.status();
+    auto& handles = handles_result.ValueOrDie();
+    ASSERT_EQ(10, handles.size());
+    std::set<std::string> keys;
+    for (const auto& handle : handles) {
+      const Keyset& keyset = TestKeysetHandle::GetKeyset(*handle);
+      ASSERT_EQ(1, keyset.key_size());
+      EXPECT_EQ(keyset.key(0).key_id(), keyset.primary_key_id());
+      EXPECT_EQ(KeyStatusType::ENABLED, keyset.key(0).status());
+      EXPECT_EQ(OutputPrefixType::TINK, keyset.key(0).output_prefix_type());
+      EXPECT_EQ(EcdsaSignKeyManager().get_key_type(),
+                keyset.key(0).key_data().type_url());
+      keys.insert(keyset.key(0).key_data().value());
+      EXPECT_TRUE(handle->GetPrimitive<PublicKeySign>().ok());
+    }
+    EXPECT_EQ(10, keys.size());
+  }
+
+  auto empty_result =
+      KeysetHandle::GenerateNewBatch(AeadKeyTemplates::Aes128Gcm(), 0);
+  ASSERT_TRUE(empty_result.ok()) << empty_result.status();
+  EXPECT_TRUE(empty_result.ValueOrDie().empty());
+}
+
+TEST_F(KeysetHandleTest, GenerateNewBatchErrors) {
+  KeyTemplate templ;
+  templ.set_type_url("type.googleapis.com/some.unknown.KeyType");
+  templ.set_output_prefix_type(OutputPrefixType::TINK);
+  EXPECT_THAT(KeysetHandle::GenerateNewBatch(templ, 3).status(),
+              StatusIs(util::error::NOT_FOUND));
+
+  EXPECT_THAT(
+      KeysetHandle::GenerateNewBatch(AeadKeyTemplates::Aes128Gcm(), -1)
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+
+  templ = AeadKeyTemplates::Aes128Gcm();
+  templ.set_output_prefix_type(OutputPrefixType::UNKNOWN_PREFIX);
+  EXPECT_FALSE(KeysetHandle::GenerateNewBatch(templ, 3).ok());
+}
+
 TEST_F(KeysetHandleTest, UnknownPrefixIsInvalid) {
   KeyTemplate templ(AeadKeyTemplates::Aes128Gcm());
   templ.set_output_prefix_type(OutputPrefixType::UNKNOWN_PREFIX);
@@ -428,6 +486,161 @@ TEST_F(KeysetHandleTest, GetPrimitive) {
   EXPECT_EQ(aead->Decrypt(raw_encryption, aad).ValueOrDie(), plaintext);
 }
 
+TEST_F(KeysetHandleTest, GetSharedPrimitive) {
+  auto handle_result = KeysetHandle::GenerateNew(AeadKeyTemplates::Aes128Gcm());
+  ASSERT_THAT(handle_result.status(), IsOk());
+  std::unique_ptr<KeysetHandle> handle = std::move(handle_result.ValueOrDie());
+
+  auto aead_result = handle->GetSharedPrimitive<Aead>();
+  ASSERT_THAT(aead_result.status(), IsOk());
+  std::shared_ptr<Aead> aead = aead_result.ValueOrDie();
+  std::string encryption = aead->Encrypt("plaintext", "aad").ValueOrDie();
+  EXPECT_EQ(
+      handle->GetPrimitive<Aead>().ValueOrDie()->Decrypt(encryption, "aad")
+          .ValueOrDie(),
+      "plaintext");
+
+  // Later calls, also on copies of the handle, return the same primitive.
+  EXPECT_EQ(handle->GetSharedPrimitive<Aead>().ValueOrDie(), aead);
+  KeysetHandle handle_copy = *handle;
+  EXPECT_EQ(handle_copy.GetSharedPrimitive<Aead>().ValueOrDie(), aead);
+
+  // A handle with a modified keyset has its own primitive.
+  auto manager_result = KeysetManager::New(*handle);
+  ASSERT_THAT(manager_result.status(), IsOk());
+  std::unique_ptr<KeysetManager> manager =
+      std::move(manager_result.ValueOrDie());
+  ASSERT_THAT(manager->Rotate(AeadKeyTemplates::Aes256Gcm()).status(), IsOk());
+  std::unique_ptr<KeysetHandle> rotated_handle = manager->GetKeysetHandle();
+  auto rotated_aead_result = rotated_handle->GetSharedPrimitive<Aead>();
+  ASSERT_THAT(rotated_aead_result.status(), IsOk());
+  EXPECT_NE(rotated_aead_result.ValueOrDie(), aead);
+}
+
+TEST_F(KeysetHandleTest, GetPrimitiveWithLoadingOptions) {
+  Keyset keyset;
+  std::vector<std::string> encryptions;
+  for (uint32_t key_id = 0; key_id < 20; key_id++) {
+    KeyData key_data =
+        *Registry::NewKeyData(AeadKeyTemplates::Aes128Gcm()).ValueOrDie();
+    AddKeyData(key_data, key_id,
+               key_id % 2 == 0 ? OutputPrefixType::TINK : OutputPrefixType::RAW,
+               KeyStatusType::ENABLED, &keyset);
+    keyset.set_primary_key_id(key_id);
+    encryptions.push_back(TestKeysetHandle::GetKeysetHandle(keyset)
+                              ->GetPrimitive<Aead>()
+                              .ValueOrDie()
+                              ->Encrypt("plaintext", "aad")
+                              .ValueOrDie());
+  }
+  keyset.set_primary_key_id(10);
+  std::unique_ptr<KeysetHandle> keyset_handle =
+      TestKeysetHandle::GetKeysetHandle(keyset);
+
+  for (int parallelism : {1, 4, 64}) {
+    for (bool lazy : {false, true}) {
+      SCOPED_TRACE(absl::StrCat("parallelism=", parallelism, " lazy=", lazy));
+      KeysetHandle::LoadingOptions options;
+      options.parallelism = parallelism;
+      options.lazy = lazy;
+      auto aead_result = keyset_handle->GetPrimitive<Aead>(options);
+      ASSERT_THAT(aead_result.status(), IsOk());
+      std::unique_ptr<Aead> aead = std::move(aead_result.ValueOrDie());
+      for (const std::string& encryption : encryptions) {
+        EXPECT_EQ(aead->Decrypt(encryption, "aad").ValueOrDie(), "plaintext");
+      }
+      std::string encryption = aead->Encrypt("plaintext", "aad").ValueOrDie();
+      EXPECT_EQ(encryption.substr(0, CryptoFormat::kNonRawPrefixSize),
+                encryptions[10].substr(0, CryptoFormat::kNonRawPrefixSize));
+    }
+  }
+}
+
+TEST_F(KeysetHandleTest, GetPrimitiveWithLoadingOptionsInvalidKey) {
+  Keyset keyset;
+  KeyData key_data_0 =
+      *Registry::NewKeyData(AeadKeyTemplates::Aes128Gcm()).ValueOrDie();
+  AddKeyData(key_data_0, /*key_id=*/0, OutputPrefixType::TINK,
+             KeyStatusType::ENABLED, &keyset);
+  KeyData key_data_1 = key_data_0;
+  key_data_1.set_value("invalid key");
+  AddKeyData(key_data_1, /*key_id=*/1, OutputPrefixType::TINK,
+             KeyStatusType::ENABLED, &keyset);
+  keyset.set_primary_key_id(0);
+  std::unique_ptr<KeysetHandle> keyset_handle =
+      TestKeysetHandle::GetKeysetHandle(keyset);
+
+  KeysetHandle::LoadingOptions options;
+  options.parallelism = 2;
+  EXPECT_FALSE(keyset_handle->GetPrimitive<Aead>(options).ok());
+
+  // Lazily, the invalid key only fails ciphertexts which refer to it.
+  options.lazy = true;
+  auto aead_result = keyset_handle->GetPrimitive<Aead>(options);
+  ASSERT_THAT(aead_result.status(), IsOk());
+  std::unique_ptr<Aead> aead = std::move(aead_result.ValueOrDie());
+  std::string encryption = aead->Encrypt("plaintext", "aad").ValueOrDie();
+  EXPECT_EQ(aead->Decrypt(encryption, "aad").ValueOrDie(), "plaintext");
+  KeysetInfo::KeyInfo key_info;
+  key_info.set_output_prefix_type(OutputPrefixType::TINK);
+  key_info.set_key_id(1);
+  EXPECT_FALSE(
+      aead->Decrypt(absl::StrCat(
+                        CryptoFormat::GetOutputPrefix(key_info).ValueOrDie(),
+                        encryption.substr(CryptoFormat::kNonRawPrefixSize)),
+                    "aad")
+          .ok());
+
+  // The primary key is never created lazily.
+  keyset.set_primary_key_id(1);
+  EXPECT_FALSE(TestKeysetHandle::GetKeysetHandle(keyset)
+                   ->GetPrimitive<Aead>(options)
+                   .ok());
+}
+
+TEST_F(KeysetHandleTest, GetPrimitiveWithWarmUp) {
+  Keyset keyset;
+  KeyData key_data_0 =
+      *Registry::NewKeyData(AeadKeyTemplates::Aes128Gcm()).ValueOrDie();
+  AddKeyData(key_data_0, /*key_id=*/0, OutputPrefixType::TINK,
+             KeyStatusType::ENABLED, &keyset);
+  KeyData key_data_1 =
+      *Registry::NewKeyData(AeadKeyTemplates::Aes256Gcm()).ValueOrDie();
+  AddKeyData(key_data_1, /*key_id=*/1, OutputPrefixType::RAW,
+             KeyStatusType::ENABLED, &keyset);
+  keyset.set_primary_key_id(0);
+
+  KeysetHandle::LoadingOptions options;
+  options.parallelism = 2;
+  options.warm_up = true;
+  auto aead_result =
+      TestKeysetHandle::GetKeysetHandle(keyset)->GetPrimitive<Aead>(options);
+  ASSERT_THAT(aead_result.status(), IsOk());
+  std::string encryption =
+      aead_result.ValueOrDie()->Encrypt("plaintext", "aad").ValueOrDie();
+  EXPECT_EQ(aead_result.ValueOrDie()->Decrypt(encryption, "aad").ValueOrDie(),
+            "plaintext");
+
+  // Warm-up creates the primitives of all keys, even if lazy is set.
+  keyset.mutable_key(1)->mutable_key_data()->set_value("invalid key");
+  options.lazy = true;
+  EXPECT_FALSE(TestKeysetHandle::GetKeysetHandle(keyset)
+                   ->GetPrimitive<Aead>(options)
+                   .ok());
+}
+
+TEST_F(KeysetHandleTest, GetPrimitiveWithWarmUpSignature) {
+  auto handle_result =
+      KeysetHandle::GenerateNew(SignatureKeyTemplates::EcdsaP256());
+  ASSERT_THAT(handle_result.status(), IsOk());
+  KeysetHandle::LoadingOptions options;
+  options.warm_up = true;
+  auto sign_result =
+      handle_result.ValueOrDie()->GetPrimitive<PublicKeySign>(options);
+  ASSERT_THAT(sign_result.status(), IsOk());
+  EXPECT_THAT(sign_result.ValueOrDie()->Sign("data").status(), IsOk());
+}
+
 // Tests that GetPrimitive(nullptr) fails with a non-ok status.
 TEST_F(KeysetHandleTest, GetPrimitiveNullptrKeyManager) {
   Keyset keyset;
@@ -675,6 +888,25 @@ TEST_F(KeysetHandleTest, GetKeysetInfo) {
   }
 }
 
+TEST_F(KeysetHandleTest, EstimateMemoryUsage) {
+  Keyset keyset;
+  Keyset::Key key;
+  AddTinkKey("some key type", 42, key, KeyStatusType::ENABLED,
+             KeyData::SYMMETRIC, &keyset);
+  keyset.set_primary_key_id(42);
+  size_t small_usage =
+      TestKeysetHandle::GetKeysetHandle(keyset)->EstimateMemoryUsage();
+  EXPECT_LT(sizeof(KeysetHandle), small_usage);
+
+  for (int i = 0; i < 100; ++i) {
+    AddTinkKey(absl::StrCat("more key type", i), i, key, KeyStatusType::ENABLED,
+               KeyData::SYMMETRIC, &keyset);
+  }
+  size_t large_usage =
+      TestKeysetHandle::GetKeysetHandle(keyset)->EstimateMemoryUsage();
+  EXPECT_LT(small_usage + 100 * sizeof(Keyset::Key), large_usage);
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
@@ -16,9 +16,14 @@
 
 #include "tink/keyset_manager.h"
 
+#include <algorithm>
+#include <map>
 #include <random>
+#include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
+#include "tink/internal/traced_operation.h"
 #include "tink/keyset_handle.h"
 #include "tink/keyset_reader.h"
 #include "tink/registry.h"
@@ -68,8 +73,16 @@ StatusOr<uint32_t> KeysetManager::Add(const KeyTemplate& key_template) {
 
 crypto::tink::util::StatusOr<uint32_t> KeysetManager::Add(
     const google::crypto::tink::KeyTemplate& key_template, bool as_primary) {
+  internal::TracedOperation operation("tink.keyset_manager.add");
+  operation.SetAttribute("tink.type_url", key_template.type_url());
   absl::MutexLock lock(&keyset_mutex_);
-  return KeysetHandle::AddToKeyset(key_template, as_primary, &keyset_);
+  auto key_id_result = KeysetHandle::AddToKeyset(key_template, as_primary,
+                                                 key_pool_, &keyset_);
+  operation.SetStatus(key_id_result.status());
+  if (key_id_result.ok()) {
+    operation.SetAttribute("tink.key_id", key_id_result.ValueOrDie());
+  }
+  return key_id_result;
 }
 
 StatusOr<uint32_t> KeysetManager::Rotate(const KeyTemplate& key_template) {
@@ -180,6 +193,47 @@ Status KeysetManager::SetPrimary(uint32_t key_id) {
 }
 
 
+KeysetManager::CompactionReport KeysetManager::Compact(
+    const std::map<uint32_t, int64_t>& usage, bool disable_unused) {
+  internal::TracedOperation operation("tink.keyset_manager.compact");
+  absl::MutexLock lock(&keyset_mutex_);
+  auto usage_of = [&usage](const Keyset::Key& key) -> int64_t {
+    auto it = usage.find(key.key_id());
+    return it == usage.end() ? 0 : it->second;
+  };
+  CompactionReport report;
+  for (auto& key : *(keyset_.mutable_key())) {
+    if (key.status() != KeyStatusType::ENABLED ||
+        key.key_id() == keyset_.primary_key_id() || usage_of(key) > 0) {
+      continue;
+    }
+    report.unused_key_ids.push_back(key.key_id());
+    if (disable_unused) {
+      key.set_status(KeyStatusType::DISABLED);
+      report.disabled_key_ids.push_back(key.key_id());
+    }
+  }
+
+  std::vector<Keyset::Key> keys(
+      std::make_move_iterator(keyset_.mutable_key()->begin()),
+      std::make_move_iterator(keyset_.mutable_key()->end()));
+  std::stable_sort(keys.begin(), keys.end(),
+                   [&usage_of](const Keyset::Key& a, const Keyset::Key& b) {
+                     bool a_enabled = a.status() == KeyStatusType::ENABLED;
+                     bool b_enabled = b.status() == KeyStatusType::ENABLED;
+                     if (a_enabled != b_enabled) return a_enabled;
+                     return usage_of(a) > usage_of(b);
+                   });
+  keyset_.clear_key();
+  for (Keyset::Key& key : keys) *keyset_.add_key() = std::move(key);
+
+  operation.SetAttribute("tink.unused_keys",
+                         static_cast<int64_t>(report.unused_key_ids.size()));
+  operation.SetAttribute("tink.disabled_keys",
+                         static_cast<int64_t>(report.disabled_key_ids.size()));
+  return report;
+}
+
 int KeysetManager::KeyCount() const {
   absl::MutexLock lock(&keyset_mutex_);
   return keyset_.key_size();
@@ -15,6 +15,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "tink/keyset_manager.h"
 
+#include <cstdint>
+#include <map>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "tink/aead/aead_config.h"
 #include "tink/aead/aes_gcm_key_manager.h"
@@ -230,5 +234,54 @@ TEST_F(KeysetManagerTest, testBasicOperations) {
   EXPECT_EQ(1, keyset_manager->KeyCount());
 }
 
+TEST_F(KeysetManagerTest, testCompact) {
+  AesGcmKeyFormat key_format;
+  key_format.set_key_size(16);
+  KeyTemplate key_template;
+  key_template.set_type_url(AesGcmKeyManager().get_key_type());
+  key_template.set_output_prefix_type(OutputPrefixType::RAW);
+  key_template.set_value(key_format.SerializeAsString());
+
+  auto keyset_manager =
+      std::move(KeysetManager::New(key_template).ValueOrDie());
+  std::vector<uint32_t> key_ids = {
+      keyset_manager->GetKeysetHandle()->GetKeysetInfo().primary_key_id()};
+  for (int i = 0; i < 4; i++) {
+    key_ids.push_back(keyset_manager->Add(key_template).ValueOrDie());
+  }
+  // Keys 0 (the primary) and 3 are unused, key 4 is disabled.
+  EXPECT_TRUE(keyset_manager->Disable(key_ids[4]).ok());
+  std::map<uint32_t, int64_t> usage = {
+      {key_ids[1], 5}, {key_ids[2], 20}, {key_ids[4], 100}};
+
+  // A dry run only reorders the keys.
+  KeysetManager::CompactionReport report =
+      keyset_manager->Compact(usage, /*disable_unused=*/false);
+  EXPECT_EQ(std::vector<uint32_t>({key_ids[3]}), report.unused_key_ids);
+  EXPECT_TRUE(report.disabled_key_ids.empty());
+  auto keyset =
+      TestKeysetHandle::GetKeyset(*(keyset_manager->GetKeysetHandle()));
+  ASSERT_EQ(5, keyset.key_size());
+  EXPECT_EQ(key_ids[0], keyset.primary_key_id());
+  EXPECT_EQ(key_ids[2], keyset.key(0).key_id());
+  EXPECT_EQ(key_ids[1], keyset.key(1).key_id());
+  EXPECT_EQ(key_ids[0], keyset.key(2).key_id());
+  EXPECT_EQ(key_ids[3], keyset.key(3).key_id());
+  EXPECT_EQ(key_ids[4], keyset.key(4).key_id());
+  EXPECT_EQ(KeyStatusType::ENABLED, keyset.key(3).status());
+
+  report = keyset_manager->Compact(usage, /*disable_unused=*/true);
+  EXPECT_EQ(std::vector<uint32_t>({key_ids[3]}), report.unused_key_ids);
+  EXPECT_EQ(std::vector<uint32_t>({key_ids[3]}), report.disabled_key_ids);
+  keyset = TestKeysetHandle::GetKeyset(*(keyset_manager->GetKeysetHandle()));
+  ASSERT_EQ(5, keyset.key_size());
+  EXPECT_EQ(key_ids[0], keyset.primary_key_id());
+  EXPECT_EQ(key_ids[0], keyset.key(2).key_id());
+  EXPECT_EQ(KeyStatusType::ENABLED, keyset.key(2).status());
+  EXPECT_EQ(key_ids[4], keyset.key(3).key_id());
+  EXPECT_EQ(key_ids[3], keyset.key(4).key_id());
+  EXPECT_EQ(KeyStatusType::DISABLED, keyset.key(4).status());
+}
+
 }  // namespace tink
 }  // namespace crypto
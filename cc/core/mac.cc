@@ -0,0 +1,90 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/mac.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+class PrefixedMac : public Mac {
+ public:
+  PrefixedMac(const Mac& mac, absl::string_view prefix)
+      : mac_(mac), prefix_(prefix) {}
+
+  util::StatusOr<std::string> ComputeMac(
+      absl::string_view data) const override {
+    return mac_.ComputeMac(absl::StrCat(prefix_, data));
+  }
+
+  util::Status VerifyMac(absl::string_view mac_value,
+                         absl::string_view data) const override {
+    return mac_.VerifyMac(mac_value, absl::StrCat(prefix_, data));
+  }
+
+  using Mac::VerifyMac;
+
+ private:
+  const Mac& mac_;
+  const std::string prefix_;
+};
+
+}  // namespace
+
+util::StatusOr<int64_t> Mac::ComputeMacInto(absl::string_view data,
+                                            absl::Span<uint8_t> tag) const {
+  auto mac_result = ComputeMac(data);
+  if (!mac_result.ok()) return mac_result.status();
+  const std::string& mac = mac_result.ValueOrDie();
+  if (tag.size() < mac.size()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Tag buffer too small");
+  }
+  std::copy(mac.begin(), mac.end(), tag.begin());
+  return static_cast<int64_t>(mac.size());
+}
+
+util::StatusOr<std::vector<std::string>> Mac::ComputeMacs(
+    absl::Span<const absl::string_view> data) const {
+  std::vector<std::string> macs;
+  macs.reserve(data.size());
+  for (absl::string_view message : data) {
+    auto mac_result = ComputeMac(message);
+    if (!mac_result.ok()) return mac_result.status();
+    macs.push_back(std::move(mac_result.ValueOrDie()));
+  }
+  return std::move(macs);
+}
+
+util::StatusOr<std::unique_ptr<Mac>> Mac::WithPrefix(
+    absl::string_view prefix) const {
+  return {absl::make_unique<PrefixedMac>(*this, prefix)};
+}
+
+}  // namespace tink
+}  // namespace crypto
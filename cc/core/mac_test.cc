@@ -0,0 +1,54 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/mac.h"
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/util/inlined_buffer.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::DummyMac;
+using ::crypto::tink::test::IsOk;
+
+TEST(MacTest, ComputeMacIntoInlinedBuffer) {
+  DummyMac mac_impl("dummy");
+  const Mac& mac = mac_impl;
+  util::InlinedBuffer<64> tag;
+  ASSERT_THAT(mac.ComputeMac("data", &tag), IsOk());
+  EXPECT_EQ(tag.AsStringView(), mac.ComputeMac("data").ValueOrDie());
+  EXPECT_EQ(tag.capacity(), 64);
+  EXPECT_THAT(mac.VerifyMac(tag.AsStringView(), "data"), IsOk());
+}
+
+TEST(MacTest, ComputeMacIntoTooSmallInlinedBuffer) {
+  DummyMac mac_impl("dummy");
+  const Mac& mac = mac_impl;
+  util::InlinedBuffer<4> tag;
+  ASSERT_THAT(mac.ComputeMac("data", &tag), IsOk());
+  EXPECT_EQ(tag.AsStringView(), mac.ComputeMac("data").ValueOrDie());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
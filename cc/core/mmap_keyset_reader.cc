@@ -0,0 +1,289 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/mmap_keyset_reader.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <limits>
+
+#include "absl/memory/memory.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
+#include "tink/internal/key_info.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using ::google::crypto::tink::EncryptedKeyset;
+using ::google::crypto::tink::KeyData;
+using ::google::crypto::tink::Keyset;
+using ::google::crypto::tink::KeyStatusType;
+using ::google::crypto::tink::OutputPrefixType;
+using ::google::protobuf::internal::WireFormatLite;
+using ::google::protobuf::io::CodedInputStream;
+
+namespace {
+
+// Attempts to close file descriptor fd, while ignoring EINTR.
+int close_ignoring_eintr(int fd) {
+  int result;
+  do {
+    result = close(fd);
+  } while (result < 0 && errno == EINTR);
+  return result;
+}
+
+util::Status ParseError() {
+  return util::Status(util::error::INVALID_ARGUMENT,
+                      "Could not parse the mapped file as a Keyset-proto.");
+}
+
+// Reads the tags of the message in 'serialized' one by one, and calls
+// 'handle_field' for each of them. 'handle_field' returns false if the
+// field could not be read; it may skip the field with SkipField().
+template <typename HandleField>
+bool ForEachField(absl::string_view serialized, HandleField handle_field) {
+  CodedInputStream input(reinterpret_cast<const uint8_t*>(serialized.data()),
+                         serialized.size());
+  while (true) {
+    uint32_t tag = input.ReadTag();
+    if (tag == 0) return input.ConsumedEntireMessage();
+    if (!handle_field(tag, &input)) return false;
+  }
+}
+
+bool SkipField(uint32_t tag, CodedInputStream* input) {
+  return WireFormatLite::SkipField(input, tag);
+}
+
+// Returns true iff 'tag' is the tag of field 'field_number' with 'wire_type'.
+// Fields with an unexpected wire type are unknown fields, as for the parser.
+bool IsField(uint32_t tag, int field_number,
+             WireFormatLite::WireType wire_type) {
+  return tag == WireFormatLite::MakeTag(field_number, wire_type);
+}
+
+// Reads a length-delimited field from 'input', which reads 'serialized',
+// and returns its contents as a view into 'serialized'.
+bool ReadView(CodedInputStream* input, absl::string_view serialized,
+              absl::string_view* view) {
+  uint32_t length;
+  if (!input->ReadVarint32(&length)) return false;
+  size_t position = input->CurrentPosition();
+  if (length > serialized.size() - position) return false;
+  *view = serialized.substr(position, length);
+  return input->Skip(length);
+}
+
+// Parses 'serialized_key_data' into 'key_data', except that the value is
+// only returned as a view into 'serialized_key_data'.
+bool ParseKeyDataWithoutValue(absl::string_view serialized_key_data,
+                              KeyData* key_data, absl::string_view* value) {
+  return ForEachField(
+      serialized_key_data, [&](uint32_t tag, CodedInputStream* input) {
+        absl::string_view view;
+        uint32_t varint;
+        if (IsField(tag, 1, WireFormatLite::WIRETYPE_LENGTH_DELIMITED)) {
+          if (!ReadView(input, serialized_key_data, &view)) return false;
+          key_data->set_type_url(std::string(view));
+          return true;
+        }
+        if (IsField(tag, 2, WireFormatLite::WIRETYPE_LENGTH_DELIMITED)) {
+          return ReadView(input, serialized_key_data, value);
+        }
+        if (IsField(tag, 3, WireFormatLite::WIRETYPE_VARINT)) {
+          if (!input->ReadVarint32(&varint)) return false;
+          key_data->set_key_material_type(
+              static_cast<KeyData::KeyMaterialType>(varint));
+          return true;
+        }
+        return SkipField(tag, input);
+      });
+}
+
+// Parses 'serialized_key' into 'key', except that the value of its KeyData
+// is left empty; the locations of the KeyData and of its value in
+// 'serialized_key' are returned instead.
+bool ParseKeyWithoutValue(absl::string_view serialized_key, Keyset::Key* key,
+                          absl::string_view* serialized_key_data,
+                          absl::string_view* value) {
+  bool has_key_data = false;
+  return ForEachField(serialized_key, [&](uint32_t tag,
+                                          CodedInputStream* input) {
+    uint32_t varint;
+    if (IsField(tag, 1, WireFormatLite::WIRETYPE_LENGTH_DELIMITED)) {
+      // Repeated occurrences would have to be merged; writers never do this.
+      if (has_key_data) return false;
+      has_key_data = true;
+      return ReadView(input, serialized_key, serialized_key_data) &&
+             ParseKeyDataWithoutValue(*serialized_key_data,
+                                      key->mutable_key_data(), value);
+    }
+    if (IsField(tag, 2, WireFormatLite::WIRETYPE_VARINT)) {
+      if (!input->ReadVarint32(&varint)) return false;
+      key->set_status(static_cast<KeyStatusType>(varint));
+      return true;
+    }
+    if (IsField(tag, 3, WireFormatLite::WIRETYPE_VARINT)) {
+      if (!input->ReadVarint32(&varint)) return false;
+      key->set_key_id(varint);
+      return true;
+    }
+    if (IsField(tag, 4, WireFormatLite::WIRETYPE_VARINT)) {
+      if (!input->ReadVarint32(&varint)) return false;
+      key->set_output_prefix_type(static_cast<OutputPrefixType>(varint));
+      return true;
+    }
+    return SkipField(tag, input);
+  });
+}
+
+}  // namespace
+
+//  static
+util::StatusOr<std::unique_ptr<MmapKeysetReader>> MmapKeysetReader::New(
+    int file_descriptor) {
+  if (file_descriptor < 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "file_descriptor must be non-negative.");
+  }
+  struct stat file_stat;
+  if (fstat(file_descriptor, &file_stat) != 0) {
+    int fstat_errno = errno;
+    close_ignoring_eintr(file_descriptor);
+    return ToStatusF(util::error::INTERNAL, "fstat failed: %d", fstat_errno);
+  }
+  if (file_stat.st_size <= 0 ||
+      file_stat.st_size > std::numeric_limits<int>::max()) {
+    close_ignoring_eintr(file_descriptor);
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Cannot map a keyset file of %d bytes.",
+                     static_cast<int64_t>(file_stat.st_size));
+  }
+  size_t size = file_stat.st_size;
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+  int mmap_errno = errno;
+  close_ignoring_eintr(file_descriptor);
+  if (data == MAP_FAILED) {
+    return ToStatusF(util::error::INTERNAL, "mmap failed: %d", mmap_errno);
+  }
+#ifdef MADV_DONTDUMP
+  // The mapping holds key material, which should not end up in core dumps.
+  madvise(data, size, MADV_DONTDUMP);
+#endif
+  std::unique_ptr<MmapKeysetReader> reader(new MmapKeysetReader(data, size));
+  util::Status status = reader->Index();
+  if (!status.ok()) return status;
+  return std::move(reader);
+}
+
+MmapKeysetReader::~MmapKeysetReader() {
+  munmap(const_cast<void*>(data_), size_);
+}
+
+util::Status MmapKeysetReader::Index() {
+  // The skeleton holds everything but the values of the keys, so that
+  // ValidateKeyset() applies without copying any key material.
+  Keyset skeleton;
+  bool parsed = ForEachField(contents(), [&](uint32_t tag,
+                                             CodedInputStream* input) {
+    if (IsField(tag, 1, WireFormatLite::WIRETYPE_VARINT)) {
+      uint32_t primary_key_id;
+      if (!input->ReadVarint32(&primary_key_id)) return false;
+      skeleton.set_primary_key_id(primary_key_id);
+      return true;
+    }
+    if (IsField(tag, 2, WireFormatLite::WIRETYPE_LENGTH_DELIMITED)) {
+      absl::string_view serialized_key;
+      IndexedKey indexed_key;
+      if (!ReadView(input, contents(), &serialized_key)) return false;
+      if (!ParseKeyWithoutValue(serialized_key, skeleton.add_key(),
+                                &indexed_key.serialized_key_data,
+                                &indexed_key.value)) {
+        return false;
+      }
+      keys_.push_back(indexed_key);
+      return true;
+    }
+    return SkipField(tag, input);
+  });
+  if (!parsed) return ParseError();
+  util::Status status = ValidateKeyset(skeleton);
+  if (!status.ok()) return status;
+
+  keyset_info_ = KeysetInfoFromKeyset(skeleton);
+  key_index_.reserve(keys_.size());
+  for (size_t i = 0; i < keys_.size(); i++) {
+    // For repeated key ids, the first key is kept.
+    key_index_.emplace(skeleton.key(i).key_id(), i);
+  }
+  return util::Status::OK;
+}
+
+util::StatusOr<std::unique_ptr<Keyset>> MmapKeysetReader::Read() {
+  auto keyset = absl::make_unique<Keyset>();
+  if (!keyset->ParseFromArray(data_, size_)) return ParseError();
+  return std::move(keyset);
+}
+
+util::StatusOr<std::unique_ptr<EncryptedKeyset>>
+MmapKeysetReader::ReadEncrypted() {
+  return util::Status(util::error::UNIMPLEMENTED,
+                      "MmapKeysetReader only reads cleartext keysets.");
+}
+
+util::StatusOr<const MmapKeysetReader::IndexedKey*> MmapKeysetReader::FindKey(
+    uint32_t key_id) const {
+  auto it = key_index_.find(key_id);
+  if (it == key_index_.end()) {
+    return ToStatusF(util::error::NOT_FOUND,
+                     "The keyset has no key with id %d.", key_id);
+  }
+  return &keys_[it->second];
+}
+
+util::StatusOr<util::SecretProto<KeyData>> MmapKeysetReader::ReadKeyData(
+    uint32_t key_id) const {
+  auto key_result = FindKey(key_id);
+  if (!key_result.ok()) return key_result.status();
+  absl::string_view serialized_key_data =
+      key_result.ValueOrDie()->serialized_key_data;
+  util::SecretProto<KeyData> key_data;
+  if (!key_data->ParseFromArray(serialized_key_data.data(),
+                                serialized_key_data.size())) {
+    return ParseError();
+  }
+  return std::move(key_data);
+}
+
+util::StatusOr<util::SecretData> MmapKeysetReader::ReadKeyValue(
+    uint32_t key_id) const {
+  auto key_result = FindKey(key_id);
+  if (!key_result.ok()) return key_result.status();
+  return util::SecretDataFromStringView(key_result.ValueOrDie()->value);
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,143 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/mmap_keyset_reader.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/internal/key_info.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+#include "proto/aes_gcm.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::AddRawKey;
+using ::crypto::tink::test::AddTinkKey;
+using ::crypto::tink::test::GetTestFileDescriptor;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::AesGcmKey;
+using ::google::crypto::tink::KeyData;
+using ::google::crypto::tink::Keyset;
+using ::google::crypto::tink::KeyStatusType;
+
+class MmapKeysetReaderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    AesGcmKey key;
+    key.set_key_value("0123456789abcdef");
+    AddTinkKey("some key type", 42, key, KeyStatusType::ENABLED,
+               KeyData::SYMMETRIC, &keyset_);
+    key.set_key_value("fedcba9876543210");
+    AddRawKey("some other key type", 711, key, KeyStatusType::ENABLED,
+              KeyData::SYMMETRIC, &keyset_);
+    keyset_.set_primary_key_id(42);
+  }
+
+  util::StatusOr<std::unique_ptr<MmapKeysetReader>> NewReader(
+      absl::string_view contents) {
+    return MmapKeysetReader::New(
+        GetTestFileDescriptor("mmap_keyset_reader_test_keyset", contents));
+  }
+
+  Keyset keyset_;
+};
+
+TEST_F(MmapKeysetReaderTest, KeysetInfo) {
+  auto reader_result = NewReader(keyset_.SerializeAsString());
+  ASSERT_THAT(reader_result.status(), IsOk());
+  EXPECT_EQ(reader_result.ValueOrDie()->keyset_info().SerializeAsString(),
+            KeysetInfoFromKeyset(keyset_).SerializeAsString());
+}
+
+TEST_F(MmapKeysetReaderTest, ReadKeyData) {
+  auto reader_result = NewReader(keyset_.SerializeAsString());
+  ASSERT_THAT(reader_result.status(), IsOk());
+  const MmapKeysetReader& reader = *reader_result.ValueOrDie();
+
+  for (const Keyset::Key& key : keyset_.key()) {
+    auto key_data_result = reader.ReadKeyData(key.key_id());
+    ASSERT_THAT(key_data_result.status(), IsOk());
+    EXPECT_EQ(key_data_result.ValueOrDie()->SerializeAsString(),
+              key.key_data().SerializeAsString());
+
+    auto value_result = reader.ReadKeyValue(key.key_id());
+    ASSERT_THAT(value_result.status(), IsOk());
+    EXPECT_EQ(util::SecretDataAsStringView(value_result.ValueOrDie()),
+              key.key_data().value());
+  }
+  EXPECT_THAT(reader.ReadKeyData(43).status(),
+              StatusIs(util::error::NOT_FOUND));
+  EXPECT_THAT(reader.ReadKeyValue(43).status(),
+              StatusIs(util::error::NOT_FOUND));
+}
+
+TEST_F(MmapKeysetReaderTest, Read) {
+  auto reader_result = NewReader(keyset_.SerializeAsString());
+  ASSERT_THAT(reader_result.status(), IsOk());
+  auto keyset_result = reader_result.ValueOrDie()->Read();
+  ASSERT_THAT(keyset_result.status(), IsOk());
+  EXPECT_EQ(keyset_result.ValueOrDie()->SerializeAsString(),
+            keyset_.SerializeAsString());
+  EXPECT_THAT(reader_result.ValueOrDie()->ReadEncrypted().status(),
+              StatusIs(util::error::UNIMPLEMENTED));
+}
+
+TEST_F(MmapKeysetReaderTest, UnknownFieldsAreSkipped) {
+  // Field 15 of Keyset (varint) and field 15 of Keyset.Key (bytes).
+  std::string extended = keyset_.SerializeAsString() + "\x78\x01";
+  Keyset::Key extended_key = keyset_.key(0);
+  extended_key.set_status(KeyStatusType::DISABLED);
+  extended_key.mutable_key_data()->set_value("disabled key");
+  std::string serialized_key = extended_key.SerializeAsString() + "\x7a\x01x";
+  extended += "\x12";
+  extended += static_cast<char>(serialized_key.size());
+  extended += serialized_key;
+
+  auto reader_result = NewReader(extended);
+  ASSERT_THAT(reader_result.status(), IsOk());
+  EXPECT_EQ(reader_result.ValueOrDie()->keyset_info().key_info_size(), 3);
+  // The first key with a given id is returned.
+  auto value_result = reader_result.ValueOrDie()->ReadKeyValue(42);
+  ASSERT_THAT(value_result.status(), IsOk());
+  EXPECT_EQ(util::SecretDataAsStringView(value_result.ValueOrDie()),
+            keyset_.key(0).key_data().value());
+}
+
+TEST_F(MmapKeysetReaderTest, InvalidKeysets) {
+  EXPECT_FALSE(NewReader("some weird string").ok());
+  EXPECT_FALSE(NewReader("").ok());
+  EXPECT_FALSE(NewReader(keyset_.SerializeAsString().substr(0, 20)).ok());
+
+  keyset_.set_primary_key_id(43);
+  EXPECT_THAT(NewReader(keyset_.SerializeAsString()).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+
+  EXPECT_THAT(MmapKeysetReader::New(-1).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
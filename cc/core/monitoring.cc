@@ -0,0 +1,60 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/monitoring.h"
+
+#include <atomic>
+#include <memory>
+
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+std::atomic<MonitoringClient*> monitoring_client{nullptr};
+
+}  // namespace
+
+util::Status RegisterMonitoringClient(
+    std::unique_ptr<MonitoringClient> client) {
+  if (client == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Monitoring client must be non-null.");
+  }
+  if (client->latency_sampling_period() < 1) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Latency sampling period must be positive.");
+  }
+  MonitoringClient* expected = nullptr;
+  if (!monitoring_client.compare_exchange_strong(expected, client.get(),
+                                                 std::memory_order_acq_rel)) {
+    return util::Status(util::error::ALREADY_EXISTS,
+                        "A monitoring client is already registered.");
+  }
+  // Intentionally leaked: wrappers may use the client until the program
+  // exits.
+  client.release();
+  return util::OkStatus();
+}
+
+MonitoringClient* GetMonitoringClient() {
+  return monitoring_client.load(std::memory_order_acquire);
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,104 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/monitoring_stats_client.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <tuple>
+
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tink/monitoring.h"
+
+namespace crypto {
+namespace tink {
+
+constexpr int MonitoringStatsClient::kLatencyBuckets;
+constexpr int MonitoringStatsClient::kShards;
+
+// static
+int MonitoringStatsClient::LatencyBucket(absl::Duration latency) {
+  int64_t micros = absl::ToInt64Microseconds(latency);
+  int bucket = 0;
+  while (micros > 0 && bucket < kLatencyBuckets - 1) {
+    micros >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+void MonitoringStatsClient::Log(const MonitoringEvent& event) {
+  Shard& shard =
+      shards_[std::hash<std::thread::id>()(std::this_thread::get_id()) %
+              kShards];
+  absl::MutexLock lock(&shard.mutex);
+  Stats& stats = shard.stats[std::make_tuple(
+      event.primitive, event.operation, event.ok ? event.key_id : 0)];
+  stats.operations++;
+  if (!event.ok) stats.failures++;
+  stats.keys_tried += event.keys_tried;
+  if (event.tried_raw_keys) stats.raw_key_fallthroughs++;
+  if (event.raw_key_limit_reached) stats.raw_key_limits_reached++;
+  if (event.latency_sampled) {
+    stats.latency_histogram[LatencyBucket(event.latency)]++;
+  }
+}
+
+MonitoringStatsClient::StatsMap MonitoringStatsClient::GetStats() const {
+  StatsMap result;
+  for (const Shard& shard : shards_) {
+    absl::MutexLock lock(&shard.mutex);
+    for (const auto& entry : shard.stats) {
+      const auto& key = entry.first;
+      Stats& stats = result[std::make_tuple(std::string(std::get<0>(key)),
+                                            std::string(std::get<1>(key)),
+                                            std::get<2>(key))];
+      stats.operations += entry.second.operations;
+      stats.failures += entry.second.failures;
+      stats.keys_tried += entry.second.keys_tried;
+      stats.raw_key_fallthroughs += entry.second.raw_key_fallthroughs;
+      stats.raw_key_limits_reached += entry.second.raw_key_limits_reached;
+      for (int i = 0; i < kLatencyBuckets; i++) {
+        stats.latency_histogram[i] += entry.second.latency_histogram[i];
+      }
+    }
+  }
+  return result;
+}
+
+// static
+std::map<uint32_t, int64_t> MonitoringStatsClient::KeyUsage(
+    const StatsMap& stats, absl::string_view operation,
+    const StatsMap& since) {
+  std::map<uint32_t, int64_t> usage;
+  for (const auto& entry : stats) {
+    // Failed operations are counted under key id 0.
+    uint32_t key_id = std::get<2>(entry.first);
+    if (key_id == 0 || std::get<1>(entry.first) != operation) continue;
+    int64_t operations = entry.second.operations;
+    auto earlier = since.find(entry.first);
+    if (earlier != since.end()) operations -= earlier->second.operations;
+    if (operations > 0) usage[key_id] += operations;
+  }
+  return usage;
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,134 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/monitoring_stats_client.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <tuple>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/time/time.h"
+#include "tink/monitoring.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+MonitoringEvent Event(absl::string_view operation, bool ok, uint32_t key_id) {
+  MonitoringEvent event;
+  event.primitive = "aead";
+  event.operation = operation;
+  event.ok = ok;
+  event.key_id = key_id;
+  event.keys_tried = 1;
+  return event;
+}
+
+TEST(MonitoringStatsClientTest, LatencyBucket) {
+  EXPECT_EQ(0, MonitoringStatsClient::LatencyBucket(absl::ZeroDuration()));
+  EXPECT_EQ(0, MonitoringStatsClient::LatencyBucket(absl::Nanoseconds(999)));
+  EXPECT_EQ(1, MonitoringStatsClient::LatencyBucket(absl::Microseconds(1)));
+  EXPECT_EQ(2, MonitoringStatsClient::LatencyBucket(absl::Microseconds(2)));
+  EXPECT_EQ(2, MonitoringStatsClient::LatencyBucket(absl::Microseconds(3)));
+  EXPECT_EQ(10, MonitoringStatsClient::LatencyBucket(absl::Milliseconds(1)));
+  EXPECT_EQ(MonitoringStatsClient::kLatencyBuckets - 1,
+            MonitoringStatsClient::LatencyBucket(absl::Hours(1)));
+}
+
+TEST(MonitoringStatsClientTest, AggregatesByKeyAndOperation) {
+  MonitoringStatsClient client;
+  client.Log(Event("encrypt", true, 42));
+  client.Log(Event("encrypt", true, 42));
+  client.Log(Event("decrypt", true, 42));
+  client.Log(Event("decrypt", true, 43));
+
+  MonitoringEvent failure = Event("decrypt", false, 0);
+  failure.keys_tried = 3;
+  failure.tried_raw_keys = true;
+  failure.raw_key_limit_reached = true;
+  client.Log(failure);
+
+  MonitoringEvent sampled = Event("decrypt", true, 43);
+  sampled.latency_sampled = true;
+  sampled.latency = absl::Microseconds(3);
+  client.Log(sampled);
+
+  MonitoringStatsClient::StatsMap stats = client.GetStats();
+  ASSERT_EQ(4, stats.size());
+
+  const auto& encrypt = stats[std::make_tuple("aead", "encrypt", 42)];
+  EXPECT_EQ(2, encrypt.operations);
+  EXPECT_EQ(0, encrypt.failures);
+  EXPECT_EQ(2, encrypt.keys_tried);
+
+  const auto& failed = stats[std::make_tuple("aead", "decrypt", 0)];
+  EXPECT_EQ(1, failed.operations);
+  EXPECT_EQ(1, failed.failures);
+  EXPECT_EQ(3, failed.keys_tried);
+  EXPECT_EQ(1, failed.raw_key_fallthroughs);
+  EXPECT_EQ(1, failed.raw_key_limits_reached);
+
+  const auto& decrypt = stats[std::make_tuple("aead", "decrypt", 43)];
+  EXPECT_EQ(2, decrypt.operations);
+  EXPECT_EQ(0, decrypt.raw_key_fallthroughs);
+  EXPECT_EQ(0, decrypt.raw_key_limits_reached);
+  EXPECT_EQ(1, decrypt.latency_histogram[2]);
+  int64_t sampled_count = 0;
+  for (int64_t count : decrypt.latency_histogram) sampled_count += count;
+  EXPECT_EQ(1, sampled_count);
+}
+
+TEST(MonitoringStatsClientTest, KeyUsage) {
+  MonitoringStatsClient client;
+  client.Log(Event("encrypt", true, 42));
+  client.Log(Event("decrypt", true, 42));
+  client.Log(Event("decrypt", true, 43));
+  client.Log(Event("decrypt", false, 0));
+  MonitoringStatsClient::StatsMap earlier = client.GetStats();
+  client.Log(Event("decrypt", true, 42));
+  client.Log(Event("decrypt", true, 42));
+  MonitoringStatsClient::StatsMap stats = client.GetStats();
+
+  std::map<uint32_t, int64_t> usage =
+      MonitoringStatsClient::KeyUsage(stats, "decrypt");
+  EXPECT_EQ((std::map<uint32_t, int64_t>{{42, 3}, {43, 1}}), usage);
+
+  usage = MonitoringStatsClient::KeyUsage(stats, "decrypt", earlier);
+  EXPECT_EQ((std::map<uint32_t, int64_t>{{42, 2}}), usage);
+}
+
+TEST(MonitoringStatsClientTest, MergesThreads) {
+  MonitoringStatsClient client;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&client]() {
+      for (int i = 0; i < 1000; i++) client.Log(Event("encrypt", true, 7));
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  MonitoringStatsClient::StatsMap stats = client.GetStats();
+  ASSERT_EQ(1, stats.size());
+  EXPECT_EQ(8000, stats.begin()->second.operations);
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,77 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/page_aead.h"
+
+#include <cstdint>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+util::Status ValidatePages(int page_size, int overhead,
+                           absl::Span<char> pages) {
+  if (page_size < overhead) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        absl::StrCat("Page size ", page_size,
+                                     " is smaller than the overhead ",
+                                     overhead));
+  }
+  if (page_size == 0 || pages.size() % page_size != 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "The pages are not a multiple of the page size");
+  }
+  return util::OkStatus();
+}
+
+}  // namespace
+
+util::Status PageAead::EncryptPages(uint64_t first_page_number,
+                                    absl::string_view associated_data,
+                                    int page_size,
+                                    absl::Span<char> pages) const {
+  util::Status status = ValidatePages(page_size, overhead(), pages);
+  if (!status.ok()) return status;
+  for (size_t i = 0; i * page_size < pages.size(); i++) {
+    status = EncryptPage(first_page_number + i, associated_data,
+                         pages.subspan(i * page_size, page_size));
+    if (!status.ok()) return status;
+  }
+  return util::OkStatus();
+}
+
+util::Status PageAead::DecryptPages(uint64_t first_page_number,
+                                    absl::string_view associated_data,
+                                    int page_size,
+                                    absl::Span<char> pages) const {
+  util::Status status = ValidatePages(page_size, overhead(), pages);
+  if (!status.ok()) return status;
+  for (size_t i = 0; i * page_size < pages.size(); i++) {
+    status = DecryptPage(first_page_number + i, associated_data,
+                         pages.subspan(i * page_size, page_size));
+    if (!status.ok()) return status;
+  }
+  return util::OkStatus();
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,177 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/per_key_encrypted_keyset_handle.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/cleartext_keyset_handle.h"
+#include "tink/internal/key_info.h"
+#include "tink/keyset_handle.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/errors.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/tink.pb.h"
+
+using google::crypto::tink::KeyData;
+using google::crypto::tink::Keyset;
+using google::crypto::tink::KeysetInfo;
+using google::crypto::tink::PerKeyEncryptedKeyset;
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+constexpr int kDekSizeInBytes = 32;
+
+// The associated data of the key at 'index', whose id is 'key_id'.
+std::string KeyAssociatedData(int index, uint32_t key_id) {
+  std::string associated_data(8, '\0');
+  for (int i = 0; i < 4; i++) {
+    associated_data[i] = static_cast<char>(index >> (24 - 8 * i));
+    associated_data[4 + i] = static_cast<char>(key_id >> (24 - 8 * i));
+  }
+  return associated_data;
+}
+
+}  // namespace
+
+// static
+util::StatusOr<std::string> PerKeyEncryptedKeysetHandle::Write(
+    const KeysetHandle& keyset_handle, const Aead& master_key_aead) {
+  const Keyset& keyset = CleartextKeysetHandle::GetKeyset(keyset_handle);
+  util::Status status = ValidateKeyset(keyset);
+  if (!status.ok()) return status;
+  util::SecretData dek_value = subtle::Random::GetRandomKeyBytes(
+      kDekSizeInBytes);
+  auto dek_result = subtle::AesGcmBoringSsl::New(dek_value);
+  if (!dek_result.ok()) return dek_result.status();
+  const Aead& dek = *dek_result.ValueOrDie();
+
+  PerKeyEncryptedKeyset encrypted_keyset;
+  encrypted_keyset.set_keyset_info(
+      KeysetInfoFromKeyset(keyset).SerializeAsString());
+  auto encrypted_dek_result = master_key_aead.Encrypt(
+      util::SecretDataAsStringView(dek_value), encrypted_keyset.keyset_info());
+  if (!encrypted_dek_result.ok()) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Encryption of the data encryption key failed: %s",
+                     encrypted_dek_result.status().error_message());
+  }
+  encrypted_keyset.set_encrypted_dek(encrypted_dek_result.ValueOrDie());
+  for (int i = 0; i < keyset.key_size(); i++) {
+    std::string serialized_key = keyset.key(i).SerializeAsString();
+    auto encrypted_key_result = dek.Encrypt(
+        serialized_key, KeyAssociatedData(i, keyset.key(i).key_id()));
+    util::SafeZeroString(&serialized_key);
+    if (!encrypted_key_result.ok()) return encrypted_key_result.status();
+    encrypted_keyset.add_encrypted_keys(encrypted_key_result.ValueOrDie());
+  }
+  return encrypted_keyset.SerializeAsString();
+}
+
+// static
+util::StatusOr<std::unique_ptr<PerKeyEncryptedKeysetHandle>>
+PerKeyEncryptedKeysetHandle::Read(absl::string_view serialized_keyset,
+                                  const Aead& master_key_aead) {
+  PerKeyEncryptedKeyset encrypted_keyset;
+  if (!encrypted_keyset.ParseFromArray(serialized_keyset.data(),
+                                       serialized_keyset.size())) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        "Could not parse the input as a PerKeyEncryptedKeyset-proto.");
+  }
+  auto dek_value_result = master_key_aead.Decrypt(
+      encrypted_keyset.encrypted_dek(), encrypted_keyset.keyset_info());
+  if (!dek_value_result.ok()) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Error decrypting the data encryption key: %s",
+                     dek_value_result.status().error_message());
+  }
+  std::string& dek_value = dek_value_result.ValueOrDie();
+  util::SecretData dek_secret = util::SecretDataFromStringView(dek_value);
+  util::SafeZeroString(&dek_value);
+  if (dek_secret.size() != kDekSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "The data encryption key has the wrong size.");
+  }
+  auto dek_result = subtle::AesGcmBoringSsl::New(dek_secret);
+  if (!dek_result.ok()) return dek_result.status();
+
+  auto state = std::make_shared<State>();
+  state->dek = std::move(dek_result.ValueOrDie());
+  if (!state->keyset_info.ParseFromString(encrypted_keyset.keyset_info())) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Could not parse the KeysetInfo of the keyset.");
+  }
+  if (state->keyset_info.key_info_size() !=
+      encrypted_keyset.encrypted_keys_size()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "The number of encrypted keys does not match the "
+                        "KeysetInfo.");
+  }
+  state->encrypted_keys.assign(encrypted_keyset.encrypted_keys().begin(),
+                               encrypted_keyset.encrypted_keys().end());
+  return {absl::WrapUnique(new PerKeyEncryptedKeysetHandle(std::move(state)))};
+}
+
+// static
+util::StatusOr<KeyData> PerKeyEncryptedKeysetHandle::DecryptKeyData(
+    const State& state, int index) {
+  const KeysetInfo::KeyInfo& key_info = state.keyset_info.key_info(index);
+  auto decrypt_result = state.dek->Decrypt(
+      state.encrypted_keys[index],
+      KeyAssociatedData(index, key_info.key_id()));
+  if (!decrypt_result.ok()) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Error decrypting key %u: %s", key_info.key_id(),
+                     decrypt_result.status().error_message());
+  }
+  std::string& serialized_key = decrypt_result.ValueOrDie();
+  Keyset::Key key;
+  bool parsed = key.ParseFromString(serialized_key);
+  util::SafeZeroString(&serialized_key);
+  if (!parsed) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not parse key %u as a Keyset.Key-proto.",
+                     key_info.key_id());
+  }
+  if (key.key_id() != key_info.key_id() ||
+      key.status() != key_info.status() ||
+      key.output_prefix_type() != key_info.output_prefix_type() ||
+      key.key_data().type_url() != key_info.type_url()) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key %u does not match its KeyInfo.", key_info.key_id());
+  }
+  util::Status status = ValidateKey(key);
+  if (!status.ok()) return status;
+  state.num_decrypted_keys.fetch_add(1, std::memory_order_relaxed);
+  return std::move(*key.mutable_key_data());
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,177 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/per_key_encrypted_keyset_handle.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "tink/aead.h"
+#include "tink/aead/aead_key_templates.h"
+#include "tink/aead/aead_wrapper.h"
+#include "tink/aead/aes_gcm_key_manager.h"
+#include "tink/keyset_handle.h"
+#include "tink/registry.h"
+#include "tink/util/test_keyset_handle.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::AddKeyData;
+using ::crypto::tink::test::DummyAead;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::KeyData;
+using ::google::crypto::tink::Keyset;
+using ::google::crypto::tink::KeysetInfo;
+using ::google::crypto::tink::KeyStatusType;
+using ::google::crypto::tink::OutputPrefixType;
+using ::google::crypto::tink::PerKeyEncryptedKeyset;
+
+constexpr int kNumKeys = 20;
+constexpr uint32_t kPrimaryKeyId = 10;
+
+class PerKeyEncryptedKeysetHandleTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Registry::Reset();
+    ASSERT_THAT(Registry::RegisterKeyTypeManager(
+                    absl::make_unique<AesGcmKeyManager>(), true),
+                IsOk());
+    ASSERT_THAT(
+        Registry::RegisterPrimitiveWrapper(absl::make_unique<AeadWrapper>()),
+        IsOk());
+    for (uint32_t key_id = 0; key_id < kNumKeys; key_id++) {
+      KeyData key_data =
+          *Registry::NewKeyData(AeadKeyTemplates::Aes128Gcm()).ValueOrDie();
+      AddKeyData(key_data, key_id,
+                 key_id % 2 == 0 ? OutputPrefixType::TINK
+                                 : OutputPrefixType::LEGACY,
+                 KeyStatusType::ENABLED, &keyset_);
+      keyset_.set_primary_key_id(key_id);
+      encryptions_.push_back(TestKeysetHandle::GetKeysetHandle(keyset_)
+                                 ->GetPrimitive<Aead>()
+                                 .ValueOrDie()
+                                 ->Encrypt("plaintext", "aad")
+                                 .ValueOrDie());
+    }
+    keyset_.set_primary_key_id(kPrimaryKeyId);
+  }
+
+  std::string WriteKeyset() {
+    return PerKeyEncryptedKeysetHandle::Write(
+               *TestKeysetHandle::GetKeysetHandle(keyset_), master_key_aead_)
+        .ValueOrDie();
+  }
+
+  Keyset keyset_;
+  std::vector<std::string> encryptions_;
+  DummyAead master_key_aead_{"master key"};
+};
+
+TEST_F(PerKeyEncryptedKeysetHandleTest, KeysAreDecryptedWhenUsed) {
+  auto handle_result =
+      PerKeyEncryptedKeysetHandle::Read(WriteKeyset(), master_key_aead_);
+  ASSERT_THAT(handle_result.status(), IsOk());
+  auto handle = std::move(handle_result.ValueOrDie());
+  EXPECT_EQ(handle->num_decrypted_keys(), 0);
+  EXPECT_EQ(handle->GetKeysetInfo().primary_key_id(), kPrimaryKeyId);
+  EXPECT_EQ(handle->GetKeysetInfo().key_info_size(), kNumKeys);
+
+  auto aead_result = handle->GetPrimitive<Aead>();
+  ASSERT_THAT(aead_result.status(), IsOk());
+  std::unique_ptr<Aead> aead = std::move(aead_result.ValueOrDie());
+  EXPECT_EQ(handle->num_decrypted_keys(), 1);
+  std::string encryption = aead->Encrypt("plaintext", "aad").ValueOrDie();
+  EXPECT_EQ(encryption.substr(0, 5), encryptions_[kPrimaryKeyId].substr(0, 5));
+
+  EXPECT_EQ(aead->Decrypt(encryptions_[3], "aad").ValueOrDie(), "plaintext");
+  EXPECT_EQ(aead->Decrypt(encryptions_[3], "aad").ValueOrDie(), "plaintext");
+  EXPECT_EQ(handle->num_decrypted_keys(), 2);
+  for (const std::string& encryption : encryptions_) {
+    EXPECT_EQ(aead->Decrypt(encryption, "aad").ValueOrDie(), "plaintext");
+  }
+  EXPECT_EQ(handle->num_decrypted_keys(), kNumKeys);
+}
+
+TEST_F(PerKeyEncryptedKeysetHandleTest, KeysetInfoIsAuthenticated) {
+  PerKeyEncryptedKeyset encrypted_keyset;
+  ASSERT_TRUE(encrypted_keyset.ParseFromString(WriteKeyset()));
+  KeysetInfo keyset_info;
+  ASSERT_TRUE(keyset_info.ParseFromString(encrypted_keyset.keyset_info()));
+  keyset_info.set_primary_key_id(3);
+  encrypted_keyset.set_keyset_info(keyset_info.SerializeAsString());
+  EXPECT_THAT(PerKeyEncryptedKeysetHandle::Read(
+                  encrypted_keyset.SerializeAsString(), master_key_aead_)
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(PerKeyEncryptedKeysetHandleTest, WrongMasterKeyFails) {
+  EXPECT_THAT(PerKeyEncryptedKeysetHandle::Read(WriteKeyset(),
+                                                DummyAead("other key"))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(PerKeyEncryptedKeysetHandleTest, SwappedKeysAreRejected) {
+  PerKeyEncryptedKeyset encrypted_keyset;
+  ASSERT_TRUE(encrypted_keyset.ParseFromString(WriteKeyset()));
+  encrypted_keyset.mutable_encrypted_keys()->SwapElements(2, 3);
+  auto handle_result = PerKeyEncryptedKeysetHandle::Read(
+      encrypted_keyset.SerializeAsString(), master_key_aead_);
+  ASSERT_THAT(handle_result.status(), IsOk());
+  auto aead = handle_result.ValueOrDie()->GetPrimitive<Aead>().ValueOrDie();
+  EXPECT_FALSE(aead->Decrypt(encryptions_[2], "aad").ok());
+  EXPECT_FALSE(aead->Decrypt(encryptions_[3], "aad").ok());
+  EXPECT_EQ(aead->Decrypt(encryptions_[4], "aad").ValueOrDie(), "plaintext");
+
+  // The primary key is decrypted right away.
+  encrypted_keyset.mutable_encrypted_keys()->SwapElements(kPrimaryKeyId, 0);
+  handle_result = PerKeyEncryptedKeysetHandle::Read(
+      encrypted_keyset.SerializeAsString(), master_key_aead_);
+  ASSERT_THAT(handle_result.status(), IsOk());
+  EXPECT_THAT(handle_result.ValueOrDie()->GetPrimitive<Aead>().status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(PerKeyEncryptedKeysetHandleTest, MissingKeyIsRejected) {
+  PerKeyEncryptedKeyset encrypted_keyset;
+  ASSERT_TRUE(encrypted_keyset.ParseFromString(WriteKeyset()));
+  encrypted_keyset.mutable_encrypted_keys()->RemoveLast();
+  EXPECT_THAT(PerKeyEncryptedKeysetHandle::Read(
+                  encrypted_keyset.SerializeAsString(), master_key_aead_)
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(PerKeyEncryptedKeysetHandleTest, InvalidInputIsRejected) {
+  EXPECT_THAT(
+      PerKeyEncryptedKeysetHandle::Read("invalid", master_key_aead_).status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
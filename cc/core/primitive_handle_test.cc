@@ -0,0 +1,112 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/primitive_handle.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "tink/aead.h"
+#include "tink/aead/aead_wrapper.h"
+#include "tink/keyset_handle.h"
+#include "tink/registry.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_keyset_handle.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::AddKeyData;
+using ::crypto::tink::test::DummyAeadKeyManager;
+using ::crypto::tink::test::IsOk;
+using ::google::crypto::tink::KeyData;
+using ::google::crypto::tink::Keyset;
+using ::google::crypto::tink::KeyStatusType;
+using ::google::crypto::tink::OutputPrefixType;
+
+constexpr char kKeyType[] = "type.googleapis.com/some.DummyAeadKey";
+
+class PrimitiveHandleTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Registry::Reset();
+    ASSERT_THAT(
+        Registry::RegisterPrimitiveWrapper(absl::make_unique<AeadWrapper>()),
+        IsOk());
+    ASSERT_THAT(Registry::RegisterKeyManager(
+                    absl::make_unique<DummyAeadKeyManager>(kKeyType), true),
+                IsOk());
+  }
+
+  void TearDown() override { Registry::Reset(); }
+
+  static void AddKey(uint32_t key_id, const std::string& value,
+                     Keyset* keyset) {
+    KeyData key_data;
+    key_data.set_type_url(kKeyType);
+    key_data.set_value(value);
+    key_data.set_key_material_type(KeyData::SYMMETRIC);
+    AddKeyData(key_data, key_id, OutputPrefixType::TINK,
+               KeyStatusType::ENABLED, keyset);
+  }
+};
+
+TEST_F(PrimitiveHandleTest, KeepsPrimitiveAndKeysetInfo) {
+  Keyset keyset;
+  AddKey(1, "key 1", &keyset);
+  AddKey(2, "key 2", &keyset);
+  keyset.set_primary_key_id(2);
+  auto aead = TestKeysetHandle::GetKeysetHandle(keyset)
+                  ->GetPrimitive<Aead>()
+                  .ValueOrDie();
+  std::string ciphertext = aead->Encrypt("plaintext", "ad").ValueOrDie();
+
+  auto handle_result = PrimitiveHandle<Aead>::New(
+      TestKeysetHandle::GetKeysetHandle(keyset));
+  ASSERT_THAT(handle_result.status(), IsOk());
+  auto& handle = handle_result.ValueOrDie();
+  EXPECT_EQ("plaintext",
+            handle->get_primitive().Decrypt(ciphertext, "ad").ValueOrDie());
+  EXPECT_EQ(2, handle->get_keyset_info().primary_key_id());
+  ASSERT_EQ(2, handle->get_keyset_info().key_info_size());
+  EXPECT_EQ(kKeyType, handle->get_keyset_info().key_info(0).type_url());
+  EXPECT_EQ(1, handle->get_keyset_info().key_info(0).key_id());
+  EXPECT_LT(sizeof(*handle), handle->SpaceUsed());
+}
+
+TEST_F(PrimitiveHandleTest, Errors) {
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            PrimitiveHandle<Aead>::New(nullptr).status().error_code());
+
+  Keyset keyset;
+  AddKey(1, "key 1", &keyset);
+  keyset.set_primary_key_id(1);
+  keyset.mutable_key(0)->mutable_key_data()->set_type_url("unknown");
+  EXPECT_FALSE(
+      PrimitiveHandle<Aead>::New(TestKeysetHandle::GetKeysetHandle(keyset))
+          .ok());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
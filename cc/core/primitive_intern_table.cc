@@ -0,0 +1,88 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/primitive_intern_table.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/synchronization/mutex.h"
+#include "openssl/sha.h"
+#include "tink/util/secret_data.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+std::string KeyDataDigest(const google::crypto::tink::KeyData& key_data) {
+  std::string serialized_key_data = key_data.SerializeAsString();
+  std::string digest(SHA256_DIGEST_LENGTH, '\0');
+  SHA256(reinterpret_cast<const uint8_t*>(serialized_key_data.data()),
+         serialized_key_data.size(), reinterpret_cast<uint8_t*>(&digest[0]));
+  util::SafeZeroString(&serialized_key_data);
+  return digest;
+}
+
+}  // namespace internal
+
+// static
+PrimitiveInternTable& PrimitiveInternTable::GlobalInstance() {
+  static PrimitiveInternTable* instance = new PrimitiveInternTable();
+  return *instance;
+}
+
+int PrimitiveInternTable::size() const {
+  absl::MutexLock lock(&mutex_);
+  int size = 0;
+  for (const auto& id_and_primitive : primitives_) {
+    if (!id_and_primitive.second.expired()) size++;
+  }
+  return size;
+}
+
+std::shared_ptr<void> PrimitiveInternTable::Lookup(const Id& id) const {
+  absl::MutexLock lock(&mutex_);
+  auto it = primitives_.find(id);
+  if (it == primitives_.end()) return nullptr;
+  return it->second.lock();
+}
+
+std::shared_ptr<void> PrimitiveInternTable::Insert(
+    const Id& id, std::shared_ptr<void> primitive) {
+  absl::MutexLock lock(&mutex_);
+  std::weak_ptr<void>& entry = primitives_[id];
+  std::shared_ptr<void> existing = entry.lock();
+  if (existing != nullptr) return existing;
+  entry = primitive;
+  // Removes the entries of released primitives whenever the table doubled,
+  // which keeps the amortized cost of an insertion constant.
+  if (primitives_.size() > 2 * purged_size_) {
+    for (auto it = primitives_.begin(); it != primitives_.end();) {
+      if (it->second.expired()) {
+        it = primitives_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    purged_size_ = primitives_.size();
+  }
+  return primitive;
+}
+
+}  // namespace tink
+}  // namespace crypto
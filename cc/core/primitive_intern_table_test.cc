@@ -0,0 +1,146 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/primitive_intern_table.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "tink/aead.h"
+#include "tink/aead/aead_wrapper.h"
+#include "tink/keyset_handle.h"
+#include "tink/registry.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_keyset_handle.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::AddKeyData;
+using ::crypto::tink::test::DummyAeadKeyManager;
+using ::crypto::tink::test::IsOk;
+using ::google::crypto::tink::KeyData;
+using ::google::crypto::tink::Keyset;
+using ::google::crypto::tink::KeyStatusType;
+using ::google::crypto::tink::OutputPrefixType;
+
+constexpr char kKeyType[] = "type.googleapis.com/some.CountedAeadKey";
+
+class PrimitiveInternTableTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Registry::Reset();
+    ASSERT_THAT(
+        Registry::RegisterPrimitiveWrapper(absl::make_unique<AeadWrapper>()),
+        IsOk());
+    ASSERT_THAT(
+        Registry::RegisterKeyManager(
+            absl::make_unique<DummyAeadKeyManager>(kKeyType, &count_), true),
+        IsOk());
+  }
+
+  void TearDown() override { Registry::Reset(); }
+
+  static void AddKey(uint32_t key_id, const std::string& value,
+                     Keyset* keyset) {
+    KeyData key_data;
+    key_data.set_type_url(kKeyType);
+    key_data.set_value(value);
+    key_data.set_key_material_type(KeyData::SYMMETRIC);
+    AddKeyData(key_data, key_id, OutputPrefixType::TINK,
+               KeyStatusType::ENABLED, keyset);
+  }
+
+  // Returns the primitive of 'keyset', loaded using 'intern_table'.
+  std::unique_ptr<Aead> GetAead(const Keyset& keyset,
+                                PrimitiveInternTable* intern_table) {
+    KeysetHandle::LoadingOptions options;
+    options.intern_table = intern_table;
+    auto aead_result = TestKeysetHandle::GetKeysetHandle(keyset)
+                           ->GetPrimitive<Aead>(options);
+    EXPECT_THAT(aead_result.status(), IsOk());
+    return std::move(aead_result.ValueOrDie());
+  }
+
+  std::atomic<int> count_{0};
+};
+
+TEST_F(PrimitiveInternTableTest, KeysAreShared) {
+  PrimitiveInternTable intern_table;
+  Keyset keyset_1;
+  AddKey(1, "shared key", &keyset_1);
+  AddKey(2, "key 2", &keyset_1);
+  keyset_1.set_primary_key_id(1);
+  Keyset keyset_2;
+  AddKey(1, "shared key", &keyset_2);
+  AddKey(3, "key 3", &keyset_2);
+  keyset_2.set_primary_key_id(3);
+
+  std::unique_ptr<Aead> aead_1 = GetAead(keyset_1, &intern_table);
+  std::unique_ptr<Aead> aead_2 = GetAead(keyset_2, &intern_table);
+  EXPECT_EQ(3, count_);
+  EXPECT_EQ(3, intern_table.size());
+  std::string ciphertext = aead_1->Encrypt("plaintext", "ad").ValueOrDie();
+  EXPECT_EQ("plaintext", aead_2->Decrypt(ciphertext, "ad").ValueOrDie());
+  ciphertext = aead_2->Encrypt("plaintext", "ad").ValueOrDie();
+  EXPECT_FALSE(aead_1->Decrypt(ciphertext, "ad").ok());
+
+  // A key with other key data is not shared.
+  keyset_2.mutable_key(0)->mutable_key_data()->set_value("other key");
+  std::unique_ptr<Aead> aead_3 = GetAead(keyset_2, &intern_table);
+  EXPECT_EQ(4, count_);
+
+  // Without the table every key is created again.
+  std::unique_ptr<Aead> aead_4 = GetAead(keyset_1, nullptr);
+  EXPECT_EQ(6, count_);
+}
+
+TEST_F(PrimitiveInternTableTest, ReleasedPrimitivesAreCreatedAgain) {
+  PrimitiveInternTable intern_table;
+  Keyset keyset;
+  AddKey(1, "key 1", &keyset);
+  keyset.set_primary_key_id(1);
+  std::unique_ptr<Aead> aead = GetAead(keyset, &intern_table);
+  EXPECT_EQ(1, intern_table.size());
+  aead.reset();
+  EXPECT_EQ(0, intern_table.size());
+
+  aead = GetAead(keyset, &intern_table);
+  EXPECT_EQ(2, count_);
+  EXPECT_EQ(1, intern_table.size());
+}
+
+TEST_F(PrimitiveInternTableTest, FailuresAreNotShared) {
+  PrimitiveInternTable intern_table;
+  KeyData key_data;
+  key_data.set_type_url("unknown key type");
+  for (int i = 0; i < 2; i++) {
+    EXPECT_FALSE(intern_table.GetPrimitive<Aead>(key_data).ok());
+  }
+  EXPECT_EQ(0, intern_table.size());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -16,18 +16,24 @@
 
 #include "tink/primitive_set.h"
 
+#include <memory>
+#include <string>
 #include <thread>  // NOLINT(build/c++11)
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
 #include "tink/crypto_format.h"
 #include "tink/mac.h"
+#include "tink/space_used.h"
 #include "tink/util/test_matchers.h"
 #include "tink/util/test_util.h"
 #include "proto/tink.pb.h"
 
 using ::crypto::tink::test::DummyMac;
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
 using ::google::crypto::tink::KeysetInfo;
 using ::google::crypto::tink::KeyStatusType;
 using ::google::crypto::tink::OutputPrefixType;
@@ -424,7 +430,8 @@ TEST_F(PrimitiveSetTest, GetAll) {
   for (auto* entry : pset.get_all()) {
     auto mac_or = entry->get_primitive().ComputeMac("");
     ASSERT_THAT(mac_or.status(), IsOk());
-    mac_and_id.push_back({mac_or.ValueOrDie(), entry->get_identifier()});
+    mac_and_id.push_back(
+        {mac_or.ValueOrDie(), std::string(entry->get_identifier())});
   }
 
   // In the following id part, the first byte is 1 for Tink.
@@ -438,6 +445,393 @@ TEST_F(PrimitiveSetTest, GetAll) {
   EXPECT_THAT(mac_and_id, UnorderedElementsAreArray(expected_result));
 }
 
+TEST_F(PrimitiveSetTest, FrozenLookups) {
+  PrimitiveSet<Mac> pset;
+  EXPECT_THAT(pset.AddPrimitive(absl::make_unique<DummyMac>("MAC1"),
+                                CreateKey(0x01010101, OutputPrefixType::TINK,
+                                          KeyStatusType::ENABLED))
+                  .status(),
+              IsOk());
+  EXPECT_THAT(pset.AddPrimitive(absl::make_unique<DummyMac>("MAC2"),
+                                CreateKey(0x01010101, OutputPrefixType::LEGACY,
+                                          KeyStatusType::ENABLED))
+                  .status(),
+              IsOk());
+  auto entry_or = pset.AddPrimitive(
+      absl::make_unique<DummyMac>("MAC3"),
+      CreateKey(0x02020202, OutputPrefixType::TINK, KeyStatusType::ENABLED));
+  ASSERT_THAT(entry_or.status(), IsOk());
+  EXPECT_THAT(pset.set_primary(entry_or.ValueOrDie()), IsOk());
+  EXPECT_THAT(pset.AddPrimitive(absl::make_unique<DummyMac>("MAC4"),
+                                CreateKey(0x02020202, OutputPrefixType::RAW,
+                                          KeyStatusType::ENABLED))
+                  .status(),
+              IsOk());
+
+  EXPECT_FALSE(pset.is_frozen());
+  pset.Freeze();
+  EXPECT_TRUE(pset.is_frozen());
+  pset.Freeze();  // no-op
+  EXPECT_TRUE(pset.is_frozen());
+
+  auto tink_or = pset.get_primitives("\1\1\1\1\1");
+  ASSERT_THAT(tink_or.status(), IsOk());
+  ASSERT_EQ(1, tink_or.ValueOrDie()->size());
+  EXPECT_EQ("13:0:DummyMac:MAC1",
+            (*tink_or.ValueOrDie())[0]->get_primitive().ComputeMac("")
+                .ValueOrDie());
+
+  auto legacy_or = pset.get_primitives(absl::string_view("\0\1\1\1\1", 5));
+  ASSERT_THAT(legacy_or.status(), IsOk());
+  ASSERT_EQ(1, legacy_or.ValueOrDie()->size());
+  EXPECT_EQ("13:0:DummyMac:MAC2",
+            (*legacy_or.ValueOrDie())[0]->get_primitive().ComputeMac("")
+                .ValueOrDie());
+
+  auto primary_or = pset.get_primitives("\1\2\2\2\2");
+  ASSERT_THAT(primary_or.status(), IsOk());
+  ASSERT_EQ(1, primary_or.ValueOrDie()->size());
+  EXPECT_EQ(pset.get_primary(), (*primary_or.ValueOrDie())[0].get());
+
+  auto raw_or = pset.get_raw_primitives();
+  ASSERT_THAT(raw_or.status(), IsOk());
+  EXPECT_EQ(1, raw_or.ValueOrDie()->size());
+
+  EXPECT_EQ(util::error::NOT_FOUND,
+            pset.get_primitives("\1\3\3\3\3").status().error_code());
+  EXPECT_EQ(util::error::NOT_FOUND,
+            pset.get_primitives(absl::string_view("\0\0\0\0\0", 5))
+                .status()
+                .error_code());
+  EXPECT_EQ(util::error::NOT_FOUND,
+            pset.get_primitives("prefix").status().error_code());
+  EXPECT_EQ(4, pset.get_all().size());
+}
+
+TEST_F(PrimitiveSetTest, FrozenSetIsImmutable) {
+  PrimitiveSet<Mac> pset;
+  auto entry_or = pset.AddPrimitive(
+      absl::make_unique<DummyMac>("MAC1"),
+      CreateKey(0x01010101, OutputPrefixType::TINK, KeyStatusType::ENABLED));
+  ASSERT_THAT(entry_or.status(), IsOk());
+  pset.Freeze();
+
+  EXPECT_EQ(util::error::FAILED_PRECONDITION,
+            pset.set_primary(entry_or.ValueOrDie()).error_code());
+  EXPECT_EQ(util::error::FAILED_PRECONDITION,
+            pset.AddPrimitive(absl::make_unique<DummyMac>("MAC2"),
+                              CreateKey(0x02020202, OutputPrefixType::TINK,
+                                        KeyStatusType::ENABLED))
+                .status()
+                .error_code());
+  EXPECT_EQ(util::error::FAILED_PRECONDITION, pset.Reserve(10).error_code());
+  EXPECT_EQ(1, pset.get_all().size());
+}
+
+TEST_F(PrimitiveSetTest, FrozenConcurrentLookups) {
+  PrimitiveSet<Mac> mac_set;
+  int offset = 100;
+  int count = 100;
+  add_primitives(&mac_set, offset, count);
+  mac_set.Freeze();
+
+  std::thread access_primitives_a(access_primitives, &mac_set, offset, count);
+  std::thread access_primitives_b(access_primitives, &mac_set, offset, count);
+  access_primitives_a.join();
+  access_primitives_b.join();
+}
+
+TEST_F(PrimitiveSetTest, ManyPrefixes) {
+  PrimitiveSet<Mac> pset;
+  int count = 1000;
+  add_primitives(&pset, 0, 1);
+  auto first_or = pset.get_primitives(absl::string_view("\1\0\0\0\0", 5));
+  ASSERT_THAT(first_or.status(), IsOk());
+  // Adds keys with the same id but another prefix, so that the table grows.
+  add_primitives(&pset, 1, count - 1);
+  for (int i = 0; i < count; i++) {
+    KeysetInfo::KeyInfo key_info =
+        CreateKey(i, OutputPrefixType::LEGACY, KeyStatusType::ENABLED);
+    EXPECT_THAT(pset.AddPrimitive(absl::make_unique<DummyMac>("legacy"),
+                                  key_info)
+                    .status(),
+                IsOk());
+  }
+  EXPECT_EQ(2 * count, pset.get_all().size());
+
+  // Entry vectors do not move when the table grows.
+  auto first_again_or =
+      pset.get_primitives(absl::string_view("\1\0\0\0\0", 5));
+  ASSERT_THAT(first_again_or.status(), IsOk());
+  EXPECT_EQ(first_or.ValueOrDie(), first_again_or.ValueOrDie());
+
+  pset.Freeze();
+  for (int i = 0; i < count; i++) {
+    for (auto prefix_type : {OutputPrefixType::TINK, OutputPrefixType::LEGACY}) {
+      std::string prefix =
+          CryptoFormat::GetOutputPrefix(CreateKey(i, prefix_type,
+                                                  KeyStatusType::ENABLED))
+              .ValueOrDie();
+      auto entries_or = pset.get_primitives(prefix);
+      ASSERT_THAT(entries_or.status(), IsOk());
+      ASSERT_EQ(1, entries_or.ValueOrDie()->size());
+      EXPECT_EQ(i, (*entries_or.ValueOrDie())[0]->get_key_id());
+      EXPECT_EQ(prefix, (*entries_or.ValueOrDie())[0]->get_identifier());
+    }
+  }
+  EXPECT_EQ(util::error::NOT_FOUND,
+            pset.get_raw_primitives().status().error_code());
+}
+
+TEST_F(PrimitiveSetTest, ReservedPrefixes) {
+  PrimitiveSet<Mac> pset;
+  int count = 1000;
+  EXPECT_THAT(pset.Reserve(count), IsOk());
+  add_primitives(&pset, 0, 1);
+  auto first_or = pset.get_primitives(absl::string_view("\1\0\0\0\0", 5));
+  ASSERT_THAT(first_or.status(), IsOk());
+  add_primitives(&pset, 1, count - 1);
+  pset.Freeze();
+
+  // All entries are found, and get_all() lists them in the order in which
+  // they were added.
+  std::vector<PrimitiveSet<Mac>::Entry<Mac>*> entries = pset.get_all();
+  ASSERT_EQ(count, entries.size());
+  for (int i = 0; i < count; i++) {
+    std::string prefix =
+        CryptoFormat::GetOutputPrefix(
+            CreateKey(i, OutputPrefixType::TINK, KeyStatusType::ENABLED))
+            .ValueOrDie();
+    auto entries_or = pset.get_primitives(prefix);
+    ASSERT_THAT(entries_or.status(), IsOk());
+    ASSERT_EQ(1, entries_or.ValueOrDie()->size());
+    EXPECT_EQ(entries[i], (*entries_or.ValueOrDie())[0].get());
+  }
+  EXPECT_EQ(first_or.ValueOrDie(),
+            pset.get_primitives(absl::string_view("\1\0\0\0\0", 5))
+                .ValueOrDie());
+}
+
+TEST_F(PrimitiveSetTest, AdaptiveOrder) {
+  PrimitiveSet<Mac> pset;
+  std::vector<PrimitiveSet<Mac>::Entry<Mac>*> raw_entries;
+  for (int i = 0; i < 3; i++) {
+    auto entry_or = pset.AddPrimitive(
+        absl::make_unique<DummyMac>(absl::StrCat("raw", i)),
+        CreateKey(10 + i, OutputPrefixType::RAW, KeyStatusType::ENABLED));
+    ASSERT_THAT(entry_or.status(), IsOk());
+    raw_entries.push_back(entry_or.ValueOrDie());
+  }
+  ASSERT_THAT(pset.set_primary(raw_entries[1]), IsOk());
+
+  // Disabled by default.
+  EXPECT_FALSE(pset.is_adaptive_order());
+  EXPECT_EQ(0, pset.preferred_index(CryptoFormat::kRawPrefix));
+  pset.RecordSuccess(raw_entries[2]);
+  EXPECT_EQ(0, pset.preferred_index(CryptoFormat::kRawPrefix));
+
+  // The primary is tried first once enabled.
+  ASSERT_THAT(pset.EnableAdaptiveOrder(), IsOk());
+  EXPECT_TRUE(pset.is_adaptive_order());
+  EXPECT_EQ(1, pset.preferred_index(CryptoFormat::kRawPrefix));
+  EXPECT_EQ(0, pset.preferred_index("\1\2\3\4\5"));
+
+  pset.Freeze();
+  EXPECT_EQ(util::error::FAILED_PRECONDITION,
+            pset.EnableAdaptiveOrder().error_code());
+  pset.RecordSuccess(raw_entries[2]);
+  EXPECT_EQ(2, pset.preferred_index(CryptoFormat::kRawPrefix));
+
+  std::vector<size_t> order;
+  for (size_t i = 0; i < 3; i++) {
+    order.push_back(PrimitiveSet<Mac>::AdaptiveOrderIndex(2, i));
+  }
+  EXPECT_EQ(std::vector<size_t>({2, 0, 1}), order);
+  order.clear();
+  for (size_t i = 0; i < 3; i++) {
+    order.push_back(PrimitiveSet<Mac>::AdaptiveOrderIndex(0, i));
+  }
+  EXPECT_EQ(std::vector<size_t>({0, 1, 2}), order);
+}
+
+TEST_F(PrimitiveSetTest, LazyPrimitives) {
+  PrimitiveSet<Mac> pset;
+  int factory_calls = 0;
+  auto dummy_mac_factory = [&factory_calls](const std::string& name) {
+    return [&factory_calls, name]() -> util::StatusOr<std::unique_ptr<Mac>> {
+      factory_calls++;
+      return std::unique_ptr<Mac>(absl::make_unique<DummyMac>(name));
+    };
+  };
+  auto primary_or = pset.AddLazyPrimitive(
+      dummy_mac_factory("MAC1"),
+      CreateKey(0x01010101, OutputPrefixType::TINK, KeyStatusType::ENABLED));
+  ASSERT_THAT(primary_or.status(), IsOk());
+  EXPECT_TRUE(primary_or.ValueOrDie()->is_lazy());
+  ASSERT_THAT(pset.AddLazyPrimitive(dummy_mac_factory("MAC2"),
+                                    CreateKey(0x02020202, OutputPrefixType::TINK,
+                                              KeyStatusType::ENABLED))
+                  .status(),
+              IsOk());
+  ASSERT_THAT(
+      pset.AddLazyPrimitive(
+          []() -> util::StatusOr<std::unique_ptr<Mac>> {
+            return util::Status(util::error::INVALID_ARGUMENT, "bad key");
+          },
+          CreateKey(0x03030303, OutputPrefixType::TINK,
+                    KeyStatusType::ENABLED))
+          .status(),
+      IsOk());
+  EXPECT_EQ(0, factory_calls);
+
+  // Setting the primary creates its primitive.
+  ASSERT_THAT(pset.set_primary(primary_or.ValueOrDie()), IsOk());
+  EXPECT_EQ(1, factory_calls);
+  pset.Freeze();
+
+  // Lookups create the primitives they return, once.
+  for (int i = 0; i < 2; i++) {
+    auto entries_or = pset.get_primitives(std::string("\1\2\2\2\2", 5));
+    ASSERT_THAT(entries_or.status(), IsOk());
+    ASSERT_EQ(1, entries_or.ValueOrDie()->size());
+    EXPECT_EQ("13:0:DummyMac:MAC2",
+              (*entries_or.ValueOrDie())[0]
+                  ->get_primitive()
+                  .ComputeMac("")
+                  .ValueOrDie());
+    EXPECT_EQ(2, factory_calls);
+  }
+
+  // A primitive which cannot be created is reported by the lookup.
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            pset.get_primitives(std::string("\1\3\3\3\3", 5))
+                .status()
+                .error_code());
+  EXPECT_EQ(3, pset.get_all().size());
+
+  // Entries from get_all() give access to their primitives, or the error
+  // with which their creation failed, through get_primitive_or().
+  for (const auto* entry : pset.get_all()) {
+    auto primitive_or = entry->get_primitive_or();
+    if (entry->get_key_id() == 0x03030303) {
+      EXPECT_EQ(util::error::INVALID_ARGUMENT,
+                primitive_or.status().error_code());
+    } else {
+      ASSERT_THAT(primitive_or.status(), IsOk());
+      EXPECT_EQ(&entry->get_primitive(), primitive_or.ValueOrDie());
+    }
+  }
+  EXPECT_EQ(2, factory_calls);
+}
+
+TEST_F(PrimitiveSetTest, SharedPrimitives) {
+  std::shared_ptr<Mac> mac = std::make_shared<DummyMac>("MAC1");
+  auto pset = absl::make_unique<PrimitiveSet<Mac>>();
+  PrimitiveSet<Mac> other_pset;
+  auto key = CreateKey(0x01010101, OutputPrefixType::TINK,
+                       KeyStatusType::ENABLED);
+  auto entry_or = pset->AddSharedPrimitive(mac, key);
+  ASSERT_THAT(entry_or.status(), IsOk());
+  EXPECT_FALSE(entry_or.ValueOrDie()->is_lazy());
+  auto other_entry_or = other_pset.AddSharedPrimitive(mac, key);
+  ASSERT_THAT(other_entry_or.status(), IsOk());
+  EXPECT_EQ(&entry_or.ValueOrDie()->get_primitive(),
+            &other_entry_or.ValueOrDie()->get_primitive());
+
+  // The primitive outlives the set it was added to first.
+  pset.reset();
+  mac.reset();
+  EXPECT_EQ("13:0:DummyMac:MAC1",
+            other_entry_or.ValueOrDie()->get_primitive().ComputeMac("")
+                .ValueOrDie());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            other_pset.AddSharedPrimitive(nullptr, key).status().error_code());
+}
+
+// A DummyMac which reports that it holds 'space_used' bytes.
+class SizedMac : public DummyMac, public SpaceUsedInterface {
+ public:
+  explicit SizedMac(size_t space_used)
+      : DummyMac("sized MAC"), space_used_(space_used) {}
+
+  size_t SpaceUsed() const override { return space_used_; }
+
+ private:
+  size_t space_used_;
+};
+
+TEST_F(PrimitiveSetTest, SpaceUsed) {
+  PrimitiveSet<Mac> pset;
+  size_t empty_space_used = pset.SpaceUsed();
+  EXPECT_LE(sizeof(pset), empty_space_used);
+  ASSERT_THAT(pset.AddPrimitive(absl::make_unique<SizedMac>(100000),
+                                CreateKey(0x01010101, OutputPrefixType::TINK,
+                                          KeyStatusType::ENABLED))
+                  .status(),
+              IsOk());
+  size_t space_used = pset.SpaceUsed();
+  EXPECT_LE(empty_space_used + 100000, space_used);
+  EXPECT_EQ(100000, SpaceUsed(pset.get_all()[0]->get_primitive()));
+
+  // Primitives which do not implement SpaceUsedInterface only count as the
+  // size of their entry.
+  ASSERT_THAT(pset.AddPrimitive(absl::make_unique<DummyMac>("MAC"),
+                                CreateKey(0x02020202, OutputPrefixType::TINK,
+                                          KeyStatusType::ENABLED))
+                  .status(),
+              IsOk());
+  EXPECT_GT(space_used + 100000, pset.SpaceUsed());
+  EXPECT_EQ(0, SpaceUsed(DummyMac("MAC")));
+}
+
+TEST_F(PrimitiveSetTest, EntrySize) {
+  // An entry holds its primitive, a pointer to the state of lazy loading
+  // (which only lazy entries allocate), its 5-byte identifier, its key id
+  // and one byte for each of its enums.  On 64-bit platforms this is 40
+  // bytes, down from 128 with the lazy state inline.
+  EXPECT_LE(sizeof(PrimitiveSet<Mac>::Entry<Mac>),
+            sizeof(std::shared_ptr<Mac>) + sizeof(void*) + 16);
+
+  // Lazy entries account for their state in SpaceUsed().
+  PrimitiveSet<Mac> eager_set;
+  ASSERT_THAT(eager_set.AddPrimitive(absl::make_unique<DummyMac>("MAC"),
+                                     CreateKey(0x01010101,
+                                               OutputPrefixType::TINK,
+                                               KeyStatusType::ENABLED))
+                  .status(),
+              IsOk());
+  PrimitiveSet<Mac> lazy_set;
+  ASSERT_THAT(
+      lazy_set
+          .AddLazyPrimitive(
+              []() -> util::StatusOr<std::unique_ptr<Mac>> {
+                return {absl::make_unique<DummyMac>("MAC")};
+              },
+              CreateKey(0x01010101, OutputPrefixType::TINK,
+                        KeyStatusType::ENABLED))
+          .status(),
+      IsOk());
+  EXPECT_LT(eager_set.SpaceUsed(), lazy_set.SpaceUsed());
+}
+
+TEST_F(PrimitiveSetTest, GetPrimitiveByKeyId) {
+  PrimitiveSet<Mac> pset;
+  for (uint32_t key_id : {0x01010101, 0x02020202}) {
+    ASSERT_THAT(pset.AddPrimitive(absl::make_unique<DummyMac>(
+                                      absl::StrCat("MAC ", key_id)),
+                                  CreateKey(key_id, OutputPrefixType::RAW,
+                                            KeyStatusType::ENABLED))
+                    .status(),
+                IsOk());
+  }
+  auto entry_result = pset.get_primitive_by_key_id(0x02020202);
+  ASSERT_THAT(entry_result.status(), IsOk());
+  EXPECT_EQ(0x02020202, entry_result.ValueOrDie()->get_key_id());
+  EXPECT_EQ(pset.get_all()[1], entry_result.ValueOrDie());
+  EXPECT_THAT(pset.get_primitive_by_key_id(0x03030303).status(),
+              StatusIs(util::error::NOT_FOUND));
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
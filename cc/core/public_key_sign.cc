@@ -0,0 +1,49 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "tink/public_key_sign.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/output_stream_with_result.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+util::StatusOr<std::vector<std::string>> PublicKeySign::SignBatch(
+    absl::Span<const absl::string_view> data) const {
+  std::vector<std::string> signatures;
+  signatures.reserve(data.size());
+  for (absl::string_view item : data) {
+    auto sign_result = Sign(item);
+    if (!sign_result.ok()) return sign_result.status();
+    signatures.push_back(std::move(sign_result.ValueOrDie()));
+  }
+  return std::move(signatures);
+}
+
+util::StatusOr<std::unique_ptr<OutputStreamWithResult<std::string>>>
+PublicKeySign::NewSignOutputStream() const {
+  return util::Status(util::error::UNIMPLEMENTED,
+                      "Streaming signing is not supported by this primitive");
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,75 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+#include "tink/public_key_sign.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::DummyPublicKeySign;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+// Signs everything except "bad".
+class FailingPublicKeySign : public PublicKeySign {
+ public:
+  util::StatusOr<std::string> Sign(absl::string_view data) const override {
+    if (data == "bad") {
+      return util::Status(util::error::INTERNAL, "Signing failed.");
+    }
+    return std::string(data);
+  }
+};
+
+TEST(PublicKeySignTest, SignBatch) {
+  DummyPublicKeySign sign("dummy");
+  std::vector<absl::string_view> data = {"first", "second", ""};
+  auto signatures_or = sign.SignBatch(data);
+  ASSERT_THAT(signatures_or.status(), IsOk());
+  EXPECT_THAT(signatures_or.ValueOrDie(),
+              ElementsAre(sign.Sign("first").ValueOrDie(),
+                          sign.Sign("second").ValueOrDie(),
+                          sign.Sign("").ValueOrDie()));
+}
+
+TEST(PublicKeySignTest, SignEmptyBatch) {
+  DummyPublicKeySign sign("dummy");
+  auto signatures_or = sign.SignBatch({});
+  ASSERT_THAT(signatures_or.status(), IsOk());
+  EXPECT_THAT(signatures_or.ValueOrDie(), IsEmpty());
+}
+
+TEST(PublicKeySignTest, SignBatchFails) {
+  FailingPublicKeySign sign;
+  std::vector<absl::string_view> data = {"good", "bad"};
+  EXPECT_THAT(sign.SignBatch(data).status(),
+              StatusIs(util::error::INTERNAL));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,57 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/public_key_verify.h"
+
+#include <memory>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/output_stream_with_result.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+util::StatusOr<std::vector<util::Status>> PublicKeyVerify::VerifyBatch(
+    absl::Span<const absl::string_view> signatures,
+    absl::Span<const absl::string_view> data) const {
+  if (signatures.size() != data.size()) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("Batch has ", signatures.size(), " signatures but ",
+                     data.size(), " data entries"));
+  }
+  std::vector<util::Status> results;
+  results.reserve(signatures.size());
+  for (size_t i = 0; i < signatures.size(); i++) {
+    results.push_back(Verify(signatures[i], data[i]));
+  }
+  return std::move(results);
+}
+
+util::StatusOr<std::unique_ptr<OutputStreamWithResult<util::Status>>>
+PublicKeyVerify::NewVerifyOutputStream(absl::string_view signature) const {
+  return util::Status(
+      util::error::UNIMPLEMENTED,
+      "Streaming verification is not supported by this primitive");
+}
+
+}  // namespace tink
+}  // namespace crypto
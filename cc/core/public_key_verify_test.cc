@@ -0,0 +1,75 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/public_key_verify.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::DummyPublicKeySign;
+using ::crypto::tink::test::DummyPublicKeyVerify;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Not;
+using ::testing::SizeIs;
+
+TEST(PublicKeyVerifyTest, VerifyBatch) {
+  DummyPublicKeySign sign("dummy");
+  DummyPublicKeyVerify verify("dummy");
+  std::string first_signature = sign.Sign("first").ValueOrDie();
+  std::string second_signature = sign.Sign("second").ValueOrDie();
+  std::vector<absl::string_view> signatures = {first_signature,
+                                               second_signature, "garbage"};
+  std::vector<absl::string_view> data = {"first", "wrong data", "third"};
+
+  auto results_or = verify.VerifyBatch(signatures, data);
+  ASSERT_THAT(results_or.status(), IsOk());
+  const std::vector<util::Status>& results = results_or.ValueOrDie();
+  ASSERT_THAT(results, SizeIs(3));
+  EXPECT_THAT(results[0], IsOk());
+  EXPECT_THAT(results[1], Not(IsOk()));
+  EXPECT_THAT(results[2], Not(IsOk()));
+}
+
+TEST(PublicKeyVerifyTest, VerifyEmptyBatch) {
+  DummyPublicKeyVerify verify("dummy");
+  auto results_or = verify.VerifyBatch({}, {});
+  ASSERT_THAT(results_or.status(), IsOk());
+  EXPECT_THAT(results_or.ValueOrDie(), SizeIs(0));
+}
+
+TEST(PublicKeyVerifyTest, VerifyBatchSizeMismatch) {
+  DummyPublicKeyVerify verify("dummy");
+  std::vector<absl::string_view> signatures = {"a", "b"};
+  std::vector<absl::string_view> data = {"a"};
+  EXPECT_THAT(verify.VerifyBatch(signatures, data).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
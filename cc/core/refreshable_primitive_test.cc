@@ -0,0 +1,179 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/refreshable_primitive.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "tink/aead.h"
+#include "tink/aead/aead_wrapper.h"
+#include "tink/keyset_handle.h"
+#include "tink/registry.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_keyset_handle.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::AddKeyData;
+using ::crypto::tink::test::DummyAeadKeyManager;
+using ::crypto::tink::test::IsOk;
+using ::google::crypto::tink::KeyData;
+using ::google::crypto::tink::Keyset;
+using ::google::crypto::tink::KeyStatusType;
+using ::google::crypto::tink::OutputPrefixType;
+
+constexpr char kKeyType[] = "type.googleapis.com/some.CountedAeadKey";
+
+class RefreshablePrimitiveTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Registry::Reset();
+    ASSERT_THAT(
+        Registry::RegisterPrimitiveWrapper(absl::make_unique<AeadWrapper>()),
+        IsOk());
+    ASSERT_THAT(
+        Registry::RegisterKeyManager(
+            absl::make_unique<DummyAeadKeyManager>(kKeyType, &count_), true),
+        IsOk());
+  }
+
+  void TearDown() override { Registry::Reset(); }
+
+  static void AddKey(uint32_t key_id, const std::string& value,
+                     Keyset* keyset) {
+    KeyData key_data;
+    key_data.set_type_url(kKeyType);
+    key_data.set_value(value);
+    key_data.set_key_material_type(KeyData::SYMMETRIC);
+    AddKeyData(key_data, key_id, OutputPrefixType::TINK,
+               KeyStatusType::ENABLED, keyset);
+  }
+
+  std::atomic<int> count_{0};
+};
+
+TEST_F(RefreshablePrimitiveTest, UnchangedKeysAreReused) {
+  Keyset keyset;
+  AddKey(1, "key 1", &keyset);
+  AddKey(2, "key 2", &keyset);
+  keyset.set_primary_key_id(1);
+  auto refreshable_result = RefreshablePrimitive<Aead>::New(
+      *TestKeysetHandle::GetKeysetHandle(keyset));
+  ASSERT_THAT(refreshable_result.status(), IsOk());
+  auto& refreshable = refreshable_result.ValueOrDie();
+  EXPECT_EQ(2, count_);
+  std::shared_ptr<Aead> old_aead = refreshable->Get();
+  std::string ciphertext = old_aead->Encrypt("plaintext", "ad").ValueOrDie();
+
+  // Adding a key only creates the primitive of the new key.
+  AddKey(3, "key 3", &keyset);
+  keyset.set_primary_key_id(3);
+  ASSERT_THAT(refreshable->Refresh(*TestKeysetHandle::GetKeysetHandle(keyset)),
+              IsOk());
+  EXPECT_EQ(3, count_);
+  std::shared_ptr<Aead> new_aead = refreshable->Get();
+  EXPECT_NE(old_aead, new_aead);
+  EXPECT_EQ("plaintext", new_aead->Decrypt(ciphertext, "ad").ValueOrDie());
+  std::string new_ciphertext =
+      new_aead->Encrypt("plaintext", "ad").ValueOrDie();
+  EXPECT_NE(ciphertext, new_ciphertext);
+
+  // The old primitive is not affected.
+  EXPECT_EQ("plaintext", old_aead->Decrypt(ciphertext, "ad").ValueOrDie());
+  EXPECT_FALSE(old_aead->Decrypt(new_ciphertext, "ad").ok());
+  EXPECT_EQ(ciphertext, old_aead->Encrypt("plaintext", "ad").ValueOrDie());
+
+  // Keys whose key data changed are created again.
+  keyset.mutable_key(1)->mutable_key_data()->set_value("new key 2");
+  ASSERT_THAT(refreshable->Refresh(*TestKeysetHandle::GetKeysetHandle(keyset)),
+              IsOk());
+  EXPECT_EQ(4, count_);
+}
+
+TEST_F(RefreshablePrimitiveTest, FailedRefreshKeepsThePrimitive) {
+  Keyset keyset;
+  AddKey(1, "key 1", &keyset);
+  keyset.set_primary_key_id(1);
+  auto refreshable_result = RefreshablePrimitive<Aead>::New(
+      *TestKeysetHandle::GetKeysetHandle(keyset));
+  ASSERT_THAT(refreshable_result.status(), IsOk());
+  auto& refreshable = refreshable_result.ValueOrDie();
+  std::shared_ptr<Aead> aead = refreshable->Get();
+
+  keyset.set_primary_key_id(2);
+  EXPECT_FALSE(
+      refreshable->Refresh(*TestKeysetHandle::GetKeysetHandle(keyset)).ok());
+  keyset.set_primary_key_id(1);
+  keyset.mutable_key(0)->mutable_key_data()->set_type_url("unknown");
+  EXPECT_FALSE(
+      refreshable->Refresh(*TestKeysetHandle::GetKeysetHandle(keyset)).ok());
+  EXPECT_EQ(aead, refreshable->Get());
+
+  EXPECT_FALSE(RefreshablePrimitive<Aead>::New(
+                   *TestKeysetHandle::GetKeysetHandle(keyset))
+                   .ok());
+}
+
+TEST_F(RefreshablePrimitiveTest, ConcurrentRefreshes) {
+  Keyset keyset;
+  AddKey(1, "key 1", &keyset);
+  keyset.set_primary_key_id(1);
+  auto refreshable_result = RefreshablePrimitive<Aead>::New(
+      *TestKeysetHandle::GetKeysetHandle(keyset));
+  ASSERT_THAT(refreshable_result.status(), IsOk());
+  auto& refreshable = refreshable_result.ValueOrDie();
+  std::string ciphertext =
+      refreshable->Get()->Encrypt("plaintext", "ad").ValueOrDie();
+
+  std::atomic<bool> done(false);
+  std::vector<std::thread> readers;
+  std::atomic<int> failures(0);
+  for (int i = 0; i < 4; i++) {
+    readers.emplace_back([&]() {
+      while (!done) {
+        auto result = refreshable->Get()->Decrypt(ciphertext, "ad");
+        if (!result.ok() || result.ValueOrDie() != "plaintext") failures++;
+      }
+    });
+  }
+  for (uint32_t key_id = 2; key_id < 50; key_id++) {
+    AddKey(key_id, "key", &keyset);
+    keyset.set_primary_key_id(key_id);
+    ASSERT_THAT(
+        refreshable->Refresh(*TestKeysetHandle::GetKeysetHandle(keyset)),
+        IsOk());
+  }
+  done = true;
+  for (auto& reader : readers) reader.join();
+  EXPECT_EQ(0, failures);
+  EXPECT_EQ(49, count_);
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
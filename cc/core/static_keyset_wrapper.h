@@ -0,0 +1,150 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef TINK_CORE_STATIC_KEYSET_WRAPPER_H_
+#define TINK_CORE_STATIC_KEYSET_WRAPPER_H_
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+
+#include "absl/memory/memory.h"
+#include "tink/config/tink_fips.h"
+#include "tink/core/template_util.h"
+#include "tink/internal/key_info.h"
+#include "tink/internal/keyset_wrapper.h"
+#include "tink/primitive_set.h"
+#include "tink/primitive_wrapper.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+namespace internal {
+
+// Defines ::value as true if the given List of primitives contains P.
+template <typename P, typename PrimitiveList>
+struct ListContains;
+template <typename P, typename... Primitives>
+struct ListContains<P, List<Primitives...>>
+    : public OccursInTuple<P, std::tuple<Primitives...>> {};
+
+}  // namespace internal
+
+// A KeysetWrapper<Q> for a list of key types fixed at compile time. Keys are
+// dispatched to the KeyTypeManagers by comparing type URLs, parsed into the
+// manager's KeyProto and turned into primitives P, which are then wrapped
+// into a Q by the given PrimitiveWrapper. The global Registry is not used at
+// all, so no registration is needed, no lock is taken and no type erasure
+// is involved; only the given key types are linked into the binary.
+//
+// Each KeyTypeManager must be default constructible and support primitive P.
+// Keys whose type is not in the list are rejected with NOT_FOUND.
+//
+// Example:
+//   StaticKeysetWrapper<Aead, Aead, AesGcmKeyManager, AesEaxKeyManager>
+//       wrapper(absl::make_unique<AeadWrapper>());
+//   auto aead_result = wrapper.Wrap(keyset);
+template <typename P, typename Q, typename... KeyTypeManagers>
+class StaticKeysetWrapper : public KeysetWrapper<Q> {
+ public:
+  static_assert(sizeof...(KeyTypeManagers) > 0,
+                "At least one KeyTypeManager must be given.");
+  static_assert(
+      !internal::HasDuplicates<KeyTypeManagers...>::value,
+      "List of KeyTypeManagers contains a duplicate, which is not allowed.");
+  static_assert(absl::conjunction<internal::ListContains<
+                    P, typename KeyTypeManagers::PrimitiveList>...>::value,
+                "All KeyTypeManagers must support the primitive.");
+
+  explicit StaticKeysetWrapper(std::unique_ptr<PrimitiveWrapper<P, Q>> wrapper)
+      : wrapper_(std::move(wrapper)) {}
+
+  crypto::tink::util::StatusOr<std::unique_ptr<Q>> Wrap(
+      const google::crypto::tink::Keyset& keyset) const override {
+    crypto::tink::util::Status status = ValidateKeyset(keyset);
+    if (!status.ok()) return status;
+    auto primitives = absl::make_unique<PrimitiveSet<P>>();
+    for (const google::crypto::tink::Keyset::Key& key : keyset.key()) {
+      if (key.status() != google::crypto::tink::KeyStatusType::ENABLED) {
+        continue;
+      }
+      auto primitive = GetPrimitive(key.key_data());
+      if (!primitive.ok()) return primitive.status();
+      auto entry = primitives->AddPrimitive(std::move(primitive.ValueOrDie()),
+                                            KeyInfoFromKey(key));
+      if (!entry.ok()) return entry.status();
+      if (key.key_id() == keyset.primary_key_id()) {
+        auto primary_result = primitives->set_primary(entry.ValueOrDie());
+        if (!primary_result.ok()) return primary_result;
+      }
+    }
+    return wrapper_->Wrap(std::move(primitives));
+  }
+
+  // Creates the primitive for a single key.
+  crypto::tink::util::StatusOr<std::unique_ptr<P>> GetPrimitive(
+      const google::crypto::tink::KeyData& key_data) const {
+    return GetPrimitiveFromManager<0>(key_data);
+  }
+
+ private:
+  template <std::size_t I>
+  typename std::enable_if<
+      I == sizeof...(KeyTypeManagers),
+      crypto::tink::util::StatusOr<std::unique_ptr<P>>>::type
+  GetPrimitiveFromManager(const google::crypto::tink::KeyData& key_data) const {
+    return ToStatusF(crypto::tink::util::error::NOT_FOUND,
+                     "No manager for type '%s' has been configured.",
+                     key_data.type_url());
+  }
+
+  template <std::size_t I>
+  typename std::enable_if<
+      (I < sizeof...(KeyTypeManagers)),
+      crypto::tink::util::StatusOr<std::unique_ptr<P>>>::type
+  GetPrimitiveFromManager(const google::crypto::tink::KeyData& key_data) const {
+    const auto& manager = std::get<I>(managers_);
+    if (key_data.type_url() != manager.get_key_type()) {
+      return GetPrimitiveFromManager<I + 1>(key_data);
+    }
+    crypto::tink::util::Status status =
+        ChecksFipsCompatibility(manager.FipsStatus());
+    if (!status.ok()) return status;
+    typename std::tuple_element<I, std::tuple<KeyTypeManagers...>>::type::
+        KeyProto key_proto;
+    if (!key_proto.ParseFromString(key_data.value())) {
+      return ToStatusF(crypto::tink::util::error::INVALID_ARGUMENT,
+                       "Could not parse key_data.value as key type '%s'.",
+                       key_data.type_url());
+    }
+    status = manager.ValidateKey(key_proto);
+    if (!status.ok()) return status;
+    return manager.template GetPrimitive<P>(key_proto);
+  }
+
+  const std::tuple<KeyTypeManagers...> managers_;
+  const std::unique_ptr<PrimitiveWrapper<P, Q>> wrapper_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_CORE_STATIC_KEYSET_WRAPPER_H_
@@ -0,0 +1,134 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "tink/core/static_keyset_wrapper.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "tink/aead.h"
+#include "tink/aead/aead_wrapper.h"
+#include "tink/aead/aes_eax_key_manager.h"
+#include "tink/aead/aes_gcm_key_manager.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+#include "proto/aes_eax.pb.h"
+#include "proto/aes_gcm.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::AddRawKey;
+using ::crypto::tink::test::AddTinkKey;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::AesEaxKey;
+using ::google::crypto::tink::AesEaxKeyFormat;
+using ::google::crypto::tink::AesGcmKey;
+using ::google::crypto::tink::AesGcmKeyFormat;
+using ::google::crypto::tink::KeyData;
+using ::google::crypto::tink::Keyset;
+using ::google::crypto::tink::KeyStatusType;
+using ::testing::Eq;
+using ::testing::HasSubstr;
+
+using TestKeysetWrapper =
+    StaticKeysetWrapper<Aead, Aead, AesGcmKeyManager, AesEaxKeyManager>;
+
+AesGcmKey NewAesGcmKey() {
+  AesGcmKeyFormat key_format;
+  key_format.set_key_size(16);
+  return AesGcmKeyManager().CreateKey(key_format).ValueOrDie();
+}
+
+AesEaxKey NewAesEaxKey() {
+  AesEaxKeyFormat key_format;
+  key_format.set_key_size(16);
+  key_format.mutable_params()->set_iv_size(16);
+  return AesEaxKeyManager().CreateKey(key_format).ValueOrDie();
+}
+
+TEST(StaticKeysetWrapperTest, Wrap) {
+  Keyset keyset;
+  AddTinkKey(AesGcmKeyManager().get_key_type(), 42, NewAesGcmKey(),
+             KeyStatusType::ENABLED, KeyData::SYMMETRIC, &keyset);
+  AddRawKey(AesEaxKeyManager().get_key_type(), 43, NewAesEaxKey(),
+            KeyStatusType::ENABLED, KeyData::SYMMETRIC, &keyset);
+  keyset.set_primary_key_id(43);
+
+  TestKeysetWrapper wrapper(absl::make_unique<AeadWrapper>());
+  auto aead_result = wrapper.Wrap(keyset);
+  ASSERT_THAT(aead_result.status(), IsOk());
+  std::unique_ptr<Aead> aead = std::move(aead_result.ValueOrDie());
+
+  auto ciphertext = aead->Encrypt("plaintext", "aad");
+  ASSERT_THAT(ciphertext.status(), IsOk());
+  auto plaintext = aead->Decrypt(ciphertext.ValueOrDie(), "aad");
+  ASSERT_THAT(plaintext.status(), IsOk());
+  EXPECT_THAT(plaintext.ValueOrDie(), Eq("plaintext"));
+
+  // The primary is the raw AES-EAX key.
+  auto eax = wrapper.GetPrimitive(keyset.key(1).key_data());
+  ASSERT_THAT(eax.status(), IsOk());
+  EXPECT_THAT(
+      eax.ValueOrDie()->Decrypt(ciphertext.ValueOrDie(), "aad").status(),
+      IsOk());
+}
+
+TEST(StaticKeysetWrapperTest, UnknownKeyTypeFails) {
+  Keyset keyset;
+  AddTinkKey(AesEaxKeyManager().get_key_type(), 42, NewAesEaxKey(),
+             KeyStatusType::ENABLED, KeyData::SYMMETRIC, &keyset);
+  keyset.set_primary_key_id(42);
+
+  StaticKeysetWrapper<Aead, Aead, AesGcmKeyManager> wrapper(
+      absl::make_unique<AeadWrapper>());
+  EXPECT_THAT(wrapper.Wrap(keyset).status(),
+              StatusIs(util::error::NOT_FOUND,
+                       HasSubstr(AesEaxKeyManager().get_key_type())));
+}
+
+TEST(StaticKeysetWrapperTest, InvalidKeyFails) {
+  AesGcmKey key = NewAesGcmKey();
+  key.set_key_value("too short");
+  Keyset keyset;
+  AddTinkKey(AesGcmKeyManager().get_key_type(), 42, key,
+             KeyStatusType::ENABLED, KeyData::SYMMETRIC, &keyset);
+  keyset.set_primary_key_id(42);
+
+  TestKeysetWrapper wrapper(absl::make_unique<AeadWrapper>());
+  EXPECT_FALSE(wrapper.Wrap(keyset).ok());
+}
+
+TEST(StaticKeysetWrapperTest, DisabledKeysAreSkipped) {
+  Keyset keyset;
+  AddTinkKey(AesGcmKeyManager().get_key_type(), 42, NewAesGcmKey(),
+             KeyStatusType::ENABLED, KeyData::SYMMETRIC, &keyset);
+  AddTinkKey("some unknown type", 43, NewAesGcmKey(), KeyStatusType::DISABLED,
+             KeyData::SYMMETRIC, &keyset);
+  keyset.set_primary_key_id(42);
+
+  TestKeysetWrapper wrapper(absl::make_unique<AeadWrapper>());
+  EXPECT_THAT(wrapper.Wrap(keyset).status(), IsOk());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,33 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/thread_pool_executor.h"
+
+#include <memory>
+
+#include "absl/memory/memory.h"
+#include "tink/executor.h"
+#include "tink/internal/thread_pool.h"
+
+namespace crypto {
+namespace tink {
+
+std::unique_ptr<Executor> NewThreadPoolExecutor(int num_threads) {
+  return absl::make_unique<internal::ThreadPool>(num_threads);
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,103 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/thread_pool_executor.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "tink/executor.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+TEST(ThreadPoolExecutorTest, Schedule) {
+  std::atomic<int> sum(0);
+  {
+    std::unique_ptr<Executor> executor = NewThreadPoolExecutor(3);
+    EXPECT_EQ(3, executor->num_threads());
+    for (int i = 1; i <= 100; i++) {
+      executor->Schedule([&sum, i]() { sum += i; });
+    }
+  }
+  EXPECT_EQ(5050, sum);
+}
+
+TEST(ThreadPoolExecutorTest, TasksScheduleTasks) {
+  std::unique_ptr<Executor> executor = NewThreadPoolExecutor(4);
+  absl::BlockingCounter done(100);
+  std::atomic<int> calls(0);
+  for (int i = 0; i < 10; i++) {
+    executor->Schedule([&executor, &calls, &done]() {
+      // Stays in the queue of this worker, unless another one steals it.
+      for (int j = 0; j < 10; j++) {
+        executor->Schedule([&calls, &done]() {
+          calls++;
+          done.DecrementCount();
+        });
+      }
+    });
+  }
+  done.Wait();
+  EXPECT_EQ(100, calls);
+}
+
+TEST(ThreadPoolExecutorTest, ParallelFor) {
+  for (int num_threads : {0, 1, 4}) {
+    SCOPED_TRACE(num_threads);
+    std::unique_ptr<Executor> executor = NewThreadPoolExecutor(num_threads);
+    std::vector<int> calls(1000, 0);
+    executor->ParallelFor(1000, [&calls](int i) { calls[i]++; });
+    EXPECT_EQ(std::vector<int>(1000, 1), calls);
+  }
+}
+
+// Runs the tasks on the calling thread, to check the default ParallelFor().
+class InlineExecutor : public Executor {
+ public:
+  void Schedule(std::function<void()> task) override {
+    scheduled_++;
+    task();
+  }
+  int num_threads() const override { return 2; }
+  int scheduled() const { return scheduled_; }
+
+ private:
+  int scheduled_ = 0;
+};
+
+TEST(ExecutorTest, DefaultParallelFor) {
+  InlineExecutor executor;
+  std::vector<int> calls(10, 0);
+  executor.ParallelFor(10, [&calls](int i) { calls[i]++; });
+  EXPECT_EQ(std::vector<int>(10, 1), calls);
+  EXPECT_EQ(2, executor.scheduled());
+
+  // No more tasks than there are indices besides the caller's.
+  executor.ParallelFor(2, [&calls](int i) { calls[i]++; });
+  EXPECT_EQ(3, executor.scheduled());
+  executor.ParallelFor(0, [](int) { FAIL(); });
+  EXPECT_EQ(3, executor.scheduled());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,54 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/tracing.h"
+
+#include <atomic>
+#include <memory>
+
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+std::atomic<Tracer*> registered_tracer{nullptr};
+
+}  // namespace
+
+util::Status RegisterTracer(std::unique_ptr<Tracer> tracer) {
+  if (tracer == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Tracer must be non-null.");
+  }
+  Tracer* expected = nullptr;
+  if (!registered_tracer.compare_exchange_strong(expected, tracer.get(),
+                                                 std::memory_order_acq_rel)) {
+    return util::Status(util::error::ALREADY_EXISTS,
+                        "A tracer is already registered.");
+  }
+  // Intentionally leaked: spans may be started until the program exits.
+  tracer.release();
+  return util::OkStatus();
+}
+
+Tracer* GetTracer() {
+  return registered_tracer.load(std::memory_order_acquire);
+}
+
+}  // namespace tink
+}  // namespace crypto
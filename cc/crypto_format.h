@@ -17,8 +17,12 @@
 #ifndef TINK_CRYPTO_FORMAT_H_
 #define TINK_CRYPTO_FORMAT_H_
 
+#include <array>
+#include <cstdint>
+#include <string>
 #include <vector>
 
+#include "absl/strings/string_view.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
 
@@ -44,10 +48,36 @@ class CryptoFormat {
   static constexpr int kRawPrefixSize = 0;
   static const absl::string_view kRawPrefix;  // empty string
 
+  // An output prefix held inline, i.e. without any heap allocation.  It is
+  // either empty (RAW) or kNonRawPrefixSize bytes long.
+  class OutputPrefix {
+   public:
+    // Constructs the empty (RAW) prefix.
+    OutputPrefix() : bytes_{}, size_(0) {}
+    // Constructs the prefix 'start_byte' followed by 'key_id' in big endian
+    // order.
+    OutputPrefix(uint8_t start_byte, uint32_t key_id);
+
+    const char* data() const { return bytes_.data(); }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    absl::string_view view() const { return absl::string_view(data(), size_); }
+    operator absl::string_view() const { return view(); }  // NOLINT
+
+   private:
+    std::array<char, kNonRawPrefixSize> bytes_;
+    uint8_t size_;
+  };
+
   // Generates the prefix for the outputs handled with the given key_info.
   // Returns an error if the prefix type 'output_prefix_type' is invalid.
   static crypto::tink::util::StatusOr<std::string> GetOutputPrefix(
       const google::crypto::tink::KeysetInfo::KeyInfo& key_info);
+
+  // Like GetOutputPrefix(), but returns the prefix inline.
+  static crypto::tink::util::StatusOr<OutputPrefix> GetInlineOutputPrefix(
+      const google::crypto::tink::KeysetInfo::KeyInfo& key_info);
 };
 
 }  // namespace tink
@@ -22,7 +22,9 @@
 #include "absl/strings/str_cat.h"
 #include "tink/core/key_type_manager.h"
 #include "tink/deterministic_aead.h"
+#include "tink/subtle/aes_siv_aesni.h"
 #include "tink/subtle/aes_siv_boringssl.h"
+#include "tink/subtle/cpu_features.h"
 #include "tink/subtle/random.h"
 #include "tink/util/constants.h"
 #include "tink/util/errors.h"
@@ -45,6 +47,16 @@ class AesSivKeyManager
   class DeterministicAeadFactory : public PrimitiveFactory<DeterministicAead> {
     crypto::tink::util::StatusOr<std::unique_ptr<DeterministicAead>> Create(
         const google::crypto::tink::AesSivKey& key) const override {
+#if defined(__SSE4_1__) && defined(__AES__)
+      // Both implementations produce the same ciphertexts; the AESNI one
+      // pipelines the CMAC and CTR computations.
+      if (subtle::UseAesniImplementations()) {
+        subtle::RecordImplementation("AesSiv", "aesni");
+        return subtle::AesSivAesni::New(
+            util::SecretDataFromStringView(key.key_value()));
+      }
+#endif
+      subtle::RecordImplementation("AesSiv", "boringssl");
       return subtle::AesSivBoringSsl::New(
           util::SecretDataFromStringView(key.key_value()));
     }
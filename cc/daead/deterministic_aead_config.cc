@@ -20,7 +20,10 @@
 #include "tink/config/config_util.h"
 #include "tink/config/tink_fips.h"
 #include "tink/daead/aes_siv_key_manager.h"
+#include "tink/daead/deterministic_aes_gcm_siv_key_manager.h"
 #include "tink/daead/deterministic_aead_wrapper.h"
+#include "tink/daead/searchable_aes_siv_key_manager.h"
+#include "tink/daead/searchable_deterministic_aead_wrapper.h"
 #include "tink/registry.h"
 #include "tink/util/status.h"
 #include "proto/config.pb.h"
@@ -48,10 +51,19 @@ util::Status DeterministicAeadConfig::Register() {
   auto status = Registry::RegisterKeyTypeManager(
       absl::make_unique<AesSivKeyManager>(), true);
   if (!status.ok()) return status;
+  status = Registry::RegisterKeyTypeManager(
+      absl::make_unique<DeterministicAesGcmSivKeyManager>(), true);
+  if (!status.ok()) return status;
+  status = Registry::RegisterKeyTypeManager(
+      absl::make_unique<SearchableAesSivKeyManager>(), true);
+  if (!status.ok()) return status;
 
-  // Register primitive wrapper.
-  return Registry::RegisterPrimitiveWrapper(
+  // Register primitive wrappers.
+  status = Registry::RegisterPrimitiveWrapper(
       absl::make_unique<DeterministicAeadWrapper>());
+  if (!status.ok()) return status;
+  return Registry::RegisterPrimitiveWrapper(
+      absl::make_unique<SearchableDeterministicAeadWrapper>());
 }
 
 }  // namespace tink
@@ -24,9 +24,12 @@
 #include "tink/config/tink_fips.h"
 #include "tink/daead/aes_siv_key_manager.h"
 #include "tink/daead/deterministic_aead_key_templates.h"
+#include "tink/daead/deterministic_aes_gcm_siv_key_manager.h"
+#include "tink/daead/searchable_aes_siv_key_manager.h"
 #include "tink/deterministic_aead.h"
 #include "tink/keyset_handle.h"
 #include "tink/registry.h"
+#include "tink/searchable_deterministic_aead.h"
 #include "tink/util/status.h"
 #include "tink/util/test_matchers.h"
 #include "tink/util/test_util.h"
@@ -37,6 +40,7 @@ namespace {
 
 using ::crypto::tink::test::DummyDeterministicAead;
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
 using ::crypto::tink::test::StatusIs;
 using ::testing::Eq;
 
@@ -59,6 +63,14 @@ TEST_F(DeterministicAeadConfigTest, Basic) {
                   AesSivKeyManager().get_key_type())
                   .status(),
               IsOk());
+  EXPECT_THAT(Registry::get_key_manager<DeterministicAead>(
+                  DeterministicAesGcmSivKeyManager().get_key_type())
+                  .status(),
+              IsOk());
+  EXPECT_THAT(Registry::get_key_manager<SearchableDeterministicAead>(
+                  SearchableAesSivKeyManager().get_key_type())
+                  .status(),
+              IsOk());
 }
 
 // Tests that the DeterministicAeadWrapper has been properly registered and we
@@ -101,6 +113,39 @@ TEST_F(DeterministicAeadConfigTest, WrappersRegistered) {
   EXPECT_FALSE(decryption_result.status().ok());
 }
 
+// Tests that a searchable keyset gives both primitives, with the same
+// ciphertexts.
+TEST_F(DeterministicAeadConfigTest, SearchableKeyset) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  ASSERT_THAT(DeterministicAeadConfig::Register(), IsOk());
+  auto handle_result = KeysetHandle::GenerateNew(
+      DeterministicAeadKeyTemplates::SearchableAes256Siv());
+  ASSERT_THAT(handle_result.status(), IsOk());
+  auto searchable_result = handle_result.ValueOrDie()
+                               ->GetPrimitive<SearchableDeterministicAead>();
+  ASSERT_THAT(searchable_result.status(), IsOk());
+  auto daead_result =
+      handle_result.ValueOrDie()->GetPrimitive<DeterministicAead>();
+  ASSERT_THAT(daead_result.status(), IsOk());
+
+  const SearchableDeterministicAead& searchable =
+      *searchable_result.ValueOrDie();
+  const DeterministicAead& daead = *daead_result.ValueOrDie();
+
+  auto encrypt_result = searchable.EncryptWithSearchToken("value", "ad");
+  ASSERT_THAT(encrypt_result.status(), IsOk());
+  const SearchableCiphertext& result = encrypt_result.ValueOrDie();
+  EXPECT_THAT(daead.EncryptDeterministically("value", "ad"),
+              IsOkAndHolds(result.ciphertext));
+  EXPECT_THAT(daead.DecryptDeterministically(result.ciphertext, "ad"),
+              IsOkAndHolds("value"));
+  EXPECT_THAT(searchable.ComputeSearchToken("value", "ad"),
+              IsOkAndHolds(result.search_token));
+}
+
 TEST_F(DeterministicAeadConfigTest, RegisterFipsValidTemplates) {
   if (!kUseOnlyFips) {
     GTEST_SKIP() << "Only supported in FIPS-only mode";
@@ -111,6 +156,12 @@ TEST_F(DeterministicAeadConfigTest, RegisterFipsValidTemplates) {
   // Check that we can not retrieve non-FIPS key handle
   std::list<google::crypto::tink::KeyTemplate> non_fips_key_templates;
   non_fips_key_templates.push_back(DeterministicAeadKeyTemplates::Aes256Siv());
+  non_fips_key_templates.push_back(
+      DeterministicAeadKeyTemplates::Aes128GcmSiv());
+  non_fips_key_templates.push_back(
+      DeterministicAeadKeyTemplates::Aes256GcmSiv());
+  non_fips_key_templates.push_back(
+      DeterministicAeadKeyTemplates::SearchableAes256Siv());
 
   for (auto key_template : non_fips_key_templates) {
     auto new_keyset_handle_result = KeysetHandle::GenerateNew(key_template);
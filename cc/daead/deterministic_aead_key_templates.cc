@@ -18,11 +18,15 @@
 
 #include "proto/aes_siv.pb.h"
 #include "proto/common.pb.h"
+#include "proto/deterministic_aes_gcm_siv.pb.h"
+#include "proto/searchable_aes_siv.pb.h"
 #include "proto/tink.pb.h"
 
 using google::crypto::tink::AesSivKeyFormat;
+using google::crypto::tink::DeterministicAesGcmSivKeyFormat;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::OutputPrefixType;
+using google::crypto::tink::SearchableAesSivKeyFormat;
 
 namespace crypto {
 namespace tink {
@@ -40,6 +44,28 @@ KeyTemplate* NewAesSivKeyTemplate(int key_size_in_bytes) {
   return key_template;
 }
 
+KeyTemplate* NewDeterministicAesGcmSivKeyTemplate(int key_size_in_bytes) {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.DeterministicAesGcmSivKey");
+  key_template->set_output_prefix_type(OutputPrefixType::TINK);
+  DeterministicAesGcmSivKeyFormat key_format;
+  key_format.set_key_size(key_size_in_bytes);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
+KeyTemplate* NewSearchableAesSivKeyTemplate(int key_size_in_bytes) {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.SearchableAesSivKey");
+  key_template->set_output_prefix_type(OutputPrefixType::TINK);
+  SearchableAesSivKeyFormat key_format;
+  key_format.set_key_size(key_size_in_bytes);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
 }  // anonymous namespace
 
 // static
@@ -49,5 +75,26 @@ const KeyTemplate& DeterministicAeadKeyTemplates::Aes256Siv() {
   return *key_template;
 }
 
+// static
+const KeyTemplate& DeterministicAeadKeyTemplates::Aes128GcmSiv() {
+  static const KeyTemplate* key_template =
+      NewDeterministicAesGcmSivKeyTemplate(/* key_size_in_bytes= */ 16);
+  return *key_template;
+}
+
+// static
+const KeyTemplate& DeterministicAeadKeyTemplates::Aes256GcmSiv() {
+  static const KeyTemplate* key_template =
+      NewDeterministicAesGcmSivKeyTemplate(/* key_size_in_bytes= */ 32);
+  return *key_template;
+}
+
+// static
+const KeyTemplate& DeterministicAeadKeyTemplates::SearchableAes256Siv() {
+  static const KeyTemplate* key_template =
+      NewSearchableAesSivKeyTemplate(/* key_size_in_bytes= */ 96);
+  return *key_template;
+}
+
 }  // namespace tink
 }  // namespace crypto
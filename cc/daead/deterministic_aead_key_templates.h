@@ -40,6 +40,24 @@ class DeterministicAeadKeyTemplates {
   //   - key size: 64 bytes
   //   - OutputPrefixType: TINK
   static const google::crypto::tink::KeyTemplate& Aes256Siv();
+
+  // Returns a KeyTemplate that generates new instances of
+  // DeterministicAesGcmSivKey with the following parameters:
+  //   - key size: 16 bytes
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate& Aes128GcmSiv();
+
+  // Returns a KeyTemplate that generates new instances of
+  // DeterministicAesGcmSivKey with the following parameters:
+  //   - key size: 32 bytes
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate& Aes256GcmSiv();
+
+  // Returns a KeyTemplate that generates new instances of
+  // SearchableAesSivKey with the following parameters:
+  //   - key size: 96 bytes (64 bytes AES-SIV, 32 bytes token key)
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate& SearchableAes256Siv();
 };
 
 }  // namespace tink
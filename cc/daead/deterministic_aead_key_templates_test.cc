@@ -19,13 +19,19 @@
 #include "gtest/gtest.h"
 #include "tink/core/key_manager_impl.h"
 #include "tink/daead/aes_siv_key_manager.h"
+#include "tink/daead/deterministic_aes_gcm_siv_key_manager.h"
+#include "tink/daead/searchable_aes_siv_key_manager.h"
 #include "proto/aes_siv.pb.h"
 #include "proto/common.pb.h"
+#include "proto/deterministic_aes_gcm_siv.pb.h"
+#include "proto/searchable_aes_siv.pb.h"
 #include "proto/tink.pb.h"
 
 using google::crypto::tink::AesSivKeyFormat;
+using google::crypto::tink::DeterministicAesGcmSivKeyFormat;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::OutputPrefixType;
+using google::crypto::tink::SearchableAesSivKeyFormat;
 
 namespace crypto {
 namespace tink {
@@ -60,6 +66,64 @@ TEST(DeterministicAeadKeyTemplatesTest, testAesSivKeyTemplates) {
   }
 }
 
+TEST(DeterministicAeadKeyTemplatesTest,
+     testDeterministicAesGcmSivKeyTemplates) {
+  std::string type_url =
+      "type.googleapis.com/google.crypto.tink.DeterministicAesGcmSivKey";
+  DeterministicAesGcmSivKeyManager key_type_manager;
+  auto key_manager =
+      internal::MakeKeyManager<DeterministicAead>(&key_type_manager);
+
+  {  // Test Aes128GcmSiv().
+    const KeyTemplate& key_template =
+        DeterministicAeadKeyTemplates::Aes128GcmSiv();
+    EXPECT_EQ(type_url, key_template.type_url());
+    EXPECT_EQ(OutputPrefixType::TINK, key_template.output_prefix_type());
+    DeterministicAesGcmSivKeyFormat key_format;
+    EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+    EXPECT_EQ(16, key_format.key_size());
+    EXPECT_EQ(&key_template, &DeterministicAeadKeyTemplates::Aes128GcmSiv());
+    auto new_key_result =
+        key_manager->get_key_factory().NewKey(key_template.value());
+    EXPECT_TRUE(new_key_result.ok()) << new_key_result.status();
+  }
+
+  {  // Test Aes256GcmSiv().
+    const KeyTemplate& key_template =
+        DeterministicAeadKeyTemplates::Aes256GcmSiv();
+    EXPECT_EQ(type_url, key_template.type_url());
+    EXPECT_EQ(OutputPrefixType::TINK, key_template.output_prefix_type());
+    DeterministicAesGcmSivKeyFormat key_format;
+    EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+    EXPECT_EQ(32, key_format.key_size());
+    EXPECT_EQ(&key_template, &DeterministicAeadKeyTemplates::Aes256GcmSiv());
+    auto new_key_result =
+        key_manager->get_key_factory().NewKey(key_template.value());
+    EXPECT_TRUE(new_key_result.ok()) << new_key_result.status();
+  }
+}
+
+TEST(DeterministicAeadKeyTemplatesTest, testSearchableAesSivKeyTemplates) {
+  const KeyTemplate& key_template =
+      DeterministicAeadKeyTemplates::SearchableAes256Siv();
+  EXPECT_EQ("type.googleapis.com/google.crypto.tink.SearchableAesSivKey",
+            key_template.type_url());
+  EXPECT_EQ(OutputPrefixType::TINK, key_template.output_prefix_type());
+  SearchableAesSivKeyFormat key_format;
+  EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+  EXPECT_EQ(96, key_format.key_size());
+  EXPECT_EQ(&key_template,
+            &DeterministicAeadKeyTemplates::SearchableAes256Siv());
+
+  SearchableAesSivKeyManager key_type_manager;
+  auto key_manager = internal::MakeKeyManager<SearchableDeterministicAead>(
+      &key_type_manager);
+  EXPECT_EQ(key_manager->get_key_type(), key_template.type_url());
+  auto new_key_result =
+      key_manager->get_key_factory().NewKey(key_template.value());
+  EXPECT_TRUE(new_key_result.ok()) << new_key_result.status();
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
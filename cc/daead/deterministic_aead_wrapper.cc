@@ -16,8 +16,22 @@
 
 #include "tink/daead/deterministic_aead_wrapper.h"
 
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/strings/strip.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "tink/crypto_format.h"
 #include "tink/deterministic_aead.h"
+#include "tink/internal/monitored_operation.h"
 #include "tink/primitive_set.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/status.h"
@@ -53,12 +67,100 @@ class  DeterministicAeadSetWrapper : public DeterministicAead {
       absl::string_view ciphertext,
       absl::string_view associated_data) const override;
 
+  crypto::tink::util::StatusOr<std::string> DecryptDeterministicallyWithKeyId(
+      absl::string_view ciphertext, absl::string_view associated_data,
+      uint32_t key_id) const override;
+
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override;
+
+  crypto::tink::util::Status EncryptDeterministicallyBatchInto(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> ciphertext_buffers) const override;
+
+  // Binds the primitive of every key to 'associated_data', so that the
+  // returned object gets the speedup of the primitives which precompute
+  // work for fixed associated data.
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<DeterministicAeadWithAssociatedData>>
+  WithAssociatedData(absl::string_view associated_data) const override;
+
   ~DeterministicAeadSetWrapper() override {}
 
  private:
+  using Entry = PrimitiveSet<DeterministicAead>::Entry<DeterministicAead>;
+
+  class BoundAssociatedData;
+
+  // Decrypts 'ciphertext' with the keys which may have produced it, where
+  // 'decrypt(entry, raw_ciphertext)' decrypts with the key of 'entry'.
+  template <class DecryptFunction>
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext, const DecryptFunction& decrypt) const;
+
+ protected:
   std::unique_ptr<PrimitiveSet<DeterministicAead>> daead_set_;
 };
 
+// The wrapper of a set with a single key, the primary, as most keysets
+// are between key rotations.  Decryption goes straight to the primitive of
+// the key, which is kept at hand with its prefix, instead of looking up the
+// prefix of every ciphertext in the set.
+class SingleKeyDeterministicAeadWrapper : public DeterministicAeadSetWrapper {
+ public:
+  explicit SingleKeyDeterministicAeadWrapper(
+      std::unique_ptr<PrimitiveSet<DeterministicAead>> daead_set)
+      : DeterministicAeadSetWrapper(std::move(daead_set)),
+        daead_(daead_set_->get_primary()->get_primitive()),
+        prefix_(daead_set_->get_primary()->get_identifier()),
+        key_id_(daead_set_->get_primary()->get_key_id()) {}
+
+  crypto::tink::util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override;
+
+ private:
+  const DeterministicAead& daead_;
+  const std::string prefix_;
+  const uint32_t key_id_;
+};
+
+class DeterministicAeadSetWrapper::BoundAssociatedData
+    : public DeterministicAeadWithAssociatedData {
+ public:
+  BoundAssociatedData(
+      const DeterministicAeadSetWrapper& wrapper,
+      absl::string_view associated_data,
+      std::unique_ptr<DeterministicAeadWithAssociatedData> primary)
+      : wrapper_(wrapper),
+        associated_data_(associated_data),
+        primary_(std::move(primary)) {}
+
+  util::StatusOr<std::string> EncryptDeterministically(
+      absl::string_view plaintext) const override;
+
+  util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext) const override;
+
+ private:
+  // Returns the primitive of 'entry' bound to the associated data, binding
+  // it on first use.  'entry' must not be lazy or must be materialized.
+  util::StatusOr<const DeterministicAeadWithAssociatedData*> Bind(
+      const Entry& entry) const;
+
+  const DeterministicAeadSetWrapper& wrapper_;
+  const std::string associated_data_;
+  const std::unique_ptr<DeterministicAeadWithAssociatedData> primary_;
+  mutable absl::Mutex bound_mutex_;
+  // The primitives of the other keys of wrapper_ which were tried so far,
+  // bound to the associated data.  Binding them all up front would create
+  // the primitives of keys which the keyset may have left lazy.
+  mutable absl::flat_hash_map<
+      const Entry*, std::unique_ptr<DeterministicAeadWithAssociatedData>>
+      bound_ ABSL_GUARDED_BY(bound_mutex_);
+};
+
 util::StatusOr<std::string>
 DeterministicAeadSetWrapper::EncryptDeterministically(
     absl::string_view plaintext, absl::string_view associated_data) const {
@@ -67,12 +169,15 @@ DeterministicAeadSetWrapper::EncryptDeterministically(
   plaintext = subtle::SubtleUtilBoringSSL::EnsureNonNull(plaintext);
   associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
 
+  internal::MonitoredOperation operation("daead", "encrypt");
+  operation.KeyTried();
   auto encrypt_result =
       daead_set_->get_primary()->get_primitive().EncryptDeterministically(
           plaintext, associated_data);
   if (!encrypt_result.ok()) return encrypt_result.status();
-  const std::string& key_id = daead_set_->get_primary()->get_identifier();
-  return key_id + encrypt_result.ValueOrDie();
+  operation.Succeeded(daead_set_->get_primary()->get_key_id());
+  absl::string_view key_id = daead_set_->get_primary()->get_identifier();
+  return absl::StrCat(key_id, encrypt_result.ValueOrDie());
 }
 
 util::StatusOr<std::string>
@@ -81,7 +186,17 @@ DeterministicAeadSetWrapper::DecryptDeterministically(
   // BoringSSL expects a non-null pointer for plaintext and additional_data,
   // regardless of whether the size is 0.
   associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+  return Decrypt(ciphertext, [associated_data](const Entry& entry,
+                                               absl::string_view raw) {
+    return entry.get_primitive().DecryptDeterministically(raw,
+                                                          associated_data);
+  });
+}
 
+template <class DecryptFunction>
+util::StatusOr<std::string> DeterministicAeadSetWrapper::Decrypt(
+    absl::string_view ciphertext, const DecryptFunction& decrypt) const {
+  internal::MonitoredOperation operation("daead", "decrypt");
   if (ciphertext.length() > CryptoFormat::kNonRawPrefixSize) {
     absl::string_view key_id =
         ciphertext.substr(0, CryptoFormat::kNonRawPrefixSize);
@@ -89,11 +204,17 @@ DeterministicAeadSetWrapper::DecryptDeterministically(
     if (primitives_result.ok()) {
       absl::string_view raw_ciphertext =
           ciphertext.substr(CryptoFormat::kNonRawPrefixSize);
-      for (auto& daead_entry : *(primitives_result.ValueOrDie())) {
-        DeterministicAead& daead = daead_entry->get_primitive();
-        auto decrypt_result =
-            daead.DecryptDeterministically(raw_ciphertext, associated_data);
+      const PrimitiveSet<DeterministicAead>::Primitives& entries =
+          *primitives_result.ValueOrDie();
+      size_t first = daead_set_->preferred_index(key_id);
+      for (size_t i = 0; i < entries.size(); i++) {
+        auto& daead_entry =
+            entries[PrimitiveSet<DeterministicAead>::AdaptiveOrderIndex(first, i)];
+        operation.KeyTried();
+        auto decrypt_result = decrypt(*daead_entry, raw_ciphertext);
         if (decrypt_result.ok()) {
+          operation.Succeeded(daead_entry->get_key_id());
+          daead_set_->RecordSuccess(daead_entry.get());
           return std::move(decrypt_result.ValueOrDie());
         } else {
           // LOG that a matching key didn't decrypt the ciphertext.
@@ -105,11 +226,18 @@ DeterministicAeadSetWrapper::DecryptDeterministically(
   // No matching key succeeded with decryption, try all RAW keys.
   auto raw_primitives_result = daead_set_->get_raw_primitives();
   if (raw_primitives_result.ok()) {
-    for (auto& daead_entry : *(raw_primitives_result.ValueOrDie())) {
-      DeterministicAead& daead = daead_entry->get_primitive();
-      auto decrypt_result =
-          daead.DecryptDeterministically(ciphertext, associated_data);
+    operation.RawKeysTried();
+    const PrimitiveSet<DeterministicAead>::Primitives& entries =
+        *raw_primitives_result.ValueOrDie();
+    size_t first = daead_set_->preferred_index(CryptoFormat::kRawPrefix);
+    for (size_t i = 0; i < entries.size(); i++) {
+      auto& daead_entry =
+          entries[PrimitiveSet<DeterministicAead>::AdaptiveOrderIndex(first, i)];
+      operation.KeyTried();
+      auto decrypt_result = decrypt(*daead_entry, ciphertext);
       if (decrypt_result.ok()) {
+        operation.Succeeded(daead_entry->get_key_id());
+        daead_set_->RecordSuccess(daead_entry.get());
         return std::move(decrypt_result.ValueOrDie());
       }
     }
@@ -117,6 +245,166 @@ DeterministicAeadSetWrapper::DecryptDeterministically(
   return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
 }
 
+util::StatusOr<std::string>
+DeterministicAeadSetWrapper::DecryptDeterministicallyWithKeyId(
+    absl::string_view ciphertext, absl::string_view associated_data,
+    uint32_t key_id) const {
+  associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+
+  internal::MonitoredOperation operation("daead", "decrypt");
+  auto entry_result = daead_set_->get_primitive_by_key_id(key_id);
+  if (!entry_result.ok()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        absl::StrCat("No key with id ", key_id));
+  }
+  const Entry& entry = *entry_result.ValueOrDie();
+  if (absl::ConsumePrefix(&ciphertext, entry.get_identifier())) {
+    operation.KeyTried();
+    auto decrypt_result = entry.get_primitive().DecryptDeterministically(
+        ciphertext, associated_data);
+    if (decrypt_result.ok()) {
+      operation.Succeeded(key_id);
+      return decrypt_result;
+    }
+  }
+  return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
+}
+
+util::StatusOr<int64_t> DeterministicAeadSetWrapper::CiphertextSize(
+    int64_t plaintext_size) const {
+  auto size_result =
+      daead_set_->get_primary()->get_primitive().CiphertextSize(
+          plaintext_size);
+  if (!size_result.ok()) return size_result.status();
+  return daead_set_->get_primary()->get_identifier().size() +
+         size_result.ValueOrDie();
+}
+
+util::Status DeterministicAeadSetWrapper::EncryptDeterministicallyBatchInto(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> ciphertext_buffers) const {
+  absl::string_view key_id = daead_set_->get_primary()->get_identifier();
+  // Write the prefix of the primary key once per value, and hand the primary
+  // the rest of every buffer, so that it can encrypt the whole batch at once.
+  std::vector<absl::Span<char>> raw_buffers;
+  raw_buffers.reserve(ciphertext_buffers.size());
+  for (absl::Span<char> buffer : ciphertext_buffers) {
+    if (buffer.size() < key_id.size()) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Ciphertext buffer too small");
+    }
+    std::copy(key_id.begin(), key_id.end(), buffer.begin());
+    raw_buffers.push_back(buffer.subspan(key_id.size()));
+  }
+  std::vector<absl::string_view> non_null_plaintexts;
+  non_null_plaintexts.reserve(plaintexts.size());
+  for (absl::string_view plaintext : plaintexts) {
+    non_null_plaintexts.push_back(
+        subtle::SubtleUtilBoringSSL::EnsureNonNull(plaintext));
+  }
+  internal::MonitoredOperation operation("daead", "encrypt_batch");
+  operation.KeyTried();
+  util::Status status =
+      daead_set_->get_primary()
+          ->get_primitive()
+          .EncryptDeterministicallyBatchInto(
+              non_null_plaintexts,
+              subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data),
+              raw_buffers);
+  if (status.ok()) {
+    operation.Succeeded(daead_set_->get_primary()->get_key_id());
+  }
+  return status;
+}
+
+util::StatusOr<std::unique_ptr<DeterministicAeadWithAssociatedData>>
+DeterministicAeadSetWrapper::WithAssociatedData(
+    absl::string_view associated_data) const {
+  associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+  // Only the primary is bound here; the other keys are bound when
+  // decryption first gets to them.
+  auto primary_result =
+      daead_set_->get_primary()->get_primitive().WithAssociatedData(
+          associated_data);
+  if (!primary_result.ok()) return primary_result.status();
+  return {absl::make_unique<BoundAssociatedData>(
+      *this, associated_data, std::move(primary_result.ValueOrDie()))};
+}
+
+util::StatusOr<std::string>
+DeterministicAeadSetWrapper::BoundAssociatedData::EncryptDeterministically(
+    absl::string_view plaintext) const {
+  plaintext = subtle::SubtleUtilBoringSSL::EnsureNonNull(plaintext);
+  const Entry* primary = wrapper_.daead_set_->get_primary();
+  internal::MonitoredOperation operation("daead", "encrypt");
+  operation.KeyTried();
+  auto encrypt_result = primary_->EncryptDeterministically(plaintext);
+  if (!encrypt_result.ok()) return encrypt_result.status();
+  operation.Succeeded(primary->get_key_id());
+  return absl::StrCat(primary->get_identifier(), encrypt_result.ValueOrDie());
+}
+
+util::StatusOr<std::string>
+DeterministicAeadSetWrapper::BoundAssociatedData::DecryptDeterministically(
+    absl::string_view ciphertext) const {
+  return wrapper_.Decrypt(
+      ciphertext, [this](const Entry& entry, absl::string_view raw) {
+        auto bound_result = Bind(entry);
+        if (!bound_result.ok()) {
+          return util::StatusOr<std::string>(bound_result.status());
+        }
+        return bound_result.ValueOrDie()->DecryptDeterministically(raw);
+      });
+}
+
+util::StatusOr<const DeterministicAeadWithAssociatedData*>
+DeterministicAeadSetWrapper::BoundAssociatedData::Bind(
+    const Entry& entry) const {
+  if (&entry == wrapper_.daead_set_->get_primary()) return primary_.get();
+  {
+    absl::MutexLock lock(&bound_mutex_);
+    auto it = bound_.find(&entry);
+    if (it != bound_.end()) return it->second.get();
+  }
+  // Binding may precompute per-key state, so it is done without the lock;
+  // if two threads bind the same key, the first one to finish wins.
+  auto bound_result =
+      entry.get_primitive().WithAssociatedData(associated_data_);
+  if (!bound_result.ok()) return bound_result.status();
+  absl::MutexLock lock(&bound_mutex_);
+  auto it =
+      bound_.emplace(&entry, std::move(bound_result.ValueOrDie())).first;
+  return it->second.get();
+}
+
+util::StatusOr<std::string>
+SingleKeyDeterministicAeadWrapper::DecryptDeterministically(
+    absl::string_view ciphertext, absl::string_view associated_data) const {
+  associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+
+  internal::MonitoredOperation operation("daead", "decrypt");
+  bool matches = true;
+  if (prefix_.empty()) {
+    operation.RawKeysTried();
+  } else {
+    // As in DeterministicAeadSetWrapper, a prefix is only looked for in
+    // ciphertexts which are longer than it.
+    matches = ciphertext.length() > CryptoFormat::kNonRawPrefixSize &&
+              absl::ConsumePrefix(&ciphertext, prefix_);
+  }
+  if (matches) {
+    operation.KeyTried();
+    auto decrypt_result =
+        daead_.DecryptDeterministically(ciphertext, associated_data);
+    if (decrypt_result.ok()) {
+      operation.Succeeded(key_id_);
+      return decrypt_result;
+    }
+  }
+  return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
+}
+
 }  // anonymous namespace
 
 util::StatusOr<std::unique_ptr<DeterministicAead>>
@@ -124,8 +412,14 @@ DeterministicAeadWrapper::Wrap(
     std::unique_ptr<PrimitiveSet<DeterministicAead>> primitive_set) const {
   util::Status status = Validate(primitive_set.get());
   if (!status.ok()) return status;
-  std::unique_ptr<DeterministicAead> daead(
-      new DeterministicAeadSetWrapper(std::move(primitive_set)));
+  primitive_set->Freeze();
+  std::unique_ptr<DeterministicAead> daead;
+  if (primitive_set->get_all().size() == 1) {
+    daead.reset(
+        new SingleKeyDeterministicAeadWrapper(std::move(primitive_set)));
+  } else {
+    daead.reset(new DeterministicAeadSetWrapper(std::move(primitive_set)));
+  }
   return std::move(daead);
 }
 
@@ -16,8 +16,13 @@
 
 #include "tink/daead/deterministic_aead_wrapper.h"
 
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
 #include "tink/deterministic_aead.h"
 #include "tink/primitive_set.h"
 #include "tink/util/status.h"
@@ -26,9 +31,11 @@
 
 using ::crypto::tink::test::DummyDeterministicAead;
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
 using ::google::crypto::tink::KeysetInfo;
 using ::google::crypto::tink::KeyStatusType;
 using ::google::crypto::tink::OutputPrefixType;
+using ::testing::ElementsAre;
 
 namespace crypto {
 namespace tink {
@@ -134,6 +141,240 @@ TEST_F(DeterministicAeadSetWrapperTest, testBasic) {
   }
 }
 
+// A DummyDeterministicAead which can predict the size of its ciphertexts.
+class SizedDummyDeterministicAead : public DummyDeterministicAead {
+ public:
+  explicit SizedDummyDeterministicAead(absl::string_view daead_name)
+      : DummyDeterministicAead(daead_name), daead_name_(daead_name) {}
+
+  util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override {
+    return absl::StrCat(daead_name_.size(), ":2:", daead_name_, "ad").size() +
+           plaintext_size;
+  }
+
+ private:
+  std::string daead_name_;
+};
+
+TEST(DeterministicAeadSetWrapperBatchTest, EncryptBatch) {
+  KeysetInfo::KeyInfo key_info;
+  key_info.set_output_prefix_type(OutputPrefixType::TINK);
+  key_info.set_key_id(1234543);
+  key_info.set_status(KeyStatusType::ENABLED);
+
+  auto daead_set = absl::make_unique<PrimitiveSet<DeterministicAead>>();
+  auto entry_result = daead_set->AddPrimitive(
+      absl::make_unique<SizedDummyDeterministicAead>("daead0"), key_info);
+  ASSERT_THAT(entry_result.status(), IsOk());
+  ASSERT_THAT(daead_set->set_primary(entry_result.ValueOrDie()), IsOk());
+  std::string prefix(daead_set->get_primary()->get_identifier());
+
+  auto daead_result = DeterministicAeadWrapper().Wrap(std::move(daead_set));
+  ASSERT_THAT(daead_result.status(), IsOk());
+  std::unique_ptr<DeterministicAead> daead =
+      std::move(daead_result.ValueOrDie());
+
+  std::vector<int64_t> offsets = {0, 5, 5, 10};
+  std::string ciphertexts;
+  std::vector<int64_t> ciphertext_offsets;
+  ASSERT_THAT(daead->EncryptDeterministicallyBatch(
+                  offsets, "firstthird", "ad", &ciphertexts,
+                  &ciphertext_offsets),
+              IsOk());
+  std::string header = absl::StrCat(prefix, "6:2:daead0ad");
+  EXPECT_EQ(ciphertexts,
+            absl::StrCat(header, "first", header, header, "third"));
+  ASSERT_EQ(ciphertext_offsets.size(), offsets.size());
+
+  std::string plaintexts;
+  std::vector<int64_t> plaintext_offsets;
+  ASSERT_THAT(daead->DecryptDeterministicallyBatch(ciphertext_offsets,
+                                                   ciphertexts, "ad",
+                                                   &plaintexts,
+                                                   &plaintext_offsets),
+              IsOk());
+  EXPECT_EQ(plaintexts, "firstthird");
+  EXPECT_THAT(plaintext_offsets, ElementsAre(0, 5, 5, 10));
+}
+
+TEST_F(DeterministicAeadSetWrapperTest, WithAssociatedData) {
+  KeysetInfo::KeyInfo tink_key_info;
+  tink_key_info.set_output_prefix_type(OutputPrefixType::TINK);
+  tink_key_info.set_key_id(1234543);
+  tink_key_info.set_status(KeyStatusType::ENABLED);
+  KeysetInfo::KeyInfo raw_key_info;
+  raw_key_info.set_output_prefix_type(OutputPrefixType::RAW);
+  raw_key_info.set_key_id(726329);
+  raw_key_info.set_status(KeyStatusType::ENABLED);
+
+  auto daead_set = absl::make_unique<PrimitiveSet<DeterministicAead>>();
+  ASSERT_THAT(daead_set
+                  ->AddPrimitive(
+                      absl::make_unique<DummyDeterministicAead>("raw daead"),
+                      raw_key_info)
+                  .status(),
+              IsOk());
+  auto entry_result = daead_set->AddPrimitive(
+      absl::make_unique<DummyDeterministicAead>("daead0"), tink_key_info);
+  ASSERT_THAT(entry_result.status(), IsOk());
+  ASSERT_THAT(daead_set->set_primary(entry_result.ValueOrDie()), IsOk());
+  auto daead =
+      std::move(DeterministicAeadWrapper().Wrap(std::move(daead_set))
+                    .ValueOrDie());
+
+  auto bound_result = daead->WithAssociatedData("ad");
+  ASSERT_THAT(bound_result.status(), IsOk());
+  auto& bound = bound_result.ValueOrDie();
+  std::string ciphertext =
+      bound->EncryptDeterministically("plaintext").ValueOrDie();
+  EXPECT_EQ(ciphertext,
+            daead->EncryptDeterministically("plaintext", "ad").ValueOrDie());
+  EXPECT_EQ("plaintext",
+            bound->DecryptDeterministically(ciphertext).ValueOrDie());
+
+  // Ciphertexts of the RAW key are decrypted too.
+  std::string raw_ciphertext = DummyDeterministicAead("raw daead")
+                                   .EncryptDeterministically("plaintext", "ad")
+                                   .ValueOrDie();
+  EXPECT_EQ("plaintext",
+            bound->DecryptDeterministically(raw_ciphertext).ValueOrDie());
+
+  EXPECT_FALSE(bound
+                   ->DecryptDeterministically(
+                       daead->EncryptDeterministically("plaintext", "other ad")
+                           .ValueOrDie())
+                   .ok());
+}
+
+TEST_F(DeterministicAeadSetWrapperTest, WithAssociatedDataKeepsKeysLazy) {
+  KeysetInfo::KeyInfo tink_key_info;
+  tink_key_info.set_output_prefix_type(OutputPrefixType::TINK);
+  tink_key_info.set_key_id(1234543);
+  tink_key_info.set_status(KeyStatusType::ENABLED);
+  KeysetInfo::KeyInfo raw_key_info;
+  raw_key_info.set_output_prefix_type(OutputPrefixType::RAW);
+  raw_key_info.set_key_id(726329);
+  raw_key_info.set_status(KeyStatusType::ENABLED);
+
+  int factory_calls = 0;
+  auto daead_set = absl::make_unique<PrimitiveSet<DeterministicAead>>();
+  ASSERT_THAT(
+      daead_set
+          ->AddLazyPrimitive(
+              [&factory_calls]()
+                  -> util::StatusOr<std::unique_ptr<DeterministicAead>> {
+                factory_calls++;
+                return std::unique_ptr<DeterministicAead>(
+                    absl::make_unique<DummyDeterministicAead>("raw daead"));
+              },
+              raw_key_info)
+          .status(),
+      IsOk());
+  auto entry_result = daead_set->AddPrimitive(
+      absl::make_unique<DummyDeterministicAead>("daead0"), tink_key_info);
+  ASSERT_THAT(entry_result.status(), IsOk());
+  ASSERT_THAT(daead_set->set_primary(entry_result.ValueOrDie()), IsOk());
+  auto daead =
+      std::move(DeterministicAeadWrapper().Wrap(std::move(daead_set))
+                    .ValueOrDie());
+
+  auto bound_result = daead->WithAssociatedData("ad");
+  ASSERT_THAT(bound_result.status(), IsOk());
+  auto& bound = bound_result.ValueOrDie();
+  std::string ciphertext =
+      bound->EncryptDeterministically("plaintext").ValueOrDie();
+  EXPECT_EQ("plaintext",
+            bound->DecryptDeterministically(ciphertext).ValueOrDie());
+  EXPECT_EQ(0, factory_calls);
+
+  // The RAW key is created when decryption gets to it, and bound once.
+  std::string raw_ciphertext = DummyDeterministicAead("raw daead")
+                                   .EncryptDeterministically("plaintext", "ad")
+                                   .ValueOrDie();
+  for (int i = 0; i < 2; i++) {
+    EXPECT_EQ("plaintext",
+              bound->DecryptDeterministically(raw_ciphertext).ValueOrDie());
+  }
+  EXPECT_EQ(1, factory_calls);
+}
+
+TEST(DeterministicAeadSetWrapperSingleKeyTest, EncryptDecrypt) {
+  for (OutputPrefixType prefix_type :
+       {OutputPrefixType::TINK, OutputPrefixType::LEGACY,
+        OutputPrefixType::RAW}) {
+    SCOPED_TRACE(prefix_type);
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(prefix_type);
+    key_info.set_key_id(1234543);
+    key_info.set_status(KeyStatusType::ENABLED);
+    auto daead_set = absl::make_unique<PrimitiveSet<DeterministicAead>>();
+    auto entry_result = daead_set->AddPrimitive(
+        absl::make_unique<DummyDeterministicAead>("daead0"), key_info);
+    ASSERT_THAT(entry_result.status(), IsOk());
+    ASSERT_THAT(daead_set->set_primary(entry_result.ValueOrDie()), IsOk());
+    std::string prefix(daead_set->get_primary()->get_identifier());
+
+    auto daead_result = DeterministicAeadWrapper().Wrap(std::move(daead_set));
+    ASSERT_THAT(daead_result.status(), IsOk());
+    std::unique_ptr<DeterministicAead> daead =
+        std::move(daead_result.ValueOrDie());
+    auto encrypt_result = daead->EncryptDeterministically("plaintext", "aad");
+    ASSERT_THAT(encrypt_result.status(), IsOk());
+    std::string ciphertext = encrypt_result.ValueOrDie();
+
+    auto decrypt_result = daead->DecryptDeterministically(ciphertext, "aad");
+    ASSERT_THAT(decrypt_result.status(), IsOk());
+    EXPECT_EQ("plaintext", decrypt_result.ValueOrDie());
+    EXPECT_FALSE(
+        daead->DecryptDeterministically(ciphertext, "other aad").ok());
+    EXPECT_FALSE(daead->DecryptDeterministically(prefix, "aad").ok());
+    // A ciphertext of another key, with a different prefix.
+    std::string other_ciphertext = ciphertext;
+    other_ciphertext[prefix.empty() ? 0 : prefix.size() - 1] ^= 1;
+    EXPECT_FALSE(
+        daead->DecryptDeterministically(other_ciphertext, "aad").ok());
+  }
+}
+
+TEST(DeterministicAeadSetWrapperKeyIdTest, DecryptWithKeyId) {
+  auto daead_set = absl::make_unique<PrimitiveSet<DeterministicAead>>();
+  for (uint32_t key_id : {10, 11, 12}) {
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(key_id == 12 ? OutputPrefixType::TINK
+                                                 : OutputPrefixType::RAW);
+    key_info.set_key_id(key_id);
+    key_info.set_status(KeyStatusType::ENABLED);
+    auto entry_result =
+        daead_set->AddPrimitive(absl::make_unique<DummyDeterministicAead>(
+                                    absl::StrCat("daead", key_id)),
+                                key_info);
+    ASSERT_THAT(entry_result.status(), IsOk());
+    if (key_id == 11) {
+      ASSERT_THAT(daead_set->set_primary(entry_result.ValueOrDie()), IsOk());
+    }
+  }
+  auto daead_result = DeterministicAeadWrapper().Wrap(std::move(daead_set));
+  ASSERT_THAT(daead_result.status(), IsOk());
+  std::unique_ptr<DeterministicAead> daead =
+      std::move(daead_result.ValueOrDie());
+  std::string ciphertext =
+      daead->EncryptDeterministically("plaintext", "aad").ValueOrDie();
+
+  auto decrypt_result =
+      daead->DecryptDeterministicallyWithKeyId(ciphertext, "aad", 11);
+  ASSERT_THAT(decrypt_result.status(), IsOk());
+  EXPECT_EQ("plaintext", decrypt_result.ValueOrDie());
+  // Only the hinted key is tried, and a TINK key needs its prefix.
+  EXPECT_FALSE(
+      daead->DecryptDeterministicallyWithKeyId(ciphertext, "aad", 10).ok());
+  EXPECT_FALSE(
+      daead->DecryptDeterministicallyWithKeyId(ciphertext, "aad", 12).ok());
+  EXPECT_THAT(
+      daead->DecryptDeterministicallyWithKeyId(ciphertext, "aad", 13).status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
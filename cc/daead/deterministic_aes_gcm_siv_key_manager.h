@@ -0,0 +1,153 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef TINK_DAEAD_DETERMINISTIC_AES_GCM_SIV_KEY_MANAGER_H_
+#define TINK_DAEAD_DETERMINISTIC_AES_GCM_SIV_KEY_MANAGER_H_
+
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/core/key_type_manager.h"
+#include "tink/deterministic_aead.h"
+#include "tink/subtle/aes_gcm_siv_aesni.h"
+#include "tink/subtle/aes_gcm_siv_boringssl.h"
+#include "tink/subtle/cpu_features.h"
+#include "tink/subtle/random.h"
+#include "tink/util/constants.h"
+#include "tink/util/errors.h"
+#include "tink/util/input_stream_util.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/deterministic_aes_gcm_siv.pb.h"
+
+namespace crypto {
+namespace tink {
+
+class DeterministicAesGcmSivKeyManager
+    : public KeyTypeManager<
+          google::crypto::tink::DeterministicAesGcmSivKey,
+          google::crypto::tink::DeterministicAesGcmSivKeyFormat,
+          List<DeterministicAead>> {
+ public:
+  class DeterministicAeadFactory : public PrimitiveFactory<DeterministicAead> {
+    crypto::tink::util::StatusOr<std::unique_ptr<DeterministicAead>> Create(
+        const google::crypto::tink::DeterministicAesGcmSivKey& key)
+        const override {
+#if defined(__SSE4_1__) && defined(__AES__) && defined(__PCLMUL__)
+      // Both implementations produce the same ciphertexts; the AESNI one
+      // derives the message keys once, instead of for every message.
+      if (subtle::UseAesniImplementations() &&
+          subtle::GetCpuFeatures().pclmulqdq) {
+        subtle::RecordImplementation("DeterministicAesGcmSiv", "aesni");
+        return subtle::DeterministicAesGcmSivAesni::New(
+            util::SecretDataFromStringView(key.key_value()));
+      }
+#endif
+      subtle::RecordImplementation("DeterministicAesGcmSiv", "boringssl");
+      return subtle::DeterministicAesGcmSivBoringSsl::New(
+          util::SecretDataFromStringView(key.key_value()));
+    }
+  };
+
+  DeterministicAesGcmSivKeyManager()
+      : KeyTypeManager(absl::make_unique<DeterministicAeadFactory>()) {}
+
+  uint32_t get_version() const override { return 0; }
+
+  google::crypto::tink::KeyData::KeyMaterialType key_material_type()
+      const override {
+    return google::crypto::tink::KeyData::SYMMETRIC;
+  }
+
+  const std::string& get_key_type() const override { return key_type_; }
+
+  crypto::tink::util::Status ValidateKey(
+      const google::crypto::tink::DeterministicAesGcmSivKey& key)
+      const override {
+    crypto::tink::util::Status status =
+        ValidateVersion(key.version(), get_version());
+    if (!status.ok()) return status;
+    return ValidateKeySize(key.key_value().size());
+  }
+
+  crypto::tink::util::Status ValidateKeyFormat(
+      const google::crypto::tink::DeterministicAesGcmSivKeyFormat& key_format)
+      const override {
+    return ValidateKeySize(key_format.key_size());
+  }
+
+  crypto::tink::util::StatusOr<google::crypto::tink::DeterministicAesGcmSivKey>
+  CreateKey(
+      const google::crypto::tink::DeterministicAesGcmSivKeyFormat& key_format)
+      const override {
+    google::crypto::tink::DeterministicAesGcmSivKey key;
+    key.set_version(get_version());
+    key.set_key_value(subtle::Random::GetRandomBytes(key_format.key_size()));
+    return key;
+  }
+
+  crypto::tink::util::StatusOr<google::crypto::tink::DeterministicAesGcmSivKey>
+  DeriveKey(
+      const google::crypto::tink::DeterministicAesGcmSivKeyFormat& key_format,
+      InputStream* input_stream) const override {
+    crypto::tink::util::Status status =
+        ValidateVersion(key_format.version(), get_version());
+    if (!status.ok()) return status;
+
+    crypto::tink::util::StatusOr<std::string> randomness =
+        ReadBytesFromStream(key_format.key_size(), input_stream);
+
+    if (!randomness.ok()) {
+      if (randomness.status().error_code() == util::error::OUT_OF_RANGE) {
+        return crypto::tink::util::Status(
+            crypto::tink::util::error::INVALID_ARGUMENT,
+            "Could not get enough pseudorandomness from input stream");
+      }
+      return randomness.status();
+    }
+    google::crypto::tink::DeterministicAesGcmSivKey key;
+    key.set_version(get_version());
+    key.set_key_value(randomness.ValueOrDie());
+    return key;
+  }
+
+  FipsCompatibility FipsStatus() const override {
+    return FipsCompatibility::kNotFips;
+  }
+
+ private:
+  crypto::tink::util::Status ValidateKeySize(uint32_t key_size) const {
+    if (key_size != 16 && key_size != 32) {
+      return crypto::tink::util::Status(
+          crypto::tink::util::error::INVALID_ARGUMENT,
+          absl::StrCat("Invalid key size: key size is ", key_size,
+                       " bytes; supported sizes: 16 or 32 bytes."));
+    }
+    return crypto::tink::util::OkStatus();
+  }
+
+  const std::string key_type_ = absl::StrCat(
+      kTypeGoogleapisCom,
+      google::crypto::tink::DeterministicAesGcmSivKey().GetTypeName());
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_DAEAD_DETERMINISTIC_AES_GCM_SIV_KEY_MANAGER_H_
@@ -0,0 +1,165 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/daead/deterministic_aes_gcm_siv_key_manager.h"
+
+#include <sstream>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "tink/deterministic_aead.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/deterministic_aes_gcm_siv.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::DeterministicAesGcmSivKey;
+using ::google::crypto::tink::DeterministicAesGcmSivKeyFormat;
+using ::testing::Eq;
+using ::testing::HasSubstr;
+using ::testing::Ne;
+using ::testing::Not;
+using ::testing::SizeIs;
+
+namespace {
+
+TEST(DeterministicAesGcmSivKeyManagerTest, Basics) {
+  EXPECT_THAT(DeterministicAesGcmSivKeyManager().get_version(), Eq(0));
+  EXPECT_THAT(
+      DeterministicAesGcmSivKeyManager().get_key_type(),
+      Eq("type.googleapis.com/google.crypto.tink.DeterministicAesGcmSivKey"));
+  EXPECT_THAT(DeterministicAesGcmSivKeyManager().key_material_type(),
+              Eq(google::crypto::tink::KeyData::SYMMETRIC));
+}
+
+TEST(DeterministicAesGcmSivKeyManagerTest, ValidateKeyFormat) {
+  DeterministicAesGcmSivKeyFormat format;
+  for (int i = 0; i <= 64; ++i) {
+    format.set_key_size(i);
+    if (i == 16 || i == 32) {
+      EXPECT_THAT(
+          DeterministicAesGcmSivKeyManager().ValidateKeyFormat(format),
+          IsOk());
+    } else {
+      EXPECT_THAT(
+          DeterministicAesGcmSivKeyManager().ValidateKeyFormat(format),
+          Not(IsOk()))
+          << " for length " << i;
+    }
+  }
+}
+
+TEST(DeterministicAesGcmSivKeyManagerTest, CreateKey) {
+  DeterministicAesGcmSivKeyManager manager;
+  for (int key_size : {16, 32}) {
+    DeterministicAesGcmSivKeyFormat format;
+    format.set_key_size(key_size);
+    auto key1_or = manager.CreateKey(format);
+    ASSERT_THAT(key1_or.status(), IsOk());
+    EXPECT_THAT(key1_or.ValueOrDie().key_value(), SizeIs(key_size));
+    EXPECT_THAT(key1_or.ValueOrDie().version(), Eq(0));
+    EXPECT_THAT(manager.ValidateKey(key1_or.ValueOrDie()), IsOk());
+    auto key2_or = manager.CreateKey(format);
+    ASSERT_THAT(key2_or.status(), IsOk());
+    EXPECT_THAT(key1_or.ValueOrDie().key_value(),
+                Ne(key2_or.ValueOrDie().key_value()));
+  }
+}
+
+TEST(DeterministicAesGcmSivKeyManagerTest, DeriveKey) {
+  util::IstreamInputStream input_stream{absl::make_unique<std::stringstream>(
+      "0123456789abcdefXXXXX")};
+  DeterministicAesGcmSivKeyFormat format;
+  format.set_key_size(16);
+  format.set_version(0);
+  auto key_or =
+      DeterministicAesGcmSivKeyManager().DeriveKey(format, &input_stream);
+  ASSERT_THAT(key_or.status(), IsOk());
+  EXPECT_THAT(key_or.ValueOrDie().key_value(), Eq("0123456789abcdef"));
+  EXPECT_THAT(key_or.ValueOrDie().version(), Eq(0));
+}
+
+TEST(DeterministicAesGcmSivKeyManagerTest, DeriveKeyWithoutEnoughEntropy) {
+  util::IstreamInputStream input_stream{
+      absl::make_unique<std::stringstream>("0123456789abcdef")};
+  DeterministicAesGcmSivKeyFormat format;
+  format.set_key_size(32);
+  format.set_version(0);
+  auto key_or =
+      DeterministicAesGcmSivKeyManager().DeriveKey(format, &input_stream);
+  EXPECT_THAT(key_or.status(), StatusIs(util::error::INVALID_ARGUMENT,
+                                        HasSubstr("pseudorandomness")));
+}
+
+TEST(DeterministicAesGcmSivKeyManagerTest, ValidateKey) {
+  DeterministicAesGcmSivKey key;
+  key.set_version(0);
+  for (int i = 0; i <= 64; ++i) {
+    key.set_key_value(std::string(i, 'a'));
+    if (i == 16 || i == 32) {
+      EXPECT_THAT(DeterministicAesGcmSivKeyManager().ValidateKey(key), IsOk());
+    } else {
+      EXPECT_THAT(DeterministicAesGcmSivKeyManager().ValidateKey(key),
+                  Not(IsOk()))
+          << " for length " << i;
+    }
+  }
+  key.set_key_value(std::string(16, 'a'));
+  key.set_version(1);
+  EXPECT_THAT(DeterministicAesGcmSivKeyManager().ValidateKey(key),
+              Not(IsOk()));
+}
+
+TEST(DeterministicAesGcmSivKeyManagerTest, GetPrimitive) {
+  for (int key_size : {16, 32}) {
+    DeterministicAesGcmSivKeyFormat format;
+    format.set_key_size(key_size);
+    auto key_or = DeterministicAesGcmSivKeyManager().CreateKey(format);
+    ASSERT_THAT(key_or.status(), IsOk());
+    auto daead_or =
+        DeterministicAesGcmSivKeyManager().GetPrimitive<DeterministicAead>(
+            key_or.ValueOrDie());
+    ASSERT_THAT(daead_or.status(), IsOk());
+    auto& daead = daead_or.ValueOrDie();
+
+    auto ciphertext_or = daead->EncryptDeterministically("123", "abcd");
+    ASSERT_THAT(ciphertext_or.status(), IsOk());
+    EXPECT_THAT(ciphertext_or.ValueOrDie(), SizeIs(3 + 16));
+    EXPECT_THAT(daead->EncryptDeterministically("123", "abcd").ValueOrDie(),
+                Eq(ciphertext_or.ValueOrDie()));
+    auto plaintext_or =
+        daead->DecryptDeterministically(ciphertext_or.ValueOrDie(), "abcd");
+    ASSERT_THAT(plaintext_or.status(), IsOk());
+    EXPECT_THAT(plaintext_or.ValueOrDie(), Eq("123"));
+    EXPECT_THAT(
+        daead->DecryptDeterministically(ciphertext_or.ValueOrDie(), "abce")
+            .status(),
+        Not(IsOk()));
+  }
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
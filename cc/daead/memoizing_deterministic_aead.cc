@@ -0,0 +1,139 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/daead/memoizing_deterministic_aead.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/base/internal/endian.h"
+#include "absl/hash/hash.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/mem.h"
+#include "tink/deterministic_aead.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+// Returns the size of 'associated_data' (4 bytes, big-endian), followed by
+// 'associated_data' and 'plaintext', so that different pairs have
+// different inputs.
+util::SecretData EncodeInput(absl::string_view plaintext,
+                             absl::string_view associated_data) {
+  util::SecretData input(4 + associated_data.size() + plaintext.size());
+  absl::big_endian::Store32(input.data(), associated_data.size());
+  if (!associated_data.empty()) {
+    std::memcpy(input.data() + 4, associated_data.data(),
+                associated_data.size());
+  }
+  if (!plaintext.empty()) {
+    std::memcpy(input.data() + 4 + associated_data.size(), plaintext.data(),
+                plaintext.size());
+  }
+  return input;
+}
+
+}  // namespace
+
+constexpr int MemoizingDeterministicAead::kNumShards;
+
+// static
+util::StatusOr<std::unique_ptr<MemoizingDeterministicAead>>
+MemoizingDeterministicAead::New(std::unique_ptr<DeterministicAead> daead,
+                                const Options& options) {
+  if (daead == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "daead must be non-null");
+  }
+  if (options.max_entries < 1) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "max_entries must be positive");
+  }
+  if (options.max_input_size < 1) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "max_input_size must be positive");
+  }
+  return {absl::WrapUnique(
+      new MemoizingDeterministicAead(std::move(daead), options))};
+}
+
+util::StatusOr<std::string>
+MemoizingDeterministicAead::EncryptDeterministically(
+    absl::string_view plaintext, absl::string_view associated_data) const {
+  if (plaintext.size() + associated_data.size() >
+      static_cast<size_t>(options_.max_input_size)) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return daead_->EncryptDeterministically(plaintext, associated_data);
+  }
+  util::SecretData input = EncodeInput(plaintext, associated_data);
+  uint64_t hash =
+      absl::Hash<absl::string_view>()(util::SecretDataAsStringView(input));
+  Shard& shard = shards_[hash % kNumShards];
+  {
+    absl::MutexLock lock(&shard.mutex);
+    auto it = shard.entries.find(hash);
+    if (it != shard.entries.end() &&
+        it->second.input.size() == input.size() &&
+        CRYPTO_memcmp(it->second.input.data(), input.data(), input.size()) ==
+            0) {
+      shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_position);
+      hits_.fetch_add(1, std::memory_order_relaxed);
+      return it->second.ciphertext;
+    }
+  }
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  util::StatusOr<std::string> ciphertext_or =
+      daead_->EncryptDeterministically(plaintext, associated_data);
+  if (!ciphertext_or.ok()) return ciphertext_or;
+
+  absl::MutexLock lock(&shard.mutex);
+  auto it = shard.entries.find(hash);
+  if (it != shard.entries.end()) {
+    shard.lru.erase(it->second.lru_position);
+    shard.entries.erase(it);
+  }
+  shard.lru.push_front(hash);
+  shard.entries.emplace(hash, Entry{std::move(input),
+                                    ciphertext_or.ValueOrDie(),
+                                    shard.lru.begin()});
+  if (shard.lru.size() > static_cast<size_t>(max_entries_per_shard_)) {
+    shard.entries.erase(shard.lru.back());
+    shard.lru.pop_back();
+    evictions_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return ciphertext_or;
+}
+
+MemoizingDeterministicAead::Stats MemoizingDeterministicAead::GetStats()
+    const {
+  Stats stats;
+  stats.hits = hits_.load(std::memory_order_relaxed);
+  stats.misses = misses_.load(std::memory_order_relaxed);
+  stats.evictions = evictions_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}  // namespace tink
+}  // namespace crypto
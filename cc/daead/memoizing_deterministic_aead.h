@@ -0,0 +1,148 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_DAEAD_MEMOIZING_DETERMINISTIC_AEAD_H_
+#define TINK_DAEAD_MEMOIZING_DETERMINISTIC_AEAD_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/deterministic_aead.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+// A DeterministicAead which remembers the ciphertexts of the (plaintext,
+// associated data) pairs it encrypted recently, and returns them again
+// instead of encrypting the same pair again.  As the encryption is
+// deterministic, the ciphertexts are the same as those of the wrapped
+// primitive.
+//
+// This is worthwhile for columns with few distinct values, such as status
+// or country codes, which are encrypted over and over: their encryption
+// then costs a hash table lookup.  It is opt-in, since the cache keeps
+// plaintexts in memory for longer.  Plaintexts and associated data are
+// kept in SecretData, which is wiped when an entry is evicted, and only
+// pairs of at most Options::max_input_size bytes are cached.  Decryption
+// is not cached.
+//
+// The cache is sharded by the hash of the pair, each shard with its own
+// lock and least recently used list, so that threads rarely contend.
+//
+// This class is thread-safe.
+class MemoizingDeterministicAead : public DeterministicAead {
+ public:
+  struct Options {
+    // The maximal number of cached ciphertexts; must be positive.  The least
+    // recently used entry of a shard is dropped when a new one is added to a
+    // full shard.
+    int max_entries = 4096;
+    // The maximal size of the plaintext and associated data of a cached
+    // ciphertext, together; must be positive.  Larger inputs are passed
+    // through.
+    int max_input_size = 256;
+  };
+
+  struct Stats {
+    int64_t hits = 0;
+    int64_t misses = 0;
+    int64_t evictions = 0;
+  };
+
+  static constexpr int kNumShards = 16;
+
+  // Returns a primitive which caches the ciphertexts of 'daead'.
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<MemoizingDeterministicAead>>
+  New(std::unique_ptr<DeterministicAead> daead, const Options& options);
+
+  crypto::tink::util::StatusOr<std::string> EncryptDeterministically(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override {
+    return daead_->DecryptDeterministically(ciphertext, associated_data);
+  }
+
+  crypto::tink::util::StatusOr<std::string> DecryptDeterministicallyWithKeyId(
+      absl::string_view ciphertext, absl::string_view associated_data,
+      uint32_t key_id) const override {
+    return daead_->DecryptDeterministicallyWithKeyId(ciphertext,
+                                                     associated_data, key_id);
+  }
+
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override {
+    return daead_->CiphertextSize(plaintext_size);
+  }
+
+  // Returns the number of lookups which found a cached ciphertext, of
+  // those which did not (including inputs which are too large), and of
+  // evicted entries, so far.
+  Stats GetStats() const;
+
+ private:
+  struct Entry {
+    // The size of the associated data, the associated data and the
+    // plaintext of the ciphertext.
+    util::SecretData input;
+    std::string ciphertext;
+    std::list<uint64_t>::iterator lru_position;
+  };
+
+  struct Shard {
+    absl::Mutex mutex;
+    // Entries indexed by the hash of their input, with the least recently
+    // used one at the back of 'lru'.  Of inputs with the same hash, only
+    // the last one is kept.
+    absl::flat_hash_map<uint64_t, Entry> entries ABSL_GUARDED_BY(mutex);
+    std::list<uint64_t> lru ABSL_GUARDED_BY(mutex);
+  };
+
+  MemoizingDeterministicAead(std::unique_ptr<DeterministicAead> daead,
+                             const Options& options)
+      : daead_(std::move(daead)),
+        options_(options),
+        max_entries_per_shard_(
+            std::max(1, (options.max_entries + kNumShards - 1) / kNumShards)) {}
+
+  const std::unique_ptr<DeterministicAead> daead_;
+  const Options options_;
+  const int max_entries_per_shard_;
+  mutable std::array<Shard, kNumShards> shards_;
+  mutable std::atomic<int64_t> hits_{0};
+  mutable std::atomic<int64_t> misses_{0};
+  mutable std::atomic<int64_t> evictions_{0};
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_DAEAD_MEMOIZING_DETERMINISTIC_AEAD_H_
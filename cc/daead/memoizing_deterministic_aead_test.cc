@@ -0,0 +1,200 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/daead/memoizing_deterministic_aead.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/deterministic_aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::DummyDeterministicAead;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+using ::testing::Gt;
+
+// Counts the encryptions of a DummyDeterministicAead.
+class CountingDeterministicAead : public DeterministicAead {
+ public:
+  explicit CountingDeterministicAead(std::atomic<int>* encryptions)
+      : daead_("counting"), encryptions_(encryptions) {}
+
+  util::StatusOr<std::string> EncryptDeterministically(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override {
+    encryptions_->fetch_add(1);
+    return daead_.EncryptDeterministically(plaintext, associated_data);
+  }
+
+  util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override {
+    return daead_.DecryptDeterministically(ciphertext, associated_data);
+  }
+
+ private:
+  DummyDeterministicAead daead_;
+  std::atomic<int>* encryptions_;
+};
+
+std::unique_ptr<MemoizingDeterministicAead> NewMemoizing(
+    std::atomic<int>* encryptions,
+    const MemoizingDeterministicAead::Options& options) {
+  auto daead_or = MemoizingDeterministicAead::New(
+      absl::make_unique<CountingDeterministicAead>(encryptions), options);
+  EXPECT_THAT(daead_or.status(), IsOk());
+  return std::move(daead_or.ValueOrDie());
+}
+
+TEST(MemoizingDeterministicAeadTest, CachesCiphertexts) {
+  std::atomic<int> encryptions(0);
+  auto daead = NewMemoizing(&encryptions, {});
+  DummyDeterministicAead reference("counting");
+  for (int round = 0; round < 3; round++) {
+    for (absl::string_view plaintext : {"", "US", "DE", "FR"}) {
+      for (absl::string_view associated_data : {"", "country"}) {
+        auto ciphertext_or =
+            daead->EncryptDeterministically(plaintext, associated_data);
+        ASSERT_THAT(ciphertext_or.status(), IsOk());
+        EXPECT_THAT(ciphertext_or.ValueOrDie(),
+                    Eq(reference
+                           .EncryptDeterministically(plaintext,
+                                                     associated_data)
+                           .ValueOrDie()));
+        auto decrypted_or = daead->DecryptDeterministically(
+            ciphertext_or.ValueOrDie(), associated_data);
+        ASSERT_THAT(decrypted_or.status(), IsOk());
+        EXPECT_THAT(decrypted_or.ValueOrDie(), Eq(plaintext));
+      }
+    }
+  }
+  EXPECT_THAT(encryptions.load(), Eq(8));
+  MemoizingDeterministicAead::Stats stats = daead->GetStats();
+  EXPECT_THAT(stats.hits, Eq(16));
+  EXPECT_THAT(stats.misses, Eq(8));
+  EXPECT_THAT(stats.evictions, Eq(0));
+}
+
+TEST(MemoizingDeterministicAeadTest, DistinguishesPairs) {
+  std::atomic<int> encryptions(0);
+  auto daead = NewMemoizing(&encryptions, {});
+  // The same concatenation of associated data and plaintext.
+  auto ciphertext1_or = daead->EncryptDeterministically("bc", "a");
+  ASSERT_THAT(ciphertext1_or.status(), IsOk());
+  auto ciphertext2_or = daead->EncryptDeterministically("c", "ab");
+  ASSERT_THAT(ciphertext2_or.status(), IsOk());
+  EXPECT_THAT(encryptions.load(), Eq(2));
+  EXPECT_THAT(
+      daead->DecryptDeterministically(ciphertext2_or.ValueOrDie(), "ab")
+          .ValueOrDie(),
+      Eq("c"));
+}
+
+TEST(MemoizingDeterministicAeadTest, LargeInputsAreNotCached) {
+  std::atomic<int> encryptions(0);
+  MemoizingDeterministicAead::Options options;
+  options.max_input_size = 10;
+  auto daead = NewMemoizing(&encryptions, options);
+  for (int i = 0; i < 2; i++) {
+    EXPECT_THAT(daead->EncryptDeterministically("0123456", "789").status(),
+                IsOk());
+    EXPECT_THAT(daead->EncryptDeterministically("0123456", "789a").status(),
+                IsOk());
+  }
+  EXPECT_THAT(encryptions.load(), Eq(3));
+}
+
+TEST(MemoizingDeterministicAeadTest, EvictsLeastRecentlyUsed) {
+  std::atomic<int> encryptions(0);
+  MemoizingDeterministicAead::Options options;
+  options.max_entries = MemoizingDeterministicAead::kNumShards;
+  auto daead = NewMemoizing(&encryptions, options);
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_THAT(daead->EncryptDeterministically(absl::StrCat(i), "").status(),
+                IsOk());
+  }
+  EXPECT_THAT(daead->GetStats().evictions, Gt(0));
+  // The last value is still cached.
+  int before = encryptions.load();
+  EXPECT_THAT(daead->EncryptDeterministically("999", "").status(), IsOk());
+  EXPECT_THAT(encryptions.load(), Eq(before));
+}
+
+TEST(MemoizingDeterministicAeadTest, ConcurrentUse) {
+  std::atomic<int> encryptions(0);
+  auto daead = NewMemoizing(&encryptions, {});
+  DummyDeterministicAead reference("counting");
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&daead, &reference]() {
+      for (int i = 0; i < 1000; i++) {
+        std::string plaintext = absl::StrCat(i % 50);
+        auto ciphertext_or = daead->EncryptDeterministically(plaintext, "ad");
+        ASSERT_THAT(ciphertext_or.status(), IsOk());
+        EXPECT_THAT(
+            ciphertext_or.ValueOrDie(),
+            Eq(reference.EncryptDeterministically(plaintext, "ad")
+                   .ValueOrDie()));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  MemoizingDeterministicAead::Stats stats = daead->GetStats();
+  EXPECT_THAT(stats.hits + stats.misses, Eq(4000));
+  EXPECT_THAT(encryptions.load(), Eq(stats.misses));
+}
+
+TEST(MemoizingDeterministicAeadTest, InvalidArguments) {
+  EXPECT_THAT(MemoizingDeterministicAead::New(nullptr, {}).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  MemoizingDeterministicAead::Options options;
+  options.max_entries = 0;
+  EXPECT_THAT(MemoizingDeterministicAead::New(
+                  absl::make_unique<DummyDeterministicAead>("dummy"), options)
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  for (int max_input_size : {0, -1}) {
+    options = MemoizingDeterministicAead::Options();
+    options.max_input_size = max_input_size;
+    EXPECT_THAT(
+        MemoizingDeterministicAead::New(
+            absl::make_unique<DummyDeterministicAead>("dummy"), options)
+            .status(),
+        StatusIs(util::error::INVALID_ARGUMENT));
+  }
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,188 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef TINK_DAEAD_SEARCHABLE_AES_SIV_KEY_MANAGER_H_
+#define TINK_DAEAD_SEARCHABLE_AES_SIV_KEY_MANAGER_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/core/key_type_manager.h"
+#include "tink/deterministic_aead.h"
+#include "tink/searchable_deterministic_aead.h"
+#include "tink/subtle/aes_siv_aesni.h"
+#include "tink/subtle/aes_siv_boringssl.h"
+#include "tink/subtle/cpu_features.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/searchable_aes_siv.h"
+#include "tink/util/constants.h"
+#include "tink/util/errors.h"
+#include "tink/util/input_stream_util.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/searchable_aes_siv.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// Key manager for SearchableAesSivKey, which provides both a
+// DeterministicAead and a SearchableDeterministicAead: the ciphertexts of
+// both are the same, so a keyset can be ingested with search tokens and read
+// back as an ordinary deterministic AEAD.
+class SearchableAesSivKeyManager
+    : public KeyTypeManager<google::crypto::tink::SearchableAesSivKey,
+                            google::crypto::tink::SearchableAesSivKeyFormat,
+                            List<DeterministicAead,
+                                 SearchableDeterministicAead>> {
+ public:
+  class DeterministicAeadFactory : public PrimitiveFactory<DeterministicAead> {
+    crypto::tink::util::StatusOr<std::unique_ptr<DeterministicAead>> Create(
+        const google::crypto::tink::SearchableAesSivKey& key) const override {
+      auto searchable_result = NewSearchableAesSiv(key);
+      if (!searchable_result.ok()) return searchable_result.status();
+      return {std::move(searchable_result.ValueOrDie())};
+    }
+  };
+  class SearchableDeterministicAeadFactory
+      : public PrimitiveFactory<SearchableDeterministicAead> {
+    crypto::tink::util::StatusOr<std::unique_ptr<SearchableDeterministicAead>>
+    Create(const google::crypto::tink::SearchableAesSivKey& key)
+        const override {
+      auto searchable_result = NewSearchableAesSiv(key);
+      if (!searchable_result.ok()) return searchable_result.status();
+      return {std::move(searchable_result.ValueOrDie())};
+    }
+  };
+
+  SearchableAesSivKeyManager()
+      : KeyTypeManager(
+            absl::make_unique<DeterministicAeadFactory>(),
+            absl::make_unique<SearchableDeterministicAeadFactory>()) {}
+
+  uint32_t get_version() const override { return 0; }
+
+  google::crypto::tink::KeyData::KeyMaterialType key_material_type()
+      const override {
+    return google::crypto::tink::KeyData::SYMMETRIC;
+  }
+
+  const std::string& get_key_type() const override { return key_type_; }
+
+  crypto::tink::util::Status ValidateKey(
+      const google::crypto::tink::SearchableAesSivKey& key) const override {
+    crypto::tink::util::Status status =
+        ValidateVersion(key.version(), get_version());
+    if (!status.ok()) return status;
+    return ValidateKeySize(key.key_value().size());
+  }
+
+  crypto::tink::util::Status ValidateKeyFormat(
+      const google::crypto::tink::SearchableAesSivKeyFormat& key_format)
+      const override {
+    return ValidateKeySize(key_format.key_size());
+  }
+
+  crypto::tink::util::StatusOr<google::crypto::tink::SearchableAesSivKey>
+  CreateKey(const google::crypto::tink::SearchableAesSivKeyFormat& key_format)
+      const override {
+    google::crypto::tink::SearchableAesSivKey key;
+    key.set_version(get_version());
+    key.set_key_value(subtle::Random::GetRandomBytes(key_format.key_size()));
+    return key;
+  }
+
+  crypto::tink::util::StatusOr<google::crypto::tink::SearchableAesSivKey>
+  DeriveKey(const google::crypto::tink::SearchableAesSivKeyFormat& key_format,
+            InputStream* input_stream) const override {
+    crypto::tink::util::Status status =
+        ValidateVersion(key_format.version(), get_version());
+    if (!status.ok()) return status;
+
+    crypto::tink::util::StatusOr<std::string> randomness =
+        ReadBytesFromStream(key_format.key_size(), input_stream);
+
+    if (!randomness.ok()) {
+      if (randomness.status().error_code() == util::error::OUT_OF_RANGE) {
+        return crypto::tink::util::Status(
+            crypto::tink::util::error::INVALID_ARGUMENT,
+            "Could not get enough pseudorandomness from input stream");
+      }
+      return randomness.status();
+    }
+    google::crypto::tink::SearchableAesSivKey key;
+    key.set_version(get_version());
+    key.set_key_value(randomness.ValueOrDie());
+    return key;
+  }
+
+  FipsCompatibility FipsStatus() const override {
+    return FipsCompatibility::kNotFips;
+  }
+
+ private:
+  static constexpr size_t kAesSivKeySizeInBytes = 64;
+  static constexpr size_t kKeySizeInBytes =
+      kAesSivKeySizeInBytes + subtle::SearchableAesSiv::kTokenKeySize;
+
+  static crypto::tink::util::Status ValidateKeySize(uint32_t key_size) {
+    if (key_size != kKeySizeInBytes) {
+      return crypto::tink::util::Status(
+          crypto::tink::util::error::INVALID_ARGUMENT,
+          absl::StrCat("Invalid key size: key size is ", key_size,
+                       " bytes; supported size: ", kKeySizeInBytes, " bytes."));
+    }
+    return crypto::tink::util::OkStatus();
+  }
+
+  static crypto::tink::util::StatusOr<std::unique_ptr<DeterministicAead>>
+  NewAesSiv(const util::SecretData& key) {
+#if defined(__SSE4_1__) && defined(__AES__)
+    if (subtle::UseAesniImplementations()) {
+      subtle::RecordImplementation("SearchableAesSiv", "aesni");
+      return subtle::AesSivAesni::New(key);
+    }
+#endif
+    subtle::RecordImplementation("SearchableAesSiv", "boringssl");
+    return subtle::AesSivBoringSsl::New(key);
+  }
+
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<subtle::SearchableAesSiv>>
+  NewSearchableAesSiv(const google::crypto::tink::SearchableAesSivKey& key) {
+    util::SecretData key_value =
+        util::SecretDataFromStringView(key.key_value());
+    auto aes_siv_result = NewAesSiv(util::SecretData(
+        key_value.begin(), key_value.begin() + kAesSivKeySizeInBytes));
+    if (!aes_siv_result.ok()) return aes_siv_result.status();
+    return subtle::SearchableAesSiv::New(
+        std::move(aes_siv_result.ValueOrDie()),
+        util::SecretData(key_value.begin() + kAesSivKeySizeInBytes,
+                         key_value.end()));
+  }
+
+  const std::string key_type_ = absl::StrCat(
+      kTypeGoogleapisCom,
+      google::crypto::tink::SearchableAesSivKey().GetTypeName());
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_DAEAD_SEARCHABLE_AES_SIV_KEY_MANAGER_H_
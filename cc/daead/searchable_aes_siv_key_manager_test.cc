@@ -0,0 +1,155 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/daead/searchable_aes_siv_key_manager.h"
+
+#include <sstream>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "tink/deterministic_aead.h"
+#include "tink/searchable_deterministic_aead.h"
+#include "tink/subtle/aes_siv_boringssl.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/searchable_aes_siv.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::SearchableAesSivKey;
+using ::google::crypto::tink::SearchableAesSivKeyFormat;
+using ::testing::Eq;
+using ::testing::HasSubstr;
+using ::testing::Ne;
+using ::testing::Not;
+using ::testing::SizeIs;
+
+namespace {
+
+TEST(SearchableAesSivKeyManagerTest, Basics) {
+  EXPECT_THAT(SearchableAesSivKeyManager().get_version(), Eq(0));
+  EXPECT_THAT(SearchableAesSivKeyManager().get_key_type(),
+              Eq("type.googleapis.com/google.crypto.tink.SearchableAesSivKey"));
+  EXPECT_THAT(SearchableAesSivKeyManager().key_material_type(),
+              Eq(google::crypto::tink::KeyData::SYMMETRIC));
+}
+
+TEST(SearchableAesSivKeyManagerTest, ValidateKeyFormat) {
+  SearchableAesSivKeyFormat format;
+  for (int i = 0; i <= 128; ++i) {
+    format.set_key_size(i);
+    if (i == 96) {
+      EXPECT_THAT(SearchableAesSivKeyManager().ValidateKeyFormat(format),
+                  IsOk());
+    } else {
+      EXPECT_THAT(SearchableAesSivKeyManager().ValidateKeyFormat(format),
+                  Not(IsOk()))
+          << " for length " << i;
+    }
+  }
+}
+
+TEST(SearchableAesSivKeyManagerTest, CreateKey) {
+  SearchableAesSivKeyManager manager;
+  SearchableAesSivKeyFormat format;
+  format.set_key_size(96);
+  auto key1_or = manager.CreateKey(format);
+  ASSERT_THAT(key1_or.status(), IsOk());
+  EXPECT_THAT(key1_or.ValueOrDie().key_value(), SizeIs(96));
+  EXPECT_THAT(key1_or.ValueOrDie().version(), Eq(0));
+  EXPECT_THAT(manager.ValidateKey(key1_or.ValueOrDie()), IsOk());
+  auto key2_or = manager.CreateKey(format);
+  ASSERT_THAT(key2_or.status(), IsOk());
+  EXPECT_THAT(key1_or.ValueOrDie().key_value(),
+              Ne(key2_or.ValueOrDie().key_value()));
+}
+
+TEST(SearchableAesSivKeyManagerTest, DeriveKey) {
+  std::string randomness(96, 'k');
+  util::IstreamInputStream input_stream{
+      absl::make_unique<std::stringstream>(randomness + "XXXXX")};
+  SearchableAesSivKeyFormat format;
+  format.set_key_size(96);
+  auto key_or = SearchableAesSivKeyManager().DeriveKey(format, &input_stream);
+  ASSERT_THAT(key_or.status(), IsOk());
+  EXPECT_THAT(key_or.ValueOrDie().key_value(), Eq(randomness));
+
+  util::IstreamInputStream short_input_stream{
+      absl::make_unique<std::stringstream>(std::string(64, 'k'))};
+  EXPECT_THAT(
+      SearchableAesSivKeyManager().DeriveKey(format, &short_input_stream)
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT, HasSubstr("pseudorandomness")));
+}
+
+TEST(SearchableAesSivKeyManagerTest, ValidateKey) {
+  SearchableAesSivKey key;
+  key.set_version(0);
+  key.set_key_value(std::string(96, 'a'));
+  EXPECT_THAT(SearchableAesSivKeyManager().ValidateKey(key), IsOk());
+  key.set_key_value(std::string(64, 'a'));
+  EXPECT_THAT(SearchableAesSivKeyManager().ValidateKey(key), Not(IsOk()));
+  key.set_key_value(std::string(96, 'a'));
+  key.set_version(1);
+  EXPECT_THAT(SearchableAesSivKeyManager().ValidateKey(key), Not(IsOk()));
+}
+
+TEST(SearchableAesSivKeyManagerTest, GetPrimitives) {
+  SearchableAesSivKeyFormat format;
+  format.set_key_size(96);
+  SearchableAesSivKey key =
+      SearchableAesSivKeyManager().CreateKey(format).ValueOrDie();
+  auto daead_or =
+      SearchableAesSivKeyManager().GetPrimitive<DeterministicAead>(key);
+  ASSERT_THAT(daead_or.status(), IsOk());
+  auto searchable_or =
+      SearchableAesSivKeyManager().GetPrimitive<SearchableDeterministicAead>(
+          key);
+  ASSERT_THAT(searchable_or.status(), IsOk());
+
+  auto encrypt_result =
+      searchable_or.ValueOrDie()->EncryptWithSearchToken("123", "abcd");
+  ASSERT_THAT(encrypt_result.status(), IsOk());
+  const SearchableCiphertext& result = encrypt_result.ValueOrDie();
+  EXPECT_THAT(result.search_token, SizeIs(16));
+  // Both primitives produce the AES-SIV ciphertexts of the first 64 bytes
+  // of the key.
+  auto aes_siv =
+      subtle::AesSivBoringSsl::New(
+          util::SecretDataFromStringView(key.key_value().substr(0, 64)))
+          .ValueOrDie();
+  EXPECT_THAT(aes_siv->EncryptDeterministically("123", "abcd"),
+              IsOkAndHolds(result.ciphertext));
+  const DeterministicAead& daead = *daead_or.ValueOrDie();
+  EXPECT_THAT(daead.EncryptDeterministically("123", "abcd"),
+              IsOkAndHolds(result.ciphertext));
+  EXPECT_THAT(daead.DecryptDeterministically(result.ciphertext, "abcd"),
+              IsOkAndHolds("123"));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,172 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/daead/searchable_deterministic_aead_wrapper.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/crypto_format.h"
+#include "tink/internal/monitored_operation.h"
+#include "tink/primitive_set.h"
+#include "tink/searchable_deterministic_aead.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+using Entry = PrimitiveSet<SearchableDeterministicAead>::Entry<
+    SearchableDeterministicAead>;
+
+util::Status Validate(PrimitiveSet<SearchableDeterministicAead>* daead_set) {
+  if (daead_set == nullptr) {
+    return util::Status(util::error::INTERNAL, "daead_set must be non-NULL");
+  }
+  if (daead_set->get_primary() == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "daead_set has no primary");
+  }
+  return util::Status::OK;
+}
+
+class SearchableDeterministicAeadSetWrapper
+    : public SearchableDeterministicAead {
+ public:
+  explicit SearchableDeterministicAeadSetWrapper(
+      std::unique_ptr<PrimitiveSet<SearchableDeterministicAead>> daead_set)
+      : daead_set_(std::move(daead_set)) {}
+
+  crypto::tink::util::StatusOr<SearchableCiphertext> EncryptWithSearchToken(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> ComputeSearchToken(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override;
+
+ private:
+  std::unique_ptr<PrimitiveSet<SearchableDeterministicAead>> daead_set_;
+};
+
+util::StatusOr<SearchableCiphertext>
+SearchableDeterministicAeadSetWrapper::EncryptWithSearchToken(
+    absl::string_view plaintext, absl::string_view associated_data) const {
+  // BoringSSL expects a non-null pointer for plaintext and additional_data,
+  // regardless of whether the size is 0.
+  plaintext = subtle::SubtleUtilBoringSSL::EnsureNonNull(plaintext);
+  associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+
+  internal::MonitoredOperation operation("searchable_daead", "encrypt");
+  operation.KeyTried();
+  const Entry* primary = daead_set_->get_primary();
+  auto encrypt_result = primary->get_primitive().EncryptWithSearchToken(
+      plaintext, associated_data);
+  if (!encrypt_result.ok()) return encrypt_result.status();
+  operation.Succeeded(primary->get_key_id());
+  SearchableCiphertext& result = encrypt_result.ValueOrDie();
+  absl::string_view key_id = primary->get_identifier();
+  if (!key_id.empty()) {
+    result.ciphertext = absl::StrCat(key_id, result.ciphertext);
+    result.search_token = absl::StrCat(key_id, result.search_token);
+  }
+  return encrypt_result;
+}
+
+util::StatusOr<std::string>
+SearchableDeterministicAeadSetWrapper::ComputeSearchToken(
+    absl::string_view plaintext, absl::string_view associated_data) const {
+  plaintext = subtle::SubtleUtilBoringSSL::EnsureNonNull(plaintext);
+  associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+
+  const Entry* primary = daead_set_->get_primary();
+  auto token_result =
+      primary->get_primitive().ComputeSearchToken(plaintext, associated_data);
+  if (!token_result.ok()) return token_result.status();
+  return absl::StrCat(primary->get_identifier(), token_result.ValueOrDie());
+}
+
+util::StatusOr<std::string>
+SearchableDeterministicAeadSetWrapper::DecryptDeterministically(
+    absl::string_view ciphertext, absl::string_view associated_data) const {
+  associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+
+  internal::MonitoredOperation operation("searchable_daead", "decrypt");
+  if (ciphertext.length() > CryptoFormat::kNonRawPrefixSize) {
+    absl::string_view key_id =
+        ciphertext.substr(0, CryptoFormat::kNonRawPrefixSize);
+    auto primitives_result = daead_set_->get_primitives(key_id);
+    if (primitives_result.ok()) {
+      absl::string_view raw_ciphertext =
+          ciphertext.substr(CryptoFormat::kNonRawPrefixSize);
+      for (auto& entry : *primitives_result.ValueOrDie()) {
+        operation.KeyTried();
+        auto decrypt_result = entry->get_primitive().DecryptDeterministically(
+            raw_ciphertext, associated_data);
+        if (decrypt_result.ok()) {
+          operation.Succeeded(entry->get_key_id());
+          return decrypt_result;
+        }
+      }
+    }
+  }
+
+  // No matching key succeeded with decryption, try all RAW keys.
+  auto raw_primitives_result = daead_set_->get_raw_primitives();
+  if (raw_primitives_result.ok()) {
+    operation.RawKeysTried();
+    for (auto& entry : *raw_primitives_result.ValueOrDie()) {
+      operation.KeyTried();
+      auto decrypt_result = entry->get_primitive().DecryptDeterministically(
+          ciphertext, associated_data);
+      if (decrypt_result.ok()) {
+        operation.Succeeded(entry->get_key_id());
+        return decrypt_result;
+      }
+    }
+  }
+  return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
+}
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<SearchableDeterministicAead>>
+SearchableDeterministicAeadWrapper::Wrap(
+    std::unique_ptr<PrimitiveSet<SearchableDeterministicAead>> primitive_set)
+    const {
+  util::Status status = Validate(primitive_set.get());
+  if (!status.ok()) return status;
+  primitive_set->Freeze();
+  std::unique_ptr<SearchableDeterministicAead> daead =
+      absl::make_unique<SearchableDeterministicAeadSetWrapper>(
+          std::move(primitive_set));
+  return std::move(daead);
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,55 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_DAEAD_SEARCHABLE_DETERMINISTIC_AEAD_WRAPPER_H_
+#define TINK_DAEAD_SEARCHABLE_DETERMINISTIC_AEAD_WRAPPER_H_
+
+#include <memory>
+
+#include "tink/primitive_set.h"
+#include "tink/primitive_wrapper.h"
+#include "tink/searchable_deterministic_aead.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+// Wraps a set of SearchableDeterministicAead-instances that correspond to a
+// keyset, and combines them into a single SearchableDeterministicAead:
+//   * EncryptWithSearchToken(...) and ComputeSearchToken(...) use the
+//     primary instance, and prefix both the ciphertext and the token with
+//     the output prefix of the primary key
+//   * DecryptDeterministically(...) uses the instance that matches the
+//     ciphertext prefix, or the RAW instances.
+// Prefixing the tokens keeps the tokens of different keys apart; while a
+// keyset is rotated, queries look up the token of each key.
+class SearchableDeterministicAeadWrapper
+    : public PrimitiveWrapper<SearchableDeterministicAead,
+                              SearchableDeterministicAead> {
+ public:
+  // Returns a SearchableDeterministicAead that uses the instances provided
+  // in 'primitive_set', which must be non-NULL and must contain a primary
+  // instance.
+  crypto::tink::util::StatusOr<std::unique_ptr<SearchableDeterministicAead>>
+  Wrap(std::unique_ptr<PrimitiveSet<SearchableDeterministicAead>>
+           primitive_set) const override;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_DAEAD_SEARCHABLE_DETERMINISTIC_AEAD_WRAPPER_H_
@@ -0,0 +1,130 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/daead/searchable_deterministic_aead_wrapper.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/match.h"
+#include "tink/primitive_set.h"
+#include "tink/searchable_deterministic_aead.h"
+#include "tink/subtle/aes_siv_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/searchable_aes_siv.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::google::crypto::tink::KeysetInfo;
+using ::google::crypto::tink::KeyStatusType;
+using ::google::crypto::tink::OutputPrefixType;
+using ::testing::Not;
+
+std::unique_ptr<SearchableDeterministicAead> NewSearchableAesSiv() {
+  auto aes_siv =
+      subtle::AesSivBoringSsl::New(subtle::Random::GetRandomKeyBytes(64));
+  EXPECT_THAT(aes_siv.status(), IsOk());
+  auto searchable = subtle::SearchableAesSiv::New(
+      std::move(aes_siv.ValueOrDie()), subtle::Random::GetRandomKeyBytes(32));
+  EXPECT_THAT(searchable.status(), IsOk());
+  return std::move(searchable.ValueOrDie());
+}
+
+KeysetInfo::KeyInfo NewKeyInfo(uint32_t key_id,
+                               OutputPrefixType output_prefix_type) {
+  KeysetInfo::KeyInfo key_info;
+  key_info.set_output_prefix_type(output_prefix_type);
+  key_info.set_key_id(key_id);
+  key_info.set_status(KeyStatusType::ENABLED);
+  return key_info;
+}
+
+TEST(SearchableDeterministicAeadWrapperTest, WrapNullptr) {
+  EXPECT_THAT(SearchableDeterministicAeadWrapper().Wrap(nullptr).status(),
+              Not(IsOk()));
+}
+
+TEST(SearchableDeterministicAeadWrapperTest, WrapWithoutPrimary) {
+  auto daead_set =
+      absl::make_unique<PrimitiveSet<SearchableDeterministicAead>>();
+  ASSERT_THAT(daead_set
+                  ->AddPrimitive(NewSearchableAesSiv(),
+                                 NewKeyInfo(1234, OutputPrefixType::TINK))
+                  .status(),
+              IsOk());
+  EXPECT_THAT(
+      SearchableDeterministicAeadWrapper().Wrap(std::move(daead_set)).status(),
+      Not(IsOk()));
+}
+
+TEST(SearchableDeterministicAeadWrapperTest, EncryptDecrypt) {
+  auto daead_set =
+      absl::make_unique<PrimitiveSet<SearchableDeterministicAead>>();
+  auto raw_entry = daead_set->AddPrimitive(
+      NewSearchableAesSiv(), NewKeyInfo(1234, OutputPrefixType::RAW));
+  ASSERT_THAT(raw_entry.status(), IsOk());
+  auto tink_entry = daead_set->AddPrimitive(
+      NewSearchableAesSiv(), NewKeyInfo(5678, OutputPrefixType::TINK));
+  ASSERT_THAT(tink_entry.status(), IsOk());
+  std::string prefix(tink_entry.ValueOrDie()->get_identifier());
+  const SearchableDeterministicAead& raw_primitive =
+      raw_entry.ValueOrDie()->get_primitive();
+  std::string raw_ciphertext =
+      raw_primitive.EncryptWithSearchToken("value", "column")
+          .ValueOrDie()
+          .ciphertext;
+  std::string raw_token =
+      raw_primitive.ComputeSearchToken("value", "column").ValueOrDie();
+  ASSERT_THAT(daead_set->set_primary(tink_entry.ValueOrDie()), IsOk());
+
+  auto wrap_result =
+      SearchableDeterministicAeadWrapper().Wrap(std::move(daead_set));
+  ASSERT_THAT(wrap_result.status(), IsOk());
+  const SearchableDeterministicAead& daead = *wrap_result.ValueOrDie();
+
+  auto result = daead.EncryptWithSearchToken("value", "column");
+  ASSERT_THAT(result.status(), IsOk());
+  const SearchableCiphertext& searchable = result.ValueOrDie();
+  EXPECT_TRUE(absl::StartsWith(searchable.ciphertext, prefix));
+  EXPECT_TRUE(absl::StartsWith(searchable.search_token, prefix));
+  EXPECT_THAT(daead.ComputeSearchToken("value", "column"),
+              IsOkAndHolds(searchable.search_token));
+  EXPECT_NE(searchable.search_token, raw_token);
+
+  EXPECT_THAT(daead.DecryptDeterministically(searchable.ciphertext, "column"),
+              IsOkAndHolds("value"));
+  EXPECT_THAT(daead.DecryptDeterministically(raw_ciphertext, "column"),
+              IsOkAndHolds("value"));
+  EXPECT_THAT(
+      daead.DecryptDeterministically(raw_ciphertext, "other column").status(),
+      Not(IsOk()));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -17,12 +17,22 @@
 #ifndef TINK_DETERMINISTIC_AEAD_H_
 #define TINK_DETERMINISTIC_AEAD_H_
 
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/util/inlined_buffer.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
 namespace tink {
 
+class DeterministicAeadWithAssociatedData;
+
 ///////////////////////////////////////////////////////////////////////////////
 // The interface for deterministic authenticated encryption with associated
 // data.
@@ -51,9 +61,123 @@ class DeterministicAead {
       absl::string_view ciphertext,
       absl::string_view associated_data) const = 0;
 
+  // Encrypts 'plaintext' as EncryptDeterministically() does, but returns the
+  // ciphertext in '*ciphertext', so that ciphertexts of up to N bytes need
+  // no heap allocation.  Uses EncryptDeterministicallyBatchInto() if the
+  // implementation knows CiphertextSize(), and copies the result of
+  // EncryptDeterministically() otherwise.
+  template <size_t N>
+  crypto::tink::util::Status EncryptDeterministically(
+      absl::string_view plaintext, absl::string_view associated_data,
+      crypto::tink::util::InlinedBuffer<N>* ciphertext) const {
+    auto size_result = CiphertextSize(plaintext.size());
+    if (!size_result.ok()) {
+      auto ciphertext_result =
+          EncryptDeterministically(plaintext, associated_data);
+      if (!ciphertext_result.ok()) return ciphertext_result.status();
+      ciphertext->assign(ciphertext_result.ValueOrDie());
+      return crypto::tink::util::Status::OK;
+    }
+    ciphertext->resize(size_result.ValueOrDie());
+    absl::string_view plaintexts[] = {plaintext};
+    absl::Span<char> buffers[] = {ciphertext->AsSpan()};
+    return EncryptDeterministicallyBatchInto(plaintexts, associated_data,
+                                             buffers);
+  }
+
+  // Decrypts 'ciphertext' as DecryptDeterministically() does, but only with
+  // the key with id 'key_id' of the keyset, instead of the keys which may
+  // have produced it.  This is for callers which store the key id next to
+  // the ciphertext, e.g. to save the prefix of RAW ciphertexts, where
+  // DecryptDeterministically() would try all RAW keys.  'ciphertext' starts
+  // with the output prefix of the key, if it has one.  Primitives of
+  // keysets implement this; the default implementation returns
+  // UNIMPLEMENTED.
+  virtual crypto::tink::util::StatusOr<std::string>
+  DecryptDeterministicallyWithKeyId(absl::string_view ciphertext,
+                                    absl::string_view associated_data,
+                                    uint32_t key_id) const {
+    return crypto::tink::util::Status(
+        crypto::tink::util::error::UNIMPLEMENTED,
+        "DecryptDeterministicallyWithKeyId() is not supported by this "
+        "DeterministicAead");
+  }
+
+  // Returns the size of the ciphertext produced for a plaintext of
+  // 'plaintext_size' bytes, or an UNIMPLEMENTED error if the implementation
+  // cannot determine it without encrypting.
+  virtual crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const {
+    return crypto::tink::util::Status(
+        crypto::tink::util::error::UNIMPLEMENTED,
+        "CiphertextSize() is not supported by this DeterministicAead");
+  }
+
+  // Encrypts all values of a column, each with 'associated_data' as
+  // associated data. The column is given in the layout Arrow uses for
+  // variable-length binary data: 'plaintext_offsets' holds n + 1
+  // non-decreasing offsets into 'plaintext_data', and the i-th of the n
+  // values is plaintext_data[plaintext_offsets[i], plaintext_offsets[i + 1]).
+  // The ciphertexts are written in the same layout: '*ciphertext_data' is
+  // sized once for the whole column and '*ciphertext_offsets' receives
+  // n + 1 offsets, starting at 0. Either all values are encrypted or an
+  // error is returned.
+  crypto::tink::util::Status EncryptDeterministicallyBatch(
+      absl::Span<const int64_t> plaintext_offsets,
+      absl::string_view plaintext_data, absl::string_view associated_data,
+      std::string* ciphertext_data,
+      std::vector<int64_t>* ciphertext_offsets) const;
+
+  // Decrypts all values of a column in the layout of
+  // EncryptDeterministicallyBatch(), each with 'associated_data' as
+  // associated data. Either all values are decrypted or an error is
+  // returned.
+  crypto::tink::util::Status DecryptDeterministicallyBatch(
+      absl::Span<const int64_t> ciphertext_offsets,
+      absl::string_view ciphertext_data, absl::string_view associated_data,
+      std::string* plaintext_data,
+      std::vector<int64_t>* plaintext_offsets) const;
+
+  // Encrypts plaintexts[i] into ciphertext_buffers[i], for every i, with
+  // 'associated_data' as associated data. Each buffer has exactly
+  // CiphertextSize(plaintexts[i].size()) bytes. This is the customization
+  // point behind EncryptDeterministicallyBatch(), for implementations that
+  // can share work between values (e.g. process several of them at once);
+  // the default implementation calls EncryptDeterministically() for every
+  // value.
+  virtual crypto::tink::util::Status EncryptDeterministicallyBatchInto(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> ciphertext_buffers) const;
+
+  // Returns an object which encrypts and decrypts like this one, always with
+  // 'associated_data' as associated data. Implementations compute the part
+  // of the work which only depends on the associated data (e.g. its MAC)
+  // once here, rather than for every message. The returned object refers to
+  // this one, which must outlive it.
+  //
+  // The default implementation keeps a copy of 'associated_data' and calls
+  // EncryptDeterministically() and DecryptDeterministically().
+  virtual crypto::tink::util::StatusOr<
+      std::unique_ptr<DeterministicAeadWithAssociatedData>>
+  WithAssociatedData(absl::string_view associated_data) const;
+
   virtual ~DeterministicAead() {}
 };
 
+// A DeterministicAead bound to fixed associated data, as returned by
+// DeterministicAead::WithAssociatedData().
+class DeterministicAeadWithAssociatedData {
+ public:
+  virtual crypto::tink::util::StatusOr<std::string> EncryptDeterministically(
+      absl::string_view plaintext) const = 0;
+
+  virtual crypto::tink::util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext) const = 0;
+
+  virtual ~DeterministicAeadWithAssociatedData() {}
+};
+
 }  // namespace tink
 }  // namespace crypto
 
@@ -0,0 +1,98 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_ENCRYPTED_KEYSET_CACHE_H_
+#define TINK_ENCRYPTED_KEYSET_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "absl/types/optional.h"
+#include "tink/util/secret_data.h"
+
+namespace crypto {
+namespace tink {
+
+// A bounded cache of decrypted keysets for KeysetHandle::Read(), indexed by
+// the SHA-256 digest of the encrypted keyset. Processes which read the same
+// encrypted keyset repeatedly, e.g. at startup and on every configuration
+// refresh, thus make a single call to the master key, which is usually a
+// remote KMS, per TTL.
+//
+// A read served from the cache does not use the master key at all, so a
+// cache must only be shared by code which may read all the keysets it
+// holds. The decrypted keysets are held in SecretData, which is zeroized
+// when the entries are dropped.
+//
+// This class is thread-safe.
+class EncryptedKeysetCache {
+ public:
+  struct Options {
+    // The maximal number of cached keysets. The least recently used keyset
+    // is dropped when a new one is added to a full cache.
+    int max_entries = 16;
+    // The time a decrypted keyset is cached.
+    absl::Duration ttl = absl::Minutes(10);
+  };
+
+  explicit EncryptedKeysetCache(const Options& options) : options_(options) {}
+
+  EncryptedKeysetCache(const EncryptedKeysetCache&) = delete;
+  EncryptedKeysetCache& operator=(const EncryptedKeysetCache&) = delete;
+
+  // Returns the cache shared by the whole process, with the default options.
+  static EncryptedKeysetCache& GlobalInstance();
+
+  // Drops all cached keysets, e.g. after the master key was rotated.
+  void Clear() ABSL_LOCKS_EXCLUDED(mutex_);
+
+ private:
+  friend class KeysetHandle;
+
+  struct Entry {
+    std::string digest;
+    util::SecretData serialized_keyset;
+    absl::Time expiration;
+    std::list<uint64_t>::iterator lru_position;
+  };
+
+  // Returns the serialized keyset decrypted from 'encrypted_keyset', or
+  // absl::nullopt if it is not cached.
+  absl::optional<util::SecretData> Lookup(absl::string_view encrypted_keyset)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Caches 'serialized_keyset' as the decryption of 'encrypted_keyset'.
+  void Insert(absl::string_view encrypted_keyset,
+              util::SecretData serialized_keyset) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  const Options options_;
+  absl::Mutex mutex_;
+  // Entries indexed by the first 8 bytes of their digest, with the least
+  // recently used one at the back of 'lru_'.
+  absl::flat_hash_map<uint64_t, Entry> entries_ ABSL_GUARDED_BY(mutex_);
+  std::list<uint64_t> lru_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_ENCRYPTED_KEYSET_CACHE_H_
@@ -0,0 +1,59 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_EXECUTOR_H_
+#define TINK_EXECUTOR_H_
+
+#include <functional>
+
+namespace crypto {
+namespace tink {
+
+// Runs the tasks into which Tink splits large operations, e.g. the segments
+// of a parallel encrypting stream or the chunks of AesGcmParallel.
+//
+// The APIs that accept an Executor share it with the caller, so that an
+// application can run all of Tink's parallel work on one scheduler of its
+// own, and bound the number of cores that Tink uses.  NewThreadPoolExecutor()
+// (see thread_pool_executor.h) returns the default implementation.
+//
+// Implementations must be thread safe.
+class Executor {
+ public:
+  virtual ~Executor() = default;
+
+  // Runs 'task' at some later point, possibly on another thread.  'task'
+  // must run even if it is scheduled while the executor is being destroyed.
+  virtual void Schedule(std::function<void()> task) = 0;
+
+  // Returns the number of threads that run scheduled tasks, not counting
+  // the threads that call ParallelFor().  Used as a hint on how many tasks
+  // to split an operation into.
+  virtual int num_threads() const = 0;
+
+  // Calls 'func'(i) for every i in [0, count), on the threads of this
+  // executor and on the calling thread, and returns once all calls have
+  // returned.  Must not be called from a task running on this executor.
+  //
+  // The default implementation schedules up to num_threads() tasks, which
+  // claim the indices one by one along with the calling thread.
+  virtual void ParallelFor(int count, const std::function<void(int)>& func);
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_EXECUTOR_H_
@@ -0,0 +1,134 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/fieldenc/field_encryption.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/base/internal/endian.h"
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/deterministic_aead.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace fieldenc {
+
+namespace {
+
+constexpr int kFieldNumberSize = 4;
+
+}  // namespace
+
+util::Status FieldBatch::Encrypt(const FieldEncryptionPrimitives& primitives,
+                                 absl::string_view associated_data) {
+  return Process(/*encrypt=*/true, primitives, associated_data);
+}
+
+util::Status FieldBatch::Decrypt(const FieldEncryptionPrimitives& primitives,
+                                 absl::string_view associated_data) {
+  return Process(/*encrypt=*/false, primitives, associated_data);
+}
+
+util::Status FieldBatch::Process(bool encrypt,
+                                 const FieldEncryptionPrimitives& primitives,
+                                 absl::string_view associated_data) {
+  if (!randomized_.empty() && primitives.aead == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "The message has randomized fields but no Aead");
+  }
+  if (!deterministic_.empty() && primitives.deterministic_aead == nullptr) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        "The message has deterministic fields but no DeterministicAead");
+  }
+
+  // The results are only written back once all fields are processed.
+  std::string randomized_arena;
+  std::vector<absl::string_view> randomized_outputs;
+  if (!randomized_.empty()) {
+    std::string associated_data_arena;
+    associated_data_arena.reserve(randomized_.size() *
+                                  (kFieldNumberSize + associated_data.size()));
+    std::vector<absl::string_view> inputs;
+    inputs.reserve(randomized_.size());
+    for (const RandomizedField& field : randomized_) {
+      char field_number[kFieldNumberSize];
+      absl::big_endian::Store32(field_number, field.field_number);
+      associated_data_arena.append(field_number, kFieldNumberSize);
+      associated_data_arena.append(associated_data.data(),
+                                   associated_data.size());
+      inputs.push_back(*field.value);
+    }
+    // Taken after all appends, so that the arena does not move anymore.
+    std::vector<absl::string_view> field_associated_data;
+    field_associated_data.reserve(randomized_.size());
+    const size_t stride = kFieldNumberSize + associated_data.size();
+    for (size_t i = 0; i < randomized_.size(); ++i) {
+      field_associated_data.push_back(absl::string_view(
+          associated_data_arena.data() + i * stride, stride));
+    }
+    util::Status status =
+        encrypt ? primitives.aead->EncryptBatch(inputs, field_associated_data,
+                                                &randomized_arena,
+                                                &randomized_outputs)
+                : primitives.aead->DecryptBatch(inputs, field_associated_data,
+                                                &randomized_arena,
+                                                &randomized_outputs);
+    if (!status.ok()) return status;
+  }
+
+  std::string deterministic_data;
+  std::vector<int64_t> deterministic_offsets;
+  if (!deterministic_.empty()) {
+    std::vector<int64_t> input_offsets;
+    input_offsets.reserve(deterministic_.size() + 1);
+    input_offsets.push_back(0);
+    std::string input_data;
+    for (const std::string* value : deterministic_) {
+      input_offsets.push_back(input_offsets.back() + value->size());
+    }
+    input_data.reserve(input_offsets.back());
+    for (const std::string* value : deterministic_) input_data += *value;
+    const DeterministicAead& daead = *primitives.deterministic_aead;
+    util::Status status =
+        encrypt ? daead.EncryptDeterministicallyBatch(
+                      input_offsets, input_data, associated_data,
+                      &deterministic_data, &deterministic_offsets)
+                : daead.DecryptDeterministicallyBatch(
+                      input_offsets, input_data, associated_data,
+                      &deterministic_data, &deterministic_offsets);
+    if (!status.ok()) return status;
+  }
+
+  for (size_t i = 0; i < randomized_.size(); ++i) {
+    randomized_[i].value->assign(randomized_outputs[i].data(),
+                                 randomized_outputs[i].size());
+  }
+  for (size_t i = 0; i < deterministic_.size(); ++i) {
+    deterministic_[i]->assign(
+        deterministic_data, deterministic_offsets[i],
+        deterministic_offsets[i + 1] - deterministic_offsets[i]);
+  }
+  return util::Status::OK;
+}
+
+}  // namespace fieldenc
+}  // namespace tink
+}  // namespace crypto
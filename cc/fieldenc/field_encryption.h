@@ -0,0 +1,112 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_FIELDENC_FIELD_ENCRYPTION_H_
+#define TINK_FIELDENC_FIELD_ENCRYPTION_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/deterministic_aead.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace fieldenc {
+
+// Encryption of the fields of protobuf messages which are annotated with
+// (google.crypto.tink.tink_field_encryption), see
+// proto/field_encryption.proto.
+//
+// protoc-gen-tink_fields generates, for every message of a .proto file
+// which has annotated fields, directly or in its sub-messages of the same
+// file, the functions
+//
+//   crypto::tink::util::Status EncryptTinkFields(
+//       const crypto::tink::fieldenc::FieldEncryptionPrimitives& primitives,
+//       absl::string_view associated_data, Message* message);
+//   crypto::tink::util::Status DecryptTinkFields(
+//       const crypto::tink::fieldenc::FieldEncryptionPrimitives& primitives,
+//       absl::string_view associated_data, Message* message);
+//
+// in <name>.tink_fields.h, which replace the values of the annotated fields
+// by their ciphertexts and back, in place.  The generated code collects the
+// fields into a FieldBatch with typed accessors, without reflection, and
+// the batch encrypts all of them with one call of the batch API of each
+// primitive.
+
+enum class FieldEncryptionMode {
+  kRandomized,
+  kDeterministic,
+};
+
+// The primitives for the annotated fields of a message.  Either may be null
+// if the message has no field of its mode.
+struct FieldEncryptionPrimitives {
+  const Aead* aead = nullptr;
+  const DeterministicAead* deterministic_aead = nullptr;
+};
+
+// The annotated fields of a message, as collected by generated code.
+//
+// A randomized field is encrypted with the Aead, with its field number
+// (as 4 big-endian bytes) followed by 'associated_data' as associated
+// data, so that its ciphertext cannot be moved to a field of another
+// number.  Deterministic fields are encrypted with the DeterministicAead,
+// all with 'associated_data', so that equal values of different fields can
+// be matched.
+//
+// Either all fields are encrypted (or decrypted) or none is modified.
+class FieldBatch {
+ public:
+  void Add(FieldEncryptionMode mode, uint32_t field_number,
+           std::string* value) {
+    if (mode == FieldEncryptionMode::kRandomized) {
+      randomized_.push_back({field_number, value});
+    } else {
+      deterministic_.push_back(value);
+    }
+  }
+
+  crypto::tink::util::Status Encrypt(
+      const FieldEncryptionPrimitives& primitives,
+      absl::string_view associated_data);
+  crypto::tink::util::Status Decrypt(
+      const FieldEncryptionPrimitives& primitives,
+      absl::string_view associated_data);
+
+ private:
+  struct RandomizedField {
+    uint32_t field_number;
+    std::string* value;
+  };
+
+  crypto::tink::util::Status Process(
+      bool encrypt, const FieldEncryptionPrimitives& primitives,
+      absl::string_view associated_data);
+
+  std::vector<RandomizedField> randomized_;
+  std::vector<std::string*> deterministic_;
+};
+
+}  // namespace fieldenc
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_FIELDENC_FIELD_ENCRYPTION_H_
@@ -0,0 +1,295 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/fieldenc/field_encryption_generator.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "absl/strings/strip.h"
+#include "absl/strings/substitute.h"
+#include "google/protobuf/descriptor.h"
+#include "tink/util/status.h"
+#include "proto/field_encryption.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace fieldenc {
+
+namespace {
+
+using ::google::crypto::tink::FieldEncryptionMode;
+using ::google::protobuf::Descriptor;
+using ::google::protobuf::FieldDescriptor;
+using ::google::protobuf::FileDescriptor;
+
+constexpr absl::string_view kPrimitivesParameter =
+    "    const crypto::tink::fieldenc::FieldEncryptionPrimitives& "
+    "primitives,\n"
+    "    absl::string_view associated_data, $0* message)";
+
+std::string BaseName(const FileDescriptor& file) {
+  absl::string_view name = file.name();
+  absl::ConsumeSuffix(&name, ".proto");
+  return std::string(name);
+}
+
+// The name of the C++ class of 'message' within its package namespace.
+std::string ClassName(const Descriptor& message) {
+  absl::string_view name = message.full_name();
+  if (!message.file()->package().empty()) {
+    name.remove_prefix(message.file()->package().size() + 1);
+  }
+  return absl::StrReplaceAll(name, {{".", "_"}});
+}
+
+FieldEncryptionMode ModeOf(const FieldDescriptor& field) {
+  return field.options().GetExtension(
+      google::crypto::tink::tink_field_encryption);
+}
+
+bool IsAnnotated(const FieldDescriptor& field) {
+  return ModeOf(field) != google::crypto::tink::UNKNOWN_FIELD_ENCRYPTION;
+}
+
+// Returns whether 'field' holds sub-messages to follow, i.e. of a type of
+// 'file' which is not a map entry.
+bool IsSubMessageOf(const FieldDescriptor& field, const FileDescriptor& file) {
+  return field.type() == FieldDescriptor::TYPE_MESSAGE &&
+         !field.is_map() && field.message_type()->file() == &file;
+}
+
+void CollectMessages(const Descriptor& message,
+                     std::vector<const Descriptor*>* messages) {
+  if (message.options().map_entry()) return;
+  messages->push_back(&message);
+  for (int i = 0; i < message.nested_type_count(); ++i) {
+    CollectMessages(*message.nested_type(i), messages);
+  }
+}
+
+// Appends the body of the CollectTinkFields() of 'message'.
+void AppendCollect(const Descriptor& message,
+                   const absl::flat_hash_set<const Descriptor*>& encrypted,
+                   std::string* source) {
+  absl::StrAppend(source, "void CollectTinkFields(", ClassName(message),
+                  "* message,\n"
+                  "                       crypto::tink::fieldenc::FieldBatch* "
+                  "batch) {\n");
+  for (int i = 0; i < message.field_count(); ++i) {
+    const FieldDescriptor& field = *message.field(i);
+    std::string name = field.lowercase_name();
+    if (IsAnnotated(field)) {
+      std::string mode =
+          ModeOf(field) == google::crypto::tink::DETERMINISTIC
+              ? "crypto::tink::fieldenc::FieldEncryptionMode::kDeterministic"
+              : "crypto::tink::fieldenc::FieldEncryptionMode::kRandomized";
+      if (field.is_repeated()) {
+        absl::StrAppend(
+            source, absl::Substitute(
+                        "  for (std::string& value : *message->mutable_$0()) "
+                        "{\n"
+                        "    batch->Add($1, $2, &value);\n"
+                        "  }\n",
+                        name, mode, field.number()));
+      } else if (field.has_presence()) {
+        absl::StrAppend(source,
+                        absl::Substitute("  if (message->has_$0()) {\n"
+                                         "    batch->Add($1, $2, "
+                                         "message->mutable_$0());\n"
+                                         "  }\n",
+                                         name, mode, field.number()));
+      } else {
+        absl::StrAppend(
+            source, absl::Substitute(
+                        "  batch->Add($1, $2, message->mutable_$0());\n",
+                        name, mode, field.number()));
+      }
+    } else if (IsSubMessageOf(field, *message.file()) &&
+               encrypted.contains(field.message_type())) {
+      if (field.is_repeated()) {
+        absl::StrAppend(
+            source,
+            absl::Substitute("  for (auto& value : *message->mutable_$0()) {\n"
+                             "    CollectTinkFields(&value, batch);\n"
+                             "  }\n",
+                             name));
+      } else {
+        absl::StrAppend(
+            source,
+            absl::Substitute("  if (message->has_$0()) {\n"
+                             "    CollectTinkFields(message->mutable_$0(), "
+                             "batch);\n"
+                             "  }\n",
+                             name));
+      }
+    }
+  }
+  absl::StrAppend(source, "}\n\n");
+}
+
+}  // namespace
+
+std::string TinkFieldsHeaderName(const FileDescriptor& file) {
+  return absl::StrCat(BaseName(file), ".tink_fields.h");
+}
+
+std::string TinkFieldsSourceName(const FileDescriptor& file) {
+  return absl::StrCat(BaseName(file), ".tink_fields.cc");
+}
+
+util::Status GenerateTinkFields(const FileDescriptor& file,
+                                std::string* header, std::string* source) {
+  std::vector<const Descriptor*> messages;
+  for (int i = 0; i < file.message_type_count(); ++i) {
+    CollectMessages(*file.message_type(i), &messages);
+  }
+
+  // A message is encrypted if it has annotated fields, or sub-messages
+  // which are encrypted.
+  absl::flat_hash_set<const Descriptor*> encrypted;
+  for (const Descriptor* message : messages) {
+    for (int i = 0; i < message->field_count(); ++i) {
+      const FieldDescriptor& field = *message->field(i);
+      if (!IsAnnotated(field)) continue;
+      if (field.type() != FieldDescriptor::TYPE_BYTES) {
+        return util::Status(
+            util::error::INVALID_ARGUMENT,
+            absl::StrCat("Field ", field.full_name(),
+                         " is annotated with tink_field_encryption, but only "
+                         "bytes fields can be encrypted"));
+      }
+      encrypted.insert(message);
+    }
+  }
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (const Descriptor* message : messages) {
+      if (encrypted.contains(message)) continue;
+      for (int i = 0; i < message->field_count(); ++i) {
+        const FieldDescriptor& field = *message->field(i);
+        if (IsSubMessageOf(field, file) &&
+            encrypted.contains(field.message_type())) {
+          encrypted.insert(message);
+          changed = true;
+          break;
+        }
+      }
+    }
+  }
+  // In the order of the file.
+  std::vector<const Descriptor*> encrypted_messages;
+  for (const Descriptor* message : messages) {
+    if (encrypted.contains(message)) encrypted_messages.push_back(message);
+  }
+
+  std::vector<std::string> namespaces;
+  if (!file.package().empty()) {
+    namespaces = absl::StrSplit(file.package(), '.');
+  }
+  std::string namespace_begin;
+  std::string namespace_end;
+  for (const std::string& name : namespaces) {
+    absl::StrAppend(&namespace_begin, "namespace ", name, " {\n");
+    namespace_end.insert(0, absl::StrCat("}  // namespace ", name, "\n"));
+  }
+  std::string guard = absl::AsciiStrToUpper(TinkFieldsHeaderName(file));
+  for (char& c : guard) {
+    if (!absl::ascii_isalnum(c)) c = '_';
+  }
+  absl::StrAppend(&guard, "_");
+
+  *header = absl::StrCat(
+      "// Generated by protoc-gen-tink_fields.  DO NOT EDIT!\n"
+      "// source: ",
+      file.name(),
+      "\n\n"
+      "#ifndef ",
+      guard, "\n#define ", guard,
+      "\n\n"
+      "#include \"absl/strings/string_view.h\"\n"
+      "#include \"",
+      BaseName(file),
+      ".pb.h\"\n"
+      "#include \"tink/fieldenc/field_encryption.h\"\n"
+      "#include \"tink/util/status.h\"\n\n",
+      namespace_begin, "\n");
+  for (const Descriptor* message : encrypted_messages) {
+    std::string parameters =
+        absl::Substitute(kPrimitivesParameter, ClassName(*message));
+    absl::StrAppend(header, "// Encrypts the annotated fields of '*message'.\n",
+                    "crypto::tink::util::Status EncryptTinkFields(\n",
+                    parameters, ";\n",
+                    "// Decrypts the annotated fields of '*message'.\n",
+                    "crypto::tink::util::Status DecryptTinkFields(\n",
+                    parameters, ";\n\n");
+  }
+  absl::StrAppend(header, namespace_end, "\n#endif  // ", guard, "\n");
+
+  *source = absl::StrCat(
+      "// Generated by protoc-gen-tink_fields.  DO NOT EDIT!\n"
+      "// source: ",
+      file.name(),
+      "\n\n"
+      "#include \"",
+      TinkFieldsHeaderName(file),
+      "\"\n\n"
+      "#include <string>\n\n"
+      "#include \"absl/strings/string_view.h\"\n"
+      "#include \"tink/fieldenc/field_encryption.h\"\n"
+      "#include \"tink/util/status.h\"\n\n",
+      namespace_begin, "\nnamespace {\n\n");
+  // Declared first, as sub-messages may refer to each other.
+  for (const Descriptor* message : encrypted_messages) {
+    absl::StrAppend(source, "void CollectTinkFields(", ClassName(*message),
+                    "* message,\n"
+                    "                       "
+                    "crypto::tink::fieldenc::FieldBatch* batch);\n");
+  }
+  absl::StrAppend(source, "\n");
+  for (const Descriptor* message : encrypted_messages) {
+    AppendCollect(*message, encrypted, source);
+  }
+  absl::StrAppend(source, "}  // namespace\n\n");
+  for (const Descriptor* message : encrypted_messages) {
+    std::string parameters =
+        absl::Substitute(kPrimitivesParameter, ClassName(*message));
+    for (absl::string_view operation : {"Encrypt", "Decrypt"}) {
+      absl::StrAppend(source, "crypto::tink::util::Status ", operation,
+                      "TinkFields(\n", parameters,
+                      " {\n"
+                      "  crypto::tink::fieldenc::FieldBatch batch;\n"
+                      "  CollectTinkFields(message, &batch);\n"
+                      "  return batch.",
+                      operation,
+                      "(primitives, associated_data);\n"
+                      "}\n\n");
+    }
+  }
+  absl::StrAppend(source, namespace_end);
+  return util::Status::OK;
+}
+
+}  // namespace fieldenc
+}  // namespace tink
+}  // namespace crypto
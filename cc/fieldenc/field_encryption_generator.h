@@ -0,0 +1,50 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_FIELDENC_FIELD_ENCRYPTION_GENERATOR_H_
+#define TINK_FIELDENC_FIELD_ENCRYPTION_GENERATOR_H_
+
+#include <string>
+
+#include "google/protobuf/descriptor.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace fieldenc {
+
+// Returns the names of the header and the source file which
+// protoc-gen-tink_fields generates for 'file', e.g. "a/b.tink_fields.h"
+// and "a/b.tink_fields.cc" for "a/b.proto".
+std::string TinkFieldsHeaderName(const google::protobuf::FileDescriptor& file);
+std::string TinkFieldsSourceName(const google::protobuf::FileDescriptor& file);
+
+// Generates the contents of the header and the source file of 'file', as
+// described in field_encryption.h, into '*header' and '*source'.  Fields
+// annotated with UNKNOWN_FIELD_ENCRYPTION are not encrypted.  Fails if an
+// annotated field is not a bytes field.
+//
+// Sub-messages are only followed if their type is defined in 'file'; the
+// annotated fields of other files' messages are left to the caller.
+crypto::tink::util::Status GenerateTinkFields(
+    const google::protobuf::FileDescriptor& file, std::string* header,
+    std::string* source);
+
+}  // namespace fieldenc
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_FIELDENC_FIELD_ENCRYPTION_GENERATOR_H_
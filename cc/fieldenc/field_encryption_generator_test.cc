@@ -0,0 +1,180 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/fieldenc/field_encryption_generator.h"
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/descriptor.pb.h"
+#include "tink/util/test_matchers.h"
+#include "proto/field_encryption.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace fieldenc {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::FieldEncryptionMode;
+using ::google::protobuf::DescriptorPool;
+using ::google::protobuf::DescriptorProto;
+using ::google::protobuf::FieldDescriptorProto;
+using ::google::protobuf::FileDescriptor;
+using ::google::protobuf::FileDescriptorProto;
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+FieldDescriptorProto* AddField(DescriptorProto* message,
+                               const std::string& name, int number,
+                               FieldDescriptorProto::Type type,
+                               FieldDescriptorProto::Label label =
+                                   FieldDescriptorProto::LABEL_OPTIONAL) {
+  FieldDescriptorProto* field = message->add_field();
+  field->set_name(name);
+  field->set_number(number);
+  field->set_type(type);
+  field->set_label(label);
+  return field;
+}
+
+void Annotate(FieldDescriptorProto* field, FieldEncryptionMode mode) {
+  field->mutable_options()->SetExtension(
+      google::crypto::tink::tink_field_encryption, mode);
+}
+
+// example/user.proto, in proto3:
+//
+//   message Address {
+//     bytes street = 1 [(tink_field_encryption) = RANDOMIZED];
+//   }
+//   message User {
+//     string id = 1;
+//     bytes email = 2 [(tink_field_encryption) = DETERMINISTIC];
+//     repeated bytes notes = 3 [(tink_field_encryption) = RANDOMIZED];
+//     Address address = 4;
+//     message Contact { Address address = 1; }
+//     repeated Contact contacts = 5;
+//   }
+//   message Plain { bytes data = 1; }
+FileDescriptorProto UserFile() {
+  FileDescriptorProto file;
+  file.set_name("example/user.proto");
+  file.set_package("example.users");
+  file.set_syntax("proto3");
+
+  DescriptorProto* address = file.add_message_type();
+  address->set_name("Address");
+  Annotate(AddField(address, "street", 1, FieldDescriptorProto::TYPE_BYTES),
+           google::crypto::tink::RANDOMIZED);
+
+  DescriptorProto* user = file.add_message_type();
+  user->set_name("User");
+  AddField(user, "id", 1, FieldDescriptorProto::TYPE_STRING);
+  Annotate(AddField(user, "email", 2, FieldDescriptorProto::TYPE_BYTES),
+           google::crypto::tink::DETERMINISTIC);
+  Annotate(AddField(user, "notes", 3, FieldDescriptorProto::TYPE_BYTES,
+                    FieldDescriptorProto::LABEL_REPEATED),
+           google::crypto::tink::RANDOMIZED);
+  AddField(user, "address", 4, FieldDescriptorProto::TYPE_MESSAGE)
+      ->set_type_name(".example.users.Address");
+  DescriptorProto* contact = user->add_nested_type();
+  contact->set_name("Contact");
+  AddField(contact, "address", 1, FieldDescriptorProto::TYPE_MESSAGE)
+      ->set_type_name(".example.users.Address");
+  AddField(user, "contacts", 5, FieldDescriptorProto::TYPE_MESSAGE,
+           FieldDescriptorProto::LABEL_REPEATED)
+      ->set_type_name(".example.users.User.Contact");
+
+  DescriptorProto* plain = file.add_message_type();
+  plain->set_name("Plain");
+  AddField(plain, "data", 1, FieldDescriptorProto::TYPE_BYTES);
+  return file;
+}
+
+TEST(FieldEncryptionGeneratorTest, Names) {
+  DescriptorPool pool;
+  const FileDescriptor* file = pool.BuildFile(UserFile());
+  ASSERT_NE(nullptr, file);
+  EXPECT_EQ("example/user.tink_fields.h", TinkFieldsHeaderName(*file));
+  EXPECT_EQ("example/user.tink_fields.cc", TinkFieldsSourceName(*file));
+}
+
+TEST(FieldEncryptionGeneratorTest, Generate) {
+  DescriptorPool pool;
+  const FileDescriptor* file = pool.BuildFile(UserFile());
+  ASSERT_NE(nullptr, file);
+  std::string header;
+  std::string source;
+  ASSERT_THAT(GenerateTinkFields(*file, &header, &source), IsOk());
+
+  EXPECT_THAT(header, HasSubstr("#ifndef EXAMPLE_USER_TINK_FIELDS_H_\n"));
+  EXPECT_THAT(header, HasSubstr("#include \"example/user.pb.h\"\n"));
+  EXPECT_THAT(header, HasSubstr("namespace example {\nnamespace users {\n"));
+  EXPECT_THAT(header, HasSubstr("absl::string_view associated_data, "
+                                "Address* message);"));
+  EXPECT_THAT(header, HasSubstr("User* message);"));
+  EXPECT_THAT(header, HasSubstr("User_Contact* message);"));
+  EXPECT_THAT(header, Not(HasSubstr("Plain")));
+
+  EXPECT_THAT(source, HasSubstr("#include \"example/user.tink_fields.h\""));
+  EXPECT_THAT(
+      source,
+      HasSubstr("  batch->Add("
+                "crypto::tink::fieldenc::FieldEncryptionMode::kRandomized, "
+                "1, message->mutable_street());\n"));
+  EXPECT_THAT(
+      source,
+      HasSubstr("  batch->Add("
+                "crypto::tink::fieldenc::FieldEncryptionMode::kDeterministic, "
+                "2, message->mutable_email());\n"));
+  EXPECT_THAT(source,
+              HasSubstr("  for (std::string& value : "
+                        "*message->mutable_notes()) {\n"));
+  EXPECT_THAT(source, HasSubstr("  if (message->has_address()) {\n"
+                                "    CollectTinkFields("
+                                "message->mutable_address(), batch);\n"));
+  EXPECT_THAT(source,
+              HasSubstr("  for (auto& value : *message->mutable_contacts()) "
+                        "{\n    CollectTinkFields(&value, batch);\n"));
+  EXPECT_THAT(source, Not(HasSubstr("mutable_id()")));
+  EXPECT_THAT(source, Not(HasSubstr("Plain")));
+}
+
+TEST(FieldEncryptionGeneratorTest, OnlyBytesFields) {
+  FileDescriptorProto file_proto;
+  file_proto.set_name("bad.proto");
+  file_proto.set_syntax("proto3");
+  DescriptorProto* message = file_proto.add_message_type();
+  message->set_name("Bad");
+  Annotate(AddField(message, "name", 1, FieldDescriptorProto::TYPE_STRING),
+           google::crypto::tink::RANDOMIZED);
+  DescriptorPool pool;
+  const FileDescriptor* file = pool.BuildFile(file_proto);
+  ASSERT_NE(nullptr, file);
+  std::string header;
+  std::string source;
+  EXPECT_THAT(GenerateTinkFields(*file, &header, &source),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace fieldenc
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,143 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/fieldenc/field_encryption.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/aes_siv_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace fieldenc {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Not;
+
+class FieldBatchTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto aead_result = subtle::AesGcmBoringSsl::New(
+        util::SecretDataFromStringView(subtle::Random::GetRandomBytes(16)));
+    ASSERT_THAT(aead_result.status(), IsOk());
+    aead_ = std::move(aead_result.ValueOrDie());
+    auto daead_result = subtle::AesSivBoringSsl::New(
+        util::SecretDataFromStringView(subtle::Random::GetRandomBytes(64)));
+    ASSERT_THAT(daead_result.status(), IsOk());
+    daead_ = std::move(daead_result.ValueOrDie());
+    primitives_.aead = aead_.get();
+    primitives_.deterministic_aead = daead_.get();
+  }
+
+  std::unique_ptr<Aead> aead_;
+  std::unique_ptr<DeterministicAead> daead_;
+  FieldEncryptionPrimitives primitives_;
+};
+
+TEST_F(FieldBatchTest, EncryptDecrypt) {
+  std::string name = "Alice";
+  std::string email = "alice@example.com";
+  std::string other_email = "alice@example.com";
+  std::string empty;
+
+  FieldBatch encrypt_batch;
+  encrypt_batch.Add(FieldEncryptionMode::kRandomized, 1, &name);
+  encrypt_batch.Add(FieldEncryptionMode::kDeterministic, 2, &email);
+  encrypt_batch.Add(FieldEncryptionMode::kDeterministic, 3, &other_email);
+  encrypt_batch.Add(FieldEncryptionMode::kRandomized, 4, &empty);
+  ASSERT_THAT(encrypt_batch.Encrypt(primitives_, "ad"), IsOk());
+  EXPECT_NE("Alice", name);
+  EXPECT_NE("alice@example.com", email);
+  // Deterministic fields share the associated data.
+  EXPECT_EQ(email, other_email);
+  EXPECT_FALSE(empty.empty());
+
+  FieldBatch decrypt_batch;
+  decrypt_batch.Add(FieldEncryptionMode::kRandomized, 1, &name);
+  decrypt_batch.Add(FieldEncryptionMode::kDeterministic, 2, &email);
+  decrypt_batch.Add(FieldEncryptionMode::kDeterministic, 3, &other_email);
+  decrypt_batch.Add(FieldEncryptionMode::kRandomized, 4, &empty);
+  ASSERT_THAT(decrypt_batch.Decrypt(primitives_, "ad"), IsOk());
+  EXPECT_EQ("Alice", name);
+  EXPECT_EQ("alice@example.com", email);
+  EXPECT_EQ("alice@example.com", other_email);
+  EXPECT_EQ("", empty);
+}
+
+TEST_F(FieldBatchTest, RandomizedFieldsAreBoundToTheirNumber) {
+  std::string value = "secret";
+  FieldBatch encrypt_batch;
+  encrypt_batch.Add(FieldEncryptionMode::kRandomized, 1, &value);
+  ASSERT_THAT(encrypt_batch.Encrypt(primitives_, "ad"), IsOk());
+
+  FieldBatch other_number;
+  other_number.Add(FieldEncryptionMode::kRandomized, 2, &value);
+  EXPECT_THAT(other_number.Decrypt(primitives_, "ad"), Not(IsOk()));
+  FieldBatch other_associated_data;
+  other_associated_data.Add(FieldEncryptionMode::kRandomized, 1, &value);
+  EXPECT_THAT(other_associated_data.Decrypt(primitives_, "other"),
+              Not(IsOk()));
+}
+
+TEST_F(FieldBatchTest, FailureLeavesAllFieldsUnchanged) {
+  std::string first = "first";
+  std::string second = "second";
+  FieldBatch encrypt_batch;
+  encrypt_batch.Add(FieldEncryptionMode::kRandomized, 1, &first);
+  encrypt_batch.Add(FieldEncryptionMode::kDeterministic, 2, &second);
+  ASSERT_THAT(encrypt_batch.Encrypt(primitives_, "ad"), IsOk());
+
+  second[0] ^= 1;
+  const std::string encrypted_first = first;
+  const std::string encrypted_second = second;
+  FieldBatch decrypt_batch;
+  decrypt_batch.Add(FieldEncryptionMode::kRandomized, 1, &first);
+  decrypt_batch.Add(FieldEncryptionMode::kDeterministic, 2, &second);
+  EXPECT_THAT(decrypt_batch.Decrypt(primitives_, "ad"), Not(IsOk()));
+  EXPECT_EQ(encrypted_first, first);
+  EXPECT_EQ(encrypted_second, second);
+}
+
+TEST_F(FieldBatchTest, MissingPrimitive) {
+  std::string value = "value";
+  FieldBatch randomized;
+  randomized.Add(FieldEncryptionMode::kRandomized, 1, &value);
+  FieldBatch deterministic;
+  deterministic.Add(FieldEncryptionMode::kDeterministic, 1, &value);
+  FieldEncryptionPrimitives none;
+  EXPECT_THAT(randomized.Encrypt(none, "ad"),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(deterministic.Encrypt(none, "ad"),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_EQ("value", value);
+
+  // An empty batch needs no primitive.
+  EXPECT_THAT(FieldBatch().Encrypt(none, "ad"), IsOk());
+}
+
+}  // namespace
+}  // namespace fieldenc
+}  // namespace tink
+}  // namespace crypto
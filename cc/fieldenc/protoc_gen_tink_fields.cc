@@ -0,0 +1,90 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// protoc plugin which generates the encryption functions of the fields
+// annotated with (google.crypto.tink.tink_field_encryption), see
+// field_encryption.h.  Usage:
+//
+//   protoc --plugin=protoc-gen-tink_fields=<path> --tink_fields_out=<dir> \
+//       a/b.proto
+//
+// writes <dir>/a/b.tink_fields.h and <dir>/a/b.tink_fields.cc, which are
+// compiled with the output of --cpp_out.
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "google/protobuf/compiler/code_generator.h"
+#include "google/protobuf/compiler/plugin.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/io/zero_copy_stream.h"
+#include "tink/fieldenc/field_encryption_generator.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace fieldenc {
+namespace {
+
+class TinkFieldsGenerator : public google::protobuf::compiler::CodeGenerator {
+ public:
+  bool Generate(const google::protobuf::FileDescriptor* file,
+                const std::string& parameter,
+                google::protobuf::compiler::GeneratorContext* context,
+                std::string* error) const override {
+    std::string header;
+    std::string source;
+    util::Status status = GenerateTinkFields(*file, &header, &source);
+    if (!status.ok()) {
+      *error = status.error_message();
+      return false;
+    }
+    return Write(TinkFieldsHeaderName(*file), header, context) &&
+           Write(TinkFieldsSourceName(*file), source, context);
+  }
+
+ private:
+  static bool Write(const std::string& name, const std::string& contents,
+                    google::protobuf::compiler::GeneratorContext* context) {
+    std::unique_ptr<google::protobuf::io::ZeroCopyOutputStream> output(
+        context->Open(name));
+    size_t written = 0;
+    while (written < contents.size()) {
+      void* buffer;
+      int size;
+      if (!output->Next(&buffer, &size)) return false;
+      size_t chunk = std::min<size_t>(size, contents.size() - written);
+      memcpy(buffer, contents.data() + written, chunk);
+      written += chunk;
+      if (chunk < static_cast<size_t>(size)) {
+        output->BackUp(size - chunk);
+      }
+    }
+    return true;
+  }
+};
+
+}  // namespace
+}  // namespace fieldenc
+}  // namespace tink
+}  // namespace crypto
+
+int main(int argc, char** argv) {
+  crypto::tink::fieldenc::TinkFieldsGenerator generator;
+  return google::protobuf::compiler::PluginMain(argc, argv, &generator);
+}
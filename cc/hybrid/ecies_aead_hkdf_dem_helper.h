@@ -21,8 +21,7 @@
 
 #include "tink/aead.h"
 #include "tink/daead/subtle/aead_or_daead.h"
-#include "tink/key_manager.h"
-#include "tink/util/protobuf_helper.h"
+#include "tink/subtle/common_enums.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
@@ -31,9 +30,15 @@ namespace crypto {
 namespace tink {
 
 // A helper for DEM (data encapsulation mechanism) of ECIES-AEAD-HKDF.
+//
+// The DEM key template is parsed once, in New(); GetAeadOrDaead() then builds
+// the DEM primitive directly from the key bytes, without going through the
+// key protos and the key manager of the DEM key type.
 class EciesAeadHkdfDemHelper {
  public:
-  // Constructs a new helper for the specified DEM key template.
+  // Constructs a new helper for the specified DEM key template.  Fails if no
+  // key manager for the DEM key type is registered, or if the template is
+  // not valid for it.
   static
   crypto::tink::util::StatusOr<std::unique_ptr<const EciesAeadHkdfDemHelper>>
       New(const google::crypto::tink::KeyTemplate& dem_key_template);
@@ -50,7 +55,7 @@ class EciesAeadHkdfDemHelper {
   // be of length dem_key_size_in_bytes().
   virtual crypto::tink::util::StatusOr<
       std::unique_ptr<crypto::tink::subtle::AeadOrDaead>>
-  GetAeadOrDaead(const util::SecretData& symmetric_key_value) const = 0;
+  GetAeadOrDaead(const util::SecretData& symmetric_key_value) const;
 
  protected:
   enum DemKeyType {
@@ -63,22 +68,19 @@ class EciesAeadHkdfDemHelper {
   struct DemKeyParams {
     DemKeyType key_type;
     uint32_t key_size_in_bytes;
+    // Only set for AES_CTR_HMAC_AEAD_KEY.
     uint32_t aes_ctr_key_size_in_bytes;
+    int aes_ctr_iv_size_in_bytes;
+    subtle::HashType hmac_hash_type;
+    uint32_t hmac_tag_size_in_bytes;
   };
 
-  EciesAeadHkdfDemHelper(const google::crypto::tink::KeyTemplate& key_template,
-                         DemKeyParams key_params)
-      : key_template_(key_template), key_params_(key_params) {}
+  explicit EciesAeadHkdfDemHelper(DemKeyParams key_params)
+      : key_params_(key_params) {}
 
   static util::StatusOr<DemKeyParams> GetKeyParams(
       const ::google::crypto::tink::KeyTemplate& key_template);
 
-  bool ReplaceKeyBytes(const util::SecretData& key_bytes,
-                       portable_proto::MessageLite* proto) const;
-
-  void ZeroKeyBytes(portable_proto::MessageLite* proto) const;
-
-  const google::crypto::tink::KeyTemplate key_template_;
   const DemKeyParams key_params_;
 };
 
@@ -16,12 +16,19 @@
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "tink/aead.h"
+#include "tink/aead/aead_key_templates.h"
+#include "tink/aead/aes_ctr_hmac_aead_key_manager.h"
 #include "tink/aead/aes_gcm_key_manager.h"
+#include "tink/aead/xchacha20_poly1305_key_manager.h"
 #include "tink/daead/aes_siv_key_manager.h"
 #include "tink/registry.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/test_matchers.h"
 #include "tink/util/test_util.h"
+#include "proto/aes_ctr_hmac_aead.pb.h"
+#include "proto/xchacha20_poly1305.pb.h"
 
 namespace crypto {
 namespace tink {
@@ -31,6 +38,8 @@ using ::crypto::tink::subtle::AeadOrDaead;
 using ::crypto::tink::test::IsOk;
 using ::crypto::tink::test::StatusIs;
 using ::crypto::tink::util::StatusOr;
+using ::google::crypto::tink::AesCtrHmacAeadKey;
+using ::google::crypto::tink::XChaCha20Poly1305Key;
 using ::testing::HasSubstr;
 
 // Checks whether Decrypt(Encrypt(message)) == message with the given dem.
@@ -113,6 +122,90 @@ TEST(EciesAeadHkdfDemHelperTest, DemHelperWithSomeDeterministicAeadKeyType) {
               IsOk());
 }
 
+TEST(EciesAeadHkdfDemHelperTest, InvalidKeyFormat) {
+  ASSERT_THAT(Registry::RegisterKeyTypeManager(
+                  absl::make_unique<AesGcmKeyManager>(), true),
+              IsOk());
+  google::crypto::tink::AesGcmKeyFormat key_format;
+  key_format.set_key_size(17);
+  google::crypto::tink::KeyTemplate dem_key_template;
+  dem_key_template.set_type_url(AesGcmKeyManager().get_key_type());
+  dem_key_template.set_value(key_format.SerializeAsString());
+  EXPECT_THAT(EciesAeadHkdfDemHelper::New(dem_key_template).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(EciesAeadHkdfDemHelperTest, AesCtrHmacAeadMatchesKeyManager) {
+  ASSERT_THAT(Registry::RegisterKeyTypeManager(
+                  absl::make_unique<AesCtrHmacAeadKeyManager>(), true),
+              IsOk());
+  const google::crypto::tink::KeyTemplate& dem_key_template =
+      AeadKeyTemplates::Aes128CtrHmacSha256();
+  auto dem_helper_or = EciesAeadHkdfDemHelper::New(dem_key_template);
+  ASSERT_THAT(dem_helper_or.status(), IsOk());
+  auto dem_helper = std::move(dem_helper_or.ValueOrDie());
+  ASSERT_EQ(dem_helper->dem_key_size_in_bytes(), 48);
+
+  std::string key_bytes = test::HexDecodeOrDie(
+      "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+      "202122232425262728292a2b2c2d2e2f");
+  auto aead_or_daead_or =
+      dem_helper->GetAeadOrDaead(util::SecretDataFromStringView(key_bytes));
+  ASSERT_THAT(aead_or_daead_or.status(), IsOk());
+  auto aead_or_daead = std::move(aead_or_daead_or.ValueOrDie());
+  EXPECT_THAT(EncryptThenDecrypt(*aead_or_daead, "test_plaintext", "test_ad"),
+              IsOk());
+
+  // The DEM is compatible with the primitive of the key manager.
+  google::crypto::tink::AesCtrHmacAeadKeyFormat key_format;
+  ASSERT_TRUE(key_format.ParseFromString(dem_key_template.value()));
+  AesCtrHmacAeadKey key;
+  key.mutable_aes_ctr_key()->set_key_value(key_bytes.substr(0, 16));
+  *key.mutable_aes_ctr_key()->mutable_params() =
+      key_format.aes_ctr_key_format().params();
+  key.mutable_hmac_key()->set_key_value(key_bytes.substr(16));
+  *key.mutable_hmac_key()->mutable_params() =
+      key_format.hmac_key_format().params();
+  auto aead = AesCtrHmacAeadKeyManager().GetPrimitive<Aead>(key).ValueOrDie();
+  std::string ciphertext =
+      aead_or_daead->Encrypt("test_plaintext", "test_ad").ValueOrDie();
+  auto plaintext_or = aead->Decrypt(ciphertext, "test_ad");
+  ASSERT_THAT(plaintext_or.status(), IsOk());
+  EXPECT_EQ(plaintext_or.ValueOrDie(), "test_plaintext");
+}
+
+TEST(EciesAeadHkdfDemHelperTest, XChaCha20Poly1305MatchesKeyManager) {
+  ASSERT_THAT(Registry::RegisterKeyTypeManager(
+                  absl::make_unique<XChaCha20Poly1305KeyManager>(), true),
+              IsOk());
+  auto dem_helper_or =
+      EciesAeadHkdfDemHelper::New(AeadKeyTemplates::XChaCha20Poly1305());
+  ASSERT_THAT(dem_helper_or.status(), IsOk());
+  auto dem_helper = std::move(dem_helper_or.ValueOrDie());
+  ASSERT_EQ(dem_helper->dem_key_size_in_bytes(), 32);
+
+  std::string key_bytes = test::HexDecodeOrDie(
+      "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f");
+  auto aead_or_daead_or =
+      dem_helper->GetAeadOrDaead(util::SecretDataFromStringView(key_bytes));
+  ASSERT_THAT(aead_or_daead_or.status(), IsOk());
+  auto aead_or_daead = std::move(aead_or_daead_or.ValueOrDie());
+
+  XChaCha20Poly1305Key key;
+  key.set_key_value(key_bytes);
+  auto aead =
+      XChaCha20Poly1305KeyManager().GetPrimitive<Aead>(key).ValueOrDie();
+  std::string ciphertext =
+      aead_or_daead->Encrypt("test_plaintext", "test_ad").ValueOrDie();
+  auto plaintext_or = aead->Decrypt(ciphertext, "test_ad");
+  ASSERT_THAT(plaintext_or.status(), IsOk());
+  EXPECT_EQ(plaintext_or.ValueOrDie(), "test_plaintext");
+
+  // Keys of the wrong length are rejected.
+  EXPECT_THAT(dem_helper->GetAeadOrDaead(util::SecretData(16, 0)).status(),
+              StatusIs(util::error::INTERNAL));
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
@@ -16,7 +16,9 @@
 
 #include "tink/hybrid/ecies_aead_hkdf_hybrid_decrypt.h"
 
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "tink/hybrid/ecies_aead_hkdf_dem_helper.h"
@@ -63,6 +65,12 @@ util::Status Validate(const EciesAeadHkdfPrivateKey& key) {
 // static
 util::StatusOr<std::unique_ptr<HybridDecrypt>> EciesAeadHkdfHybridDecrypt::New(
     const EciesAeadHkdfPrivateKey& recipient_key) {
+  return New(recipient_key, /*parallelism=*/1);
+}
+
+// static
+util::StatusOr<std::unique_ptr<HybridDecrypt>> EciesAeadHkdfHybridDecrypt::New(
+    const EciesAeadHkdfPrivateKey& recipient_key, int parallelism) {
   util::Status status = Validate(recipient_key);
   if (!status.ok()) return status;
 
@@ -78,7 +86,7 @@ util::StatusOr<std::unique_ptr<HybridDecrypt>> EciesAeadHkdfHybridDecrypt::New(
 
   return {absl::WrapUnique(new EciesAeadHkdfHybridDecrypt(
       recipient_key.public_key().params(), std::move(kem_result).ValueOrDie(),
-      std::move(dem_result).ValueOrDie()))};
+      std::move(dem_result).ValueOrDie(), parallelism))};
 }
 
 util::StatusOr<std::string> EciesAeadHkdfHybridDecrypt::Decrypt(
@@ -118,5 +126,29 @@ util::StatusOr<std::string> EciesAeadHkdfHybridDecrypt::Decrypt(
   return decrypt_result.ValueOrDie();
 }
 
+util::StatusOr<std::vector<std::string>>
+EciesAeadHkdfHybridDecrypt::DecryptBatch(
+    absl::Span<const absl::string_view> ciphertexts,
+    absl::string_view context_info) const {
+  // Decrypt() only reads the recipient key, so the ciphertexts, and in
+  // particular their ECDH computations, are processed concurrently.
+  std::vector<util::StatusOr<std::string>> results(ciphertexts.size());
+  auto decrypt_item = [&](int i) {
+    results[i] = Decrypt(ciphertexts[i], context_info);
+  };
+  if (thread_pool_ == nullptr) {
+    for (int i = 0; i < ciphertexts.size(); i++) decrypt_item(i);
+  } else {
+    thread_pool_->ParallelFor(ciphertexts.size(), decrypt_item);
+  }
+  std::vector<std::string> plaintexts;
+  plaintexts.reserve(results.size());
+  for (auto& result : results) {
+    if (!result.ok()) return result.status();
+    plaintexts.push_back(std::move(result.ValueOrDie()));
+  }
+  return std::move(plaintexts);
+}
+
 }  // namespace tink
 }  // namespace crypto
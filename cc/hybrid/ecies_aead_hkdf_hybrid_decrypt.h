@@ -18,10 +18,15 @@
 #define TINK_HYBRID_ECIES_AEAD_HKDF_HYBRID_DECRYPT_H_
 
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
+#include "absl/memory/memory.h"
+#include "absl/types/span.h"
 #include "tink/hybrid/ecies_aead_hkdf_dem_helper.h"
 #include "tink/hybrid_decrypt.h"
+#include "tink/internal/thread_pool.h"
 #include "tink/subtle/ecies_hkdf_recipient_kem_boringssl.h"
 #include "tink/util/statusor.h"
 #include "proto/ecies_aead_hkdf.pb.h"
@@ -38,22 +43,39 @@ class EciesAeadHkdfHybridDecrypt : public HybridDecrypt {
   static crypto::tink::util::StatusOr<std::unique_ptr<HybridDecrypt>> New(
       const google::crypto::tink::EciesAeadHkdfPrivateKey& recipient_key);
 
+  // As above, but DecryptBatch() decrypts on up to 'parallelism' threads,
+  // the calling thread included.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HybridDecrypt>> New(
+      const google::crypto::tink::EciesAeadHkdfPrivateKey& recipient_key,
+      int parallelism);
+
   crypto::tink::util::StatusOr<std::string> Decrypt(
       absl::string_view ciphertext,
       absl::string_view context_info) const override;
 
+  crypto::tink::util::StatusOr<std::vector<std::string>> DecryptBatch(
+      absl::Span<const absl::string_view> ciphertexts,
+      absl::string_view context_info) const override;
+
  private:
   EciesAeadHkdfHybridDecrypt(
       google::crypto::tink::EciesAeadHkdfParams recipient_key_params,
       std::unique_ptr<const subtle::EciesHkdfRecipientKemBoringSsl> kem,
-      std::unique_ptr<const EciesAeadHkdfDemHelper> dem_helper)
+      std::unique_ptr<const EciesAeadHkdfDemHelper> dem_helper,
+      int parallelism)
       : recipient_key_params_(std::move(recipient_key_params)),
         recipient_kem_(std::move(kem)),
-        dem_helper_(std::move(dem_helper)) {}
+        dem_helper_(std::move(dem_helper)) {
+    if (parallelism > 1) {
+      thread_pool_ = absl::make_unique<internal::ThreadPool>(parallelism - 1);
+    }
+  }
 
   google::crypto::tink::EciesAeadHkdfParams recipient_key_params_;
   std::unique_ptr<const subtle::EciesHkdfRecipientKemBoringSsl> recipient_kem_;
   std::unique_ptr<const EciesAeadHkdfDemHelper> dem_helper_;
+  // Null if 'parallelism' is 1.
+  std::unique_ptr<internal::ThreadPool> thread_pool_;
 };
 
 }  // namespace tink
@@ -252,6 +252,41 @@ TEST_F(EciesAeadHkdfHybridDecryptTest, testAesGcmHybridDecryption) {
   EXPECT_EQ(i, 32 - 4);
 }
 
+TEST_F(EciesAeadHkdfHybridDecryptTest, testDecryptBatch) {
+  ASSERT_TRUE(Registry::RegisterKeyTypeManager(
+                  absl::make_unique<AesGcmKeyManager>(), true)
+                  .ok());
+  for (auto curve :
+       {EllipticCurveType::NIST_P256, EllipticCurveType::CURVE25519}) {
+    auto ecies_key = test::GetEciesAesGcmHkdfTestKey(
+        curve, EcPointFormat::COMPRESSED, HashType::SHA256, 16);
+    auto hybrid_encrypt =
+        EciesAeadHkdfHybridEncrypt::New(ecies_key.public_key()).ValueOrDie();
+    std::string context_info = "some context info";
+    std::vector<std::string> plaintexts;
+    std::vector<std::string> ciphertexts;
+    for (int i = 0; i < 10; i++) {
+      plaintexts.push_back(Random::GetRandomBytes(i));
+      ciphertexts.push_back(
+          hybrid_encrypt->Encrypt(plaintexts.back(), context_info)
+              .ValueOrDie());
+    }
+    std::vector<absl::string_view> ciphertext_views(ciphertexts.begin(),
+                                                    ciphertexts.end());
+
+    for (int parallelism : {1, 4}) {
+      auto hybrid_decrypt =
+          EciesAeadHkdfHybridDecrypt::New(ecies_key, parallelism)
+              .ValueOrDie();
+      EXPECT_THAT(hybrid_decrypt->DecryptBatch(ciphertext_views, context_info),
+                  IsOkAndHolds(Eq(plaintexts)));
+      EXPECT_FALSE(
+          hybrid_decrypt->DecryptBatch(ciphertext_views, "other context info")
+              .ok());
+    }
+  }
+}
+
 TEST_F(EciesAeadHkdfHybridDecryptTest, testAesCtrAeadHybridDecryption) {
   // Register DEM key manager.
   std::string dem_key_type = AesCtrHmacAeadKeyManager().get_key_type();
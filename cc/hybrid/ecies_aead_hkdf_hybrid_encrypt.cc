@@ -16,9 +16,13 @@
 
 #include "tink/hybrid/ecies_aead_hkdf_hybrid_encrypt.h"
 
+#include <memory>
+#include <utility>
+
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "tink/aead.h"
+#include "tink/subtle/ecies_ephemeral_key_pool.h"
 #include "tink/util/enums.h"
 #include "tink/util/status.h"
 #include "proto/ecies_aead_hkdf.pb.h"
@@ -59,13 +63,20 @@ util::Status Validate(const EciesAeadHkdfPublicKey& key) {
 // static
 util::StatusOr<std::unique_ptr<HybridEncrypt>> EciesAeadHkdfHybridEncrypt::New(
     const EciesAeadHkdfPublicKey& recipient_key) {
+  return New(recipient_key, nullptr);
+}
+
+// static
+util::StatusOr<std::unique_ptr<HybridEncrypt>> EciesAeadHkdfHybridEncrypt::New(
+    const EciesAeadHkdfPublicKey& recipient_key,
+    std::shared_ptr<subtle::EciesEphemeralKeyPool> key_pool) {
   util::Status status = Validate(recipient_key);
   if (!status.ok()) return status;
 
   auto kem_result = subtle::EciesHkdfSenderKemBoringSsl::New(
       util::Enums::ProtoToSubtle(
           recipient_key.params().kem_params().curve_type()),
-      recipient_key.x(), recipient_key.y());
+      recipient_key.x(), recipient_key.y(), std::move(key_pool));
   if (!kem_result.ok()) return kem_result.status();
 
   auto dem_result = EciesAeadHkdfDemHelper::New(
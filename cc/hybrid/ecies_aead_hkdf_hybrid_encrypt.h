@@ -21,6 +21,7 @@
 
 #include "tink/hybrid/ecies_aead_hkdf_dem_helper.h"
 #include "tink/hybrid_encrypt.h"
+#include "tink/subtle/ecies_ephemeral_key_pool.h"
 #include "tink/subtle/ecies_hkdf_sender_kem_boringssl.h"
 #include "tink/util/statusor.h"
 #include "proto/ecies_aead_hkdf.pb.h"
@@ -37,6 +38,14 @@ class EciesAeadHkdfHybridEncrypt : public HybridEncrypt {
   static crypto::tink::util::StatusOr<std::unique_ptr<HybridEncrypt>> New(
       const google::crypto::tink::EciesAeadHkdfPublicKey& recipient_key);
 
+  // As above, but the ephemeral KEM key pairs are taken from 'key_pool',
+  // which must be for the curve of 'recipient_key', so that Encrypt() does
+  // not have to generate them.  'key_pool' may be shared between
+  // primitives.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HybridEncrypt>> New(
+      const google::crypto::tink::EciesAeadHkdfPublicKey& recipient_key,
+      std::shared_ptr<subtle::EciesEphemeralKeyPool> key_pool);
+
   crypto::tink::util::StatusOr<std::string> Encrypt(
       absl::string_view plaintext,
       absl::string_view context_info) const override;
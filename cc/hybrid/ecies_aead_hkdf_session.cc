@@ -0,0 +1,212 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/ecies_aead_hkdf_session.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/ec_util.h"
+#include "tink/subtle/ecies_hkdf_recipient_kem_boringssl.h"
+#include "tink/subtle/ecies_hkdf_sender_kem_boringssl.h"
+#include "tink/subtle/prf/hkdf_prf.h"
+#include "tink/util/enums.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "proto/common.pb.h"
+#include "proto/ecies_aead_hkdf.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::util::Enums;
+using ::google::crypto::tink::EciesAeadHkdfParams;
+using ::google::crypto::tink::EciesAeadHkdfPrivateKey;
+using ::google::crypto::tink::EciesAeadHkdfPublicKey;
+using ::google::crypto::tink::EllipticCurveType;
+
+constexpr uint32_t kSessionSecretSizeInBytes = 32;
+constexpr char kSessionSalt[] = "ECIES session";
+constexpr int kMessageIndexSizeInBytes = 8;
+
+util::Status Validate(const EciesAeadHkdfPublicKey& key) {
+  if (key.x().empty() || !key.has_params()) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        "Invalid EciesAeadHkdfPublicKey: missing required fields.");
+  }
+  if (key.params().has_kem_params() &&
+      key.params().kem_params().curve_type() == EllipticCurveType::CURVE25519) {
+    if (!key.y().empty()) {
+      return util::Status(
+          util::error::INVALID_ARGUMENT,
+          "Invalid EciesAeadHkdfPublicKey: has unexpected field.");
+    }
+  } else if (key.y().empty()) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        "Invalid EciesAeadHkdfPublicKey: missing required fields.");
+  }
+  return util::OkStatus();
+}
+
+std::string EncodeMessageIndex(uint64_t message_index) {
+  std::string encoded(kMessageIndexSizeInBytes, '\0');
+  for (int i = kMessageIndexSizeInBytes - 1; i >= 0; i--) {
+    encoded[i] = static_cast<char>(message_index & 0xff);
+    message_index >>= 8;
+  }
+  return encoded;
+}
+
+// Returns the PRF which derives the DEM keys of the messages from the
+// session secret.
+util::StatusOr<std::unique_ptr<Prf>> NewDemKeyPrf(
+    const EciesAeadHkdfParams& params, const util::SecretData& session_secret) {
+  return subtle::HkdfPrf::New(
+      Enums::ProtoToSubtle(params.kem_params().hkdf_hash_type()),
+      session_secret, kSessionSalt);
+}
+
+// Returns the DEM of message 'encoded_message_index'.
+util::StatusOr<std::unique_ptr<subtle::AeadOrDaead>> GetDem(
+    const Prf& dem_key_prf, const EciesAeadHkdfDemHelper& dem_helper,
+    absl::string_view encoded_message_index) {
+  util::SecretData dem_key(dem_helper.dem_key_size_in_bytes());
+  std::vector<absl::string_view> inputs = {encoded_message_index};
+  util::Status status = dem_key_prf.ComputeBatch(
+      inputs, dem_key.size(), absl::MakeSpan(dem_key.data(), dem_key.size()));
+  if (!status.ok()) return status;
+  return dem_helper.GetAeadOrDaead(dem_key);
+}
+
+}  // namespace
+
+// static
+util::StatusOr<std::unique_ptr<EciesAeadHkdfSessionEncrypt>>
+EciesAeadHkdfSessionEncrypt::New(const EciesAeadHkdfPublicKey& recipient_key,
+                                 absl::string_view context_info) {
+  util::Status status = Validate(recipient_key);
+  if (!status.ok()) return status;
+  const EciesAeadHkdfParams& params = recipient_key.params();
+
+  auto dem_result =
+      EciesAeadHkdfDemHelper::New(params.dem_params().aead_dem());
+  if (!dem_result.ok()) return dem_result.status();
+
+  auto kem_result = subtle::EciesHkdfSenderKemBoringSsl::New(
+      Enums::ProtoToSubtle(params.kem_params().curve_type()),
+      recipient_key.x(), recipient_key.y());
+  if (!kem_result.ok()) return kem_result.status();
+  auto kem_key_result = kem_result.ValueOrDie()->GenerateKey(
+      Enums::ProtoToSubtle(params.kem_params().hkdf_hash_type()),
+      params.kem_params().hkdf_salt(), context_info,
+      kSessionSecretSizeInBytes,
+      Enums::ProtoToSubtle(params.ec_point_format()));
+  if (!kem_key_result.ok()) return kem_key_result.status();
+  auto kem_key = std::move(kem_key_result.ValueOrDie());
+
+  auto prf_result = NewDemKeyPrf(params, kem_key->get_symmetric_key());
+  if (!prf_result.ok()) return prf_result.status();
+
+  return {absl::WrapUnique(new EciesAeadHkdfSessionEncrypt(
+      kem_key->get_kem_bytes(), std::move(prf_result.ValueOrDie()),
+      std::move(dem_result.ValueOrDie())))};
+}
+
+util::StatusOr<std::string> EciesAeadHkdfSessionEncrypt::Encrypt(
+    absl::string_view plaintext) const {
+  uint64_t message_index =
+      next_message_index_.fetch_add(1, std::memory_order_relaxed);
+  std::string encoded_message_index = EncodeMessageIndex(message_index);
+
+  auto dem_result =
+      GetDem(*dem_key_prf_, *dem_helper_, encoded_message_index);
+  if (!dem_result.ok()) return dem_result.status();
+  auto encrypt_result =
+      dem_result.ValueOrDie()->Encrypt(plaintext, "");  // empty aad
+  if (!encrypt_result.ok()) return encrypt_result.status();
+
+  return absl::StrCat(encoded_message_index, encrypt_result.ValueOrDie());
+}
+
+// static
+util::StatusOr<std::unique_ptr<EciesAeadHkdfSessionDecrypt>>
+EciesAeadHkdfSessionDecrypt::New(const EciesAeadHkdfPrivateKey& recipient_key,
+                                 absl::string_view header,
+                                 absl::string_view context_info) {
+  util::Status status = Validate(recipient_key.public_key());
+  if (!status.ok()) return status;
+  if (recipient_key.key_value().empty()) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        "Invalid EciesAeadHkdfPrivateKey: missing required fields.");
+  }
+  const EciesAeadHkdfParams& params = recipient_key.public_key().params();
+
+  auto header_size_result = subtle::EcUtil::EncodingSizeInBytes(
+      Enums::ProtoToSubtle(params.kem_params().curve_type()),
+      Enums::ProtoToSubtle(params.ec_point_format()));
+  if (!header_size_result.ok()) return header_size_result.status();
+  if (header.size() != header_size_result.ValueOrDie()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid session header size");
+  }
+
+  auto dem_result =
+      EciesAeadHkdfDemHelper::New(params.dem_params().aead_dem());
+  if (!dem_result.ok()) return dem_result.status();
+
+  auto kem_result = subtle::EciesHkdfRecipientKemBoringSsl::New(
+      Enums::ProtoToSubtle(params.kem_params().curve_type()),
+      util::SecretDataFromStringView(recipient_key.key_value()));
+  if (!kem_result.ok()) return kem_result.status();
+  auto session_secret_result = kem_result.ValueOrDie()->GenerateKey(
+      header, Enums::ProtoToSubtle(params.kem_params().hkdf_hash_type()),
+      params.kem_params().hkdf_salt(), context_info,
+      kSessionSecretSizeInBytes,
+      Enums::ProtoToSubtle(params.ec_point_format()));
+  if (!session_secret_result.ok()) return session_secret_result.status();
+
+  auto prf_result = NewDemKeyPrf(params, session_secret_result.ValueOrDie());
+  if (!prf_result.ok()) return prf_result.status();
+
+  return {absl::WrapUnique(new EciesAeadHkdfSessionDecrypt(
+      std::move(prf_result.ValueOrDie()), std::move(dem_result.ValueOrDie())))};
+}
+
+util::StatusOr<std::string> EciesAeadHkdfSessionDecrypt::Decrypt(
+    absl::string_view ciphertext) const {
+  if (ciphertext.size() < kMessageIndexSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too short");
+  }
+  auto dem_result = GetDem(*dem_key_prf_, *dem_helper_,
+                           ciphertext.substr(0, kMessageIndexSizeInBytes));
+  if (!dem_result.ok()) return dem_result.status();
+  return dem_result.ValueOrDie()->Decrypt(
+      ciphertext.substr(kMessageIndexSizeInBytes), "");  // empty aad
+}
+
+}  // namespace tink
+}  // namespace crypto
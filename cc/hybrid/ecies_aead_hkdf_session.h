@@ -0,0 +1,112 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_HYBRID_ECIES_AEAD_HKDF_SESSION_H_
+#define TINK_HYBRID_ECIES_AEAD_HKDF_SESSION_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "tink/hybrid/ecies_aead_hkdf_dem_helper.h"
+#include "tink/prf/prf_set.h"
+#include "tink/util/statusor.h"
+#include "proto/ecies_aead_hkdf.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// Session-based ECIES-AEAD-HKDF, for encrypting many messages to the same
+// recipient.  The KEM (key encapsulation mechanism) runs once per session
+// rather than once per message, so the cost of the elliptic curve
+// operations is amortized over all messages of the session.
+//
+// Wire format:
+//   session header:  kem_bytes
+//   message:         message_index || dem_ciphertext
+// where 'kem_bytes' is the encoded ephemeral public key, as in the
+// ciphertexts of EciesAeadHkdfHybridEncrypt, and 'message_index' is an 8-byte
+// big-endian counter.  The KEM derives a 32-byte session secret from the
+// shared secret, using the HKDF parameters of the recipient key and the
+// context info of the session.  The DEM key of a message is
+//   HKDF(hash, ikm = session_secret, salt = "ECIES session",
+//        info = message_index)
+// with the HKDF hash of the recipient key, which must be SHA1, SHA256 or
+// SHA512.  The DEM uses empty associated data.
+//
+// The session header must be delivered to the recipient along with the
+// messages.  Each message can be decrypted independently of the others;
+// detecting dropped, replayed or reordered messages is left to the caller.
+class EciesAeadHkdfSessionEncrypt {
+ public:
+  // Starts a session to 'recipient_key', with the given context info.
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<EciesAeadHkdfSessionEncrypt>>
+  New(const google::crypto::tink::EciesAeadHkdfPublicKey& recipient_key,
+      absl::string_view context_info);
+
+  // Returns the session header.
+  const std::string& header() const { return header_; }
+
+  // Encrypts 'plaintext' as the next message of the session.  Safe to call
+  // concurrently.
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext) const;
+
+ private:
+  EciesAeadHkdfSessionEncrypt(
+      std::string header, std::unique_ptr<Prf> dem_key_prf,
+      std::unique_ptr<const EciesAeadHkdfDemHelper> dem_helper)
+      : header_(std::move(header)), dem_key_prf_(std::move(dem_key_prf)),
+        dem_helper_(std::move(dem_helper)) {}
+
+  const std::string header_;
+  const std::unique_ptr<Prf> dem_key_prf_;
+  const std::unique_ptr<const EciesAeadHkdfDemHelper> dem_helper_;
+  mutable std::atomic<uint64_t> next_message_index_{0};
+};
+
+// Decrypts the messages of a session started by EciesAeadHkdfSessionEncrypt.
+class EciesAeadHkdfSessionDecrypt {
+ public:
+  // Joins the session with the given header and context info.
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<EciesAeadHkdfSessionDecrypt>>
+  New(const google::crypto::tink::EciesAeadHkdfPrivateKey& recipient_key,
+      absl::string_view header, absl::string_view context_info);
+
+  // Decrypts a message of the session.
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext) const;
+
+ private:
+  EciesAeadHkdfSessionDecrypt(
+      std::unique_ptr<Prf> dem_key_prf,
+      std::unique_ptr<const EciesAeadHkdfDemHelper> dem_helper)
+      : dem_key_prf_(std::move(dem_key_prf)),
+        dem_helper_(std::move(dem_helper)) {}
+
+  const std::unique_ptr<Prf> dem_key_prf_;
+  const std::unique_ptr<const EciesAeadHkdfDemHelper> dem_helper_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_HYBRID_ECIES_AEAD_HKDF_SESSION_H_
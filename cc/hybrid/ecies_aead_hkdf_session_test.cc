@@ -0,0 +1,171 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/ecies_aead_hkdf_session.h"
+
+#include <set>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/aead/aes_gcm_key_manager.h"
+#include "tink/config/tink_fips.h"
+#include "tink/daead/aes_siv_key_manager.h"
+#include "tink/registry.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+#include "proto/common.pb.h"
+#include "proto/ecies_aead_hkdf.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::EciesAeadHkdfPrivateKey;
+using ::google::crypto::tink::EcPointFormat;
+using ::google::crypto::tink::EllipticCurveType;
+using ::google::crypto::tink::HashType;
+using ::testing::Not;
+
+class EciesAeadHkdfSessionTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (kUseOnlyFips) {
+      GTEST_SKIP() << "Not supported in FIPS-only mode";
+    }
+    ASSERT_THAT(Registry::RegisterKeyTypeManager(
+                    absl::make_unique<AesGcmKeyManager>(), true),
+                IsOk());
+    ASSERT_THAT(Registry::RegisterKeyTypeManager(
+                    absl::make_unique<AesSivKeyManager>(), true),
+                IsOk());
+  }
+};
+
+TEST_F(EciesAeadHkdfSessionTest, EncryptDecrypt) {
+  for (const EciesAeadHkdfPrivateKey& key :
+       {test::GetEciesAesGcmHkdfTestKey(EllipticCurveType::NIST_P256,
+                                        EcPointFormat::UNCOMPRESSED,
+                                        HashType::SHA256, 16),
+        test::GetEciesAesGcmHkdfTestKey(EllipticCurveType::CURVE25519,
+                                        EcPointFormat::COMPRESSED,
+                                        HashType::SHA512, 32),
+        test::GetEciesAesSivHkdfTestKey(EllipticCurveType::NIST_P384,
+                                        EcPointFormat::COMPRESSED,
+                                        HashType::SHA256)}) {
+    auto encrypt_or =
+        EciesAeadHkdfSessionEncrypt::New(key.public_key(), "context");
+    ASSERT_THAT(encrypt_or.status(), IsOk());
+    auto encrypt = std::move(encrypt_or.ValueOrDie());
+    auto decrypt_or =
+        EciesAeadHkdfSessionDecrypt::New(key, encrypt->header(), "context");
+    ASSERT_THAT(decrypt_or.status(), IsOk());
+    auto decrypt = std::move(decrypt_or.ValueOrDie());
+
+    std::vector<std::string> ciphertexts;
+    for (int i = 0; i < 10; i++) {
+      auto ciphertext_or = encrypt->Encrypt("plaintext");
+      ASSERT_THAT(ciphertext_or.status(), IsOk());
+      ciphertexts.push_back(ciphertext_or.ValueOrDie());
+    }
+    // Messages are decrypted in any order, and each one under its own key.
+    for (int i = ciphertexts.size() - 1; i >= 0; i--) {
+      EXPECT_EQ(ciphertexts[i].substr(0, 8),
+                std::string("\0\0\0\0\0\0\0", 7) + static_cast<char>(i));
+      auto plaintext_or = decrypt->Decrypt(ciphertexts[i]);
+      ASSERT_THAT(plaintext_or.status(), IsOk());
+      EXPECT_EQ(plaintext_or.ValueOrDie(), "plaintext");
+    }
+    EXPECT_EQ(std::set<std::string>(ciphertexts.begin(), ciphertexts.end())
+                  .size(),
+              ciphertexts.size());
+  }
+}
+
+TEST_F(EciesAeadHkdfSessionTest, DecryptFailures) {
+  EciesAeadHkdfPrivateKey key = test::GetEciesAesGcmHkdfTestKey(
+      EllipticCurveType::NIST_P256, EcPointFormat::UNCOMPRESSED,
+      HashType::SHA256, 16);
+  auto encrypt =
+      EciesAeadHkdfSessionEncrypt::New(key.public_key(), "context")
+          .ValueOrDie();
+  std::string first = encrypt->Encrypt("first").ValueOrDie();
+  std::string second = encrypt->Encrypt("second").ValueOrDie();
+
+  // Wrong context info.
+  auto decrypt =
+      EciesAeadHkdfSessionDecrypt::New(key, encrypt->header(), "other")
+          .ValueOrDie();
+  EXPECT_THAT(decrypt->Decrypt(first).status(), Not(IsOk()));
+
+  decrypt = EciesAeadHkdfSessionDecrypt::New(key, encrypt->header(), "context")
+                .ValueOrDie();
+  // Message index swapped.
+  EXPECT_THAT(
+      decrypt->Decrypt(absl::StrCat(second.substr(0, 8), first.substr(8)))
+          .status(),
+      Not(IsOk()));
+  EXPECT_THAT(decrypt->Decrypt(first.substr(0, 7)).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  // Wrong header.
+  EXPECT_THAT(EciesAeadHkdfSessionDecrypt::New(
+                  key, encrypt->header().substr(1), "context")
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(EciesAeadHkdfSessionTest, ConcurrentEncrypt) {
+  EciesAeadHkdfPrivateKey key = test::GetEciesAesGcmHkdfTestKey(
+      EllipticCurveType::CURVE25519, EcPointFormat::COMPRESSED,
+      HashType::SHA256, 16);
+  auto encrypt =
+      EciesAeadHkdfSessionEncrypt::New(key.public_key(), "").ValueOrDie();
+  std::vector<std::thread> threads;
+  std::vector<std::vector<std::string>> ciphertexts(4);
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&encrypt, &ciphertexts, t]() {
+      for (int i = 0; i < 50; i++) {
+        ciphertexts[t].push_back(
+            encrypt->Encrypt(absl::StrCat(t)).ValueOrDie());
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  auto decrypt =
+      EciesAeadHkdfSessionDecrypt::New(key, encrypt->header(), "")
+          .ValueOrDie();
+  std::set<std::string> message_indices;
+  for (int t = 0; t < 4; t++) {
+    for (const std::string& ciphertext : ciphertexts[t]) {
+      message_indices.insert(ciphertext.substr(0, 8));
+      auto plaintext_or = decrypt->Decrypt(ciphertext);
+      ASSERT_THAT(plaintext_or.status(), IsOk());
+      EXPECT_EQ(plaintext_or.ValueOrDie(), absl::StrCat(t));
+    }
+  }
+  EXPECT_EQ(message_indices.size(), 200);
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
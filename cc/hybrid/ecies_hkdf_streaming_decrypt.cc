@@ -0,0 +1,199 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/ecies_hkdf_streaming_decrypt.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/input_stream.h"
+#include "tink/random_access_stream.h"
+#include "tink/streaming_aead.h"
+#include "tink/subtle/aes_gcm_hkdf_streaming.h"
+#include "tink/subtle/ec_util.h"
+#include "tink/util/buffer.h"
+#include "tink/util/enums.h"
+#include "tink/util/input_stream_util.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/ecies_aead_hkdf.pb.h"
+
+using ::google::crypto::tink::EciesAeadHkdfPrivateKey;
+using ::google::crypto::tink::EllipticCurveType;
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+util::Status Validate(const EciesAeadHkdfPrivateKey& key) {
+  if (!key.has_public_key() || !key.public_key().has_params() ||
+      key.public_key().x().empty() || key.key_value().empty()) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        "Invalid EciesAeadHkdfPublicKey: missing required fields.");
+  }
+  if (key.public_key().params().has_kem_params() &&
+      key.public_key().params().kem_params().curve_type() ==
+          EllipticCurveType::CURVE25519) {
+    if (!key.public_key().y().empty()) {
+      return util::Status(
+          util::error::INVALID_ARGUMENT,
+          "Invalid EciesAeadHkdfPublicKey: has unexpected field.");
+    }
+  } else if (key.public_key().y().empty()) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        "Invalid EciesAeadHkdfPublicKey: missing required fields.");
+  }
+  return util::Status::OK;
+}
+
+util::StatusOr<std::unique_ptr<subtle::AesGcmHkdfStreaming>> NewStreaming(
+    util::SecretData ikm, const EciesHkdfStreamingParams& params,
+    int kem_bytes_size) {
+  subtle::AesGcmHkdfStreaming::Params streaming_params;
+  streaming_params.ikm = std::move(ikm);
+  streaming_params.hkdf_hash = params.hkdf_hash;
+  streaming_params.derived_key_size = params.derived_key_size;
+  streaming_params.ciphertext_segment_size = params.ciphertext_segment_size;
+  streaming_params.ciphertext_offset = kem_bytes_size;
+  return subtle::AesGcmHkdfStreaming::New(std::move(streaming_params));
+}
+
+// Reads the first 'count' bytes of 'stream'.
+util::StatusOr<std::string> ReadPrefix(RandomAccessStream* stream,
+                                       int count) {
+  auto buffer_result = util::Buffer::New(count);
+  if (!buffer_result.ok()) return buffer_result.status();
+  util::Buffer* buffer = buffer_result.ValueOrDie().get();
+  std::string bytes;
+  while (bytes.size() < count) {
+    util::Status status =
+        stream->PRead(bytes.size(), count - bytes.size(), buffer);
+    bytes.append(buffer->get_mem_block(), buffer->size());
+    if (status.error_code() == util::error::OUT_OF_RANGE) {
+      if (bytes.size() == count) break;
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "ciphertext too short");
+    }
+    if (!status.ok()) return status;
+  }
+  return bytes;
+}
+
+}  // namespace
+
+// static
+util::StatusOr<std::unique_ptr<EciesHkdfStreamingDecrypt>>
+EciesHkdfStreamingDecrypt::New(const EciesAeadHkdfPrivateKey& recipient_key,
+                               const EciesHkdfStreamingParams& params) {
+  util::Status status = Validate(recipient_key);
+  if (!status.ok()) return status;
+  const auto& key_params = recipient_key.public_key().params();
+  auto kem_bytes_size_result = subtle::EcUtil::EncodingSizeInBytes(
+      util::Enums::ProtoToSubtle(key_params.kem_params().curve_type()),
+      util::Enums::ProtoToSubtle(key_params.ec_point_format()));
+  if (!kem_bytes_size_result.ok()) return kem_bytes_size_result.status();
+  int kem_bytes_size = kem_bytes_size_result.ValueOrDie();
+  // Checks the stream parameters with a placeholder key.
+  auto streaming_result = NewStreaming(
+      util::SecretData(params.derived_key_size), params, kem_bytes_size);
+  if (!streaming_result.ok()) return streaming_result.status();
+
+  auto kem_result = subtle::EciesHkdfRecipientKemBoringSsl::New(
+      util::Enums::ProtoToSubtle(key_params.kem_params().curve_type()),
+      util::SecretDataFromStringView(recipient_key.key_value()));
+  if (!kem_result.ok()) return kem_result.status();
+  return {absl::WrapUnique(new EciesHkdfStreamingDecrypt(
+      key_params, std::move(kem_result).ValueOrDie(), params,
+      kem_bytes_size))};
+}
+
+util::StatusOr<std::unique_ptr<InputStream>>
+EciesHkdfStreamingDecrypt::NewDecryptingStream(
+    std::unique_ptr<InputStream> ciphertext_source,
+    absl::string_view context_info) const {
+  if (ciphertext_source == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "ciphertext_source must be non-null");
+  }
+  auto kem_bytes_result =
+      ReadBytesFromStream(kem_bytes_size_, ciphertext_source.get());
+  if (!kem_bytes_result.ok()) {
+    if (kem_bytes_result.status().error_code() == util::error::OUT_OF_RANGE) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "ciphertext too short");
+    }
+    return kem_bytes_result.status();
+  }
+  auto streaming_result =
+      Decapsulate(kem_bytes_result.ValueOrDie(), context_info);
+  if (!streaming_result.ok()) return streaming_result.status();
+  return streaming_result.ValueOrDie()->NewDecryptingStream(
+      std::move(ciphertext_source), /*associated_data=*/"");
+}
+
+util::StatusOr<std::unique_ptr<RandomAccessStream>>
+EciesHkdfStreamingDecrypt::NewDecryptingRandomAccessStream(
+    std::unique_ptr<RandomAccessStream> ciphertext_source,
+    absl::string_view context_info,
+    const StreamingAead::RandomAccessOptions& options) const {
+  if (ciphertext_source == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "ciphertext_source must be non-null");
+  }
+  auto kem_bytes_result = ReadPrefix(ciphertext_source.get(), kem_bytes_size_);
+  if (!kem_bytes_result.ok()) return kem_bytes_result.status();
+  auto streaming_result =
+      Decapsulate(kem_bytes_result.ValueOrDie(), context_info);
+  if (!streaming_result.ok()) return streaming_result.status();
+  // The KEM bytes are the ciphertext offset of the stream, so the
+  // positions of its segments are those in 'ciphertext_source'.
+  return streaming_result.ValueOrDie()->NewDecryptingRandomAccessStream(
+      std::move(ciphertext_source), /*associated_data=*/"", options);
+}
+
+util::StatusOr<std::unique_ptr<StreamingAead>>
+EciesHkdfStreamingDecrypt::Decapsulate(absl::string_view kem_bytes,
+                                       absl::string_view context_info) const {
+  auto symmetric_key_result = recipient_kem_->GenerateKey(
+      kem_bytes,
+      util::Enums::ProtoToSubtle(
+          recipient_key_params_.kem_params().hkdf_hash_type()),
+      recipient_key_params_.kem_params().hkdf_salt(), context_info,
+      params_.derived_key_size,
+      util::Enums::ProtoToSubtle(recipient_key_params_.ec_point_format()));
+  if (!symmetric_key_result.ok()) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("invalid ciphertext: ",
+                     symmetric_key_result.status().error_message()));
+  }
+  auto streaming_result = NewStreaming(
+      std::move(symmetric_key_result.ValueOrDie()), params_, kem_bytes_size_);
+  if (!streaming_result.ok()) return streaming_result.status();
+  return {std::move(streaming_result.ValueOrDie())};
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,85 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_HYBRID_ECIES_HKDF_STREAMING_DECRYPT_H_
+#define TINK_HYBRID_ECIES_HKDF_STREAMING_DECRYPT_H_
+
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "tink/hybrid/ecies_hkdf_streaming_encrypt.h"
+#include "tink/input_stream.h"
+#include "tink/random_access_stream.h"
+#include "tink/streaming_aead.h"
+#include "tink/subtle/ecies_hkdf_recipient_kem_boringssl.h"
+#include "tink/util/statusor.h"
+#include "proto/ecies_aead_hkdf.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// Decrypts the ciphertexts of EciesHkdfStreamingEncrypt.  The KEM bytes
+// are read, and the key of the stream decapsulated, when a decrypting
+// stream is created.
+class EciesHkdfStreamingDecrypt {
+ public:
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<EciesHkdfStreamingDecrypt>>
+  New(const google::crypto::tink::EciesAeadHkdfPrivateKey& recipient_key,
+      const EciesHkdfStreamingParams& params);
+
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
+  NewDecryptingStream(
+      std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
+      absl::string_view context_info) const;
+
+  // The returned stream reads the whole ciphertext through
+  // 'ciphertext_source', including the KEM bytes.  With 'options', its
+  // segments are cached, and decrypted ahead or in parallel.
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<crypto::tink::RandomAccessStream>>
+  NewDecryptingRandomAccessStream(
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view context_info,
+      const StreamingAead::RandomAccessOptions& options =
+          StreamingAead::RandomAccessOptions()) const;
+
+ private:
+  EciesHkdfStreamingDecrypt(
+      const google::crypto::tink::EciesAeadHkdfParams& recipient_key_params,
+      std::unique_ptr<const subtle::EciesHkdfRecipientKemBoringSsl>
+          recipient_kem,
+      const EciesHkdfStreamingParams& params, int kem_bytes_size)
+      : recipient_key_params_(recipient_key_params),
+        recipient_kem_(std::move(recipient_kem)),
+        params_(params),
+        kem_bytes_size_(kem_bytes_size) {}
+
+  // Returns the StreamingAead of the key encapsulated in 'kem_bytes'.
+  crypto::tink::util::StatusOr<std::unique_ptr<StreamingAead>> Decapsulate(
+      absl::string_view kem_bytes, absl::string_view context_info) const;
+
+  const google::crypto::tink::EciesAeadHkdfParams recipient_key_params_;
+  const std::unique_ptr<const subtle::EciesHkdfRecipientKemBoringSsl>
+      recipient_kem_;
+  const EciesHkdfStreamingParams params_;
+  const int kem_bytes_size_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_HYBRID_ECIES_HKDF_STREAMING_DECRYPT_H_
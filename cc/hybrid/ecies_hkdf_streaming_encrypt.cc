@@ -0,0 +1,138 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/ecies_hkdf_streaming_encrypt.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/output_stream.h"
+#include "tink/subtle/aes_gcm_hkdf_streaming.h"
+#include "tink/subtle/ec_util.h"
+#include "tink/util/enums.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/ecies_aead_hkdf.pb.h"
+
+using ::google::crypto::tink::EciesAeadHkdfPublicKey;
+using ::google::crypto::tink::EllipticCurveType;
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+util::Status Validate(const EciesAeadHkdfPublicKey& key) {
+  if (key.x().empty() || !key.has_params()) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        "Invalid EciesAeadHkdfPublicKey: missing required fields.");
+  }
+  if (key.params().has_kem_params() &&
+      key.params().kem_params().curve_type() == EllipticCurveType::CURVE25519) {
+    if (!key.y().empty()) {
+      return util::Status(
+          util::error::INVALID_ARGUMENT,
+          "Invalid EciesAeadHkdfPublicKey: has unexpected field.");
+    }
+  } else if (key.y().empty()) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        "Invalid EciesAeadHkdfPublicKey: missing required fields.");
+  }
+  return util::Status::OK;
+}
+
+util::StatusOr<std::unique_ptr<subtle::AesGcmHkdfStreaming>> NewStreaming(
+    util::SecretData ikm, const EciesHkdfStreamingParams& params,
+    int kem_bytes_size) {
+  subtle::AesGcmHkdfStreaming::Params streaming_params;
+  streaming_params.ikm = std::move(ikm);
+  streaming_params.hkdf_hash = params.hkdf_hash;
+  streaming_params.derived_key_size = params.derived_key_size;
+  streaming_params.ciphertext_segment_size = params.ciphertext_segment_size;
+  streaming_params.ciphertext_offset = kem_bytes_size;
+  return subtle::AesGcmHkdfStreaming::New(std::move(streaming_params));
+}
+
+}  // namespace
+
+// static
+util::StatusOr<std::unique_ptr<EciesHkdfStreamingEncrypt>>
+EciesHkdfStreamingEncrypt::New(const EciesAeadHkdfPublicKey& recipient_key,
+                               const EciesHkdfStreamingParams& params) {
+  util::Status status = Validate(recipient_key);
+  if (!status.ok()) return status;
+  auto kem_bytes_size_result = subtle::EcUtil::EncodingSizeInBytes(
+      util::Enums::ProtoToSubtle(
+          recipient_key.params().kem_params().curve_type()),
+      util::Enums::ProtoToSubtle(recipient_key.params().ec_point_format()));
+  if (!kem_bytes_size_result.ok()) return kem_bytes_size_result.status();
+  int kem_bytes_size = kem_bytes_size_result.ValueOrDie();
+  // Checks the stream parameters with a placeholder key.
+  auto streaming_result = NewStreaming(
+      util::SecretData(params.derived_key_size), params, kem_bytes_size);
+  if (!streaming_result.ok()) return streaming_result.status();
+
+  auto kem_result = subtle::EciesHkdfSenderKemBoringSsl::New(
+      util::Enums::ProtoToSubtle(
+          recipient_key.params().kem_params().curve_type()),
+      recipient_key.x(), recipient_key.y());
+  if (!kem_result.ok()) return kem_result.status();
+  return {absl::WrapUnique(new EciesHkdfStreamingEncrypt(
+      recipient_key, std::move(kem_result).ValueOrDie(), params,
+      kem_bytes_size))};
+}
+
+util::StatusOr<std::unique_ptr<OutputStream>>
+EciesHkdfStreamingEncrypt::NewEncryptingStream(
+    std::unique_ptr<OutputStream> ciphertext_destination,
+    absl::string_view context_info) const {
+  if (ciphertext_destination == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "ciphertext_destination must be non-null");
+  }
+  auto kem_key_result = sender_kem_->GenerateKey(
+      util::Enums::ProtoToSubtle(
+          recipient_key_.params().kem_params().hkdf_hash_type()),
+      recipient_key_.params().kem_params().hkdf_salt(), context_info,
+      params_.derived_key_size,
+      util::Enums::ProtoToSubtle(recipient_key_.params().ec_point_format()));
+  if (!kem_key_result.ok()) return kem_key_result.status();
+  const auto& kem_key = kem_key_result.ValueOrDie();
+  const std::string& kem_bytes = kem_key->get_kem_bytes();
+  if (kem_bytes.size() != kem_bytes_size_) {
+    return util::Status(util::error::INTERNAL, "unexpected KEM bytes size");
+  }
+  auto streaming_result =
+      NewStreaming(kem_key->get_symmetric_key(), params_, kem_bytes_size_);
+  if (!streaming_result.ok()) return streaming_result.status();
+
+  util::Status status = ciphertext_destination->WriteFrom(absl::MakeConstSpan(
+      reinterpret_cast<const uint8_t*>(kem_bytes.data()), kem_bytes.size()));
+  if (!status.ok()) return status;
+  return streaming_result.ValueOrDie()->NewEncryptingStream(
+      std::move(ciphertext_destination), /*associated_data=*/"");
+}
+
+}  // namespace tink
+}  // namespace crypto
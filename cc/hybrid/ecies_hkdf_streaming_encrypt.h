@@ -0,0 +1,86 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_HYBRID_ECIES_HKDF_STREAMING_ENCRYPT_H_
+#define TINK_HYBRID_ECIES_HKDF_STREAMING_ENCRYPT_H_
+
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "tink/output_stream.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/ecies_hkdf_sender_kem_boringssl.h"
+#include "tink/util/statusor.h"
+#include "proto/ecies_aead_hkdf.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// The parameters of the AesGcmHkdfStreaming stream of an ECIES streaming
+// ciphertext.  Sender and recipient must use the same parameters.
+struct EciesHkdfStreamingParams {
+  subtle::HashType hkdf_hash = subtle::HashType::SHA256;
+  int derived_key_size = 32;
+  int ciphertext_segment_size = 1 << 20;
+};
+
+// Hybrid encryption of streams of any size: the ECIES KEM of
+// 'recipient_key' derives the key of an AesGcmHkdfStreaming, which
+// encrypts the stream.  The ciphertext is
+//   kem_bytes | aes_gcm_hkdf_streaming_ciphertext
+// where the stream's first segment is shortened by the size of kem_bytes,
+// as for a ciphertext offset.  The context info is the HKDF info of the
+// KEM, as in EciesAeadHkdfHybridEncrypt, so the stream's associated data
+// is empty.  The DEM parameters of 'recipient_key' are not used.
+//
+// Ciphertexts are decrypted with EciesHkdfStreamingDecrypt, as a stream,
+// or as a random access stream whose segments are decrypted in parallel.
+class EciesHkdfStreamingEncrypt {
+ public:
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<EciesHkdfStreamingEncrypt>>
+  New(const google::crypto::tink::EciesAeadHkdfPublicKey& recipient_key,
+      const EciesHkdfStreamingParams& params);
+
+  // Writes the KEM bytes of a new key to 'ciphertext_destination', and
+  // returns a stream which encrypts the bytes written to it into
+  // 'ciphertext_destination'.
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+  NewEncryptingStream(
+      std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+      absl::string_view context_info) const;
+
+ private:
+  EciesHkdfStreamingEncrypt(
+      const google::crypto::tink::EciesAeadHkdfPublicKey& recipient_key,
+      std::unique_ptr<const subtle::EciesHkdfSenderKemBoringSsl> sender_kem,
+      const EciesHkdfStreamingParams& params, int kem_bytes_size)
+      : recipient_key_(recipient_key),
+        sender_kem_(std::move(sender_kem)),
+        params_(params),
+        kem_bytes_size_(kem_bytes_size) {}
+
+  const google::crypto::tink::EciesAeadHkdfPublicKey recipient_key_;
+  const std::unique_ptr<const subtle::EciesHkdfSenderKemBoringSsl>
+      sender_kem_;
+  const EciesHkdfStreamingParams params_;
+  const int kem_bytes_size_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_HYBRID_ECIES_HKDF_STREAMING_ENCRYPT_H_
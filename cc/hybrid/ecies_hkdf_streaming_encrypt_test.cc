@@ -0,0 +1,202 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/ecies_hkdf_streaming_encrypt.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "tink/hybrid/ecies_hkdf_streaming_decrypt.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/buffer.h"
+#include "tink/util/file_random_access_stream.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/ostream_output_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+#include "proto/ecies_aead_hkdf.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::GetEciesAesGcmHkdfTestKey;
+using ::crypto::tink::test::GetTestFileDescriptor;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::EciesAeadHkdfPrivateKey;
+using ::testing::Eq;
+using ::testing::Not;
+
+EciesHkdfStreamingParams TestParams() {
+  EciesHkdfStreamingParams params;
+  params.ciphertext_segment_size = 1024;
+  return params;
+}
+
+EciesAeadHkdfPrivateKey TestKey(subtle::EllipticCurveType curve,
+                                subtle::EcPointFormat point_format) {
+  return GetEciesAesGcmHkdfTestKey(curve, point_format,
+                                   subtle::HashType::SHA256,
+                                   /*aes_gcm_key_size=*/16);
+}
+
+std::string Encrypt(const EciesAeadHkdfPrivateKey& key,
+                    absl::string_view plaintext,
+                    absl::string_view context_info) {
+  auto encrypt_result =
+      EciesHkdfStreamingEncrypt::New(key.public_key(), TestParams());
+  EXPECT_THAT(encrypt_result.status(), IsOk());
+  auto ciphertext_stream = absl::make_unique<std::stringstream>();
+  std::stringstream* ciphertext = ciphertext_stream.get();
+  auto encrypting_stream_result =
+      encrypt_result.ValueOrDie()->NewEncryptingStream(
+          absl::make_unique<util::OstreamOutputStream>(
+              std::move(ciphertext_stream)),
+          context_info);
+  EXPECT_THAT(encrypting_stream_result.status(), IsOk());
+  EXPECT_THAT(subtle::test::WriteToStream(
+                  encrypting_stream_result.ValueOrDie().get(), plaintext),
+              IsOk());
+  return ciphertext->str();
+}
+
+util::StatusOr<std::string> Decrypt(const EciesAeadHkdfPrivateKey& key,
+                                    absl::string_view ciphertext,
+                                    absl::string_view context_info) {
+  auto decrypt_result = EciesHkdfStreamingDecrypt::New(key, TestParams());
+  if (!decrypt_result.ok()) return decrypt_result.status();
+  auto decrypting_stream_result =
+      decrypt_result.ValueOrDie()->NewDecryptingStream(
+          absl::make_unique<util::IstreamInputStream>(
+              absl::make_unique<std::stringstream>(std::string(ciphertext))),
+          context_info);
+  if (!decrypting_stream_result.ok()) {
+    return decrypting_stream_result.status();
+  }
+  std::string plaintext;
+  util::Status status = subtle::test::ReadFromStream(
+      decrypting_stream_result.ValueOrDie().get(), &plaintext);
+  if (!status.ok()) return status;
+  return plaintext;
+}
+
+TEST(EciesHkdfStreamingTest, EncryptThenDecrypt) {
+  for (const EciesAeadHkdfPrivateKey& key :
+       {TestKey(subtle::EllipticCurveType::NIST_P256,
+                subtle::EcPointFormat::UNCOMPRESSED),
+        TestKey(subtle::EllipticCurveType::CURVE25519,
+                subtle::EcPointFormat::COMPRESSED)}) {
+    for (int size : {0, 1, 1000, 10000}) {
+      SCOPED_TRACE(size);
+      std::string plaintext = subtle::Random::GetRandomBytes(size);
+      std::string ciphertext = Encrypt(key, plaintext, "context info");
+      auto decrypt_result = Decrypt(key, ciphertext, "context info");
+      ASSERT_THAT(decrypt_result.status(), IsOk());
+      EXPECT_THAT(decrypt_result.ValueOrDie(), Eq(plaintext));
+    }
+  }
+}
+
+TEST(EciesHkdfStreamingTest, DecryptingRandomAccessStream) {
+  EciesAeadHkdfPrivateKey key =
+      TestKey(subtle::EllipticCurveType::NIST_P256,
+              subtle::EcPointFormat::COMPRESSED);
+  std::string plaintext = subtle::Random::GetRandomBytes(20000);
+  std::string ciphertext = Encrypt(key, plaintext, "context info");
+  auto decrypt_result = EciesHkdfStreamingDecrypt::New(key, TestParams());
+  ASSERT_THAT(decrypt_result.status(), IsOk());
+  StreamingAead::RandomAccessOptions options;
+  options.parallelism = 4;
+  auto stream_result =
+      decrypt_result.ValueOrDie()->NewDecryptingRandomAccessStream(
+          absl::make_unique<util::FileRandomAccessStream>(
+              GetTestFileDescriptor("ecies_hkdf_streaming_ct", ciphertext)),
+          "context info", options);
+  ASSERT_THAT(stream_result.status(), IsOk());
+  auto size_result = stream_result.ValueOrDie()->size();
+  ASSERT_THAT(size_result.status(), IsOk());
+  EXPECT_THAT(size_result.ValueOrDie(), Eq(plaintext.size()));
+  for (int position : {0, 500, 5000}) {
+    SCOPED_TRACE(position);
+    auto buffer = std::move(util::Buffer::New(10000).ValueOrDie());
+    EXPECT_THAT(stream_result.ValueOrDie()->PRead(position, 10000,
+                                                  buffer.get()),
+                IsOk());
+    EXPECT_THAT(std::string(buffer->get_mem_block(), buffer->size()),
+                Eq(plaintext.substr(position, 10000)));
+  }
+}
+
+TEST(EciesHkdfStreamingTest, DecryptionFailures) {
+  EciesAeadHkdfPrivateKey key =
+      TestKey(subtle::EllipticCurveType::NIST_P256,
+              subtle::EcPointFormat::UNCOMPRESSED);
+  std::string ciphertext = Encrypt(key, "plaintext", "context info");
+  EXPECT_THAT(Decrypt(key, ciphertext, "other context info").status(),
+              Not(IsOk()));
+  EXPECT_THAT(
+      Decrypt(TestKey(subtle::EllipticCurveType::NIST_P256,
+                      subtle::EcPointFormat::UNCOMPRESSED),
+              ciphertext, "context info")
+          .status(),
+      Not(IsOk()));
+  EXPECT_THAT(Decrypt(key, ciphertext.substr(0, 10), "context info").status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  std::string corrupted = ciphertext;
+  corrupted[1] ^= 1;
+  EXPECT_THAT(Decrypt(key, corrupted, "context info").status(), Not(IsOk()));
+  corrupted = ciphertext;
+  corrupted[ciphertext.size() - 1] ^= 1;
+  EXPECT_THAT(Decrypt(key, corrupted, "context info").status(), Not(IsOk()));
+}
+
+TEST(EciesHkdfStreamingTest, InvalidParams) {
+  EciesAeadHkdfPrivateKey key =
+      TestKey(subtle::EllipticCurveType::NIST_P256,
+              subtle::EcPointFormat::UNCOMPRESSED);
+  EciesHkdfStreamingParams params;
+  params.derived_key_size = 20;
+  EXPECT_THAT(EciesHkdfStreamingEncrypt::New(key.public_key(), params)
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(EciesHkdfStreamingDecrypt::New(key, params).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  // The first segment must have room for the KEM bytes and the header.
+  params = EciesHkdfStreamingParams();
+  params.ciphertext_segment_size = 100;
+  EXPECT_THAT(EciesHkdfStreamingEncrypt::New(key.public_key(), params)
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EciesAeadHkdfPrivateKey no_public_key;
+  EXPECT_THAT(EciesHkdfStreamingDecrypt::New(no_public_key, TestParams())
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
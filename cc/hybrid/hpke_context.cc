@@ -0,0 +1,61 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/hpke_context.h"
+
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "tink/hybrid/internal/hpke_context_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using ::crypto::tink::internal::HpkeContextBoringSsl;
+using ::google::crypto::tink::HpkePrivateKey;
+using ::google::crypto::tink::HpkePublicKey;
+
+// static
+util::StatusOr<std::unique_ptr<HpkeContext>> HpkeContext::SetupSender(
+    const HpkePublicKey& recipient_public_key, absl::string_view info) {
+  auto context_or = HpkeContextBoringSsl::SetupSender(
+      recipient_public_key.params(), recipient_public_key.public_key(), info);
+  if (!context_or.ok()) return context_or.status();
+  return {absl::WrapUnique(
+      new HpkeContext(std::move(context_or.ValueOrDie())))};
+}
+
+// static
+util::StatusOr<std::unique_ptr<HpkeContext>> HpkeContext::SetupRecipient(
+    const HpkePrivateKey& recipient_private_key,
+    absl::string_view encapsulated_key, absl::string_view info) {
+  auto context_or = HpkeContextBoringSsl::SetupRecipient(
+      recipient_private_key.public_key().params(),
+      util::SecretDataFromStringView(recipient_private_key.private_key()),
+      recipient_private_key.public_key().public_key(), encapsulated_key, info);
+  if (!context_or.ok()) return context_or.status();
+  return {absl::WrapUnique(
+      new HpkeContext(std::move(context_or.ValueOrDie())))};
+}
+
+}  // namespace tink
+}  // namespace crypto
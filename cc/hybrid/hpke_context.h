@@ -0,0 +1,89 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_HYBRID_HPKE_CONTEXT_H_
+#define TINK_HYBRID_HPKE_CONTEXT_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "tink/hybrid/internal/hpke_context_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// A multi-message HPKE context (RFC 9180, Section 5) of an HPKE key.
+//
+// HybridEncrypt and HybridDecrypt of an HPKE key set up a new context for
+// every message. Protocols which send several messages to the same
+// recipient can instead set up one context, send its encapsulated key once,
+// and seal the messages with it, which saves the key agreement of every
+// further message. The recipient must open the messages in the order they
+// were sealed. A context also exports secrets which both sides agree on.
+//
+// A context is not thread-safe.
+class HpkeContext {
+ public:
+  // Sets up a sender context to the owner of 'recipient_public_key'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HpkeContext>>
+  SetupSender(const google::crypto::tink::HpkePublicKey& recipient_public_key,
+              absl::string_view info);
+
+  // Sets up the recipient context of the sender context with encapsulated
+  // key 'encapsulated_key'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HpkeContext>>
+  SetupRecipient(
+      const google::crypto::tink::HpkePrivateKey& recipient_private_key,
+      absl::string_view encapsulated_key, absl::string_view info);
+
+  // The encapsulated key which the sender passes to the recipient.
+  const std::string& encapsulated_key() const {
+    return context_->encapsulated_key();
+  }
+
+  crypto::tink::util::StatusOr<std::string> Seal(
+      absl::string_view plaintext, absl::string_view associated_data) {
+    return context_->Seal(plaintext, associated_data);
+  }
+
+  crypto::tink::util::StatusOr<std::string> Open(
+      absl::string_view ciphertext, absl::string_view associated_data) {
+    return context_->Open(ciphertext, associated_data);
+  }
+
+  // Returns a secret of 'length' bytes, at most 8160, which is the same in
+  // the sender and the recipient context for the same 'exporter_context'.
+  crypto::tink::util::StatusOr<util::SecretData> Export(
+      absl::string_view exporter_context, size_t length) const {
+    return context_->Export(exporter_context, length);
+  }
+
+ private:
+  explicit HpkeContext(std::unique_ptr<internal::HpkeContextBoringSsl> context)
+      : context_(std::move(context)) {}
+
+  std::unique_ptr<internal::HpkeContextBoringSsl> context_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_HYBRID_HPKE_CONTEXT_H_
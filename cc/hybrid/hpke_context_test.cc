@@ -0,0 +1,127 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/hpke_context.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "tink/hybrid/hpke_private_key_manager.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::google::crypto::tink::HpkeAead;
+using ::google::crypto::tink::HpkeKdf;
+using ::google::crypto::tink::HpkeKem;
+using ::google::crypto::tink::HpkeKeyFormat;
+using ::google::crypto::tink::HpkePrivateKey;
+using ::testing::Eq;
+using ::testing::Not;
+
+HpkePrivateKey CreatePrivateKey() {
+  HpkeKeyFormat key_format;
+  key_format.mutable_params()->set_kem(HpkeKem::DHKEM_X25519_HKDF_SHA256);
+  key_format.mutable_params()->set_kdf(HpkeKdf::HKDF_SHA256);
+  key_format.mutable_params()->set_aead(HpkeAead::AES_128_GCM);
+  return HpkePrivateKeyManager().CreateKey(key_format).ValueOrDie();
+}
+
+TEST(HpkeContextTest, SealOpenSeveralMessages) {
+  HpkePrivateKey private_key = CreatePrivateKey();
+  auto sender_or = HpkeContext::SetupSender(private_key.public_key(), "info");
+  ASSERT_THAT(sender_or.status(), IsOk());
+  auto& sender = sender_or.ValueOrDie();
+  auto recipient_or = HpkeContext::SetupRecipient(
+      private_key, sender->encapsulated_key(), "info");
+  ASSERT_THAT(recipient_or.status(), IsOk());
+  auto& recipient = recipient_or.ValueOrDie();
+
+  for (int i = 0; i < 10; i++) {
+    std::string message = absl::StrCat("message ", i);
+    auto ciphertext_or = sender->Seal(message, "aad");
+    ASSERT_THAT(ciphertext_or.status(), IsOk());
+    auto plaintext_or = recipient->Open(ciphertext_or.ValueOrDie(), "aad");
+    ASSERT_THAT(plaintext_or.status(), IsOk());
+    EXPECT_THAT(plaintext_or.ValueOrDie(), Eq(message));
+  }
+  // A message sealed twice has two different ciphertexts.
+  EXPECT_THAT(sender->Seal("message", "").ValueOrDie(),
+              Not(Eq(sender->Seal("message", "").ValueOrDie())));
+}
+
+TEST(HpkeContextTest, Export) {
+  HpkePrivateKey private_key = CreatePrivateKey();
+  auto sender = HpkeContext::SetupSender(private_key.public_key(), "info")
+                    .ValueOrDie();
+  auto recipient = HpkeContext::SetupRecipient(
+                       private_key, sender->encapsulated_key(), "info")
+                       .ValueOrDie();
+  auto secret_or = sender->Export("exporter context", 42);
+  ASSERT_THAT(secret_or.status(), IsOk());
+  EXPECT_THAT(secret_or.ValueOrDie().size(), Eq(42));
+  EXPECT_THAT(recipient->Export("exporter context", 42).ValueOrDie(),
+              Eq(secret_or.ValueOrDie()));
+  EXPECT_THAT(recipient->Export("other exporter context", 42).ValueOrDie(),
+              Not(Eq(secret_or.ValueOrDie())));
+}
+
+TEST(HpkeContextTest, FirstMessageIsHybridCiphertext) {
+  HpkePrivateKey private_key = CreatePrivateKey();
+  auto sender = HpkeContext::SetupSender(private_key.public_key(),
+                                         "context info")
+                    .ValueOrDie();
+  std::string ciphertext =
+      absl::StrCat(sender->encapsulated_key(),
+                   sender->Seal("plaintext", "").ValueOrDie());
+  auto decrypt = HpkePrivateKeyManager()
+                     .GetPrimitive<HybridDecrypt>(private_key)
+                     .ValueOrDie();
+  auto plaintext_or = decrypt->Decrypt(ciphertext, "context info");
+  ASSERT_THAT(plaintext_or.status(), IsOk());
+  EXPECT_THAT(plaintext_or.ValueOrDie(), Eq("plaintext"));
+}
+
+TEST(HpkeContextTest, InvalidKeys) {
+  HpkePrivateKey private_key = CreatePrivateKey();
+  HpkePrivateKey invalid_key = private_key;
+  invalid_key.mutable_public_key()->mutable_params()->set_aead(
+      HpkeAead::AEAD_UNKNOWN);
+  EXPECT_THAT(
+      HpkeContext::SetupSender(invalid_key.public_key(), "").status(),
+      Not(IsOk()));
+  EXPECT_THAT(HpkeContext::SetupRecipient(
+                  invalid_key, std::string(32, '\x01'), "")
+                  .status(),
+              Not(IsOk()));
+  EXPECT_THAT(HpkeContext::SetupRecipient(private_key, "short", "").status(),
+              Not(IsOk()));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
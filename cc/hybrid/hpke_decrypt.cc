@@ -0,0 +1,71 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/hpke_decrypt.h"
+
+#include <memory>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "tink/hybrid/internal/hpke_context_boringssl.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using ::crypto::tink::internal::HpkeContextBoringSsl;
+using ::google::crypto::tink::HpkePrivateKey;
+
+// static
+util::StatusOr<std::unique_ptr<HybridDecrypt>> HpkeDecrypt::New(
+    const HpkePrivateKey& recipient_private_key) {
+  const auto& params = recipient_private_key.public_key().params();
+  util::Status status = internal::ValidateHpkeParams(params);
+  if (!status.ok()) return status;
+  auto enc_size_or = internal::HpkeEncapsulatedKeySize(params.kem());
+  if (!enc_size_or.ok()) return enc_size_or.status();
+  if (recipient_private_key.public_key().public_key().size() !=
+      enc_size_or.ValueOrDie()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid HPKE public key size");
+  }
+  return {absl::WrapUnique(new HpkeDecrypt(
+      params,
+      util::SecretDataFromStringView(recipient_private_key.private_key()),
+      recipient_private_key.public_key().public_key(),
+      enc_size_or.ValueOrDie()))};
+}
+
+util::StatusOr<std::string> HpkeDecrypt::Decrypt(
+    absl::string_view ciphertext, absl::string_view context_info) const {
+  if (ciphertext.size() < encapsulated_key_size_) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  auto context_or = HpkeContextBoringSsl::SetupRecipient(
+      params_, private_key_, public_key_,
+      ciphertext.substr(0, encapsulated_key_size_), context_info);
+  if (!context_or.ok()) return context_or.status();
+  return context_or.ValueOrDie()->Open(
+      ciphertext.substr(encapsulated_key_size_), /*associated_data=*/"");
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,62 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_HYBRID_HPKE_DECRYPT_H_
+#define TINK_HYBRID_HPKE_DECRYPT_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// HPKE decryption in base mode (RFC 9180), of the ciphertexts of
+// HpkeEncrypt.
+class HpkeDecrypt : public HybridDecrypt {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<HybridDecrypt>> New(
+      const google::crypto::tink::HpkePrivateKey& recipient_private_key);
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view context_info) const override;
+
+ private:
+  HpkeDecrypt(google::crypto::tink::HpkeParams params,
+              util::SecretData private_key, std::string public_key,
+              size_t encapsulated_key_size)
+      : params_(std::move(params)),
+        private_key_(std::move(private_key)),
+        public_key_(std::move(public_key)),
+        encapsulated_key_size_(encapsulated_key_size) {}
+
+  const google::crypto::tink::HpkeParams params_;
+  const util::SecretData private_key_;
+  const std::string public_key_;
+  const size_t encapsulated_key_size_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_HYBRID_HPKE_DECRYPT_H_
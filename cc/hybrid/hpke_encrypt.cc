@@ -0,0 +1,66 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/hpke_encrypt.h"
+
+#include <memory>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/hybrid/internal/hpke_context_boringssl.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using ::crypto::tink::internal::HpkeContextBoringSsl;
+using ::google::crypto::tink::HpkePublicKey;
+
+// static
+util::StatusOr<std::unique_ptr<HybridEncrypt>> HpkeEncrypt::New(
+    const HpkePublicKey& recipient_public_key) {
+  util::Status status =
+      internal::ValidateHpkeParams(recipient_public_key.params());
+  if (!status.ok()) return status;
+  auto enc_size_or =
+      internal::HpkeEncapsulatedKeySize(recipient_public_key.params().kem());
+  if (!enc_size_or.ok()) return enc_size_or.status();
+  if (recipient_public_key.public_key().size() != enc_size_or.ValueOrDie()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid HPKE public key size");
+  }
+  return {absl::WrapUnique(new HpkeEncrypt(recipient_public_key))};
+}
+
+util::StatusOr<std::string> HpkeEncrypt::Encrypt(
+    absl::string_view plaintext, absl::string_view context_info) const {
+  auto context_or = HpkeContextBoringSsl::SetupSender(
+      recipient_public_key_.params(), recipient_public_key_.public_key(),
+      context_info);
+  if (!context_or.ok()) return context_or.status();
+  auto& context = context_or.ValueOrDie();
+  auto ciphertext_or = context->Seal(plaintext, /*associated_data=*/"");
+  if (!ciphertext_or.ok()) return ciphertext_or.status();
+  return absl::StrCat(context->encapsulated_key(), ciphertext_or.ValueOrDie());
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,54 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_HYBRID_HPKE_ENCRYPT_H_
+#define TINK_HYBRID_HPKE_ENCRYPT_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// HPKE encryption in base mode (RFC 9180). Every message is sealed in a new
+// context, with 'context_info' as the HPKE info; the ciphertext is the
+// encapsulated key followed by the AEAD ciphertext.
+class HpkeEncrypt : public HybridEncrypt {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<HybridEncrypt>> New(
+      const google::crypto::tink::HpkePublicKey& recipient_public_key);
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view context_info) const override;
+
+ private:
+  explicit HpkeEncrypt(google::crypto::tink::HpkePublicKey recipient_public_key)
+      : recipient_public_key_(std::move(recipient_public_key)) {}
+
+  const google::crypto::tink::HpkePublicKey recipient_public_key_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_HYBRID_HPKE_ENCRYPT_H_
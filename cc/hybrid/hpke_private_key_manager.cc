@@ -0,0 +1,90 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/hpke_private_key_manager.h"
+
+#include <string>
+
+#include "openssl/curve25519.h"
+#include "tink/hybrid/hpke_public_key_manager.h"
+#include "tink/hybrid/internal/hpke_context_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using ::google::crypto::tink::HpkeKem;
+using ::google::crypto::tink::HpkeKeyFormat;
+using ::google::crypto::tink::HpkePrivateKey;
+using ::google::crypto::tink::HpkePublicKey;
+
+util::Status HpkePrivateKeyManager::ValidateKeyFormat(
+    const HpkeKeyFormat& key_format) const {
+  if (!key_format.has_params()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Missing params.");
+  }
+  return internal::ValidateHpkeParams(key_format.params());
+}
+
+util::StatusOr<HpkePrivateKey> HpkePrivateKeyManager::CreateKey(
+    const HpkeKeyFormat& key_format) const {
+  if (key_format.params().kem() != HpkeKem::DHKEM_X25519_HKDF_SHA256) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Unsupported HPKE KEM.");
+  }
+  util::SecretData private_key(X25519_PRIVATE_KEY_LEN);
+  std::string public_key(X25519_PUBLIC_VALUE_LEN, '\0');
+  X25519_keypair(reinterpret_cast<uint8_t*>(&public_key[0]),
+                 private_key.data());
+
+  HpkePrivateKey hpke_private_key;
+  hpke_private_key.set_version(get_version());
+  hpke_private_key.set_private_key(
+      std::string(util::SecretDataAsStringView(private_key)));
+  HpkePublicKey* hpke_public_key = hpke_private_key.mutable_public_key();
+  hpke_public_key->set_version(get_version());
+  *hpke_public_key->mutable_params() = key_format.params();
+  hpke_public_key->set_public_key(public_key);
+  return hpke_private_key;
+}
+
+util::StatusOr<HpkePublicKey> HpkePrivateKeyManager::GetPublicKey(
+    const HpkePrivateKey& private_key) const {
+  return private_key.public_key();
+}
+
+util::Status HpkePrivateKeyManager::ValidateKey(
+    const HpkePrivateKey& key) const {
+  util::Status status = ValidateVersion(key.version(), get_version());
+  if (!status.ok()) return status;
+  if (!key.has_public_key()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Missing public_key.");
+  }
+  status = HpkePublicKeyManager().ValidateKey(key.public_key());
+  if (!status.ok()) return status;
+  if (key.private_key().size() != X25519_PRIVATE_KEY_LEN) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid HPKE private key size.");
+  }
+  return util::OkStatus();
+}
+
+}  // namespace tink
+}  // namespace crypto
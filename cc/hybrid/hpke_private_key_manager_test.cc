@@ -0,0 +1,162 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/hpke_private_key_manager.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/hybrid/hpke_public_key_manager.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/hpke.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::HpkeAead;
+using ::google::crypto::tink::HpkeKdf;
+using ::google::crypto::tink::HpkeKem;
+using ::google::crypto::tink::HpkeKeyFormat;
+using ::google::crypto::tink::HpkePrivateKey;
+using ::google::crypto::tink::HpkePublicKey;
+using ::google::crypto::tink::KeyData;
+using ::testing::Eq;
+using ::testing::Not;
+using ::testing::SizeIs;
+
+HpkeKeyFormat CreateKeyFormat(HpkeAead aead) {
+  HpkeKeyFormat key_format;
+  key_format.mutable_params()->set_kem(HpkeKem::DHKEM_X25519_HKDF_SHA256);
+  key_format.mutable_params()->set_kdf(HpkeKdf::HKDF_SHA256);
+  key_format.mutable_params()->set_aead(aead);
+  return key_format;
+}
+
+TEST(HpkePrivateKeyManagerTest, Basics) {
+  EXPECT_THAT(HpkePrivateKeyManager().get_version(), Eq(0));
+  EXPECT_THAT(HpkePrivateKeyManager().key_material_type(),
+              Eq(KeyData::ASYMMETRIC_PRIVATE));
+  EXPECT_THAT(HpkePrivateKeyManager().get_key_type(),
+              Eq("type.googleapis.com/google.crypto.tink.HpkePrivateKey"));
+}
+
+TEST(HpkePrivateKeyManagerTest, ValidateKeyFormat) {
+  EXPECT_THAT(HpkePrivateKeyManager().ValidateKeyFormat(
+                  CreateKeyFormat(HpkeAead::AES_128_GCM)),
+              IsOk());
+  EXPECT_THAT(HpkePrivateKeyManager().ValidateKeyFormat(HpkeKeyFormat()),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  HpkeKeyFormat key_format = CreateKeyFormat(HpkeAead::AES_128_GCM);
+  key_format.mutable_params()->set_kem(HpkeKem::KEM_UNKNOWN);
+  EXPECT_THAT(HpkePrivateKeyManager().ValidateKeyFormat(key_format),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  key_format = CreateKeyFormat(HpkeAead::AEAD_UNKNOWN);
+  EXPECT_THAT(HpkePrivateKeyManager().ValidateKeyFormat(key_format),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(HpkePrivateKeyManagerTest, CreateKey) {
+  HpkeKeyFormat key_format = CreateKeyFormat(HpkeAead::AES_128_GCM);
+  auto key_or = HpkePrivateKeyManager().CreateKey(key_format);
+  ASSERT_THAT(key_or.status(), IsOk());
+  const HpkePrivateKey& key = key_or.ValueOrDie();
+  EXPECT_THAT(HpkePrivateKeyManager().ValidateKey(key), IsOk());
+  EXPECT_THAT(key.private_key(), SizeIs(32));
+  EXPECT_THAT(key.public_key().public_key(), SizeIs(32));
+  EXPECT_THAT(key.public_key().params().aead(), Eq(HpkeAead::AES_128_GCM));
+  auto public_key_or = HpkePrivateKeyManager().GetPublicKey(key);
+  ASSERT_THAT(public_key_or.status(), IsOk());
+  EXPECT_THAT(public_key_or.ValueOrDie().public_key(),
+              Eq(key.public_key().public_key()));
+
+  auto other_key_or = HpkePrivateKeyManager().CreateKey(key_format);
+  ASSERT_THAT(other_key_or.status(), IsOk());
+  EXPECT_THAT(other_key_or.ValueOrDie().private_key(),
+              Not(Eq(key.private_key())));
+}
+
+TEST(HpkePrivateKeyManagerTest, ValidateKey) {
+  EXPECT_THAT(HpkePrivateKeyManager().ValidateKey(HpkePrivateKey()),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  HpkePrivateKey key =
+      HpkePrivateKeyManager()
+          .CreateKey(CreateKeyFormat(HpkeAead::AES_128_GCM))
+          .ValueOrDie();
+  HpkePrivateKey invalid_key = key;
+  invalid_key.set_version(1);
+  EXPECT_THAT(HpkePrivateKeyManager().ValidateKey(invalid_key),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  invalid_key = key;
+  invalid_key.set_private_key("short");
+  EXPECT_THAT(HpkePrivateKeyManager().ValidateKey(invalid_key),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  invalid_key = key;
+  invalid_key.mutable_public_key()->set_public_key("short");
+  EXPECT_THAT(HpkePrivateKeyManager().ValidateKey(invalid_key),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(HpkePrivateKeyManagerTest, EncryptDecrypt) {
+  for (HpkeAead aead : {HpkeAead::AES_128_GCM, HpkeAead::AES_256_GCM,
+                        HpkeAead::CHACHA20_POLY1305}) {
+    HpkePrivateKey private_key =
+        HpkePrivateKeyManager().CreateKey(CreateKeyFormat(aead)).ValueOrDie();
+    auto decrypt_or =
+        HpkePrivateKeyManager().GetPrimitive<HybridDecrypt>(private_key);
+    ASSERT_THAT(decrypt_or.status(), IsOk());
+    auto encrypt_or = HpkePublicKeyManager().GetPrimitive<HybridEncrypt>(
+        private_key.public_key());
+    ASSERT_THAT(encrypt_or.status(), IsOk());
+    auto& decrypt = decrypt_or.ValueOrDie();
+    auto& encrypt = encrypt_or.ValueOrDie();
+
+    std::string ciphertext =
+        encrypt->Encrypt("plaintext", "context info").ValueOrDie();
+    // The encapsulated key, the plaintext and the tag.
+    EXPECT_THAT(ciphertext, SizeIs(32 + 9 + 16));
+    auto plaintext_or = decrypt->Decrypt(ciphertext, "context info");
+    ASSERT_THAT(plaintext_or.status(), IsOk());
+    EXPECT_THAT(plaintext_or.ValueOrDie(), Eq("plaintext"));
+    EXPECT_THAT(encrypt->Encrypt("plaintext", "context info").ValueOrDie(),
+                Not(Eq(ciphertext)));
+
+    EXPECT_THAT(decrypt->Decrypt(ciphertext, "other context info").status(),
+                Not(IsOk()));
+    for (int i : {0, 31, 32, 56}) {
+      std::string modified_ciphertext = ciphertext;
+      modified_ciphertext[i] ^= 1;
+      EXPECT_THAT(decrypt->Decrypt(modified_ciphertext, "context info").status(),
+                  Not(IsOk()));
+    }
+    EXPECT_THAT(decrypt->Decrypt(ciphertext.substr(0, 31), "context info")
+                    .status(),
+                Not(IsOk()));
+  }
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
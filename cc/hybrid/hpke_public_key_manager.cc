@@ -0,0 +1,46 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/hpke_public_key_manager.h"
+
+#include "tink/hybrid/internal/hpke_context_boringssl.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using ::google::crypto::tink::HpkePublicKey;
+
+util::Status HpkePublicKeyManager::ValidateKey(
+    const HpkePublicKey& key) const {
+  util::Status status = ValidateVersion(key.version(), get_version());
+  if (!status.ok()) return status;
+  status = internal::ValidateHpkeParams(key.params());
+  if (!status.ok()) return status;
+  auto enc_size_or = internal::HpkeEncapsulatedKeySize(key.params().kem());
+  if (!enc_size_or.ok()) return enc_size_or.status();
+  if (key.public_key().size() != enc_size_or.ValueOrDie()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid HPKE public key size.");
+  }
+  return util::OkStatus();
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,90 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/hpke_public_key_manager.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/hpke.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::HpkeAead;
+using ::google::crypto::tink::HpkeKdf;
+using ::google::crypto::tink::HpkeKem;
+using ::google::crypto::tink::HpkePublicKey;
+using ::google::crypto::tink::KeyData;
+using ::testing::Eq;
+
+HpkePublicKey CreatePublicKey() {
+  HpkePublicKey key;
+  key.mutable_params()->set_kem(HpkeKem::DHKEM_X25519_HKDF_SHA256);
+  key.mutable_params()->set_kdf(HpkeKdf::HKDF_SHA256);
+  key.mutable_params()->set_aead(HpkeAead::AES_128_GCM);
+  // Test vector of RFC 9180, Appendix A.1.1.
+  key.set_public_key(std::string(
+      "\x39\x48\xcf\xe0\xad\x1d\xdb\x69\x5d\x78\x0e\x59\x07\x71\x95\xda"
+      "\x6c\x56\x50\x6b\x02\x73\x29\x79\x4a\xb0\x2b\xca\x80\x81\x5c\x4d",
+      32));
+  return key;
+}
+
+TEST(HpkePublicKeyManagerTest, Basics) {
+  EXPECT_THAT(HpkePublicKeyManager().get_version(), Eq(0));
+  EXPECT_THAT(HpkePublicKeyManager().key_material_type(),
+              Eq(KeyData::ASYMMETRIC_PUBLIC));
+  EXPECT_THAT(HpkePublicKeyManager().get_key_type(),
+              Eq("type.googleapis.com/google.crypto.tink.HpkePublicKey"));
+}
+
+TEST(HpkePublicKeyManagerTest, ValidateKey) {
+  EXPECT_THAT(HpkePublicKeyManager().ValidateKey(CreatePublicKey()), IsOk());
+  EXPECT_THAT(HpkePublicKeyManager().ValidateKey(HpkePublicKey()),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  HpkePublicKey key = CreatePublicKey();
+  key.set_version(1);
+  EXPECT_THAT(HpkePublicKeyManager().ValidateKey(key),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  key = CreatePublicKey();
+  key.mutable_params()->set_kdf(HpkeKdf::KDF_UNKNOWN);
+  EXPECT_THAT(HpkePublicKeyManager().ValidateKey(key),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  key = CreatePublicKey();
+  key.set_public_key("short");
+  EXPECT_THAT(HpkePublicKeyManager().ValidateKey(key),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(HpkePublicKeyManagerTest, GetPrimitive) {
+  auto encrypt_or =
+      HpkePublicKeyManager().GetPrimitive<HybridEncrypt>(CreatePublicKey());
+  ASSERT_THAT(encrypt_or.status(), IsOk());
+  EXPECT_THAT(encrypt_or.ValueOrDie()->Encrypt("plaintext", "").status(),
+              IsOk());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -20,6 +20,8 @@
 #include "tink/aead/aead_config.h"
 #include "tink/hybrid/ecies_aead_hkdf_private_key_manager.h"
 #include "tink/hybrid/ecies_aead_hkdf_public_key_manager.h"
+#include "tink/hybrid/hpke_private_key_manager.h"
+#include "tink/hybrid/hpke_public_key_manager.h"
 #include "tink/config/config_util.h"
 #include "tink/config/tink_fips.h"
 #include "tink/registry.h"
@@ -64,6 +66,10 @@ util::Status HybridConfig::Register() {
       absl::make_unique<EciesAeadHkdfPrivateKeyManager>(),
       absl::make_unique<EciesAeadHkdfPublicKeyManager>(), true);
   if (!status.ok()) return status;
+  status = Registry::RegisterAsymmetricKeyManagers(
+      absl::make_unique<HpkePrivateKeyManager>(),
+      absl::make_unique<HpkePublicKeyManager>(), true);
+  if (!status.ok()) return status;
 
   return util::OkStatus();
 }
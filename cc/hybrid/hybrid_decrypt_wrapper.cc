@@ -16,8 +16,15 @@
 
 #include "tink/hybrid/hybrid_decrypt_wrapper.h"
 
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/crypto_format.h"
 #include "tink/hybrid_decrypt.h"
+#include "tink/internal/monitored_operation.h"
 #include "tink/primitive_set.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/status.h"
@@ -38,6 +45,10 @@ class HybridDecryptSetWrapper : public HybridDecrypt {
       absl::string_view ciphertext,
       absl::string_view context_info) const override;
 
+  crypto::tink::util::StatusOr<std::vector<std::string>> DecryptBatch(
+      absl::Span<const absl::string_view> ciphertexts,
+      absl::string_view context_info) const override;
+
   ~HybridDecryptSetWrapper() override {}
 
  private:
@@ -50,6 +61,7 @@ util::StatusOr<std::string> HybridDecryptSetWrapper::Decrypt(
   // regardless of whether the size is 0.
   context_info = subtle::SubtleUtilBoringSSL::EnsureNonNull(context_info);
 
+  internal::MonitoredOperation operation("hybrid_decrypt", "decrypt");
   if (ciphertext.length() > CryptoFormat::kNonRawPrefixSize) {
     absl::string_view key_id =
         ciphertext.substr(0, CryptoFormat::kNonRawPrefixSize);
@@ -59,9 +71,11 @@ util::StatusOr<std::string> HybridDecryptSetWrapper::Decrypt(
           ciphertext.substr(CryptoFormat::kNonRawPrefixSize);
       for (auto& hybrid_decrypt_entry : *(primitives_result.ValueOrDie())) {
         HybridDecrypt& hybrid_decrypt = hybrid_decrypt_entry->get_primitive();
+        operation.KeyTried();
         auto decrypt_result =
             hybrid_decrypt.Decrypt(raw_ciphertext, context_info);
         if (decrypt_result.ok()) {
+          operation.Succeeded(hybrid_decrypt_entry->get_key_id());
           return std::move(decrypt_result.ValueOrDie());
         } else {
           // LOG that a matching key didn't decrypt the ciphertext.
@@ -73,10 +87,13 @@ util::StatusOr<std::string> HybridDecryptSetWrapper::Decrypt(
   // No matching key succeeded with decryption, try all RAW keys.
   auto raw_primitives_result = hybrid_decrypt_set_->get_raw_primitives();
   if (raw_primitives_result.ok()) {
+    operation.RawKeysTried();
     for (auto& hybrid_decrypt_entry : *(raw_primitives_result.ValueOrDie())) {
         HybridDecrypt& hybrid_decrypt = hybrid_decrypt_entry->get_primitive();
+      operation.KeyTried();
       auto decrypt_result = hybrid_decrypt.Decrypt(ciphertext, context_info);
       if (decrypt_result.ok()) {
+        operation.Succeeded(hybrid_decrypt_entry->get_key_id());
         return std::move(decrypt_result.ValueOrDie());
       }
     }
@@ -84,6 +101,57 @@ util::StatusOr<std::string> HybridDecryptSetWrapper::Decrypt(
   return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
 }
 
+util::StatusOr<std::vector<std::string>> HybridDecryptSetWrapper::DecryptBatch(
+    absl::Span<const absl::string_view> ciphertexts,
+    absl::string_view context_info) const {
+  context_info = subtle::SubtleUtilBoringSSL::EnsureNonNull(context_info);
+
+  // The ciphertexts with the prefix of the primary key go to the primary in
+  // one call, so that it can decrypt them in parallel.
+  auto primary = hybrid_decrypt_set_->get_primary();
+  absl::string_view key_id = primary->get_identifier();
+  std::vector<int> primary_indices;
+  std::vector<absl::string_view> primary_ciphertexts;
+  if (!key_id.empty()) {
+    for (int i = 0; i < ciphertexts.size(); i++) {
+      if (ciphertexts[i].length() > CryptoFormat::kNonRawPrefixSize &&
+          ciphertexts[i].substr(0, CryptoFormat::kNonRawPrefixSize) ==
+              key_id) {
+        primary_indices.push_back(i);
+        primary_ciphertexts.push_back(
+            ciphertexts[i].substr(CryptoFormat::kNonRawPrefixSize));
+      }
+    }
+  }
+
+  std::vector<std::string> plaintexts(ciphertexts.size());
+  std::vector<bool> decrypted(ciphertexts.size(), false);
+  if (!primary_ciphertexts.empty()) {
+    internal::MonitoredOperation operation("hybrid_decrypt", "decrypt");
+    operation.KeyTried();
+    auto decrypt_result = primary->get_primitive().DecryptBatch(
+        primary_ciphertexts, context_info);
+    if (decrypt_result.ok()) {
+      operation.Succeeded(primary->get_key_id());
+      for (int j = 0; j < primary_indices.size(); j++) {
+        plaintexts[primary_indices[j]] =
+            std::move(decrypt_result.ValueOrDie()[j]);
+        decrypted[primary_indices[j]] = true;
+      }
+    }
+  }
+
+  // Everything else, including the batch of the primary if one of its
+  // ciphertexts failed, is decrypted one by one, trying all matching keys.
+  for (int i = 0; i < ciphertexts.size(); i++) {
+    if (decrypted[i]) continue;
+    auto decrypt_result = Decrypt(ciphertexts[i], context_info);
+    if (!decrypt_result.ok()) return decrypt_result.status();
+    plaintexts[i] = std::move(decrypt_result.ValueOrDie());
+  }
+  return std::move(plaintexts);
+}
+
 util::Status Validate(PrimitiveSet<HybridDecrypt>* hybrid_decrypt_set) {
   if (hybrid_decrypt_set == nullptr) {
     return util::Status(util::error::INTERNAL,
@@ -104,6 +172,7 @@ HybridDecryptWrapper::Wrap(
     std::unique_ptr<PrimitiveSet<HybridDecrypt>> primitive_set) const {
   util::Status status = Validate(primitive_set.get());
   if (!status.ok()) return status;
+  primitive_set->Freeze();
   std::unique_ptr<HybridDecrypt> hybrid_decrypt(
       new HybridDecryptSetWrapper(std::move(primitive_set)));
   return std::move(hybrid_decrypt);
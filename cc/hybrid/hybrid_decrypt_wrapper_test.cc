@@ -16,7 +16,13 @@
 
 #include "tink/hybrid/hybrid_decrypt_wrapper.h"
 
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
 #include "tink/hybrid_decrypt.h"
 #include "tink/primitive_set.h"
 #include "tink/util/status.h"
@@ -102,7 +108,7 @@ TEST_F(HybridDecryptSetWrapperTest, Basic) {
     entry_result = hybrid_decrypt_set->AddPrimitive(std::move(hybrid_decrypt),
                                                     keyset.key_info(1));
     ASSERT_TRUE(entry_result.ok());
-    std::string prefix_id_1 = entry_result.ValueOrDie()->get_identifier();
+    std::string prefix_id_1(entry_result.ValueOrDie()->get_identifier());
     hybrid_decrypt.reset(new DummyHybridDecrypt(hybrid_name_2));
     entry_result = hybrid_decrypt_set->AddPrimitive(std::move(hybrid_decrypt),
                                                     keyset.key_info(2));
@@ -160,6 +166,55 @@ TEST_F(HybridDecryptSetWrapperTest, Basic) {
   }
 }
 
+TEST_F(HybridDecryptSetWrapperTest, DecryptBatch) {
+  KeysetInfo keyset;
+  KeysetInfo::KeyInfo* key = keyset.add_key_info();
+  key->set_output_prefix_type(OutputPrefixType::RAW);
+  key->set_key_id(1234543);
+  key->set_status(KeyStatusType::ENABLED);
+  key = keyset.add_key_info();
+  key->set_output_prefix_type(OutputPrefixType::TINK);
+  key->set_key_id(7213743);
+  key->set_status(KeyStatusType::ENABLED);
+
+  std::unique_ptr<PrimitiveSet<HybridDecrypt>> hybrid_decrypt_set(
+      new PrimitiveSet<HybridDecrypt>());
+  ASSERT_THAT(hybrid_decrypt_set
+                  ->AddPrimitive(absl::make_unique<DummyHybridDecrypt>("raw"),
+                                 keyset.key_info(0))
+                  .status(),
+              IsOk());
+  auto entry_result = hybrid_decrypt_set->AddPrimitive(
+      absl::make_unique<DummyHybridDecrypt>("tink"), keyset.key_info(1));
+  ASSERT_THAT(entry_result.status(), IsOk());
+  std::string prefix(entry_result.ValueOrDie()->get_identifier());
+  ASSERT_THAT(hybrid_decrypt_set->set_primary(entry_result.ValueOrDie()),
+              IsOk());
+  auto hybrid_decrypt_result =
+      HybridDecryptWrapper().Wrap(std::move(hybrid_decrypt_set));
+  ASSERT_THAT(hybrid_decrypt_result.status(), IsOk());
+  auto hybrid_decrypt = std::move(hybrid_decrypt_result.ValueOrDie());
+
+  std::string context_info = "some_context";
+  std::string primary_1 =
+      prefix +
+      DummyHybridEncrypt("tink").Encrypt("first", context_info).ValueOrDie();
+  std::string raw =
+      DummyHybridEncrypt("raw").Encrypt("second", context_info).ValueOrDie();
+  std::string primary_2 =
+      prefix +
+      DummyHybridEncrypt("tink").Encrypt("third", context_info).ValueOrDie();
+  std::vector<absl::string_view> ciphertexts = {primary_1, raw, primary_2};
+  auto plaintexts_result =
+      hybrid_decrypt->DecryptBatch(ciphertexts, context_info);
+  ASSERT_THAT(plaintexts_result.status(), IsOk());
+  EXPECT_THAT(plaintexts_result.ValueOrDie(),
+              testing::ElementsAre("first", "second", "third"));
+
+  ciphertexts.push_back("some bad ciphertext");
+  EXPECT_FALSE(hybrid_decrypt->DecryptBatch(ciphertexts, context_info).ok());
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
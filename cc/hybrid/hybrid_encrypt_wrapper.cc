@@ -16,6 +16,8 @@
 
 #include "tink/hybrid/hybrid_encrypt_wrapper.h"
 
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "tink/crypto_format.h"
 #include "tink/hybrid_encrypt.h"
 #include "tink/primitive_set.h"
@@ -71,8 +73,8 @@ util::StatusOr<std::string> HybridEncryptSetWrapper::Encrypt(
   auto encrypt_result =
       primary->get_primitive().Encrypt(plaintext, context_info);
   if (!encrypt_result.ok()) return encrypt_result.status();
-  const std::string& key_id = primary->get_identifier();
-  return key_id + encrypt_result.ValueOrDie();
+  absl::string_view key_id = primary->get_identifier();
+  return absl::StrCat(key_id, encrypt_result.ValueOrDie());
 }
 
 }  // anonymous namespace
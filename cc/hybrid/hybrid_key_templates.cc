@@ -21,6 +21,7 @@
 #include "tink/daead/deterministic_aead_key_templates.h"
 #include "proto/common.pb.h"
 #include "proto/ecies_aead_hkdf.pb.h"
+#include "proto/hpke.pb.h"
 #include "proto/tink.pb.h"
 
 namespace crypto {
@@ -31,6 +32,10 @@ using google::crypto::tink::EciesAeadHkdfKeyFormat;
 using google::crypto::tink::EcPointFormat;
 using google::crypto::tink::EllipticCurveType;
 using google::crypto::tink::HashType;
+using google::crypto::tink::HpkeAead;
+using google::crypto::tink::HpkeKdf;
+using google::crypto::tink::HpkeKem;
+using google::crypto::tink::HpkeKeyFormat;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::OutputPrefixType;
 
@@ -57,6 +62,20 @@ KeyTemplate* NewEciesAeadHkdfKeyTemplate(
   return key_template;
 }
 
+KeyTemplate* NewHpkeKeyTemplate(HpkeKem kem, HpkeKdf kdf, HpkeAead aead,
+                               OutputPrefixType prefix_type) {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.HpkePrivateKey");
+  key_template->set_output_prefix_type(prefix_type);
+  HpkeKeyFormat key_format;
+  key_format.mutable_params()->set_kem(kem);
+  key_format.mutable_params()->set_kdf(kdf);
+  key_format.mutable_params()->set_aead(aead);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
 }  // anonymous namespace
 
 // static
@@ -163,5 +182,29 @@ HybridKeyTemplates::EciesX25519HkdfHmacSha256DeterministicAesSiv() {
   return *key_template;
 }
 
+// static
+const KeyTemplate& HybridKeyTemplates::HpkeX25519HkdfSha256Aes128Gcm() {
+  static const KeyTemplate* key_template = NewHpkeKeyTemplate(
+      HpkeKem::DHKEM_X25519_HKDF_SHA256, HpkeKdf::HKDF_SHA256,
+      HpkeAead::AES_128_GCM, OutputPrefixType::TINK);
+  return *key_template;
+}
+
+// static
+const KeyTemplate& HybridKeyTemplates::HpkeX25519HkdfSha256Aes256Gcm() {
+  static const KeyTemplate* key_template = NewHpkeKeyTemplate(
+      HpkeKem::DHKEM_X25519_HKDF_SHA256, HpkeKdf::HKDF_SHA256,
+      HpkeAead::AES_256_GCM, OutputPrefixType::TINK);
+  return *key_template;
+}
+
+// static
+const KeyTemplate& HybridKeyTemplates::HpkeX25519HkdfSha256ChaCha20Poly1305() {
+  static const KeyTemplate* key_template = NewHpkeKeyTemplate(
+      HpkeKem::DHKEM_X25519_HKDF_SHA256, HpkeKdf::HKDF_SHA256,
+      HpkeAead::CHACHA20_POLY1305, OutputPrefixType::TINK);
+  return *key_template;
+}
+
 }  // namespace tink
 }  // namespace crypto
@@ -21,10 +21,12 @@
 #include "tink/aead/aead_key_templates.h"
 #include "tink/daead/deterministic_aead_key_templates.h"
 #include "tink/hybrid/ecies_aead_hkdf_private_key_manager.h"
+#include "tink/hybrid/hpke_private_key_manager.h"
 #include "tink/hybrid/hybrid_config.h"
 #include "tink/util/test_matchers.h"
 #include "proto/common.pb.h"
 #include "proto/ecies_aead_hkdf.pb.h"
+#include "proto/hpke.pb.h"
 #include "proto/tink.pb.h"
 
 namespace crypto {
@@ -36,6 +38,10 @@ using google::crypto::tink::EciesAeadHkdfKeyFormat;
 using google::crypto::tink::EcPointFormat;
 using google::crypto::tink::EllipticCurveType;
 using google::crypto::tink::HashType;
+using google::crypto::tink::HpkeAead;
+using google::crypto::tink::HpkeKdf;
+using google::crypto::tink::HpkeKem;
+using google::crypto::tink::HpkeKeyFormat;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::OutputPrefixType;
 
@@ -348,6 +354,38 @@ TEST_F(HybridKeyTemplatesTest,
   EXPECT_THAT(key_manager.ValidateKeyFormat(key_format), IsOk());
 }
 
+TEST_F(HybridKeyTemplatesTest, testHpkeX25519HkdfSha256) {
+  std::string type_url = "type.googleapis.com/google.crypto.tink.HpkePrivateKey";
+  struct {
+    const KeyTemplate& key_template;
+    HpkeAead aead;
+  } test_cases[] = {
+      {HybridKeyTemplates::HpkeX25519HkdfSha256Aes128Gcm(),
+       HpkeAead::AES_128_GCM},
+      {HybridKeyTemplates::HpkeX25519HkdfSha256Aes256Gcm(),
+       HpkeAead::AES_256_GCM},
+      {HybridKeyTemplates::HpkeX25519HkdfSha256ChaCha20Poly1305(),
+       HpkeAead::CHACHA20_POLY1305},
+  };
+  HpkePrivateKeyManager key_manager;
+  for (const auto& test_case : test_cases) {
+    const KeyTemplate& key_template = test_case.key_template;
+    EXPECT_EQ(type_url, key_template.type_url());
+    EXPECT_EQ(OutputPrefixType::TINK, key_template.output_prefix_type());
+    HpkeKeyFormat key_format;
+    EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+    EXPECT_EQ(HpkeKem::DHKEM_X25519_HKDF_SHA256, key_format.params().kem());
+    EXPECT_EQ(HpkeKdf::HKDF_SHA256, key_format.params().kdf());
+    EXPECT_EQ(test_case.aead, key_format.params().aead());
+
+    // Check that the template works with the key manager.
+    EXPECT_EQ(key_manager.get_key_type(), key_template.type_url());
+    EXPECT_THAT(key_manager.ValidateKeyFormat(key_format), IsOk());
+  }
+  EXPECT_EQ(&HybridKeyTemplates::HpkeX25519HkdfSha256Aes128Gcm(),
+            &HybridKeyTemplates::HpkeX25519HkdfSha256Aes128Gcm());
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
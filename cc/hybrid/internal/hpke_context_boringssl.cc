@@ -0,0 +1,344 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/internal/hpke_context_boringssl.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "openssl/aead.h"
+#include "openssl/curve25519.h"
+#include "openssl/digest.h"
+#include "openssl/hkdf.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+using ::google::crypto::tink::HpkeAead;
+using ::google::crypto::tink::HpkeKdf;
+using ::google::crypto::tink::HpkeKem;
+using ::google::crypto::tink::HpkeParams;
+
+namespace {
+
+// Algorithm identifiers of RFC 9180, Section 7.
+constexpr uint16_t kX25519HkdfSha256KemId = 0x0020;
+constexpr uint16_t kHkdfSha256KdfId = 0x0001;
+constexpr uint16_t kAes128GcmAeadId = 0x0001;
+constexpr uint16_t kAes256GcmAeadId = 0x0002;
+constexpr uint16_t kChaCha20Poly1305AeadId = 0x0003;
+
+constexpr size_t kSha256DigestSize = 32;
+constexpr size_t kNonceSize = 12;
+constexpr char kHpkeVersionLabel[] = "HPKE-v1";
+
+// I2OSP(value, 2).
+std::string TwoByteBigEndian(uint16_t value) {
+  return std::string({static_cast<char>(value >> 8),
+                      static_cast<char>(value & 0xff)});
+}
+
+std::string KemSuiteId() {
+  return absl::StrCat("KEM", TwoByteBigEndian(kX25519HkdfSha256KemId));
+}
+
+struct AeadAlgorithm {
+  uint16_t id;
+  const EVP_AEAD* aead;
+};
+
+util::StatusOr<AeadAlgorithm> GetAeadAlgorithm(HpkeAead aead) {
+  switch (aead) {
+    case HpkeAead::AES_128_GCM:
+      return AeadAlgorithm{kAes128GcmAeadId, EVP_aead_aes_128_gcm()};
+    case HpkeAead::AES_256_GCM:
+      return AeadAlgorithm{kAes256GcmAeadId, EVP_aead_aes_256_gcm()};
+    case HpkeAead::CHACHA20_POLY1305:
+      return AeadAlgorithm{kChaCha20Poly1305AeadId,
+                           EVP_aead_chacha20_poly1305()};
+    default:
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          absl::StrCat("Unsupported HPKE AEAD: ", aead));
+  }
+}
+
+// LabeledExtract() of RFC 9180, Section 4, with HKDF-SHA256.
+util::SecretData LabeledExtract(absl::string_view suite_id,
+                                absl::string_view salt,
+                                absl::string_view label,
+                                absl::string_view ikm) {
+  // The input keying material is secret, so it is assembled in SecretData.
+  util::SecretData labeled_ikm = util::SecretDataFromStringView(
+      absl::StrCat(kHpkeVersionLabel, suite_id, label));
+  labeled_ikm.insert(labeled_ikm.end(), ikm.begin(), ikm.end());
+  util::SecretData prk(kSha256DigestSize);
+  size_t prk_size;
+  HKDF_extract(prk.data(), &prk_size, EVP_sha256(), labeled_ikm.data(),
+               labeled_ikm.size(), reinterpret_cast<const uint8_t*>(salt.data()),
+               salt.size());
+  return prk;
+}
+
+// LabeledExpand() of RFC 9180, Section 4, with HKDF-SHA256.
+util::StatusOr<util::SecretData> LabeledExpand(absl::string_view suite_id,
+                                               const util::SecretData& prk,
+                                               absl::string_view label,
+                                               absl::string_view info,
+                                               size_t length) {
+  if (length > 255 * kSha256DigestSize) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Requested HPKE secret is too long");
+  }
+  std::string labeled_info =
+      absl::StrCat(TwoByteBigEndian(length), kHpkeVersionLabel, suite_id,
+                   label, info);
+  util::SecretData out(length);
+  if (HKDF_expand(out.data(), out.size(), EVP_sha256(), prk.data(), prk.size(),
+                  reinterpret_cast<const uint8_t*>(labeled_info.data()),
+                  labeled_info.size()) != 1) {
+    return util::Status(util::error::INTERNAL, "HKDF_expand failed");
+  }
+  return out;
+}
+
+// ExtractAndExpand() of DHKEM(X25519, HKDF-SHA256), RFC 9180, Section 4.1.
+util::StatusOr<util::SecretData> KemSharedSecret(
+    const util::SecretData& dh, absl::string_view encapsulated_key,
+    absl::string_view recipient_public_key) {
+  std::string suite_id = KemSuiteId();
+  util::SecretData eae_prk = LabeledExtract(
+      suite_id, "", "eae_prk", util::SecretDataAsStringView(dh));
+  return LabeledExpand(suite_id, eae_prk, "shared_secret",
+                       absl::StrCat(encapsulated_key, recipient_public_key),
+                       kSha256DigestSize);
+}
+
+// Computes the X25519 shared value of 'private_key' and 'public_key'.
+util::StatusOr<util::SecretData> X25519Dh(const util::SecretData& private_key,
+                                          absl::string_view public_key) {
+  if (private_key.size() != X25519_PRIVATE_KEY_LEN ||
+      public_key.size() != X25519_PUBLIC_VALUE_LEN) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid X25519 key size");
+  }
+  util::SecretData dh(X25519_SHARED_KEY_LEN);
+  // X25519() fails if the result is all zeros, i.e. for small order points.
+  if (X25519(dh.data(), private_key.data(),
+             reinterpret_cast<const uint8_t*>(public_key.data())) != 1) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "X25519 key agreement failed");
+  }
+  return dh;
+}
+
+}  // namespace
+
+util::Status ValidateHpkeParams(const HpkeParams& params) {
+  if (params.kem() != HpkeKem::DHKEM_X25519_HKDF_SHA256) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        absl::StrCat("Unsupported HPKE KEM: ", params.kem()));
+  }
+  if (params.kdf() != HpkeKdf::HKDF_SHA256) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        absl::StrCat("Unsupported HPKE KDF: ", params.kdf()));
+  }
+  return GetAeadAlgorithm(params.aead()).status();
+}
+
+util::StatusOr<size_t> HpkeEncapsulatedKeySize(HpkeKem kem) {
+  if (kem != HpkeKem::DHKEM_X25519_HKDF_SHA256) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        absl::StrCat("Unsupported HPKE KEM: ", kem));
+  }
+  return X25519_PUBLIC_VALUE_LEN;
+}
+
+// static
+util::StatusOr<std::unique_ptr<HpkeContextBoringSsl>>
+HpkeContextBoringSsl::SetupSender(const HpkeParams& params,
+                                  absl::string_view recipient_public_key,
+                                  absl::string_view info) {
+  return SetupSenderWithEphemeralKey(
+      params, recipient_public_key, info,
+      subtle::Random::GetRandomKeyBytes(X25519_PRIVATE_KEY_LEN));
+}
+
+// static
+util::StatusOr<std::unique_ptr<HpkeContextBoringSsl>>
+HpkeContextBoringSsl::SetupSenderWithEphemeralKey(
+    const HpkeParams& params, absl::string_view recipient_public_key,
+    absl::string_view info, const util::SecretData& ephemeral_private_key) {
+  util::Status status = ValidateHpkeParams(params);
+  if (!status.ok()) return status;
+  auto dh_or = X25519Dh(ephemeral_private_key, recipient_public_key);
+  if (!dh_or.ok()) return dh_or.status();
+  std::string encapsulated_key(X25519_PUBLIC_VALUE_LEN, '\0');
+  X25519_public_from_private(reinterpret_cast<uint8_t*>(&encapsulated_key[0]),
+                             ephemeral_private_key.data());
+  auto shared_secret_or = KemSharedSecret(dh_or.ValueOrDie(), encapsulated_key,
+                                          recipient_public_key);
+  if (!shared_secret_or.ok()) return shared_secret_or.status();
+  return KeySchedule(params, shared_secret_or.ValueOrDie(), info,
+                     std::move(encapsulated_key));
+}
+
+// static
+util::StatusOr<std::unique_ptr<HpkeContextBoringSsl>>
+HpkeContextBoringSsl::SetupRecipient(
+    const HpkeParams& params, const util::SecretData& recipient_private_key,
+    absl::string_view recipient_public_key, absl::string_view encapsulated_key,
+    absl::string_view info) {
+  util::Status status = ValidateHpkeParams(params);
+  if (!status.ok()) return status;
+  if (recipient_public_key.size() != X25519_PUBLIC_VALUE_LEN) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid X25519 key size");
+  }
+  auto dh_or = X25519Dh(recipient_private_key, encapsulated_key);
+  if (!dh_or.ok()) return dh_or.status();
+  auto shared_secret_or = KemSharedSecret(dh_or.ValueOrDie(), encapsulated_key,
+                                          recipient_public_key);
+  if (!shared_secret_or.ok()) return shared_secret_or.status();
+  return KeySchedule(params, shared_secret_or.ValueOrDie(), info,
+                     std::string(encapsulated_key));
+}
+
+// static
+util::StatusOr<std::unique_ptr<HpkeContextBoringSsl>>
+HpkeContextBoringSsl::KeySchedule(const HpkeParams& params,
+                                  const util::SecretData& shared_secret,
+                                  absl::string_view info,
+                                  std::string encapsulated_key) {
+  auto aead_or = GetAeadAlgorithm(params.aead());
+  if (!aead_or.ok()) return aead_or.status();
+  const AeadAlgorithm& aead = aead_or.ValueOrDie();
+  std::string suite_id = absl::StrCat(
+      "HPKE", TwoByteBigEndian(kX25519HkdfSha256KemId),
+      TwoByteBigEndian(kHkdfSha256KdfId), TwoByteBigEndian(aead.id));
+
+  // Base mode: mode 0, empty PSK and PSK ID.
+  util::SecretData psk_id_hash = LabeledExtract(suite_id, "", "psk_id_hash", "");
+  util::SecretData info_hash = LabeledExtract(suite_id, "", "info_hash", info);
+  std::string key_schedule_context =
+      absl::StrCat(std::string(1, '\0'),
+                   util::SecretDataAsStringView(psk_id_hash),
+                   util::SecretDataAsStringView(info_hash));
+  util::SecretData secret = LabeledExtract(
+      suite_id, util::SecretDataAsStringView(shared_secret), "secret", "");
+
+  auto key_or = LabeledExpand(suite_id, secret, "key", key_schedule_context,
+                              EVP_AEAD_key_length(aead.aead));
+  if (!key_or.ok()) return key_or.status();
+  auto base_nonce_or = LabeledExpand(suite_id, secret, "base_nonce",
+                                     key_schedule_context, kNonceSize);
+  if (!base_nonce_or.ok()) return base_nonce_or.status();
+  auto exporter_secret_or = LabeledExpand(
+      suite_id, secret, "exp", key_schedule_context, kSha256DigestSize);
+  if (!exporter_secret_or.ok()) return exporter_secret_or.status();
+
+  const util::SecretData& key = key_or.ValueOrDie();
+  bssl::UniquePtr<EVP_AEAD_CTX> aead_ctx(
+      EVP_AEAD_CTX_new(aead.aead, key.data(), key.size(),
+                       EVP_AEAD_DEFAULT_TAG_LENGTH));
+  if (aead_ctx == nullptr) {
+    return util::Status(util::error::INTERNAL,
+                        "could not initialize EVP_AEAD_CTX");
+  }
+  return absl::WrapUnique(new HpkeContextBoringSsl(
+      std::move(suite_id), std::move(encapsulated_key), std::move(aead_ctx),
+      std::move(base_nonce_or).ValueOrDie(),
+      std::move(exporter_secret_or).ValueOrDie()));
+}
+
+std::string HpkeContextBoringSsl::ComputeNonce() const {
+  std::string nonce(util::SecretDataAsStringView(base_nonce_));
+  for (int i = 0; i < 8; i++) {
+    nonce[kNonceSize - 1 - i] ^=
+        static_cast<char>((sequence_number_ >> (8 * i)) & 0xff);
+  }
+  return nonce;
+}
+
+util::StatusOr<std::string> HpkeContextBoringSsl::Seal(
+    absl::string_view plaintext, absl::string_view associated_data) {
+  if (sequence_number_ == UINT64_MAX) {
+    return util::Status(util::error::RESOURCE_EXHAUSTED,
+                        "HPKE sequence number overflow");
+  }
+  std::string nonce = ComputeNonce();
+  std::string ciphertext(
+      plaintext.size() + EVP_AEAD_max_overhead(EVP_AEAD_CTX_aead(aead_ctx_.get())),
+      '\0');
+  size_t ciphertext_size;
+  if (EVP_AEAD_CTX_seal(
+          aead_ctx_.get(), reinterpret_cast<uint8_t*>(&ciphertext[0]),
+          &ciphertext_size, ciphertext.size(),
+          reinterpret_cast<const uint8_t*>(nonce.data()), nonce.size(),
+          reinterpret_cast<const uint8_t*>(plaintext.data()), plaintext.size(),
+          reinterpret_cast<const uint8_t*>(associated_data.data()),
+          associated_data.size()) != 1) {
+    return util::Status(util::error::INTERNAL, "EVP_AEAD_CTX_seal failed");
+  }
+  ciphertext.resize(ciphertext_size);
+  sequence_number_++;
+  return ciphertext;
+}
+
+util::StatusOr<std::string> HpkeContextBoringSsl::Open(
+    absl::string_view ciphertext, absl::string_view associated_data) {
+  if (sequence_number_ == UINT64_MAX) {
+    return util::Status(util::error::RESOURCE_EXHAUSTED,
+                        "HPKE sequence number overflow");
+  }
+  std::string nonce = ComputeNonce();
+  std::string plaintext(ciphertext.size(), '\0');
+  size_t plaintext_size;
+  if (EVP_AEAD_CTX_open(
+          aead_ctx_.get(), reinterpret_cast<uint8_t*>(&plaintext[0]),
+          &plaintext_size, plaintext.size(),
+          reinterpret_cast<const uint8_t*>(nonce.data()), nonce.size(),
+          reinterpret_cast<const uint8_t*>(ciphertext.data()),
+          ciphertext.size(),
+          reinterpret_cast<const uint8_t*>(associated_data.data()),
+          associated_data.size()) != 1) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Decryption failed");
+  }
+  plaintext.resize(plaintext_size);
+  sequence_number_++;
+  return plaintext;
+}
+
+util::StatusOr<util::SecretData> HpkeContextBoringSsl::Export(
+    absl::string_view exporter_context, size_t length) const {
+  return LabeledExpand(suite_id_, exporter_secret_, "sec", exporter_context,
+                       length);
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
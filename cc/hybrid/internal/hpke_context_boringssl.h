@@ -0,0 +1,129 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_HYBRID_INTERNAL_HPKE_CONTEXT_BORINGSSL_H_
+#define TINK_HYBRID_INTERNAL_HPKE_CONTEXT_BORINGSSL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "openssl/aead.h"
+#include "openssl/base.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// Returns OK if 'params' name a supported HPKE suite.
+crypto::tink::util::Status ValidateHpkeParams(
+    const google::crypto::tink::HpkeParams& params);
+
+// Returns the size of the encapsulated key 'enc' of 'kem'.
+crypto::tink::util::StatusOr<size_t> HpkeEncapsulatedKeySize(
+    google::crypto::tink::HpkeKem kem);
+
+// An HPKE context in base mode (RFC 9180, Section 5.1), implemented on
+// BoringSSL's X25519, HKDF and EVP_AEAD.
+//
+// A sender context seals messages, a recipient context opens them. Both
+// advance a sequence number with every message, so messages must be opened
+// in the order they were sealed, and a context must not be used by several
+// threads at once. Export() only reads the context.
+class HpkeContextBoringSsl {
+ public:
+  // Sets up a sender context to the recipient with serialized public key
+  // 'recipient_public_key', with a fresh ephemeral key.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HpkeContextBoringSsl>>
+  SetupSender(const google::crypto::tink::HpkeParams& params,
+              absl::string_view recipient_public_key, absl::string_view info);
+
+  // As SetupSender(), but with the given ephemeral private key. Only meant
+  // for known-answer tests: a sender must never reuse an ephemeral key.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HpkeContextBoringSsl>>
+  SetupSenderWithEphemeralKey(const google::crypto::tink::HpkeParams& params,
+                              absl::string_view recipient_public_key,
+                              absl::string_view info,
+                              const util::SecretData& ephemeral_private_key);
+
+  // Sets up the recipient context of the sender which produced
+  // 'encapsulated_key'. 'recipient_public_key' must belong to
+  // 'recipient_private_key'; it is passed in so that it is not derived
+  // again for every context.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HpkeContextBoringSsl>>
+  SetupRecipient(const google::crypto::tink::HpkeParams& params,
+                 const util::SecretData& recipient_private_key,
+                 absl::string_view recipient_public_key,
+                 absl::string_view encapsulated_key, absl::string_view info);
+
+  // The encapsulated key 'enc' which the recipient needs to set up its
+  // context.
+  const std::string& encapsulated_key() const { return encapsulated_key_; }
+
+  // Encrypts 'plaintext' as the next message of the context.
+  crypto::tink::util::StatusOr<std::string> Seal(
+      absl::string_view plaintext, absl::string_view associated_data);
+
+  // Decrypts 'ciphertext' as the next message of the context. The sequence
+  // number only advances if decryption succeeds.
+  crypto::tink::util::StatusOr<std::string> Open(
+      absl::string_view ciphertext, absl::string_view associated_data);
+
+  // Derives a secret of 'length' bytes from the context, bound to
+  // 'exporter_context' (RFC 9180, Section 5.3).
+  crypto::tink::util::StatusOr<util::SecretData> Export(
+      absl::string_view exporter_context, size_t length) const;
+
+ private:
+  HpkeContextBoringSsl(std::string suite_id, std::string encapsulated_key,
+                       bssl::UniquePtr<EVP_AEAD_CTX> aead_ctx,
+                       util::SecretData base_nonce,
+                       util::SecretData exporter_secret)
+      : suite_id_(std::move(suite_id)),
+        encapsulated_key_(std::move(encapsulated_key)),
+        aead_ctx_(std::move(aead_ctx)),
+        base_nonce_(std::move(base_nonce)),
+        exporter_secret_(std::move(exporter_secret)) {}
+
+  // Runs the key schedule on the KEM shared secret.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HpkeContextBoringSsl>>
+  KeySchedule(const google::crypto::tink::HpkeParams& params,
+              const util::SecretData& shared_secret, absl::string_view info,
+              std::string encapsulated_key);
+
+  // Returns the nonce of the current message.
+  std::string ComputeNonce() const;
+
+  const std::string suite_id_;
+  const std::string encapsulated_key_;
+  const bssl::UniquePtr<EVP_AEAD_CTX> aead_ctx_;
+  const util::SecretData base_nonce_;
+  const util::SecretData exporter_secret_;
+  uint64_t sequence_number_ = 0;
+};
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_HYBRID_INTERNAL_HPKE_CONTEXT_BORINGSSL_H_
@@ -0,0 +1,227 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/internal/hpke_context_boringssl.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::crypto::tink::test::HexDecodeOrDie;
+using ::crypto::tink::test::HexEncode;
+using ::crypto::tink::test::IsOk;
+using ::google::crypto::tink::HpkeAead;
+using ::google::crypto::tink::HpkeKdf;
+using ::google::crypto::tink::HpkeKem;
+using ::google::crypto::tink::HpkeParams;
+using ::testing::Eq;
+using ::testing::Not;
+
+// Test vector of RFC 9180, Appendix A.1.1: DHKEM(X25519, HKDF-SHA256),
+// HKDF-SHA256, AES-128-GCM in base mode.
+constexpr char kEphemeralPrivateKey[] =
+    "52c4a758a802cd8b936eceea314432798d5baf2d7e9235dc084ab1b9cfa2f736";
+constexpr char kEncapsulatedKey[] =
+    "37fda3567bdbd628e88668c3c8d7e97d1d1253b6d4ea6d44c150f741f1bf4431";
+constexpr char kRecipientPrivateKey[] =
+    "4612c550263fc8ad58375df3f557aac531d26850903e55a9f23f21d8534e8ac8";
+constexpr char kRecipientPublicKey[] =
+    "3948cfe0ad1ddb695d780e59077195da6c56506b027329794ab02bca80815c4d";
+constexpr char kInfo[] = "4f6465206f6e2061204772656369616e2055726e";
+constexpr char kPlaintext[] =
+    "4265617574792069732074727574682c20747275746820626561757479";
+constexpr char kAssociatedData0[] = "436f756e742d30";
+constexpr char kCiphertext0[] =
+    "f938558b5d72f1a23810b4be2ab4f84331acc02fc97babc53a52ae8218a355a96d8770ac"
+    "83d07bea87e13c512a";
+constexpr char kAssociatedData1[] = "436f756e742d31";
+constexpr char kCiphertext1[] =
+    "af2d7e9ac9ae7e270f46ba1f975be53c09f8d875bdc8535458c2494e8a6eab251c03d0c2"
+    "2a56b8ca42c2063b84";
+
+HpkeParams X25519Params(HpkeAead aead) {
+  HpkeParams params;
+  params.set_kem(HpkeKem::DHKEM_X25519_HKDF_SHA256);
+  params.set_kdf(HpkeKdf::HKDF_SHA256);
+  params.set_aead(aead);
+  return params;
+}
+
+std::unique_ptr<HpkeContextBoringSsl> TestVectorSender() {
+  auto sender_or = HpkeContextBoringSsl::SetupSenderWithEphemeralKey(
+      X25519Params(HpkeAead::AES_128_GCM),
+      HexDecodeOrDie(kRecipientPublicKey), HexDecodeOrDie(kInfo),
+      util::SecretDataFromStringView(HexDecodeOrDie(kEphemeralPrivateKey)));
+  EXPECT_THAT(sender_or.status(), IsOk());
+  return std::move(sender_or.ValueOrDie());
+}
+
+std::unique_ptr<HpkeContextBoringSsl> TestVectorRecipient() {
+  auto recipient_or = HpkeContextBoringSsl::SetupRecipient(
+      X25519Params(HpkeAead::AES_128_GCM),
+      util::SecretDataFromStringView(HexDecodeOrDie(kRecipientPrivateKey)),
+      HexDecodeOrDie(kRecipientPublicKey), HexDecodeOrDie(kEncapsulatedKey),
+      HexDecodeOrDie(kInfo));
+  EXPECT_THAT(recipient_or.status(), IsOk());
+  return std::move(recipient_or.ValueOrDie());
+}
+
+TEST(HpkeContextBoringSslTest, SenderMatchesTestVector) {
+  std::unique_ptr<HpkeContextBoringSsl> sender = TestVectorSender();
+  EXPECT_THAT(HexEncode(sender->encapsulated_key()), Eq(kEncapsulatedKey));
+  auto ciphertext_or = sender->Seal(HexDecodeOrDie(kPlaintext),
+                                    HexDecodeOrDie(kAssociatedData0));
+  ASSERT_THAT(ciphertext_or.status(), IsOk());
+  EXPECT_THAT(HexEncode(ciphertext_or.ValueOrDie()), Eq(kCiphertext0));
+  ciphertext_or = sender->Seal(HexDecodeOrDie(kPlaintext),
+                               HexDecodeOrDie(kAssociatedData1));
+  ASSERT_THAT(ciphertext_or.status(), IsOk());
+  EXPECT_THAT(HexEncode(ciphertext_or.ValueOrDie()), Eq(kCiphertext1));
+}
+
+TEST(HpkeContextBoringSslTest, RecipientMatchesTestVector) {
+  std::unique_ptr<HpkeContextBoringSsl> recipient = TestVectorRecipient();
+  // Messages must be opened in order.
+  EXPECT_THAT(recipient
+                  ->Open(HexDecodeOrDie(kCiphertext1),
+                         HexDecodeOrDie(kAssociatedData1))
+                  .status(),
+              Not(IsOk()));
+  auto plaintext_or = recipient->Open(HexDecodeOrDie(kCiphertext0),
+                                      HexDecodeOrDie(kAssociatedData0));
+  ASSERT_THAT(plaintext_or.status(), IsOk());
+  EXPECT_THAT(HexEncode(plaintext_or.ValueOrDie()), Eq(kPlaintext));
+  plaintext_or = recipient->Open(HexDecodeOrDie(kCiphertext1),
+                                 HexDecodeOrDie(kAssociatedData1));
+  ASSERT_THAT(plaintext_or.status(), IsOk());
+  EXPECT_THAT(HexEncode(plaintext_or.ValueOrDie()), Eq(kPlaintext));
+}
+
+TEST(HpkeContextBoringSslTest, ExportMatchesTestVector) {
+  std::unique_ptr<HpkeContextBoringSsl> sender = TestVectorSender();
+  std::unique_ptr<HpkeContextBoringSsl> recipient = TestVectorRecipient();
+  struct {
+    std::string exporter_context;
+    std::string exported_value;
+  } vectors[] = {
+      {"", "3853fe2b4035195a573ffc53856e77058e15d9ea064de3e59f4961d0095250ee"},
+      {"00",
+       "2e8f0b54673c7029649d4eb9d5e33bf1872cf76d623ff164ac185da9e88c21a5"},
+      {"54657374436f6e74657874",
+       "e9e43065102c3836401bed8c3c3c75ae46be1639869391d62c61f1ec7af54931"},
+  };
+  for (const auto& vector : vectors) {
+    for (const HpkeContextBoringSsl* context : {sender.get(), recipient.get()}) {
+      auto secret_or = context->Export(HexDecodeOrDie(vector.exporter_context),
+                                       /*length=*/32);
+      ASSERT_THAT(secret_or.status(), IsOk());
+      EXPECT_THAT(
+          HexEncode(util::SecretDataAsStringView(secret_or.ValueOrDie())),
+          Eq(vector.exported_value));
+    }
+  }
+  EXPECT_THAT(sender->Export("", 255 * 32 + 1).status(), Not(IsOk()));
+}
+
+TEST(HpkeContextBoringSslTest, SealOpenAllAeads) {
+  for (HpkeAead aead : {HpkeAead::AES_128_GCM, HpkeAead::AES_256_GCM,
+                        HpkeAead::CHACHA20_POLY1305}) {
+    HpkeParams params = X25519Params(aead);
+    auto sender_or = HpkeContextBoringSsl::SetupSender(
+        params, HexDecodeOrDie(kRecipientPublicKey), "info");
+    ASSERT_THAT(sender_or.status(), IsOk());
+    auto& sender = sender_or.ValueOrDie();
+    auto recipient_or = HpkeContextBoringSsl::SetupRecipient(
+        params,
+        util::SecretDataFromStringView(HexDecodeOrDie(kRecipientPrivateKey)),
+        HexDecodeOrDie(kRecipientPublicKey), sender->encapsulated_key(),
+        "info");
+    ASSERT_THAT(recipient_or.status(), IsOk());
+    auto& recipient = recipient_or.ValueOrDie();
+    for (const std::string message : {"first", "", "third"}) {
+      auto ciphertext_or = sender->Seal(message, "aad");
+      ASSERT_THAT(ciphertext_or.status(), IsOk());
+      auto plaintext_or = recipient->Open(ciphertext_or.ValueOrDie(), "aad");
+      ASSERT_THAT(plaintext_or.status(), IsOk());
+      EXPECT_THAT(plaintext_or.ValueOrDie(), Eq(message));
+    }
+
+    // A recipient with other info derives other keys.
+    auto other_recipient_or = HpkeContextBoringSsl::SetupRecipient(
+        params,
+        util::SecretDataFromStringView(HexDecodeOrDie(kRecipientPrivateKey)),
+        HexDecodeOrDie(kRecipientPublicKey), sender->encapsulated_key(),
+        "other info");
+    ASSERT_THAT(other_recipient_or.status(), IsOk());
+    EXPECT_THAT(other_recipient_or.ValueOrDie()
+                    ->Open(sender->Seal("message", "").ValueOrDie(), "")
+                    .status(),
+                Not(IsOk()));
+  }
+}
+
+TEST(HpkeContextBoringSslTest, InvalidParameters) {
+  HpkeParams params = X25519Params(HpkeAead::AES_128_GCM);
+  EXPECT_THAT(ValidateHpkeParams(params), IsOk());
+  params.set_aead(HpkeAead::AEAD_UNKNOWN);
+  EXPECT_THAT(ValidateHpkeParams(params), Not(IsOk()));
+  params = X25519Params(HpkeAead::AES_128_GCM);
+  params.set_kdf(HpkeKdf::KDF_UNKNOWN);
+  EXPECT_THAT(ValidateHpkeParams(params), Not(IsOk()));
+  params = X25519Params(HpkeAead::AES_128_GCM);
+  params.set_kem(HpkeKem::KEM_UNKNOWN);
+  EXPECT_THAT(ValidateHpkeParams(params), Not(IsOk()));
+  EXPECT_THAT(
+      HpkeContextBoringSsl::SetupSender(params,
+                                        HexDecodeOrDie(kRecipientPublicKey), "")
+          .status(),
+      Not(IsOk()));
+
+  params = X25519Params(HpkeAead::AES_128_GCM);
+  EXPECT_THAT(HpkeContextBoringSsl::SetupSender(params, "short key", "")
+                  .status(),
+              Not(IsOk()));
+  // The all-zero point has small order, so the shared value is zero.
+  EXPECT_THAT(HpkeContextBoringSsl::SetupSender(
+                  params, std::string(32, '\0'), "")
+                  .status(),
+              Not(IsOk()));
+  EXPECT_THAT(
+      HpkeContextBoringSsl::SetupRecipient(
+          params,
+          util::SecretDataFromStringView(HexDecodeOrDie(kRecipientPrivateKey)),
+          HexDecodeOrDie(kRecipientPublicKey), "short", "")
+          .status(),
+      Not(IsOk()));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
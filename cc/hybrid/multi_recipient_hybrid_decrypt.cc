@@ -0,0 +1,135 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/multi_recipient_hybrid_decrypt.h"
+
+#include <memory>
+#include <string>
+
+#include "absl/base/internal/endian.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/hybrid/internal/hpke_context_boringssl.h"
+#include "tink/hybrid/multi_recipient_hybrid_encrypt.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using ::crypto::tink::internal::HpkeContextBoringSsl;
+using ::google::crypto::tink::HpkePrivateKey;
+
+namespace {
+
+// The size of the number of entries, and of the key id and the size of
+// an entry.
+constexpr size_t kFieldSize = 4;
+
+uint32_t LoadBigEndian32(absl::string_view bytes) {
+  return absl::big_endian::Load32(bytes.data());
+}
+
+}  // namespace
+
+// static
+util::StatusOr<std::unique_ptr<HybridDecrypt>>
+MultiRecipientHybridDecrypt::New(uint32_t key_id,
+                                 const HpkePrivateKey& recipient_private_key) {
+  const auto& params = recipient_private_key.public_key().params();
+  util::Status status = internal::ValidateHpkeParams(params);
+  if (!status.ok()) return status;
+  auto enc_size_or = internal::HpkeEncapsulatedKeySize(params.kem());
+  if (!enc_size_or.ok()) return enc_size_or.status();
+  if (recipient_private_key.public_key().public_key().size() !=
+      enc_size_or.ValueOrDie()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid HPKE public key size");
+  }
+  return {absl::WrapUnique(new MultiRecipientHybridDecrypt(
+      key_id, params,
+      util::SecretDataFromStringView(recipient_private_key.private_key()),
+      recipient_private_key.public_key().public_key(),
+      enc_size_or.ValueOrDie()))};
+}
+
+util::StatusOr<std::string> MultiRecipientHybridDecrypt::DecryptDemKey(
+    absl::string_view entry, absl::string_view key_id,
+    absl::string_view context_info) const {
+  if (entry.size() < encapsulated_key_size_) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Recipient entry too short");
+  }
+  auto context_or = HpkeContextBoringSsl::SetupRecipient(
+      params_, private_key_, public_key_,
+      entry.substr(0, encapsulated_key_size_), context_info);
+  if (!context_or.ok()) return context_or.status();
+  return context_or.ValueOrDie()->Open(entry.substr(encapsulated_key_size_),
+                                       key_id);
+}
+
+util::StatusOr<std::string> MultiRecipientHybridDecrypt::Decrypt(
+    absl::string_view ciphertext, absl::string_view context_info) const {
+  if (ciphertext.size() < kFieldSize) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  uint32_t entry_count = LoadBigEndian32(ciphertext);
+  size_t offset = kFieldSize;
+  absl::string_view own_entry;
+  absl::string_view own_key_id;
+  for (uint32_t i = 0; i < entry_count; i++) {
+    if (ciphertext.size() - offset < 2 * kFieldSize) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Ciphertext too short");
+    }
+    absl::string_view key_id = ciphertext.substr(offset, kFieldSize);
+    uint32_t entry_size =
+        LoadBigEndian32(ciphertext.substr(offset + kFieldSize));
+    offset += 2 * kFieldSize;
+    if (ciphertext.size() - offset < entry_size) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Ciphertext too short");
+    }
+    if (LoadBigEndian32(key_id) == key_id_) {
+      own_entry = ciphertext.substr(offset, entry_size);
+      own_key_id = key_id;
+    }
+    offset += entry_size;
+  }
+  if (own_key_id.empty()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Ciphertext has no entry for this recipient");
+  }
+  auto dem_key_or = DecryptDemKey(own_entry, own_key_id, context_info);
+  if (!dem_key_or.ok()) return dem_key_or.status();
+  util::SecretData dem_key =
+      util::SecretDataFromStringView(dem_key_or.ValueOrDie());
+  if (dem_key.size() != MultiRecipientHybridEncrypt::kDemKeySize) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid DEM key size");
+  }
+  auto dem_or = subtle::AesGcmBoringSsl::New(dem_key);
+  if (!dem_or.ok()) return dem_or.status();
+  return dem_or.ValueOrDie()->Decrypt(ciphertext.substr(offset),
+                                      ciphertext.substr(0, offset));
+}
+
+}  // namespace tink
+}  // namespace crypto
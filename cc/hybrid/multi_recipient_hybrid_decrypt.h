@@ -0,0 +1,77 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_HYBRID_MULTI_RECIPIENT_HYBRID_DECRYPT_H_
+#define TINK_HYBRID_MULTI_RECIPIENT_HYBRID_DECRYPT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// Decryption of the ciphertexts of MultiRecipientHybridEncrypt by one of
+// their recipients.  Only the entry with the recipient's key id is
+// decapsulated; the others are skipped.
+class MultiRecipientHybridDecrypt : public HybridDecrypt {
+ public:
+  // Returns a decrypter for the recipient with 'key_id' and
+  // 'recipient_private_key'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HybridDecrypt>> New(
+      uint32_t key_id,
+      const google::crypto::tink::HpkePrivateKey& recipient_private_key);
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view context_info) const override;
+
+ private:
+  MultiRecipientHybridDecrypt(uint32_t key_id,
+                              google::crypto::tink::HpkeParams params,
+                              util::SecretData private_key,
+                              std::string public_key,
+                              size_t encapsulated_key_size)
+      : key_id_(key_id),
+        params_(std::move(params)),
+        private_key_(std::move(private_key)),
+        public_key_(std::move(public_key)),
+        encapsulated_key_size_(encapsulated_key_size) {}
+
+  // Returns the DEM key in 'entry', the part of an entry after its size.
+  crypto::tink::util::StatusOr<std::string> DecryptDemKey(
+      absl::string_view entry, absl::string_view key_id,
+      absl::string_view context_info) const;
+
+  const uint32_t key_id_;
+  const google::crypto::tink::HpkeParams params_;
+  const util::SecretData private_key_;
+  const std::string public_key_;
+  const size_t encapsulated_key_size_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_HYBRID_MULTI_RECIPIENT_HYBRID_DECRYPT_H_
@@ -0,0 +1,114 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/multi_recipient_hybrid_encrypt.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/internal/endian.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/hybrid/internal/hpke_context_boringssl.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using ::crypto::tink::internal::HpkeContextBoringSsl;
+
+namespace {
+
+std::string BigEndian32(uint32_t value) {
+  char bytes[4];
+  absl::big_endian::Store32(bytes, value);
+  return std::string(bytes, sizeof(bytes));
+}
+
+}  // namespace
+
+constexpr int MultiRecipientHybridEncrypt::kDemKeySize;
+
+// static
+util::StatusOr<std::unique_ptr<HybridEncrypt>>
+MultiRecipientHybridEncrypt::New(
+    std::vector<Recipient> recipients) {
+  if (recipients.empty()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "At least one recipient is required");
+  }
+  absl::flat_hash_set<uint32_t> key_ids;
+  for (const Recipient& recipient : recipients) {
+    if (!key_ids.insert(recipient.key_id).second) {
+      return util::Status(
+          util::error::INVALID_ARGUMENT,
+          absl::StrCat("Duplicate recipient key id ", recipient.key_id));
+    }
+    const auto& params = recipient.public_key.params();
+    util::Status status = internal::ValidateHpkeParams(params);
+    if (!status.ok()) return status;
+    auto enc_size_or = internal::HpkeEncapsulatedKeySize(params.kem());
+    if (!enc_size_or.ok()) return enc_size_or.status();
+    if (recipient.public_key.public_key().size() !=
+        enc_size_or.ValueOrDie()) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Invalid HPKE public key size");
+    }
+  }
+  return {absl::WrapUnique(
+      new MultiRecipientHybridEncrypt(std::move(recipients)))};
+}
+
+util::StatusOr<std::string> MultiRecipientHybridEncrypt::Encrypt(
+    absl::string_view plaintext, absl::string_view context_info) const {
+  util::SecretData dem_key = subtle::Random::GetRandomKeyBytes(kDemKeySize);
+  std::string header = BigEndian32(recipients_.size());
+  for (const Recipient& recipient : recipients_) {
+    auto context_or = HpkeContextBoringSsl::SetupSender(
+        recipient.public_key.params(), recipient.public_key.public_key(),
+        context_info);
+    if (!context_or.ok()) return context_or.status();
+    auto& context = context_or.ValueOrDie();
+    std::string key_id = BigEndian32(recipient.key_id);
+    auto wrapped_key_or =
+        context->Seal(util::SecretDataAsStringView(dem_key), key_id);
+    if (!wrapped_key_or.ok()) return wrapped_key_or.status();
+    const std::string& encapsulated_key = context->encapsulated_key();
+    absl::StrAppend(&header, key_id,
+                    BigEndian32(encapsulated_key.size() +
+                                wrapped_key_or.ValueOrDie().size()),
+                    encapsulated_key, wrapped_key_or.ValueOrDie());
+  }
+  auto dem_or = subtle::AesGcmBoringSsl::New(dem_key);
+  if (!dem_or.ok()) return dem_or.status();
+  auto dem_ciphertext_or = dem_or.ValueOrDie()->Encrypt(plaintext, header);
+  if (!dem_ciphertext_or.ok()) return dem_ciphertext_or.status();
+  return absl::StrCat(header, dem_ciphertext_or.ValueOrDie());
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,85 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_HYBRID_MULTI_RECIPIENT_HYBRID_ENCRYPT_H_
+#define TINK_HYBRID_MULTI_RECIPIENT_HYBRID_ENCRYPT_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// Hybrid encryption of a message to several recipients with HPKE keys,
+// which encrypts the message only once.
+//
+// The message is encrypted with AES-256-GCM under a random data encryption
+// (DEM) key, and only the DEM key is encrypted to each recipient, with HPKE
+// in base mode (RFC 9180) and the context info as the HPKE info.  Sending
+// a message to N recipients thus costs one encryption of the message and
+// N encapsulations, instead of N encryptions of the message.
+//
+// Recipients are identified by key ids, e.g. the ids of their keys in a
+// keyset, and MultiRecipientHybridDecrypt only decrypts the entry with the
+// key id of its recipient.  The ciphertext is
+//   number of entries (4 bytes, big-endian) || entry_1 || ... || entry_N ||
+//   AES-256-GCM ciphertext of the message (IV || ciphertext || tag),
+// with each entry
+//   key id (4 bytes, big-endian) || size of the rest (4 bytes, big-endian)
+//   || HPKE encapsulated key || HPKE ciphertext of the DEM key.
+// The DEM key of an entry is authenticated with its key id, and the message
+// with the entries.
+//
+// As with any hybrid encryption, the sender is not authenticated.  Note
+// that every recipient learns the DEM key, and can therefore forge messages
+// that the other recipients of the ciphertext accept; applications which
+// need to prevent that must sign the ciphertexts.
+class MultiRecipientHybridEncrypt : public HybridEncrypt {
+ public:
+  struct Recipient {
+    uint32_t key_id;
+    google::crypto::tink::HpkePublicKey public_key;
+  };
+
+  // Returns an encrypter to 'recipients', which must have distinct key ids.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HybridEncrypt>> New(
+      std::vector<Recipient> recipients);
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view context_info) const override;
+
+  static constexpr int kDemKeySize = 32;
+
+ private:
+  explicit MultiRecipientHybridEncrypt(std::vector<Recipient> recipients)
+      : recipients_(std::move(recipients)) {}
+
+  const std::vector<Recipient> recipients_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_HYBRID_MULTI_RECIPIENT_HYBRID_ENCRYPT_H_
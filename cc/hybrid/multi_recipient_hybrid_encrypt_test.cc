@@ -0,0 +1,169 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/multi_recipient_hybrid_encrypt.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/hybrid/hpke_private_key_manager.h"
+#include "tink/hybrid/multi_recipient_hybrid_decrypt.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::HpkeAead;
+using ::google::crypto::tink::HpkeKdf;
+using ::google::crypto::tink::HpkeKem;
+using ::google::crypto::tink::HpkeKeyFormat;
+using ::google::crypto::tink::HpkePrivateKey;
+using ::testing::Eq;
+using ::testing::Not;
+
+HpkePrivateKey CreateKey(HpkeAead aead) {
+  HpkeKeyFormat key_format;
+  key_format.mutable_params()->set_kem(HpkeKem::DHKEM_X25519_HKDF_SHA256);
+  key_format.mutable_params()->set_kdf(HpkeKdf::HKDF_SHA256);
+  key_format.mutable_params()->set_aead(aead);
+  return HpkePrivateKeyManager().CreateKey(key_format).ValueOrDie();
+}
+
+class MultiRecipientHybridTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (HpkeAead aead : {HpkeAead::AES_128_GCM, HpkeAead::AES_256_GCM,
+                          HpkeAead::CHACHA20_POLY1305}) {
+      private_keys_.push_back(CreateKey(aead));
+    }
+    for (int i = 0; i < private_keys_.size(); i++) {
+      recipients_.push_back({kKeyIds[i], private_keys_[i].public_key()});
+    }
+  }
+
+  std::unique_ptr<HybridDecrypt> NewDecrypt(int i) {
+    auto decrypt_or =
+        MultiRecipientHybridDecrypt::New(kKeyIds[i], private_keys_[i]);
+    EXPECT_THAT(decrypt_or.status(), IsOk());
+    return std::move(decrypt_or.ValueOrDie());
+  }
+
+  static constexpr uint32_t kKeyIds[] = {7, 0xffffffff, 42};
+  std::vector<HpkePrivateKey> private_keys_;
+  std::vector<MultiRecipientHybridEncrypt::Recipient> recipients_;
+};
+
+constexpr uint32_t MultiRecipientHybridTest::kKeyIds[];
+
+TEST_F(MultiRecipientHybridTest, EncryptDecrypt) {
+  auto encrypt_or = MultiRecipientHybridEncrypt::New(recipients_);
+  ASSERT_THAT(encrypt_or.status(), IsOk());
+  for (const std::string plaintext : {"", "some plaintext"}) {
+    auto ciphertext_or =
+        encrypt_or.ValueOrDie()->Encrypt(plaintext, "context info");
+    ASSERT_THAT(ciphertext_or.status(), IsOk());
+    for (int i = 0; i < private_keys_.size(); i++) {
+      auto decrypted_or =
+          NewDecrypt(i)->Decrypt(ciphertext_or.ValueOrDie(), "context info");
+      ASSERT_THAT(decrypted_or.status(), IsOk());
+      EXPECT_THAT(decrypted_or.ValueOrDie(), Eq(plaintext));
+    }
+  }
+}
+
+TEST_F(MultiRecipientHybridTest, PayloadIsEncryptedOnce) {
+  std::string plaintext(10000, 'a');
+  auto one_or = MultiRecipientHybridEncrypt::New({recipients_[0]});
+  ASSERT_THAT(one_or.status(), IsOk());
+  auto all_or = MultiRecipientHybridEncrypt::New(recipients_);
+  ASSERT_THAT(all_or.status(), IsOk());
+  auto one_ct_or = one_or.ValueOrDie()->Encrypt(plaintext, "");
+  ASSERT_THAT(one_ct_or.status(), IsOk());
+  auto all_ct_or = all_or.ValueOrDie()->Encrypt(plaintext, "");
+  ASSERT_THAT(all_ct_or.status(), IsOk());
+  // Each further recipient only adds an entry of a few dozen bytes.
+  EXPECT_LT(all_ct_or.ValueOrDie().size(),
+            one_ct_or.ValueOrDie().size() + 2 * 200);
+}
+
+TEST_F(MultiRecipientHybridTest, WrongRecipientOrContextInfo) {
+  auto encrypt_or = MultiRecipientHybridEncrypt::New(
+      {recipients_[0], recipients_[1]});
+  ASSERT_THAT(encrypt_or.status(), IsOk());
+  auto ciphertext_or = encrypt_or.ValueOrDie()->Encrypt("plaintext", "info");
+  ASSERT_THAT(ciphertext_or.status(), IsOk());
+  const std::string& ciphertext = ciphertext_or.ValueOrDie();
+
+  EXPECT_THAT(NewDecrypt(2)->Decrypt(ciphertext, "info").status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(NewDecrypt(0)->Decrypt(ciphertext, "other info").status(),
+              Not(IsOk()));
+  // The key of recipient 2 under the key id of recipient 0.
+  auto decrypt_or =
+      MultiRecipientHybridDecrypt::New(kKeyIds[0], private_keys_[2]);
+  ASSERT_THAT(decrypt_or.status(), IsOk());
+  EXPECT_THAT(decrypt_or.ValueOrDie()->Decrypt(ciphertext, "info").status(),
+              Not(IsOk()));
+}
+
+TEST_F(MultiRecipientHybridTest, ModifiedCiphertext) {
+  auto encrypt_or = MultiRecipientHybridEncrypt::New(recipients_);
+  ASSERT_THAT(encrypt_or.status(), IsOk());
+  auto ciphertext_or = encrypt_or.ValueOrDie()->Encrypt("plaintext", "info");
+  ASSERT_THAT(ciphertext_or.status(), IsOk());
+  const std::string& ciphertext = ciphertext_or.ValueOrDie();
+  std::unique_ptr<HybridDecrypt> decrypt = NewDecrypt(1);
+  for (int i = 0; i < ciphertext.size(); i++) {
+    std::string modified = ciphertext;
+    modified[i] ^= 1;
+    EXPECT_THAT(decrypt->Decrypt(modified, "info").status(), Not(IsOk()))
+        << "byte " << i;
+  }
+  for (int size = 0; size < ciphertext.size(); size++) {
+    EXPECT_THAT(decrypt->Decrypt(ciphertext.substr(0, size), "info").status(),
+                Not(IsOk()))
+        << "size " << size;
+  }
+}
+
+TEST_F(MultiRecipientHybridTest, InvalidRecipients) {
+  EXPECT_THAT(MultiRecipientHybridEncrypt::New({}).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  auto duplicate = recipients_;
+  duplicate[1].key_id = duplicate[0].key_id;
+  EXPECT_THAT(MultiRecipientHybridEncrypt::New(duplicate).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  auto invalid = recipients_;
+  invalid[2].public_key.set_public_key("short");
+  EXPECT_THAT(MultiRecipientHybridEncrypt::New(invalid).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -17,7 +17,11 @@
 #ifndef TINK_HYBRID_DECRYPT_H_
 #define TINK_HYBRID_DECRYPT_H_
 
+#include <string>
+#include <vector>
+
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -59,6 +63,17 @@ class HybridDecrypt {
   virtual crypto::tink::util::StatusOr<std::string> Decrypt(
       absl::string_view ciphertext, absl::string_view context_info) const = 0;
 
+  // Decrypts ciphertexts[i], for every i, verifying the integrity of
+  // 'context_info', and returns the plaintexts in order.  Either all
+  // ciphertexts are decrypted or an error is returned.
+  //
+  // The default implementation calls Decrypt() for every ciphertext;
+  // implementations override it when they can decrypt ciphertexts in
+  // parallel.
+  virtual crypto::tink::util::StatusOr<std::vector<std::string>> DecryptBatch(
+      absl::Span<const absl::string_view> ciphertexts,
+      absl::string_view context_info) const;
+
   virtual ~HybridDecrypt() {}
 };
 
@@ -17,6 +17,11 @@
 #ifndef TINK_INPUT_STREAM_H_
 #define TINK_INPUT_STREAM_H_
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "absl/types/span.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
@@ -90,6 +95,38 @@ class InputStream {
   //   then returned value is the total number of bytes in the stream.
   // * If the last call to Next() ended with a failure, -1 is returned;
   virtual int64_t Position() const = 0;
+
+  // Reads bytes from the stream into 'buffer', until it is full or the
+  // stream ends.  Streams that can put the bytes straight into 'buffer'
+  // (e.g. from a file, or by decrypting into it) override this method to
+  // skip their own buffers, and the default implementation copies the
+  // buffers returned by Next() and backs up the unused rest.
+  //
+  // Postconditions:
+  // * If the returned status is not OK, an error occurred (OUT_OF_RANGE
+  //   is never returned), and the contents of 'buffer' are unspecified.
+  // * Otherwise, the returned value is the number of bytes read into
+  //   'buffer', which is less than buffer.size() iff the stream ended.
+  // * BackUp() must not be called directly after ReadInto().
+  virtual crypto::tink::util::StatusOr<int> ReadInto(
+      absl::Span<uint8_t> buffer) {
+    int count = 0;
+    while (count < static_cast<int>(buffer.size())) {
+      const void* data;
+      auto next_result = Next(&data);
+      if (next_result.status().error_code() ==
+          crypto::tink::util::error::OUT_OF_RANGE) {
+        break;
+      }
+      if (!next_result.ok()) return next_result.status();
+      int available = next_result.ValueOrDie();
+      int needed = std::min(available, static_cast<int>(buffer.size()) - count);
+      std::memcpy(buffer.data() + count, data, needed);
+      count += needed;
+      if (available > needed) BackUp(available - needed);
+    }
+    return count;
+  }
 };
 
 }  // namespace tink
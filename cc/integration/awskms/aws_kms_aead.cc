@@ -14,11 +14,17 @@
 
 #include "tink/integration/awskms/aws_kms_aead.h"
 
+#include <memory>
+#include <string>
+#include <utility>
+
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "aws/core/auth/AWSCredentialsProvider.h"
 #include "aws/core/client/AWSClient.h"
+#include "aws/core/client/AsyncCallerContext.h"
 #include "aws/core/utils/Outcome.h"
 #include "aws/core/utils/memory/AWSMemory.h"
 #include "aws/kms/KMSClient.h"
@@ -28,6 +34,8 @@
 #include "aws/kms/model/EncryptRequest.h"
 #include "aws/kms/model/EncryptResult.h"
 #include "tink/aead.h"
+#include "tink/async_aead.h"
+#include "tink/internal/traced_operation.h"
 #include "tink/util/errors.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -59,33 +67,11 @@ std::string AwsErrorToString(Aws::Client::AWSError<Aws::KMS::KMSErrors> err) {
                       err.GetExceptionName(), ": ", err.GetMessage());
 }
 
-}  // namespace
-
-AwsKmsAead::AwsKmsAead(absl::string_view key_arn,
-                       std::shared_ptr<Aws::KMS::KMSClient> aws_client) :
-    key_arn_(key_arn), aws_client_(aws_client) {
-}
-
-// static
-StatusOr<std::unique_ptr<Aead>>
-AwsKmsAead::New(absl::string_view key_arn,
-                std::shared_ptr<Aws::KMS::KMSClient> aws_client) {
-  if (key_arn.empty()) {
-    return Status(util::error::INVALID_ARGUMENT,
-                  "Key ARN cannot be empty.");
-  }
-  if (aws_client == nullptr) {
-    return Status(util::error::INVALID_ARGUMENT,
-                  "AWS KMS client cannot be null.");
-  }
-  std::unique_ptr<Aead> aead(new AwsKmsAead(key_arn, aws_client));
-  return std::move(aead);
-}
-
-StatusOr<std::string> AwsKmsAead::Encrypt(
-    absl::string_view plaintext, absl::string_view associated_data) const {
+Aws::KMS::Model::EncryptRequest NewEncryptRequest(
+    absl::string_view key_arn, absl::string_view plaintext,
+    absl::string_view associated_data) {
   Aws::KMS::Model::EncryptRequest req;
-  req.SetKeyId(key_arn_.c_str());
+  req.SetKeyId(std::string(key_arn).c_str());
   Aws::Utils::ByteBuffer plaintext_buffer(
       reinterpret_cast<const unsigned char*>(plaintext.data()),
       plaintext.length());
@@ -94,7 +80,11 @@ StatusOr<std::string> AwsKmsAead::Encrypt(
     req.AddEncryptionContext("associatedData",
                              HexEncode(associated_data).c_str());
   }
-  auto outcome = aws_client_->Encrypt(req);
+  return req;
+}
+
+StatusOr<std::string> GetCiphertext(
+    const Aws::KMS::Model::EncryptOutcome& outcome) {
   if (outcome.IsSuccess()) {
     auto& blob = outcome.GetResult().GetCiphertextBlob();
     std::string ciphertext(
@@ -108,10 +98,11 @@ StatusOr<std::string> AwsKmsAead::Encrypt(
                    AwsErrorToString(err));
 }
 
-StatusOr<std::string> AwsKmsAead::Decrypt(
-    absl::string_view ciphertext, absl::string_view associated_data) const {
+Aws::KMS::Model::DecryptRequest NewDecryptRequest(
+    absl::string_view key_arn, absl::string_view ciphertext,
+    absl::string_view associated_data) {
   Aws::KMS::Model::DecryptRequest req;
-  req.SetKeyId(key_arn_.c_str());
+  req.SetKeyId(std::string(key_arn).c_str());
   Aws::Utils::ByteBuffer ciphertext_buffer(
       reinterpret_cast<const unsigned char*>(ciphertext.data()),
       ciphertext.length());
@@ -120,9 +111,15 @@ StatusOr<std::string> AwsKmsAead::Decrypt(
     req.AddEncryptionContext("associatedData",
                              HexEncode(associated_data).c_str());
   }
-  auto outcome = aws_client_->Decrypt(req);
+  return req;
+}
+
+StatusOr<std::string> GetPlaintext(
+    absl::string_view key_arn,
+    const Aws::KMS::Model::DecryptOutcome& outcome) {
   if (outcome.IsSuccess()) {
-    if (outcome.GetResult().GetKeyId() != Aws::String(key_arn_.c_str())) {
+    if (outcome.GetResult().GetKeyId() !=
+        Aws::String(std::string(key_arn).c_str())) {
       return util::Status(util::error::INVALID_ARGUMENT,
                           "AWS KMS decryption failed: wrong key ARN.");
     }
@@ -138,6 +135,129 @@ StatusOr<std::string> AwsKmsAead::Decrypt(
                    AwsErrorToString(err));
 }
 
+}  // namespace
+
+AwsKmsAead::AwsKmsAead(absl::string_view key_arn,
+                       std::shared_ptr<Aws::KMS::KMSClient> aws_client) :
+    key_arn_(key_arn), aws_client_(aws_client) {
+}
+
+AwsKmsAead::~AwsKmsAead() {
+  // The handlers of pending requests refer to this object.
+  absl::MutexLock lock(&pending_requests_mutex_);
+  pending_requests_mutex_.Await(absl::Condition(
+      +[](int* pending_requests) { return *pending_requests == 0; },
+      &pending_requests_));
+}
+
+// static
+StatusOr<std::unique_ptr<Aead>>
+AwsKmsAead::New(absl::string_view key_arn,
+                std::shared_ptr<Aws::KMS::KMSClient> aws_client) {
+  if (key_arn.empty()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "Key ARN cannot be empty.");
+  }
+  if (aws_client == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "AWS KMS client cannot be null.");
+  }
+  std::unique_ptr<Aead> aead(new AwsKmsAead(key_arn, aws_client));
+  return std::move(aead);
+}
+
+// static
+StatusOr<std::unique_ptr<AsyncAead>>
+AwsKmsAead::NewAsync(absl::string_view key_arn,
+                     std::shared_ptr<Aws::KMS::KMSClient> aws_client) {
+  if (key_arn.empty()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "Key ARN cannot be empty.");
+  }
+  if (aws_client == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "AWS KMS client cannot be null.");
+  }
+  std::unique_ptr<AsyncAead> aead(new AwsKmsAead(key_arn, aws_client));
+  return std::move(aead);
+}
+
+void AwsKmsAead::StartRequest() const {
+  absl::MutexLock lock(&pending_requests_mutex_);
+  pending_requests_++;
+}
+
+void AwsKmsAead::FinishRequest() const {
+  absl::MutexLock lock(&pending_requests_mutex_);
+  pending_requests_--;
+}
+
+StatusOr<std::string> AwsKmsAead::Encrypt(
+    absl::string_view plaintext, absl::string_view associated_data) const {
+  internal::TracedOperation operation("tink.aws_kms_aead.encrypt");
+  operation.SetAttribute("tink.kms_key", key_arn_);
+  operation.SetAttribute("tink.bytes", plaintext.size());
+  auto outcome = aws_client_->Encrypt(
+      NewEncryptRequest(key_arn_, plaintext, associated_data));
+  auto result = GetCiphertext(outcome);
+  operation.SetStatus(result.status());
+  return result;
+}
+
+StatusOr<std::string> AwsKmsAead::Decrypt(
+    absl::string_view ciphertext, absl::string_view associated_data) const {
+  internal::TracedOperation operation("tink.aws_kms_aead.decrypt");
+  operation.SetAttribute("tink.kms_key", key_arn_);
+  operation.SetAttribute("tink.bytes", ciphertext.size());
+  auto outcome = aws_client_->Decrypt(
+      NewDecryptRequest(key_arn_, ciphertext, associated_data));
+  auto result = GetPlaintext(key_arn_, outcome);
+  operation.SetStatus(result.status());
+  return result;
+}
+
+void AwsKmsAead::EncryptAsync(absl::string_view plaintext,
+                              absl::string_view associated_data,
+                              DoneCallback done) const {
+  internal::TracedOperation operation("tink.aws_kms_aead.encrypt");
+  operation.SetAttribute("tink.kms_key", key_arn_);
+  operation.SetAttribute("tink.bytes", plaintext.size());
+  done = operation.EndWhenDone(std::move(done));
+  StartRequest();
+  aws_client_->EncryptAsync(
+      NewEncryptRequest(key_arn_, plaintext, associated_data),
+      [this, done](
+          const Aws::KMS::KMSClient* client,
+          const Aws::KMS::Model::EncryptRequest& request,
+          const Aws::KMS::Model::EncryptOutcome& outcome,
+          const std::shared_ptr<const Aws::Client::AsyncCallerContext>&
+              context) {
+        done(GetCiphertext(outcome));
+        FinishRequest();
+      });
+}
+
+void AwsKmsAead::DecryptAsync(absl::string_view ciphertext,
+                              absl::string_view associated_data,
+                              DoneCallback done) const {
+  internal::TracedOperation operation("tink.aws_kms_aead.decrypt");
+  operation.SetAttribute("tink.kms_key", key_arn_);
+  operation.SetAttribute("tink.bytes", ciphertext.size());
+  done = operation.EndWhenDone(std::move(done));
+  StartRequest();
+  aws_client_->DecryptAsync(
+      NewDecryptRequest(key_arn_, ciphertext, associated_data),
+      [this, done](
+          const Aws::KMS::KMSClient* client,
+          const Aws::KMS::Model::DecryptRequest& request,
+          const Aws::KMS::Model::DecryptOutcome& outcome,
+          const std::shared_ptr<const Aws::Client::AsyncCallerContext>&
+              context) {
+        done(GetPlaintext(key_arn_, outcome));
+        FinishRequest();
+      });
+}
+
 }  // namespace awskms
 }  // namespace integration
 }  // namespace tink
@@ -15,9 +15,15 @@
 #ifndef TINK_INTEGRATION_AWSKMS_AWS_KMS_AEAD_H_
 #define TINK_INTEGRATION_AWSKMS_AWS_KMS_AEAD_H_
 
+#include <memory>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "aws/kms/KMSClient.h"
 #include "tink/aead.h"
+#include "tink/async_aead.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -28,7 +34,10 @@ namespace awskms {
 // AwsKmsAead is an implementation of AEAD that forwards
 // encryption/decryption requests to a key managed by
 // <a href="https://aws.amazon.com/kms/">AWS KMS</a>.
-class AwsKmsAead : public Aead {
+//
+// AwsKmsAead also implements AsyncAead, using the asynchronous API of the
+// AWS client.  The destructor waits for pending requests to complete.
+class AwsKmsAead : public Aead, public AsyncAead {
  public:
   // Creates a new AwsKmsAead that is bound to the key specified in 'key_arn',
   // and that uses the given client when communicating with the KMS.
@@ -36,6 +45,11 @@ class AwsKmsAead : public Aead {
   New(absl::string_view key_arn,
       std::shared_ptr<Aws::KMS::KMSClient> aws_client);
 
+  // Like New(), but returns the AsyncAead-interface of AwsKmsAead.
+  static crypto::tink::util::StatusOr<std::unique_ptr<AsyncAead>>
+  NewAsync(absl::string_view key_arn,
+           std::shared_ptr<Aws::KMS::KMSClient> aws_client);
+
   crypto::tink::util::StatusOr<std::string> Encrypt(
       absl::string_view plaintext,
       absl::string_view associated_data) const override;
@@ -44,13 +58,28 @@ class AwsKmsAead : public Aead {
       absl::string_view ciphertext,
       absl::string_view associated_data) const override;
 
-  virtual ~AwsKmsAead() {}
+  void EncryptAsync(absl::string_view plaintext,
+                    absl::string_view associated_data,
+                    DoneCallback done) const override;
+
+  void DecryptAsync(absl::string_view ciphertext,
+                    absl::string_view associated_data,
+                    DoneCallback done) const override;
+
+  ~AwsKmsAead() override;
 
  private:
   AwsKmsAead(absl::string_view key_arn,
              std::shared_ptr<Aws::KMS::KMSClient> aws_client);
+
+  // Bookkeeping of pending asynchronous requests.
+  void StartRequest() const;
+  void FinishRequest() const;
+
   std::string key_arn_;  // The location of a crypto key in AWS KMS.
   std::shared_ptr<Aws::KMS::KMSClient> aws_client_;
+  mutable absl::Mutex pending_requests_mutex_;
+  mutable int pending_requests_ ABSL_GUARDED_BY(pending_requests_mutex_) = 0;
 };
 
 
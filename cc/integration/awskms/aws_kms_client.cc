@@ -13,6 +13,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "tink/integration/awskms/aws_kms_client.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -22,6 +24,7 @@
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "aws/core/Aws.h"
 #include "aws/core/auth/AWSCredentialsProvider.h"
 #include "aws/core/auth/AWSCredentialsProviderChain.h"
@@ -57,9 +60,10 @@ std::string GetKeyArn(absl::string_view key_uri) {
 }
 
 // Returns ClientConfiguration with region set to the value
-// extracted from 'key_arn'.
+// extracted from 'key_arn', and timeouts of at most 'request_timeout'.
 StatusOr<Aws::Client::ClientConfiguration>
-    GetAwsClientConfig(absl::string_view key_arn) {
+    GetAwsClientConfig(absl::string_view key_arn,
+                       absl::Duration request_timeout) {
   std::vector<std::string> key_arn_parts = absl::StrSplit(key_arn, ':');
   if (key_arn_parts.size() < 6) {
     return ToStatusF(util::error::INVALID_ARGUMENT, "Invalid key ARN '%s'.",
@@ -68,8 +72,9 @@ StatusOr<Aws::Client::ClientConfiguration>
   Aws::Client::ClientConfiguration config;
   config.region = key_arn_parts[3].c_str();  // 4th part of key arn
   config.scheme = Aws::Http::Scheme::HTTPS;
-  config.connectTimeoutMs = 30000;
-  config.requestTimeoutMs = 60000;
+  int64_t request_timeout_ms = absl::ToInt64Milliseconds(request_timeout);
+  config.connectTimeoutMs = std::min<int64_t>(30000, request_timeout_ms);
+  config.requestTimeoutMs = request_timeout_ms;
   return config;
 }
 
@@ -181,8 +186,23 @@ void AwsKmsClient::InitAwsApi() {
 StatusOr<std::unique_ptr<AwsKmsClient>>
 AwsKmsClient::New(absl::string_view key_uri,
                   absl::string_view credentials_path) {
+  return New(key_uri, credentials_path, absl::Seconds(60));
+}
+
+// static
+StatusOr<std::unique_ptr<AwsKmsClient>>
+AwsKmsClient::New(absl::string_view key_uri,
+                  absl::string_view credentials_path,
+                  absl::Duration request_timeout) {
+  if (request_timeout < absl::Milliseconds(1) ||
+      request_timeout > absl::Milliseconds(INT32_MAX)) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid request timeout %s.",
+                     absl::FormatDuration(request_timeout));
+  }
   if (!aws_api_is_initialized_) InitAwsApi();
   std::unique_ptr<AwsKmsClient> client(new AwsKmsClient());
+  client->request_timeout_ = request_timeout;
 
   // Read credentials.
   auto credentials_result = GetAwsCredentials(credentials_path);
@@ -198,7 +218,8 @@ AwsKmsClient::New(absl::string_view key_uri,
       return ToStatusF(util::error::INVALID_ARGUMENT, "Key '%s' not supported",
                        key_uri);
     }
-    auto config_result = GetAwsClientConfig(client->key_arn_);
+    auto config_result =
+        GetAwsClientConfig(client->key_arn_, client->request_timeout_);
     if (!config_result.ok()) return config_result.status();
     // Create AWS KMSClient.
     client->aws_client_ = Aws::MakeShared<Aws::KMS::KMSClient>(
@@ -218,6 +239,26 @@ bool AwsKmsClient::DoesSupport(absl::string_view key_uri) const {
 
 StatusOr<std::unique_ptr<Aead>>
 AwsKmsClient::GetAead(absl::string_view key_uri) const {
+  auto key_arn_result = GetSupportedKeyArn(key_uri);
+  if (!key_arn_result.ok()) return key_arn_result.status();
+  auto aws_client_result = GetAwsClient(key_arn_result.ValueOrDie());
+  if (!aws_client_result.ok()) return aws_client_result.status();
+  return AwsKmsAead::New(key_arn_result.ValueOrDie(),
+                         aws_client_result.ValueOrDie());
+}
+
+StatusOr<std::unique_ptr<AsyncAead>>
+AwsKmsClient::GetAsyncAead(absl::string_view key_uri) const {
+  auto key_arn_result = GetSupportedKeyArn(key_uri);
+  if (!key_arn_result.ok()) return key_arn_result.status();
+  auto aws_client_result = GetAwsClient(key_arn_result.ValueOrDie());
+  if (!aws_client_result.ok()) return aws_client_result.status();
+  return AwsKmsAead::NewAsync(key_arn_result.ValueOrDie(),
+                              aws_client_result.ValueOrDie());
+}
+
+StatusOr<std::string> AwsKmsClient::GetSupportedKeyArn(
+    absl::string_view key_uri) const {
   if (!DoesSupport(key_uri)) {
     if (!key_arn_.empty()) {
       return ToStatusF(util::error::INVALID_ARGUMENT,
@@ -229,15 +270,24 @@ AwsKmsClient::GetAead(absl::string_view key_uri) const {
     }
   }
   if (!key_arn_.empty()) {  // This client is bound to a specific key.
-    return AwsKmsAead::New(key_arn_, aws_client_);
-  } else {  // Create an AWS KMSClient for the given key.
-    auto key_arn = GetKeyArn(key_uri);
-    auto config_result = GetAwsClientConfig(key_arn);
-    if (!config_result.ok()) return config_result.status();
-    auto aws_client = Aws::MakeShared<Aws::KMS::KMSClient>(
+    return key_arn_;
+  }
+  return GetKeyArn(key_uri);
+}
+
+StatusOr<std::shared_ptr<Aws::KMS::KMSClient>> AwsKmsClient::GetAwsClient(
+    absl::string_view key_arn) const {
+  if (aws_client_ != nullptr) return aws_client_;
+  auto config_result = GetAwsClientConfig(key_arn, request_timeout_);
+  if (!config_result.ok()) return config_result.status();
+  std::string region(config_result.ValueOrDie().region.c_str());
+  absl::MutexLock lock(&regional_clients_mutex_);
+  auto& aws_client = regional_clients_[region];
+  if (aws_client == nullptr) {  // Create an AWS KMSClient for the region.
+    aws_client = Aws::MakeShared<Aws::KMS::KMSClient>(
         kAwsCryptoAllocationTag, credentials_, config_result.ValueOrDie());
-    return AwsKmsAead::New(key_arn, aws_client);
   }
+  return aws_client;
 }
 
 Status AwsKmsClient::RegisterNewClient(absl::string_view key_uri,
@@ -16,12 +16,17 @@
 #define TINK_INTEGRATION_AWSKMS_AWS_KMS_CLIENT_H_
 
 #include <memory>
+#include <string>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "aws/core/auth/AWSCredentialsProvider.h"
 #include "aws/kms/KMSClient.h"
 #include "tink/aead.h"
+#include "tink/async_aead.h"
 #include "tink/kms_client.h"
 #include "tink/kms_clients.h"
 #include "tink/util/status.h"
@@ -46,6 +51,13 @@ class AwsKmsClient : public crypto::tink::KmsClient  {
   static crypto::tink::util::StatusOr<std::unique_ptr<AwsKmsClient>>
   New(absl::string_view key_uri, absl::string_view credentials_path);
 
+  // Like New() above, with the primitives of the client failing requests
+  // that take longer than 'request_timeout', instead of after the default
+  // timeout of 60 seconds.
+  static crypto::tink::util::StatusOr<std::unique_ptr<AwsKmsClient>>
+  New(absl::string_view key_uri, absl::string_view credentials_path,
+      absl::Duration request_timeout);
+
   // Creates a new client and registers it in KMSClients.
   static crypto::tink::util::Status RegisterNewClient(
       absl::string_view key_uri, absl::string_view credentials_path);
@@ -58,8 +70,24 @@ class AwsKmsClient : public crypto::tink::KmsClient  {
   crypto::tink::util::StatusOr<std::unique_ptr<Aead>>
   GetAead(absl::string_view key_uri) const override;
 
+  // Returns an AsyncAead-primitive backed by KMS key specified by 'key_uri',
+  // provided that this KmsClient does support 'key_uri'.
+  crypto::tink::util::StatusOr<std::unique_ptr<AsyncAead>>
+  GetAsyncAead(absl::string_view key_uri) const override;
+
  private:
   AwsKmsClient() {}
+
+  // Returns the ARN of the key specified by 'key_uri', or an error if this
+  // client does not support 'key_uri'.
+  crypto::tink::util::StatusOr<std::string> GetSupportedKeyArn(
+      absl::string_view key_uri) const;
+
+  // Returns the AWS KMSClient for 'key_arn'.  Unless this client is bound to
+  // a key, there is one AWS KMSClient per region, shared by all primitives
+  // so that they reuse its connections.
+  crypto::tink::util::StatusOr<std::shared_ptr<Aws::KMS::KMSClient>>
+  GetAwsClient(absl::string_view key_arn) const;
   // Initializes AWS API.
   static void InitAwsApi();
   static bool aws_api_is_initialized_;
@@ -67,7 +95,12 @@ class AwsKmsClient : public crypto::tink::KmsClient  {
 
   std::string key_arn_;
   Aws::Auth::AWSCredentials credentials_;
+  absl::Duration request_timeout_;
   std::shared_ptr<Aws::KMS::KMSClient> aws_client_;
+  mutable absl::Mutex regional_clients_mutex_;
+  mutable absl::flat_hash_map<std::string,
+                              std::shared_ptr<Aws::KMS::KMSClient>>
+      regional_clients_ ABSL_GUARDED_BY(regional_clients_mutex_);
 };
 
 
@@ -14,12 +14,22 @@
 
 #include "tink/integration/gcpkms/gcp_kms_aead.h"
 
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/base/call_once.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "google/cloud/kms/v1/service.grpc.pb.h"
+#include "grpcpp/completion_queue.h"
 #include "tink/aead.h"
+#include "tink/async_aead.h"
+#include "tink/internal/traced_operation.h"
 #include "tink/util/errors.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -38,15 +48,115 @@ using google::cloud::kms::v1::EncryptResponse;
 using google::cloud::kms::v1::KeyManagementService;
 using grpc::ClientContext;
 
+namespace {
+
+EncryptRequest NewEncryptRequest(absl::string_view key_name,
+                                 absl::string_view plaintext,
+                                 absl::string_view associated_data) {
+  EncryptRequest req;
+  req.set_name(std::string(key_name));
+  req.set_plaintext(std::string(plaintext));
+  req.set_additional_authenticated_data(std::string(associated_data));
+  return req;
+}
+
+DecryptRequest NewDecryptRequest(absl::string_view key_name,
+                                 absl::string_view ciphertext,
+                                 absl::string_view associated_data) {
+  DecryptRequest req;
+  req.set_name(std::string(key_name));
+  req.set_ciphertext(std::string(ciphertext));
+  req.set_additional_authenticated_data(std::string(associated_data));
+  return req;
+}
+
+// Returns the code of the error to return for a failed request.
+util::error::Code GetErrorCode(const grpc::Status& status) {
+  return status.error_code() == grpc::StatusCode::DEADLINE_EXCEEDED
+             ? util::error::DEADLINE_EXCEEDED
+             : util::error::INVALID_ARGUMENT;
+}
+
+StatusOr<std::string> GetResult(const grpc::Status& status,
+                                const EncryptResponse& resp) {
+  if (status.ok()) return resp.ciphertext();
+  return ToStatusF(GetErrorCode(status),
+                   "GCP KMS encryption failed: %s", status.error_message());
+}
+
+StatusOr<std::string> GetResult(const grpc::Status& status,
+                                const DecryptResponse& resp) {
+  if (status.ok()) return resp.plaintext();
+  return ToStatusF(GetErrorCode(status),
+                   "GCP KMS encryption failed: %s", status.error_message());
+}
+
+// A request in flight on the completion queue; its address is the tag of
+// the request.
+class AsyncCall {
+ public:
+  virtual ~AsyncCall() {}
+  // Called on the polling thread once the request has finished.
+  virtual void Finish() = 0;
+};
+
+template <typename Response>
+class AsyncCallImpl : public AsyncCall {
+ public:
+  explicit AsyncCallImpl(AsyncAead::DoneCallback done)
+      : done_(std::move(done)) {}
+
+  void Finish() override { done_(GetResult(status_, response_)); }
+
+  ClientContext* context() { return &context_; }
+
+  // Takes ownership of 'this' until Finish() has been called.
+  void Start(
+      std::unique_ptr<grpc::ClientAsyncResponseReader<Response>> reader) {
+    reader_ = std::move(reader);
+    reader_->Finish(&response_, &status_, this);
+  }
+
+ private:
+  AsyncAead::DoneCallback done_;
+  ClientContext context_;
+  Response response_;
+  grpc::Status status_;
+  std::unique_ptr<grpc::ClientAsyncResponseReader<Response>> reader_;
+};
+
+void PollCompletionQueue(grpc::CompletionQueue* completion_queue) {
+  void* tag;
+  bool ok;
+  // Next() returns false once the queue is shut down and drained.
+  while (completion_queue->Next(&tag, &ok)) {
+    std::unique_ptr<AsyncCall> call(static_cast<AsyncCall*>(tag));
+    call->Finish();
+  }
+}
+
+}  // namespace
+
 GcpKmsAead::GcpKmsAead(
     absl::string_view key_name,
-    std::shared_ptr<KeyManagementService::Stub> kms_stub)
-    : key_name_(key_name), kms_stub_(kms_stub) {}
+    std::shared_ptr<KeyManagementService::Stub> kms_stub,
+    absl::Duration request_timeout)
+    : key_name_(key_name),
+      kms_stub_(kms_stub),
+      request_timeout_(request_timeout) {}
+
+GcpKmsAead::~GcpKmsAead() {
+  completion_queue_.Shutdown();
+  // Make sure the queue is drained, also if no request has been started.
+  StartPolling();
+  polling_thread_.join();
+}
 
 // static
 StatusOr<std::unique_ptr<Aead>>
 GcpKmsAead::New(absl::string_view key_name,
-                std::shared_ptr<KeyManagementService::Stub> kms_stub) {
+                std::shared_ptr<KeyManagementService::Stub> kms_stub,
+                absl::Duration request_timeout) {
   if (key_name.empty()) {
     return Status(util::error::INVALID_ARGUMENT, "Key URI cannot be empty.");
   }
@@ -54,46 +164,109 @@ GcpKmsAead::New(absl::string_view key_name,
     return Status(util::error::INVALID_ARGUMENT,
                   "KMS stub cannot be null.");
   }
-  std::unique_ptr<Aead> aead(new GcpKmsAead(key_name, kms_stub));
+  std::unique_ptr<Aead> aead(
+      new GcpKmsAead(key_name, kms_stub, request_timeout));
   return std::move(aead);
 }
 
+// static
+StatusOr<std::unique_ptr<AsyncAead>>
+GcpKmsAead::NewAsync(absl::string_view key_name,
+                     std::shared_ptr<KeyManagementService::Stub> kms_stub,
+                     absl::Duration request_timeout) {
+  if (key_name.empty()) {
+    return Status(util::error::INVALID_ARGUMENT, "Key URI cannot be empty.");
+  }
+  if (kms_stub == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "KMS stub cannot be null.");
+  }
+  std::unique_ptr<AsyncAead> aead(
+      new GcpKmsAead(key_name, kms_stub, request_timeout));
+  return std::move(aead);
+}
+
+void GcpKmsAead::PrepareContext(ClientContext* context) const {
+  context->AddMetadata("x-goog-request-params",
+                       absl::StrCat("name=", key_name_));
+  if (request_timeout_ != absl::InfiniteDuration()) {
+    context->set_deadline(absl::ToChronoTime(absl::Now() + request_timeout_));
+  }
+}
+
+void GcpKmsAead::StartPolling() const {
+  absl::call_once(polling_started_, [this]() {
+    polling_thread_ = std::thread(PollCompletionQueue, &completion_queue_);
+  });
+}
+
 StatusOr<std::string> GcpKmsAead::Encrypt(
     absl::string_view plaintext, absl::string_view associated_data) const {
-  EncryptRequest req;
-  req.set_name(key_name_);
-  req.set_plaintext(std::string(plaintext));
-  req.set_additional_authenticated_data(std::string(associated_data));
-
+  internal::TracedOperation operation("tink.gcp_kms_aead.encrypt");
+  operation.SetAttribute("tink.kms_key", key_name_);
+  operation.SetAttribute("tink.bytes", plaintext.size());
+  EncryptRequest req = NewEncryptRequest(key_name_, plaintext, associated_data);
   EncryptResponse resp;
   ClientContext context;
-  context.AddMetadata("x-goog-request-params",
-                      absl::StrCat("name=", key_name_));
+  PrepareContext(&context);
 
   auto status =  kms_stub_->Encrypt(&context, req, &resp);
-
-  if (status.ok()) return resp.ciphertext();
-  return ToStatusF(util::error::INVALID_ARGUMENT,
-                   "GCP KMS encryption failed: %s", status.error_message());
+  auto result = GetResult(status, resp);
+  operation.SetStatus(result.status());
+  return result;
 }
 
 StatusOr<std::string> GcpKmsAead::Decrypt(
     absl::string_view ciphertext, absl::string_view associated_data) const {
-  DecryptRequest req;
-  req.set_name(key_name_);
-  req.set_ciphertext(std::string(ciphertext));
-  req.set_additional_authenticated_data(std::string(associated_data));
-
+  internal::TracedOperation operation("tink.gcp_kms_aead.decrypt");
+  operation.SetAttribute("tink.kms_key", key_name_);
+  operation.SetAttribute("tink.bytes", ciphertext.size());
+  DecryptRequest req =
+      NewDecryptRequest(key_name_, ciphertext, associated_data);
   DecryptResponse resp;
   ClientContext context;
-  context.AddMetadata("x-goog-request-params",
-                      absl::StrCat("name=", key_name_));
+  PrepareContext(&context);
 
   auto status =  kms_stub_->Decrypt(&context, req, &resp);
+  auto result = GetResult(status, resp);
+  operation.SetStatus(result.status());
+  return result;
+}
 
-  if (status.ok()) return resp.plaintext();
-  return ToStatusF(util::error::INVALID_ARGUMENT,
-                   "GCP KMS encryption failed: %s", status.error_message());
+void GcpKmsAead::EncryptAsync(absl::string_view plaintext,
+                              absl::string_view associated_data,
+                              DoneCallback done) const {
+  internal::TracedOperation operation("tink.gcp_kms_aead.encrypt");
+  operation.SetAttribute("tink.kms_key", key_name_);
+  operation.SetAttribute("tink.bytes", plaintext.size());
+  done = operation.EndWhenDone(std::move(done));
+  StartPolling();
+  auto call = absl::make_unique<AsyncCallImpl<EncryptResponse>>(
+      std::move(done));
+  PrepareContext(call->context());
+  auto reader = kms_stub_->AsyncEncrypt(
+      call->context(),
+      NewEncryptRequest(key_name_, plaintext, associated_data),
+      &completion_queue_);
+  call.release()->Start(std::move(reader));
+}
+
+void GcpKmsAead::DecryptAsync(absl::string_view ciphertext,
+                              absl::string_view associated_data,
+                              DoneCallback done) const {
+  internal::TracedOperation operation("tink.gcp_kms_aead.decrypt");
+  operation.SetAttribute("tink.kms_key", key_name_);
+  operation.SetAttribute("tink.bytes", ciphertext.size());
+  done = operation.EndWhenDone(std::move(done));
+  StartPolling();
+  auto call = absl::make_unique<AsyncCallImpl<DecryptResponse>>(
+      std::move(done));
+  PrepareContext(call->context());
+  auto reader = kms_stub_->AsyncDecrypt(
+      call->context(),
+      NewDecryptRequest(key_name_, ciphertext, associated_data),
+      &completion_queue_);
+  call.release()->Start(std::move(reader));
 }
 
 }  // namespace gcpkms
@@ -15,11 +15,19 @@
 #ifndef TINK_INTEGRATION_GCPKMS_GCP_KMS_AEAD_H_
 #define TINK_INTEGRATION_GCPKMS_GCP_KMS_AEAD_H_
 
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "absl/base/call_once.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 
 #include "google/cloud/kms/v1/service.grpc.pb.h"
+#include "grpcpp/completion_queue.h"
 
 #include "tink/aead.h"
+#include "tink/async_aead.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -30,17 +38,32 @@ namespace gcpkms {
 // GcpKmsAead is an implementation of AEAD that forwards
 // encryption/decryption requests to a key managed by
 // <a href="https://cloud.google.com/kms/">Google Cloud KMS</a>.
-class GcpKmsAead : public Aead {
+//
+// GcpKmsAead also implements AsyncAead: its asynchronous requests use
+// gRPC's asynchronous API, with the completions processed by a thread
+// that is started at the first request.  The destructor waits for pending
+// requests to complete.
+class GcpKmsAead : public Aead, public AsyncAead {
  public:
   // Creates a new GcpKmsAead that is bound to the key specified in 'key_name',
   // and that uses the channel when communicating with the KMS.
   // Valid values for 'key_name' have the following format:
   //    projects/*/locations/*/keyRings/*/cryptoKeys/*.
   // See https://cloud.google.com/kms/docs/object-hierarchy for more info.
+  // Each request fails with DEADLINE_EXCEEDED if it takes longer than
+  // 'request_timeout'.
   static crypto::tink::util::StatusOr<std::unique_ptr<Aead>>
   New(absl::string_view key_name,
       std::shared_ptr<google::cloud::kms::v1::KeyManagementService::Stub>
-          kms_stub);
+          kms_stub,
+      absl::Duration request_timeout = absl::InfiniteDuration());
+
+  // Like New(), but returns the AsyncAead-interface of GcpKmsAead.
+  static crypto::tink::util::StatusOr<std::unique_ptr<AsyncAead>>
+  NewAsync(absl::string_view key_name,
+           std::shared_ptr<google::cloud::kms::v1::KeyManagementService::Stub>
+               kms_stub,
+           absl::Duration request_timeout = absl::InfiniteDuration());
 
   crypto::tink::util::StatusOr<std::string> Encrypt(
       absl::string_view plaintext,
@@ -50,16 +73,36 @@ class GcpKmsAead : public Aead {
       absl::string_view ciphertext,
       absl::string_view associated_data) const override;
 
-  virtual ~GcpKmsAead() {}
+  void EncryptAsync(absl::string_view plaintext,
+                    absl::string_view associated_data,
+                    DoneCallback done) const override;
+
+  void DecryptAsync(absl::string_view ciphertext,
+                    absl::string_view associated_data,
+                    DoneCallback done) const override;
+
+  ~GcpKmsAead() override;
 
  private:
   GcpKmsAead(
       absl::string_view key_name,
       std::shared_ptr<google::cloud::kms::v1::KeyManagementService::Stub>
-          kms_stub);
+          kms_stub,
+      absl::Duration request_timeout);
+
+  // Sets the routing metadata and the deadline of a request.
+  void PrepareContext(grpc::ClientContext* context) const;
+
+  // Starts the thread that processes 'completion_queue_', if not yet done.
+  void StartPolling() const;
+
   std::string key_name_;  // The location of a crypto key in GCP KMS.
   std::shared_ptr<google::cloud::kms::v1::KeyManagementService::Stub>
       kms_stub_;
+  absl::Duration request_timeout_;
+  mutable grpc::CompletionQueue completion_queue_;
+  mutable absl::once_flag polling_started_;
+  mutable std::thread polling_thread_;
 };
 
 
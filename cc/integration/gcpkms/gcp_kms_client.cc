@@ -25,6 +25,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "tink/integration/gcpkms/gcp_kms_aead.h"
 #include "tink/kms_clients.h"
 #include "tink/util/errors.h"
@@ -103,7 +104,20 @@ std::string GetKeyName(absl::string_view key_uri) {
 StatusOr<std::unique_ptr<GcpKmsClient>>
 GcpKmsClient::New(absl::string_view key_uri,
                   absl::string_view credentials_path) {
+  return New(key_uri, credentials_path, absl::InfiniteDuration());
+}
+
+// static
+StatusOr<std::unique_ptr<GcpKmsClient>>
+GcpKmsClient::New(absl::string_view key_uri,
+                  absl::string_view credentials_path,
+                  absl::Duration request_timeout) {
+  if (request_timeout <= absl::ZeroDuration()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "The request timeout must be positive.");
+  }
   std::unique_ptr<GcpKmsClient> client(new GcpKmsClient());
+  client->request_timeout_ = request_timeout;
 
   // If a specific key is given, create a GCP KMSClient.
   if (!key_uri.empty()) {
@@ -137,6 +151,22 @@ bool GcpKmsClient::DoesSupport(absl::string_view key_uri) const {
 
 StatusOr<std::unique_ptr<Aead>>
 GcpKmsClient::GetAead(absl::string_view key_uri) const {
+  auto key_name_result = GetSupportedKeyName(key_uri);
+  if (!key_name_result.ok()) return key_name_result.status();
+  return GcpKmsAead::New(key_name_result.ValueOrDie(), kms_stub_,
+                         request_timeout_);
+}
+
+StatusOr<std::unique_ptr<AsyncAead>>
+GcpKmsClient::GetAsyncAead(absl::string_view key_uri) const {
+  auto key_name_result = GetSupportedKeyName(key_uri);
+  if (!key_name_result.ok()) return key_name_result.status();
+  return GcpKmsAead::NewAsync(key_name_result.ValueOrDie(), kms_stub_,
+                              request_timeout_);
+}
+
+StatusOr<std::string> GcpKmsClient::GetSupportedKeyName(
+    absl::string_view key_uri) const {
   if (!DoesSupport(key_uri)) {
     if (!key_name_.empty()) {
       return ToStatusF(util::error::INVALID_ARGUMENT,
@@ -148,11 +178,9 @@ GcpKmsClient::GetAead(absl::string_view key_uri) const {
     }
   }
   if (!key_name_.empty()) {  // This client is bound to a specific key.
-    return GcpKmsAead::New(key_name_, kms_stub_);
-  } else {  // Create an GCP KMSClient for the given key.
-    auto key_name = GetKeyName(key_uri);
-    return GcpKmsAead::New(key_name, kms_stub_);
+    return key_name_;
   }
+  return GetKeyName(key_uri);
 }
 
 Status GcpKmsClient::RegisterNewClient(absl::string_view key_uri,
@@ -18,9 +18,11 @@
 #include <memory>
 
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "google/cloud/kms/v1/service.grpc.pb.h"
 #include "grpcpp/channel.h"
 #include "tink/aead.h"
+#include "tink/async_aead.h"
 #include "tink/kms_client.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -44,6 +46,12 @@ class GcpKmsClient : public crypto::tink::KmsClient  {
   static crypto::tink::util::StatusOr<std::unique_ptr<GcpKmsClient>>
   New(absl::string_view key_uri, absl::string_view credentials_path);
 
+  // Like New() above, with the primitives of the client failing requests
+  // that take longer than 'request_timeout' with DEADLINE_EXCEEDED.
+  static crypto::tink::util::StatusOr<std::unique_ptr<GcpKmsClient>>
+  New(absl::string_view key_uri, absl::string_view credentials_path,
+      absl::Duration request_timeout);
+
   // Creates a new client and registers it in KMSClients.
   static crypto::tink::util::Status RegisterNewClient(
       absl::string_view key_uri, absl::string_view credentials_path);
@@ -56,11 +64,23 @@ class GcpKmsClient : public crypto::tink::KmsClient  {
   crypto::tink::util::StatusOr<std::unique_ptr<Aead>>
   GetAead(absl::string_view key_uri) const override;
 
+  // Returns an AsyncAead-primitive backed by KMS key specified by 'key_uri',
+  // provided that this KmsClient does support 'key_uri'.  All primitives
+  // of this client share its gRPC channel.
+  crypto::tink::util::StatusOr<std::unique_ptr<AsyncAead>>
+  GetAsyncAead(absl::string_view key_uri) const override;
+
  private:
   GcpKmsClient() {}
 
+  // Returns the name of the key specified by 'key_uri', or an error if this
+  // client does not support 'key_uri'.
+  crypto::tink::util::StatusOr<std::string> GetSupportedKeyName(
+      absl::string_view key_uri) const;
+
   std::string key_name_;
   std::shared_ptr<google::cloud::kms::v1::KeyManagementService::Stub> kms_stub_;
+  absl::Duration request_timeout_ = absl::InfiniteDuration();
 };
 
 
@@ -0,0 +1,231 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/integration/pkcs11/fake_pkcs11_api.h"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace integration {
+namespace pkcs11 {
+namespace test {
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace {
+
+constexpr int kTagSizeInBytes = 16;
+
+}  // namespace
+
+void FakePkcs11Api::AddKey(KeyClass key_class, absl::string_view label) {
+  absl::MutexLock lock(&mutex_);
+  ObjectHandle handle = 1000 + keys_.size();
+  keys_[handle] = Key{key_class, std::string(label)};
+}
+
+void FakePkcs11Api::SetOperationDelay(absl::Duration delay) {
+  absl::MutexLock lock(&mutex_);
+  operation_delay_ = delay;
+}
+
+void FakePkcs11Api::InvalidateOpenSessions() {
+  absl::MutexLock lock(&mutex_);
+  invalid_sessions_.insert(open_sessions_.begin(), open_sessions_.end());
+}
+
+void FakePkcs11Api::SetOpenSessionFails(bool fails) {
+  absl::MutexLock lock(&mutex_);
+  open_session_fails_ = fails;
+}
+
+int FakePkcs11Api::sessions_opened() const {
+  absl::MutexLock lock(&mutex_);
+  return sessions_opened_;
+}
+
+int FakePkcs11Api::sessions_closed() const {
+  absl::MutexLock lock(&mutex_);
+  return sessions_closed_;
+}
+
+int FakePkcs11Api::max_operations_in_flight() const {
+  absl::MutexLock lock(&mutex_);
+  return max_operations_in_flight_;
+}
+
+bool FakePkcs11Api::session_used_concurrently() const {
+  absl::MutexLock lock(&mutex_);
+  return session_used_concurrently_;
+}
+
+StatusOr<Pkcs11Api::SessionHandle> FakePkcs11Api::OpenSession() {
+  absl::MutexLock lock(&mutex_);
+  if (open_session_fails_) {
+    return Status(util::error::UNAVAILABLE, "CKR_DEVICE_REMOVED");
+  }
+  SessionHandle session = next_session_++;
+  open_sessions_.insert(session);
+  sessions_opened_++;
+  return session;
+}
+
+Status FakePkcs11Api::CloseSession(SessionHandle session) {
+  absl::MutexLock lock(&mutex_);
+  if (open_sessions_.erase(session) == 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "CKR_SESSION_HANDLE_INVALID");
+  }
+  invalid_sessions_.erase(session);
+  sessions_closed_++;
+  return Status::OK;
+}
+
+Status FakePkcs11Api::BeginOperation(SessionHandle session) {
+  absl::Duration delay;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (open_sessions_.count(session) == 0 ||
+        invalid_sessions_.count(session) != 0) {
+      return Status(util::error::UNAVAILABLE, "CKR_SESSION_HANDLE_INVALID");
+    }
+    if (!busy_sessions_.insert(session).second) {
+      session_used_concurrently_ = true;
+    }
+    operations_in_flight_++;
+    max_operations_in_flight_ =
+        std::max(max_operations_in_flight_, operations_in_flight_);
+    delay = operation_delay_;
+  }
+  absl::SleepFor(delay);
+  return Status::OK;
+}
+
+void FakePkcs11Api::EndOperation(SessionHandle session) {
+  absl::MutexLock lock(&mutex_);
+  busy_sessions_.erase(session);
+  operations_in_flight_--;
+}
+
+StatusOr<FakePkcs11Api::Key> FakePkcs11Api::GetKey(
+    ObjectHandle key, KeyClass key_class) const {
+  absl::MutexLock lock(&mutex_);
+  auto it = keys_.find(key);
+  if (it == keys_.end() || it->second.key_class != key_class) {
+    return Status(util::error::INVALID_ARGUMENT, "CKR_KEY_HANDLE_INVALID");
+  }
+  return it->second;
+}
+
+StatusOr<Pkcs11Api::ObjectHandle> FakePkcs11Api::FindKey(
+    SessionHandle session, KeyClass key_class, absl::string_view label) {
+  Status status = BeginOperation(session);
+  if (!status.ok()) return status;
+  StatusOr<ObjectHandle> result =
+      Status(util::error::NOT_FOUND, absl::StrCat("No key '", label, "'"));
+  {
+    absl::MutexLock lock(&mutex_);
+    for (const auto& entry : keys_) {
+      if (entry.second.key_class == key_class &&
+          entry.second.label == label) {
+        result = entry.first;
+      }
+    }
+  }
+  EndOperation(session);
+  return result;
+}
+
+StatusOr<std::string> FakePkcs11Api::Sign(SessionHandle session,
+                                          ObjectHandle key,
+                                          SignatureMechanism mechanism,
+                                          absl::string_view data) {
+  Status status = BeginOperation(session);
+  if (!status.ok()) return status;
+  StatusOr<Key> key_result = GetKey(key, KeyClass::kPrivateKey);
+  EndOperation(session);
+  if (!key_result.ok()) return key_result.status();
+  return absl::StrCat("signature of '", data, "' by '",
+                      key_result.ValueOrDie().label, "' with mechanism ",
+                      static_cast<int>(mechanism));
+}
+
+// static
+std::string FakePkcs11Api::Tag(const Key& key, absl::string_view iv,
+                               absl::string_view associated_data,
+                               absl::string_view plaintext) {
+  std::string input = absl::StrCat(key.label.size(), ":", key.label,
+                                    iv.size(), ":", iv, associated_data.size(),
+                                    ":", associated_data, plaintext);
+  std::string tag;
+  for (int i = 0; tag.size() < kTagSizeInBytes; i++) {
+    size_t checksum = std::hash<std::string>()(absl::StrCat(i, input));
+    tag.append(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+  }
+  tag.resize(kTagSizeInBytes);
+  return tag;
+}
+
+StatusOr<std::string> FakePkcs11Api::EncryptAesGcm(
+    SessionHandle session, ObjectHandle key, absl::string_view iv,
+    absl::string_view plaintext, absl::string_view associated_data) {
+  Status status = BeginOperation(session);
+  if (!status.ok()) return status;
+  StatusOr<Key> key_result = GetKey(key, KeyClass::kSecretKey);
+  EndOperation(session);
+  if (!key_result.ok()) return key_result.status();
+  return absl::StrCat(
+      plaintext, Tag(key_result.ValueOrDie(), iv, associated_data, plaintext));
+}
+
+StatusOr<std::string> FakePkcs11Api::DecryptAesGcm(
+    SessionHandle session, ObjectHandle key, absl::string_view iv,
+    absl::string_view ciphertext, absl::string_view associated_data) {
+  Status status = BeginOperation(session);
+  if (!status.ok()) return status;
+  StatusOr<Key> key_result = GetKey(key, KeyClass::kSecretKey);
+  EndOperation(session);
+  if (!key_result.ok()) return key_result.status();
+  if (ciphertext.size() < kTagSizeInBytes) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "CKR_ENCRYPTED_DATA_LEN_RANGE");
+  }
+  absl::string_view plaintext =
+      ciphertext.substr(0, ciphertext.size() - kTagSizeInBytes);
+  if (ciphertext.substr(plaintext.size()) !=
+      Tag(key_result.ValueOrDie(), iv, associated_data, plaintext)) {
+    return Status(util::error::INVALID_ARGUMENT, "CKR_ENCRYPTED_DATA_INVALID");
+  }
+  return std::string(plaintext);
+}
+
+}  // namespace test
+}  // namespace pkcs11
+}  // namespace integration
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,133 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_INTEGRATION_PKCS11_FAKE_PKCS11_API_H_
+#define TINK_INTEGRATION_PKCS11_FAKE_PKCS11_API_H_
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tink/integration/pkcs11/pkcs11_api.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace integration {
+namespace pkcs11 {
+namespace test {
+
+// FakePkcs11Api is an in-memory token for testing.  Its "signatures" and
+// "AES-GCM" are not cryptographic: a signature spells out the key, the
+// mechanism and the data, and the ciphertext of the AES-GCM functions is
+// the plaintext, followed by a checksum of the key, the IV, the associated
+// data and the plaintext as tag.
+//
+// The fake records how it is used, so that tests can check that no session
+// runs two operations at once and how many operations were in flight.
+class FakePkcs11Api : public Pkcs11Api {
+ public:
+  FakePkcs11Api() {}
+
+  // Adds a key to the token.
+  void AddKey(KeyClass key_class, absl::string_view label);
+
+  // Makes every operation take 'delay', so that operations overlap.
+  void SetOperationDelay(absl::Duration delay);
+
+  // Makes all sessions which are currently open fail every operation with
+  // UNAVAILABLE, as after the device was reset.
+  void InvalidateOpenSessions();
+
+  // Makes OpenSession() fail.
+  void SetOpenSessionFails(bool fails);
+
+  int sessions_opened() const;
+  int sessions_closed() const;
+  // The largest number of operations which ran at once.
+  int max_operations_in_flight() const;
+  // Whether an operation was started on a session which was still running
+  // another one.
+  bool session_used_concurrently() const;
+
+  crypto::tink::util::StatusOr<SessionHandle> OpenSession() override;
+
+  crypto::tink::util::Status CloseSession(SessionHandle session) override;
+
+  crypto::tink::util::StatusOr<ObjectHandle> FindKey(
+      SessionHandle session, KeyClass key_class,
+      absl::string_view label) override;
+
+  crypto::tink::util::StatusOr<std::string> Sign(
+      SessionHandle session, ObjectHandle key, SignatureMechanism mechanism,
+      absl::string_view data) override;
+
+  crypto::tink::util::StatusOr<std::string> EncryptAesGcm(
+      SessionHandle session, ObjectHandle key, absl::string_view iv,
+      absl::string_view plaintext,
+      absl::string_view associated_data) override;
+
+  crypto::tink::util::StatusOr<std::string> DecryptAesGcm(
+      SessionHandle session, ObjectHandle key, absl::string_view iv,
+      absl::string_view ciphertext,
+      absl::string_view associated_data) override;
+
+ private:
+  struct Key {
+    KeyClass key_class;
+    std::string label;
+  };
+
+  // Marks 'session' as running an operation, and waits for the operation
+  // delay.  Returns UNAVAILABLE if the session is not usable.
+  crypto::tink::util::Status BeginOperation(SessionHandle session);
+  void EndOperation(SessionHandle session);
+
+  crypto::tink::util::StatusOr<Key> GetKey(ObjectHandle key,
+                                           KeyClass key_class) const;
+
+  static std::string Tag(const Key& key, absl::string_view iv,
+                         absl::string_view associated_data,
+                         absl::string_view plaintext);
+
+  mutable absl::Mutex mutex_;
+  std::map<ObjectHandle, Key> keys_ ABSL_GUARDED_BY(mutex_);
+  std::set<SessionHandle> open_sessions_ ABSL_GUARDED_BY(mutex_);
+  std::set<SessionHandle> busy_sessions_ ABSL_GUARDED_BY(mutex_);
+  std::set<SessionHandle> invalid_sessions_ ABSL_GUARDED_BY(mutex_);
+  SessionHandle next_session_ ABSL_GUARDED_BY(mutex_) = 1;
+  absl::Duration operation_delay_ ABSL_GUARDED_BY(mutex_);
+  bool open_session_fails_ ABSL_GUARDED_BY(mutex_) = false;
+  int sessions_opened_ ABSL_GUARDED_BY(mutex_) = 0;
+  int sessions_closed_ ABSL_GUARDED_BY(mutex_) = 0;
+  int operations_in_flight_ ABSL_GUARDED_BY(mutex_) = 0;
+  int max_operations_in_flight_ ABSL_GUARDED_BY(mutex_) = 0;
+  bool session_used_concurrently_ ABSL_GUARDED_BY(mutex_) = false;
+};
+
+}  // namespace test
+}  // namespace pkcs11
+}  // namespace integration
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTEGRATION_PKCS11_FAKE_PKCS11_API_H_
@@ -0,0 +1,103 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/integration/pkcs11/pkcs11_aead.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/subtle/random.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace integration {
+namespace pkcs11 {
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+// static
+StatusOr<std::unique_ptr<Aead>> Pkcs11Aead::New(
+    std::shared_ptr<Pkcs11SessionPool> pool, absl::string_view key_label) {
+  if (pool == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT, "pool must not be null");
+  }
+  if (key_label.empty()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "key_label must not be empty");
+  }
+  Pkcs11Api& api = pool->api();
+  StatusOr<Pkcs11Api::ObjectHandle> key = pool->Run<Pkcs11Api::ObjectHandle>(
+      [&api, key_label](Pkcs11Api::SessionHandle session) {
+        return api.FindKey(session, Pkcs11Api::KeyClass::kSecretKey,
+                           key_label);
+      });
+  if (!key.ok()) return key.status();
+  return {absl::WrapUnique(new Pkcs11Aead(std::move(pool), key.ValueOrDie()))};
+}
+
+StatusOr<std::string> Pkcs11Aead::Encrypt(
+    absl::string_view plaintext, absl::string_view associated_data) const {
+  std::string iv = subtle::Random::GetRandomBytes(kIvSizeInBytes);
+  Pkcs11Api& api = pool_->api();
+  StatusOr<std::string> result = pool_->Run<std::string>(
+      [&](Pkcs11Api::SessionHandle session) {
+        return api.EncryptAesGcm(session, key_, iv, plaintext,
+                                 associated_data);
+      });
+  if (!result.ok()) {
+    return Status(result.status().CanonicalCode(),
+                  absl::StrCat("PKCS#11 encryption failed: ",
+                               result.status().error_message()));
+  }
+  if (result.ValueOrDie().size() != plaintext.size() + kTagSizeInBytes) {
+    return Status(util::error::INTERNAL,
+                  "PKCS#11 encryption returned a ciphertext of wrong size");
+  }
+  return absl::StrCat(iv, result.ValueOrDie());
+}
+
+StatusOr<std::string> Pkcs11Aead::Decrypt(
+    absl::string_view ciphertext, absl::string_view associated_data) const {
+  if (ciphertext.size() < kIvSizeInBytes + kTagSizeInBytes) {
+    return Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  Pkcs11Api& api = pool_->api();
+  StatusOr<std::string> result = pool_->Run<std::string>(
+      [&](Pkcs11Api::SessionHandle session) {
+        return api.DecryptAesGcm(session, key_,
+                                 ciphertext.substr(0, kIvSizeInBytes),
+                                 ciphertext.substr(kIvSizeInBytes),
+                                 associated_data);
+      });
+  if (!result.ok()) {
+    return Status(result.status().CanonicalCode(),
+                  absl::StrCat("PKCS#11 decryption failed: ",
+                               result.status().error_message()));
+  }
+  return result;
+}
+
+}  // namespace pkcs11
+}  // namespace integration
+}  // namespace tink
+}  // namespace crypto
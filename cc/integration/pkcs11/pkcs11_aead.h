@@ -0,0 +1,71 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_INTEGRATION_PKCS11_PKCS11_AEAD_H_
+#define TINK_INTEGRATION_PKCS11_PKCS11_AEAD_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/integration/pkcs11/pkcs11_api.h"
+#include "tink/integration/pkcs11/pkcs11_session_pool.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace integration {
+namespace pkcs11 {
+
+// Pkcs11Aead is an implementation of AEAD that encrypts with AES-GCM under
+// a secret key which never leaves an HSM.  The ciphertexts are the
+// 12 byte IV, which Tink draws, followed by the ciphertext and the 16 byte
+// tag, as with AesGcmBoringSsl.  Concurrent calls run on different
+// sessions of the pool.
+class Pkcs11Aead : public Aead {
+ public:
+  // Creates a new Pkcs11Aead for the secret key with label 'key_label'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
+      std::shared_ptr<Pkcs11SessionPool> pool, absl::string_view key_label);
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override;
+
+ private:
+  static constexpr int kIvSizeInBytes = 12;
+  static constexpr int kTagSizeInBytes = 16;
+
+  Pkcs11Aead(std::shared_ptr<Pkcs11SessionPool> pool,
+             Pkcs11Api::ObjectHandle key)
+      : pool_(std::move(pool)), key_(key) {}
+
+  const std::shared_ptr<Pkcs11SessionPool> pool_;
+  const Pkcs11Api::ObjectHandle key_;
+};
+
+}  // namespace pkcs11
+}  // namespace integration
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTEGRATION_PKCS11_PKCS11_AEAD_H_
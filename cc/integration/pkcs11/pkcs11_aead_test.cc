@@ -0,0 +1,105 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/integration/pkcs11/pkcs11_aead.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "tink/integration/pkcs11/fake_pkcs11_api.h"
+#include "tink/integration/pkcs11/pkcs11_api.h"
+#include "tink/integration/pkcs11/pkcs11_session_pool.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace integration {
+namespace pkcs11 {
+namespace {
+
+using crypto::tink::integration::pkcs11::test::FakePkcs11Api;
+
+class Pkcs11AeadTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    api_ = std::make_shared<FakePkcs11Api>();
+    api_->AddKey(Pkcs11Api::KeyClass::kSecretKey, "wrapping-key");
+    api_->AddKey(Pkcs11Api::KeyClass::kPrivateKey, "signing-key");
+    pool_ = Pkcs11SessionPool::New(api_, 4).ValueOrDie();
+  }
+
+  std::shared_ptr<FakePkcs11Api> api_;
+  std::shared_ptr<Pkcs11SessionPool> pool_;
+};
+
+TEST_F(Pkcs11AeadTest, EncryptDecrypt) {
+  auto aead = Pkcs11Aead::New(pool_, "wrapping-key").ValueOrDie();
+  std::string plaintext = "some plaintext";
+  std::string associated_data = "some associated data";
+  auto ciphertext = aead->Encrypt(plaintext, associated_data);
+  ASSERT_TRUE(ciphertext.ok()) << ciphertext.status();
+  EXPECT_EQ(12 + plaintext.size() + 16, ciphertext.ValueOrDie().size());
+
+  auto decrypted = aead->Decrypt(ciphertext.ValueOrDie(), associated_data);
+  ASSERT_TRUE(decrypted.ok()) << decrypted.status();
+  EXPECT_EQ(plaintext, decrypted.ValueOrDie());
+
+  // Each encryption uses a fresh IV.
+  EXPECT_NE(ciphertext.ValueOrDie(),
+            aead->Encrypt(plaintext, associated_data).ValueOrDie());
+}
+
+TEST_F(Pkcs11AeadTest, DecryptFailsForModifiedCiphertext) {
+  auto aead = Pkcs11Aead::New(pool_, "wrapping-key").ValueOrDie();
+  std::string ciphertext = aead->Encrypt("plaintext", "ad").ValueOrDie();
+
+  EXPECT_FALSE(aead->Decrypt(ciphertext, "other ad").ok());
+  for (size_t i = 0; i < ciphertext.size(); i++) {
+    std::string modified = ciphertext;
+    modified[i] ^= 1;
+    EXPECT_FALSE(aead->Decrypt(modified, "ad").ok()) << "byte " << i;
+  }
+  auto result = aead->Decrypt(ciphertext.substr(0, 27), "ad");
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+}
+
+TEST_F(Pkcs11AeadTest, KeyMustBeSecretKey) {
+  EXPECT_EQ(util::error::NOT_FOUND,
+            Pkcs11Aead::New(pool_, "signing-key").status().error_code());
+  EXPECT_EQ(util::error::NOT_FOUND,
+            Pkcs11Aead::New(pool_, "unknown-key").status().error_code());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            Pkcs11Aead::New(pool_, "").status().error_code());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            Pkcs11Aead::New(nullptr, "wrapping-key").status().error_code());
+}
+
+TEST_F(Pkcs11AeadTest, SurvivesDeviceReset) {
+  auto aead = Pkcs11Aead::New(pool_, "wrapping-key").ValueOrDie();
+  std::string ciphertext = aead->Encrypt("plaintext", "ad").ValueOrDie();
+  api_->InvalidateOpenSessions();
+  auto decrypted = aead->Decrypt(ciphertext, "ad");
+  ASSERT_TRUE(decrypted.ok()) << decrypted.status();
+  EXPECT_EQ("plaintext", decrypted.ValueOrDie());
+}
+
+}  // namespace
+}  // namespace pkcs11
+}  // namespace integration
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,99 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_INTEGRATION_PKCS11_PKCS11_API_H_
+#define TINK_INTEGRATION_PKCS11_PKCS11_API_H_
+
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace integration {
+namespace pkcs11 {
+
+// The part of a PKCS#11 library which the HSM-backed primitives use, one
+// method per sequence of C_* calls.  An implementation wraps the function
+// list of the vendor's library for one token, on which it has called
+// C_Initialize, and whose user it logs in with the first session.  All
+// methods may be called concurrently, on different sessions.
+//
+// Errors which mean that a session can no longer be used, such as
+// CKR_SESSION_HANDLE_INVALID, CKR_SESSION_CLOSED or CKR_DEVICE_REMOVED,
+// must be returned as UNAVAILABLE, so that Pkcs11SessionPool replaces the
+// session.
+class Pkcs11Api {
+ public:
+  // CK_SESSION_HANDLE and CK_OBJECT_HANDLE.
+  using SessionHandle = uint64_t;
+  using ObjectHandle = uint64_t;
+
+  enum class KeyClass {
+    kPrivateKey,  // CKO_PRIVATE_KEY
+    kSecretKey,   // CKO_SECRET_KEY
+  };
+
+  enum class SignatureMechanism {
+    kRsaPkcs1Sha256,  // CKM_SHA256_RSA_PKCS
+    kRsaPkcs1Sha512,  // CKM_SHA512_RSA_PKCS
+    kRsaPssSha256,    // CKM_SHA256_RSA_PKCS_PSS with MGF1-SHA256 and a
+                      // 32 byte salt
+    kEcdsaSha256,     // CKM_ECDSA_SHA256, with IEEE P1363 signatures
+  };
+
+  virtual ~Pkcs11Api() = default;
+
+  // C_OpenSession with CKF_SERIAL_SESSION.
+  virtual crypto::tink::util::StatusOr<SessionHandle> OpenSession() = 0;
+
+  // C_CloseSession.
+  virtual crypto::tink::util::Status CloseSession(SessionHandle session) = 0;
+
+  // C_FindObjectsInit, C_FindObjects and C_FindObjectsFinal for the one
+  // object of class 'key_class' with CKA_LABEL 'label'.  Object handles of
+  // token objects are valid in all sessions.
+  virtual crypto::tink::util::StatusOr<ObjectHandle> FindKey(
+      SessionHandle session, KeyClass key_class, absl::string_view label) = 0;
+
+  // C_SignInit and C_Sign.
+  virtual crypto::tink::util::StatusOr<std::string> Sign(
+      SessionHandle session, ObjectHandle key, SignatureMechanism mechanism,
+      absl::string_view data) = 0;
+
+  // C_EncryptInit with CKM_AES_GCM, a 128 bit tag and the given IV and
+  // associated data, and C_Encrypt.  Returns the ciphertext followed by the
+  // tag.
+  virtual crypto::tink::util::StatusOr<std::string> EncryptAesGcm(
+      SessionHandle session, ObjectHandle key, absl::string_view iv,
+      absl::string_view plaintext, absl::string_view associated_data) = 0;
+
+  // C_DecryptInit with CKM_AES_GCM and C_Decrypt, for the ciphertext
+  // followed by the tag.
+  virtual crypto::tink::util::StatusOr<std::string> DecryptAesGcm(
+      SessionHandle session, ObjectHandle key, absl::string_view iv,
+      absl::string_view ciphertext, absl::string_view associated_data) = 0;
+};
+
+}  // namespace pkcs11
+}  // namespace integration
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTEGRATION_PKCS11_PKCS11_API_H_
@@ -0,0 +1,187 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/integration/pkcs11/pkcs11_client.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "tink/integration/pkcs11/pkcs11_aead.h"
+#include "tink/integration/pkcs11/pkcs11_public_key_sign.h"
+#include "tink/kms_clients.h"
+#include "tink/thread_pool_executor.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace integration {
+namespace pkcs11 {
+
+namespace {
+
+using crypto::tink::ToStatusF;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+static constexpr char kKeyUriPrefix[] = "pkcs11:";
+
+struct KeyUri {
+  std::string label;
+  std::string type;
+};
+
+int HexDigitValue(char c) {
+  if (absl::ascii_isdigit(c)) return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// Decodes the %XX escapes of an attribute value.
+StatusOr<std::string> PercentDecode(absl::string_view value) {
+  std::string decoded;
+  decoded.reserve(value.size());
+  for (size_t i = 0; i < value.size(); i++) {
+    if (value[i] != '%') {
+      decoded.push_back(value[i]);
+      continue;
+    }
+    int high = i + 2 < value.size() ? HexDigitValue(value[i + 1]) : -1;
+    int low = i + 2 < value.size() ? HexDigitValue(value[i + 2]) : -1;
+    if (high < 0 || low < 0) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    "Invalid percent-encoding in PKCS#11 URI");
+    }
+    decoded.push_back(static_cast<char>(high * 16 + low));
+    i += 2;
+  }
+  return decoded;
+}
+
+// Parses the path attributes 'object' and 'type' of a PKCS#11 URI.  The
+// query attributes, after '?', are ignored.
+StatusOr<KeyUri> ParseKeyUri(absl::string_view key_uri) {
+  if (!absl::StartsWithIgnoreCase(key_uri, kKeyUriPrefix)) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key '%s' is not a PKCS#11 URI", key_uri);
+  }
+  absl::string_view path = key_uri.substr(sizeof(kKeyUriPrefix) - 1);
+  path = path.substr(0, path.find('?'));
+  KeyUri parsed;
+  for (absl::string_view attribute :
+       absl::StrSplit(path, ';', absl::SkipEmpty())) {
+    std::pair<absl::string_view, absl::string_view> name_and_value =
+        absl::StrSplit(attribute, absl::MaxSplits('=', 1));
+    StatusOr<std::string> value = PercentDecode(name_and_value.second);
+    if (!value.ok()) return value.status();
+    if (name_and_value.first == "object") {
+      parsed.label = std::move(value.ValueOrDie());
+    } else if (name_and_value.first == "type") {
+      parsed.type = std::move(value.ValueOrDie());
+    }
+  }
+  if (parsed.label.empty()) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "PKCS#11 URI '%s' has no object attribute", key_uri);
+  }
+  return parsed;
+}
+
+}  // namespace
+
+// static
+StatusOr<std::unique_ptr<Pkcs11Client>> Pkcs11Client::New(
+    absl::string_view key_uri, std::shared_ptr<Pkcs11Api> api,
+    const Options& options) {
+  std::unique_ptr<Pkcs11Client> client(new Pkcs11Client());
+  // If a specific key is given, bind the client to it.
+  if (!key_uri.empty()) {
+    StatusOr<KeyUri> parsed = ParseKeyUri(key_uri);
+    if (!parsed.ok()) return parsed.status();
+    client->key_label_ = parsed.ValueOrDie().label;
+  }
+  auto pool_result = Pkcs11SessionPool::New(std::move(api),
+                                            options.max_sessions);
+  if (!pool_result.ok()) return pool_result.status();
+  client->pool_ = std::move(pool_result.ValueOrDie());
+  client->executor_ = options.executor;
+  if (client->executor_ == nullptr) {
+    client->executor_ = NewThreadPoolExecutor(options.max_sessions - 1);
+  }
+  return std::move(client);
+}
+
+// static
+Status Pkcs11Client::RegisterNewClient(absl::string_view key_uri,
+                                       std::shared_ptr<Pkcs11Api> api,
+                                       const Options& options) {
+  auto client_result = Pkcs11Client::New(key_uri, std::move(api), options);
+  if (!client_result.ok()) return client_result.status();
+  return KmsClients::Add(std::move(client_result.ValueOrDie()));
+}
+
+bool Pkcs11Client::DoesSupport(absl::string_view key_uri) const {
+  StatusOr<KeyUri> parsed = ParseKeyUri(key_uri);
+  if (!parsed.ok()) return false;
+  return key_label_.empty() || key_label_ == parsed.ValueOrDie().label;
+}
+
+StatusOr<std::string> Pkcs11Client::GetSupportedKeyLabel(
+    absl::string_view key_uri, absl::string_view type) const {
+  if (!DoesSupport(key_uri)) {
+    if (!key_label_.empty()) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "This client is bound to '%s', and cannot use key '%s'.",
+                       key_label_, key_uri);
+    }
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "This client does not support key '%s'.", key_uri);
+  }
+  KeyUri parsed = ParseKeyUri(key_uri).ValueOrDie();
+  if (!parsed.type.empty() && parsed.type != type) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key '%s' is not of type '%s'.", key_uri, type);
+  }
+  return parsed.label;
+}
+
+StatusOr<std::unique_ptr<Aead>> Pkcs11Client::GetAead(
+    absl::string_view key_uri) const {
+  auto label_result = GetSupportedKeyLabel(key_uri, "secret-key");
+  if (!label_result.ok()) return label_result.status();
+  return Pkcs11Aead::New(pool_, label_result.ValueOrDie());
+}
+
+StatusOr<std::unique_ptr<PublicKeySign>> Pkcs11Client::GetPublicKeySign(
+    absl::string_view key_uri,
+    Pkcs11Api::SignatureMechanism mechanism) const {
+  auto label_result = GetSupportedKeyLabel(key_uri, "private");
+  if (!label_result.ok()) return label_result.status();
+  return Pkcs11PublicKeySign::New(pool_, label_result.ValueOrDie(), mechanism,
+                                  executor_);
+}
+
+}  // namespace pkcs11
+}  // namespace integration
+}  // namespace tink
+}  // namespace crypto
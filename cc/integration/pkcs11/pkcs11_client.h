@@ -0,0 +1,103 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_INTEGRATION_PKCS11_PKCS11_CLIENT_H_
+#define TINK_INTEGRATION_PKCS11_PKCS11_CLIENT_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/executor.h"
+#include "tink/integration/pkcs11/pkcs11_api.h"
+#include "tink/integration/pkcs11/pkcs11_session_pool.h"
+#include "tink/kms_client.h"
+#include "tink/public_key_sign.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace integration {
+namespace pkcs11 {
+
+// Pkcs11Client is an implementation of KmsClient for keys in an HSM, or any
+// other token with a PKCS#11 library.  Keys are named by PKCS#11 URIs
+// (RFC 7512) with the label of the key as 'object' attribute, e.g.
+// "pkcs11:object=payments-signing-key;type=private".  The 'type' attribute
+// is optional; other attributes are ignored, since the token is the one of
+// the Pkcs11Api.
+//
+// All primitives of a client share one pool of sessions.
+class Pkcs11Client : public crypto::tink::KmsClient {
+ public:
+  struct Options {
+    // The maximal number of sessions open at once, and so the maximal
+    // number of operations in flight on the token.
+    int max_sessions = 16;
+    // Runs the C_Sign calls of PublicKeySign::SignBatch() in parallel.  If
+    // null, the client creates a pool of max_sessions - 1 threads.
+    std::shared_ptr<Executor> executor;
+  };
+
+  // Creates a new Pkcs11Client for the token of 'api'.  If 'key_uri' is not
+  // empty, the client is bound to that key.
+  static crypto::tink::util::StatusOr<std::unique_ptr<Pkcs11Client>> New(
+      absl::string_view key_uri, std::shared_ptr<Pkcs11Api> api,
+      const Options& options);
+
+  // Creates a new client and registers it in KmsClients.
+  static crypto::tink::util::Status RegisterNewClient(
+      absl::string_view key_uri, std::shared_ptr<Pkcs11Api> api,
+      const Options& options);
+
+  // Returns true iff this client does support the key specified by
+  // 'key_uri'.
+  bool DoesSupport(absl::string_view key_uri) const override;
+
+  // Returns an Aead-primitive backed by the AES secret key specified by
+  // 'key_uri', provided that this client does support 'key_uri'.
+  crypto::tink::util::StatusOr<std::unique_ptr<Aead>> GetAead(
+      absl::string_view key_uri) const override;
+
+  // Returns a PublicKeySign-primitive backed by the private key specified
+  // by 'key_uri', which signs with 'mechanism'.
+  crypto::tink::util::StatusOr<std::unique_ptr<PublicKeySign>>
+  GetPublicKeySign(absl::string_view key_uri,
+                   Pkcs11Api::SignatureMechanism mechanism) const;
+
+ private:
+  Pkcs11Client() {}
+
+  // Returns the label of the key specified by 'key_uri', or an error if
+  // this client does not support 'key_uri' or if the key is not of type
+  // 'type'.
+  crypto::tink::util::StatusOr<std::string> GetSupportedKeyLabel(
+      absl::string_view key_uri, absl::string_view type) const;
+
+  // The label of the key the client is bound to, if any.
+  std::string key_label_;
+  std::shared_ptr<Pkcs11SessionPool> pool_;
+  std::shared_ptr<Executor> executor_;
+};
+
+}  // namespace pkcs11
+}  // namespace integration
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTEGRATION_PKCS11_PKCS11_CLIENT_H_
@@ -0,0 +1,119 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/integration/pkcs11/pkcs11_client.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "tink/integration/pkcs11/fake_pkcs11_api.h"
+#include "tink/integration/pkcs11/pkcs11_api.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace integration {
+namespace pkcs11 {
+namespace {
+
+using crypto::tink::integration::pkcs11::test::FakePkcs11Api;
+
+constexpr Pkcs11Api::SignatureMechanism kMechanism =
+    Pkcs11Api::SignatureMechanism::kEcdsaSha256;
+
+class Pkcs11ClientTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    api_ = std::make_shared<FakePkcs11Api>();
+    api_->AddKey(Pkcs11Api::KeyClass::kSecretKey, "wrapping key");
+    api_->AddKey(Pkcs11Api::KeyClass::kPrivateKey, "signing-key");
+  }
+
+  std::shared_ptr<FakePkcs11Api> api_;
+};
+
+TEST_F(Pkcs11ClientTest, ClientNotBoundToAKey) {
+  auto client = Pkcs11Client::New("", api_, {}).ValueOrDie();
+  EXPECT_TRUE(client->DoesSupport("pkcs11:object=signing-key"));
+  EXPECT_TRUE(client->DoesSupport("PKCS11:token=hsm;object=wrapping%20key"));
+  EXPECT_TRUE(client->DoesSupport("pkcs11:object=a?pin-source=file:pin"));
+  EXPECT_FALSE(client->DoesSupport("pkcs11:token=hsm"));
+  EXPECT_FALSE(client->DoesSupport("pkcs11:object=bad%2"));
+  EXPECT_FALSE(client->DoesSupport("gcp-kms://projects/p/keys/k"));
+}
+
+TEST_F(Pkcs11ClientTest, ClientBoundToAKey) {
+  auto client =
+      Pkcs11Client::New("pkcs11:object=signing-key", api_, {}).ValueOrDie();
+  EXPECT_TRUE(client->DoesSupport("pkcs11:object=signing-key;type=private"));
+  EXPECT_FALSE(client->DoesSupport("pkcs11:object=wrapping%20key"));
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            client->GetAead("pkcs11:object=wrapping%20key")
+                .status()
+                .error_code());
+
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            Pkcs11Client::New("pkcs11:token=hsm", api_, {})
+                .status()
+                .error_code());
+}
+
+TEST_F(Pkcs11ClientTest, GetPrimitives) {
+  auto client = Pkcs11Client::New("", api_, {}).ValueOrDie();
+  auto aead = client->GetAead("pkcs11:object=wrapping%20key;type=secret-key");
+  ASSERT_TRUE(aead.ok()) << aead.status();
+  std::string ciphertext =
+      aead.ValueOrDie()->Encrypt("plaintext", "ad").ValueOrDie();
+  EXPECT_EQ("plaintext",
+            aead.ValueOrDie()->Decrypt(ciphertext, "ad").ValueOrDie());
+
+  auto signer =
+      client->GetPublicKeySign("pkcs11:object=signing-key", kMechanism);
+  ASSERT_TRUE(signer.ok()) << signer.status();
+  EXPECT_TRUE(signer.ValueOrDie()->Sign("message").ok());
+
+  // Both primitives share the sessions of the client.
+  EXPECT_EQ(1, api_->sessions_opened());
+}
+
+TEST_F(Pkcs11ClientTest, TypeMustMatch) {
+  auto client = Pkcs11Client::New("", api_, {}).ValueOrDie();
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            client->GetAead("pkcs11:object=wrapping%20key;type=private")
+                .status()
+                .error_code());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            client
+                ->GetPublicKeySign(
+                    "pkcs11:object=signing-key;type=secret-key", kMechanism)
+                .status()
+                .error_code());
+}
+
+TEST_F(Pkcs11ClientTest, InvalidMaxSessions) {
+  Pkcs11Client::Options options;
+  options.max_sessions = 0;
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            Pkcs11Client::New("", api_, options).status().error_code());
+}
+
+}  // namespace
+}  // namespace pkcs11
+}  // namespace integration
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,98 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/integration/pkcs11/pkcs11_public_key_sign.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace integration {
+namespace pkcs11 {
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+// static
+StatusOr<std::unique_ptr<PublicKeySign>> Pkcs11PublicKeySign::New(
+    std::shared_ptr<Pkcs11SessionPool> pool, absl::string_view key_label,
+    Pkcs11Api::SignatureMechanism mechanism,
+    std::shared_ptr<Executor> executor) {
+  if (pool == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT, "pool must not be null");
+  }
+  if (key_label.empty()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "key_label must not be empty");
+  }
+  Pkcs11Api& api = pool->api();
+  StatusOr<Pkcs11Api::ObjectHandle> key = pool->Run<Pkcs11Api::ObjectHandle>(
+      [&api, key_label](Pkcs11Api::SessionHandle session) {
+        return api.FindKey(session, Pkcs11Api::KeyClass::kPrivateKey,
+                           key_label);
+      });
+  if (!key.ok()) return key.status();
+  return {absl::WrapUnique(new Pkcs11PublicKeySign(
+      std::move(pool), key.ValueOrDie(), mechanism, std::move(executor)))};
+}
+
+StatusOr<std::string> Pkcs11PublicKeySign::Sign(
+    absl::string_view data) const {
+  Pkcs11Api& api = pool_->api();
+  StatusOr<std::string> result =
+      pool_->Run<std::string>([&](Pkcs11Api::SessionHandle session) {
+        return api.Sign(session, key_, mechanism_, data);
+      });
+  if (!result.ok()) {
+    return Status(result.status().CanonicalCode(),
+                  absl::StrCat("PKCS#11 signing failed: ",
+                               result.status().error_message()));
+  }
+  return result;
+}
+
+StatusOr<std::vector<std::string>> Pkcs11PublicKeySign::SignBatch(
+    absl::Span<const absl::string_view> data) const {
+  if (executor_ == nullptr || data.size() < 2) {
+    return PublicKeySign::SignBatch(data);
+  }
+  // C_Sign blocks its thread until the device is done, so the calls are
+  // spread over threads, each of which takes a session of its own.
+  std::vector<StatusOr<std::string>> results(
+      data.size(), Status(util::error::INTERNAL, "not signed"));
+  executor_->ParallelFor(data.size(),
+                         [&](int i) { results[i] = Sign(data[i]); });
+  std::vector<std::string> signatures;
+  signatures.reserve(data.size());
+  for (StatusOr<std::string>& result : results) {
+    if (!result.ok()) return result.status();
+    signatures.push_back(std::move(result.ValueOrDie()));
+  }
+  return signatures;
+}
+
+}  // namespace pkcs11
+}  // namespace integration
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,81 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_INTEGRATION_PKCS11_PKCS11_PUBLIC_KEY_SIGN_H_
+#define TINK_INTEGRATION_PKCS11_PKCS11_PUBLIC_KEY_SIGN_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/executor.h"
+#include "tink/integration/pkcs11/pkcs11_api.h"
+#include "tink/integration/pkcs11/pkcs11_session_pool.h"
+#include "tink/public_key_sign.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace integration {
+namespace pkcs11 {
+
+// Pkcs11PublicKeySign signs with a private key which never leaves an HSM.
+// Concurrent calls run on different sessions of the pool.  The signatures
+// are those of the PKCS#11 mechanism, e.g. ECDSA signatures are in the
+// IEEE P1363 encoding.
+class Pkcs11PublicKeySign : public PublicKeySign {
+ public:
+  // Creates a new Pkcs11PublicKeySign for the private key with label
+  // 'key_label'.  SignBatch() runs its C_Sign calls on the threads of
+  // 'executor' and the calling thread, so that up to the number of
+  // sessions of the pool are in flight at once; with a null 'executor' it
+  // signs one item after the other.
+  static crypto::tink::util::StatusOr<std::unique_ptr<PublicKeySign>> New(
+      std::shared_ptr<Pkcs11SessionPool> pool, absl::string_view key_label,
+      Pkcs11Api::SignatureMechanism mechanism,
+      std::shared_ptr<Executor> executor);
+
+  crypto::tink::util::StatusOr<std::string> Sign(
+      absl::string_view data) const override;
+
+  crypto::tink::util::StatusOr<std::vector<std::string>> SignBatch(
+      absl::Span<const absl::string_view> data) const override;
+
+ private:
+  Pkcs11PublicKeySign(std::shared_ptr<Pkcs11SessionPool> pool,
+                      Pkcs11Api::ObjectHandle key,
+                      Pkcs11Api::SignatureMechanism mechanism,
+                      std::shared_ptr<Executor> executor)
+      : pool_(std::move(pool)),
+        key_(key),
+        mechanism_(mechanism),
+        executor_(std::move(executor)) {}
+
+  const std::shared_ptr<Pkcs11SessionPool> pool_;
+  const Pkcs11Api::ObjectHandle key_;
+  const Pkcs11Api::SignatureMechanism mechanism_;
+  const std::shared_ptr<Executor> executor_;
+};
+
+}  // namespace pkcs11
+}  // namespace integration
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTEGRATION_PKCS11_PKCS11_PUBLIC_KEY_SIGN_H_
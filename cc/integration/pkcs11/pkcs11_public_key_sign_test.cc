@@ -0,0 +1,123 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/integration/pkcs11/pkcs11_public_key_sign.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "tink/integration/pkcs11/fake_pkcs11_api.h"
+#include "tink/integration/pkcs11/pkcs11_api.h"
+#include "tink/integration/pkcs11/pkcs11_session_pool.h"
+#include "tink/thread_pool_executor.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace integration {
+namespace pkcs11 {
+namespace {
+
+using crypto::tink::integration::pkcs11::test::FakePkcs11Api;
+
+constexpr Pkcs11Api::SignatureMechanism kMechanism =
+    Pkcs11Api::SignatureMechanism::kRsaPkcs1Sha256;
+
+class Pkcs11PublicKeySignTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    api_ = std::make_shared<FakePkcs11Api>();
+    api_->AddKey(Pkcs11Api::KeyClass::kPrivateKey, "signing-key");
+    api_->AddKey(Pkcs11Api::KeyClass::kSecretKey, "wrapping-key");
+  }
+
+  std::shared_ptr<FakePkcs11Api> api_;
+};
+
+TEST_F(Pkcs11PublicKeySignTest, Sign) {
+  auto pool = Pkcs11SessionPool::New(api_, 2).ValueOrDie();
+  auto signer =
+      Pkcs11PublicKeySign::New(std::move(pool), "signing-key", kMechanism,
+                               nullptr)
+          .ValueOrDie();
+  auto signature = signer->Sign("message");
+  ASSERT_TRUE(signature.ok()) << signature.status();
+  EXPECT_NE(std::string::npos, signature.ValueOrDie().find("'message'"));
+  EXPECT_NE(std::string::npos, signature.ValueOrDie().find("'signing-key'"));
+}
+
+TEST_F(Pkcs11PublicKeySignTest, KeyMustBePrivateKey) {
+  std::shared_ptr<Pkcs11SessionPool> pool =
+      Pkcs11SessionPool::New(api_, 2).ValueOrDie();
+  EXPECT_EQ(util::error::NOT_FOUND,
+            Pkcs11PublicKeySign::New(pool, "wrapping-key", kMechanism, nullptr)
+                .status()
+                .error_code());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            Pkcs11PublicKeySign::New(pool, "", kMechanism, nullptr)
+                .status()
+                .error_code());
+}
+
+TEST_F(Pkcs11PublicKeySignTest, SignBatchRunsOnAllSessions) {
+  const int kMaxSessions = 4;
+  api_->SetOperationDelay(absl::Milliseconds(10));
+  auto pool = Pkcs11SessionPool::New(api_, kMaxSessions).ValueOrDie();
+  auto signer =
+      Pkcs11PublicKeySign::New(std::move(pool), "signing-key", kMechanism,
+                               NewThreadPoolExecutor(kMaxSessions - 1))
+          .ValueOrDie();
+
+  std::vector<std::string> messages;
+  for (int i = 0; i < 32; i++) messages.push_back(absl::StrCat("message ", i));
+  std::vector<absl::string_view> data(messages.begin(), messages.end());
+  auto signatures = signer->SignBatch(data);
+  ASSERT_TRUE(signatures.ok()) << signatures.status();
+  ASSERT_EQ(messages.size(), signatures.ValueOrDie().size());
+  for (size_t i = 0; i < messages.size(); i++) {
+    EXPECT_EQ(signer->Sign(messages[i]).ValueOrDie(),
+              signatures.ValueOrDie()[i]);
+  }
+  EXPECT_FALSE(api_->session_used_concurrently());
+  EXPECT_GT(api_->max_operations_in_flight(), 1);
+  EXPECT_LE(api_->max_operations_in_flight(), kMaxSessions);
+}
+
+TEST_F(Pkcs11PublicKeySignTest, SignBatchWithoutExecutor) {
+  auto pool = Pkcs11SessionPool::New(api_, 4).ValueOrDie();
+  auto signer =
+      Pkcs11PublicKeySign::New(std::move(pool), "signing-key", kMechanism,
+                               nullptr)
+          .ValueOrDie();
+  std::vector<absl::string_view> data = {"a", "b", "c"};
+  auto signatures = signer->SignBatch(data);
+  ASSERT_TRUE(signatures.ok()) << signatures.status();
+  ASSERT_EQ(3, signatures.ValueOrDie().size());
+  EXPECT_EQ(signer->Sign("b").ValueOrDie(), signatures.ValueOrDie()[1]);
+  EXPECT_EQ(1, api_->max_operations_in_flight());
+}
+
+}  // namespace
+}  // namespace pkcs11
+}  // namespace integration
+}  // namespace tink
+}  // namespace crypto
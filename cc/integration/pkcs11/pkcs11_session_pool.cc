@@ -0,0 +1,97 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/integration/pkcs11/pkcs11_session_pool.h"
+
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace integration {
+namespace pkcs11 {
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+StatusOr<std::unique_ptr<Pkcs11SessionPool>> Pkcs11SessionPool::New(
+    std::shared_ptr<Pkcs11Api> api, int max_sessions) {
+  if (api == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT, "api must not be null");
+  }
+  if (max_sessions < 1) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "max_sessions must be positive");
+  }
+  return absl::WrapUnique(new Pkcs11SessionPool(std::move(api), max_sessions));
+}
+
+Pkcs11SessionPool::~Pkcs11SessionPool() {
+  absl::MutexLock lock(&mutex_);
+  for (Pkcs11Api::SessionHandle session : idle_sessions_) {
+    api_->CloseSession(session).IgnoreError();
+  }
+}
+
+int Pkcs11SessionPool::open_sessions() const {
+  absl::MutexLock lock(&mutex_);
+  return open_sessions_;
+}
+
+StatusOr<Pkcs11Api::SessionHandle> Pkcs11SessionPool::Acquire() {
+  {
+    absl::MutexLock lock(&mutex_);
+    auto available = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+      return !idle_sessions_.empty() || open_sessions_ < max_sessions_;
+    };
+    mutex_.Await(absl::Condition(&available));
+    if (!idle_sessions_.empty()) {
+      Pkcs11Api::SessionHandle session = idle_sessions_.back();
+      idle_sessions_.pop_back();
+      return session;
+    }
+    open_sessions_++;
+  }
+  // Opening a session can take a round trip to the device, so other
+  // callers can meanwhile take sessions which are returned.
+  StatusOr<Pkcs11Api::SessionHandle> session = api_->OpenSession();
+  if (!session.ok()) {
+    absl::MutexLock lock(&mutex_);
+    open_sessions_--;
+  }
+  return session;
+}
+
+void Pkcs11SessionPool::Release(Pkcs11Api::SessionHandle session,
+                                bool usable) {
+  if (!usable) api_->CloseSession(session).IgnoreError();
+  absl::MutexLock lock(&mutex_);
+  if (usable) {
+    idle_sessions_.push_back(session);
+  } else {
+    open_sessions_--;
+  }
+}
+
+}  // namespace pkcs11
+}  // namespace integration
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,105 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_INTEGRATION_PKCS11_PKCS11_SESSION_POOL_H_
+#define TINK_INTEGRATION_PKCS11_PKCS11_SESSION_POOL_H_
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/integration/pkcs11/pkcs11_api.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace integration {
+namespace pkcs11 {
+
+// A thread-safe pool of PKCS#11 sessions.  A session can only run one
+// operation at a time, so opening one per operation, or sharing one
+// behind a lock, caps the throughput far below that of the device.  The
+// pool instead keeps up to 'max_sessions' sessions open and hands each
+// one to one caller at a time, so that that many operations are in flight
+// on the token at once.
+//
+// Sessions are opened on demand and kept open until the pool is destroyed,
+// or until an operation on them fails with UNAVAILABLE.
+class Pkcs11SessionPool {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<Pkcs11SessionPool>>
+  New(std::shared_ptr<Pkcs11Api> api, int max_sessions);
+
+  // Closes the sessions.  No operation may be running.
+  ~Pkcs11SessionPool();
+
+  // Calls 'operation' with a session which no other operation uses until
+  // it returns, waiting for one if all 'max_sessions' sessions are in use.
+  // If 'operation' fails with UNAVAILABLE, the session is closed and
+  // 'operation' is retried once with another session.
+  template <typename T>
+  crypto::tink::util::StatusOr<T> Run(
+      const std::function<crypto::tink::util::StatusOr<T>(
+          Pkcs11Api::SessionHandle)>& operation) {
+    crypto::tink::util::StatusOr<T> result = crypto::tink::util::Status(
+        crypto::tink::util::error::INTERNAL, "operation did not run");
+    for (int attempt = 0; attempt < 2; attempt++) {
+      auto session = Acquire();
+      if (!session.ok()) return session.status();
+      result = operation(session.ValueOrDie());
+      bool usable = result.status().error_code() !=
+                    crypto::tink::util::error::UNAVAILABLE;
+      Release(session.ValueOrDie(), usable);
+      if (usable) break;
+    }
+    return result;
+  }
+
+  Pkcs11Api& api() const { return *api_; }
+  int max_sessions() const { return max_sessions_; }
+
+  // The number of sessions which are currently open.
+  int open_sessions() const;
+
+ private:
+  Pkcs11SessionPool(std::shared_ptr<Pkcs11Api> api, int max_sessions)
+      : api_(std::move(api)), max_sessions_(max_sessions) {}
+
+  crypto::tink::util::StatusOr<Pkcs11Api::SessionHandle> Acquire();
+  // Returns 'session' to the pool, or closes it if it is no longer usable.
+  void Release(Pkcs11Api::SessionHandle session, bool usable);
+
+  const std::shared_ptr<Pkcs11Api> api_;
+  const int max_sessions_;
+
+  mutable absl::Mutex mutex_;
+  // The sessions which are open but not in use, the most recently used one
+  // last.
+  std::vector<Pkcs11Api::SessionHandle> idle_sessions_ ABSL_GUARDED_BY(mutex_);
+  // The sessions which are open or being opened.
+  int open_sessions_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace pkcs11
+}  // namespace integration
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTEGRATION_PKCS11_PKCS11_SESSION_POOL_H_
@@ -0,0 +1,159 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/integration/pkcs11/pkcs11_session_pool.h"
+
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/time/time.h"
+#include "tink/integration/pkcs11/fake_pkcs11_api.h"
+#include "tink/integration/pkcs11/pkcs11_api.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace integration {
+namespace pkcs11 {
+namespace {
+
+using crypto::tink::integration::pkcs11::test::FakePkcs11Api;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+StatusOr<std::string> FindAndSign(Pkcs11Api& api,
+                                  Pkcs11Api::SessionHandle session) {
+  StatusOr<Pkcs11Api::ObjectHandle> key =
+      api.FindKey(session, Pkcs11Api::KeyClass::kPrivateKey, "key");
+  if (!key.ok()) return key.status();
+  return api.Sign(session, key.ValueOrDie(),
+                  Pkcs11Api::SignatureMechanism::kEcdsaSha256, "data");
+}
+
+TEST(Pkcs11SessionPoolTest, InvalidArguments) {
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            Pkcs11SessionPool::New(nullptr, 4).status().error_code());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            Pkcs11SessionPool::New(std::make_shared<FakePkcs11Api>(), 0)
+                .status()
+                .error_code());
+}
+
+TEST(Pkcs11SessionPoolTest, ReusesSessions) {
+  auto api = std::make_shared<FakePkcs11Api>();
+  api->AddKey(Pkcs11Api::KeyClass::kPrivateKey, "key");
+  {
+    auto pool = Pkcs11SessionPool::New(api, 4).ValueOrDie();
+    for (int i = 0; i < 10; i++) {
+      auto result = pool->Run<std::string>(
+          [&api](Pkcs11Api::SessionHandle session) {
+            return FindAndSign(*api, session);
+          });
+      EXPECT_TRUE(result.ok()) << result.status();
+    }
+    EXPECT_EQ(1, api->sessions_opened());
+    EXPECT_EQ(1, pool->open_sessions());
+  }
+  // The pool closes its sessions when it is destroyed.
+  EXPECT_EQ(1, api->sessions_closed());
+}
+
+TEST(Pkcs11SessionPoolTest, ConcurrentOperationsUseDifferentSessions) {
+  const int kMaxSessions = 3;
+  auto api = std::make_shared<FakePkcs11Api>();
+  api->AddKey(Pkcs11Api::KeyClass::kPrivateKey, "key");
+  api->SetOperationDelay(absl::Milliseconds(5));
+  auto pool = Pkcs11SessionPool::New(api, kMaxSessions).ValueOrDie();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&api, &pool]() {
+      for (int i = 0; i < 5; i++) {
+        auto result = pool->Run<std::string>(
+            [&api](Pkcs11Api::SessionHandle session) {
+              return FindAndSign(*api, session);
+            });
+        EXPECT_TRUE(result.ok()) << result.status();
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  EXPECT_FALSE(api->session_used_concurrently());
+  EXPECT_LE(api->max_operations_in_flight(), kMaxSessions);
+  EXPECT_GT(api->max_operations_in_flight(), 1);
+  EXPECT_LE(api->sessions_opened(), kMaxSessions);
+  EXPECT_EQ(api->sessions_opened(), pool->open_sessions());
+}
+
+TEST(Pkcs11SessionPoolTest, ReplacesInvalidatedSession) {
+  auto api = std::make_shared<FakePkcs11Api>();
+  api->AddKey(Pkcs11Api::KeyClass::kPrivateKey, "key");
+  auto pool = Pkcs11SessionPool::New(api, 4).ValueOrDie();
+  auto sign = [&api](Pkcs11Api::SessionHandle session) {
+    return FindAndSign(*api, session);
+  };
+  ASSERT_TRUE(pool->Run<std::string>(sign).ok());
+
+  api->InvalidateOpenSessions();
+  auto result = pool->Run<std::string>(sign);
+  EXPECT_TRUE(result.ok()) << result.status();
+  EXPECT_EQ(2, api->sessions_opened());
+  EXPECT_EQ(1, api->sessions_closed());
+  EXPECT_EQ(1, pool->open_sessions());
+}
+
+TEST(Pkcs11SessionPoolTest, FailsIfNoSessionCanBeOpened) {
+  auto api = std::make_shared<FakePkcs11Api>();
+  api->SetOpenSessionFails(true);
+  auto pool = Pkcs11SessionPool::New(api, 2).ValueOrDie();
+  auto result = pool->Run<std::string>(
+      [](Pkcs11Api::SessionHandle session) -> StatusOr<std::string> {
+        return std::string("not reached");
+      });
+  EXPECT_EQ(util::error::UNAVAILABLE, result.status().error_code());
+  EXPECT_EQ(0, pool->open_sessions());
+
+  // The pool recovers once the token does.
+  api->SetOpenSessionFails(false);
+  result = pool->Run<std::string>(
+      [](Pkcs11Api::SessionHandle session) -> StatusOr<std::string> {
+        return std::string("reached");
+      });
+  ASSERT_TRUE(result.ok()) << result.status();
+  EXPECT_EQ("reached", result.ValueOrDie());
+}
+
+TEST(Pkcs11SessionPoolTest, OtherErrorsKeepTheSession) {
+  auto api = std::make_shared<FakePkcs11Api>();
+  auto pool = Pkcs11SessionPool::New(api, 2).ValueOrDie();
+  auto result = pool->Run<std::string>(
+      [&api](Pkcs11Api::SessionHandle session) {
+        return FindAndSign(*api, session);
+      });
+  EXPECT_EQ(util::error::NOT_FOUND, result.status().error_code());
+  EXPECT_EQ(1, api->sessions_opened());
+  EXPECT_EQ(0, api->sessions_closed());
+  EXPECT_EQ(1, pool->open_sessions());
+}
+
+}  // namespace
+}  // namespace pkcs11
+}  // namespace integration
+}  // namespace tink
+}  // namespace crypto
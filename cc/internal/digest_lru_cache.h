@@ -0,0 +1,125 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_INTERNAL_DIGEST_LRU_CACHE_H_
+#define TINK_INTERNAL_DIGEST_LRU_CACHE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "openssl/mem.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// A bounded cache of values indexed by a cryptographic digest (e.g. the
+// SHA-256 digest of a signature or token), each of which expires at its own
+// time.  Digests are compared in constant time, and the least recently used
+// entry is dropped when a new one is added to a full cache.  Digests must
+// be at least 8 bytes long; they are indexed by their first 8 bytes.
+//
+// Instances of this class are thread safe.
+template <typename V>
+class DigestLruCache {
+ public:
+  // A cache with a non-positive 'max_entries' caches nothing.
+  explicit DigestLruCache(int max_entries) : max_entries_(max_entries) {}
+
+  DigestLruCache(const DigestLruCache&) = delete;
+  DigestLruCache& operator=(const DigestLruCache&) = delete;
+
+  // Returns true iff a value which has not expired is cached for 'digest',
+  // and if so copies it to 'value', unless 'value' is null.  Expired
+  // entries are dropped.
+  bool Lookup(absl::string_view digest, V* value) const
+      ABSL_LOCKS_EXCLUDED(mutex_) {
+    if (max_entries_ <= 0) return false;
+    absl::MutexLock lock(&mutex_);
+    auto it = entries_.find(DigestIndex(digest));
+    if (it == entries_.end() || it->second.digest.size() != digest.size() ||
+        CRYPTO_memcmp(it->second.digest.data(), digest.data(),
+                      digest.size()) != 0) {
+      return false;
+    }
+    if (absl::Now() >= it->second.expiration) {
+      lru_.erase(it->second.lru_position);
+      entries_.erase(it);
+      return false;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+    if (value != nullptr) *value = it->second.value;
+    return true;
+  }
+
+  // Caches 'value' for 'digest' until 'expiration', replacing any value
+  // cached for it before.
+  void Insert(std::string digest, V value, absl::Time expiration) const
+      ABSL_LOCKS_EXCLUDED(mutex_) {
+    if (max_entries_ <= 0) return;
+    uint64_t index = DigestIndex(digest);
+    absl::MutexLock lock(&mutex_);
+    auto it = entries_.find(index);
+    if (it != entries_.end()) {
+      lru_.erase(it->second.lru_position);
+      entries_.erase(it);
+    }
+    lru_.push_front(index);
+    entries_.emplace(index, Entry{std::move(digest), std::move(value),
+                                  expiration, lru_.begin()});
+    if (lru_.size() > static_cast<size_t>(max_entries_)) {
+      entries_.erase(lru_.back());
+      lru_.pop_back();
+    }
+  }
+
+ private:
+  struct Entry {
+    std::string digest;
+    V value;
+    absl::Time expiration;
+    std::list<uint64_t>::iterator lru_position;
+  };
+
+  static uint64_t DigestIndex(absl::string_view digest) {
+    uint64_t index;
+    std::memcpy(&index, digest.data(), sizeof(index));
+    return index;
+  }
+
+  const int max_entries_;
+  mutable absl::Mutex mutex_;
+  // Entries indexed by the first 8 bytes of their digest, with the least
+  // recently used one at the back of 'lru_'.
+  mutable absl::flat_hash_map<uint64_t, Entry> entries_
+      ABSL_GUARDED_BY(mutex_);
+  mutable std::list<uint64_t> lru_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTERNAL_DIGEST_LRU_CACHE_H_
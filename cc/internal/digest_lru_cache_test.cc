@@ -0,0 +1,87 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/internal/digest_lru_cache.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+const absl::Time kFuture = absl::InfiniteFuture();
+
+TEST(DigestLruCacheTest, LookupAndInsert) {
+  DigestLruCache<int> cache(2);
+  int value = 0;
+  EXPECT_FALSE(cache.Lookup("digest_1", &value));
+  cache.Insert("digest_1", 1, kFuture);
+  EXPECT_TRUE(cache.Lookup("digest_1", &value));
+  EXPECT_EQ(1, value);
+  EXPECT_TRUE(cache.Lookup("digest_1", nullptr));
+
+  // Inserting the same digest again replaces its value.
+  cache.Insert("digest_1", 2, kFuture);
+  EXPECT_TRUE(cache.Lookup("digest_1", &value));
+  EXPECT_EQ(2, value);
+}
+
+TEST(DigestLruCacheTest, SameIndexDifferentDigest) {
+  DigestLruCache<int> cache(2);
+  // Both digests start with the same 8 bytes.
+  cache.Insert("digest_1_a", 1, kFuture);
+  EXPECT_FALSE(cache.Lookup("digest_1_b", nullptr));
+  EXPECT_FALSE(cache.Lookup("digest_1_aa", nullptr));
+  EXPECT_TRUE(cache.Lookup("digest_1_a", nullptr));
+}
+
+TEST(DigestLruCacheTest, DropsLeastRecentlyUsed) {
+  DigestLruCache<int> cache(2);
+  cache.Insert("digest_1", 1, kFuture);
+  cache.Insert("digest_2", 2, kFuture);
+  // Makes digest_1 the most recently used one.
+  EXPECT_TRUE(cache.Lookup("digest_1", nullptr));
+  cache.Insert("digest_3", 3, kFuture);
+  EXPECT_TRUE(cache.Lookup("digest_1", nullptr));
+  EXPECT_FALSE(cache.Lookup("digest_2", nullptr));
+  EXPECT_TRUE(cache.Lookup("digest_3", nullptr));
+}
+
+TEST(DigestLruCacheTest, Expiration) {
+  DigestLruCache<int> cache(2);
+  cache.Insert("digest_1", 1, absl::Now() - absl::Seconds(1));
+  EXPECT_FALSE(cache.Lookup("digest_1", nullptr));
+  cache.Insert("digest_2", 2, absl::Now() + absl::Hours(1));
+  EXPECT_TRUE(cache.Lookup("digest_2", nullptr));
+}
+
+TEST(DigestLruCacheTest, NonPositiveMaxEntries) {
+  for (int max_entries : {0, -1}) {
+    DigestLruCache<int> cache(max_entries);
+    cache.Insert("digest_1", 1, kFuture);
+    EXPECT_FALSE(cache.Lookup("digest_1", nullptr));
+  }
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
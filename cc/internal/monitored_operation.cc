@@ -0,0 +1,58 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/internal/monitored_operation.h"
+
+#include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tink/monitoring.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+namespace {
+
+// Counts the operations of this thread, to pick those whose latency is
+// measured without any shared state.
+thread_local unsigned int operations_until_sample = 0;
+
+}  // namespace
+
+MonitoredOperation::MonitoredOperation(absl::string_view primitive,
+                                       absl::string_view operation)
+    : client_(GetMonitoringClient()) {
+  if (client_ == nullptr) return;
+  event_.primitive = primitive;
+  event_.operation = operation;
+  if (operations_until_sample == 0) {
+    operations_until_sample = client_->latency_sampling_period();
+    event_.latency_sampled = true;
+    start_ = absl::Now();
+  }
+  operations_until_sample--;
+}
+
+MonitoredOperation::~MonitoredOperation() {
+  if (client_ == nullptr) return;
+  if (event_.latency_sampled) event_.latency = absl::Now() - start_;
+  client_->Log(event_);
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,74 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_INTERNAL_MONITORED_OPERATION_H_
+#define TINK_INTERNAL_MONITORED_OPERATION_H_
+
+#include <cstdint>
+
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "tink/monitoring.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// Collects the MonitoringEvent of one operation of a primitive wrapper, and
+// logs it to the registered MonitoringClient when destroyed.  Without a
+// registered client nothing is logged and the clock is never read.
+//
+// Usage:
+//   MonitoredOperation operation("aead", "decrypt");
+//   for (...) {
+//     operation.KeyTried();
+//     if (decrypt_result.ok()) {
+//       operation.Succeeded(entry->get_key_id());
+//       return decrypt_result;
+//     }
+//   }
+class MonitoredOperation {
+ public:
+  // 'primitive' and 'operation' must be string literals.
+  MonitoredOperation(absl::string_view primitive, absl::string_view operation);
+  ~MonitoredOperation();
+
+  MonitoredOperation(const MonitoredOperation&) = delete;
+  MonitoredOperation& operator=(const MonitoredOperation&) = delete;
+
+  // Records that a key is about to be tried.
+  void KeyTried() { event_.keys_tried++; }
+  // Records that the wrapper falls through to the RAW keys.
+  void RawKeysTried() { event_.tried_raw_keys = true; }
+  // Records that the wrapper gave up on the RAW keys at its limit.
+  void RawKeyLimitReached() { event_.raw_key_limit_reached = true; }
+  // Records that the key with id 'key_id' performed the operation.
+  void Succeeded(uint32_t key_id) {
+    event_.ok = true;
+    event_.key_id = key_id;
+  }
+
+ private:
+  MonitoringClient* const client_;
+  MonitoringEvent event_;
+  absl::Time start_;
+};
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTERNAL_MONITORED_OPERATION_H_
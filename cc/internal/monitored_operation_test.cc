@@ -0,0 +1,96 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/internal/monitored_operation.h"
+
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "tink/monitoring.h"
+#include "tink/monitoring_stats_client.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+
+// A client can only be registered once per process, so all checks run in a
+// single test.
+TEST(MonitoredOperationTest, LogsToRegisteredClient) {
+  EXPECT_EQ(nullptr, GetMonitoringClient());
+  {
+    // Without a client nothing is logged.
+    MonitoredOperation operation("aead", "encrypt");
+    operation.KeyTried();
+    operation.Succeeded(1);
+  }
+
+  EXPECT_THAT(RegisterMonitoringClient(nullptr),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(
+      RegisterMonitoringClient(absl::make_unique<MonitoringStatsClient>(0)),
+      StatusIs(util::error::INVALID_ARGUMENT));
+
+  auto client = absl::make_unique<MonitoringStatsClient>(
+      /*latency_sampling_period=*/4);
+  MonitoringStatsClient* stats_client = client.get();
+  ASSERT_THAT(RegisterMonitoringClient(std::move(client)), IsOk());
+  EXPECT_EQ(stats_client, GetMonitoringClient());
+  EXPECT_THAT(
+      RegisterMonitoringClient(absl::make_unique<MonitoringStatsClient>()),
+      StatusIs(util::error::ALREADY_EXISTS));
+
+  for (int i = 0; i < 8; i++) {
+    MonitoredOperation operation("aead", "decrypt");
+    operation.KeyTried();
+    operation.Succeeded(42);
+  }
+  {
+    MonitoredOperation operation("aead", "decrypt");
+    operation.KeyTried();
+    operation.RawKeysTried();
+    operation.KeyTried();
+  }
+
+  MonitoringStatsClient::StatsMap stats = stats_client->GetStats();
+  ASSERT_EQ(2, stats.size());
+  const auto& succeeded = stats[std::make_tuple("aead", "decrypt", 42)];
+  EXPECT_EQ(8, succeeded.operations);
+  EXPECT_EQ(0, succeeded.failures);
+  EXPECT_EQ(8, succeeded.keys_tried);
+  int64_t sampled = 0;
+  for (int64_t count : succeeded.latency_histogram) sampled += count;
+  EXPECT_EQ(2, sampled);
+
+  const auto& failed = stats[std::make_tuple("aead", "decrypt", 0)];
+  EXPECT_EQ(1, failed.operations);
+  EXPECT_EQ(1, failed.failures);
+  EXPECT_EQ(2, failed.keys_tried);
+  EXPECT_EQ(1, failed.raw_key_fallthroughs);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
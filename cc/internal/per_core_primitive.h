@@ -0,0 +1,140 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_INTERNAL_PER_CORE_PRIMITIVE_H_
+#define TINK_INTERNAL_PER_CORE_PRIMITIVE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "absl/base/call_once.h"
+#include "absl/memory/memory.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// Returns a small integer that identifies the calling thread. Threads are
+// numbered in the order in which they first call this function.
+inline size_t PerCoreThreadIndex() {
+  static std::atomic<size_t> next_index{0};
+  thread_local size_t index =
+      next_index.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+// Holds up to 'num_replicas' copies of a primitive of type P, each created
+// by 'factory' the first time a thread assigned to it calls Get(). Threads
+// are spread round-robin over the replicas, so with at least as many
+// replicas as threads no two threads share primitive state, and the state a
+// thread touches was allocated by that thread. Each replica's bookkeeping
+// sits on its own cache line.
+//
+// Any factory producing equivalent primitives works, e.g. for a keyset:
+//
+//   auto per_core = PerCorePrimitive<Aead>::New([&handle]() {
+//     return handle->GetPrimitive<Aead>();
+//   });
+//   ...
+//   per_core.ValueOrDie()->Get().Encrypt(plaintext, associated_data);
+//
+// 'factory' must remain callable, and thread safe, for the lifetime of the
+// PerCorePrimitive. If it fails for a later replica, the threads assigned
+// to that replica use the first one.
+//
+// Instances of this class are thread safe.
+template <class P>
+class PerCorePrimitive {
+ public:
+  using Factory = std::function<crypto::tink::util::StatusOr<
+      std::unique_ptr<P>>()>;
+
+  // Creates the first replica right away, to surface factory errors.
+  // 'num_replicas' defaults to the number of hardware threads.
+  static crypto::tink::util::StatusOr<std::unique_ptr<PerCorePrimitive<P>>>
+  New(Factory factory, int num_replicas = 0) {
+    if (factory == nullptr) {
+      return crypto::tink::util::Status(crypto::tink::util::error::INTERNAL,
+                                        "factory must be non-null");
+    }
+    if (num_replicas < 0) {
+      return crypto::tink::util::Status(
+          crypto::tink::util::error::INVALID_ARGUMENT,
+          "num_replicas must be non-negative");
+    }
+    if (num_replicas == 0) {
+      num_replicas = std::max(1u, std::thread::hardware_concurrency());
+    }
+    auto first_result = factory();
+    if (!first_result.ok()) return first_result.status();
+    auto per_core = absl::WrapUnique(
+        new PerCorePrimitive<P>(std::move(factory), num_replicas));
+    Replica& first = per_core->replicas_[0];
+    absl::call_once(first.once, [&first, &first_result]() {
+      first.primitive = std::move(first_result.ValueOrDie());
+    });
+    return std::move(per_core);
+  }
+
+  PerCorePrimitive(const PerCorePrimitive&) = delete;
+  PerCorePrimitive& operator=(const PerCorePrimitive&) = delete;
+
+  // Returns the replica assigned to the calling thread.
+  const P& Get() const {
+    Replica& replica = replicas_[PerCoreThreadIndex() % num_replicas_];
+    absl::call_once(replica.once, [this, &replica]() {
+      auto primitive_result = factory_();
+      if (primitive_result.ok()) {
+        replica.primitive = std::move(primitive_result.ValueOrDie());
+      }
+    });
+    if (replica.primitive == nullptr) return *replicas_[0].primitive;
+    return *replica.primitive;
+  }
+
+  int num_replicas() const { return num_replicas_; }
+
+ private:
+  static constexpr size_t kCacheLineSize = 64;
+
+  struct alignas(kCacheLineSize) Replica {
+    absl::once_flag once;
+    std::unique_ptr<P> primitive;
+  };
+
+  PerCorePrimitive(Factory factory, int num_replicas)
+      : factory_(std::move(factory)),
+        num_replicas_(num_replicas),
+        replicas_(new Replica[num_replicas]) {}
+
+  const Factory factory_;
+  const int num_replicas_;
+  // Each element is written once, inside its call_once.
+  const std::unique_ptr<Replica[]> replicas_;
+};
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTERNAL_PER_CORE_PRIMITIVE_H_
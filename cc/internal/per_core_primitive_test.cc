@@ -0,0 +1,162 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/internal/per_core_primitive.h"
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::crypto::tink::test::DummyAead;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::AllOf;
+using ::testing::Eq;
+using ::testing::Ge;
+using ::testing::Le;
+
+// Returns a factory that creates DummyAeads named "0", "1", ... and counts
+// the calls in 'calls'.
+PerCorePrimitive<Aead>::Factory CountingFactory(std::atomic<int>* calls) {
+  return [calls]() -> util::StatusOr<std::unique_ptr<Aead>> {
+    int call = calls->fetch_add(1);
+    return {absl::make_unique<DummyAead>(absl::StrCat(call))};
+  };
+}
+
+TEST(PerCorePrimitiveTest, SameReplicaWithinThread) {
+  std::atomic<int> calls{0};
+  auto per_core_result =
+      PerCorePrimitive<Aead>::New(CountingFactory(&calls), 4);
+  ASSERT_THAT(per_core_result.status(), IsOk());
+  const PerCorePrimitive<Aead>& per_core = *per_core_result.ValueOrDie();
+  EXPECT_THAT(per_core.num_replicas(), Eq(4));
+  EXPECT_THAT(calls.load(), Eq(1));
+
+  const Aead* first = &per_core.Get();
+  EXPECT_THAT(&per_core.Get(), Eq(first));
+  auto ciphertext = per_core.Get().Encrypt("plaintext", "aad");
+  ASSERT_THAT(ciphertext.status(), IsOk());
+  auto plaintext = first->Decrypt(ciphertext.ValueOrDie(), "aad");
+  ASSERT_THAT(plaintext.status(), IsOk());
+  EXPECT_THAT(plaintext.ValueOrDie(), Eq("plaintext"));
+}
+
+TEST(PerCorePrimitiveTest, ThreadsGetDistinctReplicas) {
+  constexpr int kThreads = 4;
+  std::atomic<int> calls{0};
+  auto per_core = std::move(
+      PerCorePrimitive<Aead>::New(CountingFactory(&calls), kThreads)
+          .ValueOrDie());
+  std::vector<const Aead*> replicas(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&per_core, &replicas, t]() {
+      replicas[t] = &per_core->Get();
+      EXPECT_THAT(&per_core->Get(), Eq(replicas[t]));
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  EXPECT_THAT(std::set<const Aead*>(replicas.begin(), replicas.end()).size(),
+              Eq(kThreads));
+  // The eagerly created first replica plus one per thread, except for the
+  // thread that was assigned the first replica (if any).
+  EXPECT_THAT(calls.load(), AllOf(Ge(kThreads), Le(kThreads + 1)));
+}
+
+TEST(PerCorePrimitiveTest, MoreThreadsThanReplicas) {
+  std::atomic<int> calls{0};
+  auto per_core = std::move(
+      PerCorePrimitive<Aead>::New(CountingFactory(&calls), 2).ValueOrDie());
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&per_core]() {
+      EXPECT_THAT(per_core->Get().Encrypt("message", "").status(), IsOk());
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  EXPECT_THAT(calls.load(), Eq(2));
+}
+
+TEST(PerCorePrimitiveTest, LaterFactoryFailureUsesFirstReplica) {
+  std::atomic<int> calls{0};
+  auto per_core = std::move(
+      PerCorePrimitive<Aead>::New(
+          [&calls]() -> util::StatusOr<std::unique_ptr<Aead>> {
+            if (calls.fetch_add(1) > 0) {
+              return util::Status(util::error::INTERNAL, "factory failed");
+            }
+            return {absl::make_unique<DummyAead>("first")};
+          },
+          8)
+          .ValueOrDie());
+  std::vector<std::string> ciphertexts(4);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&per_core, &ciphertexts, t]() {
+      ciphertexts[t] = per_core->Get().Encrypt("message", "").ValueOrDie();
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  for (const std::string& ciphertext : ciphertexts) {
+    EXPECT_THAT(ciphertext,
+                Eq(DummyAead("first").Encrypt("message", "").ValueOrDie()));
+  }
+}
+
+TEST(PerCorePrimitiveTest, InvalidArguments) {
+  std::atomic<int> calls{0};
+  EXPECT_THAT(PerCorePrimitive<Aead>::New(nullptr).status(),
+              StatusIs(util::error::INTERNAL));
+  EXPECT_THAT(
+      PerCorePrimitive<Aead>::New(CountingFactory(&calls), -1).status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+  auto failing_factory = []() -> util::StatusOr<std::unique_ptr<Aead>> {
+    return util::Status(util::error::NOT_FOUND, "no primitive");
+  };
+  EXPECT_THAT(PerCorePrimitive<Aead>::New(failing_factory).status(),
+              StatusIs(util::error::NOT_FOUND));
+}
+
+TEST(PerCorePrimitiveTest, DefaultNumReplicas) {
+  std::atomic<int> calls{0};
+  auto per_core_result = PerCorePrimitive<Aead>::New(CountingFactory(&calls));
+  ASSERT_THAT(per_core_result.status(), IsOk());
+  EXPECT_THAT(per_core_result.ValueOrDie()->num_replicas(), Ge(1));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
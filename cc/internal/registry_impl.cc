@@ -15,6 +15,13 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "tink/internal/registry_impl.h"
 
+#include <algorithm>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
+
+#include "absl/types/span.h"
+
 #include "tink/util/errors.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
@@ -29,13 +36,90 @@ namespace internal {
 
 StatusOr<const RegistryImpl::KeyTypeInfo*> RegistryImpl::get_key_type_info(
     absl::string_view type_url) const {
-  absl::MutexLock lock(&maps_mutex_);
-  auto it = type_url_to_info_.find(type_url);
-  if (it == type_url_to_info_.end()) {
+  const KeyTypeInfo* info = FindKeyTypeInfo(type_url);
+  if (info == nullptr && RunLazyRegistration(type_url)) {
+    info = FindKeyTypeInfo(type_url);
+  }
+  if (info == nullptr) {
     return ToStatusF(util::error::NOT_FOUND,
                      "No manager for type '%s' has been registered.", type_url);
   }
-  return &it->second;
+  return info;
+}
+
+const RegistryImpl::KeyTypeInfo* RegistryImpl::FindKeyTypeInfo(
+    absl::string_view type_url) const {
+  absl::MutexLockMaybe lock(LookupMutex());
+  auto it = type_url_to_info_.find(type_url);
+  return it == type_url_to_info_.end() ? nullptr : &it->second;
+}
+
+const RegistryImpl::WrapperInfo* RegistryImpl::FindWrapperInfo(
+    const std::type_index& primitive) const {
+  absl::MutexLockMaybe lock(LookupMutex());
+  auto it = primitive_to_wrapper_.find(primitive);
+  return it == primitive_to_wrapper_.end() ? nullptr : &it->second;
+}
+
+const RegistryImpl::WrapperInfo* RegistryImpl::GetWrapperInfo(
+    const std::type_info& primitive) const {
+  const WrapperInfo* info = FindWrapperInfo(std::type_index(primitive));
+  if (info == nullptr && RunLazyRegistration(primitive)) {
+    info = FindWrapperInfo(std::type_index(primitive));
+  }
+  return info;
+}
+
+// The register functions take maps_mutex_ themselves, so they are called
+// after it is released. If several threads miss the same key type at once,
+// each of them calls the register function; registering the same managers
+// again is a no-op.
+bool RegistryImpl::RunLazyRegistration(absl::string_view type_url) const {
+  RegisterFunction register_function = nullptr;
+  {
+    absl::MutexLockMaybe lock(LookupMutex());
+    // A sealed registry has run all lazy registrations already.
+    if (sealed_.load(std::memory_order_relaxed)) return false;
+    for (const auto& table : lazy_key_types_) {
+      for (const LazyKeyType& entry : table) {
+        if (type_url == entry.type_url) {
+          register_function = entry.register_function;
+          break;
+        }
+      }
+      if (register_function != nullptr) break;
+    }
+  }
+  return register_function != nullptr && register_function().ok();
+}
+
+bool RegistryImpl::RunLazyRegistration(const std::type_info& primitive) const {
+  RegisterFunction register_function = nullptr;
+  {
+    absl::MutexLockMaybe lock(LookupMutex());
+    if (sealed_.load(std::memory_order_relaxed)) return false;
+    for (const auto& table : lazy_wrappers_) {
+      for (const LazyWrapper& entry : table) {
+        if (*entry.primitive == primitive) {
+          register_function = entry.register_function;
+          break;
+        }
+      }
+      if (register_function != nullptr) break;
+    }
+  }
+  return register_function != nullptr && register_function().ok();
+}
+
+crypto::tink::util::Status RegistryImpl::RegisterLazily(
+    absl::Span<const LazyKeyType> key_types,
+    absl::Span<const LazyWrapper> wrappers) {
+  absl::MutexLock lock(&maps_mutex_);
+  crypto::tink::util::Status status = CheckNotSealed();
+  if (!status.ok()) return status;
+  lazy_key_types_.push_back(key_types);
+  lazy_wrappers_.push_back(wrappers);
+  return crypto::tink::util::Status::OK;
 }
 
 StatusOr<std::unique_ptr<KeyData>> RegistryImpl::NewKeyData(
@@ -52,6 +136,44 @@ StatusOr<std::unique_ptr<KeyData>> RegistryImpl::NewKeyData(
       key_template.value());
 }
 
+StatusOr<std::vector<std::unique_ptr<KeyData>>>
+RegistryImpl::NewKeyDataBatch(const KeyTemplate& key_template, int count,
+                              Executor* executor) const {
+  if (count < 0) {
+    return crypto::tink::util::Status(util::error::INVALID_ARGUMENT,
+                                      "count must not be negative");
+  }
+  // The key type is looked up once, rather than once per key.
+  auto key_type_info_or = get_key_type_info(key_template.type_url());
+  if (!key_type_info_or.ok()) return key_type_info_or.status();
+  if (!key_type_info_or.ValueOrDie()->new_key_allowed()) {
+    return crypto::tink::util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("KeyManager for type ", key_template.type_url(),
+                     " does not allow for creation of new keys."));
+  }
+  const KeyFactory& key_factory = key_type_info_or.ValueOrDie()->key_factory();
+  std::vector<std::unique_ptr<KeyData>> key_data(count);
+  std::vector<crypto::tink::util::Status> statuses(count);
+  auto generate = [&](int i) {
+    auto result = key_factory.NewKeyData(key_template.value());
+    if (result.ok()) {
+      key_data[i] = std::move(result.ValueOrDie());
+    } else {
+      statuses[i] = result.status();
+    }
+  };
+  if (executor != nullptr && count > 1) {
+    executor->ParallelFor(count, generate);
+  } else {
+    for (int i = 0; i < count; i++) generate(i);
+  }
+  for (const auto& status : statuses) {
+    if (!status.ok()) return status;
+  }
+  return std::move(key_data);
+}
+
 StatusOr<std::unique_ptr<KeyData>> RegistryImpl::GetPublicKeyData(
     absl::string_view type_url,
     absl::string_view serialized_private_key) const {
@@ -69,9 +191,20 @@ StatusOr<std::unique_ptr<KeyData>> RegistryImpl::GetPublicKeyData(
   return result;
 }
 
+crypto::tink::util::Status RegistryImpl::CheckNotSealed() const {
+  if (sealed_.load(std::memory_order_relaxed)) {
+    return crypto::tink::util::Status(
+        util::error::FAILED_PRECONDITION,
+        "The registry is sealed and cannot be modified.");
+  }
+  return crypto::tink::util::Status::OK;
+}
+
 crypto::tink::util::Status RegistryImpl::CheckInsertable(
     absl::string_view type_url, const std::type_index& key_manager_type_index,
     bool new_key_allowed) const {
+  crypto::tink::util::Status status = CheckNotSealed();
+  if (!status.ok()) return status;
   auto it = type_url_to_info_.find(type_url);
 
   if (it == type_url_to_info_.end()) {
@@ -106,11 +239,39 @@ RegistryImpl::DeriveKey(const google::crypto::tink::KeyTemplate& key_template,
                                                       randomness);
 }
 
+void RegistryImpl::Seal() {
+  std::vector<RegisterFunction> register_functions;
+  {
+    absl::MutexLock lock(&maps_mutex_);
+    // Most entries share their register function, which is run only once.
+    auto add = [&register_functions](RegisterFunction register_function) {
+      if (std::find(register_functions.begin(), register_functions.end(),
+                    register_function) == register_functions.end()) {
+        register_functions.push_back(register_function);
+      }
+    };
+    for (const auto& table : lazy_key_types_) {
+      for (const LazyKeyType& entry : table) add(entry.register_function);
+    }
+    for (const auto& table : lazy_wrappers_) {
+      for (const LazyWrapper& entry : table) add(entry.register_function);
+    }
+  }
+  for (RegisterFunction register_function : register_functions) {
+    register_function().IgnoreError();
+  }
+  absl::MutexLock lock(&maps_mutex_);
+  sealed_.store(true, std::memory_order_release);
+}
+
 void RegistryImpl::Reset() {
   absl::MutexLock lock(&maps_mutex_);
+  sealed_.store(false, std::memory_order_release);
   type_url_to_info_.clear();
   name_to_catalogue_map_.clear();
   primitive_to_wrapper_.clear();
+  lazy_key_types_.clear();
+  lazy_wrappers_.clear();
 }
 
 }  // namespace internal
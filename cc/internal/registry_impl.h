@@ -17,10 +17,12 @@
 #define TINK_INTERNAL_REGISTRY_IMPL_H_
 
 #include <algorithm>
+#include <atomic>
 #include <tuple>
 #include <typeindex>
 #include <typeinfo>
 #include <utility>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
@@ -30,12 +32,14 @@
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/types/optional.h"
+#include "absl/types/span.h"
 #include "tink/catalogue.h"
 #include "tink/config/tink_fips.h"
 #include "tink/core/key_manager_impl.h"
 #include "tink/core/key_type_manager.h"
 #include "tink/core/private_key_manager_impl.h"
 #include "tink/core/private_key_type_manager.h"
+#include "tink/executor.h"
 #include "tink/internal/keyset_wrapper.h"
 #include "tink/internal/keyset_wrapper_impl.h"
 #include "tink/key_manager.h"
@@ -62,6 +66,32 @@ class RegistryImpl {
   RegistryImpl(const RegistryImpl&) = delete;
   RegistryImpl& operator=(const RegistryImpl&) = delete;
 
+  // A function which registers key managers and primitive wrappers in the
+  // global registry, like AeadConfig::Register().
+  using RegisterFunction = crypto::tink::util::Status (*)();
+
+  // A key type registered by a RegisterFunction.
+  struct LazyKeyType {
+    const char* type_url;
+    RegisterFunction register_function;
+  };
+
+  // The primitive (i.e. the type 'Q' of a PrimitiveWrapper<P, Q>) of a
+  // wrapper registered by a RegisterFunction.
+  struct LazyWrapper {
+    const std::type_info* primitive;
+    RegisterFunction register_function;
+  };
+
+  // Defers the registration of the given key types and wrappers until they
+  // are first looked up: a lookup of a key type in 'key_types', or of the
+  // wrapper of a primitive in 'wrappers', that is not registered yet calls
+  // the corresponding RegisterFunction first. The arrays are not copied,
+  // and must outlive the registry (e.g. be static data).
+  crypto::tink::util::Status RegisterLazily(
+      absl::Span<const LazyKeyType> key_types,
+      absl::Span<const LazyWrapper> wrappers) ABSL_LOCKS_EXCLUDED(maps_mutex_);
+
   template <class P>
   crypto::tink::util::StatusOr<const Catalogue<P>*> get_catalogue(
       absl::string_view catalogue_name) const ABSL_LOCKS_EXCLUDED(maps_mutex_);
@@ -119,6 +149,12 @@ class RegistryImpl {
   NewKeyData(const google::crypto::tink::KeyTemplate& key_template) const
       ABSL_LOCKS_EXCLUDED(maps_mutex_);
 
+  crypto::tink::util::StatusOr<
+      std::vector<std::unique_ptr<google::crypto::tink::KeyData>>>
+  NewKeyDataBatch(const google::crypto::tink::KeyTemplate& key_template,
+                  int count, Executor* executor) const
+      ABSL_LOCKS_EXCLUDED(maps_mutex_);
+
   crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
   GetPublicKeyData(absl::string_view type_url,
                    absl::string_view serialized_private_key) const
@@ -138,6 +174,11 @@ class RegistryImpl {
       const google::crypto::tink::KeyTemplate& key_template,
       InputStream* randomness) const ABSL_LOCKS_EXCLUDED(maps_mutex_);
 
+  // After Seal() the registry cannot be modified anymore (except by Reset()),
+  // so that lookups can read the maps without holding maps_mutex_.
+  // Registrations deferred by RegisterLazily() are carried out first.
+  void Seal() ABSL_LOCKS_EXCLUDED(maps_mutex_);
+
   void Reset() ABSL_LOCKS_EXCLUDED(maps_mutex_);
 
  private:
@@ -391,6 +432,36 @@ class RegistryImpl {
   crypto::tink::util::StatusOr<const KeyTypeInfo*> get_key_type_info(
       absl::string_view type_url) const ABSL_LOCKS_EXCLUDED(maps_mutex_);
 
+  // Returns the key type info or the wrapper info for the given key, or
+  // nullptr if there is none. Unlike get_key_type_info() these do not
+  // consider lazy registrations.
+  const KeyTypeInfo* FindKeyTypeInfo(absl::string_view type_url) const
+      ABSL_LOCKS_EXCLUDED(maps_mutex_);
+  const WrapperInfo* FindWrapperInfo(const std::type_index& primitive) const
+      ABSL_LOCKS_EXCLUDED(maps_mutex_);
+
+  // Returns the wrapper info for 'primitive', running its lazy
+  // registration if needed, or nullptr if there is none.
+  const WrapperInfo* GetWrapperInfo(const std::type_info& primitive) const
+      ABSL_LOCKS_EXCLUDED(maps_mutex_);
+
+  // Runs the lazy registration of the key type 'type_url' or of the wrapper
+  // of 'primitive', if there is one. Returns true if it succeeded.
+  bool RunLazyRegistration(absl::string_view type_url) const
+      ABSL_LOCKS_EXCLUDED(maps_mutex_);
+  bool RunLazyRegistration(const std::type_info& primitive) const
+      ABSL_LOCKS_EXCLUDED(maps_mutex_);
+
+  // Returns maps_mutex_ if lookups need to lock it, and nullptr if the
+  // registry is sealed. To be used with absl::MutexLockMaybe.
+  absl::Mutex* LookupMutex() const ABSL_LOCK_RETURNED(maps_mutex_) {
+    return sealed_.load(std::memory_order_acquire) ? nullptr : &maps_mutex_;
+  }
+
+  // Returns an error if the registry is sealed.
+  crypto::tink::util::Status CheckNotSealed() const
+      ABSL_SHARED_LOCKS_REQUIRED(maps_mutex_);
+
   // Returns OK if the key manager with the given type index can be inserted
   // for type url type_url and parameter new_key_allowed. Otherwise returns
   // an error to be returned to the user.
@@ -399,6 +470,9 @@ class RegistryImpl {
       bool new_key_allowed) const ABSL_SHARED_LOCKS_REQUIRED(maps_mutex_);
 
   mutable absl::Mutex maps_mutex_;
+  // Set by Seal(). Once set, the maps below are immutable (only Reset() may
+  // modify them again) and lookups read them without locking maps_mutex_.
+  std::atomic<bool> sealed_{false};
   // A map from the type_url to the given KeyTypeInfo. Once emplaced KeyTypeInfo
   // objects must remain valid throughout the life time of the binary. Hence,
   // one should /never/ replace any element of the KeyTypeInfo. This is because
@@ -414,6 +488,12 @@ class RegistryImpl {
 
   absl::flat_hash_map<std::string, LabelInfo> name_to_catalogue_map_
       ABSL_GUARDED_BY(maps_mutex_);
+
+  // The tables passed to RegisterLazily(). Only searched on lookup misses.
+  std::vector<absl::Span<const LazyKeyType>> lazy_key_types_
+      ABSL_GUARDED_BY(maps_mutex_);
+  std::vector<absl::Span<const LazyWrapper>> lazy_wrappers_
+      ABSL_GUARDED_BY(maps_mutex_);
 };
 
 template <class P>
@@ -426,6 +506,8 @@ crypto::tink::util::Status RegistryImpl::AddCatalogue(
   }
   std::shared_ptr<void> entry(catalogue);
   absl::MutexLock lock(&maps_mutex_);
+  crypto::tink::util::Status status = CheckNotSealed();
+  if (!status.ok()) return status;
   auto curr_catalogue = name_to_catalogue_map_.find(catalogue_name);
   if (curr_catalogue != name_to_catalogue_map_.end()) {
     auto existing =
@@ -448,7 +530,7 @@ crypto::tink::util::Status RegistryImpl::AddCatalogue(
 template <class P>
 crypto::tink::util::StatusOr<const Catalogue<P>*> RegistryImpl::get_catalogue(
     absl::string_view catalogue_name) const {
-  absl::MutexLock lock(&maps_mutex_);
+  absl::MutexLockMaybe lock(LookupMutex());
   auto catalogue_entry = name_to_catalogue_map_.find(catalogue_name);
   if (catalogue_entry == name_to_catalogue_map_.end()) {
     return ToStatusF(crypto::tink::util::error::NOT_FOUND,
@@ -674,6 +756,8 @@ crypto::tink::util::Status RegistryImpl::RegisterPrimitiveWrapper(
   std::unique_ptr<PrimitiveWrapper<P, Q>> entry(wrapper);
 
   absl::MutexLock lock(&maps_mutex_);
+  crypto::tink::util::Status status = CheckNotSealed();
+  if (!status.ok()) return status;
   auto it = primitive_to_wrapper_.find(std::type_index(typeid(Q)));
   if (it != primitive_to_wrapper_.end()) {
     if (!it->second.HasSameType(*wrapper)) {
@@ -693,13 +777,9 @@ crypto::tink::util::Status RegistryImpl::RegisterPrimitiveWrapper(
 template <class P>
 crypto::tink::util::StatusOr<const KeyManager<P>*>
 RegistryImpl::get_key_manager(absl::string_view type_url) const {
-  absl::MutexLock lock(&maps_mutex_);
-  auto it = type_url_to_info_.find(type_url);
-  if (it == type_url_to_info_.end()) {
-    return ToStatusF(crypto::tink::util::error::NOT_FOUND,
-                     "No manager for type '%s' has been registered.", type_url);
-  }
-  return it->second.get_key_manager<P>(type_url);
+  auto key_type_info_or = get_key_type_info(type_url);
+  if (!key_type_info_or.ok()) return key_type_info_or.status();
+  return key_type_info_or.ValueOrDie()->get_key_manager<P>(type_url);
 }
 
 template <class P>
@@ -725,27 +805,25 @@ crypto::tink::util::StatusOr<std::unique_ptr<P>> RegistryImpl::GetPrimitive(
 template <class P>
 crypto::tink::util::StatusOr<const PrimitiveWrapper<P, P>*>
 RegistryImpl::GetLegacyWrapper() const {
-  absl::MutexLock lock(&maps_mutex_);
-  auto it = primitive_to_wrapper_.find(std::type_index(typeid(P)));
-  if (it == primitive_to_wrapper_.end()) {
+  const WrapperInfo* wrapper_info = GetWrapperInfo(typeid(P));
+  if (wrapper_info == nullptr) {
     return util::Status(
         util::error::NOT_FOUND,
         absl::StrCat("No wrapper registered for type ", typeid(P).name()));
   }
-  return it->second.GetLegacyWrapper<P>();
+  return wrapper_info->GetLegacyWrapper<P>();
 }
 
 template <class P>
 crypto::tink::util::StatusOr<const KeysetWrapper<P>*>
 RegistryImpl::GetKeysetWrapper() const {
-  absl::MutexLock lock(&maps_mutex_);
-  auto it = primitive_to_wrapper_.find(std::type_index(typeid(P)));
-  if (it == primitive_to_wrapper_.end()) {
+  const WrapperInfo* wrapper_info = GetWrapperInfo(typeid(P));
+  if (wrapper_info == nullptr) {
     return util::Status(
         util::error::NOT_FOUND,
         absl::StrCat("No wrapper registered for type ", typeid(P).name()));
   }
-  return it->second.GetKeysetWrapper<P>();
+  return wrapper_info->GetKeysetWrapper<P>();
 }
 
 template <class P>
@@ -704,6 +704,109 @@ TEST_F(RegistryTest, testGetPublicKeyData) {
                       bad_key_result.status().error_message());
 }
 
+TEST_F(RegistryTest, SealedRegistryCannotBeModified) {
+  register_test_managers("sealed_type_", 3);
+  Registry::Seal();
+
+  // Lookups still work.
+  verify_test_managers("sealed_type_", 3);
+  EXPECT_EQ(util::error::NOT_FOUND,
+            Registry::get_key_manager<Aead>("unknown").status().error_code());
+
+  // Registrations fail, also for a key manager which is already registered.
+  EXPECT_EQ(util::error::FAILED_PRECONDITION,
+            Registry::RegisterKeyManager(
+                absl::make_unique<TestAeadKeyManager>("other_type"), true)
+                .error_code());
+  EXPECT_EQ(util::error::FAILED_PRECONDITION,
+            Registry::RegisterKeyManager(
+                absl::make_unique<TestAeadKeyManager>("sealed_type_0"), true)
+                .error_code());
+  EXPECT_EQ(util::error::FAILED_PRECONDITION,
+            Registry::RegisterPrimitiveWrapper(absl::make_unique<AeadWrapper>())
+                .error_code());
+  EXPECT_FALSE(Registry::get_key_manager<Aead>("other_type").ok());
+
+  // Reset() unseals the registry.
+  Registry::Reset();
+  EXPECT_TRUE(Registry::RegisterKeyManager(
+                  absl::make_unique<TestAeadKeyManager>("other_type"), true)
+                  .ok());
+}
+
+TEST_F(RegistryTest, ConcurrentLookupsOnSealedRegistry) {
+  register_test_managers("sealed_type_", 10);
+  Registry::Seal();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back(verify_test_managers, "sealed_type_", 10);
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+}
+
+int lazy_registrations = 0;
+
+Status RegisterLazyTestManagers() {
+  lazy_registrations++;
+  Status status = Registry::RegisterKeyManager(
+      absl::make_unique<TestAeadKeyManager>("lazy_type_0"), true);
+  if (!status.ok()) return status;
+  status = Registry::RegisterKeyManager(
+      absl::make_unique<TestAeadKeyManager>("lazy_type_1"), true);
+  if (!status.ok()) return status;
+  return Registry::RegisterPrimitiveWrapper(absl::make_unique<AeadWrapper>());
+}
+
+constexpr RegistryImpl::LazyKeyType kLazyKeyTypes[] = {
+    {"lazy_type_0", &RegisterLazyTestManagers},
+    {"lazy_type_1", &RegisterLazyTestManagers},
+};
+
+constexpr RegistryImpl::LazyWrapper kLazyWrappers[] = {
+    {&typeid(Aead), &RegisterLazyTestManagers},
+};
+
+TEST_F(RegistryTest, LazyKeyManagerRegistration) {
+  lazy_registrations = 0;
+  ASSERT_THAT(RegistryImpl::GlobalInstance().RegisterLazily(kLazyKeyTypes,
+                                                             kLazyWrappers),
+              IsOk());
+  EXPECT_EQ(0, lazy_registrations);
+  verify_test_managers("lazy_type_", 2);
+  EXPECT_EQ(1, lazy_registrations);
+  EXPECT_THAT(Registry::get_key_manager<Aead>("unknown").status(),
+              StatusIs(util::error::NOT_FOUND));
+  EXPECT_EQ(1, lazy_registrations);
+}
+
+TEST_F(RegistryTest, LazyWrapperRegistration) {
+  lazy_registrations = 0;
+  ASSERT_THAT(RegistryImpl::GlobalInstance().RegisterLazily(kLazyKeyTypes,
+                                                             kLazyWrappers),
+              IsOk());
+  auto primitive_set = absl::make_unique<PrimitiveSet<Aead>>();
+  // The wrapper is found, and fails as the set has no primary.
+  EXPECT_THAT(Registry::Wrap<Aead>(std::move(primitive_set)).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_EQ(1, lazy_registrations);
+  verify_test_managers("lazy_type_", 2);
+  EXPECT_EQ(1, lazy_registrations);
+}
+
+TEST_F(RegistryTest, SealRunsLazyRegistrations) {
+  lazy_registrations = 0;
+  ASSERT_THAT(RegistryImpl::GlobalInstance().RegisterLazily(kLazyKeyTypes,
+                                                             kLazyWrappers),
+              IsOk());
+  Registry::Seal();
+  EXPECT_EQ(1, lazy_registrations);
+  verify_test_managers("lazy_type_", 2);
+  EXPECT_EQ(1, lazy_registrations);
+  Registry::Reset();
+}
+
 // Tests that if we register the same type of wrapper twice, the second call
 // succeeds.
 TEST_F(RegistryTest, RegisterWrapperTwice) {
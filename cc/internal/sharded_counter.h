@@ -0,0 +1,83 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_INTERNAL_SHARDED_COUNTER_H_
+#define TINK_INTERNAL_SHARDED_COUNTER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "tink/internal/per_core_primitive.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// A counter which many threads increment without contending on a lock or a
+// cache line: threads are spread round-robin over 'num_shards' counters,
+// each on its own cache line, and Sum() adds them up.
+//
+// Instances of this class are thread safe.
+class ShardedCounter {
+ public:
+  // 'num_shards' defaults to the number of hardware threads.
+  explicit ShardedCounter(int num_shards = 0)
+      : num_shards_(num_shards > 0
+                        ? num_shards
+                        : std::max(1u, std::thread::hardware_concurrency())),
+        shards_(new Shard[num_shards_]) {}
+
+  ShardedCounter(const ShardedCounter&) = delete;
+  ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+  // Adds 'n', and returns the new value of the shard of the calling thread.
+  int64_t Add(int64_t n) {
+    Shard& shard = shards_[PerCoreThreadIndex() % num_shards_];
+    return shard.value.fetch_add(n, std::memory_order_relaxed) + n;
+  }
+
+  // Returns the sum of all shards.  Additions which run concurrently may or
+  // may not be included.
+  int64_t Sum() const {
+    int64_t sum = 0;
+    for (int i = 0; i < num_shards_; i++) {
+      sum += shards_[i].value.load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+
+  int num_shards() const { return num_shards_; }
+
+ private:
+  static constexpr size_t kCacheLineSize = 64;
+
+  struct alignas(kCacheLineSize) Shard {
+    std::atomic<int64_t> value{0};
+  };
+
+  const int num_shards_;
+  const std::unique_ptr<Shard[]> shards_;
+};
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTERNAL_SHARDED_COUNTER_H_
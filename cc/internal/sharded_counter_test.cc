@@ -0,0 +1,58 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/internal/sharded_counter.h"
+
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+TEST(ShardedCounterTest, SingleThread) {
+  ShardedCounter counter(4);
+  EXPECT_EQ(4, counter.num_shards());
+  EXPECT_EQ(0, counter.Sum());
+  EXPECT_EQ(1, counter.Add(1));
+  EXPECT_EQ(6, counter.Add(5));
+  EXPECT_EQ(6, counter.Sum());
+}
+
+TEST(ShardedCounterTest, DefaultShards) {
+  ShardedCounter counter;
+  EXPECT_GE(counter.num_shards(), 1);
+}
+
+TEST(ShardedCounterTest, ManyThreads) {
+  ShardedCounter counter(3);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&counter]() {
+      for (int j = 0; j < 10000; j++) counter.Add(1);
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  EXPECT_EQ(80000, counter.Sum());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
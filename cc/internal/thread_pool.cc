@@ -0,0 +1,120 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/internal/thread_pool.h"
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+namespace {
+
+// The pool and the index of the worker running on this thread, if any.
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local int current_worker = 0;
+
+}  // namespace
+
+ThreadPool::ThreadPool(int num_threads) {
+  for (int i = 0; i < num_threads; i++) {
+    queues_.push_back(absl::make_unique<Queue>());
+  }
+  for (int i = 0; i < num_threads; i++) {
+    threads_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    shutdown_ = true;
+  }
+  for (auto& thread : threads_) thread.join();
+}
+
+void ThreadPool::Schedule(std::function<void()> task) {
+  if (threads_.empty()) {
+    task();
+    return;
+  }
+  if (current_pool == this) {
+    // The task most likely works on data that the worker just touched.
+    Queue& queue = *queues_[current_worker];
+    absl::MutexLock lock(&queue.mutex);
+    queue.tasks.push_front(std::move(task));
+  } else {
+    Queue& queue = *queues_[next_queue_++ % queues_.size()];
+    absl::MutexLock lock(&queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  absl::MutexLock lock(&mutex_);
+  pending_++;
+}
+
+std::function<void()> ThreadPool::TakeTask(int index) {
+  // The reservation guarantees that some queue holds a task for this
+  // worker, even if other workers take the ones seen first.
+  while (true) {
+    {
+      Queue& own = *queues_[index];
+      absl::MutexLock lock(&own.mutex);
+      if (!own.tasks.empty()) {
+        std::function<void()> task = std::move(own.tasks.front());
+        own.tasks.pop_front();
+        return task;
+      }
+    }
+    for (size_t i = 1; i < queues_.size(); i++) {
+      Queue& other = *queues_[(index + i) % queues_.size()];
+      absl::MutexLock lock(&other.mutex);
+      if (!other.tasks.empty()) {
+        std::function<void()> task = std::move(other.tasks.back());
+        other.tasks.pop_back();
+        return task;
+      }
+    }
+  }
+}
+
+bool ThreadPool::HasWork() const {
+  return shutdown_ || pending_ > 0;
+}
+
+void ThreadPool::WorkerLoop(int index) {
+  current_pool = this;
+  current_worker = index;
+  while (true) {
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(this, &ThreadPool::HasWork));
+      if (pending_ == 0) return;  // shutdown_ and no work left.
+      pending_--;
+    }
+    TakeTask(index)();
+  }
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,89 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_INTERNAL_THREAD_POOL_H_
+#define TINK_INTERNAL_THREAD_POOL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/executor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// A fixed-size pool of worker threads, used by primitives that split large
+// operations (e.g. many stream segments) into independent tasks, and the
+// default Executor.
+//
+// Every worker has its own queue of tasks.  Tasks scheduled by a worker go
+// to the front of its own queue, and tasks scheduled by other threads are
+// spread over the queues.  A worker takes the tasks of its own queue from
+// the front, and once it is empty steals the oldest tasks of the others.
+// Instances of this class are thread safe.
+class ThreadPool : public Executor {
+ public:
+  // Starts 'num_threads' worker threads; 'num_threads' may be 0, in which
+  // case all work runs on the threads that call ParallelFor().
+  explicit ThreadPool(int num_threads);
+
+  // Runs all tasks scheduled so far, then joins the worker threads.
+  ~ThreadPool() override;
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Runs 'task' on one of the worker threads at some later point.
+  // With no worker threads 'task' runs immediately on the calling thread.
+  void Schedule(std::function<void()> task) override;
+
+  int num_threads() const override { return threads_.size(); }
+
+ private:
+  struct Queue {
+    absl::Mutex mutex;
+    std::deque<std::function<void()>> tasks ABSL_GUARDED_BY(mutex);
+  };
+
+  void WorkerLoop(int index);
+  // Removes a task from the queue of worker 'index', or else from another
+  // queue.  Requires a task to have been reserved in 'pending_'.
+  std::function<void()> TakeTask(int index);
+  bool HasWork() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::atomic<unsigned> next_queue_{0};
+  absl::Mutex mutex_;
+  // The number of tasks in the queues not yet reserved by a worker.
+  int64_t pending_ ABSL_GUARDED_BY(mutex_) = 0;
+  bool shutdown_ ABSL_GUARDED_BY(mutex_) = false;
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTERNAL_THREAD_POOL_H_
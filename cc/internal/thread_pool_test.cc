@@ -0,0 +1,90 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/internal/thread_pool.h"
+
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/synchronization/blocking_counter.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+TEST(ThreadPoolTest, Schedule) {
+  std::atomic<int> sum(0);
+  {
+    ThreadPool pool(4);
+    EXPECT_EQ(4, pool.num_threads());
+    for (int i = 1; i <= 100; i++) {
+      pool.Schedule([&sum, i]() { sum += i; });
+    }
+    // The destructor runs the remaining tasks.
+  }
+  EXPECT_EQ(5050, sum);
+}
+
+TEST(ThreadPoolTest, ScheduleWithoutThreads) {
+  ThreadPool pool(0);
+  int calls = 0;
+  pool.Schedule([&calls]() { calls++; });
+  EXPECT_EQ(1, calls);
+}
+
+TEST(ThreadPoolTest, ScheduleAndWait) {
+  ThreadPool pool(2);
+  absl::BlockingCounter done(10);
+  std::atomic<int> calls(0);
+  for (int i = 0; i < 10; i++) {
+    pool.Schedule([&calls, &done]() {
+      calls++;
+      done.DecrementCount();
+    });
+  }
+  done.Wait();
+  EXPECT_EQ(10, calls);
+}
+
+TEST(ThreadPoolTest, ParallelFor) {
+  for (int num_threads : {0, 1, 3, 8}) {
+    SCOPED_TRACE(num_threads);
+    ThreadPool pool(num_threads);
+    for (int count : {0, 1, 2, 7, 1000}) {
+      std::vector<int> calls(count, 0);
+      pool.ParallelFor(count, [&calls](int i) { calls[i]++; });
+      EXPECT_EQ(std::vector<int>(count, 1), calls);
+    }
+  }
+}
+
+TEST(ThreadPoolTest, ConcurrentParallelFor) {
+  ThreadPool pool(4);
+  std::atomic<int> sum(0);
+  ThreadPool callers(3);
+  callers.ParallelFor(3, [&pool, &sum](int) {
+    pool.ParallelFor(100, [&sum](int i) { sum += i; });
+  });
+  EXPECT_EQ(3 * 4950, sum);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,97 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_INTERNAL_TRACED_OPERATION_H_
+#define TINK_INTERNAL_TRACED_OPERATION_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "tink/tracing.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// The span of one expensive operation, started by the registered Tracer and
+// ended when destroyed.  Without a registered tracer nothing is allocated,
+// and all methods return right away; attributes which are costly to compute
+// should be guarded by enabled().
+//
+// Usage:
+//   TracedOperation operation("tink.keyset_handle.read");
+//   operation.SetAttribute("tink.bytes", encrypted_keyset.size());
+//   ...
+//   operation.SetStatus(status);
+class TracedOperation {
+ public:
+  // 'name' must be a string literal.
+  explicit TracedOperation(absl::string_view name) {
+    Tracer* tracer = GetTracer();
+    if (tracer != nullptr) span_ = tracer->StartSpan(name);
+  }
+  ~TracedOperation() {
+    if (span_ != nullptr) span_->End(status_);
+  }
+
+  TracedOperation(const TracedOperation&) = delete;
+  TracedOperation& operator=(const TracedOperation&) = delete;
+
+  // Whether the operation is traced.
+  bool enabled() const { return span_ != nullptr; }
+
+  // 'key' must be a string literal.
+  void SetAttribute(absl::string_view key, absl::string_view value) {
+    if (span_ != nullptr) span_->SetAttribute(key, value);
+  }
+  void SetAttribute(absl::string_view key, int64_t value) {
+    if (span_ != nullptr) span_->SetAttribute(key, value);
+  }
+
+  // Records the status the span ends with; OK by default.
+  void SetStatus(const crypto::tink::util::Status& status) {
+    if (span_ != nullptr) status_ = status;
+  }
+
+  // For operations which finish asynchronously: returns a callback which
+  // ends the span with the result passed to it, and then calls 'done'.  The
+  // span no longer ends with this object.  Without a span, returns 'done'.
+  template <class T>
+  std::function<void(crypto::tink::util::StatusOr<T>)> EndWhenDone(
+      std::function<void(crypto::tink::util::StatusOr<T>)> done) {
+    if (span_ == nullptr) return done;
+    std::shared_ptr<TraceSpan> span = std::move(span_);
+    return [span, done](crypto::tink::util::StatusOr<T> result) {
+      span->End(result.status());
+      done(std::move(result));
+    };
+  }
+
+ private:
+  std::unique_ptr<TraceSpan> span_;
+  crypto::tink::util::Status status_;
+};
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTERNAL_TRACED_OPERATION_H_
@@ -0,0 +1,147 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/internal/traced_operation.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/tracing.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+
+struct EndedSpan {
+  std::string name;
+  std::map<std::string, std::string> attributes;
+  util::Status status;
+};
+
+// Records the spans once they ended.
+class RecordingTracer : public Tracer {
+ public:
+  std::unique_ptr<TraceSpan> StartSpan(absl::string_view name) override {
+    return absl::make_unique<Span>(this, name);
+  }
+
+  std::vector<EndedSpan> ended_spans() {
+    absl::MutexLock lock(&mutex_);
+    return ended_spans_;
+  }
+
+ private:
+  class Span : public TraceSpan {
+   public:
+    Span(RecordingTracer* tracer, absl::string_view name) : tracer_(tracer) {
+      span_.name = std::string(name);
+    }
+    void SetAttribute(absl::string_view key,
+                      absl::string_view value) override {
+      span_.attributes[std::string(key)] = std::string(value);
+    }
+    void SetAttribute(absl::string_view key, int64_t value) override {
+      span_.attributes[std::string(key)] = std::to_string(value);
+    }
+    void End(const util::Status& status) override {
+      span_.status = status;
+      absl::MutexLock lock(&tracer_->mutex_);
+      tracer_->ended_spans_.push_back(span_);
+    }
+
+   private:
+    RecordingTracer* const tracer_;
+    EndedSpan span_;
+  };
+
+  absl::Mutex mutex_;
+  std::vector<EndedSpan> ended_spans_ ABSL_GUARDED_BY(mutex_);
+};
+
+// A tracer can only be registered once per process, so all checks run in a
+// single test.
+TEST(TracedOperationTest, StartsSpansWithRegisteredTracer) {
+  EXPECT_EQ(nullptr, GetTracer());
+  std::vector<util::StatusOr<std::string>> results;
+  std::function<void(util::StatusOr<std::string>)> done =
+      [&results](util::StatusOr<std::string> result) {
+        results.push_back(std::move(result));
+      };
+  {
+    // Without a tracer nothing is traced.
+    TracedOperation operation("tink.test.operation");
+    EXPECT_FALSE(operation.enabled());
+    operation.SetAttribute("tink.bytes", 3);
+    operation.EndWhenDone(done)(std::string("result"));
+  }
+  ASSERT_EQ(1, results.size());
+
+  EXPECT_THAT(RegisterTracer(nullptr), StatusIs(util::error::INVALID_ARGUMENT));
+  auto tracer = absl::make_unique<RecordingTracer>();
+  RecordingTracer* recording_tracer = tracer.get();
+  ASSERT_THAT(RegisterTracer(std::move(tracer)), IsOk());
+  EXPECT_EQ(recording_tracer, GetTracer());
+  EXPECT_THAT(RegisterTracer(absl::make_unique<RecordingTracer>()),
+              StatusIs(util::error::ALREADY_EXISTS));
+
+  {
+    TracedOperation operation("tink.test.sync");
+    EXPECT_TRUE(operation.enabled());
+    operation.SetAttribute("tink.type_url", "type.googleapis.com/Key");
+    operation.SetAttribute("tink.bytes", 42);
+    operation.SetStatus(util::Status(util::error::INTERNAL, "failed"));
+  }
+  std::vector<EndedSpan> spans = recording_tracer->ended_spans();
+  ASSERT_EQ(1, spans.size());
+  EXPECT_EQ("tink.test.sync", spans[0].name);
+  EXPECT_EQ("type.googleapis.com/Key", spans[0].attributes["tink.type_url"]);
+  EXPECT_EQ("42", spans[0].attributes["tink.bytes"]);
+  EXPECT_THAT(spans[0].status, StatusIs(util::error::INTERNAL));
+
+  // An asynchronous operation ends with the result passed to the callback.
+  std::function<void(util::StatusOr<std::string>)> traced_done;
+  {
+    TracedOperation operation("tink.test.async");
+    traced_done = operation.EndWhenDone(done);
+  }
+  EXPECT_EQ(1, recording_tracer->ended_spans().size());
+  traced_done(util::Status(util::error::UNAVAILABLE, "unavailable"));
+  ASSERT_EQ(2, results.size());
+  EXPECT_THAT(results[1].status(), StatusIs(util::error::UNAVAILABLE));
+  spans = recording_tracer->ended_spans();
+  ASSERT_EQ(2, spans.size());
+  EXPECT_EQ("tink.test.async", spans[1].name);
+  EXPECT_THAT(spans[1].status, StatusIs(util::error::UNAVAILABLE));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,69 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "tink/internal/warm_up.h"
+
+#include <string>
+
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+Status WarmUpPrimitive(const Aead& aead) {
+  StatusOr<std::string> ciphertext = aead.Encrypt("", "");
+  if (!ciphertext.ok()) return ciphertext.status();
+  StatusOr<std::string> plaintext = aead.Decrypt(ciphertext.ValueOrDie(), "");
+  if (!plaintext.ok()) return plaintext.status();
+  if (!plaintext.ValueOrDie().empty()) {
+    return Status(util::error::INTERNAL, "Decryption returned wrong plaintext");
+  }
+  return Status::OK;
+}
+
+Status WarmUpPrimitive(const DeterministicAead& daead) {
+  StatusOr<std::string> ciphertext = daead.EncryptDeterministically("", "");
+  if (!ciphertext.ok()) return ciphertext.status();
+  StatusOr<std::string> plaintext =
+      daead.DecryptDeterministically(ciphertext.ValueOrDie(), "");
+  if (!plaintext.ok()) return plaintext.status();
+  if (!plaintext.ValueOrDie().empty()) {
+    return Status(util::error::INTERNAL, "Decryption returned wrong plaintext");
+  }
+  return Status::OK;
+}
+
+Status WarmUpPrimitive(const HybridEncrypt& encrypt) {
+  return encrypt.Encrypt("", "").status();
+}
+
+Status WarmUpPrimitive(const Mac& mac) {
+  StatusOr<std::string> tag = mac.ComputeMac("");
+  if (!tag.ok()) return tag.status();
+  return mac.VerifyMac(tag.ValueOrDie(), "");
+}
+
+Status WarmUpPrimitive(const PublicKeySign& sign) {
+  return sign.Sign("").status();
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
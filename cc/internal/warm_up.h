@@ -0,0 +1,64 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef TINK_INTERNAL_WARM_UP_H_
+#define TINK_INTERNAL_WARM_UP_H_
+
+#include <type_traits>
+
+#include "tink/aead.h"
+#include "tink/deterministic_aead.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/mac.h"
+#include "tink/public_key_sign.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+
+// Runs one operation of 'primitive' on empty inputs, and checks its result
+// where the primitive can check it itself (e.g. by decrypting the
+// ciphertext). The work which the first operation of a key does (e.g. the
+// precomputations of BoringSSL for an RSA key, or the page faults on the
+// key material) is thus done before the first request.
+crypto::tink::util::Status WarmUpPrimitive(const Aead& aead);
+crypto::tink::util::Status WarmUpPrimitive(const DeterministicAead& daead);
+crypto::tink::util::Status WarmUpPrimitive(const HybridEncrypt& encrypt);
+crypto::tink::util::Status WarmUpPrimitive(const Mac& mac);
+crypto::tink::util::Status WarmUpPrimitive(const PublicKeySign& sign);
+
+template <class P>
+struct HasWarmUpOperation
+    : std::integral_constant<
+          bool, std::is_base_of<Aead, P>::value ||
+                    std::is_base_of<DeterministicAead, P>::value ||
+                    std::is_base_of<HybridEncrypt, P>::value ||
+                    std::is_base_of<Mac, P>::value ||
+                    std::is_base_of<PublicKeySign, P>::value> {};
+
+// Primitives whose operations need an input from a peer (e.g. a signature
+// to verify) are only created.
+template <class P, typename std::enable_if<!HasWarmUpOperation<P>::value,
+                                           int>::type = 0>
+crypto::tink::util::Status WarmUpPrimitive(const P&) {
+  return crypto::tink::util::Status::OK;
+}
+
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_INTERNAL_WARM_UP_H_
@@ -0,0 +1,99 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "tink/internal/warm_up.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace internal {
+namespace {
+
+using ::crypto::tink::test::DummyAead;
+using ::crypto::tink::test::DummyDeterministicAead;
+using ::crypto::tink::test::DummyHybridEncrypt;
+using ::crypto::tink::test::DummyMac;
+using ::crypto::tink::test::DummyPublicKeySign;
+using ::crypto::tink::test::DummyPublicKeyVerify;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::crypto::tink::util::Status;
+using ::crypto::tink::util::StatusOr;
+
+// An Aead whose decryption returns a wrong plaintext.
+class WrongPlaintextAead : public Aead {
+ public:
+  StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override {
+    return std::string(plaintext);
+  }
+  StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override {
+    return std::string("wrong");
+  }
+};
+
+// An Aead whose encryption fails.
+class FailingAead : public Aead {
+ public:
+  StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override {
+    return Status(util::error::UNAVAILABLE, "device not reachable");
+  }
+  StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override {
+    return Status(util::error::UNAVAILABLE, "device not reachable");
+  }
+};
+
+TEST(WarmUpTest, WorkingPrimitives) {
+  EXPECT_THAT(WarmUpPrimitive(DummyAead("aead")), IsOk());
+  EXPECT_THAT(WarmUpPrimitive(DummyDeterministicAead("daead")), IsOk());
+  EXPECT_THAT(WarmUpPrimitive(DummyHybridEncrypt("hybrid")), IsOk());
+  EXPECT_THAT(WarmUpPrimitive(DummyMac("mac")), IsOk());
+  EXPECT_THAT(WarmUpPrimitive(DummyPublicKeySign("sign")), IsOk());
+}
+
+TEST(WarmUpTest, PrimitiveWithoutOperationIsOk) {
+  EXPECT_THAT(WarmUpPrimitive(DummyPublicKeyVerify("verify")), IsOk());
+}
+
+TEST(WarmUpTest, FailingOperation) {
+  EXPECT_THAT(WarmUpPrimitive(FailingAead()),
+              StatusIs(util::error::UNAVAILABLE));
+}
+
+TEST(WarmUpTest, WrongResult) {
+  EXPECT_THAT(WarmUpPrimitive(WrongPlaintextAead()),
+              StatusIs(util::error::INTERNAL));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace tink
+}  // namespace crypto
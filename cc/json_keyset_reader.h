@@ -18,8 +18,12 @@
 #define TINK_JSON_KEYSET_READER_H_
 
 #include <istream>
+#include <memory>
+#include <string>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "tink/keyset_reader.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
@@ -27,6 +31,43 @@
 namespace crypto {
 namespace tink {
 
+// Remembers the last keyset read by the JsonKeysetReaders that use it, so
+// that reading the same JSON keyset again, e.g. every time a service
+// reloads its configuration, skips the parsing.  The keyset is recognized
+// by comparing the serialized keyset byte for byte.  The cached key
+// material is zeroized when it is replaced, and when the cache is
+// destroyed.
+//
+// Instances of this class are thread safe.
+class JsonKeysetCache {
+ public:
+  JsonKeysetCache() = default;
+  ~JsonKeysetCache();
+
+  JsonKeysetCache(const JsonKeysetCache&) = delete;
+  JsonKeysetCache& operator=(const JsonKeysetCache&) = delete;
+
+ private:
+  friend class JsonKeysetReader;
+
+  // Returns a copy of the cached keyset if it was read from
+  // 'serialized_keyset', and nullptr otherwise.
+  std::unique_ptr<google::crypto::tink::Keyset> Get(
+      absl::string_view serialized_keyset) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Replaces the cached keyset by 'keyset', read from 'serialized_keyset'.
+  void Put(absl::string_view serialized_keyset,
+           const google::crypto::tink::Keyset& keyset)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  void Clear() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  absl::Mutex mutex_;
+  std::string serialized_keyset_ ABSL_GUARDED_BY(mutex_);
+  std::unique_ptr<google::crypto::tink::Keyset> keyset_
+      ABSL_GUARDED_BY(mutex_);
+};
+
 // A KeysetReader that can read from some source cleartext or
 // encrypted keysets in proto JSON wire format, cf.
 // https://developers.google.com/protocol-buffers/docs/encoding
@@ -37,6 +78,13 @@ class JsonKeysetReader : public KeysetReader {
   static crypto::tink::util::StatusOr<std::unique_ptr<KeysetReader>> New(
       absl::string_view serialized_keyset);
 
+  // Like the above, but Read() first looks the keyset up in 'cache', which
+  // must outlive the reader.
+  static crypto::tink::util::StatusOr<std::unique_ptr<KeysetReader>> New(
+      std::unique_ptr<std::istream> keyset_stream, JsonKeysetCache* cache);
+  static crypto::tink::util::StatusOr<std::unique_ptr<KeysetReader>> New(
+      absl::string_view serialized_keyset, JsonKeysetCache* cache);
+
   crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::Keyset>>
   Read() override;
 
@@ -52,6 +100,7 @@ class JsonKeysetReader : public KeysetReader {
 
   std::string serialized_keyset_;
   std::unique_ptr<std::istream> keyset_stream_;
+  JsonKeysetCache* cache_ = nullptr;
 };
 
 }  // namespace tink
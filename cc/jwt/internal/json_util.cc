@@ -14,7 +14,15 @@
 
 #include "tink/jwt/internal/json_util.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
 #include <google/protobuf/util/json_util.h>
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
 #include "absl/strings/substitute.h"
 
 namespace crypto {
@@ -27,6 +35,136 @@ util::Status ConvertProtoStatus(const google::protobuf::util::Status& status) {
                                     std::string(status.message().data(), status.message().length()));
 }
 
+// Largest magnitude up to which every integer is exactly representable as a
+// double, and hence printed without a fraction or exponent.
+constexpr double kMaxExactInteger = 9007199254740992.0;  // 2^53
+
+void AppendJsonString(absl::string_view value, std::string* output) {
+  output->push_back('"');
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        output->append("\\\"");
+        break;
+      case '\\':
+        output->append("\\\\");
+        break;
+      case '\b':
+        output->append("\\b");
+        break;
+      case '\f':
+        output->append("\\f");
+        break;
+      case '\n':
+        output->append("\\n");
+        break;
+      case '\r':
+        output->append("\\r");
+        break;
+      case '\t':
+        output->append("\\t");
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          absl::StrAppendFormat(output, "\\u%04x",
+                                static_cast<unsigned char>(c));
+        } else {
+          output->push_back(c);
+        }
+    }
+  }
+  output->push_back('"');
+}
+
+util::Status AppendJsonNumber(double value, std::string* output) {
+  if (!std::isfinite(value)) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "JSON numbers must be finite");
+  }
+  if (value == std::floor(value) && std::fabs(value) <= kMaxExactInteger) {
+    absl::StrAppend(output, static_cast<int64_t>(value));
+    return util::OkStatus();
+  }
+  // Uses the shortest of the two precisions that reads back exactly.
+  std::string shortest = absl::StrFormat("%.15g", value);
+  double parsed;
+  if (!absl::SimpleAtod(shortest, &parsed) || parsed != value) {
+    shortest = absl::StrFormat("%.17g", value);
+  }
+  output->append(shortest);
+  return util::OkStatus();
+}
+
+util::Status AppendJsonStruct(const google::protobuf::Struct& proto,
+                              std::string* output);
+util::Status AppendJsonList(const google::protobuf::ListValue& proto,
+                            std::string* output);
+
+util::Status AppendJsonValue(const google::protobuf::Value& value,
+                             std::string* output) {
+  switch (value.kind_case()) {
+    case google::protobuf::Value::kNullValue:
+      output->append("null");
+      return util::OkStatus();
+    case google::protobuf::Value::kNumberValue:
+      return AppendJsonNumber(value.number_value(), output);
+    case google::protobuf::Value::kStringValue:
+      AppendJsonString(value.string_value(), output);
+      return util::OkStatus();
+    case google::protobuf::Value::kBoolValue:
+      output->append(value.bool_value() ? "true" : "false");
+      return util::OkStatus();
+    case google::protobuf::Value::kStructValue:
+      return AppendJsonStruct(value.struct_value(), output);
+    case google::protobuf::Value::kListValue:
+      return AppendJsonList(value.list_value(), output);
+    default:
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "JSON value without kind");
+  }
+}
+
+// Writes the fields ordered by name, so that equal structs always give the
+// same JSON string.
+util::Status AppendJsonStruct(const google::protobuf::Struct& proto,
+                              std::string* output) {
+  using Field = google::protobuf::Map<std::string,
+                                      google::protobuf::Value>::value_type;
+  std::vector<const Field*> fields;
+  fields.reserve(proto.fields().size());
+  for (const auto& field : proto.fields()) {
+    fields.push_back(&field);
+  }
+  std::sort(fields.begin(), fields.end(),
+            [](const Field* a, const Field* b) { return a->first < b->first; });
+  output->push_back('{');
+  for (const Field* field : fields) {
+    if (output->back() != '{') output->push_back(',');
+    AppendJsonString(field->first, output);
+    output->push_back(':');
+    util::Status status = AppendJsonValue(field->second, output);
+    if (!status.ok()) return status;
+  }
+  output->push_back('}');
+  return util::OkStatus();
+}
+
+util::Status AppendJsonList(const google::protobuf::ListValue& proto,
+                            std::string* output) {
+  output->push_back('[');
+  for (const auto& value : proto.values()) {
+    if (output->back() != '[') output->push_back(',');
+    util::Status status = AppendJsonValue(value, output);
+    if (!status.ok()) return status;
+  }
+  output->push_back(']');
+  return util::OkStatus();
+}
+
+// Initial capacity of the output of the serializers, enough for the claims
+// of a typical token so that the string rarely needs to grow.
+constexpr size_t kJsonOutputCapacity = 256;
+
 }  // namespace
 
 util::StatusOr<google::protobuf::Struct> JsonStringToProtoStruct(
@@ -56,9 +194,10 @@ util::StatusOr<google::protobuf::ListValue> JsonStringToProtoList(
 util::StatusOr<std::string> ProtoStructToJsonString(
     const google::protobuf::Struct& proto) {
   std::string output;
-  auto status = google::protobuf::util::MessageToJsonString(proto, &output);
+  output.reserve(kJsonOutputCapacity);
+  util::Status status = AppendJsonStruct(proto, &output);
   if (!status.ok()) {
-    return ConvertProtoStatus(status);
+    return status;
   }
   return output;
 }
@@ -66,9 +205,10 @@ util::StatusOr<std::string> ProtoStructToJsonString(
 util::StatusOr<std::string> ProtoListToJsonString(
     const google::protobuf::ListValue& proto) {
   std::string output;
-  auto status = google::protobuf::util::MessageToJsonString(proto, &output);
+  output.reserve(kJsonOutputCapacity);
+  util::Status status = AppendJsonList(proto, &output);
   if (!status.ok()) {
-    return ConvertProtoStatus(status);
+    return status;
   }
   return output;
 }
@@ -14,6 +14,10 @@
 
 #include "tink/jwt/internal/json_util.h"
 
+#include <cmath>
+#include <limits>
+#include <string>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "tink/util/test_matchers.h"
@@ -99,6 +103,56 @@ TEST(JsonUtil, ParseListWithCommentNotOk) {
   EXPECT_FALSE(proto_or.ok());
 }
 
+TEST(JsonUtil, SerializeStructOk) {
+  google::protobuf::Struct proto;
+  auto& fields = *proto.mutable_fields();
+  fields["b"].set_string_value("quote \" backslash \\ newline \n \x01");
+  fields["a"].set_number_value(1.5);
+  fields["c"].set_null_value(google::protobuf::NULL_VALUE);
+  auto& nested = *fields["d"].mutable_struct_value()->mutable_fields();
+  nested["y"].set_number_value(1e300);
+  nested["x"].mutable_list_value()->add_values()->set_number_value(0.1);
+  nested["x"].mutable_list_value()->add_values()->set_bool_value(true);
+  fields["e"].mutable_struct_value();
+  fields["f"].mutable_list_value();
+
+  std::string expected =
+      R"({"a":1.5,"b":"quote \" backslash \\ newline \n \u0001","c":null,)"
+      R"("d":{"x":[0.1,true],"y":1e+300},"e":{},"f":[]})";
+  ASSERT_THAT(ProtoStructToJsonString(proto), IsOkAndHolds(expected));
+  auto parsed_or = JsonStringToProtoStruct(expected);
+  ASSERT_THAT(parsed_or.status(), IsOk());
+  EXPECT_THAT(ProtoStructToJsonString(parsed_or.ValueOrDie()),
+              IsOkAndHolds(expected));
+}
+
+TEST(JsonUtil, SerializeNumbersOk) {
+  for (double number : {0.0, -1.0, 1614556800.0, 9007199254740992.0,
+                        1e21, 0.1, 1.0 / 3, -2.5e-10}) {
+    google::protobuf::Struct proto;
+    (*proto.mutable_fields())["n"].set_number_value(number);
+    auto json_or = ProtoStructToJsonString(proto);
+    ASSERT_THAT(json_or.status(), IsOk());
+    auto parsed_or = JsonStringToProtoStruct(json_or.ValueOrDie());
+    ASSERT_THAT(parsed_or.status(), IsOk());
+    EXPECT_EQ(number, parsed_or.ValueOrDie().fields().at("n").number_value())
+        << json_or.ValueOrDie();
+  }
+  google::protobuf::Struct proto;
+  (*proto.mutable_fields())["n"].set_number_value(1614556800);
+  EXPECT_THAT(ProtoStructToJsonString(proto),
+              IsOkAndHolds(R"({"n":1614556800})"));
+}
+
+TEST(JsonUtil, SerializeNonFiniteNumberNotOk) {
+  google::protobuf::Struct proto;
+  (*proto.mutable_fields())["n"].set_number_value(
+      std::numeric_limits<double>::infinity());
+  EXPECT_FALSE(ProtoStructToJsonString(proto).ok());
+  google::protobuf::ListValue list;
+  list.add_values()->set_number_value(std::nan(""));
+  EXPECT_FALSE(ProtoListToJsonString(list).ok());
+}
 
 }  // namespace tink
 }  // namespace crypto
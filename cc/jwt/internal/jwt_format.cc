@@ -14,8 +14,10 @@
 
 #include "tink/jwt/internal/jwt_format.h"
 
-#include "absl/strings/escaping.h"
-#include "absl/strings/str_split.h"
+#include <algorithm>
+#include <cstdint>
+
+#include "absl/strings/str_cat.h"
 #include "tink/jwt/internal/json_util.h"
 
 namespace crypto {
@@ -24,29 +26,131 @@ namespace jwt_internal {
 
 namespace {
 
-bool isValidUrlsafeBase64Char(char c) {
-  return (((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
-          ((c >= '0') && (c <= '9')) || ((c == '-') || (c == '_')));
-}
+constexpr char kBase64UrlAlphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
 
-bool StrictWebSafeBase64Unescape(absl::string_view src, std::string* dest) {
-  for (char c : src) {
-    if (!isValidUrlsafeBase64Char(c)) {
-      return false;
+// Value of a character which is not in kBase64UrlAlphabet.
+constexpr uint8_t kInvalid = 0xff;
+
+// Returns a table mapping each character to its 6-bit value in
+// kBase64UrlAlphabet, or to kInvalid.
+const uint8_t* DecodingTable() {
+  static const uint8_t* table = [] {
+    uint8_t* values = new uint8_t[256];
+    std::fill(values, values + 256, kInvalid);
+    for (int i = 0; i < 64; ++i) {
+      values[static_cast<uint8_t>(kBase64UrlAlphabet[i])] = i;
     }
+    return values;
+  }();
+  return table;
+}
+
+bool Base64UrlUnescape(absl::string_view src, std::string* dest) {
+  dest->resize(Base64UrlMaxDecodedSize(src.size()));
+  size_t size;
+  if (!Base64UrlDecode(src, &(*dest)[0], &size)) {
+    dest->clear();
+    return false;
   }
-  return absl::WebSafeBase64Unescape(src, dest);
+  dest->resize(size);
+  return true;
+}
+
+std::string Base64UrlEscape(absl::string_view src) {
+  std::string dest;
+  AppendBase64Url(src, &dest);
+  return dest;
 }
 
 }  // namespace
 
+size_t Base64UrlEncode(absl::string_view data, char* output) {
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(data.data());
+  size_t remaining = data.size();
+  char* out = output;
+  for (; remaining >= 3; remaining -= 3, in += 3, out += 4) {
+    uint32_t bits = (in[0] << 16) | (in[1] << 8) | in[2];
+    out[0] = kBase64UrlAlphabet[bits >> 18];
+    out[1] = kBase64UrlAlphabet[(bits >> 12) & 0x3f];
+    out[2] = kBase64UrlAlphabet[(bits >> 6) & 0x3f];
+    out[3] = kBase64UrlAlphabet[bits & 0x3f];
+  }
+  if (remaining == 1) {
+    out[0] = kBase64UrlAlphabet[in[0] >> 2];
+    out[1] = kBase64UrlAlphabet[(in[0] & 0x03) << 4];
+    out += 2;
+  } else if (remaining == 2) {
+    uint32_t bits = (in[0] << 8) | in[1];
+    out[0] = kBase64UrlAlphabet[bits >> 10];
+    out[1] = kBase64UrlAlphabet[(bits >> 4) & 0x3f];
+    out[2] = kBase64UrlAlphabet[(bits << 2) & 0x3f];
+    out += 3;
+  }
+  return out - output;
+}
+
+void AppendBase64Url(absl::string_view data, std::string* output) {
+  size_t offset = output->size();
+  output->resize(offset + Base64UrlEncodedSize(data.size()));
+  Base64UrlEncode(data, &(*output)[offset]);
+}
+
+bool Base64UrlDecode(absl::string_view encoded, char* output,
+                     size_t* output_size) {
+  if (encoded.size() % 4 == 1) {
+    return false;
+  }
+  const uint8_t* table = DecodingTable();
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(encoded.data());
+  size_t remaining = encoded.size();
+  uint8_t* out = reinterpret_cast<uint8_t*>(output);
+  for (; remaining >= 4; remaining -= 4, in += 4, out += 3) {
+    uint8_t a = table[in[0]];
+    uint8_t b = table[in[1]];
+    uint8_t c = table[in[2]];
+    uint8_t d = table[in[3]];
+    if ((a | b | c | d) & 0xc0) {
+      return false;
+    }
+    uint32_t bits = (a << 18) | (b << 12) | (c << 6) | d;
+    out[0] = bits >> 16;
+    out[1] = bits >> 8;
+    out[2] = bits;
+  }
+  if (remaining > 0) {
+    uint32_t bits = 0;
+    for (size_t i = 0; i < remaining; ++i) {
+      uint8_t value = table[in[i]];
+      if (value & 0xc0) {
+        return false;
+      }
+      bits = (bits << 6) | value;
+    }
+    if (remaining == 2) {
+      // 12 bits, of which the last 4 must be zero.
+      if (bits & 0x0f) return false;
+      out[0] = bits >> 4;
+      out += 1;
+    } else {
+      // 18 bits, of which the last 2 must be zero.
+      if (bits & 0x03) return false;
+      out[0] = bits >> 10;
+      out[1] = bits >> 2;
+      out += 2;
+    }
+  }
+  *output_size = out - reinterpret_cast<uint8_t*>(output);
+  return true;
+}
+
 
 std::string EncodeHeader(absl::string_view json_header) {
-  return absl::WebSafeBase64Escape(json_header);
+  return Base64UrlEscape(json_header);
 }
 
 bool DecodeHeader(absl::string_view header, std::string* json_header) {
-  return StrictWebSafeBase64Unescape(header, json_header);
+  return Base64UrlUnescape(header, json_header);
 }
 
 std::string CreateHeader(absl::string_view algorithm) {
@@ -54,6 +158,15 @@ std::string CreateHeader(absl::string_view algorithm) {
   return EncodeHeader(header);
 }
 
+std::string CreateHeader(absl::string_view algorithm, absl::string_view kid) {
+  google::protobuf::Struct header;
+  auto& fields = *header.mutable_fields();
+  fields["alg"].set_string_value(std::string(algorithm));
+  fields["kid"].set_string_value(std::string(kid));
+  // Serializing a Struct of two strings does not fail.
+  return EncodeHeader(ProtoStructToJsonString(header).ValueOrDie());
+}
+
 util::Status ValidateHeader(absl::string_view encoded_header,
                             absl::string_view algorithm) {
   std::string json_header;
@@ -92,21 +205,36 @@ util::Status ValidateHeader(absl::string_view encoded_header,
   return util::OkStatus();
 }
 
+bool GetKeyIdFromHeader(absl::string_view encoded_header, std::string* kid) {
+  std::string json_header;
+  if (!DecodeHeader(encoded_header, &json_header)) return false;
+  auto proto_or = JsonStringToProtoStruct(json_header);
+  if (!proto_or.ok()) return false;
+  const auto& fields = proto_or.ValueOrDie().fields();
+  auto it = fields.find("kid");
+  if (it == fields.end() ||
+      it->second.kind_case() != google::protobuf::Value::kStringValue) {
+    return false;
+  }
+  *kid = it->second.string_value();
+  return true;
+}
+
 std::string EncodePayload(absl::string_view json_payload) {
-  return absl::WebSafeBase64Escape(json_payload);
+  return Base64UrlEscape(json_payload);
 }
 
 bool DecodePayload(absl::string_view payload, std::string* json_payload) {
-  return StrictWebSafeBase64Unescape(payload, json_payload);
+  return Base64UrlUnescape(payload, json_payload);
 }
 
 std::string EncodeSignature(absl::string_view signature) {
-  return absl::WebSafeBase64Escape(signature);
+  return Base64UrlEscape(signature);
 }
 
 bool DecodeSignature(absl::string_view encoded_signature,
                      std::string* signature) {
-  return StrictWebSafeBase64Unescape(encoded_signature, signature);
+  return Base64UrlUnescape(encoded_signature, signature);
 }
 
 }  // namespace jwt_internal
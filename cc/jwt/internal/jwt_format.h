@@ -15,6 +15,10 @@
 #ifndef TINK_JWT_INTERNAL_JWT_FORMAT_H_
 #define TINK_JWT_INTERNAL_JWT_FORMAT_H_
 
+#include <cstddef>
+#include <string>
+
+#include "absl/strings/string_view.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
@@ -22,12 +26,41 @@ namespace crypto {
 namespace tink {
 namespace jwt_internal {
 
+// Unpadded base64url (RFC 4648, section 5) codec writing into caller-provided
+// buffers.
+//
+// Returns the length of the encoding of 'size' bytes.
+constexpr size_t Base64UrlEncodedSize(size_t size) {
+  return (size / 3) * 4 + (size % 3 == 0 ? 0 : size % 3 + 1);
+}
+// Returns an upper bound for the length of the decoding of 'size' characters.
+constexpr size_t Base64UrlMaxDecodedSize(size_t size) {
+  return (size / 4) * 3 + (size % 4 == 0 ? 0 : size % 4 - 1);
+}
+// Writes the encoding of 'data' to 'output', which must have room for
+// Base64UrlEncodedSize(data.size()) characters, and returns its length.
+size_t Base64UrlEncode(absl::string_view data, char* output);
+// Appends the encoding of 'data' to 'output'.
+void AppendBase64Url(absl::string_view data, std::string* output);
+// Writes the decoding of 'encoded' to 'output', which must have room for
+// Base64UrlMaxDecodedSize(encoded.size()) bytes, and sets 'output_size' to
+// its length. Returns false if 'encoded' contains a character outside of the
+// base64url alphabet (this includes padding and whitespace) or is not a
+// canonical encoding.
+bool Base64UrlDecode(absl::string_view encoded, char* output,
+                     size_t* output_size);
+
 std::string EncodeHeader(absl::string_view json_header);
 bool DecodeHeader(absl::string_view header, std::string* json_header);
 
 std::string CreateHeader(absl::string_view algorithm);
+// Returns the header for 'algorithm' with the key ID 'kid'.
+std::string CreateHeader(absl::string_view algorithm, absl::string_view kid);
 util::Status ValidateHeader(absl::string_view encoded_header,
                             absl::string_view algorithm);
+// Sets 'kid' to the key ID in 'encoded_header'. Returns false if the header
+// cannot be decoded or has no "kid" string.
+bool GetKeyIdFromHeader(absl::string_view encoded_header, std::string* kid);
 
 std::string EncodePayload(absl::string_view json_payload);
 bool DecodePayload(absl::string_view payload, std::string* json_payload);
@@ -16,6 +16,7 @@
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "absl/strings/escaping.h"
 #include "tink/util/test_matchers.h"
 #include "tink/util/test_util.h"
 
@@ -103,6 +104,26 @@ TEST(JwtFormat, CreateValidateHeader) {
   EXPECT_FALSE(ValidateHeader(encoded_header, "HS256").ok());
 }
 
+TEST(JwtFormat, CreateHeaderWithKeyId) {
+  std::string encoded_header = CreateHeader("HS256", "key \"1\"");
+  EXPECT_THAT(ValidateHeader(encoded_header, "HS256"), IsOk());
+  std::string kid;
+  ASSERT_TRUE(GetKeyIdFromHeader(encoded_header, &kid));
+  EXPECT_EQ(kid, "key \"1\"");
+}
+
+TEST(JwtFormat, GetKeyIdFromHeader) {
+  std::string kid;
+  EXPECT_TRUE(GetKeyIdFromHeader(
+      EncodeHeader(R"({"alg":"HS256","kid":"some kid"})"), &kid));
+  EXPECT_EQ(kid, "some kid");
+  EXPECT_FALSE(GetKeyIdFromHeader(CreateHeader("HS256"), &kid));
+  EXPECT_FALSE(GetKeyIdFromHeader(
+      EncodeHeader(R"({"alg":"HS256","kid":1})"), &kid));
+  EXPECT_FALSE(GetKeyIdFromHeader(EncodeHeader(R"({"kid":"a")"), &kid));
+  EXPECT_FALSE(GetKeyIdFromHeader("eyJ?", &kid));
+}
+
 TEST(JwtFormat, ValidateEmptyHeaderFails) {
   std::string header = "{}";
   EXPECT_FALSE(ValidateHeader(EncodeHeader(header), "HS256").ok());
@@ -176,6 +197,43 @@ TEST(JwtFormat, DecodeSignatureWithLineFeedFails) {
       DecodePayload("dBjftJeZ4CVP-mB92K2\n7uhbUJU1p1r_wW1gFWFOEjXk", &output));
 }
 
+TEST(JwtFormat, Base64UrlEncodeAndDecodeAllLengths) {
+  std::string data("\x00\xfb\xff\x10 any data", 13);
+  for (size_t size = 0; size <= data.size(); ++size) {
+    absl::string_view prefix = absl::string_view(data).substr(0, size);
+    std::string expected = absl::WebSafeBase64Escape(prefix);
+    std::string output(Base64UrlEncodedSize(size), 'x');
+    EXPECT_THAT(Base64UrlEncode(prefix, &output[0]), Eq(expected.size()));
+    EXPECT_THAT(output, Eq(expected));
+
+    std::string decoded(Base64UrlMaxDecodedSize(expected.size()), 'x');
+    size_t decoded_size;
+    ASSERT_TRUE(Base64UrlDecode(expected, &decoded[0], &decoded_size));
+    decoded.resize(decoded_size);
+    EXPECT_THAT(decoded, Eq(prefix));
+  }
+}
+
+TEST(JwtFormat, AppendBase64Url) {
+  std::string output = "abc.";
+  AppendBase64Url("\xfb\xff", &output);
+  EXPECT_THAT(output, Eq("abc.-_8"));
+}
+
+TEST(JwtFormat, Base64UrlDecodeInvalidInputFails) {
+  char output[16];
+  size_t output_size;
+  // Padding, standard base64 characters and an impossible length.
+  EXPECT_FALSE(Base64UrlDecode("-_8=", output, &output_size));
+  EXPECT_FALSE(Base64UrlDecode("+/8", output, &output_size));
+  EXPECT_FALSE(Base64UrlDecode("YWJjZ", output, &output_size));
+  // Non-zero trailing bits.
+  EXPECT_FALSE(Base64UrlDecode("YR", output, &output_size));
+  EXPECT_FALSE(Base64UrlDecode("YWJ", output, &output_size));
+  EXPECT_TRUE(Base64UrlDecode("YWI", output, &output_size));
+  EXPECT_THAT(absl::string_view(output, output_size), Eq("ab"));
+}
+
 }  // namespace jwt_internal
 }  // namespace tink
 }  // namespace crypto
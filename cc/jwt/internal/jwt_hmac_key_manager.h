@@ -18,6 +18,7 @@
 
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
 #include "tink/core/key_type_manager.h"
 #include "tink/jwt/internal/jwt_mac_impl.h"
 #include "tink/jwt/internal/raw_jwt_hmac_key_manager.h"
@@ -72,9 +73,13 @@ class JwtHmacKeyManager
       if (!mac_or.ok()) {
         return mac_or.status();
       }
+      absl::optional<std::string> kid;
+      if (jwt_hmac_key.has_custom_kid()) {
+        kid = jwt_hmac_key.custom_kid().value();
+      }
       std::unique_ptr<JwtMac> jwt_mac =
           absl::make_unique<jwt_internal::JwtMacImpl>(
-              std::move(mac_or.ValueOrDie()), algorithm);
+              std::move(mac_or.ValueOrDie()), algorithm, std::move(kid));
       return jwt_mac;
     }
   };
@@ -14,8 +14,9 @@
 
 #include "tink/jwt/internal/jwt_mac_impl.h"
 
-#include "absl/strings/escaping.h"
-#include "absl/strings/str_split.h"
+#include <string>
+
+#include "absl/strings/strip.h"
 #include "tink/jwt/internal/json_util.h"
 #include "tink/jwt/internal/jwt_format.h"
 
@@ -25,20 +26,27 @@ namespace jwt_internal {
 
 util::StatusOr<std::string> JwtMacImpl::ComputeMacAndEncode(
     const RawJwt& token) const {
-  std::string encoded_header = CreateHeader(algorithm_);
   util::StatusOr<std::string> payload_or = token.ToString();
   if (!payload_or.ok()) {
     return payload_or.status();
   }
-  std::string encoded_payload = EncodePayload(payload_or.ValueOrDie());
-  std::string unsigned_token =
-      absl::StrCat(encoded_header, ".", encoded_payload);
-  util::StatusOr<std::string> tag_or = mac_->ComputeMac(unsigned_token);
+  const std::string& payload = payload_or.ValueOrDie();
+  // Assemble the compact serialization in a single buffer, and compute the
+  // MAC over its prefix.
+  std::string compact;
+  compact.reserve(encoded_header_.size() + 1 +
+                  Base64UrlEncodedSize(payload.size()) + 1 +
+                  Base64UrlEncodedSize(kMaxTagSize));
+  compact.append(encoded_header_);
+  compact.push_back('.');
+  AppendBase64Url(payload, &compact);
+  util::StatusOr<std::string> tag_or = ComputeMac(compact);
   if (!tag_or.ok()) {
     return tag_or.status();
   }
-  std::string encoded_tag = EncodeSignature(tag_or.ValueOrDie());
-  return absl::StrCat(unsigned_token, ".", encoded_tag);
+  compact.push_back('.');
+  AppendBase64Url(tag_or.ValueOrDie(), &compact);
+  return compact;
 }
 
 util::StatusOr<VerifiedJwt> JwtMacImpl::VerifyMacAndDecode(
@@ -52,34 +60,77 @@ util::StatusOr<VerifiedJwt> JwtMacImpl::VerifyMacAndDecode(
   if (!DecodeSignature(compact.substr(mac_pos + 1), &mac_value)) {
     return util::Status(util::error::INVALID_ARGUMENT, "invalid JWT MAC");
   }
-  util::Status verify_result = mac_->VerifyMac(mac_value, unsigned_token);
+  util::Status verify_result = VerifyMac(mac_value, unsigned_token);
   if (!verify_result.ok()) {
     return verify_result;
   }
-  std::vector<absl::string_view> parts = absl::StrSplit(unsigned_token, '.');
-  if (parts.size() != 2) {
+  std::size_t payload_pos = unsigned_token.find('.');
+  if (payload_pos == absl::string_view::npos ||
+      unsigned_token.find('.', payload_pos + 1) != absl::string_view::npos) {
     return util::Status(
         util::error::INVALID_ARGUMENT,
         "only tokens in JWS compact serialization format are supported");
   }
-  util::Status validate_header_result = ValidateHeader(parts[0], algorithm_);
+  util::Status validate_header_result =
+      ValidateEncodedHeader(unsigned_token.substr(0, payload_pos));
   if (!validate_header_result.ok()) {
     return validate_header_result;
   }
   std::string json_payload;
-  if (!DecodePayload(parts[1], &json_payload)) {
+  if (!DecodePayload(unsigned_token.substr(payload_pos + 1), &json_payload)) {
     return util::Status(util::error::INVALID_ARGUMENT, "invalid JWT payload");
   }
   auto raw_jwt_or = RawJwt::FromString(json_payload);
   if (!raw_jwt_or.ok()) {
     return raw_jwt_or.status();
   }
-  RawJwt raw_jwt = raw_jwt_or.ValueOrDie();
-  util::Status validate_result = validator.Validate(raw_jwt);
+  util::Status validate_result = validator.Validate(raw_jwt_or.ValueOrDie());
   if (!validate_result.ok()) {
     return validate_result;
   }
-  return VerifiedJwt(raw_jwt);
+  return VerifiedJwt(std::move(raw_jwt_or.ValueOrDie()));
+}
+
+util::StatusOr<std::string> JwtMacImpl::ComputeMac(
+    absl::string_view unsigned_token) const {
+  absl::string_view rest = unsigned_token;
+  if (header_mac_ != nullptr && absl::ConsumePrefix(&rest, encoded_header_) &&
+      absl::ConsumePrefix(&rest, ".")) {
+    return header_mac_->ComputeMac(rest);
+  }
+  return mac_->ComputeMac(unsigned_token);
+}
+
+util::Status JwtMacImpl::VerifyMac(absl::string_view mac_value,
+                                   absl::string_view unsigned_token) const {
+  absl::string_view rest = unsigned_token;
+  if (header_mac_ != nullptr && absl::ConsumePrefix(&rest, encoded_header_) &&
+      absl::ConsumePrefix(&rest, ".")) {
+    return header_mac_->VerifyMac(mac_value, rest);
+  }
+  return mac_->VerifyMac(mac_value, unsigned_token);
+}
+
+util::Status JwtMacImpl::ValidateEncodedHeader(
+    absl::string_view encoded_header) const {
+  if (encoded_header == encoded_header_) {
+    return util::OkStatus();
+  }
+  {
+    absl::MutexLock lock(&header_cache_mutex_);
+    if (validated_headers_.contains(encoded_header)) {
+      return util::OkStatus();
+    }
+  }
+  util::Status status = ValidateHeader(encoded_header, algorithm_);
+  if (!status.ok()) {
+    return status;
+  }
+  absl::MutexLock lock(&header_cache_mutex_);
+  if (validated_headers_.size() < kMaxCachedHeaders) {
+    validated_headers_.emplace(encoded_header);
+  }
+  return util::OkStatus();
 }
 
 }  // namespace jwt_internal
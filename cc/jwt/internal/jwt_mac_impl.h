@@ -15,7 +15,13 @@
 #ifndef TINK_JWT_INTERNAL_JWT_MAC_IMPL_H_
 #define TINK_JWT_INTERNAL_JWT_MAC_IMPL_H_
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+#include "tink/jwt/internal/jwt_format.h"
 #include "tink/jwt/jwt_mac.h"
 #include "tink/jwt/jwt_validator.h"
 #include "tink/jwt/raw_jwt.h"
@@ -30,10 +36,17 @@ namespace jwt_internal {
 
 class JwtMacImpl : public JwtMac {
  public:
+  // If 'kid' is set, ComputeMacAndEncode() writes it into the header.
   explicit JwtMacImpl(std::unique_ptr<crypto::tink::Mac> mac,
-                      absl::string_view algorithm) {
+                      absl::string_view algorithm,
+                      absl::optional<std::string> kid = absl::nullopt) {
     mac_ = std::move(mac);
     algorithm_ = std::string(algorithm);
+    kid_ = std::move(kid);
+    encoded_header_ = kid_.has_value() ? CreateHeader(algorithm_, *kid_)
+                                       : CreateHeader(algorithm_);
+    auto header_mac_or = mac_->WithPrefix(absl::StrCat(encoded_header_, "."));
+    if (header_mac_or.ok()) header_mac_ = std::move(header_mac_or.ValueOrDie());
   }
 
   crypto::tink::util::StatusOr<std::string> ComputeMacAndEncode(
@@ -43,9 +56,41 @@ class JwtMacImpl : public JwtMac {
       absl::string_view compact,
       const crypto::tink::JwtValidator& validator) const override;
 
+  const absl::optional<std::string>& kid() const { return kid_; }
+
  private:
+  // The size of the largest tag, used to size the buffer of
+  // ComputeMacAndEncode().
+  static constexpr int kMaxTagSize = 64;
+  // Maximal number of distinct header encodings remembered by
+  // ValidateEncodedHeader().
+  static constexpr int kMaxCachedHeaders = 32;
+
+  // Validates the encoded header against algorithm_. Headers which validated
+  // successfully before are accepted without being decoded and parsed again.
+  crypto::tink::util::Status ValidateEncodedHeader(
+      absl::string_view encoded_header) const;
+
+  // Computes the MAC of 'unsigned_token', skipping the hashing of the header
+  // if it is encoded_header_.
+  crypto::tink::util::StatusOr<std::string> ComputeMac(
+      absl::string_view unsigned_token) const;
+
+  // Verifies 'mac_value' for 'unsigned_token' like ComputeMac() computes it.
+  crypto::tink::util::Status VerifyMac(absl::string_view mac_value,
+                                       absl::string_view unsigned_token) const;
+
   std::unique_ptr<crypto::tink::Mac> mac_;
+  // mac_ with encoded_header_ and the following '.' already absorbed, for
+  // tokens with the default header. Null if mac_ failed to create it.
+  std::unique_ptr<crypto::tink::Mac> header_mac_;
   std::string algorithm_;
+  absl::optional<std::string> kid_;
+  // The header produced by ComputeMacAndEncode().
+  std::string encoded_header_;
+  mutable absl::Mutex header_cache_mutex_;
+  mutable absl::flat_hash_set<std::string> validated_headers_
+      ABSL_GUARDED_BY(header_cache_mutex_);
 };
 
 }  // namespace jwt_internal
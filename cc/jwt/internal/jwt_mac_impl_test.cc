@@ -17,6 +17,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
 #include "tink/jwt/internal/jwt_format.h"
 #include "tink/jwt/jwt_mac.h"
 #include "tink/jwt/jwt_validator.h"
@@ -39,7 +40,7 @@ namespace jwt_internal {
 
 namespace {
 
-util::StatusOr<std::unique_ptr<JwtMac>> CreateJwtMac() {
+util::StatusOr<std::unique_ptr<Mac>> CreateHmac() {
   std::string key_value;
   if (!absl::WebSafeBase64Unescape(
           "AyM1SysPpbyDfgZld3umj1qzKObwVMkoqQ-EstJQLr_T-1"
@@ -47,10 +48,13 @@ util::StatusOr<std::unique_ptr<JwtMac>> CreateJwtMac() {
           &key_value)) {
     return util::Status(util::error::INVALID_ARGUMENT, "failed to parse key");
   }
-  crypto::tink::util::StatusOr<std::unique_ptr<Mac>> mac_or =
-      subtle::HmacBoringSsl::New(
-          util::Enums::ProtoToSubtle(google::crypto::tink::HashType::SHA256),
-          32, util::SecretDataFromStringView(key_value));
+  return subtle::HmacBoringSsl::New(
+      util::Enums::ProtoToSubtle(google::crypto::tink::HashType::SHA256), 32,
+      util::SecretDataFromStringView(key_value));
+}
+
+util::StatusOr<std::unique_ptr<JwtMac>> CreateJwtMac() {
+  crypto::tink::util::StatusOr<std::unique_ptr<Mac>> mac_or = CreateHmac();
   if (!mac_or.ok()) {
     return mac_or.status();
   }
@@ -59,6 +63,25 @@ util::StatusOr<std::unique_ptr<JwtMac>> CreateJwtMac() {
   return jwt_mac;
 }
 
+// Returns a token with the given JSON header and payload, MAC'ed with the key
+// used by CreateJwtMac().
+util::StatusOr<std::string> CreateTokenWithHeader(
+    absl::string_view json_header, absl::string_view json_payload) {
+  crypto::tink::util::StatusOr<std::unique_ptr<Mac>> mac_or = CreateHmac();
+  if (!mac_or.ok()) {
+    return mac_or.status();
+  }
+  std::string unsigned_token = absl::StrCat(EncodeHeader(json_header), ".",
+                                            EncodePayload(json_payload));
+  util::StatusOr<std::string> tag_or =
+      mac_or.ValueOrDie()->ComputeMac(unsigned_token);
+  if (!tag_or.ok()) {
+    return tag_or.status();
+  }
+  return absl::StrCat(unsigned_token, ".",
+                      EncodeSignature(tag_or.ValueOrDie()));
+}
+
 TEST(JwtMacImplTest, CreateAndValidateToken) {
   auto jwt_mac_or = CreateJwtMac();
   ASSERT_THAT(jwt_mac_or.status(), IsOk());
@@ -149,6 +172,63 @@ TEST(JwtMacImplTest, ValidateInvalidTokens) {
       jwt_mac->VerifyMacAndDecode("eyJhbGciOiJIUzI1NiJ9.e30", validator).ok());
 }
 
+TEST(JwtMacImplTest, ValidateTokenWithOtherHeaderRepeatedly) {
+  auto jwt_mac_or = CreateJwtMac();
+  ASSERT_THAT(jwt_mac_or.status(), IsOk());
+  std::unique_ptr<JwtMac> jwt_mac = std::move(jwt_mac_or.ValueOrDie());
+  JwtValidator validator = JwtValidatorBuilder().Build();
+
+  auto compact_or = CreateTokenWithHeader(R"({"typ":"JWT","alg":"HS256"})",
+                                          R"({"iss":"joe"})");
+  ASSERT_THAT(compact_or.status(), IsOk());
+  // The second verification uses the cached result for the header.
+  for (int i = 0; i < 2; ++i) {
+    util::StatusOr<VerifiedJwt> verified_jwt_or =
+        jwt_mac->VerifyMacAndDecode(compact_or.ValueOrDie(), validator);
+    ASSERT_THAT(verified_jwt_or.status(), IsOk());
+    EXPECT_THAT(verified_jwt_or.ValueOrDie().GetIssuer(),
+                test::IsOkAndHolds("joe"));
+  }
+}
+
+TEST(JwtMacImplTest, InvalidHeaderIsRejectedRepeatedly) {
+  auto jwt_mac_or = CreateJwtMac();
+  ASSERT_THAT(jwt_mac_or.status(), IsOk());
+  std::unique_ptr<JwtMac> jwt_mac = std::move(jwt_mac_or.ValueOrDie());
+  JwtValidator validator = JwtValidatorBuilder().Build();
+
+  auto wrong_alg_or =
+      CreateTokenWithHeader(R"({"alg":"HS384"})", R"({"iss":"joe"})");
+  ASSERT_THAT(wrong_alg_or.status(), IsOk());
+  auto wrong_typ_or = CreateTokenWithHeader(R"({"alg":"HS256","typ":"JWE"})",
+                                            R"({"iss":"joe"})");
+  ASSERT_THAT(wrong_typ_or.status(), IsOk());
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_FALSE(
+        jwt_mac->VerifyMacAndDecode(wrong_alg_or.ValueOrDie(), validator).ok());
+    EXPECT_FALSE(
+        jwt_mac->VerifyMacAndDecode(wrong_typ_or.ValueOrDie(), validator).ok());
+  }
+}
+
+TEST(JwtMacImplTest, ManyDistinctHeaders) {
+  auto jwt_mac_or = CreateJwtMac();
+  ASSERT_THAT(jwt_mac_or.status(), IsOk());
+  std::unique_ptr<JwtMac> jwt_mac = std::move(jwt_mac_or.ValueOrDie());
+  JwtValidator validator = JwtValidatorBuilder().Build();
+
+  // More distinct headers than the cache holds still verify.
+  for (int i = 0; i < 100; ++i) {
+    auto compact_or = CreateTokenWithHeader(
+        absl::StrCat(R"({"alg":"HS256","kid":")", i, R"("})"), "{}");
+    ASSERT_THAT(compact_or.status(), IsOk());
+    EXPECT_THAT(
+        jwt_mac->VerifyMacAndDecode(compact_or.ValueOrDie(), validator)
+            .status(),
+        IsOk());
+  }
+}
+
 }  // namespace
 }  // namespace jwt_internal
 }  // namespace tink
@@ -14,6 +14,14 @@
 
 #include "tink/jwt/internal/jwt_mac_wrapper.h"
 
+#include <string>
+#include <vector>
+
+#include "absl/base/call_once.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "tink/jwt/internal/jwt_format.h"
+#include "tink/jwt/internal/jwt_mac_impl.h"
 #include "tink/jwt/jwt_mac.h"
 #include "tink/primitive_set.h"
 #include "tink/util/status.h"
@@ -41,9 +49,39 @@ class JwtMacSetWrapper : public JwtMac {
   ~JwtMacSetWrapper() override {}
 
  private:
+  using Entry = PrimitiveSet<JwtMac>::Entry<JwtMac>;
+  using EntriesByKid =
+      absl::flat_hash_map<std::string, std::vector<const Entry*>>;
+
+  // Returns the keys with a "kid" (e.g. imported from a JWK set), by kid.
+  // The index is built on first use, since finding the kids creates the
+  // primitives of all keys, which the keyset may have left lazy.
+  const EntriesByKid& entries_by_kid() const;
+
   std::unique_ptr<PrimitiveSet<JwtMac>> jwt_mac_set_;
+  mutable absl::once_flag entries_by_kid_once_;
+  // Tokens whose header names one of these kids are only verified with the
+  // keys with that kid.
+  mutable EntriesByKid entries_by_kid_;
 };
 
+const JwtMacSetWrapper::EntriesByKid& JwtMacSetWrapper::entries_by_kid()
+    const {
+  absl::call_once(entries_by_kid_once_, [this]() {
+    for (const auto* entry : jwt_mac_set_->get_all()) {
+      auto jwt_mac_or = entry->get_primitive_or();
+      // Keys whose primitive cannot be created are never used to verify.
+      if (!jwt_mac_or.ok()) continue;
+      const auto* jwt_mac_impl = dynamic_cast<const jwt_internal::JwtMacImpl*>(
+          jwt_mac_or.ValueOrDie());
+      if (jwt_mac_impl != nullptr && jwt_mac_impl->kid().has_value()) {
+        entries_by_kid_[*jwt_mac_impl->kid()].push_back(entry);
+      }
+    }
+  });
+  return entries_by_kid_;
+}
+
 util::Status Validate(PrimitiveSet<JwtMac>* jwt_mac_set) {
   if (jwt_mac_set == nullptr) {
     return util::Status(util::error::INTERNAL, "jwt_mac_set must be non-NULL");
@@ -70,6 +108,23 @@ util::StatusOr<std::string> JwtMacSetWrapper::ComputeMacAndEncode(
 util::StatusOr<crypto::tink::VerifiedJwt> JwtMacSetWrapper::VerifyMacAndDecode(
     absl::string_view compact,
     const crypto::tink::JwtValidator& validator) const {
+  std::string kid;
+  if (jwt_internal::GetKeyIdFromHeader(compact.substr(0, compact.find('.')),
+                                       &kid)) {
+    const EntriesByKid& entries_by_kid = this->entries_by_kid();
+    auto it = entries_by_kid.find(kid);
+    if (it != entries_by_kid.end()) {
+      for (const auto* entry : it->second) {
+        auto verified_jwt_or =
+            entry->get_primitive().VerifyMacAndDecode(compact, validator);
+        if (verified_jwt_or.ok()) {
+          return verified_jwt_or;
+        }
+      }
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "verification failed");
+    }
+  }
   auto raw_primitives_result = jwt_mac_set_->get_raw_primitives();
   if (raw_primitives_result.ok()) {
     for (auto& mac_entry : *(raw_primitives_result.ValueOrDie())) {
@@ -89,6 +144,7 @@ util::StatusOr<std::unique_ptr<JwtMac>> JwtMacWrapper::Wrap(
     std::unique_ptr<PrimitiveSet<JwtMac>> jwt_mac_set) const {
   util::Status status = Validate(jwt_mac_set.get());
   if (!status.ok()) return status;
+  jwt_mac_set->Freeze();
   std::unique_ptr<JwtMac> jwt_mac(new JwtMacSetWrapper(std::move(jwt_mac_set)));
   return std::move(jwt_mac);
 }
@@ -0,0 +1,134 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/jwt/internal/jwt_verification_cache.h"
+
+#include <algorithm>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/time/clock.h"
+#include "openssl/sha.h"
+
+namespace crypto {
+namespace tink {
+namespace jwt_internal {
+
+namespace {
+
+std::string TokenDigest(absl::string_view compact) {
+  std::string digest(SHA256_DIGEST_LENGTH, '\0');
+  SHA256(reinterpret_cast<const uint8_t*>(compact.data()), compact.size(),
+         reinterpret_cast<uint8_t*>(&digest[0]));
+  return digest;
+}
+
+class CachingJwtMac : public JwtMac {
+ public:
+  CachingJwtMac(std::unique_ptr<JwtMac> jwt_mac,
+                const JwtVerificationCache::Options& options)
+      : jwt_mac_(std::move(jwt_mac)), cache_(options) {}
+
+  crypto::tink::util::StatusOr<std::string> ComputeMacAndEncode(
+      const RawJwt& token) const override {
+    return jwt_mac_->ComputeMacAndEncode(token);
+  }
+
+  crypto::tink::util::StatusOr<VerifiedJwt> VerifyMacAndDecode(
+      absl::string_view compact,
+      const JwtValidator& validator) const override {
+    return cache_.Verify(
+        compact, validator,
+        [this](absl::string_view compact, const JwtValidator& validator) {
+          return jwt_mac_->VerifyMacAndDecode(compact, validator);
+        });
+  }
+
+ private:
+  std::unique_ptr<JwtMac> jwt_mac_;
+  JwtVerificationCache cache_;
+};
+
+class CachingJwtPublicKeyVerify : public JwtPublicKeyVerify {
+ public:
+  CachingJwtPublicKeyVerify(std::unique_ptr<JwtPublicKeyVerify> jwt_verify,
+                            const JwtVerificationCache::Options& options)
+      : jwt_verify_(std::move(jwt_verify)), cache_(options) {}
+
+  crypto::tink::util::StatusOr<VerifiedJwt> VerifyMacAndDecode(
+      absl::string_view token, const JwtValidator& validator) const override {
+    return cache_.Verify(
+        token, validator,
+        [this](absl::string_view token, const JwtValidator& validator) {
+          return jwt_verify_->VerifyMacAndDecode(token, validator);
+        });
+  }
+
+ private:
+  std::unique_ptr<JwtPublicKeyVerify> jwt_verify_;
+  JwtVerificationCache cache_;
+};
+
+}  // namespace
+
+absl::optional<util::StatusOr<VerifiedJwt>> JwtVerificationCache::Lookup(
+    absl::string_view compact, const JwtValidator& validator) const {
+  if (options_.max_entries <= 0) {
+    return absl::nullopt;
+  }
+  RawJwt raw_jwt;
+  if (!tokens_.Lookup(TokenDigest(compact), &raw_jwt)) {
+    return absl::nullopt;
+  }
+  util::Status validate_result = validator.Validate(raw_jwt);
+  if (!validate_result.ok()) {
+    return util::StatusOr<VerifiedJwt>(validate_result);
+  }
+  return util::StatusOr<VerifiedJwt>(VerifiedJwt(std::move(raw_jwt)));
+}
+
+void JwtVerificationCache::Insert(absl::string_view compact,
+                                  const VerifiedJwt& verified_jwt) const {
+  if (options_.max_entries <= 0) {
+    return;
+  }
+  absl::Time expiration = absl::Now() + options_.max_ttl;
+  if (verified_jwt.HasExpiration()) {
+    util::StatusOr<absl::Time> exp_or = verified_jwt.GetExpiration();
+    if (!exp_or.ok()) {
+      return;
+    }
+    expiration = std::min(expiration, exp_or.ValueOrDie());
+  }
+  tokens_.Insert(TokenDigest(compact), verified_jwt.raw_jwt_, expiration);
+}
+
+std::unique_ptr<JwtMac> NewCachingJwtMac(
+    std::unique_ptr<JwtMac> jwt_mac,
+    const JwtVerificationCache::Options& options) {
+  return absl::make_unique<CachingJwtMac>(std::move(jwt_mac), options);
+}
+
+std::unique_ptr<JwtPublicKeyVerify> NewCachingJwtPublicKeyVerify(
+    std::unique_ptr<JwtPublicKeyVerify> jwt_verify,
+    const JwtVerificationCache::Options& options) {
+  return absl::make_unique<CachingJwtPublicKeyVerify>(std::move(jwt_verify),
+                                                      options);
+}
+
+}  // namespace jwt_internal
+}  // namespace tink
+}  // namespace crypto
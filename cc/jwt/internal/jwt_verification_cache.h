@@ -0,0 +1,107 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_JWT_INTERNAL_JWT_VERIFICATION_CACHE_H_
+#define TINK_JWT_INTERNAL_JWT_VERIFICATION_CACHE_H_
+
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "absl/types/optional.h"
+#include "tink/internal/digest_lru_cache.h"
+#include "tink/jwt/jwt_mac.h"
+#include "tink/jwt/jwt_public_key_verify.h"
+#include "tink/jwt/jwt_validator.h"
+#include "tink/jwt/raw_jwt.h"
+#include "tink/jwt/verified_jwt.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace jwt_internal {
+
+// A bounded cache of successfully verified tokens, indexed by the SHA-256
+// digest of their compact serialization. Digests are compared in constant
+// time.
+//
+// Only the result of the cryptographic verification and of the decoding is
+// cached: on every hit the cached token is validated again, so that time
+// based claims (exp, nbf, iat) and the rules of the given validator are
+// always checked. An entry is never kept past the expiration of its token.
+//
+// This class is thread-safe.
+class JwtVerificationCache {
+ public:
+  struct Options {
+    // The maximal number of cached tokens. The least recently used token is
+    // dropped when a new one is added to a full cache.
+    int max_entries = 1024;
+    // The maximal time a token is cached, regardless of its expiration.
+    absl::Duration max_ttl = absl::Minutes(5);
+  };
+
+  explicit JwtVerificationCache(const Options& options)
+      : options_(options), tokens_(options.max_entries) {}
+
+  // Returns absl::nullopt if 'compact' is not cached. Otherwise returns the
+  // cached token validated against 'validator'.
+  absl::optional<crypto::tink::util::StatusOr<VerifiedJwt>> Lookup(
+      absl::string_view compact, const JwtValidator& validator) const;
+
+  // Caches 'verified_jwt' as the result of verifying 'compact'.
+  void Insert(absl::string_view compact, const VerifiedJwt& verified_jwt) const;
+
+  // Returns the verification of 'compact' by 'verify', using the cache.
+  template <typename VerifyFunction>
+  crypto::tink::util::StatusOr<VerifiedJwt> Verify(
+      absl::string_view compact, const JwtValidator& validator,
+      VerifyFunction verify) const {
+    auto cached = Lookup(compact, validator);
+    if (cached.has_value()) {
+      return *std::move(cached);
+    }
+    crypto::tink::util::StatusOr<VerifiedJwt> verified_jwt_or =
+        verify(compact, validator);
+    if (verified_jwt_or.ok()) {
+      Insert(compact, verified_jwt_or.ValueOrDie());
+    }
+    return verified_jwt_or;
+  }
+
+ private:
+  const Options options_;
+  internal::DigestLruCache<RawJwt> tokens_;
+};
+
+// Returns a JwtMac which behaves like 'jwt_mac', but keeps the tokens it
+// verified successfully in a JwtVerificationCache with the given 'options'.
+std::unique_ptr<JwtMac> NewCachingJwtMac(
+    std::unique_ptr<JwtMac> jwt_mac,
+    const JwtVerificationCache::Options& options);
+
+// Returns a JwtPublicKeyVerify which behaves like 'jwt_verify', but keeps the
+// tokens it verified successfully in a JwtVerificationCache with the given
+// 'options'.
+std::unique_ptr<JwtPublicKeyVerify> NewCachingJwtPublicKeyVerify(
+    std::unique_ptr<JwtPublicKeyVerify> jwt_verify,
+    const JwtVerificationCache::Options& options);
+
+}  // namespace jwt_internal
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_JWT_INTERNAL_JWT_VERIFICATION_CACHE_H_
@@ -0,0 +1,193 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/jwt/internal/jwt_verification_cache.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/escaping.h"
+#include "absl/time/clock.h"
+#include "tink/jwt/internal/jwt_mac_impl.h"
+#include "tink/jwt/jwt_mac.h"
+#include "tink/jwt/jwt_validator.h"
+#include "tink/jwt/raw_jwt.h"
+#include "tink/jwt/verified_jwt.h"
+#include "tink/subtle/hmac_boringssl.h"
+#include "tink/util/enums.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/test_matchers.h"
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+
+namespace crypto {
+namespace tink {
+namespace jwt_internal {
+
+namespace {
+
+// Forwards to a JwtMacImpl and counts the calls to VerifyMacAndDecode().
+class CountingJwtMac : public JwtMac {
+ public:
+  CountingJwtMac(std::unique_ptr<JwtMac> jwt_mac, int* verify_calls)
+      : jwt_mac_(std::move(jwt_mac)), verify_calls_(verify_calls) {}
+
+  util::StatusOr<std::string> ComputeMacAndEncode(
+      const RawJwt& token) const override {
+    return jwt_mac_->ComputeMacAndEncode(token);
+  }
+
+  util::StatusOr<VerifiedJwt> VerifyMacAndDecode(
+      absl::string_view compact,
+      const JwtValidator& validator) const override {
+    ++*verify_calls_;
+    return jwt_mac_->VerifyMacAndDecode(compact, validator);
+  }
+
+ private:
+  std::unique_ptr<JwtMac> jwt_mac_;
+  int* verify_calls_;
+};
+
+std::unique_ptr<JwtMac> CreateCachingJwtMac(
+    int* verify_calls, const JwtVerificationCache::Options& options) {
+  std::string key_value;
+  EXPECT_TRUE(absl::WebSafeBase64Unescape(
+      "AyM1SysPpbyDfgZld3umj1qzKObwVMkoqQ-EstJQLr_T-1"
+      "qS0gZH75aKtMN3Yj0iPS4hcgUuTwjAzZr1Z9CAow",
+      &key_value));
+  auto mac_or = subtle::HmacBoringSsl::New(
+      util::Enums::ProtoToSubtle(google::crypto::tink::HashType::SHA256), 32,
+      util::SecretDataFromStringView(key_value));
+  EXPECT_THAT(mac_or.status(), IsOk());
+  return NewCachingJwtMac(
+      absl::make_unique<CountingJwtMac>(
+          absl::make_unique<JwtMacImpl>(std::move(mac_or.ValueOrDie()),
+                                        "HS256"),
+          verify_calls),
+      options);
+}
+
+std::string CreateToken(const JwtMac& jwt_mac, absl::string_view issuer,
+                        absl::Time expiration) {
+  auto raw_jwt_or =
+      RawJwtBuilder().SetIssuer(issuer).SetExpiration(expiration).Build();
+  EXPECT_THAT(raw_jwt_or.status(), IsOk());
+  auto compact_or = jwt_mac.ComputeMacAndEncode(raw_jwt_or.ValueOrDie());
+  EXPECT_THAT(compact_or.status(), IsOk());
+  return compact_or.ValueOrDie();
+}
+
+TEST(JwtVerificationCacheTest, RepeatedVerificationIsCached) {
+  int verify_calls = 0;
+  std::unique_ptr<JwtMac> jwt_mac =
+      CreateCachingJwtMac(&verify_calls, JwtVerificationCache::Options());
+  std::string compact =
+      CreateToken(*jwt_mac, "issuer", absl::Now() + absl::Seconds(300));
+  JwtValidator validator = JwtValidatorBuilder().Build();
+
+  for (int i = 0; i < 3; ++i) {
+    util::StatusOr<VerifiedJwt> verified_jwt_or =
+        jwt_mac->VerifyMacAndDecode(compact, validator);
+    ASSERT_THAT(verified_jwt_or.status(), IsOk());
+    EXPECT_THAT(verified_jwt_or.ValueOrDie().GetIssuer(),
+                IsOkAndHolds("issuer"));
+  }
+  EXPECT_EQ(verify_calls, 1);
+}
+
+TEST(JwtVerificationCacheTest, CachedTokenIsValidatedAgain) {
+  int verify_calls = 0;
+  std::unique_ptr<JwtMac> jwt_mac =
+      CreateCachingJwtMac(&verify_calls, JwtVerificationCache::Options());
+  absl::Time expiration = absl::Now() + absl::Seconds(300);
+  std::string compact = CreateToken(*jwt_mac, "issuer", expiration);
+
+  ASSERT_THAT(jwt_mac
+                  ->VerifyMacAndDecode(compact, JwtValidatorBuilder().Build())
+                  .status(),
+              IsOk());
+  EXPECT_FALSE(
+      jwt_mac
+          ->VerifyMacAndDecode(compact,
+                               JwtValidatorBuilder().SetIssuer("other").Build())
+          .ok());
+  EXPECT_FALSE(jwt_mac
+                   ->VerifyMacAndDecode(
+                       compact, JwtValidatorBuilder()
+                                    .SetFixedNow(expiration + absl::Seconds(1))
+                                    .Build())
+                   .ok());
+  EXPECT_EQ(verify_calls, 1);
+}
+
+TEST(JwtVerificationCacheTest, InvalidTokenIsNotCached) {
+  int verify_calls = 0;
+  std::unique_ptr<JwtMac> jwt_mac =
+      CreateCachingJwtMac(&verify_calls, JwtVerificationCache::Options());
+  std::string compact =
+      CreateToken(*jwt_mac, "issuer", absl::Now() + absl::Seconds(300));
+  compact.back() = compact.back() == 'A' ? 'B' : 'A';
+  JwtValidator validator = JwtValidatorBuilder().Build();
+
+  EXPECT_FALSE(jwt_mac->VerifyMacAndDecode(compact, validator).ok());
+  EXPECT_FALSE(jwt_mac->VerifyMacAndDecode(compact, validator).ok());
+  EXPECT_EQ(verify_calls, 2);
+}
+
+TEST(JwtVerificationCacheTest, LeastRecentlyUsedTokenIsDropped) {
+  int verify_calls = 0;
+  JwtVerificationCache::Options options;
+  options.max_entries = 1;
+  std::unique_ptr<JwtMac> jwt_mac = CreateCachingJwtMac(&verify_calls, options);
+  absl::Time expiration = absl::Now() + absl::Seconds(300);
+  std::string compact1 = CreateToken(*jwt_mac, "issuer1", expiration);
+  std::string compact2 = CreateToken(*jwt_mac, "issuer2", expiration);
+  JwtValidator validator = JwtValidatorBuilder().Build();
+
+  EXPECT_THAT(jwt_mac->VerifyMacAndDecode(compact1, validator).status(),
+              IsOk());
+  EXPECT_THAT(jwt_mac->VerifyMacAndDecode(compact2, validator).status(),
+              IsOk());
+  EXPECT_THAT(jwt_mac->VerifyMacAndDecode(compact1, validator).status(),
+              IsOk());
+  EXPECT_EQ(verify_calls, 3);
+}
+
+TEST(JwtVerificationCacheTest, ZeroEntriesDisablesCache) {
+  int verify_calls = 0;
+  JwtVerificationCache::Options options;
+  options.max_entries = 0;
+  std::unique_ptr<JwtMac> jwt_mac = CreateCachingJwtMac(&verify_calls, options);
+  std::string compact =
+      CreateToken(*jwt_mac, "issuer", absl::Now() + absl::Seconds(300));
+  JwtValidator validator = JwtValidatorBuilder().Build();
+
+  EXPECT_THAT(jwt_mac->VerifyMacAndDecode(compact, validator).status(),
+              IsOk());
+  EXPECT_THAT(jwt_mac->VerifyMacAndDecode(compact, validator).status(),
+              IsOk());
+  EXPECT_EQ(verify_calls, 2);
+}
+
+}  // namespace
+}  // namespace jwt_internal
+}  // namespace tink
+}  // namespace crypto
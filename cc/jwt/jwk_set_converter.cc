@@ -0,0 +1,156 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/jwt/jwk_set_converter.h"
+
+#include <memory>
+#include <string>
+
+#include "google/protobuf/struct.pb.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/cleartext_keyset_handle.h"
+#include "tink/jwt/internal/json_util.h"
+#include "tink/jwt/internal/jwt_format.h"
+#include "tink/util/keyset_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/common.pb.h"
+#include "proto/jwt_hmac.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+using ::google::crypto::tink::HashType;
+using ::google::crypto::tink::JwtHmacKey;
+using ::google::crypto::tink::KeyData;
+using ::google::crypto::tink::Keyset;
+using ::google::crypto::tink::KeyStatusType;
+using ::google::crypto::tink::OutputPrefixType;
+using ::google::protobuf::Struct;
+using ::google::protobuf::Value;
+
+constexpr char kJwtHmacKeyTypeUrl[] =
+    "type.googleapis.com/google.crypto.tink.JwtHmacKey";
+
+// Returns the string member 'name' of 'key', or an error if it is missing
+// or not a string.
+util::StatusOr<std::string> GetString(const Struct& key,
+                                      absl::string_view name) {
+  auto it = key.fields().find(std::string(name));
+  if (it == key.fields().end()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        absl::StrCat("JWK is missing ", name));
+  }
+  if (it->second.kind_case() != Value::kStringValue) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        absl::StrCat("JWK ", name, " is not a string"));
+  }
+  return it->second.string_value();
+}
+
+util::StatusOr<JwtHmacKey> ToJwtHmacKey(const Struct& jwk) {
+  auto kty_or = GetString(jwk, "kty");
+  if (!kty_or.ok()) return kty_or.status();
+  if (kty_or.ValueOrDie() != "oct") {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "only JWKs with kty oct are supported");
+  }
+  if (jwk.fields().count("use") > 0) {
+    auto use_or = GetString(jwk, "use");
+    if (!use_or.ok()) return use_or.status();
+    if (use_or.ValueOrDie() != "sig") {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "JWK use must be sig");
+    }
+  }
+  JwtHmacKey key;
+  auto alg_or = GetString(jwk, "alg");
+  if (!alg_or.ok()) return alg_or.status();
+  const std::string& alg = alg_or.ValueOrDie();
+  if (alg == "HS256") {
+    key.set_hash_type(HashType::SHA256);
+  } else if (alg == "HS384") {
+    key.set_hash_type(HashType::SHA384);
+  } else if (alg == "HS512") {
+    key.set_hash_type(HashType::SHA512);
+  } else {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        absl::StrCat("unsupported JWK alg ", alg));
+  }
+  auto k_or = GetString(jwk, "k");
+  if (!k_or.ok()) return k_or.status();
+  const std::string& k = k_or.ValueOrDie();
+  std::string key_value(jwt_internal::Base64UrlMaxDecodedSize(k.size()), '\0');
+  size_t key_size;
+  if (!jwt_internal::Base64UrlDecode(k, &key_value[0], &key_size)) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid JWK k");
+  }
+  key_value.resize(key_size);
+  key.set_key_value(key_value);
+  if (jwk.fields().count("kid") > 0) {
+    auto kid_or = GetString(jwk, "kid");
+    if (!kid_or.ok()) return kid_or.status();
+    key.mutable_custom_kid()->set_value(kid_or.ValueOrDie());
+  }
+  return key;
+}
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<KeysetHandle>> JwkSetToKeysetHandle(
+    absl::string_view jwk_set) {
+  auto jwk_set_or = JsonStringToProtoStruct(jwk_set);
+  if (!jwk_set_or.ok()) return jwk_set_or.status();
+  const auto& fields = jwk_set_or.ValueOrDie().fields();
+  auto keys_it = fields.find("keys");
+  if (keys_it == fields.end() ||
+      keys_it->second.kind_case() != Value::kListValue) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "JWK set has no list of keys");
+  }
+  const auto& jwks = keys_it->second.list_value().values();
+  if (jwks.empty()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "JWK set is empty");
+  }
+
+  Keyset keyset;
+  for (const Value& jwk : jwks) {
+    if (jwk.kind_case() != Value::kStructValue) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "JWK is not an object");
+    }
+    auto key_or = ToJwtHmacKey(jwk.struct_value());
+    if (!key_or.ok()) return key_or.status();
+    uint32_t key_id = GenerateUnusedKeyId(keyset);
+    Keyset::Key* key = keyset.add_key();
+    key->set_key_id(key_id);
+    key->set_status(KeyStatusType::ENABLED);
+    key->set_output_prefix_type(OutputPrefixType::RAW);
+    KeyData* key_data = key->mutable_key_data();
+    key_data->set_type_url(kJwtHmacKeyTypeUrl);
+    key_data->set_key_material_type(KeyData::SYMMETRIC);
+    key_or.ValueOrDie().SerializeToString(key_data->mutable_value());
+    if (keyset.key_size() == 1) keyset.set_primary_key_id(key_id);
+  }
+  return CleartextKeysetHandle::GetKeysetHandle(keyset);
+}
+
+}  // namespace tink
+}  // namespace crypto
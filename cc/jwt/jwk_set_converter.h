@@ -0,0 +1,46 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_JWT_JWK_SET_CONVERTER_H_
+#define TINK_JWT_JWK_SET_CONVERTER_H_
+
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "tink/keyset_handle.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+// Converts a JWK set (RFC 7517) of symmetric keys into a keyset handle
+// whose JwtMac primitive computes and verifies JWTs with these keys.
+//
+// Every key must have "kty" "oct", an "alg" of "HS256", "HS384" or "HS512"
+// and its value in "k"; "use", if present, must be "sig". The "kid" of a key
+// is kept: tokens computed with the key carry it in their header, and
+// tokens whose header names it are verified with that key only, instead of
+// trying every key of the set. The first key of the set is the primary.
+//
+// The key material is imported in cleartext, so the JWK set should come
+// from a trusted source, like a keyset read with CleartextKeysetHandle.
+crypto::tink::util::StatusOr<std::unique_ptr<KeysetHandle>>
+JwkSetToKeysetHandle(absl::string_view jwk_set);
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_JWT_JWK_SET_CONVERTER_H_
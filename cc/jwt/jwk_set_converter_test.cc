@@ -0,0 +1,130 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/jwt/jwk_set_converter.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "tink/jwt/internal/jwt_format.h"
+#include "tink/jwt/jwt_mac.h"
+#include "tink/jwt/jwt_mac_config.h"
+#include "tink/jwt/jwt_validator.h"
+#include "tink/jwt/raw_jwt.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+
+constexpr char kKey1[] =
+    R"({"kty":"oct","alg":"HS256","kid":"key-1","use":"sig",)"
+    R"("k":"AyM1SysPpbyDfgZld3umj1qzKObwVMkoqQ-EstJQLr_T-1qS0gZH75aKtMN3Yj0iPS4hcgUuTwjAzZr1Z9CAow"})";
+constexpr char kKey2[] =
+    R"({"kty":"oct","alg":"HS512","kid":"key-2",)"
+    R"("k":"c2VjcmV0IGtleSB2YWx1ZSBvZiBhdCBsZWFzdCB0aGlydHkgdHdvIGJ5dGVz"})";
+constexpr char kKeyWithoutKid[] =
+    R"({"kty":"oct","alg":"HS256",)"
+    R"("k":"YW5vdGhlciBzZWNyZXQga2V5IG9mIHRoaXJ0eSB0d28gYnl0ZXM"})";
+
+class JwkSetConverterTest : public ::testing::Test {
+ protected:
+  void SetUp() override { ASSERT_THAT(JwtMacRegister(), IsOk()); }
+
+  // Returns the JwtMac of a JWK set with the given keys.
+  static std::unique_ptr<JwtMac> GetJwtMac(absl::string_view keys) {
+    auto handle_or = JwkSetToKeysetHandle(absl::StrCat(R"({"keys":[)", keys,
+                                                       "]}"));
+    EXPECT_THAT(handle_or.status(), IsOk());
+    auto jwt_mac_or = handle_or.ValueOrDie()->GetPrimitive<JwtMac>();
+    EXPECT_THAT(jwt_mac_or.status(), IsOk());
+    return std::move(jwt_mac_or.ValueOrDie());
+  }
+
+  static std::string ComputeToken(const JwtMac& jwt_mac) {
+    RawJwt raw_jwt = RawJwtBuilder().SetIssuer("issuer").Build().ValueOrDie();
+    return jwt_mac.ComputeMacAndEncode(raw_jwt).ValueOrDie();
+  }
+};
+
+TEST_F(JwkSetConverterTest, ComputeAndVerifyWithKid) {
+  std::unique_ptr<JwtMac> jwt_mac =
+      GetJwtMac(absl::StrCat(kKey1, ",", kKey2, ",", kKeyWithoutKid));
+  JwtValidator validator = JwtValidatorBuilder().Build();
+
+  // The first key is the primary, and its kid is in the header.
+  std::string token = ComputeToken(*jwt_mac);
+  std::string kid;
+  ASSERT_TRUE(jwt_internal::GetKeyIdFromHeader(
+      token.substr(0, token.find('.')), &kid));
+  EXPECT_EQ(kid, "key-1");
+  EXPECT_THAT(jwt_mac->VerifyMacAndDecode(token, validator).status(), IsOk());
+
+  // Tokens of the other keys verify too.
+  std::string token2 = ComputeToken(*GetJwtMac(kKey2));
+  EXPECT_THAT(jwt_mac->VerifyMacAndDecode(token2, validator).status(),
+              IsOk());
+  std::string token3 = ComputeToken(*GetJwtMac(kKeyWithoutKid));
+  EXPECT_FALSE(jwt_internal::GetKeyIdFromHeader(
+      token3.substr(0, token3.find('.')), &kid));
+  EXPECT_THAT(jwt_mac->VerifyMacAndDecode(token3, validator).status(),
+              IsOk());
+
+  EXPECT_FALSE(GetJwtMac(kKeyWithoutKid)
+                   ->VerifyMacAndDecode(token2, validator)
+                   .ok());
+}
+
+TEST_F(JwkSetConverterTest, KidSelectsTheKey) {
+  // A token of the key without kid, relabeled with the kid of another key,
+  // is only tried with that key.
+  std::string key_with_wrong_kid = absl::StrCat(
+      R"({"kty":"oct","alg":"HS256","kid":"key-1",)",
+      R"("k":"YW5vdGhlciBzZWNyZXQga2V5IG9mIHRoaXJ0eSB0d28gYnl0ZXM"})");
+  std::string token = ComputeToken(*GetJwtMac(key_with_wrong_kid));
+  std::unique_ptr<JwtMac> jwt_mac =
+      GetJwtMac(absl::StrCat(kKey1, ",", kKeyWithoutKid));
+  EXPECT_FALSE(
+      jwt_mac->VerifyMacAndDecode(token, JwtValidatorBuilder().Build()).ok());
+}
+
+TEST_F(JwkSetConverterTest, InvalidJwkSets) {
+  for (const std::string& jwk_set : std::vector<std::string>{
+           "not json",
+           "{}",
+           R"({"keys":[]})",
+           R"({"keys":"abc"})",
+           R"({"keys":["abc"]})",
+           R"({"keys":[{"kty":"RSA","alg":"HS256","k":"YWJj"}]})",
+           R"({"keys":[{"kty":"oct","alg":"RS256","k":"YWJj"}]})",
+           R"({"keys":[{"kty":"oct","k":"YWJj"}]})",
+           R"({"keys":[{"kty":"oct","alg":"HS256"}]})",
+           R"({"keys":[{"kty":"oct","alg":"HS256","k":"YW=="}]})",
+           R"({"keys":[{"kty":"oct","alg":"HS256","k":"YWJj","use":"enc"}]})",
+           R"({"keys":[{"kty":"oct","alg":"HS256","k":"YWJj","kid":1}]})",
+       }) {
+    EXPECT_FALSE(JwkSetToKeysetHandle(jwk_set).ok()) << jwk_set;
+  }
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -14,6 +14,9 @@
 
 #include "tink/jwt/jwt_validator.h"
 
+#include "google/protobuf/struct.pb.h"
+#include "tink/jwt/jwt_names.h"
+
 namespace crypto {
 namespace tink {
 
@@ -42,73 +45,106 @@ JwtValidator::JwtValidator(absl::optional<absl::string_view> issuer,
 }
 
 util::Status JwtValidator::Validate(RawJwt const& raw_jwt) const {
+  // Finds the registered claims in one pass over the claims of the token,
+  // and compares them in place, so that a valid token is checked without
+  // copying any claim or allocating any memory.
+  const google::protobuf::Value* expiration = nullptr;
+  const google::protobuf::Value* not_before = nullptr;
+  const google::protobuf::Value* issuer = nullptr;
+  const google::protobuf::Value* subject = nullptr;
+  const google::protobuf::Value* audiences = nullptr;
+  for (const auto& field : raw_jwt.json_proto_.fields()) {
+    absl::string_view name = field.first;
+    if (name == kJwtClaimExpiration) {
+      expiration = &field.second;
+    } else if (name == kJwtClaimNotBefore) {
+      not_before = &field.second;
+    } else if (name == kJwtClaimIssuer) {
+      issuer = &field.second;
+    } else if (name == kJwtClaimSubject) {
+      subject = &field.second;
+    } else if (name == kJwtClaimAudience) {
+      audiences = &field.second;
+    }
+  }
+
   absl::Time now;
   if (fixed_now_.has_value()) {
     now = fixed_now_.value();
   } else {
     now = absl::Now();
   }
-  if (raw_jwt.HasExpiration()) {
-    auto expiration_or = raw_jwt.GetExpiration();
-    if (!expiration_or.ok()) {
-      return expiration_or.status();
+  if (expiration != nullptr) {
+    if (expiration->kind_case() != google::protobuf::Value::kNumberValue) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Expiration is not a number");
     }
-    if (expiration_or.ValueOrDie() < now - clock_skew_) {
+    if (absl::FromUnixSeconds(expiration->number_value()) <
+        now - clock_skew_) {
       return util::Status(util::error::INVALID_ARGUMENT, "token has expired");
     }
   }
-  if (raw_jwt.HasNotBefore()) {
-    auto not_before_or = raw_jwt.GetNotBefore();
-    if (!not_before_or.ok()) {
-      return not_before_or.status();
+  if (not_before != nullptr) {
+    if (not_before->kind_case() != google::protobuf::Value::kNumberValue) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "NotBefore is not a number");
     }
-    if (not_before_or.ValueOrDie() > now + clock_skew_) {
+    if (absl::FromUnixSeconds(not_before->number_value()) >
+        now + clock_skew_) {
       return util::Status(util::error::INVALID_ARGUMENT,
                         "token cannot yet be used");
     }
   }
   if (issuer_.has_value()){
-    if (!raw_jwt.HasIssuer()) {
+    if (issuer == nullptr) {
       return util::Status(util::error::INVALID_ARGUMENT,
                           "missing expected issuer");
     }
-    auto issuer_or = raw_jwt.GetIssuer();
-    if (!issuer_or.ok()) {
-      return issuer_or.status();
+    if (issuer->kind_case() != google::protobuf::Value::kStringValue) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Issuer is not a string");
     }
-    if (issuer_.value() != issuer_or.ValueOrDie()) {
+    if (issuer_.value() != issuer->string_value()) {
       return util::Status(util::error::INVALID_ARGUMENT, "wrong issuer");
     }
   }
   if (subject_.has_value()) {
-    if (!raw_jwt.HasSubject()) {
+    if (subject == nullptr) {
       return util::Status(util::error::INVALID_ARGUMENT,
                           "missing expected subject");
     }
-    auto subject_or = raw_jwt.GetSubject();
-    if (!subject_or.ok()) {
-      return subject_or.status();
+    if (subject->kind_case() != google::protobuf::Value::kStringValue) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Subject is not a string");
     }
-    if (subject_.value() != subject_or.ValueOrDie()) {
+    if (subject_.value() != subject->string_value()) {
       return util::Status(util::error::INVALID_ARGUMENT, "wrong subject");
     }
   }
   if (audience_.has_value()) {
-    if (!raw_jwt.HasAudiences()) {
+    if (audiences == nullptr) {
       return util::Status(util::error::INVALID_ARGUMENT,
                           "missing expected audiences");
     }
-    auto audiences_or = raw_jwt.GetAudiences();
-    if (!audiences_or.ok()) {
-      return audiences_or.status();
+    if (audiences->kind_case() != google::protobuf::Value::kListValue) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Audiences is not a list");
+    }
+    bool found = false;
+    for (const auto& value : audiences->list_value().values()) {
+      if (value.kind_case() != google::protobuf::Value::kStringValue) {
+        return util::Status(util::error::INVALID_ARGUMENT,
+                            "Audiences is not a list of strings");
+      }
+      if (value.string_value() == audience_.value()) {
+        found = true;
+      }
     }
-    std::vector<std::string> audiences = audiences_or.ValueOrDie();
-    auto it = std::find(audiences.begin(), audiences.end(), audience_);
-    if (it == audiences.end()) {
+    if (!found) {
       return util::Status(util::error::INVALID_ARGUMENT, "audience not found");
     }
   } else {
-    if (raw_jwt.HasAudiences()) {
+    if (audiences != nullptr) {
       return util::Status(
           util::error::INVALID_ARGUMENT,
           "invalid JWT; token has audience set, but validator not");
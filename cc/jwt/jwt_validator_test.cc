@@ -284,6 +284,30 @@ TEST(JwtValidator, FixedNowValidOk) {
 }
 
 
+TEST(JwtValidator, ClaimsOfWrongTypeNotOk) {
+  JwtValidator validator = JwtValidatorBuilder()
+                               .SetIssuer("issuer")
+                               .SetSubject("subject")
+                               .SetAudience("audience")
+                               .Build();
+  util::StatusOr<RawJwt> valid_or = RawJwt::FromString(
+      R"({"iss":"issuer","sub":"subject","aud":["other","audience"]})");
+  ASSERT_THAT(valid_or.status(), IsOk());
+  EXPECT_THAT(validator.Validate(valid_or.ValueOrDie()), IsOk());
+
+  for (absl::string_view json :
+       {R"({"iss":1,"sub":"subject","aud":["audience"]})",
+        R"({"iss":"issuer","sub":true,"aud":["audience"]})",
+        R"({"iss":"issuer","sub":"subject","aud":"audience"})",
+        R"({"iss":"issuer","sub":"subject","aud":["audience",1]})",
+        R"({"iss":"issuer","sub":"subject","aud":["audience"],"exp":"0"})",
+        R"({"iss":"issuer","sub":"subject","aud":["audience"],"nbf":"0"})"}) {
+    util::StatusOr<RawJwt> jwt_or = RawJwt::FromString(json);
+    ASSERT_THAT(jwt_or.status(), IsOk());
+    EXPECT_FALSE(validator.Validate(jwt_or.ValueOrDie()).ok()) << json;
+  }
+}
+
 TEST(JwtValidator, CallBuildTwiceOk) {
   JwtValidatorBuilder builder = JwtValidatorBuilder();
 
@@ -48,7 +48,7 @@ bool hasClaimOfKind(const google::protobuf::Struct& json_proto,
   if (IsRegisteredClaimName(name)) {
     return false;
   }
-  auto fields = json_proto.fields();
+  const auto& fields = json_proto.fields();
   auto it = fields.find(std::string(name));
   if (it == fields.end()) {
     return false;
@@ -64,7 +64,7 @@ util::StatusOr<RawJwt> RawJwt::FromString(absl::string_view json_string) {
   if (!proto_or.ok()) {
     return proto_or.status();
   }
-  RawJwt token(proto_or.ValueOrDie());
+  RawJwt token(std::move(proto_or.ValueOrDie()));
   return token;
 }
 
@@ -75,7 +75,7 @@ util::StatusOr<std::string> RawJwt::ToString() const {
 RawJwt::RawJwt() {}
 
 RawJwt::RawJwt(google::protobuf::Struct json_proto) {
-  json_proto_ = json_proto;
+  json_proto_ = std::move(json_proto);
 }
 
 bool RawJwt::HasIssuer() const {
@@ -83,7 +83,7 @@ bool RawJwt::HasIssuer() const {
 }
 
 util::StatusOr<std::string> RawJwt::GetIssuer() const {
-  auto fields = json_proto_.fields();
+  const auto& fields = json_proto_.fields();
   auto it = fields.find(std::string(kJwtClaimIssuer));
   if (it == fields.end()) {
     return util::Status(util::error::INVALID_ARGUMENT, "No Issuer found");
@@ -101,7 +101,7 @@ bool RawJwt::HasSubject() const {
 }
 
 util::StatusOr<std::string> RawJwt::GetSubject() const {
-  auto fields = json_proto_.fields();
+  const auto& fields = json_proto_.fields();
   auto it = fields.find(std::string(kJwtClaimSubject));
   if (it == fields.end()) {
     return util::Status(util::error::INVALID_ARGUMENT, "No Subject found");
@@ -119,12 +119,12 @@ bool RawJwt::HasAudiences() const {
 }
 
 util::StatusOr<std::vector<std::string>> RawJwt::GetAudiences() const {
-  auto fields = json_proto_.fields();
+  const auto& fields = json_proto_.fields();
   auto it = fields.find(std::string(kJwtClaimAudience));
   if (it == fields.end()) {
     return util::Status(util::error::NOT_FOUND, "No Audiences found");
   }
-  auto list = it->second;
+  const auto& list = it->second;
   if (list.kind_case() != google::protobuf::Value::kListValue) {
     return util::Status(util::error::INVALID_ARGUMENT,
                         "Audiences is not a list");
@@ -147,7 +147,7 @@ bool RawJwt::HasJwtId() const {
 }
 
 util::StatusOr<std::string> RawJwt::GetJwtId() const {
-  auto fields = json_proto_.fields();
+  const auto& fields = json_proto_.fields();
   auto it = fields.find(std::string(kJwtClaimJwtId));
   if (it == fields.end()) {
     return util::Status(util::error::NOT_FOUND, "No JwtId found");
@@ -164,7 +164,7 @@ bool RawJwt::HasExpiration() const {
 }
 
 util::StatusOr<absl::Time> RawJwt::GetExpiration() const {
-  auto fields = json_proto_.fields();
+  const auto& fields = json_proto_.fields();
   auto it = fields.find(std::string(kJwtClaimExpiration));
   if (it == fields.end()) {
     return util::Status(util::error::NOT_FOUND, "No Expiration found");
@@ -183,7 +183,7 @@ bool RawJwt::HasNotBefore() const {
 }
 
 util::StatusOr<absl::Time> RawJwt::GetNotBefore() const {
-  auto fields = json_proto_.fields();
+  const auto& fields = json_proto_.fields();
   auto it = fields.find(std::string(kJwtClaimNotBefore));
   if (it == fields.end()) {
     return util::Status(util::error::NOT_FOUND, "No NotBefore found");
@@ -202,7 +202,7 @@ bool RawJwt::HasIssuedAt() const {
 }
 
 util::StatusOr<absl::Time> RawJwt::GetIssuedAt() const {
-  auto fields = json_proto_.fields();
+  const auto& fields = json_proto_.fields();
   auto it = fields.find(std::string(kJwtClaimIssuedAt));
   if (it == fields.end()) {
     return util::Status(util::error::NOT_FOUND, "No IssuedAt found");
@@ -230,7 +230,7 @@ util::StatusOr<bool> RawJwt::GetBooleanClaim(
   if (!status.ok()) {
     return status;
   }
-  auto fields = json_proto_.fields();
+  const auto& fields = json_proto_.fields();
   auto it = fields.find(std::string(name));
   if (it == fields.end()) {
     return util::Status(util::error::NOT_FOUND,
@@ -255,7 +255,7 @@ util::StatusOr<std::string> RawJwt::GetStringClaim(
   if (!status.ok()) {
     return status;
   }
-  auto fields = json_proto_.fields();
+  const auto& fields = json_proto_.fields();
   auto it = fields.find(std::string(name));
   if (it == fields.end()) {
     return util::Status(util::error::NOT_FOUND,
@@ -279,7 +279,7 @@ util::StatusOr<double> RawJwt::GetNumberClaim(absl::string_view name) const {
   if (!status.ok()) {
     return status;
   }
-  auto fields = json_proto_.fields();
+  const auto& fields = json_proto_.fields();
   auto it = fields.find(std::string(name));
   if (it == fields.end()) {
     return util::Status(util::error::NOT_FOUND,
@@ -304,7 +304,7 @@ util::StatusOr<std::string> RawJwt::GetJsonObjectClaim(
   if (!status.ok()) {
     return status;
   }
-  auto fields = json_proto_.fields();
+  const auto& fields = json_proto_.fields();
   auto it = fields.find(std::string(name));
   if (it == fields.end()) {
     return util::Status(util::error::NOT_FOUND,
@@ -330,7 +330,7 @@ util::StatusOr<std::string> RawJwt::GetJsonArrayClaim(
   if (!status.ok()) {
     return status;
   }
-  auto fields = json_proto_.fields();
+  const auto& fields = json_proto_.fields();
   auto it = fields.find(std::string(name));
   if (it == fields.end()) {
     return util::Status(util::error::NOT_FOUND,
@@ -346,7 +346,7 @@ util::StatusOr<std::string> RawJwt::GetJsonArrayClaim(
 }
 
 std::vector<std::string> RawJwt::CustomClaimNames() const {
-  auto fields = json_proto_.fields();
+  const auto& fields = json_proto_.fields();
   std::vector<std::string> values;
   for (auto it = fields.begin(); it != fields.end(); it++) {
     if (!IsRegisteredClaimName(it->first)) {
@@ -73,6 +73,7 @@ class RawJwt {
  private:
   explicit RawJwt(google::protobuf::Struct json_proto);
   friend class RawJwtBuilder;
+  friend class JwtValidator;
   google::protobuf::Struct json_proto_;
 };
 
@@ -25,9 +25,7 @@ namespace tink {
 
 VerifiedJwt::VerifiedJwt() {}
 
-VerifiedJwt::VerifiedJwt(const RawJwt& raw_jwt) {
-  raw_jwt_ = raw_jwt;
-}
+VerifiedJwt::VerifiedJwt(RawJwt raw_jwt) : raw_jwt_(std::move(raw_jwt)) {}
 
 bool VerifiedJwt::HasIssuer() const {
   return raw_jwt_.HasIssuer();
@@ -30,6 +30,7 @@ namespace jwt_internal {
 
 // For friend declaration
 class JwtMacImpl;
+class JwtVerificationCache;
 
 }
 
@@ -77,8 +78,9 @@ class VerifiedJwt {
 
  private:
   VerifiedJwt();
-  explicit VerifiedJwt(const RawJwt& raw_jwt);
+  explicit VerifiedJwt(RawJwt raw_jwt);
   friend class jwt_internal::JwtMacImpl;
+  friend class jwt_internal::JwtVerificationCache;
   RawJwt raw_jwt_;
 };
 
@@ -0,0 +1,115 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_KEY_POOL_H_
+#define TINK_KEY_POOL_H_
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/executor.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// KeyPool generates keys ahead of time on background threads, so that
+// KeysetHandle::GenerateNew() and KeysetManager do not have to wait for
+// the generation of keys that are expensive to generate (e.g. RSA keys).
+//
+// For every template passed to AddTemplate() the pool keeps a small stock
+// of fresh keys, which it refills whenever a key is taken.  Every key is
+// handed out exactly once.  The keys still in stock when the pool is
+// destroyed are zeroized.
+//
+// Instances of this class are thread safe.
+class KeyPool {
+ public:
+  // Returns a pool that generates keys on 'num_threads' threads, and keeps
+  // up to 'stock_size' keys per template.
+  static crypto::tink::util::StatusOr<std::unique_ptr<KeyPool>> New(
+      int num_threads, int stock_size);
+
+  // Like New() above, but generates the keys on the shared 'executor',
+  // which must run its tasks on worker threads of its own.
+  static crypto::tink::util::StatusOr<std::unique_ptr<KeyPool>> New(
+      std::shared_ptr<Executor> executor, int stock_size);
+
+  // Stops the generation of keys, and zeroizes the keys in stock.
+  ~KeyPool();
+
+  KeyPool(const KeyPool&) = delete;
+  KeyPool& operator=(const KeyPool&) = delete;
+
+  // Starts keeping a stock of keys generated according to 'key_template'.
+  // Templates that differ only in the output prefix type share the stock.
+  // If the keys cannot be generated (e.g. the key type is not registered),
+  // the stock stays empty, and NewKeyData() returns the error.
+  void AddTemplate(const google::crypto::tink::KeyTemplate& key_template)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Returns a fresh key generated according to 'key_template': one from
+  // the stock if there is one, and otherwise one generated on the calling
+  // thread, like Registry::NewKeyData().
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
+  NewKeyData(const google::crypto::tink::KeyTemplate& key_template)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Returns the number of keys in stock for 'key_template'.
+  int StockSize(const google::crypto::tink::KeyTemplate& key_template) const
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+ private:
+  // The keys of one template, and the number of keys being generated.
+  struct Stock {
+    google::crypto::tink::KeyTemplate key_template;
+    std::deque<std::unique_ptr<google::crypto::tink::KeyData>> keys;
+    int pending = 0;
+  };
+
+  KeyPool(std::shared_ptr<Executor> executor, int stock_size);
+
+  bool NoTasksRunning() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return running_tasks_ == 0;
+  }
+
+  // Schedules the generation of as many keys as 'stock' lacks.
+  void Refill(const std::string& id, Stock* stock)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Generates one key for the stock with the given 'id'.
+  void Generate(const std::string& id) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  const int stock_size_;
+  mutable absl::Mutex mutex_;
+  bool shutdown_ ABSL_GUARDED_BY(mutex_) = false;
+  std::map<std::string, Stock> stocks_ ABSL_GUARDED_BY(mutex_);
+  // The number of Generate() tasks scheduled and not finished yet, which
+  // the destructor waits for, as the executor may outlive the pool.
+  int running_tasks_ ABSL_GUARDED_BY(mutex_) = 0;
+  std::shared_ptr<Executor> executor_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_KEY_POOL_H_
@@ -17,19 +17,39 @@
 #ifndef TINK_KEYSET_HANDLE_H_
 #define TINK_KEYSET_HANDLE_H_
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <typeindex>
+#include <vector>
+
 #include "absl/base/attributes.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
 #include "tink/aead.h"
+#include "tink/executor.h"
 #include "tink/internal/key_info.h"
+#include "tink/internal/traced_operation.h"
+#include "tink/internal/warm_up.h"
 #include "tink/key_manager.h"
 #include "tink/keyset_reader.h"
 #include "tink/keyset_writer.h"
+#include "tink/primitive_intern_table.h"
 #include "tink/primitive_set.h"
 #include "tink/registry.h"
+#include "tink/util/errors.h"
 #include "proto/tink.pb.h"
 
 namespace crypto {
 namespace tink {
 
+class EncryptedKeysetCache;
+class KeyPool;
+
 // KeysetHandle provides abstracted access to Keysets, to limit
 // the exposure of actual protocol buffers that hold sensitive
 // key material.
@@ -40,6 +60,13 @@ class KeysetHandle {
   static crypto::tink::util::StatusOr<std::unique_ptr<KeysetHandle>> Read(
       std::unique_ptr<KeysetReader> reader, const Aead& master_key_aead);
 
+  // Like Read(reader, master_key_aead), but looks the decrypted keyset up
+  // in |cache| first, and adds it to |cache| after a decryption, so that
+  // reading the same encrypted keyset again does not use |master_key_aead|.
+  static crypto::tink::util::StatusOr<std::unique_ptr<KeysetHandle>> Read(
+      std::unique_ptr<KeysetReader> reader, const Aead& master_key_aead,
+      EncryptedKeysetCache* cache);
+
   // Creates a KeysetHandle from a keyset which contains no secret key material.
   // This can be used to load public keysets or envelope encryption keysets.
   static crypto::tink::util::StatusOr<std::unique_ptr<KeysetHandle>>
@@ -50,6 +77,24 @@ class KeysetHandle {
   static crypto::tink::util::StatusOr<std::unique_ptr<KeysetHandle>>
   GenerateNew(const google::crypto::tink::KeyTemplate& key_template);
 
+  // Like GenerateNew(key_template), but takes the key from |key_pool|,
+  // which saves the wait for the generation of the key if |key_pool| keeps
+  // a stock of keys for |key_template|.
+  static crypto::tink::util::StatusOr<std::unique_ptr<KeysetHandle>>
+  GenerateNew(const google::crypto::tink::KeyTemplate& key_template,
+              KeyPool* key_pool);
+
+  // Returns |count| new KeysetHandles, each of which contains a single fresh
+  // key generated according to |key_template|, e.g. for provisioning many
+  // tenants at once.  Cheaper than |count| calls to GenerateNew(): the key
+  // manager is looked up once, the key ids are drawn from the random number
+  // generator at once and, if |executor| is non-null, the keys are
+  // generated on its threads.
+  static crypto::tink::util::StatusOr<
+      std::vector<std::unique_ptr<KeysetHandle>>>
+  GenerateNewBatch(const google::crypto::tink::KeyTemplate& key_template,
+                   int count, std::shared_ptr<Executor> executor = nullptr);
+
   // Encrypts the underlying keyset with the provided |master_key_aead|
   // and writes the resulting EncryptedKeyset to the given |writer|,
   // which must be non-null.
@@ -60,6 +105,11 @@ class KeysetHandle {
   // key material, thus can be used for logging or monitoring.
   google::crypto::tink::KeysetInfo GetKeysetInfo() const;
 
+  // Returns an estimate of the number of bytes held by this handle, i.e.
+  // mostly by its copy of the keyset. The primitives created from it are
+  // not included; use SpaceUsed(*primitive) (cf. space_used.h) for them.
+  size_t EstimateMemoryUsage() const;
+
   // Writes the underlying keyset to |writer| only if the keyset does not
   // contain any secret key material.
   // This can be used to persist public keysets or envelope encryption keysets.
@@ -80,6 +130,52 @@ class KeysetHandle {
   template <class P>
   crypto::tink::util::StatusOr<std::unique_ptr<P>> GetPrimitive() const;
 
+  // Like GetPrimitive(), but the primitive is only created by the first call
+  // for a given P; later calls return the same instance, which must therefore
+  // be used in a thread-safe way (as all Tink primitives are). Key managers
+  // registered after the first call are not taken into account.
+  //
+  // The cache belongs to the keyset: a handle obtained from
+  // KeysetManager::GetKeysetHandle() after modifying the keyset starts with
+  // an empty cache, while copies of a handle share it.
+  template <class P>
+  crypto::tink::util::StatusOr<std::shared_ptr<P>> GetSharedPrimitive() const;
+
+  // Options for GetPrimitive(const LoadingOptions&).
+  struct LoadingOptions {
+    // The number of threads which create the primitives of the keys; the
+    // calling thread is one of them. Useful for keysets with many keys whose
+    // primitives are expensive to create (e.g. RSA keys).
+    int parallelism = 1;
+    // If true, only the primitive of the primary key is created right away.
+    // The primitives of the other keys are created the first time a
+    // ciphertext, tag or signature refers to them, and a key whose primitive
+    // cannot be created then behaves as if it was not in the keyset. Meant
+    // for decrypting and verifying large keysets, most of whose keys are
+    // rarely used. 'parallelism' has no effect in this mode.
+    bool lazy = false;
+    // If non-null, the primitives of the keys are taken from this table, so
+    // that keys which are also in other keysets loaded with the same table
+    // share a single primitive (see PrimitiveInternTable). Primitives
+    // created lazily are not shared.
+    PrimitiveInternTable* intern_table = nullptr;
+    // If true, the primitives of all keys are created right away, even if
+    // 'lazy' is set, and each one runs an operation on empty inputs (e.g.
+    // an encryption and a decryption), so that the first request of a key
+    // does not pay for its one-time work. Loading fails if any of these
+    // operations fails. Primitives which need an input of a peer (e.g.
+    // PublicKeyVerify) are only created.
+    bool warm_up = false;
+  };
+
+  // Like GetPrimitive(), but creates the primitives of the keys as
+  // specified by 'options'. With the default options this is equivalent to
+  // GetPrimitive(), except that the registry's legacy primitive wrapper is
+  // used.
+  template <class P>
+  crypto::tink::util::StatusOr<std::unique_ptr<P>> GetPrimitive(
+      const LoadingOptions& options) const;
+
   // Creates a wrapped primitive corresponding to this keyset. Uses the given
   // KeyManager, as well as the KeyManager and PrimitiveWrapper objects in the
   // global registry to create the primitive. The given KeyManager is used for
@@ -94,6 +190,10 @@ class KeysetHandle {
   friend class CleartextKeysetHandle;
   friend class KeysetManager;
   friend class RegistryImpl;
+  template <class P>
+  friend class PrimitiveHandle;
+  template <class P>
+  friend class RefreshablePrimitive;
 
   // TestKeysetHandle::GetKeyset() provides access to get_keyset().
   friend class TestKeysetHandle;
@@ -103,12 +203,13 @@ class KeysetHandle {
   // Creates a handle that contains the given keyset.
   explicit KeysetHandle(std::unique_ptr<google::crypto::tink::Keyset> keyset);
 
-  // Helper function which generates a key from a template, then adds it
-  // to the keyset. TODO(tholenst): Change this to a proper member operating
-  // on the internal keyset.
+  // Helper function which generates a key from a template (or takes it from
+  // 'key_pool', if non-null), then adds it to the keyset.
+  // TODO(tholenst): Change this to a proper member operating on the
+  // internal keyset.
   static crypto::tink::util::StatusOr<uint32_t> AddToKeyset(
       const google::crypto::tink::KeyTemplate& key_template, bool as_primary,
-      google::crypto::tink::Keyset* keyset);
+      KeyPool* key_pool, google::crypto::tink::Keyset* keyset);
 
   // Returns keyset held by this handle.
   const google::crypto::tink::Keyset& get_keyset() const;
@@ -124,7 +225,21 @@ class KeysetHandle {
   crypto::tink::util::StatusOr<std::unique_ptr<PrimitiveSet<P>>> GetPrimitives(
       const KeyManager<P>* custom_manager) const;
 
+  // Like GetPrimitives(nullptr), but creates the primitives as specified by
+  // 'options'.
+  template <class P>
+  crypto::tink::util::StatusOr<std::unique_ptr<PrimitiveSet<P>>> GetPrimitives(
+      const LoadingOptions& options) const;
+
+  // Primitives created by GetSharedPrimitive(), indexed by primitive type.
+  struct PrimitiveCache {
+    absl::Mutex mutex;
+    absl::flat_hash_map<std::type_index, std::shared_ptr<void>> primitives
+        ABSL_GUARDED_BY(mutex);
+  };
+
   google::crypto::tink::Keyset keyset_;
+  std::shared_ptr<PrimitiveCache> primitive_cache_;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -162,10 +277,148 @@ KeysetHandle::GetPrimitives(const KeyManager<P>* custom_manager) const {
   return std::move(primitives);
 }
 
+template <class P>
+crypto::tink::util::StatusOr<std::unique_ptr<PrimitiveSet<P>>>
+KeysetHandle::GetPrimitives(const LoadingOptions& options) const {
+  crypto::tink::util::Status status = ValidateKeyset(get_keyset());
+  if (!status.ok()) return status;
+  std::vector<const google::crypto::tink::Keyset::Key*> keys;
+  for (const google::crypto::tink::Keyset::Key& key : get_keyset().key()) {
+    if (key.status() == google::crypto::tink::KeyStatusType::ENABLED) {
+      keys.push_back(&key);
+    }
+  }
+  const uint32_t primary_key_id = get_keyset().primary_key_id();
+  const bool lazy = options.lazy && !options.warm_up;
+
+  // Creates (and warms up) the primitives of all keys which are not lazy,
+  // each one by the first thread which claims its index.
+  std::vector<std::shared_ptr<P>> primitives(keys.size());
+  std::vector<crypto::tink::util::Status> statuses(keys.size());
+  std::atomic<size_t> next_index(0);
+  auto create_primitives = [&]() {
+    for (size_t i = next_index++; i < keys.size(); i = next_index++) {
+      if (lazy && keys[i]->key_id() != primary_key_id) continue;
+      if (options.intern_table != nullptr) {
+        auto primitive_result =
+            options.intern_table->template GetPrimitive<P>(
+                keys[i]->key_data());
+        if (primitive_result.ok()) {
+          primitives[i] = std::move(primitive_result.ValueOrDie());
+        } else {
+          statuses[i] = primitive_result.status();
+        }
+      } else {
+        auto primitive_result =
+            Registry::GetPrimitive<P>(keys[i]->key_data());
+        if (primitive_result.ok()) {
+          primitives[i] = std::move(primitive_result.ValueOrDie());
+        } else {
+          statuses[i] = primitive_result.status();
+        }
+      }
+      if (options.warm_up && primitives[i] != nullptr) {
+        crypto::tink::util::Status warm_up_status =
+            internal::WarmUpPrimitive(*primitives[i]);
+        if (!warm_up_status.ok()) {
+          statuses[i] = ToStatusF(warm_up_status.CanonicalCode(),
+                                  "Warm-up of key %d failed: %s",
+                                  keys[i]->key_id(),
+                                  warm_up_status.error_message());
+        }
+      }
+    }
+  };
+  int num_threads = lazy ? 1 : options.parallelism;
+  num_threads =
+      std::max(1, std::min(num_threads, static_cast<int>(keys.size())));
+  std::vector<std::thread> workers;
+  for (int i = 1; i < num_threads; i++) {
+    workers.emplace_back(create_primitives);
+  }
+  create_primitives();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  // Fills the set in keyset order, so that the first failure is reported as
+  // with GetPrimitives(nullptr).
+  auto primitive_set = absl::make_unique<PrimitiveSet<P>>();
+  primitive_set->Reserve(keys.size()).IgnoreError();
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (!statuses[i].ok()) return statuses[i];
+    crypto::tink::util::StatusOr<typename PrimitiveSet<P>::template Entry<P>*>
+        entry_result;
+    if (primitives[i] != nullptr) {
+      entry_result = primitive_set->AddSharedPrimitive(
+          std::move(primitives[i]), KeyInfoFromKey(*keys[i]));
+    } else {
+      google::crypto::tink::KeyData key_data = keys[i]->key_data();
+      entry_result = primitive_set->AddLazyPrimitive(
+          [key_data]() { return Registry::GetPrimitive<P>(key_data); },
+          KeyInfoFromKey(*keys[i]));
+    }
+    if (!entry_result.ok()) return entry_result.status();
+    if (keys[i]->key_id() == primary_key_id) {
+      auto primary_result =
+          primitive_set->set_primary(entry_result.ValueOrDie());
+      if (!primary_result.ok()) return primary_result;
+    }
+  }
+  return std::move(primitive_set);
+}
+
 template <class P>
 crypto::tink::util::StatusOr<std::unique_ptr<P>> KeysetHandle::GetPrimitive()
     const {
-  return internal::RegistryImpl::GlobalInstance().WrapKeyset<P>(keyset_);
+  internal::TracedOperation operation("tink.keyset_handle.get_primitive");
+  operation.SetAttribute("tink.num_keys", keyset_.key_size());
+  operation.SetAttribute("tink.primary_key_id", keyset_.primary_key_id());
+  auto primitive_result =
+      internal::RegistryImpl::GlobalInstance().WrapKeyset<P>(keyset_);
+  operation.SetStatus(primitive_result.status());
+  return primitive_result;
+}
+
+template <class P>
+crypto::tink::util::StatusOr<std::shared_ptr<P>>
+KeysetHandle::GetSharedPrimitive() const {
+  const std::type_index type(typeid(P));
+  {
+    absl::MutexLock lock(&primitive_cache_->mutex);
+    auto it = primitive_cache_->primitives.find(type);
+    if (it != primitive_cache_->primitives.end()) {
+      return std::static_pointer_cast<P>(it->second);
+    }
+  }
+  // Create the primitive without holding the lock; if another thread was
+  // faster, its primitive is kept and ours is dropped.
+  auto primitive_result = GetPrimitive<P>();
+  if (!primitive_result.ok()) return primitive_result.status();
+  std::shared_ptr<P> primitive = std::move(primitive_result.ValueOrDie());
+  absl::MutexLock lock(&primitive_cache_->mutex);
+  auto it = primitive_cache_->primitives.emplace(type, primitive).first;
+  return std::static_pointer_cast<P>(it->second);
+}
+
+template <class P>
+crypto::tink::util::StatusOr<std::unique_ptr<P>> KeysetHandle::GetPrimitive(
+    const LoadingOptions& options) const {
+  internal::TracedOperation operation("tink.keyset_handle.get_primitive");
+  operation.SetAttribute("tink.num_keys", keyset_.key_size());
+  operation.SetAttribute("tink.primary_key_id", keyset_.primary_key_id());
+  operation.SetAttribute("tink.parallelism", options.parallelism);
+  operation.SetAttribute("tink.lazy", options.lazy);
+  operation.SetAttribute("tink.warm_up", options.warm_up);
+  auto primitives_result = GetPrimitives<P>(options);
+  if (!primitives_result.ok()) {
+    operation.SetStatus(primitives_result.status());
+    return primitives_result.status();
+  }
+  auto primitive_result =
+      Registry::Wrap<P>(std::move(primitives_result.ValueOrDie()));
+  operation.SetStatus(primitive_result.status());
+  return primitive_result;
 }
 
 template <class P>
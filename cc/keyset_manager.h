@@ -16,6 +16,10 @@
 #ifndef TINK_KEYSET_MANAGER_H_
 #define TINK_KEYSET_MANAGER_H_
 
+#include <cstdint>
+#include <map>
+#include <vector>
+
 #include "absl/base/thread_annotations.h"
 #include "absl/synchronization/mutex.h"
 #include "tink/util/status.h"
@@ -25,6 +29,7 @@
 namespace crypto {
 namespace tink {
 
+class KeyPool;
 class KeysetHandle;
 
 // KeysetManager provides convenience methods for creation of Keysets, and for
@@ -33,9 +38,23 @@ class KeysetHandle;
 // accessed via GetKeysetHandle()-method.
 class KeysetManager {
  public:
+  // The result of Compact().
+  struct CompactionReport {
+    // The ids of the enabled keys, other than the primary, which were not
+    // used, in keyset order.
+    std::vector<uint32_t> unused_key_ids;
+    // The ids of the keys which Compact() disabled; empty unless
+    // 'disable_unused' was set.
+    std::vector<uint32_t> disabled_key_ids;
+  };
+
   // Constructs a KeysetManager with an empty Keyset.
   KeysetManager() {}
 
+  // Constructs a KeysetManager with an empty Keyset, which takes the keys
+  // it adds from 'key_pool'. The pool must outlive the KeysetManager.
+  explicit KeysetManager(KeyPool* key_pool) : key_pool_(key_pool) {}
+
   // Creates a new KeysetManager that contains a Keyset with a single key
   // generated freshly according the specification in 'key_template'.
   static crypto::tink::util::StatusOr<std::unique_ptr<KeysetManager>> New(
@@ -92,6 +111,20 @@ class KeysetManager {
   crypto::tink::util::Status SetPrimary(uint32_t key_id)
       ABSL_LOCKS_EXCLUDED(keyset_mutex_);
 
+  // Compacts the keyset according to 'usage', the number of operations per
+  // key id over some window, e.g. the decryptions counted by
+  // MonitoringStatsClient::KeyUsage().  Keys missing from 'usage' were not
+  // used.
+  //
+  // Reorders the keys so that enabled keys come first, by decreasing
+  // usage, as wrappers try keys with the same prefix, e.g. the RAW keys,
+  // in keyset order.  Reports the enabled keys other than the primary
+  // which were not used and, if 'disable_unused' is set, disables them,
+  // so that primitive sets built from the keyset leave them out.
+  CompactionReport Compact(const std::map<uint32_t, int64_t>& usage,
+                           bool disable_unused)
+      ABSL_LOCKS_EXCLUDED(keyset_mutex_);
+
   // Returns the count of all keys in the keyset.
   int KeyCount() const;
 
@@ -104,6 +137,7 @@ class KeysetManager {
       const google::crypto::tink::KeyTemplate& key_template, bool as_primary)
       ABSL_LOCKS_EXCLUDED(keyset_mutex_);
 
+  KeyPool* const key_pool_ = nullptr;
   mutable absl::Mutex keyset_mutex_;
   google::crypto::tink::Keyset keyset_ ABSL_GUARDED_BY(keyset_mutex_);
 };
@@ -19,6 +19,8 @@
 
 #include "absl/strings/string_view.h"
 #include "tink/aead.h"
+#include "tink/async_aead.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -26,6 +28,12 @@ namespace tink {
 
 // KmsClient knows how to produce primitives backed by keys stored
 // in remote KMS services.
+//
+// The connections of a client (e.g. gRPC channels, HTTP connection pools)
+// are generally not usable in the child of a fork().  Processes which fork
+// after unwrapping their keysets need no client in the children; children
+// which call the KMS themselves create their clients, or reconnect them in
+// a hook of util::AddPostForkChildHook().
 class KmsClient {
  public:
   // Returns true iff this client does support KMS key specified by 'key_uri'.
@@ -36,6 +44,17 @@ class KmsClient {
   virtual crypto::tink::util::StatusOr<std::unique_ptr<Aead>>
   GetAead(absl::string_view key_uri) const = 0;
 
+  // Returns an AsyncAead-primitive backed by KMS key specified by 'key_uri',
+  // which lets callers have many requests to the KMS in flight at once.
+  // Returns an UNIMPLEMENTED error if this KmsClient does not support
+  // asynchronous requests.
+  virtual crypto::tink::util::StatusOr<std::unique_ptr<AsyncAead>>
+  GetAsyncAead(absl::string_view key_uri) const {
+    return crypto::tink::util::Status(
+        crypto::tink::util::error::UNIMPLEMENTED,
+        "GetAsyncAead() is not supported by this KmsClient");
+  }
+
   virtual ~KmsClient() {}
 };
 
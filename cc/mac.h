@@ -17,7 +17,14 @@
 #ifndef TINK_MAC_H_
 #define TINK_MAC_H_
 
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/util/inlined_buffer.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
@@ -40,6 +47,82 @@ class Mac {
       absl::string_view mac_value,
       absl::string_view data) const = 0;
 
+  // Computes the MAC of 'data' as ComputeMac() does, but writes it into the
+  // beginning of 'tag' and returns its size.  Fails with INVALID_ARGUMENT if
+  // 'tag' is too small.
+  //
+  // The default implementation calls ComputeMac() and copies the result;
+  // implementations override it to compute the MAC without allocating.
+  virtual crypto::tink::util::StatusOr<int64_t> ComputeMacInto(
+      absl::string_view data, absl::Span<uint8_t> tag) const;
+
+  // Computes the MAC of 'data' as ComputeMac() does, but returns it in
+  // '*mac', so that MACs of up to N bytes need no heap allocation.  Uses
+  // ComputeMacInto(), and copies the result of ComputeMac() if the MAC does
+  // not fit into N bytes.
+  template <size_t N>
+  crypto::tink::util::Status ComputeMac(
+      absl::string_view data, crypto::tink::util::InlinedBuffer<N>* mac) const {
+    mac->resize(mac->capacity());
+    auto written_result = ComputeMacInto(
+        data, absl::MakeSpan(reinterpret_cast<uint8_t*>(mac->data()),
+                             mac->size()));
+    if (written_result.ok()) {
+      mac->resize(written_result.ValueOrDie());
+      return crypto::tink::util::Status::OK;
+    }
+    auto mac_result = ComputeMac(data);
+    if (!mac_result.ok()) {
+      mac->clear();
+      return mac_result.status();
+    }
+    mac->assign(mac_result.ValueOrDie());
+    return crypto::tink::util::Status::OK;
+  }
+
+  // Verifies 'mac_value' as VerifyMac() does, for MACs held in byte buffers
+  // such as those written by ComputeMacInto().
+  crypto::tink::util::Status VerifyMac(absl::Span<const uint8_t> mac_value,
+                                       absl::string_view data) const {
+    return VerifyMac(
+        absl::string_view(reinterpret_cast<const char*>(mac_value.data()),
+                          mac_value.size()),
+        data);
+  }
+
+  // Verifies 'mac_value' as VerifyMac() does, but only with the key with id
+  // 'key_id' of the keyset, instead of the keys which may have produced
+  // it.  This is for callers which store the key id next to the MAC, e.g.
+  // to save the prefix of RAW MACs, where VerifyMac() would try all RAW
+  // keys.  'mac_value' starts with the output prefix of the key, if it has
+  // one.  Primitives of keysets implement this; the default implementation
+  // returns UNIMPLEMENTED.
+  virtual crypto::tink::util::Status VerifyMacWithKeyId(
+      absl::string_view mac_value, absl::string_view data,
+      uint32_t key_id) const {
+    return crypto::tink::util::Status(
+        crypto::tink::util::error::UNIMPLEMENTED,
+        "VerifyMacWithKeyId() is not supported by this Mac");
+  }
+
+  // Computes the MAC of every element of 'data', in order.  Either all MACs
+  // are returned or an error is.
+  //
+  // The default implementation calls ComputeMac() for every element;
+  // implementations override it to amortize work across messages.
+  virtual crypto::tink::util::StatusOr<std::vector<std::string>> ComputeMacs(
+      absl::Span<const absl::string_view> data) const;
+
+  // Returns a Mac whose MAC of 'data' is the MAC of 'prefix' + 'data' under
+  // this Mac, for messages which share a long constant prefix. The returned
+  // object may refer to this one, which must outlive it.
+  //
+  // The default implementation keeps a copy of 'prefix' and concatenates
+  // it with every message; implementations override it to process the
+  // prefix only once.
+  virtual crypto::tink::util::StatusOr<std::unique_ptr<Mac>> WithPrefix(
+      absl::string_view prefix) const;
+
   virtual ~Mac() {}
 };
 
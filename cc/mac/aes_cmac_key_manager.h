@@ -22,6 +22,7 @@
 #include "tink/key_manager.h"
 #include "tink/mac.h"
 #include "tink/subtle/aes_cmac_boringssl.h"
+#include "tink/subtle/cpu_features.h"
 #include "tink/subtle/random.h"
 #include "tink/util/constants.h"
 #include "tink/util/errors.h"
@@ -44,6 +45,7 @@ class AesCmacKeyManager
   class MacFactory : public PrimitiveFactory<Mac> {
     crypto::tink::util::StatusOr<std::unique_ptr<Mac>> Create(
         const google::crypto::tink::AesCmacKey& key) const override {
+      subtle::RecordImplementation("AesCmac", "boringssl");
       return subtle::AesCmacBoringSsl::New(
           util::SecretDataFromStringView(key.key_value()),
           key.params().tag_size());
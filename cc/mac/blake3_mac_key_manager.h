@@ -0,0 +1,133 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_MAC_BLAKE3_MAC_KEY_MANAGER_H_
+#define TINK_MAC_BLAKE3_MAC_KEY_MANAGER_H_
+
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/core/key_type_manager.h"
+#include "tink/key_manager.h"
+#include "tink/mac.h"
+#include "tink/subtle/blake3.h"
+#include "tink/subtle/blake3_mac.h"
+#include "tink/subtle/cpu_features.h"
+#include "tink/subtle/random.h"
+#include "tink/util/constants.h"
+#include "tink/util/errors.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/blake3_mac.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+class Blake3MacKeyManager
+    : public KeyTypeManager<google::crypto::tink::Blake3MacKey,
+                            google::crypto::tink::Blake3MacKeyFormat,
+                            List<Mac>> {
+ public:
+  class MacFactory : public PrimitiveFactory<Mac> {
+    crypto::tink::util::StatusOr<std::unique_ptr<Mac>> Create(
+        const google::crypto::tink::Blake3MacKey& key) const override {
+      subtle::RecordImplementation("Blake3",
+                                   subtle::Blake3Hasher::Implementation());
+      return subtle::Blake3Mac::New(
+          util::SecretDataFromStringView(key.key_value()),
+          key.params().tag_size());
+    }
+  };
+
+  Blake3MacKeyManager()
+      : KeyTypeManager(absl::make_unique<Blake3MacKeyManager::MacFactory>()) {}
+
+  uint32_t get_version() const override { return 0; }
+
+  google::crypto::tink::KeyData::KeyMaterialType key_material_type()
+      const override {
+    return google::crypto::tink::KeyData::SYMMETRIC;
+  }
+
+  const std::string& get_key_type() const override { return key_type_; }
+
+  crypto::tink::util::Status ValidateKey(
+      const google::crypto::tink::Blake3MacKey& key) const override {
+    crypto::tink::util::Status status =
+        ValidateVersion(key.version(), get_version());
+    if (!status.ok()) return status;
+    if (key.key_value().size() != subtle::Blake3Hasher::kKeySizeInBytes) {
+      return crypto::tink::util::Status(
+          util::error::INVALID_ARGUMENT,
+          "Invalid Blake3MacKey: key_value wrong length.");
+    }
+    return ValidateParams(key.params());
+  }
+
+  crypto::tink::util::Status ValidateKeyFormat(
+      const google::crypto::tink::Blake3MacKeyFormat& key_format)
+      const override {
+    if (key_format.key_size() != subtle::Blake3Hasher::kKeySizeInBytes) {
+      return crypto::tink::util::Status(
+          crypto::tink::util::error::INVALID_ARGUMENT,
+          "Invalid Blake3MacKeyFormat: invalid key_size.");
+    }
+    return ValidateParams(key_format.params());
+  }
+
+  crypto::tink::util::StatusOr<google::crypto::tink::Blake3MacKey> CreateKey(
+      const google::crypto::tink::Blake3MacKeyFormat& key_format)
+      const override {
+    google::crypto::tink::Blake3MacKey key;
+    key.set_version(get_version());
+    key.set_key_value(subtle::Random::GetRandomBytes(key_format.key_size()));
+    *key.mutable_params() = key_format.params();
+    return key;
+  }
+
+  FipsCompatibility FipsStatus() const override {
+    return FipsCompatibility::kNotFips;
+  }
+
+ private:
+  crypto::tink::util::Status ValidateParams(
+      const google::crypto::tink::Blake3MacParams& params) const {
+    if (params.tag_size() < subtle::Blake3Mac::kMinTagSizeInBytes) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          absl::StrCat("Invalid Blake3MacParams: tag_size ",
+                                       params.tag_size(), " is too small."));
+    }
+    if (params.tag_size() > subtle::Blake3Mac::kMaxTagSizeInBytes) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          absl::StrCat("Invalid Blake3MacParams: tag_size ",
+                                       params.tag_size(), " is too big."));
+    }
+    return util::OkStatus();
+  }
+
+  const std::string key_type_ = absl::StrCat(
+      kTypeGoogleapisCom, google::crypto::tink::Blake3MacKey().GetTypeName());
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_MAC_BLAKE3_MAC_KEY_MANAGER_H_
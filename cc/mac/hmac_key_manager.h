@@ -22,6 +22,7 @@
 #include "absl/strings/str_cat.h"
 #include "tink/core/key_type_manager.h"
 #include "tink/mac.h"
+#include "tink/subtle/cpu_features.h"
 #include "tink/subtle/hmac_boringssl.h"
 #include "tink/util/constants.h"
 #include "tink/util/enums.h"
@@ -43,6 +44,7 @@ class HmacKeyManager
   class MacFactory : public PrimitiveFactory<Mac> {
     crypto::tink::util::StatusOr<std::unique_ptr<Mac>> Create(
         const google::crypto::tink::HmacKey& hmac_key) const override {
+      subtle::RecordImplementation("Hmac", "boringssl");
       return subtle::HmacBoringSsl::New(
           util::Enums::ProtoToSubtle(hmac_key.params().hash()),
           hmac_key.params().tag_size(),
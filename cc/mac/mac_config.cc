@@ -20,6 +20,7 @@
 #include "tink/config/config_util.h"
 #include "tink/config/tink_fips.h"
 #include "tink/mac/aes_cmac_key_manager.h"
+#include "tink/mac/blake3_mac_key_manager.h"
 #include "tink/mac/hmac_key_manager.h"
 #include "tink/mac/mac_wrapper.h"
 #include "tink/registry.h"
@@ -59,6 +60,10 @@ util::Status MacConfig::Register() {
       absl::make_unique<AesCmacKeyManager>(), true);
   if (!status.ok()) return status;
 
+  status = Registry::RegisterKeyTypeManager(
+      absl::make_unique<Blake3MacKeyManager>(), true);
+  if (!status.ok()) return status;
+
   return util::OkStatus();
 }
 
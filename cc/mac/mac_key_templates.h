@@ -73,6 +73,13 @@ class MacKeyTemplates {
   //   - tag size: 16 bytes
   //   - OutputPrefixType: TINK
   static const google::crypto::tink::KeyTemplate& AesCmac();
+
+  // Returns a KeyTemplate that generates new instances of Blake3MacKey
+  // with the following parameters:
+  //   - key size: 32 bytes
+  //   - tag size: 32 bytes
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate& Blake3();
 };
 
 }  // namespace tink
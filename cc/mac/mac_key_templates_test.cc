@@ -20,9 +20,11 @@
 #include "gtest/gtest.h"
 #include "tink/core/key_manager_impl.h"
 #include "tink/mac/aes_cmac_key_manager.h"
+#include "tink/mac/blake3_mac_key_manager.h"
 #include "tink/mac/hmac_key_manager.h"
 #include "tink/util/test_matchers.h"
 #include "proto/aes_cmac.pb.h"
+#include "proto/blake3_mac.pb.h"
 #include "proto/common.pb.h"
 #include "proto/hmac.pb.h"
 #include "proto/tink.pb.h"
@@ -33,6 +35,7 @@ namespace {
 
 using ::crypto::tink::test::IsOk;
 using ::google::crypto::tink::AesCmacKeyFormat;
+using ::google::crypto::tink::Blake3MacKeyFormat;
 using ::google::crypto::tink::HashType;
 using ::google::crypto::tink::HmacKeyFormat;
 using ::google::crypto::tink::KeyTemplate;
@@ -167,6 +170,24 @@ TEST(AesCmac, CheckValues) {
   EXPECT_THAT(key_format.params().tag_size(), Eq(16));
 }
 
+TEST(Blake3, Basics) {
+  EXPECT_THAT(MacKeyTemplates::Blake3().type_url(),
+              Eq("type.googleapis.com/google.crypto.tink.Blake3MacKey"));
+  EXPECT_THAT(MacKeyTemplates::Blake3().type_url(),
+              Eq(Blake3MacKeyManager().get_key_type()));
+  EXPECT_THAT(MacKeyTemplates::Blake3().output_prefix_type(),
+              Eq(OutputPrefixType::TINK));
+  EXPECT_THAT(MacKeyTemplates::Blake3(), Ref(MacKeyTemplates::Blake3()));
+}
+
+TEST(Blake3, WorksWithKeyTypeManager) {
+  Blake3MacKeyFormat key_format;
+  EXPECT_TRUE(key_format.ParseFromString(MacKeyTemplates::Blake3().value()));
+  EXPECT_THAT(Blake3MacKeyManager().ValidateKeyFormat(key_format), IsOk());
+  EXPECT_THAT(key_format.key_size(), Eq(32));
+  EXPECT_THAT(key_format.params().tag_size(), Eq(32));
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
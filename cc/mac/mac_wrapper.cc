@@ -16,10 +16,21 @@
 
 #include "tink/mac/mac_wrapper.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/strip.h"
+#include "absl/types/span.h"
 #include "tink/crypto_format.h"
+#include "tink/internal/monitored_operation.h"
 #include "tink/mac.h"
 #include "tink/primitive_set.h"
+#include "tink/space_used.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -32,10 +43,12 @@ using google::crypto::tink::OutputPrefixType;
 
 namespace {
 
-class MacSetWrapper : public Mac {
+class MacSetWrapper : public Mac, public SpaceUsedInterface {
  public:
-  explicit MacSetWrapper(std::unique_ptr<PrimitiveSet<Mac>> mac_set)
-      : mac_set_(std::move(mac_set)) {}
+  MacSetWrapper(std::unique_ptr<PrimitiveSet<Mac>> mac_set,
+                int max_raw_keys_tried)
+      : mac_set_(std::move(mac_set)),
+        max_raw_keys_tried_(max_raw_keys_tried) {}
 
   crypto::tink::util::StatusOr<std::string> ComputeMac(
       absl::string_view data) const override;
@@ -43,10 +56,51 @@ class MacSetWrapper : public Mac {
   crypto::tink::util::Status VerifyMac(absl::string_view mac_value,
                                        absl::string_view data) const override;
 
+  crypto::tink::util::Status VerifyMacWithKeyId(
+      absl::string_view mac_value, absl::string_view data,
+      uint32_t key_id) const override;
+
+  crypto::tink::util::StatusOr<std::vector<std::string>> ComputeMacs(
+      absl::Span<const absl::string_view> data) const override;
+
+  crypto::tink::util::StatusOr<int64_t> ComputeMacInto(
+      absl::string_view data, absl::Span<uint8_t> tag) const override;
+
+  size_t SpaceUsed() const override {
+    return sizeof(*this) + mac_set_->SpaceUsed();
+  }
+
   ~MacSetWrapper() override {}
 
- private:
+ protected:
   std::unique_ptr<PrimitiveSet<Mac>> mac_set_;
+  const int max_raw_keys_tried_;
+};
+
+// The wrapper of a set with a single key, the primary, as most keysets
+// are between key rotations.  Verification goes straight to the primitive
+// of the key, which is kept at hand with its prefix, instead of looking up
+// the prefix of every MAC in the set.  Only used for keys which are not
+// LEGACY, and which MacSetWrapper would try.
+class SingleKeyMacWrapper : public MacSetWrapper {
+ public:
+  explicit SingleKeyMacWrapper(std::unique_ptr<PrimitiveSet<Mac>> mac_set)
+      : MacSetWrapper(std::move(mac_set), std::numeric_limits<int>::max()),
+        mac_(mac_set_->get_primary()->get_primitive()),
+        prefix_(mac_set_->get_primary()->get_identifier()),
+        key_id_(mac_set_->get_primary()->get_key_id()) {}
+
+  crypto::tink::util::Status VerifyMac(absl::string_view mac_value,
+                                       absl::string_view data) const override;
+
+  size_t SpaceUsed() const override {
+    return sizeof(*this) + mac_set_->SpaceUsed();
+  }
+
+ private:
+  const Mac& mac_;
+  const std::string prefix_;
+  const uint32_t key_id_;
 };
 
 util::Status Validate(PrimitiveSet<Mac>* mac_set) {
@@ -74,10 +128,61 @@ util::StatusOr<std::string> MacSetWrapper::ComputeMac(
         reinterpret_cast<const char*>(&CryptoFormat::kLegacyStartByte), 1);
     data = local_data;
   }
+  internal::MonitoredOperation operation("mac", "compute");
+  operation.KeyTried();
   auto compute_mac_result = primary->get_primitive().ComputeMac(data);
   if (!compute_mac_result.ok()) return compute_mac_result.status();
-  const std::string& key_id = primary->get_identifier();
-  return key_id + compute_mac_result.ValueOrDie();
+  operation.Succeeded(primary->get_key_id());
+  absl::string_view key_id = primary->get_identifier();
+  return absl::StrCat(key_id, compute_mac_result.ValueOrDie());
+}
+
+util::StatusOr<std::vector<std::string>> MacSetWrapper::ComputeMacs(
+    absl::Span<const absl::string_view> data) const {
+  auto primary = mac_set_->get_primary();
+  // LEGACY keys MAC a modified copy of every message; those go one by one.
+  if (primary->get_output_prefix_type() == OutputPrefixType::LEGACY) {
+    return Mac::ComputeMacs(data);
+  }
+  std::vector<absl::string_view> non_null_data;
+  non_null_data.reserve(data.size());
+  for (absl::string_view message : data) {
+    non_null_data.push_back(
+        subtle::SubtleUtilBoringSSL::EnsureNonNull(message));
+  }
+  internal::MonitoredOperation operation("mac", "compute_batch");
+  operation.KeyTried();
+  auto macs_result = primary->get_primitive().ComputeMacs(non_null_data);
+  if (!macs_result.ok()) return macs_result.status();
+  operation.Succeeded(primary->get_key_id());
+  std::vector<std::string> macs = std::move(macs_result.ValueOrDie());
+  absl::string_view key_id = primary->get_identifier();
+  for (std::string& mac : macs) {
+    mac.insert(0, key_id.data(), key_id.size());
+  }
+  return std::move(macs);
+}
+
+util::StatusOr<int64_t> MacSetWrapper::ComputeMacInto(
+    absl::string_view data, absl::Span<uint8_t> tag) const {
+  auto primary = mac_set_->get_primary();
+  // LEGACY keys MAC a modified copy of the message.
+  if (primary->get_output_prefix_type() == OutputPrefixType::LEGACY) {
+    return Mac::ComputeMacInto(data, tag);
+  }
+  data = subtle::SubtleUtilBoringSSL::EnsureNonNull(data);
+  absl::string_view key_id = primary->get_identifier();
+  if (tag.size() < key_id.size()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Tag buffer too small");
+  }
+  internal::MonitoredOperation operation("mac", "compute");
+  operation.KeyTried();
+  auto written_result = primary->get_primitive().ComputeMacInto(
+      data, tag.subspan(key_id.size()));
+  if (!written_result.ok()) return written_result.status();
+  operation.Succeeded(primary->get_key_id());
+  std::copy(key_id.begin(), key_id.end(), tag.begin());
+  return static_cast<int64_t>(key_id.size()) + written_result.ValueOrDie();
 }
 
 util::Status MacSetWrapper::VerifyMac(
@@ -86,6 +191,7 @@ util::Status MacSetWrapper::VerifyMac(
   data = subtle::SubtleUtilBoringSSL::EnsureNonNull(data);
   mac_value = subtle::SubtleUtilBoringSSL::EnsureNonNull(mac_value);
 
+  internal::MonitoredOperation operation("mac", "verify");
   if (mac_value.length() > CryptoFormat::kNonRawPrefixSize) {
     absl::string_view key_id =
         mac_value.substr(0, CryptoFormat::kNonRawPrefixSize);
@@ -93,17 +199,22 @@ util::Status MacSetWrapper::VerifyMac(
     if (primitives_result.ok()) {
       absl::string_view raw_mac_value =
           mac_value.substr(CryptoFormat::kNonRawPrefixSize);
+      // Built at most once, for the first LEGACY entry.
+      std::string legacy_data;
       for (auto& mac_entry : *(primitives_result.ValueOrDie())) {
-        std::string legacy_data;
         absl::string_view view_on_data_or_legacy_data = data;
         if (mac_entry->get_output_prefix_type() == OutputPrefixType::LEGACY) {
-          legacy_data = absl::StrCat(data, std::string("\x00", 1));
+          if (legacy_data.empty()) {
+            legacy_data = absl::StrCat(data, std::string("\x00", 1));
+          }
           view_on_data_or_legacy_data = legacy_data;
         }
         Mac& mac = mac_entry->get_primitive();
+        operation.KeyTried();
         util::Status status =
             mac.VerifyMac(raw_mac_value, view_on_data_or_legacy_data);
         if (status.ok()) {
+          operation.Succeeded(mac_entry->get_key_id());
           return status;
         } else {
           // TODO(przydatek): LOG that a matching key didn't verify the MAC.
@@ -112,13 +223,28 @@ util::Status MacSetWrapper::VerifyMac(
     }
   }
 
-  // No matching key succeeded with verification, try all RAW keys.
+  // No matching key succeeded with verification, try the RAW keys.
   auto raw_primitives_result = mac_set_->get_raw_primitives();
   if (raw_primitives_result.ok()) {
-    for (auto& mac_entry : *(raw_primitives_result.ValueOrDie())) {
+    operation.RawKeysTried();
+    const PrimitiveSet<Mac>::Primitives& raw_entries =
+        *raw_primitives_result.ValueOrDie();
+    size_t first = mac_set_->preferred_index(CryptoFormat::kRawPrefix);
+    int keys_tried = 0;
+    for (size_t i = 0; i < raw_entries.size(); i++) {
+      if (keys_tried == max_raw_keys_tried_) {
+        operation.RawKeyLimitReached();
+        break;
+      }
+      auto& mac_entry =
+          raw_entries[PrimitiveSet<Mac>::AdaptiveOrderIndex(first, i)];
       Mac& mac = mac_entry->get_primitive();
+      operation.KeyTried();
+      keys_tried++;
       util::Status status = mac.VerifyMac(mac_value, data);
       if (status.ok()) {
+        operation.Succeeded(mac_entry->get_key_id());
+        mac_set_->RecordSuccess(mac_entry.get());
         return status;
       }
     }
@@ -126,13 +252,94 @@ util::Status MacSetWrapper::VerifyMac(
   return util::Status(util::error::INVALID_ARGUMENT, "verification failed");
 }
 
+util::Status MacSetWrapper::VerifyMacWithKeyId(absl::string_view mac_value,
+                                              absl::string_view data,
+                                              uint32_t key_id) const {
+  data = subtle::SubtleUtilBoringSSL::EnsureNonNull(data);
+  mac_value = subtle::SubtleUtilBoringSSL::EnsureNonNull(mac_value);
+
+  internal::MonitoredOperation operation("mac", "verify");
+  auto entry_result = mac_set_->get_primitive_by_key_id(key_id);
+  if (!entry_result.ok()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        absl::StrCat("No key with id ", key_id));
+  }
+  const PrimitiveSet<Mac>::Entry<Mac>& entry = *entry_result.ValueOrDie();
+  if (absl::ConsumePrefix(&mac_value, entry.get_identifier())) {
+    std::string legacy_data;
+    if (entry.get_output_prefix_type() == OutputPrefixType::LEGACY) {
+      legacy_data = absl::StrCat(data, std::string("\x00", 1));
+      data = legacy_data;
+    }
+    operation.KeyTried();
+    util::Status status = entry.get_primitive().VerifyMac(mac_value, data);
+    if (status.ok()) {
+      operation.Succeeded(key_id);
+      return status;
+    }
+  }
+  return util::Status(util::error::INVALID_ARGUMENT, "verification failed");
+}
+
+util::Status SingleKeyMacWrapper::VerifyMac(absl::string_view mac_value,
+                                            absl::string_view data) const {
+  data = subtle::SubtleUtilBoringSSL::EnsureNonNull(data);
+  mac_value = subtle::SubtleUtilBoringSSL::EnsureNonNull(mac_value);
+
+  internal::MonitoredOperation operation("mac", "verify");
+  bool matches = true;
+  if (prefix_.empty()) {
+    operation.RawKeysTried();
+  } else {
+    // As in MacSetWrapper, a prefix is only looked for in MACs which are
+    // longer than it.
+    matches = mac_value.length() > CryptoFormat::kNonRawPrefixSize &&
+              absl::ConsumePrefix(&mac_value, prefix_);
+  }
+  if (matches) {
+    operation.KeyTried();
+    util::Status status = mac_.VerifyMac(mac_value, data);
+    if (status.ok()) {
+      operation.Succeeded(key_id_);
+      return status;
+    }
+  }
+  return util::Status(util::error::INVALID_ARGUMENT, "verification failed");
+}
+
 }  // namespace
 
+util::StatusOr<std::unique_ptr<MacWrapper>> MacWrapper::New(
+    int max_raw_keys_tried) {
+  if (max_raw_keys_tried < 1) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("max_raw_keys_tried must be at least 1, got ",
+                     max_raw_keys_tried));
+  }
+  return {absl::WrapUnique(new MacWrapper(max_raw_keys_tried))};
+}
+
 util::StatusOr<std::unique_ptr<Mac>> MacWrapper::Wrap(
       std::unique_ptr<PrimitiveSet<Mac>> mac_set) const {
   util::Status status = Validate(mac_set.get());
   if (!status.ok()) return status;
-  std::unique_ptr<Mac> mac(new MacSetWrapper(std::move(mac_set)));
+  // With a limit, the RAW key which verified last must be tried first, or
+  // valid MACs of keys beyond the limit would always be rejected.
+  if (max_raw_keys_tried_ != std::numeric_limits<int>::max() &&
+      !mac_set->is_adaptive_order()) {
+    status = mac_set->EnableAdaptiveOrder();
+    if (!status.ok()) return status;
+  }
+  mac_set->Freeze();
+  std::unique_ptr<Mac> mac;
+  const auto* primary = mac_set->get_primary();
+  if (mac_set->get_all().size() == 1 &&
+      primary->get_output_prefix_type() != OutputPrefixType::LEGACY) {
+    mac.reset(new SingleKeyMacWrapper(std::move(mac_set)));
+  } else {
+    mac.reset(new MacSetWrapper(std::move(mac_set), max_raw_keys_tried_));
+  }
   return std::move(mac);
 }
 
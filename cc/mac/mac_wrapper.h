@@ -17,6 +17,9 @@
 #ifndef TINK_MAC_MAC_WRAPPER_H_
 #define TINK_MAC_MAC_WRAPPER_H_
 
+#include <limits>
+#include <memory>
+
 #include "absl/strings/string_view.h"
 #include "tink/mac.h"
 #include "tink/primitive_set.h"
@@ -32,11 +35,34 @@ namespace tink {
 // and combines them into a single Mac-primitive, that uses the provided
 // instances, depending on the context:
 //   * Mac::ComputeMac(...) uses the primary instance from the set
-//   * Mac::VerifyMac(...) uses the instance that matches the MAC prefix.
+//   * Mac::VerifyMac(...) uses the instance that matches the MAC prefix,
+//     and falls back to the RAW instances.
+//
+// An invalid MAC is checked against every RAW instance, so with many RAW
+// keys each forged MAC costs many MAC computations.  'max_raw_keys_tried'
+// bounds the number of RAW instances tried per verification.  With a
+// limit, the wrapper enables the adaptive order of the set (cf.
+// PrimitiveSet::EnableAdaptiveOrder()), so that the RAW instance which
+// verified most recently is tried first and the limit rarely rejects valid
+// MACs.  Hitting the limit is reported to the registered MonitoringClient.
 class MacWrapper : public PrimitiveWrapper<Mac, Mac> {
  public:
+  // Creates a wrapper which tries all RAW instances.
+  MacWrapper() : MacWrapper(std::numeric_limits<int>::max()) {}
+
+  // Creates a wrapper which tries at most 'max_raw_keys_tried' RAW instances
+  // per verification; 'max_raw_keys_tried' must be at least 1.
+  static util::StatusOr<std::unique_ptr<MacWrapper>> New(
+      int max_raw_keys_tried);
+
   util::StatusOr<std::unique_ptr<Mac>> Wrap(
       std::unique_ptr<PrimitiveSet<Mac>> mac_set) const override;
+
+ private:
+  explicit MacWrapper(int max_raw_keys_tried)
+      : max_raw_keys_tried_(max_raw_keys_tried) {}
+
+  const int max_raw_keys_tried_;
 };
 
 }  // namespace tink
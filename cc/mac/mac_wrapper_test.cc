@@ -16,18 +16,27 @@
 
 #include "tink/mac/mac_wrapper.h"
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
 #include "tink/crypto_format.h"
 #include "tink/mac.h"
 #include "tink/primitive_set.h"
+#include "tink/util/allocation_counter.h"
+#include "tink/util/inlined_buffer.h"
 #include "tink/util/status.h"
 #include "tink/util/test_matchers.h"
 #include "tink/util/test_util.h"
 #include "proto/tink.pb.h"
 
+using ::crypto::tink::test::AllocationCounter;
 using crypto::tink::test::DummyMac;
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
 using google::crypto::tink::KeysetInfo;
 using google::crypto::tink::KeyStatusType;
 using google::crypto::tink::OutputPrefixType;
@@ -36,6 +45,40 @@ namespace crypto {
 namespace tink {
 namespace {
 
+// A Mac which computes and verifies its MACs without allocating: the "MAC"
+// of any data is the name of the Mac.
+class BufferDummyMac : public Mac {
+ public:
+  explicit BufferDummyMac(absl::string_view mac_name) : mac_name_(mac_name) {}
+
+  util::StatusOr<std::string> ComputeMac(
+      absl::string_view data) const override {
+    return mac_name_;
+  }
+
+  util::Status VerifyMac(absl::string_view mac_value,
+                         absl::string_view data) const override {
+    if (mac_value != mac_name_) {
+      return util::Status(util::error::INVALID_ARGUMENT, "Wrong MAC.");
+    }
+    return util::Status::OK;
+  }
+
+  using Mac::VerifyMac;
+
+  util::StatusOr<int64_t> ComputeMacInto(
+      absl::string_view data, absl::Span<uint8_t> tag) const override {
+    if (tag.size() < mac_name_.size()) {
+      return util::Status(util::error::INVALID_ARGUMENT, "Tag too small.");
+    }
+    std::copy(mac_name_.begin(), mac_name_.end(), tag.begin());
+    return mac_name_.size();
+  }
+
+ private:
+  std::string mac_name_;
+};
+
 TEST(MacWrapperTest, WrapNullptr) {
   auto mac_result = MacWrapper().Wrap(nullptr);
   EXPECT_FALSE(mac_result.ok());
@@ -206,6 +249,291 @@ TEST(MacWrapperTest, VerifyRawAfterLegacy) {
               IsOk());
 }
 
+// Counts the verifications of a DummyMac.
+class CountingMac : public Mac {
+ public:
+  CountingMac(absl::string_view name, int* verifications)
+      : mac_(std::string(name)), verifications_(verifications) {}
+
+  crypto::tink::util::StatusOr<std::string> ComputeMac(
+      absl::string_view data) const override {
+    return mac_.ComputeMac(data);
+  }
+
+  crypto::tink::util::Status VerifyMac(absl::string_view mac,
+                                       absl::string_view data) const override {
+    (*verifications_)++;
+    return mac_.VerifyMac(mac, data);
+  }
+
+ private:
+  DummyMac mac_;
+  int* verifications_;
+};
+
+TEST(MacWrapperTest, RawKeyLimitMustBePositive) {
+  EXPECT_THAT(MacWrapper::New(0).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(MacWrapper::New(-1).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(MacWrapper::New(1).status(), IsOk());
+}
+
+TEST(MacWrapperTest, RawKeyLimitAndOrder) {
+  int verifications = 0;
+  std::unique_ptr<PrimitiveSet<Mac>> mac_set(new PrimitiveSet<Mac>());
+  for (int i = 0; i < 4; i++) {
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(OutputPrefixType::RAW);
+    key_info.set_key_id(100 + i);
+    key_info.set_status(KeyStatusType::ENABLED);
+    auto entry_result = mac_set->AddPrimitive(
+        absl::make_unique<CountingMac>(absl::StrCat("raw", i), &verifications),
+        key_info);
+    ASSERT_THAT(entry_result.status(), IsOk());
+    if (i == 0) {
+      ASSERT_THAT(mac_set->set_primary(entry_result.ValueOrDie()), IsOk());
+    }
+  }
+  auto wrapper_result = MacWrapper::New(2);
+  ASSERT_THAT(wrapper_result.status(), IsOk());
+  auto mac_result = wrapper_result.ValueOrDie()->Wrap(std::move(mac_set));
+  ASSERT_THAT(mac_result.status(), IsOk());
+  std::unique_ptr<Mac> mac = std::move(mac_result.ValueOrDie());
+  std::string data = "data";
+  std::string mac_1 = DummyMac("raw1").ComputeMac(data).ValueOrDie();
+  std::string mac_3 = DummyMac("raw3").ComputeMac(data).ValueOrDie();
+
+  EXPECT_THAT(mac->VerifyMac(mac_1, data), IsOk());
+  EXPECT_EQ(2, verifications);
+
+  // The last three keys are out of reach of the limit.
+  verifications = 0;
+  EXPECT_FALSE(mac->VerifyMac(mac_3, data).ok());
+  EXPECT_EQ(2, verifications);
+  EXPECT_FALSE(mac->VerifyMac("forged", data).ok());
+  EXPECT_EQ(4, verifications);
+
+  // The key which verified last is tried first.
+  verifications = 0;
+  EXPECT_THAT(mac->VerifyMac(mac_1, data), IsOk());
+  EXPECT_EQ(1, verifications);
+
+  // Without a limit all keys are tried in their order in the set.
+  mac_set = absl::make_unique<PrimitiveSet<Mac>>();
+  for (int i = 0; i < 4; i++) {
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(OutputPrefixType::RAW);
+    key_info.set_key_id(100 + i);
+    key_info.set_status(KeyStatusType::ENABLED);
+    auto entry_result = mac_set->AddPrimitive(
+        absl::make_unique<CountingMac>(absl::StrCat("raw", i), &verifications),
+        key_info);
+    ASSERT_THAT(entry_result.status(), IsOk());
+    if (i == 0) {
+      ASSERT_THAT(mac_set->set_primary(entry_result.ValueOrDie()), IsOk());
+    }
+  }
+  mac = std::move(MacWrapper().Wrap(std::move(mac_set)).ValueOrDie());
+  verifications = 0;
+  EXPECT_THAT(mac->VerifyMac(mac_3, data), IsOk());
+  EXPECT_EQ(4, verifications);
+  verifications = 0;
+  EXPECT_THAT(mac->VerifyMac(mac_3, data), IsOk());
+  EXPECT_EQ(4, verifications);
+}
+
+TEST(MacWrapperTest, ComputeMacs) {
+  for (OutputPrefixType prefix_type :
+       {OutputPrefixType::TINK, OutputPrefixType::LEGACY,
+        OutputPrefixType::RAW}) {
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(prefix_type);
+    key_info.set_key_id(1234543);
+    key_info.set_status(KeyStatusType::ENABLED);
+    auto mac_set = absl::make_unique<PrimitiveSet<Mac>>();
+    auto entry_result =
+        mac_set->AddPrimitive(absl::make_unique<DummyMac>("mac"), key_info);
+    ASSERT_THAT(entry_result.status(), IsOk());
+    ASSERT_THAT(mac_set->set_primary(entry_result.ValueOrDie()), IsOk());
+    auto mac_result = MacWrapper().Wrap(std::move(mac_set));
+    ASSERT_THAT(mac_result.status(), IsOk());
+    const Mac& mac = *mac_result.ValueOrDie();
+
+    std::vector<absl::string_view> data = {"", "first", "second"};
+    auto macs_result = mac.ComputeMacs(data);
+    ASSERT_THAT(macs_result.status(), IsOk());
+    ASSERT_EQ(data.size(), macs_result.ValueOrDie().size());
+    for (size_t i = 0; i < data.size(); i++) {
+      const std::string& mac_value = macs_result.ValueOrDie()[i];
+      EXPECT_EQ(mac.ComputeMac(data[i]).ValueOrDie(), mac_value);
+      EXPECT_THAT(mac.VerifyMac(mac_value, data[i]), IsOk());
+    }
+  }
+}
+
+TEST(MacWrapperTest, ComputeMacInto) {
+  for (OutputPrefixType prefix_type :
+       {OutputPrefixType::TINK, OutputPrefixType::LEGACY,
+        OutputPrefixType::RAW}) {
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(prefix_type);
+    key_info.set_key_id(1234543);
+    key_info.set_status(KeyStatusType::ENABLED);
+    auto mac_set = absl::make_unique<PrimitiveSet<Mac>>();
+    auto entry_result =
+        mac_set->AddPrimitive(absl::make_unique<DummyMac>("mac"), key_info);
+    ASSERT_THAT(entry_result.status(), IsOk());
+    ASSERT_THAT(mac_set->set_primary(entry_result.ValueOrDie()), IsOk());
+    auto mac_result = MacWrapper().Wrap(std::move(mac_set));
+    ASSERT_THAT(mac_result.status(), IsOk());
+    const Mac& mac = *mac_result.ValueOrDie();
+
+    std::string expected = mac.ComputeMac("data").ValueOrDie();
+    std::vector<uint8_t> tag(expected.size() + 10, 0);
+    auto written_result = mac.ComputeMacInto("data", absl::MakeSpan(tag));
+    ASSERT_THAT(written_result.status(), IsOk());
+    ASSERT_EQ(expected.size(), written_result.ValueOrDie());
+    EXPECT_EQ(expected, std::string(tag.begin(), tag.begin() + expected.size()));
+    EXPECT_THAT(mac.VerifyMac(absl::MakeConstSpan(tag.data(), expected.size()),
+                              "data"),
+                IsOk());
+
+    EXPECT_THAT(mac.ComputeMacInto(
+                       "data", absl::MakeSpan(tag.data(), expected.size() - 1))
+                    .status(),
+                StatusIs(util::error::INVALID_ARGUMENT));
+  }
+}
+
+TEST(MacWrapperTest, WithPrefix) {
+  for (OutputPrefixType prefix_type :
+       {OutputPrefixType::TINK, OutputPrefixType::LEGACY,
+        OutputPrefixType::RAW}) {
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(prefix_type);
+    key_info.set_key_id(1234543);
+    key_info.set_status(KeyStatusType::ENABLED);
+    auto mac_set = absl::make_unique<PrimitiveSet<Mac>>();
+    auto entry_result =
+        mac_set->AddPrimitive(absl::make_unique<DummyMac>("mac"), key_info);
+    ASSERT_THAT(entry_result.status(), IsOk());
+    ASSERT_THAT(mac_set->set_primary(entry_result.ValueOrDie()), IsOk());
+    auto mac_result = MacWrapper().Wrap(std::move(mac_set));
+    ASSERT_THAT(mac_result.status(), IsOk());
+    const Mac& mac = *mac_result.ValueOrDie();
+
+    auto prefixed_result = mac.WithPrefix("header.");
+    ASSERT_THAT(prefixed_result.status(), IsOk());
+    const Mac& prefixed = *prefixed_result.ValueOrDie();
+    std::string mac_value = prefixed.ComputeMac("payload").ValueOrDie();
+    EXPECT_EQ(mac.ComputeMac("header.payload").ValueOrDie(), mac_value);
+    EXPECT_THAT(prefixed.VerifyMac(mac_value, "payload"), IsOk());
+    EXPECT_FALSE(prefixed.VerifyMac(mac_value, "header.payload").ok());
+  }
+}
+
+TEST(MacWrapperTest, SingleKey) {
+  for (OutputPrefixType prefix_type :
+       {OutputPrefixType::TINK, OutputPrefixType::CRUNCHY,
+        OutputPrefixType::RAW}) {
+    SCOPED_TRACE(prefix_type);
+    KeysetInfo::KeyInfo key_info;
+    key_info.set_output_prefix_type(prefix_type);
+    key_info.set_key_id(1234543);
+    key_info.set_status(KeyStatusType::ENABLED);
+    auto mac_set = absl::make_unique<PrimitiveSet<Mac>>();
+    auto entry_result =
+        mac_set->AddPrimitive(absl::make_unique<DummyMac>("mac0"), key_info);
+    ASSERT_THAT(entry_result.status(), IsOk());
+    ASSERT_THAT(mac_set->set_primary(entry_result.ValueOrDie()), IsOk());
+    std::string prefix(mac_set->get_primary()->get_identifier());
+
+    auto mac_result = MacWrapper().Wrap(std::move(mac_set));
+    ASSERT_THAT(mac_result.status(), IsOk());
+    std::unique_ptr<Mac> mac = std::move(mac_result.ValueOrDie());
+    auto compute_mac_result = mac->ComputeMac("data");
+    ASSERT_THAT(compute_mac_result.status(), IsOk());
+    std::string mac_value = compute_mac_result.ValueOrDie();
+
+    EXPECT_THAT(mac->VerifyMac(mac_value, "data"), IsOk());
+    EXPECT_FALSE(mac->VerifyMac(mac_value, "other data").ok());
+    EXPECT_FALSE(mac->VerifyMac(prefix, "data").ok());
+    // A MAC of another key, with a different prefix.
+    std::string other_mac_value = mac_value;
+    other_mac_value[prefix.empty() ? 0 : prefix.size() - 1] ^= 1;
+    EXPECT_FALSE(mac->VerifyMac(other_mac_value, "data").ok());
+  }
+}
+
+TEST(MacWrapperTest, AllocationBudget) {
+  // With one key the wrapper takes its single-key fast path.
+  for (int num_keys : {1, 2}) {
+    SCOPED_TRACE(num_keys);
+    auto mac_set = absl::make_unique<PrimitiveSet<Mac>>();
+    for (int i = 0; i < num_keys; i++) {
+      KeysetInfo::KeyInfo key_info;
+      key_info.set_output_prefix_type(OutputPrefixType::TINK);
+      key_info.set_key_id(1234543 + i);
+      key_info.set_status(KeyStatusType::ENABLED);
+      auto entry_result = mac_set->AddPrimitive(
+          absl::make_unique<BufferDummyMac>(absl::StrCat("mac", i)),
+          key_info);
+      ASSERT_THAT(entry_result.status(), IsOk());
+      if (i == 0) {
+        ASSERT_THAT(mac_set->set_primary(entry_result.ValueOrDie()), IsOk());
+      }
+    }
+    auto mac_result = MacWrapper().Wrap(std::move(mac_set));
+    ASSERT_THAT(mac_result.status(), IsOk());
+    const Mac& mac = *mac_result.ValueOrDie();
+
+    util::InlinedBuffer<32> tag;
+    AllocationCounter counter;
+    util::Status status = mac.ComputeMac("data", &tag);
+    int64_t allocations = counter.count();
+    ASSERT_THAT(status, IsOk());
+    EXPECT_EQ(allocations, 0);
+
+    counter.Reset();
+    status = mac.VerifyMac(tag.AsStringView(), "data");
+    allocations = counter.count();
+    EXPECT_THAT(status, IsOk());
+    EXPECT_EQ(allocations, 0);
+  }
+}
+
+TEST(MacWrapperTest, VerifyMacWithKeyId) {
+  for (OutputPrefixType prefix_type :
+       {OutputPrefixType::RAW, OutputPrefixType::LEGACY}) {
+    SCOPED_TRACE(prefix_type);
+    auto mac_set = absl::make_unique<PrimitiveSet<Mac>>();
+    for (uint32_t key_id : {10, 11, 12}) {
+      KeysetInfo::KeyInfo key_info;
+      key_info.set_output_prefix_type(prefix_type);
+      key_info.set_key_id(key_id);
+      key_info.set_status(KeyStatusType::ENABLED);
+      auto entry_result = mac_set->AddPrimitive(
+          absl::make_unique<DummyMac>(absl::StrCat("mac", key_id)), key_info);
+      ASSERT_THAT(entry_result.status(), IsOk());
+      if (key_id == 11) {
+        ASSERT_THAT(mac_set->set_primary(entry_result.ValueOrDie()), IsOk());
+      }
+    }
+    auto mac_result = MacWrapper().Wrap(std::move(mac_set));
+    ASSERT_THAT(mac_result.status(), IsOk());
+    std::unique_ptr<Mac> mac = std::move(mac_result.ValueOrDie());
+    std::string mac_value = mac->ComputeMac("data").ValueOrDie();
+
+    EXPECT_THAT(mac->VerifyMacWithKeyId(mac_value, "data", 11), IsOk());
+    // Only the hinted key is tried.
+    EXPECT_FALSE(mac->VerifyMacWithKeyId(mac_value, "data", 10).ok());
+    EXPECT_FALSE(mac->VerifyMacWithKeyId(mac_value, "other data", 11).ok());
+    EXPECT_THAT(mac->VerifyMacWithKeyId(mac_value, "data", 13),
+                StatusIs(util::error::INVALID_ARGUMENT));
+  }
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
@@ -0,0 +1,115 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_MMAP_KEYSET_READER_H_
+#define TINK_MMAP_KEYSET_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "tink/keyset_reader.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/secret_proto.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// A KeysetReader for cleartext keysets in proto binary wire format (as
+// written by BinaryKeysetWriter), which maps the keyset file into memory
+// instead of reading it into a string.
+//
+// New() validates the keyset and indexes its keys by scanning the mapped
+// file, without copying any key material: keyset_info() is available right
+// away, and the KeyData of a key is only parsed, into memory which is wiped
+// when released, when it is requested by ReadKeyData() or ReadKeyValue().
+// This keeps the peak memory usage low for keysets with many keys of which
+// only a few are used. Read() still parses the whole keyset, but directly
+// from the mapped file.
+//
+// Encrypted keysets have to be decrypted as a whole, so ReadEncrypted()
+// is not supported; use BinaryKeysetReader for them.
+class MmapKeysetReader : public KeysetReader {
+ public:
+  // Maps the file 'file_descriptor' refers to and indexes the keyset in it.
+  // Takes ownership of 'file_descriptor', which is closed once mapped.
+  static crypto::tink::util::StatusOr<std::unique_ptr<MmapKeysetReader>> New(
+      int file_descriptor);
+
+  MmapKeysetReader(const MmapKeysetReader&) = delete;
+  MmapKeysetReader& operator=(const MmapKeysetReader&) = delete;
+  ~MmapKeysetReader() override;
+
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::Keyset>>
+  Read() override;
+
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<google::crypto::tink::EncryptedKeyset>>
+  ReadEncrypted() override;
+
+  // Returns the metadata of the keyset, which contains no key material.
+  const google::crypto::tink::KeysetInfo& keyset_info() const {
+    return keyset_info_;
+  }
+
+  // Returns the KeyData of the key with the given id.
+  crypto::tink::util::StatusOr<
+      crypto::tink::util::SecretProto<google::crypto::tink::KeyData>>
+  ReadKeyData(uint32_t key_id) const;
+
+  // Returns the value of the KeyData of the key with the given id, i.e. the
+  // serialized key proto of its key type.
+  crypto::tink::util::StatusOr<crypto::tink::util::SecretData> ReadKeyValue(
+      uint32_t key_id) const;
+
+ private:
+  // Location of a key in the mapped file.
+  struct IndexedKey {
+    absl::string_view serialized_key_data;
+    absl::string_view value;
+  };
+
+  MmapKeysetReader(const void* data, size_t size)
+      : data_(data), size_(size) {}
+
+  absl::string_view contents() const {
+    return absl::string_view(static_cast<const char*>(data_), size_);
+  }
+
+  // Fills keyset_info_, keys_ and key_index_.
+  crypto::tink::util::Status Index();
+
+  crypto::tink::util::StatusOr<const IndexedKey*> FindKey(
+      uint32_t key_id) const;
+
+  const void* const data_;
+  const size_t size_;
+  google::crypto::tink::KeysetInfo keyset_info_;
+  // The keys in keyset order, i.e. keys_[i] corresponds to
+  // keyset_info_.key_info(i).
+  std::vector<IndexedKey> keys_;
+  absl::flat_hash_map<uint32_t, size_t> key_index_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_MMAP_KEYSET_READER_H_
@@ -0,0 +1,87 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_MONITORING_H_
+#define TINK_MONITORING_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+
+///////////////////////////////////////////////////////////////////////////////
+// One operation of a keyset-backed primitive, as reported to a
+// MonitoringClient by the primitive wrappers.
+struct MonitoringEvent {
+  // The primitive and the operation, e.g. "aead" and "decrypt".  Both refer
+  // to string literals and stay valid for the lifetime of the program.
+  absl::string_view primitive;
+  absl::string_view operation;
+  // Whether the operation succeeded, and if so the id of the key which
+  // performed it.
+  bool ok = false;
+  uint32_t key_id = 0;
+  // The number of keys the wrapper tried, and whether it fell through to
+  // the RAW keys of the keyset because no key matched the prefix of the
+  // input or the matching keys failed.
+  int keys_tried = 0;
+  bool tried_raw_keys = false;
+  // Whether the wrapper stopped trying RAW keys because it reached its limit
+  // on RAW key attempts, e.g. MacWrapper's max_raw_keys_tried.
+  bool raw_key_limit_reached = false;
+  // Whether the latency of this operation was measured, see
+  // MonitoringClient::latency_sampling_period(), and if so the latency.
+  bool latency_sampled = false;
+  absl::Duration latency;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Receives the events of all primitive wrappers once registered with
+// RegisterMonitoringClient().  Log() is called on the thread which ran the
+// operation, after the operation, so implementations must be thread safe
+// and should be cheap.
+class MonitoringClient {
+ public:
+  virtual void Log(const MonitoringEvent& event) = 0;
+
+  // The latency of one in this many operations of each thread is measured.
+  // Must be positive.
+  virtual int latency_sampling_period() const { return 64; }
+
+  virtual ~MonitoringClient() {}
+};
+
+// Registers 'client' to receive the events of all primitive wrappers.  Only
+// one client can be registered, and only once; later calls fail with
+// ALREADY_EXISTS.  The client is never destroyed.
+//
+// Without a registered client the wrappers only check for one, so
+// monitoring costs nothing unless it is used.
+crypto::tink::util::Status RegisterMonitoringClient(
+    std::unique_ptr<MonitoringClient> client);
+
+// Returns the registered client, or nullptr if there is none.
+MonitoringClient* GetMonitoringClient();
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_MONITORING_H_
@@ -0,0 +1,112 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_MONITORING_STATS_CLIENT_H_
+#define TINK_MONITORING_STATS_CLIENT_H_
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/monitoring.h"
+
+namespace crypto {
+namespace tink {
+
+///////////////////////////////////////////////////////////////////////////////
+// A MonitoringClient which aggregates the events in memory.  Per primitive,
+// operation and key id it counts the operations, the failures, the keys
+// tried, the fall-throughs to RAW keys and the operations which hit the
+// limit on RAW key attempts, and keeps a histogram of the sampled
+// latencies.  Failed operations are counted under key id 0.
+//
+// Usage:
+//   auto client = absl::make_unique<MonitoringStatsClient>();
+//   MonitoringStatsClient* stats = client.get();
+//   RegisterMonitoringClient(std::move(client));
+//   ...
+//   for (const auto& entry : stats->GetStats()) { ... }
+//
+// Instances of this class are thread safe.  Events are aggregated in
+// per-thread shards, so that threads rarely contend.
+class MonitoringStatsClient : public MonitoringClient {
+ public:
+  // Bucket 0 of the latency histogram counts latencies below 1 microsecond,
+  // bucket i > 0 those in [2^(i-1), 2^i) microseconds, and the last bucket
+  // all longer ones.
+  static constexpr int kLatencyBuckets = 24;
+
+  struct Stats {
+    int64_t operations = 0;
+    int64_t failures = 0;
+    int64_t keys_tried = 0;
+    int64_t raw_key_fallthroughs = 0;
+    int64_t raw_key_limits_reached = 0;
+    std::array<int64_t, kLatencyBuckets> latency_histogram = {};
+  };
+
+  // Statistics keyed by primitive, operation and key id.
+  using StatsMap =
+      std::map<std::tuple<std::string, std::string, uint32_t>, Stats>;
+
+  explicit MonitoringStatsClient(int latency_sampling_period = 64)
+      : latency_sampling_period_(latency_sampling_period) {}
+
+  void Log(const MonitoringEvent& event) override;
+
+  int latency_sampling_period() const override {
+    return latency_sampling_period_;
+  }
+
+  // Returns the statistics of all events logged so far.
+  StatsMap GetStats() const;
+
+  // Returns per key id the number of successful 'operation's, e.g.
+  // "decrypt", of all primitives in 'stats' beyond those in 'since'.
+  // Passing an earlier result of GetStats() as 'since' restricts the counts
+  // to the window between the two calls.  The result suits
+  // KeysetManager::Compact().
+  static std::map<uint32_t, int64_t> KeyUsage(const StatsMap& stats,
+                                              absl::string_view operation,
+                                              const StatsMap& since = {});
+
+  // Returns the latency histogram bucket of 'latency'.
+  static int LatencyBucket(absl::Duration latency);
+
+ private:
+  static constexpr int kShards = 16;
+
+  struct Shard {
+    mutable absl::Mutex mutex;
+    // MonitoringEvent guarantees that the names are string literals.
+    std::map<std::tuple<absl::string_view, absl::string_view, uint32_t>,
+             Stats>
+        stats ABSL_GUARDED_BY(mutex);
+  };
+
+  const int latency_sampling_period_;
+  std::array<Shard, kShards> shards_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_MONITORING_STATS_CLIENT_H_
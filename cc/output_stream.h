@@ -17,6 +17,11 @@
 #ifndef TINK_OUTPUT_STREAM_H_
 #define TINK_OUTPUT_STREAM_H_
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "absl/types/span.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
@@ -105,6 +110,46 @@ class OutputStream {
   //   via BackUp() (if any).
   // * If the last call to Next() ended with a failure, -1 is returned;
   virtual int64_t Position() const = 0;
+
+  // Writes all of 'data' to the stream.  Streams that can take the bytes
+  // straight from 'data' (e.g. writing them to a file, or encrypting from
+  // them) override this method to skip their own buffers, and the default
+  // implementation copies 'data' into the buffers returned by Next() and
+  // backs up the unused rest.
+  //
+  // Postconditions:
+  // * If the returned status is not OK, an error occurred, and an unknown
+  //   prefix of 'data' was written.
+  // * BackUp() must not be called directly after WriteFrom().
+  virtual crypto::tink::util::Status WriteFrom(
+      absl::Span<const uint8_t> data) {
+    while (!data.empty()) {
+      void* buffer;
+      auto next_result = Next(&buffer);
+      if (!next_result.ok()) return next_result.status();
+      int available = next_result.ValueOrDie();
+      int used = std::min(static_cast<size_t>(available), data.size());
+      std::memcpy(buffer, data.data(), used);
+      data.remove_prefix(used);
+      if (available > used) BackUp(available - used);
+    }
+    return crypto::tink::util::Status::OK;
+  }
+
+  // Writes the data written to the stream so far (except the bytes backed
+  // up) through to the output, without closing the stream, e.g. so that
+  // the peer of an interactive protocol can read a message before the next
+  // one is written.
+  //
+  // Return values:
+  //  OK: the data was written to the output.
+  //  UNIMPLEMENTED: if the stream cannot flush, which is the default;
+  //      the data is then still written eventually, as usual.
+  //  other: if an error occurred, which is permanent.
+  virtual crypto::tink::util::Status Flush() {
+    return crypto::tink::util::Status(crypto::tink::util::error::UNIMPLEMENTED,
+                                      "Flush() is not supported");
+  }
 };
 
 }  // namespace tink
@@ -0,0 +1,84 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_PAGE_AEAD_H_
+#define TINK_PAGE_AEAD_H_
+
+#include <cstdint>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+
+///////////////////////////////////////////////////////////////////////////////
+// Authenticated encryption of the fixed-size pages of a block store, e.g.
+// the 4, 8 or 16 KiB pages of an embedded database, which are written in
+// any order and rewritten in place.
+//
+// A page of n bytes holds n - overhead() bytes of data, followed by a
+// trailer of overhead() bytes with the nonce and the tag, so encrypted
+// pages are as large as the pages of the store.  Pages are encrypted and
+// decrypted in place, in buffers of the caller, which may be aligned for
+// direct I/O; nothing is allocated per page.
+//
+// The page number and 'associated_data', e.g. the id of the file, are
+// authenticated, so a page can not be moved to another position or file.
+// Encrypting a page again picks a fresh nonce.  Nothing detects that a
+// page was replaced by an older version of itself; stores which must
+// detect rollback keep a version in the page data or in their metadata.
+class PageAead {
+ public:
+  // Returns the size of the trailer of a page.
+  virtual int overhead() const = 0;
+
+  // Encrypts the first page.size() - overhead() bytes of 'page' in place
+  // and writes the trailer into the last overhead() bytes.
+  virtual crypto::tink::util::Status EncryptPage(
+      uint64_t page_number, absl::string_view associated_data,
+      absl::Span<char> page) const = 0;
+
+  // Decrypts a page written by EncryptPage() with the same 'page_number'
+  // and 'associated_data' in place: on success, the first
+  // page.size() - overhead() bytes of 'page' are the data.  On failure,
+  // the contents of 'page' are unspecified.
+  virtual crypto::tink::util::Status DecryptPage(
+      uint64_t page_number, absl::string_view associated_data,
+      absl::Span<char> page) const = 0;
+
+  // Encrypts the consecutive pages of 'page_size' bytes in 'pages', the
+  // first of which is 'first_page_number', as EncryptPage() does.  This is
+  // for the groups of pages of an I/O request.  'pages' must be a multiple
+  // of 'page_size' bytes long.
+  virtual crypto::tink::util::Status EncryptPages(
+      uint64_t first_page_number, absl::string_view associated_data,
+      int page_size, absl::Span<char> pages) const;
+
+  // Decrypts the consecutive pages of 'page_size' bytes in 'pages', as
+  // DecryptPage() does.  Fails if any page fails to decrypt.
+  virtual crypto::tink::util::Status DecryptPages(
+      uint64_t first_page_number, absl::string_view associated_data,
+      int page_size, absl::Span<char> pages) const;
+
+  virtual ~PageAead() {}
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_PAGE_AEAD_H_
@@ -0,0 +1,81 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/paymentmethodtoken/google_payments_public_keys_manager.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tink/paymentmethodtoken/payment_method_token_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace paymentmethodtoken {
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+StatusOr<std::shared_ptr<const std::vector<SenderVerifyingKey>>>
+GooglePaymentsPublicKeysManager::GetKeys() const {
+  std::shared_ptr<const std::vector<SenderVerifyingKey>> keys = FreshKeys();
+  if (keys != nullptr) return keys;
+
+  absl::MutexLock refresh_lock(&refresh_mutex_);
+  // Another thread may have refreshed the keys while this one waited.
+  keys = FreshKeys();
+  if (keys != nullptr) return keys;
+  Status status = RefreshLocked();
+  absl::MutexLock lock(&mutex_);
+  if (keys_ == nullptr) return status;
+  return keys_;
+}
+
+Status GooglePaymentsPublicKeysManager::Refresh() const {
+  absl::MutexLock refresh_lock(&refresh_mutex_);
+  return RefreshLocked();
+}
+
+std::shared_ptr<const std::vector<SenderVerifyingKey>>
+GooglePaymentsPublicKeysManager::FreshKeys() const {
+  absl::MutexLock lock(&mutex_);
+  if (absl::Now() - fetch_time_ >= options_.refresh_interval) return nullptr;
+  return keys_;
+}
+
+Status GooglePaymentsPublicKeysManager::RefreshLocked() const {
+  StatusOr<std::string> keys_json = fetch_keys_();
+  if (!keys_json.ok()) return keys_json.status();
+  auto keys_result = ParseSenderVerifyingKeys(keys_json.ValueOrDie());
+  if (!keys_result.ok()) return keys_result.status();
+  auto keys = std::make_shared<const std::vector<SenderVerifyingKey>>(
+      std::move(keys_result.ValueOrDie()));
+  absl::MutexLock lock(&mutex_);
+  keys_.swap(keys);
+  fetch_time_ = absl::Now();
+  // The previous keys are released here, unless they are still in use.
+  return Status::OK;
+}
+
+}  // namespace paymentmethodtoken
+}  // namespace tink
+}  // namespace crypto
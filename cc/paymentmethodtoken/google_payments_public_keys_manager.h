@@ -0,0 +1,96 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_PAYMENTMETHODTOKEN_GOOGLE_PAYMENTS_PUBLIC_KEYS_MANAGER_H_
+#define TINK_PAYMENTMETHODTOKEN_GOOGLE_PAYMENTS_PUBLIC_KEYS_MANAGER_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tink/paymentmethodtoken/payment_method_token_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace paymentmethodtoken {
+
+// Keeps the keys with which Google signs payment method tokens, as
+// GooglePaymentsPublicKeysManager of Java does.  Tink has no HTTP client in
+// C++, so the keys are fetched by a function of the caller, which returns
+// the document of e.g.
+// https://payments.developers.google.com/paymentmethodtoken/keys.json.
+//
+// The keys are parsed once per fetch, and fetched again when they are older
+// than the refresh interval.  If a refresh fails, the keys fetched before
+// are kept, so that an outage of the key server does not stop the
+// recipients.
+//
+// This class is thread-safe.
+class GooglePaymentsPublicKeysManager {
+ public:
+  using FetchFunction =
+      std::function<crypto::tink::util::StatusOr<std::string>()>;
+
+  struct Options {
+    absl::Duration refresh_interval = absl::Hours(1);
+  };
+
+  GooglePaymentsPublicKeysManager(FetchFunction fetch_keys,
+                                  const Options& options)
+      : fetch_keys_(std::move(fetch_keys)), options_(options) {}
+
+  // Returns the current keys, which are fetched first if they were never
+  // fetched or are older than the refresh interval.  The returned keys stay
+  // usable after later refreshes.
+  crypto::tink::util::StatusOr<
+      std::shared_ptr<const std::vector<SenderVerifyingKey>>>
+  GetKeys() const ABSL_LOCKS_EXCLUDED(refresh_mutex_, mutex_);
+
+  // Fetches the keys now.  On failure the current keys are kept.
+  crypto::tink::util::Status Refresh() const
+      ABSL_LOCKS_EXCLUDED(refresh_mutex_, mutex_);
+
+ private:
+  // Returns the current keys if they are younger than the refresh interval,
+  // or null.
+  std::shared_ptr<const std::vector<SenderVerifyingKey>> FreshKeys() const
+      ABSL_LOCKS_EXCLUDED(mutex_);
+  crypto::tink::util::Status RefreshLocked() const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(refresh_mutex_) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  const FetchFunction fetch_keys_;
+  const Options options_;
+  // Serializes the fetches, without blocking GetKeys() for fresh keys.
+  mutable absl::Mutex refresh_mutex_;
+  mutable absl::Mutex mutex_;
+  mutable std::shared_ptr<const std::vector<SenderVerifyingKey>> keys_
+      ABSL_GUARDED_BY(mutex_);
+  mutable absl::Time fetch_time_ ABSL_GUARDED_BY(mutex_) =
+      absl::InfinitePast();
+};
+
+}  // namespace paymentmethodtoken
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_PAYMENTMETHODTOKEN_GOOGLE_PAYMENTS_PUBLIC_KEYS_MANAGER_H_
@@ -0,0 +1,163 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/paymentmethodtoken/google_payments_public_keys_manager.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
+#include "tink/paymentmethodtoken/payment_method_token_test_util.h"
+#include "tink/paymentmethodtoken/payment_method_token_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace paymentmethodtoken {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Not;
+
+// Serves 'keys_json', or fails with 'status', and counts the fetches.
+struct FakeKeyServer {
+  GooglePaymentsPublicKeysManager::FetchFunction Fetch() {
+    return [this]() -> util::StatusOr<std::string> {
+      fetches++;
+      if (!status.ok()) return status;
+      return keys_json;
+    };
+  }
+
+  std::string keys_json;
+  util::Status status;
+  int fetches = 0;
+};
+
+GooglePaymentsPublicKeysManager::Options WithRefreshInterval(
+    absl::Duration refresh_interval) {
+  GooglePaymentsPublicKeysManager::Options options;
+  options.refresh_interval = refresh_interval;
+  return options;
+}
+
+TEST(GooglePaymentsPublicKeysManagerTest, ParsesKeys) {
+  TestKeyPair key = NewTestKeyPair();
+  FakeKeyServer server;
+  server.keys_json = KeysJsonForTest({key}, kProtocolVersionEcV2);
+  GooglePaymentsPublicKeysManager manager(
+      server.Fetch(), GooglePaymentsPublicKeysManager::Options());
+  auto keys_result = manager.GetKeys();
+  ASSERT_THAT(keys_result.status(), IsOk());
+  ASSERT_EQ(keys_result.ValueOrDie()->size(), 1);
+  const SenderVerifyingKey& parsed = keys_result.ValueOrDie()->front();
+  EXPECT_EQ(parsed.protocol_version, kProtocolVersionEcV2);
+  EXPECT_EQ(parsed.expiration, absl::InfiniteFuture());
+  std::string signature;
+  ASSERT_TRUE(absl::Base64Unescape(SignForTest(key, "data"), &signature));
+  EXPECT_THAT(parsed.verify->Verify(signature, "data"), IsOk());
+}
+
+TEST(GooglePaymentsPublicKeysManagerTest, ParsesExpiration) {
+  TestKeyPair key = NewTestKeyPair();
+  FakeKeyServer server;
+  server.keys_json = absl::StrCat(
+      "{\"keys\": [{\"keyValue\": \"", key.public_key,
+      "\", \"protocolVersion\": \"ECv1\", \"keyExpiration\": \"1000\"}]}");
+  GooglePaymentsPublicKeysManager manager(
+      server.Fetch(), GooglePaymentsPublicKeysManager::Options());
+  auto keys_result = manager.GetKeys();
+  ASSERT_THAT(keys_result.status(), IsOk());
+  ASSERT_EQ(keys_result.ValueOrDie()->size(), 1);
+  EXPECT_EQ(keys_result.ValueOrDie()->front().expiration,
+            absl::FromUnixMillis(1000));
+}
+
+TEST(GooglePaymentsPublicKeysManagerTest, FetchesOnceWhileFresh) {
+  FakeKeyServer server;
+  server.keys_json =
+      KeysJsonForTest({NewTestKeyPair()}, kProtocolVersionEcV2);
+  GooglePaymentsPublicKeysManager manager(server.Fetch(),
+                                          WithRefreshInterval(absl::Hours(1)));
+  auto first = manager.GetKeys();
+  auto second = manager.GetKeys();
+  ASSERT_THAT(first.status(), IsOk());
+  ASSERT_THAT(second.status(), IsOk());
+  EXPECT_EQ(first.ValueOrDie(), second.ValueOrDie());
+  EXPECT_EQ(server.fetches, 1);
+
+  ASSERT_THAT(manager.Refresh(), IsOk());
+  EXPECT_EQ(server.fetches, 2);
+  auto third = manager.GetKeys();
+  ASSERT_THAT(third.status(), IsOk());
+  EXPECT_NE(first.ValueOrDie(), third.ValueOrDie());
+  // The keys returned before stay usable.
+  EXPECT_EQ(first.ValueOrDie()->size(), 1);
+}
+
+TEST(GooglePaymentsPublicKeysManagerTest, KeepsKeysWhenRefreshFails) {
+  FakeKeyServer server;
+  server.keys_json =
+      KeysJsonForTest({NewTestKeyPair()}, kProtocolVersionEcV2);
+  GooglePaymentsPublicKeysManager manager(
+      server.Fetch(), WithRefreshInterval(absl::ZeroDuration()));
+  auto first = manager.GetKeys();
+  ASSERT_THAT(first.status(), IsOk());
+
+  server.status = util::Status(util::error::UNAVAILABLE, "server down");
+  auto second = manager.GetKeys();
+  ASSERT_THAT(second.status(), IsOk());
+  EXPECT_EQ(first.ValueOrDie(), second.ValueOrDie());
+  EXPECT_EQ(server.fetches, 2);
+  EXPECT_THAT(manager.Refresh(), StatusIs(util::error::UNAVAILABLE));
+
+  server.status = util::Status::OK;
+  server.keys_json = "{\"keys\": [{\"keyValue\": \"invalid\"}]}";
+  EXPECT_THAT(manager.Refresh(), StatusIs(util::error::INVALID_ARGUMENT));
+  auto third = manager.GetKeys();
+  ASSERT_THAT(third.status(), IsOk());
+  EXPECT_EQ(first.ValueOrDie(), third.ValueOrDie());
+}
+
+TEST(GooglePaymentsPublicKeysManagerTest, FailsWithoutKeys) {
+  FakeKeyServer server;
+  server.status = util::Status(util::error::UNAVAILABLE, "server down");
+  GooglePaymentsPublicKeysManager manager(
+      server.Fetch(), GooglePaymentsPublicKeysManager::Options());
+  EXPECT_THAT(manager.GetKeys().status(), StatusIs(util::error::UNAVAILABLE));
+  EXPECT_THAT(manager.GetKeys().status(), StatusIs(util::error::UNAVAILABLE));
+  EXPECT_EQ(server.fetches, 2);
+
+  server.status = util::Status::OK;
+  server.keys_json = "not json";
+  EXPECT_THAT(manager.GetKeys().status(), Not(IsOk()));
+  server.keys_json = "{\"keys\": \"none\"}";
+  EXPECT_THAT(manager.GetKeys().status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace paymentmethodtoken
+}  // namespace tink
+}  // namespace crypto
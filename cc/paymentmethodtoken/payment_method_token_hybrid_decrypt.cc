@@ -0,0 +1,118 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/paymentmethodtoken/payment_method_token_hybrid_decrypt.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "google/protobuf/struct.pb.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/jwt/internal/json_util.h"
+#include "tink/paymentmethodtoken/payment_method_token_util.h"
+#include "tink/subtle/aes_ctr_boringssl.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/ecies_hkdf_recipient_kem_boringssl.h"
+#include "tink/subtle/hmac_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace paymentmethodtoken {
+
+namespace {
+
+constexpr int kAesCtrIvSize = 16;
+
+}  // namespace
+
+using crypto::tink::subtle::AesCtrBoringSsl;
+using crypto::tink::subtle::EciesHkdfRecipientKemBoringSsl;
+using crypto::tink::subtle::EcPointFormat;
+using crypto::tink::subtle::EllipticCurveType;
+using crypto::tink::subtle::HashType;
+using crypto::tink::subtle::HmacBoringSsl;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+// static
+StatusOr<std::unique_ptr<HybridDecrypt>> PaymentMethodTokenHybridDecrypt::New(
+    const util::SecretData& private_key, absl::string_view protocol_version) {
+  int aes_key_size;
+  if (protocol_version == kProtocolVersionEcV1) {
+    aes_key_size = kEcV1AesKeySize;
+  } else if (protocol_version == kProtocolVersionEcV2) {
+    aes_key_size = kEcV2AesKeySize;
+  } else {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("unsupported protocol version: ",
+                               protocol_version));
+  }
+  auto kem_result = EciesHkdfRecipientKemBoringSsl::New(
+      EllipticCurveType::NIST_P256, private_key);
+  if (!kem_result.ok()) return kem_result.status();
+  return {absl::WrapUnique(new PaymentMethodTokenHybridDecrypt(
+      std::move(kem_result.ValueOrDie()), aes_key_size))};
+}
+
+StatusOr<std::string> PaymentMethodTokenHybridDecrypt::Decrypt(
+    absl::string_view ciphertext, absl::string_view context_info) const {
+  auto message_result = JsonStringToProtoStruct(ciphertext);
+  if (!message_result.ok()) return message_result.status();
+  const google::protobuf::Struct& message = message_result.ValueOrDie();
+  std::string ephemeral_public_key, encrypted_message, tag;
+  for (auto field : {std::make_pair("ephemeralPublicKey",
+                                    &ephemeral_public_key),
+                     std::make_pair("encryptedMessage", &encrypted_message),
+                     std::make_pair("tag", &tag)}) {
+    auto value_result = GetStringField(message, field.first);
+    if (!value_result.ok()) return value_result.status();
+    if (!absl::Base64Unescape(value_result.ValueOrDie(), field.second)) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    absl::StrCat(field.first, " is not valid base64"));
+    }
+  }
+
+  auto key_result = kem_->GenerateKey(
+      ephemeral_public_key, HashType::SHA256, /*hkdf_salt=*/"", context_info,
+      aes_key_size_ + kHmacKeySize, EcPointFormat::UNCOMPRESSED);
+  if (!key_result.ok()) return key_result.status();
+  const util::SecretData& key = key_result.ValueOrDie();
+  auto hmac_result = HmacBoringSsl::New(
+      HashType::SHA256, kHmacKeySize,
+      util::SecretData(key.begin() + aes_key_size_, key.end()));
+  if (!hmac_result.ok()) return hmac_result.status();
+  Status status = hmac_result.ValueOrDie()->VerifyMac(tag, encrypted_message);
+  if (!status.ok()) {
+    return Status(util::error::INVALID_ARGUMENT, "cannot decrypt; bad tag");
+  }
+  auto aes_ctr_result = AesCtrBoringSsl::New(
+      util::SecretData(key.begin(), key.begin() + aes_key_size_),
+      kAesCtrIvSize);
+  if (!aes_ctr_result.ok()) return aes_ctr_result.status();
+  return aes_ctr_result.ValueOrDie()->Decrypt(
+      absl::StrCat(std::string(kAesCtrIvSize, '\0'), encrypted_message));
+}
+
+}  // namespace paymentmethodtoken
+}  // namespace tink
+}  // namespace crypto
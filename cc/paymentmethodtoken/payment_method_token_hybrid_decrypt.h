@@ -0,0 +1,68 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_PAYMENTMETHODTOKEN_PAYMENT_METHOD_TOKEN_HYBRID_DECRYPT_H_
+#define TINK_PAYMENTMETHODTOKEN_PAYMENT_METHOD_TOKEN_HYBRID_DECRYPT_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/subtle/ecies_hkdf_recipient_kem_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace paymentmethodtoken {
+
+// Decrypts the signed message of a payment method token, i.e. the JSON
+// object with the fields "ephemeralPublicKey", "encryptedMessage" and "tag",
+// as PaymentMethodTokenHybridDecrypt of Java does.  The context info is the
+// HKDF info, which is kHkdfInfo for tokens sent by Google.
+//
+// The key is derived with HKDF-SHA256 from the ephemeral public key and the
+// ECDH shared secret; the message is encrypted with AES-CTR with a zero IV,
+// and authenticated with HMAC-SHA256.
+class PaymentMethodTokenHybridDecrypt : public HybridDecrypt {
+ public:
+  // Returns a decrypter with the NIST P-256 private key 'private_key', a
+  // big-endian integer, for 'protocol_version', "ECv1" or "ECv2".
+  static crypto::tink::util::StatusOr<std::unique_ptr<HybridDecrypt>> New(
+      const util::SecretData& private_key,
+      absl::string_view protocol_version);
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view context_info) const override;
+
+ private:
+  PaymentMethodTokenHybridDecrypt(
+      std::unique_ptr<subtle::EciesHkdfRecipientKemBoringSsl> kem,
+      int aes_key_size)
+      : kem_(std::move(kem)), aes_key_size_(aes_key_size) {}
+
+  const std::unique_ptr<subtle::EciesHkdfRecipientKemBoringSsl> kem_;
+  const int aes_key_size_;
+};
+
+}  // namespace paymentmethodtoken
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_PAYMENTMETHODTOKEN_PAYMENT_METHOD_TOKEN_HYBRID_DECRYPT_H_
@@ -0,0 +1,121 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/paymentmethodtoken/payment_method_token_hybrid_decrypt.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/ascii.h"
+#include "tink/paymentmethodtoken/payment_method_token_test_util.h"
+#include "tink/paymentmethodtoken/payment_method_token_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace paymentmethodtoken {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Not;
+
+constexpr char kMessage[] = "{\"paymentMethod\": \"CARD\"}";
+
+TEST(PaymentMethodTokenHybridDecryptTest, DecryptEcV1AndEcV2) {
+  TestKeyPair recipient = NewTestKeyPair();
+  for (auto version : {std::make_pair(kProtocolVersionEcV1, kEcV1AesKeySize),
+                       std::make_pair(kProtocolVersionEcV2, kEcV2AesKeySize)}) {
+    auto decrypt_result =
+        PaymentMethodTokenHybridDecrypt::New(recipient.ec_key.priv,
+                                             version.first);
+    ASSERT_THAT(decrypt_result.status(), IsOk());
+    std::string ciphertext =
+        EncryptForTest(recipient, version.second, kMessage);
+    auto message_result =
+        decrypt_result.ValueOrDie()->Decrypt(ciphertext, kHkdfInfo);
+    ASSERT_THAT(message_result.status(), IsOk());
+    EXPECT_EQ(message_result.ValueOrDie(), kMessage);
+
+    // The key size of the other protocol version derives other keys.
+    std::string other_ciphertext = EncryptForTest(
+        recipient, kEcV1AesKeySize + kEcV2AesKeySize - version.second,
+        kMessage);
+    EXPECT_THAT(
+        decrypt_result.ValueOrDie()->Decrypt(other_ciphertext, kHkdfInfo)
+            .status(),
+        Not(IsOk()));
+  }
+}
+
+TEST(PaymentMethodTokenHybridDecryptTest, WrongKeyOrContextInfo) {
+  TestKeyPair recipient = NewTestKeyPair();
+  std::string ciphertext = EncryptForTest(recipient, kEcV2AesKeySize, kMessage);
+  auto decrypt_result = PaymentMethodTokenHybridDecrypt::New(
+      NewTestKeyPair().ec_key.priv, kProtocolVersionEcV2);
+  ASSERT_THAT(decrypt_result.status(), IsOk());
+  EXPECT_THAT(
+      decrypt_result.ValueOrDie()->Decrypt(ciphertext, kHkdfInfo).status(),
+      Not(IsOk()));
+
+  decrypt_result = PaymentMethodTokenHybridDecrypt::New(recipient.ec_key.priv,
+                                                        kProtocolVersionEcV2);
+  ASSERT_THAT(decrypt_result.status(), IsOk());
+  EXPECT_THAT(
+      decrypt_result.ValueOrDie()->Decrypt(ciphertext, "other info").status(),
+      Not(IsOk()));
+}
+
+TEST(PaymentMethodTokenHybridDecryptTest, ModifiedCiphertext) {
+  TestKeyPair recipient = NewTestKeyPair();
+  auto decrypt_result = PaymentMethodTokenHybridDecrypt::New(
+      recipient.ec_key.priv, kProtocolVersionEcV2);
+  ASSERT_THAT(decrypt_result.status(), IsOk());
+  std::string ciphertext = EncryptForTest(recipient, kEcV2AesKeySize, kMessage);
+  // Every field is base64 and flipping a case changes its value.
+  for (int i = 0; i < ciphertext.size(); i++) {
+    if (!absl::ascii_isalpha(ciphertext[i])) continue;
+    std::string modified = ciphertext;
+    modified[i] ^= 0x20;
+    EXPECT_THAT(
+        decrypt_result.ValueOrDie()->Decrypt(modified, kHkdfInfo).status(),
+        Not(IsOk()))
+        << modified;
+  }
+  EXPECT_THAT(decrypt_result.ValueOrDie()->Decrypt("{}", kHkdfInfo).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(
+      decrypt_result.ValueOrDie()->Decrypt("not json", kHkdfInfo).status(),
+      Not(IsOk()));
+}
+
+TEST(PaymentMethodTokenHybridDecryptTest, UnsupportedProtocolVersion) {
+  TestKeyPair recipient = NewTestKeyPair();
+  EXPECT_THAT(PaymentMethodTokenHybridDecrypt::New(
+                  recipient.ec_key.priv, kProtocolVersionEcV2SigningOnly)
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace paymentmethodtoken
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,309 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/paymentmethodtoken/payment_method_token_recipient.h"
+
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "google/protobuf/struct.pb.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tink/jwt/internal/json_util.h"
+#include "tink/paymentmethodtoken/payment_method_token_hybrid_decrypt.h"
+#include "tink/paymentmethodtoken/payment_method_token_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace paymentmethodtoken {
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace {
+
+// Fails if 'message' has expired.
+Status CheckMessageExpiration(absl::string_view message) {
+  auto message_result = JsonStringToProtoStruct(message);
+  if (!message_result.ok()) return message_result.status();
+  if (!message_result.ValueOrDie().fields().contains("messageExpiration")) {
+    return Status::OK;
+  }
+  auto expiration_result =
+      GetStringField(message_result.ValueOrDie(), "messageExpiration");
+  if (!expiration_result.ok()) return expiration_result.status();
+  auto time_result = ParseExpiration(expiration_result.ValueOrDie());
+  if (!time_result.ok()) return time_result.status();
+  if (time_result.ValueOrDie() <= absl::Now()) {
+    return Status(util::error::INVALID_ARGUMENT, "expired payload");
+  }
+  return Status::OK;
+}
+
+}  // namespace
+
+// static
+StatusOr<std::unique_ptr<PaymentMethodTokenRecipient>>
+PaymentMethodTokenRecipient::New(const Params& params) {
+  bool signing_only =
+      params.protocol_version == kProtocolVersionEcV2SigningOnly;
+  if (params.protocol_version != kProtocolVersionEcV1 &&
+      params.protocol_version != kProtocolVersionEcV2 && !signing_only) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("unsupported protocol version: ",
+                               params.protocol_version));
+  }
+  if (params.sender_id.empty() || params.recipient_id.empty()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "sender_id and recipient_id must not be empty");
+  }
+  if (params.sender_verifying_keys.empty() ==
+      (params.keys_manager == nullptr)) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "exactly one of sender_verifying_keys and keys_manager "
+                  "must be set");
+  }
+  if (signing_only != params.recipient_private_keys.empty()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  signing_only
+                      ? "ECv2SigningOnly takes no recipient private keys"
+                      : "recipient_private_keys must not be empty");
+  }
+
+  std::vector<std::unique_ptr<HybridDecrypt>> decrypters;
+  for (const util::SecretData& private_key : params.recipient_private_keys) {
+    auto decrypt_result = PaymentMethodTokenHybridDecrypt::New(
+        private_key, params.protocol_version);
+    if (!decrypt_result.ok()) return decrypt_result.status();
+    decrypters.push_back(std::move(decrypt_result.ValueOrDie()));
+  }
+  std::shared_ptr<SenderVerifyingKeys> sender_keys;
+  if (!params.sender_verifying_keys.empty()) {
+    sender_keys = std::make_shared<SenderVerifyingKeys>();
+    for (const std::string& key : params.sender_verifying_keys) {
+      auto verify_result = NewEcdsaVerifyFromSpki(key);
+      if (!verify_result.ok()) return verify_result.status();
+      sender_keys->push_back(SenderVerifyingKey{
+          params.protocol_version, absl::InfiniteFuture(),
+          std::move(verify_result.ValueOrDie())});
+    }
+  }
+  return absl::WrapUnique(new PaymentMethodTokenRecipient(
+      params, std::move(decrypters), std::move(sender_keys)));
+}
+
+PaymentMethodTokenRecipient::PaymentMethodTokenRecipient(
+    const Params& params,
+    std::vector<std::unique_ptr<HybridDecrypt>> decrypters,
+    std::shared_ptr<const SenderVerifyingKeys> sender_keys)
+    : params_(params),
+      decrypters_(std::move(decrypters)),
+      sender_keys_(std::move(sender_keys)) {}
+
+StatusOr<std::string> PaymentMethodTokenRecipient::Unseal(
+    absl::string_view sealed_message) const {
+  auto token_result = JsonStringToProtoStruct(sealed_message);
+  if (!token_result.ok()) return token_result.status();
+  const google::protobuf::Struct& token = token_result.ValueOrDie();
+  auto protocol_version_result = GetStringField(token, "protocolVersion");
+  if (!protocol_version_result.ok()) return protocol_version_result.status();
+  if (protocol_version_result.ValueOrDie() != params_.protocol_version) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("invalid protocol version: ",
+                               protocol_version_result.ValueOrDie()));
+  }
+  auto signature_result = GetStringField(token, "signature");
+  if (!signature_result.ok()) return signature_result.status();
+  std::string signature;
+  if (!absl::Base64Unescape(signature_result.ValueOrDie(), &signature)) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "signature is not valid base64");
+  }
+  auto signed_message_result = GetStringField(token, "signedMessage");
+  if (!signed_message_result.ok()) return signed_message_result.status();
+  const std::string& signed_message = signed_message_result.ValueOrDie();
+
+  auto sender_keys_result = GetSenderKeys();
+  if (!sender_keys_result.ok()) return sender_keys_result.status();
+  std::string signed_data =
+      ToLengthValue({params_.sender_id, params_.recipient_id,
+                     params_.protocol_version, signed_message});
+  if (params_.protocol_version == kProtocolVersionEcV1) {
+    Status status = VerifyWithSenderKeys(*sender_keys_result.ValueOrDie(),
+                                         signature, signed_data);
+    if (!status.ok()) return status;
+  } else {
+    auto intermediate_key_result =
+        GetIntermediateKey(token, sender_keys_result.ValueOrDie());
+    if (!intermediate_key_result.ok()) {
+      return intermediate_key_result.status();
+    }
+    if (!intermediate_key_result.ValueOrDie()
+             ->Verify(signature, signed_data)
+             .ok()) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    "cannot verify signature");
+    }
+  }
+
+  std::string message;
+  if (params_.protocol_version == kProtocolVersionEcV2SigningOnly) {
+    message = signed_message;
+  } else {
+    auto message_result = Decrypt(signed_message);
+    if (!message_result.ok()) return message_result.status();
+    message = std::move(message_result.ValueOrDie());
+  }
+  Status status = CheckMessageExpiration(message);
+  if (!status.ok()) return status;
+  return message;
+}
+
+StatusOr<std::shared_ptr<const std::vector<SenderVerifyingKey>>>
+PaymentMethodTokenRecipient::GetSenderKeys() const {
+  if (sender_keys_ != nullptr) return sender_keys_;
+  return params_.keys_manager->GetKeys();
+}
+
+Status PaymentMethodTokenRecipient::VerifyWithSenderKeys(
+    const SenderVerifyingKeys& sender_keys, absl::string_view signature,
+    absl::string_view data) const {
+  absl::Time now = absl::Now();
+  for (const SenderVerifyingKey& key : sender_keys) {
+    if (key.protocol_version != params_.protocol_version ||
+        key.expiration <= now) {
+      continue;
+    }
+    if (key.verify->Verify(signature, data).ok()) return Status::OK;
+  }
+  return Status(util::error::INVALID_ARGUMENT, "cannot verify signature");
+}
+
+StatusOr<std::shared_ptr<const PublicKeyVerify>>
+PaymentMethodTokenRecipient::GetIntermediateKey(
+    const google::protobuf::Struct& token,
+    std::shared_ptr<const SenderVerifyingKeys> sender_keys) const {
+  auto it = token.fields().find("intermediateSigningKey");
+  if (it == token.fields().end() ||
+      it->second.kind_case() != google::protobuf::Value::kStructValue) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "missing field intermediateSigningKey");
+  }
+  const google::protobuf::Struct& intermediate_key = it->second.struct_value();
+  auto signed_key_result = GetStringField(intermediate_key, "signedKey");
+  if (!signed_key_result.ok()) return signed_key_result.status();
+  const std::string& signed_key = signed_key_result.ValueOrDie();
+  absl::Time now = absl::Now();
+  {
+    absl::MutexLock lock(&mutex_);
+    auto cached = intermediate_keys_.find(signed_key);
+    if (cached != intermediate_keys_.end() &&
+        cached->second.sender_keys == sender_keys &&
+        cached->second.expiration > now) {
+      lru_.splice(lru_.begin(), lru_, cached->second.lru_position);
+      return cached->second.verify;
+    }
+  }
+
+  // The signatures cover the signed key as it is serialized in the token,
+  // so that it can be cached as such.
+  auto signatures = intermediate_key.fields().find("signatures");
+  if (signatures == intermediate_key.fields().end() ||
+      signatures->second.kind_case() != google::protobuf::Value::kListValue) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "missing list field signatures");
+  }
+  std::string signed_data = ToLengthValue(
+      {params_.sender_id, params_.protocol_version, signed_key});
+  bool verified = false;
+  for (const google::protobuf::Value& value :
+       signatures->second.list_value().values()) {
+    std::string signature;
+    if (value.kind_case() != google::protobuf::Value::kStringValue ||
+        !absl::Base64Unescape(value.string_value(), &signature)) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    "signature is not valid base64");
+    }
+    if (VerifyWithSenderKeys(*sender_keys, signature, signed_data).ok()) {
+      verified = true;
+      break;
+    }
+  }
+  if (!verified) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "cannot verify signature of intermediate signing key");
+  }
+
+  auto key_result = JsonStringToProtoStruct(signed_key);
+  if (!key_result.ok()) return key_result.status();
+  auto expiration_result =
+      GetStringField(key_result.ValueOrDie(), "keyExpiration");
+  if (!expiration_result.ok()) return expiration_result.status();
+  auto time_result = ParseExpiration(expiration_result.ValueOrDie());
+  if (!time_result.ok()) return time_result.status();
+  if (time_result.ValueOrDie() <= now) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "expired intermediate signing key");
+  }
+  auto key_value_result = GetStringField(key_result.ValueOrDie(), "keyValue");
+  if (!key_value_result.ok()) return key_value_result.status();
+  auto verify_result = NewEcdsaVerifyFromSpki(key_value_result.ValueOrDie());
+  if (!verify_result.ok()) return verify_result.status();
+  std::shared_ptr<const PublicKeyVerify> verify =
+      std::move(verify_result.ValueOrDie());
+
+  absl::MutexLock lock(&mutex_);
+  auto cached = intermediate_keys_.find(signed_key);
+  if (cached != intermediate_keys_.end()) {
+    lru_.erase(cached->second.lru_position);
+    intermediate_keys_.erase(cached);
+  }
+  while (!lru_.empty() &&
+         intermediate_keys_.size() >= params_.max_cached_intermediate_keys) {
+    intermediate_keys_.erase(lru_.back());
+    lru_.pop_back();
+  }
+  if (params_.max_cached_intermediate_keys > 0) {
+    lru_.emplace_front(signed_key);
+    intermediate_keys_[lru_.front()] = CachedKey{
+        std::move(sender_keys), verify, time_result.ValueOrDie(),
+        lru_.begin()};
+  }
+  return verify;
+}
+
+StatusOr<std::string> PaymentMethodTokenRecipient::Decrypt(
+    absl::string_view signed_message) const {
+  for (const std::unique_ptr<HybridDecrypt>& decrypter : decrypters_) {
+    auto message_result = decrypter->Decrypt(signed_message, kHkdfInfo);
+    if (message_result.ok()) return message_result;
+  }
+  return Status(util::error::INVALID_ARGUMENT, "cannot decrypt");
+}
+
+}  // namespace paymentmethodtoken
+}  // namespace tink
+}  // namespace crypto
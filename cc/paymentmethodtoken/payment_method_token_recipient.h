@@ -0,0 +1,131 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_PAYMENTMETHODTOKEN_PAYMENT_METHOD_TOKEN_RECIPIENT_H_
+#define TINK_PAYMENTMETHODTOKEN_PAYMENT_METHOD_TOKEN_RECIPIENT_H_
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/struct.pb.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/paymentmethodtoken/google_payments_public_keys_manager.h"
+#include "tink/paymentmethodtoken/payment_method_token_util.h"
+#include "tink/public_key_verify.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace paymentmethodtoken {
+
+// Verifies and decrypts Google Pay payment method tokens, as
+// PaymentMethodTokenRecipient of Java does, for the protocol versions ECv1,
+// ECv2 and ECv2SigningOnly.
+//
+// With ECv2, every token carries an intermediate signing key signed by one
+// of the sender's keys.  The intermediate keys the recipient verified are
+// kept in an LRU cache, so that the tokens signed with the same
+// intermediate key, which are most of them, skip the verification of its
+// signatures and the parsing of its public key.  An entry is only used with
+// the sender keys it was verified with, and never past the expiration of
+// its key.
+//
+// This class is thread-safe.
+class PaymentMethodTokenRecipient {
+ public:
+  struct Params {
+    // kProtocolVersionEcV1, kProtocolVersionEcV2 or
+    // kProtocolVersionEcV2SigningOnly.
+    std::string protocol_version = kProtocolVersionEcV2;
+    std::string sender_id = kGoogleSenderId;
+    // The merchant identifier, e.g. "merchant:12345".
+    std::string recipient_id;
+    // The NIST P-256 private keys of the recipient, as big-endian integers,
+    // which are tried in turn.  Must be empty for ECv2SigningOnly.
+    std::vector<util::SecretData> recipient_private_keys;
+    // The sender's keys are either the base64 X.509 SubjectPublicKeyInfo
+    // keys of 'sender_verifying_keys', or those of 'keys_manager'.
+    std::vector<std::string> sender_verifying_keys;
+    std::shared_ptr<GooglePaymentsPublicKeysManager> keys_manager;
+    // The number of verified intermediate signing keys which are cached.
+    int max_cached_intermediate_keys = 64;
+  };
+
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<PaymentMethodTokenRecipient>>
+  New(const Params& params);
+
+  // Verifies 'sealed_message', a token, and returns its decrypted message.
+  crypto::tink::util::StatusOr<std::string> Unseal(
+      absl::string_view sealed_message) const
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+ private:
+  typedef std::vector<SenderVerifyingKey> SenderVerifyingKeys;
+
+  struct CachedKey {
+    // The sender keys with which the key was verified.
+    std::shared_ptr<const SenderVerifyingKeys> sender_keys;
+    std::shared_ptr<const PublicKeyVerify> verify;
+    absl::Time expiration;
+    std::list<std::string>::iterator lru_position;
+  };
+
+  PaymentMethodTokenRecipient(
+      const Params& params,
+      std::vector<std::unique_ptr<HybridDecrypt>> decrypters,
+      std::shared_ptr<const SenderVerifyingKeys> sender_keys);
+
+  crypto::tink::util::StatusOr<std::shared_ptr<const SenderVerifyingKeys>>
+  GetSenderKeys() const;
+  // Verifies 'signature' of 'data' with the current sender keys.
+  crypto::tink::util::Status VerifyWithSenderKeys(
+      const SenderVerifyingKeys& sender_keys, absl::string_view signature,
+      absl::string_view data) const;
+  // Returns the verifier of the intermediate signing key of 'token'.
+  crypto::tink::util::StatusOr<std::shared_ptr<const PublicKeyVerify>>
+  GetIntermediateKey(const google::protobuf::Struct& token,
+                     std::shared_ptr<const SenderVerifyingKeys> sender_keys)
+      const ABSL_LOCKS_EXCLUDED(mutex_);
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view signed_message) const;
+
+  const Params params_;
+  const std::vector<std::unique_ptr<HybridDecrypt>> decrypters_;
+  // The sender keys of 'sender_verifying_keys', or null.
+  const std::shared_ptr<const SenderVerifyingKeys> sender_keys_;
+  mutable absl::Mutex mutex_;
+  // The verified intermediate signing keys, indexed by their signed key,
+  // with the least recently used one at the back of 'lru_'.
+  mutable absl::flat_hash_map<std::string, CachedKey> intermediate_keys_
+      ABSL_GUARDED_BY(mutex_);
+  mutable std::list<std::string> lru_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace paymentmethodtoken
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_PAYMENTMETHODTOKEN_PAYMENT_METHOD_TOKEN_RECIPIENT_H_
@@ -0,0 +1,308 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/paymentmethodtoken/payment_method_token_recipient.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tink/paymentmethodtoken/google_payments_public_keys_manager.h"
+#include "tink/paymentmethodtoken/payment_method_token_test_util.h"
+#include "tink/paymentmethodtoken/payment_method_token_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace paymentmethodtoken {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Not;
+
+constexpr char kRecipientId[] = "merchant:12345";
+constexpr char kMessage[] = "{\"paymentMethod\": \"CARD\"}";
+
+class PaymentMethodTokenRecipientTest : public ::testing::Test {
+ protected:
+  PaymentMethodTokenRecipientTest()
+      : sender_(NewTestKeyPair()),
+        intermediate_(NewTestKeyPair()),
+        recipient_(NewTestKeyPair()) {}
+
+  PaymentMethodTokenRecipient::Params EcV2Params() {
+    PaymentMethodTokenRecipient::Params params;
+    params.protocol_version = kProtocolVersionEcV2;
+    params.recipient_id = kRecipientId;
+    params.recipient_private_keys.push_back(recipient_.ec_key.priv);
+    params.sender_verifying_keys.push_back(sender_.public_key);
+    return params;
+  }
+
+  std::unique_ptr<PaymentMethodTokenRecipient> NewRecipient(
+      const PaymentMethodTokenRecipient::Params& params) {
+    auto recipient_result = PaymentMethodTokenRecipient::New(params);
+    EXPECT_THAT(recipient_result.status(), IsOk());
+    return std::move(recipient_result.ValueOrDie());
+  }
+
+  // Returns a token of 'signed_message' signed by 'intermediate_', whose key
+  // is signed by 'key_signer' and expires at 'key_expiration'.
+  std::string EcV2Token(absl::string_view protocol_version,
+                        absl::string_view signed_message,
+                        const TestKeyPair& key_signer,
+                        absl::Time key_expiration) {
+    std::string signed_key = SignedKeyForTest(intermediate_, key_expiration);
+    std::string key_signature = SignForTest(
+        key_signer, ToLengthValue({kGoogleSenderId, protocol_version,
+                                   signed_key}));
+    std::string signature = SignForTest(
+        intermediate_, ToLengthValue({kGoogleSenderId, kRecipientId,
+                                      protocol_version, signed_message}));
+    return TokenForTest(protocol_version, signature, signed_message,
+                        signed_key, {key_signature});
+  }
+
+  std::string EcV2Token(absl::string_view message) {
+    return EcV2Token(kProtocolVersionEcV2,
+                     EncryptForTest(recipient_, kEcV2AesKeySize, message),
+                     sender_, absl::Now() + absl::Hours(1));
+  }
+
+  TestKeyPair sender_;
+  TestKeyPair intermediate_;
+  TestKeyPair recipient_;
+};
+
+TEST_F(PaymentMethodTokenRecipientTest, UnsealEcV2) {
+  std::unique_ptr<PaymentMethodTokenRecipient> recipient =
+      NewRecipient(EcV2Params());
+  auto message_result = recipient->Unseal(EcV2Token(kMessage));
+  ASSERT_THAT(message_result.status(), IsOk());
+  EXPECT_EQ(message_result.ValueOrDie(), kMessage);
+}
+
+TEST_F(PaymentMethodTokenRecipientTest, UnsealEcV1) {
+  PaymentMethodTokenRecipient::Params params = EcV2Params();
+  params.protocol_version = kProtocolVersionEcV1;
+  std::unique_ptr<PaymentMethodTokenRecipient> recipient =
+      NewRecipient(params);
+  std::string signed_message =
+      EncryptForTest(recipient_, kEcV1AesKeySize, kMessage);
+  std::string signature = SignForTest(
+      sender_, ToLengthValue({kGoogleSenderId, kRecipientId,
+                              kProtocolVersionEcV1, signed_message}));
+  auto message_result = recipient->Unseal(TokenForTest(
+      kProtocolVersionEcV1, signature, signed_message, "", {}));
+  ASSERT_THAT(message_result.status(), IsOk());
+  EXPECT_EQ(message_result.ValueOrDie(), kMessage);
+
+  std::string other_signature = SignForTest(
+      intermediate_, ToLengthValue({kGoogleSenderId, kRecipientId,
+                                    kProtocolVersionEcV1, signed_message}));
+  EXPECT_THAT(recipient
+                  ->Unseal(TokenForTest(kProtocolVersionEcV1, other_signature,
+                                        signed_message, "", {}))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(PaymentMethodTokenRecipientTest, UnsealEcV2SigningOnly) {
+  PaymentMethodTokenRecipient::Params params = EcV2Params();
+  params.protocol_version = kProtocolVersionEcV2SigningOnly;
+  params.recipient_private_keys.clear();
+  std::unique_ptr<PaymentMethodTokenRecipient> recipient =
+      NewRecipient(params);
+  auto message_result = recipient->Unseal(
+      EcV2Token(kProtocolVersionEcV2SigningOnly, kMessage, sender_,
+                absl::Now() + absl::Hours(1)));
+  ASSERT_THAT(message_result.status(), IsOk());
+  EXPECT_EQ(message_result.ValueOrDie(), kMessage);
+}
+
+TEST_F(PaymentMethodTokenRecipientTest, TriesAllPrivateKeys) {
+  PaymentMethodTokenRecipient::Params params = EcV2Params();
+  params.recipient_private_keys.insert(params.recipient_private_keys.begin(),
+                                       NewTestKeyPair().ec_key.priv);
+  std::unique_ptr<PaymentMethodTokenRecipient> recipient =
+      NewRecipient(params);
+  auto message_result = recipient->Unseal(EcV2Token(kMessage));
+  ASSERT_THAT(message_result.status(), IsOk());
+  EXPECT_EQ(message_result.ValueOrDie(), kMessage);
+}
+
+TEST_F(PaymentMethodTokenRecipientTest, CachesVerifiedIntermediateKey) {
+  std::unique_ptr<PaymentMethodTokenRecipient> recipient =
+      NewRecipient(EcV2Params());
+  std::string signed_message =
+      EncryptForTest(recipient_, kEcV2AesKeySize, kMessage);
+  absl::Time key_expiration = absl::Now() + absl::Hours(1);
+  ASSERT_THAT(recipient
+                  ->Unseal(EcV2Token(kProtocolVersionEcV2, signed_message,
+                                     sender_, key_expiration))
+                  .status(),
+              IsOk());
+  // The same signed key is not verified again, so that a token whose key
+  // signatures are not checked is accepted.  The signed key itself was
+  // authenticated by the first token.
+  std::string token = EcV2Token(kProtocolVersionEcV2, signed_message,
+                                NewTestKeyPair(), key_expiration);
+  EXPECT_THAT(recipient->Unseal(token).status(), IsOk());
+  // Without the cache it is rejected.
+  PaymentMethodTokenRecipient::Params params = EcV2Params();
+  params.max_cached_intermediate_keys = 0;
+  EXPECT_THAT(NewRecipient(params)->Unseal(token).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(PaymentMethodTokenRecipientTest, CacheIsBoundToSenderKeys) {
+  std::string keys_json = KeysJsonForTest({sender_}, kProtocolVersionEcV2);
+  auto keys_manager = std::make_shared<GooglePaymentsPublicKeysManager>(
+      [&keys_json]() -> util::StatusOr<std::string> { return keys_json; },
+      GooglePaymentsPublicKeysManager::Options());
+  PaymentMethodTokenRecipient::Params params = EcV2Params();
+  params.sender_verifying_keys.clear();
+  params.keys_manager = keys_manager;
+  std::unique_ptr<PaymentMethodTokenRecipient> recipient =
+      NewRecipient(params);
+  std::string token = EcV2Token(kMessage);
+  ASSERT_THAT(recipient->Unseal(token).status(), IsOk());
+
+  // After the sender key is rotated out, its intermediate keys are no
+  // longer trusted, even if they are cached.
+  keys_json = KeysJsonForTest({NewTestKeyPair()}, kProtocolVersionEcV2);
+  ASSERT_THAT(keys_manager->Refresh(), IsOk());
+  EXPECT_THAT(recipient->Unseal(token).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(PaymentMethodTokenRecipientTest, SenderKeysOfOtherProtocolVersion) {
+  std::string keys_json = KeysJsonForTest({sender_}, kProtocolVersionEcV1);
+  PaymentMethodTokenRecipient::Params params = EcV2Params();
+  params.sender_verifying_keys.clear();
+  params.keys_manager = std::make_shared<GooglePaymentsPublicKeysManager>(
+      [&keys_json]() -> util::StatusOr<std::string> { return keys_json; },
+      GooglePaymentsPublicKeysManager::Options());
+  EXPECT_THAT(NewRecipient(params)->Unseal(EcV2Token(kMessage)).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(PaymentMethodTokenRecipientTest, ExpiredIntermediateKey) {
+  std::unique_ptr<PaymentMethodTokenRecipient> recipient =
+      NewRecipient(EcV2Params());
+  std::string token = EcV2Token(
+      kProtocolVersionEcV2,
+      EncryptForTest(recipient_, kEcV2AesKeySize, kMessage), sender_,
+      absl::Now() - absl::Seconds(1));
+  EXPECT_THAT(recipient->Unseal(token).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(PaymentMethodTokenRecipientTest, ExpiredMessage) {
+  std::unique_ptr<PaymentMethodTokenRecipient> recipient =
+      NewRecipient(EcV2Params());
+  auto expiring_message = [](absl::Time expiration) {
+    return absl::StrCat("{\"messageExpiration\": \"",
+                        absl::ToUnixMillis(expiration), "\"}");
+  };
+  EXPECT_THAT(recipient
+                  ->Unseal(EcV2Token(
+                      expiring_message(absl::Now() + absl::Hours(1))))
+                  .status(),
+              IsOk());
+  EXPECT_THAT(recipient
+                  ->Unseal(EcV2Token(
+                      expiring_message(absl::Now() - absl::Seconds(1))))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(PaymentMethodTokenRecipientTest, WrongRecipientOrProtocolVersion) {
+  PaymentMethodTokenRecipient::Params params = EcV2Params();
+  params.recipient_id = "merchant:other";
+  EXPECT_THAT(NewRecipient(params)->Unseal(EcV2Token(kMessage)).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+
+  params = EcV2Params();
+  params.protocol_version = kProtocolVersionEcV1;
+  EXPECT_THAT(NewRecipient(params)->Unseal(EcV2Token(kMessage)).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(PaymentMethodTokenRecipientTest, ModifiedToken) {
+  std::unique_ptr<PaymentMethodTokenRecipient> recipient =
+      NewRecipient(EcV2Params());
+  std::string token = EcV2Token(kMessage);
+  EXPECT_THAT(recipient->Unseal(token.substr(0, token.size() - 1)).status(),
+              Not(IsOk()));
+  EXPECT_THAT(recipient->Unseal("{}").status(), Not(IsOk()));
+  // A message signed for another token does not verify.
+  std::string other_token = EcV2Token("{}");
+  std::string signed_message_field = "\"signedMessage\":";
+  size_t other = other_token.find(signed_message_field);
+  size_t position = token.find(signed_message_field);
+  ASSERT_NE(other, std::string::npos);
+  ASSERT_NE(position, std::string::npos);
+  EXPECT_THAT(recipient->Unseal(absl::StrCat(token.substr(0, position),
+                                             other_token.substr(other)))
+                  .status(),
+              Not(IsOk()));
+}
+
+TEST_F(PaymentMethodTokenRecipientTest, InvalidParams) {
+  PaymentMethodTokenRecipient::Params params = EcV2Params();
+  params.protocol_version = "ECv3";
+  EXPECT_THAT(PaymentMethodTokenRecipient::New(params).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+
+  params = EcV2Params();
+  params.recipient_id.clear();
+  EXPECT_THAT(PaymentMethodTokenRecipient::New(params).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+
+  params = EcV2Params();
+  params.sender_verifying_keys.clear();
+  EXPECT_THAT(PaymentMethodTokenRecipient::New(params).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+
+  params = EcV2Params();
+  params.recipient_private_keys.clear();
+  EXPECT_THAT(PaymentMethodTokenRecipient::New(params).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+
+  params = EcV2Params();
+  params.protocol_version = kProtocolVersionEcV2SigningOnly;
+  EXPECT_THAT(PaymentMethodTokenRecipient::New(params).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+
+  params = EcV2Params();
+  params.sender_verifying_keys = {"invalid"};
+  EXPECT_THAT(PaymentMethodTokenRecipient::New(params).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace paymentmethodtoken
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,183 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/paymentmethodtoken/payment_method_token_test_util.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/struct.pb.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "openssl/bn.h"
+#include "openssl/ec.h"
+#include "openssl/mem.h"
+#include "openssl/nid.h"
+#include "openssl/x509.h"
+#include "tink/jwt/internal/json_util.h"
+#include "tink/paymentmethodtoken/payment_method_token_util.h"
+#include "tink/subtle/aes_ctr_boringssl.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/ecdsa_sign_boringssl.h"
+#include "tink/subtle/ecies_hkdf_sender_kem_boringssl.h"
+#include "tink/subtle/hmac_boringssl.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/secret_data.h"
+
+namespace crypto {
+namespace tink {
+namespace paymentmethodtoken {
+
+using crypto::tink::subtle::AesCtrBoringSsl;
+using crypto::tink::subtle::EcdsaSignatureEncoding;
+using crypto::tink::subtle::EcdsaSignBoringSsl;
+using crypto::tink::subtle::EciesHkdfNistPCurveSendKemBoringSsl;
+using crypto::tink::subtle::EcPointFormat;
+using crypto::tink::subtle::EllipticCurveType;
+using crypto::tink::subtle::HashType;
+using crypto::tink::subtle::HmacBoringSsl;
+using crypto::tink::subtle::SubtleUtilBoringSSL;
+
+namespace {
+
+std::string ToJson(const google::protobuf::Struct& object) {
+  return ProtoStructToJsonString(object).ValueOrDie();
+}
+
+void SetString(google::protobuf::Struct* object, absl::string_view name,
+               absl::string_view value) {
+  (*object->mutable_fields())[std::string(name)].set_string_value(
+      std::string(value));
+}
+
+}  // namespace
+
+TestKeyPair NewTestKeyPair() {
+  TestKeyPair key;
+  key.ec_key =
+      SubtleUtilBoringSSL::GetNewEcKey(EllipticCurveType::NIST_P256)
+          .ValueOrDie();
+  bssl::UniquePtr<EC_KEY> ec_key(
+      EC_KEY_new_by_curve_name(NID_X9_62_prime256v1));
+  bssl::UniquePtr<EC_POINT> point(
+      SubtleUtilBoringSSL::GetEcPoint(EllipticCurveType::NIST_P256,
+                                      key.ec_key.pub_x, key.ec_key.pub_y)
+          .ValueOrDie());
+  EC_KEY_set_public_key(ec_key.get(), point.get());
+  uint8_t* der = nullptr;
+  int der_size = i2d_EC_PUBKEY(ec_key.get(), &der);
+  absl::Base64Escape(
+      absl::string_view(reinterpret_cast<const char*>(der), der_size),
+      &key.public_key);
+  OPENSSL_free(der);
+  return key;
+}
+
+std::string SignForTest(const TestKeyPair& key, absl::string_view data) {
+  auto sign = EcdsaSignBoringSsl::New(key.ec_key, HashType::SHA256,
+                                      EcdsaSignatureEncoding::DER)
+                  .ValueOrDie();
+  return absl::Base64Escape(sign->Sign(data).ValueOrDie());
+}
+
+std::string EncryptForTest(const TestKeyPair& recipient, int aes_key_size,
+                           absl::string_view message) {
+  auto kem = EciesHkdfNistPCurveSendKemBoringSsl::New(
+                 EllipticCurveType::NIST_P256, recipient.ec_key.pub_x,
+                 recipient.ec_key.pub_y)
+                 .ValueOrDie();
+  auto kem_key =
+      kem->GenerateKey(HashType::SHA256, "", kHkdfInfo,
+                       aes_key_size + kHmacKeySize,
+                       EcPointFormat::UNCOMPRESSED)
+          .ValueOrDie();
+  const util::SecretData& key = kem_key->get_symmetric_key();
+  auto aes_ctr =
+      AesCtrBoringSsl::New(
+          util::SecretData(key.begin(), key.begin() + aes_key_size), 16)
+          .ValueOrDie();
+  // AesCtrBoringSsl encrypts with a random IV, but tokens use a zero IV.
+  // Decrypting with the zero IV is the same as encrypting with it.
+  std::string encrypted =
+      aes_ctr->Decrypt(absl::StrCat(std::string(16, '\0'), message))
+          .ValueOrDie();
+  auto hmac = HmacBoringSsl::New(
+                  HashType::SHA256, kHmacKeySize,
+                  util::SecretData(key.begin() + aes_key_size, key.end()))
+                  .ValueOrDie();
+  google::protobuf::Struct signed_message;
+  SetString(&signed_message, "encryptedMessage",
+            absl::Base64Escape(encrypted));
+  SetString(&signed_message, "ephemeralPublicKey",
+            absl::Base64Escape(kem_key->get_kem_bytes()));
+  SetString(&signed_message, "tag",
+            absl::Base64Escape(hmac->ComputeMac(encrypted).ValueOrDie()));
+  return ToJson(signed_message);
+}
+
+std::string SignedKeyForTest(const TestKeyPair& intermediate,
+                             absl::Time expiration) {
+  google::protobuf::Struct signed_key;
+  SetString(&signed_key, "keyValue", intermediate.public_key);
+  SetString(&signed_key, "keyExpiration",
+            absl::StrCat(absl::ToUnixMillis(expiration)));
+  return ToJson(signed_key);
+}
+
+std::string TokenForTest(absl::string_view protocol_version,
+                         absl::string_view signature,
+                         absl::string_view signed_message,
+                         absl::string_view signed_key,
+                         const std::vector<std::string>& key_signatures) {
+  google::protobuf::Struct token;
+  SetString(&token, "protocolVersion", protocol_version);
+  SetString(&token, "signature", signature);
+  SetString(&token, "signedMessage", signed_message);
+  if (!signed_key.empty()) {
+    google::protobuf::Struct* intermediate_key =
+        (*token.mutable_fields())["intermediateSigningKey"]
+            .mutable_struct_value();
+    SetString(intermediate_key, "signedKey", signed_key);
+    google::protobuf::ListValue* signatures =
+        (*intermediate_key->mutable_fields())["signatures"]
+            .mutable_list_value();
+    for (const std::string& key_signature : key_signatures) {
+      signatures->add_values()->set_string_value(key_signature);
+    }
+  }
+  return ToJson(token);
+}
+
+std::string KeysJsonForTest(const std::vector<TestKeyPair>& keys,
+                            absl::string_view protocol_version) {
+  google::protobuf::Struct keys_json;
+  google::protobuf::ListValue* list =
+      (*keys_json.mutable_fields())["keys"].mutable_list_value();
+  for (const TestKeyPair& key : keys) {
+    google::protobuf::Struct* entry =
+        list->add_values()->mutable_struct_value();
+    SetString(entry, "keyValue", key.public_key);
+    SetString(entry, "protocolVersion", protocol_version);
+  }
+  return ToJson(keys_json);
+}
+
+}  // namespace paymentmethodtoken
+}  // namespace tink
+}  // namespace crypto
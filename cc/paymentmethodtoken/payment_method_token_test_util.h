@@ -0,0 +1,69 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_PAYMENTMETHODTOKEN_PAYMENT_METHOD_TOKEN_TEST_UTIL_H_
+#define TINK_PAYMENTMETHODTOKEN_PAYMENT_METHOD_TOKEN_TEST_UTIL_H_
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+
+namespace crypto {
+namespace tink {
+namespace paymentmethodtoken {
+
+// Helpers which build payment method tokens as a sender would, for tests.
+
+// A NIST P-256 key pair with its public key as a base64 X.509
+// SubjectPublicKeyInfo.
+struct TestKeyPair {
+  subtle::SubtleUtilBoringSSL::EcKey ec_key;
+  std::string public_key;
+};
+
+TestKeyPair NewTestKeyPair();
+
+// Returns the base64 DER-encoded ECDSA SHA-256 signature of 'data'.
+std::string SignForTest(const TestKeyPair& key, absl::string_view data);
+
+// Returns the signed message which encrypts 'message' for 'recipient'.
+std::string EncryptForTest(const TestKeyPair& recipient, int aes_key_size,
+                           absl::string_view message);
+
+// Returns the signed key of 'intermediate', which expires at 'expiration'.
+std::string SignedKeyForTest(const TestKeyPair& intermediate,
+                             absl::Time expiration);
+
+// Returns a token.  The intermediate signing key is only added if
+// 'signed_key' is not empty.
+std::string TokenForTest(absl::string_view protocol_version,
+                         absl::string_view signature,
+                         absl::string_view signed_message,
+                         absl::string_view signed_key,
+                         const std::vector<std::string>& key_signatures);
+
+// Returns a document in the format of the Google keys.json.
+std::string KeysJsonForTest(const std::vector<TestKeyPair>& keys,
+                            absl::string_view protocol_version);
+
+}  // namespace paymentmethodtoken
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_PAYMENTMETHODTOKEN_PAYMENT_METHOD_TOKEN_TEST_UTIL_H_
@@ -0,0 +1,150 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/paymentmethodtoken/payment_method_token_util.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "google/protobuf/struct.pb.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "openssl/bytestring.h"
+#include "openssl/ec.h"
+#include "openssl/evp.h"
+#include "openssl/nid.h"
+#include "tink/jwt/internal/json_util.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/ecdsa_verify_boringssl.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace paymentmethodtoken {
+
+using crypto::tink::subtle::EcdsaSignatureEncoding;
+using crypto::tink::subtle::EcdsaVerifyBoringSsl;
+using crypto::tink::subtle::HashType;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+std::string ToLengthValue(std::initializer_list<absl::string_view> chunks) {
+  std::string result;
+  for (absl::string_view chunk : chunks) {
+    uint32_t length = chunk.size();
+    for (int i = 0; i < 4; i++) {
+      result.push_back(static_cast<char>((length >> (8 * i)) & 0xff));
+    }
+    absl::StrAppend(&result, chunk);
+  }
+  return result;
+}
+
+StatusOr<std::unique_ptr<PublicKeyVerify>> NewEcdsaVerifyFromSpki(
+    absl::string_view base64_key) {
+  std::string der;
+  if (!absl::Base64Unescape(base64_key, &der)) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "verifying key is not valid base64");
+  }
+  CBS cbs;
+  CBS_init(&cbs, reinterpret_cast<const uint8_t*>(der.data()), der.size());
+  bssl::UniquePtr<EVP_PKEY> public_key(EVP_parse_public_key(&cbs));
+  if (public_key == nullptr || CBS_len(&cbs) != 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "verifying key is not a valid SubjectPublicKeyInfo");
+  }
+  bssl::UniquePtr<EC_KEY> ec_key(EVP_PKEY_get1_EC_KEY(public_key.get()));
+  if (ec_key == nullptr ||
+      EC_GROUP_get_curve_name(EC_KEY_get0_group(ec_key.get())) !=
+          NID_X9_62_prime256v1) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "verifying key is not a NIST P-256 key");
+  }
+  auto verify_result = EcdsaVerifyBoringSsl::New(
+      std::move(ec_key), HashType::SHA256, EcdsaSignatureEncoding::DER);
+  if (!verify_result.ok()) return verify_result.status();
+  return {std::move(verify_result.ValueOrDie())};
+}
+
+StatusOr<absl::Time> ParseExpiration(absl::string_view expiration) {
+  int64_t millis;
+  if (!absl::SimpleAtoi(expiration, &millis)) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("invalid expiration: ", expiration));
+  }
+  return absl::FromUnixMillis(millis);
+}
+
+StatusOr<std::string> GetStringField(const google::protobuf::Struct& object,
+                                     absl::string_view name) {
+  auto it = object.fields().find(std::string(name));
+  if (it == object.fields().end() ||
+      it->second.kind_case() != google::protobuf::Value::kStringValue) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("missing string field ", name));
+  }
+  return it->second.string_value();
+}
+
+StatusOr<std::vector<SenderVerifyingKey>> ParseSenderVerifyingKeys(
+    absl::string_view keys_json) {
+  auto keys_result = JsonStringToProtoStruct(keys_json);
+  if (!keys_result.ok()) return keys_result.status();
+  auto it = keys_result.ValueOrDie().fields().find("keys");
+  if (it == keys_result.ValueOrDie().fields().end() ||
+      it->second.kind_case() != google::protobuf::Value::kListValue) {
+    return Status(util::error::INVALID_ARGUMENT, "missing list field keys");
+  }
+  std::vector<SenderVerifyingKey> keys;
+  for (const google::protobuf::Value& value :
+       it->second.list_value().values()) {
+    if (value.kind_case() != google::protobuf::Value::kStructValue) {
+      return Status(util::error::INVALID_ARGUMENT, "key is not an object");
+    }
+    const google::protobuf::Struct& key = value.struct_value();
+    SenderVerifyingKey parsed;
+    auto protocol_version_result = GetStringField(key, "protocolVersion");
+    if (!protocol_version_result.ok()) return protocol_version_result.status();
+    parsed.protocol_version = protocol_version_result.ValueOrDie();
+    parsed.expiration = absl::InfiniteFuture();
+    if (key.fields().contains("keyExpiration")) {
+      auto expiration_result = GetStringField(key, "keyExpiration");
+      if (!expiration_result.ok()) return expiration_result.status();
+      auto time_result = ParseExpiration(expiration_result.ValueOrDie());
+      if (!time_result.ok()) return time_result.status();
+      parsed.expiration = time_result.ValueOrDie();
+    }
+    auto key_value_result = GetStringField(key, "keyValue");
+    if (!key_value_result.ok()) return key_value_result.status();
+    auto verify_result = NewEcdsaVerifyFromSpki(key_value_result.ValueOrDie());
+    if (!verify_result.ok()) return verify_result.status();
+    parsed.verify = std::move(verify_result.ValueOrDie());
+    keys.push_back(std::move(parsed));
+  }
+  return keys;
+}
+
+}  // namespace paymentmethodtoken
+}  // namespace tink
+}  // namespace crypto
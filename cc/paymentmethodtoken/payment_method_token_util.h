@@ -0,0 +1,82 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_PAYMENTMETHODTOKEN_PAYMENT_METHOD_TOKEN_UTIL_H_
+#define TINK_PAYMENTMETHODTOKEN_PAYMENT_METHOD_TOKEN_UTIL_H_
+
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/struct.pb.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "tink/public_key_verify.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace paymentmethodtoken {
+
+// The constants of the Google Pay payment method token format, as in
+// PaymentMethodTokenConstants of Java.
+constexpr char kGoogleSenderId[] = "Google";
+constexpr char kProtocolVersionEcV1[] = "ECv1";
+constexpr char kProtocolVersionEcV2[] = "ECv2";
+constexpr char kProtocolVersionEcV2SigningOnly[] = "ECv2SigningOnly";
+// The HKDF info of the ECIES key derivation.
+constexpr char kHkdfInfo[] = "Google";
+constexpr int kEcV1AesKeySize = 16;
+constexpr int kEcV2AesKeySize = 32;
+constexpr int kHmacKeySize = 32;
+
+// A key with which the sender signs messages or intermediate signing keys.
+struct SenderVerifyingKey {
+  std::string protocol_version;
+  // absl::InfiniteFuture() if the key does not expire.
+  absl::Time expiration;
+  std::shared_ptr<const PublicKeyVerify> verify;
+};
+
+// Returns the concatenation of 'chunks', each preceded by its length as a
+// 4-byte little-endian integer, which is the input of every signature.
+std::string ToLengthValue(std::initializer_list<absl::string_view> chunks);
+
+// Returns a verifier of the DER-encoded ECDSA NIST P-256 SHA-256 signatures
+// of the key 'base64_key', a base64 X.509 SubjectPublicKeyInfo.
+crypto::tink::util::StatusOr<std::unique_ptr<PublicKeyVerify>>
+NewEcdsaVerifyFromSpki(absl::string_view base64_key);
+
+// Returns the time of 'expiration', a decimal number of milliseconds since
+// the Unix epoch.
+crypto::tink::util::StatusOr<absl::Time> ParseExpiration(
+    absl::string_view expiration);
+
+// Returns the string field 'name' of 'object'.
+crypto::tink::util::StatusOr<std::string> GetStringField(
+    const google::protobuf::Struct& object, absl::string_view name);
+
+// Returns the keys of 'keys_json', which is in the format of
+// https://payments.developers.google.com/paymentmethodtoken/keys.json.
+crypto::tink::util::StatusOr<std::vector<SenderVerifyingKey>>
+ParseSenderVerifyingKeys(absl::string_view keys_json);
+
+}  // namespace paymentmethodtoken
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_PAYMENTMETHODTOKEN_PAYMENT_METHOD_TOKEN_UTIL_H_
@@ -0,0 +1,158 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_PER_KEY_ENCRYPTED_KEYSET_HANDLE_H_
+#define TINK_PER_KEY_ENCRYPTED_KEYSET_HANDLE_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/keyset_handle.h"
+#include "tink/primitive_set.h"
+#include "tink/registry.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// Reads and writes keysets in which every key is encrypted separately
+// (cf. PerKeyEncryptedKeyset in tink.proto), for processes which load large
+// keysets but use few of their keys, e.g. the server of one tenant of a
+// keyset with a key per tenant.
+//
+// Read() decrypts the data encryption key with one call to the master key,
+// which also authenticates the cleartext KeysetInfo.  The keys stay
+// encrypted until a primitive of the keyset uses them, so that the time to
+// load a keyset, and the key material held in memory, grow with the number
+// of keys used rather than with the size of the keyset.
+class PerKeyEncryptedKeysetHandle {
+ public:
+  // Returns the keyset of 'keyset_handle' as a serialized
+  // PerKeyEncryptedKeyset, whose data encryption key is encrypted with
+  // 'master_key_aead'.
+  static crypto::tink::util::StatusOr<std::string> Write(
+      const KeysetHandle& keyset_handle, const Aead& master_key_aead);
+
+  // Reads the serialized PerKeyEncryptedKeyset 'serialized_keyset', and
+  // decrypts its data encryption key with 'master_key_aead'.  No key is
+  // decrypted yet.
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<PerKeyEncryptedKeysetHandle>>
+  Read(absl::string_view serialized_keyset, const Aead& master_key_aead);
+
+  // Returns the KeysetInfo of the keyset, which was authenticated by Read().
+  const google::crypto::tink::KeysetInfo& GetKeysetInfo() const {
+    return state_->keyset_info;
+  }
+
+  // Creates a wrapped primitive of the keyset.  The primary key is decrypted
+  // right away.  Every other enabled key is decrypted, and its primitive
+  // created, the first time a ciphertext, tag or signature refers to it, as
+  // with KeysetHandle::LoadingOptions::lazy; a key which cannot be decrypted
+  // then behaves as if it was not in the keyset.
+  template <class P>
+  crypto::tink::util::StatusOr<std::unique_ptr<P>> GetPrimitive() const;
+
+  // Returns the number of keys decrypted so far, by all primitives created
+  // by this handle.
+  int num_decrypted_keys() const {
+    return state_->num_decrypted_keys.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Shared by the handle and the lazy entries of its primitives.
+  struct State {
+    std::unique_ptr<Aead> dek;
+    google::crypto::tink::KeysetInfo keyset_info;
+    std::vector<std::string> encrypted_keys;
+    mutable std::atomic<int> num_decrypted_keys{0};
+  };
+
+  explicit PerKeyEncryptedKeysetHandle(std::shared_ptr<const State> state)
+      : state_(std::move(state)) {}
+
+  // Decrypts the key at 'index' in the keyset, and checks that it matches
+  // its KeyInfo.
+  static crypto::tink::util::StatusOr<google::crypto::tink::KeyData>
+  DecryptKeyData(const State& state, int index);
+
+  std::shared_ptr<const State> state_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Implementation details of templated methods.
+
+template <class P>
+crypto::tink::util::StatusOr<std::unique_ptr<P>>
+PerKeyEncryptedKeysetHandle::GetPrimitive() const {
+  const google::crypto::tink::KeysetInfo& keyset_info = state_->keyset_info;
+  auto primitive_set = absl::make_unique<PrimitiveSet<P>>();
+  bool has_primary = false;
+  for (int i = 0; i < keyset_info.key_info_size(); i++) {
+    const google::crypto::tink::KeysetInfo::KeyInfo& key_info =
+        keyset_info.key_info(i);
+    if (key_info.status() != google::crypto::tink::KeyStatusType::ENABLED) {
+      continue;
+    }
+    const bool is_primary = key_info.key_id() == keyset_info.primary_key_id();
+    crypto::tink::util::StatusOr<typename PrimitiveSet<P>::template Entry<P>*>
+        entry_result;
+    if (is_primary) {
+      auto key_data_result = DecryptKeyData(*state_, i);
+      if (!key_data_result.ok()) return key_data_result.status();
+      auto primitive_result =
+          Registry::GetPrimitive<P>(key_data_result.ValueOrDie());
+      if (!primitive_result.ok()) return primitive_result.status();
+      entry_result = primitive_set->AddPrimitive(
+          std::move(primitive_result.ValueOrDie()), key_info);
+    } else {
+      std::shared_ptr<const State> state = state_;
+      entry_result = primitive_set->AddLazyPrimitive(
+          [state, i]() -> crypto::tink::util::StatusOr<std::unique_ptr<P>> {
+            auto key_data_result = DecryptKeyData(*state, i);
+            if (!key_data_result.ok()) return key_data_result.status();
+            return Registry::GetPrimitive<P>(key_data_result.ValueOrDie());
+          },
+          key_info);
+    }
+    if (!entry_result.ok()) return entry_result.status();
+    if (is_primary) {
+      auto primary_result =
+          primitive_set->set_primary(entry_result.ValueOrDie());
+      if (!primary_result.ok()) return primary_result;
+      has_primary = true;
+    }
+  }
+  if (!has_primary) {
+    return crypto::tink::util::Status(
+        crypto::tink::util::error::INVALID_ARGUMENT,
+        "keyset does not contain a valid primary key");
+  }
+  return Registry::Wrap<P>(std::move(primitive_set));
+}
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_PER_KEY_ENCRYPTED_KEYSET_HANDLE_H_
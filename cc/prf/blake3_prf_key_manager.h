@@ -0,0 +1,138 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_PRF_BLAKE3_PRF_KEY_MANAGER_H_
+#define TINK_PRF_BLAKE3_PRF_KEY_MANAGER_H_
+
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/core/key_type_manager.h"
+#include "tink/key_manager.h"
+#include "tink/subtle/blake3.h"
+#include "tink/subtle/cpu_features.h"
+#include "tink/subtle/prf/blake3_prf.h"
+#include "tink/subtle/random.h"
+#include "tink/util/constants.h"
+#include "tink/util/errors.h"
+#include "tink/util/input_stream_util.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/blake3_prf.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+class Blake3PrfKeyManager
+    : public KeyTypeManager<google::crypto::tink::Blake3PrfKey,
+                            google::crypto::tink::Blake3PrfKeyFormat,
+                            List<Prf>> {
+ public:
+  class PrfSetFactory : public PrimitiveFactory<Prf> {
+    crypto::tink::util::StatusOr<std::unique_ptr<Prf>> Create(
+        const google::crypto::tink::Blake3PrfKey& key) const override {
+      subtle::RecordImplementation("Blake3",
+                                   subtle::Blake3Hasher::Implementation());
+      return subtle::Blake3Prf::New(
+          util::SecretDataFromStringView(key.key_value()));
+    }
+  };
+
+  Blake3PrfKeyManager()
+      : KeyTypeManager(
+            absl::make_unique<Blake3PrfKeyManager::PrfSetFactory>()) {}
+
+  uint32_t get_version() const override { return 0; }
+
+  google::crypto::tink::KeyData::KeyMaterialType key_material_type()
+      const override {
+    return google::crypto::tink::KeyData::SYMMETRIC;
+  }
+
+  const std::string& get_key_type() const override { return key_type_; }
+
+  crypto::tink::util::Status ValidateKey(
+      const google::crypto::tink::Blake3PrfKey& key) const override {
+    crypto::tink::util::Status status =
+        ValidateVersion(key.version(), get_version());
+    if (!status.ok()) return status;
+    if (key.key_value().size() != subtle::Blake3Hasher::kKeySizeInBytes) {
+      return crypto::tink::util::Status(
+          util::error::INVALID_ARGUMENT,
+          "Invalid Blake3PrfKey: key_value wrong length.");
+    }
+    return util::OkStatus();
+  }
+
+  crypto::tink::util::Status ValidateKeyFormat(
+      const google::crypto::tink::Blake3PrfKeyFormat& key_format)
+      const override {
+    crypto::tink::util::Status status =
+        ValidateVersion(key_format.version(), get_version());
+    if (!status.ok()) return status;
+    if (key_format.key_size() != subtle::Blake3Hasher::kKeySizeInBytes) {
+      return crypto::tink::util::Status(
+          crypto::tink::util::error::INVALID_ARGUMENT,
+          "Invalid Blake3PrfKeyFormat: invalid key_size.");
+    }
+    return util::OkStatus();
+  }
+
+  crypto::tink::util::StatusOr<google::crypto::tink::Blake3PrfKey> CreateKey(
+      const google::crypto::tink::Blake3PrfKeyFormat& key_format)
+      const override {
+    google::crypto::tink::Blake3PrfKey key;
+    key.set_version(get_version());
+    key.set_key_value(subtle::Random::GetRandomBytes(key_format.key_size()));
+    return key;
+  }
+
+  crypto::tink::util::StatusOr<google::crypto::tink::Blake3PrfKey> DeriveKey(
+      const google::crypto::tink::Blake3PrfKeyFormat& key_format,
+      InputStream* input_stream) const override {
+    auto status = ValidateKeyFormat(key_format);
+    if (!status.ok()) {
+      return status;
+    }
+    crypto::tink::util::StatusOr<std::string> randomness =
+        ReadBytesFromStream(key_format.key_size(), input_stream);
+    if (!randomness.status().ok()) {
+      return randomness.status();
+    }
+    google::crypto::tink::Blake3PrfKey key;
+    key.set_version(get_version());
+    key.set_key_value(randomness.ValueOrDie());
+    return key;
+  }
+
+  FipsCompatibility FipsStatus() const override {
+    return FipsCompatibility::kNotFips;
+  }
+
+ private:
+  const std::string key_type_ = absl::StrCat(
+      kTypeGoogleapisCom, google::crypto::tink::Blake3PrfKey().GetTypeName());
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_PRF_BLAKE3_PRF_KEY_MANAGER_H_
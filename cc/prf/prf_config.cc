@@ -15,9 +15,11 @@
 
 #include "tink/config/tink_fips.h"
 #include "tink/prf/aes_cmac_prf_key_manager.h"
+#include "tink/prf/blake3_prf_key_manager.h"
 #include "tink/prf/hkdf_prf_key_manager.h"
 #include "tink/prf/hmac_prf_key_manager.h"
 #include "tink/prf/prf_set_wrapper.h"
+#include "tink/prf/siphash_prf_key_manager.h"
 #include "tink/registry.h"
 #include "tink/util/status.h"
 
@@ -46,6 +48,18 @@ crypto::tink::util::Status PrfConfig::Register() {
   if (!status.ok()) {
     return status;
   }
+
+  status = Registry::RegisterKeyTypeManager(
+      absl::make_unique<Blake3PrfKeyManager>(), true);
+  if (!status.ok()) {
+    return status;
+  }
+
+  status = Registry::RegisterKeyTypeManager(
+      absl::make_unique<SipHashPrfKeyManager>(), true);
+  if (!status.ok()) {
+    return status;
+  }
   return util::OkStatus();
 }
 
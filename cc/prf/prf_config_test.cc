@@ -65,6 +65,8 @@ TEST_F(PrfConfigTest, RegisterNonFipsTemplates) {
   std::list<google::crypto::tink::KeyTemplate> non_fips_key_templates;
   non_fips_key_templates.push_back(PrfKeyTemplates::HkdfSha256());
   non_fips_key_templates.push_back(PrfKeyTemplates::AesCmac());
+  non_fips_key_templates.push_back(PrfKeyTemplates::Blake3());
+  non_fips_key_templates.push_back(PrfKeyTemplates::SipHash24());
 
   for (auto key_template : non_fips_key_templates) {
     auto new_keyset_handle_result = KeysetHandle::GenerateNew(key_template);
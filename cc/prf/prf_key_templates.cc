@@ -15,11 +15,15 @@
 
 #include "absl/memory/memory.h"
 #include "tink/prf/aes_cmac_prf_key_manager.h"
+#include "tink/prf/blake3_prf_key_manager.h"
 #include "tink/prf/hkdf_prf_key_manager.h"
 #include "tink/prf/hmac_prf_key_manager.h"
+#include "tink/prf/siphash_prf_key_manager.h"
 #include "proto/aes_cmac_prf.pb.h"
+#include "proto/blake3_prf.pb.h"
 #include "proto/hkdf_prf.pb.h"
 #include "proto/hmac_prf.pb.h"
+#include "proto/siphash_prf.pb.h"
 
 namespace crypto {
 namespace tink {
@@ -27,8 +31,10 @@ namespace tink {
 namespace {
 
 using google::crypto::tink::AesCmacPrfKeyFormat;
+using google::crypto::tink::Blake3PrfKeyFormat;
 using google::crypto::tink::HkdfPrfKeyFormat;
 using google::crypto::tink::HmacPrfKeyFormat;
+using google::crypto::tink::SipHashPrfKeyFormat;
 
 std::unique_ptr<google::crypto::tink::KeyTemplate> NewHkdfSha256Template() {
   auto key_template = absl::make_unique<google::crypto::tink::KeyTemplate>();
@@ -72,6 +78,32 @@ std::unique_ptr<google::crypto::tink::KeyTemplate> NewAesCmacTemplate() {
   return key_template;
 }
 
+std::unique_ptr<google::crypto::tink::KeyTemplate> NewBlake3Template() {
+  auto key_template = absl::make_unique<google::crypto::tink::KeyTemplate>();
+  auto blake3_prf_key_manager = absl::make_unique<Blake3PrfKeyManager>();
+  key_template->set_type_url(blake3_prf_key_manager->get_key_type());
+  key_template->set_output_prefix_type(
+      google::crypto::tink::OutputPrefixType::RAW);
+  Blake3PrfKeyFormat key_format;
+  key_format.set_version(blake3_prf_key_manager->get_version());
+  key_format.set_key_size(32);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
+std::unique_ptr<google::crypto::tink::KeyTemplate> NewSipHash24Template() {
+  auto key_template = absl::make_unique<google::crypto::tink::KeyTemplate>();
+  auto siphash_prf_key_manager = absl::make_unique<SipHashPrfKeyManager>();
+  key_template->set_type_url(siphash_prf_key_manager->get_key_type());
+  key_template->set_output_prefix_type(
+      google::crypto::tink::OutputPrefixType::RAW);
+  SipHashPrfKeyFormat key_format;
+  key_format.set_version(siphash_prf_key_manager->get_version());
+  key_format.set_key_size(16);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
 }  // namespace
 
 const google::crypto::tink::KeyTemplate& PrfKeyTemplates::HkdfSha256() {
@@ -98,5 +130,17 @@ const google::crypto::tink::KeyTemplate& PrfKeyTemplates::AesCmac() {
   return *key_template;
 }
 
+const google::crypto::tink::KeyTemplate& PrfKeyTemplates::Blake3() {
+  static const google::crypto::tink::KeyTemplate* key_template =
+      NewBlake3Template().release();
+  return *key_template;
+}
+
+const google::crypto::tink::KeyTemplate& PrfKeyTemplates::SipHash24() {
+  static const google::crypto::tink::KeyTemplate* key_template =
+      NewSipHash24Template().release();
+  return *key_template;
+}
+
 }  // namespace tink
 }  // namespace crypto
@@ -39,6 +39,14 @@ class PrfKeyTemplates {
   static const google::crypto::tink::KeyTemplate& HmacSha256();
   static const google::crypto::tink::KeyTemplate& HmacSha512();
   static const google::crypto::tink::KeyTemplate& AesCmac();
+  // Blake3
+  //  * Key size: 256 bit
+  //  * Output length: any, via Prf::Compute()
+  static const google::crypto::tink::KeyTemplate& Blake3();
+  // SipHash-2-4
+  //  * Key size: 128 bit
+  //  * Output length: at most 8 bytes, see Prf::Compute64()
+  static const google::crypto::tink::KeyTemplate& SipHash24();
 };
 
 }  // namespace tink
@@ -18,11 +18,15 @@
 #include "gtest/gtest.h"
 #include "absl/memory/memory.h"
 #include "tink/prf/aes_cmac_prf_key_manager.h"
+#include "tink/prf/blake3_prf_key_manager.h"
 #include "tink/prf/hkdf_prf_key_manager.h"
 #include "tink/prf/hmac_prf_key_manager.h"
+#include "tink/prf/siphash_prf_key_manager.h"
 #include "tink/util/test_matchers.h"
 #include "proto/aes_cmac_prf.pb.h"
+#include "proto/blake3_prf.pb.h"
 #include "proto/hmac_prf.pb.h"
+#include "proto/siphash_prf.pb.h"
 
 namespace crypto {
 namespace tink {
@@ -108,6 +112,47 @@ TEST(CmacPrfTest, MultipleCallsSameReference) {
   EXPECT_THAT(PrfKeyTemplates::AesCmac(), Ref(PrfKeyTemplates::AesCmac()));
 }
 
+TEST(Blake3PrfTest, Basics) {
+  EXPECT_THAT(PrfKeyTemplates::Blake3().type_url(),
+              Eq("type.googleapis.com/google.crypto.tink.Blake3PrfKey"));
+  auto manager = absl::make_unique<Blake3PrfKeyManager>();
+  EXPECT_THAT(PrfKeyTemplates::Blake3().type_url(),
+              Eq(manager->get_key_type()));
+  google::crypto::tink::Blake3PrfKeyFormat format;
+  ASSERT_TRUE(format.ParseFromString(PrfKeyTemplates::Blake3().value()));
+  EXPECT_THAT(manager->ValidateKeyFormat(format), IsOk());
+}
+
+TEST(Blake3PrfTest, OutputPrefixType) {
+  EXPECT_THAT(PrfKeyTemplates::Blake3().output_prefix_type(),
+              Eq(google::crypto::tink::OutputPrefixType::RAW));
+}
+
+TEST(Blake3PrfTest, MultipleCallsSameReference) {
+  EXPECT_THAT(PrfKeyTemplates::Blake3(), Ref(PrfKeyTemplates::Blake3()));
+}
+
+TEST(SipHashPrfTest, Basics) {
+  EXPECT_THAT(PrfKeyTemplates::SipHash24().type_url(),
+              Eq("type.googleapis.com/google.crypto.tink.SipHashPrfKey"));
+  auto manager = absl::make_unique<SipHashPrfKeyManager>();
+  EXPECT_THAT(PrfKeyTemplates::SipHash24().type_url(),
+              Eq(manager->get_key_type()));
+  google::crypto::tink::SipHashPrfKeyFormat format;
+  ASSERT_TRUE(format.ParseFromString(PrfKeyTemplates::SipHash24().value()));
+  EXPECT_THAT(manager->ValidateKeyFormat(format), IsOk());
+}
+
+TEST(SipHashPrfTest, OutputPrefixType) {
+  EXPECT_THAT(PrfKeyTemplates::SipHash24().output_prefix_type(),
+              Eq(google::crypto::tink::OutputPrefixType::RAW));
+}
+
+TEST(SipHashPrfTest, MultipleCallsSameReference) {
+  EXPECT_THAT(PrfKeyTemplates::SipHash24(),
+              Ref(PrfKeyTemplates::SipHash24()));
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
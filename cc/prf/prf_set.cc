@@ -14,18 +14,80 @@
 
 #include "tink/prf/prf_set.h"
 
+#include <algorithm>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
 namespace crypto {
 namespace tink {
 
+util::Status Prf::ComputeBatch(absl::Span<const absl::string_view> inputs,
+                               size_t output_length,
+                               absl::Span<uint8_t> out) const {
+  if (out.size() != inputs.size() * output_length) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("Output buffer has ", out.size(), " bytes, but ",
+                     inputs.size() * output_length, " bytes are needed"));
+  }
+  uint8_t* next = out.data();
+  for (absl::string_view input : inputs) {
+    auto output_result = Compute(input, output_length);
+    if (!output_result.ok()) return output_result.status();
+    const std::string& output = output_result.ValueOrDie();
+    if (output.size() != output_length) {
+      return util::Status(util::error::INTERNAL,
+                          "PRF returned an output of the wrong length");
+    }
+    next = std::copy(output.begin(), output.end(), next);
+  }
+  return util::OkStatus();
+}
+
+util::StatusOr<uint64_t> Prf::Compute64(absl::string_view input) const {
+  auto output_result = Compute(input, sizeof(uint64_t));
+  if (!output_result.ok()) return output_result.status();
+  const std::string& output = output_result.ValueOrDie();
+  if (output.size() != sizeof(uint64_t)) {
+    return util::Status(util::error::INTERNAL,
+                        "PRF returned an output of the wrong length");
+  }
+  uint64_t value = 0;
+  for (int i = sizeof(uint64_t) - 1; i >= 0; i--) {
+    value = (value << 8) | static_cast<uint8_t>(output[i]);
+  }
+  return value;
+}
+
+const Prf* PrfSet::GetPrimaryPrf() const {
+  const std::map<uint32_t, Prf*>& prfs = GetPrfs();
+  auto prf_it = prfs.find(GetPrimaryId());
+  return prf_it == prfs.end() ? nullptr : prf_it->second;
+}
+
 util::StatusOr<std::string> PrfSet::ComputePrimary(absl::string_view input,
                                                    size_t output_length) const {
-  auto prfs = GetPrfs();
-  auto prf_it = prfs.find(GetPrimaryId());
-  if (prf_it == prfs.end()) {
+  const Prf* prf = GetPrimaryPrf();
+  if (prf == nullptr) {
+    return util::Status(util::error::INTERNAL,
+                        "PrfSet has no PRF for primary ID.");
+  }
+  return prf->Compute(input, output_length);
+}
+
+util::StatusOr<uint64_t> PrfSet::ComputePrimary64(
+    absl::string_view input) const {
+  const Prf* prf = GetPrimaryPrf();
+  if (prf == nullptr) {
     return util::Status(util::error::INTERNAL,
                         "PrfSet has no PRF for primary ID.");
   }
-  return prf_it->second->Compute(input, output_length);
+  return prf->Compute64(input);
 }
 
 }  // namespace tink
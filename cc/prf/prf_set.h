@@ -18,6 +18,8 @@
 #include <map>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -56,6 +58,27 @@ class Prf {
   // algorithm is less than outputLength.
   virtual util::StatusOr<std::string> Compute(absl::string_view input,
                                               size_t output_length) const = 0;
+
+  // Computes the PRF on every element of 'inputs', and writes the first
+  // output_length bytes of the output on inputs[i] to
+  // out[i * output_length, (i + 1) * output_length).  'out' must be exactly
+  // inputs.size() * output_length bytes long.  Either all outputs are
+  // written or an error is returned.
+  //
+  // The default implementation calls Compute() for every input;
+  // implementations override it to amortize work across inputs.
+  virtual util::Status ComputeBatch(absl::Span<const absl::string_view> inputs,
+                                    size_t output_length,
+                                    absl::Span<uint8_t> out) const;
+
+  // Returns the first 8 bytes of the PRF output on 'input' as a
+  // little-endian integer, i.e. Compute(input, 8) decoded as little-endian.
+  // Meant for hash table and sharding keys, where the std::string returned
+  // by Compute() can cost more than the PRF itself.
+  //
+  // The default implementation calls Compute(); PRFs with a native 64-bit
+  // output, such as SipHashPrf, override it.
+  virtual util::StatusOr<uint64_t> Compute64(absl::string_view input) const;
 };
 
 // A Tink Keyset can be converted into a set of PRFs using this primitive. Every
@@ -74,6 +97,14 @@ class PrfSet {
   // See PRF.compute for details of the parameters.
   util::StatusOr<std::string> ComputePrimary(absl::string_view input,
                                              size_t output_length) const;
+  // Convenience method to compute Prf::Compute64() of the primary PRF.
+  util::StatusOr<uint64_t> ComputePrimary64(absl::string_view input) const;
+
+ protected:
+  // Returns the primary PRF, or nullptr if GetPrfs() does not contain it.
+  // The default implementation looks it up in GetPrfs(); implementations
+  // which know it upfront override this to skip the lookup.
+  virtual const Prf* GetPrimaryPrf() const;
 };
 
 }  // namespace tink
@@ -15,16 +15,20 @@
 #include "tink/prf/prf_set.h"
 
 #include <map>
+#include <string>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/keyset_handle.h"
 #include "tink/keyset_manager.h"
 #include "tink/prf/prf_config.h"
 #include "tink/prf/prf_key_templates.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "tink/util/test_matchers.h"
 #include "tink/util/test_util.h"
@@ -34,6 +38,7 @@ namespace tink {
 namespace {
 
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
 using ::testing::_;
 using ::testing::Eq;
 using ::testing::Pair;
@@ -48,6 +53,17 @@ class DummyPrf : public Prf {
   }
 };
 
+// Returns the first output_length bytes of the input.
+class PrefixPrf : public Prf {
+  util::StatusOr<std::string> Compute(absl::string_view input,
+                                      size_t output_length) const override {
+    if (input.size() < output_length) {
+      return util::Status(util::error::INVALID_ARGUMENT, "input too short");
+    }
+    return std::string(input.substr(0, output_length));
+  }
+};
+
 class DummyPrfSet : public PrfSet {
  public:
   uint32_t GetPrimaryId() const override { return 1; }
@@ -81,6 +97,52 @@ TEST(PrfSetTest, ComputePrimary) {
       << "Expected broken PrfSet to not be able to compute the primary PRF";
 }
 
+TEST(PrfSetTest, ComputePrimary64) {
+  DummyPrfSet prfset;
+  auto output = prfset.ComputePrimary64("DummyInput");
+  ASSERT_THAT(output.status(), IsOk());
+  // Little-endian "DummyPRF".
+  EXPECT_THAT(output.ValueOrDie(), Eq(0x465250796d6d7544ULL));
+  EXPECT_FALSE(BrokenDummyPrfSet().ComputePrimary64("DummyInput").ok());
+}
+
+TEST(PrfTest, Compute64) {
+  PrefixPrf prf;
+  auto output = prf.Compute64("\x01\x02\x03\x04\x05\x06\x07\x08\x09");
+  ASSERT_THAT(output.status(), IsOk());
+  EXPECT_THAT(output.ValueOrDie(), Eq(0x0807060504030201ULL));
+  EXPECT_THAT(prf.Compute64("short").status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(PrfTest, ComputeBatch) {
+  PrefixPrf prf;
+  std::vector<absl::string_view> inputs = {"abcd", "efgh", "ijklmn"};
+  std::string out(12, '\0');
+  ASSERT_THAT(
+      prf.ComputeBatch(inputs, 4,
+                       absl::MakeSpan(reinterpret_cast<uint8_t*>(&out[0]),
+                                      out.size())),
+      IsOk());
+  EXPECT_THAT(out, StrEq("abcdefghijkl"));
+
+  // Empty batch.
+  EXPECT_THAT(prf.ComputeBatch({}, 4, absl::Span<uint8_t>()), IsOk());
+  // Wrong output buffer size.
+  EXPECT_THAT(
+      prf.ComputeBatch(inputs, 4,
+                       absl::MakeSpan(reinterpret_cast<uint8_t*>(&out[0]),
+                                      out.size() - 1)),
+      StatusIs(util::error::INVALID_ARGUMENT));
+  // Compute() fails on the last input.
+  out.resize(15);
+  EXPECT_THAT(
+      prf.ComputeBatch(inputs, 5,
+                       absl::MakeSpan(reinterpret_cast<uint8_t*>(&out[0]),
+                                      out.size())),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 TEST(PrfSetWrapperTest, TestPrimitivesEndToEnd) {
   auto status = PrfConfig::Register();
   ASSERT_TRUE(status.ok()) << status;
@@ -145,6 +207,17 @@ TEST(PrfSetWrapperTest, TestPrimitivesEndToEnd) {
       if (output_result.ok()) {
         EXPECT_THAT(output_result.ValueOrDie(), StrEq(output));
       }
+      std::vector<absl::string_view> batch = {input, input2};
+      std::string batch_output(2 * output_length, '\0');
+      EXPECT_THAT(prf.second->ComputeBatch(
+                      batch, output_length,
+                      absl::MakeSpan(
+                          reinterpret_cast<uint8_t*>(&batch_output[0]),
+                          batch_output.size())),
+                  IsOk());
+      EXPECT_THAT(batch_output,
+                  StrEq(absl::StrCat(results[results.size() - 2],
+                                     results[results.size() - 1])));
     }
     for (int i = 0; i < results.size(); i++) {
       EXPECT_THAT(results[i], SizeIs(output_length));
@@ -27,7 +27,8 @@ namespace {
 class PrfSetPrimitiveWrapper : public PrfSet {
  public:
   explicit PrfSetPrimitiveWrapper(std::unique_ptr<PrimitiveSet<Prf>> prf_set)
-      : prf_set_(std::move(prf_set)) {
+      : prf_set_(std::move(prf_set)),
+        primary_(&prf_set_->get_primary()->get_primitive()) {
     for (const auto& prf : *prf_set_->get_raw_primitives().ValueOrDie()) {
       prfs_.insert({prf->get_key_id(), &prf->get_primitive()});
     }
@@ -40,8 +41,14 @@ class PrfSetPrimitiveWrapper : public PrfSet {
 
   ~PrfSetPrimitiveWrapper() override {}
 
+ protected:
+  // The primary is kept at hand, so that ComputePrimary() does not look it
+  // up in prfs_ on every call.
+  const Prf* GetPrimaryPrf() const override { return primary_; }
+
  private:
   std::unique_ptr<PrimitiveSet<Prf>> prf_set_;
+  const Prf* const primary_;
   std::map<uint32_t, Prf*> prfs_;
 };
 
@@ -59,7 +66,8 @@ util::Status Validate(PrimitiveSet<Prf>* prf_set) {
                           "PrfSet should only be used with prefix type RAW");
     }
   }
-  return util::Status::OK;
+  // Materializes lazy entries, which PrfSetPrimitiveWrapper needs.
+  return prf_set->get_raw_primitives().status();
 }
 
 }  // namespace
@@ -68,6 +76,7 @@ util::StatusOr<std::unique_ptr<PrfSet>> PrfSetWrapper::Wrap(
     std::unique_ptr<PrimitiveSet<Prf>> prf_set) const {
   util::Status status = Validate(prf_set.get());
   if (!status.ok()) return status;
+  prf_set->Freeze();
   return {absl::make_unique<PrfSetPrimitiveWrapper>(std::move(prf_set))};
 }
 
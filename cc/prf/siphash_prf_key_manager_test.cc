@@ -0,0 +1,131 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/prf/siphash_prf_key_manager.h"
+
+#include <sstream>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/config/tink_fips.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "proto/siphash_prf.pb.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::google::crypto::tink::SipHashPrfKey;
+using ::google::crypto::tink::SipHashPrfKeyFormat;
+using ::testing::Eq;
+using ::testing::Not;
+using ::testing::SizeIs;
+
+std::unique_ptr<InputStream> GetInputStreamForString(const std::string& input) {
+  return absl::make_unique<util::IstreamInputStream>(
+      absl::make_unique<std::stringstream>(input));
+}
+
+SipHashPrfKeyFormat ValidKeyFormat() {
+  SipHashPrfKeyFormat format;
+  format.set_key_size(16);
+  return format;
+}
+
+TEST(SipHashPrfKeyManagerTest, Basics) {
+  EXPECT_THAT(SipHashPrfKeyManager().get_version(), Eq(0));
+  EXPECT_THAT(SipHashPrfKeyManager().get_key_type(),
+              Eq("type.googleapis.com/google.crypto.tink.SipHashPrfKey"));
+  EXPECT_THAT(SipHashPrfKeyManager().key_material_type(),
+              Eq(google::crypto::tink::KeyData::SYMMETRIC));
+  EXPECT_THAT(SipHashPrfKeyManager::MaxOutputLength(), Eq(8));
+}
+
+TEST(SipHashPrfKeyManagerTest, ValidateKeyFormat) {
+  EXPECT_THAT(SipHashPrfKeyManager().ValidateKeyFormat(SipHashPrfKeyFormat()),
+              Not(IsOk()));
+  SipHashPrfKeyFormat format = ValidKeyFormat();
+  EXPECT_THAT(SipHashPrfKeyManager().ValidateKeyFormat(format), IsOk());
+  for (int key_size : {1, 8, 15, 17, 32}) {
+    format.set_key_size(key_size);
+    EXPECT_THAT(SipHashPrfKeyManager().ValidateKeyFormat(format), Not(IsOk()))
+        << key_size;
+  }
+  format = ValidKeyFormat();
+  format.set_version(1);
+  EXPECT_THAT(SipHashPrfKeyManager().ValidateKeyFormat(format), Not(IsOk()));
+}
+
+TEST(SipHashPrfKeyManagerTest, CreateKey) {
+  auto key_or = SipHashPrfKeyManager().CreateKey(ValidKeyFormat());
+  ASSERT_THAT(key_or.status(), IsOk());
+  SipHashPrfKey key = key_or.ValueOrDie();
+  EXPECT_THAT(key.version(), Eq(0));
+  EXPECT_THAT(key.key_value(), SizeIs(16));
+  EXPECT_THAT(SipHashPrfKeyManager().ValidateKey(key), IsOk());
+}
+
+TEST(SipHashPrfKeyManagerTest, ValidateKey) {
+  EXPECT_THAT(SipHashPrfKeyManager().ValidateKey(SipHashPrfKey()),
+              Not(IsOk()));
+  SipHashPrfKey key =
+      SipHashPrfKeyManager().CreateKey(ValidKeyFormat()).ValueOrDie();
+  key.set_version(1);
+  EXPECT_THAT(SipHashPrfKeyManager().ValidateKey(key), Not(IsOk()));
+  key.set_version(0);
+  key.set_key_value("01234567");
+  EXPECT_THAT(SipHashPrfKeyManager().ValidateKey(key), Not(IsOk()));
+}
+
+TEST(SipHashPrfKeyManagerTest, GetPrimitive) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  SipHashPrfKey key;
+  // The key of the test vectors of the SipHash reference implementation.
+  std::string key_value(16, '\0');
+  for (int i = 0; i < key_value.size(); i++) key_value[i] = i;
+  key.set_key_value(key_value);
+  auto prf_or = SipHashPrfKeyManager().GetPrimitive<Prf>(key);
+  ASSERT_THAT(prf_or.status(), IsOk());
+  auto output_or = prf_or.ValueOrDie()->Compute64("");
+  ASSERT_THAT(output_or.status(), IsOk());
+  EXPECT_THAT(output_or.ValueOrDie(), Eq(0x726fdb47dd0e0e31ULL));
+}
+
+TEST(SipHashPrfKeyManagerTest, DeriveKey) {
+  std::string bytes = "0123456789abcdef";
+  auto inputstream = GetInputStreamForString(bytes);
+  auto key_or =
+      SipHashPrfKeyManager().DeriveKey(ValidKeyFormat(), inputstream.get());
+  ASSERT_THAT(key_or.status(), IsOk());
+  EXPECT_THAT(key_or.ValueOrDie().key_value(), Eq(bytes));
+
+  inputstream = GetInputStreamForString("01234567");
+  EXPECT_THAT(
+      SipHashPrfKeyManager().DeriveKey(ValidKeyFormat(), inputstream.get())
+          .status(),
+      Not(IsOk()));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,54 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/prf/tenant_key_deriver.h"
+
+#include <sstream>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/internal/registry_impl.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/util/istream_input_stream.h"
+
+namespace crypto {
+namespace tink {
+
+using ::google::crypto::tink::KeyData;
+using ::google::crypto::tink::KeyTemplate;
+
+util::StatusOr<KeyData> DeriveTenantKeyData(const PrfSet& master_prf_set,
+                                            const KeyTemplate& key_template,
+                                            absl::string_view tenant_id) {
+  // The lengths keep the encoding unambiguous, so that e.g. the keys of a
+  // 128-bit and a 256-bit template are unrelated.
+  std::string input = absl::StrCat(
+      subtle::BigEndian32(key_template.type_url().size()),
+      key_template.type_url(), subtle::BigEndian32(key_template.value().size()),
+      key_template.value(), tenant_id);
+  auto key_material_result =
+      master_prf_set.ComputePrimary(input, kTenantKeyMaterialSize);
+  if (!key_material_result.ok()) return key_material_result.status();
+  util::IstreamInputStream randomness(absl::make_unique<std::stringstream>(
+      std::move(key_material_result.ValueOrDie())));
+  return internal::RegistryImpl::GlobalInstance().DeriveKey(key_template,
+                                                           &randomness);
+}
+
+}  // namespace tink
+}  // namespace crypto
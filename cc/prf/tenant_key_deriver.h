@@ -0,0 +1,175 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_PRF_TENANT_KEY_DERIVER_H_
+#define TINK_PRF_TENANT_KEY_DERIVER_H_
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/prf/prf_set.h"
+#include "tink/registry.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// Derives the key of tenant 'tenant_id' for 'key_template' from the primary
+// PRF of 'master_prf_set', with the DeriveKey() of the key manager of the
+// template. The PRF is evaluated on an encoding of the template and the
+// tenant id, so that every template and tenant gets an independent key, and
+// must support outputs of kTenantKeyMaterialSize bytes: use an HKDF master
+// key, e.g. of PrfKeyTemplates::HkdfSha256().
+crypto::tink::util::StatusOr<google::crypto::tink::KeyData>
+DeriveTenantKeyData(const PrfSet& master_prf_set,
+                    const google::crypto::tink::KeyTemplate& key_template,
+                    absl::string_view tenant_id);
+
+// The number of PRF output bytes DeriveTenantKeyData() reads.
+constexpr size_t kTenantKeyMaterialSize = 128;
+
+// Creates the primitives of many tenants from a single master PRF keyset,
+// instead of storing a keyset per tenant: the key of a tenant is derived
+// with DeriveTenantKeyData() when it is first needed, which takes a few
+// microseconds, and the primitives of the most recently used tenants are
+// kept in a bounded LRU cache.
+//
+//   auto deriver = TenantPrimitiveDeriver<Aead>::New(
+//       master_handle->GetPrimitive<PrfSet>().ValueOrDie(),
+//       AeadKeyTemplates::Aes256Gcm(), /* max_cached_tenants= */ 10000);
+//   ...
+//   auto aead = deriver.ValueOrDie()->Get(tenant_id);
+//
+// The primitives are those of a single RAW key: their outputs have no
+// prefix. Rotating the master key changes the keys of all tenants, so data
+// which outlives a master key must be re-encrypted, or decrypted with a
+// deriver for the old master key.
+//
+// This class is thread safe.
+template <class P>
+class TenantPrimitiveDeriver {
+ public:
+  // 'master_prf_set' is the PrfSet of the master keyset, and 'key_template'
+  // the template of the tenant keys, whose key manager must be registered
+  // and support DeriveKey(). Derives a key once to check both.
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<TenantPrimitiveDeriver<P>>>
+  New(std::unique_ptr<PrfSet> master_prf_set,
+      const google::crypto::tink::KeyTemplate& key_template,
+      int max_cached_tenants) {
+    if (master_prf_set == nullptr) {
+      return crypto::tink::util::Status(crypto::tink::util::error::INTERNAL,
+                                        "master_prf_set must be non-null");
+    }
+    if (max_cached_tenants < 0) {
+      return crypto::tink::util::Status(
+          crypto::tink::util::error::INVALID_ARGUMENT,
+          "max_cached_tenants must be non-negative");
+    }
+    auto deriver = absl::WrapUnique(new TenantPrimitiveDeriver<P>(
+        std::move(master_prf_set), key_template, max_cached_tenants));
+    auto primitive_result = deriver->Derive("");
+    if (!primitive_result.ok()) return primitive_result.status();
+    return std::move(deriver);
+  }
+
+  TenantPrimitiveDeriver(const TenantPrimitiveDeriver&) = delete;
+  TenantPrimitiveDeriver& operator=(const TenantPrimitiveDeriver&) = delete;
+
+  // Returns the primitive of tenant 'tenant_id'.
+  crypto::tink::util::StatusOr<std::shared_ptr<P>> Get(
+      absl::string_view tenant_id) ABSL_LOCKS_EXCLUDED(mutex_) {
+    {
+      absl::MutexLock lock(&mutex_);
+      auto it = cache_.find(tenant_id);
+      if (it != cache_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+        return it->second.primitive;
+      }
+    }
+    // Derive without holding the lock, so that new tenants do not wait for
+    // each other.
+    auto primitive_result = Derive(tenant_id);
+    if (!primitive_result.ok()) return primitive_result.status();
+    std::shared_ptr<P> primitive = std::move(primitive_result.ValueOrDie());
+    if (max_cached_tenants_ == 0) return primitive;
+
+    absl::MutexLock lock(&mutex_);
+    auto it = cache_.find(tenant_id);
+    if (it != cache_.end()) return it->second.primitive;
+    if (cache_.size() >= static_cast<size_t>(max_cached_tenants_)) {
+      cache_.erase(lru_.back());
+      lru_.pop_back();
+    }
+    lru_.emplace_front(tenant_id);
+    cache_.emplace(lru_.front(), CacheEntry{primitive, lru_.begin()});
+    return primitive;
+  }
+
+  // Returns the number of tenants whose primitive is cached.
+  size_t num_cached_tenants() const ABSL_LOCKS_EXCLUDED(mutex_) {
+    absl::MutexLock lock(&mutex_);
+    return cache_.size();
+  }
+
+ private:
+  struct CacheEntry {
+    std::shared_ptr<P> primitive;
+    std::list<std::string>::iterator lru_position;
+  };
+
+  TenantPrimitiveDeriver(std::unique_ptr<PrfSet> master_prf_set,
+                         const google::crypto::tink::KeyTemplate& key_template,
+                         int max_cached_tenants)
+      : master_prf_set_(std::move(master_prf_set)),
+        key_template_(key_template),
+        max_cached_tenants_(max_cached_tenants) {}
+
+  crypto::tink::util::StatusOr<std::unique_ptr<P>> Derive(
+      absl::string_view tenant_id) const {
+    auto key_data_result =
+        DeriveTenantKeyData(*master_prf_set_, key_template_, tenant_id);
+    if (!key_data_result.ok()) return key_data_result.status();
+    return Registry::GetPrimitive<P>(key_data_result.ValueOrDie());
+  }
+
+  const std::unique_ptr<PrfSet> master_prf_set_;
+  const google::crypto::tink::KeyTemplate key_template_;
+  const int max_cached_tenants_;
+
+  mutable absl::Mutex mutex_;
+  // Tenant ids, the most recently used first. The keys of cache_ point into
+  // these strings.
+  std::list<std::string> lru_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<absl::string_view, CacheEntry> cache_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_PRF_TENANT_KEY_DERIVER_H_
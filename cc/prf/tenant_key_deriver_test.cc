@@ -0,0 +1,167 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/prf/tenant_key_deriver.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/aead.h"
+#include "tink/aead/aead_config.h"
+#include "tink/aead/aead_key_templates.h"
+#include "tink/keyset_handle.h"
+#include "tink/prf/prf_config.h"
+#include "tink/prf/prf_key_templates.h"
+#include "tink/prf/prf_set.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::google::crypto::tink::KeyData;
+using ::testing::Eq;
+using ::testing::Ne;
+using ::testing::Not;
+
+class TenantKeyDeriverTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_THAT(AeadConfig::Register(), IsOk());
+    ASSERT_THAT(PrfConfig::Register(), IsOk());
+    auto handle_result =
+        KeysetHandle::GenerateNew(PrfKeyTemplates::HkdfSha256());
+    ASSERT_THAT(handle_result.status(), IsOk());
+    master_handle_ = std::move(handle_result.ValueOrDie());
+  }
+
+  std::unique_ptr<PrfSet> MasterPrfSet() {
+    return std::move(master_handle_->GetPrimitive<PrfSet>().ValueOrDie());
+  }
+
+  std::unique_ptr<TenantPrimitiveDeriver<Aead>> NewDeriver(
+      int max_cached_tenants) {
+    auto deriver_result = TenantPrimitiveDeriver<Aead>::New(
+        MasterPrfSet(), AeadKeyTemplates::Aes128Gcm(), max_cached_tenants);
+    EXPECT_THAT(deriver_result.status(), IsOk());
+    return std::move(deriver_result.ValueOrDie());
+  }
+
+  std::unique_ptr<KeysetHandle> master_handle_;
+};
+
+TEST_F(TenantKeyDeriverTest, DeriveTenantKeyData) {
+  std::unique_ptr<PrfSet> prf_set = MasterPrfSet();
+  auto key_data_result = DeriveTenantKeyData(
+      *prf_set, AeadKeyTemplates::Aes128Gcm(), "tenant 1");
+  ASSERT_THAT(key_data_result.status(), IsOk());
+  const KeyData& key_data = key_data_result.ValueOrDie();
+  EXPECT_THAT(key_data.type_url(),
+              Eq(AeadKeyTemplates::Aes128Gcm().type_url()));
+
+  EXPECT_THAT(DeriveTenantKeyData(*prf_set, AeadKeyTemplates::Aes128Gcm(),
+                                  "tenant 1")
+                  .ValueOrDie()
+                  .value(),
+              Eq(key_data.value()));
+  EXPECT_THAT(DeriveTenantKeyData(*prf_set, AeadKeyTemplates::Aes128Gcm(),
+                                  "tenant 2")
+                  .ValueOrDie()
+                  .value(),
+              Ne(key_data.value()));
+}
+
+TEST_F(TenantKeyDeriverTest, TenantsHaveTheirOwnKeys) {
+  std::unique_ptr<TenantPrimitiveDeriver<Aead>> deriver = NewDeriver(10);
+  auto aead_result = deriver->Get("tenant 1");
+  ASSERT_THAT(aead_result.status(), IsOk());
+  std::string ciphertext =
+      aead_result.ValueOrDie()->Encrypt("plaintext", "ad").ValueOrDie();
+
+  // Another deriver for the same master key derives the same key.
+  auto other_aead_result = NewDeriver(10)->Get("tenant 1");
+  ASSERT_THAT(other_aead_result.status(), IsOk());
+  EXPECT_THAT(other_aead_result.ValueOrDie()->Decrypt(ciphertext, "ad"),
+              IsOkAndHolds("plaintext"));
+
+  auto tenant_2_result = deriver->Get("tenant 2");
+  ASSERT_THAT(tenant_2_result.status(), IsOk());
+  EXPECT_THAT(tenant_2_result.ValueOrDie()->Decrypt(ciphertext, "ad").status(),
+              Not(IsOk()));
+}
+
+TEST_F(TenantKeyDeriverTest, LeastRecentlyUsedTenantsAreDropped) {
+  std::unique_ptr<TenantPrimitiveDeriver<Aead>> deriver = NewDeriver(2);
+  std::shared_ptr<Aead> a = deriver->Get("a").ValueOrDie();
+  std::shared_ptr<Aead> b = deriver->Get("b").ValueOrDie();
+  EXPECT_THAT(deriver->Get("a").ValueOrDie(), Eq(a));
+  EXPECT_THAT(deriver->num_cached_tenants(), Eq(2));
+
+  // "b" is the least recently used tenant.
+  ASSERT_THAT(deriver->Get("c").status(), IsOk());
+  EXPECT_THAT(deriver->num_cached_tenants(), Eq(2));
+  EXPECT_THAT(deriver->Get("a").ValueOrDie(), Eq(a));
+  EXPECT_THAT(deriver->Get("b").ValueOrDie(), Ne(b));
+}
+
+TEST_F(TenantKeyDeriverTest, NoCache) {
+  std::unique_ptr<TenantPrimitiveDeriver<Aead>> deriver = NewDeriver(0);
+  std::shared_ptr<Aead> a = deriver->Get("a").ValueOrDie();
+  EXPECT_THAT(deriver->Get("a").ValueOrDie(), Ne(a));
+  EXPECT_THAT(deriver->num_cached_tenants(), Eq(0));
+}
+
+TEST_F(TenantKeyDeriverTest, MasterKeyWithShortOutputsFails) {
+  // HMAC-SHA256 PRFs have at most 32 bytes of output.
+  auto handle_result =
+      KeysetHandle::GenerateNew(PrfKeyTemplates::HmacSha256());
+  ASSERT_THAT(handle_result.status(), IsOk());
+  EXPECT_THAT(
+      TenantPrimitiveDeriver<Aead>::New(
+          std::move(
+              handle_result.ValueOrDie()->GetPrimitive<PrfSet>().ValueOrDie()),
+          AeadKeyTemplates::Aes128Gcm(), 10)
+          .status(),
+      Not(IsOk()));
+}
+
+TEST_F(TenantKeyDeriverTest, InvalidArguments) {
+  EXPECT_THAT(TenantPrimitiveDeriver<Aead>::New(
+                  nullptr, AeadKeyTemplates::Aes128Gcm(), 10)
+                  .status(),
+              Not(IsOk()));
+  EXPECT_THAT(TenantPrimitiveDeriver<Aead>::New(
+                  MasterPrfSet(), AeadKeyTemplates::Aes128Gcm(), -1)
+                  .status(),
+              Not(IsOk()));
+  google::crypto::tink::KeyTemplate unknown_template;
+  unknown_template.set_type_url("type.googleapis.com/unknown");
+  EXPECT_THAT(
+      TenantPrimitiveDeriver<Aead>::New(MasterPrfSet(), unknown_template, 10)
+          .status(),
+      Not(IsOk()));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
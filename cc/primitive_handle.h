@@ -0,0 +1,100 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_PRIMITIVE_HANDLE_H_
+#define TINK_PRIMITIVE_HANDLE_H_
+
+#include <memory>
+#include <utility>
+
+#include "tink/keyset_handle.h"
+#include "tink/space_used.h"
+#include "tink/util/keyset_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// Holds the primitive of a keyset together with the KeysetInfo of the
+// keyset, but not the keyset itself.
+//
+// A KeysetHandle keeps its keyset, including the key material, for as long
+// as it lives, while the primitive created from it holds the key material
+// once more in its own form (key schedules, BoringSSL contexts, ...).
+// Services which load many large keysets only to use their primitives can
+// convert the handles into PrimitiveHandles, which zeroizes and frees the
+// keysets once the primitives are built, and keeps only the metadata of
+// the keys.
+template <class P>
+class PrimitiveHandle {
+ public:
+  // Creates the primitive of |keyset_handle| like
+  // KeysetHandle::GetPrimitive(), then zeroizes the key material of
+  // |keyset_handle| and destroys it. Copies of |keyset_handle| made before
+  // are not affected.
+  static crypto::tink::util::StatusOr<std::unique_ptr<PrimitiveHandle<P>>>
+  New(std::unique_ptr<KeysetHandle> keyset_handle);
+
+  PrimitiveHandle(const PrimitiveHandle&) = delete;
+  PrimitiveHandle& operator=(const PrimitiveHandle&) = delete;
+
+  const P& get_primitive() const { return *primitive_; }
+
+  // Returns the metadata of the keys of the keyset, without key material.
+  const google::crypto::tink::KeysetInfo& get_keyset_info() const {
+    return keyset_info_;
+  }
+
+  // Returns an estimate of the number of bytes held by this handle,
+  // including the primitive as far as it implements SpaceUsedInterface.
+  size_t SpaceUsed() const {
+    return sizeof(*this) - sizeof(keyset_info_) +
+           keyset_info_.SpaceUsedLong() + crypto::tink::SpaceUsed(*primitive_);
+  }
+
+ private:
+  PrimitiveHandle(std::unique_ptr<P> primitive,
+                  google::crypto::tink::KeysetInfo keyset_info)
+      : primitive_(std::move(primitive)),
+        keyset_info_(std::move(keyset_info)) {}
+
+  std::unique_ptr<P> primitive_;
+  google::crypto::tink::KeysetInfo keyset_info_;
+};
+
+template <class P>
+crypto::tink::util::StatusOr<std::unique_ptr<PrimitiveHandle<P>>>
+PrimitiveHandle<P>::New(std::unique_ptr<KeysetHandle> keyset_handle) {
+  if (keyset_handle == nullptr) {
+    return crypto::tink::util::Status(
+        crypto::tink::util::error::INVALID_ARGUMENT,
+        "keyset_handle must be non-null");
+  }
+  auto primitive_result = keyset_handle->GetPrimitive<P>();
+  if (!primitive_result.ok()) return primitive_result.status();
+  std::unique_ptr<PrimitiveHandle<P>> primitive_handle(new PrimitiveHandle<P>(
+      std::move(primitive_result.ValueOrDie()),
+      keyset_handle->GetKeysetInfo()));
+  ZeroizeKeyValues(&keyset_handle->keyset_);
+  return std::move(primitive_handle);
+}
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_PRIMITIVE_HANDLE_H_
@@ -0,0 +1,115 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_PRIMITIVE_INTERN_TABLE_H_
+#define TINK_PRIMITIVE_INTERN_TABLE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/registry.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+namespace internal {
+
+// Returns the SHA-256 digest of the serialized 'key_data'.
+std::string KeyDataDigest(const google::crypto::tink::KeyData& key_data);
+
+}  // namespace internal
+
+// Shares the primitives of identical keys between the primitives of
+// different keysets, e.g. of per-tenant keysets which all contain the same
+// few keys. Without it, every KeysetHandle::GetPrimitive() call creates the
+// primitives of all keys again, i.e. another copy of every AES key schedule
+// or RSA key.
+//
+// The table only holds weak references: a primitive is released as soon as
+// the last keyset primitive using it is destroyed, and created again by the
+// next lookup. Keys are identified by the primitive type and the SHA-256
+// digest of their key data, so only keys with exactly the same type url,
+// key material and key material type are shared. Tink primitives are
+// immutable and thread safe, hence sharing them is safe.
+//
+// Use it via KeysetHandle::LoadingOptions::intern_table.
+//
+// Instances of this class are thread safe.
+class PrimitiveInternTable {
+ public:
+  PrimitiveInternTable() = default;
+
+  PrimitiveInternTable(const PrimitiveInternTable&) = delete;
+  PrimitiveInternTable& operator=(const PrimitiveInternTable&) = delete;
+
+  // Returns the process-wide table.
+  static PrimitiveInternTable& GlobalInstance();
+
+  // Returns the primitive of 'key_data', creating it with the registry if
+  // the table holds no live primitive of the same key.
+  template <class P>
+  crypto::tink::util::StatusOr<std::shared_ptr<P>> GetPrimitive(
+      const google::crypto::tink::KeyData& key_data)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Returns the number of live primitives in the table.
+  int size() const ABSL_LOCKS_EXCLUDED(mutex_);
+
+ private:
+  // Identifies a key by the primitive type and the digest of its key data.
+  typedef std::pair<std::type_index, std::string> Id;
+
+  // Returns the live primitive with the given 'id', or nullptr.
+  std::shared_ptr<void> Lookup(const Id& id) const ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Adds 'primitive' with the given 'id', unless another thread added a live
+  // one in the meantime, which is then returned instead.
+  std::shared_ptr<void> Insert(const Id& id, std::shared_ptr<void> primitive)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  mutable absl::Mutex mutex_;
+  std::map<Id, std::weak_ptr<void>> primitives_ ABSL_GUARDED_BY(mutex_);
+  // The number of entries after the last removal of released primitives.
+  size_t purged_size_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+template <class P>
+crypto::tink::util::StatusOr<std::shared_ptr<P>>
+PrimitiveInternTable::GetPrimitive(
+    const google::crypto::tink::KeyData& key_data) {
+  Id id(std::type_index(typeid(P)), internal::KeyDataDigest(key_data));
+  std::shared_ptr<void> primitive = Lookup(id);
+  if (primitive == nullptr) {
+    // The primitive is created without holding the lock.
+    auto primitive_result = Registry::GetPrimitive<P>(key_data);
+    if (!primitive_result.ok()) return primitive_result.status();
+    primitive = Insert(
+        id, std::shared_ptr<P>(std::move(primitive_result.ValueOrDie())));
+  }
+  return std::static_pointer_cast<P>(primitive);
+}
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_PRIMITIVE_INTERN_TABLE_H_
@@ -17,13 +17,21 @@
 #ifndef TINK_PRIMITIVE_SET_H_
 #define TINK_PRIMITIVE_SET_H_
 
-#include <unordered_map>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <utility>
 #include <vector>
 
+#include "absl/base/call_once.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "tink/crypto_format.h"
-#include "tink/util/errors.h"
+#include "tink/space_used.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
 
@@ -46,6 +54,14 @@ namespace tink {
 // the set is used, and upon decryption the ciphertext's prefix
 // determines the identifier of the primitive from the set.
 //
+// Entries are indexed by their output prefix in a flat open-addressing
+// table, so that looking up the primitives for a prefix does not allocate.
+// The per-prefix entry lists are allocated in chunks, so that sets of very
+// large keysets take few allocations besides the entries themselves.
+// A set can be frozen (cf. Freeze()), after which it is immutable and
+// lookups by identifier no longer take a lock.  Primitive wrappers freeze
+// the sets they take ownership of.
+//
 // PrimitiveSet is a public class to allow its use in implementations
 // of custom primitives.
 template <class P>
@@ -58,55 +74,167 @@ class PrimitiveSet {
     static crypto::tink::util::StatusOr<std::unique_ptr<Entry<P>>> New(
         std::unique_ptr<P> primitive,
         const google::crypto::tink::KeysetInfo::KeyInfo& key_info) {
-      if (key_info.status() != google::crypto::tink::KeyStatusType::ENABLED) {
+      auto identifier_result = CheckKeyInfo(key_info);
+      if (!identifier_result.ok()) return identifier_result.status();
+      if (primitive == nullptr) {
         return util::Status(crypto::tink::util::error::INVALID_ARGUMENT,
-                            "The key must be ENABLED.");
+                            "The primitive must be non-null.");
       }
-      auto identifier_result = CryptoFormat::GetOutputPrefix(key_info);
+      return absl::WrapUnique(new Entry(
+          std::move(primitive), nullptr, identifier_result.ValueOrDie(),
+          key_info.status(), key_info.key_id(), key_info.output_prefix_type()));
+    }
+
+    // Like New(), but the primitive may be shared with other entries, e.g.
+    // with the entry for the same key in a set for an older keyset version.
+    static crypto::tink::util::StatusOr<std::unique_ptr<Entry<P>>> NewShared(
+        std::shared_ptr<P> primitive,
+        const google::crypto::tink::KeysetInfo::KeyInfo& key_info) {
+      auto identifier_result = CheckKeyInfo(key_info);
       if (!identifier_result.ok()) return identifier_result.status();
       if (primitive == nullptr) {
         return util::Status(crypto::tink::util::error::INVALID_ARGUMENT,
                             "The primitive must be non-null.");
       }
-      std::string identifier = identifier_result.ValueOrDie();
-      return absl::WrapUnique(new Entry(std::move(primitive), identifier,
-                                        key_info.status(), key_info.key_id(),
-                                        key_info.output_prefix_type()));
+      return absl::WrapUnique(new Entry(
+          std::move(primitive), nullptr, identifier_result.ValueOrDie(),
+          key_info.status(), key_info.key_id(), key_info.output_prefix_type()));
+    }
+
+    // Like New(), but the primitive is only created by 'factory' when the
+    // entry is first materialized (cf. PrimitiveSet::AddLazyPrimitive()).
+    static crypto::tink::util::StatusOr<std::unique_ptr<Entry<P>>> NewLazy(
+        std::function<crypto::tink::util::StatusOr<std::unique_ptr<P>>()>
+            factory,
+        const google::crypto::tink::KeysetInfo::KeyInfo& key_info) {
+      auto identifier_result = CheckKeyInfo(key_info);
+      if (!identifier_result.ok()) return identifier_result.status();
+      if (!factory) {
+        return util::Status(crypto::tink::util::error::INVALID_ARGUMENT,
+                            "The factory must be non-null.");
+      }
+      return absl::WrapUnique(new Entry(
+          nullptr, std::move(factory), identifier_result.ValueOrDie(),
+          key_info.status(), key_info.key_id(), key_info.output_prefix_type()));
     }
 
+    // Returns the primitive of this entry.  Must only be called on entries
+    // which are not lazy or were materialized successfully, which is the
+    // case for all entries returned by get_primitives(),
+    // get_raw_primitives(), get_primitive_by_key_id() and get_primary().
+    // For other entries (e.g. from get_all()) use get_primitive_or().
     P2& get_primitive() const { return *primitive_; }
 
-    const std::string& get_identifier() const { return identifier_; }
+    // Returns the primitive of this entry, creating it first if the entry
+    // is lazy, or the error with which its creation failed.
+    crypto::tink::util::StatusOr<P2*> get_primitive_or() const {
+      crypto::tink::util::Status status = Materialize();
+      if (!status.ok()) return status;
+      return primitive_.get();
+    }
 
-    google::crypto::tink::KeyStatusType get_status() const { return status_; }
+    // Returns the output prefix of this entry.  The returned view is valid
+    // as long as the entry.
+    absl::string_view get_identifier() const { return identifier_.view(); }
+
+    google::crypto::tink::KeyStatusType get_status() const {
+      return static_cast<google::crypto::tink::KeyStatusType>(status_);
+    }
 
     uint32_t get_key_id() const { return key_id_; }
 
     google::crypto::tink::OutputPrefixType get_output_prefix_type() const {
-      return output_prefix_type_;
+      return static_cast<google::crypto::tink::OutputPrefixType>(
+          output_prefix_type_);
+    }
+
+    // Returns true iff the primitive of this entry is created lazily.
+    bool is_lazy() const { return lazy_state_ != nullptr; }
+
+    // Creates the primitive of a lazy entry, unless this has been done
+    // before, and returns whether this succeeded.  Thread-safe; for entries
+    // which are not lazy this always returns OK.
+    crypto::tink::util::Status Materialize() const {
+      if (lazy_state_ == nullptr) return crypto::tink::util::Status::OK;
+      LazyState& lazy_state = *lazy_state_;
+      absl::call_once(lazy_state.materialize_once, [this, &lazy_state]() {
+        auto primitive_result = lazy_state.factory();
+        if (!primitive_result.ok()) {
+          lazy_state.creation_status = primitive_result.status();
+        } else if (primitive_result.ValueOrDie() == nullptr) {
+          lazy_state.creation_status =
+              util::Status(crypto::tink::util::error::INTERNAL,
+                           "The factory returned a null primitive.");
+        } else {
+          primitive_ = std::move(primitive_result.ValueOrDie());
+        }
+        // The factory usually holds a copy of the key material.
+        lazy_state.factory = nullptr;
+      });
+      return lazy_state.creation_status;
     }
 
    private:
-    Entry(std::unique_ptr<P2> primitive, const std::string& identifier,
+    friend class PrimitiveSet<P>;
+
+    // The state of a lazy entry until (and after) its primitive is
+    // created.  Only lazy entries allocate it, so that the entries of sets
+    // loaded eagerly, usually all of them, stay small.
+    struct LazyState {
+      explicit LazyState(
+          std::function<crypto::tink::util::StatusOr<std::unique_ptr<P2>>()>
+              factory)
+          : factory(std::move(factory)) {}
+
+      std::function<crypto::tink::util::StatusOr<std::unique_ptr<P2>>()>
+          factory;
+      absl::once_flag materialize_once;
+      crypto::tink::util::Status creation_status;
+    };
+
+    Entry(std::shared_ptr<P2> primitive,
+          std::function<crypto::tink::util::StatusOr<std::unique_ptr<P2>>()>
+              factory,
+          const CryptoFormat::OutputPrefix& identifier,
           google::crypto::tink::KeyStatusType status, uint32_t key_id,
           google::crypto::tink::OutputPrefixType output_prefix_type)
         : primitive_(std::move(primitive)),
+          lazy_state_(primitive_ == nullptr
+                          ? absl::make_unique<LazyState>(std::move(factory))
+                          : nullptr),
           identifier_(identifier),
-          status_(status),
-          key_id_(key_id),
-          output_prefix_type_(output_prefix_type) {}
+          status_(static_cast<uint8_t>(status)),
+          output_prefix_type_(static_cast<uint8_t>(output_prefix_type)),
+          key_id_(key_id) {}
+
+    // Checks that an entry can be created for 'key_info' and returns its
+    // identifier.
+    static crypto::tink::util::StatusOr<CryptoFormat::OutputPrefix>
+    CheckKeyInfo(
+        const google::crypto::tink::KeysetInfo::KeyInfo& key_info) {
+      if (key_info.status() != google::crypto::tink::KeyStatusType::ENABLED) {
+        return util::Status(crypto::tink::util::error::INVALID_ARGUMENT,
+                            "The key must be ENABLED.");
+      }
+      return CryptoFormat::GetInlineOutputPrefix(key_info);
+    }
 
-    std::unique_ptr<P> primitive_;
-    std::string identifier_;
-    google::crypto::tink::KeyStatusType status_;
+    // For lazy entries, primitive_ and *lazy_state_ are only accessed in
+    // (or after) the call_once in Materialize().
+    mutable std::shared_ptr<P> primitive_;
+    const std::unique_ptr<LazyState> lazy_state_;  // null unless lazy
+    CryptoFormat::OutputPrefix identifier_;
+    // The enums are stored in a byte each (the values accepted by
+    // CheckKeyInfo() are all small), so that they pack with identifier_.
+    uint8_t status_;
+    uint8_t output_prefix_type_;
     uint32_t key_id_;
-    google::crypto::tink::OutputPrefixType output_prefix_type_;
   };
 
   typedef std::vector<std::unique_ptr<Entry<P>>> Primitives;
 
   // Constructs an empty PrimitiveSet.
-  PrimitiveSet<P>() : primary_(nullptr) {}
+  PrimitiveSet<P>() : primary_(nullptr), frozen_(false) {}
 
   // Adds 'primitive' to this set for the specified 'key'.
   crypto::tink::util::StatusOr<Entry<P>*> AddPrimitive(
@@ -115,23 +243,55 @@ class PrimitiveSet {
     auto entry_or = Entry<P>::New(std::move(primitive), key_info);
     if (!entry_or.ok()) return entry_or.status();
 
+    return AddEntry(std::move(entry_or.ValueOrDie()));
+  }
+
+  // Like AddPrimitive(), but 'primitive' may be shared with other sets.
+  crypto::tink::util::StatusOr<Entry<P>*> AddSharedPrimitive(
+      std::shared_ptr<P> primitive,
+      const google::crypto::tink::KeysetInfo::KeyInfo& key_info) {
+    auto entry_or = Entry<P>::NewShared(std::move(primitive), key_info);
+    if (!entry_or.ok()) return entry_or.status();
+    return AddEntry(std::move(entry_or.ValueOrDie()));
+  }
+
+  // Adds an entry for the specified 'key' whose primitive is only created
+  // by 'factory' when it is first needed, i.e. when the entry is returned
+  // by get_primitives() or get_raw_primitives() or is set as the primary.
+  // This avoids the cost of creating primitives for keys which are never
+  // used, e.g. old keys of a large keyset which are kept for decryption.
+  // 'factory' may be called from any thread, at most once.
+  crypto::tink::util::StatusOr<Entry<P>*> AddLazyPrimitive(
+      std::function<crypto::tink::util::StatusOr<std::unique_ptr<P>>()>
+          factory,
+      const google::crypto::tink::KeysetInfo::KeyInfo& key_info) {
+    auto entry_or = Entry<P>::NewLazy(std::move(factory), key_info);
+    if (!entry_or.ok()) return entry_or.status();
+    return AddEntry(std::move(entry_or.ValueOrDie()));
+  }
+
+  // Makes room for entries with 'num_identifiers' distinct identifiers
+  // (e.g. the number of keys to be added), so that the lookup table is not
+  // rebuilt while they are added.  Must be called before Freeze().
+  crypto::tink::util::Status Reserve(size_t num_identifiers) {
     absl::MutexLock lock(&primitives_mutex_);
-    std::string identifier = entry_or.ValueOrDie()->get_identifier();
-    primitives_[identifier].push_back(std::move(entry_or.ValueOrDie()));
-    return primitives_[identifier].back().get();
+    if (is_frozen()) return FrozenError();
+    while (2 * num_identifiers > slots_.size()) Grow();
+    return crypto::tink::util::Status::OK;
   }
 
-  // Returns the entries with primitives identifed by 'identifier'.
+  // Returns the entries with primitives identifed by 'identifier'.  Lazy
+  // entries among them are materialized first; if this fails for any of
+  // them, the failure is returned instead.
   crypto::tink::util::StatusOr<const Primitives*> get_primitives(
       absl::string_view identifier) {
-    absl::MutexLock lock(&primitives_mutex_);
-    typename CiphertextPrefixToPrimitivesMap::iterator found =
-        primitives_.find(std::string(identifier));
-    if (found == primitives_.end()) {
-      return ToStatusF(crypto::tink::util::error::NOT_FOUND,
-                       "No primitives found for identifier '%s'.", identifier);
+    auto entries_result = find_primitives(identifier);
+    if (!entries_result.ok()) return entries_result.status();
+    for (const auto& entry : *entries_result.ValueOrDie()) {
+      crypto::tink::util::Status status = entry->Materialize();
+      if (!status.ok()) return status;
     }
-    return &(found->second);
+    return entries_result;
   }
 
   // Returns all primitives that use RAW prefix.
@@ -139,6 +299,23 @@ class PrimitiveSet {
     return get_primitives(CryptoFormat::kRawPrefix);
   }
 
+  // Returns the entry of the key with id 'key_id', which is materialized
+  // first if it is lazy.  If several entries have this key id, the first
+  // one added is returned.  This lets wrappers go straight to the key of
+  // inputs whose key id is known from elsewhere, e.g. RAW ciphertexts
+  // stored next to the id of their key.
+  crypto::tink::util::StatusOr<Entry<P>*> get_primitive_by_key_id(
+      uint32_t key_id) {
+    Entry<P>* entry = find_by_key_id(key_id);
+    if (entry == nullptr) {
+      return crypto::tink::util::Status(crypto::tink::util::error::NOT_FOUND,
+                                        "Unknown key id.");
+    }
+    crypto::tink::util::Status status = entry->Materialize();
+    if (!status.ok()) return status;
+    return entry;
+  }
+
   // Sets the given 'primary' as the primary primitive of this set.
   crypto::tink::util::Status set_primary(Entry<P>* primary) {
     if (!primary) {
@@ -149,26 +326,119 @@ class PrimitiveSet {
       return util::Status(crypto::tink::util::error::INVALID_ARGUMENT,
                           "Primary has to be enabled.");
     }
-    auto entries_result = get_primitives(primary->get_identifier());
+    if (is_frozen()) return FrozenError();
+    auto entries_result = find_primitives(primary->get_identifier());
     if (!entries_result.ok()) {
       return util::Status(crypto::tink::util::error::INVALID_ARGUMENT,
                           "Primary cannot be set to an entry which is "
                           "not held by this primitive set.");
     }
+    crypto::tink::util::Status status = primary->Materialize();
+    if (!status.ok()) return status;
 
     primary_ = primary;
+    StorePreferredIndex(primary);
     return crypto::tink::util::Status::OK;
   }
 
   // Returns the entry with the primary primitive.
   const Entry<P>* get_primary() const { return primary_; }
 
-  // Returns all entries currently in this primitive set.
+  // By default wrappers try the entries with the same identifier, e.g. the
+  // RAW entries, in the order in which they were added.  Once adaptive
+  // order is enabled, the set remembers per identifier which entry
+  // succeeded most recently, initially the primary, and wrappers try that
+  // one first:
+  //
+  //   size_t first = set.preferred_index(identifier);
+  //   for (size_t i = 0; i < entries.size(); i++) {
+  //     auto& entry = entries[PrimitiveSet<P>::AdaptiveOrderIndex(first, i)];
+  //     ...
+  //     if (ok) set.RecordSuccess(entry.get());
+  //   }
+  //
+  // This saves failed attempts during key rotation, but makes the order,
+  // and with it the timing, depend on earlier inputs; hence it is opt-in.
+  // Must be called before Freeze().
+  crypto::tink::util::Status EnableAdaptiveOrder() {
+    if (is_frozen()) return FrozenError();
+    adaptive_order_ = true;
+    return crypto::tink::util::Status::OK;
+  }
+
+  bool is_adaptive_order() const { return adaptive_order_; }
+
+  // Returns the index of the entry with 'identifier' which should be tried
+  // first.  Always 0 unless adaptive order is enabled.
+  size_t preferred_index(absl::string_view identifier) const {
+    if (!adaptive_order_) return 0;
+    const EntryList* list = find_list(identifier);
+    if (list == nullptr) return 0;
+    return list->preferred_index.load(std::memory_order_relaxed);
+  }
+
+  // Records that 'entry' succeeded, so that it is tried first from now on.
+  // A no-op unless adaptive order is enabled.  Thread-safe and lock-free
+  // once the set is frozen.
+  void RecordSuccess(const Entry<P>* entry) const {
+    if (adaptive_order_) StorePreferredIndex(entry);
+  }
+
+  // Returns the index of the entry to try at position 'i' when the entry at
+  // 'first' is tried first and the others follow in their original order.
+  static size_t AdaptiveOrderIndex(size_t first, size_t i) {
+    if (i == 0) return first;
+    return i <= first ? i - 1 : i;
+  }
+
+  // Makes this set immutable: subsequent calls to AddPrimitive() and
+  // set_primary() fail, and get_primitives() is served without locking.
+  // Calling Freeze() on an already frozen set is a no-op.
+  //
+  // Freeze() must happen-before any concurrent use of the frozen set,
+  // which is the case when the set is frozen before it is shared.
+  void Freeze() {
+    absl::MutexLock lock(&primitives_mutex_);
+    frozen_.store(true, std::memory_order_release);
+  }
+
+  // Returns true iff Freeze() has been called on this set.
+  bool is_frozen() const { return frozen_.load(std::memory_order_acquire); }
+
+  // Returns an estimate of the number of bytes held by this set, including
+  // the primitives of its entries as far as they implement
+  // SpaceUsedInterface.  Primitives shared with other sets are counted in
+  // full; primitives of lazy entries are not counted.
+  size_t SpaceUsed() const {
+    absl::MutexLock lock(&primitives_mutex_);
+    size_t space_used =
+        sizeof(*this) + slots_.capacity() * sizeof(Slot) +
+        lists_.size() * sizeof(EntryList) +
+        by_key_id_.capacity() *
+            (sizeof(typename decltype(by_key_id_)::value_type) + 1);
+    for (const EntryList& list : lists_) {
+      space_used +=
+          list.primitives.capacity() * sizeof(typename Primitives::value_type);
+      for (const auto& entry : list.primitives) {
+        space_used += sizeof(Entry<P>);
+        if (entry->is_lazy()) {
+          space_used += sizeof(typename Entry<P>::LazyState);
+        } else {
+          space_used += crypto::tink::SpaceUsed(entry->get_primitive());
+        }
+      }
+    }
+    return space_used;
+  }
+
+  // Returns all entries currently in this primitive set.  Lazy entries are
+  // not materialized; use Entry::get_primitive_or() to access their
+  // primitives.
   const std::vector<Entry<P>*> get_all() const {
     absl::MutexLock lock(&primitives_mutex_);
     std::vector<Entry<P>*> result;
-    for (const auto& prefix_and_vector : primitives_) {
-      for (const auto& primitive : prefix_and_vector.second) {
+    for (const EntryList& list : lists_) {
+      for (const auto& primitive : list.primitives) {
         result.push_back(primitive.get());
       }
     }
@@ -176,12 +446,149 @@ class PrimitiveSet {
   }
 
  private:
-  typedef std::unordered_map<std::string, Primitives>
-      CiphertextPrefixToPrimitivesMap;
-  Entry<P>* primary_;  // the Entry<P> object is owned by primitives_
+  // The entries with one identifier.
+  struct EntryList {
+    Primitives primitives;
+    // Only a hint for the order of attempts, so relaxed accesses suffice.
+    mutable std::atomic<size_t> preferred_index{0};
+  };
+
+  // A slot of the open-addressing table; unused slots have no list.  The
+  // lists live in lists_, so that they do not move when the table grows.
+  struct Slot {
+    uint64_t packed_identifier = 0;
+    EntryList* list = nullptr;
+  };
+
+  // Packs an identifier (at most CryptoFormat::kNonRawPrefixSize bytes)
+  // together with its length into a single integer, so that the RAW prefix
+  // and every 5-byte prefix map to distinct values.  Returns false if
+  // 'identifier' is too long to be held by any set.
+  static bool PackIdentifier(absl::string_view identifier, uint64_t* packed) {
+    if (identifier.size() > CryptoFormat::kNonRawPrefixSize) return false;
+    uint64_t value = identifier.size();
+    for (char c : identifier) {
+      value = (value << 8) | static_cast<uint8_t>(c);
+    }
+    *packed = value;
+    return true;
+  }
+
+  // Returns the slot for 'packed' in 'slots', which is either the slot
+  // holding it or the empty slot where it belongs.  'slots' must not be
+  // full and its size must be a power of two.
+  static size_t FindSlot(const std::vector<Slot>& slots, uint64_t packed) {
+    size_t mask = slots.size() - 1;
+    // Key ids are often small or sequential, so the bits are mixed before
+    // probing.
+    size_t index = ((packed * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+    while (slots[index].list != nullptr &&
+           slots[index].packed_identifier != packed) {
+      index = (index + 1) & mask;
+    }
+    return index;
+  }
+
+  // Doubles the table, keeping its load factor at most one half.
+  void Grow() ABSL_EXCLUSIVE_LOCKS_REQUIRED(primitives_mutex_) {
+    std::vector<Slot> slots(slots_.empty() ? 8 : 2 * slots_.size());
+    for (const Slot& slot : slots_) {
+      if (slot.list == nullptr) continue;
+      slots[FindSlot(slots, slot.packed_identifier)] = slot;
+    }
+    slots_.swap(slots);
+  }
+
+  crypto::tink::util::StatusOr<Entry<P>*> AddEntry(
+      std::unique_ptr<Entry<P>> entry) {
+    absl::MutexLock lock(&primitives_mutex_);
+    if (is_frozen()) return FrozenError();
+    uint64_t packed;
+    PackIdentifier(entry->get_identifier(), &packed);
+    if (2 * (lists_.size() + 1) > slots_.size()) Grow();
+    Slot& slot = slots_[FindSlot(slots_, packed)];
+    if (slot.list == nullptr) {
+      slot.packed_identifier = packed;
+      lists_.emplace_back();
+      slot.list = &lists_.back();
+    }
+    slot.list->primitives.push_back(std::move(entry));
+    Entry<P>* added = slot.list->primitives.back().get();
+    by_key_id_.emplace(added->get_key_id(), added);
+    return added;
+  }
+
+  Entry<P>* find_by_key_id(uint32_t key_id) const {
+    if (is_frozen()) return lookup_by_key_id(key_id);
+    absl::MutexLock lock(&primitives_mutex_);
+    return lookup_by_key_id(key_id);
+  }
+
+  // Must hold primitives_mutex_ unless the set is frozen.
+  Entry<P>* lookup_by_key_id(uint32_t key_id) const
+      ABSL_NO_THREAD_SAFETY_ANALYSIS {
+    auto it = by_key_id_.find(key_id);
+    return it == by_key_id_.end() ? nullptr : it->second;
+  }
+
+  // Like get_primitives(), but does not materialize lazy entries.
+  crypto::tink::util::StatusOr<const Primitives*> find_primitives(
+      absl::string_view identifier) {
+    const EntryList* list = find_list(identifier);
+    if (list == nullptr) {
+      // Wrappers look up the prefix of every input and fall back to the
+      // RAW keys when this fails, so the message is neither formatted nor
+      // long enough to be allocated.
+      return crypto::tink::util::Status(crypto::tink::util::error::NOT_FOUND,
+                                        "Unknown prefix.");
+    }
+    return &list->primitives;
+  }
+
+  const EntryList* find_list(absl::string_view identifier) const {
+    if (is_frozen()) return lookup(identifier);
+    absl::MutexLock lock(&primitives_mutex_);
+    return lookup(identifier);
+  }
+
+  void StorePreferredIndex(const Entry<P>* entry) const {
+    const EntryList* list = find_list(entry->get_identifier());
+    if (list == nullptr) return;
+    for (size_t i = 0; i < list->primitives.size(); i++) {
+      if (list->primitives[i].get() == entry) {
+        list->preferred_index.store(i, std::memory_order_relaxed);
+        return;
+      }
+    }
+  }
+
+  static crypto::tink::util::Status FrozenError() {
+    return util::Status(crypto::tink::util::error::FAILED_PRECONDITION,
+                        "The primitive set is frozen.");
+  }
+
+  // Returns the list for 'identifier', or nullptr if there is none.  Must
+  // hold primitives_mutex_ unless the set is frozen.
+  const EntryList* lookup(absl::string_view identifier) const
+      ABSL_NO_THREAD_SAFETY_ANALYSIS {
+    uint64_t packed;
+    if (slots_.empty() || !PackIdentifier(identifier, &packed)) {
+      return nullptr;
+    }
+    return slots_[FindSlot(slots_, packed)].list;
+  }
+
+  Entry<P>* primary_;  // the Entry<P> object is owned by lists_
   mutable absl::Mutex primitives_mutex_;
-  CiphertextPrefixToPrimitivesMap primitives_
-      ABSL_GUARDED_BY(primitives_mutex_);
+  // Guarded by primitives_mutex_ until the set is frozen, read-only
+  // afterwards.  A deque never moves its elements when it grows.
+  std::deque<EntryList> lists_;  // in the order of their first entries
+  std::vector<Slot> slots_;
+  // The first entry added for every key id.
+  absl::flat_hash_map<uint32_t, Entry<P>*> by_key_id_;
+  // Only set before the set is frozen, cf. EnableAdaptiveOrder().
+  bool adaptive_order_ = false;
+  std::atomic<bool> frozen_;
 };
 
 }  // namespace tink
@@ -17,7 +17,13 @@
 #ifndef TINK_PUBLIC_KEY_SIGN_H_
 #define TINK_PUBLIC_KEY_SIGN_H_
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/output_stream_with_result.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -37,6 +43,25 @@ class PublicKeySign {
   virtual crypto::tink::util::StatusOr<std::string> Sign(
       absl::string_view data) const = 0;
 
+  // Computes the signature for data[i], for every i, and returns the
+  // signatures in order.  Either all items are signed or an error is
+  // returned.
+  //
+  // The default implementation calls Sign() for every item;
+  // implementations override it when they can sign items in parallel or
+  // share work across items.
+  virtual crypto::tink::util::StatusOr<std::vector<std::string>> SignBatch(
+      absl::Span<const absl::string_view> data) const;
+
+  // Returns a stream which, once closed, returns the signature of the data
+  // written to it, as Sign() would.  The data is hashed while it is written,
+  // so it need not be held in memory as a whole.
+  //
+  // The default implementation fails with UNIMPLEMENTED.
+  virtual crypto::tink::util::StatusOr<
+      std::unique_ptr<OutputStreamWithResult<std::string>>>
+  NewSignOutputStream() const;
+
   virtual ~PublicKeySign() {}
 };
 
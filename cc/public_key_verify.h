@@ -17,8 +17,14 @@
 #ifndef TINK_PUBLIC_KEY_VERIFY_H_
 #define TINK_PUBLIC_KEY_VERIFY_H_
 
+#include <memory>
+#include <vector>
+
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/output_stream_with_result.h"
 #include "tink/util/status.h"
+#include "tink/util/statusor.h"
 
 namespace crypto {
 namespace tink {
@@ -38,6 +44,27 @@ class PublicKeyVerify {
       absl::string_view signature,
       absl::string_view data) const = 0;
 
+  // Verifies that signatures[i] is a digital signature for data[i], for
+  // every i, and returns the result of each verification in order.  An
+  // error is returned only if the batch itself is malformed, i.e. if the
+  // two spans have different sizes.
+  //
+  // The default implementation calls Verify() for every item;
+  // implementations override it when they can share work across items.
+  virtual crypto::tink::util::StatusOr<std::vector<crypto::tink::util::Status>>
+  VerifyBatch(absl::Span<const absl::string_view> signatures,
+              absl::Span<const absl::string_view> data) const;
+
+  // Returns a stream which, once closed, returns the result of verifying
+  // that 'signature' is a digital signature for the data written to it, as
+  // Verify() would.  The data is hashed while it is written, so it need not
+  // be held in memory as a whole.
+  //
+  // The default implementation fails with UNIMPLEMENTED.
+  virtual crypto::tink::util::StatusOr<
+      std::unique_ptr<OutputStreamWithResult<crypto::tink::util::Status>>>
+  NewVerifyOutputStream(absl::string_view signature) const;
+
   virtual ~PublicKeyVerify() {}
 };
 
@@ -17,6 +17,9 @@
 #ifndef TINK_RANDOM_ACCESS_STREAM_H_
 #define TINK_RANDOM_ACCESS_STREAM_H_
 
+#include <cstdint>
+
+#include "absl/strings/string_view.h"
 #include "tink/util/buffer.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -53,6 +56,24 @@ class RandomAccessStream {
       int count,
       crypto::tink::util::Buffer* dest_buffer) = 0;
 
+  // Zero-copy variant of PRead(), for streams whose contents are already
+  // in memory (e.g. memory-mapped files): returns a view of up to 'count'
+  // bytes starting at 'position', which remains valid as long as the
+  // stream. The view is shorter than 'count' only at the end of the
+  // stream.  'position' and 'count' must be as for PRead().
+  //
+  // Return values:
+  //  OK: the view of the bytes.
+  //  OUT_OF_RANGE: if 'position' is not smaller than the size of the stream.
+  //  INVALID_ARGUMENT: if some of the arguments are not valid.
+  //  UNIMPLEMENTED: if the stream cannot provide views, which is the
+  //      default; callers then use PRead().
+  virtual crypto::tink::util::StatusOr<absl::string_view> PReadView(
+      int64_t position, int count) {
+    return crypto::tink::util::Status(crypto::tink::util::error::UNIMPLEMENTED,
+                                      "PReadView() is not supported");
+  }
+
   // Returns the size of this stream in bytes, if available.
   // If the size is not available, returns a non-Ok status.
   // The returned value is the "logical" size of a stream, i.e. of
@@ -0,0 +1,147 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_REFRESHABLE_PRIMITIVE_H_
+#define TINK_REFRESHABLE_PRIMITIVE_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/internal/key_info.h"
+#include "tink/keyset_handle.h"
+#include "tink/primitive_intern_table.h"
+#include "tink/primitive_set.h"
+#include "tink/registry.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// Holds the primitive of a keyset which is replaced by new versions over
+// time, e.g. when a configuration system pushes a keyset with one more key.
+//
+// Refresh() builds the primitive of the new version, but reuses the
+// primitives of the keys which did not change, i.e. which have the same key
+// id and key data as in the previous version, instead of creating them
+// again from the key material, which is expensive e.g. for RSA and EC keys.
+// The new primitive is published atomically: Get() returns either the old
+// or the new one, and operations on a primitive returned earlier are not
+// affected by a refresh.
+//
+// Instances of this class are thread safe.
+template <class P>
+class RefreshablePrimitive {
+ public:
+  // Returns an instance holding the primitive of 'keyset_handle'.
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<RefreshablePrimitive<P>>>
+  New(const KeysetHandle& keyset_handle) {
+    std::unique_ptr<RefreshablePrimitive<P>> refreshable(
+        new RefreshablePrimitive<P>());
+    crypto::tink::util::Status status = refreshable->Refresh(keyset_handle);
+    if (!status.ok()) return status;
+    return std::move(refreshable);
+  }
+
+  RefreshablePrimitive(const RefreshablePrimitive&) = delete;
+  RefreshablePrimitive& operator=(const RefreshablePrimitive&) = delete;
+
+  // Returns the current primitive.  It stays usable after later refreshes.
+  std::shared_ptr<P> Get() const ABSL_LOCKS_EXCLUDED(mutex_) {
+    absl::ReaderMutexLock lock(&mutex_);
+    return primitive_;
+  }
+
+  // Replaces the primitive by the one of 'keyset_handle'.  On failure the
+  // current primitive is kept.
+  crypto::tink::util::Status Refresh(const KeysetHandle& keyset_handle)
+      ABSL_LOCKS_EXCLUDED(refresh_mutex_, mutex_);
+
+ private:
+  // Identifies a key by its id and the digest of its key data.
+  typedef std::pair<uint32_t, std::string> KeyId;
+
+  RefreshablePrimitive() = default;
+
+  // Serializes refreshes, without blocking Get() while the new primitive is
+  // built.
+  absl::Mutex refresh_mutex_;
+  // The primitives of the enabled keys of the current keyset.
+  std::map<KeyId, std::shared_ptr<P>> key_primitives_
+      ABSL_GUARDED_BY(refresh_mutex_);
+  mutable absl::Mutex mutex_;
+  std::shared_ptr<P> primitive_ ABSL_GUARDED_BY(mutex_);
+};
+
+template <class P>
+crypto::tink::util::Status RefreshablePrimitive<P>::Refresh(
+    const KeysetHandle& keyset_handle) {
+  absl::MutexLock refresh_lock(&refresh_mutex_);
+  const google::crypto::tink::Keyset& keyset = keyset_handle.get_keyset();
+  crypto::tink::util::Status status = ValidateKeyset(keyset);
+  if (!status.ok()) return status;
+  auto primitive_set = absl::make_unique<PrimitiveSet<P>>();
+  primitive_set->Reserve(keyset.key_size()).IgnoreError();
+  std::map<KeyId, std::shared_ptr<P>> key_primitives;
+  for (const google::crypto::tink::Keyset::Key& key : keyset.key()) {
+    if (key.status() != google::crypto::tink::KeyStatusType::ENABLED) {
+      continue;
+    }
+    KeyId key_id(key.key_id(), internal::KeyDataDigest(key.key_data()));
+    std::shared_ptr<P>& primitive = key_primitives[key_id];
+    if (primitive == nullptr) {
+      auto it = key_primitives_.find(key_id);
+      if (it != key_primitives_.end()) {
+        primitive = it->second;
+      } else {
+        auto primitive_result = Registry::GetPrimitive<P>(key.key_data());
+        if (!primitive_result.ok()) return primitive_result.status();
+        primitive = std::move(primitive_result.ValueOrDie());
+      }
+    }
+    auto entry_result =
+        primitive_set->AddSharedPrimitive(primitive, KeyInfoFromKey(key));
+    if (!entry_result.ok()) return entry_result.status();
+    if (key.key_id() == keyset.primary_key_id()) {
+      status = primitive_set->set_primary(entry_result.ValueOrDie());
+      if (!status.ok()) return status;
+    }
+  }
+  auto wrapped_result = Registry::Wrap<P>(std::move(primitive_set));
+  if (!wrapped_result.ok()) return wrapped_result.status();
+  std::shared_ptr<P> primitive = std::move(wrapped_result.ValueOrDie());
+  key_primitives_.swap(key_primitives);
+  {
+    absl::MutexLock lock(&mutex_);
+    primitive_.swap(primitive);
+  }
+  // The previous primitive is released here, unless it is still in use.
+  return crypto::tink::util::Status::OK;
+}
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_REFRESHABLE_PRIMITIVE_H_
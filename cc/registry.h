@@ -19,8 +19,10 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "tink/executor.h"
 #include "tink/internal/registry_impl.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -181,6 +183,19 @@ class Registry {
     return internal::RegistryImpl::GlobalInstance().NewKeyData(key_template);
   }
 
+  // Generates 'count' new KeyData for the specified 'key_template', like
+  // 'count' calls to NewKeyData(key_template), but looks the KeyManager up
+  // only once.  If 'executor' is non-null, the keys are generated on its
+  // threads, which pays off for keys that are expensive to generate, e.g.
+  // RSA keys.  Fails if the generation of any of the keys fails.
+  static crypto::tink::util::StatusOr<
+      std::vector<std::unique_ptr<google::crypto::tink::KeyData>>>
+  NewKeyDataBatch(const google::crypto::tink::KeyTemplate& key_template,
+                  int count, std::shared_ptr<Executor> executor = nullptr) {
+    return internal::RegistryImpl::GlobalInstance().NewKeyDataBatch(
+        key_template, count, executor.get());
+  }
+
   // Convenience method for extracting the public key data from the
   // private key given in serialized_private_key.
   // It looks up a KeyManager identified by type_url, whose KeyFactory must be
@@ -202,8 +217,16 @@ class Registry {
         std::move(primitive_set));
   }
 
+  // Seals the registry: afterwards no key managers, primitive wrappers or
+  // catalogues can be added, and lookups no longer take a lock. Call this
+  // once all configuration (e.g. TinkConfig::Register()) is done, to avoid
+  // lock contention when many threads create primitives concurrently.
+  static void Seal() {
+    internal::RegistryImpl::GlobalInstance().Seal();
+  }
+
   // Resets the registry.
-  // After reset the registry is empty, i.e. it contains neither catalogues
+  // After reset the registry is empty and no longer sealed, i.e. it contains neither catalogues
   // nor key managers. This method is intended for testing only.
   static void Reset() {
     return internal::RegistryImpl::GlobalInstance().Reset();
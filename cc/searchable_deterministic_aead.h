@@ -0,0 +1,77 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_SEARCHABLE_DETERMINISTIC_AEAD_H_
+#define TINK_SEARCHABLE_DETERMINISTIC_AEAD_H_
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+// The output of SearchableDeterministicAead::EncryptWithSearchToken().
+struct SearchableCiphertext {
+  std::string ciphertext;
+  std::string search_token;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Deterministic authenticated encryption which also returns a search token,
+// a blind index of the plaintext for equality searches over encrypted
+// columns.
+//
+// EncryptWithSearchToken() returns the ciphertext of
+// DeterministicAead::EncryptDeterministically() together with the token,
+// from a single pass over the plaintext, instead of encrypting the value and
+// computing a PRF of it separately. Queries compute the token of the value
+// they look for with ComputeSearchToken().
+//
+// Tokens, like ciphertexts, are equal exactly when both the plaintext and
+// the associated data are equal, so queries must use the associated data
+// that was used on ingestion. Without the key, a token can not be linked to
+// the ciphertext it was computed with.
+class SearchableDeterministicAead {
+ public:
+  // Encrypts 'plaintext' with 'associated_data' as associated data
+  // deterministically, and returns the ciphertext and the search token.
+  virtual crypto::tink::util::StatusOr<SearchableCiphertext>
+  EncryptWithSearchToken(absl::string_view plaintext,
+                         absl::string_view associated_data) const = 0;
+
+  // Returns the search token of 'plaintext' with 'associated_data', i.e. the
+  // token returned by EncryptWithSearchToken() for the same arguments.
+  virtual crypto::tink::util::StatusOr<std::string> ComputeSearchToken(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const = 0;
+
+  // Decrypts a ciphertext returned by EncryptWithSearchToken(), as
+  // DeterministicAead::DecryptDeterministically() does.
+  virtual crypto::tink::util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const = 0;
+
+  virtual ~SearchableDeterministicAead() {}
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SEARCHABLE_DETERMINISTIC_AEAD_H_
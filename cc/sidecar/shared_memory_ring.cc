@@ -0,0 +1,118 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/sidecar/shared_memory_ring.h"
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+
+namespace crypto {
+namespace tink {
+namespace sidecar {
+
+// Processes share the atomics, so they must not be implemented with a lock.
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+              "SharedMemoryRing needs lock-free 64 bit atomics");
+
+namespace {
+
+constexpr int kSpinPolls = 2000;
+constexpr int kYieldPolls = 100;
+constexpr absl::Duration kIdleSleep = absl::Microseconds(50);
+
+// Spinning only helps if the other side runs on another processor.
+int SpinPolls() {
+  static const int spin_polls =
+      std::thread::hardware_concurrency() > 1 ? kSpinPolls : 0;
+  return spin_polls;
+}
+
+}  // namespace
+
+// static
+size_t SharedMemoryRing::RequiredSize(uint32_t num_slots, uint32_t slot_size) {
+  return sizeof(RingIndices) + static_cast<size_t>(num_slots) * slot_size;
+}
+
+// static
+void SharedMemoryRing::Initialize(void* memory) {
+  RingIndices* indices = new (memory) RingIndices;
+  indices->head.store(0, std::memory_order_relaxed);
+  indices->tail.store(0, std::memory_order_release);
+}
+
+SharedMemoryRing::SharedMemoryRing(void* memory, uint32_t num_slots,
+                                   uint32_t slot_size)
+    : indices_(static_cast<RingIndices*>(memory)),
+      slots_(static_cast<char*>(memory) + sizeof(RingIndices)),
+      num_slots_(num_slots),
+      slot_size_(slot_size) {}
+
+char* SharedMemoryRing::BeginPush() {
+  uint64_t tail = indices_->tail.load(std::memory_order_relaxed);
+  // Acquire, so that the consumer is done with the slot before it is
+  // overwritten.
+  uint64_t head = indices_->head.load(std::memory_order_acquire);
+  if (tail - head >= num_slots_) return nullptr;
+  return slot(tail);
+}
+
+void SharedMemoryRing::EndPush() {
+  uint64_t tail = indices_->tail.load(std::memory_order_relaxed);
+  indices_->tail.store(tail + 1, std::memory_order_release);
+}
+
+const char* SharedMemoryRing::BeginPop() {
+  uint64_t head = indices_->head.load(std::memory_order_relaxed);
+  uint64_t tail = indices_->tail.load(std::memory_order_acquire);
+  if (head == tail) return nullptr;
+  return slot(head);
+}
+
+void SharedMemoryRing::EndPop() {
+  uint64_t head = indices_->head.load(std::memory_order_relaxed);
+  indices_->head.store(head + 1, std::memory_order_release);
+}
+
+bool SharedMemoryRing::empty() const {
+  return indices_->head.load(std::memory_order_acquire) ==
+         indices_->tail.load(std::memory_order_acquire);
+}
+
+void SharedMemoryRing::Reset() {
+  uint64_t tail = indices_->tail.load(std::memory_order_acquire);
+  indices_->head.store(tail, std::memory_order_release);
+}
+
+void RingBackoff::Wait() {
+  if (polls_ < SpinPolls()) {
+    polls_++;
+  } else if (polls_ < SpinPolls() + kYieldPolls) {
+    polls_++;
+    std::this_thread::yield();
+  } else {
+    absl::SleepFor(kIdleSleep);
+  }
+}
+
+}  // namespace sidecar
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,108 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SIDECAR_SHARED_MEMORY_RING_H_
+#define TINK_SIDECAR_SHARED_MEMORY_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace crypto {
+namespace tink {
+namespace sidecar {
+
+// The indices of a SharedMemoryRing, which live in the shared memory in
+// front of its slots.  They only ever grow; slot i % num_slots is the
+// slot of index i.  They are on cache lines of their own, so that the
+// producer and the consumer do not write to the same line.
+struct RingIndices {
+  // The index of the next slot to read.  Written only by the consumer.
+  alignas(64) std::atomic<uint64_t> head;
+  // The index of the next slot to write.  Written only by the producer.
+  alignas(64) std::atomic<uint64_t> tail;
+};
+
+// A lock-free ring of fixed-size slots for one producer and one consumer,
+// which may be in different processes.  SharedMemoryRing does not own the
+// memory, which is RequiredSize() bytes at a 64 byte aligned address.
+//
+// The producer fills the slot returned by BeginPush() and publishes it with
+// EndPush(); the consumer reads the slot returned by BeginPop() and hands
+// it back with EndPop().  Both sides access the slot in place, so no data
+// is copied besides that of the caller.
+class SharedMemoryRing {
+ public:
+  // The memory needed by a ring of 'num_slots' slots of 'slot_size' bytes.
+  static size_t RequiredSize(uint32_t num_slots, uint32_t slot_size);
+
+  // Sets up an empty ring in 'memory'.  Must be called once, before any
+  // process uses the ring.
+  static void Initialize(void* memory);
+
+  SharedMemoryRing() = default;
+  SharedMemoryRing(void* memory, uint32_t num_slots, uint32_t slot_size);
+
+  uint32_t num_slots() const { return num_slots_; }
+  uint32_t slot_size() const { return slot_size_; }
+
+  // Returns the next slot to write, or nullptr if the ring is full.
+  char* BeginPush();
+  // Publishes the slot returned by the last BeginPush().
+  void EndPush();
+
+  // Returns the next slot to read, or nullptr if the ring is empty.
+  const char* BeginPop();
+  // Frees the slot returned by the last BeginPop().
+  void EndPop();
+
+  // Whether every pushed slot has been popped.
+  bool empty() const;
+
+  // Empties the ring.  Neither a producer nor a consumer may use it.
+  void Reset();
+
+ private:
+  char* slot(uint64_t index) const {
+    return slots_ + (index % num_slots_) * slot_size_;
+  }
+
+  RingIndices* indices_ = nullptr;
+  char* slots_ = nullptr;
+  uint32_t num_slots_ = 0;
+  uint32_t slot_size_ = 0;
+};
+
+// Waits between polls of a ring: spins first, since the other side
+// usually answers within microseconds, then yields the processor, and
+// sleeps once the ring has been idle for a while.  On a single processor
+// it does not spin.
+class RingBackoff {
+ public:
+  RingBackoff() = default;
+
+  void Wait();
+  void Reset() { polls_ = 0; }
+
+ private:
+  int polls_ = 0;
+};
+
+}  // namespace sidecar
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SIDECAR_SHARED_MEMORY_RING_H_
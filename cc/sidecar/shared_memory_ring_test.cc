@@ -0,0 +1,122 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/sidecar/shared_memory_ring.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "gtest/gtest.h"
+
+namespace crypto {
+namespace tink {
+namespace sidecar {
+namespace {
+
+constexpr uint32_t kNumSlots = 4;
+constexpr uint32_t kSlotSize = 64;
+
+class SharedMemoryRingTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    size_t size = SharedMemoryRing::RequiredSize(kNumSlots, kSlotSize);
+    memory_ = aligned_alloc(64, size);
+    SharedMemoryRing::Initialize(memory_);
+    ring_ = SharedMemoryRing(memory_, kNumSlots, kSlotSize);
+  }
+
+  void TearDown() override { free(memory_); }
+
+  void* memory_;
+  SharedMemoryRing ring_;
+};
+
+TEST_F(SharedMemoryRingTest, PushAndPopInOrder) {
+  EXPECT_TRUE(ring_.empty());
+  EXPECT_EQ(nullptr, ring_.BeginPop());
+  for (uint32_t i = 0; i < kNumSlots; i++) {
+    char* slot = ring_.BeginPush();
+    ASSERT_NE(nullptr, slot);
+    std::memcpy(slot, &i, sizeof(i));
+    ring_.EndPush();
+  }
+  // The ring is full.
+  EXPECT_EQ(nullptr, ring_.BeginPush());
+  EXPECT_FALSE(ring_.empty());
+  for (uint32_t i = 0; i < kNumSlots; i++) {
+    const char* slot = ring_.BeginPop();
+    ASSERT_NE(nullptr, slot);
+    uint32_t value;
+    std::memcpy(&value, slot, sizeof(value));
+    EXPECT_EQ(i, value);
+    ring_.EndPop();
+  }
+  EXPECT_TRUE(ring_.empty());
+  EXPECT_NE(nullptr, ring_.BeginPush());
+}
+
+TEST_F(SharedMemoryRingTest, UnpublishedSlotIsNotPopped) {
+  ASSERT_NE(nullptr, ring_.BeginPush());
+  EXPECT_EQ(nullptr, ring_.BeginPop());
+  ring_.EndPush();
+  EXPECT_NE(nullptr, ring_.BeginPop());
+}
+
+TEST_F(SharedMemoryRingTest, Reset) {
+  for (uint32_t i = 0; i < 3; i++) {
+    ASSERT_NE(nullptr, ring_.BeginPush());
+    ring_.EndPush();
+  }
+  ring_.Reset();
+  EXPECT_TRUE(ring_.empty());
+  EXPECT_EQ(nullptr, ring_.BeginPop());
+}
+
+TEST_F(SharedMemoryRingTest, ProducerAndConsumerThreads) {
+  const uint64_t kCount = 100000;
+  std::thread producer([this, kCount]() {
+    RingBackoff backoff;
+    for (uint64_t i = 0; i < kCount; i++) {
+      char* slot;
+      while ((slot = ring_.BeginPush()) == nullptr) backoff.Wait();
+      backoff.Reset();
+      std::memcpy(slot, &i, sizeof(i));
+      std::memset(slot + sizeof(i), static_cast<int>(i & 0xff),
+                  kSlotSize - sizeof(i));
+      ring_.EndPush();
+    }
+  });
+  RingBackoff backoff;
+  for (uint64_t i = 0; i < kCount; i++) {
+    const char* slot;
+    while ((slot = ring_.BeginPop()) == nullptr) backoff.Wait();
+    backoff.Reset();
+    uint64_t value;
+    std::memcpy(&value, slot, sizeof(value));
+    ASSERT_EQ(i, value);
+    ASSERT_EQ(static_cast<char>(i & 0xff), slot[kSlotSize - 1]);
+    ring_.EndPop();
+  }
+  producer.join();
+  EXPECT_TRUE(ring_.empty());
+}
+
+}  // namespace
+}  // namespace sidecar
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,293 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/sidecar/sidecar_client.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/aead.h"
+#include "tink/mac.h"
+#include "tink/prf/prf_set.h"
+#include "tink/sidecar/shared_memory_ring.h"
+#include "tink/sidecar/sidecar_region.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace sidecar {
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+// The channel of a client, shared by the client and its primitives.
+class SidecarConnection {
+ public:
+  SidecarConnection(std::unique_ptr<SidecarRegion> region, int channel_index)
+      : region_(std::move(region)),
+        channel_index_(channel_index),
+        channel_(region_->channel(channel_index)) {}
+
+  ~SidecarConnection() {
+    // A broken channel may still hold requests, so it is left to the server
+    // to reclaim once the process exits.
+    if (!broken_.load()) region_->ReleaseChannel(channel_index_);
+  }
+
+  size_t max_payload_size() const { return region_->max_payload_size(); }
+
+  // Sends a request, and waits for its response.
+  StatusOr<std::string> Call(SidecarOperation operation,
+                             absl::string_view name, absl::string_view input,
+                             absl::string_view argument,
+                             uint32_t output_length) const;
+
+ private:
+  Status Broken() const {
+    broken_.store(true);
+    return Status(util::error::UNAVAILABLE, "The sidecar server stopped");
+  }
+
+  // Reads the response in 'slot'.
+  StatusOr<std::string> ParseResponse(const char* slot) const;
+
+  const std::unique_ptr<SidecarRegion> region_;
+  const int channel_index_;
+  const SidecarChannel channel_;
+
+  // Producer side of the request ring.
+  mutable absl::Mutex send_mutex_;
+  mutable uint64_t next_request_id_ ABSL_GUARDED_BY(send_mutex_) = 1;
+
+  // Consumer side of the response ring.  The thread holding the mutex
+  // reads the responses, and keeps those of other threads for them.
+  mutable absl::Mutex receive_mutex_;
+  mutable absl::flat_hash_map<uint64_t, StatusOr<std::string>> responses_
+      ABSL_GUARDED_BY(receive_mutex_);
+
+  // Set once the server stopped while a request was in flight.
+  mutable std::atomic<bool> broken_{false};
+};
+
+StatusOr<std::string> SidecarConnection::Call(SidecarOperation operation,
+                                              absl::string_view name,
+                                              absl::string_view input,
+                                              absl::string_view argument,
+                                              uint32_t output_length) const {
+  if (name.size() + input.size() + argument.size() > max_payload_size()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "Request exceeds the slot size of the sidecar");
+  }
+  if (broken_.load()) return Broken();
+  RingBackoff backoff;
+  uint64_t request_id;
+  {
+    absl::MutexLock lock(&send_mutex_);
+    SharedMemoryRing requests = channel_.requests;
+    char* slot;
+    while ((slot = requests.BeginPush()) == nullptr) {
+      if (!region_->server_running()) return Broken();
+      backoff.Wait();
+    }
+    request_id = next_request_id_++;
+    SlotHeader header = {};
+    header.request_id = request_id;
+    header.operation = static_cast<uint32_t>(operation);
+    header.name_size = name.size();
+    header.input_size = input.size();
+    header.argument_size = argument.size();
+    header.output_length = output_length;
+    std::memcpy(slot, &header, sizeof(header));
+    char* payload = slot + sizeof(header);
+    std::memcpy(payload, name.data(), name.size());
+    std::memcpy(payload + name.size(), input.data(), input.size());
+    std::memcpy(payload + name.size() + input.size(), argument.data(),
+                argument.size());
+    requests.EndPush();
+  }
+
+  backoff.Reset();
+  absl::MutexLock lock(&receive_mutex_);
+  SharedMemoryRing responses = channel_.responses;
+  while (true) {
+    auto it = responses_.find(request_id);
+    if (it != responses_.end()) {
+      StatusOr<std::string> result = std::move(it->second);
+      responses_.erase(it);
+      return result;
+    }
+    if (broken_.load()) return Broken();
+    const char* slot = responses.BeginPop();
+    if (slot == nullptr) {
+      if (!region_->server_running()) return Broken();
+      backoff.Wait();
+      continue;
+    }
+    backoff.Reset();
+    uint64_t response_id;
+    std::memcpy(&response_id, slot, sizeof(response_id));
+    StatusOr<std::string> result = ParseResponse(slot);
+    responses.EndPop();
+    if (response_id == request_id) return result;
+    responses_.emplace(response_id, std::move(result));
+  }
+}
+
+StatusOr<std::string> SidecarConnection::ParseResponse(
+    const char* slot) const {
+  SlotHeader header;
+  std::memcpy(&header, slot, sizeof(header));
+  if (header.input_size > max_payload_size()) {
+    return Status(util::error::INTERNAL,
+                  "Response exceeds the slot size of the sidecar");
+  }
+  std::string output(slot + sizeof(header), header.input_size);
+  if (header.status_code == util::error::OK) return output;
+  util::error::Code code = util::error::UNKNOWN;
+  if (header.status_code <= util::error::UNAUTHENTICATED) {
+    code = static_cast<util::error::Code>(header.status_code);
+  }
+  return Status(code, output);
+}
+
+namespace {
+
+class SidecarAead : public Aead {
+ public:
+  SidecarAead(std::shared_ptr<SidecarConnection> connection,
+              absl::string_view name)
+      : connection_(std::move(connection)), name_(name) {}
+
+  StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override {
+    return connection_->Call(SidecarOperation::kAeadEncrypt, name_, plaintext,
+                             associated_data, 0);
+  }
+
+  StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override {
+    return connection_->Call(SidecarOperation::kAeadDecrypt, name_,
+                             ciphertext, associated_data, 0);
+  }
+
+ private:
+  const std::shared_ptr<SidecarConnection> connection_;
+  const std::string name_;
+};
+
+class SidecarMac : public Mac {
+ public:
+  SidecarMac(std::shared_ptr<SidecarConnection> connection,
+             absl::string_view name)
+      : connection_(std::move(connection)), name_(name) {}
+
+  StatusOr<std::string> ComputeMac(absl::string_view data) const override {
+    return connection_->Call(SidecarOperation::kMacCompute, name_, data, "",
+                             0);
+  }
+
+  Status VerifyMac(absl::string_view mac_value,
+                   absl::string_view data) const override {
+    return connection_
+        ->Call(SidecarOperation::kMacVerify, name_, data, mac_value, 0)
+        .status();
+  }
+
+ private:
+  const std::shared_ptr<SidecarConnection> connection_;
+  const std::string name_;
+};
+
+class SidecarPrf : public Prf {
+ public:
+  SidecarPrf(std::shared_ptr<SidecarConnection> connection,
+             absl::string_view name)
+      : connection_(std::move(connection)), name_(name) {}
+
+  StatusOr<std::string> Compute(absl::string_view input,
+                                size_t output_length) const override {
+    if (output_length > connection_->max_payload_size()) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    "Output length exceeds the slot size of the sidecar");
+    }
+    return connection_->Call(SidecarOperation::kPrfCompute, name_, input, "",
+                             output_length);
+  }
+
+ private:
+  const std::shared_ptr<SidecarConnection> connection_;
+  const std::string name_;
+};
+
+}  // namespace
+
+// static
+StatusOr<std::unique_ptr<SidecarClient>> SidecarClient::Connect(
+    const std::string& path) {
+  auto region_result = SidecarRegion::Open(path);
+  if (!region_result.ok()) return region_result.status();
+  std::unique_ptr<SidecarRegion> region =
+      std::move(region_result.ValueOrDie());
+  if (!region->server_running()) {
+    return Status(util::error::UNAVAILABLE,
+                  "The sidecar server is not running");
+  }
+  auto channel_result = region->ClaimChannel();
+  if (!channel_result.ok()) return channel_result.status();
+  return {absl::WrapUnique(
+      new SidecarClient(std::make_shared<SidecarConnection>(
+          std::move(region), channel_result.ValueOrDie())))};
+}
+
+SidecarClient::SidecarClient(std::shared_ptr<SidecarConnection> connection)
+    : connection_(std::move(connection)) {}
+
+SidecarClient::~SidecarClient() {}
+
+StatusOr<std::unique_ptr<Aead>> SidecarClient::GetAead(
+    absl::string_view name) const {
+  return {absl::make_unique<SidecarAead>(connection_, name)};
+}
+
+StatusOr<std::unique_ptr<Mac>> SidecarClient::GetMac(
+    absl::string_view name) const {
+  return {absl::make_unique<SidecarMac>(connection_, name)};
+}
+
+StatusOr<std::unique_ptr<Prf>> SidecarClient::GetPrf(
+    absl::string_view name) const {
+  return {absl::make_unique<SidecarPrf>(connection_, name)};
+}
+
+size_t SidecarClient::max_message_size() const {
+  return connection_->max_payload_size();
+}
+
+}  // namespace sidecar
+}  // namespace tink
+}  // namespace crypto
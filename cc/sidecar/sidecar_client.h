@@ -0,0 +1,79 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SIDECAR_SIDECAR_CLIENT_H_
+#define TINK_SIDECAR_SIDECAR_CLIENT_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/mac.h"
+#include "tink/prf/prf_set.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace sidecar {
+
+class SidecarConnection;
+
+// SidecarClient connects to the SidecarServer of the host, and returns
+// primitives which run on the server's keys.  The primitives implement the
+// usual interfaces, so code which uses them does not change.
+//
+// A client claims one channel of the server for as long as it or any of
+// its primitives exists.  All of them may be used from many threads; the
+// requests share the channel, so a process usually needs one client.
+//
+// Requests and responses are limited to the slot size of the server, which
+// max_message_size() bounds from above.  If the server stops, all
+// operations fail with UNAVAILABLE, and a new client must be connected.
+class SidecarClient {
+ public:
+  // Connects to the server whose region is at 'path'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<SidecarClient>> Connect(
+      const std::string& path);
+
+  ~SidecarClient();
+
+  // Returns the Aead, Mac or primary PRF which the server has under
+  // 'name'.  Whether it has one is checked by the first operation, which
+  // fails with NOT_FOUND if not.
+  crypto::tink::util::StatusOr<std::unique_ptr<Aead>> GetAead(
+      absl::string_view name) const;
+  crypto::tink::util::StatusOr<std::unique_ptr<Mac>> GetMac(
+      absl::string_view name) const;
+  crypto::tink::util::StatusOr<std::unique_ptr<Prf>> GetPrf(
+      absl::string_view name) const;
+
+  // The size which the name of the primitive, the input and the associated
+  // data or tag of a request may take together.
+  size_t max_message_size() const;
+
+ private:
+  explicit SidecarClient(std::shared_ptr<SidecarConnection> connection);
+
+  const std::shared_ptr<SidecarConnection> connection_;
+};
+
+}  // namespace sidecar
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SIDECAR_SIDECAR_CLIENT_H_
@@ -0,0 +1,280 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/sidecar/sidecar_region.h"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "tink/sidecar/shared_memory_ring.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace sidecar {
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace {
+
+constexpr uint64_t kMagic = 0x72616364697354ULL;  // "Tsidcar"
+constexpr uint32_t kVersion = 1;
+constexpr size_t kAlignment = 64;
+constexpr int kMaxChannels = 4096;
+constexpr int kMaxSlotsPerRing = 1024;
+constexpr int kMaxSlotSize = 16 * 1024 * 1024;
+
+size_t RoundUp(size_t size) {
+  return (size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+// Attempts to close file descriptor fd, while ignoring EINTR.
+int close_ignoring_eintr(int fd) {
+  int result;
+  do {
+    result = close(fd);
+  } while (result < 0 && errno == EINTR);
+  return result;
+}
+
+}  // namespace
+
+struct SidecarRegion::Header {
+  // Written last by Create(), so that Open() never sees a region which is
+  // not set up yet.
+  std::atomic<uint64_t> magic;
+  uint32_t version;
+  uint32_t num_channels;
+  uint32_t slots_per_ring;
+  uint32_t slot_size;
+  std::atomic<uint32_t> server_running;
+};
+
+namespace {
+
+constexpr size_t kHeaderSize = 64;
+constexpr size_t kOwnerSize = 64;
+
+size_t RingSize(uint32_t slots_per_ring, uint32_t slot_size) {
+  return RoundUp(SharedMemoryRing::RequiredSize(slots_per_ring, slot_size));
+}
+
+size_t RegionSize(uint32_t num_channels, uint32_t slots_per_ring,
+                  uint32_t slot_size) {
+  return kHeaderSize +
+         num_channels * (kOwnerSize + 2 * RingSize(slots_per_ring, slot_size));
+}
+
+}  // namespace
+
+// static
+StatusOr<std::unique_ptr<SidecarRegion>> SidecarRegion::Create(
+    const std::string& path, const Options& options) {
+  static_assert(sizeof(Header) <= kHeaderSize, "Header too large");
+  if (options.num_channels < 1 || options.num_channels > kMaxChannels) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "num_channels must be in [1, %d]", kMaxChannels);
+  }
+  if (options.slots_per_ring < 1 ||
+      options.slots_per_ring > kMaxSlotsPerRing) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "slots_per_ring must be in [1, %d]", kMaxSlotsPerRing);
+  }
+  if (options.slot_size < 256 || options.slot_size > kMaxSlotSize ||
+      options.slot_size % kAlignment != 0) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "slot_size must be a multiple of %d in [256, %d]",
+                     static_cast<int>(kAlignment), kMaxSlotSize);
+  }
+  if (unlink(path.c_str()) != 0 && errno != ENOENT) {
+    return ToStatusF(util::error::INTERNAL, "unlink of %s failed: %d", path,
+                     errno);
+  }
+  int fd = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC,
+                options.mode);
+  if (fd < 0) {
+    return ToStatusF(util::error::INTERNAL, "Cannot create %s: %d", path,
+                     errno);
+  }
+  size_t size = RegionSize(options.num_channels, options.slots_per_ring,
+                           options.slot_size);
+  // The mode passed to open() is subject to the umask.
+  if (fchmod(fd, options.mode) != 0 || ftruncate(fd, size) != 0) {
+    int truncate_errno = errno;
+    close_ignoring_eintr(fd);
+    unlink(path.c_str());
+    return ToStatusF(util::error::INTERNAL, "Cannot size %s: %d", path,
+                     truncate_errno);
+  }
+  void* memory =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int mmap_errno = errno;
+  close_ignoring_eintr(fd);
+  if (memory == MAP_FAILED) {
+    unlink(path.c_str());
+    return ToStatusF(util::error::INTERNAL, "mmap failed: %d", mmap_errno);
+  }
+
+  Header* header = new (memory) Header;
+  header->version = kVersion;
+  header->num_channels = options.num_channels;
+  header->slots_per_ring = options.slots_per_ring;
+  header->slot_size = options.slot_size;
+  header->server_running.store(0, std::memory_order_relaxed);
+  std::unique_ptr<SidecarRegion> region(new SidecarRegion(memory, size));
+  for (int i = 0; i < options.num_channels; i++) {
+    char* channel = region->channel_memory(i);
+    new (channel) std::atomic<int32_t>(0);
+    SharedMemoryRing::Initialize(channel + kOwnerSize);
+    SharedMemoryRing::Initialize(channel + kOwnerSize + region->ring_size_);
+  }
+  header->magic.store(kMagic, std::memory_order_release);
+  return std::move(region);
+}
+
+// static
+StatusOr<std::unique_ptr<SidecarRegion>> SidecarRegion::Open(
+    const std::string& path) {
+  int fd = open(path.c_str(), O_RDWR | O_CLOEXEC);
+  if (fd < 0) {
+    return ToStatusF(errno == ENOENT ? util::error::UNAVAILABLE
+                                     : util::error::INTERNAL,
+                     "Cannot open %s: %d", path, errno);
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    int fstat_errno = errno;
+    close_ignoring_eintr(fd);
+    return ToStatusF(util::error::INTERNAL, "fstat failed: %d", fstat_errno);
+  }
+  size_t size = file_stat.st_size;
+  if (size < kHeaderSize) {
+    close_ignoring_eintr(fd);
+    return ToStatusF(util::error::UNAVAILABLE, "%s is not set up yet", path);
+  }
+  void* memory =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  int mmap_errno = errno;
+  close_ignoring_eintr(fd);
+  if (memory == MAP_FAILED) {
+    return ToStatusF(util::error::INTERNAL, "mmap failed: %d", mmap_errno);
+  }
+  std::unique_ptr<SidecarRegion> region(new SidecarRegion(memory, size));
+  if (region->header_->magic.load(std::memory_order_acquire) != kMagic) {
+    return ToStatusF(util::error::UNAVAILABLE,
+                     "%s is not a sidecar region, or not set up yet", path);
+  }
+  const Header& header = *region->header_;
+  if (header.version != kVersion) {
+    return ToStatusF(util::error::FAILED_PRECONDITION,
+                     "%s has version %d, expected %d", path,
+                     header.version, kVersion);
+  }
+  if (header.num_channels < 1 || header.num_channels > kMaxChannels ||
+      header.slots_per_ring < 1 || header.slots_per_ring > kMaxSlotsPerRing ||
+      header.slot_size < 256 || header.slot_size > kMaxSlotSize ||
+      header.slot_size % kAlignment != 0 ||
+      RegionSize(header.num_channels, header.slots_per_ring,
+                 header.slot_size) > size) {
+    return ToStatusF(util::error::FAILED_PRECONDITION,
+                     "%s has an invalid layout", path);
+  }
+  return std::move(region);
+}
+
+SidecarRegion::SidecarRegion(void* memory, size_t size)
+    : memory_(memory), size_(size), header_(static_cast<Header*>(memory)) {
+  num_channels_ = header_->num_channels;
+  slots_per_ring_ = header_->slots_per_ring;
+  slot_size_ = header_->slot_size;
+  ring_size_ = RingSize(slots_per_ring_, slot_size_);
+}
+
+SidecarRegion::~SidecarRegion() { munmap(memory_, size_); }
+
+size_t SidecarRegion::max_payload_size() const {
+  return slot_size_ - sizeof(SlotHeader);
+}
+
+char* SidecarRegion::channel_memory(int index) const {
+  return static_cast<char*>(memory_) + kHeaderSize +
+         index * (kOwnerSize + 2 * ring_size_);
+}
+
+SidecarChannel SidecarRegion::channel(int index) const {
+  char* memory = channel_memory(index);
+  SidecarChannel channel;
+  channel.owner_pid = reinterpret_cast<std::atomic<int32_t>*>(memory);
+  channel.requests =
+      SharedMemoryRing(memory + kOwnerSize, slots_per_ring_, slot_size_);
+  channel.responses = SharedMemoryRing(memory + kOwnerSize + ring_size_,
+                                       slots_per_ring_, slot_size_);
+  return channel;
+}
+
+bool SidecarRegion::server_running() const {
+  return header_->server_running.load(std::memory_order_acquire) != 0;
+}
+
+void SidecarRegion::set_server_running(bool running) {
+  header_->server_running.store(running ? 1 : 0, std::memory_order_release);
+}
+
+StatusOr<int> SidecarRegion::ClaimChannel() {
+  int32_t pid = getpid();
+  for (int i = 0; i < num_channels_; i++) {
+    int32_t expected = 0;
+    if (channel(i).owner_pid->compare_exchange_strong(
+            expected, pid, std::memory_order_acq_rel)) {
+      return i;
+    }
+  }
+  return Status(util::error::RESOURCE_EXHAUSTED,
+                "All channels of the sidecar are in use");
+}
+
+void SidecarRegion::ReleaseChannel(int index) {
+  channel(index).owner_pid->store(0, std::memory_order_release);
+}
+
+bool SidecarRegion::ReclaimIfAbandoned(int index) {
+  SidecarChannel abandoned = channel(index);
+  int32_t pid = abandoned.owner_pid->load(std::memory_order_acquire);
+  // EPERM means that the process exists, but belongs to another user.
+  if (pid == 0 || kill(pid, 0) == 0 || errno != ESRCH) return false;
+  abandoned.requests.Reset();
+  abandoned.responses.Reset();
+  abandoned.owner_pid->store(0, std::memory_order_release);
+  return true;
+}
+
+}  // namespace sidecar
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,141 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SIDECAR_SIDECAR_REGION_H_
+#define TINK_SIDECAR_SIDECAR_REGION_H_
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "tink/sidecar/shared_memory_ring.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace sidecar {
+
+// The operations which a client can request.
+enum class SidecarOperation : uint32_t {
+  kAeadEncrypt = 1,
+  kAeadDecrypt = 2,
+  kMacCompute = 3,
+  kMacVerify = 4,
+  kPrfCompute = 5,
+};
+
+// The header of every slot.  A request slot carries the name of the
+// primitive, the input and the argument (the associated data, or the tag
+// to verify) after the header; a response slot carries the output, or the
+// error message if status_code is not OK.
+struct SlotHeader {
+  uint64_t request_id;
+  uint32_t operation;
+  uint32_t status_code;
+  uint32_t name_size;
+  // The size of the output in responses.
+  uint32_t input_size;
+  uint32_t argument_size;
+  // The output length of kPrfCompute.
+  uint32_t output_length;
+};
+
+// The two rings of one client: requests flow from the client to the
+// server, responses back.  A client owns a channel for as long as it is
+// connected.
+struct SidecarChannel {
+  // The pid of the owning process, or 0 if the channel is free.
+  std::atomic<int32_t>* owner_pid;
+  SharedMemoryRing requests;
+  SharedMemoryRing responses;
+};
+
+// A file mapped into the server and all client processes, which holds a
+// fixed number of channels.  Whoever can open the file can use every
+// primitive of the server, so its permissions are the access control.
+class SidecarRegion {
+ public:
+  struct Options {
+    // The maximal number of clients connected at once.
+    int num_channels = 64;
+    // The number of requests a client can have in flight.
+    int slots_per_ring = 8;
+    // The size of a slot, which bounds the size of a request and of a
+    // response, including the SlotHeader and the name of the primitive.
+    int slot_size = 8192;
+    // The permissions of the file.
+    mode_t mode = 0600;
+  };
+
+  // Creates a new region at 'path', typically on a tmpfs such as /dev/shm.
+  // An existing file at 'path' is unlinked first: clients which still map
+  // it see that its server stopped, rather than the new server's memory.
+  static crypto::tink::util::StatusOr<std::unique_ptr<SidecarRegion>> Create(
+      const std::string& path, const Options& options);
+
+  // Maps the region which a server created at 'path'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<SidecarRegion>> Open(
+      const std::string& path);
+
+  ~SidecarRegion();
+
+  int num_channels() const { return num_channels_; }
+  // The space for the name, input and argument of a request, or for the
+  // output of a response.
+  size_t max_payload_size() const;
+
+  SidecarChannel channel(int index) const;
+
+  // Whether a server serves the region.
+  bool server_running() const;
+  void set_server_running(bool running);
+
+  // Claims a free channel for the calling process, and returns its index.
+  // Fails with RESOURCE_EXHAUSTED if all channels are in use.
+  crypto::tink::util::StatusOr<int> ClaimChannel();
+
+  // Frees the channel 'index', whose rings must be empty.
+  void ReleaseChannel(int index);
+
+  // Frees the channel 'index' if its owner process has exited, and returns
+  // whether it did.  Only the thread which serves the channel may call it.
+  bool ReclaimIfAbandoned(int index);
+
+ private:
+  struct Header;
+
+  SidecarRegion(void* memory, size_t size);
+
+  char* channel_memory(int index) const;
+
+  void* const memory_;
+  const size_t size_;
+  Header* const header_;
+  int num_channels_ = 0;
+  uint32_t slots_per_ring_ = 0;
+  uint32_t slot_size_ = 0;
+  size_t ring_size_ = 0;
+};
+
+}  // namespace sidecar
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SIDECAR_SIDECAR_REGION_H_
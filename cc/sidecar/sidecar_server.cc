@@ -0,0 +1,303 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/sidecar/sidecar_server.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/keyset_handle.h"
+#include "tink/mac.h"
+#include "tink/prf/prf_set.h"
+#include "tink/sidecar/shared_memory_ring.h"
+#include "tink/sidecar/sidecar_region.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace sidecar {
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace {
+
+// The number of idle polls of all channels between checks for channels
+// whose client exited without releasing them.
+constexpr int kPollsPerReclaim = 4096;
+
+}  // namespace
+
+// static
+StatusOr<std::unique_ptr<SidecarServer>> SidecarServer::New(
+    const std::string& path, const Options& options) {
+  if (options.num_threads < 1) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "num_threads must be positive");
+  }
+  auto region_result = SidecarRegion::Create(path, options.region);
+  if (!region_result.ok()) return region_result.status();
+  return {absl::WrapUnique(
+      new SidecarServer(path, std::move(region_result.ValueOrDie()),
+                        std::min(options.num_threads,
+                                 options.region.num_channels)))};
+}
+
+SidecarServer::~SidecarServer() {
+  Stop();
+  unlink(path_.c_str());
+}
+
+Status SidecarServer::CheckCanAdd(absl::string_view name) const {
+  if (!threads_.empty()) {
+    return Status(util::error::FAILED_PRECONDITION,
+                  "Primitives must be added before Start()");
+  }
+  if (name.empty() || name.size() > region_->max_payload_size() / 2) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("Invalid primitive name '", name, "'"));
+  }
+  return Status::OK;
+}
+
+Status SidecarServer::AddAead(absl::string_view name,
+                              std::unique_ptr<Aead> aead) {
+  Status status = CheckCanAdd(name);
+  if (!status.ok()) return status;
+  if (aead == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT, "aead must not be null");
+  }
+  if (!aeads_.emplace(std::string(name), std::move(aead)).second) {
+    return Status(util::error::ALREADY_EXISTS,
+                  absl::StrCat("There already is an AEAD named '", name, "'"));
+  }
+  return Status::OK;
+}
+
+Status SidecarServer::AddMac(absl::string_view name, std::unique_ptr<Mac> mac) {
+  Status status = CheckCanAdd(name);
+  if (!status.ok()) return status;
+  if (mac == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT, "mac must not be null");
+  }
+  if (!macs_.emplace(std::string(name), std::move(mac)).second) {
+    return Status(util::error::ALREADY_EXISTS,
+                  absl::StrCat("There already is a MAC named '", name, "'"));
+  }
+  return Status::OK;
+}
+
+Status SidecarServer::AddPrfSet(absl::string_view name,
+                                std::unique_ptr<PrfSet> prf_set) {
+  Status status = CheckCanAdd(name);
+  if (!status.ok()) return status;
+  if (prf_set == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT, "prf_set must not be null");
+  }
+  if (!prf_sets_.emplace(std::string(name), std::move(prf_set)).second) {
+    return Status(util::error::ALREADY_EXISTS,
+                  absl::StrCat("There already is a PRF named '", name, "'"));
+  }
+  return Status::OK;
+}
+
+Status SidecarServer::AddKeyset(absl::string_view name,
+                                const KeysetHandle& keyset_handle) {
+  Status status = CheckCanAdd(name);
+  if (!status.ok()) return status;
+  bool added = false;
+  auto aead_result = keyset_handle.GetPrimitive<Aead>();
+  if (aead_result.ok()) {
+    status = AddAead(name, std::move(aead_result.ValueOrDie()));
+    if (!status.ok()) return status;
+    added = true;
+  }
+  auto mac_result = keyset_handle.GetPrimitive<Mac>();
+  if (mac_result.ok()) {
+    status = AddMac(name, std::move(mac_result.ValueOrDie()));
+    if (!status.ok()) return status;
+    added = true;
+  }
+  auto prf_set_result = keyset_handle.GetPrimitive<PrfSet>();
+  if (prf_set_result.ok()) {
+    status = AddPrfSet(name, std::move(prf_set_result.ValueOrDie()));
+    if (!status.ok()) return status;
+    added = true;
+  }
+  if (!added) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("Keyset '", name,
+                               "' has no AEAD, MAC or PRF primitive"));
+  }
+  return Status::OK;
+}
+
+void SidecarServer::Start() {
+  if (!threads_.empty()) return;
+  stopping_.store(false, std::memory_order_release);
+  region_->set_server_running(true);
+  for (int i = 0; i < num_threads_; i++) {
+    threads_.emplace_back([this, i]() { Serve(i); });
+  }
+}
+
+void SidecarServer::Stop() {
+  stopping_.store(true, std::memory_order_release);
+  for (std::thread& thread : threads_) thread.join();
+  region_->set_server_running(false);
+}
+
+void SidecarServer::Serve(int index) {
+  RingBackoff backoff;
+  int idle_polls = 0;
+  while (!stopping_.load(std::memory_order_acquire)) {
+    bool served = false;
+    for (int i = index; i < region_->num_channels(); i += num_threads_) {
+      served |= ServeRequest(region_->channel(i));
+    }
+    if (served) {
+      backoff.Reset();
+      continue;
+    }
+    if (++idle_polls % kPollsPerReclaim == 0) {
+      for (int i = index; i < region_->num_channels(); i += num_threads_) {
+        region_->ReclaimIfAbandoned(i);
+      }
+    }
+    backoff.Wait();
+  }
+}
+
+bool SidecarServer::ServeRequest(const SidecarChannel& channel) {
+  // Free channels have empty rings, so they are skipped here.
+  SharedMemoryRing requests = channel.requests;
+  SharedMemoryRing responses = channel.responses;
+  const char* request = requests.BeginPop();
+  if (request == nullptr) return false;
+  char* response = responses.BeginPush();
+  // The client has not yet read the responses to its earlier requests.
+  if (response == nullptr) return false;
+
+  // The client can write to the slot at any time, so every field is read
+  // once, and the sizes are checked before they are used.
+  SlotHeader header;
+  std::memcpy(&header, request, sizeof(header));
+  const char* payload = request + sizeof(header);
+  size_t max_payload_size = region_->max_payload_size();
+  StatusOr<std::string> result;
+  if (static_cast<uint64_t>(header.name_size) + header.input_size +
+          header.argument_size >
+          max_payload_size ||
+      header.output_length > max_payload_size) {
+    result = Status(util::error::INVALID_ARGUMENT,
+                    "Request exceeds the slot size");
+  } else {
+    result = Execute(
+        header.operation, absl::string_view(payload, header.name_size),
+        absl::string_view(payload + header.name_size, header.input_size),
+        absl::string_view(payload + header.name_size + header.input_size,
+                          header.argument_size),
+        header.output_length);
+  }
+
+  SlotHeader reply = {};
+  reply.request_id = header.request_id;
+  reply.operation = header.operation;
+  absl::string_view output;
+  std::string error_message;
+  if (result.ok() && result.ValueOrDie().size() > max_payload_size) {
+    result = Status(util::error::RESOURCE_EXHAUSTED,
+                    "Response exceeds the slot size");
+  }
+  if (result.ok()) {
+    reply.status_code = util::error::OK;
+    output = result.ValueOrDie();
+  } else {
+    reply.status_code = result.status().CanonicalCode();
+    error_message = result.status().error_message();
+    output = absl::string_view(error_message)
+                 .substr(0, std::min(error_message.size(), max_payload_size));
+  }
+  reply.input_size = output.size();
+  std::memcpy(response, &reply, sizeof(reply));
+  std::memcpy(response + sizeof(reply), output.data(), output.size());
+  requests.EndPop();
+  responses.EndPush();
+  return true;
+}
+
+StatusOr<std::string> SidecarServer::Execute(uint32_t operation,
+                                             absl::string_view name,
+                                             absl::string_view input,
+                                             absl::string_view argument,
+                                             uint32_t output_length) const {
+  switch (static_cast<SidecarOperation>(operation)) {
+    case SidecarOperation::kAeadEncrypt:
+    case SidecarOperation::kAeadDecrypt: {
+      auto it = aeads_.find(name);
+      if (it == aeads_.end()) {
+        return Status(util::error::NOT_FOUND,
+                      absl::StrCat("No AEAD named '", name, "'"));
+      }
+      if (static_cast<SidecarOperation>(operation) ==
+          SidecarOperation::kAeadEncrypt) {
+        return it->second->Encrypt(input, argument);
+      }
+      return it->second->Decrypt(input, argument);
+    }
+    case SidecarOperation::kMacCompute:
+    case SidecarOperation::kMacVerify: {
+      auto it = macs_.find(name);
+      if (it == macs_.end()) {
+        return Status(util::error::NOT_FOUND,
+                      absl::StrCat("No MAC named '", name, "'"));
+      }
+      if (static_cast<SidecarOperation>(operation) ==
+          SidecarOperation::kMacCompute) {
+        return it->second->ComputeMac(input);
+      }
+      Status status = it->second->VerifyMac(argument, input);
+      if (!status.ok()) return status;
+      return std::string();
+    }
+    case SidecarOperation::kPrfCompute: {
+      auto it = prf_sets_.find(name);
+      if (it == prf_sets_.end()) {
+        return Status(util::error::NOT_FOUND,
+                      absl::StrCat("No PRF named '", name, "'"));
+      }
+      return it->second->ComputePrimary(input, output_length);
+    }
+  }
+  return Status(util::error::INVALID_ARGUMENT,
+                absl::StrCat("Unknown operation ", operation));
+}
+
+}  // namespace sidecar
+}  // namespace tink
+}  // namespace crypto
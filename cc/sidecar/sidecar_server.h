@@ -0,0 +1,118 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SIDECAR_SIDECAR_SERVER_H_
+#define TINK_SIDECAR_SIDECAR_SERVER_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/keyset_handle.h"
+#include "tink/mac.h"
+#include "tink/prf/prf_set.h"
+#include "tink/sidecar/sidecar_region.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace sidecar {
+
+// SidecarServer serves the Aead, Mac and PrfSet primitives of one process
+// to the other processes of a host, through a SidecarRegion.  Processes
+// which would each load the same keysets, and each unwrap them with a KMS,
+// instead connect a SidecarClient, and share the primitives of the server.
+//
+// Each client has a channel of its own: a pair of lock-free rings in shared
+// memory, which the threads of the server poll.  A request therefore costs
+// no system call while the server is busy, at the price of the polling
+// threads spinning for a while after the last request.
+//
+// The primitives are added before Start(), under names by which clients
+// refer to them.  Keys never leave the server; the clients only see the
+// results.
+class SidecarServer {
+ public:
+  struct Options {
+    SidecarRegion::Options region;
+    // The number of threads which poll the channels.  Each channel is
+    // served by one thread, so that its requests are answered in order.
+    int num_threads = 1;
+  };
+
+  // Creates a server whose region is at 'path'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<SidecarServer>> New(
+      const std::string& path, const Options& options);
+
+  // Stops the server and unlinks its region.
+  ~SidecarServer();
+
+  crypto::tink::util::Status AddAead(absl::string_view name,
+                                     std::unique_ptr<Aead> aead);
+  crypto::tink::util::Status AddMac(absl::string_view name,
+                                    std::unique_ptr<Mac> mac);
+  crypto::tink::util::Status AddPrfSet(absl::string_view name,
+                                       std::unique_ptr<PrfSet> prf_set);
+
+  // Adds whichever of the Aead, Mac and PrfSet primitives 'keyset_handle'
+  // has, under 'name'.  Fails if it has none of them.
+  crypto::tink::util::Status AddKeyset(absl::string_view name,
+                                       const KeysetHandle& keyset_handle);
+
+  // Starts serving requests.  No primitive may be added afterwards.
+  void Start();
+
+  // Stops serving requests.  Clients waiting for a response fail with
+  // UNAVAILABLE.
+  void Stop();
+
+ private:
+  SidecarServer(const std::string& path, std::unique_ptr<SidecarRegion> region,
+                int num_threads)
+      : path_(path), region_(std::move(region)), num_threads_(num_threads) {}
+
+  crypto::tink::util::Status CheckCanAdd(absl::string_view name) const;
+
+  // Polls the channels index, index + num_threads_, ...
+  void Serve(int index);
+  // Answers the next request of 'channel', if there is one and there is
+  // room for the response.  Returns whether it did.
+  bool ServeRequest(const SidecarChannel& channel);
+  crypto::tink::util::StatusOr<std::string> Execute(
+      uint32_t operation, absl::string_view name, absl::string_view input,
+      absl::string_view argument, uint32_t output_length) const;
+
+  const std::string path_;
+  const std::unique_ptr<SidecarRegion> region_;
+  const int num_threads_;
+  absl::flat_hash_map<std::string, std::unique_ptr<Aead>> aeads_;
+  absl::flat_hash_map<std::string, std::unique_ptr<Mac>> macs_;
+  absl::flat_hash_map<std::string, std::unique_ptr<PrfSet>> prf_sets_;
+  std::vector<std::thread> threads_;
+  std::atomic<bool> stopping_{false};
+};
+
+}  // namespace sidecar
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SIDECAR_SIDECAR_SERVER_H_
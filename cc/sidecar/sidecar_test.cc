@@ -0,0 +1,281 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tink/aead.h"
+#include "tink/mac.h"
+#include "tink/prf/prf_set.h"
+#include "tink/sidecar/sidecar_client.h"
+#include "tink/sidecar/sidecar_server.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace sidecar {
+namespace {
+
+using crypto::tink::test::DummyAead;
+using crypto::tink::test::DummyMac;
+using crypto::tink::util::StatusOr;
+
+class DummyPrf : public Prf {
+ public:
+  StatusOr<std::string> Compute(absl::string_view input,
+                                size_t output_length) const override {
+    std::string output = absl::StrCat("prf:", input);
+    output.resize(output_length, '.');
+    return output;
+  }
+};
+
+class DummyPrfSet : public PrfSet {
+ public:
+  DummyPrfSet() { prfs_[1] = &prf_; }
+  uint32_t GetPrimaryId() const override { return 1; }
+  const std::map<uint32_t, Prf*>& GetPrfs() const override { return prfs_; }
+
+ private:
+  DummyPrf prf_;
+  std::map<uint32_t, Prf*> prfs_;
+};
+
+std::string RegionPath() {
+  return absl::StrCat(
+      test::TmpDir(), "/sidecar_",
+      ::testing::UnitTest::GetInstance()->current_test_info()->name());
+}
+
+std::unique_ptr<SidecarServer> NewServer(
+    const SidecarServer::Options& options) {
+  auto server = SidecarServer::New(RegionPath(), options).ValueOrDie();
+  EXPECT_TRUE(
+      server->AddAead("aead", absl::make_unique<DummyAead>("aead")).ok());
+  EXPECT_TRUE(server->AddMac("mac", absl::make_unique<DummyMac>("mac")).ok());
+  EXPECT_TRUE(server->AddPrfSet("prf", absl::make_unique<DummyPrfSet>()).ok());
+  server->Start();
+  return server;
+}
+
+TEST(SidecarTest, Aead) {
+  auto server = NewServer(SidecarServer::Options());
+  auto client = SidecarClient::Connect(RegionPath()).ValueOrDie();
+  auto aead = client->GetAead("aead").ValueOrDie();
+
+  DummyAead expected("aead");
+  auto ciphertext = aead->Encrypt("plaintext", "associated data");
+  ASSERT_TRUE(ciphertext.ok()) << ciphertext.status();
+  EXPECT_EQ(expected.Encrypt("plaintext", "associated data").ValueOrDie(),
+            ciphertext.ValueOrDie());
+  auto plaintext = aead->Decrypt(ciphertext.ValueOrDie(), "associated data");
+  ASSERT_TRUE(plaintext.ok()) << plaintext.status();
+  EXPECT_EQ("plaintext", plaintext.ValueOrDie());
+
+  // The error of the server's primitive is passed on.
+  auto result = aead->Decrypt(ciphertext.ValueOrDie(), "other data");
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+  EXPECT_EQ("Dummy operation failed.", result.status().error_message());
+}
+
+TEST(SidecarTest, MacAndPrf) {
+  auto server = NewServer(SidecarServer::Options());
+  auto client = SidecarClient::Connect(RegionPath()).ValueOrDie();
+
+  auto mac = client->GetMac("mac").ValueOrDie();
+  auto tag = mac->ComputeMac("data");
+  ASSERT_TRUE(tag.ok()) << tag.status();
+  EXPECT_EQ(DummyMac("mac").ComputeMac("data").ValueOrDie(), tag.ValueOrDie());
+  EXPECT_TRUE(mac->VerifyMac(tag.ValueOrDie(), "data").ok());
+  EXPECT_FALSE(mac->VerifyMac(tag.ValueOrDie(), "other data").ok());
+
+  auto prf = client->GetPrf("prf").ValueOrDie();
+  auto output = prf->Compute("input", 16);
+  ASSERT_TRUE(output.ok()) << output.status();
+  EXPECT_EQ("prf:input.......", output.ValueOrDie());
+}
+
+TEST(SidecarTest, UnknownPrimitive) {
+  auto server = NewServer(SidecarServer::Options());
+  auto client = SidecarClient::Connect(RegionPath()).ValueOrDie();
+  EXPECT_EQ(util::error::NOT_FOUND,
+            client->GetAead("unknown")
+                .ValueOrDie()
+                ->Encrypt("plaintext", "")
+                .status()
+                .error_code());
+  // Names are per primitive.
+  EXPECT_EQ(util::error::NOT_FOUND,
+            client->GetMac("aead")
+                .ValueOrDie()
+                ->ComputeMac("data")
+                .status()
+                .error_code());
+}
+
+TEST(SidecarTest, MessageSizeIsLimited) {
+  SidecarServer::Options options;
+  options.region.slot_size = 1024;
+  auto server = NewServer(options);
+  auto client = SidecarClient::Connect(RegionPath()).ValueOrDie();
+  auto aead = client->GetAead("aead").ValueOrDie();
+  EXPECT_GT(client->max_message_size(), 900);
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            aead->Encrypt(std::string(1024, 'a'), "").status().error_code());
+  // The request fits, but not the response.
+  EXPECT_EQ(util::error::RESOURCE_EXHAUSTED,
+            aead->Encrypt(std::string(client->max_message_size() - 4, 'a'),
+                          "")
+                .status()
+                .error_code());
+  EXPECT_TRUE(aead->Encrypt(std::string(900, 'a'), "").ok());
+}
+
+TEST(SidecarTest, ConcurrentClientsAndThreads) {
+  SidecarServer::Options options;
+  options.num_threads = 2;
+  options.region.slots_per_ring = 4;
+  auto server = NewServer(options);
+  const int kClients = 3;
+  const int kThreadsPerClient = 4;
+  const int kOperations = 300;
+  std::vector<std::unique_ptr<SidecarClient>> clients;
+  for (int i = 0; i < kClients; i++) {
+    clients.push_back(SidecarClient::Connect(RegionPath()).ValueOrDie());
+  }
+  std::vector<std::thread> threads;
+  for (int c = 0; c < kClients; c++) {
+    for (int t = 0; t < kThreadsPerClient; t++) {
+      threads.emplace_back([&clients, c, t, kOperations]() {
+        auto aead = clients[c]->GetAead("aead").ValueOrDie();
+        auto mac = clients[c]->GetMac("mac").ValueOrDie();
+        for (int i = 0; i < kOperations; i++) {
+          std::string message = absl::StrCat(c, "/", t, "/", i);
+          auto ciphertext = aead->Encrypt(message, "ad");
+          ASSERT_TRUE(ciphertext.ok()) << ciphertext.status();
+          auto plaintext = aead->Decrypt(ciphertext.ValueOrDie(), "ad");
+          ASSERT_TRUE(plaintext.ok()) << plaintext.status();
+          ASSERT_EQ(message, plaintext.ValueOrDie());
+          auto tag = mac->ComputeMac(message);
+          ASSERT_TRUE(tag.ok()) << tag.status();
+          ASSERT_TRUE(mac->VerifyMac(tag.ValueOrDie(), message).ok());
+        }
+      });
+    }
+  }
+  for (std::thread& thread : threads) thread.join();
+}
+
+TEST(SidecarTest, ChannelsAreReleased) {
+  SidecarServer::Options options;
+  options.region.num_channels = 1;
+  auto server = NewServer(options);
+  auto client = SidecarClient::Connect(RegionPath()).ValueOrDie();
+  auto aead = client->GetAead("aead").ValueOrDie();
+  EXPECT_EQ(util::error::RESOURCE_EXHAUSTED,
+            SidecarClient::Connect(RegionPath()).status().error_code());
+
+  // The primitive keeps the channel.
+  client.reset();
+  EXPECT_EQ(util::error::RESOURCE_EXHAUSTED,
+            SidecarClient::Connect(RegionPath()).status().error_code());
+  EXPECT_TRUE(aead->Encrypt("plaintext", "").ok());
+  aead.reset();
+  EXPECT_TRUE(SidecarClient::Connect(RegionPath()).ok());
+}
+
+TEST(SidecarTest, ChannelOfExitedProcessIsReclaimed) {
+  SidecarServer::Options options;
+  options.region.num_channels = 1;
+  auto server = NewServer(options);
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    // Exits without releasing the channel.
+    auto client = SidecarClient::Connect(RegionPath());
+    _exit(client.ok() ? 0 : 1);
+  }
+  int status;
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+  ASSERT_TRUE(WIFEXITED(status));
+  ASSERT_EQ(0, WEXITSTATUS(status));
+
+  absl::Time deadline = absl::Now() + absl::Seconds(10);
+  StatusOr<std::unique_ptr<SidecarClient>> client =
+      SidecarClient::Connect(RegionPath());
+  while (!client.ok() && absl::Now() < deadline) {
+    EXPECT_EQ(util::error::RESOURCE_EXHAUSTED,
+              client.status().error_code());
+    absl::SleepFor(absl::Milliseconds(10));
+    client = SidecarClient::Connect(RegionPath());
+  }
+  EXPECT_TRUE(client.ok()) << client.status();
+}
+
+TEST(SidecarTest, ServerStops) {
+  auto server = NewServer(SidecarServer::Options());
+  auto client = SidecarClient::Connect(RegionPath()).ValueOrDie();
+  auto aead = client->GetAead("aead").ValueOrDie();
+  ASSERT_TRUE(aead->Encrypt("plaintext", "").ok());
+  server.reset();
+  EXPECT_EQ(util::error::UNAVAILABLE,
+            aead->Encrypt("plaintext", "").status().error_code());
+  EXPECT_EQ(util::error::UNAVAILABLE,
+            SidecarClient::Connect(RegionPath()).status().error_code());
+}
+
+TEST(SidecarTest, ServerArguments) {
+  auto server =
+      SidecarServer::New(RegionPath(), SidecarServer::Options()).ValueOrDie();
+  EXPECT_EQ(util::error::UNAVAILABLE,
+            SidecarClient::Connect(RegionPath()).status().error_code());
+  EXPECT_TRUE(server->AddAead("a", absl::make_unique<DummyAead>("a")).ok());
+  EXPECT_EQ(util::error::ALREADY_EXISTS,
+            server->AddAead("a", absl::make_unique<DummyAead>("a"))
+                .error_code());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            server->AddAead("", absl::make_unique<DummyAead>("a"))
+                .error_code());
+  server->Start();
+  EXPECT_EQ(util::error::FAILED_PRECONDITION,
+            server->AddMac("m", absl::make_unique<DummyMac>("m"))
+                .error_code());
+
+  SidecarServer::Options options;
+  options.region.slot_size = 1000;
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            SidecarServer::New(RegionPath() + "_2", options)
+                .status()
+                .error_code());
+}
+
+}  // namespace
+}  // namespace sidecar
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,165 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// The sidecar daemon: loads keysets once, and serves their AEAD, MAC and
+// PRF primitives to the processes of the host through a SidecarServer.
+//
+//   tink_sidecar --region=/dev/shm/tink-sidecar
+//       --keysets=orders:orders.json,sessions:sessions.json
+//       --master_key_uri=gcp-kms://projects/p/.../cryptoKeys/k
+//
+// Clients connect with SidecarClient::Connect("/dev/shm/tink-sidecar") and
+// refer to the primitives by the names before the colons.  Without
+// --master_key_uri the keysets are read in cleartext, for development.
+
+#include <pthread.h>
+#include <signal.h>
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "tink/aead.h"
+#include "tink/aead/aead_config.h"
+#include "tink/cleartext_keyset_handle.h"
+#include "tink/integration/gcpkms/gcp_kms_client.h"
+#include "tink/json_keyset_reader.h"
+#include "tink/keyset_handle.h"
+#include "tink/kms_clients.h"
+#include "tink/mac/mac_config.h"
+#include "tink/prf/prf_config.h"
+#include "tink/sidecar/sidecar_server.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+ABSL_FLAG(std::string, region, "/dev/shm/tink-sidecar",
+          "Path of the shared memory region, on a tmpfs.");
+ABSL_FLAG(std::vector<std::string>, keysets, {},
+          "Comma-separated name:path pairs of the JSON keysets to serve.");
+ABSL_FLAG(std::string, master_key_uri, "",
+          "URI of the KMS key which encrypts the keysets; empty for "
+          "cleartext keysets.");
+ABSL_FLAG(std::string, gcp_credentials, "",
+          "Path of the GCP credentials; empty for the default credentials.");
+ABSL_FLAG(int, channels, 64, "Maximal number of connected clients.");
+ABSL_FLAG(int, slot_size, 8192,
+          "Size of a request or response slot, which bounds the messages.");
+ABSL_FLAG(int, threads, 1, "Number of threads which serve the clients.");
+
+namespace crypto {
+namespace tink {
+namespace sidecar {
+namespace {
+
+util::StatusOr<std::unique_ptr<KeysetHandle>> ReadKeyset(
+    const std::string& path, const Aead* master_key_aead) {
+  auto stream = absl::make_unique<std::ifstream>(path, std::ios::binary);
+  if (!stream->good()) {
+    return util::Status(util::error::NOT_FOUND,
+                        absl::StrCat("Cannot open keyset ", path));
+  }
+  auto reader_result = JsonKeysetReader::New(std::move(stream));
+  if (!reader_result.ok()) return reader_result.status();
+  if (master_key_aead == nullptr) {
+    return CleartextKeysetHandle::Read(std::move(reader_result.ValueOrDie()));
+  }
+  return KeysetHandle::Read(std::move(reader_result.ValueOrDie()),
+                            *master_key_aead);
+}
+
+util::Status Run() {
+  util::Status status = AeadConfig::Register();
+  if (status.ok()) status = MacConfig::Register();
+  if (status.ok()) status = PrfConfig::Register();
+  if (!status.ok()) return status;
+
+  // The keysets are unwrapped once here, rather than in every client.
+  std::unique_ptr<Aead> master_key_aead;
+  const std::string master_key_uri = absl::GetFlag(FLAGS_master_key_uri);
+  if (!master_key_uri.empty()) {
+    if (absl::StartsWith(master_key_uri, "gcp-kms://")) {
+      status = integration::gcpkms::GcpKmsClient::RegisterNewClient(
+          master_key_uri, absl::GetFlag(FLAGS_gcp_credentials));
+      if (!status.ok()) return status;
+    }
+    auto client_result = KmsClients::Get(master_key_uri);
+    if (!client_result.ok()) return client_result.status();
+    auto aead_result = client_result.ValueOrDie()->GetAead(master_key_uri);
+    if (!aead_result.ok()) return aead_result.status();
+    master_key_aead = std::move(aead_result.ValueOrDie());
+  }
+
+  SidecarServer::Options options;
+  options.region.num_channels = absl::GetFlag(FLAGS_channels);
+  options.region.slot_size = absl::GetFlag(FLAGS_slot_size);
+  options.num_threads = absl::GetFlag(FLAGS_threads);
+  auto server_result =
+      SidecarServer::New(absl::GetFlag(FLAGS_region), options);
+  if (!server_result.ok()) return server_result.status();
+  std::unique_ptr<SidecarServer> server = std::move(server_result.ValueOrDie());
+  for (const std::string& entry : absl::GetFlag(FLAGS_keysets)) {
+    std::vector<std::string> name_and_path =
+        absl::StrSplit(entry, absl::MaxSplits(':', 1));
+    if (name_and_path.size() != 2) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          absl::StrCat("Expected name:path, got ", entry));
+    }
+    auto handle_result =
+        ReadKeyset(name_and_path[1], master_key_aead.get());
+    if (!handle_result.ok()) return handle_result.status();
+    status = server->AddKeyset(name_and_path[0], *handle_result.ValueOrDie());
+    if (!status.ok()) return status;
+  }
+
+  // The signals are blocked before the threads of the server start, so
+  // that they inherit the mask and sigwait() below receives the signals.
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+  server->Start();
+  std::cerr << "Serving " << absl::GetFlag(FLAGS_keysets).size()
+            << " keysets at " << absl::GetFlag(FLAGS_region) << std::endl;
+  int signal;
+  sigwait(&signals, &signal);
+  // Destroying the server stops it, and unlinks the region.
+  return util::Status::OK;
+}
+
+}  // namespace
+}  // namespace sidecar
+}  // namespace tink
+}  // namespace crypto
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+  crypto::tink::util::Status status = crypto::tink::sidecar::Run();
+  if (!status.ok()) {
+    std::cerr << status << std::endl;
+    return 1;
+  }
+  return 0;
+}
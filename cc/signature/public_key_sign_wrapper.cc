@@ -16,9 +16,15 @@
 
 #include "tink/signature/public_key_sign_wrapper.h"
 
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
 #include "tink/crypto_format.h"
 #include "tink/primitive_set.h"
 #include "tink/public_key_sign.h"
+#include "tink/space_used.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
@@ -42,7 +48,8 @@ util::Status Validate(PrimitiveSet<PublicKeySign>* public_key_sign_set) {
   return util::Status::OK;
 }
 
-class PublicKeySignSetWrapper : public PublicKeySign {
+class PublicKeySignSetWrapper : public PublicKeySign,
+                                public SpaceUsedInterface {
  public:
   explicit PublicKeySignSetWrapper(
       std::unique_ptr<PrimitiveSet<PublicKeySign>> public_key_sign_set)
@@ -51,6 +58,13 @@ class PublicKeySignSetWrapper : public PublicKeySign {
   crypto::tink::util::StatusOr<std::string> Sign(
       absl::string_view data) const override;
 
+  crypto::tink::util::StatusOr<std::vector<std::string>> SignBatch(
+      absl::Span<const absl::string_view> data) const override;
+
+  size_t SpaceUsed() const override {
+    return sizeof(*this) + public_key_sign_set_->SpaceUsed();
+  }
+
   ~PublicKeySignSetWrapper() override {}
 
  private:
@@ -72,8 +86,41 @@ util::StatusOr<std::string> PublicKeySignSetWrapper::Sign(
   }
   auto sign_result = primary->get_primitive().Sign(data);
   if (!sign_result.ok()) return sign_result.status();
-  const std::string& key_id = primary->get_identifier();
-  return key_id + sign_result.ValueOrDie();
+  absl::string_view key_id = primary->get_identifier();
+  return absl::StrCat(key_id, sign_result.ValueOrDie());
+}
+
+util::StatusOr<std::vector<std::string>> PublicKeySignSetWrapper::SignBatch(
+    absl::Span<const absl::string_view> data) const {
+  auto primary = public_key_sign_set_->get_primary();
+  std::vector<std::string> legacy_data;
+  std::vector<absl::string_view> primary_data;
+  primary_data.reserve(data.size());
+  if (primary->get_output_prefix_type() == OutputPrefixType::LEGACY) {
+    legacy_data.reserve(data.size());
+    for (absl::string_view item : data) {
+      legacy_data.push_back(
+          absl::StrCat(item, std::string(1, CryptoFormat::kLegacyStartByte)));
+    }
+    primary_data.assign(legacy_data.begin(), legacy_data.end());
+  } else {
+    for (absl::string_view item : data) {
+      primary_data.push_back(
+          subtle::SubtleUtilBoringSSL::EnsureNonNull(item));
+    }
+  }
+  // The whole batch goes to the primary in one call, so that it can sign
+  // the items in parallel.
+  auto sign_result = primary->get_primitive().SignBatch(primary_data);
+  if (!sign_result.ok()) return sign_result.status();
+  std::vector<std::string> signatures = std::move(sign_result.ValueOrDie());
+  absl::string_view key_id = primary->get_identifier();
+  if (!key_id.empty()) {
+    for (std::string& signature : signatures) {
+      signature.insert(0, key_id.data(), key_id.size());
+    }
+  }
+  return std::move(signatures);
 }
 
 }  // anonymous namespace
@@ -15,6 +15,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "tink/signature/public_key_sign_wrapper.h"
+
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "absl/memory/memory.h"
 #include "tink/crypto_format.h"
@@ -170,6 +174,35 @@ TEST_F(PublicKeySignSetWrapperTest, testLegacySignatures) {
     EXPECT_TRUE(status.ok()) << status;
 }
 
+TEST_F(PublicKeySignSetWrapperTest, testSignBatch) {
+  for (OutputPrefixType prefix_type :
+       {OutputPrefixType::TINK, OutputPrefixType::LEGACY,
+        OutputPrefixType::RAW}) {
+    KeysetInfo::KeyInfo key;
+    key.set_output_prefix_type(prefix_type);
+    key.set_key_id(1234543);
+    key.set_status(KeyStatusType::ENABLED);
+    std::unique_ptr<PrimitiveSet<PublicKeySign>> pk_sign_set(
+        new PrimitiveSet<PublicKeySign>());
+    auto entry_result = pk_sign_set->AddPrimitive(
+        absl::make_unique<DummyPublicKeySign>("batch"), key);
+    ASSERT_TRUE(entry_result.ok());
+    ASSERT_THAT(pk_sign_set->set_primary(entry_result.ValueOrDie()), IsOk());
+    auto pk_sign =
+        PublicKeySignWrapper().Wrap(std::move(pk_sign_set)).ValueOrDie();
+
+    std::vector<absl::string_view> data = {"first", "", "third"};
+    auto signatures_result = pk_sign->SignBatch(data);
+    ASSERT_THAT(signatures_result.status(), IsOk());
+    const std::vector<std::string>& signatures =
+        signatures_result.ValueOrDie();
+    ASSERT_EQ(signatures.size(), data.size());
+    for (size_t i = 0; i < data.size(); i++) {
+      EXPECT_EQ(signatures[i], pk_sign->Sign(data[i]).ValueOrDie());
+    }
+  }
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
@@ -0,0 +1,139 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/signature/public_key_verify_cache.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/time/clock.h"
+#include "absl/types/span.h"
+#include "openssl/sha.h"
+#include "tink/public_key_verify.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+// Returns the SHA-256 digest of 'signature' and 'data'.  The size of the
+// signature is hashed first, so that no two pairs have the same input.
+std::string VerificationDigest(absl::string_view signature,
+                               absl::string_view data) {
+  uint8_t signature_size[8];
+  uint64_t size = signature.size();
+  for (int i = 7; i >= 0; --i) {
+    signature_size[i] = static_cast<uint8_t>(size);
+    size >>= 8;
+  }
+  SHA256_CTX context;
+  SHA256_Init(&context);
+  SHA256_Update(&context, signature_size, sizeof(signature_size));
+  SHA256_Update(&context, signature.data(), signature.size());
+  SHA256_Update(&context, data.data(), data.size());
+  std::string digest(SHA256_DIGEST_LENGTH, '\0');
+  SHA256_Final(reinterpret_cast<uint8_t*>(&digest[0]), &context);
+  return digest;
+}
+
+class CachingPublicKeyVerify : public PublicKeyVerify {
+ public:
+  CachingPublicKeyVerify(std::unique_ptr<PublicKeyVerify> verify,
+                         const PublicKeyVerifyCache::Options& options)
+      : verify_(std::move(verify)), cache_(options) {}
+
+  crypto::tink::util::Status Verify(absl::string_view signature,
+                                    absl::string_view data) const override {
+    if (cache_.Contains(signature, data)) return util::OkStatus();
+    util::Status status = verify_->Verify(signature, data);
+    if (status.ok()) cache_.Insert(signature, data);
+    return status;
+  }
+
+  crypto::tink::util::StatusOr<std::vector<crypto::tink::util::Status>>
+  VerifyBatch(absl::Span<const absl::string_view> signatures,
+              absl::Span<const absl::string_view> data) const override {
+    if (signatures.size() != data.size()) {
+      return verify_->VerifyBatch(signatures, data);
+    }
+    // Only the items that are not cached are passed on, as one batch.
+    std::vector<util::Status> results(signatures.size(), util::OkStatus());
+    std::vector<size_t> missed;
+    std::vector<absl::string_view> missed_signatures;
+    std::vector<absl::string_view> missed_data;
+    for (size_t i = 0; i < signatures.size(); ++i) {
+      if (cache_.Contains(signatures[i], data[i])) continue;
+      missed.push_back(i);
+      missed_signatures.push_back(signatures[i]);
+      missed_data.push_back(data[i]);
+    }
+    if (missed.empty()) return results;
+    auto missed_results =
+        verify_->VerifyBatch(missed_signatures, missed_data);
+    if (!missed_results.ok()) return missed_results.status();
+    for (size_t j = 0; j < missed.size(); ++j) {
+      util::Status& status = missed_results.ValueOrDie()[j];
+      if (status.ok()) cache_.Insert(missed_signatures[j], missed_data[j]);
+      results[missed[j]] = std::move(status);
+    }
+    return results;
+  }
+
+  crypto::tink::util::StatusOr<std::unique_ptr<
+      OutputStreamWithResult<crypto::tink::util::Status>>>
+  NewVerifyOutputStream(absl::string_view signature) const override {
+    return verify_->NewVerifyOutputStream(signature);
+  }
+
+ private:
+  std::unique_ptr<PublicKeyVerify> verify_;
+  PublicKeyVerifyCache cache_;
+};
+
+}  // namespace
+
+bool PublicKeyVerifyCache::Contains(absl::string_view signature,
+                                    absl::string_view data) const {
+  if (options_.max_entries <= 0) {
+    return false;
+  }
+  return verifications_.Lookup(VerificationDigest(signature, data),
+                               /*value=*/nullptr);
+}
+
+void PublicKeyVerifyCache::Insert(absl::string_view signature,
+                                  absl::string_view data) const {
+  if (options_.max_entries <= 0) {
+    return;
+  }
+  verifications_.Insert(VerificationDigest(signature, data), Verified(),
+                        absl::Now() + options_.ttl);
+}
+
+std::unique_ptr<PublicKeyVerify> NewCachingPublicKeyVerify(
+    std::unique_ptr<PublicKeyVerify> verify,
+    const PublicKeyVerifyCache::Options& options) {
+  return absl::make_unique<CachingPublicKeyVerify>(std::move(verify),
+                                                   options);
+}
+
+}  // namespace tink
+}  // namespace crypto
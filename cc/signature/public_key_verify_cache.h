@@ -0,0 +1,91 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SIGNATURE_PUBLIC_KEY_VERIFY_CACHE_H_
+#define TINK_SIGNATURE_PUBLIC_KEY_VERIFY_CACHE_H_
+
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "tink/internal/digest_lru_cache.h"
+#include "tink/public_key_verify.h"
+
+namespace crypto {
+namespace tink {
+
+// A bounded cache of successful signature verifications, for primitives
+// that verify the same signatures of the same data over and over again
+// (e.g. signed manifests checked on every deployment).  Each entry is the
+// SHA-256 digest of a signature and its data; digests are compared in
+// constant time.  A cached verification thus costs one SHA-256 over the
+// data, instead of the public key operation.
+//
+// Only successful verifications are cached, so that a failure is always
+// the result of the underlying primitive.  A cache belongs to one
+// primitive (typically the one of a keyset, from PublicKeyVerifyWrapper),
+// whose key ids are part of the signatures it verifies; the cache must be
+// dropped when the keyset changes, e.g. when a key is revoked.
+//
+// This class is thread-safe.
+class PublicKeyVerifyCache {
+ public:
+  struct Options {
+    // The maximal number of cached verifications.  The least recently used
+    // one is dropped when a new one is added to a full cache.
+    int max_entries = 1024;
+    // The maximal time a verification is cached.
+    absl::Duration ttl = absl::Minutes(5);
+  };
+
+  explicit PublicKeyVerifyCache(const Options& options)
+      : options_(options), verifications_(options.max_entries) {}
+
+  // Returns true iff the verification of 'signature' for 'data' is cached.
+  bool Contains(absl::string_view signature, absl::string_view data) const;
+
+  // Caches the successful verification of 'signature' for 'data'.
+  void Insert(absl::string_view signature, absl::string_view data) const;
+
+ private:
+  // A verification has no data besides its digest.
+  struct Verified {};
+
+  const Options options_;
+  internal::DigestLruCache<Verified> verifications_;
+};
+
+// Returns a PublicKeyVerify which behaves like 'verify', but keeps the
+// signatures it verified successfully in a PublicKeyVerifyCache with the
+// given 'options'.  Verify() and VerifyBatch() use the cache; the streams
+// of NewVerifyOutputStream() do not.
+//
+// Each returned primitive has a cache of its own, which is never shared
+// with another one.  Since the cache is keyed by signature and data only,
+// 'verify' must be the primitive of a whole keyset, as returned by
+// KeysetHandle::GetPrimitive<PublicKeyVerify>(), and not the primitive of
+// a single key of it.  A cached verification then means that the keyset
+// accepted the signature, whichever key (selected by the key id in its
+// prefix) verified it.  Wrap the primitive of the new keyset again when
+// keys change.
+std::unique_ptr<PublicKeyVerify> NewCachingPublicKeyVerify(
+    std::unique_ptr<PublicKeyVerify> verify,
+    const PublicKeyVerifyCache::Options& options);
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SIGNATURE_PUBLIC_KEY_VERIFY_CACHE_H_
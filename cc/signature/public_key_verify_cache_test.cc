@@ -0,0 +1,197 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/signature/public_key_verify_cache.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "tink/public_key_verify.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::crypto::tink::util::Status;
+using ::crypto::tink::util::StatusOr;
+using ::testing::ElementsAre;
+
+namespace crypto {
+namespace tink {
+namespace {
+
+// Accepts "<prefix><data>" as the signature of <data>, and counts the
+// signatures it verified.
+class CountingPublicKeyVerify : public PublicKeyVerify {
+ public:
+  CountingPublicKeyVerify(int* count, absl::string_view prefix)
+      : count_(count), prefix_(prefix) {}
+
+  Status Verify(absl::string_view signature,
+                absl::string_view data) const override {
+    ++*count_;
+    if (signature != absl::StrCat(prefix_, data)) {
+      return Status(util::error::INVALID_ARGUMENT, "invalid signature");
+    }
+    return util::OkStatus();
+  }
+
+ private:
+  int* count_;
+  std::string prefix_;
+};
+
+std::unique_ptr<PublicKeyVerify> NewCachingVerify(
+    int* count, const PublicKeyVerifyCache::Options& options,
+    absl::string_view prefix = "sig:") {
+  return NewCachingPublicKeyVerify(
+      absl::make_unique<CountingPublicKeyVerify>(count, prefix), options);
+}
+
+TEST(PublicKeyVerifyCacheTest, RepeatedVerificationIsCached) {
+  int count = 0;
+  auto verify = NewCachingVerify(&count, PublicKeyVerifyCache::Options());
+  EXPECT_THAT(verify->Verify("sig:artifact", "artifact"), IsOk());
+  EXPECT_THAT(verify->Verify("sig:artifact", "artifact"), IsOk());
+  EXPECT_THAT(verify->Verify("sig:artifact", "artifact"), IsOk());
+  EXPECT_EQ(count, 1);
+}
+
+TEST(PublicKeyVerifyCacheTest, FailedVerificationIsNotCached) {
+  int count = 0;
+  auto verify = NewCachingVerify(&count, PublicKeyVerifyCache::Options());
+  EXPECT_THAT(verify->Verify("sig:other", "artifact"),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(verify->Verify("sig:other", "artifact"),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_EQ(count, 2);
+}
+
+TEST(PublicKeyVerifyCacheTest, CachedSignatureDoesNotVerifyOtherData) {
+  int count = 0;
+  auto verify = NewCachingVerify(&count, PublicKeyVerifyCache::Options());
+  EXPECT_THAT(verify->Verify("sig:a", "a"), IsOk());
+  // The signature and the data are hashed unambiguously.
+  EXPECT_THAT(verify->Verify("sig:", "aa"),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(verify->Verify("sig:a", "b"),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_EQ(count, 3);
+}
+
+TEST(PublicKeyVerifyCacheTest, LeastRecentlyUsedVerificationIsDropped) {
+  int count = 0;
+  PublicKeyVerifyCache::Options options;
+  options.max_entries = 2;
+  auto verify = NewCachingVerify(&count, options);
+  EXPECT_THAT(verify->Verify("sig:a", "a"), IsOk());
+  EXPECT_THAT(verify->Verify("sig:b", "b"), IsOk());
+  EXPECT_THAT(verify->Verify("sig:a", "a"), IsOk());
+  EXPECT_THAT(verify->Verify("sig:c", "c"), IsOk());
+  EXPECT_EQ(count, 3);
+  // "b" was dropped, "a" was not.
+  EXPECT_THAT(verify->Verify("sig:a", "a"), IsOk());
+  EXPECT_EQ(count, 3);
+  EXPECT_THAT(verify->Verify("sig:b", "b"), IsOk());
+  EXPECT_EQ(count, 4);
+}
+
+TEST(PublicKeyVerifyCacheTest, ExpiredVerificationIsDropped) {
+  int count = 0;
+  PublicKeyVerifyCache::Options options;
+  options.ttl = absl::Milliseconds(10);
+  auto verify = NewCachingVerify(&count, options);
+  EXPECT_THAT(verify->Verify("sig:a", "a"), IsOk());
+  absl::SleepFor(absl::Milliseconds(20));
+  EXPECT_THAT(verify->Verify("sig:a", "a"), IsOk());
+  EXPECT_EQ(count, 2);
+}
+
+TEST(PublicKeyVerifyCacheTest, ZeroEntriesDisablesCache) {
+  int count = 0;
+  PublicKeyVerifyCache::Options options;
+  options.max_entries = 0;
+  auto verify = NewCachingVerify(&count, options);
+  EXPECT_THAT(verify->Verify("sig:a", "a"), IsOk());
+  EXPECT_THAT(verify->Verify("sig:a", "a"), IsOk());
+  EXPECT_EQ(count, 2);
+}
+
+TEST(PublicKeyVerifyCacheTest, PrimitivesDoNotShareEntries) {
+  // Two keysets, the first of which accepts "sig:<data>" and the second
+  // "other:<data>".
+  int count_1 = 0;
+  int count_2 = 0;
+  auto verify_1 = NewCachingVerify(&count_1, PublicKeyVerifyCache::Options());
+  auto verify_2 = NewCachingVerify(&count_2, PublicKeyVerifyCache::Options(),
+                                   "other:");
+  EXPECT_THAT(verify_1->Verify("sig:a", "a"), IsOk());
+  EXPECT_THAT(verify_2->Verify("other:a", "a"), IsOk());
+  // A verification cached by one keyset is not one of the other.
+  EXPECT_THAT(verify_2->Verify("sig:a", "a"),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(verify_1->Verify("other:a", "a"),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_EQ(count_1, 2);
+  EXPECT_EQ(count_2, 2);
+  // Each keyset still hits its own entry.
+  EXPECT_THAT(verify_1->Verify("sig:a", "a"), IsOk());
+  EXPECT_THAT(verify_2->Verify("other:a", "a"), IsOk());
+  EXPECT_EQ(count_1, 2);
+  EXPECT_EQ(count_2, 2);
+}
+
+TEST(PublicKeyVerifyCacheTest, VerifyBatchVerifiesOnlyMisses) {
+  int count = 0;
+  auto verify = NewCachingVerify(&count, PublicKeyVerifyCache::Options());
+  EXPECT_THAT(verify->Verify("sig:a", "a"), IsOk());
+  std::vector<absl::string_view> signatures = {"sig:a", "sig:b", "bad"};
+  std::vector<absl::string_view> data = {"a", "b", "c"};
+  StatusOr<std::vector<Status>> results =
+      verify->VerifyBatch(signatures, data);
+  ASSERT_THAT(results.status(), IsOk());
+  EXPECT_THAT(results.ValueOrDie(),
+              ElementsAre(IsOk(), IsOk(),
+                          StatusIs(util::error::INVALID_ARGUMENT)));
+  EXPECT_EQ(count, 3);
+  results = verify->VerifyBatch(signatures, data);
+  ASSERT_THAT(results.status(), IsOk());
+  EXPECT_THAT(results.ValueOrDie(),
+              ElementsAre(IsOk(), IsOk(),
+                          StatusIs(util::error::INVALID_ARGUMENT)));
+  EXPECT_EQ(count, 4);
+}
+
+TEST(PublicKeyVerifyCacheTest, VerifyBatchRejectsMismatchedSizes) {
+  int count = 0;
+  auto verify = NewCachingVerify(&count, PublicKeyVerifyCache::Options());
+  std::vector<absl::string_view> signatures = {"sig:a", "sig:b"};
+  std::vector<absl::string_view> data = {"a"};
+  EXPECT_THAT(verify->VerifyBatch(signatures, data).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -16,8 +16,14 @@
 
 #include "tink/signature/public_key_verify_wrapper.h"
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
 #include "tink/crypto_format.h"
+#include "tink/internal/monitored_operation.h"
 #include "tink/primitive_set.h"
 #include "tink/public_key_verify.h"
 #include "tink/subtle/subtle_util_boringssl.h"
@@ -53,9 +59,22 @@ class PublicKeyVerifySetWrapper : public PublicKeyVerify {
   crypto::tink::util::Status Verify(absl::string_view signature,
                                     absl::string_view data) const override;
 
+  crypto::tink::util::StatusOr<std::vector<crypto::tink::util::Status>>
+  VerifyBatch(absl::Span<const absl::string_view> signatures,
+              absl::Span<const absl::string_view> data) const override;
+
   ~PublicKeyVerifySetWrapper() override {}
 
  private:
+  // Verifies the items listed in 'indices' with 'public_key_verify', taking
+  // 'prefix_size' bytes off every signature, and sets (*results)[i] to OK
+  // for every item i that verifies.
+  static util::Status VerifyPending(
+      const PublicKeyVerify& public_key_verify, bool legacy,
+      size_t prefix_size, absl::Span<const absl::string_view> signatures,
+      absl::Span<const absl::string_view> data,
+      const std::vector<size_t>& indices, std::vector<util::Status>* results);
+
   std::unique_ptr<PrimitiveSet<PublicKeyVerify>> public_key_verify_set_;
 };
 
@@ -67,6 +86,7 @@ util::Status PublicKeyVerifySetWrapper::Verify(
   data = subtle::SubtleUtilBoringSSL::EnsureNonNull(data);
   signature = subtle::SubtleUtilBoringSSL::EnsureNonNull(signature);
 
+  internal::MonitoredOperation operation("public_key_verify", "verify");
   if (signature.length() <= CryptoFormat::kNonRawPrefixSize) {
     // This also rejects raw signatures with size of 4 bytes or fewer.
     // We're not aware of any schemes that output signatures that small.
@@ -86,9 +106,11 @@ util::Status PublicKeyVerifySetWrapper::Verify(
         view_on_data_or_legacy_data = legacy_data;
       }
       auto& public_key_verify = entry->get_primitive();
+      operation.KeyTried();
       auto verify_result =
           public_key_verify.Verify(raw_signature, view_on_data_or_legacy_data);
       if (verify_result.ok()) {
+        operation.Succeeded(entry->get_key_id());
         return util::Status::OK;
       } else {
         // LOG that a matching key didn't verify the signature.
@@ -99,11 +121,14 @@ util::Status PublicKeyVerifySetWrapper::Verify(
   // No matching key succeeded with verification, try all RAW keys.
   auto raw_primitives_result = public_key_verify_set_->get_raw_primitives();
   if (raw_primitives_result.ok()) {
+    operation.RawKeysTried();
     for (auto& public_key_verify_entry :
              *(raw_primitives_result.ValueOrDie())) {
       auto& public_key_verify = public_key_verify_entry->get_primitive();
+      operation.KeyTried();
       auto verify_result = public_key_verify.Verify(signature, data);
       if (verify_result.ok()) {
+        operation.Succeeded(public_key_verify_entry->get_key_id());
         return util::Status::OK;
       }
     }
@@ -111,6 +136,102 @@ util::Status PublicKeyVerifySetWrapper::Verify(
   return util::Status(util::error::INVALID_ARGUMENT, "Invalid signature.");
 }
 
+// static
+util::Status PublicKeyVerifySetWrapper::VerifyPending(
+    const PublicKeyVerify& public_key_verify, bool legacy, size_t prefix_size,
+    absl::Span<const absl::string_view> signatures,
+    absl::Span<const absl::string_view> data,
+    const std::vector<size_t>& indices, std::vector<util::Status>* results) {
+  std::vector<size_t> pending;
+  std::vector<absl::string_view> pending_signatures;
+  std::vector<std::string> legacy_data;
+  std::vector<absl::string_view> pending_data;
+  for (size_t i : indices) {
+    if ((*results)[i].ok()) continue;
+    pending.push_back(i);
+    pending_signatures.push_back(signatures[i].substr(prefix_size));
+  }
+  if (pending.empty()) return util::Status::OK;
+  if (legacy) {
+    legacy_data.reserve(pending.size());
+    for (size_t i : pending) {
+      legacy_data.push_back(absl::StrCat(data[i], std::string("\x00", 1)));
+    }
+    pending_data.assign(legacy_data.begin(), legacy_data.end());
+  } else {
+    for (size_t i : pending) {
+      pending_data.push_back(
+          subtle::SubtleUtilBoringSSL::EnsureNonNull(data[i]));
+    }
+  }
+  auto verify_results =
+      public_key_verify.VerifyBatch(pending_signatures, pending_data);
+  if (!verify_results.ok()) return verify_results.status();
+  for (size_t j = 0; j < pending.size(); j++) {
+    if (verify_results.ValueOrDie()[j].ok()) {
+      (*results)[pending[j]] = util::Status::OK;
+    }
+  }
+  return util::Status::OK;
+}
+
+util::StatusOr<std::vector<util::Status>>
+PublicKeyVerifySetWrapper::VerifyBatch(
+    absl::Span<const absl::string_view> signatures,
+    absl::Span<const absl::string_view> data) const {
+  if (signatures.size() != data.size()) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("Batch has ", signatures.size(), " signatures but ",
+                     data.size(), " data entries"));
+  }
+  // Items are grouped by key id, so that every key sees all of its
+  // signatures in a single VerifyBatch() call.  Items which no key verifies
+  // keep the same error Verify() would return.
+  std::vector<util::Status> results(
+      signatures.size(),
+      util::Status(util::error::INVALID_ARGUMENT, "Invalid signature."));
+  std::map<absl::string_view, std::vector<size_t>> indices_by_key_id;
+  std::vector<size_t> well_formed;
+  for (size_t i = 0; i < signatures.size(); i++) {
+    if (signatures[i].length() <= CryptoFormat::kNonRawPrefixSize) {
+      results[i] =
+          util::Status(util::error::INVALID_ARGUMENT, "Signature too short.");
+      continue;
+    }
+    indices_by_key_id[signatures[i].substr(0, CryptoFormat::kNonRawPrefixSize)]
+        .push_back(i);
+    well_formed.push_back(i);
+  }
+
+  for (const auto& key_id_and_indices : indices_by_key_id) {
+    auto primitives_result =
+        public_key_verify_set_->get_primitives(key_id_and_indices.first);
+    if (!primitives_result.ok()) continue;
+    for (auto& entry : *(primitives_result.ValueOrDie())) {
+      auto status = VerifyPending(
+          entry->get_primitive(),
+          entry->get_output_prefix_type() == OutputPrefixType::LEGACY,
+          CryptoFormat::kNonRawPrefixSize, signatures, data,
+          key_id_and_indices.second, &results);
+      if (!status.ok()) return status;
+    }
+  }
+
+  // Try all RAW keys on the items that no matching key verified.
+  auto raw_primitives_result = public_key_verify_set_->get_raw_primitives();
+  if (raw_primitives_result.ok()) {
+    for (auto& entry : *(raw_primitives_result.ValueOrDie())) {
+      auto status =
+          VerifyPending(entry->get_primitive(), /*legacy=*/false,
+                        /*prefix_size=*/0, signatures, data, well_formed,
+                        &results);
+      if (!status.ok()) return status;
+    }
+  }
+  return std::move(results);
+}
+
 }  // anonymous namespace
 
 util::StatusOr<std::unique_ptr<PublicKeyVerify>> PublicKeyVerifyWrapper::Wrap(
@@ -118,6 +239,7 @@ util::StatusOr<std::unique_ptr<PublicKeyVerify>> PublicKeyVerifyWrapper::Wrap(
     const {
   util::Status status = Validate(public_key_verify_set.get());
   if (!status.ok()) return status;
+  public_key_verify_set->Freeze();
   std::unique_ptr<PublicKeyVerify> public_key_verify(
       new PublicKeyVerifySetWrapper(std::move(public_key_verify_set)));
   return std::move(public_key_verify);
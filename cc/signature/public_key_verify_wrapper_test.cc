@@ -16,7 +16,14 @@
 
 #include "tink/signature/public_key_verify_wrapper.h"
 
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/crypto_format.h"
 #include "tink/primitive_set.h"
 #include "tink/public_key_verify.h"
 #include "tink/util/status.h"
@@ -26,9 +33,13 @@
 using ::crypto::tink::test::DummyPublicKeySign;
 using ::crypto::tink::test::DummyPublicKeyVerify;
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
 using ::google::crypto::tink::KeysetInfo;
 using ::google::crypto::tink::KeyStatusType;
 using ::google::crypto::tink::OutputPrefixType;
+using ::testing::HasSubstr;
+using ::testing::Not;
+using ::testing::SizeIs;
 
 namespace crypto {
 namespace tink {
@@ -124,6 +135,70 @@ TEST_F(PublicKeyVerifySetWrapperTest, testBasic) {
   }
 }
 
+TEST_F(PublicKeyVerifySetWrapperTest, testVerifyBatch) {
+  KeysetInfo keyset_info;
+  std::vector<OutputPrefixType> prefix_types = {
+      OutputPrefixType::RAW, OutputPrefixType::LEGACY, OutputPrefixType::TINK};
+  std::unique_ptr<PrimitiveSet<PublicKeyVerify>> pk_verify_set(
+      new PrimitiveSet<PublicKeyVerify>());
+  for (int i = 0; i < prefix_types.size(); i++) {
+    KeysetInfo::KeyInfo* key_info = keyset_info.add_key_info();
+    key_info->set_output_prefix_type(prefix_types[i]);
+    key_info->set_key_id(1000 + i);
+    key_info->set_status(KeyStatusType::ENABLED);
+    auto entry_result = pk_verify_set->AddPrimitive(
+        absl::make_unique<DummyPublicKeyVerify>(absl::StrCat("signature_", i)),
+        *key_info);
+    ASSERT_THAT(entry_result.status(), IsOk());
+    ASSERT_THAT(pk_verify_set->set_primary(entry_result.ValueOrDie()), IsOk());
+  }
+  auto pk_verify_result =
+      PublicKeyVerifyWrapper().Wrap(std::move(pk_verify_set));
+  ASSERT_THAT(pk_verify_result.status(), IsOk());
+  const PublicKeyVerify& pk_verify = *pk_verify_result.ValueOrDie();
+
+  std::string data = "some data to sign";
+  std::string raw_signature =
+      DummyPublicKeySign("signature_0").Sign(data).ValueOrDie();
+  std::string legacy_signature = absl::StrCat(
+      CryptoFormat::GetOutputPrefix(keyset_info.key_info(1)).ValueOrDie(),
+      DummyPublicKeySign("signature_1")
+          .Sign(absl::StrCat(data, std::string("\x00", 1)))
+          .ValueOrDie());
+  std::string tink_prefix =
+      CryptoFormat::GetOutputPrefix(keyset_info.key_info(2)).ValueOrDie();
+  std::string tink_signature = absl::StrCat(
+      tink_prefix, DummyPublicKeySign("signature_2").Sign(data).ValueOrDie());
+  std::string wrong_key_signature = absl::StrCat(
+      tink_prefix, DummyPublicKeySign("signature_1").Sign(data).ValueOrDie());
+
+  std::vector<absl::string_view> signatures = {
+      tink_signature, raw_signature, legacy_signature, wrong_key_signature,
+      "abc",          tink_signature};
+  std::vector<absl::string_view> batch_data = {data, data, data,
+                                               data, data, "other data"};
+  auto results_or = pk_verify.VerifyBatch(signatures, batch_data);
+  ASSERT_THAT(results_or.status(), IsOk());
+  const std::vector<util::Status>& results = results_or.ValueOrDie();
+  ASSERT_THAT(results, SizeIs(signatures.size()));
+  EXPECT_THAT(results[0], IsOk());
+  EXPECT_THAT(results[1], IsOk());
+  EXPECT_THAT(results[2], IsOk());
+  EXPECT_THAT(results[3], StatusIs(util::error::INVALID_ARGUMENT,
+                                   HasSubstr("Invalid signature")));
+  EXPECT_THAT(results[4], StatusIs(util::error::INVALID_ARGUMENT,
+                                   HasSubstr("too short")));
+  EXPECT_THAT(results[5], Not(IsOk()));
+  // Every item gets the same result as a single Verify() call.
+  for (int i = 0; i < signatures.size(); i++) {
+    EXPECT_EQ(results[i].ok(),
+              pk_verify.Verify(signatures[i], batch_data[i]).ok());
+  }
+
+  EXPECT_THAT(pk_verify.VerifyBatch(signatures, {data}).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
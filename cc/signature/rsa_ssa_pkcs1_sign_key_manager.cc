@@ -16,12 +16,16 @@
 
 #include "tink/signature/rsa_ssa_pkcs1_sign_key_manager.h"
 
+#include <memory>
+
 #include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
 #include "tink/public_key_sign.h"
 #include "tink/public_key_verify.h"
 #include "tink/signature/rsa_ssa_pkcs1_verify_key_manager.h"
 #include "tink/signature/sig_util.h"
+#include "tink/subtle/offload_engine.h"
+#include "tink/subtle/offload_rsa_ssa_pkcs1_sign.h"
 #include "tink/subtle/rsa_ssa_pkcs1_sign_boringssl.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/enums.h"
@@ -104,7 +108,16 @@ RsaSsaPkcs1SignKeyManager::PublicKeySignFactory::Create(
   subtle::SubtleUtilBoringSSL::RsaSsaPkcs1Params params;
   const RsaSsaPkcs1Params& params_proto = private_key.public_key().params();
   params.hash_type = Enums::ProtoToSubtle(params_proto.hash_type());
-  auto signer = subtle::RsaSsaPkcs1SignBoringSsl::New(key, params);
+  std::shared_ptr<subtle::OffloadEngine> engine = subtle::GetOffloadEngine();
+  StatusOr<std::unique_ptr<PublicKeySign>> signer =
+      util::Status(util::error::UNIMPLEMENTED, "No offload engine");
+  if (engine != nullptr && subtle::GetOffloadPolicy().rsa_ssa_pkcs1_sign) {
+    signer = subtle::OffloadRsaSsaPkcs1Sign::New(key, params, engine);
+  }
+  // Keys the engine does not support stay in software.
+  if (!signer.ok()) {
+    signer = subtle::RsaSsaPkcs1SignBoringSsl::New(key, params);
+  }
   if (!signer.ok()) return signer.status();
   // To check that the key is correct, we sign a test message with private key
   // and verify with public key.
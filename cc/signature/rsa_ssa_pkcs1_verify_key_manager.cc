@@ -50,7 +50,7 @@ RsaSsaPkcs1VerifyKeyManager::PublicKeyVerifyFactory::Create(
   params.hash_type = Enums::ProtoToSubtle(rsa_ssa_pkcs1_params.hash_type());
 
   auto rsa_ssa_pkcs1_result =
-      subtle::RsaSsaPkcs1VerifyBoringSsl::New(rsa_pub_key, params);
+      subtle::RsaSsaPkcs1VerifyBoringSsl::New(rsa_pub_key, params, options_);
   if (!rsa_ssa_pkcs1_result.ok()) return rsa_ssa_pkcs1_result.status();
   return {std::move(rsa_ssa_pkcs1_result.ValueOrDie())};
 }
@@ -24,6 +24,7 @@
 #include "absl/strings/str_cat.h"
 #include "tink/core/key_type_manager.h"
 #include "tink/public_key_verify.h"
+#include "tink/subtle/rsa_public_key_context.h"
 #include "tink/util/constants.h"
 #include "tink/util/errors.h"
 #include "tink/util/protobuf_helper.h"
@@ -39,13 +40,26 @@ class RsaSsaPkcs1VerifyKeyManager
                             List<PublicKeyVerify>> {
  public:
   class PublicKeyVerifyFactory : public PrimitiveFactory<PublicKeyVerify> {
+   public:
+    explicit PublicKeyVerifyFactory(const subtle::RsaVerifyOptions& options)
+        : options_(options) {}
+
+   private:
     crypto::tink::util::StatusOr<std::unique_ptr<PublicKeyVerify>> Create(
         const google::crypto::tink::RsaSsaPkcs1PublicKey&
             rsa_ssa_pkcs1_public_key) const override;
+
+    const subtle::RsaVerifyOptions options_;
   };
 
   RsaSsaPkcs1VerifyKeyManager()
-      : KeyTypeManager(absl::make_unique<PublicKeyVerifyFactory>()) {}
+      : RsaSsaPkcs1VerifyKeyManager(subtle::RsaVerifyOptions()) {}
+
+  // Creates a key manager whose primitives are created with 'options', e.g.
+  // to verify with precomputed Montgomery contexts, or to verify batches on
+  // an executor.
+  explicit RsaSsaPkcs1VerifyKeyManager(const subtle::RsaVerifyOptions& options)
+      : KeyTypeManager(absl::make_unique<PublicKeyVerifyFactory>(options)) {}
 
   uint32_t get_version() const override { return 0; }
 
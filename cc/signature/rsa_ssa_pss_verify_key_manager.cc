@@ -53,7 +53,7 @@ RsaSsaPssVerifyKeyManager::PublicKeyVerifyFactory::Create(
   params.salt_length = rsa_ssa_pss_params.salt_length();
 
   auto rsa_ssa_pss_result =
-      subtle::RsaSsaPssVerifyBoringSsl::New(rsa_pub_key, params);
+      subtle::RsaSsaPssVerifyBoringSsl::New(rsa_pub_key, params, options_);
   if (!rsa_ssa_pss_result.ok()) return rsa_ssa_pss_result.status();
   return {std::move(rsa_ssa_pss_result).ValueOrDie()};
 }
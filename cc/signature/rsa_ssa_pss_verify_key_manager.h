@@ -23,6 +23,7 @@
 #include "tink/core/private_key_type_manager.h"
 #include "tink/public_key_sign.h"
 #include "tink/public_key_verify.h"
+#include "tink/subtle/rsa_public_key_context.h"
 #include "tink/util/constants.h"
 #include "tink/util/errors.h"
 #include "tink/util/protobuf_helper.h"
@@ -39,13 +40,26 @@ class RsaSsaPssVerifyKeyManager
                             List<PublicKeyVerify>> {
  public:
   class PublicKeyVerifyFactory : public PrimitiveFactory<PublicKeyVerify> {
+   public:
+    explicit PublicKeyVerifyFactory(const subtle::RsaVerifyOptions& options)
+        : options_(options) {}
+
+   private:
     crypto::tink::util::StatusOr<std::unique_ptr<PublicKeyVerify>> Create(
         const google::crypto::tink::RsaSsaPssPublicKey& rsa_ssa_pss_public_key)
         const override;
+
+    const subtle::RsaVerifyOptions options_;
   };
 
   RsaSsaPssVerifyKeyManager()
-      : KeyTypeManager(absl::make_unique<PublicKeyVerifyFactory>()) {}
+      : RsaSsaPssVerifyKeyManager(subtle::RsaVerifyOptions()) {}
+
+  // Creates a key manager whose primitives are created with 'options', e.g.
+  // to verify with precomputed Montgomery contexts, or to verify batches on
+  // an executor.
+  explicit RsaSsaPssVerifyKeyManager(const subtle::RsaVerifyOptions& options)
+      : KeyTypeManager(absl::make_unique<PublicKeyVerifyFactory>(options)) {}
 
   uint32_t get_version() const override { return 0; }
 
@@ -16,13 +16,18 @@
 
 #include "tink/signature/rsa_ssa_pss_verify_key_manager.h"
 
+#include <string>
+#include <vector>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/strings/escaping.h"
 #include "openssl/rsa.h"
 #include "tink/public_key_sign.h"
 #include "tink/public_key_verify.h"
+#include "tink/thread_pool_executor.h"
 #include "tink/signature/rsa_ssa_pss_sign_key_manager.h"
+#include "tink/subtle/rsa_public_key_context.h"
 #include "tink/subtle/rsa_ssa_pss_sign_boringssl.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/secret_data.h"
@@ -177,6 +182,47 @@ TEST(RsaSsaPssSignKeyManagerTest, Create) {
       IsOk());
 }
 
+TEST(RsaSsaPssVerifyKeyManagerTest, CreateWithOptions) {
+  StatusOr<RsaSsaPssPrivateKey> private_key_or =
+      RsaSsaPssSignKeyManager().CreateKey(CreateKeyFormat(
+          HashType::SHA256, HashType::SHA256, 32, 3072, RSA_F4));
+  ASSERT_THAT(private_key_or.status(), IsOk());
+  RsaSsaPssPrivateKey private_key = private_key_or.ValueOrDie();
+  RsaSsaPssPublicKey public_key =
+      RsaSsaPssSignKeyManager().GetPublicKey(private_key).ValueOrDie();
+  auto signer = RsaSsaPssSignKeyManager()
+                    .GetPrimitive<PublicKeySign>(private_key)
+                    .ValueOrDie();
+
+  subtle::RsaVerifyOptions options;
+  options.precompute_montgomery = true;
+  options.executor = NewThreadPoolExecutor(2);
+  auto verifier_or = RsaSsaPssVerifyKeyManager(options)
+                         .GetPrimitive<PublicKeyVerify>(public_key);
+  ASSERT_THAT(verifier_or.status(), IsOk());
+
+  std::vector<std::string> messages = {"a", "b", "c", "d"};
+  std::vector<std::string> signatures;
+  for (const std::string& message : messages) {
+    signatures.push_back(signer->Sign(message).ValueOrDie());
+  }
+  // The last signature is for another message.
+  signatures.back() = signatures.front();
+  std::vector<absl::string_view> signature_views(signatures.begin(),
+                                                 signatures.end());
+  std::vector<absl::string_view> message_views(messages.begin(),
+                                               messages.end());
+  auto results_or =
+      verifier_or.ValueOrDie()->VerifyBatch(signature_views, message_views);
+  ASSERT_THAT(results_or.status(), IsOk());
+  const std::vector<util::Status>& results = results_or.ValueOrDie();
+  ASSERT_EQ(results.size(), 4);
+  EXPECT_THAT(results[0], IsOk());
+  EXPECT_THAT(results[1], IsOk());
+  EXPECT_THAT(results[2], IsOk());
+  EXPECT_THAT(results[3], StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 // Test vector from
 // https://csrc.nist.gov/Projects/Cryptographic-Algorithm-Validation-Program/Digital-Signatures
 struct NistTestVector {
@@ -16,19 +16,28 @@
 
 #include "tink/signature/signature_pem_keyset_reader.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <random>
+#include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "tink/internal/thread_pool.h"
 #include "tink/keyset_reader.h"
+#include "tink/public_key_verify.h"
 #include "tink/signature/rsa_ssa_pkcs1_sign_key_manager.h"
 #include "tink/signature/rsa_ssa_pkcs1_verify_key_manager.h"
 #include "tink/signature/rsa_ssa_pss_sign_key_manager.h"
 #include "tink/signature/rsa_ssa_pss_verify_key_manager.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/ecdsa_verify_boringssl.h"
 #include "tink/subtle/pem_parser_boringssl.h"
+#include "tink/subtle/rsa_ssa_pkcs1_verify_boringssl.h"
+#include "tink/subtle/rsa_ssa_pss_verify_boringssl.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/enums.h"
 #include "tink/util/keyset_util.h"
@@ -305,8 +314,123 @@ util::Status AddRsaSsaPublicKey(const PemKey& pem_key, Keyset* keyset) {
   return util::OkStatus();
 }
 
+// Parses the PEM-encoded RSA public key `pem_key` and creates a verifier
+// for it, without going through the key protos.
+util::StatusOr<std::unique_ptr<PublicKeyVerify>> NewRsaSsaVerifierFromPem(
+    const PemKey& pem_key) {
+  auto rsa_or =
+      subtle::PemParser::ParseRsaPublicKeyToBoringSsl(pem_key.serialized_key);
+  if (!rsa_or.ok()) return rsa_or.status();
+  bssl::UniquePtr<RSA> rsa = std::move(rsa_or).ValueOrDie();
+
+  // Check key length is as expected.
+  size_t modulus_size = RSA_bits(rsa.get());
+  if (pem_key.parameters.key_size_in_bits != modulus_size) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("Invalid RSA Key modulus size; found ", modulus_size,
+                     ", expected ", pem_key.parameters.key_size_in_bits));
+  }
+
+  subtle::HashType hash_type =
+      util::Enums::ProtoToSubtle(pem_key.parameters.hash_type);
+  switch (pem_key.parameters.algorithm) {
+    case PemAlgorithm::RSASSA_PSS: {
+      // Same parameters as set by SetRsaSsaPssParameters().
+      auto salt_len_or = util::Enums::HashLength(pem_key.parameters.hash_type);
+      if (!salt_len_or.ok()) return salt_len_or.status();
+      subtle::SubtleUtilBoringSSL::RsaSsaPssParams params;
+      params.sig_hash = hash_type;
+      params.mgf1_hash = hash_type;
+      params.salt_length = salt_len_or.ValueOrDie();
+      auto verifier_or =
+          subtle::RsaSsaPssVerifyBoringSsl::New(std::move(rsa), params);
+      if (!verifier_or.ok()) return verifier_or.status();
+      return {std::move(verifier_or).ValueOrDie()};
+    }
+    case PemAlgorithm::RSASSA_PKCS1: {
+      subtle::SubtleUtilBoringSSL::RsaSsaPkcs1Params params;
+      params.hash_type = hash_type;
+      auto verifier_or =
+          subtle::RsaSsaPkcs1VerifyBoringSsl::New(std::move(rsa), params);
+      if (!verifier_or.ok()) return verifier_or.status();
+      return {std::move(verifier_or).ValueOrDie()};
+    }
+    default:
+      return util::Status(
+          util::error::INVALID_ARGUMENT,
+          absl::StrCat("Invalid RSA algorithm ", pem_key.parameters.algorithm));
+  }
+}
+
+// Parses the PEM-encoded EC public key `pem_key` and creates an ECDSA
+// verifier for it, which expects DER-encoded signatures.
+util::StatusOr<std::unique_ptr<PublicKeyVerify>> NewEcdsaVerifierFromPem(
+    const PemKey& pem_key) {
+  if (pem_key.parameters.algorithm != PemAlgorithm::ECDSA) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("Invalid EC algorithm ", pem_key.parameters.algorithm));
+  }
+  auto ec_key_or =
+      subtle::PemParser::ParseEcPublicKeyToBoringSsl(pem_key.serialized_key);
+  if (!ec_key_or.ok()) return ec_key_or.status();
+  bssl::UniquePtr<EC_KEY> ec_key = std::move(ec_key_or).ValueOrDie();
+
+  // Check key length is as expected.
+  size_t field_size = EC_GROUP_get_degree(EC_KEY_get0_group(ec_key.get()));
+  if (pem_key.parameters.key_size_in_bits != field_size) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("Invalid EC Key size; found ", field_size, ", expected ",
+                     pem_key.parameters.key_size_in_bits));
+  }
+
+  auto verifier_or = subtle::EcdsaVerifyBoringSsl::New(
+      std::move(ec_key),
+      util::Enums::ProtoToSubtle(pem_key.parameters.hash_type),
+      subtle::EcdsaSignatureEncoding::DER);
+  if (!verifier_or.ok()) return verifier_or.status();
+  return {std::move(verifier_or).ValueOrDie()};
+}
+
 }  // namespace
 
+util::StatusOr<std::vector<std::unique_ptr<PublicKeyVerify>>>
+NewPublicKeyVerifiersFromPem(const std::vector<PemKey>& pem_keys,
+                             int parallelism) {
+  std::vector<util::StatusOr<std::unique_ptr<PublicKeyVerify>>> results(
+      pem_keys.size());
+  auto parse = [&pem_keys, &results](int i) {
+    switch (pem_keys[i].parameters.key_type) {
+      case PemKeyType::PEM_RSA:
+        results[i] = NewRsaSsaVerifierFromPem(pem_keys[i]);
+        break;
+      case PemKeyType::PEM_EC:
+        results[i] = NewEcdsaVerifierFromPem(pem_keys[i]);
+        break;
+      default:
+        results[i] = util::Status(util::error::INVALID_ARGUMENT,
+                                  "Unknown PEM key type");
+    }
+  };
+  int num_threads =
+      std::max(1, std::min(parallelism, static_cast<int>(pem_keys.size())));
+  if (num_threads == 1) {
+    for (int i = 0; i < pem_keys.size(); i++) parse(i);
+  } else {
+    internal::ThreadPool(num_threads - 1).ParallelFor(pem_keys.size(), parse);
+  }
+
+  std::vector<std::unique_ptr<PublicKeyVerify>> verifiers;
+  verifiers.reserve(results.size());
+  for (auto& result : results) {
+    if (!result.ok()) return result.status();
+    verifiers.push_back(std::move(result).ValueOrDie());
+  }
+  return std::move(verifiers);
+}
+
 void SignaturePemKeysetReaderBuilder::Add(const PemKey& pem_serialized_key) {
   pem_serialized_keys_.push_back(pem_serialized_key);
 }
@@ -17,10 +17,12 @@
 #ifndef TINK_SIGNATURE_SIGNATURE_PEM_KEYSET_READER_H_
 #define TINK_SIGNATURE_SIGNATURE_PEM_KEYSET_READER_H_
 
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "tink/keyset_reader.h"
+#include "tink/public_key_verify.h"
 #include "tink/util/statusor.h"
 #include "proto/common.pb.h"
 #include "proto/tink.pb.h"
@@ -28,8 +30,9 @@
 namespace crypto {
 namespace tink {
 
-// Type of key. Currently, only RSA keys are supported.
-// TODO(ambrosin): Add EC keys persing.
+// Type of key. The keyset readers support only RSA keys;
+// NewPublicKeyVerifiersFromPem() also supports EC public keys.
+// TODO(ambrosin): Add EC keys parsing to the keyset readers.
 enum PemKeyType { PEM_RSA, PEM_EC };
 
 // Algorithm to use with this key.
@@ -141,6 +144,19 @@ class PublicKeyVerifyPemKeysetReader : public SignaturePemKeysetReader {
       : SignaturePemKeysetReader(pem_serialized_keys) {}
 };
 
+// Parses the PEM-encoded public keys `pem_keys` and returns one verifier per
+// key, in the order of `pem_keys`, or the first error encountered.
+//
+// Unlike PublicKeyVerifyPemKeysetReader, which converts the keys into a
+// keyset whose primitives then decode the key protos again, this hands the
+// parsed BoringSSL keys directly to the subtle verifiers. It is meant for
+// services which load many PEM keys, e.g. certificate verification; the
+// keys are parsed on `parallelism` threads, including the calling thread.
+// The verifiers do not add or check an output prefix, as with RAW keys.
+util::StatusOr<std::vector<std::unique_ptr<PublicKeyVerify>>>
+NewPublicKeyVerifiersFromPem(const std::vector<PemKey>& pem_keys,
+                             int parallelism = 1);
+
 }  // namespace tink
 }  // namespace crypto
 
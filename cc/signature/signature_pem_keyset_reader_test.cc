@@ -28,7 +28,9 @@
 #include "tink/signature/rsa_ssa_pss_sign_key_manager.h"
 #include "tink/signature/rsa_ssa_pss_verify_key_manager.h"
 #include "tink/signature/signature_config.h"
+#include "tink/subtle/common_enums.h"
 #include "tink/subtle/pem_parser_boringssl.h"
+#include "tink/subtle/rsa_ssa_pss_sign_boringssl.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/enums.h"
 #include "tink/util/secret_data.h"
@@ -425,6 +427,67 @@ TEST(SignaturePemKeysetTeaderTest, ReadRsaPublicKeyInvalidHashType) {
   EXPECT_THAT(keyset_reader->Read().status(), StatusIs(Code::INVALID_ARGUMENT));
 }
 
+TEST(NewPublicKeyVerifiersFromPemTest, VerifiesSignatures) {
+  PemKey pss_key = {.serialized_key = std::string(kRsaPublicKey2048),
+                    .parameters = {.key_type = PemKeyType::PEM_RSA,
+                                   .algorithm = PemAlgorithm::RSASSA_PSS,
+                                   .key_size_in_bits = 2048,
+                                   .hash_type = HashType::SHA256}};
+  PemKey pkcs1_key = pss_key;
+  pkcs1_key.parameters.algorithm = PemAlgorithm::RSASSA_PKCS1;
+  std::vector<PemKey> pem_keys = {pss_key, pkcs1_key, pss_key};
+
+  auto private_key_or =
+      subtle::PemParser::ParseRsaPrivateKey(kRsaPrivateKey2048);
+  ASSERT_THAT(private_key_or.status(), IsOk());
+  subtle::SubtleUtilBoringSSL::RsaSsaPssParams params;
+  params.sig_hash = subtle::HashType::SHA256;
+  params.mgf1_hash = subtle::HashType::SHA256;
+  params.salt_length = 32;
+  auto signer_or =
+      subtle::RsaSsaPssSignBoringSsl::New(*private_key_or.ValueOrDie(), params);
+  ASSERT_THAT(signer_or.status(), IsOk());
+  std::string signature =
+      signer_or.ValueOrDie()->Sign("some data").ValueOrDie();
+
+  for (int parallelism : {1, 2}) {
+    auto verifiers_or = NewPublicKeyVerifiersFromPem(pem_keys, parallelism);
+    ASSERT_THAT(verifiers_or.status(), IsOk());
+    const auto& verifiers = verifiers_or.ValueOrDie();
+    ASSERT_THAT(verifiers, SizeIs(3));
+    EXPECT_THAT(verifiers[0]->Verify(signature, "some data"), IsOk());
+    EXPECT_THAT(verifiers[1]->Verify(signature, "some data"), Not(IsOk()));
+    EXPECT_THAT(verifiers[2]->Verify(signature, "some data"), IsOk());
+    EXPECT_THAT(verifiers[0]->Verify(signature, "other data"), Not(IsOk()));
+  }
+}
+
+TEST(NewPublicKeyVerifiersFromPemTest, Errors) {
+  PemKey pem_key = {.serialized_key = std::string(kRsaPublicKey2048),
+                    .parameters = {.key_type = PemKeyType::PEM_RSA,
+                                   .algorithm = PemAlgorithm::RSASSA_PSS,
+                                   .key_size_in_bits = 2048,
+                                   .hash_type = HashType::SHA256}};
+  PemKey size_mismatch = pem_key;
+  size_mismatch.parameters.key_size_in_bits = 3072;
+  EXPECT_THAT(NewPublicKeyVerifiersFromPem({pem_key, size_mismatch}, 2)
+                  .status(),
+              StatusIs(Code::INVALID_ARGUMENT));
+
+  PemKey too_small = pem_key;
+  too_small.serialized_key = std::string(kRsaPublicKey1024);
+  too_small.parameters.key_size_in_bits = 1024;
+  EXPECT_THAT(NewPublicKeyVerifiersFromPem({too_small}).status(),
+              Not(IsOk()));
+
+  PemKey not_ec = pem_key;
+  not_ec.parameters.key_type = PemKeyType::PEM_EC;
+  not_ec.parameters.algorithm = PemAlgorithm::ECDSA;
+  EXPECT_THAT(NewPublicKeyVerifiersFromPem({not_ec}).status(), Not(IsOk()));
+
+  EXPECT_THAT(NewPublicKeyVerifiersFromPem({}).status(), IsOk());
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
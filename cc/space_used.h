@@ -0,0 +1,54 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SPACE_USED_H_
+#define TINK_SPACE_USED_H_
+
+#include <cstddef>
+
+namespace crypto {
+namespace tink {
+
+// Implemented by primitives which can estimate how much memory they hold,
+// e.g. to find out which keysets take the most memory in a process that
+// loads many of them.
+//
+// The primitives returned by KeysetHandle::GetPrimitive() implement it for
+// the AEAD, MAC and PublicKeySign wrappers, and count the primitives of
+// their keys which implement it, in particular those in subtle/ which hold
+// BoringSSL contexts or RSA keys.
+class SpaceUsedInterface {
+ public:
+  virtual ~SpaceUsedInterface() = default;
+
+  // Returns an estimate of the number of bytes held by this object,
+  // including sizeof(*this) and the memory of the objects it owns.
+  virtual size_t SpaceUsed() const = 0;
+};
+
+// Returns object.SpaceUsed() if 'object' implements SpaceUsedInterface, and
+// 0 otherwise.
+template <class T>
+size_t SpaceUsed(const T& object) {
+  const SpaceUsedInterface* space_used =
+      dynamic_cast<const SpaceUsedInterface*>(&object);
+  return space_used == nullptr ? 0 : space_used->SpaceUsed();
+}
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SPACE_USED_H_
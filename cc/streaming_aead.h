@@ -17,12 +17,17 @@
 #ifndef TINK_STREAMING_AEAD_H_
 #define TINK_STREAMING_AEAD_H_
 
+#include <cstdint>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "tink/executor.h"
 #include "tink/input_stream.h"
 #include "tink/output_stream.h"
 #include "tink/random_access_stream.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -77,6 +82,93 @@ class StreamingAead {
       std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
       absl::string_view associated_data) = 0;
 
+  // Options for the decrypting random access streams returned by
+  // NewDecryptingRandomAccessStream() below.
+  struct RandomAccessOptions {
+    // The maximum number of decrypted segments kept in a least recently used
+    // cache, so that overlapping PRead()s decrypt each segment only once.
+    int cache_segments = 0;
+    // The number of segments that are decrypted in the background after
+    // a sequential PRead(), ahead of the next one.  Prefetched segments are
+    // kept in the cache, so this must not exceed 'cache_segments', and it
+    // requires 'parallelism' > 1 or an 'executor'.
+    int readahead_segments = 0;
+    // The number of threads, including the calling one, that decrypt the
+    // segments of a PRead() spanning several segments.  The stream owns
+    // 'parallelism' - 1 worker threads, which also do the readahead.
+    int parallelism = 1;
+    // If not null, the stream runs its parallel work and the readahead on
+    // 'executor' instead of on threads of its own, and 'parallelism' is
+    // ignored.  PRead() must then not be called from a task running on
+    // 'executor'.
+    std::shared_ptr<Executor> executor;
+  };
+
+  // Like NewDecryptingRandomAccessStream() above, but the returned stream
+  // uses the specified 'options'.  Implementations that do not support
+  // any options may ignore them; the default implementation does so.
+  virtual crypto::tink::util::StatusOr<
+      std::unique_ptr<crypto::tink::RandomAccessStream>>
+  NewDecryptingRandomAccessStream(
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view associated_data, const RandomAccessOptions& options) {
+    return NewDecryptingRandomAccessStream(std::move(ciphertext_source),
+                                           associated_data);
+  }
+
+  // A range of bytes of a ciphertext.
+  struct CiphertextRange {
+    int64_t position;
+    int64_t size;
+  };
+
+  // Returns the ranges of a ciphertext of 'ciphertext_size' bytes that a
+  // stream from NewDecryptingRandomAccessStream() reads for a PRead() of
+  // 'count' plaintext bytes at 'position', including what it reads to
+  // initialize itself (e.g. the header).  The ranges are sorted, and ranges
+  // at most 'max_gap' bytes apart are coalesced.  This lets readers of remote
+  // storage fetch all the ciphertext upfront with few requests, and pass the
+  // buffers to the decrypting stream in a util::PrefetchedRandomAccessStream.
+  // The plan assumes a stream without readahead.  The default implementation
+  // returns UNIMPLEMENTED.
+  virtual crypto::tink::util::StatusOr<std::vector<CiphertextRange>>
+  PlanCiphertextRanges(int64_t ciphertext_size, int64_t position,
+                       int64_t count, int64_t max_gap) {
+    return crypto::tink::util::Status(
+        crypto::tink::util::error::UNIMPLEMENTED,
+        "Planning ciphertext ranges is not supported");
+  }
+
+  // Checks that 'ciphertext_source' is a complete and authentic ciphertext
+  // for 'associated_data', without returning the plaintext, e.g. to check
+  // backups.  Returns OK iff reading the whole ciphertext through
+  // NewDecryptingStream() would succeed.  Implementations that can check
+  // the segments of the ciphertext independently do so on up to
+  // 'parallelism' threads, including the calling one, and skip as much of
+  // the decryption as their construction allows.  The default
+  // implementation reads the plaintext from NewDecryptingStream() and
+  // discards it, ignoring 'parallelism'.
+  virtual crypto::tink::util::Status VerifyStream(
+      std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
+      absl::string_view associated_data, int parallelism) {
+    auto decrypting_stream_result =
+        NewDecryptingStream(std::move(ciphertext_source), associated_data);
+    if (!decrypting_stream_result.ok()) {
+      return decrypting_stream_result.status();
+    }
+    crypto::tink::InputStream& decrypting_stream =
+        *decrypting_stream_result.ValueOrDie();
+    const void* data;
+    while (true) {
+      auto next_result = decrypting_stream.Next(&data);
+      if (next_result.status().error_code() ==
+          crypto::tink::util::error::OUT_OF_RANGE) {
+        return crypto::tink::util::OkStatus();
+      }
+      if (!next_result.ok()) return next_result.status();
+    }
+  }
+
   virtual ~StreamingAead() {}
 };
 
@@ -21,6 +21,7 @@
 #include <string>
 
 #include "absl/strings/string_view.h"
+#include "tink/aead.h"
 #include "tink/output_stream_with_result.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -28,6 +29,18 @@
 namespace crypto {
 namespace tink {
 
+// A ComputeMacOutputStream whose progress can be saved, so that the MAC of a
+// long stream can be finished by another process, e.g. after a restart.
+class CheckpointableComputeMacOutputStream
+    : public OutputStreamWithResult<std::string> {
+ public:
+  // Returns the state of the MAC computation over the data written so far,
+  // encrypted with 'aead'.  All of the buffer of the last NextBuffer() call
+  // counts as written, so unused bytes must be given back with BackUp()
+  // first; afterwards the stream goes on with a new buffer.
+  virtual util::StatusOr<std::string> Checkpoint(const Aead& aead) = 0;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // Interface for Streaming MACs (Message Authentication Codes).
 // This interface should be used for authentication only, and not for other
@@ -44,6 +57,22 @@ class StreamingMac {
   virtual util::StatusOr<std::unique_ptr<OutputStreamWithResult<util::Status>>>
   NewVerifyMacOutputStream(const std::string& mac_value) const = 0;
 
+  // Returns a ComputeMacOutputStream which can save its progress.
+  virtual util::StatusOr<std::unique_ptr<CheckpointableComputeMacOutputStream>>
+  NewCheckpointableComputeMacOutputStream() const {
+    return util::Status(util::error::UNIMPLEMENTED,
+                        "This StreamingMac does not support checkpoints");
+  }
+
+  // Returns a ComputeMacOutputStream which continues the computation saved
+  // in 'checkpoint', which was encrypted with 'aead', at the same position.
+  virtual util::StatusOr<std::unique_ptr<CheckpointableComputeMacOutputStream>>
+  ResumeComputeMacOutputStream(absl::string_view checkpoint,
+                               const Aead& aead) const {
+    return util::Status(util::error::UNIMPLEMENTED,
+                        "This StreamingMac does not support checkpoints");
+  }
+
   virtual ~StreamingMac() {}
 };
 
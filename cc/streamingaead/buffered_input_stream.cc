@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "absl/memory/memory.h"
+#include "absl/types/span.h"
 #include "tink/input_stream.h"
 #include "tink/util/errors.h"
 #include "tink/util/status.h"
@@ -39,7 +40,8 @@ BufferedInputStream::BufferedInputStream(
   count_in_buffer_ = 0;
   count_backedup_ = 0;
   position_ = 0;
-  buffer_.resize(4 * 1024);  // 4 KB
+  // buffer_ is allocated on the first read, as streams that have rewinding
+  // disabled from the start never need it.
   buffer_offset_ = 0;
   after_rewind_ = false;
   rewinding_enabled_ = true;
@@ -73,7 +75,8 @@ crypto::tink::util::StatusOr<int> BufferedInputStream::Next(const void** data) {
   // can be discarded, and from now on we go directly to input_stream_
   if (!rewinding_enabled_) {
     direct_access_ = true;
-    buffer_.resize(0);
+    // Frees the memory, which clear() would keep.
+    std::vector<uint8_t>().swap(buffer_);
     return input_stream_->Next(data);
   }
 
@@ -88,7 +91,8 @@ crypto::tink::util::StatusOr<int> BufferedInputStream::Next(const void** data) {
   }
   size_t count_read = next_result.ValueOrDie();
   if (buffer_.size() < count_in_buffer_ + count_read) {
-    buffer_.resize(buffer_.size() + std::max(buffer_.size(), count_read));
+    buffer_.resize(buffer_.size() + std::max(
+        {buffer_.size(), count_read, kInitialBufferSize}));
   }
   memcpy(buffer_.data() + count_in_buffer_, buf, count_read);
   buffer_offset_ = count_in_buffer_;
@@ -99,6 +103,12 @@ crypto::tink::util::StatusOr<int> BufferedInputStream::Next(const void** data) {
   return count_read;
 }
 
+crypto::tink::util::StatusOr<int> BufferedInputStream::ReadInto(
+    absl::Span<uint8_t> buffer) {
+  if (direct_access_) return input_stream_->ReadInto(buffer);
+  return InputStream::ReadInto(buffer);
+}
+
 void BufferedInputStream::BackUp(int count) {
   if (direct_access_) {
     input_stream_->BackUp(count);
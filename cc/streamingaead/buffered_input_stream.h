@@ -20,6 +20,7 @@
 #include <memory>
 #include <vector>
 
+#include "absl/types/span.h"
 #include "tink/input_stream.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -47,13 +48,23 @@ class BufferedInputStream : public crypto::tink::InputStream {
 
   int64_t Position() const override;
 
+  // Relays to the wrapped stream once this stream reads directly from it.
+  crypto::tink::util::StatusOr<int> ReadInto(
+      absl::Span<uint8_t> buffer) override;
+
   // Rewinds this stream to the beginning (if rewinding is still enabled).
   crypto::tink::util::Status Rewind();
 
-  // Disables rewinding.
+  // Disables rewinding. The bytes buffered so far are still returned by
+  // Next() (after a rewind, or if backed up), and then the stream switches
+  // to reading directly from the wrapped stream, without copying, and frees
+  // its buffer.
   void DisableRewinding();
 
  private:
+  static constexpr size_t kInitialBufferSize = 4 * 1024;  // 4 KB
+
+
   std::unique_ptr<crypto::tink::InputStream> input_stream_;
   bool direct_access_;      // true iff we don't buffer any data any more
 
@@ -0,0 +1,106 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/streamingaead/chacha20_poly1305_hkdf_streaming_key_manager.h"
+
+#include "tink/subtle/chacha20_poly1305_hkdf_streaming.h"
+#include "tink/subtle/random.h"
+#include "tink/util/input_stream_util.h"
+#include "tink/util/validation.h"
+
+namespace crypto {
+namespace tink {
+
+using ::crypto::tink::subtle::ChaCha20Poly1305HkdfStreaming;
+using ::crypto::tink::util::Status;
+using ::crypto::tink::util::StatusOr;
+using ::google::crypto::tink::ChaCha20Poly1305HkdfStreamingKey;
+using ::google::crypto::tink::ChaCha20Poly1305HkdfStreamingKeyFormat;
+using ::google::crypto::tink::ChaCha20Poly1305HkdfStreamingParams;
+using ::google::crypto::tink::HashType;
+
+namespace {
+
+Status ValidateParams(const ChaCha20Poly1305HkdfStreamingParams& params) {
+  if (!(params.hkdf_hash_type() == HashType::SHA1 ||
+        params.hkdf_hash_type() == HashType::SHA256 ||
+        params.hkdf_hash_type() == HashType::SHA512)) {
+    return Status(util::error::INVALID_ARGUMENT, "unsupported hkdf_hash_type");
+  }
+  int header_size = 1 + ChaCha20Poly1305HkdfStreaming::kKeySizeInBytes +
+                    ChaCha20Poly1305HkdfStreaming::kNoncePrefixSizeInBytes;
+  if (params.ciphertext_segment_size() <=
+      header_size + ChaCha20Poly1305HkdfStreaming::kTagSizeInBytes) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "ciphertext_segment_size too small");
+  }
+  return util::OkStatus();
+}
+
+}  // namespace
+
+StatusOr<ChaCha20Poly1305HkdfStreamingKey>
+ChaCha20Poly1305HkdfStreamingKeyManager::CreateKey(
+    const ChaCha20Poly1305HkdfStreamingKeyFormat& key_format) const {
+  ChaCha20Poly1305HkdfStreamingKey key;
+  key.set_version(get_version());
+  key.set_key_value(subtle::Random::GetRandomBytes(key_format.key_size()));
+  *key.mutable_params() = key_format.params();
+  return key;
+}
+
+StatusOr<ChaCha20Poly1305HkdfStreamingKey>
+ChaCha20Poly1305HkdfStreamingKeyManager::DeriveKey(
+    const ChaCha20Poly1305HkdfStreamingKeyFormat& key_format,
+    InputStream* input_stream) const {
+  Status status = ValidateVersion(key_format.version(), get_version());
+  if (!status.ok()) return status;
+
+  StatusOr<std::string> randomness_or =
+      ReadBytesFromStream(key_format.key_size(), input_stream);
+  if (!randomness_or.ok()) {
+    return randomness_or.status();
+  }
+  ChaCha20Poly1305HkdfStreamingKey key;
+  key.set_version(get_version());
+  key.set_key_value(randomness_or.ValueOrDie());
+  *key.mutable_params() = key_format.params();
+  return key;
+}
+
+Status ChaCha20Poly1305HkdfStreamingKeyManager::ValidateKey(
+    const ChaCha20Poly1305HkdfStreamingKey& key) const {
+  Status status = ValidateVersion(key.version(), get_version());
+  if (!status.ok()) return status;
+  if (key.key_value().size() <
+      ChaCha20Poly1305HkdfStreaming::kKeySizeInBytes) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "key_value (i.e. ikm) too short");
+  }
+  return ValidateParams(key.params());
+}
+
+Status ChaCha20Poly1305HkdfStreamingKeyManager::ValidateKeyFormat(
+    const ChaCha20Poly1305HkdfStreamingKeyFormat& key_format) const {
+  if (key_format.key_size() < ChaCha20Poly1305HkdfStreaming::kKeySizeInBytes) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "key_size must be at least 32 bytes");
+  }
+  return ValidateParams(key_format.params());
+}
+
+}  // namespace tink
+}  // namespace crypto
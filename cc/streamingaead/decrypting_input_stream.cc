@@ -18,13 +18,17 @@
 
 #include <algorithm>
 #include <cstring>
+#include <string>
 #include <vector>
 
 #include "absl/memory/memory.h"
+#include "absl/types/span.h"
 #include "tink/input_stream.h"
+#include "tink/internal/monitored_operation.h"
 #include "tink/primitive_set.h"
 #include "tink/streaming_aead.h"
 #include "tink/streamingaead/buffered_input_stream.h"
+#include "tink/streamingaead/header_key_cache.h"
 #include "tink/streamingaead/shared_input_stream.h"
 #include "tink/util/errors.h"
 #include "tink/util/status.h"
@@ -39,17 +43,49 @@ using crypto::tink::StreamingAead;
 using util::Status;
 using util::StatusOr;
 
+namespace {
+
+// Reads up to HeaderKeyCache::kPrefixSize bytes from 'ct_source'
+// into 'prefix'.
+Status ReadPrefix(InputStream* ct_source, std::string* prefix) {
+  const void* data;
+  while (prefix->size() < HeaderKeyCache::kPrefixSize) {
+    auto next_result = ct_source->Next(&data);
+    if (next_result.status().error_code() == util::error::OUT_OF_RANGE) {
+      break;
+    }
+    if (!next_result.ok()) return next_result.status();
+    int count = std::min<int>(next_result.ValueOrDie(),
+                              HeaderKeyCache::kPrefixSize - prefix->size());
+    prefix->append(static_cast<const char*>(data), count);
+  }
+  return Status::OK;
+}
+
+}  // namespace
+
 // static
 StatusOr<std::unique_ptr<InputStream>> DecryptingInputStream::New(
     std::shared_ptr<PrimitiveSet<StreamingAead>> primitives,
     std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
     absl::string_view associated_data) {
+  return New(std::move(primitives), std::move(ciphertext_source),
+             associated_data, nullptr);
+}
+
+// static
+StatusOr<std::unique_ptr<InputStream>> DecryptingInputStream::New(
+    std::shared_ptr<PrimitiveSet<StreamingAead>> primitives,
+    std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
+    absl::string_view associated_data,
+    std::shared_ptr<HeaderKeyCache> header_key_cache) {
   std::unique_ptr<DecryptingInputStream> dec_stream(
       new DecryptingInputStream());
   dec_stream->primitives_ = primitives;
   dec_stream->buffered_ct_source_ =
       std::make_shared<BufferedInputStream>(std::move(ciphertext_source));
   dec_stream->associated_data_ = std::string(associated_data);
+  dec_stream->header_key_cache_ = std::move(header_key_cache);
   dec_stream->attempted_matching_ = false;
   dec_stream->matching_stream_ = nullptr;
   return {std::move(dec_stream)};
@@ -65,12 +101,46 @@ util::StatusOr<int> DecryptingInputStream::Next(const void** data) {
   }
   // Matching has not been attempted yet, so try it now.
   attempted_matching_ = true;
+  internal::MonitoredOperation operation("streaming_aead", "decrypt_stream");
   auto raw_primitives_result = primitives_->get_raw_primitives();
   if (!raw_primitives_result.ok()) {
     return Status(util::error::INTERNAL, "No RAW primitives found");
   }
-  for (auto& primitive : *(raw_primitives_result.ValueOrDie())) {
-    StreamingAead& streaming_aead = primitive->get_primitive();
+  auto& raw_primitives = *(raw_primitives_result.ValueOrDie());
+
+  // Look up the primitive that matched a stream with the same header.
+  std::string prefix;
+  int hint = -1;
+  bool use_cache = header_key_cache_ != nullptr && raw_primitives.size() > 1;
+  if (use_cache) {
+    use_cache = ReadPrefix(buffered_ct_source_.get(), &prefix).ok();
+    Status s = buffered_ct_source_->Rewind();
+    if (!s.ok()) {
+      return s;
+    }
+  }
+  if (use_cache) {
+    auto cached_index = header_key_cache_->Lookup(prefix);
+    if (cached_index.has_value() && *cached_index < raw_primitives.size()) {
+      hint = *cached_index;
+    }
+  }
+
+  // Try the hinted primitive first, and then the others in order.
+  for (int attempt = -1; attempt < static_cast<int>(raw_primitives.size());
+       attempt++) {
+    int i = attempt < 0 ? hint : attempt;
+    if (i < 0 || (attempt >= 0 && i == hint)) continue;
+    StreamingAead& streaming_aead = raw_primitives[i]->get_primitive();
+    operation.KeyTried();
+    // Nothing needs rewinding after the last attempt, so it reads the
+    // ciphertext without buffering it, past the bytes buffered so far.
+    // In particular, streams of single-key keysets are never buffered.
+    bool last_attempt =
+        attempt + 1 == static_cast<int>(raw_primitives.size()) ||
+        (attempt + 2 == static_cast<int>(raw_primitives.size()) &&
+         attempt + 1 == hint);
+    if (last_attempt) buffered_ct_source_->DisableRewinding();
     auto shared_ct = absl::make_unique<SharedInputStream>(
         buffered_ct_source_.get());
     auto decrypting_stream_result = streaming_aead.NewDecryptingStream(
@@ -81,10 +151,13 @@ util::StatusOr<int> DecryptingInputStream::Next(const void** data) {
           next_result.ok()) {  // Found a match.
         buffered_ct_source_->DisableRewinding();
         matching_stream_ = std::move(decrypting_stream_result.ValueOrDie());
+        if (use_cache) header_key_cache_->Insert(prefix, i);
+        operation.Succeeded(raw_primitives[i]->get_key_id());
         return next_result;
       }
     }
     // Not a match, rewind and try the next primitive.
+    if (last_attempt) break;
     Status s = buffered_ct_source_->Rewind();
     if (!s.ok()) {
       return s;
@@ -94,6 +167,13 @@ util::StatusOr<int> DecryptingInputStream::Next(const void** data) {
                 "Could not find a decrypter matching the ciphertext stream.");
 }
 
+util::StatusOr<int> DecryptingInputStream::ReadInto(
+    absl::Span<uint8_t> buffer) {
+  // Before a match is found, the first Next() finds one.
+  if (matching_stream_ == nullptr) return InputStream::ReadInto(buffer);
+  return matching_stream_->ReadInto(buffer);
+}
+
 void DecryptingInputStream::BackUp(int count) {
   if (matching_stream_ != nullptr) {
     matching_stream_->BackUp(count);
@@ -20,11 +20,13 @@
 #include <memory>
 #include <vector>
 
+#include "absl/types/span.h"
 #include "tink/input_stream.h"
 #include "tink/primitive_set.h"
 #include "tink/streaming_aead.h"
 #include "tink/util/statusor.h"
 #include "tink/streamingaead/buffered_input_stream.h"
+#include "tink/streamingaead/header_key_cache.h"
 
 namespace crypto {
 namespace tink {
@@ -47,10 +49,21 @@ class DecryptingInputStream : public crypto::tink::InputStream {
       std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
       absl::string_view associated_data);
 
+  // Like New() above, but if 'header_key_cache' is not null, it is consulted
+  // to try the primitive that decrypted a stream with the same header first,
+  // and it is updated with the matching primitive.
+  static util::StatusOr<std::unique_ptr<InputStream>> New(
+      std::shared_ptr<
+          crypto::tink::PrimitiveSet<crypto::tink::StreamingAead>> primitives,
+      std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
+      absl::string_view associated_data,
+      std::shared_ptr<HeaderKeyCache> header_key_cache);
+
   ~DecryptingInputStream() override {}
   util::StatusOr<int> Next(const void** data) override;
   void BackUp(int count) override;
   int64_t Position() const override;
+  util::StatusOr<int> ReadInto(absl::Span<uint8_t> buffer) override;
 
  private:
   DecryptingInputStream() {}
@@ -58,6 +71,7 @@ class DecryptingInputStream : public crypto::tink::InputStream {
       crypto::tink::PrimitiveSet<crypto::tink::StreamingAead>> primitives_;
   std::shared_ptr<BufferedInputStream> buffered_ct_source_;
   std::string associated_data_;
+  std::shared_ptr<HeaderKeyCache> header_key_cache_;
   std::unique_ptr<crypto::tink::InputStream> matching_stream_;
   bool attempted_matching_;
 };
@@ -16,6 +16,7 @@
 
 #include "tink/streamingaead/decrypting_input_stream.h"
 
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -27,6 +28,7 @@
 #include "tink/output_stream.h"
 #include "tink/primitive_set.h"
 #include "tink/streaming_aead.h"
+#include "tink/streamingaead/header_key_cache.h"
 #include "tink/subtle/random.h"
 #include "tink/subtle/test_util.h"
 #include "tink/util/istream_input_stream.h"
@@ -167,6 +169,71 @@ TEST(DecryptingInputStreamTest, BasicDecryption) {
   }
 }
 
+// An InputStream that remembers the memory ranges it has returned.
+class RecordingInputStream : public InputStream {
+ public:
+  explicit RecordingInputStream(std::unique_ptr<InputStream> input_stream,
+                                std::vector<absl::string_view>* returned)
+      : input_stream_(std::move(input_stream)), returned_(returned) {}
+
+  util::StatusOr<int> Next(const void** data) override {
+    auto next_result = input_stream_->Next(data);
+    if (next_result.ok()) {
+      returned_->emplace_back(static_cast<const char*>(*data),
+                              next_result.ValueOrDie());
+    }
+    return next_result;
+  }
+  void BackUp(int count) override { input_stream_->BackUp(count); }
+  int64_t Position() const override { return input_stream_->Position(); }
+
+ private:
+  std::unique_ptr<InputStream> input_stream_;
+  std::vector<absl::string_view>* returned_;
+};
+
+// Returns true if 'data' lies within one of the ranges in 'returned'.
+bool IsWithin(absl::string_view data,
+              const std::vector<absl::string_view>& returned) {
+  for (absl::string_view range : returned) {
+    if (data.data() >= range.data() &&
+        data.data() + data.size() <= range.data() + range.size()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+TEST(DecryptingInputStreamTest, SingleKeyIsNotBuffered) {
+  auto saead_set = GetTestStreamingAeadSet({{1234543, "streaming_aead0"}});
+  auto& saead = (*saead_set->get_raw_primitives().ValueOrDie())[0];
+  std::string plaintext = subtle::Random::GetRandomBytes(1000);
+  std::string aad = "some aad";
+  std::vector<absl::string_view> returned;
+  auto dec_stream_result = DecryptingInputStream::New(
+      saead_set,
+      absl::make_unique<RecordingInputStream>(
+          GetCiphertextSource(&saead->get_primitive(), plaintext, aad),
+          &returned),
+      aad);
+  ASSERT_THAT(dec_stream_result.status(), IsOk());
+  auto& dec_stream = dec_stream_result.ValueOrDie();
+
+  // All the decrypted bytes come straight from the ciphertext source.
+  std::string decrypted;
+  const void* data;
+  auto next_result = dec_stream->Next(&data);
+  while (next_result.ok()) {
+    absl::string_view chunk(static_cast<const char*>(data),
+                            next_result.ValueOrDie());
+    EXPECT_TRUE(IsWithin(chunk, returned));
+    decrypted.append(chunk.data(), chunk.size());
+    next_result = dec_stream->Next(&data);
+  }
+  EXPECT_THAT(next_result.status(), StatusIs(util::error::OUT_OF_RANGE));
+  EXPECT_EQ(plaintext, decrypted);
+}
+
 TEST(DecryptingInputStreamTest, WrongAssociatedData) {
   uint32_t key_id_0 = 1234543;
   uint32_t key_id_1 = 726329;
@@ -228,6 +295,41 @@ TEST(DecryptingInputStreamTest, WrongCiphertext) {
   }
 }
 
+TEST(DecryptingInputStreamTest, HeaderKeyCache) {
+  auto saead_set = GetTestStreamingAeadSet(
+      {{1234543, "streaming_aead0"}, {726329, "streaming_aead1"},
+       {7213743, "streaming_aead2"}});
+  auto header_key_cache = std::make_shared<HeaderKeyCache>();
+  std::string plaintext = subtle::Random::GetRandomBytes(1000);
+  std::string aad = "some aad";
+
+  int index = 0;
+  for (const auto& p : *(saead_set->get_raw_primitives().ValueOrDie())) {
+    SCOPED_TRACE(absl::StrCat("index = ", index));
+    std::string ct;
+    ASSERT_THAT(
+        ReadFromStream(
+            GetCiphertextSource(&(p->get_primitive()), plaintext, aad).get(),
+            &ct),
+        IsOk());
+    std::string prefix = ct.substr(0, HeaderKeyCache::kPrefixSize);
+    // A wrong hint only costs an additional attempt.
+    header_key_cache->Insert(prefix, (index + 1) % 3);
+
+    for (int i = 0; i < 2; i++) {
+      auto dec_stream_result = DecryptingInputStream::New(
+          saead_set, GetInputStream(ct), aad, header_key_cache);
+      ASSERT_THAT(dec_stream_result.status(), IsOk());
+      std::string decrypted;
+      EXPECT_THAT(
+          ReadFromStream(dec_stream_result.ValueOrDie().get(), &decrypted),
+          IsOk());
+      EXPECT_EQ(plaintext, decrypted);
+      EXPECT_EQ(index, header_key_cache->Lookup(prefix));
+    }
+    index++;
+  }
+}
 
 }  // namespace
 }  // namespace streamingaead
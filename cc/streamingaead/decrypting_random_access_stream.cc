@@ -16,12 +16,22 @@
 
 #include "tink/streamingaead/decrypting_random_access_stream.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
 #include "absl/memory/memory.h"
 #include "absl/synchronization/mutex.h"
+#include "tink/executor.h"
+#include "tink/internal/monitored_operation.h"
 #include "tink/random_access_stream.h"
 #include "tink/primitive_set.h"
 #include "tink/streaming_aead.h"
-#include "tink/streamingaead/shared_random_access_stream.h"
+#include "tink/streamingaead/header_key_cache.h"
 #include "tink/util/buffer.h"
 #include "tink/util/errors.h"
 #include "tink/util/status.h"
@@ -36,11 +46,174 @@ using crypto::tink::StreamingAead;
 using util::Status;
 using util::StatusOr;
 
+// Shares the PReads of the ciphertext source among the streams of all the
+// primitives tried while matching: each (position, count) range is read from
+// the source once, and concurrent reads of the same range wait for it.
+// Once disabled, after matching, reads are forwarded to the source.
+class DecryptingRandomAccessStream::MatchingReadCache {
+ public:
+  explicit MatchingReadCache(RandomAccessStream* source) : source_(source) {}
+
+  Status PRead(int64_t position, int count, util::Buffer* dest_buffer) {
+    std::shared_ptr<Read> read;
+    bool fetch = false;
+    {
+      absl::MutexLock lock(&mutex_);
+      if (enabled_) {
+        std::shared_ptr<Read>& entry = reads_[{position, count}];
+        if (entry == nullptr) {
+          entry = std::make_shared<Read>();
+          fetch = true;
+        }
+        read = entry;
+      }
+    }
+    if (read == nullptr) return source_->PRead(position, count, dest_buffer);
+    if (fetch) {
+      auto status = source_->PRead(position, count, dest_buffer);
+      absl::MutexLock lock(&mutex_);
+      read->status = status;
+      read->data.assign(dest_buffer->get_mem_block(), dest_buffer->size());
+      read->done = true;
+      return status;
+    }
+    absl::MutexLock lock(&mutex_);
+    mutex_.Await(absl::Condition(&read->done));
+    std::memcpy(dest_buffer->get_mem_block(), read->data.data(),
+                read->data.size());
+    auto status = dest_buffer->set_size(read->data.size());
+    if (!status.ok()) return status;
+    return read->status;
+  }
+
+  // Views would bypass the sharing, so they are only offered once disabled.
+  StatusOr<absl::string_view> PReadView(int64_t position, int count) {
+    {
+      absl::MutexLock lock(&mutex_);
+      if (enabled_) {
+        return Status(util::error::UNIMPLEMENTED,
+                      "PReadView() is not supported while matching");
+      }
+    }
+    return source_->PReadView(position, count);
+  }
+
+  StatusOr<int64_t> size() { return source_->size(); }
+
+  // Returns a stream that reads via this cache, which must outlive it.
+  std::unique_ptr<RandomAccessStream> NewStream() {
+    return absl::make_unique<Stream>(this);
+  }
+
+  // Frees the reads kept so far, and forwards all later ones.
+  void Disable() {
+    absl::MutexLock lock(&mutex_);
+    enabled_ = false;
+    reads_.clear();
+  }
+
+ private:
+  class Stream : public RandomAccessStream {
+   public:
+    explicit Stream(MatchingReadCache* cache) : cache_(cache) {}
+
+    Status PRead(int64_t position, int count,
+                 util::Buffer* dest_buffer) override {
+      return cache_->PRead(position, count, dest_buffer);
+    }
+
+    StatusOr<absl::string_view> PReadView(int64_t position,
+                                          int count) override {
+      return cache_->PReadView(position, count);
+    }
+
+    StatusOr<int64_t> size() override { return cache_->size(); }
+
+   private:
+    MatchingReadCache* const cache_;
+  };
+
+  struct Read {
+    bool done = false;
+    Status status;
+    std::string data;
+  };
+
+  RandomAccessStream* const source_;
+  absl::Mutex mutex_;
+  bool enabled_ ABSL_GUARDED_BY(mutex_) = true;
+  absl::flat_hash_map<std::pair<int64_t, int>, std::shared_ptr<Read>> reads_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+namespace {
+
+// Creates the decrypting stream of 'streaming_aead' for 'ciphertext_source'
+// and does the first PRead() with it. Returns true if the stream can
+// decrypt the ciphertext, in which case it is moved to 'matching_stream'
+// and the status of the PRead() is stored in 'status'.
+bool TryPrimitive(StreamingAead& streaming_aead,
+                  std::unique_ptr<RandomAccessStream> ciphertext_source,
+                  absl::string_view associated_data,
+                  const StreamingAead::RandomAccessOptions& options,
+                  int64_t position, int count, util::Buffer* dest_buffer,
+                  std::unique_ptr<RandomAccessStream>* matching_stream,
+                  Status* status) {
+  auto decrypting_stream_result =
+      streaming_aead.NewDecryptingRandomAccessStream(
+          std::move(ciphertext_source), associated_data, options);
+  if (!decrypting_stream_result.ok()) return false;
+  auto read_status = decrypting_stream_result.ValueOrDie()->PRead(
+      position, count, dest_buffer);
+  if (!read_status.ok() &&
+      read_status.error_code() != util::error::OUT_OF_RANGE) {
+    return false;
+  }
+  *matching_stream = std::move(decrypting_stream_result.ValueOrDie());
+  *status = read_status;
+  return true;
+}
+
+}  // namespace
+
 // static
 StatusOr<std::unique_ptr<RandomAccessStream>> DecryptingRandomAccessStream::New(
     std::shared_ptr<PrimitiveSet<StreamingAead>> primitives,
     std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
     absl::string_view associated_data) {
+  return New(std::move(primitives), std::move(ciphertext_source),
+             associated_data, StreamingAead::RandomAccessOptions());
+}
+
+// static
+StatusOr<std::unique_ptr<RandomAccessStream>> DecryptingRandomAccessStream::New(
+    std::shared_ptr<PrimitiveSet<StreamingAead>> primitives,
+    std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+    absl::string_view associated_data,
+    const StreamingAead::RandomAccessOptions& options) {
+  return New(std::move(primitives), std::move(ciphertext_source),
+             associated_data, options, nullptr);
+}
+
+// static
+StatusOr<std::unique_ptr<RandomAccessStream>> DecryptingRandomAccessStream::New(
+    std::shared_ptr<PrimitiveSet<StreamingAead>> primitives,
+    std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+    absl::string_view associated_data,
+    const StreamingAead::RandomAccessOptions& options,
+    std::shared_ptr<HeaderKeyCache> header_key_cache) {
+  return New(std::move(primitives), std::move(ciphertext_source),
+             associated_data, options, std::move(header_key_cache), nullptr);
+}
+
+// static
+StatusOr<std::unique_ptr<RandomAccessStream>> DecryptingRandomAccessStream::New(
+    std::shared_ptr<PrimitiveSet<StreamingAead>> primitives,
+    std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+    absl::string_view associated_data,
+    const StreamingAead::RandomAccessOptions& options,
+    std::shared_ptr<HeaderKeyCache> header_key_cache,
+    std::shared_ptr<Executor> executor) {
   if (primitives == nullptr) {
     return Status(util::error::INVALID_ARGUMENT,
                   "primitives must be non-null.");
@@ -50,9 +223,30 @@ StatusOr<std::unique_ptr<RandomAccessStream>> DecryptingRandomAccessStream::New(
                   "ciphertext_source must be non-null.");
   }
   return {absl::WrapUnique(new DecryptingRandomAccessStream(
-      primitives, std::move(ciphertext_source), associated_data))};
+      primitives, std::move(ciphertext_source), associated_data, options,
+      std::move(header_key_cache), std::move(executor)))};
 }
 
+DecryptingRandomAccessStream::DecryptingRandomAccessStream(
+    std::shared_ptr<PrimitiveSet<StreamingAead>> primitives,
+    std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+    absl::string_view associated_data,
+    const StreamingAead::RandomAccessOptions& options,
+    std::shared_ptr<HeaderKeyCache> header_key_cache,
+    std::shared_ptr<Executor> executor)
+    : primitives_(primitives),
+      ciphertext_source_(std::move(ciphertext_source)),
+      associated_data_(associated_data),
+      options_(options),
+      header_key_cache_(std::move(header_key_cache)),
+      executor_(std::move(executor)),
+      read_cache_(absl::make_unique<MatchingReadCache>(
+          ciphertext_source_.get())),
+      attempted_matching_(false),
+      matching_stream_(nullptr) {}
+
+DecryptingRandomAccessStream::~DecryptingRandomAccessStream() {}
+
 util::Status DecryptingRandomAccessStream::PRead(
     int64_t position, int count,
     crypto::tink::util::Buffer* dest_buffer) {
@@ -93,30 +287,113 @@ util::Status DecryptingRandomAccessStream::PRead(
                   "Did not find a decrypter matching the ciphertext stream.");
   }
   attempted_matching_ = true;
+  internal::MonitoredOperation operation("streaming_aead", "decrypt_random_access");
   auto raw_primitives_result = primitives_->get_raw_primitives();
   if (!raw_primitives_result.ok()) {
     return Status(util::error::INTERNAL, "No RAW primitives found");
   }
-  for (auto& primitive : *(raw_primitives_result.ValueOrDie())) {
-    StreamingAead& streaming_aead = primitive->get_primitive();
-    auto shared_ct = absl::make_unique<SharedRandomAccessStream>(
-        ciphertext_source_.get());
-    auto decrypting_stream_result =
-        streaming_aead.NewDecryptingRandomAccessStream(
-            std::move(shared_ct), associated_data_);
-    if (decrypting_stream_result.ok()) {
-      auto status = decrypting_stream_result.ValueOrDie()->PRead(
-          position, count, dest_buffer);
-      if (status.ok() || status.error_code() == util::error::OUT_OF_RANGE) {
-        // Found a match.
-        matching_stream_ = std::move(decrypting_stream_result.ValueOrDie());
-        return status;
+  auto& raw_primitives = *(raw_primitives_result.ValueOrDie());
+
+  // Look up the primitive that matched a stream with the same header.
+  std::string prefix;
+  int hint = -1;
+  bool use_cache = header_key_cache_ != nullptr && raw_primitives.size() > 1;
+  if (use_cache) {
+    auto buffer_result = util::Buffer::New(HeaderKeyCache::kPrefixSize);
+    if (!buffer_result.ok()) return buffer_result.status();
+    auto prefix_buffer = std::move(buffer_result.ValueOrDie());
+    auto status = read_cache_->PRead(0, HeaderKeyCache::kPrefixSize,
+                                     prefix_buffer.get());
+    use_cache =
+        status.ok() || status.error_code() == util::error::OUT_OF_RANGE;
+    prefix.assign(prefix_buffer->get_mem_block(), prefix_buffer->size());
+  }
+  if (use_cache) {
+    auto cached_index = header_key_cache_->Lookup(prefix);
+    if (cached_index.has_value() && *cached_index < raw_primitives.size()) {
+      hint = *cached_index;
+    }
+  }
+
+  // Try the hinted primitive first, and then the others in order.
+  std::vector<int> order;
+  if (hint >= 0) order.push_back(hint);
+  for (int i = 0; i < static_cast<int>(raw_primitives.size()); i++) {
+    if (i != hint) order.push_back(i);
+  }
+  auto try_primitive = [this, &raw_primitives, position, count](
+                           int i, util::Buffer* buffer,
+                           std::unique_ptr<RandomAccessStream>* stream,
+                           Status* status) {
+    return TryPrimitive(
+        raw_primitives[i]->get_primitive(),
+        read_cache_->NewStream(),
+        associated_data_, options_, position, count, buffer, stream, status);
+  };
+  // With an executor only the hinted primitive is tried on its own.
+  int sequential = order.size();
+  if (executor_ != nullptr) sequential = hint >= 0 ? 1 : 0;
+  int matched = -1;
+  Status status;
+  for (int k = 0; k < sequential && matched < 0; k++) {
+    operation.KeyTried();
+    if (try_primitive(order[k], dest_buffer, &matching_stream_, &status)) {
+      matched = order[k];
+    }
+  }
+  int remaining = order.size() - sequential;
+  if (matched < 0 && remaining > 0) {
+    // Each concurrent attempt reads into its own buffer; the first one in
+    // 'order' that matches wins, and later ones are skipped if possible.
+    struct Attempt {
+      bool tried = false;
+      bool matched = false;
+      std::unique_ptr<util::Buffer> buffer;
+      std::unique_ptr<RandomAccessStream> stream;
+      Status status;
+    };
+    std::vector<Attempt> attempts(remaining);
+    std::atomic<int> first_match{remaining};
+    executor_->ParallelFor(remaining, [&](int k) {
+      if (k > first_match.load()) return;
+      Attempt& attempt = attempts[k];
+      attempt.tried = true;
+      auto buffer_result = util::Buffer::New(std::max(count, 1));
+      if (!buffer_result.ok()) return;
+      attempt.buffer = std::move(buffer_result.ValueOrDie());
+      attempt.matched = try_primitive(order[sequential + k],
+                                      attempt.buffer.get(), &attempt.stream,
+                                      &attempt.status);
+      if (!attempt.matched) return;
+      int current = first_match.load();
+      while (k < current && !first_match.compare_exchange_weak(current, k)) {
       }
+    });
+    for (int k = 0; k < remaining; k++) {
+      if (attempts[k].tried) operation.KeyTried();
     }
-    // Not a match, try the next primitive.
+    int k = first_match.load();
+    if (k < remaining) {
+      Attempt& attempt = attempts[k];
+      std::memcpy(dest_buffer->get_mem_block(),
+                  attempt.buffer->get_mem_block(), attempt.buffer->size());
+      auto size_status = dest_buffer->set_size(attempt.buffer->size());
+      if (!size_status.ok()) return size_status;
+      matching_stream_ = std::move(attempt.stream);
+      status = attempt.status;
+      matched = order[sequential + k];
+    }
+  }
+  // The streams of the other primitives are gone, so the matching stream
+  // can read the ciphertext source directly from now on.
+  read_cache_->Disable();
+  if (matched < 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "Could not find a decrypter matching the ciphertext stream.");
   }
-  return Status(util::error::INVALID_ARGUMENT,
-                "Could not find a decrypter matching the ciphertext stream.");
+  if (use_cache) header_key_cache_->Insert(prefix, matched);
+  operation.Succeeded(raw_primitives[matched]->get_key_id());
+  return status;
 }
 
 StatusOr<int64_t> DecryptingRandomAccessStream::size() {
@@ -21,9 +21,11 @@
 #include <vector>
 
 #include "absl/synchronization/mutex.h"
+#include "tink/executor.h"
 #include "tink/random_access_stream.h"
 #include "tink/primitive_set.h"
 #include "tink/streaming_aead.h"
+#include "tink/streamingaead/header_key_cache.h"
 #include "tink/util/buffer.h"
 #include "tink/util/statusor.h"
 
@@ -36,6 +38,9 @@ namespace streamingaead {
 // to read the stream via the provided primitives to find a matching one,
 // i.e. the primitive that is able to decrypt the stream.
 // Once a match is found, all subsequent calls are forwarded to it.
+// While matching, each range of the ciphertext is read only once and shared
+// by all the primitives tried, so e.g. the header is fetched a single time
+// from a remote 'ciphertext_source'.
 class DecryptingRandomAccessStream : public crypto::tink::RandomAccessStream {
  public:
   // Constructs an RandomAccessStream that wraps 'random_access_stream',
@@ -48,26 +53,68 @@ class DecryptingRandomAccessStream : public crypto::tink::RandomAccessStream {
       std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
       absl::string_view associated_data);
 
-  ~DecryptingRandomAccessStream() override {}
+  // Like New() above, but the stream returned by the matching primitive
+  // is created with the given 'options' (see
+  // StreamingAead::RandomAccessOptions).
+  static util::StatusOr<std::unique_ptr<RandomAccessStream>> New(
+      std::shared_ptr<
+          crypto::tink::PrimitiveSet<crypto::tink::StreamingAead>> primitives,
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view associated_data,
+      const StreamingAead::RandomAccessOptions& options);
+
+  // Like New() above, but if 'header_key_cache' is not null, it is consulted
+  // to try the primitive that decrypted a stream with the same header first,
+  // and it is updated with the matching primitive.
+  static util::StatusOr<std::unique_ptr<RandomAccessStream>> New(
+      std::shared_ptr<
+          crypto::tink::PrimitiveSet<crypto::tink::StreamingAead>> primitives,
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view associated_data,
+      const StreamingAead::RandomAccessOptions& options,
+      std::shared_ptr<HeaderKeyCache> header_key_cache);
+
+  // Like New() above, but if 'executor' is not null, the primitives are tried
+  // concurrently on it (after the one suggested by 'header_key_cache', if
+  // any). The first PRead() must then not be called from a task running on
+  // 'executor'.
+  static util::StatusOr<std::unique_ptr<RandomAccessStream>> New(
+      std::shared_ptr<
+          crypto::tink::PrimitiveSet<crypto::tink::StreamingAead>> primitives,
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view associated_data,
+      const StreamingAead::RandomAccessOptions& options,
+      std::shared_ptr<HeaderKeyCache> header_key_cache,
+      std::shared_ptr<crypto::tink::Executor> executor);
+
+  ~DecryptingRandomAccessStream() override;
   crypto::tink::util::Status PRead(int64_t position, int count,
       crypto::tink::util::Buffer* dest_buffer) override;
   crypto::tink::util::StatusOr<int64_t> size() override;
 
  private:
+  class MatchingReadCache;
+
   DecryptingRandomAccessStream(
       std::shared_ptr<
           crypto::tink::PrimitiveSet<crypto::tink::StreamingAead>> primitives,
       std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
-      absl::string_view associated_data)
-      : primitives_(primitives),
-        ciphertext_source_(std::move(ciphertext_source)),
-        associated_data_(associated_data),
-        attempted_matching_(false),
-        matching_stream_(nullptr) {}
+      absl::string_view associated_data,
+      const StreamingAead::RandomAccessOptions& options,
+      std::shared_ptr<HeaderKeyCache> header_key_cache,
+      std::shared_ptr<crypto::tink::Executor> executor);
+
   std::shared_ptr<
       crypto::tink::PrimitiveSet<crypto::tink::StreamingAead>> primitives_;
   std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source_;
   std::string associated_data_;
+  const StreamingAead::RandomAccessOptions options_;
+  const std::shared_ptr<HeaderKeyCache> header_key_cache_;
+  const std::shared_ptr<crypto::tink::Executor> executor_;
+  // Reads 'ciphertext_source_' for the streams of the tried primitives,
+  // including the matching one. Declared before 'matching_stream_', which
+  // uses it, so that it outlives it.
+  const std::unique_ptr<MatchingReadCache> read_cache_;
   mutable absl::Mutex matching_mutex_;
   bool attempted_matching_ ABSL_GUARDED_BY(matching_mutex_);
   std::unique_ptr<crypto::tink::RandomAccessStream> matching_stream_
@@ -16,6 +16,8 @@
 
 #include "tink/streamingaead/decrypting_random_access_stream.h"
 
+#include <atomic>
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -24,9 +26,11 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "tink/random_access_stream.h"
+#include "tink/internal/thread_pool.h"
 #include "tink/output_stream.h"
 #include "tink/primitive_set.h"
 #include "tink/streaming_aead.h"
+#include "tink/streamingaead/header_key_cache.h"
 #include "tink/subtle/random.h"
 #include "tink/subtle/test_util.h"
 #include "tink/util/file_random_access_stream.h"
@@ -179,6 +183,160 @@ TEST(DecryptingRandomAccessStreamTest, BasicDecryption) {
   }
 }
 
+TEST(DecryptingRandomAccessStreamTest, DecryptionWithOptions) {
+  auto saead_set = GetTestStreamingAeadSet(
+      {{1234543, "streaming_aead0"}, {726329, "streaming_aead1"}});
+  StreamingAead::RandomAccessOptions options;
+  options.cache_segments = 4;
+  options.readahead_segments = 2;
+  options.parallelism = 2;
+  std::string plaintext = subtle::Random::GetRandomBytes(10000);
+  std::string aad = "some_aad";
+  for (const auto& p : *(saead_set->get_raw_primitives().ValueOrDie())) {
+    auto dec_stream_result = DecryptingRandomAccessStream::New(
+        saead_set, GetCiphertextSource(&(p->get_primitive()), plaintext, aad),
+        aad, options);
+    EXPECT_THAT(dec_stream_result.status(), IsOk());
+    auto dec_stream = std::move(dec_stream_result.ValueOrDie());
+    std::string decrypted;
+    auto status = ReadAll(dec_stream.get(), &decrypted);
+    EXPECT_THAT(status, StatusIs(util::error::OUT_OF_RANGE, HasSubstr("EOF")));
+    EXPECT_EQ(plaintext, decrypted);
+  }
+}
+
+TEST(DecryptingRandomAccessStreamTest, HeaderKeyCache) {
+  auto saead_set = GetTestStreamingAeadSet(
+      {{1234543, "streaming_aead0"}, {726329, "streaming_aead1"},
+       {7213743, "streaming_aead2"}});
+  auto header_key_cache = std::make_shared<HeaderKeyCache>();
+  std::string plaintext = subtle::Random::GetRandomBytes(1000);
+  std::string aad = "some aad";
+
+  int index = 0;
+  for (const auto& p : *(saead_set->get_raw_primitives().ValueOrDie())) {
+    SCOPED_TRACE(absl::StrCat("index = ", index));
+    std::string ct;
+    EXPECT_THAT(
+        ReadAll(
+            GetCiphertextSource(&(p->get_primitive()), plaintext, aad).get(),
+            &ct),
+        StatusIs(util::error::OUT_OF_RANGE));
+    std::string prefix = ct.substr(0, HeaderKeyCache::kPrefixSize);
+    // A wrong hint only costs an additional attempt.
+    header_key_cache->Insert(prefix, (index + 1) % 3);
+
+    for (int i = 0; i < 2; i++) {
+      auto dec_stream_result = DecryptingRandomAccessStream::New(
+          saead_set, GetRandomAccessStream(ct), aad,
+          StreamingAead::RandomAccessOptions(), header_key_cache);
+      ASSERT_THAT(dec_stream_result.status(), IsOk());
+      std::string decrypted;
+      EXPECT_THAT(ReadAll(dec_stream_result.ValueOrDie().get(), &decrypted),
+                  StatusIs(util::error::OUT_OF_RANGE));
+      EXPECT_EQ(plaintext, decrypted);
+      EXPECT_EQ(index, header_key_cache->Lookup(prefix));
+    }
+    index++;
+  }
+}
+
+// A RandomAccessStream that counts the PRead()s of the start of the
+// wrapped stream, i.e. of the header.
+class HeaderReadCountingStream : public RandomAccessStream {
+ public:
+  HeaderReadCountingStream(std::unique_ptr<RandomAccessStream> stream,
+                           std::atomic<int>* header_reads)
+      : stream_(std::move(stream)), header_reads_(header_reads) {}
+
+  util::Status PRead(int64_t position, int count,
+                     util::Buffer* dest_buffer) override {
+    if (position == 0) (*header_reads_)++;
+    return stream_->PRead(position, count, dest_buffer);
+  }
+
+  util::StatusOr<int64_t> size() override { return stream_->size(); }
+
+ private:
+  std::unique_ptr<RandomAccessStream> stream_;
+  std::atomic<int>* header_reads_;
+};
+
+TEST(DecryptingRandomAccessStreamTest, HeaderReadOnceWhileMatching) {
+  auto saead_set = GetTestStreamingAeadSet(
+      {{1234543, "streaming_aead0"}, {726329, "streaming_aead1"},
+       {7213743, "streaming_aead2"}, {8134573, "streaming_aead3"}});
+  std::string plaintext = subtle::Random::GetRandomBytes(1000);
+  std::string aad = "some aad";
+  auto executor = std::make_shared<internal::ThreadPool>(2);
+
+  int index = 0;
+  for (const auto& p : *(saead_set->get_raw_primitives().ValueOrDie())) {
+    for (bool concurrent : {false, true}) {
+      SCOPED_TRACE(absl::StrCat("index = ", index,
+                                ", concurrent = ", concurrent));
+      std::atomic<int> header_reads{0};
+      auto dec_stream_result = DecryptingRandomAccessStream::New(
+          saead_set,
+          absl::make_unique<HeaderReadCountingStream>(
+              GetCiphertextSource(&(p->get_primitive()), plaintext, aad),
+              &header_reads),
+          aad, StreamingAead::RandomAccessOptions(), nullptr,
+          concurrent ? executor : nullptr);
+      ASSERT_THAT(dec_stream_result.status(), IsOk());
+      std::string decrypted;
+      EXPECT_THAT(ReadAll(dec_stream_result.ValueOrDie().get(), &decrypted),
+                  StatusIs(util::error::OUT_OF_RANGE));
+      EXPECT_EQ(plaintext, decrypted);
+      EXPECT_EQ(1, header_reads.load());
+    }
+    index++;
+  }
+}
+
+TEST(DecryptingRandomAccessStreamTest, ConcurrentMatchingWithHeaderKeyCache) {
+  auto saead_set = GetTestStreamingAeadSet(
+      {{1234543, "streaming_aead0"}, {726329, "streaming_aead1"},
+       {7213743, "streaming_aead2"}});
+  auto header_key_cache = std::make_shared<HeaderKeyCache>();
+  auto executor = std::make_shared<internal::ThreadPool>(2);
+  std::string plaintext = subtle::Random::GetRandomBytes(1000);
+  std::string aad = "some aad";
+
+  int index = 0;
+  for (const auto& p : *(saead_set->get_raw_primitives().ValueOrDie())) {
+    SCOPED_TRACE(absl::StrCat("index = ", index));
+    std::string ct;
+    EXPECT_THAT(
+        ReadAll(
+            GetCiphertextSource(&(p->get_primitive()), plaintext, aad).get(),
+            &ct),
+        StatusIs(util::error::OUT_OF_RANGE));
+    for (int i = 0; i < 2; i++) {
+      auto dec_stream_result = DecryptingRandomAccessStream::New(
+          saead_set, GetRandomAccessStream(ct), aad,
+          StreamingAead::RandomAccessOptions(), header_key_cache, executor);
+      ASSERT_THAT(dec_stream_result.status(), IsOk());
+      std::string decrypted;
+      EXPECT_THAT(ReadAll(dec_stream_result.ValueOrDie().get(), &decrypted),
+                  StatusIs(util::error::OUT_OF_RANGE));
+      EXPECT_EQ(plaintext, decrypted);
+      EXPECT_EQ(index, header_key_cache->Lookup(
+                           ct.substr(0, HeaderKeyCache::kPrefixSize)));
+    }
+    index++;
+  }
+
+  // A ciphertext no primitive matches.
+  auto dec_stream_result = DecryptingRandomAccessStream::New(
+      saead_set, GetRandomAccessStream(subtle::Random::GetRandomBytes(100)),
+      aad, StreamingAead::RandomAccessOptions(), header_key_cache, executor);
+  ASSERT_THAT(dec_stream_result.status(), IsOk());
+  std::string decrypted;
+  EXPECT_THAT(ReadAll(dec_stream_result.ValueOrDie().get(), &decrypted),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 TEST(DecryptingRandomAccessStreamTest, SelectiveDecryption) {
   uint32_t key_id_0 = 1234543;
   uint32_t key_id_1 = 726329;
@@ -0,0 +1,56 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/streamingaead/header_key_cache.h"
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+
+namespace crypto {
+namespace tink {
+namespace streamingaead {
+
+absl::optional<int> HeaderKeyCache::Lookup(absl::string_view prefix) const {
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(prefix);
+  if (it == entries_.end()) return absl::nullopt;
+  lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+  return it->second.index;
+}
+
+void HeaderKeyCache::Insert(absl::string_view prefix, int index) {
+  if (max_entries_ <= 0) return;
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(prefix);
+  if (it != entries_.end()) {
+    it->second.index = index;
+    lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+    return;
+  }
+  if (entries_.size() >= max_entries_) {
+    entries_.erase(lru_.back());
+    lru_.pop_back();
+  }
+  lru_.emplace_front(prefix);
+  entries_[lru_.front()] = {index, lru_.begin()};
+}
+
+}  // namespace streamingaead
+}  // namespace tink
+}  // namespace crypto
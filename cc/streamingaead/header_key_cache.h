@@ -0,0 +1,81 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_STREAMINGAEAD_HEADER_KEY_CACHE_H_
+#define TINK_STREAMINGAEAD_HEADER_KEY_CACHE_H_
+
+#include <list>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+
+namespace crypto {
+namespace tink {
+namespace streamingaead {
+
+// Remembers which primitive of a set of StreamingAead-primitives decrypted a
+// ciphertext stream, indexed by the first kPrefixSize bytes of the stream.
+//
+// The header of the streaming AEAD ciphertexts starts with a random salt and
+// nonce prefix, so the prefix identifies a ciphertext, and a stream that is
+// opened again can try the matching primitive first instead of deriving keys
+// for every primitive of the set. A lookup is only a hint: the caller must
+// still fall back to the other primitives if the hinted one fails.
+//
+// This class is thread-safe.
+class HeaderKeyCache {
+ public:
+  // Size of the ciphertext prefix used as index. This is the size of the
+  // smallest header of the supported streaming AEAD formats.
+  static constexpr int kPrefixSize = 24;
+
+  // The least recently used entry is dropped when a new one is added to a
+  // cache with 'max_entries' entries.
+  explicit HeaderKeyCache(int max_entries = 1024)
+      : max_entries_(max_entries) {}
+
+  // Returns the index of the primitive which decrypted the ciphertext that
+  // starts with 'prefix', or absl::nullopt if it is not known.
+  absl::optional<int> Lookup(absl::string_view prefix) const
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Records that the primitive with index 'index' decrypted the ciphertext
+  // that starts with 'prefix'.
+  void Insert(absl::string_view prefix, int index) ABSL_LOCKS_EXCLUDED(mutex_);
+
+ private:
+  struct Entry {
+    int index;
+    std::list<std::string>::iterator lru_position;
+  };
+
+  const int max_entries_;
+  mutable absl::Mutex mutex_;
+  // Entries indexed by ciphertext prefix, with the least recently used one at
+  // the back of 'lru_'.
+  absl::flat_hash_map<std::string, Entry> entries_ ABSL_GUARDED_BY(mutex_);
+  mutable std::list<std::string> lru_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace streamingaead
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_STREAMINGAEAD_HEADER_KEY_CACHE_H_
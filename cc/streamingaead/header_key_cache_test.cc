@@ -0,0 +1,74 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/streamingaead/header_key_cache.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
+
+namespace crypto {
+namespace tink {
+namespace streamingaead {
+namespace {
+
+TEST(HeaderKeyCacheTest, LookupAndInsert) {
+  HeaderKeyCache cache;
+  EXPECT_EQ(absl::nullopt, cache.Lookup("header 1"));
+  cache.Insert("header 1", 3);
+  cache.Insert("header 2", 5);
+  EXPECT_EQ(3, cache.Lookup("header 1"));
+  EXPECT_EQ(5, cache.Lookup("header 2"));
+  cache.Insert("header 1", 7);
+  EXPECT_EQ(7, cache.Lookup("header 1"));
+}
+
+TEST(HeaderKeyCacheTest, DropsLeastRecentlyUsed) {
+  HeaderKeyCache cache(/*max_entries=*/2);
+  cache.Insert("header 1", 1);
+  cache.Insert("header 2", 2);
+  EXPECT_EQ(1, cache.Lookup("header 1"));
+  cache.Insert("header 3", 3);
+  EXPECT_EQ(1, cache.Lookup("header 1"));
+  EXPECT_EQ(absl::nullopt, cache.Lookup("header 2"));
+  EXPECT_EQ(3, cache.Lookup("header 3"));
+}
+
+TEST(HeaderKeyCacheTest, ManyEntries) {
+  HeaderKeyCache cache(/*max_entries=*/100);
+  for (int i = 0; i < 1000; i++) {
+    cache.Insert(absl::StrCat("header ", i), i);
+  }
+  for (int i = 0; i < 900; i++) {
+    EXPECT_EQ(absl::nullopt, cache.Lookup(absl::StrCat("header ", i)));
+  }
+  for (int i = 900; i < 1000; i++) {
+    EXPECT_EQ(i, cache.Lookup(absl::StrCat("header ", i)));
+  }
+}
+
+TEST(HeaderKeyCacheTest, Disabled) {
+  HeaderKeyCache cache(/*max_entries=*/0);
+  cache.Insert("header 1", 1);
+  EXPECT_EQ(absl::nullopt, cache.Lookup("header 1"));
+}
+
+}  // namespace
+}  // namespace streamingaead
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,243 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/streamingaead/kms_envelope_streaming_aead.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/base/internal/endian.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/aead.h"
+#include "tink/input_stream.h"
+#include "tink/output_stream.h"
+#include "tink/random_access_stream.h"
+#include "tink/registry.h"
+#include "tink/streaming_aead.h"
+#include "tink/util/buffer.h"
+#include "tink/util/input_stream_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+const int kEncryptedDekPrefixSize = 4;
+// Encrypted DEKs are at most a few hundred bytes, so a larger size means a
+// corrupted ciphertext.
+const uint32_t kMaxEncryptedDekSize = 64 * 1024;
+const char* kEmptyAssociatedData = "";
+
+// Returns the size of the encrypted DEK given by 'prefix'.
+util::StatusOr<int> GetEncryptedDekSize(absl::string_view prefix) {
+  uint32_t encrypted_dek_size =
+      absl::big_endian::Load32(reinterpret_cast<const uint8_t*>(prefix.data()));
+  if (encrypted_dek_size == 0 || encrypted_dek_size > kMaxEncryptedDekSize) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid ciphertext");
+  }
+  return static_cast<int>(encrypted_dek_size);
+}
+
+// Reads 'count' bytes at 'position' of 'stream'.
+util::StatusOr<std::string> ReadFully(RandomAccessStream* stream,
+                                      int64_t position, int count) {
+  auto buffer_result = util::Buffer::New(count);
+  if (!buffer_result.ok()) return buffer_result.status();
+  util::Buffer* buffer = buffer_result.ValueOrDie().get();
+  std::string bytes;
+  while (bytes.size() < count) {
+    util::Status status =
+        stream->PRead(position + bytes.size(), count - bytes.size(), buffer);
+    bytes.append(buffer->get_mem_block(), buffer->size());
+    if (status.error_code() == util::error::OUT_OF_RANGE) {
+      if (bytes.size() == count) break;
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "ciphertext too short");
+    }
+    if (!status.ok()) return status;
+  }
+  return bytes;
+}
+
+// The part of a RandomAccessStream after its first 'offset' bytes.
+class OffsetRandomAccessStream : public RandomAccessStream {
+ public:
+  OffsetRandomAccessStream(std::unique_ptr<RandomAccessStream> stream,
+                           int64_t offset)
+      : stream_(std::move(stream)), offset_(offset) {}
+
+  util::Status PRead(int64_t position, int count,
+                     util::Buffer* dest_buffer) override {
+    if (position < 0) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "position cannot be negative");
+    }
+    return stream_->PRead(offset_ + position, count, dest_buffer);
+  }
+
+  util::StatusOr<absl::string_view> PReadView(int64_t position,
+                                              int count) override {
+    if (position < 0) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "position cannot be negative");
+    }
+    return stream_->PReadView(offset_ + position, count);
+  }
+
+  util::StatusOr<int64_t> size() override {
+    auto size_result = stream_->size();
+    if (!size_result.ok()) return size_result.status();
+    return std::max<int64_t>(0, size_result.ValueOrDie() - offset_);
+  }
+
+ private:
+  std::unique_ptr<RandomAccessStream> stream_;
+  const int64_t offset_;
+};
+
+}  // namespace
+
+// static
+util::StatusOr<std::unique_ptr<StreamingAead>> KmsEnvelopeStreamingAead::New(
+    const google::crypto::tink::KeyTemplate& dek_template,
+    std::unique_ptr<Aead> remote_aead) {
+  if (remote_aead == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "remote_aead must be non-null");
+  }
+  auto km_result = Registry::get_key_manager<StreamingAead>(
+      dek_template.type_url());
+  if (!km_result.ok()) return km_result.status();
+  std::unique_ptr<StreamingAead> envelope_streaming_aead(
+      new KmsEnvelopeStreamingAead(dek_template, std::move(remote_aead)));
+  return std::move(envelope_streaming_aead);
+}
+
+util::StatusOr<std::unique_ptr<OutputStream>>
+KmsEnvelopeStreamingAead::NewEncryptingStream(
+    std::unique_ptr<OutputStream> ciphertext_destination,
+    absl::string_view associated_data) {
+  if (ciphertext_destination == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "ciphertext_destination must be non-null");
+  }
+  // Create a new DEK for the stream, and wrap it with the KEK.
+  auto dek_result = Registry::NewKeyData(dek_template_);
+  if (!dek_result.ok()) return dek_result.status();
+  auto dek = std::move(dek_result.ValueOrDie());
+  auto streaming_aead_result = Registry::GetPrimitive<StreamingAead>(*dek);
+  if (!streaming_aead_result.ok()) return streaming_aead_result.status();
+  auto encrypted_dek_result =
+      remote_aead_->Encrypt(dek->value(), kEmptyAssociatedData);
+  if (!encrypted_dek_result.ok()) return encrypted_dek_result.status();
+  const std::string& encrypted_dek = encrypted_dek_result.ValueOrDie();
+
+  uint8_t encrypted_dek_size[kEncryptedDekPrefixSize];
+  absl::big_endian::Store32(encrypted_dek_size, encrypted_dek.size());
+  auto status = ciphertext_destination->WriteFrom(encrypted_dek_size);
+  if (!status.ok()) return status;
+  status = ciphertext_destination->WriteFrom(absl::MakeConstSpan(
+      reinterpret_cast<const uint8_t*>(encrypted_dek.data()),
+      encrypted_dek.size()));
+  if (!status.ok()) return status;
+  return streaming_aead_result.ValueOrDie()->NewEncryptingStream(
+      std::move(ciphertext_destination), associated_data);
+}
+
+util::StatusOr<std::unique_ptr<InputStream>>
+KmsEnvelopeStreamingAead::NewDecryptingStream(
+    std::unique_ptr<InputStream> ciphertext_source,
+    absl::string_view associated_data) {
+  if (ciphertext_source == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "ciphertext_source must be non-null");
+  }
+  auto prefix_result =
+      ReadBytesFromStream(kEncryptedDekPrefixSize, ciphertext_source.get());
+  if (!prefix_result.ok()) return prefix_result.status();
+  auto size_result = GetEncryptedDekSize(prefix_result.ValueOrDie());
+  if (!size_result.ok()) return size_result.status();
+  auto encrypted_dek_result =
+      ReadBytesFromStream(size_result.ValueOrDie(), ciphertext_source.get());
+  if (!encrypted_dek_result.ok()) return encrypted_dek_result.status();
+  auto streaming_aead_result = UnwrapDek(encrypted_dek_result.ValueOrDie());
+  if (!streaming_aead_result.ok()) return streaming_aead_result.status();
+  return streaming_aead_result.ValueOrDie()->NewDecryptingStream(
+      std::move(ciphertext_source), associated_data);
+}
+
+util::StatusOr<std::unique_ptr<RandomAccessStream>>
+KmsEnvelopeStreamingAead::NewDecryptingRandomAccessStream(
+    std::unique_ptr<RandomAccessStream> ciphertext_source,
+    absl::string_view associated_data) {
+  return NewDecryptingRandomAccessStream(std::move(ciphertext_source),
+                                         associated_data,
+                                         RandomAccessOptions());
+}
+
+util::StatusOr<std::unique_ptr<RandomAccessStream>>
+KmsEnvelopeStreamingAead::NewDecryptingRandomAccessStream(
+    std::unique_ptr<RandomAccessStream> ciphertext_source,
+    absl::string_view associated_data, const RandomAccessOptions& options) {
+  if (ciphertext_source == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "ciphertext_source must be non-null");
+  }
+  auto prefix_result =
+      ReadFully(ciphertext_source.get(), 0, kEncryptedDekPrefixSize);
+  if (!prefix_result.ok()) return prefix_result.status();
+  auto size_result = GetEncryptedDekSize(prefix_result.ValueOrDie());
+  if (!size_result.ok()) return size_result.status();
+  int encrypted_dek_size = size_result.ValueOrDie();
+  auto encrypted_dek_result = ReadFully(
+      ciphertext_source.get(), kEncryptedDekPrefixSize, encrypted_dek_size);
+  if (!encrypted_dek_result.ok()) return encrypted_dek_result.status();
+  auto streaming_aead_result = UnwrapDek(encrypted_dek_result.ValueOrDie());
+  if (!streaming_aead_result.ok()) return streaming_aead_result.status();
+  return streaming_aead_result.ValueOrDie()->NewDecryptingRandomAccessStream(
+      absl::make_unique<OffsetRandomAccessStream>(
+          std::move(ciphertext_source),
+          kEncryptedDekPrefixSize + encrypted_dek_size),
+      associated_data, options);
+}
+
+util::StatusOr<std::unique_ptr<StreamingAead>>
+KmsEnvelopeStreamingAead::UnwrapDek(absl::string_view encrypted_dek) const {
+  auto dek_result = remote_aead_->Decrypt(encrypted_dek, kEmptyAssociatedData);
+  if (!dek_result.ok()) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("invalid ciphertext: ",
+                     dek_result.status().error_message()));
+  }
+  google::crypto::tink::KeyData key_data;
+  key_data.set_type_url(dek_template_.type_url());
+  key_data.set_value(dek_result.ValueOrDie());
+  key_data.set_key_material_type(google::crypto::tink::KeyData::SYMMETRIC);
+  return Registry::GetPrimitive<StreamingAead>(key_data);
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,98 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_STREAMINGAEAD_KMS_ENVELOPE_STREAMING_AEAD_H_
+#define TINK_STREAMINGAEAD_KMS_ENVELOPE_STREAMING_AEAD_H_
+
+#include <memory>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/input_stream.h"
+#include "tink/output_stream.h"
+#include "tink/random_access_stream.h"
+#include "tink/streaming_aead.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// A StreamingAead for envelope encryption of large objects: each stream is
+// encrypted with a new data encryption key (DEK), created from a streaming
+// key template, e.g. of AesGcmHkdfStreamingKey, and wrapped with a remote
+// key encryption key (KEK) in a KMS, accessed via 'remote_aead'.  So there
+// is one KMS call per stream, and objects of any size are encrypted and
+// decrypted with the memory of the DEK's segments.
+//
+// The ciphertext format is the one of KmsEnvelopeAead, with the DEK's
+// ciphertext stream as payload:
+//   4-byte-prefix | encrypted_dek | dek_ciphertext_stream
+// where 4-byte-prefix is the length of encrypted_dek in big-endian format.
+//
+// The streams returned by NewDecryptingStream() and
+// NewDecryptingRandomAccessStream() read the encrypted DEK and unwrap it
+// when they are created.
+class KmsEnvelopeStreamingAead : public StreamingAead {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<StreamingAead>> New(
+      const google::crypto::tink::KeyTemplate& dek_template,
+      std::unique_ptr<Aead> remote_aead);
+
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+  NewEncryptingStream(
+      std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+      absl::string_view associated_data) override;
+
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
+  NewDecryptingStream(
+      std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
+      absl::string_view associated_data) override;
+
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<crypto::tink::RandomAccessStream>>
+  NewDecryptingRandomAccessStream(
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view associated_data) override;
+
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<crypto::tink::RandomAccessStream>>
+  NewDecryptingRandomAccessStream(
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view associated_data,
+      const RandomAccessOptions& options) override;
+
+  ~KmsEnvelopeStreamingAead() override {}
+
+ private:
+  KmsEnvelopeStreamingAead(
+      const google::crypto::tink::KeyTemplate& dek_template,
+      std::unique_ptr<Aead> remote_aead)
+      : dek_template_(dek_template), remote_aead_(std::move(remote_aead)) {}
+
+  // Returns the StreamingAead of the DEK wrapped in 'encrypted_dek'.
+  crypto::tink::util::StatusOr<std::unique_ptr<StreamingAead>> UnwrapDek(
+      absl::string_view encrypted_dek) const;
+
+  google::crypto::tink::KeyTemplate dek_template_;
+  std::unique_ptr<Aead> remote_aead_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_STREAMINGAEAD_KMS_ENVELOPE_STREAMING_AEAD_H_
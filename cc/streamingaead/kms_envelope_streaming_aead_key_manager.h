@@ -0,0 +1,102 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_STREAMINGAEAD_KMS_ENVELOPE_STREAMING_AEAD_KEY_MANAGER_H_
+#define TINK_STREAMINGAEAD_KMS_ENVELOPE_STREAMING_AEAD_KEY_MANAGER_H_
+
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/core/key_type_manager.h"
+#include "tink/key_manager.h"
+#include "tink/streaming_aead.h"
+#include "tink/util/constants.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/kms_envelope.pb.h"
+
+namespace crypto {
+namespace tink {
+
+class KmsEnvelopeStreamingAeadKeyManager
+    : public KeyTypeManager<
+          google::crypto::tink::KmsEnvelopeStreamingAeadKey,
+          google::crypto::tink::KmsEnvelopeStreamingAeadKeyFormat,
+          List<StreamingAead>> {
+ public:
+  class StreamingAeadFactory : public PrimitiveFactory<StreamingAead> {
+    crypto::tink::util::StatusOr<std::unique_ptr<StreamingAead>> Create(
+        const google::crypto::tink::KmsEnvelopeStreamingAeadKey& key)
+        const override;
+  };
+
+  KmsEnvelopeStreamingAeadKeyManager()
+      : KeyTypeManager(absl::make_unique<StreamingAeadFactory>()) {}
+
+  uint32_t get_version() const override { return 0; }
+
+  google::crypto::tink::KeyData::KeyMaterialType key_material_type()
+      const override {
+    return google::crypto::tink::KeyData::REMOTE;
+  }
+
+  const std::string& get_key_type() const override { return key_type_; }
+
+  crypto::tink::util::Status ValidateKey(
+      const google::crypto::tink::KmsEnvelopeStreamingAeadKey& key)
+      const override {
+    crypto::tink::util::Status status =
+        ValidateVersion(key.version(), get_version());
+    if (!status.ok()) return status;
+    return ValidateKeyFormat(key.params());
+  }
+
+  crypto::tink::util::Status ValidateKeyFormat(
+      const google::crypto::tink::KmsEnvelopeStreamingAeadKeyFormat& format)
+      const override {
+    if (format.kek_uri().empty()) {
+      return crypto::tink::util::Status(util::error::INVALID_ARGUMENT,
+                                        "Missing kek_uri.");
+    }
+    return util::OkStatus();
+  }
+
+  crypto::tink::util::StatusOr<
+      google::crypto::tink::KmsEnvelopeStreamingAeadKey>
+  CreateKey(const google::crypto::tink::KmsEnvelopeStreamingAeadKeyFormat&
+                key_format) const override {
+    google::crypto::tink::KmsEnvelopeStreamingAeadKey key;
+    key.set_version(get_version());
+    *(key.mutable_params()) = key_format;
+    return key;
+  }
+
+  FipsCompatibility FipsStatus() const override {
+    return FipsCompatibility::kNotFips;
+  }
+
+ private:
+  const std::string key_type_ = absl::StrCat(
+      kTypeGoogleapisCom,
+      google::crypto::tink::KmsEnvelopeStreamingAeadKey().GetTypeName());
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_STREAMINGAEAD_KMS_ENVELOPE_STREAMING_AEAD_KEY_MANAGER_H_
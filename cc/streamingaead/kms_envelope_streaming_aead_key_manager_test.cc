@@ -0,0 +1,138 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/streamingaead/kms_envelope_streaming_aead_key_manager.h"
+
+#include <memory>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "tink/kms_clients.h"
+#include "tink/registry.h"
+#include "tink/streaming_aead.h"
+#include "tink/streamingaead/aes_gcm_hkdf_streaming_key_manager.h"
+#include "tink/streamingaead/kms_envelope_streaming_aead.h"
+#include "tink/streamingaead/streaming_aead_key_templates.h"
+#include "tink/subtle/streaming_aead_test_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+#include "proto/kms_envelope.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::DummyAead;
+using ::crypto::tink::test::DummyKmsClient;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::google::crypto::tink::KmsEnvelopeStreamingAeadKey;
+using ::google::crypto::tink::KmsEnvelopeStreamingAeadKeyFormat;
+using ::testing::Eq;
+using ::testing::Not;
+
+TEST(KmsEnvelopeStreamingAeadKeyManagerTest, Basics) {
+  EXPECT_THAT(KmsEnvelopeStreamingAeadKeyManager().get_version(), Eq(0));
+  EXPECT_THAT(
+      KmsEnvelopeStreamingAeadKeyManager().get_key_type(),
+      Eq("type.googleapis.com/google.crypto.tink.KmsEnvelopeStreamingAeadKey"));
+  EXPECT_THAT(KmsEnvelopeStreamingAeadKeyManager().key_material_type(),
+              Eq(google::crypto::tink::KeyData::REMOTE));
+}
+
+TEST(KmsEnvelopeStreamingAeadKeyManagerTest, ValidateKey) {
+  KmsEnvelopeStreamingAeadKey key;
+  EXPECT_THAT(KmsEnvelopeStreamingAeadKeyManager().ValidateKey(key),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  key.mutable_params()->set_kek_uri("Some uri");
+  *(key.mutable_params()->mutable_dek_template()) =
+      StreamingAeadKeyTemplates::Aes128GcmHkdf4KB();
+  EXPECT_THAT(KmsEnvelopeStreamingAeadKeyManager().ValidateKey(key), IsOk());
+  key.set_version(1);
+  EXPECT_THAT(KmsEnvelopeStreamingAeadKeyManager().ValidateKey(key),
+              Not(IsOk()));
+}
+
+TEST(KmsEnvelopeStreamingAeadKeyManagerTest, CreateKey) {
+  KmsEnvelopeStreamingAeadKeyFormat key_format;
+  key_format.set_kek_uri("Some uri");
+  *key_format.mutable_dek_template() =
+      StreamingAeadKeyTemplates::Aes128GcmHkdf4KB();
+  auto key_or = KmsEnvelopeStreamingAeadKeyManager().CreateKey(key_format);
+  ASSERT_THAT(key_or.status(), IsOk());
+  EXPECT_THAT(key_or.ValueOrDie().params().kek_uri(),
+              Eq(key_format.kek_uri()));
+  EXPECT_THAT(key_or.ValueOrDie().params().dek_template().value(),
+              Eq(key_format.dek_template().value()));
+}
+
+class KmsEnvelopeStreamingAeadKeyManagerCreateTest : public ::testing::Test {
+ public:
+  // The KmsClients class has a global variable which keeps the registered
+  // clients, so they are set up once for the test suite.
+  static void SetUpTestSuite() {
+    if (!KmsClients::Add(absl::make_unique<DummyKmsClient>(
+                             "prefix1", "prefix1:some_key1"))
+             .ok())
+      abort();
+    if (!Registry::RegisterKeyTypeManager(
+             absl::make_unique<AesGcmHkdfStreamingKeyManager>(), true)
+             .ok())
+      abort();
+  }
+};
+
+TEST_F(KmsEnvelopeStreamingAeadKeyManagerCreateTest, CreateStreamingAead) {
+  KmsEnvelopeStreamingAeadKey key;
+  key.mutable_params()->set_kek_uri("prefix1:some_key1");
+  *(key.mutable_params()->mutable_dek_template()) =
+      StreamingAeadKeyTemplates::Aes128GcmHkdf4KB();
+
+  auto kms_streaming_aead =
+      KmsEnvelopeStreamingAeadKeyManager().GetPrimitive<StreamingAead>(key);
+  ASSERT_THAT(kms_streaming_aead.status(), IsOk());
+
+  auto direct_streaming_aead = KmsEnvelopeStreamingAead::New(
+      key.params().dek_template(),
+      absl::make_unique<DummyAead>("prefix1:some_key1"));
+  ASSERT_THAT(direct_streaming_aead.status(), IsOk());
+
+  EXPECT_THAT(EncryptThenDecrypt(kms_streaming_aead.ValueOrDie().get(),
+                                 direct_streaming_aead.ValueOrDie().get(),
+                                 "plaintext", "aad",
+                                 /*ciphertext_offset=*/0),
+              IsOk());
+}
+
+TEST_F(KmsEnvelopeStreamingAeadKeyManagerCreateTest, CreateWithWrongKek) {
+  KmsEnvelopeStreamingAeadKey key;
+  key.mutable_params()->set_kek_uri("prefix1:some_other_key");
+  *(key.mutable_params()->mutable_dek_template()) =
+      StreamingAeadKeyTemplates::Aes128GcmHkdf4KB();
+  EXPECT_THAT(KmsEnvelopeStreamingAeadKeyManager()
+                  .GetPrimitive<StreamingAead>(key)
+                  .status(),
+              Not(IsOk()));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,177 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/streamingaead/kms_envelope_streaming_aead.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/base/internal/endian.h"
+#include "absl/memory/memory.h"
+#include "tink/registry.h"
+#include "tink/streaming_aead.h"
+#include "tink/streamingaead/aes_gcm_hkdf_streaming_key_manager.h"
+#include "tink/streamingaead/streaming_aead_key_templates.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/streaming_aead_test_util.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/ostream_output_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::DummyAead;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Not;
+
+class KmsEnvelopeStreamingAeadTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    Registry::Reset();
+    ASSERT_THAT(Registry::RegisterKeyTypeManager(
+                    absl::make_unique<AesGcmHkdfStreamingKeyManager>(), true),
+                IsOk());
+  }
+
+  void TearDown() override { Registry::Reset(); }
+
+  static std::unique_ptr<StreamingAead> NewStreamingAead(
+      absl::string_view kek_name) {
+    auto result = KmsEnvelopeStreamingAead::New(
+        StreamingAeadKeyTemplates::Aes128GcmHkdf4KB(),
+        absl::make_unique<DummyAead>(kek_name));
+    EXPECT_THAT(result.status(), IsOk());
+    return std::move(result.ValueOrDie());
+  }
+
+  // Returns the ciphertext of 'plaintext' encrypted with 'streaming_aead'.
+  static std::string Encrypt(StreamingAead* streaming_aead,
+                             absl::string_view plaintext,
+                             absl::string_view associated_data) {
+    auto ciphertext_stream = absl::make_unique<std::stringstream>();
+    std::stringstream* ciphertext = ciphertext_stream.get();
+    auto encrypting_stream_result = streaming_aead->NewEncryptingStream(
+        absl::make_unique<util::OstreamOutputStream>(
+            std::move(ciphertext_stream)),
+        associated_data);
+    EXPECT_THAT(encrypting_stream_result.status(), IsOk());
+    EXPECT_THAT(subtle::test::WriteToStream(
+                    encrypting_stream_result.ValueOrDie().get(), plaintext),
+                IsOk());
+    return ciphertext->str();
+  }
+
+  // Decrypts 'ciphertext' with 'streaming_aead' through a decrypting
+  // stream.
+  static util::StatusOr<std::string> Decrypt(
+      StreamingAead* streaming_aead, absl::string_view ciphertext,
+      absl::string_view associated_data) {
+    auto decrypting_stream_result = streaming_aead->NewDecryptingStream(
+        absl::make_unique<util::IstreamInputStream>(
+            absl::make_unique<std::stringstream>(std::string(ciphertext))),
+        associated_data);
+    if (!decrypting_stream_result.ok()) {
+      return decrypting_stream_result.status();
+    }
+    std::string plaintext;
+    auto status = subtle::test::ReadFromStream(
+        decrypting_stream_result.ValueOrDie().get(), &plaintext);
+    if (!status.ok()) return status;
+    return plaintext;
+  }
+};
+
+TEST_F(KmsEnvelopeStreamingAeadTest, EncryptThenDecrypt) {
+  auto streaming_aead = NewStreamingAead("kek");
+  for (int size : {0, 1, 4000, 100000}) {
+    SCOPED_TRACE(size);
+    std::string plaintext = subtle::Random::GetRandomBytes(size);
+    EXPECT_THAT(EncryptThenDecrypt(streaming_aead.get(), streaming_aead.get(),
+                                   plaintext, "associated data",
+                                   /*ciphertext_offset=*/0),
+                IsOk());
+  }
+}
+
+TEST_F(KmsEnvelopeStreamingAeadTest, CiphertextStartsWithEncryptedDek) {
+  auto streaming_aead = NewStreamingAead("kek");
+  std::string ciphertext = Encrypt(streaming_aead.get(), "plaintext", "ad");
+  ASSERT_GT(ciphertext.size(), 4);
+  uint32_t encrypted_dek_size = absl::big_endian::Load32(
+      reinterpret_cast<const uint8_t*>(ciphertext.data()));
+  ASSERT_LT(encrypted_dek_size, ciphertext.size() - 4);
+  std::string encrypted_dek = ciphertext.substr(4, encrypted_dek_size);
+  EXPECT_THAT(DummyAead("kek").Decrypt(encrypted_dek, "").status(), IsOk());
+
+  // Each stream has its own DEK.
+  EXPECT_NE(ciphertext.substr(4, encrypted_dek_size),
+            Encrypt(streaming_aead.get(), "plaintext", "ad")
+                .substr(4, encrypted_dek_size));
+}
+
+TEST_F(KmsEnvelopeStreamingAeadTest, DecryptionFailures) {
+  auto streaming_aead = NewStreamingAead("kek");
+  std::string ciphertext = Encrypt(streaming_aead.get(), "plaintext", "ad");
+  auto decrypt_result = Decrypt(streaming_aead.get(), ciphertext, "ad");
+  ASSERT_THAT(decrypt_result.status(), IsOk());
+  EXPECT_EQ("plaintext", decrypt_result.ValueOrDie());
+
+  EXPECT_THAT(Decrypt(streaming_aead.get(), ciphertext, "other ad").status(),
+              Not(IsOk()));
+  EXPECT_THAT(
+      Decrypt(NewStreamingAead("other kek").get(), ciphertext, "ad").status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(Decrypt(streaming_aead.get(), ciphertext.substr(0, 3), "ad")
+                  .status(),
+              Not(IsOk()));
+  std::string corrupted = ciphertext;
+  corrupted[0] ^= 1;
+  EXPECT_THAT(Decrypt(streaming_aead.get(), corrupted, "ad").status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  corrupted = ciphertext;
+  corrupted[ciphertext.size() - 1] ^= 1;
+  EXPECT_THAT(Decrypt(streaming_aead.get(), corrupted, "ad").status(),
+              Not(IsOk()));
+}
+
+TEST_F(KmsEnvelopeStreamingAeadTest, InvalidArguments) {
+  EXPECT_THAT(KmsEnvelopeStreamingAead::New(
+                  StreamingAeadKeyTemplates::Aes128GcmHkdf4KB(), nullptr)
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  google::crypto::tink::KeyTemplate dek_template;
+  dek_template.set_type_url("unknown type url");
+  EXPECT_THAT(KmsEnvelopeStreamingAead::New(
+                  dek_template, absl::make_unique<DummyAead>("kek"))
+                  .status(),
+              Not(IsOk()));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
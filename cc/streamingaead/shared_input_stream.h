@@ -17,6 +17,7 @@
 #ifndef TINK_STREAMINGAEAD_SHARED_INPUT_STREAM_H_
 #define TINK_STREAMINGAEAD_SHARED_INPUT_STREAM_H_
 
+#include "absl/types/span.h"
 #include "tink/input_stream.h"
 #include "tink/util/statusor.h"
 
@@ -49,6 +50,11 @@ class SharedInputStream : public crypto::tink::InputStream {
     return input_stream_->Position();
   }
 
+  crypto::tink::util::StatusOr<int> ReadInto(
+      absl::Span<uint8_t> buffer) override {
+    return input_stream_->ReadInto(buffer);
+  }
+
  private:
   crypto::tink::InputStream* input_stream_;
 };
@@ -17,6 +17,7 @@
 #ifndef TINK_STREAMINGAEAD_SHARED_RANDOM_ACCESS_STREAM_H_
 #define TINK_STREAMINGAEAD_SHARED_RANDOM_ACCESS_STREAM_H_
 
+#include "absl/strings/string_view.h"
 #include "tink/random_access_stream.h"
 #include "tink/util/buffer.h"
 #include "tink/util/status.h"
@@ -46,6 +47,11 @@ class SharedRandomAccessStream : public crypto::tink::RandomAccessStream {
     return random_access_stream_->PRead(position, count, dest_buffer);
   }
 
+  crypto::tink::util::StatusOr<absl::string_view> PReadView(
+      int64_t position, int count) override {
+    return random_access_stream_->PReadView(position, count);
+  }
+
   crypto::tink::util::StatusOr<int64_t> size() override {
     return random_access_stream_->size();
   }
@@ -22,6 +22,8 @@
 #include "tink/registry.h"
 #include "tink/streamingaead/aes_ctr_hmac_streaming_key_manager.h"
 #include "tink/streamingaead/aes_gcm_hkdf_streaming_key_manager.h"
+#include "tink/streamingaead/chacha20_poly1305_hkdf_streaming_key_manager.h"
+#include "tink/streamingaead/kms_envelope_streaming_aead_key_manager.h"
 #include "tink/streamingaead/streaming_aead_wrapper.h"
 #include "tink/util/status.h"
 
@@ -56,6 +58,14 @@ util::Status StreamingAeadConfig::Register() {
       absl::make_unique<AesCtrHmacStreamingKeyManager>(), true);
   if (!status.ok()) return status;
 
+  status = Registry::RegisterKeyTypeManager(
+      absl::make_unique<ChaCha20Poly1305HkdfStreamingKeyManager>(), true);
+  if (!status.ok()) return status;
+
+  status = Registry::RegisterKeyTypeManager(
+      absl::make_unique<KmsEnvelopeStreamingAeadKeyManager>(), true);
+  if (!status.ok()) return status;
+
   return util::OkStatus();
 }
 
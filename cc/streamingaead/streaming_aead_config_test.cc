@@ -29,6 +29,7 @@
 #include "tink/streaming_aead.h"
 #include "tink/streamingaead/aes_ctr_hmac_streaming_key_manager.h"
 #include "tink/streamingaead/aes_gcm_hkdf_streaming_key_manager.h"
+#include "tink/streamingaead/chacha20_poly1305_hkdf_streaming_key_manager.h"
 #include "tink/streamingaead/streaming_aead_key_templates.h"
 #include "tink/util/status.h"
 #include "tink/util/test_matchers.h"
@@ -60,6 +61,10 @@ TEST_F(StreamingAeadConfigTest, Basic) {
                   AesCtrHmacStreamingKeyManager().get_key_type())
                   .status(),
               StatusIs(util::error::NOT_FOUND));
+  EXPECT_THAT(Registry::get_key_manager<StreamingAead>(
+                  ChaCha20Poly1305HkdfStreamingKeyManager().get_key_type())
+                  .status(),
+              StatusIs(util::error::NOT_FOUND));
   EXPECT_THAT(StreamingAeadConfig::Register(), IsOk());
   EXPECT_THAT(Registry::get_key_manager<StreamingAead>(
                   AesGcmHkdfStreamingKeyManager().get_key_type())
@@ -69,6 +74,10 @@ TEST_F(StreamingAeadConfigTest, Basic) {
                   AesCtrHmacStreamingKeyManager().get_key_type())
                   .status(),
               IsOk());
+  EXPECT_THAT(Registry::get_key_manager<StreamingAead>(
+                  ChaCha20Poly1305HkdfStreamingKeyManager().get_key_type())
+                  .status(),
+              IsOk());
 }
 
 // Tests that the StreamingAeadWrapper has been properly registered
@@ -117,6 +126,10 @@ TEST_F(StreamingAeadConfigTest, RegisterNonFipsTemplates) {
       StreamingAeadKeyTemplates::Aes256GcmHkdf1MB());
   non_fips_key_templates.push_back(
       StreamingAeadKeyTemplates::Aes256GcmHkdf4KB());
+  non_fips_key_templates.push_back(
+      StreamingAeadKeyTemplates::ChaCha20Poly1305HkdfSha256Segment4KB());
+  non_fips_key_templates.push_back(
+      StreamingAeadKeyTemplates::ChaCha20Poly1305HkdfSha256Segment1MB());
 
   for (auto key_template : non_fips_key_templates) {
     EXPECT_THAT(KeysetHandle::GenerateNew(key_template).status(),
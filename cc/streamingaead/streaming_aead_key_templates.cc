@@ -16,15 +16,21 @@
 
 #include "tink/streamingaead/streaming_aead_key_templates.h"
 
+#include <string>
+
 #include "proto/aes_ctr_hmac_streaming.pb.h"
 #include "proto/aes_gcm_hkdf_streaming.pb.h"
+#include "proto/chacha20_poly1305_hkdf_streaming.pb.h"
 #include "proto/common.pb.h"
+#include "proto/kms_envelope.pb.h"
 #include "proto/tink.pb.h"
 
 using google::crypto::tink::AesCtrHmacStreamingKeyFormat;
 using google::crypto::tink::AesGcmHkdfStreamingKeyFormat;
+using google::crypto::tink::ChaCha20Poly1305HkdfStreamingKeyFormat;
 using google::crypto::tink::HashType;
 using google::crypto::tink::KeyTemplate;
+using google::crypto::tink::KmsEnvelopeStreamingAeadKeyFormat;
 using google::crypto::tink::OutputPrefixType;
 
 namespace crypto {
@@ -66,6 +72,22 @@ KeyTemplate* NewAesCtrHmacStreamingKeyTemplate(int ikm_size_in_bytes) {
   return key_template;
 }
 
+KeyTemplate* NewChaCha20Poly1305HkdfStreamingKeyTemplate(
+    int segment_size_in_bytes) {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/"
+      "google.crypto.tink.ChaCha20Poly1305HkdfStreamingKey");
+  key_template->set_output_prefix_type(OutputPrefixType::RAW);
+  ChaCha20Poly1305HkdfStreamingKeyFormat key_format;
+  key_format.set_key_size(32);
+  auto params = key_format.mutable_params();
+  params->set_ciphertext_segment_size(segment_size_in_bytes);
+  params->set_hkdf_hash_type(HashType::SHA256);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
 }  // anonymous namespace
 
 // static
@@ -103,5 +125,37 @@ const KeyTemplate& StreamingAeadKeyTemplates::Aes256CtrHmacSha256Segment4KB() {
   return *key_template;
 }
 
+// static
+const KeyTemplate&
+StreamingAeadKeyTemplates::ChaCha20Poly1305HkdfSha256Segment4KB() {
+  static const KeyTemplate* key_template =
+      NewChaCha20Poly1305HkdfStreamingKeyTemplate(
+          /* segment_size_in_bytes= */ 4096);
+  return *key_template;
+}
+
+// static
+const KeyTemplate&
+StreamingAeadKeyTemplates::ChaCha20Poly1305HkdfSha256Segment1MB() {
+  static const KeyTemplate* key_template =
+      NewChaCha20Poly1305HkdfStreamingKeyTemplate(
+          /* segment_size_in_bytes= */ 1048576);
+  return *key_template;
+}
+
+// static
+KeyTemplate StreamingAeadKeyTemplates::KmsEnvelopeStreamingAead(
+    absl::string_view kek_uri, const KeyTemplate& dek_template) {
+  KeyTemplate key_template;
+  key_template.set_type_url(
+      "type.googleapis.com/google.crypto.tink.KmsEnvelopeStreamingAeadKey");
+  key_template.set_output_prefix_type(OutputPrefixType::RAW);
+  KmsEnvelopeStreamingAeadKeyFormat key_format;
+  key_format.set_kek_uri(std::string(kek_uri));
+  key_format.mutable_dek_template()->MergeFrom(dek_template);
+  key_format.SerializeToString(key_template.mutable_value());
+  return key_template;
+}
+
 }  // namespace tink
 }  // namespace crypto
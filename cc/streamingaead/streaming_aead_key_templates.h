@@ -17,6 +17,7 @@
 #ifndef TINK_STREAMINGAEAD_STREAMING_AEAD_KEY_TEMPLATES_H_
 #define TINK_STREAMINGAEAD_STREAMING_AEAD_KEY_TEMPLATES_H_
 
+#include "absl/strings/string_view.h"
 #include "proto/tink.pb.h"
 
 namespace crypto {
@@ -85,6 +86,36 @@ class StreamingAeadKeyTemplates {
   //   - OutputPrefixType: RAW
   static const google::crypto::tink::KeyTemplate&
   Aes256CtrHmacSha256Segment4KB();
+
+  // Returns a KeyTemplate that generates new instances of
+  // ChaCha20Poly1305HkdfStreamingKey with the following parameters:
+  //   - main key (ikm) size: 32 bytes
+  //   - HKDF algorithm: HMAC-SHA256
+  //   - ciphertext segment size: 4096 bytes
+  //   - OutputPrefixType: RAW
+  static const google::crypto::tink::KeyTemplate&
+  ChaCha20Poly1305HkdfSha256Segment4KB();
+
+  // Returns a KeyTemplate that generates new instances of
+  // ChaCha20Poly1305HkdfStreamingKey with the following parameters:
+  //   - main key (ikm) size: 32 bytes
+  //   - HKDF algorithm: HMAC-SHA256
+  //   - ciphertext segment size: 1048576 bytes (1 MB)
+  //   - OutputPrefixType: RAW
+  static const google::crypto::tink::KeyTemplate&
+  ChaCha20Poly1305HkdfSha256Segment1MB();
+
+  // Returns a KeyTemplate that generates new instances of
+  // KmsEnvelopeStreamingAeadKey with the following parameters:
+  //   - KEK is pointing to kek_uri
+  //   - DEK template is dek_template, a streaming key template such as
+  //     Aes256GcmHkdf1MB()
+  //   - OutputPrefixType: RAW
+  // Like for AeadKeyTemplates::KmsEnvelopeAead(), the generated keys hold no
+  // key material, only a reference to the remote KEK.
+  static google::crypto::tink::KeyTemplate KmsEnvelopeStreamingAead(
+      absl::string_view kek_uri,
+      const google::crypto::tink::KeyTemplate& dek_template);
 };
 
 }  // namespace tink
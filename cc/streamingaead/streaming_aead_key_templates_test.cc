@@ -20,16 +20,22 @@
 #include "gtest/gtest.h"
 #include "tink/streamingaead/aes_ctr_hmac_streaming_key_manager.h"
 #include "tink/streamingaead/aes_gcm_hkdf_streaming_key_manager.h"
+#include "tink/streamingaead/chacha20_poly1305_hkdf_streaming_key_manager.h"
+#include "tink/streamingaead/kms_envelope_streaming_aead_key_manager.h"
 #include "tink/util/test_matchers.h"
 #include "proto/aes_ctr_hmac_streaming.pb.h"
 #include "proto/aes_gcm_hkdf_streaming.pb.h"
+#include "proto/chacha20_poly1305_hkdf_streaming.pb.h"
 #include "proto/common.pb.h"
+#include "proto/kms_envelope.pb.h"
 #include "proto/tink.pb.h"
 
 using google::crypto::tink::AesCtrHmacStreamingKeyFormat;
 using google::crypto::tink::AesGcmHkdfStreamingKeyFormat;
+using google::crypto::tink::ChaCha20Poly1305HkdfStreamingKeyFormat;
 using google::crypto::tink::HashType;
 using google::crypto::tink::KeyTemplate;
+using google::crypto::tink::KmsEnvelopeStreamingAeadKeyFormat;
 using google::crypto::tink::OutputPrefixType;
 
 namespace crypto {
@@ -246,6 +252,114 @@ TEST(Aes256CtrHmacSha256Segment4KBTest, CheckValues) {
   EXPECT_THAT(key_format.params().hmac_params().tag_size(), Eq(32));
 }
 
+TEST(ChaCha20Poly1305HkdfSha256Segment4KBTest, TypeUrl) {
+  const KeyTemplate& key_template =
+      StreamingAeadKeyTemplates::ChaCha20Poly1305HkdfSha256Segment4KB();
+  EXPECT_THAT(key_template.type_url(),
+              Eq("type.googleapis.com/"
+                 "google.crypto.tink.ChaCha20Poly1305HkdfStreamingKey"));
+  EXPECT_THAT(key_template.type_url(),
+              Eq(ChaCha20Poly1305HkdfStreamingKeyManager().get_key_type()));
+}
+
+TEST(ChaCha20Poly1305HkdfSha256Segment4KBTest, OutputPrefixType) {
+  EXPECT_THAT(
+      StreamingAeadKeyTemplates::ChaCha20Poly1305HkdfSha256Segment4KB()
+          .output_prefix_type(),
+      Eq(OutputPrefixType::RAW));
+}
+
+TEST(ChaCha20Poly1305HkdfSha256Segment4KBTest, SameReference) {
+  // Check that reference to the same object is returned.
+  EXPECT_THAT(
+      StreamingAeadKeyTemplates::ChaCha20Poly1305HkdfSha256Segment4KB(),
+      Ref(StreamingAeadKeyTemplates::ChaCha20Poly1305HkdfSha256Segment4KB()));
+}
+
+TEST(ChaCha20Poly1305HkdfSha256Segment4KBTest, WorksWithKeyTypeManager) {
+  const KeyTemplate& key_template =
+      StreamingAeadKeyTemplates::ChaCha20Poly1305HkdfSha256Segment4KB();
+  ChaCha20Poly1305HkdfStreamingKeyFormat key_format;
+  EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+  EXPECT_THAT(
+      ChaCha20Poly1305HkdfStreamingKeyManager().ValidateKeyFormat(key_format),
+      IsOk());
+}
+
+TEST(ChaCha20Poly1305HkdfSha256Segment4KBTest, CheckValues) {
+  const KeyTemplate& key_template =
+      StreamingAeadKeyTemplates::ChaCha20Poly1305HkdfSha256Segment4KB();
+  ChaCha20Poly1305HkdfStreamingKeyFormat key_format;
+  EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+  EXPECT_THAT(key_format.key_size(), Eq(32));
+  EXPECT_THAT(key_format.params().ciphertext_segment_size(), Eq(4096));
+  EXPECT_THAT(key_format.params().hkdf_hash_type(), Eq(HashType::SHA256));
+}
+
+TEST(ChaCha20Poly1305HkdfSha256Segment1MBTest, TypeUrl) {
+  const KeyTemplate& key_template =
+      StreamingAeadKeyTemplates::ChaCha20Poly1305HkdfSha256Segment1MB();
+  EXPECT_THAT(key_template.type_url(),
+              Eq("type.googleapis.com/"
+                 "google.crypto.tink.ChaCha20Poly1305HkdfStreamingKey"));
+  EXPECT_THAT(key_template.type_url(),
+              Eq(ChaCha20Poly1305HkdfStreamingKeyManager().get_key_type()));
+}
+
+TEST(ChaCha20Poly1305HkdfSha256Segment1MBTest, OutputPrefixType) {
+  EXPECT_THAT(
+      StreamingAeadKeyTemplates::ChaCha20Poly1305HkdfSha256Segment1MB()
+          .output_prefix_type(),
+      Eq(OutputPrefixType::RAW));
+}
+
+TEST(ChaCha20Poly1305HkdfSha256Segment1MBTest, SameReference) {
+  // Check that reference to the same object is returned.
+  EXPECT_THAT(
+      StreamingAeadKeyTemplates::ChaCha20Poly1305HkdfSha256Segment1MB(),
+      Ref(StreamingAeadKeyTemplates::ChaCha20Poly1305HkdfSha256Segment1MB()));
+}
+
+TEST(ChaCha20Poly1305HkdfSha256Segment1MBTest, WorksWithKeyTypeManager) {
+  const KeyTemplate& key_template =
+      StreamingAeadKeyTemplates::ChaCha20Poly1305HkdfSha256Segment1MB();
+  ChaCha20Poly1305HkdfStreamingKeyFormat key_format;
+  EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+  EXPECT_THAT(
+      ChaCha20Poly1305HkdfStreamingKeyManager().ValidateKeyFormat(key_format),
+      IsOk());
+}
+
+TEST(ChaCha20Poly1305HkdfSha256Segment1MBTest, CheckValues) {
+  const KeyTemplate& key_template =
+      StreamingAeadKeyTemplates::ChaCha20Poly1305HkdfSha256Segment1MB();
+  ChaCha20Poly1305HkdfStreamingKeyFormat key_format;
+  EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+  EXPECT_THAT(key_format.key_size(), Eq(32));
+  EXPECT_THAT(key_format.params().ciphertext_segment_size(), Eq(1048576));
+  EXPECT_THAT(key_format.params().hkdf_hash_type(), Eq(HashType::SHA256));
+}
+
+TEST(KmsEnvelopeStreamingAeadTest, CheckValues) {
+  const KeyTemplate& dek_template =
+      StreamingAeadKeyTemplates::Aes256GcmHkdf1MB();
+  KeyTemplate key_template =
+      StreamingAeadKeyTemplates::KmsEnvelopeStreamingAead("kek uri",
+                                                          dek_template);
+  EXPECT_THAT(key_template.type_url(),
+              Eq(KmsEnvelopeStreamingAeadKeyManager().get_key_type()));
+  EXPECT_THAT(key_template.output_prefix_type(), Eq(OutputPrefixType::RAW));
+  KmsEnvelopeStreamingAeadKeyFormat key_format;
+  EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+  EXPECT_THAT(
+      KmsEnvelopeStreamingAeadKeyManager().ValidateKeyFormat(key_format),
+      IsOk());
+  EXPECT_THAT(key_format.kek_uri(), Eq("kek uri"));
+  EXPECT_THAT(key_format.dek_template().type_url(),
+              Eq(dek_template.type_url()));
+  EXPECT_THAT(key_format.dek_template().value(), Eq(dek_template.value()));
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
@@ -16,14 +16,20 @@
 
 #include "tink/streamingaead/streaming_aead_wrapper.h"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include "tink/streaming_aead.h"
 #include "tink/crypto_format.h"
 #include "tink/input_stream.h"
+#include "tink/internal/monitored_operation.h"
 #include "tink/output_stream.h"
 #include "tink/primitive_set.h"
 #include "tink/random_access_stream.h"
 #include "tink/streamingaead/decrypting_input_stream.h"
 #include "tink/streamingaead/decrypting_random_access_stream.h"
+#include "tink/streamingaead/header_key_cache.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
@@ -56,7 +62,9 @@ class StreamingAeadSetWrapper: public StreamingAead {
  public:
   explicit StreamingAeadSetWrapper(
       std::unique_ptr<PrimitiveSet<StreamingAead>> primitives)
-      : primitives_(std::move(primitives)) {}
+      : primitives_(std::move(primitives)),
+        header_key_cache_(std::make_shared<streamingaead::HeaderKeyCache>()) {
+  }
 
   crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
   NewEncryptingStream(
@@ -74,6 +82,21 @@ class StreamingAeadSetWrapper: public StreamingAead {
       std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
       absl::string_view associated_data) override;
 
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<crypto::tink::RandomAccessStream>>
+  NewDecryptingRandomAccessStream(
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view associated_data,
+      const RandomAccessOptions& options) override;
+
+  crypto::tink::util::StatusOr<std::vector<CiphertextRange>>
+  PlanCiphertextRanges(int64_t ciphertext_size, int64_t position,
+                       int64_t count, int64_t max_gap) override;
+
+  crypto::tink::util::Status VerifyStream(
+      std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
+      absl::string_view associated_data, int parallelism) override;
+
   ~StreamingAeadSetWrapper() override {}
 
  private:
@@ -83,14 +106,24 @@ class StreamingAeadSetWrapper: public StreamingAead {
   // is destroyed, as we refer to primitives_ only when the user attempts
   // to read some data from the decrypting stream.
   std::shared_ptr<PrimitiveSet<StreamingAead>> primitives_;
+  // Shared with the decrypting streams, so that opening a ciphertext again
+  // tries the key that decrypted it before first.
+  std::shared_ptr<streamingaead::HeaderKeyCache> header_key_cache_;
 };  // class StreamingAeadSetWrapper
 
 StatusOr<std::unique_ptr<OutputStream>>
 StreamingAeadSetWrapper::NewEncryptingStream(
     std::unique_ptr<OutputStream> ciphertext_destination,
     absl::string_view associated_data) {
-  return primitives_->get_primary()->get_primitive().NewEncryptingStream(
+  internal::MonitoredOperation operation("streaming_aead", "encrypt_stream");
+  operation.KeyTried();
+  auto encrypting_stream_result =
+      primitives_->get_primary()->get_primitive().NewEncryptingStream(
           std::move(ciphertext_destination), associated_data);
+  if (encrypting_stream_result.ok()) {
+    operation.Succeeded(primitives_->get_primary()->get_key_id());
+  }
+  return encrypting_stream_result;
 }
 
 StatusOr<std::unique_ptr<InputStream>>
@@ -98,7 +131,8 @@ StreamingAeadSetWrapper::NewDecryptingStream(
     std::unique_ptr<InputStream> ciphertext_source,
     absl::string_view associated_data) {
   return {streamingaead::DecryptingInputStream::New(
-      primitives_, std::move(ciphertext_source), associated_data)};
+      primitives_, std::move(ciphertext_source), associated_data,
+      header_key_cache_)};
 }
 
 StatusOr<std::unique_ptr<RandomAccessStream>>
@@ -106,7 +140,78 @@ StreamingAeadSetWrapper::NewDecryptingRandomAccessStream(
     std::unique_ptr<RandomAccessStream> ciphertext_source,
     absl::string_view associated_data) {
   return {streamingaead::DecryptingRandomAccessStream::New(
-      primitives_, std::move(ciphertext_source), associated_data)};
+      primitives_, std::move(ciphertext_source), associated_data,
+      RandomAccessOptions(), header_key_cache_)};
+}
+
+StatusOr<std::unique_ptr<RandomAccessStream>>
+StreamingAeadSetWrapper::NewDecryptingRandomAccessStream(
+    std::unique_ptr<RandomAccessStream> ciphertext_source,
+    absl::string_view associated_data, const RandomAccessOptions& options) {
+  return {streamingaead::DecryptingRandomAccessStream::New(
+      primitives_, std::move(ciphertext_source), associated_data, options,
+      header_key_cache_)};
+}
+
+StatusOr<std::vector<StreamingAead::CiphertextRange>>
+StreamingAeadSetWrapper::PlanCiphertextRanges(int64_t ciphertext_size,
+                                              int64_t position, int64_t count,
+                                              int64_t max_gap) {
+  auto raw_primitives_result = primitives_->get_raw_primitives();
+  if (!raw_primitives_result.ok()) {
+    return Status(util::error::INTERNAL, "No RAW primitives found");
+  }
+  auto& raw_primitives = *raw_primitives_result.ValueOrDie();
+  // The decrypting stream may try every key, and reads the prefix of the
+  // ciphertext to look up the matching key with several keys.
+  std::vector<CiphertextRange> ranges;
+  if (raw_primitives.size() > 1) {
+    ranges.push_back(
+        {0, std::min<int64_t>(streamingaead::HeaderKeyCache::kPrefixSize,
+                              ciphertext_size)});
+  }
+  for (const auto& entry : raw_primitives) {
+    auto plan_result = entry->get_primitive().PlanCiphertextRanges(
+        ciphertext_size, position, count, max_gap);
+    if (!plan_result.ok()) return plan_result.status();
+    for (const CiphertextRange& range : plan_result.ValueOrDie()) {
+      ranges.push_back(range);
+    }
+  }
+  std::sort(ranges.begin(), ranges.end(),
+            [](const CiphertextRange& a, const CiphertextRange& b) {
+              return a.position < b.position;
+            });
+  std::vector<CiphertextRange> coalesced;
+  for (const CiphertextRange& range : ranges) {
+    if (!coalesced.empty() &&
+        range.position - (coalesced.back().position + coalesced.back().size) <=
+            max_gap) {
+      int64_t end = std::max(coalesced.back().position + coalesced.back().size,
+                             range.position + range.size);
+      coalesced.back().size = end - coalesced.back().position;
+    } else {
+      coalesced.push_back(range);
+    }
+  }
+  return coalesced;
+}
+
+Status StreamingAeadSetWrapper::VerifyStream(
+    std::unique_ptr<InputStream> ciphertext_source,
+    absl::string_view associated_data, int parallelism) {
+  // A failed verification does not tell whether the key or the ciphertext is
+  // wrong, so with several keys the matching key is found by decrypting the
+  // ciphertext instead.
+  auto raw_primitives_result = primitives_->get_raw_primitives();
+  if (raw_primitives_result.ok() &&
+      raw_primitives_result.ValueOrDie()->size() == 1) {
+    return raw_primitives_result.ValueOrDie()->front()->get_primitive()
+        .VerifyStream(std::move(ciphertext_source), associated_data,
+                      parallelism);
+  }
+  return StreamingAead::VerifyStream(std::move(ciphertext_source),
+                                     associated_data, parallelism);
 }
 
 }  // anonymous namespace
@@ -115,6 +220,7 @@ StatusOr<std::unique_ptr<StreamingAead>> StreamingAeadWrapper::Wrap(
     std::unique_ptr<PrimitiveSet<StreamingAead>> streaming_aead_set) const {
   auto status = Validate(streaming_aead_set.get());
   if (!status.ok()) return status;
+  streaming_aead_set->Freeze();
   std::unique_ptr<StreamingAead> streaming_aead =
       absl::make_unique<StreamingAeadSetWrapper>(
           std::move(streaming_aead_set));
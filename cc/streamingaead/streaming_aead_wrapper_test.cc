@@ -17,6 +17,7 @@
 #include "tink/streamingaead/streaming_aead_wrapper.h"
 
 #include <sstream>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "absl/memory/memory.h"
@@ -188,6 +189,33 @@ TEST(StreamingAeadSetWrapperTest, BasicEncryptionAndDecryption) {
   }
 }
 
+TEST(StreamingAeadSetWrapperTest, VerifyStream) {
+  // With one key VerifyStream() is forwarded to its primitive, and with
+  // several keys the matching one is found by decrypting.
+  for (int key_count : {1, 3}) {
+    SCOPED_TRACE(absl::StrCat("key_count = ", key_count));
+    std::vector<StreamingAeadSpec> spec;
+    for (int i = 0; i < key_count; i++) {
+      spec.push_back({static_cast<uint32_t>(1000 + i),
+                      absl::StrCat("streaming_aead", i),
+                      OutputPrefixType::RAW});
+    }
+    auto wrap_result =
+        StreamingAeadWrapper().Wrap(GetTestStreamingAeadSet(spec));
+    ASSERT_THAT(wrap_result.status(), IsOk());
+    auto saead = std::move(wrap_result.ValueOrDie());
+    // DummyStreamingAead produces name || aad || plaintext.
+    std::string ciphertext =
+        absl::StrCat("streaming_aead0", "aad", "plaintext");
+    auto new_source = [&ciphertext]() -> std::unique_ptr<InputStream> {
+      return absl::make_unique<util::IstreamInputStream>(
+          absl::make_unique<std::stringstream>(ciphertext));
+    };
+    EXPECT_THAT(saead->VerifyStream(new_source(), "aad", 2), IsOk());
+    EXPECT_FALSE(saead->VerifyStream(new_source(), "other aad", 2).ok());
+  }
+}
+
 TEST(StreamingAeadSetWrapperTest, DecryptionWithRandomAccessStream) {
   uint32_t key_id_0 = 1234543;
   uint32_t key_id_1 = 726329;
@@ -0,0 +1,474 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aegis.h"
+
+#if defined(__SSE4_1__) && defined(__AES__)
+#define TINK_SUBTLE_AEGIS_AESNI
+#include <emmintrin.h>  // SSE2: _mm_xor_si128, _mm_and_si128 etc.
+#include <wmmintrin.h>  // AES_NI instructions.
+#elif defined(__aarch64__) && \
+    (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+#define TINK_SUBTLE_AEGIS_ARMV8
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/mem.h"
+#include "tink/subtle/cpu_features.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+#if defined(TINK_SUBTLE_AEGIS_AESNI) || defined(TINK_SUBTLE_AEGIS_ARMV8)
+
+namespace {
+
+constexpr size_t kBlockSize = 16;
+constexpr size_t kTagSize = 16;
+
+#ifdef TINK_SUBTLE_AEGIS_AESNI
+
+using Block = __m128i;
+
+inline Block LoadBlock(const uint8_t* block) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+}
+
+inline void StoreBlock(uint8_t* block, Block value) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(block), value);
+}
+
+inline Block Xor(Block a, Block b) { return _mm_xor_si128(a, b); }
+
+inline Block And(Block a, Block b) { return _mm_and_si128(a, b); }
+
+// One AES round: SubBytes, ShiftRows and MixColumns of 'in', followed by
+// the XOR of 'round_key'.
+inline Block AesRound(Block in, Block round_key) {
+  return _mm_aesenc_si128(in, round_key);
+}
+
+#else  // TINK_SUBTLE_AEGIS_ARMV8
+
+using Block = uint8x16_t;
+
+inline Block LoadBlock(const uint8_t* block) { return vld1q_u8(block); }
+
+inline void StoreBlock(uint8_t* block, Block value) { vst1q_u8(block, value); }
+
+inline Block Xor(Block a, Block b) { return veorq_u8(a, b); }
+
+inline Block And(Block a, Block b) { return vandq_u8(a, b); }
+
+// AESE XORs its key in before SubBytes and ShiftRows, so it gets a zero key
+// and 'round_key' is XORed in after MixColumns, as AESENC on x86 does.
+inline Block AesRound(Block in, Block round_key) {
+  return veorq_u8(vaesmcq_u8(vaeseq_u8(in, vdupq_n_u8(0))), round_key);
+}
+
+#endif  // TINK_SUBTLE_AEGIS_AESNI
+
+// The constants of AEGIS: the Fibonacci sequence modulo 256.
+constexpr uint8_t kC0[kBlockSize] = {0x00, 0x01, 0x01, 0x02, 0x03, 0x05,
+                                     0x08, 0x0d, 0x15, 0x22, 0x37, 0x59,
+                                     0x90, 0xe9, 0x79, 0x62};
+constexpr uint8_t kC1[kBlockSize] = {0xdb, 0x3d, 0x18, 0x55, 0x6d, 0xc2,
+                                     0x2f, 0xf1, 0x20, 0x11, 0x31, 0x42,
+                                     0x73, 0xb5, 0x28, 0xdd};
+
+// The block of the 64-bit little endian bit lengths of the associated data
+// and of the message, which the finalization absorbs.
+Block LengthBlock(uint64_t ad_size, uint64_t message_size) {
+  uint8_t block[kBlockSize];
+  for (int i = 0; i < 8; i++) {
+    block[i] = static_cast<uint8_t>((ad_size * 8) >> (8 * i));
+    block[8 + i] = static_cast<uint8_t>((message_size * 8) >> (8 * i));
+  }
+  return LoadBlock(block);
+}
+
+// The state of AEGIS-128L: 8 blocks, absorbing 2 blocks per update.
+class Aegis128LState {
+ public:
+  static constexpr size_t kKeySize = 16;
+  static constexpr int kRateBlocks = 2;
+
+  Aegis128LState(const uint8_t* key, const uint8_t* nonce) {
+    const Block k = LoadBlock(key);
+    const Block n = LoadBlock(nonce);
+    const Block c0 = LoadBlock(kC0);
+    const Block c1 = LoadBlock(kC1);
+    s_[0] = Xor(k, n);
+    s_[1] = c1;
+    s_[2] = c0;
+    s_[3] = c1;
+    s_[4] = Xor(k, n);
+    s_[5] = Xor(k, c0);
+    s_[6] = Xor(k, c1);
+    s_[7] = Xor(k, c0);
+    const Block m[2] = {n, k};
+    for (int i = 0; i < 10; i++) Update(m);
+  }
+
+  inline void Update(const Block* m) {
+    const Block s7 = s_[7];
+    for (int i = 7; i > 0; i--) {
+      s_[i] = AesRound(s_[i - 1], i == 4 ? Xor(s_[4], m[1]) : s_[i]);
+    }
+    s_[0] = AesRound(s7, Xor(s_[0], m[0]));
+  }
+
+  inline void KeyStream(Block* z) const {
+    z[0] = Xor(Xor(s_[6], s_[1]), And(s_[2], s_[3]));
+    z[1] = Xor(Xor(s_[2], s_[5]), And(s_[6], s_[7]));
+  }
+
+  Block Finalize(uint64_t ad_size, uint64_t message_size) {
+    const Block t = Xor(s_[2], LengthBlock(ad_size, message_size));
+    const Block m[2] = {t, t};
+    for (int i = 0; i < 7; i++) Update(m);
+    Block tag = s_[0];
+    for (int i = 1; i < 7; i++) tag = Xor(tag, s_[i]);
+    return tag;
+  }
+
+ private:
+  Block s_[8];
+};
+
+// The state of AEGIS-256: 6 blocks, absorbing 1 block per update.
+class Aegis256State {
+ public:
+  static constexpr size_t kKeySize = 32;
+  static constexpr int kRateBlocks = 1;
+
+  Aegis256State(const uint8_t* key, const uint8_t* nonce) {
+    const Block k0 = LoadBlock(key);
+    const Block k1 = LoadBlock(key + kBlockSize);
+    const Block kn0 = Xor(k0, LoadBlock(nonce));
+    const Block kn1 = Xor(k1, LoadBlock(nonce + kBlockSize));
+    const Block c0 = LoadBlock(kC0);
+    const Block c1 = LoadBlock(kC1);
+    s_[0] = kn0;
+    s_[1] = kn1;
+    s_[2] = c1;
+    s_[3] = c0;
+    s_[4] = Xor(k0, c0);
+    s_[5] = Xor(k1, c1);
+    for (int i = 0; i < 4; i++) {
+      Update(&k0);
+      Update(&k1);
+      Update(&kn0);
+      Update(&kn1);
+    }
+  }
+
+  inline void Update(const Block* m) {
+    const Block s5 = s_[5];
+    for (int i = 5; i > 0; i--) s_[i] = AesRound(s_[i - 1], s_[i]);
+    s_[0] = AesRound(s5, Xor(s_[0], m[0]));
+  }
+
+  inline void KeyStream(Block* z) const {
+    z[0] = Xor(Xor(Xor(s_[1], s_[4]), s_[5]), And(s_[2], s_[3]));
+  }
+
+  Block Finalize(uint64_t ad_size, uint64_t message_size) {
+    const Block t = Xor(s_[3], LengthBlock(ad_size, message_size));
+    for (int i = 0; i < 7; i++) Update(&t);
+    Block tag = s_[0];
+    for (int i = 1; i < 6; i++) tag = Xor(tag, s_[i]);
+    return tag;
+  }
+
+ private:
+  Block s_[6];
+};
+
+// Absorbs 'ad' into 'state', zero padded to a multiple of the rate.
+template <class State>
+void AbsorbAssociatedData(absl::string_view ad, State* state) {
+  constexpr size_t kRate = State::kRateBlocks * kBlockSize;
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(ad.data());
+  Block m[State::kRateBlocks];
+  size_t i = 0;
+  for (; i + kRate <= ad.size(); i += kRate) {
+    for (int b = 0; b < State::kRateBlocks; b++) {
+      m[b] = LoadBlock(in + i + b * kBlockSize);
+    }
+    state->Update(m);
+  }
+  if (i < ad.size()) {
+    uint8_t padded[kRate] = {0};
+    std::copy_n(in + i, ad.size() - i, padded);
+    for (int b = 0; b < State::kRateBlocks; b++) {
+      m[b] = LoadBlock(padded + b * kBlockSize);
+    }
+    state->Update(m);
+  }
+}
+
+// Encrypts pt[0] .. pt[size - 1] into ct and writes the tag to ct + size.
+template <class State>
+void Seal(const uint8_t* key, const uint8_t* nonce, absl::string_view ad,
+          const uint8_t* pt, size_t size, uint8_t* ct) {
+  constexpr size_t kRate = State::kRateBlocks * kBlockSize;
+  State state(key, nonce);
+  AbsorbAssociatedData(ad, &state);
+  Block m[State::kRateBlocks];
+  Block z[State::kRateBlocks];
+  size_t i = 0;
+  for (; i + kRate <= size; i += kRate) {
+    state.KeyStream(z);
+    for (int b = 0; b < State::kRateBlocks; b++) {
+      m[b] = LoadBlock(pt + i + b * kBlockSize);
+      StoreBlock(ct + i + b * kBlockSize, Xor(m[b], z[b]));
+    }
+    state.Update(m);
+  }
+  if (i < size) {
+    // The last partial chunk is zero padded; the padding absorbed into the
+    // state is thus zero as well.
+    uint8_t padded[kRate] = {0};
+    std::copy_n(pt + i, size - i, padded);
+    state.KeyStream(z);
+    for (int b = 0; b < State::kRateBlocks; b++) {
+      m[b] = LoadBlock(padded + b * kBlockSize);
+      StoreBlock(padded + b * kBlockSize, Xor(m[b], z[b]));
+    }
+    std::copy_n(padded, size - i, ct + i);
+    state.Update(m);
+  }
+  StoreBlock(ct + size, state.Finalize(ad.size(), size));
+}
+
+// Decrypts ct[0] .. ct[size - 1] into pt and returns whether the tag at
+// ct + size is valid. On failure, pt is zeroed.
+template <class State>
+bool Open(const uint8_t* key, const uint8_t* nonce, absl::string_view ad,
+          const uint8_t* ct, size_t size, uint8_t* pt) {
+  constexpr size_t kRate = State::kRateBlocks * kBlockSize;
+  State state(key, nonce);
+  AbsorbAssociatedData(ad, &state);
+  Block m[State::kRateBlocks];
+  Block z[State::kRateBlocks];
+  size_t i = 0;
+  for (; i + kRate <= size; i += kRate) {
+    state.KeyStream(z);
+    for (int b = 0; b < State::kRateBlocks; b++) {
+      m[b] = Xor(LoadBlock(ct + i + b * kBlockSize), z[b]);
+      StoreBlock(pt + i + b * kBlockSize, m[b]);
+    }
+    state.Update(m);
+  }
+  if (i < size) {
+    // Decrypting the zero padding yields key stream, which must be zeroed
+    // again before the chunk is absorbed.
+    uint8_t padded[kRate] = {0};
+    std::copy_n(ct + i, size - i, padded);
+    state.KeyStream(z);
+    for (int b = 0; b < State::kRateBlocks; b++) {
+      StoreBlock(padded + b * kBlockSize,
+                 Xor(LoadBlock(padded + b * kBlockSize), z[b]));
+    }
+    std::fill(padded + (size - i), padded + kRate, 0);
+    std::copy_n(padded, size - i, pt + i);
+    for (int b = 0; b < State::kRateBlocks; b++) {
+      m[b] = LoadBlock(padded + b * kBlockSize);
+    }
+    state.Update(m);
+  }
+  uint8_t tag[kTagSize];
+  StoreBlock(tag, state.Finalize(ad.size(), size));
+  if (CRYPTO_memcmp(tag, ct + size, kTagSize) != 0) {
+    std::fill_n(pt, size, 0);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+// static
+bool Aegis::IsSupported() {
+#ifdef TINK_SUBTLE_AEGIS_AESNI
+  return UseAesniImplementations();
+#else
+  return GetCpuFeatures().arm_aes &&
+         GetDispatchPolicy() == DispatchPolicy::kFastest;
+#endif
+}
+
+// static
+util::StatusOr<std::unique_ptr<Aead>> Aegis::New(const util::SecretData& key) {
+  auto status = CheckFipsCompatibility<Aegis>();
+  if (!status.ok()) return status;
+  if (!IsValidKeySizeInBytes(key.size())) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
+  }
+  if (!IsSupported()) {
+    return util::Status(util::error::UNIMPLEMENTED,
+                        "AEGIS needs the AES instructions of the CPU");
+  }
+  return {absl::WrapUnique(new Aegis(key))};
+}
+
+util::StatusOr<std::string> Aegis::Encrypt(
+    absl::string_view plaintext, absl::string_view associated_data) const {
+  std::string ciphertext;
+  ResizeStringUninitialized(
+      &ciphertext, key_.size() + plaintext.size() + kTagSizeInBytes);
+  auto written_or =
+      EncryptInto(plaintext, associated_data,
+                  absl::MakeSpan(&ciphertext[0], ciphertext.size()));
+  if (!written_or.ok()) return written_or.status();
+  return std::move(ciphertext);
+}
+
+util::StatusOr<std::string> Aegis::Decrypt(
+    absl::string_view ciphertext, absl::string_view associated_data) const {
+  if (ciphertext.size() < key_.size() + kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  std::string plaintext;
+  ResizeStringUninitialized(
+      &plaintext, ciphertext.size() - key_.size() - kTagSizeInBytes);
+  auto written_or =
+      DecryptInto(ciphertext, associated_data,
+                  absl::MakeSpan(&plaintext[0], plaintext.size()));
+  if (!written_or.ok()) return written_or.status();
+  return std::move(plaintext);
+}
+
+util::StatusOr<int64_t> Aegis::CiphertextSize(int64_t plaintext_size) const {
+  if (plaintext_size < 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Plaintext size must be non-negative");
+  }
+  return key_.size() + plaintext_size + kTagSizeInBytes;
+}
+
+util::StatusOr<int64_t> Aegis::EncryptInto(
+    absl::string_view plaintext, absl::string_view associated_data,
+    absl::Span<char> ciphertext_buffer) const {
+  // The nonce is as long as the key.
+  const size_t nonce_size = key_.size();
+  const size_t ciphertext_size =
+      nonce_size + plaintext.size() + kTagSizeInBytes;
+  if (ciphertext_buffer.size() < ciphertext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Ciphertext buffer too small");
+  }
+  auto status = Random::GetRandomBytes(ciphertext_buffer.subspan(0, nonce_size));
+  if (!status.ok()) return status;
+  uint8_t* nonce = reinterpret_cast<uint8_t*>(ciphertext_buffer.data());
+  const uint8_t* pt = reinterpret_cast<const uint8_t*>(plaintext.data());
+  if (nonce_size == Aegis128LState::kKeySize) {
+    Seal<Aegis128LState>(key_.data(), nonce, associated_data, pt,
+                         plaintext.size(), nonce + nonce_size);
+  } else {
+    Seal<Aegis256State>(key_.data(), nonce, associated_data, pt,
+                        plaintext.size(), nonce + nonce_size);
+  }
+  return ciphertext_size;
+}
+
+util::StatusOr<int64_t> Aegis::DecryptInto(
+    absl::string_view ciphertext, absl::string_view associated_data,
+    absl::Span<char> plaintext_buffer) const {
+  const size_t nonce_size = key_.size();
+  if (ciphertext.size() < nonce_size + kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  const size_t plaintext_size =
+      ciphertext.size() - nonce_size - kTagSizeInBytes;
+  if (plaintext_buffer.size() < plaintext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Plaintext buffer too small");
+  }
+  const uint8_t* nonce = reinterpret_cast<const uint8_t*>(ciphertext.data());
+  uint8_t* pt = reinterpret_cast<uint8_t*>(plaintext_buffer.data());
+  bool valid;
+  if (nonce_size == Aegis128LState::kKeySize) {
+    valid = Open<Aegis128LState>(key_.data(), nonce, associated_data,
+                                 nonce + nonce_size, plaintext_size, pt);
+  } else {
+    valid = Open<Aegis256State>(key_.data(), nonce, associated_data,
+                                nonce + nonce_size, plaintext_size, pt);
+  }
+  if (!valid) {
+    return util::Status(util::error::INTERNAL, "Authentication failed");
+  }
+  return plaintext_size;
+}
+
+#else  // TINK_SUBTLE_AEGIS_AESNI || TINK_SUBTLE_AEGIS_ARMV8
+
+// static
+bool Aegis::IsSupported() { return false; }
+
+// static
+util::StatusOr<std::unique_ptr<Aead>> Aegis::New(const util::SecretData& key) {
+  return util::Status(util::error::UNIMPLEMENTED,
+                      "AEGIS is not compiled in for this CPU");
+}
+
+util::StatusOr<std::string> Aegis::Encrypt(absl::string_view plaintext,
+                                           absl::string_view ad) const {
+  return util::Status(util::error::UNIMPLEMENTED, "AEGIS is not compiled in");
+}
+
+util::StatusOr<std::string> Aegis::Decrypt(absl::string_view ciphertext,
+                                           absl::string_view ad) const {
+  return util::Status(util::error::UNIMPLEMENTED, "AEGIS is not compiled in");
+}
+
+util::StatusOr<int64_t> Aegis::CiphertextSize(int64_t plaintext_size) const {
+  return util::Status(util::error::UNIMPLEMENTED, "AEGIS is not compiled in");
+}
+
+util::StatusOr<int64_t> Aegis::EncryptInto(absl::string_view plaintext,
+                                           absl::string_view ad,
+                                           absl::Span<char> buffer) const {
+  return util::Status(util::error::UNIMPLEMENTED, "AEGIS is not compiled in");
+}
+
+util::StatusOr<int64_t> Aegis::DecryptInto(absl::string_view ciphertext,
+                                           absl::string_view ad,
+                                           absl::Span<char> buffer) const {
+  return util::Status(util::error::UNIMPLEMENTED, "AEGIS is not compiled in");
+}
+
+#endif  // TINK_SUBTLE_AEGIS_AESNI || TINK_SUBTLE_AEGIS_ARMV8
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
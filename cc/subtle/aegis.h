@@ -0,0 +1,100 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_AEGIS_H_
+#define TINK_SUBTLE_AEGIS_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// AEGIS-128L for 16 byte keys and AEGIS-256 for 32 byte keys, as specified
+// in draft-irtf-cfrg-aegis-aead, with 16 byte tags.
+//
+// The ciphertext is a random nonce as long as the key, followed by the
+// encrypted message and the tag. Like AES-GCM, AEGIS relies on nonces not
+// being repeated, but its nonces are large enough to be chosen at random
+// for practically any number of messages.
+//
+// AEGIS is built on the AES round function, so it is implemented on the AES
+// instructions of x86 (AES-NI) and ARMv8 (Crypto Extensions): on CPUs
+// without them, or if they are not compiled in, New() fails with
+// UNIMPLEMENTED, as there is no constant-time portable implementation.
+//
+// Thread safety: This class is thread safe and thus can be used
+// concurrently.
+class Aegis : public Aead {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
+      const util::SecretData& key);
+
+  // Returns true if New() can succeed on this CPU, i.e. if the AES
+  // instructions are compiled in, supported by the CPU and allowed by the
+  // dispatch policy.
+  static bool IsSupported();
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override;
+
+  crypto::tink::util::StatusOr<int64_t> EncryptInto(
+      absl::string_view plaintext, absl::string_view associated_data,
+      absl::Span<char> ciphertext_buffer) const override;
+
+  crypto::tink::util::StatusOr<int64_t> DecryptInto(
+      absl::string_view ciphertext, absl::string_view associated_data,
+      absl::Span<char> plaintext_buffer) const override;
+
+  static bool IsValidKeySizeInBytes(size_t size) {
+    return size == 16 || size == 32;
+  }
+
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kNotFips;
+
+ private:
+  static constexpr int kTagSizeInBytes = 16;
+
+  explicit Aegis(util::SecretData key) : key_(std::move(key)) {}
+
+  const util::SecretData key_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_AEGIS_H_
@@ -0,0 +1,197 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aegis.h"
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::HexDecodeOrDie;
+using ::crypto::tink::test::HexEncode;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+using ::testing::Not;
+
+// Test vectors of draft-irtf-cfrg-aegis-aead, in the style of Wycheproof.
+struct TestVector {
+  const char* comment;
+  const char* key;
+  const char* nonce;
+  const char* ad;
+  const char* msg;
+  const char* ct;
+  const char* tag;
+  bool valid;
+};
+
+const TestVector kTestVectors[] = {
+    {"AEGIS-128L, one block", "10010000000000000000000000000000",
+     "10000200000000000000000000000000", "",
+     "00000000000000000000000000000000", "c1c0e58bd913006feba00f4b3cc3594e",
+     "abe0ece80c24868a226a35d16bdae37a", true},
+    {"AEGIS-128L, empty message", "10010000000000000000000000000000",
+     "10000200000000000000000000000000", "", "", "",
+     "c2b879a67def9d74e6c14f708bbcc9b4", true},
+    {"AEGIS-128L, two blocks", "10010000000000000000000000000000",
+     "10000200000000000000000000000000", "0001020304050607",
+     "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+     "79d94593d8c2119d7e8fd9b8fc77845c5c077a05b2528b6ac54b563aed8efe84",
+     "cc6f3372f6aa1bb82388d695c3962d9a", true},
+    {"AEGIS-128L, partial block", "10010000000000000000000000000000",
+     "10000200000000000000000000000000", "0001020304050607",
+     "000102030405060708090a0b0c0d", "79d94593d8c2119d7e8fd9b8fc77",
+     "5c04b3dba849b2701effbe32c7f0fab7", true},
+    {"AEGIS-128L, modified tag", "10010000000000000000000000000000",
+     "10000200000000000000000000000000", "", "", "",
+     "c2b879a67def9d74e6c14f708bbcc9b5", false},
+    {"AEGIS-256, one block",
+     "1001000000000000000000000000000000000000000000000000000000000000",
+     "1000020000000000000000000000000000000000000000000000000000000000", "",
+     "00000000000000000000000000000000", "754fc3d8c973246dcc6d741412a4b236",
+     "3fe91994768b332ed7f570a19ec5896e", true},
+    {"AEGIS-256, empty message",
+     "1001000000000000000000000000000000000000000000000000000000000000",
+     "1000020000000000000000000000000000000000000000000000000000000000", "",
+     "", "", "e3def978a0f054afd1e761d7553afba3", true},
+    {"AEGIS-256, two blocks",
+     "1001000000000000000000000000000000000000000000000000000000000000",
+     "1000020000000000000000000000000000000000000000000000000000000000",
+     "0001020304050607",
+     "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+     "f373079ed84b2709faee373584585d60accd191db310ef5d8b11833df9dec711",
+     "8d86f91ee606e9ff26a01b64ccbdd91d", true},
+    {"AEGIS-256, modified ciphertext",
+     "1001000000000000000000000000000000000000000000000000000000000000",
+     "1000020000000000000000000000000000000000000000000000000000000000", "",
+     "00000000000000000000000000000000", "754fc3d8c973246dcc6d741412a4b237",
+     "3fe91994768b332ed7f570a19ec5896e", false},
+};
+
+class AegisTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (kUseOnlyFips) {
+      GTEST_SKIP() << "Not supported in FIPS-only mode";
+    }
+    if (!Aegis::IsSupported()) {
+      GTEST_SKIP() << "AEGIS is not supported on this CPU";
+    }
+  }
+};
+
+TEST_F(AegisTest, TestVectors) {
+  for (const TestVector& vector : kTestVectors) {
+    SCOPED_TRACE(vector.comment);
+    auto aead_or =
+        Aegis::New(util::SecretDataFromStringView(HexDecodeOrDie(vector.key)));
+    ASSERT_THAT(aead_or.status(), IsOk());
+    auto& aead = aead_or.ValueOrDie();
+    std::string ciphertext = HexDecodeOrDie(
+        absl::StrCat(vector.nonce, vector.ct, vector.tag));
+    auto plaintext_or = aead->Decrypt(ciphertext, HexDecodeOrDie(vector.ad));
+    if (vector.valid) {
+      ASSERT_THAT(plaintext_or.status(), IsOk());
+      EXPECT_THAT(HexEncode(plaintext_or.ValueOrDie()), Eq(vector.msg));
+    } else {
+      EXPECT_THAT(plaintext_or.status(), Not(IsOk()));
+    }
+  }
+}
+
+// The sizes cover the boundaries of the 16 and 32 byte chunks.
+TEST_F(AegisTest, EncryptDecrypt) {
+  for (int key_size : {16, 32}) {
+    auto aead_or = Aegis::New(Random::GetRandomKeyBytes(key_size));
+    ASSERT_THAT(aead_or.status(), IsOk());
+    auto& aead = aead_or.ValueOrDie();
+    for (int msg_size : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000}) {
+      for (int ad_size : {0, 1, 16, 31, 32, 33, 100}) {
+        std::string msg = Random::GetRandomBytes(msg_size);
+        std::string ad = Random::GetRandomBytes(ad_size);
+        auto ciphertext_or = aead->Encrypt(msg, ad);
+        ASSERT_THAT(ciphertext_or.status(), IsOk());
+        const std::string& ciphertext = ciphertext_or.ValueOrDie();
+        EXPECT_THAT(ciphertext.size(),
+                    Eq(aead->CiphertextSize(msg_size).ValueOrDie()));
+        auto plaintext_or = aead->Decrypt(ciphertext, ad);
+        ASSERT_THAT(plaintext_or.status(), IsOk())
+            << msg_size << " " << ad_size;
+        EXPECT_THAT(plaintext_or.ValueOrDie(), Eq(msg));
+
+        std::string modified = ciphertext;
+        modified[ciphertext.size() - 1] ^= 1;
+        EXPECT_THAT(aead->Decrypt(modified, ad).status(), Not(IsOk()));
+        if (msg_size > 0) {
+          modified = ciphertext;
+          modified[key_size] ^= 1;
+          EXPECT_THAT(aead->Decrypt(modified, ad).status(), Not(IsOk()));
+        }
+        EXPECT_THAT(aead->Decrypt(ciphertext, absl::StrCat(ad, "x")).status(),
+                    Not(IsOk()));
+      }
+    }
+  }
+}
+
+TEST_F(AegisTest, DecryptIntoZeroesPlaintextOnFailure) {
+  auto aead = std::move(Aegis::New(Random::GetRandomKeyBytes(16)).ValueOrDie());
+  std::string ciphertext = aead->Encrypt("secret message", "").ValueOrDie();
+  ciphertext.back() ^= 1;
+  std::string buffer(14, 'x');
+  EXPECT_THAT(aead->DecryptInto(ciphertext, "",
+                                absl::MakeSpan(&buffer[0], buffer.size()))
+                  .status(),
+              Not(IsOk()));
+  EXPECT_THAT(buffer, Eq(std::string(14, '\0')));
+}
+
+TEST_F(AegisTest, InvalidInputs) {
+  for (int key_size : {0, 15, 17, 24, 31, 33, 64}) {
+    EXPECT_THAT(Aegis::New(util::SecretData(key_size, 'x')).status(),
+                StatusIs(util::error::INVALID_ARGUMENT))
+        << key_size;
+  }
+  auto aead = std::move(Aegis::New(Random::GetRandomKeyBytes(32)).ValueOrDie());
+  EXPECT_THAT(aead->Decrypt(std::string(47, 'x'), "").status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  std::string buffer(10, '\0');
+  EXPECT_THAT(aead->EncryptInto("plaintext", "",
+                                absl::MakeSpan(&buffer[0], buffer.size()))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
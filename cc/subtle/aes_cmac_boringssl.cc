@@ -17,12 +17,15 @@
 #include "tink/subtle/aes_cmac_boringssl.h"
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
-#include "openssl/cmac.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/mem.h"
+#include "tink/subtle/prf/aes_cmac_prf.h"
 #include "tink/subtle/subtle_util.h"
-#include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/status.h"
 
 namespace crypto {
@@ -41,51 +44,59 @@ util::StatusOr<std::unique_ptr<Mac>> AesCmacBoringSsl::New(util::SecretData key,
   if (tag_size > kMaxTagSize) {
     return util::Status(util::error::INVALID_ARGUMENT, "invalid tag size");
   }
-  return {absl::WrapUnique(new AesCmacBoringSsl(std::move(key), tag_size))};
+  auto prf_or = AesCmacPrf::New(key);
+  if (!prf_or.ok()) return prf_or.status();
+  return {absl::WrapUnique(
+      new AesCmacBoringSsl(std::move(prf_or.ValueOrDie()), tag_size))};
 }
 
 util::StatusOr<std::string> AesCmacBoringSsl::ComputeMac(
     absl::string_view data) const {
-  // BoringSSL expects a non-null pointer for data,
-  // regardless of whether the size is 0.
-  data = SubtleUtilBoringSSL::EnsureNonNull(data);
+  return prf_->Compute(data, tag_size_);
+}
 
-  std::string result;
-  ResizeStringUninitialized(&result, kMaxTagSize);
-  const int res =
-      AES_CMAC(reinterpret_cast<uint8_t*>(&result[0]), key_.data(), key_.size(),
-               reinterpret_cast<const uint8_t*>(data.data()), data.size());
-  if (res == 0) {
-    return util::Status(util::error::INTERNAL,
-                        "BoringSSL failed to compute CMAC");
+util::StatusOr<int64_t> AesCmacBoringSsl::ComputeMacInto(
+    absl::string_view data, absl::Span<uint8_t> tag) const {
+  if (tag.size() < tag_size_) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Tag buffer too small");
   }
-  result.resize(tag_size_);
-  return result;
+  auto status = prf_->ComputeBatch(absl::MakeConstSpan(&data, 1), tag_size_,
+                                   tag.subspan(0, tag_size_));
+  if (!status.ok()) return status;
+  return tag_size_;
 }
 
 util::Status AesCmacBoringSsl::VerifyMac(absl::string_view mac,
                                          absl::string_view data) const {
-  // BoringSSL expects a non-null pointer for data,
-  // regardless of whether the size is 0.
-  data = SubtleUtilBoringSSL::EnsureNonNull(data);
-
   if (mac.size() != tag_size_) {
     return util::Status(util::error::INVALID_ARGUMENT, "incorrect tag size");
   }
-  uint8_t buf[kMaxTagSize];
-  const int res =
-      AES_CMAC(buf, key_.data(), key_.size(),
-               reinterpret_cast<const uint8_t*>(data.data()), data.size());
-  if (res == 0) {
-    return util::Status(util::error::INTERNAL,
-                        "BoringSSL failed to compute CMAC");
-  }
-  if (CRYPTO_memcmp(buf, mac.data(), tag_size_) != 0) {
+  uint8_t tag[kMaxTagSize];
+  auto status = prf_->ComputeBatch(absl::MakeConstSpan(&data, 1), tag_size_,
+                                   absl::MakeSpan(tag, tag_size_));
+  if (!status.ok()) return status;
+  if (CRYPTO_memcmp(tag, mac.data(), tag_size_) != 0) {
     return util::Status(util::error::INVALID_ARGUMENT, "verification failed");
   }
   return util::OkStatus();
 }
 
+util::StatusOr<std::vector<std::string>> AesCmacBoringSsl::ComputeMacs(
+    absl::Span<const absl::string_view> data) const {
+  std::string tags;
+  ResizeStringUninitialized(&tags, data.size() * tag_size_);
+  auto status = prf_->ComputeBatch(
+      data, tag_size_,
+      absl::MakeSpan(reinterpret_cast<uint8_t*>(&tags[0]), tags.size()));
+  if (!status.ok()) return status;
+  std::vector<std::string> macs;
+  macs.reserve(data.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    macs.push_back(tags.substr(i * tag_size_, tag_size_));
+  }
+  return std::move(macs);
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -18,10 +18,15 @@
 #define TINK_SUBTLE_AES_CMAC_BORINGSSL_H_
 
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/mac.h"
 #include "tink/config/tink_fips.h"
+#include "tink/prf/prf_set.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/statusor.h"
 
@@ -29,6 +34,9 @@ namespace crypto {
 namespace tink {
 namespace subtle {
 
+// AES-CMAC (RFC 4493).  The key schedule and the CMAC subkeys are computed
+// once, in New(), by the AesCmacPrf this class delegates to; ComputeMacs()
+// uses its interleaved batch computation.
 class AesCmacBoringSsl : public Mac {
  public:
   static crypto::tink::util::StatusOr<std::unique_ptr<Mac>> New(
@@ -43,6 +51,17 @@ class AesCmacBoringSsl : public Mac {
   crypto::tink::util::Status VerifyMac(absl::string_view mac,
                                        absl::string_view data) const override;
 
+  // Computes the CMAC for 'data' into 'tag', without allocating.
+  crypto::tink::util::StatusOr<int64_t> ComputeMacInto(
+      absl::string_view data, absl::Span<uint8_t> tag) const override;
+
+  using Mac::VerifyMac;
+
+  // Computes the CMACs of all of 'data' with up to AesCmacPrf::kLanes CMAC
+  // chains in flight at a time.
+  crypto::tink::util::StatusOr<std::vector<std::string>> ComputeMacs(
+      absl::Span<const absl::string_view> data) const override;
+
   static constexpr crypto::tink::FipsCompatibility kFipsStatus =
       crypto::tink::FipsCompatibility::kNotFips;
 
@@ -56,10 +75,10 @@ class AesCmacBoringSsl : public Mac {
   static constexpr size_t kBigKeySize = 32;
   static constexpr size_t kMaxTagSize = 16;
 
-  AesCmacBoringSsl(util::SecretData key, uint32_t tag_size)
-      : key_(std::move(key)), tag_size_(tag_size) {}
+  AesCmacBoringSsl(std::unique_ptr<Prf> prf, uint32_t tag_size)
+      : prf_(std::move(prf)), tag_size_(tag_size) {}
 
-  const util::SecretData key_;
+  const std::unique_ptr<Prf> prf_;
   const uint32_t tag_size_;
 };
 
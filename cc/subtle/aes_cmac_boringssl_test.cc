@@ -17,11 +17,17 @@
 #include "tink/subtle/aes_cmac_boringssl.h"
 
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/config/tink_fips.h"
 #include "tink/mac.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/random.h"
+#include "tink/util/allocation_counter.h"
+#include "tink/util/inlined_buffer.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -33,6 +39,7 @@ namespace tink {
 namespace subtle {
 namespace {
 
+using ::crypto::tink::test::IsOk;
 using ::crypto::tink::test::StatusIs;
 
 constexpr uint32_t kTagSize = 16;
@@ -272,6 +279,89 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_pair(40, "dfa66747de9ae63030ca32611497c827"),
         std::make_pair(64, "51f0bebf7e3b9d92fc49741779363cfe")));
 
+TEST(AesCmacBoringSslTest, ComputeMacs) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  for (int key_size : {16, 32}) {
+    auto cmac_result =
+        AesCmacBoringSsl::New(Random::GetRandomKeyBytes(key_size),
+                              kSmallTagSize);
+    ASSERT_THAT(cmac_result.status(), IsOk());
+    const Mac& cmac = *cmac_result.ValueOrDie();
+    // More messages than are interleaved, of sizes around the block size.
+    std::vector<std::string> messages;
+    for (int size : {0, 1, 15, 16, 17, 31, 32, 33, 100, 1000, 0, 16}) {
+      messages.push_back(Random::GetRandomBytes(size));
+    }
+    std::vector<absl::string_view> data(messages.begin(), messages.end());
+    auto macs_result = cmac.ComputeMacs(data);
+    ASSERT_THAT(macs_result.status(), IsOk());
+    ASSERT_EQ(data.size(), macs_result.ValueOrDie().size());
+    for (size_t i = 0; i < data.size(); i++) {
+      EXPECT_EQ(cmac.ComputeMac(data[i]).ValueOrDie(),
+                macs_result.ValueOrDie()[i]);
+      EXPECT_THAT(cmac.VerifyMac(macs_result.ValueOrDie()[i], data[i]),
+                  IsOk());
+    }
+    auto empty_result = cmac.ComputeMacs({});
+    ASSERT_THAT(empty_result.status(), IsOk());
+    EXPECT_TRUE(empty_result.ValueOrDie().empty());
+  }
+}
+
+TEST(AesCmacBoringSslTest, ComputeMacInto) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto cmac_result =
+      AesCmacBoringSsl::New(Random::GetRandomKeyBytes(16), kSmallTagSize);
+  ASSERT_THAT(cmac_result.status(), IsOk());
+  const AesCmacBoringSsl& cmac =
+      static_cast<const AesCmacBoringSsl&>(*cmac_result.ValueOrDie());
+  std::string data = "Some data to test.";
+  uint8_t tag[kSmallTagSize + 1] = {0};
+  auto written_result = cmac.ComputeMacInto(data, absl::MakeSpan(tag));
+  ASSERT_THAT(written_result.status(), IsOk());
+  EXPECT_EQ(kSmallTagSize, written_result.ValueOrDie());
+  EXPECT_EQ(cmac.ComputeMac(data).ValueOrDie(),
+            std::string(reinterpret_cast<char*>(tag), kSmallTagSize));
+  EXPECT_EQ(0, tag[kSmallTagSize]);
+  EXPECT_THAT(cmac.VerifyMac(absl::MakeConstSpan(tag, kSmallTagSize), data),
+              IsOk());
+  tag[0] ^= 1;
+  EXPECT_THAT(cmac.VerifyMac(absl::MakeConstSpan(tag, kSmallTagSize), data),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(
+      cmac.ComputeMacInto(data, absl::MakeSpan(tag, kSmallTagSize - 1))
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(AesCmacBoringSslTest, AllocationBudget) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto cmac_result =
+      AesCmacBoringSsl::New(Random::GetRandomKeyBytes(16), kTagSize);
+  ASSERT_THAT(cmac_result.status(), IsOk());
+  const Mac& cmac = *cmac_result.ValueOrDie();
+  std::string data = "Some data to test.";
+
+  util::InlinedBuffer<32> tag;
+  test::AllocationCounter counter;
+  util::Status status = cmac.ComputeMac(data, &tag);
+  int64_t allocations = counter.count();
+  ASSERT_THAT(status, IsOk());
+  EXPECT_EQ(allocations, 0);
+
+  counter.Reset();
+  status = cmac.VerifyMac(tag.AsStringView(), data);
+  allocations = counter.count();
+  EXPECT_THAT(status, IsOk());
+  EXPECT_EQ(allocations, 0);
+}
+
 TEST(AesCmacBoringSslTest, TestFipsOnly) {
   if (!kUseOnlyFips) {
     GTEST_SKIP() << "Only supported in FIPS-only mode";
@@ -16,9 +16,11 @@
 
 #include "tink/subtle/aes_ctr_boringssl.h"
 
+#include <cstring>
 #include <string>
 
 #include "absl/memory/memory.h"
+#include "absl/types/span.h"
 #include "openssl/evp.h"
 #include "tink/config/tink_fips.h"
 #include "tink/subtle/random.h"
@@ -43,8 +45,29 @@ util::StatusOr<std::unique_ptr<IndCpaCipher>> AesCtrBoringSsl::New(
   if (iv_size < kMinIvSizeInBytes || iv_size > kBlockSize) {
     return util::Status(util::error::INVALID_ARGUMENT, "invalid iv size");
   }
-  return {
-      absl::WrapUnique(new AesCtrBoringSsl(std::move(key), iv_size, cipher))};
+  bssl::UniquePtr<EVP_CIPHER_CTX> keyed_ctx(EVP_CIPHER_CTX_new());
+  if (keyed_ctx == nullptr ||
+      EVP_EncryptInit_ex(keyed_ctx.get(), cipher, nullptr /* engine */,
+                         key.data(), nullptr /* iv */) != 1) {
+    return util::Status(util::error::INTERNAL, "could not initialize ctx");
+  }
+  return {absl::WrapUnique(
+      new AesCtrBoringSsl(iv_size, std::move(keyed_ctx)))};
+}
+
+util::StatusOr<bssl::UniquePtr<EVP_CIPHER_CTX>> AesCtrBoringSsl::NewContext(
+    absl::string_view iv) const {
+  // OpenSSL expects that the IV must be a full block. We pad with zeros.
+  // Note that kBlockSize >= iv_size_ is checked in the factory method.
+  uint8_t iv_block[kBlockSize] = {0};
+  std::memcpy(iv_block, iv.data(), iv_size_);
+  bssl::UniquePtr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new());
+  if (ctx == nullptr || !EVP_CIPHER_CTX_copy(ctx.get(), keyed_ctx_.get()) ||
+      EVP_EncryptInit_ex(ctx.get(), nullptr, nullptr, nullptr, iv_block) !=
+          1) {
+    return util::Status(util::error::INTERNAL, "could not initialize ctx");
+  }
+  return std::move(ctx);
 }
 
 util::StatusOr<std::string> AesCtrBoringSsl::Encrypt(
@@ -53,29 +76,19 @@ util::StatusOr<std::string> AesCtrBoringSsl::Encrypt(
   // the size is 0.
   plaintext = SubtleUtilBoringSSL::EnsureNonNull(plaintext);
 
-  bssl::UniquePtr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new());
-  if (ctx.get() == nullptr) {
-    return util::Status(util::error::INTERNAL,
-                        "could not initialize EVP_CIPHER_CTX");
-  }
-  std::string ciphertext = Random::GetRandomBytes(iv_size_);
-  // OpenSSL expects that the IV must be a full block. We pad with zeros.
-  std::string iv_block = ciphertext;
-  // Note that kBlockSize >= iv_size_ is checked in the factory method.
-  // We explicitly add the '\0' argument to stress that we need to initialize
-  // the new memory.
-  iv_block.resize(kBlockSize, '\0');
-
-  int ret =
-      EVP_EncryptInit_ex(ctx.get(), cipher_, nullptr /* engine */, key_.data(),
-                         reinterpret_cast<const uint8_t*>(&iv_block[0]));
-  if (ret != 1) {
-    return util::Status(util::error::INTERNAL, "could not initialize ctx");
-  }
+  // The IV is drawn directly into the front of the ciphertext.
+  std::string ciphertext;
   ResizeStringUninitialized(&ciphertext, iv_size_ + plaintext.size());
+  auto status =
+      Random::GetRandomBytes(absl::MakeSpan(&ciphertext[0], iv_size_));
+  if (!status.ok()) return status;
+
+  auto ctx_or = NewContext(absl::string_view(ciphertext.data(), iv_size_));
+  if (!ctx_or.ok()) return ctx_or.status();
   int len;
-  ret = EVP_EncryptUpdate(
-      ctx.get(), reinterpret_cast<uint8_t*>(&ciphertext[iv_size_]), &len,
+  int ret = EVP_EncryptUpdate(
+      ctx_or.ValueOrDie().get(),
+      reinterpret_cast<uint8_t*>(&ciphertext[iv_size_]), &len,
       reinterpret_cast<const uint8_t*>(plaintext.data()), plaintext.size());
   if (ret != 1) {
     return util::Status(util::error::INTERNAL, "encryption failed");
@@ -83,7 +96,7 @@ util::StatusOr<std::string> AesCtrBoringSsl::Encrypt(
   if (len != plaintext.size()) {
     return util::Status(util::error::INTERNAL, "incorrect ciphertext size");
   }
-  return ciphertext;
+  return std::move(ciphertext);
 }
 
 util::StatusOr<std::string> AesCtrBoringSsl::Decrypt(
@@ -92,31 +105,17 @@ util::StatusOr<std::string> AesCtrBoringSsl::Decrypt(
     return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too short");
   }
 
-  bssl::UniquePtr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new());
-  if (ctx.get() == nullptr) {
-    return util::Status(util::error::INTERNAL,
-                        "could not initialize EVP_CIPHER_CTX");
-  }
-
-  // Initialise key and IV
-  std::string iv_block = std::string(ciphertext.substr(0, iv_size_));
-  iv_block.resize(kBlockSize, '\0');
-  int ret = EVP_DecryptInit_ex(ctx.get(), cipher_, nullptr /* engine */,
-                               reinterpret_cast<const uint8_t*>(key_.data()),
-                               reinterpret_cast<const uint8_t*>(&iv_block[0]));
-  if (ret != 1) {
-    return util::Status(util::error::INTERNAL,
-                        "could not initialize key or iv");
-  }
+  auto ctx_or = NewContext(ciphertext.substr(0, iv_size_));
+  if (!ctx_or.ok()) return ctx_or.status();
 
   size_t plaintext_size = ciphertext.size() - iv_size_;
   std::string plaintext;
   ResizeStringUninitialized(&plaintext, plaintext_size);
-  size_t read = iv_size_;
+  // AES-CTR decryption is the same operation as encryption.
   int len;
-  ret = EVP_DecryptUpdate(
-      ctx.get(), reinterpret_cast<uint8_t*>(&plaintext[0]), &len,
-      reinterpret_cast<const uint8_t*>(&ciphertext.data()[read]),
+  int ret = EVP_EncryptUpdate(
+      ctx_or.ValueOrDie().get(), reinterpret_cast<uint8_t*>(&plaintext[0]),
+      &len, reinterpret_cast<const uint8_t*>(&ciphertext.data()[iv_size_]),
       plaintext_size);
   if (ret != 1) {
     return util::Status(util::error::INTERNAL, "decryption failed");
@@ -125,7 +124,7 @@ util::StatusOr<std::string> AesCtrBoringSsl::Decrypt(
   if (len != plaintext_size) {
     return util::Status(util::error::INTERNAL, "incorrect plaintext size");
   }
-  return plaintext;
+  return std::move(plaintext);
 }
 
 }  // namespace subtle
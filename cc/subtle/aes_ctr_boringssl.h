@@ -20,6 +20,8 @@
 #include <memory>
 #include <utility>
 
+#include "absl/strings/string_view.h"
+#include "openssl/base.h"
 #include "openssl/evp.h"
 #include "tink/config/tink_fips.h"
 #include "tink/subtle/ind_cpa_cipher.h"
@@ -48,13 +50,18 @@ class AesCtrBoringSsl : public IndCpaCipher {
   static constexpr int kMinIvSizeInBytes = 12;
   static constexpr int kBlockSize = 16;
 
-  AesCtrBoringSsl(util::SecretData key, int iv_size, const EVP_CIPHER* cipher)
-      : key_(std::move(key)), iv_size_(iv_size), cipher_(cipher) {}
+  AesCtrBoringSsl(int iv_size, bssl::UniquePtr<EVP_CIPHER_CTX> keyed_ctx)
+      : iv_size_(iv_size), keyed_ctx_(std::move(keyed_ctx)) {}
+
+  // Returns a copy of keyed_ctx_ with the counter block set to 'iv', which
+  // is zero padded to a full block.
+  crypto::tink::util::StatusOr<bssl::UniquePtr<EVP_CIPHER_CTX>> NewContext(
+      absl::string_view iv) const;
 
-  const util::SecretData key_;
   const int iv_size_;
-  // cipher_ is a singleton owned by BoringSsl.
-  const EVP_CIPHER *cipher_;
+  // Holds the expanded key, but no counter block.  Copied for each message so
+  // that the key schedule is computed only once.
+  const bssl::UniquePtr<EVP_CIPHER_CTX> keyed_ctx_;
 };
 
 }  // namespace subtle
@@ -0,0 +1,243 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_ctr_hmac_boringssl.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/types/span.h"
+#include "openssl/cipher.h"
+#include "openssl/crypto.h"
+#include "openssl/evp.h"
+#include "openssl/hmac.h"
+#include "openssl/mem.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+// The chunk size: the input, the output and the hash state of a chunk fit in
+// the L1 data cache together.
+constexpr size_t kChunkSize = 4096;
+
+}  // namespace
+
+// static
+util::Status AesCtrHmacBoringSsl::CtrEncryptAndMac(
+    EVP_CIPHER_CTX* cipher_ctx, HMAC_CTX* hmac_ctx,
+    absl::Span<const uint8_t> in, uint8_t* out) {
+  for (size_t pos = 0; pos < in.size(); pos += kChunkSize) {
+    size_t chunk_size = std::min(kChunkSize, in.size() - pos);
+    int len;
+    if (EVP_EncryptUpdate(cipher_ctx, out + pos, &len, in.data() + pos,
+                          chunk_size) != 1 ||
+        len != chunk_size) {
+      return util::Status(util::error::INTERNAL, "AES-CTR failed");
+    }
+    if (!HMAC_Update(hmac_ctx, out + pos, chunk_size)) {
+      return util::Status(util::error::INTERNAL, "HMAC update failed");
+    }
+  }
+  return util::OkStatus();
+}
+
+// static
+util::Status AesCtrHmacBoringSsl::MacAndCtrDecrypt(
+    EVP_CIPHER_CTX* cipher_ctx, HMAC_CTX* hmac_ctx,
+    absl::Span<const uint8_t> in, uint8_t* out) {
+  for (size_t pos = 0; pos < in.size(); pos += kChunkSize) {
+    size_t chunk_size = std::min(kChunkSize, in.size() - pos);
+    // Hash before decrypting, which may overwrite the chunk.
+    if (!HMAC_Update(hmac_ctx, in.data() + pos, chunk_size)) {
+      return util::Status(util::error::INTERNAL, "HMAC update failed");
+    }
+    // AES-CTR decryption is the same operation as encryption.
+    int len;
+    if (EVP_EncryptUpdate(cipher_ctx, out + pos, &len, in.data() + pos,
+                          chunk_size) != 1 ||
+        len != chunk_size) {
+      return util::Status(util::error::INTERNAL, "AES-CTR failed");
+    }
+  }
+  return util::OkStatus();
+}
+
+util::StatusOr<std::unique_ptr<Aead>> AesCtrHmacBoringSsl::New(
+    const util::SecretData& aes_key, int iv_size, HashType hmac_hash_type,
+    const util::SecretData& hmac_key, uint32_t tag_size) {
+  auto status = CheckFipsCompatibility<AesCtrHmacBoringSsl>();
+  if (!status.ok()) return status;
+
+  const EVP_CIPHER* cipher =
+      SubtleUtilBoringSSL::GetAesCtrCipherForKeySize(aes_key.size());
+  if (cipher == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
+  }
+  if (iv_size < kMinIvSizeInBytes || iv_size > kBlockSize) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid iv size");
+  }
+  util::StatusOr<const EVP_MD*> md_or =
+      SubtleUtilBoringSSL::EvpHash(hmac_hash_type);
+  if (!md_or.ok()) return md_or.status();
+  if (tag_size < kMinTagSizeInBytes ||
+      tag_size > EVP_MD_size(md_or.ValueOrDie())) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid tag size");
+  }
+  if (hmac_key.size() < kMinHmacKeySizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "invalid HMAC key size");
+  }
+
+  bssl::UniquePtr<EVP_CIPHER_CTX> cipher_ctx(EVP_CIPHER_CTX_new());
+  if (cipher_ctx == nullptr ||
+      EVP_EncryptInit_ex(cipher_ctx.get(), cipher, nullptr /* engine */,
+                         aes_key.data(), nullptr /* iv */) != 1) {
+    return util::Status(util::error::INTERNAL, "could not initialize ctx");
+  }
+  bssl::UniquePtr<HMAC_CTX> hmac_ctx(HMAC_CTX_new());
+  if (hmac_ctx == nullptr ||
+      !HMAC_Init_ex(hmac_ctx.get(), hmac_key.data(), hmac_key.size(),
+                    md_or.ValueOrDie(), nullptr /* engine */)) {
+    return util::Status(util::error::INTERNAL, "HMAC initialization failed");
+  }
+  return {absl::WrapUnique(new AesCtrHmacBoringSsl(
+      iv_size, tag_size, std::move(cipher_ctx), std::move(hmac_ctx)))};
+}
+
+util::Status AesCtrHmacBoringSsl::InitOperation(
+    absl::string_view iv, absl::string_view additional_data,
+    EVP_CIPHER_CTX* cipher_ctx, HMAC_CTX* hmac_ctx) const {
+  // OpenSSL expects that the IV must be a full block. We pad with zeros.
+  uint8_t iv_block[kBlockSize] = {0};
+  std::memcpy(iv_block, iv.data(), iv_size_);
+  if (!EVP_CIPHER_CTX_copy(cipher_ctx, cipher_ctx_.get()) ||
+      EVP_EncryptInit_ex(cipher_ctx, nullptr, nullptr, nullptr, iv_block) !=
+          1) {
+    return util::Status(util::error::INTERNAL, "could not initialize ctx");
+  }
+  additional_data = SubtleUtilBoringSSL::EnsureNonNull(additional_data);
+  if (!HMAC_CTX_copy_ex(hmac_ctx, hmac_ctx_.get()) ||
+      !HMAC_Update(hmac_ctx,
+                   reinterpret_cast<const uint8_t*>(additional_data.data()),
+                   additional_data.size()) ||
+      !HMAC_Update(hmac_ctx, reinterpret_cast<const uint8_t*>(iv.data()),
+                   iv.size())) {
+    return util::Status(util::error::INTERNAL, "HMAC update failed");
+  }
+  return util::OkStatus();
+}
+
+util::Status AesCtrHmacBoringSsl::FinalizeTag(
+    absl::string_view additional_data, HMAC_CTX* hmac_ctx,
+    uint8_t* tag) const {
+  uint64_t aad_size_in_bits =
+      static_cast<uint64_t>(additional_data.size()) * 8;
+  uint8_t encoded_size[8];
+  for (int i = sizeof(encoded_size) - 1; i >= 0; i--) {
+    encoded_size[i] = aad_size_in_bits & 0xff;
+    aad_size_in_bits >>= 8;
+  }
+  unsigned int tag_len;
+  if (!HMAC_Update(hmac_ctx, encoded_size, sizeof(encoded_size)) ||
+      !HMAC_Final(hmac_ctx, tag, &tag_len)) {
+    return util::Status(util::error::INTERNAL, "HMAC finalization failed");
+  }
+  return util::OkStatus();
+}
+
+util::StatusOr<std::string> AesCtrHmacBoringSsl::Encrypt(
+    absl::string_view plaintext, absl::string_view additional_data) const {
+  // BoringSSL expects a non-null pointer for plaintext, regardless of whether
+  // the size is 0.
+  plaintext = SubtleUtilBoringSSL::EnsureNonNull(plaintext);
+  if (additional_data.size() > UINT64_MAX / 8) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "additional data too long");
+  }
+
+  // The IV is drawn directly into the front of the ciphertext.
+  std::string ciphertext;
+  ResizeStringUninitialized(&ciphertext,
+                            iv_size_ + plaintext.size() + tag_size_);
+  auto status =
+      Random::GetRandomBytes(absl::MakeSpan(&ciphertext[0], iv_size_));
+  if (!status.ok()) return status;
+  uint8_t* out = reinterpret_cast<uint8_t*>(&ciphertext[0]);
+
+  bssl::ScopedEVP_CIPHER_CTX cipher_ctx;
+  bssl::ScopedHMAC_CTX hmac_ctx;
+  status = InitOperation(absl::string_view(ciphertext.data(), iv_size_),
+                         additional_data, cipher_ctx.get(), hmac_ctx.get());
+  if (!status.ok()) return status;
+  status = CtrEncryptAndMac(
+      cipher_ctx.get(), hmac_ctx.get(),
+      absl::MakeSpan(reinterpret_cast<const uint8_t*>(plaintext.data()),
+                     plaintext.size()),
+      out + iv_size_);
+  if (!status.ok()) return status;
+  uint8_t tag[EVP_MAX_MD_SIZE];
+  status = FinalizeTag(additional_data, hmac_ctx.get(), tag);
+  if (!status.ok()) return status;
+  std::memcpy(out + iv_size_ + plaintext.size(), tag, tag_size_);
+  return std::move(ciphertext);
+}
+
+util::StatusOr<std::string> AesCtrHmacBoringSsl::Decrypt(
+    absl::string_view ciphertext, absl::string_view additional_data) const {
+  if (ciphertext.size() < iv_size_ + tag_size_) {
+    return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too short");
+  }
+  if (additional_data.size() > UINT64_MAX / 8) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "additional data too long");
+  }
+  size_t plaintext_size = ciphertext.size() - iv_size_ - tag_size_;
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(ciphertext.data());
+
+  bssl::ScopedEVP_CIPHER_CTX cipher_ctx;
+  bssl::ScopedHMAC_CTX hmac_ctx;
+  auto status = InitOperation(ciphertext.substr(0, iv_size_), additional_data,
+                              cipher_ctx.get(), hmac_ctx.get());
+  if (!status.ok()) return status;
+  std::string plaintext;
+  ResizeStringUninitialized(&plaintext, plaintext_size);
+  uint8_t* out = reinterpret_cast<uint8_t*>(&plaintext[0]);
+  status = MacAndCtrDecrypt(cipher_ctx.get(), hmac_ctx.get(),
+                            absl::MakeSpan(in + iv_size_, plaintext_size), out);
+  if (!status.ok()) return status;
+  uint8_t tag[EVP_MAX_MD_SIZE];
+  status = FinalizeTag(additional_data, hmac_ctx.get(), tag);
+  if (!status.ok()) return status;
+  if (CRYPTO_memcmp(tag, in + iv_size_ + plaintext_size, tag_size_) != 0) {
+    OPENSSL_cleanse(out, plaintext_size);
+    return util::Status(util::error::INVALID_ARGUMENT, "verification failed");
+  }
+  return std::move(plaintext);
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
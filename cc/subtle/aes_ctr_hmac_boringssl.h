@@ -0,0 +1,117 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_AES_CTR_HMAC_BORINGSSL_H_
+#define TINK_SUBTLE_AES_CTR_HMAC_BORINGSSL_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/base.h"
+#include "openssl/evp.h"
+#include "openssl/hmac.h"
+#include "tink/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// AES-CTR-HMAC as EncryptThenAuthenticate over AesCtrBoringSsl and
+// HmacBoringSsl computes it, with identical ciphertexts: the tag is the HMAC
+// of (aad || iv || ciphertext || aad size in bits), and the result is
+// (iv || ciphertext || tag).
+//
+// Instead of encrypting the whole message and then hashing it, the message is
+// processed in chunks which are encrypted and immediately hashed while they
+// are still in the L1 cache.  Both keys are set up once, in New().
+class AesCtrHmacBoringSsl : public Aead {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
+      const util::SecretData& aes_key, int iv_size, HashType hmac_hash_type,
+      const util::SecretData& hmac_key, uint32_t tag_size);
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view additional_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view additional_data) const override;
+
+  // Encrypts 'in' with 'cipher_ctx', which is initialized with the key and the
+  // counter block, into 'out', and feeds the ciphertext to 'hmac_ctx' chunk by
+  // chunk.  'out' may be equal to in.data().
+  static crypto::tink::util::Status CtrEncryptAndMac(
+      EVP_CIPHER_CTX* cipher_ctx, HMAC_CTX* hmac_ctx,
+      absl::Span<const uint8_t> in, uint8_t* out);
+
+  // Feeds the ciphertext 'in' to 'hmac_ctx' and decrypts it with 'cipher_ctx'
+  // into 'out' chunk by chunk.  'out' may be equal to in.data().  The caller
+  // must erase 'out' if the tag does not verify.
+  static crypto::tink::util::Status MacAndCtrDecrypt(
+      EVP_CIPHER_CTX* cipher_ctx, HMAC_CTX* hmac_ctx,
+      absl::Span<const uint8_t> in, uint8_t* out);
+
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kRequiresBoringCrypto;
+
+ private:
+  static constexpr int kMinIvSizeInBytes = 12;
+  static constexpr int kMinTagSizeInBytes = 10;
+  static constexpr int kMinHmacKeySizeInBytes = 16;
+  static constexpr int kBlockSize = 16;
+
+  AesCtrHmacBoringSsl(int iv_size, uint32_t tag_size,
+                      bssl::UniquePtr<EVP_CIPHER_CTX> cipher_ctx,
+                      bssl::UniquePtr<HMAC_CTX> hmac_ctx)
+      : iv_size_(iv_size),
+        tag_size_(tag_size),
+        cipher_ctx_(std::move(cipher_ctx)),
+        hmac_ctx_(std::move(hmac_ctx)) {}
+
+  // Copies the keyed contexts and starts the tag with the additional data and
+  // the IV.  'iv' must have iv_size_ bytes.
+  crypto::tink::util::Status InitOperation(
+      absl::string_view iv, absl::string_view additional_data,
+      EVP_CIPHER_CTX* cipher_ctx, HMAC_CTX* hmac_ctx) const;
+
+  // Completes the tag with the size of the additional data into 'tag', which
+  // must have room for EVP_MAX_MD_SIZE bytes.
+  crypto::tink::util::Status FinalizeTag(absl::string_view additional_data,
+                                         HMAC_CTX* hmac_ctx,
+                                         uint8_t* tag) const;
+
+  const int iv_size_;
+  const uint32_t tag_size_;
+  // Keyed with the AES key but without counter block; copied per operation.
+  const bssl::UniquePtr<EVP_CIPHER_CTX> cipher_ctx_;
+  // Keyed with the HMAC key; copied per operation.
+  const bssl::UniquePtr<HMAC_CTX> hmac_ctx_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_AES_CTR_HMAC_BORINGSSL_H_
@@ -0,0 +1,142 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_ctr_hmac_boringssl.h"
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/aes_ctr_boringssl.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/encrypt_then_authenticate.h"
+#include "tink/subtle/hmac_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+using ::testing::Not;
+
+// Returns EncryptThenAuthenticate over AesCtrBoringSsl and HmacBoringSsl,
+// whose ciphertexts AesCtrHmacBoringSsl must reproduce.
+std::unique_ptr<Aead> NewReference(const util::SecretData& aes_key,
+                                   int iv_size, HashType hash_type,
+                                   const util::SecretData& hmac_key,
+                                   int tag_size) {
+  auto ctr = AesCtrBoringSsl::New(aes_key, iv_size);
+  EXPECT_THAT(ctr.status(), IsOk());
+  auto hmac = HmacBoringSsl::New(hash_type, tag_size, hmac_key);
+  EXPECT_THAT(hmac.status(), IsOk());
+  auto aead = EncryptThenAuthenticate::New(std::move(ctr.ValueOrDie()),
+                                           std::move(hmac.ValueOrDie()),
+                                           tag_size);
+  EXPECT_THAT(aead.status(), IsOk());
+  return std::move(aead.ValueOrDie());
+}
+
+TEST(AesCtrHmacBoringSslTest, MatchesEncryptThenAuthenticate) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::SecretData aes_key = Random::GetRandomKeyBytes(32);
+  util::SecretData hmac_key = Random::GetRandomKeyBytes(32);
+  for (int iv_size : {12, 16}) {
+    auto aead_or =
+        AesCtrHmacBoringSsl::New(aes_key, iv_size, SHA256, hmac_key, 16);
+    ASSERT_THAT(aead_or.status(), IsOk());
+    const Aead& aead = *aead_or.ValueOrDie();
+    std::unique_ptr<Aead> reference =
+        NewReference(aes_key, iv_size, SHA256, hmac_key, 16);
+    // Sizes around the chunk size of the stitched loop.
+    for (int size : {0, 1, 16, 4095, 4096, 4097, 3 * 4096 + 5}) {
+      std::string message = Random::GetRandomBytes(size);
+      std::string aad = Random::GetRandomBytes(size % 17);
+      auto ct = aead.Encrypt(message, aad);
+      ASSERT_THAT(ct.status(), IsOk());
+      EXPECT_THAT(ct.ValueOrDie().size(), Eq(iv_size + size + 16));
+      auto pt = reference->Decrypt(ct.ValueOrDie(), aad);
+      ASSERT_THAT(pt.status(), IsOk());
+      EXPECT_THAT(pt.ValueOrDie(), Eq(message));
+
+      ct = reference->Encrypt(message, aad);
+      ASSERT_THAT(ct.status(), IsOk());
+      pt = aead.Decrypt(ct.ValueOrDie(), aad);
+      ASSERT_THAT(pt.status(), IsOk());
+      EXPECT_THAT(pt.ValueOrDie(), Eq(message));
+    }
+  }
+}
+
+TEST(AesCtrHmacBoringSslTest, Modification) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto aead_or =
+      AesCtrHmacBoringSsl::New(Random::GetRandomKeyBytes(16), 16, SHA1,
+                               Random::GetRandomKeyBytes(16), 10);
+  ASSERT_THAT(aead_or.status(), IsOk());
+  const Aead& aead = *aead_or.ValueOrDie();
+  std::string message = Random::GetRandomBytes(5000);
+  auto ct_or = aead.Encrypt(message, "aad");
+  ASSERT_THAT(ct_or.status(), IsOk());
+  std::string ct = ct_or.ValueOrDie();
+  for (size_t i = 0; i < ct.size(); i += 499) {
+    std::string modified = ct;
+    modified[i] ^= 1;
+    EXPECT_THAT(aead.Decrypt(modified, "aad").status(),
+                StatusIs(util::error::INVALID_ARGUMENT));
+  }
+  EXPECT_THAT(aead.Decrypt(ct, "aae").status(), Not(IsOk()));
+  EXPECT_THAT(aead.Decrypt(ct.substr(0, 25), "aad").status(), Not(IsOk()));
+}
+
+TEST(AesCtrHmacBoringSslTest, InvalidParameters) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::SecretData key = Random::GetRandomKeyBytes(16);
+  EXPECT_THAT(AesCtrHmacBoringSsl::New(Random::GetRandomKeyBytes(24), 16,
+                                       SHA256, key, 16)
+                  .status(),
+              Not(IsOk()));
+  EXPECT_THAT(AesCtrHmacBoringSsl::New(key, 11, SHA256, key, 16).status(),
+              Not(IsOk()));
+  EXPECT_THAT(AesCtrHmacBoringSsl::New(key, 16, SHA256, key, 9).status(),
+              Not(IsOk()));
+  EXPECT_THAT(AesCtrHmacBoringSsl::New(key, 16, SHA1, key, 21).status(),
+              Not(IsOk()));
+  EXPECT_THAT(AesCtrHmacBoringSsl::New(key, 16, SHA256,
+                                       Random::GetRandomKeyBytes(15), 16)
+                  .status(),
+              Not(IsOk()));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -21,13 +21,16 @@
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/base.h"
 #include "openssl/cipher.h"
 #include "openssl/err.h"
 #include "openssl/evp.h"
+#include "openssl/hmac.h"
+#include "openssl/mem.h"
+#include "tink/subtle/aes_ctr_hmac_boringssl.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/hkdf.h"
-#include "tink/subtle/hmac_boringssl.h"
 #include "tink/subtle/random.h"
 #include "tink/subtle/stream_segment_decrypter.h"
 #include "tink/subtle/stream_segment_encrypter.h"
@@ -69,6 +72,75 @@ static util::Status DeriveKeys(const util::SecretData& ikm, HashType hkdf_algo,
   return util::OkStatus();
 }
 
+// Returns an AES-CTR context for 'key_value'. The key is expanded once here;
+// segments only set their nonce on a copy of this context.
+static util::StatusOr<bssl::UniquePtr<EVP_CIPHER_CTX>> NewCipherContext(
+    const util::SecretData& key_value) {
+  const EVP_CIPHER* cipher =
+      SubtleUtilBoringSSL::GetAesCtrCipherForKeySize(key_value.size());
+  if (cipher == nullptr) {
+    return util::Status(util::error::INTERNAL, "invalid key size");
+  }
+  bssl::UniquePtr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new());
+  if (ctx == nullptr ||
+      EVP_EncryptInit_ex(ctx.get(), cipher, nullptr /* engine */,
+                         reinterpret_cast<const uint8_t*>(key_value.data()),
+                         nullptr /* iv */) != 1) {
+    return util::Status(util::error::INTERNAL, "could not initialize ctx");
+  }
+  return {std::move(ctx)};
+}
+
+// Returns an HMAC context keyed with 'hmac_key_value', to be copied for each
+// segment.
+static util::StatusOr<bssl::UniquePtr<HMAC_CTX>> NewHmacContext(
+    HashType tag_algo, const util::SecretData& hmac_key_value) {
+  auto md_result = SubtleUtilBoringSSL::EvpHash(tag_algo);
+  if (!md_result.ok()) return md_result.status();
+  bssl::UniquePtr<HMAC_CTX> ctx(HMAC_CTX_new());
+  if (ctx == nullptr ||
+      !HMAC_Init_ex(ctx.get(), hmac_key_value.data(), hmac_key_value.size(),
+                    md_result.ValueOrDie(), nullptr /* engine */)) {
+    return util::Status(util::error::INTERNAL,
+                        "BoringSSL failed to initialize HMAC");
+  }
+  return {std::move(ctx)};
+}
+
+// Sets up 'cipher_ctx' and 'hmac_ctx' for one segment: copies of the keyed
+// 'keyed_cipher_ctx' and 'keyed_hmac_ctx', with the initial counter block
+// 'nonce', and with 'nonce' already fed to the MAC.
+static util::Status InitSegment(const EVP_CIPHER_CTX* keyed_cipher_ctx,
+                                const HMAC_CTX* keyed_hmac_ctx,
+                                absl::string_view nonce,
+                                EVP_CIPHER_CTX* cipher_ctx,
+                                HMAC_CTX* hmac_ctx) {
+  if (!EVP_CIPHER_CTX_copy(cipher_ctx, keyed_cipher_ctx) ||
+      EVP_EncryptInit_ex(cipher_ctx, nullptr, nullptr, nullptr,
+                         reinterpret_cast<const uint8_t*>(nonce.data())) !=
+          1) {
+    return util::Status(util::error::INTERNAL, "could not initialize ctx");
+  }
+  if (!HMAC_CTX_copy_ex(hmac_ctx, keyed_hmac_ctx) ||
+      !HMAC_Update(hmac_ctx, reinterpret_cast<const uint8_t*>(nonce.data()),
+                   nonce.size())) {
+    return util::Status(util::error::INTERNAL,
+                        "BoringSSL failed to compute HMAC");
+  }
+  return util::OkStatus();
+}
+
+// Writes the untruncated HMAC into 'tag', which must have room for
+// EVP_MAX_MD_SIZE bytes.
+static util::Status FinalizeTag(HMAC_CTX* hmac_ctx, uint8_t* tag) {
+  unsigned int tag_len;
+  if (!HMAC_Final(hmac_ctx, tag, &tag_len)) {
+    return util::Status(util::error::INTERNAL,
+                        "BoringSSL failed to compute HMAC");
+  }
+  return util::OkStatus();
+}
+
 static util::Status Validate(const AesCtrHmacStreaming::Params& params) {
   if (params.ikm.size() < std::max(16, params.key_size)) {
     return util::Status(util::error::INVALID_ARGUMENT,
@@ -128,6 +200,13 @@ AesCtrHmacStreaming::NewSegmentEncrypter(
   return AesCtrHmacStreamSegmentEncrypter::New(params_, associated_data);
 }
 
+util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+AesCtrHmacStreaming::NewSegmentEncrypterForHeader(
+    absl::string_view header, absl::string_view associated_data) const {
+  return AesCtrHmacStreamSegmentEncrypter::NewForHeader(params_, header,
+                                                        associated_data);
+}
+
 // static
 util::StatusOr<std::unique_ptr<StreamSegmentDecrypter>>
 AesCtrHmacStreaming::NewSegmentDecrypter(
@@ -153,7 +232,25 @@ AesCtrHmacStreamSegmentEncrypter::New(const AesCtrHmacStreaming::Params& params,
   std::string salt = Random::GetRandomBytes(params.key_size);
   std::string nonce_prefix =
       Random::GetRandomBytes(AesCtrHmacStreaming::kNoncePrefixSizeInBytes);
-  std::string header = MakeHeader(salt, nonce_prefix);
+  return NewForHeader(params, MakeHeader(salt, nonce_prefix), associated_data);
+}
+
+// static
+util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+AesCtrHmacStreamSegmentEncrypter::NewForHeader(
+    const AesCtrHmacStreaming::Params& params, absl::string_view header,
+    absl::string_view associated_data) {
+  auto status = Validate(params);
+  if (!status.ok()) return status;
+
+  int header_size =
+      1 + params.key_size + AesCtrHmacStreaming::kNoncePrefixSizeInBytes;
+  if (header.size() != static_cast<size_t>(header_size) ||
+      static_cast<uint8_t>(header[0]) != header_size) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid header");
+  }
+  absl::string_view salt = header.substr(1, params.key_size);
+  absl::string_view nonce_prefix = header.substr(1 + params.key_size);
 
   util::SecretData key_value;
   util::SecretData hmac_key_value;
@@ -161,25 +258,31 @@ AesCtrHmacStreamSegmentEncrypter::New(const AesCtrHmacStreaming::Params& params,
                       params.key_size, &key_value, &hmac_key_value);
   if (!status.ok()) return status;
 
-  auto cipher = SubtleUtilBoringSSL::GetAesCtrCipherForKeySize(params.key_size);
-  if (cipher == nullptr) {
-    return util::Status(util::error::INTERNAL, "invalid key size");
-  }
-
-  auto hmac_result = HmacBoringSsl::New(params.tag_algo, params.tag_size,
-                                        std::move(hmac_key_value));
-  if (!hmac_result.ok()) return hmac_result.status();
-  auto mac = std::move(hmac_result.ValueOrDie());
+  auto cipher_ctx_result = NewCipherContext(key_value);
+  if (!cipher_ctx_result.ok()) return cipher_ctx_result.status();
+  auto hmac_ctx_result = NewHmacContext(params.tag_algo, hmac_key_value);
+  if (!hmac_ctx_result.ok()) return hmac_ctx_result.status();
 
   return {absl::WrapUnique(new AesCtrHmacStreamSegmentEncrypter(
-      std::move(key_value), header, nonce_prefix,
-      params.ciphertext_segment_size, params.ciphertext_offset, params.tag_size,
-      cipher, std::move(mac)))};
+      std::move(cipher_ctx_result.ValueOrDie()),
+      std::move(hmac_ctx_result.ValueOrDie()), std::string(header),
+      std::string(nonce_prefix), params.ciphertext_segment_size,
+      params.ciphertext_offset, params.tag_size))};
 }
 
 util::Status AesCtrHmacStreamSegmentEncrypter::EncryptSegment(
     const std::vector<uint8_t>& plaintext, bool is_last_segment,
     std::vector<uint8_t>* ciphertext_buffer) {
+  util::Status status = EncryptSegmentAt(segment_number_, plaintext,
+                                         is_last_segment, ciphertext_buffer);
+  if (!status.ok()) return status;
+  IncSegmentNumber();
+  return util::OkStatus();
+}
+
+util::Status AesCtrHmacStreamSegmentEncrypter::EncryptSegmentAt(
+    int64_t segment_number, const std::vector<uint8_t>& plaintext,
+    bool is_last_segment, std::vector<uint8_t>* ciphertext_buffer) const {
   if (plaintext.size() > get_plaintext_segment_size()) {
     return util::Status(util::error::INVALID_ARGUMENT, "plaintext too long");
   }
@@ -187,50 +290,59 @@ util::Status AesCtrHmacStreamSegmentEncrypter::EncryptSegment(
     return util::Status(util::error::INVALID_ARGUMENT,
                         "ciphertext_buffer must be non-null");
   }
-  if (get_segment_number() > std::numeric_limits<uint32_t>::max() ||
-      (get_segment_number() == std::numeric_limits<uint32_t>::max() &&
+  ciphertext_buffer->resize(plaintext.size() + tag_size_);
+  return Seal(segment_number, plaintext, is_last_segment,
+              absl::MakeSpan(*ciphertext_buffer));
+}
+
+util::Status AesCtrHmacStreamSegmentEncrypter::EncryptSegmentInto(
+    absl::Span<const uint8_t> plaintext, bool is_last_segment,
+    absl::Span<uint8_t> ciphertext) {
+  if (ciphertext.size() != plaintext.size() + tag_size_) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "ciphertext has the wrong size");
+  }
+  util::Status status =
+      Seal(segment_number_, plaintext, is_last_segment, ciphertext);
+  if (!status.ok()) return status;
+  IncSegmentNumber();
+  return util::OkStatus();
+}
+
+util::Status AesCtrHmacStreamSegmentEncrypter::Seal(
+    int64_t segment_number, absl::Span<const uint8_t> plaintext,
+    bool is_last_segment, absl::Span<uint8_t> ciphertext) const {
+  if (plaintext.size() > get_plaintext_segment_size()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "plaintext too long");
+  }
+  if (segment_number < 0 ||
+      segment_number > std::numeric_limits<uint32_t>::max() ||
+      (segment_number == std::numeric_limits<uint32_t>::max() &&
        !is_last_segment)) {
     return util::Status(util::error::INVALID_ARGUMENT, "too many segments");
   }
 
-  int ct_size = plaintext.size() + tag_size_;
-  ciphertext_buffer->resize(ct_size);
+  int pt_size = plaintext.size();
 
   std::string nonce =
-      NonceForSegment(nonce_prefix_, segment_number_, is_last_segment);
-
-  // Encrypt.
-  bssl::UniquePtr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new());
-  if (ctx.get() == nullptr) {
-    return util::Status(util::error::INTERNAL,
-                        "could not initialize EVP_CIPHER_CTX");
-  }
-  if (EVP_EncryptInit_ex(ctx.get(), cipher_, nullptr /* engine */,
-                         reinterpret_cast<const uint8_t*>(key_value_.data()),
-                         reinterpret_cast<const uint8_t*>(nonce.data())) != 1) {
-    return util::Status(util::error::INTERNAL, "could not initialize ctx");
-  }
+      NonceForSegment(nonce_prefix_, segment_number, is_last_segment);
 
-  int out_len;
-  if (EVP_EncryptUpdate(ctx.get(), ciphertext_buffer->data(), &out_len,
-                        plaintext.data(), plaintext.size()) != 1) {
-    return util::Status(util::error::INTERNAL, "encryption failed");
-  }
-  if (out_len != plaintext.size()) {
-    return util::Status(util::error::INTERNAL, "incorrect ciphertext size");
-  }
+  // Encrypt and MAC in one pass; AES-CTR supports encrypting in place.
+  bssl::ScopedEVP_CIPHER_CTX cipher_ctx;
+  bssl::ScopedHMAC_CTX hmac_ctx;
+  auto status = InitSegment(cipher_ctx_.get(), hmac_ctx_.get(), nonce,
+                            cipher_ctx.get(), hmac_ctx.get());
+  if (!status.ok()) return status;
+  status = AesCtrHmacBoringSsl::CtrEncryptAndMac(
+      cipher_ctx.get(), hmac_ctx.get(), plaintext, ciphertext.data());
+  if (!status.ok()) return status;
 
   // Add MAC tag.
-  absl::string_view ciphertext_string(
-      reinterpret_cast<const char*>(ciphertext_buffer->data()),
-      plaintext.size());
-  auto tag_result = mac_->ComputeMac(absl::StrCat(nonce, ciphertext_string));
-  if (!tag_result.ok()) return tag_result.status();
-  std::string tag = tag_result.ValueOrDie();
-  memcpy(ciphertext_buffer->data() + plaintext.size(),
-         reinterpret_cast<const uint8_t*>(tag.data()), tag_size_);
+  uint8_t tag[EVP_MAX_MD_SIZE];
+  status = FinalizeTag(hmac_ctx.get(), tag);
+  if (!status.ok()) return status;
+  memcpy(ciphertext.data() + pt_size, tag, tag_size_);
 
-  IncSegmentNumber();
   return util::OkStatus();
 }
 
@@ -269,20 +381,18 @@ util::Status AesCtrHmacStreamSegmentDecrypter::Init(
       std::string(reinterpret_cast<const char*>(header.data() + 1 + key_size_),
                   AesCtrHmacStreaming::kNoncePrefixSizeInBytes);
 
+  util::SecretData key_value;
   util::SecretData hmac_key_value;
   auto status = DeriveKeys(ikm_, hkdf_algo_, salt, associated_data_, key_size_,
-                           &key_value_, &hmac_key_value);
+                           &key_value, &hmac_key_value);
   if (!status.ok()) return status;
 
-  cipher_ = SubtleUtilBoringSSL::GetAesCtrCipherForKeySize(key_size_);
-  if (cipher_ == nullptr) {
-    return util::Status(util::error::INTERNAL, "invalid key size");
-  }
-
-  auto hmac_result =
-      HmacBoringSsl::New(tag_algo_, tag_size_, std::move(hmac_key_value));
-  if (!hmac_result.ok()) return hmac_result.status();
-  mac_ = std::move(hmac_result.ValueOrDie());
+  auto cipher_ctx_result = NewCipherContext(key_value);
+  if (!cipher_ctx_result.ok()) return cipher_ctx_result.status();
+  cipher_ctx_ = std::move(cipher_ctx_result.ValueOrDie());
+  auto hmac_ctx_result = NewHmacContext(tag_algo_, hmac_key_value);
+  if (!hmac_ctx_result.ok()) return hmac_ctx_result.status();
+  hmac_ctx_ = std::move(hmac_ctx_result.ValueOrDie());
 
   is_initialized_ = true;
   return util::OkStatus();
@@ -291,6 +401,7 @@ util::Status AesCtrHmacStreamSegmentDecrypter::Init(
 util::Status AesCtrHmacStreamSegmentDecrypter::DecryptSegment(
     const std::vector<uint8_t>& ciphertext, int64_t segment_number,
     bool is_last_segment, std::vector<uint8_t>* plaintext_buffer) {
+  // Keep reporting these errors ahead of a null plaintext_buffer.
   if (!is_initialized_) {
     return util::Status(util::error::FAILED_PRECONDITION,
                         "decrypter not initialized");
@@ -298,54 +409,102 @@ util::Status AesCtrHmacStreamSegmentDecrypter::DecryptSegment(
   if (ciphertext.size() > get_ciphertext_segment_size()) {
     return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too long");
   }
-  if (ciphertext.size() < tag_size_) {
-    return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too short");
-  }
   if (plaintext_buffer == nullptr) {
     return util::Status(util::error::INVALID_ARGUMENT,
                         "plaintext_buffer must be non-null");
   }
+  plaintext_buffer->resize(
+      ciphertext.size() > tag_size_ ? ciphertext.size() - tag_size_ : 0);
+  return DecryptSegmentInto(ciphertext, segment_number, is_last_segment,
+                            absl::MakeSpan(*plaintext_buffer));
+}
+
+util::Status AesCtrHmacStreamSegmentDecrypter::ValidateSegment(
+    size_t ciphertext_size, int64_t segment_number,
+    bool is_last_segment) const {
+  if (!is_initialized_) {
+    return util::Status(util::error::FAILED_PRECONDITION,
+                        "decrypter not initialized");
+  }
+  if (ciphertext_size > get_ciphertext_segment_size()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too long");
+  }
+  if (ciphertext_size < tag_size_) {
+    return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too short");
+  }
   if (segment_number > std::numeric_limits<uint32_t>::max() ||
       (segment_number == std::numeric_limits<uint32_t>::max() &&
        !is_last_segment)) {
     return util::Status(util::error::INVALID_ARGUMENT, "too many segments");
   }
+  return util::OkStatus();
+}
+
+util::Status AesCtrHmacStreamSegmentDecrypter::DecryptSegmentInto(
+    absl::Span<const uint8_t> ciphertext, int64_t segment_number,
+    bool is_last_segment, absl::Span<uint8_t> plaintext) {
+  util::Status status =
+      ValidateSegment(ciphertext.size(), segment_number, is_last_segment);
+  if (!status.ok()) return status;
+  if (plaintext.size() != ciphertext.size() - tag_size_) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "plaintext has the wrong size");
+  }
 
-  int pt_size = ciphertext.size() - tag_size_;
-  plaintext_buffer->resize(pt_size);
+  int pt_size = plaintext.size();
 
   std::string nonce =
       NonceForSegment(nonce_prefix_, segment_number, is_last_segment);
 
-  // Verify MAC tag.
-  absl::string_view tag(
-      reinterpret_cast<const char*>(ciphertext.data() + pt_size), tag_size_);
-  absl::string_view ciphertext_string(
-      reinterpret_cast<const char*>(ciphertext.data()), pt_size);
-  auto status = mac_->VerifyMac(tag, absl::StrCat(nonce, ciphertext_string));
+  // MAC and decrypt in one pass; AES-CTR supports decrypting in place.
+  bssl::ScopedEVP_CIPHER_CTX cipher_ctx;
+  bssl::ScopedHMAC_CTX hmac_ctx;
+  status = InitSegment(cipher_ctx_.get(), hmac_ctx_.get(), nonce,
+                       cipher_ctx.get(), hmac_ctx.get());
+  if (!status.ok()) return status;
+  status = AesCtrHmacBoringSsl::MacAndCtrDecrypt(
+      cipher_ctx.get(), hmac_ctx.get(), ciphertext.subspan(0, pt_size),
+      plaintext.data());
   if (!status.ok()) return status;
 
-  // Decrypt.
-  bssl::UniquePtr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new());
-  if (ctx.get() == nullptr) {
-    return util::Status(util::error::INTERNAL,
-                        "could not initialize EVP_CIPHER_CTX");
-  }
-  if (EVP_DecryptInit_ex(ctx.get(), cipher_, nullptr /* engine */,
-                         reinterpret_cast<const uint8_t*>(key_value_.data()),
-                         reinterpret_cast<const uint8_t*>(nonce.data())) != 1) {
-    return util::Status(util::error::INTERNAL, "could not initialize ctx");
+  // Verify MAC tag, and erase the plaintext if it does not verify.
+  uint8_t tag[EVP_MAX_MD_SIZE];
+  status = FinalizeTag(hmac_ctx.get(), tag);
+  if (!status.ok()) return status;
+  if (CRYPTO_memcmp(tag, ciphertext.data() + pt_size, tag_size_) != 0) {
+    OPENSSL_cleanse(plaintext.data(), pt_size);
+    return util::Status(util::error::INVALID_ARGUMENT, "verification failed");
   }
+  return util::OkStatus();
+}
 
-  int out_len;
-  if (EVP_DecryptUpdate(ctx.get(), plaintext_buffer->data(), &out_len,
-                        ciphertext.data(), pt_size) != 1) {
-    return util::Status(util::error::INTERNAL, "decryption failed");
+util::Status AesCtrHmacStreamSegmentDecrypter::VerifySegment(
+    absl::Span<const uint8_t> ciphertext, int64_t segment_number,
+    bool is_last_segment) {
+  util::Status status =
+      ValidateSegment(ciphertext.size(), segment_number, is_last_segment);
+  if (!status.ok()) return status;
+  int ct_size = ciphertext.size() - tag_size_;
+  std::string nonce =
+      NonceForSegment(nonce_prefix_, segment_number, is_last_segment);
+
+  // The tag is computed over the nonce and the ciphertext, so there is no
+  // need to run AES-CTR.
+  bssl::ScopedHMAC_CTX hmac_ctx;
+  if (!HMAC_CTX_copy_ex(hmac_ctx.get(), hmac_ctx_.get()) ||
+      !HMAC_Update(hmac_ctx.get(),
+                   reinterpret_cast<const uint8_t*>(nonce.data()),
+                   nonce.size()) ||
+      !HMAC_Update(hmac_ctx.get(), ciphertext.data(), ct_size)) {
+    return util::Status(util::error::INTERNAL,
+                        "BoringSSL failed to compute HMAC");
   }
-  if (out_len != pt_size) {
-    return util::Status(util::error::INTERNAL, "incorrect plaintext size");
+  uint8_t tag[EVP_MAX_MD_SIZE];
+  status = FinalizeTag(hmac_ctx.get(), tag);
+  if (!status.ok()) return status;
+  if (CRYPTO_memcmp(tag, ciphertext.data() + ct_size, tag_size_) != 0) {
+    return util::Status(util::error::INVALID_ARGUMENT, "verification failed");
   }
-
   return util::OkStatus();
 }
 
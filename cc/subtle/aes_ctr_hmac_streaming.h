@@ -19,8 +19,9 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/evp.h"
-#include "tink/mac.h"
+#include "openssl/hmac.h"
 #include "tink/config/tink_fips.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/nonce_based_streaming_aead.h"
@@ -93,9 +94,19 @@ class AesCtrHmacStreaming : public NonceBasedStreamingAead {
   util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>> NewSegmentEncrypter(
       absl::string_view associated_data) const override;
 
+  util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+  NewSegmentEncrypterForHeader(
+      absl::string_view header,
+      absl::string_view associated_data) const override;
+
   util::StatusOr<std::unique_ptr<StreamSegmentDecrypter>> NewSegmentDecrypter(
       absl::string_view associated_data) const override;
 
+  // Re-encrypting a segment with a longer plaintext under the same nonce
+  // only extends the AES-CTR key stream, so the ciphertext of the old
+  // plaintext does not change, and HMAC does not depend on the nonce.
+  bool SupportsAppending() const override { return true; }
+
  private:
   explicit AesCtrHmacStreaming(Params params) : params_(std::move(params)) {}
   const Params params_;
@@ -108,11 +119,26 @@ class AesCtrHmacStreamSegmentEncrypter : public StreamSegmentEncrypter {
       const AesCtrHmacStreaming::Params& params,
       absl::string_view associated_data);
 
+  // Like New(), but continues the stream that starts with 'header', i.e.
+  // uses the same keys and nonce prefix as the encrypter that produced it.
+  static util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>> NewForHeader(
+      const AesCtrHmacStreaming::Params& params, absl::string_view header,
+      absl::string_view associated_data);
+
   // Overridden methods of StreamSegmentEncrypter.
   util::Status EncryptSegment(const std::vector<uint8_t>& plaintext,
                               bool is_last_segment,
                               std::vector<uint8_t>* ciphertext_buffer) override;
 
+  util::Status EncryptSegmentAt(
+      int64_t segment_number, const std::vector<uint8_t>& plaintext,
+      bool is_last_segment,
+      std::vector<uint8_t>* ciphertext_buffer) const override;
+
+  util::Status EncryptSegmentInto(absl::Span<const uint8_t> plaintext,
+                                  bool is_last_segment,
+                                  absl::Span<uint8_t> ciphertext) override;
+
   const std::vector<uint8_t>& get_header() const override { return header_; }
   int64_t get_segment_number() const override { return segment_number_; }
   int get_plaintext_segment_size() const override {
@@ -127,31 +153,35 @@ class AesCtrHmacStreamSegmentEncrypter : public StreamSegmentEncrypter {
   void IncSegmentNumber() override { segment_number_++; }
 
  private:
-  AesCtrHmacStreamSegmentEncrypter(util::SecretData key_value,
+  // Encrypts 'plaintext' as the segment number 'segment_number' into
+  // 'ciphertext', which is tag_size_ bytes longer.
+  util::Status Seal(int64_t segment_number,
+                    absl::Span<const uint8_t> plaintext, bool is_last_segment,
+                    absl::Span<uint8_t> ciphertext) const;
+
+  AesCtrHmacStreamSegmentEncrypter(bssl::UniquePtr<EVP_CIPHER_CTX> cipher_ctx,
+                                   bssl::UniquePtr<HMAC_CTX> hmac_ctx,
                                    absl::string_view header,
                                    absl::string_view nonce_prefix,
                                    int ciphertext_segment_size,
-                                   int ciphertext_offset, int tag_size,
-                                   const EVP_CIPHER* cipher,
-                                   std::unique_ptr<Mac> mac)
-      : key_value_(std::move(key_value)),
+                                   int ciphertext_offset, int tag_size)
+      : cipher_ctx_(std::move(cipher_ctx)),
+        hmac_ctx_(std::move(hmac_ctx)),
         header_(header.begin(), header.end()),
         nonce_prefix_(nonce_prefix),
         ciphertext_segment_size_(ciphertext_segment_size),
         ciphertext_offset_(ciphertext_offset),
         tag_size_(tag_size),
-        cipher_(cipher),
-        mac_(std::move(mac)),
         segment_number_(0) {}
 
-  const util::SecretData key_value_;
+  // Keyed contexts, which are copied for each segment.
+  const bssl::UniquePtr<EVP_CIPHER_CTX> cipher_ctx_;
+  const bssl::UniquePtr<HMAC_CTX> hmac_ctx_;
   const std::vector<uint8_t> header_;
   const std::string nonce_prefix_;
   const int ciphertext_segment_size_;
   const int ciphertext_offset_;
   const int tag_size_;
-  const EVP_CIPHER* cipher_;
-  const std::unique_ptr<Mac> mac_;
   int64_t segment_number_;
 };
 
@@ -169,6 +199,16 @@ class AesCtrHmacStreamSegmentDecrypter : public StreamSegmentDecrypter {
                               int64_t segment_number, bool is_last_segment,
                               std::vector<uint8_t>* plaintext_buffer) override;
 
+  util::Status DecryptSegmentInto(absl::Span<const uint8_t> ciphertext,
+                                  int64_t segment_number,
+                                  bool is_last_segment,
+                                  absl::Span<uint8_t> plaintext) override;
+
+  // Only checks the HMAC tag, without decrypting.
+  util::Status VerifySegment(absl::Span<const uint8_t> ciphertext,
+                             int64_t segment_number,
+                             bool is_last_segment) override;
+
   int get_header_size() const override {
     return 1 + key_size_ + AesCtrHmacStreaming::kNoncePrefixSizeInBytes;
   }
@@ -197,6 +237,11 @@ class AesCtrHmacStreamSegmentDecrypter : public StreamSegmentDecrypter {
         tag_algo_(tag_algo),
         tag_size_(tag_size) {}
 
+  // Checks that a segment of 'ciphertext_size' bytes with the given number
+  // can be decrypted by this decrypter.
+  util::Status ValidateSegment(size_t ciphertext_size, int64_t segment_number,
+                               bool is_last_segment) const;
+
   // Parameters set upon decrypter creation.
   const util::SecretData ikm_;
   const HashType hkdf_algo_;
@@ -209,10 +254,10 @@ class AesCtrHmacStreamSegmentDecrypter : public StreamSegmentDecrypter {
 
   // Parameters set when initializing with data from stream header.
   bool is_initialized_ = false;
-  util::SecretData key_value_;
   std::string nonce_prefix_;
-  const EVP_CIPHER* cipher_;
-  std::unique_ptr<Mac> mac_;
+  // Keyed contexts, which are copied for each segment.
+  bssl::UniquePtr<EVP_CIPHER_CTX> cipher_ctx_;
+  bssl::UniquePtr<HMAC_CTX> hmac_ctx_;
 };
 
 }  // namespace subtle
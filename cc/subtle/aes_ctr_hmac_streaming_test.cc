@@ -14,18 +14,25 @@
 
 #include "tink/subtle/aes_ctr_hmac_streaming.h"
 
+#include <algorithm>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
+#include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/random.h"
 #include "tink/subtle/stream_segment_decrypter.h"
 #include "tink/subtle/stream_segment_encrypter.h"
 #include "tink/subtle/streaming_aead_test_util.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/ostream_output_stream.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "tink/util/test_matchers.h"
@@ -123,6 +130,31 @@ TEST(AesCtrHmacStreamSegmentEncrypterTest, Basic) {
   }
 }
 
+TEST(AesCtrHmacStreamSegmentEncrypterTest, EncryptSegmentAt) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto enc_result =
+      AesCtrHmacStreamSegmentEncrypter::New(ValidParams(), "associated data");
+  ASSERT_THAT(enc_result.status(), IsOk());
+  auto enc = std::move(enc_result.ValueOrDie());
+
+  std::vector<uint8_t> pt(enc->get_plaintext_segment_size(), 'p');
+  std::vector<uint8_t> ct_at;
+  // EncryptSegmentAt() does not change the segment number.
+  EXPECT_THAT(enc->EncryptSegmentAt(2, pt, /* is_last_segment = */ true,
+                                    &ct_at),
+              IsOk());
+  EXPECT_EQ(0, enc->get_segment_number());
+  // It produces the same ciphertext as EncryptSegment() does for the segment
+  // with the same number.
+  std::vector<uint8_t> ct;
+  for (bool is_last_segment : {false, false, true}) {
+    EXPECT_THAT(enc->EncryptSegment(pt, is_last_segment, &ct), IsOk());
+  }
+  EXPECT_EQ(ct, ct_at);
+}
+
 TEST(AesCtrHmacStreamSegmentEncrypterTest, EncryptLongPlaintext) {
   if (kUseOnlyFips) {
     GTEST_SKIP() << "Not supported in FIPS-only mode";
@@ -243,6 +275,64 @@ TEST(AesCtrHmacStreamSegmentDecrypterTest, Basic) {
   }
 }
 
+TEST(AesCtrHmacStreamSegmentEncrypterTest, EncryptDecryptInPlace) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  AesCtrHmacStreaming::Params params = ValidParams();
+  std::string associated_data = "associated data";
+
+  auto enc_result =
+      AesCtrHmacStreamSegmentEncrypter::New(params, associated_data);
+  ASSERT_THAT(enc_result.status(), IsOk());
+  auto enc = std::move(enc_result.ValueOrDie());
+  auto dec_result =
+      AesCtrHmacStreamSegmentDecrypter::New(params, associated_data);
+  ASSERT_THAT(dec_result.status(), IsOk());
+  auto dec = std::move(dec_result.ValueOrDie());
+  ASSERT_THAT(dec->Init(enc->get_header()), IsOk());
+
+  int segment_number = 0;
+  for (int pt_size : {0, 1, 10, enc->get_plaintext_segment_size()}) {
+    for (bool is_last_segment : {false, true}) {
+      SCOPED_TRACE(absl::StrCat("plaintext_size = ", pt_size,
+                                ", is_last_segment = ", is_last_segment));
+      std::vector<uint8_t> pt(pt_size, 'p');
+      std::vector<uint8_t> expected_ct;
+      ASSERT_THAT(enc->EncryptSegmentAt(segment_number, pt, is_last_segment,
+                                        &expected_ct),
+                  IsOk());
+
+      std::vector<uint8_t> segment(pt);
+      segment.resize(pt_size + params.tag_size);
+      ASSERT_THAT(enc->EncryptSegmentInto(
+                      absl::MakeConstSpan(segment.data(), pt_size),
+                      is_last_segment, absl::MakeSpan(segment)),
+                  IsOk());
+      EXPECT_EQ(expected_ct, segment);
+      EXPECT_EQ(segment_number + 1, enc->get_segment_number());
+
+      ASSERT_THAT(dec->DecryptSegmentInto(
+                      absl::MakeConstSpan(segment), segment_number,
+                      is_last_segment, absl::MakeSpan(segment.data(), pt_size)),
+                  IsOk());
+      segment.resize(pt_size);
+      EXPECT_EQ(pt, segment);
+      segment_number++;
+    }
+  }
+
+  std::vector<uint8_t> segment(10 + params.tag_size);
+  EXPECT_THAT(enc->EncryptSegmentInto(absl::MakeConstSpan(segment.data(), 10),
+                                      true, absl::MakeSpan(segment.data(), 20)),
+              StatusIs(util::error::INVALID_ARGUMENT,
+                       HasSubstr("wrong size")));
+  EXPECT_THAT(dec->DecryptSegmentInto(absl::MakeConstSpan(segment), 0, true,
+                                      absl::MakeSpan(segment.data(), 9)),
+              StatusIs(util::error::INVALID_ARGUMENT,
+                       HasSubstr("wrong size")));
+}
+
 TEST(AesCtrHmacStreamSegmentDecrypterTest, AlreadyInit) {
   if (kUseOnlyFips) {
     GTEST_SKIP() << "Not supported in FIPS-only mode";
@@ -428,6 +518,119 @@ TEST(AesCtrHmacStreamingTest, Basic) {
   }
 }
 
+TEST(AesCtrHmacStreamingTest, ParallelEncryption) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto result = AesCtrHmacStreaming::New(ValidParams());
+  ASSERT_THAT(result.status(), IsOk());
+  auto streaming_aead = std::move(result.ValueOrDie());
+  std::string associated_data = "associated data";
+
+  for (int parallelism : {2, 4}) {
+    for (int plaintext_size : {0, 100, 100000}) {
+      SCOPED_TRACE(absl::StrCat("parallelism = ", parallelism,
+                                ", plaintext_size = ", plaintext_size));
+      std::string plaintext = Random::GetRandomBytes(plaintext_size);
+
+      // Encrypt with a parallel stream.
+      auto ct_stream = absl::make_unique<std::stringstream>();
+      auto ct_buf = ct_stream->rdbuf();
+      auto enc_stream_result = streaming_aead->NewParallelEncryptingStream(
+          absl::make_unique<util::OstreamOutputStream>(std::move(ct_stream)),
+          associated_data, parallelism);
+      ASSERT_THAT(enc_stream_result.status(), IsOk());
+      auto enc_stream = std::move(enc_stream_result.ValueOrDie());
+      ASSERT_THAT(test::WriteToStream(enc_stream.get(), plaintext), IsOk());
+
+      // Decrypt with a regular decrypting stream.
+      auto dec_stream_result = streaming_aead->NewDecryptingStream(
+          absl::make_unique<util::IstreamInputStream>(
+              absl::make_unique<std::stringstream>(ct_buf->str())),
+          associated_data);
+      ASSERT_THAT(dec_stream_result.status(), IsOk());
+      std::string decrypted;
+      EXPECT_THAT(test::ReadFromStream(dec_stream_result.ValueOrDie().get(),
+                                       &decrypted),
+                  IsOk());
+      EXPECT_EQ(plaintext, decrypted);
+    }
+  }
+}
+
+TEST(AesCtrHmacStreamingTest, RandomAccessEncryption) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto result = AesCtrHmacStreaming::New(ValidParams());
+  ASSERT_THAT(result.status(), IsOk());
+  auto streaming_aead = std::move(result.ValueOrDie());
+  std::string associated_data = "associated data";
+
+  for (int plaintext_size : {0, 100, 100000}) {
+    SCOPED_TRACE(absl::StrCat("plaintext_size = ", plaintext_size));
+    std::string plaintext = Random::GetRandomBytes(plaintext_size);
+
+    // Encrypt the second half of the segments with another encrypter for
+    // the same stream, and before the first half.
+    auto first_result =
+        streaming_aead->NewRandomAccessEncrypter(associated_data);
+    ASSERT_THAT(first_result.status(), IsOk());
+    auto first = std::move(first_result.ValueOrDie());
+    std::string header(first->header().begin(), first->header().end());
+    auto second_result = streaming_aead->NewRandomAccessEncrypterForHeader(
+        header, associated_data);
+    ASSERT_THAT(second_result.status(), IsOk());
+    auto second = std::move(second_result.ValueOrDie());
+    int64_t middle_segment = 0;
+    while (first->plaintext_position(2 * middle_segment) < plaintext_size) {
+      middle_segment++;
+    }
+    int64_t middle = std::min<int64_t>(
+        plaintext_size, first->plaintext_position(middle_segment));
+    absl::string_view pt(plaintext);
+    std::vector<uint8_t> ct_first, ct_second;
+    if (middle < plaintext_size) {
+      ASSERT_THAT(
+          second->EncryptPart(
+              middle_segment,
+              absl::MakeConstSpan(
+                  reinterpret_cast<const uint8_t*>(pt.data()) + middle,
+                  plaintext_size - middle),
+              true, &ct_second),
+          IsOk());
+    }
+    ASSERT_THAT(
+        first->EncryptPart(
+            0,
+            absl::MakeConstSpan(reinterpret_cast<const uint8_t*>(pt.data()),
+                                middle),
+            middle == plaintext_size, &ct_first),
+        IsOk());
+    std::string ciphertext = absl::StrCat(
+        std::string(ct_first.begin(), ct_first.end()),
+        std::string(ct_second.begin(), ct_second.end()));
+
+    // Decrypt with a regular decrypting stream.
+    auto dec_stream_result = streaming_aead->NewDecryptingStream(
+        absl::make_unique<util::IstreamInputStream>(
+            absl::make_unique<std::stringstream>(ciphertext)),
+        associated_data);
+    ASSERT_THAT(dec_stream_result.status(), IsOk());
+    std::string decrypted;
+    EXPECT_THAT(test::ReadFromStream(dec_stream_result.ValueOrDie().get(),
+                                     &decrypted),
+                IsOk());
+    EXPECT_EQ(plaintext, decrypted);
+  }
+
+  // Headers of the wrong size are rejected.
+  EXPECT_THAT(streaming_aead
+                  ->NewRandomAccessEncrypterForHeader("header", associated_data)
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 TEST(ValidateTest, ValidParams) {
   if (kUseOnlyFips) {
     GTEST_SKIP() << "Not supported in FIPS-only mode";
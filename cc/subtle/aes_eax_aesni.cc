@@ -81,9 +81,9 @@ inline __m128i Increment(__m128i x) {
 // So far I've not found a simple way to compute and add the carry using
 // xmm instructions. However, optimizing this function is not important,
 // since it is used just once during decryption.
-inline __m128i Add(__m128i x, uint64 y) {
-  // Convert to a vector of two uint64.
-  uint64 vec[2];
+inline __m128i Add(__m128i x, uint64_t y) {
+  // Convert to a vector of two uint64_t.
+  uint64_t vec[2];
   _mm_storeu_si128(reinterpret_cast<__m128i*>(vec), x);
   // Perform the addition on the vector.
   vec[0] += y;
@@ -163,7 +163,7 @@ uint8_t Rcon(int round) {
 // This performs a rotation and a substitution with an S-box.
 // This implementation uses AESKEYGENASSIST to compute the result twice
 // and checks that the two results match.
-inline uint32 SubRot(uint32 tmp) {
+inline uint32_t SubRot(uint32_t tmp) {
   __m128i inp = _mm_set_epi32(0, 0, tmp, 0);
   __m128i out = _mm_aeskeygenassist_si128(inp, 0x00);
   return _mm_extract_epi32(out, 1);
@@ -172,7 +172,7 @@ inline uint32 SubRot(uint32 tmp) {
 // Apply the S-box to the 4 bytes in a word.
 // This operation is used in the key expansion of 256-bit keys.
 // This implementation computes the result twice and checks equality.
-inline uint32 SubWord(uint32 tmp) {
+inline uint32_t SubWord(uint32_t tmp) {
   __m128i inp = _mm_set_epi32(0, 0, tmp, 0);
   __m128i out = _mm_aeskeygenassist_si128(inp, 0x00);
   return _mm_extract_epi32(out, 0);
@@ -184,12 +184,12 @@ void Aes128KeyExpansion(const uint8_t* key, __m128i *round_key) {
   const int Nk = 4;  // Number of words in the key
   const int Nb = 4;  // Number of words per round key
   const int Nr = 10;  // Number or rounds
-  uint32 *w = reinterpret_cast<uint32*>(round_key);
-  const uint32 *keywords = reinterpret_cast<const uint32*>(key);
+  uint32_t *w = reinterpret_cast<uint32_t*>(round_key);
+  const uint32_t *keywords = reinterpret_cast<const uint32_t*>(key);
   for (int i = 0; i < Nk; i++) {
     w[i] = keywords[i];
   }
-  uint32 tmp = w[Nk - 1];
+  uint32_t tmp = w[Nk - 1];
   for (int i = Nk; i < Nb * (Nr + 1); i++) {
     if (i % Nk == 0) {
       tmp = SubRot(tmp) ^ Rcon(i / Nk);
@@ -203,12 +203,12 @@ void Aes256KeyExpansion(const uint8_t* key, __m128i *round_key) {
   const int Nk = 8;  // Number of words in the key
   const int Nb = 4;  // Number of words per round key
   const int Nr = 14;  // Number or rounds
-  uint32 *w = reinterpret_cast<uint32*>(round_key);
-  const uint32 *keywords = reinterpret_cast<const uint32*>(key);
+  uint32_t *w = reinterpret_cast<uint32_t*>(round_key);
+  const uint32_t *keywords = reinterpret_cast<const uint32_t*>(key);
   for (int i = 0; i < Nk; i++) {
     w[i] = keywords[i];
   }
-  uint32 tmp = w[Nk - 1];
+  uint32_t tmp = w[Nk - 1];
   for (int i = Nk; i < Nb * (Nr + 1); i++) {
     if (i % Nk == 0) {
       tmp = SubRot(tmp) ^ Rcon(i / Nk);
@@ -299,6 +299,25 @@ inline void AesEaxAesni::Encrypt3Decrypt1(
   *out_dec = _mm_aesdeclast_si128(tmp3, (*round_dec_key_)[rounds_]);
 }
 
+inline void AesEaxAesni::Encrypt3Blocks(const __m128i in0, const __m128i in1,
+                                        const __m128i in2, __m128i* out0,
+                                        __m128i* out1, __m128i* out2) const {
+  __m128i first_round = (*round_key_)[0];
+  __m128i tmp0 = _mm_xor_si128(in0, first_round);
+  __m128i tmp1 = _mm_xor_si128(in1, first_round);
+  __m128i tmp2 = _mm_xor_si128(in2, first_round);
+  for (int i = 1; i < rounds_; i++) {
+    __m128i round_key = (*round_key_)[i];
+    tmp0 = _mm_aesenc_si128(tmp0, round_key);
+    tmp1 = _mm_aesenc_si128(tmp1, round_key);
+    tmp2 = _mm_aesenc_si128(tmp2, round_key);
+  }
+  __m128i last_round = (*round_key_)[rounds_];
+  *out0 = _mm_aesenclast_si128(tmp0, last_round);
+  *out1 = _mm_aesenclast_si128(tmp1, last_round);
+  *out2 = _mm_aesenclast_si128(tmp2, last_round);
+}
+
 inline __m128i AesEaxAesni::EncryptBlock(__m128i block) const {
   __m128i tmp = _mm_xor_si128(block, (*round_key_)[0]);
   for (int i = 1; i < rounds_; i++){
@@ -357,6 +376,36 @@ __m128i AesEaxAesni::OMAC(absl::string_view blob, int tag) const {
   return EncryptBlock(state);
 }
 
+AesEaxAesni::IncrementalOmac::IncrementalOmac(const AesEaxAesni& eax,
+                                              absl::string_view blob, int tag)
+    : eax_(eax),
+      data_(reinterpret_cast<const uint8_t*>(blob.data())),
+      size_(blob.size()),
+      tag_(tag),
+      steps_(1 + (blob.size() + kBlockSize - 1) / kBlockSize),
+      state_(_mm_setzero_si128()) {}
+
+inline __m128i AesEaxAesni::IncrementalOmac::NextInput() const {
+  // The steps of OMAC() above: one for the tag, and one per block.
+  if (step_ == 0) {
+    __m128i first = _mm_set_epi32(tag_ << 24, 0, 0, 0);
+    return size_ == 0 ? _mm_xor_si128(first, *eax_.B_) : first;
+  }
+  size_t idx = (step_ - 1) * kBlockSize;
+  if (size_ - idx > kBlockSize) {
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data_ + idx));
+    return _mm_xor_si128(state_, in);
+  }
+  return _mm_xor_si128(state_, eax_.Pad(data_ + idx, size_ - idx));
+}
+
+__m128i AesEaxAesni::IncrementalOmac::Finish() {
+  while (pending()) {
+    Advance(eax_.EncryptBlock(NextInput()));
+  }
+  return state_;
+}
+
 bool AesEaxAesni::RawEncrypt(absl::string_view nonce, absl::string_view in,
                              absl::string_view additional_data,
                              absl::Span<uint8_t> ciphertext) const {
@@ -368,9 +417,10 @@ bool AesEaxAesni::RawEncrypt(absl::string_view nonce, absl::string_view in,
 
   // NOTE(bleichen): The author of EAX designed this mode, so that
   //   it would be possible to compute N and H independently of the encryption.
-  //   So far this possiblity is not used in this implementation.
+  //   H is computed alongside the OMAC of the ciphertext, which leaves the
+  //   AES unit mostly idle while it waits for the previous block.
   const __m128i N = OMAC(nonce, 0);
-  const __m128i H = OMAC(additional_data, 1);
+  IncrementalOmac header_omac(*this, additional_data, 1);
 
   // Compute the initial counter in little endian order.
   // EAX uses big endian order, but it is easier to increment
@@ -387,7 +437,14 @@ bool AesEaxAesni::RawEncrypt(absl::string_view nonce, absl::string_view in,
     __m128i ctr_big_endian = Reverse(ctr);
     // Get the key stream for one message block and compute
     // the MAC for the previous ciphertext block or header.
-    Encrypt2Blocks(mac, ctr_big_endian, &mac, &key_stream);
+    if (header_omac.pending()) {
+      __m128i header_mac;
+      Encrypt3Blocks(mac, ctr_big_endian, header_omac.NextInput(), &mac,
+                     &key_stream, &header_mac);
+      header_omac.Advance(header_mac);
+    } else {
+      Encrypt2Blocks(mac, ctr_big_endian, &mac, &key_stream);
+    }
     __m128i pt = _mm_loadu_si128(reinterpret_cast<const __m128i*>(plaintext));
     __m128i ct = _mm_xor_si128(pt, key_stream);
     mac = _mm_xor_si128(mac, ct);
@@ -414,6 +471,7 @@ bool AesEaxAesni::RawEncrypt(absl::string_view nonce, absl::string_view in,
     mac = _mm_xor_si128(mac, *B_);
   }
   mac = EncryptBlock(mac);
+  const __m128i H = header_omac.Finish();
   __m128i tag = _mm_xor_si128(mac, N);
   tag = _mm_xor_si128(tag, H);
   StorePartialBlock(out, kTagSize, tag);
@@ -424,7 +482,6 @@ bool AesEaxAesni::RawDecrypt(absl::string_view nonce, absl::string_view in,
                              absl::string_view additional_data,
                              absl::Span<uint8_t> plaintext) const {
   __m128i N = OMAC(nonce, 0);
-  __m128i H = OMAC(additional_data, 1);
 
   const uint8_t* ciphertext = reinterpret_cast<const uint8_t*>(in.data());
   const size_t ciphertext_size = in.size();
@@ -443,15 +500,18 @@ bool AesEaxAesni::RawDecrypt(absl::string_view nonce, absl::string_view in,
 
   // A CBC-MAC is reversible. This allows to pipeline the MAC verification
   // by recomputing the MAC for the first half of the ciphertext and
-  // reversion the MAC for the second half.
+  // reversion the MAC for the second half. Reversing starts from
+  // tag ^ N ^ H, so the OMAC of the header is computed first, alongside
+  // the first blocks of the forward half.
+  IncrementalOmac header_omac(*this, additional_data, 1);
   __m128i mac_forward = _mm_set_epi32(0x2000000, 0, 0, 0);
-  __m128i mac_backward = _mm_xor_si128(tag, N);
-  mac_backward = _mm_xor_si128(mac_backward, H);
 
   // Special case code for empty messages of size 0.
   if (plaintext.empty()) {
     mac_forward = _mm_xor_si128(mac_forward, *B_);
     mac_forward = EncryptBlock(mac_forward);
+    __m128i mac_backward = _mm_xor_si128(tag, N);
+    mac_backward = _mm_xor_si128(mac_backward, header_omac.Finish());
     return EqualBlocks(mac_forward, mac_backward);
   }
 
@@ -461,13 +521,33 @@ bool AesEaxAesni::RawDecrypt(absl::string_view nonce, absl::string_view in,
       reinterpret_cast<const __m128i*>(ciphertext);
   __m128i* plaintext_blocks = reinterpret_cast<__m128i*>(plaintext.data());
   __m128i ctr_forward = Reverse(N);
-  __m128i ctr_backward = Add(ctr_forward, last_block);
-  __m128i unused = _mm_setzero_si128();
   __m128i stream_forward;
+  __m128i header_mac;
+  Encrypt2Blocks(mac_forward, header_omac.NextInput(), &mac_forward,
+                 &header_mac);
+  header_omac.Advance(header_mac);
+  // forward is the first block not yet decrypted and MACed.
+  size_t forward = 0;
+  while (header_omac.pending() && forward < last_block) {
+    __m128i ct = _mm_loadu_si128(&ciphertext_blocks[forward]);
+    mac_forward = _mm_xor_si128(mac_forward, ct);
+    Encrypt3Blocks(Reverse(ctr_forward), mac_forward, header_omac.NextInput(),
+                   &stream_forward, &mac_forward, &header_mac);
+    header_omac.Advance(header_mac);
+    _mm_storeu_si128(&plaintext_blocks[forward],
+                     _mm_xor_si128(ct, stream_forward));
+    ctr_forward = Increment(ctr_forward);
+    forward++;
+  }
+  __m128i mac_backward = _mm_xor_si128(tag, N);
+  mac_backward = _mm_xor_si128(mac_backward, header_omac.Finish());
+
+  __m128i ctr_backward = Add(Reverse(N), last_block);
+  __m128i unused = _mm_setzero_si128();
   __m128i stream_backward;
   Encrypt3Decrypt1(
-      Reverse(ctr_backward), mac_forward, unused, mac_backward,
-      &stream_backward, &mac_forward, &unused, &mac_backward);
+      Reverse(ctr_backward), unused, unused, mac_backward,
+      &stream_backward, &unused, &unused, &mac_backward);
   __m128i ct = LoadPartialBlock(&ciphertext[plaintext.size() - last_block_size],
                                 last_block_size);
   __m128i pt = _mm_xor_si128(ct, stream_backward);
@@ -476,39 +556,41 @@ bool AesEaxAesni::RawDecrypt(absl::string_view nonce, absl::string_view in,
   __m128i padded_last_block =
       Pad(&ciphertext[plaintext.size() - last_block_size], last_block_size);
   mac_backward = _mm_xor_si128(mac_backward, padded_last_block);
-  const size_t mid_block = last_block / 2;
+  // backward is one past the last block not yet decrypted and MACed.
+  size_t backward = last_block;
   // Decrypts two blocks concurrently as long as there are at least two
   // blocks to decrypt. The two blocks are the first block not yet decrypted
   // and the last block not yet decrypted. The reason for this is that the
   // OMAC can be verified at the same time. mac_forward is the OMAC of leading
   // ciphertext blocks that have already been decrypted. mac_backward is the
-  // partial result for the OMAC up to block last_block - i - 1 that is
+  // partial result for the OMAC up to block backward - 1 that is
   // necessary so OMAC of the full encryption results in the tag received from
   // the ciphertext.
-  for (size_t i = 0; i < mid_block; i++) {
+  while (backward - forward >= 2) {
     ctr_backward = Decrement(ctr_backward);
-    __m128i ct_forward = _mm_loadu_si128(&ciphertext_blocks[i]);
-    __m128i ct_backward =
-        _mm_loadu_si128(&ciphertext_blocks[last_block - i - 1]);
+    backward--;
+    __m128i ct_forward = _mm_loadu_si128(&ciphertext_blocks[forward]);
+    __m128i ct_backward = _mm_loadu_si128(&ciphertext_blocks[backward]);
     mac_forward = _mm_xor_si128(mac_forward, ct_forward);
     Encrypt3Decrypt1(
        Reverse(ctr_forward), Reverse(ctr_backward), mac_forward, mac_backward,
         &stream_forward, &stream_backward, &mac_forward, &mac_backward);
     __m128i plaintext_forward = _mm_xor_si128(ct_forward, stream_forward);
     __m128i plaintext_backward = _mm_xor_si128(ct_backward, stream_backward);
-    _mm_storeu_si128(&plaintext_blocks[i], plaintext_forward);
-    _mm_storeu_si128(&plaintext_blocks[last_block - i - 1], plaintext_backward);
+    _mm_storeu_si128(&plaintext_blocks[forward], plaintext_forward);
+    _mm_storeu_si128(&plaintext_blocks[backward], plaintext_backward);
     mac_backward = _mm_xor_si128(mac_backward, ct_backward);
     ctr_forward = Increment(ctr_forward);
+    forward++;
   }
   // Decrypts and MACs another block, if there is a single block in the middle.
-  if (last_block & 1) {
-    __m128i ct = _mm_loadu_si128(&ciphertext_blocks[mid_block]);
+  if (backward - forward == 1) {
+    __m128i ct = _mm_loadu_si128(&ciphertext_blocks[forward]);
     mac_forward = _mm_xor_si128(mac_forward, ct);
     Encrypt2Blocks(
         Reverse(ctr_forward), mac_forward, &stream_forward, &mac_forward);
     __m128i pt = _mm_xor_si128(ct, stream_forward);
-    _mm_storeu_si128(&plaintext_blocks[mid_block], pt);
+    _mm_storeu_si128(&plaintext_blocks[forward], pt);
   }
   if (!EqualBlocks(mac_forward, mac_backward)) {
     absl::c_fill(plaintext, 0);
@@ -530,8 +612,10 @@ crypto::tink::util::StatusOr<std::string> AesEaxAesni::Encrypt(
   size_t ciphertext_size = plaintext.size() + nonce_size_ + kTagSize;
   std::string ciphertext;
   ResizeStringUninitialized(&ciphertext, ciphertext_size);
-  const std::string nonce = Random::GetRandomBytes(nonce_size_);
-  absl::c_copy(nonce, ciphertext.begin());
+  auto status =
+      Random::GetRandomBytes(absl::MakeSpan(&ciphertext[0], nonce_size_));
+  if (!status.ok()) return status;
+  absl::string_view nonce(ciphertext.data(), nonce_size_);
   bool result = RawEncrypt(
       nonce, plaintext, additional_data,
       absl::MakeSpan(reinterpret_cast<uint8_t*>(&ciphertext[nonce_size_]),
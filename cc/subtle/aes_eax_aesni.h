@@ -42,6 +42,12 @@ namespace subtle {
 // Currently the implementation supports 128 and 256 bit keys and 96 or 128 bit
 // nonces. AES-EAX allows arbitrary nonce sizes. Allowing only 96 or 128 bits
 // is a tink specific restriction.
+//
+// The OMACs are CBC-MACs, and hence bound by the latency of AES rather than
+// its throughput. The CTR key stream is computed in the gaps of the OMAC of
+// the ciphertext, and so is the OMAC of the header: when encrypting
+// alongside the OMAC of the ciphertext, and when decrypting alongside the
+// forward half of it, since the backward half needs the header's OMAC.
 class AesEaxAesni : public Aead {
  public:
   static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
@@ -87,6 +93,10 @@ class AesEaxAesni : public Aead {
       __m128i *out0,
       __m128i *out1) const;
 
+  // Encrypt 3 blocks with plain AES.
+  void Encrypt3Blocks(const __m128i in0, const __m128i in1, const __m128i in2,
+                      __m128i* out0, __m128i* out1, __m128i* out2) const;
+
   // Encrypt 3 blocks and decrypts 1 block.
   // This is used to decrypt a ciphertext and verify the MAC concurrently.
   void Encrypt3Decrypt1(
@@ -105,6 +115,34 @@ class AesEaxAesni : public Aead {
   // Computes an OMAC.
   __m128i OMAC(absl::string_view blob, int tag) const;
 
+  // Computes an OMAC one AES call at a time, so that it can share the AES
+  // unit with another computation.
+  class IncrementalOmac {
+   public:
+    IncrementalOmac(const AesEaxAesni& eax, absl::string_view blob, int tag);
+
+    // Returns true if the OMAC needs more AES calls.
+    bool pending() const { return step_ < steps_; }
+    // Returns the input of the next AES call; only valid if pending().
+    __m128i NextInput() const;
+    // Sets the state to the output of the AES call on NextInput().
+    void Advance(__m128i output) {
+      state_ = output;
+      step_++;
+    }
+    // Finishes the computation and returns the OMAC.
+    __m128i Finish();
+
+   private:
+    const AesEaxAesni& eax_;
+    const uint8_t* data_;
+    size_t size_;
+    int tag_;
+    size_t step_ = 0;
+    size_t steps_;
+    __m128i state_;
+  };
+
   static constexpr int kMaxRounds = 14;  // maximal number of rounds
   static constexpr int kMaxRoundKeys =
       kMaxRounds + 1;  // max number of round keys
@@ -23,6 +23,8 @@
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "tink/subtle/aes_eax_boringssl.h"
+#include "tink/subtle/random.h"
 #include "tink/subtle/wycheproof_util.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/status.h"
@@ -89,6 +91,44 @@ TEST(AesEaxAesniTest, testAadSize) {
   }
 }
 
+// The header OMAC is interleaved with the encryption of the message, so
+// the combinations of long and short headers and messages are compared
+// with AesEaxBoringSsl.
+TEST(AesEaxAesniTest, testMatchesBoringSsl) {
+  util::SecretData key = Random::GetRandomKeyBytes(32);
+  auto res = AesEaxAesni::New(key, 16);
+  EXPECT_TRUE(res.ok()) << res.status();
+  auto cipher = std::move(res.ValueOrDie());
+  auto reference_res = AesEaxBoringSsl::New(key, 16);
+  EXPECT_TRUE(reference_res.ok()) << reference_res.status();
+  auto reference = std::move(reference_res.ValueOrDie());
+  for (size_t size : {0, 1, 15, 16, 17, 32, 33, 48, 255, 256, 257, 4097}) {
+    for (size_t aad_size : {0, 1, 15, 16, 17, 32, 33, 300, 5000}) {
+      std::string message = Random::GetRandomBytes(size);
+      std::string aad = Random::GetRandomBytes(aad_size);
+      auto ct = cipher->Encrypt(message, aad);
+      EXPECT_TRUE(ct.ok()) << ct.status();
+      auto pt = reference->Decrypt(ct.ValueOrDie(), aad);
+      EXPECT_TRUE(pt.ok()) << size << " " << aad_size;
+      EXPECT_EQ(pt.ValueOrDie(), message);
+
+      ct = reference->Encrypt(message, aad);
+      EXPECT_TRUE(ct.ok()) << ct.status();
+      pt = cipher->Decrypt(ct.ValueOrDie(), aad);
+      EXPECT_TRUE(pt.ok()) << size << " " << aad_size;
+      EXPECT_EQ(pt.ValueOrDie(), message);
+
+      // Flip a bit at the start, in the middle and in the tag.
+      for (size_t pos : {size_t{16}, 16 + size / 2, 16 + size + 15}) {
+        std::string modified = ct.ValueOrDie();
+        modified[pos] ^= 1;
+        EXPECT_FALSE(cipher->Decrypt(modified, aad).ok())
+            << size << " " << aad_size << " " << pos;
+      }
+    }
+  }
+}
+
 TEST(AesEaxAesniTest, testLongNonce) {
   util::SecretData key = util::SecretDataFromStringView(
       test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
@@ -26,6 +26,7 @@
 #include "openssl/evp.h"
 #include "tink/config/tink_fips.h"
 #include "tink/aead.h"
+#include "tink/space_used.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -34,7 +35,7 @@ namespace crypto {
 namespace tink {
 namespace subtle {
 
-class AesEaxBoringSsl : public Aead {
+class AesEaxBoringSsl : public Aead, public SpaceUsedInterface {
  public:
   // Constructs a new Aead cipher for Aes-EAX.
   // Currently supported key sizes are 128 and 256 bits.
@@ -51,6 +52,21 @@ class AesEaxBoringSsl : public Aead {
       absl::string_view ciphertext,
       absl::string_view additional_data) const override;
 
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override;
+
+  crypto::tink::util::StatusOr<int64_t> EncryptInto(
+      absl::string_view plaintext, absl::string_view additional_data,
+      absl::Span<char> ciphertext_buffer) const override;
+
+  crypto::tink::util::StatusOr<int64_t> DecryptInto(
+      absl::string_view ciphertext, absl::string_view additional_data,
+      absl::Span<char> plaintext_buffer) const override;
+
+  size_t SpaceUsed() const override {
+    return sizeof(*this) + sizeof(AES_KEY);
+  }
+
   static constexpr crypto::tink::FipsCompatibility kFipsStatus =
       crypto::tink::FipsCompatibility::kNotFips;
 
@@ -57,6 +57,53 @@ TEST(AesEaxBoringSslTest, TestBasic) {
   EXPECT_EQ(pt.ValueOrDie(), message);
 }
 
+TEST(AesEaxBoringSslTest, EncryptIntoDecryptInto) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::SecretData key =
+      util::SecretDataFromStringView(test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
+  auto cipher_or = AesEaxBoringSsl::New(key, 12);
+  ASSERT_TRUE(cipher_or.ok()) << cipher_or.status();
+  auto cipher = std::move(cipher_or.ValueOrDie());
+  std::string message = "Some data to encrypt.";
+  std::string aad = "Some data to authenticate.";
+
+  auto ciphertext_size_or = cipher->CiphertextSize(message.size());
+  ASSERT_TRUE(ciphertext_size_or.ok()) << ciphertext_size_or.status();
+  EXPECT_EQ(ciphertext_size_or.ValueOrDie(), message.size() + 12 + 16);
+  std::string ciphertext(ciphertext_size_or.ValueOrDie(), '\0');
+  auto written_or = cipher->EncryptInto(
+      message, aad, absl::MakeSpan(&ciphertext[0], ciphertext.size()));
+  ASSERT_TRUE(written_or.ok()) << written_or.status();
+  EXPECT_EQ(written_or.ValueOrDie(), ciphertext.size());
+
+  // Both decryption entry points accept the ciphertext.
+  auto pt = cipher->Decrypt(ciphertext, aad);
+  ASSERT_TRUE(pt.ok()) << pt.status();
+  EXPECT_EQ(pt.ValueOrDie(), message);
+  std::string plaintext(message.size(), '\0');
+  written_or = cipher->DecryptInto(
+      ciphertext, aad, absl::MakeSpan(&plaintext[0], plaintext.size()));
+  ASSERT_TRUE(written_or.ok()) << written_or.status();
+  EXPECT_EQ(written_or.ValueOrDie(), message.size());
+  EXPECT_EQ(plaintext, message);
+
+  // Buffers that are too small are rejected.
+  EXPECT_THAT(cipher
+                  ->EncryptInto(message, aad,
+                                absl::MakeSpan(&ciphertext[0],
+                                               ciphertext.size() - 1))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(cipher
+                  ->DecryptInto(ciphertext, aad,
+                                absl::MakeSpan(&plaintext[0],
+                                               plaintext.size() - 1))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 TEST(AesEaxBoringSslTest, TestMessageSize) {
   if (kUseOnlyFips) {
     GTEST_SKIP() << "Not supported in FIPS-only mode";
@@ -16,6 +16,8 @@
 
 #include "tink/subtle/aes_gcm_boringssl.h"
 
+#include <algorithm>
+#include <string>
 #include <utility>
 
 #include "absl/memory/memory.h"
@@ -51,19 +53,12 @@ util::StatusOr<std::unique_ptr<Aead>> AesGcmBoringSsl::New(
 
 util::StatusOr<std::string> AesGcmBoringSsl::Encrypt(
     absl::string_view plaintext, absl::string_view additional_data) const {
-  std::string result = Random::GetRandomBytes(kIvSizeInBytes);
+  std::string result;
   ResizeStringUninitialized(
       &result, kIvSizeInBytes + plaintext.size() + kTagSizeInBytes);
-  size_t len;
-  if (EVP_AEAD_CTX_seal(
-          ctx_.get(), reinterpret_cast<uint8_t*>(&result[kIvSizeInBytes]), &len,
-          plaintext.size() + kTagSizeInBytes,
-          reinterpret_cast<const uint8_t*>(&result[0]), kIvSizeInBytes,
-          reinterpret_cast<const uint8_t*>(plaintext.data()), plaintext.size(),
-          reinterpret_cast<const uint8_t*>(additional_data.data()),
-          additional_data.size()) != 1) {
-    return util::Status(util::error::INTERNAL, "Encryption failed");
-  }
+  auto written_or = EncryptInto(plaintext, additional_data,
+                                absl::MakeSpan(&result[0], result.size()));
+  if (!written_or.ok()) return written_or.status();
   return result;
 }
 
@@ -76,10 +71,100 @@ util::StatusOr<std::string> AesGcmBoringSsl::Decrypt(
   std::string result;
   ResizeStringUninitialized(
       &result, ciphertext.size() - kIvSizeInBytes - kTagSizeInBytes);
+  auto written_or = DecryptInto(ciphertext, additional_data,
+                                absl::MakeSpan(&result[0], result.size()));
+  if (!written_or.ok()) return written_or.status();
+  return result;
+}
+
+util::StatusOr<int64_t> AesGcmBoringSsl::CiphertextSize(
+    int64_t plaintext_size) const {
+  if (plaintext_size < 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Plaintext size must be non-negative");
+  }
+  return kIvSizeInBytes + plaintext_size + kTagSizeInBytes;
+}
+
+util::StatusOr<int64_t> AesGcmBoringSsl::EncryptInto(
+    absl::string_view plaintext, absl::string_view additional_data,
+    absl::Span<char> ciphertext_buffer) const {
+  const size_t ciphertext_size =
+      kIvSizeInBytes + plaintext.size() + kTagSizeInBytes;
+  if (ciphertext_buffer.size() < ciphertext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Ciphertext buffer too small");
+  }
+  auto status =
+      Random::GetRandomBytes(ciphertext_buffer.subspan(0, kIvSizeInBytes));
+  if (!status.ok()) return status;
+  status = SealWithIvInBuffer(plaintext, additional_data, ciphertext_buffer);
+  if (!status.ok()) return status;
+  return ciphertext_size;
+}
+
+util::Status AesGcmBoringSsl::EncryptBatchInto(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::Span<const absl::string_view> additional_data,
+    absl::Span<const absl::Span<char>> ciphertext_buffers) const {
+  if (plaintexts.size() != additional_data.size() ||
+      plaintexts.size() != ciphertext_buffers.size()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Batch sizes do not match");
+  }
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    if (ciphertext_buffers[i].size() <
+        kIvSizeInBytes + plaintexts[i].size() + kTagSizeInBytes) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Ciphertext buffer too small");
+    }
+  }
+  std::string ivs;
+  ResizeStringUninitialized(&ivs, plaintexts.size() * kIvSizeInBytes);
+  auto status = Random::GetRandomBytes(absl::MakeSpan(&ivs[0], ivs.size()));
+  if (!status.ok()) return status;
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    std::copy_n(&ivs[i * kIvSizeInBytes], kIvSizeInBytes,
+                ciphertext_buffers[i].data());
+    status = SealWithIvInBuffer(plaintexts[i], additional_data[i],
+                                ciphertext_buffers[i]);
+    if (!status.ok()) return status;
+  }
+  return util::Status::OK;
+}
+
+util::Status AesGcmBoringSsl::SealWithIvInBuffer(
+    absl::string_view plaintext, absl::string_view additional_data,
+    absl::Span<char> ciphertext_buffer) const {
+  uint8_t* iv = reinterpret_cast<uint8_t*>(ciphertext_buffer.data());
+  size_t len;
+  if (EVP_AEAD_CTX_seal(
+          ctx_.get(), iv + kIvSizeInBytes, &len,
+          plaintext.size() + kTagSizeInBytes, iv, kIvSizeInBytes,
+          reinterpret_cast<const uint8_t*>(plaintext.data()), plaintext.size(),
+          reinterpret_cast<const uint8_t*>(additional_data.data()),
+          additional_data.size()) != 1) {
+    return util::Status(util::error::INTERNAL, "Encryption failed");
+  }
+  return util::Status::OK;
+}
+
+util::StatusOr<int64_t> AesGcmBoringSsl::DecryptInto(
+    absl::string_view ciphertext, absl::string_view additional_data,
+    absl::Span<char> plaintext_buffer) const {
+  if (ciphertext.size() < kIvSizeInBytes + kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  const size_t plaintext_size =
+      ciphertext.size() - kIvSizeInBytes - kTagSizeInBytes;
+  if (plaintext_buffer.size() < plaintext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Plaintext buffer too small");
+  }
   size_t len;
   if (EVP_AEAD_CTX_open(
-          ctx_.get(), reinterpret_cast<uint8_t*>(&result[0]), &len,
-          result.size(),
+          ctx_.get(), reinterpret_cast<uint8_t*>(plaintext_buffer.data()), &len,
+          plaintext_size,
           // The nonce is the first |kIvSizeInBytes| bytes of |ciphertext|.
           reinterpret_cast<const uint8_t*>(ciphertext.data()), kIvSizeInBytes,
           // The input is the remainder.
@@ -89,7 +174,7 @@ util::StatusOr<std::string> AesGcmBoringSsl::Decrypt(
           additional_data.size()) != 1) {
     return util::Status(util::error::INTERNAL, "Authentication failed");
   }
-  return result;
+  return len;
 }
 
 }  // namespace subtle
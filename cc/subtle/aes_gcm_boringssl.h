@@ -21,9 +21,11 @@
 #include <utility>
 
 #include "absl/base/macros.h"
+#include "absl/types/span.h"
 #include "openssl/aead.h"
 #include "tink/aead.h"
 #include "tink/config/tink_fips.h"
+#include "tink/space_used.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/statusor.h"
 
@@ -31,7 +33,7 @@ namespace crypto {
 namespace tink {
 namespace subtle {
 
-class AesGcmBoringSsl : public Aead {
+class AesGcmBoringSsl : public Aead, public SpaceUsedInterface {
  public:
   ABSL_DEPRECATED("Use AesGcmBoringSsl::New(const util::SecretData&) instead.")
   static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
@@ -49,6 +51,33 @@ class AesGcmBoringSsl : public Aead {
       absl::string_view ciphertext,
       absl::string_view additional_data) const override;
 
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override;
+
+  crypto::tink::util::StatusOr<int64_t> EncryptInto(
+      absl::string_view plaintext, absl::string_view additional_data,
+      absl::Span<char> ciphertext_buffer) const override;
+
+  crypto::tink::util::StatusOr<int64_t> DecryptInto(
+      absl::string_view ciphertext, absl::string_view additional_data,
+      absl::Span<char> plaintext_buffer) const override;
+
+  // VerifyCiphertext() is not overridden: BoringSSL offers no GHASH-only
+  // check of the tag, so verifying a ciphertext decrypts it like
+  // DecryptInto() does.
+
+  // Draws the nonces for the whole batch with a single call to the random
+  // number generator.
+  crypto::tink::util::Status EncryptBatchInto(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::Span<const absl::string_view> additional_data,
+      absl::Span<const absl::Span<char>> ciphertext_buffers) const override;
+
+  // The expanded key is part of the EVP_AEAD_CTX.
+  size_t SpaceUsed() const override {
+    return sizeof(*this) + sizeof(EVP_AEAD_CTX);
+  }
+
   static constexpr crypto::tink::FipsCompatibility kFipsStatus =
       crypto::tink::FipsCompatibility::kRequiresBoringCrypto;
 
@@ -59,6 +88,12 @@ class AesGcmBoringSsl : public Aead {
   explicit AesGcmBoringSsl(bssl::UniquePtr<EVP_AEAD_CTX> ctx)
       : ctx_(std::move(ctx)) {}
 
+  // Encrypts 'plaintext' into 'ciphertext_buffer', whose first
+  // kIvSizeInBytes bytes already hold the IV.
+  crypto::tink::util::Status SealWithIvInBuffer(
+      absl::string_view plaintext, absl::string_view additional_data,
+      absl::Span<char> ciphertext_buffer) const;
+
   bssl::UniquePtr<EVP_AEAD_CTX> ctx_;
 };
 
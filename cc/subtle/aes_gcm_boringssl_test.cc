@@ -25,7 +25,10 @@
 #include "openssl/err.h"
 #include "include/rapidjson/document.h"
 #include "tink/config/tink_fips.h"
+#include "tink/subtle/random.h"
 #include "tink/subtle/wycheproof_util.h"
+#include "tink/util/allocation_counter.h"
+#include "tink/util/inlined_buffer.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -62,6 +65,116 @@ TEST(AesGcmBoringSslTest, testBasic) {
   EXPECT_EQ(pt.ValueOrDie(), message);
 }
 
+TEST(AesGcmBoringSslTest, EncryptIntoDecryptInto) {
+  if (kUseOnlyFips && !FIPS_mode()) {
+    GTEST_SKIP()
+        << "Test should not run in FIPS mode when BoringCrypto is unavailable.";
+  }
+  util::SecretData key =
+      util::SecretDataFromStringView(test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
+  auto cipher_or = AesGcmBoringSsl::New(key);
+  ASSERT_TRUE(cipher_or.ok()) << cipher_or.status();
+  auto cipher = std::move(cipher_or.ValueOrDie());
+  std::string message = "Some data to encrypt.";
+  std::string aad = "Some data to authenticate.";
+
+  auto ciphertext_size_or = cipher->CiphertextSize(message.size());
+  ASSERT_TRUE(ciphertext_size_or.ok()) << ciphertext_size_or.status();
+  EXPECT_EQ(ciphertext_size_or.ValueOrDie(), message.size() + 12 + 16);
+  std::string ciphertext(ciphertext_size_or.ValueOrDie(), '\0');
+  auto written_or = cipher->EncryptInto(
+      message, aad, absl::MakeSpan(&ciphertext[0], ciphertext.size()));
+  ASSERT_TRUE(written_or.ok()) << written_or.status();
+  EXPECT_EQ(written_or.ValueOrDie(), ciphertext.size());
+
+  // Both decryption entry points accept the ciphertext.
+  auto pt = cipher->Decrypt(ciphertext, aad);
+  ASSERT_TRUE(pt.ok()) << pt.status();
+  EXPECT_EQ(pt.ValueOrDie(), message);
+  std::string plaintext(message.size(), '\0');
+  written_or = cipher->DecryptInto(
+      ciphertext, aad, absl::MakeSpan(&plaintext[0], plaintext.size()));
+  ASSERT_TRUE(written_or.ok()) << written_or.status();
+  EXPECT_EQ(written_or.ValueOrDie(), message.size());
+  EXPECT_EQ(plaintext, message);
+
+  // Buffers that are too small are rejected.
+  EXPECT_THAT(cipher
+                  ->EncryptInto(message, aad,
+                                absl::MakeSpan(&ciphertext[0],
+                                               ciphertext.size() - 1))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(cipher
+                  ->DecryptInto(ciphertext, aad,
+                                absl::MakeSpan(&plaintext[0],
+                                               plaintext.size() - 1))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(AesGcmBoringSslTest, AllocationBudget) {
+  if (kUseOnlyFips && !FIPS_mode()) {
+    GTEST_SKIP()
+        << "Test should not run in FIPS mode when BoringCrypto is unavailable.";
+  }
+  auto cipher_or = AesGcmBoringSsl::New(Random::GetRandomKeyBytes(16));
+  ASSERT_TRUE(cipher_or.ok()) << cipher_or.status();
+  const Aead& cipher = *cipher_or.ValueOrDie();
+  std::string message = "Some data to encrypt.";
+  std::string aad = "Some data to authenticate.";
+
+  util::InlinedBuffer<64> ciphertext;
+  test::AllocationCounter counter;
+  util::Status status = cipher.Encrypt(message, aad, &ciphertext);
+  int64_t allocations = counter.count();
+  ASSERT_THAT(status, IsOk());
+  EXPECT_EQ(allocations, 0);
+
+  util::InlinedBuffer<64> plaintext;
+  counter.Reset();
+  status = cipher.Decrypt(ciphertext.AsStringView(), aad, &plaintext);
+  allocations = counter.count();
+  ASSERT_THAT(status, IsOk());
+  EXPECT_EQ(allocations, 0);
+  EXPECT_EQ(plaintext.AsStringView(), message);
+}
+
+TEST(AesGcmBoringSslTest, EncryptBatch) {
+  if (kUseOnlyFips && !FIPS_mode()) {
+    GTEST_SKIP()
+        << "Test should not run in FIPS mode when BoringCrypto is unavailable.";
+  }
+
+  util::SecretData key = util::SecretDataFromStringView(
+      test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
+  auto cipher = std::move(AesGcmBoringSsl::New(key).ValueOrDie());
+  std::vector<absl::string_view> messages = {"first", "", "third message"};
+  std::vector<absl::string_view> aads = {"aad", "", "other aad"};
+
+  std::string arena;
+  std::vector<absl::string_view> ciphertexts;
+  ASSERT_THAT(cipher->EncryptBatch(messages, aads, &arena, &ciphertexts),
+              IsOk());
+  ASSERT_EQ(ciphertexts.size(), messages.size());
+  for (int i = 0; i < messages.size(); i++) {
+    EXPECT_EQ(ciphertexts[i].size(), messages[i].size() + 12 + 16);
+    auto pt = cipher->Decrypt(ciphertexts[i], aads[i]);
+    ASSERT_THAT(pt.status(), IsOk());
+    EXPECT_EQ(pt.ValueOrDie(), messages[i]);
+  }
+  // Every message gets a fresh IV.
+  EXPECT_NE(ciphertexts[0].substr(0, 12), ciphertexts[1].substr(0, 12));
+  EXPECT_NE(ciphertexts[1].substr(0, 12), ciphertexts[2].substr(0, 12));
+
+  std::string plaintext_arena;
+  std::vector<absl::string_view> plaintexts;
+  ASSERT_THAT(
+      cipher->DecryptBatch(ciphertexts, aads, &plaintext_arena, &plaintexts),
+      IsOk());
+  EXPECT_EQ(plaintexts, messages);
+}
+
 TEST(AesGcmBoringSslTest, testModification) {
   if (kUseOnlyFips && !FIPS_mode()) {
     GTEST_SKIP()
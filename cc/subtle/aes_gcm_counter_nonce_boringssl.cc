@@ -0,0 +1,217 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_gcm_counter_nonce_boringssl.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/fork_hooks.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+util::StatusOr<std::unique_ptr<Aead>> AesGcmCounterNonceBoringSsl::New(
+    const util::SecretData& key, uint64_t max_messages) {
+  auto status = CheckFipsCompatibility<AesGcmCounterNonceBoringSsl>();
+  if (!status.ok()) return status;
+
+  if (max_messages == 0 || max_messages > kMaxMessages) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "max_messages must be in [1, 2^32]");
+  }
+  const EVP_AEAD* aead =
+      SubtleUtilBoringSSL::GetAesGcmAeadForKeySize(key.size());
+  if (aead == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
+  }
+  bssl::UniquePtr<EVP_AEAD_CTX> ctx(EVP_AEAD_CTX_new(
+      aead, key.data(), key.size(), EVP_AEAD_DEFAULT_TAG_LENGTH));
+  if (!ctx) {
+    return util::Status(util::error::INTERNAL,
+                        "could not initialize EVP_AEAD_CTX");
+  }
+  return {absl::WrapUnique(new AesGcmCounterNonceBoringSsl(
+      std::move(ctx), Random::GetRandomBytes(kPrefixSizeInBytes),
+      max_messages))};
+}
+
+util::StatusOr<std::string> AesGcmCounterNonceBoringSsl::Encrypt(
+    absl::string_view plaintext, absl::string_view additional_data) const {
+  std::string result;
+  ResizeStringUninitialized(
+      &result, kIvSizeInBytes + plaintext.size() + kTagSizeInBytes);
+  auto written_or = EncryptInto(plaintext, additional_data,
+                                absl::MakeSpan(&result[0], result.size()));
+  if (!written_or.ok()) return written_or.status();
+  return result;
+}
+
+util::StatusOr<std::string> AesGcmCounterNonceBoringSsl::Decrypt(
+    absl::string_view ciphertext, absl::string_view additional_data) const {
+  if (ciphertext.size() < kIvSizeInBytes + kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+
+  std::string result;
+  ResizeStringUninitialized(
+      &result, ciphertext.size() - kIvSizeInBytes - kTagSizeInBytes);
+  auto written_or = DecryptInto(ciphertext, additional_data,
+                                absl::MakeSpan(&result[0], result.size()));
+  if (!written_or.ok()) return written_or.status();
+  return result;
+}
+
+util::StatusOr<int64_t> AesGcmCounterNonceBoringSsl::CiphertextSize(
+    int64_t plaintext_size) const {
+  if (plaintext_size < 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Plaintext size must be non-negative");
+  }
+  return kIvSizeInBytes + plaintext_size + kTagSizeInBytes;
+}
+
+void AesGcmCounterNonceBoringSsl::RenewPrefixAfterFork() const {
+  absl::MutexLock lock(&renew_mutex_);
+  uint64_t generation = util::ForkGeneration();
+  if (fork_generation_.load(std::memory_order_relaxed) == generation) return;
+  prefix_ = Random::GetRandomBytes(kPrefixSizeInBytes);
+  next_counter_.store(0, std::memory_order_relaxed);
+  fork_generation_.store(generation, std::memory_order_release);
+}
+
+util::StatusOr<uint64_t> AesGcmCounterNonceBoringSsl::ReserveCounters(
+    size_t count) const {
+  // The prefix and the counter inherited from the parent of a fork() are
+  // shared with its other children.
+  if (fork_generation_.load(std::memory_order_acquire) !=
+      util::ForkGeneration()) {
+    RenewPrefixAfterFork();
+  }
+  uint64_t first = next_counter_.fetch_add(count, std::memory_order_relaxed);
+  if (first > max_messages_ || count > max_messages_ - first) {
+    return util::Status(util::error::RESOURCE_EXHAUSTED,
+                        "Message limit of this primitive reached");
+  }
+  return first;
+}
+
+util::StatusOr<int64_t> AesGcmCounterNonceBoringSsl::EncryptInto(
+    absl::string_view plaintext, absl::string_view additional_data,
+    absl::Span<char> ciphertext_buffer) const {
+  const size_t ciphertext_size =
+      kIvSizeInBytes + plaintext.size() + kTagSizeInBytes;
+  if (ciphertext_buffer.size() < ciphertext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Ciphertext buffer too small");
+  }
+  auto counter_or = ReserveCounters(1);
+  if (!counter_or.ok()) return counter_or.status();
+  auto status = Seal(counter_or.ValueOrDie(), plaintext, additional_data,
+                     ciphertext_buffer);
+  if (!status.ok()) return status;
+  return ciphertext_size;
+}
+
+util::Status AesGcmCounterNonceBoringSsl::EncryptBatchInto(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::Span<const absl::string_view> additional_data,
+    absl::Span<const absl::Span<char>> ciphertext_buffers) const {
+  if (plaintexts.size() != additional_data.size() ||
+      plaintexts.size() != ciphertext_buffers.size()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Batch sizes do not match");
+  }
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    if (ciphertext_buffers[i].size() <
+        kIvSizeInBytes + plaintexts[i].size() + kTagSizeInBytes) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Ciphertext buffer too small");
+    }
+  }
+  if (plaintexts.empty()) return util::OkStatus();
+  auto first_or = ReserveCounters(plaintexts.size());
+  if (!first_or.ok()) return first_or.status();
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    auto status = Seal(first_or.ValueOrDie() + i, plaintexts[i],
+                       additional_data[i], ciphertext_buffers[i]);
+    if (!status.ok()) return status;
+  }
+  return util::OkStatus();
+}
+
+util::Status AesGcmCounterNonceBoringSsl::Seal(
+    uint64_t counter, absl::string_view plaintext,
+    absl::string_view additional_data,
+    absl::Span<char> ciphertext_buffer) const {
+  uint8_t* iv = reinterpret_cast<uint8_t*>(ciphertext_buffer.data());
+  std::copy_n(prefix_.data(), kPrefixSizeInBytes, iv);
+  for (int i = 0; i < kIvSizeInBytes - kPrefixSizeInBytes; i++) {
+    iv[kPrefixSizeInBytes + i] = static_cast<uint8_t>(counter >> (24 - 8 * i));
+  }
+  size_t len;
+  if (EVP_AEAD_CTX_seal(
+          ctx_.get(), iv + kIvSizeInBytes, &len,
+          plaintext.size() + kTagSizeInBytes, iv, kIvSizeInBytes,
+          reinterpret_cast<const uint8_t*>(plaintext.data()), plaintext.size(),
+          reinterpret_cast<const uint8_t*>(additional_data.data()),
+          additional_data.size()) != 1) {
+    return util::Status(util::error::INTERNAL, "Encryption failed");
+  }
+  return util::OkStatus();
+}
+
+util::StatusOr<int64_t> AesGcmCounterNonceBoringSsl::DecryptInto(
+    absl::string_view ciphertext, absl::string_view additional_data,
+    absl::Span<char> plaintext_buffer) const {
+  if (ciphertext.size() < kIvSizeInBytes + kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  const size_t plaintext_size =
+      ciphertext.size() - kIvSizeInBytes - kTagSizeInBytes;
+  if (plaintext_buffer.size() < plaintext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Plaintext buffer too small");
+  }
+  size_t len;
+  if (EVP_AEAD_CTX_open(
+          ctx_.get(), reinterpret_cast<uint8_t*>(plaintext_buffer.data()), &len,
+          plaintext_size,
+          // The nonce is the first |kIvSizeInBytes| bytes of |ciphertext|.
+          reinterpret_cast<const uint8_t*>(ciphertext.data()), kIvSizeInBytes,
+          // The input is the remainder.
+          reinterpret_cast<const uint8_t*>(ciphertext.data()) + kIvSizeInBytes,
+          ciphertext.size() - kIvSizeInBytes,
+          reinterpret_cast<const uint8_t*>(additional_data.data()),
+          additional_data.size()) != 1) {
+    return util::Status(util::error::INTERNAL, "Authentication failed");
+  }
+  return len;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
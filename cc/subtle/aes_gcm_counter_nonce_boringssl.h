@@ -0,0 +1,139 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_AES_GCM_COUNTER_NONCE_BORINGSSL_H_
+#define TINK_SUBTLE_AES_GCM_COUNTER_NONCE_BORINGSSL_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "openssl/aead.h"
+#include "tink/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/util/fork_hooks.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// AES-GCM with deterministically constructed nonces (NIST SP 800-38D,
+// Section 8.2.1). New() draws a random 8 byte prefix, and the nonce of each
+// message is the prefix followed by a 4 byte big-endian counter, so that
+// encryption does not call the random number generator. Ciphertexts have
+// the same format as those of AesGcmBoringSsl, which decrypts them (and
+// vice versa).
+//
+// Each instance encrypts at most 'max_messages' messages, and at most 2^32
+// messages; after that, encryption fails with RESOURCE_EXHAUSTED and a new
+// primitive (with a fresh prefix) must be created. Instances sharing a key
+// only risk reusing a nonce if they draw the same 64-bit prefix.
+//
+// The child of a fork() draws a new prefix and restarts the counter at its
+// first encryption, so that processes forked from the one which created the
+// primitive never use the nonces of each other; the message limit applies
+// to each process separately.
+//
+// Thread safety: This class is thread safe and thus can be used
+// concurrently.
+class AesGcmCounterNonceBoringSsl : public Aead {
+ public:
+  static constexpr uint64_t kMaxMessages = uint64_t{1} << 32;
+
+  static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
+      const util::SecretData& key, uint64_t max_messages = kMaxMessages);
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view additional_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view additional_data) const override;
+
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override;
+
+  crypto::tink::util::StatusOr<int64_t> EncryptInto(
+      absl::string_view plaintext, absl::string_view additional_data,
+      absl::Span<char> ciphertext_buffer) const override;
+
+  crypto::tink::util::StatusOr<int64_t> DecryptInto(
+      absl::string_view ciphertext, absl::string_view additional_data,
+      absl::Span<char> plaintext_buffer) const override;
+
+  // Reserves the counters of the whole batch with a single atomic add.
+  crypto::tink::util::Status EncryptBatchInto(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::Span<const absl::string_view> additional_data,
+      absl::Span<const absl::Span<char>> ciphertext_buffers) const override;
+
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kRequiresBoringCrypto;
+
+ private:
+  static constexpr int kIvSizeInBytes = 12;
+  static constexpr int kPrefixSizeInBytes = 8;
+  static constexpr int kTagSizeInBytes = 16;
+
+  AesGcmCounterNonceBoringSsl(bssl::UniquePtr<EVP_AEAD_CTX> ctx,
+                              std::string prefix, uint64_t max_messages)
+      : ctx_(std::move(ctx)),
+        prefix_(std::move(prefix)),
+        max_messages_(max_messages),
+        fork_generation_(util::ForkGeneration()) {}
+
+  // Reserves 'count' consecutive counter values and returns the first.
+  crypto::tink::util::StatusOr<uint64_t> ReserveCounters(size_t count) const;
+  // Draws a new prefix and restarts the counter, unless this was already
+  // done in the calling process.
+  void RenewPrefixAfterFork() const ABSL_LOCKS_EXCLUDED(renew_mutex_);
+
+  // Writes the nonce of 'counter' to ciphertext_buffer[0 .. 11] and encrypts
+  // 'plaintext' into the rest of 'ciphertext_buffer'.
+  crypto::tink::util::Status Seal(uint64_t counter,
+                                  absl::string_view plaintext,
+                                  absl::string_view additional_data,
+                                  absl::Span<char> ciphertext_buffer) const;
+
+  const bssl::UniquePtr<EVP_AEAD_CTX> ctx_;
+  // Only replaced by RenewPrefixAfterFork(), in a child which has not yet
+  // reserved any counters.
+  mutable std::string prefix_;
+  const uint64_t max_messages_;
+  // The fork generation of prefix_ and next_counter_.
+  mutable std::atomic<uint64_t> fork_generation_;
+  mutable absl::Mutex renew_mutex_;
+  // The number of counter values handed out so far. It may overshoot
+  // max_messages_ by the size of rejected reservations, but no counter at
+  // or above max_messages_ is ever used.
+  mutable std::atomic<uint64_t> next_counter_{0};
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_AES_GCM_COUNTER_NONCE_BORINGSSL_H_
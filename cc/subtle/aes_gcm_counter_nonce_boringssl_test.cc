@@ -0,0 +1,237 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_gcm_counter_nonce_boringssl.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <set>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+using ::testing::Ne;
+
+TEST(AesGcmCounterNonceBoringSslTest, InteroperatesWithAesGcmBoringSsl) {
+  for (int key_size : {16, 32}) {
+    util::SecretData key = Random::GetRandomKeyBytes(key_size);
+    auto aead_or = AesGcmCounterNonceBoringSsl::New(key);
+    ASSERT_THAT(aead_or.status(), IsOk());
+    const Aead& aead = *aead_or.ValueOrDie();
+    auto reference_or = AesGcmBoringSsl::New(key);
+    ASSERT_THAT(reference_or.status(), IsOk());
+    const Aead& reference = *reference_or.ValueOrDie();
+    for (int size : {0, 1, 16, 17, 1000}) {
+      std::string message = Random::GetRandomBytes(size);
+      auto ct = aead.Encrypt(message, "aad");
+      ASSERT_THAT(ct.status(), IsOk());
+      EXPECT_THAT(ct.ValueOrDie().size(), Eq(12 + size + 16));
+      auto pt = reference.Decrypt(ct.ValueOrDie(), "aad");
+      ASSERT_THAT(pt.status(), IsOk());
+      EXPECT_THAT(pt.ValueOrDie(), Eq(message));
+
+      ct = reference.Encrypt(message, "aad");
+      ASSERT_THAT(ct.status(), IsOk());
+      pt = aead.Decrypt(ct.ValueOrDie(), "aad");
+      ASSERT_THAT(pt.status(), IsOk());
+      EXPECT_THAT(pt.ValueOrDie(), Eq(message));
+    }
+  }
+}
+
+TEST(AesGcmCounterNonceBoringSslTest, NonceIsPrefixAndCounter) {
+  util::SecretData key = Random::GetRandomKeyBytes(16);
+  auto aead = std::move(AesGcmCounterNonceBoringSsl::New(key).ValueOrDie());
+  std::string first = aead->Encrypt("message", "").ValueOrDie();
+  EXPECT_THAT(test::HexEncode(first.substr(8, 4)), Eq("00000000"));
+  for (const std::string& counter : {"00000001", "00000002", "00000003"}) {
+    std::string ct = aead->Encrypt("message", "").ValueOrDie();
+    EXPECT_THAT(ct.substr(0, 8), Eq(first.substr(0, 8)));
+    EXPECT_THAT(test::HexEncode(ct.substr(8, 4)), Eq(counter));
+  }
+
+  // Another primitive draws its own prefix.
+  auto other = std::move(AesGcmCounterNonceBoringSsl::New(key).ValueOrDie());
+  std::string ct = other->Encrypt("message", "").ValueOrDie();
+  EXPECT_THAT(ct.substr(0, 8), Ne(first.substr(0, 8)));
+}
+
+TEST(AesGcmCounterNonceBoringSslTest, ChildUsesNewPrefix) {
+  auto aead = std::move(
+      AesGcmCounterNonceBoringSsl::New(Random::GetRandomKeyBytes(16))
+          .ValueOrDie());
+  std::string first = aead->Encrypt("message", "").ValueOrDie();
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    auto ct_or = aead->Encrypt("message", "");
+    if (!ct_or.ok()) _exit(1);
+    ssize_t written = write(fds[1], ct_or.ValueOrDie().data(), 12);
+    _exit(written == 12 ? 0 : 1);
+  }
+  std::string second = aead->Encrypt("message", "").ValueOrDie();
+  std::string child_nonce(12, '\0');
+  ASSERT_EQ(12, read(fds[0], &child_nonce[0], child_nonce.size()));
+  int status;
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+  close(fds[0]);
+  close(fds[1]);
+  // The parent continues its own counter, and the child starts over with a
+  // prefix of its own.
+  EXPECT_THAT(second.substr(0, 8), Eq(first.substr(0, 8)));
+  EXPECT_THAT(test::HexEncode(second.substr(8, 4)), Eq("00000001"));
+  EXPECT_THAT(child_nonce.substr(0, 8), Ne(first.substr(0, 8)));
+  EXPECT_THAT(test::HexEncode(child_nonce.substr(8, 4)), Eq("00000000"));
+}
+
+TEST(AesGcmCounterNonceBoringSslTest, MessageLimit) {
+  auto aead = std::move(
+      AesGcmCounterNonceBoringSsl::New(Random::GetRandomKeyBytes(16), 3)
+          .ValueOrDie());
+  std::string ct;
+  for (int i = 0; i < 3; i++) {
+    auto ct_or = aead->Encrypt("message", "aad");
+    ASSERT_THAT(ct_or.status(), IsOk());
+    ct = ct_or.ValueOrDie();
+  }
+  EXPECT_THAT(aead->Encrypt("message", "aad").status(),
+              StatusIs(util::error::RESOURCE_EXHAUSTED));
+  std::vector<absl::string_view> plaintexts = {"a"};
+  std::vector<absl::string_view> aads = {""};
+  std::string arena;
+  std::vector<absl::string_view> ciphertexts;
+  EXPECT_THAT(aead->EncryptBatch(plaintexts, aads, &arena, &ciphertexts),
+              StatusIs(util::error::RESOURCE_EXHAUSTED));
+  // Decryption is not limited.
+  auto pt = aead->Decrypt(ct, "aad");
+  ASSERT_THAT(pt.status(), IsOk());
+  EXPECT_THAT(pt.ValueOrDie(), Eq("message"));
+}
+
+TEST(AesGcmCounterNonceBoringSslTest, EncryptBatch) {
+  auto aead = std::move(
+      AesGcmCounterNonceBoringSsl::New(Random::GetRandomKeyBytes(32), 5)
+          .ValueOrDie());
+  std::vector<std::string> messages;
+  std::vector<std::string> aads;
+  for (int i = 0; i < 5; i++) {
+    messages.push_back(Random::GetRandomBytes(i * 17));
+    aads.push_back(Random::GetRandomBytes(i));
+  }
+  std::vector<absl::string_view> plaintexts(messages.begin(), messages.end());
+  std::vector<absl::string_view> associated_data(aads.begin(), aads.end());
+  std::string arena;
+  std::vector<absl::string_view> ciphertexts;
+  ASSERT_THAT(
+      aead->EncryptBatch(plaintexts, associated_data, &arena, &ciphertexts),
+      IsOk());
+  ASSERT_THAT(ciphertexts.size(), Eq(messages.size()));
+  for (size_t i = 0; i < messages.size(); i++) {
+    EXPECT_THAT(static_cast<int>(ciphertexts[i][11]), Eq(i));
+    auto pt = aead->Decrypt(ciphertexts[i], aads[i]);
+    ASSERT_THAT(pt.status(), IsOk());
+    EXPECT_THAT(pt.ValueOrDie(), Eq(messages[i]));
+  }
+  EXPECT_THAT(aead->Encrypt("message", "").status(),
+              StatusIs(util::error::RESOURCE_EXHAUSTED));
+}
+
+TEST(AesGcmCounterNonceBoringSslTest, ConcurrentEncryptionsUseDistinctNonces) {
+  auto aead = std::move(
+      AesGcmCounterNonceBoringSsl::New(Random::GetRandomKeyBytes(16))
+          .ValueOrDie());
+  constexpr int kThreads = 4;
+  constexpr int kMessagesPerThread = 100;
+  std::vector<std::vector<std::string>> nonces(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&aead, &nonces, t]() {
+      for (int i = 0; i < kMessagesPerThread; i++) {
+        nonces[t].push_back(
+            aead->Encrypt("message", "").ValueOrDie().substr(0, 12));
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  std::set<std::string> distinct;
+  for (const auto& thread_nonces : nonces) {
+    distinct.insert(thread_nonces.begin(), thread_nonces.end());
+  }
+  EXPECT_THAT(distinct.size(), Eq(kThreads * kMessagesPerThread));
+}
+
+TEST(AesGcmCounterNonceBoringSslTest, InvalidParameters) {
+  for (int key_size : {0, 15, 24, 33}) {
+    EXPECT_THAT(
+        AesGcmCounterNonceBoringSsl::New(util::SecretData(key_size, 'x'))
+            .status(),
+        StatusIs(util::error::INVALID_ARGUMENT))
+        << key_size;
+  }
+  util::SecretData key = Random::GetRandomKeyBytes(16);
+  EXPECT_THAT(AesGcmCounterNonceBoringSsl::New(key, 0).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(
+      AesGcmCounterNonceBoringSsl::New(
+          key, AesGcmCounterNonceBoringSsl::kMaxMessages + 1)
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(AesGcmCounterNonceBoringSslTest, ModifiedCiphertext) {
+  auto aead = std::move(
+      AesGcmCounterNonceBoringSsl::New(Random::GetRandomKeyBytes(16))
+          .ValueOrDie());
+  std::string ct = aead->Encrypt("some message", "aad").ValueOrDie();
+  for (size_t i = 0; i < ct.size(); i++) {
+    std::string modified = ct;
+    modified[i] ^= 1;
+    EXPECT_THAT(aead->Decrypt(modified, "aad").status(),
+                StatusIs(util::error::INTERNAL))
+        << i;
+  }
+  EXPECT_THAT(aead->Decrypt(ct.substr(0, 27), "aad").status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -165,6 +165,30 @@ util::Status AesGcmHkdfStreamSegmentDecrypter::DecryptSegment(
     int64_t segment_number,
     bool is_last_segment,
     std::vector<uint8_t>* plaintext_buffer) {
+  // Keep reporting these errors ahead of a null plaintext_buffer.
+  if (!is_initialized_) {
+    return util::Status(util::error::FAILED_PRECONDITION,
+                        "decrypter not initialized");
+  }
+  if (ciphertext.size() > get_ciphertext_segment_size()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too long");
+  }
+  if (plaintext_buffer == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "plaintext_buffer must be non-null");
+  }
+  const size_t tag_size = AesGcmHkdfStreamSegmentEncrypter::kTagSizeInBytes;
+  plaintext_buffer->resize(
+      ciphertext.size() > tag_size ? ciphertext.size() - tag_size : 0);
+  return DecryptSegmentInto(ciphertext, segment_number, is_last_segment,
+                            absl::MakeSpan(*plaintext_buffer));
+}
+
+util::Status AesGcmHkdfStreamSegmentDecrypter::DecryptSegmentInto(
+    absl::Span<const uint8_t> ciphertext,
+    int64_t segment_number,
+    bool is_last_segment,
+    absl::Span<uint8_t> plaintext) {
   if (!is_initialized_) {
     return util::Status(util::error::FAILED_PRECONDITION,
                         "decrypter not initialized");
@@ -175,9 +199,10 @@ util::Status AesGcmHkdfStreamSegmentDecrypter::DecryptSegment(
   if (ciphertext.size() < AesGcmHkdfStreamSegmentEncrypter::kTagSizeInBytes) {
     return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too short");
   }
-  if (plaintext_buffer == nullptr) {
+  if (plaintext.size() !=
+      ciphertext.size() - AesGcmHkdfStreamSegmentEncrypter::kTagSizeInBytes) {
     return util::Status(util::error::INVALID_ARGUMENT,
-                        "plaintext_buffer must be non-null");
+                        "plaintext has the wrong size");
   }
   if (segment_number > std::numeric_limits<uint32_t>::max() ||
       (segment_number == std::numeric_limits<uint32_t>::max() &&
@@ -185,10 +210,6 @@ util::Status AesGcmHkdfStreamSegmentDecrypter::DecryptSegment(
     return util::Status(util::error::INVALID_ARGUMENT, "too many segments");
   }
 
-  int pt_size =
-      ciphertext.size() - AesGcmHkdfStreamSegmentEncrypter::kTagSizeInBytes;
-  plaintext_buffer->resize(pt_size);
-
   // Construct IV.
   std::vector<uint8_t> iv(AesGcmHkdfStreamSegmentEncrypter::kNonceSizeInBytes);
   absl::c_copy(nonce_prefix_, iv.begin());
@@ -197,11 +218,11 @@ util::Status AesGcmHkdfStreamSegmentDecrypter::DecryptSegment(
       static_cast<uint32_t>(segment_number));
   iv.back() = is_last_segment ? 1 : 0;
 
-  // Decrypt.
+  // Decrypt; BoringSSL supports opening in place.
   size_t out_len;
   if (!EVP_AEAD_CTX_open(
-          ctx_.get(), plaintext_buffer->data(), &out_len,
-          plaintext_buffer->size(),
+          ctx_.get(), plaintext.data(), &out_len,
+          plaintext.size(),
           iv.data(), iv.size(),
           ciphertext.data(), ciphertext.size(),
           /* ad = */ nullptr, /* ad.length() = */ 0)) {
@@ -209,7 +230,7 @@ util::Status AesGcmHkdfStreamSegmentDecrypter::DecryptSegment(
                         absl::StrCat("Decryption failed: ",
                                      SubtleUtilBoringSSL::GetErrors()));
   }
-  if (out_len != plaintext_buffer->size()) {
+  if (out_len != plaintext.size()) {
     return util::Status(util::error::INTERNAL, "incorrect plaintext size");
   }
   return util::OkStatus();
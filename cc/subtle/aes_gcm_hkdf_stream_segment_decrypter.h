@@ -24,6 +24,7 @@
 
 #include "openssl/aead.h"
 #include "tink/subtle/common_enums.h"
+#include "absl/types/span.h"
 #include "tink/subtle/stream_segment_decrypter.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/statusor.h"
@@ -82,6 +83,11 @@ class AesGcmHkdfStreamSegmentDecrypter : public StreamSegmentDecrypter {
       bool is_last_segment,
       std::vector<uint8_t>* plaintext_buffer) override;
 
+  util::Status DecryptSegmentInto(absl::Span<const uint8_t> ciphertext,
+                                  int64_t segment_number,
+                                  bool is_last_segment,
+                                  absl::Span<uint8_t> plaintext) override;
+
   int get_header_size() const override {
     return header_size_;
   }
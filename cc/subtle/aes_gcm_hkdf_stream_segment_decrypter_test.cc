@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
 #include "tink/subtle/aes_gcm_hkdf_stream_segment_encrypter.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/hkdf.h"
@@ -146,6 +147,53 @@ TEST(AesGcmHkdfStreamSegmentDecrypterTest, testBasic) {
 }
 
 
+TEST(AesGcmHkdfStreamSegmentDecrypterTest, testInPlace) {
+  AesGcmHkdfStreamSegmentDecrypter::Params params;
+  params.ikm = Random::GetRandomKeyBytes(32);
+  params.hkdf_hash = SHA256;
+  params.derived_key_size = 32;
+  params.ciphertext_offset = 0;
+  params.ciphertext_segment_size = 256;
+  params.associated_data = "associated data";
+  auto result = AesGcmHkdfStreamSegmentDecrypter::New(params);
+  ASSERT_TRUE(result.ok()) << result.status();
+  auto dec = std::move(result.ValueOrDie());
+  auto enc = std::move(
+      GetEncrypter(params.ikm, params.hkdf_hash, params.derived_key_size,
+                   params.ciphertext_offset, params.ciphertext_segment_size,
+                   params.associated_data).ValueOrDie());
+  ASSERT_TRUE(dec->Init(enc->get_header()).ok());
+  const int tag_size = AesGcmHkdfStreamSegmentEncrypter::kTagSizeInBytes;
+
+  int segment_number = 0;
+  for (int pt_size : {0, 1, 10, dec->get_plaintext_segment_size()}) {
+    for (bool is_last_segment : {false, true}) {
+      SCOPED_TRACE(absl::StrCat("plaintext_size = ", pt_size,
+                                ", is_last_segment = ", is_last_segment));
+      std::vector<uint8_t> pt(pt_size, 'p');
+      std::vector<uint8_t> segment(pt);
+      segment.resize(pt_size + tag_size);
+      auto status = enc->EncryptSegmentInto(
+          absl::MakeConstSpan(segment.data(), pt_size), is_last_segment,
+          absl::MakeSpan(segment));
+      ASSERT_TRUE(status.ok()) << status;
+      std::vector<uint8_t> decrypted;
+      status = dec->DecryptSegment(segment, segment_number, is_last_segment,
+                                   &decrypted);
+      ASSERT_TRUE(status.ok()) << status;
+      EXPECT_EQ(pt, decrypted);
+
+      status = dec->DecryptSegmentInto(
+          absl::MakeConstSpan(segment), segment_number, is_last_segment,
+          absl::MakeSpan(segment.data(), pt_size));
+      ASSERT_TRUE(status.ok()) << status;
+      segment.resize(pt_size);
+      EXPECT_EQ(pt, segment);
+      segment_number++;
+    }
+  }
+}
+
 TEST(AesGcmHkdfStreamSegmentDecrypterTest, testWrongDerivedKeySize) {
   for (int derived_key_size : {12, 24, 64}) {
     for (HashType hkdf_hash : {SHA1, SHA256, SHA512}) {
@@ -25,6 +25,7 @@
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/aead.h"
 #include "tink/subtle/random.h"
 #include "tink/subtle/subtle_util_boringssl.h"
@@ -60,6 +61,12 @@ util::Status Validate(const AesGcmHkdfStreamSegmentEncrypter::Params& params) {
     return util::Status(util::error::INVALID_ARGUMENT,
                         "salt must have same size as the key");
   }
+  if (!params.nonce_prefix.empty() &&
+      params.nonce_prefix.size() !=
+          AesGcmHkdfStreamSegmentEncrypter::kNoncePrefixSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "nonce_prefix has the wrong size");
+  }
   if (params.ciphertext_offset < 0) {
     return util::Status(util::error::INVALID_ARGUMENT,
                         "ciphertext_offset must be non-negative");
@@ -113,7 +120,9 @@ int AesGcmHkdfStreamSegmentEncrypter::get_plaintext_segment_size() const {
 AesGcmHkdfStreamSegmentEncrypter::AesGcmHkdfStreamSegmentEncrypter(
     bssl::UniquePtr<EVP_AEAD_CTX> ctx, const Params& params)
     : ctx_(std::move(ctx)),
-      nonce_prefix_(Random::GetRandomBytes(kNoncePrefixSizeInBytes)),
+      nonce_prefix_(params.nonce_prefix.empty()
+                        ? Random::GetRandomBytes(kNoncePrefixSizeInBytes)
+                        : params.nonce_prefix),
       header_(CreateHeader(params.salt, nonce_prefix_)),
       ciphertext_segment_size_(params.ciphertext_segment_size),
       ciphertext_offset_(params.ciphertext_offset) {}
@@ -134,6 +143,18 @@ util::Status AesGcmHkdfStreamSegmentEncrypter::EncryptSegment(
     const std::vector<uint8_t>& plaintext,
     bool is_last_segment,
     std::vector<uint8_t>* ciphertext_buffer) {
+  util::Status status = EncryptSegmentAt(get_segment_number(), plaintext,
+                                         is_last_segment, ciphertext_buffer);
+  if (!status.ok()) return status;
+  IncSegmentNumber();
+  return util::OkStatus();
+}
+
+util::Status AesGcmHkdfStreamSegmentEncrypter::EncryptSegmentAt(
+    int64_t segment_number,
+    const std::vector<uint8_t>& plaintext,
+    bool is_last_segment,
+    std::vector<uint8_t>* ciphertext_buffer) const {
   if (plaintext.size() > get_plaintext_segment_size()) {
     return util::Status(util::error::INVALID_ARGUMENT, "plaintext too long");
   }
@@ -141,25 +162,50 @@ util::Status AesGcmHkdfStreamSegmentEncrypter::EncryptSegment(
     return util::Status(util::error::INVALID_ARGUMENT,
                         "ciphertext_buffer must be non-null");
   }
-  if (get_segment_number() > std::numeric_limits<uint32_t>::max() ||
-      (get_segment_number() == std::numeric_limits<uint32_t>::max() &&
+  ciphertext_buffer->resize(plaintext.size() + kTagSizeInBytes);
+  return Seal(segment_number, plaintext, is_last_segment,
+              absl::MakeSpan(*ciphertext_buffer));
+}
+
+util::Status AesGcmHkdfStreamSegmentEncrypter::EncryptSegmentInto(
+    absl::Span<const uint8_t> plaintext, bool is_last_segment,
+    absl::Span<uint8_t> ciphertext) {
+  if (ciphertext.size() != plaintext.size() + kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "ciphertext has the wrong size");
+  }
+  util::Status status = Seal(get_segment_number(), plaintext,
+                             is_last_segment, ciphertext);
+  if (!status.ok()) return status;
+  IncSegmentNumber();
+  return util::OkStatus();
+}
+
+util::Status AesGcmHkdfStreamSegmentEncrypter::Seal(
+    int64_t segment_number, absl::Span<const uint8_t> plaintext,
+    bool is_last_segment, absl::Span<uint8_t> ciphertext) const {
+  if (plaintext.size() > get_plaintext_segment_size()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "plaintext too long");
+  }
+  if (segment_number < 0 ||
+      segment_number > std::numeric_limits<uint32_t>::max() ||
+      (segment_number == std::numeric_limits<uint32_t>::max() &&
        !is_last_segment)) {
     return util::Status(util::error::INVALID_ARGUMENT, "too many segments");
   }
 
-  int ct_size = plaintext.size() + kTagSizeInBytes;
-  ciphertext_buffer->resize(ct_size);
-
   // Construct IV.
   std::vector<uint8_t> iv(kNonceSizeInBytes);
   memcpy(iv.data(), nonce_prefix_.data(), kNoncePrefixSizeInBytes);
   BigEndianStore32(iv.data() + kNoncePrefixSizeInBytes,
-                   static_cast<uint32_t>(get_segment_number()));
+                   static_cast<uint32_t>(segment_number));
   iv.back() = is_last_segment ? 1 : 0;
+  // BoringSSL supports sealing in place, with 'ciphertext' starting at the
+  // same address as 'plaintext'.
   size_t out_len;
   if (!EVP_AEAD_CTX_seal(
-          ctx_.get(), ciphertext_buffer->data(), &out_len,
-          ciphertext_buffer->size(),
+          ctx_.get(), ciphertext.data(), &out_len,
+          ciphertext.size(),
           iv.data(), iv.size(),
           plaintext.data(), plaintext.size(),
           /* ad = */ nullptr, /* ad.length() = */ 0)) {
@@ -167,11 +213,9 @@ util::Status AesGcmHkdfStreamSegmentEncrypter::EncryptSegment(
                         absl::StrCat("Encryption failed: ",
                                      SubtleUtilBoringSSL::GetErrors()));
   }
-  IncSegmentNumber();
   return util::OkStatus();
 }
 
-
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
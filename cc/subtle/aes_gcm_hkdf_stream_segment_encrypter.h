@@ -17,10 +17,12 @@
 #ifndef TINK_SUBTLE_AES_GCM_HKDF_STREAM_SEGMENT_ENCRYPTER_H_
 #define TINK_SUBTLE_AES_GCM_HKDF_STREAM_SEGMENT_ENCRYPTER_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "absl/types/span.h"
 #include "openssl/aead.h"
 #include "tink/subtle/stream_segment_encrypter.h"
 #include "tink/util/secret_data.h"
@@ -76,6 +78,9 @@ class AesGcmHkdfStreamSegmentEncrypter : public StreamSegmentEncrypter {
     std::string salt;
     int ciphertext_offset;
     int ciphertext_segment_size;
+    // The nonce prefix of the stream; chosen randomly if empty.  Only set
+    // to continue a stream whose header was produced by another encrypter.
+    std::string nonce_prefix;
   };
 
   // A factory.
@@ -88,6 +93,16 @@ class AesGcmHkdfStreamSegmentEncrypter : public StreamSegmentEncrypter {
       bool is_last_segment,
       std::vector<uint8_t>* ciphertext_buffer) override;
 
+  util::Status EncryptSegmentAt(
+      int64_t segment_number,
+      const std::vector<uint8_t>& plaintext,
+      bool is_last_segment,
+      std::vector<uint8_t>* ciphertext_buffer) const override;
+
+  util::Status EncryptSegmentInto(absl::Span<const uint8_t> plaintext,
+                                  bool is_last_segment,
+                                  absl::Span<uint8_t> ciphertext) override;
+
   const std::vector<uint8_t>& get_header() const override {
     return header_;
   }
@@ -111,6 +126,12 @@ class AesGcmHkdfStreamSegmentEncrypter : public StreamSegmentEncrypter {
   AesGcmHkdfStreamSegmentEncrypter(bssl::UniquePtr<EVP_AEAD_CTX> ctx,
                                    const Params& params);
 
+  // Encrypts 'plaintext' as the segment number 'segment_number' into
+  // 'ciphertext', which is kTagSizeInBytes longer.
+  util::Status Seal(int64_t segment_number,
+                    absl::Span<const uint8_t> plaintext, bool is_last_segment,
+                    absl::Span<uint8_t> ciphertext) const;
+
   bssl::UniquePtr<EVP_AEAD_CTX> ctx_;
   const std::string nonce_prefix_;
   const std::vector<uint8_t> header_;
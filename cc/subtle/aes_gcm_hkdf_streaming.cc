@@ -82,6 +82,27 @@ AesGcmHkdfStreaming::NewSegmentEncrypter(
   return AesGcmHkdfStreamSegmentEncrypter::New(std::move(params));
 }
 
+util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+AesGcmHkdfStreaming::NewSegmentEncrypterForHeader(
+    absl::string_view header, absl::string_view associated_data) const {
+  int header_size = 1 + derived_key_size_ +
+                    AesGcmHkdfStreamSegmentEncrypter::kNoncePrefixSizeInBytes;
+  if (header.size() != static_cast<size_t>(header_size) ||
+      static_cast<uint8_t>(header[0]) != header_size) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid header");
+  }
+  AesGcmHkdfStreamSegmentEncrypter::Params params;
+  params.salt = std::string(header.substr(1, derived_key_size_));
+  params.nonce_prefix = std::string(header.substr(1 + derived_key_size_));
+  auto hkdf_result = Hkdf::ComputeHkdf(hkdf_hash_, ikm_, params.salt,
+                                       associated_data, derived_key_size_);
+  if (!hkdf_result.ok()) return hkdf_result.status();
+  params.key = std::move(hkdf_result).ValueOrDie();
+  params.ciphertext_offset = ciphertext_offset_;
+  params.ciphertext_segment_size = ciphertext_segment_size_;
+  return AesGcmHkdfStreamSegmentEncrypter::New(std::move(params));
+}
+
 util::StatusOr<std::unique_ptr<StreamSegmentDecrypter>>
 AesGcmHkdfStreaming::NewSegmentDecrypter(
     absl::string_view associated_data) const {
@@ -50,6 +50,11 @@ class AesGcmHkdfStreaming : public NonceBasedStreamingAead {
   util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>> NewSegmentEncrypter(
       absl::string_view associated_data) const override;
 
+  util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+  NewSegmentEncrypterForHeader(
+      absl::string_view header,
+      absl::string_view associated_data) const override;
+
   util::StatusOr<std::unique_ptr<StreamSegmentDecrypter>> NewSegmentDecrypter(
       absl::string_view associated_data) const override;
 
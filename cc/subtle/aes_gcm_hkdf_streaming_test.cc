@@ -18,10 +18,13 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/output_stream.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/random.h"
@@ -209,6 +212,179 @@ TEST(AesGcmHkdfStreamingTest, testWrongCiphertextSegmentSize) {
 }
 
 
+TEST(AesGcmHkdfStreamingTest, testParallelEncryption) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  for (int ct_segment_size : {80, 4096}) {
+    for (int parallelism : {2, 4}) {
+      SCOPED_TRACE(absl::StrCat("ciphertext_segment_size = ", ct_segment_size,
+                                ", parallelism = ", parallelism));
+      AesGcmHkdfStreaming::Params params;
+      params.ikm = Random::GetRandomKeyBytes(16);
+      params.hkdf_hash = SHA256;
+      params.derived_key_size = 16;
+      params.ciphertext_segment_size = ct_segment_size;
+      params.ciphertext_offset = 0;
+      auto result = AesGcmHkdfStreaming::New(std::move(params));
+      ASSERT_THAT(result.status(), IsOk());
+      auto streaming_aead = std::move(result.ValueOrDie());
+      std::string associated_data = "some associated data";
+
+      for (int pt_size : {0, 100, 100000}) {
+        SCOPED_TRACE(absl::StrCat(" pt_size = ", pt_size));
+        std::string pt = Random::GetRandomBytes(pt_size);
+
+        // Encrypt with a parallel stream.
+        auto ct_stream = absl::make_unique<std::stringstream>();
+        auto ct_buf = ct_stream->rdbuf();
+        auto enc_stream_result = streaming_aead->NewParallelEncryptingStream(
+            absl::make_unique<util::OstreamOutputStream>(std::move(ct_stream)),
+            associated_data, parallelism);
+        ASSERT_THAT(enc_stream_result.status(), IsOk());
+        auto enc_stream = std::move(enc_stream_result.ValueOrDie());
+        ASSERT_THAT(test::WriteToStream(enc_stream.get(), pt), IsOk());
+
+        // Decrypt with a regular decrypting stream.
+        auto dec_stream_result = streaming_aead->NewDecryptingStream(
+            absl::make_unique<util::IstreamInputStream>(
+                absl::make_unique<std::stringstream>(ct_buf->str())),
+            associated_data);
+        ASSERT_THAT(dec_stream_result.status(), IsOk());
+        std::string decrypted;
+        EXPECT_THAT(test::ReadFromStream(dec_stream_result.ValueOrDie().get(),
+                                         &decrypted),
+                    IsOk());
+        EXPECT_EQ(pt, decrypted);
+      }
+    }
+  }
+}
+
+TEST(AesGcmHkdfStreamingTest, testSizeHint) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  AesGcmHkdfStreaming::Params params;
+  params.ikm = Random::GetRandomKeyBytes(16);
+  params.hkdf_hash = SHA256;
+  params.derived_key_size = 16;
+  params.ciphertext_segment_size = 1 << 20;
+  params.ciphertext_offset = 0;
+  auto result = AesGcmHkdfStreaming::New(std::move(params));
+  ASSERT_THAT(result.status(), IsOk());
+  auto streaming_aead = std::move(result.ValueOrDie());
+  std::string associated_data = "some associated data";
+
+  for (int pt_size : {0, 200, 5000, 3000000}) {
+    SCOPED_TRACE(absl::StrCat("pt_size = ", pt_size));
+    std::string pt = Random::GetRandomBytes(pt_size);
+
+    // Encrypt with a size hint.
+    auto ct_stream = absl::make_unique<std::stringstream>();
+    auto ct_buf = ct_stream->rdbuf();
+    auto enc_stream_result = streaming_aead->NewEncryptingStreamWithSizeHint(
+        absl::make_unique<util::OstreamOutputStream>(std::move(ct_stream)),
+        associated_data, pt_size);
+    ASSERT_THAT(enc_stream_result.status(), IsOk());
+    auto enc_stream = std::move(enc_stream_result.ValueOrDie());
+    ASSERT_THAT(test::WriteToStream(enc_stream.get(), pt), IsOk());
+    std::string ct = ct_buf->str();
+
+    // Decrypt with and without a size hint.
+    for (bool with_hint : {false, true}) {
+      auto ct_source = absl::make_unique<util::IstreamInputStream>(
+          absl::make_unique<std::stringstream>(ct));
+      auto dec_stream_result =
+          with_hint ? streaming_aead->NewDecryptingStreamWithSizeHint(
+                          std::move(ct_source), associated_data, ct.size())
+                    : streaming_aead->NewDecryptingStream(
+                          std::move(ct_source), associated_data);
+      ASSERT_THAT(dec_stream_result.status(), IsOk());
+      std::string decrypted;
+      EXPECT_THAT(test::ReadFromStream(dec_stream_result.ValueOrDie().get(),
+                                       &decrypted),
+                  IsOk());
+      EXPECT_EQ(pt, decrypted);
+    }
+  }
+}
+
+TEST(AesGcmHkdfStreamingTest, testRandomAccessEncryption) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  AesGcmHkdfStreaming::Params params;
+  params.ikm = Random::GetRandomKeyBytes(16);
+  params.hkdf_hash = SHA256;
+  params.derived_key_size = 16;
+  params.ciphertext_segment_size = 256;
+  params.ciphertext_offset = 0;
+  auto result = AesGcmHkdfStreaming::New(std::move(params));
+  ASSERT_THAT(result.status(), IsOk());
+  auto streaming_aead = std::move(result.ValueOrDie());
+  std::string associated_data = "some associated data";
+
+  for (int pt_size : {0, 100, 100000}) {
+    SCOPED_TRACE(absl::StrCat(" pt_size = ", pt_size));
+    std::string pt = Random::GetRandomBytes(pt_size);
+
+    // Encrypt the segments backwards, alternating between two encrypters
+    // for the same stream.
+    auto first_result =
+        streaming_aead->NewRandomAccessEncrypter(associated_data);
+    ASSERT_THAT(first_result.status(), IsOk());
+    auto first = std::move(first_result.ValueOrDie());
+    std::string header(first->header().begin(), first->header().end());
+    auto second_result = streaming_aead->NewRandomAccessEncrypterForHeader(
+        header, associated_data);
+    ASSERT_THAT(second_result.status(), IsOk());
+    auto second = std::move(second_result.ValueOrDie());
+    int64_t segment_count = 1;
+    while (first->plaintext_position(segment_count) < pt_size) {
+      segment_count++;
+    }
+    std::vector<std::string> ct_segments(segment_count);
+    for (int64_t i = segment_count - 1; i >= 0; i--) {
+      auto* encrypter = i % 2 == 0 ? first.get() : second.get();
+      absl::string_view pt_segment = absl::string_view(pt).substr(
+          encrypter->plaintext_position(i),
+          encrypter->plaintext_segment_size(i));
+      std::vector<uint8_t> ct_segment;
+      ASSERT_THAT(
+          encrypter->EncryptSegmentAt(
+              i,
+              absl::MakeConstSpan(
+                  reinterpret_cast<const uint8_t*>(pt_segment.data()),
+                  pt_segment.size()),
+              i == segment_count - 1, &ct_segment),
+          IsOk());
+      ct_segments[i] = std::string(ct_segment.begin(), ct_segment.end());
+    }
+    std::string ct = header;
+    for (const auto& ct_segment : ct_segments) ct.append(ct_segment);
+
+    // Decrypt with a regular decrypting stream.
+    auto dec_stream_result = streaming_aead->NewDecryptingStream(
+        absl::make_unique<util::IstreamInputStream>(
+            absl::make_unique<std::stringstream>(ct)),
+        associated_data);
+    ASSERT_THAT(dec_stream_result.status(), IsOk());
+    std::string decrypted;
+    EXPECT_THAT(test::ReadFromStream(dec_stream_result.ValueOrDie().get(),
+                                     &decrypted),
+                IsOk());
+    EXPECT_EQ(pt, decrypted);
+  }
+
+  // A header of another size is rejected.
+  EXPECT_THAT(streaming_aead
+                  ->NewRandomAccessEncrypterForHeader(std::string(10, '\x0a'),
+                                                      associated_data)
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 // FIPS only mode tests
 TEST(AesGcmHkdfStreamingTest, TestFipsOnly) {
   if (!kUseOnlyFips) {
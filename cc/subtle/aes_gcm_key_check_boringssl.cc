@@ -0,0 +1,187 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_gcm_key_check_boringssl.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "openssl/aead.h"
+#include "openssl/crypto.h"
+#include "openssl/mem.h"
+#include "openssl/sha.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/hkdf.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+constexpr int kCheckKeySizeInBytes = 32;
+constexpr char kEncryptionKeyInfo[] = "AesGcmKeyCheck encryption key";
+constexpr char kCheckKeyInfo[] = "AesGcmKeyCheck check key";
+
+}  // namespace
+
+constexpr int AesGcmKeyCheckBoringSsl::kIvSizeInBytes;
+constexpr int AesGcmKeyCheckBoringSsl::kKeyCheckSizeInBytes;
+constexpr int AesGcmKeyCheckBoringSsl::kTagSizeInBytes;
+constexpr int AesGcmKeyCheckBoringSsl::kHeaderSizeInBytes;
+
+util::StatusOr<std::unique_ptr<Aead>> AesGcmKeyCheckBoringSsl::New(
+    const util::SecretData& key) {
+  auto status = CheckFipsCompatibility<AesGcmKeyCheckBoringSsl>();
+  if (!status.ok()) return status;
+
+  const EVP_AEAD* aead =
+      SubtleUtilBoringSSL::GetAesGcmAeadForKeySize(key.size());
+  if (aead == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
+  }
+  auto encryption_key_or = Hkdf::ComputeHkdf(
+      HashType::SHA256, key, /*salt=*/"", kEncryptionKeyInfo, key.size());
+  if (!encryption_key_or.ok()) return encryption_key_or.status();
+  auto check_key_or = Hkdf::ComputeHkdf(HashType::SHA256, key, /*salt=*/"",
+                                        kCheckKeyInfo, kCheckKeySizeInBytes);
+  if (!check_key_or.ok()) return check_key_or.status();
+
+  const util::SecretData& encryption_key = encryption_key_or.ValueOrDie();
+  bssl::UniquePtr<EVP_AEAD_CTX> ctx(
+      EVP_AEAD_CTX_new(aead, encryption_key.data(), encryption_key.size(),
+                       EVP_AEAD_DEFAULT_TAG_LENGTH));
+  if (!ctx) {
+    return util::Status(util::error::INTERNAL,
+                        "could not initialize EVP_AEAD_CTX");
+  }
+  return {absl::WrapUnique(new AesGcmKeyCheckBoringSsl(
+      std::move(ctx), std::move(check_key_or.ValueOrDie())))};
+}
+
+void AesGcmKeyCheckBoringSsl::ComputeKeyCheck(const uint8_t* iv,
+                                              uint8_t* check) const {
+  // 44 bytes, i.e. a single SHA-256 block.
+  uint8_t input[kCheckKeySizeInBytes + kIvSizeInBytes];
+  std::copy_n(check_key_.data(), kCheckKeySizeInBytes, input);
+  std::copy_n(iv, kIvSizeInBytes, input + kCheckKeySizeInBytes);
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+  ::SHA256(input, sizeof(input), digest);
+  std::copy_n(digest, kKeyCheckSizeInBytes, check);
+  OPENSSL_cleanse(input, sizeof(input));
+}
+
+util::StatusOr<std::string> AesGcmKeyCheckBoringSsl::Encrypt(
+    absl::string_view plaintext, absl::string_view additional_data) const {
+  std::string result;
+  ResizeStringUninitialized(
+      &result, kHeaderSizeInBytes + plaintext.size() + kTagSizeInBytes);
+  auto written_or = EncryptInto(plaintext, additional_data,
+                                absl::MakeSpan(&result[0], result.size()));
+  if (!written_or.ok()) return written_or.status();
+  return result;
+}
+
+util::StatusOr<std::string> AesGcmKeyCheckBoringSsl::Decrypt(
+    absl::string_view ciphertext, absl::string_view additional_data) const {
+  if (ciphertext.size() < kHeaderSizeInBytes + kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+
+  std::string result;
+  ResizeStringUninitialized(
+      &result, ciphertext.size() - kHeaderSizeInBytes - kTagSizeInBytes);
+  auto written_or = DecryptInto(ciphertext, additional_data,
+                                absl::MakeSpan(&result[0], result.size()));
+  if (!written_or.ok()) return written_or.status();
+  return result;
+}
+
+util::StatusOr<int64_t> AesGcmKeyCheckBoringSsl::CiphertextSize(
+    int64_t plaintext_size) const {
+  if (plaintext_size < 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Plaintext size must be non-negative");
+  }
+  return kHeaderSizeInBytes + plaintext_size + kTagSizeInBytes;
+}
+
+util::StatusOr<int64_t> AesGcmKeyCheckBoringSsl::EncryptInto(
+    absl::string_view plaintext, absl::string_view additional_data,
+    absl::Span<char> ciphertext_buffer) const {
+  const size_t ciphertext_size =
+      kHeaderSizeInBytes + plaintext.size() + kTagSizeInBytes;
+  if (ciphertext_buffer.size() < ciphertext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Ciphertext buffer too small");
+  }
+  uint8_t* iv = reinterpret_cast<uint8_t*>(ciphertext_buffer.data());
+  auto status = Random::GetRandomBytes(absl::MakeSpan(iv, kIvSizeInBytes));
+  if (!status.ok()) return status;
+  ComputeKeyCheck(iv, iv + kIvSizeInBytes);
+  size_t len;
+  if (EVP_AEAD_CTX_seal(
+          ctx_.get(), iv + kHeaderSizeInBytes, &len,
+          plaintext.size() + kTagSizeInBytes, iv, kIvSizeInBytes,
+          reinterpret_cast<const uint8_t*>(plaintext.data()), plaintext.size(),
+          reinterpret_cast<const uint8_t*>(additional_data.data()),
+          additional_data.size()) != 1) {
+    return util::Status(util::error::INTERNAL, "Encryption failed");
+  }
+  return ciphertext_size;
+}
+
+util::StatusOr<int64_t> AesGcmKeyCheckBoringSsl::DecryptInto(
+    absl::string_view ciphertext, absl::string_view additional_data,
+    absl::Span<char> plaintext_buffer) const {
+  if (ciphertext.size() < kHeaderSizeInBytes + kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  const size_t plaintext_size =
+      ciphertext.size() - kHeaderSizeInBytes - kTagSizeInBytes;
+  if (plaintext_buffer.size() < plaintext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Plaintext buffer too small");
+  }
+  const uint8_t* iv = reinterpret_cast<const uint8_t*>(ciphertext.data());
+  uint8_t check[kKeyCheckSizeInBytes];
+  ComputeKeyCheck(iv, check);
+  if (CRYPTO_memcmp(check, iv + kIvSizeInBytes, kKeyCheckSizeInBytes) != 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Key check failed: wrong key");
+  }
+  size_t len;
+  if (EVP_AEAD_CTX_open(
+          ctx_.get(), reinterpret_cast<uint8_t*>(plaintext_buffer.data()), &len,
+          plaintext_size, iv, kIvSizeInBytes, iv + kHeaderSizeInBytes,
+          ciphertext.size() - kHeaderSizeInBytes,
+          reinterpret_cast<const uint8_t*>(additional_data.data()),
+          additional_data.size()) != 1) {
+    return util::Status(util::error::INTERNAL, "Authentication failed");
+  }
+  return len;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
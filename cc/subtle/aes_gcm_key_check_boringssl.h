@@ -0,0 +1,109 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_AES_GCM_KEY_CHECK_BORINGSSL_H_
+#define TINK_SUBTLE_AES_GCM_KEY_CHECK_BORINGSSL_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/aead.h"
+#include "tink/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// AES-GCM whose ciphertexts carry a key check value, so that decryption
+// with a wrong key fails after hashing a single block, rather than after
+// decrypting and authenticating the whole ciphertext.  This matters where
+// the keyset wrapper tries several keys on one ciphertext, e.g. for RAW
+// keys or colliding prefixes: each wrong key costs as much as a short
+// message.
+//
+// Two keys are derived from the key with HKDF-SHA256: an AES-GCM key of
+// the same size, and a 32 byte check key.  The ciphertext format is
+//
+//   iv (12 bytes) || check (16 bytes) || AES-GCM ciphertext || tag (16 bytes)
+//
+// where check = SHA-256(check key || iv) truncated to 16 bytes.  As the
+// check value is a collision resistant function of the key, it also
+// commits the ciphertext to the key (with 64-bit security), i.e. no
+// ciphertext decrypts under two different keys.
+//
+// Thread safety: This class is thread safe and thus can be used
+// concurrently.
+class AesGcmKeyCheckBoringSsl : public Aead {
+ public:
+  static constexpr int kIvSizeInBytes = 12;
+  static constexpr int kKeyCheckSizeInBytes = 16;
+  static constexpr int kTagSizeInBytes = 16;
+
+  static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
+      const util::SecretData& key);
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view additional_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view additional_data) const override;
+
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override;
+
+  crypto::tink::util::StatusOr<int64_t> EncryptInto(
+      absl::string_view plaintext, absl::string_view additional_data,
+      absl::Span<char> ciphertext_buffer) const override;
+
+  // Fails with INVALID_ARGUMENT before decrypting if the key check value of
+  // 'ciphertext' does not match the key.
+  crypto::tink::util::StatusOr<int64_t> DecryptInto(
+      absl::string_view ciphertext, absl::string_view additional_data,
+      absl::Span<char> plaintext_buffer) const override;
+
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kNotFips;
+
+ private:
+  static constexpr int kHeaderSizeInBytes =
+      kIvSizeInBytes + kKeyCheckSizeInBytes;
+
+  AesGcmKeyCheckBoringSsl(bssl::UniquePtr<EVP_AEAD_CTX> ctx,
+                          util::SecretData check_key)
+      : ctx_(std::move(ctx)), check_key_(std::move(check_key)) {}
+
+  // Writes the key check value of 'iv' to 'check'.
+  void ComputeKeyCheck(const uint8_t* iv, uint8_t* check) const;
+
+  const bssl::UniquePtr<EVP_AEAD_CTX> ctx_;
+  const util::SecretData check_key_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_AES_GCM_KEY_CHECK_BORINGSSL_H_
@@ -0,0 +1,161 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_gcm_key_check_boringssl.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+using ::testing::HasSubstr;
+using ::testing::Ne;
+
+constexpr int kOverhead = AesGcmKeyCheckBoringSsl::kIvSizeInBytes +
+                          AesGcmKeyCheckBoringSsl::kKeyCheckSizeInBytes +
+                          AesGcmKeyCheckBoringSsl::kTagSizeInBytes;
+
+class AesGcmKeyCheckBoringSslTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (kUseOnlyFips) {
+      GTEST_SKIP() << "Not supported in FIPS-only mode";
+    }
+  }
+};
+
+TEST_F(AesGcmKeyCheckBoringSslTest, EncryptDecrypt) {
+  for (int key_size : {16, 32}) {
+    auto aead_or = AesGcmKeyCheckBoringSsl::New(
+        Random::GetRandomKeyBytes(key_size));
+    ASSERT_THAT(aead_or.status(), IsOk());
+    const Aead& aead = *aead_or.ValueOrDie();
+    for (int size : {0, 1, 16, 17, 1000}) {
+      std::string message = Random::GetRandomBytes(size);
+      auto ct = aead.Encrypt(message, "aad");
+      ASSERT_THAT(ct.status(), IsOk());
+      EXPECT_THAT(ct.ValueOrDie().size(), Eq(size + kOverhead));
+      EXPECT_THAT(aead.CiphertextSize(size).ValueOrDie(),
+                  Eq(size + kOverhead));
+      auto pt = aead.Decrypt(ct.ValueOrDie(), "aad");
+      ASSERT_THAT(pt.status(), IsOk());
+      EXPECT_THAT(pt.ValueOrDie(), Eq(message));
+      EXPECT_THAT(aead.Decrypt(ct.ValueOrDie(), "other aad").status(),
+                  StatusIs(util::error::INTERNAL));
+    }
+  }
+}
+
+TEST_F(AesGcmKeyCheckBoringSslTest, InvalidKeySize) {
+  for (int key_size : {0, 15, 24, 31, 33}) {
+    EXPECT_THAT(
+        AesGcmKeyCheckBoringSsl::New(Random::GetRandomKeyBytes(key_size))
+            .status(),
+        StatusIs(util::error::INVALID_ARGUMENT))
+        << key_size;
+  }
+}
+
+TEST_F(AesGcmKeyCheckBoringSslTest, WrongKeyFailsKeyCheck) {
+  auto aead = std::move(
+      AesGcmKeyCheckBoringSsl::New(Random::GetRandomKeyBytes(16))
+          .ValueOrDie());
+  auto other_aead = std::move(
+      AesGcmKeyCheckBoringSsl::New(Random::GetRandomKeyBytes(16))
+          .ValueOrDie());
+  std::string ct = aead->Encrypt("message", "aad").ValueOrDie();
+  auto result = other_aead->Decrypt(ct, "aad");
+  EXPECT_THAT(result.status(), StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(result.status().error_message(), HasSubstr("Key check"));
+}
+
+TEST_F(AesGcmKeyCheckBoringSslTest, ModifiedCiphertext) {
+  auto aead = std::move(
+      AesGcmKeyCheckBoringSsl::New(Random::GetRandomKeyBytes(32))
+          .ValueOrDie());
+  std::string ct = aead->Encrypt("message", "aad").ValueOrDie();
+  for (size_t i = 0; i < ct.size(); i++) {
+    std::string modified = ct;
+    modified[i] ^= 1;
+    EXPECT_FALSE(aead->Decrypt(modified, "aad").ok()) << i;
+  }
+  for (size_t size = 0; size < kOverhead; size++) {
+    EXPECT_THAT(aead->Decrypt(ct.substr(0, size), "aad").status(),
+                StatusIs(util::error::INVALID_ARGUMENT));
+  }
+}
+
+TEST_F(AesGcmKeyCheckBoringSslTest, DistinctKeyChecksPerMessage) {
+  auto aead = std::move(
+      AesGcmKeyCheckBoringSsl::New(Random::GetRandomKeyBytes(16))
+          .ValueOrDie());
+  std::string first = aead->Encrypt("message", "").ValueOrDie();
+  std::string second = aead->Encrypt("message", "").ValueOrDie();
+  EXPECT_THAT(first.substr(12, 16), Ne(second.substr(12, 16)));
+}
+
+TEST_F(AesGcmKeyCheckBoringSslTest, EncryptIntoDecryptInto) {
+  auto aead = std::move(
+      AesGcmKeyCheckBoringSsl::New(Random::GetRandomKeyBytes(16))
+          .ValueOrDie());
+  std::string message = "some message";
+  std::vector<char> ct(message.size() + kOverhead);
+  auto written = aead->EncryptInto(message, "aad", absl::MakeSpan(ct));
+  ASSERT_THAT(written.status(), IsOk());
+  EXPECT_THAT(written.ValueOrDie(), Eq(ct.size()));
+  std::vector<char> pt(ct.size());
+  auto read = aead->DecryptInto(absl::string_view(ct.data(), ct.size()), "aad",
+                                absl::MakeSpan(pt));
+  ASSERT_THAT(read.status(), IsOk());
+  EXPECT_THAT(std::string(pt.data(), read.ValueOrDie()), Eq(message));
+
+  std::vector<char> short_buffer(ct.size() - 1);
+  EXPECT_THAT(
+      aead->EncryptInto(message, "aad", absl::MakeSpan(short_buffer)).status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(AesGcmKeyCheckBoringSslFipsTest, FipsOnly) {
+  if (!kUseOnlyFips) {
+    GTEST_SKIP() << "Only supported in FIPS-only mode";
+  }
+  EXPECT_THAT(
+      AesGcmKeyCheckBoringSsl::New(Random::GetRandomKeyBytes(16)).status(),
+      StatusIs(util::error::INTERNAL));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,126 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_gcm_page_boringssl.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "absl/base/internal/endian.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+constexpr int kPageNumberSize = 8;
+
+// The associated data of a page: its number followed by the associated
+// data of the caller.  Short associated data, e.g. a file id, stays on the
+// stack.
+using PageAssociatedData = absl::InlinedVector<uint8_t, 64>;
+
+PageAssociatedData MakeAssociatedData(uint64_t page_number,
+                                      absl::string_view associated_data) {
+  PageAssociatedData result(kPageNumberSize + associated_data.size());
+  absl::big_endian::Store64(result.data(), page_number);
+  std::copy(associated_data.begin(), associated_data.end(),
+            result.begin() + kPageNumberSize);
+  return result;
+}
+
+}  // namespace
+
+constexpr int AesGcmPageBoringSsl::kNonceSizeInBytes;
+constexpr int AesGcmPageBoringSsl::kTagSizeInBytes;
+
+util::StatusOr<std::unique_ptr<PageAead>> AesGcmPageBoringSsl::New(
+    const util::SecretData& key) {
+  auto status = CheckFipsCompatibility<AesGcmPageBoringSsl>();
+  if (!status.ok()) return status;
+
+  const EVP_AEAD* aead =
+      SubtleUtilBoringSSL::GetAesGcmAeadForKeySize(key.size());
+  if (aead == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
+  }
+  bssl::UniquePtr<EVP_AEAD_CTX> ctx(EVP_AEAD_CTX_new(
+      aead, key.data(), key.size(), EVP_AEAD_DEFAULT_TAG_LENGTH));
+  if (!ctx) {
+    return util::Status(util::error::INTERNAL,
+                        "could not initialize EVP_AEAD_CTX");
+  }
+  return {absl::WrapUnique(new AesGcmPageBoringSsl(std::move(ctx)))};
+}
+
+util::Status AesGcmPageBoringSsl::EncryptPage(
+    uint64_t page_number, absl::string_view associated_data,
+    absl::Span<char> page) const {
+  if (page.size() < overhead()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Page too small");
+  }
+  const size_t data_size = page.size() - overhead();
+  uint8_t* data = reinterpret_cast<uint8_t*>(page.data());
+  uint8_t* nonce = data + data_size + kTagSizeInBytes;
+  auto status =
+      Random::GetRandomBytes(absl::MakeSpan(nonce, kNonceSizeInBytes));
+  if (!status.ok()) return status;
+  PageAssociatedData ad = MakeAssociatedData(page_number, associated_data);
+  size_t len;
+  // Seals in place: the ciphertext replaces the data, and the tag is
+  // written right behind it, in front of the nonce.
+  if (EVP_AEAD_CTX_seal(ctx_.get(), data, &len, data_size + kTagSizeInBytes,
+                        nonce, kNonceSizeInBytes, data, data_size, ad.data(),
+                        ad.size()) != 1) {
+    return util::Status(util::error::INTERNAL, "Encryption failed");
+  }
+  return util::OkStatus();
+}
+
+util::Status AesGcmPageBoringSsl::DecryptPage(
+    uint64_t page_number, absl::string_view associated_data,
+    absl::Span<char> page) const {
+  if (page.size() < overhead()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Page too small");
+  }
+  const size_t data_size = page.size() - overhead();
+  uint8_t* data = reinterpret_cast<uint8_t*>(page.data());
+  const uint8_t* nonce = data + data_size + kTagSizeInBytes;
+  PageAssociatedData ad = MakeAssociatedData(page_number, associated_data);
+  size_t len;
+  if (EVP_AEAD_CTX_open(ctx_.get(), data, &len, data_size, nonce,
+                        kNonceSizeInBytes, data, data_size + kTagSizeInBytes,
+                        ad.data(), ad.size()) != 1) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Authentication failed");
+  }
+  return util::OkStatus();
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,80 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_AES_GCM_PAGE_BORINGSSL_H_
+#define TINK_SUBTLE_AES_GCM_PAGE_BORINGSSL_H_
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/page_aead.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// AES-GCM encryption of the pages of a block store, in place.  A page is
+//
+//   data || tag (16 bytes) || nonce (12 bytes)
+//
+// where the data is encrypted in place with a random nonce, and the
+// associated data is the page number as 8 bytes in big endian followed by
+// the associated data of the caller.  As with AesGcmBoringSsl, a key must
+// not encrypt more than 2^32 pages, counting rewrites of the same page.
+//
+// Thread safety: This class is thread safe and thus can be used
+// concurrently.
+class AesGcmPageBoringSsl : public PageAead {
+ public:
+  static constexpr int kNonceSizeInBytes = 12;
+  static constexpr int kTagSizeInBytes = 16;
+
+  static crypto::tink::util::StatusOr<std::unique_ptr<PageAead>> New(
+      const util::SecretData& key);
+
+  int overhead() const override { return kTagSizeInBytes + kNonceSizeInBytes; }
+
+  crypto::tink::util::Status EncryptPage(
+      uint64_t page_number, absl::string_view associated_data,
+      absl::Span<char> page) const override;
+
+  crypto::tink::util::Status DecryptPage(
+      uint64_t page_number, absl::string_view associated_data,
+      absl::Span<char> page) const override;
+
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kNotFips;
+
+ private:
+  explicit AesGcmPageBoringSsl(bssl::UniquePtr<EVP_AEAD_CTX> ctx)
+      : ctx_(std::move(ctx)) {}
+
+  const bssl::UniquePtr<EVP_AEAD_CTX> ctx_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_AES_GCM_PAGE_BORINGSSL_H_
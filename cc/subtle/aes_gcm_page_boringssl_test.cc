@@ -0,0 +1,174 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_gcm_page_boringssl.h"
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/types/span.h"
+#include "tink/config/tink_fips.h"
+#include "tink/page_aead.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+
+constexpr int kPageSize = 4096;
+
+class AesGcmPageBoringSslTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (kUseOnlyFips) {
+      GTEST_SKIP() << "Not supported in FIPS-only mode";
+    }
+  }
+};
+
+std::string NewPage(int size) {
+  return Random::GetRandomBytes(size);
+}
+
+TEST_F(AesGcmPageBoringSslTest, EncryptDecryptInPlace) {
+  for (int key_size : {16, 32}) {
+    auto page_aead_or =
+        AesGcmPageBoringSsl::New(Random::GetRandomKeyBytes(key_size));
+    ASSERT_THAT(page_aead_or.status(), IsOk());
+    const PageAead& page_aead = *page_aead_or.ValueOrDie();
+    EXPECT_EQ(page_aead.overhead(), 28);
+
+    std::string page = NewPage(kPageSize);
+    std::string data = page.substr(0, kPageSize - page_aead.overhead());
+    ASSERT_THAT(page_aead.EncryptPage(7, "file", absl::MakeSpan(&page[0],
+                                                               page.size())),
+                IsOk());
+    EXPECT_EQ(page.size(), kPageSize);
+    EXPECT_NE(page.substr(0, data.size()), data);
+    ASSERT_THAT(page_aead.DecryptPage(7, "file", absl::MakeSpan(&page[0],
+                                                               page.size())),
+                IsOk());
+    EXPECT_EQ(page.substr(0, data.size()), data);
+  }
+}
+
+TEST_F(AesGcmPageBoringSslTest, PageNumberAndAssociatedDataAreBound) {
+  auto page_aead_or = AesGcmPageBoringSsl::New(Random::GetRandomKeyBytes(32));
+  ASSERT_THAT(page_aead_or.status(), IsOk());
+  const PageAead& page_aead = *page_aead_or.ValueOrDie();
+  std::string encrypted = NewPage(kPageSize);
+  ASSERT_THAT(page_aead.EncryptPage(
+                  7, "file", absl::MakeSpan(&encrypted[0], encrypted.size())),
+              IsOk());
+
+  std::string page = encrypted;
+  EXPECT_THAT(
+      page_aead.DecryptPage(8, "file", absl::MakeSpan(&page[0], page.size())),
+      StatusIs(util::error::INVALID_ARGUMENT));
+  page = encrypted;
+  EXPECT_THAT(page_aead.DecryptPage(7, "other file",
+                                    absl::MakeSpan(&page[0], page.size())),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  for (int i : {0, kPageSize - 28, kPageSize - 1}) {
+    page = encrypted;
+    page[i] ^= 1;
+    EXPECT_THAT(page_aead.DecryptPage(7, "file",
+                                      absl::MakeSpan(&page[0], page.size())),
+                StatusIs(util::error::INVALID_ARGUMENT))
+        << i;
+  }
+}
+
+TEST_F(AesGcmPageBoringSslTest, RewriteUsesFreshNonce) {
+  auto page_aead_or = AesGcmPageBoringSsl::New(Random::GetRandomKeyBytes(16));
+  ASSERT_THAT(page_aead_or.status(), IsOk());
+  const PageAead& page_aead = *page_aead_or.ValueOrDie();
+  std::string page1(kPageSize, 'x');
+  std::string page2(kPageSize, 'x');
+  ASSERT_THAT(
+      page_aead.EncryptPage(1, "", absl::MakeSpan(&page1[0], page1.size())),
+      IsOk());
+  ASSERT_THAT(
+      page_aead.EncryptPage(1, "", absl::MakeSpan(&page2[0], page2.size())),
+      IsOk());
+  EXPECT_NE(page1, page2);
+}
+
+TEST_F(AesGcmPageBoringSslTest, Batch) {
+  auto page_aead_or = AesGcmPageBoringSsl::New(Random::GetRandomKeyBytes(16));
+  ASSERT_THAT(page_aead_or.status(), IsOk());
+  const PageAead& page_aead = *page_aead_or.ValueOrDie();
+  constexpr int kPageCount = 8;
+  std::string pages = NewPage(kPageCount * kPageSize);
+  const std::string original = pages;
+  ASSERT_THAT(page_aead.EncryptPages(
+                  100, "file", kPageSize,
+                  absl::MakeSpan(&pages[0], pages.size())),
+              IsOk());
+  // Each page can be decrypted on its own.
+  std::string third = pages.substr(2 * kPageSize, kPageSize);
+  ASSERT_THAT(page_aead.DecryptPage(102, "file",
+                                    absl::MakeSpan(&third[0], third.size())),
+              IsOk());
+  EXPECT_EQ(third.substr(0, kPageSize - 28),
+            original.substr(2 * kPageSize, kPageSize - 28));
+
+  ASSERT_THAT(page_aead.DecryptPages(
+                  100, "file", kPageSize,
+                  absl::MakeSpan(&pages[0], pages.size())),
+              IsOk());
+  for (int i = 0; i < kPageCount; i++) {
+    EXPECT_EQ(pages.substr(i * kPageSize, kPageSize - 28),
+              original.substr(i * kPageSize, kPageSize - 28));
+  }
+  EXPECT_THAT(page_aead.EncryptPages(
+                  0, "", kPageSize,
+                  absl::MakeSpan(&pages[0], pages.size() - 1)),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(AesGcmPageBoringSslTest, InvalidArguments) {
+  EXPECT_THAT(AesGcmPageBoringSsl::New(Random::GetRandomKeyBytes(24))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  auto page_aead_or = AesGcmPageBoringSsl::New(Random::GetRandomKeyBytes(16));
+  ASSERT_THAT(page_aead_or.status(), IsOk());
+  std::string page(27, 'x');
+  EXPECT_THAT(page_aead_or.ValueOrDie()->EncryptPage(
+                  0, "", absl::MakeSpan(&page[0], page.size())),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(AesGcmPageBoringSslFipsTest, FipsOnly) {
+  if (!kUseOnlyFips) {
+    GTEST_SKIP() << "Only supported in FIPS-only mode";
+  }
+  EXPECT_THAT(AesGcmPageBoringSsl::New(Random::GetRandomKeyBytes(16)).status(),
+              StatusIs(util::error::INTERNAL));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
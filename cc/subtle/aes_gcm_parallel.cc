@@ -0,0 +1,349 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_gcm_parallel.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "openssl/aead.h"
+#include "openssl/crypto.h"
+#include "openssl/evp.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+using Block = AesGcmParallel::Block;
+
+constexpr uint8_t kZeroBlock[16] = {0};
+
+// GCM's 32-bit block counter limits messages to 2^32 - 2 blocks.
+constexpr int64_t kMaxMessageSizeInBytes = (int64_t{1} << 36) - 32;
+
+Block LoadBlock(const uint8_t* in) {
+  Block block = {0, 0};
+  for (int i = 0; i < 16; i++) {
+    block[i / 8] = (block[i / 8] << 8) | in[i];
+  }
+  return block;
+}
+
+void StoreBlock(const Block& block, uint8_t* out) {
+  for (int i = 0; i < 16; i++) {
+    out[i] = static_cast<uint8_t>(block[i / 8] >> (56 - 8 * (i % 8)));
+  }
+}
+
+Block Xor(const Block& x, const Block& y) {
+  return {x[0] ^ y[0], x[1] ^ y[1]};
+}
+
+// Multiplication in GF(2^128) as defined in NIST SP 800-38D, Algorithm 1.
+// This runs a few times per chunk, so it favours constant time over speed.
+Block Multiply(const Block& x, const Block& y) {
+  Block z = {0, 0};
+  Block v = y;
+  for (int i = 0; i < 128; i++) {
+    uint64_t bit_mask = 0 - ((x[i / 64] >> (63 - i % 64)) & 1);
+    z[0] ^= v[0] & bit_mask;
+    z[1] ^= v[1] & bit_mask;
+    uint64_t reduce_mask = 0 - (v[1] & 1);
+    v[1] = (v[1] >> 1) | (v[0] << 63);
+    v[0] = (v[0] >> 1) ^ (0xe100000000000000 & reduce_mask);
+  }
+  return z;
+}
+
+// Returns h^n for n >= 1.
+Block Power(const Block& h, uint64_t n) {
+  Block result = h;
+  int bit = 63;
+  while ((n >> bit) == 0) bit--;
+  for (bit--; bit >= 0; bit--) {
+    result = Multiply(result, result);
+    if ((n >> bit) & 1) result = Multiply(result, h);
+  }
+  return result;
+}
+
+uint64_t NumBlocks(uint64_t size) { return (size + 15) / 16; }
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<Aead>> AesGcmParallel::New(
+    const util::SecretData& key,
+    std::shared_ptr<Executor> executor,
+    int64_t parallel_threshold_in_bytes) {
+  auto status = CheckFipsCompatibility<AesGcmParallel>();
+  if (!status.ok()) return status;
+
+  if (executor == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT, "executor is null");
+  }
+  const EVP_AEAD* aead =
+      SubtleUtilBoringSSL::GetAesGcmAeadForKeySize(key.size());
+  const EVP_CIPHER* cipher =
+      SubtleUtilBoringSSL::GetAesCtrCipherForKeySize(key.size());
+  if (aead == nullptr || cipher == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
+  }
+  auto sequential_or = AesGcmBoringSsl::New(key);
+  if (!sequential_or.ok()) return sequential_or.status();
+  bssl::UniquePtr<EVP_AEAD_CTX> ghash_ctx(EVP_AEAD_CTX_new(
+      aead, key.data(), key.size(), EVP_AEAD_DEFAULT_TAG_LENGTH));
+  if (!ghash_ctx) {
+    return util::Status(util::error::INTERNAL,
+                        "could not initialize EVP_AEAD_CTX");
+  }
+  bssl::UniquePtr<EVP_CIPHER_CTX> ctr_ctx(EVP_CIPHER_CTX_new());
+  if (ctr_ctx == nullptr ||
+      EVP_EncryptInit_ex(ctr_ctx.get(), cipher, nullptr /* engine */,
+                         key.data(), nullptr /* iv */) != 1) {
+    return util::Status(util::error::INTERNAL, "could not initialize ctx");
+  }
+  auto result = absl::WrapUnique(new AesGcmParallel(
+      std::move(sequential_or.ValueOrDie()), std::move(ghash_ctx),
+      std::move(ctr_ctx), std::move(executor), parallel_threshold_in_bytes));
+  status = result->Init();
+  if (!status.ok()) return status;
+  return {std::move(result)};
+}
+
+util::Status AesGcmParallel::Init() {
+  uint8_t block[16];
+  auto status = Ctr(kZeroBlock, 0, kZeroBlock, sizeof(block), block);
+  if (!status.ok()) return status;
+  hash_keys_->h = LoadBlock(block);
+  status = Ctr(kZeroBlock, 1, kZeroBlock, sizeof(block), block);
+  if (!status.ok()) return status;
+  hash_keys_->ghash_mask = LoadBlock(block);
+  OPENSSL_cleanse(block, sizeof(block));
+  hash_keys_->h_chunk = Power(hash_keys_->h, kChunkSizeInBytes / 16);
+  return util::OkStatus();
+}
+
+util::Status AesGcmParallel::Ctr(const uint8_t* iv, uint32_t counter,
+                                 const uint8_t* in, size_t size,
+                                 uint8_t* out) const {
+  uint8_t counter_block[16];
+  std::memcpy(counter_block, iv, kIvSizeInBytes);
+  for (int i = 0; i < 4; i++) {
+    counter_block[kIvSizeInBytes + i] =
+        static_cast<uint8_t>(counter >> (24 - 8 * i));
+  }
+  // The context increments all 128 bits of the counter block, which is the
+  // same as GCM's 32-bit increment since kMaxMessageSizeInBytes keeps the
+  // counter from wrapping.
+  bssl::UniquePtr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new());
+  int len;
+  if (ctx == nullptr || !EVP_CIPHER_CTX_copy(ctx.get(), ctr_ctx_.get()) ||
+      EVP_EncryptInit_ex(ctx.get(), nullptr, nullptr, nullptr,
+                         counter_block) != 1 ||
+      EVP_EncryptUpdate(ctx.get(), out, &len, in, size) != 1 ||
+      static_cast<size_t>(len) != size) {
+    return util::Status(util::error::INTERNAL, "AES-CTR failed");
+  }
+  return util::OkStatus();
+}
+
+util::StatusOr<Block> AesGcmParallel::Ghash(absl::string_view data) const {
+  // Sealing an empty message with 'data' as its associated data yields
+  // E(0^96 || 1) xor GHASH(data || L), with L the length block of 'data'.
+  // Unmasking and adding L * H leaves Y * H.
+  uint8_t tag[kTagSizeInBytes];
+  size_t len;
+  if (EVP_AEAD_CTX_seal(ghash_ctx_.get(), tag, &len, sizeof(tag), kZeroBlock,
+                        kIvSizeInBytes, nullptr, 0,
+                        reinterpret_cast<const uint8_t*>(data.data()),
+                        data.size()) != 1) {
+    return util::Status(util::error::INTERNAL, "GHASH failed");
+  }
+  Block length_block = {static_cast<uint64_t>(data.size()) * 8, 0};
+  return Xor(Xor(LoadBlock(tag), hash_keys_->ghash_mask),
+             Multiply(length_block, hash_keys_->h));
+}
+
+util::Status AesGcmParallel::CryptParallel(const uint8_t* iv,
+                                           absl::string_view additional_data,
+                                           absl::string_view in, uint8_t* out,
+                                           bool encrypt, uint8_t* tag) const {
+  const int num_chunks =
+      (in.size() + kChunkSizeInBytes - 1) / kChunkSizeInBytes;
+  std::vector<Block> hashes(num_chunks);
+  std::vector<util::Status> statuses(num_chunks);
+  executor_->ParallelFor(num_chunks, [&](int i) {
+    const size_t offset = static_cast<size_t>(i) * kChunkSizeInBytes;
+    const size_t size = std::min<size_t>(kChunkSizeInBytes, in.size() - offset);
+    const uint8_t* chunk_in =
+        reinterpret_cast<const uint8_t*>(in.data()) + offset;
+    const uint32_t counter = 2 + offset / 16;
+    // The chunk is hashed while it is still in cache.
+    util::StatusOr<Block> hash_or;
+    if (encrypt) {
+      statuses[i] = Ctr(iv, counter, chunk_in, size, out + offset);
+      if (!statuses[i].ok()) return;
+      hash_or = Ghash(absl::string_view(
+          reinterpret_cast<const char*>(out + offset), size));
+    } else {
+      hash_or = Ghash(in.substr(offset, size));
+      if (hash_or.ok()) {
+        statuses[i] = Ctr(iv, counter, chunk_in, size, out + offset);
+      }
+    }
+    if (!hash_or.ok()) {
+      statuses[i] = hash_or.status();
+      return;
+    }
+    hashes[i] = hash_or.ValueOrDie();
+  });
+  for (const util::Status& status : statuses) {
+    if (!status.ok()) return status;
+  }
+
+  // GHASH is linear: the hash of the whole input is the sum of the chunk
+  // hashes, each multiplied by H^(number of blocks after the chunk).
+  auto hash_or = Ghash(additional_data);
+  if (!hash_or.ok()) return hash_or.status();
+  Block hash = hash_or.ValueOrDie();
+  for (int i = 0; i < num_chunks; i++) {
+    const size_t offset = static_cast<size_t>(i) * kChunkSizeInBytes;
+    const uint64_t chunk_blocks =
+        NumBlocks(std::min<size_t>(kChunkSizeInBytes, in.size() - offset));
+    hash = Xor(Multiply(hash, chunk_blocks == kChunkSizeInBytes / 16
+                                  ? hash_keys_->h_chunk
+                                  : Power(hash_keys_->h, chunk_blocks)),
+               hashes[i]);
+  }
+  Block length_block = {static_cast<uint64_t>(additional_data.size()) * 8,
+                        static_cast<uint64_t>(in.size()) * 8};
+  hash = Xor(hash, Multiply(length_block, hash_keys_->h));
+
+  uint8_t mask[kTagSizeInBytes];
+  auto status = Ctr(iv, 1, kZeroBlock, sizeof(mask), mask);
+  if (!status.ok()) return status;
+  StoreBlock(Xor(hash, LoadBlock(mask)), tag);
+  return util::OkStatus();
+}
+
+util::StatusOr<std::string> AesGcmParallel::Encrypt(
+    absl::string_view plaintext, absl::string_view additional_data) const {
+  std::string result;
+  ResizeStringUninitialized(
+      &result, kIvSizeInBytes + plaintext.size() + kTagSizeInBytes);
+  auto written_or = EncryptInto(plaintext, additional_data,
+                                absl::MakeSpan(&result[0], result.size()));
+  if (!written_or.ok()) return written_or.status();
+  return result;
+}
+
+util::StatusOr<std::string> AesGcmParallel::Decrypt(
+    absl::string_view ciphertext, absl::string_view additional_data) const {
+  if (ciphertext.size() < kIvSizeInBytes + kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+
+  std::string result;
+  ResizeStringUninitialized(
+      &result, ciphertext.size() - kIvSizeInBytes - kTagSizeInBytes);
+  auto written_or = DecryptInto(ciphertext, additional_data,
+                                absl::MakeSpan(&result[0], result.size()));
+  if (!written_or.ok()) return written_or.status();
+  return result;
+}
+
+util::StatusOr<int64_t> AesGcmParallel::CiphertextSize(
+    int64_t plaintext_size) const {
+  return sequential_->CiphertextSize(plaintext_size);
+}
+
+util::StatusOr<int64_t> AesGcmParallel::EncryptInto(
+    absl::string_view plaintext, absl::string_view additional_data,
+    absl::Span<char> ciphertext_buffer) const {
+  if (static_cast<int64_t>(plaintext.size()) < parallel_threshold_in_bytes_) {
+    return sequential_->EncryptInto(plaintext, additional_data,
+                                    ciphertext_buffer);
+  }
+  if (static_cast<int64_t>(plaintext.size()) > kMaxMessageSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Plaintext too long");
+  }
+  const size_t ciphertext_size =
+      kIvSizeInBytes + plaintext.size() + kTagSizeInBytes;
+  if (ciphertext_buffer.size() < ciphertext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Ciphertext buffer too small");
+  }
+  auto status =
+      Random::GetRandomBytes(ciphertext_buffer.subspan(0, kIvSizeInBytes));
+  if (!status.ok()) return status;
+  uint8_t* iv = reinterpret_cast<uint8_t*>(ciphertext_buffer.data());
+  status = CryptParallel(iv, additional_data, plaintext, iv + kIvSizeInBytes,
+                         /*encrypt=*/true,
+                         iv + kIvSizeInBytes + plaintext.size());
+  if (!status.ok()) return status;
+  return ciphertext_size;
+}
+
+util::StatusOr<int64_t> AesGcmParallel::DecryptInto(
+    absl::string_view ciphertext, absl::string_view additional_data,
+    absl::Span<char> plaintext_buffer) const {
+  if (ciphertext.size() < kIvSizeInBytes + kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  const size_t plaintext_size =
+      ciphertext.size() - kIvSizeInBytes - kTagSizeInBytes;
+  if (static_cast<int64_t>(plaintext_size) < parallel_threshold_in_bytes_) {
+    return sequential_->DecryptInto(ciphertext, additional_data,
+                                    plaintext_buffer);
+  }
+  if (static_cast<int64_t>(plaintext_size) > kMaxMessageSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too long");
+  }
+  if (plaintext_buffer.size() < plaintext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Plaintext buffer too small");
+  }
+  const uint8_t* iv = reinterpret_cast<const uint8_t*>(ciphertext.data());
+  uint8_t* out = reinterpret_cast<uint8_t*>(plaintext_buffer.data());
+  uint8_t tag[kTagSizeInBytes];
+  auto status = CryptParallel(
+      iv, additional_data, ciphertext.substr(kIvSizeInBytes, plaintext_size),
+      out, /*encrypt=*/false, tag);
+  if (!status.ok()) return status;
+  if (CRYPTO_memcmp(tag, iv + kIvSizeInBytes + plaintext_size,
+                    kTagSizeInBytes) != 0) {
+    // Like EVP_AEAD_CTX_open, do not leave unauthenticated plaintext behind.
+    std::memset(out, 0, plaintext_size);
+    return util::Status(util::error::INTERNAL, "Authentication failed");
+  }
+  return plaintext_size;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,152 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_AES_GCM_PARALLEL_H_
+#define TINK_SUBTLE_AES_GCM_PARALLEL_H_
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/aead.h"
+#include "openssl/evp.h"
+#include "tink/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/executor.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// AES-GCM which encrypts and decrypts large messages on several threads.
+// Its ciphertexts are identical to those of AesGcmBoringSsl: a 12 byte
+// random IV, followed by the encrypted message and the 16 byte tag, and the
+// two classes decrypt each other's ciphertexts.
+//
+// Messages shorter than 'parallel_threshold_in_bytes' are handled by an
+// AesGcmBoringSsl on the calling thread. Longer messages are split into
+// chunks of kChunkSizeInBytes, and each chunk is encrypted (AES-CTR,
+// starting at the chunk's counter value) and hashed (GHASH) by a task on
+// 'executor' or on the calling thread. The partial hashes are combined with
+// powers of the hash key H into the GHASH of the whole ciphertext.
+//
+// 'executor' is shared with the caller, who may use it for other work;
+// Encrypt() and Decrypt() must not be called from a task running on it.
+//
+// Thread safety: This class is thread safe and thus can be used
+// concurrently.
+class AesGcmParallel : public Aead {
+ public:
+  static constexpr int64_t kDefaultParallelThresholdInBytes = 4 << 20;
+  static constexpr int kChunkSizeInBytes = 256 << 10;
+
+  static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
+      const util::SecretData& key,
+      std::shared_ptr<Executor> executor,
+      int64_t parallel_threshold_in_bytes = kDefaultParallelThresholdInBytes);
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view additional_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view additional_data) const override;
+
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override;
+
+  crypto::tink::util::StatusOr<int64_t> EncryptInto(
+      absl::string_view plaintext, absl::string_view additional_data,
+      absl::Span<char> ciphertext_buffer) const override;
+
+  crypto::tink::util::StatusOr<int64_t> DecryptInto(
+      absl::string_view ciphertext, absl::string_view additional_data,
+      absl::Span<char> plaintext_buffer) const override;
+
+  // GCM is assembled here from AES-CTR and GHASH, which is not a FIPS
+  // approved implementation.
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kNotFips;
+
+  // An element of GF(2^128) in GCM's bit order, as two big-endian halves.
+  using Block = std::array<uint64_t, 2>;
+
+  struct HashKeys {
+    Block h;
+    Block h_chunk;     // H^(kChunkSizeInBytes / 16)
+    Block ghash_mask;  // E(0^96 || 1), which ghash_ctx_ adds to its tags
+  };
+
+ private:
+  static constexpr int kIvSizeInBytes = 12;
+  static constexpr int kTagSizeInBytes = 16;
+
+  AesGcmParallel(std::unique_ptr<Aead> sequential,
+                 bssl::UniquePtr<EVP_AEAD_CTX> ghash_ctx,
+                 bssl::UniquePtr<EVP_CIPHER_CTX> ctr_ctx,
+                 std::shared_ptr<Executor> executor,
+                 int64_t parallel_threshold_in_bytes)
+      : sequential_(std::move(sequential)),
+        ghash_ctx_(std::move(ghash_ctx)),
+        ctr_ctx_(std::move(ctr_ctx)),
+        executor_(std::move(executor)),
+        parallel_threshold_in_bytes_(parallel_threshold_in_bytes) {}
+
+  // Computes the hash key, the mask of the GHASH tags and H^(chunk blocks).
+  crypto::tink::util::Status Init();
+
+  // Encrypts 'size' bytes with AES-CTR, starting at the counter block
+  // iv || 'counter'.
+  crypto::tink::util::Status Ctr(const uint8_t* iv, uint32_t counter,
+                                 const uint8_t* in, size_t size,
+                                 uint8_t* out) const;
+
+  // Returns Y * H, where Y is the GHASH state after absorbing 'data' (padded
+  // with zeros to a multiple of 16 bytes) from the zero state.
+  crypto::tink::util::StatusOr<Block> Ghash(absl::string_view data) const;
+
+  // Encrypts or decrypts 'in' into 'out' on the executor, and computes the
+  // tag of the ciphertext, which is 'out' when encrypting and 'in' when
+  // decrypting.
+  crypto::tink::util::Status CryptParallel(const uint8_t* iv,
+                                           absl::string_view additional_data,
+                                           absl::string_view in, uint8_t* out,
+                                           bool encrypt, uint8_t* tag) const;
+
+  const std::unique_ptr<Aead> sequential_;
+  // Computes GHASH as the tag of empty messages under the all-zero nonce.
+  const bssl::UniquePtr<EVP_AEAD_CTX> ghash_ctx_;
+  // Keyed AES-CTR context, copied by every chunk.
+  const bssl::UniquePtr<EVP_CIPHER_CTX> ctr_ctx_;
+  const std::shared_ptr<Executor> executor_;
+  const int64_t parallel_threshold_in_bytes_;
+  util::SecretUniquePtr<HashKeys> hash_keys_ =
+      util::MakeSecretUniquePtr<HashKeys>();
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_AES_GCM_PARALLEL_H_
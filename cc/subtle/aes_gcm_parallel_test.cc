@@ -0,0 +1,160 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_gcm_parallel.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/types/span.h"
+#include "tink/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/internal/thread_pool.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+using ::testing::Not;
+
+constexpr int kChunkSize = AesGcmParallel::kChunkSizeInBytes;
+
+TEST(AesGcmParallelTest, InteroperatesWithAesGcmBoringSsl) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto executor = std::make_shared<internal::ThreadPool>(3);
+  for (int key_size : {16, 32}) {
+    util::SecretData key = Random::GetRandomKeyBytes(key_size);
+    // A threshold of 0 takes the parallel path for every message.
+    auto parallel_or = AesGcmParallel::New(key, executor, 0);
+    ASSERT_THAT(parallel_or.status(), IsOk());
+    const Aead& parallel = *parallel_or.ValueOrDie();
+    auto boringssl_or = AesGcmBoringSsl::New(key);
+    ASSERT_THAT(boringssl_or.status(), IsOk());
+    const Aead& boringssl = *boringssl_or.ValueOrDie();
+    // Sizes around the chunk boundaries.
+    for (int size : {0, 1, 16, 17, kChunkSize - 1, kChunkSize, kChunkSize + 1,
+                     3 * kChunkSize + 17}) {
+      for (int aad_size : {0, 1, 16, 33}) {
+        std::string message = Random::GetRandomBytes(size);
+        std::string aad = Random::GetRandomBytes(aad_size);
+        auto ct = parallel.Encrypt(message, aad);
+        ASSERT_THAT(ct.status(), IsOk());
+        EXPECT_THAT(ct.ValueOrDie().size(), Eq(12 + size + 16));
+        auto pt = boringssl.Decrypt(ct.ValueOrDie(), aad);
+        ASSERT_THAT(pt.status(), IsOk()) << size << " " << aad_size;
+        EXPECT_THAT(pt.ValueOrDie(), Eq(message));
+
+        ct = boringssl.Encrypt(message, aad);
+        ASSERT_THAT(ct.status(), IsOk());
+        pt = parallel.Decrypt(ct.ValueOrDie(), aad);
+        ASSERT_THAT(pt.status(), IsOk()) << size << " " << aad_size;
+        EXPECT_THAT(pt.ValueOrDie(), Eq(message));
+      }
+    }
+  }
+}
+
+TEST(AesGcmParallelTest, Threshold) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  // Without worker threads all chunks run on the calling thread.
+  auto executor = std::make_shared<internal::ThreadPool>(0);
+  auto aead_or = AesGcmParallel::New(Random::GetRandomKeyBytes(16), executor,
+                                     2 * kChunkSize);
+  ASSERT_THAT(aead_or.status(), IsOk());
+  const Aead& aead = *aead_or.ValueOrDie();
+  for (int size : {0, 2 * kChunkSize - 1, 2 * kChunkSize, 5 * kChunkSize}) {
+    std::string message = Random::GetRandomBytes(size);
+    auto ct = aead.Encrypt(message, "aad");
+    ASSERT_THAT(ct.status(), IsOk());
+    auto pt = aead.Decrypt(ct.ValueOrDie(), "aad");
+    ASSERT_THAT(pt.status(), IsOk());
+    EXPECT_THAT(pt.ValueOrDie(), Eq(message));
+  }
+}
+
+TEST(AesGcmParallelTest, Modification) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto executor = std::make_shared<internal::ThreadPool>(2);
+  auto aead_or =
+      AesGcmParallel::New(Random::GetRandomKeyBytes(32), executor, 0);
+  ASSERT_THAT(aead_or.status(), IsOk());
+  const Aead& aead = *aead_or.ValueOrDie();
+  std::string message = Random::GetRandomBytes(2 * kChunkSize + 5);
+  std::string ct = aead.Encrypt(message, "aad").ValueOrDie();
+  for (size_t i : {size_t{0}, size_t{11}, size_t{12}, ct.size() / 2,
+                   ct.size() - 17, ct.size() - 1}) {
+    std::string modified = ct;
+    modified[i] ^= 1;
+    std::string plaintext(message.size(), 'x');
+    EXPECT_THAT(aead.DecryptInto(modified, "aad", absl::MakeSpan(plaintext))
+                    .status(),
+                StatusIs(util::error::INTERNAL))
+        << i;
+    EXPECT_THAT(plaintext, Eq(std::string(message.size(), '\0')));
+  }
+  EXPECT_THAT(aead.Decrypt(ct, "aae").status(), Not(IsOk()));
+  EXPECT_THAT(aead.Decrypt(ct.substr(0, 27), "aad").status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(AesGcmParallelTest, InvalidParameters) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto executor = std::make_shared<internal::ThreadPool>(1);
+  for (int key_size : {0, 15, 24, 33}) {
+    EXPECT_THAT(
+        AesGcmParallel::New(util::SecretData(key_size, 'x'), executor).status(),
+        StatusIs(util::error::INVALID_ARGUMENT))
+        << key_size;
+  }
+  EXPECT_THAT(
+      AesGcmParallel::New(Random::GetRandomKeyBytes(16), nullptr).status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(AesGcmParallelTest, FipsMode) {
+  if (!kUseOnlyFips) {
+    GTEST_SKIP() << "Only supported in FIPS-only mode";
+  }
+  auto executor = std::make_shared<internal::ThreadPool>(1);
+  EXPECT_THAT(
+      AesGcmParallel::New(Random::GetRandomKeyBytes(16), executor).status(),
+      StatusIs(util::error::INTERNAL));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
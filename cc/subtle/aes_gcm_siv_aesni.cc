@@ -0,0 +1,679 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef __SSE4_1__
+#ifdef __AES__
+#ifdef __PCLMUL__
+
+#include "tink/subtle/aes_gcm_siv_aesni.h"
+
+#include <emmintrin.h>  // SSE2: used for _mm_add_epi32 _mm_unpacklo_epi64 etc.
+#include <smmintrin.h>  // SSE4: used for _mm_insert_epi32
+#include <wmmintrin.h>  // AES_NI and PCLMULQDQ instructions.
+#include <xmmintrin.h>  // Datatype _mm128i
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+using RoundKeys = AesGcmSivAesni::RoundKeys;
+using MessageKeys = AesGcmSivAesni::MessageKeys;
+
+constexpr size_t kBlockSize = 16;
+constexpr size_t kNonceSize = 12;
+// Number of counter blocks encrypted together in CTR mode, and of blocks
+// POLYVAL absorbs per reduction.
+constexpr int kLanes = 8;
+// RFC 8452 limits the plaintext and the additional data to 2^36 bytes.
+constexpr uint64_t kMaxInputSize = uint64_t{1} << 36;
+
+inline __m128i LoadBlock(const uint8_t* block) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+}
+
+inline void StoreBlock(uint8_t* block, __m128i value) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(block), value);
+}
+
+// Loads block[0] .. block[size - 1] into the least significant bytes of a
+// register, followed by zeros. The efficiency of this function is not
+// critical.
+__m128i LoadPartialBlock(const uint8_t* block, size_t size) {
+  std::array<uint8_t, 16> tmp;
+  tmp.fill(0);
+  std::copy_n(block, size, tmp.begin());
+  return LoadBlock(tmp.data());
+}
+
+// Sets out[i] = in[i] XOR key_stream[i] for i = 0 .. size - 1, where
+// size <= 16. The efficiency of this function is not critical.
+void XorPartialBlock(__m128i key_stream, const uint8_t* in, size_t size,
+                     uint8_t* out) {
+  std::array<uint8_t, 16> tmp;
+  StoreBlock(tmp.data(), key_stream);
+  for (size_t j = 0; j < size; j++) {
+    out[j] = in[j] ^ tmp[j];
+  }
+}
+
+static const uint8_t kRoundConstant[11] =
+    {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36};
+
+// Call the AESKEYGENASSIST operation on a 32-bit input.
+// This performs a rotation and a substitution with an S-box.
+inline uint32_t SubRot(uint32_t tmp) {
+  __m128i inp = _mm_set_epi32(0, 0, tmp, 0);
+  __m128i out = _mm_aeskeygenassist_si128(inp, 0x00);
+  return _mm_extract_epi32(out, 1);
+}
+
+// Apply the S-box to the 4 bytes in a word.
+inline uint32_t SubWord(uint32_t tmp) {
+  __m128i inp = _mm_set_epi32(0, 0, tmp, 0);
+  __m128i out = _mm_aeskeygenassist_si128(inp, 0x00);
+  return _mm_extract_epi32(out, 0);
+}
+
+// Key expansion as in FIPS 197 for keys of 'nk' words, i.e. 4 for AES-128
+// and 8 for AES-256.
+void AesKeyExpansion(const uint8_t* key, int nk, __m128i* round_key) {
+  const int nb = 4;  // Number of words per round key
+  const int nr = nk + 6;
+  uint32_t* w = reinterpret_cast<uint32_t*>(round_key);
+  std::memcpy(w, key, nk * sizeof(uint32_t));
+  uint32_t tmp = w[nk - 1];
+  for (int i = nk; i < nb * (nr + 1); i++) {
+    if (i % nk == 0) {
+      tmp = SubRot(tmp) ^ kRoundConstant[i / nk];
+    } else if (nk > 6 && i % nk == 4) {
+      tmp = SubWord(tmp);
+    }
+    tmp ^= w[i - nk];
+    w[i] = tmp;
+  }
+}
+
+// Applies one step of AES to the blocks b[0] .. b[N - 1]. The recursion
+// unrolls the loop over the blocks, which lets the compiler keep them in
+// registers.
+template <int N>
+struct Lanes {
+  static inline void Xor(__m128i* b, __m128i round_key) {
+    Lanes<N - 1>::Xor(b, round_key);
+    b[N - 1] = _mm_xor_si128(b[N - 1], round_key);
+  }
+  static inline void Round(__m128i* b, __m128i round_key) {
+    Lanes<N - 1>::Round(b, round_key);
+    b[N - 1] = _mm_aesenc_si128(b[N - 1], round_key);
+  }
+  static inline void LastRound(__m128i* b, __m128i round_key) {
+    Lanes<N - 1>::LastRound(b, round_key);
+    b[N - 1] = _mm_aesenclast_si128(b[N - 1], round_key);
+  }
+  static inline void Copy(const __m128i* from, __m128i* to) {
+    Lanes<N - 1>::Copy(from, to);
+    to[N - 1] = from[N - 1];
+  }
+};
+
+template <>
+struct Lanes<0> {
+  static inline void Xor(__m128i* b, __m128i round_key) {}
+  static inline void Round(__m128i* b, __m128i round_key) {}
+  static inline void LastRound(__m128i* b, __m128i round_key) {}
+  static inline void Copy(const __m128i* from, __m128i* to) {}
+};
+
+// Encrypts the blocks blocks[0] .. blocks[N - 1] in place with the
+// 'rounds' + 1 round keys 'key', interleaving the rounds of all blocks.
+template <int N>
+inline void EncryptLanes(const RoundKeys& key, int rounds, __m128i* blocks) {
+  // A local copy, which cannot alias the round keys.
+  __m128i b[N];
+  Lanes<N>::Copy(blocks, b);
+  Lanes<N>::Xor(b, key[0]);
+  for (int i = 1; i < rounds; i++) {
+    Lanes<N>::Round(b, key[i]);
+  }
+  Lanes<N>::LastRound(b, key[rounds]);
+  Lanes<N>::Copy(b, blocks);
+}
+
+// A sum of unreduced products in POLYVAL's field GF(2^128), whose elements
+// are stored with the coefficient of x^i in bit i.
+struct Product {
+  __m128i lo = _mm_setzero_si128();
+  __m128i mid = _mm_setzero_si128();
+  __m128i hi = _mm_setzero_si128();
+
+  inline void Add(__m128i a, __m128i b) {
+    lo = _mm_xor_si128(lo, _mm_clmulepi64_si128(a, b, 0x00));
+    hi = _mm_xor_si128(hi, _mm_clmulepi64_si128(a, b, 0x11));
+    mid = _mm_xor_si128(mid, _mm_clmulepi64_si128(a, b, 0x01));
+    mid = _mm_xor_si128(mid, _mm_clmulepi64_si128(a, b, 0x10));
+  }
+
+  // Returns the sum times x^-128, modulo x^128 + x^127 + x^126 + x^121 + 1.
+  // The two folding steps are those of the RFC 8452 reference
+  // implementation.
+  inline __m128i Reduce() const {
+    const __m128i poly = _mm_setr_epi32(1, 0, 0, 0xc2000000);
+    __m128i l = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+    __m128i h = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+    __m128i t = _mm_clmulepi64_si128(l, poly, 0x10);
+    l = _mm_xor_si128(_mm_shuffle_epi32(l, _MM_SHUFFLE(1, 0, 3, 2)), t);
+    t = _mm_clmulepi64_si128(l, poly, 0x10);
+    l = _mm_xor_si128(_mm_shuffle_epi32(l, _MM_SHUFFLE(1, 0, 3, 2)), t);
+    return _mm_xor_si128(h, l);
+  }
+};
+
+// POLYVAL's multiplication a * b * x^-128.
+inline __m128i Dot(__m128i a, __m128i b) {
+  Product p;
+  p.Add(a, b);
+  return p.Reduce();
+}
+
+// POLYVAL in progress. Groups of kLanes blocks are absorbed with a single
+// reduction, as the sum of the products of the blocks with the powers
+// H^kLanes .. H^1 of the key.
+class Polyval {
+ public:
+  // Only computes the powers of 'key' if 'aggregate' is set, i.e. if some
+  // input has at least kLanes blocks.
+  Polyval(__m128i key, bool aggregate) : aggregate_(aggregate) {
+    powers_[0] = key;
+    if (aggregate) {
+      for (int i = 1; i < kLanes; i++) {
+        powers_[i] = Dot(powers_[i - 1], key);
+      }
+    }
+  }
+
+  __m128i state() const { return state_; }
+
+  void Update(__m128i block) {
+    state_ = Dot(_mm_xor_si128(state_, block), powers_[0]);
+  }
+
+  // Absorbs blocks[0] .. blocks[kLanes - 1]; the powers must be computed.
+  void UpdateLanes(const __m128i* blocks) {
+    Product p;
+    p.Add(_mm_xor_si128(state_, blocks[0]), powers_[kLanes - 1]);
+    for (int j = 1; j < kLanes; j++) {
+      p.Add(blocks[j], powers_[kLanes - 1 - j]);
+    }
+    state_ = p.Reduce();
+  }
+
+  // Absorbs data[0] .. data[size - 1], padded with zeros to whole blocks.
+  void UpdatePadded(const uint8_t* data, size_t size) {
+    size_t i = 0;
+    if (aggregate_) {
+      __m128i blocks[kLanes];
+      for (; size - i >= kLanes * kBlockSize; i += kLanes * kBlockSize) {
+        for (int j = 0; j < kLanes; j++) {
+          blocks[j] = LoadBlock(data + i + j * kBlockSize);
+        }
+        UpdateLanes(blocks);
+      }
+    }
+    for (; size - i >= kBlockSize; i += kBlockSize) {
+      Update(LoadBlock(data + i));
+    }
+    if (i < size) Update(LoadPartialBlock(data + i, size - i));
+  }
+
+ private:
+  const bool aggregate_;
+  // powers_[i] = H^(i + 1).
+  __m128i powers_[kLanes];
+  __m128i state_ = _mm_setzero_si128();
+};
+
+// Whether POLYVAL needs the powers of its key for an input of these sizes.
+inline bool NeedsAggregation(size_t additional_data_size, size_t message_size) {
+  return std::max(additional_data_size, message_size) >= kLanes * kBlockSize;
+}
+
+// Completes the tag, given POLYVAL over the padded additional data and
+// message.
+__m128i FinalizeTag(const MessageKeys& keys, int rounds, const uint8_t* nonce,
+                    size_t additional_data_size, size_t message_size,
+                    Polyval* polyval) {
+  polyval->Update(_mm_set_epi64x(message_size * 8, additional_data_size * 8));
+  __m128i s = _mm_xor_si128(polyval->state(),
+                            LoadPartialBlock(nonce, kNonceSize));
+  s = _mm_and_si128(s, _mm_setr_epi32(-1, -1, -1, 0x7fffffff));
+  EncryptLanes<1>(keys.enc_key, rounds, &s);
+  return s;
+}
+
+// The initial counter block for the tag 'tag'.
+inline __m128i InitialCounter(__m128i tag) {
+  return _mm_or_si128(tag, _mm_setr_epi32(0, 0, 0, 0x80000000));
+}
+
+// Fills key_stream[0] .. key_stream[kLanes - 1] with the encryption of
+// the next kLanes counter blocks, of which only the first 32 bits (in
+// little endian order) are incremented.
+inline void NextKeyStream(const RoundKeys& key, int rounds, __m128i* counter,
+                          __m128i* key_stream) {
+  const __m128i one = _mm_setr_epi32(1, 0, 0, 0);
+  for (int j = 0; j < kLanes; j++) {
+    key_stream[j] = *counter;
+    *counter = _mm_add_epi32(*counter, one);
+  }
+  EncryptLanes<kLanes>(key, rounds, key_stream);
+}
+
+// Encrypts in[0] .. in[size - 1] into 'out' in CTR mode. If 'polyval' is
+// not null, the output is absorbed into it.
+void CtrCrypt(const RoundKeys& key, int rounds, __m128i counter,
+              const uint8_t* in, size_t size, uint8_t* out,
+              Polyval* polyval) {
+  __m128i key_stream[kLanes];
+  size_t i = 0;
+  for (; size - i >= kLanes * kBlockSize; i += kLanes * kBlockSize) {
+    NextKeyStream(key, rounds, &counter, key_stream);
+    for (int j = 0; j < kLanes; j++) {
+      key_stream[j] = _mm_xor_si128(key_stream[j],
+                                    LoadBlock(in + i + j * kBlockSize));
+      StoreBlock(out + i + j * kBlockSize, key_stream[j]);
+    }
+    if (polyval != nullptr) polyval->UpdateLanes(key_stream);
+  }
+  if (i < size) {
+    NextKeyStream(key, rounds, &counter, key_stream);
+    for (size_t j = 0; i + j * kBlockSize < size; j++) {
+      size_t offset = i + j * kBlockSize;
+      XorPartialBlock(key_stream[j], in + offset,
+                      std::min(kBlockSize, size - offset), out + offset);
+    }
+    if (polyval != nullptr) polyval->UpdatePadded(out + i, size - i);
+  }
+}
+
+// Encrypts 'plaintext' into ct[0] .. ct[plaintext.size() + 15] with the
+// keys 'keys' and the nonce 'nonce', given 'polyval' over the padded
+// additional data of 'additional_data_size' bytes.
+void SealAfterAdditionalData(const MessageKeys& keys, int rounds,
+                             const uint8_t* nonce, size_t additional_data_size,
+                             absl::string_view plaintext, Polyval polyval,
+                             uint8_t* ct) {
+  const uint8_t* pt = reinterpret_cast<const uint8_t*>(plaintext.data());
+  polyval.UpdatePadded(pt, plaintext.size());
+  __m128i tag = FinalizeTag(keys, rounds, nonce, additional_data_size,
+                            plaintext.size(), &polyval);
+  CtrCrypt(keys.enc_key, rounds, InitialCounter(tag), pt, plaintext.size(), ct,
+           nullptr);
+  StoreBlock(ct + plaintext.size(), tag);
+}
+
+// Decrypts ct[0] .. ct[plaintext_size + 15], i.e. the encrypted message
+// followed by the tag, into pt[0] .. pt[plaintext_size - 1]. Returns false,
+// with 'pt' zeroed, if the tag is invalid.
+bool Open(const MessageKeys& keys, int rounds, const uint8_t* nonce,
+          absl::string_view additional_data, const uint8_t* ct,
+          size_t plaintext_size, uint8_t* pt) {
+  const __m128i tag = LoadBlock(ct + plaintext_size);
+  Polyval polyval(keys.auth_key,
+                  NeedsAggregation(additional_data.size(), plaintext_size));
+  polyval.UpdatePadded(reinterpret_cast<const uint8_t*>(additional_data.data()),
+                       additional_data.size());
+  CtrCrypt(keys.enc_key, rounds, InitialCounter(tag), ct, plaintext_size, pt,
+           &polyval);
+  __m128i expected_tag = FinalizeTag(keys, rounds, nonce,
+                                     additional_data.size(), plaintext_size,
+                                     &polyval);
+  // Compare in constant time: all bytes are compared, whatever the result.
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(tag, expected_tag)) != 0xFFFF) {
+    std::fill_n(pt, plaintext_size, 0);
+    return false;
+  }
+  return true;
+}
+
+util::Status CheckInputSizes(size_t message_size,
+                             size_t additional_data_size) {
+  if (message_size > kMaxInputSize) {
+    return util::Status(util::error::INVALID_ARGUMENT, "message too long");
+  }
+  if (additional_data_size > kMaxInputSize) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "additional data too long");
+  }
+  return util::OkStatus();
+}
+
+// The nonce of DeterministicAesGcmSivAesni.
+constexpr uint8_t kZeroNonce[kNonceSize] = {0};
+
+}  // namespace
+
+// static
+crypto::tink::util::StatusOr<std::unique_ptr<Aead>> AesGcmSivAesni::New(
+    const util::SecretData& key) {
+  auto status = CheckFipsCompatibility<AesGcmSivAesni>();
+  if (!status.ok()) return status;
+
+  if (!IsValidKeySizeInBytes(key.size())) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
+  }
+  auto aead = absl::WrapUnique(new AesGcmSivAesni(key.size()));
+  AesKeyExpansion(key.data(), key.size() / 4, aead->key_gen_key_->data());
+  return {std::move(aead)};
+}
+
+void AesGcmSivAesni::DeriveKeys(const uint8_t* const* nonces, int count,
+                                MessageKeys* keys) const {
+  // The i-th derivation block of a nonce is the 32-bit little endian i
+  // followed by the nonce; the first 8 bytes of the encryption of blocks
+  // 0 and 1 form the authentication key, and those of the 2 or 4 following
+  // blocks the encryption key.
+  const int blocks_per_nonce = key_size_ == 16 ? 4 : 6;
+  __m128i blocks[12];
+  for (int m = 0; m < count; m++) {
+    std::array<uint8_t, 16> tmp;
+    tmp.fill(0);
+    std::copy_n(nonces[m], kNonceSize, tmp.begin() + 4);
+    __m128i nonce_block = LoadBlock(tmp.data());
+    for (int i = 0; i < blocks_per_nonce; i++) {
+      blocks[m * blocks_per_nonce + i] = _mm_insert_epi32(nonce_block, i, 0);
+    }
+  }
+  switch (count * blocks_per_nonce) {
+    case 4:
+      EncryptLanes<4>(*key_gen_key_, rounds_, blocks);
+      break;
+    case 6:
+      EncryptLanes<6>(*key_gen_key_, rounds_, blocks);
+      break;
+    case 8:
+      EncryptLanes<8>(*key_gen_key_, rounds_, blocks);
+      break;
+    default:
+      EncryptLanes<12>(*key_gen_key_, rounds_, blocks);
+      break;
+  }
+  for (int m = 0; m < count; m++) {
+    const __m128i* derived = blocks + m * blocks_per_nonce;
+    keys[m].auth_key = _mm_unpacklo_epi64(derived[0], derived[1]);
+    __m128i enc_key[2] = {_mm_unpacklo_epi64(derived[2], derived[3]),
+                          _mm_setzero_si128()};
+    if (key_size_ == 32) {
+      enc_key[1] = _mm_unpacklo_epi64(derived[4], derived[5]);
+    }
+    AesKeyExpansion(reinterpret_cast<const uint8_t*>(enc_key), key_size_ / 4,
+                    keys[m].enc_key.data());
+  }
+}
+
+void AesGcmSivAesni::Seal(const MessageKeys& keys,
+                          absl::string_view plaintext,
+                          absl::string_view additional_data,
+                          uint8_t* ct) const {
+  Polyval polyval(keys.auth_key,
+                  NeedsAggregation(additional_data.size(), plaintext.size()));
+  polyval.UpdatePadded(reinterpret_cast<const uint8_t*>(additional_data.data()),
+                       additional_data.size());
+  SealAfterAdditionalData(keys, rounds_, ct - kIvSizeInBytes,
+                          additional_data.size(), plaintext, polyval, ct);
+}
+
+util::Status AesGcmSivAesni::CheckSizes(size_t message_size,
+                                        size_t additional_data_size) const {
+  return CheckInputSizes(message_size, additional_data_size);
+}
+
+util::StatusOr<std::string> AesGcmSivAesni::Encrypt(
+    absl::string_view plaintext, absl::string_view additional_data) const {
+  std::string ciphertext;
+  ResizeStringUninitialized(
+      &ciphertext, kIvSizeInBytes + plaintext.size() + kTagSizeInBytes);
+  auto written_or =
+      EncryptInto(plaintext, additional_data,
+                  absl::MakeSpan(&ciphertext[0], ciphertext.size()));
+  if (!written_or.ok()) return written_or.status();
+  return std::move(ciphertext);
+}
+
+util::StatusOr<std::string> AesGcmSivAesni::Decrypt(
+    absl::string_view ciphertext, absl::string_view additional_data) const {
+  if (ciphertext.size() < kIvSizeInBytes + kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  std::string plaintext;
+  ResizeStringUninitialized(
+      &plaintext, ciphertext.size() - kIvSizeInBytes - kTagSizeInBytes);
+  auto written_or = DecryptInto(
+      ciphertext, additional_data,
+      absl::MakeSpan(&plaintext[0], plaintext.size()));
+  if (!written_or.ok()) return written_or.status();
+  return std::move(plaintext);
+}
+
+util::StatusOr<int64_t> AesGcmSivAesni::CiphertextSize(
+    int64_t plaintext_size) const {
+  if (plaintext_size < 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Plaintext size must be non-negative");
+  }
+  return kIvSizeInBytes + plaintext_size + kTagSizeInBytes;
+}
+
+util::StatusOr<int64_t> AesGcmSivAesni::EncryptInto(
+    absl::string_view plaintext, absl::string_view additional_data,
+    absl::Span<char> ciphertext_buffer) const {
+  auto status = CheckSizes(plaintext.size(), additional_data.size());
+  if (!status.ok()) return status;
+  const size_t ciphertext_size =
+      kIvSizeInBytes + plaintext.size() + kTagSizeInBytes;
+  if (ciphertext_buffer.size() < ciphertext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Ciphertext buffer too small");
+  }
+  status = Random::GetRandomBytes(ciphertext_buffer.subspan(0, kIvSizeInBytes));
+  if (!status.ok()) return status;
+  const uint8_t* nonce =
+      reinterpret_cast<const uint8_t*>(ciphertext_buffer.data());
+  MessageKeys keys;
+  DeriveKeys(&nonce, 1, &keys);
+  Seal(keys, plaintext, additional_data,
+       reinterpret_cast<uint8_t*>(ciphertext_buffer.data()) + kIvSizeInBytes);
+  return ciphertext_size;
+}
+
+util::StatusOr<int64_t> AesGcmSivAesni::DecryptInto(
+    absl::string_view ciphertext, absl::string_view additional_data,
+    absl::Span<char> plaintext_buffer) const {
+  if (ciphertext.size() < kIvSizeInBytes + kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  const size_t plaintext_size =
+      ciphertext.size() - kIvSizeInBytes - kTagSizeInBytes;
+  auto status = CheckSizes(plaintext_size, additional_data.size());
+  if (!status.ok()) return status;
+  if (plaintext_buffer.size() < plaintext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Plaintext buffer too small");
+  }
+  const uint8_t* nonce = reinterpret_cast<const uint8_t*>(ciphertext.data());
+  MessageKeys keys;
+  DeriveKeys(&nonce, 1, &keys);
+  if (!Open(keys, rounds_, nonce, additional_data, nonce + kIvSizeInBytes,
+            plaintext_size,
+            reinterpret_cast<uint8_t*>(plaintext_buffer.data()))) {
+    return util::Status(util::error::INTERNAL, "Authentication failed");
+  }
+  return plaintext_size;
+}
+
+util::Status AesGcmSivAesni::EncryptBatchInto(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::Span<const absl::string_view> associated_data,
+    absl::Span<const absl::Span<char>> ciphertext_buffers) const {
+  if (plaintexts.size() != associated_data.size() ||
+      plaintexts.size() != ciphertext_buffers.size()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Batch sizes do not match");
+  }
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    auto status = CheckSizes(plaintexts[i].size(), associated_data[i].size());
+    if (!status.ok()) return status;
+    if (ciphertext_buffers[i].size() <
+        kIvSizeInBytes + plaintexts[i].size() + kTagSizeInBytes) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Ciphertext buffer too small");
+    }
+  }
+  std::string nonces;
+  ResizeStringUninitialized(&nonces, plaintexts.size() * kIvSizeInBytes);
+  auto status =
+      Random::GetRandomBytes(absl::MakeSpan(&nonces[0], nonces.size()));
+  if (!status.ok()) return status;
+  for (size_t i = 0; i < plaintexts.size(); i += 2) {
+    const int count = std::min<size_t>(2, plaintexts.size() - i);
+    const uint8_t* batch_nonces[2];
+    for (int m = 0; m < count; m++) {
+      std::copy_n(&nonces[(i + m) * kIvSizeInBytes], kIvSizeInBytes,
+                  ciphertext_buffers[i + m].data());
+      batch_nonces[m] =
+          reinterpret_cast<const uint8_t*>(ciphertext_buffers[i + m].data());
+    }
+    MessageKeys keys[2];
+    DeriveKeys(batch_nonces, count, keys);
+    for (int m = 0; m < count; m++) {
+      Seal(keys[m], plaintexts[i + m], associated_data[i + m],
+           reinterpret_cast<uint8_t*>(ciphertext_buffers[i + m].data()) +
+               kIvSizeInBytes);
+    }
+  }
+  return util::OkStatus();
+}
+
+// static
+util::StatusOr<std::unique_ptr<DeterministicAead>>
+DeterministicAesGcmSivAesni::New(const util::SecretData& key) {
+  auto status = CheckFipsCompatibility<DeterministicAesGcmSivAesni>();
+  if (!status.ok()) return status;
+
+  if (!IsValidKeySizeInBytes(key.size())) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
+  }
+  // The keys of the zero nonce are all that is ever needed, so the key
+  // generating key is dropped once they are derived.
+  AesGcmSivAesni aead(key.size());
+  AesKeyExpansion(key.data(), key.size() / 4, aead.key_gen_key_->data());
+  auto daead = absl::WrapUnique(new DeterministicAesGcmSivAesni(aead.rounds_));
+  const uint8_t* nonce = kZeroNonce;
+  aead.DeriveKeys(&nonce, 1, daead->keys_.get());
+  return {std::move(daead)};
+}
+
+util::StatusOr<std::string>
+DeterministicAesGcmSivAesni::EncryptDeterministically(
+    absl::string_view plaintext, absl::string_view associated_data) const {
+  auto status = CheckInputSizes(plaintext.size(), associated_data.size());
+  if (!status.ok()) return status;
+  std::string ciphertext;
+  ResizeStringUninitialized(&ciphertext, plaintext.size() + kTagSizeInBytes);
+  Polyval polyval(keys_->auth_key,
+                  NeedsAggregation(associated_data.size(), plaintext.size()));
+  polyval.UpdatePadded(reinterpret_cast<const uint8_t*>(associated_data.data()),
+                       associated_data.size());
+  SealAfterAdditionalData(*keys_, rounds_, kZeroNonce, associated_data.size(),
+                          plaintext, polyval,
+                          reinterpret_cast<uint8_t*>(&ciphertext[0]));
+  return std::move(ciphertext);
+}
+
+util::StatusOr<std::string>
+DeterministicAesGcmSivAesni::DecryptDeterministically(
+    absl::string_view ciphertext, absl::string_view associated_data) const {
+  if (ciphertext.size() < kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  const size_t plaintext_size = ciphertext.size() - kTagSizeInBytes;
+  auto status = CheckInputSizes(plaintext_size, associated_data.size());
+  if (!status.ok()) return status;
+  std::string plaintext;
+  ResizeStringUninitialized(&plaintext, plaintext_size);
+  if (!Open(*keys_, rounds_, kZeroNonce, associated_data,
+            reinterpret_cast<const uint8_t*>(ciphertext.data()),
+            plaintext_size, reinterpret_cast<uint8_t*>(&plaintext[0]))) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Authentication failed");
+  }
+  return std::move(plaintext);
+}
+
+util::Status DeterministicAesGcmSivAesni::EncryptDeterministicallyBatchInto(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> ciphertext_buffers) const {
+  if (plaintexts.size() != ciphertext_buffers.size()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Batch sizes do not match");
+  }
+  size_t max_plaintext_size = 0;
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    auto status = CheckInputSizes(plaintexts[i].size(), associated_data.size());
+    if (!status.ok()) return status;
+    if (ciphertext_buffers[i].size() !=
+        plaintexts[i].size() + kTagSizeInBytes) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Ciphertext buffer has the wrong size");
+    }
+    max_plaintext_size = std::max(max_plaintext_size, plaintexts[i].size());
+  }
+  Polyval polyval(keys_->auth_key,
+                  NeedsAggregation(associated_data.size(), max_plaintext_size));
+  polyval.UpdatePadded(reinterpret_cast<const uint8_t*>(associated_data.data()),
+                       associated_data.size());
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    SealAfterAdditionalData(
+        *keys_, rounds_, kZeroNonce, associated_data.size(), plaintexts[i],
+        polyval, reinterpret_cast<uint8_t*>(ciphertext_buffers[i].data()));
+  }
+  return util::OkStatus();
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // __PCLMUL__
+#endif  // __AES__
+#endif  // __SSE4_1__
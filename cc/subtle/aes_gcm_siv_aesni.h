@@ -0,0 +1,191 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_AES_GCM_SIV_AESNI_H_
+#define TINK_SUBTLE_AES_GCM_SIV_AESNI_H_
+
+#ifdef __SSE4_1__
+#ifdef __AES__
+#ifdef __PCLMUL__
+
+#include <xmmintrin.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/deterministic_aead.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// This class implements AES-GCM-SIV (RFC 8452) on CPUs that support the
+// AESNI and PCLMULQDQ instruction sets (as well as SSE 4.1). It produces the
+// same ciphertexts as AesGcmSivBoringSsl: a 12 byte random nonce, followed
+// by the encrypted message and the 16 byte tag.
+//
+// The key schedule of the key-generating key is computed once, in New().
+// Per message, the 4 or 6 AES blocks which derive the message keys are
+// encrypted together, and POLYVAL processes 8 blocks per reduction with a
+// table of the powers H^1 .. H^8 of the message's authentication key, which
+// lives on the stack. The CTR key stream is computed 8 blocks at a time,
+// and when decrypting, POLYVAL runs over each group of plaintext blocks
+// right after it is decrypted.
+//
+// Thread safety: This class is thread safe and thus can be used
+// concurrently.
+class AesGcmSivAesni : public Aead {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
+      const util::SecretData& key);
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view additional_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view additional_data) const override;
+
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override;
+
+  crypto::tink::util::StatusOr<int64_t> EncryptInto(
+      absl::string_view plaintext, absl::string_view additional_data,
+      absl::Span<char> ciphertext_buffer) const override;
+
+  crypto::tink::util::StatusOr<int64_t> DecryptInto(
+      absl::string_view ciphertext, absl::string_view additional_data,
+      absl::Span<char> plaintext_buffer) const override;
+
+  // Draws the nonces of all messages at once, and derives the keys of two
+  // messages at a time.
+  crypto::tink::util::Status EncryptBatchInto(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::Span<const absl::string_view> associated_data,
+      absl::Span<const absl::Span<char>> ciphertext_buffers) const override;
+
+  static bool IsValidKeySizeInBytes(size_t size) {
+    return size == 16 || size == 32;
+  }
+
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kNotFips;
+
+  // Round keys of AES-128 or AES-256.
+  static constexpr int kMaxRounds = 14;
+  using RoundKeys = std::array<__m128i, kMaxRounds + 1>;
+
+  // The keys RFC 8452 derives from the key-generating key and a nonce.
+  struct MessageKeys {
+    __m128i auth_key;
+    RoundKeys enc_key;
+  };
+
+ private:
+  friend class DeterministicAesGcmSivAesni;
+
+  static constexpr int kIvSizeInBytes = 12;
+  static constexpr int kTagSizeInBytes = 16;
+
+  explicit AesGcmSivAesni(size_t key_size)
+      : key_size_(key_size), rounds_(key_size == 16 ? 10 : 14) {}
+
+  // Derives the keys of 'count' messages, 1 or 2, from the nonces
+  // nonces[0] .. nonces[count - 1] of kIvSizeInBytes bytes each.
+  void DeriveKeys(const uint8_t* const* nonces, int count,
+                  MessageKeys* keys) const;
+
+  // Encrypts 'plaintext' into ct[0] .. ct[plaintext.size() + 15] with the
+  // keys derived from the nonce at ct - kIvSizeInBytes.
+  void Seal(const MessageKeys& keys, absl::string_view plaintext,
+            absl::string_view additional_data, uint8_t* ct) const;
+
+  crypto::tink::util::Status CheckSizes(size_t message_size,
+                                        size_t additional_data_size) const;
+
+  const size_t key_size_;
+  const int rounds_;
+  // The key schedule of the key-generating key.
+  util::SecretUniquePtr<RoundKeys> key_gen_key_ =
+      util::MakeSecretUniquePtr<RoundKeys>();
+};
+
+// AES-GCM-SIV with the all-zero nonce as a DeterministicAead. The
+// ciphertext is that of AesGcmSivAesni for the zero nonce without the
+// nonce, i.e. the encrypted plaintext followed by the 16 byte tag.
+//
+// Unlike AES-SIV this needs a single pass of AES: POLYVAL runs on the
+// carry-less multiplier next to the CTR encryption. As the nonce is fixed,
+// the message keys are derived once, in New().
+class DeterministicAesGcmSivAesni : public DeterministicAead {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<DeterministicAead>> New(
+      const util::SecretData& key);
+
+  crypto::tink::util::StatusOr<std::string> EncryptDeterministically(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override {
+    return plaintext_size + kTagSizeInBytes;
+  }
+
+  // Absorbs 'associated_data' into POLYVAL once for all values.
+  crypto::tink::util::Status EncryptDeterministicallyBatchInto(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> ciphertext_buffers) const override;
+
+  static bool IsValidKeySizeInBytes(size_t size) {
+    return AesGcmSivAesni::IsValidKeySizeInBytes(size);
+  }
+
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kNotFips;
+
+ private:
+  static constexpr int kTagSizeInBytes = 16;
+
+  explicit DeterministicAesGcmSivAesni(int rounds) : rounds_(rounds) {}
+
+  const int rounds_;
+  util::SecretUniquePtr<AesGcmSivAesni::MessageKeys> keys_ =
+      util::MakeSecretUniquePtr<AesGcmSivAesni::MessageKeys>();
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // __PCLMUL__
+#endif  // __AES__
+#endif  // __SSE4_1__
+#endif  // TINK_SUBTLE_AES_GCM_SIV_AESNI_H_
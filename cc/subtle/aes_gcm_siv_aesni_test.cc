@@ -0,0 +1,276 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__SSE4_1__) && defined(__AES__) && defined(__PCLMUL__)
+
+#include "tink/subtle/aes_gcm_siv_aesni.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "tink/config/tink_fips.h"
+#include "tink/deterministic_aead.h"
+#include "tink/subtle/aes_gcm_siv_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+
+TEST(AesGcmSivAesniTest, InvalidKeySizes) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  for (int key_size : {0, 15, 17, 24, 31, 33, 64}) {
+    util::SecretData key(key_size, 'x');
+    EXPECT_THAT(AesGcmSivAesni::New(key).status(),
+                StatusIs(util::error::INVALID_ARGUMENT))
+        << key_size;
+  }
+}
+
+// The message and additional data sizes cover the boundaries of the 8-block
+// CTR and POLYVAL groups.
+TEST(AesGcmSivAesniTest, InteroperatesWithAesGcmSivBoringSsl) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  for (int key_size : {16, 32}) {
+    util::SecretData key = Random::GetRandomKeyBytes(key_size);
+    auto aesni = std::move(AesGcmSivAesni::New(key).ValueOrDie());
+    auto boringssl = std::move(AesGcmSivBoringSsl::New(key).ValueOrDie());
+    for (int msg_size : {0, 1, 15, 16, 17, 127, 128, 129, 255, 256, 1000}) {
+      for (int aad_size : {0, 1, 16, 17, 128, 200}) {
+        std::string msg = Random::GetRandomBytes(msg_size);
+        std::string aad = Random::GetRandomBytes(aad_size);
+        auto ct = aesni->Encrypt(msg, aad);
+        ASSERT_THAT(ct.status(), IsOk());
+        auto pt = boringssl->Decrypt(ct.ValueOrDie(), aad);
+        ASSERT_THAT(pt.status(), IsOk()) << msg_size << " " << aad_size;
+        EXPECT_EQ(pt.ValueOrDie(), msg);
+
+        ct = boringssl->Encrypt(msg, aad);
+        ASSERT_THAT(ct.status(), IsOk());
+        pt = aesni->Decrypt(ct.ValueOrDie(), aad);
+        ASSERT_THAT(pt.status(), IsOk()) << msg_size << " " << aad_size;
+        EXPECT_EQ(pt.ValueOrDie(), msg);
+      }
+    }
+  }
+}
+
+TEST(AesGcmSivAesniTest, EncryptBatch) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  for (int key_size : {16, 32}) {
+    auto aead =
+        std::move(AesGcmSivAesni::New(Random::GetRandomKeyBytes(key_size))
+                      .ValueOrDie());
+    // An odd number of messages, so that the last one is derived alone.
+    std::vector<std::string> messages;
+    std::vector<std::string> aads;
+    for (int i = 0; i < 5; i++) {
+      messages.push_back(Random::GetRandomBytes(i * 61));
+      aads.push_back(Random::GetRandomBytes(i * 7));
+    }
+    std::vector<absl::string_view> plaintexts(messages.begin(),
+                                              messages.end());
+    std::vector<absl::string_view> associated_data(aads.begin(), aads.end());
+    std::string arena;
+    std::vector<absl::string_view> ciphertexts;
+    ASSERT_THAT(
+        aead->EncryptBatch(plaintexts, associated_data, &arena, &ciphertexts),
+        IsOk());
+    ASSERT_EQ(ciphertexts.size(), messages.size());
+    for (size_t i = 0; i < messages.size(); i++) {
+      auto pt = aead->Decrypt(ciphertexts[i], aads[i]);
+      ASSERT_THAT(pt.status(), IsOk()) << i;
+      EXPECT_EQ(pt.ValueOrDie(), messages[i]);
+    }
+  }
+}
+
+TEST(AesGcmSivAesniTest, ModifiedCiphertext) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto aead = std::move(
+      AesGcmSivAesni::New(Random::GetRandomKeyBytes(32)).ValueOrDie());
+  std::string message = Random::GetRandomBytes(200);
+  std::string ct = aead->Encrypt(message, "aad").ValueOrDie();
+  for (size_t i = 0; i < ct.size(); i++) {
+    std::string modified = ct;
+    modified[i] ^= 0x01;
+    EXPECT_FALSE(aead->Decrypt(modified, "aad").ok()) << i;
+  }
+  EXPECT_FALSE(aead->Decrypt(ct, "aae").ok());
+  EXPECT_FALSE(aead->Decrypt(ct.substr(0, ct.size() - 1), "aad").ok());
+  EXPECT_THAT(aead->Decrypt(ct.substr(0, 27), "aad").status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+// Test vectors from RFC 8452, Appendix C, given as nonce || result.
+TEST(AesGcmSivAesniTest, TestVectors) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  struct TestVector {
+    std::string key;
+    std::string plaintext;
+    std::string ciphertext;
+  };
+  const std::string nonce = "030000000000000000000000";
+  const std::vector<TestVector> vectors = {
+      {"01000000000000000000000000000000", "",
+       nonce + "dc20e2d83f25705bb49e439eca56de25"},
+      {"01000000000000000000000000000000", "0100000000000000",
+       nonce + "b5d839330ac7b786578782fff6013b815b287c22493a364c"},
+      {"01000000000000000000000000000000", "010000000000000000000000",
+       nonce + "7323ea61d05932260047d942a4978db357391a0bc4fdec8b0d106639"},
+      {"01000000000000000000000000000000", "01000000000000000000000000000000",
+       nonce + "743f7c8077ab25f8624e2e948579cf77"
+               "303aaf90f6fe21199c6068577437a0c4"},
+      {"01000000000000000000000000000000"
+       "00000000000000000000000000000000",
+       "", nonce + "07f5f4169bbf55a8400cd47ea6fd400f"},
+      {"01000000000000000000000000000000"
+       "00000000000000000000000000000000",
+       "0100000000000000",
+       nonce + "c2ef328e5c71c83b843122130f7364b761e0b97427e3df28"},
+  };
+  for (const TestVector& vector : vectors) {
+    auto aead_or = AesGcmSivAesni::New(
+        util::SecretDataFromStringView(test::HexDecodeOrDie(vector.key)));
+    ASSERT_THAT(aead_or.status(), IsOk());
+    auto pt = aead_or.ValueOrDie()->Decrypt(
+        test::HexDecodeOrDie(vector.ciphertext), "");
+    ASSERT_THAT(pt.status(), IsOk()) << vector.ciphertext;
+    EXPECT_EQ(test::HexEncode(pt.ValueOrDie()), vector.plaintext);
+  }
+}
+
+TEST(DeterministicAesGcmSivAesniTest, InvalidKeySizes) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  for (int key_size : {0, 15, 17, 24, 31, 33, 64}) {
+    util::SecretData key(key_size, 'x');
+    EXPECT_THAT(DeterministicAesGcmSivAesni::New(key).status(),
+                StatusIs(util::error::INVALID_ARGUMENT))
+        << key_size;
+  }
+}
+
+// The ciphertexts are those of AES-GCM-SIV with the zero nonce.
+TEST(DeterministicAesGcmSivAesniTest, IsAesGcmSivWithZeroNonce) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  const std::string zero_nonce(12, '\0');
+  for (int key_size : {16, 32}) {
+    util::SecretData key = Random::GetRandomKeyBytes(key_size);
+    auto daead = std::move(DeterministicAesGcmSivAesni::New(key).ValueOrDie());
+    auto aead = std::move(AesGcmSivAesni::New(key).ValueOrDie());
+    for (int msg_size : {0, 1, 16, 17, 128, 129, 1000}) {
+      for (int aad_size : {0, 1, 17, 200}) {
+        std::string msg = Random::GetRandomBytes(msg_size);
+        std::string aad = Random::GetRandomBytes(aad_size);
+        auto ct = daead->EncryptDeterministically(msg, aad);
+        ASSERT_THAT(ct.status(), IsOk());
+        EXPECT_EQ(ct.ValueOrDie().size(),
+                  daead->CiphertextSize(msg_size).ValueOrDie());
+        EXPECT_EQ(ct.ValueOrDie(),
+                  daead->EncryptDeterministically(msg, aad).ValueOrDie());
+        auto pt = aead->Decrypt(zero_nonce + ct.ValueOrDie(), aad);
+        ASSERT_THAT(pt.status(), IsOk()) << msg_size << " " << aad_size;
+        EXPECT_EQ(pt.ValueOrDie(), msg);
+        pt = daead->DecryptDeterministically(ct.ValueOrDie(), aad);
+        ASSERT_THAT(pt.status(), IsOk()) << msg_size << " " << aad_size;
+        EXPECT_EQ(pt.ValueOrDie(), msg);
+      }
+    }
+  }
+}
+
+TEST(DeterministicAesGcmSivAesniTest, EncryptBatch) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto daead = std::move(
+      DeterministicAesGcmSivAesni::New(Random::GetRandomKeyBytes(16))
+          .ValueOrDie());
+  std::string aad = Random::GetRandomBytes(33);
+  std::string data;
+  std::vector<int64_t> offsets = {0};
+  for (int i = 0; i < 5; i++) {
+    data += Random::GetRandomBytes(i * 61);
+    offsets.push_back(data.size());
+  }
+  std::string ciphertext_data;
+  std::vector<int64_t> ciphertext_offsets;
+  ASSERT_THAT(daead->EncryptDeterministicallyBatch(
+                  offsets, data, aad, &ciphertext_data, &ciphertext_offsets),
+              IsOk());
+  ASSERT_EQ(ciphertext_offsets.size(), offsets.size());
+  for (size_t i = 0; i + 1 < offsets.size(); i++) {
+    std::string msg =
+        data.substr(offsets[i], offsets[i + 1] - offsets[i]);
+    EXPECT_EQ(ciphertext_data.substr(
+                  ciphertext_offsets[i],
+                  ciphertext_offsets[i + 1] - ciphertext_offsets[i]),
+              daead->EncryptDeterministically(msg, aad).ValueOrDie())
+        << i;
+  }
+}
+
+TEST(DeterministicAesGcmSivAesniTest, ModifiedCiphertext) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto daead = std::move(
+      DeterministicAesGcmSivAesni::New(Random::GetRandomKeyBytes(32))
+          .ValueOrDie());
+  std::string ct =
+      daead->EncryptDeterministically("some message", "aad").ValueOrDie();
+  for (size_t i = 0; i < ct.size(); i++) {
+    std::string modified = ct;
+    modified[i] ^= 0x01;
+    EXPECT_FALSE(daead->DecryptDeterministically(modified, "aad").ok()) << i;
+  }
+  EXPECT_FALSE(daead->DecryptDeterministically(ct, "aae").ok());
+  EXPECT_THAT(daead->DecryptDeterministically(ct.substr(0, 15), "aad").status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // defined(__SSE4_1__) && defined(__AES__) && defined(__PCLMUL__)
@@ -41,13 +41,9 @@ const EVP_AEAD* GetCipherForKeySize(int size_in_bytes) {
       return nullptr;
   }
 }
-}  // namespace
 
-util::StatusOr<std::unique_ptr<Aead>> AesGcmSivBoringSsl::New(
+util::StatusOr<bssl::UniquePtr<EVP_AEAD_CTX>> NewContext(
     const util::SecretData& key) {
-  auto status = CheckFipsCompatibility<AesGcmSivBoringSsl>();
-  if (!status.ok()) return status;
-
   const EVP_AEAD* aead = GetCipherForKeySize(key.size());
   if (aead == nullptr) {
     return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
@@ -58,43 +54,105 @@ util::StatusOr<std::unique_ptr<Aead>> AesGcmSivBoringSsl::New(
     return util::Status(util::error::INTERNAL,
                         "could not initialize EVP_AEAD_CTX");
   }
-  return {absl::WrapUnique(new AesGcmSivBoringSsl(std::move(ctx)))};
+  return std::move(ctx);
+}
+
+// The nonce of DeterministicAesGcmSivBoringSsl.
+constexpr uint8_t kZeroNonce[12] = {0};
+}  // namespace
+
+util::StatusOr<std::unique_ptr<Aead>> AesGcmSivBoringSsl::New(
+    const util::SecretData& key) {
+  auto status = CheckFipsCompatibility<AesGcmSivBoringSsl>();
+  if (!status.ok()) return status;
+
+  auto ctx_or = NewContext(key);
+  if (!ctx_or.ok()) return ctx_or.status();
+  return {absl::WrapUnique(
+      new AesGcmSivBoringSsl(std::move(ctx_or.ValueOrDie())))};
 }
 
 util::StatusOr<std::string> AesGcmSivBoringSsl::Encrypt(
     absl::string_view plaintext, absl::string_view additional_data) const {
-  std::string ciphertext = Random::GetRandomBytes(kIvSizeInBytes);
+  std::string ciphertext;
   ResizeStringUninitialized(
       &ciphertext, kIvSizeInBytes + plaintext.size() + kTagSizeInBytes);
+  auto written_or =
+      EncryptInto(plaintext, additional_data,
+                  absl::MakeSpan(&ciphertext[0], ciphertext.size()));
+  if (!written_or.ok()) return written_or.status();
+  return ciphertext;
+}
+
+util::StatusOr<std::string> AesGcmSivBoringSsl::Decrypt(
+    absl::string_view ciphertext, absl::string_view additional_data) const {
+  if (ciphertext.size() < kIvSizeInBytes + kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+
+  std::string plaintext;
+  ResizeStringUninitialized(
+      &plaintext, ciphertext.size() - kIvSizeInBytes - kTagSizeInBytes);
+  auto written_or = DecryptInto(
+      ciphertext, additional_data,
+      absl::MakeSpan(&plaintext[0], plaintext.size()));
+  if (!written_or.ok()) return written_or.status();
+  return plaintext;
+}
+
+util::StatusOr<int64_t> AesGcmSivBoringSsl::CiphertextSize(
+    int64_t plaintext_size) const {
+  if (plaintext_size < 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Plaintext size must be non-negative");
+  }
+  return kIvSizeInBytes + plaintext_size + kTagSizeInBytes;
+}
+
+util::StatusOr<int64_t> AesGcmSivBoringSsl::EncryptInto(
+    absl::string_view plaintext, absl::string_view additional_data,
+    absl::Span<char> ciphertext_buffer) const {
+  const size_t ciphertext_size =
+      kIvSizeInBytes + plaintext.size() + kTagSizeInBytes;
+  if (ciphertext_buffer.size() < ciphertext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Ciphertext buffer too small");
+  }
+  uint8_t* iv = reinterpret_cast<uint8_t*>(ciphertext_buffer.data());
+  auto status =
+      Random::GetRandomBytes(ciphertext_buffer.subspan(0, kIvSizeInBytes));
+  if (!status.ok()) return status;
   size_t len;
   if (EVP_AEAD_CTX_seal(
-          ctx_.get(), reinterpret_cast<uint8_t*>(&ciphertext[kIvSizeInBytes]),
-          &len, ciphertext.size() - kIvSizeInBytes,
-          reinterpret_cast<const uint8_t*>(&ciphertext[0]), kIvSizeInBytes,
+          ctx_.get(), iv + kIvSizeInBytes, &len,
+          ciphertext_size - kIvSizeInBytes, iv, kIvSizeInBytes,
           reinterpret_cast<const uint8_t*>(plaintext.data()), plaintext.size(),
           reinterpret_cast<const uint8_t*>(additional_data.data()),
           additional_data.size()) != 1) {
     return util::Status(util::error::INTERNAL, "Encryption failed");
   }
-  if (len != ciphertext.size() - kIvSizeInBytes) {
+  if (len != ciphertext_size - kIvSizeInBytes) {
     return util::Status(util::error::INTERNAL, "incorrect ciphertext size");
   }
-  return ciphertext;
+  return ciphertext_size;
 }
 
-util::StatusOr<std::string> AesGcmSivBoringSsl::Decrypt(
-    absl::string_view ciphertext, absl::string_view additional_data) const {
+util::StatusOr<int64_t> AesGcmSivBoringSsl::DecryptInto(
+    absl::string_view ciphertext, absl::string_view additional_data,
+    absl::Span<char> plaintext_buffer) const {
   if (ciphertext.size() < kIvSizeInBytes + kTagSizeInBytes) {
     return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
   }
-
-  std::string plaintext;
-  ResizeStringUninitialized(
-      &plaintext, ciphertext.size() - kIvSizeInBytes - kTagSizeInBytes);
+  const size_t plaintext_size =
+      ciphertext.size() - kIvSizeInBytes - kTagSizeInBytes;
+  if (plaintext_buffer.size() < plaintext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Plaintext buffer too small");
+  }
   size_t len;
   if (EVP_AEAD_CTX_open(
-          ctx_.get(), reinterpret_cast<uint8_t*>(&plaintext[0]), &len,
-          plaintext.size(),
+          ctx_.get(), reinterpret_cast<uint8_t*>(plaintext_buffer.data()), &len,
+          plaintext_size,
           // The nonce is the first |kIvSizeInBytes| bytes of |ciphertext|.
           reinterpret_cast<const uint8_t*>(ciphertext.data()), kIvSizeInBytes,
           // The input is the remainder.
@@ -104,6 +162,63 @@ util::StatusOr<std::string> AesGcmSivBoringSsl::Decrypt(
           additional_data.size()) != 1) {
     return util::Status(util::error::INTERNAL, "Authentication failed");
   }
+  if (len != plaintext_size) {
+    return util::Status(util::error::INTERNAL, "incorrect ciphertext size");
+  }
+  return len;
+}
+
+// static
+util::StatusOr<std::unique_ptr<DeterministicAead>>
+DeterministicAesGcmSivBoringSsl::New(const util::SecretData& key) {
+  auto status = CheckFipsCompatibility<DeterministicAesGcmSivBoringSsl>();
+  if (!status.ok()) return status;
+
+  auto ctx_or = NewContext(key);
+  if (!ctx_or.ok()) return ctx_or.status();
+  return {absl::WrapUnique(
+      new DeterministicAesGcmSivBoringSsl(std::move(ctx_or.ValueOrDie())))};
+}
+
+util::StatusOr<std::string>
+DeterministicAesGcmSivBoringSsl::EncryptDeterministically(
+    absl::string_view plaintext, absl::string_view associated_data) const {
+  std::string ciphertext;
+  ResizeStringUninitialized(&ciphertext, plaintext.size() + kTagSizeInBytes);
+  size_t len;
+  if (EVP_AEAD_CTX_seal(
+          ctx_.get(), reinterpret_cast<uint8_t*>(&ciphertext[0]), &len,
+          ciphertext.size(), kZeroNonce, kNonceSizeInBytes,
+          reinterpret_cast<const uint8_t*>(plaintext.data()), plaintext.size(),
+          reinterpret_cast<const uint8_t*>(associated_data.data()),
+          associated_data.size()) != 1) {
+    return util::Status(util::error::INTERNAL, "Encryption failed");
+  }
+  if (len != ciphertext.size()) {
+    return util::Status(util::error::INTERNAL, "incorrect ciphertext size");
+  }
+  return ciphertext;
+}
+
+util::StatusOr<std::string>
+DeterministicAesGcmSivBoringSsl::DecryptDeterministically(
+    absl::string_view ciphertext, absl::string_view associated_data) const {
+  if (ciphertext.size() < kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  std::string plaintext;
+  ResizeStringUninitialized(&plaintext, ciphertext.size() - kTagSizeInBytes);
+  size_t len;
+  if (EVP_AEAD_CTX_open(
+          ctx_.get(), reinterpret_cast<uint8_t*>(&plaintext[0]), &len,
+          plaintext.size(), kZeroNonce, kNonceSizeInBytes,
+          reinterpret_cast<const uint8_t*>(ciphertext.data()),
+          ciphertext.size(),
+          reinterpret_cast<const uint8_t*>(associated_data.data()),
+          associated_data.size()) != 1) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Authentication failed");
+  }
   if (len != plaintext.size()) {
     return util::Status(util::error::INTERNAL, "incorrect ciphertext size");
   }
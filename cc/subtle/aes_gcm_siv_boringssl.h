@@ -18,12 +18,16 @@
 #define TINK_SUBTLE_AES_GCM_SIV_BORINGSSL_H_
 
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/aead.h"
 #include "tink/aead.h"
 #include "tink/config/tink_fips.h"
+#include "tink/deterministic_aead.h"
+#include "tink/space_used.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/statusor.h"
 
@@ -48,7 +52,7 @@ namespace subtle {
 // https://cyber.biu.ac.il/aes-gcm-siv/
 // or Section 6.3 of this paper:
 // https://eprint.iacr.org/2017/702.pdf
-class AesGcmSivBoringSsl : public Aead {
+class AesGcmSivBoringSsl : public Aead, public SpaceUsedInterface {
  public:
   static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
       const util::SecretData& key);
@@ -61,6 +65,21 @@ class AesGcmSivBoringSsl : public Aead {
       absl::string_view ciphertext,
       absl::string_view additional_data) const override;
 
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override;
+
+  crypto::tink::util::StatusOr<int64_t> EncryptInto(
+      absl::string_view plaintext, absl::string_view additional_data,
+      absl::Span<char> ciphertext_buffer) const override;
+
+  crypto::tink::util::StatusOr<int64_t> DecryptInto(
+      absl::string_view ciphertext, absl::string_view additional_data,
+      absl::Span<char> plaintext_buffer) const override;
+
+  size_t SpaceUsed() const override {
+    return sizeof(*this) + sizeof(EVP_AEAD_CTX);
+  }
+
   static constexpr crypto::tink::FipsCompatibility kFipsStatus =
       crypto::tink::FipsCompatibility::kNotFips;
 
@@ -74,6 +93,45 @@ class AesGcmSivBoringSsl : public Aead {
   bssl::UniquePtr<EVP_AEAD_CTX> ctx_;
 };
 
+// AES-GCM-SIV with the all-zero nonce as a DeterministicAead. The
+// ciphertext is that of AesGcmSivBoringSsl for the zero nonce without the
+// nonce, i.e. the encrypted plaintext followed by the 16 byte tag.
+class DeterministicAesGcmSivBoringSsl : public DeterministicAead,
+                                        public SpaceUsedInterface {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<DeterministicAead>> New(
+      const util::SecretData& key);
+
+  crypto::tink::util::StatusOr<std::string> EncryptDeterministically(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override {
+    return plaintext_size + kTagSizeInBytes;
+  }
+
+  size_t SpaceUsed() const override {
+    return sizeof(*this) + sizeof(EVP_AEAD_CTX);
+  }
+
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kNotFips;
+
+ private:
+  static constexpr int kNonceSizeInBytes = 12;
+  static constexpr int kTagSizeInBytes = 16;
+
+  explicit DeterministicAesGcmSivBoringSsl(bssl::UniquePtr<EVP_AEAD_CTX> ctx)
+      : ctx_(std::move(ctx)) {}
+
+  bssl::UniquePtr<EVP_AEAD_CTX> ctx_;
+};
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
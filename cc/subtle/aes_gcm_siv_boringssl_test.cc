@@ -23,6 +23,7 @@
 #include "absl/strings/str_cat.h"
 #include "openssl/err.h"
 #include "include/rapidjson/document.h"
+#include "tink/subtle/random.h"
 #include "tink/subtle/wycheproof_util.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/status.h"
@@ -61,6 +62,53 @@ TEST(AesGcmSivBoringSslTest, Basic) {
   EXPECT_EQ(pt.ValueOrDie(), message);
 }
 
+TEST(AesGcmSivBoringSslTest, EncryptIntoDecryptInto) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::SecretData key =
+      util::SecretDataFromStringView(test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
+  auto cipher_or = AesGcmSivBoringSsl::New(key);
+  ASSERT_TRUE(cipher_or.ok()) << cipher_or.status();
+  auto cipher = std::move(cipher_or.ValueOrDie());
+  std::string message = "Some data to encrypt.";
+  std::string aad = "Some data to authenticate.";
+
+  auto ciphertext_size_or = cipher->CiphertextSize(message.size());
+  ASSERT_TRUE(ciphertext_size_or.ok()) << ciphertext_size_or.status();
+  EXPECT_EQ(ciphertext_size_or.ValueOrDie(), message.size() + 12 + 16);
+  std::string ciphertext(ciphertext_size_or.ValueOrDie(), '\0');
+  auto written_or = cipher->EncryptInto(
+      message, aad, absl::MakeSpan(&ciphertext[0], ciphertext.size()));
+  ASSERT_TRUE(written_or.ok()) << written_or.status();
+  EXPECT_EQ(written_or.ValueOrDie(), ciphertext.size());
+
+  // Both decryption entry points accept the ciphertext.
+  auto pt = cipher->Decrypt(ciphertext, aad);
+  ASSERT_TRUE(pt.ok()) << pt.status();
+  EXPECT_EQ(pt.ValueOrDie(), message);
+  std::string plaintext(message.size(), '\0');
+  written_or = cipher->DecryptInto(
+      ciphertext, aad, absl::MakeSpan(&plaintext[0], plaintext.size()));
+  ASSERT_TRUE(written_or.ok()) << written_or.status();
+  EXPECT_EQ(written_or.ValueOrDie(), message.size());
+  EXPECT_EQ(plaintext, message);
+
+  // Buffers that are too small are rejected.
+  EXPECT_THAT(cipher
+                  ->EncryptInto(message, aad,
+                                absl::MakeSpan(&ciphertext[0],
+                                               ciphertext.size() - 1))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(cipher
+                  ->DecryptInto(ciphertext, aad,
+                                absl::MakeSpan(&plaintext[0],
+                                               plaintext.size() - 1))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 TEST(AesGcmSivBoringSslTest, Sizes) {
   if (kUseOnlyFips) {
     GTEST_SKIP() << "Not supported in FIPS-only mode";
@@ -320,6 +368,50 @@ TEST(AesGcmSivBoringSslTest, TestFipsOnly) {
               StatusIs(util::error::INTERNAL));
 }
 
+TEST(DeterministicAesGcmSivBoringSslTest, IsAesGcmSivWithZeroNonce) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  for (int key_size : {16, 32}) {
+    util::SecretData key = Random::GetRandomKeyBytes(key_size);
+    auto daead =
+        std::move(DeterministicAesGcmSivBoringSsl::New(key).ValueOrDie());
+    auto aead = std::move(AesGcmSivBoringSsl::New(key).ValueOrDie());
+    std::string message = "Some data to encrypt.";
+    std::string aad = "Some data to authenticate.";
+    auto ct = daead->EncryptDeterministically(message, aad);
+    ASSERT_TRUE(ct.ok()) << ct.status();
+    EXPECT_EQ(ct.ValueOrDie().size(), message.size() + 16);
+    EXPECT_EQ(ct.ValueOrDie(),
+              daead->EncryptDeterministically(message, aad).ValueOrDie());
+    auto pt = aead->Decrypt(std::string(12, '\0') + ct.ValueOrDie(), aad);
+    ASSERT_TRUE(pt.ok()) << pt.status();
+    EXPECT_EQ(pt.ValueOrDie(), message);
+    pt = daead->DecryptDeterministically(ct.ValueOrDie(), aad);
+    ASSERT_TRUE(pt.ok()) << pt.status();
+    EXPECT_EQ(pt.ValueOrDie(), message);
+
+    std::string modified = ct.ValueOrDie();
+    modified[0] ^= 0x01;
+    EXPECT_FALSE(daead->DecryptDeterministically(modified, aad).ok());
+    EXPECT_THAT(daead->DecryptDeterministically(modified.substr(0, 15), aad)
+                    .status(),
+                StatusIs(util::error::INVALID_ARGUMENT));
+  }
+}
+
+TEST(DeterministicAesGcmSivBoringSslTest, InvalidKeySizes) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  for (int key_size : {0, 15, 17, 24, 31, 33, 64}) {
+    util::SecretData key(key_size, 'x');
+    EXPECT_THAT(DeterministicAesGcmSivBoringSsl::New(key).status(),
+                StatusIs(util::error::INVALID_ARGUMENT))
+        << key_size;
+  }
+}
+
 }  // namespace
 }  // namespace subtle
 }  // namespace tink
@@ -0,0 +1,694 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef __SSE4_1__
+#ifdef __AES__
+
+#include "tink/subtle/aes_siv_aesni.h"
+
+#include <emmintrin.h>  // SSE2: used for _mm_sub_epi64 _mm_unpacklo_epi64 etc.
+#include <smmintrin.h>  // SSE4: used for _mm_cmpeq_epi64
+#include <tmmintrin.h>  // SSE3: used for _mm_shuffle_epi8
+#include <wmmintrin.h>  // AES_NI instructions.
+#include <xmmintrin.h>  // Datatype _mm128i
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "tink/util/errors.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+using RoundKeys = AesSivAesni::RoundKeys;
+
+// Number of counter blocks encrypted together in CTR mode.
+constexpr int kCtrLanes = 8;
+// Number of counter blocks encrypted together with the CMAC blocks while
+// decrypting. The CMACs only advance by one block per AES invocation, so
+// the CTR decryption is spread over several invocations.
+constexpr int kInterleavedCtrLanes = 4;
+// Number of values whose CMACs are computed together when encrypting a
+// batch.
+constexpr int kCellLanes = 4;
+constexpr size_t kBlockSize = 16;
+
+inline bool EqualBlocks(__m128i x, __m128i y) {
+  // Compare byte wise.
+  // A byte in eq is 0xff if the corresponding byte in x and y are equal
+  // and 0x00 if the corresponding byte in x and y are not equal.
+  __m128i eq = _mm_cmpeq_epi8(x, y);
+  // Extract the 16 most significant bits of each byte in eq.
+  int bits = _mm_movemask_epi8(eq);
+  return 0xFFFF == bits;
+}
+
+// Reverse the order of the bytes in x.
+inline __m128i Reverse(__m128i x) {
+  const __m128i reverse_order =
+      _mm_set_epi32(0x00010203, 0x04050607, 0x08090a0b, 0x0c0d0e0f);
+  return _mm_shuffle_epi8(x, reverse_order);
+}
+
+// Increment x by 1.
+// This function assumes that the bytes of x are in little endian order.
+// Hence before using the result as a counter block the bytes must be
+// reversed, since SIV uses counter values in big endian order.
+inline __m128i Increment(__m128i x) {
+  const __m128i mask =
+      _mm_set_epi32(0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff);
+  // Determine which of the two 64-bit parts of x overflow.
+  __m128i carries = _mm_cmpeq_epi64(x, mask);  // SSE4
+  // Move the least significant 64 carry bits into the most significant 64 bits
+  // of diff and fill the least significant bits of diff with 0xff..ff.
+  __m128i diff = _mm_unpacklo_epi64(mask, carries);
+  // Use subtraction since the 64-bit parts that must be incremented contain
+  // the value -1.
+  return _mm_sub_epi64(x, diff);
+}
+
+// Rotate a value by 32 bit to the left (assuming little endian order).
+inline __m128i RotLeft32(__m128i value) {
+  return _mm_shuffle_epi32(value, _MM_SHUFFLE(2, 1, 0, 3));
+}
+
+// Multiply a binary polynomial given in big endian order by x
+// and reduce modulo x^128 + x^7 + x^2 + x + 1
+inline __m128i MultiplyByX(__m128i value) {
+  value = Reverse(value);
+  // Sets each dword to 0xffffffff if the most significant bit of the same
+  // dword in value is set.
+  __m128i msb = _mm_srai_epi32(value, 31);
+  __m128i msb_rotated = RotLeft32(msb);
+  // If the most significant bit in value is set, then this bit is reduced
+  // to x^7 + x^2 + x + 1 (which corresponds to the constant 0x87).
+  __m128i carry = _mm_and_si128(msb_rotated, _mm_set_epi32(1, 1, 1, 0x87));
+  __m128i res = _mm_xor_si128(_mm_slli_epi32(value, 1), carry);
+  return Reverse(res);
+}
+
+inline __m128i LoadBlock(const uint8_t* block) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+}
+
+inline void StoreBlock(uint8_t* block, __m128i value) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(block), value);
+}
+
+// Load block[0]..block[block_size-1] into the least significant bytes of
+// a register, followed by the padding byte 0x80 if block_size < 16 and
+// zeros. The efficiency of this function is not critical.
+__m128i LoadPaddedBlock(const uint8_t* block, size_t block_size) {
+  std::array<uint8_t, 16> tmp;
+  tmp.fill(0);
+  std::copy_n(block, block_size, tmp.begin());
+  if (block_size < tmp.size()) tmp[block_size] = 0x80;
+  return LoadBlock(tmp.data());
+}
+
+// Sets out[i] = in[i] XOR key_stream[i] for i = 0 .. size - 1.
+// The efficiency of this function for partial blocks is not critical.
+void XorKeyStream(const __m128i* key_stream, const uint8_t* in, size_t size,
+                  uint8_t* out) {
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    StoreBlock(out + i,
+               _mm_xor_si128(LoadBlock(in + i), key_stream[i / 16]));
+  }
+  if (i < size) {
+    std::array<uint8_t, 16> tmp;
+    StoreBlock(tmp.data(), key_stream[i / 16]);
+    for (size_t j = 0; i + j < size; j++) {
+      out[i + j] = in[i + j] ^ tmp[j];
+    }
+  }
+}
+
+static const uint8_t kRoundConstant[11] =
+    {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36};
+
+// Call the AESKEYGENASSIST operation on a 32-bit input.
+// This performs a rotation and a substitution with an S-box.
+inline uint32_t SubRot(uint32_t tmp) {
+  __m128i inp = _mm_set_epi32(0, 0, tmp, 0);
+  __m128i out = _mm_aeskeygenassist_si128(inp, 0x00);
+  return _mm_extract_epi32(out, 1);
+}
+
+// Apply the S-box to the 4 bytes in a word.
+inline uint32_t SubWord(uint32_t tmp) {
+  __m128i inp = _mm_set_epi32(0, 0, tmp, 0);
+  __m128i out = _mm_aeskeygenassist_si128(inp, 0x00);
+  return _mm_extract_epi32(out, 0);
+}
+
+// Key expansion for 256-bit keys as in FIPS 197.
+void Aes256KeyExpansion(const uint8_t* key, __m128i* round_key) {
+  const int Nk = 8;  // Number of words in the key
+  const int Nb = 4;  // Number of words per round key
+  const int Nr = AesSivAesni::kRounds;
+  uint32_t* w = reinterpret_cast<uint32_t*>(round_key);
+  const uint32_t* keywords = reinterpret_cast<const uint32_t*>(key);
+  for (int i = 0; i < Nk; i++) {
+    w[i] = keywords[i];
+  }
+  uint32_t tmp = w[Nk - 1];
+  for (int i = Nk; i < Nb * (Nr + 1); i++) {
+    if (i % Nk == 0) {
+      tmp = SubRot(tmp) ^ kRoundConstant[i / Nk];
+    } else if (i % 4 == 0) {
+      tmp = SubWord(tmp);
+    }
+    tmp ^= w[i - Nk];
+    w[i] = tmp;
+  }
+}
+
+// Applies one step of AES to the blocks b[0] .. b[N - 1]. The recursion
+// unrolls the loop over the blocks, which lets the compiler keep them in
+// registers; compilers do not reliably unroll such loops by themselves.
+template <int N>
+struct Lanes {
+  static inline void Xor(__m128i* b, __m128i round_key) {
+    Lanes<N - 1>::Xor(b, round_key);
+    b[N - 1] = _mm_xor_si128(b[N - 1], round_key);
+  }
+  static inline void Round(__m128i* b, __m128i round_key) {
+    Lanes<N - 1>::Round(b, round_key);
+    b[N - 1] = _mm_aesenc_si128(b[N - 1], round_key);
+  }
+  static inline void LastRound(__m128i* b, __m128i round_key) {
+    Lanes<N - 1>::LastRound(b, round_key);
+    b[N - 1] = _mm_aesenclast_si128(b[N - 1], round_key);
+  }
+  static inline void Copy(const __m128i* from, __m128i* to) {
+    Lanes<N - 1>::Copy(from, to);
+    to[N - 1] = from[N - 1];
+  }
+};
+
+template <>
+struct Lanes<0> {
+  static inline void Xor(__m128i* b, __m128i round_key) {}
+  static inline void Round(__m128i* b, __m128i round_key) {}
+  static inline void LastRound(__m128i* b, __m128i round_key) {}
+  static inline void Copy(const __m128i* from, __m128i* to) {}
+};
+
+// Encrypts the blocks mac[0] .. mac[kMac - 1] with mac_key and the blocks
+// ctr[0] .. ctr[kCtr - 1] with ctr_key in place. The rounds of all blocks
+// are interleaved, so that they are processed in parallel by the pipelined
+// AES units of the CPU.
+template <int kMac, int kCtr>
+inline void AesRounds(const RoundKeys& mac_key, __m128i* mac,
+                      const RoundKeys& ctr_key, __m128i* ctr) {
+  // Local copies, which cannot alias the round keys.
+  __m128i m[kMac > 0 ? kMac : 1];
+  __m128i c[kCtr > 0 ? kCtr : 1];
+  Lanes<kMac>::Copy(mac, m);
+  Lanes<kCtr>::Copy(ctr, c);
+  Lanes<kMac>::Xor(m, mac_key[0]);
+  Lanes<kCtr>::Xor(c, ctr_key[0]);
+  for (int i = 1; i < AesSivAesni::kRounds; i++) {
+    Lanes<kMac>::Round(m, mac_key[i]);
+    Lanes<kCtr>::Round(c, ctr_key[i]);
+  }
+  Lanes<kMac>::LastRound(m, mac_key[AesSivAesni::kRounds]);
+  Lanes<kCtr>::LastRound(c, ctr_key[AesSivAesni::kRounds]);
+  Lanes<kMac>::Copy(m, mac);
+  Lanes<kCtr>::Copy(c, ctr);
+}
+
+inline __m128i EncryptBlock(const RoundKeys& key, __m128i block) {
+  AesRounds<1, 0>(key, &block, key, nullptr);
+  return block;
+}
+
+// Dispatches to AesRounds for 0 .. 2 CMAC blocks and either no or
+// kInterleavedCtrLanes counter blocks.
+void InterleavedAesRounds(const RoundKeys& mac_key, __m128i* mac,
+                          int mac_lanes, const RoundKeys& ctr_key,
+                          __m128i* ctr, int ctr_lanes) {
+  if (ctr_lanes == 0) {
+    if (mac_lanes == 1) {
+      AesRounds<1, 0>(mac_key, mac, ctr_key, ctr);
+    } else {
+      AesRounds<2, 0>(mac_key, mac, ctr_key, ctr);
+    }
+    return;
+  }
+  switch (mac_lanes) {
+    case 0:
+      AesRounds<0, kInterleavedCtrLanes>(mac_key, mac, ctr_key, ctr);
+      break;
+    case 1:
+      AesRounds<1, kInterleavedCtrLanes>(mac_key, mac, ctr_key, ctr);
+      break;
+    default:
+      AesRounds<2, kInterleavedCtrLanes>(mac_key, mac, ctr_key, ctr);
+      break;
+  }
+}
+
+// Converts a synthetic IV into the initial counter block in little endian
+// order, clearing the bits 31 and 63 as required by RFC 5297.
+inline __m128i InitialCounter(__m128i siv) {
+  const __m128i mask = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 0x7f, -1,
+                                     -1, -1, 0x7f, -1, -1, -1);
+  return Reverse(_mm_and_si128(siv, mask));
+}
+
+// Returns the number of leading blocks of a message of 'msg_size' bytes
+// which enter the S2V CMAC unmodified, i.e. the blocks before the last 16
+// bytes of the message, into which S2V XORs the CMAC of the additional data.
+inline size_t FreeBlocks(size_t msg_size) {
+  return msg_size < kBlockSize ? 0 : (msg_size - kBlockSize) / kBlockSize;
+}
+
+// S2V computes CMAC(msg xorend t) if msg is at least 16 bytes long, and
+// CMAC(dbl(t) XOR pad(msg)) otherwise. Writes the blocks of this CMAC
+// input which follow the FreeBlocks(msg_size) free blocks to 'tail', with
+// the CMAC subkey k1 or k2 already XORed into the last one, and returns
+// their number (1 or 2). The CMAC is then the CBC-MAC of the free blocks
+// followed by the tail blocks.
+int CmacTail(__m128i t, const uint8_t* msg, size_t msg_size, __m128i k1,
+             __m128i k2, uint8_t* tail) {
+  if (msg_size < kBlockSize) {
+    __m128i block = _mm_xor_si128(MultiplyByX(t),
+                                  LoadPaddedBlock(msg, msg_size));
+    StoreBlock(tail, _mm_xor_si128(block, k1));
+    return 1;
+  }
+  size_t tail_size = msg_size - FreeBlocks(msg_size) * kBlockSize;
+  std::copy_n(msg + msg_size - tail_size, tail_size, tail);
+  uint8_t* last = tail + tail_size - kBlockSize;
+  StoreBlock(last, _mm_xor_si128(LoadBlock(last), t));
+  if (tail_size == kBlockSize) {
+    StoreBlock(tail, _mm_xor_si128(LoadBlock(tail), k1));
+    return 1;
+  }
+  // Here tail_size is 16 + msg_size % 16.
+  __m128i block = LoadPaddedBlock(tail + kBlockSize, msg_size % kBlockSize);
+  StoreBlock(tail + kBlockSize, _mm_xor_si128(block, k2));
+  return 2;
+}
+
+// The S2V CMAC of one value of a batch in progress.
+struct CellLane {
+  size_t cell;
+  const uint8_t* msg;
+  size_t free_blocks;
+  size_t blocks;
+  size_t next_block;
+  std::array<uint8_t, 2 * kBlockSize> tail;
+  __m128i state;
+
+  __m128i NextBlock() const {
+    return next_block < free_blocks
+               ? LoadBlock(msg + next_block * kBlockSize)
+               : LoadBlock(tail.data() + (next_block - free_blocks) * kBlockSize);
+  }
+};
+
+// Advances the CMACs of lanes[0] .. lanes[N - 1] by 'steps' blocks each.
+template <int N>
+void ChainCells(const RoundKeys& mac_key, CellLane* lanes, size_t steps) {
+  __m128i state[N];
+  for (int j = 0; j < N; j++) state[j] = lanes[j].state;
+  for (size_t step = 0; step < steps; step++) {
+    for (int j = 0; j < N; j++) {
+      state[j] = _mm_xor_si128(state[j], lanes[j].NextBlock());
+      lanes[j].next_block++;
+    }
+    AesRounds<N, 0>(mac_key, state, mac_key, nullptr);
+  }
+  for (int j = 0; j < N; j++) lanes[j].state = state[j];
+}
+
+// Dispatches to ChainCells for 1 .. kCellLanes lanes.
+void ChainCells(const RoundKeys& mac_key, CellLane* lanes, int active_lanes,
+                size_t steps) {
+  static_assert(kCellLanes == 4, "Update the cases below");
+  switch (active_lanes) {
+    case 1:
+      ChainCells<1>(mac_key, lanes, steps);
+      break;
+    case 2:
+      ChainCells<2>(mac_key, lanes, steps);
+      break;
+    case 3:
+      ChainCells<3>(mac_key, lanes, steps);
+      break;
+    default:
+      ChainCells<4>(mac_key, lanes, steps);
+      break;
+  }
+}
+
+}  // namespace
+
+// static
+crypto::tink::util::StatusOr<std::unique_ptr<DeterministicAead>>
+AesSivAesni::New(const util::SecretData& key) {
+  auto status = CheckFipsCompatibility<AesSivAesni>();
+  if (!status.ok()) return status;
+
+  if (!IsValidKeySizeInBytes(key.size())) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
+  }
+  auto siv = absl::WrapUnique(new AesSivAesni());
+  siv->SetKey(key);
+  return {std::move(siv)};
+}
+
+void AesSivAesni::SetKey(const util::SecretData& key) {
+  Aes256KeyExpansion(key.data(), mac_key_->data());
+  Aes256KeyExpansion(key.data() + key.size() / 2, ctr_key_->data());
+  // The CMAC subkeys, and S2V's initial value dbl(CMAC(0^128)), where
+  // CMAC(0^128) = E(0^128 ^ K1).
+  *cmac_k1_ = MultiplyByX(EncryptBlock(*mac_key_, _mm_setzero_si128()));
+  *cmac_k2_ = MultiplyByX(*cmac_k1_);
+  *s2v_zero_ = MultiplyByX(EncryptBlock(*mac_key_, *cmac_k1_));
+}
+
+__m128i AesSivAesni::CmacFinal(__m128i state, const uint8_t* data,
+                               size_t size) const {
+  __m128i block = LoadPaddedBlock(data, size);
+  block = _mm_xor_si128(block, size == kBlockSize ? *cmac_k1_ : *cmac_k2_);
+  return EncryptBlock(*mac_key_, _mm_xor_si128(state, block));
+}
+
+void AesSivAesni::CtrCrypt(__m128i counter, const uint8_t* in, size_t size,
+                           uint8_t* out) const {
+  __m128i key_stream[kCtrLanes];
+  for (size_t i = 0; i < size; i += kCtrLanes * kBlockSize) {
+    for (int j = 0; j < kCtrLanes; j++) {
+      key_stream[j] = Reverse(counter);
+      counter = Increment(counter);
+    }
+    AesRounds<0, kCtrLanes>(*ctr_key_, nullptr, *ctr_key_, key_stream);
+    XorKeyStream(key_stream, in + i,
+                 std::min(size - i, kCtrLanes * kBlockSize), out + i);
+  }
+}
+
+__m128i AesSivAesni::S2v(absl::string_view additional_data,
+                         const __m128i* s2v_prefix, const uint8_t* msg,
+                         size_t msg_size, const uint8_t* ciphertext,
+                         uint8_t* plaintext, __m128i counter) const {
+  const uint8_t* ad = reinterpret_cast<const uint8_t*>(additional_data.data());
+  const size_t ad_size = additional_data.size();
+  // Blocks of the additional data and of the message which are processed
+  // by the chaining of the CMACs, i.e. all but the last block of the
+  // additional data, and the blocks of the message which precede the last
+  // 16 bytes, since these are modified by the CMAC of the additional data.
+  const size_t ad_blocks = s2v_prefix != nullptr || ad_size == 0
+                               ? 0
+                               : (ad_size - 1) / kBlockSize;
+  const size_t msg_blocks =
+      msg_size < kBlockSize ? 0 : (msg_size - kBlockSize) / kBlockSize;
+
+  __m128i ad_state = _mm_setzero_si128();
+  __m128i msg_state = _mm_setzero_si128();
+  size_t ad_next = 0;
+  size_t msg_next = 0;
+  // Number of bytes of msg which are available.
+  size_t available = ciphertext == nullptr ? msg_size : 0;
+  while (true) {
+    __m128i mac[2];
+    int mac_lanes = 0;
+    bool has_ad_lane = ad_next < ad_blocks;
+    if (has_ad_lane) {
+      mac[mac_lanes++] =
+          _mm_xor_si128(ad_state, LoadBlock(ad + ad_next * kBlockSize));
+      ad_next++;
+    }
+    bool has_msg_lane =
+        msg_next < msg_blocks && (msg_next + 1) * kBlockSize <= available;
+    if (has_msg_lane) {
+      mac[mac_lanes++] =
+          _mm_xor_si128(msg_state, LoadBlock(msg + msg_next * kBlockSize));
+      msg_next++;
+    }
+    __m128i key_stream[kInterleavedCtrLanes];
+    int ctr_lanes = available < msg_size ? kInterleavedCtrLanes : 0;
+    if (mac_lanes == 0 && ctr_lanes == 0) break;
+    for (int j = 0; j < ctr_lanes; j++) {
+      key_stream[j] = Reverse(counter);
+      counter = Increment(counter);
+    }
+    InterleavedAesRounds(*mac_key_, mac, mac_lanes, *ctr_key_, key_stream,
+                         ctr_lanes);
+    if (has_ad_lane) ad_state = mac[0];
+    if (has_msg_lane) msg_state = mac[mac_lanes - 1];
+    if (ctr_lanes > 0) {
+      size_t size =
+          std::min(msg_size - available, kInterleavedCtrLanes * kBlockSize);
+      XorKeyStream(key_stream, ciphertext + available, size,
+                   plaintext + available);
+      available += size;
+    }
+  }
+
+  __m128i prefix;
+  if (s2v_prefix != nullptr) {
+    prefix = *s2v_prefix;
+  } else {
+    __m128i ad_mac = CmacFinal(ad_state, ad + ad_blocks * kBlockSize,
+                               ad_size - ad_blocks * kBlockSize);
+    prefix = _mm_xor_si128(*s2v_zero_, ad_mac);
+  }
+  std::array<uint8_t, 2 * kBlockSize> tail;
+  int tail_blocks = CmacTail(prefix, msg, msg_size, *cmac_k1_, *cmac_k2_,
+                             tail.data());
+  for (int i = 0; i < tail_blocks; i++) {
+    msg_state = EncryptBlock(
+        *mac_key_,
+        _mm_xor_si128(msg_state, LoadBlock(tail.data() + i * kBlockSize)));
+  }
+  return msg_state;
+}
+
+__m128i AesSivAesni::S2vPrefix(absl::string_view additional_data) const {
+  const uint8_t* ad = reinterpret_cast<const uint8_t*>(additional_data.data());
+  const size_t ad_size = additional_data.size();
+  const size_t ad_blocks = ad_size == 0 ? 0 : (ad_size - 1) / kBlockSize;
+  __m128i state = _mm_setzero_si128();
+  for (size_t i = 0; i < ad_blocks; i++) {
+    state = EncryptBlock(*mac_key_,
+                         _mm_xor_si128(state, LoadBlock(ad + i * kBlockSize)));
+  }
+  __m128i ad_mac = CmacFinal(state, ad + ad_blocks * kBlockSize,
+                             ad_size - ad_blocks * kBlockSize);
+  return _mm_xor_si128(*s2v_zero_, ad_mac);
+}
+
+util::Status AesSivAesni::EncryptDeterministicallyBatchInto(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::string_view associated_data,
+    absl::Span<const absl::Span<char>> ciphertext_buffers) const {
+  if (plaintexts.size() != ciphertext_buffers.size()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Number of plaintexts and buffers differ");
+  }
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    if (ciphertext_buffers[i].size() != plaintexts[i].size() + kBlockSize) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Ciphertext buffer has the wrong size");
+    }
+  }
+  const __m128i t = S2vPrefix(associated_data);
+
+  // Compute the synthetic IVs with up to kCellLanes CMACs in flight. A lane
+  // whose CMAC is complete takes on the next value right away, so that
+  // values of different lengths keep all lanes busy.
+  CellLane lanes[kCellLanes];
+  int active_lanes = 0;
+  size_t next_cell = 0;
+  while (true) {
+    while (active_lanes < kCellLanes && next_cell < plaintexts.size()) {
+      CellLane& lane = lanes[active_lanes++];
+      absl::string_view plaintext = plaintexts[next_cell];
+      lane.cell = next_cell++;
+      lane.msg = reinterpret_cast<const uint8_t*>(plaintext.data());
+      lane.free_blocks = FreeBlocks(plaintext.size());
+      lane.blocks =
+          lane.free_blocks + CmacTail(t, lane.msg, plaintext.size(),
+                                      *cmac_k1_, *cmac_k2_, lane.tail.data());
+      lane.next_block = 0;
+      lane.state = _mm_setzero_si128();
+    }
+    if (active_lanes == 0) break;
+    // Run all lanes until the first of them completes.
+    size_t steps = lanes[0].blocks - lanes[0].next_block;
+    for (int j = 1; j < active_lanes; j++) {
+      steps = std::min(steps, lanes[j].blocks - lanes[j].next_block);
+    }
+    ChainCells(*mac_key_, lanes, active_lanes, steps);
+    int kept_lanes = 0;
+    for (int j = 0; j < active_lanes; j++) {
+      if (lanes[j].next_block == lanes[j].blocks) {
+        StoreBlock(
+            reinterpret_cast<uint8_t*>(ciphertext_buffers[lanes[j].cell].data()),
+            lanes[j].state);
+      } else {
+        if (kept_lanes != j) lanes[kept_lanes] = lanes[j];
+        kept_lanes++;
+      }
+    }
+    active_lanes = kept_lanes;
+  }
+
+  // Encrypt the values in CTR mode, kCtrLanes blocks at a time. Values
+  // with fewer than kCtrLanes blocks left share a batch of counter blocks.
+  __m128i key_stream[kCtrLanes];
+  __m128i pending_key_stream[kCtrLanes];
+  const uint8_t* in[kCtrLanes];
+  uint8_t* out[kCtrLanes];
+  size_t sizes[kCtrLanes];
+  int pending = 0;
+  auto flush = [&]() {
+    AesRounds<0, kCtrLanes>(*ctr_key_, nullptr, *ctr_key_,
+                            pending_key_stream);
+    for (int j = 0; j < pending; j++) {
+      XorKeyStream(&pending_key_stream[j], in[j], sizes[j], out[j]);
+    }
+    pending = 0;
+  };
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    uint8_t* ct = reinterpret_cast<uint8_t*>(ciphertext_buffers[i].data());
+    const uint8_t* pt = reinterpret_cast<const uint8_t*>(plaintexts[i].data());
+    const size_t size = plaintexts[i].size();
+    __m128i counter = InitialCounter(LoadBlock(ct));
+    size_t offset = 0;
+    for (; size - offset >= kCtrLanes * kBlockSize;
+         offset += kCtrLanes * kBlockSize) {
+      for (int j = 0; j < kCtrLanes; j++) {
+        key_stream[j] = Reverse(counter);
+        counter = Increment(counter);
+      }
+      AesRounds<0, kCtrLanes>(*ctr_key_, nullptr, *ctr_key_, key_stream);
+      XorKeyStream(key_stream, pt + offset, kCtrLanes * kBlockSize,
+                   ct + kBlockSize + offset);
+    }
+    for (; offset < size; offset += kBlockSize) {
+      pending_key_stream[pending] = Reverse(counter);
+      counter = Increment(counter);
+      in[pending] = pt + offset;
+      out[pending] = ct + kBlockSize + offset;
+      sizes[pending] = std::min(kBlockSize, size - offset);
+      if (++pending == kCtrLanes) flush();
+    }
+  }
+  if (pending > 0) flush();
+  return util::Status::OK;
+}
+
+class AesSivAesni::BoundAssociatedData
+    : public DeterministicAeadWithAssociatedData {
+ public:
+  BoundAssociatedData(const AesSivAesni& aes_siv, __m128i s2v_prefix)
+      : aes_siv_(aes_siv) {
+    StoreBlock(s2v_prefix_.data(), s2v_prefix);
+  }
+
+  ~BoundAssociatedData() override {
+    util::SafeZeroMemory(reinterpret_cast<char*>(s2v_prefix_.data()),
+                         s2v_prefix_.size());
+  }
+
+  util::StatusOr<std::string> EncryptDeterministically(
+      absl::string_view plaintext) const override {
+    __m128i s2v_prefix = LoadBlock(s2v_prefix_.data());
+    return aes_siv_.Encrypt(plaintext, "", &s2v_prefix);
+  }
+
+  util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext) const override {
+    __m128i s2v_prefix = LoadBlock(s2v_prefix_.data());
+    return aes_siv_.Decrypt(ciphertext, "", &s2v_prefix);
+  }
+
+ private:
+  const AesSivAesni& aes_siv_;
+  // Kept as bytes, since the object is not necessarily 16 byte aligned.
+  std::array<uint8_t, kBlockSize> s2v_prefix_;
+};
+
+util::StatusOr<std::unique_ptr<DeterministicAeadWithAssociatedData>>
+AesSivAesni::WithAssociatedData(absl::string_view associated_data) const {
+  return {absl::make_unique<BoundAssociatedData>(
+      *this, S2vPrefix(associated_data))};
+}
+
+util::StatusOr<std::string> AesSivAesni::EncryptDeterministically(
+    absl::string_view plaintext, absl::string_view additional_data) const {
+  return Encrypt(plaintext, additional_data, nullptr);
+}
+
+util::StatusOr<std::string> AesSivAesni::DecryptDeterministically(
+    absl::string_view ciphertext, absl::string_view additional_data) const {
+  return Decrypt(ciphertext, additional_data, nullptr);
+}
+
+util::StatusOr<std::string> AesSivAesni::Encrypt(
+    absl::string_view plaintext, absl::string_view additional_data,
+    const __m128i* s2v_prefix) const {
+  const uint8_t* pt = reinterpret_cast<const uint8_t*>(plaintext.data());
+  __m128i siv = S2v(additional_data, s2v_prefix, pt, plaintext.size(),
+                    nullptr, nullptr, _mm_setzero_si128());
+  std::string ciphertext(plaintext.size() + kBlockSize, '\0');
+  uint8_t* ct = reinterpret_cast<uint8_t*>(&ciphertext[0]);
+  StoreBlock(ct, siv);
+  CtrCrypt(InitialCounter(siv), pt, plaintext.size(), ct + kBlockSize);
+  return std::move(ciphertext);
+}
+
+util::StatusOr<std::string> AesSivAesni::Decrypt(
+    absl::string_view ciphertext, absl::string_view additional_data,
+    const __m128i* s2v_prefix) const {
+  if (ciphertext.size() < kBlockSize) {
+    return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too short");
+  }
+  size_t plaintext_size = ciphertext.size() - kBlockSize;
+  const uint8_t* ct = reinterpret_cast<const uint8_t*>(ciphertext.data());
+  __m128i siv = LoadBlock(ct);
+  std::string plaintext(plaintext_size, '\0');
+  uint8_t* pt = reinterpret_cast<uint8_t*>(&plaintext[0]);
+  __m128i s2v = S2v(additional_data, s2v_prefix, pt, plaintext_size,
+                    ct + kBlockSize, pt, InitialCounter(siv));
+  if (!EqualBlocks(siv, s2v)) {
+    util::SafeZeroString(&plaintext);
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid ciphertext");
+  }
+  return std::move(plaintext);
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // __AES__
+#endif  // __SSE4_1__
@@ -0,0 +1,161 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_AES_SIV_AESNI_H_
+#define TINK_SUBTLE_AES_SIV_AESNI_H_
+
+#ifdef __SSE4_1__
+#ifdef __AES__
+
+#include <xmmintrin.h>
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/config/tink_fips.h"
+#include "tink/deterministic_aead.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// This class implements AES-SIV-CMAC (RFC 5297) with one AD component on
+// CPUs that support the AESNI instruction set (as well as SSE 4.1). It
+// produces the same ciphertexts as AesSivBoringSsl, and like it only
+// supports 64 byte keys (two AES-256 keys).
+//
+// Instead of computing one AES block at a time, the implementation keeps
+// several independent blocks in flight: the CTR key stream is computed
+// 8 blocks at a time, the CMACs of the additional data and of the message
+// are computed concurrently, and when decrypting they are interleaved
+// with the CTR decryption of the message.
+//
+// Thread safety: This class is thread safe and thus can be used
+// concurrently.
+class AesSivAesni : public DeterministicAead {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<DeterministicAead>> New(
+      const util::SecretData& key);
+
+  crypto::tink::util::StatusOr<std::string> EncryptDeterministically(
+      absl::string_view plaintext,
+      absl::string_view additional_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext,
+      absl::string_view additional_data) const override;
+
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override {
+    return plaintext_size + kBlockSize;
+  }
+
+  // Computes the synthetic IVs of several values at once, interleaving
+  // their CMACs, and shares the CMAC of 'associated_data' between all of
+  // them. The CTR encryption runs over the values as one stream of blocks.
+  crypto::tink::util::Status EncryptDeterministicallyBatchInto(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> ciphertext_buffers) const override;
+
+  // Computes the CMAC of 'associated_data' once, so that each message only
+  // costs the CMAC of the message and the CTR encryption.
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<DeterministicAeadWithAssociatedData>>
+  WithAssociatedData(absl::string_view associated_data) const override;
+
+  static bool IsValidKeySizeInBytes(size_t size) { return size == 64; }
+
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kNotFips;
+
+  // Round keys of AES-256.
+  static constexpr int kRounds = 14;
+  using RoundKeys = std::array<__m128i, kRounds + 1>;
+
+ private:
+  class BoundAssociatedData;
+
+  static constexpr size_t kBlockSize = 16;
+
+  AesSivAesni() {}
+
+  // AesSivAesni instances are immutable objects.
+  // Therefore, the only place where SetKey should be called is in the
+  // construction, i.e. in New().
+  void SetKey(const util::SecretData& key);
+
+  // Computes the synthetic IV of the message msg[0] .. msg[msg_size - 1]
+  // and 'additional_data'. If 'ciphertext' is not null, the message is the
+  // decryption of 'ciphertext', which is written to 'msg' = 'plaintext' by
+  // CTR mode with the initial counter block 'counter' (in little endian
+  // order) while the CMACs are computed. If 's2v_prefix' is not null, it
+  // is the result of S2vPrefix(additional_data), and 'additional_data' is
+  // ignored.
+  __m128i S2v(absl::string_view additional_data, const __m128i* s2v_prefix,
+              const uint8_t* msg, size_t msg_size, const uint8_t* ciphertext,
+              uint8_t* plaintext, __m128i counter) const;
+
+  // Returns dbl(CMAC(0^128)) XOR CMAC(additional_data), the value which
+  // S2V combines with the message.
+  __m128i S2vPrefix(absl::string_view additional_data) const;
+
+  // Implement EncryptDeterministically() and DecryptDeterministically(),
+  // with the arguments of S2v().
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext, absl::string_view additional_data,
+      const __m128i* s2v_prefix) const;
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext, absl::string_view additional_data,
+      const __m128i* s2v_prefix) const;
+
+  // Completes a CMAC with the key mac_key_, given the chaining value 'state'
+  // and the last 0 .. 16 bytes of the message.
+  __m128i CmacFinal(__m128i state, const uint8_t* data, size_t size) const;
+
+  // Encrypts in[0] .. in[size - 1] with AES-CTR under ctr_key_, starting with
+  // the counter block 'counter' (in little endian order).
+  void CtrCrypt(__m128i counter, const uint8_t* in, size_t size,
+                uint8_t* out) const;
+
+  util::SecretUniquePtr<RoundKeys> mac_key_ =
+      util::MakeSecretUniquePtr<RoundKeys>();
+  util::SecretUniquePtr<RoundKeys> ctr_key_ =
+      util::MakeSecretUniquePtr<RoundKeys>();
+  // CMAC subkeys K1 and K2 of mac_key_ (cf. RFC 4493).
+  util::SecretUniquePtr<__m128i> cmac_k1_ =
+      util::MakeSecretUniquePtr<__m128i>();
+  util::SecretUniquePtr<__m128i> cmac_k2_ =
+      util::MakeSecretUniquePtr<__m128i>();
+  // dbl(CMAC(0^128)), the initial value of S2V.
+  util::SecretUniquePtr<__m128i> s2v_zero_ =
+      util::MakeSecretUniquePtr<__m128i>();
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // __AES__
+#endif  // __SSE4_1__
+#endif  // TINK_SUBTLE_AES_SIV_AESNI_H_
@@ -0,0 +1,207 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__SSE4_1__) && defined(__AES__)
+
+#include "tink/subtle/aes_siv_aesni.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tink/subtle/aes_siv_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/wycheproof_util.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+
+TEST(AesSivAesniTest, InvalidKeySizes) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  for (int key_size : {0, 16, 32, 48, 63, 65, 128}) {
+    util::SecretData key(key_size, 'x');
+    EXPECT_THAT(AesSivAesni::New(key).status(),
+                StatusIs(util::error::INVALID_ARGUMENT))
+        << key_size;
+  }
+}
+
+// The message and additional data sizes cover the boundaries of the
+// interleaved CMAC and CTR computations.
+TEST(AesSivAesniTest, SameAsAesSivBoringSsl) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::SecretData key = Random::GetRandomKeyBytes(64);
+  auto aesni = std::move(AesSivAesni::New(key).ValueOrDie());
+  auto boringssl = std::move(AesSivBoringSsl::New(key).ValueOrDie());
+  for (int msg_size = 0; msg_size < 300; msg_size += msg_size < 70 ? 1 : 13) {
+    for (int aad_size : {0, 1, 15, 16, 17, 32, 33, 100, 1000}) {
+      std::string msg = Random::GetRandomBytes(msg_size);
+      std::string aad = Random::GetRandomBytes(aad_size);
+      auto ct = aesni->EncryptDeterministically(msg, aad);
+      ASSERT_THAT(ct.status(), IsOk());
+      EXPECT_EQ(test::HexEncode(ct.ValueOrDie()),
+                test::HexEncode(
+                    boringssl->EncryptDeterministically(msg, aad).ValueOrDie()))
+          << msg_size << " " << aad_size;
+      auto pt = aesni->DecryptDeterministically(ct.ValueOrDie(), aad);
+      ASSERT_THAT(pt.status(), IsOk()) << msg_size << " " << aad_size;
+      EXPECT_EQ(pt.ValueOrDie(), msg);
+    }
+  }
+}
+
+TEST(AesSivAesniTest, EncryptBatch) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::SecretData key = Random::GetRandomKeyBytes(64);
+  auto cipher = std::move(AesSivAesni::New(key).ValueOrDie());
+  // Values of different lengths, so that lanes finish at different times.
+  std::string data;
+  std::vector<int64_t> offsets = {0};
+  for (int size : {0, 1, 16, 17, 200, 15, 32, 33, 0, 128, 129, 47, 5}) {
+    data += Random::GetRandomBytes(size);
+    offsets.push_back(data.size());
+  }
+  std::string aad = "column name";
+  std::string ciphertexts;
+  std::vector<int64_t> ciphertext_offsets;
+  ASSERT_THAT(cipher->EncryptDeterministicallyBatch(
+                  offsets, data, aad, &ciphertexts, &ciphertext_offsets),
+              IsOk());
+  ASSERT_EQ(ciphertext_offsets.size(), offsets.size());
+  for (size_t i = 0; i + 1 < offsets.size(); i++) {
+    std::string plaintext =
+        data.substr(offsets[i], offsets[i + 1] - offsets[i]);
+    std::string ciphertext =
+        ciphertexts.substr(ciphertext_offsets[i],
+                           ciphertext_offsets[i + 1] - ciphertext_offsets[i]);
+    EXPECT_EQ(test::HexEncode(ciphertext),
+              test::HexEncode(cipher->EncryptDeterministically(plaintext, aad)
+                                  .ValueOrDie()))
+        << i;
+  }
+}
+
+TEST(AesSivAesniTest, WithAssociatedData) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::SecretData key = Random::GetRandomKeyBytes(64);
+  auto cipher = std::move(AesSivAesni::New(key).ValueOrDie());
+  for (int aad_size : {0, 1, 16, 17, 100}) {
+    std::string aad = Random::GetRandomBytes(aad_size);
+    auto bound = std::move(cipher->WithAssociatedData(aad).ValueOrDie());
+    for (int msg_size : {0, 1, 15, 16, 17, 32, 33, 200}) {
+      std::string msg = Random::GetRandomBytes(msg_size);
+      std::string ct = bound->EncryptDeterministically(msg).ValueOrDie();
+      EXPECT_EQ(test::HexEncode(ct),
+                test::HexEncode(
+                    cipher->EncryptDeterministically(msg, aad).ValueOrDie()))
+          << msg_size << " " << aad_size;
+      auto pt = bound->DecryptDeterministically(ct);
+      ASSERT_THAT(pt.status(), IsOk()) << msg_size << " " << aad_size;
+      EXPECT_EQ(pt.ValueOrDie(), msg);
+      EXPECT_THAT(bound
+                      ->DecryptDeterministically(
+                          cipher->EncryptDeterministically(msg, aad + "x")
+                              .ValueOrDie())
+                      .status(),
+                  StatusIs(util::error::INVALID_ARGUMENT));
+    }
+  }
+}
+
+TEST(AesSivAesniTest, ModifiedCiphertext) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::SecretData key = Random::GetRandomKeyBytes(64);
+  auto cipher = std::move(AesSivAesni::New(key).ValueOrDie());
+  std::string aad = "Additional data";
+  std::string message = "Some data to encrypt, longer than two blocks.";
+  std::string ct = cipher->EncryptDeterministically(message, aad).ValueOrDie();
+  EXPECT_THAT(cipher->DecryptDeterministically(ct, "other aad").status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(cipher->DecryptDeterministically(ct.substr(0, 15), aad).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  for (size_t b = 0; b < ct.size(); b++) {
+    for (int bit = 0; bit < 8; bit++) {
+      std::string modified_ct = ct;
+      modified_ct[b] ^= (1 << bit);
+      EXPECT_FALSE(cipher->DecryptDeterministically(modified_ct, aad).ok())
+          << "Modified ciphertext decrypted."
+          << " byte:" << b << " bit:" << bit;
+    }
+  }
+}
+
+TEST(AesSivAesniTest, TestVectors) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  std::unique_ptr<rapidjson::Document> root =
+      WycheproofUtil::ReadTestVectors("aes_siv_cmac_test.json");
+  for (const rapidjson::Value& test_group : (*root)["testGroups"].GetArray()) {
+    const size_t key_size = test_group["keySize"].GetInt();
+    if (!AesSivAesni::IsValidKeySizeInBytes(key_size / 8)) continue;
+    for (const rapidjson::Value& test : test_group["tests"].GetArray()) {
+      util::SecretData key =
+          util::SecretDataFromStringView(WycheproofUtil::GetBytes(test["key"]));
+      std::string msg = WycheproofUtil::GetBytes(test["msg"]);
+      std::string ct = WycheproofUtil::GetBytes(test["ct"]);
+      std::string aad = WycheproofUtil::GetBytes(test["aad"]);
+      int id = test["tcId"].GetInt();
+      std::string result = test["result"].GetString();
+      auto cipher = std::move(AesSivAesni::New(key).ValueOrDie());
+
+      std::string encrypted =
+          cipher->EncryptDeterministically(msg, aad).ValueOrDie();
+      auto decrypted = cipher->DecryptDeterministically(ct, aad);
+      if (result == "invalid") {
+        EXPECT_NE(test::HexEncode(ct), test::HexEncode(encrypted)) << id;
+        EXPECT_FALSE(decrypted.ok()) << "decrypted invalid ciphertext: " << id;
+      } else {
+        EXPECT_EQ(test::HexEncode(ct), test::HexEncode(encrypted)) << id;
+        ASSERT_THAT(decrypted.status(), IsOk()) << id;
+        EXPECT_EQ(test::HexEncode(msg),
+                  test::HexEncode(decrypted.ValueOrDie()))
+            << id;
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // defined(__SSE4_1__) && defined(__AES__)
@@ -172,19 +172,22 @@ void AesSivBoringSsl::CmacLong(absl::Span<const uint8_t> data,
   EncryptBlock(block, mac);
 }
 
-void AesSivBoringSsl::S2v(absl::Span<const uint8_t> aad,
-                          absl::Span<const uint8_t> msg,
-                          uint8_t siv[kBlockSize]) const {
-  // This stuff could be precomputed.
-  uint8_t block[kBlockSize];
-  std::fill(std::begin(block), std::end(block), 0);
-  Cmac(block, block);
-  MultiplyByX(block);
+void AesSivBoringSsl::S2vPrefix(absl::Span<const uint8_t> aad,
+                                uint8_t prefix[kBlockSize]) const {
+  std::fill(prefix, prefix + kBlockSize, 0);
+  Cmac(absl::MakeSpan(prefix, kBlockSize), prefix);
+  MultiplyByX(prefix);
 
   uint8_t aad_mac[kBlockSize];
   Cmac(aad, aad_mac);
-  XorBlock(block, aad_mac, block);
+  XorBlock(prefix, aad_mac, prefix);
+}
 
+void AesSivBoringSsl::S2vFinal(const uint8_t prefix[kBlockSize],
+                               absl::Span<const uint8_t> msg,
+                               uint8_t siv[kBlockSize]) const {
+  uint8_t block[kBlockSize];
+  std::copy(prefix, prefix + kBlockSize, block);
   if (msg.size() >= kBlockSize) {
     CmacLong(msg, block, siv);
   } else {
@@ -197,14 +200,70 @@ void AesSivBoringSsl::S2v(absl::Span<const uint8_t> aad,
   }
 }
 
+class AesSivBoringSsl::BoundAssociatedData
+    : public DeterministicAeadWithAssociatedData {
+ public:
+  explicit BoundAssociatedData(const AesSivBoringSsl& aes_siv)
+      : aes_siv_(aes_siv) {}
+
+  ~BoundAssociatedData() override {
+    OPENSSL_cleanse(s2v_prefix_, sizeof(s2v_prefix_));
+  }
+
+  util::StatusOr<std::string> EncryptDeterministically(
+      absl::string_view plaintext) const override {
+    return aes_siv_.Encrypt(plaintext, s2v_prefix_);
+  }
+
+  util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext) const override {
+    return aes_siv_.Decrypt(ciphertext, s2v_prefix_);
+  }
+
+  uint8_t* s2v_prefix() { return s2v_prefix_; }
+
+ private:
+  const AesSivBoringSsl& aes_siv_;
+  uint8_t s2v_prefix_[kBlockSize];
+};
+
+util::StatusOr<std::unique_ptr<DeterministicAeadWithAssociatedData>>
+AesSivBoringSsl::WithAssociatedData(absl::string_view associated_data) const {
+  auto bound = absl::make_unique<BoundAssociatedData>(*this);
+  S2vPrefix(
+      absl::MakeSpan(reinterpret_cast<const uint8_t*>(associated_data.data()),
+                     associated_data.size()),
+      bound->s2v_prefix());
+  return {std::move(bound)};
+}
+
 util::StatusOr<std::string> AesSivBoringSsl::EncryptDeterministically(
     absl::string_view plaintext, absl::string_view additional_data) const {
-  uint8_t siv[kBlockSize];
-  S2v(absl::MakeSpan(reinterpret_cast<const uint8_t*>(additional_data.data()),
+  uint8_t prefix[kBlockSize];
+  S2vPrefix(
+      absl::MakeSpan(reinterpret_cast<const uint8_t*>(additional_data.data()),
                      additional_data.size()),
-      absl::MakeSpan(reinterpret_cast<const uint8_t*>(plaintext.data()),
-                     plaintext.size()),
-      siv);
+      prefix);
+  return Encrypt(plaintext, prefix);
+}
+
+util::StatusOr<std::string> AesSivBoringSsl::DecryptDeterministically(
+    absl::string_view ciphertext, absl::string_view additional_data) const {
+  uint8_t prefix[kBlockSize];
+  S2vPrefix(
+      absl::MakeSpan(reinterpret_cast<const uint8_t*>(additional_data.data()),
+                     additional_data.size()),
+      prefix);
+  return Decrypt(ciphertext, prefix);
+}
+
+util::StatusOr<std::string> AesSivBoringSsl::Encrypt(
+    absl::string_view plaintext, const uint8_t s2v_prefix[kBlockSize]) const {
+  uint8_t siv[kBlockSize];
+  S2vFinal(s2v_prefix,
+           absl::MakeSpan(reinterpret_cast<const uint8_t*>(plaintext.data()),
+                          plaintext.size()),
+           siv);
   size_t ciphertext_size = plaintext.size() + kBlockSize;
   std::vector<uint8_t> ct(ciphertext_size);
   std::copy(std::begin(siv), std::end(siv), ct.begin());
@@ -215,8 +274,8 @@ util::StatusOr<std::string> AesSivBoringSsl::EncryptDeterministically(
   return std::string(reinterpret_cast<const char*>(ct.data()), ciphertext_size);
 }
 
-util::StatusOr<std::string> AesSivBoringSsl::DecryptDeterministically(
-    absl::string_view ciphertext, absl::string_view additional_data) const {
+util::StatusOr<std::string> AesSivBoringSsl::Decrypt(
+    absl::string_view ciphertext, const uint8_t s2v_prefix[kBlockSize]) const {
   if (ciphertext.size() < kBlockSize) {
     return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too short");
   }
@@ -228,9 +287,7 @@ util::StatusOr<std::string> AesSivBoringSsl::DecryptDeterministically(
   CtrCrypt(siv, absl::MakeSpan(ct, plaintext_size), pt.data());
 
   uint8_t s2v[kBlockSize];
-  S2v(absl::MakeSpan(reinterpret_cast<const uint8_t*>(additional_data.data()),
-                     additional_data.size()),
-      absl::MakeSpan(pt), s2v);
+  S2vFinal(s2v_prefix, absl::MakeSpan(pt), s2v);
   if (CRYPTO_memcmp(siv, s2v, kBlockSize) != 0) {
     return util::Status(util::error::INVALID_ARGUMENT, "invalid ciphertext");
   }
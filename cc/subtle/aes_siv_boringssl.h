@@ -67,6 +67,17 @@ class AesSivBoringSsl : public DeterministicAead {
       absl::string_view ciphertext,
       absl::string_view additional_data) const override;
 
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override {
+    return plaintext_size + kBlockSize;
+  }
+
+  // Computes the CMAC of 'associated_data' once, so that each message only
+  // costs the CMAC of the message and the CTR encryption.
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<DeterministicAeadWithAssociatedData>>
+  WithAssociatedData(absl::string_view associated_data) const override;
+
   static bool IsValidKeySizeInBytes(size_t size) {
     return size == 64;
   }
@@ -75,6 +86,8 @@ class AesSivBoringSsl : public DeterministicAead {
       crypto::tink::FipsCompatibility::kNotFips;
 
  private:
+  class BoundAssociatedData;
+
   static constexpr size_t kBlockSize = 16;
 
   AesSivBoringSsl(util::SecretUniquePtr<AES_KEY> k1,
@@ -117,8 +130,21 @@ class AesSivBoringSsl : public DeterministicAead {
   static void XorBlock(const uint8_t x[kBlockSize], const uint8_t y[kBlockSize],
                        uint8_t res[kBlockSize]);
 
-  void S2v(absl::Span<const uint8_t> aad, absl::Span<const uint8_t> msg,
-           uint8_t siv[kBlockSize]) const;
+  // Computes the part of S2V which only depends on the associated data,
+  // i.e. dbl(CMAC(0)) xor CMAC(aad).
+  void S2vPrefix(absl::Span<const uint8_t> aad,
+                 uint8_t prefix[kBlockSize]) const;
+
+  // Finishes S2V for 'msg', given the result of S2vPrefix().
+  void S2vFinal(const uint8_t prefix[kBlockSize],
+                absl::Span<const uint8_t> msg, uint8_t siv[kBlockSize]) const;
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext, const uint8_t s2v_prefix[kBlockSize]) const;
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      const uint8_t s2v_prefix[kBlockSize]) const;
 
   const util::SecretUniquePtr<AES_KEY> k1_;
   const util::SecretUniquePtr<AES_KEY> k2_;
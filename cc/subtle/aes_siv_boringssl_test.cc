@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "tink/subtle/random.h"
 #include "tink/subtle/wycheproof_util.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/status.h"
@@ -176,6 +177,32 @@ TEST(AesSivBoringSslTest, testEncryptDecryptAadSize) {
   }
 }
 
+TEST(AesSivBoringSslTest, testWithAssociatedData) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::SecretData key = Random::GetRandomKeyBytes(64);
+  auto cipher = std::move(AesSivBoringSsl::New(key).ValueOrDie());
+  for (int aad_size : {0, 1, 16, 17, 100}) {
+    std::string aad = Random::GetRandomBytes(aad_size);
+    auto bound = std::move(cipher->WithAssociatedData(aad).ValueOrDie());
+    for (int msg_size : {0, 1, 15, 16, 17, 33}) {
+      std::string message = Random::GetRandomBytes(msg_size);
+      std::string ct = bound->EncryptDeterministically(message).ValueOrDie();
+      EXPECT_EQ(ct,
+                cipher->EncryptDeterministically(message, aad).ValueOrDie());
+      auto pt = bound->DecryptDeterministically(ct);
+      EXPECT_TRUE(pt.ok()) << pt.status();
+      EXPECT_EQ(pt.ValueOrDie(), message);
+      EXPECT_FALSE(bound
+                       ->DecryptDeterministically(
+                           cipher->EncryptDeterministically(message, aad + "x")
+                               .ValueOrDie())
+                       .ok());
+    }
+  }
+}
+
 TEST(AesSivBoringSslTest, testDecryptModification) {
   if (kUseOnlyFips) {
     GTEST_SKIP() << "Not supported in FIPS-only mode";
@@ -0,0 +1,665 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/blake3.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define TINK_SUBTLE_BLAKE3_AVX2
+#endif
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#define TINK_SUBTLE_BLAKE3_SSE41
+#endif
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define TINK_SUBTLE_BLAKE3_NEON
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/executor.h"
+#include "tink/subtle/cpu_features.h"
+#include "tink/util/secret_data.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+constexpr uint32_t kIv[8] = {0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+                             0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19};
+
+// The message words used by each of the 7 rounds, i.e. the message
+// permutation applied 0 to 6 times.
+constexpr uint8_t kMsgSchedule[7][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+    {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+    {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+    {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+    {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+    {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13},
+};
+
+// Domain separation flags.
+constexpr uint8_t kChunkStart = 1;
+constexpr uint8_t kChunkEnd = 2;
+constexpr uint8_t kParent = 4;
+constexpr uint8_t kRoot = 8;
+constexpr uint8_t kKeyedHash = 16;
+
+constexpr size_t kBlockSize = 64;
+constexpr size_t kChunkSize = Blake3Hasher::kChunkSizeInBytes;
+constexpr size_t kBlocksPerChunk = kChunkSize / kBlockSize;
+
+uint32_t LoadLe32(const uint8_t* p) {
+  return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+         static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+void StoreLe32(uint8_t* p, uint32_t v) {
+  p[0] = static_cast<uint8_t>(v);
+  p[1] = static_cast<uint8_t>(v >> 8);
+  p[2] = static_cast<uint8_t>(v >> 16);
+  p[3] = static_cast<uint8_t>(v >> 24);
+}
+
+inline uint32_t Rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+inline void G(uint32_t* s, int a, int b, int c, int d, uint32_t x,
+              uint32_t y) {
+  s[a] = s[a] + s[b] + x;
+  s[d] = Rotr(s[d] ^ s[a], 16);
+  s[c] = s[c] + s[d];
+  s[b] = Rotr(s[b] ^ s[c], 12);
+  s[a] = s[a] + s[b] + y;
+  s[d] = Rotr(s[d] ^ s[a], 8);
+  s[c] = s[c] + s[d];
+  s[b] = Rotr(s[b] ^ s[c], 7);
+}
+
+// Computes all 16 words of the output of the compression function.
+void Compress(const uint32_t cv[8], const uint8_t block[kBlockSize],
+              uint64_t counter, uint8_t block_size, uint8_t flags,
+              uint32_t out[16]) {
+  uint32_t m[16];
+  for (int i = 0; i < 16; i++) m[i] = LoadLe32(block + 4 * i);
+  uint32_t s[16] = {cv[0],    cv[1],    cv[2],    cv[3],
+                    cv[4],    cv[5],    cv[6],    cv[7],
+                    kIv[0],   kIv[1],   kIv[2],   kIv[3],
+                    static_cast<uint32_t>(counter),
+                    static_cast<uint32_t>(counter >> 32),
+                    block_size, flags};
+  for (int r = 0; r < 7; r++) {
+    const uint8_t* sc = kMsgSchedule[r];
+    G(s, 0, 4, 8, 12, m[sc[0]], m[sc[1]]);
+    G(s, 1, 5, 9, 13, m[sc[2]], m[sc[3]]);
+    G(s, 2, 6, 10, 14, m[sc[4]], m[sc[5]]);
+    G(s, 3, 7, 11, 15, m[sc[6]], m[sc[7]]);
+    G(s, 0, 5, 10, 15, m[sc[8]], m[sc[9]]);
+    G(s, 1, 6, 11, 12, m[sc[10]], m[sc[11]]);
+    G(s, 2, 7, 8, 13, m[sc[12]], m[sc[13]]);
+    G(s, 3, 4, 9, 14, m[sc[14]], m[sc[15]]);
+  }
+  for (int i = 0; i < 8; i++) {
+    out[i] = s[i] ^ s[i + 8];
+    out[i + 8] = s[i + 8] ^ cv[i];
+  }
+}
+
+void CompressInPlace(uint32_t cv[8], const uint8_t block[kBlockSize],
+                     uint64_t counter, uint8_t block_size, uint8_t flags) {
+  uint32_t out[16];
+  Compress(cv, block, counter, block_size, flags, out);
+  std::memcpy(cv, out, 8 * sizeof(uint32_t));
+}
+
+// The last compression of a node, whose output is either the chaining value
+// of the node or, with the root flag, the output of the hash.
+struct Output {
+  uint32_t cv[8];
+  uint8_t block[kBlockSize];
+  uint64_t counter;
+  uint8_t block_size;
+  uint8_t flags;
+
+  void ChainingValue(uint32_t out[8]) const {
+    uint32_t words[16];
+    Compress(cv, block, counter, block_size, flags, words);
+    std::memcpy(out, words, 8 * sizeof(uint32_t));
+  }
+
+  void RootBytes(absl::Span<uint8_t> out) const {
+    uint64_t output_counter = 0;
+    size_t pos = 0;
+    while (pos < out.size()) {
+      uint32_t words[16];
+      Compress(cv, block, output_counter++, block_size, flags | kRoot, words);
+      uint8_t bytes[kBlockSize];
+      for (int i = 0; i < 16; i++) StoreLe32(bytes + 4 * i, words[i]);
+      size_t n = std::min(kBlockSize, out.size() - pos);
+      std::memcpy(out.data() + pos, bytes, n);
+      pos += n;
+    }
+  }
+};
+
+Output ParentOutput(const uint32_t left[8], const uint32_t right[8],
+                    const uint32_t key[8], uint8_t flags) {
+  Output output;
+  std::memcpy(output.cv, key, sizeof(output.cv));
+  for (int i = 0; i < 8; i++) {
+    StoreLe32(output.block + 4 * i, left[i]);
+    StoreLe32(output.block + 32 + 4 * i, right[i]);
+  }
+  output.counter = 0;
+  output.block_size = kBlockSize;
+  output.flags = flags | kParent;
+  return output;
+}
+
+// 'out' may alias 'left' or 'right'.
+void ParentChainingValue(const uint32_t left[8], const uint32_t right[8],
+                         const uint32_t key[8], uint8_t flags,
+                         uint32_t out[8]) {
+  ParentOutput(left, right, key, flags).ChainingValue(out);
+}
+
+// Writes the chaining values of the 'num_chunks' full chunks at 'input',
+// whose first one has the chunk counter 'counter', to 'out'.
+using HashChunksFunction = void (*)(const uint8_t* input, size_t num_chunks,
+                                    const uint32_t key[8], uint64_t counter,
+                                    uint8_t flags, uint32_t (*out)[8]);
+
+void HashChunkPortable(const uint8_t* input, const uint32_t key[8],
+                       uint64_t counter, uint8_t flags, uint32_t out[8]) {
+  std::memcpy(out, key, 8 * sizeof(uint32_t));
+  for (size_t b = 0; b < kBlocksPerChunk; b++) {
+    uint8_t block_flags = flags;
+    if (b == 0) block_flags |= kChunkStart;
+    if (b == kBlocksPerChunk - 1) block_flags |= kChunkEnd;
+    CompressInPlace(out, input + b * kBlockSize, counter, kBlockSize,
+                    block_flags);
+  }
+}
+
+void HashChunksPortable(const uint8_t* input, size_t num_chunks,
+                        const uint32_t key[8], uint64_t counter, uint8_t flags,
+                        uint32_t (*out)[8]) {
+  for (size_t i = 0; i < num_chunks; i++) {
+    HashChunkPortable(input + i * kChunkSize, key, counter + i, flags, out[i]);
+  }
+}
+
+// The SIMD implementations compress the same block of V::kLanes chunks at
+// once, with one lane per chunk. V provides the 32-bit lane operations.
+template <class V>
+inline void GLanes(typename V::T& a, typename V::T& b, typename V::T& c,
+                   typename V::T& d, typename V::T x, typename V::T y) {
+  a = V::Add(V::Add(a, b), x);
+  d = V::template Rotr<16>(V::Xor(d, a));
+  c = V::Add(c, d);
+  b = V::template Rotr<12>(V::Xor(b, c));
+  a = V::Add(V::Add(a, b), y);
+  d = V::template Rotr<8>(V::Xor(d, a));
+  c = V::Add(c, d);
+  b = V::template Rotr<7>(V::Xor(b, c));
+}
+
+template <class V>
+void HashLanes(const uint8_t* input, const uint32_t key[8], uint64_t counter,
+               uint8_t flags, uint32_t (*out)[8]) {
+  using T = typename V::T;
+  constexpr int kLanes = V::kLanes;
+  T h[8];
+  for (int i = 0; i < 8; i++) h[i] = V::Set1(key[i]);
+  alignas(32) uint32_t counter_low[kLanes];
+  alignas(32) uint32_t counter_high[kLanes];
+  for (int lane = 0; lane < kLanes; lane++) {
+    counter_low[lane] = static_cast<uint32_t>(counter + lane);
+    counter_high[lane] = static_cast<uint32_t>((counter + lane) >> 32);
+  }
+  const T counter_low_lanes = V::Load(counter_low);
+  const T counter_high_lanes = V::Load(counter_high);
+  alignas(32) uint32_t words[16][kLanes];
+  for (size_t b = 0; b < kBlocksPerChunk; b++) {
+    for (int lane = 0; lane < kLanes; lane++) {
+      const uint8_t* block = input + lane * kChunkSize + b * kBlockSize;
+      for (int w = 0; w < 16; w++) words[w][lane] = LoadLe32(block + 4 * w);
+    }
+    T m[16];
+    for (int w = 0; w < 16; w++) m[w] = V::Load(words[w]);
+    uint8_t block_flags = flags;
+    if (b == 0) block_flags |= kChunkStart;
+    if (b == kBlocksPerChunk - 1) block_flags |= kChunkEnd;
+    T v[16] = {h[0],
+               h[1],
+               h[2],
+               h[3],
+               h[4],
+               h[5],
+               h[6],
+               h[7],
+               V::Set1(kIv[0]),
+               V::Set1(kIv[1]),
+               V::Set1(kIv[2]),
+               V::Set1(kIv[3]),
+               counter_low_lanes,
+               counter_high_lanes,
+               V::Set1(kBlockSize),
+               V::Set1(block_flags)};
+    for (int r = 0; r < 7; r++) {
+      const uint8_t* sc = kMsgSchedule[r];
+      GLanes<V>(v[0], v[4], v[8], v[12], m[sc[0]], m[sc[1]]);
+      GLanes<V>(v[1], v[5], v[9], v[13], m[sc[2]], m[sc[3]]);
+      GLanes<V>(v[2], v[6], v[10], v[14], m[sc[4]], m[sc[5]]);
+      GLanes<V>(v[3], v[7], v[11], v[15], m[sc[6]], m[sc[7]]);
+      GLanes<V>(v[0], v[5], v[10], v[15], m[sc[8]], m[sc[9]]);
+      GLanes<V>(v[1], v[6], v[11], v[12], m[sc[10]], m[sc[11]]);
+      GLanes<V>(v[2], v[7], v[8], v[13], m[sc[12]], m[sc[13]]);
+      GLanes<V>(v[3], v[4], v[9], v[14], m[sc[14]], m[sc[15]]);
+    }
+    for (int i = 0; i < 8; i++) h[i] = V::Xor(v[i], v[i + 8]);
+  }
+  alignas(32) uint32_t cv_words[8][kLanes];
+  for (int i = 0; i < 8; i++) V::Store(cv_words[i], h[i]);
+  for (int lane = 0; lane < kLanes; lane++) {
+    for (int i = 0; i < 8; i++) out[lane][i] = cv_words[i][lane];
+  }
+}
+
+template <class V>
+void HashChunksSimd(const uint8_t* input, size_t num_chunks,
+                    const uint32_t key[8], uint64_t counter, uint8_t flags,
+                    uint32_t (*out)[8]) {
+  size_t i = 0;
+  for (; i + V::kLanes <= num_chunks; i += V::kLanes) {
+    HashLanes<V>(input + i * kChunkSize, key, counter + i, flags, out + i);
+  }
+  HashChunksPortable(input + i * kChunkSize, num_chunks - i, key, counter + i,
+                     flags, out + i);
+}
+
+#ifdef TINK_SUBTLE_BLAKE3_AVX2
+struct Avx2Lanes {
+  using T = __m256i;
+  static constexpr int kLanes = 8;
+  static T Load(const uint32_t* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  }
+  static void Store(uint32_t* p, T x) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), x);
+  }
+  static T Set1(uint32_t x) { return _mm256_set1_epi32(static_cast<int>(x)); }
+  static T Add(T a, T b) { return _mm256_add_epi32(a, b); }
+  static T Xor(T a, T b) { return _mm256_xor_si256(a, b); }
+  template <int n>
+  static T Rotr(T x) {
+    return _mm256_or_si256(_mm256_srli_epi32(x, n),
+                           _mm256_slli_epi32(x, 32 - n));
+  }
+};
+#endif
+
+#ifdef TINK_SUBTLE_BLAKE3_SSE41
+struct Sse41Lanes {
+  using T = __m128i;
+  static constexpr int kLanes = 4;
+  static T Load(const uint32_t* p) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  }
+  static void Store(uint32_t* p, T x) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x);
+  }
+  static T Set1(uint32_t x) { return _mm_set1_epi32(static_cast<int>(x)); }
+  static T Add(T a, T b) { return _mm_add_epi32(a, b); }
+  static T Xor(T a, T b) { return _mm_xor_si128(a, b); }
+  template <int n>
+  static T Rotr(T x) {
+    return _mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - n));
+  }
+};
+#endif
+
+#ifdef TINK_SUBTLE_BLAKE3_NEON
+struct NeonLanes {
+  using T = uint32x4_t;
+  static constexpr int kLanes = 4;
+  static T Load(const uint32_t* p) { return vld1q_u32(p); }
+  static void Store(uint32_t* p, T x) { vst1q_u32(p, x); }
+  static T Set1(uint32_t x) { return vdupq_n_u32(x); }
+  static T Add(T a, T b) { return vaddq_u32(a, b); }
+  static T Xor(T a, T b) { return veorq_u32(a, b); }
+  template <int n>
+  static T Rotr(T x) {
+    return vsriq_n_u32(vshlq_n_u32(x, 32 - n), x, n);
+  }
+};
+#endif
+
+struct ChunkImplementation {
+  const char* name;
+  // The number of chunks compressed at once, a power of two.
+  size_t degree;
+  HashChunksFunction hash_chunks;
+};
+
+enum ImplementationIndex : uint8_t { kPortable, kSse41, kAvx2, kNeon };
+
+const ChunkImplementation& GetImplementation(uint8_t index) {
+  static const ChunkImplementation kPortableImplementation = {
+      "portable", 1, HashChunksPortable};
+  switch (index) {
+#ifdef TINK_SUBTLE_BLAKE3_SSE41
+    case kSse41: {
+      static const ChunkImplementation kSse41Implementation = {
+          "sse41", Sse41Lanes::kLanes, HashChunksSimd<Sse41Lanes>};
+      return kSse41Implementation;
+    }
+#endif
+#ifdef TINK_SUBTLE_BLAKE3_AVX2
+    case kAvx2: {
+      static const ChunkImplementation kAvx2Implementation = {
+          "avx2", Avx2Lanes::kLanes, HashChunksSimd<Avx2Lanes>};
+      return kAvx2Implementation;
+    }
+#endif
+#ifdef TINK_SUBTLE_BLAKE3_NEON
+    case kNeon: {
+      static const ChunkImplementation kNeonImplementation = {
+          "neon", NeonLanes::kLanes, HashChunksSimd<NeonLanes>};
+      return kNeonImplementation;
+    }
+#endif
+    default:
+      return kPortableImplementation;
+  }
+}
+
+uint8_t ChooseImplementation() {
+  if (GetDispatchPolicy() == DispatchPolicy::kPortableOnly) return kPortable;
+#ifdef TINK_SUBTLE_BLAKE3_AVX2
+  if (GetCpuFeatures().avx2) return kAvx2;
+#endif
+#ifdef TINK_SUBTLE_BLAKE3_SSE41
+  if (GetCpuFeatures().sse41) return kSse41;
+#endif
+#ifdef TINK_SUBTLE_BLAKE3_NEON
+  // NEON is part of every ARMv8 CPU.
+  return kNeon;
+#endif
+  return kPortable;
+}
+
+// Computes the chaining value of the subtree of 'num_chunks' full chunks at
+// 'input', where 'num_chunks' is a power of two.
+void SubtreeChainingValue(const ChunkImplementation& implementation,
+                          const uint8_t* input, size_t num_chunks,
+                          const uint32_t key[8], uint64_t counter,
+                          uint8_t flags, uint32_t out[8]) {
+  if (num_chunks <= implementation.degree) {
+    uint32_t cvs[8][8];
+    implementation.hash_chunks(input, num_chunks, key, counter, flags, cvs);
+    for (size_t n = num_chunks; n > 1; n /= 2) {
+      for (size_t i = 0; i < n / 2; i++) {
+        ParentChainingValue(cvs[2 * i], cvs[2 * i + 1], key, flags, cvs[i]);
+      }
+    }
+    std::memcpy(out, cvs[0], 8 * sizeof(uint32_t));
+    return;
+  }
+  const size_t half = num_chunks / 2;
+  uint32_t left[8];
+  uint32_t right[8];
+  SubtreeChainingValue(implementation, input, half, key, counter, flags,
+                       left);
+  SubtreeChainingValue(implementation, input + half * kChunkSize, half, key,
+                       counter + half, flags, right);
+  ParentChainingValue(left, right, key, flags, out);
+}
+
+// Computes the chaining values of the two halves of the subtree of
+// 'num_chunks' full chunks at 'input', where 'num_chunks' is a power of two
+// and at least 2. If 'executor' is not null and the subtree is large enough,
+// it is split into equal subtrees of at least kMinParallelSubtreeSize bytes,
+// at most one per thread of 'executor' and the calling thread, which are
+// hashed with Executor::ParallelFor().
+void ChildChainingValues(const ChunkImplementation& implementation,
+                         const uint8_t* input, size_t num_chunks,
+                         const uint32_t key[8], uint64_t counter,
+                         uint8_t flags, Executor* executor, uint32_t left[8],
+                         uint32_t right[8]) {
+  constexpr size_t kMinParallelChunks =
+      Blake3Hasher::kMinParallelSubtreeSize / kChunkSize;
+  size_t parts = 1;
+  if (executor != nullptr) {
+    const size_t max_parts =
+        static_cast<size_t>(std::max(executor->num_threads(), 0)) + 1;
+    while (parts * 2 <= max_parts &&
+           num_chunks / (parts * 2) >= kMinParallelChunks) {
+      parts *= 2;
+    }
+  }
+  const size_t half = num_chunks / 2;
+  if (parts < 2) {
+    SubtreeChainingValue(implementation, input, half, key, counter, flags,
+                         left);
+    SubtreeChainingValue(implementation, input + half * kChunkSize, half, key,
+                         counter + half, flags, right);
+    return;
+  }
+  const size_t part_chunks = num_chunks / parts;
+  std::vector<std::array<uint32_t, 8>> cvs(parts);
+  executor->ParallelFor(parts, [&](int i) {
+    SubtreeChainingValue(implementation, input + i * part_chunks * kChunkSize,
+                         part_chunks, key, counter + i * part_chunks, flags,
+                         cvs[i].data());
+  });
+  for (size_t n = parts; n > 2; n /= 2) {
+    for (size_t i = 0; i < n / 2; i++) {
+      ParentChainingValue(cvs[2 * i].data(), cvs[2 * i + 1].data(), key,
+                          flags, cvs[i].data());
+    }
+  }
+  std::memcpy(left, cvs[0].data(), 8 * sizeof(uint32_t));
+  std::memcpy(right, cvs[1].data(), 8 * sizeof(uint32_t));
+  util::SafeZeroMemory(reinterpret_cast<char*>(cvs.data()),
+                       cvs.size() * sizeof(cvs[0]));
+}
+
+int PopCount(uint64_t x) {
+  int count = 0;
+  for (; x != 0; x &= x - 1) count++;
+  return count;
+}
+
+}  // namespace
+
+Blake3Hasher::Blake3Hasher() { Init(kIv, 0); }
+
+Blake3Hasher::Blake3Hasher(const util::SecretData& key) {
+  uint32_t key_words[8];
+  for (int i = 0; i < 8; i++) key_words[i] = LoadLe32(key.data() + 4 * i);
+  Init(key_words, kKeyedHash);
+  util::SafeZeroMemory(reinterpret_cast<char*>(key_words), sizeof(key_words));
+}
+
+Blake3Hasher::~Blake3Hasher() {
+  util::SafeZeroMemory(reinterpret_cast<char*>(key_), sizeof(key_));
+  util::SafeZeroMemory(reinterpret_cast<char*>(chunk_cv_), sizeof(chunk_cv_));
+  util::SafeZeroMemory(reinterpret_cast<char*>(block_), sizeof(block_));
+  util::SafeZeroMemory(reinterpret_cast<char*>(cv_stack_),
+                       cv_stack_size_ * sizeof(cv_stack_[0]));
+}
+
+void Blake3Hasher::Init(const uint32_t key[8], uint8_t flags) {
+  std::memcpy(key_, key, sizeof(key_));
+  flags_ = flags;
+  implementation_ = ChooseImplementation();
+  std::memcpy(chunk_cv_, key_, sizeof(chunk_cv_));
+  chunk_counter_ = 0;
+  std::memset(block_, 0, sizeof(block_));
+  block_size_ = 0;
+  blocks_compressed_ = 0;
+  cv_stack_size_ = 0;
+}
+
+void Blake3Hasher::SetExecutor(std::shared_ptr<Executor> executor) {
+  executor_ = std::move(executor);
+}
+
+// static
+const char* Blake3Hasher::Implementation() {
+  return GetImplementation(ChooseImplementation()).name;
+}
+
+void Blake3Hasher::MergeChainingValues(uint64_t total_chunks) {
+  // Merging lazily, only before a chaining value is pushed, keeps the
+  // chaining values of the last subtree available for Finalize(), which must
+  // compress the root node with the root flag.
+  const int merged_size = PopCount(total_chunks);
+  while (cv_stack_size_ > merged_size) {
+    ParentChainingValue(cv_stack_[cv_stack_size_ - 2],
+                        cv_stack_[cv_stack_size_ - 1], key_, flags_,
+                        cv_stack_[cv_stack_size_ - 2]);
+    cv_stack_size_--;
+  }
+}
+
+void Blake3Hasher::PushChainingValue(const uint32_t cv[8],
+                                     uint64_t chunk_counter) {
+  MergeChainingValues(chunk_counter);
+  std::memcpy(cv_stack_[cv_stack_size_++], cv, sizeof(cv_stack_[0]));
+}
+
+void Blake3Hasher::UpdateChunk(const uint8_t* data, size_t size) {
+  while (size > 0) {
+    if (block_size_ == kBlockSize) {
+      uint8_t block_flags = flags_;
+      if (blocks_compressed_ == 0) block_flags |= kChunkStart;
+      CompressInPlace(chunk_cv_, block_, chunk_counter_, kBlockSize,
+                      block_flags);
+      blocks_compressed_++;
+      block_size_ = 0;
+      std::memset(block_, 0, sizeof(block_));
+    }
+    size_t n = std::min(kBlockSize - block_size_, size);
+    std::memcpy(block_ + block_size_, data, n);
+    block_size_ += n;
+    data += n;
+    size -= n;
+  }
+}
+
+void Blake3Hasher::Update(absl::string_view data) {
+  const uint8_t* input = reinterpret_cast<const uint8_t*>(data.data());
+  size_t size = data.size();
+  size_t chunk_size = blocks_compressed_ * kBlockSize + block_size_;
+  if (chunk_size > 0) {
+    size_t n = std::min(kChunkSize - chunk_size, size);
+    UpdateChunk(input, n);
+    input += n;
+    size -= n;
+    if (size == 0) return;
+    // The chunk is complete and not the last one.
+    Output output = {};
+    std::memcpy(output.cv, chunk_cv_, sizeof(output.cv));
+    std::memcpy(output.block, block_, sizeof(output.block));
+    output.counter = chunk_counter_;
+    output.block_size = block_size_;
+    output.flags = flags_ | kChunkEnd;
+    if (blocks_compressed_ == 0) output.flags |= kChunkStart;
+    uint32_t cv[8];
+    output.ChainingValue(cv);
+    PushChainingValue(cv, chunk_counter_);
+    std::memcpy(chunk_cv_, key_, sizeof(chunk_cv_));
+    chunk_counter_++;
+    std::memset(block_, 0, sizeof(block_));
+    block_size_ = 0;
+    blocks_compressed_ = 0;
+  }
+
+  // Hashes the largest subtrees which are aligned to their size and leave
+  // at least one byte for the chunk state, which must hold the last chunk.
+  const ChunkImplementation& implementation =
+      GetImplementation(implementation_);
+  while (size > kChunkSize) {
+    uint64_t subtree_chunks = 1;
+    while (subtree_chunks * 2 <= size / kChunkSize) subtree_chunks *= 2;
+    while ((chunk_counter_ & (subtree_chunks - 1)) != 0) subtree_chunks /= 2;
+    if (subtree_chunks == 1) {
+      uint32_t cv[1][8];
+      implementation.hash_chunks(input, 1, key_, chunk_counter_, flags_, cv);
+      PushChainingValue(cv[0], chunk_counter_);
+    } else {
+      // Both halves are pushed, as the subtree may be the root of the tree.
+      uint32_t left[8];
+      uint32_t right[8];
+      ChildChainingValues(implementation, input, subtree_chunks, key_,
+                          chunk_counter_, flags_, executor_.get(), left,
+                          right);
+      PushChainingValue(left, chunk_counter_);
+      PushChainingValue(right, chunk_counter_ + subtree_chunks / 2);
+    }
+    chunk_counter_ += subtree_chunks;
+    input += subtree_chunks * kChunkSize;
+    size -= subtree_chunks * kChunkSize;
+  }
+
+  if (size > 0) {
+    UpdateChunk(input, size);
+    MergeChainingValues(chunk_counter_);
+  }
+}
+
+void Blake3Hasher::Finalize(absl::Span<uint8_t> out) const {
+  const size_t chunk_size = blocks_compressed_ * kBlockSize + block_size_;
+  Output output;
+  size_t remaining;
+  if (chunk_size > 0 || cv_stack_size_ == 0) {
+    std::memcpy(output.cv, chunk_cv_, sizeof(output.cv));
+    std::memcpy(output.block, block_, sizeof(output.block));
+    output.counter = chunk_counter_;
+    output.block_size = block_size_;
+    output.flags = flags_ | kChunkEnd;
+    if (blocks_compressed_ == 0) output.flags |= kChunkStart;
+    remaining = cv_stack_size_;
+  } else {
+    output = ParentOutput(cv_stack_[cv_stack_size_ - 2],
+                          cv_stack_[cv_stack_size_ - 1], key_, flags_);
+    remaining = cv_stack_size_ - 2;
+  }
+  while (remaining > 0) {
+    remaining--;
+    uint32_t cv[8];
+    output.ChainingValue(cv);
+    output = ParentOutput(cv_stack_[remaining], cv, key_, flags_);
+  }
+  output.RootBytes(out);
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
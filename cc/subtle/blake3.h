@@ -0,0 +1,115 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_BLAKE3_H_
+#define TINK_SUBTLE_BLAKE3_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/executor.h"
+#include "tink/util/secret_data.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// BLAKE3 (https://github.com/BLAKE3-team/BLAKE3-specs) in its hash and keyed
+// hash modes, with extendable output.
+//
+// BLAKE3 splits its input into 1 KiB chunks, which are the leaves of a binary
+// tree. The chunks are independent of each other, so Update() compresses
+// several full chunks at once with SIMD instructions (AVX2, SSE4.1 or NEON,
+// as far as they are compiled in, supported by the CPU and allowed by the
+// dispatch policy). With an executor (cf. SetExecutor()), inputs of at least
+// twice kMinParallelSubtreeSize bytes are additionally split into subtrees
+// which are hashed on the threads of the executor.
+//
+// Blake3Hasher is thread-compatible: copies of it can be used concurrently,
+// e.g. a keyed hasher which is copied for every message.
+class Blake3Hasher {
+ public:
+  static constexpr size_t kKeySizeInBytes = 32;
+  static constexpr size_t kDefaultOutputSizeInBytes = 32;
+  static constexpr size_t kChunkSizeInBytes = 1024;
+  // Subtrees of this many bytes and more may be hashed on separate threads.
+  static constexpr size_t kMinParallelSubtreeSize = 256 * 1024;
+
+  // Hash mode.
+  Blake3Hasher();
+  // Keyed hash mode. 'key' must be kKeySizeInBytes long.
+  explicit Blake3Hasher(const util::SecretData& key);
+
+  Blake3Hasher(const Blake3Hasher&) = default;
+  Blake3Hasher& operator=(const Blake3Hasher&) = default;
+  ~Blake3Hasher();
+
+  void Update(absl::string_view data);
+
+  // Writes the first out.size() bytes of the output for the data passed to
+  // Update() so far. Does not change the state, so more data can be added
+  // afterwards.
+  void Finalize(absl::Span<uint8_t> out) const;
+
+  // Sets the executor on which Update() hashes the subtrees of large inputs,
+  // along with the calling thread. Update() must then not be called from a
+  // task of 'executor' (cf. Executor::ParallelFor()). Without an executor,
+  // which is the default, Update() only uses the calling thread. Copies of
+  // the hasher share the executor.
+  void SetExecutor(std::shared_ptr<Executor> executor);
+
+  // Returns the name of the implementation which compresses the chunks of
+  // hashers created now, e.g. "avx2" or "portable".
+  static const char* Implementation();
+
+ private:
+  // Largest number of chaining values on the stack: one per level of a tree
+  // of 2^64 bytes.
+  static constexpr int kMaxDepth = 54;
+
+  void Init(const uint32_t key[8], uint8_t flags);
+  // Appends the chaining value of the chunk or subtree ending before chunk
+  // 'chunk_counter', merging the completed subtrees on the stack before.
+  void PushChainingValue(const uint32_t cv[8], uint64_t chunk_counter);
+  void MergeChainingValues(uint64_t total_chunks);
+  void UpdateChunk(const uint8_t* data, size_t size);
+
+  uint32_t key_[8];
+  uint8_t flags_;
+  // Index of the chunk compression implementation, chosen on construction.
+  uint8_t implementation_;
+
+  // The chunk currently being hashed.
+  uint32_t chunk_cv_[8];
+  uint64_t chunk_counter_;
+  uint8_t block_[64];
+  uint8_t block_size_;
+  uint8_t blocks_compressed_;
+
+  uint8_t cv_stack_size_;
+  uint32_t cv_stack_[kMaxDepth][8];
+
+  std::shared_ptr<Executor> executor_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_BLAKE3_H_
@@ -0,0 +1,134 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/blake3_mac.h"
+
+#include <algorithm>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "openssl/mem.h"
+#include "tink/mac.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+util::Status ValidateParameters(const util::SecretData& key,
+                                uint32_t tag_size) {
+  if (key.size() != Blake3Hasher::kKeySizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
+  }
+  if (tag_size < Blake3Mac::kMinTagSizeInBytes ||
+      tag_size > Blake3Mac::kMaxTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid tag size");
+  }
+  return util::OkStatus();
+}
+
+// Returns a hasher keyed with 'key', or an unkeyed one if 'key' has the wrong
+// size, which is never used.
+Blake3Hasher KeyedHasherOrDefault(const util::SecretData& key) {
+  if (key.size() != Blake3Hasher::kKeySizeInBytes) return Blake3Hasher();
+  return Blake3Hasher(key);
+}
+
+}  // namespace
+
+// static
+util::StatusOr<std::unique_ptr<Mac>> Blake3Mac::New(
+    const util::SecretData& key, uint32_t tag_size) {
+  auto status = CheckFipsCompatibility<Blake3Mac>();
+  if (!status.ok()) return status;
+  status = ValidateParameters(key, tag_size);
+  if (!status.ok()) return status;
+  return {absl::WrapUnique(new Blake3Mac(key, tag_size))};
+}
+
+util::StatusOr<std::string> Blake3Mac::ComputeMac(
+    absl::string_view data) const {
+  std::string tag(tag_size_, '\0');
+  auto written_or = ComputeMacInto(
+      data, absl::MakeSpan(reinterpret_cast<uint8_t*>(&tag[0]), tag.size()));
+  if (!written_or.ok()) return written_or.status();
+  return tag;
+}
+
+util::StatusOr<int64_t> Blake3Mac::ComputeMacInto(
+    absl::string_view data, absl::Span<uint8_t> tag) const {
+  if (tag.size() < tag_size_) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Tag buffer too small");
+  }
+  Blake3Hasher hasher = hasher_;
+  hasher.Update(data);
+  hasher.Finalize(tag.subspan(0, tag_size_));
+  return tag_size_;
+}
+
+util::Status Blake3Mac::VerifyMac(absl::string_view mac,
+                                  absl::string_view data) const {
+  if (mac.size() != tag_size_) {
+    return util::Status(util::error::INVALID_ARGUMENT, "incorrect tag size");
+  }
+  uint8_t buf[kMaxTagSizeInBytes];
+  auto written_or = ComputeMacInto(data, absl::MakeSpan(buf, tag_size_));
+  if (!written_or.ok()) return written_or.status();
+  if (CRYPTO_memcmp(buf, mac.data(), tag_size_) != 0) {
+    return util::Status(util::error::INVALID_ARGUMENT, "verification failed");
+  }
+  return util::OkStatus();
+}
+
+// static
+util::StatusOr<std::unique_ptr<StatefulMac>> StatefulBlake3Mac::New(
+    const util::SecretData& key, uint32_t tag_size) {
+  auto status = ValidateParameters(key, tag_size);
+  if (!status.ok()) return status;
+  return std::unique_ptr<StatefulMac>(
+      new StatefulBlake3Mac(Blake3Hasher(key), tag_size));
+}
+
+util::Status StatefulBlake3Mac::Update(absl::string_view data) {
+  hasher_.Update(data);
+  return util::OkStatus();
+}
+
+util::StatusOr<std::string> StatefulBlake3Mac::Finalize() {
+  std::string tag(tag_size_, '\0');
+  hasher_.Finalize(
+      absl::MakeSpan(reinterpret_cast<uint8_t*>(&tag[0]), tag.size()));
+  return tag;
+}
+
+StatefulBlake3MacFactory::StatefulBlake3MacFactory(const util::SecretData& key,
+                                                   uint32_t tag_size)
+    : status_(ValidateParameters(key, tag_size)),
+      hasher_(KeyedHasherOrDefault(key)),
+      tag_size_(tag_size) {}
+
+util::StatusOr<std::unique_ptr<StatefulMac>> StatefulBlake3MacFactory::Create()
+    const {
+  if (!status_.ok()) return status_;
+  return std::unique_ptr<StatefulMac>(new StatefulBlake3Mac(hasher_, tag_size_));
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,108 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_BLAKE3_MAC_H_
+#define TINK_SUBTLE_BLAKE3_MAC_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/config/tink_fips.h"
+#include "tink/mac.h"
+#include "tink/subtle/blake3.h"
+#include "tink/subtle/mac/stateful_mac.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// The MAC of BLAKE3 in keyed hash mode: the tag is the first 'tag_size'
+// bytes of the keyed hash of the data.
+class Blake3Mac : public Mac {
+ public:
+  static constexpr uint32_t kMinTagSizeInBytes = 10;
+  static constexpr uint32_t kMaxTagSizeInBytes = 32;
+
+  // 'key' must be 32 bytes long.
+  static crypto::tink::util::StatusOr<std::unique_ptr<Mac>> New(
+      const util::SecretData& key, uint32_t tag_size);
+
+  crypto::tink::util::StatusOr<std::string> ComputeMac(
+      absl::string_view data) const override;
+
+  crypto::tink::util::Status VerifyMac(absl::string_view mac,
+                                       absl::string_view data) const override;
+
+  crypto::tink::util::StatusOr<int64_t> ComputeMacInto(
+      absl::string_view data, absl::Span<uint8_t> tag) const override;
+
+  using Mac::VerifyMac;
+
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kNotFips;
+
+ private:
+  Blake3Mac(const util::SecretData& key, uint32_t tag_size)
+      : hasher_(key), tag_size_(tag_size) {}
+
+  // A keyed hasher without data; each call works on a copy of it.
+  const Blake3Hasher hasher_;
+  const uint32_t tag_size_;
+};
+
+// The StatefulMac of Blake3Mac, e.g. for StreamingMacImpl.
+class StatefulBlake3Mac : public StatefulMac {
+ public:
+  static util::StatusOr<std::unique_ptr<StatefulMac>> New(
+      const util::SecretData& key, uint32_t tag_size);
+
+  util::Status Update(absl::string_view data) override;
+  util::StatusOr<std::string> Finalize() override;
+
+ private:
+  friend class StatefulBlake3MacFactory;
+
+  StatefulBlake3Mac(const Blake3Hasher& hasher, uint32_t tag_size)
+      : hasher_(hasher), tag_size_(tag_size) {}
+
+  Blake3Hasher hasher_;
+  const uint32_t tag_size_;
+};
+
+class StatefulBlake3MacFactory : public StatefulMacFactory {
+ public:
+  StatefulBlake3MacFactory(const util::SecretData& key, uint32_t tag_size);
+  util::StatusOr<std::unique_ptr<StatefulMac>> Create() const override;
+
+ private:
+  // Error from validating the parameters in the constructor, returned by
+  // Create().
+  util::Status status_;
+  const Blake3Hasher hasher_;
+  const uint32_t tag_size_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_BLAKE3_MAC_H_
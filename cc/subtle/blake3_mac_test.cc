@@ -0,0 +1,167 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/blake3_mac.h"
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/streaming_mac_impl.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::HexDecodeOrDie;
+using ::crypto::tink::test::HexEncode;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+using ::testing::Not;
+
+// The keyed hash of the one byte input 0x00 in the official BLAKE3 test
+// vectors.
+constexpr char kKey[] = "whats the Elvish word for friend";
+constexpr char kData[] = "00";
+constexpr char kTag[] =
+    "6d7878dfff2f485635d39013278ae14f1454b8c0a3a2d34bc1ab38228a80c95b";
+
+class Blake3MacTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (kUseOnlyFips) {
+      GTEST_SKIP() << "Not supported in FIPS-only mode";
+    }
+  }
+};
+
+TEST_F(Blake3MacTest, ComputeAndVerify) {
+  for (uint32_t tag_size : {10, 16, 32}) {
+    SCOPED_TRACE(tag_size);
+    auto mac_or =
+        Blake3Mac::New(util::SecretDataFromStringView(kKey), tag_size);
+    ASSERT_THAT(mac_or.status(), IsOk());
+    auto& mac = mac_or.ValueOrDie();
+    std::string data = HexDecodeOrDie(kData);
+    auto tag_or = mac->ComputeMac(data);
+    ASSERT_THAT(tag_or.status(), IsOk());
+    EXPECT_THAT(HexEncode(tag_or.ValueOrDie()),
+                Eq(std::string(kTag).substr(0, 2 * tag_size)));
+    EXPECT_THAT(mac->VerifyMac(tag_or.ValueOrDie(), data), IsOk());
+
+    std::string modified_tag = tag_or.ValueOrDie();
+    modified_tag[0] ^= 1;
+    EXPECT_THAT(mac->VerifyMac(modified_tag, data),
+                StatusIs(util::error::INVALID_ARGUMENT));
+    EXPECT_THAT(mac->VerifyMac(tag_or.ValueOrDie(), "other data"),
+                StatusIs(util::error::INVALID_ARGUMENT));
+    EXPECT_THAT(mac->VerifyMac(tag_or.ValueOrDie().substr(1), data),
+                StatusIs(util::error::INVALID_ARGUMENT));
+  }
+}
+
+TEST_F(Blake3MacTest, ComputeMacInto) {
+  auto mac = std::move(
+      Blake3Mac::New(util::SecretDataFromStringView(kKey), 32).ValueOrDie());
+  uint8_t tag[40];
+  auto written_or = mac->ComputeMacInto(HexDecodeOrDie(kData), tag);
+  ASSERT_THAT(written_or.status(), IsOk());
+  EXPECT_THAT(written_or.ValueOrDie(), Eq(32));
+  EXPECT_THAT(mac->VerifyMac(absl::MakeConstSpan(tag, 32), HexDecodeOrDie(kData)),
+              IsOk());
+  EXPECT_THAT(mac->ComputeMacInto(HexDecodeOrDie(kData),
+                                  absl::MakeSpan(tag, 31))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(Blake3MacTest, InvalidParameters) {
+  EXPECT_THAT(Blake3Mac::New(util::SecretData(16, 'k'), 16).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(Blake3Mac::New(util::SecretData(33, 'k'), 16).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(Blake3Mac::New(util::SecretData(32, 'k'), 9).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(Blake3Mac::New(util::SecretData(32, 'k'), 33).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(StatefulBlake3Mac::New(util::SecretData(31, 'k'), 16).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(
+      StatefulBlake3MacFactory(util::SecretData(31, 'k'), 16).Create().status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(Blake3MacTest, StatefulMacMatchesMac) {
+  const util::SecretData key = util::SecretData(32, 'k');
+  auto mac = std::move(Blake3Mac::New(key, 16).ValueOrDie());
+  std::string data(5000, 'd');
+  std::string expected = mac->ComputeMac(data).ValueOrDie();
+
+  auto stateful_mac = std::move(StatefulBlake3Mac::New(key, 16).ValueOrDie());
+  for (size_t pos = 0; pos < data.size(); pos += 700) {
+    ASSERT_THAT(stateful_mac->Update(data.substr(pos, 700)), IsOk());
+  }
+  EXPECT_THAT(stateful_mac->Finalize().ValueOrDie(), Eq(expected));
+
+  StatefulBlake3MacFactory factory(key, 16);
+  for (int i = 0; i < 2; i++) {
+    auto created = std::move(factory.Create().ValueOrDie());
+    ASSERT_THAT(created->Update(data), IsOk());
+    EXPECT_THAT(created->Finalize().ValueOrDie(), Eq(expected));
+  }
+}
+
+TEST_F(Blake3MacTest, StreamingMac) {
+  const util::SecretData key = util::SecretData(32, 'k');
+  std::string data(100000, 'd');
+  std::string expected =
+      Blake3Mac::New(key, 32).ValueOrDie()->ComputeMac(data).ValueOrDie();
+  StreamingMacImpl streaming_mac(
+      absl::make_unique<StatefulBlake3MacFactory>(key, 32));
+
+  auto compute_stream =
+      std::move(streaming_mac.NewComputeMacOutputStream().ValueOrDie());
+  ASSERT_THAT(test::WriteToStream(compute_stream.get(), data, false), IsOk());
+  auto tag_or = compute_stream->CloseAndGetResult();
+  ASSERT_THAT(tag_or.status(), IsOk());
+  EXPECT_THAT(tag_or.ValueOrDie(), Eq(expected));
+
+  auto verify_stream =
+      std::move(streaming_mac.NewVerifyMacOutputStream(expected).ValueOrDie());
+  ASSERT_THAT(test::WriteToStream(verify_stream.get(), data, false), IsOk());
+  EXPECT_THAT(verify_stream->CloseAndGetResult(), IsOk());
+
+  verify_stream = std::move(
+      streaming_mac.NewVerifyMacOutputStream(std::string(32, 'x'))
+          .ValueOrDie());
+  ASSERT_THAT(test::WriteToStream(verify_stream.get(), data, false), IsOk());
+  EXPECT_THAT(verify_stream->CloseAndGetResult(), Not(IsOk()));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
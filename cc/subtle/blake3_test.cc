@@ -0,0 +1,206 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/blake3.h"
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/subtle/cpu_features.h"
+#include "tink/thread_pool_executor.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::HexEncode;
+using ::testing::Eq;
+using ::testing::Ne;
+
+// The input of the official BLAKE3 test vectors.
+std::string TestInput(size_t size) {
+  std::string input(size, '\0');
+  for (size_t i = 0; i < size; i++) input[i] = static_cast<char>(i % 251);
+  return input;
+}
+
+util::SecretData TestKey() {
+  return util::SecretDataFromStringView("whats the Elvish word for friend");
+}
+
+std::string Output(const Blake3Hasher& hasher, size_t size) {
+  std::string output(size, '\0');
+  hasher.Finalize(
+      absl::MakeSpan(reinterpret_cast<uint8_t*>(&output[0]), output.size()));
+  return output;
+}
+
+std::string KeyedHash(absl::string_view input, size_t size = 32) {
+  Blake3Hasher hasher(TestKey());
+  hasher.Update(input);
+  return Output(hasher, size);
+}
+
+// From https://github.com/BLAKE3-team/BLAKE3/blob/master/test_vectors.
+struct TestVector {
+  size_t input_size;
+  const char* keyed_hash;
+};
+
+const TestVector kTestVectors[] = {
+    {0, "92b2b75604ed3c761f9d6f62392c8a9227ad0ea3f09573e783f1498a4ed60d26"},
+    {1, "6d7878dfff2f485635d39013278ae14f1454b8c0a3a2d34bc1ab38228a80c95b"},
+    {63, "bb1eb5d4afa793c1ebdd9fb08def6c36d10096986ae0cfe148cd101170ce37ae"},
+    {64, "ba8ced36f327700d213f120b1a207a3b8c04330528586f414d09f2f7d9ccb7e6"},
+    {65, "c0a4edefa2d2accb9277c371ac12fcdbb52988a86edc54f0716e1591b4326e72"},
+    {1023,
+     "c951ecdf03288d0fcc96ee3413563d8a6d3589547f2c2fb36d9786470f1b9d6e"},
+    {1024,
+     "75c46f6f3d9eb4f55ecaaee480db732e6c2105546f1e675003687c31719c7ba4"},
+    {1025,
+     "357dc55de0c7e382c900fd6e320acc04146be01db6a8ce7210b7189bd664ea69"},
+    {2048,
+     "879cf1fa2ea0e79126cb1063617a05b6ad9d0b696d0d757cf053439f60a99dd1"},
+    {2049,
+     "9f29700902f7c86e514ddc4df1e3049f258b2472b6dd5267f61bf13983b78dd5"},
+    {3072,
+     "044a0e7b172a312dc02a4c9a818c036ffa2776368d7f528268d2e6b5df191770"},
+    {3073,
+     "68dede9bef00ba89e43f31a6825f4cf433389fedae75c04ee9f0cf16a427c95a"},
+    {4096,
+     "befc660aea2f1718884cd8deb9902811d332f4fc4a38cf7c7300d597a081bfc0"},
+    {4097,
+     "00df940cd36bb9fa7cbbc3556744e0dbc8191401afe70520ba292ee3ca80abbc"},
+    {5120,
+     "2c493e48e9b9bf31e0553a22b23503c0a3388f035cece68eb438d22fa1943e20"},
+    {5121,
+     "6ccf1c34753e7a044db80798ecd0782a8f76f33563accaddbfbb2e0ea4b2d024"},
+    {6144,
+     "3d6b6d21281d0ade5b2b016ae4034c5dec10ca7e475f90f76eac7138e9bc8f1d"},
+    {6145,
+     "9ac301e9e39e45e3250a7e3b3df701aa0fb6889fbd80eeecf28dbc6300fbc539"},
+    {7168,
+     "b42835e40e9d4a7f42ad8cc04f85a963a76e18198377ed84adddeaecacc6f3fc"},
+    {7169,
+     "ed9b1a922c046fdb3d423ae34e143b05ca1bf28b710432857bf738bcedbfa511"},
+    {8192,
+     "dc9637c8845a770b4cbf76b8daec0eebf7dc2eac11498517f08d44c8fc00d58a"},
+    {8193,
+     "954a2a75420c8d6547e3ba5b98d963e6fa6491addc8c023189cc519821b4a1f5"},
+    {16384,
+     "9e9fc4eb7cf081ea7c47d1807790ed211bfec56aa25bb7037784c13c4b707b0d"},
+    {31744,
+     "efa53b389ab67c593dba624d898d0f7353ab99e4ac9d42302ee64cbf9939a419"},
+    {102400,
+     "1c35d1a5811083fd7119f5d5d1ba027b4d01c0c6c49fb6ff2cf75393ea5db4a7"},
+};
+
+TEST(Blake3Test, Hash) {
+  Blake3Hasher hasher;
+  EXPECT_THAT(
+      HexEncode(Output(hasher, 32)),
+      Eq("af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262"));
+  hasher.Update("abc");
+  EXPECT_THAT(
+      HexEncode(Output(hasher, 32)),
+      Eq("6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85"));
+
+  Blake3Hasher long_hasher;
+  long_hasher.Update(TestInput(8193));
+  EXPECT_THAT(
+      HexEncode(Output(long_hasher, 32)),
+      Eq("bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b"));
+}
+
+TEST(Blake3Test, KeyedHash) {
+  for (const TestVector& vector : kTestVectors) {
+    SCOPED_TRACE(vector.input_size);
+    EXPECT_THAT(HexEncode(KeyedHash(TestInput(vector.input_size))),
+                Eq(vector.keyed_hash));
+  }
+}
+
+TEST(Blake3Test, ExtendedOutput) {
+  std::string output = KeyedHash(TestInput(1025), 131);
+  EXPECT_THAT(
+      HexEncode(output),
+      Eq("357dc55de0c7e382c900fd6e320acc04146be01db6a8ce7210b7189bd664ea69"
+         "362396b77fdc0d2634a552970843722066c3c15902ae5097e00ff53f1e116f1c"
+         "d5352720113a837ab2452cafbde4d54085d9cf5d21ca613071551b25d52e69d6"
+         "c81123872b6f19cd3bc1333edf0c52b94de23ba772cf82636cff4542540a7738"
+         "d5b930"));
+  // Shorter outputs are prefixes of longer ones.
+  EXPECT_THAT(KeyedHash(TestInput(1025), 7), Eq(output.substr(0, 7)));
+}
+
+TEST(Blake3Test, IncrementalUpdates) {
+  const std::string input = TestInput(102400);
+  const std::string expected = KeyedHash(input);
+  for (size_t piece : {1, 63, 64, 65, 1000, 1024, 1025, 4096, 5000}) {
+    SCOPED_TRACE(piece);
+    Blake3Hasher hasher(TestKey());
+    for (size_t pos = 0; pos < input.size(); pos += piece) {
+      hasher.Update(absl::string_view(input).substr(pos, piece));
+    }
+    EXPECT_THAT(Output(hasher, 32), Eq(expected));
+  }
+}
+
+TEST(Blake3Test, FinalizeDoesNotChangeState) {
+  const std::string input = TestInput(5000);
+  Blake3Hasher hasher(TestKey());
+  hasher.Update(absl::string_view(input).substr(0, 3000));
+  EXPECT_THAT(Output(hasher, 32),
+              Eq(KeyedHash(absl::string_view(input).substr(0, 3000))));
+  Blake3Hasher copy = hasher;
+  hasher.Update(absl::string_view(input).substr(3000));
+  EXPECT_THAT(Output(hasher, 32), Eq(KeyedHash(input)));
+  EXPECT_THAT(Output(copy, 32), Ne(Output(hasher, 32)));
+}
+
+TEST(Blake3Test, PortableImplementation) {
+  const std::string input = TestInput(102400 + 17);
+  const std::string expected = KeyedHash(input);
+  SetDispatchPolicy(DispatchPolicy::kPortableOnly);
+  EXPECT_THAT(Blake3Hasher::Implementation(), Eq(std::string("portable")));
+  std::string portable = KeyedHash(input);
+  SetDispatchPolicy(DispatchPolicy::kFastest);
+  EXPECT_THAT(portable, Eq(expected));
+}
+
+TEST(Blake3Test, Executor) {
+  const std::string input =
+      TestInput(4 * Blake3Hasher::kMinParallelSubtreeSize + 3000);
+  const std::string expected = KeyedHash(input);
+  for (int num_threads : {0, 1, 3}) {
+    SCOPED_TRACE(num_threads);
+    Blake3Hasher hasher(TestKey());
+    hasher.SetExecutor(NewThreadPoolExecutor(num_threads));
+    hasher.Update(input);
+    EXPECT_THAT(Output(hasher, 32), Eq(expected));
+  }
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,347 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/chacha20_poly1305_hkdf_streaming.h"
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/aead.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/hkdf.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+using Streaming = ChaCha20Poly1305HkdfStreaming;
+
+constexpr int kHeaderSizeInBytes =
+    1 + Streaming::kKeySizeInBytes + Streaming::kNoncePrefixSizeInBytes;
+
+std::string NonceForSegment(absl::string_view nonce_prefix,
+                            int64_t segment_number, bool is_last_segment) {
+  return absl::StrCat(nonce_prefix, BigEndian32(segment_number),
+                      is_last_segment ? std::string(1, '\x01')
+                                      : std::string(1, '\x00'));
+}
+
+util::Status CheckSegmentNumber(int64_t segment_number, bool is_last_segment) {
+  if (segment_number < 0 ||
+      segment_number > std::numeric_limits<uint32_t>::max() ||
+      (segment_number == std::numeric_limits<uint32_t>::max() &&
+       !is_last_segment)) {
+    return util::Status(util::error::INVALID_ARGUMENT, "too many segments");
+  }
+  return util::OkStatus();
+}
+
+// Derives the key of the stream with the salt 'salt', and returns a
+// ChaCha20-Poly1305 context for it.
+util::StatusOr<bssl::UniquePtr<EVP_AEAD_CTX>> NewStreamContext(
+    const util::SecretData& ikm, HashType hkdf_hash, absl::string_view salt,
+    absl::string_view associated_data) {
+  auto hkdf_result = Hkdf::ComputeHkdf(hkdf_hash, ikm, salt, associated_data,
+                                       Streaming::kKeySizeInBytes);
+  if (!hkdf_result.ok()) return hkdf_result.status();
+  const util::SecretData& key = hkdf_result.ValueOrDie();
+  bssl::UniquePtr<EVP_AEAD_CTX> ctx(
+      EVP_AEAD_CTX_new(EVP_aead_chacha20_poly1305(), key.data(), key.size(),
+                       Streaming::kTagSizeInBytes));
+  if (!ctx) {
+    return util::Status(util::error::INTERNAL,
+                        "could not initialize EVP_AEAD_CTX");
+  }
+  return std::move(ctx);
+}
+
+util::Status Validate(const Streaming::Params& params) {
+  if (params.ikm.size() < Streaming::kKeySizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "input key material too small");
+  }
+  if (!(params.hkdf_hash == SHA1 || params.hkdf_hash == SHA256 ||
+        params.hkdf_hash == SHA512)) {
+    return util::Status(util::error::INVALID_ARGUMENT, "unsupported hkdf_hash");
+  }
+  if (params.ciphertext_offset < 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "ciphertext_offset must be non-negative");
+  }
+  if (params.ciphertext_segment_size <=
+      params.ciphertext_offset + kHeaderSizeInBytes +
+          Streaming::kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "ciphertext_segment_size too small");
+  }
+  return util::OkStatus();
+}
+
+}  // namespace
+
+// ChaCha20Poly1305HkdfStreaming
+// static
+util::StatusOr<std::unique_ptr<ChaCha20Poly1305HkdfStreaming>>
+ChaCha20Poly1305HkdfStreaming::New(Params params) {
+  auto status = CheckFipsCompatibility<ChaCha20Poly1305HkdfStreaming>();
+  if (!status.ok()) return status;
+
+  status = Validate(params);
+  if (!status.ok()) return status;
+  return {absl::WrapUnique(
+      new ChaCha20Poly1305HkdfStreaming(std::move(params)))};
+}
+
+util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+ChaCha20Poly1305HkdfStreaming::NewSegmentEncrypter(
+    absl::string_view associated_data) const {
+  return ChaCha20Poly1305HkdfStreamSegmentEncrypter::New(params_,
+                                                         associated_data);
+}
+
+util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+ChaCha20Poly1305HkdfStreaming::NewSegmentEncrypterForHeader(
+    absl::string_view header, absl::string_view associated_data) const {
+  return ChaCha20Poly1305HkdfStreamSegmentEncrypter::NewForHeader(
+      params_, header, associated_data);
+}
+
+util::StatusOr<std::unique_ptr<StreamSegmentDecrypter>>
+ChaCha20Poly1305HkdfStreaming::NewSegmentDecrypter(
+    absl::string_view associated_data) const {
+  return ChaCha20Poly1305HkdfStreamSegmentDecrypter::New(params_,
+                                                         associated_data);
+}
+
+// ChaCha20Poly1305HkdfStreamSegmentEncrypter
+// static
+util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+ChaCha20Poly1305HkdfStreamSegmentEncrypter::New(
+    const ChaCha20Poly1305HkdfStreaming::Params& params,
+    absl::string_view associated_data) {
+  std::string header = absl::StrCat(
+      std::string(1, static_cast<char>(kHeaderSizeInBytes)),
+      Random::GetRandomBytes(Streaming::kKeySizeInBytes),
+      Random::GetRandomBytes(Streaming::kNoncePrefixSizeInBytes));
+  return NewForHeader(params, header, associated_data);
+}
+
+// static
+util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+ChaCha20Poly1305HkdfStreamSegmentEncrypter::NewForHeader(
+    const ChaCha20Poly1305HkdfStreaming::Params& params,
+    absl::string_view header, absl::string_view associated_data) {
+  auto status = Validate(params);
+  if (!status.ok()) return status;
+  if (header.size() != kHeaderSizeInBytes ||
+      static_cast<uint8_t>(header[0]) != kHeaderSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid header");
+  }
+  auto ctx_result =
+      NewStreamContext(params.ikm, params.hkdf_hash,
+                       header.substr(1, Streaming::kKeySizeInBytes),
+                       associated_data);
+  if (!ctx_result.ok()) return ctx_result.status();
+  return {absl::WrapUnique(new ChaCha20Poly1305HkdfStreamSegmentEncrypter(
+      std::move(ctx_result.ValueOrDie()), header,
+      header.substr(1 + Streaming::kKeySizeInBytes),
+      params.ciphertext_segment_size, params.ciphertext_offset))};
+}
+
+util::Status ChaCha20Poly1305HkdfStreamSegmentEncrypter::EncryptSegment(
+    const std::vector<uint8_t>& plaintext, bool is_last_segment,
+    std::vector<uint8_t>* ciphertext_buffer) {
+  util::Status status = EncryptSegmentAt(segment_number_, plaintext,
+                                         is_last_segment, ciphertext_buffer);
+  if (!status.ok()) return status;
+  IncSegmentNumber();
+  return util::OkStatus();
+}
+
+util::Status ChaCha20Poly1305HkdfStreamSegmentEncrypter::EncryptSegmentAt(
+    int64_t segment_number, const std::vector<uint8_t>& plaintext,
+    bool is_last_segment, std::vector<uint8_t>* ciphertext_buffer) const {
+  if (plaintext.size() > get_plaintext_segment_size()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "plaintext too long");
+  }
+  if (ciphertext_buffer == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "ciphertext_buffer must be non-null");
+  }
+  ciphertext_buffer->resize(plaintext.size() + Streaming::kTagSizeInBytes);
+  return Seal(segment_number, plaintext, is_last_segment,
+              absl::MakeSpan(*ciphertext_buffer));
+}
+
+util::Status ChaCha20Poly1305HkdfStreamSegmentEncrypter::EncryptSegmentInto(
+    absl::Span<const uint8_t> plaintext, bool is_last_segment,
+    absl::Span<uint8_t> ciphertext) {
+  if (ciphertext.size() != plaintext.size() + Streaming::kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "ciphertext has the wrong size");
+  }
+  util::Status status =
+      Seal(segment_number_, plaintext, is_last_segment, ciphertext);
+  if (!status.ok()) return status;
+  IncSegmentNumber();
+  return util::OkStatus();
+}
+
+util::Status ChaCha20Poly1305HkdfStreamSegmentEncrypter::Seal(
+    int64_t segment_number, absl::Span<const uint8_t> plaintext,
+    bool is_last_segment, absl::Span<uint8_t> ciphertext) const {
+  if (plaintext.size() > get_plaintext_segment_size()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "plaintext too long");
+  }
+  auto status = CheckSegmentNumber(segment_number, is_last_segment);
+  if (!status.ok()) return status;
+
+  std::string nonce =
+      NonceForSegment(nonce_prefix_, segment_number, is_last_segment);
+  // BoringSSL supports sealing in place, with 'ciphertext' starting at the
+  // same address as 'plaintext'.
+  size_t out_len;
+  if (!EVP_AEAD_CTX_seal(ctx_.get(), ciphertext.data(), &out_len,
+                         ciphertext.size(),
+                         reinterpret_cast<const uint8_t*>(nonce.data()),
+                         nonce.size(), plaintext.data(), plaintext.size(),
+                         /* ad = */ nullptr, /* ad.length() = */ 0)) {
+    return util::Status(util::error::INTERNAL,
+                        absl::StrCat("Encryption failed: ",
+                                     SubtleUtilBoringSSL::GetErrors()));
+  }
+  return util::OkStatus();
+}
+
+// ChaCha20Poly1305HkdfStreamSegmentDecrypter
+// static
+util::StatusOr<std::unique_ptr<StreamSegmentDecrypter>>
+ChaCha20Poly1305HkdfStreamSegmentDecrypter::New(
+    const ChaCha20Poly1305HkdfStreaming::Params& params,
+    absl::string_view associated_data) {
+  auto status = Validate(params);
+  if (!status.ok()) return status;
+  return {absl::WrapUnique(new ChaCha20Poly1305HkdfStreamSegmentDecrypter(
+      params.ikm, params.hkdf_hash, associated_data,
+      params.ciphertext_segment_size, params.ciphertext_offset))};
+}
+
+util::Status ChaCha20Poly1305HkdfStreamSegmentDecrypter::Init(
+    const std::vector<uint8_t>& header) {
+  if (is_initialized_) {
+    return util::Status(util::error::FAILED_PRECONDITION,
+                        "decrypter already initialized");
+  }
+  if (header.size() != get_header_size()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        absl::StrCat("wrong header size, expected ",
+                                     get_header_size(), " bytes"));
+  }
+  if (header[0] != header.size()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "corrupted header");
+  }
+  absl::string_view header_view(reinterpret_cast<const char*>(header.data()),
+                                header.size());
+  auto ctx_result = NewStreamContext(
+      ikm_, hkdf_hash_, header_view.substr(1, Streaming::kKeySizeInBytes),
+      associated_data_);
+  if (!ctx_result.ok()) return ctx_result.status();
+  ctx_ = std::move(ctx_result.ValueOrDie());
+  nonce_prefix_ =
+      std::string(header_view.substr(1 + Streaming::kKeySizeInBytes));
+  is_initialized_ = true;
+  return util::OkStatus();
+}
+
+util::Status ChaCha20Poly1305HkdfStreamSegmentDecrypter::DecryptSegment(
+    const std::vector<uint8_t>& ciphertext, int64_t segment_number,
+    bool is_last_segment, std::vector<uint8_t>* plaintext_buffer) {
+  // Keep reporting these errors ahead of a null plaintext_buffer.
+  if (!is_initialized_) {
+    return util::Status(util::error::FAILED_PRECONDITION,
+                        "decrypter not initialized");
+  }
+  if (ciphertext.size() > get_ciphertext_segment_size()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too long");
+  }
+  if (plaintext_buffer == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "plaintext_buffer must be non-null");
+  }
+  const size_t tag_size = Streaming::kTagSizeInBytes;
+  plaintext_buffer->resize(
+      ciphertext.size() > tag_size ? ciphertext.size() - tag_size : 0);
+  return DecryptSegmentInto(ciphertext, segment_number, is_last_segment,
+                            absl::MakeSpan(*plaintext_buffer));
+}
+
+util::Status ChaCha20Poly1305HkdfStreamSegmentDecrypter::DecryptSegmentInto(
+    absl::Span<const uint8_t> ciphertext, int64_t segment_number,
+    bool is_last_segment, absl::Span<uint8_t> plaintext) {
+  if (!is_initialized_) {
+    return util::Status(util::error::FAILED_PRECONDITION,
+                        "decrypter not initialized");
+  }
+  if (ciphertext.size() > get_ciphertext_segment_size()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too long");
+  }
+  if (ciphertext.size() < Streaming::kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too short");
+  }
+  if (plaintext.size() != ciphertext.size() - Streaming::kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "plaintext has the wrong size");
+  }
+  auto status = CheckSegmentNumber(segment_number, is_last_segment);
+  if (!status.ok()) return status;
+
+  std::string nonce =
+      NonceForSegment(nonce_prefix_, segment_number, is_last_segment);
+  // BoringSSL supports opening in place.
+  size_t out_len;
+  if (!EVP_AEAD_CTX_open(ctx_.get(), plaintext.data(), &out_len,
+                         plaintext.size(),
+                         reinterpret_cast<const uint8_t*>(nonce.data()),
+                         nonce.size(), ciphertext.data(), ciphertext.size(),
+                         /* ad = */ nullptr, /* ad.length() = */ 0)) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        absl::StrCat("Decryption failed: ",
+                                     SubtleUtilBoringSSL::GetErrors()));
+  }
+  if (out_len != plaintext.size()) {
+    return util::Status(util::error::INTERNAL, "incorrect plaintext size");
+  }
+  return util::OkStatus();
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
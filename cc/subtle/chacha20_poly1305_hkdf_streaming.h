@@ -0,0 +1,243 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_CHACHA20_POLY1305_HKDF_STREAMING_H_
+#define TINK_SUBTLE_CHACHA20_POLY1305_HKDF_STREAMING_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/nonce_based_streaming_aead.h"
+#include "tink/subtle/stream_segment_decrypter.h"
+#include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// Streaming encryption using ChaCha20-Poly1305 (RFC 8439) with HKDF as key
+// derivation function. Unlike AesGcmHkdfStreaming it does not need AES
+// instructions to be fast.
+//
+// Each ciphertext uses a new 32 byte ChaCha20-Poly1305 key that is derived
+// from the key derivation key, a randomly chosen salt of 32 bytes and the
+// associated data using HKDF.
+//
+// The format of a ciphertext is
+//   header || segment_0 || segment_1 || ... || segment_k.
+// where:
+//  - segment_i is the i-th segment of the ciphertext.
+//  - the size of segment_1 .. segment_{k-1} is get_ciphertext_segment_size()
+//  - segment_0 is shorter, so that segment_0, the header and other information
+//    of size get_ciphertext_offset() align with get_ciphertext_segment_size().
+//
+// The format of the header is
+//   header_size || salt || nonce_prefix
+// where
+//  - header_size is 1 byte determining the size of the header
+//  - salt is a salt used in the key derivation
+//  - nonce_prefix is the prefix of the nonce
+class ChaCha20Poly1305HkdfStreaming : public NonceBasedStreamingAead {
+ public:
+  struct Params {
+    util::SecretData ikm;
+    HashType hkdf_hash;
+    int ciphertext_segment_size;
+    int ciphertext_offset;
+  };
+
+  // The size of the derived keys, and of the salt.
+  static constexpr int kKeySizeInBytes = 32;
+
+  // The size of the nonces of ChaCha20-Poly1305.
+  static constexpr int kNonceSizeInBytes = 12;
+
+  // The nonce has the format nonce_prefix || ctr || last_block, where:
+  //  - nonce_prefix is a constant of kNoncePrefixSizeInBytes bytes
+  //    for the whole file
+  //  - ctr is a big endian 32 bit counter
+  //  - last_block is a byte equal to 1 for the last block of the file
+  //    and 0 otherwise.
+  static constexpr int kNoncePrefixSizeInBytes = 7;
+
+  // The size of the tags of each ciphertext segment.
+  static constexpr int kTagSizeInBytes = 16;
+
+  static util::StatusOr<std::unique_ptr<ChaCha20Poly1305HkdfStreaming>> New(
+      Params params);
+
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kNotFips;
+
+ protected:
+  util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>> NewSegmentEncrypter(
+      absl::string_view associated_data) const override;
+
+  util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+  NewSegmentEncrypterForHeader(
+      absl::string_view header,
+      absl::string_view associated_data) const override;
+
+  util::StatusOr<std::unique_ptr<StreamSegmentDecrypter>> NewSegmentDecrypter(
+      absl::string_view associated_data) const override;
+
+ private:
+  explicit ChaCha20Poly1305HkdfStreaming(Params params)
+      : params_(std::move(params)) {}
+  const Params params_;
+};
+
+class ChaCha20Poly1305HkdfStreamSegmentEncrypter
+    : public StreamSegmentEncrypter {
+ public:
+  // A factory.
+  static util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>> New(
+      const ChaCha20Poly1305HkdfStreaming::Params& params,
+      absl::string_view associated_data);
+
+  // Like New(), but continues the stream that starts with 'header', i.e.
+  // uses the same key and nonce prefix as the encrypter that produced it.
+  static util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>> NewForHeader(
+      const ChaCha20Poly1305HkdfStreaming::Params& params,
+      absl::string_view header, absl::string_view associated_data);
+
+  // Overridden methods of StreamSegmentEncrypter.
+  util::Status EncryptSegment(const std::vector<uint8_t>& plaintext,
+                              bool is_last_segment,
+                              std::vector<uint8_t>* ciphertext_buffer) override;
+
+  util::Status EncryptSegmentAt(
+      int64_t segment_number, const std::vector<uint8_t>& plaintext,
+      bool is_last_segment,
+      std::vector<uint8_t>* ciphertext_buffer) const override;
+
+  util::Status EncryptSegmentInto(absl::Span<const uint8_t> plaintext,
+                                  bool is_last_segment,
+                                  absl::Span<uint8_t> ciphertext) override;
+
+  const std::vector<uint8_t>& get_header() const override { return header_; }
+  int64_t get_segment_number() const override { return segment_number_; }
+  int get_plaintext_segment_size() const override {
+    return ciphertext_segment_size_ -
+           ChaCha20Poly1305HkdfStreaming::kTagSizeInBytes;
+  }
+  int get_ciphertext_segment_size() const override {
+    return ciphertext_segment_size_;
+  }
+  int get_ciphertext_offset() const override { return ciphertext_offset_; }
+
+ protected:
+  void IncSegmentNumber() override { segment_number_++; }
+
+ private:
+  ChaCha20Poly1305HkdfStreamSegmentEncrypter(
+      bssl::UniquePtr<EVP_AEAD_CTX> ctx, absl::string_view header,
+      absl::string_view nonce_prefix, int ciphertext_segment_size,
+      int ciphertext_offset)
+      : ctx_(std::move(ctx)),
+        header_(header.begin(), header.end()),
+        nonce_prefix_(nonce_prefix),
+        ciphertext_segment_size_(ciphertext_segment_size),
+        ciphertext_offset_(ciphertext_offset) {}
+
+  // Encrypts 'plaintext' as the segment number 'segment_number' into
+  // 'ciphertext', which is kTagSizeInBytes longer.
+  util::Status Seal(int64_t segment_number,
+                    absl::Span<const uint8_t> plaintext, bool is_last_segment,
+                    absl::Span<uint8_t> ciphertext) const;
+
+  const bssl::UniquePtr<EVP_AEAD_CTX> ctx_;
+  const std::vector<uint8_t> header_;
+  const std::string nonce_prefix_;
+  const int ciphertext_segment_size_;
+  const int ciphertext_offset_;
+  int64_t segment_number_ = 0;
+};
+
+class ChaCha20Poly1305HkdfStreamSegmentDecrypter
+    : public StreamSegmentDecrypter {
+ public:
+  // A factory.
+  static util::StatusOr<std::unique_ptr<StreamSegmentDecrypter>> New(
+      const ChaCha20Poly1305HkdfStreaming::Params& params,
+      absl::string_view associated_data);
+
+  // Overridden methods of StreamSegmentDecrypter.
+  util::Status Init(const std::vector<uint8_t>& header) override;
+
+  util::Status DecryptSegment(const std::vector<uint8_t>& ciphertext,
+                              int64_t segment_number, bool is_last_segment,
+                              std::vector<uint8_t>* plaintext_buffer) override;
+
+  util::Status DecryptSegmentInto(absl::Span<const uint8_t> ciphertext,
+                                  int64_t segment_number,
+                                  bool is_last_segment,
+                                  absl::Span<uint8_t> plaintext) override;
+
+  int get_header_size() const override {
+    return 1 + ChaCha20Poly1305HkdfStreaming::kKeySizeInBytes +
+           ChaCha20Poly1305HkdfStreaming::kNoncePrefixSizeInBytes;
+  }
+  int get_plaintext_segment_size() const override {
+    return ciphertext_segment_size_ -
+           ChaCha20Poly1305HkdfStreaming::kTagSizeInBytes;
+  }
+  int get_ciphertext_segment_size() const override {
+    return ciphertext_segment_size_;
+  }
+  int get_ciphertext_offset() const override { return ciphertext_offset_; }
+
+ private:
+  ChaCha20Poly1305HkdfStreamSegmentDecrypter(util::SecretData ikm,
+                                             HashType hkdf_hash,
+                                             absl::string_view associated_data,
+                                             int ciphertext_segment_size,
+                                             int ciphertext_offset)
+      : ikm_(std::move(ikm)),
+        hkdf_hash_(hkdf_hash),
+        associated_data_(associated_data),
+        ciphertext_segment_size_(ciphertext_segment_size),
+        ciphertext_offset_(ciphertext_offset) {}
+
+  // Parameters set upon decrypter creation.
+  const util::SecretData ikm_;
+  const HashType hkdf_hash_;
+  const std::string associated_data_;
+  const int ciphertext_segment_size_;
+  const int ciphertext_offset_;
+
+  // Parameters set when initializing with data from stream header.
+  bool is_initialized_ = false;
+  std::string nonce_prefix_;
+  bssl::UniquePtr<EVP_AEAD_CTX> ctx_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_CHACHA20_POLY1305_HKDF_STREAMING_H_
@@ -0,0 +1,339 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/chacha20_poly1305_hkdf_streaming.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "openssl/aead.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/hkdf.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/stream_segment_decrypter.h"
+#include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/subtle/streaming_aead_test_util.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::HasSubstr;
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+constexpr int kTagSize = ChaCha20Poly1305HkdfStreaming::kTagSizeInBytes;
+
+ChaCha20Poly1305HkdfStreaming::Params ValidParams() {
+  ChaCha20Poly1305HkdfStreaming::Params params;
+  params.ikm = Random::GetRandomKeyBytes(32);
+  params.hkdf_hash = SHA256;
+  params.ciphertext_segment_size = 256;
+  params.ciphertext_offset = 0;
+  return params;
+}
+
+TEST(ChaCha20Poly1305HkdfStreamSegmentTest, EncryptDecrypt) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  for (HashType hkdf_hash : {SHA1, SHA256, SHA512}) {
+    for (int ciphertext_segment_size : {80, 128, 200}) {
+      for (int ciphertext_offset : {0, 5, 10}) {
+        SCOPED_TRACE(absl::StrCat(
+            "hkdf_hash = ", EnumToString(hkdf_hash),
+            ", ciphertext_segment_size = ", ciphertext_segment_size,
+            ", ciphertext_offset = ", ciphertext_offset));
+        ChaCha20Poly1305HkdfStreaming::Params params = ValidParams();
+        params.hkdf_hash = hkdf_hash;
+        params.ciphertext_segment_size = ciphertext_segment_size;
+        params.ciphertext_offset = ciphertext_offset;
+        std::string associated_data = "associated data";
+
+        auto enc_result = ChaCha20Poly1305HkdfStreamSegmentEncrypter::New(
+            params, associated_data);
+        ASSERT_THAT(enc_result.status(), IsOk());
+        auto enc = std::move(enc_result.ValueOrDie());
+        auto dec_result = ChaCha20Poly1305HkdfStreamSegmentDecrypter::New(
+            params, associated_data);
+        ASSERT_THAT(dec_result.status(), IsOk());
+        auto dec = std::move(dec_result.ValueOrDie());
+        ASSERT_THAT(dec->Init(enc->get_header()), IsOk());
+        EXPECT_EQ(1 + 32 + 7, dec->get_header_size());
+        EXPECT_EQ(enc->get_header().size(), dec->get_header_size());
+        EXPECT_EQ(ciphertext_segment_size - kTagSize,
+                  dec->get_plaintext_segment_size());
+        EXPECT_EQ(ciphertext_offset, dec->get_ciphertext_offset());
+
+        int segment_number = 0;
+        for (int pt_size : {0, 1, 10, dec->get_plaintext_segment_size()}) {
+          for (bool is_last_segment : {false, true}) {
+            std::vector<uint8_t> pt(pt_size, 'p');
+            std::vector<uint8_t> ct;
+            std::vector<uint8_t> decrypted;
+            ASSERT_THAT(enc->EncryptSegment(pt, is_last_segment, &ct), IsOk());
+            EXPECT_EQ(ct.size(), pt.size() + kTagSize);
+            EXPECT_THAT(dec->DecryptSegment(ct, segment_number,
+                                            is_last_segment, &decrypted),
+                        IsOk());
+            EXPECT_EQ(pt, decrypted);
+            // The segment number and the last segment flag are
+            // authenticated.
+            EXPECT_FALSE(dec->DecryptSegment(ct, segment_number + 1,
+                                             is_last_segment, &decrypted)
+                             .ok());
+            EXPECT_FALSE(dec->DecryptSegment(ct, segment_number,
+                                             !is_last_segment, &decrypted)
+                             .ok());
+            segment_number++;
+            EXPECT_EQ(segment_number, enc->get_segment_number());
+          }
+        }
+      }
+    }
+  }
+}
+
+// Checks the format of the ciphertext: each segment is the ChaCha20-Poly1305
+// encryption of the plaintext segment under the key that HKDF derives from
+// the salt in the header, with the nonce
+// nonce_prefix || big endian segment number || last segment flag.
+TEST(ChaCha20Poly1305HkdfStreamSegmentTest, CiphertextFormat) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  ChaCha20Poly1305HkdfStreaming::Params params = ValidParams();
+  std::string associated_data = "associated data";
+  auto enc = std::move(ChaCha20Poly1305HkdfStreamSegmentEncrypter::New(
+                           params, associated_data)
+                           .ValueOrDie());
+  const std::vector<uint8_t>& header = enc->get_header();
+  ASSERT_EQ(header.size(), 40);
+  EXPECT_EQ(header[0], 40);
+  std::string salt(header.begin() + 1, header.begin() + 33);
+  auto key = Hkdf::ComputeHkdf(SHA256, params.ikm, salt, associated_data, 32)
+                 .ValueOrDie();
+  bssl::UniquePtr<EVP_AEAD_CTX> ctx(EVP_AEAD_CTX_new(
+      EVP_aead_chacha20_poly1305(), key.data(), key.size(), kTagSize));
+  ASSERT_NE(ctx, nullptr);
+
+  std::vector<uint8_t> pt(100, 'p');
+  std::vector<uint8_t> ct;
+  ASSERT_THAT(enc->EncryptSegmentAt(0x01020304, pt, true, &ct), IsOk());
+  std::vector<uint8_t> nonce(header.begin() + 33, header.end());
+  for (uint8_t b : {0x01, 0x02, 0x03, 0x04, 0x01}) nonce.push_back(b);
+  std::vector<uint8_t> expected_ct(pt.size() + kTagSize);
+  size_t len;
+  ASSERT_EQ(1, EVP_AEAD_CTX_seal(ctx.get(), expected_ct.data(), &len,
+                                 expected_ct.size(), nonce.data(),
+                                 nonce.size(), pt.data(), pt.size(), nullptr,
+                                 0));
+  EXPECT_EQ(expected_ct, ct);
+}
+
+TEST(ChaCha20Poly1305HkdfStreamSegmentTest, EncryptDecryptInPlace) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  ChaCha20Poly1305HkdfStreaming::Params params = ValidParams();
+  std::string associated_data = "associated data";
+  auto enc = std::move(ChaCha20Poly1305HkdfStreamSegmentEncrypter::New(
+                           params, associated_data)
+                           .ValueOrDie());
+  auto dec = std::move(ChaCha20Poly1305HkdfStreamSegmentDecrypter::New(
+                           params, associated_data)
+                           .ValueOrDie());
+  ASSERT_THAT(dec->Init(enc->get_header()), IsOk());
+
+  int segment_number = 0;
+  for (int pt_size : {0, 1, 10, enc->get_plaintext_segment_size()}) {
+    for (bool is_last_segment : {false, true}) {
+      SCOPED_TRACE(absl::StrCat("plaintext_size = ", pt_size,
+                                ", is_last_segment = ", is_last_segment));
+      std::vector<uint8_t> pt(pt_size, 'p');
+      std::vector<uint8_t> expected_ct;
+      ASSERT_THAT(enc->EncryptSegmentAt(segment_number, pt, is_last_segment,
+                                        &expected_ct),
+                  IsOk());
+
+      std::vector<uint8_t> segment(pt);
+      segment.resize(pt_size + kTagSize);
+      ASSERT_THAT(enc->EncryptSegmentInto(
+                      absl::MakeConstSpan(segment.data(), pt_size),
+                      is_last_segment, absl::MakeSpan(segment)),
+                  IsOk());
+      EXPECT_EQ(expected_ct, segment);
+      EXPECT_EQ(segment_number + 1, enc->get_segment_number());
+
+      ASSERT_THAT(dec->DecryptSegmentInto(
+                      absl::MakeConstSpan(segment), segment_number,
+                      is_last_segment, absl::MakeSpan(segment.data(), pt_size)),
+                  IsOk());
+      segment.resize(pt_size);
+      EXPECT_EQ(pt, segment);
+      segment_number++;
+    }
+  }
+}
+
+TEST(ChaCha20Poly1305HkdfStreamSegmentTest, DecrypterErrors) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  ChaCha20Poly1305HkdfStreaming::Params params = ValidParams();
+  auto enc = std::move(
+      ChaCha20Poly1305HkdfStreamSegmentEncrypter::New(params, "ad")
+          .ValueOrDie());
+  auto dec = std::move(
+      ChaCha20Poly1305HkdfStreamSegmentDecrypter::New(params, "ad")
+          .ValueOrDie());
+  std::vector<uint8_t> ct;
+  ASSERT_THAT(enc->EncryptSegment(std::vector<uint8_t>(10), true, &ct),
+              IsOk());
+  std::vector<uint8_t> pt;
+  EXPECT_THAT(dec->DecryptSegment(ct, 0, true, &pt),
+              StatusIs(util::error::FAILED_PRECONDITION,
+                       HasSubstr("not initialized")));
+
+  std::vector<uint8_t> header = enc->get_header();
+  EXPECT_THAT(dec->Init(std::vector<uint8_t>(header.begin(), header.end() - 1)),
+              StatusIs(util::error::INVALID_ARGUMENT,
+                       HasSubstr("wrong header size")));
+  header[0]++;
+  EXPECT_THAT(dec->Init(header),
+              StatusIs(util::error::INVALID_ARGUMENT,
+                       HasSubstr("corrupted header")));
+  ASSERT_THAT(dec->Init(enc->get_header()), IsOk());
+  EXPECT_THAT(dec->Init(enc->get_header()),
+              StatusIs(util::error::FAILED_PRECONDITION,
+                       HasSubstr("already initialized")));
+
+  EXPECT_THAT(dec->DecryptSegment(ct, 0, true, &pt), IsOk());
+  ct[0] ^= 1;
+  EXPECT_THAT(dec->DecryptSegment(ct, 0, true, &pt),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(
+      dec->DecryptSegment(std::vector<uint8_t>(kTagSize - 1), 0, true, &pt),
+      StatusIs(util::error::INVALID_ARGUMENT, HasSubstr("too short")));
+
+  // The key depends on the associated data.
+  auto other_dec = std::move(
+      ChaCha20Poly1305HkdfStreamSegmentDecrypter::New(params, "other ad")
+          .ValueOrDie());
+  ASSERT_THAT(other_dec->Init(enc->get_header()), IsOk());
+  ct[0] ^= 1;
+  EXPECT_FALSE(other_dec->DecryptSegment(ct, 0, true, &pt).ok());
+}
+
+TEST(ChaCha20Poly1305HkdfStreamingTest, EncryptThenDecrypt) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  for (int ciphertext_segment_size : {80, 128, 4096}) {
+    for (int ciphertext_offset : {0, 5}) {
+      for (int plaintext_size : {0, 10, 100, 1000, 20000}) {
+        SCOPED_TRACE(absl::StrCat(
+            "ciphertext_segment_size = ", ciphertext_segment_size,
+            ", ciphertext_offset = ", ciphertext_offset,
+            ", plaintext_size = ", plaintext_size));
+        ChaCha20Poly1305HkdfStreaming::Params params = ValidParams();
+        params.ciphertext_segment_size = ciphertext_segment_size;
+        params.ciphertext_offset = ciphertext_offset;
+        auto result = ChaCha20Poly1305HkdfStreaming::New(std::move(params));
+        ASSERT_THAT(result.status(), IsOk());
+        auto streaming_aead = std::move(result.ValueOrDie());
+        std::string plaintext = Random::GetRandomBytes(plaintext_size);
+        EXPECT_THAT(EncryptThenDecrypt(streaming_aead.get(),
+                                       streaming_aead.get(), plaintext,
+                                       "associated data", ciphertext_offset),
+                    IsOk());
+      }
+    }
+  }
+}
+
+TEST(ChaCha20Poly1305HkdfStreamingTest, RandomAccessEncrypterForHeader) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto streaming_aead = std::move(
+      ChaCha20Poly1305HkdfStreaming::New(ValidParams()).ValueOrDie());
+  auto first_result = streaming_aead->NewRandomAccessEncrypter("ad");
+  ASSERT_THAT(first_result.status(), IsOk());
+  std::string header(first_result.ValueOrDie()->header().begin(),
+                     first_result.ValueOrDie()->header().end());
+  EXPECT_THAT(
+      streaming_aead->NewRandomAccessEncrypterForHeader(header, "ad").status(),
+      IsOk());
+  EXPECT_THAT(streaming_aead->NewRandomAccessEncrypterForHeader("header", "ad")
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(ChaCha20Poly1305HkdfStreamingTest, InvalidParams) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  ChaCha20Poly1305HkdfStreaming::Params params = ValidParams();
+  params.ikm = Random::GetRandomKeyBytes(16);
+  EXPECT_THAT(ChaCha20Poly1305HkdfStreaming::New(std::move(params)).status(),
+              StatusIs(util::error::INVALID_ARGUMENT,
+                       HasSubstr("key material")));
+
+  params = ValidParams();
+  params.hkdf_hash = SHA384;
+  EXPECT_THAT(ChaCha20Poly1305HkdfStreaming::New(std::move(params)).status(),
+              StatusIs(util::error::INVALID_ARGUMENT, HasSubstr("hkdf_hash")));
+
+  params = ValidParams();
+  params.ciphertext_offset = -1;
+  EXPECT_THAT(ChaCha20Poly1305HkdfStreaming::New(std::move(params)).status(),
+              StatusIs(util::error::INVALID_ARGUMENT,
+                       HasSubstr("ciphertext_offset")));
+
+  params = ValidParams();
+  params.ciphertext_segment_size = 1 + 32 + 7 + kTagSize;
+  EXPECT_THAT(ChaCha20Poly1305HkdfStreaming::New(std::move(params)).status(),
+              StatusIs(util::error::INVALID_ARGUMENT,
+                       HasSubstr("ciphertext_segment_size")));
+}
+
+TEST(ChaCha20Poly1305HkdfStreamingTest, TestFipsOnly) {
+  if (!kUseOnlyFips) {
+    GTEST_SKIP() << "Only supported in FIPS-only mode";
+  }
+  EXPECT_THAT(ChaCha20Poly1305HkdfStreaming::New(ValidParams()).status(),
+              StatusIs(util::error::INTERNAL));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
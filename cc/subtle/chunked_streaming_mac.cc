@@ -0,0 +1,259 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/chunked_streaming_mac.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "openssl/mem.h"
+#include "tink/internal/thread_pool.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+constexpr char kChunkPrefix = 0x00;
+constexpr char kFinalPrefix = 0x01;
+
+std::string BigEndian64(uint64_t val) {
+  return BigEndian32(val >> 32) + BigEndian32(val & 0xffffffff);
+}
+
+// Computes the tag of the data written to a ChunkedStreamingMac stream.
+// Buffers up to 'parallelism' chunks, and MACs them once the buffer is
+// full.
+class ChunkedMacWriter {
+ public:
+  ChunkedMacWriter(std::shared_ptr<StatefulMacFactory> mac_factory,
+                   int chunk_size, int parallelism)
+      : mac_factory_(std::move(mac_factory)),
+        chunk_size_(chunk_size),
+        buffer_(static_cast<size_t>(chunk_size) * parallelism, '\0'),
+        buffer_position_(0),
+        last_buffer_size_(0),
+        position_(0),
+        chunk_count_(0) {
+    if (parallelism > 1) {
+      pool_ = absl::make_unique<internal::ThreadPool>(parallelism - 1);
+    }
+  }
+
+  util::StatusOr<int> Next(void** data);
+  void BackUp(int count);
+  int64_t Position() const { return position_; }
+  // Returns the tag of the data written so far.
+  util::StatusOr<std::string> Finalize();
+
+ private:
+  // MACs the data in buffer_ as consecutive chunks, of which only the last
+  // may be shorter than chunk_size_, appends the chunk tags to tags_, and
+  // clears buffer_.
+  util::Status MacBufferedChunks();
+
+  const std::shared_ptr<StatefulMacFactory> mac_factory_;
+  const int chunk_size_;
+  std::unique_ptr<internal::ThreadPool> pool_;  // null if parallelism is 1
+  util::Status status_;  // the first error of Next(), if any
+  std::string buffer_;
+  int buffer_position_;   // # bytes of data in buffer_
+  int last_buffer_size_;  // # bytes returned by the last Next()
+  int64_t position_;
+  int64_t chunk_count_;
+  std::string tags_;  // concatenated tags of the chunks MACed so far
+};
+
+util::StatusOr<int> ChunkedMacWriter::Next(void** data) {
+  if (!status_.ok()) return status_;
+  if (buffer_position_ == buffer_.size()) {
+    status_ = MacBufferedChunks();
+    if (!status_.ok()) return status_;
+  }
+  *data = &buffer_[buffer_position_];
+  last_buffer_size_ = buffer_.size() - buffer_position_;
+  buffer_position_ = buffer_.size();
+  position_ += last_buffer_size_;
+  return last_buffer_size_;
+}
+
+void ChunkedMacWriter::BackUp(int count) {
+  count = std::max(0, std::min(count, last_buffer_size_));
+  last_buffer_size_ -= count;
+  buffer_position_ -= count;
+  position_ -= count;
+}
+
+util::Status ChunkedMacWriter::MacBufferedChunks() {
+  int count = (buffer_position_ + chunk_size_ - 1) / chunk_size_;
+  // The MACs are created on this thread, as factories need not be
+  // thread-safe.
+  std::vector<std::unique_ptr<StatefulMac>> macs;
+  for (int i = 0; i < count; i++) {
+    auto mac_result = mac_factory_->Create();
+    if (!mac_result.ok()) return mac_result.status();
+    macs.push_back(std::move(mac_result.ValueOrDie()));
+  }
+  std::vector<util::StatusOr<std::string>> tags(
+      count, util::Status(util::error::INTERNAL, "chunk not MACed"));
+  auto mac_chunk = [this, &macs, &tags](int i) {
+    int begin = i * chunk_size_;
+    int size = std::min(chunk_size_, buffer_position_ - begin);
+    util::Status status = macs[i]->Update(
+        std::string(1, kChunkPrefix) + BigEndian64(chunk_count_ + i));
+    if (status.ok()) {
+      status = macs[i]->Update(absl::string_view(&buffer_[begin], size));
+    }
+    tags[i] = status.ok() ? macs[i]->Finalize() : status;
+  };
+  if (pool_ != nullptr) {
+    pool_->ParallelFor(count, mac_chunk);
+  } else {
+    for (int i = 0; i < count; i++) mac_chunk(i);
+  }
+  // Clear the buffer, so that the data cannot be accessed later.
+  std::fill(buffer_.begin(), buffer_.begin() + buffer_position_, '\0');
+  buffer_position_ = 0;
+  last_buffer_size_ = 0;
+  for (const auto& tag : tags) {
+    if (!tag.ok()) return tag.status();
+    tags_.append(tag.ValueOrDie());
+  }
+  chunk_count_ += count;
+  return util::OkStatus();
+}
+
+util::StatusOr<std::string> ChunkedMacWriter::Finalize() {
+  if (!status_.ok()) return status_;
+  util::Status status = MacBufferedChunks();
+  if (!status.ok()) return status;
+  auto mac_result = mac_factory_->Create();
+  if (!mac_result.ok()) return mac_result.status();
+  std::unique_ptr<StatefulMac> mac = std::move(mac_result.ValueOrDie());
+  status = mac->Update(std::string(1, kFinalPrefix) +
+                       BigEndian64(chunk_count_) + BigEndian64(position_));
+  if (!status.ok()) return status;
+  status = mac->Update(tags_);
+  if (!status.ok()) return status;
+  return mac->Finalize();
+}
+
+class ChunkedComputeMacOutputStream
+    : public OutputStreamWithResult<std::string> {
+ public:
+  explicit ChunkedComputeMacOutputStream(
+      std::unique_ptr<ChunkedMacWriter> writer)
+      : writer_(std::move(writer)) {}
+
+  void BackUp(int count) override { writer_->BackUp(count); }
+  int64_t Position() const override { return writer_->Position(); }
+
+ protected:
+  util::StatusOr<int> NextBuffer(void** data) override {
+    return writer_->Next(data);
+  }
+  util::StatusOr<std::string> CloseStreamAndComputeResult() override {
+    return writer_->Finalize();
+  }
+
+ private:
+  const std::unique_ptr<ChunkedMacWriter> writer_;
+};
+
+class ChunkedVerifyMacOutputStream
+    : public OutputStreamWithResult<util::Status> {
+ public:
+  ChunkedVerifyMacOutputStream(const std::string& expected,
+                               std::unique_ptr<ChunkedMacWriter> writer)
+      : expected_(expected), writer_(std::move(writer)) {}
+
+  void BackUp(int count) override { writer_->BackUp(count); }
+  int64_t Position() const override { return writer_->Position(); }
+
+ protected:
+  util::StatusOr<int> NextBuffer(void** data) override {
+    return writer_->Next(data);
+  }
+  util::Status CloseStreamAndComputeResult() override {
+    util::StatusOr<std::string> mac_actual = writer_->Finalize();
+    if (!mac_actual.ok()) return mac_actual.status();
+    const std::string& actual = mac_actual.ValueOrDie();
+    if (actual.size() == expected_.size() &&
+        CRYPTO_memcmp(actual.data(), expected_.data(), actual.size()) == 0) {
+      return util::OkStatus();
+    }
+    return util::Status(util::error::INVALID_ARGUMENT, "Incorrect MAC");
+  }
+
+ private:
+  const std::string expected_;
+  const std::unique_ptr<ChunkedMacWriter> writer_;
+};
+
+}  // namespace
+
+// static
+util::StatusOr<std::unique_ptr<StreamingMac>> ChunkedStreamingMac::New(
+    std::unique_ptr<StatefulMacFactory> mac_factory, int chunk_size,
+    int parallelism) {
+  if (mac_factory == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "mac_factory must be non-null");
+  }
+  if (chunk_size < kMinChunkSize) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "chunk_size is too small");
+  }
+  if (parallelism < 1) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "parallelism must be positive");
+  }
+  if (static_cast<int64_t>(chunk_size) * parallelism > (1 << 30)) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "chunk_size * parallelism must not exceed 1 GiB");
+  }
+  return {absl::WrapUnique(new ChunkedStreamingMac(
+      std::move(mac_factory), chunk_size, parallelism))};
+}
+
+util::StatusOr<std::unique_ptr<OutputStreamWithResult<std::string>>>
+ChunkedStreamingMac::NewComputeMacOutputStream() const {
+  return {absl::make_unique<ChunkedComputeMacOutputStream>(
+      absl::make_unique<ChunkedMacWriter>(mac_factory_, chunk_size_,
+                                          parallelism_))};
+}
+
+util::StatusOr<std::unique_ptr<OutputStreamWithResult<util::Status>>>
+ChunkedStreamingMac::NewVerifyMacOutputStream(
+    const std::string& mac_value) const {
+  return {absl::make_unique<ChunkedVerifyMacOutputStream>(
+      mac_value, absl::make_unique<ChunkedMacWriter>(
+                     mac_factory_, chunk_size_, parallelism_))};
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,79 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_CHUNKED_STREAMING_MAC_H_
+#define TINK_SUBTLE_CHUNKED_STREAMING_MAC_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "tink/streaming_mac.h"
+#include "tink/subtle/mac/stateful_mac.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// A StreamingMac which authenticates the data in independent chunks, so
+// that the chunks can be MACed in parallel, and then authenticates the
+// list of the chunk tags.
+//
+// The data m is split into n chunks m_0, ..., m_{n-1} of chunk_size bytes,
+// where the last chunk may be shorter, and n = 0 if m is empty.  With MAC
+// the StatefulMac of the factory, the tag of m is
+//   t_i = MAC(0x00 || uint64_be(i) || m_i)
+//   tag = MAC(0x01 || uint64_be(n) || uint64_be(|m|) || t_0 || ... || t_{n-1})
+// The first byte separates the chunk MACs from the final MAC, so a single
+// key serves both, provided MAC is a PRF (e.g. HMAC or AES-CMAC) with tags
+// of at least 16 bytes.  The tag depends on chunk_size, but not on the
+// parallelism, and it differs from the tag of StreamingMacImpl.
+class ChunkedStreamingMac : public StreamingMac {
+ public:
+  static constexpr int kMinChunkSize = 4096;
+
+  // Returns a ChunkedStreamingMac whose streams MAC up to 'parallelism'
+  // chunks of 'chunk_size' bytes at a time, on 'parallelism' - 1 worker
+  // threads owned by the stream and on the calling thread.
+  static util::StatusOr<std::unique_ptr<StreamingMac>> New(
+      std::unique_ptr<StatefulMacFactory> mac_factory, int chunk_size,
+      int parallelism);
+
+  util::StatusOr<std::unique_ptr<OutputStreamWithResult<std::string>>>
+  NewComputeMacOutputStream() const override;
+
+  util::StatusOr<std::unique_ptr<OutputStreamWithResult<util::Status>>>
+  NewVerifyMacOutputStream(const std::string& mac_value) const override;
+
+ private:
+  ChunkedStreamingMac(std::unique_ptr<StatefulMacFactory> mac_factory,
+                      int chunk_size, int parallelism)
+      : mac_factory_(std::move(mac_factory)),
+        chunk_size_(chunk_size),
+        parallelism_(parallelism) {}
+
+  // Shared with the streams, which may outlive this object.
+  const std::shared_ptr<StatefulMacFactory> mac_factory_;
+  const int chunk_size_;
+  const int parallelism_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_CHUNKED_STREAMING_MAC_H_
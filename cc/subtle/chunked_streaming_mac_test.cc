@@ -0,0 +1,166 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/chunked_streaming_mac.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::DummyStatefulMac;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+
+constexpr int kChunkSize = ChunkedStreamingMac::kMinChunkSize;
+
+class DummyStatefulMacFactory : public StatefulMacFactory {
+ public:
+  util::StatusOr<std::unique_ptr<StatefulMac>> Create() const override {
+    return std::unique_ptr<StatefulMac>(
+        absl::make_unique<DummyStatefulMac>("chunked mac:"));
+  }
+};
+
+std::string BigEndian64(uint64_t val) {
+  return BigEndian32(val >> 32) + BigEndian32(val & 0xffffffff);
+}
+
+// Computes the tag of 'data' as specified in chunked_streaming_mac.h.
+std::string ExpectedTag(absl::string_view data) {
+  DummyStatefulMacFactory factory;
+  std::string tags;
+  int64_t n = 0;
+  for (; n * kChunkSize < data.size(); n++) {
+    auto mac = std::move(factory.Create().ValueOrDie());
+    EXPECT_THAT(mac->Update(std::string(1, '\x00') + BigEndian64(n)), IsOk());
+    EXPECT_THAT(mac->Update(data.substr(n * kChunkSize, kChunkSize)), IsOk());
+    tags += mac->Finalize().ValueOrDie();
+  }
+  auto mac = std::move(factory.Create().ValueOrDie());
+  EXPECT_THAT(mac->Update(std::string(1, '\x01') + BigEndian64(n) +
+                          BigEndian64(data.size()) + tags),
+              IsOk());
+  return mac->Finalize().ValueOrDie();
+}
+
+std::unique_ptr<StreamingMac> GetChunkedStreamingMac(int parallelism) {
+  auto result = ChunkedStreamingMac::New(
+      absl::make_unique<DummyStatefulMacFactory>(), kChunkSize, parallelism);
+  EXPECT_THAT(result.status(), IsOk());
+  return std::move(result.ValueOrDie());
+}
+
+TEST(ChunkedStreamingMacTest, ComputeMac) {
+  for (int size : {0, 1, kChunkSize - 1, kChunkSize, kChunkSize + 1,
+                   10 * kChunkSize, 100000}) {
+    std::string text = Random::GetRandomBytes(size);
+    std::string expected_mac = ExpectedTag(text);
+    for (int parallelism : {1, 2, 4}) {
+      SCOPED_TRACE(
+          absl::StrCat("size = ", size, ", parallelism = ", parallelism));
+      auto streaming_mac = GetChunkedStreamingMac(parallelism);
+      auto stream = std::move(
+          streaming_mac->NewComputeMacOutputStream().ValueOrDie());
+      EXPECT_THAT(test::WriteToStream(stream.get(), text, false), IsOk());
+      EXPECT_EQ(stream->Position(), text.size());
+      auto result = stream->CloseAndGetResult();
+      ASSERT_THAT(result.status(), IsOk());
+      EXPECT_EQ(result.ValueOrDie(), expected_mac);
+    }
+  }
+}
+
+TEST(ChunkedStreamingMacTest, VerifyMac) {
+  std::string text = Random::GetRandomBytes(5 * kChunkSize + 17);
+  std::string expected_mac = ExpectedTag(text);
+  auto streaming_mac = GetChunkedStreamingMac(3);
+
+  auto stream = std::move(
+      streaming_mac->NewVerifyMacOutputStream(expected_mac).ValueOrDie());
+  EXPECT_THAT(test::WriteToStream(stream.get(), text, false), IsOk());
+  EXPECT_THAT(stream->CloseAndGetResult(), IsOk());
+
+  // Truncated data.
+  stream = std::move(
+      streaming_mac->NewVerifyMacOutputStream(expected_mac).ValueOrDie());
+  EXPECT_THAT(test::WriteToStream(stream.get(),
+                                  absl::string_view(text).substr(1), false),
+              IsOk());
+  EXPECT_THAT(stream->CloseAndGetResult(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+
+  // Wrong MAC.
+  stream = std::move(
+      streaming_mac->NewVerifyMacOutputStream(expected_mac.substr(1))
+          .ValueOrDie());
+  EXPECT_THAT(test::WriteToStream(stream.get(), text, false), IsOk());
+  EXPECT_THAT(stream->CloseAndGetResult(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(ChunkedStreamingMacTest, BackUpAndPosition) {
+  auto streaming_mac = GetChunkedStreamingMac(2);
+  auto stream =
+      std::move(streaming_mac->NewComputeMacOutputStream().ValueOrDie());
+  void* buffer;
+  auto next_result = stream->Next(&buffer);
+  ASSERT_THAT(next_result.status(), IsOk());
+  EXPECT_EQ(2 * kChunkSize, next_result.ValueOrDie());
+  stream->BackUp(2 * kChunkSize - 10);
+  EXPECT_EQ(10, stream->Position());
+  memset(buffer, 'a', 10);
+  next_result = stream->Next(&buffer);
+  ASSERT_THAT(next_result.status(), IsOk());
+  EXPECT_EQ(2 * kChunkSize - 10, next_result.ValueOrDie());
+  stream->BackUp(next_result.ValueOrDie());
+  EXPECT_EQ(10, stream->Position());
+  auto result = stream->CloseAndGetResult();
+  ASSERT_THAT(result.status(), IsOk());
+  EXPECT_EQ(result.ValueOrDie(), ExpectedTag(std::string(10, 'a')));
+}
+
+TEST(ChunkedStreamingMacTest, InvalidParameters) {
+  EXPECT_FALSE(ChunkedStreamingMac::New(nullptr, kChunkSize, 1).ok());
+  EXPECT_FALSE(ChunkedStreamingMac::New(
+                   absl::make_unique<DummyStatefulMacFactory>(),
+                   kChunkSize - 1, 1)
+                   .ok());
+  EXPECT_FALSE(ChunkedStreamingMac::New(
+                   absl::make_unique<DummyStatefulMacFactory>(), kChunkSize, 0)
+                   .ok());
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,149 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/cpu_features.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif defined(__aarch64__) && defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+#if defined(__x86_64__) || defined(__i386__)
+
+uint64_t ReadXcr0() {
+  uint32_t eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+}
+
+CpuFeatures DetectCpuFeatures() {
+  CpuFeatures features;
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return features;
+  features.sse41 = (ecx >> 19) & 1;
+  features.aes = (ecx >> 25) & 1;
+  features.pclmulqdq = (ecx >> 1) & 1;
+  // The wide registers are only usable if the operating system saves them.
+  bool avx_state = false;
+  bool avx512_state = false;
+  if ((ecx >> 27) & 1) {  // OSXSAVE
+    uint64_t xcr0 = ReadXcr0();
+    avx_state = (xcr0 & 0x6) == 0x6;
+    avx512_state = avx_state && (xcr0 & 0xe0) == 0xe0;
+  }
+  if (__get_cpuid_max(0, nullptr) < 7) return features;
+  __cpuid_count(7, 0, eax, ebx, ecx, edx);
+  features.avx2 = avx_state && ((ebx >> 5) & 1);
+  features.avx512f = avx512_state && ((ebx >> 16) & 1);
+  features.sha = (ebx >> 29) & 1;
+  features.vaes = avx_state && ((ecx >> 9) & 1);
+  features.vpclmulqdq = avx_state && ((ecx >> 10) & 1);
+  return features;
+}
+
+#elif defined(__aarch64__) && defined(__linux__)
+
+CpuFeatures DetectCpuFeatures() {
+  CpuFeatures features;
+  unsigned long hwcap = getauxval(AT_HWCAP);  // NOLINT(runtime/int)
+  features.arm_aes = hwcap & HWCAP_AES;
+  features.arm_pmull = hwcap & HWCAP_PMULL;
+  features.arm_sha1 = hwcap & HWCAP_SHA1;
+  features.arm_sha2 = hwcap & HWCAP_SHA2;
+  return features;
+}
+
+#else
+
+CpuFeatures DetectCpuFeatures() { return CpuFeatures(); }
+
+#endif
+
+std::atomic<DispatchPolicy> dispatch_policy{DispatchPolicy::kFastest};
+
+struct ImplementationRegistry {
+  absl::Mutex mutex;
+  std::map<absl::string_view, absl::string_view> chosen
+      ABSL_GUARDED_BY(mutex);
+};
+
+ImplementationRegistry& GetImplementationRegistry() {
+  static ImplementationRegistry* registry = new ImplementationRegistry();
+  return *registry;
+}
+
+}  // namespace
+
+const CpuFeatures& GetCpuFeatures() {
+  static const CpuFeatures* features = new CpuFeatures(DetectCpuFeatures());
+  return *features;
+}
+
+void SetDispatchPolicy(DispatchPolicy policy) {
+  dispatch_policy.store(policy, std::memory_order_relaxed);
+}
+
+DispatchPolicy GetDispatchPolicy() {
+  return dispatch_policy.load(std::memory_order_relaxed);
+}
+
+bool UseAesniImplementations() {
+#if defined(__SSE4_1__) && defined(__AES__)
+  const CpuFeatures& features = GetCpuFeatures();
+  return features.sse41 && features.aes &&
+         GetDispatchPolicy() == DispatchPolicy::kFastest;
+#else
+  return false;
+#endif
+}
+
+void RecordImplementation(absl::string_view primitive,
+                          absl::string_view implementation) {
+  ImplementationRegistry& registry = GetImplementationRegistry();
+  absl::MutexLock lock(&registry.mutex);
+  registry.chosen[primitive] = implementation;
+}
+
+std::map<std::string, std::string> GetChosenImplementations() {
+  ImplementationRegistry& registry = GetImplementationRegistry();
+  absl::MutexLock lock(&registry.mutex);
+  std::map<std::string, std::string> result;
+  for (const auto& entry : registry.chosen) {
+    result.emplace(std::string(entry.first), std::string(entry.second));
+  }
+  return result;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,83 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_CPU_FEATURES_H_
+#define TINK_SUBTLE_CPU_FEATURES_H_
+
+#include <map>
+#include <string>
+
+#include "absl/strings/string_view.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// The instruction set extensions of the CPU which are relevant for the
+// implementations of the primitives.  A feature is only reported if both the
+// CPU and the operating system support it.
+struct CpuFeatures {
+  // x86.
+  bool sse41 = false;
+  bool aes = false;
+  bool pclmulqdq = false;
+  bool avx2 = false;
+  bool avx512f = false;
+  bool vaes = false;
+  bool vpclmulqdq = false;
+  bool sha = false;
+  // ARMv8.
+  bool arm_aes = false;
+  bool arm_pmull = false;
+  bool arm_sha1 = false;
+  bool arm_sha2 = false;
+};
+
+// Returns the features of the CPU, detected once on first use.
+const CpuFeatures& GetCpuFeatures();
+
+// Which implementations the key managers may choose from.
+enum class DispatchPolicy {
+  // The fastest implementation supported by the CPU.
+  kFastest,
+  // Only the portable implementations, e.g. to rule out a faulty
+  // hardware-specific one or to compare against it.
+  kPortableOnly,
+};
+
+// Sets the policy for the primitives created afterwards.  Primitives which
+// already exist keep their implementation.
+void SetDispatchPolicy(DispatchPolicy policy);
+DispatchPolicy GetDispatchPolicy();
+
+// Returns true if the AESNI implementations (AesSivAesni, AesEaxAesni) are
+// compiled in, supported by the CPU and allowed by the policy.
+bool UseAesniImplementations();
+
+// Records that an instance of 'primitive' (e.g. "AesGcm") uses the
+// implementation 'implementation' (e.g. "boringssl", "aesni").  Both must be
+// string literals.
+void RecordImplementation(absl::string_view primitive,
+                          absl::string_view implementation);
+
+// Returns, per primitive, the implementation most recently chosen for it.
+std::map<std::string, std::string> GetChosenImplementations();
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_CPU_FEATURES_H_
@@ -0,0 +1,68 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/cpu_features.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::testing::Contains;
+using ::testing::Pair;
+
+TEST(CpuFeaturesTest, DetectionIsConsistent) {
+  const CpuFeatures& features = GetCpuFeatures();
+  EXPECT_EQ(&features, &GetCpuFeatures());
+  // The wide extensions imply the basic ones on every CPU which has them.
+  if (features.vaes) EXPECT_TRUE(features.aes);
+  if (features.vpclmulqdq) EXPECT_TRUE(features.pclmulqdq);
+  if (features.avx512f) EXPECT_TRUE(features.avx2);
+#if defined(__SSE4_1__) && defined(__AES__)
+  // Code compiled for AESNI only runs on CPUs which have it.
+  EXPECT_TRUE(features.sse41);
+  EXPECT_TRUE(features.aes);
+#endif
+}
+
+TEST(CpuFeaturesTest, PolicyDisablesAesni) {
+  EXPECT_EQ(GetDispatchPolicy(), DispatchPolicy::kFastest);
+#if defined(__SSE4_1__) && defined(__AES__)
+  EXPECT_TRUE(UseAesniImplementations());
+#else
+  EXPECT_FALSE(UseAesniImplementations());
+#endif
+  SetDispatchPolicy(DispatchPolicy::kPortableOnly);
+  EXPECT_FALSE(UseAesniImplementations());
+  SetDispatchPolicy(DispatchPolicy::kFastest);
+}
+
+TEST(CpuFeaturesTest, RecordImplementation) {
+  RecordImplementation("TestPrimitive", "portable");
+  EXPECT_THAT(GetChosenImplementations(),
+              Contains(Pair("TestPrimitive", "portable")));
+  RecordImplementation("TestPrimitive", "aesni");
+  EXPECT_THAT(GetChosenImplementations(),
+              Contains(Pair("TestPrimitive", "aesni")));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
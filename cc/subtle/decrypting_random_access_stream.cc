@@ -18,13 +18,20 @@
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "tink/internal/thread_pool.h"
 #include "tink/random_access_stream.h"
+#include "tink/streaming_aead.h"
 #include "tink/subtle/stream_segment_decrypter.h"
 #include "tink/util/buffer.h"
 #include "tink/util/errors.h"
@@ -41,6 +48,38 @@ using crypto::tink::util::Buffer;
 using crypto::tink::util::Status;
 using crypto::tink::util::StatusOr;
 
+namespace {
+
+// Scratch buffers of a PRead(), kept per thread so that PReads reuse them
+// instead of allocating their own.
+struct Scratch {
+  std::unique_ptr<Buffer> ct_buffer;
+  std::vector<uint8_t> pt_segment;
+};
+
+// Takes the scratch buffers of the calling thread for the lifetime of the
+// object, and gives them back afterwards.  A nested PRead() on the same
+// thread, e.g. of a stream whose source is another decrypting stream, finds
+// the slot empty and allocates buffers of its own.
+class ThreadScratch {
+ public:
+  ThreadScratch() : scratch_(std::move(Slot())) {}
+  ~ThreadScratch() { Slot() = std::move(scratch_); }
+
+  std::unique_ptr<Buffer>* ct_buffer() { return &scratch_.ct_buffer; }
+  std::vector<uint8_t>* pt_segment() { return &scratch_.pt_segment; }
+
+ private:
+  static Scratch& Slot() {
+    thread_local Scratch slot;
+    return slot;
+  }
+
+  Scratch scratch_;
+};
+
+}  // namespace
+
 // static
 StatusOr<std::unique_ptr<RandomAccessStream>> DecryptingRandomAccessStream::New(
     std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
@@ -76,6 +115,109 @@ StatusOr<std::unique_ptr<RandomAccessStream>> DecryptingRandomAccessStream::New(
   return {std::move(dec_stream)};
 }
 
+// static
+StatusOr<std::unique_ptr<RandomAccessStream>> DecryptingRandomAccessStream::New(
+    std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+    std::unique_ptr<RandomAccessStream> ciphertext_source,
+    const StreamingAead::RandomAccessOptions& options) {
+  if (options.cache_segments < 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "cache_segments cannot be negative");
+  }
+  if (options.readahead_segments < 0 ||
+      options.readahead_segments > options.cache_segments) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "readahead_segments must be in [0, cache_segments]");
+  }
+  if (options.parallelism < 1) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "parallelism must be positive");
+  }
+  if (options.readahead_segments > 0 && options.parallelism == 1 &&
+      options.executor == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "readahead requires parallelism > 1 or an executor");
+  }
+  auto dec_stream_result =
+      New(std::move(segment_decrypter), std::move(ciphertext_source));
+  if (!dec_stream_result.ok()) return dec_stream_result.status();
+  std::unique_ptr<DecryptingRandomAccessStream> dec_stream(
+      static_cast<DecryptingRandomAccessStream*>(
+          dec_stream_result.ValueOrDie().release()));
+  dec_stream->cache_segments_ = options.cache_segments;
+  dec_stream->readahead_segments_ = options.readahead_segments;
+  if (options.executor != nullptr) {
+    dec_stream->pool_ = options.executor;
+  } else if (options.parallelism > 1) {
+    dec_stream->pool_ =
+        std::make_shared<internal::ThreadPool>(options.parallelism - 1);
+  }
+  return {std::move(dec_stream)};
+}
+
+// static
+StatusOr<std::vector<StreamingAead::CiphertextRange>>
+DecryptingRandomAccessStream::PlanCiphertextRanges(
+    const StreamSegmentDecrypter& segment_decrypter, int64_t ciphertext_size,
+    int64_t position, int64_t count, int64_t max_gap) {
+  if (ciphertext_size < 0 || position < 0 || count < 0 || max_gap < 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "sizes and positions cannot be negative");
+  }
+  // The same computations as in InitializeIfNeeded() and PReadAndDecrypt().
+  int64_t header_size = segment_decrypter.get_header_size();
+  int64_t ct_offset = segment_decrypter.get_ciphertext_offset();
+  int64_t ct_segment_size = segment_decrypter.get_ciphertext_segment_size();
+  int64_t pt_segment_size = segment_decrypter.get_plaintext_segment_size();
+  int64_t segment_count =
+      (ciphertext_size + ct_segment_size - 1) / ct_segment_size;
+  if (segment_count - 1 > std::numeric_limits<uint32_t>::max()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("too many segments: ", segment_count));
+  }
+  int64_t overhead = (ct_segment_size - pt_segment_size) * segment_count +
+                     ct_offset + header_size;
+  if (overhead > ciphertext_size) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "ciphertext stream is too short");
+  }
+  int64_t pt_size = ciphertext_size - overhead;
+  if (count > std::numeric_limits<int64_t>::max() - position) {
+    return Status(util::error::INVALID_ARGUMENT, "position too large");
+  }
+
+  std::vector<StreamingAead::CiphertextRange> ranges;
+  ranges.push_back({ct_offset, header_size});
+  if (count == 0 || position > pt_size) return ranges;
+  int64_t first_segment_nr =
+      (position + ct_offset + header_size) / pt_segment_size;
+  int64_t last_segment_nr = std::min(
+      segment_count - 1,
+      (position + count - 1 + ct_offset + header_size) / pt_segment_size);
+  if (first_segment_nr > last_segment_nr) return ranges;
+  int64_t begin = first_segment_nr == 0 ? ct_offset + header_size
+                                        : first_segment_nr * ct_segment_size;
+  int64_t end =
+      std::min((last_segment_nr + 1) * ct_segment_size, ciphertext_size);
+  if (begin - (ct_offset + header_size) <= max_gap) {
+    ranges.back().size = end - ct_offset;
+  } else {
+    ranges.push_back({begin, end - begin});
+  }
+  return ranges;
+}
+
+DecryptingRandomAccessStream::~DecryptingRandomAccessStream() {
+  {
+    // Pending Prefetch()-calls return early.  The executor may be shared,
+    // so they are waited for rather than joined with the threads.
+    absl::MutexLock lock(&cache_mutex_);
+    closing_ = true;
+    while (!prefetching_.empty()) prefetch_done_.Wait(&cache_mutex_);
+  }
+  pool_.reset();
+}
+
 util::Status DecryptingRandomAccessStream::PRead(int64_t position, int count,
                                                  Buffer* dest_buffer) {
   if (dest_buffer == nullptr) {
@@ -94,18 +236,27 @@ util::Status DecryptingRandomAccessStream::PRead(int64_t position, int count,
     return Status(util::error::INVALID_ARGUMENT, "position cannot be negative");
   }
 
-  {  // Initialize, if not initialized yet.
-    absl::MutexLock lock(&status_mutex_);
-    InitializeIfNeeded();
-    if (!status_.ok()) return status_;
-  }
+  status = EnsureInitialized();
+  if (!status.ok()) return status;
 
   if (position > pt_size_) {
     return Status(util::error::INVALID_ARGUMENT, "position too large");
   }
+  if (cache_segments_ > 0 || pool_ != nullptr) {
+    return PReadSegments(position, count, dest_buffer);
+  }
   return PReadAndDecrypt(position, count, dest_buffer);
 }
 
+util::Status DecryptingRandomAccessStream::EnsureInitialized() {
+  if (initialized_.load(std::memory_order_acquire)) return Status::OK;
+  absl::MutexLock lock(&status_mutex_);
+  InitializeIfNeeded();
+  if (!status_.ok()) return status_;
+  initialized_.store(true, std::memory_order_release);
+  return Status::OK;
+}
+
 // NOTE: As the initialization below requires availability of size() of the
 // underlying ciphertext stream, the current implementation does not support
 // dynamic encrypted streams, whose size is not known or can change over time
@@ -197,41 +348,85 @@ int64_t DecryptingRandomAccessStream::GetSegmentNr(int64_t pt_position) {
   return (pt_position + ct_offset_ + header_size_) / pt_segment_size_;
 }
 
-util::Status DecryptingRandomAccessStream::ReadAndDecryptSegment(
-    int64_t segment_nr, Buffer* ct_buffer, std::vector<uint8_t>* pt_segment) {
-  int64_t ct_position = segment_nr * ct_segment_size_;
-  if (ct_position / ct_segment_size_ != segment_nr /* overflow occured! */) {
+util::Status DecryptingRandomAccessStream::ReadSegments(
+    int64_t first_segment_nr, int segment_count,
+    std::unique_ptr<Buffer>* ct_buffer, absl::Span<const uint8_t>* ct) {
+  int64_t ct_position = first_segment_nr * ct_segment_size_;
+  if (ct_position / ct_segment_size_ !=
+      first_segment_nr /* overflow occured! */) {
     return Status(util::error::OUT_OF_RANGE,
                   absl::StrCat("segment_nr * ct_segment_size too large: ",
-                               segment_nr, ct_segment_size_));
+                               first_segment_nr, ct_segment_size_));
   }
-  int segment_size = ct_segment_size_;
-  if (segment_nr == 0) {
+  // segment_count is limited such that read_size fits an int.
+  int read_size = segment_count * ct_segment_size_;
+  if (first_segment_nr == 0) {
     // The sum of ct_offset_ and header_size is always smaller than
     // ct_segment_size_, which is an int, therefore the next two statements
     // should never overflow.
     ct_position = ct_offset_ + header_size_;
-    segment_size = ct_segment_size_ - ct_position;
+    read_size -= ct_position;
   }
-  bool is_last_segment = (segment_nr == segment_count_ - 1);
-  auto pread_status = ct_source_->PRead(ct_position, segment_size, ct_buffer);
+  bool has_last_segment =
+      (first_segment_nr + segment_count >= segment_count_);
+
+  auto view_result = ct_source_->PReadView(ct_position, read_size);
+  if (view_result.ok()) {
+    absl::string_view view = view_result.ValueOrDie();
+    if (static_cast<int>(view.size()) < read_size && !has_last_segment) {
+      return Status(util::error::OUT_OF_RANGE, "EOF");
+    }
+    *ct = absl::MakeConstSpan(reinterpret_cast<const uint8_t*>(view.data()),
+                              view.size());
+    return Status::OK;
+  }
+  if (view_result.status().error_code() != util::error::UNIMPLEMENTED) {
+    return view_result.status();
+  }
+
+  if (*ct_buffer == nullptr || (*ct_buffer)->allocated_size() < read_size) {
+    auto ct_buffer_result =
+        Buffer::New(std::max(read_size, ct_segment_size_));
+    if (!ct_buffer_result.ok()) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Invalid ciphertext segment size %d.",
+                       ct_segment_size_);
+    }
+    *ct_buffer = std::move(ct_buffer_result.ValueOrDie());
+  }
+  Buffer* buffer = ct_buffer->get();
+  auto pread_status = ct_source_->PRead(ct_position, read_size, buffer);
   if (pread_status.ok() ||
-      (is_last_segment && ct_buffer->size() > 0 &&
+      (has_last_segment && buffer->size() > 0 &&
        pread_status.error_code() == util::error::OUT_OF_RANGE)) {
     // some bytes were read
-    auto dec_status = segment_decrypter_->DecryptSegment(
-        std::vector<uint8_t>(ct_buffer->get_mem_block(),
-                             ct_buffer->get_mem_block() + ct_buffer->size()),
-        segment_nr, is_last_segment, pt_segment);
-    if (dec_status.ok()) {
-      return is_last_segment ?
-          Status(util::error::OUT_OF_RANGE, "EOF") : Status::OK;
-    }
-    return dec_status;
+    *ct = absl::MakeConstSpan(
+        reinterpret_cast<const uint8_t*>(buffer->get_mem_block()),
+        buffer->size());
+    return Status::OK;
   }
   return pread_status;
 }
 
+util::Status DecryptingRandomAccessStream::ReadAndDecryptSegment(
+    int64_t segment_nr, std::unique_ptr<Buffer>* ct_buffer,
+    std::vector<uint8_t>* pt_segment) {
+  absl::Span<const uint8_t> ct;
+  auto read_status = ReadSegments(segment_nr, 1, ct_buffer, &ct);
+  if (!read_status.ok()) return read_status;
+  bool is_last_segment = (segment_nr == segment_count_ - 1);
+  pt_segment->resize(ct.size() > static_cast<size_t>(ct_segment_overhead_)
+                         ? ct.size() - ct_segment_overhead_
+                         : 0);
+  auto dec_status = segment_decrypter_->DecryptSegmentInto(
+      ct, segment_nr, is_last_segment, absl::MakeSpan(*pt_segment));
+  if (dec_status.ok()) {
+    return is_last_segment ?
+        Status(util::error::OUT_OF_RANGE, "EOF") : Status::OK;
+  }
+  return dec_status;
+}
+
 util::Status DecryptingRandomAccessStream::PReadAndDecrypt(
     int64_t position, int count, Buffer* dest_buffer) {
   if (position < 0 || count < 0 || dest_buffer == nullptr
@@ -256,47 +451,214 @@ util::Status DecryptingRandomAccessStream::PReadAndDecrypt(
                     "position is larger than stream size");
     }
   }
-  auto ct_buffer_result = Buffer::New(ct_segment_size_);
-  if (!ct_buffer_result.ok()) {
-    return ToStatusF(util::error::INVALID_ARGUMENT,
-                     "Invalid ciphertext segment size %d.",
-                     ct_segment_size_);
-  }
-  auto ct_buffer = std::move(ct_buffer_result.ValueOrDie());
-  std::vector<uint8_t> pt_segment;
+  ThreadScratch scratch;
+  std::unique_ptr<Buffer>& ct_buffer = *scratch.ct_buffer();
+  std::vector<uint8_t>& pt_segment = *scratch.pt_segment();
   int remaining = count;
   int read_count = 0;
   int pt_offset = GetPlaintextOffset(position);
+  // The ciphertext of the segments that were read but not decrypted yet.
+  absl::Span<const uint8_t> ct_segments;
+  int64_t last_segment_nr =
+      std::min(segment_count_ - 1, GetSegmentNr(position + count - 1));
+  int max_segments_per_read =
+      std::max(1, kMaxCoalescedReadSize / ct_segment_size_);
   while (remaining > 0) {
     auto segment_nr = GetSegmentNr(position + read_count);
-    auto status =
-        ReadAndDecryptSegment(segment_nr, ct_buffer.get(), &pt_segment);
-    if (status.ok() || status.error_code() == util::error::OUT_OF_RANGE) {
-      int pt_count = pt_segment.size() - pt_offset;
-      int to_copy_count = std::min(pt_count, remaining);
-      auto s = dest_buffer->set_size(read_count + to_copy_count);
-      if (!s.ok()) return s;
+    bool is_last_segment = (segment_nr == segment_count_ - 1);
+    util::Status status;
+    if (ct_segments.empty()) {
+      int64_t segments_to_read = std::min<int64_t>(
+          last_segment_nr - segment_nr + 1, max_segments_per_read);
+      status = ReadSegments(segment_nr, std::max<int64_t>(segments_to_read, 1),
+                            &ct_buffer, &ct_segments);
+      if (!status.ok()) return status;
+    }
+    size_t ct_size = ct_segment_size_;
+    if (segment_nr == 0) ct_size -= ct_offset_ + header_size_;
+    absl::Span<const uint8_t> ct = ct_segments.subspan(0, ct_size);
+    ct_segments.remove_prefix(ct.size());
+    if (ct.size() < ct_size && !is_last_segment) {
+      return Status(util::error::OUT_OF_RANGE, "EOF");
+    }
+    int pt_count =
+        std::max<int>(static_cast<int>(ct.size()) - ct_segment_overhead_, 0);
+    int to_copy_count;
+    if (pt_offset == 0 && pt_count <= remaining) {
+      // The whole segment is requested: decrypt it in place.
+      to_copy_count = pt_count;
+      status = dest_buffer->set_size(read_count + to_copy_count);
+      if (!status.ok()) return status;
+      status = segment_decrypter_->DecryptSegmentInto(
+          ct, segment_nr, is_last_segment,
+          absl::MakeSpan(reinterpret_cast<uint8_t*>(
+                             dest_buffer->get_mem_block() + read_count),
+                         pt_count));
+      if (!status.ok()) {
+        dest_buffer->set_size(read_count).IgnoreError();
+        return status;
+      }
+    } else {
+      pt_segment.resize(pt_count);
+      status = segment_decrypter_->DecryptSegmentInto(
+          ct, segment_nr, is_last_segment, absl::MakeSpan(pt_segment));
+      if (!status.ok()) return status;
+      pt_count -= pt_offset;
+      to_copy_count = std::min(pt_count, remaining);
+      status = dest_buffer->set_size(read_count + to_copy_count);
+      if (!status.ok()) return status;
       std::memcpy(dest_buffer->get_mem_block() + read_count,
                   pt_segment.data() + pt_offset, to_copy_count);
       pt_offset = 0;
-      if (status.error_code() == util::error::OUT_OF_RANGE &&
-          to_copy_count == pt_count)
-        return status;
-      read_count += to_copy_count;
-      remaining = count - dest_buffer->size();
-    } else {  // some other error happened
-      return status;
     }
+    if (is_last_segment && to_copy_count == pt_count) {
+      return Status(util::error::OUT_OF_RANGE, "EOF");
+    }
+    read_count += to_copy_count;
+    remaining = count - dest_buffer->size();
   }
   return util::Status::OK;
 }
 
-StatusOr<int64_t> DecryptingRandomAccessStream::size() {
-  {  // Initialize, if not initialized yet.
-    absl::MutexLock lock(&status_mutex_);
-    InitializeIfNeeded();
-    if (!status_.ok()) return status_;
+util::Status DecryptingRandomAccessStream::PReadSegments(
+    int64_t position, int count, Buffer* dest_buffer) {
+  if (count == 0) return Status::OK;
+  if (position > std::numeric_limits<int64_t>::max() - count) {
+    return Status(util::error::OUT_OF_RANGE,
+                  absl::StrCat("position too large: ", position));
+  }
+  if (position == pt_size_) {
+    return Status(util::error::OUT_OF_RANGE, "EOF");
   }
+  int64_t end = std::min(pt_size_, position + count);
+  int64_t first_segment_nr = GetSegmentNr(position);
+  int64_t last_segment_nr = GetSegmentNr(end - 1);
+  int segment_count = last_segment_nr - first_segment_nr + 1;
+
+  std::vector<StatusOr<std::shared_ptr<const std::vector<uint8_t>>>> segments(
+      segment_count, Status(util::error::UNKNOWN, "not decrypted"));
+  auto get_segment = [this, first_segment_nr, &segments](int i) {
+    segments[i] = GetSegment(first_segment_nr + i);
+  };
+  if (pool_ != nullptr && segment_count > 1) {
+    pool_->ParallelFor(segment_count, get_segment);
+  } else {
+    for (int i = 0; i < segment_count; i++) get_segment(i);
+  }
+
+  int read_count = 0;
+  int pt_offset = GetPlaintextOffset(position);
+  for (int i = 0; i < segment_count; i++) {
+    if (!segments[i].ok()) return segments[i].status();
+    const std::vector<uint8_t>& pt_segment = *segments[i].ValueOrDie();
+    int64_t remaining = end - position - read_count;
+    int to_copy_count = std::min<int64_t>(
+        static_cast<int64_t>(pt_segment.size()) - pt_offset, remaining);
+    if (to_copy_count < 0) {
+      return Status(util::error::INTERNAL, "segment shorter than expected");
+    }
+    auto status = dest_buffer->set_size(read_count + to_copy_count);
+    if (!status.ok()) return status;
+    std::memcpy(dest_buffer->get_mem_block() + read_count,
+                pt_segment.data() + pt_offset, to_copy_count);
+    read_count += to_copy_count;
+    pt_offset = 0;
+  }
+  ScheduleReadahead(first_segment_nr, last_segment_nr);
+  if (end == pt_size_) {
+    return Status(util::error::OUT_OF_RANGE, "EOF");
+  }
+  return Status::OK;
+}
+
+StatusOr<std::shared_ptr<const std::vector<uint8_t>>>
+DecryptingRandomAccessStream::GetSegment(int64_t segment_nr) {
+  if (cache_segments_ > 0) {
+    absl::MutexLock lock(&cache_mutex_);
+    // Wait for a prefetch of this segment rather than decrypt it twice.
+    while (prefetching_.contains(segment_nr)) {
+      prefetch_done_.Wait(&cache_mutex_);
+    }
+    auto it = cache_.find(segment_nr);
+    if (it != cache_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+      return it->second.segment;
+    }
+  }
+  auto segment_result = DecryptSegment(segment_nr);
+  if (!segment_result.ok()) return segment_result.status();
+  if (cache_segments_ > 0) {
+    absl::MutexLock lock(&cache_mutex_);
+    CacheSegment(segment_nr, segment_result.ValueOrDie());
+  }
+  return segment_result;
+}
+
+StatusOr<std::shared_ptr<const std::vector<uint8_t>>>
+DecryptingRandomAccessStream::DecryptSegment(int64_t segment_nr) {
+  ThreadScratch scratch;
+  auto pt_segment = std::make_shared<std::vector<uint8_t>>();
+  auto status =
+      ReadAndDecryptSegment(segment_nr, scratch.ct_buffer(), pt_segment.get());
+  // OUT_OF_RANGE marks the successfully decrypted last segment.
+  if (!status.ok() && status.error_code() != util::error::OUT_OF_RANGE) {
+    return status;
+  }
+  return {std::move(pt_segment)};
+}
+
+void DecryptingRandomAccessStream::CacheSegment(
+    int64_t segment_nr, std::shared_ptr<const std::vector<uint8_t>> segment) {
+  if (cache_.contains(segment_nr)) return;
+  lru_.push_front(segment_nr);
+  cache_[segment_nr] = CacheEntry{std::move(segment), lru_.begin()};
+  if (lru_.size() > static_cast<size_t>(cache_segments_)) {
+    cache_.erase(lru_.back());
+    lru_.pop_back();
+  }
+}
+
+void DecryptingRandomAccessStream::ScheduleReadahead(int64_t first_segment_nr,
+                                                     int64_t last_segment_nr) {
+  if (readahead_segments_ == 0) return;
+  absl::MutexLock lock(&cache_mutex_);
+  // A read is sequential if it starts in the segment in which the previous
+  // one ended, or in the next one.
+  bool is_sequential =
+      first_segment_nr == next_sequential_segment_nr_ ||
+      first_segment_nr == next_sequential_segment_nr_ - 1;
+  next_sequential_segment_nr_ = last_segment_nr + 1;
+  if (!is_sequential) return;
+  int64_t readahead_end =
+      std::min(segment_count_, last_segment_nr + 1 + readahead_segments_);
+  for (int64_t nr = last_segment_nr + 1; nr < readahead_end; nr++) {
+    if (cache_.contains(nr) || prefetching_.contains(nr)) continue;
+    prefetching_.insert(nr);
+    pool_->Schedule([this, nr]() { Prefetch(nr); });
+  }
+}
+
+void DecryptingRandomAccessStream::Prefetch(int64_t segment_nr) {
+  bool closing;
+  {
+    absl::MutexLock lock(&cache_mutex_);
+    closing = closing_;
+  }
+  StatusOr<std::shared_ptr<const std::vector<uint8_t>>> segment_result =
+      Status(util::error::CANCELLED, "stream is being destroyed");
+  if (!closing) segment_result = DecryptSegment(segment_nr);
+  absl::MutexLock lock(&cache_mutex_);
+  // Failed segments are not cached; a PRead() will report the error.
+  if (segment_result.ok()) {
+    CacheSegment(segment_nr, std::move(segment_result.ValueOrDie()));
+  }
+  prefetching_.erase(segment_nr);
+  prefetch_done_.SignalAll();
+}
+
+StatusOr<int64_t> DecryptingRandomAccessStream::size() {
+  auto status = EnsureInitialized();
+  if (!status.ok()) return status;
   return pt_size_;
 }
 
@@ -15,12 +15,20 @@
 #ifndef TINK_SUBTLE_DECRYPTING_RANDOM_ACCESS_STREAM_H_
 #define TINK_SUBTLE_DECRYPTING_RANDOM_ACCESS_STREAM_H_
 
+#include <atomic>
+#include <list>
 #include <memory>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "tink/executor.h"
 #include "tink/random_access_stream.h"
+#include "tink/streaming_aead.h"
 #include "tink/subtle/stream_segment_decrypter.h"
+#include "tink/util/buffer.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -36,7 +44,9 @@ namespace subtle {
 //    refer to the plaintext bytes.
 //  - size()-call returns the size of the entire plaintext
 //    if it were to be decrypted.
-// Instances of this class are thread safe.
+// Instances of this class are thread safe.  Once the header has been read,
+// PRead() takes no lock unless segments are cached, and it reuses scratch
+// buffers of the calling thread, so concurrent PReads scale with threads.
 class DecryptingRandomAccessStream : public crypto::tink::RandomAccessStream {
  public:
   // A factory that produces decrypting random access streams.
@@ -49,6 +59,33 @@ class DecryptingRandomAccessStream : public crypto::tink::RandomAccessStream {
   New(std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
       std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source);
 
+  // Like New() above, but the returned stream caches decrypted segments,
+  // reads ahead and decrypts in parallel as specified by 'options'.
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<crypto::tink::RandomAccessStream>>
+  New(std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      const StreamingAead::RandomAccessOptions& options);
+
+  // A PRead() spanning several segments reads the ciphertext of up to this
+  // many bytes of consecutive segments from the ciphertext source at once,
+  // and then authenticates and decrypts it segment by segment.  So small
+  // segments keep random PReads cheap, while long sequential PReads need
+  // about as few source reads as with large segments.
+  static constexpr int kMaxCoalescedReadSize = 1 << 20;
+
+  // Returns the ranges of a ciphertext of 'ciphertext_size' bytes that a
+  // stream using 'segment_decrypter' reads for PRead('position', 'count'),
+  // as described in StreamingAead::PlanCiphertextRanges().  Only the sizes
+  // of 'segment_decrypter' are used, so it need not be initialized.
+  static crypto::tink::util::StatusOr<
+      std::vector<StreamingAead::CiphertextRange>>
+  PlanCiphertextRanges(const StreamSegmentDecrypter& segment_decrypter,
+                       int64_t ciphertext_size, int64_t position,
+                       int64_t count, int64_t max_gap);
+
+  ~DecryptingRandomAccessStream() override;
+
   // -----------------------
   // Methods of RandomAccessStream-interface implemented by this class.
   crypto::tink::util::Status PRead(
@@ -60,11 +97,42 @@ class DecryptingRandomAccessStream : public crypto::tink::RandomAccessStream {
   DecryptingRandomAccessStream() {}
   crypto::tink::util::Status PReadAndDecrypt(
       int64_t position, int count, crypto::tink::util::Buffer* dest_buffer);
+  // Like PReadAndDecrypt(), but gets the segments via GetSegment(), in
+  // parallel if pool_ is set, and schedules readahead.
+  crypto::tink::util::Status PReadSegments(
+      int64_t position, int count, crypto::tink::util::Buffer* dest_buffer);
+  // Returns the plaintext of the specified segment, from the cache if
+  // possible, and adds it to the cache otherwise.
+  crypto::tink::util::StatusOr<std::shared_ptr<const std::vector<uint8_t>>>
+  GetSegment(int64_t segment_nr);
+  // Decrypts the specified segment into a new plaintext vector.
+  crypto::tink::util::StatusOr<std::shared_ptr<const std::vector<uint8_t>>>
+  DecryptSegment(int64_t segment_nr);
+  // Adds the specified segment to the cache, evicting the least recently
+  // used one if the cache is full.
+  void CacheSegment(int64_t segment_nr,
+                    std::shared_ptr<const std::vector<uint8_t>> segment)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(cache_mutex_);
+  // Schedules readahead of the segments following 'last_segment_nr',
+  // if the PRead() that ended there continued the previous one.
+  void ScheduleReadahead(int64_t first_segment_nr, int64_t last_segment_nr);
+  // Decrypts the specified segment into the cache, on a worker thread.
+  void Prefetch(int64_t segment_nr);
+  // Reads 'segment_count' consecutive ciphertext segments, starting with
+  // 'first_segment_nr', from ct_source_ with a single read, and sets 'ct'
+  // to their bytes. If ct_source_ supports PReadView(), 'ct' points into
+  // ct_source_ and no bytes are copied; otherwise the segments are read into
+  // *ct_buffer, which is (re)allocated if it is null or too small.
+  crypto::tink::util::Status ReadSegments(
+      int64_t first_segment_nr, int segment_count,
+      std::unique_ptr<crypto::tink::util::Buffer>* ct_buffer,
+      absl::Span<const uint8_t>* ct);
   // Reads the specified ciphertext segment from ct_source_, decrypts it,
   // and writes the resulting plaintext bytes to pt_segment.
-  // Uses the provided ct_buffer as a buffer for the ciphertext segment.
+  // Uses ct_buffer as in ReadSegments().
   crypto::tink::util::Status ReadAndDecryptSegment(
-      int64_t segment_nr, crypto::tink::util::Buffer* ct_buffer,
+      int64_t segment_nr,
+      std::unique_ptr<crypto::tink::util::Buffer>* ct_buffer,
       std::vector<uint8_t>* pt_segment);
   // Returns the segment number that contains the specified 'pt_position'.
   int64_t GetSegmentNr(int64_t pt_position);
@@ -74,11 +142,17 @@ class DecryptingRandomAccessStream : public crypto::tink::RandomAccessStream {
   // by reading the stream header from ct_source_ and using it initialize
   // segment_decrypter_.
   void InitializeIfNeeded();
+  // Returns OK once the stream is initialized, without taking status_mutex_
+  // after the first success, and otherwise the error of InitializeIfNeeded().
+  crypto::tink::util::Status EnsureInitialized();
   std::unique_ptr<StreamSegmentDecrypter> segment_decrypter_;
   std::unique_ptr<crypto::tink::RandomAccessStream> ct_source_;
 
   mutable absl::Mutex status_mutex_;
   crypto::tink::util::Status status_ ABSL_GUARDED_BY(status_mutex_);
+  // Set when the initialization succeeded.  The fields below are written
+  // before, and immutable after, so readers that see it set need no lock.
+  std::atomic<bool> initialized_{false};
   int header_size_;
   int ct_offset_;
   int ct_segment_size_;
@@ -86,6 +160,31 @@ class DecryptingRandomAccessStream : public crypto::tink::RandomAccessStream {
   int ct_segment_overhead_;
   int64_t segment_count_;
   int64_t pt_size_;
+
+  // Options, see StreamingAead::RandomAccessOptions.
+  int cache_segments_ = 0;
+  int readahead_segments_ = 0;
+
+  // The cache of decrypted segments, most recently used first.
+  struct CacheEntry {
+    std::shared_ptr<const std::vector<uint8_t>> segment;
+    std::list<int64_t>::iterator lru_position;
+  };
+  absl::Mutex cache_mutex_;
+  absl::CondVar prefetch_done_;
+  absl::flat_hash_map<int64_t, CacheEntry> cache_
+      ABSL_GUARDED_BY(cache_mutex_);
+  std::list<int64_t> lru_ ABSL_GUARDED_BY(cache_mutex_);
+  // Segments that are being decrypted by Prefetch().
+  absl::flat_hash_set<int64_t> prefetching_ ABSL_GUARDED_BY(cache_mutex_);
+  // The segment following the last one read by PReadSegments().
+  int64_t next_sequential_segment_nr_ ABSL_GUARDED_BY(cache_mutex_) = 0;
+  bool closing_ ABSL_GUARDED_BY(cache_mutex_) = false;
+
+  // The executor of the options, or else worker threads owned by the
+  // stream, null unless parallelism > 1.  Declared last, so that owned
+  // threads are joined before any other member is destroyed.
+  std::shared_ptr<crypto::tink::Executor> pool_;
 };
 
 }  // namespace subtle
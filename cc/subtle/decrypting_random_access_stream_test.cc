@@ -17,6 +17,7 @@
 #include "tink/subtle/decrypting_random_access_stream.h"
 
 #include <sstream>
+#include <thread>  // NOLINT(build/c++11)
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -28,8 +29,11 @@
 #include "tink/streaming_aead.h"
 #include "tink/subtle/random.h"
 #include "tink/subtle/test_util.h"
+#include "tink/thread_pool_executor.h"
 #include "tink/util/file_random_access_stream.h"
+#include "tink/util/mmap_random_access_stream.h"
 #include "tink/util/ostream_output_stream.h"
+#include "tink/util/prefetched_random_access_stream.h"
 #include "tink/util/status.h"
 #include "tink/util/test_matchers.h"
 #include "tink/util/test_util.h"
@@ -73,6 +77,34 @@ class DummyRandomAccessStream : public RandomAccessStream {
   int ct_offset_;
 };
 
+// A RandomAccessStream that counts the PRead()-calls to another one.
+class CountingRandomAccessStream : public RandomAccessStream {
+ public:
+  explicit CountingRandomAccessStream(std::unique_ptr<RandomAccessStream> in)
+      : in_(std::move(in)), pread_count_(0), bytes_read_(0) {}
+
+  crypto::tink::util::Status PRead(
+      int64_t position, int count,
+      crypto::tink::util::Buffer* dest_buffer) override {
+    pread_count_++;
+    auto status = in_->PRead(position, count, dest_buffer);
+    bytes_read_ += dest_buffer->size();
+    return status;
+  }
+
+  crypto::tink::util::StatusOr<int64_t> size() override {
+    return in_->size();
+  }
+
+  int pread_count() const { return pread_count_; }
+  int64_t bytes_read() const { return bytes_read_; }
+
+ private:
+  std::unique_ptr<RandomAccessStream> in_;
+  int pread_count_;
+  int64_t bytes_read_;
+};
+
 // Creates a RandomAccessStream with the specified contents.
 std::unique_ptr<RandomAccessStream> GetRandomAccessStream(
     absl::string_view contents) {
@@ -226,6 +258,104 @@ TEST(DecryptingRandomAccessStreamTest, BasicDecryption) {
   }
 }
 
+TEST(DecryptingRandomAccessStreamTest, CoalescedSegmentReads) {
+  int pt_segment_size = 100;
+  int header_size = 10;
+  int ct_offset = 3;
+  int ct_segment_size =
+      pt_segment_size + test::DummyStreamSegmentEncrypter::kSegmentTagSize;
+  std::string plaintext = subtle::Random::GetRandomBytes(100000);
+  DummyStreamingAead saead(pt_segment_size, header_size, ct_offset);
+  auto ciphertext = absl::make_unique<CountingRandomAccessStream>(
+      GetCiphertextSource(&saead, plaintext, "some aad", ct_offset));
+  CountingRandomAccessStream* ciphertext_ptr = ciphertext.get();
+  auto dec_stream = std::move(DecryptingRandomAccessStream::New(
+      absl::make_unique<DummyStreamSegmentDecrypter>(
+          pt_segment_size, header_size, ct_offset),
+      std::move(ciphertext)).ValueOrDie());
+  auto buffer = std::move(util::Buffer::New(plaintext.size()).ValueOrDie());
+
+  // A small PRead reads a single segment.
+  auto status = dec_stream->PRead(4242, 10, buffer.get());
+  EXPECT_THAT(status, IsOk());
+  EXPECT_EQ(plaintext.substr(4242, 10),
+            std::string(buffer->get_mem_block(), buffer->size()));
+  int pread_count = ciphertext_ptr->pread_count();
+  int64_t bytes_read = ciphertext_ptr->bytes_read();
+
+  // Long PReads read many segments at once, and from any position.
+  for (int position : {0, 1, 99, 1234, 50000}) {
+    SCOPED_TRACE(absl::StrCat("position = ", position));
+    status = dec_stream->PRead(position, plaintext.size(), buffer.get());
+    EXPECT_THAT(status, StatusIs(util::error::OUT_OF_RANGE));
+    EXPECT_EQ(plaintext.substr(position),
+              std::string(buffer->get_mem_block(), buffer->size()));
+    EXPECT_EQ(pread_count + 1, ciphertext_ptr->pread_count());
+    pread_count = ciphertext_ptr->pread_count();
+  }
+  // The small PRead read (at most) one ciphertext segment after the header.
+  EXPECT_LE(bytes_read, header_size + ct_segment_size);
+}
+
+TEST(DecryptingRandomAccessStreamTest, ConcurrentPReads) {
+  int pt_segment_size = 100;
+  int header_size = 10;
+  int ct_offset = 3;
+  std::string plaintext = subtle::Random::GetRandomBytes(50000);
+  DummyStreamingAead saead(pt_segment_size, header_size, ct_offset);
+  auto dec_stream = std::move(DecryptingRandomAccessStream::New(
+      absl::make_unique<DummyStreamSegmentDecrypter>(
+          pt_segment_size, header_size, ct_offset),
+      GetCiphertextSource(&saead, plaintext, "some aad", ct_offset))
+      .ValueOrDie());
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&dec_stream, &plaintext, t]() {
+      auto buffer = std::move(util::Buffer::New(1000).ValueOrDie());
+      for (int i = 0; i < 200; i++) {
+        int position = (t * 7919 + i * 104729) % plaintext.size();
+        int count = 1 + (t * 31 + i * 17) % 1000;
+        auto status = dec_stream->PRead(position, count, buffer.get());
+        int expected_size =
+            std::min<int>(count, plaintext.size() - position);
+        if (position + count >= plaintext.size()) {
+          EXPECT_THAT(status, StatusIs(util::error::OUT_OF_RANGE));
+        } else {
+          EXPECT_THAT(status, IsOk());
+        }
+        ASSERT_EQ(expected_size, buffer->size());
+        EXPECT_EQ(plaintext.substr(position, expected_size),
+                  std::string(buffer->get_mem_block(), buffer->size()));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+TEST(DecryptingRandomAccessStreamTest, NestedStreams) {
+  // The ciphertext source of the inner stream is the outer one, so each
+  // PRead() of the inner stream nests one of the outer stream.
+  int pt_segment_size = 100;
+  int header_size = 10;
+  std::string plaintext = subtle::Random::GetRandomBytes(5000);
+  DummyStreamingAead saead(pt_segment_size, header_size, 0);
+  std::string inner_ct = GetCiphertext(&saead, plaintext, "inner", 0);
+  auto outer_stream = std::move(DecryptingRandomAccessStream::New(
+      absl::make_unique<DummyStreamSegmentDecrypter>(
+          pt_segment_size, header_size, 0),
+      GetCiphertextSource(&saead, inner_ct, "outer", 0))
+      .ValueOrDie());
+  auto inner_stream = std::move(DecryptingRandomAccessStream::New(
+      absl::make_unique<DummyStreamSegmentDecrypter>(
+          pt_segment_size, header_size, 0),
+      std::move(outer_stream))
+      .ValueOrDie());
+  std::string decrypted;
+  EXPECT_THAT(ReadAll(inner_stream.get(), &decrypted),
+              StatusIs(util::error::OUT_OF_RANGE));
+  EXPECT_EQ(plaintext, decrypted);
+}
+
 TEST(DecryptingRandomAccessStreamTest, SelectiveDecryption) {
   for (int pt_size : {1, 20, 42, 100, 1000, 10000}) {
     std::string plaintext = subtle::Random::GetRandomBytes(pt_size);
@@ -273,6 +403,107 @@ TEST(DecryptingRandomAccessStreamTest, SelectiveDecryption) {
   }
 }
 
+TEST(DecryptingRandomAccessStreamTest, PlannedCiphertextRanges) {
+  // Decrypting from only the planned ranges of the ciphertext succeeds, since
+  // reading any other byte fails.
+  int pt_segment_size = 100;
+  int header_size = 10;
+  for (int ct_offset : {0, 7}) {
+    DummyStreamingAead saead(pt_segment_size, header_size, ct_offset);
+    DummyStreamSegmentDecrypter planning_decrypter(pt_segment_size,
+                                                   header_size, ct_offset);
+    int pt_size = 1000;
+    std::string plaintext = subtle::Random::GetRandomBytes(pt_size);
+    std::string ciphertext =
+        GetCiphertext(&saead, plaintext, "some aad", ct_offset);
+    for (int position : {0, 1, 80, 250, 999, 1000}) {
+      for (int count : {1, 20, 300, 2000}) {
+        for (int max_gap : {0, 1 << 20}) {
+          SCOPED_TRACE(absl::StrCat("ct_offset = ", ct_offset,
+                                    ", position = ", position,
+                                    ", count = ", count,
+                                    ", max_gap = ", max_gap));
+          auto plan_result = DecryptingRandomAccessStream::PlanCiphertextRanges(
+              planning_decrypter, ciphertext.size(), position, count, max_gap);
+          ASSERT_THAT(plan_result.status(), IsOk());
+          const auto& ranges = plan_result.ValueOrDie();
+          ASSERT_LE(ranges.size(), max_gap == 0 ? 2 : 1);
+          auto ct_source =
+              absl::make_unique<util::PrefetchedRandomAccessStream>(
+                  ciphertext.size());
+          for (const auto& range : ranges) {
+            ASSERT_THAT(ct_source->AddRange(range.position,
+                                            ciphertext.substr(range.position,
+                                                              range.size)),
+                        IsOk());
+          }
+          auto dec_stream_result = DecryptingRandomAccessStream::New(
+              absl::make_unique<DummyStreamSegmentDecrypter>(
+                  pt_segment_size, header_size, ct_offset),
+              std::move(ct_source));
+          ASSERT_THAT(dec_stream_result.status(), IsOk());
+          auto buffer = std::move(util::Buffer::New(count).ValueOrDie());
+          auto status = dec_stream_result.ValueOrDie()->PRead(position, count,
+                                                              buffer.get());
+          EXPECT_TRUE(status.ok() ||
+                      status.error_code() == util::error::OUT_OF_RANGE)
+              << status;
+          EXPECT_EQ(plaintext.substr(position, count),
+                    std::string(buffer->get_mem_block(), buffer->size()));
+        }
+      }
+    }
+  }
+}
+
+TEST(DecryptingRandomAccessStreamTest, MmapCiphertextSource) {
+  // With a ciphertext source that supports PReadView(), the segments are
+  // decrypted without copying the ciphertext, and full segments directly
+  // into the destination buffer.
+  for (int pt_size : {0, 1, 42, 100, 1000, 10000}) {
+    std::string plaintext = subtle::Random::GetRandomBytes(pt_size);
+    for (int pt_segment_size : {50, 123}) {
+      int header_size = 10;
+      int ct_offset = 5;
+      SCOPED_TRACE(absl::StrCat("pt_size = ", pt_size,
+                                ", pt_segment_size = ", pt_segment_size));
+      DummyStreamingAead saead(pt_segment_size, header_size, ct_offset);
+      std::string filename =
+          absl::StrCat("mmap_ct_", pt_size, "_", pt_segment_size, ".bin");
+      int ct_fd = GetTestFileDescriptor(
+          filename, GetCiphertext(&saead, plaintext, "some aad", ct_offset));
+      auto ciphertext_result = util::MmapRandomAccessStream::New(ct_fd);
+      ASSERT_THAT(ciphertext_result.status(), IsOk());
+      auto seg_decrypter = absl::make_unique<DummyStreamSegmentDecrypter>(
+          pt_segment_size, header_size, ct_offset);
+      auto dec_stream_result = DecryptingRandomAccessStream::New(
+          std::move(seg_decrypter), std::move(ciphertext_result.ValueOrDie()));
+      ASSERT_THAT(dec_stream_result.status(), IsOk());
+      auto dec_stream = std::move(dec_stream_result.ValueOrDie());
+      EXPECT_EQ(pt_size, dec_stream->size().ValueOrDie());
+      std::string decrypted;
+      EXPECT_THAT(ReadAll(dec_stream.get(), &decrypted),
+                  StatusIs(util::error::OUT_OF_RANGE, HasSubstr("EOF")));
+      EXPECT_EQ(plaintext, decrypted);
+      for (int position : {0, 1, pt_size / 2}) {
+        for (int chunk_size : {1, pt_segment_size, pt_size}) {
+          if (position > pt_size || chunk_size == 0) continue;
+          SCOPED_TRACE(absl::StrCat("position = ", position,
+                                    ", chunk_size = ", chunk_size));
+          auto buffer = std::move(util::Buffer::New(chunk_size).ValueOrDie());
+          auto status = dec_stream->PRead(position, chunk_size, buffer.get());
+          EXPECT_TRUE(status.ok() ||
+                      status.error_code() == util::error::OUT_OF_RANGE);
+          EXPECT_EQ(std::min(chunk_size, std::max(pt_size - position, 0)),
+                    buffer->size());
+          EXPECT_EQ(0, std::memcmp(plaintext.data() + position,
+                                   buffer->get_mem_block(), buffer->size()));
+        }
+      }
+    }
+  }
+}
+
 TEST(DecryptingRandomAccessStreamTest, TruncatedCiphertextDecryption) {
   for (int pt_size : {100, 200, 1000}) {
     std::string plaintext = subtle::Random::GetRandomBytes(pt_size);
@@ -363,6 +594,128 @@ TEST(DecryptingRandomAccessStreamTest, OutOfRangeDecryption) {
   }
 }
 
+TEST(DecryptingRandomAccessStreamTest, DecryptionWithOptions) {
+  std::vector<StreamingAead::RandomAccessOptions> all_options(6);
+  all_options[0].cache_segments = 3;
+  all_options[1].parallelism = 4;
+  all_options[2].cache_segments = 8;
+  all_options[2].readahead_segments = 4;
+  all_options[2].parallelism = 3;
+  all_options[3].cache_segments = 1;
+  all_options[3].readahead_segments = 1;
+  all_options[3].parallelism = 2;
+  // The streams share the executor, and wait for its tasks when destroyed.
+  all_options[4].cache_segments = 4;
+  all_options[4].readahead_segments = 4;
+  all_options[4].executor = NewThreadPoolExecutor(2);
+  all_options[5].executor = NewThreadPoolExecutor(0);
+  for (const auto& options : all_options) {
+    for (int pt_size : {0, 1, 42, 1000, 10000}) {
+      std::string plaintext = subtle::Random::GetRandomBytes(pt_size);
+      for (int pt_segment_size : {50, 123}) {
+        int header_size = 10;
+        int ct_offset = 5;
+        SCOPED_TRACE(absl::StrCat(
+            "cache_segments = ", options.cache_segments,
+            ", readahead_segments = ", options.readahead_segments,
+            ", parallelism = ", options.parallelism,
+            ", executor = ", options.executor != nullptr,
+            ", pt_size = ", pt_size, ", pt_segment_size = ", pt_segment_size));
+        DummyStreamingAead saead(pt_segment_size, header_size, ct_offset);
+        auto dec_stream_result = DecryptingRandomAccessStream::New(
+            absl::make_unique<DummyStreamSegmentDecrypter>(
+                pt_segment_size, header_size, ct_offset),
+            GetCiphertextSource(&saead, plaintext, "some aad", ct_offset),
+            options);
+        ASSERT_THAT(dec_stream_result.status(), IsOk());
+        auto dec_stream = std::move(dec_stream_result.ValueOrDie());
+        EXPECT_EQ(pt_size, dec_stream->size().ValueOrDie());
+
+        // Sequential reads.
+        std::string decrypted;
+        EXPECT_THAT(ReadAll(dec_stream.get(), &decrypted),
+                    StatusIs(util::error::OUT_OF_RANGE, HasSubstr("EOF")));
+        EXPECT_EQ(plaintext, decrypted);
+
+        // Reads of various ranges, some spanning many segments.
+        for (int position : {0, 1, pt_size / 3, pt_size / 2, pt_size}) {
+          if (position > pt_size) continue;
+          for (int chunk_size : {0, 1, 100, pt_size / 2, pt_size, 20000}) {
+            SCOPED_TRACE(absl::StrCat("position = ", position,
+                                      ", chunk_size = ", chunk_size));
+            auto buffer = std::move(
+                util::Buffer::New(std::max(chunk_size, 1)).ValueOrDie());
+            auto status =
+                dec_stream->PRead(position, chunk_size, buffer.get());
+            int expected_size = std::min(chunk_size, pt_size - position);
+            if (chunk_size > 0 && position + chunk_size >= pt_size) {
+              EXPECT_THAT(status, StatusIs(util::error::OUT_OF_RANGE));
+            } else {
+              EXPECT_THAT(status, IsOk());
+            }
+            ASSERT_EQ(expected_size, buffer->size());
+            EXPECT_EQ(plaintext.substr(position, expected_size),
+                      std::string(buffer->get_mem_block(), buffer->size()));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(DecryptingRandomAccessStreamTest, CacheDecryptsEachSegmentOnce) {
+  int pt_size = 1000;
+  int pt_segment_size = 100;
+  int header_size = 10;
+  std::string plaintext = subtle::Random::GetRandomBytes(pt_size);
+  DummyStreamingAead saead(pt_segment_size, header_size, /* ct_offset = */ 0);
+  auto seg_decrypter = absl::make_unique<DummyStreamSegmentDecrypter>(
+      pt_segment_size, header_size, /* ct_offset = */ 0);
+  DummyStreamSegmentDecrypter* seg_decrypter_ptr = seg_decrypter.get();
+  StreamingAead::RandomAccessOptions options;
+  options.cache_segments = 11;
+  auto dec_stream_result = DecryptingRandomAccessStream::New(
+      std::move(seg_decrypter),
+      GetCiphertextSource(&saead, plaintext, "some aad", /* ct_offset = */ 0),
+      options);
+  ASSERT_THAT(dec_stream_result.status(), IsOk());
+  auto dec_stream = std::move(dec_stream_result.ValueOrDie());
+
+  // Many small, overlapping reads.
+  auto buffer = std::move(util::Buffer::New(30).ValueOrDie());
+  for (int i = 0; i < 3; i++) {
+    for (int position = 0; position < pt_size; position += 7) {
+      auto status = dec_stream->PRead(position, 30, buffer.get());
+      EXPECT_TRUE(status.ok() ||
+                  status.error_code() == util::error::OUT_OF_RANGE);
+      EXPECT_EQ(plaintext.substr(position, buffer->size()),
+                std::string(buffer->get_mem_block(), buffer->size()));
+    }
+  }
+  // Every plaintext byte was decrypted only once.
+  EXPECT_EQ(pt_size, seg_decrypter_ptr->get_generated_output_size());
+}
+
+TEST(DecryptingRandomAccessStreamTest, InvalidOptions) {
+  std::vector<StreamingAead::RandomAccessOptions> all_options(4);
+  all_options[0].cache_segments = -1;
+  all_options[1].parallelism = 0;
+  all_options[2].cache_segments = 2;
+  all_options[2].readahead_segments = 3;
+  all_options[2].parallelism = 2;
+  all_options[3].cache_segments = 2;
+  all_options[3].readahead_segments = 2;
+  for (const auto& options : all_options) {
+    auto dec_stream_result = DecryptingRandomAccessStream::New(
+        absl::make_unique<DummyStreamSegmentDecrypter>(
+            /* pt_segment_size = */ 100, /* header_size = */ 10,
+            /* ct_offset = */ 0),
+        GetRandomAccessStream("some ciphertext"), options);
+    EXPECT_THAT(dec_stream_result.status(),
+                StatusIs(util::error::INVALID_ARGUMENT));
+  }
+}
+
 TEST(DecryptingRandomAccessStreamTest, WrongCiphertext) {
   int pt_segment_size = 42;
   int header_size = 10;
@@ -0,0 +1,129 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_DIGEST_OUTPUT_STREAM_H_
+#define TINK_SUBTLE_DIGEST_OUTPUT_STREAM_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "openssl/base.h"
+#include "openssl/digest.h"
+#include "tink/output_stream_with_result.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// An OutputStreamWithResult which hashes the data written to it, and
+// computes its result from the digest when closed.  Signature primitives use
+// it to sign and verify data without holding all of it in memory.
+template <class T>
+class DigestOutputStream : public OutputStreamWithResult<T> {
+ public:
+  using ResultType = typename OutputStreamWithResult<T>::ResultType;
+  // Computes the result of the stream from the digest of the data.
+  using DigestFunction = std::function<ResultType(absl::string_view digest)>;
+
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<OutputStreamWithResult<T>>>
+  New(const EVP_MD* hash, DigestFunction compute_result) {
+    bssl::UniquePtr<EVP_MD_CTX> context(EVP_MD_CTX_new());
+    if (context == nullptr ||
+        EVP_DigestInit_ex(context.get(), hash, nullptr) != 1) {
+      return util::Status(util::error::INTERNAL,
+                          "Could not initialize digest.");
+    }
+    return {absl::WrapUnique<OutputStreamWithResult<T>>(new DigestOutputStream(
+        std::move(context), std::move(compute_result)))};
+  }
+
+  util::StatusOr<int> NextBuffer(void** buffer) override {
+    if (!status_.ok()) return status_;
+    WriteIntoDigest();
+    *buffer = &buffer_[0];
+    position_ += kBufferSize;
+    buffer_position_ = kBufferSize;
+    return buffer_position_;
+  }
+
+  ResultType CloseStreamAndComputeResult() override {
+    if (!status_.ok()) return status_;
+    WriteIntoDigest();
+    if (!status_.ok()) return status_;
+    status_ = util::Status(util::error::FAILED_PRECONDITION, "Stream Closed");
+    uint8_t digest[EVP_MAX_MD_SIZE];
+    unsigned int digest_size;
+    if (EVP_DigestFinal_ex(context_.get(), digest, &digest_size) != 1) {
+      return util::Status(util::error::INTERNAL, "Could not compute digest.");
+    }
+    return compute_result_(
+        absl::string_view(reinterpret_cast<const char*>(digest), digest_size));
+  }
+
+  void BackUp(int count) override {
+    count = std::min(count, buffer_position_);
+    buffer_position_ -= count;
+    position_ -= count;
+  }
+
+  int64_t Position() const override { return position_; }
+
+ private:
+  static constexpr int kBufferSize = 4096;
+
+  DigestOutputStream(bssl::UniquePtr<EVP_MD_CTX> context,
+                     DigestFunction compute_result)
+      : status_(util::OkStatus()),
+        context_(std::move(context)),
+        compute_result_(std::move(compute_result)),
+        position_(0),
+        buffer_position_(0),
+        buffer_(kBufferSize, '\0') {}
+
+  // Hashes the data in buffer_ up to buffer_position_.
+  void WriteIntoDigest() {
+    if (buffer_position_ > 0 &&
+        EVP_DigestUpdate(context_.get(), buffer_.data(), buffer_position_) !=
+            1) {
+      status_ = util::Status(util::error::INTERNAL, "Could not update digest.");
+    }
+    buffer_position_ = 0;
+  }
+
+  // Stream status: initialized as OK, and changed to FAILED_PRECONDITION
+  // when the stream is closed.
+  util::Status status_;
+  const bssl::UniquePtr<EVP_MD_CTX> context_;
+  const DigestFunction compute_result_;
+  int64_t position_;
+  int buffer_position_;
+  std::string buffer_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_DIGEST_OUTPUT_STREAM_H_
@@ -0,0 +1,103 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/digest_output_stream.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "openssl/digest.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+
+std::string Digest(absl::string_view data, const EVP_MD* hash) {
+  std::vector<uint8_t> digest =
+      boringssl::ComputeHash(SubtleUtilBoringSSL::EnsureNonNull(data), *hash)
+          .ValueOrDie();
+  return std::string(digest.begin(), digest.end());
+}
+
+TEST(DigestOutputStreamTest, ComputesDigestOfWrittenData) {
+  for (const EVP_MD* hash : {EVP_sha256(), EVP_sha384(), EVP_sha512()}) {
+    for (int size : {0, 1, 4095, 4096, 4097, 100000}) {
+      std::string data = Random::GetRandomBytes(size);
+      auto stream_or = DigestOutputStream<std::string>::New(
+          hash, [](absl::string_view digest) {
+            return util::StatusOr<std::string>(std::string(digest));
+          });
+      ASSERT_THAT(stream_or.status(), IsOk());
+      auto stream = std::move(stream_or.ValueOrDie());
+      ASSERT_THAT(test::WriteToStream(stream.get(), data), IsOk());
+      EXPECT_EQ(stream->Position(), size);
+      auto digest_or = stream->GetResult();
+      ASSERT_THAT(digest_or.status(), IsOk());
+      EXPECT_EQ(digest_or.ValueOrDie(), Digest(data, hash)) << size;
+    }
+  }
+}
+
+TEST(DigestOutputStreamTest, BackedUpDataIsNotHashed) {
+  auto stream = DigestOutputStream<std::string>::New(
+                    EVP_sha256(),
+                    [](absl::string_view digest) {
+                      return util::StatusOr<std::string>(std::string(digest));
+                    })
+                    .ValueOrDie();
+  void* buffer;
+  auto next_or = stream->Next(&buffer);
+  ASSERT_THAT(next_or.status(), IsOk());
+  memcpy(buffer, "some data", 9);
+  stream->BackUp(next_or.ValueOrDie() - 4);
+  EXPECT_EQ(stream->Position(), 4);
+  EXPECT_EQ(stream->CloseAndGetResult().ValueOrDie(),
+            Digest("some", EVP_sha256()));
+}
+
+TEST(DigestOutputStreamTest, PassesResultThrough) {
+  auto stream = DigestOutputStream<util::Status>::New(
+                    EVP_sha256(),
+                    [](absl::string_view digest) {
+                      return util::Status(util::error::INVALID_ARGUMENT,
+                                          "rejected");
+                    })
+                    .ValueOrDie();
+  EXPECT_THAT(test::WriteToStream(stream.get(), "data"),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(stream->GetResult(), StatusIs(util::error::INVALID_ARGUMENT));
+  void* buffer;
+  EXPECT_THAT(stream->Next(&buffer).status(),
+              StatusIs(util::error::FAILED_PRECONDITION));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
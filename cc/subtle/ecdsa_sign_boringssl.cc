@@ -16,10 +16,14 @@
 
 #include "tink/subtle/ecdsa_sign_boringssl.h"
 
-#include <vector>
+#include <cstddef>
+#include <memory>
+#include <string>
 
 #include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/digest_output_stream.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/errors.h"
 #include "openssl/bn.h"
@@ -31,41 +35,6 @@ namespace crypto {
 namespace tink {
 namespace subtle {
 
-namespace {
-
-// Transforms ECDSA DER signature encoding to IEEE_P1363 encoding.
-//
-// The IEEE_P1363 signature's format is r || s, where r and s are zero-padded
-// and have the same size in bytes as the order of the curve. For example, for
-// NIST P-256 curve, r and s are zero-padded to 32 bytes.
-//
-// The DER signature is encoded using ASN.1
-// (https://tools.ietf.org/html/rfc5480#appendix-A): ECDSA-Sig-Value :: =
-// SEQUENCE { r INTEGER, s INTEGER }. In particular, the encoding is: 0x30 ||
-// totalLength || 0x02 || r's length || r || 0x02 || s's length || s.
-crypto::tink::util::StatusOr<std::string> DerToIeee(absl::string_view der,
-                                                    const EC_KEY* key) {
-  size_t field_size_in_bytes =
-      (EC_GROUP_get_degree(EC_KEY_get0_group(key)) + 7) / 8;
-  bssl::UniquePtr<ECDSA_SIG> ecdsa(ECDSA_SIG_from_bytes(
-      reinterpret_cast<const uint8_t*>(der.data()), der.size()));
-  if (ecdsa.get() == nullptr) {
-    return util::Status(util::error::INTERNAL,
-                        "Internal BoringSSL ECDSA_SIG_from_bytes's error");
-  }
-  auto status_or_r = SubtleUtilBoringSSL::bn2str(ecdsa->r, field_size_in_bytes);
-  if (!status_or_r.ok()) {
-    return status_or_r.status();
-  }
-  auto status_or_s = SubtleUtilBoringSSL::bn2str(ecdsa->s, field_size_in_bytes);
-  if (!status_or_s.ok()) {
-    return status_or_s.status();
-  }
-  return status_or_r.ValueOrDie() + status_or_s.ValueOrDie();
-}
-
-}  // namespace
-
 // static
 util::StatusOr<std::unique_ptr<EcdsaSignBoringSsl>> EcdsaSignBoringSsl::New(
     const SubtleUtilBoringSSL::EcKey& ec_key, HashType hash_type,
@@ -118,10 +87,31 @@ util::StatusOr<std::unique_ptr<EcdsaSignBoringSsl>> EcdsaSignBoringSsl::New(
 EcdsaSignBoringSsl::EcdsaSignBoringSsl(bssl::UniquePtr<EC_KEY> key,
                                        const EVP_MD* hash,
                                        EcdsaSignatureEncoding encoding)
-    : key_(std::move(key)), hash_(hash), encoding_(encoding) {}
+    : key_(std::move(key)),
+      hash_(hash),
+      encoding_(encoding),
+      field_size_in_bytes_(
+          (EC_GROUP_get_degree(EC_KEY_get0_group(key_.get())) + 7) / 8) {}
+
+size_t EcdsaSignBoringSsl::MaxSignatureSize() const {
+  if (encoding_ == subtle::EcdsaSignatureEncoding::IEEE_P1363) {
+    return 2 * field_size_in_bytes_;
+  }
+  return ECDSA_size(key_.get());
+}
 
 util::StatusOr<std::string> EcdsaSignBoringSsl::Sign(
     absl::string_view data) const {
+  std::string signature(MaxSignatureSize(), '\0');
+  auto size_result =
+      SignInto(data, absl::MakeSpan(&signature[0], signature.size()));
+  if (!size_result.ok()) return size_result.status();
+  signature.resize(size_result.ValueOrDie());
+  return signature;
+}
+
+util::StatusOr<size_t> EcdsaSignBoringSsl::SignInto(
+    absl::string_view data, absl::Span<char> signature) const {
   // BoringSSL expects a non-null pointer for data,
   // regardless of whether the size is 0.
   data = SubtleUtilBoringSSL::EnsureNonNull(data);
@@ -133,26 +123,63 @@ util::StatusOr<std::string> EcdsaSignBoringSsl::Sign(
                   nullptr)) {
     return util::Status(util::error::INTERNAL, "Could not compute digest.");
   }
+  return SignDigestInto(
+      absl::string_view(reinterpret_cast<const char*>(digest), digest_size),
+      signature);
+}
 
-  // Compute the signature.
-  std::vector<uint8_t> buffer(ECDSA_size(key_.get()));
-  unsigned int sig_length;
-  if (1 != ECDSA_sign(0 /* unused */, digest, digest_size, buffer.data(),
-                  &sig_length, key_.get())) {
-    return util::Status(util::error::INTERNAL, "Signing failed.");
+util::StatusOr<std::unique_ptr<OutputStreamWithResult<std::string>>>
+EcdsaSignBoringSsl::NewSignOutputStream() const {
+  return DigestOutputStream<std::string>::New(
+      hash_, [this](absl::string_view digest) { return SignDigest(digest); });
+}
+
+util::StatusOr<std::string> EcdsaSignBoringSsl::SignDigest(
+    absl::string_view digest) const {
+  if (digest.size() != EVP_MD_size(hash_)) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Digest has the wrong size.");
   }
 
+  std::string signature(MaxSignatureSize(), '\0');
+  auto size_result =
+      SignDigestInto(digest, absl::MakeSpan(&signature[0], signature.size()));
+  if (!size_result.ok()) return size_result.status();
+  signature.resize(size_result.ValueOrDie());
+  return signature;
+}
+
+util::StatusOr<size_t> EcdsaSignBoringSsl::SignDigestInto(
+    absl::string_view digest, absl::Span<char> signature) const {
+  if (signature.size() < MaxSignatureSize()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Output buffer is too small for the signature.");
+  }
+  const uint8_t* digest_bytes = reinterpret_cast<const uint8_t*>(digest.data());
+  uint8_t* out = reinterpret_cast<uint8_t*>(signature.data());
+
   if (encoding_ == subtle::EcdsaSignatureEncoding::IEEE_P1363) {
-    auto status_or_sig = DerToIeee(
-        std::string(reinterpret_cast<char*>(buffer.data()), sig_length),
-        key_.get());
-    if (!status_or_sig.ok()) {
-      return status_or_sig.status();
+    // Writes r and s, zero-padded to the size of the field, straight into
+    // the output rather than DER-encoding the signature and decoding it.
+    bssl::UniquePtr<ECDSA_SIG> sig(
+        ECDSA_do_sign(digest_bytes, digest.size(), key_.get()));
+    if (sig == nullptr) {
+      return util::Status(util::error::INTERNAL, "Signing failed.");
+    }
+    if (1 != BN_bn2bin_padded(out, field_size_in_bytes_, sig->r) ||
+        1 != BN_bn2bin_padded(out + field_size_in_bytes_,
+                              field_size_in_bytes_, sig->s)) {
+      return util::Status(util::error::INTERNAL, "Value too large");
     }
-    return status_or_sig.ValueOrDie();
+    return 2 * field_size_in_bytes_;
   }
 
-  return std::string(reinterpret_cast<char*>(buffer.data()), sig_length);
+  unsigned int sig_length;
+  if (1 != ECDSA_sign(0 /* unused */, digest_bytes, digest.size(), out,
+                      &sig_length, key_.get())) {
+    return util::Status(util::error::INTERNAL, "Signing failed.");
+  }
+  return sig_length;
 }
 
 }  // namespace subtle
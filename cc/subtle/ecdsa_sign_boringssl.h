@@ -17,10 +17,14 @@
 #ifndef TINK_SUBTLE_ECDSA_SIGN_BORINGSSL_H_
 #define TINK_SUBTLE_ECDSA_SIGN_BORINGSSL_H_
 
+#include <cstddef>
 #include <memory>
+#include <string>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/config/tink_fips.h"
+#include "tink/output_stream_with_result.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/public_key_sign.h"
@@ -43,6 +47,24 @@ class EcdsaSignBoringSsl : public PublicKeySign {
   crypto::tink::util::StatusOr<std::string> Sign(
       absl::string_view data) const override;
 
+  // Returns the maximum size of the signatures computed by this signer.
+  size_t MaxSignatureSize() const;
+
+  // Computes the signature for 'data' into 'signature', which must be at
+  // least MaxSignatureSize() bytes long, and returns the size of the
+  // signature.
+  crypto::tink::util::StatusOr<size_t> SignInto(
+      absl::string_view data, absl::Span<char> signature) const;
+
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<OutputStreamWithResult<std::string>>>
+  NewSignOutputStream() const override;
+
+  // Computes the signature for data whose digest under the hash function of
+  // this signer is 'digest', for callers which have hashed the data already.
+  crypto::tink::util::StatusOr<std::string> SignDigest(
+      absl::string_view digest) const;
+
   static constexpr crypto::tink::FipsCompatibility kFipsStatus =
       crypto::tink::FipsCompatibility::kRequiresBoringCrypto;
 
@@ -50,9 +72,14 @@ class EcdsaSignBoringSsl : public PublicKeySign {
   EcdsaSignBoringSsl(bssl::UniquePtr<EC_KEY> key, const EVP_MD* hash,
                      EcdsaSignatureEncoding encoding);
 
+  crypto::tink::util::StatusOr<size_t> SignDigestInto(
+      absl::string_view digest, absl::Span<char> signature) const;
+
   bssl::UniquePtr<EC_KEY> key_;
   const EVP_MD* hash_;  // Owned by BoringSSL.
   EcdsaSignatureEncoding encoding_;
+  // The size of each of r and s in IEEE_P1363 signatures.
+  size_t field_size_in_bytes_;
 };
 
 }  // namespace subtle
@@ -17,6 +17,7 @@
 #include "tink/subtle/ecdsa_sign_boringssl.h"
 
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "tink/public_key_sign.h"
@@ -25,6 +26,7 @@
 #include "tink/subtle/ec_util.h"
 #include "tink/subtle/ecdsa_verify_boringssl.h"
 #include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/subtle/test_util.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "tink/util/test_matchers.h"
@@ -35,6 +37,7 @@ namespace tink {
 namespace subtle {
 namespace {
 
+using ::crypto::tink::test::IsOk;
 using ::crypto::tink::test::StatusIs;
 
 class EcdsaSignBoringSslTest : public ::testing::Test {
@@ -184,6 +187,136 @@ TEST_F(EcdsaSignBoringSslTest, TestFipsFailWithoutBoringCrypto) {
               StatusIs(util::error::INTERNAL));
 }
 
+TEST_F(EcdsaSignBoringSslTest, StreamingSignAndVerify) {
+  if (kUseOnlyFips && !FIPS_mode()) {
+    GTEST_SKIP()
+        << "Test is skipped if kOnlyUseFips but BoringCrypto is unavailable.";
+  }
+  auto ec_key = SubtleUtilBoringSSL::GetNewEcKey(EllipticCurveType::NIST_P384)
+                    .ValueOrDie();
+  auto signer = EcdsaSignBoringSsl::New(ec_key, HashType::SHA384,
+                                        EcdsaSignatureEncoding::DER)
+                    .ValueOrDie();
+  auto verifier = EcdsaVerifyBoringSsl::New(ec_key, HashType::SHA384,
+                                            EcdsaSignatureEncoding::DER)
+                      .ValueOrDie();
+  std::string message(10000, 'm');
+
+  auto sign_stream_or = signer->NewSignOutputStream();
+  ASSERT_THAT(sign_stream_or.status(), IsOk());
+  auto sign_stream = std::move(sign_stream_or.ValueOrDie());
+  ASSERT_THAT(test::WriteToStream(sign_stream.get(), message), IsOk());
+  auto signature_or = sign_stream->GetResult();
+  ASSERT_THAT(signature_or.status(), IsOk());
+  EXPECT_THAT(verifier->Verify(signature_or.ValueOrDie(), message), IsOk());
+
+  std::string signature = signer->Sign(message).ValueOrDie();
+  auto verify_stream_or = verifier->NewVerifyOutputStream(signature);
+  ASSERT_THAT(verify_stream_or.status(), IsOk());
+  auto verify_stream = std::move(verify_stream_or.ValueOrDie());
+  EXPECT_THAT(test::WriteToStream(verify_stream.get(), message), IsOk());
+
+  verify_stream = verifier->NewVerifyOutputStream(signature).ValueOrDie();
+  EXPECT_THAT(test::WriteToStream(verify_stream.get(), "some bad message"),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(EcdsaSignBoringSslTest, SignAndVerifyDigest) {
+  if (kUseOnlyFips && !FIPS_mode()) {
+    GTEST_SKIP()
+        << "Test is skipped if kOnlyUseFips but BoringCrypto is unavailable.";
+  }
+  auto ec_key = SubtleUtilBoringSSL::GetNewEcKey(EllipticCurveType::NIST_P256)
+                    .ValueOrDie();
+  auto signer = EcdsaSignBoringSsl::New(ec_key, HashType::SHA256,
+                                        EcdsaSignatureEncoding::IEEE_P1363)
+                    .ValueOrDie();
+  auto verifier = EcdsaVerifyBoringSsl::New(ec_key, HashType::SHA256,
+                                            EcdsaSignatureEncoding::IEEE_P1363)
+                      .ValueOrDie();
+  std::string message = "some data to be signed";
+  std::vector<uint8_t> digest_bytes =
+      boringssl::ComputeHash(message, *EVP_sha256()).ValueOrDie();
+  std::string digest(digest_bytes.begin(), digest_bytes.end());
+
+  auto signature_or = signer->SignDigest(digest);
+  ASSERT_THAT(signature_or.status(), IsOk());
+  EXPECT_THAT(verifier->Verify(signature_or.ValueOrDie(), message), IsOk());
+  EXPECT_THAT(
+      verifier->VerifyDigest(signer->Sign(message).ValueOrDie(), digest),
+      IsOk());
+
+  EXPECT_THAT(signer->SignDigest(message).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(verifier->VerifyDigest(signature_or.ValueOrDie(), message),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(EcdsaSignBoringSslTest, SignInto) {
+  if (kUseOnlyFips && !FIPS_mode()) {
+    GTEST_SKIP()
+        << "Test is skipped if kOnlyUseFips but BoringCrypto is unavailable.";
+  }
+  for (EcdsaSignatureEncoding encoding :
+       {EcdsaSignatureEncoding::DER, EcdsaSignatureEncoding::IEEE_P1363}) {
+    auto ec_key = SubtleUtilBoringSSL::GetNewEcKey(EllipticCurveType::NIST_P256)
+                      .ValueOrDie();
+    auto signer =
+        EcdsaSignBoringSsl::New(ec_key, HashType::SHA256, encoding)
+            .ValueOrDie();
+    auto verifier =
+        EcdsaVerifyBoringSsl::New(ec_key, HashType::SHA256, encoding)
+            .ValueOrDie();
+
+    std::string message = "some data to be signed";
+    char buffer[256];
+    auto size_result =
+        signer->SignInto(message, absl::MakeSpan(buffer, sizeof(buffer)));
+    ASSERT_THAT(size_result.status(), IsOk());
+    EXPECT_LE(size_result.ValueOrDie(), signer->MaxSignatureSize());
+    EXPECT_THAT(
+        verifier->Verify(absl::string_view(buffer, size_result.ValueOrDie()),
+                         message),
+        IsOk());
+
+    EXPECT_THAT(signer
+                    ->SignInto(message, absl::MakeSpan(
+                                            buffer,
+                                            signer->MaxSignatureSize() - 1))
+                    .status(),
+                StatusIs(util::error::INVALID_ARGUMENT));
+  }
+}
+
+TEST_F(EcdsaSignBoringSslTest, RejectsMalformedIeeeSignatures) {
+  if (kUseOnlyFips && !FIPS_mode()) {
+    GTEST_SKIP()
+        << "Test is skipped if kOnlyUseFips but BoringCrypto is unavailable.";
+  }
+  auto ec_key = SubtleUtilBoringSSL::GetNewEcKey(EllipticCurveType::NIST_P256)
+                    .ValueOrDie();
+  auto signer = EcdsaSignBoringSsl::New(ec_key, HashType::SHA256,
+                                        EcdsaSignatureEncoding::IEEE_P1363)
+                    .ValueOrDie();
+  auto verifier = EcdsaVerifyBoringSsl::New(ec_key, HashType::SHA256,
+                                            EcdsaSignatureEncoding::IEEE_P1363)
+                      .ValueOrDie();
+  std::string message = "some data to be signed";
+  std::string signature = signer->Sign(message).ValueOrDie();
+
+  EXPECT_THAT(verifier->Verify(signature.substr(1), message),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(verifier->Verify(signature + '\0', message),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  // r = 0 and s = 0.
+  EXPECT_THAT(verifier->Verify(std::string(64, '\0'), message),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  std::string modified = signature;
+  modified[10] ^= 1;
+  EXPECT_THAT(verifier->Verify(modified, message),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 }  // namespace
 }  // namespace subtle
 }  // namespace tink
@@ -16,6 +16,9 @@
 
 #include "tink/subtle/ecdsa_verify_boringssl.h"
 
+#include <memory>
+#include <string>
+
 #include "absl/strings/str_cat.h"
 #include "openssl/bn.h"
 #include "openssl/ec.h"
@@ -23,6 +26,7 @@
 #include "openssl/evp.h"
 #include "openssl/mem.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/digest_output_stream.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/errors.h"
 
@@ -35,11 +39,10 @@ util::StatusOr<std::unique_ptr<EcdsaVerifyBoringSsl>> EcdsaVerifyBoringSsl::New(
     const SubtleUtilBoringSSL::EcKey& ec_key, HashType hash_type,
     EcdsaSignatureEncoding encoding) {
   // Check curve.
-  auto group_result(SubtleUtilBoringSSL::GetEcGroup(ec_key.curve));
+  auto group_result(SubtleUtilBoringSSL::GetSharedEcGroup(ec_key.curve));
   if (!group_result.ok()) return group_result.status();
-  bssl::UniquePtr<EC_GROUP> group(group_result.ValueOrDie());
   bssl::UniquePtr<EC_KEY> key(EC_KEY_new());
-  EC_KEY_set_group(key.get(), group.get());
+  EC_KEY_set_group(key.get(), group_result.ValueOrDie());
 
   // Check key.
   auto ec_point_result =
@@ -87,23 +90,58 @@ util::Status EcdsaVerifyBoringSsl::Verify(absl::string_view signature,
                       nullptr)) {
     return util::Status(util::error::INTERNAL, "Could not compute digest.");
   }
+  return VerifyDigest(
+      signature,
+      absl::string_view(reinterpret_cast<const char*>(digest), digest_size));
+}
 
-  std::string derSig(signature);
-  if (encoding_ == subtle::EcdsaSignatureEncoding::IEEE_P1363) {
-    const EC_GROUP* group = EC_KEY_get0_group(key_.get());
-    auto status_or_der =
-        SubtleUtilBoringSSL::EcSignatureIeeeToDer(group, signature);
+util::StatusOr<std::unique_ptr<OutputStreamWithResult<util::Status>>>
+EcdsaVerifyBoringSsl::NewVerifyOutputStream(
+    absl::string_view signature) const {
+  std::string signature_copy(signature);
+  return DigestOutputStream<util::Status>::New(
+      hash_, [this, signature_copy](absl::string_view digest) {
+        return VerifyDigest(signature_copy, digest);
+      });
+}
 
-    if (!status_or_der.ok()) {
-      return status_or_der.status();
+util::Status EcdsaVerifyBoringSsl::VerifyDigest(
+    absl::string_view signature, absl::string_view digest) const {
+  if (digest.size() != EVP_MD_size(hash_)) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Digest has the wrong size.");
+  }
+
+  const uint8_t* digest_bytes = reinterpret_cast<const uint8_t*>(digest.data());
+  const uint8_t* signature_bytes =
+      reinterpret_cast<const uint8_t*>(signature.data());
+
+  if (encoding_ == subtle::EcdsaSignatureEncoding::IEEE_P1363) {
+    // Reads r and s straight from the signature rather than DER-encoding it
+    // first.
+    if (signature.size() != 2 * field_size_in_bytes_) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Signature is not valid.");
+    }
+    bssl::UniquePtr<ECDSA_SIG> sig(ECDSA_SIG_new());
+    if (sig == nullptr ||
+        BN_bin2bn(signature_bytes, field_size_in_bytes_, sig->r) == nullptr ||
+        BN_bin2bn(signature_bytes + field_size_in_bytes_,
+                  field_size_in_bytes_, sig->s) == nullptr) {
+      return util::Status(util::error::INTERNAL,
+                          "Could not parse the signature.");
+    }
+    if (1 != ECDSA_do_verify(digest_bytes, digest.size(), sig.get(),
+                             key_.get())) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Signature is not valid.");
     }
-    derSig = status_or_der.ValueOrDie();
+    return util::OkStatus();
   }
 
   // Verify the signature.
-  if (1 != ECDSA_verify(0 /* unused */, digest, digest_size,
-                        reinterpret_cast<const uint8_t*>(derSig.data()),
-                        derSig.size(), key_.get())) {
+  if (1 != ECDSA_verify(0 /* unused */, digest_bytes, digest.size(),
+                        signature_bytes, signature.size(), key_.get())) {
     // signature is invalid
     return util::Status(util::error::INVALID_ARGUMENT,
                         "Signature is not valid.");
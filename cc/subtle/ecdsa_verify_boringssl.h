@@ -17,10 +17,12 @@
 #ifndef TINK_SUBTLE_ECDSA_VERIFY_BORINGSSL_H_
 #define TINK_SUBTLE_ECDSA_VERIFY_BORINGSSL_H_
 
+#include <cstddef>
 #include <memory>
 
 #include "absl/strings/string_view.h"
 #include "tink/config/tink_fips.h"
+#include "tink/output_stream_with_result.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/public_key_verify.h"
@@ -33,6 +35,12 @@ namespace tink {
 namespace subtle {
 
 // ECDSA verification using Boring SSL, accepting signatures in DER-encoding.
+//
+// The public key is parsed and checked once in New(); each verification is
+// a single ECDSA_do_verify() (or ECDSA_verify()) on it. BoringSSL offers no
+// way to precompute multiples of the public point across verifications, so
+// the double-scalar multiplication builds its small wNAF table for the
+// public point on every call.
 class EcdsaVerifyBoringSsl : public PublicKeyVerify {
  public:
   static crypto::tink::util::StatusOr<std::unique_ptr<EcdsaVerifyBoringSsl>>
@@ -48,17 +56,33 @@ class EcdsaVerifyBoringSsl : public PublicKeyVerify {
       absl::string_view signature,
       absl::string_view data) const override;
 
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<OutputStreamWithResult<crypto::tink::util::Status>>>
+  NewVerifyOutputStream(absl::string_view signature) const override;
+
+  // Verifies that 'signature' is a digital signature for data whose digest
+  // under the hash function of this verifier is 'digest', for callers which
+  // have hashed the data already.
+  crypto::tink::util::Status VerifyDigest(absl::string_view signature,
+                                          absl::string_view digest) const;
+
   static constexpr crypto::tink::FipsCompatibility kFipsStatus =
       crypto::tink::FipsCompatibility::kRequiresBoringCrypto;
 
  private:
   EcdsaVerifyBoringSsl(bssl::UniquePtr<EC_KEY> key, const EVP_MD* hash,
                        EcdsaSignatureEncoding encoding)
-      : key_(std::move(key)), hash_(hash), encoding_(encoding) {}
+      : key_(std::move(key)),
+        hash_(hash),
+        encoding_(encoding),
+        field_size_in_bytes_(
+            (EC_GROUP_get_degree(EC_KEY_get0_group(key_.get())) + 7) / 8) {}
 
   bssl::UniquePtr<EC_KEY> key_;
   const EVP_MD* hash_;  // Owned by BoringSSL.
   EcdsaSignatureEncoding encoding_;
+  // The size of each of r and s in IEEE_P1363 signatures.
+  size_t field_size_in_bytes_;
 };
 
 }  // namespace subtle
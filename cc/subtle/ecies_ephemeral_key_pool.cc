@@ -0,0 +1,162 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/ecies_ephemeral_key_pool.h"
+
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/curve25519.h"
+#include "openssl/ec.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/fork_hooks.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// static
+util::StatusOr<std::unique_ptr<EciesEphemeralKey>>
+EciesEphemeralKeyPool::GenerateKey(EllipticCurveType curve) {
+  auto key = absl::make_unique<EciesEphemeralKey>();
+  switch (curve) {
+    case EllipticCurveType::NIST_P256:
+    case EllipticCurveType::NIST_P384:
+    case EllipticCurveType::NIST_P521: {
+      auto status_or_ec_group = SubtleUtilBoringSSL::GetSharedEcGroup(curve);
+      if (!status_or_ec_group.ok()) return status_or_ec_group.status();
+      key->ec_key.reset(EC_KEY_new());
+      if (1 != EC_KEY_set_group(key->ec_key.get(),
+                                status_or_ec_group.ValueOrDie())) {
+        return util::Status(util::error::INTERNAL, "EC_KEY_set_group failed");
+      }
+      if (1 != EC_KEY_generate_key(key->ec_key.get())) {
+        return util::Status(util::error::INTERNAL,
+                            "EC_KEY_generate_key failed");
+      }
+      return std::move(key);
+    }
+    case EllipticCurveType::CURVE25519:
+      key->x25519_private_key.resize(X25519_PRIVATE_KEY_LEN);
+      key->x25519_public_value.resize(X25519_PUBLIC_VALUE_LEN);
+      X25519_keypair(
+          reinterpret_cast<uint8_t*>(&key->x25519_public_value[0]),
+          key->x25519_private_key.data());
+      return std::move(key);
+    default:
+      return util::Status(util::error::UNIMPLEMENTED,
+                          "Unsupported elliptic curve");
+  }
+}
+
+// static
+util::StatusOr<std::shared_ptr<EciesEphemeralKeyPool>>
+EciesEphemeralKeyPool::New(EllipticCurveType curve, int capacity) {
+  if (capacity < 1) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "capacity must be positive");
+  }
+  // Fails early for unsupported curves.
+  auto key_result = GenerateKey(curve);
+  if (!key_result.ok()) return key_result.status();
+  std::shared_ptr<EciesEphemeralKeyPool> pool(
+      new EciesEphemeralKeyPool(curve, capacity));
+  {
+    absl::MutexLock lock(&pool->mutex_);
+    pool->keys_.push_back(std::move(key_result.ValueOrDie()));
+  }
+  // Without fork handlers, a child could hand out the keys of its parent.
+  if (util::ForkHandlersInstalled()) {
+    pool->worker_ =
+        std::thread(&EciesEphemeralKeyPool::WorkerLoop, pool.get());
+  }
+  return pool;
+}
+
+EciesEphemeralKeyPool::EciesEphemeralKeyPool(EllipticCurveType curve,
+                                             int capacity)
+    : curve_(curve),
+      capacity_(capacity),
+      fork_generation_(util::ForkGeneration()) {}
+
+EciesEphemeralKeyPool::~EciesEphemeralKeyPool() {
+  if (IsForkedChild()) {
+    // The worker thread only exists in the parent.
+    if (worker_.joinable()) worker_.detach();
+    return;
+  }
+  {
+    absl::MutexLock lock(&mutex_);
+    shutdown_ = true;
+  }
+  if (worker_.joinable()) worker_.join();
+}
+
+util::StatusOr<std::unique_ptr<EciesEphemeralKey>>
+EciesEphemeralKeyPool::Take() {
+  if (IsForkedChild()) return GenerateKey(curve_);
+  {
+    absl::MutexLock lock(&mutex_);
+    if (!keys_.empty()) {
+      std::unique_ptr<EciesEphemeralKey> key = std::move(keys_.front());
+      keys_.pop_front();
+      return std::move(key);
+    }
+  }
+  return GenerateKey(curve_);
+}
+
+int EciesEphemeralKeyPool::size() const {
+  if (IsForkedChild()) return 0;
+  absl::MutexLock lock(&mutex_);
+  return keys_.size();
+}
+
+bool EciesEphemeralKeyPool::IsForkedChild() const {
+  return util::ForkGeneration() != fork_generation_;
+}
+
+bool EciesEphemeralKeyPool::NeedsWork() const {
+  return shutdown_ || keys_.size() < capacity_;
+}
+
+void EciesEphemeralKeyPool::WorkerLoop() {
+  while (true) {
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(this, &EciesEphemeralKeyPool::NeedsWork));
+      if (shutdown_) return;
+    }
+    auto key_result = GenerateKey(curve_);
+    absl::MutexLock lock(&mutex_);
+    if (!key_result.ok()) {
+      // Retrying would most likely fail again; leave the work to Take().
+      shutdown_ = true;
+      return;
+    }
+    keys_.push_back(std::move(key_result.ValueOrDie()));
+  }
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,110 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_ECIES_EPHEMERAL_KEY_POOL_H_
+#define TINK_SUBTLE_ECIES_EPHEMERAL_KEY_POOL_H_
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/base.h"
+#include "openssl/ec.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// An ephemeral key pair of the ECIES sender KEM.  Only the fields of its
+// curve are set.
+struct EciesEphemeralKey {
+  // For the NIST P-curves.
+  bssl::UniquePtr<EC_KEY> ec_key;
+  // For CURVE25519.
+  util::SecretData x25519_private_key;
+  std::string x25519_public_value;
+};
+
+// Keeps a supply of ephemeral key pairs for the ECIES sender KEM, which a
+// background thread generates ahead of time, so that the key generation
+// does not add to the latency of encryption.
+//
+// Every key pair is handed out by Take() at most once, and the pool never
+// keeps a reference to it afterwards.  A pool can be shared by any number of
+// sender KEMs for its curve.
+//
+// A pool is fork-safe: in the child of a fork(), Take() ignores the key
+// pairs inherited from the parent, which its siblings would use as well,
+// and generates each key pair on the calling thread.
+class EciesEphemeralKeyPool {
+ public:
+  // Generates a key pair for 'curve' on the calling thread.
+  static crypto::tink::util::StatusOr<std::unique_ptr<EciesEphemeralKey>>
+  GenerateKey(EllipticCurveType curve);
+
+  // Returns a pool for 'curve' whose worker thread keeps up to 'capacity'
+  // key pairs ready.
+  static crypto::tink::util::StatusOr<std::shared_ptr<EciesEphemeralKeyPool>>
+  New(EllipticCurveType curve, int capacity);
+
+  // Stops the worker thread and destroys the key pairs not taken.
+  ~EciesEphemeralKeyPool();
+
+  EciesEphemeralKeyPool(const EciesEphemeralKeyPool&) = delete;
+  EciesEphemeralKeyPool& operator=(const EciesEphemeralKeyPool&) = delete;
+
+  // Removes a key pair from the pool and returns it, or generates one on the
+  // calling thread if the pool is empty.
+  crypto::tink::util::StatusOr<std::unique_ptr<EciesEphemeralKey>> Take();
+
+  EllipticCurveType curve() const { return curve_; }
+
+  // Returns the number of key pairs ready in the pool, which is 0 in the
+  // child of a fork().
+  int size() const;
+
+ private:
+  EciesEphemeralKeyPool(EllipticCurveType curve, int capacity);
+
+  void WorkerLoop();
+  bool NeedsWork() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  // Whether this process is a child of the one which created the pool; the
+  // worker thread and the state of 'mutex_' were not inherited then.
+  bool IsForkedChild() const;
+
+  const EllipticCurveType curve_;
+  const int capacity_;
+  const uint64_t fork_generation_;
+  mutable absl::Mutex mutex_;
+  std::deque<std::unique_ptr<EciesEphemeralKey>> keys_ ABSL_GUARDED_BY(mutex_);
+  // Set on destruction, or when key generation fails; the worker thread
+  // stops, and Take() generates keys on the calling thread.
+  bool shutdown_ ABSL_GUARDED_BY(mutex_) = false;
+  std::thread worker_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_ECIES_EPHEMERAL_KEY_POOL_H_
@@ -0,0 +1,130 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/ecies_ephemeral_key_pool.h"
+
+#include <set>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "openssl/bn.h"
+#include "openssl/ec.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+
+// Returns a string which identifies the key pair.
+std::string PrivateKey(EllipticCurveType curve, const EciesEphemeralKey& key) {
+  if (curve == EllipticCurveType::CURVE25519) {
+    EXPECT_EQ(key.ec_key, nullptr);
+    return std::string(util::SecretDataAsStringView(key.x25519_private_key));
+  }
+  EXPECT_NE(key.ec_key, nullptr);
+  EXPECT_TRUE(key.x25519_private_key.empty());
+  const BIGNUM* priv = EC_KEY_get0_private_key(key.ec_key.get());
+  std::string bytes(BN_num_bytes(priv), '\0');
+  BN_bn2bin(priv, reinterpret_cast<uint8_t*>(&bytes[0]));
+  return bytes;
+}
+
+// Waits until 'pool' has 'size' keys.
+void WaitForSize(const EciesEphemeralKeyPool& pool, int size) {
+  while (pool.size() < size) absl::SleepFor(absl::Milliseconds(1));
+}
+
+TEST(EciesEphemeralKeyPoolTest, KeysAreFreshAndSingleUse) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  for (EllipticCurveType curve :
+       {EllipticCurveType::NIST_P256, EllipticCurveType::NIST_P384,
+        EllipticCurveType::NIST_P521, EllipticCurveType::CURVE25519}) {
+    SCOPED_TRACE(EnumToString(curve));
+    auto pool_or = EciesEphemeralKeyPool::New(curve, 4);
+    ASSERT_THAT(pool_or.status(), IsOk());
+    auto pool = pool_or.ValueOrDie();
+    EXPECT_EQ(pool->curve(), curve);
+    WaitForSize(*pool, 4);
+    std::set<std::string> keys;
+    // Takes more keys than the capacity, so some are generated on this
+    // thread or after a refill.
+    for (int i = 0; i < 10; i++) {
+      auto key_or = pool->Take();
+      ASSERT_THAT(key_or.status(), IsOk());
+      keys.insert(PrivateKey(curve, *key_or.ValueOrDie()));
+    }
+    EXPECT_EQ(keys.size(), 10);
+    // The worker refills the pool.
+    WaitForSize(*pool, 4);
+    EXPECT_EQ(pool->size(), 4);
+  }
+}
+
+TEST(EciesEphemeralKeyPoolTest, ConcurrentTake) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto pool =
+      EciesEphemeralKeyPool::New(EllipticCurveType::CURVE25519, 8).ValueOrDie();
+  std::vector<std::thread> threads;
+  std::vector<std::set<std::string>> keys(4);
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&pool, &keys, t]() {
+      for (int i = 0; i < 100; i++) {
+        auto key_or = pool->Take();
+        ASSERT_THAT(key_or.status(), IsOk());
+        keys[t].insert(PrivateKey(EllipticCurveType::CURVE25519,
+                                  *key_or.ValueOrDie()));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  std::set<std::string> all_keys;
+  for (const auto& thread_keys : keys) {
+    all_keys.insert(thread_keys.begin(), thread_keys.end());
+  }
+  EXPECT_EQ(all_keys.size(), 400);
+}
+
+TEST(EciesEphemeralKeyPoolTest, InvalidParameters) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  EXPECT_THAT(
+      EciesEphemeralKeyPool::New(EllipticCurveType::NIST_P256, 0).status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(
+      EciesEphemeralKeyPool::New(EllipticCurveType::UNKNOWN_CURVE, 1).status(),
+      StatusIs(util::error::UNIMPLEMENTED));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
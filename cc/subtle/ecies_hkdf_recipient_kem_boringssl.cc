@@ -20,6 +20,7 @@
 #include "openssl/bn.h"
 #include "openssl/curve25519.h"
 #include "openssl/ec.h"
+#include "openssl/ecdh.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/hkdf.h"
 #include "tink/subtle/subtle_util_boringssl.h"
@@ -59,21 +60,30 @@ EciesHkdfNistPCurveRecipientKemBoringSsl::New(EllipticCurveType curve,
   if (priv_key.empty()) {
     return util::Status(util::error::INVALID_ARGUMENT, "empty priv_key");
   }
-  auto status_or_ec_group = SubtleUtilBoringSSL::GetEcGroup(curve);
+  auto status_or_ec_group = SubtleUtilBoringSSL::GetSharedEcGroup(curve);
   if (!status_or_ec_group.ok()) return status_or_ec_group.status();
-  // TODO(przydatek): consider refactoring SubtleUtilBoringSSL,
-  //     so that the saved group can be used for KEM operations.
+  const EC_GROUP* ec_group = status_or_ec_group.ValueOrDie();
+
+  // Parse the private key once, instead of for every GenerateKey() call.
+  bssl::UniquePtr<BIGNUM> priv_key_bn(
+      BN_bin2bn(priv_key.data(), priv_key.size(), nullptr));
+  bssl::UniquePtr<EC_KEY> ec_key(EC_KEY_new());
+  bool key_set = priv_key_bn != nullptr && ec_key != nullptr &&
+                 EC_KEY_set_group(ec_key.get(), ec_group) == 1 &&
+                 EC_KEY_set_private_key(ec_key.get(), priv_key_bn.get()) == 1;
+  BN_clear(priv_key_bn.get());
+  if (!key_set) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid priv_key");
+  }
   return {absl::WrapUnique(new EciesHkdfNistPCurveRecipientKemBoringSsl(
-      curve, std::move(priv_key), status_or_ec_group.ValueOrDie()))};
+      curve, std::move(ec_key), ec_group))};
 }
 
 EciesHkdfNistPCurveRecipientKemBoringSsl::
     EciesHkdfNistPCurveRecipientKemBoringSsl(EllipticCurveType curve,
-                                             util::SecretData priv_key_value,
-                                             EC_GROUP* ec_group)
-    : curve_(curve),
-      priv_key_value_(std::move(priv_key_value)),
-      ec_group_(ec_group) {}
+                                             bssl::UniquePtr<EC_KEY> priv_key,
+                                             const EC_GROUP* ec_group)
+    : curve_(curve), priv_key_(std::move(priv_key)), ec_group_(ec_group) {}
 
 util::StatusOr<util::SecretData>
 EciesHkdfNistPCurveRecipientKemBoringSsl::GenerateKey(
@@ -88,14 +98,16 @@ EciesHkdfNistPCurveRecipientKemBoringSsl::GenerateKey(
   }
   bssl::UniquePtr<EC_POINT> pub_key =
       std::move(status_or_ec_point.ValueOrDie());
-  bssl::UniquePtr<BIGNUM> priv_key(
-      BN_bin2bn(priv_key_value_.data(), priv_key_value_.size(), nullptr));
-  auto shared_secret_or = SubtleUtilBoringSSL::ComputeEcdhSharedSecret(
-      curve_, priv_key.get(), pub_key.get());
-  if (!shared_secret_or.ok()) {
-    return shared_secret_or.status();
+  // EcPointDecode() checked that the point is on the curve. Without a KDF,
+  // ECDH_compute_key() returns the x-coordinate of the shared point, padded
+  // to the field size, as ComputeEcdhSharedSecret() does.
+  util::SecretData shared_secret((EC_GROUP_get_degree(ec_group_) + 7) / 8);
+  if (ECDH_compute_key(shared_secret.data(), shared_secret.size(),
+                       pub_key.get(), priv_key_.get(),
+                       /*kdf=*/nullptr) !=
+      static_cast<int>(shared_secret.size())) {
+    return util::Status(util::error::INTERNAL, "ECDH_compute_key failed");
   }
-  util::SecretData shared_secret = shared_secret_or.ValueOrDie();
   return Hkdf::ComputeEciesHkdfSymmetricKey(
       hash, kem_bytes, shared_secret, hkdf_salt, hkdf_info, key_size_in_bytes);
 }
@@ -18,6 +18,7 @@
 #define TINK_SUBTLE_ECIES_HKDF_RECIPIENT_KEM_BORINGSSL_H_
 
 #include "absl/strings/string_view.h"
+#include "openssl/base.h"
 #include "openssl/curve25519.h"
 #include "openssl/ec.h"
 #include "tink/config/tink_fips.h"
@@ -73,12 +74,15 @@ class EciesHkdfNistPCurveRecipientKemBoringSsl
 
  private:
   EciesHkdfNistPCurveRecipientKemBoringSsl(EllipticCurveType curve,
-                                           util::SecretData priv_key_value,
-                                           EC_GROUP* ec_group);
+                                           bssl::UniquePtr<EC_KEY> priv_key,
+                                           const EC_GROUP* ec_group);
 
   EllipticCurveType curve_;
-  util::SecretData priv_key_value_;
-  bssl::UniquePtr<EC_GROUP> ec_group_;
+  // The private key, parsed once into the scalar form used by BoringSSL's
+  // constant-time point multiplication. BoringSSL clears it when freed.
+  bssl::UniquePtr<EC_KEY> priv_key_;
+  // Shared group from SubtleUtilBoringSSL::GetSharedEcGroup(), not owned.
+  const EC_GROUP* ec_group_;
 };
 
 // Implementation of EciesHkdfRecipientKemBoringSsl for curve25519.
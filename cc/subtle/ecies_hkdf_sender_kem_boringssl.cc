@@ -16,10 +16,15 @@
 
 #include "tink/subtle/ecies_hkdf_sender_kem_boringssl.h"
 
+#include <memory>
+#include <string>
+#include <utility>
+
 #include "absl/memory/memory.h"
 #include "openssl/bn.h"
 #include "openssl/curve25519.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/ecies_ephemeral_key_pool.h"
 #include "tink/subtle/hkdf.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 
@@ -27,18 +32,48 @@ namespace crypto {
 namespace tink {
 namespace subtle {
 
+namespace {
+
+util::Status ValidateKeyPool(EllipticCurveType curve,
+                             const EciesEphemeralKeyPool* key_pool) {
+  if (key_pool != nullptr && key_pool->curve() != curve) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "key_pool is for a different curve");
+  }
+  return util::OkStatus();
+}
+
+// Returns an ephemeral key pair from 'key_pool', or a new one if it is null.
+util::StatusOr<std::unique_ptr<EciesEphemeralKey>> GetEphemeralKey(
+    EllipticCurveType curve, EciesEphemeralKeyPool* key_pool) {
+  if (key_pool != nullptr) return key_pool->Take();
+  return EciesEphemeralKeyPool::GenerateKey(curve);
+}
+
+}  // namespace
+
 // static
 util::StatusOr<std::unique_ptr<const EciesHkdfSenderKemBoringSsl>>
 EciesHkdfSenderKemBoringSsl::New(subtle::EllipticCurveType curve,
                                  const std::string& pubx,
                                  const std::string& puby) {
+  return New(curve, pubx, puby, nullptr);
+}
+
+// static
+util::StatusOr<std::unique_ptr<const EciesHkdfSenderKemBoringSsl>>
+EciesHkdfSenderKemBoringSsl::New(
+    subtle::EllipticCurveType curve, const std::string& pubx,
+    const std::string& puby, std::shared_ptr<EciesEphemeralKeyPool> key_pool) {
   switch (curve) {
     case EllipticCurveType::NIST_P256:
     case EllipticCurveType::NIST_P384:
     case EllipticCurveType::NIST_P521:
-      return EciesHkdfNistPCurveSendKemBoringSsl::New(curve, pubx, puby);
+      return EciesHkdfNistPCurveSendKemBoringSsl::New(curve, pubx, puby,
+                                                      std::move(key_pool));
     case EllipticCurveType::CURVE25519:
-      return EciesHkdfX25519SendKemBoringSsl::New(curve, pubx, puby);
+      return EciesHkdfX25519SendKemBoringSsl::New(curve, pubx, puby,
+                                                  std::move(key_pool));
     default:
       return util::Status(util::error::UNIMPLEMENTED,
                           "Unsupported elliptic curve");
@@ -47,23 +82,39 @@ EciesHkdfSenderKemBoringSsl::New(subtle::EllipticCurveType curve,
 
 EciesHkdfNistPCurveSendKemBoringSsl::EciesHkdfNistPCurveSendKemBoringSsl(
     subtle::EllipticCurveType curve, const std::string& pubx,
-    const std::string& puby, EC_POINT* peer_pub_key)
-    : curve_(curve), pubx_(pubx), puby_(puby), peer_pub_key_(peer_pub_key) {}
+    const std::string& puby, EC_POINT* peer_pub_key,
+    std::shared_ptr<EciesEphemeralKeyPool> key_pool)
+    : curve_(curve),
+      pubx_(pubx),
+      puby_(puby),
+      peer_pub_key_(peer_pub_key),
+      key_pool_(std::move(key_pool)) {}
 
 // static
 util::StatusOr<std::unique_ptr<const EciesHkdfSenderKemBoringSsl>>
 EciesHkdfNistPCurveSendKemBoringSsl::New(subtle::EllipticCurveType curve,
                                          const std::string& pubx,
                                          const std::string& puby) {
+  return New(curve, pubx, puby, nullptr);
+}
+
+// static
+util::StatusOr<std::unique_ptr<const EciesHkdfSenderKemBoringSsl>>
+EciesHkdfNistPCurveSendKemBoringSsl::New(
+    subtle::EllipticCurveType curve, const std::string& pubx,
+    const std::string& puby, std::shared_ptr<EciesEphemeralKeyPool> key_pool) {
   auto status = CheckFipsCompatibility<EciesHkdfNistPCurveSendKemBoringSsl>();
   if (!status.ok()) return status;
+  status = ValidateKeyPool(curve, key_pool.get());
+  if (!status.ok()) return status;
 
   auto status_or_ec_point =
       SubtleUtilBoringSSL::GetEcPoint(curve, pubx, puby);
   if (!status_or_ec_point.ok()) return status_or_ec_point.status();
   std::unique_ptr<const EciesHkdfSenderKemBoringSsl> sender_kem(
-      new EciesHkdfNistPCurveSendKemBoringSsl(curve, pubx, puby,
-                                              status_or_ec_point.ValueOrDie()));
+      new EciesHkdfNistPCurveSendKemBoringSsl(
+          curve, pubx, puby, status_or_ec_point.ValueOrDie(),
+          std::move(key_pool)));
   return std::move(sender_kem);
 }
 
@@ -77,20 +128,11 @@ EciesHkdfNistPCurveSendKemBoringSsl::GenerateKey(
                         "peer_pub_key_ wasn't initialized");
   }
 
-  auto status_or_ec_group = SubtleUtilBoringSSL::GetEcGroup(curve_);
-  if (!status_or_ec_group.ok()) {
-    return status_or_ec_group.status();
-  }
-  bssl::UniquePtr<EC_GROUP> group(status_or_ec_group.ValueOrDie());
-  bssl::UniquePtr<EC_KEY> ephemeral_key(EC_KEY_new());
-  if (1 != EC_KEY_set_group(ephemeral_key.get(), group.get())) {
-    return util::Status(util::error::INTERNAL, "EC_KEY_set_group failed");
-  }
-  if (1 != EC_KEY_generate_key(ephemeral_key.get())) {
-    return util::Status(util::error::INTERNAL, "EC_KEY_generate_key failed");
-  }
-  const BIGNUM* ephemeral_priv = EC_KEY_get0_private_key(ephemeral_key.get());
-  const EC_POINT* ephemeral_pub = EC_KEY_get0_public_key(ephemeral_key.get());
+  auto ephemeral_key_result = GetEphemeralKey(curve_, key_pool_.get());
+  if (!ephemeral_key_result.ok()) return ephemeral_key_result.status();
+  const EC_KEY* ephemeral_key = ephemeral_key_result.ValueOrDie()->ec_key.get();
+  const BIGNUM* ephemeral_priv = EC_KEY_get0_private_key(ephemeral_key);
+  const EC_POINT* ephemeral_pub = EC_KEY_get0_public_key(ephemeral_key);
   auto status_or_string_kem =
       SubtleUtilBoringSSL::EcPointEncode(curve_, point_format, ephemeral_pub);
   if (!status_or_string_kem.ok()) {
@@ -115,7 +157,9 @@ EciesHkdfNistPCurveSendKemBoringSsl::GenerateKey(
 }
 
 EciesHkdfX25519SendKemBoringSsl::EciesHkdfX25519SendKemBoringSsl(
-    const std::string& peer_public_value) {
+    const std::string& peer_public_value,
+    std::shared_ptr<EciesEphemeralKeyPool> key_pool)
+    : key_pool_(std::move(key_pool)) {
   peer_public_value.copy(reinterpret_cast<char*>(peer_public_value_),
                          X25519_PUBLIC_VALUE_LEN);
 }
@@ -125,6 +169,14 @@ util::StatusOr<std::unique_ptr<const EciesHkdfSenderKemBoringSsl>>
 EciesHkdfX25519SendKemBoringSsl::New(subtle::EllipticCurveType curve,
                                      const std::string& pubx,
                                      const std::string& puby) {
+  return New(curve, pubx, puby, nullptr);
+}
+
+// static
+util::StatusOr<std::unique_ptr<const EciesHkdfSenderKemBoringSsl>>
+EciesHkdfX25519SendKemBoringSsl::New(
+    subtle::EllipticCurveType curve, const std::string& pubx,
+    const std::string& puby, std::shared_ptr<EciesEphemeralKeyPool> key_pool) {
   auto status = CheckFipsCompatibility<EciesHkdfX25519SendKemBoringSsl>();
   if (!status.ok()) return status;
 
@@ -139,8 +191,10 @@ EciesHkdfX25519SendKemBoringSsl::New(subtle::EllipticCurveType curve,
   if (!puby.empty()) {
     return util::Status(util::error::INVALID_ARGUMENT, "puby is not empty");
   }
+  status = ValidateKeyPool(curve, key_pool.get());
+  if (!status.ok()) return status;
   std::unique_ptr<const EciesHkdfSenderKemBoringSsl> sender_kem(
-      new EciesHkdfX25519SendKemBoringSsl(pubx));
+      new EciesHkdfX25519SendKemBoringSsl(pubx, std::move(key_pool)));
   return std::move(sender_kem);
 }
 
@@ -155,13 +209,13 @@ EciesHkdfX25519SendKemBoringSsl::GenerateKey(
         "X25519 only supports compressed elliptic curve points");
   }
 
-  util::SecretData ephemeral_private_key(X25519_PRIVATE_KEY_LEN);
-  std::string kem_bytes(X25519_PUBLIC_VALUE_LEN, '\0');
-  X25519_keypair(reinterpret_cast<uint8_t*>(&kem_bytes[0]),
-                 ephemeral_private_key.data());
+  auto ephemeral_key_result = GetEphemeralKey(CURVE25519, key_pool_.get());
+  if (!ephemeral_key_result.ok()) return ephemeral_key_result.status();
+  const EciesEphemeralKey& ephemeral_key = *ephemeral_key_result.ValueOrDie();
+  const std::string& kem_bytes = ephemeral_key.x25519_public_value;
 
   util::SecretData shared_secret(X25519_SHARED_KEY_LEN);
-  X25519(shared_secret.data(), ephemeral_private_key.data(),
+  X25519(shared_secret.data(), ephemeral_key.x25519_private_key.data(),
          peer_public_value_);
 
   auto symmetric_key_or = Hkdf::ComputeEciesHkdfSymmetricKey(
@@ -17,11 +17,15 @@
 #ifndef TINK_SUBTLE_ECIES_HKDF_SENDER_KEM_BORINGSSL_H_
 #define TINK_SUBTLE_ECIES_HKDF_SENDER_KEM_BORINGSSL_H_
 
+#include <memory>
+#include <string>
+
 #include "absl/strings/string_view.h"
 #include "openssl/curve25519.h"
 #include "openssl/ec.h"
 #include "tink/config/tink_fips.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/ecies_ephemeral_key_pool.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/statusor.h"
 
@@ -57,6 +61,15 @@ class EciesHkdfSenderKemBoringSsl {
   New(EllipticCurveType curve, const std::string& pubx,
       const std::string& puby);
 
+  // As above, but the KEM takes its ephemeral key pairs from 'key_pool',
+  // which must be for 'curve', instead of generating them in GenerateKey().
+  // A null 'key_pool' is the same as none.
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<const EciesHkdfSenderKemBoringSsl>>
+  New(EllipticCurveType curve, const std::string& pubx,
+      const std::string& puby,
+      std::shared_ptr<EciesEphemeralKeyPool> key_pool);
+
   // Generates ephemeral key pairs, computes ECDH's shared secret based on
   // generated ephemeral key and recipient's public key, then uses HKDF
   // to derive the symmetric key from the shared secret, 'hkdf_info' and
@@ -79,6 +92,13 @@ class EciesHkdfNistPCurveSendKemBoringSsl : public EciesHkdfSenderKemBoringSsl {
   New(EllipticCurveType curve, const std::string& pubx,
       const std::string& puby);
 
+  // As above, with ephemeral key pairs from 'key_pool' if it is not null.
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<const EciesHkdfSenderKemBoringSsl>>
+  New(EllipticCurveType curve, const std::string& pubx,
+      const std::string& puby,
+      std::shared_ptr<EciesEphemeralKeyPool> key_pool);
+
   // Generates ephemeral key pairs, computes ECDH's shared secret based on
   // generated ephemeral key and recipient's public key, then uses HKDF
   // to derive the symmetric key from the shared secret, 'hkdf_info' and
@@ -91,15 +111,16 @@ class EciesHkdfNistPCurveSendKemBoringSsl : public EciesHkdfSenderKemBoringSsl {
       crypto::tink::FipsCompatibility::kNotFips;
 
  private:
-  EciesHkdfNistPCurveSendKemBoringSsl(EllipticCurveType curve,
-                                      const std::string& pubx,
-                                      const std::string& puby,
-                                      EC_POINT* peer_pub_key);
+  EciesHkdfNistPCurveSendKemBoringSsl(
+      EllipticCurveType curve, const std::string& pubx,
+      const std::string& puby, EC_POINT* peer_pub_key,
+      std::shared_ptr<EciesEphemeralKeyPool> key_pool);
 
   EllipticCurveType curve_;
   std::string pubx_;
   std::string puby_;
   bssl::UniquePtr<EC_POINT> peer_pub_key_;
+  std::shared_ptr<EciesEphemeralKeyPool> key_pool_;  // may be null
 };
 
 // Implementation of EciesHkdfSenderKemBoringSsl for curve25519.
@@ -112,6 +133,13 @@ class EciesHkdfX25519SendKemBoringSsl : public EciesHkdfSenderKemBoringSsl {
   New(EllipticCurveType curve, const std::string& pubx,
       const std::string& puby);
 
+  // As above, with ephemeral key pairs from 'key_pool' if it is not null.
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<const EciesHkdfSenderKemBoringSsl>>
+  New(EllipticCurveType curve, const std::string& pubx,
+      const std::string& puby,
+      std::shared_ptr<EciesEphemeralKeyPool> key_pool);
+
   // Generates ephemeral key pairs, computes ECDH's shared secret based on
   // generated ephemeral key and recipient's public key, then uses HKDF
   // to derive the symmetric key from the shared secret, 'hkdf_info' and
@@ -124,10 +152,12 @@ class EciesHkdfX25519SendKemBoringSsl : public EciesHkdfSenderKemBoringSsl {
       crypto::tink::FipsCompatibility::kNotFips;
 
  private:
-  explicit EciesHkdfX25519SendKemBoringSsl(
-      const std::string& peer_public_value);
+  EciesHkdfX25519SendKemBoringSsl(
+      const std::string& peer_public_value,
+      std::shared_ptr<EciesEphemeralKeyPool> key_pool);
 
   uint8_t peer_public_value_[X25519_PUBLIC_VALUE_LEN];
+  std::shared_ptr<EciesEphemeralKeyPool> key_pool_;  // may be null
 };
 
 }  // namespace subtle
@@ -20,6 +20,7 @@
 
 #include "gtest/gtest.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/ecies_ephemeral_key_pool.h"
 #include "tink/subtle/ecies_hkdf_recipient_kem_boringssl.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/secret_data.h"
@@ -107,6 +108,63 @@ TEST_F(EciesHkdfSenderKemBoringSslTest, TestSenderRecipientBasic) {
   }
 }
 
+TEST_F(EciesHkdfSenderKemBoringSslTest, TestSenderRecipientWithKeyPool) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  for (const TestVector& test : test_vector) {
+    auto test_key = SubtleUtilBoringSSL::GetNewEcKey(test.curve).ValueOrDie();
+    auto key_pool_or = EciesEphemeralKeyPool::New(test.curve, 4);
+    ASSERT_TRUE(key_pool_or.ok()) << key_pool_or.status();
+    auto status_or_sender_kem = EciesHkdfSenderKemBoringSsl::New(
+        test.curve, test_key.pub_x, test_key.pub_y, key_pool_or.ValueOrDie());
+    ASSERT_TRUE(status_or_sender_kem.ok()) << status_or_sender_kem.status();
+    auto sender_kem = std::move(status_or_sender_kem.ValueOrDie());
+    auto ecies_recipient(
+        std::move(EciesHkdfRecipientKemBoringSsl::New(test.curve, test_key.priv)
+                      .ValueOrDie()));
+    std::string previous_kem_bytes;
+    for (int i = 0; i < 10; i++) {
+      auto status_or_kem_key = sender_kem->GenerateKey(
+          test.hash, test::HexDecodeOrDie(test.salt_hex),
+          test::HexDecodeOrDie(test.info_hex), test.out_len,
+          test.point_format);
+      ASSERT_TRUE(status_or_kem_key.ok());
+      auto kem_key = std::move(status_or_kem_key.ValueOrDie());
+      // Every ephemeral key is used only once.
+      EXPECT_NE(kem_key->get_kem_bytes(), previous_kem_bytes);
+      previous_kem_bytes = kem_key->get_kem_bytes();
+      auto status_or_shared_secret = ecies_recipient->GenerateKey(
+          kem_key->get_kem_bytes(), test.hash,
+          test::HexDecodeOrDie(test.salt_hex),
+          test::HexDecodeOrDie(test.info_hex), test.out_len,
+          test.point_format);
+      ASSERT_TRUE(status_or_shared_secret.ok());
+      EXPECT_EQ(test::HexEncode(util::SecretDataAsStringView(
+                    kem_key->get_symmetric_key())),
+                test::HexEncode(util::SecretDataAsStringView(
+                    status_or_shared_secret.ValueOrDie())));
+    }
+  }
+}
+
+TEST_F(EciesHkdfSenderKemBoringSslTest, TestNewKeyPoolForOtherCurve) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto test_key =
+      SubtleUtilBoringSSL::GetNewEcKey(EllipticCurveType::NIST_P256)
+          .ValueOrDie();
+  auto key_pool_or =
+      EciesEphemeralKeyPool::New(EllipticCurveType::NIST_P384, 1);
+  ASSERT_TRUE(key_pool_or.ok()) << key_pool_or.status();
+  EXPECT_THAT(EciesHkdfSenderKemBoringSsl::New(
+                  EllipticCurveType::NIST_P256, test_key.pub_x,
+                  test_key.pub_y, key_pool_or.ValueOrDie())
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 TEST_F(EciesHkdfSenderKemBoringSslTest, TestNewUnknownCurve) {
   if (kUseOnlyFips) {
     GTEST_SKIP() << "Not supported in FIPS-only mode";
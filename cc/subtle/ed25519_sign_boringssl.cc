@@ -16,13 +16,17 @@
 
 #include "tink/subtle/ed25519_sign_boringssl.h"
 
-#include <algorithm>
-#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/curve25519.h"
+#include "tink/internal/thread_pool.h"
 #include "tink/public_key_sign.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/statusor.h"
@@ -34,6 +38,16 @@ namespace subtle {
 // static
 util::StatusOr<std::unique_ptr<PublicKeySign>> Ed25519SignBoringSsl::New(
     util::SecretData private_key) {
+  return New(std::move(private_key), /*parallelism=*/1);
+}
+
+// static
+util::StatusOr<std::unique_ptr<PublicKeySign>> Ed25519SignBoringSsl::New(
+    util::SecretData private_key, int parallelism) {
+  if (parallelism < 1) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "parallelism must be positive");
+  }
   auto status = CheckFipsCompatibility<Ed25519SignBoringSsl>();
   if (!status.ok()) return status;
 
@@ -44,23 +58,57 @@ util::StatusOr<std::unique_ptr<PublicKeySign>> Ed25519SignBoringSsl::New(
                         "The only valid size is %d.",
                         private_key.size(), ED25519_PRIVATE_KEY_LEN));
   }
-  return {absl::WrapUnique(new Ed25519SignBoringSsl(std::move(private_key)))};
+  return {absl::WrapUnique(
+      new Ed25519SignBoringSsl(std::move(private_key), parallelism))};
 }
 
-util::StatusOr<std::string> Ed25519SignBoringSsl::Sign(
-    absl::string_view data) const {
-  data = SubtleUtilBoringSSL::EnsureNonNull(data);
+Ed25519SignBoringSsl::Ed25519SignBoringSsl(util::SecretData private_key,
+                                           int parallelism)
+    : private_key_(std::move(private_key)) {
+  if (parallelism > 1) {
+    thread_pool_ = absl::make_unique<internal::ThreadPool>(parallelism - 1);
+  }
+}
 
-  uint8_t out_sig[ED25519_SIGNATURE_LEN];
-  std::fill(std::begin(out_sig), std::end(out_sig), 0);
+bool Ed25519SignBoringSsl::SignInto(absl::string_view data,
+                                    uint8_t *signature) const {
+  data = SubtleUtilBoringSSL::EnsureNonNull(data);
+  return ED25519_sign(signature,
+                      reinterpret_cast<const uint8_t *>(data.data()),
+                      data.size(), private_key_.data()) == 1;
+}
 
-  if (ED25519_sign(
-          out_sig, reinterpret_cast<const uint8_t *>(data.data()), data.size(),
-          reinterpret_cast<const uint8_t *>(private_key_.data())) != 1) {
+util::StatusOr<std::string> Ed25519SignBoringSsl::Sign(
+    absl::string_view data) const {
+  std::string signature(ED25519_SIGNATURE_LEN, '\0');
+  if (!SignInto(data, reinterpret_cast<uint8_t *>(&signature[0]))) {
     return util::Status(util::error::INTERNAL, "Signing failed.");
   }
+  return signature;
+}
 
-  return std::string(reinterpret_cast<char *>(out_sig), ED25519_SIGNATURE_LEN);
+util::StatusOr<std::vector<std::string>> Ed25519SignBoringSsl::SignBatch(
+    absl::Span<const absl::string_view> data) const {
+  // Ed25519 signing uses nothing but the immutable key, so items are signed
+  // concurrently without any per-operation copies.
+  std::vector<std::string> signatures(data.size(),
+                                      std::string(ED25519_SIGNATURE_LEN, '\0'));
+  std::vector<char> failed(data.size(), 0);
+  auto sign_item = [&](int i) {
+    failed[i] =
+        !SignInto(data[i], reinterpret_cast<uint8_t *>(&signatures[i][0]));
+  };
+  if (thread_pool_ == nullptr) {
+    for (int i = 0; i < data.size(); i++) sign_item(i);
+  } else {
+    thread_pool_->ParallelFor(data.size(), sign_item);
+  }
+  for (char item_failed : failed) {
+    if (item_failed) {
+      return util::Status(util::error::INTERNAL, "Signing failed.");
+    }
+  }
+  return std::move(signatures);
 }
 
 }  // namespace subtle
@@ -17,10 +17,16 @@
 #ifndef TINK_SUBTLE_ED25519_SIGN_BORINGSSL_H_
 #define TINK_SUBTLE_ED25519_SIGN_BORINGSSL_H_
 
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/config/tink_fips.h"
+#include "tink/internal/thread_pool.h"
 #include "tink/public_key_sign.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/statusor.h"
@@ -34,18 +40,31 @@ class Ed25519SignBoringSsl : public PublicKeySign {
   static crypto::tink::util::StatusOr<std::unique_ptr<PublicKeySign>> New(
       util::SecretData private_key);
 
+  // As above, but SignBatch() signs on up to 'parallelism' threads, the
+  // calling one included.
+  static crypto::tink::util::StatusOr<std::unique_ptr<PublicKeySign>> New(
+      util::SecretData private_key, int parallelism);
+
   // Computes the signature for 'data'.
   crypto::tink::util::StatusOr<std::string> Sign(
       absl::string_view data) const override;
 
+  crypto::tink::util::StatusOr<std::vector<std::string>> SignBatch(
+      absl::Span<const absl::string_view> data) const override;
+
   static constexpr crypto::tink::FipsCompatibility kFipsStatus =
       crypto::tink::FipsCompatibility::kNotFips;
 
  private:
-  explicit Ed25519SignBoringSsl(util::SecretData private_key)
-      : private_key_(std::move(private_key)) {}
+  Ed25519SignBoringSsl(util::SecretData private_key, int parallelism);
+
+  // Writes the signature for 'data' to 'signature', which must have room
+  // for ED25519_SIGNATURE_LEN bytes.
+  bool SignInto(absl::string_view data, uint8_t* signature) const;
 
   const util::SecretData private_key_;
+  // Null if 'parallelism' is 1.
+  std::unique_ptr<internal::ThreadPool> thread_pool_;
 };
 
 }  // namespace subtle
@@ -17,6 +17,7 @@
 #include "tink/subtle/ed25519_sign_boringssl.h"
 
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "absl/strings/str_cat.h"
@@ -37,6 +38,7 @@ namespace tink {
 namespace subtle {
 namespace {
 
+using ::crypto::tink::test::IsOk;
 using ::crypto::tink::test::StatusIs;
 
 class Ed25519SignBoringSslTest : public ::testing::Test {};
@@ -340,6 +342,49 @@ TEST_F(Ed25519SignBoringSslTest, testFipsMode) {
               StatusIs(util::error::INTERNAL));
 }
 
+TEST_F(Ed25519SignBoringSslTest, SignBatch) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test assumes kOnlyUseFips is false.";
+  }
+
+  uint8_t out_public_key[ED25519_PUBLIC_KEY_LEN];
+  util::SecretData private_key(ED25519_PRIVATE_KEY_LEN);
+  ED25519_keypair(out_public_key, private_key.data());
+  std::string public_key(reinterpret_cast<const char *>(out_public_key),
+                         ED25519_PUBLIC_KEY_LEN);
+  auto verifier = Ed25519VerifyBoringSsl::New(public_key).ValueOrDie();
+
+  std::vector<std::string> messages;
+  for (int i = 0; i < 50; i++) messages.push_back(absl::StrCat("message ", i));
+  std::vector<absl::string_view> data(messages.begin(), messages.end());
+  for (int parallelism : {1, 4}) {
+    auto signer_result = Ed25519SignBoringSsl::New(private_key, parallelism);
+    ASSERT_THAT(signer_result.status(), IsOk());
+    auto signer = std::move(signer_result.ValueOrDie());
+    auto signatures_result = signer->SignBatch(data);
+    ASSERT_THAT(signatures_result.status(), IsOk());
+    const std::vector<std::string> &signatures = signatures_result.ValueOrDie();
+    ASSERT_EQ(signatures.size(), data.size());
+    for (size_t i = 0; i < data.size(); i++) {
+      // Ed25519 signatures are deterministic.
+      EXPECT_EQ(signatures[i], signer->Sign(data[i]).ValueOrDie());
+      EXPECT_THAT(verifier->Verify(signatures[i], data[i]), IsOk());
+    }
+  }
+}
+
+TEST_F(Ed25519SignBoringSslTest, RejectsInvalidParallelism) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test assumes kOnlyUseFips is false.";
+  }
+
+  util::SecretData private_key(ED25519_PRIVATE_KEY_LEN);
+  uint8_t out_public_key[ED25519_PUBLIC_KEY_LEN];
+  ED25519_keypair(out_public_key, private_key.data());
+  EXPECT_THAT(Ed25519SignBoringSsl::New(private_key, 0).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 }  // namespace
 }  // namespace subtle
 }  // namespace tink
@@ -22,9 +22,11 @@
 
 #include "absl/strings/string_view.h"
 #include "absl/strings/str_cat.h"
+#include "openssl/crypto.h"
 #include "tink/aead.h"
 #include "tink/mac.h"
 #include "tink/subtle/ind_cpa_cipher.h"
+#include "tink/subtle/mac/stateful_mac.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/errors.h"
 #include "tink/util/status.h"
@@ -51,10 +53,42 @@ util::StatusOr<std::unique_ptr<Aead>> EncryptThenAuthenticate::New(
     return util::Status(util::error::INVALID_ARGUMENT, "tag size too small");
   }
   std::unique_ptr<Aead> aead(new EncryptThenAuthenticate(
-      std::move(ind_cpa_cipher), std::move(mac), tag_size));
+      std::move(ind_cpa_cipher), std::move(mac), nullptr, tag_size));
   return std::move(aead);
 }
 
+util::StatusOr<std::unique_ptr<Aead>> EncryptThenAuthenticate::New(
+    std::unique_ptr<IndCpaCipher> ind_cpa_cipher,
+    std::unique_ptr<StatefulMacFactory> mac_factory, uint8_t tag_size) {
+  if (tag_size < kMinTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "tag size too small");
+  }
+  // Surfaces invalid MAC keys here rather than on the first operation.
+  auto mac = mac_factory->Create();
+  if (!mac.ok()) return mac.status();
+  std::unique_ptr<Aead> aead(new EncryptThenAuthenticate(
+      std::move(ind_cpa_cipher), nullptr, std::move(mac_factory), tag_size));
+  return std::move(aead);
+}
+
+util::StatusOr<std::string> EncryptThenAuthenticate::ComputeTag(
+    absl::string_view additional_data, absl::string_view ciphertext,
+    absl::string_view aad_size_in_bits) const {
+  if (mac_factory_ == nullptr) {
+    return mac_->ComputeMac(
+        absl::StrCat(additional_data, ciphertext, aad_size_in_bits));
+  }
+  auto mac_or = mac_factory_->Create();
+  if (!mac_or.ok()) return mac_or.status();
+  StatefulMac& mac = *mac_or.ValueOrDie();
+  for (absl::string_view part :
+       {additional_data, ciphertext, aad_size_in_bits}) {
+    util::Status status = mac.Update(part);
+    if (!status.ok()) return status;
+  }
+  return mac.Finalize();
+}
+
 util::StatusOr<std::string> EncryptThenAuthenticate::Encrypt(
     absl::string_view plaintext, absl::string_view additional_data) const {
   // BoringSSL expects a non-null pointer for plaintext and additional_data,
@@ -73,21 +107,20 @@ util::StatusOr<std::string> EncryptThenAuthenticate::Encrypt(
   if (!ct.ok()) {
     return ct.status();
   }
-  std::string ciphertext(ct.ValueOrDie());
-  std::string toAuthData = absl::StrCat(additional_data, ciphertext,
-                                        longToBigEndianStr(aad_size_in_bits));
-
-  auto tag = mac_->ComputeMac(toAuthData);
+  std::string ciphertext = std::move(ct.ValueOrDie());
+  auto tag = ComputeTag(additional_data, ciphertext,
+                        longToBigEndianStr(aad_size_in_bits));
   if (!tag.ok()) {
     return tag.status();
   }
   if (tag.ValueOrDie().size() != tag_size_) {
     return util::Status(util::error::INTERNAL, "invalid tag size");
   }
-  return ciphertext.append(tag.ValueOrDie());
+  ciphertext.append(tag.ValueOrDie());
+  return std::move(ciphertext);
 }
 
-util::StatusOr<std::string> EncryptThenAuthenticate::Decrypt(
+util::StatusOr<absl::string_view> EncryptThenAuthenticate::Authenticate(
     absl::string_view ciphertext, absl::string_view additional_data) const {
   // BoringSSL expects a non-null pointer for additional_data,
   // regardless of whether the size is 0.
@@ -106,15 +139,37 @@ util::StatusOr<std::string> EncryptThenAuthenticate::Decrypt(
 
   auto payload = ciphertext.substr(0, ciphertext.size() - tag_size_);
   auto tag = ciphertext.substr(ciphertext.size() - tag_size_, tag_size_);
-  std::string toAuthData = absl::StrCat(additional_data, payload,
-                                        longToBigEndianStr(aad_size_in_bits));
+  if (mac_factory_ == nullptr) {
+    std::string toAuthData = absl::StrCat(
+        additional_data, payload, longToBigEndianStr(aad_size_in_bits));
+    auto verified = mac_->VerifyMac(tag, toAuthData);
+    if (!verified.ok()) {
+      return verified;
+    }
+  } else {
+    auto expected_tag = ComputeTag(additional_data, payload,
+                                   longToBigEndianStr(aad_size_in_bits));
+    if (!expected_tag.ok()) {
+      return expected_tag.status();
+    }
+    if (expected_tag.ValueOrDie().size() != tag_size_ ||
+        CRYPTO_memcmp(expected_tag.ValueOrDie().data(), tag.data(),
+                      tag_size_) != 0) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "verification failed");
+    }
+  }
+  return payload;
+}
 
-  auto verified = mac_->VerifyMac(tag, toAuthData);
-  if (!verified.ok()) {
-    return verified;
+util::StatusOr<std::string> EncryptThenAuthenticate::Decrypt(
+    absl::string_view ciphertext, absl::string_view additional_data) const {
+  auto payload = Authenticate(ciphertext, additional_data);
+  if (!payload.ok()) {
+    return payload.status();
   }
 
-  auto pt = ind_cpa_cipher_->Decrypt(payload);
+  auto pt = ind_cpa_cipher_->Decrypt(payload.ValueOrDie());
   if (!pt.ok()) {
     return pt.status();
   }
@@ -122,6 +177,11 @@ util::StatusOr<std::string> EncryptThenAuthenticate::Decrypt(
   return pt.ValueOrDie();
 }
 
+util::Status EncryptThenAuthenticate::VerifyCiphertext(
+    absl::string_view ciphertext, absl::string_view additional_data) const {
+  return Authenticate(ciphertext, additional_data).status();
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -23,6 +23,7 @@
 #include "tink/aead.h"
 #include "tink/mac.h"
 #include "tink/subtle/ind_cpa_cipher.h"
+#include "tink/subtle/mac/stateful_mac.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
@@ -40,6 +41,13 @@ class EncryptThenAuthenticate : public Aead {
       std::unique_ptr<IndCpaCipher> ind_cpa_cipher, std::unique_ptr<Mac> mac,
       uint8_t tag_size);
 
+  // Same as above, but feeds the additional data, the ind-cpa ciphertext and
+  // the length into a StatefulMac one after the other, instead of copying
+  // them into one buffer for Mac::ComputeMac.  Ciphertexts are identical.
+  static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
+      std::unique_ptr<IndCpaCipher> ind_cpa_cipher,
+      std::unique_ptr<StatefulMacFactory> mac_factory, uint8_t tag_size);
+
   // Encrypts 'plaintext' with 'additional_data' as additional authenticated
   // data. The resulting ciphertext allows for checking authenticity and
   // integrity of additional data ({@code aad}), but does not guarantee its
@@ -57,17 +65,37 @@ class EncryptThenAuthenticate : public Aead {
       absl::string_view ciphertext,
       absl::string_view additional_data) const override;
 
+  // Only checks the MAC, without decrypting.
+  crypto::tink::util::Status VerifyCiphertext(
+      absl::string_view ciphertext,
+      absl::string_view additional_data) const override;
+
  private:
   static constexpr int kMinTagSizeInBytes = 10;
 
   EncryptThenAuthenticate(std::unique_ptr<IndCpaCipher> ind_cpa_cipher,
-                          std::unique_ptr<Mac> mac, uint8_t tag_size)
+                          std::unique_ptr<Mac> mac,
+                          std::unique_ptr<StatefulMacFactory> mac_factory,
+                          uint8_t tag_size)
       : ind_cpa_cipher_(std::move(ind_cpa_cipher)),
         mac_(std::move(mac)),
+        mac_factory_(std::move(mac_factory)),
         tag_size_(tag_size) {}
 
+  // Checks the tag at the end of 'ciphertext', and returns the ind-cpa
+  // ciphertext before it.
+  crypto::tink::util::StatusOr<absl::string_view> Authenticate(
+      absl::string_view ciphertext, absl::string_view additional_data) const;
+
+  // Computes the tag over (additional_data || ciphertext || aad_size_in_bits).
+  crypto::tink::util::StatusOr<std::string> ComputeTag(
+      absl::string_view additional_data, absl::string_view ciphertext,
+      absl::string_view aad_size_in_bits) const;
+
   const std::unique_ptr<IndCpaCipher> ind_cpa_cipher_;
+  // Exactly one of mac_ and mac_factory_ is set.
   const std::unique_ptr<Mac> mac_;
+  const std::unique_ptr<StatefulMacFactory> mac_factory_;
   const uint8_t tag_size_;
 };
 
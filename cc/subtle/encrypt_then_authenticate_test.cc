@@ -20,11 +20,13 @@
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
 #include "tink/subtle/aes_ctr_boringssl.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/hmac_boringssl.h"
 #include "tink/subtle/random.h"
+#include "tink/subtle/stateful_hmac_boringssl.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -109,6 +111,21 @@ util::StatusOr<std::unique_ptr<Aead>> createAead2(
   return std::move(cipher_res.ValueOrDie());
 }
 
+util::StatusOr<std::unique_ptr<Aead>> createStatefulMacAead(
+    util::SecretData encryption_key, int iv_size, util::SecretData mac_key,
+    uint8_t tag_size, HashType hash_type) {
+  auto ind_cipher_res =
+      AesCtrBoringSsl::New(std::move(encryption_key), iv_size);
+  if (!ind_cipher_res.ok()) {
+    return ind_cipher_res.status();
+  }
+  return EncryptThenAuthenticate::New(
+      std::move(ind_cipher_res.ValueOrDie()),
+      absl::make_unique<StatefulHmacBoringSslFactory>(hash_type, tag_size,
+                                                      mac_key),
+      tag_size);
+}
+
 util::StatusOr<std::unique_ptr<Aead>> createAead(int encryption_key_size,
                                                  int iv_size, int mac_key_size,
                                                  int tag_size,
@@ -137,6 +154,55 @@ TEST(AesGcmBoringSslTest, testRfcVectors) {
   }
 }
 
+TEST(EncryptThenAuthenticateTest, testRfcVectorsStatefulMac) {
+  for (const TestVector& test : test_vectors) {
+    util::SecretData mac_key =
+        util::SecretDataFromStringView(test::HexDecodeOrDie(test.mac_key));
+    util::SecretData enc_key =
+        util::SecretDataFromStringView(test::HexDecodeOrDie(test.enc_key));
+    std::string ct = test::HexDecodeOrDie(test.ciphertext);
+    std::string aad = test::HexDecodeOrDie(test.aad);
+    auto res = createStatefulMacAead(std::move(enc_key), test.iv_size,
+                                     std::move(mac_key), test.tag_size,
+                                     test.hash_type);
+    ASSERT_TRUE(res.ok()) << res.status();
+    auto cipher = std::move(res.ValueOrDie());
+    auto pt = cipher->Decrypt(ct, aad);
+    EXPECT_TRUE(pt.ok()) << pt.status();
+    ct[ct.size() - 1] ^= 1;
+    EXPECT_FALSE(cipher->Decrypt(ct, aad).ok());
+  }
+}
+
+TEST(EncryptThenAuthenticateTest, testStatefulMacMatchesMac) {
+  util::SecretData enc_key = Random::GetRandomKeyBytes(16);
+  util::SecretData mac_key = Random::GetRandomKeyBytes(32);
+  int iv_size = 16;
+  int tag_size = 32;
+  auto mac_res =
+      createAead2(enc_key, iv_size, mac_key, tag_size, HashType::SHA256);
+  auto stateful_res = createStatefulMacAead(enc_key, iv_size, mac_key,
+                                            tag_size, HashType::SHA256);
+  ASSERT_TRUE(mac_res.ok()) << mac_res.status();
+  ASSERT_TRUE(stateful_res.ok()) << stateful_res.status();
+  const Aead& mac_aead = *mac_res.ValueOrDie();
+  const Aead& stateful_aead = *stateful_res.ValueOrDie();
+  for (int i = 0; i < 64; i++) {
+    std::string message = Random::GetRandomBytes(i * 17);
+    std::string aad = Random::GetRandomBytes(i);
+    auto ct = stateful_aead.Encrypt(message, aad);
+    ASSERT_TRUE(ct.ok()) << ct.status();
+    auto pt = mac_aead.Decrypt(ct.ValueOrDie(), aad);
+    ASSERT_TRUE(pt.ok()) << pt.status();
+    EXPECT_EQ(pt.ValueOrDie(), message);
+    ct = mac_aead.Encrypt(message, aad);
+    ASSERT_TRUE(ct.ok()) << ct.status();
+    pt = stateful_aead.Decrypt(ct.ValueOrDie(), aad);
+    ASSERT_TRUE(pt.ok()) << pt.status();
+    EXPECT_EQ(pt.ValueOrDie(), message);
+  }
+}
+
 TEST(EncryptThenAuthenticateTest, testEncryptDecrypt) {
   int encryption_key_size = 16;
   int iv_size = 12;
@@ -242,6 +308,26 @@ TEST(EncryptThenAuthenticateTest, testDecrypt_modifiedCiphertext) {
   }
 }
 
+TEST(EncryptThenAuthenticateTest, testVerifyCiphertext) {
+  auto res = createAead(/*encryption_key_size=*/16, /*iv_size=*/12,
+                        /*mac_key_size=*/16, /*tag_size=*/16, HashType::SHA1);
+  ASSERT_TRUE(res.ok()) << res.status();
+  auto cipher = std::move(res.ValueOrDie());
+
+  std::string aad = "Some data to authenticate.";
+  std::string ct = cipher->Encrypt("Some data to encrypt.", aad).ValueOrDie();
+  EXPECT_TRUE(cipher->VerifyCiphertext(ct, aad).ok());
+  EXPECT_FALSE(cipher->VerifyCiphertext(ct, "other aad").ok());
+  for (size_t i = 0; i < ct.size() * 8; i++) {
+    std::string modified_ct = ct;
+    modified_ct[i / 8] ^= 1 << (i % 8);
+    EXPECT_FALSE(cipher->VerifyCiphertext(modified_ct, aad).ok()) << i;
+  }
+  for (size_t i = 0; i < ct.size(); i++) {
+    EXPECT_FALSE(cipher->VerifyCiphertext(ct.substr(0, i), aad).ok()) << i;
+  }
+}
+
 TEST(EncryptThenAuthenticateTest, testParamsEmptyVersusNullStringView) {
   int encryption_key_size = 16;
   int iv_size = 12;
@@ -0,0 +1,261 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/flushable_decrypting_random_access_stream.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "tink/random_access_stream.h"
+#include "tink/subtle/flushable_segment_format.h"
+#include "tink/subtle/stream_segment_decrypter.h"
+#include "tink/util/buffer.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+using crypto::tink::util::Buffer;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace format = flushable_segment_format;
+
+// static
+StatusOr<std::unique_ptr<RandomAccessStream>>
+FlushableDecryptingRandomAccessStream::New(
+    std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+    std::unique_ptr<RandomAccessStream> ciphertext_source) {
+  if (segment_decrypter == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "segment_decrypter must be non-null");
+  }
+  if (ciphertext_source == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "cipertext_source must be non-null");
+  }
+  return {absl::WrapUnique(new FlushableDecryptingRandomAccessStream(
+      std::move(segment_decrypter), std::move(ciphertext_source)))};
+}
+
+Status FlushableDecryptingRandomAccessStream::ReadCiphertext(
+    int64_t position, int count, uint8_t* buffer) {
+  int read = 0;
+  while (read < count) {
+    auto buf_result = Buffer::NewNonOwning(
+        reinterpret_cast<char*>(buffer + read), count - read);
+    if (!buf_result.ok()) return buf_result.status();
+    Status status =
+        ct_source_->PRead(position + read, count - read,
+                          buf_result.ValueOrDie().get());
+    read += buf_result.ValueOrDie()->size();
+    if (status.error_code() == util::error::OUT_OF_RANGE && read < count) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    "ciphertext stream is truncated");
+    }
+    if (!status.ok() && status.error_code() != util::error::OUT_OF_RANGE) {
+      return status;
+    }
+  }
+  return Status::OK;
+}
+
+Status FlushableDecryptingRandomAccessStream::EnsureInitialized() {
+  if (status_.error_code() != util::error::UNAVAILABLE) return status_;
+  int ct_offset = segment_decrypter_->get_ciphertext_offset();
+  std::vector<uint8_t> header(segment_decrypter_->get_header_size());
+  Status status = ReadCiphertext(ct_offset, header.size(), header.data());
+  // A transient error of the source is retried by the next call.
+  if (!status.ok() && status.error_code() != util::error::INVALID_ARGUMENT) {
+    return status;
+  }
+  if (status.ok()) status = segment_decrypter_->Init(header);
+  status_ = status;
+  next_frame_position_ = ct_offset + header.size();
+  return status_;
+}
+
+Status FlushableDecryptingRandomAccessStream::IndexUpTo(int64_t pt_position) {
+  Status status = EnsureInitialized();
+  if (!status.ok()) return status;
+  while (index_.empty() || (!index_.back().is_last &&
+                            index_.back().pt_offset + index_.back().ct_size -
+                                    segment_overhead() <=
+                                pt_position)) {
+    uint8_t frame[1 + format::kLengthSize];
+    status = ReadCiphertext(next_frame_position_, 1, frame);
+    if (!status.ok()) return status;
+    uint8_t kind = frame[0];
+    int64_t segment_nr = index_.size();
+    int64_t ct_size = format::FullSegmentSize(
+        segment_nr, segment_decrypter_->get_ciphertext_segment_size(),
+        segment_decrypter_->get_header_size(),
+        segment_decrypter_->get_ciphertext_offset());
+    int64_t full_size = ct_size;
+    if (kind == format::kFlushedSegment || kind == format::kLastSegment) {
+      status = ReadCiphertext(next_frame_position_ + 1, format::kLengthSize,
+                              frame + 1);
+      if (!status.ok()) return status;
+      ct_size = format::LoadLength(frame + 1);
+    } else if (kind != format::kFullSegment) {
+      return Status(util::error::INVALID_ARGUMENT, "invalid segment kind");
+    }
+    if (ct_size < segment_overhead() || ct_size > full_size) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    "invalid ciphertext segment size");
+    }
+    Segment segment;
+    segment.ct_position = next_frame_position_ + format::FrameSize(kind);
+    segment.pt_offset =
+        index_.empty() ? 0
+                       : index_.back().pt_offset + index_.back().ct_size -
+                             segment_overhead();
+    segment.ct_size = ct_size;
+    segment.is_last = kind == format::kLastSegment;
+    index_.push_back(segment);
+    next_frame_position_ = segment.ct_position + ct_size;
+  }
+  return Status::OK;
+}
+
+Status FlushableDecryptingRandomAccessStream::DecryptSegment(
+    const Segment& segment, int64_t segment_nr, std::vector<uint8_t>* buffer) {
+  buffer->resize(segment.ct_size);
+  Status status =
+      ReadCiphertext(segment.ct_position, segment.ct_size, buffer->data());
+  if (!status.ok()) return status;
+  if (segment.is_last) {
+    // No ciphertext may follow the last segment.
+    uint8_t extra;
+    auto buf_result =
+        Buffer::NewNonOwning(reinterpret_cast<char*>(&extra), 1);
+    if (!buf_result.ok()) return buf_result.status();
+    status = ct_source_->PRead(segment.ct_position + segment.ct_size, 1,
+                               buf_result.ValueOrDie().get());
+    if (status.ok() || buf_result.ValueOrDie()->size() > 0) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    "ciphertext stream continues after the last segment");
+    }
+    if (status.error_code() != util::error::OUT_OF_RANGE) return status;
+  }
+  return segment_decrypter_->DecryptSegmentInto(
+      absl::MakeConstSpan(*buffer), segment_nr, segment.is_last,
+      absl::MakeSpan(buffer->data(), segment.ct_size - segment_overhead()));
+}
+
+Status FlushableDecryptingRandomAccessStream::PRead(int64_t position,
+                                                    int count,
+                                                    Buffer* dest_buffer) {
+  if (dest_buffer == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "dest_buffer must be non-null");
+  }
+  auto status = dest_buffer->set_size(0);
+  if (!status.ok()) return status;
+  if (count < 0) {
+    return Status(util::error::INVALID_ARGUMENT, "count cannot be negative");
+  }
+  if (count > dest_buffer->allocated_size()) {
+    return Status(util::error::INVALID_ARGUMENT, "buffer too small");
+  }
+  if (position < 0) {
+    return Status(util::error::INVALID_ARGUMENT, "position cannot be negative");
+  }
+
+  if (count == 0) return Status::OK;
+
+  // The segments are looked up under the lock, and decrypted outside of it.
+  std::vector<Segment> segments;
+  int64_t segment_nr;
+  {
+    absl::MutexLock lock(&mutex_);
+    status = IndexUpTo(position + count - 1);
+    if (!status.ok()) return status;
+    // The last segment that starts at or before 'position'.
+    auto it = std::upper_bound(
+        index_.begin(), index_.end(), position,
+        [](int64_t pos, const Segment& segment) {
+          return pos < segment.pt_offset;
+        }) - 1;
+    segment_nr = it - index_.begin();
+    do {
+      segments.push_back(*it++);
+    } while (it != index_.end() && it->pt_offset < position + count);
+  }
+
+  std::vector<uint8_t> buffer;
+  for (const Segment& segment : segments) {
+    int pt_size = segment.ct_size - segment_overhead();
+    int64_t start = std::max<int64_t>(position - segment.pt_offset, 0);
+    // Skips empty segments, and 'position' at or past the end.
+    if (start >= pt_size) {
+      segment_nr++;
+      continue;
+    }
+    status = DecryptSegment(segment, segment_nr++, &buffer);
+    if (!status.ok()) return status;
+    int copied = std::min<int64_t>(pt_size - start,
+                                   count - dest_buffer->size());
+    std::memcpy(dest_buffer->get_mem_block() + dest_buffer->size(),
+                buffer.data() + start, copied);
+    status = dest_buffer->set_size(dest_buffer->size() + copied);
+    if (!status.ok()) return status;
+  }
+  // IndexUpTo() stops short of 'count' bytes only at the last segment,
+  // which is authenticated before the end of the stream is reported.
+  if (dest_buffer->size() < count) {
+    absl::MutexLock lock(&mutex_);
+    status = VerifyLastSegment();
+    if (!status.ok()) return status;
+    return Status(util::error::OUT_OF_RANGE, "EOF");
+  }
+  return Status::OK;
+}
+
+Status FlushableDecryptingRandomAccessStream::VerifyLastSegment() {
+  if (last_segment_verified_) return Status::OK;
+  // As the sizes of all segments add up to the position of the last one,
+  // its authentication also authenticates the plaintext size.
+  std::vector<uint8_t> buffer;
+  Status status = DecryptSegment(index_.back(), index_.size() - 1, &buffer);
+  if (!status.ok()) return status;
+  last_segment_verified_ = true;
+  return Status::OK;
+}
+
+StatusOr<int64_t> FlushableDecryptingRandomAccessStream::size() {
+  absl::MutexLock lock(&mutex_);
+  Status status = IndexUpTo(std::numeric_limits<int64_t>::max());
+  if (!status.ok()) return status;
+  status = VerifyLastSegment();
+  if (!status.ok()) return status;
+  const Segment& last = index_.back();
+  return last.pt_offset + last.ct_size - segment_overhead();
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,127 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_FLUSHABLE_DECRYPTING_RANDOM_ACCESS_STREAM_H_
+#define TINK_SUBTLE_FLUSHABLE_DECRYPTING_RANDOM_ACCESS_STREAM_H_
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/random_access_stream.h"
+#include "tink/subtle/stream_segment_decrypter.h"
+#include "tink/util/buffer.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// A RandomAccessStream that decrypts a ciphertext in the flushable format
+// (see flushable_segment_format.h).  As its segments have variable sizes,
+// the positions of the segments are not computed from the ciphertext size
+// like in DecryptingRandomAccessStream, but kept in an index, which is
+// built by reading the frames of the segments as far as a PRead() needs.
+// The index takes 24 bytes per segment.  The ciphertext source may grow
+// while the stream is in use (e.g. a file that is still being written and
+// flushed): a PRead() past the indexed segments extends the index.
+//
+// Instances of this class are thread safe; the segments are decrypted
+// outside of the lock of the index.
+class FlushableDecryptingRandomAccessStream
+    : public crypto::tink::RandomAccessStream {
+ public:
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<crypto::tink::RandomAccessStream>>
+  New(std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source);
+
+  ~FlushableDecryptingRandomAccessStream() override {}
+
+  // -----------------------
+  // Methods of RandomAccessStream-interface implemented by this class.
+  crypto::tink::util::Status PRead(
+      int64_t position, int count,
+      crypto::tink::util::Buffer* dest_buffer) override;
+  // Indexes all segments, and authenticates the last one, so that the
+  // returned size is that of the authentic plaintext.  Likewise, PRead()
+  // authenticates the last segment before it returns OUT_OF_RANGE.
+  crypto::tink::util::StatusOr<int64_t> size() override;
+
+ private:
+  struct Segment {
+    int64_t ct_position;  // position of the ciphertext, after the frame
+    int64_t pt_offset;    // position of the plaintext
+    int32_t ct_size;
+    bool is_last;
+  };
+
+  FlushableDecryptingRandomAccessStream(
+      std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source)
+      : segment_decrypter_(std::move(segment_decrypter)),
+        ct_source_(std::move(ciphertext_source)) {}
+
+  int segment_overhead() const {
+    return segment_decrypter_->get_ciphertext_segment_size() -
+           segment_decrypter_->get_plaintext_segment_size();
+  }
+
+  // Reads exactly 'count' bytes at 'position' of ct_source_ into 'buffer'.
+  crypto::tink::util::Status ReadCiphertext(int64_t position, int count,
+                                            uint8_t* buffer);
+
+  // Reads the header and initializes segment_decrypter_, once.
+  crypto::tink::util::Status EnsureInitialized()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Extends index_ until it covers the plaintext byte 'pt_position', or
+  // has the last segment.
+  crypto::tink::util::Status IndexUpTo(int64_t pt_position)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Reads and decrypts 'segment', number 'segment_nr', in place.
+  crypto::tink::util::Status DecryptSegment(const Segment& segment,
+                                            int64_t segment_nr,
+                                            std::vector<uint8_t>* buffer);
+
+  // Authenticates the last segment of the complete index_, once.
+  crypto::tink::util::Status VerifyLastSegment()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  std::unique_ptr<StreamSegmentDecrypter> segment_decrypter_;
+  std::unique_ptr<crypto::tink::RandomAccessStream> ct_source_;
+
+  absl::Mutex mutex_;
+  // UNAVAILABLE until the header has been read, and the permanent error if
+  // it was invalid.
+  crypto::tink::util::Status status_ ABSL_GUARDED_BY(mutex_) =
+      crypto::tink::util::Status(crypto::tink::util::error::UNAVAILABLE,
+                                 "not initialized");
+  std::vector<Segment> index_ ABSL_GUARDED_BY(mutex_);
+  int64_t next_frame_position_ ABSL_GUARDED_BY(mutex_) = 0;
+  bool last_segment_verified_ ABSL_GUARDED_BY(mutex_) = false;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_FLUSHABLE_DECRYPTING_RANDOM_ACCESS_STREAM_H_
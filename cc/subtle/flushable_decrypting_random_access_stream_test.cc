@@ -0,0 +1,237 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/flushable_decrypting_random_access_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/output_stream.h"
+#include "tink/random_access_stream.h"
+#include "tink/subtle/flushable_segment_format.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/buffer.h"
+#include "tink/util/ostream_output_stream.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+using crypto::tink::subtle::test::DummyStreamingAead;
+using crypto::tink::util::Buffer;
+using crypto::tink::util::OstreamOutputStream;
+
+namespace {
+
+// A RandomAccessStream over a string, which may grow while it is read.
+class StringRandomAccessStream : public RandomAccessStream {
+ public:
+  explicit StringRandomAccessStream(const std::string* contents)
+      : contents_(contents) {}
+  util::Status PRead(int64_t position, int count,
+                     Buffer* dest_buffer) override {
+    int64_t size = contents_->size();
+    int copied = std::max<int64_t>(0, std::min<int64_t>(count,
+                                                         size - position));
+    std::memcpy(dest_buffer->get_mem_block(), contents_->data() + position,
+                copied);
+    dest_buffer->set_size(copied).IgnoreError();
+    if (copied < count) {
+      return util::Status(util::error::OUT_OF_RANGE, "EOF");
+    }
+    return util::Status::OK;
+  }
+  util::StatusOr<int64_t> size() override { return contents_->size(); }
+
+ private:
+  const std::string* contents_;
+};
+
+constexpr int kPtSegmentSize = 100;
+constexpr int kHeaderSize = 10;
+
+// Encrypts 'pt' with a flushable stream of 'saead' into 'ct', flushing
+// after each 'flush_interval' bytes.
+void Encrypt(DummyStreamingAead* saead, absl::string_view pt,
+             int flush_interval, std::string* ct) {
+  auto ct_stream = absl::make_unique<std::stringstream>();
+  std::stringbuf* ct_buf = ct_stream->rdbuf();
+  auto enc_stream = std::move(
+      saead->NewFlushableEncryptingStream(
+               absl::make_unique<OstreamOutputStream>(std::move(ct_stream)),
+               "aad")
+          .ValueOrDie());
+  while (!pt.empty()) {
+    int chunk = std::min<int>(flush_interval, pt.size());
+    EXPECT_TRUE(test::WriteToStream(enc_stream.get(), pt.substr(0, chunk),
+                                    /* close_stream = */ false).ok());
+    EXPECT_TRUE(enc_stream->Flush().ok());
+    pt.remove_prefix(chunk);
+  }
+  EXPECT_TRUE(enc_stream->Close().ok());
+  *ct = ct_buf->str();
+}
+
+std::unique_ptr<RandomAccessStream> GetDecryptingStream(
+    DummyStreamingAead* saead, const std::string* ct) {
+  return std::move(saead->NewFlushableDecryptingRandomAccessStream(
+                            absl::make_unique<StringRandomAccessStream>(ct),
+                            "aad")
+                       .ValueOrDie());
+}
+
+TEST(FlushableDecryptingRandomAccessStreamTest, PReads) {
+  for (int pt_size : {0, 1, 50, 89, 90, 91, 500}) {
+    for (int flush_interval : {1, 13, 90, 1000}) {
+      SCOPED_TRACE(absl::StrCat("pt_size = ", pt_size,
+                                ", flush_interval = ", flush_interval));
+      DummyStreamingAead saead(kPtSegmentSize, kHeaderSize,
+                               /* ct_offset = */ 0);
+      std::string pt = Random::GetRandomBytes(pt_size);
+      std::string ct;
+      Encrypt(&saead, pt, flush_interval, &ct);
+      auto dec_stream = GetDecryptingStream(&saead, &ct);
+      auto buffer = std::move(Buffer::New(pt_size + 10).ValueOrDie());
+      for (int position = 0; position <= pt_size; position += 7) {
+        for (int count : {1, 10, 150}) {
+          if (count > pt_size + 10) continue;
+          int expected = std::min(count, pt_size - position);
+          auto status = dec_stream->PRead(position, count, buffer.get());
+          if (expected < count) {
+            EXPECT_EQ(util::error::OUT_OF_RANGE, status.error_code());
+          } else {
+            EXPECT_TRUE(status.ok()) << status;
+          }
+          EXPECT_EQ(pt.substr(position, expected),
+                    std::string(buffer->get_mem_block(), buffer->size()));
+        }
+      }
+      auto size_result = dec_stream->size();
+      ASSERT_TRUE(size_result.ok()) << size_result.status();
+      EXPECT_EQ(pt_size, size_result.ValueOrDie());
+    }
+  }
+}
+
+TEST(FlushableDecryptingRandomAccessStreamTest, GrowingCiphertext) {
+  DummyStreamingAead saead(kPtSegmentSize, kHeaderSize, /* ct_offset = */ 0);
+  std::string pt = Random::GetRandomBytes(300);
+  std::string full_ct;
+  Encrypt(&saead, pt, /* flush_interval = */ 40, &full_ct);
+  // The ciphertext as it is while the plaintext is written: the segments
+  // flushed so far.
+  int flushed_segment_size = 1 + flushable_segment_format::kLengthSize + 40 +
+                             test::DummyStreamSegmentEncrypter::kSegmentTagSize;
+  std::string ct = full_ct.substr(0, kHeaderSize + 2 * flushed_segment_size);
+  auto dec_stream = GetDecryptingStream(&saead, &ct);
+  auto buffer = std::move(Buffer::New(100).ValueOrDie());
+  auto status = dec_stream->PRead(10, 60, buffer.get());
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(pt.substr(10, 60),
+            std::string(buffer->get_mem_block(), buffer->size()));
+  // Neither the rest nor the size are known yet.
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            dec_stream->PRead(70, 20, buffer.get()).error_code());
+  EXPECT_FALSE(dec_stream->size().ok());
+
+  // Once more segments are flushed, they are indexed too.
+  ct = full_ct;
+  status = dec_stream->PRead(70, 100, buffer.get());
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(pt.substr(70, 100),
+            std::string(buffer->get_mem_block(), buffer->size()));
+  auto size_result = dec_stream->size();
+  ASSERT_TRUE(size_result.ok()) << size_result.status();
+  EXPECT_EQ(300, size_result.ValueOrDie());
+}
+
+TEST(FlushableDecryptingRandomAccessStreamTest, ModifiedCiphertext) {
+  DummyStreamingAead saead(kPtSegmentSize, kHeaderSize, /* ct_offset = */ 0);
+  std::string pt = Random::GetRandomBytes(200);
+  std::string ct;
+  Encrypt(&saead, pt, /* flush_interval = */ 50, &ct);
+  auto buffer = std::move(Buffer::New(200).ValueOrDie());
+  {
+    // A truncated ciphertext has no size, and no end: only the plaintext
+    // of the segments before the truncation can be read.
+    std::string modified = ct.substr(0, ct.size() - 1);
+    auto dec_stream = GetDecryptingStream(&saead, &modified);
+    EXPECT_FALSE(dec_stream->size().ok());
+    EXPECT_TRUE(dec_stream->PRead(0, 200, buffer.get()).ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT,
+              dec_stream->PRead(150, 60, buffer.get()).error_code());
+  }
+  {
+    // Nor has a ciphertext that continues after the last segment.
+    std::string modified = ct + "x";
+    auto dec_stream = GetDecryptingStream(&saead, &modified);
+    EXPECT_FALSE(dec_stream->size().ok());
+  }
+  {
+    // Moving the boundary between two segments.
+    std::string modified = ct;
+    modified[kHeaderSize + flushable_segment_format::kLengthSize] += 1;
+    auto dec_stream = GetDecryptingStream(&saead, &modified);
+    EXPECT_FALSE(dec_stream->PRead(0, 10, buffer.get()).ok());
+    EXPECT_FALSE(dec_stream->size().ok());
+  }
+  {
+    // A wrong header.
+    std::string modified = ct;
+    modified[0] = 'x';
+    auto dec_stream = GetDecryptingStream(&saead, &modified);
+    EXPECT_EQ(util::error::INVALID_ARGUMENT,
+              dec_stream->PRead(0, 10, buffer.get()).error_code());
+  }
+}
+
+TEST(FlushableDecryptingRandomAccessStreamTest, ConcurrentPReads) {
+  DummyStreamingAead saead(kPtSegmentSize, kHeaderSize, /* ct_offset = */ 0);
+  std::string pt = Random::GetRandomBytes(5000);
+  std::string ct;
+  Encrypt(&saead, pt, /* flush_interval = */ 77, &ct);
+  auto dec_stream = GetDecryptingStream(&saead, &ct);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&dec_stream, &pt, t]() {
+      auto buffer = std::move(Buffer::New(123).ValueOrDie());
+      for (int position = 5000 - 123 - t; position >= 0; position -= 97) {
+        auto status = dec_stream->PRead(position, 123, buffer.get());
+        EXPECT_TRUE(status.ok()) << status;
+        EXPECT_EQ(pt.substr(position, 123),
+                  std::string(buffer->get_mem_block(), buffer->size()));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,82 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_FLUSHABLE_SEGMENT_FORMAT_H_
+#define TINK_SUBTLE_FLUSHABLE_SEGMENT_FORMAT_H_
+
+#include <cstdint>
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace flushable_segment_format {
+
+// The flushable ciphertext format is a variant of the format of
+// StreamSegmentEncrypter in which a segment may end early, when the writer
+// flushes the stream.  It consists of the header of the stream and of
+// framed segments:
+//
+//   | header | kind | [length] | ciphertext segment | kind | ...
+//
+// where 'kind' is one byte:
+//  * kFullSegment: a not-last segment that encrypts as much plaintext as
+//    the segment can hold, i.e. whose ciphertext has the size of segment
+//    'segment_number' in the fixed-size format;
+//  * kFlushedSegment: a not-last segment that ended at a Flush(), followed
+//    by 'length', the size of its ciphertext as a 4-byte big-endian value;
+//  * kLastSegment: the last segment, followed by 'length' as above.
+//
+// The segments are encrypted as in the fixed-size format, with consecutive
+// segment numbers and the last-segment flag, so that truncating the stream,
+// or moving the boundary between two segments, fails the authentication.
+constexpr uint8_t kFullSegment = 0;
+constexpr uint8_t kFlushedSegment = 1;
+constexpr uint8_t kLastSegment = 2;
+
+constexpr int kLengthSize = 4;
+
+// Returns the size of the frame that precedes a segment of 'kind'.
+inline int FrameSize(uint8_t kind) {
+  return kind == kFullSegment ? 1 : 1 + kLengthSize;
+}
+
+inline void StoreLength(uint32_t length, uint8_t* out) {
+  out[0] = static_cast<uint8_t>(length >> 24);
+  out[1] = static_cast<uint8_t>(length >> 16);
+  out[2] = static_cast<uint8_t>(length >> 8);
+  out[3] = static_cast<uint8_t>(length);
+}
+
+inline uint32_t LoadLength(const uint8_t* in) {
+  return (static_cast<uint32_t>(in[0]) << 24) |
+         (static_cast<uint32_t>(in[1]) << 16) |
+         (static_cast<uint32_t>(in[2]) << 8) | static_cast<uint32_t>(in[3]);
+}
+
+// Returns the ciphertext size of a full segment 'segment_number' of a
+// stream with the given parameters.
+inline int FullSegmentSize(int64_t segment_number, int ct_segment_size,
+                           int header_size, int ct_offset) {
+  if (segment_number == 0) return ct_segment_size - header_size - ct_offset;
+  return ct_segment_size;
+}
+
+}  // namespace flushable_segment_format
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_FLUSHABLE_SEGMENT_FORMAT_H_
@@ -16,6 +16,7 @@
 
 #include "tink/subtle/hmac_boringssl.h"
 
+#include <algorithm>
 #include <string>
 
 #include "absl/memory/memory.h"
@@ -57,49 +58,79 @@ util::StatusOr<std::unique_ptr<Mac>> HmacBoringSsl::New(HashType hash_type,
   if (key.size() < kMinKeySize) {
     return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
   }
-  return {absl::WrapUnique(new HmacBoringSsl(md, tag_size, std::move(key)))};
+
+  bssl::UniquePtr<HMAC_CTX> ctx(HMAC_CTX_new());
+  if (ctx == nullptr ||
+      !HMAC_Init_ex(ctx.get(), key.data(), key.size(), md, nullptr)) {
+    return util::Status(util::error::INTERNAL,
+                        "BoringSSL failed to initialize HMAC");
+  }
+  return {absl::WrapUnique(new HmacBoringSsl(tag_size, std::move(ctx)))};
 }
 
-util::StatusOr<std::string> HmacBoringSsl::ComputeMac(
-    absl::string_view data) const {
+util::Status HmacBoringSsl::ComputeFullMac(absl::string_view data,
+                                           uint8_t* buf) const {
   // BoringSSL expects a non-null pointer for data,
   // regardless of whether the size is 0.
   data = SubtleUtilBoringSSL::EnsureNonNull(data);
 
-  uint8_t buf[EVP_MAX_MD_SIZE];
+  bssl::ScopedHMAC_CTX ctx;
   unsigned int out_len;
-  const uint8_t* res = HMAC(md_, key_.data(), key_.size(),
-                            reinterpret_cast<const uint8_t*>(data.data()),
-                            data.size(), buf, &out_len);
-  if (res == nullptr) {
+  if (!HMAC_CTX_copy_ex(ctx.get(), hmac_context_.get()) ||
+      !HMAC_Update(ctx.get(), reinterpret_cast<const uint8_t*>(data.data()),
+                   data.size()) ||
+      !HMAC_Final(ctx.get(), buf, &out_len)) {
     // TODO(bleichen): We expect that BoringSSL supports the
     //   hashes that we use. Maybe we should have a status that indicates
     //   such mismatches between expected and actual behaviour.
     return util::Status(util::error::INTERNAL,
                         "BoringSSL failed to compute HMAC");
   }
+  return util::OkStatus();
+}
+
+util::StatusOr<std::string> HmacBoringSsl::ComputeMac(
+    absl::string_view data) const {
+  uint8_t buf[EVP_MAX_MD_SIZE];
+  auto status = ComputeFullMac(data, buf);
+  if (!status.ok()) return status;
   return std::string(reinterpret_cast<char*>(buf), tag_size_);
 }
 
+util::StatusOr<int64_t> HmacBoringSsl::ComputeMacInto(
+    absl::string_view data, absl::Span<uint8_t> tag) const {
+  if (tag.size() < tag_size_) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Tag buffer too small");
+  }
+  uint8_t buf[EVP_MAX_MD_SIZE];
+  auto status = ComputeFullMac(data, buf);
+  if (!status.ok()) return status;
+  std::copy_n(buf, tag_size_, tag.data());
+  return tag_size_;
+}
+
+util::StatusOr<std::unique_ptr<Mac>> HmacBoringSsl::WithPrefix(
+    absl::string_view prefix) const {
+  prefix = SubtleUtilBoringSSL::EnsureNonNull(prefix);
+  bssl::UniquePtr<HMAC_CTX> ctx(HMAC_CTX_new());
+  if (ctx == nullptr || !HMAC_CTX_copy_ex(ctx.get(), hmac_context_.get()) ||
+      !HMAC_Update(ctx.get(), reinterpret_cast<const uint8_t*>(prefix.data()),
+                   prefix.size())) {
+    return util::Status(util::error::INTERNAL,
+                        "BoringSSL failed to compute HMAC");
+  }
+  return {absl::WrapUnique(new HmacBoringSsl(tag_size_, std::move(ctx)))};
+}
+
 util::Status HmacBoringSsl::VerifyMac(
     absl::string_view mac,
     absl::string_view data) const {
-  // BoringSSL expects a non-null pointer for data,
-  // regardless of whether the size is 0.
-  data = SubtleUtilBoringSSL::EnsureNonNull(data);
-
   if (mac.size() != tag_size_) {
     return util::Status(util::error::INVALID_ARGUMENT, "incorrect tag size");
   }
   uint8_t buf[EVP_MAX_MD_SIZE];
-  unsigned int out_len;
-  const uint8_t* res = HMAC(md_, key_.data(), key_.size(),
-                            reinterpret_cast<const uint8_t*>(data.data()),
-                            data.size(), buf, &out_len);
-  if (res == nullptr) {
-    return util::Status(util::error::INTERNAL,
-                        "BoringSSL failed to compute HMAC");
-  }
+  auto status = ComputeFullMac(data, buf);
+  if (!status.ok()) return status;
   if (CRYPTO_memcmp(buf, mac.data(), tag_size_) != 0) {
     return util::Status(util::error::INVALID_ARGUMENT, "verification failed");
   }
@@ -21,9 +21,14 @@
 #include <utility>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/base.h"
 #include "openssl/evp.h"
+#include "openssl/hmac.h"
+#include "openssl/sha.h"
 #include "tink/mac.h"
 #include "tink/config/tink_fips.h"
+#include "tink/space_used.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/status.h"
@@ -33,7 +38,7 @@ namespace crypto {
 namespace tink {
 namespace subtle {
 
-class HmacBoringSsl : public Mac {
+class HmacBoringSsl : public Mac, public SpaceUsedInterface {
  public:
   static crypto::tink::util::StatusOr<std::unique_ptr<Mac>> New(
       HashType hash_type, uint32_t tag_size, util::SecretData key);
@@ -48,6 +53,23 @@ class HmacBoringSsl : public Mac {
       absl::string_view mac,
       absl::string_view data) const override;
 
+  // Computes the HMAC for 'data' into 'tag', without allocating.
+  crypto::tink::util::StatusOr<int64_t> ComputeMacInto(
+      absl::string_view data, absl::Span<uint8_t> tag) const override;
+
+  using Mac::VerifyMac;
+
+  // Returns an HmacBoringSsl whose context has absorbed 'prefix', so that
+  // only the rest of each message is hashed. The returned Mac does not refer
+  // to this one.
+  crypto::tink::util::StatusOr<std::unique_ptr<Mac>> WithPrefix(
+      absl::string_view prefix) const override;
+
+  // The HMAC_CTX holds three digest states, none larger than a SHA-512 one.
+  size_t SpaceUsed() const override {
+    return sizeof(*this) + sizeof(HMAC_CTX) + 3 * sizeof(SHA512_CTX);
+  }
+
   static constexpr crypto::tink::FipsCompatibility kFipsStatus =
       crypto::tink::FipsCompatibility::kRequiresBoringCrypto;
 
@@ -55,13 +77,19 @@ class HmacBoringSsl : public Mac {
   // Minimum HMAC key size in bytes.
   static constexpr size_t kMinKeySize = 16;
 
-  HmacBoringSsl(const EVP_MD* md, uint32_t tag_size, util::SecretData key)
-      : md_(md), tag_size_(tag_size), key_(std::move(key)) {}
+  HmacBoringSsl(uint32_t tag_size, bssl::UniquePtr<HMAC_CTX> ctx)
+      : tag_size_(tag_size), hmac_context_(std::move(ctx)) {}
+
+  // Computes the untruncated HMAC of 'data' into 'buf', which must hold at
+  // least EVP_MAX_MD_SIZE bytes.
+  crypto::tink::util::Status ComputeFullMac(absl::string_view data,
+                                            uint8_t* buf) const;
 
-  // HmacBoringSsl is not owner of md (it is owned by BoringSSL).
-  const EVP_MD* const md_;
   const uint32_t tag_size_;
-  const util::SecretData key_;
+  // A context keyed in New(), i.e. with the inner and outer pads already
+  // absorbed, followed by the prefix for Macs made by WithPrefix().  It is
+  // never modified; each call works on a copy of it.
+  const bssl::UniquePtr<HMAC_CTX> hmac_context_;
 };
 
 }  // namespace subtle
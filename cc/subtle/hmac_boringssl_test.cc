@@ -17,8 +17,11 @@
 #include "tink/subtle/hmac_boringssl.h"
 
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "absl/types/span.h"
 #include "tink/mac.h"
 #include "tink/config/tink_fips.h"
 #include "tink/subtle/common_enums.h"
@@ -33,6 +36,7 @@ namespace tink {
 namespace subtle {
 namespace {
 
+using ::crypto::tink::test::IsOk;
 using ::crypto::tink::test::StatusIs;
 
 class HmacBoringSslTest : public ::testing::Test {
@@ -90,6 +94,68 @@ TEST_F(HmacBoringSslTest, testBasic) {
   }
 }
 
+TEST_F(HmacBoringSslTest, testComputeMacInto) {
+  if (kUseOnlyFips && !FIPS_mode()) {
+    GTEST_SKIP()
+        << "Test should not run in FIPS mode when BoringCrypto is unavailable.";
+  }
+
+  util::SecretData key = util::SecretDataFromStringView(
+      test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
+  size_t tag_size = 16;
+  auto hmac_result = HmacBoringSsl::New(HashType::SHA1, tag_size, key);
+  EXPECT_TRUE(hmac_result.ok()) << hmac_result.status();
+  auto hmac = std::move(hmac_result.ValueOrDie());
+  std::string data = "Some data to test.";
+  std::vector<uint8_t> tag(tag_size + 4, 0);
+  auto res = hmac->ComputeMacInto(data, absl::MakeSpan(tag));
+  EXPECT_TRUE(res.ok()) << res.status().ToString();
+  EXPECT_EQ(tag_size, res.ValueOrDie());
+  EXPECT_EQ(std::string(tag.begin(), tag.begin() + tag_size),
+            test::HexDecodeOrDie("9ccdca5b7fffb690df396e4ac49b9cd4"));
+  EXPECT_EQ(std::vector<uint8_t>(4, 0),
+            std::vector<uint8_t>(tag.begin() + tag_size, tag.end()));
+  EXPECT_THAT(hmac->VerifyMac(absl::MakeConstSpan(tag.data(), tag_size), data),
+              IsOk());
+  EXPECT_THAT(
+      hmac->ComputeMacInto(data, absl::MakeSpan(tag.data(), tag_size - 1))
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(HmacBoringSslTest, testWithPrefix) {
+  if (kUseOnlyFips && !FIPS_mode()) {
+    GTEST_SKIP()
+        << "Test should not run in FIPS mode when BoringCrypto is unavailable.";
+  }
+
+  util::SecretData key = util::SecretDataFromStringView(
+      test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
+  size_t tag_size = 16;
+  auto hmac = std::move(
+      HmacBoringSsl::New(HashType::SHA1, tag_size, key).ValueOrDie());
+  auto prefixed_result = hmac->WithPrefix("Some data");
+  ASSERT_THAT(prefixed_result.status(), IsOk());
+  std::unique_ptr<Mac> prefixed = std::move(prefixed_result.ValueOrDie());
+  // The prefixed Mac does not depend on the Mac it was made from.
+  hmac.reset();
+
+  std::string tag = prefixed->ComputeMac(" to test.").ValueOrDie();
+  EXPECT_EQ(tag, test::HexDecodeOrDie("9ccdca5b7fffb690df396e4ac49b9cd4"));
+  EXPECT_THAT(prefixed->VerifyMac(tag, " to test."), IsOk());
+  EXPECT_FALSE(prefixed->VerifyMac(tag, "Some data to test.").ok());
+  // The prefix is not consumed by computing MACs.
+  EXPECT_EQ(prefixed->ComputeMac(" to test.").ValueOrDie(), tag);
+
+  auto empty_prefix = std::move(
+      HmacBoringSsl::New(HashType::SHA1, tag_size, key)
+          .ValueOrDie()
+          ->WithPrefix("")
+          .ValueOrDie());
+  EXPECT_EQ(empty_prefix->ComputeMac("").ValueOrDie(),
+            test::HexDecodeOrDie("5433122f77bcf8a4d9b874b4149823ef"));
+}
+
 TEST_F(HmacBoringSslTest, testModification) {
   if (kUseOnlyFips && !FIPS_mode()) {
     GTEST_SKIP()
@@ -138,6 +204,36 @@ TEST_F(HmacBoringSslTest, testTruncation) {
   }
 }
 
+TEST_F(HmacBoringSslTest, testConcurrentComputeMac) {
+  if (kUseOnlyFips && !FIPS_mode()) {
+    GTEST_SKIP()
+        << "Test should not run in FIPS mode when BoringCrypto is unavailable.";
+  }
+
+  util::SecretData key = util::SecretDataFromStringView(
+      test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
+  auto hmac_result = HmacBoringSsl::New(HashType::SHA1, 16, key);
+  ASSERT_TRUE(hmac_result.ok()) << hmac_result.status();
+  const Mac& hmac = *hmac_result.ValueOrDie();
+
+  // Every call copies the keyed context, so concurrent use must not
+  // interfere.
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&hmac]() {
+      for (int j = 0; j < 100; j++) {
+        auto res = hmac.ComputeMac("Some data to test.");
+        ASSERT_TRUE(res.ok()) << res.status();
+        EXPECT_EQ(res.ValueOrDie(),
+                  test::HexDecodeOrDie("9ccdca5b7fffb690df396e4ac49b9cd4"));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
 TEST_F(HmacBoringSslTest, testInvalidKeySizes) {
   if (kUseOnlyFips && !FIPS_mode()) {
     GTEST_SKIP()
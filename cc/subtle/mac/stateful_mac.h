@@ -25,6 +25,7 @@
 #ifndef TINK_SUBTLE_MAC_STATEFUL_MAC_H_
 #define TINK_SUBTLE_MAC_STATEFUL_MAC_H_
 
+#include "tink/util/secret_data.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "absl/strings/string_view.h"
@@ -40,6 +41,15 @@ class StatefulMac {
 
   virtual util::Status Update(absl::string_view data) = 0;
   virtual util::StatusOr<std::string> Finalize() = 0;
+
+  // Returns the state reached with the data passed to Update() so far, from
+  // which StatefulMacFactory::Resume() continues.  The state is derived from
+  // the key and must be kept as secret as the key.  Returns UNIMPLEMENTED
+  // if the implementation cannot export its state.
+  virtual util::StatusOr<util::SecretData> ExportState() const {
+    return util::Status(util::error::UNIMPLEMENTED,
+                        "This StatefulMac cannot export its state");
+  }
 };
 
 class StatefulMacFactory {
@@ -47,6 +57,14 @@ class StatefulMacFactory {
   virtual ~StatefulMacFactory() {}
 
   virtual util::StatusOr<std::unique_ptr<StatefulMac>> Create() const = 0;
+
+  // Returns a StatefulMac in the 'state' which ExportState() returned for a
+  // StatefulMac of a factory with the same key and parameters.
+  virtual util::StatusOr<std::unique_ptr<StatefulMac>> Resume(
+      const util::SecretData& state) const {
+    return util::Status(util::error::UNIMPLEMENTED,
+                        "This StatefulMacFactory cannot resume a state");
+  }
 };
 
 }  // namespace subtle
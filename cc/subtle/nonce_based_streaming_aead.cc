@@ -16,22 +16,48 @@
 
 #include "tink/subtle/nonce_based_streaming_aead.h"
 
+#include <string>
+#include <vector>
+
 #include "absl/strings/string_view.h"
+#include "tink/async_output_stream.h"
 #include "tink/input_stream.h"
 #include "tink/output_stream.h"
 #include "tink/random_access_stream.h"
 #include "tink/streaming_aead.h"
 #include "tink/subtle/decrypting_random_access_stream.h"
+#include "tink/subtle/flushable_decrypting_random_access_stream.h"
 #include "tink/subtle/stream_segment_decrypter.h"
 #include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/subtle/streaming_aead_appending_stream.h"
+#include "tink/subtle/streaming_aead_async_encrypting_stream.h"
 #include "tink/subtle/streaming_aead_decrypting_stream.h"
 #include "tink/subtle/streaming_aead_encrypting_stream.h"
+#include "tink/subtle/streaming_aead_flushable_decrypting_stream.h"
+#include "tink/subtle/streaming_aead_flushable_encrypting_stream.h"
+#include "tink/subtle/streaming_aead_random_access_encrypter.h"
+#include "tink/subtle/streaming_aead_split_decrypting_stream.h"
+#include "tink/subtle/streaming_aead_stream_verifier.h"
+#include "tink/util/buffer.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
 namespace tink {
 namespace subtle {
 
+namespace {
+
+// Returns the number of the last segment of a ciphertext of
+// 'ciphertext_size' bytes, or -1 if the ciphertext is empty.
+int64_t GetLastSegmentNumber(const StreamSegmentDecrypter& segment_decrypter,
+                             int64_t ciphertext_size) {
+  int64_t ct_segment_size = segment_decrypter.get_ciphertext_segment_size();
+  return (ciphertext_size + ct_segment_size - 1) / ct_segment_size - 1;
+}
+
+}  // namespace
+
 crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
     NonceBasedStreamingAead::NewEncryptingStream(
         std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
@@ -40,7 +66,170 @@ crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
   if (!segment_encrypter_result.ok()) return segment_encrypter_result.status();
   return StreamingAeadEncryptingStream::New(
       std::move(segment_encrypter_result.ValueOrDie()),
-      std::move(ciphertext_destination));
+      std::move(ciphertext_destination), /* parallelism = */ 1,
+      buffer_pool_);
+}
+
+crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+    NonceBasedStreamingAead::NewEncryptingStreamWithSizeHint(
+        std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+        absl::string_view associated_data, int64_t plaintext_size) {
+  auto segment_encrypter_result = NewSegmentEncrypter(associated_data);
+  if (!segment_encrypter_result.ok()) return segment_encrypter_result.status();
+  return StreamingAeadEncryptingStream::NewWithSizeHint(
+      std::move(segment_encrypter_result.ValueOrDie()),
+      std::move(ciphertext_destination), plaintext_size, buffer_pool_);
+}
+
+crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+    NonceBasedStreamingAead::NewParallelEncryptingStream(
+        std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+        absl::string_view associated_data, int parallelism) {
+  auto segment_encrypter_result = NewSegmentEncrypter(associated_data);
+  if (!segment_encrypter_result.ok()) return segment_encrypter_result.status();
+  return StreamingAeadEncryptingStream::New(
+      std::move(segment_encrypter_result.ValueOrDie()),
+      std::move(ciphertext_destination), parallelism, buffer_pool_);
+}
+
+crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+    NonceBasedStreamingAead::NewParallelEncryptingStream(
+        std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+        absl::string_view associated_data,
+        std::shared_ptr<crypto::tink::Executor> executor) {
+  auto segment_encrypter_result = NewSegmentEncrypter(associated_data);
+  if (!segment_encrypter_result.ok()) return segment_encrypter_result.status();
+  return StreamingAeadEncryptingStream::New(
+      std::move(segment_encrypter_result.ValueOrDie()),
+      std::move(ciphertext_destination), std::move(executor), buffer_pool_);
+}
+
+crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::AsyncOutputStream>>
+    NonceBasedStreamingAead::NewAsyncEncryptingStream(
+        std::unique_ptr<crypto::tink::AsyncOutputStream> ciphertext_destination,
+        absl::string_view associated_data) {
+  auto segment_encrypter_result = NewSegmentEncrypter(associated_data);
+  if (!segment_encrypter_result.ok()) return segment_encrypter_result.status();
+  return StreamingAeadAsyncEncryptingStream::New(
+      std::move(segment_encrypter_result.ValueOrDie()),
+      std::move(ciphertext_destination), buffer_pool_);
+}
+
+crypto::tink::util::StatusOr<
+    std::unique_ptr<StreamingAeadRandomAccessEncrypter>>
+    NonceBasedStreamingAead::NewRandomAccessEncrypter(
+        absl::string_view associated_data) {
+  auto segment_encrypter_result = NewSegmentEncrypter(associated_data);
+  if (!segment_encrypter_result.ok()) return segment_encrypter_result.status();
+  return StreamingAeadRandomAccessEncrypter::New(
+      std::move(segment_encrypter_result.ValueOrDie()));
+}
+
+crypto::tink::util::StatusOr<
+    std::unique_ptr<StreamingAeadRandomAccessEncrypter>>
+    NonceBasedStreamingAead::NewRandomAccessEncrypterForHeader(
+        absl::string_view header, absl::string_view associated_data) {
+  auto segment_encrypter_result =
+      NewSegmentEncrypterForHeader(header, associated_data);
+  if (!segment_encrypter_result.ok()) return segment_encrypter_result.status();
+  return StreamingAeadRandomAccessEncrypter::New(
+      std::move(segment_encrypter_result.ValueOrDie()));
+}
+
+crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+    NonceBasedStreamingAead::NewAppendingStream(
+        std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+        std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+        absl::string_view associated_data) {
+  if (!SupportsAppending()) {
+    return crypto::tink::util::Status(
+        crypto::tink::util::error::UNIMPLEMENTED,
+        "Appending is not supported, as it would reuse the nonce of the last "
+        "segment");
+  }
+  if (ciphertext_source == nullptr) {
+    return crypto::tink::util::Status(
+        crypto::tink::util::error::INVALID_ARGUMENT,
+        "ciphertext_source must be non-null");
+  }
+  auto segment_decrypter_result = NewSegmentDecrypter(associated_data);
+  if (!segment_decrypter_result.ok()) return segment_decrypter_result.status();
+  std::unique_ptr<StreamSegmentDecrypter> segment_decrypter =
+      std::move(segment_decrypter_result.ValueOrDie());
+  auto ct_size_result = ciphertext_source->size();
+  if (!ct_size_result.ok()) return ct_size_result.status();
+  int64_t ct_size = ct_size_result.ValueOrDie();
+  int64_t last_segment_nr = GetLastSegmentNumber(*segment_decrypter, ct_size);
+  if (last_segment_nr < 0) {
+    return crypto::tink::util::Status(
+        crypto::tink::util::error::INVALID_ARGUMENT,
+        "ciphertext stream is too short");
+  }
+
+  // The header gives the key and the nonce prefix of the stream.
+  int header_size = segment_decrypter->get_header_size();
+  auto buffer_result = util::Buffer::New(header_size);
+  if (!buffer_result.ok()) return buffer_result.status();
+  util::Buffer& buffer = *buffer_result.ValueOrDie();
+  crypto::tink::util::Status status = ciphertext_source->PRead(
+      segment_decrypter->get_ciphertext_offset(), header_size, &buffer);
+  if (!status.ok() &&
+      status.error_code() != crypto::tink::util::error::OUT_OF_RANGE) {
+    return status;
+  }
+  if (buffer.size() < header_size) {
+    return crypto::tink::util::Status(
+        crypto::tink::util::error::INVALID_ARGUMENT,
+        "could not read header");
+  }
+  std::string header(buffer.get_mem_block(), header_size);
+
+  // Decrypting the last segment also checks that it is the last one.
+  int ct_segment_size = segment_decrypter->get_ciphertext_segment_size();
+  auto last_segment_result = StreamingAeadSplitDecryptingStream::New(
+      std::move(segment_decrypter), std::move(ciphertext_source),
+      last_segment_nr * ct_segment_size, ct_size);
+  if (!last_segment_result.ok()) return last_segment_result.status();
+  std::vector<uint8_t> last_segment;
+  const void* data;
+  while (true) {
+    auto next_result = last_segment_result.ValueOrDie()->Next(&data);
+    if (next_result.status().error_code() ==
+        crypto::tink::util::error::OUT_OF_RANGE) {
+      break;
+    }
+    if (!next_result.ok()) return next_result.status();
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    last_segment.insert(last_segment.end(), bytes,
+                        bytes + next_result.ValueOrDie());
+  }
+
+  auto encrypter_result = NewRandomAccessEncrypterForHeader(header,
+                                                            associated_data);
+  if (!encrypter_result.ok()) return encrypter_result.status();
+  return StreamingAeadAppendingStream::New(
+      std::move(encrypter_result.ValueOrDie()), last_segment_nr,
+      std::move(last_segment), std::move(ciphertext_destination));
+}
+
+crypto::tink::util::StatusOr<int64_t>
+    NonceBasedStreamingAead::GetAppendPosition(int64_t ciphertext_size) {
+  // The sizes of the segments do not depend on the associated data.
+  auto segment_decrypter_result = NewSegmentDecrypter("");
+  if (!segment_decrypter_result.ok()) return segment_decrypter_result.status();
+  const StreamSegmentDecrypter& segment_decrypter =
+      *segment_decrypter_result.ValueOrDie();
+  int64_t last_segment_nr =
+      GetLastSegmentNumber(segment_decrypter, ciphertext_size);
+  int header_size = segment_decrypter.get_header_size();
+  int ct_offset = segment_decrypter.get_ciphertext_offset();
+  if (last_segment_nr < 0 || ciphertext_size < ct_offset + header_size) {
+    return crypto::tink::util::Status(
+        crypto::tink::util::error::INVALID_ARGUMENT,
+        "ciphertext stream is too short");
+  }
+  if (last_segment_nr == 0) return ct_offset + header_size;
+  return last_segment_nr * segment_decrypter.get_ciphertext_segment_size();
 }
 
 crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
@@ -51,7 +240,18 @@ crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
   if (!segment_decrypter_result.ok()) return segment_decrypter_result.status();
   return StreamingAeadDecryptingStream::New(
       std::move(segment_decrypter_result.ValueOrDie()),
-      std::move(ciphertext_source));
+      std::move(ciphertext_source), buffer_pool_);
+}
+
+crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
+    NonceBasedStreamingAead::NewDecryptingStreamWithSizeHint(
+        std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
+        absl::string_view associated_data, int64_t ciphertext_size) {
+  auto segment_decrypter_result = NewSegmentDecrypter(associated_data);
+  if (!segment_decrypter_result.ok()) return segment_decrypter_result.status();
+  return StreamingAeadDecryptingStream::NewWithSizeHint(
+      std::move(segment_decrypter_result.ValueOrDie()),
+      std::move(ciphertext_source), ciphertext_size, buffer_pool_);
 }
 
 crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::RandomAccessStream>>
@@ -65,6 +265,86 @@ crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::RandomAccessStream>>
       std::move(ciphertext_source));
 }
 
+crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::RandomAccessStream>>
+    NonceBasedStreamingAead::NewDecryptingRandomAccessStream(
+        std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+        absl::string_view associated_data,
+        const RandomAccessOptions& options) {
+  auto segment_decrypter_result = NewSegmentDecrypter(associated_data);
+  if (!segment_decrypter_result.ok()) return segment_decrypter_result.status();
+  return DecryptingRandomAccessStream::New(
+      std::move(segment_decrypter_result.ValueOrDie()),
+      std::move(ciphertext_source), options);
+}
+
+crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
+    NonceBasedStreamingAead::NewSplitDecryptingStream(
+        std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+        absl::string_view associated_data, int64_t split_start,
+        int64_t split_end) {
+  auto segment_decrypter_result = NewSegmentDecrypter(associated_data);
+  if (!segment_decrypter_result.ok()) return segment_decrypter_result.status();
+  return StreamingAeadSplitDecryptingStream::New(
+      std::move(segment_decrypter_result.ValueOrDie()),
+      std::move(ciphertext_source), split_start, split_end);
+}
+
+crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+    NonceBasedStreamingAead::NewFlushableEncryptingStream(
+        std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+        absl::string_view associated_data) {
+  auto segment_encrypter_result = NewSegmentEncrypter(associated_data);
+  if (!segment_encrypter_result.ok()) return segment_encrypter_result.status();
+  return StreamingAeadFlushableEncryptingStream::New(
+      std::move(segment_encrypter_result.ValueOrDie()),
+      std::move(ciphertext_destination));
+}
+
+crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
+    NonceBasedStreamingAead::NewFlushableDecryptingStream(
+        std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
+        absl::string_view associated_data) {
+  auto segment_decrypter_result = NewSegmentDecrypter(associated_data);
+  if (!segment_decrypter_result.ok()) return segment_decrypter_result.status();
+  return StreamingAeadFlushableDecryptingStream::New(
+      std::move(segment_decrypter_result.ValueOrDie()),
+      std::move(ciphertext_source));
+}
+
+crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::RandomAccessStream>>
+    NonceBasedStreamingAead::NewFlushableDecryptingRandomAccessStream(
+        std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+        absl::string_view associated_data) {
+  auto segment_decrypter_result = NewSegmentDecrypter(associated_data);
+  if (!segment_decrypter_result.ok()) return segment_decrypter_result.status();
+  return FlushableDecryptingRandomAccessStream::New(
+      std::move(segment_decrypter_result.ValueOrDie()),
+      std::move(ciphertext_source));
+}
+
+crypto::tink::util::StatusOr<std::vector<StreamingAead::CiphertextRange>>
+    NonceBasedStreamingAead::PlanCiphertextRanges(int64_t ciphertext_size,
+                                                  int64_t position,
+                                                  int64_t count,
+                                                  int64_t max_gap) {
+  // The sizes of the segments do not depend on the associated data.
+  auto segment_decrypter_result = NewSegmentDecrypter("");
+  if (!segment_decrypter_result.ok()) return segment_decrypter_result.status();
+  return DecryptingRandomAccessStream::PlanCiphertextRanges(
+      *segment_decrypter_result.ValueOrDie(), ciphertext_size, position, count,
+      max_gap);
+}
+
+crypto::tink::util::Status NonceBasedStreamingAead::VerifyStream(
+    std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
+    absl::string_view associated_data, int parallelism) {
+  auto segment_decrypter_result = NewSegmentDecrypter(associated_data);
+  if (!segment_decrypter_result.ok()) return segment_decrypter_result.status();
+  return VerifyCiphertextStream(
+      std::move(segment_decrypter_result.ValueOrDie()),
+      ciphertext_source.get(), parallelism);
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
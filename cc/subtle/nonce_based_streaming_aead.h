@@ -17,13 +17,23 @@
 #ifndef TINK_SUBTLE_NONCE_BASED_STREAMING_AEAD_H_
 #define TINK_SUBTLE_NONCE_BASED_STREAMING_AEAD_H_
 
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "absl/strings/string_view.h"
+#include "tink/async_output_stream.h"
+#include "tink/executor.h"
 #include "tink/input_stream.h"
 #include "tink/output_stream.h"
 #include "tink/random_access_stream.h"
 #include "tink/streaming_aead.h"
+#include "tink/subtle/segment_buffer_pool.h"
 #include "tink/subtle/stream_segment_decrypter.h"
 #include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/subtle/streaming_aead_random_access_encrypter.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -42,17 +52,171 @@ class NonceBasedStreamingAead : public StreamingAead {
       std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
       absl::string_view associated_data) override;
 
+  // Like NewEncryptingStream(), but 'plaintext_size' is the number of bytes
+  // that will be written to the returned stream, if known, so that small
+  // plaintexts are buffered with no more memory than they need (see
+  // StreamingAeadEncryptingStream::NewWithSizeHint()).  The ciphertext is
+  // the same as that of NewEncryptingStream().
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+  NewEncryptingStreamWithSizeHint(
+      std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+      absl::string_view associated_data, int64_t plaintext_size);
+
+  // Like NewEncryptingStream(), but the returned stream encrypts up to
+  // 'parallelism' segments concurrently (see StreamingAeadEncryptingStream).
+  // The ciphertext is the same as that of NewEncryptingStream().
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+  NewParallelEncryptingStream(
+      std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+      absl::string_view associated_data, int parallelism);
+
+  // Like NewParallelEncryptingStream() above, but the returned stream
+  // encrypts the segments on the shared 'executor' and on the calling
+  // thread.
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+  NewParallelEncryptingStream(
+      std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+      absl::string_view associated_data,
+      std::shared_ptr<crypto::tink::Executor> executor);
+
+  // Like NewEncryptingStream(), but the returned stream writes to an
+  // AsyncOutputStream, and does not block while it is busy (see
+  // StreamingAeadAsyncEncryptingStream).  The ciphertext is the same as
+  // that of NewEncryptingStream().
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::AsyncOutputStream>>
+  NewAsyncEncryptingStream(
+      std::unique_ptr<crypto::tink::AsyncOutputStream> ciphertext_destination,
+      absl::string_view associated_data);
+
+  // Returns an encrypter for a new ciphertext stream, whose segments can be
+  // encrypted in any order and concatenated afterwards (see
+  // StreamingAeadRandomAccessEncrypter).
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<StreamingAeadRandomAccessEncrypter>>
+  NewRandomAccessEncrypter(absl::string_view associated_data);
+
+  // Like NewRandomAccessEncrypter(), but returns an encrypter for the
+  // existing ciphertext stream that starts with 'header', so that several
+  // parties can encrypt the segments of one stream.  The parties must
+  // encrypt disjoint segments.
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<StreamingAeadRandomAccessEncrypter>>
+  NewRandomAccessEncrypterForHeader(absl::string_view header,
+                                    absl::string_view associated_data);
+
+  // Returns a stream that appends the plaintext written to it to the
+  // ciphertext in 'ciphertext_source', without re-encrypting more than its
+  // last segment: the returned stream decrypts that segment, and writes it
+  // again with the appended plaintext, followed by the new segments, to
+  // 'ciphertext_destination'.  The caller must replace the bytes of the
+  // ciphertext from GetAppendPosition() on with the bytes written to
+  // 'ciphertext_destination', e.g. by truncating the file there and
+  // appending to it.
+  //
+  // Only supported if SupportsAppending() is true.  WARNING: a version of
+  // a ciphertext must be appended to at most once; appending different
+  // plaintexts to the same version (e.g. from concurrent writers, or when
+  // retrying a failed append) reuses the nonce of the last segment.  Also,
+  // whoever can modify the ciphertext can replace it by an older version.
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+  NewAppendingStream(
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+      absl::string_view associated_data);
+
+  // Returns the position of the last segment of a ciphertext of
+  // 'ciphertext_size' bytes, from which NewAppendingStream() rewrites it.
+  crypto::tink::util::StatusOr<int64_t> GetAppendPosition(
+      int64_t ciphertext_size);
+
   crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
   NewDecryptingStream(
       std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
       absl::string_view associated_data) override;
 
+  // Like NewDecryptingStream(), but 'ciphertext_size' is the number of bytes
+  // of 'ciphertext_source', e.g. the size of a file, so that small
+  // ciphertexts are read and decrypted in one pass (see
+  // StreamingAeadDecryptingStream::NewWithSizeHint()).
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
+  NewDecryptingStreamWithSizeHint(
+      std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
+      absl::string_view associated_data, int64_t ciphertext_size);
+
   crypto::tink::util::StatusOr<
       std::unique_ptr<crypto::tink::RandomAccessStream>>
   NewDecryptingRandomAccessStream(
       std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
       absl::string_view associated_data) override;
 
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<crypto::tink::RandomAccessStream>>
+  NewDecryptingRandomAccessStream(
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view associated_data,
+      const RandomAccessOptions& options) override;
+
+  // Returns a stream decrypting the segments of 'ciphertext_source' that
+  // start in its byte range [split_start, split_end), so that the splits of
+  // one large ciphertext can be decrypted in parallel by different workers
+  // (see StreamingAeadSplitDecryptingStream).  Concatenating the plaintexts
+  // of the splits of a partition of the ciphertext yields its plaintext.
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
+  NewSplitDecryptingStream(
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view associated_data, int64_t split_start,
+      int64_t split_end);
+
+  // Like NewEncryptingStream(), but the returned stream supports Flush(),
+  // which writes the plaintext written so far through to
+  // 'ciphertext_destination' as a short segment.  The ciphertext is in the
+  // flushable format (see flushable_segment_format.h), which only the
+  // streams of NewFlushableDecryptingStream() and
+  // NewFlushableDecryptingRandomAccessStream() decrypt.
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+  NewFlushableEncryptingStream(
+      std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+      absl::string_view associated_data);
+
+  // Returns a stream decrypting a ciphertext of
+  // NewFlushableEncryptingStream().
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
+  NewFlushableDecryptingStream(
+      std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
+      absl::string_view associated_data);
+
+  // Returns a random access stream decrypting a ciphertext of
+  // NewFlushableEncryptingStream() (see
+  // FlushableDecryptingRandomAccessStream).
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<crypto::tink::RandomAccessStream>>
+  NewFlushableDecryptingRandomAccessStream(
+      std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+      absl::string_view associated_data);
+
+  // Plans the ranges read by the streams of
+  // NewDecryptingRandomAccessStream() (see
+  // DecryptingRandomAccessStream::PlanCiphertextRanges()).
+  crypto::tink::util::StatusOr<std::vector<CiphertextRange>>
+  PlanCiphertextRanges(int64_t ciphertext_size, int64_t position,
+                       int64_t count, int64_t max_gap) override;
+
+  // Verifies the segments with StreamSegmentDecrypter::VerifySegment(), in
+  // parallel (see VerifyCiphertextStream()).
+  crypto::tink::util::Status VerifyStream(
+      std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
+      absl::string_view associated_data, int parallelism) override;
+
+  // Makes the encrypting and decrypting streams created afterwards take
+  // their segment buffers from 'buffer_pool', which may be shared by
+  // several primitives (see SegmentBufferPool).  This is worthwhile for
+  // large segments and many short-lived streams.  By default, or if
+  // 'buffer_pool' is null, each stream allocates its own buffers.
+  // Must not be called concurrently with the creation of streams.
+  void set_segment_buffer_pool(std::shared_ptr<SegmentBufferPool> buffer_pool) {
+    buffer_pool_ = std::move(buffer_pool);
+  }
+
  protected:
   // Methods to be implemented by a subclass of this class.
 
@@ -60,9 +224,29 @@ class NonceBasedStreamingAead : public StreamingAead {
   virtual crypto::tink::util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
   NewSegmentEncrypter(absl::string_view associated_data) const = 0;
 
+  // Returns a new StreamSegmentEncrypter that uses `associated_data` for AEAD,
+  // and continues the ciphertext stream that starts with `header`, i.e. has
+  // the same key and nonce prefix as the encrypter that produced `header`.
+  // The default implementation returns UNIMPLEMENTED.
+  virtual crypto::tink::util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+  NewSegmentEncrypterForHeader(absl::string_view header,
+                               absl::string_view associated_data) const {
+    return crypto::tink::util::Status(
+        crypto::tink::util::error::UNIMPLEMENTED,
+        "Encrypting for a given header is not supported");
+  }
+
   // Returns a new StreamSegmentDecrypter that uses `associated_data` for AEAD.
   virtual crypto::tink::util::StatusOr<std::unique_ptr<StreamSegmentDecrypter>>
   NewSegmentDecrypter(absl::string_view associated_data) const = 0;
+
+  // Returns true iff encrypting a longer plaintext as the same segment, with
+  // the same nonce, is safe, as long as the old plaintext is a prefix of the
+  // new one.  NewAppendingStream() requires it.  The default is false.
+  virtual bool SupportsAppending() const { return false; }
+
+ private:
+  std::shared_ptr<SegmentBufferPool> buffer_pool_;
 };
 
 }  // namespace subtle
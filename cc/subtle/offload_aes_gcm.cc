@@ -0,0 +1,298 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/offload_aes_gcm.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+// The inputs and output of an asynchronous operation, which have to live
+// until the engine has completed it.
+struct AsyncOperation {
+  std::string input;
+  std::string associated_data;
+  std::string output;
+};
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<OffloadAesGcm>> OffloadAesGcm::New(
+    const util::SecretData& key, std::shared_ptr<OffloadEngine> engine,
+    int64_t min_offload_size) {
+  if (engine == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT, "engine is null");
+  }
+  auto software_result = AesGcmBoringSsl::New(key);
+  if (!software_result.ok()) return software_result.status();
+  auto session_result = engine->NewAesGcmSession(key);
+  if (!session_result.ok()) return session_result.status();
+  return {absl::WrapUnique(new OffloadAesGcm(
+      std::move(software_result.ValueOrDie()), std::move(engine),
+      std::move(session_result.ValueOrDie()), min_offload_size))};
+}
+
+std::vector<util::Status> OffloadAesGcm::RunOnEngine(
+    std::vector<OffloadEngine::AesGcmOperation> batch) const {
+  std::vector<util::Status> statuses(batch.size());
+  absl::BlockingCounter pending(batch.size());
+  for (size_t i = 0; i < batch.size(); i++) {
+    util::Status* status = &statuses[i];
+    batch[i].done = [status, &pending](util::Status result) {
+      *status = std::move(result);
+      pending.DecrementCount();
+    };
+  }
+  if (!batch.empty()) {
+    session_->Submit(std::move(batch));
+    pending.Wait();
+  }
+  return statuses;
+}
+
+util::StatusOr<std::string> OffloadAesGcm::Encrypt(
+    absl::string_view plaintext, absl::string_view associated_data) const {
+  std::string result;
+  ResizeStringUninitialized(
+      &result, kIvSizeInBytes + plaintext.size() + kTagSizeInBytes);
+  auto written_result = EncryptInto(plaintext, associated_data,
+                                    absl::MakeSpan(&result[0], result.size()));
+  if (!written_result.ok()) return written_result.status();
+  return result;
+}
+
+util::StatusOr<std::string> OffloadAesGcm::Decrypt(
+    absl::string_view ciphertext, absl::string_view associated_data) const {
+  if (ciphertext.size() < kIvSizeInBytes + kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  std::string result;
+  ResizeStringUninitialized(
+      &result, ciphertext.size() - kIvSizeInBytes - kTagSizeInBytes);
+  auto written_result = DecryptInto(ciphertext, associated_data,
+                                    absl::MakeSpan(&result[0], result.size()));
+  if (!written_result.ok()) return written_result.status();
+  return result;
+}
+
+util::StatusOr<int64_t> OffloadAesGcm::CiphertextSize(
+    int64_t plaintext_size) const {
+  return software_->CiphertextSize(plaintext_size);
+}
+
+util::StatusOr<int64_t> OffloadAesGcm::EncryptInto(
+    absl::string_view plaintext, absl::string_view associated_data,
+    absl::Span<char> ciphertext_buffer) const {
+  if (static_cast<int64_t>(plaintext.size()) < min_offload_size_) {
+    return software_->EncryptInto(plaintext, associated_data,
+                                  ciphertext_buffer);
+  }
+  const size_t ciphertext_size =
+      kIvSizeInBytes + plaintext.size() + kTagSizeInBytes;
+  if (ciphertext_buffer.size() < ciphertext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Ciphertext buffer too small");
+  }
+  util::Status status =
+      Random::GetRandomBytes(ciphertext_buffer.subspan(0, kIvSizeInBytes));
+  if (!status.ok()) return status;
+  std::vector<OffloadEngine::AesGcmOperation> batch(1);
+  batch[0].seal = true;
+  batch[0].nonce =
+      absl::string_view(ciphertext_buffer.data(), kIvSizeInBytes);
+  batch[0].input = plaintext;
+  batch[0].associated_data = associated_data;
+  batch[0].output = ciphertext_buffer.subspan(
+      kIvSizeInBytes, plaintext.size() + kTagSizeInBytes);
+  status = RunOnEngine(std::move(batch))[0];
+  if (ShouldFallBackToSoftware(status)) {
+    return software_->EncryptInto(plaintext, associated_data,
+                                  ciphertext_buffer);
+  }
+  if (!status.ok()) return status;
+  return ciphertext_size;
+}
+
+util::StatusOr<int64_t> OffloadAesGcm::DecryptInto(
+    absl::string_view ciphertext, absl::string_view associated_data,
+    absl::Span<char> plaintext_buffer) const {
+  if (ciphertext.size() < kIvSizeInBytes + kTagSizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  const size_t plaintext_size =
+      ciphertext.size() - kIvSizeInBytes - kTagSizeInBytes;
+  if (static_cast<int64_t>(plaintext_size) < min_offload_size_) {
+    return software_->DecryptInto(ciphertext, associated_data,
+                                  plaintext_buffer);
+  }
+  if (plaintext_buffer.size() < plaintext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Plaintext buffer too small");
+  }
+  std::vector<OffloadEngine::AesGcmOperation> batch(1);
+  batch[0].seal = false;
+  batch[0].nonce = ciphertext.substr(0, kIvSizeInBytes);
+  batch[0].input = ciphertext.substr(kIvSizeInBytes);
+  batch[0].associated_data = associated_data;
+  batch[0].output = plaintext_buffer.subspan(0, plaintext_size);
+  util::Status status = RunOnEngine(std::move(batch))[0];
+  if (ShouldFallBackToSoftware(status)) {
+    return software_->DecryptInto(ciphertext, associated_data,
+                                  plaintext_buffer);
+  }
+  if (!status.ok()) return status;
+  return plaintext_size;
+}
+
+util::Status OffloadAesGcm::EncryptBatchInto(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::Span<const absl::string_view> associated_data,
+    absl::Span<const absl::Span<char>> ciphertext_buffers) const {
+  if (plaintexts.size() != associated_data.size() ||
+      plaintexts.size() != ciphertext_buffers.size()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Batch sizes do not match");
+  }
+  std::vector<OffloadEngine::AesGcmOperation> batch;
+  std::vector<size_t> offloaded;
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    if (static_cast<int64_t>(plaintexts[i].size()) < min_offload_size_) {
+      auto written_result = software_->EncryptInto(
+          plaintexts[i], associated_data[i], ciphertext_buffers[i]);
+      if (!written_result.ok()) return written_result.status();
+      continue;
+    }
+    absl::Span<char> buffer = ciphertext_buffers[i];
+    if (buffer.size() <
+        kIvSizeInBytes + plaintexts[i].size() + kTagSizeInBytes) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Ciphertext buffer too small");
+    }
+    util::Status status =
+        Random::GetRandomBytes(buffer.subspan(0, kIvSizeInBytes));
+    if (!status.ok()) return status;
+    OffloadEngine::AesGcmOperation operation;
+    operation.seal = true;
+    operation.nonce = absl::string_view(buffer.data(), kIvSizeInBytes);
+    operation.input = plaintexts[i];
+    operation.associated_data = associated_data[i];
+    operation.output = buffer.subspan(
+        kIvSizeInBytes, plaintexts[i].size() + kTagSizeInBytes);
+    batch.push_back(std::move(operation));
+    offloaded.push_back(i);
+  }
+  std::vector<util::Status> statuses = RunOnEngine(std::move(batch));
+  for (size_t k = 0; k < offloaded.size(); k++) {
+    if (statuses[k].ok()) continue;
+    if (!ShouldFallBackToSoftware(statuses[k])) return statuses[k];
+    size_t i = offloaded[k];
+    auto written_result = software_->EncryptInto(
+        plaintexts[i], associated_data[i], ciphertext_buffers[i]);
+    if (!written_result.ok()) return written_result.status();
+  }
+  return util::Status::OK;
+}
+
+void OffloadAesGcm::EncryptAsync(absl::string_view plaintext,
+                                 absl::string_view associated_data,
+                                 DoneCallback done) const {
+  if (static_cast<int64_t>(plaintext.size()) < min_offload_size_) {
+    done(software_->Encrypt(plaintext, associated_data));
+    return;
+  }
+  auto async_operation = std::make_shared<AsyncOperation>();
+  async_operation->input = std::string(plaintext);
+  async_operation->associated_data = std::string(associated_data);
+  std::string& output = async_operation->output;
+  ResizeStringUninitialized(
+      &output, kIvSizeInBytes + plaintext.size() + kTagSizeInBytes);
+  util::Status status =
+      Random::GetRandomBytes(absl::MakeSpan(&output[0], kIvSizeInBytes));
+  if (!status.ok()) {
+    done(status);
+    return;
+  }
+  std::vector<OffloadEngine::AesGcmOperation> batch(1);
+  batch[0].seal = true;
+  batch[0].nonce = absl::string_view(output.data(), kIvSizeInBytes);
+  batch[0].input = async_operation->input;
+  batch[0].associated_data = async_operation->associated_data;
+  batch[0].output = absl::MakeSpan(&output[kIvSizeInBytes],
+                                   output.size() - kIvSizeInBytes);
+  batch[0].done = [this, async_operation, done](util::Status result) {
+    if (result.ok()) {
+      done(std::move(async_operation->output));
+    } else if (ShouldFallBackToSoftware(result)) {
+      done(software_->Encrypt(async_operation->input,
+                              async_operation->associated_data));
+    } else {
+      done(result);
+    }
+  };
+  session_->Submit(std::move(batch));
+}
+
+void OffloadAesGcm::DecryptAsync(absl::string_view ciphertext,
+                                 absl::string_view associated_data,
+                                 DoneCallback done) const {
+  if (ciphertext.size() < kIvSizeInBytes + kTagSizeInBytes ||
+      static_cast<int64_t>(ciphertext.size() - kIvSizeInBytes -
+                           kTagSizeInBytes) < min_offload_size_) {
+    done(software_->Decrypt(ciphertext, associated_data));
+    return;
+  }
+  auto async_operation = std::make_shared<AsyncOperation>();
+  async_operation->input = std::string(ciphertext);
+  async_operation->associated_data = std::string(associated_data);
+  std::string& output = async_operation->output;
+  ResizeStringUninitialized(
+      &output, ciphertext.size() - kIvSizeInBytes - kTagSizeInBytes);
+  absl::string_view input = async_operation->input;
+  std::vector<OffloadEngine::AesGcmOperation> batch(1);
+  batch[0].seal = false;
+  batch[0].nonce = input.substr(0, kIvSizeInBytes);
+  batch[0].input = input.substr(kIvSizeInBytes);
+  batch[0].associated_data = async_operation->associated_data;
+  batch[0].output = absl::MakeSpan(&output[0], output.size());
+  batch[0].done = [this, async_operation, done](util::Status result) {
+    if (result.ok()) {
+      done(std::move(async_operation->output));
+    } else if (ShouldFallBackToSoftware(result)) {
+      done(software_->Decrypt(async_operation->input,
+                              async_operation->associated_data));
+    } else {
+      done(result);
+    }
+  };
+  session_->Submit(std::move(batch));
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,117 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_OFFLOAD_AES_GCM_H_
+#define TINK_SUBTLE_OFFLOAD_AES_GCM_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/aead.h"
+#include "tink/async_aead.h"
+#include "tink/subtle/offload_engine.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// AES-GCM which runs the messages of at least 'min_offload_size' bytes on
+// an OffloadEngine, and the shorter ones with AesGcmBoringSsl.  Messages
+// the engine cannot take at the moment fall back to AesGcmBoringSsl as
+// well.  The ciphertexts are the same as those of AesGcmBoringSsl, so
+// either can decrypt the ciphertexts of the other.
+//
+// Encrypt() and Decrypt() wait for the engine.  EncryptBatchInto() submits
+// all long messages of the batch at once, and EncryptAsync() and
+// DecryptAsync() return right after submitting, so that the device can
+// work on many messages while the calling threads do something else.  The
+// object must not be destroyed while asynchronous operations are pending.
+class OffloadAesGcm : public Aead, public AsyncAead {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<OffloadAesGcm>> New(
+      const util::SecretData& key, std::shared_ptr<OffloadEngine> engine,
+      int64_t min_offload_size);
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override;
+
+  crypto::tink::util::StatusOr<int64_t> EncryptInto(
+      absl::string_view plaintext, absl::string_view associated_data,
+      absl::Span<char> ciphertext_buffer) const override;
+
+  crypto::tink::util::StatusOr<int64_t> DecryptInto(
+      absl::string_view ciphertext, absl::string_view associated_data,
+      absl::Span<char> plaintext_buffer) const override;
+
+  crypto::tink::util::Status EncryptBatchInto(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::Span<const absl::string_view> associated_data,
+      absl::Span<const absl::Span<char>> ciphertext_buffers) const override;
+
+  void EncryptAsync(absl::string_view plaintext,
+                    absl::string_view associated_data,
+                    DoneCallback done) const override;
+
+  void DecryptAsync(absl::string_view ciphertext,
+                    absl::string_view associated_data,
+                    DoneCallback done) const override;
+
+ private:
+  static constexpr int kIvSizeInBytes = 12;
+  static constexpr int kTagSizeInBytes = 16;
+
+  OffloadAesGcm(std::unique_ptr<Aead> software,
+                std::shared_ptr<OffloadEngine> engine,
+                std::unique_ptr<OffloadEngine::AesGcmSession> session,
+                int64_t min_offload_size)
+      : software_(std::move(software)),
+        engine_(std::move(engine)),
+        session_(std::move(session)),
+        min_offload_size_(min_offload_size) {}
+
+  // Submits 'batch' to the engine and returns the status of every
+  // operation once all of them have completed.
+  std::vector<crypto::tink::util::Status> RunOnEngine(
+      std::vector<OffloadEngine::AesGcmOperation> batch) const;
+
+  const std::unique_ptr<Aead> software_;
+  // The engine is kept alive as long as a session with it exists.
+  const std::shared_ptr<OffloadEngine> engine_;
+  const std::unique_ptr<OffloadEngine::AesGcmSession> session_;
+  const int64_t min_offload_size_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_OFFLOAD_AES_GCM_H_
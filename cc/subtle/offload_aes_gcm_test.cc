@@ -0,0 +1,268 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/offload_aes_gcm.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/synchronization/notification.h"
+#include "openssl/aead.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::ElementsAre;
+using ::testing::Not;
+
+// Runs every batch with BoringSSL on a thread of its own, as a device
+// which completes operations on its polling thread would.
+class FakeEngine : public OffloadEngine {
+ public:
+  // The number of operations completed by the engine, and the sizes of the
+  // submitted batches.
+  struct Stats {
+    std::atomic<int> operations{0};
+    std::vector<int> batch_sizes;
+  };
+
+  class Session : public AesGcmSession {
+   public:
+    Session(bssl::UniquePtr<EVP_AEAD_CTX> ctx, const FakeEngine* engine)
+        : ctx_(std::move(ctx)), engine_(engine) {}
+
+    ~Session() override {
+      for (std::thread& thread : threads_) thread.join();
+    }
+
+    void Submit(std::vector<AesGcmOperation> batch) const override {
+      engine_->stats_->batch_sizes.push_back(batch.size());
+      threads_.emplace_back([this, batch]() {
+        for (const AesGcmOperation& operation : batch) {
+          operation.done(Run(operation));
+        }
+      });
+    }
+
+   private:
+    util::Status Run(const AesGcmOperation& operation) const {
+      if (engine_->unavailable_) {
+        return util::Status(util::error::UNAVAILABLE, "device is busy");
+      }
+      engine_->stats_->operations++;
+      auto bytes = [](absl::string_view s) {
+        return reinterpret_cast<const uint8_t*>(s.data());
+      };
+      size_t written;
+      int ok = (operation.seal ? EVP_AEAD_CTX_seal : EVP_AEAD_CTX_open)(
+          ctx_.get(), reinterpret_cast<uint8_t*>(operation.output.data()),
+          &written, operation.output.size(), bytes(operation.nonce),
+          operation.nonce.size(), bytes(operation.input),
+          operation.input.size(), bytes(operation.associated_data),
+          operation.associated_data.size());
+      if (ok != 1 || written != operation.output.size()) {
+        return util::Status(util::error::INVALID_ARGUMENT,
+                            "Authentication failed");
+      }
+      return util::Status::OK;
+    }
+
+    const bssl::UniquePtr<EVP_AEAD_CTX> ctx_;
+    const FakeEngine* const engine_;
+    mutable std::vector<std::thread> threads_;
+  };
+
+  FakeEngine(Stats* stats, bool unavailable)
+      : stats_(stats), unavailable_(unavailable) {}
+
+  absl::string_view name() const override { return "fake"; }
+
+  util::StatusOr<std::unique_ptr<AesGcmSession>> NewAesGcmSession(
+      const util::SecretData& key) const override {
+    if (key.size() != 16) {
+      return util::Status(util::error::UNIMPLEMENTED, "unsupported key");
+    }
+    bssl::UniquePtr<EVP_AEAD_CTX> ctx(
+        EVP_AEAD_CTX_new(EVP_aead_aes_128_gcm(), key.data(), key.size(),
+                         EVP_AEAD_DEFAULT_TAG_LENGTH));
+    return {absl::make_unique<Session>(std::move(ctx), this)};
+  }
+
+  util::StatusOr<std::unique_ptr<RsaSession>> NewRsaSession(
+      const SubtleUtilBoringSSL::RsaPrivateKey& key) const override {
+    return util::Status(util::error::UNIMPLEMENTED, "no RSA");
+  }
+
+ private:
+  Stats* const stats_;
+  const bool unavailable_;
+};
+
+constexpr int kMinOffloadSize = 1000;
+
+std::unique_ptr<OffloadAesGcm> NewOffloadAesGcm(const util::SecretData& key,
+                                                FakeEngine::Stats* stats,
+                                                bool unavailable = false) {
+  auto aead_result = OffloadAesGcm::New(
+      key, std::make_shared<FakeEngine>(stats, unavailable), kMinOffloadSize);
+  EXPECT_THAT(aead_result.status(), IsOk());
+  return std::move(aead_result.ValueOrDie());
+}
+
+TEST(OffloadAesGcmTest, LongMessagesRunOnTheEngine) {
+  util::SecretData key = Random::GetRandomKeyBytes(16);
+  FakeEngine::Stats stats;
+  std::unique_ptr<OffloadAesGcm> aead = NewOffloadAesGcm(key, &stats);
+  auto software = std::move(AesGcmBoringSsl::New(key).ValueOrDie());
+
+  std::string long_message = Random::GetRandomBytes(kMinOffloadSize);
+  auto ciphertext = aead->Encrypt(long_message, "ad");
+  ASSERT_THAT(ciphertext.status(), IsOk());
+  EXPECT_EQ(1, stats.operations);
+  // The software implementation decrypts what the engine encrypted, and
+  // the other way around.
+  auto plaintext = software->Decrypt(ciphertext.ValueOrDie(), "ad");
+  ASSERT_THAT(plaintext.status(), IsOk());
+  EXPECT_EQ(long_message, plaintext.ValueOrDie());
+  plaintext = aead->Decrypt(
+      software->Encrypt(long_message, "ad").ValueOrDie(), "ad");
+  ASSERT_THAT(plaintext.status(), IsOk());
+  EXPECT_EQ(long_message, plaintext.ValueOrDie());
+  EXPECT_EQ(2, stats.operations);
+
+  EXPECT_THAT(aead->Decrypt(ciphertext.ValueOrDie(), "other ad").status(),
+              Not(IsOk()));
+}
+
+TEST(OffloadAesGcmTest, ShortMessagesRunInSoftware) {
+  util::SecretData key = Random::GetRandomKeyBytes(16);
+  FakeEngine::Stats stats;
+  std::unique_ptr<OffloadAesGcm> aead = NewOffloadAesGcm(key, &stats);
+  auto ciphertext = aead->Encrypt("short", "ad");
+  ASSERT_THAT(ciphertext.status(), IsOk());
+  auto plaintext = aead->Decrypt(ciphertext.ValueOrDie(), "ad");
+  ASSERT_THAT(plaintext.status(), IsOk());
+  EXPECT_EQ("short", plaintext.ValueOrDie());
+  EXPECT_EQ(0, stats.operations);
+  EXPECT_THAT(aead->Decrypt("too short", "ad").status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(OffloadAesGcmTest, UnavailableEngineFallsBackToSoftware) {
+  util::SecretData key = Random::GetRandomKeyBytes(16);
+  FakeEngine::Stats stats;
+  std::unique_ptr<OffloadAesGcm> aead =
+      NewOffloadAesGcm(key, &stats, /*unavailable=*/true);
+  std::string long_message = Random::GetRandomBytes(2 * kMinOffloadSize);
+  auto ciphertext = aead->Encrypt(long_message, "ad");
+  ASSERT_THAT(ciphertext.status(), IsOk());
+  auto plaintext = aead->Decrypt(ciphertext.ValueOrDie(), "ad");
+  ASSERT_THAT(plaintext.status(), IsOk());
+  EXPECT_EQ(long_message, plaintext.ValueOrDie());
+  EXPECT_EQ(0, stats.operations);
+  EXPECT_EQ(2, stats.batch_sizes.size());
+}
+
+TEST(OffloadAesGcmTest, EncryptBatchSubmitsLongMessagesAtOnce) {
+  util::SecretData key = Random::GetRandomKeyBytes(16);
+  FakeEngine::Stats stats;
+  std::unique_ptr<OffloadAesGcm> aead = NewOffloadAesGcm(key, &stats);
+  std::vector<std::string> messages = {
+      Random::GetRandomBytes(kMinOffloadSize), "short",
+      Random::GetRandomBytes(3 * kMinOffloadSize), ""};
+  std::vector<absl::string_view> plaintexts(messages.begin(), messages.end());
+  std::vector<absl::string_view> associated_data = {"a", "b", "c", "d"};
+  std::string arena;
+  std::vector<absl::string_view> ciphertexts;
+  ASSERT_THAT(
+      aead->EncryptBatch(plaintexts, associated_data, &arena, &ciphertexts),
+      IsOk());
+  EXPECT_THAT(stats.batch_sizes, ElementsAre(2));
+  ASSERT_EQ(messages.size(), ciphertexts.size());
+  for (size_t i = 0; i < messages.size(); i++) {
+    auto plaintext = aead->Decrypt(ciphertexts[i], associated_data[i]);
+    ASSERT_THAT(plaintext.status(), IsOk());
+    EXPECT_EQ(messages[i], plaintext.ValueOrDie());
+  }
+}
+
+TEST(OffloadAesGcmTest, Async) {
+  util::SecretData key = Random::GetRandomKeyBytes(16);
+  FakeEngine::Stats stats;
+  std::unique_ptr<OffloadAesGcm> aead = NewOffloadAesGcm(key, &stats);
+  std::string long_message = Random::GetRandomBytes(kMinOffloadSize);
+
+  util::StatusOr<std::string> ciphertext =
+      util::Status(util::error::UNKNOWN, "not done");
+  absl::Notification encrypted;
+  // The input only has to be valid until EncryptAsync() returns.
+  std::string input = long_message;
+  aead->EncryptAsync(input, "ad", [&](util::StatusOr<std::string> result) {
+    ciphertext = std::move(result);
+    encrypted.Notify();
+  });
+  input.assign(input.size(), 'x');
+  encrypted.WaitForNotification();
+  ASSERT_THAT(ciphertext.status(), IsOk());
+
+  util::StatusOr<std::string> plaintext =
+      util::Status(util::error::UNKNOWN, "not done");
+  absl::Notification decrypted;
+  aead->DecryptAsync(ciphertext.ValueOrDie(), "ad",
+                     [&](util::StatusOr<std::string> result) {
+                       plaintext = std::move(result);
+                       decrypted.Notify();
+                     });
+  decrypted.WaitForNotification();
+  ASSERT_THAT(plaintext.status(), IsOk());
+  EXPECT_EQ(long_message, plaintext.ValueOrDie());
+  EXPECT_EQ(2, stats.operations);
+}
+
+TEST(OffloadAesGcmTest, UnsupportedKey) {
+  FakeEngine::Stats stats;
+  EXPECT_THAT(OffloadAesGcm::New(Random::GetRandomKeyBytes(32),
+                                 std::make_shared<FakeEngine>(&stats, false),
+                                 kMinOffloadSize)
+                  .status(),
+              StatusIs(util::error::UNIMPLEMENTED));
+  EXPECT_THAT(
+      OffloadAesGcm::New(Random::GetRandomKeyBytes(16), nullptr, 0).status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
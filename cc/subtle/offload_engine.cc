@@ -0,0 +1,73 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/offload_engine.h"
+
+#include <memory>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/subtle/cpu_features.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+struct OffloadRegistry {
+  absl::Mutex mutex;
+  std::shared_ptr<OffloadEngine> engine ABSL_GUARDED_BY(mutex);
+  OffloadPolicy policy ABSL_GUARDED_BY(mutex);
+};
+
+OffloadRegistry& GetOffloadRegistry() {
+  static OffloadRegistry* registry = new OffloadRegistry();
+  return *registry;
+}
+
+}  // namespace
+
+void SetOffloadEngine(std::shared_ptr<OffloadEngine> engine,
+                      const OffloadPolicy& policy) {
+  OffloadRegistry& registry = GetOffloadRegistry();
+  absl::MutexLock lock(&registry.mutex);
+  registry.engine = std::move(engine);
+  registry.policy = policy;
+}
+
+std::shared_ptr<OffloadEngine> GetOffloadEngine() {
+  if (GetDispatchPolicy() == DispatchPolicy::kPortableOnly) return nullptr;
+  OffloadRegistry& registry = GetOffloadRegistry();
+  absl::MutexLock lock(&registry.mutex);
+  return registry.engine;
+}
+
+OffloadPolicy GetOffloadPolicy() {
+  OffloadRegistry& registry = GetOffloadRegistry();
+  absl::MutexLock lock(&registry.mutex);
+  return registry.policy;
+}
+
+bool ShouldFallBackToSoftware(const util::Status& status) {
+  return status.error_code() == util::error::UNAVAILABLE ||
+         status.error_code() == util::error::RESOURCE_EXHAUSTED;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,138 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_OFFLOAD_ENGINE_H_
+#define TINK_SUBTLE_OFFLOAD_ENGINE_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// A backend which runs AES-GCM and RSA private key operations on a hardware
+// accelerator, e.g. Intel QuickAssist, instead of on the CPU.  Tink ships
+// no such backend; it is implemented on top of the vendor's driver and
+// installed with SetOffloadEngine().
+//
+// Operations are submitted in batches and complete asynchronously, usually
+// on a thread which polls the device.  An engine which is temporarily out
+// of capacity or unavailable completes operations with UNAVAILABLE or
+// RESOURCE_EXHAUSTED, and the primitives then run them in software instead
+// (see OffloadAesGcm and OffloadRsaSsaPkcs1Sign).  Any other error is final.
+class OffloadEngine {
+ public:
+  // Called exactly once per operation, on any thread, once the output has
+  // been written or the operation failed.
+  using DoneCallback = std::function<void(crypto::tink::util::Status)>;
+
+  // One AES-GCM operation with a 12 byte nonce and a 16 byte tag.  Sealing
+  // writes the ciphertext followed by the tag to 'output', which has
+  // input.size() + 16 bytes.  Opening takes the ciphertext followed by the
+  // tag as 'input', and writes the plaintext to 'output', which has
+  // input.size() - 16 bytes.  All views must stay valid until 'done' is
+  // called.
+  struct AesGcmOperation {
+    bool seal;
+    absl::string_view nonce;
+    absl::string_view input;
+    absl::string_view associated_data;
+    absl::Span<char> output;
+    DoneCallback done;
+  };
+
+  // One raw RSA private key operation: 'output' receives input^d mod n, as
+  // a big-endian integer of the size of the modulus.  'input' has the size
+  // of the modulus and is smaller than it.  Padding is the caller's job.
+  struct RsaOperation {
+    absl::string_view input;
+    absl::Span<char> output;
+    DoneCallback done;
+  };
+
+  // A key loaded into the engine.
+  class AesGcmSession {
+   public:
+    virtual ~AesGcmSession() = default;
+    // Queues all operations of 'batch' and returns without waiting for
+    // them.  Must not be called from a DoneCallback.
+    virtual void Submit(std::vector<AesGcmOperation> batch) const = 0;
+  };
+
+  class RsaSession {
+   public:
+    virtual ~RsaSession() = default;
+    virtual void Submit(std::vector<RsaOperation> batch) const = 0;
+  };
+
+  virtual ~OffloadEngine() = default;
+
+  // A short name of the engine, e.g. "qat", used for RecordImplementation().
+  // Must be a string literal.
+  virtual absl::string_view name() const = 0;
+
+  // Loads an AES key of 16 or 32 bytes.  Fails with UNIMPLEMENTED if the
+  // engine does not support the key.
+  virtual crypto::tink::util::StatusOr<std::unique_ptr<AesGcmSession>>
+  NewAesGcmSession(const crypto::tink::util::SecretData& key) const = 0;
+
+  // Loads an RSA private key, which the engine may use with or without its
+  // CRT parameters.  Fails with UNIMPLEMENTED if the engine does not support
+  // the key.
+  virtual crypto::tink::util::StatusOr<std::unique_ptr<RsaSession>>
+  NewRsaSession(const SubtleUtilBoringSSL::RsaPrivateKey& key) const = 0;
+};
+
+// Which operations the key managers hand to the engine.
+struct OffloadPolicy {
+  // AES-GCM messages below this size are encrypted and decrypted in
+  // software, since the round trip to the device costs more than AES-NI
+  // needs for them.
+  int64_t min_aes_gcm_message_size = 16 * 1024;
+  // Whether RSA-SSA-PKCS1 signing keys use the engine.
+  bool rsa_ssa_pkcs1_sign = true;
+};
+
+// Installs 'engine' for the primitives created afterwards, or removes the
+// engine if it is null.  Primitives which already exist keep theirs.
+void SetOffloadEngine(std::shared_ptr<OffloadEngine> engine,
+                      const OffloadPolicy& policy = OffloadPolicy());
+
+// Returns the installed engine, or null if there is none or the dispatch
+// policy only allows portable implementations.
+std::shared_ptr<OffloadEngine> GetOffloadEngine();
+OffloadPolicy GetOffloadPolicy();
+
+// Returns true if an operation which failed with 'status' on the engine
+// should be retried in software.
+bool ShouldFallBackToSoftware(const crypto::tink::util::Status& status);
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_OFFLOAD_ENGINE_H_
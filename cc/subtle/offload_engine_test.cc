@@ -0,0 +1,80 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/offload_engine.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "tink/subtle/cpu_features.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+class NoOpEngine : public OffloadEngine {
+ public:
+  absl::string_view name() const override { return "noop"; }
+
+  util::StatusOr<std::unique_ptr<AesGcmSession>> NewAesGcmSession(
+      const util::SecretData& key) const override {
+    return util::Status(util::error::UNIMPLEMENTED, "no AES-GCM");
+  }
+
+  util::StatusOr<std::unique_ptr<RsaSession>> NewRsaSession(
+      const SubtleUtilBoringSSL::RsaPrivateKey& key) const override {
+    return util::Status(util::error::UNIMPLEMENTED, "no RSA");
+  }
+};
+
+TEST(OffloadEngineTest, SetAndGet) {
+  EXPECT_EQ(nullptr, GetOffloadEngine());
+  auto engine = std::make_shared<NoOpEngine>();
+  OffloadPolicy policy;
+  policy.min_aes_gcm_message_size = 4096;
+  policy.rsa_ssa_pkcs1_sign = false;
+  SetOffloadEngine(engine, policy);
+  EXPECT_EQ(engine, GetOffloadEngine());
+  EXPECT_EQ(4096, GetOffloadPolicy().min_aes_gcm_message_size);
+  EXPECT_FALSE(GetOffloadPolicy().rsa_ssa_pkcs1_sign);
+
+  // Portable implementations only rule out the engine.
+  SetDispatchPolicy(DispatchPolicy::kPortableOnly);
+  EXPECT_EQ(nullptr, GetOffloadEngine());
+  SetDispatchPolicy(DispatchPolicy::kFastest);
+  EXPECT_EQ(engine, GetOffloadEngine());
+
+  SetOffloadEngine(nullptr);
+  EXPECT_EQ(nullptr, GetOffloadEngine());
+  EXPECT_TRUE(GetOffloadPolicy().rsa_ssa_pkcs1_sign);
+}
+
+TEST(OffloadEngineTest, ShouldFallBackToSoftware) {
+  EXPECT_TRUE(ShouldFallBackToSoftware(
+      util::Status(util::error::UNAVAILABLE, "device reset")));
+  EXPECT_TRUE(ShouldFallBackToSoftware(
+      util::Status(util::error::RESOURCE_EXHAUSTED, "queue is full")));
+  EXPECT_FALSE(ShouldFallBackToSoftware(
+      util::Status(util::error::INVALID_ARGUMENT, "Authentication failed")));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,160 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/offload_rsa_ssa_pkcs1_sign.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "openssl/crypto.h"
+#include "openssl/digest.h"
+#include "openssl/mem.h"
+#include "openssl/rsa.h"
+#include "tink/subtle/rsa_ssa_pkcs1_sign_boringssl.h"
+#include "tink/subtle/subtle_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// static
+util::StatusOr<std::unique_ptr<PublicKeySign>> OffloadRsaSsaPkcs1Sign::New(
+    const SubtleUtilBoringSSL::RsaPrivateKey& private_key,
+    const SubtleUtilBoringSSL::RsaSsaPkcs1Params& params,
+    std::shared_ptr<OffloadEngine> engine) {
+  if (engine == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT, "engine is null");
+  }
+  // Validates the key and the parameters.
+  auto software_result = RsaSsaPkcs1SignBoringSsl::New(private_key, params);
+  if (!software_result.ok()) return software_result.status();
+  auto sig_hash = SubtleUtilBoringSSL::EvpHash(params.hash_type);
+  if (!sig_hash.ok()) return sig_hash.status();
+  SubtleUtilBoringSSL::RsaPublicKey public_key;
+  public_key.n = private_key.n;
+  public_key.e = private_key.e;
+  auto rsa = SubtleUtilBoringSSL::BoringSslRsaFromRsaPublicKey(public_key);
+  if (!rsa.ok()) return rsa.status();
+  auto session_result = engine->NewRsaSession(private_key);
+  if (!session_result.ok()) return session_result.status();
+  return {absl::WrapUnique(new OffloadRsaSsaPkcs1Sign(
+      std::move(software_result.ValueOrDie()), std::move(rsa).ValueOrDie(),
+      sig_hash.ValueOrDie(), std::move(engine),
+      std::move(session_result.ValueOrDie())))};
+}
+
+util::StatusOr<std::string> OffloadRsaSsaPkcs1Sign::EncodeMessage(
+    absl::string_view data) const {
+  data = SubtleUtilBoringSSL::EnsureNonNull(data);
+  auto digest_result = boringssl::ComputeHash(data, *sig_hash_);
+  if (!digest_result.ok()) return digest_result.status();
+  const std::vector<uint8_t>& digest = digest_result.ValueOrDie();
+
+  uint8_t* digest_info = nullptr;
+  size_t digest_info_size = 0;
+  int is_allocated = 0;
+  if (RSA_add_pkcs1_prefix(&digest_info, &digest_info_size, &is_allocated,
+                           EVP_MD_type(sig_hash_), digest.data(),
+                           digest.size()) != 1) {
+    return util::Status(util::error::INTERNAL, "Encoding the digest failed");
+  }
+  bssl::UniquePtr<uint8_t> digest_info_owner(is_allocated ? digest_info
+                                                          : nullptr);
+  std::string encoded_message;
+  ResizeStringUninitialized(&encoded_message, RSA_size(public_key_.get()));
+  if (RSA_padding_add_PKCS1_type_1(
+          reinterpret_cast<uint8_t*>(&encoded_message[0]),
+          encoded_message.size(), digest_info, digest_info_size) != 1) {
+    return util::Status(util::error::INTERNAL, "Padding the digest failed");
+  }
+  return encoded_message;
+}
+
+bool OffloadRsaSsaPkcs1Sign::Verify(absl::string_view encoded_message,
+                                    absl::string_view signature) const {
+  std::string recovered;
+  ResizeStringUninitialized(&recovered, RSA_size(public_key_.get()));
+  size_t recovered_size = 0;
+  if (RSA_verify_raw(public_key_.get(), &recovered_size,
+                     reinterpret_cast<uint8_t*>(&recovered[0]),
+                     recovered.size(),
+                     reinterpret_cast<const uint8_t*>(signature.data()),
+                     signature.size(), RSA_NO_PADDING) != 1) {
+    return false;
+  }
+  return recovered_size == encoded_message.size() &&
+         CRYPTO_memcmp(recovered.data(), encoded_message.data(),
+                       recovered_size) == 0;
+}
+
+util::StatusOr<std::string> OffloadRsaSsaPkcs1Sign::Sign(
+    absl::string_view data) const {
+  auto signatures_result = SignBatch({data});
+  if (!signatures_result.ok()) return signatures_result.status();
+  return std::move(signatures_result.ValueOrDie()[0]);
+}
+
+util::StatusOr<std::vector<std::string>> OffloadRsaSsaPkcs1Sign::SignBatch(
+    absl::Span<const absl::string_view> data) const {
+  const size_t signature_size = RSA_size(public_key_.get());
+  std::vector<std::string> encoded_messages;
+  encoded_messages.reserve(data.size());
+  std::vector<std::string> signatures(data.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    auto encoded_result = EncodeMessage(data[i]);
+    if (!encoded_result.ok()) return encoded_result.status();
+    encoded_messages.push_back(std::move(encoded_result.ValueOrDie()));
+    ResizeStringUninitialized(&signatures[i], signature_size);
+  }
+
+  std::vector<util::Status> statuses(data.size());
+  absl::BlockingCounter pending(data.size());
+  std::vector<OffloadEngine::RsaOperation> batch(data.size());
+  for (size_t i = 0; i < data.size(); i++) {
+    batch[i].input = encoded_messages[i];
+    batch[i].output = absl::MakeSpan(&signatures[i][0], signature_size);
+    util::Status* status = &statuses[i];
+    batch[i].done = [status, &pending](util::Status result) {
+      *status = std::move(result);
+      pending.DecrementCount();
+    };
+  }
+  if (!batch.empty()) {
+    session_->Submit(std::move(batch));
+    pending.Wait();
+  }
+
+  for (size_t i = 0; i < data.size(); i++) {
+    if (statuses[i].ok() && Verify(encoded_messages[i], signatures[i])) {
+      continue;
+    }
+    if (!statuses[i].ok() && !ShouldFallBackToSoftware(statuses[i])) {
+      return statuses[i];
+    }
+    auto signature_result = software_->Sign(data[i]);
+    if (!signature_result.ok()) return signature_result.status();
+    signatures[i] = std::move(signature_result.ValueOrDie());
+  }
+  return signatures;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,93 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_OFFLOAD_RSA_SSA_PKCS1_SIGN_H_
+#define TINK_SUBTLE_OFFLOAD_RSA_SSA_PKCS1_SIGN_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/base.h"
+#include "openssl/rsa.h"
+#include "tink/public_key_sign.h"
+#include "tink/subtle/offload_engine.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// RSA-SSA-PKCS1 signing whose private key operation runs on an
+// OffloadEngine.  The data is hashed and padded on the CPU, and every
+// signature of the engine is verified with the public key before it is
+// returned, so that a faulty device cannot leak the key through a wrong
+// signature.  Signatures the engine cannot compute at the moment, or which
+// do not verify, are computed with RsaSsaPkcs1SignBoringSsl instead.
+//
+// SignBatch() submits all signatures of the batch to the engine at once.
+class OffloadRsaSsaPkcs1Sign : public PublicKeySign {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<PublicKeySign>> New(
+      const SubtleUtilBoringSSL::RsaPrivateKey& private_key,
+      const SubtleUtilBoringSSL::RsaSsaPkcs1Params& params,
+      std::shared_ptr<OffloadEngine> engine);
+
+  crypto::tink::util::StatusOr<std::string> Sign(
+      absl::string_view data) const override;
+
+  crypto::tink::util::StatusOr<std::vector<std::string>> SignBatch(
+      absl::Span<const absl::string_view> data) const override;
+
+ private:
+  OffloadRsaSsaPkcs1Sign(std::unique_ptr<PublicKeySign> software,
+                         bssl::UniquePtr<RSA> public_key,
+                         const EVP_MD* sig_hash,
+                         std::shared_ptr<OffloadEngine> engine,
+                         std::unique_ptr<OffloadEngine::RsaSession> session)
+      : software_(std::move(software)),
+        public_key_(std::move(public_key)),
+        sig_hash_(sig_hash),
+        engine_(std::move(engine)),
+        session_(std::move(session)) {}
+
+  // Returns the EMSA-PKCS1-v1_5 encoding of the digest of 'data', which
+  // the engine turns into the signature.
+  crypto::tink::util::StatusOr<std::string> EncodeMessage(
+      absl::string_view data) const;
+
+  // Returns true if the public key operation turns 'signature' back into
+  // 'encoded_message'.
+  bool Verify(absl::string_view encoded_message,
+              absl::string_view signature) const;
+
+  const std::unique_ptr<PublicKeySign> software_;
+  const bssl::UniquePtr<RSA> public_key_;
+  const EVP_MD* const sig_hash_;  // Owned by BoringSSL.
+  // The engine is kept alive as long as a session with it exists.
+  const std::shared_ptr<OffloadEngine> engine_;
+  const std::unique_ptr<OffloadEngine::RsaSession> session_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_OFFLOAD_RSA_SSA_PKCS1_SIGN_H_
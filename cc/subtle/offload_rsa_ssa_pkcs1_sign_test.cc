@@ -0,0 +1,214 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/offload_rsa_ssa_pkcs1_sign.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "openssl/base.h"
+#include "openssl/bn.h"
+#include "openssl/rsa.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/rsa_ssa_pkcs1_verify_boringssl.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::ElementsAre;
+
+// Computes the raw private key operation with BoringSSL on the submitting
+// thread.
+class FakeEngine : public OffloadEngine {
+ public:
+  enum class Mode { kWorking, kUnavailable, kFaulty };
+
+  struct Stats {
+    int operations = 0;
+    std::vector<int> batch_sizes;
+  };
+
+  class Session : public RsaSession {
+   public:
+    Session(bssl::UniquePtr<RSA> rsa, Mode mode, Stats* stats)
+        : rsa_(std::move(rsa)), mode_(mode), stats_(stats) {}
+
+    void Submit(std::vector<RsaOperation> batch) const override {
+      stats_->batch_sizes.push_back(batch.size());
+      for (const RsaOperation& operation : batch) {
+        if (mode_ == Mode::kUnavailable) {
+          operation.done(
+              util::Status(util::error::RESOURCE_EXHAUSTED, "queue is full"));
+          continue;
+        }
+        stats_->operations++;
+        size_t written;
+        RSA_sign_raw(rsa_.get(), &written,
+                     reinterpret_cast<uint8_t*>(operation.output.data()),
+                     operation.output.size(),
+                     reinterpret_cast<const uint8_t*>(operation.input.data()),
+                     operation.input.size(), RSA_NO_PADDING);
+        if (mode_ == Mode::kFaulty) operation.output[0] ^= 1;
+        operation.done(util::Status::OK);
+      }
+    }
+
+   private:
+    const bssl::UniquePtr<RSA> rsa_;
+    const Mode mode_;
+    Stats* const stats_;
+  };
+
+  FakeEngine(Mode mode, Stats* stats) : mode_(mode), stats_(stats) {}
+
+  absl::string_view name() const override { return "fake"; }
+
+  util::StatusOr<std::unique_ptr<AesGcmSession>> NewAesGcmSession(
+      const util::SecretData& key) const override {
+    return util::Status(util::error::UNIMPLEMENTED, "no AES-GCM");
+  }
+
+  util::StatusOr<std::unique_ptr<RsaSession>> NewRsaSession(
+      const SubtleUtilBoringSSL::RsaPrivateKey& key) const override {
+    auto rsa = SubtleUtilBoringSSL::BoringSslRsaFromRsaPrivateKey(key);
+    if (!rsa.ok()) return rsa.status();
+    return {absl::make_unique<Session>(std::move(rsa).ValueOrDie(), mode_,
+                                       stats_)};
+  }
+
+ private:
+  const Mode mode_;
+  Stats* const stats_;
+};
+
+class OffloadRsaSsaPkcs1SignTest : public ::testing::Test {
+ public:
+  OffloadRsaSsaPkcs1SignTest() : rsa_f4_(BN_new()) {
+    EXPECT_TRUE(BN_set_u64(rsa_f4_.get(), RSA_F4));
+    EXPECT_THAT(SubtleUtilBoringSSL::GetNewRsaKeyPair(
+                    2048, rsa_f4_.get(), &private_key_, &public_key_),
+                IsOk());
+  }
+
+ protected:
+  std::unique_ptr<PublicKeySign> NewSigner(FakeEngine::Mode mode) {
+    auto signer_result = OffloadRsaSsaPkcs1Sign::New(
+        private_key_, params_, std::make_shared<FakeEngine>(mode, &stats_));
+    EXPECT_THAT(signer_result.status(), IsOk());
+    return std::move(signer_result.ValueOrDie());
+  }
+
+  void ExpectValid(absl::string_view signature, absl::string_view data) {
+    auto verifier_result =
+        RsaSsaPkcs1VerifyBoringSsl::New(public_key_, params_);
+    ASSERT_THAT(verifier_result.status(), IsOk());
+    EXPECT_THAT(verifier_result.ValueOrDie()->Verify(signature, data),
+                IsOk());
+  }
+
+  bssl::UniquePtr<BIGNUM> rsa_f4_;
+  SubtleUtilBoringSSL::RsaPrivateKey private_key_;
+  SubtleUtilBoringSSL::RsaPublicKey public_key_;
+  SubtleUtilBoringSSL::RsaSsaPkcs1Params params_{
+      /*hash_type=*/HashType::SHA256};
+  FakeEngine::Stats stats_;
+};
+
+TEST_F(OffloadRsaSsaPkcs1SignTest, SignsOnTheEngine) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+  std::unique_ptr<PublicKeySign> signer =
+      NewSigner(FakeEngine::Mode::kWorking);
+  auto signature = signer->Sign("data");
+  ASSERT_THAT(signature.status(), IsOk());
+  ExpectValid(signature.ValueOrDie(), "data");
+  EXPECT_EQ(1, stats_.operations);
+}
+
+TEST_F(OffloadRsaSsaPkcs1SignTest, SignBatchSubmitsOneBatch) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+  std::unique_ptr<PublicKeySign> signer =
+      NewSigner(FakeEngine::Mode::kWorking);
+  std::vector<absl::string_view> data = {"a", "b", "", "d"};
+  auto signatures = signer->SignBatch(data);
+  ASSERT_THAT(signatures.status(), IsOk());
+  ASSERT_EQ(data.size(), signatures.ValueOrDie().size());
+  for (size_t i = 0; i < data.size(); i++) {
+    ExpectValid(signatures.ValueOrDie()[i], data[i]);
+  }
+  EXPECT_THAT(stats_.batch_sizes, ElementsAre(4));
+}
+
+TEST_F(OffloadRsaSsaPkcs1SignTest, UnavailableEngineFallsBackToSoftware) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+  std::unique_ptr<PublicKeySign> signer =
+      NewSigner(FakeEngine::Mode::kUnavailable);
+  auto signature = signer->Sign("data");
+  ASSERT_THAT(signature.status(), IsOk());
+  ExpectValid(signature.ValueOrDie(), "data");
+  EXPECT_EQ(0, stats_.operations);
+}
+
+TEST_F(OffloadRsaSsaPkcs1SignTest, FaultySignaturesAreNotReturned) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+  std::unique_ptr<PublicKeySign> signer = NewSigner(FakeEngine::Mode::kFaulty);
+  auto signature = signer->Sign("data");
+  ASSERT_THAT(signature.status(), IsOk());
+  ExpectValid(signature.ValueOrDie(), "data");
+  EXPECT_EQ(1, stats_.operations);
+}
+
+TEST_F(OffloadRsaSsaPkcs1SignTest, InvalidArguments) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+  EXPECT_THAT(
+      OffloadRsaSsaPkcs1Sign::New(private_key_, params_, nullptr).status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+  SubtleUtilBoringSSL::RsaSsaPkcs1Params sha1_params{
+      /*hash_type=*/HashType::SHA1};
+  EXPECT_THAT(
+      OffloadRsaSsaPkcs1Sign::New(
+          private_key_, sha1_params,
+          std::make_shared<FakeEngine>(FakeEngine::Mode::kWorking, &stats_))
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
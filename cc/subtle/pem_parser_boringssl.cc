@@ -23,6 +23,7 @@
 #include "openssl/base.h"
 #include "openssl/bio.h"
 #include "openssl/bn.h"
+#include "openssl/ec.h"
 #include "openssl/evp.h"
 #include "openssl/pem.h"
 #include "openssl/rsa.h"
@@ -155,6 +156,27 @@ util::StatusOr<std::string> ConvertBioToString(BIO* bio) {
 // static.
 util::StatusOr<std::unique_ptr<SubtleUtilBoringSSL::RsaPublicKey>>
 PemParser::ParseRsaPublicKey(absl::string_view pem_serialized_key) {
+  auto rsa_key_result = ParseRsaPublicKeyToBoringSsl(pem_serialized_key);
+  if (!rsa_key_result.ok()) return rsa_key_result.status();
+
+  // We are only interested in e and n.
+  const BIGNUM *n_bn, *e_bn;
+  RSA_get0_key(rsa_key_result.ValueOrDie().get(), &n_bn, &e_bn,
+               /*out_d=*/nullptr);
+  auto n_str_statusor = SubtleUtilBoringSSL::bn2str(n_bn, BN_num_bytes(n_bn));
+  auto e_str_statusor = SubtleUtilBoringSSL::bn2str(e_bn, BN_num_bytes(e_bn));
+  if (!n_str_statusor.ok()) return n_str_statusor.status();
+  if (!e_str_statusor.ok()) return e_str_statusor.status();
+  auto rsa_public_key = absl::make_unique<SubtleUtilBoringSSL::RsaPublicKey>();
+  rsa_public_key->e = std::move(e_str_statusor.ValueOrDie());
+  rsa_public_key->n = std::move(n_str_statusor.ValueOrDie());
+
+  return rsa_public_key;
+}
+
+// static.
+util::StatusOr<bssl::UniquePtr<RSA>> PemParser::ParseRsaPublicKeyToBoringSsl(
+    absl::string_view pem_serialized_key) {
   // Read the RSA key into EVP_PKEY.
   bssl::UniquePtr<BIO> rsa_key_bio(BIO_new(BIO_s_mem()));
   BIO_write(rsa_key_bio.get(), pem_serialized_key.data(),
@@ -167,33 +189,20 @@ PemParser::ParseRsaPublicKey(absl::string_view pem_serialized_key) {
     return util::Status(util::error::INVALID_ARGUMENT,
                         "PEM Public Key parsing failed");
   }
-  // No need to free bssl_rsa_key after use.
-  RSA *bssl_rsa_key = EVP_PKEY_get0_RSA(evp_rsa_key.get());
-  auto is_valid = VerifyRsaKey(bssl_rsa_key);
+  bssl::UniquePtr<RSA> rsa_key(EVP_PKEY_get1_RSA(evp_rsa_key.get()));
+  auto is_valid = VerifyRsaKey(rsa_key.get());
   if (!is_valid.ok()) {
     return is_valid;
   }
 
-  // Get the public key paramters.
-  const BIGNUM *n_bn, *e_bn, *d_bn;
-  RSA_get0_key(bssl_rsa_key, &n_bn, &e_bn, &d_bn);
-
-  // Public key should not have d_bn set.
+  // Public key should not have d set.
+  const BIGNUM *d_bn;
+  RSA_get0_key(rsa_key.get(), /*out_n=*/nullptr, /*out_e=*/nullptr, &d_bn);
   if (d_bn != nullptr) {
     return util::Status(util::error::INVALID_ARGUMENT,
                         "Invalid RSA Public Key format");
   }
-
-  // We are only interested in e and n.
-  auto n_str_statusor = SubtleUtilBoringSSL::bn2str(n_bn, BN_num_bytes(n_bn));
-  auto e_str_statusor = SubtleUtilBoringSSL::bn2str(e_bn, BN_num_bytes(e_bn));
-  if (!n_str_statusor.ok()) return n_str_statusor.status();
-  if (!e_str_statusor.ok()) return e_str_statusor.status();
-  auto rsa_public_key = absl::make_unique<SubtleUtilBoringSSL::RsaPublicKey>();
-  rsa_public_key->e = std::move(e_str_statusor.ValueOrDie());
-  rsa_public_key->n = std::move(n_str_statusor.ValueOrDie());
-
-  return rsa_public_key;
+  return std::move(rsa_key);
 }
 
 // static.
@@ -315,6 +324,39 @@ PemParser::ParseEcPublicKey(absl::string_view pem_serialized_key) {
                       "PEM EC Public Key parsing is unimplemented");
 }
 
+util::StatusOr<bssl::UniquePtr<EC_KEY>> PemParser::ParseEcPublicKeyToBoringSsl(
+    absl::string_view pem_serialized_key) {
+  bssl::UniquePtr<BIO> ec_key_bio(BIO_new(BIO_s_mem()));
+  BIO_write(ec_key_bio.get(), pem_serialized_key.data(),
+            pem_serialized_key.size());
+
+  bssl::UniquePtr<EVP_PKEY> evp_ec_key(PEM_read_bio_PUBKEY(
+      ec_key_bio.get(), /*x=*/nullptr, /*cb=*/nullptr, /*u=*/nullptr));
+  if (evp_ec_key == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "PEM Public Key parsing failed");
+  }
+  bssl::UniquePtr<EC_KEY> ec_key(EVP_PKEY_get1_EC_KEY(evp_ec_key.get()));
+  if (ec_key == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid EC key format");
+  }
+  switch (EC_GROUP_get_curve_name(EC_KEY_get0_group(ec_key.get()))) {
+    case NID_X9_62_prime256v1:
+    case NID_secp384r1:
+    case NID_secp521r1:
+      break;
+    default:
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Unsupported EC curve");
+  }
+  if (EC_KEY_check_key(ec_key.get()) != kBsslOk) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid EC key format");
+  }
+  return std::move(ec_key);
+}
+
 util::StatusOr<std::unique_ptr<SubtleUtilBoringSSL::EcKey>>
 PemParser::ParseEcPrivateKey(absl::string_view pem_serialized_key) {
   return util::Status(util::error::UNIMPLEMENTED,
@@ -17,6 +17,9 @@
 #define TINK_SUBTLE_PEM_PARSER_BORINGSSL_H_
 
 #include "absl/strings/string_view.h"
+#include "openssl/base.h"
+#include "openssl/ec.h"
+#include "openssl/rsa.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/statusor.h"
 
@@ -33,6 +36,12 @@ class PemParser {
   static util::StatusOr<std::unique_ptr<SubtleUtilBoringSSL::RsaPublicKey>>
   ParseRsaPublicKey(absl::string_view pem_serialized_key);
 
+  // Like ParseRsaPublicKey(), but returns the BoringSSL key, which callers
+  // such as RsaSsaPssVerifyBoringSsl can use as is, instead of converting
+  // the key to a SubtleUtilBoringSSL::RsaPublicKey and back.
+  static util::StatusOr<bssl::UniquePtr<RSA>> ParseRsaPublicKeyToBoringSsl(
+      absl::string_view pem_serialized_key);
+
   // Parses a given PEM serialized RSA private key `pem_serialized_key` into a
   // SubtleUtilBoringSSL::RsaPublicKey.
   static util::StatusOr<std::unique_ptr<SubtleUtilBoringSSL::RsaPrivateKey>>
@@ -53,6 +62,11 @@ class PemParser {
   static util::StatusOr<std::unique_ptr<SubtleUtilBoringSSL::EcKey>>
   ParseEcPublicKey(absl::string_view pem_serialized_key);
 
+  // Parses a given PEM serialized EC public key `pem_serialized_key` on one
+  // of the NIST curves P-256, P-384 and P-521 into a BoringSSL key.
+  static util::StatusOr<bssl::UniquePtr<EC_KEY>> ParseEcPublicKeyToBoringSsl(
+      absl::string_view pem_serialized_key);
+
   // Parses a given PEM serialized EC private key `pem_serialized_key` into a
   // SubtleUtilBoringSSL::EcKey.
   static util::StatusOr<std::unique_ptr<SubtleUtilBoringSSL::EcKey>>
@@ -0,0 +1,216 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/prf/aes_cmac_prf.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/base.h"
+#include "openssl/cipher.h"
+#include "openssl/mem.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+// Returns the doubling of 'block' in GF(2^128), as in RFC 4493, Section 2.3.
+util::SecretData Double(const util::SecretData& block) {
+  util::SecretData result(block.size());
+  for (size_t i = 0; i < block.size(); i++) {
+    uint8_t next = i + 1 < block.size() ? block[i + 1] : 0;
+    result[i] = (block[i] << 1) | (next >> 7);
+  }
+  if (block[0] & 0x80) result[block.size() - 1] ^= 0x87;
+  return result;
+}
+
+// Encrypts 'count' consecutive blocks at 'blocks' in place.
+util::Status EncryptBlocks(EVP_CIPHER_CTX* ctx, uint8_t* blocks, int count) {
+  int len;
+  if (!EVP_EncryptUpdate(ctx, blocks, &len, blocks, count * 16) ||
+      len != count * 16) {
+    return util::Status(util::error::INTERNAL, "AES encryption failed");
+  }
+  return util::OkStatus();
+}
+
+}  // namespace
+
+// static
+crypto::tink::util::StatusOr<std::unique_ptr<Prf>> AesCmacPrf::New(
+    const util::SecretData& key_value) {
+  auto status = CheckFipsCompatibility<AesCmacPrf>();
+  if (!status.ok()) return status;
+
+  const EVP_CIPHER* cipher;
+  switch (key_value.size()) {
+    case 16:
+      cipher = EVP_aes_128_ecb();
+      break;
+    case 32:
+      cipher = EVP_aes_256_ecb();
+      break;
+    default:
+      return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
+  }
+  bssl::UniquePtr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new());
+  if (ctx == nullptr ||
+      !EVP_EncryptInit_ex(ctx.get(), cipher, nullptr /* engine */,
+                          key_value.data(), nullptr /* iv */) ||
+      !EVP_CIPHER_CTX_set_padding(ctx.get(), 0)) {
+    return util::Status(util::error::INTERNAL,
+                        "could not initialize AES context");
+  }
+
+  // L = AES(K, 0^128), K1 = 2 * L, K2 = 2 * K1.
+  util::SecretData l(kBlockSize, 0);
+  bssl::ScopedEVP_CIPHER_CTX l_ctx;
+  if (!EVP_CIPHER_CTX_copy(l_ctx.get(), ctx.get())) {
+    return util::Status(util::error::INTERNAL, "EVP_CIPHER_CTX_copy failed");
+  }
+  status = EncryptBlocks(l_ctx.get(), l.data(), 1);
+  if (!status.ok()) return status;
+  util::SecretData k1 = Double(l);
+  util::SecretData k2 = Double(k1);
+  return {absl::WrapUnique(
+      new AesCmacPrf(std::move(ctx), std::move(k1), std::move(k2)))};
+}
+
+crypto::tink::util::Status AesCmacPrf::CheckOutputLength(
+    size_t output_length) const {
+  if (output_length > kMaxOutputLength) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("PRF only supports outputs up to ", kMaxOutputLength,
+                     " bytes, but ", output_length, " bytes were requested"));
+  }
+  return util::OkStatus();
+}
+
+crypto::tink::util::Status AesCmacPrf::ComputeLanes(
+    EVP_CIPHER_CTX* ctx, absl::Span<const absl::string_view> inputs,
+    size_t output_length, uint8_t* out) const {
+  // The chaining value of each input, and the blocks to be encrypted in the
+  // current round, packed for a single AES call.
+  uint8_t state[kLanes][kBlockSize] = {};
+  uint8_t blocks[kLanes * kBlockSize];
+  int active[kLanes];
+  size_t num_blocks[kLanes];
+  size_t max_blocks = 0;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    // The empty message is padded to a single block.
+    num_blocks[i] =
+        std::max<size_t>(1, (inputs[i].size() + kBlockSize - 1) / kBlockSize);
+    max_blocks = std::max(max_blocks, num_blocks[i]);
+  }
+
+  util::Status status;
+  for (size_t round = 0; round < max_blocks && status.ok(); round++) {
+    int count = 0;
+    for (size_t i = 0; i < inputs.size(); i++) {
+      if (round >= num_blocks[i]) continue;
+      uint8_t* block = &blocks[count * kBlockSize];
+      const uint8_t* data =
+          reinterpret_cast<const uint8_t*>(inputs[i].data()) +
+          round * kBlockSize;
+      if (round + 1 < num_blocks[i]) {
+        for (size_t j = 0; j < kBlockSize; j++) {
+          block[j] = state[i][j] ^ data[j];
+        }
+      } else {
+        // The last block is XORed with K1 if it is complete, and padded with
+        // 10...0 and XORed with K2 otherwise.
+        size_t remaining = inputs[i].size() - round * kBlockSize;
+        const uint8_t* subkey =
+            remaining == kBlockSize ? k1_.data() : k2_.data();
+        for (size_t j = 0; j < kBlockSize; j++) {
+          uint8_t m = j < remaining ? data[j] : (j == remaining ? 0x80 : 0);
+          block[j] = state[i][j] ^ m ^ subkey[j];
+        }
+      }
+      active[count++] = i;
+    }
+    status = EncryptBlocks(ctx, blocks, count);
+    for (int k = 0; k < count && status.ok(); k++) {
+      memcpy(state[active[k]], &blocks[k * kBlockSize], kBlockSize);
+    }
+  }
+  if (status.ok()) {
+    for (size_t i = 0; i < inputs.size(); i++) {
+      memcpy(out + i * output_length, state[i], output_length);
+    }
+  }
+  OPENSSL_cleanse(state, sizeof(state));
+  OPENSSL_cleanse(blocks, sizeof(blocks));
+  return status;
+}
+
+crypto::tink::util::StatusOr<std::string> AesCmacPrf::Compute(
+    absl::string_view input, size_t output_length) const {
+  auto status = CheckOutputLength(output_length);
+  if (!status.ok()) return status;
+  bssl::ScopedEVP_CIPHER_CTX ctx;
+  if (!EVP_CIPHER_CTX_copy(ctx.get(), ecb_context_.get())) {
+    return util::Status(util::error::INTERNAL, "EVP_CIPHER_CTX_copy failed");
+  }
+  std::string output;
+  ResizeStringUninitialized(&output, output_length);
+  status = ComputeLanes(ctx.get(), absl::MakeConstSpan(&input, 1),
+                        output_length,
+                        reinterpret_cast<uint8_t*>(&output[0]));
+  if (!status.ok()) return status;
+  return output;
+}
+
+crypto::tink::util::Status AesCmacPrf::ComputeBatch(
+    absl::Span<const absl::string_view> inputs, size_t output_length,
+    absl::Span<uint8_t> out) const {
+  auto status = CheckOutputLength(output_length);
+  if (!status.ok()) return status;
+  if (out.size() != inputs.size() * output_length) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("Output buffer has ", out.size(), " bytes, but ",
+                     inputs.size() * output_length, " bytes are needed"));
+  }
+  bssl::ScopedEVP_CIPHER_CTX ctx;
+  if (!EVP_CIPHER_CTX_copy(ctx.get(), ecb_context_.get())) {
+    return util::Status(util::error::INTERNAL, "EVP_CIPHER_CTX_copy failed");
+  }
+  for (size_t i = 0; i < inputs.size(); i += kLanes) {
+    status = ComputeLanes(ctx.get(), inputs.subspan(i, kLanes), output_length,
+                          out.data() + i * output_length);
+    if (!status.ok()) return status;
+  }
+  return util::OkStatus();
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,97 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_PRF_AES_CMAC_PRF_H_
+#define TINK_SUBTLE_PRF_AES_CMAC_PRF_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/base.h"
+#include "openssl/cipher.h"
+#include "tink/config/tink_fips.h"
+#include "tink/prf/prf_set.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// AES-CMAC (RFC 4493) as a Prf.  The output is the same as that of
+// StatefulCmacBoringSsl with the same key, truncated to the requested length.
+//
+// ComputeBatch() interleaves the CMAC chains of up to kLanes inputs: in each
+// round it XORs the next message block of every unfinished input into that
+// input's chaining value, and encrypts all of them with a single AES-ECB
+// call.  The blocks of one chain depend on each other, but those of
+// different chains do not, so the AES implementation can pipeline them.
+class AesCmacPrf : public Prf {
+ public:
+  static constexpr size_t kMaxOutputLength = 16;
+  // The number of inputs whose CMAC chains are computed together.
+  static constexpr int kLanes = 8;
+
+  // Key must be 16 or 32 bytes, all other sizes will be rejected.
+  static crypto::tink::util::StatusOr<std::unique_ptr<Prf>> New(
+      const util::SecretData& key_value);
+
+  // Returns the first 'output_length' bytes of AES-CMAC(key, input), which
+  // is at most kMaxOutputLength.
+  crypto::tink::util::StatusOr<std::string> Compute(
+      absl::string_view input, size_t output_length) const override;
+
+  crypto::tink::util::Status ComputeBatch(
+      absl::Span<const absl::string_view> inputs, size_t output_length,
+      absl::Span<uint8_t> out) const override;
+
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kNotFips;
+
+ private:
+  static constexpr size_t kBlockSize = 16;
+
+  AesCmacPrf(bssl::UniquePtr<EVP_CIPHER_CTX> ecb_context,
+             util::SecretData k1, util::SecretData k2)
+      : ecb_context_(std::move(ecb_context)),
+        k1_(std::move(k1)),
+        k2_(std::move(k2)) {}
+
+  crypto::tink::util::Status CheckOutputLength(size_t output_length) const;
+  // Computes the CMAC of at most kLanes 'inputs' with 'ctx', a copy of
+  // ecb_context_, and writes the first 'output_length' bytes of the i-th tag
+  // to out + i * output_length.
+  crypto::tink::util::Status ComputeLanes(
+      EVP_CIPHER_CTX* ctx, absl::Span<const absl::string_view> inputs,
+      size_t output_length, uint8_t* out) const;
+
+  // An AES-ECB encryption context with the key, without padding.  It is
+  // never modified; computations run on copies of it.
+  const bssl::UniquePtr<EVP_CIPHER_CTX> ecb_context_;
+  // The CMAC subkeys, as in RFC 4493, Section 2.3.
+  const util::SecretData k1_;
+  const util::SecretData k2_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_PRF_AES_CMAC_PRF_H_
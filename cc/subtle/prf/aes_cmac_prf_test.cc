@@ -0,0 +1,148 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/prf/aes_cmac_prf.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/stateful_cmac_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+using ::crypto::tink::test::HexDecodeOrDie;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+
+std::string BatchOutput(const Prf& prf, const std::vector<std::string>& inputs,
+                        size_t output_length) {
+  std::vector<absl::string_view> views(inputs.begin(), inputs.end());
+  std::string out(inputs.size() * output_length, '\0');
+  EXPECT_THAT(
+      prf.ComputeBatch(views, output_length,
+                       absl::MakeSpan(reinterpret_cast<uint8_t*>(&out[0]),
+                                      out.size())),
+      IsOk());
+  return out;
+}
+
+TEST(AesCmacPrfTest, Rfc4493TestVectors) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  // https://tools.ietf.org/html/rfc4493#section-4
+  util::SecretData key = util::SecretDataFromStringView(
+      HexDecodeOrDie("2b7e151628aed2a6abf7158809cf4f3c"));
+  std::string message = HexDecodeOrDie(
+      "6bc1bee22e409f96e93d7e117393172a"
+      "ae2d8a571e03ac9c9eb76fac45af8e51"
+      "30c81c46a35ce411e5fbc1191a0a52ef"
+      "f69f2445df4f9b17ad2b417be66c3710");
+  std::vector<std::string> inputs = {"", message.substr(0, 16),
+                                     message.substr(0, 40), message};
+  std::vector<std::string> tags = {
+      HexDecodeOrDie("bb1d6929e95937287fa37d129b756746"),
+      HexDecodeOrDie("070a16b46b4d4144f79bdd9dd04a287c"),
+      HexDecodeOrDie("dfa66747de9ae63030ca32611497c827"),
+      HexDecodeOrDie("51f0bebf7e3b9d92fc49741779363cfe")};
+
+  auto prf_or = AesCmacPrf::New(key);
+  ASSERT_THAT(prf_or.status(), IsOk());
+  const Prf& prf = *prf_or.ValueOrDie();
+  for (int i = 0; i < inputs.size(); i++) {
+    auto result_or = prf.Compute(inputs[i], 16);
+    ASSERT_THAT(result_or.status(), IsOk());
+    EXPECT_THAT(result_or.ValueOrDie(), Eq(tags[i]));
+  }
+  EXPECT_THAT(BatchOutput(prf, inputs, 16),
+              Eq(absl::StrCat(tags[0], tags[1], tags[2], tags[3])));
+}
+
+TEST(AesCmacPrfTest, SameAsStatefulCmac) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  // More inputs than lanes, of different lengths, so that chains of
+  // different lengths are interleaved.
+  std::vector<std::string> inputs;
+  for (int size = 0; size <= 3 * AesCmacPrf::kLanes; size++) {
+    inputs.push_back(Random::GetRandomBytes(size * 7));
+  }
+  for (int key_size : {16, 32}) {
+    for (int output_length : {0, 1, 10, 16}) {
+      SCOPED_TRACE(absl::StrCat("key_size = ", key_size,
+                                ", output_length = ", output_length));
+      util::SecretData key = Random::GetRandomKeyBytes(key_size);
+      auto prf_or = AesCmacPrf::New(key);
+      ASSERT_THAT(prf_or.status(), IsOk());
+      std::string expected;
+      for (const std::string& input : inputs) {
+        auto cmac_or = StatefulCmacBoringSsl::New(output_length, key);
+        ASSERT_THAT(cmac_or.status(), IsOk());
+        ASSERT_THAT(cmac_or.ValueOrDie()->Update(input), IsOk());
+        auto tag_or = cmac_or.ValueOrDie()->Finalize();
+        ASSERT_THAT(tag_or.status(), IsOk());
+        auto result_or = prf_or.ValueOrDie()->Compute(input, output_length);
+        ASSERT_THAT(result_or.status(), IsOk());
+        EXPECT_THAT(result_or.ValueOrDie(), Eq(tag_or.ValueOrDie()));
+        expected += tag_or.ValueOrDie();
+      }
+      EXPECT_THAT(BatchOutput(*prf_or.ValueOrDie(), inputs, output_length),
+                  Eq(expected));
+    }
+  }
+}
+
+TEST(AesCmacPrfTest, InvalidParameters) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  EXPECT_THAT(AesCmacPrf::New(Random::GetRandomKeyBytes(24)).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+
+  auto prf_or = AesCmacPrf::New(Random::GetRandomKeyBytes(32));
+  ASSERT_THAT(prf_or.status(), IsOk());
+  const Prf& prf = *prf_or.ValueOrDie();
+  EXPECT_THAT(prf.Compute("input", 17).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  std::vector<absl::string_view> inputs = {"a", "b"};
+  std::vector<uint8_t> out(2 * 17);
+  EXPECT_THAT(prf.ComputeBatch(inputs, 17, absl::MakeSpan(out)),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  out.resize(2 * 16 + 1);
+  EXPECT_THAT(prf.ComputeBatch(inputs, 16, absl::MakeSpan(out)),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
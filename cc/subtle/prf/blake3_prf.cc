@@ -0,0 +1,53 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/prf/blake3_prf.h"
+
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/types/span.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// static
+util::StatusOr<std::unique_ptr<Prf>> Blake3Prf::New(
+    const util::SecretData& key) {
+  auto status = CheckFipsCompatibility<Blake3Prf>();
+  if (!status.ok()) return status;
+  if (key.size() != Blake3Hasher::kKeySizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
+  }
+  return {absl::WrapUnique(new Blake3Prf(key))};
+}
+
+util::StatusOr<std::string> Blake3Prf::Compute(absl::string_view input,
+                                               size_t output_length) const {
+  Blake3Hasher hasher = hasher_;
+  hasher.Update(input);
+  std::string output(output_length, '\0');
+  hasher.Finalize(
+      absl::MakeSpan(reinterpret_cast<uint8_t*>(&output[0]), output.size()));
+  return output;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,61 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_PRF_BLAKE3_PRF_H_
+#define TINK_SUBTLE_PRF_BLAKE3_PRF_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/config/tink_fips.h"
+#include "tink/prf/prf_set.h"
+#include "tink/subtle/blake3.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// BLAKE3 in keyed hash mode as a Prf. BLAKE3 has extendable output, so
+// Compute() supports any output length; the first 32 bytes are the same as
+// the tag of Blake3Mac with the same key.
+class Blake3Prf : public Prf {
+ public:
+  // 'key' must be 32 bytes long.
+  static crypto::tink::util::StatusOr<std::unique_ptr<Prf>> New(
+      const util::SecretData& key);
+
+  crypto::tink::util::StatusOr<std::string> Compute(
+      absl::string_view input, size_t output_length) const override;
+
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kNotFips;
+
+ private:
+  explicit Blake3Prf(const util::SecretData& key) : hasher_(key) {}
+
+  // A keyed hasher without data; each call works on a copy of it.
+  const Blake3Hasher hasher_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_PRF_BLAKE3_PRF_H_
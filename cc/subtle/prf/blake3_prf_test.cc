@@ -0,0 +1,93 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/prf/blake3_prf.h"
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/config/tink_fips.h"
+#include "tink/subtle/blake3_mac.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::HexEncode;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+using ::testing::SizeIs;
+
+class Blake3PrfTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (kUseOnlyFips) {
+      GTEST_SKIP() << "Not supported in FIPS-only mode";
+    }
+  }
+};
+
+// The keyed hash of the one byte input 0x00 in the official BLAKE3 test
+// vectors.
+TEST_F(Blake3PrfTest, TestVector) {
+  auto prf_or = Blake3Prf::New(
+      util::SecretDataFromStringView("whats the Elvish word for friend"));
+  ASSERT_THAT(prf_or.status(), IsOk());
+  auto output_or = prf_or.ValueOrDie()->Compute(std::string(1, '\0'), 32);
+  ASSERT_THAT(output_or.status(), IsOk());
+  EXPECT_THAT(
+      HexEncode(output_or.ValueOrDie()),
+      Eq("6d7878dfff2f485635d39013278ae14f1454b8c0a3a2d34bc1ab38228a80c95b"));
+}
+
+TEST_F(Blake3PrfTest, OutputLengths) {
+  auto prf = std::move(Blake3Prf::New(util::SecretData(32, 'k')).ValueOrDie());
+  std::string long_output = prf->Compute("input", 1000).ValueOrDie();
+  EXPECT_THAT(long_output, SizeIs(1000));
+  for (size_t length : {0, 1, 16, 32, 33, 64, 65, 999}) {
+    EXPECT_THAT(prf->Compute("input", length).ValueOrDie(),
+                Eq(long_output.substr(0, length)));
+  }
+  EXPECT_THAT(prf->Compute("other input", 32).ValueOrDie(),
+              testing::Ne(long_output.substr(0, 32)));
+}
+
+TEST_F(Blake3PrfTest, MatchesMac) {
+  const util::SecretData key(32, 'k');
+  auto prf = std::move(Blake3Prf::New(key).ValueOrDie());
+  auto mac = std::move(Blake3Mac::New(key, 32).ValueOrDie());
+  std::string data(3000, 'd');
+  EXPECT_THAT(prf->Compute(data, 32).ValueOrDie(),
+              Eq(mac->ComputeMac(data).ValueOrDie()));
+}
+
+TEST_F(Blake3PrfTest, InvalidKeySize) {
+  for (int key_size : {0, 16, 31, 33, 64}) {
+    EXPECT_THAT(Blake3Prf::New(util::SecretData(key_size, 'k')).status(),
+                StatusIs(util::error::INVALID_ARGUMENT));
+  }
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
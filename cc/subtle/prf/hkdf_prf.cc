@@ -0,0 +1,155 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/prf/hkdf_prf.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/base.h"
+#include "openssl/hkdf.h"
+#include "openssl/hmac.h"
+#include "openssl/mem.h"
+#include "tink/subtle/subtle_util.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// static
+crypto::tink::util::StatusOr<std::unique_ptr<Prf>> HkdfPrf::New(
+    HashType hash, const util::SecretData& secret, absl::string_view salt) {
+  auto status = CheckFipsCompatibility<HkdfPrf>();
+  if (!status.ok()) return status;
+
+  if (hash != SHA256 && hash != SHA512 && hash != SHA1) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("Hash ", hash, " not acceptable for HkdfPrf"));
+  }
+  if (secret.size() < 10) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Too short secret for HkdfPrf");
+  }
+  auto evp_md_or = SubtleUtilBoringSSL::EvpHash(hash);
+  if (!evp_md_or.ok()) {
+    return util::Status(util::error::UNIMPLEMENTED, "Unsupported hash");
+  }
+  const EVP_MD* digest = evp_md_or.ValueOrDie();
+
+  // PRK as by RFC 5869, Section 2.2
+  util::SecretData prk(EVP_MAX_MD_SIZE);
+  size_t prk_len;
+  if (1 != HKDF_extract(prk.data(), &prk_len, digest, secret.data(),
+                        secret.size(),
+                        reinterpret_cast<const uint8_t*>(salt.data()),
+                        salt.size())) {
+    return util::Status(util::error::INTERNAL, "BoringSSL's HKDF failed");
+  }
+  bssl::UniquePtr<HMAC_CTX> prk_context(HMAC_CTX_new());
+  if (prk_context == nullptr ||
+      !HMAC_Init_ex(prk_context.get(), prk.data(), prk_len, digest, nullptr)) {
+    return util::Status(util::error::INTERNAL,
+                        "BoringSSL's HMAC_Init_ex failed");
+  }
+  return {absl::WrapUnique(
+      new HkdfPrf(EVP_MD_size(digest), std::move(prk_context)))};
+}
+
+crypto::tink::util::Status HkdfPrf::CheckOutputLength(
+    size_t output_length) const {
+  if (output_length > 255 * digest_size_) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("HkdfPrf only supports outputs up to ", 255 * digest_size_,
+                     " bytes, but ", output_length, " bytes were requested"));
+  }
+  return util::OkStatus();
+}
+
+crypto::tink::util::Status HkdfPrf::Expand(HMAC_CTX* ctx,
+                                           absl::string_view input,
+                                           absl::Span<uint8_t> out) const {
+  // BoringSSL expects a non-null pointer for input,
+  // regardless of whether the size is 0.
+  input = SubtleUtilBoringSSL::EnsureNonNull(input);
+
+  // T(i) = HMAC-Hash(PRK, T(i-1) | info | i) as in RFC 5869, Section 2.3
+  uint8_t t[EVP_MAX_MD_SIZE];
+  for (size_t pos = 0, i = 1; pos < out.size(); pos += digest_size_, i++) {
+    uint8_t i_as_uint8 = i;
+    if (!HMAC_CTX_copy_ex(ctx, prk_context_.get()) ||
+        (i > 1 && !HMAC_Update(ctx, t, digest_size_)) ||
+        !HMAC_Update(ctx, reinterpret_cast<const uint8_t*>(input.data()),
+                     input.size()) ||
+        !HMAC_Update(ctx, &i_as_uint8, 1) || !HMAC_Final(ctx, t, nullptr)) {
+      OPENSSL_cleanse(t, sizeof(t));
+      return util::Status(util::error::INTERNAL,
+                          "BoringSSL failed to compute HMAC");
+    }
+    memcpy(&out[pos], t, std::min(digest_size_, out.size() - pos));
+  }
+  OPENSSL_cleanse(t, sizeof(t));
+  return util::OkStatus();
+}
+
+crypto::tink::util::StatusOr<std::string> HkdfPrf::Compute(
+    absl::string_view input, size_t output_length) const {
+  auto status = CheckOutputLength(output_length);
+  if (!status.ok()) return status;
+  std::string output;
+  ResizeStringUninitialized(&output, output_length);
+  bssl::ScopedHMAC_CTX ctx;
+  status = Expand(ctx.get(), input,
+                  absl::MakeSpan(reinterpret_cast<uint8_t*>(&output[0]),
+                                 output_length));
+  if (!status.ok()) return status;
+  return output;
+}
+
+crypto::tink::util::Status HkdfPrf::ComputeBatch(
+    absl::Span<const absl::string_view> inputs, size_t output_length,
+    absl::Span<uint8_t> out) const {
+  auto status = CheckOutputLength(output_length);
+  if (!status.ok()) return status;
+  if (out.size() != inputs.size() * output_length) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("Output buffer has ", out.size(), " bytes, but ",
+                     inputs.size() * output_length, " bytes are needed"));
+  }
+  bssl::ScopedHMAC_CTX ctx;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    status = Expand(ctx.get(), inputs[i],
+                    out.subspan(i * output_length, output_length));
+    if (!status.ok()) return status;
+  }
+  return util::OkStatus();
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
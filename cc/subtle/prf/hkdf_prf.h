@@ -0,0 +1,82 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_PRF_HKDF_PRF_H_
+#define TINK_SUBTLE_PRF_HKDF_PRF_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/base.h"
+#include "openssl/hmac.h"
+#include "tink/config/tink_fips.h"
+#include "tink/prf/prf_set.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// HKDF (RFC 5869) as a Prf, with the input as info.  The output is the same
+// as that of HkdfStreamingPrf with the same parameters, but Compute() runs
+// HKDF-Expand directly: the pseudorandom key is extracted once, in New(),
+// and each output block is computed on a copy of an HMAC context keyed with
+// it.
+class HkdfPrf : public Prf {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<Prf>> New(
+      HashType hash, const util::SecretData& secret, absl::string_view salt);
+
+  // Returns the first 'output_length' bytes of HKDF-Expand(PRK, input), which
+  // is at most 255 times the digest size.
+  crypto::tink::util::StatusOr<std::string> Compute(
+      absl::string_view input, size_t output_length) const override;
+
+  // Runs HKDF-Expand for all inputs on a single HMAC context, writing the
+  // outputs directly into 'out'.
+  crypto::tink::util::Status ComputeBatch(
+      absl::Span<const absl::string_view> inputs, size_t output_length,
+      absl::Span<uint8_t> out) const override;
+
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kNotFips;
+
+ private:
+  HkdfPrf(size_t digest_size, bssl::UniquePtr<HMAC_CTX> prk_context)
+      : digest_size_(digest_size), prk_context_(std::move(prk_context)) {}
+
+  crypto::tink::util::Status CheckOutputLength(size_t output_length) const;
+  // Writes HKDF-Expand(PRK, input) to 'out', using 'ctx' as scratch space.
+  crypto::tink::util::Status Expand(HMAC_CTX* ctx, absl::string_view input,
+                                    absl::Span<uint8_t> out) const;
+
+  const size_t digest_size_;
+  // An HMAC context keyed with the pseudorandom key.  It is never modified;
+  // each output block is computed on a copy of it.
+  const bssl::UniquePtr<HMAC_CTX> prk_context_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_PRF_HKDF_PRF_H_
@@ -0,0 +1,160 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/prf/hkdf_prf.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/subtle/prf/hkdf_streaming_prf.h"
+#include "tink/subtle/random.h"
+#include "tink/util/input_stream_util.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+using ::crypto::tink::test::HexDecodeOrDie;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+
+TEST(HkdfPrf, TestVector1) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  // https://tools.ietf.org/html/rfc5869#appendix-A.1
+  util::SecretData ikm = util::SecretDataFromStringView(
+      HexDecodeOrDie("0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b"));
+  std::string salt = HexDecodeOrDie("000102030405060708090a0b0c");
+  std::string info = HexDecodeOrDie("f0f1f2f3f4f5f6f7f8f9");
+  std::string expected_result = HexDecodeOrDie(
+      "3cb25f25faacd57a90434f64d0362f2a"
+      "2d2d0a90cf1a5a4c5db02d56ecc4c5bf"
+      "34007208d5b887185865");
+
+  auto prf_or = HkdfPrf::New(SHA256, ikm, salt);
+  ASSERT_THAT(prf_or.status(), IsOk());
+  auto result_or = prf_or.ValueOrDie()->Compute(info, expected_result.size());
+  ASSERT_THAT(result_or.status(), IsOk());
+  EXPECT_THAT(result_or.ValueOrDie(), Eq(expected_result));
+}
+
+TEST(HkdfPrf, SameOutputAsHkdfStreamingPrf) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  const std::vector<std::string> inputs = {"", "input",
+                                           std::string(1000, 'i')};
+  for (HashType hash : {SHA1, SHA256, SHA512}) {
+    for (std::string salt : {"", "salt"}) {
+      util::SecretData ikm = Random::GetRandomKeyBytes(32);
+      auto prf_or = HkdfPrf::New(hash, ikm, salt);
+      ASSERT_THAT(prf_or.status(), IsOk());
+      auto streaming_prf_or = HkdfStreamingPrf::New(hash, ikm, salt);
+      ASSERT_THAT(streaming_prf_or.status(), IsOk());
+      for (const std::string& input : inputs) {
+        for (int output_length : {0, 1, 16, 20, 32, 33, 64, 65, 1000}) {
+          SCOPED_TRACE(absl::StrCat("hash = ", hash, ", salt = ", salt,
+                                    ", input size = ", input.size(),
+                                    ", output_length = ", output_length));
+          auto result_or = prf_or.ValueOrDie()->Compute(input, output_length);
+          ASSERT_THAT(result_or.status(), IsOk());
+          std::unique_ptr<InputStream> stream =
+              streaming_prf_or.ValueOrDie()->ComputePrf(input);
+          auto expected_or = ReadBytesFromStream(output_length, stream.get());
+          ASSERT_THAT(expected_or.status(), IsOk());
+          EXPECT_THAT(result_or.ValueOrDie(), Eq(expected_or.ValueOrDie()));
+        }
+      }
+    }
+  }
+}
+
+TEST(HkdfPrf, MaxOutputLength) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto prf_or =
+      HkdfPrf::New(SHA512, util::SecretDataFromStringView("key0123456"), "");
+  ASSERT_THAT(prf_or.status(), IsOk());
+  const int max_output_length = 255 * (512 / 8);
+  auto result_or = prf_or.ValueOrDie()->Compute("input", max_output_length);
+  ASSERT_THAT(result_or.status(), IsOk());
+  EXPECT_THAT(result_or.ValueOrDie().size(), Eq(max_output_length));
+  EXPECT_THAT(
+      prf_or.ValueOrDie()->Compute("input", max_output_length + 1).status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(HkdfPrf, ComputeBatch) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  auto prf_or = HkdfPrf::New(
+      SHA256, util::SecretDataFromStringView("key0123456"), "salt");
+  ASSERT_THAT(prf_or.status(), IsOk());
+  const Prf& prf = *prf_or.ValueOrDie();
+  std::vector<std::string> inputs = {"", "a", Random::GetRandomBytes(100),
+                                     "input"};
+  std::vector<absl::string_view> views(inputs.begin(), inputs.end());
+  for (int output_length : {0, 16, 32, 33, 100}) {
+    SCOPED_TRACE(absl::StrCat("output_length = ", output_length));
+    std::vector<uint8_t> out(inputs.size() * output_length);
+    ASSERT_THAT(prf.ComputeBatch(views, output_length, absl::MakeSpan(out)),
+                IsOk());
+    for (int i = 0; i < inputs.size(); i++) {
+      auto result_or = prf.Compute(inputs[i], output_length);
+      ASSERT_THAT(result_or.status(), IsOk());
+      EXPECT_THAT(std::string(out.begin() + i * output_length,
+                              out.begin() + (i + 1) * output_length),
+                  Eq(result_or.ValueOrDie()));
+    }
+  }
+  std::vector<uint8_t> out(3 * 16);
+  EXPECT_THAT(prf.ComputeBatch(views, 16, absl::MakeSpan(out)),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(HkdfPrf, InvalidParameters) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  EXPECT_THAT(
+      HkdfPrf::New(SHA384, util::SecretDataFromStringView("key0123456"), "")
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(
+      HkdfPrf::New(SHA256, util::SecretDataFromStringView("short"), "")
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,165 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/prf/siphash_prf.h"
+
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "openssl/mem.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+uint64_t LoadLe64(const uint8_t* p) {
+  uint64_t value = 0;
+  for (int i = 7; i >= 0; i--) value = (value << 8) | p[i];
+  return value;
+}
+
+void StoreLe64(uint8_t* p, uint64_t value, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    p[i] = static_cast<uint8_t>(value);
+    value >>= 8;
+  }
+}
+
+inline uint64_t Rotl(uint64_t x, int bits) {
+  return (x << bits) | (x >> (64 - bits));
+}
+
+inline void SipRound(uint64_t& v0, uint64_t& v1, uint64_t& v2, uint64_t& v3) {
+  v0 += v1;
+  v1 = Rotl(v1, 13);
+  v1 ^= v0;
+  v0 = Rotl(v0, 32);
+  v2 += v3;
+  v3 = Rotl(v3, 16);
+  v3 ^= v2;
+  v0 += v3;
+  v3 = Rotl(v3, 21);
+  v3 ^= v0;
+  v2 += v1;
+  v1 = Rotl(v1, 17);
+  v1 ^= v2;
+  v2 = Rotl(v2, 32);
+}
+
+util::Status CheckOutputLength(size_t output_length) {
+  if (output_length > SipHashPrf::kMaxOutputLength) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("PRF only supports outputs up to ",
+                     SipHashPrf::kMaxOutputLength, " bytes"));
+  }
+  return util::OkStatus();
+}
+
+}  // namespace
+
+// static
+util::StatusOr<std::unique_ptr<Prf>> SipHashPrf::New(
+    const util::SecretData& key) {
+  auto status = CheckFipsCompatibility<SipHashPrf>();
+  if (!status.ok()) return status;
+  if (key.size() != kKeySizeInBytes) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
+  }
+  return {absl::WrapUnique(
+      new SipHashPrf(LoadLe64(key.data()), LoadLe64(key.data() + 8)))};
+}
+
+SipHashPrf::~SipHashPrf() {
+  OPENSSL_cleanse(&k0_, sizeof(k0_));
+  OPENSSL_cleanse(&k1_, sizeof(k1_));
+}
+
+uint64_t SipHashPrf::Hash(absl::string_view input) const {
+  uint64_t v0 = k0_ ^ 0x736f6d6570736575ULL;
+  uint64_t v1 = k1_ ^ 0x646f72616e646f6dULL;
+  uint64_t v2 = k0_ ^ 0x6c7967656e657261ULL;
+  uint64_t v3 = k1_ ^ 0x7465646279746573ULL;
+
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(input.data());
+  const size_t size = input.size();
+  const uint8_t* end = data + (size & ~static_cast<size_t>(7));
+  for (; data != end; data += 8) {
+    uint64_t m = LoadLe64(data);
+    v3 ^= m;
+    SipRound(v0, v1, v2, v3);
+    SipRound(v0, v1, v2, v3);
+    v0 ^= m;
+  }
+  // The last block holds the remaining bytes and the input length mod 256.
+  uint64_t b = static_cast<uint64_t>(size & 0xff) << 56;
+  for (int i = (size & 7) - 1; i >= 0; i--) {
+    b |= static_cast<uint64_t>(data[i]) << (8 * i);
+  }
+  v3 ^= b;
+  SipRound(v0, v1, v2, v3);
+  SipRound(v0, v1, v2, v3);
+  v0 ^= b;
+
+  v2 ^= 0xff;
+  SipRound(v0, v1, v2, v3);
+  SipRound(v0, v1, v2, v3);
+  SipRound(v0, v1, v2, v3);
+  SipRound(v0, v1, v2, v3);
+  return v0 ^ v1 ^ v2 ^ v3;
+}
+
+util::StatusOr<std::string> SipHashPrf::Compute(absl::string_view input,
+                                                size_t output_length) const {
+  auto status = CheckOutputLength(output_length);
+  if (!status.ok()) return status;
+  std::string output(output_length, '\0');
+  StoreLe64(reinterpret_cast<uint8_t*>(&output[0]), Hash(input),
+            output_length);
+  return output;
+}
+
+util::Status SipHashPrf::ComputeBatch(
+    absl::Span<const absl::string_view> inputs, size_t output_length,
+    absl::Span<uint8_t> out) const {
+  auto status = CheckOutputLength(output_length);
+  if (!status.ok()) return status;
+  if (out.size() != inputs.size() * output_length) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        absl::StrCat("Output buffer has ", out.size(), " bytes, but ",
+                     inputs.size() * output_length, " bytes are needed"));
+  }
+  uint8_t* next = out.data();
+  for (absl::string_view input : inputs) {
+    StoreLe64(next, Hash(input), output_length);
+    next += output_length;
+  }
+  return util::OkStatus();
+}
+
+util::StatusOr<uint64_t> SipHashPrf::Compute64(absl::string_view input) const {
+  return Hash(input);
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,83 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_PRF_SIPHASH_PRF_H_
+#define TINK_SUBTLE_PRF_SIPHASH_PRF_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/config/tink_fips.h"
+#include "tink/prf/prf_set.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// SipHash-2-4 (https://www.aumasson.jp/siphash/siphash.pdf) as a Prf.
+//
+// SipHash is built for short inputs: hashing 8 to 32 bytes takes a few
+// dozen cycles, without the fixed cost of a block cipher key schedule or a
+// hash function padding block. In exchange its output is only 64 bits, so
+// Compute() returns at most 8 bytes, and it should only be used where
+// collisions between outputs are acceptable, e.g. to key hash tables or to
+// choose shards. Compute64() returns the output without allocating.
+class SipHashPrf : public Prf {
+ public:
+  static constexpr size_t kKeySizeInBytes = 16;
+  static constexpr size_t kMaxOutputLength = 8;
+
+  static crypto::tink::util::StatusOr<std::unique_ptr<Prf>> New(
+      const util::SecretData& key);
+
+  ~SipHashPrf() override;
+
+  // Returns the first 'output_length' bytes of the little-endian encoding
+  // of the SipHash-2-4 of 'input'. 'output_length' must be at most
+  // kMaxOutputLength.
+  crypto::tink::util::StatusOr<std::string> Compute(
+      absl::string_view input, size_t output_length) const override;
+
+  crypto::tink::util::Status ComputeBatch(
+      absl::Span<const absl::string_view> inputs, size_t output_length,
+      absl::Span<uint8_t> out) const override;
+
+  crypto::tink::util::StatusOr<uint64_t> Compute64(
+      absl::string_view input) const override;
+
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kNotFips;
+
+ private:
+  SipHashPrf(uint64_t k0, uint64_t k1) : k0_(k0), k1_(k1) {}
+
+  uint64_t Hash(absl::string_view input) const;
+
+  uint64_t k0_;
+  uint64_t k1_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_PRF_SIPHASH_PRF_H_
@@ -0,0 +1,141 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/prf/siphash_prf.h"
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/types/span.h"
+#include "tink/config/tink_fips.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/test_matchers.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::HexEncode;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Eq;
+
+class SipHashPrfTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (kUseOnlyFips) {
+      GTEST_SKIP() << "Not supported in FIPS-only mode";
+    }
+  }
+
+  // The key 00 01 .. 0f of the test vectors of the reference implementation.
+  static util::SecretData Key() {
+    util::SecretData key(SipHashPrf::kKeySizeInBytes);
+    for (int i = 0; i < key.size(); i++) key[i] = i;
+    return key;
+  }
+
+  // The input 00 01 .. (size - 1) of the test vectors.
+  static std::string Input(int size) {
+    std::string input(size, '\0');
+    for (int i = 0; i < size; i++) input[i] = i;
+    return input;
+  }
+};
+
+struct TestVector {
+  int input_size;
+  uint64_t output;
+};
+
+TEST_F(SipHashPrfTest, ReferenceVectors) {
+  const std::vector<TestVector> test_vectors = {
+      {0, 0x726fdb47dd0e0e31ULL},  {1, 0x74f839c593dc67fdULL},
+      {7, 0xab0200f58b01d137ULL},  {8, 0x93f5f5799a932462ULL},
+      {15, 0xa129ca6149be45e5ULL}, {16, 0x3f2acc7f57c29bdbULL},
+      {63, 0x958a324ceb064572ULL},
+  };
+  auto prf = std::move(SipHashPrf::New(Key()).ValueOrDie());
+  for (const TestVector& test_vector : test_vectors) {
+    std::string input = Input(test_vector.input_size);
+    auto output_or = prf->Compute64(input);
+    ASSERT_THAT(output_or.status(), IsOk());
+    EXPECT_THAT(output_or.ValueOrDie(), Eq(test_vector.output))
+        << test_vector.input_size;
+  }
+  // The reference implementation writes the output little-endian.
+  EXPECT_THAT(HexEncode(prf->Compute(Input(0), 8).ValueOrDie()),
+              Eq("310e0edd47db6f72"));
+}
+
+TEST_F(SipHashPrfTest, OutputLengths) {
+  auto prf = std::move(SipHashPrf::New(Key()).ValueOrDie());
+  std::string output = prf->Compute("input", 8).ValueOrDie();
+  for (size_t length = 0; length <= 8; length++) {
+    auto output_or = prf->Compute("input", length);
+    ASSERT_THAT(output_or.status(), IsOk());
+    EXPECT_THAT(output_or.ValueOrDie(), Eq(output.substr(0, length)));
+  }
+  EXPECT_THAT(prf->Compute("input", 9).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(SipHashPrfTest, ComputeBatch) {
+  auto prf = std::move(SipHashPrf::New(Key()).ValueOrDie());
+  std::vector<absl::string_view> inputs = {"", "a", "0123456789abcdef",
+                                           "some longer input"};
+  std::string out(4 * 6, '\0');
+  ASSERT_THAT(prf->ComputeBatch(
+                  inputs, 6,
+                  absl::MakeSpan(reinterpret_cast<uint8_t*>(&out[0]),
+                                 out.size())),
+              IsOk());
+  for (int i = 0; i < inputs.size(); i++) {
+    EXPECT_THAT(out.substr(6 * i, 6),
+                Eq(prf->Compute(inputs[i], 6).ValueOrDie()));
+  }
+  EXPECT_THAT(prf->ComputeBatch(
+                  inputs, 5,
+                  absl::MakeSpan(reinterpret_cast<uint8_t*>(&out[0]),
+                                 out.size())),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(prf->ComputeBatch(inputs, 9, absl::Span<uint8_t>()),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(SipHashPrfTest, InvalidKeySize) {
+  for (int key_size : {0, 8, 15, 17, 32}) {
+    EXPECT_THAT(SipHashPrf::New(util::SecretData(key_size, 'k')).status(),
+                StatusIs(util::error::INVALID_ARGUMENT));
+  }
+}
+
+TEST(SipHashPrfFipsTest, NotFips) {
+  if (!kUseOnlyFips) {
+    GTEST_SKIP() << "Only supported in FIPS-only mode";
+  }
+  EXPECT_THAT(SipHashPrf::New(util::SecretData(16, 'k')).status(),
+              StatusIs(util::error::INTERNAL));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
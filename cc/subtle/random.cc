@@ -16,19 +16,37 @@
 
 #include "tink/subtle/random.h"
 
+#include <atomic>
+#include <cstdint>
 #include <cstring>
 #include <string>
 
+#include "absl/types/span.h"
+#include "openssl/mem.h"
 #include "openssl/rand.h"
+#include "tink/util/fork_hooks.h"
 
 namespace crypto {
 namespace tink {
 namespace subtle {
 
-// static
-std::string Random::GetRandomBytes(size_t length) {
-  std::unique_ptr<uint8_t[]> buf(new uint8_t[length]);
-  // BoringSSL documentation says that it always returns 1; while
+namespace {
+
+std::atomic<bool> buffering_enabled{false};
+
+struct RandomBuffer {
+  uint8_t bytes[Random::kBufferSize];
+  // The unused bytes are the last 'available' ones of 'bytes'.
+  size_t available = 0;
+  uint64_t generation = 0;
+
+  ~RandomBuffer() { OPENSSL_cleanse(bytes, sizeof(bytes)); }
+};
+
+// Fills 'out' with 'length' random bytes, from the buffer of this thread if
+// buffering is enabled and the request is small.
+void FillRandom(uint8_t* out, size_t length) {
+  // BoringSSL documentation says that RAND_bytes always returns 1; while
   // OpenSSL documentation says that it returns 1 on success, 0 otherwise. We
   // use BoringSSL, so we don't check the return value.
   //
@@ -38,13 +56,65 @@ std::string Random::GetRandomBytes(size_t length) {
   // until the system has collected at least 128 bits since boot. For old
   // kernels without getrandom support (and not in FIPS mode), it will resort to
   // /dev/urandom.
-  RAND_bytes(buf.get(), length);
-  return std::string(reinterpret_cast<const char *>(buf.get()), length);
+  if (length > Random::kMaxBufferedRequestSize ||
+      !buffering_enabled.load(std::memory_order_relaxed)) {
+    RAND_bytes(out, length);
+    return;
+  }
+  // Buffers are only filled once the fork handlers are in place, and the
+  // child of a fork() discards the buffers inherited from its parent.
+  if (!util::ForkHandlersInstalled()) {
+    RAND_bytes(out, length);
+    return;
+  }
+  thread_local RandomBuffer buffer;
+  uint64_t generation = util::ForkGeneration();
+  if (buffer.generation != generation) {
+    buffer.available = 0;
+    buffer.generation = generation;
+  }
+  if (buffer.available < length) {
+    RAND_bytes(buffer.bytes, sizeof(buffer.bytes));
+    buffer.available = sizeof(buffer.bytes);
+  }
+  uint8_t* next = buffer.bytes + sizeof(buffer.bytes) - buffer.available;
+  std::memcpy(out, next, length);
+  OPENSSL_cleanse(next, length);
+  buffer.available -= length;
+}
+
+}  // namespace
+
+constexpr size_t Random::kBufferSize;
+constexpr size_t Random::kMaxBufferedRequestSize;
+
+// static
+void Random::SetThreadLocalBuffering(bool enabled) {
+  buffering_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+// static
+std::string Random::GetRandomBytes(size_t length) {
+  std::string result(length, '\0');
+  if (length > 0) FillRandom(reinterpret_cast<uint8_t*>(&result[0]), length);
+  return result;
+}
+
+// static
+util::Status Random::GetRandomBytes(absl::Span<char> buffer) {
+  FillRandom(reinterpret_cast<uint8_t*>(buffer.data()), buffer.size());
+  return util::Status::OK;
+}
+
+// static
+util::Status Random::GetRandomBytes(absl::Span<uint8_t> buffer) {
+  FillRandom(buffer.data(), buffer.size());
+  return util::Status::OK;
 }
 
 uint32_t Random::GetRandomUInt32() {
   uint8_t buf[sizeof(uint32_t)];
-  RAND_bytes(buf, sizeof(uint32_t));
+  FillRandom(buf, sizeof(uint32_t));
   uint32_t result;
   std::memcpy(&result, buf, sizeof(uint32_t));
   return result;
@@ -52,7 +122,7 @@ uint32_t Random::GetRandomUInt32() {
 
 uint16_t Random::GetRandomUInt16() {
   uint8_t buf[sizeof(uint16_t)];
-  RAND_bytes(buf, sizeof(uint16_t));
+  FillRandom(buf, sizeof(uint16_t));
   uint16_t result;
   std::memcpy(&result, buf, sizeof(uint16_t));
   return result;
@@ -60,15 +130,13 @@ uint16_t Random::GetRandomUInt16() {
 
 uint8_t Random::GetRandomUInt8() {
   uint8_t result;
-  RAND_bytes(&result, 1);
+  FillRandom(&result, 1);
   return result;
 }
 
 util::SecretData Random::GetRandomKeyBytes(size_t length) {
   util::SecretData buf(length, 0);
-  // BoringSSL documentation says that it always returns 1; while
-  // OpenSSL documentation says that it returns 1 on success, 0 otherwise. We
-  // use BoringSSL, so we don't check the return value.
+  // See FillRandom() regarding the return value of RAND_bytes.
   RAND_bytes(buf.data(), buf.size());
   return buf;
 }
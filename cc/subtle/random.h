@@ -17,10 +17,14 @@
 #ifndef TINK_SUBTLE_RANDOM_H_
 #define TINK_SUBTLE_RANDOM_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 
+#include "absl/types/span.h"
 #include "tink/util/secret_data.h"
+#include "tink/util/status.h"
 
 namespace crypto {
 namespace tink {
@@ -30,11 +34,27 @@ class Random {
  public:
   // Returns a random string of desired length.
   static std::string GetRandomBytes(size_t length);
+  // Fills 'buffer' with random bytes.
+  static util::Status GetRandomBytes(absl::Span<char> buffer);
+  static util::Status GetRandomBytes(absl::Span<uint8_t> buffer);
   static uint32_t GetRandomUInt32();
   static uint16_t GetRandomUInt16();
   static uint8_t GetRandomUInt8();
   // Returns length bytes of random data stored in specialized key container.
+  // Key bytes are never served from the per-thread buffer.
   static util::SecretData GetRandomKeyBytes(size_t length);
+
+  // Enables or disables the per-thread buffering of random bytes.  When
+  // enabled, requests of up to kMaxBufferedRequestSize bytes (nonces, IVs,
+  // salts and random integers) are served from a buffer of each thread which
+  // is refilled kBufferSize bytes at a time, so that concurrent threads
+  // rarely enter RAND_bytes.  Bytes are erased from the buffer once handed
+  // out, and the buffers are discarded in the child after a fork(), so no
+  // bytes are ever handed out twice.  Disabled by default.
+  static void SetThreadLocalBuffering(bool enabled);
+
+  static constexpr size_t kBufferSize = 4096;
+  static constexpr size_t kMaxBufferedRequestSize = 64;
 };
 
 }  // namespace subtle
@@ -16,8 +16,12 @@
 
 #include "tink/subtle/random.h"
 
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include <set>
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -45,6 +49,17 @@ TEST(RandomTest, testBasic) {
   EXPECT_THAT(rand_strings, SizeIs(numTests));
 }
 
+TEST(RandomTest, GetRandomBytesIntoBuffer) {
+  int numTests = 32;
+  absl::flat_hash_set<std::string> rand_strings;
+  for (int i = 0; i < numTests; i++) {
+    std::string s(16, '\0');
+    EXPECT_TRUE(Random::GetRandomBytes(absl::MakeSpan(&s[0], s.size())).ok());
+    rand_strings.insert(s);
+  }
+  EXPECT_THAT(rand_strings, SizeIs(numTests));
+}
+
 TEST(RandomTest, KeyBytesTest) {
   util::SecretData key = Random::GetRandomKeyBytes(16);
   EXPECT_THAT(key, SizeIs(16));
@@ -131,6 +146,64 @@ TEST(RandomTest, UInt32Test) {
   }
 }
 
+TEST(RandomTest, BufferedBytesAreUnique) {
+  Random::SetThreadLocalBuffering(true);
+  constexpr int kThreads = 4;
+  // Enough nonces to refill every buffer a few times.
+  constexpr int kNoncesPerThread = 4 * Random::kBufferSize / 12;
+  std::vector<std::vector<std::string>> nonces(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&nonces, t]() {
+      for (int i = 0; i < kNoncesPerThread; i++) {
+        std::string nonce(12, '\0');
+        EXPECT_TRUE(
+            Random::GetRandomBytes(absl::MakeSpan(&nonce[0], nonce.size()))
+                .ok());
+        nonces[t].push_back(nonce);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  Random::SetThreadLocalBuffering(false);
+
+  absl::flat_hash_set<std::string> unique_nonces;
+  for (const auto& thread_nonces : nonces) {
+    unique_nonces.insert(thread_nonces.begin(), thread_nonces.end());
+  }
+  EXPECT_THAT(unique_nonces, SizeIs(kThreads * kNoncesPerThread));
+}
+
+TEST(RandomTest, BufferedBytesDifferAfterFork) {
+  Random::SetThreadLocalBuffering(true);
+  // Fill the buffer of this thread before forking.
+  Random::GetRandomBytes(16);
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    std::string child_bytes = Random::GetRandomBytes(16);
+    ssize_t written = write(fds[1], child_bytes.data(), child_bytes.size());
+    _exit(written == 16 ? 0 : 1);
+  }
+  std::string parent_bytes = Random::GetRandomBytes(16);
+  Random::SetThreadLocalBuffering(false);
+  std::string child_bytes(16, '\0');
+  ASSERT_EQ(16, read(fds[0], &child_bytes[0], child_bytes.size()));
+  int status;
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+  close(fds[0]);
+  close(fds[1]);
+  EXPECT_NE(parent_bytes, child_bytes);
+}
+
+TEST(RandomTest, GetRandomBytesIntoUint8Buffer) {
+  std::vector<uint8_t> bytes(32, 0);
+  EXPECT_TRUE(Random::GetRandomBytes(absl::MakeSpan(bytes)).ok());
+  EXPECT_NE(std::vector<uint8_t>(32, 0), bytes);
+}
+
 }  // namespace
 }  // namespace subtle
 }  // namespace tink
@@ -0,0 +1,118 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/rsa_private_key_pool.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/rsa.h"
+#include "tink/internal/thread_pool.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+RsaPrivateKeyPool::RsaPrivateKeyPool(bssl::UniquePtr<RSA> private_key,
+                                     int parallelism)
+    : private_key_(std::move(private_key)) {
+  if (parallelism > 1) {
+    thread_pool_ = absl::make_unique<internal::ThreadPool>(parallelism - 1);
+  }
+}
+
+util::StatusOr<bssl::UniquePtr<RSA>> RsaPrivateKeyPool::Acquire() const {
+  {
+    absl::MutexLock lock(&mutex_);
+    if (!idle_copies_.empty()) {
+      bssl::UniquePtr<RSA> copy = std::move(idle_copies_.back());
+      idle_copies_.pop_back();
+      return std::move(copy);
+    }
+    num_copies_++;
+  }
+  bssl::UniquePtr<RSA> copy(RSAPrivateKey_dup(private_key_.get()));
+  if (copy == nullptr) {
+    absl::MutexLock lock(&mutex_);
+    num_copies_--;
+    return util::Status(util::error::INTERNAL, "Copying the RSA key failed.");
+  }
+  return std::move(copy);
+}
+
+void RsaPrivateKeyPool::Release(bssl::UniquePtr<RSA> private_key) const {
+  absl::MutexLock lock(&mutex_);
+  idle_copies_.push_back(std::move(private_key));
+}
+
+util::StatusOr<std::string> RsaPrivateKeyPool::Sign(
+    absl::string_view data, const SignFunction& sign) const {
+  auto key_result = Acquire();
+  if (!key_result.ok()) return key_result.status();
+  bssl::UniquePtr<RSA> private_key = std::move(key_result.ValueOrDie());
+  auto sign_result = sign(private_key.get(), data);
+  Release(std::move(private_key));
+  return sign_result;
+}
+
+util::StatusOr<std::vector<std::string>> RsaPrivateKeyPool::SignBatch(
+    absl::Span<const absl::string_view> data, const SignFunction& sign) const {
+  std::vector<std::string> signatures(data.size());
+  std::vector<util::Status> statuses(data.size());
+  auto sign_item = [&](int i) {
+    auto sign_result = Sign(data[i], sign);
+    if (sign_result.ok()) {
+      signatures[i] = std::move(sign_result.ValueOrDie());
+    } else {
+      statuses[i] = sign_result.status();
+    }
+  };
+  if (thread_pool_ == nullptr) {
+    for (int i = 0; i < data.size(); i++) sign_item(i);
+  } else {
+    thread_pool_->ParallelFor(data.size(), sign_item);
+  }
+  for (const util::Status& status : statuses) {
+    if (!status.ok()) return status;
+  }
+  return std::move(signatures);
+}
+
+int RsaPrivateKeyPool::num_copies() const {
+  absl::MutexLock lock(&mutex_);
+  return num_copies_;
+}
+
+size_t RsaPrivateKeyPool::SpaceUsed() const {
+  // A key holds the modulus, d and the five CRT values, which take about
+  // 4.5 times the size of the modulus, and once used for signing, the
+  // Montgomery contexts of n, p and q, which take about as much again.
+  constexpr size_t kBytesPerModulusByte = 9;
+  size_t key_size = kBytesPerModulusByte * RSA_size(private_key_.get());
+  absl::MutexLock lock(&mutex_);
+  return sizeof(*this) + (1 + num_copies_) * key_size +
+         idle_copies_.capacity() * sizeof(bssl::UniquePtr<RSA>);
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
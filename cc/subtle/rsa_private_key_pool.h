@@ -0,0 +1,96 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_RSA_PRIVATE_KEY_POOL_H_
+#define TINK_SUBTLE_RSA_PRIVATE_KEY_POOL_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "openssl/base.h"
+#include "openssl/rsa.h"
+#include "tink/internal/thread_pool.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// Runs RSA private key operations on copies of one key, so that concurrent
+// operations do not share an RSA object.
+//
+// BoringSSL keeps per-key state in each RSA object -- the Montgomery
+// contexts of the modulus and the primes, computed by the first private key
+// operation, and a cache of blinding values -- and guards it with a lock in
+// the object.  The pool gives each operation a copy of the key of its own,
+// making a new copy only when all existing ones are in use, and keeps the
+// copies with their precomputed state for later operations.
+//
+// Instances of this class are thread safe.
+class RsaPrivateKeyPool {
+ public:
+  // Signs 'data' with 'private_key'.
+  using SignFunction = std::function<crypto::tink::util::StatusOr<std::string>(
+      RSA* private_key, absl::string_view data)>;
+
+  // Creates a pool for 'private_key', which signs batches on up to
+  // 'parallelism' threads, the calling one included.
+  RsaPrivateKeyPool(bssl::UniquePtr<RSA> private_key, int parallelism);
+
+  RsaPrivateKeyPool(const RsaPrivateKeyPool&) = delete;
+  RsaPrivateKeyPool& operator=(const RsaPrivateKeyPool&) = delete;
+
+  // Runs 'sign' for 'data' with a copy of the key.
+  crypto::tink::util::StatusOr<std::string> Sign(absl::string_view data,
+                                                 const SignFunction& sign) const;
+
+  // Runs 'sign' for every item of 'data', in parallel, and returns the
+  // signatures in order, or the first error.
+  crypto::tink::util::StatusOr<std::vector<std::string>> SignBatch(
+      absl::Span<const absl::string_view> data, const SignFunction& sign) const;
+
+  // Returns the number of copies of the key made so far.
+  int num_copies() const;
+
+  // Returns an estimate of the number of bytes held by the pool, i.e. mostly
+  // by the key and its copies.
+  size_t SpaceUsed() const;
+
+ private:
+  crypto::tink::util::StatusOr<bssl::UniquePtr<RSA>> Acquire() const;
+  void Release(bssl::UniquePtr<RSA> private_key) const;
+
+  // Only ever copied, never used for signing.
+  const bssl::UniquePtr<RSA> private_key_;
+  mutable absl::Mutex mutex_;
+  mutable std::vector<bssl::UniquePtr<RSA>> idle_copies_
+      ABSL_GUARDED_BY(mutex_);
+  mutable int num_copies_ ABSL_GUARDED_BY(mutex_) = 0;
+  // Null if 'parallelism' is 1.
+  std::unique_ptr<internal::ThreadPool> thread_pool_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_RSA_PRIVATE_KEY_POOL_H_
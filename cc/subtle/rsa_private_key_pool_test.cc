@@ -0,0 +1,110 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/rsa_private_key_pool.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/synchronization/notification.h"
+#include "openssl/bn.h"
+#include "openssl/rsa.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::ElementsAre;
+
+bssl::UniquePtr<RSA> NewRsaKey() {
+  bssl::UniquePtr<BIGNUM> e(BN_new());
+  BN_set_word(e.get(), RSA_F4);
+  bssl::UniquePtr<RSA> rsa(RSA_new());
+  EXPECT_EQ(1, RSA_generate_key_ex(rsa.get(), 2048, e.get(), nullptr));
+  return rsa;
+}
+
+TEST(RsaPrivateKeyPoolTest, CopiesAreReused) {
+  RsaPrivateKeyPool pool(NewRsaKey(), /*parallelism=*/1);
+  std::set<RSA*> keys;
+  RsaPrivateKeyPool::SignFunction sign = [&keys](RSA* private_key,
+                                                 absl::string_view data) {
+    keys.insert(private_key);
+    return util::StatusOr<std::string>(absl::StrCat("signed ", data));
+  };
+  for (int i = 0; i < 3; i++) {
+    auto signature_or = pool.Sign("data", sign);
+    ASSERT_THAT(signature_or.status(), IsOk());
+    EXPECT_EQ(signature_or.ValueOrDie(), "signed data");
+  }
+  EXPECT_EQ(keys.size(), 1);
+  EXPECT_EQ(pool.num_copies(), 1);
+}
+
+TEST(RsaPrivateKeyPoolTest, ConcurrentOperationsUseDifferentCopies) {
+  RsaPrivateKeyPool pool(NewRsaKey(), /*parallelism=*/4);
+  absl::Mutex mutex;
+  std::set<RSA*> keys;
+  int running = 0;
+  // Every operation waits until all four run, so no copy can be shared.
+  RsaPrivateKeyPool::SignFunction sign = [&](RSA* private_key,
+                                             absl::string_view data) {
+    absl::MutexLock lock(&mutex);
+    keys.insert(private_key);
+    running++;
+    mutex.Await(absl::Condition(
+        +[](int* running) { return *running == 4; }, &running));
+    return util::StatusOr<std::string>(std::string(data));
+  };
+  std::vector<absl::string_view> data = {"a", "b", "c", "d"};
+  auto signatures_or = pool.SignBatch(data, sign);
+  ASSERT_THAT(signatures_or.status(), IsOk());
+  EXPECT_THAT(signatures_or.ValueOrDie(), ElementsAre("a", "b", "c", "d"));
+  EXPECT_EQ(keys.size(), 4);
+  EXPECT_EQ(pool.num_copies(), 4);
+}
+
+TEST(RsaPrivateKeyPoolTest, SignBatchReturnsError) {
+  RsaPrivateKeyPool pool(NewRsaKey(), /*parallelism=*/2);
+  RsaPrivateKeyPool::SignFunction sign = [](RSA* private_key,
+                                            absl::string_view data) {
+    if (data == "bad") {
+      return util::StatusOr<std::string>(
+          util::Status(util::error::INTERNAL, "Signing failed."));
+    }
+    return util::StatusOr<std::string>(std::string(data));
+  };
+  std::vector<absl::string_view> data = {"good", "bad", "good"};
+  EXPECT_THAT(pool.SignBatch(data, sign).status(),
+              StatusIs(util::error::INTERNAL));
+  // The copies are returned to the pool after a failure.
+  EXPECT_THAT(pool.Sign("good", sign).status(), IsOk());
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,92 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/rsa_public_key_context.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "openssl/bn.h"
+#include "openssl/rsa.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// static
+util::StatusOr<std::unique_ptr<RsaPublicKeyContext>> RsaPublicKeyContext::New(
+    const RSA& rsa) {
+  const BIGNUM* n;
+  const BIGNUM* e;
+  RSA_get0_key(&rsa, &n, &e, nullptr);
+  if (n == nullptr || e == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "RSA key has no modulus or public exponent");
+  }
+  bssl::UniquePtr<BIGNUM> n_copy(BN_dup(n));
+  bssl::UniquePtr<BIGNUM> e_copy(BN_dup(e));
+  bssl::UniquePtr<BN_CTX> ctx(BN_CTX_new());
+  if (n_copy == nullptr || e_copy == nullptr || ctx == nullptr) {
+    return util::Status(util::error::INTERNAL, "Allocation failed");
+  }
+  bssl::UniquePtr<BN_MONT_CTX> mont(
+      BN_MONT_CTX_new_for_modulus(n_copy.get(), ctx.get()));
+  if (mont == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Could not build the Montgomery context");
+  }
+  return {absl::WrapUnique(new RsaPublicKeyContext(
+      std::move(n_copy), std::move(e_copy), std::move(mont)))};
+}
+
+util::StatusOr<std::string> RsaPublicKeyContext::PublicOperation(
+    absl::string_view signature) const {
+  if (signature.size() != modulus_size_) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Signature has the wrong size.");
+  }
+  bssl::UniquePtr<BN_CTX> ctx(BN_CTX_new());
+  bssl::UniquePtr<BIGNUM> s(
+      BN_bin2bn(reinterpret_cast<const uint8_t*>(signature.data()),
+                signature.size(), nullptr));
+  bssl::UniquePtr<BIGNUM> m(BN_new());
+  if (ctx == nullptr || s == nullptr || m == nullptr) {
+    return util::Status(util::error::INTERNAL, "Allocation failed.");
+  }
+  if (BN_ucmp(s.get(), n_.get()) >= 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Signature is not valid.");
+  }
+  // The exponent is public, so that it need not be constant time.
+  std::string message(modulus_size_, '\0');
+  if (!BN_mod_exp_mont(m.get(), s.get(), e_.get(), n_.get(), ctx.get(),
+                       mont_.get()) ||
+      !BN_bn2bin_padded(reinterpret_cast<uint8_t*>(&message[0]),
+                        message.size(), m.get())) {
+    return util::Status(util::error::INTERNAL,
+                        "RSA public operation failed.");
+  }
+  return message;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
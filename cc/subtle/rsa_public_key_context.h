@@ -0,0 +1,84 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_RSA_PUBLIC_KEY_CONTEXT_H_
+#define TINK_SUBTLE_RSA_PUBLIC_KEY_CONTEXT_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "openssl/base.h"
+#include "openssl/bn.h"
+#include "openssl/rsa.h"
+#include "tink/executor.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// Options of RsaSsaPkcs1VerifyBoringSsl and RsaSsaPssVerifyBoringSsl.
+struct RsaVerifyOptions {
+  // Whether to build an RsaPublicKeyContext in New(), and verify with it
+  // rather than through BoringSSL's RSA verification, which builds the
+  // Montgomery context of the modulus lazily and takes the lock of the RSA
+  // object on every call.  The signatures accepted are the same.
+  bool precompute_montgomery = false;
+  // If set, VerifyBatch() verifies on the threads of 'executor' as well as
+  // on the calling thread.
+  std::shared_ptr<Executor> executor;
+};
+
+// The public half of an RSA key with the Montgomery context of its modulus,
+// computed once in New().  Nothing is modified afterwards, so that any
+// number of threads may use one context without synchronization.
+class RsaPublicKeyContext {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<RsaPublicKeyContext>>
+  New(const RSA& rsa);
+
+  RsaPublicKeyContext(const RsaPublicKeyContext&) = delete;
+  RsaPublicKeyContext& operator=(const RsaPublicKeyContext&) = delete;
+
+  // Returns signature^e mod n, big-endian and as long as the modulus.
+  // Fails with INVALID_ARGUMENT unless 'signature' is as long as the
+  // modulus, and less than it as an integer.
+  crypto::tink::util::StatusOr<std::string> PublicOperation(
+      absl::string_view signature) const;
+
+  // The size of the modulus in bytes.
+  size_t modulus_size() const { return modulus_size_; }
+
+ private:
+  RsaPublicKeyContext(bssl::UniquePtr<BIGNUM> n, bssl::UniquePtr<BIGNUM> e,
+                      bssl::UniquePtr<BN_MONT_CTX> mont)
+      : n_(std::move(n)),
+        e_(std::move(e)),
+        mont_(std::move(mont)),
+        modulus_size_(BN_num_bytes(n_.get())) {}
+
+  const bssl::UniquePtr<BIGNUM> n_;
+  const bssl::UniquePtr<BIGNUM> e_;
+  const bssl::UniquePtr<BN_MONT_CTX> mont_;
+  const size_t modulus_size_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_RSA_PUBLIC_KEY_CONTEXT_H_
@@ -0,0 +1,94 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/rsa_public_key_context.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "openssl/bn.h"
+#include "openssl/rsa.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+
+bssl::UniquePtr<RSA> NewRsaPublicKey() {
+  bssl::UniquePtr<BIGNUM> e(BN_new());
+  BN_set_word(e.get(), RSA_F4);
+  SubtleUtilBoringSSL::RsaPrivateKey private_key;
+  SubtleUtilBoringSSL::RsaPublicKey public_key;
+  EXPECT_THAT(SubtleUtilBoringSSL::GetNewRsaKeyPair(2048, e.get(),
+                                                    &private_key, &public_key),
+              IsOk());
+  return std::move(
+      SubtleUtilBoringSSL::BoringSslRsaFromRsaPublicKey(public_key)
+          .ValueOrDie());
+}
+
+TEST(RsaPublicKeyContextTest, MatchesBoringSsl) {
+  bssl::UniquePtr<RSA> rsa = NewRsaPublicKey();
+  auto context_or = RsaPublicKeyContext::New(*rsa);
+  ASSERT_THAT(context_or.status(), IsOk());
+  const RsaPublicKeyContext& context = *context_or.ValueOrDie();
+  ASSERT_EQ(context.modulus_size(), RSA_size(rsa.get()));
+
+  for (int i = 0; i < 10; i++) {
+    // Clearing the top byte keeps the input below the modulus.
+    std::string input = Random::GetRandomBytes(context.modulus_size());
+    input[0] = 0;
+    std::string expected(context.modulus_size(), '\0');
+    ASSERT_EQ(RSA_public_encrypt(
+                  input.size(), reinterpret_cast<const uint8_t*>(input.data()),
+                  reinterpret_cast<uint8_t*>(&expected[0]), rsa.get(),
+                  RSA_NO_PADDING),
+              context.modulus_size());
+    auto output_or = context.PublicOperation(input);
+    ASSERT_THAT(output_or.status(), IsOk());
+    EXPECT_EQ(output_or.ValueOrDie(), expected);
+  }
+}
+
+TEST(RsaPublicKeyContextTest, InvalidInputs) {
+  bssl::UniquePtr<RSA> rsa = NewRsaPublicKey();
+  auto context = std::move(RsaPublicKeyContext::New(*rsa).ValueOrDie());
+  size_t size = context->modulus_size();
+  EXPECT_THAT(context->PublicOperation(std::string(size - 1, '\x01')).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(context->PublicOperation(std::string(size + 1, '\x01')).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  // Not less than the modulus.
+  EXPECT_THAT(context->PublicOperation(std::string(size, '\xff')).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(RsaPublicKeyContextTest, KeyWithoutModulus) {
+  bssl::UniquePtr<RSA> rsa(RSA_new());
+  EXPECT_THAT(RsaPublicKeyContext::New(*rsa).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -16,6 +16,9 @@
 
 #include "tink/subtle/rsa_ssa_pkcs1_sign_boringssl.h"
 
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/memory/memory.h"
@@ -24,6 +27,8 @@
 #include "openssl/digest.h"
 #include "openssl/evp.h"
 #include "openssl/rsa.h"
+#include "tink/subtle/digest_output_stream.h"
+#include "tink/subtle/rsa_private_key_pool.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 
 namespace crypto {
@@ -34,6 +39,17 @@ namespace subtle {
 util::StatusOr<std::unique_ptr<PublicKeySign>> RsaSsaPkcs1SignBoringSsl::New(
     const SubtleUtilBoringSSL::RsaPrivateKey& private_key,
     const SubtleUtilBoringSSL::RsaSsaPkcs1Params& params) {
+  return New(private_key, params, /*parallelism=*/1);
+}
+
+// static
+util::StatusOr<std::unique_ptr<PublicKeySign>> RsaSsaPkcs1SignBoringSsl::New(
+    const SubtleUtilBoringSSL::RsaPrivateKey& private_key,
+    const SubtleUtilBoringSSL::RsaSsaPkcs1Params& params, int parallelism) {
+  if (parallelism < 1) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "parallelism must be positive");
+  }
   auto status = CheckFipsCompatibility<RsaSsaPkcs1SignBoringSsl>();
   if (!status.ok()) return status;
 
@@ -59,25 +75,69 @@ util::StatusOr<std::unique_ptr<PublicKeySign>> RsaSsaPkcs1SignBoringSsl::New(
   }
 
   return {absl::WrapUnique(new RsaSsaPkcs1SignBoringSsl(
-      std::move(rsa).ValueOrDie(), sig_hash.ValueOrDie()))};
+      absl::make_unique<RsaPrivateKeyPool>(std::move(rsa).ValueOrDie(),
+                                           parallelism),
+      sig_hash.ValueOrDie()))};
 }
 
 util::StatusOr<std::string> RsaSsaPkcs1SignBoringSsl::Sign(
     absl::string_view data) const {
+  return private_keys_->Sign(
+      data, [this](RSA* private_key, absl::string_view item) {
+        return SignWithKey(private_key, item);
+      });
+}
+
+util::StatusOr<std::vector<std::string>> RsaSsaPkcs1SignBoringSsl::SignBatch(
+    absl::Span<const absl::string_view> data) const {
+  return private_keys_->SignBatch(
+      data, [this](RSA* private_key, absl::string_view item) {
+        return SignWithKey(private_key, item);
+      });
+}
+
+util::StatusOr<std::unique_ptr<OutputStreamWithResult<std::string>>>
+RsaSsaPkcs1SignBoringSsl::NewSignOutputStream() const {
+  return DigestOutputStream<std::string>::New(
+      sig_hash_,
+      [this](absl::string_view digest) { return SignDigest(digest); });
+}
+
+util::StatusOr<std::string> RsaSsaPkcs1SignBoringSsl::SignDigest(
+    absl::string_view digest) const {
+  if (digest.size() != EVP_MD_size(sig_hash_)) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Digest has the wrong size.");
+  }
+  return private_keys_->Sign(
+      digest, [this](RSA* private_key, absl::string_view item) {
+        return SignDigestWithKey(private_key, item);
+      });
+}
+
+util::StatusOr<std::string> RsaSsaPkcs1SignBoringSsl::SignWithKey(
+    RSA* private_key, absl::string_view data) const {
   data = SubtleUtilBoringSSL::EnsureNonNull(data);
   auto digest_or = boringssl::ComputeHash(data, *sig_hash_);
   if (!digest_or.ok()) return digest_or.status();
   std::vector<uint8_t> digest = std::move(digest_or.ValueOrDie());
+  return SignDigestWithKey(
+      private_key,
+      absl::string_view(reinterpret_cast<const char*>(digest.data()),
+                        digest.size()));
+}
 
-  std::vector<uint8_t> signature(RSA_size(private_key_.get()));
+util::StatusOr<std::string> RsaSsaPkcs1SignBoringSsl::SignDigestWithKey(
+    RSA* private_key, absl::string_view digest) const {
+  std::vector<uint8_t> signature(RSA_size(private_key));
   unsigned int signature_length = 0;
 
   if (RSA_sign(/*hash_nid=*/EVP_MD_type(sig_hash_),
-               /*in=*/digest.data(),
+               /*in=*/reinterpret_cast<const uint8_t*>(digest.data()),
                /*in_len=*/digest.size(),
                /*out=*/signature.data(),
                /*out_len=*/&signature_length,
-               /*rsa=*/private_key_.get()) != 1) {
+               /*rsa=*/private_key) != 1) {
     // TODO(b/112581512): Decide if it's safe to propagate the BoringSSL error.
     // For now, just empty the error stack.
     SubtleUtilBoringSSL::GetErrors();
@@ -15,11 +15,16 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "tink/subtle/rsa_ssa_pkcs1_sign_boringssl.h"
+
 #include <cstdint>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
 #include "openssl/base.h"
 #include "openssl/bn.h"
 #include "openssl/crypto.h"
@@ -27,6 +32,7 @@
 #include "tink/config/tink_fips.h"
 #include "tink/subtle/rsa_ssa_pkcs1_verify_boringssl.h"
 #include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/subtle/test_util.h"
 #include "tink/util/test_matchers.h"
 
 namespace crypto {
@@ -183,6 +189,97 @@ TEST_F(RsaPkcs1SignBoringsslTest, TestAllowedFipsModuli) {
               IsOk());
 }
 
+TEST_F(RsaPkcs1SignBoringsslTest, SignBatch) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+
+  SubtleUtilBoringSSL::RsaSsaPkcs1Params params{/*sig_hash=*/HashType::SHA256};
+  auto signer_or =
+      RsaSsaPkcs1SignBoringSsl::New(private_key_, params, /*parallelism=*/4);
+  ASSERT_THAT(signer_or.status(), IsOk());
+  auto signer = std::move(signer_or.ValueOrDie());
+
+  std::vector<std::string> messages;
+  for (int i = 0; i < 10; i++) messages.push_back(absl::StrCat("data", i));
+  std::vector<absl::string_view> data(messages.begin(), messages.end());
+  auto signatures_or = signer->SignBatch(data);
+  ASSERT_THAT(signatures_or.status(), IsOk());
+  const std::vector<std::string>& signatures = signatures_or.ValueOrDie();
+  ASSERT_EQ(signatures.size(), data.size());
+
+  auto verifier =
+      RsaSsaPkcs1VerifyBoringSsl::New(public_key_, params).ValueOrDie();
+  for (size_t i = 0; i < data.size(); i++) {
+    // PKCS#1 v1.5 signatures are deterministic.
+    EXPECT_EQ(signatures[i], signer->Sign(data[i]).ValueOrDie());
+    EXPECT_THAT(verifier->Verify(signatures[i], data[i]), IsOk());
+  }
+}
+
+TEST_F(RsaPkcs1SignBoringsslTest, ConcurrentSign) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+
+  SubtleUtilBoringSSL::RsaSsaPkcs1Params params{/*sig_hash=*/HashType::SHA256};
+  auto signer = RsaSsaPkcs1SignBoringSsl::New(private_key_, params).ValueOrDie();
+  auto verifier =
+      RsaSsaPkcs1VerifyBoringSsl::New(public_key_, params).ValueOrDie();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&signer, &verifier, t]() {
+      for (int i = 0; i < 5; i++) {
+        std::string data = absl::StrCat(t, "/", i);
+        auto signature_or = signer->Sign(data);
+        ASSERT_THAT(signature_or.status(), IsOk());
+        EXPECT_THAT(verifier->Verify(signature_or.ValueOrDie(), data), IsOk());
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+TEST_F(RsaPkcs1SignBoringsslTest, RejectsInvalidParallelism) {
+  SubtleUtilBoringSSL::RsaSsaPkcs1Params params{/*sig_hash=*/HashType::SHA256};
+  EXPECT_THAT(
+      RsaSsaPkcs1SignBoringSsl::New(private_key_, params, /*parallelism=*/0)
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(RsaPkcs1SignBoringsslTest, StreamingSignAndVerify) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+
+  SubtleUtilBoringSSL::RsaSsaPkcs1Params params{/*sig_hash=*/HashType::SHA256};
+  auto signer =
+      RsaSsaPkcs1SignBoringSsl::New(private_key_, params).ValueOrDie();
+  auto verifier =
+      RsaSsaPkcs1VerifyBoringSsl::New(public_key_, params).ValueOrDie();
+  std::string message(10000, 'm');
+
+  auto sign_stream_or = signer->NewSignOutputStream();
+  ASSERT_THAT(sign_stream_or.status(), IsOk());
+  auto sign_stream = std::move(sign_stream_or.ValueOrDie());
+  ASSERT_THAT(test::WriteToStream(sign_stream.get(), message), IsOk());
+  auto signature_or = sign_stream->GetResult();
+  ASSERT_THAT(signature_or.status(), IsOk());
+  EXPECT_THAT(verifier->Verify(signature_or.ValueOrDie(), message), IsOk());
+
+  auto verify_stream_or =
+      verifier->NewVerifyOutputStream(signature_or.ValueOrDie());
+  ASSERT_THAT(verify_stream_or.status(), IsOk());
+  auto verify_stream = std::move(verify_stream_or.ValueOrDie());
+  EXPECT_THAT(test::WriteToStream(verify_stream.get(), message), IsOk());
+
+  verify_stream =
+      verifier->NewVerifyOutputStream(signature_or.ValueOrDie()).ValueOrDie();
+  EXPECT_THAT(test::WriteToStream(verify_stream.get(), "bad message"),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 }  // namespace
 }  // namespace subtle
 }  // namespace tink
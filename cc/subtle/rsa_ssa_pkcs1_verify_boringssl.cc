@@ -15,12 +15,21 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "tink/subtle/rsa_ssa_pkcs1_verify_boringssl.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "absl/strings/str_cat.h"
 #include "openssl/bn.h"
 #include "openssl/digest.h"
 #include "openssl/evp.h"
+#include "openssl/mem.h"
 #include "openssl/rsa.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/digest_output_stream.h"
+#include "tink/subtle/rsa_public_key_context.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/errors.h"
 
@@ -33,9 +42,49 @@ util::StatusOr<std::unique_ptr<RsaSsaPkcs1VerifyBoringSsl>>
 RsaSsaPkcs1VerifyBoringSsl::New(
     const SubtleUtilBoringSSL::RsaPublicKey& pub_key,
     const SubtleUtilBoringSSL::RsaSsaPkcs1Params& params) {
+  return New(pub_key, params, RsaVerifyOptions());
+}
+
+// static
+util::StatusOr<std::unique_ptr<RsaSsaPkcs1VerifyBoringSsl>>
+RsaSsaPkcs1VerifyBoringSsl::New(
+    bssl::UniquePtr<RSA> rsa,
+    const SubtleUtilBoringSSL::RsaSsaPkcs1Params& params) {
+  return New(std::move(rsa), params, RsaVerifyOptions());
+}
+
+// static
+util::StatusOr<std::unique_ptr<RsaSsaPkcs1VerifyBoringSsl>>
+RsaSsaPkcs1VerifyBoringSsl::New(
+    const SubtleUtilBoringSSL::RsaPublicKey& pub_key,
+    const SubtleUtilBoringSSL::RsaSsaPkcs1Params& params,
+    const RsaVerifyOptions& options) {
+  // The RSA modulus and exponent are checked as part of the conversion to
+  // bssl::UniquePtr<RSA>.
+  auto rsa = SubtleUtilBoringSSL::BoringSslRsaFromRsaPublicKey(pub_key);
+  if (!rsa.ok()) {
+    return rsa.status();
+  }
+  return New(std::move(rsa).ValueOrDie(), params, options);
+}
+
+// static
+util::StatusOr<std::unique_ptr<RsaSsaPkcs1VerifyBoringSsl>>
+RsaSsaPkcs1VerifyBoringSsl::New(
+    bssl::UniquePtr<RSA> rsa,
+    const SubtleUtilBoringSSL::RsaSsaPkcs1Params& params,
+    const RsaVerifyOptions& options) {
   auto status = CheckFipsCompatibility<RsaSsaPkcs1VerifyBoringSsl>();
   if (!status.ok()) return status;
 
+  if (rsa == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "rsa must be non-null");
+  }
+  auto modulus_status =
+      SubtleUtilBoringSSL::ValidateRsaModulusSize(RSA_bits(rsa.get()));
+  if (!modulus_status.ok()) return modulus_status;
+
   // Check hash.
   auto hash_status =
       SubtleUtilBoringSSL::ValidateSignatureHash(params.hash_type);
@@ -45,16 +94,17 @@ RsaSsaPkcs1VerifyBoringSsl::New(
   auto sig_hash_result = SubtleUtilBoringSSL::EvpHash(params.hash_type);
   if (!sig_hash_result.ok()) return sig_hash_result.status();
 
-  // The RSA modulus and exponent are checked as part of the conversion to
-  // bssl::UniquePtr<RSA>.
-  auto rsa = SubtleUtilBoringSSL::BoringSslRsaFromRsaPublicKey(pub_key);
-  if (!rsa.ok()) {
-    return rsa.status();
+  std::unique_ptr<const RsaPublicKeyContext> public_key_context;
+  if (options.precompute_montgomery) {
+    auto context_result = RsaPublicKeyContext::New(*rsa);
+    if (!context_result.ok()) return context_result.status();
+    public_key_context = std::move(context_result.ValueOrDie());
   }
 
   std::unique_ptr<RsaSsaPkcs1VerifyBoringSsl> verify(
-      new RsaSsaPkcs1VerifyBoringSsl(std::move(rsa).ValueOrDie(),
-                                     sig_hash_result.ValueOrDie()));
+      new RsaSsaPkcs1VerifyBoringSsl(
+          std::move(rsa), sig_hash_result.ValueOrDie(),
+          std::move(public_key_context), options.executor));
   return std::move(verify);
 }
 
@@ -67,10 +117,53 @@ util::Status RsaSsaPkcs1VerifyBoringSsl::Verify(absl::string_view signature,
   auto digest_result = boringssl::ComputeHash(data, *sig_hash_);
   if (!digest_result.ok()) return digest_result.status();
   auto digest = std::move(digest_result.ValueOrDie());
+  return VerifyDigest(
+      signature,
+      absl::string_view(reinterpret_cast<const char*>(digest.data()),
+                        digest.size()));
+}
+
+util::StatusOr<std::vector<util::Status>>
+RsaSsaPkcs1VerifyBoringSsl::VerifyBatch(
+    absl::Span<const absl::string_view> signatures,
+    absl::Span<const absl::string_view> data) const {
+  if (executor_ == nullptr || signatures.size() < 2 ||
+      signatures.size() != data.size()) {
+    return PublicKeyVerify::VerifyBatch(signatures, data);
+  }
+  std::vector<util::Status> results(signatures.size());
+  executor_->ParallelFor(signatures.size(), [&](int i) {
+    results[i] = Verify(signatures[i], data[i]);
+  });
+  return std::move(results);
+}
+
+util::StatusOr<std::unique_ptr<OutputStreamWithResult<util::Status>>>
+RsaSsaPkcs1VerifyBoringSsl::NewVerifyOutputStream(
+    absl::string_view signature) const {
+  std::string signature_copy(signature);
+  return DigestOutputStream<util::Status>::New(
+      sig_hash_, [this, signature_copy](absl::string_view digest) {
+        return VerifyDigest(signature_copy, digest);
+      });
+}
+
+util::Status RsaSsaPkcs1VerifyBoringSsl::VerifyDigest(
+    absl::string_view signature, absl::string_view digest) const {
+  if (digest.size() != EVP_MD_size(sig_hash_)) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Digest has the wrong size.");
+  }
+
+  if (public_key_context_ != nullptr) {
+    auto encoded_result = public_key_context_->PublicOperation(signature);
+    if (!encoded_result.ok()) return encoded_result.status();
+    return CheckEncoding(encoded_result.ValueOrDie(), digest);
+  }
 
   if (1 !=
       RSA_verify(EVP_MD_type(sig_hash_),
-                 /*msg=*/digest.data(),
+                 /*msg=*/reinterpret_cast<const uint8_t*>(digest.data()),
                  /*msg_len=*/digest.size(),
                  /*sig=*/reinterpret_cast<const uint8_t*>(signature.data()),
                  /*sig_len=*/signature.length(),
@@ -83,6 +176,32 @@ util::Status RsaSsaPkcs1VerifyBoringSsl::Verify(absl::string_view signature,
   return util::Status::OK;
 }
 
+util::Status RsaSsaPkcs1VerifyBoringSsl::CheckEncoding(
+    absl::string_view encoded, absl::string_view digest) const {
+  uint8_t* digest_info;
+  size_t digest_info_length;
+  int is_allocated;
+  if (1 != RSA_add_pkcs1_prefix(
+               &digest_info, &digest_info_length, &is_allocated,
+               EVP_MD_type(sig_hash_),
+               reinterpret_cast<const uint8_t*>(digest.data()),
+               digest.size())) {
+    return util::Status(util::error::INTERNAL,
+                        "Could not compute the DigestInfo.");
+  }
+  std::string expected(encoded.size(), '\0');
+  int padded = RSA_padding_add_PKCS1_type_1(
+      reinterpret_cast<uint8_t*>(&expected[0]), expected.size(), digest_info,
+      digest_info_length);
+  if (is_allocated) OPENSSL_free(digest_info);
+  if (1 != padded ||
+      CRYPTO_memcmp(expected.data(), encoded.data(), encoded.size()) != 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Signature is not valid.");
+  }
+  return util::Status::OK;
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -19,15 +19,20 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/evp.h"
 #include "openssl/rsa.h"
+#include "tink/output_stream_with_result.h"
 #include "tink/public_key_verify.h"
 #include "tink/config/tink_fips.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/rsa_public_key_context.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/status.h"
+#include "tink/util/statusor.h"
 
 namespace crypto {
 namespace tink {
@@ -44,10 +49,43 @@ class RsaSsaPkcs1VerifyBoringSsl : public PublicKeyVerify {
   New(const SubtleUtilBoringSSL::RsaPublicKey& pub_key,
       const SubtleUtilBoringSSL::RsaSsaPkcs1Params& params);
 
+  // Like New(pub_key, params), but takes the public key as a BoringSSL key,
+  // e.g. one returned by PemParser::ParseRsaPublicKeyToBoringSsl().
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<RsaSsaPkcs1VerifyBoringSsl>>
+  New(bssl::UniquePtr<RSA> rsa,
+      const SubtleUtilBoringSSL::RsaSsaPkcs1Params& params);
+
+  // As above, with 'options'; see RsaVerifyOptions.
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<RsaSsaPkcs1VerifyBoringSsl>>
+  New(const SubtleUtilBoringSSL::RsaPublicKey& pub_key,
+      const SubtleUtilBoringSSL::RsaSsaPkcs1Params& params,
+      const RsaVerifyOptions& options);
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<RsaSsaPkcs1VerifyBoringSsl>>
+  New(bssl::UniquePtr<RSA> rsa,
+      const SubtleUtilBoringSSL::RsaSsaPkcs1Params& params,
+      const RsaVerifyOptions& options);
+
   // Verifies that 'signature' is a digital signature for 'data'.
   crypto::tink::util::Status Verify(absl::string_view signature,
                                     absl::string_view data) const override;
 
+  crypto::tink::util::StatusOr<std::vector<crypto::tink::util::Status>>
+  VerifyBatch(absl::Span<const absl::string_view> signatures,
+              absl::Span<const absl::string_view> data) const override;
+
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<OutputStreamWithResult<crypto::tink::util::Status>>>
+  NewVerifyOutputStream(absl::string_view signature) const override;
+
+  // Verifies that 'signature' is a digital signature for data whose digest
+  // under the signature hash function is 'digest', for callers which have
+  // hashed the data already.
+  crypto::tink::util::Status VerifyDigest(absl::string_view signature,
+                                          absl::string_view digest) const;
+
   ~RsaSsaPkcs1VerifyBoringSsl() override = default;
 
   static constexpr crypto::tink::FipsCompatibility kFipsStatus =
@@ -60,11 +98,25 @@ class RsaSsaPkcs1VerifyBoringSsl : public PublicKeyVerify {
   // https://www.keylength.com/en/4/).
   static constexpr size_t kMinModulusSizeInBits = 2048;
 
-  RsaSsaPkcs1VerifyBoringSsl(bssl::UniquePtr<RSA> rsa, const EVP_MD* sig_hash)
-      : rsa_(std::move(rsa)), sig_hash_(sig_hash) {}
+  RsaSsaPkcs1VerifyBoringSsl(
+      bssl::UniquePtr<RSA> rsa, const EVP_MD* sig_hash,
+      std::unique_ptr<const RsaPublicKeyContext> public_key_context,
+      std::shared_ptr<Executor> executor)
+      : rsa_(std::move(rsa)),
+        sig_hash_(sig_hash),
+        public_key_context_(std::move(public_key_context)),
+        executor_(std::move(executor)) {}
+
+  // Checks that 'encoded', the result of the public key operation on a
+  // signature, is the PKCS#1 v1.5 encoding of 'digest'.
+  crypto::tink::util::Status CheckEncoding(absl::string_view encoded,
+                                           absl::string_view digest) const;
 
   const bssl::UniquePtr<RSA> rsa_;
   const EVP_MD* const sig_hash_;  // Owned by BoringSSL.
+  // Set if the options ask for precomputed Montgomery contexts.
+  const std::unique_ptr<const RsaPublicKeyContext> public_key_context_;
+  const std::shared_ptr<Executor> executor_;
 };
 
 }  // namespace subtle
@@ -18,6 +18,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "absl/strings/escaping.h"
@@ -26,8 +27,10 @@
 #include "include/rapidjson/document.h"
 #include "tink/public_key_sign.h"
 #include "tink/public_key_verify.h"
+#include "tink/thread_pool_executor.h"
 #include "tink/config/tink_fips.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/rsa_public_key_context.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/subtle/wycheproof_util.h"
 #include "tink/util/status.h"
@@ -169,7 +172,7 @@ TEST_F(RsaSsaPkcs1VerifyBoringSslTest, Modification) {
 }
 
 static util::StatusOr<std::unique_ptr<RsaSsaPkcs1VerifyBoringSsl>> GetVerifier(
-    const rapidjson::Value& test_group) {
+    const rapidjson::Value& test_group, const RsaVerifyOptions& options) {
   SubtleUtilBoringSSL::RsaPublicKey key;
   key.n = WycheproofUtil::GetInteger(test_group["n"]);
   key.e = WycheproofUtil::GetInteger(test_group["e"]);
@@ -178,7 +181,7 @@ static util::StatusOr<std::unique_ptr<RsaSsaPkcs1VerifyBoringSsl>> GetVerifier(
   SubtleUtilBoringSSL::RsaSsaPkcs1Params params;
   params.hash_type = md;
 
-  auto result = RsaSsaPkcs1VerifyBoringSsl::New(key, params);
+  auto result = RsaSsaPkcs1VerifyBoringSsl::New(key, params, options);
   if (!result.ok()) {
     std::cout << "Failed: " << result.status() << "\n";
   }
@@ -190,7 +193,8 @@ static util::StatusOr<std::unique_ptr<RsaSsaPkcs1VerifyBoringSsl>> GetVerifier(
 // a verfier cannot be constructed. This option can be used for
 // if a file contains test vectors that are not necessarily supported
 // by tink.
-bool TestSignatures(const std::string& filename, bool allow_skipping) {
+bool TestSignatures(const std::string& filename, bool allow_skipping,
+                    const RsaVerifyOptions& options = RsaVerifyOptions()) {
   std::unique_ptr<rapidjson::Document> root =
       WycheproofUtil::ReadTestVectors(filename);
   std::cout << (*root)["algorithm"].GetString();
@@ -201,7 +205,7 @@ bool TestSignatures(const std::string& filename, bool allow_skipping) {
   int group_count = 0;
   for (const rapidjson::Value& test_group : (*root)["testGroups"].GetArray()) {
     group_count++;
-    auto verifier_result = GetVerifier(test_group);
+    auto verifier_result = GetVerifier(test_group, options);
     if (!verifier_result.ok()) {
       std::string type = test_group["type"].GetString();
       if (allow_skipping) {
@@ -291,6 +295,85 @@ TEST_F(RsaSsaPkcs1VerifyBoringSslTest, WycheproofRsaPkcs14096SHA512) {
                              /*allow_skipping=*/true));
 }
 
+TEST_F(RsaSsaPkcs1VerifyBoringSslTest, WycheproofPrecomputedMontgomery) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+  RsaVerifyOptions options;
+  options.precompute_montgomery = true;
+  for (const std::string& filename :
+       {"rsa_signature_2048_sha256_test.json",
+        "rsa_signature_3072_sha512_test.json",
+        "rsa_signature_4096_sha512_test.json"}) {
+    SCOPED_TRACE(filename);
+    EXPECT_TRUE(TestSignatures(filename, /*allow_skipping=*/true, options));
+  }
+}
+
+TEST_F(RsaSsaPkcs1VerifyBoringSslTest, PrecomputedMontgomeryModification) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+  SubtleUtilBoringSSL::RsaPublicKey pub_key{nist_test_vector.n,
+                                            nist_test_vector.e};
+  SubtleUtilBoringSSL::RsaSsaPkcs1Params params{nist_test_vector.sig_hash};
+  RsaVerifyOptions options;
+  options.precompute_montgomery = true;
+  auto verifier =
+      RsaSsaPkcs1VerifyBoringSsl::New(pub_key, params, options).ValueOrDie();
+  EXPECT_THAT(
+      verifier->Verify(nist_test_vector.signature, nist_test_vector.message),
+      IsOk());
+  for (std::size_t i = 0; i < 8 * nist_test_vector.signature.length(); i++) {
+    std::string modified_signature = nist_test_vector.signature;
+    modified_signature[i / 8] ^= 1 << (i % 8);
+    EXPECT_THAT(verifier->Verify(modified_signature, nist_test_vector.message),
+                StatusIs(util::error::INVALID_ARGUMENT));
+  }
+  EXPECT_THAT(verifier->Verify(nist_test_vector.signature.substr(1),
+                               nist_test_vector.message),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  // A signature which is not less than the modulus.
+  EXPECT_THAT(verifier->Verify(std::string(nist_test_vector.n.size(), '\xff'),
+                               nist_test_vector.message),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(RsaSsaPkcs1VerifyBoringSslTest, VerifyBatchOnExecutor) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+  SubtleUtilBoringSSL::RsaPublicKey pub_key{nist_test_vector.n,
+                                            nist_test_vector.e};
+  SubtleUtilBoringSSL::RsaSsaPkcs1Params params{nist_test_vector.sig_hash};
+  RsaVerifyOptions options;
+  options.precompute_montgomery = true;
+  options.executor = NewThreadPoolExecutor(3);
+  auto verifier =
+      RsaSsaPkcs1VerifyBoringSsl::New(pub_key, params, options).ValueOrDie();
+
+  std::vector<std::string> messages;
+  for (int i = 0; i < 64; i++) {
+    messages.push_back(nist_test_vector.message);
+    // Every third message is modified.
+    if (i % 3 == 0) messages.back()[i % messages.back().size()] ^= 1;
+  }
+  std::vector<absl::string_view> signatures(messages.size(),
+                                            nist_test_vector.signature);
+  std::vector<absl::string_view> data(messages.begin(), messages.end());
+  auto results_or = verifier->VerifyBatch(signatures, data);
+  ASSERT_THAT(results_or.status(), IsOk());
+  const std::vector<util::Status>& results = results_or.ValueOrDie();
+  ASSERT_EQ(results.size(), messages.size());
+  for (int i = 0; i < results.size(); i++) {
+    EXPECT_EQ(results[i].ok(), i % 3 != 0) << i;
+  }
+
+  EXPECT_THAT(verifier->VerifyBatch(signatures, absl::MakeSpan(data).subspan(1))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 // FIPS-only mode test
 TEST_F(RsaSsaPkcs1VerifyBoringSslTest, TestFipsFailWithoutBoringCrypto) {
   if (!kUseOnlyFips || FIPS_mode()) {
@@ -16,6 +16,9 @@
 
 #include "tink/subtle/rsa_ssa_pss_sign_boringssl.h"
 
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/memory/memory.h"
@@ -23,6 +26,8 @@
 #include "openssl/base.h"
 #include "openssl/evp.h"
 #include "openssl/rsa.h"
+#include "tink/subtle/digest_output_stream.h"
+#include "tink/subtle/rsa_private_key_pool.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 
 namespace crypto {
@@ -33,6 +38,17 @@ namespace subtle {
 util::StatusOr<std::unique_ptr<PublicKeySign>> RsaSsaPssSignBoringSsl::New(
     const SubtleUtilBoringSSL::RsaPrivateKey& private_key,
     const SubtleUtilBoringSSL::RsaSsaPssParams& params) {
+  return New(private_key, params, /*parallelism=*/1);
+}
+
+// static
+util::StatusOr<std::unique_ptr<PublicKeySign>> RsaSsaPssSignBoringSsl::New(
+    const SubtleUtilBoringSSL::RsaPrivateKey& private_key,
+    const SubtleUtilBoringSSL::RsaSsaPssParams& params, int parallelism) {
+  if (parallelism < 1) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "parallelism must be positive");
+  }
   auto status = CheckFipsCompatibility<RsaSsaPssSignBoringSsl>();
   if (!status.ok()) return status;
 
@@ -53,33 +69,77 @@ util::StatusOr<std::unique_ptr<PublicKeySign>> RsaSsaPssSignBoringSsl::New(
   }
 
   return {absl::WrapUnique(new RsaSsaPssSignBoringSsl(
-      std::move(rsa).ValueOrDie(), sig_hash.ValueOrDie(),
+      absl::make_unique<RsaPrivateKeyPool>(std::move(rsa).ValueOrDie(),
+                                           parallelism),
+      sig_hash.ValueOrDie(),
       mgf1_hash.ValueOrDie(), params.salt_length))};
 }
 
-RsaSsaPssSignBoringSsl::RsaSsaPssSignBoringSsl(bssl::UniquePtr<RSA> private_key,
-                                               const EVP_MD* sig_hash,
-                                               const EVP_MD* mgf1_hash,
-                                               int32_t salt_length)
-    : private_key_(std::move(private_key)),
+RsaSsaPssSignBoringSsl::RsaSsaPssSignBoringSsl(
+    std::unique_ptr<RsaPrivateKeyPool> private_keys, const EVP_MD* sig_hash,
+    const EVP_MD* mgf1_hash, int32_t salt_length)
+    : private_keys_(std::move(private_keys)),
       sig_hash_(sig_hash),
       mgf1_hash_(mgf1_hash),
       salt_length_(salt_length) {}
 
 util::StatusOr<std::string> RsaSsaPssSignBoringSsl::Sign(
     absl::string_view data) const {
+  return private_keys_->Sign(
+      data, [this](RSA* private_key, absl::string_view item) {
+        return SignWithKey(private_key, item);
+      });
+}
+
+util::StatusOr<std::vector<std::string>> RsaSsaPssSignBoringSsl::SignBatch(
+    absl::Span<const absl::string_view> data) const {
+  return private_keys_->SignBatch(
+      data, [this](RSA* private_key, absl::string_view item) {
+        return SignWithKey(private_key, item);
+      });
+}
+
+util::StatusOr<std::unique_ptr<OutputStreamWithResult<std::string>>>
+RsaSsaPssSignBoringSsl::NewSignOutputStream() const {
+  return DigestOutputStream<std::string>::New(
+      sig_hash_,
+      [this](absl::string_view digest) { return SignDigest(digest); });
+}
+
+util::StatusOr<std::string> RsaSsaPssSignBoringSsl::SignDigest(
+    absl::string_view digest) const {
+  if (digest.size() != EVP_MD_size(sig_hash_)) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Digest has the wrong size.");
+  }
+  return private_keys_->Sign(
+      digest, [this](RSA* private_key, absl::string_view item) {
+        return SignDigestWithKey(private_key, item);
+      });
+}
+
+util::StatusOr<std::string> RsaSsaPssSignBoringSsl::SignWithKey(
+    RSA* private_key, absl::string_view data) const {
   data = SubtleUtilBoringSSL::EnsureNonNull(data);
   auto digest_or = boringssl::ComputeHash(data, *sig_hash_);
   if (!digest_or.ok()) return digest_or.status();
   std::vector<uint8_t> digest = std::move(digest_or.ValueOrDie());
+  return SignDigestWithKey(
+      private_key,
+      absl::string_view(reinterpret_cast<const char*>(digest.data()),
+                        digest.size()));
+}
 
-  std::vector<uint8_t> signature(RSA_size(private_key_.get()));
+util::StatusOr<std::string> RsaSsaPssSignBoringSsl::SignDigestWithKey(
+    RSA* private_key, absl::string_view digest) const {
+  std::vector<uint8_t> signature(RSA_size(private_key));
   size_t signature_length;
 
-  if (RSA_sign_pss_mgf1(private_key_.get(),
+  if (RSA_sign_pss_mgf1(private_key,
                         /*out_len=*/&signature_length,
                         /*out=*/signature.data(), /*max_out=*/signature.size(),
-                        /*in=*/digest.data(), /*in_len=*/digest.size(),
+                        /*in=*/reinterpret_cast<const uint8_t*>(digest.data()),
+                        /*in_len=*/digest.size(),
                         /*md=*/sig_hash_,
                         /*mgf1_md=*/mgf1_hash_, salt_length_) != 1) {
     // TODO(b/112581512): Decide if it's safe to propagate the BoringSSL error.
@@ -18,14 +18,20 @@
 #define TINK_SUBTLE_RSA_SSA_PSS_SIGN_BORINGSSL_H_
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/base.h"
 #include "openssl/ec.h"
 #include "openssl/rsa.h"
 #include "tink/config/tink_fips.h"
+#include "tink/output_stream_with_result.h"
 #include "tink/public_key_sign.h"
+#include "tink/space_used.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/rsa_private_key_pool.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/statusor.h"
 
@@ -37,30 +43,57 @@ namespace subtle {
 // Signature Scheme) encoding is defined at
 // https://tools.ietf.org/html/rfc8017#section-8.1). This implemention uses
 // Boring SSL for the underlying cryptographic operations.
-class RsaSsaPssSignBoringSsl : public PublicKeySign {
+class RsaSsaPssSignBoringSsl : public PublicKeySign, public SpaceUsedInterface {
  public:
   static crypto::tink::util::StatusOr<std::unique_ptr<PublicKeySign>> New(
       const SubtleUtilBoringSSL::RsaPrivateKey& private_key,
       const SubtleUtilBoringSSL::RsaSsaPssParams& params);
 
+  // As above, but SignBatch() signs on up to 'parallelism' threads.  See
+  // RsaPrivateKeyPool for how concurrent signing operations are kept apart.
+  static crypto::tink::util::StatusOr<std::unique_ptr<PublicKeySign>> New(
+      const SubtleUtilBoringSSL::RsaPrivateKey& private_key,
+      const SubtleUtilBoringSSL::RsaSsaPssParams& params, int parallelism);
+
   // Computes the signature for 'data'.
   crypto::tink::util::StatusOr<std::string> Sign(
       absl::string_view data) const override;
 
+  crypto::tink::util::StatusOr<std::vector<std::string>> SignBatch(
+      absl::Span<const absl::string_view> data) const override;
+
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<OutputStreamWithResult<std::string>>>
+  NewSignOutputStream() const override;
+
+  // Computes the signature for data whose digest under the signature hash
+  // function is 'digest', for callers which have hashed the data already.
+  crypto::tink::util::StatusOr<std::string> SignDigest(
+      absl::string_view digest) const;
+
   ~RsaSsaPssSignBoringSsl() override = default;
 
+  size_t SpaceUsed() const override {
+    return sizeof(*this) + private_keys_->SpaceUsed();
+  }
+
   static constexpr crypto::tink::FipsCompatibility kFipsStatus =
       crypto::tink::FipsCompatibility::kRequiresBoringCrypto;
 
  private:
-  const bssl::UniquePtr<RSA> private_key_;
+  const std::unique_ptr<RsaPrivateKeyPool> private_keys_;
   const EVP_MD* sig_hash_;   // Owned by BoringSSL.
   const EVP_MD* mgf1_hash_;  // Owned by BoringSSL.
   int32_t salt_length_;
 
-  RsaSsaPssSignBoringSsl(bssl::UniquePtr<RSA> private_key,
+  RsaSsaPssSignBoringSsl(std::unique_ptr<RsaPrivateKeyPool> private_keys,
                          const EVP_MD* sig_hash, const EVP_MD* mgf1_hash,
                          int32_t salt_length);
+
+  crypto::tink::util::StatusOr<std::string> SignWithKey(
+      RSA* private_key, absl::string_view data) const;
+  crypto::tink::util::StatusOr<std::string> SignDigestWithKey(
+      RSA* private_key, absl::string_view digest) const;
 };
 
 }  // namespace subtle
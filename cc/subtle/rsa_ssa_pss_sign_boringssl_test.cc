@@ -16,14 +16,19 @@
 
 #include "tink/subtle/rsa_ssa_pss_sign_boringssl.h"
 
+#include <string>
+#include <vector>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
 #include "openssl/base.h"
 #include "openssl/bn.h"
 #include "openssl/rsa.h"
 #include "tink/subtle/rsa_ssa_pss_verify_boringssl.h"
 #include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/subtle/test_util.h"
 #include "tink/util/test_matchers.h"
 
 namespace crypto {
@@ -204,6 +209,67 @@ TEST_F(RsaPssSignBoringsslTest, TestAllowedFipsModuli) {
               IsOk());
 }
 
+TEST_F(RsaPssSignBoringsslTest, SignBatch) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+
+  SubtleUtilBoringSSL::RsaSsaPssParams params{/*sig_hash=*/HashType::SHA256,
+                                              /*mgf1_hash=*/HashType::SHA256,
+                                              /*salt_length=*/32};
+  auto signer_or =
+      RsaSsaPssSignBoringSsl::New(private_key_, params, /*parallelism=*/4);
+  ASSERT_THAT(signer_or.status(), IsOk());
+
+  std::vector<std::string> messages;
+  for (int i = 0; i < 10; i++) messages.push_back(absl::StrCat("data", i));
+  std::vector<absl::string_view> data(messages.begin(), messages.end());
+  auto signatures_or = signer_or.ValueOrDie()->SignBatch(data);
+  ASSERT_THAT(signatures_or.status(), IsOk());
+  const std::vector<std::string>& signatures = signatures_or.ValueOrDie();
+  ASSERT_EQ(signatures.size(), data.size());
+
+  auto verifier =
+      RsaSsaPssVerifyBoringSsl::New(public_key_, params).ValueOrDie();
+  for (size_t i = 0; i < data.size(); i++) {
+    EXPECT_THAT(verifier->Verify(signatures[i], data[i]), IsOk());
+  }
+}
+
+TEST_F(RsaPssSignBoringsslTest, StreamingSignAndVerify) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+
+  SubtleUtilBoringSSL::RsaSsaPssParams params{/*sig_hash=*/HashType::SHA256,
+                                              /*mgf1_hash=*/HashType::SHA256,
+                                              /*salt_length=*/32};
+  auto signer =
+      RsaSsaPssSignBoringSsl::New(private_key_, params).ValueOrDie();
+  auto verifier =
+      RsaSsaPssVerifyBoringSsl::New(public_key_, params).ValueOrDie();
+  std::string message(10000, 'm');
+
+  auto sign_stream_or = signer->NewSignOutputStream();
+  ASSERT_THAT(sign_stream_or.status(), IsOk());
+  auto sign_stream = std::move(sign_stream_or.ValueOrDie());
+  ASSERT_THAT(test::WriteToStream(sign_stream.get(), message), IsOk());
+  auto signature_or = sign_stream->GetResult();
+  ASSERT_THAT(signature_or.status(), IsOk());
+  EXPECT_THAT(verifier->Verify(signature_or.ValueOrDie(), message), IsOk());
+
+  auto verify_stream_or =
+      verifier->NewVerifyOutputStream(signature_or.ValueOrDie());
+  ASSERT_THAT(verify_stream_or.status(), IsOk());
+  auto verify_stream = std::move(verify_stream_or.ValueOrDie());
+  EXPECT_THAT(test::WriteToStream(verify_stream.get(), message), IsOk());
+
+  verify_stream =
+      verifier->NewVerifyOutputStream(signature_or.ValueOrDie()).ValueOrDie();
+  EXPECT_THAT(test::WriteToStream(verify_stream.get(), "bad message"),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 }  // namespace
 }  // namespace subtle
 }  // namespace tink
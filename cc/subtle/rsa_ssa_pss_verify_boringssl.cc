@@ -15,11 +15,19 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "tink/subtle/rsa_ssa_pss_verify_boringssl.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "absl/strings/str_cat.h"
 #include "openssl/bn.h"
 #include "openssl/evp.h"
 #include "openssl/rsa.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/digest_output_stream.h"
+#include "tink/subtle/rsa_public_key_context.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/errors.h"
 
@@ -32,9 +40,49 @@ util::StatusOr<std::unique_ptr<RsaSsaPssVerifyBoringSsl>>
 RsaSsaPssVerifyBoringSsl::New(
     const SubtleUtilBoringSSL::RsaPublicKey& pub_key,
     const SubtleUtilBoringSSL::RsaSsaPssParams& params) {
+  return New(pub_key, params, RsaVerifyOptions());
+}
+
+// static
+util::StatusOr<std::unique_ptr<RsaSsaPssVerifyBoringSsl>>
+RsaSsaPssVerifyBoringSsl::New(
+    bssl::UniquePtr<RSA> rsa,
+    const SubtleUtilBoringSSL::RsaSsaPssParams& params) {
+  return New(std::move(rsa), params, RsaVerifyOptions());
+}
+
+// static
+util::StatusOr<std::unique_ptr<RsaSsaPssVerifyBoringSsl>>
+RsaSsaPssVerifyBoringSsl::New(
+    const SubtleUtilBoringSSL::RsaPublicKey& pub_key,
+    const SubtleUtilBoringSSL::RsaSsaPssParams& params,
+    const RsaVerifyOptions& options) {
+  // The RSA modulus and exponent are checked as part of the conversion to
+  // bssl::UniquePtr<RSA>.
+  auto rsa = SubtleUtilBoringSSL::BoringSslRsaFromRsaPublicKey(pub_key);
+  if (!rsa.ok()) {
+    return rsa.status();
+  }
+  return New(std::move(rsa).ValueOrDie(), params, options);
+}
+
+// static
+util::StatusOr<std::unique_ptr<RsaSsaPssVerifyBoringSsl>>
+RsaSsaPssVerifyBoringSsl::New(
+    bssl::UniquePtr<RSA> rsa,
+    const SubtleUtilBoringSSL::RsaSsaPssParams& params,
+    const RsaVerifyOptions& options) {
   auto status = CheckFipsCompatibility<RsaSsaPssVerifyBoringSsl>();
   if (!status.ok()) return status;
 
+  if (rsa == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "rsa must be non-null");
+  }
+  auto modulus_status =
+      SubtleUtilBoringSSL::ValidateRsaModulusSize(RSA_bits(rsa.get()));
+  if (!modulus_status.ok()) return modulus_status;
+
   // Check hash.
   auto hash_status =
       SubtleUtilBoringSSL::ValidateSignatureHash(params.sig_hash);
@@ -48,16 +96,17 @@ RsaSsaPssVerifyBoringSsl::New(
   auto mgf1_hash_result = SubtleUtilBoringSSL::EvpHash(params.mgf1_hash);
   if (!mgf1_hash_result.ok()) return mgf1_hash_result.status();
 
-  // The RSA modulus and exponent are checked as part of the conversion to
-  // bssl::UniquePtr<RSA>.
-  auto rsa = SubtleUtilBoringSSL::BoringSslRsaFromRsaPublicKey(pub_key);
-  if (!rsa.ok()) {
-    return rsa.status();
+  std::unique_ptr<const RsaPublicKeyContext> public_key_context;
+  if (options.precompute_montgomery) {
+    auto context_result = RsaPublicKeyContext::New(*rsa);
+    if (!context_result.ok()) return context_result.status();
+    public_key_context = std::move(context_result.ValueOrDie());
   }
 
   std::unique_ptr<RsaSsaPssVerifyBoringSsl> verify(new RsaSsaPssVerifyBoringSsl(
-      std::move(rsa).ValueOrDie(), sig_hash_result.ValueOrDie(),
-      mgf1_hash_result.ValueOrDie(), params.salt_length));
+      std::move(rsa), sig_hash_result.ValueOrDie(),
+      mgf1_hash_result.ValueOrDie(), params.salt_length,
+      std::move(public_key_context), options.executor));
   return std::move(verify);
 }
 
@@ -70,10 +119,62 @@ util::Status RsaSsaPssVerifyBoringSsl::Verify(absl::string_view signature,
   auto digest_result = boringssl::ComputeHash(data, *sig_hash_);
   if (!digest_result.ok()) return digest_result.status();
   auto digest = std::move(digest_result.ValueOrDie());
+  return VerifyDigest(
+      signature,
+      absl::string_view(reinterpret_cast<const char*>(digest.data()),
+                        digest.size()));
+}
+
+util::StatusOr<std::vector<util::Status>> RsaSsaPssVerifyBoringSsl::VerifyBatch(
+    absl::Span<const absl::string_view> signatures,
+    absl::Span<const absl::string_view> data) const {
+  if (executor_ == nullptr || signatures.size() < 2 ||
+      signatures.size() != data.size()) {
+    return PublicKeyVerify::VerifyBatch(signatures, data);
+  }
+  std::vector<util::Status> results(signatures.size());
+  executor_->ParallelFor(signatures.size(), [&](int i) {
+    results[i] = Verify(signatures[i], data[i]);
+  });
+  return std::move(results);
+}
+
+util::StatusOr<std::unique_ptr<OutputStreamWithResult<util::Status>>>
+RsaSsaPssVerifyBoringSsl::NewVerifyOutputStream(
+    absl::string_view signature) const {
+  std::string signature_copy(signature);
+  return DigestOutputStream<util::Status>::New(
+      sig_hash_, [this, signature_copy](absl::string_view digest) {
+        return VerifyDigest(signature_copy, digest);
+      });
+}
+
+util::Status RsaSsaPssVerifyBoringSsl::VerifyDigest(
+    absl::string_view signature, absl::string_view digest) const {
+  if (digest.size() != EVP_MD_size(sig_hash_)) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Digest has the wrong size.");
+  }
+
+  if (public_key_context_ != nullptr) {
+    auto encoded_result = public_key_context_->PublicOperation(signature);
+    if (!encoded_result.ok()) return encoded_result.status();
+    if (1 != RSA_verify_PKCS1_PSS_mgf1(
+                 rsa_.get(), reinterpret_cast<const uint8_t*>(digest.data()),
+                 sig_hash_, mgf1_hash_,
+                 reinterpret_cast<const uint8_t*>(
+                     encoded_result.ValueOrDie().data()),
+                 salt_length_)) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Signature is not valid.");
+    }
+    return util::Status::OK;
+  }
 
   if (1 != RSA_verify_pss_mgf1(
-               rsa_.get(), digest.data(), digest.size(), sig_hash_, mgf1_hash_,
-               salt_length_, reinterpret_cast<const uint8_t*>(signature.data()),
+               rsa_.get(), reinterpret_cast<const uint8_t*>(digest.data()),
+               digest.size(), sig_hash_, mgf1_hash_, salt_length_,
+               reinterpret_cast<const uint8_t*>(signature.data()),
                signature.length())) {
     // Signature is invalid.
     return util::Status(util::error::INVALID_ARGUMENT,
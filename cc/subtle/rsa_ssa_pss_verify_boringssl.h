@@ -19,15 +19,20 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/evp.h"
 #include "openssl/rsa.h"
+#include "tink/output_stream_with_result.h"
 #include "tink/public_key_verify.h"
 #include "tink/config/tink_fips.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/rsa_public_key_context.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/status.h"
+#include "tink/util/statusor.h"
 
 namespace crypto {
 namespace tink {
@@ -43,27 +48,65 @@ class RsaSsaPssVerifyBoringSsl : public PublicKeyVerify {
   New(const SubtleUtilBoringSSL::RsaPublicKey& pub_key,
       const SubtleUtilBoringSSL::RsaSsaPssParams& params);
 
+  // Like New(pub_key, params), but takes the public key as a BoringSSL key,
+  // e.g. one returned by PemParser::ParseRsaPublicKeyToBoringSsl().
+  static crypto::tink::util::StatusOr<std::unique_ptr<RsaSsaPssVerifyBoringSsl>>
+  New(bssl::UniquePtr<RSA> rsa,
+      const SubtleUtilBoringSSL::RsaSsaPssParams& params);
+
+  // As above, with 'options'; see RsaVerifyOptions.
+  static crypto::tink::util::StatusOr<std::unique_ptr<RsaSsaPssVerifyBoringSsl>>
+  New(const SubtleUtilBoringSSL::RsaPublicKey& pub_key,
+      const SubtleUtilBoringSSL::RsaSsaPssParams& params,
+      const RsaVerifyOptions& options);
+  static crypto::tink::util::StatusOr<std::unique_ptr<RsaSsaPssVerifyBoringSsl>>
+  New(bssl::UniquePtr<RSA> rsa,
+      const SubtleUtilBoringSSL::RsaSsaPssParams& params,
+      const RsaVerifyOptions& options);
+
   // Verifies that 'signature' is a digital signature for 'data'.
   crypto::tink::util::Status Verify(absl::string_view signature,
                                     absl::string_view data) const override;
 
+  crypto::tink::util::StatusOr<std::vector<crypto::tink::util::Status>>
+  VerifyBatch(absl::Span<const absl::string_view> signatures,
+              absl::Span<const absl::string_view> data) const override;
+
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<OutputStreamWithResult<crypto::tink::util::Status>>>
+  NewVerifyOutputStream(absl::string_view signature) const override;
+
+  // Verifies that 'signature' is a digital signature for data whose digest
+  // under the signature hash function is 'digest', for callers which have
+  // hashed the data already.
+  crypto::tink::util::Status VerifyDigest(absl::string_view signature,
+                                          absl::string_view digest) const;
+
   ~RsaSsaPssVerifyBoringSsl() override = default;
 
   static constexpr crypto::tink::FipsCompatibility kFipsStatus =
       crypto::tink::FipsCompatibility::kRequiresBoringCrypto;
 
  private:
-  RsaSsaPssVerifyBoringSsl(bssl::UniquePtr<RSA> rsa, const EVP_MD* sig_hash,
-                           const EVP_MD* mgf1_hash, int salt_length)
+  RsaSsaPssVerifyBoringSsl(
+      bssl::UniquePtr<RSA> rsa, const EVP_MD* sig_hash,
+      const EVP_MD* mgf1_hash, int salt_length,
+      std::unique_ptr<const RsaPublicKeyContext> public_key_context,
+      std::shared_ptr<Executor> executor)
       : rsa_(std::move(rsa)),
         sig_hash_(sig_hash),
         mgf1_hash_(mgf1_hash),
-        salt_length_(salt_length) {}
+        salt_length_(salt_length),
+        public_key_context_(std::move(public_key_context)),
+        executor_(std::move(executor)) {}
 
   const bssl::UniquePtr<RSA> rsa_;
   const EVP_MD* const sig_hash_;   // Owned by BoringSSL.
   const EVP_MD* const mgf1_hash_;  // Owned by BoringSSL.
   int salt_length_;
+  // Set if the options ask for precomputed Montgomery contexts.
+  const std::unique_ptr<const RsaPublicKeyContext> public_key_context_;
+  const std::shared_ptr<Executor> executor_;
 };
 
 }  // namespace subtle
@@ -17,6 +17,7 @@
 #include "tink/subtle/rsa_ssa_pss_verify_boringssl.h"
 
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "absl/strings/escaping.h"
@@ -24,7 +25,9 @@
 #include "include/rapidjson/document.h"
 #include "tink/public_key_sign.h"
 #include "tink/public_key_verify.h"
+#include "tink/thread_pool_executor.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/rsa_public_key_context.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/subtle/wycheproof_util.h"
 #include "tink/util/status.h"
@@ -175,7 +178,7 @@ TEST_F(RsaSsaPssVerifyBoringSslTest, Modification) {
 }
 
 static util::StatusOr<std::unique_ptr<RsaSsaPssVerifyBoringSsl>> GetVerifier(
-    const rapidjson::Value& test_group) {
+    const rapidjson::Value& test_group, const RsaVerifyOptions& options) {
   SubtleUtilBoringSSL::RsaPublicKey key;
   key.n = WycheproofUtil::GetInteger(test_group["n"]);
   key.e = WycheproofUtil::GetInteger(test_group["e"]);
@@ -185,7 +188,7 @@ static util::StatusOr<std::unique_ptr<RsaSsaPssVerifyBoringSsl>> GetVerifier(
   params.mgf1_hash = WycheproofUtil::GetHashType(test_group["mgfSha"]);
   params.salt_length = test_group["sLen"].GetInt();
 
-  auto result = RsaSsaPssVerifyBoringSsl::New(key, params);
+  auto result = RsaSsaPssVerifyBoringSsl::New(key, params, options);
   if (!result.ok()) {
     std::cout << "Failed: " << result.status() << "\n";
   }
@@ -197,7 +200,8 @@ static util::StatusOr<std::unique_ptr<RsaSsaPssVerifyBoringSsl>> GetVerifier(
 // a verfier cannot be constructed. This option can be used for
 // if a file contains test vectors that are not necessarily supported
 // by tink.
-bool TestSignatures(const std::string& filename, bool allow_skipping) {
+bool TestSignatures(const std::string& filename, bool allow_skipping,
+                    const RsaVerifyOptions& options = RsaVerifyOptions()) {
   std::unique_ptr<rapidjson::Document> root =
       WycheproofUtil::ReadTestVectors(filename);
   std::cout << (*root)["algorithm"].GetString();
@@ -208,7 +212,7 @@ bool TestSignatures(const std::string& filename, bool allow_skipping) {
   int group_count = 0;
   for (const rapidjson::Value& test_group : (*root)["testGroups"].GetArray()) {
     group_count++;
-    auto verifier_result = GetVerifier(test_group);
+    auto verifier_result = GetVerifier(test_group, options);
     if (!verifier_result.ok()) {
       std::string type = test_group["type"].GetString();
       if (allow_skipping) {
@@ -305,6 +309,54 @@ TEST_F(RsaSsaPssVerifyBoringSslTest, WycheproofRsaPss4096Sha51232) {
                              /*allow_skipping=*/false));
 }
 
+TEST_F(RsaSsaPssVerifyBoringSslTest, WycheproofPrecomputedMontgomery) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+  RsaVerifyOptions options;
+  options.precompute_montgomery = true;
+  for (const std::string& filename :
+       {"rsa_pss_2048_sha256_mgf1_0_test.json",
+        "rsa_pss_2048_sha256_mgf1_32_test.json",
+        "rsa_pss_4096_sha512_mgf1_32_test.json"}) {
+    SCOPED_TRACE(filename);
+    EXPECT_TRUE(TestSignatures(filename, /*allow_skipping=*/false, options));
+  }
+}
+
+TEST_F(RsaSsaPssVerifyBoringSslTest, VerifyBatchOnExecutor) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Test not run in FIPS-only mode";
+  }
+  SubtleUtilBoringSSL::RsaPublicKey pub_key{nist_test_vector.n,
+                                            nist_test_vector.e};
+  SubtleUtilBoringSSL::RsaSsaPssParams params{nist_test_vector.sig_hash,
+                                              nist_test_vector.mgf1_hash,
+                                              nist_test_vector.salt_length};
+  RsaVerifyOptions options;
+  options.precompute_montgomery = true;
+  options.executor = NewThreadPoolExecutor(3);
+  auto verifier =
+      RsaSsaPssVerifyBoringSsl::New(pub_key, params, options).ValueOrDie();
+
+  std::vector<std::string> messages;
+  for (int i = 0; i < 64; i++) {
+    messages.push_back(nist_test_vector.message);
+    // Every third message is modified.
+    if (i % 3 == 0) messages.back()[i % messages.back().size()] ^= 1;
+  }
+  std::vector<absl::string_view> signatures(messages.size(),
+                                            nist_test_vector.signature);
+  std::vector<absl::string_view> data(messages.begin(), messages.end());
+  auto results_or = verifier->VerifyBatch(signatures, data);
+  ASSERT_THAT(results_or.status(), IsOk());
+  const std::vector<util::Status>& results = results_or.ValueOrDie();
+  ASSERT_EQ(results.size(), messages.size());
+  for (int i = 0; i < results.size(); i++) {
+    EXPECT_EQ(results[i].ok(), i % 3 != 0) << i;
+  }
+}
+
 // FIPS-only mode test
 TEST_F(RsaSsaPssVerifyBoringSslTest, TestFipsFailWithoutBoringCrypto) {
   if (!kUseOnlyFips || FIPS_mode()) {
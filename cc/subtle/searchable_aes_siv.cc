@@ -0,0 +1,87 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/searchable_aes_siv.h"
+
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "openssl/aes.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// static
+util::StatusOr<std::unique_ptr<SearchableAesSiv>> SearchableAesSiv::New(
+    std::unique_ptr<DeterministicAead> aes_siv,
+    const util::SecretData& token_key) {
+  auto status = CheckFipsCompatibility<SearchableAesSiv>();
+  if (!status.ok()) return status;
+
+  if (aes_siv == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "aes_siv must be non-null");
+  }
+  if (token_key.size() != kTokenKeySize) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "invalid token key size");
+  }
+  util::SecretUniquePtr<AES_KEY> aes_key = util::MakeSecretUniquePtr<AES_KEY>();
+  if (AES_set_encrypt_key(token_key.data(), 8 * token_key.size(),
+                          aes_key.get()) != 0) {
+    return util::Status(util::error::INTERNAL, "could not initialize aes key");
+  }
+  return {absl::WrapUnique(
+      new SearchableAesSiv(std::move(aes_siv), std::move(aes_key)))};
+}
+
+std::string SearchableAesSiv::TokenOf(absl::string_view ciphertext) const {
+  // AES-SIV ciphertexts start with the synthetic IV.
+  std::string token(kTokenSize, '\0');
+  AES_encrypt(reinterpret_cast<const uint8_t*>(ciphertext.data()),
+              reinterpret_cast<uint8_t*>(&token[0]), token_key_.get());
+  return token;
+}
+
+util::StatusOr<SearchableCiphertext> SearchableAesSiv::EncryptWithSearchToken(
+    absl::string_view plaintext, absl::string_view associated_data) const {
+  auto encrypt_result =
+      aes_siv_->EncryptDeterministically(plaintext, associated_data);
+  if (!encrypt_result.ok()) return encrypt_result.status();
+  SearchableCiphertext result;
+  result.ciphertext = std::move(encrypt_result.ValueOrDie());
+  if (result.ciphertext.size() < kTokenSize) {
+    return util::Status(util::error::INTERNAL, "ciphertext too short");
+  }
+  result.search_token = TokenOf(result.ciphertext);
+  return std::move(result);
+}
+
+util::StatusOr<std::string> SearchableAesSiv::ComputeSearchToken(
+    absl::string_view plaintext, absl::string_view associated_data) const {
+  auto encrypt_result = EncryptWithSearchToken(plaintext, associated_data);
+  if (!encrypt_result.ok()) return encrypt_result.status();
+  return std::move(encrypt_result.ValueOrDie().search_token);
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,123 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_SUBTLE_SEARCHABLE_AES_SIV_H_
+#define TINK_SUBTLE_SEARCHABLE_AES_SIV_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "openssl/aes.h"
+#include "tink/config/tink_fips.h"
+#include "tink/deterministic_aead.h"
+#include "tink/searchable_deterministic_aead.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// AES-SIV (RFC 5297) which also computes search tokens.
+//
+// The ciphertexts are those of AES-SIV. The search token of a plaintext is
+// the AES encryption, under a separate 256-bit token key, of its synthetic
+// IV, i.e. of the first 16 bytes of the AES-SIV ciphertext. The synthetic IV
+// is the S2V CMAC of the associated data and the plaintext, so the token is
+// a PRF of both, and costs a single AES block on top of the encryption.
+// Since the token key is independent of the AES-SIV key, tokens can not be
+// linked to the ciphertexts without it.
+//
+// ComputeSearchToken() encrypts the plaintext to get its synthetic IV; the
+// values looked up by queries are usually short.
+//
+// Thread safety: This class is thread safe and thus can be used
+// concurrently.
+class SearchableAesSiv : public DeterministicAead,
+                         public SearchableDeterministicAead {
+ public:
+  // 'aes_siv' is the AES-SIV primitive (AesSivBoringSsl or AesSivAesni),
+  // 'token_key' a 32 byte AES key which is only used for the tokens.
+  static crypto::tink::util::StatusOr<std::unique_ptr<SearchableAesSiv>> New(
+      std::unique_ptr<DeterministicAead> aes_siv,
+      const util::SecretData& token_key);
+
+  crypto::tink::util::StatusOr<std::string> EncryptDeterministically(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override {
+    return aes_siv_->EncryptDeterministically(plaintext, associated_data);
+  }
+
+  crypto::tink::util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override {
+    return aes_siv_->DecryptDeterministically(ciphertext, associated_data);
+  }
+
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override {
+    return aes_siv_->CiphertextSize(plaintext_size);
+  }
+
+  crypto::tink::util::Status EncryptDeterministicallyBatchInto(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::string_view associated_data,
+      absl::Span<const absl::Span<char>> ciphertext_buffers) const override {
+    return aes_siv_->EncryptDeterministicallyBatchInto(
+        plaintexts, associated_data, ciphertext_buffers);
+  }
+
+  crypto::tink::util::StatusOr<
+      std::unique_ptr<DeterministicAeadWithAssociatedData>>
+  WithAssociatedData(absl::string_view associated_data) const override {
+    return aes_siv_->WithAssociatedData(associated_data);
+  }
+
+  crypto::tink::util::StatusOr<SearchableCiphertext> EncryptWithSearchToken(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> ComputeSearchToken(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override;
+
+  static constexpr size_t kTokenKeySize = 32;
+  static constexpr size_t kTokenSize = 16;
+
+  static constexpr crypto::tink::FipsCompatibility kFipsStatus =
+      crypto::tink::FipsCompatibility::kNotFips;
+
+ private:
+  SearchableAesSiv(std::unique_ptr<DeterministicAead> aes_siv,
+                   util::SecretUniquePtr<AES_KEY> token_key)
+      : aes_siv_(std::move(aes_siv)), token_key_(std::move(token_key)) {}
+
+  // Returns the token of 'ciphertext', an AES-SIV ciphertext.
+  std::string TokenOf(absl::string_view ciphertext) const;
+
+  const std::unique_ptr<DeterministicAead> aes_siv_;
+  const util::SecretUniquePtr<AES_KEY> token_key_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_SEARCHABLE_AES_SIV_H_
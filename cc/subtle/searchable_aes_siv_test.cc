@@ -0,0 +1,110 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/searchable_aes_siv.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "openssl/aes.h"
+#include "tink/subtle/aes_siv_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::IsOkAndHolds;
+using ::testing::Eq;
+using ::testing::Ne;
+using ::testing::Not;
+using ::testing::SizeIs;
+
+std::unique_ptr<DeterministicAead> NewAesSiv(const util::SecretData& key) {
+  return std::move(AesSivBoringSsl::New(key).ValueOrDie());
+}
+
+TEST(SearchableAesSivTest, EncryptWithSearchToken) {
+  util::SecretData key = Random::GetRandomKeyBytes(64);
+  util::SecretData token_key = Random::GetRandomKeyBytes(32);
+  auto searchable_result = SearchableAesSiv::New(NewAesSiv(key), token_key);
+  ASSERT_THAT(searchable_result.status(), IsOk());
+  const SearchableAesSiv& searchable = *searchable_result.ValueOrDie();
+
+  auto result = searchable.EncryptWithSearchToken("value", "column");
+  ASSERT_THAT(result.status(), IsOk());
+  const std::string& ciphertext = result.ValueOrDie().ciphertext;
+  const std::string& token = result.ValueOrDie().search_token;
+  EXPECT_THAT(NewAesSiv(key)->EncryptDeterministically("value", "column"),
+              IsOkAndHolds(ciphertext));
+  EXPECT_THAT(searchable.EncryptDeterministically("value", "column"),
+              IsOkAndHolds(ciphertext));
+  EXPECT_THAT(searchable.DecryptDeterministically(ciphertext, "column"),
+              IsOkAndHolds("value"));
+
+  // The token is the synthetic IV, encrypted with the token key.
+  ASSERT_THAT(token, SizeIs(SearchableAesSiv::kTokenSize));
+  AES_KEY aes_key;
+  ASSERT_EQ(0, AES_set_encrypt_key(token_key.data(), 256, &aes_key));
+  std::string expected_token(16, '\0');
+  AES_encrypt(reinterpret_cast<const uint8_t*>(ciphertext.data()),
+              reinterpret_cast<uint8_t*>(&expected_token[0]), &aes_key);
+  EXPECT_THAT(token, Eq(expected_token));
+  EXPECT_THAT(token, Ne(ciphertext.substr(0, 16)));
+  EXPECT_THAT(searchable.ComputeSearchToken("value", "column"),
+              IsOkAndHolds(token));
+}
+
+TEST(SearchableAesSivTest, TokensDependOnPlaintextAndAssociatedData) {
+  auto searchable =
+      SearchableAesSiv::New(NewAesSiv(Random::GetRandomKeyBytes(64)),
+                            Random::GetRandomKeyBytes(32))
+          .ValueOrDie();
+  std::string token = searchable->ComputeSearchToken("value", "").ValueOrDie();
+  EXPECT_THAT(searchable->ComputeSearchToken("value", ""), IsOkAndHolds(token));
+  EXPECT_THAT(searchable->ComputeSearchToken("value2", ""),
+              Not(IsOkAndHolds(token)));
+  EXPECT_THAT(searchable->ComputeSearchToken("value", "ad"),
+              Not(IsOkAndHolds(token)));
+  EXPECT_THAT(searchable->ComputeSearchToken("", "").status(), IsOk());
+}
+
+TEST(SearchableAesSivTest, InvalidArguments) {
+  EXPECT_THAT(SearchableAesSiv::New(nullptr, Random::GetRandomKeyBytes(32))
+                  .status(),
+              Not(IsOk()));
+  for (int size : {0, 16, 31, 33, 64}) {
+    EXPECT_THAT(SearchableAesSiv::New(NewAesSiv(Random::GetRandomKeyBytes(64)),
+                                      Random::GetRandomKeyBytes(size))
+                    .status(),
+                Not(IsOk()))
+        << " for token key size " << size;
+  }
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
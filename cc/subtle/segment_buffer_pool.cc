@@ -0,0 +1,133 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/segment_buffer_pool.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cstdint>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "absl/hash/hash.h"
+#include "absl/synchronization/mutex.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+// Advises the kernel to back the huge-page-aligned part of the 'size' bytes
+// at 'data' with transparent huge pages.  The advice is best-effort, so
+// errors are ignored.
+void AdviseHugePages(uint8_t* data, size_t size) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  constexpr uintptr_t kMask = SegmentBufferPool::kHugePageSize - 1;
+  uintptr_t begin = (reinterpret_cast<uintptr_t>(data) + kMask) & ~kMask;
+  uintptr_t end = (reinterpret_cast<uintptr_t>(data) + size) & ~kMask;
+  if (begin < end) {
+    madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE);
+  }
+#endif
+}
+
+// Returns the NUMA node of the CPU the calling thread runs on, or 0 if it
+// is unknown.
+int CurrentNumaNode() {
+#if defined(__linux__) && defined(SYS_getcpu)
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return node % SegmentBufferPool::kMaxNumaNodes;
+  }
+#endif
+  return 0;
+}
+
+// Returns the NUMA node which holds the page at 'data', or the node of the
+// calling thread if it is unknown.
+int NumaNodeOf(const uint8_t* data) {
+#if defined(__linux__) && defined(SYS_get_mempolicy)
+  // MPOL_F_NODE | MPOL_F_ADDR of <linux/mempolicy.h>.
+  constexpr unsigned long kNodeOfAddress = 1 | 2;  // NOLINT(runtime/int)
+  int node = 0;
+  if (syscall(SYS_get_mempolicy, &node, nullptr, 0, data, kNodeOfAddress) ==
+      0) {
+    return node % SegmentBufferPool::kMaxNumaNodes;
+  }
+#endif
+  return CurrentNumaNode();
+}
+
+}  // namespace
+
+SegmentBufferPool::SegmentBufferPool(const Options& options)
+    : options_(options),
+      shards_(new Shard[kNumShards * (options.numa_aware ? kMaxNumaNodes
+                                                         : 1)]) {}
+
+SegmentBufferPool::Shard& SegmentBufferPool::ThreadShard(int numa_node) {
+  size_t hash = absl::Hash<std::thread::id>()(std::this_thread::get_id());
+  return shards_[numa_node * kNumShards + hash % kNumShards];
+}
+
+std::vector<uint8_t> SegmentBufferPool::Acquire(int capacity) {
+  int numa_node = options_.numa_aware ? CurrentNumaNode() : 0;
+  if (options_.max_buffers_per_shard > 0) {
+    Shard& shard = ThreadShard(numa_node);
+    absl::MutexLock lock(&shard.mutex);
+    for (int i = shard.buffers.size() - 1; i >= 0; i--) {
+      if (shard.buffers[i].capacity() >= capacity) {
+        std::vector<uint8_t> buffer;
+        buffer.swap(shard.buffers[i]);
+        shard.buffers[i].swap(shard.buffers.back());
+        shard.buffers.pop_back();
+        return buffer;
+      }
+    }
+  }
+  std::vector<uint8_t> buffer;
+  buffer.reserve(capacity);
+  if (options_.use_huge_pages) AdviseHugePages(buffer.data(), capacity);
+  if (options_.numa_aware) {
+    // Fault the pages in now, so that they are placed on the node of this
+    // thread rather than of the first one to write them.
+    buffer.resize(capacity);
+    buffer.clear();
+  }
+  return buffer;
+}
+
+void SegmentBufferPool::Release(std::vector<uint8_t> buffer) {
+  if (options_.max_buffers_per_shard <= 0 || buffer.capacity() == 0) return;
+  buffer.clear();
+  int numa_node = options_.numa_aware ? NumaNodeOf(buffer.data()) : 0;
+  Shard& shard = ThreadShard(numa_node);
+  absl::MutexLock lock(&shard.mutex);
+  if (shard.buffers.size() < options_.max_buffers_per_shard) {
+    shard.buffers.push_back(std::move(buffer));
+  }
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,101 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_SEGMENT_BUFFER_POOL_H_
+#define TINK_SUBTLE_SEGMENT_BUFFER_POOL_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// A pool of the segment buffers of streaming AEAD streams.
+//
+// Streams with large segments (e.g. several MiB) that are opened and closed
+// often spend much time allocating, zeroing and faulting in their buffers.
+// Streams that are created with a SegmentBufferPool acquire their buffers
+// from the pool and release them to it when they are destroyed, so that
+// the next stream reuses them.
+//
+// Released buffers are kept in free lists that are sharded by thread, so
+// that streams opened on the same thread reuse each other's buffers and
+// threads rarely contend for a free list.
+//
+// With Options::numa_aware, the free lists are moreover kept per NUMA node:
+// new buffers are faulted in by the acquiring thread, so that the kernel
+// places them on its node, and released buffers return to the free lists
+// of the node that holds them.  A stream that is processed on one node
+// thus never reuses a buffer of another node.
+//
+// Subclasses may override Acquire() and Release() to use another allocation
+// strategy.  This class is thread-safe, and so must be its subclasses.
+class SegmentBufferPool {
+ public:
+  struct Options {
+    // The maximum number of released buffers kept per shard; 0 disables
+    // recycling.
+    int max_buffers_per_shard = 4;
+    // If true, the kernel is advised to back buffers with transparent huge
+    // pages, where supported.  This only affects the parts of a buffer that
+    // are aligned to kHugePageSize, so it is effective for buffers of at
+    // least 2 * kHugePageSize bytes.
+    bool use_huge_pages = false;
+    // If true, buffers are kept per NUMA node, as described above.  This
+    // costs zeroing new buffers and a system call per Acquire() and
+    // Release(), which is only worthwhile for large buffers on hosts with
+    // several nodes.  Only supported on Linux; ignored elsewhere.
+    bool numa_aware = false;
+  };
+
+  static constexpr int kNumShards = 16;
+  // Nodes beyond this share the free lists of lower nodes.
+  static constexpr int kMaxNumaNodes = 8;
+  static constexpr int kHugePageSize = 2 << 20;
+
+  SegmentBufferPool() : SegmentBufferPool(Options()) {}
+  explicit SegmentBufferPool(const Options& options);
+  virtual ~SegmentBufferPool() {}
+
+  // Returns an empty buffer with a capacity of at least 'capacity' bytes.
+  virtual std::vector<uint8_t> Acquire(int capacity);
+
+  // Returns 'buffer', which need not come from Acquire(), to the pool.
+  virtual void Release(std::vector<uint8_t> buffer);
+
+ private:
+  struct Shard {
+    absl::Mutex mutex;
+    std::vector<std::vector<uint8_t>> buffers ABSL_GUARDED_BY(mutex);
+  };
+
+  // Returns the shard of the calling thread among those of 'numa_node'.
+  Shard& ThreadShard(int numa_node);
+
+  const Options options_;
+  std::unique_ptr<Shard[]> shards_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_SEGMENT_BUFFER_POOL_H_
@@ -0,0 +1,123 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/segment_buffer_pool.h"
+
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+TEST(SegmentBufferPoolTest, AcquireReturnsEmptyBuffer) {
+  SegmentBufferPool pool;
+  std::vector<uint8_t> buffer = pool.Acquire(1000);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_GE(buffer.capacity(), 1000);
+}
+
+TEST(SegmentBufferPoolTest, ReleasedBufferIsReused) {
+  SegmentBufferPool pool;
+  std::vector<uint8_t> buffer = pool.Acquire(1000);
+  buffer.resize(1000, 'x');
+  const uint8_t* data = buffer.data();
+  pool.Release(std::move(buffer));
+
+  // A larger buffer cannot be served from the released one.
+  std::vector<uint8_t> large = pool.Acquire(2000);
+  EXPECT_NE(data, large.data());
+  std::vector<uint8_t> reused = pool.Acquire(500);
+  EXPECT_EQ(data, reused.data());
+  EXPECT_TRUE(reused.empty());
+}
+
+TEST(SegmentBufferPoolTest, BoundedFreeList) {
+  SegmentBufferPool::Options options;
+  options.max_buffers_per_shard = 2;
+  SegmentBufferPool pool(options);
+  std::vector<std::vector<uint8_t>> buffers;
+  std::vector<const uint8_t*> data;
+  for (int i = 0; i < 3; i++) {
+    buffers.push_back(pool.Acquire(100));
+    data.push_back(buffers.back().data());
+  }
+  for (auto& buffer : buffers) pool.Release(std::move(buffer));
+  // Only the first two buffers were kept, and the most recently released
+  // one is reused first.
+  std::vector<uint8_t> first = pool.Acquire(100);
+  std::vector<uint8_t> second = pool.Acquire(100);
+  EXPECT_EQ(data[1], first.data());
+  EXPECT_EQ(data[0], second.data());
+}
+
+TEST(SegmentBufferPoolTest, HugePages) {
+  SegmentBufferPool::Options options;
+  options.use_huge_pages = true;
+  SegmentBufferPool pool(options);
+  int capacity = 3 * SegmentBufferPool::kHugePageSize;
+  std::vector<uint8_t> buffer = pool.Acquire(capacity);
+  EXPECT_GE(buffer.capacity(), capacity);
+  buffer.resize(capacity, 'x');
+  EXPECT_EQ('x', buffer.back());
+}
+
+TEST(SegmentBufferPoolTest, NumaAware) {
+  SegmentBufferPool::Options options;
+  options.numa_aware = true;
+  SegmentBufferPool pool(options);
+  std::vector<uint8_t> buffer = pool.Acquire(1 << 20);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_GE(buffer.capacity(), 1 << 20);
+  // The threads may move between nodes, so which buffers are reused is not
+  // deterministic; only that the per-node free lists are consistent is.
+  pool.Release(std::move(buffer));
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&pool]() {
+      for (int i = 0; i < 100; i++) {
+        std::vector<uint8_t> buffer = pool.Acquire(4096 + i % 10);
+        EXPECT_TRUE(buffer.empty());
+        buffer.resize(4096, 'x');
+        pool.Release(std::move(buffer));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+TEST(SegmentBufferPoolTest, ConcurrentUse) {
+  SegmentBufferPool pool;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&pool]() {
+      for (int i = 0; i < 1000; i++) {
+        std::vector<uint8_t> buffer = pool.Acquire(100 + i % 10);
+        buffer.resize(100, 'x');
+        pool.Release(std::move(buffer));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
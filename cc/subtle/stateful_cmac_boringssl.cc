@@ -14,76 +14,162 @@
 
 #include "tink/subtle/stateful_cmac_boringssl.h"
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
 #include "absl/memory/memory.h"
-#include "openssl/base.h"
-#include "tink/subtle/subtle_util_boringssl.h"
+#include "openssl/mem.h"
 #include "tink/util/status.h"
 
 namespace crypto {
 namespace tink {
 namespace subtle {
 
-util::StatusOr<std::unique_ptr<StatefulMac>> StatefulCmacBoringSsl::New(
-    uint32_t tag_size, const util::SecretData& key_value) {
-  const EVP_CIPHER* cipher;
-  switch (key_value.size()) {
-    case 16:
-      cipher = EVP_aes_128_cbc();
-      break;
-    case 32:
-      cipher = EVP_aes_256_cbc();
-      break;
-    default:
-      return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
+namespace {
+
+// Version of the format of ExportState():
+//   version || chaining value (16 bytes) || pending block (1 to 16 bytes)
+// where the pending block is empty only if no data was given.
+constexpr uint8_t kStateVersion = 1;
+
+// Multiplies 'block' by x in GF(2^128), as in the subkey derivation of
+// RFC 4493, section 2.3.
+void MultiplyByX(const uint8_t in[AES_BLOCK_SIZE],
+                 uint8_t out[AES_BLOCK_SIZE]) {
+  uint8_t carry = in[0] >> 7;
+  for (int i = 0; i < AES_BLOCK_SIZE - 1; i++) {
+    out[i] = (in[i] << 1) | (in[i + 1] >> 7);
+  }
+  out[AES_BLOCK_SIZE - 1] = (in[AES_BLOCK_SIZE - 1] << 1) ^ (carry * 0x87);
+}
+
+void XorBlock(const uint8_t* in, uint8_t* out) {
+  for (int i = 0; i < AES_BLOCK_SIZE; i++) out[i] ^= in[i];
+}
+
+}  // namespace
+
+// static
+util::Status StatefulCmacBoringSsl::NewKeys(uint32_t tag_size,
+                                            const util::SecretData& key_value,
+                                            Keys* keys) {
+  if (key_value.size() != kSmallKeySize && key_value.size() != kBigKeySize) {
+    return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
   }
   if (tag_size > kMaxTagSize) {
     return util::Status(util::error::INVALID_ARGUMENT, "invalid tag size");
   }
-
-  // Create and initialize the CMAC context
-  bssl::UniquePtr<CMAC_CTX> ctx(CMAC_CTX_new());
-
-  // Initialize the CMAC
-  if (!CMAC_Init(ctx.get(), key_value.data(), key_value.size(), cipher,
-                 nullptr /* engine */)) {
+  keys->tag_size = tag_size;
+  if (AES_set_encrypt_key(key_value.data(), 8 * key_value.size(),
+                          &keys->aes_key) != 0) {
     return util::Status(util::error::FAILED_PRECONDITION,
                         "CMAC initialization failed");
   }
+  uint8_t l[kBlockSize] = {0};
+  AES_encrypt(l, l, &keys->aes_key);
+  MultiplyByX(l, keys->k1);
+  MultiplyByX(keys->k1, keys->k2);
+  OPENSSL_cleanse(l, sizeof(l));
+  return util::OkStatus();
+}
 
-  return {
-      absl::WrapUnique(new StatefulCmacBoringSsl(tag_size, std::move(ctx)))};
+StatefulCmacBoringSsl::StatefulCmacBoringSsl(const Keys& keys)
+    : keys_(keys) {}
+
+StatefulCmacBoringSsl::~StatefulCmacBoringSsl() {
+  OPENSSL_cleanse(&keys_, sizeof(keys_));
+  OPENSSL_cleanse(chain_, sizeof(chain_));
+  OPENSSL_cleanse(pending_, sizeof(pending_));
+}
+
+util::StatusOr<std::unique_ptr<StatefulMac>> StatefulCmacBoringSsl::New(
+    uint32_t tag_size, const util::SecretData& key_value) {
+  Keys keys;
+  util::Status status = NewKeys(tag_size, key_value, &keys);
+  if (!status.ok()) return status;
+  auto mac = absl::WrapUnique(new StatefulCmacBoringSsl(keys));
+  OPENSSL_cleanse(&keys, sizeof(keys));
+  return {std::move(mac)};
 }
 
 util::Status StatefulCmacBoringSsl::Update(absl::string_view data) {
-  // BoringSSL expects a non-null pointer for data,
-  // regardless of whether the size is 0.
-  data = SubtleUtilBoringSSL::EnsureNonNull(data);
-
-  if (!CMAC_Update(cmac_context_.get(),
-                   reinterpret_cast<const uint8_t*>(data.data()),
-                   data.size())) {
-    return util::Status(util::error::INTERNAL, "Inputs to CMAC Update invalid");
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(data.data());
+  size_t size = data.size();
+  while (size > 0) {
+    // A full pending block is only encrypted once it is known not to be the
+    // last one.
+    if (pending_size_ == kBlockSize) {
+      XorBlock(pending_, chain_);
+      AES_encrypt(chain_, chain_, &keys_.aes_key);
+      pending_size_ = 0;
+    }
+    size_t fill = std::min(size, kBlockSize - pending_size_);
+    std::memcpy(pending_ + pending_size_, in, fill);
+    pending_size_ += fill;
+    in += fill;
+    size -= fill;
   }
   return util::OkStatus();
 }
 
 util::StatusOr<std::string> StatefulCmacBoringSsl::Finalize() {
-  uint8_t buf[EVP_MAX_MD_SIZE];
-  size_t out_len;
+  uint8_t last[kBlockSize];
+  std::memcpy(last, pending_, pending_size_);
+  if (pending_size_ == kBlockSize) {
+    XorBlock(keys_.k1, last);
+  } else {
+    last[pending_size_] = 0x80;
+    std::fill(last + pending_size_ + 1, last + kBlockSize, 0);
+    XorBlock(keys_.k2, last);
+  }
+  XorBlock(last, chain_);
+  AES_encrypt(chain_, chain_, &keys_.aes_key);
+  OPENSSL_cleanse(last, sizeof(last));
+  return std::string(reinterpret_cast<char*>(chain_), keys_.tag_size);
+}
 
-  if (!CMAC_Final(cmac_context_.get(), buf, &out_len)) {
-    return util::Status(util::error::INTERNAL, "CMAC finalization failed");
+util::StatusOr<util::SecretData> StatefulCmacBoringSsl::ExportState() const {
+  util::SecretData state(1 + kBlockSize + pending_size_);
+  state[0] = kStateVersion;
+  std::memcpy(state.data() + 1, chain_, kBlockSize);
+  std::memcpy(state.data() + 1 + kBlockSize, pending_, pending_size_);
+  return std::move(state);
+}
+
+// static
+util::StatusOr<std::unique_ptr<StatefulMac>> StatefulCmacBoringSsl::Resume(
+    const Keys& keys, const util::SecretData& state) {
+  if (state.size() < 1 + kBlockSize || state.size() > 1 + 2 * kBlockSize ||
+      state[0] != kStateVersion) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid CMAC state");
   }
-  return std::string(reinterpret_cast<char*>(buf), tag_size_);
+  auto mac = absl::WrapUnique(new StatefulCmacBoringSsl(keys));
+  std::memcpy(mac->chain_, state.data() + 1, kBlockSize);
+  mac->pending_size_ = state.size() - 1 - kBlockSize;
+  std::memcpy(mac->pending_, state.data() + 1 + kBlockSize,
+              mac->pending_size_);
+  return {std::move(mac)};
 }
 
 StatefulCmacBoringSslFactory::StatefulCmacBoringSslFactory(
     uint32_t tag_size, const util::SecretData& key_value)
-    : tag_size_(tag_size), key_value_(key_value) {}
+    : status_(StatefulCmacBoringSsl::NewKeys(tag_size, key_value, &keys_)) {}
+
+StatefulCmacBoringSslFactory::~StatefulCmacBoringSslFactory() {
+  OPENSSL_cleanse(&keys_, sizeof(keys_));
+}
 
 util::StatusOr<std::unique_ptr<StatefulMac>>
 StatefulCmacBoringSslFactory::Create() const {
-  return StatefulCmacBoringSsl::New(tag_size_, key_value_);
+  if (!status_.ok()) return status_;
+  return {absl::WrapUnique(new StatefulCmacBoringSsl(keys_))};
+}
+
+util::StatusOr<std::unique_ptr<StatefulMac>>
+StatefulCmacBoringSslFactory::Resume(const util::SecretData& state) const {
+  if (!status_.ok()) return status_;
+  return StatefulCmacBoringSsl::Resume(keys_, state);
 }
 
 }  // namespace subtle
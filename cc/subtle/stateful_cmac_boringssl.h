@@ -15,12 +15,13 @@
 #ifndef TINK_SUBTLE_STATEFUL_CMAC_BORINGSSL_H_
 #define TINK_SUBTLE_STATEFUL_CMAC_BORINGSSL_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <utility>
+#include <string>
 
-#include "openssl/base.h"
-#include "openssl/cmac.h"
-#include "openssl/evp.h"
+#include "absl/strings/string_view.h"
+#include "openssl/aes.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/mac/stateful_mac.h"
 #include "tink/util/secret_data.h"
@@ -32,35 +33,69 @@ namespace tink {
 namespace subtle {
 
 // A BoringSSL CMAC implementation of Stateful Mac interface.
+//
+// CMAC (RFC 4493) is computed with the AES block function of BoringSSL rather
+// than with a CMAC_CTX, whose state cannot be read, so that ExportState() can
+// write out the chaining value and the pending block.
 class StatefulCmacBoringSsl : public subtle::StatefulMac {
  public:
   // Key must be 16 or 32 bytes, all other sizes will be rejected.
   static util::StatusOr<std::unique_ptr<StatefulMac>> New(
       uint32_t tag_size, const util::SecretData& key_value);
+  ~StatefulCmacBoringSsl() override;
   util::Status Update(absl::string_view data) override;
   util::StatusOr<std::string> Finalize() override;
+  util::StatusOr<util::SecretData> ExportState() const override;
 
  private:
   static constexpr size_t kSmallKeySize = 16;
   static constexpr size_t kBigKeySize = 32;
   static constexpr size_t kMaxTagSize = 16;
+  static constexpr size_t kBlockSize = AES_BLOCK_SIZE;
+
+  friend class StatefulCmacBoringSslFactory;
+
+  // The expanded AES key and the two CMAC subkeys.
+  struct Keys {
+    uint32_t tag_size;
+    AES_KEY aes_key;
+    uint8_t k1[kBlockSize];
+    uint8_t k2[kBlockSize];
+  };
+
+  explicit StatefulCmacBoringSsl(const Keys& keys);
+
+  // Validates the parameters and derives '*keys' from 'key_value'.
+  static util::Status NewKeys(uint32_t tag_size,
+                              const util::SecretData& key_value, Keys* keys);
 
-  StatefulCmacBoringSsl(uint32_t tag_size, bssl::UniquePtr<CMAC_CTX> ctx)
-      : cmac_context_(std::move(ctx)), tag_size_(tag_size) {}
+  // Returns a StatefulCmacBoringSsl with 'keys', in 'state'.
+  static util::StatusOr<std::unique_ptr<StatefulMac>> Resume(
+      const Keys& keys, const util::SecretData& state);
 
-  const bssl::UniquePtr<CMAC_CTX> cmac_context_;
-  const uint32_t tag_size_;
+  Keys keys_;
+  uint8_t chain_[kBlockSize] = {0};
+  // The last block, which is only encrypted once more data follows, since
+  // the last block is masked with a subkey first.
+  uint8_t pending_[kBlockSize];
+  size_t pending_size_ = 0;
 };
 
+// Sets up the CMAC key once; every StatefulMac it creates starts from a copy
+// of the keys.
 class StatefulCmacBoringSslFactory : public subtle::StatefulMacFactory {
  public:
   StatefulCmacBoringSslFactory(uint32_t tag_size,
                                const util::SecretData& key_value);
+  ~StatefulCmacBoringSslFactory() override;
   util::StatusOr<std::unique_ptr<StatefulMac>> Create() const override;
+  util::StatusOr<std::unique_ptr<StatefulMac>> Resume(
+      const util::SecretData& state) const override;
 
  private:
-  const uint32_t tag_size_;
-  const util::SecretData key_value_;
+  // Error from deriving the keys in the constructor, returned by Create().
+  util::Status status_;
+  StatefulCmacBoringSsl::Keys keys_;
 };
 
 }  // namespace subtle
@@ -171,6 +171,67 @@ TEST(StatefulCmacFactoryTest, createsObjects) {
   EXPECT_THAT(output, StrEq(expected));
 }
 
+TEST(StatefulCmacBoringSslTest, testRfc4493Vectors) {
+  std::string key(test::HexDecodeOrDie("2b7e151628aed2a6abf7158809cf4f3c"));
+  std::string data(test::HexDecodeOrDie(
+      "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+      "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710"));
+  BasicCmac(kTagSize, key, data.substr(0, 16),
+            test::HexDecodeOrDie("070a16b46b4d4144f79bdd9dd04a287c"));
+  BasicCmac(kTagSize, key, data.substr(0, 40),
+            test::HexDecodeOrDie("dfa66747de9ae63030ca32611497c827"));
+  BasicCmac(kTagSize, key, data,
+            test::HexDecodeOrDie("51f0bebf7e3b9d92fc49741779363cfe"));
+}
+
+TEST(StatefulCmacFactoryTest, resumesExportedState) {
+  util::SecretData key = util::SecretDataFromStringView(std::string(32, 'k'));
+  std::string data(100, 'd');
+  for (int i = 0; i < data.size(); i++) data[i] = static_cast<char>(i * 7);
+  StatefulCmacBoringSslFactory factory(kTagSize, key);
+  auto expected_or = factory.Create();
+  ASSERT_THAT(expected_or.status(), IsOk());
+  ASSERT_THAT(expected_or.ValueOrDie()->Update(data), IsOk());
+  std::string expected = expected_or.ValueOrDie()->Finalize().ValueOrDie();
+
+  // Split the data before, at, and after block boundaries.
+  for (size_t split : {0, 1, 15, 16, 17, 32, 33, 100}) {
+    SCOPED_TRACE(split);
+    auto first_or = factory.Create();
+    ASSERT_THAT(first_or.status(), IsOk());
+    ASSERT_THAT(first_or.ValueOrDie()->Update(data.substr(0, split)), IsOk());
+    auto state_or = first_or.ValueOrDie()->ExportState();
+    ASSERT_THAT(state_or.status(), IsOk());
+
+    auto second_or = factory.Resume(state_or.ValueOrDie());
+    ASSERT_THAT(second_or.status(), IsOk());
+    ASSERT_THAT(second_or.ValueOrDie()->Update(data.substr(split)), IsOk());
+    auto output_or = second_or.ValueOrDie()->Finalize();
+    ASSERT_THAT(output_or.status(), IsOk());
+    EXPECT_THAT(output_or.ValueOrDie(), StrEq(expected));
+  }
+}
+
+TEST(StatefulCmacFactoryTest, rejectsInvalidState) {
+  util::SecretData key = util::SecretDataFromStringView(std::string(16, 'k'));
+  StatefulCmacBoringSslFactory factory(kTagSize, key);
+  auto cmac = factory.Create().ValueOrDie();
+  ASSERT_THAT(cmac->Update("Some data to test."), IsOk());
+  util::SecretData state = cmac->ExportState().ValueOrDie();
+
+  util::SecretData truncated(state.begin(), state.begin() + 10);
+  EXPECT_THAT(factory.Resume(truncated).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  util::SecretData too_long(state);
+  too_long.resize(1 + 2 * 16 + 1);
+  EXPECT_THAT(factory.Resume(too_long).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  util::SecretData bad_version(state);
+  bad_version[0] ^= 1;
+  EXPECT_THAT(factory.Resume(bad_version).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 // Test with test vectors from Wycheproof project.
 bool WycheproofTest(const rapidjson::Document &root) {
   int errors = 0;
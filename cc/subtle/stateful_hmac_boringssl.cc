@@ -14,23 +14,155 @@
 
 #include "tink/subtle/stateful_hmac_boringssl.h"
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
 #include "absl/memory/memory.h"
-#include "openssl/base.h"
-#include "tink/subtle/subtle_util_boringssl.h"
+#include "openssl/mem.h"
+#include "openssl/sha.h"
 #include "tink/util/status.h"
 
 namespace crypto {
 namespace tink {
 namespace subtle {
 
-util::StatusOr<std::unique_ptr<StatefulMac>> StatefulHmacBoringSsl::New(
-    HashType hash_type, uint32_t tag_size, const util::SecretData& key_value) {
-  util::StatusOr<const EVP_MD*> res = SubtleUtilBoringSSL::EvpHash(hash_type);
-  if (!res.ok()) {
-    return res.status();
+namespace {
+
+// Version of the format of ExportState():
+//   version || hash type || hashed size (8 bytes) || chaining value || pending
+// where all integers are little-endian and the chaining value are the 8 words
+// of the inner SHA-256 or SHA-512 context, of 4 or 8 bytes each.
+constexpr uint8_t kStateVersion = 1;
+constexpr size_t kStateHeaderSize = 2 + 8;
+
+void PutUint64(uint64_t value, size_t size, uint8_t* out) {
+  for (size_t i = 0; i < size; i++) {
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+uint64_t GetUint64(const uint8_t* in, size_t size) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; i++) {
+    value |= static_cast<uint64_t>(in[i]) << (8 * i);
+  }
+  return value;
+}
+
+}  // namespace
+
+// static
+size_t StatefulHmacBoringSsl::BlockSize(HashType hash_type) {
+  switch (hash_type) {
+    case SHA1:
+      return SHA_CBLOCK;
+    case SHA224:
+    case SHA256:
+      return SHA256_CBLOCK;
+    case SHA384:
+    case SHA512:
+      return SHA512_CBLOCK;
+    default:
+      return 0;
+  }
+}
+
+// static
+size_t StatefulHmacBoringSsl::DigestSize(HashType hash_type) {
+  switch (hash_type) {
+    case SHA1:
+      return SHA_DIGEST_LENGTH;
+    case SHA224:
+      return SHA224_DIGEST_LENGTH;
+    case SHA256:
+      return SHA256_DIGEST_LENGTH;
+    case SHA384:
+      return SHA384_DIGEST_LENGTH;
+    case SHA512:
+      return SHA512_DIGEST_LENGTH;
+    default:
+      return 0;
+  }
+}
+
+// static
+void StatefulHmacBoringSsl::HashInit(HashType hash_type,
+                                     HashContext* context) {
+  switch (hash_type) {
+    case SHA1:
+      SHA1_Init(&context->sha1);
+      break;
+    case SHA224:
+      SHA224_Init(&context->sha256);
+      break;
+    case SHA256:
+      SHA256_Init(&context->sha256);
+      break;
+    case SHA384:
+      SHA384_Init(&context->sha512);
+      break;
+    default:
+      SHA512_Init(&context->sha512);
+      break;
+  }
+}
+
+// static
+void StatefulHmacBoringSsl::HashUpdate(HashType hash_type,
+                                       HashContext* context,
+                                       const uint8_t* data, size_t size) {
+  switch (hash_type) {
+    case SHA1:
+      SHA1_Update(&context->sha1, data, size);
+      break;
+    case SHA224:
+      SHA224_Update(&context->sha256, data, size);
+      break;
+    case SHA256:
+      SHA256_Update(&context->sha256, data, size);
+      break;
+    case SHA384:
+      SHA384_Update(&context->sha512, data, size);
+      break;
+    default:
+      SHA512_Update(&context->sha512, data, size);
+      break;
+  }
+}
+
+// static
+void StatefulHmacBoringSsl::HashFinal(HashType hash_type,
+                                      HashContext* context, uint8_t* digest) {
+  switch (hash_type) {
+    case SHA1:
+      SHA1_Final(digest, &context->sha1);
+      break;
+    case SHA224:
+      SHA224_Final(digest, &context->sha256);
+      break;
+    case SHA256:
+      SHA256_Final(digest, &context->sha256);
+      break;
+    case SHA384:
+      SHA384_Final(digest, &context->sha512);
+      break;
+    default:
+      SHA512_Final(digest, &context->sha512);
+      break;
+  }
+}
+
+// static
+util::Status StatefulHmacBoringSsl::NewKeyedContexts(
+    HashType hash_type, uint32_t tag_size, const util::SecretData& key_value,
+    KeyedContexts* keyed) {
+  size_t block_size = BlockSize(hash_type);
+  if (block_size == 0) {
+    return util::Status(util::error::UNIMPLEMENTED,
+                        "Unsupported hash function for HMAC");
   }
-  const EVP_MD* md = res.ValueOrDie();
-  if (EVP_MD_size(md) < tag_size) {
+  if (DigestSize(hash_type) < tag_size) {
     // The key manager is responsible to security policies.
     // The checks here just ensure the preconditions of the primitive.
     // If this fails then something is wrong with the key manager.
@@ -39,50 +171,183 @@ util::StatusOr<std::unique_ptr<StatefulMac>> StatefulHmacBoringSsl::New(
   if (key_value.size() < kMinKeySize) {
     return util::Status(util::error::INVALID_ARGUMENT, "invalid key size");
   }
+  keyed->hash_type = hash_type;
+  keyed->tag_size = tag_size;
 
-  // Create and initialize the HMAC context
-  bssl::UniquePtr<HMAC_CTX> ctx(HMAC_CTX_new());
-  // Initialize the HMAC
-  if (!HMAC_Init(ctx.get(), key_value.data(), key_value.size(), md)) {
-    return util::Status(util::error::FAILED_PRECONDITION,
-                        "HMAC initialization failed");
+  // Keys longer than a block are hashed first (RFC 2104, section 2).
+  uint8_t block[kMaxBlockSize] = {0};
+  if (key_value.size() > block_size) {
+    HashInit(hash_type, &keyed->inner);
+    HashUpdate(hash_type, &keyed->inner, key_value.data(), key_value.size());
+    HashFinal(hash_type, &keyed->inner, block);
+  } else {
+    std::memcpy(block, key_value.data(), key_value.size());
   }
+  for (size_t i = 0; i < block_size; i++) block[i] ^= 0x36;
+  HashInit(hash_type, &keyed->inner);
+  HashUpdate(hash_type, &keyed->inner, block, block_size);
+  for (size_t i = 0; i < block_size; i++) block[i] ^= 0x36 ^ 0x5c;
+  HashInit(hash_type, &keyed->outer);
+  HashUpdate(hash_type, &keyed->outer, block, block_size);
+  OPENSSL_cleanse(block, sizeof(block));
+  return util::OkStatus();
+}
 
-  return std::unique_ptr<StatefulMac>(
-      new StatefulHmacBoringSsl(tag_size, std::move(ctx)));
+StatefulHmacBoringSsl::StatefulHmacBoringSsl(const KeyedContexts& keyed)
+    : hash_type_(keyed.hash_type),
+      tag_size_(keyed.tag_size),
+      block_size_(BlockSize(keyed.hash_type)),
+      inner_(keyed.inner),
+      outer_(keyed.outer) {}
+
+StatefulHmacBoringSsl::~StatefulHmacBoringSsl() {
+  OPENSSL_cleanse(&inner_, sizeof(inner_));
+  OPENSSL_cleanse(&outer_, sizeof(outer_));
+  OPENSSL_cleanse(pending_, sizeof(pending_));
 }
 
-util::Status StatefulHmacBoringSsl::Update(absl::string_view data) {
-  // BoringSSL expects a non-null pointer for data,
-  // regardless of whether the size is 0.
-  data = SubtleUtilBoringSSL::EnsureNonNull(data);
+util::StatusOr<std::unique_ptr<StatefulMac>> StatefulHmacBoringSsl::New(
+    HashType hash_type, uint32_t tag_size, const util::SecretData& key_value) {
+  KeyedContexts keyed;
+  util::Status status =
+      NewKeyedContexts(hash_type, tag_size, key_value, &keyed);
+  if (!status.ok()) return status;
+  auto mac = absl::WrapUnique(new StatefulHmacBoringSsl(keyed));
+  OPENSSL_cleanse(&keyed, sizeof(keyed));
+  return std::unique_ptr<StatefulMac>(std::move(mac));
+}
 
-  if (!HMAC_Update(hmac_context_.get(),
-                   reinterpret_cast<const uint8_t*>(data.data()),
-                   data.size())) {
-    return util::Status(util::error::FAILED_PRECONDITION,
-                        "Inputs to HMAC Update invalid");
+util::Status StatefulHmacBoringSsl::Update(absl::string_view data) {
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(data.data());
+  size_t size = data.size();
+  // Complete the pending block first; the inner hash only gets whole blocks.
+  if (pending_size_ > 0) {
+    size_t fill = std::min(size, block_size_ - pending_size_);
+    std::memcpy(pending_ + pending_size_, in, fill);
+    pending_size_ += fill;
+    in += fill;
+    size -= fill;
+    if (pending_size_ < block_size_) return util::OkStatus();
+    HashUpdate(hash_type_, &inner_, pending_, block_size_);
+    hashed_size_ += block_size_;
+    pending_size_ = 0;
+  }
+  size_t whole_blocks_size = size - size % block_size_;
+  if (whole_blocks_size > 0) {
+    HashUpdate(hash_type_, &inner_, in, whole_blocks_size);
+    hashed_size_ += whole_blocks_size;
+    in += whole_blocks_size;
+    size -= whole_blocks_size;
+  }
+  if (size > 0) {
+    std::memcpy(pending_, in, size);
+    pending_size_ = size;
   }
   return util::OkStatus();
 }
 
 util::StatusOr<std::string> StatefulHmacBoringSsl::Finalize() {
-  uint8_t buf[EVP_MAX_MD_SIZE];
-  unsigned int out_len;
+  uint8_t digest[SHA512_DIGEST_LENGTH];
+  if (pending_size_ > 0) {
+    HashUpdate(hash_type_, &inner_, pending_, pending_size_);
+  }
+  HashFinal(hash_type_, &inner_, digest);
+  HashUpdate(hash_type_, &outer_, digest, DigestSize(hash_type_));
+  HashFinal(hash_type_, &outer_, digest);
+  return std::string(reinterpret_cast<char*>(digest), tag_size_);
+}
+
+util::StatusOr<util::SecretData> StatefulHmacBoringSsl::ExportState() const {
+  // The chaining value of SHA_CTX is not laid out alike in BoringSSL and
+  // OpenSSL, so that HMAC-SHA1 does not export its state.
+  if (hash_type_ == SHA1) {
+    return util::Status(util::error::UNIMPLEMENTED,
+                        "HMAC-SHA1 cannot export its state");
+  }
+  size_t word_size = block_size_ / 16;
+  util::SecretData state(kStateHeaderSize + 8 * word_size + pending_size_);
+  uint8_t* out = state.data();
+  out[0] = kStateVersion;
+  out[1] = static_cast<uint8_t>(hash_type_);
+  PutUint64(hashed_size_, 8, out + 2);
+  out += kStateHeaderSize;
+  for (int i = 0; i < 8; i++) {
+    uint64_t word = word_size == 4 ? inner_.sha256.h[i] : inner_.sha512.h[i];
+    PutUint64(word, word_size, out);
+    out += word_size;
+  }
+  std::memcpy(out, pending_, pending_size_);
+  return std::move(state);
+}
 
-  if (!HMAC_Final(hmac_context_.get(), buf, &out_len)) {
-    return util::Status(util::error::INTERNAL, "HMAC finalization failed");
+// static
+util::StatusOr<std::unique_ptr<StatefulMac>> StatefulHmacBoringSsl::Resume(
+    const KeyedContexts& keyed, const util::SecretData& state) {
+  HashType hash_type = keyed.hash_type;
+  size_t block_size = BlockSize(hash_type);
+  size_t word_size = block_size / 16;
+  if (hash_type == SHA1) {
+    return util::Status(util::error::UNIMPLEMENTED,
+                        "HMAC-SHA1 cannot resume from a state");
+  }
+  if (state.size() < kStateHeaderSize + 8 * word_size ||
+      state.size() >= kStateHeaderSize + 8 * word_size + block_size ||
+      state[0] != kStateVersion) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid HMAC state");
   }
-  return std::string(reinterpret_cast<char*>(buf), tag_size_);
+  if (state[1] != static_cast<uint8_t>(hash_type)) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "HMAC state is for another hash function");
+  }
+  uint64_t hashed_size = GetUint64(state.data() + 2, 8);
+  // The length of the inner hash, with the key block, must fit into 2^61
+  // bytes for the bit count to fit into the 64 bits of SHA-256.
+  if (hashed_size % block_size != 0 || hashed_size >= (uint64_t{1} << 60)) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid HMAC state");
+  }
+
+  auto mac = absl::WrapUnique(new StatefulHmacBoringSsl(keyed));
+  HashInit(hash_type, &mac->inner_);
+  const uint8_t* in = state.data() + kStateHeaderSize;
+  uint64_t bits = (block_size + hashed_size) * 8;
+  if (word_size == 4) {
+    for (int i = 0; i < 8; i++, in += 4) {
+      mac->inner_.sha256.h[i] = static_cast<uint32_t>(GetUint64(in, 4));
+    }
+    mac->inner_.sha256.Nl = static_cast<uint32_t>(bits);
+    mac->inner_.sha256.Nh = static_cast<uint32_t>(bits >> 32);
+  } else {
+    for (int i = 0; i < 8; i++, in += 8) {
+      mac->inner_.sha512.h[i] = GetUint64(in, 8);
+    }
+    mac->inner_.sha512.Nl = bits;
+    mac->inner_.sha512.Nh = 0;
+  }
+  mac->hashed_size_ = hashed_size;
+  mac->pending_size_ = state.data() + state.size() - in;
+  std::memcpy(mac->pending_, in, mac->pending_size_);
+  return std::unique_ptr<StatefulMac>(std::move(mac));
 }
 
 StatefulHmacBoringSslFactory::StatefulHmacBoringSslFactory(
     HashType hash_type, uint32_t tag_size, const util::SecretData& key_value)
-    : hash_type_(hash_type), tag_size_(tag_size), key_value_(key_value) {}
+    : status_(StatefulHmacBoringSsl::NewKeyedContexts(hash_type, tag_size,
+                                                      key_value, &keyed_)) {}
+
+StatefulHmacBoringSslFactory::~StatefulHmacBoringSslFactory() {
+  OPENSSL_cleanse(&keyed_, sizeof(keyed_));
+}
 
 util::StatusOr<std::unique_ptr<StatefulMac>>
 StatefulHmacBoringSslFactory::Create() const {
-  return StatefulHmacBoringSsl::New(hash_type_, tag_size_, key_value_);
+  if (!status_.ok()) return status_;
+  return std::unique_ptr<StatefulMac>(new StatefulHmacBoringSsl(keyed_));
+}
+
+util::StatusOr<std::unique_ptr<StatefulMac>>
+StatefulHmacBoringSslFactory::Resume(const util::SecretData& state) const {
+  if (!status_.ok()) return status_;
+  return StatefulHmacBoringSsl::Resume(keyed_, state);
 }
 
 }  // namespace subtle
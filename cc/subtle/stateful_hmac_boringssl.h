@@ -15,9 +15,13 @@
 #ifndef TINK_SUBTLE_STATEFUL_HMAC_BORINGSSL_H_
 #define TINK_SUBTLE_STATEFUL_HMAC_BORINGSSL_H_
 
-#include "openssl/base.h"
-#include "openssl/evp.h"
-#include "openssl/hmac.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "openssl/sha.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/mac/stateful_mac.h"
 #include "tink/util/secret_data.h"
@@ -29,34 +33,91 @@ namespace tink {
 namespace subtle {
 
 // A BoringSSL HMAC implementation of Stateful Mac interface.
+//
+// HMAC is computed with the SHA contexts of BoringSSL rather than with an
+// HMAC_CTX, whose state cannot be read.  The inner hash only gets whole
+// blocks, so that its state is the chaining value and the length, which
+// ExportState() writes out for SHA-224, SHA-256, SHA-384 and SHA-512.
 class StatefulHmacBoringSsl : public subtle::StatefulMac {
  public:
   static util::StatusOr<std::unique_ptr<StatefulMac>> New(
       HashType hash_type, uint32_t tag_size, const util::SecretData& key_value);
+  ~StatefulHmacBoringSsl() override;
   util::Status Update(absl::string_view data) override;
   util::StatusOr<std::string> Finalize() override;
+  util::StatusOr<util::SecretData> ExportState() const override;
 
  private:
   // Minimum HMAC key size in bytes.
   static constexpr size_t kMinKeySize = 16;
+  static constexpr size_t kMaxBlockSize = SHA512_CBLOCK;
+
+  friend class StatefulHmacBoringSslFactory;
+
+  union HashContext {
+    SHA_CTX sha1;
+    SHA256_CTX sha256;
+    SHA512_CTX sha512;
+  };
+
+  // The hash contexts after the inner and the outer padded key.
+  struct KeyedContexts {
+    HashType hash_type;
+    uint32_t tag_size;
+    HashContext inner;
+    HashContext outer;
+  };
+
+  explicit StatefulHmacBoringSsl(const KeyedContexts& keyed);
 
-  StatefulHmacBoringSsl(uint32_t tag_size, bssl::UniquePtr<HMAC_CTX> ctx)
-      : hmac_context_(std::move(ctx)), tag_size_(tag_size) {}
+  // Validates the parameters and hashes the padded 'key_value' into
+  // '*keyed'.
+  static util::Status NewKeyedContexts(HashType hash_type, uint32_t tag_size,
+                                       const util::SecretData& key_value,
+                                       KeyedContexts* keyed);
 
-  const bssl::UniquePtr<HMAC_CTX> hmac_context_;
+  // Returns a StatefulHmacBoringSsl with the key of 'keyed', in 'state'.
+  static util::StatusOr<std::unique_ptr<StatefulMac>> Resume(
+      const KeyedContexts& keyed, const util::SecretData& state);
+
+  // Returns the block size or the digest size of 'hash_type', or 0 if it is
+  // not supported.
+  static size_t BlockSize(HashType hash_type);
+  static size_t DigestSize(HashType hash_type);
+
+  static void HashInit(HashType hash_type, HashContext* context);
+  static void HashUpdate(HashType hash_type, HashContext* context,
+                         const uint8_t* data, size_t size);
+  static void HashFinal(HashType hash_type, HashContext* context,
+                        uint8_t* digest);
+
+  const HashType hash_type_;
   const uint32_t tag_size_;
+  const size_t block_size_;
+  HashContext inner_;
+  HashContext outer_;
+  // The number of data bytes which inner_ got, a multiple of block_size_.
+  uint64_t hashed_size_ = 0;
+  // The data after the last whole block, which inner_ has not got yet.
+  uint8_t pending_[kMaxBlockSize];
+  size_t pending_size_ = 0;
 };
 
+// Keys the HMAC contexts once and hands out copies of them, so that creating
+// a StatefulMac does not hash the inner and outer pads again.
 class StatefulHmacBoringSslFactory : public subtle::StatefulMacFactory {
  public:
   StatefulHmacBoringSslFactory(HashType hash_type, uint32_t tag_size,
                                const util::SecretData& key_value);
+  ~StatefulHmacBoringSslFactory() override;
   util::StatusOr<std::unique_ptr<StatefulMac>> Create() const override;
+  util::StatusOr<std::unique_ptr<StatefulMac>> Resume(
+      const util::SecretData& state) const override;
 
  private:
-  const HashType hash_type_;
-  const uint32_t tag_size_;
-  const util::SecretData key_value_;
+  // Error from keying the contexts in the constructor, returned by Create().
+  util::Status status_;
+  StatefulHmacBoringSsl::KeyedContexts keyed_;
 };
 
 }  // namespace subtle
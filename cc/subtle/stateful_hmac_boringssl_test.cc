@@ -196,6 +196,119 @@ TEST(StatefulCmacFactoryTest, createsObjects) {
   EXPECT_THAT(output, StrEq(expected));
 }
 
+TEST(StatefulCmacFactoryTest, createsIndependentObjects) {
+  std::string key(test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
+  std::string data = "Some data to test.";
+  std::string expected(
+      test::HexDecodeOrDie("1d6eb74bc283f7947e92c72bd985ce6e"));
+  StatefulHmacBoringSslFactory factory(HashType::SHA256, kTagSize,
+                                       util::SecretDataFromStringView(key));
+
+  // All objects start from the same keyed context, but must not share state.
+  auto first_or = factory.Create();
+  ASSERT_THAT(first_or.status(), IsOk());
+  auto second_or = factory.Create();
+  ASSERT_THAT(second_or.status(), IsOk());
+  EXPECT_THAT(first_or.ValueOrDie()->Update("unrelated data"), IsOk());
+  EXPECT_THAT(second_or.ValueOrDie()->Update(data), IsOk());
+  auto output_or = second_or.ValueOrDie()->Finalize();
+  ASSERT_THAT(output_or.status(), IsOk());
+  EXPECT_THAT(output_or.ValueOrDie(), StrEq(expected));
+}
+
+TEST(StatefulCmacFactoryTest, invalidKeySize) {
+  StatefulHmacBoringSslFactory factory(
+      HashType::SHA256, kTagSize,
+      util::SecretDataFromStringView(test::HexDecodeOrDie("0001020304")));
+  EXPECT_THAT(factory.Create().status(),
+              StatusIs(util::error::INVALID_ARGUMENT,
+                       HasSubstr("invalid key size")));
+}
+
+TEST(StatefulHmacBoringSslTest, testKeyLongerThanBlock) {
+  // RFC 4231, test case 6.
+  std::string key(131, '\xaa');
+  std::string data = "Test Using Larger Than Block-Size Key - Hash Key First";
+  std::string expected(test::HexDecodeOrDie(
+      "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54"));
+  BasicHmac(HashType::SHA256, 32, key, data, expected);
+}
+
+TEST(StatefulHmacBoringSslFactoryTest, resumesExportedState) {
+  util::SecretData key = util::SecretDataFromStringView(std::string(32, 'k'));
+  std::string data(1000, 'd');
+  for (int i = 0; i < data.size(); i++) data[i] = static_cast<char>(i * 7);
+  for (HashType hash_type : {HashType::SHA224, HashType::SHA256,
+                             HashType::SHA384, HashType::SHA512}) {
+    SCOPED_TRACE(EnumToString(hash_type));
+    StatefulHmacBoringSslFactory factory(hash_type, kTagSize, key);
+    auto expected_or = StatefulHmacBoringSsl::New(hash_type, kTagSize, key);
+    ASSERT_THAT(expected_or.status(), IsOk());
+    ASSERT_THAT(expected_or.ValueOrDie()->Update(data), IsOk());
+    std::string expected = expected_or.ValueOrDie()->Finalize().ValueOrDie();
+
+    // Split the data before, at, and after block boundaries.
+    for (size_t split : {0, 1, 63, 64, 65, 127, 128, 129, 500, 1000}) {
+      SCOPED_TRACE(split);
+      auto first_or = factory.Create();
+      ASSERT_THAT(first_or.status(), IsOk());
+      ASSERT_THAT(first_or.ValueOrDie()->Update(data.substr(0, split)),
+                  IsOk());
+      auto state_or = first_or.ValueOrDie()->ExportState();
+      ASSERT_THAT(state_or.status(), IsOk());
+
+      auto second_or = factory.Resume(state_or.ValueOrDie());
+      ASSERT_THAT(second_or.status(), IsOk());
+      ASSERT_THAT(second_or.ValueOrDie()->Update(data.substr(split)), IsOk());
+      auto output_or = second_or.ValueOrDie()->Finalize();
+      ASSERT_THAT(output_or.status(), IsOk());
+      EXPECT_THAT(output_or.ValueOrDie(), StrEq(expected));
+
+      // The exporting object can go on, too.
+      ASSERT_THAT(first_or.ValueOrDie()->Update(data.substr(split)), IsOk());
+      EXPECT_THAT(first_or.ValueOrDie()->Finalize().ValueOrDie(),
+                  StrEq(expected));
+    }
+  }
+}
+
+TEST(StatefulHmacBoringSslFactoryTest, rejectsInvalidState) {
+  util::SecretData key = util::SecretDataFromStringView(std::string(32, 'k'));
+  StatefulHmacBoringSslFactory factory256(HashType::SHA256, kTagSize, key);
+  StatefulHmacBoringSslFactory factory512(HashType::SHA512, kTagSize, key);
+  auto hmac = factory256.Create().ValueOrDie();
+  ASSERT_THAT(hmac->Update("Some data to test."), IsOk());
+  util::SecretData state = hmac->ExportState().ValueOrDie();
+
+  EXPECT_THAT(factory512.Resume(state).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  util::SecretData truncated(state.begin(), state.begin() + 20);
+  EXPECT_THAT(factory256.Resume(truncated).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  util::SecretData too_long(state);
+  too_long.resize(state.size() + 64);
+  EXPECT_THAT(factory256.Resume(too_long).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  util::SecretData bad_version(state);
+  bad_version[0] ^= 1;
+  EXPECT_THAT(factory256.Resume(bad_version).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  util::SecretData bad_length(state);
+  bad_length[2] ^= 1;
+  EXPECT_THAT(factory256.Resume(bad_length).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(StatefulHmacBoringSslFactoryTest, sha1DoesNotExportState) {
+  util::SecretData key = util::SecretDataFromStringView(std::string(32, 'k'));
+  StatefulHmacBoringSslFactory factory(HashType::SHA1, kTagSize, key);
+  auto hmac = factory.Create().ValueOrDie();
+  EXPECT_THAT(hmac->ExportState().status(),
+              StatusIs(util::error::UNIMPLEMENTED));
+  EXPECT_THAT(factory.Resume(util::SecretData(30)).status(),
+              StatusIs(util::error::UNIMPLEMENTED));
+}
+
 class StatefulHmacBoringSslTestVectorTest
     : public ::testing::TestWithParam<std::pair<int, std::string>> {
  public:
@@ -17,9 +17,11 @@
 #ifndef TINK_SUBTLE_STREAM_SEGMENT_DECRYPTER_H_
 #define TINK_SUBTLE_STREAM_SEGMENT_DECRYPTER_H_
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
+#include "absl/types/span.h"
 #include "tink/util/status.h"
 
 namespace crypto {
@@ -50,6 +52,52 @@ class StreamSegmentDecrypter {
       bool is_last_segment,
       std::vector<uint8_t>* plaintext_buffer) = 0;
 
+  // Like DecryptSegment(), but decrypts 'ciphertext' directly into
+  // 'plaintext', whose size must be the size of 'ciphertext' minus the
+  // segment overhead (i.e. get_ciphertext_segment_size() -
+  // get_plaintext_segment_size()). This lets callers decrypt from memory
+  // they do not own (e.g. a memory-mapped file) into their own buffers.
+  // 'plaintext' may start at the same address as 'ciphertext', which
+  // decrypts the segment in place, but must not overlap it otherwise;
+  // 'ciphertext' is unspecified after a failed in-place decryption.
+  // The default implementation copies the data around DecryptSegment().
+  virtual util::Status DecryptSegmentInto(
+      absl::Span<const uint8_t> ciphertext, int64_t segment_number,
+      bool is_last_segment, absl::Span<uint8_t> plaintext) {
+    std::vector<uint8_t> plaintext_buffer;
+    util::Status status = DecryptSegment(
+        std::vector<uint8_t>(ciphertext.begin(), ciphertext.end()),
+        segment_number, is_last_segment, &plaintext_buffer);
+    if (!status.ok()) return status;
+    if (plaintext_buffer.size() != plaintext.size()) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "plaintext has the wrong size");
+    }
+    std::copy(plaintext_buffer.begin(), plaintext_buffer.end(),
+              plaintext.begin());
+    return util::OkStatus();
+  }
+
+  // Checks that 'ciphertext' is an authentic segment, as DecryptSegmentInto()
+  // would, but without returning the plaintext.  Implementations whose
+  // construction authenticates the ciphertext (e.g. encrypt-then-MAC) skip
+  // the decryption.  Like DecryptSegmentInto(), this may be called
+  // concurrently once the decrypter is initialized.
+  // The default implementation decrypts a copy of 'ciphertext' in place.
+  virtual util::Status VerifySegment(absl::Span<const uint8_t> ciphertext,
+                                     int64_t segment_number,
+                                     bool is_last_segment) {
+    int overhead = get_ciphertext_segment_size() - get_plaintext_segment_size();
+    if (ciphertext.size() < overhead) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "ciphertext too short");
+    }
+    std::vector<uint8_t> buffer(ciphertext.begin(), ciphertext.end());
+    return DecryptSegmentInto(
+        buffer, segment_number, is_last_segment,
+        absl::MakeSpan(buffer.data(), buffer.size() - overhead));
+  }
+
   // Initializes this decrypter, using the information from 'header',
   // which must be of size exactly get_header_size().
   virtual util::Status Init(const std::vector<uint8_t>& header) = 0;
@@ -17,9 +17,11 @@
 #ifndef TINK_SUBTLE_STREAM_SEGMENT_ENCRYPTER_H_
 #define TINK_SUBTLE_STREAM_SEGMENT_ENCRYPTER_H_
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
+#include "absl/types/span.h"
 #include "tink/util/status.h"
 
 namespace crypto {
@@ -76,6 +78,45 @@ class StreamSegmentEncrypter {
       bool is_last_segment,
       std::vector<uint8_t>* ciphertext_buffer) = 0;
 
+  // Like EncryptSegment(), but encrypts 'plaintext' directly into
+  // 'ciphertext', whose size must be the size of 'plaintext' plus the
+  // segment overhead (i.e. get_ciphertext_segment_size() -
+  // get_plaintext_segment_size()). 'ciphertext' may start at the same
+  // address as 'plaintext', which encrypts the segment in place, but must
+  // not overlap it otherwise.
+  // The default implementation copies the data around EncryptSegment().
+  virtual util::Status EncryptSegmentInto(absl::Span<const uint8_t> plaintext,
+                                          bool is_last_segment,
+                                          absl::Span<uint8_t> ciphertext) {
+    std::vector<uint8_t> ciphertext_buffer;
+    util::Status status = EncryptSegment(
+        std::vector<uint8_t>(plaintext.begin(), plaintext.end()),
+        is_last_segment, &ciphertext_buffer);
+    if (!status.ok()) return status;
+    if (ciphertext_buffer.size() != ciphertext.size()) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "ciphertext has the wrong size");
+    }
+    std::copy(ciphertext_buffer.begin(), ciphertext_buffer.end(),
+              ciphertext.begin());
+    return util::OkStatus();
+  }
+
+  // Encrypts 'plaintext' as the segment number 'segment_number', just like
+  // EncryptSegment() would if get_segment_number() were 'segment_number',
+  // but neither reads nor increments the current segment number.
+  // Unlike EncryptSegment() this method is thread-safe, so that callers
+  // can encrypt several segments of one stream concurrently.
+  // Encrypters that do not support this return UNIMPLEMENTED.
+  virtual util::Status EncryptSegmentAt(
+      int64_t segment_number,
+      const std::vector<uint8_t>& plaintext,
+      bool is_last_segment,
+      std::vector<uint8_t>* ciphertext_buffer) const {
+    return util::Status(util::error::UNIMPLEMENTED,
+                        "EncryptSegmentAt() is not supported");
+  }
+
   // Returns the header of the ciphertext stream.
   virtual const std::vector<uint8_t>& get_header() const = 0;
 
@@ -0,0 +1,117 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/streaming_aead_appending_stream.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "tink/output_stream.h"
+#include "tink/subtle/streaming_aead_random_access_encrypter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+// static
+StatusOr<std::unique_ptr<OutputStream>> StreamingAeadAppendingStream::New(
+    std::unique_ptr<StreamingAeadRandomAccessEncrypter> encrypter,
+    int64_t segment_number, std::vector<uint8_t> segment_plaintext,
+    std::unique_ptr<OutputStream> ciphertext_destination) {
+  if (encrypter == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "encrypter must be non-null");
+  }
+  if (ciphertext_destination == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "ciphertext_destination must be non-null");
+  }
+  if (segment_number < 0 ||
+      segment_plaintext.size() >
+          encrypter->plaintext_segment_size(segment_number)) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "segment_plaintext does not fit the segment");
+  }
+  std::unique_ptr<StreamingAeadAppendingStream> stream(
+      new StreamingAeadAppendingStream());
+  stream->count_ = segment_plaintext.size();
+  stream->pt_buffer_ = std::move(segment_plaintext);
+  stream->pt_buffer_.resize(encrypter->plaintext_segment_size(segment_number));
+  stream->segment_number_ = segment_number;
+  stream->encrypter_ = std::move(encrypter);
+  stream->ct_destination_ = std::move(ciphertext_destination);
+  return {std::move(stream)};
+}
+
+Status StreamingAeadAppendingStream::EncryptSegment(bool is_last_segment) {
+  Status status = encrypter_->EncryptSegmentAt(
+      segment_number_, absl::MakeConstSpan(pt_buffer_.data(), count_),
+      is_last_segment, &ct_buffer_);
+  if (!status.ok()) return status;
+  return ct_destination_->WriteFrom(ct_buffer_);
+}
+
+StatusOr<int> StreamingAeadAppendingStream::Next(void** data) {
+  if (!status_.ok()) return status_;
+  if (count_ == pt_buffer_.size()) {
+    // More plaintext follows, so the full segment is not the last one.
+    status_ = EncryptSegment(/* is_last_segment = */ false);
+    if (!status_.ok()) return status_;
+    segment_number_++;
+    pt_buffer_.resize(encrypter_->plaintext_segment_size(segment_number_));
+    count_ = 0;
+  }
+  *data = pt_buffer_.data() + count_;
+  last_next_size_ = pt_buffer_.size() - count_;
+  count_ = pt_buffer_.size();
+  position_ += last_next_size_;
+  return last_next_size_;
+}
+
+void StreamingAeadAppendingStream::BackUp(int count) {
+  if (!status_.ok() || count < 1) return;
+  int actual_count = std::min(count, last_next_size_);
+  last_next_size_ -= actual_count;
+  count_ -= actual_count;
+  position_ -= actual_count;
+}
+
+Status StreamingAeadAppendingStream::Close() {
+  if (!status_.ok()) return status_;
+  status_ = EncryptSegment(/* is_last_segment = */ true);
+  if (!status_.ok()) {
+    ct_destination_->Close().IgnoreError();
+    return status_;
+  }
+  status_ = Status(util::error::FAILED_PRECONDITION, "Stream closed");
+  return ct_destination_->Close();
+}
+
+int64_t StreamingAeadAppendingStream::Position() const { return position_; }
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,81 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_SUBTLE_STREAMING_AEAD_APPENDING_STREAM_H_
+#define TINK_SUBTLE_STREAMING_AEAD_APPENDING_STREAM_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tink/output_stream.h"
+#include "tink/subtle/streaming_aead_random_access_encrypter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// An OutputStream that appends plaintext to an existing ciphertext stream
+// (see NonceBasedStreamingAead::NewAppendingStream()).  It re-encrypts the
+// last segment of the existing stream with the appended plaintext, and
+// writes it and the following segments to its destination, which replaces
+// the existing ciphertext from the position of that segment on.
+//
+// Position() returns the number of appended plaintext bytes.
+class StreamingAeadAppendingStream : public OutputStream {
+ public:
+  // Returns a stream that encrypts with 'encrypter', starting with the
+  // segment 'segment_number', whose plaintext starts with
+  // 'segment_plaintext', and writes the ciphertext segments to
+  // 'ciphertext_destination'.
+  static
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+      New(std::unique_ptr<StreamingAeadRandomAccessEncrypter> encrypter,
+          int64_t segment_number, std::vector<uint8_t> segment_plaintext,
+          std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination);
+
+  // -----------------------
+  // Methods of OutputStream-interface implemented by this class.
+  crypto::tink::util::StatusOr<int> Next(void** data) override;
+  void BackUp(int count) override;
+  crypto::tink::util::Status Close() override;
+  int64_t Position() const override;
+
+ private:
+  StreamingAeadAppendingStream() {}
+  // Encrypts the first count_ bytes of pt_buffer_ as the segment
+  // segment_number_, and writes it to ct_destination_.
+  crypto::tink::util::Status EncryptSegment(bool is_last_segment);
+
+  std::unique_ptr<StreamingAeadRandomAccessEncrypter> encrypter_;
+  std::unique_ptr<crypto::tink::OutputStream> ct_destination_;
+  int64_t segment_number_;
+  std::vector<uint8_t> pt_buffer_;  // plaintext of the current segment
+  int count_;                       // number of bytes used in pt_buffer_
+  int last_next_size_ = 0;          // bytes returned by Next() not backed up
+  std::vector<uint8_t> ct_buffer_;
+  int64_t position_ = 0;
+  crypto::tink::util::Status status_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_STREAMING_AEAD_APPENDING_STREAM_H_
@@ -0,0 +1,207 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/streaming_aead_appending_stream.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/output_stream.h"
+#include "tink/random_access_stream.h"
+#include "tink/subtle/aes_ctr_hmac_streaming.h"
+#include "tink/subtle/aes_gcm_hkdf_streaming.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/ostream_output_stream.h"
+#include "tink/util/prefetched_random_access_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::crypto::tink::util::IstreamInputStream;
+using ::crypto::tink::util::OstreamOutputStream;
+using ::crypto::tink::util::PrefetchedRandomAccessStream;
+
+constexpr int kSegmentSize = 256;
+
+std::unique_ptr<AesCtrHmacStreaming> NewAesCtrHmacStreaming(
+    int ciphertext_offset) {
+  AesCtrHmacStreaming::Params params;
+  params.ikm = Random::GetRandomKeyBytes(32);
+  params.hkdf_algo = SHA256;
+  params.key_size = 32;
+  params.ciphertext_segment_size = kSegmentSize;
+  params.ciphertext_offset = ciphertext_offset;
+  params.tag_algo = SHA256;
+  params.tag_size = 16;
+  return std::move(AesCtrHmacStreaming::New(std::move(params)).ValueOrDie());
+}
+
+// Returns the bytes written to the destination of the stream returned by
+// 'write', which the stream owns.  'write' returns null if it fails.
+template <typename WriteFunction>
+std::string WriteToString(WriteFunction write) {
+  auto ct_stream = absl::make_unique<std::stringstream>();
+  auto ct_buf = ct_stream->rdbuf();
+  std::unique_ptr<OutputStream> stream =
+      write(absl::make_unique<OstreamOutputStream>(std::move(ct_stream)));
+  if (stream == nullptr) return "";
+  return ct_buf->str();
+}
+
+std::string Encrypt(NonceBasedStreamingAead* saead,
+                    absl::string_view plaintext, int ciphertext_offset) {
+  // The encrypting stream does not write the ciphertext offset.
+  return std::string(ciphertext_offset, 'x') +
+         WriteToString([&](std::unique_ptr<OutputStream> destination) {
+           auto enc_stream_result = saead->NewEncryptingStream(
+               std::move(destination), "associated data");
+           EXPECT_THAT(enc_stream_result.status(), IsOk());
+           EXPECT_THAT(test::WriteToStream(
+                           enc_stream_result.ValueOrDie().get(), plaintext),
+                       IsOk());
+           return std::move(enc_stream_result.ValueOrDie());
+         });
+}
+
+std::unique_ptr<RandomAccessStream> StreamOf(const std::string& data) {
+  auto stream = absl::make_unique<PrefetchedRandomAccessStream>(data.size());
+  EXPECT_THAT(stream->AddRange(0, data), IsOk());
+  return std::move(stream);
+}
+
+// Appends 'plaintext' to 'ciphertext' in place.
+util::Status Append(NonceBasedStreamingAead* saead, absl::string_view plaintext,
+                    std::string* ciphertext) {
+  auto position_result = saead->GetAppendPosition(ciphertext->size());
+  if (!position_result.ok()) return position_result.status();
+  util::Status status;
+  std::string tail =
+      WriteToString([&](std::unique_ptr<OutputStream> destination)
+                        -> std::unique_ptr<OutputStream> {
+        auto append_stream_result = saead->NewAppendingStream(
+            StreamOf(*ciphertext), std::move(destination), "associated data");
+        status = append_stream_result.status();
+        if (!status.ok()) return nullptr;
+        status = test::WriteToStream(append_stream_result.ValueOrDie().get(),
+                                     plaintext);
+        return std::move(append_stream_result.ValueOrDie());
+      });
+  if (!status.ok()) return status;
+  ciphertext->resize(position_result.ValueOrDie());
+  ciphertext->append(tail);
+  return util::OkStatus();
+}
+
+std::string Decrypt(NonceBasedStreamingAead* saead,
+                    const std::string& ciphertext, int ciphertext_offset) {
+  auto dec_stream_result = saead->NewDecryptingStream(
+      absl::make_unique<IstreamInputStream>(
+          absl::make_unique<std::stringstream>(
+              ciphertext.substr(ciphertext_offset))),
+      "associated data");
+  EXPECT_THAT(dec_stream_result.status(), IsOk());
+  std::string plaintext;
+  EXPECT_THAT(
+      test::ReadFromStream(dec_stream_result.ValueOrDie().get(), &plaintext),
+      IsOk());
+  return plaintext;
+}
+
+TEST(StreamingAeadAppendingStreamTest, AppendedCiphertextDecrypts) {
+  for (int ciphertext_offset : {0, 8}) {
+    std::unique_ptr<AesCtrHmacStreaming> saead =
+        NewAesCtrHmacStreaming(ciphertext_offset);
+    for (int initial_size : {0, 1, 200, 240, 440, 1000}) {
+      for (int appended_size : {0, 1, 39, 240, 1000}) {
+        SCOPED_TRACE(absl::StrCat("ciphertext_offset = ", ciphertext_offset,
+                                  ", initial_size = ", initial_size,
+                                  ", appended_size = ", appended_size));
+        std::string plaintext = Random::GetRandomBytes(initial_size);
+        std::string ciphertext =
+            Encrypt(saead.get(), plaintext, ciphertext_offset);
+        // Appending several times gives the same result as encrypting the
+        // whole plaintext at once, except for the header.
+        for (int i = 0; i < 3; i++) {
+          std::string appended = Random::GetRandomBytes(appended_size);
+          ASSERT_THAT(Append(saead.get(), appended, &ciphertext), IsOk());
+          plaintext += appended;
+          EXPECT_EQ(
+              Encrypt(saead.get(), plaintext, ciphertext_offset).size(),
+              ciphertext.size());
+          EXPECT_EQ(plaintext,
+                    Decrypt(saead.get(), ciphertext, ciphertext_offset));
+        }
+      }
+    }
+  }
+}
+
+TEST(StreamingAeadAppendingStreamTest, OnlyRewritesTheLastSegment) {
+  std::unique_ptr<AesCtrHmacStreaming> saead = NewAesCtrHmacStreaming(0);
+  std::string ciphertext =
+      Encrypt(saead.get(), Random::GetRandomBytes(1000), 0);
+  std::string original = ciphertext;
+  ASSERT_THAT(Append(saead.get(), "more plaintext", &ciphertext), IsOk());
+  int64_t position = saead->GetAppendPosition(original.size()).ValueOrDie();
+  EXPECT_EQ(4 * kSegmentSize, position);
+  EXPECT_EQ(original.substr(0, position), ciphertext.substr(0, position));
+}
+
+TEST(StreamingAeadAppendingStreamTest, ModifiedLastSegmentFails) {
+  std::unique_ptr<AesCtrHmacStreaming> saead = NewAesCtrHmacStreaming(0);
+  std::string ciphertext =
+      Encrypt(saead.get(), Random::GetRandomBytes(1000), 0);
+  ciphertext[ciphertext.size() - 1] ^= 1;
+  EXPECT_FALSE(Append(saead.get(), "more plaintext", &ciphertext).ok());
+  // A truncated ciphertext lacks its last segment.
+  std::string truncated = ciphertext.substr(0, 2 * kSegmentSize);
+  EXPECT_FALSE(Append(saead.get(), "more plaintext", &truncated).ok());
+}
+
+TEST(StreamingAeadAppendingStreamTest, UnsupportedForAesGcmHkdf) {
+  AesGcmHkdfStreaming::Params params;
+  params.ikm = Random::GetRandomKeyBytes(32);
+  params.hkdf_hash = SHA256;
+  params.derived_key_size = 32;
+  params.ciphertext_segment_size = kSegmentSize;
+  params.ciphertext_offset = 0;
+  std::unique_ptr<AesGcmHkdfStreaming> saead =
+      std::move(AesGcmHkdfStreaming::New(std::move(params)).ValueOrDie());
+  std::string ciphertext = Encrypt(saead.get(), "plaintext", 0);
+  EXPECT_THAT(Append(saead.get(), "more plaintext", &ciphertext),
+              StatusIs(util::error::UNIMPLEMENTED));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,218 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/streaming_aead_async_encrypting_stream.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "tink/async_output_stream.h"
+#include "tink/subtle/segment_buffer_pool.h"
+#include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// static
+StatusOr<std::unique_ptr<AsyncOutputStream>>
+StreamingAeadAsyncEncryptingStream::New(
+    std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+    std::unique_ptr<AsyncOutputStream> ciphertext_destination,
+    std::shared_ptr<SegmentBufferPool> buffer_pool) {
+  if (segment_encrypter == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "segment_encrypter must be non-null");
+  }
+  if (ciphertext_destination == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "cipertext_destination must be non-null");
+  }
+  int first_segment_size = segment_encrypter->get_plaintext_segment_size() -
+                           segment_encrypter->get_ciphertext_offset() -
+                           segment_encrypter->get_header().size();
+  if (first_segment_size <= 0) {
+    return Status(util::error::INTERNAL,
+                  "Size of the first segment must be greater than 0.");
+  }
+  std::unique_ptr<StreamingAeadAsyncEncryptingStream> enc_stream(
+      new StreamingAeadAsyncEncryptingStream());
+  int ct_segment_size = segment_encrypter->get_ciphertext_segment_size();
+  enc_stream->segment_encrypter_ = std::move(segment_encrypter);
+  enc_stream->ct_destination_ = std::move(ciphertext_destination);
+  enc_stream->buffer_pool_ = std::move(buffer_pool);
+  SegmentBufferPool* pool = enc_stream->buffer_pool_.get();
+  if (pool != nullptr) {
+    enc_stream->pt_buffer_ = pool->Acquire(ct_segment_size);
+    enc_stream->ct_buffer_ = pool->Acquire(ct_segment_size);
+  } else {
+    enc_stream->pt_buffer_.reserve(ct_segment_size);
+    enc_stream->ct_buffer_.reserve(ct_segment_size);
+  }
+  enc_stream->pt_capacity_ = first_segment_size;
+  return {std::move(enc_stream)};
+}
+
+StreamingAeadAsyncEncryptingStream::StreamingAeadAsyncEncryptingStream()
+    : position_(0),
+      written_(0),
+      status_(Status::OK),
+      closing_(false),
+      header_written_(false),
+      last_segment_written_(false),
+      destination_closed_(false),
+      arrivals_(0) {
+  on_destination_done_ = [this](Status status) {
+    if (!status.ok()) status_ = status;
+    if (ArriveAtDestinationDone()) Run();
+  };
+}
+
+StreamingAeadAsyncEncryptingStream::~StreamingAeadAsyncEncryptingStream() {
+  if (buffer_pool_ == nullptr) return;
+  buffer_pool_->Release(std::move(pt_buffer_));
+  buffer_pool_->Release(std::move(ct_buffer_));
+}
+
+void StreamingAeadAsyncEncryptingStream::Write(
+    absl::Span<const uint8_t> data, Callback done) {
+  if (done_ == nullptr && status_.ok()) data_ = data;
+  Start(std::move(done));
+}
+
+void StreamingAeadAsyncEncryptingStream::Close(Callback done) {
+  if (done_ == nullptr && status_.ok()) closing_ = true;
+  Start(std::move(done));
+}
+
+void StreamingAeadAsyncEncryptingStream::Start(Callback done) {
+  if (done_ != nullptr) {
+    done(Status(util::error::FAILED_PRECONDITION,
+                "Another operation is outstanding"));
+    return;
+  }
+  if (!status_.ok()) {
+    done(status_);
+    return;
+  }
+  done_ = std::move(done);
+  Run();
+}
+
+void StreamingAeadAsyncEncryptingStream::Finish(Status status) {
+  if (status.ok() && !closing_) position_ = written_;
+  if (status.ok() && closing_) {
+    status_ = Status(util::error::FAILED_PRECONDITION, "Stream closed");
+  }
+  Callback done = std::move(done_);
+  done_ = nullptr;
+  done(status);
+}
+
+Status StreamingAeadAsyncEncryptingStream::EncryptSegment(
+    absl::Span<const uint8_t> plaintext, bool is_last_segment) {
+  int segment_overhead = segment_encrypter_->get_ciphertext_segment_size() -
+                         segment_encrypter_->get_plaintext_segment_size();
+  ct_buffer_.resize(plaintext.size() + segment_overhead);
+  return segment_encrypter_->EncryptSegmentInto(plaintext, is_last_segment,
+                                                absl::MakeSpan(ct_buffer_));
+}
+
+bool StreamingAeadAsyncEncryptingStream::ArriveAtDestinationDone() {
+  return arrivals_.fetch_add(1) == 1;
+}
+
+bool StreamingAeadAsyncEncryptingStream::WriteToDestination(
+    absl::Span<const uint8_t> data) {
+  arrivals_ = 0;
+  ct_destination_->Write(data, on_destination_done_);
+  return ArriveAtDestinationDone();
+}
+
+bool StreamingAeadAsyncEncryptingStream::CloseDestination() {
+  arrivals_ = 0;
+  ct_destination_->Close(on_destination_done_);
+  return ArriveAtDestinationDone();
+}
+
+void StreamingAeadAsyncEncryptingStream::Run() {
+  while (true) {
+    if (!status_.ok()) return Finish(status_);
+
+    if (!header_written_) {
+      header_written_ = true;
+      if (!WriteToDestination(segment_encrypter_->get_header())) return;
+      continue;
+    }
+
+    if (!closing_) {
+      if (data_.empty()) return Finish(Status::OK);
+      // A segment is encrypted only once more plaintext follows it, as
+      // the last segment is encrypted differently.
+      bool buffer_full = static_cast<int>(pt_buffer_.size()) == pt_capacity_;
+      if (buffer_full || (pt_buffer_.empty() &&
+                          data_.size() > static_cast<size_t>(pt_capacity_))) {
+        if (buffer_full) {
+          status_ = EncryptSegment(pt_buffer_, /* is_last_segment = */ false);
+          pt_buffer_.clear();
+        } else {
+          // Encrypt the segment directly from the data.
+          status_ = EncryptSegment(data_.subspan(0, pt_capacity_),
+                                   /* is_last_segment = */ false);
+          data_.remove_prefix(pt_capacity_);
+          written_ += pt_capacity_;
+        }
+        if (!status_.ok()) continue;
+        pt_capacity_ = segment_encrypter_->get_plaintext_segment_size();
+        if (!WriteToDestination(ct_buffer_)) return;
+        continue;
+      }
+      size_t count =
+          std::min(static_cast<size_t>(pt_capacity_ - pt_buffer_.size()),
+                   data_.size());
+      pt_buffer_.insert(pt_buffer_.end(), data_.begin(),
+                        data_.begin() + count);
+      data_.remove_prefix(count);
+      written_ += count;
+      continue;
+    }
+
+    if (!last_segment_written_) {
+      last_segment_written_ = true;
+      status_ = EncryptSegment(pt_buffer_, /* is_last_segment = */ true);
+      if (!status_.ok()) continue;
+      if (!WriteToDestination(ct_buffer_)) return;
+      continue;
+    }
+    if (!destination_closed_) {
+      destination_closed_ = true;
+      if (!CloseDestination()) return;
+      continue;
+    }
+    return Finish(Status::OK);
+  }
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
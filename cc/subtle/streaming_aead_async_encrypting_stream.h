@@ -0,0 +1,122 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_STREAMING_AEAD_ASYNC_ENCRYPTING_STREAM_H_
+#define TINK_SUBTLE_STREAMING_AEAD_ASYNC_ENCRYPTING_STREAM_H_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "tink/async_output_stream.h"
+#include "tink/subtle/segment_buffer_pool.h"
+#include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// The asynchronous counterpart of StreamingAeadEncryptingStream: writes the
+// same ciphertext to an AsyncOutputStream, but never blocks on it.  While
+// the ciphertext destination is busy with a segment, the stream waits for
+// its callback instead of a thread, so that many streams can be served by
+// a few threads.
+//
+// Segments are encrypted on the thread that calls Write() or Close(), or
+// on the thread that calls back from the ciphertext destination.  Full
+// segments in the written data are encrypted directly from it.
+class StreamingAeadAsyncEncryptingStream : public AsyncOutputStream {
+ public:
+  // A factory that produces asynchronous encrypting streams.
+  // The returned stream is a wrapper around 'ciphertext_destination',
+  // such that any bytes written via the wrapper are AEAD-encrypted
+  // by 'segment_encrypter'.  The buffers of the stream come from
+  // 'buffer_pool', unless it is null.
+  static crypto::tink::util::StatusOr<std::unique_ptr<AsyncOutputStream>> New(
+      std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+      std::unique_ptr<AsyncOutputStream> ciphertext_destination,
+      std::shared_ptr<SegmentBufferPool> buffer_pool = nullptr);
+
+  ~StreamingAeadAsyncEncryptingStream() override;
+
+  // -----------------------
+  // Methods of AsyncOutputStream-interface implemented by this class.
+  void Write(absl::Span<const uint8_t> data, Callback done) override;
+  // Encrypts the last segment, and closes the ciphertext destination.
+  void Close(Callback done) override;
+  int64_t Position() const override { return position_; }
+
+ private:
+  StreamingAeadAsyncEncryptingStream();
+
+  // Starts an operation that calls 'done' when it is done, unless another
+  // operation is outstanding or the stream failed.
+  void Start(Callback done);
+
+  // Advances the current operation as far as possible without waiting for
+  // the ciphertext destination.
+  void Run();
+
+  // Ends the current operation with 'status'.  Must be the last thing done
+  // with this stream, as the callback may destroy it.
+  void Finish(crypto::tink::util::Status status);
+
+  // Encrypts 'plaintext' into ct_buffer_.
+  crypto::tink::util::Status EncryptSegment(
+      absl::Span<const uint8_t> plaintext, bool is_last_segment);
+
+  // Writes 'data' to, or closes, the ciphertext destination.  Returns true
+  // if the destination is already done, false if Run() will be called
+  // once it is.
+  bool WriteToDestination(absl::Span<const uint8_t> data);
+  bool CloseDestination();
+  bool ArriveAtDestinationDone();
+
+  std::unique_ptr<StreamSegmentEncrypter> segment_encrypter_;
+  std::unique_ptr<AsyncOutputStream> ct_destination_;
+  std::shared_ptr<SegmentBufferPool> buffer_pool_;  // may be null
+  std::vector<uint8_t> pt_buffer_;  // plaintext of the current segment
+  std::vector<uint8_t> ct_buffer_;  // ciphertext written to ct_destination_
+  int pt_capacity_;  // plaintext size of the current segment
+  std::atomic<int64_t> position_;  // # plaintext bytes of finished writes
+  int64_t written_;  // # plaintext bytes taken from written data so far
+  crypto::tink::util::Status status_;  // status of the stream
+
+  // The current operation: the data left of a Write(), or a Close().
+  absl::Span<const uint8_t> data_;
+  bool closing_;
+  Callback done_;  // null iff no operation is outstanding
+
+  // The progress of the ciphertext destination.
+  bool header_written_;
+  bool last_segment_written_;
+  bool destination_closed_;
+
+  // Called by ct_destination_ when an operation is done.  Both it and the
+  // thread that started the operation increment 'arrivals_', and the one
+  // that arrives second continues with Run().
+  Callback on_destination_done_;
+  std::atomic<int> arrivals_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_STREAMING_AEAD_ASYNC_ENCRYPTING_STREAM_H_
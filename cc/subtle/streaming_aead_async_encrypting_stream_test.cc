@@ -0,0 +1,365 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/streaming_aead_async_encrypting_stream.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <future>  // NOLINT(build/c++11)
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/async_output_stream.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/segment_buffer_pool.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+using crypto::tink::AsyncOutputStream;
+using crypto::tink::subtle::test::DummyStreamSegmentEncrypter;
+using crypto::tink::util::Status;
+
+namespace {
+
+// An AsyncOutputStream that appends the written data to a string, and
+// calls back right away, from a queue of deferred work, or from another
+// thread.  The data is appended just before the callback, so that it must
+// stay valid until then.
+class StringAsyncOutputStream : public AsyncOutputStream {
+ public:
+  enum Mode { kInline, kDeferred, kOtherThread };
+
+  // 'queue' is used by kDeferred streams only.
+  StringAsyncOutputStream(Mode mode, std::string* contents,
+                          std::deque<std::function<void()>>* queue = nullptr)
+      : mode_(mode), contents_(contents), queue_(queue), position_(0) {}
+
+  ~StringAsyncOutputStream() override {
+    for (auto& thread : threads_) thread.join();
+  }
+
+  void Write(absl::Span<const uint8_t> data, Callback done) override {
+    if (closed_) {
+      done(Status(util::error::FAILED_PRECONDITION, "Stream closed"));
+      return;
+    }
+    std::string* contents = contents_;
+    int64_t* position = &position_;
+    Status status = write_status_;
+    Complete([contents, position, data, status, done]() {
+      if (status.ok()) {
+        contents->append(reinterpret_cast<const char*>(data.data()),
+                         data.size());
+        *position += data.size();
+      }
+      done(status);
+    });
+  }
+
+  void Close(Callback done) override {
+    closed_ = true;
+    Complete([done]() { done(Status::OK); });
+  }
+
+  int64_t Position() const override { return position_; }
+
+  void set_write_status(Status status) { write_status_ = status; }
+
+ private:
+  void Complete(std::function<void()> completion) {
+    switch (mode_) {
+      case kInline:
+        completion();
+        break;
+      case kDeferred:
+        queue_->push_back(std::move(completion));
+        break;
+      case kOtherThread:
+        threads_.emplace_back(std::move(completion));
+        break;
+    }
+  }
+
+  Mode mode_;
+  std::string* contents_;
+  std::deque<std::function<void()>>* queue_;
+  std::vector<std::thread> threads_;
+  int64_t position_;
+  bool closed_ = false;
+  Status write_status_ = Status::OK;
+};
+
+// Writes 'pt' to 'stream' in chunks of at most 'chunk_size' bytes, each
+// once the previous one is done, then closes the stream, and calls 'done'
+// with the resulting status.  Like StreamingAeadAsyncEncryptingStream, it
+// loops instead of recursing when the callbacks come right away.
+class ChunkedWriter {
+ public:
+  ChunkedWriter(AsyncOutputStream* stream, absl::string_view pt,
+                int chunk_size, AsyncOutputStream::Callback done)
+      : stream_(stream), pt_(pt), chunk_size_(chunk_size), offset_(0),
+        done_(std::move(done)), arrivals_(0) {}
+
+  void Start() { Run(); }
+
+ private:
+  void Run() {
+    while (true) {
+      if (!status_.ok()) {
+        done_(status_);
+        return;
+      }
+      if (offset_ == pt_.size()) {
+        stream_->Close(done_);
+        return;
+      }
+      size_t size = std::min(pt_.size() - offset_,
+                             static_cast<size_t>(chunk_size_));
+      auto chunk = absl::MakeConstSpan(
+          reinterpret_cast<const uint8_t*>(pt_.data() + offset_), size);
+      offset_ += size;
+      arrivals_ = 0;
+      stream_->Write(chunk, [this](Status status) {
+        status_ = status;
+        if (arrivals_.fetch_add(1) == 1) Run();
+      });
+      if (arrivals_.fetch_add(1) == 0) return;
+    }
+  }
+
+  AsyncOutputStream* stream_;
+  absl::string_view pt_;
+  int chunk_size_;
+  size_t offset_;
+  AsyncOutputStream::Callback done_;
+  Status status_;
+  std::atomic<int> arrivals_;
+};
+
+// Returns an encrypting stream writing to 'ct' via a StringAsyncOutputStream
+// with the specified 'mode', and sets 'seg_enc' to its segment encrypter.
+std::unique_ptr<AsyncOutputStream> GetEncryptingStream(
+    int pt_segment_size, int header_size, int ct_offset,
+    StringAsyncOutputStream::Mode mode, std::string* ct,
+    DummyStreamSegmentEncrypter** seg_enc,
+    std::deque<std::function<void()>>* queue = nullptr,
+    std::shared_ptr<SegmentBufferPool> buffer_pool = nullptr) {
+  auto enc = absl::make_unique<DummyStreamSegmentEncrypter>(
+      pt_segment_size, header_size, ct_offset);
+  *seg_enc = enc.get();
+  auto result = StreamingAeadAsyncEncryptingStream::New(
+      std::move(enc),
+      absl::make_unique<StringAsyncOutputStream>(mode, ct, queue),
+      std::move(buffer_pool));
+  EXPECT_TRUE(result.ok()) << result.status();
+  return std::move(result.ValueOrDie());
+}
+
+// Writes 'pt' to 'stream' as ChunkedWriter does, and waits for the result.
+Status EncryptAndWait(AsyncOutputStream* stream, absl::string_view pt,
+                      int chunk_size) {
+  std::promise<Status> result;
+  ChunkedWriter writer(stream, pt, chunk_size,
+                       [&result](Status status) { result.set_value(status); });
+  writer.Start();
+  return result.get_future().get();
+}
+
+class StreamingAeadAsyncEncryptingStreamTest : public ::testing::Test {
+};
+
+TEST_F(StreamingAeadAsyncEncryptingStreamTest, WritingStreams) {
+  std::vector<int> pt_sizes = {0, 10, 100, 1000, 10000, 100000};
+  std::vector<int> pt_segment_sizes = {64, 100, 1024};
+  std::vector<int> header_sizes = {5, 32};
+  std::vector<int> ct_offsets = {0, 5};
+  std::vector<int> chunk_sizes = {1, 63, 1000, 100000};
+  for (auto mode : {StringAsyncOutputStream::kInline,
+                    StringAsyncOutputStream::kOtherThread}) {
+    for (auto pt_size : pt_sizes) {
+      for (auto pt_segment_size : pt_segment_sizes) {
+        for (auto header_size : header_sizes) {
+          for (auto ct_offset : ct_offsets) {
+            for (auto chunk_size : chunk_sizes) {
+              // Threads per chunk take too long for tiny chunks.
+              if (mode == StringAsyncOutputStream::kOtherThread &&
+                  pt_size / chunk_size > 100) {
+                continue;
+              }
+              SCOPED_TRACE(absl::StrCat(
+                  "mode = ", mode, ", pt_size = ", pt_size,
+                  ", pt_segment_size = ", pt_segment_size,
+                  ", header_size = ", header_size, ", ct_offset = ", ct_offset,
+                  ", chunk_size = ", chunk_size));
+              std::string ct;
+              DummyStreamSegmentEncrypter* seg_enc;
+              auto enc_stream = GetEncryptingStream(
+                  pt_segment_size, header_size, ct_offset, mode, &ct,
+                  &seg_enc);
+              std::string pt = Random::GetRandomBytes(pt_size);
+              auto status = EncryptAndWait(enc_stream.get(), pt, chunk_size);
+              EXPECT_TRUE(status.ok()) << status;
+              EXPECT_EQ(pt_size, enc_stream->Position());
+              std::string exp_ciphertext = seg_enc->GenerateCiphertext(pt);
+              // Waits for the threads of the ciphertext destination.
+              enc_stream.reset();
+              EXPECT_EQ(exp_ciphertext, ct);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_F(StreamingAeadAsyncEncryptingStreamTest, ManyStreamsOnOneThread) {
+  int stream_count = 500;
+  int pt_size = 5000;
+  std::deque<std::function<void()>> queue;
+  std::vector<std::string> pts(stream_count);
+  std::vector<std::string> cts(stream_count);
+  std::vector<DummyStreamSegmentEncrypter*> seg_encs(stream_count);
+  std::vector<std::unique_ptr<AsyncOutputStream>> streams;
+  std::vector<std::unique_ptr<ChunkedWriter>> writers;
+  std::vector<Status> statuses(stream_count,
+                               Status(util::error::UNKNOWN, "Not done"));
+  auto buffer_pool = std::make_shared<SegmentBufferPool>();
+  for (int i = 0; i < stream_count; i++) {
+    pts[i] = Random::GetRandomBytes(pt_size);
+    streams.push_back(GetEncryptingStream(
+        /* pt_segment_size = */ 256, /* header_size = */ 16,
+        /* ct_offset = */ 0, StringAsyncOutputStream::kDeferred, &cts[i],
+        &seg_encs[i], &queue, buffer_pool));
+    Status* status = &statuses[i];
+    writers.push_back(absl::make_unique<ChunkedWriter>(
+        streams[i].get(), pts[i], /* chunk_size = */ 300,
+        [status](Status result) { *status = result; }));
+    writers[i]->Start();
+  }
+  // The streams wait for the ciphertext destinations, which are served
+  // by this loop, interleaving all streams.
+  while (!queue.empty()) {
+    std::function<void()> completion = std::move(queue.front());
+    queue.pop_front();
+    completion();
+  }
+  for (int i = 0; i < stream_count; i++) {
+    EXPECT_TRUE(statuses[i].ok()) << statuses[i];
+    EXPECT_EQ(seg_encs[i]->GenerateCiphertext(pts[i]), cts[i]);
+  }
+}
+
+TEST_F(StreamingAeadAsyncEncryptingStreamTest, OneOperationAtATime) {
+  std::deque<std::function<void()>> queue;
+  std::string ct;
+  DummyStreamSegmentEncrypter* seg_enc;
+  auto enc_stream = GetEncryptingStream(
+      /* pt_segment_size = */ 64, /* header_size = */ 8, /* ct_offset = */ 0,
+      StringAsyncOutputStream::kDeferred, &ct, &seg_enc, &queue);
+  std::string pt = Random::GetRandomBytes(1000);
+  auto data = absl::MakeConstSpan(
+      reinterpret_cast<const uint8_t*>(pt.data()), pt.size());
+  Status first_status(util::error::UNKNOWN, "Not done");
+  Status second_status(util::error::UNKNOWN, "Not done");
+  enc_stream->Write(data,
+                    [&first_status](Status status) { first_status = status; });
+  // The stream waits for the header to be written.
+  EXPECT_EQ(util::error::UNKNOWN, first_status.error_code());
+  enc_stream->Write(
+      data, [&second_status](Status status) { second_status = status; });
+  EXPECT_EQ(util::error::FAILED_PRECONDITION, second_status.error_code());
+  while (!queue.empty()) {
+    std::function<void()> completion = std::move(queue.front());
+    queue.pop_front();
+    completion();
+  }
+  EXPECT_TRUE(first_status.ok()) << first_status;
+  EXPECT_EQ(pt.size(), enc_stream->Position());
+
+  Status close_status(util::error::UNKNOWN, "Not done");
+  enc_stream->Close([&close_status](Status status) { close_status = status; });
+  while (!queue.empty()) {
+    std::function<void()> completion = std::move(queue.front());
+    queue.pop_front();
+    completion();
+  }
+  EXPECT_TRUE(close_status.ok()) << close_status;
+  EXPECT_EQ(seg_enc->GenerateCiphertext(pt), ct);
+
+  // The stream is closed.
+  enc_stream->Write(data, [&first_status](Status status) {
+    first_status = status;
+  });
+  EXPECT_EQ(util::error::FAILED_PRECONDITION, first_status.error_code());
+}
+
+TEST_F(StreamingAeadAsyncEncryptingStreamTest, DestinationFailure) {
+  std::string ct;
+  auto destination = absl::make_unique<StringAsyncOutputStream>(
+      StringAsyncOutputStream::kInline, &ct);
+  StringAsyncOutputStream* destination_ptr = destination.get();
+  auto enc_stream = std::move(StreamingAeadAsyncEncryptingStream::New(
+      absl::make_unique<DummyStreamSegmentEncrypter>(
+          /* pt_segment_size = */ 64, /* header_size = */ 8,
+          /* ct_offset = */ 0),
+      std::move(destination)).ValueOrDie());
+  std::string pt = Random::GetRandomBytes(1000);
+  auto data = absl::MakeConstSpan(
+      reinterpret_cast<const uint8_t*>(pt.data()), pt.size());
+  Status write_status;
+  enc_stream->Write(data.subspan(0, 100),
+                    [&write_status](Status status) { write_status = status; });
+  EXPECT_TRUE(write_status.ok()) << write_status;
+
+  destination_ptr->set_write_status(
+      Status(util::error::UNAVAILABLE, "Connection reset"));
+  enc_stream->Write(data.subspan(100),
+                    [&write_status](Status status) { write_status = status; });
+  EXPECT_EQ(util::error::UNAVAILABLE, write_status.error_code());
+  // The failure is permanent.
+  Status close_status;
+  enc_stream->Close([&close_status](Status status) { close_status = status; });
+  EXPECT_EQ(util::error::UNAVAILABLE, close_status.error_code());
+}
+
+TEST_F(StreamingAeadAsyncEncryptingStreamTest, NullArguments) {
+  std::string ct;
+  auto result = StreamingAeadAsyncEncryptingStream::New(
+      nullptr, absl::make_unique<StringAsyncOutputStream>(
+                   StringAsyncOutputStream::kInline, &ct));
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+  result = StreamingAeadAsyncEncryptingStream::New(
+      absl::make_unique<DummyStreamSegmentEncrypter>(64, 8, 0), nullptr);
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -20,7 +20,13 @@
 #include <cstring>
 
 #include "absl/memory/memory.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "tink/executor.h"
 #include "tink/input_stream.h"
+#include "tink/internal/thread_pool.h"
+#include "tink/internal/traced_operation.h"
+#include "tink/subtle/segment_buffer_pool.h"
 #include "tink/subtle/stream_segment_decrypter.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -41,44 +47,100 @@ namespace {
 // Will try to read exactly 'count' bytes, unless the end of stream
 // is reached (then returns status OUT_OF_RANGE) or an error occurs
 // (an other non-OK status).
+// Reads at first 'initial_count' bytes, and then doubles the number of
+// bytes read, so that 'output' only grows as large as the stream is.
 // Before returning, resizes 'output' accordingly, to reflect
 // the actual number of bytes read.
 
 util::Status ReadFromStream(InputStream* input_stream, int count,
-                            std::vector<uint8_t>* output) {
+                            int initial_count, std::vector<uint8_t>* output) {
   if (count <= 0 || input_stream == nullptr || output == nullptr) {
     return Status(util::error::INTERNAL, "Illegal read from a stream");
   }
+  int read = 0;
+  int size = std::min(count, std::max(initial_count, 1));
+  while (true) {
+    output->resize(size);
+    auto read_result = input_stream->ReadInto(
+        absl::MakeSpan(output->data() + read, size - read));
+    if (!read_result.ok()) return read_result.status();
+    read += read_result.ValueOrDie();
+    if (read < size) {
+      output->resize(read);
+      return Status(util::error::OUT_OF_RANGE, "Reached end of stream.");
+    }
+    if (size == count) return Status::OK;
+    size = std::min(count, 2 * size);
+  }
+}
+
+// Returns true iff 'input_stream' has no more bytes, without changing its
+// position.
+StatusOr<bool> AtEndOfStream(InputStream* input_stream) {
   const void* buffer;
-  int bytes_to_be_read = count;
-  int read_bytes;    // bytes read in one Next()-call
-  int needed_bytes;  // bytes actually needed
-  output->resize(count);
-  while (bytes_to_be_read > 0) {
+  while (true) {
     auto next_result = input_stream->Next(&buffer);
     if (next_result.status().error_code() == util::error::OUT_OF_RANGE) {
-      // End of stream.
-      output->resize(count - bytes_to_be_read);
-      return next_result.status();
+      return true;
     }
     if (!next_result.ok()) return next_result.status();
-    read_bytes = next_result.ValueOrDie();
-    needed_bytes = std::min(read_bytes, bytes_to_be_read);
-    memcpy(output->data() + (count - bytes_to_be_read), buffer, needed_bytes);
-    bytes_to_be_read -= needed_bytes;
-  }
-  if (read_bytes > needed_bytes) {
-    input_stream->BackUp(read_bytes - needed_bytes);
+    if (next_result.ValueOrDie() > 0) {
+      input_stream->BackUp(next_result.ValueOrDie());
+      return false;
+    }
   }
-  return Status::OK;
+}
+
+// Reads a ciphertext segment, which has 'segment_size' bytes unless it is
+// the last one, into 'buffer', in chunks of at first 'initial_read_size'
+// bytes.  Returns whether it is the last segment.
+StatusOr<bool> ReadSegment(InputStream* input_stream, int segment_size,
+                           int initial_read_size,
+                           std::vector<uint8_t>* buffer) {
+  Status status =
+      ReadFromStream(input_stream, segment_size, initial_read_size, buffer);
+  if (status.error_code() == util::error::OUT_OF_RANGE) return true;
+  if (!status.ok()) return status;
+  // A full segment is the last one iff no ciphertext follows it.  This
+  // must be known before decrypting, as decrypting in place overwrites
+  // the ciphertext even if it fails.
+  return AtEndOfStream(input_stream);
 }
 
 }  // anonymous namespace
 
+constexpr int StreamingAeadDecryptingStream::kInitialBufferSize;
+
 // static
 StatusOr<std::unique_ptr<InputStream>> StreamingAeadDecryptingStream::New(
     std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
     std::unique_ptr<InputStream> ciphertext_source) {
+  return New(std::move(segment_decrypter), std::move(ciphertext_source),
+             /* buffer_pool = */ nullptr);
+}
+
+// static
+StatusOr<std::unique_ptr<InputStream>> StreamingAeadDecryptingStream::New(
+    std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+    std::unique_ptr<InputStream> ciphertext_source,
+    std::shared_ptr<SegmentBufferPool> buffer_pool) {
+  return NewWithSizeHint(std::move(segment_decrypter),
+                         std::move(ciphertext_source),
+                         /* ciphertext_size_hint = */ -1,
+                         std::move(buffer_pool));
+}
+
+// static
+StatusOr<std::unique_ptr<InputStream>>
+StreamingAeadDecryptingStream::NewWithSizeHint(
+    std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+    std::unique_ptr<InputStream> ciphertext_source,
+    int64_t ciphertext_size_hint,
+    std::shared_ptr<SegmentBufferPool> buffer_pool) {
+  if (ciphertext_size_hint < -1) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "ciphertext_size_hint must be non-negative or -1");
+  }
   if (segment_decrypter == nullptr) {
     return Status(util::error::INVALID_ARGUMENT,
                   "segment_decrypter must be non-null");
@@ -91,6 +153,7 @@ StatusOr<std::unique_ptr<InputStream>> StreamingAeadDecryptingStream::New(
       new StreamingAeadDecryptingStream());
   dec_stream->segment_decrypter_ = std::move(segment_decrypter);
   dec_stream->ct_source_ = std::move(ciphertext_source);
+  dec_stream->buffer_pool_ = std::move(buffer_pool);
   int first_segment_size =
       dec_stream->segment_decrypter_->get_ciphertext_segment_size() -
       dec_stream->segment_decrypter_->get_ciphertext_offset() -
@@ -99,25 +162,86 @@ StatusOr<std::unique_ptr<InputStream>> StreamingAeadDecryptingStream::New(
     return Status(util::error::INTERNAL,
                   "Size of the first segment must be greater than 0.");
   }
-  dec_stream->ct_buffer_.resize(first_segment_size);
+  // Without a pool, buffer_ grows while the first segment is read.  If the
+  // size of the ciphertext is known, the first read asks for one more
+  // byte than the ciphertext has, so that it also finds its end.
+  if (dec_stream->buffer_pool_ != nullptr) {
+    dec_stream->buffer_ = dec_stream->buffer_pool_->Acquire(
+        dec_stream->segment_decrypter_->get_ciphertext_segment_size());
+  }
+  dec_stream->first_read_size_ =
+      std::min(first_segment_size, kInitialBufferSize);
+  if (ciphertext_size_hint >= 0) {
+    int64_t header_size = dec_stream->segment_decrypter_->get_header_size();
+    dec_stream->first_read_size_ = static_cast<int>(std::min<int64_t>(
+        first_segment_size,
+        std::max<int64_t>(ciphertext_size_hint - header_size + 1, 1)));
+  }
   dec_stream->position_ = 0;
   dec_stream->segment_number_ = 0;
   dec_stream->is_initialized_ = false;
   dec_stream->read_last_segment_ = false;
+  dec_stream->pt_count_ = 0;
   dec_stream->count_backedup_ = first_segment_size;
   dec_stream->pt_buffer_offset_ = 0;
   dec_stream->status_ = Status::OK;
   return {std::move(dec_stream)};
 }
 
+// static
+StatusOr<std::unique_ptr<InputStream>>
+StreamingAeadDecryptingStream::NewPipelined(
+    std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+    std::unique_ptr<InputStream> ciphertext_source, int read_ahead,
+    std::shared_ptr<Executor> executor,
+    std::shared_ptr<SegmentBufferPool> buffer_pool) {
+  if (read_ahead < 1) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "read_ahead must be positive");
+  }
+  auto stream_result =
+      New(std::move(segment_decrypter), std::move(ciphertext_source),
+          std::move(buffer_pool));
+  if (!stream_result.ok()) return stream_result.status();
+  auto* dec_stream = static_cast<StreamingAeadDecryptingStream*>(
+      stream_result.ValueOrDie().get());
+  if (executor == nullptr) {
+    executor = std::make_shared<internal::ThreadPool>(read_ahead + 1);
+  }
+  dec_stream->executor_ = std::move(executor);
+  dec_stream->read_ahead_ = read_ahead;
+  return stream_result;
+}
+
+StreamingAeadDecryptingStream::~StreamingAeadDecryptingStream() {
+  if (executor_ != nullptr) {
+    // The tasks refer to this stream.
+    absl::MutexLock lock(&pipeline_mutex_);
+    stopping_ = true;
+    pipeline_mutex_.Await(absl::Condition(
+        +[](int* active_tasks) { return *active_tasks == 0; },
+        &active_tasks_));
+    if (buffer_pool_ != nullptr) {
+      for (auto& segment : pipeline_) {
+        buffer_pool_->Release(std::move(segment->buffer));
+      }
+      for (auto& buffer : free_buffers_) {
+        buffer_pool_->Release(std::move(buffer));
+      }
+    }
+  }
+  if (buffer_pool_ != nullptr) buffer_pool_->Release(std::move(buffer_));
+}
+
 StatusOr<int> StreamingAeadDecryptingStream::Next(const void** data) {
   if (!status_.ok()) return status_;
 
   // The first call to Next().
   if (!is_initialized_) {
     std::vector<uint8_t> header;
-    status_ = ReadFromStream(ct_source_.get(),
-                             segment_decrypter_->get_header_size(), &header);
+    int header_size = segment_decrypter_->get_header_size();
+    status_ = ReadFromStream(ct_source_.get(), header_size, header_size,
+                             &header);
     if (status_.error_code() == util::error::OUT_OF_RANGE) {
       status_ = Status(util::error::INVALID_ARGUMENT,
                        "Could not read stream header.");
@@ -127,38 +251,33 @@ StatusOr<int> StreamingAeadDecryptingStream::Next(const void** data) {
     if (!status_.ok()) return status_;
     is_initialized_ = true;
     count_backedup_ = 0;
-    status_ = ReadFromStream(ct_source_.get(), ct_buffer_.size(), &ct_buffer_);
-    if (!status_.ok() && (status_.error_code() != util::error::OUT_OF_RANGE)) {
-      return status_;
-    }
-    read_last_segment_ = (status_.error_code() == util::error::OUT_OF_RANGE);
-    status_ = segment_decrypter_->DecryptSegment(
-        ct_buffer_,
-        /* segment_number = */ segment_number_,
-        /* is_last_segment = */ read_last_segment_,
-        &pt_buffer_);
-    if (!status_.ok() && !read_last_segment_) {
-      // Try decrypting as the last segment, if haven't tried yet.
-      read_last_segment_ = true;
-      status_ = segment_decrypter_->DecryptSegment(
-          ct_buffer_,
-          /* segment_number = */ segment_number_,
-          /* is_last_segment = */ read_last_segment_,
-          &pt_buffer_);
-    }
+    int first_segment_size = segment_decrypter_->get_ciphertext_segment_size() -
+                             segment_decrypter_->get_ciphertext_offset() -
+                             header_size;
+    status_ = ReadAndDecryptSegment(first_segment_size, first_read_size_,
+                                    /* destination = */ nullptr);
     if (!status_.ok()) return status_;
-    *data = pt_buffer_.data();
-    position_ = pt_buffer_.size();
-    return pt_buffer_.size();
+    if (executor_ != nullptr && !read_last_segment_) {
+      bool start_reader;
+      {
+        absl::MutexLock lock(&pipeline_mutex_);
+        next_read_segment_ = 1;
+        start_reader = ClaimReadAhead();
+      }
+      if (start_reader) executor_->Schedule([this]() { ReadAhead(); });
+    }
+    *data = buffer_.data();
+    position_ = pt_count_;
+    return pt_count_;
   }
 
   // If some bytes were backed up, return them first.
   if (count_backedup_ > 0) {
     position_ += count_backedup_;
-    pt_buffer_offset_ = pt_buffer_.size() - count_backedup_;
+    pt_buffer_offset_ = pt_count_ - count_backedup_;
     int backedup = count_backedup_;
     count_backedup_ = 0;
-    *data = pt_buffer_.data() + pt_buffer_offset_;
+    *data = buffer_.data() + pt_buffer_offset_;
     return backedup;
   }
 
@@ -169,36 +288,198 @@ StatusOr<int> StreamingAeadDecryptingStream::Next(const void** data) {
     return status_;
   }
   segment_number_++;
-  ct_buffer_.resize(segment_decrypter_->get_ciphertext_segment_size());
-  status_ = ReadFromStream(ct_source_.get(), ct_buffer_.size(), &ct_buffer_);
-  if (!status_.ok() && (status_.error_code() != util::error::OUT_OF_RANGE)) {
-    return status_;
+  if (executor_ != nullptr) {
+    status_ = TakePipelinedSegment();
+  } else {
+    int ct_segment_size = segment_decrypter_->get_ciphertext_segment_size();
+    status_ = ReadAndDecryptSegment(ct_segment_size, ct_segment_size,
+                                    /* destination = */ nullptr);
+  }
+  if (!status_.ok()) return status_;
+  *data = buffer_.data();
+  pt_buffer_offset_ = 0;
+  position_ += pt_count_;
+  return pt_count_;
+}
+
+Status StreamingAeadDecryptingStream::ReadAndDecryptSegment(
+    int segment_size, int initial_read_size, uint8_t* destination) {
+  // The span covers reading the segment too, so that it shows slow sources.
+  internal::TracedOperation operation("tink.streaming_aead.decrypt_segment");
+  operation.SetAttribute("tink.segment_number", segment_number_);
+  auto is_last_result = ReadSegment(ct_source_.get(), segment_size,
+                                    initial_read_size, &buffer_);
+  operation.SetAttribute("tink.bytes", buffer_.size());
+  if (!is_last_result.ok()) {
+    operation.SetStatus(is_last_result.status());
+    return is_last_result.status();
   }
-  read_last_segment_ = (status_.error_code() == util::error::OUT_OF_RANGE);
-  status_ = segment_decrypter_->DecryptSegment(
-      ct_buffer_,
+  read_last_segment_ = is_last_result.ValueOrDie();
+  int segment_overhead = segment_decrypter_->get_ciphertext_segment_size() -
+                         segment_decrypter_->get_plaintext_segment_size();
+  pt_count_ = std::max(static_cast<int>(buffer_.size()) - segment_overhead, 0);
+  if (destination == nullptr) destination = buffer_.data();
+  Status status = segment_decrypter_->DecryptSegmentInto(
+      absl::MakeConstSpan(buffer_),
       /* segment_number = */ segment_number_,
       /* is_last_segment = */ read_last_segment_,
-      &pt_buffer_);
-  if (!status_.ok() && !read_last_segment_) {
-    // Try decrypting as the last segment, if haven't tried yet.
-    read_last_segment_ = true;
-    status_ = segment_decrypter_->DecryptSegment(
-        ct_buffer_,
-        /* segment_number = */ segment_number_,
-        /* is_last_segment = */ read_last_segment_,
-        &pt_buffer_);
+      absl::MakeSpan(destination, pt_count_));
+  operation.SetStatus(status);
+  return status;
+}
+
+bool StreamingAeadDecryptingStream::ClaimReadAhead() {
+  if (reader_running_ || reader_done_ || stopping_ ||
+      pipeline_.size() >= static_cast<size_t>(read_ahead_)) {
+    return false;
   }
-  if (!status_.ok()) return status_;
-  *data = pt_buffer_.data();
-  pt_buffer_offset_ = 0;
-  position_ += pt_buffer_.size();
-  return pt_buffer_.size();
+  reader_running_ = true;
+  ++active_tasks_;
+  return true;
+}
+
+std::vector<uint8_t> StreamingAeadDecryptingStream::AcquireBuffer() {
+  if (!free_buffers_.empty()) {
+    std::vector<uint8_t> buffer = std::move(free_buffers_.back());
+    free_buffers_.pop_back();
+    return buffer;
+  }
+  int capacity = segment_decrypter_->get_ciphertext_segment_size();
+  if (buffer_pool_ != nullptr) return buffer_pool_->Acquire(capacity);
+  std::vector<uint8_t> buffer;
+  buffer.reserve(capacity);
+  return buffer;
+}
+
+void StreamingAeadDecryptingStream::ReadAhead() {
+  int ct_segment_size = segment_decrypter_->get_ciphertext_segment_size();
+  while (true) {
+    PipelinedSegment* segment;
+    {
+      absl::MutexLock lock(&pipeline_mutex_);
+      if (stopping_ || pipeline_.size() >= static_cast<size_t>(read_ahead_)) {
+        reader_running_ = false;
+        --active_tasks_;
+        return;
+      }
+      pipeline_.push_back(absl::make_unique<PipelinedSegment>());
+      segment = pipeline_.back().get();
+      segment->buffer = AcquireBuffer();
+      segment->segment_number = next_read_segment_++;
+    }
+    auto is_last_result = ReadSegment(ct_source_.get(), ct_segment_size,
+                                      ct_segment_size, &segment->buffer);
+    {
+      absl::MutexLock lock(&pipeline_mutex_);
+      if (!is_last_result.ok()) {
+        segment->status = is_last_result.status();
+        segment->ready = true;
+        reader_done_ = true;
+        reader_running_ = false;
+        --active_tasks_;
+        return;
+      }
+      segment->is_last_segment = is_last_result.ValueOrDie();
+      ++active_tasks_;
+    }
+    // 'segment' may be consumed as soon as it is decrypted.
+    bool is_last_segment = is_last_result.ValueOrDie();
+    executor_->Schedule(
+        [this, segment]() { DecryptPipelinedSegment(segment); });
+    if (is_last_segment) {
+      absl::MutexLock lock(&pipeline_mutex_);
+      reader_done_ = true;
+      reader_running_ = false;
+      --active_tasks_;
+      return;
+    }
+  }
+}
+
+void StreamingAeadDecryptingStream::DecryptPipelinedSegment(
+    PipelinedSegment* segment) {
+  internal::TracedOperation operation("tink.streaming_aead.decrypt_segment");
+  operation.SetAttribute("tink.segment_number", segment->segment_number);
+  operation.SetAttribute("tink.bytes", segment->buffer.size());
+  int segment_overhead = segment_decrypter_->get_ciphertext_segment_size() -
+                         segment_decrypter_->get_plaintext_segment_size();
+  int pt_count =
+      std::max(static_cast<int>(segment->buffer.size()) - segment_overhead, 0);
+  Status status = segment_decrypter_->DecryptSegmentInto(
+      absl::MakeConstSpan(segment->buffer), segment->segment_number,
+      segment->is_last_segment,
+      absl::MakeSpan(segment->buffer.data(), pt_count));
+  operation.SetStatus(status);
+  absl::MutexLock lock(&pipeline_mutex_);
+  segment->pt_count = pt_count;
+  segment->status = status;
+  segment->ready = true;
+  --active_tasks_;
+}
+
+Status StreamingAeadDecryptingStream::TakePipelinedSegment() {
+  std::unique_ptr<PipelinedSegment> segment;
+  bool start_reader;
+  {
+    absl::MutexLock lock(&pipeline_mutex_);
+    auto ready = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(pipeline_mutex_) {
+      return pipeline_.empty() ? !reader_running_ : pipeline_.front()->ready;
+    };
+    pipeline_mutex_.Await(absl::Condition(&ready));
+    if (pipeline_.empty()) {
+      return Status(util::error::INTERNAL, "No segment was read ahead");
+    }
+    segment = std::move(pipeline_.front());
+    pipeline_.pop_front();
+    // The previous segment is consumed.
+    buffer_.swap(segment->buffer);
+    free_buffers_.push_back(std::move(segment->buffer));
+    start_reader = ClaimReadAhead();
+  }
+  if (start_reader) executor_->Schedule([this]() { ReadAhead(); });
+  pt_count_ = segment->pt_count;
+  read_last_segment_ = segment->is_last_segment;
+  return segment->status;
+}
+
+StatusOr<int> StreamingAeadDecryptingStream::ReadInto(
+    absl::Span<uint8_t> buffer) {
+  int count = 0;
+  int size = buffer.size();
+  int pt_segment_size = segment_decrypter_->get_plaintext_segment_size();
+  while (count < size) {
+    if (executor_ == nullptr && is_initialized_ && status_.ok() &&
+        count_backedup_ == 0 && !read_last_segment_ &&
+        size - count >= pt_segment_size) {
+      // Decrypt the next segment directly into 'buffer', leaving no
+      // plaintext in buffer_.
+      segment_number_++;
+      int ct_segment_size = segment_decrypter_->get_ciphertext_segment_size();
+      status_ = ReadAndDecryptSegment(ct_segment_size, ct_segment_size,
+                                      buffer.data() + count);
+      if (!status_.ok()) return status_;
+      count += pt_count_;
+      position_ += pt_count_;
+      pt_count_ = 0;
+      pt_buffer_offset_ = 0;
+      continue;
+    }
+    const void* data;
+    auto next_result = Next(&data);
+    if (next_result.status().error_code() == util::error::OUT_OF_RANGE) break;
+    if (!next_result.ok()) return next_result.status();
+    int available = next_result.ValueOrDie();
+    int needed = std::min(available, size - count);
+    memcpy(buffer.data() + count, data, needed);
+    count += needed;
+    BackUp(available - needed);
+  }
+  return count;
 }
 
 void StreamingAeadDecryptingStream::BackUp(int count) {
   if (!is_initialized_ || !status_.ok() || count < 1) return;
-  int curr_buffer_size = pt_buffer_.size() - pt_buffer_offset_;
+  int curr_buffer_size = pt_count_ - pt_buffer_offset_;
   int actual_count = std::min(count, curr_buffer_size - count_backedup_);
   count_backedup_ += actual_count;
   position_ -= actual_count;
@@ -17,10 +17,17 @@
 #ifndef TINK_SUBTLE_STREAMING_AEAD_DECRYPTING_STREAM_H_
 #define TINK_SUBTLE_STREAMING_AEAD_DECRYPTING_STREAM_H_
 
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "tink/executor.h"
 #include "tink/input_stream.h"
+#include "tink/subtle/segment_buffer_pool.h"
 #include "tink/subtle/stream_segment_decrypter.h"
 #include "tink/util/statusor.h"
 
@@ -36,36 +43,153 @@ class StreamingAeadDecryptingStream : public InputStream {
   // underlying ciphertext by 'segment_decrypter', using 'associated_data' as
   // associated authenticated data, and the read bytes are bytes of the
   // resulting plaintext.
+  //
+  // Segments are decrypted in place, which overwrites their ciphertext even
+  // if decryption fails, so a segment cannot be decrypted again as the last
+  // one after failing as a middle one.  The stream thus decrypts a full
+  // segment only once it knows whether more ciphertext follows it: it reads
+  // ahead until 'ciphertext_source' returns at least one byte of the next
+  // segment, or reports its end.  On a source which blocks until more data
+  // arrives (e.g. a socket), the plaintext of segment i is therefore not
+  // returned before segment i + 1 starts to arrive, or the source is
+  // closed.  This holds for the streams of all the factories below.
   static
   crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
       New(std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
           std::unique_ptr<crypto::tink::InputStream> ciphertext_source);
 
+  // Like New() above, but the buffer of the stream comes from 'buffer_pool',
+  // and is returned to it when the stream is destroyed.  If 'buffer_pool' is
+  // null, the stream allocates its buffer itself.
+  static
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
+      New(std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+          std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
+          std::shared_ptr<SegmentBufferPool> buffer_pool);
+
+  // Like New() above, but 'ciphertext_size_hint' is the number of bytes of
+  // 'ciphertext_source', if known, or -1.  A ciphertext of at most a
+  // segment is then read with a single read into a buffer of its size.
+  static
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
+      NewWithSizeHint(
+          std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+          std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
+          int64_t ciphertext_size_hint,
+          std::shared_ptr<SegmentBufferPool> buffer_pool);
+
+  // Like New() above, but reads and decrypts up to 'read_ahead' segments
+  // ahead of the consumer, while it processes the current one: one task
+  // reads the ciphertext segments in order, and each segment is then
+  // decrypted by a task of its own.  The tasks run on 'executor', or on
+  // 'read_ahead' + 1 threads owned by the stream if 'executor' is null; the
+  // reading task blocks on 'ciphertext_source', so a shared executor needs
+  // a thread to spare for it.  The stream holds at most 'read_ahead' + 1
+  // ciphertext segments, and returns the same data and errors, at the
+  // same positions, as a stream of New(); only 'ciphertext_source' may be
+  // read further than the segment at which an error is returned.
+  static
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
+      NewPipelined(
+          std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+          std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
+          int read_ahead, std::shared_ptr<Executor> executor,
+          std::shared_ptr<SegmentBufferPool> buffer_pool);
+
+  // The buffer of the first segment grows on demand, up to the size of the
+  // segment: the segment is read in chunks of at first kInitialBufferSize
+  // bytes (unless the stream has a size hint), and then twice as many bytes
+  // as were read so far, so that small streams do not allocate (and zero)
+  // a buffer of the segment size.
+  static constexpr int kInitialBufferSize = 1 << 12;
+
+  ~StreamingAeadDecryptingStream() override;
+
   // -----------------------
   // Methods of InputStream-interface implemented by this class.
   crypto::tink::util::StatusOr<int> Next(const void** data) override;
   void BackUp(int count) override;
   int64_t Position() const override;
 
+  // Decrypts full segments directly into 'buffer'.
+  crypto::tink::util::StatusOr<int> ReadInto(
+      absl::Span<uint8_t> buffer) override;
+
  private:
+  // A segment read ahead by a pipelined stream.
+  struct PipelinedSegment {
+    std::vector<uint8_t> buffer;  // decrypted in place
+    int64_t segment_number;
+    bool is_last_segment = false;
+    int pt_count = 0;
+    crypto::tink::util::Status status;
+    bool ready = false;  // true once decrypted, or if reading failed
+  };
+
   StreamingAeadDecryptingStream() {}
+  // Reads the next ciphertext segment, which has 'segment_size' bytes
+  // unless it is the last one, into buffer_, and decrypts it into
+  // 'destination', which has room for a plaintext segment, or in place
+  // if 'destination' is null.  Reads chunks of at first
+  // 'initial_read_size' bytes.
+  crypto::tink::util::Status ReadAndDecryptSegment(int segment_size,
+                                                   int initial_read_size,
+                                                   uint8_t* destination);
+
+  // Makes the next read-ahead segment the current one, in buffer_.
+  crypto::tink::util::Status TakePipelinedSegment();
+  // Returns true if the reading task is to be scheduled, i.e. if it is not
+  // running and has segments to read, and then counts it as running.
+  bool ClaimReadAhead() ABSL_EXCLUSIVE_LOCKS_REQUIRED(pipeline_mutex_);
+  // The reading task: reads segments while fewer than read_ahead_ are
+  // pending, and schedules their decryption.
+  void ReadAhead();
+  void DecryptPipelinedSegment(PipelinedSegment* segment);
+  // Returns an empty buffer for a ciphertext segment.
+  std::vector<uint8_t> AcquireBuffer()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(pipeline_mutex_);
+
   std::unique_ptr<StreamSegmentDecrypter> segment_decrypter_;
   std::unique_ptr<crypto::tink::InputStream> ct_source_;
-  std::vector<uint8_t> ct_buffer_;  // ciphertext buffer
-  std::vector<uint8_t> pt_buffer_;  // plaintext buffer
+  std::shared_ptr<SegmentBufferPool> buffer_pool_;  // may be null
+  // A ciphertext segment, which is decrypted in place, so that the
+  // plaintext is in its first pt_count_ bytes.
+  std::vector<uint8_t> buffer_;
+  int pt_count_;
   int64_t position_;  // number of plaintext bytes read from this stream
   int64_t segment_number_;  // current segment number
   crypto::tink::util::Status status_;  // status of the stream
 
-  // Counters that describe the state of the data in pt_buffer_.
-  int count_backedup_;    // # bytes in pt_buffer_ that were backed up
-  int pt_buffer_offset_;  // offset at which *data starts in pt_buffer_
+  // Counters that describe the state of the plaintext in buffer_.
+  int count_backedup_;    // # bytes in buffer_ that were backed up
+  int pt_buffer_offset_;  // offset at which *data starts in buffer_
+  // The size of the first read of the first segment.
+  int first_read_size_;
 
   // Flag that indicates whether the decrypting stream has been initialized.
   // If true, the header of the ciphertext stream has been already read
   // and processed.
   bool is_initialized_;
   bool read_last_segment_;
+
+  // Used only by pipelined streams, otherwise 'executor_' is null.  Once
+  // the first segment is decrypted, ct_source_ is only read by the reading
+  // task.
+  std::shared_ptr<Executor> executor_;
+  int read_ahead_ = 0;
+  absl::Mutex pipeline_mutex_;
+  // The segments read ahead, in order.
+  std::deque<std::unique_ptr<PipelinedSegment>> pipeline_
+      ABSL_GUARDED_BY(pipeline_mutex_);
+  std::vector<std::vector<uint8_t>> free_buffers_
+      ABSL_GUARDED_BY(pipeline_mutex_);
+  int64_t next_read_segment_ ABSL_GUARDED_BY(pipeline_mutex_) = 0;
+  // The number of scheduled tasks which have not finished.
+  int active_tasks_ ABSL_GUARDED_BY(pipeline_mutex_) = 0;
+  bool reader_running_ ABSL_GUARDED_BY(pipeline_mutex_) = false;
+  // Set once the last segment was read, or reading failed.
+  bool reader_done_ ABSL_GUARDED_BY(pipeline_mutex_) = false;
+  bool stopping_ ABSL_GUARDED_BY(pipeline_mutex_) = false;
 };
 
 }  // namespace subtle
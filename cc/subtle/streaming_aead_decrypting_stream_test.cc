@@ -16,6 +16,7 @@
 
 #include "tink/subtle/streaming_aead_decrypting_stream.h"
 
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -23,9 +24,12 @@
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/input_stream.h"
+#include "tink/internal/thread_pool.h"
 #include "tink/subtle/stream_segment_decrypter.h"
 #include "tink/subtle/random.h"
+#include "tink/subtle/segment_buffer_pool.h"
 #include "tink/subtle/test_util.h"
 #include "tink/util/istream_input_stream.h"
 #include "tink/util/status.h"
@@ -51,7 +55,8 @@ struct ValidationRefs {
 // with references to internal objects, used for test validation.
 std::unique_ptr<InputStream> GetDecryptingStream(
     int pt_segment_size, int header_size, int ct_offset,
-    absl::string_view ciphertext, ValidationRefs* refs) {
+    absl::string_view ciphertext, ValidationRefs* refs,
+    std::shared_ptr<SegmentBufferPool> buffer_pool = nullptr) {
   // Prepare ciphertext source stream.
   auto ct_stream =
       absl::make_unique<std::stringstream>(std::string(ciphertext));
@@ -62,7 +67,8 @@ std::unique_ptr<InputStream> GetDecryptingStream(
   // A reference to the segment decrypter, for later validation.
   refs->seg_dec = seg_dec.get();
   auto dec_stream = std::move(StreamingAeadDecryptingStream::New(
-      std::move(seg_dec), std::move(ct_source)).ValueOrDie());
+      std::move(seg_dec), std::move(ct_source),
+      std::move(buffer_pool)).ValueOrDie());
   EXPECT_EQ(0, dec_stream->Position());
   return dec_stream;
 }
@@ -120,6 +126,239 @@ TEST_F(StreamingAeadDecryptingStreamTest, WritingStreams) {
   }
 }
 
+TEST_F(StreamingAeadDecryptingStreamTest, PooledBuffers) {
+  auto buffer_pool = std::make_shared<SegmentBufferPool>();
+  int header_size = 10;
+  int ct_offset = 5;
+  // Consecutive streams reuse the buffers of their predecessors.
+  for (auto pt_segment_size : {1000, 64, 100000, 1000}) {
+    SCOPED_TRACE(absl::StrCat("pt_segment_size = ", pt_segment_size));
+    std::string pt = Random::GetRandomBytes(300000);
+    DummyStreamSegmentEncrypter seg_enc(pt_segment_size, header_size,
+        ct_offset);
+    std::string ct = seg_enc.GenerateCiphertext(pt);
+    ValidationRefs refs;
+    auto dec_stream = GetDecryptingStream(pt_segment_size, header_size,
+        ct_offset, ct, &refs, buffer_pool);
+    std::string decrypted;
+    auto status = test::ReadFromStream(dec_stream.get(), &decrypted);
+    EXPECT_TRUE(status.ok()) << status;
+    EXPECT_EQ(pt, decrypted);
+  }
+}
+
+TEST_F(StreamingAeadDecryptingStreamTest, ReadInto) {
+  int header_size = 10;
+  int ct_offset = 5;
+  for (auto pt_segment_size : {64, 1000}) {
+    for (auto pt_size : {0, 100, 10000, 100000}) {
+      SCOPED_TRACE(absl::StrCat("pt_segment_size = ", pt_segment_size,
+                                ", pt_size = ", pt_size));
+      std::string pt = Random::GetRandomBytes(pt_size);
+      DummyStreamSegmentEncrypter seg_enc(pt_segment_size, header_size,
+          ct_offset);
+      std::string ct = seg_enc.GenerateCiphertext(pt);
+      ValidationRefs refs;
+      auto dec_stream = GetDecryptingStream(pt_segment_size, header_size,
+          ct_offset, ct, &refs);
+      std::string decrypted;
+      for (int read_size : {0, 10, 5000, 1, 64, 65, 1000, 1001, 20000}) {
+        SCOPED_TRACE(absl::StrCat("read_size = ", read_size));
+        std::string chunk(read_size, '\0');
+        auto read_result = dec_stream->ReadInto(absl::MakeSpan(
+            reinterpret_cast<uint8_t*>(&chunk[0]), chunk.size()));
+        EXPECT_TRUE(read_result.ok()) << read_result.status();
+        decrypted += chunk.substr(0, read_result.ValueOrDie());
+        EXPECT_EQ(decrypted.size(), dec_stream->Position());
+
+        // Next() and BackUp() still work in between.
+        const void* buffer;
+        auto next_result = dec_stream->Next(&buffer);
+        if (!next_result.ok()) {
+          EXPECT_EQ(util::error::OUT_OF_RANGE,
+                    next_result.status().error_code());
+          continue;
+        }
+        int next_count = std::min(next_result.ValueOrDie(), 7);
+        decrypted.append(static_cast<const char*>(buffer), next_count);
+        dec_stream->BackUp(next_result.ValueOrDie() - next_count);
+        EXPECT_EQ(decrypted.size(), dec_stream->Position());
+      }
+      std::string rest(pt_size + 1, '\0');
+      auto read_result = dec_stream->ReadInto(
+          absl::MakeSpan(reinterpret_cast<uint8_t*>(&rest[0]), rest.size()));
+      EXPECT_TRUE(read_result.ok()) << read_result.status();
+      EXPECT_LT(read_result.ValueOrDie(), rest.size());
+      decrypted += rest.substr(0, read_result.ValueOrDie());
+      EXPECT_EQ(pt, decrypted);
+    }
+  }
+}
+
+TEST_F(StreamingAeadDecryptingStreamTest, SizeHint) {
+  int pt_segment_size = 100000;
+  int header_size = 10;
+  int ct_offset = 5;
+  for (int pt_size : {0, 1, 200, 10000, 99000, 250000}) {
+    std::string pt = Random::GetRandomBytes(pt_size);
+    DummyStreamSegmentEncrypter seg_enc(pt_segment_size, header_size,
+        ct_offset);
+    std::string ct = seg_enc.GenerateCiphertext(pt);
+    int ct_size = ct.size();
+    // Hints that are wrong are allowed too.
+    for (int hint : {ct_size, ct_size - 1, ct_size / 2, 2 * ct_size, 0}) {
+      SCOPED_TRACE(absl::StrCat("pt_size = ", pt_size, ", hint = ", hint));
+      auto result = StreamingAeadDecryptingStream::NewWithSizeHint(
+          absl::make_unique<DummyStreamSegmentDecrypter>(
+              pt_segment_size, header_size, ct_offset),
+          absl::make_unique<IstreamInputStream>(
+              absl::make_unique<std::stringstream>(ct)),
+          hint, /* buffer_pool = */ nullptr);
+      ASSERT_TRUE(result.ok()) << result.status();
+      std::string decrypted;
+      auto status = test::ReadFromStream(result.ValueOrDie().get(),
+                                         &decrypted);
+      EXPECT_TRUE(status.ok()) << status;
+      EXPECT_EQ(pt, decrypted);
+    }
+  }
+
+  auto result = StreamingAeadDecryptingStream::NewWithSizeHint(
+      absl::make_unique<DummyStreamSegmentDecrypter>(
+          pt_segment_size, header_size, ct_offset),
+      absl::make_unique<IstreamInputStream>(
+          absl::make_unique<std::stringstream>()),
+      /* ciphertext_size_hint = */ -2, /* buffer_pool = */ nullptr);
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+}
+
+std::unique_ptr<InputStream> GetPipelinedDecryptingStream(
+    int pt_segment_size, int header_size, int ct_offset,
+    absl::string_view ciphertext, int read_ahead,
+    std::shared_ptr<Executor> executor,
+    std::shared_ptr<SegmentBufferPool> buffer_pool = nullptr) {
+  auto result = StreamingAeadDecryptingStream::NewPipelined(
+      absl::make_unique<DummyStreamSegmentDecrypter>(
+          pt_segment_size, header_size, ct_offset),
+      absl::make_unique<IstreamInputStream>(
+          absl::make_unique<std::stringstream>(std::string(ciphertext))),
+      read_ahead, std::move(executor), std::move(buffer_pool));
+  EXPECT_TRUE(result.ok()) << result.status();
+  return std::move(result.ValueOrDie());
+}
+
+TEST_F(StreamingAeadDecryptingStreamTest, Pipelined) {
+  int header_size = 10;
+  int ct_offset = 5;
+  auto buffer_pool = std::make_shared<SegmentBufferPool>();
+  auto executor = std::make_shared<internal::ThreadPool>(2);
+  for (int read_ahead : {1, 4}) {
+    for (auto pt_segment_size : {64, 1000}) {
+      for (auto pt_size : {0, 10, 1000, 100000}) {
+        SCOPED_TRACE(absl::StrCat("read_ahead = ", read_ahead,
+                                  ", pt_segment_size = ", pt_segment_size,
+                                  ", pt_size = ", pt_size));
+        std::string pt = Random::GetRandomBytes(pt_size);
+        DummyStreamSegmentEncrypter seg_enc(pt_segment_size, header_size,
+            ct_offset);
+        std::string ct = seg_enc.GenerateCiphertext(pt);
+
+        auto dec_stream = GetPipelinedDecryptingStream(
+            pt_segment_size, header_size, ct_offset, ct, read_ahead,
+            /* executor = */ nullptr, buffer_pool);
+        std::string decrypted;
+        auto status = test::ReadFromStream(dec_stream.get(), &decrypted);
+        EXPECT_TRUE(status.ok()) << status;
+        EXPECT_EQ(pt, decrypted);
+        EXPECT_EQ(pt.size(), dec_stream->Position());
+
+        // With a shared executor, and reading with ReadInto() and BackUp().
+        dec_stream = GetPipelinedDecryptingStream(
+            pt_segment_size, header_size, ct_offset, ct, read_ahead,
+            executor);
+        decrypted.clear();
+        while (true) {
+          std::string chunk(3 * pt_segment_size / 2, '\0');
+          auto read_result = dec_stream->ReadInto(absl::MakeSpan(
+              reinterpret_cast<uint8_t*>(&chunk[0]), chunk.size()));
+          ASSERT_TRUE(read_result.ok()) << read_result.status();
+          decrypted += chunk.substr(0, read_result.ValueOrDie());
+          if (read_result.ValueOrDie() < chunk.size()) break;
+        }
+        EXPECT_EQ(pt, decrypted);
+      }
+    }
+  }
+}
+
+TEST_F(StreamingAeadDecryptingStreamTest, PipelinedErrors) {
+  int pt_segment_size = 100;
+  int header_size = 10;
+  int ct_offset = 0;
+  std::string pt = Random::GetRandomBytes(1000);
+  DummyStreamSegmentEncrypter seg_enc(pt_segment_size, header_size,
+      ct_offset);
+  std::string ct = seg_enc.GenerateCiphertext(pt);
+  std::string corrupted = ct;
+  // Corrupts the segment number of the fourth segment.
+  int ct_segment_size =
+      pt_segment_size + DummyStreamSegmentEncrypter::kSegmentTagSize;
+  corrupted[4 * ct_segment_size - 2] ^= 1;
+  // The same data and the same error as without read-ahead.
+  for (const std::string& ciphertext :
+       {corrupted, ct.substr(0, ct.size() - 2)}) {
+    ValidationRefs refs;
+    auto dec_stream = GetDecryptingStream(pt_segment_size, header_size,
+        ct_offset, ciphertext, &refs);
+    std::string decrypted;
+    auto status = test::ReadFromStream(dec_stream.get(), &decrypted);
+    ASSERT_FALSE(status.ok());
+    for (int read_ahead : {1, 3, 20}) {
+      SCOPED_TRACE(absl::StrCat("read_ahead = ", read_ahead));
+      auto pipelined_stream = GetPipelinedDecryptingStream(
+          pt_segment_size, header_size, ct_offset, ciphertext, read_ahead,
+          /* executor = */ nullptr);
+      std::string pipelined_decrypted;
+      auto pipelined_status = test::ReadFromStream(pipelined_stream.get(),
+                                                   &pipelined_decrypted);
+      EXPECT_EQ(status, pipelined_status);
+      EXPECT_EQ(decrypted, pipelined_decrypted);
+      EXPECT_EQ(dec_stream->Position(), pipelined_stream->Position());
+      // The error persists.
+      const void* buffer;
+      EXPECT_EQ(status, pipelined_stream->Next(&buffer).status());
+    }
+  }
+}
+
+TEST_F(StreamingAeadDecryptingStreamTest, PipelinedDestroyedEarly) {
+  int pt_segment_size = 64;
+  int header_size = 10;
+  std::string pt = Random::GetRandomBytes(100000);
+  DummyStreamSegmentEncrypter seg_enc(pt_segment_size, header_size,
+      /* ct_offset = */ 0);
+  std::string ct = seg_enc.GenerateCiphertext(pt);
+  auto buffer_pool = std::make_shared<SegmentBufferPool>();
+  for (int segments_read : {0, 1, 2, 10}) {
+    auto dec_stream = GetPipelinedDecryptingStream(
+        pt_segment_size, header_size, /* ct_offset = */ 0, ct,
+        /* read_ahead = */ 8, /* executor = */ nullptr, buffer_pool);
+    for (int i = 0; i < segments_read; i++) {
+      const void* buffer;
+      ASSERT_TRUE(dec_stream->Next(&buffer).ok());
+    }
+  }
+
+  auto result = StreamingAeadDecryptingStream::NewPipelined(
+      absl::make_unique<DummyStreamSegmentDecrypter>(
+          pt_segment_size, header_size, /* ct_offset = */ 0),
+      absl::make_unique<IstreamInputStream>(
+          absl::make_unique<std::stringstream>(ct)),
+      /* read_ahead = */ 0, /* executor = */ nullptr,
+      /* buffer_pool = */ nullptr);
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+}
+
 TEST_F(StreamingAeadDecryptingStreamTest, EmptyCiphertext) {
   int pt_segment_size = 512;
   int header_size = 64;
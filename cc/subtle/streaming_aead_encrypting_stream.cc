@@ -18,9 +18,17 @@
 
 #include <algorithm>
 #include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
+#include "absl/types/span.h"
+#include "tink/executor.h"
+#include "tink/internal/thread_pool.h"
+#include "tink/internal/traced_operation.h"
 #include "tink/output_stream.h"
+#include "tink/subtle/segment_buffer_pool.h"
 #include "tink/subtle/stream_segment_encrypter.h"
 #include "tink/util/statusor.h"
 
@@ -32,40 +40,83 @@ namespace crypto {
 namespace tink {
 namespace subtle {
 
-namespace {
-
-// Writes 'contents' to the specified 'output_stream', which must be non-null.
-// In case of errors returns the first non-OK status of
-// output_stream->Next()-operation.
-
-util::Status WriteToStream(const std::vector<uint8_t>& contents,
-                           OutputStream* output_stream) {
-  void* buffer;
-  int pos = 0;
-  int remaining = contents.size();
-  int available_space = 0;
-  int available_bytes = 0;
-  while (remaining > 0) {
-    auto next_result = output_stream->Next(&buffer);
-    if (!next_result.ok()) return next_result.status();
-    available_space = next_result.ValueOrDie();
-    available_bytes = std::min(available_space, remaining);
-    memcpy(buffer, contents.data() + pos, available_bytes);
-    remaining -= available_bytes;
-    pos += available_bytes;
+constexpr int StreamingAeadEncryptingStream::kInitialBufferSize;
+
+// static
+StatusOr<std::unique_ptr<OutputStream>> StreamingAeadEncryptingStream::New(
+    std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+    std::unique_ptr<OutputStream> ciphertext_destination) {
+  return New(std::move(segment_encrypter), std::move(ciphertext_destination),
+             /* parallelism = */ 1, /* buffer_pool = */ nullptr);
+}
+
+// static
+StatusOr<std::unique_ptr<OutputStream>> StreamingAeadEncryptingStream::New(
+    std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+    std::unique_ptr<OutputStream> ciphertext_destination, int parallelism) {
+  return New(std::move(segment_encrypter), std::move(ciphertext_destination),
+             parallelism, /* buffer_pool = */ nullptr);
+}
+
+// static
+StatusOr<std::unique_ptr<OutputStream>> StreamingAeadEncryptingStream::New(
+    std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+    std::unique_ptr<OutputStream> ciphertext_destination, int parallelism,
+    std::shared_ptr<SegmentBufferPool> buffer_pool) {
+  if (parallelism < 1) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "parallelism must be positive");
   }
-  if (available_space > available_bytes) {
-    output_stream->BackUp(available_space - available_bytes);
+  std::shared_ptr<Executor> executor;
+  if (parallelism > 1) {
+    executor = std::make_shared<internal::ThreadPool>(parallelism - 1);
   }
-  return Status::OK;
+  return Create(std::move(segment_encrypter),
+                std::move(ciphertext_destination), parallelism,
+                std::move(executor), std::move(buffer_pool),
+                /* plaintext_size_hint = */ -1);
 }
 
-}  // anonymous namespace
-
 // static
 StatusOr<std::unique_ptr<OutputStream>> StreamingAeadEncryptingStream::New(
     std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
-    std::unique_ptr<OutputStream> ciphertext_destination) {
+    std::unique_ptr<OutputStream> ciphertext_destination,
+    std::shared_ptr<Executor> executor,
+    std::shared_ptr<SegmentBufferPool> buffer_pool) {
+  if (executor == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT, "executor must be non-null");
+  }
+  int parallelism = executor->num_threads() + 1;
+  return Create(std::move(segment_encrypter),
+                std::move(ciphertext_destination), parallelism,
+                std::move(executor), std::move(buffer_pool),
+                /* plaintext_size_hint = */ -1);
+}
+
+// static
+StatusOr<std::unique_ptr<OutputStream>>
+StreamingAeadEncryptingStream::NewWithSizeHint(
+    std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+    std::unique_ptr<OutputStream> ciphertext_destination,
+    int64_t plaintext_size_hint,
+    std::shared_ptr<SegmentBufferPool> buffer_pool) {
+  if (plaintext_size_hint < -1) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "plaintext_size_hint must be non-negative or -1");
+  }
+  return Create(std::move(segment_encrypter),
+                std::move(ciphertext_destination), /* parallelism = */ 1,
+                /* executor = */ nullptr, std::move(buffer_pool),
+                plaintext_size_hint);
+}
+
+// static
+StatusOr<std::unique_ptr<OutputStream>> StreamingAeadEncryptingStream::Create(
+    std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+    std::unique_ptr<OutputStream> ciphertext_destination, int parallelism,
+    std::shared_ptr<Executor> executor,
+    std::shared_ptr<SegmentBufferPool> buffer_pool,
+    int64_t plaintext_size_hint) {
   if (segment_encrypter == nullptr) {
     return Status(util::error::INVALID_ARGUMENT,
                   "segment_encrypter must be non-null");
@@ -78,6 +129,7 @@ StatusOr<std::unique_ptr<OutputStream>> StreamingAeadEncryptingStream::New(
       new StreamingAeadEncryptingStream());
   enc_stream->segment_encrypter_ = std::move(segment_encrypter);
   enc_stream->ct_destination_ = std::move(ciphertext_destination);
+  enc_stream->buffer_pool_ = std::move(buffer_pool);
   int first_segment_size =
       enc_stream->segment_encrypter_->get_plaintext_segment_size() -
       enc_stream->segment_encrypter_->get_ciphertext_offset() -
@@ -87,16 +139,137 @@ StatusOr<std::unique_ptr<OutputStream>> StreamingAeadEncryptingStream::New(
     return Status(util::error::INTERNAL,
                   "Size of the first segment must be greater than 0.");
   }
-  enc_stream->pt_buffer_.resize(first_segment_size);
-  enc_stream->pt_to_encrypt_.resize(0);
+  // The first segment starts with the plaintext size given by the hint, or
+  // else with kInitialBufferSize bytes, and grows on demand.  Segments are
+  // encrypted in place, so the plaintext buffers get room for the
+  // ciphertext.  pt_to_encrypt_ is only needed past the first segment.
+  int initial_size = std::min(first_segment_size, kInitialBufferSize);
+  if (plaintext_size_hint >= 0) {
+    initial_size = static_cast<int>(std::min<int64_t>(
+        first_segment_size, std::max<int64_t>(plaintext_size_hint, 1)));
+  }
+  int segment_overhead =
+      enc_stream->segment_encrypter_->get_ciphertext_segment_size() -
+      enc_stream->segment_encrypter_->get_plaintext_segment_size();
+  enc_stream->pt_buffer_ =
+      enc_stream->AcquireBuffer(initial_size + segment_overhead);
+  enc_stream->pt_buffer_.resize(initial_size);
+  enc_stream->pt_buffer_limit_ = first_segment_size;
   enc_stream->position_ = 0;
   enc_stream->is_first_segment_ = true;
-  enc_stream->count_backedup_ = first_segment_size;
+  enc_stream->count_backedup_ = initial_size;
   enc_stream->pt_buffer_offset_ = 0;
   enc_stream->status_ = Status::OK;
+  enc_stream->next_segment_number_ =
+      enc_stream->segment_encrypter_->get_segment_number();
+  enc_stream->pending_count_ = 0;
+  if (parallelism == 1) return {std::move(enc_stream)};
+
+  int pt_segment_size =
+      enc_stream->segment_encrypter_->get_plaintext_segment_size();
+  int segments_per_thread =
+      std::max(1, kMinBatchSize / std::max(1, pt_segment_size));
+  int batch_size = parallelism * segments_per_thread;
+  int ct_segment_size =
+      enc_stream->segment_encrypter_->get_ciphertext_segment_size();
+  enc_stream->ct_buffer_ = enc_stream->AcquireBuffer(ct_segment_size);
+  for (int i = 0; i < batch_size; i++) {
+    enc_stream->pending_pt_.push_back(
+        enc_stream->AcquireBuffer(ct_segment_size));
+    enc_stream->pending_ct_.push_back(
+        enc_stream->AcquireBuffer(ct_segment_size));
+  }
+  enc_stream->pool_ = std::move(executor);
   return {std::move(enc_stream)};
 }
 
+StreamingAeadEncryptingStream::StreamingAeadEncryptingStream() {}
+
+StreamingAeadEncryptingStream::~StreamingAeadEncryptingStream() {
+  // The worker threads must not use the buffers any more.
+  pool_.reset();
+  if (buffer_pool_ == nullptr) return;
+  buffer_pool_->Release(std::move(pt_buffer_));
+  buffer_pool_->Release(std::move(ct_buffer_));
+  buffer_pool_->Release(std::move(pt_to_encrypt_));
+  for (auto& buffer : pending_pt_) buffer_pool_->Release(std::move(buffer));
+  for (auto& buffer : pending_ct_) buffer_pool_->Release(std::move(buffer));
+}
+
+std::vector<uint8_t> StreamingAeadEncryptingStream::AcquireBuffer(
+    int capacity) const {
+  if (buffer_pool_ != nullptr) {
+    return buffer_pool_->Acquire(
+        segment_encrypter_->get_ciphertext_segment_size());
+  }
+  std::vector<uint8_t> buffer;
+  buffer.reserve(capacity);
+  return buffer;
+}
+
+Status StreamingAeadEncryptingStream::EncryptSegment(
+    std::vector<uint8_t>* segment, bool is_last_segment) {
+  internal::TracedOperation operation("tink.streaming_aead.encrypt_segment");
+  operation.SetAttribute("tink.bytes", segment->size());
+  if (pool_ == nullptr) {
+    int pt_size = segment->size();
+    int segment_overhead = segment_encrypter_->get_ciphertext_segment_size() -
+                           segment_encrypter_->get_plaintext_segment_size();
+    segment->resize(pt_size + segment_overhead);
+    Status status = segment_encrypter_->EncryptSegmentInto(
+        absl::MakeConstSpan(segment->data(), pt_size), is_last_segment,
+        absl::MakeSpan(*segment));
+    operation.SetStatus(status);
+    return status;
+  }
+  operation.SetAttribute("tink.segment_number", next_segment_number_);
+  Status status = segment_encrypter_->EncryptSegmentAt(
+      next_segment_number_, *segment, is_last_segment, &ct_buffer_);
+  operation.SetStatus(status);
+  if (!status.ok()) return status;
+  next_segment_number_++;
+  segment->swap(ct_buffer_);
+  return Status::OK;
+}
+
+Status StreamingAeadEncryptingStream::AddPendingSegment() {
+  pending_pt_[pending_count_].swap(pt_to_encrypt_);
+  pending_count_++;
+  if (pending_count_ < static_cast<int>(pending_pt_.size())) {
+    return Status::OK;
+  }
+  return FlushPendingSegments();
+}
+
+Status StreamingAeadEncryptingStream::FlushPendingSegments() {
+  if (pending_count_ == 0) return Status::OK;
+  internal::TracedOperation operation("tink.streaming_aead.encrypt_segments");
+  operation.SetAttribute("tink.segment_number", next_segment_number_);
+  operation.SetAttribute("tink.segment_count", pending_count_);
+  std::vector<Status> statuses(pending_count_);
+  pool_->ParallelFor(pending_count_, [this, &statuses](int i) {
+    statuses[i] = segment_encrypter_->EncryptSegmentAt(
+        next_segment_number_ + i, pending_pt_[i],
+        /* is_last_segment = */ false, &pending_ct_[i]);
+  });
+  for (const Status& status : statuses) {
+    if (!status.ok()) {
+      operation.SetStatus(status);
+      return status;
+    }
+  }
+  next_segment_number_ += pending_count_;
+  for (int i = 0; i < pending_count_; i++) {
+    Status status = ct_destination_->WriteFrom(pending_ct_[i]);
+    if (!status.ok()) {
+      operation.SetStatus(status);
+      return status;
+    }
+  }
+  pending_count_ = 0;
+  return Status::OK;
+}
+
 StatusOr<int> StreamingAeadEncryptingStream::Next(void** data) {
   if (!status_.ok()) return status_;
 
@@ -104,8 +277,7 @@ StatusOr<int> StreamingAeadEncryptingStream::Next(void** data) {
   if (is_first_segment_) {
     is_first_segment_ = false;
     count_backedup_ = 0;
-    status_ =
-        WriteToStream(segment_encrypter_->get_header(), ct_destination_.get());
+    status_ = ct_destination_->WriteFrom(segment_encrypter_->get_header());
     if (!status_.ok()) return status_;
     *data = pt_buffer_.data();
     position_ = pt_buffer_.size();
@@ -122,7 +294,22 @@ StatusOr<int> StreamingAeadEncryptingStream::Next(void** data) {
     return backedup;
   }
 
-  // We're past the first segment, and no space was backed up, so we:
+  // If the segment in pt_buffer_ is not full yet, extend it.
+  int segment_overhead = segment_encrypter_->get_ciphertext_segment_size() -
+                         segment_encrypter_->get_plaintext_segment_size();
+  int size = pt_buffer_.size();
+  if (size < pt_buffer_limit_) {
+    int new_size =
+        std::min(pt_buffer_limit_, std::max(2 * size, kInitialBufferSize));
+    pt_buffer_.reserve(new_size + segment_overhead);
+    pt_buffer_.resize(new_size);
+    *data = pt_buffer_.data() + size;
+    pt_buffer_offset_ = size;
+    position_ += new_size - size;
+    return new_size - size;
+  }
+
+  // The segment is full, and no space was backed up, so we:
   // 1. encrypt pt_to_encrypt_ (if non-empty) as a not-last segment
   //    and attempt to write the ciphertext to ct_destination_.
   // 2. move contents of pt_buffer_ to pt_to_encrypt_ (for later encryption,
@@ -130,23 +317,95 @@ StatusOr<int> StreamingAeadEncryptingStream::Next(void** data) {
   // 3. prepare and return "fresh" pt_buffer_.
   //
   // Step 1.
+  //    Parallel streams instead add pt_to_encrypt_ to the pending batch.
   if (!pt_to_encrypt_.empty()) {
-    status_ = segment_encrypter_->EncryptSegment(
-        pt_to_encrypt_, /* is_last_segment = */ false, &ct_buffer_);
-    if (!status_.ok()) return status_;
-    status_ = WriteToStream(ct_buffer_, ct_destination_.get());
-    if (!status_.ok()) return status_;
+    if (pool_ != nullptr) {
+      status_ = AddPendingSegment();
+      if (!status_.ok()) return status_;
+    } else {
+      status_ = EncryptSegment(&pt_to_encrypt_, /* is_last_segment = */ false);
+      if (!status_.ok()) return status_;
+      status_ = ct_destination_->WriteFrom(pt_to_encrypt_);
+      if (!status_.ok()) return status_;
+    }
   }
   // Step 2.
   pt_buffer_.swap(pt_to_encrypt_);
   // Step 3.
-  pt_buffer_.resize(segment_encrypter_->get_plaintext_segment_size());
+  //    A stream of more than one segment gets full-sized buffers.
+  int ct_segment_size = segment_encrypter_->get_ciphertext_segment_size();
+  if (pt_buffer_.capacity() < static_cast<size_t>(ct_segment_size)) {
+    pt_buffer_ = AcquireBuffer(ct_segment_size);
+  }
+  pt_buffer_limit_ = segment_encrypter_->get_plaintext_segment_size();
+  pt_buffer_.resize(pt_buffer_limit_);
   *data = pt_buffer_.data();
   pt_buffer_offset_ = 0;
   position_ += pt_buffer_.size();
   return pt_buffer_.size();
 }
 
+Status StreamingAeadEncryptingStream::WriteFrom(
+    absl::Span<const uint8_t> data) {
+  int pt_segment_size = segment_encrypter_->get_plaintext_segment_size();
+  while (!data.empty()) {
+    if (pool_ == nullptr && status_.ok() && !is_first_segment_ &&
+        count_backedup_ == 0 &&
+        static_cast<int>(pt_buffer_.size()) == pt_buffer_limit_ &&
+        data.size() > static_cast<size_t>(pt_segment_size)) {
+      status_ = EncryptFullSegments(&data);
+      if (!status_.ok()) return status_;
+      continue;
+    }
+    void* buffer;
+    auto next_result = Next(&buffer);
+    if (!next_result.ok()) return next_result.status();
+    int available = next_result.ValueOrDie();
+    int used = std::min(static_cast<size_t>(available), data.size());
+    memcpy(buffer, data.data(), used);
+    data.remove_prefix(used);
+    BackUp(available - used);
+  }
+  return Status::OK;
+}
+
+Status StreamingAeadEncryptingStream::EncryptFullSegments(
+    absl::Span<const uint8_t>* data) {
+  // More plaintext follows pt_to_encrypt_ and the full pt_buffer_, so neither
+  // is the last segment.
+  Status status;
+  if (!pt_to_encrypt_.empty()) {
+    status = EncryptSegment(&pt_to_encrypt_, /* is_last_segment = */ false);
+    if (!status.ok()) return status;
+    status = ct_destination_->WriteFrom(pt_to_encrypt_);
+    if (!status.ok()) return status;
+  }
+  status = EncryptSegment(&pt_buffer_, /* is_last_segment = */ false);
+  if (!status.ok()) return status;
+  status = ct_destination_->WriteFrom(pt_buffer_);
+  if (!status.ok()) return status;
+  // Then the segments of 'data' that are followed by more of it are
+  // encrypted from 'data' into pt_to_encrypt_.
+  int pt_segment_size = segment_encrypter_->get_plaintext_segment_size();
+  pt_buffer_limit_ = pt_segment_size;
+  pt_to_encrypt_.resize(segment_encrypter_->get_ciphertext_segment_size());
+  while (data->size() > static_cast<size_t>(pt_segment_size)) {
+    status = segment_encrypter_->EncryptSegmentInto(
+        data->subspan(0, pt_segment_size), /* is_last_segment = */ false,
+        absl::MakeSpan(pt_to_encrypt_));
+    if (!status.ok()) return status;
+    status = ct_destination_->WriteFrom(pt_to_encrypt_);
+    if (!status.ok()) return status;
+    data->remove_prefix(pt_segment_size);
+    position_ += pt_segment_size;
+  }
+  // The rest of 'data' goes to pt_buffer_, a new segment, via Next().
+  pt_to_encrypt_.clear();
+  pt_buffer_.clear();
+  pt_buffer_offset_ = 0;
+  return Status::OK;
+}
+
 void StreamingAeadEncryptingStream::BackUp(int count) {
   if (is_first_segment_ || !status_.ok() || count < 1) return;
   int curr_buffer_size = pt_buffer_.size() - pt_buffer_offset_;
@@ -158,10 +417,16 @@ void StreamingAeadEncryptingStream::BackUp(int count) {
 Status StreamingAeadEncryptingStream::Close() {
   if (!status_.ok()) return status_;
   if (is_first_segment_) {  // Next() was never called.
-    status_ =
-        WriteToStream(segment_encrypter_->get_header(), ct_destination_.get());
+    status_ = ct_destination_->WriteFrom(segment_encrypter_->get_header());
     if (!status_.ok()) return status_;
   }
+  if (pool_ != nullptr) {
+    status_ = FlushPendingSegments();
+    if (!status_.ok()) {
+      ct_destination_->Close().IgnoreError();
+      return status_;
+    }
+  }
 
   // The last segment encrypts plaintext from pt_to_encrypt_,
   // unless the current pt_buffer_ has some plaintext bytes.
@@ -173,13 +438,12 @@ Status StreamingAeadEncryptingStream::Close() {
   }
   if (pt_last_segment != &pt_to_encrypt_ && (!pt_to_encrypt_.empty())) {
     // Before writing the last segment we must encrypt pt_to_encrypt_.
-    status_ = segment_encrypter_->EncryptSegment(
-        pt_to_encrypt_, /* is_last_segment = */ false, &ct_buffer_);
+    status_ = EncryptSegment(&pt_to_encrypt_, /* is_last_segment = */ false);
     if (!status_.ok()) {
       ct_destination_->Close().IgnoreError();
       return status_;
     }
-    status_ = WriteToStream(ct_buffer_, ct_destination_.get());
+    status_ = ct_destination_->WriteFrom(pt_to_encrypt_);
     if (!status_.ok()) {
       ct_destination_->Close().IgnoreError();
       return status_;
@@ -187,13 +451,12 @@ Status StreamingAeadEncryptingStream::Close() {
   }
 
   // Encrypt pt_last_segment, write the ciphertext, and close the stream.
-  status_ = segment_encrypter_->EncryptSegment(
-      *pt_last_segment, /* is_last_segment = */ true, &ct_buffer_);
+  status_ = EncryptSegment(pt_last_segment, /* is_last_segment = */ true);
   if (!status_.ok()) {
     ct_destination_->Close().IgnoreError();
     return status_;
   }
-  status_ = WriteToStream(ct_buffer_, ct_destination_.get());
+  status_ = ct_destination_->WriteFrom(*pt_last_segment);
   if (!status_.ok()) {
     ct_destination_->Close().IgnoreError();
     return status_;
@@ -17,10 +17,14 @@
 #ifndef TINK_SUBTLE_STREAMING_AEAD_ENCRYPTING_STREAM_H_
 #define TINK_SUBTLE_STREAMING_AEAD_ENCRYPTING_STREAM_H_
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
+#include "absl/types/span.h"
+#include "tink/executor.h"
 #include "tink/output_stream.h"
+#include "tink/subtle/segment_buffer_pool.h"
 #include "tink/subtle/stream_segment_encrypter.h"
 #include "tink/util/statusor.h"
 
@@ -40,6 +44,65 @@ class StreamingAeadEncryptingStream : public OutputStream {
       New(std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
           std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination);
 
+  // Like New() above, but encrypts up to 'parallelism' segments at a time,
+  // on 'parallelism' - 1 worker threads owned by the stream and on the
+  // calling thread.  The ciphertext is written to 'ciphertext_destination'
+  // in order as usual, and the stream buffers at most a bounded number of
+  // segments (see kMinBatchSize).  For 'parallelism' > 1 the
+  // 'segment_encrypter' must support EncryptSegmentAt().
+  static
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+      New(std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+          std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+          int parallelism);
+
+  // Like New() above, but the buffers of the stream come from
+  // 'buffer_pool', and are returned to it when the stream is destroyed.
+  // If 'buffer_pool' is null, the stream allocates its buffers itself.
+  static
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+      New(std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+          std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+          int parallelism, std::shared_ptr<SegmentBufferPool> buffer_pool);
+
+  // Like New() above, but encrypts the segments on the shared 'executor'
+  // and on the calling thread, as a stream with 'parallelism'
+  // executor->num_threads() + 1 does on threads of its own.  The stream
+  // must not be used from a task running on 'executor'.
+  static
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+      New(std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+          std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+          std::shared_ptr<Executor> executor,
+          std::shared_ptr<SegmentBufferPool> buffer_pool);
+
+  // Like New(segment_encrypter, ciphertext_destination, 1, buffer_pool),
+  // but 'plaintext_size_hint' is the number of bytes that will be written
+  // to the stream, if known, or -1.  A plaintext of at most a segment is
+  // then buffered in a buffer of its size, and encrypted in one pass by
+  // Close().  Writing more or fewer bytes than the hint is allowed.
+  static
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+      NewWithSizeHint(
+          std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+          std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+          int64_t plaintext_size_hint,
+          std::shared_ptr<SegmentBufferPool> buffer_pool);
+
+  // The plaintext buffer of a segment grows on demand, up to the size of
+  // the segment: Next() returns at first at most kInitialBufferSize bytes
+  // (unless the stream has a size hint), and then twice as many bytes as
+  // the segment has so far, so that small streams do not allocate (and
+  // zero) a buffer of the segment size.
+  static constexpr int kInitialBufferSize = 1 << 12;
+
+  // The minimum number of plaintext bytes that a parallel stream collects
+  // per thread before encrypting them, so that small segments are not
+  // dispatched to the worker threads one by one.
+  static constexpr int kMinBatchSize = 1 << 16;
+
+  ~StreamingAeadEncryptingStream() override;
+
   // -----------------------
   // Methods of OutputStream-interface implemented by this class.
   crypto::tink::util::StatusOr<int> Next(void** data) override;
@@ -47,12 +110,55 @@ class StreamingAeadEncryptingStream : public OutputStream {
   crypto::tink::util::Status Close() override;
   int64_t Position() const override;
 
+  // Encrypts full segments directly from 'data', unless the stream is
+  // parallel.
+  crypto::tink::util::Status WriteFrom(
+      absl::Span<const uint8_t> data) override;
+
  private:
-  StreamingAeadEncryptingStream() {}
+  StreamingAeadEncryptingStream();
+
+  // Returns a stream which encrypts up to 'parallelism' segments at a time
+  // on 'executor', which is null if 'parallelism' is 1.
+  // 'plaintext_size_hint' is -1 if unknown.
+  static
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+      Create(std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+             std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+             int parallelism, std::shared_ptr<Executor> executor,
+             std::shared_ptr<SegmentBufferPool> buffer_pool,
+             int64_t plaintext_size_hint);
+
+  // Returns an empty buffer with room for at least 'capacity' bytes.
+  // Buffers of the buffer_pool_ have room for a ciphertext segment, so that
+  // any stream can reuse them.
+  std::vector<uint8_t> AcquireBuffer(int capacity) const;
+
+  // Replaces the plaintext in 'segment' by its ciphertext, encrypting in
+  // place, or via ct_buffer_ using next_segment_number_ if this stream is
+  // parallel.
+  crypto::tink::util::Status EncryptSegment(std::vector<uint8_t>* segment,
+                                            bool is_last_segment);
+
+  // Encrypts and writes pt_to_encrypt_, the full pt_buffer_ and then the
+  // segments of 'data' while more than a segment of it is left, and
+  // removes them from 'data'.  Requires a non-parallel stream past its
+  // first Next() with a full pt_buffer_ and no space backed up.
+  crypto::tink::util::Status EncryptFullSegments(
+      absl::Span<const uint8_t>* data);
+
+  // Adds pt_to_encrypt_ (a not-last segment) to the pending batch, and
+  // encrypts and writes the batch once it is full.
+  crypto::tink::util::Status AddPendingSegment();
+
+  // Encrypts the pending batch and writes the ciphertext to ct_destination_.
+  crypto::tink::util::Status FlushPendingSegments();
+
   std::unique_ptr<StreamSegmentEncrypter> segment_encrypter_;
   std::unique_ptr<crypto::tink::OutputStream> ct_destination_;
+  std::shared_ptr<SegmentBufferPool> buffer_pool_;  // may be null
   std::vector<uint8_t> pt_buffer_;  // plaintext buffer
-  std::vector<uint8_t> ct_buffer_;  // ciphertext buffer
+  std::vector<uint8_t> ct_buffer_;  // ciphertext buffer of parallel streams
   std::vector<uint8_t> pt_to_encrypt_;  // plaintext to be encrypted
   int64_t position_;  // number of plaintext bytes written to this stream
   crypto::tink::util::Status status_;  // status of the stream
@@ -60,6 +166,7 @@ class StreamingAeadEncryptingStream : public OutputStream {
   // Counters that describe the state of the data in pt_buffer_.
   int count_backedup_;    // # bytes in pt_buffer_ that were backed up
   int pt_buffer_offset_;  // offset at which *data starts in pt_buffer_
+  int pt_buffer_limit_;   // size of pt_buffer_ once its segment is full
 
   // Flag that indicates whether the user has obtained a buffer to write
   // the data of the first segment.
@@ -67,6 +174,14 @@ class StreamingAeadEncryptingStream : public OutputStream {
   // header has been written to ct_destination_, nor the user had
   // a chance to write any data to this stream.
   bool is_first_segment_;
+
+  // Used only by parallel streams, otherwise 'pool_' is null.
+  std::shared_ptr<Executor> pool_;
+  int64_t next_segment_number_;
+  // Not-last segments waiting for encryption, and their ciphertexts.
+  std::vector<std::vector<uint8_t>> pending_pt_;
+  std::vector<std::vector<uint8_t>> pending_ct_;
+  int pending_count_;
 };
 
 }  // namespace subtle
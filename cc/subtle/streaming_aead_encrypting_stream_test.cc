@@ -16,17 +16,23 @@
 
 #include "tink/subtle/streaming_aead_encrypting_stream.h"
 
+#include <memory>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/executor.h"
 #include "tink/output_stream.h"
 #include "tink/subtle/stream_segment_encrypter.h"
 #include "tink/subtle/random.h"
+#include "tink/subtle/segment_buffer_pool.h"
 #include "tink/subtle/test_util.h"
+#include "tink/thread_pool_executor.h"
 #include "tink/util/ostream_output_stream.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -50,8 +56,11 @@ struct ValidationRefs {
 
 // A helper for creating StreamingAeadEncryptingStream together
 // with references to internal objects, used for test validation.
+// With 'parallelism' > 1 a parallel stream is created.
 std::unique_ptr<OutputStream> GetEncryptingStream(
-    int pt_segment_size, int header_size, int ct_offset, ValidationRefs* refs) {
+    int pt_segment_size, int header_size, int ct_offset, ValidationRefs* refs,
+    int parallelism = 1,
+    std::shared_ptr<SegmentBufferPool> buffer_pool = nullptr) {
   // Prepare ciphertext destination stream.
   auto ct_stream = absl::make_unique<std::stringstream>();
   // A reference to the ciphertext buffer, for later validation.
@@ -63,7 +72,8 @@ std::unique_ptr<OutputStream> GetEncryptingStream(
   // A reference to the segment encrypter, for later validation.
   refs->seg_enc = seg_enc.get();
   auto enc_stream = std::move(StreamingAeadEncryptingStream::New(
-      std::move(seg_enc), std::move(ct_destination)).ValueOrDie());
+      std::move(seg_enc), std::move(ct_destination), parallelism,
+      std::move(buffer_pool)).ValueOrDie());
   EXPECT_EQ(0, enc_stream->Position());
   return enc_stream;
 }
@@ -562,6 +572,234 @@ TEST_F(StreamingAeadEncryptingStreamTest, BackupAndPosition) {
   EXPECT_EQ(util::error::FAILED_PRECONDITION, close_status.error_code());
 }
 
+TEST_F(StreamingAeadEncryptingStreamTest, ParallelWritingStreams) {
+  std::vector<int> pt_sizes = {0, 10, 1000, 100000, 1000000};
+  std::vector<int> pt_segment_sizes = {64, 1000, 100000};
+  std::vector<int> parallelisms = {1, 2, 3, 8};
+  int header_size = 10;
+  int ct_offset = 5;
+  for (auto pt_size : pt_sizes) {
+    for (auto pt_segment_size : pt_segment_sizes) {
+      for (auto parallelism : parallelisms) {
+        SCOPED_TRACE(absl::StrCat("pt_size = ", pt_size,
+                                  ", pt_segment_size = ", pt_segment_size,
+                                  ", parallelism = ", parallelism));
+        ValidationRefs refs;
+        auto enc_stream = GetEncryptingStream(pt_segment_size, header_size,
+            ct_offset, &refs, parallelism);
+
+        // Write plaintext to the stream, and close the stream.
+        std::string pt = Random::GetRandomBytes(pt_size);
+        auto status = test::WriteToStream(enc_stream.get(), pt);
+        EXPECT_TRUE(status.ok()) << status;
+        EXPECT_EQ(enc_stream->Position(), pt.size());
+        EXPECT_EQ(refs.seg_enc->get_generated_output_size(),
+                  refs.ct_buf->str().size());
+        // The ciphertext is the same as that of a sequential stream.
+        EXPECT_EQ(refs.seg_enc->GenerateCiphertext(pt), refs.ct_buf->str());
+
+        // Try closing the stream again.
+        status = enc_stream->Close();
+        EXPECT_FALSE(status.ok());
+        EXPECT_EQ(util::error::FAILED_PRECONDITION, status.error_code());
+      }
+    }
+  }
+}
+
+TEST_F(StreamingAeadEncryptingStreamTest, PooledBuffers) {
+  auto buffer_pool = std::make_shared<SegmentBufferPool>();
+  int header_size = 10;
+  int ct_offset = 5;
+  // Consecutive streams reuse the buffers of their predecessors, which
+  // must not leak plaintext or ciphertext into the new stream.
+  for (auto pt_segment_size : {1000, 64, 100000, 1000}) {
+    for (auto parallelism : {1, 3}) {
+      SCOPED_TRACE(absl::StrCat("pt_segment_size = ", pt_segment_size,
+                                ", parallelism = ", parallelism));
+      ValidationRefs refs;
+      auto enc_stream = GetEncryptingStream(pt_segment_size, header_size,
+          ct_offset, &refs, parallelism, buffer_pool);
+      std::string pt = Random::GetRandomBytes(300000);
+      auto status = test::WriteToStream(enc_stream.get(), pt);
+      EXPECT_TRUE(status.ok()) << status;
+      EXPECT_EQ(refs.seg_enc->GenerateCiphertext(pt), refs.ct_buf->str());
+    }
+  }
+}
+
+TEST_F(StreamingAeadEncryptingStreamTest, WriteFrom) {
+  int header_size = 10;
+  int ct_offset = 5;
+  for (auto pt_segment_size : {64, 1000}) {
+    for (auto parallelism : {1, 3}) {
+      SCOPED_TRACE(absl::StrCat("pt_segment_size = ", pt_segment_size,
+                                ", parallelism = ", parallelism));
+      ValidationRefs refs;
+      auto enc_stream = GetEncryptingStream(pt_segment_size, header_size,
+          ct_offset, &refs, parallelism);
+      std::string pt = Random::GetRandomBytes(100000);
+      auto pt_data = absl::MakeConstSpan(
+          reinterpret_cast<const uint8_t*>(pt.data()), pt.size());
+      int written = 0;
+      for (int write_size : {0, 10, 5000, 1, 64, 65, 1000, 1001, 20000}) {
+        SCOPED_TRACE(absl::StrCat("write_size = ", write_size));
+        auto status =
+            enc_stream->WriteFrom(pt_data.subspan(written, write_size));
+        EXPECT_TRUE(status.ok()) << status;
+        written += write_size;
+        EXPECT_EQ(written, enc_stream->Position());
+
+        // Next() and BackUp() still work in between.
+        void* buffer;
+        auto next_result = enc_stream->Next(&buffer);
+        EXPECT_TRUE(next_result.ok()) << next_result.status();
+        int next_count = std::min(next_result.ValueOrDie(), 7);
+        memcpy(buffer, pt.data() + written, next_count);
+        enc_stream->BackUp(next_result.ValueOrDie() - next_count);
+        written += next_count;
+        EXPECT_EQ(written, enc_stream->Position());
+      }
+      auto status = enc_stream->WriteFrom(pt_data.subspan(written));
+      EXPECT_TRUE(status.ok()) << status;
+      EXPECT_EQ(pt.size(), enc_stream->Position());
+      status = enc_stream->Close();
+      EXPECT_TRUE(status.ok()) << status;
+      EXPECT_EQ(refs.seg_enc->GenerateCiphertext(pt), refs.ct_buf->str());
+    }
+  }
+}
+
+TEST_F(StreamingAeadEncryptingStreamTest, SharedExecutor) {
+  std::shared_ptr<Executor> executor = NewThreadPoolExecutor(3);
+  int header_size = 10;
+  int ct_offset = 5;
+  // Several streams use the executor at the same time.
+  std::vector<ValidationRefs> refs(3);
+  std::vector<std::unique_ptr<OutputStream>> enc_streams;
+  std::vector<std::string> pts;
+  for (int i = 0; i < refs.size(); i++) {
+    auto ct_stream = absl::make_unique<std::stringstream>();
+    refs[i].ct_buf = ct_stream->rdbuf();
+    auto seg_enc = absl::make_unique<DummyStreamSegmentEncrypter>(
+        /* pt_segment_size = */ 1000, header_size, ct_offset);
+    refs[i].seg_enc = seg_enc.get();
+    auto result = StreamingAeadEncryptingStream::New(
+        std::move(seg_enc),
+        absl::make_unique<OstreamOutputStream>(std::move(ct_stream)),
+        executor, /* buffer_pool = */ nullptr);
+    ASSERT_TRUE(result.ok()) << result.status();
+    enc_streams.push_back(std::move(result.ValueOrDie()));
+    pts.push_back(Random::GetRandomBytes(200000 + i));
+  }
+  for (int i = 0; i < refs.size(); i++) {
+    auto status = test::WriteToStream(enc_streams[i].get(), pts[i]);
+    EXPECT_TRUE(status.ok()) << status;
+    EXPECT_EQ(refs[i].seg_enc->GenerateCiphertext(pts[i]),
+              refs[i].ct_buf->str());
+  }
+
+  auto result = StreamingAeadEncryptingStream::New(
+      absl::make_unique<DummyStreamSegmentEncrypter>(
+          /* pt_segment_size = */ 64, header_size, ct_offset),
+      absl::make_unique<OstreamOutputStream>(
+          absl::make_unique<std::stringstream>()),
+      /* executor = */ nullptr, /* buffer_pool = */ nullptr);
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+}
+
+TEST_F(StreamingAeadEncryptingStreamTest, BufferGrowsOnDemand) {
+  int pt_segment_size = 100000;
+  int header_size = 10;
+  int ct_offset = 5;
+  int first_segment_size = pt_segment_size - header_size - ct_offset;
+  ValidationRefs refs;
+  auto enc_stream = GetEncryptingStream(pt_segment_size, header_size,
+      ct_offset, &refs);
+  std::string pt = Random::GetRandomBytes(3 * pt_segment_size);
+
+  // The first segment is returned in growing buffers, the others at once.
+  std::vector<int> expected_sizes;
+  int size = StreamingAeadEncryptingStream::kInitialBufferSize;
+  expected_sizes.push_back(size);
+  while (size < first_segment_size) {
+    int new_size = std::min(first_segment_size, 2 * size);
+    expected_sizes.push_back(new_size - size);
+    size = new_size;
+  }
+  expected_sizes.push_back(pt_segment_size);
+  int written = 0;
+  for (int expected_size : expected_sizes) {
+    void* buffer;
+    auto next_result = enc_stream->Next(&buffer);
+    ASSERT_TRUE(next_result.ok()) << next_result.status();
+    EXPECT_EQ(expected_size, next_result.ValueOrDie());
+    memcpy(buffer, pt.data() + written, next_result.ValueOrDie());
+    written += next_result.ValueOrDie();
+    EXPECT_EQ(written, enc_stream->Position());
+  }
+  auto status = test::WriteToStream(enc_stream.get(), pt.substr(written));
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(refs.seg_enc->GenerateCiphertext(pt), refs.ct_buf->str());
+}
+
+TEST_F(StreamingAeadEncryptingStreamTest, SizeHint) {
+  int pt_segment_size = 100000;
+  int header_size = 10;
+  int ct_offset = 5;
+  int first_segment_size = pt_segment_size - header_size - ct_offset;
+  for (int pt_size : {0, 1, 200, 10000, first_segment_size, 250000}) {
+    // Hints that are wrong are allowed too.
+    for (int hint : {pt_size, pt_size / 2, 2 * pt_size + 10}) {
+      SCOPED_TRACE(absl::StrCat("pt_size = ", pt_size, ", hint = ", hint));
+      auto ct_stream = absl::make_unique<std::stringstream>();
+      std::stringbuf* ct_buf = ct_stream->rdbuf();
+      auto seg_enc = absl::make_unique<DummyStreamSegmentEncrypter>(
+          pt_segment_size, header_size, ct_offset);
+      DummyStreamSegmentEncrypter* seg_enc_ref = seg_enc.get();
+      auto result = StreamingAeadEncryptingStream::NewWithSizeHint(
+          std::move(seg_enc),
+          absl::make_unique<OstreamOutputStream>(std::move(ct_stream)),
+          hint, /* buffer_pool = */ nullptr);
+      ASSERT_TRUE(result.ok()) << result.status();
+      auto enc_stream = std::move(result.ValueOrDie());
+
+      // The first buffer has the size of the hint.
+      void* buffer;
+      auto next_result = enc_stream->Next(&buffer);
+      ASSERT_TRUE(next_result.ok()) << next_result.status();
+      EXPECT_EQ(std::min(first_segment_size, std::max(hint, 1)),
+                next_result.ValueOrDie());
+      enc_stream->BackUp(next_result.ValueOrDie());
+
+      std::string pt = Random::GetRandomBytes(pt_size);
+      auto status = test::WriteToStream(enc_stream.get(), pt);
+      EXPECT_TRUE(status.ok()) << status;
+      EXPECT_EQ(seg_enc_ref->GenerateCiphertext(pt), ct_buf->str());
+    }
+  }
+
+  auto result = StreamingAeadEncryptingStream::NewWithSizeHint(
+      absl::make_unique<DummyStreamSegmentEncrypter>(
+          pt_segment_size, header_size, ct_offset),
+      absl::make_unique<OstreamOutputStream>(
+          absl::make_unique<std::stringstream>()),
+      /* plaintext_size_hint = */ -2, /* buffer_pool = */ nullptr);
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+}
+
+TEST_F(StreamingAeadEncryptingStreamTest, InvalidParallelism) {
+  auto ct_destination = absl::make_unique<OstreamOutputStream>(
+      absl::make_unique<std::stringstream>());
+  auto result = StreamingAeadEncryptingStream::New(
+      absl::make_unique<DummyStreamSegmentEncrypter>(
+          /* pt_segment_size = */ 64, /* header_size = */ 10,
+          /* ct_offset = */ 0),
+      std::move(ct_destination), /* parallelism = */ 0);
+  EXPECT_FALSE(result.ok());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+}
+
 }  // namespace
 }  // namespace subtle
 }  // namespace tink
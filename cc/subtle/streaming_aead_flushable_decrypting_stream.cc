@@ -0,0 +1,165 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/streaming_aead_flushable_decrypting_stream.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/types/span.h"
+#include "tink/input_stream.h"
+#include "tink/subtle/flushable_segment_format.h"
+#include "tink/subtle/stream_segment_decrypter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+using crypto::tink::InputStream;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace format = flushable_segment_format;
+
+// static
+StatusOr<std::unique_ptr<InputStream>>
+StreamingAeadFlushableDecryptingStream::New(
+    std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+    std::unique_ptr<InputStream> ciphertext_source) {
+  if (segment_decrypter == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "segment_decrypter must be non-null");
+  }
+  if (ciphertext_source == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "cipertext_source must be non-null");
+  }
+  return {absl::WrapUnique(new StreamingAeadFlushableDecryptingStream(
+      std::move(segment_decrypter), std::move(ciphertext_source)))};
+}
+
+Status StreamingAeadFlushableDecryptingStream::ReadExactly(int count,
+                                                          uint8_t* buffer) {
+  auto read_result = ct_source_->ReadInto(absl::MakeSpan(buffer, count));
+  if (!read_result.ok()) return read_result.status();
+  if (read_result.ValueOrDie() < count) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "ciphertext stream is truncated");
+  }
+  return Status::OK;
+}
+
+Status StreamingAeadFlushableDecryptingStream::ReadAndDecryptSegment() {
+  uint8_t frame[1 + format::kLengthSize];
+  Status status = ReadExactly(1, frame);
+  if (!status.ok()) return status;
+  uint8_t kind = frame[0];
+  int full_size = format::FullSegmentSize(
+      segment_number_, segment_decrypter_->get_ciphertext_segment_size(),
+      segment_decrypter_->get_header_size(),
+      segment_decrypter_->get_ciphertext_offset());
+  int segment_overhead = segment_decrypter_->get_ciphertext_segment_size() -
+                         segment_decrypter_->get_plaintext_segment_size();
+  int64_t ct_size = full_size;
+  if (kind == format::kFlushedSegment || kind == format::kLastSegment) {
+    status = ReadExactly(format::kLengthSize, frame + 1);
+    if (!status.ok()) return status;
+    ct_size = format::LoadLength(frame + 1);
+  } else if (kind != format::kFullSegment) {
+    return Status(util::error::INVALID_ARGUMENT, "invalid segment kind");
+  }
+  if (ct_size < segment_overhead || ct_size > full_size) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "invalid ciphertext segment size");
+  }
+  buffer_.resize(ct_size);
+  status = ReadExactly(ct_size, buffer_.data());
+  if (!status.ok()) return status;
+  read_last_segment_ = kind == format::kLastSegment;
+  pt_count_ = ct_size - segment_overhead;
+  status = segment_decrypter_->DecryptSegmentInto(
+      absl::MakeConstSpan(buffer_), segment_number_, read_last_segment_,
+      absl::MakeSpan(buffer_.data(), pt_count_));
+  if (!status.ok()) return status;
+  segment_number_++;
+  if (read_last_segment_) {
+    // No ciphertext may follow the last segment.
+    uint8_t extra;
+    auto read_result = ct_source_->ReadInto(absl::MakeSpan(&extra, 1));
+    if (!read_result.ok()) return read_result.status();
+    if (read_result.ValueOrDie() != 0) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    "ciphertext stream continues after the last segment");
+    }
+  }
+  return Status::OK;
+}
+
+StatusOr<int> StreamingAeadFlushableDecryptingStream::Next(const void** data) {
+  if (!status_.ok()) return status_;
+
+  if (!is_initialized_) {
+    std::vector<uint8_t> header(segment_decrypter_->get_header_size());
+    status_ = ReadExactly(header.size(), header.data());
+    if (!status_.ok()) return status_;
+    status_ = segment_decrypter_->Init(header);
+    if (!status_.ok()) return status_;
+    is_initialized_ = true;
+  }
+
+  // If some bytes were backed up, return them first.
+  if (count_backedup_ > 0) {
+    int backedup = count_backedup_;
+    count_backedup_ = 0;
+    position_ += backedup;
+    *data = buffer_.data() + pt_count_ - backedup;
+    return backedup;
+  }
+
+  // Segments without plaintext (e.g. an empty last one) are skipped.
+  do {
+    if (read_last_segment_) {
+      status_ = Status(util::error::OUT_OF_RANGE, "Reached end of stream.");
+      return status_;
+    }
+    status_ = ReadAndDecryptSegment();
+    if (!status_.ok()) return status_;
+  } while (pt_count_ == 0);
+  *data = buffer_.data();
+  position_ += pt_count_;
+  return pt_count_;
+}
+
+void StreamingAeadFlushableDecryptingStream::BackUp(int count) {
+  if (!status_.ok() || count < 1 || !is_initialized_) return;
+  int actual_count = std::min(count, pt_count_ - count_backedup_);
+  count_backedup_ += actual_count;
+  position_ -= actual_count;
+}
+
+int64_t StreamingAeadFlushableDecryptingStream::Position() const {
+  return position_;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,87 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_STREAMING_AEAD_FLUSHABLE_DECRYPTING_STREAM_H_
+#define TINK_SUBTLE_STREAMING_AEAD_FLUSHABLE_DECRYPTING_STREAM_H_
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "tink/input_stream.h"
+#include "tink/subtle/stream_segment_decrypter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// A decrypting stream for ciphertexts in the flushable format (see
+// flushable_segment_format.h), as written by
+// StreamingAeadFlushableEncryptingStream.  Each segment is returned as soon
+// as it has been read, so that the plaintext of a flushed segment is
+// available before the writer writes the next one.
+class StreamingAeadFlushableDecryptingStream : public InputStream {
+ public:
+  // The returned stream is a wrapper around 'ciphertext_source', such that
+  // any bytes read via the wrapper are AEAD-decrypted by
+  // 'segment_decrypter'.
+  static
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
+      New(std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+          std::unique_ptr<crypto::tink::InputStream> ciphertext_source);
+
+  ~StreamingAeadFlushableDecryptingStream() override {}
+
+  // -----------------------
+  // Methods of InputStream-interface implemented by this class.
+  crypto::tink::util::StatusOr<int> Next(const void** data) override;
+  void BackUp(int count) override;
+  int64_t Position() const override;
+
+ private:
+  StreamingAeadFlushableDecryptingStream(
+      std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+      std::unique_ptr<crypto::tink::InputStream> ciphertext_source)
+      : segment_decrypter_(std::move(segment_decrypter)),
+        ct_source_(std::move(ciphertext_source)) {}
+
+  // Reads exactly 'count' bytes into 'buffer', or fails with
+  // INVALID_ARGUMENT if the stream ends before.
+  crypto::tink::util::Status ReadExactly(int count, uint8_t* buffer);
+
+  // Reads and decrypts the next segment into buffer_.
+  crypto::tink::util::Status ReadAndDecryptSegment();
+
+  std::unique_ptr<StreamSegmentDecrypter> segment_decrypter_;
+  std::unique_ptr<crypto::tink::InputStream> ct_source_;
+  std::vector<uint8_t> buffer_;  // the current segment, decrypted in place
+  int pt_count_ = 0;             // plaintext bytes in buffer_
+  int count_backedup_ = 0;       // bytes of buffer_ that were backed up
+  int64_t position_ = 0;         // plaintext bytes returned so far
+  int64_t segment_number_ = 0;   // number of the next segment
+  bool is_initialized_ = false;
+  bool read_last_segment_ = false;
+  crypto::tink::util::Status status_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_STREAMING_AEAD_FLUSHABLE_DECRYPTING_STREAM_H_
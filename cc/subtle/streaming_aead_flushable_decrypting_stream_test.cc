@@ -0,0 +1,190 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/streaming_aead_flushable_decrypting_stream.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/input_stream.h"
+#include "tink/output_stream.h"
+#include "tink/subtle/flushable_segment_format.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/ostream_output_stream.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+using crypto::tink::subtle::test::DummyStreamingAead;
+using crypto::tink::util::IstreamInputStream;
+using crypto::tink::util::OstreamOutputStream;
+
+namespace {
+
+constexpr int kPtSegmentSize = 100;
+constexpr int kHeaderSize = 10;
+
+// Encrypts 'pt' with a flushable stream of 'saead', flushing after each
+// 'flush_interval' bytes.
+std::string Encrypt(DummyStreamingAead* saead, absl::string_view pt,
+                    int flush_interval) {
+  auto ct_stream = absl::make_unique<std::stringstream>();
+  std::stringbuf* ct_buf = ct_stream->rdbuf();
+  auto enc_stream = std::move(
+      saead->NewFlushableEncryptingStream(
+               absl::make_unique<OstreamOutputStream>(std::move(ct_stream)),
+               "aad")
+          .ValueOrDie());
+  while (!pt.empty()) {
+    int chunk = std::min<int>(flush_interval, pt.size());
+    EXPECT_TRUE(test::WriteToStream(enc_stream.get(), pt.substr(0, chunk),
+                                    /* close_stream = */ false).ok());
+    EXPECT_TRUE(enc_stream->Flush().ok());
+    pt.remove_prefix(chunk);
+  }
+  EXPECT_TRUE(enc_stream->Close().ok());
+  return ct_buf->str();
+}
+
+util::Status Decrypt(DummyStreamingAead* saead, absl::string_view ct,
+                     std::string* pt) {
+  auto dec_stream = std::move(
+      saead->NewFlushableDecryptingStream(
+               absl::make_unique<IstreamInputStream>(
+                   absl::make_unique<std::stringstream>(std::string(ct))),
+               "aad")
+          .ValueOrDie());
+  return test::ReadFromStream(dec_stream.get(), pt);
+}
+
+TEST(StreamingAeadFlushableDecryptingStreamTest, SegmentsAreReturnedAsRead) {
+  DummyStreamingAead saead(kPtSegmentSize, kHeaderSize, /* ct_offset = */ 0);
+  std::string pt = Random::GetRandomBytes(250);
+  std::string ct = Encrypt(&saead, pt, /* flush_interval = */ 30);
+  auto dec_stream = std::move(
+      saead.NewFlushableDecryptingStream(
+               absl::make_unique<IstreamInputStream>(
+                   absl::make_unique<std::stringstream>(ct)),
+               "aad")
+          .ValueOrDie());
+  // Each flushed segment is returned by a Next() of its own.
+  std::string decrypted;
+  const void* data;
+  for (int i = 0; i < 9; i++) {
+    auto next_result = dec_stream->Next(&data);
+    ASSERT_TRUE(next_result.ok()) << next_result.status();
+    EXPECT_EQ(std::min(30, 250 - 30 * i), next_result.ValueOrDie());
+    decrypted.append(static_cast<const char*>(data),
+                     next_result.ValueOrDie());
+    EXPECT_EQ(decrypted.size(), dec_stream->Position());
+  }
+  // BackUp() returns the bytes again.
+  dec_stream->BackUp(5);
+  EXPECT_EQ(245, dec_stream->Position());
+  auto next_result = dec_stream->Next(&data);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  EXPECT_EQ(5, next_result.ValueOrDie());
+  EXPECT_EQ(pt.substr(245), std::string(static_cast<const char*>(data), 5));
+  // The empty last segment ends the stream.
+  EXPECT_EQ(util::error::OUT_OF_RANGE,
+            dec_stream->Next(&data).status().error_code());
+  EXPECT_EQ(250, dec_stream->Position());
+  EXPECT_EQ(pt, decrypted);
+}
+
+TEST(StreamingAeadFlushableDecryptingStreamTest, ModifiedCiphertext) {
+  DummyStreamingAead saead(kPtSegmentSize, kHeaderSize, /* ct_offset = */ 0);
+  std::string pt = Random::GetRandomBytes(250);
+  std::string ct = Encrypt(&saead, pt, /* flush_interval = */ 60);
+  std::string decrypted;
+  ASSERT_TRUE(Decrypt(&saead, ct, &decrypted).ok());
+  EXPECT_EQ(pt, decrypted);
+
+  int frame_size = 1 + flushable_segment_format::kLengthSize;
+  int first_frame = kHeaderSize;
+  int second_frame = first_frame + frame_size + 60 +
+                     test::DummyStreamSegmentEncrypter::kSegmentTagSize;
+
+  // Truncating the stream, anywhere.
+  for (int size : {0, kHeaderSize, first_frame + 3, second_frame,
+                   static_cast<int>(ct.size()) - 1}) {
+    SCOPED_TRACE(absl::StrCat("size = ", size));
+    EXPECT_EQ(util::error::INVALID_ARGUMENT,
+              Decrypt(&saead, ct.substr(0, size), &decrypted).error_code());
+  }
+  // Appending to the stream.
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            Decrypt(&saead, ct + "x", &decrypted).error_code());
+  {
+    // A flushed segment marked as the last one.
+    std::string modified = ct;
+    modified[first_frame] = flushable_segment_format::kLastSegment;
+    EXPECT_FALSE(Decrypt(&saead, modified, &decrypted).ok());
+  }
+  {
+    // An unknown kind of segment.
+    std::string modified = ct;
+    modified[second_frame] = 7;
+    EXPECT_EQ(util::error::INVALID_ARGUMENT,
+              Decrypt(&saead, modified, &decrypted).error_code());
+  }
+  {
+    // Moving the boundary between two segments.
+    std::string modified = ct;
+    modified[first_frame + frame_size - 1] += 1;
+    EXPECT_FALSE(Decrypt(&saead, modified, &decrypted).ok());
+  }
+  {
+    // A length larger than a segment.
+    std::string modified = ct;
+    modified[first_frame + 1] = 1;
+    EXPECT_EQ(util::error::INVALID_ARGUMENT,
+              Decrypt(&saead, modified, &decrypted).error_code());
+  }
+  {
+    // A wrong header.
+    std::string modified = ct;
+    modified[0] = 'x';
+    EXPECT_EQ(util::error::INVALID_ARGUMENT,
+              Decrypt(&saead, modified, &decrypted).error_code());
+  }
+}
+
+TEST(StreamingAeadFlushableDecryptingStreamTest, InvalidArguments) {
+  EXPECT_FALSE(StreamingAeadFlushableDecryptingStream::New(
+      nullptr, absl::make_unique<IstreamInputStream>(
+                   absl::make_unique<std::stringstream>()))
+      .ok());
+  EXPECT_FALSE(StreamingAeadFlushableDecryptingStream::New(
+      absl::make_unique<test::DummyStreamSegmentDecrypter>(100, 10, 0),
+      nullptr)
+      .ok());
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
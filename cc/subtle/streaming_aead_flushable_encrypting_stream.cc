@@ -0,0 +1,180 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/streaming_aead_flushable_encrypting_stream.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/types/span.h"
+#include "tink/output_stream.h"
+#include "tink/subtle/flushable_segment_format.h"
+#include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+using crypto::tink::OutputStream;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace format = flushable_segment_format;
+
+namespace {
+
+// The frame of a segment is stored in buffer_ right before its plaintext.
+constexpr int kMaxFrameSize = 1 + format::kLengthSize;
+
+}  // namespace
+
+// static
+StatusOr<std::unique_ptr<OutputStream>>
+StreamingAeadFlushableEncryptingStream::New(
+    std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+    std::unique_ptr<OutputStream> ciphertext_destination) {
+  if (segment_encrypter == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "segment_encrypter must be non-null");
+  }
+  if (ciphertext_destination == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "cipertext_destination must be non-null");
+  }
+  int first_segment_size = segment_encrypter->get_plaintext_segment_size() -
+                           segment_encrypter->get_ciphertext_offset() -
+                           segment_encrypter->get_header().size();
+  if (first_segment_size <= 0) {
+    return Status(util::error::INTERNAL,
+                  "Size of the first segment must be greater than 0.");
+  }
+  return {absl::WrapUnique(new StreamingAeadFlushableEncryptingStream(
+      std::move(segment_encrypter), std::move(ciphertext_destination)))};
+}
+
+StreamingAeadFlushableEncryptingStream::StreamingAeadFlushableEncryptingStream(
+    std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+    std::unique_ptr<OutputStream> ciphertext_destination)
+    : segment_encrypter_(std::move(segment_encrypter)),
+      ct_destination_(std::move(ciphertext_destination)),
+      segment_size_(0),
+      last_next_size_(0),
+      position_(0),
+      header_written_(false),
+      status_(Status::OK) {
+  segment_limit_ = segment_encrypter_->get_plaintext_segment_size() -
+                   segment_encrypter_->get_ciphertext_offset() -
+                   segment_encrypter_->get_header().size();
+  buffer_.resize(kMaxFrameSize +
+                 segment_encrypter_->get_ciphertext_segment_size());
+}
+
+StreamingAeadFlushableEncryptingStream::
+    ~StreamingAeadFlushableEncryptingStream() {}
+
+Status StreamingAeadFlushableEncryptingStream::WriteHeader() {
+  if (header_written_) return Status::OK;
+  header_written_ = true;
+  return ct_destination_->WriteFrom(segment_encrypter_->get_header());
+}
+
+Status StreamingAeadFlushableEncryptingStream::WriteSegment(uint8_t kind) {
+  int segment_overhead = segment_encrypter_->get_ciphertext_segment_size() -
+                         segment_encrypter_->get_plaintext_segment_size();
+  int ct_size = segment_size_ + segment_overhead;
+  uint8_t* plaintext = buffer_.data() + kMaxFrameSize;
+  Status status = segment_encrypter_->EncryptSegmentInto(
+      absl::MakeConstSpan(plaintext, segment_size_),
+      /* is_last_segment = */ kind == format::kLastSegment,
+      absl::MakeSpan(plaintext, ct_size));
+  if (!status.ok()) return status;
+  int frame_size = format::FrameSize(kind);
+  uint8_t* frame = plaintext - frame_size;
+  frame[0] = kind;
+  if (kind != format::kFullSegment) format::StoreLength(ct_size, frame + 1);
+  status = ct_destination_->WriteFrom(
+      absl::MakeConstSpan(frame, frame_size + ct_size));
+  if (!status.ok()) return status;
+  segment_limit_ = segment_encrypter_->get_plaintext_segment_size();
+  segment_size_ = 0;
+  last_next_size_ = 0;
+  return Status::OK;
+}
+
+StatusOr<int> StreamingAeadFlushableEncryptingStream::Next(void** data) {
+  if (!status_.ok()) return status_;
+  status_ = WriteHeader();
+  if (!status_.ok()) return status_;
+  // A full segment is written once more plaintext follows it, so that it
+  // can be the last one otherwise.
+  if (segment_size_ == segment_limit_) {
+    status_ = WriteSegment(format::kFullSegment);
+    if (!status_.ok()) return status_;
+  }
+  *data = buffer_.data() + kMaxFrameSize + segment_size_;
+  last_next_size_ = segment_limit_ - segment_size_;
+  segment_size_ = segment_limit_;
+  position_ += last_next_size_;
+  return last_next_size_;
+}
+
+void StreamingAeadFlushableEncryptingStream::BackUp(int count) {
+  if (!status_.ok() || count < 1) return;
+  int actual_count = std::min(count, last_next_size_);
+  last_next_size_ -= actual_count;
+  segment_size_ -= actual_count;
+  position_ -= actual_count;
+}
+
+Status StreamingAeadFlushableEncryptingStream::Flush() {
+  if (!status_.ok()) return status_;
+  status_ = WriteHeader();
+  if (!status_.ok()) return status_;
+  if (segment_size_ > 0) {
+    status_ = WriteSegment(format::kFlushedSegment);
+    if (!status_.ok()) return status_;
+  }
+  Status status = ct_destination_->Flush();
+  if (status.error_code() == util::error::UNIMPLEMENTED) return Status::OK;
+  status_ = status;
+  return status_;
+}
+
+Status StreamingAeadFlushableEncryptingStream::Close() {
+  if (!status_.ok()) return status_;
+  status_ = WriteHeader();
+  if (status_.ok()) status_ = WriteSegment(format::kLastSegment);
+  if (!status_.ok()) {
+    ct_destination_->Close().IgnoreError();
+    return status_;
+  }
+  status_ = Status(util::error::FAILED_PRECONDITION, "Stream closed");
+  return ct_destination_->Close();
+}
+
+int64_t StreamingAeadFlushableEncryptingStream::Position() const {
+  return position_;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,93 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_STREAMING_AEAD_FLUSHABLE_ENCRYPTING_STREAM_H_
+#define TINK_SUBTLE_STREAMING_AEAD_FLUSHABLE_ENCRYPTING_STREAM_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tink/output_stream.h"
+#include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// An encrypting stream whose Flush() writes the plaintext written so far
+// through to the destination, instead of holding it until a segment is
+// full.  Flush() ends the current segment early, so the ciphertext is in
+// the flushable format (see flushable_segment_format.h), which only the
+// flushable decrypting streams read.  Each Flush() that follows new
+// plaintext costs a segment overhead and a 5-byte frame, so that
+// interactive protocols should flush per message, not per write.
+class StreamingAeadFlushableEncryptingStream : public OutputStream {
+ public:
+  // The returned stream is a wrapper around 'ciphertext_destination',
+  // such that any bytes written via the wrapper are AEAD-encrypted
+  // by 'segment_encrypter'.
+  static
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::OutputStream>>
+      New(std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+          std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination);
+
+  ~StreamingAeadFlushableEncryptingStream() override;
+
+  // -----------------------
+  // Methods of OutputStream-interface implemented by this class.
+  crypto::tink::util::StatusOr<int> Next(void** data) override;
+  void BackUp(int count) override;
+  crypto::tink::util::Status Close() override;
+  int64_t Position() const override;
+
+  // Encrypts the plaintext of the current segment, if any, as a flushed
+  // segment, writes it, and then flushes 'ciphertext_destination' unless
+  // it does not support Flush().  The next segment starts empty.
+  crypto::tink::util::Status Flush() override;
+
+ private:
+  StreamingAeadFlushableEncryptingStream(
+      std::unique_ptr<StreamSegmentEncrypter> segment_encrypter,
+      std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination);
+
+  // Writes the header, if it was not written yet.
+  crypto::tink::util::Status WriteHeader();
+
+  // Encrypts the plaintext of the current segment, writes it framed as a
+  // segment of 'kind', and starts the next segment.
+  crypto::tink::util::Status WriteSegment(uint8_t kind);
+
+  std::unique_ptr<StreamSegmentEncrypter> segment_encrypter_;
+  std::unique_ptr<crypto::tink::OutputStream> ct_destination_;
+  // The frame and the plaintext of the current segment, which is encrypted
+  // in place.
+  std::vector<uint8_t> buffer_;
+  int segment_limit_;      // plaintext capacity of the current segment
+  int segment_size_;       // plaintext bytes in the current segment
+  int last_next_size_;     // bytes of the last Next() not backed up
+  int64_t position_;       // number of plaintext bytes written
+  bool header_written_;
+  crypto::tink::util::Status status_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_STREAMING_AEAD_FLUSHABLE_ENCRYPTING_STREAM_H_
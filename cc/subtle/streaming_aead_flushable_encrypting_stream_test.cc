@@ -0,0 +1,286 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/streaming_aead_flushable_encrypting_stream.h"
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/input_stream.h"
+#include "tink/output_stream.h"
+#include "tink/subtle/flushable_segment_format.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/streaming_aead_flushable_decrypting_stream.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/ostream_output_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+using crypto::tink::subtle::test::DummyStreamSegmentDecrypter;
+using crypto::tink::subtle::test::DummyStreamSegmentEncrypter;
+using crypto::tink::util::IstreamInputStream;
+using crypto::tink::util::OstreamOutputStream;
+
+namespace {
+
+// An OutputStream that appends to a string, and records the size of the
+// string at the last Flush().
+class FlushCountingOutputStream : public OutputStream {
+ public:
+  explicit FlushCountingOutputStream(std::string* output) : output_(output) {}
+  util::StatusOr<int> Next(void** data) override {
+    Commit();
+    buffer_.assign(kBufferSize, 0);
+    *data = buffer_.data();
+    backedup_ = 0;
+    return kBufferSize;
+  }
+  void BackUp(int count) override {
+    backedup_ += std::max(0, std::min(count, kBufferSize - backedup_));
+  }
+  util::Status WriteFrom(absl::Span<const uint8_t> data) override {
+    Commit();
+    output_->append(reinterpret_cast<const char*>(data.data()), data.size());
+    return util::Status::OK;
+  }
+  util::Status Close() override {
+    Commit();
+    return util::Status::OK;
+  }
+  int64_t Position() const override {
+    return output_->size() + buffer_.size() - backedup_;
+  }
+  util::Status Flush() override {
+    Commit();
+    flushed_size_ = output_->size();
+    return util::Status::OK;
+  }
+  int64_t flushed_size() const { return flushed_size_; }
+
+ private:
+  static constexpr int kBufferSize = 16;
+
+  void Commit() {
+    output_->append(reinterpret_cast<const char*>(buffer_.data()),
+                    buffer_.size() - backedup_);
+    buffer_.clear();
+    backedup_ = 0;
+  }
+
+  std::string* output_;
+  std::vector<uint8_t> buffer_;
+  int backedup_ = 0;
+  int64_t flushed_size_ = -1;
+};
+
+std::unique_ptr<OutputStream> GetEncryptingStream(
+    int pt_segment_size, int header_size, int ct_offset,
+    std::unique_ptr<OutputStream> ct_destination) {
+  auto enc_stream_result = StreamingAeadFlushableEncryptingStream::New(
+      absl::make_unique<DummyStreamSegmentEncrypter>(
+          pt_segment_size, header_size, ct_offset),
+      std::move(ct_destination));
+  EXPECT_TRUE(enc_stream_result.ok()) << enc_stream_result.status();
+  return std::move(enc_stream_result.ValueOrDie());
+}
+
+// Decrypts 'ciphertext', and returns the status of the decryption.
+util::Status Decrypt(int pt_segment_size, int header_size, int ct_offset,
+                     absl::string_view ciphertext, std::string* plaintext) {
+  auto dec_stream = std::move(StreamingAeadFlushableDecryptingStream::New(
+      absl::make_unique<DummyStreamSegmentDecrypter>(
+          pt_segment_size, header_size, ct_offset),
+      absl::make_unique<IstreamInputStream>(
+          absl::make_unique<std::stringstream>(std::string(ciphertext))))
+      .ValueOrDie());
+  return test::ReadFromStream(dec_stream.get(), plaintext);
+}
+
+TEST(StreamingAeadFlushableEncryptingStreamTest, RoundTrip) {
+  for (int pt_size : {0, 1, 10, 100, 1000, 10000}) {
+    for (int pt_segment_size : {64, 100, 1024}) {
+      for (int header_size : {5, 32}) {
+        for (int ct_offset : {0, 5}) {
+          for (int flush_interval : {0, 1, 7, 100, 3000}) {
+            SCOPED_TRACE(absl::StrCat(
+                "pt_size = ", pt_size, ", pt_segment_size = ", pt_segment_size,
+                ", header_size = ", header_size, ", ct_offset = ", ct_offset,
+                ", flush_interval = ", flush_interval));
+            std::string ct;
+            auto enc_stream = GetEncryptingStream(
+                pt_segment_size, header_size, ct_offset,
+                absl::make_unique<FlushCountingOutputStream>(&ct));
+            std::string pt = Random::GetRandomBytes(pt_size);
+            int written = 0;
+            while (written < pt_size) {
+              int chunk = flush_interval > 0 ? flush_interval : pt_size;
+              chunk = std::min(chunk, pt_size - written);
+              auto status = enc_stream->WriteFrom(absl::MakeConstSpan(
+                  reinterpret_cast<const uint8_t*>(pt.data()) + written,
+                  chunk));
+              ASSERT_TRUE(status.ok()) << status;
+              written += chunk;
+              EXPECT_EQ(written, enc_stream->Position());
+              if (flush_interval > 0) {
+                status = enc_stream->Flush();
+                ASSERT_TRUE(status.ok()) << status;
+              }
+            }
+            auto status = enc_stream->Close();
+            ASSERT_TRUE(status.ok()) << status;
+            std::string decrypted;
+            status = Decrypt(pt_segment_size, header_size, ct_offset, ct,
+                             &decrypted);
+            EXPECT_TRUE(status.ok()) << status;
+            EXPECT_EQ(pt, decrypted);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(StreamingAeadFlushableEncryptingStreamTest, FlushWritesThrough) {
+  int pt_segment_size = 100;
+  int header_size = 10;
+  std::string ct;
+  auto destination = absl::make_unique<FlushCountingOutputStream>(&ct);
+  FlushCountingOutputStream* counting_destination = destination.get();
+  auto enc_stream =
+      GetEncryptingStream(pt_segment_size, header_size, /* ct_offset = */ 0,
+                          std::move(destination));
+
+  // Flushing an empty stream writes the header only.
+  auto status = enc_stream->Flush();
+  ASSERT_TRUE(status.ok()) << status;
+  EXPECT_EQ(header_size, ct.size());
+  EXPECT_EQ(header_size, counting_destination->flushed_size());
+
+  // A flush ends the current segment, and is passed on to the destination.
+  std::string pt = Random::GetRandomBytes(30);
+  ASSERT_TRUE(test::WriteToStream(enc_stream.get(), pt.substr(0, 20),
+                                  /* close_stream = */ false).ok());
+  EXPECT_EQ(header_size, ct.size());
+  status = enc_stream->Flush();
+  ASSERT_TRUE(status.ok()) << status;
+  int flushed_segment_size = 1 + flushable_segment_format::kLengthSize + 20 +
+                             DummyStreamSegmentEncrypter::kSegmentTagSize;
+  EXPECT_EQ(header_size + flushed_segment_size, ct.size());
+  EXPECT_EQ(ct.size(), counting_destination->flushed_size());
+  EXPECT_EQ(flushable_segment_format::kFlushedSegment,
+            static_cast<uint8_t>(ct[header_size]));
+
+  // The plaintext written so far can be decrypted from the flushed prefix:
+  // the stream then ends without its last segment.
+  {
+    auto dec_stream = std::move(StreamingAeadFlushableDecryptingStream::New(
+        absl::make_unique<DummyStreamSegmentDecrypter>(pt_segment_size,
+                                                       header_size, 0),
+        absl::make_unique<IstreamInputStream>(
+            absl::make_unique<std::stringstream>(ct))).ValueOrDie());
+    const void* data;
+    auto next_result = dec_stream->Next(&data);
+    ASSERT_TRUE(next_result.ok()) << next_result.status();
+    EXPECT_EQ(pt.substr(0, 20),
+              std::string(static_cast<const char*>(data),
+                          next_result.ValueOrDie()));
+    EXPECT_EQ(util::error::INVALID_ARGUMENT,
+              dec_stream->Next(&data).status().error_code());
+  }
+
+  // A second flush without new plaintext writes nothing.
+  status = enc_stream->Flush();
+  ASSERT_TRUE(status.ok()) << status;
+  EXPECT_EQ(header_size + flushed_segment_size, ct.size());
+
+  ASSERT_TRUE(test::WriteToStream(enc_stream.get(), pt.substr(20)).ok());
+  EXPECT_EQ(flushable_segment_format::kLastSegment,
+            static_cast<uint8_t>(ct[header_size + flushed_segment_size]));
+  std::string decrypted;
+  status = Decrypt(pt_segment_size, header_size, 0, ct, &decrypted);
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(pt, decrypted);
+  EXPECT_FALSE(enc_stream->Flush().ok());
+}
+
+TEST(StreamingAeadFlushableEncryptingStreamTest, FlushOfOstream) {
+  // OstreamOutputStream supports Flush(), so the flushed ciphertext is in
+  // the ostream right away, despite the buffer of the OstreamOutputStream.
+  auto ct_stream = absl::make_unique<std::stringstream>();
+  std::stringbuf* ct_buf = ct_stream->rdbuf();
+  auto enc_stream = GetEncryptingStream(
+      /* pt_segment_size = */ 1000, /* header_size = */ 10,
+      /* ct_offset = */ 0,
+      absl::make_unique<OstreamOutputStream>(std::move(ct_stream)));
+  ASSERT_TRUE(test::WriteToStream(enc_stream.get(), "hello",
+                                  /* close_stream = */ false).ok());
+  EXPECT_EQ(0, ct_buf->str().size());
+  auto status = enc_stream->Flush();
+  ASSERT_TRUE(status.ok()) << status;
+  EXPECT_EQ(10 + 1 + flushable_segment_format::kLengthSize + 5 +
+                DummyStreamSegmentEncrypter::kSegmentTagSize,
+            ct_buf->str().size());
+}
+
+TEST(StreamingAeadFlushableEncryptingStreamTest, FullSegmentsAreNotFramed) {
+  int pt_segment_size = 64;
+  int header_size = 10;
+  std::string ct;
+  auto enc_stream =
+      GetEncryptingStream(pt_segment_size, header_size, /* ct_offset = */ 0,
+                          absl::make_unique<FlushCountingOutputStream>(&ct));
+  // The first segment holds 54 bytes, the following ones 64 bytes.
+  std::string pt = Random::GetRandomBytes(54 + 64 + 1);
+  ASSERT_TRUE(test::WriteToStream(enc_stream.get(), pt).ok());
+  int tag_size = DummyStreamSegmentEncrypter::kSegmentTagSize;
+  EXPECT_EQ(header_size + (1 + 54 + tag_size) + (1 + 64 + tag_size) +
+                (1 + flushable_segment_format::kLengthSize + 1 + tag_size),
+            ct.size());
+  EXPECT_EQ(flushable_segment_format::kFullSegment,
+            static_cast<uint8_t>(ct[header_size]));
+}
+
+TEST(StreamingAeadFlushableEncryptingStreamTest, InvalidArguments) {
+  EXPECT_FALSE(StreamingAeadFlushableEncryptingStream::New(
+      nullptr, absl::make_unique<FlushCountingOutputStream>(nullptr)).ok());
+  EXPECT_FALSE(StreamingAeadFlushableEncryptingStream::New(
+      absl::make_unique<DummyStreamSegmentEncrypter>(100, 10, 0), nullptr)
+      .ok());
+  // The first segment must hold some plaintext.
+  std::string ct;
+  EXPECT_FALSE(StreamingAeadFlushableEncryptingStream::New(
+      absl::make_unique<DummyStreamSegmentEncrypter>(100, 60, 40),
+      absl::make_unique<FlushCountingOutputStream>(&ct)).ok());
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,144 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/streaming_aead_random_access_encrypter.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/types/span.h"
+#include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// static
+StatusOr<std::unique_ptr<StreamingAeadRandomAccessEncrypter>>
+StreamingAeadRandomAccessEncrypter::New(
+    std::unique_ptr<StreamSegmentEncrypter> segment_encrypter) {
+  if (segment_encrypter == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "segment_encrypter must be non-null");
+  }
+  int first_segment_size = segment_encrypter->get_plaintext_segment_size() -
+                           segment_encrypter->get_ciphertext_offset() -
+                           segment_encrypter->get_header().size();
+  if (first_segment_size <= 0) {
+    return Status(util::error::INTERNAL,
+                  "Size of the first segment must be greater than 0.");
+  }
+  return {absl::WrapUnique(
+      new StreamingAeadRandomAccessEncrypter(std::move(segment_encrypter)))};
+}
+
+StreamingAeadRandomAccessEncrypter::StreamingAeadRandomAccessEncrypter(
+    std::unique_ptr<StreamSegmentEncrypter> segment_encrypter)
+    : segment_encrypter_(std::move(segment_encrypter)),
+      first_segment_size_(segment_encrypter_->get_plaintext_segment_size() -
+                          segment_encrypter_->get_ciphertext_offset() -
+                          segment_encrypter_->get_header().size()),
+      pt_segment_size_(segment_encrypter_->get_plaintext_segment_size()),
+      ct_segment_size_(segment_encrypter_->get_ciphertext_segment_size()) {}
+
+int StreamingAeadRandomAccessEncrypter::plaintext_segment_size(
+    int64_t segment_number) const {
+  return segment_number == 0 ? first_segment_size_ : pt_segment_size_;
+}
+
+int64_t StreamingAeadRandomAccessEncrypter::plaintext_position(
+    int64_t segment_number) const {
+  if (segment_number == 0) return 0;
+  return first_segment_size_ + (segment_number - 1) * pt_segment_size_;
+}
+
+int64_t StreamingAeadRandomAccessEncrypter::ciphertext_position(
+    int64_t segment_number) const {
+  if (segment_number == 0) {
+    return segment_encrypter_->get_ciphertext_offset() + header().size();
+  }
+  return segment_number * ct_segment_size_;
+}
+
+Status StreamingAeadRandomAccessEncrypter::EncryptSegmentAt(
+    int64_t segment_number, absl::Span<const uint8_t> plaintext,
+    bool is_last_segment, std::vector<uint8_t>* ciphertext_buffer) const {
+  if (ciphertext_buffer == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "ciphertext_buffer must be non-null");
+  }
+  if (segment_number < 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "segment_number must be non-negative");
+  }
+  size_t segment_size = plaintext_segment_size(segment_number);
+  if (plaintext.size() > segment_size ||
+      (!is_last_segment && plaintext.size() != segment_size)) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "plaintext has the wrong size for the segment");
+  }
+  if (is_last_segment && plaintext.empty() && segment_number != 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "the last segment must not be empty");
+  }
+  return segment_encrypter_->EncryptSegmentAt(
+      segment_number, std::vector<uint8_t>(plaintext.begin(), plaintext.end()),
+      is_last_segment, ciphertext_buffer);
+}
+
+Status StreamingAeadRandomAccessEncrypter::EncryptPart(
+    int64_t first_segment_number, absl::Span<const uint8_t> plaintext,
+    bool is_last_part, std::vector<uint8_t>* ciphertext_buffer) const {
+  if (ciphertext_buffer == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "ciphertext_buffer must be non-null");
+  }
+  ciphertext_buffer->clear();
+  if (first_segment_number == 0) {
+    ciphertext_buffer->assign(header().begin(), header().end());
+  }
+  int64_t segment_number = first_segment_number;
+  std::vector<uint8_t> ct_segment;
+  do {
+    size_t segment_size = plaintext_segment_size(segment_number);
+    bool is_last_segment = is_last_part && plaintext.size() <= segment_size;
+    if (!is_last_segment && plaintext.size() < segment_size) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    "plaintext must end at a segment boundary");
+    }
+    size_t count = std::min(segment_size, plaintext.size());
+    Status status =
+        EncryptSegmentAt(segment_number, plaintext.subspan(0, count),
+                         is_last_segment, &ct_segment);
+    if (!status.ok()) return status;
+    ciphertext_buffer->insert(ciphertext_buffer->end(), ct_segment.begin(),
+                              ct_segment.end());
+    plaintext.remove_prefix(count);
+    segment_number++;
+  } while (!plaintext.empty());
+  return util::OkStatus();
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,108 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_STREAMING_AEAD_RANDOM_ACCESS_ENCRYPTER_H_
+#define TINK_SUBTLE_STREAMING_AEAD_RANDOM_ACCESS_ENCRYPTER_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "tink/subtle/stream_segment_encrypter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// Encrypts the segments of one ciphertext stream in any order, so that
+// the parts of a large plaintext can be encrypted independently (e.g. by
+// several threads or machines) and the resulting ciphertexts concatenated.
+// The concatenation is the same as the ciphertext of an encrypting stream
+// with the same header, and is decrypted by the usual decrypting streams.
+//
+// Typical use: one party creates the encrypter, and hands its header() to
+// the others, which create encrypters for the same stream from the header
+// (see NonceBasedStreamingAead::NewRandomAccessEncrypterForHeader()).
+// The plaintext is split at segment boundaries (see plaintext_position()),
+// each party encrypts its part with EncryptPart(), and the parts are
+// concatenated in order, the first one starting with the header.
+//
+// WARNING: every segment number of a stream must be encrypted only once,
+// and exactly one segment must be encrypted as the last one.  Encrypting
+// different plaintexts as the same segment reuses the nonce of the
+// segment, which breaks the confidentiality and the integrity of the
+// stream.  It is up to the caller to assign disjoint segments to parties.
+//
+// All methods are thread-safe.
+class StreamingAeadRandomAccessEncrypter {
+ public:
+  // Returns an encrypter for the stream of 'segment_encrypter', which must
+  // support EncryptSegmentAt().
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<StreamingAeadRandomAccessEncrypter>>
+  New(std::unique_ptr<StreamSegmentEncrypter> segment_encrypter);
+
+  // Returns the header of the ciphertext stream.
+  const std::vector<uint8_t>& header() const {
+    return segment_encrypter_->get_header();
+  }
+
+  // Returns the size of the plaintext of segment 'segment_number', unless
+  // it is the last one, which may be shorter (but not empty, unless the
+  // whole plaintext is empty).
+  int plaintext_segment_size(int64_t segment_number) const;
+
+  // Returns the position of segment 'segment_number' within the plaintext,
+  // and within the ciphertext (counting the ciphertext offset and the
+  // header).
+  int64_t plaintext_position(int64_t segment_number) const;
+  int64_t ciphertext_position(int64_t segment_number) const;
+
+  // Encrypts 'plaintext' as the segment 'segment_number', and writes the
+  // result to 'ciphertext_buffer', adjusting its size as needed.  Unless
+  // 'is_last_segment' is true, 'plaintext' must have exactly
+  // plaintext_segment_size(segment_number) bytes.
+  crypto::tink::util::Status EncryptSegmentAt(
+      int64_t segment_number, absl::Span<const uint8_t> plaintext,
+      bool is_last_segment, std::vector<uint8_t>* ciphertext_buffer) const;
+
+  // Encrypts 'plaintext' as the consecutive segments starting with
+  // 'first_segment_number', and writes the concatenated ciphertext
+  // segments to 'ciphertext_buffer', preceded by the header if
+  // 'first_segment_number' is 0.  Unless 'is_last_part' is true,
+  // 'plaintext' must end at a segment boundary.
+  crypto::tink::util::Status EncryptPart(
+      int64_t first_segment_number, absl::Span<const uint8_t> plaintext,
+      bool is_last_part, std::vector<uint8_t>* ciphertext_buffer) const;
+
+ private:
+  explicit StreamingAeadRandomAccessEncrypter(
+      std::unique_ptr<StreamSegmentEncrypter> segment_encrypter);
+
+  const std::unique_ptr<StreamSegmentEncrypter> segment_encrypter_;
+  const int first_segment_size_;  // plaintext size of segment 0
+  const int pt_segment_size_;
+  const int ct_segment_size_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_STREAMING_AEAD_RANDOM_ACCESS_ENCRYPTER_H_
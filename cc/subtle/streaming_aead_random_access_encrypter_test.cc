@@ -0,0 +1,223 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/streaming_aead_random_access_encrypter.h"
+
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using crypto::tink::subtle::test::DummyStreamingAead;
+using crypto::tink::subtle::test::DummyStreamSegmentEncrypter;
+
+absl::Span<const uint8_t> AsSpan(absl::string_view s) {
+  return absl::MakeConstSpan(reinterpret_cast<const uint8_t*>(s.data()),
+                             s.size());
+}
+
+std::unique_ptr<StreamingAeadRandomAccessEncrypter> GetEncrypter(
+    int pt_segment_size, int header_size, int ct_offset) {
+  auto seg_enc = absl::make_unique<DummyStreamSegmentEncrypter>(
+      pt_segment_size, header_size, ct_offset);
+  return std::move(
+      StreamingAeadRandomAccessEncrypter::New(std::move(seg_enc))
+          .ValueOrDie());
+}
+
+TEST(StreamingAeadRandomAccessEncrypterTest, Positions) {
+  int pt_segment_size = 100;
+  int header_size = 20;
+  int ct_offset = 10;
+  int ct_segment_size =
+      pt_segment_size + DummyStreamSegmentEncrypter::kSegmentTagSize;
+  auto encrypter = GetEncrypter(pt_segment_size, header_size, ct_offset);
+  EXPECT_EQ(header_size, encrypter->header().size());
+  EXPECT_EQ(70, encrypter->plaintext_segment_size(0));
+  EXPECT_EQ(100, encrypter->plaintext_segment_size(1));
+  EXPECT_EQ(100, encrypter->plaintext_segment_size(7));
+  EXPECT_EQ(0, encrypter->plaintext_position(0));
+  EXPECT_EQ(70, encrypter->plaintext_position(1));
+  EXPECT_EQ(270, encrypter->plaintext_position(3));
+  EXPECT_EQ(30, encrypter->ciphertext_position(0));
+  EXPECT_EQ(ct_segment_size, encrypter->ciphertext_position(1));
+  EXPECT_EQ(3 * ct_segment_size, encrypter->ciphertext_position(3));
+}
+
+TEST(StreamingAeadRandomAccessEncrypterTest, EncryptingSegments) {
+  int pt_segment_size = 100;
+  int header_size = 20;
+  int ct_offset = 10;
+  auto encrypter = GetEncrypter(pt_segment_size, header_size, ct_offset);
+  DummyStreamSegmentEncrypter expected_encrypter(pt_segment_size, header_size,
+                                                 ct_offset);
+  std::string pt = Random::GetRandomBytes(320);
+  std::string expected_ct = expected_encrypter.GenerateCiphertext(pt);
+
+  // Encrypt the segments backwards, and put them where they belong.
+  std::string ct(expected_ct.size(), '\0');
+  ct.replace(0, header_size,
+             std::string(encrypter->header().begin(),
+                         encrypter->header().end()));
+  std::vector<uint8_t> ct_segment;
+  for (int64_t segment_nr = 3; segment_nr >= 0; segment_nr--) {
+    int64_t pt_position = encrypter->plaintext_position(segment_nr);
+    std::string pt_segment =
+        pt.substr(pt_position, encrypter->plaintext_segment_size(segment_nr));
+    auto status = encrypter->EncryptSegmentAt(
+        segment_nr, AsSpan(pt_segment), segment_nr == 3, &ct_segment);
+    EXPECT_TRUE(status.ok()) << status;
+    ct.replace(encrypter->ciphertext_position(segment_nr) - ct_offset,
+               ct_segment.size(),
+               std::string(ct_segment.begin(), ct_segment.end()));
+  }
+  EXPECT_EQ(expected_ct, ct);
+}
+
+TEST(StreamingAeadRandomAccessEncrypterTest, EncryptingPartsConcurrently) {
+  for (int pt_segment_size : {1, 10, 123, 1000}) {
+    for (int ct_offset : {0, 5, 30}) {
+      for (int pt_size : {0, 1, 10, 999, 5000, 123456}) {
+        int header_size = 30;
+        if (pt_segment_size <= ct_offset + header_size) continue;
+        SCOPED_TRACE(absl::StrCat("pt_segment_size = ", pt_segment_size,
+                                  ", ct_offset = ", ct_offset,
+                                  ", pt_size = ", pt_size));
+        DummyStreamingAead saead(pt_segment_size, header_size, ct_offset);
+        auto first_result = saead.NewRandomAccessEncrypter("aad");
+        ASSERT_TRUE(first_result.ok()) << first_result.status();
+        auto first = std::move(first_result.ValueOrDie());
+        std::string header(first->header().begin(), first->header().end());
+        std::string pt = Random::GetRandomBytes(pt_size);
+
+        // Split the plaintext into parts of one to ten segments.
+        std::vector<int64_t> first_segments = {0};
+        int64_t segment_nr = 0;
+        while (true) {
+          segment_nr += 1 + Random::GetRandomUInt32() % 10;
+          if (first->plaintext_position(segment_nr) >= pt_size) break;
+          first_segments.push_back(segment_nr);
+        }
+
+        // Encrypt each part on its own thread, with its own encrypter.
+        int part_count = first_segments.size();
+        std::vector<std::vector<uint8_t>> ct_parts(part_count);
+        std::vector<util::Status> statuses(part_count);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < part_count; i++) {
+          threads.emplace_back([&, i]() {
+            auto result =
+                saead.NewRandomAccessEncrypterForHeader(header, "aad");
+            if (!result.ok()) {
+              statuses[i] = result.status();
+              return;
+            }
+            auto encrypter = std::move(result.ValueOrDie());
+            bool is_last_part = i == part_count - 1;
+            int64_t begin = encrypter->plaintext_position(first_segments[i]);
+            int64_t end = is_last_part ? pt_size
+                : encrypter->plaintext_position(first_segments[i + 1]);
+            statuses[i] = encrypter->EncryptPart(
+                first_segments[i],
+                AsSpan(absl::string_view(pt).substr(begin, end - begin)),
+                is_last_part, &ct_parts[i]);
+          });
+        }
+        std::string ct;
+        for (int i = 0; i < part_count; i++) {
+          threads[i].join();
+          EXPECT_TRUE(statuses[i].ok()) << statuses[i];
+          ct.append(ct_parts[i].begin(), ct_parts[i].end());
+        }
+        DummyStreamSegmentEncrypter expected_encrypter(
+            pt_segment_size, header_size, ct_offset);
+        EXPECT_EQ(expected_encrypter.GenerateCiphertext(pt), ct);
+      }
+    }
+  }
+}
+
+TEST(StreamingAeadRandomAccessEncrypterTest, InvalidArguments) {
+  auto encrypter = GetEncrypter(100, 20, 10);
+  std::string pt = Random::GetRandomBytes(300);
+  std::vector<uint8_t> ct;
+
+  // Wrong segment sizes.
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            encrypter->EncryptSegmentAt(-1, AsSpan(pt.substr(0, 100)), false,
+                                        &ct).error_code());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            encrypter->EncryptSegmentAt(0, AsSpan(pt.substr(0, 100)), false,
+                                        &ct).error_code());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            encrypter->EncryptSegmentAt(1, AsSpan(pt.substr(0, 99)), false,
+                                        &ct).error_code());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            encrypter->EncryptSegmentAt(1, AsSpan(pt.substr(0, 101)), true,
+                                        &ct).error_code());
+  EXPECT_TRUE(
+      encrypter->EncryptSegmentAt(1, AsSpan(pt.substr(0, 99)), true, &ct)
+          .ok());
+
+  // Only an empty stream ends with an empty segment.
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            encrypter->EncryptSegmentAt(1, AsSpan(""), true, &ct)
+                .error_code());
+  EXPECT_TRUE(encrypter->EncryptSegmentAt(0, AsSpan(""), true, &ct).ok());
+
+  // Parts that do not end at a segment boundary.
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            encrypter->EncryptPart(0, AsSpan(pt.substr(0, 100)), false, &ct)
+                .error_code());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            encrypter->EncryptPart(1, AsSpan(""), false, &ct).error_code());
+  EXPECT_TRUE(
+      encrypter->EncryptPart(0, AsSpan(pt.substr(0, 170)), false, &ct).ok());
+  EXPECT_TRUE(
+      encrypter->EncryptPart(0, AsSpan(pt.substr(0, 100)), true, &ct).ok());
+
+  // A header of another stream.
+  DummyStreamingAead saead(100, 20, 10);
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            saead.NewRandomAccessEncrypterForHeader(std::string(19, 'h'), "aad")
+                .status().error_code());
+}
+
+TEST(StreamingAeadRandomAccessEncrypterTest, NullArguments) {
+  auto result = StreamingAeadRandomAccessEncrypter::New(nullptr);
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+  auto encrypter = GetEncrypter(100, 20, 10);
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            encrypter->EncryptPart(0, AsSpan("abc"), true, nullptr)
+                .error_code());
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,194 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/streaming_aead_split_decrypting_stream.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "tink/input_stream.h"
+#include "tink/random_access_stream.h"
+#include "tink/subtle/stream_segment_decrypter.h"
+#include "tink/util/buffer.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+using crypto::tink::util::Buffer;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace {
+
+// Reads exactly 'count' bytes at 'position' of 'ciphertext_source' into
+// 'output'.
+Status ReadFully(RandomAccessStream* ciphertext_source, int64_t position,
+                 int count, uint8_t* output) {
+  auto buffer_result =
+      Buffer::NewNonOwning(reinterpret_cast<char*>(output), count);
+  if (!buffer_result.ok()) return buffer_result.status();
+  Buffer& buffer = *buffer_result.ValueOrDie();
+  Status status = ciphertext_source->PRead(position, count, &buffer);
+  if (!status.ok() && status.error_code() != util::error::OUT_OF_RANGE) {
+    return status;
+  }
+  if (buffer.size() < count) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "ciphertext stream is too short");
+  }
+  return util::OkStatus();
+}
+
+}  // namespace
+
+// static
+StatusOr<std::unique_ptr<InputStream>> StreamingAeadSplitDecryptingStream::New(
+    std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+    std::unique_ptr<RandomAccessStream> ciphertext_source, int64_t split_start,
+    int64_t split_end) {
+  if (segment_decrypter == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "segment_decrypter must be non-null");
+  }
+  if (ciphertext_source == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "ciphertext_source must be non-null");
+  }
+  if (split_start < 0 || split_end < split_start) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("invalid split [", split_start, ", ",
+                               split_end, ")"));
+  }
+  std::unique_ptr<StreamingAeadSplitDecryptingStream> dec_stream(
+      new StreamingAeadSplitDecryptingStream());
+  dec_stream->segment_decrypter_ = std::move(segment_decrypter);
+  dec_stream->ct_source_ = std::move(ciphertext_source);
+  Status status = dec_stream->Initialize(split_start, split_end);
+  if (!status.ok()) return status;
+  return {std::move(dec_stream)};
+}
+
+Status StreamingAeadSplitDecryptingStream::Initialize(int64_t split_start,
+                                                      int64_t split_end) {
+  header_size_ = segment_decrypter_->get_header_size();
+  ct_offset_ = segment_decrypter_->get_ciphertext_offset();
+  std::vector<uint8_t> header(header_size_);
+  Status status =
+      ReadFully(ct_source_.get(), ct_offset_, header_size_, header.data());
+  if (!status.ok()) return status;
+  status = segment_decrypter_->Init(header);
+  if (!status.ok()) return status;
+  ct_segment_size_ = segment_decrypter_->get_ciphertext_segment_size();
+  ct_segment_overhead_ =
+      ct_segment_size_ - segment_decrypter_->get_plaintext_segment_size();
+
+  // The number of segments is computed as in DecryptingRandomAccessStream.
+  StatusOr<int64_t> ct_size_result = ct_source_->size();
+  if (!ct_size_result.ok()) return ct_size_result.status();
+  ct_size_ = ct_size_result.ValueOrDie();
+  segment_count_ = ct_size_ / ct_segment_size_;
+  if (ct_size_ % ct_segment_size_ > 0) segment_count_++;
+  // Tink supports up to 2^32 segments.
+  if (segment_count_ - 1 > std::numeric_limits<uint32_t>::max()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("too many segments: ", segment_count_));
+  }
+  if (ct_segment_overhead_ * segment_count_ + ct_offset_ + header_size_ >
+      ct_size_) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "ciphertext stream is too short");
+  }
+
+  // Segment i > 0 starts at i * ct_segment_size_, and belongs to the split
+  // iff split_start <= i * ct_segment_size_ < split_end.
+  next_segment_nr_ = (split_start + ct_segment_size_ - 1) / ct_segment_size_;
+  end_segment_nr_ = split_end == 0 ? 0 : (split_end - 1) / ct_segment_size_ + 1;
+  end_segment_nr_ = std::min(end_segment_nr_, segment_count_);
+  buffer_.resize(ct_segment_size_);
+  return util::OkStatus();
+}
+
+Status StreamingAeadSplitDecryptingStream::ReadAndDecryptSegment() {
+  int64_t segment_nr = next_segment_nr_;
+  bool is_last_segment = (segment_nr == segment_count_ - 1);
+  int64_t ct_position = segment_nr * ct_segment_size_;
+  int ct_count = ct_segment_size_;
+  if (segment_nr == 0) {
+    ct_position = ct_offset_ + header_size_;
+    ct_count -= ct_offset_ + header_size_;
+  }
+  if (is_last_segment) {
+    ct_count = static_cast<int>(ct_size_ - ct_position);
+  }
+  if (ct_count < ct_segment_overhead_) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "ciphertext segment is too short");
+  }
+  Status status =
+      ReadFully(ct_source_.get(), ct_position, ct_count, buffer_.data());
+  if (!status.ok()) return status;
+  pt_count_ = ct_count - ct_segment_overhead_;
+  status = segment_decrypter_->DecryptSegmentInto(
+      absl::MakeConstSpan(buffer_.data(), ct_count), segment_nr,
+      is_last_segment, absl::MakeSpan(buffer_.data(), pt_count_));
+  if (!status.ok()) return status;
+  pt_buffer_offset_ = 0;
+  next_segment_nr_++;
+  return util::OkStatus();
+}
+
+StatusOr<int> StreamingAeadSplitDecryptingStream::Next(const void** data) {
+  if (!status_.ok()) return status_;
+  // The last segment may have an empty plaintext.
+  while (pt_buffer_offset_ == pt_count_) {
+    if (next_segment_nr_ >= end_segment_nr_) {
+      return Status(util::error::OUT_OF_RANGE, "EOF");
+    }
+    status_ = ReadAndDecryptSegment();
+    if (!status_.ok()) return status_;
+  }
+  *data = buffer_.data() + pt_buffer_offset_;
+  int count = pt_count_ - pt_buffer_offset_;
+  pt_buffer_offset_ = pt_count_;
+  position_ += count;
+  return count;
+}
+
+void StreamingAeadSplitDecryptingStream::BackUp(int count) {
+  if (!status_.ok() || count < 1) return;
+  int actual_count = std::min(count, pt_buffer_offset_);
+  pt_buffer_offset_ -= actual_count;
+  position_ -= actual_count;
+}
+
+int64_t StreamingAeadSplitDecryptingStream::Position() const {
+  if (!status_.ok()) return -1;
+  return position_;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
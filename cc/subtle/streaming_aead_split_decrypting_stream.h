@@ -0,0 +1,96 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_SUBTLE_STREAMING_AEAD_SPLIT_DECRYPTING_STREAM_H_
+#define TINK_SUBTLE_STREAMING_AEAD_SPLIT_DECRYPTING_STREAM_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tink/input_stream.h"
+#include "tink/random_access_stream.h"
+#include "tink/subtle/stream_segment_decrypter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// An InputStream that decrypts the segments of a ciphertext stream which
+// start in one split of the ciphertext, so that the splits of a large
+// ciphertext can be decrypted by different workers, e.g. in MapReduce jobs.
+//
+// The split [split_start, split_end) of the ciphertext owns the segments
+// whose first ciphertext byte lies in it, where the first segment is taken
+// to start at offset 0 (before the header).  Thus the splits of any
+// partition of [0, ciphertext size) own every segment exactly once, and
+// the concatenation of their plaintexts, in order, is the plaintext of the
+// stream.  A split may own no segment, and its stream is then empty.  The
+// last owned segment is read completely, even if it ends after split_end.
+//
+// Every stream reads the header of the ciphertext and its size, so that
+// it knows which segment is the last one.
+class StreamingAeadSplitDecryptingStream : public InputStream {
+ public:
+  // Returns a stream decrypting the segments of 'ciphertext_source' owned
+  // by [split_start, split_end) with 'segment_decrypter', which must not be
+  // initialized yet.
+  static
+  crypto::tink::util::StatusOr<std::unique_ptr<crypto::tink::InputStream>>
+      New(std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+          std::unique_ptr<crypto::tink::RandomAccessStream> ciphertext_source,
+          int64_t split_start, int64_t split_end);
+
+  // -----------------------
+  // Methods of InputStream-interface implemented by this class.
+  crypto::tink::util::StatusOr<int> Next(const void** data) override;
+  void BackUp(int count) override;
+  int64_t Position() const override;
+
+ private:
+  StreamingAeadSplitDecryptingStream() {}
+  crypto::tink::util::Status Initialize(int64_t split_start,
+                                        int64_t split_end);
+  // Reads and decrypts the segment next_segment_nr_ into buffer_.
+  crypto::tink::util::Status ReadAndDecryptSegment();
+
+  std::unique_ptr<StreamSegmentDecrypter> segment_decrypter_;
+  std::unique_ptr<crypto::tink::RandomAccessStream> ct_source_;
+  int64_t ct_size_;
+  int header_size_;
+  int ct_offset_;
+  int ct_segment_size_;
+  int ct_segment_overhead_;
+  int64_t segment_count_;    // number of segments of the whole stream
+  int64_t next_segment_nr_;  // next segment to decrypt
+  int64_t end_segment_nr_;   // first segment after the split
+  // A ciphertext segment, decrypted in place, so that the plaintext is in
+  // its first pt_count_ bytes.
+  std::vector<uint8_t> buffer_;
+  int pt_count_ = 0;
+  int pt_buffer_offset_ = 0;  // offset of the next plaintext byte in buffer_
+  int64_t position_ = 0;      // number of plaintext bytes read
+  crypto::tink::util::Status status_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_STREAMING_AEAD_SPLIT_DECRYPTING_STREAM_H_
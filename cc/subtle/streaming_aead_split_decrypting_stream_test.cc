@@ -0,0 +1,204 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/subtle/streaming_aead_split_decrypting_stream.h"
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/input_stream.h"
+#include "tink/random_access_stream.h"
+#include "tink/subtle/aes_ctr_hmac_streaming.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/nonce_based_streaming_aead.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/ostream_output_stream.h"
+#include "tink/util/prefetched_random_access_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::util::OstreamOutputStream;
+using ::crypto::tink::util::PrefetchedRandomAccessStream;
+using ::testing::HasSubstr;
+
+constexpr int kSegmentSize = 256;
+
+std::unique_ptr<NonceBasedStreamingAead> NewStreamingAead(
+    int ciphertext_offset) {
+  AesCtrHmacStreaming::Params params;
+  params.ikm = Random::GetRandomKeyBytes(32);
+  params.hkdf_algo = SHA256;
+  params.key_size = 32;
+  params.ciphertext_segment_size = kSegmentSize;
+  params.ciphertext_offset = ciphertext_offset;
+  params.tag_algo = SHA256;
+  params.tag_size = 16;
+  return std::move(AesCtrHmacStreaming::New(std::move(params)).ValueOrDie());
+}
+
+std::string Encrypt(StreamingAead* saead, absl::string_view plaintext,
+                    int ciphertext_offset) {
+  auto ct_stream = absl::make_unique<std::stringstream>();
+  auto ct_buf = ct_stream->rdbuf();
+  auto enc_stream_result = saead->NewEncryptingStream(
+      absl::make_unique<OstreamOutputStream>(std::move(ct_stream)),
+      "associated data");
+  EXPECT_THAT(enc_stream_result.status(), IsOk());
+  EXPECT_THAT(
+      test::WriteToStream(enc_stream_result.ValueOrDie().get(), plaintext),
+      IsOk());
+  // The encrypting stream does not write the ciphertext offset.
+  return std::string(ciphertext_offset, 'x') + ct_buf->str();
+}
+
+std::unique_ptr<RandomAccessStream> StreamOf(const std::string& data) {
+  auto stream = absl::make_unique<PrefetchedRandomAccessStream>(data.size());
+  EXPECT_THAT(stream->AddRange(0, data), IsOk());
+  return std::move(stream);
+}
+
+// Returns the plaintext of the split [split_start, split_end) of
+// 'ciphertext'.
+util::StatusOr<std::string> DecryptSplit(NonceBasedStreamingAead* saead,
+                                         const std::string& ciphertext,
+                                         int64_t split_start,
+                                         int64_t split_end) {
+  auto dec_stream_result = saead->NewSplitDecryptingStream(
+      StreamOf(ciphertext), "associated data", split_start, split_end);
+  if (!dec_stream_result.ok()) return dec_stream_result.status();
+  std::string plaintext;
+  util::Status status =
+      test::ReadFromStream(dec_stream_result.ValueOrDie().get(), &plaintext);
+  if (!status.ok()) return status;
+  return plaintext;
+}
+
+TEST(StreamingAeadSplitDecryptingStreamTest, SplitsJoinToThePlaintext) {
+  for (int ciphertext_offset : {0, 8}) {
+    std::unique_ptr<NonceBasedStreamingAead> saead =
+        NewStreamingAead(ciphertext_offset);
+    for (int pt_size : {0, 1, 200, 1000, 10 * kSegmentSize + 7}) {
+      std::string plaintext = Random::GetRandomBytes(pt_size);
+      std::string ciphertext =
+          Encrypt(saead.get(), plaintext, ciphertext_offset);
+      for (int split_size : {1, 100, kSegmentSize, 1000, 1 << 20}) {
+        SCOPED_TRACE(absl::StrCat("ciphertext_offset = ", ciphertext_offset,
+                                  ", pt_size = ", pt_size,
+                                  ", split_size = ", split_size));
+        std::string decrypted;
+        for (int64_t start = 0; start < ciphertext.size();
+             start += split_size) {
+          int64_t end =
+              std::min<int64_t>(start + split_size, ciphertext.size());
+          auto split_result =
+              DecryptSplit(saead.get(), ciphertext, start, end);
+          ASSERT_THAT(split_result.status(), IsOk());
+          decrypted += split_result.ValueOrDie();
+        }
+        EXPECT_EQ(plaintext, decrypted);
+      }
+    }
+  }
+}
+
+TEST(StreamingAeadSplitDecryptingStreamTest, SplitOwnsTheSegmentsStartingInIt) {
+  std::unique_ptr<NonceBasedStreamingAead> saead = NewStreamingAead(0);
+  std::string plaintext = Random::GetRandomBytes(10 * kSegmentSize);
+  std::string ciphertext = Encrypt(saead.get(), plaintext, 0);
+
+  // No segment starts in [1, kSegmentSize).
+  auto split_result = DecryptSplit(saead.get(), ciphertext, 1, kSegmentSize);
+  ASSERT_THAT(split_result.status(), IsOk());
+  EXPECT_EQ("", split_result.ValueOrDie());
+
+  // Segments 1 and 2 start in [kSegmentSize, 2 * kSegmentSize + 1).  The
+  // header takes 40 bytes and the tags 16 bytes of each segment, so that
+  // the first segment holds 200 plaintext bytes and the others 240.
+  split_result = DecryptSplit(saead.get(), ciphertext, kSegmentSize,
+                              2 * kSegmentSize + 1);
+  ASSERT_THAT(split_result.status(), IsOk());
+  EXPECT_EQ(plaintext.substr(200, 2 * 240), split_result.ValueOrDie());
+}
+
+TEST(StreamingAeadSplitDecryptingStreamTest, DetectsModifications) {
+  std::unique_ptr<NonceBasedStreamingAead> saead = NewStreamingAead(0);
+  std::string plaintext = Random::GetRandomBytes(5 * kSegmentSize);
+  std::string ciphertext = Encrypt(saead.get(), plaintext, 0);
+  int64_t size = ciphertext.size();
+
+  // A modified segment fails only the split that owns it.
+  std::string modified = ciphertext;
+  modified[2 * kSegmentSize + 10] ^= 1;
+  EXPECT_THAT(DecryptSplit(saead.get(), modified, 0, 2 * kSegmentSize).status(),
+              IsOk());
+  EXPECT_FALSE(DecryptSplit(saead.get(), modified, 2 * kSegmentSize,
+                            3 * kSegmentSize)
+                   .ok());
+  EXPECT_THAT(DecryptSplit(saead.get(), modified, 3 * kSegmentSize, size)
+                  .status(),
+              IsOk());
+
+  // A truncated ciphertext fails the split that owns its new last segment.
+  std::string truncated = ciphertext.substr(0, 4 * kSegmentSize);
+  EXPECT_THAT(
+      DecryptSplit(saead.get(), truncated, 0, 3 * kSegmentSize).status(),
+      IsOk());
+  EXPECT_FALSE(DecryptSplit(saead.get(), truncated, 3 * kSegmentSize,
+                            4 * kSegmentSize)
+                   .ok());
+
+  // Wrong associated data fails every split.
+  auto dec_stream_result = saead->NewSplitDecryptingStream(
+      StreamOf(ciphertext), "other associated data", 0, size);
+  ASSERT_THAT(dec_stream_result.status(), IsOk());
+  std::string decrypted;
+  EXPECT_FALSE(
+      test::ReadFromStream(dec_stream_result.ValueOrDie().get(), &decrypted)
+          .ok());
+}
+
+TEST(StreamingAeadSplitDecryptingStreamTest, InvalidArguments) {
+  std::unique_ptr<NonceBasedStreamingAead> saead = NewStreamingAead(0);
+  std::string ciphertext = Encrypt(saead.get(), "plaintext", 0);
+  EXPECT_FALSE(DecryptSplit(saead.get(), ciphertext, -1, 10).ok());
+  EXPECT_FALSE(DecryptSplit(saead.get(), ciphertext, 10, 5).ok());
+  auto split_result = DecryptSplit(saead.get(), ciphertext.substr(0, 10), 0,
+                                   10);
+  EXPECT_FALSE(split_result.ok());
+  EXPECT_THAT(std::string(split_result.status().error_message()),
+              HasSubstr("too short"));
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,156 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/streaming_aead_stream_verifier.h"
+
+#include <memory>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "tink/input_stream.h"
+#include "tink/internal/thread_pool.h"
+#include "tink/subtle/stream_segment_decrypter.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace {
+
+// The number of segments read per thread before they are verified.
+constexpr int kSegmentsPerThread = 4;
+
+// Reads up to 'count' bytes into 'output', and resizes it to the number of
+// bytes read.
+Status ReadSegment(InputStream* input_stream, int count,
+                   std::vector<uint8_t>* output) {
+  output->resize(count);
+  auto read_result = input_stream->ReadInto(absl::MakeSpan(*output));
+  if (!read_result.ok()) return read_result.status();
+  output->resize(read_result.ValueOrDie());
+  return util::OkStatus();
+}
+
+// Returns true iff 'input_stream' has no more bytes, without changing its
+// position.
+StatusOr<bool> AtEndOfStream(InputStream* input_stream) {
+  const void* buffer;
+  while (true) {
+    auto next_result = input_stream->Next(&buffer);
+    if (next_result.status().error_code() == util::error::OUT_OF_RANGE) {
+      return true;
+    }
+    if (!next_result.ok()) return next_result.status();
+    if (next_result.ValueOrDie() > 0) {
+      input_stream->BackUp(next_result.ValueOrDie());
+      return false;
+    }
+  }
+}
+
+}  // namespace
+
+Status VerifyCiphertextStream(
+    std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+    InputStream* ciphertext_source, int parallelism) {
+  if (segment_decrypter == nullptr || ciphertext_source == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "segment_decrypter and ciphertext_source must be non-null");
+  }
+  if (parallelism < 1) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "parallelism must be at least 1");
+  }
+  int header_size = segment_decrypter->get_header_size();
+  std::vector<uint8_t> header;
+  Status status = ReadSegment(ciphertext_source, header_size, &header);
+  if (!status.ok()) return status;
+  if (header.size() < header_size) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "Could not read stream header.");
+  }
+  status = segment_decrypter->Init(header);
+  if (!status.ok()) return status;
+
+  int ct_segment_size = segment_decrypter->get_ciphertext_segment_size();
+  int first_segment_size = ct_segment_size -
+                           segment_decrypter->get_ciphertext_offset() -
+                           header_size;
+  if (first_segment_size <= 0) {
+    return Status(util::error::INTERNAL,
+                  "Size of the first segment must be greater than 0.");
+  }
+
+  std::unique_ptr<internal::ThreadPool> pool;
+  if (parallelism > 1) {
+    pool = absl::make_unique<internal::ThreadPool>(parallelism - 1);
+  }
+  std::vector<std::vector<uint8_t>> segments(parallelism * kSegmentsPerThread);
+  std::vector<Status> statuses(segments.size());
+  int64_t first_segment_number = 0;
+  bool read_last_segment = false;
+  while (!read_last_segment) {
+    // Read the next batch of segments.  As in the decrypting streams, a full
+    // segment is the last one iff no ciphertext follows it.
+    int count = 0;
+    while (count < segments.size() && !read_last_segment) {
+      int64_t segment_number = first_segment_number + count;
+      int size = segment_number == 0 ? first_segment_size : ct_segment_size;
+      status = ReadSegment(ciphertext_source, size, &segments[count]);
+      if (!status.ok()) return status;
+      if (segments[count].size() < size) {
+        read_last_segment = true;
+      } else {
+        auto at_end_result = AtEndOfStream(ciphertext_source);
+        if (!at_end_result.ok()) return at_end_result.status();
+        read_last_segment = at_end_result.ValueOrDie();
+      }
+      count++;
+    }
+
+    auto verify = [&](int i) {
+      statuses[i] = segment_decrypter->VerifySegment(
+          segments[i], first_segment_number + i,
+          /* is_last_segment = */ read_last_segment && i == count - 1);
+    };
+    if (pool != nullptr) {
+      pool->ParallelFor(count, verify);
+    } else {
+      for (int i = 0; i < count; i++) verify(i);
+    }
+    for (int i = 0; i < count; i++) {
+      if (!statuses[i].ok()) {
+        return Status(statuses[i].CanonicalCode(),
+                      absl::StrCat("Segment ", first_segment_number + i,
+                                   " failed verification: ",
+                                   statuses[i].error_message()));
+      }
+    }
+    first_segment_number += count;
+  }
+  return util::OkStatus();
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
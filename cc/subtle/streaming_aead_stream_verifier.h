@@ -0,0 +1,46 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_STREAMING_AEAD_STREAM_VERIFIER_H_
+#define TINK_SUBTLE_STREAMING_AEAD_STREAM_VERIFIER_H_
+
+#include <memory>
+
+#include "tink/input_stream.h"
+#include "tink/subtle/stream_segment_decrypter.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// Checks that 'ciphertext_source' is a complete and authentic ciphertext
+// stream for 'segment_decrypter', which must not be initialized yet, without
+// decrypting more than StreamSegmentDecrypter::VerifySegment() does.
+//
+// The segments are read in batches, and the segments of a batch are verified
+// on up to 'parallelism' threads, including the calling one.  The error of
+// the first segment that fails verification is returned, with its segment
+// number in the message.
+crypto::tink::util::Status VerifyCiphertextStream(
+    std::unique_ptr<StreamSegmentDecrypter> segment_decrypter,
+    crypto::tink::InputStream* ciphertext_source, int parallelism);
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_STREAMING_AEAD_STREAM_VERIFIER_H_
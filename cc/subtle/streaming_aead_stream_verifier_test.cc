@@ -0,0 +1,162 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/streaming_aead_stream_verifier.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/input_stream.h"
+#include "tink/streaming_aead.h"
+#include "tink/subtle/aes_ctr_hmac_streaming.h"
+#include "tink/subtle/aes_gcm_hkdf_streaming.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/ostream_output_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::crypto::tink::util::IstreamInputStream;
+using ::crypto::tink::util::OstreamOutputStream;
+using ::testing::HasSubstr;
+
+constexpr int kSegmentSize = 256;
+
+std::unique_ptr<StreamingAead> NewAesCtrHmacStreaming() {
+  AesCtrHmacStreaming::Params params;
+  params.ikm = Random::GetRandomKeyBytes(32);
+  params.hkdf_algo = SHA256;
+  params.key_size = 32;
+  params.ciphertext_segment_size = kSegmentSize;
+  params.ciphertext_offset = 0;
+  params.tag_algo = SHA256;
+  params.tag_size = 16;
+  return std::move(AesCtrHmacStreaming::New(std::move(params)).ValueOrDie());
+}
+
+std::unique_ptr<StreamingAead> NewAesGcmHkdfStreaming() {
+  AesGcmHkdfStreaming::Params params;
+  params.ikm = Random::GetRandomKeyBytes(32);
+  params.hkdf_hash = SHA256;
+  params.derived_key_size = 32;
+  params.ciphertext_segment_size = kSegmentSize;
+  params.ciphertext_offset = 0;
+  return std::move(AesGcmHkdfStreaming::New(std::move(params)).ValueOrDie());
+}
+
+std::string Encrypt(StreamingAead* saead, absl::string_view plaintext,
+                    absl::string_view associated_data) {
+  auto ct_stream = absl::make_unique<std::stringstream>();
+  auto ct_buf = ct_stream->rdbuf();
+  auto enc_stream_result = saead->NewEncryptingStream(
+      absl::make_unique<OstreamOutputStream>(std::move(ct_stream)),
+      associated_data);
+  EXPECT_THAT(enc_stream_result.status(), IsOk());
+  EXPECT_THAT(
+      test::WriteToStream(enc_stream_result.ValueOrDie().get(), plaintext),
+      IsOk());
+  return ct_buf->str();
+}
+
+std::unique_ptr<InputStream> StreamOf(absl::string_view data) {
+  return absl::make_unique<IstreamInputStream>(
+      absl::make_unique<std::stringstream>(std::string(data)));
+}
+
+struct VerifierTestParam {
+  bool use_gcm;
+  int parallelism;
+};
+
+class StreamingAeadStreamVerifierTest
+    : public ::testing::TestWithParam<VerifierTestParam> {
+ protected:
+  void SetUp() override {
+    saead_ = GetParam().use_gcm ? NewAesGcmHkdfStreaming()
+                                : NewAesCtrHmacStreaming();
+  }
+
+  util::Status Verify(absl::string_view ciphertext,
+                      absl::string_view associated_data) {
+    return saead_->VerifyStream(StreamOf(ciphertext), associated_data,
+                                GetParam().parallelism);
+  }
+
+  std::unique_ptr<StreamingAead> saead_;
+};
+
+TEST_P(StreamingAeadStreamVerifierTest, VerifiesValidCiphertexts) {
+  // Sizes around the boundaries of the first segments, and enough segments
+  // for several batches.
+  for (int size : {0, 1, 100, 200, 250, 1000, 100 * kSegmentSize}) {
+    SCOPED_TRACE(absl::StrCat("plaintext size = ", size));
+    std::string ciphertext = Encrypt(saead_.get(), Random::GetRandomBytes(size),
+                                     "associated data");
+    EXPECT_THAT(Verify(ciphertext, "associated data"), IsOk());
+  }
+}
+
+TEST_P(StreamingAeadStreamVerifierTest, ReportsFirstBadSegment) {
+  std::string ciphertext =
+      Encrypt(saead_.get(), Random::GetRandomBytes(100 * kSegmentSize), "ad");
+  // The header and the shorter first segment take one segment together.
+  for (int segment : {1, 37, 99}) {
+    SCOPED_TRACE(absl::StrCat("corrupted segment = ", segment));
+    std::string corrupted = ciphertext;
+    corrupted[segment * kSegmentSize + 10] ^= 1;
+    corrupted[(segment + 5) * kSegmentSize + 10] ^= 1;
+    util::Status status = Verify(corrupted, "ad");
+    EXPECT_FALSE(status.ok());
+    EXPECT_THAT(status.error_message(),
+                HasSubstr(absl::StrCat("Segment ", segment, " ")));
+  }
+}
+
+TEST_P(StreamingAeadStreamVerifierTest, RejectsModifiedCiphertexts) {
+  std::string ciphertext =
+      Encrypt(saead_.get(), Random::GetRandomBytes(10 * kSegmentSize), "ad");
+  EXPECT_FALSE(Verify(ciphertext, "other ad").ok());
+  // Truncated at a segment boundary, and in the middle of a segment.
+  EXPECT_FALSE(Verify(ciphertext.substr(0, 5 * kSegmentSize), "ad").ok());
+  EXPECT_FALSE(Verify(ciphertext.substr(0, ciphertext.size() - 1), "ad").ok());
+  EXPECT_FALSE(Verify(absl::StrCat(ciphertext, "x"), "ad").ok());
+  EXPECT_THAT(Verify(ciphertext.substr(0, 5), "ad"),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    StreamingAeadStreamVerifierTests, StreamingAeadStreamVerifierTest,
+    ::testing::Values(VerifierTestParam{false, 1}, VerifierTestParam{false, 4},
+                      VerifierTestParam{true, 1}, VerifierTestParam{true, 4}));
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
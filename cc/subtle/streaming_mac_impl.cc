@@ -14,7 +14,12 @@
 
 #include "tink/subtle/streaming_mac_impl.h"
 
+#include <cstdint>
+#include <string>
+#include <utility>
+
 #include "absl/memory/memory.h"
+#include "tink/util/secret_data.h"
 #include "tink/util/status.h"
 
 namespace crypto {
@@ -23,14 +28,20 @@ namespace subtle {
 
 namespace {
 constexpr size_t kBufferSize = 4096;
-}
 
-class ComputeMacOutputStream : public OutputStreamWithResult<std::string> {
+// Associated data of the checkpoints, which are the position in the stream
+// (8 bytes, little-endian) followed by the exported StatefulMac state.
+constexpr char kCheckpointContext[] = "tink streaming mac checkpoint";
+constexpr size_t kPositionSize = 8;
+}  // namespace
+
+class ComputeMacOutputStream : public CheckpointableComputeMacOutputStream {
  public:
-  explicit ComputeMacOutputStream(std::unique_ptr<StatefulMac> mac)
+  explicit ComputeMacOutputStream(std::unique_ptr<StatefulMac> mac,
+                                  int64_t position = 0)
       : status_(util::OkStatus()),
         mac_(std::move(mac)),
-        position_(0),
+        position_(position),
         buffer_position_(0),
         buffer_("") {
     buffer_.resize(kBufferSize);
@@ -40,6 +51,7 @@ class ComputeMacOutputStream : public OutputStreamWithResult<std::string> {
   util::StatusOr<std::string> CloseStreamAndComputeResult() override;
   void BackUp(int count) override;
   int64_t Position() const override { return position_; }
+  util::StatusOr<std::string> Checkpoint(const Aead& aead) override;
 
  private:
   void WriteIntoMac();
@@ -93,6 +105,32 @@ void ComputeMacOutputStream::BackUp(int count) {
   position_ -= count;
 }
 
+util::StatusOr<std::string> ComputeMacOutputStream::Checkpoint(
+    const Aead& aead) {
+  if (!status_.ok()) {
+    return status_;
+  }
+  // Ends the current buffer, as NextBuffer() does.
+  WriteIntoMac();
+  buffer_position_ = 0;
+  if (!status_.ok()) {
+    return status_;
+  }
+  util::StatusOr<util::SecretData> state = mac_->ExportState();
+  if (!state.ok()) {
+    return state.status();
+  }
+  util::SecretData plaintext(kPositionSize);
+  for (size_t i = 0; i < kPositionSize; i++) {
+    plaintext[i] = static_cast<uint8_t>(static_cast<uint64_t>(position_) >>
+                                        (8 * i));
+  }
+  plaintext.insert(plaintext.end(), state.ValueOrDie().begin(),
+                   state.ValueOrDie().end());
+  return aead.Encrypt(util::SecretDataAsStringView(plaintext),
+                      kCheckpointContext);
+}
+
 // Writes the data in buffer_ into mac_, and clears buffer_.
 void ComputeMacOutputStream::WriteIntoMac() {
   // Remove the suffix of the buffer (all data after buffer_position_).
@@ -192,6 +230,50 @@ StreamingMacImpl::NewVerifyMacOutputStream(const std::string& mac_value) const {
       absl::make_unique<VerifyMacOutputStream>(
           mac_value, std::move(mac_status.ValueOrDie())));
 }
+
+util::StatusOr<std::unique_ptr<CheckpointableComputeMacOutputStream>>
+StreamingMacImpl::NewCheckpointableComputeMacOutputStream() const {
+  util::StatusOr<std::unique_ptr<StatefulMac>> mac_status =
+      mac_factory_->Create();
+  if (!mac_status.ok()) {
+    return mac_status.status();
+  }
+  return std::unique_ptr<CheckpointableComputeMacOutputStream>(
+      absl::make_unique<ComputeMacOutputStream>(
+          std::move(mac_status.ValueOrDie())));
+}
+
+util::StatusOr<std::unique_ptr<CheckpointableComputeMacOutputStream>>
+StreamingMacImpl::ResumeComputeMacOutputStream(absl::string_view checkpoint,
+                                               const Aead& aead) const {
+  util::StatusOr<std::string> decrypted =
+      aead.Decrypt(checkpoint, kCheckpointContext);
+  if (!decrypted.ok()) {
+    return decrypted.status();
+  }
+  util::SecretData plaintext =
+      util::SecretDataFromStringView(decrypted.ValueOrDie());
+  util::SafeZeroString(&decrypted.ValueOrDie());
+  if (plaintext.size() < kPositionSize) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid checkpoint");
+  }
+  uint64_t position = 0;
+  for (size_t i = 0; i < kPositionSize; i++) {
+    position |= static_cast<uint64_t>(plaintext[i]) << (8 * i);
+  }
+  if (position > INT64_MAX) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid checkpoint");
+  }
+  util::StatusOr<std::unique_ptr<StatefulMac>> mac_status =
+      mac_factory_->Resume(
+          util::SecretData(plaintext.begin() + kPositionSize, plaintext.end()));
+  if (!mac_status.ok()) {
+    return mac_status.status();
+  }
+  return std::unique_ptr<CheckpointableComputeMacOutputStream>(
+      absl::make_unique<ComputeMacOutputStream>(
+          std::move(mac_status.ValueOrDie()), position));
+}
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -18,6 +18,8 @@
 #include <memory>
 #include <utility>
 
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
 #include "tink/streaming_mac.h"
 #include "tink/subtle/mac/stateful_mac.h"
 
@@ -42,6 +44,16 @@ class StreamingMacImpl : public StreamingMac {
   util::StatusOr<std::unique_ptr<OutputStreamWithResult<util::Status>>>
   NewVerifyMacOutputStream(const std::string& mac_value) const override;
 
+  // Returns a ComputeMacOutputStream whose checkpoints hold the exported
+  // state of the StatefulMac; fails in Checkpoint() if the StatefulMac cannot
+  // export its state.
+  util::StatusOr<std::unique_ptr<CheckpointableComputeMacOutputStream>>
+  NewCheckpointableComputeMacOutputStream() const override;
+
+  util::StatusOr<std::unique_ptr<CheckpointableComputeMacOutputStream>>
+  ResumeComputeMacOutputStream(absl::string_view checkpoint,
+                               const Aead& aead) const override;
+
  private:
   std::unique_ptr<StatefulMacFactory> mac_factory_;
 };
@@ -15,8 +15,11 @@
 #include "tink/subtle/streaming_mac_impl.h"
 
 #include "gtest/gtest.h"
+#include "tink/subtle/common_enums.h"
 #include "tink/subtle/random.h"
+#include "tink/subtle/stateful_hmac_boringssl.h"
 #include "tink/subtle/test_util.h"
+#include "tink/util/secret_data.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "tink/util/test_matchers.h"
@@ -27,6 +30,7 @@ namespace tink {
 namespace subtle {
 namespace {
 
+using ::crypto::tink::test::DummyAead;
 using ::crypto::tink::test::DummyStatefulMac;
 using ::crypto::tink::test::IsOk;
 using ::crypto::tink::test::StatusIs;
@@ -250,6 +254,82 @@ TEST(StreamingMacImplTest, VerifyCloseTwiceError) {
   EXPECT_EQ(util::error::FAILED_PRECONDITION, reclose_status.error_code());
 }
 
+std::unique_ptr<StreamingMac> GetHmacStreamingMac() {
+  return absl::make_unique<StreamingMacImpl>(
+      absl::make_unique<StatefulHmacBoringSslFactory>(
+          HashType::SHA256, 16,
+          util::SecretDataFromStringView(std::string(32, 'k'))));
+}
+
+TEST(StreamingMacImplTest, ComputeResumesFromCheckpoint) {
+  std::unique_ptr<StreamingMac> streaming_mac = GetHmacStreamingMac();
+  DummyAead aead("checkpoint aead");
+  std::string text = Random::GetRandomBytes(10000);
+  auto full_stream = streaming_mac->NewComputeMacOutputStream();
+  ASSERT_THAT(full_stream.status(), IsOk());
+  ASSERT_THAT(test::WriteToStream(full_stream.ValueOrDie().get(), text, false),
+              IsOk());
+  auto expected_mac = full_stream.ValueOrDie()->CloseAndGetResult();
+  ASSERT_THAT(expected_mac.status(), IsOk());
+
+  for (size_t split : {0, 1, 4096, 5000, 10000}) {
+    SCOPED_TRACE(split);
+    auto first_stream =
+        streaming_mac->NewCheckpointableComputeMacOutputStream();
+    ASSERT_THAT(first_stream.status(), IsOk());
+    ASSERT_THAT(test::WriteToStream(first_stream.ValueOrDie().get(),
+                                    text.substr(0, split), false),
+                IsOk());
+    auto checkpoint = first_stream.ValueOrDie()->Checkpoint(aead);
+    ASSERT_THAT(checkpoint.status(), IsOk());
+
+    auto second_stream =
+        streaming_mac->ResumeComputeMacOutputStream(checkpoint.ValueOrDie(),
+                                                    aead);
+    ASSERT_THAT(second_stream.status(), IsOk());
+    EXPECT_EQ(second_stream.ValueOrDie()->Position(), split);
+    ASSERT_THAT(test::WriteToStream(second_stream.ValueOrDie().get(),
+                                    text.substr(split), false),
+                IsOk());
+    EXPECT_EQ(second_stream.ValueOrDie()->Position(), text.size());
+    auto mac = second_stream.ValueOrDie()->CloseAndGetResult();
+    ASSERT_THAT(mac.status(), IsOk());
+    EXPECT_EQ(mac.ValueOrDie(), expected_mac.ValueOrDie());
+
+    // The checkpointed stream goes on, too.
+    ASSERT_THAT(test::WriteToStream(first_stream.ValueOrDie().get(),
+                                    text.substr(split), false),
+                IsOk());
+    mac = first_stream.ValueOrDie()->CloseAndGetResult();
+    ASSERT_THAT(mac.status(), IsOk());
+    EXPECT_EQ(mac.ValueOrDie(), expected_mac.ValueOrDie());
+  }
+}
+
+TEST(StreamingMacImplTest, ResumeRejectsCheckpointOfOtherAead) {
+  std::unique_ptr<StreamingMac> streaming_mac = GetHmacStreamingMac();
+  auto stream = streaming_mac->NewCheckpointableComputeMacOutputStream();
+  ASSERT_THAT(stream.status(), IsOk());
+  ASSERT_THAT(test::WriteToStream(stream.ValueOrDie().get(), "some data",
+                                  false),
+              IsOk());
+  auto checkpoint = stream.ValueOrDie()->Checkpoint(DummyAead("aead 1"));
+  ASSERT_THAT(checkpoint.status(), IsOk());
+  EXPECT_FALSE(streaming_mac
+                   ->ResumeComputeMacOutputStream(checkpoint.ValueOrDie(),
+                                                  DummyAead("aead 2"))
+                   .ok());
+}
+
+TEST(StreamingMacImplTest, CheckpointFailsIfMacCannotExportState) {
+  auto streaming_mac = absl::make_unique<StreamingMacImpl>(
+      absl::make_unique<DummyStatefulMacFactory>());
+  auto stream = streaming_mac->NewCheckpointableComputeMacOutputStream();
+  ASSERT_THAT(stream.status(), IsOk());
+  EXPECT_THAT(stream.ValueOrDie()->Checkpoint(DummyAead("aead")).status(),
+              StatusIs(util::error::UNIMPLEMENTED));
+}
+
 }  // namespace
 }  // namespace subtle
 }  // namespace tink
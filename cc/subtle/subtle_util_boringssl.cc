@@ -32,6 +32,7 @@
 #include "openssl/mem.h"
 #include "openssl/rsa.h"
 #include "tink/config/tink_fips.h"
+#include "tink/internal/traced_operation.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/random.h"
 #include "tink/util/errors.h"
@@ -108,6 +109,39 @@ util::StatusOr<EC_GROUP *> SubtleUtilBoringSSL::GetEcGroup(
   }
 }
 
+// static
+util::StatusOr<const EC_GROUP *> SubtleUtilBoringSSL::GetSharedEcGroup(
+    EllipticCurveType curve_type) {
+  // The groups are created once and intentionally never freed.  They are
+  // never modified after construction, so they can be shared by all threads.
+  static const EC_GROUP *const p256 =
+      EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+  static const EC_GROUP *const p384 =
+      EC_GROUP_new_by_curve_name(NID_secp384r1);
+  static const EC_GROUP *const p521 =
+      EC_GROUP_new_by_curve_name(NID_secp521r1);
+  const EC_GROUP *group;
+  switch (curve_type) {
+    case EllipticCurveType::NIST_P256:
+      group = p256;
+      break;
+    case EllipticCurveType::NIST_P384:
+      group = p384;
+      break;
+    case EllipticCurveType::NIST_P521:
+      group = p521;
+      break;
+    default:
+      return util::Status(util::error::UNIMPLEMENTED,
+                          "Unsupported elliptic curve");
+  }
+  if (group == nullptr) {
+    return util::Status(util::error::INTERNAL,
+                        "EC_GROUP_new_by_curve_name failed");
+  }
+  return group;
+}
+
 // static
 util::StatusOr<EC_POINT *> SubtleUtilBoringSSL::GetEcPoint(
     EllipticCurveType curve, absl::string_view pubx, absl::string_view puby) {
@@ -120,14 +154,14 @@ util::StatusOr<EC_POINT *> SubtleUtilBoringSSL::GetEcPoint(
   if (bn_x.get() == nullptr || bn_y.get() == nullptr) {
     return util::Status(util::error::INTERNAL, "BN_bin2bn failed");
   }
-  auto status_or_ec_group = SubtleUtilBoringSSL::GetEcGroup(curve);
+  auto status_or_ec_group = GetSharedEcGroup(curve);
   if (!status_or_ec_group.ok()) {
     return status_or_ec_group.status();
   }
-  bssl::UniquePtr<EC_GROUP> group(status_or_ec_group.ValueOrDie());
-  bssl::UniquePtr<EC_POINT> pub_key(EC_POINT_new(group.get()));
+  const EC_GROUP *group = status_or_ec_group.ValueOrDie();
+  bssl::UniquePtr<EC_POINT> pub_key(EC_POINT_new(group));
   if (1 != EC_POINT_set_affine_coordinates_GFp(
-               group.get(), pub_key.get(), bn_x.get(), bn_y.get(), nullptr)) {
+               group, pub_key.get(), bn_x.get(), bn_y.get(), nullptr)) {
     return util::Status(util::error::INTERNAL,
                         "EC_POINT_set_affine_coordinates_GFp failed");
   }
@@ -228,8 +262,8 @@ SubtleUtilBoringSSL::X25519KeyFromEcKey(
 std::unique_ptr<SubtleUtilBoringSSL::Ed25519Key>
 SubtleUtilBoringSSL::GetNewEd25519Key() {
   // Generate a new secret seed.
-  util::SecretData secret_seed = util::SecretDataFromStringView(
-      crypto::tink::subtle::Random::GetRandomBytes(32));
+  util::SecretData secret_seed =
+      crypto::tink::subtle::Random::GetRandomKeyBytes(32);
   return GetNewEd25519KeyFromSeed(secret_seed);
 }
 
@@ -277,50 +311,50 @@ util::StatusOr<const EVP_MD *> SubtleUtilBoringSSL::EvpHash(
 // static
 util::StatusOr<util::SecretData> SubtleUtilBoringSSL::ComputeEcdhSharedSecret(
     EllipticCurveType curve, const BIGNUM *priv_key, const EC_POINT *pub_key) {
-  auto status_or_ec_group = SubtleUtilBoringSSL::GetEcGroup(curve);
+  auto status_or_ec_group = GetSharedEcGroup(curve);
   if (!status_or_ec_group.ok()) {
     return status_or_ec_group.status();
   }
-  bssl::UniquePtr<EC_GROUP> priv_group(status_or_ec_group.ValueOrDie());
-  bssl::UniquePtr<EC_POINT> shared_point(EC_POINT_new(priv_group.get()));
+  const EC_GROUP *priv_group = status_or_ec_group.ValueOrDie();
+  bssl::UniquePtr<EC_POINT> shared_point(EC_POINT_new(priv_group));
   // BoringSSL's EC_POINT_set_affine_coordinates_GFp documentation says that
   // "unlike with OpenSSL, it's considered an error if the point is not on the
   // curve". To be sure, we double check here.
-  if (1 != EC_POINT_is_on_curve(priv_group.get(), pub_key, nullptr)) {
+  if (1 != EC_POINT_is_on_curve(priv_group, pub_key, nullptr)) {
     return util::Status(util::error::INTERNAL, "Point is not on curve");
   }
   // Compute the shared point.
-  if (1 != EC_POINT_mul(priv_group.get(), shared_point.get(), nullptr, pub_key,
+  if (1 != EC_POINT_mul(priv_group, shared_point.get(), nullptr, pub_key,
                         priv_key, nullptr)) {
     return util::Status(util::error::INTERNAL, "Point multiplication failed");
   }
   // Check for buggy computation.
   if (1 !=
-      EC_POINT_is_on_curve(priv_group.get(), shared_point.get(), nullptr)) {
+      EC_POINT_is_on_curve(priv_group, shared_point.get(), nullptr)) {
     return util::Status(util::error::INTERNAL, "Shared point is not on curve");
   }
   // Get shared point's x coordinate.
   bssl::UniquePtr<BIGNUM> shared_x(BN_new());
   if (1 !=
-      EC_POINT_get_affine_coordinates_GFp(priv_group.get(), shared_point.get(),
+      EC_POINT_get_affine_coordinates_GFp(priv_group, shared_point.get(),
                                           shared_x.get(), nullptr, nullptr)) {
     return util::Status(util::error::INTERNAL,
                         "EC_POINT_get_affine_coordinates_GFp failed");
   }
   return BignumToSecretData(shared_x.get(),
-                            FieldElementSizeInBytes(priv_group.get()));
+                            FieldElementSizeInBytes(priv_group));
 }
 
 // static
 util::StatusOr<bssl::UniquePtr<EC_POINT>> SubtleUtilBoringSSL::EcPointDecode(
     EllipticCurveType curve, EcPointFormat format, absl::string_view encoded) {
-  auto status_or_ec_group = GetEcGroup(curve);
+  auto status_or_ec_group = GetSharedEcGroup(curve);
   if (!status_or_ec_group.ok()) {
     return status_or_ec_group.status();
   }
-  bssl::UniquePtr<EC_GROUP> group(status_or_ec_group.ValueOrDie());
-  bssl::UniquePtr<EC_POINT> point(EC_POINT_new(group.get()));
-  unsigned curve_size_in_bytes = (EC_GROUP_get_degree(group.get()) + 7) / 8;
+  const EC_GROUP *group = status_or_ec_group.ValueOrDie();
+  bssl::UniquePtr<EC_POINT> point(EC_POINT_new(group));
+  unsigned curve_size_in_bytes = (EC_GROUP_get_degree(group) + 7) / 8;
   switch (format) {
     case EcPointFormat::UNCOMPRESSED: {
       if (static_cast<int>(encoded[0]) != 0x04) {
@@ -335,7 +369,7 @@ util::StatusOr<bssl::UniquePtr<EC_POINT>> SubtleUtilBoringSSL::EcPointDecode(
                              encoded.size(), 1 + 2 * curve_size_in_bytes));
       }
       if (1 !=
-          EC_POINT_oct2point(group.get(), point.get(),
+          EC_POINT_oct2point(group, point.get(),
                              reinterpret_cast<const uint8_t *>(encoded.data()),
                              encoded.size(), nullptr)) {
         return util::Status(util::error::INTERNAL, "EC_POINT_toc2point failed");
@@ -368,7 +402,7 @@ util::StatusOr<bssl::UniquePtr<EC_POINT>> SubtleUtilBoringSSL::EcPointDecode(
         return util::Status(util::error::INTERNAL,
                             "Openssl internal error extracting y coordinate");
       }
-      if (1 != EC_POINT_set_affine_coordinates_GFp(group.get(), point.get(),
+      if (1 != EC_POINT_set_affine_coordinates_GFp(group, point.get(),
                                                    x.get(), y.get(), nullptr)) {
         return util::Status(util::error::INTERNAL,
                             "Openssl internal error setting coordinates");
@@ -383,7 +417,7 @@ util::StatusOr<bssl::UniquePtr<EC_POINT>> SubtleUtilBoringSSL::EcPointDecode(
                             "0x03, but input doesn't");
       }
       if (1 !=
-          EC_POINT_oct2point(group.get(), point.get(),
+          EC_POINT_oct2point(group, point.get(),
                              reinterpret_cast<const uint8_t *>(encoded.data()),
                              encoded.size(), nullptr)) {
         return util::Status(util::error::INTERNAL, "EC_POINT_oct2point failed");
@@ -393,7 +427,7 @@ util::StatusOr<bssl::UniquePtr<EC_POINT>> SubtleUtilBoringSSL::EcPointDecode(
     default:
       return util::Status(util::error::INTERNAL, "Unsupported format");
   }
-  if (1 != EC_POINT_is_on_curve(group.get(), point.get(), nullptr)) {
+  if (1 != EC_POINT_is_on_curve(group, point.get(), nullptr)) {
     return util::Status(util::error::INTERNAL, "Point is not on curve");
   }
   return {std::move(point)};
@@ -402,13 +436,13 @@ util::StatusOr<bssl::UniquePtr<EC_POINT>> SubtleUtilBoringSSL::EcPointDecode(
 // static
 util::StatusOr<std::string> SubtleUtilBoringSSL::EcPointEncode(
     EllipticCurveType curve, EcPointFormat format, const EC_POINT *point) {
-  auto status_or_ec_group = GetEcGroup(curve);
+  auto status_or_ec_group = GetSharedEcGroup(curve);
   if (!status_or_ec_group.ok()) {
     return status_or_ec_group.status();
   }
-  bssl::UniquePtr<EC_GROUP> group(status_or_ec_group.ValueOrDie());
-  unsigned curve_size_in_bytes = (EC_GROUP_get_degree(group.get()) + 7) / 8;
-  if (1 != EC_POINT_is_on_curve(group.get(), point, nullptr)) {
+  const EC_GROUP *group = status_or_ec_group.ValueOrDie();
+  unsigned curve_size_in_bytes = (EC_GROUP_get_degree(group) + 7) / 8;
+  if (1 != EC_POINT_is_on_curve(group, point, nullptr)) {
     return util::Status(util::error::INTERNAL, "Point is not on curve");
   }
   switch (format) {
@@ -416,7 +450,7 @@ util::StatusOr<std::string> SubtleUtilBoringSSL::EcPointEncode(
       std::unique_ptr<uint8_t[]> encoded(
           new uint8_t[1 + 2 * curve_size_in_bytes]);
       size_t size = EC_POINT_point2oct(
-          group.get(), point, POINT_CONVERSION_UNCOMPRESSED, encoded.get(),
+          group, point, POINT_CONVERSION_UNCOMPRESSED, encoded.get(),
           1 + 2 * curve_size_in_bytes, nullptr);
       if (size != 1 + 2 * curve_size_in_bytes) {
         return util::Status(util::error::INTERNAL, "EC_POINT_point2oct failed");
@@ -434,7 +468,7 @@ util::StatusOr<std::string> SubtleUtilBoringSSL::EcPointEncode(
       }
       std::unique_ptr<uint8_t[]> encoded(new uint8_t[2 * curve_size_in_bytes]);
 
-      if (1 != EC_POINT_get_affine_coordinates_GFp(group.get(), point, x.get(),
+      if (1 != EC_POINT_get_affine_coordinates_GFp(group, point, x.get(),
                                                    y.get(), nullptr)) {
         return util::Status(util::error::INTERNAL,
                             "Openssl internal error getting coordinates");
@@ -456,7 +490,7 @@ util::StatusOr<std::string> SubtleUtilBoringSSL::EcPointEncode(
     case EcPointFormat::COMPRESSED: {
       std::unique_ptr<uint8_t[]> encoded(new uint8_t[1 + curve_size_in_bytes]);
       size_t size = EC_POINT_point2oct(
-          group.get(), point, POINT_CONVERSION_COMPRESSED, encoded.get(),
+          group, point, POINT_CONVERSION_COMPRESSED, encoded.get(),
           1 + curve_size_in_bytes, nullptr);
       if (size != 1 + curve_size_in_bytes) {
         return util::Status(util::error::INTERNAL, "EC_POINT_point2oct failed");
@@ -600,11 +634,17 @@ util::Status SubtleUtilBoringSSL::GetNewRsaKeyPair(
   if (BN_copy(e_copy.get(), e) == nullptr) {
     return util::Status(util::error::INTERNAL, GetErrors());
   }
-  if (RSA_generate_key_ex(rsa.get(), modulus_size_in_bits, e_copy.get(),
-                          /*cb=*/nullptr) != 1) {
-    return util::Status(
-        util::error::INTERNAL,
-        absl::StrCat("Error generating private key: ", GetErrors()));
+  {
+    internal::TracedOperation operation("tink.rsa.generate_key_pair");
+    operation.SetAttribute("tink.modulus_bits", modulus_size_in_bits);
+    if (RSA_generate_key_ex(rsa.get(), modulus_size_in_bits, e_copy.get(),
+                            /*cb=*/nullptr) != 1) {
+      util::Status status(
+          util::error::INTERNAL,
+          absl::StrCat("Error generating private key: ", GetErrors()));
+      operation.SetStatus(status);
+      return status;
+    }
   }
 
   const BIGNUM *n_bn, *e_bn, *d_bn;
@@ -131,6 +131,12 @@ class SubtleUtilBoringSSL {
   static crypto::tink::util::StatusOr<EC_GROUP *> GetEcGroup(
       EllipticCurveType curve_type);
 
+  // Returns a process-wide EC_GROUP for the curve type.  The group is owned
+  // by Tink, must not be freed or modified, and may be used concurrently.
+  // Prefer this over GetEcGroup() when the group is only read.
+  static crypto::tink::util::StatusOr<const EC_GROUP *> GetSharedEcGroup(
+      EllipticCurveType curve_type);
+
   // Returns BoringSSL's EC_POINT constructed from the curve type, big-endian
   // representation of public key's x-coordinate and y-coordinate.
   static crypto::tink::util::StatusOr<EC_POINT *> GetEcPoint(
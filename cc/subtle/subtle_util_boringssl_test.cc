@@ -141,6 +141,29 @@ TEST(SubtleUtilBoringSSLTest, EcPointDecode) {
   }
 }
 
+TEST(SubtleUtilBoringSSLTest, GetSharedEcGroup) {
+  for (EllipticCurveType curve :
+       {EllipticCurveType::NIST_P256, EllipticCurveType::NIST_P384,
+        EllipticCurveType::NIST_P521}) {
+    auto shared_group_or = SubtleUtilBoringSSL::GetSharedEcGroup(curve);
+    ASSERT_THAT(shared_group_or.status(), IsOk());
+    const EC_GROUP* shared_group = shared_group_or.ValueOrDie();
+    ASSERT_THAT(shared_group, NotNull());
+    // The same instance is returned every time.
+    EXPECT_EQ(shared_group,
+              SubtleUtilBoringSSL::GetSharedEcGroup(curve).ValueOrDie());
+
+    auto group_or = SubtleUtilBoringSSL::GetEcGroup(curve);
+    ASSERT_THAT(group_or.status(), IsOk());
+    bssl::UniquePtr<EC_GROUP> group(group_or.ValueOrDie());
+    EXPECT_EQ(0, EC_GROUP_cmp(shared_group, group.get(), nullptr));
+  }
+  EXPECT_THAT(
+      SubtleUtilBoringSSL::GetSharedEcGroup(EllipticCurveType::CURVE25519)
+          .status(),
+      StatusIs(util::error::UNIMPLEMENTED));
+}
+
 TEST(SubtleUtilBoringSSLTest, Bn2strAndStr2bn) {
   int len = 8;
   std::string bn_str[6] = {"0000000000000000", "0000000000000001",
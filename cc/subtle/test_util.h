@@ -17,6 +17,7 @@
 #ifndef TINK_SUBTLE_TEST_UTIL_H_
 #define TINK_SUBTLE_TEST_UTIL_H_
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -104,15 +105,26 @@ class DummyStreamSegmentEncrypter : public StreamSegmentEncrypter {
       const std::vector<uint8_t>& plaintext,
       bool is_last_segment,
       std::vector<uint8_t>* ciphertext_buffer) override {
+    util::Status status = EncryptSegmentAt(segment_number_, plaintext,
+                                           is_last_segment, ciphertext_buffer);
+    if (!status.ok()) return status;
+    IncSegmentNumber();
+    return util::Status::OK;
+  }
+
+  util::Status EncryptSegmentAt(
+      int64_t segment_number,
+      const std::vector<uint8_t>& plaintext,
+      bool is_last_segment,
+      std::vector<uint8_t>* ciphertext_buffer) const override {
     ciphertext_buffer->resize(plaintext.size() + kSegmentTagSize);
     memcpy(ciphertext_buffer->data(), plaintext.data(), plaintext.size());
     memcpy(ciphertext_buffer->data() + plaintext.size(),
-           &segment_number_, sizeof(segment_number_));
+           &segment_number, sizeof(segment_number));
     // The last byte of the a ciphertext segment.
     ciphertext_buffer->back() =
         is_last_segment ? kLastSegment : kNotLastSegment;
     generated_output_size_ += ciphertext_buffer->size();
-    IncSegmentNumber();
     return util::Status::OK;
   }
 
@@ -152,7 +164,7 @@ class DummyStreamSegmentEncrypter : public StreamSegmentEncrypter {
   int pt_segment_size_;
   int ct_offset_;
   int64_t segment_number_;
-  int64_t generated_output_size_;
+  mutable std::atomic<int64_t> generated_output_size_;
 };   // class DummyStreamSegmentEncrypter
 
 // A dummy decrypter that "decrypts" segments encrypted by
@@ -235,7 +247,8 @@ class DummyStreamSegmentDecrypter : public StreamSegmentDecrypter {
   std::vector<uint8_t> header_;
   int pt_segment_size_;
   int ct_offset_;
-  int64_t generated_output_size_;
+  // Atomic, as pipelined streams decrypt segments concurrently.
+  std::atomic<int64_t> generated_output_size_;
 };   // class DummyStreamSegmentDecrypter
 
 class DummyStreamingAead : public NonceBasedStreamingAead {
@@ -252,6 +265,16 @@ class DummyStreamingAead : public NonceBasedStreamingAead {
         pt_segment_size_, header_size_, ct_offset_)};
   }
 
+  util::StatusOr<std::unique_ptr<StreamSegmentEncrypter>>
+  NewSegmentEncrypterForHeader(
+      absl::string_view header,
+      absl::string_view associated_data) const override {
+    if (header != std::string(header_size_, 'h')) {
+      return util::Status(util::error::INVALID_ARGUMENT, "invalid header");
+    }
+    return NewSegmentEncrypter(associated_data);
+  }
+
   util::StatusOr<std::unique_ptr<StreamSegmentDecrypter>> NewSegmentDecrypter(
       absl::string_view associated_data) const override {
     return {absl::make_unique<DummyStreamSegmentDecrypter>(
@@ -16,6 +16,7 @@
 
 #include "tink/subtle/xchacha20_poly1305_boringssl.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -54,61 +55,129 @@ util::StatusOr<std::unique_ptr<Aead>> XChacha20Poly1305BoringSsl::New(
   if (cipher == nullptr) {
     return util::Status(util::error::INTERNAL, "Failed to get EVP_AEAD");
   }
-  return std::unique_ptr<Aead>(
-      new XChacha20Poly1305BoringSsl(std::move(key), cipher));
+  bssl::UniquePtr<EVP_AEAD_CTX> ctx(
+      EVP_AEAD_CTX_new(cipher, reinterpret_cast<const uint8_t*>(key.data()),
+                       key.size(), kTagSize));
+  if (ctx == nullptr) {
+    return util::Status(util::error::INTERNAL,
+                        "could not initialize EVP_AEAD_CTX");
+  }
+  return std::unique_ptr<Aead>(new XChacha20Poly1305BoringSsl(std::move(ctx)));
 }
 
 util::StatusOr<std::string> XChacha20Poly1305BoringSsl::Encrypt(
     absl::string_view plaintext, absl::string_view additional_data) const {
-  bssl::UniquePtr<EVP_AEAD_CTX> ctx(
-      EVP_AEAD_CTX_new(aead_, reinterpret_cast<const uint8_t*>(key_.data()),
-                       key_.size(), kTagSize));
-  if (ctx.get() == nullptr) {
-    return util::Status(util::error::INTERNAL,
-                        "could not initialize EVP_AEAD_CTX");
+  std::string ct;
+  ResizeStringUninitialized(&ct, kNonceSize + plaintext.size() + kTagSize);
+  auto written_or =
+      EncryptInto(plaintext, additional_data, absl::MakeSpan(&ct[0], ct.size()));
+  if (!written_or.ok()) return written_or.status();
+  return ct;
+}
+
+util::StatusOr<std::string> XChacha20Poly1305BoringSsl::Decrypt(
+    absl::string_view ciphertext, absl::string_view additional_data) const {
+  if (ciphertext.size() < kNonceSize + kTagSize) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+
+  std::string out;
+  ResizeStringUninitialized(&out, ciphertext.size() - kNonceSize - kTagSize);
+  auto written_or = DecryptInto(ciphertext, additional_data,
+                                absl::MakeSpan(&out[0], out.size()));
+  if (!written_or.ok()) return written_or.status();
+  return out;
+}
+
+util::StatusOr<int64_t> XChacha20Poly1305BoringSsl::CiphertextSize(
+    int64_t plaintext_size) const {
+  if (plaintext_size < 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Plaintext size must be non-negative");
   }
+  return kNonceSize + plaintext_size + kTagSize;
+}
 
+util::StatusOr<int64_t> XChacha20Poly1305BoringSsl::EncryptInto(
+    absl::string_view plaintext, absl::string_view additional_data,
+    absl::Span<char> ciphertext_buffer) const {
   // BoringSSL expects a non-null pointer for plaintext and additional_data,
   // regardless of whether the size is 0.
   plaintext = SubtleUtilBoringSSL::EnsureNonNull(plaintext);
   additional_data = SubtleUtilBoringSSL::EnsureNonNull(additional_data);
 
-  const std::string nonce = Random::GetRandomBytes(kNonceSize);
-  if (nonce.size() != kNonceSize) {
-    return util::Status(util::error::INTERNAL,
-                        "Failed to get enough random bytes for nonce");
+  size_t ciphertext_size = kNonceSize + plaintext.size() + kTagSize;
+  if (ciphertext_buffer.size() < ciphertext_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Ciphertext buffer too small");
   }
 
-  size_t ciphertext_size = nonce.size() + plaintext.size() + kTagSize;
-
   // Write the nonce in the output buffer.
-  std::string ct = nonce;
-  ResizeStringUninitialized(&ct, ciphertext_size);
-  size_t written = nonce.size();
+  auto status =
+      Random::GetRandomBytes(ciphertext_buffer.subspan(0, kNonceSize));
+  if (!status.ok()) return status;
+  status = SealWithNonceInBuffer(plaintext, additional_data,
+                                 ciphertext_buffer.subspan(0, ciphertext_size));
+  if (!status.ok()) return status;
+  return ciphertext_size;
+}
+
+util::Status XChacha20Poly1305BoringSsl::EncryptBatchInto(
+    absl::Span<const absl::string_view> plaintexts,
+    absl::Span<const absl::string_view> additional_data,
+    absl::Span<const absl::Span<char>> ciphertext_buffers) const {
+  if (plaintexts.size() != additional_data.size() ||
+      plaintexts.size() != ciphertext_buffers.size()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Batch sizes do not match");
+  }
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    if (ciphertext_buffers[i].size() <
+        kNonceSize + plaintexts[i].size() + kTagSize) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Ciphertext buffer too small");
+    }
+  }
+  std::string nonces;
+  ResizeStringUninitialized(&nonces, plaintexts.size() * kNonceSize);
+  auto status =
+      Random::GetRandomBytes(absl::MakeSpan(&nonces[0], nonces.size()));
+  if (!status.ok()) return status;
+  for (size_t i = 0; i < plaintexts.size(); i++) {
+    std::copy_n(&nonces[i * kNonceSize], kNonceSize,
+                ciphertext_buffers[i].data());
+    status = SealWithNonceInBuffer(
+        SubtleUtilBoringSSL::EnsureNonNull(plaintexts[i]),
+        SubtleUtilBoringSSL::EnsureNonNull(additional_data[i]),
+        ciphertext_buffers[i]);
+    if (!status.ok()) return status;
+  }
+  return util::Status::OK;
+}
 
-  // Encrypt the plaintext and store it after the nonce.
+util::Status XChacha20Poly1305BoringSsl::SealWithNonceInBuffer(
+    absl::string_view plaintext, absl::string_view additional_data,
+    absl::Span<char> ciphertext_buffer) const {
+  uint8_t* nonce = reinterpret_cast<uint8_t*>(ciphertext_buffer.data());
   size_t out_len = 0;
-  int ret = EVP_AEAD_CTX_seal(
-      ctx.get(), reinterpret_cast<uint8_t*>(&ct[written]), &out_len,
-      ciphertext_size - written, reinterpret_cast<const uint8_t*>(nonce.data()),
-      nonce.size(), reinterpret_cast<const uint8_t*>(plaintext.data()),
-      plaintext.size(),
-      reinterpret_cast<const uint8_t*>(additional_data.data()),
-      additional_data.size());
-  if (ret != 1) {
+  if (EVP_AEAD_CTX_seal(
+          ctx_.get(), nonce + kNonceSize, &out_len,
+          ciphertext_buffer.size() - kNonceSize, nonce, kNonceSize,
+          reinterpret_cast<const uint8_t*>(plaintext.data()), plaintext.size(),
+          reinterpret_cast<const uint8_t*>(additional_data.data()),
+          additional_data.size()) != 1) {
     return util::Status(util::error::INTERNAL, "EVP_AEAD_CTX_seal failed");
   }
-  written += out_len;
-
   // Verify that all the expected data has been written.
-  if (written != ciphertext_size) {
+  if (out_len != plaintext.size() + kTagSize) {
     return util::Status(util::error::INTERNAL, "Incorrect ciphertext size");
   }
-  return ct;
+  return util::Status::OK;
 }
 
-util::StatusOr<std::string> XChacha20Poly1305BoringSsl::Decrypt(
-    absl::string_view ciphertext, absl::string_view additional_data) const {
+util::StatusOr<int64_t> XChacha20Poly1305BoringSsl::DecryptInto(
+    absl::string_view ciphertext, absl::string_view additional_data,
+    absl::Span<char> plaintext_buffer) const {
   // BoringSSL expects a non-null pointer for additional_data,
   // regardless of whether the size is 0.
   additional_data = SubtleUtilBoringSSL::EnsureNonNull(additional_data);
@@ -116,18 +185,11 @@ util::StatusOr<std::string> XChacha20Poly1305BoringSsl::Decrypt(
   if (ciphertext.size() < kNonceSize + kTagSize) {
     return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
   }
-
-  bssl::UniquePtr<EVP_AEAD_CTX> ctx(
-      EVP_AEAD_CTX_new(aead_, reinterpret_cast<const uint8_t*>(key_.data()),
-                       key_.size(), kTagSize));
-  if (ctx.get() == nullptr) {
-    return util::Status(util::error::INTERNAL,
-                        "could not initialize EVP_AEAD_CTX");
-  }
-
-  std::string out;
   size_t out_size = ciphertext.size() - kNonceSize - kTagSize;
-  ResizeStringUninitialized(&out, out_size);
+  if (plaintext_buffer.size() < out_size) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Plaintext buffer too small");
+  }
 
   absl::string_view nonce = ciphertext.substr(0, kNonceSize);
   absl::string_view encrypted =
@@ -135,8 +197,8 @@ util::StatusOr<std::string> XChacha20Poly1305BoringSsl::Decrypt(
 
   size_t len = 0;
   int ret = EVP_AEAD_CTX_open(
-      ctx.get(), reinterpret_cast<uint8_t*>(&out[0]), &len, out_size,
-      reinterpret_cast<const uint8_t*>(nonce.data()), nonce.size(),
+      ctx_.get(), reinterpret_cast<uint8_t*>(plaintext_buffer.data()), &len,
+      out_size, reinterpret_cast<const uint8_t*>(nonce.data()), nonce.size(),
       reinterpret_cast<const uint8_t*>(encrypted.data()), encrypted.size(),
       reinterpret_cast<const uint8_t*>(additional_data.data()),
       additional_data.size());
@@ -148,7 +210,7 @@ util::StatusOr<std::string> XChacha20Poly1305BoringSsl::Decrypt(
     return util::Status(util::error::INTERNAL, "Incorrect output size");
   }
 
-  return out;
+  return len;
 }
 
 }  // namespace subtle
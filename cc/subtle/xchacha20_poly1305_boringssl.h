@@ -21,9 +21,12 @@
 #include <utility>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "openssl/base.h"
+#include "openssl/aead.h"
 #include "tink/aead.h"
 #include "tink/config/tink_fips.h"
+#include "tink/space_used.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -32,7 +35,7 @@ namespace crypto {
 namespace tink {
 namespace subtle {
 
-class XChacha20Poly1305BoringSsl : public Aead {
+class XChacha20Poly1305BoringSsl : public Aead, public SpaceUsedInterface {
  public:
   // Constructs a new Aead cipher for XChacha20-Poly1305.
   // Currently supported key size is 256 bits.
@@ -49,6 +52,28 @@ class XChacha20Poly1305BoringSsl : public Aead {
       absl::string_view ciphertext,
       absl::string_view additional_data) const override;
 
+  crypto::tink::util::StatusOr<int64_t> CiphertextSize(
+      int64_t plaintext_size) const override;
+
+  crypto::tink::util::StatusOr<int64_t> EncryptInto(
+      absl::string_view plaintext, absl::string_view additional_data,
+      absl::Span<char> ciphertext_buffer) const override;
+
+  crypto::tink::util::StatusOr<int64_t> DecryptInto(
+      absl::string_view ciphertext, absl::string_view additional_data,
+      absl::Span<char> plaintext_buffer) const override;
+
+  // Draws the nonces for the whole batch with a single call to the random
+  // number generator.
+  crypto::tink::util::Status EncryptBatchInto(
+      absl::Span<const absl::string_view> plaintexts,
+      absl::Span<const absl::string_view> additional_data,
+      absl::Span<const absl::Span<char>> ciphertext_buffers) const override;
+
+  size_t SpaceUsed() const override {
+    return sizeof(*this) + sizeof(EVP_AEAD_CTX);
+  }
+
   static constexpr crypto::tink::FipsCompatibility kFipsStatus =
       crypto::tink::FipsCompatibility::kNotFips;
 
@@ -57,11 +82,18 @@ class XChacha20Poly1305BoringSsl : public Aead {
   static constexpr int kNonceSize = 24;
   static constexpr int kTagSize = 16;
 
-  XChacha20Poly1305BoringSsl(util::SecretData key, const EVP_AEAD* aead)
-      : key_(std::move(key)), aead_(aead) {}
+  explicit XChacha20Poly1305BoringSsl(bssl::UniquePtr<EVP_AEAD_CTX> ctx)
+      : ctx_(std::move(ctx)) {}
+
+  // Encrypts 'plaintext' into 'ciphertext_buffer', whose first kNonceSize
+  // bytes already hold the nonce.
+  crypto::tink::util::Status SealWithNonceInBuffer(
+      absl::string_view plaintext, absl::string_view additional_data,
+      absl::Span<char> ciphertext_buffer) const;
 
-  const util::SecretData key_;
-  const EVP_AEAD* const aead_;
+  // Set up once per key; sealing and opening do not modify it, so it is
+  // shared by concurrent calls.
+  bssl::UniquePtr<EVP_AEAD_CTX> ctx_;
 };
 
 }  // namespace subtle
@@ -19,6 +19,7 @@
 #include <string>
 #include <vector>
 
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/strings/str_cat.h"
 #include "openssl/err.h"
@@ -32,6 +33,7 @@ namespace tink {
 namespace subtle {
 namespace {
 
+using ::crypto::tink::test::IsOk;
 using ::crypto::tink::test::StatusIs;
 
 TEST(XChacha20Poly1305BoringSslTest, TestBasic) {
@@ -55,6 +57,87 @@ TEST(XChacha20Poly1305BoringSslTest, TestBasic) {
   EXPECT_EQ(pt.ValueOrDie(), message);
 }
 
+TEST(XChacha20Poly1305BoringSslTest, EncryptIntoDecryptInto) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+  util::SecretData key =
+      util::SecretDataFromStringView(test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f000102030405060708090a0b0c0d0e0f"));
+  auto cipher_or = XChacha20Poly1305BoringSsl::New(key);
+  ASSERT_TRUE(cipher_or.ok()) << cipher_or.status();
+  auto cipher = std::move(cipher_or.ValueOrDie());
+  std::string message = "Some data to encrypt.";
+  std::string aad = "Some data to authenticate.";
+
+  auto ciphertext_size_or = cipher->CiphertextSize(message.size());
+  ASSERT_TRUE(ciphertext_size_or.ok()) << ciphertext_size_or.status();
+  EXPECT_EQ(ciphertext_size_or.ValueOrDie(), message.size() + 24 + 16);
+  std::string ciphertext(ciphertext_size_or.ValueOrDie(), '\0');
+  auto written_or = cipher->EncryptInto(
+      message, aad, absl::MakeSpan(&ciphertext[0], ciphertext.size()));
+  ASSERT_TRUE(written_or.ok()) << written_or.status();
+  EXPECT_EQ(written_or.ValueOrDie(), ciphertext.size());
+
+  // Both decryption entry points accept the ciphertext.
+  auto pt = cipher->Decrypt(ciphertext, aad);
+  ASSERT_TRUE(pt.ok()) << pt.status();
+  EXPECT_EQ(pt.ValueOrDie(), message);
+  std::string plaintext(message.size(), '\0');
+  written_or = cipher->DecryptInto(
+      ciphertext, aad, absl::MakeSpan(&plaintext[0], plaintext.size()));
+  ASSERT_TRUE(written_or.ok()) << written_or.status();
+  EXPECT_EQ(written_or.ValueOrDie(), message.size());
+  EXPECT_EQ(plaintext, message);
+
+  // Buffers that are too small are rejected.
+  EXPECT_THAT(cipher
+                  ->EncryptInto(message, aad,
+                                absl::MakeSpan(&ciphertext[0],
+                                               ciphertext.size() - 1))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(cipher
+                  ->DecryptInto(ciphertext, aad,
+                                absl::MakeSpan(&plaintext[0],
+                                               plaintext.size() - 1))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(XChacha20Poly1305BoringSslTest, EncryptBatch) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  util::SecretData key = util::SecretDataFromStringView(test::HexDecodeOrDie(
+      "000102030405060708090a0b0c0d0e0f000102030405060708090a0b0c0d0e0f"));
+  auto cipher = std::move(XChacha20Poly1305BoringSsl::New(key).ValueOrDie());
+  std::vector<absl::string_view> messages = {"first", "", "third message"};
+  std::vector<absl::string_view> aads = {"aad", "", "other aad"};
+
+  std::string arena;
+  std::vector<absl::string_view> ciphertexts;
+  ASSERT_THAT(cipher->EncryptBatch(messages, aads, &arena, &ciphertexts),
+              IsOk());
+  ASSERT_EQ(ciphertexts.size(), messages.size());
+  for (int i = 0; i < messages.size(); i++) {
+    EXPECT_EQ(ciphertexts[i].size(), messages[i].size() + 24 + 16);
+    auto pt = cipher->Decrypt(ciphertexts[i], aads[i]);
+    ASSERT_THAT(pt.status(), IsOk());
+    EXPECT_EQ(pt.ValueOrDie(), messages[i]);
+  }
+  // Every message gets a fresh nonce.
+  EXPECT_NE(ciphertexts[0].substr(0, 24), ciphertexts[1].substr(0, 24));
+  EXPECT_NE(ciphertexts[1].substr(0, 24), ciphertexts[2].substr(0, 24));
+
+  std::string plaintext_arena;
+  std::vector<absl::string_view> plaintexts;
+  ASSERT_THAT(
+      cipher->DecryptBatch(ciphertexts, aads, &plaintext_arena, &plaintexts),
+      IsOk());
+  EXPECT_EQ(plaintexts, messages);
+}
+
 TEST(XChacha20Poly1305BoringSslTest, TestModification) {
   if (kUseOnlyFips) {
     GTEST_SKIP() << "Not supported in FIPS-only mode";
@@ -0,0 +1,37 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_THREAD_POOL_EXECUTOR_H_
+#define TINK_THREAD_POOL_EXECUTOR_H_
+
+#include <memory>
+
+#include "tink/executor.h"
+
+namespace crypto {
+namespace tink {
+
+// Returns the default Executor: a pool of 'num_threads' worker threads with
+// a queue of tasks per worker, where idle workers steal the tasks of busy
+// ones.  With 'num_threads' = 0 all tasks run on the calling threads.
+// Destroying the executor runs the tasks scheduled so far, then joins the
+// worker threads.
+std::unique_ptr<Executor> NewThreadPoolExecutor(int num_threads);
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_THREAD_POOL_EXECUTOR_H_
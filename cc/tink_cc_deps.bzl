@@ -37,6 +37,16 @@ def tink_cc_deps():
             sha256 = "54a139559cc46a68cf79e55d5c22dc9d48e647a66827342520ce0441402430fe",
         )
 
+    # Google Benchmark. Used by the microbenchmarks in benchmarks/.
+    if not native.existing_rule("com_github_google_benchmark"):
+        # Release from 2020-09-11
+        http_archive(
+            name = "com_github_google_benchmark",
+            strip_prefix = "benchmark-1.5.2",
+            url = "https://github.com/google/benchmark/archive/v1.5.2.tar.gz",
+            sha256 = "dccbdab796baa1043f04982147e67bb6e118fe610da2c65f88912d73987e700c",
+        )
+
     if not native.existing_rule("rapidjson"):
         # Release from 2016-08-25; still the latest release on 2019-10-18
         http_archive(
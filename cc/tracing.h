@@ -0,0 +1,81 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_TRACING_H_
+#define TINK_TRACING_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+
+///////////////////////////////////////////////////////////////////////////////
+// A span of one expensive operation, e.g. a KMS call, a keyset load or the
+// decryption of a segment of a stream.  The spans map directly onto the
+// spans of OpenTelemetry, so that a Tracer can forward them to its tracing
+// library in a few lines.
+//
+// The attribute keys are string literals following the OpenTelemetry naming
+// conventions, e.g. "tink.type_url", "tink.key_id", "tink.bytes" or
+// "tink.segment_number".  No attribute ever holds key material, plaintext or
+// ciphertext.
+class TraceSpan {
+ public:
+  virtual void SetAttribute(absl::string_view key, absl::string_view value) = 0;
+  virtual void SetAttribute(absl::string_view key, int64_t value) = 0;
+
+  // Called once the operation finished, with its status.  Called at most
+  // once, and no other method is called afterwards.
+  virtual void End(const crypto::tink::util::Status& status) = 0;
+
+  virtual ~TraceSpan() {}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Starts the spans of Tink once registered with RegisterTracer().
+// StartSpan() is called on the thread which starts the operation, so the
+// span can be made a child of the current span of that thread; the span
+// may however end on another thread, e.g. for asynchronous KMS calls.
+// Implementations must be thread safe.
+class Tracer {
+ public:
+  // Starts the span of the operation 'name', e.g.
+  // "tink.kms_envelope_aead.decrypt".  'name' is a string literal.  Returns
+  // nullptr to skip the operation.
+  virtual std::unique_ptr<TraceSpan> StartSpan(absl::string_view name) = 0;
+
+  virtual ~Tracer() {}
+};
+
+// Registers 'tracer' to start the spans of all traced operations.  Only one
+// tracer can be registered, and only once; later calls fail with
+// ALREADY_EXISTS.  The tracer is never destroyed.
+//
+// Without a registered tracer the traced operations only check for one, so
+// tracing costs nothing unless it is used.
+crypto::tink::util::Status RegisterTracer(std::unique_ptr<Tracer> tracer);
+
+// Returns the registered tracer, or nullptr if there is none.
+Tracer* GetTracer();
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_TRACING_H_
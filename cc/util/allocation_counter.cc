@@ -0,0 +1,51 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/allocation_counter.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace crypto {
+namespace tink {
+namespace test {
+namespace {
+
+// Constant-initialized, so that operator new can use it at any time,
+// including during static initialization.
+thread_local int64_t thread_allocation_count = 0;
+
+}  // namespace
+
+int64_t ThreadAllocationCount() { return thread_allocation_count; }
+
+}  // namespace test
+}  // namespace tink
+}  // namespace crypto
+
+// Counting replacements of the global allocation functions.  The array and
+// nothrow forms default to these, so every allocation is counted once.
+void* operator new(size_t size) {
+  ++crypto::tink::test::thread_allocation_count;
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t size) noexcept { std::free(ptr); }
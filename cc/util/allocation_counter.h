@@ -0,0 +1,63 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_ALLOCATION_COUNTER_H_
+#define TINK_UTIL_ALLOCATION_COUNTER_H_
+
+#include <cstdint>
+
+namespace crypto {
+namespace tink {
+namespace test {
+
+// Returns the number of calls to the global operator new (in all its forms)
+// made by the current thread so far.
+//
+// Linking the allocation_counter library replaces the global operator new
+// and operator delete of the binary with counting versions based on malloc
+// and free, so it is only meant for tests and benchmarks. Allocations made
+// by C libraries such as BoringSSL through malloc are not counted.
+int64_t ThreadAllocationCount();
+
+// Counts the calls to operator new made by the current thread during the
+// lifetime of the counter, so that tests can assert the allocation budget
+// of an operation:
+//
+//   AllocationCounter counter;
+//   ASSERT_THAT(aead.EncryptInto(plaintext, associated_data, buffer), IsOk());
+//   EXPECT_EQ(counter.count(), 0);
+class AllocationCounter {
+ public:
+  AllocationCounter() : start_(ThreadAllocationCount()) {}
+
+  AllocationCounter(const AllocationCounter&) = delete;
+  AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+  // Returns the number of allocations since construction or the last
+  // Reset().
+  int64_t count() const { return ThreadAllocationCount() - start_; }
+
+  void Reset() { start_ = ThreadAllocationCount(); }
+
+ private:
+  int64_t start_;
+};
+
+}  // namespace test
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_ALLOCATION_COUNTER_H_
@@ -0,0 +1,54 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/allocation_counter.h"
+
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace crypto {
+namespace tink {
+namespace test {
+namespace {
+
+TEST(AllocationCounterTest, CountsAllocations) {
+  AllocationCounter counter;
+  EXPECT_EQ(counter.count(), 0);
+  auto value = std::make_shared<int>(1);
+  EXPECT_EQ(counter.count(), 1);
+  std::vector<int> values(100);
+  std::string long_string(100, 'x');
+  EXPECT_EQ(counter.count(), 3);
+  counter.Reset();
+  EXPECT_EQ(counter.count(), 0);
+}
+
+TEST(AllocationCounterTest, IgnoresOtherThreads) {
+  AllocationCounter counter;
+  std::thread thread([] { std::vector<std::string> values(10, "x"); });
+  int64_t after_start = counter.count();
+  thread.join();
+  EXPECT_EQ(counter.count(), after_start);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace tink
+}  // namespace crypto
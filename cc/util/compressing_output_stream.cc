@@ -0,0 +1,171 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/util/compressing_output_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "zlib.h"
+#include "tink/output_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+namespace {
+
+// zlib takes input sizes as unsigned ints.
+constexpr size_t kMaxChunkSize = 1 << 30;
+
+}  // namespace
+
+StatusOr<std::unique_ptr<OutputStream>> CompressingOutputStream::New(
+    std::unique_ptr<OutputStream> output, int level, int buffer_size) {
+  if (output == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT, "output must be non-null");
+  }
+  if (buffer_size <= 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "buffer_size must be positive");
+  }
+  auto stream = absl::WrapUnique(
+      new CompressingOutputStream(std::move(output), buffer_size));
+  int result = deflateInit(&stream->zstream_, level);
+  if (result == Z_STREAM_ERROR) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("Invalid compression level ", level));
+  }
+  if (result != Z_OK) {
+    return Status(util::error::INTERNAL, "Failed to initialize compression");
+  }
+  stream->zstream_initialized_ = true;
+  return {std::move(stream)};
+}
+
+CompressingOutputStream::CompressingOutputStream(
+    std::unique_ptr<OutputStream> output, int buffer_size)
+    : output_(std::move(output)),
+      zstream_initialized_(false),
+      buffer_(absl::make_unique<uint8_t[]>(buffer_size)),
+      buffer_size_(buffer_size),
+      count_in_buffer_(0),
+      position_(0),
+      output_buffer_(nullptr),
+      output_available_(0) {
+  std::memset(&zstream_, 0, sizeof(zstream_));
+}
+
+CompressingOutputStream::~CompressingOutputStream() {
+  // Without Close() the compressed stream is left incomplete.
+  if (zstream_initialized_) deflateEnd(&zstream_);
+}
+
+Status CompressingOutputStream::Compress(absl::Span<const uint8_t> input,
+                                         int flush) {
+  if (input.empty() && flush == Z_NO_FLUSH) return util::OkStatus();
+  do {
+    size_t chunk_size = std::min(input.size(), kMaxChunkSize);
+    zstream_.next_in = const_cast<uint8_t*>(input.data());
+    zstream_.avail_in = chunk_size;
+    int chunk_flush = chunk_size == input.size() ? flush : Z_NO_FLUSH;
+    int result;
+    do {
+      if (output_available_ == 0) {
+        void* buffer;
+        auto next_result = output_->Next(&buffer);
+        if (!next_result.ok()) return next_result.status();
+        output_buffer_ = static_cast<uint8_t*>(buffer);
+        output_available_ = next_result.ValueOrDie();
+      }
+      zstream_.next_out = output_buffer_;
+      zstream_.avail_out = output_available_;
+      result = deflate(&zstream_, chunk_flush);
+      if (result == Z_STREAM_ERROR) {
+        return Status(util::error::INTERNAL, "Compression failed");
+      }
+      output_buffer_ = zstream_.next_out;
+      output_available_ = zstream_.avail_out;
+      // With space left in the output buffer deflate() has consumed all of
+      // the input, and with Z_FINISH has also written all of its output.
+    } while (output_available_ == 0 ||
+             (chunk_flush == Z_FINISH && result != Z_STREAM_END));
+    input.remove_prefix(chunk_size);
+  } while (!input.empty());
+  return util::OkStatus();
+}
+
+Status CompressingOutputStream::CompressBuffer() {
+  int count = count_in_buffer_;
+  count_in_buffer_ = 0;
+  if (count == 0) return util::OkStatus();
+  return Compress(absl::MakeConstSpan(buffer_.get(), count), Z_NO_FLUSH);
+}
+
+StatusOr<int> CompressingOutputStream::Next(void** data) {
+  if (!status_.ok()) return status_;
+  status_ = CompressBuffer();
+  if (!status_.ok()) return status_;
+  count_in_buffer_ = buffer_size_;
+  position_ += buffer_size_;
+  *data = buffer_.get();
+  return buffer_size_;
+}
+
+Status CompressingOutputStream::WriteFrom(absl::Span<const uint8_t> data) {
+  if (!status_.ok()) return status_;
+  status_ = CompressBuffer();
+  if (status_.ok()) status_ = Compress(data, Z_NO_FLUSH);
+  if (!status_.ok()) return status_;
+  position_ += data.size();
+  return util::OkStatus();
+}
+
+void CompressingOutputStream::BackUp(int count) {
+  if (!status_.ok() || count < 1) return;
+  int actual_count = std::min(count, count_in_buffer_);
+  count_in_buffer_ -= actual_count;
+  position_ -= actual_count;
+}
+
+Status CompressingOutputStream::Close() {
+  if (!status_.ok()) return status_;
+  status_ = CompressBuffer();
+  if (status_.ok()) status_ = Compress({}, Z_FINISH);
+  deflateEnd(&zstream_);
+  zstream_initialized_ = false;
+  if (!status_.ok()) return status_;
+  if (output_available_ > 0) output_->BackUp(output_available_);
+  status_ = output_->Close();
+  if (!status_.ok()) return status_;
+  status_ = Status(util::error::FAILED_PRECONDITION, "Stream closed");
+  return util::OkStatus();
+}
+
+int64_t CompressingOutputStream::Position() const { return position_; }
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,109 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_UTIL_COMPRESSING_OUTPUT_STREAM_H_
+#define TINK_UTIL_COMPRESSING_OUTPUT_STREAM_H_
+
+#include <memory>
+
+#include "absl/types/span.h"
+#include "zlib.h"
+#include "tink/output_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// An OutputStream that compresses the bytes written to it with deflate (in
+// the zlib format), and writes the compressed bytes to another
+// OutputStream.  It is a stage of a pipeline that compresses before
+// encrypting, in one pass:
+//
+//   auto encrypting_stream = streaming_aead.NewEncryptingStream(
+//       std::move(ciphertext_destination), associated_data);
+//   auto compressing_stream = CompressingOutputStream::New(
+//       std::move(encrypting_stream.ValueOrDie()));
+//
+// The compressed bytes go straight into the buffers returned by Next() of
+// the wrapped stream (e.g. the plaintext segments of an encrypting stream),
+// which are filled completely before the next one is requested, so no
+// intermediate copy of the compressed data is made.  WriteFrom()
+// compresses directly from the caller's bytes.  DecompressingInputStream
+// reverses this stage.
+//
+// WARNING: compressing before encrypting makes the size of the ciphertext
+// depend on the content of the plaintext.  If an attacker can influence
+// part of the plaintext and observe ciphertext sizes, they can recover
+// secrets from the rest of it (as in the CRIME and BREACH attacks).  Only
+// compress plaintexts which do not mix secrets with data chosen by others.
+class CompressingOutputStream : public crypto::tink::OutputStream {
+ public:
+  static constexpr int kDefaultBufferSize = 64 * 1024;
+
+  // Returns a stream that writes to 'output' at compression 'level' (from
+  // 0 to 9, or Z_DEFAULT_COMPRESSION), and returns buffers of
+  // 'buffer_size' bytes from Next().  Closing the stream closes 'output'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<OutputStream>> New(
+      std::unique_ptr<crypto::tink::OutputStream> output,
+      int level = Z_DEFAULT_COMPRESSION,
+      int buffer_size = kDefaultBufferSize);
+
+  ~CompressingOutputStream() override;
+
+  crypto::tink::util::StatusOr<int> Next(void** data) override;
+
+  // Compresses directly from 'data'.
+  crypto::tink::util::Status WriteFrom(
+      absl::Span<const uint8_t> data) override;
+
+  void BackUp(int count) override;
+
+  crypto::tink::util::Status Close() override;
+
+  // Returns the number of uncompressed bytes written.
+  int64_t Position() const override;
+
+ private:
+  CompressingOutputStream(std::unique_ptr<crypto::tink::OutputStream> output,
+                          int buffer_size);
+
+  // Compresses the bytes returned by the last Next() and not backed up.
+  crypto::tink::util::Status CompressBuffer();
+  // Compresses 'input' with the deflate flush mode 'flush'.
+  crypto::tink::util::Status Compress(absl::Span<const uint8_t> input,
+                                      int flush);
+
+  crypto::tink::util::Status status_;
+  std::unique_ptr<crypto::tink::OutputStream> output_;
+  z_stream zstream_;
+  bool zstream_initialized_;
+  std::unique_ptr<uint8_t[]> buffer_;
+  const int buffer_size_;
+  int count_in_buffer_;  // # bytes of buffer_ returned and not backed up
+  int64_t position_;
+  // The part of the last buffer from output_->Next() not yet filled.
+  uint8_t* output_buffer_;
+  int output_available_;
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_COMPRESSING_OUTPUT_STREAM_H_
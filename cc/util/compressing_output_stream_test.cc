@@ -0,0 +1,151 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/util/compressing_output_stream.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "zlib.h"
+#include "tink/output_stream.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/ostream_output_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Not;
+
+// Returns a compressible text of about 'size' bytes.
+std::string NewText(int size) {
+  std::string text;
+  for (int i = 0; text.size() < size; i++) {
+    absl::StrAppend(&text, "line ", i % 100, " of the text\n");
+  }
+  return text;
+}
+
+std::string Uncompress(absl::string_view compressed, size_t size) {
+  std::string output(size, '\0');
+  uLongf output_size = size;
+  EXPECT_EQ(Z_OK, uncompress(reinterpret_cast<Bytef*>(&output[0]),
+                             &output_size,
+                             reinterpret_cast<const Bytef*>(compressed.data()),
+                             compressed.size()));
+  output.resize(output_size);
+  return output;
+}
+
+class CompressingOutputStreamTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<OutputStream> NewStream(int level, int buffer_size) {
+    auto destination = absl::make_unique<std::stringstream>();
+    destination_ = destination.get();
+    auto stream_result = CompressingOutputStream::New(
+        absl::make_unique<OstreamOutputStream>(std::move(destination), 100),
+        level, buffer_size);
+    EXPECT_THAT(stream_result.status(), IsOk());
+    return std::move(stream_result.ValueOrDie());
+  }
+
+  std::stringstream* destination_;
+};
+
+TEST_F(CompressingOutputStreamTest, WriteWithNext) {
+  for (int buffer_size : {1, 10, 1000, 64 * 1024}) {
+    SCOPED_TRACE(buffer_size);
+    std::string text = NewText(200 * 1000);
+    auto stream = NewStream(Z_DEFAULT_COMPRESSION, buffer_size);
+    ASSERT_THAT(subtle::test::WriteToStream(stream.get(), text), IsOk());
+    EXPECT_EQ(text.size(), stream->Position());
+    std::string compressed = destination_->str();
+    EXPECT_LT(compressed.size(), text.size() / 10);
+    EXPECT_EQ(text, Uncompress(compressed, text.size()));
+  }
+}
+
+TEST_F(CompressingOutputStreamTest, WriteFrom) {
+  std::string text = NewText(100 * 1000);
+  auto stream = NewStream(9, 100);
+  void* buffer;
+  ASSERT_THAT(stream->Next(&buffer).status(), IsOk());
+  std::memcpy(buffer, text.data(), 10);
+  stream->BackUp(90);
+  absl::string_view rest = absl::string_view(text).substr(10);
+  ASSERT_THAT(stream->WriteFrom(absl::MakeConstSpan(
+                  reinterpret_cast<const uint8_t*>(rest.data()), rest.size())),
+              IsOk());
+  EXPECT_EQ(text.size(), stream->Position());
+  ASSERT_THAT(stream->Close(), IsOk());
+  EXPECT_EQ(text, Uncompress(destination_->str(), text.size()));
+}
+
+TEST_F(CompressingOutputStreamTest, IncompressibleAndEmptyData) {
+  for (int size : {0, 1, 100 * 1000}) {
+    SCOPED_TRACE(size);
+    std::string data = subtle::Random::GetRandomBytes(size);
+    auto stream = NewStream(Z_DEFAULT_COMPRESSION, 1000);
+    ASSERT_THAT(subtle::test::WriteToStream(stream.get(), data), IsOk());
+    EXPECT_EQ(data, Uncompress(destination_->str(), data.size()));
+  }
+}
+
+TEST_F(CompressingOutputStreamTest, ClosedStream) {
+  auto stream = NewStream(Z_DEFAULT_COMPRESSION, 100);
+  ASSERT_THAT(stream->Close(), IsOk());
+  void* buffer;
+  EXPECT_THAT(stream->Next(&buffer).status(),
+              StatusIs(util::error::FAILED_PRECONDITION));
+  EXPECT_THAT(stream->Close(), StatusIs(util::error::FAILED_PRECONDITION));
+}
+
+TEST_F(CompressingOutputStreamTest, InvalidArguments) {
+  EXPECT_THAT(CompressingOutputStream::New(nullptr).status(), Not(IsOk()));
+  EXPECT_THAT(
+      CompressingOutputStream::New(
+          absl::make_unique<OstreamOutputStream>(
+              absl::make_unique<std::stringstream>()),
+          Z_DEFAULT_COMPRESSION, 0)
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(CompressingOutputStream::New(
+                  absl::make_unique<OstreamOutputStream>(
+                      absl::make_unique<std::stringstream>()),
+                  10)
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
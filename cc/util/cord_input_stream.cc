@@ -0,0 +1,80 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/cord_input_stream.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+#include "absl/strings/cord.h"
+#include "absl/strings/string_view.h"
+#include "tink/input_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+CordInputStream::CordInputStream(absl::Cord input)
+    : input_(std::move(input)),
+      next_chunk_(input_.chunk_begin()),
+      position_(0),
+      count_backedup_(0) {}
+
+crypto::tink::util::StatusOr<int> CordInputStream::Next(const void** data) {
+  // If some bytes were backed up, return them first.
+  if (count_backedup_ > 0) {
+    last_data_.remove_prefix(last_data_.size() - count_backedup_);
+    position_ += count_backedup_;
+    count_backedup_ = 0;
+    *data = last_data_.data();
+    return static_cast<int>(last_data_.size());
+  }
+  while (chunk_rest_.empty()) {
+    if (next_chunk_ == input_.chunk_end()) {
+      last_data_ = absl::string_view();
+      return Status(util::error::OUT_OF_RANGE, "EOF");
+    }
+    chunk_rest_ = *next_chunk_;
+    ++next_chunk_;
+  }
+  size_t count = std::min(chunk_rest_.size(),
+                          static_cast<size_t>(std::numeric_limits<int>::max()));
+  last_data_ = chunk_rest_.substr(0, count);
+  chunk_rest_.remove_prefix(count);
+  position_ += count;
+  *data = last_data_.data();
+  return static_cast<int>(count);
+}
+
+void CordInputStream::BackUp(int count) {
+  if (count < 1 || last_data_.empty()) return;
+  int actual_count = std::min(
+      count, static_cast<int>(last_data_.size()) - count_backedup_);
+  count_backedup_ += actual_count;
+  position_ -= actual_count;
+}
+
+int64_t CordInputStream::Position() const {
+  return position_;
+}
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,62 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_CORD_INPUT_STREAM_H_
+#define TINK_UTIL_CORD_INPUT_STREAM_H_
+
+#include <cstdint>
+
+#include "absl/strings/cord.h"
+#include "absl/strings/string_view.h"
+#include "tink/input_stream.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// An InputStream that reads from an absl::Cord.
+//
+// Next() returns the chunks of the cord itself, so the contents of the cord
+// are neither flattened nor copied by the stream.
+class CordInputStream : public crypto::tink::InputStream {
+ public:
+  // Constructs an InputStream that will read from 'input'. Copying a cord
+  // only shares its chunks.
+  explicit CordInputStream(absl::Cord input);
+
+  ~CordInputStream() override = default;
+
+  crypto::tink::util::StatusOr<int> Next(const void** data) override;
+
+  void BackUp(int count) override;
+
+  int64_t Position() const override;
+
+ private:
+  absl::Cord input_;
+  absl::Cord::ChunkIterator next_chunk_;
+  absl::string_view chunk_rest_;  // part of the current chunk not yet read
+  absl::string_view last_data_;   // buffer returned by the last Next()
+  int64_t position_;
+  int count_backedup_;  // # bytes at the end of last_data_ that were backed up
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_CORD_INPUT_STREAM_H_
@@ -0,0 +1,153 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/cord_input_stream.h"
+
+#include <algorithm>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/subtle/random.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+// Returns a cord with the contents of 'contents', which refers to it in
+// chunks of 'chunk_size' bytes.  'contents' must outlive the cord.
+absl::Cord GetTestCord(absl::string_view contents, int chunk_size) {
+  absl::Cord cord;
+  while (!contents.empty()) {
+    absl::string_view chunk = contents.substr(0, chunk_size);
+    cord.Append(absl::MakeCordFromExternal(chunk, []() {}));
+    contents.remove_prefix(chunk.size());
+  }
+  return cord;
+}
+
+// Reads all of 'input_stream' into 'output'.  Returns the status of the
+// last Next().
+util::Status ReadTillEnd(util::CordInputStream* input_stream,
+                         std::string* output) {
+  output->clear();
+  const void* buffer;
+  auto next_result = input_stream->Next(&buffer);
+  while (next_result.ok()) {
+    output->append(static_cast<const char*>(buffer), next_result.ValueOrDie());
+    next_result = input_stream->Next(&buffer);
+  }
+  return next_result.status();
+}
+
+TEST(CordInputStreamTest, ReadingCords) {
+  for (int size : {0, 10, 100, 1000, 10000, 100000, 1000000}) {
+    SCOPED_TRACE(absl::StrCat("size = ", size));
+    std::string contents = subtle::Random::GetRandomBytes(size);
+    util::CordInputStream input_stream(GetTestCord(contents, 4096));
+    std::string stream_contents;
+    auto status = ReadTillEnd(&input_stream, &stream_contents);
+    EXPECT_EQ(util::error::OUT_OF_RANGE, status.error_code());
+    EXPECT_EQ("EOF", status.error_message());
+    EXPECT_EQ(contents, stream_contents);
+    EXPECT_EQ(size, input_stream.Position());
+  }
+}
+
+TEST(CordInputStreamTest, NextReturnsTheChunksOfTheCord) {
+  std::string contents = subtle::Random::GetRandomBytes(100000);
+  absl::Cord cord = GetTestCord(contents, 10000);
+  util::CordInputStream input_stream(cord);
+  for (absl::string_view chunk : cord.Chunks()) {
+    const void* buffer;
+    auto next_result = input_stream.Next(&buffer);
+    ASSERT_TRUE(next_result.ok()) << next_result.status();
+    EXPECT_EQ(chunk.size(), next_result.ValueOrDie());
+    EXPECT_EQ(chunk.data(), buffer);
+  }
+}
+
+TEST(CordInputStreamTest, BackupAndPosition) {
+  int chunk_size = 1234;
+  std::string contents = subtle::Random::GetRandomBytes(100000);
+  util::CordInputStream input_stream(GetTestCord(contents, chunk_size));
+  const void* buffer;
+  EXPECT_EQ(0, input_stream.Position());
+  auto next_result = input_stream.Next(&buffer);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  EXPECT_EQ(chunk_size, next_result.ValueOrDie());
+  EXPECT_EQ(chunk_size, input_stream.Position());
+
+  // BackUp several times, but in total fewer bytes than returned by Next().
+  int total_backup_size = 0;
+  for (int backup_size : {0, 1, 5, 0, 10, 100, -42, 400, 20, -100}) {
+    input_stream.BackUp(backup_size);
+    total_backup_size += std::max(0, backup_size);
+    EXPECT_EQ(chunk_size - total_backup_size, input_stream.Position());
+  }
+  // Call Next(), it should return exactly the backed up bytes.
+  next_result = input_stream.Next(&buffer);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  EXPECT_EQ(total_backup_size, next_result.ValueOrDie());
+  EXPECT_EQ(chunk_size, input_stream.Position());
+  EXPECT_EQ(
+      contents.substr(chunk_size - total_backup_size, total_backup_size),
+      std::string(static_cast<const char*>(buffer), total_backup_size));
+
+  // BackUp more than returned, which backs up only the returned bytes.
+  input_stream.BackUp(total_backup_size + 100);
+  EXPECT_EQ(chunk_size - total_backup_size, input_stream.Position());
+  next_result = input_stream.Next(&buffer);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  EXPECT_EQ(total_backup_size, next_result.ValueOrDie());
+
+  // Call Next() again, it should return the second chunk.
+  next_result = input_stream.Next(&buffer);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  EXPECT_EQ(chunk_size, next_result.ValueOrDie());
+  EXPECT_EQ(2 * chunk_size, input_stream.Position());
+  EXPECT_EQ(contents.substr(chunk_size, chunk_size),
+            std::string(static_cast<const char*>(buffer), chunk_size));
+
+  // Backing up at the end of the cord returns the bytes again.
+  std::string rest;
+  EXPECT_EQ(util::error::OUT_OF_RANGE,
+            ReadTillEnd(&input_stream, &rest).error_code());
+  EXPECT_EQ(contents.substr(2 * chunk_size), rest);
+  input_stream.BackUp(10);
+  EXPECT_EQ(contents.size(), input_stream.Position());
+}
+
+TEST(CordInputStreamTest, ReadInto) {
+  std::string contents = subtle::Random::GetRandomBytes(100000);
+  util::CordInputStream input_stream(GetTestCord(contents, 1000));
+  std::string stream_contents;
+  for (int read_size : {0, 10, 5000, 999, 1000, 1, 30000, 100000}) {
+    std::string buffer(read_size, '\0');
+    auto read_result = input_stream.ReadInto(absl::MakeSpan(
+        reinterpret_cast<uint8_t*>(&buffer[0]), buffer.size()));
+    ASSERT_TRUE(read_result.ok()) << read_result.status();
+    stream_contents.append(buffer, 0, read_result.ValueOrDie());
+  }
+  EXPECT_EQ(contents, stream_contents);
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,120 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/cord_output_stream.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/output_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+CordOutputStream::CordOutputStream(absl::Cord* output, int buffer_size)
+    : status_(Status::OK),
+      output_(output),
+      buffer_size_(buffer_size > 0 ? buffer_size : 128 * 1024),  // 128 KB
+      position_(0),
+      count_in_buffer_(0),
+      last_size_(0),
+      count_backedup_(0) {}
+
+void CordOutputStream::AppendBuffer() {
+  if (count_in_buffer_ == 0) return;
+  if (count_in_buffer_ < buffer_size_ / 2) {
+    // Copies the few bytes, and keeps buffer_ for the next Next().
+    output_->Append(absl::string_view(
+        reinterpret_cast<const char*>(buffer_.get()), count_in_buffer_));
+  } else {
+    uint8_t* buffer = buffer_.release();
+    output_->Append(absl::MakeCordFromExternal(
+        absl::string_view(reinterpret_cast<const char*>(buffer),
+                          count_in_buffer_),
+        [buffer]() { delete[] buffer; }));
+  }
+  count_in_buffer_ = 0;
+}
+
+crypto::tink::util::StatusOr<int> CordOutputStream::Next(void** data) {
+  if (!status_.ok()) return status_;
+  if (buffer_ == nullptr || count_in_buffer_ == buffer_size_) {
+    AppendBuffer();
+    if (buffer_ == nullptr) {
+      buffer_ = absl::make_unique<uint8_t[]>(buffer_size_);
+    }
+  }
+  // Returns the free space at the end of buffer_, which is all of buffer_
+  // unless the previous buffer was backed up.
+  *data = buffer_.get() + count_in_buffer_;
+  last_size_ = buffer_size_ - count_in_buffer_;
+  count_backedup_ = 0;
+  count_in_buffer_ = buffer_size_;
+  position_ += last_size_;
+  return last_size_;
+}
+
+Status CordOutputStream::WriteFrom(absl::Span<const uint8_t> data) {
+  if (!status_.ok()) return status_;
+  if (static_cast<int64_t>(data.size()) < buffer_size_) {
+    return OutputStream::WriteFrom(data);
+  }
+  // Appends the buffered bytes and then 'data', and leaves the buffer
+  // empty.
+  AppendBuffer();
+  output_->Append(absl::string_view(
+      reinterpret_cast<const char*>(data.data()), data.size()));
+  last_size_ = 0;
+  count_backedup_ = 0;
+  position_ += data.size();
+  return Status::OK;
+}
+
+void CordOutputStream::BackUp(int count) {
+  if (!status_.ok() || count < 1 || last_size_ == 0) return;
+  int actual_count = std::min(count, last_size_ - count_backedup_);
+  count_backedup_ += actual_count;
+  count_in_buffer_ -= actual_count;
+  position_ -= actual_count;
+}
+
+CordOutputStream::~CordOutputStream() {
+  Close().IgnoreError();
+}
+
+Status CordOutputStream::Close() {
+  if (!status_.ok()) return status_;
+  AppendBuffer();
+  buffer_.reset();
+  status_ = Status(util::error::FAILED_PRECONDITION, "Stream closed");
+  return Status::OK;
+}
+
+int64_t CordOutputStream::Position() const {
+  return position_;
+}
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,81 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_CORD_OUTPUT_STREAM_H_
+#define TINK_UTIL_CORD_OUTPUT_STREAM_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "absl/strings/cord.h"
+#include "absl/types/span.h"
+#include "tink/output_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// An OutputStream that appends to an absl::Cord.
+//
+// The buffers returned by Next() are appended to the cord as they are,
+// without copying, once they are full: the cord takes over their ownership.
+// Only buffers which are mostly backed up are copied into the cord, so that
+// the cord does not keep large, mostly unused buffers alive.
+class CordOutputStream : public crypto::tink::OutputStream {
+ public:
+  // Constructs an OutputStream that will append to 'output', which must
+  // outlive the stream, using buffers of the specified size, if any (if no
+  // legal 'buffer_size' is given, a reasonable default will be used).
+  // The bytes written are in 'output' once the stream is closed.
+  explicit CordOutputStream(absl::Cord* output, int buffer_size = -1);
+
+  ~CordOutputStream() override;
+
+  crypto::tink::util::StatusOr<int> Next(void** data) override;
+
+  // Appends chunks of at least the buffer size directly from 'data'.
+  crypto::tink::util::Status WriteFrom(
+      absl::Span<const uint8_t> data) override;
+
+  void BackUp(int count) override;
+
+  crypto::tink::util::Status Close() override;
+
+  int64_t Position() const override;
+
+ private:
+  // Appends the bytes written to buffer_ to output_.
+  void AppendBuffer();
+
+  util::Status status_;
+  absl::Cord* output_;
+  std::unique_ptr<uint8_t[]> buffer_;
+  const int buffer_size_;
+  int64_t position_;  // # bytes written since the stream was created
+
+  // Counters that describe the state of the data in buffer_.
+  int count_in_buffer_;  // # bytes in buffer_ that will be appended
+  int last_size_;        // size of the buffer returned by the last Next()
+  int count_backedup_;   // # bytes of that buffer that were backed up
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_CORD_OUTPUT_STREAM_H_
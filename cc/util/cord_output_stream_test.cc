@@ -0,0 +1,161 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/cord_output_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/subtle/random.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+// Writes 'contents' to the specified 'output_stream', and closes the stream.
+// Returns the status of output_stream->Close()-operation, or a non-OK status
+// of a prior output_stream->Next()-operation, if any.
+util::Status WriteToStream(util::CordOutputStream* output_stream,
+                           absl::string_view contents) {
+  void* buffer;
+  int pos = 0;
+  int remaining = contents.length();
+  int available_space = 0;
+  int available_bytes = 0;
+  while (remaining > 0) {
+    auto next_result = output_stream->Next(&buffer);
+    if (!next_result.ok()) return next_result.status();
+    available_space = next_result.ValueOrDie();
+    available_bytes = std::min(available_space, remaining);
+    memcpy(buffer, contents.data() + pos, available_bytes);
+    remaining -= available_bytes;
+    pos += available_bytes;
+  }
+  if (available_space > available_bytes) {
+    output_stream->BackUp(available_space - available_bytes);
+  }
+  return output_stream->Close();
+}
+
+TEST(CordOutputStreamTest, WritingStreams) {
+  for (int size : {0, 10, 100, 1000, 10000, 100000, 1000000}) {
+    SCOPED_TRACE(absl::StrCat("size = ", size));
+    std::string contents = subtle::Random::GetRandomBytes(size);
+    absl::Cord cord("existing ");
+    util::CordOutputStream output_stream(&cord);
+    EXPECT_TRUE(WriteToStream(&output_stream, contents).ok());
+    EXPECT_EQ(size, output_stream.Position());
+    EXPECT_EQ(absl::StrCat("existing ", contents), std::string(cord));
+  }
+}
+
+TEST(CordOutputStreamTest, FullBuffersBecomeChunksOfTheCord) {
+  int buffer_size = 10000;
+  absl::Cord cord;
+  util::CordOutputStream output_stream(&cord, buffer_size);
+  void* buffers[3];
+  for (void*& buffer : buffers) {
+    auto next_result = output_stream.Next(&buffer);
+    ASSERT_TRUE(next_result.ok()) << next_result.status();
+    ASSERT_EQ(buffer_size, next_result.ValueOrDie());
+    memset(buffer, 'a', buffer_size);
+  }
+  ASSERT_TRUE(output_stream.Close().ok());
+  ASSERT_EQ(3 * buffer_size, cord.size());
+  int i = 0;
+  for (absl::string_view chunk : cord.Chunks()) {
+    ASSERT_LT(i, 3);
+    EXPECT_EQ(buffers[i++], chunk.data());
+    EXPECT_EQ(buffer_size, chunk.size());
+  }
+}
+
+TEST(CordOutputStreamTest, BackupAndPosition) {
+  int buffer_size = 1234;
+  absl::Cord cord;
+  util::CordOutputStream output_stream(&cord, buffer_size);
+  std::string contents = subtle::Random::GetRandomBytes(3 * buffer_size);
+  void* buffer;
+  EXPECT_EQ(0, output_stream.Position());
+  auto next_result = output_stream.Next(&buffer);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  EXPECT_EQ(buffer_size, next_result.ValueOrDie());
+  EXPECT_EQ(buffer_size, output_stream.Position());
+  memcpy(buffer, contents.data(), buffer_size);
+
+  // BackUp several times, but in total fewer bytes than returned by Next().
+  int total_backup_size = 0;
+  for (int backup_size : {0, 1, 5, 0, 10, 100, -42, 400, 20, -100}) {
+    output_stream.BackUp(backup_size);
+    total_backup_size += std::max(0, backup_size);
+    EXPECT_EQ(buffer_size - total_backup_size, output_stream.Position());
+  }
+  // Call Next(), it should return exactly the backed up space.
+  next_result = output_stream.Next(&buffer);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  EXPECT_EQ(total_backup_size, next_result.ValueOrDie());
+  EXPECT_EQ(buffer_size, output_stream.Position());
+  memcpy(buffer, contents.data() + buffer_size - total_backup_size,
+         total_backup_size);
+
+  // BackUp more than returned, which backs up only the returned space.
+  output_stream.BackUp(buffer_size);
+  EXPECT_EQ(buffer_size - total_backup_size, output_stream.Position());
+  next_result = output_stream.Next(&buffer);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  EXPECT_EQ(total_backup_size, next_result.ValueOrDie());
+  memcpy(buffer, contents.data() + buffer_size - total_backup_size,
+         total_backup_size);
+
+  // Write the rest with WriteFrom(), and close.
+  auto data = absl::MakeConstSpan(
+      reinterpret_cast<const uint8_t*>(contents.data()), contents.size());
+  EXPECT_TRUE(output_stream.WriteFrom(data.subspan(buffer_size, 10)).ok());
+  EXPECT_TRUE(output_stream.WriteFrom(data.subspan(buffer_size + 10)).ok());
+  EXPECT_EQ(contents.size(), output_stream.Position());
+  EXPECT_TRUE(output_stream.Close().ok());
+  EXPECT_EQ(contents, std::string(cord));
+
+  // The closed stream cannot be written any more.
+  EXPECT_FALSE(output_stream.Next(&buffer).ok());
+  EXPECT_FALSE(output_stream.Close().ok());
+}
+
+TEST(CordOutputStreamTest, DestructorAppendsTheBuffer) {
+  absl::Cord cord;
+  {
+    util::CordOutputStream output_stream(&cord);
+    std::string contents = "some bytes";
+    EXPECT_TRUE(output_stream
+                    .WriteFrom(absl::MakeConstSpan(
+                        reinterpret_cast<const uint8_t*>(contents.data()),
+                        contents.size()))
+                    .ok());
+    EXPECT_TRUE(cord.empty());
+  }
+  EXPECT_EQ("some bytes", std::string(cord));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
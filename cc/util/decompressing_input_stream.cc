@@ -0,0 +1,173 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/util/decompressing_input_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/types/span.h"
+#include "zlib.h"
+#include "tink/input_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+StatusOr<std::unique_ptr<InputStream>> DecompressingInputStream::New(
+    std::unique_ptr<InputStream> input, int buffer_size) {
+  if (input == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT, "input must be non-null");
+  }
+  if (buffer_size <= 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "buffer_size must be positive");
+  }
+  auto stream = absl::WrapUnique(
+      new DecompressingInputStream(std::move(input), buffer_size));
+  if (inflateInit(&stream->zstream_) != Z_OK) {
+    return Status(util::error::INTERNAL,
+                  "Failed to initialize decompression");
+  }
+  stream->zstream_initialized_ = true;
+  return {std::move(stream)};
+}
+
+DecompressingInputStream::DecompressingInputStream(
+    std::unique_ptr<InputStream> input, int buffer_size)
+    : input_(std::move(input)),
+      zstream_initialized_(false),
+      end_of_data_(false),
+      buffer_(absl::make_unique<uint8_t[]>(buffer_size)),
+      buffer_size_(buffer_size),
+      count_in_buffer_(0),
+      count_backedup_(0),
+      position_(0) {
+  std::memset(&zstream_, 0, sizeof(zstream_));
+}
+
+DecompressingInputStream::~DecompressingInputStream() {
+  if (zstream_initialized_) inflateEnd(&zstream_);
+}
+
+StatusOr<int> DecompressingInputStream::Decompress(
+    absl::Span<uint8_t> output) {
+  if (end_of_data_) return 0;
+  zstream_.next_out = output.data();
+  zstream_.avail_out = output.size();
+  while (true) {
+    int result = inflate(&zstream_, Z_NO_FLUSH);
+    if (result == Z_STREAM_END) {
+      end_of_data_ = true;
+      break;
+    }
+    if (result != Z_OK && result != Z_BUF_ERROR) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    "Invalid compressed data");
+    }
+    // With space left in 'output' inflate() has consumed all of its input;
+    // what is available is returned rather than waiting for more input.
+    if (zstream_.avail_out < output.size()) break;
+    const void* data;
+    auto next_result = input_->Next(&data);
+    if (next_result.status().error_code() == util::error::OUT_OF_RANGE) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    "Compressed data is truncated");
+    }
+    if (!next_result.ok()) return next_result.status();
+    zstream_.next_in = const_cast<Bytef*>(static_cast<const Bytef*>(data));
+    zstream_.avail_in = next_result.ValueOrDie();
+  }
+  int count = output.size() - zstream_.avail_out;
+  if (end_of_data_) {
+    // The rest of the input must be empty, and is read to its end.
+    const void* data;
+    auto next_result = input_->Next(&data);
+    while (next_result.ok() && next_result.ValueOrDie() == 0) {
+      next_result = input_->Next(&data);
+    }
+    if (zstream_.avail_in > 0 || next_result.ok()) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    "Unexpected data after the compressed data");
+    }
+    if (next_result.status().error_code() != util::error::OUT_OF_RANGE) {
+      return next_result.status();
+    }
+  }
+  return count;
+}
+
+StatusOr<int> DecompressingInputStream::Next(const void** data) {
+  if (!status_.ok()) return status_;
+  if (count_backedup_ > 0) {
+    *data = buffer_.get() + count_in_buffer_ - count_backedup_;
+    int count = count_backedup_;
+    count_backedup_ = 0;
+    position_ += count;
+    return count;
+  }
+  auto decompress_result =
+      Decompress(absl::MakeSpan(buffer_.get(), buffer_size_));
+  if (!decompress_result.ok()) {
+    status_ = decompress_result.status();
+    return status_;
+  }
+  count_in_buffer_ = decompress_result.ValueOrDie();
+  if (count_in_buffer_ == 0) {
+    return Status(util::error::OUT_OF_RANGE, "EOF");
+  }
+  position_ += count_in_buffer_;
+  *data = buffer_.get();
+  return count_in_buffer_;
+}
+
+void DecompressingInputStream::BackUp(int count) {
+  if (!status_.ok() || count < 1) return;
+  int actual_count = std::min(count, count_in_buffer_ - count_backedup_);
+  count_backedup_ += actual_count;
+  position_ -= actual_count;
+}
+
+int64_t DecompressingInputStream::Position() const { return position_; }
+
+StatusOr<int> DecompressingInputStream::ReadInto(absl::Span<uint8_t> buffer) {
+  if (!status_.ok()) return status_;
+  int count = std::min<int>(count_backedup_, buffer.size());
+  std::memcpy(buffer.data(), buffer_.get() + count_in_buffer_ - count_backedup_,
+              count);
+  count_backedup_ -= count;
+  while (count < static_cast<int>(buffer.size())) {
+    auto decompress_result = Decompress(buffer.subspan(count));
+    if (!decompress_result.ok()) {
+      status_ = decompress_result.status();
+      return status_;
+    }
+    if (decompress_result.ValueOrDie() == 0) break;
+    count += decompress_result.ValueOrDie();
+  }
+  position_ += count;
+  return count;
+}
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,98 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef TINK_UTIL_DECOMPRESSING_INPUT_STREAM_H_
+#define TINK_UTIL_DECOMPRESSING_INPUT_STREAM_H_
+
+#include <memory>
+
+#include "absl/types/span.h"
+#include "zlib.h"
+#include "tink/input_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// An InputStream that decompresses the bytes of another InputStream, which
+// were compressed by CompressingOutputStream.  It is a stage of a pipeline
+// that decrypts before decompressing, in one pass:
+//
+//   auto decrypting_stream = streaming_aead.NewDecryptingStream(
+//       std::move(ciphertext_source), associated_data);
+//   auto decompressing_stream = DecompressingInputStream::New(
+//       std::move(decrypting_stream.ValueOrDie()));
+//
+// The compressed bytes are read straight from the buffers returned by
+// Next() of the wrapped stream (e.g. the plaintext segments of a decrypting
+// stream), and ReadInto() decompresses directly into the caller's buffer.
+// Once the compressed data ends, the rest of the wrapped stream is read as
+// well, and must be empty: for a decrypting stream this authenticates the
+// end of the ciphertext before the end of the data is reported.
+//
+// See CompressingOutputStream for the side channels of compression.
+class DecompressingInputStream : public crypto::tink::InputStream {
+ public:
+  static constexpr int kDefaultBufferSize = 64 * 1024;
+
+  // Returns a stream that reads from 'input', and returns buffers of at
+  // most 'buffer_size' bytes from Next().
+  static crypto::tink::util::StatusOr<std::unique_ptr<InputStream>> New(
+      std::unique_ptr<crypto::tink::InputStream> input,
+      int buffer_size = kDefaultBufferSize);
+
+  ~DecompressingInputStream() override;
+
+  crypto::tink::util::StatusOr<int> Next(const void** data) override;
+
+  void BackUp(int count) override;
+
+  // Returns the number of decompressed bytes read.
+  int64_t Position() const override;
+
+  // Decompresses directly into 'buffer'.
+  crypto::tink::util::StatusOr<int> ReadInto(
+      absl::Span<uint8_t> buffer) override;
+
+ private:
+  DecompressingInputStream(std::unique_ptr<crypto::tink::InputStream> input,
+                           int buffer_size);
+
+  // Decompresses into 'output' until it is full or the compressed data
+  // ends, and returns the number of bytes written, which is 0 only at the
+  // end.
+  crypto::tink::util::StatusOr<int> Decompress(absl::Span<uint8_t> output);
+
+  crypto::tink::util::Status status_;
+  std::unique_ptr<crypto::tink::InputStream> input_;
+  z_stream zstream_;
+  bool zstream_initialized_;
+  bool end_of_data_;
+  std::unique_ptr<uint8_t[]> buffer_;
+  const int buffer_size_;
+  int count_in_buffer_;  // # bytes in buffer_ from the last Next()
+  int count_backedup_;   // # bytes at the end of buffer_ backed up
+  int64_t position_;
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_DECOMPRESSING_INPUT_STREAM_H_
@@ -0,0 +1,183 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+#include "tink/util/decompressing_input_stream.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/input_stream.h"
+#include "tink/output_stream.h"
+#include "tink/subtle/aes_gcm_hkdf_streaming.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/test_util.h"
+#include "tink/util/compressing_output_stream.h"
+#include "tink/util/istream_input_stream.h"
+#include "tink/util/ostream_output_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+
+// Returns a compressible text of about 'size' bytes.
+std::string NewText(int size) {
+  std::string text;
+  for (int i = 0; text.size() < size; i++) {
+    absl::StrAppend(&text, "line ", i % 100, " of the text\n");
+  }
+  return text;
+}
+
+std::string Compress(absl::string_view data) {
+  auto destination = absl::make_unique<std::stringstream>();
+  std::stringstream* destination_ptr = destination.get();
+  auto stream = std::move(
+      CompressingOutputStream::New(
+          absl::make_unique<OstreamOutputStream>(std::move(destination)))
+          .ValueOrDie());
+  EXPECT_THAT(subtle::test::WriteToStream(stream.get(), data), IsOk());
+  return destination_ptr->str();
+}
+
+std::unique_ptr<InputStream> NewStream(absl::string_view compressed,
+                                       int buffer_size) {
+  auto stream_result = DecompressingInputStream::New(
+      absl::make_unique<IstreamInputStream>(
+          absl::make_unique<std::stringstream>(std::string(compressed)), 100),
+      buffer_size);
+  EXPECT_THAT(stream_result.status(), IsOk());
+  return std::move(stream_result.ValueOrDie());
+}
+
+TEST(DecompressingInputStreamTest, ReadWithNext) {
+  std::string text = NewText(200 * 1000);
+  std::string compressed = Compress(text);
+  for (int buffer_size : {1, 10, 1000, 64 * 1024}) {
+    SCOPED_TRACE(buffer_size);
+    auto stream = NewStream(compressed, buffer_size);
+    std::string output;
+    ASSERT_THAT(subtle::test::ReadFromStream(stream.get(), &output), IsOk());
+    EXPECT_EQ(text, output);
+    EXPECT_EQ(text.size(), stream->Position());
+  }
+}
+
+TEST(DecompressingInputStreamTest, ReadIntoAndBackUp) {
+  std::string text = NewText(100 * 1000);
+  auto stream = NewStream(Compress(text), 1000);
+  const void* data;
+  auto next_result = stream->Next(&data);
+  ASSERT_THAT(next_result.status(), IsOk());
+  int read = next_result.ValueOrDie() / 2;
+  stream->BackUp(next_result.ValueOrDie() - read);
+  EXPECT_EQ(read, stream->Position());
+
+  // A larger buffer than the rest of the data.
+  std::string output(text.size(), '\0');
+  auto read_result = stream->ReadInto(absl::MakeSpan(
+      reinterpret_cast<uint8_t*>(&output[0]), output.size()));
+  ASSERT_THAT(read_result.status(), IsOk());
+  EXPECT_EQ(text.size() - read, read_result.ValueOrDie());
+  output.resize(read_result.ValueOrDie());
+  EXPECT_EQ(text.substr(read), output);
+  EXPECT_THAT(stream->Next(&data).status(),
+              StatusIs(util::error::OUT_OF_RANGE));
+}
+
+TEST(DecompressingInputStreamTest, EmptyData) {
+  auto stream = NewStream(Compress(""), 100);
+  const void* data;
+  EXPECT_THAT(stream->Next(&data).status(),
+              StatusIs(util::error::OUT_OF_RANGE));
+}
+
+TEST(DecompressingInputStreamTest, InvalidData) {
+  std::string compressed = Compress(NewText(10 * 1000));
+  std::string corrupted = compressed;
+  corrupted[corrupted.size() / 2] ^= 0x55;
+  for (const std::string& invalid :
+       {compressed.substr(0, compressed.size() - 1), corrupted,
+        compressed + "x", std::string("not compressed")}) {
+    auto stream = NewStream(invalid, 100);
+    std::string output;
+    EXPECT_THAT(subtle::test::ReadFromStream(stream.get(), &output),
+                StatusIs(util::error::INVALID_ARGUMENT));
+  }
+}
+
+TEST(DecompressingInputStreamTest, CompressEncryptDecryptDecompress) {
+  subtle::AesGcmHkdfStreaming::Params params;
+  params.ikm = subtle::Random::GetRandomKeyBytes(16);
+  params.hkdf_hash = subtle::SHA256;
+  params.derived_key_size = 16;
+  params.ciphertext_segment_size = 4096;
+  params.ciphertext_offset = 0;
+  auto streaming_aead =
+      std::move(subtle::AesGcmHkdfStreaming::New(std::move(params))
+                    .ValueOrDie());
+  std::string text = NewText(300 * 1000);
+
+  auto ciphertext_destination = absl::make_unique<std::stringstream>();
+  std::stringstream* ciphertext_ptr = ciphertext_destination.get();
+  auto encrypting_stream = streaming_aead->NewEncryptingStream(
+      absl::make_unique<OstreamOutputStream>(
+          std::move(ciphertext_destination)),
+      "ad");
+  ASSERT_THAT(encrypting_stream.status(), IsOk());
+  auto compressing_stream = CompressingOutputStream::New(
+      std::move(encrypting_stream.ValueOrDie()));
+  ASSERT_THAT(compressing_stream.status(), IsOk());
+  ASSERT_THAT(subtle::test::WriteToStream(
+                  compressing_stream.ValueOrDie().get(), text),
+              IsOk());
+  std::string ciphertext = ciphertext_ptr->str();
+  EXPECT_LT(ciphertext.size(), text.size() / 10);
+
+  auto decrypting_stream = streaming_aead->NewDecryptingStream(
+      absl::make_unique<IstreamInputStream>(
+          absl::make_unique<std::stringstream>(ciphertext)),
+      "ad");
+  ASSERT_THAT(decrypting_stream.status(), IsOk());
+  auto decompressing_stream = DecompressingInputStream::New(
+      std::move(decrypting_stream.ValueOrDie()));
+  ASSERT_THAT(decompressing_stream.status(), IsOk());
+  std::string output;
+  ASSERT_THAT(subtle::test::ReadFromStream(
+                  decompressing_stream.ValueOrDie().get(), &output),
+              IsOk());
+  EXPECT_EQ(text, output);
+}
+
+}  // namespace
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,348 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/encrypted_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "tink/aead.h"
+#include "tink/subtle/aegis.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+namespace {
+
+constexpr int kKeySizeInBytes = 32;
+// Bounds the plaintext held at once by a batch of Rekey().
+constexpr int64_t kMaxRekeyBatchBytes = 1 << 20;
+
+StatusOr<std::unique_ptr<Aead>> NewAead(bool prefer_aegis) {
+  if (prefer_aegis && subtle::Aegis::IsSupported()) {
+    return subtle::Aegis::New(
+        subtle::Random::GetRandomKeyBytes(kKeySizeInBytes));
+  }
+  return subtle::AesGcmBoringSsl::New(
+      subtle::Random::GetRandomKeyBytes(kKeySizeInBytes));
+}
+
+// Hands out blocks of power-of-two sizes from kMinBlockSize to
+// EncryptedCache::kMaxSlabBlockSize bytes, carved from slabs of kSlabSize
+// bytes, and keeps freed blocks on a free list per size.  Larger blocks
+// are allocated individually.  Not thread-safe.
+class SlabAllocator {
+ public:
+  static constexpr size_t kMinBlockSize = 64;
+  static constexpr size_t kSlabSize = 64 * 1024;
+
+  char* Allocate(size_t size) {
+    int size_class = SizeClass(size);
+    if (size_class < 0) return new char[size];
+    char*& free_list = free_lists_[size_class];
+    if (free_list != nullptr) {
+      char* block = free_list;
+      std::memcpy(&free_list, block, sizeof(char*));
+      return block;
+    }
+    size_t block_size = kMinBlockSize << size_class;
+    if (static_cast<size_t>(end_ - next_) < block_size) {
+      slabs_.push_back(absl::make_unique<char[]>(kSlabSize));
+      next_ = slabs_.back().get();
+      end_ = next_ + kSlabSize;
+    }
+    char* block = next_;
+    next_ += block_size;
+    return block;
+  }
+
+  void Deallocate(char* block, size_t size) {
+    int size_class = SizeClass(size);
+    if (size_class < 0) {
+      delete[] block;
+      return;
+    }
+    std::memcpy(block, &free_lists_[size_class], sizeof(char*));
+    free_lists_[size_class] = block;
+  }
+
+  // Returns whether a block allocated for 'old_size' bytes can hold
+  // 'new_size' bytes, and is what Allocate(new_size) would return.
+  static bool SameBlock(size_t old_size, size_t new_size) {
+    int size_class = SizeClass(old_size);
+    return size_class >= 0 ? size_class == SizeClass(new_size)
+                           : old_size == new_size;
+  }
+
+ private:
+  static constexpr int kNumSizeClasses = 7;  // 64, 128, ..., 4096 bytes
+
+  // Returns the size class of 'size', or -1 if it is too large for a slab.
+  static int SizeClass(size_t size) {
+    if (size > static_cast<size_t>(EncryptedCache::kMaxSlabBlockSize)) {
+      return -1;
+    }
+    int size_class = 0;
+    while ((kMinBlockSize << size_class) < size) ++size_class;
+    return size_class;
+  }
+
+  std::vector<std::unique_ptr<char[]>> slabs_;
+  char* next_ = nullptr;
+  char* end_ = nullptr;
+  char* free_lists_[kNumSizeClasses] = {};
+};
+
+struct Entry {
+  char* data;
+  uint32_t size;
+  // The generation of the Aead which encrypted the value.
+  uint32_t generation;
+
+  absl::string_view ciphertext() const {
+    return absl::string_view(data, size);
+  }
+};
+
+}  // namespace
+
+struct EncryptedCache::Shard {
+  ~Shard() {
+    for (auto& key_and_entry : entries) {
+      slabs.Deallocate(key_and_entry.second.data, key_and_entry.second.size);
+    }
+  }
+
+  mutable absl::Mutex mutex;
+  absl::flat_hash_map<std::string, Entry> entries ABSL_GUARDED_BY(mutex);
+  SlabAllocator slabs ABSL_GUARDED_BY(mutex);
+};
+
+// static
+StatusOr<std::unique_ptr<EncryptedCache>> EncryptedCache::New(
+    const Options& options) {
+  if (options.num_shards < 1) {
+    return Status(error::INVALID_ARGUMENT, "num_shards must be positive");
+  }
+  auto aead_result = NewAead(options.prefer_aegis);
+  if (!aead_result.ok()) return aead_result.status();
+  auto overhead_result = aead_result.ValueOrDie()->CiphertextSize(0);
+  if (!overhead_result.ok()) return overhead_result.status();
+  return {absl::WrapUnique(
+      new EncryptedCache(options, std::move(aead_result.ValueOrDie()),
+                         overhead_result.ValueOrDie()))};
+}
+
+EncryptedCache::EncryptedCache(const Options& options,
+                               std::unique_ptr<Aead> aead, int64_t overhead)
+    : options_(options),
+      overhead_(overhead),
+      shards_(new Shard[options.num_shards]) {
+  aeads_[0] = std::move(aead);
+}
+
+EncryptedCache::~EncryptedCache() {}
+
+EncryptedCache::Shard& EncryptedCache::ShardOf(absl::string_view key) const {
+  return shards_[absl::Hash<absl::string_view>()(key) % options_.num_shards];
+}
+
+Status EncryptedCache::Put(absl::string_view key, absl::string_view value) {
+  if (value.size() > std::numeric_limits<uint32_t>::max() - overhead_) {
+    return Status(error::INVALID_ARGUMENT, "Value too large");
+  }
+  const uint32_t size = value.size() + overhead_;
+  Shard& shard = ShardOf(key);
+  absl::MutexLock lock(&shard.mutex);
+  // Read under the lock of the shard, so that Rekey() cannot retire the
+  // generation before it re-encrypts this shard.
+  const uint32_t generation = generation_.load(std::memory_order_acquire);
+  auto it = shard.entries.find(key);
+  const bool reuse_block = it != shard.entries.end() &&
+                           SlabAllocator::SameBlock(it->second.size, size);
+  char* block = reuse_block ? it->second.data : shard.slabs.Allocate(size);
+  auto written_result = AeadOf(generation).EncryptInto(
+      value, key, absl::MakeSpan(block, size));
+  if (!written_result.ok() || written_result.ValueOrDie() != size) {
+    shard.slabs.Deallocate(block, size);
+    // The old value was overwritten.
+    if (reuse_block) shard.entries.erase(it);
+    if (!written_result.ok()) return written_result.status();
+    return Status(error::INTERNAL, "Unexpected ciphertext size");
+  }
+  if (it == shard.entries.end()) {
+    shard.entries.emplace(std::string(key), Entry{block, size, generation});
+    return Status::OK;
+  }
+  if (!reuse_block) {
+    shard.slabs.Deallocate(it->second.data, it->second.size);
+  }
+  it->second = Entry{block, size, generation};
+  return Status::OK;
+}
+
+StatusOr<std::string> EncryptedCache::Get(absl::string_view key) const {
+  Shard& shard = ShardOf(key);
+  absl::ReaderMutexLock lock(&shard.mutex);
+  auto it = shard.entries.find(key);
+  if (it == shard.entries.end()) {
+    return Status(error::NOT_FOUND, "No value for the key");
+  }
+  const Entry& entry = it->second;
+  std::string value(entry.size - overhead_, '\0');
+  auto written_result = AeadOf(entry.generation)
+                            .DecryptInto(entry.ciphertext(), key,
+                                         absl::MakeSpan(&value[0],
+                                                        value.size()));
+  if (!written_result.ok()) return written_result.status();
+  return std::move(value);
+}
+
+StatusOr<int64_t> EncryptedCache::GetInto(absl::string_view key,
+                                          absl::Span<char> buffer) const {
+  Shard& shard = ShardOf(key);
+  absl::ReaderMutexLock lock(&shard.mutex);
+  auto it = shard.entries.find(key);
+  if (it == shard.entries.end()) {
+    return Status(error::NOT_FOUND, "No value for the key");
+  }
+  const Entry& entry = it->second;
+  if (buffer.size() < entry.size - overhead_) {
+    return Status(error::INVALID_ARGUMENT, "Buffer too small");
+  }
+  return AeadOf(entry.generation)
+      .DecryptInto(entry.ciphertext(), key, buffer);
+}
+
+bool EncryptedCache::Erase(absl::string_view key) {
+  Shard& shard = ShardOf(key);
+  absl::MutexLock lock(&shard.mutex);
+  auto it = shard.entries.find(key);
+  if (it == shard.entries.end()) return false;
+  shard.slabs.Deallocate(it->second.data, it->second.size);
+  shard.entries.erase(it);
+  return true;
+}
+
+int64_t EncryptedCache::size() const {
+  int64_t size = 0;
+  for (int i = 0; i < options_.num_shards; ++i) {
+    absl::ReaderMutexLock lock(&shards_[i].mutex);
+    size += shards_[i].entries.size();
+  }
+  return size;
+}
+
+Status EncryptedCache::Rekey() {
+  absl::MutexLock rekey_lock(&rekey_mutex_);
+  auto aead_result = NewAead(options_.prefer_aegis);
+  if (!aead_result.ok()) return aead_result.status();
+  const uint32_t generation =
+      generation_.load(std::memory_order_relaxed) + 1;
+  aeads_[generation & 1] = std::move(aead_result.ValueOrDie());
+  generation_.store(generation, std::memory_order_release);
+  Status status = Status::OK;
+  for (int i = 0; i < options_.num_shards; ++i) {
+    Status shard_status = RekeyShard(shards_[i], generation);
+    if (status.ok()) status = shard_status;
+  }
+  return status;
+}
+
+Status EncryptedCache::RekeyShard(Shard& shard, uint32_t generation) {
+  absl::MutexLock lock(&shard.mutex);
+  const Aead& old_aead = AeadOf(generation - 1);
+  const Aead& new_aead = AeadOf(generation);
+  Status status = Status::OK;
+  std::vector<std::string> failed_keys;
+  std::vector<std::pair<absl::string_view, Entry*>> batch;
+  std::vector<absl::string_view> plaintexts;
+  std::vector<absl::string_view> keys;
+  std::vector<absl::Span<char>> ciphertexts;
+  SecretData plaintext_buffer;
+  auto it = shard.entries.begin();
+  while (it != shard.entries.end()) {
+    // Collects the next batch of values of the old generation.
+    batch.clear();
+    int64_t batch_bytes = 0;
+    for (; it != shard.entries.end() &&
+           batch.size() < static_cast<size_t>(kRekeyBatchSize) &&
+           batch_bytes < kMaxRekeyBatchBytes;
+         ++it) {
+      if (it->second.generation == generation) continue;
+      batch.emplace_back(it->first, &it->second);
+      batch_bytes += it->second.size - overhead_;
+    }
+    if (batch.empty()) break;
+    plaintext_buffer.resize(std::max<int64_t>(plaintext_buffer.size(),
+                                              batch_bytes));
+    plaintexts.clear();
+    keys.clear();
+    ciphertexts.clear();
+    char* plaintext = reinterpret_cast<char*>(plaintext_buffer.data());
+    for (const auto& key_and_entry : batch) {
+      Entry& entry = *key_and_entry.second;
+      auto written_result = old_aead.DecryptInto(
+          entry.ciphertext(), key_and_entry.first,
+          absl::MakeSpan(plaintext, entry.size - overhead_));
+      if (!written_result.ok()) {
+        if (status.ok()) status = written_result.status();
+        failed_keys.emplace_back(key_and_entry.first);
+        continue;
+      }
+      plaintexts.emplace_back(plaintext, written_result.ValueOrDie());
+      keys.push_back(key_and_entry.first);
+      ciphertexts.push_back(absl::MakeSpan(entry.data, entry.size));
+      entry.generation = generation;
+      plaintext += written_result.ValueOrDie();
+    }
+    Status batch_status =
+        new_aead.EncryptBatchInto(plaintexts, keys, ciphertexts);
+    SafeZeroMemory(reinterpret_cast<char*>(plaintext_buffer.data()),
+                   batch_bytes);
+    if (!batch_status.ok()) {
+      if (status.ok()) status = batch_status;
+      for (absl::string_view key : keys) failed_keys.emplace_back(key);
+    }
+  }
+  for (const std::string& key : failed_keys) {
+    auto failed = shard.entries.find(key);
+    shard.slabs.Deallocate(failed->second.data, failed->second.size);
+    shard.entries.erase(failed);
+  }
+  return status;
+}
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,131 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_ENCRYPTED_CACHE_H_
+#define TINK_UTIL_ENCRYPTED_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "tink/aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// An in-memory cache whose values are kept encrypted, for processes which
+// hold sensitive data (session state, PII) in large caches and must not
+// keep it in RAM in plaintext.
+//
+// Values are sealed with an ephemeral key which is generated when the
+// cache is created and never leaves it: AEGIS-256 where the CPU supports
+// it, and AES-256-GCM otherwise.  The cache key is the associated data, so
+// a value cannot be moved under another key.  Cache keys themselves are
+// stored in plaintext, and must therefore not be sensitive.
+//
+// The cache is sharded by key, and each shard keeps its ciphertexts in
+// slabs of fixed-size blocks, so that Put() and Erase() of small values
+// do not go to the heap, and GetInto() decrypts directly into a buffer of
+// the caller.  Rekey() replaces the key, re-encrypting the values one
+// shard at a time, in batches.
+//
+// This class is thread-safe.
+class EncryptedCache {
+ public:
+  struct Options {
+    // The number of shards, each with a lock of its own.
+    int num_shards = 16;
+    // If false, AES-256-GCM is used even where AEGIS-256 is supported.
+    bool prefer_aegis = true;
+  };
+
+  // Values up to this size are kept in slabs; larger values are allocated
+  // individually.
+  static constexpr int kMaxSlabBlockSize = 4096;
+
+  static crypto::tink::util::StatusOr<std::unique_ptr<EncryptedCache>> New(
+      const Options& options);
+
+  ~EncryptedCache();
+
+  // Stores 'value' under 'key', replacing the previous value, if any.
+  crypto::tink::util::Status Put(absl::string_view key,
+                                 absl::string_view value);
+
+  // Returns the value stored under 'key', or NOT_FOUND.
+  crypto::tink::util::StatusOr<std::string> Get(absl::string_view key) const;
+
+  // Decrypts the value stored under 'key' into 'buffer' and returns its
+  // size.  Fails with NOT_FOUND if there is no such value, and with
+  // INVALID_ARGUMENT if 'buffer' is too small for it.
+  crypto::tink::util::StatusOr<int64_t> GetInto(absl::string_view key,
+                                                absl::Span<char> buffer) const;
+
+  // Removes the value stored under 'key'.  Returns whether there was one.
+  bool Erase(absl::string_view key);
+
+  // Returns the number of values in the cache.
+  int64_t size() const;
+
+  // Replaces the key of the cache with a fresh one, and re-encrypts all
+  // values with it.  The shards are re-encrypted one at a time, so that
+  // only the callers of the shard being re-encrypted wait, and the values
+  // of a shard in batches of up to kRekeyBatchSize.  Values which cannot
+  // be re-encrypted are dropped, and the first error is returned.
+  // Concurrent calls are serialized.
+  crypto::tink::util::Status Rekey();
+
+  static constexpr int kRekeyBatchSize = 256;
+
+ private:
+  struct Shard;
+
+  EncryptedCache(const Options& options, std::unique_ptr<Aead> aead,
+                 int64_t overhead);
+
+  Shard& ShardOf(absl::string_view key) const;
+  // Returns the Aead of the values of 'generation'.  The caller holds the
+  // lock of the shard of the value.
+  const Aead& AeadOf(uint32_t generation) const {
+    return *aeads_[generation & 1];
+  }
+  crypto::tink::util::Status RekeyShard(Shard& shard, uint32_t generation);
+
+  const Options options_;
+  // The size of a ciphertext minus that of its plaintext.
+  const int64_t overhead_;
+  std::unique_ptr<Shard[]> shards_;
+  // Values encrypted under the current generation use
+  // aeads_[generation_ & 1].  Rekey() increments generation_ and installs
+  // the new Aead in the other slot, which the previous Rekey() left
+  // without values.
+  std::unique_ptr<Aead> aeads_[2];
+  std::atomic<uint32_t> generation_{0};
+  absl::Mutex rekey_mutex_;
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_ENCRYPTED_CACHE_H_
@@ -0,0 +1,155 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/encrypted_cache.h"
+
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+
+class EncryptedCacheTest : public ::testing::TestWithParam<bool> {
+ protected:
+  std::unique_ptr<EncryptedCache> NewCache() {
+    EncryptedCache::Options options;
+    options.num_shards = 4;
+    options.prefer_aegis = GetParam();
+    auto cache_result = EncryptedCache::New(options);
+    EXPECT_THAT(cache_result.status(), IsOk());
+    return std::move(cache_result.ValueOrDie());
+  }
+};
+
+TEST_P(EncryptedCacheTest, PutGetErase) {
+  auto cache = NewCache();
+  EXPECT_THAT(cache->Get("missing").status(), StatusIs(error::NOT_FOUND));
+
+  ASSERT_THAT(cache->Put("a", "value of a"), IsOk());
+  ASSERT_THAT(cache->Put("b", ""), IsOk());
+  EXPECT_EQ(2, cache->size());
+  EXPECT_EQ("value of a", cache->Get("a").ValueOrDie());
+  EXPECT_EQ("", cache->Get("b").ValueOrDie());
+
+  EXPECT_TRUE(cache->Erase("a"));
+  EXPECT_FALSE(cache->Erase("a"));
+  EXPECT_THAT(cache->Get("a").status(), StatusIs(error::NOT_FOUND));
+  EXPECT_EQ(1, cache->size());
+}
+
+TEST_P(EncryptedCacheTest, Replace) {
+  auto cache = NewCache();
+  // Replaces values within a size class, across size classes and beyond
+  // the slabs.
+  const std::vector<std::string> values = {
+      "short", "also short", std::string(1000, 'x'),
+      std::string(EncryptedCache::kMaxSlabBlockSize * 2, 'y'), "short again"};
+  for (const std::string& value : values) {
+    ASSERT_THAT(cache->Put("key", value), IsOk());
+    EXPECT_EQ(value, cache->Get("key").ValueOrDie());
+  }
+  EXPECT_EQ(1, cache->size());
+}
+
+TEST_P(EncryptedCacheTest, GetInto) {
+  auto cache = NewCache();
+  ASSERT_THAT(cache->Put("key", "some value"), IsOk());
+
+  char buffer[10];
+  auto size_result = cache->GetInto("key", absl::MakeSpan(buffer));
+  ASSERT_THAT(size_result.status(), IsOk());
+  EXPECT_EQ("some value", std::string(buffer, size_result.ValueOrDie()));
+
+  EXPECT_THAT(cache->GetInto("key", absl::MakeSpan(buffer, 9)).status(),
+              StatusIs(error::INVALID_ARGUMENT));
+  EXPECT_THAT(cache->GetInto("other", absl::MakeSpan(buffer)).status(),
+              StatusIs(error::NOT_FOUND));
+}
+
+TEST_P(EncryptedCacheTest, Rekey) {
+  auto cache = NewCache();
+  // More values than fit into one batch of a shard.
+  const int kNumValues = 4 * EncryptedCache::kRekeyBatchSize + 10;
+  for (int i = 0; i < kNumValues; ++i) {
+    ASSERT_THAT(cache->Put(absl::StrCat("key", i), absl::StrCat("value", i)),
+                IsOk());
+  }
+  for (int round = 0; round < 3; ++round) {
+    ASSERT_THAT(cache->Rekey(), IsOk());
+    // New values are encrypted with the new key.
+    ASSERT_THAT(cache->Put("new", absl::StrCat("round", round)), IsOk());
+  }
+  EXPECT_EQ(kNumValues + 1, cache->size());
+  for (int i = 0; i < kNumValues; ++i) {
+    EXPECT_EQ(absl::StrCat("value", i),
+              cache->Get(absl::StrCat("key", i)).ValueOrDie());
+  }
+  EXPECT_EQ("round2", cache->Get("new").ValueOrDie());
+}
+
+TEST_P(EncryptedCacheTest, ConcurrentAccessAndRekey) {
+  auto cache = NewCache();
+  const int kNumThreads = 4;
+  const int kNumValues = 200;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int i = 0; i < kNumValues; ++i) {
+        std::string key = absl::StrCat(t, "/", i);
+        ASSERT_THAT(cache->Put(key, absl::StrCat("value", i)), IsOk());
+        ASSERT_EQ(absl::StrCat("value", i), cache->Get(key).ValueOrDie());
+      }
+    });
+  }
+  threads.emplace_back([&cache]() {
+    for (int i = 0; i < 10; ++i) ASSERT_THAT(cache->Rekey(), IsOk());
+  });
+  for (std::thread& thread : threads) thread.join();
+  EXPECT_EQ(kNumThreads * kNumValues, cache->size());
+  for (int t = 0; t < kNumThreads; ++t) {
+    for (int i = 0; i < kNumValues; ++i) {
+      EXPECT_EQ(absl::StrCat("value", i),
+                cache->Get(absl::StrCat(t, "/", i)).ValueOrDie());
+    }
+  }
+}
+
+TEST(EncryptedCacheOptionsTest, InvalidNumShards) {
+  EncryptedCache::Options options;
+  options.num_shards = 0;
+  EXPECT_THAT(EncryptedCache::New(options).status(),
+              StatusIs(error::INVALID_ARGUMENT));
+}
+
+INSTANTIATE_TEST_SUITE_P(EncryptedCacheTests, EncryptedCacheTest,
+                         ::testing::Bool());
+
+}  // namespace
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
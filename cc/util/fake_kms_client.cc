@@ -13,16 +13,22 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "tink/util/fake_kms_client.h"
 
+#include <cmath>
 #include <fstream>
 #include <iostream>
+#include <random>
 #include <sstream>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/memory/memory.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
 #include "tink/aead/aead_key_templates.h"
 #include "tink/binary_keyset_reader.h"
 #include "tink/binary_keyset_writer.h"
@@ -52,13 +58,134 @@ std::string GetEncodedKeyset(absl::string_view key_uri) {
   return std::string(key_uri.substr(std::string(kKeyUriPrefix).length()));
 }
 
+// The 99th percentile of the standard normal distribution.
+constexpr double kNormalP99 = 2.3263478740408408;
+
+Status ValidateSimulationOptions(
+    const FakeKmsClient::SimulationOptions& simulation) {
+  if (simulation.median_latency < absl::ZeroDuration() ||
+      simulation.p99_latency < absl::ZeroDuration()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "Latencies must not be negative");
+  }
+  if (!(simulation.error_rate >= 0 && simulation.error_rate <= 1)) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "error_rate must be in [0, 1]");
+  }
+  if (simulation.max_concurrent_requests < 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "max_concurrent_requests must not be negative");
+  }
+  return Status::OK;
+}
+
 }  // namespace
 
+class FakeKmsClient::Simulation {
+ public:
+  explicit Simulation(const SimulationOptions& options)
+      : options_(options), random_(options.seed) {
+    if (options.median_latency > absl::ZeroDuration() &&
+        options.p99_latency > options.median_latency) {
+      latency_mu_ = std::log(absl::ToDoubleNanoseconds(options.median_latency));
+      latency_sigma_ = std::log(absl::FDivDuration(options.p99_latency,
+                                                   options.median_latency)) /
+                       kNormalP99;
+    }
+  }
+
+  // Waits for a free slot and for the latency of an operation, and returns
+  // UNAVAILABLE if the operation is to fail.
+  Status Request() {
+    absl::Duration latency = options_.median_latency;
+    bool fail;
+    {
+      absl::MutexLock lock(&mutex_);
+      num_requests_++;
+      if (options_.max_concurrent_requests > 0) {
+        mutex_.Await(absl::Condition(this, &Simulation::HasFreeSlot));
+      }
+      in_flight_++;
+      if (latency_sigma_ > 0) {
+        std::lognormal_distribution<double> distribution(latency_mu_,
+                                                         latency_sigma_);
+        latency = absl::Nanoseconds(distribution(random_));
+      }
+      fail = std::bernoulli_distribution(options_.error_rate)(random_);
+    }
+    absl::SleepFor(latency);
+    {
+      absl::MutexLock lock(&mutex_);
+      in_flight_--;
+    }
+    if (fail) {
+      return Status(util::error::UNAVAILABLE, "Simulated KMS failure");
+    }
+    return Status::OK;
+  }
+
+  int64_t num_requests() const {
+    absl::MutexLock lock(&mutex_);
+    return num_requests_;
+  }
+
+ private:
+  bool HasFreeSlot() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return in_flight_ < options_.max_concurrent_requests;
+  }
+
+  const SimulationOptions options_;
+  // The parameters of the log-normal distribution of the latencies; with
+  // 'latency_sigma_' 0 every operation takes the median latency.
+  double latency_mu_ = 0;
+  double latency_sigma_ = 0;
+  mutable absl::Mutex mutex_;
+  std::mt19937_64 random_ ABSL_GUARDED_BY(mutex_);
+  int in_flight_ ABSL_GUARDED_BY(mutex_) = 0;
+  int64_t num_requests_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+class FakeKmsClient::SimulatedAead : public Aead {
+ public:
+  SimulatedAead(std::unique_ptr<Aead> aead,
+                std::shared_ptr<Simulation> simulation)
+      : aead_(std::move(aead)), simulation_(std::move(simulation)) {}
+
+  StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override {
+    Status status = simulation_->Request();
+    if (!status.ok()) return status;
+    return aead_->Encrypt(plaintext, associated_data);
+  }
+
+  StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override {
+    Status status = simulation_->Request();
+    if (!status.ok()) return status;
+    return aead_->Decrypt(ciphertext, associated_data);
+  }
+
+ private:
+  const std::unique_ptr<Aead> aead_;
+  const std::shared_ptr<Simulation> simulation_;
+};
 
 // static
 StatusOr<std::unique_ptr<FakeKmsClient>> FakeKmsClient::New(
     absl::string_view key_uri, absl::string_view credentials_path) {
+  return New(key_uri, credentials_path, SimulationOptions());
+}
+
+// static
+StatusOr<std::unique_ptr<FakeKmsClient>> FakeKmsClient::New(
+    absl::string_view key_uri, absl::string_view credentials_path,
+    const SimulationOptions& simulation) {
+  Status status = ValidateSimulationOptions(simulation);
+  if (!status.ok()) return status;
   std::unique_ptr<FakeKmsClient> client(new FakeKmsClient());
+  client->simulation_ = std::make_shared<Simulation>(simulation);
 
   if (!key_uri.empty()) {
     client->encoded_keyset_ = GetEncodedKeyset(key_uri);
@@ -103,12 +230,29 @@ StatusOr<std::unique_ptr<Aead>> FakeKmsClient::GetAead(
   if (!handle_result.ok()) {
     return handle_result.status();
   }
-  return handle_result.ValueOrDie()->GetPrimitive<crypto::tink::Aead>();
+  auto aead_result =
+      handle_result.ValueOrDie()->GetPrimitive<crypto::tink::Aead>();
+  if (!aead_result.ok()) {
+    return aead_result.status();
+  }
+  return {absl::make_unique<SimulatedAead>(
+      std::move(aead_result.ValueOrDie()), simulation_)};
+}
+
+int64_t FakeKmsClient::num_requests() const {
+  return simulation_->num_requests();
 }
 
 Status FakeKmsClient::RegisterNewClient(absl::string_view key_uri,
                                         absl::string_view credentials_path) {
-  auto client_result = FakeKmsClient::New(key_uri, credentials_path);
+  return RegisterNewClient(key_uri, credentials_path, SimulationOptions());
+}
+
+Status FakeKmsClient::RegisterNewClient(absl::string_view key_uri,
+                                        absl::string_view credentials_path,
+                                        const SimulationOptions& simulation) {
+  auto client_result =
+      FakeKmsClient::New(key_uri, credentials_path, simulation);
   if (!client_result.ok()) {
     return client_result.status();
   }
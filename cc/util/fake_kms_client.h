@@ -15,9 +15,12 @@
 #ifndef TINK_UTIL_FAKE_KMS_CLIENT_H_
 #define TINK_UTIL_FAKE_KMS_CLIENT_H_
 
+#include <cstdint>
 #include <memory>
+#include <string>
 
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "tink/aead.h"
 #include "tink/keyset_handle.h"
 #include "tink/kms_client.h"
@@ -38,8 +41,31 @@ namespace test {
 // by encoding the key in the 'key_uri'. So the client simply needs to decode
 // the key and generate an AEAD out of it. This is of course insecure and should
 // only be used in testing.
+//
+// To benchmark code which talks to a KMS, the client can simulate the
+// behavior of a remote KMS (see SimulationOptions): every operation of its
+// Aead-primitives then takes some time, may fail, and waits for a free slot
+// if too many operations are in flight.
 class FakeKmsClient : public crypto::tink::KmsClient {
  public:
+  struct SimulationOptions {
+    // The latency of each operation follows a log-normal distribution with
+    // this median and 99th percentile, as the latencies of RPCs usually do.
+    // If 'p99_latency' is not larger than 'median_latency', every operation
+    // takes exactly 'median_latency'.
+    absl::Duration median_latency = absl::ZeroDuration();
+    absl::Duration p99_latency = absl::ZeroDuration();
+    // The fraction of operations which fail with UNAVAILABLE, after their
+    // latency.
+    double error_rate = 0;
+    // The maximal number of operations in flight, over all Aeads of the
+    // client; further operations wait until one of them finishes, as
+    // with a quota of the KMS. 0 means no limit.
+    int max_concurrent_requests = 0;
+    // The seed of the random latencies and errors.
+    uint64_t seed = 0;
+  };
+
   // Creates a new FakeKmsClient that is bound to the key specified in
   // 'key_uri'.
   //
@@ -49,10 +75,22 @@ class FakeKmsClient : public crypto::tink::KmsClient {
   static crypto::tink::util::StatusOr<std::unique_ptr<FakeKmsClient>> New(
       absl::string_view key_uri, absl::string_view credentials_path);
 
+  // Like New() above, but the client simulates a remote KMS as specified by
+  // 'simulation'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<FakeKmsClient>> New(
+      absl::string_view key_uri, absl::string_view credentials_path,
+      const SimulationOptions& simulation);
+
   // Creates a new client and registers it in KMSClients.
   static crypto::tink::util::Status RegisterNewClient(
       absl::string_view key_uri, absl::string_view credentials_path);
 
+  // Like RegisterNewClient() above, but the client simulates a remote KMS as
+  // specified by 'simulation'.
+  static crypto::tink::util::Status RegisterNewClient(
+      absl::string_view key_uri, absl::string_view credentials_path,
+      const SimulationOptions& simulation);
+
   // Returns a new, random fake key_uri.
   static crypto::tink::util::StatusOr<std::string> CreateFakeKeyUri();
 
@@ -64,9 +102,20 @@ class FakeKmsClient : public crypto::tink::KmsClient {
   crypto::tink::util::StatusOr<std::unique_ptr<Aead>>
   GetAead(absl::string_view key_uri) const override;
 
+  // Returns the number of operations of the Aeads of this client so far,
+  // including the failed ones, e.g. to count the requests to the KMS of a
+  // benchmark.
+  int64_t num_requests() const;
+
  private:
+  // The simulated KMS, which the Aeads of the client share, and an Aead
+  // which goes through it.
+  class Simulation;
+  class SimulatedAead;
+
   FakeKmsClient() {}
   std::string encoded_keyset_;
+  std::shared_ptr<Simulation> simulation_;
 };
 
 }  // namespace test
@@ -14,11 +14,15 @@
 
 #include "tink/util/fake_kms_client.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "tink/aead/aead_config.h"
 #include "tink/aead/aead_key_templates.h"
 #include "tink/util/status.h"
@@ -29,6 +33,7 @@
 #include "proto/kms_envelope.pb.h"
 
 using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::KmsAeadKeyFormat;
 using google::crypto::tink::KmsEnvelopeAeadKeyFormat;
@@ -187,6 +192,107 @@ TEST_F(FakeKmsClientTest, RegisterAndEncryptDecryptWithKmsEnvelopeAead) {
   EXPECT_EQ(plaintext, decrypt_result.ValueOrDie());
 }
 
+std::unique_ptr<FakeKmsClient> NewSimulatedClient(
+    const std::string& key_uri,
+    const FakeKmsClient::SimulationOptions& simulation) {
+  auto client_result = FakeKmsClient::New(key_uri, "", simulation);
+  EXPECT_TRUE(client_result.ok()) << client_result.status();
+  return std::move(client_result.ValueOrDie());
+}
+
+TEST_F(FakeKmsClientTest, SimulatedLatency) {
+  std::string key_uri = FakeKmsClient::CreateFakeKeyUri().ValueOrDie();
+  FakeKmsClient::SimulationOptions simulation;
+  simulation.median_latency = absl::Milliseconds(20);
+  auto client = NewSimulatedClient(key_uri, simulation);
+  auto aead = std::move(client->GetAead(key_uri).ValueOrDie());
+
+  absl::Time start = absl::Now();
+  std::string ciphertext = aead->Encrypt("plaintext", "aad").ValueOrDie();
+  EXPECT_EQ(aead->Decrypt(ciphertext, "aad").ValueOrDie(), "plaintext");
+  EXPECT_GE(absl::Now() - start, absl::Milliseconds(40));
+  EXPECT_EQ(client->num_requests(), 2);
+}
+
+TEST_F(FakeKmsClientTest, SimulatedLatencyDistribution) {
+  std::string key_uri = FakeKmsClient::CreateFakeKeyUri().ValueOrDie();
+  FakeKmsClient::SimulationOptions simulation;
+  simulation.median_latency = absl::Microseconds(100);
+  simulation.p99_latency = absl::Milliseconds(1);
+  auto client = NewSimulatedClient(key_uri, simulation);
+  auto aead = std::move(client->GetAead(key_uri).ValueOrDie());
+
+  std::vector<absl::Duration> latencies;
+  for (int i = 0; i < 200; i++) {
+    absl::Time start = absl::Now();
+    ASSERT_THAT(aead->Encrypt("plaintext", "aad").status(), IsOk());
+    latencies.push_back(absl::Now() - start);
+  }
+  std::sort(latencies.begin(), latencies.end());
+  // Sleeping takes at least as long as requested, so only the lower bounds
+  // are checked.
+  EXPECT_GE(latencies[100], absl::Microseconds(50));
+  EXPECT_GE(latencies[199], absl::Microseconds(200));
+}
+
+TEST_F(FakeKmsClientTest, SimulatedErrors) {
+  std::string key_uri = FakeKmsClient::CreateFakeKeyUri().ValueOrDie();
+  FakeKmsClient::SimulationOptions simulation;
+  simulation.error_rate = 1;
+  auto aead = std::move(
+      NewSimulatedClient(key_uri, simulation)->GetAead(key_uri).ValueOrDie());
+  EXPECT_THAT(aead->Encrypt("plaintext", "aad").status(),
+              StatusIs(util::error::UNAVAILABLE));
+
+  simulation.error_rate = 0.5;
+  aead = std::move(
+      NewSimulatedClient(key_uri, simulation)->GetAead(key_uri).ValueOrDie());
+  int num_errors = 0;
+  for (int i = 0; i < 1000; i++) {
+    if (!aead->Encrypt("plaintext", "aad").ok()) num_errors++;
+  }
+  EXPECT_GT(num_errors, 400);
+  EXPECT_LT(num_errors, 600);
+}
+
+TEST_F(FakeKmsClientTest, SimulatedConcurrencyLimit) {
+  std::string key_uri = FakeKmsClient::CreateFakeKeyUri().ValueOrDie();
+  FakeKmsClient::SimulationOptions simulation;
+  simulation.median_latency = absl::Milliseconds(10);
+  simulation.max_concurrent_requests = 2;
+  auto client = NewSimulatedClient(key_uri, simulation);
+  auto aead = std::move(client->GetAead(key_uri).ValueOrDie());
+
+  absl::Time start = absl::Now();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&aead]() {
+      EXPECT_THAT(aead->Encrypt("plaintext", "aad").status(), IsOk());
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  // 8 requests, at most 2 at a time.
+  EXPECT_GE(absl::Now() - start, absl::Milliseconds(40));
+  EXPECT_EQ(client->num_requests(), 8);
+}
+
+TEST_F(FakeKmsClientTest, InvalidSimulationOptions) {
+  FakeKmsClient::SimulationOptions simulation;
+  simulation.error_rate = 1.5;
+  EXPECT_THAT(FakeKmsClient::New("", "", simulation).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  simulation.error_rate = 0;
+  simulation.median_latency = -absl::Seconds(1);
+  EXPECT_THAT(FakeKmsClient::New("", "", simulation).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  simulation.median_latency = absl::ZeroDuration();
+  simulation.max_concurrent_requests = -1;
+  EXPECT_THAT(FakeKmsClient::New("", "", simulation).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 // TODO(b/174740983): Add test where an unbounded KeyClient is registered.
 // This is not yet implemented as it would break the isolation of the tests:
 // Once a unbounded client is registered, it can't currently be unregistered.
@@ -18,8 +18,10 @@
 
 #include <unistd.h>
 #include <algorithm>
+#include <cstring>
 
 #include "absl/memory/memory.h"
+#include "absl/types/span.h"
 #include "tink/input_stream.h"
 #include "tink/util/errors.h"
 #include "tink/util/status.h"
@@ -94,6 +96,43 @@ crypto::tink::util::StatusOr<int> FileInputStream::Next(const void** data) {
   return count_in_buffer_;
 }
 
+crypto::tink::util::StatusOr<int> FileInputStream::ReadInto(
+    absl::Span<uint8_t> buffer) {
+  int count = 0;
+  int size = buffer.size();
+  while (count < size) {
+    if (status_.ok() && count_backedup_ == 0 && size - count >= buffer_size_) {
+      // Read directly into 'buffer', leaving buffer_ empty.
+      int read_result =
+          read_ignoring_eintr(fd_, buffer.data() + count, size - count);
+      if (read_result < 0) {
+        status_ =
+            ToStatusF(util::error::INTERNAL, "I/O error: %d", read_result);
+        return status_;
+      }
+      if (read_result == 0) {
+        status_ = Status(util::error::OUT_OF_RANGE, "EOF");
+        break;
+      }
+      count_in_buffer_ = 0;
+      buffer_offset_ = 0;
+      count += read_result;
+      position_ = position_ + read_result;
+      continue;
+    }
+    const void* data;
+    auto next_result = Next(&data);
+    if (next_result.status().error_code() == util::error::OUT_OF_RANGE) break;
+    if (!next_result.ok()) return next_result.status();
+    int available = next_result.ValueOrDie();
+    int needed = std::min(available, size - count);
+    std::memcpy(buffer.data() + count, data, needed);
+    count += needed;
+    BackUp(available - needed);
+  }
+  return count;
+}
+
 void FileInputStream::BackUp(int count) {
   if (!status_.ok() || count < 1 || count_backedup_ == count_in_buffer_) return;
   int actual_count = std::min(count, count_in_buffer_ - count_backedup_);
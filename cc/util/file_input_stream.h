@@ -19,6 +19,7 @@
 
 #include <memory>
 
+#include "absl/types/span.h"
 #include "tink/input_stream.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -40,6 +41,10 @@ class FileInputStream : public crypto::tink::InputStream {
 
   crypto::tink::util::StatusOr<int> Next(const void** data) override;
 
+  // Reads chunks of at least the buffer size directly into 'buffer'.
+  crypto::tink::util::StatusOr<int> ReadInto(
+      absl::Span<uint8_t> buffer) override;
+
   void BackUp(int count) override;
 
   int64_t Position() const override;
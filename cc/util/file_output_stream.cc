@@ -21,6 +21,7 @@
 #include <algorithm>
 
 #include "absl/memory/memory.h"
+#include "absl/types/span.h"
 #include "tink/output_stream.h"
 #include "tink/util/errors.h"
 #include "tink/util/status.h"
@@ -53,6 +54,26 @@ int write_ignoring_eintr(int fd, const void *buf, size_t count) {
   return result;
 }
 
+// Writes all 'count' bytes of data from 'buf' to file descriptor fd.
+Status write_fully(int fd, const uint8_t* buf, int64_t count) {
+  int64_t total_written = 0;
+  while (total_written < count) {
+    int write_result =
+        write_ignoring_eintr(fd, buf + total_written, count - total_written);
+    if (write_result < 0) {  // An I/O error occurred.
+      return ToStatusF(util::error::INTERNAL, "I/O error upon write: %d",
+                       errno);
+    } else if (write_result == 0) {  // No progress, hence abort.
+      return ToStatusF(util::error::INTERNAL,
+                       "I/O error: failed to write %d bytes.",
+                       count - total_written);
+    }
+    // Managed to write some bytes, hence continue.
+    total_written += write_result;
+  }
+  return Status::OK;
+}
+
 }  // anonymous namespace
 
 
@@ -117,6 +138,27 @@ crypto::tink::util::StatusOr<int> FileOutputStream::Next(void** data) {
   return write_result;
 }
 
+Status FileOutputStream::WriteFrom(absl::Span<const uint8_t> data) {
+  if (!status_.ok()) return status_;
+  if (static_cast<int64_t>(data.size()) < buffer_size_) {
+    return OutputStream::WriteFrom(data);
+  }
+  // Write the buffered bytes and then 'data', and leave all of buffer_
+  // backed up.
+  if (count_in_buffer_ > 0) {
+    status_ = write_fully(fd_, buffer_.get(), count_in_buffer_);
+    if (!status_.ok()) return status_;
+  }
+  status_ = write_fully(fd_, data.data(), data.size());
+  if (!status_.ok()) return status_;
+  if (buffer_ == nullptr) buffer_ = absl::make_unique<uint8_t[]>(buffer_size_);
+  count_in_buffer_ = 0;
+  count_backedup_ = buffer_size_;
+  buffer_offset_ = 0;
+  position_ = position_ + data.size();
+  return Status::OK;
+}
+
 void FileOutputStream::BackUp(int count) {
   if (!status_.ok() || count < 1 || count_in_buffer_ == 0) return;
   int curr_buffer_size = buffer_size_ - buffer_offset_;
@@ -134,23 +176,8 @@ Status FileOutputStream::Close() {
   if (!status_.ok()) return status_;
   if (count_in_buffer_ > 0) {
     // Try to write the remaining bytes.
-    int total_written = 0;
-    while (total_written < count_in_buffer_) {
-      int write_result = write_ignoring_eintr(
-          fd_, buffer_.get() + total_written, count_in_buffer_ - total_written);
-      if (write_result < 0) {  // An I/O error occurred.
-        status_ = ToStatusF(
-            util::error::INTERNAL, "I/O error upon write: %d", errno);
-        return status_;
-      } else if (write_result == 0) {  // No progress, hence abort.
-        status_ = ToStatusF(util::error::INTERNAL,
-            "I/O error: failed to write %d bytes before closing.",
-            count_in_buffer_ - total_written);
-        return status_;
-      }
-      // Managed to write some bytes, hence continue.
-      total_written += write_result;
-    }
+    status_ = write_fully(fd_, buffer_.get(), count_in_buffer_);
+    if (!status_.ok()) return status_;
   }
   if (close_ignoring_eintr(fd_) == -1) {
     status_ = ToStatusF(
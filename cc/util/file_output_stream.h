@@ -19,6 +19,7 @@
 
 #include <memory>
 
+#include "absl/types/span.h"
 #include "tink/output_stream.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -40,6 +41,10 @@ class FileOutputStream : public crypto::tink::OutputStream {
 
   crypto::tink::util::StatusOr<int> Next(void** data) override;
 
+  // Writes chunks of at least the buffer size directly from 'data'.
+  crypto::tink::util::Status WriteFrom(
+      absl::Span<const uint8_t> data) override;
+
   void BackUp(int count) override;
 
   crypto::tink::util::Status Close() override;
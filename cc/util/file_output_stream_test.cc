@@ -20,6 +20,7 @@
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/subtle/random.h"
 #include "tink/util/test_util.h"
 
@@ -177,6 +178,44 @@ TEST_F(FileOutputStreamTest, BackupAndPosition) {
   EXPECT_EQ(stream_contents, file_contents);
 }
 
+TEST_F(FileOutputStreamTest, WriteFrom) {
+  int stream_size = 100000;
+  int buffer_size = 1000;
+  std::string stream_contents = subtle::Random::GetRandomBytes(stream_size);
+  std::string filename = absl::StrCat(buffer_size, "_write_from_test.bin");
+  int output_fd = test::GetTestFileDescriptor(filename);
+  auto output_stream =
+      absl::make_unique<util::FileOutputStream>(output_fd, buffer_size);
+  int written = 0;
+  for (int write_size : {0, 10, 5000, 999, 1000, 1, 30000}) {
+    SCOPED_TRACE(absl::StrCat("write_size = ", write_size));
+    auto status = output_stream->WriteFrom(absl::MakeConstSpan(
+        reinterpret_cast<const uint8_t*>(stream_contents.data()) + written,
+        write_size));
+    EXPECT_TRUE(status.ok()) << status;
+    written += write_size;
+    EXPECT_EQ(written, output_stream->Position());
+
+    // Next() and BackUp() still work in between.
+    void* buffer;
+    auto next_result = output_stream->Next(&buffer);
+    EXPECT_TRUE(next_result.ok()) << next_result.status();
+    int next_count = next_result.ValueOrDie() - next_result.ValueOrDie() / 2;
+    memcpy(buffer, stream_contents.data() + written, next_count);
+    output_stream->BackUp(next_result.ValueOrDie() / 2);
+    written += next_count;
+    EXPECT_EQ(written, output_stream->Position());
+  }
+  auto status = output_stream->WriteFrom(absl::MakeConstSpan(
+      reinterpret_cast<const uint8_t*>(stream_contents.data()) + written,
+      stream_size - written));
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(stream_size, output_stream->Position());
+  status = output_stream->Close();
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(stream_contents, test::ReadTestFile(filename));
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
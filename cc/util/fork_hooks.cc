@@ -0,0 +1,82 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/fork_hooks.h"
+
+#include <pthread.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "absl/base/const_init.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+namespace {
+
+std::atomic<uint64_t> fork_generation{0};
+
+// Held across fork(), so that the child finds the hooks in a consistent
+// state.
+ABSL_CONST_INIT absl::Mutex hooks_mutex(absl::kConstInit);
+
+std::vector<std::function<void()>>& Hooks()
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(hooks_mutex) {
+  static auto* hooks = new std::vector<std::function<void()>>();
+  return *hooks;
+}
+
+void OnForkPrepare() ABSL_NO_THREAD_SAFETY_ANALYSIS { hooks_mutex.Lock(); }
+
+void OnForkInParent() ABSL_NO_THREAD_SAFETY_ANALYSIS { hooks_mutex.Unlock(); }
+
+void OnForkInChild() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  fork_generation.fetch_add(1, std::memory_order_relaxed);
+  for (const std::function<void()>& hook : Hooks()) hook();
+  hooks_mutex.Unlock();
+}
+
+bool InstallForkHandlers() {
+  static const bool installed =
+      pthread_atfork(&OnForkPrepare, &OnForkInParent, &OnForkInChild) == 0;
+  return installed;
+}
+
+}  // namespace
+
+uint64_t ForkGeneration() {
+  InstallForkHandlers();
+  return fork_generation.load(std::memory_order_relaxed);
+}
+
+bool ForkHandlersInstalled() { return InstallForkHandlers(); }
+
+void AddPostForkChildHook(std::function<void()> hook) {
+  InstallForkHandlers();
+  absl::MutexLock lock(&hooks_mutex);
+  Hooks().push_back(std::move(hook));
+}
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
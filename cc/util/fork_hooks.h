@@ -0,0 +1,58 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_FORK_HOOKS_H_
+#define TINK_UTIL_FORK_HOOKS_H_
+
+#include <cstdint>
+#include <functional>
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// Support for processes which create their primitives once, and then
+// fork() into workers which share them copy-on-write, like prefork
+// servers do.
+//
+// State which must differ between the workers -- buffered random bytes,
+// precomputed nonces and ephemeral keys, nonce counters -- records the
+// fork generation when it is created, and is discarded or recreated when
+// it is used in a process of another generation.  BoringSSL reseeds its
+// own random number generator in the child.
+
+// Returns the number of fork()s which separate the calling process from
+// the one that first called a function of this file, i.e. a number which
+// changes in the child after every fork().  Only a relaxed atomic load.
+uint64_t ForkGeneration();
+
+// Returns false if the fork handlers could not be installed, in which case
+// ForkGeneration() never changes and the hooks never run.
+bool ForkHandlersInstalled();
+
+// Registers 'hook' to run in the child after every later fork(), before
+// fork() returns there, in the order of registration.  Hooks are meant for
+// state which cannot be checked lazily, e.g. to reconnect the client of a
+// remote service; they must not call AddPostForkChildHook().  The child of
+// a multi-threaded process has only the thread which called fork(), so
+// that hooks must not wait for locks which other threads may have held.
+void AddPostForkChildHook(std::function<void()> hook);
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_FORK_HOOKS_H_
@@ -0,0 +1,83 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/fork_hooks.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+namespace {
+
+// Runs 'child' in a forked child, and returns the string it returned.
+template <class F>
+std::string RunInChild(F child) {
+  int fds[2];
+  if (pipe(fds) != 0) return "";
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(fds[0]);
+    std::string output = child();
+    ssize_t written = write(fds[1], output.data(), output.size());
+    _exit(written == output.size() ? 0 : 1);
+  }
+  close(fds[1]);
+  std::string output;
+  char buffer[64];
+  ssize_t read_size;
+  while ((read_size = read(fds[0], buffer, sizeof(buffer))) > 0) {
+    output.append(buffer, read_size);
+  }
+  close(fds[0]);
+  int status;
+  waitpid(pid, &status, 0);
+  return output;
+}
+
+TEST(ForkHooksTest, HandlersAreInstalled) {
+  EXPECT_TRUE(ForkHandlersInstalled());
+}
+
+TEST(ForkHooksTest, GenerationChangesInChild) {
+  uint64_t parent_generation = ForkGeneration();
+  std::string output = RunInChild([parent_generation]() {
+    return std::string(ForkGeneration() != parent_generation ? "y" : "n");
+  });
+  EXPECT_EQ(output, "y");
+  EXPECT_EQ(ForkGeneration(), parent_generation);
+}
+
+TEST(ForkHooksTest, HooksRunInChildInOrder) {
+  static std::string* calls = new std::string();
+  AddPostForkChildHook([]() { calls->push_back('a'); });
+  AddPostForkChildHook([]() { calls->push_back('b'); });
+  std::string output = RunInChild([]() { return *calls; });
+  EXPECT_EQ(output, "ab");
+  // The hooks do not run in the parent.
+  EXPECT_EQ(*calls, "");
+}
+
+}  // namespace
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
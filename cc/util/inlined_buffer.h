@@ -0,0 +1,69 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_INLINED_BUFFER_H_
+#define TINK_UTIL_INLINED_BUFFER_H_
+
+#include <cstddef>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// A byte buffer which keeps up to N bytes inside the object, and only
+// allocates on the heap for larger contents. It is the output type of the
+// overloads of Aead::Encrypt(), DeterministicAead::EncryptDeterministically()
+// and Mac::ComputeMac() for short messages, which then need no heap
+// allocation when the buffer lives on the stack.
+//
+// Like std::string, the buffer may be reused for several messages; it keeps
+// its capacity.
+template <size_t N>
+class InlinedBuffer {
+ public:
+  InlinedBuffer() = default;
+
+  const char* data() const { return bytes_.data(); }
+  char* data() { return bytes_.data(); }
+  size_t size() const { return bytes_.size(); }
+  bool empty() const { return bytes_.empty(); }
+  size_t capacity() const { return bytes_.capacity(); }
+
+  // Sets the size of the buffer, keeping its first min(size, size()) bytes.
+  void resize(size_t size) { bytes_.resize(size); }
+  void clear() { bytes_.clear(); }
+  void assign(absl::string_view bytes) {
+    bytes_.assign(bytes.begin(), bytes.end());
+  }
+
+  absl::string_view AsStringView() const {
+    return absl::string_view(data(), size());
+  }
+  absl::Span<char> AsSpan() { return absl::MakeSpan(data(), size()); }
+
+ private:
+  absl::InlinedVector<char, N> bytes_;
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_INLINED_BUFFER_H_
@@ -0,0 +1,53 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/inlined_buffer.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+namespace {
+
+TEST(InlinedBufferTest, KeepsShortContentsInline) {
+  InlinedBuffer<16> buffer;
+  EXPECT_TRUE(buffer.empty());
+  buffer.assign("0123456789");
+  EXPECT_EQ(buffer.AsStringView(), "0123456789");
+  EXPECT_EQ(buffer.capacity(), 16);
+  buffer.resize(4);
+  EXPECT_EQ(buffer.AsStringView(), "0123");
+  buffer.AsSpan()[0] = 'x';
+  EXPECT_EQ(buffer.AsStringView(), "x123");
+}
+
+TEST(InlinedBufferTest, GrowsForLongContents) {
+  InlinedBuffer<16> buffer;
+  std::string long_contents(100, 'a');
+  buffer.assign(long_contents);
+  EXPECT_EQ(buffer.AsStringView(), long_contents);
+  EXPECT_GE(buffer.capacity(), 100);
+  buffer.clear();
+  EXPECT_TRUE(buffer.empty());
+}
+
+}  // namespace
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
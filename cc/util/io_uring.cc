@@ -0,0 +1,228 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/io_uring.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+// IORING_OP_READ and IORING_OP_WRITE came with Linux 5.6, as did
+// IORING_FEAT_RW_CUR_POS, which (unlike the enum values) is a macro.
+#if defined(IORING_FEAT_RW_CUR_POS) && defined(__NR_io_uring_setup)
+#define TINK_HAVE_IO_URING 1
+#endif
+#endif
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#include "absl/memory/memory.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+#ifdef TINK_HAVE_IO_URING
+
+namespace {
+
+unsigned* RingField(void* ring, uint32_t offset) {
+  return reinterpret_cast<unsigned*>(static_cast<uint8_t*>(ring) + offset);
+}
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<IoUring>> IoUring::New(int entries) {
+  struct io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  int ring_fd = syscall(__NR_io_uring_setup, entries, &params);
+  if (ring_fd < 0) {
+    return ToStatusF(util::error::UNIMPLEMENTED,
+                     "io_uring_setup failed: %d", errno);
+  }
+  auto ring = absl::WrapUnique(new IoUring());
+  ring->ring_fd_ = ring_fd;
+  if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+    return util::Status(util::error::UNIMPLEMENTED,
+                        "io_uring does not support reads and writes");
+  }
+
+  ring->sq_ring_size_ =
+      params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  ring->cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap) {
+    ring->sq_ring_size_ = std::max(ring->sq_ring_size_, ring->cq_ring_size_);
+  }
+  void* sq_ring = mmap(nullptr, ring->sq_ring_size_, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+  if (sq_ring == MAP_FAILED) {
+    return ToStatusF(util::error::UNIMPLEMENTED,
+                     "Mapping the io_uring failed: %d", errno);
+  }
+  ring->sq_ring_ = sq_ring;
+  if (single_mmap) {
+    ring->cq_ring_ = sq_ring;
+  } else {
+    void* cq_ring =
+        mmap(nullptr, ring->cq_ring_size_, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+    if (cq_ring == MAP_FAILED) {
+      return ToStatusF(util::error::UNIMPLEMENTED,
+                       "Mapping the io_uring failed: %d", errno);
+    }
+    ring->cq_ring_ = cq_ring;
+  }
+  ring->sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  void* sqes = mmap(nullptr, ring->sqes_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    return ToStatusF(util::error::UNIMPLEMENTED,
+                     "Mapping the io_uring failed: %d", errno);
+  }
+  ring->sqes_ = sqes;
+
+  ring->sq_tail_ = RingField(ring->sq_ring_, params.sq_off.tail);
+  ring->sq_mask_ = *RingField(ring->sq_ring_, params.sq_off.ring_mask);
+  ring->sq_array_ = RingField(ring->sq_ring_, params.sq_off.array);
+  ring->cq_head_ = RingField(ring->cq_ring_, params.cq_off.head);
+  ring->cq_tail_ = RingField(ring->cq_ring_, params.cq_off.tail);
+  ring->cq_mask_ = *RingField(ring->cq_ring_, params.cq_off.ring_mask);
+  ring->cqes_ = RingField(ring->cq_ring_, params.cq_off.cqes);
+  return std::move(ring);
+}
+
+IoUring::~IoUring() {
+  if (sqes_ != nullptr) munmap(sqes_, sqes_size_);
+  if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_ != nullptr) munmap(sq_ring_, sq_ring_size_);
+  if (ring_fd_ >= 0) close(ring_fd_);
+}
+
+void IoUring::Queue(uint8_t opcode, int fd, uint64_t address, size_t count,
+                    int64_t offset, uint64_t user_data) {
+  // Only this process writes the submission queue tail.
+  unsigned tail = *sq_tail_;
+  unsigned index = tail & sq_mask_;
+  struct io_uring_sqe* sqe = static_cast<struct io_uring_sqe*>(sqes_) + index;
+  std::memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = opcode;
+  sqe->fd = fd;
+  sqe->addr = address;
+  sqe->len = count;
+  sqe->off = offset;
+  sqe->user_data = user_data;
+  sq_array_[index] = index;
+  // Publishes the entry to the kernel.
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  to_submit_++;
+}
+
+void IoUring::QueueRead(int fd, void* buffer, size_t count, int64_t offset,
+                        uint64_t user_data) {
+  Queue(IORING_OP_READ, fd, reinterpret_cast<uint64_t>(buffer), count, offset,
+        user_data);
+}
+
+void IoUring::QueueWrite(int fd, const void* buffer, size_t count,
+                         int64_t offset, uint64_t user_data) {
+  Queue(IORING_OP_WRITE, fd, reinterpret_cast<uint64_t>(buffer), count,
+        offset, user_data);
+}
+
+int IoUring::Enter(unsigned min_complete, unsigned flags) {
+  int result;
+  do {
+    result = syscall(__NR_io_uring_enter, ring_fd_, to_submit_, min_complete,
+                     flags, nullptr, 0);
+  } while (result < 0 && errno == EINTR);
+  if (result > 0) to_submit_ -= result;
+  return result;
+}
+
+util::Status IoUring::Submit() {
+  while (to_submit_ > 0) {
+    if (Enter(0, 0) < 0) {
+      return ToStatusF(util::error::INTERNAL, "io_uring_enter failed: %d",
+                       errno);
+    }
+  }
+  return util::Status::OK;
+}
+
+util::StatusOr<IoUring::Completion> IoUring::WaitForCompletion() {
+  while (true) {
+    // Only this process writes the completion queue head.
+    unsigned head = *cq_head_;
+    if (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+      const struct io_uring_cqe& cqe =
+          static_cast<struct io_uring_cqe*>(cqes_)[head & cq_mask_];
+      Completion completion = {cqe.user_data, cqe.res};
+      __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+      return completion;
+    }
+    if (Enter(1, IORING_ENTER_GETEVENTS) < 0) {
+      return ToStatusF(util::error::INTERNAL, "io_uring_enter failed: %d",
+                       errno);
+    }
+  }
+}
+
+#else  // TINK_HAVE_IO_URING
+
+util::StatusOr<std::unique_ptr<IoUring>> IoUring::New(int entries) {
+  return util::Status(util::error::UNIMPLEMENTED,
+                      "io_uring is not available on this platform");
+}
+
+IoUring::~IoUring() {}
+
+void IoUring::Queue(uint8_t opcode, int fd, uint64_t address, size_t count,
+                    int64_t offset, uint64_t user_data) {}
+
+void IoUring::QueueRead(int fd, void* buffer, size_t count, int64_t offset,
+                        uint64_t user_data) {}
+
+void IoUring::QueueWrite(int fd, const void* buffer, size_t count,
+                         int64_t offset, uint64_t user_data) {}
+
+int IoUring::Enter(unsigned min_complete, unsigned flags) { return -1; }
+
+util::Status IoUring::Submit() {
+  return util::Status(util::error::UNIMPLEMENTED, "io_uring not available");
+}
+
+util::StatusOr<IoUring::Completion> IoUring::WaitForCompletion() {
+  return util::Status(util::error::UNIMPLEMENTED, "io_uring not available");
+}
+
+#endif  // TINK_HAVE_IO_URING
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
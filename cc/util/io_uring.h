@@ -0,0 +1,101 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_IO_URING_H_
+#define TINK_UTIL_IO_URING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// A minimal wrapper around a Linux io_uring instance, which supports
+// positional reads and writes only. It talks to the kernel directly, so it
+// does not need liburing. On other platforms, and on kernels without
+// io_uring (or where it is blocked, e.g. by seccomp), New() fails with
+// UNIMPLEMENTED, and callers are expected to fall back to blocking I/O.
+//
+// Usage: queue requests with QueueRead()/QueueWrite(), start them with
+// Submit(), and collect their results with WaitForCompletion(). The caller
+// must not have more than 'entries' requests queued or in flight.
+//
+// Thread safety: an IoUring must not be used concurrently.
+class IoUring {
+ public:
+  struct Completion {
+    uint64_t user_data;
+    // The number of bytes transferred, or -errno on failure.
+    int result;
+  };
+
+  static util::StatusOr<std::unique_ptr<IoUring>> New(int entries);
+
+  ~IoUring();
+
+  // Queues a read of 'count' bytes at 'offset' of 'fd' into 'buffer'.
+  void QueueRead(int fd, void* buffer, size_t count, int64_t offset,
+                 uint64_t user_data);
+
+  // Queues a write of 'count' bytes from 'buffer' at 'offset' of 'fd'.
+  void QueueWrite(int fd, const void* buffer, size_t count, int64_t offset,
+                  uint64_t user_data);
+
+  // Hands all queued requests to the kernel.
+  util::Status Submit();
+
+  // Submits all queued requests, and waits until one of the submitted
+  // requests is complete.
+  util::StatusOr<Completion> WaitForCompletion();
+
+ private:
+  IoUring() {}
+
+  void Queue(uint8_t opcode, int fd, uint64_t address, size_t count,
+             int64_t offset, uint64_t user_data);
+  int Enter(unsigned min_complete, unsigned flags);
+
+  int ring_fd_ = -1;
+  int to_submit_ = 0;
+
+  // Memory shared with the kernel: the submission and completion rings,
+  // and the array of submission queue entries.
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  void* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  unsigned* sq_tail_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned* sq_array_ = nullptr;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  void* cqes_ = nullptr;
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_IO_URING_H_
@@ -0,0 +1,255 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/io_uring_file_input_stream.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+
+#include "absl/memory/memory.h"
+#include "tink/input_stream.h"
+#include "tink/util/errors.h"
+#include "tink/util/io_uring.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+namespace {
+
+constexpr int kDefaultChunkSize = 128 * 1024;  // 128 KB
+constexpr int kDefaultQueueDepth = 4;
+// Alignment of buffers, offsets and sizes that is sufficient for O_DIRECT.
+constexpr int kDirectIoAlignment = 4096;
+
+// Attempts to close file descriptor fd, while ignoring EINTR.
+// (code borrowed from ZeroCopy-streams)
+int close_ignoring_eintr(int fd) {
+  int result;
+  do {
+    result = close(fd);
+  } while (result < 0 && errno == EINTR);
+  return result;
+}
+
+// Attempts to read 'count' bytes of data data from file descriptor fd
+// to 'buf' while ignoring EINTR.
+int read_ignoring_eintr(int fd, void *buf, size_t count) {
+  int result;
+  do {
+    result = read(fd, buf, count);
+  } while (result < 0 && errno == EINTR);
+  return result;
+}
+
+}  // anonymous namespace
+
+IoUringFileInputStream::IoUringFileInputStream(int file_descriptor,
+                                               int chunk_size,
+                                               int queue_depth)
+    : fd_(file_descriptor),
+      chunk_size_(chunk_size > 0 ? chunk_size : kDefaultChunkSize),
+      alignment_(1),
+      head_(0),
+      head_returned_(false),
+      next_offset_(0),
+      position_(0),
+      buffer_(nullptr),
+      count_in_buffer_(0),
+      count_backedup_(0),
+      buffer_offset_(0) {
+  status_ = Status::OK;
+  int flags = fcntl(fd_, F_GETFL);
+#ifdef O_DIRECT
+  if (flags != -1 && (flags & O_DIRECT)) {
+    alignment_ = kDirectIoAlignment;
+    chunk_size_ = (chunk_size_ + alignment_ - 1) / alignment_ * alignment_;
+  }
+#endif
+  int depth = queue_depth > 0 ? queue_depth : kDefaultQueueDepth;
+  off_t start = lseek(fd_, 0, SEEK_CUR);
+  if (start >= 0) {
+    auto ring_result = IoUring::New(depth);
+    if (ring_result.ok()) {
+      ring_ = std::move(ring_result.ValueOrDie());
+      next_offset_ = start;
+    }
+  }
+  if (ring_ == nullptr) {
+    depth = 1;
+#ifdef O_DIRECT
+    // Blocking reads continue at unaligned positions after short reads,
+    // which O_DIRECT does not allow.
+    if (alignment_ > 1) {
+      fcntl(fd_, F_SETFL, flags & ~O_DIRECT);
+      alignment_ = 1;
+    }
+#endif
+  }
+
+  buffers_ = absl::make_unique<uint8_t[]>(
+      static_cast<size_t>(depth) * chunk_size_ + alignment_);
+  uintptr_t base = reinterpret_cast<uintptr_t>(buffers_.get());
+  base = (base + alignment_ - 1) / alignment_ * alignment_;
+  chunks_.resize(depth);
+  for (int i = 0; i < depth; i++) {
+    chunks_[i].buffer = reinterpret_cast<uint8_t*>(base) +
+                        static_cast<size_t>(i) * chunk_size_;
+    chunks_[i].state = Chunk::kIdle;
+  }
+}
+
+util::Status IoUringFileInputStream::QueueIdleChunks() {
+  // Idle chunks always follow the busy ones in the ring, so requesting them
+  // in ring order keeps the chunks in file order.
+  for (size_t i = 0; i < chunks_.size(); i++) {
+    size_t index = (head_ + i) % chunks_.size();
+    Chunk& chunk = chunks_[index];
+    if (chunk.state != Chunk::kIdle) continue;
+    chunk.skip = next_offset_ % alignment_;
+    chunk.offset = next_offset_ - chunk.skip;
+    chunk.state = Chunk::kInFlight;
+    ring_->QueueRead(fd_, chunk.buffer, chunk_size_, chunk.offset, index);
+    next_offset_ = chunk.offset + chunk_size_;
+  }
+  return ring_->Submit();
+}
+
+util::Status IoUringFileInputStream::WaitFor(const Chunk& chunk) {
+  while (chunk.state == Chunk::kInFlight) {
+    auto completion_result = ring_->WaitForCompletion();
+    if (!completion_result.ok()) return completion_result.status();
+    IoUring::Completion completion = completion_result.ValueOrDie();
+    Chunk& done = chunks_[completion.user_data];
+    done.state = Chunk::kDone;
+    done.result = completion.result;
+  }
+  return Status::OK;
+}
+
+util::Status IoUringFileInputStream::Drain() {
+  for (size_t i = 0; i < chunks_.size(); i++) {
+    if (i == static_cast<size_t>(head_)) continue;
+    util::Status status = WaitFor(chunks_[i]);
+    if (!status.ok()) return status;
+    chunks_[i].state = Chunk::kIdle;
+  }
+  return Status::OK;
+}
+
+crypto::tink::util::StatusOr<int> IoUringFileInputStream::Next(
+    const void** data) {
+  if (!status_.ok()) return status_;
+  if (count_backedup_ > 0) {  // Return the backed-up bytes.
+    buffer_offset_ = buffer_offset_ + (count_in_buffer_ - count_backedup_);
+    count_in_buffer_ = count_backedup_;
+    count_backedup_ = 0;
+    *data = buffer_ + buffer_offset_;
+    position_ = position_ + count_in_buffer_;
+    return count_in_buffer_;
+  }
+  if (ring_ == nullptr) return NextBlocking(data);
+
+  // The chunk returned previously can now be reused for a read-ahead.
+  if (head_returned_) {
+    chunks_[head_].state = Chunk::kIdle;
+    head_ = (head_ + 1) % chunks_.size();
+  }
+  status_ = QueueIdleChunks();
+  if (status_.ok()) status_ = WaitFor(chunks_[head_]);
+  if (!status_.ok()) return status_;
+  const Chunk& chunk = chunks_[head_];
+  if (chunk.result < 0) {
+    status_ = ToStatusF(util::error::INTERNAL, "I/O error: %d", -chunk.result);
+    return status_;
+  }
+  if (chunk.result <= chunk.skip) {
+    status_ = Status(util::error::OUT_OF_RANGE, "EOF");
+    return status_;
+  }
+  if (chunk.result < chunk_size_) {
+    // A short read, usually at the end of the file. The chunks behind it
+    // were requested at offsets that are now wrong, so they are discarded,
+    // and reading continues right after the data of this chunk.
+    next_offset_ = chunk.offset + chunk.result;
+    status_ = Drain();
+    if (!status_.ok()) return status_;
+  }
+  head_returned_ = true;
+  buffer_ = chunk.buffer + chunk.skip;
+  buffer_offset_ = 0;
+  count_backedup_ = 0;
+  count_in_buffer_ = chunk.result - chunk.skip;
+  position_ = position_ + count_in_buffer_;
+  *data = buffer_;
+  return count_in_buffer_;
+}
+
+crypto::tink::util::StatusOr<int> IoUringFileInputStream::NextBlocking(
+    const void** data) {
+  uint8_t* buffer = chunks_[0].buffer;
+  int read_result = read_ignoring_eintr(fd_, buffer, chunk_size_);
+  if (read_result <= 0) {  // EOF or an I/O error.
+    if (read_result == 0) {
+      status_ = Status(util::error::OUT_OF_RANGE, "EOF");
+    } else {
+      status_ = ToStatusF(util::error::INTERNAL, "I/O error: %d", errno);
+    }
+    return status_;
+  }
+  buffer_ = buffer;
+  buffer_offset_ = 0;
+  count_backedup_ = 0;
+  count_in_buffer_ = read_result;
+  position_ = position_ + count_in_buffer_;
+  *data = buffer_;
+  return count_in_buffer_;
+}
+
+void IoUringFileInputStream::BackUp(int count) {
+  if (!status_.ok() || count < 1 || count_backedup_ == count_in_buffer_) return;
+  int actual_count = std::min(count, count_in_buffer_ - count_backedup_);
+  count_backedup_ = count_backedup_ + actual_count;
+  position_ = position_ - actual_count;
+}
+
+IoUringFileInputStream::~IoUringFileInputStream() {
+  if (ring_ != nullptr) {
+    for (const Chunk& chunk : chunks_) {
+      if (!WaitFor(chunk).ok()) {
+        // The kernel may still write to the buffers, so they must not be
+        // freed.
+        buffers_.release();
+        break;
+      }
+    }
+  }
+  close_ignoring_eintr(fd_);
+}
+
+int64_t IoUringFileInputStream::Position() const {
+  return position_;
+}
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,106 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_IO_URING_FILE_INPUT_STREAM_H_
+#define TINK_UTIL_IO_URING_FILE_INPUT_STREAM_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tink/input_stream.h"
+#include "tink/util/io_uring.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// An InputStream that reads from a file descriptor like FileInputStream,
+// but keeps several reads in flight via io_uring: while the caller
+// processes the chunk returned by Next(), the following chunks are
+// already being read. When decrypting with a streaming AEAD, choosing the
+// ciphertext segment size as 'chunk_size' lets the decryption of one
+// segment overlap with the I/O of the next 'queue_depth' - 1 segments.
+//
+// The file descriptor may be opened with O_DIRECT; in that case
+// 'chunk_size' is rounded up to a multiple of 4096 bytes.
+//
+// If io_uring is not available, or the file descriptor is not seekable
+// (e.g. a pipe), the stream reads one chunk at a time with blocking reads.
+class IoUringFileInputStream : public crypto::tink::InputStream {
+ public:
+  // Constructs an InputStream that will read from the file specified
+  // via 'file_descriptor', starting at its current position, in chunks
+  // of 'chunk_size' bytes with up to 'queue_depth' chunks in flight
+  // (if no legal values are given, reasonable defaults will be used).
+  // Takes the ownership of the file, and will close it upon destruction.
+  explicit IoUringFileInputStream(int file_descriptor, int chunk_size = -1,
+                                  int queue_depth = -1);
+
+  ~IoUringFileInputStream() override;
+
+  crypto::tink::util::StatusOr<int> Next(const void** data) override;
+
+  void BackUp(int count) override;
+
+  int64_t Position() const override;
+
+ private:
+  struct Chunk {
+    enum State { kIdle, kInFlight, kDone };
+
+    uint8_t* buffer;
+    State state;
+    int64_t offset;  // file offset of buffer[0]
+    int skip;        // # of leading bytes in buffer before the stream data
+    int result;      // result of the read, or -errno
+  };
+
+  // Starts reads for all idle chunks, in file order starting from head_.
+  util::Status QueueIdleChunks();
+  // Processes completions until 'chunk' is no longer in flight.
+  util::Status WaitFor(const Chunk& chunk);
+  // Waits for all reads in flight, and marks all chunks but head_ idle.
+  util::Status Drain();
+  crypto::tink::util::StatusOr<int> NextBlocking(const void** data);
+
+  util::Status status_;
+  int fd_;
+  int chunk_size_;
+  int alignment_;  // alignment of offsets and sizes required by the file
+  std::unique_ptr<IoUring> ring_;  // null if reads are blocking
+  std::unique_ptr<uint8_t[]> buffers_;
+  std::vector<Chunk> chunks_;
+  int head_;             // the chunk returned by the last call to Next()
+  bool head_returned_;   // whether Next() has returned head_
+  int64_t next_offset_;  // file offset of the first byte not yet requested
+  int64_t position_;     // current position in the stream
+
+  // Counters that describe the state of the data returned from head_,
+  // which starts at buffer_.
+  const uint8_t* buffer_;
+  int count_in_buffer_;  // # of bytes available in buffer_
+  int count_backedup_;   // # of bytes available in buffer_ that were backed up
+  int buffer_offset_;    // offset at which the returned bytes start in buffer_
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_IO_URING_FILE_INPUT_STREAM_H_
@@ -0,0 +1,188 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/io_uring_file_input_stream.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+// Reads the specified 'input_stream' until no more bytes can be read,
+// and puts the read bytes into 'contents'.
+// Returns the status of the last input_stream->Next()-operation.
+util::Status ReadTillEnd(util::IoUringFileInputStream* input_stream,
+                         std::string* contents) {
+  contents->clear();
+  const void* buffer;
+  auto next_result = input_stream->Next(&buffer);
+  while (next_result.ok()) {
+    contents->append(static_cast<const char*>(buffer),
+                     next_result.ValueOrDie());
+    next_result = input_stream->Next(&buffer);
+  }
+  return next_result.status();
+}
+
+TEST(IoUringFileInputStreamTest, ReadingStreams) {
+  for (auto stream_size : {0, 10, 100, 1000, 10000, 100000, 1000000}) {
+    for (auto queue_depth : {1, 2, 4, 16}) {
+      SCOPED_TRACE(absl::StrCat("stream_size = ", stream_size,
+                                ", queue_depth = ", queue_depth));
+      std::string file_contents;
+      std::string filename = absl::StrCat(stream_size, "_uring_test.bin");
+      int input_fd =
+          test::GetTestFileDescriptor(filename, stream_size, &file_contents);
+      auto input_stream = absl::make_unique<util::IoUringFileInputStream>(
+          input_fd, 4096, queue_depth);
+      std::string stream_contents;
+      auto status = ReadTillEnd(input_stream.get(), &stream_contents);
+      EXPECT_EQ(util::error::OUT_OF_RANGE, status.error_code());
+      EXPECT_EQ("EOF", status.error_message());
+      EXPECT_EQ(file_contents, stream_contents);
+      EXPECT_EQ(stream_size, input_stream->Position());
+    }
+  }
+}
+
+TEST(IoUringFileInputStreamTest, CustomChunkSizes) {
+  int stream_size = 100000;
+  for (auto chunk_size : {1, 10, 100, 1000, 10000, 1000000}) {
+    SCOPED_TRACE(absl::StrCat("chunk_size = ", chunk_size));
+    std::string file_contents;
+    std::string filename = absl::StrCat(chunk_size, "_uring_chunk_test.bin");
+    int input_fd =
+        test::GetTestFileDescriptor(filename, stream_size, &file_contents);
+    auto input_stream =
+        absl::make_unique<util::IoUringFileInputStream>(input_fd, chunk_size);
+    const void* buffer;
+    auto next_result = input_stream->Next(&buffer);
+    ASSERT_TRUE(next_result.ok()) << next_result.status();
+    int expected_size = std::min(chunk_size, stream_size);
+    EXPECT_EQ(expected_size, next_result.ValueOrDie());
+    EXPECT_EQ(file_contents.substr(0, expected_size),
+              std::string(static_cast<const char*>(buffer), expected_size));
+    std::string stream_contents;
+    ASSERT_EQ(util::error::OUT_OF_RANGE,
+              ReadTillEnd(input_stream.get(), &stream_contents).error_code());
+    EXPECT_EQ(file_contents.substr(expected_size), stream_contents);
+  }
+}
+
+TEST(IoUringFileInputStreamTest, BackupAndPosition) {
+  int stream_size = 100000;
+  int chunk_size = 1234;
+  const void* buffer;
+  std::string file_contents;
+  int input_fd = test::GetTestFileDescriptor("uring_backup_test.bin",
+                                             stream_size, &file_contents);
+  auto input_stream =
+      absl::make_unique<util::IoUringFileInputStream>(input_fd, chunk_size);
+  EXPECT_EQ(0, input_stream->Position());
+  auto next_result = input_stream->Next(&buffer);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  EXPECT_EQ(chunk_size, next_result.ValueOrDie());
+  EXPECT_EQ(chunk_size, input_stream->Position());
+
+  input_stream->BackUp(100);
+  input_stream->BackUp(-10);
+  input_stream->BackUp(34);
+  EXPECT_EQ(chunk_size - 134, input_stream->Position());
+  next_result = input_stream->Next(&buffer);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  EXPECT_EQ(134, next_result.ValueOrDie());
+  EXPECT_EQ(chunk_size, input_stream->Position());
+  EXPECT_EQ(file_contents.substr(chunk_size - 134, 134),
+            std::string(static_cast<const char*>(buffer), 134));
+
+  // The next chunk follows the backed up bytes.
+  next_result = input_stream->Next(&buffer);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  EXPECT_EQ(chunk_size, next_result.ValueOrDie());
+  EXPECT_EQ(2 * chunk_size, input_stream->Position());
+  EXPECT_EQ(file_contents.substr(chunk_size, chunk_size),
+            std::string(static_cast<const char*>(buffer), chunk_size));
+}
+
+TEST(IoUringFileInputStreamTest, StartsAtCurrentFilePosition) {
+  std::string file_contents;
+  int input_fd = test::GetTestFileDescriptor("uring_position_test.bin", 10000,
+                                             &file_contents);
+  ASSERT_EQ(lseek(input_fd, 1001, SEEK_SET), 1001);
+  auto input_stream =
+      absl::make_unique<util::IoUringFileInputStream>(input_fd, 1000);
+  std::string stream_contents;
+  EXPECT_EQ(util::error::OUT_OF_RANGE,
+            ReadTillEnd(input_stream.get(), &stream_contents).error_code());
+  EXPECT_EQ(file_contents.substr(1001), stream_contents);
+}
+
+TEST(IoUringFileInputStreamTest, ReadingPipe) {
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  std::string contents(100000, 'x');
+  std::thread writer([&]() {
+    for (size_t pos = 0; pos < contents.size();) {
+      int written =
+          write(fds[1], contents.data() + pos, contents.size() - pos);
+      ASSERT_GT(written, 0);
+      pos += written;
+    }
+    close(fds[1]);
+  });
+  auto input_stream =
+      absl::make_unique<util::IoUringFileInputStream>(fds[0], 4096);
+  std::string stream_contents;
+  EXPECT_EQ(util::error::OUT_OF_RANGE,
+            ReadTillEnd(input_stream.get(), &stream_contents).error_code());
+  writer.join();
+  EXPECT_EQ(contents, stream_contents);
+}
+
+TEST(IoUringFileInputStreamTest, DirectIo) {
+  std::string file_contents;
+  std::string filename = "uring_direct_test.bin";
+  close(test::GetTestFileDescriptor(filename, 100000, &file_contents));
+  int input_fd = open(absl::StrCat(test::TmpDir(), "/", filename).c_str(),
+                      O_RDONLY | O_DIRECT);
+  if (input_fd < 0) {
+    GTEST_SKIP() << "O_DIRECT is not supported by the test file system";
+  }
+  // Starting at an unaligned position, with an unaligned chunk size.
+  ASSERT_EQ(lseek(input_fd, 5000, SEEK_SET), 5000);
+  auto input_stream =
+      absl::make_unique<util::IoUringFileInputStream>(input_fd, 10000);
+  std::string stream_contents;
+  EXPECT_EQ(util::error::OUT_OF_RANGE,
+            ReadTillEnd(input_stream.get(), &stream_contents).error_code());
+  EXPECT_EQ(file_contents.substr(5000), stream_contents);
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
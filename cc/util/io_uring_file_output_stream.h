@@ -0,0 +1,106 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_IO_URING_FILE_OUTPUT_STREAM_H_
+#define TINK_UTIL_IO_URING_FILE_OUTPUT_STREAM_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tink/output_stream.h"
+#include "tink/util/io_uring.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// An OutputStream that writes to a file descriptor like FileOutputStream,
+// but writes full chunks asynchronously via io_uring: Next() hands out a
+// fresh chunk while up to 'queue_depth' - 1 earlier chunks are still being
+// written. Close() waits for all writes.
+//
+// The file descriptor may be opened with O_DIRECT; in that case
+// 'chunk_size' is rounded up to a multiple of 4096 bytes, and the last
+// chunk is written without O_DIRECT if its size is not a multiple of it.
+//
+// If io_uring is not available, or the file descriptor is not seekable
+// or opened with O_APPEND, the stream writes one chunk at a time with
+// blocking writes.
+class IoUringFileOutputStream : public crypto::tink::OutputStream {
+ public:
+  // Constructs an OutputStream that will write to the file specified
+  // via 'file_descriptor', starting at its current position, in chunks
+  // of 'chunk_size' bytes with up to 'queue_depth' chunks in flight
+  // (if no legal values are given, reasonable defaults will be used).
+  // Takes the ownership of the file, and will close it upon destruction.
+  explicit IoUringFileOutputStream(int file_descriptor, int chunk_size = -1,
+                                   int queue_depth = -1);
+
+  ~IoUringFileOutputStream() override;
+
+  crypto::tink::util::StatusOr<int> Next(void** data) override;
+
+  void BackUp(int count) override;
+
+  crypto::tink::util::Status Close() override;
+
+  int64_t Position() const override;
+
+ private:
+  struct Chunk {
+    enum State { kIdle, kInFlight, kDone };
+
+    uint8_t* buffer;
+    State state;
+    int64_t offset;  // file offset of buffer[0]
+    int size;        // # of bytes to write
+    int result;      // result of the write, or -errno
+  };
+
+  // Processes completions until 'chunk' is no longer in flight.
+  util::Status WaitFor(const Chunk& chunk);
+  // Waits for the write of 'chunk', if any, and completes it if it was short.
+  util::Status Finish(Chunk* chunk);
+  // Writes 'count' bytes from 'buffer' at next_offset_ with blocking writes.
+  util::Status WriteBlocking(const uint8_t* buffer, int count);
+
+  util::Status status_;
+  int fd_;
+  int chunk_size_;
+  int alignment_;  // alignment of offsets and sizes required by the file
+  std::unique_ptr<IoUring> ring_;  // null if writes are blocking
+  std::unique_ptr<uint8_t[]> buffers_;
+  std::vector<Chunk> chunks_;
+  int head_;             // the chunk returned by the last call to Next()
+  int64_t next_offset_;  // file offset of the first byte not yet written
+  int64_t position_;     // current position in the stream
+
+  // Counters that describe the state of the data in the buffer of head_.
+  // count_in_buffer_ is always equal to (chunk_size_ - count_backedup_),
+  // except initially (before the first call to Next()), when it is 0.
+  int count_in_buffer_;  // # bytes in the buffer that will be written
+  int count_backedup_;   // # bytes in the buffer that were backed up
+  int buffer_offset_;    // offset where the returned *data starts
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_IO_URING_FILE_OUTPUT_STREAM_H_
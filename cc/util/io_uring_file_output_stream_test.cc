@@ -0,0 +1,160 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/io_uring_file_output_stream.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/subtle/random.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+// Writes 'contents' the specified 'output_stream', and closes the stream.
+// Returns the status of output_stream->Close()-operation, or a non-OK status
+// of a prior output_stream->Next()-operation, if any.
+util::Status WriteToStream(util::IoUringFileOutputStream* output_stream,
+                           absl::string_view contents) {
+  void* buffer;
+  int pos = 0;
+  int remaining = contents.length();
+  int available_space = 0;
+  int available_bytes = 0;
+  while (remaining > 0) {
+    auto next_result = output_stream->Next(&buffer);
+    if (!next_result.ok()) return next_result.status();
+    available_space = next_result.ValueOrDie();
+    available_bytes = std::min(available_space, remaining);
+    memcpy(buffer, contents.data() + pos, available_bytes);
+    remaining -= available_bytes;
+    pos += available_bytes;
+  }
+  if (available_space > available_bytes) {
+    output_stream->BackUp(available_space - available_bytes);
+  }
+  return output_stream->Close();
+}
+
+TEST(IoUringFileOutputStreamTest, WritingStreams) {
+  for (auto stream_size : {0, 10, 100, 1000, 10000, 100000, 1000000}) {
+    for (auto queue_depth : {1, 2, 4, 16}) {
+      SCOPED_TRACE(absl::StrCat("stream_size = ", stream_size,
+                                ", queue_depth = ", queue_depth));
+      std::string stream_contents =
+          subtle::Random::GetRandomBytes(stream_size);
+      std::string filename = absl::StrCat(stream_size, "_uring_test.bin");
+      int output_fd = test::GetTestFileDescriptor(filename);
+      auto output_stream = absl::make_unique<util::IoUringFileOutputStream>(
+          output_fd, 4096, queue_depth);
+      auto status = WriteToStream(output_stream.get(), stream_contents);
+      EXPECT_TRUE(status.ok()) << status;
+      EXPECT_EQ(stream_contents, test::ReadTestFile(filename));
+    }
+  }
+}
+
+TEST(IoUringFileOutputStreamTest, CustomChunkSizes) {
+  int stream_size = 100000;
+  std::string stream_contents = subtle::Random::GetRandomBytes(stream_size);
+  for (auto chunk_size : {1, 10, 100, 1000, 10000, 1000000}) {
+    SCOPED_TRACE(absl::StrCat("chunk_size = ", chunk_size));
+    std::string filename = absl::StrCat(chunk_size, "_uring_chunk_test.bin");
+    int output_fd = test::GetTestFileDescriptor(filename);
+    auto output_stream =
+        absl::make_unique<util::IoUringFileOutputStream>(output_fd,
+                                                         chunk_size);
+    void* buffer;
+    auto next_result = output_stream->Next(&buffer);
+    ASSERT_TRUE(next_result.ok()) << next_result.status();
+    EXPECT_EQ(chunk_size, next_result.ValueOrDie());
+    output_stream->BackUp(chunk_size);
+    auto status = WriteToStream(output_stream.get(), stream_contents);
+    EXPECT_TRUE(status.ok()) << status;
+    EXPECT_EQ(stream_contents, test::ReadTestFile(filename));
+  }
+}
+
+TEST(IoUringFileOutputStreamTest, BackupAndPosition) {
+  int chunk_size = 1234;
+  void* buffer;
+  std::string stream_contents =
+      subtle::Random::GetRandomBytes(3 * chunk_size);
+  std::string filename = "uring_backup_test.bin";
+  int output_fd = test::GetTestFileDescriptor(filename);
+  auto output_stream =
+      absl::make_unique<util::IoUringFileOutputStream>(output_fd, chunk_size);
+  EXPECT_EQ(0, output_stream->Position());
+  auto next_result = output_stream->Next(&buffer);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  EXPECT_EQ(chunk_size, next_result.ValueOrDie());
+  EXPECT_EQ(chunk_size, output_stream->Position());
+  std::memcpy(buffer, stream_contents.data(), chunk_size - 134);
+
+  output_stream->BackUp(100);
+  output_stream->BackUp(-10);
+  output_stream->BackUp(34);
+  EXPECT_EQ(chunk_size - 134, output_stream->Position());
+  next_result = output_stream->Next(&buffer);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  EXPECT_EQ(134, next_result.ValueOrDie());
+  EXPECT_EQ(chunk_size, output_stream->Position());
+  std::memcpy(buffer, stream_contents.data() + chunk_size - 134, 134);
+
+  // The next chunk follows the backed up space.
+  next_result = output_stream->Next(&buffer);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  EXPECT_EQ(chunk_size, next_result.ValueOrDie());
+  EXPECT_EQ(2 * chunk_size, output_stream->Position());
+  std::memcpy(buffer, stream_contents.data() + chunk_size, chunk_size);
+  auto status = WriteToStream(
+      output_stream.get(),
+      absl::string_view(stream_contents).substr(2 * chunk_size));
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(stream_contents.size(), output_stream->Position());
+  EXPECT_EQ(stream_contents, test::ReadTestFile(filename));
+}
+
+TEST(IoUringFileOutputStreamTest, DirectIo) {
+  std::string filename = "uring_direct_test.bin";
+  close(test::GetTestFileDescriptor(filename));
+  int output_fd = open(absl::StrCat(test::TmpDir(), "/", filename).c_str(),
+                       O_WRONLY | O_DIRECT);
+  if (output_fd < 0) {
+    GTEST_SKIP() << "O_DIRECT is not supported by the test file system";
+  }
+  // The last chunk is not a multiple of the O_DIRECT block size.
+  std::string stream_contents = subtle::Random::GetRandomBytes(100000);
+  auto output_stream =
+      absl::make_unique<util::IoUringFileOutputStream>(output_fd, 10000);
+  auto status = WriteToStream(output_stream.get(), stream_contents);
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(stream_contents, test::ReadTestFile(filename));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
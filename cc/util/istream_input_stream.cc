@@ -22,6 +22,7 @@
 #include <istream>
 
 #include "absl/memory/memory.h"
+#include "absl/types/span.h"
 #include "tink/input_stream.h"
 #include "tink/util/errors.h"
 #include "tink/util/status.h"
@@ -75,6 +76,42 @@ crypto::tink::util::StatusOr<int> IstreamInputStream::Next(const void** data) {
   return count_in_buffer_;
 }
 
+crypto::tink::util::StatusOr<int> IstreamInputStream::ReadInto(
+    absl::Span<uint8_t> buffer) {
+  int count = 0;
+  int size = buffer.size();
+  while (count < size) {
+    if (status_.ok() && count_backedup_ == 0 && size - count >= buffer_size_) {
+      // Read directly into 'buffer', leaving buffer_ empty.
+      input_->read(reinterpret_cast<char*>(buffer.data() + count),
+                   size - count);
+      int count_read = input_->gcount();
+      count_in_buffer_ = 0;
+      buffer_offset_ = 0;
+      count += count_read;
+      position_ = position_ + count_read;
+      if (input_->good()) continue;
+      if (input_->eof()) {
+        status_ = Status(util::error::OUT_OF_RANGE, "EOF");
+        break;
+      }
+      status_ =
+          ToStatusF(util::error::INTERNAL, "I/O error: %s", strerror(errno));
+      return status_;
+    }
+    const void* data;
+    auto next_result = Next(&data);
+    if (next_result.status().error_code() == util::error::OUT_OF_RANGE) break;
+    if (!next_result.ok()) return next_result.status();
+    int available = next_result.ValueOrDie();
+    int needed = std::min(available, size - count);
+    std::memcpy(buffer.data() + count, data, needed);
+    count += needed;
+    BackUp(available - needed);
+  }
+  return count;
+}
+
 void IstreamInputStream::BackUp(int count) {
   if (!status_.ok() || count < 1 || count_backedup_ == count_in_buffer_) return;
   int actual_count = std::min(count, count_in_buffer_ - count_backedup_);
@@ -24,6 +24,7 @@
 #include "gtest/gtest.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/subtle/random.h"
 #include "tink/util/test_util.h"
 
@@ -186,6 +187,53 @@ TEST_F(IstreamInputStreamTest, testBackupAndPosition) {
             std::string(static_cast<const char*>(buffer), buffer_size));
 }
 
+TEST_F(IstreamInputStreamTest, testReadInto) {
+  int stream_size = 100000;
+  int buffer_size = 1000;
+  std::string file_contents;
+  std::string filename = absl::StrCat(buffer_size, "_read_into_test.bin");
+  auto input = GetTestIstream(filename, stream_size, &file_contents);
+  auto input_stream = absl::make_unique<util::IstreamInputStream>(
+      std::move(input), buffer_size);
+  std::string stream_contents;
+  int read_size_sum = 0;
+  for (int read_size : {0, 10, 5000, 999, 1000, 1, 30000}) {
+    SCOPED_TRACE(absl::StrCat("read_size = ", read_size));
+    std::string chunk(read_size, '\0');
+    auto read_result = input_stream->ReadInto(absl::MakeSpan(
+        reinterpret_cast<uint8_t*>(&chunk[0]), chunk.size()));
+    EXPECT_TRUE(read_result.ok()) << read_result.status();
+    EXPECT_EQ(read_size, read_result.ValueOrDie());
+    stream_contents += chunk;
+    read_size_sum += read_size;
+    EXPECT_EQ(read_size_sum, input_stream->Position());
+
+    // Next() and BackUp() still work in between.
+    const void* buffer;
+    auto next_result = input_stream->Next(&buffer);
+    EXPECT_TRUE(next_result.ok()) << next_result.status();
+    input_stream->BackUp(next_result.ValueOrDie() / 2);
+    int next_count = next_result.ValueOrDie() - next_result.ValueOrDie() / 2;
+    stream_contents.append(static_cast<const char*>(buffer), next_count);
+    read_size_sum += next_count;
+    EXPECT_EQ(read_size_sum, input_stream->Position());
+  }
+
+  // The last read is cut short by the end of the stream.
+  std::string rest(stream_size, '\0');
+  auto read_result = input_stream->ReadInto(
+      absl::MakeSpan(reinterpret_cast<uint8_t*>(&rest[0]), rest.size()));
+  EXPECT_TRUE(read_result.ok()) << read_result.status();
+  EXPECT_EQ(stream_size - read_size_sum, read_result.ValueOrDie());
+  stream_contents += rest.substr(0, read_result.ValueOrDie());
+  EXPECT_EQ(file_contents, stream_contents);
+  EXPECT_EQ(stream_size, input_stream->Position());
+  read_result = input_stream->ReadInto(
+      absl::MakeSpan(reinterpret_cast<uint8_t*>(&rest[0]), rest.size()));
+  EXPECT_TRUE(read_result.ok()) << read_result.status();
+  EXPECT_EQ(0, read_result.ValueOrDie());
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
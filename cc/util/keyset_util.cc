@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <random>
 
+#include "tink/util/secret_data.h"
 #include "proto/tink.pb.h"
 
 namespace crypto {
@@ -51,5 +52,11 @@ uint32_t GenerateUnusedKeyId(const Keyset& keyset) {
   }
 }
 
+void ZeroizeKeyValues(Keyset* keyset) {
+  for (auto& key : *keyset->mutable_key()) {
+    util::SafeZeroString(key.mutable_key_data()->mutable_value());
+  }
+}
+
 }  // namespace tink
 }  // namespace crypto
@@ -27,6 +27,9 @@ namespace tink {
 // Generate a new random key ID not previously used in |keyset|.
 uint32_t GenerateUnusedKeyId(const google::crypto::tink::Keyset& keyset);
 
+// Overwrites the key material of all keys in |keyset| with zeros.
+void ZeroizeKeyValues(google::crypto::tink::Keyset* keyset);
+
 }  // namespace tink
 }  // namespace crypto
 
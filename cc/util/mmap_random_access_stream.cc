@@ -0,0 +1,138 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/mmap_random_access_stream.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "tink/random_access_stream.h"
+#include "tink/util/buffer.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+namespace {
+
+// Attempts to close file descriptor fd, while ignoring EINTR.
+// (code borrowed from ZeroCopy-streams)
+int close_ignoring_eintr(int fd) {
+  int result;
+  do {
+    result = close(fd);
+  } while (result < 0 && errno == EINTR);
+  return result;
+}
+
+}  // anonymous namespace
+
+// static
+StatusOr<std::unique_ptr<MmapRandomAccessStream>> MmapRandomAccessStream::New(
+    int file_descriptor) {
+  struct stat file_stat;
+  if (fstat(file_descriptor, &file_stat) != 0) {
+    int fstat_errno = errno;
+    close_ignoring_eintr(file_descriptor);
+    return ToStatusF(util::error::INTERNAL, "fstat failed: %d", fstat_errno);
+  }
+  if (file_stat.st_size < 0 ||
+      static_cast<uint64_t>(file_stat.st_size) >
+          std::numeric_limits<size_t>::max()) {
+    close_ignoring_eintr(file_descriptor);
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Cannot map a file of %d bytes.",
+                     static_cast<int64_t>(file_stat.st_size));
+  }
+  if (file_stat.st_size == 0) {
+    // mmap() rejects empty mappings.
+    close_ignoring_eintr(file_descriptor);
+    return {absl::WrapUnique(new MmapRandomAccessStream(nullptr, 0))};
+  }
+  size_t size = file_stat.st_size;
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+  int mmap_errno = errno;
+  close_ignoring_eintr(file_descriptor);
+  if (data == MAP_FAILED) {
+    return ToStatusF(util::error::INTERNAL, "mmap failed: %d", mmap_errno);
+  }
+  return {absl::WrapUnique(new MmapRandomAccessStream(data, file_stat.st_size))};
+}
+
+MmapRandomAccessStream::~MmapRandomAccessStream() {
+  if (data_ != nullptr) munmap(const_cast<void*>(data_), size_);
+}
+
+Status MmapRandomAccessStream::PRead(int64_t position, int count,
+                                     Buffer* dest_buffer) {
+  if (dest_buffer == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "dest_buffer must be non-null");
+  }
+  if (count > dest_buffer->allocated_size()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "buffer too small");
+  }
+  auto view_result = PReadView(position, count);
+  if (!view_result.ok()) {
+    dest_buffer->set_size(0).IgnoreError();
+    return view_result.status();
+  }
+  absl::string_view view = view_result.ValueOrDie();
+  Status status = dest_buffer->set_size(view.size());
+  if (!status.ok()) return status;
+  std::memcpy(dest_buffer->get_mem_block(), view.data(), view.size());
+  if (static_cast<int>(view.size()) < count) {
+    return Status(util::error::OUT_OF_RANGE, "EOF");
+  }
+  return Status::OK;
+}
+
+StatusOr<absl::string_view> MmapRandomAccessStream::PReadView(int64_t position,
+                                                              int count) {
+  if (count <= 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "count must be positive");
+  }
+  if (position < 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "position cannot be negative");
+  }
+  if (position >= size_) {
+    return Status(util::error::OUT_OF_RANGE, "EOF");
+  }
+  int64_t view_size = std::min<int64_t>(count, size_ - position);
+  return absl::string_view(static_cast<const char*>(data_) + position,
+                           view_size);
+}
+
+StatusOr<int64_t> MmapRandomAccessStream::size() {
+  return size_;
+}
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,67 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_MMAP_RANDOM_ACCESS_STREAM_H_
+#define TINK_UTIL_MMAP_RANDOM_ACCESS_STREAM_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "tink/random_access_stream.h"
+#include "tink/util/buffer.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// A RandomAccessStream that maps a file into memory. Besides PRead(), it
+// implements PReadView(), which returns views into the mapping, so that
+// DecryptingRandomAccessStream decrypts segments without copying the
+// ciphertext. The file must not be truncated while it is mapped.
+class MmapRandomAccessStream : public crypto::tink::RandomAccessStream {
+ public:
+  // Maps the file specified via 'file_descriptor', which is closed
+  // afterwards, also upon failure.
+  static crypto::tink::util::StatusOr<std::unique_ptr<MmapRandomAccessStream>>
+  New(int file_descriptor);
+
+  ~MmapRandomAccessStream() override;
+
+  crypto::tink::util::Status PRead(int64_t position,
+                                   int count,
+                                   Buffer* dest_buffer) override;
+
+  crypto::tink::util::StatusOr<absl::string_view> PReadView(
+      int64_t position, int count) override;
+
+  crypto::tink::util::StatusOr<int64_t> size() override;
+
+ private:
+  MmapRandomAccessStream(const void* data, int64_t size)
+      : data_(data), size_(size) {}
+
+  const void* data_;  // null if the file is empty
+  int64_t size_;
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_MMAP_RANDOM_ACCESS_STREAM_H_
@@ -23,6 +23,7 @@
 #include <ostream>
 
 #include "absl/memory/memory.h"
+#include "absl/types/span.h"
 #include "tink/output_stream.h"
 #include "tink/util/errors.h"
 #include "tink/util/status.h"
@@ -93,6 +94,30 @@ crypto::tink::util::StatusOr<int> OstreamOutputStream::Next(void** data) {
   return write_result;
 }
 
+Status OstreamOutputStream::WriteFrom(absl::Span<const uint8_t> data) {
+  if (!status_.ok()) return status_;
+  if (static_cast<int64_t>(data.size()) < buffer_size_) {
+    return OutputStream::WriteFrom(data);
+  }
+  // Write the buffered bytes and then 'data', and leave all of buffer_
+  // backed up.
+  if (count_in_buffer_ > 0) {
+    output_->write(reinterpret_cast<char*>(buffer_.get()), count_in_buffer_);
+  }
+  output_->write(reinterpret_cast<const char*>(data.data()), data.size());
+  if (!output_->good()) {  // An I/O error occurred.
+    status_ = ToStatusF(
+        util::error::INTERNAL, "I/O error upon write: %d", errno);
+    return status_;
+  }
+  if (buffer_ == nullptr) buffer_ = absl::make_unique<uint8_t[]>(buffer_size_);
+  count_in_buffer_ = 0;
+  count_backedup_ = buffer_size_;
+  buffer_offset_ = 0;
+  position_ = position_ + data.size();
+  return Status::OK;
+}
+
 void OstreamOutputStream::BackUp(int count) {
   if (!status_.ok() || count < 1 || count_in_buffer_ == 0) return;
   int curr_buffer_size = buffer_size_ - buffer_offset_;
@@ -127,6 +152,26 @@ Status OstreamOutputStream::Close() {
   return Status::OK;
 }
 
+Status OstreamOutputStream::Flush() {
+  if (!status_.ok()) return status_;
+  if (count_in_buffer_ > 0) {
+    output_->write(reinterpret_cast<char*>(buffer_.get()), count_in_buffer_);
+  }
+  output_->flush();
+  if (!output_->good()) {  // An I/O error occurred.
+    status_ = ToStatusF(
+        util::error::INTERNAL, "I/O error upon flushing: %d", errno);
+    return status_;
+  }
+  // As after WriteFrom(), all of buffer_ is backed up.
+  if (buffer_ != nullptr) {
+    count_in_buffer_ = 0;
+    count_backedup_ = buffer_size_;
+    buffer_offset_ = 0;
+  }
+  return Status::OK;
+}
+
 int64_t OstreamOutputStream::Position() const {
   return position_;
 }
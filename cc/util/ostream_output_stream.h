@@ -20,6 +20,7 @@
 #include <memory>
 #include <ostream>
 
+#include "absl/types/span.h"
 #include "tink/output_stream.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -41,10 +42,17 @@ class OstreamOutputStream : public crypto::tink::OutputStream {
 
   crypto::tink::util::StatusOr<int> Next(void** data) override;
 
+  // Writes chunks of at least the buffer size directly from 'data'.
+  crypto::tink::util::Status WriteFrom(
+      absl::Span<const uint8_t> data) override;
+
   void BackUp(int count) override;
 
   crypto::tink::util::Status Close() override;
 
+  // Writes the buffered bytes to the ostream, and flushes it.
+  crypto::tink::util::Status Flush() override;
+
   int64_t Position() const override;
 
  private:
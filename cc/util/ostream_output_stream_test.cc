@@ -19,11 +19,13 @@
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <sstream>
 
 #include "gtest/gtest.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tink/subtle/random.h"
 #include "tink/util/test_util.h"
 
@@ -190,6 +192,79 @@ TEST_F(OstreamOutputStreamTest, BackupAndPosition) {
   EXPECT_EQ(stream_contents, ostream_contents);
 }
 
+TEST_F(OstreamOutputStreamTest, WriteFrom) {
+  int stream_size = 100000;
+  int buffer_size = 1000;
+  std::string stream_contents = subtle::Random::GetRandomBytes(stream_size);
+  std::string filename = absl::StrCat(buffer_size, "_write_from_test.bin");
+  auto output_stream = absl::make_unique<util::OstreamOutputStream>(
+      GetTestOstream(filename), buffer_size);
+  int written = 0;
+  for (int write_size : {0, 10, 5000, 999, 1000, 1, 30000}) {
+    SCOPED_TRACE(absl::StrCat("write_size = ", write_size));
+    auto status = output_stream->WriteFrom(absl::MakeConstSpan(
+        reinterpret_cast<const uint8_t*>(stream_contents.data()) + written,
+        write_size));
+    EXPECT_TRUE(status.ok()) << status;
+    written += write_size;
+    EXPECT_EQ(written, output_stream->Position());
+
+    // Next() and BackUp() still work in between.
+    void* buffer;
+    auto next_result = output_stream->Next(&buffer);
+    EXPECT_TRUE(next_result.ok()) << next_result.status();
+    int next_count = next_result.ValueOrDie() - next_result.ValueOrDie() / 2;
+    memcpy(buffer, stream_contents.data() + written, next_count);
+    output_stream->BackUp(next_result.ValueOrDie() / 2);
+    written += next_count;
+    EXPECT_EQ(written, output_stream->Position());
+  }
+  auto status = output_stream->WriteFrom(absl::MakeConstSpan(
+      reinterpret_cast<const uint8_t*>(stream_contents.data()) + written,
+      stream_size - written));
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(stream_size, output_stream->Position());
+  status = output_stream->Close();
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(stream_contents, test::ReadTestFile(filename));
+}
+
+TEST_F(OstreamOutputStreamTest, Flush) {
+  std::string stream_contents = subtle::Random::GetRandomBytes(3000);
+  auto ostream = absl::make_unique<std::ostringstream>();
+  std::ostringstream* output = ostream.get();
+  auto output_stream = absl::make_unique<util::OstreamOutputStream>(
+      std::move(ostream), /* buffer_size = */ 1000);
+  EXPECT_TRUE(output_stream->Flush().ok());
+  EXPECT_EQ("", output->str());
+
+  void* buffer;
+  auto next_result = output_stream->Next(&buffer);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  memcpy(buffer, stream_contents.data(), 10);
+  output_stream->BackUp(next_result.ValueOrDie() - 10);
+  auto status = output_stream->Flush();
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(stream_contents.substr(0, 10), output->str());
+  EXPECT_EQ(10, output_stream->Position());
+
+  // The buffer is reused after a flush.
+  status = output_stream->WriteFrom(absl::MakeConstSpan(
+      reinterpret_cast<const uint8_t*>(stream_contents.data()) + 10, 1500));
+  EXPECT_TRUE(status.ok()) << status;
+  status = output_stream->Flush();
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(stream_contents.substr(0, 1510), output->str());
+  status = output_stream->WriteFrom(absl::MakeConstSpan(
+      reinterpret_cast<const uint8_t*>(stream_contents.data()) + 1510, 1490));
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(3000, output_stream->Position());
+  status = output_stream->Close();
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(stream_contents, output->str());
+  EXPECT_FALSE(output_stream->Flush().ok());
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
@@ -0,0 +1,140 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/prefetched_random_access_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/util/buffer.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+Status PrefetchedRandomAccessStream::AddRange(int64_t position,
+                                              std::string data) {
+  if (position < 0 || position > size_ ||
+      static_cast<int64_t>(data.size()) > size_ - position) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("range of ", data.size(), " bytes at ",
+                               position, " exceeds the stream size ", size_));
+  }
+  if (data.empty()) return Status::OK;
+  auto next = ranges_.lower_bound(position);
+  if (next != ranges_.end() &&
+      next->first < position + static_cast<int64_t>(data.size())) {
+    return Status(util::error::INVALID_ARGUMENT, "ranges overlap");
+  }
+  if (next != ranges_.begin()) {
+    auto previous = std::prev(next);
+    if (previous->first + static_cast<int64_t>(previous->second.size()) >
+        position) {
+      return Status(util::error::INVALID_ARGUMENT, "ranges overlap");
+    }
+  }
+  ranges_.emplace_hint(next, position, std::move(data));
+  return Status::OK;
+}
+
+Status PrefetchedRandomAccessStream::PRead(int64_t position, int count,
+                                           Buffer* dest_buffer) {
+  if (dest_buffer == nullptr) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "dest_buffer must be non-null");
+  }
+  Status status = dest_buffer->set_size(0);
+  if (!status.ok()) return status;
+  if (count <= 0) {
+    return Status(util::error::INVALID_ARGUMENT, "count must be positive");
+  }
+  if (count > dest_buffer->allocated_size()) {
+    return Status(util::error::INVALID_ARGUMENT, "buffer too small");
+  }
+  if (position < 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "position cannot be negative");
+  }
+  if (position >= size_) {
+    return Status(util::error::OUT_OF_RANGE, "EOF");
+  }
+  int read_size = std::min<int64_t>(count, size_ - position);
+  // Copy from consecutive ranges, starting with the one containing
+  // 'position'.
+  auto range = ranges_.upper_bound(position);
+  int copied = 0;
+  while (copied < read_size) {
+    int64_t current = position + copied;
+    if (range == ranges_.begin()) break;
+    auto containing = std::prev(range);
+    int64_t offset = current - containing->first;
+    if (offset >= static_cast<int64_t>(containing->second.size())) break;
+    int n = std::min<int64_t>(read_size - copied,
+                              containing->second.size() - offset);
+    std::memcpy(dest_buffer->get_mem_block() + copied,
+                containing->second.data() + offset, n);
+    copied += n;
+    range = ranges_.upper_bound(position + copied);
+  }
+  if (copied < read_size) {
+    return Status(util::error::FAILED_PRECONDITION,
+                  absl::StrCat("byte ", position + copied,
+                               " was not prefetched"));
+  }
+  status = dest_buffer->set_size(read_size);
+  if (!status.ok()) return status;
+  if (read_size < count) {
+    return Status(util::error::OUT_OF_RANGE, "EOF");
+  }
+  return Status::OK;
+}
+
+StatusOr<absl::string_view> PrefetchedRandomAccessStream::PReadView(
+    int64_t position, int count) {
+  if (count <= 0) {
+    return Status(util::error::INVALID_ARGUMENT, "count must be positive");
+  }
+  if (position < 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "position cannot be negative");
+  }
+  if (position >= size_) {
+    return Status(util::error::OUT_OF_RANGE, "EOF");
+  }
+  int64_t view_size = std::min<int64_t>(count, size_ - position);
+  auto range = ranges_.upper_bound(position);
+  if (range != ranges_.begin()) {
+    auto containing = std::prev(range);
+    int64_t offset = position - containing->first;
+    if (offset + view_size <=
+        static_cast<int64_t>(containing->second.size())) {
+      return absl::string_view(containing->second).substr(offset, view_size);
+    }
+  }
+  return Status(util::error::UNIMPLEMENTED,
+                "the bytes are not within one prefetched range");
+}
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,71 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_PREFETCHED_RANDOM_ACCESS_STREAM_H_
+#define TINK_UTIL_PREFETCHED_RANDOM_ACCESS_STREAM_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/random_access_stream.h"
+#include "tink/util/buffer.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// A RandomAccessStream over ranges of a larger stream that were fetched
+// beforehand, e.g. with ranged requests to an object store for the ranges
+// returned by StreamingAead::PlanCiphertextRanges().  Reading bytes outside
+// of the added ranges fails with FAILED_PRECONDITION.  PReadView() returns
+// views into the added ranges, so a DecryptingRandomAccessStream does not
+// copy the ciphertext.
+// Reading is thread safe, but AddRange() must not be called concurrently
+// with any other method.
+class PrefetchedRandomAccessStream : public crypto::tink::RandomAccessStream {
+ public:
+  // Creates a stream of 'size' bytes, none of which are available yet.
+  explicit PrefetchedRandomAccessStream(int64_t size) : size_(size) {}
+
+  // Makes 'data' available as the bytes at 'position'.  The range must be
+  // within the size of the stream, and must not overlap an added range.
+  crypto::tink::util::Status AddRange(int64_t position, std::string data);
+
+  crypto::tink::util::Status PRead(int64_t position, int count,
+                                   Buffer* dest_buffer) override;
+
+  // Returns UNIMPLEMENTED if the bytes span several added ranges, so that
+  // the caller uses PRead() instead.
+  crypto::tink::util::StatusOr<absl::string_view> PReadView(
+      int64_t position, int count) override;
+
+  crypto::tink::util::StatusOr<int64_t> size() override { return size_; }
+
+ private:
+  const int64_t size_;
+  // The added ranges, by position.
+  std::map<int64_t, std::string> ranges_;
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_PREFETCHED_RANDOM_ACCESS_STREAM_H_
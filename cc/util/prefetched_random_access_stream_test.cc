@@ -0,0 +1,96 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/prefetched_random_access_stream.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "absl/strings/string_view.h"
+#include "tink/util/buffer.h"
+#include "tink/util/status.h"
+#include "tink/util/test_matchers.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+
+TEST(PrefetchedRandomAccessStreamTest, ReadsAddedRanges) {
+  PrefetchedRandomAccessStream stream(100);
+  EXPECT_EQ(100, stream.size().ValueOrDie());
+  ASSERT_THAT(stream.AddRange(10, "0123456789"), IsOk());
+  ASSERT_THAT(stream.AddRange(20, "abcdef"), IsOk());
+  ASSERT_THAT(stream.AddRange(95, "vwxyz"), IsOk());
+
+  auto buffer = std::move(Buffer::New(20).ValueOrDie());
+  ASSERT_THAT(stream.PRead(12, 3, buffer.get()), IsOk());
+  EXPECT_EQ("234", std::string(buffer->get_mem_block(), buffer->size()));
+  // Reads may span adjacent ranges.
+  ASSERT_THAT(stream.PRead(15, 8, buffer.get()), IsOk());
+  EXPECT_EQ("56789abc", std::string(buffer->get_mem_block(), buffer->size()));
+  // Reads past the end return the bytes up to the end.
+  EXPECT_THAT(stream.PRead(97, 10, buffer.get()),
+              StatusIs(error::OUT_OF_RANGE));
+  EXPECT_EQ("xyz", std::string(buffer->get_mem_block(), buffer->size()));
+  EXPECT_THAT(stream.PRead(100, 1, buffer.get()),
+              StatusIs(error::OUT_OF_RANGE));
+}
+
+TEST(PrefetchedRandomAccessStreamTest, BytesNotPrefetched) {
+  PrefetchedRandomAccessStream stream(100);
+  ASSERT_THAT(stream.AddRange(10, "0123456789"), IsOk());
+  auto buffer = std::move(Buffer::New(20).ValueOrDie());
+  EXPECT_THAT(stream.PRead(5, 10, buffer.get()),
+              StatusIs(error::FAILED_PRECONDITION));
+  EXPECT_EQ(0, buffer->size());
+  EXPECT_THAT(stream.PRead(15, 10, buffer.get()),
+              StatusIs(error::FAILED_PRECONDITION));
+  EXPECT_THAT(stream.PRead(50, 1, buffer.get()),
+              StatusIs(error::FAILED_PRECONDITION));
+}
+
+TEST(PrefetchedRandomAccessStreamTest, ViewsWithinOneRange) {
+  PrefetchedRandomAccessStream stream(30);
+  ASSERT_THAT(stream.AddRange(0, "0123456789"), IsOk());
+  ASSERT_THAT(stream.AddRange(10, "abcdefghij"), IsOk());
+  auto view_result = stream.PReadView(2, 5);
+  ASSERT_THAT(view_result.status(), IsOk());
+  EXPECT_EQ("23456", view_result.ValueOrDie());
+  EXPECT_THAT(stream.PReadView(8, 5).status(),
+              StatusIs(error::UNIMPLEMENTED));
+  EXPECT_THAT(stream.PReadView(30, 5).status(),
+              StatusIs(error::OUT_OF_RANGE));
+}
+
+TEST(PrefetchedRandomAccessStreamTest, InvalidRanges) {
+  PrefetchedRandomAccessStream stream(30);
+  ASSERT_THAT(stream.AddRange(10, "0123456789"), IsOk());
+  EXPECT_THAT(stream.AddRange(5, "abcdef"), StatusIs(error::INVALID_ARGUMENT));
+  EXPECT_THAT(stream.AddRange(19, "ab"), StatusIs(error::INVALID_ARGUMENT));
+  EXPECT_THAT(stream.AddRange(25, "abcdef"),
+              StatusIs(error::INVALID_ARGUMENT));
+  EXPECT_THAT(stream.AddRange(-1, "a"), StatusIs(error::INVALID_ARGUMENT));
+  EXPECT_THAT(stream.AddRange(20, "abcdef"), IsOk());
+}
+
+}  // namespace
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,123 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/secret_arena.h"
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define TINK_SECRET_ARENA_SUPPORTED 1
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/synchronization/mutex.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+namespace internal {
+
+std::atomic<SecretArena*> SecretArena::instance_{nullptr};
+
+// static
+bool SecretArena::Enable() {
+#ifdef TINK_SECRET_ARENA_SUPPORTED
+  static absl::Mutex* enable_mutex = new absl::Mutex();
+  absl::MutexLock lock(enable_mutex);
+  if (instance_.load(std::memory_order_acquire) != nullptr) return true;
+  void* memory = mmap(nullptr, kCapacity, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (memory == MAP_FAILED) return false;
+#ifdef MADV_DONTDUMP
+  madvise(memory, kCapacity, MADV_DONTDUMP);
+#endif
+  // Never freed: blocks may be deallocated until the process exits.
+  instance_.store(new SecretArena(static_cast<uint8_t*>(memory)),
+                  std::memory_order_release);
+  return true;
+#else
+  return false;
+#endif
+}
+
+// static
+int SecretArena::SizeClass(size_t size) {
+  int size_class = 0;
+  for (size_t block_size = kMinBlockSize; block_size < size; block_size *= 2) {
+    size_class++;
+  }
+  return size_class;
+}
+
+// static
+void* SecretArena::Allocate(size_t size) {
+  SecretArena* arena = instance_.load(std::memory_order_acquire);
+  if (arena == nullptr || size == 0 || size > kMaxAllocationSize) {
+    return nullptr;
+  }
+  return arena->AllocateBlock(SizeClass(size));
+}
+
+// static
+bool SecretArena::Deallocate(void* ptr, size_t size) {
+  SecretArena* arena = instance_.load(std::memory_order_acquire);
+  if (arena == nullptr || !arena->Contains(ptr)) return false;
+  arena->ReleaseBlock(ptr, SizeClass(size));
+  return true;
+}
+
+void* SecretArena::AllocateBlock(int size_class) {
+  absl::MutexLock lock(&mutex_);
+  FreeBlock* block = free_lists_[size_class];
+  if (block != nullptr) {
+    free_lists_[size_class] = block->next;
+    block->next = nullptr;
+    return block;
+  }
+  // Blocks are aligned to their size, which is a power of two.
+  size_t block_size = kMinBlockSize << size_class;
+  uintptr_t offset = next_ - begin_;
+  offset = (offset + block_size - 1) & ~(block_size - 1);
+  if (offset + block_size > kCapacity) return nullptr;
+  uint8_t* result = begin_ + offset;
+  next_ = result + block_size;
+#ifdef TINK_SECRET_ARENA_SUPPORTED
+  if (next_ > locked_end_) {
+    size_t lock_size =
+        ((next_ - locked_end_ + kLockChunkSize - 1) / kLockChunkSize) *
+        kLockChunkSize;
+    if (locked_end_ + lock_size > end_) lock_size = end_ - locked_end_;
+    // Best-effort; the memory is usable even if it cannot be locked.
+    mlock(locked_end_, lock_size);
+    locked_end_ += lock_size;
+  }
+#endif
+  return result;
+}
+
+void SecretArena::ReleaseBlock(void* ptr, int size_class) {
+  absl::MutexLock lock(&mutex_);
+  FreeBlock* block = static_cast<FreeBlock*>(ptr);
+  block->next = free_lists_[size_class];
+  free_lists_[size_class] = block;
+}
+
+}  // namespace internal
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
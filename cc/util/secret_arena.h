@@ -0,0 +1,101 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_SECRET_ARENA_H_
+#define TINK_UTIL_SECRET_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+namespace internal {
+
+// A process-wide arena for small secrets, such as keys, used by
+// SanitizingAllocator once it is enabled.
+//
+// The arena reserves kCapacity bytes of address space, excluded from core
+// dumps, and locks it into RAM (with mlock) as it is used, so that secrets
+// are never written to swap.  Locking is best-effort: if it fails, e.g.
+// because of RLIMIT_MEMLOCK, the arena is still used.  Blocks are handed out
+// in power-of-two size classes from kMinBlockSize to kMaxAllocationSize
+// bytes, and freed blocks are kept on a free list per class, so that
+// creating and destroying small keys does not go to the heap.  Allocations
+// which are larger, or which do not fit into the arena anymore, are left to
+// the caller.
+class SecretArena {
+ public:
+  static constexpr size_t kMinBlockSize = 16;
+  static constexpr size_t kMaxAllocationSize = 1024;
+  static constexpr size_t kCapacity = 4 << 20;
+
+  // Enables the arena for the rest of the process lifetime.  Returns false
+  // if the arena is not supported on this platform, or if its address space
+  // could not be reserved.  Calling it again has no effect.
+  static bool Enable();
+
+  // Returns a block of at least 'size' bytes, aligned to kMinBlockSize, or
+  // nullptr if the arena is not enabled, 'size' is 0 or larger than
+  // kMaxAllocationSize, or the arena is full.
+  static void* Allocate(size_t size);
+
+  // Returns the block at 'ptr' to the arena and returns true if it was
+  // allocated by Allocate(size); returns false otherwise.  The caller must
+  // have wiped the block.
+  static bool Deallocate(void* ptr, size_t size);
+
+ private:
+  static constexpr int kNumSizeClasses = 7;  // 16, 32, ..., 1024 bytes
+  // The granularity with which the used part of the arena is locked.
+  static constexpr size_t kLockChunkSize = 64 * 1024;
+
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  explicit SecretArena(uint8_t* begin)
+      : begin_(begin), end_(begin + kCapacity) {}
+
+  static int SizeClass(size_t size);
+  void* AllocateBlock(int size_class);
+  void ReleaseBlock(void* ptr, int size_class);
+  bool Contains(const void* ptr) const {
+    auto address = reinterpret_cast<uintptr_t>(ptr);
+    return address >= reinterpret_cast<uintptr_t>(begin_) &&
+           address < reinterpret_cast<uintptr_t>(end_);
+  }
+
+  static std::atomic<SecretArena*> instance_;
+
+  uint8_t* const begin_;
+  uint8_t* const end_;
+  absl::Mutex mutex_;
+  uint8_t* next_ ABSL_GUARDED_BY(mutex_) = begin_;  // first never-used byte
+  uint8_t* locked_end_ ABSL_GUARDED_BY(mutex_) = begin_;
+  FreeBlock* free_lists_[kNumSizeClasses] ABSL_GUARDED_BY(mutex_) = {};
+};
+
+}  // namespace internal
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_SECRET_ARENA_H_
@@ -0,0 +1,101 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/secret_arena.h"
+
+#include <cstdint>
+#include <cstring>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/util/secret_data.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+namespace internal {
+namespace {
+
+using ::testing::Each;
+using ::testing::Eq;
+
+// Must run first, as the arena cannot be disabled once enabled.
+TEST(SecretArenaTest, DisabledByDefault) {
+  EXPECT_EQ(nullptr, SecretArena::Allocate(16));
+  uint8_t buffer[16];
+  EXPECT_FALSE(SecretArena::Deallocate(buffer, sizeof(buffer)));
+}
+
+TEST(SecretArenaTest, AllocateAndReuse) {
+  ASSERT_TRUE(SecretArena::Enable());
+  ASSERT_TRUE(SecretArena::Enable());
+
+  void* ptr = SecretArena::Allocate(20);
+  ASSERT_NE(nullptr, ptr);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(ptr) % SecretArena::kMinBlockSize);
+  memset(ptr, 0, 20);
+  EXPECT_TRUE(SecretArena::Deallocate(ptr, 20));
+  // 20 and 32 bytes are in the same size class.
+  EXPECT_EQ(ptr, SecretArena::Allocate(32));
+  EXPECT_TRUE(SecretArena::Deallocate(ptr, 32));
+  EXPECT_NE(ptr, SecretArena::Allocate(33));
+
+  EXPECT_EQ(nullptr, SecretArena::Allocate(0));
+  EXPECT_EQ(nullptr,
+            SecretArena::Allocate(SecretArena::kMaxAllocationSize + 1));
+  uint8_t buffer[16];
+  EXPECT_FALSE(SecretArena::Deallocate(buffer, sizeof(buffer)));
+}
+
+TEST(SecretArenaTest, SecretDataIsAllocatedAndWipedInArena) {
+  ASSERT_TRUE(SecretArena::Enable());
+  const uint8_t* data;
+  {
+    SecretData secret(64, 'x');
+    data = secret.data();
+  }
+  // The block of the destroyed SecretData is the first one to be reused.
+  auto* block = static_cast<uint8_t*>(SecretArena::Allocate(64));
+  ASSERT_EQ(data, block);
+  EXPECT_THAT(std::vector<uint8_t>(block, block + 64), Each(Eq(0)));
+  SecretArena::Deallocate(block, 64);
+
+  // Larger secrets are still allocated on the heap.
+  SecretData large(SecretArena::kMaxAllocationSize + 1, 'y');
+  EXPECT_THAT(large, Each(Eq('y')));
+}
+
+TEST(SecretArenaTest, ConcurrentUse) {
+  ASSERT_TRUE(SecretArena::Enable());
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([t]() {
+      for (int i = 0; i < 1000; i++) {
+        SecretData secret(1 + (t * 1000 + i) % 100, 't');
+        EXPECT_THAT(secret, Each(Eq('t')));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
@@ -16,9 +16,12 @@
 #define TINK_UTIL_SECRET_DATA_INTERNAL_H_
 
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 
 #include "absl/base/attributes.h"
+#include "tink/util/secret_arena.h"
 
 namespace crypto {
 namespace tink {
@@ -27,10 +30,27 @@ namespace internal {
 
 // placeholder for sanitization_functions, please ignore
 inline void SafeZeroMemory(char* ptr, std::size_t size) {
+  if (size == 0) return;
+#if defined(__GNUC__) || defined(__clang__)
+  // A plain (vectorized) memset, followed by an empty asm statement which
+  // the compiler must assume reads the memory at ptr, so that the memset
+  // cannot be removed as a dead store. This is how OPENSSL_cleanse works.
+  std::memset(ptr, 0, size);
+  __asm__ __volatile__("" : : "r"(ptr) : "memory");
+#else
   volatile char* vptr = ptr;
   while (size--) {
     *vptr++ = 0;
   }
+#endif
+}
+
+// Returns memory for 'size' bytes with alignment 'alignment' from the
+// SecretArena, if it is enabled and can serve the request, and nullptr
+// otherwise.
+inline void* AllocateFromSecretArena(std::size_t size, std::size_t alignment) {
+  if (alignment > SecretArena::kMinBlockSize) return nullptr;
+  return SecretArena::Allocate(size);
 }
 
 template <typename T>
@@ -43,12 +63,18 @@ struct SanitizingAllocator {
       const SanitizingAllocator<U>&) noexcept {}
 
   ABSL_MUST_USE_RESULT T* allocate(std::size_t n) {
+    if (n <= SecretArena::kMaxAllocationSize / sizeof(T)) {
+      void* ptr = AllocateFromSecretArena(n * sizeof(T), alignof(T));
+      if (ptr != nullptr) return static_cast<T*>(ptr);
+    }
     return std::allocator<T>().allocate(n);
   }
 
   void deallocate(T* ptr, std::size_t n) noexcept {
     SafeZeroMemory(reinterpret_cast<char*>(ptr), n * sizeof(T));
-    std::allocator<T>().deallocate(ptr, n);
+    if (!SecretArena::Deallocate(ptr, n * sizeof(T))) {
+      std::allocator<T>().deallocate(ptr, n);
+    }
   }
 
   // Allocator requirements mandate definition of eq and neq operators
@@ -66,11 +92,14 @@ struct SanitizingAllocator<void> {
   explicit constexpr SanitizingAllocator(
       const SanitizingAllocator<U>&) noexcept {}
 
-  ABSL_MUST_USE_RESULT void* allocate(std::size_t n) { return std::malloc(n); }
+  ABSL_MUST_USE_RESULT void* allocate(std::size_t n) {
+    void* ptr = AllocateFromSecretArena(n, alignof(std::max_align_t));
+    return ptr != nullptr ? ptr : std::malloc(n);
+  }
 
   void deallocate(void* ptr, std::size_t n) noexcept {
     SafeZeroMemory(reinterpret_cast<char*>(ptr), n);
-    std::free(ptr);
+    if (!SecretArena::Deallocate(ptr, n)) std::free(ptr);
   }
 
   // Allocator requirements mandate definition of eq and neq operators
@@ -17,6 +17,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/strings/string_view.h"
+#include "tink/util/secret_data_internal.h"
 
 namespace crypto {
 namespace tink {
@@ -27,6 +28,14 @@ using ::testing::AnyOf;
 using ::testing::ElementsAreArray;
 using ::testing::Eq;
 
+TEST(SafeZeroMemoryTest, ZeroesAllBytes) {
+  for (int size : {0, 1, 15, 16, 17, 100}) {
+    std::string buffer(size + 2, 'x');
+    internal::SafeZeroMemory(&buffer[1], size);
+    EXPECT_THAT(buffer, Eq("x" + std::string(size, '\0') + "x"));
+  }
+}
+
 TEST(SecretDataTest, OneByOneInsertion) {
   constexpr unsigned char kContents[] = {41, 42, 64, 12, 41, 0,
                                          52, 56, 6,  12, 127, 13};
@@ -15,6 +15,7 @@
 #ifndef TINK_UTIL_SECRET_PROTO_H_
 #define TINK_UTIL_SECRET_PROTO_H_
 
+#include <cstddef>
 #include <memory>
 #include <utility>
 
@@ -81,6 +82,48 @@ class SecretProto {
   T* value_ = google::protobuf::Arena::CreateMessage<T>(arena_.get());
 };
 
+// A protobuf arena for the secret protos of a single operation, such as the
+// key of a one-time DEK, meant to live on the stack. The first kInlineSize
+// bytes come from the object itself, so that small messages need no heap
+// allocation, and further blocks come from the SanitizingAllocator. All
+// blocks are wiped when the arena is destroyed.
+//
+// Only the message objects live on the arena: string fields longer than the
+// small string buffer still allocate their bytes on the heap.
+class ScopedSecretArena {
+ public:
+  static constexpr size_t kInlineSize = 512;
+
+  ScopedSecretArena() : arena_(Options(inline_block_.data)) {}
+
+  ScopedSecretArena(const ScopedSecretArena&) = delete;
+  ScopedSecretArena& operator=(const ScopedSecretArena&) = delete;
+
+  // Returns a new message of type T, owned by the arena.
+  template <typename T>
+  T* Create() {
+    return google::protobuf::Arena::CreateMessage<T>(&arena_);
+  }
+
+ private:
+  static google::protobuf::ArenaOptions Options(char* inline_block) {
+    google::protobuf::ArenaOptions options = internal::SecretArenaOptions();
+    options.initial_block = inline_block;
+    options.initial_block_size = kInlineSize;
+    return options;
+  }
+
+  // Wiped only after 'arena_' is destroyed, which keeps its own state in
+  // the block.
+  struct InlineBlock {
+    ~InlineBlock() { internal::SafeZeroMemory(data, kInlineSize); }
+    alignas(std::max_align_t) char data[kInlineSize];
+  };
+
+  InlineBlock inline_block_;
+  google::protobuf::Arena arena_;
+};
+
 }  // namespace util
 }  // namespace tink
 }  // namespace crypto
@@ -15,6 +15,7 @@
 #include "tink/util/secret_proto.h"
 
 #include <utility>
+#include <vector>
 
 #include "google/protobuf/util/message_differencer.h"
 #include "gmock/gmock.h"
@@ -128,6 +129,25 @@ TYPED_TEST(SecretProtoTest, MoveAssignment) {
   EXPECT_TRUE(MessageDifferencer::Equals(*t, proto));
 }
 
+TYPED_TEST(SecretProtoTest, ScopedSecretArena) {
+  TypeParam proto = CreateProto<TypeParam>();
+  ScopedSecretArena arena;
+  TypeParam* s = arena.template Create<TypeParam>();
+  EXPECT_EQ(s->GetArena(), arena.template Create<TypeParam>()->GetArena());
+  *s = proto;
+  EXPECT_TRUE(MessageDifferencer::Equals(*s, proto));
+}
+
+TEST(ScopedSecretArenaTest, GrowsBeyondInlineBlock) {
+  ScopedSecretArena arena;
+  std::vector<TestProto*> protos;
+  for (int i = 0; i < 100; i++) {
+    protos.push_back(arena.Create<TestProto>());
+    protos.back()->set_num(i);
+  }
+  for (int i = 0; i < 100; i++) EXPECT_EQ(i, protos[i]->num());
+}
+
 }  // namespace
 }  // namespace util
 }  // namespace tink
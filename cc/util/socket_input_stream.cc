@@ -0,0 +1,156 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/socket_input_stream.h"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include "absl/memory/memory.h"
+#include "tink/input_stream.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+namespace {
+
+// Attempts to close file descriptor fd, while ignoring EINTR.
+// (code borrowed from ZeroCopy-streams)
+int close_ignoring_eintr(int fd) {
+  int result;
+  do {
+    result = close(fd);
+  } while (result < 0 && errno == EINTR);
+  return result;
+}
+
+// Attempts to receive up to 'count' bytes of data from fd, which is a
+// socket iff 'is_socket', to 'buf' with 'flags', while ignoring EINTR.
+ssize_t recv_ignoring_eintr(int fd, bool is_socket, void* buf, size_t count,
+                            int flags) {
+  ssize_t result;
+  do {
+    result = is_socket ? recv(fd, buf, count, flags) : read(fd, buf, count);
+  } while (result < 0 && errno == EINTR);
+  return result;
+}
+
+}  // anonymous namespace
+
+SocketInputStream::SocketInputStream(int socket_fd, int buffer_size)
+    : buffer_size_(buffer_size > 0 ? buffer_size : 128 * 1024) {  // 128 KB
+  fd_ = socket_fd;
+  struct stat stat_buf;
+  is_socket_ = fstat(fd_, &stat_buf) == 0 && S_ISSOCK(stat_buf.st_mode);
+  at_end_ = false;
+  buffer_ = absl::make_unique<uint8_t[]>(buffer_size_);
+  position_ = 0;
+  start_ = 0;
+  end_ = 0;
+  last_count_ = 0;
+  status_ = Status::OK;
+}
+
+SocketInputStream::~SocketInputStream() {
+  close_ignoring_eintr(fd_);
+}
+
+crypto::tink::util::StatusOr<int> SocketInputStream::Next(const void** data) {
+  if (!status_.ok()) return status_;
+  if (start_ == end_) {
+    // Read new bytes to buffer_.
+    last_count_ = 0;
+    if (at_end_) {
+      status_ = Status(util::error::OUT_OF_RANGE, "EOF");
+      return status_;
+    }
+    ssize_t read_result =
+        recv_ignoring_eintr(fd_, is_socket_, buffer_.get(), buffer_size_, 0);
+    if (read_result <= 0) {  // EOF, no data for now, or an I/O error.
+      if (read_result == 0) {
+        at_end_ = true;
+        status_ = Status(util::error::OUT_OF_RANGE, "EOF");
+      } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return Status(util::error::UNAVAILABLE, "Socket would block");
+      } else {
+        status_ = ToStatusF(util::error::INTERNAL, "I/O error: %d", errno);
+      }
+      return status_;
+    }
+    start_ = 0;
+    end_ = read_result;
+  }
+  *data = buffer_.get() + start_;
+  last_count_ = end_ - start_;
+  start_ = end_;
+  position_ = position_ + last_count_;
+  return last_count_;
+}
+
+void SocketInputStream::BackUp(int count) {
+  if (!status_.ok() || count < 1) return;
+  int actual_count = std::min(count, last_count_);
+  last_count_ -= actual_count;
+  start_ -= actual_count;
+  position_ = position_ - actual_count;
+}
+
+crypto::tink::util::StatusOr<int> SocketInputStream::Fill() {
+  if (!status_.ok()) return status_;
+  // Move the bytes not returned yet to the front of buffer_.
+  if (start_ > 0) {
+    std::memmove(buffer_.get(), buffer_.get() + start_, end_ - start_);
+    end_ -= start_;
+    start_ = 0;
+  }
+  last_count_ = 0;
+  int count_read = 0;
+  while (!at_end_ && end_ < buffer_size_) {
+    ssize_t read_result =
+        recv_ignoring_eintr(fd_, is_socket_, buffer_.get() + end_,
+                            buffer_size_ - end_, MSG_DONTWAIT);
+    if (read_result == 0) {
+      at_end_ = true;
+    } else if (read_result > 0) {
+      end_ += read_result;
+      count_read += read_result;
+      if (!is_socket_) break;
+    } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      break;
+    } else {
+      status_ = ToStatusF(util::error::INTERNAL, "I/O error: %d", errno);
+      return status_;
+    }
+  }
+  return count_read;
+}
+
+int64_t SocketInputStream::Position() const {
+  return position_;
+}
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
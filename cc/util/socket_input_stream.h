@@ -0,0 +1,98 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_SOCKET_INPUT_STREAM_H_
+#define TINK_UTIL_SOCKET_INPUT_STREAM_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "tink/input_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// An InputStream that reads from a connected stream socket or a pipe,
+// like FileInputStream, but which also serves non-blocking sockets driven
+// by an event loop (e.g. epoll):
+// * If the socket is non-blocking and has no data, Next() returns
+//   UNAVAILABLE.  Unlike other errors, this one is not permanent, and
+//   Next() can be called again once the socket is readable.
+// * Fill() reads what the socket has into the buffer, without blocking.
+//
+// Readers that treat every error as permanent, like the decrypting streams
+// of StreamingAead, must not see UNAVAILABLE.  So an event loop watches
+// fd() for EPOLLIN, calls Fill() when it fires, and reads from such a
+// reader only while buffered_size() covers what the reader consumes next
+// (for a decrypting stream: a ciphertext segment and one more byte, or the
+// header and the first segment at first), or the socket reached its end.
+// The buffer must be large enough for that.
+class SocketInputStream : public crypto::tink::InputStream {
+ public:
+  // Constructs an InputStream that will read from the socket or pipe
+  // 'socket_fd', using a buffer of the specified size, if any (if no legal
+  // 'buffer_size' is given, a reasonable default will be used).
+  // Takes the ownership of the socket, and will close it upon destruction.
+  explicit SocketInputStream(int socket_fd, int buffer_size = -1);
+
+  ~SocketInputStream() override;
+
+  crypto::tink::util::StatusOr<int> Next(const void** data) override;
+
+  void BackUp(int count) override;
+
+  int64_t Position() const override;
+
+  // Reads from the socket until the buffer is full, or the socket has no
+  // more data for now, and returns the number of bytes read.  Never blocks
+  // on sockets.  Reads from pipes once, which blocks if the pipe is empty
+  // and blocking.
+  // After Fill(), BackUp() has no effect until the next call to Next().
+  crypto::tink::util::StatusOr<int> Fill();
+
+  // The number of bytes in the buffer that Next() has not returned yet.
+  int buffered_size() const { return end_ - start_; }
+
+  // Returns true iff the socket reached its end, i.e. no more bytes
+  // will be read from it beyond the buffered ones.
+  bool at_end() const { return at_end_; }
+
+  int fd() const { return fd_; }
+
+ private:
+  util::Status status_;
+  int fd_;
+  bool is_socket_;
+  bool at_end_;
+  std::unique_ptr<uint8_t[]> buffer_;
+  const int buffer_size_;
+  int64_t position_;  // current position in the stream
+
+  // The bytes of buffer_ in [start_, end_) were not returned by Next() yet,
+  // and the last call to Next() returned the last_count_ bytes before them.
+  int start_;
+  int end_;
+  int last_count_;
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_SOCKET_INPUT_STREAM_H_
@@ -0,0 +1,172 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/socket_input_stream.h"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "tink/subtle/random.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+// Writes all of 'contents' to 'fd', and closes it.
+void WriteAndClose(int fd, const std::string& contents) {
+  size_t written = 0;
+  while (written < contents.size()) {
+    ssize_t result =
+        write(fd, contents.data() + written, contents.size() - written);
+    ASSERT_GT(result, 0);
+    written += result;
+  }
+  close(fd);
+}
+
+// Reads the specified 'input_stream' until no more bytes can be read,
+// and puts the read bytes into 'contents'.
+// Returns the status of the last input_stream->Next()-operation.
+util::Status ReadTillEnd(util::SocketInputStream* input_stream,
+                         std::string* contents) {
+  contents->clear();
+  const void* buffer;
+  auto next_result = input_stream->Next(&buffer);
+  while (next_result.ok()) {
+    contents->append(static_cast<const char*>(buffer),
+                     next_result.ValueOrDie());
+    next_result = input_stream->Next(&buffer);
+  }
+  return next_result.status();
+}
+
+class SocketInputStreamTest : public ::testing::Test {
+};
+
+TEST_F(SocketInputStreamTest, ReadingSockets) {
+  for (auto stream_size : {0, 10, 100000, 1000000}) {
+    SCOPED_TRACE(absl::StrCat("stream_size = ", stream_size));
+    int fds[2];
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    std::string contents = subtle::Random::GetRandomBytes(stream_size);
+    std::thread writer(WriteAndClose, fds[1], contents);
+    auto input_stream = absl::make_unique<util::SocketInputStream>(fds[0]);
+    std::string stream_contents;
+    auto status = ReadTillEnd(input_stream.get(), &stream_contents);
+    writer.join();
+    EXPECT_EQ(util::error::OUT_OF_RANGE, status.error_code());
+    EXPECT_EQ(contents, stream_contents);
+    EXPECT_EQ(stream_size, input_stream->Position());
+  }
+}
+
+TEST_F(SocketInputStreamTest, ReadingPipes) {
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+  std::string contents = subtle::Random::GetRandomBytes(300000);
+  std::thread writer(WriteAndClose, fds[1], contents);
+  auto input_stream = absl::make_unique<util::SocketInputStream>(fds[0]);
+  std::string stream_contents;
+  auto status = ReadTillEnd(input_stream.get(), &stream_contents);
+  writer.join();
+  EXPECT_EQ(util::error::OUT_OF_RANGE, status.error_code());
+  EXPECT_EQ(contents, stream_contents);
+}
+
+TEST_F(SocketInputStreamTest, NonBlockingSocket) {
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  ASSERT_EQ(0, fcntl(fds[0], F_SETFL, O_NONBLOCK));
+  auto input_stream = absl::make_unique<util::SocketInputStream>(fds[0]);
+
+  // Without data, Next() returns UNAVAILABLE, which is not permanent.
+  const void* buffer;
+  auto next_result = input_stream->Next(&buffer);
+  EXPECT_EQ(util::error::UNAVAILABLE, next_result.status().error_code());
+  auto fill_result = input_stream->Fill();
+  ASSERT_TRUE(fill_result.ok()) << fill_result.status();
+  EXPECT_EQ(0, fill_result.ValueOrDie());
+
+  std::string contents = subtle::Random::GetRandomBytes(1000);
+  ASSERT_EQ(100, write(fds[1], contents.data(), 100));
+  next_result = input_stream->Next(&buffer);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  EXPECT_EQ(100, next_result.ValueOrDie());
+  EXPECT_EQ(contents.substr(0, 100),
+            std::string(static_cast<const char*>(buffer), 100));
+  input_stream->BackUp(40);
+  EXPECT_EQ(60, input_stream->Position());
+  EXPECT_EQ(40, input_stream->buffered_size());
+
+  // Fill() appends to the bytes not returned yet.
+  ASSERT_EQ(900, write(fds[1], contents.data() + 100, 900));
+  fill_result = input_stream->Fill();
+  ASSERT_TRUE(fill_result.ok()) << fill_result.status();
+  EXPECT_EQ(900, fill_result.ValueOrDie());
+  EXPECT_EQ(940, input_stream->buffered_size());
+  EXPECT_FALSE(input_stream->at_end());
+  next_result = input_stream->Next(&buffer);
+  ASSERT_TRUE(next_result.ok()) << next_result.status();
+  EXPECT_EQ(940, next_result.ValueOrDie());
+  EXPECT_EQ(contents.substr(60),
+            std::string(static_cast<const char*>(buffer), 940));
+  EXPECT_EQ(1000, input_stream->Position());
+  next_result = input_stream->Next(&buffer);
+  EXPECT_EQ(util::error::UNAVAILABLE, next_result.status().error_code());
+
+  // The end of the socket is noticed by Fill() and Next().
+  close(fds[1]);
+  fill_result = input_stream->Fill();
+  ASSERT_TRUE(fill_result.ok()) << fill_result.status();
+  EXPECT_EQ(0, fill_result.ValueOrDie());
+  EXPECT_TRUE(input_stream->at_end());
+  next_result = input_stream->Next(&buffer);
+  EXPECT_EQ(util::error::OUT_OF_RANGE, next_result.status().error_code());
+  EXPECT_EQ(1000, input_stream->Position());
+}
+
+TEST_F(SocketInputStreamTest, FillStopsAtBufferSize) {
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  std::string contents = subtle::Random::GetRandomBytes(1500);
+  ASSERT_EQ(1500, write(fds[1], contents.data(), contents.size()));
+  close(fds[1]);
+  // Fill() does not block on a blocking socket.
+  auto input_stream =
+      absl::make_unique<util::SocketInputStream>(fds[0], 1000);
+  auto fill_result = input_stream->Fill();
+  ASSERT_TRUE(fill_result.ok()) << fill_result.status();
+  EXPECT_EQ(1000, fill_result.ValueOrDie());
+  EXPECT_EQ(1000, input_stream->buffered_size());
+  EXPECT_FALSE(input_stream->at_end());
+
+  std::string stream_contents;
+  auto status = ReadTillEnd(input_stream.get(), &stream_contents);
+  EXPECT_EQ(util::error::OUT_OF_RANGE, status.error_code());
+  EXPECT_EQ(contents, stream_contents);
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
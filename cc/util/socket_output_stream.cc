@@ -0,0 +1,349 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/socket_output_stream.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "tink/output_stream.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+namespace {
+
+#if defined(__linux__) && defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+constexpr bool kZeroCopySupported = true;
+constexpr int kZeroCopyFlag = MSG_ZEROCOPY;
+#else
+constexpr bool kZeroCopySupported = false;
+constexpr int kZeroCopyFlag = 0;
+#endif
+
+// Attempts to close file descriptor fd, while ignoring EINTR.
+// (code borrowed from ZeroCopy-streams)
+int close_ignoring_eintr(int fd) {
+  int result;
+  do {
+    result = close(fd);
+  } while (result < 0 && errno == EINTR);
+  return result;
+}
+
+// Attempts to send 'count' bytes of data from 'buf' to fd, which is a
+// socket iff 'is_socket', with 'flags', while ignoring EINTR.
+ssize_t send_ignoring_eintr(int fd, bool is_socket, const void* buf,
+                            size_t count, int flags) {
+  ssize_t result;
+  do {
+    result = is_socket ? send(fd, buf, count, flags | MSG_NOSIGNAL)
+                       : write(fd, buf, count);
+  } while (result < 0 && errno == EINTR);
+  return result;
+}
+
+bool IsNonBlocking(int fd) {
+  int flags = fcntl(fd, F_GETFL);
+  return flags >= 0 && (flags & O_NONBLOCK) != 0;
+}
+
+Status WouldBlock() {
+  return Status(util::error::UNAVAILABLE, "Socket would block");
+}
+
+}  // anonymous namespace
+
+SocketOutputStream::SocketOutputStream(int socket_fd, int buffer_size,
+                                       bool zero_copy)
+    : buffer_size_(buffer_size > 0 ? buffer_size : 128 * 1024) {  // 128 KB
+  fd_ = socket_fd;
+  struct stat stat_buf;
+  is_socket_ = fstat(fd_, &stat_buf) == 0 && S_ISSOCK(stat_buf.st_mode);
+  zero_copy_ = false;
+#if defined(__linux__) && defined(SO_ZEROCOPY)
+  int one = 1;
+  zero_copy_ = zero_copy && kZeroCopySupported && is_socket_ &&
+               setsockopt(fd_, SOL_SOCKET, SO_ZEROCOPY, &one,
+                          sizeof(one)) == 0;
+#endif
+  closing_ = false;
+  position_ = 0;
+  next_send_id_ = 0;
+  buffer_ = nullptr;
+  count_in_buffer_ = 0;
+  count_backedup_ = 0;
+  buffer_offset_ = 0;
+  status_ = Status::OK;
+}
+
+SocketOutputStream::~SocketOutputStream() {
+  if (fd_ < 0) return;
+  if (status_.ok() && Close().ok()) return;
+  if (fd_ < 0) return;
+  // The kernel may still read from the buffers of zero-copy sends.
+  for (Chunk& chunk : queued_) {
+    if (chunk.completed < chunk.send_count) chunk.buffer.release();
+  }
+  for (Chunk& chunk : in_flight_) chunk.buffer.release();
+  close_ignoring_eintr(fd_);
+  fd_ = -1;
+}
+
+std::unique_ptr<uint8_t[]> SocketOutputStream::AcquireBuffer() {
+  if (free_buffers_.empty()) {
+    return absl::make_unique<uint8_t[]>(buffer_size_);
+  }
+  std::unique_ptr<uint8_t[]> buffer = std::move(free_buffers_.back());
+  free_buffers_.pop_back();
+  return buffer;
+}
+
+crypto::tink::util::StatusOr<int> SocketOutputStream::Next(void** data) {
+  if (!status_.ok()) return status_;
+  if (closing_) {
+    return Status(util::error::FAILED_PRECONDITION, "Stream closed");
+  }
+
+  if (buffer_ == nullptr) {  // possible only at the first call to Next()
+    buffer_ = AcquireBuffer();
+    *data = buffer_.get();
+    count_in_buffer_ = buffer_size_;
+    position_ = buffer_size_;
+    return buffer_size_;
+  }
+
+  // If some space was backed up, return it first.
+  if (count_backedup_ > 0) {
+    position_ = position_ + count_backedup_;
+    buffer_offset_ = count_in_buffer_;
+    count_in_buffer_ = count_in_buffer_ + count_backedup_;
+    int backedup = count_backedup_;
+    count_backedup_ = 0;
+    *data = buffer_.get() + buffer_offset_;
+    return backedup;
+  }
+
+  // No space was backed up, so buffer_ is full: queue it, send what the
+  // socket takes, and return a fresh buffer.
+  queued_.push_back(Chunk{std::move(buffer_), buffer_size_, 0, 0, 0, 0});
+  Status status = SendPending();
+  if (!status.ok() && status.error_code() != util::error::UNAVAILABLE) {
+    return status;
+  }
+  buffer_ = AcquireBuffer();
+  count_in_buffer_ = buffer_size_;
+  buffer_offset_ = 0;
+  position_ = position_ + buffer_size_;
+  *data = buffer_.get();
+  return buffer_size_;
+}
+
+void SocketOutputStream::BackUp(int count) {
+  if (!status_.ok() || closing_ || count < 1 || count_in_buffer_ == 0) {
+    return;
+  }
+  int curr_buffer_size = buffer_size_ - buffer_offset_;
+  int actual_count = std::min(count, curr_buffer_size - count_backedup_);
+  count_backedup_ += actual_count;
+  count_in_buffer_ -= actual_count;
+  position_ -= actual_count;
+}
+
+Status SocketOutputStream::Flush() {
+  if (!status_.ok()) return status_;
+  if (!closing_ && count_in_buffer_ > 0) {
+    // The partial chunk is queued too, and all of a fresh buffer is backed
+    // up, as if Next() had returned it and BackUp() undone that.
+    queued_.push_back(Chunk{std::move(buffer_), count_in_buffer_, 0, 0, 0, 0});
+    buffer_ = AcquireBuffer();
+    count_in_buffer_ = 0;
+    count_backedup_ = buffer_size_;
+    buffer_offset_ = 0;
+  }
+  return SendPending();
+}
+
+Status SocketOutputStream::SendPending() {
+  if (!status_.ok()) return status_;
+  Status status = ReapCompletions();
+  if (status.ok()) status = SendQueued();
+  if (!status.ok() && status.error_code() != util::error::UNAVAILABLE) {
+    status_ = status;
+  }
+  return status;
+}
+
+Status SocketOutputStream::SendQueued() {
+  while (!queued_.empty()) {
+    Chunk& chunk = queued_.front();
+    int flags = zero_copy_ ? kZeroCopyFlag : 0;
+    ssize_t result = send_ignoring_eintr(
+        fd_, is_socket_, chunk.buffer.get() + chunk.sent,
+        chunk.size - chunk.sent, flags);
+    if (result < 0 && errno == ENOBUFS && flags != 0) {
+      // Out of memory for zero-copy bookkeeping, so send a copy.
+      flags = 0;
+      result = send_ignoring_eintr(fd_, is_socket_,
+                                   chunk.buffer.get() + chunk.sent,
+                                   chunk.size - chunk.sent, flags);
+    }
+    if (result < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return WouldBlock();
+      return ToStatusF(util::error::INTERNAL, "I/O error upon send: %d",
+                       errno);
+    }
+    if (flags != 0) {
+      if (chunk.send_count == 0) chunk.first_send = next_send_id_;
+      chunk.send_count++;
+      next_send_id_++;
+    }
+    chunk.sent += result;
+    if (chunk.sent < chunk.size) continue;
+    if (chunk.completed < chunk.send_count) {
+      in_flight_.push_back(std::move(chunk));
+    } else {
+      free_buffers_.push_back(std::move(chunk.buffer));
+    }
+    queued_.pop_front();
+  }
+  return Status::OK;
+}
+
+Status SocketOutputStream::ReapCompletions() {
+#ifdef __linux__
+  if (!zero_copy_) return Status::OK;
+  while (!in_flight_.empty() ||
+         (!queued_.empty() && queued_.front().send_count > 0)) {
+    char control[128];
+    struct msghdr msg = {};
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (recvmsg(fd_, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return Status::OK;
+      return ToStatusF(util::error::INTERNAL,
+                       "I/O error upon reading the error queue: %d", errno);
+    }
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      bool is_recverr =
+          (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+          (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR);
+      if (!is_recverr) continue;
+      const auto* err =
+          reinterpret_cast<const struct sock_extended_err*>(CMSG_DATA(cmsg));
+      if (err->ee_errno != 0 || err->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+        continue;
+      }
+      // The sends with ids in [ee_info, ee_data] are completed.
+      Complete(err->ee_info, err->ee_data);
+    }
+  }
+#endif
+  return Status::OK;
+}
+
+void SocketOutputStream::Complete(uint32_t first, uint32_t last) {
+  auto count_completed = [first, last](Chunk* chunk) {
+    if (chunk->send_count == 0) return;
+    uint32_t chunk_last = chunk->first_send + chunk->send_count - 1;
+    uint32_t overlap_first = std::max(first, chunk->first_send);
+    uint32_t overlap_last = std::min(last, chunk_last);
+    if (overlap_first <= overlap_last) {
+      chunk->completed += overlap_last - overlap_first + 1;
+    }
+  };
+  for (Chunk& chunk : queued_) count_completed(&chunk);
+  for (Chunk& chunk : in_flight_) count_completed(&chunk);
+  auto done = std::partition(
+      in_flight_.begin(), in_flight_.end(),
+      [](const Chunk& chunk) { return chunk.completed < chunk.send_count; });
+  for (auto it = done; it != in_flight_.end(); ++it) {
+    free_buffers_.push_back(std::move(it->buffer));
+  }
+  in_flight_.erase(done, in_flight_.end());
+}
+
+Status SocketOutputStream::Close() {
+  if (!status_.ok()) return status_;
+  if (!closing_) {
+    closing_ = true;
+    if (count_in_buffer_ > 0) {
+      queued_.push_back(
+          Chunk{std::move(buffer_), count_in_buffer_, 0, 0, 0, 0});
+    }
+    count_in_buffer_ = 0;
+  }
+  bool non_blocking = IsNonBlocking(fd_);
+  while (true) {
+    Status status = SendPending();
+    if (!status.ok()) return status;
+    if (in_flight_.empty()) break;
+    if (non_blocking) return WouldBlock();
+    // Wait for the completions, which the socket signals as an error.
+    struct pollfd poll_fd = {fd_, 0, 0};
+    if (poll(&poll_fd, 1, -1) < 0 && errno != EINTR) {
+      status_ = ToStatusF(util::error::INTERNAL, "I/O error upon poll: %d",
+                          errno);
+      return status_;
+    }
+  }
+  int close_result = close_ignoring_eintr(fd_);
+  fd_ = -1;
+  if (close_result == -1) {
+    status_ = ToStatusF(
+        util::error::INTERNAL, "I/O error upon close: %d", errno);
+    return status_;
+  }
+  status_ = Status(util::error::FAILED_PRECONDITION, "Stream closed");
+  return Status::OK;
+}
+
+int64_t SocketOutputStream::Position() const {
+  return position_;
+}
+
+int64_t SocketOutputStream::pending_bytes() const {
+  int64_t pending = 0;
+  for (const Chunk& chunk : queued_) pending += chunk.size - chunk.sent;
+  return pending;
+}
+
+bool SocketOutputStream::HasPendingOutput() const {
+  return !queued_.empty() || !in_flight_.empty();
+}
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
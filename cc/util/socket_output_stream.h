@@ -0,0 +1,142 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_SOCKET_OUTPUT_STREAM_H_
+#define TINK_UTIL_SOCKET_OUTPUT_STREAM_H_
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "tink/output_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// An OutputStream that writes to a connected stream socket or a pipe,
+// like FileOutputStream, but which also serves non-blocking sockets driven
+// by an event loop (e.g. epoll):
+// * Full chunks are sent as soon as Next() hands out the next one.  If the
+//   socket is non-blocking and cannot take a chunk, it is queued instead,
+//   so Next() never blocks, and Flush() sends the queue once the socket is
+//   writable again.  Flush() also sends the chunk being written, so that
+//   it delivers everything written so far.
+// * With 'zero_copy', chunks are sent with MSG_ZEROCOPY, and kept until the
+//   kernel reports (on the error queue of the socket, which makes it
+//   signal EPOLLERR) that it is done with them.  If the socket does not
+//   support SO_ZEROCOPY, or is a pipe, chunks are sent normally.
+//
+// An event loop watches fd() for EPOLLOUT while HasPendingOutput(), calls
+// Flush() when it fires, and stops producing output for the stream while
+// pending_bytes() is above its limit.  On non-blocking sockets, Flush() and
+// Close() return UNAVAILABLE if they would block; unlike other errors, this
+// one is not permanent, and the call is repeated when the socket is ready.
+// As this stream's Close() may thus have to be repeated, an encrypting
+// stream writing to it should be closed first, and then this stream.
+class SocketOutputStream : public crypto::tink::OutputStream {
+ public:
+  // Constructs an OutputStream that will write to the socket or pipe
+  // 'socket_fd', in chunks of 'buffer_size' bytes (if no legal value is
+  // given, a reasonable default will be used).  With 'zero_copy', the
+  // socket must not have been used with MSG_ZEROCOPY before.
+  // Takes the ownership of the socket, and will close it upon destruction.
+  explicit SocketOutputStream(int socket_fd, int buffer_size = -1,
+                              bool zero_copy = false);
+
+  // Closes the stream if needed.  Data that cannot be sent without blocking
+  // is dropped, and zero-copy buffers still used by the kernel are leaked.
+  ~SocketOutputStream() override;
+
+  crypto::tink::util::StatusOr<int> Next(void** data) override;
+
+  void BackUp(int count) override;
+
+  // Sends all the data and waits for zero-copy completions, and then
+  // closes the socket.  Can be repeated after UNAVAILABLE.
+  crypto::tink::util::Status Close() override;
+
+  int64_t Position() const override;
+
+  // Queues the chunk being written, if it has any bytes, and sends the
+  // queued chunks.  Returns OK if all were sent, and UNAVAILABLE if the
+  // socket would block.  Also processes zero-copy completions.
+  crypto::tink::util::Status Flush() override;
+
+  // Returns true iff chunks are queued, or are still used by the kernel.
+  bool HasPendingOutput() const;
+
+  // The number of queued bytes.
+  int64_t pending_bytes() const;
+
+  // Returns true iff chunks are sent with MSG_ZEROCOPY.
+  bool zero_copy() const { return zero_copy_; }
+
+  int fd() const { return fd_; }
+
+ private:
+  struct Chunk {
+    std::unique_ptr<uint8_t[]> buffer;
+    int size;                // # bytes to send
+    int sent;                // # bytes sent
+    uint32_t first_send;     // id of the first zero-copy send of the chunk
+    uint32_t send_count;     // # zero-copy sends of the chunk
+    uint32_t completed;      // # completed zero-copy sends of the chunk
+  };
+
+  // Returns a buffer of buffer_size_ bytes, reusing released ones.
+  std::unique_ptr<uint8_t[]> AcquireBuffer();
+  // Like Flush(), but leaves the chunk being written in buffer_.
+  crypto::tink::util::Status SendPending();
+  // Sends queued_ until it is empty or the socket would block.
+  crypto::tink::util::Status SendQueued();
+  // Reads the zero-copy completions from the error queue of the socket,
+  // without blocking, and releases the chunks that are done.
+  crypto::tink::util::Status ReapCompletions();
+  // Counts the zero-copy sends with ids in ['first', 'last'] as completed.
+  void Complete(uint32_t first, uint32_t last);
+
+  crypto::tink::util::Status status_;
+  int fd_;
+  bool is_socket_;
+  bool zero_copy_;
+  bool closing_;
+  const int buffer_size_;
+  int64_t position_;  // current position in the stream
+  uint32_t next_send_id_;  // id of the next zero-copy send
+
+  std::deque<Chunk> queued_;      // chunks not yet sent completely
+  std::vector<Chunk> in_flight_;  // sent zero-copy chunks not yet completed
+  std::vector<std::unique_ptr<uint8_t[]>> free_buffers_;
+
+  // The chunk handed out by Next(), and counters that describe the state
+  // of its data, as in FileOutputStream: count_in_buffer_ is always equal
+  // to (buffer_size_ - count_backedup_), except before the first call to
+  // Next(), when buffer_ is null.
+  std::unique_ptr<uint8_t[]> buffer_;
+  int count_in_buffer_;  // # bytes in buffer_ that will be eventually sent
+  int count_backedup_;   // # bytes in buffer_ that were backed up
+  int buffer_offset_;    // offset where the returned *data starts in buffer_
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_SOCKET_OUTPUT_STREAM_H_
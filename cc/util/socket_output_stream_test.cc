@@ -0,0 +1,210 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/socket_output_stream.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "gtest/gtest.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "tink/subtle/random.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+// Reads 'fd' until its end into 'contents', and closes it.
+void ReadAndClose(int fd, std::string* contents) {
+  char buffer[4096];
+  ssize_t result;
+  while ((result = read(fd, buffer, sizeof(buffer))) > 0) {
+    contents->append(buffer, result);
+  }
+  close(fd);
+}
+
+util::Status WriteFrom(util::SocketOutputStream* output_stream,
+                       const std::string& contents) {
+  return output_stream->WriteFrom(absl::MakeConstSpan(
+      reinterpret_cast<const uint8_t*>(contents.data()), contents.size()));
+}
+
+// Connects a TCP socket to a listening socket on the loopback interface,
+// and sets 'client' and 'server' to the ends of the connection.
+void ConnectTcp(int* client, int* server) {
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_GE(listener, 0);
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addr_len = sizeof(addr);
+  ASSERT_EQ(0, bind(listener, reinterpret_cast<sockaddr*>(&addr), addr_len));
+  ASSERT_EQ(0, listen(listener, 1));
+  ASSERT_EQ(0, getsockname(listener, reinterpret_cast<sockaddr*>(&addr),
+                           &addr_len));
+  *client = socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_GE(*client, 0);
+  ASSERT_EQ(0, connect(*client, reinterpret_cast<sockaddr*>(&addr),
+                       addr_len));
+  *server = accept(listener, nullptr, nullptr);
+  ASSERT_GE(*server, 0);
+  close(listener);
+}
+
+class SocketOutputStreamTest : public ::testing::Test {
+};
+
+TEST_F(SocketOutputStreamTest, WritingSockets) {
+  for (auto stream_size : {0, 10, 100000, 1000000}) {
+    SCOPED_TRACE(absl::StrCat("stream_size = ", stream_size));
+    int fds[2];
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    std::string received;
+    std::thread reader(ReadAndClose, fds[1], &received);
+    std::string contents = subtle::Random::GetRandomBytes(stream_size);
+    auto output_stream =
+        absl::make_unique<util::SocketOutputStream>(fds[0], 4096);
+    EXPECT_FALSE(output_stream->zero_copy());
+    auto status = WriteFrom(output_stream.get(), contents);
+    EXPECT_TRUE(status.ok()) << status;
+    EXPECT_EQ(stream_size, output_stream->Position());
+    status = output_stream->Close();
+    EXPECT_TRUE(status.ok()) << status;
+    reader.join();
+    EXPECT_EQ(contents, received);
+    EXPECT_EQ(util::error::FAILED_PRECONDITION,
+              output_stream->Close().error_code());
+  }
+}
+
+TEST_F(SocketOutputStreamTest, WritingPipes) {
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+  std::string received;
+  std::thread reader(ReadAndClose, fds[0], &received);
+  std::string contents = subtle::Random::GetRandomBytes(300000);
+  auto output_stream =
+      absl::make_unique<util::SocketOutputStream>(fds[1], 1000, true);
+  EXPECT_FALSE(output_stream->zero_copy());
+  auto status = WriteFrom(output_stream.get(), contents);
+  EXPECT_TRUE(status.ok()) << status;
+  status = output_stream->Close();
+  EXPECT_TRUE(status.ok()) << status;
+  reader.join();
+  EXPECT_EQ(contents, received);
+}
+
+TEST_F(SocketOutputStreamTest, FlushSendsPartialChunk) {
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+  auto output_stream =
+      absl::make_unique<util::SocketOutputStream>(fds[1], 1000);
+  auto status = WriteFrom(output_stream.get(), "hello");
+  EXPECT_TRUE(status.ok()) << status;
+  status = output_stream->Flush();
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_FALSE(output_stream->HasPendingOutput());
+  char buffer[5];
+  ASSERT_EQ(5, read(fds[0], buffer, sizeof(buffer)));
+  EXPECT_EQ("hello", std::string(buffer, sizeof(buffer)));
+
+  // The buffer is reused after a flush.
+  status = WriteFrom(output_stream.get(), " world");
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(11, output_stream->Position());
+  status = output_stream->Close();
+  EXPECT_TRUE(status.ok()) << status;
+  std::string received;
+  ReadAndClose(fds[0], &received);
+  EXPECT_EQ(" world", received);
+}
+
+TEST_F(SocketOutputStreamTest, NonBlockingSocketQueuesOutput) {
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  ASSERT_EQ(0, fcntl(fds[0], F_SETFL, O_NONBLOCK));
+  int buffer_size = 4096;
+  auto output_stream =
+      absl::make_unique<util::SocketOutputStream>(fds[0], buffer_size);
+
+  // Much more than the socket buffers hold is written without blocking.
+  std::string contents = subtle::Random::GetRandomBytes(4 * 1024 * 1024);
+  auto status = WriteFrom(output_stream.get(), contents);
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_TRUE(output_stream->HasPendingOutput());
+  EXPECT_GT(output_stream->pending_bytes(), 0);
+  status = output_stream->Flush();
+  EXPECT_EQ(util::error::UNAVAILABLE, status.error_code());
+  status = output_stream->Close();
+  EXPECT_EQ(util::error::UNAVAILABLE, status.error_code());
+
+  // Drain the socket, and retry Close() whenever it is writable.
+  std::string received;
+  std::thread reader(ReadAndClose, fds[1], &received);
+  while (true) {
+    status = output_stream->Close();
+    if (status.error_code() != util::error::UNAVAILABLE) break;
+    EXPECT_TRUE(output_stream->HasPendingOutput());
+    struct pollfd poll_fd = {output_stream->fd(), POLLOUT, 0};
+    poll(&poll_fd, 1, -1);
+  }
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_FALSE(output_stream->HasPendingOutput());
+  EXPECT_EQ(0, output_stream->pending_bytes());
+  reader.join();
+  EXPECT_EQ(contents, received);
+}
+
+TEST_F(SocketOutputStreamTest, ZeroCopy) {
+  int client, server;
+  ConnectTcp(&client, &server);
+  std::string received;
+  std::thread reader(ReadAndClose, server, &received);
+  auto output_stream =
+      absl::make_unique<util::SocketOutputStream>(client, 64 * 1024, true);
+  // SO_ZEROCOPY is supported by TCP sockets since Linux 4.14.
+  if (!output_stream->zero_copy()) {
+    std::clog << "MSG_ZEROCOPY is not supported, sending copies" << std::endl;
+  }
+  std::string contents = subtle::Random::GetRandomBytes(4 * 1024 * 1024);
+  for (int i = 0; i < 4; i++) {
+    auto status = WriteFrom(output_stream.get(),
+                            contents.substr(i * contents.size() / 4,
+                                            contents.size() / 4));
+    EXPECT_TRUE(status.ok()) << status;
+  }
+  // Close() waits until the kernel is done with the zero-copy buffers.
+  auto status = output_stream->Close();
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_FALSE(output_stream->HasPendingOutput());
+  reader.join();
+  EXPECT_EQ(contents, received);
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
@@ -15,6 +15,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <sstream>
+#include <utility>
 
 #include "tink/util/status.h"
 
@@ -61,23 +62,14 @@ Status::operator ::absl::Status() const {
   return ::absl::Status(static_cast<absl::StatusCode>(code_), message_);
 }
 
-Status::Status() : code_(::crypto::tink::util::error::OK), message_("") {
-}
-
 Status::Status(::crypto::tink::util::error::Code error,
-               const std::string& error_message)
-    : code_(error), message_(error_message) {
-  if (code_ == ::crypto::tink::util::error::OK) {
-    message_.clear();
+               std::string error_message)
+    : code_(error) {
+  if (code_ != ::crypto::tink::util::error::OK) {
+    message_ = std::move(error_message);
   }
 }
 
-Status& Status::operator=(const Status& other) {
-  code_ = other.code_;
-  message_ = other.message_;
-  return *this;
-}
-
 const Status& Status::CANCELLED = GetCancelled();
 const Status& Status::UNKNOWN = GetUnknown();
 const Status& Status::OK = GetOk();
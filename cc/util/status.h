@@ -136,16 +136,22 @@ class ABSL_MUST_USE_RESULT Status;
 
 // A Status is a combination of an error code and a string message (for non-OK
 // error codes).
+//
+// An OK status holds an empty message, so creating, copying and moving it
+// never allocates.
 class Status {
  public:
   // Creates an OK status
-  Status();
+  Status() : code_(::crypto::tink::util::error::OK) {}
 
-  // Make a Status from the specified error and message.
-  Status(::crypto::tink::util::error::Code error,
-         const std::string& error_message);
+  // Make a Status from the specified error and message.  The message is
+  // taken by value, so that temporaries are moved rather than copied.
+  Status(::crypto::tink::util::error::Code error, std::string error_message);
 
-  Status& operator=(const Status& other);
+  Status(const Status& other) = default;
+  Status(Status&& other) = default;
+  Status& operator=(const Status& other) = default;
+  Status& operator=(Status&& other) = default;
 
   // Some pre-defined Status objects
   static const Status& OK;  // Identical to 0-arg constructor
@@ -43,6 +43,7 @@ class StatusOr {
 
   // Builds from a non-OK status. Crashes if an OK status is specified.
   inline StatusOr(const ::crypto::tink::util::Status& status);  // NOLINT
+  inline StatusOr(::crypto::tink::util::Status&& status);       // NOLINT
 
   // Builds from the specified value.
   inline StatusOr(const T& value);  // NOLINT
@@ -61,6 +62,9 @@ class StatusOr {
   // Assignment operator.
   inline const StatusOr& operator=(const StatusOr& other);
 
+  // Move assignment operator.
+  inline const StatusOr& operator=(StatusOr&& other);
+
   // Conversion assignment operator, T must be assignable from U
   template <typename U>
   inline const StatusOr& operator=(const StatusOr<U>& other);
@@ -139,6 +143,16 @@ inline StatusOr<T>::StatusOr(
   }
 }
 
+template <typename T>
+inline StatusOr<T>::StatusOr(::crypto::tink::util::Status&& status)
+    : status_(std::move(status)) {
+  if (status_.ok()) {
+    std::cerr << "::crypto::tink::util::OkStatus() "
+              << "is not a valid argument to StatusOr\n";
+    std::_Exit(1);
+  }
+}
+
 template <typename T>
 inline StatusOr<T>::StatusOr(const T& value) : value_(value) {
 }
@@ -154,7 +168,7 @@ inline StatusOr<T>::StatusOr(const StatusOr& other)
 
 template <typename T>
 inline StatusOr<T>::StatusOr(StatusOr&& other)
-    : status_(other.status_), value_(std::move(other.value_)) {
+    : status_(std::move(other.status_)), value_(std::move(other.value_)) {
 }
 
 template <typename T>
@@ -174,6 +188,17 @@ inline const StatusOr<T>& StatusOr<T>::operator=(const StatusOr& other) {
   return *this;
 }
 
+template <typename T>
+inline const StatusOr<T>& StatusOr<T>::operator=(StatusOr&& other) {
+  status_ = std::move(other.status_);
+  if (status_.ok()) {
+    value_ = std::move(*other.value_);
+  } else {
+    value_ = absl::nullopt;
+  }
+  return *this;
+}
+
 template <typename T>
 template <typename U>
 inline const StatusOr<T>& StatusOr<T>::operator=(const StatusOr<U>& other) {
@@ -114,6 +114,33 @@ TEST(StatusOrTest, MoveOutMoveOnly) {
   ASSERT_THAT(*ten, Eq(10));
 }
 
+TEST(StatusOrTest, MoveAssignMoveOnly) {
+  StatusOr<std::unique_ptr<int>> status_or = absl::make_unique<int>(10);
+  StatusOr<std::unique_ptr<int>> other = absl::make_unique<int>(20);
+  status_or = std::move(other);
+  ASSERT_THAT(status_or.status(), IsOk());
+  EXPECT_THAT(status_or.ValueOrDie(), Pointee(Eq(20)));
+
+  status_or = Status(error::Code::NOT_FOUND, "Error message");
+  EXPECT_EQ(error::Code::NOT_FOUND, status_or.status().error_code());
+  EXPECT_EQ("Error message", status_or.status().error_message());
+}
+
+TEST(StatusOrTest, MoveKeepsStatus) {
+  StatusOr<std::string> error =
+      Status(error::Code::INVALID_ARGUMENT, "Error message");
+  StatusOr<std::string> moved = std::move(error);
+  EXPECT_EQ(error::Code::INVALID_ARGUMENT, moved.status().error_code());
+  EXPECT_EQ("Error message", moved.status().error_message());
+}
+
+TEST(StatusTest, OkStatusHasNoMessage) {
+  Status status(error::Code::OK, "ignored");
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ("", status.error_message());
+  EXPECT_EQ(Status::OK, status);
+}
+
 }  // namespace
 
 }  // namespace util
@@ -17,6 +17,7 @@
 #ifndef TINK_UTIL_TEST_UTIL_H_
 #define TINK_UTIL_TEST_UTIL_H_
 
+#include <atomic>
 #include <limits>
 #include <string>
 
@@ -32,6 +33,7 @@
 #include "tink/hybrid_decrypt.h"
 #include "tink/hybrid_encrypt.h"
 #include "tink/input_stream.h"
+#include "tink/key_manager.h"
 #include "tink/keyset_handle.h"
 #include "tink/kms_client.h"
 #include "tink/mac.h"
@@ -263,6 +265,45 @@ class DummyAead : public Aead {
   std::string aead_name_;
 };
 
+// A dummy KeyManager<Aead> for keys of type 'key_type', which creates
+// DummyAeads named after the key value.  If 'count' is not null, it is
+// incremented for each created DummyAead.  It cannot create new keys.
+class DummyAeadKeyManager : public KeyManager<Aead> {
+ public:
+  explicit DummyAeadKeyManager(absl::string_view key_type,
+                               std::atomic<int>* count = nullptr)
+      : key_type_(key_type),
+        count_(count),
+        key_factory_(KeyFactory::AlwaysFailingFactory(
+            crypto::tink::util::Status(util::error::UNIMPLEMENTED,
+                                       "not implemented"))) {}
+
+  crypto::tink::util::StatusOr<std::unique_ptr<Aead>> GetPrimitive(
+      const google::crypto::tink::KeyData& key_data) const override {
+    if (count_ != nullptr) (*count_)++;
+    return {absl::make_unique<DummyAead>(key_data.value())};
+  }
+
+  crypto::tink::util::StatusOr<std::unique_ptr<Aead>> GetPrimitive(
+      const portable_proto::MessageLite& key) const override {
+    return crypto::tink::util::Status(util::error::UNIMPLEMENTED,
+                                      "not implemented");
+  }
+
+  const std::string& get_key_type() const override { return key_type_; }
+
+  uint32_t get_version() const override { return 0; }
+
+  const KeyFactory& get_key_factory() const override {
+    return *key_factory_;
+  }
+
+ private:
+  std::string key_type_;
+  std::atomic<int>* count_;
+  std::unique_ptr<KeyFactory> key_factory_;
+};
+
 // A dummy implementation of CordAead-interface.
 // An instance of DummyCordAead can be identified by a name specified
 // as a parameter of the constructor.
@@ -0,0 +1,81 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/webpush/webpush_encrypter_cache.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "openssl/mem.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "tink/webpush/webpush_hybrid_encrypt.h"
+
+namespace crypto {
+namespace tink {
+namespace webpush {
+
+util::StatusOr<std::shared_ptr<const HybridEncrypt>> WebPushEncrypterCache::Get(
+    absl::string_view recipient_public_key,
+    const util::SecretData& auth_secret) {
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = entries_.find(recipient_public_key);
+    if (it != entries_.end() &&
+        it->second.auth_secret.size() == auth_secret.size() &&
+        CRYPTO_memcmp(it->second.auth_secret.data(), auth_secret.data(),
+                      auth_secret.size()) == 0) {
+      lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+      return it->second.encrypter;
+    }
+  }
+
+  // Decoding the public key is done without the lock held.
+  auto encrypter_result = WebPushHybridEncrypt::New(
+      recipient_public_key, auth_secret, params_, key_pool_);
+  if (!encrypter_result.ok()) return encrypter_result.status();
+  std::shared_ptr<const HybridEncrypt> encrypter =
+      std::move(encrypter_result.ValueOrDie());
+
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(recipient_public_key);
+  if (it != entries_.end()) {
+    lru_.erase(it->second.lru_position);
+    entries_.erase(it);
+  }
+  while (!lru_.empty() && entries_.size() >= max_entries_) {
+    entries_.erase(lru_.back());
+    lru_.pop_back();
+  }
+  if (max_entries_ > 0) {
+    lru_.emplace_front(recipient_public_key);
+    entries_[lru_.front()] = Entry{auth_secret, encrypter, lru_.begin()};
+  }
+  return encrypter;
+}
+
+int WebPushEncrypterCache::size() const {
+  absl::MutexLock lock(&mutex_);
+  return entries_.size();
+}
+
+}  // namespace webpush
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,89 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_WEBPUSH_WEBPUSH_ENCRYPTER_CACHE_H_
+#define TINK_WEBPUSH_WEBPUSH_ENCRYPTER_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/subtle/ecies_ephemeral_key_pool.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "tink/webpush/webpush_hybrid_encrypt.h"
+
+namespace crypto {
+namespace tink {
+namespace webpush {
+
+// Keeps the WebPushHybridEncrypt of the recently used subscriptions, so that
+// a service which sends many messages to the same subscribers decodes the
+// public key of a subscriber once.  All encrypters share 'params' and
+// 'key_pool'.
+//
+// The entries are indexed by the public key of the subscription; an entry
+// whose auth secret differs from the requested one is replaced.
+//
+// This class is thread-safe.
+class WebPushEncrypterCache {
+ public:
+  // The least recently used entry is dropped when a new one is added to a
+  // cache with 'max_entries' entries.  A null 'key_pool' is the same as
+  // none.
+  WebPushEncrypterCache(int max_entries, const WebPushParams& params,
+                        std::shared_ptr<subtle::EciesEphemeralKeyPool> key_pool)
+      : max_entries_(max_entries),
+        params_(params),
+        key_pool_(std::move(key_pool)) {}
+
+  // Returns the encrypter for the subscription with 'recipient_public_key'
+  // and 'auth_secret', which is created if it is not in the cache.
+  crypto::tink::util::StatusOr<std::shared_ptr<const HybridEncrypt>> Get(
+      absl::string_view recipient_public_key,
+      const util::SecretData& auth_secret) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Returns the number of cached encrypters.
+  int size() const ABSL_LOCKS_EXCLUDED(mutex_);
+
+ private:
+  struct Entry {
+    util::SecretData auth_secret;
+    std::shared_ptr<const HybridEncrypt> encrypter;
+    std::list<std::string>::iterator lru_position;
+  };
+
+  const int max_entries_;
+  const WebPushParams params_;
+  const std::shared_ptr<subtle::EciesEphemeralKeyPool> key_pool_;
+  mutable absl::Mutex mutex_;
+  // Entries indexed by the public key, with the least recently used one at
+  // the back of 'lru_'.
+  absl::flat_hash_map<std::string, Entry> entries_ ABSL_GUARDED_BY(mutex_);
+  std::list<std::string> lru_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace webpush
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_WEBPUSH_WEBPUSH_ENCRYPTER_CACHE_H_
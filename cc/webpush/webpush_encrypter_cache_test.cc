@@ -0,0 +1,111 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/webpush/webpush_encrypter_cache.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/test_matchers.h"
+#include "tink/webpush/webpush_hybrid_encrypt.h"
+#include "tink/webpush/webpush_util.h"
+
+namespace crypto {
+namespace tink {
+namespace webpush {
+namespace {
+
+using ::crypto::tink::subtle::EllipticCurveType;
+using ::crypto::tink::subtle::SubtleUtilBoringSSL;
+using ::crypto::tink::test::IsOk;
+using ::testing::Not;
+
+std::string NewPublicKey() {
+  auto key_result = SubtleUtilBoringSSL::GetNewEcKey(
+      EllipticCurveType::NIST_P256);
+  EXPECT_THAT(key_result.status(), IsOk());
+  return absl::StrCat("\x04", key_result.ValueOrDie().pub_x,
+                      key_result.ValueOrDie().pub_y);
+}
+
+util::SecretData AuthSecret(char value) {
+  return util::SecretData(kAuthSecretSize, value);
+}
+
+TEST(WebPushEncrypterCacheTest, ReturnsCachedEncrypter) {
+  WebPushEncrypterCache cache(10, WebPushParams(), nullptr);
+  std::string public_key = NewPublicKey();
+  auto first = cache.Get(public_key, AuthSecret('a'));
+  ASSERT_THAT(first.status(), IsOk());
+  auto second = cache.Get(public_key, AuthSecret('a'));
+  ASSERT_THAT(second.status(), IsOk());
+  EXPECT_EQ(first.ValueOrDie().get(), second.ValueOrDie().get());
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_THAT(first.ValueOrDie()->Encrypt("message", "").status(), IsOk());
+}
+
+TEST(WebPushEncrypterCacheTest, ReplacesEntryWithOtherAuthSecret) {
+  WebPushEncrypterCache cache(10, WebPushParams(), nullptr);
+  std::string public_key = NewPublicKey();
+  auto first = cache.Get(public_key, AuthSecret('a'));
+  ASSERT_THAT(first.status(), IsOk());
+  auto second = cache.Get(public_key, AuthSecret('b'));
+  ASSERT_THAT(second.status(), IsOk());
+  EXPECT_NE(first.ValueOrDie().get(), second.ValueOrDie().get());
+  EXPECT_EQ(cache.size(), 1);
+  auto third = cache.Get(public_key, AuthSecret('b'));
+  ASSERT_THAT(third.status(), IsOk());
+  EXPECT_EQ(second.ValueOrDie().get(), third.ValueOrDie().get());
+}
+
+TEST(WebPushEncrypterCacheTest, EvictsLeastRecentlyUsed) {
+  WebPushEncrypterCache cache(2, WebPushParams(), nullptr);
+  std::vector<std::string> public_keys = {NewPublicKey(), NewPublicKey(),
+                                          NewPublicKey()};
+  auto first = cache.Get(public_keys[0], AuthSecret('a'));
+  ASSERT_THAT(first.status(), IsOk());
+  ASSERT_THAT(cache.Get(public_keys[1], AuthSecret('a')).status(), IsOk());
+  // Uses the first entry, so that the second one is dropped next.
+  ASSERT_THAT(cache.Get(public_keys[0], AuthSecret('a')).status(), IsOk());
+  ASSERT_THAT(cache.Get(public_keys[2], AuthSecret('a')).status(), IsOk());
+  EXPECT_EQ(cache.size(), 2);
+
+  auto again = cache.Get(public_keys[0], AuthSecret('a'));
+  ASSERT_THAT(again.status(), IsOk());
+  EXPECT_EQ(first.ValueOrDie().get(), again.ValueOrDie().get());
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(WebPushEncrypterCacheTest, InvalidSubscriptionIsNotCached) {
+  WebPushEncrypterCache cache(10, WebPushParams(), nullptr);
+  EXPECT_THAT(cache.Get("not a public key", AuthSecret('a')).status(),
+              Not(IsOk()));
+  EXPECT_THAT(cache.Get(NewPublicKey(), util::SecretData(3)).status(),
+              Not(IsOk()));
+  EXPECT_EQ(cache.size(), 0);
+}
+
+}  // namespace
+}  // namespace webpush
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,133 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/webpush/webpush_hybrid_decrypt.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/webpush/webpush_util.h"
+
+namespace crypto {
+namespace tink {
+namespace webpush {
+
+using crypto::tink::subtle::EcPointFormat;
+using crypto::tink::subtle::EllipticCurveType;
+using crypto::tink::subtle::SubtleUtilBoringSSL;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+// static
+StatusOr<std::unique_ptr<HybridDecrypt>> WebPushHybridDecrypt::New(
+    const util::SecretData& recipient_private_key,
+    absl::string_view recipient_public_key,
+    const util::SecretData& auth_secret, int record_size) {
+  if (auth_secret.size() != kAuthSecretSize) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("auth secret must have ", kAuthSecretSize,
+                               " bytes"));
+  }
+  if (record_size < kCiphertextOverhead || record_size > kMaxCiphertextSize) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("invalid record size (", record_size,
+                               "); must be a number between [",
+                               kCiphertextOverhead, ", ", kMaxCiphertextSize,
+                               "]"));
+  }
+  if (recipient_public_key.size() != kPublicKeySize) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "recipient public key must be an uncompressed P-256 point");
+  }
+  auto private_key_result = SubtleUtilBoringSSL::str2bn(
+      util::SecretDataAsStringView(recipient_private_key));
+  if (!private_key_result.ok()) return private_key_result.status();
+  return {absl::WrapUnique(new WebPushHybridDecrypt(
+      std::move(private_key_result.ValueOrDie()), recipient_public_key,
+      auth_secret, record_size))};
+}
+
+StatusOr<std::string> WebPushHybridDecrypt::Decrypt(
+    absl::string_view ciphertext, absl::string_view context_info) const {
+  if (!context_info.empty()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "context_info must be empty because it is unused");
+  }
+  if (ciphertext.size() < kCiphertextOverhead) {
+    return Status(util::error::INVALID_ARGUMENT, "ciphertext too short");
+  }
+  if (ciphertext.size() > kMaxCiphertextSize) {
+    return Status(util::error::INVALID_ARGUMENT, "ciphertext too long");
+  }
+  absl::string_view salt = ciphertext.substr(0, kSaltSize);
+  uint32_t record_size = 0;
+  for (int i = 0; i < kRecordSizeLength; i++) {
+    record_size = (record_size << 8) |
+                  static_cast<uint8_t>(ciphertext[kSaltSize + i]);
+  }
+  if (record_size != record_size_ || record_size < ciphertext.size()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("invalid record size: ", record_size));
+  }
+  int public_key_size =
+      static_cast<uint8_t>(ciphertext[kSaltSize + kRecordSizeLength]);
+  if (public_key_size != kPublicKeySize) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("invalid ephemeral public key size: ",
+                               public_key_size));
+  }
+  absl::string_view as_public_key =
+      ciphertext.substr(kSaltSize + kRecordSizeLength + 1, kPublicKeySize);
+  absl::string_view payload = ciphertext.substr(kContentCodingHeaderSize);
+
+  auto as_public_point_result = SubtleUtilBoringSSL::EcPointDecode(
+      EllipticCurveType::NIST_P256, EcPointFormat::UNCOMPRESSED,
+      as_public_key);
+  if (!as_public_point_result.ok()) return as_public_point_result.status();
+  auto ecdh_secret_result = SubtleUtilBoringSSL::ComputeEcdhSharedSecret(
+      EllipticCurveType::NIST_P256, recipient_private_key_.get(),
+      as_public_point_result.ValueOrDie().get());
+  if (!ecdh_secret_result.ok()) return ecdh_secret_result.status();
+  auto keys_result =
+      DeriveMessageKeys(ecdh_secret_result.ValueOrDie(), auth_secret_,
+                        recipient_public_key_, as_public_key, salt);
+  if (!keys_result.ok()) return keys_result.status();
+  auto padded_result = OpenRecord(keys_result.ValueOrDie(), payload);
+  if (!padded_result.ok()) return padded_result.status();
+
+  // Removes the zero padding and the delimiter of the last record.
+  const util::SecretData& padded = padded_result.ValueOrDie();
+  size_t index = padded.size();
+  while (index > 0 && padded[index - 1] == 0) index--;
+  if (index == 0 || padded[index - 1] != kPaddingDelimiter) {
+    return Status(util::error::INVALID_ARGUMENT, "decryption failed");
+  }
+  return std::string(padded.begin(), padded.begin() + index - 1);
+}
+
+}  // namespace webpush
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,72 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_WEBPUSH_WEBPUSH_HYBRID_DECRYPT_H_
+#define TINK_WEBPUSH_WEBPUSH_HYBRID_DECRYPT_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "openssl/bn.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "tink/webpush/webpush_util.h"
+
+namespace crypto {
+namespace tink {
+namespace webpush {
+
+// HybridDecrypt for Web Push messages (RFC 8291), as a user agent decrypts
+// them, which is compatible with WebPushHybridDecrypt of Java.  The context
+// info must be empty.
+class WebPushHybridDecrypt : public HybridDecrypt {
+ public:
+  // Returns a WebPushHybridDecrypt for the subscription with the NIST P-256
+  // key pair 'recipient_private_key', a big-endian integer, and
+  // 'recipient_public_key', an uncompressed point, and 'auth_secret'.  Only
+  // messages with 'record_size' in their header are accepted.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HybridDecrypt>> New(
+      const util::SecretData& recipient_private_key,
+      absl::string_view recipient_public_key,
+      const util::SecretData& auth_secret,
+      int record_size = kMaxCiphertextSize);
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view context_info) const override;
+
+ private:
+  WebPushHybridDecrypt(bssl::UniquePtr<BIGNUM> recipient_private_key,
+                       absl::string_view recipient_public_key,
+                       const util::SecretData& auth_secret, int record_size)
+      : recipient_private_key_(std::move(recipient_private_key)),
+        recipient_public_key_(recipient_public_key),
+        auth_secret_(auth_secret),
+        record_size_(record_size) {}
+
+  const bssl::UniquePtr<BIGNUM> recipient_private_key_;
+  const std::string recipient_public_key_;
+  const util::SecretData auth_secret_;
+  const int record_size_;
+};
+
+}  // namespace webpush
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_WEBPUSH_WEBPUSH_HYBRID_DECRYPT_H_
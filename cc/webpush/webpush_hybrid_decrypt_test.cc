@@ -0,0 +1,139 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/webpush/webpush_hybrid_decrypt.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/webpush/webpush_util.h"
+
+namespace crypto {
+namespace tink {
+namespace webpush {
+namespace {
+
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Not;
+
+// The example of Section 5 of RFC 8291.
+constexpr char kPlaintext[] =
+    "V2hlbiBJIGdyb3cgdXAsIEkgd2FudCB0byBiZSBhIHdhdGVybWVsb24";
+constexpr char kRecipientPrivateKey[] =
+    "q1dXpw3UpT5VOmu_cf_v6ih07Aems3njxI-JWgLcM94";
+constexpr char kRecipientPublicKey[] =
+    "BCVxsr7N_eNgVRqvHtD0zTZsEc6-VV-JvLexhqUzORcxaOzi6-AYWXvTBHm4bjyPjs7Vd8pZ"
+    "GH6SRpkNtoIAiw4";
+constexpr char kAuthSecret[] = "BTBZMqHH6r4Tts7J_aSIgg";
+constexpr char kCiphertext[] =
+    "DGv6ra1nlYgDCS1FRnbzlwAAEABBBP4z9KsN6nGRTbVYI_c7VJSPQTBtkgcy27ml"
+    "mlMoZIIgDll6e3vCYLocInmYWAmS6TlzAC8wEqKK6PBru3jl7A_yl95bQpu6cVPT"
+    "pK4Mqgkf1CXztLVBSt2Ks3oZwbuwXPXLWyouBWLVWGNWQexSgSxsj_Qulcy4a-fN";
+
+std::string Decode(absl::string_view encoded) {
+  std::string decoded;
+  EXPECT_TRUE(absl::WebSafeBase64Unescape(encoded, &decoded));
+  return decoded;
+}
+
+util::SecretData DecodeSecret(absl::string_view encoded) {
+  return util::SecretDataFromStringView(Decode(encoded));
+}
+
+std::unique_ptr<HybridDecrypt> NewRfcDecrypt() {
+  auto decrypt_result = WebPushHybridDecrypt::New(
+      DecodeSecret(kRecipientPrivateKey), Decode(kRecipientPublicKey),
+      DecodeSecret(kAuthSecret));
+  EXPECT_THAT(decrypt_result.status(), IsOk());
+  return std::move(decrypt_result.ValueOrDie());
+}
+
+TEST(WebPushHybridDecryptTest, Rfc8291Example) {
+  std::unique_ptr<HybridDecrypt> decrypt = NewRfcDecrypt();
+  auto plaintext_result = decrypt->Decrypt(Decode(kCiphertext), "");
+  ASSERT_THAT(plaintext_result.status(), IsOk());
+  EXPECT_EQ(plaintext_result.ValueOrDie(), Decode(kPlaintext));
+}
+
+TEST(WebPushHybridDecryptTest, ModifiedCiphertext) {
+  std::unique_ptr<HybridDecrypt> decrypt = NewRfcDecrypt();
+  std::string ciphertext = Decode(kCiphertext);
+  for (int i = 0; i < ciphertext.size(); i++) {
+    std::string modified = ciphertext;
+    modified[i] ^= 1;
+    EXPECT_THAT(decrypt->Decrypt(modified, "").status(), Not(IsOk()))
+        << "byte " << i;
+  }
+  for (int size = 0; size < ciphertext.size(); size++) {
+    EXPECT_THAT(decrypt->Decrypt(ciphertext.substr(0, size), "").status(),
+                Not(IsOk()))
+        << "size " << size;
+  }
+  EXPECT_THAT(decrypt->Decrypt(absl::StrCat(ciphertext, "x"), "").status(),
+              Not(IsOk()));
+}
+
+TEST(WebPushHybridDecryptTest, NonEmptyContextInfo) {
+  std::unique_ptr<HybridDecrypt> decrypt = NewRfcDecrypt();
+  EXPECT_THAT(decrypt->Decrypt(Decode(kCiphertext), "context").status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(WebPushHybridDecryptTest, OtherRecordSize) {
+  auto decrypt_result = WebPushHybridDecrypt::New(
+      DecodeSecret(kRecipientPrivateKey), Decode(kRecipientPublicKey),
+      DecodeSecret(kAuthSecret), 1024);
+  ASSERT_THAT(decrypt_result.status(), IsOk());
+  EXPECT_THAT(
+      decrypt_result.ValueOrDie()->Decrypt(Decode(kCiphertext), "").status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST(WebPushHybridDecryptTest, InvalidParameters) {
+  util::SecretData private_key = DecodeSecret(kRecipientPrivateKey);
+  std::string public_key = Decode(kRecipientPublicKey);
+  util::SecretData auth_secret = DecodeSecret(kAuthSecret);
+  EXPECT_THAT(WebPushHybridDecrypt::New(private_key, public_key,
+                                        util::SecretData(15))
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(WebPushHybridDecrypt::New(private_key, public_key.substr(1),
+                                        auth_secret)
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(WebPushHybridDecrypt::New(private_key, public_key, auth_secret,
+                                        kCiphertextOverhead - 1)
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(WebPushHybridDecrypt::New(private_key, public_key, auth_secret,
+                                        kMaxCiphertextSize + 1)
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace webpush
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,163 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/webpush/webpush_hybrid_encrypt.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "openssl/ec.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/ecies_ephemeral_key_pool.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/webpush/webpush_util.h"
+
+namespace crypto {
+namespace tink {
+namespace webpush {
+
+using crypto::tink::subtle::EciesEphemeralKey;
+using crypto::tink::subtle::EciesEphemeralKeyPool;
+using crypto::tink::subtle::EcPointFormat;
+using crypto::tink::subtle::EllipticCurveType;
+using crypto::tink::subtle::Random;
+using crypto::tink::subtle::SubtleUtilBoringSSL;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+// static
+StatusOr<std::unique_ptr<HybridEncrypt>> WebPushHybridEncrypt::New(
+    absl::string_view recipient_public_key,
+    const util::SecretData& auth_secret) {
+  return New(recipient_public_key, auth_secret, WebPushParams(), nullptr);
+}
+
+// static
+StatusOr<std::unique_ptr<HybridEncrypt>> WebPushHybridEncrypt::New(
+    absl::string_view recipient_public_key,
+    const util::SecretData& auth_secret, const WebPushParams& params,
+    std::shared_ptr<EciesEphemeralKeyPool> key_pool) {
+  if (auth_secret.size() != kAuthSecretSize) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("auth secret must have ", kAuthSecretSize,
+                               " bytes"));
+  }
+  if (params.record_size < kCiphertextOverhead ||
+      params.record_size > kMaxCiphertextSize) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("invalid record size (", params.record_size,
+                               "); must be a number between [",
+                               kCiphertextOverhead, ", ", kMaxCiphertextSize,
+                               "]"));
+  }
+  if (params.padding_size < 0 ||
+      params.padding_size > params.record_size - kCiphertextOverhead) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("invalid padding size (", params.padding_size,
+                               "); must be a number between [0, ",
+                               params.record_size - kCiphertextOverhead, "]"));
+  }
+  if (key_pool != nullptr &&
+      key_pool->curve() != EllipticCurveType::NIST_P256) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "key_pool must be for NIST_P256");
+  }
+  if (recipient_public_key.size() != kPublicKeySize) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "recipient public key must be an uncompressed P-256 point");
+  }
+  auto point_result = SubtleUtilBoringSSL::EcPointDecode(
+      EllipticCurveType::NIST_P256, EcPointFormat::UNCOMPRESSED,
+      recipient_public_key);
+  if (!point_result.ok()) return point_result.status();
+  return {absl::WrapUnique(new WebPushHybridEncrypt(
+      recipient_public_key, std::move(point_result.ValueOrDie()), auth_secret,
+      params, std::move(key_pool)))};
+}
+
+StatusOr<std::string> WebPushHybridEncrypt::Encrypt(
+    absl::string_view plaintext, absl::string_view context_info) const {
+  if (!context_info.empty()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "context_info must be empty because it is unused");
+  }
+  int max_plaintext_size =
+      params_.record_size - params_.padding_size - kCiphertextOverhead;
+  if (plaintext.size() > max_plaintext_size) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  absl::StrCat("plaintext too long; with record size = ",
+                               params_.record_size, " and padding size = ",
+                               params_.padding_size,
+                               ", plaintext cannot be longer than ",
+                               max_plaintext_size));
+  }
+
+  StatusOr<std::unique_ptr<EciesEphemeralKey>> ephemeral_key_result =
+      key_pool_ != nullptr
+          ? key_pool_->Take()
+          : EciesEphemeralKeyPool::GenerateKey(EllipticCurveType::NIST_P256);
+  if (!ephemeral_key_result.ok()) return ephemeral_key_result.status();
+  const EC_KEY* ephemeral_key = ephemeral_key_result.ValueOrDie()->ec_key.get();
+  auto ecdh_secret_result = SubtleUtilBoringSSL::ComputeEcdhSharedSecret(
+      EllipticCurveType::NIST_P256, EC_KEY_get0_private_key(ephemeral_key),
+      recipient_public_point_.get());
+  if (!ecdh_secret_result.ok()) return ecdh_secret_result.status();
+  auto as_public_key_result = SubtleUtilBoringSSL::EcPointEncode(
+      EllipticCurveType::NIST_P256, EcPointFormat::UNCOMPRESSED,
+      EC_KEY_get0_public_key(ephemeral_key));
+  if (!as_public_key_result.ok()) return as_public_key_result.status();
+  const std::string& as_public_key = as_public_key_result.ValueOrDie();
+
+  std::string salt = Random::GetRandomBytes(kSaltSize);
+  auto keys_result =
+      DeriveMessageKeys(ecdh_secret_result.ValueOrDie(), auth_secret_,
+                        recipient_public_key_, as_public_key, salt);
+  if (!keys_result.ok()) return keys_result.status();
+
+  // The plaintext is followed by the delimiter of the last record and the
+  // zero padding.
+  util::SecretData padded_plaintext(plaintext.size() + 1 +
+                                    params_.padding_size);
+  std::copy(plaintext.begin(), plaintext.end(), padded_plaintext.begin());
+  padded_plaintext[plaintext.size()] = kPaddingDelimiter;
+  auto record_result =
+      SealRecord(keys_result.ValueOrDie(),
+                 util::SecretDataAsStringView(padded_plaintext));
+  if (!record_result.ok()) return record_result.status();
+
+  const uint32_t record_size = params_.record_size;
+  const char header[] = {static_cast<char>(record_size >> 24),
+                         static_cast<char>(record_size >> 16),
+                         static_cast<char>(record_size >> 8),
+                         static_cast<char>(record_size),
+                         static_cast<char>(kPublicKeySize)};
+  return absl::StrCat(salt, absl::string_view(header, sizeof(header)),
+                      as_public_key, record_result.ValueOrDie());
+}
+
+}  // namespace webpush
+}  // namespace tink
+}  // namespace crypto
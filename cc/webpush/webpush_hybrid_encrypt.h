@@ -0,0 +1,94 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_WEBPUSH_WEBPUSH_HYBRID_ENCRYPT_H_
+#define TINK_WEBPUSH_WEBPUSH_HYBRID_ENCRYPT_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "openssl/ec.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/subtle/ecies_ephemeral_key_pool.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+#include "tink/webpush/webpush_util.h"
+
+namespace crypto {
+namespace tink {
+namespace webpush {
+
+struct WebPushParams {
+  // The record size written into the messages, between kCiphertextOverhead
+  // and kMaxCiphertextSize.
+  int record_size = kMaxCiphertextSize;
+  // The number of zero bytes added to every plaintext.
+  int padding_size = 0;
+};
+
+// HybridEncrypt for Web Push messages (RFC 8291) to one subscription, which
+// is compatible with WebPushHybridEncrypt of Java.  The context info must be
+// empty.
+//
+// The public key of the subscriber is decoded once, when the object is
+// created, so that a sender should keep the object of a subscription, e.g.
+// in a WebPushEncrypterCache.
+class WebPushHybridEncrypt : public HybridEncrypt {
+ public:
+  // Returns a WebPushHybridEncrypt for the subscription with the user agent
+  // public key 'recipient_public_key', an uncompressed NIST P-256 point, and
+  // 'auth_secret'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HybridEncrypt>> New(
+      absl::string_view recipient_public_key,
+      const util::SecretData& auth_secret);
+
+  // As above, with 'params', and with the ephemeral key pairs from
+  // 'key_pool', which must be for NIST_P256, if it is not null.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HybridEncrypt>> New(
+      absl::string_view recipient_public_key,
+      const util::SecretData& auth_secret, const WebPushParams& params,
+      std::shared_ptr<subtle::EciesEphemeralKeyPool> key_pool);
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view context_info) const override;
+
+ private:
+  WebPushHybridEncrypt(absl::string_view recipient_public_key,
+                       bssl::UniquePtr<EC_POINT> recipient_public_point,
+                       const util::SecretData& auth_secret,
+                       const WebPushParams& params,
+                       std::shared_ptr<subtle::EciesEphemeralKeyPool> key_pool)
+      : recipient_public_key_(recipient_public_key),
+        recipient_public_point_(std::move(recipient_public_point)),
+        auth_secret_(auth_secret),
+        params_(params),
+        key_pool_(std::move(key_pool)) {}
+
+  const std::string recipient_public_key_;
+  const bssl::UniquePtr<EC_POINT> recipient_public_point_;
+  const util::SecretData auth_secret_;
+  const WebPushParams params_;
+  // May be null.
+  const std::shared_ptr<subtle::EciesEphemeralKeyPool> key_pool_;
+};
+
+}  // namespace webpush
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_WEBPUSH_WEBPUSH_HYBRID_ENCRYPT_H_
@@ -0,0 +1,217 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/webpush/webpush_hybrid_encrypt.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/ecies_ephemeral_key_pool.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_matchers.h"
+#include "tink/webpush/webpush_hybrid_decrypt.h"
+#include "tink/webpush/webpush_util.h"
+
+namespace crypto {
+namespace tink {
+namespace webpush {
+namespace {
+
+using ::crypto::tink::subtle::EciesEphemeralKeyPool;
+using ::crypto::tink::subtle::EllipticCurveType;
+using ::crypto::tink::subtle::Random;
+using ::crypto::tink::subtle::SubtleUtilBoringSSL;
+using ::crypto::tink::test::IsOk;
+using ::crypto::tink::test::StatusIs;
+using ::testing::Not;
+
+class WebPushHybridEncryptTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto key_result = SubtleUtilBoringSSL::GetNewEcKey(
+        EllipticCurveType::NIST_P256);
+    ASSERT_THAT(key_result.status(), IsOk());
+    private_key_ = key_result.ValueOrDie().priv;
+    public_key_ = absl::StrCat("\x04", key_result.ValueOrDie().pub_x,
+                               key_result.ValueOrDie().pub_y);
+    auth_secret_ = util::SecretDataFromStringView(
+        Random::GetRandomBytes(kAuthSecretSize));
+  }
+
+  std::unique_ptr<HybridDecrypt> NewDecrypt(int record_size) {
+    auto decrypt_result = WebPushHybridDecrypt::New(
+        private_key_, public_key_, auth_secret_, record_size);
+    EXPECT_THAT(decrypt_result.status(), IsOk());
+    return std::move(decrypt_result.ValueOrDie());
+  }
+
+  util::SecretData private_key_;
+  std::string public_key_;
+  util::SecretData auth_secret_;
+};
+
+TEST_F(WebPushHybridEncryptTest, EncryptDecrypt) {
+  auto encrypt_result = WebPushHybridEncrypt::New(public_key_, auth_secret_);
+  ASSERT_THAT(encrypt_result.status(), IsOk());
+  std::unique_ptr<HybridDecrypt> decrypt = NewDecrypt(kMaxCiphertextSize);
+  for (int size : {0, 1, 100, kMaxCiphertextSize - kCiphertextOverhead}) {
+    std::string plaintext(size, 'p');
+    auto ciphertext_result =
+        encrypt_result.ValueOrDie()->Encrypt(plaintext, "");
+    ASSERT_THAT(ciphertext_result.status(), IsOk());
+    EXPECT_EQ(ciphertext_result.ValueOrDie().size(),
+              kCiphertextOverhead + size);
+    auto plaintext_result =
+        decrypt->Decrypt(ciphertext_result.ValueOrDie(), "");
+    ASSERT_THAT(plaintext_result.status(), IsOk());
+    EXPECT_EQ(plaintext_result.ValueOrDie(), plaintext);
+  }
+}
+
+TEST_F(WebPushHybridEncryptTest, RecordSizeAndPadding) {
+  WebPushParams params;
+  params.record_size = 1024;
+  params.padding_size = 100;
+  auto encrypt_result =
+      WebPushHybridEncrypt::New(public_key_, auth_secret_, params, nullptr);
+  ASSERT_THAT(encrypt_result.status(), IsOk());
+  std::string plaintext = "some message";
+  auto ciphertext_result = encrypt_result.ValueOrDie()->Encrypt(plaintext, "");
+  ASSERT_THAT(ciphertext_result.status(), IsOk());
+  const std::string& ciphertext = ciphertext_result.ValueOrDie();
+  EXPECT_EQ(ciphertext.size(),
+            kCiphertextOverhead + plaintext.size() + params.padding_size);
+  EXPECT_EQ(ciphertext.substr(kSaltSize, kRecordSizeLength),
+            std::string("\x00\x00\x04\x00", 4));
+
+  auto plaintext_result = NewDecrypt(1024)->Decrypt(ciphertext, "");
+  ASSERT_THAT(plaintext_result.status(), IsOk());
+  EXPECT_EQ(plaintext_result.ValueOrDie(), plaintext);
+  EXPECT_THAT(NewDecrypt(kMaxCiphertextSize)->Decrypt(ciphertext, "").status(),
+              Not(IsOk()));
+
+  int max_plaintext_size =
+      params.record_size - params.padding_size - kCiphertextOverhead;
+  EXPECT_THAT(encrypt_result.ValueOrDie()
+                  ->Encrypt(std::string(max_plaintext_size, 'p'), "")
+                  .status(),
+              IsOk());
+  EXPECT_THAT(encrypt_result.ValueOrDie()
+                  ->Encrypt(std::string(max_plaintext_size + 1, 'p'), "")
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(WebPushHybridEncryptTest, EphemeralKeysAreFresh) {
+  auto encrypt_result = WebPushHybridEncrypt::New(public_key_, auth_secret_);
+  ASSERT_THAT(encrypt_result.status(), IsOk());
+  auto first = encrypt_result.ValueOrDie()->Encrypt("message", "");
+  auto second = encrypt_result.ValueOrDie()->Encrypt("message", "");
+  ASSERT_THAT(first.status(), IsOk());
+  ASSERT_THAT(second.status(), IsOk());
+  // Neither the salt nor the ephemeral public key may be reused.
+  EXPECT_NE(first.ValueOrDie().substr(0, kSaltSize),
+            second.ValueOrDie().substr(0, kSaltSize));
+  EXPECT_NE(first.ValueOrDie().substr(kSaltSize + kRecordSizeLength + 1,
+                                      kPublicKeySize),
+            second.ValueOrDie().substr(kSaltSize + kRecordSizeLength + 1,
+                                       kPublicKeySize));
+}
+
+TEST_F(WebPushHybridEncryptTest, WithKeyPool) {
+  auto pool_result =
+      EciesEphemeralKeyPool::New(EllipticCurveType::NIST_P256, 4);
+  ASSERT_THAT(pool_result.status(), IsOk());
+  auto encrypt_result = WebPushHybridEncrypt::New(
+      public_key_, auth_secret_, WebPushParams(), pool_result.ValueOrDie());
+  ASSERT_THAT(encrypt_result.status(), IsOk());
+  std::unique_ptr<HybridDecrypt> decrypt = NewDecrypt(kMaxCiphertextSize);
+  for (int i = 0; i < 10; i++) {
+    std::string plaintext = absl::StrCat("message ", i);
+    auto ciphertext_result =
+        encrypt_result.ValueOrDie()->Encrypt(plaintext, "");
+    ASSERT_THAT(ciphertext_result.status(), IsOk());
+    auto plaintext_result =
+        decrypt->Decrypt(ciphertext_result.ValueOrDie(), "");
+    ASSERT_THAT(plaintext_result.status(), IsOk());
+    EXPECT_EQ(plaintext_result.ValueOrDie(), plaintext);
+  }
+
+  auto other_pool_result =
+      EciesEphemeralKeyPool::New(EllipticCurveType::NIST_P384, 1);
+  ASSERT_THAT(other_pool_result.status(), IsOk());
+  EXPECT_THAT(WebPushHybridEncrypt::New(public_key_, auth_secret_,
+                                        WebPushParams(),
+                                        other_pool_result.ValueOrDie())
+                  .status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(WebPushHybridEncryptTest, NonEmptyContextInfo) {
+  auto encrypt_result = WebPushHybridEncrypt::New(public_key_, auth_secret_);
+  ASSERT_THAT(encrypt_result.status(), IsOk());
+  EXPECT_THAT(encrypt_result.ValueOrDie()->Encrypt("message", "info").status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+TEST_F(WebPushHybridEncryptTest, InvalidParameters) {
+  EXPECT_THAT(
+      WebPushHybridEncrypt::New(public_key_, util::SecretData(32)).status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(
+      WebPushHybridEncrypt::New(public_key_.substr(1), auth_secret_).status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+  std::string not_on_curve = public_key_;
+  not_on_curve[kPublicKeySize - 1] ^= 1;
+  EXPECT_THAT(WebPushHybridEncrypt::New(not_on_curve, auth_secret_).status(),
+              Not(IsOk()));
+
+  WebPushParams params;
+  params.record_size = kCiphertextOverhead - 1;
+  EXPECT_THAT(
+      WebPushHybridEncrypt::New(public_key_, auth_secret_, params, nullptr)
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+  params.record_size = kMaxCiphertextSize + 1;
+  EXPECT_THAT(
+      WebPushHybridEncrypt::New(public_key_, auth_secret_, params, nullptr)
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+  params.record_size = 1000;
+  params.padding_size = 1000 - kCiphertextOverhead + 1;
+  EXPECT_THAT(
+      WebPushHybridEncrypt::New(public_key_, auth_secret_, params, nullptr)
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+  params.padding_size = -1;
+  EXPECT_THAT(
+      WebPushHybridEncrypt::New(public_key_, auth_secret_, params, nullptr)
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
+}  // namespace
+}  // namespace webpush
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,136 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/webpush/webpush_util.h"
+
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "openssl/aead.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/hkdf.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace webpush {
+
+namespace {
+
+using crypto::tink::subtle::Hkdf;
+using crypto::tink::subtle::SubtleUtilBoringSSL;
+
+// The HKDF info strings of RFC 8291 and RFC 8188, which include the
+// terminating zero byte.
+constexpr char kIkmInfo[] = "WebPush: info";
+constexpr char kCekInfo[] = "Content-Encoding: aes128gcm";
+constexpr char kNonceInfo[] = "Content-Encoding: nonce";
+
+util::StatusOr<bssl::UniquePtr<EVP_AEAD_CTX>> NewAeadContext(
+    const WebPushMessageKeys& keys) {
+  if (keys.cek.size() != kCekSize || keys.nonce.size() != kNonceSize) {
+    return util::Status(util::error::INTERNAL, "Invalid message keys");
+  }
+  bssl::UniquePtr<EVP_AEAD_CTX> ctx(
+      EVP_AEAD_CTX_new(SubtleUtilBoringSSL::GetAesGcmAeadForKeySize(kCekSize),
+                       keys.cek.data(), keys.cek.size(), kTagSize));
+  if (ctx == nullptr) {
+    return util::Status(util::error::INTERNAL,
+                        "could not initialize EVP_AEAD_CTX");
+  }
+  return std::move(ctx);
+}
+
+}  // namespace
+
+util::StatusOr<WebPushMessageKeys> DeriveMessageKeys(
+    const util::SecretData& ecdh_secret, const util::SecretData& auth_secret,
+    absl::string_view ua_public_key, absl::string_view as_public_key,
+    absl::string_view salt) {
+  std::string ikm_info =
+      absl::StrCat(absl::string_view(kIkmInfo, sizeof(kIkmInfo)),
+                   ua_public_key, as_public_key);
+  auto ikm_result = Hkdf::ComputeHkdf(
+      subtle::HashType::SHA256, ecdh_secret,
+      util::SecretDataAsStringView(auth_secret), ikm_info, kIkmSize);
+  if (!ikm_result.ok()) return ikm_result.status();
+  const util::SecretData& ikm = ikm_result.ValueOrDie();
+
+  WebPushMessageKeys keys;
+  auto cek_result =
+      Hkdf::ComputeHkdf(subtle::HashType::SHA256, ikm, salt,
+                        absl::string_view(kCekInfo, sizeof(kCekInfo)),
+                        kCekSize);
+  if (!cek_result.ok()) return cek_result.status();
+  keys.cek = std::move(cek_result.ValueOrDie());
+  auto nonce_result =
+      Hkdf::ComputeHkdf(subtle::HashType::SHA256, ikm, salt,
+                        absl::string_view(kNonceInfo, sizeof(kNonceInfo)),
+                        kNonceSize);
+  if (!nonce_result.ok()) return nonce_result.status();
+  keys.nonce = std::move(nonce_result.ValueOrDie());
+  return std::move(keys);
+}
+
+util::StatusOr<std::string> SealRecord(const WebPushMessageKeys& keys,
+                                       absl::string_view padded_plaintext) {
+  auto ctx_result = NewAeadContext(keys);
+  if (!ctx_result.ok()) return ctx_result.status();
+  padded_plaintext = SubtleUtilBoringSSL::EnsureNonNull(padded_plaintext);
+  std::string ciphertext(padded_plaintext.size() + kTagSize, '\0');
+  size_t out_len;
+  if (!EVP_AEAD_CTX_seal(
+          ctx_result.ValueOrDie().get(),
+          reinterpret_cast<uint8_t*>(&ciphertext[0]), &out_len,
+          ciphertext.size(), keys.nonce.data(), keys.nonce.size(),
+          reinterpret_cast<const uint8_t*>(padded_plaintext.data()),
+          padded_plaintext.size(), /* ad = */ nullptr, /* ad_len = */ 0)) {
+    return util::Status(util::error::INTERNAL,
+                        absl::StrCat("Encryption failed: ",
+                                     SubtleUtilBoringSSL::GetErrors()));
+  }
+  ciphertext.resize(out_len);
+  return ciphertext;
+}
+
+util::StatusOr<util::SecretData> OpenRecord(const WebPushMessageKeys& keys,
+                                            absl::string_view ciphertext) {
+  if (ciphertext.size() < kTagSize) {
+    return util::Status(util::error::INVALID_ARGUMENT, "ciphertext too short");
+  }
+  auto ctx_result = NewAeadContext(keys);
+  if (!ctx_result.ok()) return ctx_result.status();
+  // One more byte, so that the output is not null for an empty record.
+  util::SecretData plaintext(ciphertext.size() - kTagSize + 1);
+  size_t out_len;
+  if (!EVP_AEAD_CTX_open(
+          ctx_result.ValueOrDie().get(), plaintext.data(), &out_len,
+          plaintext.size() - 1, keys.nonce.data(), keys.nonce.size(),
+          reinterpret_cast<const uint8_t*>(ciphertext.data()),
+          ciphertext.size(), /* ad = */ nullptr, /* ad_len = */ 0)) {
+    return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
+  }
+  plaintext.resize(out_len);
+  return std::move(plaintext);
+}
+
+}  // namespace webpush
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,78 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_WEBPUSH_WEBPUSH_UTIL_H_
+#define TINK_WEBPUSH_WEBPUSH_UTIL_H_
+
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/util/secret_data.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace webpush {
+
+// Sizes of the message encryption of Web Push (RFC 8291), which is the
+// "aes128gcm" content coding (RFC 8188) with a single record, keyed by ECDH
+// on NIST P-256.
+constexpr int kAuthSecretSize = 16;
+constexpr int kIkmSize = 32;
+constexpr int kCekSize = 16;
+constexpr int kNonceSize = 12;
+constexpr int kSaltSize = 16;
+constexpr int kRecordSizeLength = 4;
+// An uncompressed NIST P-256 point.
+constexpr int kPublicKeySize = 65;
+constexpr int kContentCodingHeaderSize =
+    kSaltSize + kRecordSizeLength + 1 + kPublicKeySize;
+constexpr int kTagSize = 16;
+constexpr uint8_t kPaddingDelimiter = 2;
+constexpr int kCiphertextOverhead = kContentCodingHeaderSize + 1 + kTagSize;
+constexpr int kMaxCiphertextSize = 4096;
+
+// The keys of one message.
+struct WebPushMessageKeys {
+  util::SecretData cek;
+  util::SecretData nonce;
+};
+
+// Derives the content encryption key and the nonce of a message from the
+// ECDH secret, the subscription's 'auth_secret', the public keys of the
+// user agent and the application server, and the 'salt' of the message
+// (RFC 8291, section 3.4).
+util::StatusOr<WebPushMessageKeys> DeriveMessageKeys(
+    const util::SecretData& ecdh_secret, const util::SecretData& auth_secret,
+    absl::string_view ua_public_key, absl::string_view as_public_key,
+    absl::string_view salt);
+
+// Encrypts 'padded_plaintext' with AES-128-GCM under 'keys', and returns
+// the ciphertext with the tag.
+util::StatusOr<std::string> SealRecord(const WebPushMessageKeys& keys,
+                                       absl::string_view padded_plaintext);
+
+// Decrypts the record 'ciphertext' under 'keys', and returns the padded
+// plaintext.
+util::StatusOr<util::SecretData> OpenRecord(const WebPushMessageKeys& keys,
+                                            absl::string_view ciphertext);
+
+}  // namespace webpush
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_WEBPUSH_WEBPUSH_UTIL_H_
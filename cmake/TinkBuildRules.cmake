@@ -197,6 +197,53 @@ function(tink_cc_test)
   endif()
 endfunction(tink_cc_test)
 
+# Declare a Tink microbenchmark using Google Benchmark.
+#
+# Parameters:
+#   NAME base name of the benchmark.
+#   SRCS list of benchmark source files, headers included.
+#   DEPS list of dependencies, see tink_cc_library above.
+#   NO_MAIN the sources define their own main(), so benchmark_main is not
+#     linked.
+#
+# Benchmarks are only built when TINK_BUILD_BENCHMARKS is set, and are not
+# registered as tests. Each benchmark produces a build target named
+# tink_benchmark_<MODULE>_<NAME>.
+#
+function(tink_cc_benchmark)
+  cmake_parse_arguments(PARSE_ARGV 0 tink_cc_benchmark
+    "NO_MAIN"
+    "NAME"
+    "SRCS;DEPS"
+  )
+
+  if (NOT TINK_BUILD_BENCHMARKS)
+    return()
+  endif()
+
+  if (NOT DEFINED TINK_MODULE)
+    message(FATAL_ERROR "TINK_MODULE not defined")
+  endif()
+
+  STRING(REPLACE "::" "__" _ESCAPED_TINK_MODULE ${TINK_MODULE})
+
+  set(_target_name "tink_benchmark_${_ESCAPED_TINK_MODULE}_${tink_cc_benchmark_NAME}")
+
+  add_executable(${_target_name}
+    ${tink_cc_benchmark_SRCS}
+  )
+
+  if (NOT tink_cc_benchmark_NO_MAIN)
+    target_link_libraries(${_target_name} benchmark_main)
+  endif()
+  target_link_libraries(${_target_name} ${tink_cc_benchmark_DEPS})
+
+  set_property(TARGET ${_target_name}
+               PROPERTY FOLDER "${TINK_IDE_FOLDER}/Benchmarks")
+  set_property(TARGET ${_target_name} PROPERTY CXX_STANDARD ${TINK_CXX_STANDARD})
+  set_property(TARGET ${_target_name} PROPERTY CXX_STANDARD_REQUIRED true)
+endfunction(tink_cc_benchmark)
+
 # Declare a C++ Proto library.
 #
 # Parameters:
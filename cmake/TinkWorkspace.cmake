@@ -42,6 +42,17 @@ http_archive(
   SHA256 a7db7d1295ce46b93f3d1a90dbbc55a48409c00d19684fcd87823037add88118
 )
 
+if (TINK_BUILD_BENCHMARKS)
+  set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "Tink dependency override" FORCE)
+  set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "Tink dependency override" FORCE)
+
+  http_archive(
+    NAME com_github_google_benchmark
+    URL https://github.com/google/benchmark/archive/v1.5.2.tar.gz
+    SHA256 dccbdab796baa1043f04982147e67bb6e118fe610da2c65f88912d73987e700c
+  )
+endif()
+
 http_archive(
   NAME com_google_absl
   URL https://github.com/abseil/abseil-cpp/archive/64461421222f8be8663c50e8e82c91c3f95a0d3c.zip
@@ -92,3 +103,9 @@ http_archive(
   SHA256 bf0e5070b4b99240183b29df78155eee335885e53a8af8683964579c214ad301
   CMAKE_SUBDIR cmake
 )
+
+# zlib is used by the compressing and decompressing streams in util/, which
+# are only built with TINK_USE_ZLIB. It is taken from the system.
+if (TINK_USE_ZLIB)
+  find_package(ZLIB REQUIRED)
+endif()
@@ -14,6 +14,8 @@
 
 #include "pqcrypto/cc/subtle/cecpq2_hkdf_sender_kem_boringssl.h"
 
+#include <utility>
+
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "openssl/bn.h"
@@ -28,6 +30,17 @@ namespace crypto {
 namespace tink {
 namespace subtle {
 
+namespace {
+
+// Returns an ephemeral key pair from 'key_pool', or a new one if it is null.
+util::StatusOr<std::unique_ptr<EciesEphemeralKey>> GetEphemeralKey(
+    EciesEphemeralKeyPool* key_pool) {
+  if (key_pool != nullptr) return key_pool->Take();
+  return EciesEphemeralKeyPool::GenerateKey(CURVE25519);
+}
+
+}  // namespace
+
 // This method only redirects the object creation to the appropriate class
 // based on the chosen curve. As of now, the only curve supported is
 // Curve25519. This method was designed to be generic enough to faciliate the
@@ -38,23 +51,55 @@ Cecpq2HkdfSenderKemBoringSsl::New(subtle::EllipticCurveType curve,
                                   const absl::string_view ec_pubx,
                                   const absl::string_view ec_puby,
                                   const absl::string_view marshalled_hrss_pub) {
+  return New(curve, ec_pubx, ec_puby, marshalled_hrss_pub, nullptr);
+}
+
+// static
+util::StatusOr<std::unique_ptr<const Cecpq2HkdfSenderKemBoringSsl>>
+Cecpq2HkdfSenderKemBoringSsl::New(
+    subtle::EllipticCurveType curve, const absl::string_view ec_pubx,
+    const absl::string_view ec_puby,
+    const absl::string_view marshalled_hrss_pub,
+    std::shared_ptr<EciesEphemeralKeyPool> key_pool) {
   switch (curve) {
     case EllipticCurveType::CURVE25519:
-      return Cecpq2HkdfX25519SenderKemBoringSsl::New(curve, ec_pubx, ec_puby,
-                                                     marshalled_hrss_pub);
+      return Cecpq2HkdfX25519SenderKemBoringSsl::New(
+          curve, ec_pubx, ec_puby, marshalled_hrss_pub, std::move(key_pool));
     default:
       return util::Status(util::error::UNIMPLEMENTED,
                           "Unsupported elliptic curve");
   }
 }
 
+util::StatusOr<
+    std::vector<std::unique_ptr<const Cecpq2HkdfSenderKemBoringSsl::KemKey>>>
+Cecpq2HkdfSenderKemBoringSsl::GenerateKeys(
+    int count, subtle::HashType hash, absl::string_view hkdf_salt,
+    absl::string_view hkdf_info, uint32_t key_size_in_bytes,
+    subtle::EcPointFormat point_format) const {
+  if (count < 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "count must be non-negative");
+  }
+  std::vector<std::unique_ptr<const KemKey>> keys;
+  keys.reserve(count);
+  for (int i = 0; i < count; i++) {
+    auto kem_key_or = GenerateKey(hash, hkdf_salt, hkdf_info,
+                                  key_size_in_bytes, point_format);
+    if (!kem_key_or.ok()) return kem_key_or.status();
+    keys.push_back(std::move(kem_key_or.ValueOrDie()));
+  }
+  return std::move(keys);
+}
+
 Cecpq2HkdfX25519SenderKemBoringSsl::Cecpq2HkdfX25519SenderKemBoringSsl(
     const absl::string_view peer_ec_pubx,
-    const absl::string_view marshalled_hrss_pub) {
-  peer_public_key_x25519_ =
-      reinterpret_cast<const uint8_t*>(peer_ec_pubx.data());
-  peer_marshalled_public_key_hrss_ =
-      reinterpret_cast<const uint8_t*>(marshalled_hrss_pub.data());
+    util::SecretUniquePtr<HRSS_public_key> peer_public_key_hrss,
+    std::shared_ptr<EciesEphemeralKeyPool> key_pool)
+    : peer_public_key_hrss_(std::move(peer_public_key_hrss)),
+      key_pool_(std::move(key_pool)) {
+  peer_ec_pubx.copy(reinterpret_cast<char*>(peer_public_key_x25519_),
+                    X25519_PUBLIC_VALUE_LEN);
 }
 
 // static
@@ -62,6 +107,15 @@ util::StatusOr<std::unique_ptr<const Cecpq2HkdfSenderKemBoringSsl>>
 Cecpq2HkdfX25519SenderKemBoringSsl::New(
     subtle::EllipticCurveType curve, const absl::string_view pubx,
     const absl::string_view puby, const absl::string_view marshalled_hrss_pub) {
+  return New(curve, pubx, puby, marshalled_hrss_pub, nullptr);
+}
+
+// static
+util::StatusOr<std::unique_ptr<const Cecpq2HkdfSenderKemBoringSsl>>
+Cecpq2HkdfX25519SenderKemBoringSsl::New(
+    subtle::EllipticCurveType curve, const absl::string_view pubx,
+    const absl::string_view puby, const absl::string_view marshalled_hrss_pub,
+    std::shared_ptr<EciesEphemeralKeyPool> key_pool) {
   auto status = CheckFipsCompatibility<Cecpq2HkdfX25519SenderKemBoringSsl>();
   if (!status.ok()) return status;
 
@@ -81,10 +135,25 @@ Cecpq2HkdfX25519SenderKemBoringSsl::New(
     return util::Status(util::error::INVALID_ARGUMENT,
                         "marshalled_hrss_pub has unexpected length");
   }
+  if (key_pool != nullptr && key_pool->curve() != curve) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "key_pool is for a different curve");
+  }
+
+  // Recover the internal HRSS public key representation from the marshalled
+  // version, once for all encapsulations
+  auto peer_public_key_hrss = util::MakeSecretUniquePtr<HRSS_public_key>();
+  if (!HRSS_parse_public_key(
+          peer_public_key_hrss.get(),
+          reinterpret_cast<const uint8_t*>(marshalled_hrss_pub.data()))) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "marshalled_hrss_pub is not a valid HRSS public key");
+  }
 
   // If input parameters are ok, create a CECPQ2 Sender KEM instance
   std::unique_ptr<const Cecpq2HkdfSenderKemBoringSsl> sender_kem(
-      new Cecpq2HkdfX25519SenderKemBoringSsl(pubx, marshalled_hrss_pub));
+      new Cecpq2HkdfX25519SenderKemBoringSsl(
+          pubx, std::move(peer_public_key_hrss), std::move(key_pool)));
   return std::move(sender_kem);
 }
 
@@ -100,18 +169,67 @@ Cecpq2HkdfX25519SenderKemBoringSsl::GenerateKey(
         "X25519 only supports compressed elliptic curve points");
   }
 
-  // Generate the ephemeral X25519 key pair. Note that the
-  // X25519_kem_bytes holds the X25519 public key
-  util::SecretData ephemeral_x25519_private_key(X25519_PRIVATE_KEY_LEN);
-  std::string x25519_kem_bytes(X25519_PUBLIC_VALUE_LEN, '\0');
-  X25519_keypair(const_cast<uint8_t*>(
-                 reinterpret_cast<const uint8_t*>(x25519_kem_bytes.data())),
-                 ephemeral_x25519_private_key.data());
+  // Get the ephemeral X25519 key pair
+  auto ephemeral_key_or = GetEphemeralKey(key_pool_.get());
+  if (!ephemeral_key_or.ok()) return ephemeral_key_or.status();
+
+  // Generate entropy to be used in encaps
+  util::SecretData encaps_entropy =
+      crypto::tink::subtle::Random::GetRandomKeyBytes(HRSS_ENCAP_BYTES);
+
+  return DeriveKey(*ephemeral_key_or.ValueOrDie(), encaps_entropy.data(), hash,
+                   hkdf_salt, hkdf_info, key_size_in_bytes);
+}
+
+util::StatusOr<
+    std::vector<std::unique_ptr<const Cecpq2HkdfSenderKemBoringSsl::KemKey>>>
+Cecpq2HkdfX25519SenderKemBoringSsl::GenerateKeys(
+    int count, subtle::HashType hash, absl::string_view hkdf_salt,
+    absl::string_view hkdf_info, uint32_t key_size_in_bytes,
+    subtle::EcPointFormat point_format) const {
+  // Basic input validation:
+  if (count < 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "count must be non-negative");
+  }
+  if (point_format != EcPointFormat::COMPRESSED) {
+    return util::Status(
+        util::error::INVALID_ARGUMENT,
+        "X25519 only supports compressed elliptic curve points");
+  }
+
+  // Generate the entropy for all encaps with a single call
+  util::SecretData encaps_entropy =
+      crypto::tink::subtle::Random::GetRandomKeyBytes(count *
+                                                      HRSS_ENCAP_BYTES);
+
+  std::vector<std::unique_ptr<const KemKey>> keys;
+  keys.reserve(count);
+  for (int i = 0; i < count; i++) {
+    auto ephemeral_key_or = GetEphemeralKey(key_pool_.get());
+    if (!ephemeral_key_or.ok()) return ephemeral_key_or.status();
+    auto kem_key_or = DeriveKey(
+        *ephemeral_key_or.ValueOrDie(),
+        encaps_entropy.data() + i * HRSS_ENCAP_BYTES, hash, hkdf_salt,
+        hkdf_info, key_size_in_bytes);
+    if (!kem_key_or.ok()) return kem_key_or.status();
+    keys.push_back(std::move(kem_key_or.ValueOrDie()));
+  }
+  return std::move(keys);
+}
+
+util::StatusOr<std::unique_ptr<const Cecpq2HkdfSenderKemBoringSsl::KemKey>>
+Cecpq2HkdfX25519SenderKemBoringSsl::DeriveKey(
+    const EciesEphemeralKey& ephemeral_key, const uint8_t* encaps_entropy,
+    subtle::HashType hash, absl::string_view hkdf_salt,
+    absl::string_view hkdf_info, uint32_t key_size_in_bytes) const {
+  // The X25519_kem_bytes holds the ephemeral X25519 public key
+  const std::string& x25519_kem_bytes = ephemeral_key.x25519_public_value;
 
   // Generate the x25519 shared secret using peer's X25519 public key and
-  // locally generated ephemeral X25519 private key
+  // the ephemeral X25519 private key
   util::SecretData x25519_shared_secret(X25519_SHARED_KEY_LEN);
-  X25519(x25519_shared_secret.data(), ephemeral_x25519_private_key.data(),
+  X25519(x25519_shared_secret.data(), ephemeral_key.x25519_private_key.data(),
          peer_public_key_x25519_);
 
   // Declare the hrss_shared_secret and hrss_kem_bytes to be used in HRSS encaps
@@ -121,25 +239,14 @@ Cecpq2HkdfX25519SenderKemBoringSsl::GenerateKey(
   std::string hrss_kem_bytes;
   subtle::ResizeStringUninitialized(&hrss_kem_bytes, HRSS_CIPHERTEXT_BYTES);
 
-  // Recover the internal HRSS public key representation from marshalled version
-  struct HRSS_public_key peer_public_key_hrss;
-  HRSS_parse_public_key(&peer_public_key_hrss,
-                        peer_marshalled_public_key_hrss_);
-
-  // Generate entropy to be used in encaps
-  util::SecretData encaps_entropy =
-      crypto::tink::subtle::Random::GetRandomKeyBytes(HRSS_ENCAP_BYTES);
-
   // Generate a random shared secret and encapsulate it using peer's HRSS public
   // key
-  HRSS_encap(const_cast<uint8_t*>(
-             reinterpret_cast<const uint8_t*>(hrss_kem_bytes.data())),
+  HRSS_encap(reinterpret_cast<uint8_t*>(&hrss_kem_bytes[0]),
              reinterpret_cast<uint8_t*>(hrss_shared_secret.data()),
-             &peer_public_key_hrss, encaps_entropy.data());
+             peer_public_key_hrss_.get(), encaps_entropy);
 
   // Concatenate the two kem_bytes
-  std::string kem_bytes(x25519_kem_bytes);
-  kem_bytes += hrss_kem_bytes;
+  std::string kem_bytes = absl::StrCat(x25519_kem_bytes, hrss_kem_bytes);
 
   // Concatenate the two shared secrets with the two kem_bytes
   std::string kem_bytes_and_shared_secrets = absl::StrCat(
@@ -158,7 +265,8 @@ Cecpq2HkdfX25519SenderKemBoringSsl::GenerateKey(
   util::SecretData symmetric_key = symmetric_key_or.ValueOrDie();
 
   // Return the produced pair kem_bytes and symmetric_key
-  return absl::make_unique<const KemKey>(kem_bytes, symmetric_key);
+  return absl::make_unique<const KemKey>(std::move(kem_bytes),
+                                         std::move(symmetric_key));
 }
 
 }  // namespace subtle
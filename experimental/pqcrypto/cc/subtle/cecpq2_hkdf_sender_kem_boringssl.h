@@ -15,12 +15,16 @@
 #ifndef THIRD_PARTY_TINK_EXPERIMENTAL_PQCRYPTO_CC_SUBTLE_CECPQ2_HKDF_SENDER_KEM_BORINGSSL_H_
 #define THIRD_PARTY_TINK_EXPERIMENTAL_PQCRYPTO_CC_SUBTLE_CECPQ2_HKDF_SENDER_KEM_BORINGSSL_H_
 
+#include <memory>
+#include <vector>
+
 #include "absl/strings/string_view.h"
 #include "openssl/curve25519.h"
 #include "openssl/ec.h"
 #include "openssl/hrss.h"
 #include "tink/config/tink_fips.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/ecies_ephemeral_key_pool.h"
 #include "tink/util/secret_data.h"
 #include "tink/util/statusor.h"
 
@@ -87,6 +91,15 @@ class Cecpq2HkdfSenderKemBoringSsl {
       const absl::string_view ec_puby,
       const absl::string_view marshalled_hrss_pub);
 
+  // As above, but the KEM takes its ephemeral ECC key pairs from 'key_pool',
+  // which must be for 'curve'. A null 'key_pool' is the same as none.
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<const Cecpq2HkdfSenderKemBoringSsl>>
+  New(EllipticCurveType curve, const absl::string_view ec_pubx,
+      const absl::string_view ec_puby,
+      const absl::string_view marshalled_hrss_pub,
+      std::shared_ptr<EciesEphemeralKeyPool> key_pool);
+
   // Generates ephemeral key pairs, computes ECC's shared secret based on
   // generated ephemeral key and recipient's public key, generate a random
   // shared secret and encapsulates it using recipient's HRSS public key.
@@ -98,6 +111,15 @@ class Cecpq2HkdfSenderKemBoringSsl {
               absl::string_view hkdf_info, uint32_t key_size_in_bytes,
               EcPointFormat point_format) const = 0;
 
+  // Same as calling GenerateKey() 'count' times with the same arguments, but
+  // implementations may share work between the keys. Either all keys are
+  // generated or an error is returned.
+  virtual crypto::tink::util::StatusOr<
+      std::vector<std::unique_ptr<const KemKey>>>
+  GenerateKeys(int count, HashType hash, absl::string_view hkdf_salt,
+               absl::string_view hkdf_info, uint32_t key_size_in_bytes,
+               EcPointFormat point_format) const;
+
   virtual ~Cecpq2HkdfSenderKemBoringSsl() = default;
 };
 
@@ -112,6 +134,15 @@ class Cecpq2HkdfX25519SenderKemBoringSsl : public Cecpq2HkdfSenderKemBoringSsl {
       const absl::string_view puby,
       const absl::string_view marshalled_hrss_pub);
 
+  // As above, with ephemeral X25519 key pairs from 'key_pool' if it is not
+  // null.
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<const Cecpq2HkdfSenderKemBoringSsl>>
+  New(EllipticCurveType curve, const absl::string_view pubx,
+      const absl::string_view puby,
+      const absl::string_view marshalled_hrss_pub,
+      std::shared_ptr<EciesEphemeralKeyPool> key_pool);
+
   // Generates an ephemeral X25519 key pair, computes the X25519's shared secret
   // based on the ephemeral key and recipient's public key, generates a random
   // shared secret and encapsulates it using the recipient's HRSS public key.
@@ -121,30 +152,41 @@ class Cecpq2HkdfX25519SenderKemBoringSsl : public Cecpq2HkdfSenderKemBoringSsl {
       HashType hash, absl::string_view hkdf_salt, absl::string_view hkdf_info,
       uint32_t key_size_in_bytes, EcPointFormat point_format) const override;
 
+  // Draws the randomness for all keys at once, and takes the ephemeral X25519
+  // key pairs from the key pool if there is one.
+  crypto::tink::util::StatusOr<std::vector<std::unique_ptr<const KemKey>>>
+  GenerateKeys(int count, HashType hash, absl::string_view hkdf_salt,
+               absl::string_view hkdf_info, uint32_t key_size_in_bytes,
+               EcPointFormat point_format) const override;
+
   // Flag to indicate CECPQ2 is not FIPS compliant
   static constexpr crypto::tink::FipsCompatibility kFipsStatus =
       crypto::tink::FipsCompatibility::kNotFips;
 
  private:
-  // The private constructor only takes the X25519 and HRSS public keys. The
-  // curve is not provided as a parameter here because the curve validation has
-  // already been made in the New() method defined above.
-  explicit Cecpq2HkdfX25519SenderKemBoringSsl(
+  // The private constructor only takes the X25519 public key and the parsed
+  // HRSS public key. The curve is not provided as a parameter here because the
+  // curve validation has already been made in the New() method defined above.
+  Cecpq2HkdfX25519SenderKemBoringSsl(
       const absl::string_view peer_ec_pubx,
-      const absl::string_view marshalled_hrss_pub);
+      util::SecretUniquePtr<HRSS_public_key> peer_public_key_hrss,
+      std::shared_ptr<EciesEphemeralKeyPool> key_pool);
+
+  // Derives a key from the ephemeral X25519 key pair and HRSS_ENCAP_BYTES of
+  // 'encaps_entropy'.
+  crypto::tink::util::StatusOr<std::unique_ptr<const KemKey>> DeriveKey(
+      const EciesEphemeralKey& ephemeral_key, const uint8_t* encaps_entropy,
+      HashType hash, absl::string_view hkdf_salt, absl::string_view hkdf_info,
+      uint32_t key_size_in_bytes) const;
 
-  // X25519 and HRSS public key containers. We note that the BoringSSL
-  // implementation of HRSS requires that the HRSS public key is stored in the
-  // *marshalled* format. This is done by calling the HRSS_marshal_public_key
-  // function from BoringSSL (see the tests available in cecpq2_hkdf_sender_kem
-  // _boringssl_test.cc file that demonstrate this process). If this process is
-  // not done, the internal raw HRSS public key representation (using the struct
-  // HRSS_public_key data structure) might cause padding problems depending on
-  // the compiler options.
-  // Pointer to array of size X25519_PUBLIC_VALUE_LEN bytes
-  const uint8_t* peer_public_key_x25519_;
-  // Pointer to array of size HRSS_PUBLIC_KEY_BYTES bytes
-  const uint8_t* peer_marshalled_public_key_hrss_;
+  uint8_t peer_public_key_x25519_[X25519_PUBLIC_VALUE_LEN];
+  // The recipient's HRSS public key, parsed once from its *marshalled* format
+  // (see HRSS_marshal_public_key in BoringSSL and the tests in
+  // cecpq2_hkdf_sender_kem_boringssl_test.cc). The parsed form is a large
+  // polynomial structure, which is why it is not recomputed on every
+  // encapsulation.
+  const util::SecretUniquePtr<HRSS_public_key> peer_public_key_hrss_;
+  std::shared_ptr<EciesEphemeralKeyPool> key_pool_;  // may be null
 };
 
 }  // namespace subtle
@@ -20,6 +20,7 @@
 #include "openssl/hrss.h"
 #include "openssl/sha.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/ecies_ephemeral_key_pool.h"
 #include "tink/subtle/hkdf.h"
 #include "tink/subtle/random.h"
 #include "tink/subtle/subtle_util.h"
@@ -235,6 +236,96 @@ TEST(Cecpq2HkdfSenderKemBoringSslTest, TestSenderRecipientFullFlowFailure) {
                 status_or_shared_secret.ValueOrDie())));
 }
 
+// This test evaluates the batched key generation, with ephemeral X25519 keys
+// from a key pool: every generated key must be recovered by the recipient,
+// and the kem_bytes must all differ.
+TEST(Cecpq2HkdfSenderKemBoringSslTest, TestGenerateKeysWithKeyPool) {
+  if (kUseOnlyFips) {
+    GTEST_SKIP() << "Not supported in FIPS-only mode";
+  }
+
+  // Declaring auxiliary parameters
+  std::string salt_hex = "0b0b0b0b";
+  std::string info_hex = "0b0b0b0b0b0b0b0b";
+  int out_len = 32;
+  int count = 5;
+
+  auto statur_or_cecpq2_key =
+      pqc::GenerateCecpq2Keypair(EllipticCurveType::CURVE25519);
+  ASSERT_TRUE(statur_or_cecpq2_key.ok());
+  auto cecpq2_key_pair = std::move(statur_or_cecpq2_key).ValueOrDie();
+
+  // A key pool for another curve is rejected
+  auto status_or_p256_pool =
+      EciesEphemeralKeyPool::New(EllipticCurveType::NIST_P256, 1);
+  ASSERT_TRUE(status_or_p256_pool.ok());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            Cecpq2HkdfSenderKemBoringSsl::New(
+                EllipticCurveType::CURVE25519,
+                cecpq2_key_pair.x25519_key_pair.pub_x,
+                cecpq2_key_pair.x25519_key_pair.pub_y,
+                cecpq2_key_pair.hrss_key_pair.hrss_public_key_marshaled,
+                status_or_p256_pool.ValueOrDie())
+                .status()
+                .error_code());
+
+  // Creating an instance of Cecpq2HkdfSenderKemBoringSsl with a key pool
+  auto status_or_pool =
+      EciesEphemeralKeyPool::New(EllipticCurveType::CURVE25519, 2);
+  ASSERT_TRUE(status_or_pool.ok());
+  auto status_or_sender_kem = Cecpq2HkdfSenderKemBoringSsl::New(
+      EllipticCurveType::CURVE25519, cecpq2_key_pair.x25519_key_pair.pub_x,
+      cecpq2_key_pair.x25519_key_pair.pub_y,
+      cecpq2_key_pair.hrss_key_pair.hrss_public_key_marshaled,
+      status_or_pool.ValueOrDie());
+  ASSERT_TRUE(status_or_sender_kem.ok());
+  auto sender_kem = std::move(status_or_sender_kem.ValueOrDie());
+
+  // Generating a batch of symmetric keys
+  auto status_or_kem_keys = sender_kem->GenerateKeys(
+      count, HashType::SHA256, test::HexDecodeOrDie(salt_hex),
+      test::HexDecodeOrDie(info_hex), out_len, EcPointFormat::COMPRESSED);
+  ASSERT_TRUE(status_or_kem_keys.ok());
+  const auto& kem_keys = status_or_kem_keys.ValueOrDie();
+  ASSERT_EQ(kem_keys.size(), count);
+
+  // Initializing recipient's KEM data structure using recipient's private keys
+  auto status_or_recipient_kem = Cecpq2HkdfRecipientKemBoringSsl::New(
+      EllipticCurveType::CURVE25519, cecpq2_key_pair.x25519_key_pair.priv,
+      std::move(cecpq2_key_pair.hrss_key_pair.hrss_private_key_seed));
+  ASSERT_TRUE(status_or_recipient_kem.ok());
+  auto recipient_kem = std::move(status_or_recipient_kem.ValueOrDie());
+
+  for (int i = 0; i < count; i++) {
+    for (int j = 0; j < i; j++) {
+      EXPECT_NE(kem_keys[i]->get_kem_bytes(), kem_keys[j]->get_kem_bytes());
+    }
+    auto status_or_shared_secret = recipient_kem->GenerateKey(
+        kem_keys[i]->get_kem_bytes(), HashType::SHA256,
+        test::HexDecodeOrDie(salt_hex), test::HexDecodeOrDie(info_hex),
+        out_len, EcPointFormat::COMPRESSED);
+    ASSERT_TRUE(status_or_shared_secret.ok());
+    EXPECT_EQ(test::HexEncode(util::SecretDataAsStringView(
+                  kem_keys[i]->get_symmetric_key())),
+              test::HexEncode(util::SecretDataAsStringView(
+                  status_or_shared_secret.ValueOrDie())));
+  }
+
+  // Invalid arguments are rejected
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            sender_kem
+                ->GenerateKeys(-1, HashType::SHA256, "", "", out_len,
+                               EcPointFormat::COMPRESSED)
+                .status()
+                .error_code());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            sender_kem
+                ->GenerateKeys(count, HashType::SHA256, "", "", out_len,
+                               EcPointFormat::UNCOMPRESSED)
+                .status()
+                .error_code());
+}
+
 }  // namespace
 }  // namespace subtle
 }  // namespace tink
@@ -0,0 +1,195 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/cc/cc_deterministic_aead_batch.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/strip.h"
+#include "tink/subtle/subtle_util.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+// Slices with fewer values are not worth a thread of their own.
+constexpr int64_t kMinValuesPerSlice = 1024;
+
+// The output of one slice of a column, with offsets starting at 0.
+struct Slice {
+  std::string data;
+  std::vector<int64_t> offsets;
+  util::Status status;
+};
+
+util::Status ValidateColumn(absl::Span<const int64_t> offsets,
+                            absl::string_view data) {
+  if (offsets.empty()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "A column needs at least one offset");
+  }
+  for (size_t i = 0; i < offsets.size(); i++) {
+    int64_t previous = i == 0 ? 0 : offsets[i - 1];
+    if (offsets[i] < previous ||
+        static_cast<size_t>(offsets[i]) > data.size()) {
+      return util::Status(
+          util::error::INVALID_ARGUMENT,
+          absl::StrCat("Invalid offset ", offsets[i], " at position ", i,
+                       " for column data of ", data.size(), " bytes"));
+    }
+  }
+  return util::Status::OK;
+}
+
+// Calls 'process'(begin, end, slice) for consecutive slices [begin, end) of
+// the values of the column described by 'offsets', on up to 'num_threads'
+// threads, and joins the slices into '*output_data' and '*output_offsets'.
+util::Status ProcessInSlices(
+    absl::Span<const int64_t> offsets, int num_threads,
+    const std::function<util::Status(size_t, size_t, Slice*)>& process,
+    std::string* output_data, std::vector<int64_t>* output_offsets) {
+  const size_t num_values = offsets.size() - 1;
+  if (num_threads <= 0) {
+    num_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  size_t num_slices = std::min<size_t>(
+      num_threads, (num_values + kMinValuesPerSlice - 1) / kMinValuesPerSlice);
+  num_slices = std::max<size_t>(num_slices, 1);
+
+  std::vector<Slice> slices(num_slices);
+  auto run_slice = [&](size_t k) {
+    size_t begin = num_values * k / num_slices;
+    size_t end = num_values * (k + 1) / num_slices;
+    slices[k].status = process(begin, end, &slices[k]);
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(num_slices - 1);
+  for (size_t k = 1; k < num_slices; k++) {
+    threads.emplace_back(run_slice, k);
+  }
+  run_slice(0);
+  for (std::thread& thread : threads) thread.join();
+
+  size_t total_size = 0;
+  for (const Slice& slice : slices) {
+    if (!slice.status.ok()) return slice.status;
+    total_size += slice.data.size();
+  }
+  subtle::ResizeStringUninitialized(output_data, total_size);
+  output_offsets->clear();
+  output_offsets->reserve(num_values + 1);
+  output_offsets->push_back(0);
+  int64_t base = 0;
+  for (const Slice& slice : slices) {
+    std::copy(slice.data.begin(), slice.data.end(),
+              output_data->begin() + base);
+    for (size_t i = 1; i < slice.offsets.size(); i++) {
+      output_offsets->push_back(base + slice.offsets[i]);
+    }
+    base += slice.data.size();
+  }
+  return util::Status::OK;
+}
+
+}  // namespace
+
+util::Status EncryptDeterministicallyColumn(
+    const DeterministicAead& daead, absl::Span<const int64_t> plaintext_offsets,
+    absl::string_view plaintext_data, absl::string_view associated_data,
+    absl::string_view output_prefix, int num_threads,
+    std::string* ciphertext_data, std::vector<int64_t>* ciphertext_offsets) {
+  util::Status status = ValidateColumn(plaintext_offsets, plaintext_data);
+  if (!status.ok()) return status;
+  auto process = [&](size_t begin, size_t end,
+                     Slice* slice) -> util::Status {
+    // EncryptDeterministicallyBatch() lets the primitive share work between
+    // the values of the slice.
+    std::string data;
+    std::vector<int64_t> offsets;
+    util::Status batch_status = daead.EncryptDeterministicallyBatch(
+        plaintext_offsets.subspan(begin, end - begin + 1), plaintext_data,
+        associated_data, &data, &offsets);
+    if (!batch_status.ok()) return batch_status;
+    if (output_prefix.empty()) {
+      slice->data = std::move(data);
+      slice->offsets = std::move(offsets);
+      return util::Status::OK;
+    }
+    slice->data.reserve(data.size() + (end - begin) * output_prefix.size());
+    slice->offsets.reserve(offsets.size());
+    slice->offsets.push_back(0);
+    for (size_t i = 0; i + 1 < offsets.size(); i++) {
+      slice->data.append(output_prefix.data(), output_prefix.size());
+      slice->data.append(data, offsets[i], offsets[i + 1] - offsets[i]);
+      slice->offsets.push_back(slice->data.size());
+    }
+    return util::Status::OK;
+  };
+  return ProcessInSlices(plaintext_offsets, num_threads, process,
+                         ciphertext_data, ciphertext_offsets);
+}
+
+util::Status DecryptDeterministicallyColumn(
+    const DeterministicAead& daead,
+    absl::Span<const int64_t> ciphertext_offsets,
+    absl::string_view ciphertext_data, absl::string_view associated_data,
+    absl::string_view output_prefix, int num_threads,
+    std::string* plaintext_data, std::vector<int64_t>* plaintext_offsets) {
+  util::Status status = ValidateColumn(ciphertext_offsets, ciphertext_data);
+  if (!status.ok()) return status;
+  // The work which only depends on the associated data is done once, and
+  // shared by all threads.
+  auto with_associated_data_result = daead.WithAssociatedData(associated_data);
+  if (!with_associated_data_result.ok()) {
+    return with_associated_data_result.status();
+  }
+  const DeterministicAeadWithAssociatedData& with_associated_data =
+      *with_associated_data_result.ValueOrDie();
+  auto process = [&](size_t begin, size_t end,
+                     Slice* slice) -> util::Status {
+    // A plaintext is never longer than its ciphertext.
+    slice->data.reserve(ciphertext_offsets[end] - ciphertext_offsets[begin]);
+    slice->offsets.reserve(end - begin + 1);
+    slice->offsets.push_back(0);
+    for (size_t i = begin; i < end; i++) {
+      absl::string_view ciphertext = ciphertext_data.substr(
+          ciphertext_offsets[i],
+          ciphertext_offsets[i + 1] - ciphertext_offsets[i]);
+      if (!absl::ConsumePrefix(&ciphertext, output_prefix)) {
+        return util::Status(
+            util::error::INVALID_ARGUMENT,
+            absl::StrCat("Ciphertext ", i, " lacks the output prefix"));
+      }
+      auto decrypt_result =
+          with_associated_data.DecryptDeterministically(ciphertext);
+      if (!decrypt_result.ok()) return decrypt_result.status();
+      slice->data.append(decrypt_result.ValueOrDie());
+      slice->offsets.push_back(slice->data.size());
+    }
+    return util::Status::OK;
+  };
+  return ProcessInSlices(ciphertext_offsets, num_threads, process,
+                         plaintext_data, plaintext_offsets);
+}
+
+}  // namespace tink
+}  // namespace crypto
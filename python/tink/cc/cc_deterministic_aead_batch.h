@@ -0,0 +1,63 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_PYTHON_CC_CC_DETERMINISTIC_AEAD_BATCH_H_
+#define TINK_PYTHON_CC_CC_DETERMINISTIC_AEAD_BATCH_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "tink/deterministic_aead.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+
+// Bulk deterministic encryption of whole columns for the Python bindings,
+// which would otherwise encrypt a pandas or Arrow column one value at a time.
+//
+// Columns use the layout of Arrow binary arrays, as in
+// DeterministicAead::EncryptDeterministicallyBatch(): n + 1 offsets into one
+// data buffer. The column is split into slices of consecutive values, which
+// are processed on up to 'num_threads' threads (0 means one per core), and
+// the results are joined in order. The output offsets start at 0.
+//
+// 'output_prefix' is prepended to every ciphertext on encryption, and must
+// start every ciphertext on decryption, where it is removed before
+// decrypting. It is the output prefix of the primary key of a keyset, since
+// the Python keyset wrapper adds the prefixes itself.
+//
+// Either all values are processed, or an error is returned.
+util::Status EncryptDeterministicallyColumn(
+    const DeterministicAead& daead, absl::Span<const int64_t> plaintext_offsets,
+    absl::string_view plaintext_data, absl::string_view associated_data,
+    absl::string_view output_prefix, int num_threads,
+    std::string* ciphertext_data, std::vector<int64_t>* ciphertext_offsets);
+
+util::Status DecryptDeterministicallyColumn(
+    const DeterministicAead& daead,
+    absl::Span<const int64_t> ciphertext_offsets,
+    absl::string_view ciphertext_data, absl::string_view associated_data,
+    absl::string_view output_prefix, int num_threads,
+    std::string* plaintext_data, std::vector<int64_t>* plaintext_offsets);
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_PYTHON_CC_CC_DETERMINISTIC_AEAD_BATCH_H_
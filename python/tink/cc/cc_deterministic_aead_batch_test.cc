@@ -0,0 +1,164 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/cc/cc_deterministic_aead_batch.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "tink/subtle/aes_siv_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/secret_data.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+std::unique_ptr<DeterministicAead> NewDaead() {
+  auto daead_result = subtle::AesSivBoringSsl::New(
+      util::SecretDataFromStringView(subtle::Random::GetRandomBytes(64)));
+  EXPECT_TRUE(daead_result.ok()) << daead_result.status();
+  return std::move(daead_result.ValueOrDie());
+}
+
+// Returns a column of 'n' values of varying sizes.
+std::vector<std::string> NewValues(int n) {
+  std::vector<std::string> values;
+  for (int i = 0; i < n; i++) values.push_back(absl::StrCat("value ", i * 7));
+  return values;
+}
+
+void ToColumn(const std::vector<std::string>& values, std::string* data,
+              std::vector<int64_t>* offsets) {
+  data->clear();
+  offsets->assign(1, 0);
+  for (const std::string& value : values) {
+    data->append(value);
+    offsets->push_back(data->size());
+  }
+}
+
+std::string Value(const std::string& data, const std::vector<int64_t>& offsets,
+                  int i) {
+  return data.substr(offsets[i], offsets[i + 1] - offsets[i]);
+}
+
+class CcDeterministicAeadBatchTest : public ::testing::TestWithParam<int> {};
+
+TEST_P(CcDeterministicAeadBatchTest, EncryptDecrypt) {
+  int num_threads = GetParam();
+  std::unique_ptr<DeterministicAead> daead = NewDaead();
+  std::vector<std::string> values = NewValues(5000);
+  std::string plaintext_data;
+  std::vector<int64_t> plaintext_offsets;
+  ToColumn(values, &plaintext_data, &plaintext_offsets);
+
+  std::string ciphertext_data;
+  std::vector<int64_t> ciphertext_offsets;
+  ASSERT_TRUE(EncryptDeterministicallyColumn(
+                  *daead, plaintext_offsets, plaintext_data, "ad", "prefix",
+                  num_threads, &ciphertext_data, &ciphertext_offsets)
+                  .ok());
+  ASSERT_EQ(values.size() + 1, ciphertext_offsets.size());
+  EXPECT_EQ(0, ciphertext_offsets[0]);
+  for (int i : {0, 1, 1023, 1024, 2500, 4999}) {
+    std::string ciphertext = Value(ciphertext_data, ciphertext_offsets, i);
+    EXPECT_EQ(
+        absl::StrCat("prefix",
+                     daead->EncryptDeterministically(values[i], "ad")
+                         .ValueOrDie()),
+        ciphertext);
+  }
+
+  std::string decrypted_data;
+  std::vector<int64_t> decrypted_offsets;
+  ASSERT_TRUE(DecryptDeterministicallyColumn(
+                  *daead, ciphertext_offsets, ciphertext_data, "ad", "prefix",
+                  num_threads, &decrypted_data, &decrypted_offsets)
+                  .ok());
+  EXPECT_EQ(plaintext_data, decrypted_data);
+  EXPECT_EQ(plaintext_offsets, decrypted_offsets);
+}
+
+INSTANTIATE_TEST_SUITE_P(NumThreads, CcDeterministicAeadBatchTest,
+                         ::testing::Values(0, 1, 3));
+
+TEST(CcDeterministicAeadBatchErrorsTest, EmptyColumn) {
+  std::unique_ptr<DeterministicAead> daead = NewDaead();
+  std::vector<int64_t> offsets = {0};
+  std::string data;
+  std::vector<int64_t> output_offsets;
+  ASSERT_TRUE(EncryptDeterministicallyColumn(*daead, offsets, "", "ad", "", 4,
+                                             &data, &output_offsets)
+                  .ok());
+  EXPECT_EQ("", data);
+  EXPECT_EQ(offsets, output_offsets);
+}
+
+TEST(CcDeterministicAeadBatchErrorsTest, InvalidOffsets) {
+  std::unique_ptr<DeterministicAead> daead = NewDaead();
+  std::string data;
+  std::vector<int64_t> output_offsets;
+  EXPECT_FALSE(EncryptDeterministicallyColumn(*daead, {}, "", "ad", "", 1,
+                                              &data, &output_offsets)
+                   .ok());
+  std::vector<int64_t> decreasing = {0, 3, 2};
+  EXPECT_FALSE(EncryptDeterministicallyColumn(*daead, decreasing, "abc", "ad",
+                                              "", 1, &data, &output_offsets)
+                   .ok());
+  std::vector<int64_t> too_large = {0, 4};
+  EXPECT_FALSE(DecryptDeterministicallyColumn(*daead, too_large, "abc", "ad",
+                                              "", 1, &data, &output_offsets)
+                   .ok());
+}
+
+TEST(CcDeterministicAeadBatchErrorsTest, DecryptionFailures) {
+  std::unique_ptr<DeterministicAead> daead = NewDaead();
+  std::vector<std::string> values = NewValues(3000);
+  std::string plaintext_data;
+  std::vector<int64_t> plaintext_offsets;
+  ToColumn(values, &plaintext_data, &plaintext_offsets);
+  std::string ciphertext_data;
+  std::vector<int64_t> ciphertext_offsets;
+  ASSERT_TRUE(EncryptDeterministicallyColumn(
+                  *daead, plaintext_offsets, plaintext_data, "ad", "prefix", 2,
+                  &ciphertext_data, &ciphertext_offsets)
+                  .ok());
+
+  std::string data;
+  std::vector<int64_t> offsets;
+  EXPECT_FALSE(DecryptDeterministicallyColumn(*daead, ciphertext_offsets,
+                                              ciphertext_data, "other ad",
+                                              "prefix", 2, &data, &offsets)
+                   .ok());
+  EXPECT_FALSE(DecryptDeterministicallyColumn(*daead, ciphertext_offsets,
+                                              ciphertext_data, "ad", "other",
+                                              2, &data, &offsets)
+                   .ok());
+  // A single corrupted value in the last slice fails the whole column.
+  ciphertext_data[ciphertext_data.size() - 1] ^= 1;
+  EXPECT_FALSE(DecryptDeterministicallyColumn(*daead, ciphertext_offsets,
+                                              ciphertext_data, "ad", "prefix",
+                                              2, &data, &offsets)
+                   .ok());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
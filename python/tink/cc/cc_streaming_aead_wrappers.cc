@@ -16,6 +16,8 @@
 
 #include "tink/input_stream.h"
 #include "tink/output_stream.h"
+#include "tink/util/io_uring_file_input_stream.h"
+#include "tink/util/io_uring_file_output_stream.h"
 
 namespace crypto {
 namespace tink {
@@ -56,5 +58,31 @@ util::StatusOr<std::unique_ptr<InputStreamAdapter>> NewCcDecryptingStream(
   return absl::make_unique<InputStreamAdapter>(std::move(result.ValueOrDie()));
 }
 
+util::StatusOr<std::unique_ptr<OutputStreamAdapter>> NewCcEncryptingStreamToFd(
+    StreamingAead* streaming_aead, absl::string_view aad,
+    int ciphertext_destination_fd) {
+  std::unique_ptr<OutputStream> destination_os =
+      absl::make_unique<util::IoUringFileOutputStream>(
+          ciphertext_destination_fd);
+  auto result =
+      streaming_aead->NewEncryptingStream(std::move(destination_os), aad);
+  if (!result.ok()) {
+    return result.status();
+  }
+  return absl::make_unique<OutputStreamAdapter>(std::move(result.ValueOrDie()));
+}
+
+util::StatusOr<std::unique_ptr<InputStreamAdapter>> NewCcDecryptingStreamFromFd(
+    StreamingAead* streaming_aead, absl::string_view aad,
+    int ciphertext_source_fd) {
+  std::unique_ptr<InputStream> source_is =
+      absl::make_unique<util::IoUringFileInputStream>(ciphertext_source_fd);
+  auto result = streaming_aead->NewDecryptingStream(std::move(source_is), aad);
+  if (!result.ok()) {
+    return result.status();
+  }
+  return absl::make_unique<InputStreamAdapter>(std::move(result.ValueOrDie()));
+}
+
 }  // namespace tink
 }  // namespace crypto
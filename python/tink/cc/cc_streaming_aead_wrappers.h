@@ -51,6 +51,22 @@ util::StatusOr<std::unique_ptr<InputStreamAdapter>> NewCcDecryptingStream(
     StreamingAead* streaming_aead, const absl::string_view aad,
     std::shared_ptr<PythonFileObjectAdapter> ciphertext_source);
 
+// Like NewCcEncryptingStream, but writes the ciphertext straight to the file
+// descriptor 'ciphertext_destination_fd', through an IoUringFileOutputStream,
+// so that no Python code runs per chunk. Takes the ownership of the file
+// descriptor, and closes it when the stream is closed or destroyed; the
+// Python code passes a duplicate of the descriptor of its file object.
+util::StatusOr<std::unique_ptr<OutputStreamAdapter>> NewCcEncryptingStreamToFd(
+    StreamingAead* streaming_aead, const absl::string_view aad,
+    int ciphertext_destination_fd);
+
+// Like NewCcDecryptingStream, but reads the ciphertext straight from the
+// file descriptor 'ciphertext_source_fd', through an IoUringFileInputStream.
+// Takes the ownership of the file descriptor like NewCcEncryptingStreamToFd.
+util::StatusOr<std::unique_ptr<InputStreamAdapter>> NewCcDecryptingStreamFromFd(
+    StreamingAead* streaming_aead, const absl::string_view aad,
+    int ciphertext_source_fd);
+
 }  // namespace tink
 }  // namespace crypto
 
@@ -14,7 +14,13 @@
 
 #include "tink/cc/cc_streaming_aead_wrappers.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string>
+
 #include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
 #include "tink/cc/test_util.h"
 
 namespace crypto {
@@ -45,6 +51,40 @@ TEST(CcStreamingAeadWrappersTest, BasicNewCcDecryptingStream) {
   EXPECT_TRUE(result.status().ok());
 }
 
+TEST(CcStreamingAeadWrappersTest, EncryptAndDecryptWithFileDescriptors) {
+  DummyStreamingAead dummy_saead = DummyStreamingAead("Some streaming AEAD");
+  std::string filename = absl::StrCat(::testing::TempDir(), "/fd_stream_",
+                                      getpid());
+  int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+  ASSERT_GE(fd, 0);
+  auto encrypt_result =
+      NewCcEncryptingStreamToFd(&dummy_saead, "associated data", fd);
+  ASSERT_TRUE(encrypt_result.status().ok());
+  std::string plaintext(100000, 'p');
+  auto write_result = encrypt_result.ValueOrDie()->Write(plaintext);
+  ASSERT_TRUE(write_result.ok());
+  EXPECT_EQ(plaintext.size(), write_result.ValueOrDie());
+  ASSERT_TRUE(encrypt_result.ValueOrDie()->Close().ok());
+
+  fd = open(filename.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  auto decrypt_result =
+      NewCcDecryptingStreamFromFd(&dummy_saead, "associated data", fd);
+  ASSERT_TRUE(decrypt_result.status().ok());
+  std::string decrypted;
+  while (true) {
+    auto read_result = decrypt_result.ValueOrDie()->Read(-1);
+    if (!read_result.ok()) {
+      EXPECT_EQ(util::error::OUT_OF_RANGE,
+                read_result.status().error_code());
+      break;
+    }
+    decrypted += read_result.ValueOrDie();
+  }
+  EXPECT_EQ(plaintext, decrypted);
+  unlink(filename.c_str());
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
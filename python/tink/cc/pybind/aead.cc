@@ -16,8 +16,12 @@
 
 #include "tink/aead.h"
 
+#include <cstdint>
+
+#include "absl/types/span.h"
 #include "pybind11/pybind11.h"
 #include "tink/util/statusor.h"
+#include "tink/cc/pybind/buffer_util.h"
 #include "tink/cc/pybind/status_casters.h"
 
 namespace crypto {
@@ -38,11 +42,22 @@ void PybindRegisterAead(pybind11::module* module) {
 
       .def(
           "encrypt",
-          [](const Aead& self, const py::bytes& plaintext,
-             const py::bytes& associated_data) -> util::StatusOr<py::bytes> {
-            // TODO(b/145925674)
-            return self.Encrypt(std::string(plaintext),
-                                std::string(associated_data));
+          [](const Aead& self, const py::buffer& plaintext,
+             const py::buffer& associated_data) -> util::StatusOr<py::bytes> {
+            BufferView plaintext_view(plaintext);
+            BufferView associated_data_view(associated_data);
+            auto size_result = self.CiphertextSize(plaintext_view.get().size());
+            if (!size_result.ok()) {
+              return CallWithoutGil([&]() {
+                return self.Encrypt(plaintext_view.get(),
+                                    associated_data_view.get());
+              });
+            }
+            return FillBytesWithoutGil(
+                size_result.ValueOrDie(), [&](absl::Span<char> buffer) {
+                  return self.EncryptInto(plaintext_view.get(),
+                                          associated_data_view.get(), buffer);
+                });
           },
           py::arg("plaintext"), py::arg("associated_data"),
           "Encrypts 'plaintext' with 'associated_data' as associated data, "
@@ -51,11 +66,16 @@ void PybindRegisterAead(pybind11::module* module) {
           "of the associated data, but does not guarantee its secrecy.")
       .def(
           "decrypt",
-          [](const Aead& self, const py::bytes& ciphertext,
-             const py::bytes& associated_data) -> util::StatusOr<py::bytes> {
-            // TODO(b/145925674)
-            return self.Decrypt(std::string(ciphertext),
-                                std::string(associated_data));
+          [](const Aead& self, const py::buffer& ciphertext,
+             const py::buffer& associated_data) -> util::StatusOr<py::bytes> {
+            BufferView ciphertext_view(ciphertext);
+            BufferView associated_data_view(associated_data);
+            // A plaintext is never longer than its ciphertext.
+            return FillBytesWithoutGil(
+                ciphertext_view.get().size(), [&](absl::Span<char> buffer) {
+                  return self.DecryptInto(ciphertext_view.get(),
+                                          associated_data_view.get(), buffer);
+                });
           },
           py::arg("ciphertext"), py::arg("associated_data"),
           "Decrypts 'ciphertext' with 'associated_data' as associated data, "
@@ -0,0 +1,62 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/cc/pybind/buffer_util.h"
+
+#include <cstdint>
+#include <functional>
+
+#include "absl/types/span.h"
+#include "pybind11/pybind11.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+BufferView::BufferView(const pybind11::buffer& buffer) {
+  if (PyObject_GetBuffer(buffer.ptr(), &view_, PyBUF_SIMPLE) != 0) {
+    throw pybind11::error_already_set();
+  }
+}
+
+BufferView::~BufferView() { PyBuffer_Release(&view_); }
+
+util::StatusOr<pybind11::bytes> FillBytesWithoutGil(
+    int64_t max_size,
+    const std::function<util::StatusOr<int64_t>(absl::Span<char>)>& fill) {
+  // A bytes object may be written to until it is shared.
+  PyObject* bytes = PyBytes_FromStringAndSize(nullptr, max_size);
+  if (bytes == nullptr) throw pybind11::error_already_set();
+  auto result = pybind11::reinterpret_steal<pybind11::bytes>(bytes);
+  absl::Span<char> buffer(PyBytes_AS_STRING(bytes), max_size);
+  auto written_result = CallWithoutGil([&fill, buffer]() {
+    return fill(buffer);
+  });
+  if (!written_result.ok()) return written_result.status();
+  int64_t written = written_result.ValueOrDie();
+  if (written < max_size) {
+    // _PyBytes_Resize() may move the object, and frees it on failure.
+    bytes = result.release().ptr();
+    if (_PyBytes_Resize(&bytes, written) != 0) {
+      throw pybind11::error_already_set();
+    }
+    result = pybind11::reinterpret_steal<pybind11::bytes>(bytes);
+  }
+  return result;
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,74 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_PYTHON_TINK_CC_PYBIND_BUFFER_UTIL_H_
+#define TINK_PYTHON_TINK_CC_PYBIND_BUFFER_UTIL_H_
+
+#include <cstdint>
+#include <functional>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "pybind11/pybind11.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+// A read-only view on the contents of a Python object which supports the
+// buffer protocol, e.g. bytes, bytearray or memoryview, which avoids copying
+// them into a std::string.  The object cannot be resized while the view
+// exists, so the view can be used after releasing the GIL.  The view must be
+// created and destroyed while holding the GIL.
+//
+// The contents of a mutable object (e.g. a bytearray) must not be modified
+// by another thread while the GIL is released.
+class BufferView {
+ public:
+  // Throws pybind11::error_already_set if 'buffer' is not contiguous.
+  explicit BufferView(const pybind11::buffer& buffer);
+  ~BufferView();
+
+  BufferView(const BufferView&) = delete;
+  BufferView& operator=(const BufferView&) = delete;
+
+  absl::string_view get() const {
+    return absl::string_view(static_cast<const char*>(view_.buf), view_.len);
+  }
+
+ private:
+  Py_buffer view_;
+};
+
+// Runs 'function' with the GIL released, so that other Python threads can
+// run meanwhile.  'function' must not use any Python objects.
+template <typename Function>
+auto CallWithoutGil(Function function) -> decltype(function()) {
+  pybind11::gil_scoped_release release;
+  return function();
+}
+
+// Creates a bytes object of at most 'max_size' bytes and fills it, with the
+// GIL released, with 'fill', which writes into the given buffer and returns
+// the number of bytes written.  The result is returned without copying it.
+util::StatusOr<pybind11::bytes> FillBytesWithoutGil(
+    int64_t max_size,
+    const std::function<util::StatusOr<int64_t>(absl::Span<char>)>& fill);
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_PYTHON_TINK_CC_PYBIND_BUFFER_UTIL_H_
@@ -87,6 +87,19 @@ class AeadKeyManagerTest(absltest.TestCase):
     ciphertext = primitive.encrypt(plaintext, associated_data)
     self.assertEqual(primitive.decrypt(ciphertext, associated_data), plaintext)
 
+  def test_encrypt_decrypt_buffers(self):
+    key_template = self.new_aes_eax_key_template(12, 16)
+    key_data = self.key_manager.new_key_data(key_template)
+
+    primitive = self.key_manager.primitive(key_data)
+    plaintext = bytearray(b'plaintext')
+    associated_data = memoryview(b'xxassociated_data')[2:]
+    ciphertext = primitive.encrypt(plaintext, associated_data)
+    self.assertIsInstance(ciphertext, bytes)
+    self.assertEqual(
+        primitive.decrypt(memoryview(ciphertext), b'associated_data'),
+        b'plaintext')
+
 
 class DeterministicAeadKeyManagerTest(absltest.TestCase):
 
@@ -245,6 +258,7 @@ class MacKeyManagerTest(absltest.TestCase):
     self.assertLen(tag, 24)
     # No exception raised.
     mac.verify_mac(tag, data)
+    mac.verify_mac(bytearray(tag), memoryview(data))
 
   def test_mac_wrong(self):
     mac = self.key_manager.primitive(
@@ -16,7 +16,11 @@
 
 #include "tink/cc/cc_streaming_aead_wrappers.h"
 
+#include <string>
+
 #include "pybind11/pybind11.h"
+#include "tink/cc/streaming_aead_pipe.h"
+#include "tink/cc/pybind/buffer_util.h"
 #include "tink/cc/pybind/import_helper.h"
 #include "tink/cc/pybind/status_casters.h"
 
@@ -30,11 +34,11 @@ void PybindRegisterCcStreamingAeadWrappers(pybind11::module* module) {
   // TODO(b/146492561): Reduce the number of complicated lambdas.
   m.def(
       "new_cc_encrypting_stream",
-      // TODO(b/145925674)
-      [](StreamingAead* streaming_aead, const py::bytes& aad,
+      [](StreamingAead* streaming_aead, const py::buffer& aad,
          std::shared_ptr<PythonFileObjectAdapter> ciphertext_destination)
           -> util::StatusOr<std::unique_ptr<OutputStreamAdapter>> {
-        return NewCcEncryptingStream(streaming_aead, std::string(aad),
+        BufferView aad_view(aad);
+        return NewCcEncryptingStream(streaming_aead, aad_view.get(),
                                      ciphertext_destination);
       },
       py::arg("primitive"), py::arg("aad"), py::arg("destination"),
@@ -43,16 +47,78 @@ void PybindRegisterCcStreamingAeadWrappers(pybind11::module* module) {
 
   m.def(
       "new_cc_decrypting_stream",
-      // TODO(b/145925674)
-      [](StreamingAead* streaming_aead, const py::bytes& aad,
+      [](StreamingAead* streaming_aead, const py::buffer& aad,
          std::shared_ptr<PythonFileObjectAdapter> ciphertext_source)
           -> util::StatusOr<std::unique_ptr<InputStreamAdapter>> {
-        return NewCcDecryptingStream(streaming_aead, std::string(aad),
+        BufferView aad_view(aad);
+        return NewCcDecryptingStream(streaming_aead, aad_view.get(),
                                      ciphertext_source);
       },
       py::arg("primitive"), py::arg("aad"), py::arg("source"),
       // Keep source alive at least as long as InputStreamAdapter.
       py::keep_alive<0, 3>());
+
+  // The streams below own the file descriptor, so Python passes a duplicate
+  // of the descriptor of its file object.
+  m.def(
+      "new_cc_encrypting_stream_to_fd",
+      [](StreamingAead* streaming_aead, const py::buffer& aad,
+         int ciphertext_destination_fd)
+          -> util::StatusOr<std::unique_ptr<OutputStreamAdapter>> {
+        BufferView aad_view(aad);
+        return NewCcEncryptingStreamToFd(streaming_aead, aad_view.get(),
+                                         ciphertext_destination_fd);
+      },
+      py::arg("primitive"), py::arg("aad"), py::arg("destination_fd"));
+
+  m.def(
+      "new_cc_decrypting_stream_from_fd",
+      [](StreamingAead* streaming_aead, const py::buffer& aad,
+         int ciphertext_source_fd)
+          -> util::StatusOr<std::unique_ptr<InputStreamAdapter>> {
+        BufferView aad_view(aad);
+        return NewCcDecryptingStreamFromFd(streaming_aead, aad_view.get(),
+                                           ciphertext_source_fd);
+      },
+      py::arg("primitive"), py::arg("aad"), py::arg("source_fd"));
+
+  // The methods of the pipe block until its worker thread makes progress, so
+  // they all run without the GIL.
+  py::class_<StreamingAeadPipe>(m, "StreamingAeadPipe")
+      .def(
+          "write",
+          [](StreamingAeadPipe* self, const py::buffer& data) -> util::Status {
+            BufferView data_view(data);
+            return CallWithoutGil(
+                [&]() { return self->Write(data_view.get()); });
+          },
+          py::arg("data"))
+      .def("close_input", &StreamingAeadPipe::CloseInput,
+           py::call_guard<py::gil_scoped_release>())
+      .def("read",
+           [](StreamingAeadPipe* self) -> util::StatusOr<py::bytes> {
+             util::StatusOr<std::string> read_result =
+                 CallWithoutGil([&]() { return self->Read(); });
+             if (!read_result.ok()) return read_result.status();
+             return py::bytes(read_result.ValueOrDie());
+           })
+      .def("cancel", &StreamingAeadPipe::Cancel,
+           py::call_guard<py::gil_scoped_release>());
+
+  m.def(
+      "new_cc_streaming_aead_pipe",
+      [](StreamingAead* streaming_aead, const py::buffer& aad,
+         bool encrypt) -> util::StatusOr<std::unique_ptr<StreamingAeadPipe>> {
+        BufferView aad_view(aad);
+        return StreamingAeadPipe::New(
+            streaming_aead, aad_view.get(),
+            encrypt ? StreamingAeadPipe::Direction::kEncrypt
+                    : StreamingAeadPipe::Direction::kDecrypt);
+      },
+      py::arg("primitive"), py::arg("aad"), py::arg("encrypt"),
+      // The worker thread of the pipe uses the primitive until the pipe is
+      // destroyed.
+      py::keep_alive<0, 1>());
 }
 
 }  // namespace tink
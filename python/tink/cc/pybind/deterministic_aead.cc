@@ -16,15 +16,107 @@
 
 #include "tink/deterministic_aead.h"
 
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
 #include "pybind11/pybind11.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
+#include "tink/cc/cc_deterministic_aead_batch.h"
+#include "tink/cc/pybind/buffer_util.h"
 #include "tink/cc/pybind/status_casters.h"
 
 namespace crypto {
 namespace tink {
 
+namespace {
+
+namespace py = pybind11;
+
+// The functions which process a column, i.e. EncryptDeterministicallyColumn()
+// and DecryptDeterministicallyColumn().
+using ColumnFunction = util::Status (*)(
+    const DeterministicAead&, absl::Span<const int64_t>, absl::string_view,
+    absl::string_view, absl::string_view, int, std::string*,
+    std::vector<int64_t>*);
+
+// Runs 'function' on the values of 'values', and returns the results as a
+// list of bytes. The values are copied into one column while the GIL is
+// held, and the whole column is then processed without it.
+util::StatusOr<py::list> ProcessList(ColumnFunction function,
+                                     const DeterministicAead& daead,
+                                     const py::list& values,
+                                     absl::string_view associated_data,
+                                     absl::string_view output_prefix,
+                                     int num_threads) {
+  std::string input_data;
+  std::vector<int64_t> input_offsets = {0};
+  input_offsets.reserve(values.size() + 1);
+  for (const py::handle& value : values) {
+    BufferView value_view(py::reinterpret_borrow<py::buffer>(value));
+    input_data.append(value_view.get().data(), value_view.get().size());
+    input_offsets.push_back(input_data.size());
+  }
+  std::string output_data;
+  std::vector<int64_t> output_offsets;
+  util::Status status = CallWithoutGil([&]() {
+    return function(daead, input_offsets, input_data, associated_data,
+                    output_prefix, num_threads, &output_data, &output_offsets);
+  });
+  if (!status.ok()) return status;
+  py::list output(values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    output[i] = py::bytes(output_data.data() + output_offsets[i],
+                          output_offsets[i + 1] - output_offsets[i]);
+  }
+  return output;
+}
+
+// Runs 'function' on a column in the layout of an Arrow binary array, given
+// by the buffers of its offsets and of its data. The offsets are 32-bit
+// (Arrow binary) or 64-bit (Arrow large binary) integers in native byte
+// order, as given by 'offset_size'. Returns the buffers of the output column,
+// which always has 64-bit offsets.
+util::StatusOr<py::tuple> ProcessColumn(ColumnFunction function,
+                                        const DeterministicAead& daead,
+                                        absl::string_view offsets,
+                                        int offset_size, absl::string_view data,
+                                        absl::string_view associated_data,
+                                        absl::string_view output_prefix,
+                                        int num_threads) {
+  if ((offset_size != 4 && offset_size != 8) ||
+      offsets.size() % offset_size != 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Offsets must be 32-bit or 64-bit integers");
+  }
+  std::string output_data;
+  std::vector<int64_t> output_offsets;
+  util::Status status = CallWithoutGil([&]() {
+    std::vector<int64_t> input_offsets(offsets.size() / offset_size);
+    for (size_t i = 0; i < input_offsets.size(); i++) {
+      if (offset_size == 4) {
+        int32_t offset;
+        std::memcpy(&offset, offsets.data() + 4 * i, 4);
+        input_offsets[i] = offset;
+      } else {
+        std::memcpy(&input_offsets[i], offsets.data() + 8 * i, 8);
+      }
+    }
+    return function(daead, input_offsets, data, associated_data,
+                    output_prefix, num_threads, &output_data, &output_offsets);
+  });
+  if (!status.ok()) return status;
+  return py::make_tuple(
+      py::bytes(reinterpret_cast<const char*>(output_offsets.data()),
+                output_offsets.size() * sizeof(int64_t)),
+      py::bytes(output_data));
+}
+
+}  // namespace
+
 void PybindRegisterDeterministicAead(pybind11::module* module) {
-  namespace py = pybind11;
   py::module& m = *module;
 
   // TODO(b/146492561): Reduce the number of complicated lambdas.
@@ -51,22 +143,90 @@ void PybindRegisterDeterministicAead(pybind11::module* module) {
 
       .def(
           "encrypt_deterministically",
-          [](const DeterministicAead& self, const py::bytes& plaintext,
-             const py::bytes& associated_data) -> util::StatusOr<py::bytes> {
-            // TODO(b/145925674)
-            return self.EncryptDeterministically(std::string(plaintext),
-                                                 std::string(associated_data));
+          [](const DeterministicAead& self, const py::buffer& plaintext,
+             const py::buffer& associated_data) -> util::StatusOr<py::bytes> {
+            BufferView plaintext_view(plaintext);
+            BufferView associated_data_view(associated_data);
+            return CallWithoutGil([&]() {
+              return self.EncryptDeterministically(plaintext_view.get(),
+                                                   associated_data_view.get());
+            });
           },
           py::arg("plaintext"), py::arg("associated_data"))
       .def(
           "decrypt_deterministically",
-          [](const DeterministicAead& self, const py::bytes& ciphertext,
-             const py::bytes& associated_data) -> util::StatusOr<py::bytes> {
-            // TODO(b/145925674)
-            return self.DecryptDeterministically(std::string(ciphertext),
-                                                 std::string(associated_data));
+          [](const DeterministicAead& self, const py::buffer& ciphertext,
+             const py::buffer& associated_data) -> util::StatusOr<py::bytes> {
+            BufferView ciphertext_view(ciphertext);
+            BufferView associated_data_view(associated_data);
+            return CallWithoutGil([&]() {
+              return self.DecryptDeterministically(ciphertext_view.get(),
+                                                   associated_data_view.get());
+            });
+          },
+          py::arg("ciphertext"), py::arg("associated_data"))
+      .def(
+          "encrypt_deterministically_batch",
+          [](const DeterministicAead& self, const py::list& plaintexts,
+             const py::buffer& associated_data, const py::buffer& output_prefix,
+             int num_threads) -> util::StatusOr<py::list> {
+            BufferView associated_data_view(associated_data);
+            BufferView output_prefix_view(output_prefix);
+            return ProcessList(&EncryptDeterministicallyColumn, self,
+                               plaintexts, associated_data_view.get(),
+                               output_prefix_view.get(), num_threads);
+          },
+          py::arg("plaintexts"), py::arg("associated_data"),
+          py::arg("output_prefix"), py::arg("num_threads"))
+      .def(
+          "decrypt_deterministically_batch",
+          [](const DeterministicAead& self, const py::list& ciphertexts,
+             const py::buffer& associated_data, const py::buffer& output_prefix,
+             int num_threads) -> util::StatusOr<py::list> {
+            BufferView associated_data_view(associated_data);
+            BufferView output_prefix_view(output_prefix);
+            return ProcessList(&DecryptDeterministicallyColumn, self,
+                               ciphertexts, associated_data_view.get(),
+                               output_prefix_view.get(), num_threads);
+          },
+          py::arg("ciphertexts"), py::arg("associated_data"),
+          py::arg("output_prefix"), py::arg("num_threads"))
+      .def(
+          "encrypt_deterministically_column",
+          [](const DeterministicAead& self, const py::buffer& offsets,
+             int offset_size, const py::buffer& data,
+             const py::buffer& associated_data, const py::buffer& output_prefix,
+             int num_threads) -> util::StatusOr<py::tuple> {
+            BufferView offsets_view(offsets);
+            BufferView data_view(data);
+            BufferView associated_data_view(associated_data);
+            BufferView output_prefix_view(output_prefix);
+            return ProcessColumn(&EncryptDeterministicallyColumn, self,
+                                 offsets_view.get(), offset_size,
+                                 data_view.get(), associated_data_view.get(),
+                                 output_prefix_view.get(), num_threads);
+          },
+          py::arg("offsets"), py::arg("offset_size"), py::arg("data"),
+          py::arg("associated_data"), py::arg("output_prefix"),
+          py::arg("num_threads"))
+      .def(
+          "decrypt_deterministically_column",
+          [](const DeterministicAead& self, const py::buffer& offsets,
+             int offset_size, const py::buffer& data,
+             const py::buffer& associated_data, const py::buffer& output_prefix,
+             int num_threads) -> util::StatusOr<py::tuple> {
+            BufferView offsets_view(offsets);
+            BufferView data_view(data);
+            BufferView associated_data_view(associated_data);
+            BufferView output_prefix_view(output_prefix);
+            return ProcessColumn(&DecryptDeterministicallyColumn, self,
+                                 offsets_view.get(), offset_size,
+                                 data_view.get(), associated_data_view.get(),
+                                 output_prefix_view.get(), num_threads);
           },
-          py::arg("ciphertext"), py::arg("associated_data"));
+          py::arg("offsets"), py::arg("offset_size"), py::arg("data"),
+          py::arg("associated_data"), py::arg("output_prefix"),
+          py::arg("num_threads"));
 }
 
 }  // namespace tink
@@ -18,6 +18,7 @@
 
 #include "pybind11/pybind11.h"
 #include "tink/util/statusor.h"
+#include "tink/cc/pybind/buffer_util.h"
 #include "tink/cc/pybind/status_casters.h"
 
 namespace crypto {
@@ -31,11 +32,14 @@ void PybindRegisterHybridEncrypt(pybind11::module* module) {
   py::class_<HybridEncrypt>(m, "HybridEncrypt")
       .def(
           "encrypt",
-          [](const HybridEncrypt& self, const py::bytes& plaintext,
-             const py::bytes& context_info) -> util::StatusOr<py::bytes> {
-            // TODO(b/145925674)
-            return self.Encrypt(std::string(plaintext),
-                                std::string(context_info));
+          [](const HybridEncrypt& self, const py::buffer& plaintext,
+             const py::buffer& context_info) -> util::StatusOr<py::bytes> {
+            BufferView plaintext_view(plaintext);
+            BufferView context_info_view(context_info);
+            return CallWithoutGil([&]() {
+              return self.Encrypt(plaintext_view.get(),
+                                  context_info_view.get());
+            });
           },
           py::arg("plaintext"), py::arg("context_info"));
 }
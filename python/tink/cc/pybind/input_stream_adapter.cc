@@ -17,6 +17,7 @@
 #include "tink/cc/input_stream_adapter.h"
 
 #include "pybind11/pybind11.h"
+#include "tink/cc/pybind/buffer_util.h"
 #include "tink/cc/pybind/status_casters.h"
 
 namespace crypto {
@@ -32,7 +33,10 @@ void PybindRegisterInputStreamAdapter(pybind11::module* module) {
       .def(
           "read",
           [](InputStreamAdapter *self, int64_t size)
-              -> util::StatusOr<py::bytes> { return self->Read(size); },
+              -> util::StatusOr<py::bytes> {
+            // The underlying Python file object is read with the GIL.
+            return CallWithoutGil([&]() { return self->Read(size); });
+          },
           py::arg("size"));
 }
 
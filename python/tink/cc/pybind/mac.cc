@@ -18,6 +18,7 @@
 
 #include "pybind11/pybind11.h"
 #include "tink/util/status.h"
+#include "tink/cc/pybind/buffer_util.h"
 #include "tink/cc/pybind/status_casters.h"
 
 namespace crypto {
@@ -39,19 +40,23 @@ void PybindRegisterMac(pybind11::module* module) {
       .def(
           "compute_mac",
           [](const Mac& self,
-             const py::bytes& data) -> util::StatusOr<py::bytes> {
-            // TODO(b/145925674)
-            return self.ComputeMac(std::string(data));
+             const py::buffer& data) -> util::StatusOr<py::bytes> {
+            BufferView data_view(data);
+            return CallWithoutGil(
+                [&]() { return self.ComputeMac(data_view.get()); });
           },
           py::arg("data"),
           "Computes and returns the message authentication code (MAC) for "
           "'data'.")
       .def(
           "verify_mac",
-          [](const Mac& self, const py::bytes& mac,
-             const py::bytes& data) -> util::Status {
-            // TODO(b/145925674)
-            return self.VerifyMac(std::string(mac), std::string(data));
+          [](const Mac& self, const py::buffer& mac,
+             const py::buffer& data) -> util::Status {
+            BufferView mac_view(mac);
+            BufferView data_view(data);
+            return CallWithoutGil([&]() {
+              return self.VerifyMac(mac_view.get(), data_view.get());
+            });
           },
           py::arg("mac"), py::arg("data"),
           "Verifies if 'mac' is a correct authentication code (MAC) for "
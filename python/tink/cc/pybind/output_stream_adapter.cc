@@ -17,6 +17,7 @@
 #include "tink/cc/output_stream_adapter.h"
 
 #include "pybind11/pybind11.h"
+#include "tink/cc/pybind/buffer_util.h"
 #include "tink/cc/pybind/status_casters.h"
 
 namespace crypto {
@@ -31,11 +32,15 @@ void PybindRegisterOutputStreamAdapter(pybind11::module* module) {
       .def(
           "write",
           [](OutputStreamAdapter* self,
-             const py::bytes& data) -> util::StatusOr<int64_t> {
-            return self->Write(std::string(data));
+             const py::buffer& data) -> util::StatusOr<int64_t> {
+            BufferView data_view(data);
+            // The underlying Python file object is written with the GIL.
+            return CallWithoutGil(
+                [&]() { return self->Write(data_view.get()); });
           },
           py::arg("data"))
-      .def("close", &OutputStreamAdapter::Close);
+      .def("close", &OutputStreamAdapter::Close,
+           py::call_guard<py::gil_scoped_release>());
 }
 
 }  // namespace tink
@@ -19,6 +19,7 @@
 #include "pybind11/pybind11.h"
 #include "tink/prf/prf_set.h"
 #include "tink/util/statusor.h"
+#include "tink/cc/pybind/buffer_util.h"
 #include "tink/cc/pybind/status_casters.h"
 
 namespace crypto {
@@ -33,10 +34,12 @@ void PybindRegisterPrf(pybind11::module* module) {
       // only need the function "compute_primary".
       .def(
           "compute",
-          [](const Prf& self, const py::bytes& input_data,
+          [](const Prf& self, const py::buffer& input_data,
              size_t output_length) -> util::StatusOr<py::bytes> {
-            // TODO(b/145925674)
-            return self.Compute(std::string(input_data), output_length);
+            BufferView input_data_view(input_data);
+            return CallWithoutGil([&]() {
+              return self.Compute(input_data_view.get(), output_length);
+            });
           },
           py::arg("input_data"), py::arg("output_length"),
           "Computes the value of the primary (and only) PRF.");
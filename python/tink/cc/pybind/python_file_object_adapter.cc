@@ -17,6 +17,7 @@
 #include "tink/cc/python_file_object_adapter.h"
 
 #include "pybind11/pybind11.h"
+#include "tink/cc/pybind/buffer_util.h"
 #include "tink/cc/pybind/status_casters.h"
 
 namespace crypto {
@@ -80,7 +81,7 @@ class Pybind11PythonFileObjectAdapter : public PythonFileObjectAdapter {
   util::StatusOr<int> Write(absl::string_view data) override{
       PYBIND11_OVERLOAD_PURE_STATUSOR_RETURN(
           int, PythonFileObjectAdapter, "write",
-          pybind11::bytes(std::string(data)))}
+          pybind11::bytes(data.data(), data.size()))}
 
   util::Status Close() override{
       PYBIND11_OVERLOAD_PURE_STATUS_RETURN(PythonFileObjectAdapter, "close")}
@@ -103,8 +104,9 @@ void PybindRegisterPythonFileObjectAdapter(pybind11::module* module) {
       .def(
           "write",
           [](PythonFileObjectAdapter *self,
-             const py::bytes &data) -> util::StatusOr<int> {
-            return self->Write(std::string(data));  // TODO(b/145925674)
+             const py::buffer &data) -> util::StatusOr<int> {
+            BufferView data_view(data);
+            return self->Write(data_view.get());
           },
           py::arg("data"))
       .def("close", &PythonFileObjectAdapter::Close)
@@ -17,10 +17,10 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "absl/memory/memory.h"
 #include "tink/input_stream.h"
-#include "tink/subtle/subtle_util.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "tink/cc/python_file_object_adapter.h"
@@ -41,10 +41,10 @@ PythonInputStream::PythonInputStream(
     std::shared_ptr<PythonFileObjectAdapter> adapter, int buffer_size) {
   if (buffer_size <= 0) buffer_size = 128 * 1024;  // 128 KB
   adapter_ = adapter;
+  buffer_size_ = buffer_size;
   count_in_buffer_ = 0;
   count_backedup_ = 0;
   position_ = 0;
-  subtle::ResizeStringUninitialized(&buffer_, buffer_size);
   buffer_offset_ = 0;
   status_ = util::OkStatus();
 }
@@ -62,7 +62,7 @@ util::StatusOr<int> PythonInputStream::Next(const void** data) {
   }
 
   // Read new bytes to buffer_.
-  auto read_result = adapter_->Read(buffer_.size());
+  auto read_result = adapter_->Read(buffer_size_);
   if (is_eof(read_result.status())) {
     return status_ = util::Status(util::error::OUT_OF_RANGE, "EOF");
   } else if (read_result.status().error_code() == util::error::OUT_OF_RANGE) {
@@ -73,9 +73,9 @@ util::StatusOr<int> PythonInputStream::Next(const void** data) {
   } else if (!read_result.ok()) {
     return status_ = read_result.status();
   }
-  std::string read_string = read_result.ValueOrDie();
-  int count_read = read_string.length();
-  buffer_.replace(0, count_read, read_string);
+  // Take over the string read, rather than copying it into buffer_.
+  buffer_ = std::move(read_result.ValueOrDie());
+  int count_read = buffer_.length();
   buffer_offset_ = 0;
   count_backedup_ = 0;
   count_in_buffer_ = count_read;
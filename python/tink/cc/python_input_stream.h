@@ -45,6 +45,7 @@ class PythonInputStream : public InputStream {
  private:
   util::Status status_;
   std::shared_ptr<PythonFileObjectAdapter> adapter_;
+  int buffer_size_;  // # of bytes requested from adapter_ per read
   std::string buffer_;
   int64_t position_;  // current position in the file object (from the
                       // beginning)
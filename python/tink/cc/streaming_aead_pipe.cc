@@ -0,0 +1,286 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/cc/streaming_aead_pipe.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/types/span.h"
+#include "tink/input_stream.h"
+#include "tink/output_stream.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+// Size of the chunks the encrypting stream writes its output in.
+constexpr int kOutputChunkSize = 64 * 1024;
+
+util::Status CancelledStatus() {
+  return util::Status(util::error::CANCELLED, "StreamingAeadPipe cancelled");
+}
+
+}  // namespace
+
+// Reads the chunks of the input queue of a pipe.
+class StreamingAeadPipe::QueueInputStream : public InputStream {
+ public:
+  explicit QueueInputStream(StreamingAeadPipe* pipe) : pipe_(pipe) {}
+
+  util::StatusOr<int> Next(const void** data) override {
+    if (offset_ == chunk_.size()) {
+      if (!pipe_->PopInput(&chunk_)) {
+        return util::Status(util::error::OUT_OF_RANGE, "End of input");
+      }
+      offset_ = 0;
+    }
+    *data = chunk_.data() + offset_;
+    last_count_ = chunk_.size() - offset_;
+    offset_ = chunk_.size();
+    position_ += last_count_;
+    return last_count_;
+  }
+
+  void BackUp(int count) override {
+    count = std::min(std::max(count, 0), last_count_);
+    offset_ -= count;
+    position_ -= count;
+    last_count_ -= count;
+  }
+
+  int64_t Position() const override { return position_; }
+
+ private:
+  StreamingAeadPipe* pipe_;
+  std::string chunk_;
+  size_t offset_ = 0;
+  int last_count_ = 0;
+  int64_t position_ = 0;
+};
+
+// Writes to the output queue of a pipe in chunks of kOutputChunkSize bytes.
+class StreamingAeadPipe::QueueOutputStream : public OutputStream {
+ public:
+  explicit QueueOutputStream(StreamingAeadPipe* pipe) : pipe_(pipe) {}
+
+  util::StatusOr<int> Next(void** data) override {
+    if (closed_) {
+      return util::Status(util::error::FAILED_PRECONDITION, "Stream closed");
+    }
+    util::Status status = Flush();
+    if (!status.ok()) return status;
+    buffer_.resize(kOutputChunkSize);
+    *data = &buffer_[0];
+    used_ = kOutputChunkSize;
+    position_ += kOutputChunkSize;
+    return kOutputChunkSize;
+  }
+
+  void BackUp(int count) override {
+    count = std::min(std::max(count, 0), used_);
+    used_ -= count;
+    position_ -= count;
+  }
+
+  util::Status Close() override {
+    if (closed_) return util::Status::OK;
+    closed_ = true;
+    return Flush();
+  }
+
+  int64_t Position() const override { return position_; }
+
+ private:
+  util::Status Flush() {
+    if (used_ == 0) return util::Status::OK;
+    buffer_.resize(used_);
+    used_ = 0;
+    if (!pipe_->PushOutput(std::move(buffer_))) return CancelledStatus();
+    return util::Status::OK;
+  }
+
+  StreamingAeadPipe* pipe_;
+  std::string buffer_;
+  int used_ = 0;
+  int64_t position_ = 0;
+  bool closed_ = false;
+};
+
+util::StatusOr<std::unique_ptr<StreamingAeadPipe>> StreamingAeadPipe::New(
+    StreamingAead* streaming_aead, absl::string_view associated_data,
+    Direction direction, int max_queued_chunks) {
+  if (streaming_aead == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "streaming_aead must be non-null");
+  }
+  if (max_queued_chunks <= 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "max_queued_chunks must be positive");
+  }
+  std::unique_ptr<StreamingAeadPipe> pipe(new StreamingAeadPipe(
+      streaming_aead, associated_data, direction, max_queued_chunks));
+  pipe->worker_ = std::thread(&StreamingAeadPipe::Run, pipe.get());
+  return std::move(pipe);
+}
+
+StreamingAeadPipe::StreamingAeadPipe(StreamingAead* streaming_aead,
+                                     absl::string_view associated_data,
+                                     Direction direction,
+                                     int max_queued_chunks)
+    : streaming_aead_(streaming_aead),
+      associated_data_(associated_data),
+      direction_(direction),
+      max_queued_chunks_(max_queued_chunks) {}
+
+StreamingAeadPipe::~StreamingAeadPipe() {
+  Cancel();
+  if (worker_.joinable()) worker_.join();
+}
+
+util::Status StreamingAeadPipe::Write(absl::string_view data) {
+  absl::MutexLock lock(&mutex_);
+  auto can_write = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return input_.size() < max_queued_chunks_ || input_closed_ ||
+           output_closed_ || cancelled_;
+  };
+  mutex_.Await(absl::Condition(&can_write));
+  if (cancelled_) return CancelledStatus();
+  if (input_closed_) {
+    return util::Status(util::error::FAILED_PRECONDITION, "Input closed");
+  }
+  if (output_closed_) {
+    // The worker stopped before reading all of the input.
+    if (!status_.ok()) return status_;
+    return util::Status(util::error::FAILED_PRECONDITION,
+                        "Pipe finished before the end of the input");
+  }
+  if (!data.empty()) input_.emplace_back(data);
+  return util::Status::OK;
+}
+
+util::Status StreamingAeadPipe::CloseInput() {
+  absl::MutexLock lock(&mutex_);
+  if (cancelled_) return CancelledStatus();
+  input_closed_ = true;
+  return util::Status::OK;
+}
+
+util::StatusOr<std::string> StreamingAeadPipe::Read() {
+  absl::MutexLock lock(&mutex_);
+  auto can_read = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !output_.empty() || output_closed_ || cancelled_;
+  };
+  mutex_.Await(absl::Condition(&can_read));
+  if (cancelled_) return CancelledStatus();
+  if (!output_.empty()) {
+    std::string chunk = std::move(output_.front());
+    output_.pop_front();
+    return std::move(chunk);
+  }
+  if (!status_.ok()) return status_;
+  return std::string();
+}
+
+void StreamingAeadPipe::Cancel() {
+  absl::MutexLock lock(&mutex_);
+  cancelled_ = true;
+  input_.clear();
+  output_.clear();
+}
+
+bool StreamingAeadPipe::PopInput(std::string* chunk) {
+  absl::MutexLock lock(&mutex_);
+  auto has_input = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !input_.empty() || input_closed_ || cancelled_;
+  };
+  mutex_.Await(absl::Condition(&has_input));
+  if (cancelled_ || input_.empty()) return false;
+  *chunk = std::move(input_.front());
+  input_.pop_front();
+  return true;
+}
+
+bool StreamingAeadPipe::PushOutput(std::string chunk) {
+  absl::MutexLock lock(&mutex_);
+  auto has_room = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return output_.size() < max_queued_chunks_ || cancelled_;
+  };
+  mutex_.Await(absl::Condition(&has_room));
+  if (cancelled_) return false;
+  output_.push_back(std::move(chunk));
+  return true;
+}
+
+void StreamingAeadPipe::Finish(util::Status status) {
+  absl::MutexLock lock(&mutex_);
+  status_ = std::move(status);
+  output_closed_ = true;
+}
+
+void StreamingAeadPipe::Run() {
+  Finish(direction_ == Direction::kEncrypt ? Encrypt() : Decrypt());
+}
+
+util::Status StreamingAeadPipe::Encrypt() {
+  auto encrypting_stream_result = streaming_aead_->NewEncryptingStream(
+      absl::make_unique<QueueOutputStream>(this), associated_data_);
+  if (!encrypting_stream_result.ok()) return encrypting_stream_result.status();
+  std::unique_ptr<OutputStream> encrypting_stream =
+      std::move(encrypting_stream_result.ValueOrDie());
+  std::string chunk;
+  while (PopInput(&chunk)) {
+    util::Status status = encrypting_stream->WriteFrom(absl::MakeConstSpan(
+        reinterpret_cast<const uint8_t*>(chunk.data()), chunk.size()));
+    if (!status.ok()) return status;
+  }
+  {
+    absl::MutexLock lock(&mutex_);
+    if (cancelled_) return CancelledStatus();
+  }
+  return encrypting_stream->Close();
+}
+
+util::Status StreamingAeadPipe::Decrypt() {
+  // The decrypting stream is created here rather than in New(), since some
+  // streaming AEADs read the header of the ciphertext right away.
+  auto decrypting_stream_result = streaming_aead_->NewDecryptingStream(
+      absl::make_unique<QueueInputStream>(this), associated_data_);
+  if (!decrypting_stream_result.ok()) return decrypting_stream_result.status();
+  std::unique_ptr<InputStream> decrypting_stream =
+      std::move(decrypting_stream_result.ValueOrDie());
+  while (true) {
+    const void* data;
+    auto next_result = decrypting_stream->Next(&data);
+    if (!next_result.ok()) {
+      if (next_result.status().error_code() == util::error::OUT_OF_RANGE) {
+        return util::Status::OK;
+      }
+      return next_result.status();
+    }
+    int count = next_result.ValueOrDie();
+    if (count > 0 &&
+        !PushOutput(std::string(static_cast<const char*>(data), count))) {
+      return CancelledStatus();
+    }
+  }
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,124 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_PYTHON_CC_STREAMING_AEAD_PIPE_H_
+#define TINK_PYTHON_CC_STREAMING_AEAD_PIPE_H_
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "tink/streaming_aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+// Encrypts or decrypts a stream on a worker thread of its own.
+//
+// The PythonInputStream and PythonOutputStream used by NewCcEncryptingStream
+// and NewCcDecryptingStream call back into Python for every chunk, so all
+// the segment crypto runs while the GIL is held, and blocks an asyncio event
+// loop. A StreamingAeadPipe instead takes the input through Write() and
+// returns the output through Read(), and runs the encrypting or decrypting
+// stream on a worker thread in between. The input and the output are kept
+// in bounded queues of chunks: Write() blocks while the input queue is full
+// and Read() blocks while the output queue is empty, which bounds the memory
+// of the pipe and lets it run at the speed of the slower side. None of the
+// methods touch Python objects, so the bindings call them without the GIL.
+//
+// Write() and CloseInput() are meant to be called from one thread and Read()
+// from another one, or interleaved from a single thread as long as Read() is
+// only called when the worker can make progress.
+class StreamingAeadPipe {
+ public:
+  enum class Direction { kEncrypt, kDecrypt };
+
+  // Default number of chunks each of the two queues holds at most.
+  static constexpr int kDefaultMaxQueuedChunks = 16;
+
+  // Creates a pipe which encrypts or decrypts with 'streaming_aead' and
+  // 'associated_data', and starts its worker thread. 'streaming_aead' is
+  // borrowed and must outlive the pipe.
+  static util::StatusOr<std::unique_ptr<StreamingAeadPipe>> New(
+      StreamingAead* streaming_aead, absl::string_view associated_data,
+      Direction direction, int max_queued_chunks = kDefaultMaxQueuedChunks);
+
+  StreamingAeadPipe(const StreamingAeadPipe&) = delete;
+  StreamingAeadPipe& operator=(const StreamingAeadPipe&) = delete;
+
+  // Cancels the pipe and waits for the worker thread to finish.
+  ~StreamingAeadPipe();
+
+  // Appends 'data' to the input, blocking while the input queue is full.
+  // Fails if the input was closed, or the pipe failed or was cancelled.
+  util::Status Write(absl::string_view data);
+
+  // Marks the end of the input.
+  util::Status CloseInput();
+
+  // Returns the next chunk of the output, blocking until one is available.
+  // Returns an empty string at the end of the output, and the error of the
+  // worker if encryption or decryption failed.
+  util::StatusOr<std::string> Read();
+
+  // Makes pending and future calls of Write() and Read() fail, and stops
+  // the worker thread as soon as possible.
+  void Cancel();
+
+ private:
+  class QueueInputStream;
+  class QueueOutputStream;
+
+  StreamingAeadPipe(StreamingAead* streaming_aead,
+                    absl::string_view associated_data, Direction direction,
+                    int max_queued_chunks);
+
+  void Run();
+  util::Status Encrypt();
+  util::Status Decrypt();
+
+  // Used by the streams of the worker thread. PopInput() returns false at
+  // the end of the input, and PushOutput() returns false when cancelled.
+  bool PopInput(std::string* chunk) ABSL_LOCKS_EXCLUDED(mutex_);
+  bool PushOutput(std::string chunk) ABSL_LOCKS_EXCLUDED(mutex_);
+  void Finish(util::Status status) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  StreamingAead* const streaming_aead_;
+  const std::string associated_data_;
+  const Direction direction_;
+  const size_t max_queued_chunks_;
+
+  absl::Mutex mutex_;
+  std::deque<std::string> input_ ABSL_GUARDED_BY(mutex_);
+  std::deque<std::string> output_ ABSL_GUARDED_BY(mutex_);
+  bool input_closed_ ABSL_GUARDED_BY(mutex_) = false;
+  bool output_closed_ ABSL_GUARDED_BY(mutex_) = false;
+  bool cancelled_ ABSL_GUARDED_BY(mutex_) = false;
+  util::Status status_ ABSL_GUARDED_BY(mutex_);
+
+  std::thread worker_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_PYTHON_CC_STREAMING_AEAD_PIPE_H_
@@ -0,0 +1,153 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/cc/streaming_aead_pipe.h"
+
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "tink/cc/test_util.h"
+#include "tink/subtle/random.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::test::DummyStreamingAead;
+
+// Writes 'chunks' to 'pipe' on another thread, and returns all it reads.
+std::string RunPipe(StreamingAeadPipe* pipe,
+                    const std::vector<std::string>& chunks,
+                    util::Status* read_status) {
+  std::thread writer([pipe, &chunks]() {
+    for (const std::string& chunk : chunks) {
+      if (!pipe->Write(chunk).ok()) return;
+    }
+    pipe->CloseInput();
+  });
+  std::string output;
+  *read_status = util::Status::OK;
+  while (true) {
+    auto read_result = pipe->Read();
+    if (!read_result.ok()) {
+      *read_status = read_result.status();
+      pipe->Cancel();
+      break;
+    }
+    if (read_result.ValueOrDie().empty()) break;
+    output += read_result.ValueOrDie();
+  }
+  writer.join();
+  return output;
+}
+
+std::unique_ptr<StreamingAeadPipe> NewPipe(
+    StreamingAead* streaming_aead, StreamingAeadPipe::Direction direction,
+    int max_queued_chunks = StreamingAeadPipe::kDefaultMaxQueuedChunks) {
+  auto pipe_result = StreamingAeadPipe::New(streaming_aead, "associated data",
+                                            direction, max_queued_chunks);
+  EXPECT_TRUE(pipe_result.ok()) << pipe_result.status();
+  return std::move(pipe_result.ValueOrDie());
+}
+
+TEST(StreamingAeadPipeTest, EncryptAndDecrypt) {
+  DummyStreamingAead streaming_aead("Some streaming AEAD");
+  std::string plaintext = subtle::Random::GetRandomBytes(300 * 1024);
+  std::vector<std::string> plaintext_chunks;
+  for (size_t i = 0; i < plaintext.size(); i += 1000) {
+    plaintext_chunks.push_back(plaintext.substr(i, 1000));
+  }
+
+  // Few queued chunks, so that both sides block on the queues.
+  auto encrypting_pipe =
+      NewPipe(&streaming_aead, StreamingAeadPipe::Direction::kEncrypt, 2);
+  util::Status status;
+  std::string ciphertext =
+      RunPipe(encrypting_pipe.get(), plaintext_chunks, &status);
+  ASSERT_TRUE(status.ok()) << status;
+  EXPECT_EQ(absl::StrCat("Some streaming AEADassociated data", plaintext),
+            ciphertext);
+
+  std::vector<std::string> ciphertext_chunks;
+  for (size_t i = 0; i < ciphertext.size(); i += 70000) {
+    ciphertext_chunks.push_back(ciphertext.substr(i, 70000));
+  }
+  auto decrypting_pipe =
+      NewPipe(&streaming_aead, StreamingAeadPipe::Direction::kDecrypt, 2);
+  EXPECT_EQ(plaintext,
+            RunPipe(decrypting_pipe.get(), ciphertext_chunks, &status));
+  EXPECT_TRUE(status.ok()) << status;
+}
+
+TEST(StreamingAeadPipeTest, EmptyPlaintext) {
+  DummyStreamingAead streaming_aead("Some streaming AEAD");
+  auto pipe = NewPipe(&streaming_aead, StreamingAeadPipe::Direction::kEncrypt);
+  util::Status status;
+  EXPECT_EQ("Some streaming AEADassociated data",
+            RunPipe(pipe.get(), {}, &status));
+  EXPECT_TRUE(status.ok()) << status;
+}
+
+TEST(StreamingAeadPipeTest, DecryptionFailure) {
+  DummyStreamingAead streaming_aead("Some streaming AEAD");
+  auto pipe = NewPipe(&streaming_aead, StreamingAeadPipe::Direction::kDecrypt);
+  ASSERT_TRUE(pipe->Write(std::string(100, 'x')).ok());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, pipe->Read().status().error_code());
+
+  // Writes after the failure report it as well.
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, pipe->Write("more").error_code());
+}
+
+TEST(StreamingAeadPipeTest, WriteAfterCloseInput) {
+  DummyStreamingAead streaming_aead("Some streaming AEAD");
+  auto pipe = NewPipe(&streaming_aead, StreamingAeadPipe::Direction::kEncrypt);
+  ASSERT_TRUE(pipe->CloseInput().ok());
+  EXPECT_EQ(util::error::FAILED_PRECONDITION,
+            pipe->Write("data").error_code());
+}
+
+TEST(StreamingAeadPipeTest, CancelUnblocksAndStopsTheWorker) {
+  DummyStreamingAead streaming_aead("Some streaming AEAD");
+  auto pipe =
+      NewPipe(&streaming_aead, StreamingAeadPipe::Direction::kEncrypt, 1);
+  std::thread reader([&pipe]() {
+    // Blocks, since the input is never closed.
+    EXPECT_EQ(util::error::CANCELLED, pipe->Read().status().error_code());
+  });
+  ASSERT_TRUE(pipe->Write(std::string(200 * 1024, 'a')).ok());
+  pipe->Cancel();
+  reader.join();
+  EXPECT_EQ(util::error::CANCELLED, pipe->Write("data").error_code());
+  // Destroying the pipe joins the worker.
+  pipe.reset();
+}
+
+TEST(StreamingAeadPipeTest, InvalidArguments) {
+  DummyStreamingAead streaming_aead("Some streaming AEAD");
+  EXPECT_FALSE(StreamingAeadPipe::New(nullptr, "",
+                                      StreamingAeadPipe::Direction::kEncrypt)
+                   .ok());
+  EXPECT_FALSE(StreamingAeadPipe::New(&streaming_aead, "",
+                                      StreamingAeadPipe::Direction::kEncrypt, 0)
+                   .ok());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
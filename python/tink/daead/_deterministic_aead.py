@@ -20,11 +20,34 @@ from __future__ import division
 from __future__ import print_function
 
 import abc
+import array
+from typing import List, Sequence, Tuple
 
 # Special imports
 import six
 
 
+def split_column(offsets: bytes, offset_size: int, data: bytes) -> List[bytes]:
+  """Returns the values of a column in the layout of an Arrow binary array."""
+  if offset_size not in (4, 8):
+    raise ValueError('offset_size must be 4 or 8')
+  offset_values = array.array('i' if offset_size == 4 else 'q')
+  offset_values.frombytes(bytes(offsets))
+  data = memoryview(data)
+  return [
+      bytes(data[offset_values[i]:offset_values[i + 1]])
+      for i in range(len(offset_values) - 1)
+  ]
+
+
+def join_column(values: Sequence[bytes]) -> Tuple[bytes, bytes]:
+  """Returns the 64-bit offsets and the data of a column of values."""
+  offsets = array.array('q', [0])
+  for value in values:
+    offsets.append(offsets[-1] + len(value))
+  return offsets.tobytes(), b''.join(values)
+
+
 @six.add_metaclass(abc.ABCMeta)
 class DeterministicAead(object):
   """Interface for Deterministic Authenticated Encryption with Associated Data.
@@ -59,3 +82,73 @@ class DeterministicAead(object):
   def decrypt_deterministically(self, ciphertext: bytes,
                                 associated_data: bytes) -> bytes:
     raise NotImplementedError()
+
+  def encrypt_deterministically_batch(self, plaintexts: Sequence[bytes],
+                                      associated_data: bytes) -> List[bytes]:
+    """Encrypts each of plaintexts with associated_data.
+
+    Primitives backed by C++ encrypt all values in a single call, on several
+    threads and without holding the GIL. Either all values are encrypted or
+    TinkError is raised.
+
+    Args:
+      plaintexts: The values to encrypt.
+      associated_data: The associated data of all values.
+
+    Returns:
+      The ciphertexts, in the order of plaintexts.
+    """
+    return [
+        self.encrypt_deterministically(plaintext, associated_data)
+        for plaintext in plaintexts
+    ]
+
+  def decrypt_deterministically_batch(self, ciphertexts: Sequence[bytes],
+                                      associated_data: bytes) -> List[bytes]:
+    """Decrypts each of ciphertexts with associated_data.
+
+    Like encrypt_deterministically_batch(), either all values are decrypted
+    or TinkError is raised.
+    """
+    return [
+        self.decrypt_deterministically(ciphertext, associated_data)
+        for ciphertext in ciphertexts
+    ]
+
+  def encrypt_deterministically_column(
+      self, offsets: bytes, offset_size: int, data: bytes,
+      associated_data: bytes) -> Tuple[bytes, bytes]:
+    """Encrypts a column in the layout of an Arrow binary array.
+
+    This avoids converting Arrow columns into Python objects. For a pyarrow
+    array `a` of type binary (offset_size 4) or large_binary (offset_size 8)
+    without offset, pass the buffers `a.buffers()[1]` and `a.buffers()[2]`,
+    and build the result with
+    `pa.Array.from_buffers(pa.large_binary(), len(a), [a.buffers()[0],
+    pa.py_buffer(offsets), pa.py_buffer(data)])`.
+
+    Args:
+      offsets: The n + 1 offsets of the n values into data, as native 32-bit
+        or 64-bit integers.
+      offset_size: The size of each offset in bytes, 4 or 8.
+      data: The values.
+      associated_data: The associated data of all values.
+
+    Returns:
+      The 64-bit offsets and the data of the ciphertexts.
+    """
+    return join_column(
+        self.encrypt_deterministically_batch(
+            split_column(offsets, offset_size, data), associated_data))
+
+  def decrypt_deterministically_column(
+      self, offsets: bytes, offset_size: int, data: bytes,
+      associated_data: bytes) -> Tuple[bytes, bytes]:
+    """Decrypts a column in the layout of encrypt_deterministically_column().
+
+    Returns:
+      The 64-bit offsets and the data of the plaintexts.
+    """
+    return join_column(
+        self.decrypt_deterministically_batch(
+            split_column(offsets, offset_size, data), associated_data))
@@ -19,6 +19,8 @@ from __future__ import division
 # Placeholder for import for type annotations
 from __future__ import print_function
 
+from typing import List, Sequence, Tuple
+
 from tink import core
 from tink.cc.pybind import tink_bindings
 from tink.daead import _deterministic_aead
@@ -43,6 +45,60 @@ class _DeterministicAeadCcToPyWrapper(_deterministic_aead.DeterministicAead):
     return self._deterministic_aead.decrypt_deterministically(
         ciphertext, associated_data)
 
+  def encrypt_deterministically_batch(self, plaintexts: Sequence[bytes],
+                                      associated_data: bytes) -> List[bytes]:
+    return self.encrypt_deterministically_batch_with_prefix(
+        plaintexts, associated_data, b'')
+
+  def decrypt_deterministically_batch(self, ciphertexts: Sequence[bytes],
+                                      associated_data: bytes) -> List[bytes]:
+    return self.decrypt_deterministically_batch_with_prefix(
+        ciphertexts, associated_data, b'')
+
+  def encrypt_deterministically_column(
+      self, offsets: bytes, offset_size: int, data: bytes,
+      associated_data: bytes) -> Tuple[bytes, bytes]:
+    return self.encrypt_deterministically_column_with_prefix(
+        offsets, offset_size, data, associated_data, b'')
+
+  def decrypt_deterministically_column(
+      self, offsets: bytes, offset_size: int, data: bytes,
+      associated_data: bytes) -> Tuple[bytes, bytes]:
+    return self.decrypt_deterministically_column_with_prefix(
+        offsets, offset_size, data, associated_data, b'')
+
+  # The methods below are used by the keyset wrapper. They prepend
+  # output_prefix to every ciphertext on encryption, and strip it on
+  # decryption, and use all cores (num_threads=0).
+
+  @core.use_tink_errors
+  def encrypt_deterministically_batch_with_prefix(
+      self, plaintexts: Sequence[bytes], associated_data: bytes,
+      output_prefix: bytes) -> List[bytes]:
+    return self._deterministic_aead.encrypt_deterministically_batch(
+        list(plaintexts), associated_data, output_prefix, 0)
+
+  @core.use_tink_errors
+  def decrypt_deterministically_batch_with_prefix(
+      self, ciphertexts: Sequence[bytes], associated_data: bytes,
+      output_prefix: bytes) -> List[bytes]:
+    return self._deterministic_aead.decrypt_deterministically_batch(
+        list(ciphertexts), associated_data, output_prefix, 0)
+
+  @core.use_tink_errors
+  def encrypt_deterministically_column_with_prefix(
+      self, offsets: bytes, offset_size: int, data: bytes,
+      associated_data: bytes, output_prefix: bytes) -> Tuple[bytes, bytes]:
+    return self._deterministic_aead.encrypt_deterministically_column(
+        offsets, offset_size, data, associated_data, output_prefix, 0)
+
+  @core.use_tink_errors
+  def decrypt_deterministically_column_with_prefix(
+      self, offsets: bytes, offset_size: int, data: bytes,
+      associated_data: bytes, output_prefix: bytes) -> Tuple[bytes, bytes]:
+    return self._deterministic_aead.decrypt_deterministically_column(
+        offsets, offset_size, data, associated_data, output_prefix, 0)
+
 
 def register():
   """Registers all Hybrid key managers and wrapper in the Python Registry."""
@@ -19,7 +19,7 @@ from __future__ import division
 # Placeholder for import for type annotations
 from __future__ import print_function
 
-from typing import Type
+from typing import List, Sequence, Tuple, Type
 from absl import logging
 
 from tink import core
@@ -60,6 +60,69 @@ class _WrappedDeterministicAead(_deterministic_aead.DeterministicAead):
     # nothing works.
     raise core.TinkError('Decryption failed.')
 
+  # The batch methods use the primary key in a single call to C++ where they
+  # can. Decryption falls back to decrypting value by value if some values
+  # were not encrypted with the primary key.
+
+  def encrypt_deterministically_batch(self, plaintexts: Sequence[bytes],
+                                      associated_data: bytes) -> List[bytes]:
+    primary = self._primitive_set.primary()
+    with_prefix = getattr(primary.primitive,
+                          'encrypt_deterministically_batch_with_prefix', None)
+    if with_prefix is not None:
+      return with_prefix(plaintexts, associated_data, primary.identifier)
+    return [
+        primary.identifier + ciphertext
+        for ciphertext in primary.primitive.encrypt_deterministically_batch(
+            plaintexts, associated_data)
+    ]
+
+  def decrypt_deterministically_batch(self, ciphertexts: Sequence[bytes],
+                                      associated_data: bytes) -> List[bytes]:
+    primary = self._primitive_set.primary()
+    with_prefix = getattr(primary.primitive,
+                          'decrypt_deterministically_batch_with_prefix', None)
+    if with_prefix is not None:
+      try:
+        return with_prefix(ciphertexts, associated_data, primary.identifier)
+      except core.TinkError:
+        pass
+    return [
+        self.decrypt_deterministically(ciphertext, associated_data)
+        for ciphertext in ciphertexts
+    ]
+
+  def encrypt_deterministically_column(
+      self, offsets: bytes, offset_size: int, data: bytes,
+      associated_data: bytes) -> Tuple[bytes, bytes]:
+    primary = self._primitive_set.primary()
+    with_prefix = getattr(primary.primitive,
+                          'encrypt_deterministically_column_with_prefix', None)
+    if with_prefix is not None:
+      return with_prefix(offsets, offset_size, data, associated_data,
+                         primary.identifier)
+    return super(_WrappedDeterministicAead,
+                 self).encrypt_deterministically_column(
+                     offsets, offset_size, data, associated_data)
+
+  def decrypt_deterministically_column(
+      self, offsets: bytes, offset_size: int, data: bytes,
+      associated_data: bytes) -> Tuple[bytes, bytes]:
+    primary = self._primitive_set.primary()
+    with_prefix = getattr(primary.primitive,
+                          'decrypt_deterministically_column_with_prefix', None)
+    if with_prefix is not None:
+      try:
+        return with_prefix(offsets, offset_size, data, associated_data,
+                           primary.identifier)
+      except core.TinkError:
+        pass
+    return _deterministic_aead.join_column([
+        self.decrypt_deterministically(ciphertext, associated_data)
+        for ciphertext in _deterministic_aead.split_column(
+            offsets, offset_size, data)
+    ])
+
 
 class DeterministicAeadWrapper(
     core.PrimitiveWrapper[_deterministic_aead.DeterministicAead,
@@ -19,6 +19,8 @@ from __future__ import division
 # Placeholder for import for type annotations
 from __future__ import print_function
 
+import array
+
 from absl.testing import absltest
 from absl.testing import parameterized
 import tink
@@ -138,6 +140,68 @@ class AeadWrapperTest(parameterized.TestCase):
     self.assertEqual(p4.decrypt_deterministically(ciphertext4, b'ad'),
                      b'plaintext')
 
+  @parameterized.parameters([DAEAD_TEMPLATE, RAW_DAEAD_TEMPLATE])
+  def test_encrypt_decrypt_batch(self, template):
+    primitive = tink.new_keyset_handle(template).primitive(
+        daead.DeterministicAead)
+    plaintexts = [b'value %d' % i for i in range(5000)] + [b'']
+    ciphertexts = primitive.encrypt_deterministically_batch(plaintexts, b'ad')
+    self.assertLen(ciphertexts, len(plaintexts))
+    for i in (0, 1234, 5000):
+      self.assertEqual(
+          ciphertexts[i],
+          primitive.encrypt_deterministically(plaintexts[i], b'ad'))
+    self.assertEqual(
+        primitive.decrypt_deterministically_batch(ciphertexts, b'ad'),
+        plaintexts)
+    with self.assertRaises(tink.TinkError):
+      primitive.decrypt_deterministically_batch(ciphertexts, b'other ad')
+
+  @parameterized.parameters([4, 8])
+  def test_encrypt_decrypt_column(self, offset_size):
+    primitive = tink.new_keyset_handle(DAEAD_TEMPLATE).primitive(
+        daead.DeterministicAead)
+    plaintexts = [b'value %d' % i for i in range(3000)]
+    offsets = array.array('i' if offset_size == 4 else 'q', [0])
+    for plaintext in plaintexts:
+      offsets.append(offsets[-1] + len(plaintext))
+
+    ciphertext_offsets, ciphertext_data = (
+        primitive.encrypt_deterministically_column(
+            offsets.tobytes(), offset_size, b''.join(plaintexts), b'ad'))
+    ciphertext_offset_values = array.array('q')
+    ciphertext_offset_values.frombytes(ciphertext_offsets)
+    self.assertLen(ciphertext_offset_values, len(plaintexts) + 1)
+    begin, end = ciphertext_offset_values[7], ciphertext_offset_values[8]
+    self.assertEqual(ciphertext_data[begin:end],
+                     primitive.encrypt_deterministically(plaintexts[7], b'ad'))
+
+    plaintext_offsets, plaintext_data = (
+        primitive.decrypt_deterministically_column(
+            ciphertext_offsets, 8, ciphertext_data, b'ad'))
+    self.assertEqual(plaintext_data, b''.join(plaintexts))
+    self.assertEqual(plaintext_offsets,
+                     array.array('q', offsets).tobytes())
+
+  def test_decrypt_batch_with_key_rotation(self):
+    builder = keyset_builder.new_keyset_builder()
+    older_key_id = builder.add_new_key(DAEAD_TEMPLATE)
+    builder.set_primary_key(older_key_id)
+    p1 = builder.keyset_handle().primitive(daead.DeterministicAead)
+    newer_key_id = builder.add_new_key(DAEAD_TEMPLATE)
+    builder.set_primary_key(newer_key_id)
+    p2 = builder.keyset_handle().primitive(daead.DeterministicAead)
+
+    # Values of the older key are decrypted one by one.
+    ciphertexts = (
+        p1.encrypt_deterministically_batch([b'a', b'b'], b'ad') +
+        p2.encrypt_deterministically_batch([b'c'], b'ad'))
+    self.assertEqual(
+        p2.decrypt_deterministically_batch(ciphertexts, b'ad'),
+        [b'a', b'b', b'c'])
+    with self.assertRaises(tink.TinkError):
+      p1.decrypt_deterministically_batch(ciphertexts, b'ad')
+
 
 if __name__ == '__main__':
   absltest.main()
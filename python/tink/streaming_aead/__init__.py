@@ -16,6 +16,7 @@ from __future__ import division
 # Placeholder for import for type annotations
 from __future__ import print_function
 
+from tink.streaming_aead import _async_streams
 from tink.streaming_aead import _streaming_aead
 from tink.streaming_aead import _streaming_aead_key_manager
 from tink.streaming_aead import _streaming_aead_key_templates as streaming_aead_key_templates
@@ -23,3 +24,5 @@ from tink.streaming_aead import _streaming_aead_key_templates as streaming_aead_
 
 StreamingAead = _streaming_aead.StreamingAead
 register = _streaming_aead_key_manager.register
+encrypt_async = _async_streams.encrypt
+decrypt_async = _async_streams.decrypt
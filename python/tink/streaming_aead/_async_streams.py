@@ -0,0 +1,193 @@
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Streaming encryption and decryption for asyncio.
+
+The file-like streams of StreamingAead call back into Python for every chunk,
+and run all of the segment crypto on the calling thread while holding the GIL.
+The functions in this module instead run the crypto on a C++ worker thread per
+stream, which exchanges the data with Python through two bounded queues of
+chunks. The event loop only waits for these queues, in its default executor
+and without the GIL, so it keeps serving other tasks while a large stream is
+encrypted or decrypted.
+"""
+
+from __future__ import absolute_import
+from __future__ import division
+# Placeholder for import for type annotations
+from __future__ import print_function
+
+import asyncio
+from typing import AsyncIterable, AsyncIterator, List, Optional
+
+from tink import core
+from tink.streaming_aead import _streaming_aead
+from tink.streaming_aead import _streaming_aead_wrapper
+
+
+class _RewindableChunks(object):
+  """Reads chunks of an async iterable, and can replay the ones it has read."""
+
+  def __init__(self, chunks: AsyncIterable[bytes]):
+    self._iterator = chunks.__aiter__()
+    self._read_chunks = []  # type: List[bytes]
+    self._position = 0
+    self._rewindable = True
+
+  async def next(self) -> Optional[bytes]:
+    """Returns the next chunk, or None at the end."""
+    if self._position < len(self._read_chunks):
+      chunk = self._read_chunks[self._position]
+      self._position += 1
+      return chunk
+    try:
+      chunk = bytes(await self._iterator.__anext__())
+    except StopAsyncIteration:
+      return None
+    if self._rewindable:
+      self._read_chunks.append(chunk)
+      self._position += 1
+    return chunk
+
+  def rewind(self) -> None:
+    if not self._rewindable:
+      raise core.TinkError('chunks can no longer be rewound')
+    self._position = 0
+
+  def disable_rewind(self) -> None:
+    """Drops the chunks read so far, and stops keeping the future ones."""
+    self._rewindable = False
+    self._read_chunks = self._read_chunks[self._position:]
+    self._position = 0
+
+
+async def _feed(pipe, chunks: _RewindableChunks) -> None:
+  """Writes all chunks to pipe, then closes its input."""
+  loop = asyncio.get_event_loop()
+  try:
+    while True:
+      chunk = await chunks.next()
+      if chunk is None:
+        break
+      await loop.run_in_executor(None, core.use_tink_errors(pipe.write), chunk)
+    pipe.close_input()
+  except core.TinkError:
+    # The pipe failed or was cancelled. read() reports it.
+    pass
+  except BaseException:
+    # Reading the chunks failed. Make read() fail, and let the reader raise
+    # this exception instead.
+    pipe.cancel()
+    raise
+
+
+async def _read(pipe, feeder: asyncio.Future) -> Optional[bytes]:
+  """Returns the next chunk of the output of pipe, or None at the end."""
+  loop = asyncio.get_event_loop()
+  try:
+    chunk = await loop.run_in_executor(None, core.use_tink_errors(pipe.read))
+  except core.TinkError:
+    if feeder.done() and not feeder.cancelled() and feeder.exception():
+      raise feeder.exception()  # pylint: disable=raising-bad-type
+    raise
+  return chunk if chunk else None
+
+
+async def _stop(pipe, feeder: asyncio.Future) -> None:
+  """Cancels pipe, and waits for feeder to return."""
+  pipe.cancel()
+  try:
+    await feeder
+  except BaseException:  # pylint: disable=broad-except
+    pass
+
+
+async def encrypt(primitive: _streaming_aead.StreamingAead,
+                  plaintext: AsyncIterable[bytes],
+                  associated_data: bytes) -> AsyncIterator[bytes]:
+  """Encrypts plaintext with the primary key of primitive.
+
+  The crypto runs on a C++ worker thread, so that the event loop is not
+  blocked while a large plaintext is encrypted.
+
+  Args:
+    primitive: A StreamingAead from a keyset handle.
+    plaintext: The chunks of the plaintext.
+    associated_data: The associated data to use for encryption. This must match
+      the associated_data used for decryption.
+
+  Yields:
+    The chunks of the ciphertext. They are only complete once the iteration
+    ends.
+
+  Raises:
+    TinkError if encryption fails, or the exception raised by plaintext.
+  """
+  primary = _streaming_aead_wrapper.raw_primitives(primitive)[0]
+  pipe = primary.new_cc_pipe(associated_data, encrypt=True)
+  feeder = asyncio.ensure_future(_feed(pipe, _RewindableChunks(plaintext)))
+  try:
+    while True:
+      chunk = await _read(pipe, feeder)
+      if chunk is None:
+        break
+      yield chunk
+  finally:
+    await _stop(pipe, feeder)
+
+
+async def decrypt(primitive: _streaming_aead.StreamingAead,
+                  ciphertext: AsyncIterable[bytes],
+                  associated_data: bytes) -> AsyncIterator[bytes]:
+  """Decrypts ciphertext with the matching key of primitive.
+
+  Like the decrypting streams of StreamingAead, it tries the keys one after
+  the other until one of them decrypts the first plaintext bytes, keeping the
+  ciphertext chunks read until then to try the next key with them. The crypto
+  runs on a C++ worker thread, so that the event loop is not blocked while a
+  large ciphertext is decrypted.
+
+  Args:
+    primitive: A StreamingAead from a keyset handle.
+    ciphertext: The chunks of the ciphertext.
+    associated_data: The associated data to use for decryption.
+
+  Yields:
+    The chunks of the plaintext. As with the decrypting streams, the plaintext
+    is only known to be complete once the iteration ends without error.
+
+  Raises:
+    TinkError if decryption fails, or the exception raised by ciphertext.
+  """
+  remaining_primitives = _streaming_aead_wrapper.raw_primitives(primitive)
+  chunks = _RewindableChunks(ciphertext)
+  while True:
+    pipe = remaining_primitives.pop(0).new_cc_pipe(
+        associated_data, encrypt=False)
+    feeder = asyncio.ensure_future(_feed(pipe, chunks))
+    try:
+      try:
+        chunk = await _read(pipe, feeder)
+      except core.TinkError:
+        if not remaining_primitives:
+          raise core.TinkError(
+              'No matching key found for the ciphertext in the stream')
+        # Try the next key, once the feeder stopped using the chunks.
+        await _stop(pipe, feeder)
+        chunks.rewind()
+        continue
+      chunks.disable_rewind()
+      while chunk is not None:
+        yield chunk
+        chunk = await _read(pipe, feeder)
+      return
+    finally:
+      await _stop(pipe, feeder)
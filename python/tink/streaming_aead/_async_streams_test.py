@@ -0,0 +1,127 @@
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Tests for tink.python.tink.streaming_aead._async_streams."""
+
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+
+import asyncio
+import io
+from typing import AsyncIterator, List
+
+from absl.testing import absltest
+import tink
+from tink import streaming_aead
+from tink.testing import bytes_io
+from tink.testing import keyset_builder
+
+
+TEMPLATE = streaming_aead.streaming_aead_key_templates.AES128_GCM_HKDF_4KB
+
+
+def setUpModule():
+  streaming_aead.register()
+
+
+async def _chunks(data: bytes, chunk_size: int) -> AsyncIterator[bytes]:
+  for i in range(0, len(data), chunk_size):
+    await asyncio.sleep(0)
+    yield data[i:i + chunk_size]
+
+
+async def _join(chunks: AsyncIterator[bytes]) -> bytes:
+  output = []  # type: List[bytes]
+  async for chunk in chunks:
+    output.append(chunk)
+  return b''.join(output)
+
+
+def _encrypt(primitive: streaming_aead.StreamingAead, plaintext: bytes,
+             associated_data: bytes) -> bytes:
+  ciphertext_dest = bytes_io.BytesIOWithValueAfterClose()
+  with primitive.new_encrypting_stream(ciphertext_dest, associated_data) as es:
+    es.write(plaintext)
+  return ciphertext_dest.value_after_close()
+
+
+class AsyncStreamsTest(absltest.TestCase):
+
+  def test_encrypt_decrypt(self):
+    primitive = tink.new_keyset_handle(TEMPLATE).primitive(
+        streaming_aead.StreamingAead)
+    plaintext = b' '.join(b'%d' % i for i in range(100 * 1000))
+
+    ciphertext = asyncio.run(
+        _join(streaming_aead.encrypt_async(primitive, _chunks(plaintext, 1000),
+                                           b'aad')))
+    with primitive.new_decrypting_stream(io.BytesIO(ciphertext), b'aad') as ds:
+      self.assertEqual(ds.read(), plaintext)
+
+    output = asyncio.run(
+        _join(streaming_aead.decrypt_async(
+            primitive, _chunks(ciphertext, 3000), b'aad')))
+    self.assertEqual(output, plaintext)
+
+  def test_empty_plaintext(self):
+    primitive = tink.new_keyset_handle(TEMPLATE).primitive(
+        streaming_aead.StreamingAead)
+    ciphertext = asyncio.run(
+        _join(streaming_aead.encrypt_async(primitive, _chunks(b'', 1), b'aad')))
+    self.assertEqual(
+        asyncio.run(
+            _join(streaming_aead.decrypt_async(
+                primitive, _chunks(ciphertext, 10), b'aad'))), b'')
+
+  def test_decrypt_with_wrong_associated_data_fails(self):
+    primitive = tink.new_keyset_handle(TEMPLATE).primitive(
+        streaming_aead.StreamingAead)
+    ciphertext = _encrypt(primitive, b'plaintext', b'aad')
+    with self.assertRaises(tink.TinkError):
+      asyncio.run(
+          _join(streaming_aead.decrypt_async(
+              primitive, _chunks(ciphertext, 10), b'other aad')))
+
+  def test_decrypt_with_key_rotation(self):
+    builder = keyset_builder.new_keyset_builder()
+    older_key_id = builder.add_new_key(TEMPLATE)
+    builder.set_primary_key(older_key_id)
+    p1 = builder.keyset_handle().primitive(streaming_aead.StreamingAead)
+    newer_key_id = builder.add_new_key(TEMPLATE)
+    builder.set_primary_key(newer_key_id)
+    p2 = builder.keyset_handle().primitive(streaming_aead.StreamingAead)
+
+    # p2 tries its primary key first, and then the older key with the
+    # ciphertext chunks it has read so far.
+    plaintext = b' '.join(b'%d' % i for i in range(10 * 1000))
+    ciphertext = _encrypt(p1, plaintext, b'aad')
+    self.assertEqual(
+        asyncio.run(
+            _join(streaming_aead.decrypt_async(p2, _chunks(ciphertext, 7),
+                                               b'aad'))), plaintext)
+
+  def test_exception_of_the_input_is_raised(self):
+    primitive = tink.new_keyset_handle(TEMPLATE).primitive(
+        streaming_aead.StreamingAead)
+
+    async def failing_chunks() -> AsyncIterator[bytes]:
+      yield b'some data'
+      raise ValueError('input failed')
+
+    with self.assertRaisesRegex(ValueError, 'input failed'):
+      asyncio.run(
+          _join(streaming_aead.encrypt_async(primitive, failing_chunks(),
+                                             b'aad')))
+
+
+if __name__ == '__main__':
+  absltest.main()
@@ -52,10 +52,18 @@ class RawDecryptingStream(io.RawIOBase):
     self._close_ciphertext_source = close_ciphertext_source
     if not ciphertext_source.readable():
       raise ValueError('ciphertext_source must be readable')
-    cc_ciphertext_source = file_object_adapter.FileObjectAdapter(
-        ciphertext_source)
-    self._input_stream_adapter = self._get_input_stream_adapter(
-        stream_aead, associated_data, cc_ciphertext_source)
+    # Real files are read by C++ directly, through a duplicate of their file
+    # descriptor, without calling back into Python for every chunk.
+    source_fd = file_object_adapter.native_file_descriptor(
+        ciphertext_source, for_writing=False)
+    if source_fd is not None:
+      self._input_stream_adapter = self._get_input_stream_adapter_from_fd(
+          stream_aead, associated_data, source_fd)
+    else:
+      cc_ciphertext_source = file_object_adapter.FileObjectAdapter(
+          ciphertext_source)
+      self._input_stream_adapter = self._get_input_stream_adapter(
+          stream_aead, associated_data, cc_ciphertext_source)
 
   @staticmethod
   @core.use_tink_errors
@@ -64,6 +72,13 @@ class RawDecryptingStream(io.RawIOBase):
     return tink_bindings.new_cc_decrypting_stream(
         cc_primitive, aad, source)
 
+  @staticmethod
+  @core.use_tink_errors
+  def _get_input_stream_adapter_from_fd(cc_primitive, aad, source_fd):
+    """Implemented as a separate method to ensure correct error transform."""
+    return tink_bindings.new_cc_decrypting_stream_from_fd(
+        cc_primitive, aad, source_fd)
+
   @core.use_tink_errors
   def _read_from_input_stream_adapter(self, size: int) -> bytes:
     """Implemented as a separate method to ensure correct error transform."""
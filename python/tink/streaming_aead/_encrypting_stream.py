@@ -35,6 +35,13 @@ def _new_cc_encrypting_stream(cc_primitive, aad, destination):
       cc_primitive, aad, destination)
 
 
+@core.use_tink_errors
+def _new_cc_encrypting_stream_to_fd(cc_primitive, aad, destination_fd):
+  """Implemented as a separate function to ensure correct error transform."""
+  return tink_bindings.new_cc_encrypting_stream_to_fd(
+      cc_primitive, aad, destination_fd)
+
+
 class RawEncryptingStream(io.RawIOBase):
   """A file-like object which wraps writes to an underlying file-like object.
 
@@ -60,10 +67,20 @@ class RawEncryptingStream(io.RawIOBase):
     super(RawEncryptingStream, self).__init__()
     if not ciphertext_destination.writable():
       raise ValueError('ciphertext_destination must be writable')
-    cc_ciphertext_destination = file_object_adapter.FileObjectAdapter(
-        ciphertext_destination)
-    self._cc_encrypting_stream = _new_cc_encrypting_stream(
-        stream_aead, associated_data, cc_ciphertext_destination)
+    self._ciphertext_destination = ciphertext_destination
+    # Real files are written by C++ directly, through a duplicate of their
+    # file descriptor, without calling back into Python for every chunk.
+    destination_fd = file_object_adapter.native_file_descriptor(
+        ciphertext_destination, for_writing=True)
+    self._writes_fd = destination_fd is not None
+    if self._writes_fd:
+      self._cc_encrypting_stream = _new_cc_encrypting_stream_to_fd(
+          stream_aead, associated_data, destination_fd)
+    else:
+      cc_ciphertext_destination = file_object_adapter.FileObjectAdapter(
+          ciphertext_destination)
+      self._cc_encrypting_stream = _new_cc_encrypting_stream(
+          stream_aead, associated_data, cc_ciphertext_destination)
 
   @core.use_tink_errors
   def _write_to_cc_encrypting_stream(self, b: bytes) -> int:
@@ -105,6 +122,9 @@ class RawEncryptingStream(io.RawIOBase):
       return
     self.flush()
     self._close_cc_encrypting_stream()
+    if self._writes_fd:
+      # C++ only closed the duplicate of the file descriptor.
+      self._ciphertext_destination.close()
     super(RawEncryptingStream, self).close()
 
   def writable(self) -> bool:
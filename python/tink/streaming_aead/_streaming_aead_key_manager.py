@@ -51,6 +51,13 @@ class _StreamingAeadCcToPyWrapper(_raw_streaming_aead.RawStreamingAead):
         associated_data,
         close_ciphertext_source=close_ciphertext_source)
 
+  @core.use_tink_errors
+  def new_cc_pipe(self, associated_data: bytes,
+                  encrypt: bool) -> tink_bindings.StreamingAeadPipe:
+    """Returns a C++ pipe which encrypts or decrypts on a worker thread."""
+    return tink_bindings.new_cc_streaming_aead_pipe(self._cc_streaming_aead,
+                                                    associated_data, encrypt)
+
 
 def from_cc_registry(
     type_url: Text) -> core.KeyManager[_raw_streaming_aead.RawStreamingAead]:
@@ -17,7 +17,7 @@ from __future__ import division
 from __future__ import print_function
 
 import io
-from typing import cast, BinaryIO, Optional, Type
+from typing import cast, BinaryIO, List, Optional, Type
 
 from tink import core
 from tink.streaming_aead import _raw_streaming_aead
@@ -46,12 +46,18 @@ class _DecryptingStreamWrapper(io.RawIOBase):
     super(_DecryptingStreamWrapper, self).__init__()
     if not ciphertext_source.readable():
       raise ValueError('ciphertext_source must be readable')
-    self._ciphertext_source = _rewindable_input_stream.RewindableInputStream(
-        ciphertext_source)
     self._associated_data = associated_data
     self._matching_stream = None
     self._remaining_primitives = [
         entry.primitive for entry in primitive_set.raw_primitives()]
+    # With a single key there is nothing to rewind for, and the decrypting
+    # stream reads ciphertext_source directly (e.g. its file descriptor).
+    self._rewindable = len(self._remaining_primitives) > 1
+    if self._rewindable:
+      self._ciphertext_source = (
+          _rewindable_input_stream.RewindableInputStream(ciphertext_source))
+    else:
+      self._ciphertext_source = ciphertext_source
     self._attempting_stream = self._next_decrypting_stream()
 
   def _next_decrypting_stream(self) -> io.RawIOBase:
@@ -101,7 +107,8 @@ class _DecryptingStreamWrapper(io.RawIOBase):
         # (b'' indicates that the plaintext is an empty string.)
         self._matching_stream = self._attempting_stream
         self._attempting_stream = None
-        self._ciphertext_source.disable_rewind()
+        if self._rewindable:
+          self._ciphertext_source.disable_rewind()
         return data
       except core.TinkError:
         if not self._remaining_primitives:
@@ -153,6 +160,31 @@ class _WrappedStreamingAead(_streaming_aead.StreamingAead):
     return cast(BinaryIO, io.BufferedReader(raw))
 
 
+def raw_primitives(
+    primitive: _streaming_aead.StreamingAead
+) -> List[_raw_streaming_aead.RawStreamingAead]:
+  """Returns the raw primitives of a wrapped primitive, the primary first.
+
+  Args:
+    primitive: A StreamingAead created by StreamingAeadWrapper.
+
+  Returns:
+    The raw primitives of all keys of the keyset, starting with the primary.
+
+  Raises:
+    TinkError if primitive was not created by StreamingAeadWrapper.
+  """
+  if not isinstance(primitive, _WrappedStreamingAead):
+    raise core.TinkError('primitive was not created by StreamingAeadWrapper')
+  primitive_set = primitive._primitive_set  # pylint: disable=protected-access
+  primary = primitive_set.primary().primitive
+  return [primary] + [
+      entry.primitive
+      for entry in primitive_set.raw_primitives()
+      if entry.primitive is not primary
+  ]
+
+
 class StreamingAeadWrapper(
     core.PrimitiveWrapper[_raw_streaming_aead.RawStreamingAead,
                           _streaming_aead.StreamingAead]):
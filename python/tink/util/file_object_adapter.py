@@ -21,7 +21,8 @@ from __future__ import division
 from __future__ import print_function
 
 import io
-from typing import BinaryIO
+import os
+from typing import BinaryIO, Optional
 
 from tink.cc.pybind import tink_bindings
 
@@ -70,3 +71,37 @@ class FileObjectAdapter(tink_bindings.PythonFileObjectAdapter):
       return data
     except io.BlockingIOError:
       return b''
+
+
+def native_file_descriptor(file_object: BinaryIO,
+                           for_writing: bool) -> Optional[int]:
+  """Returns a duplicate of the file descriptor of file_object, or None.
+
+  C++ streams can read or write such a descriptor without calling back into
+  Python for every chunk. This is only done if it does not bypass data
+  buffered by file_object: an object to write to is flushed first, and an
+  object to read from must either be unbuffered (io.FileIO), or seekable, in
+  which case the descriptor is moved to the position of file_object. Since
+  the duplicate shares the position with the original descriptor, file_object
+  must not be read or written while the duplicate is in use.
+
+  Args:
+    file_object: A binary file object.
+    for_writing: Whether the descriptor is used for writing or for reading.
+
+  Returns:
+    A new file descriptor owned by the caller, or None if file_object has no
+    file descriptor that can be used.
+  """
+  try:
+    fd = file_object.fileno()
+    if for_writing:
+      file_object.flush()
+    elif not isinstance(file_object, io.FileIO):
+      if not file_object.seekable():
+        return None
+      os.lseek(fd, file_object.tell(), os.SEEK_SET)
+  except (AttributeError, OSError, ValueError):
+    # io.UnsupportedOperation is both an OSError and a ValueError.
+    return None
+  return os.dup(fd)
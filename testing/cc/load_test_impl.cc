@@ -0,0 +1,222 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Implementation of a LoadTest Service.
+#include "load_test_impl.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tink/aead.h"
+#include "tink/binary_keyset_reader.h"
+#include "tink/cleartext_keyset_handle.h"
+#include "tink/deterministic_aead.h"
+#include "tink/keyset_handle.h"
+#include "tink/mac.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/testing/testing_api.grpc.pb.h"
+
+namespace tink_testing_api {
+
+using ::crypto::tink::BinaryKeysetReader;
+using ::crypto::tink::CleartextKeysetHandle;
+using ::crypto::tink::KeysetHandle;
+using ::crypto::tink::util::StatusOr;
+
+namespace {
+
+// One operation of the load test.
+using Operation = std::function<crypto::tink::util::Status()>;
+
+template <typename P>
+StatusOr<std::shared_ptr<P>> GetPrimitive(const KeysetHandle& handle) {
+  auto primitive_result = handle.GetPrimitive<P>();
+  if (!primitive_result.ok()) return primitive_result.status();
+  return std::shared_ptr<P>(std::move(primitive_result.ValueOrDie()));
+}
+
+// Returns the operation requested by 'request'.  For decryption and
+// verification, the ciphertext or MAC of the input is computed first.
+StatusOr<Operation> NewOperation(const KeysetHandle& handle,
+                                 const LoadTestRequest& request) {
+  const std::string input = request.input();
+  const std::string associated_data = request.associated_data();
+  switch (request.operation()) {
+    case LoadTestRequest::AEAD_ENCRYPT:
+    case LoadTestRequest::AEAD_DECRYPT: {
+      auto aead_result = GetPrimitive<crypto::tink::Aead>(handle);
+      if (!aead_result.ok()) return aead_result.status();
+      std::shared_ptr<crypto::tink::Aead> aead = aead_result.ValueOrDie();
+      if (request.operation() == LoadTestRequest::AEAD_ENCRYPT) {
+        return Operation([aead, input, associated_data]() {
+          return aead->Encrypt(input, associated_data).status();
+        });
+      }
+      auto encrypt_result = aead->Encrypt(input, associated_data);
+      if (!encrypt_result.ok()) return encrypt_result.status();
+      std::string ciphertext = encrypt_result.ValueOrDie();
+      return Operation([aead, ciphertext, associated_data]() {
+        return aead->Decrypt(ciphertext, associated_data).status();
+      });
+    }
+    case LoadTestRequest::DETERMINISTIC_AEAD_ENCRYPT:
+    case LoadTestRequest::DETERMINISTIC_AEAD_DECRYPT: {
+      auto daead_result =
+          GetPrimitive<crypto::tink::DeterministicAead>(handle);
+      if (!daead_result.ok()) return daead_result.status();
+      std::shared_ptr<crypto::tink::DeterministicAead> daead =
+          daead_result.ValueOrDie();
+      if (request.operation() ==
+          LoadTestRequest::DETERMINISTIC_AEAD_ENCRYPT) {
+        return Operation([daead, input, associated_data]() {
+          return daead->EncryptDeterministically(input, associated_data)
+              .status();
+        });
+      }
+      auto encrypt_result =
+          daead->EncryptDeterministically(input, associated_data);
+      if (!encrypt_result.ok()) return encrypt_result.status();
+      std::string ciphertext = encrypt_result.ValueOrDie();
+      return Operation([daead, ciphertext, associated_data]() {
+        return daead->DecryptDeterministically(ciphertext, associated_data)
+            .status();
+      });
+    }
+    case LoadTestRequest::MAC_COMPUTE:
+    case LoadTestRequest::MAC_VERIFY: {
+      auto mac_result = GetPrimitive<crypto::tink::Mac>(handle);
+      if (!mac_result.ok()) return mac_result.status();
+      std::shared_ptr<crypto::tink::Mac> mac = mac_result.ValueOrDie();
+      if (request.operation() == LoadTestRequest::MAC_COMPUTE) {
+        return Operation([mac, input]() {
+          return mac->ComputeMac(input).status();
+        });
+      }
+      auto compute_result = mac->ComputeMac(input);
+      if (!compute_result.ok()) return compute_result.status();
+      std::string mac_value = compute_result.ValueOrDie();
+      return Operation([mac, mac_value, input]() {
+        return mac->VerifyMac(mac_value, input);
+      });
+    }
+    default:
+      return crypto::tink::util::Status(
+          crypto::tink::util::error::INVALID_ARGUMENT,
+          "Unknown load test operation");
+  }
+}
+
+// Returns the latency below which 'fraction' of the sorted 'latencies' are.
+double PercentileMicros(const std::vector<absl::Duration>& latencies,
+                        double fraction) {
+  size_t index = std::min(latencies.size() - 1,
+                          static_cast<size_t>(fraction * latencies.size()));
+  return absl::ToDoubleMicroseconds(latencies[index]);
+}
+
+}  // namespace
+
+constexpr int LoadTestImpl::kMaxThreads;
+
+// Runs a load test
+::grpc::Status LoadTestImpl::Run(grpc::ServerContext* context,
+                                 const LoadTestRequest* request,
+                                 LoadTestResponse* response) {
+  if (request->operations() <= 0) {
+    response->set_err("operations must be positive");
+    return ::grpc::Status::OK;
+  }
+  if (request->threads() <= 0 || request->threads() > kMaxThreads) {
+    response->set_err("threads must be between 1 and 256");
+    return ::grpc::Status::OK;
+  }
+  auto reader_result = BinaryKeysetReader::New(request->keyset());
+  if (!reader_result.ok()) {
+    response->set_err(reader_result.status().error_message());
+    return ::grpc::Status::OK;
+  }
+  auto handle_result =
+      CleartextKeysetHandle::Read(std::move(reader_result.ValueOrDie()));
+  if (!handle_result.ok()) {
+    response->set_err(handle_result.status().error_message());
+    return ::grpc::Status::OK;
+  }
+  auto operation_result = NewOperation(*handle_result.ValueOrDie(), *request);
+  if (!operation_result.ok()) {
+    response->set_err(operation_result.status().error_message());
+    return ::grpc::Status::OK;
+  }
+  const Operation& operation = operation_result.ValueOrDie();
+
+  const int num_threads = request->threads();
+  std::vector<std::vector<absl::Duration>> latencies(num_threads);
+  std::vector<crypto::tink::util::Status> statuses(num_threads);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads);
+  absl::Time start = absl::Now();
+  for (int t = 0; t < num_threads; t++) {
+    int count = request->operations() / num_threads +
+                (t < request->operations() % num_threads ? 1 : 0);
+    threads.emplace_back([&operation, &latencies, &statuses, t, count]() {
+      latencies[t].reserve(count);
+      for (int i = 0; i < count; i++) {
+        absl::Time operation_start = absl::Now();
+        crypto::tink::util::Status status = operation();
+        latencies[t].push_back(absl::Now() - operation_start);
+        if (!status.ok()) {
+          statuses[t] = status;
+          return;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  absl::Duration elapsed = absl::Now() - start;
+
+  std::vector<absl::Duration> all_latencies;
+  all_latencies.reserve(request->operations());
+  for (int t = 0; t < num_threads; t++) {
+    if (!statuses[t].ok()) {
+      response->set_err(statuses[t].error_message());
+      return ::grpc::Status::OK;
+    }
+    all_latencies.insert(all_latencies.end(), latencies[t].begin(),
+                         latencies[t].end());
+  }
+  std::sort(all_latencies.begin(), all_latencies.end());
+
+  LoadTestResponse::Output* output = response->mutable_output();
+  output->set_operations(all_latencies.size());
+  output->set_elapsed_seconds(absl::ToDoubleSeconds(elapsed));
+  output->set_operations_per_second(all_latencies.size() /
+                                    absl::ToDoubleSeconds(elapsed));
+  output->set_latency_p50_micros(PercentileMicros(all_latencies, 0.5));
+  output->set_latency_p90_micros(PercentileMicros(all_latencies, 0.9));
+  output->set_latency_p99_micros(PercentileMicros(all_latencies, 0.99));
+  output->set_latency_max_micros(
+      absl::ToDoubleMicroseconds(all_latencies.back()));
+  return ::grpc::Status::OK;
+}
+
+}  // namespace tink_testing_api
@@ -0,0 +1,163 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "load_test_impl.h"
+
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "tink/aead/aead_config.h"
+#include "tink/aead/aead_key_templates.h"
+#include "tink/binary_keyset_writer.h"
+#include "tink/cleartext_keyset_handle.h"
+#include "tink/mac/mac_config.h"
+#include "tink/mac/mac_key_templates.h"
+#include "proto/testing/testing_api.grpc.pb.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using ::crypto::tink::AeadKeyTemplates;
+using ::crypto::tink::BinaryKeysetWriter;
+using ::crypto::tink::CleartextKeysetHandle;
+using ::crypto::tink::MacKeyTemplates;
+
+using ::testing::Eq;
+using ::testing::Ge;
+using ::testing::Gt;
+using ::testing::IsEmpty;
+using ::testing::Not;
+using ::tink_testing_api::LoadTestRequest;
+using ::tink_testing_api::LoadTestResponse;
+
+using crypto::tink::KeysetHandle;
+using google::crypto::tink::KeyTemplate;
+
+std::string ValidKeyset(const KeyTemplate& key_template) {
+  auto handle_result = KeysetHandle::GenerateNew(key_template);
+  EXPECT_TRUE(handle_result.ok());
+  std::stringbuf keyset;
+  auto writer_result =
+      BinaryKeysetWriter::New(absl::make_unique<std::ostream>(&keyset));
+  EXPECT_TRUE(writer_result.ok());
+
+  auto status = CleartextKeysetHandle::Write(writer_result.ValueOrDie().get(),
+                                             *handle_result.ValueOrDie());
+  EXPECT_TRUE(status.ok());
+  return keyset.str();
+}
+
+class LoadTestImplTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    ASSERT_TRUE(AeadConfig::Register().ok());
+    ASSERT_TRUE(MacConfig::Register().ok());
+  }
+};
+
+void ExpectValidOutput(const LoadTestResponse& response, int operations) {
+  EXPECT_THAT(response.err(), IsEmpty());
+  const LoadTestResponse::Output& output = response.output();
+  EXPECT_THAT(output.operations(), Eq(operations));
+  EXPECT_THAT(output.elapsed_seconds(), Gt(0));
+  EXPECT_THAT(output.operations_per_second(), Gt(0));
+  EXPECT_THAT(output.latency_p90_micros(), Ge(output.latency_p50_micros()));
+  EXPECT_THAT(output.latency_p99_micros(), Ge(output.latency_p90_micros()));
+  EXPECT_THAT(output.latency_max_micros(), Ge(output.latency_p99_micros()));
+}
+
+TEST_F(LoadTestImplTest, AeadEncryptAndDecrypt) {
+  tink_testing_api::LoadTestImpl load_test;
+  LoadTestRequest request;
+  request.set_keyset(ValidKeyset(AeadKeyTemplates::Aes128Gcm()));
+  request.set_input("Plain text");
+  request.set_associated_data("ad");
+  request.set_operations(1001);
+  request.set_threads(4);
+
+  request.set_operation(LoadTestRequest::AEAD_ENCRYPT);
+  LoadTestResponse encrypt_response;
+  EXPECT_TRUE(load_test.Run(nullptr, &request, &encrypt_response).ok());
+  ExpectValidOutput(encrypt_response, 1001);
+
+  request.set_operation(LoadTestRequest::AEAD_DECRYPT);
+  LoadTestResponse decrypt_response;
+  EXPECT_TRUE(load_test.Run(nullptr, &request, &decrypt_response).ok());
+  ExpectValidOutput(decrypt_response, 1001);
+}
+
+TEST_F(LoadTestImplTest, MacComputeAndVerify) {
+  tink_testing_api::LoadTestImpl load_test;
+  LoadTestRequest request;
+  request.set_keyset(ValidKeyset(MacKeyTemplates::HmacSha256()));
+  request.set_input("data");
+  request.set_operations(100);
+  request.set_threads(1);
+
+  request.set_operation(LoadTestRequest::MAC_COMPUTE);
+  LoadTestResponse compute_response;
+  EXPECT_TRUE(load_test.Run(nullptr, &request, &compute_response).ok());
+  ExpectValidOutput(compute_response, 100);
+
+  request.set_operation(LoadTestRequest::MAC_VERIFY);
+  LoadTestResponse verify_response;
+  EXPECT_TRUE(load_test.Run(nullptr, &request, &verify_response).ok());
+  ExpectValidOutput(verify_response, 100);
+}
+
+TEST_F(LoadTestImplTest, WrongPrimitiveFails) {
+  tink_testing_api::LoadTestImpl load_test;
+  LoadTestRequest request;
+  request.set_keyset(ValidKeyset(AeadKeyTemplates::Aes128Gcm()));
+  request.set_operation(LoadTestRequest::MAC_COMPUTE);
+  request.set_operations(10);
+  request.set_threads(1);
+  LoadTestResponse response;
+
+  EXPECT_TRUE(load_test.Run(nullptr, &request, &response).ok());
+  EXPECT_THAT(response.err(), Not(IsEmpty()));
+}
+
+TEST_F(LoadTestImplTest, InvalidRequestsFail) {
+  tink_testing_api::LoadTestImpl load_test;
+  LoadTestRequest request;
+  request.set_keyset(ValidKeyset(AeadKeyTemplates::Aes128Gcm()));
+  request.set_operation(LoadTestRequest::AEAD_ENCRYPT);
+  request.set_operations(10);
+
+  request.set_threads(0);
+  LoadTestResponse no_threads_response;
+  EXPECT_TRUE(load_test.Run(nullptr, &request, &no_threads_response).ok());
+  EXPECT_THAT(no_threads_response.err(), Not(IsEmpty()));
+
+  request.set_threads(1);
+  request.set_operations(0);
+  LoadTestResponse no_operations_response;
+  EXPECT_TRUE(load_test.Run(nullptr, &request, &no_operations_response).ok());
+  EXPECT_THAT(no_operations_response.err(), Not(IsEmpty()));
+
+  request.set_operations(10);
+  request.set_operation(LoadTestRequest::UNKNOWN_OPERATION);
+  LoadTestResponse unknown_response;
+  EXPECT_TRUE(load_test.Run(nullptr, &request, &unknown_response).ok());
+  EXPECT_THAT(unknown_response.err(), Not(IsEmpty()));
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
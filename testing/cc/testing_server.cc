@@ -23,6 +23,7 @@
 #include "deterministic_aead_impl.h"
 #include "hybrid_impl.h"
 #include "keyset_impl.h"
+#include "load_test_impl.h"
 #include "mac_impl.h"
 #include "metadata_impl.h"
 #include "prf_set_impl.h"
@@ -30,6 +31,12 @@
 #include "streaming_aead_impl.h"
 
 ABSL_FLAG(int, port, 23456, "the port");
+ABSL_FLAG(int, num_cqs, 0,
+          "the number of completion queues of the server, or 0 for the gRPC "
+          "default; more queues let more requests be served concurrently");
+ABSL_FLAG(int, max_pollers, 0,
+          "the maximum number of polling threads per completion queue, or 0 "
+          "for the gRPC default");
 
 void RunServer() {
   auto status = crypto::tink::TinkConfig::Register();
@@ -59,10 +66,20 @@ void RunServer() {
   tink_testing_api::SignatureImpl signature;
   tink_testing_api::StreamingAeadImpl streaming_aead;
   tink_testing_api::PrfSetImpl prf_set;
+  tink_testing_api::LoadTestImpl load_test;
 
   grpc::ServerBuilder builder;
   builder.AddListeningPort(
       server_address, ::grpc::experimental::LocalServerCredentials(LOCAL_TCP));
+  if (absl::GetFlag(FLAGS_num_cqs) > 0) {
+    builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::NUM_CQS,
+                                absl::GetFlag(FLAGS_num_cqs));
+  }
+  if (absl::GetFlag(FLAGS_max_pollers) > 0) {
+    builder.SetSyncServerOption(
+        grpc::ServerBuilder::SyncServerOption::MAX_POLLERS,
+        absl::GetFlag(FLAGS_max_pollers));
+  }
 
   builder.RegisterService(&metadata);
   builder.RegisterService(&keyset);
@@ -73,6 +90,7 @@ void RunServer() {
   builder.RegisterService(&signature);
   builder.RegisterService(&prf_set);
   builder.RegisterService(&streaming_aead);
+  builder.RegisterService(&load_test);
 
   std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
   std::cout << "Server listening on " << server_address << std::endl;
@@ -20,10 +20,45 @@
 #include "tink/aead.h"
 #include "tink/keyset_handle.h"
 #include "tink/util/status.h"
+#include "testing/cc/cli_benchmark.h"
 #include "testing/cc/cli_util.h"
 
 using crypto::tink::KeysetHandle;
 
+namespace {
+
+// Runs the benchmark mode, see CliBenchmark.
+int RunBenchmark(int argc, char** argv) {
+  std::string operation(argc == 7 ? argv[3] : "");
+  if (operation != "encrypt" && operation != "decrypt") {
+    CliBenchmark::ExitWithUsage(argv[0], "'encrypt', 'decrypt'");
+  }
+  CliUtil::InitTink();
+  std::unique_ptr<KeysetHandle> keyset_handle = CliUtil::ReadKeyset(argv[2]);
+  std::unique_ptr<crypto::tink::Aead> aead =
+      CliBenchmark::GetPrimitive<crypto::tink::Aead>(*keyset_handle);
+  const std::string associated_data = "associated data";
+  CliBenchmark::Prepare prepare;
+  CliBenchmark::Operation benchmarked;
+  if (operation == "encrypt") {
+    benchmarked = [&](absl::string_view input) {
+      return aead->Encrypt(input, associated_data).status();
+    };
+  } else {
+    prepare = [&](absl::string_view input) {
+      return aead->Encrypt(input, associated_data);
+    };
+    benchmarked = [&](absl::string_view input) {
+      return aead->Decrypt(input, associated_data).status();
+    };
+  }
+  CliBenchmark::Run("AEAD-" + operation, CliBenchmark::ParseOptions(argv + 4),
+                    prepare, benchmarked);
+  return 0;
+}
+
+}  // namespace
+
 // A command-line utility for testing AEAD-primitives.
 // It requires 5 arguments:
 //   keyset-file:  name of the file with the keyset to be used for encryption
@@ -32,7 +67,12 @@ using crypto::tink::KeysetHandle;
 //                or ciphertext for decryption)
 //   associated-data-file:  name of the file containing associated data
 //   output-file:  name of the file for the resulting output
+// With "benchmark" as first argument, runs a throughput benchmark instead,
+// see CliBenchmark.
 int main(int argc, char** argv) {
+  if (CliBenchmark::IsBenchmark(argc, argv)) {
+    return RunBenchmark(argc, argv);
+  }
   if (argc != 6) {
     std::clog << "Usage: " << argv[0]
          << " keyset-file operation input-file associated-data-file "
@@ -0,0 +1,165 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "testing/cc/cli_benchmark.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstdint>
+#include <cstdlib>
+#include <future>  // NOLINT(build/c++11)
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "absl/strings/numbers.h"
+#include "tink/subtle/random.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+using crypto::tink::subtle::Random;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// The number of distinct inputs, which the threads go through in turn, so
+// that the benchmark does not only measure a single cached input.
+constexpr int kMaxInputs = 16;
+
+int ParsePositive(const char* arg, const char* name) {
+  int value;
+  if (!absl::SimpleAtoi(arg, &value) || value <= 0) {
+    std::clog << "Invalid " << name << " '" << arg
+              << "', expected a positive number.\n";
+    exit(1);
+  }
+  return value;
+}
+
+// Returns the latency at 'percentile' of the sorted 'latencies', in
+// microseconds.
+double Percentile(const std::vector<int64_t>& latencies, double percentile) {
+  size_t index = static_cast<size_t>(percentile / 100 * latencies.size());
+  index = std::min(index, latencies.size() - 1);
+  return latencies[index] / 1000.0;
+}
+
+}  // namespace
+
+// static
+bool CliBenchmark::IsBenchmark(int argc, char** argv) {
+  return argc > 1 && std::string(argv[1]) == "benchmark";
+}
+
+// static
+CliBenchmark::Options CliBenchmark::ParseOptions(char** argv) {
+  Options options;
+  options.input_size = ParsePositive(argv[0], "input-size");
+  options.threads = ParsePositive(argv[1], "threads");
+  options.operations = ParsePositive(argv[2], "operations");
+  return options;
+}
+
+// static
+void CliBenchmark::ExitWithUsage(const std::string& cli,
+                                 const std::string& operations) {
+  std::clog << "Usage: " << cli
+            << " benchmark keyset-file operation input-size threads "
+            << "operations\n"
+            << "where operation is one of " << operations << ".\n";
+  exit(1);
+}
+
+// static
+void CliBenchmark::Run(const std::string& name, const Options& options,
+                       const Prepare& prepare, const Operation& operation) {
+  std::vector<std::string> inputs;
+  int input_count = std::min(kMaxInputs, options.operations);
+  for (int i = 0; i < input_count; i++) {
+    std::string input = Random::GetRandomBytes(options.input_size);
+    if (prepare) {
+      StatusOr<std::string> prepared = prepare(input);
+      if (!prepared.ok()) {
+        std::clog << "Preparing the inputs failed: "
+                  << prepared.status().error_message() << std::endl;
+        exit(1);
+      }
+      input = std::move(prepared.ValueOrDie());
+    }
+    inputs.push_back(std::move(input));
+  }
+
+  std::clog << "Running " << name << " on " << options.threads
+            << " threads, " << options.operations << " operations each, on "
+            << options.input_size << " bytes...\n";
+  std::vector<std::vector<int64_t>> latencies(options.threads);
+  std::vector<Status> statuses(options.threads);
+  std::promise<void> start;
+  std::shared_future<void> started = start.get_future().share();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < options.threads; t++) {
+    threads.emplace_back([&, t]() {
+      std::vector<int64_t>& thread_latencies = latencies[t];
+      thread_latencies.reserve(options.operations);
+      // One untimed operation, so that lazy initialization is not counted.
+      statuses[t] = operation(inputs[t % inputs.size()]);
+      started.wait();
+      for (int i = 0; i < options.operations && statuses[t].ok(); i++) {
+        const std::string& input = inputs[(t + i) % inputs.size()];
+        Clock::time_point begin = Clock::now();
+        statuses[t] = operation(input);
+        thread_latencies.push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - begin)
+                .count());
+      }
+    });
+  }
+  Clock::time_point begin = Clock::now();
+  start.set_value();
+  for (std::thread& thread : threads) thread.join();
+  double seconds =
+      std::chrono::duration<double>(Clock::now() - begin).count();
+
+  for (const Status& status : statuses) {
+    if (!status.ok()) {
+      std::clog << name << " failed: " << status.error_message() << std::endl;
+      exit(1);
+    }
+  }
+  std::vector<int64_t> all_latencies;
+  for (const std::vector<int64_t>& thread_latencies : latencies) {
+    all_latencies.insert(all_latencies.end(), thread_latencies.begin(),
+                         thread_latencies.end());
+  }
+  std::sort(all_latencies.begin(), all_latencies.end());
+  double total_operations = all_latencies.size();
+  std::cout << std::fixed << std::setprecision(1) << name
+            << ": input-size=" << options.input_size
+            << " threads=" << options.threads
+            << " operations=" << all_latencies.size()
+            << " ops/s=" << total_operations / seconds
+            << " MB/s=" << total_operations * options.input_size / seconds / 1e6
+            << " latency-us: p50=" << Percentile(all_latencies, 50)
+            << " p90=" << Percentile(all_latencies, 90)
+            << " p99=" << Percentile(all_latencies, 99)
+            << " max=" << all_latencies.back() / 1000.0 << std::endl;
+}
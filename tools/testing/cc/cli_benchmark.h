@@ -0,0 +1,91 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TOOLS_TESTING_CC_CLI_BENCHMARK_H_
+#define TOOLS_TESTING_CC_CLI_BENCHMARK_H_
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/keyset_handle.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+// Throughput benchmark for the operations of the CLI applications, so that
+// implementations in different languages can be compared on the same
+// keysets.  A CLI runs a benchmark when its first argument is "benchmark":
+//   <cli> benchmark keyset-file operation input-size threads operations
+class CliBenchmark {
+ public:
+  struct Options {
+    // The size of the generated inputs in bytes.
+    int input_size;
+    // The number of threads which run the operation at once.
+    int threads;
+    // The number of timed operations per thread.
+    int operations;
+  };
+
+  // Turns a generated input into the input of the benchmarked operation,
+  // e.g. a plaintext into a ciphertext when benchmarking decryption.
+  using Prepare = std::function<crypto::tink::util::StatusOr<std::string>(
+      absl::string_view input)>;
+
+  // The benchmarked operation.
+  using Operation =
+      std::function<crypto::tink::util::Status(absl::string_view input)>;
+
+  // Returns true if the arguments of the CLI ask for a benchmark.
+  static bool IsBenchmark(int argc, char** argv);
+
+  // Parses the arguments "input-size threads operations" at 'argv'.
+  // In case of errors writes a log message and aborts.
+  static Options ParseOptions(char** argv);
+
+  // Prints the usage of the benchmark mode of 'cli' with the given
+  // operations, and aborts.
+  static void ExitWithUsage(const std::string& cli,
+                            const std::string& operations);
+
+  // Returns the primitive P of 'keyset_handle'.
+  // In case of errors writes a log message and aborts.
+  template <class P>
+  static std::unique_ptr<P> GetPrimitive(
+      const crypto::tink::KeysetHandle& keyset_handle) {
+    auto primitive_result = keyset_handle.GetPrimitive<P>();
+    if (!primitive_result.ok()) {
+      std::clog << "Getting the primitive failed: "
+                << primitive_result.status().error_message() << std::endl;
+      exit(1);
+    }
+    return std::move(primitive_result.ValueOrDie());
+  }
+
+  // Runs 'operation' options.operations times on each of options.threads
+  // threads, over random inputs of options.input_size bytes passed through
+  // 'prepare', which may be null.  Prints the number of operations per
+  // second, the throughput in MB/s of the generated inputs and percentiles
+  // of the latency to stdout.
+  // In case of errors writes a log message and aborts.
+  static void Run(const std::string& name, const Options& options,
+                  const Prepare& prepare, const Operation& operation);
+};
+
+#endif  // TOOLS_TESTING_CC_CLI_BENCHMARK_H_
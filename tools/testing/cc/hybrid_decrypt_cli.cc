@@ -18,12 +18,50 @@
 #include <fstream>
 
 #include "tink/hybrid_decrypt.h"
+#include "tink/hybrid_encrypt.h"
 #include "tink/keyset_handle.h"
 #include "tink/util/status.h"
+#include "testing/cc/cli_benchmark.h"
 #include "testing/cc/cli_util.h"
 
 using crypto::tink::KeysetHandle;
 
+namespace {
+
+// Runs the benchmark mode, see CliBenchmark.  The ciphertexts are encrypted
+// with the public keyset of the given private keyset.
+int RunBenchmark(int argc, char** argv) {
+  std::string operation(argc == 7 ? argv[3] : "");
+  if (operation != "decrypt") {
+    CliBenchmark::ExitWithUsage(argv[0], "'decrypt'");
+  }
+  CliUtil::InitTink();
+  std::unique_ptr<KeysetHandle> keyset_handle = CliUtil::ReadKeyset(argv[2]);
+  auto public_handle_result = keyset_handle->GetPublicKeysetHandle();
+  if (!public_handle_result.ok()) {
+    std::clog << "Getting the public keyset failed: "
+              << public_handle_result.status().error_message() << std::endl;
+    exit(1);
+  }
+  std::unique_ptr<crypto::tink::HybridEncrypt> hybrid_encrypt =
+      CliBenchmark::GetPrimitive<crypto::tink::HybridEncrypt>(
+          *public_handle_result.ValueOrDie());
+  std::unique_ptr<crypto::tink::HybridDecrypt> hybrid_decrypt =
+      CliBenchmark::GetPrimitive<crypto::tink::HybridDecrypt>(*keyset_handle);
+  const std::string context_info = "context info";
+  CliBenchmark::Run(
+      "HybridDecrypt-decrypt", CliBenchmark::ParseOptions(argv + 4),
+      [&](absl::string_view input) {
+        return hybrid_encrypt->Encrypt(input, context_info);
+      },
+      [&](absl::string_view input) {
+        return hybrid_decrypt->Decrypt(input, context_info).status();
+      });
+  return 0;
+}
+
+}  // namespace
+
 // A command-line utility for testing HybridDecrypt-primitives.
 // It requires 4 arguments:
 //   keyset-file:  name of the file with the keyset to be used for decryption
@@ -31,7 +69,12 @@ using crypto::tink::KeysetHandle;
 //   context-info-file:  name of the file that contains "context info" which
 //       will be used during the decryption
 //   output-file:  name of the output file for the resulting plaintext
+// With "benchmark" as first argument, runs a throughput benchmark instead,
+// see CliBenchmark.
 int main(int argc, char** argv) {
+  if (CliBenchmark::IsBenchmark(argc, argv)) {
+    return RunBenchmark(argc, argv);
+  }
   if (argc != 5) {
     std::clog << "Usage: "
               << argv[0]
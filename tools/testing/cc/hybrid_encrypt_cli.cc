@@ -18,11 +18,36 @@
 #include "tink/keyset_handle.h"
 #include "tink/hybrid/hybrid_encrypt_factory.h"
 #include "tink/util/status.h"
+#include "testing/cc/cli_benchmark.h"
 #include "testing/cc/cli_util.h"
 
 using crypto::tink::HybridEncryptFactory;
 using crypto::tink::KeysetHandle;
 
+namespace {
+
+// Runs the benchmark mode, see CliBenchmark.
+int RunBenchmark(int argc, char** argv) {
+  std::string operation(argc == 7 ? argv[3] : "");
+  if (operation != "encrypt") {
+    CliBenchmark::ExitWithUsage(argv[0], "'encrypt'");
+  }
+  CliUtil::InitTink();
+  std::unique_ptr<KeysetHandle> keyset_handle = CliUtil::ReadKeyset(argv[2]);
+  std::unique_ptr<crypto::tink::HybridEncrypt> hybrid_encrypt =
+      CliBenchmark::GetPrimitive<crypto::tink::HybridEncrypt>(*keyset_handle);
+  const std::string context_info = "context info";
+  CliBenchmark::Run("HybridEncrypt-encrypt",
+                    CliBenchmark::ParseOptions(argv + 4), nullptr,
+                    [&](absl::string_view input) {
+                      return hybrid_encrypt->Encrypt(input, context_info)
+                          .status();
+                    });
+  return 0;
+}
+
+}  // namespace
+
 // A command-line utility for testing HybridEncrypt-primitives.
 // It requires 4 arguments:
 //   keyset-file:  name of the file with the keyset to be used for encryption
@@ -30,7 +55,12 @@ using crypto::tink::KeysetHandle;
 //   context-info-file:  name of the file that contains "context info" which
 //       will be used during the decryption
 //   output-file:  name of the output file for the resulting ciphertext
+// With "benchmark" as first argument, runs a throughput benchmark instead,
+// see CliBenchmark.
 int main(int argc, char** argv) {
+  if (CliBenchmark::IsBenchmark(argc, argv)) {
+    return RunBenchmark(argc, argv);
+  }
   if (argc != 5) {
     std::clog << "Usage: "
               << argv[0]
@@ -21,11 +21,52 @@
 #include "tink/mac.h"
 #include "tink/mac/mac_factory.h"
 #include "tink/util/status.h"
+#include "testing/cc/cli_benchmark.h"
 #include "testing/cc/cli_util.h"
 
 using crypto::tink::MacFactory;
 using crypto::tink::KeysetHandle;
 
+namespace {
+
+// Runs the benchmark mode, see CliBenchmark.  Verification is benchmarked
+// on correct MACs, which are prepended to the inputs.
+int RunBenchmark(int argc, char** argv) {
+  std::string operation(argc == 7 ? argv[3] : "");
+  if (operation != "compute" && operation != "verify") {
+    CliBenchmark::ExitWithUsage(argv[0], "'compute', 'verify'");
+  }
+  CliUtil::InitTink();
+  std::unique_ptr<KeysetHandle> keyset_handle = CliUtil::ReadKeyset(argv[2]);
+  std::unique_ptr<crypto::tink::Mac> mac =
+      CliBenchmark::GetPrimitive<crypto::tink::Mac>(*keyset_handle);
+  CliBenchmark::Prepare prepare;
+  CliBenchmark::Operation benchmarked;
+  size_t mac_size = 0;
+  if (operation == "compute") {
+    benchmarked = [&](absl::string_view input) {
+      return mac->ComputeMac(input).status();
+    };
+  } else {
+    prepare = [&](absl::string_view input)
+        -> crypto::tink::util::StatusOr<std::string> {
+      auto mac_result = mac->ComputeMac(input);
+      if (!mac_result.ok()) return mac_result.status();
+      mac_size = mac_result.ValueOrDie().size();
+      return mac_result.ValueOrDie() + std::string(input);
+    };
+    benchmarked = [&](absl::string_view input) {
+      return mac->VerifyMac(input.substr(0, mac_size),
+                            input.substr(mac_size));
+    };
+  }
+  CliBenchmark::Run("MAC-" + operation, CliBenchmark::ParseOptions(argv + 4),
+                    prepare, benchmarked);
+  return 0;
+}
+
+}  // namespace
+
 // A command-line utility for testing Mac-primitives.
 // It requires 4 for MAC computation and 5 for MAC verification:
 //   keyset-file:  name of the file with the keyset to be used for MAC
@@ -35,7 +76,12 @@ using crypto::tink::KeysetHandle;
 //              or with MAC value (when verifying the MAC)
 //   result-file: name of the file for MAC verification result (valid/invalid)
 //                (only for MAC verification operation)
+// With "benchmark" as first argument, runs a throughput benchmark instead,
+// see CliBenchmark.
 int main(int argc, char** argv) {
+  if (CliBenchmark::IsBenchmark(argc, argv)) {
+    return RunBenchmark(argc, argv);
+  }
   if (argc != 5 && argc != 6) {
     std::clog << "Usage: " << argv[0]
          << " keyset-file operation data-file mac-file [result-file]\n";
@@ -23,11 +23,34 @@
 #include "tink/keyset_handle.h"
 #include "tink/prf/prf_set.h"
 #include "tink/util/status.h"
+#include "testing/cc/cli_benchmark.h"
 #include "testing/cc/cli_util.h"
 
 using crypto::tink::KeysetHandle;
 using crypto::tink::PrfSet;
 
+namespace {
+
+// Runs the benchmark mode, see CliBenchmark.  Computes 32 bytes with the
+// primary PRF.
+int RunBenchmark(int argc, char** argv) {
+  std::string operation(argc == 7 ? argv[3] : "");
+  if (operation != "compute") {
+    CliBenchmark::ExitWithUsage(argv[0], "'compute'");
+  }
+  CliUtil::InitTink();
+  std::unique_ptr<KeysetHandle> keyset_handle = CliUtil::ReadKeyset(argv[2]);
+  std::unique_ptr<PrfSet> prf_set =
+      CliBenchmark::GetPrimitive<PrfSet>(*keyset_handle);
+  CliBenchmark::Run("PrfSet-compute", CliBenchmark::ParseOptions(argv + 4),
+                    nullptr, [&](absl::string_view input) {
+                      return prf_set->ComputePrimary(input, 32).status();
+                    });
+  return 0;
+}
+
+}  // namespace
+
 // A command-line utility for testing PrfSet-primitives.
 // It requires 4 arguments:
 //   keyset-file:  name of the file with the keyset to be used for PrfSet
@@ -39,7 +62,12 @@ using crypto::tink::PrfSet;
 //   If the requested output is too long the result should be instead
 //   <prf_id>:--.
 //   The file is sorted by <prf_id> in the shell script.
+// With "benchmark" as first argument, runs a throughput benchmark instead,
+// see CliBenchmark.
 int main(int argc, char** argv) {
+  if (CliBenchmark::IsBenchmark(argc, argv)) {
+    return RunBenchmark(argc, argv);
+  }
   if (argc != 5) {
     std::clog << "Usage: " << argv[0]
               << " keyset-file data-file prf-file output-length" << std::endl;
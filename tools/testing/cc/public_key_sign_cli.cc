@@ -20,16 +20,43 @@
 #include "tink/public_key_sign.h"
 #include "tink/keyset_handle.h"
 #include "tink/util/status.h"
+#include "testing/cc/cli_benchmark.h"
 #include "testing/cc/cli_util.h"
 
 using crypto::tink::KeysetHandle;
 
+namespace {
+
+// Runs the benchmark mode, see CliBenchmark.
+int RunBenchmark(int argc, char** argv) {
+  std::string operation(argc == 7 ? argv[3] : "");
+  if (operation != "sign") {
+    CliBenchmark::ExitWithUsage(argv[0], "'sign'");
+  }
+  CliUtil::InitTink();
+  std::unique_ptr<KeysetHandle> keyset_handle = CliUtil::ReadKeyset(argv[2]);
+  std::unique_ptr<crypto::tink::PublicKeySign> public_key_sign =
+      CliBenchmark::GetPrimitive<crypto::tink::PublicKeySign>(*keyset_handle);
+  CliBenchmark::Run("PublicKeySign-sign", CliBenchmark::ParseOptions(argv + 4),
+                    nullptr, [&](absl::string_view input) {
+                      return public_key_sign->Sign(input).status();
+                    });
+  return 0;
+}
+
+}  // namespace
+
 // A command-line utility for testing PublicKeySign-primitives.
 // It requires 3 arguments:
 //   keyset-file:  name of the file with the keyset to be used for signing
 //   message-file:  name of the file that contains message to be signed
 //   output-file:  name of the output file for the resulting plaintext
+// With "benchmark" as first argument, runs a throughput benchmark instead,
+// see CliBenchmark.
 int main(int argc, char** argv) {
+  if (CliBenchmark::IsBenchmark(argc, argv)) {
+    return RunBenchmark(argc, argv);
+  }
   if (argc != 4) {
     std::clog << "Usage: "
               << argv[0]
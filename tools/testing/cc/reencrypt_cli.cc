@@ -0,0 +1,133 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "absl/strings/numbers.h"
+#include "tink/aead.h"
+#include "tink/keyset_handle.h"
+#include "tink/streaming_aead.h"
+#include "testing/cc/cli_util.h"
+#include "testing/cc/reencrypter.h"
+
+using crypto::tink::KeysetHandle;
+
+namespace {
+
+// Returns the primitive 'P' of the keyset in file 'keyset_filename'.
+template <class P>
+std::unique_ptr<P> GetPrimitive(const std::string& keyset_filename) {
+  std::unique_ptr<KeysetHandle> keyset_handle =
+      CliUtil::ReadKeyset(keyset_filename);
+  auto primitive_result = keyset_handle->GetPrimitive<P>();
+  if (!primitive_result.ok()) {
+    std::clog << "Getting the primitive of keyset " << keyset_filename
+              << " failed: " << primitive_result.status().error_message()
+              << std::endl;
+    exit(1);
+  }
+  return std::move(primitive_result.ValueOrDie());
+}
+
+}  // namespace
+
+// A command-line utility for re-encrypting files after a key rotation.
+// It requires 7 arguments:
+//   old-keyset-file:  name of the file with the keyset that decrypts
+//                     the files
+//   new-keyset-file:  name of the file with the keyset whose primary key
+//                     encrypts the files
+//   primitive:  the primitive of the keysets, i.e. "aead" or "streaming_aead"
+//   associated-data-file:  name of the file containing associated data
+//   job-file:  name of a file with one job per line, consisting of the
+//              name of an input file and the name of the output file,
+//              separated by a space
+//   checkpoint-file:  name of the file that records the completed jobs;
+//                     running the utility again skips them
+//   threads:  the number of files that are re-encrypted concurrently
+int main(int argc, char** argv) {
+  if (argc != 8) {
+    std::clog << "Usage: " << argv[0]
+              << " old-keyset-file new-keyset-file primitive "
+              << "associated-data-file job-file checkpoint-file threads\n";
+    exit(1);
+  }
+  std::string old_keyset_filename(argv[1]);
+  std::string new_keyset_filename(argv[2]);
+  std::string primitive(argv[3]);
+  std::string associated_data_file(argv[4]);
+  std::string job_filename(argv[5]);
+  std::string checkpoint_filename(argv[6]);
+  int num_threads;
+  if (!absl::SimpleAtoi(argv[7], &num_threads) || num_threads < 1) {
+    std::clog << "Invalid number of threads '" << argv[7] << "'.\n";
+    exit(1);
+  }
+  if (!(primitive == "aead" || primitive == "streaming_aead")) {
+    std::clog << "Unknown primitive '" << primitive << "'.\n"
+              << "Expected 'aead' or 'streaming_aead'.\n";
+    exit(1);
+  }
+
+  // Init Tink;
+  CliUtil::InitTink();
+
+  // Get the primitives.
+  std::unique_ptr<Reencrypter> reencrypter;
+  if (primitive == "aead") {
+    reencrypter = Reencrypter::NewForAead(
+        GetPrimitive<crypto::tink::Aead>(old_keyset_filename),
+        GetPrimitive<crypto::tink::Aead>(new_keyset_filename));
+  } else {
+    reencrypter = Reencrypter::NewForStreamingAead(
+        GetPrimitive<crypto::tink::StreamingAead>(old_keyset_filename),
+        GetPrimitive<crypto::tink::StreamingAead>(new_keyset_filename));
+  }
+
+  // Read the jobs, and the associated data.
+  std::vector<Reencrypter::Job> jobs;
+  std::ifstream job_file(job_filename);
+  std::string line;
+  while (std::getline(job_file, line)) {
+    if (line.empty()) continue;
+    Reencrypter::Job job;
+    std::istringstream fields(line);
+    if (!(fields >> job.input_filename >> job.output_filename)) {
+      std::clog << "Invalid job '" << line << "'.\n";
+      exit(1);
+    }
+    jobs.push_back(job);
+  }
+  std::string associated_data = CliUtil::Read(associated_data_file);
+
+  std::clog << "Re-encrypting " << jobs.size() << " files with "
+            << num_threads << " threads...\n";
+  Reencrypter::Stats stats;
+  auto status = reencrypter->ReencryptFiles(
+      jobs, associated_data, checkpoint_filename, num_threads,
+      /* report_interval_files = */ 100, &stats);
+  if (!status.ok()) {
+    std::clog << "Error while re-encrypting: " << status.error_message()
+              << std::endl;
+    exit(1);
+  }
+  std::clog << "All done.\n";
+  return 0;
+}
@@ -0,0 +1,268 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "testing/cc/reencrypter.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mutex>  // NOLINT(build/c++11)
+#include <set>
+#include <sstream>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "absl/types/span.h"
+#include "tink/util/file_input_stream.h"
+#include "tink/util/file_output_stream.h"
+
+using crypto::tink::Aead;
+using crypto::tink::InputStream;
+using crypto::tink::OutputStream;
+using crypto::tink::StreamingAead;
+using crypto::tink::util::FileInputStream;
+using crypto::tink::util::FileOutputStream;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace {
+
+// Returns the contents of the file 'filename'.
+StatusOr<std::string> ReadFile(const std::string& filename) {
+  std::ifstream input(filename, std::ifstream::in | std::ifstream::binary);
+  if (!input.is_open()) {
+    return Status(crypto::tink::util::error::NOT_FOUND,
+                  absl::StrCat("Cannot open file ", filename));
+  }
+  std::stringstream contents;
+  contents << input.rdbuf();
+  if (input.bad()) {
+    return Status(crypto::tink::util::error::INTERNAL,
+                  absl::StrCat("Error reading file ", filename));
+  }
+  return contents.str();
+}
+
+// Writes 'contents' to the file 'filename'.
+Status WriteFile(const std::string& contents, const std::string& filename) {
+  std::ofstream output(filename, std::ofstream::out | std::ofstream::binary);
+  output << contents;
+  output.close();
+  if (output.fail()) {
+    return Status(crypto::tink::util::error::INTERNAL,
+                  absl::StrCat("Error writing file ", filename));
+  }
+  return Status::OK;
+}
+
+void Report(const Reencrypter::Stats& stats, int64_t total_files) {
+  double mib = stats.plaintext_bytes / (1024.0 * 1024.0);
+  std::clog << "Re-encrypted " << stats.files << " of " << total_files
+            << " files (" << stats.skipped_files << " done before), " << mib
+            << " MiB in " << stats.seconds << " s, "
+            << (stats.seconds > 0 ? mib / stats.seconds : 0) << " MiB/s"
+            << std::endl;
+}
+
+}  // namespace
+
+// static
+std::unique_ptr<Reencrypter> Reencrypter::NewForStreamingAead(
+    std::unique_ptr<StreamingAead> old_streaming_aead,
+    std::unique_ptr<StreamingAead> new_streaming_aead) {
+  std::unique_ptr<Reencrypter> reencrypter(new Reencrypter());
+  reencrypter->old_streaming_aead_ = std::move(old_streaming_aead);
+  reencrypter->new_streaming_aead_ = std::move(new_streaming_aead);
+  return reencrypter;
+}
+
+// static
+std::unique_ptr<Reencrypter> Reencrypter::NewForAead(
+    std::unique_ptr<Aead> old_aead, std::unique_ptr<Aead> new_aead) {
+  std::unique_ptr<Reencrypter> reencrypter(new Reencrypter());
+  reencrypter->old_aead_ = std::move(old_aead);
+  reencrypter->new_aead_ = std::move(new_aead);
+  return reencrypter;
+}
+
+StatusOr<int64_t> Reencrypter::ReencryptStream(
+    std::unique_ptr<InputStream> ciphertext_source,
+    std::unique_ptr<OutputStream> ciphertext_destination,
+    absl::string_view associated_data) const {
+  if (old_streaming_aead_ == nullptr) {
+    return Status(crypto::tink::util::error::FAILED_PRECONDITION,
+                  "Not a StreamingAead re-encrypter");
+  }
+  auto dec_stream_result = old_streaming_aead_->NewDecryptingStream(
+      std::move(ciphertext_source), associated_data);
+  if (!dec_stream_result.ok()) return dec_stream_result.status();
+  auto dec_stream = std::move(dec_stream_result.ValueOrDie());
+  auto enc_stream_result = new_streaming_aead_->NewEncryptingStream(
+      std::move(ciphertext_destination), associated_data);
+  if (!enc_stream_result.ok()) return enc_stream_result.status();
+  auto enc_stream = std::move(enc_stream_result.ValueOrDie());
+
+  // Hand each decrypted buffer straight to the encrypting stream, which
+  // encrypts whole segments directly from it.
+  int64_t plaintext_bytes = 0;
+  const void* buffer;
+  while (true) {
+    auto next_result = dec_stream->Next(&buffer);
+    if (next_result.status().error_code() ==
+        crypto::tink::util::error::OUT_OF_RANGE) {
+      break;
+    }
+    if (!next_result.ok()) return next_result.status();
+    int count = next_result.ValueOrDie();
+    auto status = enc_stream->WriteFrom(absl::MakeConstSpan(
+        static_cast<const uint8_t*>(buffer), count));
+    if (!status.ok()) return status;
+    plaintext_bytes += count;
+  }
+  auto status = enc_stream->Close();
+  if (!status.ok()) return status;
+  return plaintext_bytes;
+}
+
+StatusOr<int64_t> Reencrypter::ReencryptFile(
+    const Job& job, absl::string_view associated_data) const {
+  // Write to a temporary file, so that no partial output is taken for a
+  // complete one.
+  std::string temp_filename = absl::StrCat(job.output_filename, ".tmp");
+  StatusOr<int64_t> result(int64_t{0});
+  if (old_aead_ != nullptr) {
+    auto read_result = ReadFile(job.input_filename);
+    if (!read_result.ok()) return read_result.status();
+    auto decrypt_result =
+        old_aead_->Decrypt(read_result.ValueOrDie(), associated_data);
+    if (!decrypt_result.ok()) return decrypt_result.status();
+    auto encrypt_result =
+        new_aead_->Encrypt(decrypt_result.ValueOrDie(), associated_data);
+    if (!encrypt_result.ok()) return encrypt_result.status();
+    auto status = WriteFile(encrypt_result.ValueOrDie(), temp_filename);
+    if (status.ok()) {
+      result = static_cast<int64_t>(decrypt_result.ValueOrDie().size());
+    } else {
+      result = status;
+    }
+  } else {
+    int input_fd = open(job.input_filename.c_str(), O_RDONLY);
+    if (input_fd < 0) {
+      return Status(crypto::tink::util::error::NOT_FOUND,
+                    absl::StrCat("Cannot open file ", job.input_filename));
+    }
+    auto input_stream = absl::make_unique<FileInputStream>(input_fd);
+    int output_fd =
+        open(temp_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (output_fd < 0) {
+      return Status(crypto::tink::util::error::INTERNAL,
+                    absl::StrCat("Cannot create file ", temp_filename));
+    }
+    result = ReencryptStream(std::move(input_stream),
+                             absl::make_unique<FileOutputStream>(output_fd),
+                             associated_data);
+  }
+  if (result.ok() &&
+      rename(temp_filename.c_str(), job.output_filename.c_str()) != 0) {
+    result = Status(crypto::tink::util::error::INTERNAL,
+                    absl::StrCat("Cannot rename ", temp_filename, " to ",
+                                 job.output_filename));
+  }
+  if (!result.ok()) unlink(temp_filename.c_str());
+  return result;
+}
+
+Status Reencrypter::ReencryptFiles(const std::vector<Job>& jobs,
+                                   absl::string_view associated_data,
+                                   const std::string& checkpoint_filename,
+                                   int num_threads, int report_interval_files,
+                                   Stats* stats) const {
+  auto start_time = std::chrono::steady_clock::now();
+  *stats = Stats();
+
+  // Skip the jobs that are done according to the checkpoint.
+  std::set<std::string> done;
+  std::ofstream checkpoint;
+  if (!checkpoint_filename.empty()) {
+    std::ifstream previous_checkpoint(checkpoint_filename);
+    std::string line;
+    while (std::getline(previous_checkpoint, line)) done.insert(line);
+    checkpoint.open(checkpoint_filename, std::ofstream::app);
+    if (!checkpoint.is_open()) {
+      return Status(crypto::tink::util::error::INTERNAL,
+                    absl::StrCat("Cannot open file ", checkpoint_filename));
+    }
+  }
+  std::vector<const Job*> pending;
+  for (const Job& job : jobs) {
+    if (done.count(job.output_filename) > 0) {
+      stats->skipped_files++;
+    } else {
+      pending.push_back(&job);
+    }
+  }
+
+  std::mutex mutex;
+  Status first_error = Status::OK;
+  std::atomic<size_t> next_job(0);
+  std::atomic<bool> failed(false);
+  auto worker = [&]() {
+    while (!failed) {
+      size_t i = next_job++;
+      if (i >= pending.size()) return;
+      auto result = ReencryptFile(*pending[i], associated_data);
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!result.ok()) {
+        if (first_error.ok()) {
+          first_error = Status(
+              result.status().CanonicalCode(),
+              absl::StrCat("Re-encrypting ", pending[i]->input_filename,
+                           " failed: ", result.status().error_message()));
+        }
+        failed = true;
+        return;
+      }
+      stats->files++;
+      stats->plaintext_bytes += result.ValueOrDie();
+      if (checkpoint.is_open()) {
+        checkpoint << pending[i]->output_filename << std::endl;
+      }
+      if (report_interval_files > 0 &&
+          stats->files % report_interval_files == 0) {
+        stats->seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start_time).count();
+        Report(*stats, jobs.size());
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 1; i < num_threads; i++) threads.emplace_back(worker);
+  worker();
+  for (auto& thread : threads) thread.join();
+
+  stats->seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start_time).count();
+  Report(*stats, jobs.size());
+  return first_error;
+}
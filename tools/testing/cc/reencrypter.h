@@ -0,0 +1,103 @@
+// Copyright 2026 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TOOLS_TESTING_CC_REENCRYPTER_H_
+#define TOOLS_TESTING_CC_REENCRYPTER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/input_stream.h"
+#include "tink/output_stream.h"
+#include "tink/streaming_aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+// Re-encrypts ciphertexts after a key rotation: decrypts them with the
+// primitive of the old keyset, and encrypts the plaintext with the
+// primitive of the new keyset (i.e. with its primary key).
+//
+// Files are re-encrypted by a pool of worker threads, each of which
+// streams one file at a time from the decrypting stream into the
+// encrypting stream, without copying the plaintext in between.  Every
+// output file is written under a temporary name, and renamed once it is
+// complete; then it is recorded in a checkpoint file, so that an
+// interrupted job can be resumed by running it again.
+class Reencrypter {
+ public:
+  // A file to re-encrypt, and where to put the result.
+  struct Job {
+    std::string input_filename;
+    std::string output_filename;
+  };
+
+  // Totals of a run of ReencryptFiles().
+  struct Stats {
+    int64_t files = 0;            // # files re-encrypted
+    int64_t skipped_files = 0;    // # files done according to the checkpoint
+    int64_t plaintext_bytes = 0;  // # plaintext bytes re-encrypted
+    double seconds = 0;           // wall time of the run
+  };
+
+  // Returns a Reencrypter for StreamingAead ciphertexts.
+  static std::unique_ptr<Reencrypter> NewForStreamingAead(
+      std::unique_ptr<crypto::tink::StreamingAead> old_streaming_aead,
+      std::unique_ptr<crypto::tink::StreamingAead> new_streaming_aead);
+
+  // Returns a Reencrypter for Aead ciphertexts, each of which is a whole
+  // file.
+  static std::unique_ptr<Reencrypter> NewForAead(
+      std::unique_ptr<crypto::tink::Aead> old_aead,
+      std::unique_ptr<crypto::tink::Aead> new_aead);
+
+  // Re-encrypts the StreamingAead ciphertext read from 'ciphertext_source'
+  // to 'ciphertext_destination', and closes the latter.  Returns the
+  // number of plaintext bytes.
+  crypto::tink::util::StatusOr<int64_t> ReencryptStream(
+      std::unique_ptr<crypto::tink::InputStream> ciphertext_source,
+      std::unique_ptr<crypto::tink::OutputStream> ciphertext_destination,
+      absl::string_view associated_data) const;
+
+  // Re-encrypts the file 'job.input_filename' to 'job.output_filename'.
+  // Returns the number of plaintext bytes.
+  crypto::tink::util::StatusOr<int64_t> ReencryptFile(
+      const Job& job, absl::string_view associated_data) const;
+
+  // Re-encrypts the files of 'jobs' on 'num_threads' threads, skipping
+  // those listed in the file 'checkpoint_filename' (unless it is empty),
+  // to which the output filename of each completed job is appended.
+  // Reports the progress to std::clog every 'report_interval_files' files.
+  // Stops at the first error, and returns it; the completed files stay
+  // recorded in the checkpoint.
+  crypto::tink::util::Status ReencryptFiles(
+      const std::vector<Job>& jobs, absl::string_view associated_data,
+      const std::string& checkpoint_filename, int num_threads,
+      int report_interval_files, Stats* stats) const;
+
+ private:
+  Reencrypter() {}
+
+  std::unique_ptr<crypto::tink::StreamingAead> old_streaming_aead_;
+  std::unique_ptr<crypto::tink::StreamingAead> new_streaming_aead_;
+  std::unique_ptr<crypto::tink::Aead> old_aead_;
+  std::unique_ptr<crypto::tink::Aead> new_aead_;
+};
+
+#endif  // TOOLS_TESTING_CC_REENCRYPTER_H_
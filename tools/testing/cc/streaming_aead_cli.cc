@@ -16,12 +16,14 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 #include "tink/streaming_aead.h"
 #include "tink/keyset_handle.h"
 #include "tink/util/istream_input_stream.h"
 #include "tink/util/ostream_output_stream.h"
 #include "tink/util/status.h"
+#include "testing/cc/cli_benchmark.h"
 #include "testing/cc/cli_util.h"
 
 using crypto::tink::InputStream;
@@ -30,6 +32,64 @@ using crypto::tink::OutputStream;
 using crypto::tink::util::IstreamInputStream;
 using crypto::tink::util::OstreamOutputStream;
 
+namespace {
+
+// Encrypts or decrypts 'input' in memory, with 'saead'.
+crypto::tink::util::StatusOr<std::string> StreamingEncryptOrDecrypt(
+    crypto::tink::StreamingAead* saead, bool encrypt,
+    absl::string_view input, absl::string_view associated_data) {
+  std::unique_ptr<InputStream> input_stream(
+      absl::make_unique<IstreamInputStream>(
+          absl::make_unique<std::istringstream>(std::string(input))));
+  auto output = absl::make_unique<std::ostringstream>();
+  std::ostringstream* output_ptr = output.get();
+  std::unique_ptr<OutputStream> output_stream(
+      absl::make_unique<OstreamOutputStream>(std::move(output)));
+  if (encrypt) {
+    auto enc_stream_result =
+        saead->NewEncryptingStream(std::move(output_stream), associated_data);
+    if (!enc_stream_result.ok()) return enc_stream_result.status();
+    output_stream = std::move(enc_stream_result.ValueOrDie());
+  } else {
+    auto dec_stream_result =
+        saead->NewDecryptingStream(std::move(input_stream), associated_data);
+    if (!dec_stream_result.ok()) return dec_stream_result.status();
+    input_stream = std::move(dec_stream_result.ValueOrDie());
+  }
+  CliUtil::CopyStream(input_stream.get(), output_stream.get());
+  return output_ptr->str();
+}
+
+// Runs the benchmark mode, see CliBenchmark.  The streams are in memory.
+int RunBenchmark(int argc, char** argv) {
+  std::string operation(argc == 7 ? argv[3] : "");
+  if (operation != "encrypt" && operation != "decrypt") {
+    CliBenchmark::ExitWithUsage(argv[0], "'encrypt', 'decrypt'");
+  }
+  CliUtil::InitTink();
+  std::unique_ptr<KeysetHandle> keyset_handle = CliUtil::ReadKeyset(argv[2]);
+  std::unique_ptr<crypto::tink::StreamingAead> saead =
+      CliBenchmark::GetPrimitive<crypto::tink::StreamingAead>(*keyset_handle);
+  const std::string associated_data = "associated data";
+  CliBenchmark::Prepare prepare;
+  if (operation == "decrypt") {
+    prepare = [&](absl::string_view input) {
+      return StreamingEncryptOrDecrypt(saead.get(), true, input, associated_data);
+    };
+  }
+  CliBenchmark::Run("StreamingAead-" + operation,
+                    CliBenchmark::ParseOptions(argv + 4), prepare,
+                    [&](absl::string_view input) {
+                      return StreamingEncryptOrDecrypt(
+                                 saead.get(), operation == "encrypt", input,
+                                 associated_data)
+                          .status();
+                    });
+  return 0;
+}
+
+}  // namespace
+
 // A command-line utility for testing StreamingAead-primitives.
 // It requires 5 arguments:
 //   keyset-file:  name of the file with the keyset to be used for encryption
@@ -38,7 +98,12 @@ using crypto::tink::util::OstreamOutputStream;
 //                or ciphertext for decryption)
 //   associated-data-file:  name of the file containing associated data
 //   output-file:  name of the file for the resulting output
+// With "benchmark" as first argument, runs a throughput benchmark instead,
+// see CliBenchmark.
 int main(int argc, char** argv) {
+  if (CliBenchmark::IsBenchmark(argc, argv)) {
+    return RunBenchmark(argc, argv);
+  }
   if (argc != 6) {
     std::clog << "Usage: " << argv[0]
          << " keyset-file operation input-file associated-data-file "